@@ -292,6 +292,13 @@ else()
     set(GNURADIO_FFT_USES_TEMPLATES TRUE)
 endif()
 
+# Detect if buffer readers have their own header
+if(EXISTS ${GNURADIO_RUNTIME_INCLUDE_DIRS}/gnuradio/buffer_reader.h)
+    set(GNURADIO_HAS_BUFFER_READER TRUE)
+else()
+    set(GNURADIO_HAS_BUFFER_READER FALSE)
+endif()
+
 # Search for IIO component
 if(GNURADIO_VERSION VERSION_GREATER 3.8.99)
     pkg_check_modules(PC_GNURADIO_IIO QUIET gnuradio-iio)
@@ -63,6 +63,13 @@ Rtklib_Pvt::Rtklib_Pvt(const ConfigurationInterface* configuration,
 
     // output rate
     pvt_output_parameters.observable_interval_ms = configuration->property("GNSS-SDR.observable_interval_ms", pvt_output_parameters.observable_interval_ms);
+    // the observables can come at a lower rate than the one of the receiver clock
+    const uint32_t observables_pvt_interval_ms = configuration->property("Observables.pvt_interval_ms", 0U);
+    if (observables_pvt_interval_ms > pvt_output_parameters.observable_interval_ms and pvt_output_parameters.observable_interval_ms > 0)
+        {
+            const uint32_t step_ms = pvt_output_parameters.observable_interval_ms;
+            pvt_output_parameters.observable_interval_ms = (observables_pvt_interval_ms + step_ms - 1U) / step_ms * step_ms;
+        }
 
     pvt_output_parameters.output_rate_ms = bc::lcm(static_cast<int>(pvt_output_parameters.observable_interval_ms), configuration->property(role + ".output_rate_ms", 500));
 
@@ -90,6 +97,7 @@ Rtklib_Pvt::Rtklib_Pvt(const ConfigurationInterface* configuration,
         {
             pvt_output_parameters.rinex_name = FLAGS_RINEX_name;
         }
+    pvt_output_parameters.rinex_rotation_period_s = configuration->property(role + ".rinex_rotation_period_s", pvt_output_parameters.rinex_rotation_period_s);
 
     // RTCM Printer settings
     pvt_output_parameters.flag_rtcm_tty_port = configuration->property(role + ".flag_rtcm_tty_port", false);
@@ -97,6 +105,8 @@ Rtklib_Pvt::Rtklib_Pvt(const ConfigurationInterface* configuration,
     pvt_output_parameters.flag_rtcm_server = configuration->property(role + ".flag_rtcm_server", false);
     pvt_output_parameters.rtcm_tcp_port = configuration->property(role + ".rtcm_tcp_port", 2101);
     pvt_output_parameters.rtcm_station_id = configuration->property(role + ".rtcm_station_id", 1234);
+    pvt_output_parameters.rtcm_mount_points = configuration->property(role + ".rtcm_mount_points", pvt_output_parameters.rtcm_mount_points);
+    pvt_output_parameters.rtcm_client_queue_size = configuration->property(role + ".rtcm_client_queue_size", pvt_output_parameters.rtcm_client_queue_size);
     // RTCM message rates: least common multiple with output_rate_ms
     const int rtcm_MT1019_rate_ms = bc::lcm(configuration->property(role + ".rtcm_MT1019_rate_ms", 5000), pvt_output_parameters.output_rate_ms);
     const int rtcm_MT1020_rate_ms = bc::lcm(configuration->property(role + ".rtcm_MT1020_rate_ms", 5000), pvt_output_parameters.output_rate_ms);
@@ -152,6 +162,13 @@ Rtklib_Pvt::Rtklib_Pvt(const ConfigurationInterface* configuration,
     pvt_output_parameters.nmea_rate_ms = bc::lcm(configuration->property(role + ".nmea_rate_ms", pvt_output_parameters.nmea_rate_ms), pvt_output_parameters.output_rate_ms);
     pvt_output_parameters.an_rate_ms = configuration->property(role + ".an_rate_ms", pvt_output_parameters.an_rate_ms);
 
+    // maximum number of outputs waiting to be written by the printers
+    pvt_output_parameters.output_queue_size = configuration->property(role + ".output_queue_size", pvt_output_parameters.output_queue_size);
+
+    // KML, GPX, GeoJSON and NMEA files: flush period and rotation period (0: no rotation)
+    pvt_output_parameters.output_flush_period_ms = configuration->property(role + ".output_flush_period_ms", pvt_output_parameters.output_flush_period_ms);
+    pvt_output_parameters.output_rotation_period_s = configuration->property(role + ".output_rotation_period_s", pvt_output_parameters.output_rotation_period_s);
+
     // Infer the type of receiver
     /*
      *   TYPE  |  RECEIVER
@@ -619,6 +636,10 @@ Rtklib_Pvt::Rtklib_Pvt(const ConfigurationInterface* configuration,
 
     const int earth_tide = configuration->property(role + ".earth_tide", 0);
 
+    /* Set the interval of the evaluation of the earth tides, which are interpolated in between (0: every epoch).
+    The tides change over hours, so a few tens of seconds spare most of their cost on static sites. */
+    const double earth_tide_interval = configuration->property(role + ".earth_tide_interval_s", 0.0);
+
     int nsys = 0;
     if ((gps_1C_count > 0) || (gps_2S_count > 0) || (gps_L5_count > 0))
         {
@@ -705,6 +726,9 @@ Rtklib_Pvt::Rtklib_Pvt(const ConfigurationInterface* configuration,
     const double min_elevation_to_fix_ambiguity = configuration->property(role + ".min_elevation_to_fix_ambiguity", 0.0); /* Set the minimum elevation (deg) to fix integer ambiguity.
                                                                                                                         If the elevation of the satellite is less than the value, the ambiguity is excluded from the fixed integer vector. */
 
+    const int min_ambiguities_partial_fix = configuration->property(role + ".min_ambiguities_partial_fix", 0); /* Set the minimum number of integer ambiguities fixed by partial ambiguity resolution when the full set fails the ratio-test.
+                                                                                                             The ambiguities with the largest variances are excluded. 0: partial ambiguity resolution disabled. */
+
     const int outage_reset_ambiguity = configuration->property(role + ".outage_reset_ambiguity", 5); /* Set the outage count to reset ambiguity. If the data outage count is over the value, the estimated ambiguity is reset to the initial value.  */
 
     const double slip_threshold = configuration->property(role + ".slip_threshold", 0.05); /* set the cycle‐slip threshold (m) of geometry‐free LC carrier‐phase difference between epochs */
@@ -803,7 +827,9 @@ Rtklib_Pvt::Rtklib_Pvt(const ConfigurationInterface* configuration,
         {{}, {}},                                                                          /* odisp[2][6*11] ocean tide loading parameters {rov,base} */
         {{}, {{}, {}}, {{}, {}}, {}, {}},                                                  /* exterr_t exterr   extended receiver error model */
         0,                                                                                 /* disable L2-AR */
-        {}                                                                                 /* char pppopt[256]   ppp option   "-GAP_RESION="  default gap to reset iono parameters (ep) */
+        {},                                                                                /* char pppopt[256]   ppp option   "-GAP_RESION="  default gap to reset iono parameters (ep) */
+        min_ambiguities_partial_fix,                                                       /* min number of ambiguities fixed by partial AR (0:off) */
+        earth_tide_interval                                                                /* interval of the earth tide evaluations (s) (0:every epoch) */
     };
 
     rtkinit(&rtk, &rtklib_configuration_options);
@@ -816,8 +842,10 @@ Rtklib_Pvt::Rtklib_Pvt(const ConfigurationInterface* configuration,
     pvt_output_parameters.geojson_output_enabled = configuration->property(role + ".geojson_output_enabled", default_output_enabled);
     pvt_output_parameters.kml_output_enabled = configuration->property(role + ".kml_output_enabled", default_output_enabled);
     pvt_output_parameters.xml_output_enabled = configuration->property(role + ".xml_output_enabled", default_output_enabled);
+    pvt_output_parameters.nav_data_binary = configuration->property(role + ".nav_data_format", std::string("xml")) == "binary";
     pvt_output_parameters.nmea_output_file_enabled = configuration->property(role + ".nmea_output_file_enabled", default_output_enabled);
     pvt_output_parameters.rtcm_output_file_enabled = configuration->property(role + ".rtcm_output_file_enabled", false);
+    pvt_output_parameters.raw_obs_output_enabled = configuration->property(role + ".raw_obs_output_enabled", false);
 
     const std::string default_output_path = configuration->property(role + ".output_path", std::string("."));
     pvt_output_parameters.output_path = default_output_path;
@@ -828,16 +856,22 @@ Rtklib_Pvt::Rtklib_Pvt(const ConfigurationInterface* configuration,
     pvt_output_parameters.xml_output_path = configuration->property(role + ".xml_output_path", default_output_path);
     pvt_output_parameters.nmea_output_file_path = configuration->property(role + ".nmea_output_file_path", default_output_path);
     pvt_output_parameters.rtcm_output_file_path = configuration->property(role + ".rtcm_output_file_path", default_output_path);
+    pvt_output_parameters.raw_obs_output_path = configuration->property(role + ".raw_obs_output_path", default_output_path);
 
     // Read PVT MONITOR Configuration
     pvt_output_parameters.monitor_enabled = configuration->property(role + ".enable_monitor", false);
     pvt_output_parameters.udp_addresses = configuration->property(role + ".monitor_client_addresses", std::string("127.0.0.1"));
     pvt_output_parameters.udp_port = configuration->property(role + ".monitor_udp_port", 1234);
+    pvt_output_parameters.monitor_shm_name = configuration->property(role + ".monitor_shm_name", std::string(""));
+    pvt_output_parameters.monitor_callbacks_name = configuration->property(role + ".monitor_callbacks_name", std::string(""));
     pvt_output_parameters.protobuf_enabled = configuration->property(role + ".enable_protobuf", true);
     if (configuration->property("Monitor.enable_protobuf", false) == true)
         {
             pvt_output_parameters.protobuf_enabled = true;
         }
+    // Fixed layout binary packets (Monitor_Pvt_Packet), in the UDP datagrams and / or to a serial device
+    pvt_output_parameters.monitor_binary_enabled = configuration->property(role + ".enable_monitor_binary", false);
+    pvt_output_parameters.monitor_tty_devname = configuration->property(role + ".monitor_tty_devname", std::string(""));
 
     // Read EPHEMERIS MONITOR Configuration
     pvt_output_parameters.monitor_ephemeris_enabled = configuration->property(role + ".enable_monitor_ephemeris", false);
@@ -850,6 +884,32 @@ Rtklib_Pvt::Rtklib_Pvt(const ConfigurationInterface* configuration,
     // Enable or disable rx clock correction in observables
     pvt_output_parameters.enable_rx_clock_correction = configuration->property(role + ".enable_rx_clock_correction", false);
 
+    // Run the positioning (other than Single) in a thread of its own, and a Single solver for the rx clock
+    pvt_output_parameters.decoupled_positioning = configuration->property(role + ".decoupled_positioning", pvt_output_parameters.decoupled_positioning);
+
+    // Single positions extrapolated from anchors, for output rates of tens of Hz
+    pvt_output_parameters.high_rate = configuration->property(role + ".high_rate", pvt_output_parameters.high_rate);
+    pvt_output_parameters.high_rate_anchor_ms = configuration->property(role + ".high_rate_anchor_ms", pvt_output_parameters.high_rate_anchor_ms);
+
+    // Heading and pitch from the baselines between several antennas, one per RF channel
+    pvt_output_parameters.antennas = configuration->property(role + ".antennas", pvt_output_parameters.antennas);
+    if (pvt_output_parameters.antennas > 1)
+        {
+            pvt_output_parameters.channel_antenna.resize(in_streams_);
+            for (unsigned int i = 0; i < in_streams_; i++)
+                {
+                    const int antenna = configuration->property("Channel" + std::to_string(i) + ".RF_channel_ID", 0);
+                    if (antenna < 0 || antenna >= static_cast<int>(pvt_output_parameters.antennas))
+                        {
+                            LOG(WARNING) << "Channel " << i << " is on RF channel " << antenna << ", out of the " << pvt_output_parameters.antennas << " antennas of " << role << ". It is not used";
+                        }
+                    pvt_output_parameters.channel_antenna[i] = antenna;
+                }
+            pvt_output_parameters.attitude_baseline_length_m = configuration->property(role + ".attitude_baseline_length_m", pvt_output_parameters.attitude_baseline_length_m);
+            pvt_output_parameters.attitude_baseline_sigma_m = configuration->property(role + ".attitude_baseline_sigma_m", pvt_output_parameters.attitude_baseline_sigma_m);
+            pvt_output_parameters.attitude_output_filename = configuration->property(role + ".attitude_output_filename", pvt_output_parameters.attitude_output_filename);
+        }
+
     // Set maximum clock offset allowed if pvt_output_parameters.enable_rx_clock_correction = false
     pvt_output_parameters.max_obs_block_rx_clock_offset_ms = configuration->property(role + ".max_clock_offset_ms", pvt_output_parameters.max_obs_block_rx_clock_offset_ms);
 
@@ -891,6 +951,12 @@ bool Rtklib_Pvt::get_latest_PVT(double* longitude_deg,
 }
 
 
+void Rtklib_Pvt::get_receiver_snapshot(Gnss_Receiver_Snapshot& snapshot) const
+{
+    pvt_->get_receiver_snapshot(snapshot);
+}
+
+
 void Rtklib_Pvt::clear_ephemeris()
 {
     pvt_->clear_ephemeris();
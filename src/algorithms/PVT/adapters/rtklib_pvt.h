@@ -49,6 +49,7 @@ class Gps_Ephemeris;
  *
  * GNSS-SDR.pre_2009_file - flag indicating a file older than 2009 rollover should be processed (false)
  * GNSS-SDR.observable_interval_ms - (20)
+ * Observables.pvt_interval_ms - interval of the observables given to PVT, if longer than GNSS-SDR.observable_interval_ms (0)
  *
  * It supports the following configuration options:
  *
@@ -220,6 +221,8 @@ public:
         double* course_over_ground_deg,
         time_t* UTC_time) override;
 
+    void get_receiver_snapshot(Gnss_Receiver_Snapshot& snapshot) const override;
+
 private:
     rtklib_pvt_gs_sptr pvt_;
     rtk_t rtk{};
@@ -17,6 +17,8 @@
 #include "rtklib_pvt_gs.h"
 #include "MATH_CONSTANTS.h"
 #include "an_packet_printer.h"
+#include "attitude_solver.h"
+#include "beamformer_steering.h"
 #include "beidou_dnav_almanac.h"
 #include "beidou_dnav_ephemeris.h"
 #include "beidou_dnav_iono.h"
@@ -37,6 +39,10 @@
 #include "gnss_sdr_create_directory.h"
 #include "gnss_sdr_filesystem.h"
 #include "gnss_sdr_make_unique.h"
+#include "gnss_receiver_callbacks.h"
+#include "gnss_shm_ring.h"
+#include "gnss_signal_id.h"
+#include "gnss_trace.h"
 #include "gps_almanac.h"
 #include "gps_cnav_ephemeris.h"
 #include "gps_cnav_iono.h"
@@ -49,9 +55,12 @@
 #include "kml_printer.h"
 #include "monitor_ephemeris_udp_sink.h"
 #include "monitor_pvt.h"
+#include "monitor_pvt_serial_sink.h"
 #include "monitor_pvt_udp_sink.h"
 #include "nmea_printer.h"
 #include "pvt_conf.h"
+#include "pvt_output_dispatcher.h"
+#include "raw_obs_log.h"
 #include "rinex_printer.h"
 #include "rtcm_printer.h"
 #include "rtklib_rtkcmn.h"
@@ -119,25 +128,6 @@ rtklib_pvt_gs::rtklib_pvt_gs(uint32_t nchannels,
           gr::io_signature::make(nchannels, nchannels, sizeof(Gnss_Synchro)),
           gr::io_signature::make(0, 0, 0)),
       d_dump_filename(conf_.dump_filename),
-      d_gps_ephemeris_sptr_type_hash_code(typeid(std::shared_ptr<Gps_Ephemeris>).hash_code()),
-      d_gps_iono_sptr_type_hash_code(typeid(std::shared_ptr<Gps_Iono>).hash_code()),
-      d_gps_utc_model_sptr_type_hash_code(typeid(std::shared_ptr<Gps_Utc_Model>).hash_code()),
-      d_gps_cnav_ephemeris_sptr_type_hash_code(typeid(std::shared_ptr<Gps_CNAV_Ephemeris>).hash_code()),
-      d_gps_cnav_iono_sptr_type_hash_code(typeid(std::shared_ptr<Gps_CNAV_Iono>).hash_code()),
-      d_gps_cnav_utc_model_sptr_type_hash_code(typeid(std::shared_ptr<Gps_CNAV_Utc_Model>).hash_code()),
-      d_gps_almanac_sptr_type_hash_code(typeid(std::shared_ptr<Gps_Almanac>).hash_code()),
-      d_galileo_ephemeris_sptr_type_hash_code(typeid(std::shared_ptr<Galileo_Ephemeris>).hash_code()),
-      d_galileo_iono_sptr_type_hash_code(typeid(std::shared_ptr<Galileo_Iono>).hash_code()),
-      d_galileo_utc_model_sptr_type_hash_code(typeid(std::shared_ptr<Galileo_Utc_Model>).hash_code()),
-      d_galileo_almanac_helper_sptr_type_hash_code(typeid(std::shared_ptr<Galileo_Almanac_Helper>).hash_code()),
-      d_galileo_almanac_sptr_type_hash_code(typeid(std::shared_ptr<Galileo_Almanac>).hash_code()),
-      d_glonass_gnav_ephemeris_sptr_type_hash_code(typeid(std::shared_ptr<Glonass_Gnav_Ephemeris>).hash_code()),
-      d_glonass_gnav_utc_model_sptr_type_hash_code(typeid(std::shared_ptr<Glonass_Gnav_Utc_Model>).hash_code()),
-      d_glonass_gnav_almanac_sptr_type_hash_code(typeid(std::shared_ptr<Glonass_Gnav_Almanac>).hash_code()),
-      d_beidou_dnav_ephemeris_sptr_type_hash_code(typeid(std::shared_ptr<Beidou_Dnav_Ephemeris>).hash_code()),
-      d_beidou_dnav_iono_sptr_type_hash_code(typeid(std::shared_ptr<Beidou_Dnav_Iono>).hash_code()),
-      d_beidou_dnav_utc_model_sptr_type_hash_code(typeid(std::shared_ptr<Beidou_Dnav_Utc_Model>).hash_code()),
-      d_beidou_dnav_almanac_sptr_type_hash_code(typeid(std::shared_ptr<Beidou_Dnav_Almanac>).hash_code()),
       d_galileo_has_data_sptr_type_hash_code(typeid(std::shared_ptr<Galileo_HAS_data>).hash_code()),
       d_rinex_version(conf_.rinex_version),
       d_rx_time(0.0),
@@ -168,6 +158,7 @@ rtklib_pvt_gs::rtklib_pvt_gs(uint32_t nchannels,
       d_show_local_time_zone(conf_.show_local_time_zone),
       d_waiting_obs_block_rx_clock_offset_correction_msg(false),
       d_enable_rx_clock_correction(conf_.enable_rx_clock_correction),
+      d_separate_user_pvt_solver(conf_.enable_rx_clock_correction || (conf_.decoupled_positioning && rtk.opt.mode != PMODE_SINGLE)),
       d_an_printer_enabled(conf_.an_output_enabled),
       d_log_timetag(conf_.log_source_timetag)
 {
@@ -177,19 +168,8 @@ rtklib_pvt_gs::rtklib_pvt_gs(uint32_t nchannels,
     this->message_port_register_out(pmt::mp("pvt_to_trk"));
     // Send PVT status to gnss_flowgraph
     this->message_port_register_out(pmt::mp("status"));
-
-    // GPS Ephemeris data message port in
-    this->message_port_register_in(pmt::mp("telemetry"));
-    this->set_msg_handler(pmt::mp("telemetry"),
-#if HAS_GENERIC_LAMBDA
-        [this](auto&& PH1) { msg_handler_telemetry(PH1); });
-#else
-#if USE_BOOST_BIND_PLACEHOLDERS
-        boost::bind(&rtklib_pvt_gs::msg_handler_telemetry, this, boost::placeholders::_1));
-#else
-        boost::bind(&rtklib_pvt_gs::msg_handler_telemetry, this, _1));
-#endif
-#endif
+    // Send the directions of the satellites to the antenna array beamformers
+    this->message_port_register_out(pmt::mp("pvt_to_beamformer"));
 
     // Galileo E6 HAS messages port in
     this->message_port_register_in(pmt::mp("E6_HAS_to_PVT"));
@@ -250,7 +230,7 @@ rtklib_pvt_gs::rtklib_pvt_gs(uint32_t nchannels,
         }
     if (d_kml_output_enabled)
         {
-            d_kml_dump = std::make_unique<Kml_Printer>(conf_.kml_output_path);
+            d_kml_dump = std::make_unique<Kml_Printer>(conf_.kml_output_path, conf_.output_flush_period_ms, conf_.output_rotation_period_s);
             d_kml_dump->set_headers(kml_dump_filename);
         }
     else
@@ -266,7 +246,7 @@ rtklib_pvt_gs::rtklib_pvt_gs(uint32_t nchannels,
         }
     if (d_gpx_output_enabled)
         {
-            d_gpx_dump = std::make_unique<Gpx_Printer>(conf_.gpx_output_path);
+            d_gpx_dump = std::make_unique<Gpx_Printer>(conf_.gpx_output_path, conf_.output_flush_period_ms, conf_.output_rotation_period_s);
             d_gpx_dump->set_headers(gpx_dump_filename);
         }
     else
@@ -282,7 +262,7 @@ rtklib_pvt_gs::rtklib_pvt_gs(uint32_t nchannels,
         }
     if (d_geojson_output_enabled)
         {
-            d_geojson_printer = std::make_unique<GeoJSON_Printer>(conf_.geojson_output_path);
+            d_geojson_printer = std::make_unique<GeoJSON_Printer>(conf_.geojson_output_path, conf_.output_flush_period_ms, conf_.output_rotation_period_s);
             d_geojson_printer->set_headers(geojson_dump_filename);
         }
     else
@@ -298,7 +278,7 @@ rtklib_pvt_gs::rtklib_pvt_gs(uint32_t nchannels,
 
     if (d_nmea_output_file_enabled)
         {
-            d_nmea_printer = std::make_unique<Nmea_Printer>(conf_.nmea_dump_filename, conf_.nmea_output_file_enabled, conf_.flag_nmea_tty_port, conf_.nmea_dump_devname, conf_.nmea_output_file_path);
+            d_nmea_printer = std::make_unique<Nmea_Printer>(conf_.nmea_dump_filename, conf_.nmea_output_file_enabled, conf_.flag_nmea_tty_port, conf_.nmea_dump_devname, conf_.nmea_output_file_path, conf_.output_flush_period_ms, conf_.output_rotation_period_s);
         }
     else
         {
@@ -309,7 +289,7 @@ rtklib_pvt_gs::rtklib_pvt_gs(uint32_t nchannels,
     const std::string rtcm_dump_filename = d_dump_filename;
     if (conf_.flag_rtcm_server || conf_.flag_rtcm_tty_port || conf_.rtcm_output_file_enabled)
         {
-            d_rtcm_printer = std::make_unique<Rtcm_Printer>(rtcm_dump_filename, conf_.rtcm_output_file_enabled, conf_.flag_rtcm_server, conf_.flag_rtcm_tty_port, conf_.rtcm_tcp_port, conf_.rtcm_station_id, conf_.rtcm_dump_devname, true, conf_.rtcm_output_file_path);
+            d_rtcm_printer = std::make_unique<Rtcm_Printer>(rtcm_dump_filename, conf_.rtcm_output_file_enabled, conf_.flag_rtcm_server, conf_.flag_rtcm_tty_port, conf_.rtcm_tcp_port, conf_.rtcm_station_id, conf_.rtcm_dump_devname, true, conf_.rtcm_output_file_path, conf_.rtcm_mount_points, conf_.rtcm_client_queue_size);
             std::map<int, int> rtcm_msg_rate_ms = conf_.rtcm_msg_rate_ms;
             if (rtcm_msg_rate_ms.find(1019) != rtcm_msg_rate_ms.end())
                 {
@@ -379,7 +359,7 @@ rtklib_pvt_gs::rtklib_pvt_gs(uint32_t nchannels,
     // initialize RINEX printer
     if (d_rinex_output_enabled)
         {
-            d_rp = std::make_unique<Rinex_Printer>(d_rinex_version, conf_.rinex_output_path, conf_.rinex_name);
+            d_rp = std::make_unique<Rinex_Printer>(d_rinex_version, conf_.rinex_output_path, conf_.rinex_name, conf_.rinex_rotation_period_s);
             d_rp->set_pre_2009_file(conf_.pre_2009_file);
         }
     else
@@ -387,6 +367,16 @@ rtklib_pvt_gs::rtklib_pvt_gs(uint32_t nchannels,
             d_rp = nullptr;
         }
 
+    // binary log of the observables and of the navigation data, converted to RINEX offline
+    if (conf_.raw_obs_output_enabled)
+        {
+            d_raw_obs_log = std::make_unique<Raw_Obs_Log>(conf_.raw_obs_output_path, conf_.rinex_name, d_type_of_rx);
+            if (!d_raw_obs_log->is_open())
+                {
+                    d_raw_obs_log = nullptr;
+                }
+        }
+
     // XML printer
     if (d_xml_storage)
         {
@@ -421,6 +411,10 @@ rtklib_pvt_gs::rtklib_pvt_gs(uint32_t nchannels,
                 }
 
             d_xml_base_path = d_xml_base_path + fs::path::preferred_separator;
+            d_nav_data_extension = conf_.nav_data_binary ? ".bin" : ".xml";
+            d_nav_data_store = std::make_unique<Gnss_Nav_Data_Store>(conf_.nav_data_binary);
+            d_nav_data_stored = std::chrono::steady_clock::now();
+            d_nav_data_period = std::chrono::milliseconds(conf_.output_flush_period_ms);
         }
 
     // Initialize HAS simple printer
@@ -444,6 +438,15 @@ rtklib_pvt_gs::rtklib_pvt_gs(uint32_t nchannels,
             d_an_printer = nullptr;
         }
 
+    if (!conf_.monitor_callbacks_name.empty())
+        {
+            d_receiver_callbacks = Gnss_Receiver_Callbacks::get(conf_.monitor_callbacks_name);
+            if (!d_receiver_callbacks->pvt)
+                {
+                    d_receiver_callbacks = nullptr;
+                }
+        }
+
     // PVT MONITOR
     if (d_flag_monitor_pvt_enabled)
         {
@@ -452,7 +455,24 @@ rtklib_pvt_gs::rtklib_pvt_gs(uint32_t nchannels,
             std::sort(udp_addr_vec.begin(), udp_addr_vec.end());
             udp_addr_vec.erase(std::unique(udp_addr_vec.begin(), udp_addr_vec.end()), udp_addr_vec.end());
 
-            d_udp_sink_ptr = std::make_unique<Monitor_Pvt_Udp_Sink>(udp_addr_vec, conf_.udp_port, conf_.protobuf_enabled);
+            d_udp_sink_ptr = std::make_unique<Monitor_Pvt_Udp_Sink>(udp_addr_vec, conf_.udp_port, conf_.protobuf_enabled, conf_.monitor_binary_enabled);
+            if (!conf_.monitor_shm_name.empty())
+                {
+                    d_pvt_shm_ring = std::make_unique<Gnss_Shm_Ring_Writer>(conf_.monitor_shm_name, SHM_RECORD_MONITOR_PVT, sizeof(Monitor_Pvt), 256);
+                    if (!d_pvt_shm_ring->is_open())
+                        {
+                            LOG(WARNING) << "Error creating the PVT monitor shared memory: " << d_pvt_shm_ring->error();
+                            d_pvt_shm_ring = nullptr;
+                        }
+                }
+            if (!conf_.monitor_tty_devname.empty())
+                {
+                    d_pvt_serial_sink = std::make_unique<Monitor_Pvt_Serial_Sink>(conf_.monitor_tty_devname);
+                    if (!d_pvt_serial_sink->is_open())
+                        {
+                            d_pvt_serial_sink = nullptr;
+                        }
+                }
         }
     else
         {
@@ -520,20 +540,25 @@ rtklib_pvt_gs::rtklib_pvt_gs(uint32_t nchannels,
             d_local_time_str = std::string(" ") + time_zone_abrv + " (UTC " + utc_diff_str.substr(0, 3) + ":" + utc_diff_str.substr(3, 2) + ")";
         }
 
-    if (d_enable_rx_clock_correction == true)
+    if (d_separate_user_pvt_solver == true)
         {
             // setup two PVT solvers: internal solver for rx clock and user solver
-            // user PVT solver
-            d_user_pvt_solver = std::make_shared<Rtklib_Solver>(rtk, dump_ls_pvt_filename, d_dump, d_dump_mat);
-            d_user_pvt_solver->set_averaging_depth(1);
-            d_user_pvt_solver->set_pre_2009_file(conf_.pre_2009_file);
-
             // internal PVT solver, mainly used to estimate the receiver clock
             rtk_t internal_rtk = rtk;
             internal_rtk.opt.mode = PMODE_SINGLE;  // use single positioning mode in internal PVT solver
             d_internal_pvt_solver = std::make_shared<Rtklib_Solver>(internal_rtk, dump_ls_pvt_filename, false, false);
             d_internal_pvt_solver->set_averaging_depth(1);
             d_internal_pvt_solver->set_pre_2009_file(conf_.pre_2009_file);
+
+            // user PVT solver, with the navigation data of the internal one
+            d_user_pvt_solver = std::make_shared<Rtklib_Solver>(rtk, dump_ls_pvt_filename, d_dump, d_dump_mat, d_internal_pvt_solver->get_nav_data());
+            d_user_pvt_solver->set_averaging_depth(1);
+            d_user_pvt_solver->set_pre_2009_file(conf_.pre_2009_file);
+            if (conf_.decoupled_positioning && rtk.opt.mode != PMODE_SINGLE)
+                {
+                    // the user solver runs at its own pace, the internal one at the observables rate
+                    d_user_pvt_solver->enable_decoupled_positioning();
+                }
         }
     else
         {
@@ -543,19 +568,49 @@ rtklib_pvt_gs::rtklib_pvt_gs(uint32_t nchannels,
             d_internal_pvt_solver->set_pre_2009_file(conf_.pre_2009_file);
             d_user_pvt_solver = d_internal_pvt_solver;
         }
+    if (conf_.high_rate)
+        {
+            const double anchor_period_s = static_cast<double>(std::max(conf_.high_rate_anchor_ms, 1)) / 1000.0;
+            d_internal_pvt_solver->enable_high_rate(anchor_period_s);
+            if (d_user_pvt_solver != d_internal_pvt_solver and rtk.opt.mode == PMODE_SINGLE)
+                {
+                    d_user_pvt_solver->enable_high_rate(anchor_period_s);
+                }
+        }
 
-    d_mapStringValues["1C"] = evGPS_1C;
-    d_mapStringValues["2S"] = evGPS_2S;
-    d_mapStringValues["L5"] = evGPS_L5;
-    d_mapStringValues["1B"] = evGAL_1B;
-    d_mapStringValues["5X"] = evGAL_5X;
-    d_mapStringValues["E6"] = evGAL_E6;
-    d_mapStringValues["7X"] = evGAL_7X;
-    d_mapStringValues["1G"] = evGLO_1G;
-    d_mapStringValues["2G"] = evGLO_2G;
-    d_mapStringValues["B1"] = evBDS_B1;
-    d_mapStringValues["B2"] = evBDS_B2;
-    d_mapStringValues["B3"] = evBDS_B3;
+    // heading and pitch from the baselines to the other antennas, whose
+    // observables are not given to the positioning of the main one
+    if (conf_.antennas > 1)
+        {
+            d_channel_antenna = conf_.channel_antenna;
+            d_channel_antenna.resize(d_nchannels, 0);
+            d_antenna_observables_maps.resize(conf_.antennas - 1);
+            d_attitude_solver = std::make_unique<Attitude_Solver>(rtk.opt, conf_.antennas, conf_.attitude_baseline_length_m, conf_.attitude_baseline_sigma_m);
+            d_internal_pvt_solver->enable_epoch_observations();
+            if (!conf_.attitude_output_filename.empty())
+                {
+                    d_attitude_file.open(conf_.attitude_output_filename, std::ios::out | std::ios::trunc);
+                    if (d_attitude_file.is_open())
+                        {
+                            d_attitude_file << "week,tow_s,antenna,status,satellites,ratio,east_m,north_m,up_m,length_m,heading_deg,pitch_deg\n";
+                        }
+                    else
+                        {
+                            LOG(WARNING) << "Unable to open the attitude output file " << conf_.attitude_output_filename;
+                        }
+                }
+        }
+
+    // navigation state for the aiding of the tracking channels
+    d_navigation_state = Gnss_Navigation_State::get();
+
+    // the observables tag each epoch with its sample counter if the latency is measured
+    d_pipeline_latency = Gnss_Pipeline_Latency::global_instance();
+    d_rx_sample_key = pmt::mp("rx_sample");
+    d_sample_clock = Gnss_Sample_Clock::global_instance();
+
+    // the printers write their outputs in a thread of their own
+    d_output_dispatcher = std::make_unique<Pvt_Output_Dispatcher>(conf_.output_queue_size);
 
     // set the RTKLIB trace (debug) level
     tracelevel(conf_.rtk_trace_level);
@@ -587,981 +642,527 @@ rtklib_pvt_gs::~rtklib_pvt_gs()
             msgctl(d_sysv_msqid, IPC_RMID, nullptr);
         }
     try
-        {
-            if (d_xml_storage)
-                {
-                    // save GPS L2CM ephemeris to XML file
-                    std::string file_name = d_xml_base_path + "gps_cnav_ephemeris.xml";
-                    if (d_internal_pvt_solver->gps_cnav_ephemeris_map.empty() == false)
-                        {
-                            std::ofstream ofs;
-                            try
-                                {
-                                    ofs.open(file_name.c_str(), std::ofstream::trunc | std::ofstream::out);
-                                    boost::archive::xml_oarchive xml(ofs);
-                                    xml << boost::serialization::make_nvp("GNSS-SDR_cnav_ephemeris_map", d_internal_pvt_solver->gps_cnav_ephemeris_map);
-                                    LOG(INFO) << "Saved GPS L2CM or L5 Ephemeris map data";
-                                }
-                            catch (const boost::archive::archive_exception& e)
-                                {
-                                    LOG(WARNING) << e.what();
-                                }
-                            catch (const std::exception& e)
-                                {
-                                    LOG(WARNING) << e.what();
-                                }
-                        }
-                    else
-                        {
-                            LOG(INFO) << "Failed to save GPS L2CM or L5 Ephemeris, map is empty";
-                        }
-
-                    // save GPS L1 CA ephemeris to XML file
-                    file_name = d_xml_base_path + "gps_ephemeris.xml";
-                    if (d_internal_pvt_solver->gps_ephemeris_map.empty() == false)
-                        {
-                            std::ofstream ofs;
-                            try
-                                {
-                                    ofs.open(file_name.c_str(), std::ofstream::trunc | std::ofstream::out);
-                                    boost::archive::xml_oarchive xml(ofs);
-                                    xml << boost::serialization::make_nvp("GNSS-SDR_ephemeris_map", d_internal_pvt_solver->gps_ephemeris_map);
-                                    LOG(INFO) << "Saved GPS L1 CA Ephemeris map data";
-                                }
-                            catch (const boost::archive::archive_exception& e)
-                                {
-                                    LOG(WARNING) << e.what();
-                                }
-                            catch (const std::exception& e)
-                                {
-                                    LOG(WARNING) << e.what();
-                                }
-                        }
-                    else
-                        {
-                            LOG(INFO) << "Failed to save GPS L1 CA Ephemeris, map is empty";
-                        }
-
-                    // save Galileo E1 ephemeris to XML file
-                    file_name = d_xml_base_path + "gal_ephemeris.xml";
-                    if (d_internal_pvt_solver->galileo_ephemeris_map.empty() == false)
-                        {
-                            std::ofstream ofs;
-                            try
-                                {
-                                    ofs.open(file_name.c_str(), std::ofstream::trunc | std::ofstream::out);
-                                    boost::archive::xml_oarchive xml(ofs);
-                                    xml << boost::serialization::make_nvp("GNSS-SDR_gal_ephemeris_map", d_internal_pvt_solver->galileo_ephemeris_map);
-                                    LOG(INFO) << "Saved Galileo E1 Ephemeris map data";
-                                }
-                            catch (const boost::archive::archive_exception& e)
-                                {
-                                    LOG(WARNING) << e.what();
-                                }
-                            catch (const std::ofstream::failure& e)
-                                {
-                                    LOG(WARNING) << "Problem opening output XML file";
-                                }
-                            catch (const std::exception& e)
-                                {
-                                    LOG(WARNING) << e.what();
-                                }
-                        }
-                    else
-                        {
-                            LOG(INFO) << "Failed to save Galileo E1 Ephemeris, map is empty";
-                        }
-
-                    // save GLONASS GNAV ephemeris to XML file
-                    file_name = d_xml_base_path + "eph_GLONASS_GNAV.xml";
-                    if (d_internal_pvt_solver->glonass_gnav_ephemeris_map.empty() == false)
-                        {
-                            std::ofstream ofs;
-                            try
-                                {
-                                    ofs.open(file_name.c_str(), std::ofstream::trunc | std::ofstream::out);
-                                    boost::archive::xml_oarchive xml(ofs);
-                                    xml << boost::serialization::make_nvp("GNSS-SDR_gnav_ephemeris_map", d_internal_pvt_solver->glonass_gnav_ephemeris_map);
-                                    LOG(INFO) << "Saved GLONASS GNAV Ephemeris map data";
-                                }
-                            catch (const boost::archive::archive_exception& e)
-                                {
-                                    LOG(WARNING) << e.what();
-                                }
-                            catch (const std::ofstream::failure& e)
-                                {
-                                    LOG(WARNING) << "Problem opening output XML file";
-                                }
-                            catch (const std::exception& e)
-                                {
-                                    LOG(WARNING) << e.what();
-                                }
-                        }
-                    else
-                        {
-                            LOG(INFO) << "Failed to save GLONASS GNAV Ephemeris, map is empty";
-                        }
-
-                    // Save GPS UTC model parameters
-                    file_name = d_xml_base_path + "gps_utc_model.xml";
-                    if (d_internal_pvt_solver->gps_utc_model.valid)
-                        {
-                            std::ofstream ofs;
-                            try
-                                {
-                                    ofs.open(file_name.c_str(), std::ofstream::trunc | std::ofstream::out);
-                                    boost::archive::xml_oarchive xml(ofs);
-                                    xml << boost::serialization::make_nvp("GNSS-SDR_utc_model", d_internal_pvt_solver->gps_utc_model);
-                                    LOG(INFO) << "Saved GPS UTC model parameters";
-                                }
-                            catch (const std::ofstream::failure& e)
-                                {
-                                    LOG(WARNING) << "Problem opening output XML file";
-                                }
-                            catch (const boost::archive::archive_exception& e)
-                                {
-                                    LOG(WARNING) << e.what();
-                                }
-                            catch (const std::exception& e)
-                                {
-                                    LOG(WARNING) << e.what();
-                                }
-                        }
-                    else
-                        {
-                            LOG(INFO) << "Failed to save GPS UTC model parameters, not valid data";
-                        }
-
-                    // Save Galileo UTC model parameters
-                    file_name = d_xml_base_path + "gal_utc_model.xml";
-                    if (d_internal_pvt_solver->galileo_utc_model.Delta_tLS != 0.0)
-                        {
-                            std::ofstream ofs;
-                            try
-                                {
-                                    ofs.open(file_name.c_str(), std::ofstream::trunc | std::ofstream::out);
-                                    boost::archive::xml_oarchive xml(ofs);
-                                    xml << boost::serialization::make_nvp("GNSS-SDR_gal_utc_model", d_internal_pvt_solver->galileo_utc_model);
-                                    LOG(INFO) << "Saved Galileo UTC model parameters";
-                                }
-                            catch (const boost::archive::archive_exception& e)
-                                {
-                                    LOG(WARNING) << e.what();
-                                }
-                            catch (const std::ofstream::failure& e)
-                                {
-                                    LOG(WARNING) << "Problem opening output XML file";
-                                }
-                            catch (const std::exception& e)
-                                {
-                                    LOG(WARNING) << e.what();
-                                }
-                        }
-                    else
-                        {
-                            LOG(INFO) << "Failed to save Galileo UTC model parameters, not valid data";
-                        }
-
-                    // Save GPS iono parameters
-                    file_name = d_xml_base_path + "gps_iono.xml";
-                    if (d_internal_pvt_solver->gps_iono.valid == true)
-                        {
-                            std::ofstream ofs;
-                            try
-                                {
-                                    ofs.open(file_name.c_str(), std::ofstream::trunc | std::ofstream::out);
-                                    boost::archive::xml_oarchive xml(ofs);
-                                    xml << boost::serialization::make_nvp("GNSS-SDR_iono_model", d_internal_pvt_solver->gps_iono);
-                                    LOG(INFO) << "Saved GPS ionospheric model parameters";
-                                }
-                            catch (const boost::archive::archive_exception& e)
-                                {
-                                    LOG(WARNING) << e.what();
-                                }
-                            catch (const std::ofstream::failure& e)
-                                {
-                                    LOG(WARNING) << "Problem opening output XML file";
-                                }
-                            catch (const std::exception& e)
-                                {
-                                    LOG(WARNING) << e.what();
-                                }
-                        }
-                    else
-                        {
-                            LOG(INFO) << "Failed to save GPS ionospheric model parameters, not valid data";
-                        }
-
-                    // Save GPS CNAV iono parameters
-                    file_name = d_xml_base_path + "gps_cnav_iono.xml";
-                    if (d_internal_pvt_solver->gps_cnav_iono.valid == true)
-                        {
-                            std::ofstream ofs;
-                            try
-                                {
-                                    ofs.open(file_name.c_str(), std::ofstream::trunc | std::ofstream::out);
-                                    boost::archive::xml_oarchive xml(ofs);
-                                    xml << boost::serialization::make_nvp("GNSS-SDR_cnav_iono_model", d_internal_pvt_solver->gps_cnav_iono);
-                                    LOG(INFO) << "Saved GPS CNAV ionospheric model parameters";
-                                }
-                            catch (const boost::archive::archive_exception& e)
-                                {
-                                    LOG(WARNING) << e.what();
-                                }
-                            catch (const std::ofstream::failure& e)
-                                {
-                                    LOG(WARNING) << "Problem opening output XML file";
-                                }
-                            catch (const std::exception& e)
-                                {
-                                    LOG(WARNING) << e.what();
-                                }
-                        }
-                    else
-                        {
-                            LOG(INFO) << "Failed to save GPS CNAV ionospheric model parameters, not valid data";
-                        }
-
-                    // Save Galileo iono parameters
-                    file_name = d_xml_base_path + "gal_iono.xml";
-                    if (d_internal_pvt_solver->galileo_iono.ai0 != 0.0)
-                        {
-                            std::ofstream ofs;
-                            try
-                                {
-                                    ofs.open(file_name.c_str(), std::ofstream::trunc | std::ofstream::out);
-                                    boost::archive::xml_oarchive xml(ofs);
-                                    xml << boost::serialization::make_nvp("GNSS-SDR_gal_iono_model", d_internal_pvt_solver->galileo_iono);
-                                    LOG(INFO) << "Saved Galileo ionospheric model parameters";
-                                }
-                            catch (const boost::archive::archive_exception& e)
-                                {
-                                    LOG(WARNING) << e.what();
-                                }
-                            catch (const std::ofstream::failure& e)
-                                {
-                                    LOG(WARNING) << "Problem opening output XML file";
-                                }
-                            catch (const std::exception& e)
-                                {
-                                    LOG(WARNING) << e.what();
-                                }
-                        }
-                    else
-                        {
-                            LOG(INFO) << "Failed to save Galileo ionospheric model parameters, not valid data";
-                        }
-
-                    // save GPS almanac to XML file
-                    file_name = d_xml_base_path + "gps_almanac.xml";
-                    if (d_internal_pvt_solver->gps_almanac_map.empty() == false)
-                        {
-                            std::ofstream ofs;
-                            try
-                                {
-                                    ofs.open(file_name.c_str(), std::ofstream::trunc | std::ofstream::out);
-                                    boost::archive::xml_oarchive xml(ofs);
-                                    xml << boost::serialization::make_nvp("GNSS-SDR_gps_almanac_map", d_internal_pvt_solver->gps_almanac_map);
-                                    LOG(INFO) << "Saved GPS almanac map data";
-                                }
-                            catch (const boost::archive::archive_exception& e)
-                                {
-                                    LOG(WARNING) << e.what();
-                                }
-                            catch (const std::ofstream::failure& e)
-                                {
-                                    LOG(WARNING) << "Problem opening output XML file";
-                                }
-                            catch (const std::exception& e)
-                                {
-                                    LOG(WARNING) << e.what();
-                                }
-                        }
-                    else
-                        {
-                            LOG(INFO) << "Failed to save GPS almanac, map is empty";
-                        }
-
-                    // Save Galileo almanac
-                    file_name = d_xml_base_path + "gal_almanac.xml";
-                    if (d_internal_pvt_solver->galileo_almanac_map.empty() == false)
-                        {
-                            std::ofstream ofs;
-                            try
-                                {
-                                    ofs.open(file_name.c_str(), std::ofstream::trunc | std::ofstream::out);
-                                    boost::archive::xml_oarchive xml(ofs);
-                                    xml << boost::serialization::make_nvp("GNSS-SDR_gal_almanac_map", d_internal_pvt_solver->galileo_almanac_map);
-                                    LOG(INFO) << "Saved Galileo almanac data";
-                                }
-                            catch (const boost::archive::archive_exception& e)
-                                {
-                                    LOG(WARNING) << e.what();
-                                }
-                            catch (const std::ofstream::failure& e)
-                                {
-                                    LOG(WARNING) << "Problem opening output XML file";
-                                }
-                            catch (const std::exception& e)
-                                {
-                                    LOG(WARNING) << e.what();
-                                }
-                        }
-                    else
-                        {
-                            LOG(INFO) << "Failed to save Galileo almanac, not valid data";
-                        }
-
-                    // Save GPS CNAV UTC model parameters
-                    file_name = d_xml_base_path + "gps_cnav_utc_model.xml";
-                    if (d_internal_pvt_solver->gps_cnav_utc_model.valid)
-                        {
-                            std::ofstream ofs;
-                            try
-                                {
-                                    ofs.open(file_name.c_str(), std::ofstream::trunc | std::ofstream::out);
-                                    boost::archive::xml_oarchive xml(ofs);
-                                    xml << boost::serialization::make_nvp("GNSS-SDR_cnav_utc_model", d_internal_pvt_solver->gps_cnav_utc_model);
-                                    LOG(INFO) << "Saved GPS CNAV UTC model parameters";
-                                }
-                            catch (const boost::archive::archive_exception& e)
-                                {
-                                    LOG(WARNING) << e.what();
-                                }
-                            catch (const std::ofstream::failure& e)
-                                {
-                                    LOG(WARNING) << "Problem opening output XML file";
-                                }
-                            catch (const std::exception& e)
-                                {
-                                    LOG(WARNING) << e.what();
-                                }
-                        }
-                    else
-                        {
-                            LOG(INFO) << "Failed to save GPS CNAV UTC model parameters, not valid data";
-                        }
-
-                    // save GLONASS GNAV ephemeris to XML file
-                    file_name = d_xml_base_path + "glo_gnav_ephemeris.xml";
-                    if (d_internal_pvt_solver->glonass_gnav_ephemeris_map.empty() == false)
-                        {
-                            std::ofstream ofs;
-                            try
-                                {
-                                    ofs.open(file_name.c_str(), std::ofstream::trunc | std::ofstream::out);
-                                    boost::archive::xml_oarchive xml(ofs);
-                                    xml << boost::serialization::make_nvp("GNSS-SDR_gnav_ephemeris_map", d_internal_pvt_solver->glonass_gnav_ephemeris_map);
-                                    LOG(INFO) << "Saved GLONASS GNAV ephemeris map data";
-                                }
-                            catch (const boost::archive::archive_exception& e)
-                                {
-                                    LOG(WARNING) << e.what();
-                                }
-                            catch (const std::ofstream::failure& e)
-                                {
-                                    LOG(WARNING) << "Problem opening output XML file";
-                                }
-                            catch (const std::exception& e)
-                                {
-                                    LOG(WARNING) << e.what();
-                                }
-                        }
-                    else
-                        {
-                            LOG(INFO) << "Failed to save GLONASS GNAV ephemeris, map is empty";
-                        }
-
-                    // save GLONASS UTC model parameters to XML file
-                    file_name = d_xml_base_path + "glo_utc_model.xml";
-                    if (d_internal_pvt_solver->glonass_gnav_utc_model.valid)
-                        {
-                            std::ofstream ofs;
-                            try
-                                {
-                                    ofs.open(file_name.c_str(), std::ofstream::trunc | std::ofstream::out);
-                                    boost::archive::xml_oarchive xml(ofs);
-                                    xml << boost::serialization::make_nvp("GNSS-SDR_gnav_utc_model", d_internal_pvt_solver->glonass_gnav_utc_model);
-                                    LOG(INFO) << "Saved GLONASS UTC model parameters";
-                                }
-                            catch (const boost::archive::archive_exception& e)
-                                {
-                                    LOG(WARNING) << e.what();
-                                }
-                            catch (const std::ofstream::failure& e)
-                                {
-                                    LOG(WARNING) << "Problem opening output XML file";
-                                }
-                            catch (const std::exception& e)
-                                {
-                                    LOG(WARNING) << e.what();
-                                }
-                        }
-                    else
-                        {
-                            LOG(INFO) << "Failed to save GLONASS GNAV ephemeris, not valid data";
-                        }
-
-                    // save BeiDou DNAV ephemeris to XML file
-                    file_name = d_xml_base_path + "bds_dnav_ephemeris.xml";
-                    if (d_internal_pvt_solver->beidou_dnav_ephemeris_map.empty() == false)
-                        {
-                            std::ofstream ofs;
-                            try
-                                {
-                                    ofs.open(file_name.c_str(), std::ofstream::trunc | std::ofstream::out);
-                                    boost::archive::xml_oarchive xml(ofs);
-                                    xml << boost::serialization::make_nvp("GNSS-SDR_bds_dnav_ephemeris_map", d_internal_pvt_solver->beidou_dnav_ephemeris_map);
-                                    LOG(INFO) << "Saved BeiDou DNAV Ephemeris map data";
-                                }
-                            catch (const boost::archive::archive_exception& e)
-                                {
-                                    LOG(WARNING) << e.what();
-                                }
-                            catch (const std::ofstream::failure& e)
-                                {
-                                    LOG(WARNING) << "Problem opening output XML file";
-                                }
-                            catch (const std::exception& e)
-                                {
-                                    LOG(WARNING) << e.what();
-                                }
-                        }
-                    else
-                        {
-                            LOG(INFO) << "Failed to save BeiDou DNAV Ephemeris, map is empty";
-                        }
-
-                    // Save BeiDou DNAV iono parameters
-                    file_name = d_xml_base_path + "bds_dnav_iono.xml";
-                    if (d_internal_pvt_solver->beidou_dnav_iono.valid)
-                        {
-                            std::ofstream ofs;
-                            try
-                                {
-                                    ofs.open(file_name.c_str(), std::ofstream::trunc | std::ofstream::out);
-                                    boost::archive::xml_oarchive xml(ofs);
-                                    xml << boost::serialization::make_nvp("GNSS-SDR_bds_dnav_iono_model", d_internal_pvt_solver->beidou_dnav_iono);
-                                    LOG(INFO) << "Saved BeiDou DNAV ionospheric model parameters";
-                                }
-                            catch (const boost::archive::archive_exception& e)
-                                {
-                                    LOG(WARNING) << e.what();
-                                }
-                            catch (const std::ofstream::failure& e)
-                                {
-                                    LOG(WARNING) << "Problem opening output XML file";
-                                }
-                            catch (const std::exception& e)
-                                {
-                                    LOG(WARNING) << e.what();
-                                }
-                        }
-                    else
-                        {
-                            LOG(INFO) << "Failed to save BeiDou DNAV ionospheric model parameters, not valid data";
-                        }
-
-                    // save BeiDou DNAV almanac to XML file
-                    file_name = d_xml_base_path + "bds_dnav_almanac.xml";
-                    if (d_internal_pvt_solver->beidou_dnav_almanac_map.empty() == false)
-                        {
-                            std::ofstream ofs;
-                            try
-                                {
-                                    ofs.open(file_name.c_str(), std::ofstream::trunc | std::ofstream::out);
-                                    boost::archive::xml_oarchive xml(ofs);
-                                    xml << boost::serialization::make_nvp("GNSS-SDR_bds_dnav_almanac_map", d_internal_pvt_solver->beidou_dnav_almanac_map);
-                                    LOG(INFO) << "Saved BeiDou DNAV almanac map data";
-                                }
-                            catch (const boost::archive::archive_exception& e)
-                                {
-                                    LOG(WARNING) << e.what();
-                                }
-                            catch (const std::ofstream::failure& e)
-                                {
-                                    LOG(WARNING) << "Problem opening output XML file";
-                                }
-                            catch (const std::exception& e)
-                                {
-                                    LOG(WARNING) << e.what();
-                                }
-                        }
-                    else
-                        {
-                            LOG(INFO) << "Failed to save BeiDou DNAV almanac, map is empty";
-                        }
-
-                    // Save BeiDou UTC model parameters
-                    file_name = d_xml_base_path + "bds_dnav_utc_model.xml";
-                    if (d_internal_pvt_solver->beidou_dnav_utc_model.valid)
-                        {
-                            std::ofstream ofs;
-                            try
-                                {
-                                    ofs.open(file_name.c_str(), std::ofstream::trunc | std::ofstream::out);
-                                    boost::archive::xml_oarchive xml(ofs);
-                                    xml << boost::serialization::make_nvp("GNSS-SDR_bds_dnav_utc_model", d_internal_pvt_solver->beidou_dnav_utc_model);
-                                    LOG(INFO) << "Saved BeiDou DNAV UTC model parameters";
-                                }
-                            catch (const boost::archive::archive_exception& e)
-                                {
-                                    LOG(WARNING) << e.what();
-                                }
-                            catch (const std::ofstream::failure& e)
-                                {
-                                    LOG(WARNING) << "Problem opening output XML file";
-                                }
-                            catch (const std::exception& e)
-                                {
-                                    LOG(WARNING) << e.what();
-                                }
-                        }
-                    else
-                        {
-                            LOG(INFO) << "Failed to save BeiDou DNAV UTC model parameters, not valid data";
-                        }
-                }
-
-            if (d_log_timetag_file.is_open())
-                {
-                    try
-                        {
-                            d_log_timetag_file.close();
-                        }
-                    catch (const std::exception& e)
-                        {
-                            LOG(WARNING) << "Problem closing Log PVT timetag metadata file: " << e.what();
-                        }
-                }
-        }
-    catch (std::length_error& e)
-        {
-            LOG(WARNING) << e.what();
-        }
-}
-
-
-void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
-{
-    try
-        {
-            const size_t msg_type_hash_code = pmt::any_ref(msg).type().hash_code();
-            // ************************* GPS telemetry *************************
-            if (msg_type_hash_code == d_gps_ephemeris_sptr_type_hash_code)
-                {
-                    // ### GPS EPHEMERIS ###
-                    const auto gps_eph = wht::any_cast<std::shared_ptr<Gps_Ephemeris>>(pmt::any_ref(msg));
-                    DLOG(INFO) << "Ephemeris record has arrived from SAT ID "
-                               << gps_eph->PRN << " (Block "
-                               << gps_eph->satelliteBlock[gps_eph->PRN] << ")"
-                               << "inserted with Toe=" << gps_eph->toe << " and GPS Week="
-                               << gps_eph->WN;
-
-                    // todo: Send only new sets of ephemeris (new TOE), not sent to the client
-                    // send the new eph to the eph monitor (if enabled)
-                    if (d_flag_monitor_ephemeris_enabled)
-                        {
-                            d_eph_udp_sink_ptr->write_gps_ephemeris(gps_eph);
-                        }
-                    // update/insert new ephemeris record to the global ephemeris map
-                    if (d_rinex_output_enabled && d_rp->is_rinex_header_written())  // The header is already written, we can now log the navigation message data
-                        {
-                            bool new_annotation = false;
-                            if (d_internal_pvt_solver->gps_ephemeris_map.find(gps_eph->PRN) == d_internal_pvt_solver->gps_ephemeris_map.cend())
-                                {
-                                    new_annotation = true;
-                                }
-                            else
-                                {
-                                    if (d_internal_pvt_solver->gps_ephemeris_map[gps_eph->PRN].toe != gps_eph->toe)
-                                        {
-                                            new_annotation = true;
-                                        }
-                                }
-                            if (new_annotation == true)
-                                {
-                                    // New record!
-                                    std::map<int32_t, Gps_Ephemeris> new_eph;
-                                    new_eph[gps_eph->PRN] = *gps_eph;
-                                    d_rp->log_rinex_nav_gps_nav(d_type_of_rx, new_eph);
-                                }
-                        }
-                    d_internal_pvt_solver->gps_ephemeris_map[gps_eph->PRN] = *gps_eph;
-                    if (d_enable_rx_clock_correction == true)
-                        {
-                            d_user_pvt_solver->gps_ephemeris_map[gps_eph->PRN] = *gps_eph;
-                        }
-                    if (gps_eph->SV_health != 0)
-                        {
-                            std::cout << TEXT_RED << "Satellite " << Gnss_Satellite(std::string("GPS"), gps_eph->PRN)
-                                      << " is not healthy, not used for navigation" << TEXT_RESET << '\n';
-                        }
-                }
-            else if (msg_type_hash_code == d_gps_iono_sptr_type_hash_code)
-                {
-                    // ### GPS IONO ###
-                    const auto gps_iono = wht::any_cast<std::shared_ptr<Gps_Iono>>(pmt::any_ref(msg));
-                    d_internal_pvt_solver->gps_iono = *gps_iono;
-                    if (d_enable_rx_clock_correction == true)
-                        {
-                            d_user_pvt_solver->gps_iono = *gps_iono;
-                        }
-                    DLOG(INFO) << "New IONO record has arrived ";
-                }
-            else if (msg_type_hash_code == d_gps_utc_model_sptr_type_hash_code)
-                {
-                    // ### GPS UTC MODEL ###
-                    const auto gps_utc_model = wht::any_cast<std::shared_ptr<Gps_Utc_Model>>(pmt::any_ref(msg));
-                    d_internal_pvt_solver->gps_utc_model = *gps_utc_model;
-                    if (d_enable_rx_clock_correction == true)
-                        {
-                            d_user_pvt_solver->gps_utc_model = *gps_utc_model;
-                        }
-                    DLOG(INFO) << "New UTC record has arrived ";
-                }
-            else if (msg_type_hash_code == d_gps_cnav_ephemeris_sptr_type_hash_code)
-                {
-                    // ### GPS CNAV message ###
-                    const auto gps_cnav_ephemeris = wht::any_cast<std::shared_ptr<Gps_CNAV_Ephemeris>>(pmt::any_ref(msg));
-                    // update/insert new ephemeris record to the global ephemeris map
-                    if (d_rinex_output_enabled && d_rp->is_rinex_header_written())  // The header is already written, we can now log the navigation message data
-                        {
-                            bool new_annotation = false;
-                            if (d_internal_pvt_solver->gps_cnav_ephemeris_map.find(gps_cnav_ephemeris->PRN) == d_internal_pvt_solver->gps_cnav_ephemeris_map.cend())
-                                {
-                                    new_annotation = true;
-                                }
-                            else
-                                {
-                                    if (d_internal_pvt_solver->gps_cnav_ephemeris_map[gps_cnav_ephemeris->PRN].toe1 != gps_cnav_ephemeris->toe1)
-                                        {
-                                            new_annotation = true;
-                                        }
-                                }
-                            if (new_annotation == true)
-                                {
-                                    // New record!
-                                    std::map<int32_t, Gps_CNAV_Ephemeris> new_cnav_eph;
-                                    new_cnav_eph[gps_cnav_ephemeris->PRN] = *gps_cnav_ephemeris;
-                                    d_rp->log_rinex_nav_gps_cnav(d_type_of_rx, new_cnav_eph);
-                                }
-                        }
-                    d_internal_pvt_solver->gps_cnav_ephemeris_map[gps_cnav_ephemeris->PRN] = *gps_cnav_ephemeris;
-                    if (d_enable_rx_clock_correction == true)
-                        {
-                            d_user_pvt_solver->gps_cnav_ephemeris_map[gps_cnav_ephemeris->PRN] = *gps_cnav_ephemeris;
-                        }
-                    if (gps_cnav_ephemeris->signal_health != 0)
-                        {
-                            std::cout << "Satellite " << Gnss_Satellite(std::string("GPS"), gps_cnav_ephemeris->PRN)
-                                      << " does not report a healthy status in the CNAV message,"
-                                      << " use PVT solutions at your own risk.\n";
-                        }
-                    DLOG(INFO) << "New GPS CNAV ephemeris record has arrived ";
-                }
-            else if (msg_type_hash_code == d_gps_cnav_iono_sptr_type_hash_code)
-                {
-                    // ### GPS CNAV IONO ###
-                    const auto gps_cnav_iono = wht::any_cast<std::shared_ptr<Gps_CNAV_Iono>>(pmt::any_ref(msg));
-                    d_internal_pvt_solver->gps_cnav_iono = *gps_cnav_iono;
-                    if (d_enable_rx_clock_correction == true)
-                        {
-                            d_user_pvt_solver->gps_cnav_iono = *gps_cnav_iono;
-                        }
-                    DLOG(INFO) << "New CNAV IONO record has arrived ";
-                }
-            else if (msg_type_hash_code == d_gps_cnav_utc_model_sptr_type_hash_code)
-                {
-                    // ### GPS CNAV UTC MODEL ###
-                    const auto gps_cnav_utc_model = wht::any_cast<std::shared_ptr<Gps_CNAV_Utc_Model>>(pmt::any_ref(msg));
-                    d_internal_pvt_solver->gps_cnav_utc_model = *gps_cnav_utc_model;
-                    {
-                        d_user_pvt_solver->gps_cnav_utc_model = *gps_cnav_utc_model;
-                    }
-                    DLOG(INFO) << "New CNAV UTC record has arrived ";
-                }
-
-            else if (msg_type_hash_code == d_gps_almanac_sptr_type_hash_code)
-                {
-                    // ### GPS ALMANAC ###
-                    const auto gps_almanac = wht::any_cast<std::shared_ptr<Gps_Almanac>>(pmt::any_ref(msg));
-                    d_internal_pvt_solver->gps_almanac_map[gps_almanac->PRN] = *gps_almanac;
-                    if (d_enable_rx_clock_correction == true)
-                        {
-                            d_user_pvt_solver->gps_almanac_map[gps_almanac->PRN] = *gps_almanac;
-                        }
-                    DLOG(INFO) << "New GPS almanac record has arrived ";
-                }
-
-            // *********************** Galileo telemetry ***********************
-            else if (msg_type_hash_code == d_galileo_ephemeris_sptr_type_hash_code)
-                {
-                    // ### Galileo EPHEMERIS ###
-                    const auto galileo_eph = wht::any_cast<std::shared_ptr<Galileo_Ephemeris>>(pmt::any_ref(msg));
-                    // insert new ephemeris record
-                    DLOG(INFO) << "Galileo New Ephemeris record inserted in global map with TOW =" << galileo_eph->tow
-                               << ", GALILEO Week Number =" << galileo_eph->WN
-                               << " and Ephemeris IOD = " << galileo_eph->IOD_ephemeris;
-                    // todo: Send only new sets of ephemeris (new TOE), not sent to the client
-                    // send the new eph to the eph monitor (if enabled)
-                    if (d_flag_monitor_ephemeris_enabled)
-                        {
-                            d_eph_udp_sink_ptr->write_galileo_ephemeris(galileo_eph);
-                        }
-                    // update/insert new ephemeris record to the global ephemeris map
-                    if (d_rinex_output_enabled && d_rp->is_rinex_header_written())  // The header is already written, we can now log the navigation message data
-                        {
-                            bool new_annotation = false;
-                            if (d_internal_pvt_solver->galileo_ephemeris_map.find(galileo_eph->PRN) == d_internal_pvt_solver->galileo_ephemeris_map.cend())
-                                {
-                                    new_annotation = true;
-                                }
-                            else
-                                {
-                                    if (d_internal_pvt_solver->galileo_ephemeris_map[galileo_eph->PRN].toe != galileo_eph->toe)
-                                        {
-                                            new_annotation = true;
-                                        }
-                                }
-                            if (new_annotation == true)
-                                {
-                                    // New record!
-                                    std::map<int32_t, Galileo_Ephemeris> new_gal_eph;
-                                    new_gal_eph[galileo_eph->PRN] = *galileo_eph;
-                                    d_rp->log_rinex_nav_gal_nav(d_type_of_rx, new_gal_eph);
-                                }
-                        }
-                    d_internal_pvt_solver->galileo_ephemeris_map[galileo_eph->PRN] = *galileo_eph;
-                    if (d_enable_rx_clock_correction == true)
-                        {
-                            d_user_pvt_solver->galileo_ephemeris_map[galileo_eph->PRN] = *galileo_eph;
-                        }
-                    if (((galileo_eph->E1B_HS != 0) || (galileo_eph->E1B_DVS == true)) ||
-                        ((galileo_eph->E5a_HS != 0) || (galileo_eph->E5a_DVS == true)) ||
-                        ((galileo_eph->E5b_HS != 0) || (galileo_eph->E5b_DVS == true)))
-                        {
-                            std::cout << TEXT_RED << "Satellite " << Gnss_Satellite(std::string("Galileo"), galileo_eph->PRN)
-                                      << " is not healthy, not used for navigation" << TEXT_RESET << '\n';
-                        }
-                }
-            else if (msg_type_hash_code == d_galileo_iono_sptr_type_hash_code)
-                {
-                    // ### Galileo IONO ###
-                    const auto galileo_iono = wht::any_cast<std::shared_ptr<Galileo_Iono>>(pmt::any_ref(msg));
-                    d_internal_pvt_solver->galileo_iono = *galileo_iono;
-                    if (d_enable_rx_clock_correction == true)
-                        {
-                            d_user_pvt_solver->galileo_iono = *galileo_iono;
-                        }
-                    DLOG(INFO) << "New IONO record has arrived ";
-                }
-            else if (msg_type_hash_code == d_galileo_utc_model_sptr_type_hash_code)
-                {
-                    // ### Galileo UTC MODEL ###
-                    const auto galileo_utc_model = wht::any_cast<std::shared_ptr<Galileo_Utc_Model>>(pmt::any_ref(msg));
-                    d_internal_pvt_solver->galileo_utc_model = *galileo_utc_model;
-                    if (d_enable_rx_clock_correction == true)
-                        {
-                            d_user_pvt_solver->galileo_utc_model = *galileo_utc_model;
-                        }
-                    DLOG(INFO) << "New UTC record has arrived ";
-                }
-            else if (msg_type_hash_code == d_galileo_almanac_helper_sptr_type_hash_code)
-                {
-                    // ### Galileo Almanac ###
-                    const auto galileo_almanac_helper = wht::any_cast<std::shared_ptr<Galileo_Almanac_Helper>>(pmt::any_ref(msg));
-                    const Galileo_Almanac sv1 = galileo_almanac_helper->get_almanac(1);
-                    const Galileo_Almanac sv2 = galileo_almanac_helper->get_almanac(2);
-                    const Galileo_Almanac sv3 = galileo_almanac_helper->get_almanac(3);
-
-                    if (sv1.PRN != 0)
-                        {
-                            d_internal_pvt_solver->galileo_almanac_map[sv1.PRN] = sv1;
-                            if (d_enable_rx_clock_correction == true)
-                                {
-                                    d_user_pvt_solver->galileo_almanac_map[sv1.PRN] = sv1;
-                                }
-                        }
-                    if (sv2.PRN != 0)
-                        {
-                            d_internal_pvt_solver->galileo_almanac_map[sv2.PRN] = sv2;
-                            if (d_enable_rx_clock_correction == true)
-                                {
-                                    d_user_pvt_solver->galileo_almanac_map[sv2.PRN] = sv2;
-                                }
-                        }
-                    if (sv3.PRN != 0)
-                        {
-                            d_internal_pvt_solver->galileo_almanac_map[sv3.PRN] = sv3;
-                            if (d_enable_rx_clock_correction == true)
-                                {
-                                    d_user_pvt_solver->galileo_almanac_map[sv3.PRN] = sv3;
-                                }
-                        }
-                    DLOG(INFO) << "New Galileo Almanac data have arrived ";
-                }
-            else if (msg_type_hash_code == d_galileo_almanac_sptr_type_hash_code)
-                {
-                    // ### Galileo Almanac ###
-                    const auto galileo_alm = wht::any_cast<std::shared_ptr<Galileo_Almanac>>(pmt::any_ref(msg));
-                    // update/insert new almanac record to the global almanac map
-                    d_internal_pvt_solver->galileo_almanac_map[galileo_alm->PRN] = *galileo_alm;
-                    if (d_enable_rx_clock_correction == true)
-                        {
-                            d_user_pvt_solver->galileo_almanac_map[galileo_alm->PRN] = *galileo_alm;
-                        }
-                }
-
-            // **************** GLONASS GNAV Telemetry *************************
-            else if (msg_type_hash_code == d_glonass_gnav_ephemeris_sptr_type_hash_code)
-                {
-                    // ### GLONASS GNAV EPHEMERIS ###
-                    const auto glonass_gnav_eph = wht::any_cast<std::shared_ptr<Glonass_Gnav_Ephemeris>>(pmt::any_ref(msg));
-                    // TODO Add GLONASS with gps week number and tow,
-                    // insert new ephemeris record
-                    DLOG(INFO) << "GLONASS GNAV New Ephemeris record inserted in global map with TOW =" << glonass_gnav_eph->d_TOW
-                               << ", Week Number =" << glonass_gnav_eph->d_WN
-                               << " and Ephemeris IOD in UTC = " << glonass_gnav_eph->compute_GLONASS_time(glonass_gnav_eph->d_t_b)
-                               << " from SV = " << glonass_gnav_eph->i_satellite_slot_number;
-                    // update/insert new ephemeris record to the global ephemeris map
-                    if (d_rinex_output_enabled && d_rp->is_rinex_header_written())  // The header is already written, we can now log the navigation message data
-                        {
-                            bool new_annotation = false;
-                            if (d_internal_pvt_solver->glonass_gnav_ephemeris_map.find(glonass_gnav_eph->PRN) == d_internal_pvt_solver->glonass_gnav_ephemeris_map.cend())
-                                {
-                                    new_annotation = true;
-                                }
-                            else
-                                {
-                                    if (d_internal_pvt_solver->glonass_gnav_ephemeris_map[glonass_gnav_eph->PRN].d_t_b != glonass_gnav_eph->d_t_b)
-                                        {
-                                            new_annotation = true;
-                                        }
-                                }
-                            if (new_annotation == true)
-                                {
-                                    // New record!
-                                    std::map<int32_t, Glonass_Gnav_Ephemeris> new_glo_eph;
-                                    new_glo_eph[glonass_gnav_eph->PRN] = *glonass_gnav_eph;
-                                    d_rp->log_rinex_nav_glo_gnav(d_type_of_rx, new_glo_eph);
-                                }
-                        }
-                    d_internal_pvt_solver->glonass_gnav_ephemeris_map[glonass_gnav_eph->PRN] = *glonass_gnav_eph;
-                    if (d_enable_rx_clock_correction == true)
-                        {
-                            d_user_pvt_solver->glonass_gnav_ephemeris_map[glonass_gnav_eph->PRN] = *glonass_gnav_eph;
-                        }
-                }
-            else if (msg_type_hash_code == d_glonass_gnav_utc_model_sptr_type_hash_code)
-                {
-                    // ### GLONASS GNAV UTC MODEL ###
-                    const auto glonass_gnav_utc_model = wht::any_cast<std::shared_ptr<Glonass_Gnav_Utc_Model>>(pmt::any_ref(msg));
-                    d_internal_pvt_solver->glonass_gnav_utc_model = *glonass_gnav_utc_model;
-                    if (d_enable_rx_clock_correction == true)
-                        {
-                            d_user_pvt_solver->glonass_gnav_utc_model = *glonass_gnav_utc_model;
-                        }
-                    DLOG(INFO) << "New GLONASS GNAV UTC record has arrived ";
-                }
-            else if (msg_type_hash_code == d_glonass_gnav_almanac_sptr_type_hash_code)
-                {
-                    // ### GLONASS GNAV Almanac ###
-                    const auto glonass_gnav_almanac = wht::any_cast<std::shared_ptr<Glonass_Gnav_Almanac>>(pmt::any_ref(msg));
-                    d_internal_pvt_solver->glonass_gnav_almanac = *glonass_gnav_almanac;
-                    if (d_enable_rx_clock_correction == true)
-                        {
-                            d_user_pvt_solver->glonass_gnav_almanac = *glonass_gnav_almanac;
-                        }
-                    DLOG(INFO) << "New GLONASS GNAV Almanac has arrived "
-                               << ", GLONASS GNAV Slot Number =" << glonass_gnav_almanac->d_n_A;
-                }
-
-            // *********************** BeiDou telemetry ************************
-            else if (msg_type_hash_code == d_beidou_dnav_ephemeris_sptr_type_hash_code)
-                {
-                    // ### Beidou EPHEMERIS ###
-                    const auto bds_dnav_eph = wht::any_cast<std::shared_ptr<Beidou_Dnav_Ephemeris>>(pmt::any_ref(msg));
-                    DLOG(INFO) << "Ephemeris record has arrived from SAT ID "
-                               << bds_dnav_eph->PRN << " (Block "
-                               << bds_dnav_eph->satelliteBlock[bds_dnav_eph->PRN] << ")"
-                               << "inserted with Toe=" << bds_dnav_eph->toe << " and BDS Week="
-                               << bds_dnav_eph->WN;
-                    // update/insert new ephemeris record to the global ephemeris map
-                    if (d_rinex_output_enabled && d_rp->is_rinex_header_written())  // The header is already written, we can now log the navigation message data
-                        {
-                            bool new_annotation = false;
-                            if (d_internal_pvt_solver->beidou_dnav_ephemeris_map.find(bds_dnav_eph->PRN) == d_internal_pvt_solver->beidou_dnav_ephemeris_map.cend())
-                                {
-                                    new_annotation = true;
-                                }
-                            else
-                                {
-                                    if (d_internal_pvt_solver->beidou_dnav_ephemeris_map[bds_dnav_eph->PRN].toc != bds_dnav_eph->toc)
-                                        {
-                                            new_annotation = true;
-                                        }
-                                }
-                            if (new_annotation == true)
-                                {
-                                    // New record!
-                                    std::map<int32_t, Beidou_Dnav_Ephemeris> new_bds_eph;
-                                    new_bds_eph[bds_dnav_eph->PRN] = *bds_dnav_eph;
-                                    d_rp->log_rinex_nav_bds_dnav(d_type_of_rx, new_bds_eph);
-                                }
-                        }
-                    d_internal_pvt_solver->beidou_dnav_ephemeris_map[bds_dnav_eph->PRN] = *bds_dnav_eph;
-                    if (d_enable_rx_clock_correction == true)
-                        {
-                            d_user_pvt_solver->beidou_dnav_ephemeris_map[bds_dnav_eph->PRN] = *bds_dnav_eph;
-                        }
-                    if (bds_dnav_eph->SV_health != 0)
-                        {
-                            std::cout << TEXT_RED << "Satellite " << Gnss_Satellite(std::string("Beidou"), bds_dnav_eph->PRN)
-                                      << " is not healthy, not used for navigation" << TEXT_RESET << '\n';
-                        }
-                }
-            else if (msg_type_hash_code == d_beidou_dnav_iono_sptr_type_hash_code)
+        {
+            if (d_nav_data_store)
                 {
-                    // ### BeiDou IONO ###
-                    const auto bds_dnav_iono = wht::any_cast<std::shared_ptr<Beidou_Dnav_Iono>>(pmt::any_ref(msg));
-                    d_internal_pvt_solver->beidou_dnav_iono = *bds_dnav_iono;
-                    if (d_enable_rx_clock_correction == true)
-                        {
-                            d_user_pvt_solver->beidou_dnav_iono = *bds_dnav_iono;
-                        }
-                    DLOG(INFO) << "New BeiDou DNAV IONO record has arrived ";
+                    // all the valid navigation data, and then the pending files are written
+                    store_nav_data(~0U);
+                    d_nav_data_store.reset();
                 }
-            else if (msg_type_hash_code == d_beidou_dnav_utc_model_sptr_type_hash_code)
+
+            if (d_log_timetag_file.is_open())
                 {
-                    // ### BeiDou UTC MODEL ###
-                    const auto bds_dnav_utc_model = wht::any_cast<std::shared_ptr<Beidou_Dnav_Utc_Model>>(pmt::any_ref(msg));
-                    d_internal_pvt_solver->beidou_dnav_utc_model = *bds_dnav_utc_model;
-                    if (d_enable_rx_clock_correction == true)
+                    try
                         {
-                            d_user_pvt_solver->beidou_dnav_utc_model = *bds_dnav_utc_model;
+                            d_log_timetag_file.close();
                         }
-                    DLOG(INFO) << "New BeiDou DNAV UTC record has arrived ";
-                }
-            else if (msg_type_hash_code == d_beidou_dnav_almanac_sptr_type_hash_code)
-                {
-                    // ### BeiDou ALMANAC ###
-                    const auto bds_dnav_almanac = wht::any_cast<std::shared_ptr<Beidou_Dnav_Almanac>>(pmt::any_ref(msg));
-                    d_internal_pvt_solver->beidou_dnav_almanac_map[bds_dnav_almanac->PRN] = *bds_dnav_almanac;
-                    if (d_enable_rx_clock_correction == true)
+                    catch (const std::exception& e)
                         {
-                            d_user_pvt_solver->beidou_dnav_almanac_map[bds_dnav_almanac->PRN] = *bds_dnav_almanac;
+                            LOG(WARNING) << "Problem closing Log PVT timetag metadata file: " << e.what();
                         }
-                    DLOG(INFO) << "New BeiDou DNAV almanac record has arrived ";
-                }
-            else
-                {
-                    LOG(WARNING) << "msg_handler_telemetry unknown object type!";
                 }
         }
-    catch (const wht::bad_any_cast& e)
+    catch (std::length_error& e)
+        {
+            LOG(WARNING) << e.what();
+        }
+}
+
+
+void rtklib_pvt_gs::handle_nav_product(const Gnss_Nav_Product& product)
+{
+    switch (product.type())
+        {
+        // ************************* GPS telemetry *************************
+        case NAV_GPS_EPHEMERIS:
+            {
+                // ### GPS EPHEMERIS ###
+                const auto gps_eph = product.get<Gps_Ephemeris>();
+                DLOG(INFO) << "Ephemeris record has arrived from SAT ID "
+                           << gps_eph->PRN << " (Block "
+                           << gps_eph->satelliteBlock[gps_eph->PRN] << ")"
+                           << "inserted with Toe=" << gps_eph->toe << " and GPS Week="
+                           << gps_eph->WN;
+
+                // todo: Send only new sets of ephemeris (new TOE), not sent to the client
+                // send the new eph to the eph monitor (if enabled)
+                if (d_flag_monitor_ephemeris_enabled)
+                    {
+                        d_eph_udp_sink_ptr->write_gps_ephemeris(gps_eph);
+                    }
+                // update/insert new ephemeris record to the global ephemeris map
+                if (d_rinex_output_enabled)
+                    {
+                        bool new_annotation = false;
+                        if (d_internal_pvt_solver->gps_ephemeris_map.find(gps_eph->PRN) == d_internal_pvt_solver->gps_ephemeris_map.cend())
+                            {
+                                new_annotation = true;
+                            }
+                        else
+                            {
+                                if (d_internal_pvt_solver->gps_ephemeris_map[gps_eph->PRN].toe != gps_eph->toe)
+                                    {
+                                        new_annotation = true;
+                                    }
+                            }
+                        if (new_annotation == true)
+                            {
+                                // New record!
+                                std::map<int32_t, Gps_Ephemeris> new_eph;
+                                new_eph[gps_eph->PRN] = *gps_eph;
+                                d_output_dispatcher->push([this, new_eph]() {
+                                    if (d_rp->is_rinex_header_written())  // The header is already written, we can now log the navigation message data
+                                        {
+                                            d_rp->log_rinex_nav_gps_nav(d_type_of_rx, new_eph);
+                                        }
+                                });
+                            }
+                    }
+                d_internal_pvt_solver->gps_ephemeris_map[gps_eph->PRN] = *gps_eph;
+                if (gps_eph->SV_health != 0)
+                    {
+                        std::cout << TEXT_RED << "Satellite " << Gnss_Satellite(std::string("GPS"), gps_eph->PRN)
+                                  << " is not healthy, not used for navigation" << TEXT_RESET << '\n';
+                    }
+            }
+            break;
+        case NAV_GPS_IONO:
+            {
+                // ### GPS IONO ###
+                const auto gps_iono = product.get<Gps_Iono>();
+                d_internal_pvt_solver->gps_iono = *gps_iono;
+                DLOG(INFO) << "New IONO record has arrived ";
+            }
+            break;
+        case NAV_GPS_UTC_MODEL:
+            {
+                // ### GPS UTC MODEL ###
+                const auto gps_utc_model = product.get<Gps_Utc_Model>();
+                d_internal_pvt_solver->gps_utc_model = *gps_utc_model;
+                DLOG(INFO) << "New UTC record has arrived ";
+            }
+            break;
+        case NAV_GPS_CNAV_EPHEMERIS:
+            {
+                // ### GPS CNAV message ###
+                const auto gps_cnav_ephemeris = product.get<Gps_CNAV_Ephemeris>();
+                // update/insert new ephemeris record to the global ephemeris map
+                if (d_rinex_output_enabled)
+                    {
+                        bool new_annotation = false;
+                        if (d_internal_pvt_solver->gps_cnav_ephemeris_map.find(gps_cnav_ephemeris->PRN) == d_internal_pvt_solver->gps_cnav_ephemeris_map.cend())
+                            {
+                                new_annotation = true;
+                            }
+                        else
+                            {
+                                if (d_internal_pvt_solver->gps_cnav_ephemeris_map[gps_cnav_ephemeris->PRN].toe1 != gps_cnav_ephemeris->toe1)
+                                    {
+                                        new_annotation = true;
+                                    }
+                            }
+                        if (new_annotation == true)
+                            {
+                                // New record!
+                                std::map<int32_t, Gps_CNAV_Ephemeris> new_cnav_eph;
+                                new_cnav_eph[gps_cnav_ephemeris->PRN] = *gps_cnav_ephemeris;
+                                d_output_dispatcher->push([this, new_cnav_eph]() {
+                                    if (d_rp->is_rinex_header_written())  // The header is already written, we can now log the navigation message data
+                                        {
+                                            d_rp->log_rinex_nav_gps_cnav(d_type_of_rx, new_cnav_eph);
+                                        }
+                                });
+                            }
+                    }
+                d_internal_pvt_solver->gps_cnav_ephemeris_map[gps_cnav_ephemeris->PRN] = *gps_cnav_ephemeris;
+                if (gps_cnav_ephemeris->signal_health != 0)
+                    {
+                        std::cout << "Satellite " << Gnss_Satellite(std::string("GPS"), gps_cnav_ephemeris->PRN)
+                                  << " does not report a healthy status in the CNAV message,"
+                                  << " use PVT solutions at your own risk.\n";
+                    }
+                DLOG(INFO) << "New GPS CNAV ephemeris record has arrived ";
+            }
+            break;
+        case NAV_GPS_CNAV_IONO:
+            {
+                // ### GPS CNAV IONO ###
+                const auto gps_cnav_iono = product.get<Gps_CNAV_Iono>();
+                d_internal_pvt_solver->gps_cnav_iono = *gps_cnav_iono;
+                DLOG(INFO) << "New CNAV IONO record has arrived ";
+            }
+            break;
+        case NAV_GPS_CNAV_UTC_MODEL:
+            {
+                // ### GPS CNAV UTC MODEL ###
+                const auto gps_cnav_utc_model = product.get<Gps_CNAV_Utc_Model>();
+                d_internal_pvt_solver->gps_cnav_utc_model = *gps_cnav_utc_model;
+                DLOG(INFO) << "New CNAV UTC record has arrived ";
+            }
+            break;
+
+        case NAV_GPS_ALMANAC:
+            {
+                // ### GPS ALMANAC ###
+                const auto gps_almanac = product.get<Gps_Almanac>();
+                d_internal_pvt_solver->gps_almanac_map[gps_almanac->PRN] = *gps_almanac;
+                DLOG(INFO) << "New GPS almanac record has arrived ";
+            }
+            break;
+
+        // *********************** Galileo telemetry ***********************
+        case NAV_GALILEO_EPHEMERIS:
+            {
+                // ### Galileo EPHEMERIS ###
+                const auto galileo_eph = product.get<Galileo_Ephemeris>();
+                const auto stored_eph = d_internal_pvt_solver->galileo_ephemeris_map.find(galileo_eph->PRN);
+                const bool have_stored_eph = stored_eph != d_internal_pvt_solver->galileo_ephemeris_map.cend();
+                if (galileo_eph->flag_reduced_ced)
+                    {
+                        // a reduced CED allows a first fix, but it never replaces a full ephemeris set
+                        if (have_stored_eph and !stored_eph->second.flag_reduced_ced)
+                            {
+                                break;
+                            }
+                        d_internal_pvt_solver->galileo_ephemeris_map[galileo_eph->PRN] = *galileo_eph;
+                        DLOG(INFO) << "Galileo reduced CED record inserted in global map for PRN " << galileo_eph->PRN
+                                   << " with TOW =" << galileo_eph->tow;
+                        break;
+                    }
+                if (have_stored_eph and stored_eph->second.flag_reduced_ced)
+                    {
+                        LOG(INFO) << "Galileo PRN " << galileo_eph->PRN << ": the reduced CED is replaced by the full ephemeris set";
+                    }
+                // insert new ephemeris record
+                DLOG(INFO) << "Galileo New Ephemeris record inserted in global map with TOW =" << galileo_eph->tow
+                           << ", GALILEO Week Number =" << galileo_eph->WN
+                           << " and Ephemeris IOD = " << galileo_eph->IOD_ephemeris;
+                // todo: Send only new sets of ephemeris (new TOE), not sent to the client
+                // send the new eph to the eph monitor (if enabled)
+                if (d_flag_monitor_ephemeris_enabled)
+                    {
+                        d_eph_udp_sink_ptr->write_galileo_ephemeris(galileo_eph);
+                    }
+                // update/insert new ephemeris record to the global ephemeris map
+                if (d_rinex_output_enabled)
+                    {
+                        bool new_annotation = false;
+                        if (d_internal_pvt_solver->galileo_ephemeris_map.find(galileo_eph->PRN) == d_internal_pvt_solver->galileo_ephemeris_map.cend())
+                            {
+                                new_annotation = true;
+                            }
+                        else
+                            {
+                                if (d_internal_pvt_solver->galileo_ephemeris_map[galileo_eph->PRN].toe != galileo_eph->toe)
+                                    {
+                                        new_annotation = true;
+                                    }
+                            }
+                        if (new_annotation == true)
+                            {
+                                // New record!
+                                std::map<int32_t, Galileo_Ephemeris> new_gal_eph;
+                                new_gal_eph[galileo_eph->PRN] = *galileo_eph;
+                                d_output_dispatcher->push([this, new_gal_eph]() {
+                                    if (d_rp->is_rinex_header_written())  // The header is already written, we can now log the navigation message data
+                                        {
+                                            d_rp->log_rinex_nav_gal_nav(d_type_of_rx, new_gal_eph);
+                                        }
+                                });
+                            }
+                    }
+                d_internal_pvt_solver->galileo_ephemeris_map[galileo_eph->PRN] = *galileo_eph;
+                if (((galileo_eph->E1B_HS != 0) || (galileo_eph->E1B_DVS == true)) ||
+                    ((galileo_eph->E5a_HS != 0) || (galileo_eph->E5a_DVS == true)) ||
+                    ((galileo_eph->E5b_HS != 0) || (galileo_eph->E5b_DVS == true)))
+                    {
+                        std::cout << TEXT_RED << "Satellite " << Gnss_Satellite(std::string("Galileo"), galileo_eph->PRN)
+                                  << " is not healthy, not used for navigation" << TEXT_RESET << '\n';
+                    }
+            }
+            break;
+        case NAV_GALILEO_IONO:
+            {
+                // ### Galileo IONO ###
+                const auto galileo_iono = product.get<Galileo_Iono>();
+                d_internal_pvt_solver->galileo_iono = *galileo_iono;
+                DLOG(INFO) << "New IONO record has arrived ";
+            }
+            break;
+        case NAV_GALILEO_UTC_MODEL:
+            {
+                // ### Galileo UTC MODEL ###
+                const auto galileo_utc_model = product.get<Galileo_Utc_Model>();
+                d_internal_pvt_solver->galileo_utc_model = *galileo_utc_model;
+                DLOG(INFO) << "New UTC record has arrived ";
+            }
+            break;
+        case NAV_GALILEO_ALMANAC_HELPER:
+            {
+                // ### Galileo Almanac ###
+                const auto galileo_almanac_helper = product.get<Galileo_Almanac_Helper>();
+                const Galileo_Almanac sv1 = galileo_almanac_helper->get_almanac(1);
+                const Galileo_Almanac sv2 = galileo_almanac_helper->get_almanac(2);
+                const Galileo_Almanac sv3 = galileo_almanac_helper->get_almanac(3);
+
+                if (sv1.PRN != 0)
+                    {
+                        d_internal_pvt_solver->galileo_almanac_map[sv1.PRN] = sv1;
+                    }
+                if (sv2.PRN != 0)
+                    {
+                        d_internal_pvt_solver->galileo_almanac_map[sv2.PRN] = sv2;
+                    }
+                if (sv3.PRN != 0)
+                    {
+                        d_internal_pvt_solver->galileo_almanac_map[sv3.PRN] = sv3;
+                    }
+                DLOG(INFO) << "New Galileo Almanac data have arrived ";
+            }
+            break;
+        case NAV_GALILEO_ALMANAC:
+            {
+                // ### Galileo Almanac ###
+                const auto galileo_alm = product.get<Galileo_Almanac>();
+                // update/insert new almanac record to the global almanac map
+                d_internal_pvt_solver->galileo_almanac_map[galileo_alm->PRN] = *galileo_alm;
+            }
+            break;
+
+        // **************** GLONASS GNAV Telemetry *************************
+        case NAV_GLONASS_GNAV_EPHEMERIS:
+            {
+                // ### GLONASS GNAV EPHEMERIS ###
+                const auto glonass_gnav_eph = product.get<Glonass_Gnav_Ephemeris>();
+                // TODO Add GLONASS with gps week number and tow,
+                // insert new ephemeris record
+                DLOG(INFO) << "GLONASS GNAV New Ephemeris record inserted in global map with TOW =" << glonass_gnav_eph->d_TOW
+                           << ", Week Number =" << glonass_gnav_eph->d_WN
+                           << " and Ephemeris IOD in UTC = " << glonass_gnav_eph->compute_GLONASS_time(glonass_gnav_eph->d_t_b)
+                           << " from SV = " << glonass_gnav_eph->i_satellite_slot_number;
+                // update/insert new ephemeris record to the global ephemeris map
+                if (d_rinex_output_enabled)
+                    {
+                        bool new_annotation = false;
+                        if (d_internal_pvt_solver->glonass_gnav_ephemeris_map.find(glonass_gnav_eph->PRN) == d_internal_pvt_solver->glonass_gnav_ephemeris_map.cend())
+                            {
+                                new_annotation = true;
+                            }
+                        else
+                            {
+                                if (d_internal_pvt_solver->glonass_gnav_ephemeris_map[glonass_gnav_eph->PRN].d_t_b != glonass_gnav_eph->d_t_b)
+                                    {
+                                        new_annotation = true;
+                                    }
+                            }
+                        if (new_annotation == true)
+                            {
+                                // New record!
+                                std::map<int32_t, Glonass_Gnav_Ephemeris> new_glo_eph;
+                                new_glo_eph[glonass_gnav_eph->PRN] = *glonass_gnav_eph;
+                                d_output_dispatcher->push([this, new_glo_eph]() {
+                                    if (d_rp->is_rinex_header_written())  // The header is already written, we can now log the navigation message data
+                                        {
+                                            d_rp->log_rinex_nav_glo_gnav(d_type_of_rx, new_glo_eph);
+                                        }
+                                });
+                            }
+                    }
+                d_internal_pvt_solver->glonass_gnav_ephemeris_map[glonass_gnav_eph->PRN] = *glonass_gnav_eph;
+            }
+            break;
+        case NAV_GLONASS_GNAV_UTC_MODEL:
+            {
+                // ### GLONASS GNAV UTC MODEL ###
+                const auto glonass_gnav_utc_model = product.get<Glonass_Gnav_Utc_Model>();
+                d_internal_pvt_solver->glonass_gnav_utc_model = *glonass_gnav_utc_model;
+                DLOG(INFO) << "New GLONASS GNAV UTC record has arrived ";
+            }
+            break;
+        case NAV_GLONASS_GNAV_ALMANAC:
+            {
+                // ### GLONASS GNAV Almanac ###
+                const auto glonass_gnav_almanac = product.get<Glonass_Gnav_Almanac>();
+                d_internal_pvt_solver->glonass_gnav_almanac = *glonass_gnav_almanac;
+                DLOG(INFO) << "New GLONASS GNAV Almanac has arrived "
+                           << ", GLONASS GNAV Slot Number =" << glonass_gnav_almanac->d_n_A;
+            }
+            break;
+
+        // *********************** BeiDou telemetry ************************
+        case NAV_BEIDOU_DNAV_EPHEMERIS:
+            {
+                // ### Beidou EPHEMERIS ###
+                const auto bds_dnav_eph = product.get<Beidou_Dnav_Ephemeris>();
+                DLOG(INFO) << "Ephemeris record has arrived from SAT ID "
+                           << bds_dnav_eph->PRN << " (Block "
+                           << bds_dnav_eph->satelliteBlock[bds_dnav_eph->PRN] << ")"
+                           << "inserted with Toe=" << bds_dnav_eph->toe << " and BDS Week="
+                           << bds_dnav_eph->WN;
+                // update/insert new ephemeris record to the global ephemeris map
+                if (d_rinex_output_enabled)
+                    {
+                        bool new_annotation = false;
+                        if (d_internal_pvt_solver->beidou_dnav_ephemeris_map.find(bds_dnav_eph->PRN) == d_internal_pvt_solver->beidou_dnav_ephemeris_map.cend())
+                            {
+                                new_annotation = true;
+                            }
+                        else
+                            {
+                                if (d_internal_pvt_solver->beidou_dnav_ephemeris_map[bds_dnav_eph->PRN].toc != bds_dnav_eph->toc)
+                                    {
+                                        new_annotation = true;
+                                    }
+                            }
+                        if (new_annotation == true)
+                            {
+                                // New record!
+                                std::map<int32_t, Beidou_Dnav_Ephemeris> new_bds_eph;
+                                new_bds_eph[bds_dnav_eph->PRN] = *bds_dnav_eph;
+                                d_output_dispatcher->push([this, new_bds_eph]() {
+                                    if (d_rp->is_rinex_header_written())  // The header is already written, we can now log the navigation message data
+                                        {
+                                            d_rp->log_rinex_nav_bds_dnav(d_type_of_rx, new_bds_eph);
+                                        }
+                                });
+                            }
+                    }
+                d_internal_pvt_solver->beidou_dnav_ephemeris_map[bds_dnav_eph->PRN] = *bds_dnav_eph;
+                if (bds_dnav_eph->SV_health != 0)
+                    {
+                        std::cout << TEXT_RED << "Satellite " << Gnss_Satellite(std::string("Beidou"), bds_dnav_eph->PRN)
+                                  << " is not healthy, not used for navigation" << TEXT_RESET << '\n';
+                    }
+            }
+            break;
+        case NAV_BEIDOU_DNAV_IONO:
+            {
+                // ### BeiDou IONO ###
+                const auto bds_dnav_iono = product.get<Beidou_Dnav_Iono>();
+                d_internal_pvt_solver->beidou_dnav_iono = *bds_dnav_iono;
+                DLOG(INFO) << "New BeiDou DNAV IONO record has arrived ";
+            }
+            break;
+        case NAV_BEIDOU_DNAV_UTC_MODEL:
+            {
+                // ### BeiDou UTC MODEL ###
+                const auto bds_dnav_utc_model = product.get<Beidou_Dnav_Utc_Model>();
+                d_internal_pvt_solver->beidou_dnav_utc_model = *bds_dnav_utc_model;
+                DLOG(INFO) << "New BeiDou DNAV UTC record has arrived ";
+            }
+            break;
+        case NAV_BEIDOU_DNAV_ALMANAC:
+            {
+                // ### BeiDou ALMANAC ###
+                const auto bds_dnav_almanac = product.get<Beidou_Dnav_Almanac>();
+                d_internal_pvt_solver->beidou_dnav_almanac_map[bds_dnav_almanac->PRN] = *bds_dnav_almanac;
+                DLOG(INFO) << "New BeiDou DNAV almanac record has arrived ";
+            }
+            break;
+        default:
+            LOG(WARNING) << "Unknown navigation product type " << product.type();
+        }
+}
+
+
+namespace
+{
+// Stores data in the file basename plus extension, if it is valid
+template <class T>
+void pvt_store_nav_data_file(Gnss_Nav_Data_Store& store, const std::string& basename, const std::string& extension, const char* name, const T& data, bool valid)
+{
+    if (valid)
+        {
+            store.store(basename + extension, name, data);
+            DLOG(INFO) << "Storing " << basename << extension;
+        }
+}
+}  // namespace
+
+
+void rtklib_pvt_gs::store_nav_data(uint32_t products)
+{
+    const auto changed = [products](Gnss_Nav_Product_Type type) { return (products & (1U << type)) != 0; };
+    const Rtklib_Solver& solver = *d_internal_pvt_solver;
+    Gnss_Nav_Data_Store& store = *d_nav_data_store;
+    const std::string& path = d_xml_base_path;
+    const std::string& ext = d_nav_data_extension;
+
+    // GPS
+    if (changed(NAV_GPS_EPHEMERIS))
+        {
+            pvt_store_nav_data_file(store, path + "gps_ephemeris", ext, "GNSS-SDR_ephemeris_map", solver.gps_ephemeris_map, !solver.gps_ephemeris_map.empty());
+        }
+    if (changed(NAV_GPS_IONO))
+        {
+            pvt_store_nav_data_file(store, path + "gps_iono", ext, "GNSS-SDR_iono_model", solver.gps_iono, solver.gps_iono.valid);
+        }
+    if (changed(NAV_GPS_UTC_MODEL))
+        {
+            pvt_store_nav_data_file(store, path + "gps_utc_model", ext, "GNSS-SDR_utc_model", solver.gps_utc_model, solver.gps_utc_model.valid);
+        }
+    if (changed(NAV_GPS_CNAV_EPHEMERIS))
+        {
+            pvt_store_nav_data_file(store, path + "gps_cnav_ephemeris", ext, "GNSS-SDR_cnav_ephemeris_map", solver.gps_cnav_ephemeris_map, !solver.gps_cnav_ephemeris_map.empty());
+        }
+    if (changed(NAV_GPS_CNAV_IONO))
+        {
+            pvt_store_nav_data_file(store, path + "gps_cnav_iono", ext, "GNSS-SDR_cnav_iono_model", solver.gps_cnav_iono, solver.gps_cnav_iono.valid);
+        }
+    if (changed(NAV_GPS_CNAV_UTC_MODEL))
+        {
+            pvt_store_nav_data_file(store, path + "gps_cnav_utc_model", ext, "GNSS-SDR_cnav_utc_model", solver.gps_cnav_utc_model, solver.gps_cnav_utc_model.valid);
+        }
+    if (changed(NAV_GPS_ALMANAC))
+        {
+            pvt_store_nav_data_file(store, path + "gps_almanac", ext, "GNSS-SDR_gps_almanac_map", solver.gps_almanac_map, !solver.gps_almanac_map.empty());
+        }
+
+    // Galileo
+    if (changed(NAV_GALILEO_EPHEMERIS))
+        {
+            pvt_store_nav_data_file(store, path + "gal_ephemeris", ext, "GNSS-SDR_gal_ephemeris_map", solver.galileo_ephemeris_map, !solver.galileo_ephemeris_map.empty());
+        }
+    if (changed(NAV_GALILEO_IONO))
+        {
+            pvt_store_nav_data_file(store, path + "gal_iono", ext, "GNSS-SDR_gal_iono_model", solver.galileo_iono, solver.galileo_iono.ai0 != 0.0);
+        }
+    if (changed(NAV_GALILEO_UTC_MODEL))
+        {
+            pvt_store_nav_data_file(store, path + "gal_utc_model", ext, "GNSS-SDR_gal_utc_model", solver.galileo_utc_model, solver.galileo_utc_model.Delta_tLS != 0.0);
+        }
+    if (changed(NAV_GALILEO_ALMANAC_HELPER) or changed(NAV_GALILEO_ALMANAC))
+        {
+            pvt_store_nav_data_file(store, path + "gal_almanac", ext, "GNSS-SDR_gal_almanac_map", solver.galileo_almanac_map, !solver.galileo_almanac_map.empty());
+        }
+
+    // GLONASS, whose ephemerides are stored under both names
+    if (changed(NAV_GLONASS_GNAV_EPHEMERIS))
+        {
+            pvt_store_nav_data_file(store, path + "eph_GLONASS_GNAV", ext, "GNSS-SDR_gnav_ephemeris_map", solver.glonass_gnav_ephemeris_map, !solver.glonass_gnav_ephemeris_map.empty());
+            pvt_store_nav_data_file(store, path + "glo_gnav_ephemeris", ext, "GNSS-SDR_gnav_ephemeris_map", solver.glonass_gnav_ephemeris_map, !solver.glonass_gnav_ephemeris_map.empty());
+        }
+    if (changed(NAV_GLONASS_GNAV_UTC_MODEL))
+        {
+            pvt_store_nav_data_file(store, path + "glo_utc_model", ext, "GNSS-SDR_gnav_utc_model", solver.glonass_gnav_utc_model, solver.glonass_gnav_utc_model.valid);
+        }
+
+    // BeiDou
+    if (changed(NAV_BEIDOU_DNAV_EPHEMERIS))
+        {
+            pvt_store_nav_data_file(store, path + "bds_dnav_ephemeris", ext, "GNSS-SDR_bds_dnav_ephemeris_map", solver.beidou_dnav_ephemeris_map, !solver.beidou_dnav_ephemeris_map.empty());
+        }
+    if (changed(NAV_BEIDOU_DNAV_IONO))
+        {
+            pvt_store_nav_data_file(store, path + "bds_dnav_iono", ext, "GNSS-SDR_bds_dnav_iono_model", solver.beidou_dnav_iono, solver.beidou_dnav_iono.valid);
+        }
+    if (changed(NAV_BEIDOU_DNAV_UTC_MODEL))
+        {
+            pvt_store_nav_data_file(store, path + "bds_dnav_utc_model", ext, "GNSS-SDR_bds_dnav_utc_model", solver.beidou_dnav_utc_model, solver.beidou_dnav_utc_model.valid);
+        }
+    if (changed(NAV_BEIDOU_DNAV_ALMANAC))
         {
-            LOG(WARNING) << "msg_handler_telemetry Bad any_cast: " << e.what();
+            pvt_store_nav_data_file(store, path + "bds_dnav_almanac", ext, "GNSS-SDR_bds_dnav_almanac_map", solver.beidou_dnav_almanac_map, !solver.beidou_dnav_almanac_map.empty());
         }
 }
 
@@ -1631,15 +1232,6 @@ void rtklib_pvt_gs::clear_ephemeris()
     d_internal_pvt_solver->galileo_almanac_map.clear();
     d_internal_pvt_solver->beidou_dnav_ephemeris_map.clear();
     d_internal_pvt_solver->beidou_dnav_almanac_map.clear();
-    if (d_enable_rx_clock_correction == true)
-        {
-            d_user_pvt_solver->gps_ephemeris_map.clear();
-            d_user_pvt_solver->gps_almanac_map.clear();
-            d_user_pvt_solver->galileo_ephemeris_map.clear();
-            d_user_pvt_solver->galileo_almanac_map.clear();
-            d_user_pvt_solver->beidou_dnav_ephemeris_map.clear();
-            d_user_pvt_solver->beidou_dnav_almanac_map.clear();
-        }
 }
 
 
@@ -1748,7 +1340,7 @@ bool rtklib_pvt_gs::get_latest_PVT(double* longitude_deg,
     double* course_over_ground_deg,
     time_t* UTC_time) const
 {
-    if (d_enable_rx_clock_correction == true)
+    if (d_separate_user_pvt_solver == true)
         {
             if (d_user_pvt_solver->is_valid_position())
                 {
@@ -1781,6 +1373,158 @@ bool rtklib_pvt_gs::get_latest_PVT(double* longitude_deg,
 }
 
 
+void rtklib_pvt_gs::get_receiver_snapshot(Gnss_Receiver_Snapshot& snapshot) const
+{
+    std::unique_lock<std::mutex> lock(d_snapshot_mutex);
+    d_snapshot_target = &snapshot;
+    d_snapshot_requested.store(true, std::memory_order_release);
+    if (!d_snapshot_cond.wait_for(lock, std::chrono::seconds(1), [this] { return d_snapshot_target == nullptr; }))
+        {
+            // work() is not being called, so the navigation data are not
+            // being updated
+            d_snapshot_target = nullptr;
+            d_snapshot_requested.store(false, std::memory_order_relaxed);
+            copy_receiver_snapshot(snapshot);
+        }
+}
+
+
+void rtklib_pvt_gs::copy_receiver_snapshot(Gnss_Receiver_Snapshot& snapshot) const
+{
+    snapshot.gps_ephemeris_map = d_internal_pvt_solver->gps_ephemeris_map;
+    snapshot.gps_cnav_ephemeris_map = d_internal_pvt_solver->gps_cnav_ephemeris_map;
+    snapshot.gps_almanac_map = d_internal_pvt_solver->gps_almanac_map;
+    snapshot.gps_iono = d_internal_pvt_solver->gps_iono;
+    snapshot.gps_utc_model = d_internal_pvt_solver->gps_utc_model;
+    snapshot.galileo_ephemeris_map = d_internal_pvt_solver->galileo_ephemeris_map;
+    snapshot.galileo_almanac_map = d_internal_pvt_solver->galileo_almanac_map;
+    snapshot.galileo_iono = d_internal_pvt_solver->galileo_iono;
+    snapshot.galileo_utc_model = d_internal_pvt_solver->galileo_utc_model;
+    snapshot.glonass_gnav_ephemeris_map = d_internal_pvt_solver->glonass_gnav_ephemeris_map;
+    snapshot.glonass_gnav_utc_model = d_internal_pvt_solver->glonass_gnav_utc_model;
+    snapshot.beidou_dnav_ephemeris_map = d_internal_pvt_solver->beidou_dnav_ephemeris_map;
+    snapshot.beidou_dnav_almanac_map = d_internal_pvt_solver->beidou_dnav_almanac_map;
+    snapshot.beidou_dnav_utc_model = d_internal_pvt_solver->beidou_dnav_utc_model;
+
+    double ground_speed_kmh;
+    double course_over_ground_deg;
+    time_t utc_time;
+    snapshot.pvt_valid = get_latest_PVT(&snapshot.longitude_deg,
+        &snapshot.latitude_deg,
+        &snapshot.height_m,
+        &ground_speed_kmh,
+        &course_over_ground_deg,
+        &utc_time);
+    if (snapshot.pvt_valid)
+        {
+            snapshot.pvt_utc_time = static_cast<int64_t>(utc_time);
+            snapshot.clock_drift_ppm = d_internal_pvt_solver->get_clock_drift_ppm();
+        }
+}
+
+
+void rtklib_pvt_gs::publish_beamformer_steering()
+{
+    const auto steering = std::make_shared<Beamformer_Steering>();
+    for (int sat = 1; sat <= MAXSAT; sat++)
+        {
+            const ssat_t& ssat = d_user_pvt_solver->pvt_ssat[sat - 1];
+            if (ssat.vs != 1)
+                {
+                    continue;
+                }
+            Beamformer_Steering::Direction direction;
+            int prn = 0;
+            switch (satsys(sat, &prn))
+                {
+                case SYS_GPS:
+                    direction.system = 'G';
+                    break;
+                case SYS_GAL:
+                    direction.system = 'E';
+                    break;
+                case SYS_GLO:
+                    direction.system = 'R';
+                    break;
+                case SYS_BDS:
+                    direction.system = 'C';
+                    break;
+                default:
+                    break;
+                }
+            direction.prn = static_cast<uint32_t>(prn);
+            direction.azimuth_rad = ssat.azel[0];
+            direction.elevation_rad = ssat.azel[1];
+            steering->directions.push_back(direction);
+        }
+    std::sort(steering->directions.begin(), steering->directions.end(),
+        [](const Beamformer_Steering::Direction& a, const Beamformer_Steering::Direction& b) { return a.elevation_rad > b.elevation_rad; });
+    this->message_port_pub(pmt::mp("pvt_to_beamformer"), pmt::make_any(steering));
+}
+
+
+void rtklib_pvt_gs::solve_attitude()
+{
+    const obsd_t* base_obs = nullptr;
+    const nav_t* nav = nullptr;
+    const int n_base = d_internal_pvt_solver->get_epoch_observations(&base_obs, &nav);
+    const std::vector<Attitude_Solution>& solutions = d_attitude_solver->solve(base_obs, n_base, nav, d_internal_pvt_solver->pvt_sol, d_antenna_observables_maps);
+    for (const auto& solution : solutions)
+        {
+            if (solution.status == SOLQ_NONE)
+                {
+                    continue;
+                }
+            DLOG(INFO) << "Antenna " << solution.antenna << (solution.status == SOLQ_FIX ? " (fix)" : " (float)")
+                       << ": heading " << solution.heading_deg << " [deg], pitch " << solution.pitch_deg
+                       << " [deg], baseline " << solution.length_m << " [m]";
+            if (d_attitude_file.is_open())
+                {
+                    int week = 0;
+                    const double tow_s = time2gpst(solution.time, &week);
+                    d_attitude_file << week << ',' << std::fixed << std::setprecision(3) << tow_s << ','
+                                    << solution.antenna << ',' << (solution.status == SOLQ_FIX ? "fix" : "float") << ','
+                                    << solution.satellites << ',' << std::setprecision(2) << solution.ratio << ','
+                                    << std::setprecision(4) << solution.baseline_enu[0] << ',' << solution.baseline_enu[1] << ','
+                                    << solution.baseline_enu[2] << ',' << solution.length_m << ','
+                                    << std::setprecision(3) << solution.heading_deg << ',' << solution.pitch_deg << '\n';
+                }
+        }
+}
+
+
+void rtklib_pvt_gs::publish_navigation_state()
+{
+    // the pseudorange rates are computed from the next epoch on
+    d_internal_pvt_solver->enable_pseudorange_rates();
+
+    Gnss_Receiver_State receiver;
+    for (int i = 0; i < 3; i++)
+        {
+            receiver.pos_ecef_m[i] = d_internal_pvt_solver->pvt_sol.rr[i];
+            receiver.vel_ecef_m_s[i] = d_internal_pvt_solver->pvt_sol.rr[3 + i];
+        }
+    receiver.clock_offset_s = d_internal_pvt_solver->get_time_offset_s();
+    receiver.clock_drift_ppm = d_internal_pvt_solver->get_clock_drift_ppm();
+    receiver.rx_time_s = d_gnss_observables_map.cbegin()->second.RX_time;
+    receiver.sample_counter = d_gnss_observables_map.cbegin()->second.Tracking_sample_counter;
+
+    d_navigation_state->begin_epoch();
+    d_navigation_state->set_receiver(receiver);
+    for (const auto& obs : d_gnss_observables_map)
+        {
+            Gnss_Channel_Assistance assistance;
+            if (d_internal_pvt_solver->get_pseudorange_rate(obs.second, assistance.pseudorange_rate_m_s))
+                {
+                    assistance.PRN = obs.second.PRN;
+                    assistance.System = obs.second.System;
+                    d_navigation_state->set_channel(obs.second.Channel_ID, assistance);
+                }
+        }
+    d_navigation_state->end_epoch();
+}
+
+
 void rtklib_pvt_gs::apply_rx_clock_offset(std::map<int, Gnss_Synchro>& observables_map,
     double rx_clock_offset_s)
 {
@@ -1793,39 +1537,39 @@ void rtklib_pvt_gs::apply_rx_clock_offset(std::map<int, Gnss_Synchro>& observabl
             observables_iter->second.RX_time -= rx_clock_offset_s;
             observables_iter->second.Pseudorange_m -= rx_clock_offset_s * SPEED_OF_LIGHT_M_S;
 
-            switch (d_mapStringValues[observables_iter->second.Signal])
+            switch (gnss_signal_id(observables_iter->second))
                 {
-                case evGPS_1C:
-                case evSBAS_1C:
-                case evGAL_1B:
+                case SIGNAL_GPS_1C:
+                case SIGNAL_SBAS_1C:
+                case SIGNAL_GAL_1B:
                     observables_iter->second.Carrier_phase_rads -= rx_clock_offset_s * FREQ1 * TWO_PI;
                     break;
-                case evGPS_L5:
-                case evGAL_5X:
+                case SIGNAL_GPS_L5:
+                case SIGNAL_GAL_5X:
                     observables_iter->second.Carrier_phase_rads -= rx_clock_offset_s * FREQ5 * TWO_PI;
                     break;
-                case evGAL_E6:
+                case SIGNAL_GAL_E6:
                     observables_iter->second.Carrier_phase_rads -= rx_clock_offset_s * FREQ6 * TWO_PI;
                     break;
-                case evGAL_7X:
+                case SIGNAL_GAL_7X:
                     observables_iter->second.Carrier_phase_rads -= rx_clock_offset_s * FREQ7 * TWO_PI;
                     break;
-                case evGPS_2S:
+                case SIGNAL_GPS_2S:
                     observables_iter->second.Carrier_phase_rads -= rx_clock_offset_s * FREQ2 * TWO_PI;
                     break;
-                case evBDS_B3:
+                case SIGNAL_BDS_B3:
                     observables_iter->second.Carrier_phase_rads -= rx_clock_offset_s * FREQ3_BDS * TWO_PI;
                     break;
-                case evGLO_1G:
+                case SIGNAL_GLO_1G:
                     observables_iter->second.Carrier_phase_rads -= rx_clock_offset_s * FREQ1_GLO * TWO_PI;
                     break;
-                case evGLO_2G:
+                case SIGNAL_GLO_2G:
                     observables_iter->second.Carrier_phase_rads -= rx_clock_offset_s * FREQ2_GLO * TWO_PI;
                     break;
-                case evBDS_B1:
+                case SIGNAL_BDS_B1:
                     observables_iter->second.Carrier_phase_rads -= rx_clock_offset_s * FREQ1_BDS * TWO_PI;
                     break;
-                case evBDS_B2:
+                case SIGNAL_BDS_B2:
                     observables_iter->second.Carrier_phase_rads -= rx_clock_offset_s * FREQ2_BDS * TWO_PI;
                     break;
                 default:
@@ -1895,39 +1639,39 @@ void rtklib_pvt_gs::initialize_and_apply_carrier_phase_offset()
             if (d_channel_initialized.at(observables_iter->second.Channel_ID) == false)
                 {
                     double wavelength_m = 0;
-                    switch (d_mapStringValues[observables_iter->second.Signal])
+                    switch (gnss_signal_id(observables_iter->second))
                         {
-                        case evGPS_1C:
-                        case evSBAS_1C:
-                        case evGAL_1B:
+                        case SIGNAL_GPS_1C:
+                        case SIGNAL_SBAS_1C:
+                        case SIGNAL_GAL_1B:
                             wavelength_m = SPEED_OF_LIGHT_M_S / FREQ1;
                             break;
-                        case evGPS_L5:
-                        case evGAL_5X:
+                        case SIGNAL_GPS_L5:
+                        case SIGNAL_GAL_5X:
                             wavelength_m = SPEED_OF_LIGHT_M_S / FREQ5;
                             break;
-                        case evGAL_E6:
+                        case SIGNAL_GAL_E6:
                             wavelength_m = SPEED_OF_LIGHT_M_S / FREQ6;
                             break;
-                        case evGAL_7X:
+                        case SIGNAL_GAL_7X:
                             wavelength_m = SPEED_OF_LIGHT_M_S / FREQ7;
                             break;
-                        case evGPS_2S:
+                        case SIGNAL_GPS_2S:
                             wavelength_m = SPEED_OF_LIGHT_M_S / FREQ2;
                             break;
-                        case evBDS_B3:
+                        case SIGNAL_BDS_B3:
                             wavelength_m = SPEED_OF_LIGHT_M_S / FREQ3_BDS;
                             break;
-                        case evGLO_1G:
+                        case SIGNAL_GLO_1G:
                             wavelength_m = SPEED_OF_LIGHT_M_S / FREQ1_GLO;
                             break;
-                        case evGLO_2G:
+                        case SIGNAL_GLO_2G:
                             wavelength_m = SPEED_OF_LIGHT_M_S / FREQ2_GLO;
                             break;
-                        case evBDS_B1:
+                        case SIGNAL_BDS_B1:
                             wavelength_m = SPEED_OF_LIGHT_M_S / FREQ1_BDS;
                             break;
-                        case evBDS_B2:
+                        case SIGNAL_BDS_B2:
                             wavelength_m = SPEED_OF_LIGHT_M_S / FREQ2_BDS;
                             break;
                         default:
@@ -1947,34 +1691,64 @@ void rtklib_pvt_gs::initialize_and_apply_carrier_phase_offset()
 int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_items,
     gr_vector_void_star& output_items __attribute__((unused)))
 {
+    static const char* const trace_names[] = {"available", nullptr};
+    const Gnss_Trace_Scope trace("pvt", -1, trace_names, noutput_items);
+    if (d_snapshot_requested.load(std::memory_order_acquire))
+        {
+            const std::lock_guard<std::mutex> lock(d_snapshot_mutex);
+            if (d_snapshot_target != nullptr)
+                {
+                    copy_receiver_snapshot(*d_snapshot_target);
+                    d_snapshot_target = nullptr;
+                    d_snapshot_requested.store(false, std::memory_order_relaxed);
+                    d_snapshot_cond.notify_all();
+                }
+        }
+
     //**************** time tags ****************
     if (d_enable_rx_clock_correction == false)  // todo: currently only works if clock correction is disabled
         {
-            std::vector<gr::tag_t> tags_vec;
             // time tag from obs to pvt is always propagated in channel 0
-            this->get_tags_in_range(tags_vec, 0, this->nitems_read(0), this->nitems_read(0) + noutput_items);
-            for (const auto& it : tags_vec)
+            if (!d_TimeChannelTagReader.attached())
                 {
-                    try
-                        {
-                            if (pmt::any_ref(it.value).type().hash_code() == typeid(const std::shared_ptr<GnssTime>).hash_code())
-                                {
-                                    const auto timetag = boost::any_cast<const std::shared_ptr<GnssTime>>(pmt::any_ref(it.value));
-                                    // std::cout << "PVT timetag: " << timetag->rx_time << '\n';
-                                    d_TimeChannelTagTimestamps.push(*timetag);
-                                }
-                            else
-                                {
-                                    std::cout << "hash code not match\n";
-                                }
-                        }
-                    catch (const boost::bad_any_cast& e)
-                        {
-                            std::cout << "msg Bad any_cast: " << e.what();
-                        }
+                    d_TimeChannelTagReader.attach(gnss_time_tag_input_channel(this, 0));
+                }
+            GnssTime timetag{};
+            while (d_TimeChannelTagReader.next(this->nitems_read(0), this->nitems_read(0) + noutput_items, timetag))
+                {
+                    // std::cout << "PVT timetag: " << timetag.rx_time << '\n';
+                    d_TimeChannelTagTimestamps.push(timetag);
                 }
         }
     //************* end time tags **************
+    if (d_pipeline_latency)
+        {
+            this->get_tags_in_range(d_rx_sample_tags, 0, this->nitems_read(0), this->nitems_read(0) + noutput_items, d_rx_sample_key);
+        }
+
+    // navigation data delivered by the telemetry decoders since the last call
+    d_nav_product_reader.drain(d_nav_products);
+    for (const auto& product : d_nav_products)
+        {
+            handle_nav_product(product);
+            d_nav_data_changed |= 1U << product.type();
+            if (d_raw_obs_log)
+                {
+                    d_output_dispatcher->push([this, product]() { d_raw_obs_log->log_nav_product(product); });
+                }
+        }
+    d_nav_products.clear();
+    if (d_nav_data_store and d_nav_data_changed != 0)
+        {
+            // at most once per flush period, as the ephemerides arrive in bursts
+            const auto now = std::chrono::steady_clock::now();
+            if (now - d_nav_data_stored >= d_nav_data_period)
+                {
+                    store_nav_data(d_nav_data_changed);
+                    d_nav_data_changed = 0;
+                    d_nav_data_stored = now;
+                }
+        }
 
     for (int32_t epoch = 0; epoch < noutput_items; epoch++)
         {
@@ -1985,104 +1759,127 @@ int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_item
             bool flag_write_RTCM_1045_output = false;
             bool flag_write_RTCM_MSM_output = false;
             bool flag_write_RINEX_obs_output = false;
+            // copies of the solution and of the observables given to the printers
+            std::shared_ptr<const Rtklib_Solver> output_pvt;
+            std::shared_ptr<const std::map<int, Gnss_Synchro>> output_observables;
             d_local_counter_ms += static_cast<uint64_t>(d_observable_interval_ms);
 
             d_gnss_observables_map.clear();
+            for (auto& antenna_observables_map : d_antenna_observables_maps)
+                {
+                    antenna_observables_map.clear();
+                }
             const auto** in = reinterpret_cast<const Gnss_Synchro**>(&input_items[0]);  // Get the input buffer pointer
             // ############ 1. READ PSEUDORANGES ####
             for (uint32_t i = 0; i < d_nchannels; i++)
                 {
                     if (in[i][epoch].Flag_valid_pseudorange)
                         {
-                            const auto tmp_eph_iter_gps = d_internal_pvt_solver->gps_ephemeris_map.find(in[i][epoch].PRN);
-                            const auto tmp_eph_iter_gal = d_internal_pvt_solver->galileo_ephemeris_map.find(in[i][epoch].PRN);
-                            const auto tmp_eph_iter_cnav = d_internal_pvt_solver->gps_cnav_ephemeris_map.find(in[i][epoch].PRN);
-                            const auto tmp_eph_iter_glo_gnav = d_internal_pvt_solver->glonass_gnav_ephemeris_map.find(in[i][epoch].PRN);
-                            const auto tmp_eph_iter_bds_dnav = d_internal_pvt_solver->beidou_dnav_ephemeris_map.find(in[i][epoch].PRN);
-
+                            // only the ephemeris of the system of the observable is looked up
+                            const Gnss_Synchro& gnss_synchro = in[i][epoch];
+                            const Gnss_Signal_Id signal_id = gnss_signal_id(gnss_synchro);
+                            const Gps_Ephemeris* gps_eph = nullptr;
+                            const Gps_CNAV_Ephemeris* gps_cnav_eph = nullptr;
+                            const Galileo_Ephemeris* gal_eph = nullptr;
+                            const Glonass_Gnav_Ephemeris* glo_gnav_eph = nullptr;
                             bool store_valid_observable = false;
 
-                            if (tmp_eph_iter_gps != d_internal_pvt_solver->gps_ephemeris_map.cend())
-                                {
-                                    const uint32_t prn_aux = tmp_eph_iter_gps->second.PRN;
-                                    if ((prn_aux == in[i][epoch].PRN) && (std::string(in[i][epoch].Signal) == std::string("1C")) && (tmp_eph_iter_gps->second.SV_health == 0))
-                                        {
-                                            store_valid_observable = true;
-                                        }
-                                }
-                            if (tmp_eph_iter_gal != d_internal_pvt_solver->galileo_ephemeris_map.cend())
-                                {
-                                    const uint32_t prn_aux = tmp_eph_iter_gal->second.PRN;
-                                    if ((prn_aux == in[i][epoch].PRN) &&
-                                        (((std::string(in[i][epoch].Signal) == std::string("1B")) && (tmp_eph_iter_gal->second.E1B_DVS == false) && (tmp_eph_iter_gal->second.E1B_HS == 0)) ||
-                                            ((std::string(in[i][epoch].Signal) == std::string("5X")) && (tmp_eph_iter_gal->second.E5a_DVS == false) && (tmp_eph_iter_gal->second.E5a_HS == 0)) ||
-                                            ((std::string(in[i][epoch].Signal) == std::string("7X")) && (tmp_eph_iter_gal->second.E5b_DVS == false) && (tmp_eph_iter_gal->second.E5b_HS == 0))))
-                                        {
-                                            store_valid_observable = true;
-                                        }
-                                }
-                            if (tmp_eph_iter_cnav != d_internal_pvt_solver->gps_cnav_ephemeris_map.cend())
-                                {
-                                    const uint32_t prn_aux = tmp_eph_iter_cnav->second.PRN;
-                                    if ((prn_aux == in[i][epoch].PRN) && (((std::string(in[i][epoch].Signal) == std::string("2S")) || (std::string(in[i][epoch].Signal) == std::string("L5")))))
-                                        {
-                                            store_valid_observable = true;
-                                        }
+                            switch (signal_id)
+                                {
+                                case SIGNAL_GPS_1C:
+                                    {
+                                        const auto tmp_eph_iter_gps = d_internal_pvt_solver->gps_ephemeris_map.find(gnss_synchro.PRN);
+                                        if (tmp_eph_iter_gps != d_internal_pvt_solver->gps_ephemeris_map.cend())
+                                            {
+                                                gps_eph = &tmp_eph_iter_gps->second;
+                                                store_valid_observable = (gps_eph->SV_health == 0);
+                                            }
+                                        break;
+                                    }
+                                case SIGNAL_GPS_2S:
+                                case SIGNAL_GPS_L5:
+                                    {
+                                        const auto tmp_eph_iter_cnav = d_internal_pvt_solver->gps_cnav_ephemeris_map.find(gnss_synchro.PRN);
+                                        if (tmp_eph_iter_cnav != d_internal_pvt_solver->gps_cnav_ephemeris_map.cend())
+                                            {
+                                                gps_cnav_eph = &tmp_eph_iter_cnav->second;
+                                                store_valid_observable = true;
+                                            }
+                                        break;
+                                    }
+                                case SIGNAL_GAL_1B:
+                                case SIGNAL_GAL_5X:
+                                case SIGNAL_GAL_7X:
+                                    {
+                                        const auto tmp_eph_iter_gal = d_internal_pvt_solver->galileo_ephemeris_map.find(gnss_synchro.PRN);
+                                        if (tmp_eph_iter_gal != d_internal_pvt_solver->galileo_ephemeris_map.cend())
+                                            {
+                                                gal_eph = &tmp_eph_iter_gal->second;
+                                                store_valid_observable = ((signal_id == SIGNAL_GAL_1B) && (gal_eph->E1B_DVS == false) && (gal_eph->E1B_HS == 0)) ||
+                                                                         ((signal_id == SIGNAL_GAL_5X) && (gal_eph->E5a_DVS == false) && (gal_eph->E5a_HS == 0)) ||
+                                                                         ((signal_id == SIGNAL_GAL_7X) && (gal_eph->E5b_DVS == false) && (gal_eph->E5b_HS == 0));
+                                            }
+                                        break;
+                                    }
+                                case SIGNAL_GLO_1G:
+                                case SIGNAL_GLO_2G:
+                                    {
+                                        const auto tmp_eph_iter_glo_gnav = d_internal_pvt_solver->glonass_gnav_ephemeris_map.find(gnss_synchro.PRN);
+                                        if (tmp_eph_iter_glo_gnav != d_internal_pvt_solver->glonass_gnav_ephemeris_map.cend())
+                                            {
+                                                glo_gnav_eph = &tmp_eph_iter_glo_gnav->second;
+                                                store_valid_observable = true;
+                                            }
+                                        break;
+                                    }
+                                case SIGNAL_BDS_B1:
+                                case SIGNAL_BDS_B3:
+                                    {
+                                        const auto tmp_eph_iter_bds_dnav = d_internal_pvt_solver->beidou_dnav_ephemeris_map.find(gnss_synchro.PRN);
+                                        if (tmp_eph_iter_bds_dnav != d_internal_pvt_solver->beidou_dnav_ephemeris_map.cend())
+                                            {
+                                                store_valid_observable = (tmp_eph_iter_bds_dnav->second.SV_health == 0);
+                                            }
+                                        break;
+                                    }
+                                default:
+                                    break;
                                 }
-                            if (tmp_eph_iter_glo_gnav != d_internal_pvt_solver->glonass_gnav_ephemeris_map.cend())
+
+                            if (store_valid_observable)
                                 {
-                                    const uint32_t prn_aux = tmp_eph_iter_glo_gnav->second.PRN;
-                                    if ((prn_aux == in[i][epoch].PRN) && ((std::string(in[i][epoch].Signal) == std::string("1G")) || (std::string(in[i][epoch].Signal) == std::string("2G"))))
+                                    if (d_attitude_solver == nullptr || d_channel_antenna[i] == 0)
                                         {
-                                            store_valid_observable = true;
+                                            // store valid observables in a map.
+                                            d_gnss_observables_map.insert(std::pair<int, Gnss_Synchro>(i, gnss_synchro));
                                         }
-                                }
-                            if (tmp_eph_iter_bds_dnav != d_internal_pvt_solver->beidou_dnav_ephemeris_map.cend())
-                                {
-                                    const uint32_t prn_aux = tmp_eph_iter_bds_dnav->second.PRN;
-                                    if ((prn_aux == in[i][epoch].PRN) && (((std::string(in[i][epoch].Signal) == std::string("B1")) || (std::string(in[i][epoch].Signal) == std::string("B3"))) && (tmp_eph_iter_bds_dnav->second.SV_health == 0)))
+                                    else if (d_channel_antenna[i] > 0 && d_channel_antenna[i] <= static_cast<int32_t>(d_antenna_observables_maps.size()))
                                         {
-                                            store_valid_observable = true;
+                                            // the other antennas only give their baselines
+                                            d_antenna_observables_maps[d_channel_antenna[i] - 1].insert(std::pair<int, Gnss_Synchro>(i, gnss_synchro));
                                         }
                                 }
 
-                            if (store_valid_observable)
-                                {
-                                    // store valid observables in a map.
-                                    d_gnss_observables_map.insert(std::pair<int, Gnss_Synchro>(i, in[i][epoch]));
-                                }
-
                             if (d_rtcm_enabled)
                                 {
                                     try
                                         {
-                                            if (d_internal_pvt_solver->gps_ephemeris_map.empty() == false)
+                                            // keep track of locking time
+                                            if (gps_eph != nullptr)
                                                 {
-                                                    if (tmp_eph_iter_gps != d_internal_pvt_solver->gps_ephemeris_map.cend())
-                                                        {
-                                                            d_rtcm_printer->lock_time(d_internal_pvt_solver->gps_ephemeris_map.find(in[i][epoch].PRN)->second, in[i][epoch].RX_time, in[i][epoch]);  // keep track of locking time
-                                                        }
+                                                    d_rtcm_printer->lock_time(*gps_eph, gnss_synchro.RX_time, gnss_synchro);
                                                 }
-                                            if (d_internal_pvt_solver->galileo_ephemeris_map.empty() == false)
+                                            if (gps_cnav_eph != nullptr)
                                                 {
-                                                    if (tmp_eph_iter_gal != d_internal_pvt_solver->galileo_ephemeris_map.cend())
-                                                        {
-                                                            d_rtcm_printer->lock_time(d_internal_pvt_solver->galileo_ephemeris_map.find(in[i][epoch].PRN)->second, in[i][epoch].RX_time, in[i][epoch]);  // keep track of locking time
-                                                        }
+                                                    d_rtcm_printer->lock_time(*gps_cnav_eph, gnss_synchro.RX_time, gnss_synchro);
                                                 }
-                                            if (d_internal_pvt_solver->gps_cnav_ephemeris_map.empty() == false)
+                                            if (gal_eph != nullptr)
                                                 {
-                                                    if (tmp_eph_iter_cnav != d_internal_pvt_solver->gps_cnav_ephemeris_map.cend())
-                                                        {
-                                                            d_rtcm_printer->lock_time(d_internal_pvt_solver->gps_cnav_ephemeris_map.find(in[i][epoch].PRN)->second, in[i][epoch].RX_time, in[i][epoch]);  // keep track of locking time
-                                                        }
+                                                    d_rtcm_printer->lock_time(*gal_eph, gnss_synchro.RX_time, gnss_synchro);
                                                 }
-                                            if (d_internal_pvt_solver->glonass_gnav_ephemeris_map.empty() == false)
+                                            if (glo_gnav_eph != nullptr)
                                                 {
-                                                    if (tmp_eph_iter_glo_gnav != d_internal_pvt_solver->glonass_gnav_ephemeris_map.cend())
-                                                        {
-                                                            d_rtcm_printer->lock_time(d_internal_pvt_solver->glonass_gnav_ephemeris_map.find(in[i][epoch].PRN)->second, in[i][epoch].RX_time, in[i][epoch]);  // keep track of locking time
-                                                        }
+                                                    d_rtcm_printer->lock_time(*glo_gnav_eph, gnss_synchro.RX_time, gnss_synchro);
                                                 }
                                         }
                                     catch (const boost::exception& ex)
@@ -2113,6 +1910,14 @@ int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_item
                     // #### solve PVT and store the corrected observable set
                     if (d_internal_pvt_solver->get_PVT(d_gnss_observables_map, false))
                         {
+                            if (d_attitude_solver)
+                                {
+                                    solve_attitude();
+                                }
+                            if (d_navigation_state->has_readers())
+                                {
+                                    publish_navigation_state();
+                                }
                             const double Rx_clock_offset_s = d_internal_pvt_solver->get_time_offset_s();
 
                             // **************** time tags ****************
@@ -2224,6 +2029,8 @@ int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_item
 
                     if (flag_pvt_valid == true)
                         {
+                            static const char* const epoch_names[] = {"observations", "rx_time_ms", nullptr};
+                            Gnss_Trace::record('i', "pvt_epoch", -1, epoch_names, d_user_pvt_solver->get_num_valid_observations(), static_cast<int64_t>(current_RX_time_ms));
                             // experimental VTL tests
                             // send tracking command
                             //                            const std::shared_ptr<TrackingCmd> trk_cmd_test = std::make_shared<TrackingCmd>(TrackingCmd());
@@ -2327,55 +2134,65 @@ int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_item
                                             send_sys_v_ttff_msg(ttff);
                                             d_first_fix = false;
                                         }
-                                    if (d_kml_output_enabled)
-                                        {
-                                            if (current_RX_time_ms % d_kml_rate_ms == 0)
-                                                {
-                                                    d_kml_dump->print_position(d_user_pvt_solver.get(), false);
-                                                }
-                                        }
-                                    if (d_gpx_output_enabled)
-                                        {
-                                            if (current_RX_time_ms % d_gpx_rate_ms == 0)
-                                                {
-                                                    d_gpx_dump->print_position(d_user_pvt_solver.get(), false);
-                                                }
-                                        }
-                                    if (d_geojson_output_enabled)
-                                        {
-                                            if (current_RX_time_ms % d_geojson_rate_ms == 0)
-                                                {
-                                                    d_geojson_printer->print_position(d_user_pvt_solver.get(), false);
-                                                }
-                                        }
-                                    if (d_nmea_output_file_enabled)
+                                    const bool flag_write_kml_output = d_kml_output_enabled && (current_RX_time_ms % d_kml_rate_ms == 0);
+                                    const bool flag_write_gpx_output = d_gpx_output_enabled && (current_RX_time_ms % d_gpx_rate_ms == 0);
+                                    const bool flag_write_geojson_output = d_geojson_output_enabled && (current_RX_time_ms % d_geojson_rate_ms == 0);
+                                    const bool flag_write_nmea_output = d_nmea_output_file_enabled && (current_RX_time_ms % d_nmea_rate_ms == 0);
+                                    if (flag_write_kml_output || flag_write_gpx_output || flag_write_geojson_output || flag_write_nmea_output || d_rinex_output_enabled || d_rtcm_enabled || (d_raw_obs_log && flag_write_RINEX_obs_output))
                                         {
-                                            if (current_RX_time_ms % d_nmea_rate_ms == 0)
+                                            if (!output_pvt)
                                                 {
-                                                    d_nmea_printer->Print_Nmea_Line(d_user_pvt_solver.get(), false);
+                                                    output_pvt = d_user_pvt_solver->snapshot();
+                                                    output_observables = std::make_shared<const std::map<int, Gnss_Synchro>>(d_gnss_observables_map);
                                                 }
-                                        }
-                                    if (d_rinex_output_enabled)
-                                        {
-                                            d_rp->print_rinex_annotation(d_user_pvt_solver.get(), d_gnss_observables_map, d_rx_time, d_type_of_rx, flag_write_RINEX_obs_output);
-                                        }
-                                    if (d_rtcm_enabled)
-                                        {
-                                            d_rtcm_printer->Print_Rtcm_Messages(d_user_pvt_solver.get(),
-                                                d_gnss_observables_map,
-                                                d_rx_time,
-                                                d_type_of_rx,
-                                                d_rtcm_MSM_rate_ms,
-                                                d_rtcm_MT1019_rate_ms,
-                                                d_rtcm_MT1020_rate_ms,
-                                                d_rtcm_MT1045_rate_ms,
-                                                d_rtcm_MT1077_rate_ms,
-                                                d_rtcm_MT1097_rate_ms,
-                                                flag_write_RTCM_MSM_output,
-                                                flag_write_RTCM_1019_output,
-                                                flag_write_RTCM_1020_output,
-                                                flag_write_RTCM_1045_output,
-                                                d_enable_rx_clock_correction);
+                                            const double rx_time = d_rx_time;
+                                            d_output_dispatcher->push([this, output_pvt, output_observables, rx_time,
+                                                                          flag_write_kml_output, flag_write_gpx_output, flag_write_geojson_output, flag_write_nmea_output,
+                                                                          flag_write_RINEX_obs_output, flag_write_RTCM_MSM_output,
+                                                                          flag_write_RTCM_1019_output, flag_write_RTCM_1020_output, flag_write_RTCM_1045_output]() {
+                                                if (flag_write_kml_output)
+                                                    {
+                                                        d_kml_dump->print_position(output_pvt.get(), false);
+                                                    }
+                                                if (flag_write_gpx_output)
+                                                    {
+                                                        d_gpx_dump->print_position(output_pvt.get(), false);
+                                                    }
+                                                if (flag_write_geojson_output)
+                                                    {
+                                                        d_geojson_printer->print_position(output_pvt.get(), false);
+                                                    }
+                                                if (flag_write_nmea_output)
+                                                    {
+                                                        d_nmea_printer->Print_Nmea_Line(output_pvt.get(), false);
+                                                    }
+                                                if (d_rinex_output_enabled)
+                                                    {
+                                                        d_rp->print_rinex_annotation(output_pvt.get(), *output_observables, rx_time, d_type_of_rx, flag_write_RINEX_obs_output);
+                                                    }
+                                                if (d_raw_obs_log && flag_write_RINEX_obs_output)
+                                                    {
+                                                        d_raw_obs_log->log_epoch(rx_time, *output_observables);
+                                                    }
+                                                if (d_rtcm_enabled)
+                                                    {
+                                                        d_rtcm_printer->Print_Rtcm_Messages(output_pvt.get(),
+                                                            *output_observables,
+                                                            rx_time,
+                                                            d_type_of_rx,
+                                                            d_rtcm_MSM_rate_ms,
+                                                            d_rtcm_MT1019_rate_ms,
+                                                            d_rtcm_MT1020_rate_ms,
+                                                            d_rtcm_MT1045_rate_ms,
+                                                            d_rtcm_MT1077_rate_ms,
+                                                            d_rtcm_MT1097_rate_ms,
+                                                            flag_write_RTCM_MSM_output,
+                                                            flag_write_RTCM_1019_output,
+                                                            flag_write_RTCM_1020_output,
+                                                            flag_write_RTCM_1045_output,
+                                                            d_enable_rx_clock_correction);
+                                                    }
+                                            });
                                         }
                                 }
                         }
@@ -2440,15 +2257,43 @@ int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_item
                     if (d_user_pvt_solver->is_valid_position())
                         {
                             const std::shared_ptr<Monitor_Pvt> monitor_pvt = std::make_shared<Monitor_Pvt>(d_user_pvt_solver->get_monitor_pvt());
+                            monitor_pvt->skipped_epochs = d_sample_clock->skipped_epochs();
+                            if (d_pipeline_latency)
+                                {
+                                    const uint64_t epoch_item = this->nitems_read(0) + static_cast<uint64_t>(epoch);
+                                    for (const auto& tag : d_rx_sample_tags)
+                                        {
+                                            if (tag.offset == epoch_item and d_pipeline_latency->elapsed_ms(pmt::to_uint64(tag.value), monitor_pvt->latency_ms))
+                                                {
+                                                    d_pipeline_latency->record(monitor_pvt->latency_ms);
+                                                    break;
+                                                }
+                                        }
+                                }
 
                             // publish new position to the gnss_flowgraph channel status monitor
                             if (current_RX_time_ms % d_report_rate_ms == 0)
                                 {
                                     this->message_port_pub(pmt::mp("status"), pmt::make_any(monitor_pvt));
+                                    publish_beamformer_steering();
+                                }
+                            if (d_receiver_callbacks)
+                                {
+                                    d_receiver_callbacks->pvt(*monitor_pvt);
                                 }
                             if (d_flag_monitor_pvt_enabled)
                                 {
                                     d_udp_sink_ptr->write_monitor_pvt(monitor_pvt.get());
+                                    if (d_pvt_shm_ring)
+                                        {
+                                            d_pvt_shm_ring->publish(monitor_pvt.get());
+                                        }
+                                    if (d_pvt_serial_sink)
+                                        {
+                                            d_output_dispatcher->push([this, monitor_pvt]() {
+                                                d_pvt_serial_sink->write_monitor_pvt(monitor_pvt.get());
+                                            });
+                                        }
                                 }
                         }
                 }
@@ -2456,7 +2301,14 @@ int rtklib_pvt_gs::work(int noutput_items, gr_vector_const_void_star& input_item
                 {
                     if (d_local_counter_ms % static_cast<uint64_t>(d_an_rate_ms) == 0)
                         {
-                            d_an_printer->print_packet(d_user_pvt_solver.get(), d_gnss_observables_map);
+                            if (!output_pvt)
+                                {
+                                    output_pvt = d_user_pvt_solver->snapshot();
+                                    output_observables = std::make_shared<const std::map<int, Gnss_Synchro>>(d_gnss_observables_map);
+                                }
+                            d_output_dispatcher->push([this, output_pvt, output_observables]() {
+                                d_an_printer->print_packet(output_pvt.get(), *output_observables);
+                            });
                         }
                 }
         }
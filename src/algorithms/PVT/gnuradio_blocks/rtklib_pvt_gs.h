@@ -18,21 +18,31 @@
 #define GNSS_SDR_RTKLIB_PVT_GS_H
 
 #include "gnss_block_interface.h"
+#include "gnss_nav_product_channel.h"
+#include "gnss_nav_data_store.h"
+#include "gnss_navigation_state.h"
+#include "gnss_pipeline_latency.h"
+#include "gnss_receiver_snapshot.h"
+#include "gnss_sample_clock.h"
 #include "gnss_synchro.h"
 #include "gnss_time.h"
+#include "gnss_time_tag_channel.h"
 #include "rtklib.h"
 #include <boost/date_time/gregorian/gregorian.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <gnuradio/sync_block.h>  // for sync_block
 #include <gnuradio/types.h>       // for gr_vector_const_void_star
 #include <pmt/pmt.h>              // for pmt_t
+#include <atomic>                 // for atomic
 #include <chrono>                 // for system_clock
+#include <condition_variable>     // for condition_variable
 #include <cstddef>                // for size_t
 #include <cstdint>                // for int32_t
 #include <ctime>                  // for time_t
 #include <fstream>                // for std::fstream
 #include <map>                    // for map
 #include <memory>                 // for shared_ptr, unique_ptr
+#include <mutex>                  // for mutex
 #include <queue>                  // for std::queue
 #include <string>                 // for string
 #include <sys/types.h>            // for key_t
@@ -52,15 +62,21 @@ class Galileo_Ephemeris;
 class GeoJSON_Printer;
 class Gps_Almanac;
 class Gps_Ephemeris;
+class Gnss_Receiver_Callbacks;
+class Gnss_Shm_Ring_Writer;
 class Gpx_Printer;
 class Kml_Printer;
+class Monitor_Pvt_Serial_Sink;
 class Monitor_Pvt_Udp_Sink;
 class Monitor_Ephemeris_Udp_Sink;
 class Nmea_Printer;
 class Pvt_Conf;
+class Pvt_Output_Dispatcher;
+class Raw_Obs_Log;
 class Rinex_Printer;
 class Rtcm_Printer;
 class An_Packet_Printer;
+class Attitude_Solver;
 class Has_Simple_Printer;
 class Rtklib_Solver;
 class rtklib_pvt_gs;
@@ -124,6 +140,12 @@ public:
         double* course_over_ground_deg,
         time_t* UTC_time) const;
 
+    /*!
+     * \brief Copies the navigation data, the last position fix and the
+     * receiver clock drift to snapshot
+     */
+    void get_receiver_snapshot(Gnss_Receiver_Snapshot& snapshot) const;
+
     int work(int noutput_items, gr_vector_const_void_star& input_items,
         gr_vector_void_star& output_items);  //!< PVT Signal Processing
 
@@ -138,12 +160,23 @@ private:
 
     void log_source_timetag_info(double RX_time_ns, double TAG_time_ns);
 
-    void msg_handler_telemetry(const pmt::pmt_t& msg);
+    void handle_nav_product(const Gnss_Nav_Product& product);
+
+    // stores the navigation data of the products, a bit mask of Gnss_Nav_Product_Type
+    void store_nav_data(uint32_t products);
 
     void msg_handler_has_data(const pmt::pmt_t& msg) const;
 
     void initialize_and_apply_carrier_phase_offset();
 
+    void publish_navigation_state();
+
+    void publish_beamformer_steering();
+
+    void solve_attitude();  // baselines from the main antenna to the other antennas
+
+    void copy_receiver_snapshot(Gnss_Receiver_Snapshot& snapshot) const;
+
     void apply_rx_clock_offset(std::map<int, Gnss_Synchro>& observables_map,
         double rx_clock_offset_s);
 
@@ -173,6 +206,19 @@ private:
     std::shared_ptr<Rtklib_Solver> d_internal_pvt_solver;
     std::shared_ptr<Rtklib_Solver> d_user_pvt_solver;
 
+    // The snapshots are copied by the work thread, which owns the maps of
+    // navigation data, while get_receiver_snapshot() waits
+    mutable std::mutex d_snapshot_mutex;
+    mutable std::condition_variable d_snapshot_cond;
+    mutable Gnss_Receiver_Snapshot* d_snapshot_target{nullptr};
+    mutable std::atomic<bool> d_snapshot_requested{false};
+
+    std::shared_ptr<Gnss_Navigation_State> d_navigation_state;  // read by the vector tracking channels
+    std::shared_ptr<Gnss_Pipeline_Latency> d_pipeline_latency;  // latency of the solutions, if measured
+    std::shared_ptr<Gnss_Sample_Clock> d_sample_clock;          // epochs lost by the observables
+    std::vector<gr::tag_t> d_rx_sample_tags;                    // sample counters of the epochs of a call to work
+    pmt::pmt_t d_rx_sample_key;
+
     std::unique_ptr<Rinex_Printer> d_rp;
     std::unique_ptr<Kml_Printer> d_kml_dump;
     std::unique_ptr<Gpx_Printer> d_gpx_dump;
@@ -181,63 +227,49 @@ private:
     std::unique_ptr<Rtcm_Printer> d_rtcm_printer;
     std::unique_ptr<Monitor_Pvt_Udp_Sink> d_udp_sink_ptr;
     std::unique_ptr<Monitor_Ephemeris_Udp_Sink> d_eph_udp_sink_ptr;
+    std::unique_ptr<Gnss_Shm_Ring_Writer> d_pvt_shm_ring;
+    std::shared_ptr<Gnss_Receiver_Callbacks> d_receiver_callbacks;  // if the PVT solutions are given to an application
+    std::unique_ptr<Monitor_Pvt_Serial_Sink> d_pvt_serial_sink;
     std::unique_ptr<Has_Simple_Printer> d_has_simple_printer;
     std::unique_ptr<An_Packet_Printer> d_an_printer;
+    std::unique_ptr<Attitude_Solver> d_attitude_solver;  // if there are several antennas
+    std::ofstream d_attitude_file;
+    std::unique_ptr<Raw_Obs_Log> d_raw_obs_log;  // if raw_obs_output_enabled
+
+    // declared after the printers, so that it is destroyed first: the
+    // pending outputs are written before the printers are closed
+    std::unique_ptr<Pvt_Output_Dispatcher> d_output_dispatcher;
+
+    std::unique_ptr<Gnss_Nav_Data_Store> d_nav_data_store;  // if xml_output_enabled
+    std::chrono::steady_clock::time_point d_nav_data_stored;
+    std::chrono::milliseconds d_nav_data_period{1000};  // minimum time between stores
 
     std::chrono::time_point<std::chrono::system_clock> d_start;
     std::chrono::time_point<std::chrono::system_clock> d_end;
 
     std::string d_dump_filename;
     std::string d_xml_base_path;
+    std::string d_nav_data_extension;  // of the navigation data files, .xml or .bin
     std::string d_local_time_str;
 
     std::vector<bool> d_channel_initialized;
     std::vector<double> d_initial_carrier_phase_offset_estimation_rads;
 
-    enum StringValue_
-    {
-        evGPS_1C,
-        evGPS_2S,
-        evGPS_L5,
-        evSBAS_1C,
-        evGAL_1B,
-        evGAL_5X,
-        evGAL_E6,
-        evGAL_7X,
-        evGLO_1G,
-        evGLO_2G,
-        evBDS_B1,
-        evBDS_B2,
-        evBDS_B3
-    };
-    std::map<std::string, StringValue_> d_mapStringValues;
     std::map<int, Gnss_Synchro> d_gnss_observables_map;
     std::map<int, Gnss_Synchro> d_gnss_observables_map_t0;
     std::map<int, Gnss_Synchro> d_gnss_observables_map_t1;
+    std::vector<std::map<int, Gnss_Synchro>> d_antenna_observables_maps;  // observables of the antennas other than the main one
+    std::vector<int32_t> d_channel_antenna;                               // antenna of each channel, if there are several
 
     std::queue<GnssTime> d_TimeChannelTagTimestamps;
+    Gnss_Time_Tag_Reader d_TimeChannelTagReader;  // time tags produced by the observables block
+
+    Gnss_Nav_Product_Reader d_nav_product_reader;  // navigation data produced by the telemetry decoders
+    std::vector<Gnss_Nav_Product> d_nav_products;
+    uint32_t d_nav_data_changed{0};  // navigation products received since they were last stored
 
     boost::posix_time::time_duration d_utc_diff_time;
 
-    size_t d_gps_ephemeris_sptr_type_hash_code;
-    size_t d_gps_iono_sptr_type_hash_code;
-    size_t d_gps_utc_model_sptr_type_hash_code;
-    size_t d_gps_cnav_ephemeris_sptr_type_hash_code;
-    size_t d_gps_cnav_iono_sptr_type_hash_code;
-    size_t d_gps_cnav_utc_model_sptr_type_hash_code;
-    size_t d_gps_almanac_sptr_type_hash_code;
-    size_t d_galileo_ephemeris_sptr_type_hash_code;
-    size_t d_galileo_iono_sptr_type_hash_code;
-    size_t d_galileo_utc_model_sptr_type_hash_code;
-    size_t d_galileo_almanac_helper_sptr_type_hash_code;
-    size_t d_galileo_almanac_sptr_type_hash_code;
-    size_t d_glonass_gnav_ephemeris_sptr_type_hash_code;
-    size_t d_glonass_gnav_utc_model_sptr_type_hash_code;
-    size_t d_glonass_gnav_almanac_sptr_type_hash_code;
-    size_t d_beidou_dnav_ephemeris_sptr_type_hash_code;
-    size_t d_beidou_dnav_iono_sptr_type_hash_code;
-    size_t d_beidou_dnav_utc_model_sptr_type_hash_code;
-    size_t d_beidou_dnav_almanac_sptr_type_hash_code;
     size_t d_galileo_has_data_sptr_type_hash_code;
 
     double d_rinex_version;
@@ -284,6 +316,7 @@ private:
     bool d_show_local_time_zone;
     bool d_waiting_obs_block_rx_clock_offset_correction_msg;
     bool d_enable_rx_clock_correction;
+    bool d_separate_user_pvt_solver;
     bool d_enable_has_messages;
     bool d_an_printer_enabled;
     bool d_log_timetag;
@@ -0,0 +1,245 @@
+/*!
+ * \file attitude_solver.cc
+ * \brief Heading and pitch of a vehicle from the short baselines between
+ * several antennas of the receiver.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "attitude_solver.h"
+#include "MATH_CONSTANTS.h"
+#include "gnss_signal_id.h"
+#include "rtklib_conversions.h"
+#include "rtklib_ephemeris.h"
+#include "rtklib_rtkcmn.h"
+#include "rtklib_rtkpos.h"
+#include <glog/logging.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+// RTKLIB frequency index of the observables of a signal, as in Rtklib_Solver::get_PVT()
+int rtklib_band(const Gnss_Synchro& gnss_synchro)
+{
+    switch (gnss_signal_id(gnss_synchro))
+        {
+        case SIGNAL_GPS_1C:
+        case SIGNAL_GAL_1B:
+        case SIGNAL_GLO_1G:
+        case SIGNAL_BDS_B1:
+            return 0;
+        case SIGNAL_GPS_2S:
+        case SIGNAL_GLO_2G:
+            return 1;
+        case SIGNAL_GPS_L5:
+        case SIGNAL_GAL_5X:
+        case SIGNAL_GAL_7X:
+        case SIGNAL_BDS_B3:
+            return 2;
+        default:
+            return -1;
+        }
+}
+}  // namespace
+
+
+Attitude_Solver::Attitude_Solver(const prcopt_t& opt, uint32_t n_antennas, double baseline_length_m, double baseline_sigma_m)
+    : d_rtk(n_antennas > 1 ? n_antennas - 1 : 0),
+      d_solutions(d_rtk.size())
+{
+    prcopt_t baseline_opt = opt;
+    baseline_opt.mode = PMODE_MOVEB;
+    baseline_opt.ionoopt = IONOOPT_OFF;  // short baselines: the atmospheric delays cancel
+    baseline_opt.tropopt = TROPOPT_OFF;
+    baseline_opt.intpref = 0;
+    baseline_opt.baseline[0] = std::max(baseline_length_m, 0.0);
+    baseline_opt.baseline[1] = baseline_sigma_m;
+    for (size_t k = 0; k < d_rtk.size(); k++)
+        {
+            rtkinit(&d_rtk[k], &baseline_opt);
+            if (k > 0)
+                {
+                    // the baselines are solved one after the other, so they can use the same workspaces
+                    std::free(d_rtk[k].ws);
+                    d_rtk[k].ws = d_rtk[0].ws;
+                }
+            d_solutions[k].antenna = static_cast<uint32_t>(k + 1);
+        }
+    d_base_obs.reserve(MAXOBS);
+    d_rover_slots.reserve(MAXOBS);
+    d_obs.reserve(2 * MAXOBS);
+}
+
+
+Attitude_Solver::~Attitude_Solver()
+{
+    for (size_t k = 0; k < d_rtk.size(); k++)
+        {
+            if (k > 0)
+                {
+                    d_rtk[k].ws = nullptr;  // freed with the first baseline
+                }
+            rtkfree(&d_rtk[k]);
+        }
+}
+
+
+const std::vector<Attitude_Solution>& Attitude_Solver::solve(const obsd_t* base_obs, int n_base,
+    const nav_t* nav,
+    const sol_t& base_sol,
+    const std::vector<std::map<int, Gnss_Synchro>>& antenna_observables)
+{
+    for (auto& solution : d_solutions)
+        {
+            solution.status = SOLQ_NONE;
+            solution.satellites = 0;
+        }
+    if (n_base < 4 || d_rtk.empty())
+        {
+            return d_solutions;
+        }
+
+    // observations of the main antenna, sorted by satellite as relpos expects
+    d_base_obs.assign(base_obs, base_obs + n_base);
+    std::sort(d_base_obs.begin(), d_base_obs.end(), [](const obsd_t& a, const obsd_t& b) { return a.sat < b.sat; });
+    d_base_index.fill(-1);
+    for (int i = 0; i < n_base; i++)
+        {
+            d_base_obs[i].rcv = 2;
+            d_base_index[d_base_obs[i].sat - 1] = i;
+        }
+
+    // satellite positions and clocks, once for all the baselines
+    d_rs.resize(6 * n_base);
+    d_dts.resize(2 * n_base);
+    d_var.resize(n_base);
+    d_svh.resize(n_base);
+    satposs(d_base_obs[0].time, d_base_obs.data(), n_base, nav, d_rtk[0].opt.sateph, d_rs.data(), d_dts.data(), d_var.data(), d_svh.data());
+
+    const size_t n_baselines = std::min(d_rtk.size(), antenna_observables.size());
+    for (size_t k = 0; k < n_baselines; k++)
+        {
+            // observations of the antenna, of the satellites also seen by the main antenna
+            d_rover_slots.assign(n_base, obsd_t{});
+            for (const auto& observable : antenna_observables[k])
+                {
+                    const int band = rtklib_band(observable.second);
+                    if (band < 0)
+                        {
+                            continue;
+                        }
+                    obsd_t obs{};
+                    insert_obs_to_rtklib(obs, observable.second, 0, band);
+                    const int index = (obs.sat > 0 && obs.sat <= MAXSAT) ? d_base_index[obs.sat - 1] : -1;
+                    if (index < 0)
+                        {
+                            continue;
+                        }
+                    obsd_t& slot = d_rover_slots[index];
+                    if (slot.sat == 0)
+                        {
+                            slot = obs;
+                        }
+                    else
+                        {
+                            // another signal of the same satellite
+                            slot.P[band] = obs.P[band];
+                            slot.L[band] = obs.L[band];
+                            slot.D[band] = obs.D[band];
+                            slot.SNR[band] = obs.SNR[band];
+                            slot.code[band] = obs.code[band];
+                        }
+                }
+
+            d_obs.clear();
+            d_baseline_rs.clear();
+            d_baseline_dts.clear();
+            d_baseline_svh.clear();
+            for (int i = 0; i < n_base; i++)
+                {
+                    if (d_rover_slots[i].sat == 0)
+                        {
+                            continue;
+                        }
+                    // same receiver clock and epoch as the main antenna
+                    d_rover_slots[i].time = d_base_obs[i].time;
+                    d_obs.push_back(d_rover_slots[i]);
+                    d_baseline_rs.insert(d_baseline_rs.end(), d_rs.cbegin() + 6 * i, d_rs.cbegin() + 6 * (i + 1));
+                    d_baseline_dts.insert(d_baseline_dts.end(), d_dts.cbegin() + 2 * i, d_dts.cbegin() + 2 * (i + 1));
+                    d_baseline_svh.push_back(d_svh[i]);
+                }
+            const int nu = static_cast<int>(d_obs.size());
+            if (nu < 4)
+                {
+                    continue;
+                }
+            d_obs.insert(d_obs.end(), d_base_obs.cbegin(), d_base_obs.cend());
+            d_baseline_rs.insert(d_baseline_rs.end(), d_rs.cbegin(), d_rs.cend());
+            d_baseline_dts.insert(d_baseline_dts.end(), d_dts.cbegin(), d_dts.cend());
+            d_baseline_svh.insert(d_baseline_svh.end(), d_svh.cbegin(), d_svh.cend());
+
+            // the main antenna is the moving base, and its previous baseline the a priori of the antenna
+            rtk_t& rtk = d_rtk[k];
+            Attitude_Solution& solution = d_solutions[k];
+            const bool has_baseline = rtk.sol.stat == SOLQ_FIX || rtk.sol.stat == SOLQ_FLOAT;
+            for (int i = 0; i < 6; i++)
+                {
+                    rtk.rb[i] = base_sol.rr[i];
+                    rtk.sol.rr[i] = base_sol.rr[i] + ((i < 3 && has_baseline) ? solution.baseline_ecef[i] : 0.0);
+                }
+            if (rtk.sol.time.time != 0)
+                {
+                    rtk.tt = timediff(d_base_obs[0].time, rtk.sol.time);
+                }
+            rtk.sol.time = d_base_obs[0].time;
+            rtk.sol.stat = SOLQ_NONE;
+
+            if (relpos_geom(&rtk, d_obs.data(), nu, n_base, nav, d_baseline_rs.data(), d_baseline_dts.data(), d_baseline_svh.data()) == 0)
+                {
+                    DLOG(INFO) << "Baseline to antenna " << solution.antenna << " not solved: " << rtk.errbuf;
+                    rtk.neb = 0;  // clear error buffer to avoid repeating the error message
+                    continue;
+                }
+            rtk.neb = 0;
+            for (int i = 0; i < 3; i++)
+                {
+                    solution.baseline_ecef[i] = rtk.sol.rr[i] - rtk.rb[i];
+                }
+            baseline_attitude(rtk.rb, solution);
+            solution.time = rtk.sol.time;
+            solution.ratio = rtk.sol.ratio;
+            solution.satellites = rtk.sol.ns;
+            solution.status = rtk.sol.stat;
+        }
+    return d_solutions;
+}
+
+
+void Attitude_Solver::baseline_attitude(const double* rb, Attitude_Solution& solution)
+{
+    std::array<double, 3> pos{};
+    ecef2pos(rb, pos.data());
+    ecef2enu(pos.data(), solution.baseline_ecef.data(), solution.baseline_enu.data());
+    const double east = solution.baseline_enu[0];
+    const double north = solution.baseline_enu[1];
+    const double up = solution.baseline_enu[2];
+    const double horizontal = std::sqrt(east * east + north * north);
+    solution.length_m = std::sqrt(horizontal * horizontal + up * up);
+    double heading_rad = std::atan2(east, north);
+    if (heading_rad < 0.0)
+        {
+            heading_rad += TWO_PI;
+        }
+    solution.heading_deg = heading_rad * R2D;
+    solution.pitch_deg = std::atan2(up, horizontal) * R2D;
+}
@@ -0,0 +1,121 @@
+/*!
+ * \file attitude_solver.h
+ * \brief Heading and pitch of a vehicle from the short baselines between
+ * several antennas of the receiver.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ATTITUDE_SOLVER_H
+#define GNSS_SDR_ATTITUDE_SOLVER_H
+
+#include "gnss_synchro.h"
+#include "rtklib.h"
+#include <array>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+/** \addtogroup PVT
+ * \{ */
+/** \addtogroup PVT_libs
+ * \{ */
+
+
+/*!
+ * \brief Baseline from the main antenna to another antenna of the receiver
+ */
+struct Attitude_Solution
+{
+    std::array<double, 3> baseline_ecef{};  //!< Baseline, ECEF [m]
+    std::array<double, 3> baseline_enu{};   //!< Baseline, East, North and Up at the main antenna [m]
+    gtime_t time{};                         //!< Time of the epoch (GPS time)
+    double length_m{0.0};                   //!< Length of the baseline [m]
+    double heading_deg{0.0};                //!< Azimuth of the baseline, clockwise from the North, in [0, 360) [deg]
+    double pitch_deg{0.0};                  //!< Elevation of the baseline over the horizon [deg]
+    double ratio{0.0};                      //!< Ratio factor of the ambiguity validation
+    uint32_t antenna{0};                    //!< Antenna at the end of the baseline (RF channel)
+    uint32_t satellites{0};                 //!< Satellites used in the solution
+    int status{SOLQ_NONE};                  //!< SOLQ_FIX, SOLQ_FLOAT or SOLQ_NONE
+};
+
+
+/*!
+ * \brief Solves the baselines from the main antenna (antenna 0) to each of
+ * the other antennas of the receiver, whose channels share the receiver
+ * clock and the observables epochs, by relative positioning in moving-base
+ * mode with the main antenna as base.
+ *
+ * The satellite positions and clocks are computed once per epoch, for the
+ * observations of the main antenna, and shared by all the baselines. The
+ * baselines are short, so the atmospheric delays cancel in the double
+ * differences and they are not modeled. The baselines are solved one after
+ * the other, so they share the LAMBDA workspaces, allocated once.
+ */
+class Attitude_Solver
+{
+public:
+    /*!
+     * \brief opt are the processing options of the main antenna (frequencies,
+     * elevation mask, ambiguity resolution, dynamics). If baseline_length_m
+     * is positive, the length of the baselines is constrained to it, with a
+     * standard deviation of baseline_sigma_m.
+     */
+    Attitude_Solver(const prcopt_t& opt, uint32_t n_antennas, double baseline_length_m = 0.0, double baseline_sigma_m = 0.01);
+    ~Attitude_Solver();
+
+    Attitude_Solver(const Attitude_Solver&) = delete;
+    Attitude_Solver& operator=(const Attitude_Solver&) = delete;
+
+    /*!
+     * \brief Solves the baselines of an epoch. base_obs are the n_base
+     * observations of the main antenna given to its positioning, nav its
+     * navigation data and base_sol its position and velocity.
+     * antenna_observables[a - 1] are the observables of the epoch of
+     * antenna a, for a in [1, n_antennas). Returns one solution per
+     * baseline.
+     */
+    const std::vector<Attitude_Solution>& solve(const obsd_t* base_obs, int n_base,
+        const nav_t* nav,
+        const sol_t& base_sol,
+        const std::vector<std::map<int, Gnss_Synchro>>& antenna_observables);
+
+    /*!
+     * \brief Fills the length, the ENU components, the heading and the pitch
+     * of solution from its ECEF baseline, at the base position rb (ECEF)
+     */
+    static void baseline_attitude(const double* rb, Attitude_Solution& solution);
+
+    inline uint32_t n_antennas() const
+    {
+        return static_cast<uint32_t>(d_rtk.size()) + 1;
+    }
+
+private:
+    std::vector<rtk_t> d_rtk;  // one per baseline, sharing the LAMBDA workspaces of the first one
+    std::vector<Attitude_Solution> d_solutions;
+    std::vector<obsd_t> d_base_obs;      // observations of the main antenna, by satellite
+    std::vector<obsd_t> d_rover_slots;   // observations of an antenna, at the index of the satellite in d_base_obs
+    std::vector<obsd_t> d_obs;           // observations of a baseline: antenna, then main antenna
+    std::vector<double> d_rs;            // satellite positions and velocities of d_base_obs
+    std::vector<double> d_dts;           // satellite clocks of d_base_obs
+    std::vector<double> d_var;           // variances of the satellite positions of d_base_obs
+    std::vector<int> d_svh;              // satellite health flags of d_base_obs
+    std::vector<double> d_baseline_rs;   // satellite positions and velocities of d_obs
+    std::vector<double> d_baseline_dts;  // satellite clocks of d_obs
+    std::vector<int> d_baseline_svh;     // satellite health flags of d_obs
+    std::array<int, MAXSAT> d_base_index{};  // index in d_base_obs by satellite number - 1, or -1
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_ATTITUDE_SOLVER_H
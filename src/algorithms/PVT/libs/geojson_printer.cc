@@ -28,8 +28,11 @@
 #include <sstream>    // for stringstream
 
 
-GeoJSON_Printer::GeoJSON_Printer(const std::string& base_path) : geojson_base_path(base_path),
-                                                                 first_pos(true)
+GeoJSON_Printer::GeoJSON_Printer(const std::string& base_path,
+    uint32_t flush_period_ms,
+    uint32_t rotation_period_s) : d_schedule(flush_period_ms, rotation_period_s),
+                                  geojson_base_path(base_path),
+                                  first_pos(true)
 {
     fs::path full_path(fs::current_path());
     const fs::path p(geojson_base_path);
@@ -126,6 +129,10 @@ bool GeoJSON_Printer::set_headers(const std::string& filename, bool time_tag_nam
             filename_ = filename + ".geojson";
         }
     filename_ = geojson_base_path + filename_;
+    if (name_.empty())
+        {
+            name_ = filename;  // the rotated files are named after the first one
+        }
 
     geojson_file.open(filename_.c_str());
 
@@ -175,17 +182,30 @@ bool GeoJSON_Printer::print_position(const Pvt_Solution* const position, bool pr
             height = position->get_avg_height();
         }
 
+    if (d_schedule.rotation_due(position->get_position_UTC_time()))
+        {
+            // tagged with the time of the solution, since the samples may
+            // be processed faster than real time
+            close_file();
+            set_headers(name_ + "_" + boost::posix_time::to_iso_string(position->get_position_UTC_time()).substr(0, 15), false);
+        }
+
     if (geojson_file.is_open())
         {
+            d_line.clear();
             if (first_pos == true)
                 {
-                    geojson_file << "       [" << longitude << ", " << latitude << ", " << height << "]";
                     first_pos = false;
                 }
             else
                 {
-                    geojson_file << ",\n";
-                    geojson_file << "       [" << longitude << ", " << latitude << ", " << height << "]";
+                    d_line.append(",\n");
+                }
+            d_line.append("       [").append_fixed(longitude, PRECISION).append(", ").append_fixed(latitude, PRECISION).append(", ").append_fixed(height, PRECISION).append(']');
+            d_line.write_to(geojson_file);
+            if (d_schedule.flush_due())
+                {
+                    geojson_file.flush();
                 }
             return true;
         }
@@ -20,6 +20,8 @@
 #define GNSS_SDR_GEOJSON_PRINTER_H
 
 
+#include "pvt_text_output.h"
+#include <cstdint>
 #include <fstream>
 #include <string>
 
@@ -39,15 +41,19 @@ class Pvt_Solution;
 class GeoJSON_Printer
 {
 public:
-    explicit GeoJSON_Printer(const std::string& base_path = ".");
+    explicit GeoJSON_Printer(const std::string& base_path = ".", uint32_t flush_period_ms = 1000, uint32_t rotation_period_s = 0);
     ~GeoJSON_Printer();
     bool set_headers(const std::string& filename, bool time_tag_name = true);
     bool print_position(const Pvt_Solution* const position, bool print_average_values);
     bool close_file();
 
 private:
+    static constexpr int PRECISION = 14;  // decimal digits of the numbers
+    Pvt_Text_Buffer d_line;
+    Pvt_Output_Schedule d_schedule;
     std::ofstream geojson_file;
     std::string filename_;
+    std::string name_;  // name given to the first set_headers()
     std::string geojson_base_path;
     bool first_pos;
 };
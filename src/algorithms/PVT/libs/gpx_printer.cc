@@ -28,9 +28,12 @@
 #include <sstream>    // for stringstream
 
 
-Gpx_Printer::Gpx_Printer(const std::string& base_path) : indent("  "),
-                                                         gpx_base_path(base_path),
-                                                         positions_printed(false)
+Gpx_Printer::Gpx_Printer(const std::string& base_path,
+    uint32_t flush_period_ms,
+    uint32_t rotation_period_s) : d_schedule(flush_period_ms, rotation_period_s),
+                                  indent("  "),
+                                  gpx_base_path(base_path),
+                                  positions_printed(false)
 {
     fs::path full_path(fs::current_path());
     const fs::path p(gpx_base_path);
@@ -114,6 +117,10 @@ bool Gpx_Printer::set_headers(const std::string& filename, bool time_tag_name)
         }
 
     gpx_filename = gpx_base_path + gpx_filename;
+    if (gpx_name.empty())
+        {
+            gpx_name = filename;  // the rotated files are named after the first one
+        }
     gpx_file.open(gpx_filename.c_str());
 
     if (gpx_file.is_open())
@@ -154,13 +161,6 @@ bool Gpx_Printer::print_position(const Pvt_Solution* const position, bool print_
     const double hdop = position->get_hdop();
     const double vdop = position->get_vdop();
     const double pdop = position->get_pdop();
-    std::string utc_time = to_iso_extended_string(position->get_position_UTC_time());
-    if (utc_time.length() < 23)
-        {
-            utc_time += ".";
-        }
-    utc_time.resize(23, '0');  // time up to ms
-    utc_time.append("Z");      // UTC time zone
 
     if (print_average_values == false)
         {
@@ -175,15 +175,29 @@ bool Gpx_Printer::print_position(const Pvt_Solution* const position, bool print_
             height = position->get_avg_height();
         }
 
+    if (d_schedule.rotation_due(position->get_position_UTC_time()))
+        {
+            // tagged with the time of the solution, since the samples may
+            // be processed faster than real time
+            close_file();
+            set_headers(gpx_name + "_" + boost::posix_time::to_iso_string(position->get_position_UTC_time()).substr(0, 15), false);
+        }
+
     if (gpx_file.is_open())
         {
-            gpx_file << indent << indent << indent << "<trkpt lon=\"" << longitude << "\" lat=\"" << latitude << "\"><ele>" << height << "</ele>"
-                     << "<time>" << utc_time << "</time>"
-                     << "<hdop>" << hdop << "</hdop><vdop>" << vdop << "</vdop><pdop>" << pdop << "</pdop>"
-                     << "<extensions><gpxtpx:TrackPointExtension>"
-                     << "<gpxtpx:speed>" << speed_over_ground << "</gpxtpx:speed>"
-                     << "<gpxtpx:course>" << course_over_ground << "</gpxtpx:course>"
-                     << "</gpxtpx:TrackPointExtension></extensions></trkpt>\n";
+            d_line.clear();
+            d_line.append(indent, 3).append("<trkpt lon=\"").append_fixed(longitude, PRECISION).append("\" lat=\"").append_fixed(latitude, PRECISION).append("\"><ele>").append_fixed(height, PRECISION).append("</ele>");
+            d_line.append("<time>").append_iso_time(position->get_position_UTC_time()).append("</time>");
+            d_line.append("<hdop>").append_fixed(hdop, PRECISION).append("</hdop><vdop>").append_fixed(vdop, PRECISION).append("</vdop><pdop>").append_fixed(pdop, PRECISION).append("</pdop>");
+            d_line.append("<extensions><gpxtpx:TrackPointExtension>");
+            d_line.append("<gpxtpx:speed>").append_fixed(speed_over_ground, PRECISION).append("</gpxtpx:speed>");
+            d_line.append("<gpxtpx:course>").append_fixed(course_over_ground, PRECISION).append("</gpxtpx:course>");
+            d_line.append("</gpxtpx:TrackPointExtension></extensions></trkpt>\n");
+            d_line.write_to(gpx_file);
+            if (d_schedule.flush_due())
+                {
+                    gpx_file.flush();
+                }
             return true;
         }
     return false;
@@ -20,6 +20,8 @@
 #define GNSS_SDR_GPX_PRINTER_H
 
 
+#include "pvt_text_output.h"
+#include <cstdint>
 #include <fstream>
 #include <string>
 
@@ -39,15 +41,19 @@ class Pvt_Solution;
 class Gpx_Printer
 {
 public:
-    explicit Gpx_Printer(const std::string& base_path = ".");
+    explicit Gpx_Printer(const std::string& base_path = ".", uint32_t flush_period_ms = 1000, uint32_t rotation_period_s = 0);
     ~Gpx_Printer();
     bool set_headers(const std::string& filename, bool time_tag_name = true);
     bool print_position(const Pvt_Solution* const position, bool print_average_values);
     bool close_file();
 
 private:
+    static constexpr int PRECISION = 14;  // decimal digits of the numbers
+    Pvt_Text_Buffer d_line;
+    Pvt_Output_Schedule d_schedule;
     std::ofstream gpx_file;
     std::string gpx_filename;
+    std::string gpx_name;  // name given to the first set_headers()
     std::string indent;
     std::string gpx_base_path;
     bool positions_printed;
@@ -30,9 +30,12 @@
 #include <sys/types.h>  // for mode_t
 
 
-Kml_Printer::Kml_Printer(const std::string& base_path) : kml_base_path(base_path),
-                                                         indent("  "),
-                                                         positions_printed(false)
+Kml_Printer::Kml_Printer(const std::string& base_path,
+    uint32_t flush_period_ms,
+    uint32_t rotation_period_s) : d_schedule(flush_period_ms, rotation_period_s),
+                                  kml_base_path(base_path),
+                                  indent("  "),
+                                  positions_printed(false)
 {
     fs::path full_path(fs::current_path());
     const fs::path p(kml_base_path);
@@ -133,6 +136,10 @@ bool Kml_Printer::set_headers(const std::string& filename, bool time_tag_name)
             kml_filename = filename + ".kml";
         }
     kml_filename = kml_base_path + kml_filename;
+    if (kml_name.empty())
+        {
+            kml_name = filename;  // the rotated files are named after the first one
+        }
     kml_file.open(kml_filename.c_str());
 
     tmp_file.open(tmp_file_str.c_str());
@@ -223,13 +230,6 @@ bool Kml_Printer::print_position(const Pvt_Solution* const position, bool print_
     const double hdop = position->get_hdop();
     const double vdop = position->get_vdop();
     const double pdop = position->get_pdop();
-    std::string utc_time = to_iso_extended_string(position->get_position_UTC_time());
-    if (utc_time.length() < 23)
-        {
-            utc_time += ".";
-        }
-    utc_time.resize(23, '0');  // time up to ms
-    utc_time.append("Z");      // UTC time zone
 
     if (print_average_values == false)
         {
@@ -244,38 +244,53 @@ bool Kml_Printer::print_position(const Pvt_Solution* const position, bool print_
             height = position->get_avg_height();
         }
 
+    if (d_schedule.rotation_due(position->get_position_UTC_time()))
+        {
+            // tagged with the time of the solution, since the samples may
+            // be processed faster than real time
+            close_file();
+            set_headers(kml_name + "_" + boost::posix_time::to_iso_string(position->get_position_UTC_time()).substr(0, 15), false);
+        }
+
     if (kml_file.is_open() && tmp_file.is_open())
         {
             point_id++;
-            kml_file << indent << indent << indent << "<Placemark>\n"
-                     << indent << indent << indent << indent << "<name>" << point_id << "</name>\n"
-                     << indent << indent << indent << indent << "<snippet/>\n"
-                     << indent << indent << indent << indent << "<description><![CDATA[\n"
-                     << indent << indent << indent << indent << indent << "<table>\n"
-                     << indent << indent << indent << indent << indent << indent << "<tr><td>Time:</td><td>" << utc_time << "</td></tr>\n"
-                     << indent << indent << indent << indent << indent << indent << "<tr><td>Longitude:</td><td>" << longitude << "</td><td>deg</td></tr>\n"
-                     << indent << indent << indent << indent << indent << indent << "<tr><td>Latitude:</td><td>" << latitude << "</td><td>deg</td></tr>\n"
-                     << indent << indent << indent << indent << indent << indent << "<tr><td>Altitude:</td><td>" << height << "</td><td>m</td></tr>\n"
-                     << indent << indent << indent << indent << indent << indent << "<tr><td>Speed:</td><td>" << speed_over_ground << "</td><td>m/s</td></tr>\n"
-                     << indent << indent << indent << indent << indent << indent << "<tr><td>Course:</td><td>" << course_over_ground << "</td><td>deg</td></tr>\n"
-                     << indent << indent << indent << indent << indent << indent << "<tr><td>HDOP:</td><td>" << hdop << "</td></tr>\n"
-                     << indent << indent << indent << indent << indent << indent << "<tr><td>VDOP:</td><td>" << vdop << "</td></tr>\n"
-                     << indent << indent << indent << indent << indent << indent << "<tr><td>PDOP:</td><td>" << pdop << "</td></tr>\n"
-                     << indent << indent << indent << indent << indent << "</table>\n"
-                     << indent << indent << indent << indent << "]]></description>\n"
-                     << indent << indent << indent << indent << "<TimeStamp>\n"
-                     << indent << indent << indent << indent << indent << "<when>" << utc_time << "</when>\n"
-                     << indent << indent << indent << indent << "</TimeStamp>\n"
-                     << indent << indent << indent << indent << "<styleUrl>#track</styleUrl>\n"
-                     << indent << indent << indent << indent << "<Point>\n"
-                     << indent << indent << indent << indent << indent << "<altitudeMode>absolute</altitudeMode>\n"
-                     << indent << indent << indent << indent << indent << "<coordinates>" << longitude << "," << latitude << "," << height << "</coordinates>\n"
-                     << indent << indent << indent << indent << "</Point>\n"
-                     << indent << indent << indent << "</Placemark>\n";
-
-            tmp_file << indent << indent << indent << indent << indent
-                     << longitude << "," << latitude << "," << height << '\n';
-
+            d_line.clear();
+            d_line.append(indent, 3).append("<Placemark>\n");
+            d_line.append(indent, 4).append("<name>").append_uint(point_id).append("</name>\n");
+            d_line.append(indent, 4).append("<snippet/>\n");
+            d_line.append(indent, 4).append("<description><![CDATA[\n");
+            d_line.append(indent, 5).append("<table>\n");
+            d_line.append(indent, 6).append("<tr><td>Time:</td><td>").append_iso_time(position->get_position_UTC_time()).append("</td></tr>\n");
+            d_line.append(indent, 6).append("<tr><td>Longitude:</td><td>").append_fixed(longitude, PRECISION).append("</td><td>deg</td></tr>\n");
+            d_line.append(indent, 6).append("<tr><td>Latitude:</td><td>").append_fixed(latitude, PRECISION).append("</td><td>deg</td></tr>\n");
+            d_line.append(indent, 6).append("<tr><td>Altitude:</td><td>").append_fixed(height, PRECISION).append("</td><td>m</td></tr>\n");
+            d_line.append(indent, 6).append("<tr><td>Speed:</td><td>").append_fixed(speed_over_ground, PRECISION).append("</td><td>m/s</td></tr>\n");
+            d_line.append(indent, 6).append("<tr><td>Course:</td><td>").append_fixed(course_over_ground, PRECISION).append("</td><td>deg</td></tr>\n");
+            d_line.append(indent, 6).append("<tr><td>HDOP:</td><td>").append_fixed(hdop, PRECISION).append("</td></tr>\n");
+            d_line.append(indent, 6).append("<tr><td>VDOP:</td><td>").append_fixed(vdop, PRECISION).append("</td></tr>\n");
+            d_line.append(indent, 6).append("<tr><td>PDOP:</td><td>").append_fixed(pdop, PRECISION).append("</td></tr>\n");
+            d_line.append(indent, 5).append("</table>\n");
+            d_line.append(indent, 4).append("]]></description>\n");
+            d_line.append(indent, 4).append("<TimeStamp>\n");
+            d_line.append(indent, 5).append("<when>").append_iso_time(position->get_position_UTC_time()).append("</when>\n");
+            d_line.append(indent, 4).append("</TimeStamp>\n");
+            d_line.append(indent, 4).append("<styleUrl>#track</styleUrl>\n");
+            d_line.append(indent, 4).append("<Point>\n");
+            d_line.append(indent, 5).append("<altitudeMode>absolute</altitudeMode>\n");
+            d_line.append(indent, 5).append("<coordinates>").append_fixed(longitude, PRECISION).append(',').append_fixed(latitude, PRECISION).append(',').append_fixed(height, PRECISION).append("</coordinates>\n");
+            d_line.append(indent, 4).append("</Point>\n");
+            d_line.append(indent, 3).append("</Placemark>\n");
+            d_line.write_to(kml_file);
+
+            d_line.clear();
+            d_line.append(indent, 5).append_fixed(longitude, PRECISION).append(',').append_fixed(latitude, PRECISION).append(',').append_fixed(height, PRECISION).append('\n');
+            d_line.write_to(tmp_file);
+
+            if (d_schedule.flush_due())
+                {
+                    kml_file.flush();
+                }
             return true;
         }
     return false;
@@ -19,6 +19,8 @@
 #ifndef GNSS_SDR_KML_PRINTER_H
 #define GNSS_SDR_KML_PRINTER_H
 
+#include "pvt_text_output.h"
+#include <cstdint>
 #include <fstream>  // for ofstream
 #include <string>
 
@@ -38,16 +40,20 @@ class Pvt_Solution;
 class Kml_Printer
 {
 public:
-    explicit Kml_Printer(const std::string& base_path = std::string("."));
+    explicit Kml_Printer(const std::string& base_path = std::string("."), uint32_t flush_period_ms = 1000, uint32_t rotation_period_s = 0);
     ~Kml_Printer();
     bool set_headers(const std::string& filename, bool time_tag_name = true);
     bool print_position(const Pvt_Solution* const position, bool print_average_values);
     bool close_file();
 
 private:
+    static constexpr int PRECISION = 14;  // decimal digits of the numbers
+    Pvt_Text_Buffer d_line;
+    Pvt_Output_Schedule d_schedule;
     std::ofstream kml_file;
     std::ofstream tmp_file;
     std::string kml_filename;
+    std::string kml_name;  // name given to the first set_headers()
     std::string kml_base_path;
     std::string tmp_file_str;
     std::string indent;
@@ -17,20 +17,15 @@
 
 #include "monitor_ephemeris_udp_sink.h"
 #include <boost/archive/binary_oarchive.hpp>
-#include <iostream>
-#include <sstream>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/stream.hpp>
 
 
 Monitor_Ephemeris_Udp_Sink::Monitor_Ephemeris_Udp_Sink(const std::vector<std::string>& addresses,
     const uint16_t& port,
-    bool protobuf_enabled) : socket{io_context},
+    bool protobuf_enabled) : sender(addresses, port),
                              use_protobuf(protobuf_enabled)
 {
-    for (const auto& address : addresses)
-        {
-            boost::asio::ip::udp::endpoint endpoint(boost::asio::ip::address::from_string(address, error), port);
-            endpoints.push_back(endpoint);
-        }
     if (use_protobuf)
         {
             serdes_gal = Serdes_Galileo_Eph();
@@ -41,73 +36,51 @@ Monitor_Ephemeris_Udp_Sink::Monitor_Ephemeris_Udp_Sink(const std::vector<std::st
 
 bool Monitor_Ephemeris_Udp_Sink::write_galileo_ephemeris(const std::shared_ptr<Galileo_Ephemeris>& monitor_gal_eph)
 {
-    std::string outbound_data;
-    if (use_protobuf == false)
+    std::string* outbound_data = sender.next_datagram();
+    if (outbound_data == nullptr)
         {
-            std::ostringstream archive_stream;
-            boost::archive::binary_oarchive oa{archive_stream};
-            oa << *monitor_gal_eph;
-            outbound_data = archive_stream.str();
+            return false;
         }
-    else
+    if (use_protobuf == false)
         {
-            outbound_data = "E";
-            outbound_data.append(serdes_gal.createProtobuffer(monitor_gal_eph));
+            boost::iostreams::stream<boost::iostreams::back_insert_device<std::string>> archive_stream(*outbound_data);
+            {
+                boost::archive::binary_oarchive oa{archive_stream};
+                oa << *monitor_gal_eph;
+            }
+            archive_stream.flush();
         }
-
-    for (const auto& endpoint : endpoints)
+    else
         {
-            socket.open(endpoint.protocol(), error);
-            socket.connect(endpoint, error);
-
-            try
-                {
-                    if (socket.send(boost::asio::buffer(outbound_data)) == 0)
-                        {
-                            return false;
-                        }
-                }
-            catch (boost::system::system_error const& e)
-                {
-                    return false;
-                }
+            outbound_data->push_back('E');
+            serdes_gal.createProtobuffer(monitor_gal_eph, *outbound_data);
         }
+    sender.submit();
     return true;
 }
 
 
 bool Monitor_Ephemeris_Udp_Sink::write_gps_ephemeris(const std::shared_ptr<Gps_Ephemeris>& monitor_gps_eph)
 {
-    std::string outbound_data;
-    if (use_protobuf == false)
+    std::string* outbound_data = sender.next_datagram();
+    if (outbound_data == nullptr)
         {
-            std::ostringstream archive_stream;
-            boost::archive::binary_oarchive oa{archive_stream};
-            oa << *monitor_gps_eph;
-            outbound_data = archive_stream.str();
+            return false;
         }
-    else
+    if (use_protobuf == false)
         {
-            outbound_data = "G";
-            outbound_data.append(serdes_gps.createProtobuffer(monitor_gps_eph));
+            boost::iostreams::stream<boost::iostreams::back_insert_device<std::string>> archive_stream(*outbound_data);
+            {
+                boost::archive::binary_oarchive oa{archive_stream};
+                oa << *monitor_gps_eph;
+            }
+            archive_stream.flush();
         }
-
-    for (const auto& endpoint : endpoints)
+    else
         {
-            socket.open(endpoint.protocol(), error);
-            socket.connect(endpoint, error);
-
-            try
-                {
-                    if (socket.send(boost::asio::buffer(outbound_data)) == 0)
-                        {
-                            return false;
-                        }
-                }
-            catch (boost::system::system_error const& e)
-                {
-                    return false;
-                }
+            outbound_data->push_back('G');
+            serdes_gps.createProtobuffer(monitor_gps_eph, *outbound_data);
         }
+    sender.submit();
     return true;
 }
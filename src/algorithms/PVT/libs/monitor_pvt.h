@@ -84,6 +84,12 @@ public:
     // User clock drift [ppm]
     double user_clk_drift_ppm;
 
+    // Time from the arrival of the samples of the epoch to the solution [ms], 0 if not measured
+    double latency_ms;
+
+    // Epochs of the receiver clock lost by the observables since the start, because they fell behind
+    uint64_t skipped_epochs;
+
     /*!
      * \brief This member function serializes and restores
      * Monitor_Pvt objects from a byte stream.
@@ -131,6 +137,8 @@ public:
         ar& BOOST_SERIALIZATION_NVP(vdop);
 
         ar& BOOST_SERIALIZATION_NVP(user_clk_drift_ppm);
+        ar& BOOST_SERIALIZATION_NVP(latency_ms);
+        ar& BOOST_SERIALIZATION_NVP(skipped_epochs);
     }
 };
 
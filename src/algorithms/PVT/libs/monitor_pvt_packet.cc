@@ -0,0 +1,214 @@
+/*!
+ * \file monitor_pvt_packet.cc
+ * \brief Fixed layout binary packet with the contents of a Monitor_Pvt
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "monitor_pvt_packet.h"
+#include <array>
+#include <cstring>  // for memcpy
+
+
+namespace
+{
+// CRC16-CCITT, polynomial x^16 + x^12 + x^5 + 1, as in the Advanced Navigation packets
+std::array<uint16_t, 256> make_crc16_table()
+{
+    std::array<uint16_t, 256> table{};
+    for (uint32_t i = 0; i < 256; i++)
+        {
+            auto crc = static_cast<uint16_t>(i << 8);
+            for (int bit = 0; bit < 8; bit++)
+                {
+                    crc = static_cast<uint16_t>((crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1);
+                }
+            table[i] = crc;
+        }
+    return table;
+}
+
+
+class Packet_Writer
+{
+public:
+    explicit Packet_Writer(uint8_t* out) : d_out(out) {}
+
+    template <class T>
+    void operator()(const T& value)
+    {
+        put(value);
+    }
+
+    void put(uint64_t value, int bytes)
+    {
+        for (int i = 0; i < bytes; i++)
+            {
+                *d_out++ = static_cast<uint8_t>(value >> (8 * i));
+            }
+    }
+
+    void put(uint8_t value) { put(value, 1); }
+    void put(uint32_t value) { put(value, 4); }
+    void put(uint64_t value) { put(value, 8); }
+
+    void put(float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        put(bits, 4);
+    }
+
+    void put(double value)
+    {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        put(bits, 8);
+    }
+
+private:
+    uint8_t* d_out;
+};
+
+
+class Packet_Reader
+{
+public:
+    explicit Packet_Reader(const uint8_t* in) : d_in(in) {}
+
+    template <class T>
+    void operator()(T& value)
+    {
+        get(value);
+    }
+
+    uint64_t get(int bytes)
+    {
+        uint64_t value = 0;
+        for (int i = 0; i < bytes; i++)
+            {
+                value |= static_cast<uint64_t>(*d_in++) << (8 * i);
+            }
+        return value;
+    }
+
+    void get(uint8_t& value) { value = static_cast<uint8_t>(get(1)); }
+    void get(uint32_t& value) { value = static_cast<uint32_t>(get(4)); }
+    void get(uint64_t& value) { value = get(8); }
+
+    void get(float& value)
+    {
+        const auto bits = static_cast<uint32_t>(get(4));
+        std::memcpy(&value, &bits, sizeof(value));
+    }
+
+    void get(double& value)
+    {
+        const uint64_t bits = get(8);
+        std::memcpy(&value, &bits, sizeof(value));
+    }
+
+private:
+    const uint8_t* d_in;
+};
+
+
+// The fields, in the order of the payload
+template <class Stream, class Pvt>
+void monitor_pvt_fields(Stream& s, Pvt& m)
+{
+    s(m.TOW_at_current_symbol_ms);
+    s(m.week);
+    s(m.RX_time);
+    s(m.user_clk_offset);
+    s(m.pos_x);
+    s(m.pos_y);
+    s(m.pos_z);
+    s(m.vel_x);
+    s(m.vel_y);
+    s(m.vel_z);
+    s(m.cov_xx);
+    s(m.cov_yy);
+    s(m.cov_zz);
+    s(m.cov_xy);
+    s(m.cov_yz);
+    s(m.cov_zx);
+    s(m.latitude);
+    s(m.longitude);
+    s(m.height);
+    s(m.valid_sats);
+    s(m.solution_status);
+    s(m.solution_type);
+    s(m.AR_ratio_factor);
+    s(m.AR_ratio_threshold);
+    s(m.gdop);
+    s(m.pdop);
+    s(m.hdop);
+    s(m.vdop);
+    s(m.user_clk_drift_ppm);
+    s(m.latency_ms);
+    s(m.skipped_epochs);
+}
+}  // namespace
+
+
+constexpr uint8_t Monitor_Pvt_Packet::SYNC_1;
+constexpr uint8_t Monitor_Pvt_Packet::SYNC_2;
+constexpr uint8_t Monitor_Pvt_Packet::VERSION;
+constexpr std::size_t Monitor_Pvt_Packet::HEADER_LENGTH;
+constexpr std::size_t Monitor_Pvt_Packet::PAYLOAD_LENGTH;
+constexpr std::size_t Monitor_Pvt_Packet::CRC_LENGTH;
+constexpr std::size_t Monitor_Pvt_Packet::LENGTH;
+
+
+void Monitor_Pvt_Packet::encode(const Monitor_Pvt& monitor_pvt, uint8_t* packet)
+{
+    Packet_Writer writer(packet);
+    writer.put(SYNC_1);
+    writer.put(SYNC_2);
+    writer.put(VERSION);
+    writer.put(PAYLOAD_LENGTH, 2);
+    monitor_pvt_fields(writer, monitor_pvt);
+    writer.put(crc16(packet, HEADER_LENGTH + PAYLOAD_LENGTH), 2);
+}
+
+
+bool Monitor_Pvt_Packet::decode(const uint8_t* packet, std::size_t length, Monitor_Pvt& monitor_pvt)
+{
+    if (length != LENGTH or packet[0] != SYNC_1 or packet[1] != SYNC_2 or packet[2] != VERSION)
+        {
+            return false;
+        }
+    Packet_Reader reader(packet + 3);
+    if (reader.get(2) != PAYLOAD_LENGTH)
+        {
+            return false;
+        }
+    Packet_Reader crc_reader(packet + HEADER_LENGTH + PAYLOAD_LENGTH);
+    if (crc_reader.get(CRC_LENGTH) != crc16(packet, HEADER_LENGTH + PAYLOAD_LENGTH))
+        {
+            return false;
+        }
+    monitor_pvt_fields(reader, monitor_pvt);
+    return true;
+}
+
+
+uint16_t Monitor_Pvt_Packet::crc16(const uint8_t* data, std::size_t length)
+{
+    static const std::array<uint16_t, 256> table = make_crc16_table();
+    uint16_t crc = 0xFFFF;
+    for (std::size_t i = 0; i < length; i++)
+        {
+            crc = static_cast<uint16_t>((crc << 8) ^ table[(crc >> 8) ^ data[i]]);
+        }
+    return crc;
+}
@@ -0,0 +1,79 @@
+/*!
+ * \file monitor_pvt_packet.h
+ * \brief Fixed layout binary packet with the contents of a Monitor_Pvt
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_MONITOR_PVT_PACKET_H
+#define GNSS_SDR_MONITOR_PVT_PACKET_H
+
+#include "monitor_pvt.h"
+#include <cstddef>
+#include <cstdint>
+
+/** \addtogroup PVT
+ * \{ */
+/** \addtogroup PVT_libs
+ * \{ */
+
+
+/*!
+ * \brief Encodes and decodes the fields of a Monitor_Pvt in a binary packet
+ * of fixed length, for consumers that cannot afford to parse text or to link
+ * against Protocol Buffers or Boost.Serialization.
+ *
+ * Layout (all the numbers in little endian byte order):
+ *
+ * | Offset | Size | Contents                                              |
+ * |--------|------|-------------------------------------------------------|
+ * | 0      | 2    | Sync bytes 0x47 0x53 ("GS")                           |
+ * | 2      | 1    | Version of the layout (2)                             |
+ * | 3      | 2    | Length of the payload, PAYLOAD_LENGTH                 |
+ * | 5      | 211  | Fields of Monitor_Pvt in declaration order, with the  |
+ * |        |      | native sizes (uint32, double, uint8, float, uint64),  |
+ * |        |      | unpadded                                              |
+ * | 216    | 2    | CRC-16-CCITT (initial value 0xFFFF) of bytes 0 to 215 |
+ *
+ * New versions only append fields to the payload, so that a consumer of
+ * version 1 can read the first 203 bytes of the payload of any version.
+ * Version 2 appends skipped_epochs.
+ */
+class Monitor_Pvt_Packet
+{
+public:
+    static constexpr uint8_t SYNC_1 = 0x47;
+    static constexpr uint8_t SYNC_2 = 0x53;
+    static constexpr uint8_t VERSION = 2;
+    static constexpr std::size_t HEADER_LENGTH = 5;
+    static constexpr std::size_t PAYLOAD_LENGTH = 211;
+    static constexpr std::size_t CRC_LENGTH = 2;
+    static constexpr std::size_t LENGTH = HEADER_LENGTH + PAYLOAD_LENGTH + CRC_LENGTH;
+
+    /*!
+     * \brief Writes the LENGTH bytes of the packet of monitor_pvt to packet
+     */
+    static void encode(const Monitor_Pvt& monitor_pvt, uint8_t* packet);
+
+    /*!
+     * \brief Reads a packet of length bytes into monitor_pvt. Returns false,
+     * leaving monitor_pvt unchanged, if the sync bytes, the version, the
+     * length or the CRC are wrong.
+     */
+    static bool decode(const uint8_t* packet, std::size_t length, Monitor_Pvt& monitor_pvt);
+
+    static uint16_t crc16(const uint8_t* data, std::size_t length);
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_MONITOR_PVT_PACKET_H
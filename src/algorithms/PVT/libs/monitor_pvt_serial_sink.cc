@@ -0,0 +1,103 @@
+/*!
+ * \file monitor_pvt_serial_sink.cc
+ * \brief Implementation of a class that writes Monitor_Pvt_Packet packets to
+ * a serial device
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "monitor_pvt_serial_sink.h"
+#include <glog/logging.h>
+#include <cerrno>
+#include <cstddef>
+#include <fcntl.h>    // for open, fcntl
+#include <termios.h>  // values for termios
+#include <unistd.h>   // for write, close
+
+
+Monitor_Pvt_Serial_Sink::Monitor_Pvt_Serial_Sink(const std::string& devname)
+    : d_devname(devname),
+      d_dev_descriptor(init_serial(devname))
+{
+    if (d_dev_descriptor != -1)
+        {
+            DLOG(INFO) << "PVT monitor writing binary packets on " << d_devname;
+        }
+    else
+        {
+            LOG(WARNING) << "PVT monitor cannot open the serial device " << d_devname;
+        }
+}
+
+
+Monitor_Pvt_Serial_Sink::~Monitor_Pvt_Serial_Sink()
+{
+    if (d_dev_descriptor != -1)
+        {
+            close(d_dev_descriptor);
+        }
+}
+
+
+bool Monitor_Pvt_Serial_Sink::write_monitor_pvt(const Monitor_Pvt* const monitor_pvt)
+{
+    if (d_dev_descriptor == -1)
+        {
+            return false;
+        }
+    Monitor_Pvt_Packet::encode(*monitor_pvt, d_packet.data());
+    const uint8_t* data = d_packet.data();
+    std::size_t pending = d_packet.size();
+    while (pending > 0)
+        {
+            const ssize_t written = write(d_dev_descriptor, data, pending);
+            if (written == -1)
+                {
+                    if (errno == EINTR)
+                        {
+                            continue;
+                        }
+                    LOG(ERROR) << "PVT monitor cannot write on serial device " << d_devname;
+                    return false;
+                }
+            data += written;
+            pending -= static_cast<std::size_t>(written);
+        }
+    return true;
+}
+
+
+int Monitor_Pvt_Serial_Sink::init_serial(const std::string& serial_device) const
+{
+    // clang-format off
+    struct termios options{};
+    // clang-format on
+    const int fd = open(serial_device.c_str(), O_RDWR | O_NOCTTY | O_NDELAY | O_CLOEXEC);
+    if (fd == -1)
+        {
+            return fd;  // failed to open TTY port
+        }
+
+    if (fcntl(fd, F_SETFL, 0) == -1)
+        {
+            LOG(INFO) << "Error enabling direct I/O";  // clear all flags on descriptor, enable direct I/O
+        }
+    tcgetattr(fd, &options);  // read serial port options
+
+    // 115200 bauds, 8 bit data, no parity, one stop bit, ignore control lines
+    options.c_cflag = B115200 | CS8 | CLOCAL | CREAD;
+    options.c_iflag = IGNPAR;
+    options.c_oflag = 0;  // raw output, so that no byte of the packets is translated
+    options.c_lflag = 0;
+
+    tcsetattr(fd, TCSANOW, &options);
+    return fd;
+}
@@ -0,0 +1,59 @@
+/*!
+ * \file monitor_pvt_serial_sink.h
+ * \brief Interface of a class that writes Monitor_Pvt_Packet packets to a
+ * serial device
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_MONITOR_PVT_SERIAL_SINK_H
+#define GNSS_SDR_MONITOR_PVT_SERIAL_SINK_H
+
+#include "monitor_pvt.h"
+#include "monitor_pvt_packet.h"
+#include <array>
+#include <cstdint>
+#include <string>
+
+/** \addtogroup PVT
+ * \{ */
+/** \addtogroup PVT_libs
+ * \{ */
+
+
+/*!
+ * \brief Writes each Monitor_Pvt as a Monitor_Pvt_Packet to a serial device
+ * (115200 bauds, 8N1), with a single write per packet.
+ */
+class Monitor_Pvt_Serial_Sink
+{
+public:
+    explicit Monitor_Pvt_Serial_Sink(const std::string& devname);
+    ~Monitor_Pvt_Serial_Sink();
+
+    Monitor_Pvt_Serial_Sink(const Monitor_Pvt_Serial_Sink&) = delete;
+    Monitor_Pvt_Serial_Sink& operator=(const Monitor_Pvt_Serial_Sink&) = delete;
+
+    bool is_open() const { return d_dev_descriptor != -1; }
+    bool write_monitor_pvt(const Monitor_Pvt* const monitor_pvt);
+
+private:
+    int init_serial(const std::string& serial_device) const;
+
+    std::array<uint8_t, Monitor_Pvt_Packet::LENGTH> d_packet{};
+    std::string d_devname;
+    int d_dev_descriptor;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_MONITOR_PVT_SERIAL_SINK_H
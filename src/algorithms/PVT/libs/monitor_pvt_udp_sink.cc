@@ -16,22 +16,19 @@
  */
 
 #include "monitor_pvt_udp_sink.h"
+#include "monitor_pvt_packet.h"
 #include <boost/archive/binary_oarchive.hpp>
-#include <iostream>
-#include <sstream>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/stream.hpp>
 
 
 Monitor_Pvt_Udp_Sink::Monitor_Pvt_Udp_Sink(const std::vector<std::string>& addresses,
     const uint16_t& port,
-    bool protobuf_enabled) : socket{io_context},
-                             use_protobuf(protobuf_enabled)
+    bool protobuf_enabled,
+    bool binary_enabled) : sender(addresses, port),
+                           use_protobuf(protobuf_enabled),
+                           use_binary(binary_enabled)
 {
-    for (const auto& address : addresses)
-        {
-            boost::asio::ip::udp::endpoint endpoint(boost::asio::ip::address::from_string(address, error), port);
-            endpoints.push_back(endpoint);
-        }
-
     if (use_protobuf)
         {
             serdes = Serdes_Monitor_Pvt();
@@ -41,35 +38,30 @@ Monitor_Pvt_Udp_Sink::Monitor_Pvt_Udp_Sink(const std::vector<std::string>& addre
 
 bool Monitor_Pvt_Udp_Sink::write_monitor_pvt(const Monitor_Pvt* const monitor_pvt)
 {
-    std::string outbound_data;
-    if (use_protobuf == false)
+    std::string* outbound_data = sender.next_datagram();
+    if (outbound_data == nullptr)
         {
-            std::ostringstream archive_stream;
-            boost::archive::binary_oarchive oa{archive_stream};
-            oa << *monitor_pvt;
-            outbound_data = archive_stream.str();
+            return false;
         }
-    else
+    if (use_binary)
         {
-            outbound_data = serdes.createProtobuffer(monitor_pvt);
+            // encoded in place, in the memory kept by the slot of the ring
+            outbound_data->resize(Monitor_Pvt_Packet::LENGTH);
+            Monitor_Pvt_Packet::encode(*monitor_pvt, reinterpret_cast<uint8_t*>(&(*outbound_data)[0]));
         }
-
-    for (const auto& endpoint : endpoints)
+    else if (use_protobuf == false)
         {
-            socket.open(endpoint.protocol(), error);
-            socket.connect(endpoint, error);
-
-            try
-                {
-                    if (socket.send(boost::asio::buffer(outbound_data)) == 0)
-                        {
-                            return false;
-                        }
-                }
-            catch (boost::system::system_error const& e)
-                {
-                    return false;
-                }
+            boost::iostreams::stream<boost::iostreams::back_insert_device<std::string>> archive_stream(*outbound_data);
+            {
+                boost::archive::binary_oarchive oa{archive_stream};
+                oa << *monitor_pvt;
+            }
+            archive_stream.flush();
+        }
+    else
+        {
+            serdes.createProtobuffer(monitor_pvt, *outbound_data);
         }
+    sender.submit();
     return true;
 }
@@ -18,9 +18,10 @@
 #ifndef GNSS_SDR_MONITOR_PVT_UDP_SINK_H
 #define GNSS_SDR_MONITOR_PVT_UDP_SINK_H
 
+#include "gnss_udp_sender.h"
 #include "monitor_pvt.h"
 #include "serdes_monitor_pvt.h"
-#include <boost/asio.hpp>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -31,25 +32,21 @@
  * \{ */
 
 
-#if USE_BOOST_ASIO_IO_CONTEXT
-using b_io_context = boost::asio::io_context;
-#else
-using b_io_context = boost::asio::io_service;
-#endif
-
 class Monitor_Pvt_Udp_Sink
 {
 public:
-    Monitor_Pvt_Udp_Sink(const std::vector<std::string>& addresses, const uint16_t& port, bool protobuf_enabled);
+    /*!
+     * \brief The datagrams are Monitor_Pvt_Packet packets if binary_enabled,
+     * else Protocol Buffers if protobuf_enabled, else Boost binary archives.
+     */
+    Monitor_Pvt_Udp_Sink(const std::vector<std::string>& addresses, const uint16_t& port, bool protobuf_enabled, bool binary_enabled = false);
     bool write_monitor_pvt(const Monitor_Pvt* const monitor_pvt);
 
 private:
     Serdes_Monitor_Pvt serdes;
-    b_io_context io_context;
-    boost::asio::ip::udp::socket socket;
-    std::vector<boost::asio::ip::udp::endpoint> endpoints;
-    boost::system::error_code error;
+    Gnss_Udp_Sender sender;
     bool use_protobuf;
+    bool use_binary;
 };
 
 
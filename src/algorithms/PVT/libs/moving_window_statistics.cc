@@ -0,0 +1,125 @@
+/*!
+ * \file moving_window_statistics.cc
+ * \brief Mean and median of the last samples of a sequence, updated in
+ * constant and logarithmic time per sample.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "moving_window_statistics.h"
+#include <algorithm>  // for std::max
+#include <iterator>   // for std::prev
+#include <numeric>    // for std::accumulate
+
+
+Moving_Window_Statistics::Moving_Window_Statistics(size_t depth)
+    : d_window(std::max<size_t>(depth, 1))
+{
+}
+
+
+void Moving_Window_Statistics::set_depth(size_t depth)
+{
+    d_window.set_capacity(std::max<size_t>(depth, 1));
+    clear();
+}
+
+
+void Moving_Window_Statistics::clear()
+{
+    d_window.clear();
+    d_low.clear();
+    d_high.clear();
+    d_sum = 0.0;
+    d_pushes = 0;
+}
+
+
+void Moving_Window_Statistics::push(double value)
+{
+    if (d_window.full())
+        {
+            // all the values of d_low are lower than or equal to those of
+            // d_high, so an oldest value not greater than the largest of d_low
+            // is found in d_low
+            const double oldest = d_window.front();
+            if (!d_low.empty() and oldest <= *d_low.rbegin())
+                {
+                    d_low.erase(d_low.find(oldest));
+                }
+            else
+                {
+                    d_high.erase(d_high.find(oldest));
+                }
+            d_sum -= oldest;
+        }
+    d_window.push_back(value);
+    if (!d_high.empty() and value >= *d_high.begin())
+        {
+            d_high.insert(value);
+        }
+    else
+        {
+            d_low.insert(value);
+        }
+    balance();
+
+    if (++d_pushes < d_window.capacity())
+        {
+            d_sum += value;
+        }
+    else
+        {
+            d_sum = std::accumulate(d_window.begin(), d_window.end(), 0.0);
+            d_pushes = 0;
+        }
+}
+
+
+double Moving_Window_Statistics::mean() const
+{
+    if (d_window.empty())
+        {
+            return 0.0;
+        }
+    return d_sum / static_cast<double>(d_window.size());
+}
+
+
+double Moving_Window_Statistics::median() const
+{
+    if (d_window.empty())
+        {
+            return 0.0;
+        }
+    if (d_low.size() > d_high.size())
+        {
+            return *d_low.rbegin();
+        }
+    return (*d_low.rbegin() + *d_high.begin()) / 2.0;
+}
+
+
+void Moving_Window_Statistics::balance()
+{
+    // d_low has as many values as d_high, or one more
+    if (d_low.size() > d_high.size() + 1)
+        {
+            const auto largest = std::prev(d_low.end());
+            d_high.insert(*largest);
+            d_low.erase(largest);
+        }
+    else if (d_high.size() > d_low.size())
+        {
+            d_low.insert(*d_high.begin());
+            d_high.erase(d_high.begin());
+        }
+}
@@ -0,0 +1,65 @@
+/*!
+ * \file moving_window_statistics.h
+ * \brief Mean and median of the last samples of a sequence, updated in
+ * constant and logarithmic time per sample.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_MOVING_WINDOW_STATISTICS_H
+#define GNSS_SDR_MOVING_WINDOW_STATISTICS_H
+
+#include <boost/circular_buffer.hpp>
+#include <cstddef>
+#include <set>
+
+/** \addtogroup PVT
+ * \{ */
+/** \addtogroup PVT_libs
+ * \{ */
+
+
+/*!
+ * \brief Mean and median of the last depth samples pushed.
+ *
+ * The mean is kept as a running sum, which is recomputed from the window each
+ * time the window has been renewed, so that rounding errors do not build up.
+ * The median is kept with the window split in two sorted halves. A push takes
+ * O(1) time for the mean and O(log depth) for the median.
+ */
+class Moving_Window_Statistics
+{
+public:
+    explicit Moving_Window_Statistics(size_t depth = 1);
+
+    void set_depth(size_t depth);  //!< Sets the length of the window (at least 1), and clears it
+    void clear();
+    void push(double value);
+
+    bool full() const { return d_window.full(); }
+    size_t size() const { return d_window.size(); }
+    double mean() const;    //!< Mean of the window, or 0 if empty
+    double median() const;  //!< Median of the window, or 0 if empty
+
+private:
+    void balance();
+
+    boost::circular_buffer<double> d_window;
+    std::multiset<double> d_low;   // smallest half of the window, and the median if the size is odd
+    std::multiset<double> d_high;  // largest half of the window
+    double d_sum{0.0};
+    size_t d_pushes{0};  // since the sum was last recomputed
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_MOVING_WINDOW_STATISTICS_H
@@ -24,12 +24,15 @@
 #include "rtklib_solution.h"
 #include "rtklib_solver.h"
 #include <glog/logging.h>
+#include <boost/date_time/posix_time/posix_time.hpp>
 #include <array>
+#include <cerrno>
 #include <cstdint>
 #include <exception>
 #include <fcntl.h>
 #include <iostream>  // for cout, cerr
 #include <termios.h>
+#include <unistd.h>  // for write, close
 #include <utility>
 
 
@@ -37,8 +40,11 @@ Nmea_Printer::Nmea_Printer(const std::string& filename,
     bool flag_nmea_output_file,
     bool flag_nmea_tty_port,
     std::string nmea_dump_devname,
-    const std::string& base_path) : nmea_base_path(base_path),
-                                    d_flag_nmea_output_file(flag_nmea_output_file)
+    const std::string& base_path,
+    uint32_t flush_period_ms,
+    uint32_t rotation_period_s) : d_schedule(flush_period_ms, rotation_period_s),
+                                  nmea_base_path(base_path),
+                                  d_flag_nmea_output_file(flag_nmea_output_file)
 {
     if (d_flag_nmea_output_file == true)
         {
@@ -75,6 +81,7 @@ Nmea_Printer::Nmea_Printer(const std::string& filename,
             nmea_base_path = nmea_base_path + fs::path::preferred_separator;
 
             nmea_filename = nmea_base_path + filename;
+            nmea_first_filename = nmea_filename;
 
             nmea_file_descriptor.open(nmea_filename.c_str(), std::ios::out);
             if (nmea_file_descriptor.is_open())
@@ -196,30 +203,31 @@ bool Nmea_Printer::Print_Nmea_Line(const Rtklib_Solver* const pvt_data, bool pri
     d_PVT_data = pvt_data;
     print_avg_pos = print_average_values;
 
-    // generate the NMEA sentences
-
+    // generate the NMEA sentences, in a single buffer
+    d_sentences.clear();
     // GPRMC
-    const std::string GPRMC = get_GPRMC();
+    d_sentences.append(get_GPRMC());
     // GPGGA (Global Positioning System Fixed Data)
-    const std::string GPGGA = get_GPGGA();
+    d_sentences.append(get_GPGGA());
     // GPGSA
-    const std::string GPGSA = get_GPGSA();
+    d_sentences.append(get_GPGSA());
     // GPGSV
-    const std::string GPGSV = get_GPGSV();
+    d_sentences.append(get_GPGSV());
 
     // write to log file
     if (d_flag_nmea_output_file)
         {
             try
                 {
-                    // GPRMC
-                    nmea_file_descriptor << GPRMC;
-                    // GPGGA (Global Positioning System Fixed Data)
-                    nmea_file_descriptor << GPGGA;
-                    // GPGSA
-                    nmea_file_descriptor << GPGSA;
-                    // GPGSV
-                    nmea_file_descriptor << GPGSV;
+                    if (d_schedule.rotation_due(d_PVT_data->get_position_UTC_time()))
+                        {
+                            rotate_file(d_PVT_data->get_position_UTC_time());
+                        }
+                    d_sentences.write_to(nmea_file_descriptor);
+                    if (d_schedule.flush_due())
+                        {
+                            nmea_file_descriptor.flush();
+                        }
                 }
             catch (const std::exception& ex)
                 {
@@ -230,31 +238,62 @@ bool Nmea_Printer::Print_Nmea_Line(const Rtklib_Solver* const pvt_data, bool pri
     // write to serial device
     if (nmea_dev_descriptor != -1)
         {
-            if (write(nmea_dev_descriptor, GPRMC.c_str(), GPRMC.length()) == -1)
+            if (!write_serial())
                 {
                     DLOG(INFO) << "NMEA printer cannot write on serial device" << nmea_devname.c_str();
                     return false;
                 }
-            if (write(nmea_dev_descriptor, GPGGA.c_str(), GPGGA.length()) == -1)
-                {
-                    DLOG(INFO) << "NMEA printer cannot write on serial device" << nmea_devname.c_str();
-                    return false;
-                }
-            if (write(nmea_dev_descriptor, GPGSA.c_str(), GPGSA.length()) == -1)
-                {
-                    DLOG(INFO) << "NMEA printer cannot write on serial device" << nmea_devname.c_str();
-                    return false;
-                }
-            if (write(nmea_dev_descriptor, GPGSV.c_str(), GPGSV.length()) == -1)
+        }
+    return true;
+}
+
+
+bool Nmea_Printer::write_serial() const
+{
+    const char* data = d_sentences.data();
+    std::size_t pending = d_sentences.size();
+    while (pending > 0)
+        {
+            const ssize_t written = write(nmea_dev_descriptor, data, pending);
+            if (written == -1)
                 {
-                    DLOG(INFO) << "NMEA printer cannot write on serial device" << nmea_devname.c_str();
+                    if (errno == EINTR)
+                        {
+                            continue;
+                        }
                     return false;
                 }
+            data += written;
+            pending -= static_cast<std::size_t>(written);
         }
     return true;
 }
 
 
+void Nmea_Printer::rotate_file(const boost::posix_time::ptime& position_UTC_time)
+{
+    if (nmea_file_descriptor.is_open())
+        {
+            nmea_file_descriptor.close();
+        }
+    // the time tag goes before the extension of the first file name
+    const std::string time_tag = "_" + boost::posix_time::to_iso_string(position_UTC_time).substr(0, 15);
+    const fs::path first_file(nmea_first_filename);
+    fs::path new_file(first_file.parent_path());
+    new_file /= first_file.stem().string() + time_tag + first_file.extension().string();
+    nmea_filename = new_file.string();
+    nmea_file_descriptor.open(nmea_filename.c_str(), std::ios::out);
+    if (nmea_file_descriptor.is_open())
+        {
+            DLOG(INFO) << "NMEA printer writing on " << nmea_filename.c_str();
+        }
+    else
+        {
+            std::cout << "File " << nmea_filename << " cannot be saved. Wrong permissions?\n";
+        }
+}
+
+
 char Nmea_Printer::checkSum(const std::string& sentence) const
 {
     char check = 0;
@@ -394,11 +433,9 @@ std::string Nmea_Printer::get_UTC_NMEA_time(const boost::posix_time::ptime d_pos
 std::string Nmea_Printer::get_GPRMC() const
 {
     // Sample -> $GPRMC,161229.487,A,3723.2475,N,12158.3416,W,0.13,309.62,120598,*10
-    std::stringstream sentence_str;
     std::array<unsigned char, 1024> buff{};
-    outnmea_rmc(buff.data(), &d_PVT_data->pvt_sol);
-    sentence_str << buff.data();
-    return sentence_str.str();
+    const int length = outnmea_rmc(buff.data(), &d_PVT_data->pvt_sol);
+    return std::string(reinterpret_cast<const char*>(buff.data()), length > 0 ? length : 0);
 }
 
 
@@ -406,11 +443,9 @@ std::string Nmea_Printer::get_GPGSA() const
 {
     // $GPGSA,A,3,07,02,26,27,09,04,15, , , , , ,1.8,1.0,1.5*33
     // GSA-GNSS DOP and Active Satellites
-    std::stringstream sentence_str;
     std::array<unsigned char, 1024> buff{};
-    outnmea_gsa(buff.data(), &d_PVT_data->pvt_sol, d_PVT_data->pvt_ssat.data());
-    sentence_str << buff.data();
-    return sentence_str.str();
+    const int length = outnmea_gsa(buff.data(), &d_PVT_data->pvt_sol, d_PVT_data->pvt_ssat.data());
+    return std::string(reinterpret_cast<const char*>(buff.data()), length > 0 ? length : 0);
 }
 
 
@@ -419,20 +454,16 @@ std::string Nmea_Printer::get_GPGSV() const
     // GSV-GNSS Satellites in View
     // $GPGSV,2,1,07,07,79,048,42,02,51,062,43,26,36,256,42,27,27,138,42*71
     // Notice that NMEA 2.1 only supports 12 channels
-    std::stringstream sentence_str;
     std::array<unsigned char, 1024> buff{};
-    outnmea_gsv(buff.data(), &d_PVT_data->pvt_sol, d_PVT_data->pvt_ssat.data());
-    sentence_str << buff.data();
-    return sentence_str.str();
+    const int length = outnmea_gsv(buff.data(), &d_PVT_data->pvt_sol, d_PVT_data->pvt_ssat.data());
+    return std::string(reinterpret_cast<const char*>(buff.data()), length > 0 ? length : 0);
 }
 
 
 std::string Nmea_Printer::get_GPGGA() const
 {
-    std::stringstream sentence_str;
     std::array<unsigned char, 1024> buff{};
-    outnmea_gga(buff.data(), &d_PVT_data->pvt_sol);
-    sentence_str << buff.data();
-    return sentence_str.str();
+    const int length = outnmea_gga(buff.data(), &d_PVT_data->pvt_sol);
+    return std::string(reinterpret_cast<const char*>(buff.data()), length > 0 ? length : 0);
     // $GPGGA,104427.591,5920.7009,N,01803.2938,E,1,05,3.3,78.2,M,23.2,M,0.0,0000*4A
 }
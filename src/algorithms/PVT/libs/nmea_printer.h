@@ -22,7 +22,9 @@
 #ifndef GNSS_SDR_NMEA_PRINTER_H
 #define GNSS_SDR_NMEA_PRINTER_H
 
+#include "pvt_text_output.h"
 #include <boost/date_time/posix_time/ptime.hpp>  // for ptime
+#include <cstdint>                               // for uint32_t
 #include <fstream>                               // for ofstream
 #include <memory>                                // for shared_ptr
 #include <string>                                // for string
@@ -47,7 +49,13 @@ public:
     /*!
      * \brief Default constructor.
      */
-    Nmea_Printer(const std::string& filename, bool flag_nmea_output_file, bool flag_nmea_tty_port, std::string nmea_dump_devname, const std::string& base_path = ".");
+    Nmea_Printer(const std::string& filename,
+        bool flag_nmea_output_file,
+        bool flag_nmea_tty_port,
+        std::string nmea_dump_devname,
+        const std::string& base_path = ".",
+        uint32_t flush_period_ms = 1000,
+        uint32_t rotation_period_s = 0);
 
     /*!
      * \brief Default destructor.
@@ -62,6 +70,8 @@ public:
 private:
     int init_serial(const std::string& serial_device);  // serial port control
     void close_serial() const;
+    bool write_serial() const;                                            // writes d_sentences to the serial device
+    void rotate_file(const boost::posix_time::ptime& position_UTC_time);  // closes the log file and opens a new one
     std::string get_GPGGA() const;  // fix data
     std::string get_GPGSV() const;  // satellite data
     std::string get_GPGSA() const;  // overall satellite reception data
@@ -73,9 +83,13 @@ private:
 
     const Rtklib_Solver* d_PVT_data;
 
+    Pvt_Text_Buffer d_sentences;  // sentences of the current epoch
+    Pvt_Output_Schedule d_schedule;
+
     std::ofstream nmea_file_descriptor;  // Output file stream for NMEA log file
 
     std::string nmea_filename;  // String with the NMEA log filename
+    std::string nmea_first_filename;  // name of the first log file, from which those of the rotated files are made
     std::string nmea_base_path;
     std::string nmea_devname;
 
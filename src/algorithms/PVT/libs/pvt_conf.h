@@ -20,6 +20,7 @@
 #include <cstdint>
 #include <map>
 #include <string>
+#include <vector>
 
 /** \addtogroup PVT
  * \{ */
@@ -31,6 +32,7 @@ class Pvt_Conf
 {
 public:
     std::map<int, int> rtcm_msg_rate_ms;
+    std::vector<int32_t> channel_antenna;  // antenna (RF channel) of each channel, if there are several
 
     std::string rinex_name = std::string("-");
     std::string dump_filename;
@@ -46,11 +48,23 @@ public:
     std::string kml_output_path = std::string(".");
     std::string xml_output_path = std::string(".");
     std::string rtcm_output_file_path = std::string(".");
+    std::string raw_obs_output_path = std::string(".");
     std::string udp_addresses;
     std::string udp_eph_addresses;
+    std::string monitor_shm_name;
+    std::string monitor_callbacks_name;
+    std::string monitor_tty_devname;
+    std::string rtcm_mount_points;
+    std::string attitude_output_filename;
 
     uint32_t type_of_receiver = 0;
     uint32_t observable_interval_ms = 20;
+    uint32_t output_queue_size = 100;
+    uint32_t rinex_rotation_period_s = 0;
+    uint32_t output_flush_period_ms = 1000;
+    uint32_t output_rotation_period_s = 0;
+    uint32_t rtcm_client_queue_size = 64;
+    uint32_t antennas = 1;
 
     int32_t output_rate_ms = 0;
     int32_t display_rate_ms = 0;
@@ -62,10 +76,14 @@ public:
     int32_t rinexobs_rate_ms = 0;
     int32_t an_rate_ms = 1000;
     int32_t max_obs_block_rx_clock_offset_ms = 40;
+    int32_t high_rate_anchor_ms = 1000;
     int udp_port = 0;
     int udp_eph_port = 0;
     int rtk_trace_level = 0;
 
+    double attitude_baseline_length_m = 0.0;
+    double attitude_baseline_sigma_m = 0.01;
+
     uint16_t rtcm_tcp_port = 0;
     uint16_t rtcm_station_id = 0;
 
@@ -80,11 +98,16 @@ public:
     bool an_output_enabled = false;
     bool kml_output_enabled = true;
     bool xml_output_enabled = true;
+    bool nav_data_binary = false;
     bool rtcm_output_file_enabled = true;
+    bool raw_obs_output_enabled = false;
     bool monitor_enabled = false;
     bool monitor_ephemeris_enabled = false;
     bool protobuf_enabled = true;
+    bool monitor_binary_enabled = false;
     bool enable_rx_clock_correction = true;
+    bool decoupled_positioning = false;
+    bool high_rate = false;
     bool show_local_time_zone = false;
     bool pre_2009_file = false;
     bool dump = false;
@@ -0,0 +1,119 @@
+/*!
+ * \file pvt_output_dispatcher.cc
+ * \brief Writer thread for the PVT output printers
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "pvt_output_dispatcher.h"
+#include <glog/logging.h>
+#include <exception>
+#include <utility>
+
+
+Pvt_Output_Dispatcher::Pvt_Output_Dispatcher(std::size_t capacity) : d_capacity(capacity > 0 ? capacity : 1)
+{
+    d_writer = std::thread(&Pvt_Output_Dispatcher::run, this);
+}
+
+
+Pvt_Output_Dispatcher::~Pvt_Output_Dispatcher()
+{
+    try
+        {
+            {
+                std::lock_guard<std::mutex> lock(d_mutex);
+                d_stop = true;
+            }
+            d_cond.notify_one();
+            if (d_writer.joinable())
+                {
+                    d_writer.join();
+                }
+            if (d_dropped > 0)
+                {
+                    LOG(WARNING) << "PVT output queue: " << d_dropped << " outputs discarded, maximum depth " << d_max_depth;
+                }
+            else
+                {
+                    DLOG(INFO) << "PVT output queue: maximum depth " << d_max_depth;
+                }
+        }
+    catch (const std::exception& e)
+        {
+            LOG(WARNING) << "Exception in the PVT output dispatcher destructor: " << e.what();
+        }
+}
+
+
+bool Pvt_Output_Dispatcher::push(std::function<void()> output)
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        if (d_queue.size() >= d_capacity)
+            {
+                if (d_dropped++ == 0)
+                    {
+                        LOG(WARNING) << "PVT output queue full (" << d_capacity << " outputs), discarding outputs";
+                    }
+                return false;
+            }
+        d_queue.push_back(std::move(output));
+        if (d_queue.size() > d_max_depth)
+            {
+                d_max_depth = d_queue.size();
+            }
+    }
+    d_cond.notify_one();
+    return true;
+}
+
+
+uint64_t Pvt_Output_Dispatcher::get_dropped() const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_dropped;
+}
+
+
+std::size_t Pvt_Output_Dispatcher::get_max_depth() const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_max_depth;
+}
+
+
+void Pvt_Output_Dispatcher::run()
+{
+    while (true)
+        {
+            std::function<void()> output;
+            {
+                std::unique_lock<std::mutex> lock(d_mutex);
+                d_cond.wait(lock, [this] { return d_stop || !d_queue.empty(); });
+                if (d_queue.empty())
+                    {
+                        // stopped, and all the outputs were written
+                        return;
+                    }
+                output = std::move(d_queue.front());
+                d_queue.pop_front();
+            }
+            try
+                {
+                    output();
+                }
+            catch (const std::exception& e)
+                {
+                    LOG(WARNING) << "Exception writing a PVT output: " << e.what();
+                }
+        }
+}
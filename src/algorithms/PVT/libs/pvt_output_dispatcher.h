@@ -0,0 +1,75 @@
+/*!
+ * \file pvt_output_dispatcher.h
+ * \brief Writer thread for the PVT output printers
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_PVT_OUTPUT_DISPATCHER_H
+#define GNSS_SDR_PVT_OUTPUT_DISPATCHER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/** \addtogroup PVT
+ * \{ */
+/** \addtogroup PVT_libs
+ * \{ */
+
+
+/*!
+ * \brief Runs the writes of the PVT printers (files, serial ports and
+ * servers) in a thread of their own, in the order they were pushed, so that
+ * slow outputs do not stall the PVT block.
+ *
+ * The outputs work on copies of the data they print. The queue is bounded:
+ * when it is full, new outputs are discarded and counted.
+ */
+class Pvt_Output_Dispatcher
+{
+public:
+    explicit Pvt_Output_Dispatcher(std::size_t capacity);
+
+    /*!
+     * \brief Runs the outputs still in the queue, and stops the thread
+     */
+    ~Pvt_Output_Dispatcher();
+
+    /*!
+     * \brief Queues an output. Returns false if the queue is full.
+     */
+    bool push(std::function<void()> output);
+
+    uint64_t get_dropped() const;        //!< Number of outputs discarded because the queue was full
+    std::size_t get_max_depth() const;  //!< Maximum number of outputs waiting in the queue
+
+private:
+    void run();
+
+    std::deque<std::function<void()>> d_queue;
+    mutable std::mutex d_mutex;
+    std::condition_variable d_cond;
+    std::thread d_writer;
+    std::size_t d_capacity;
+    std::size_t d_max_depth{0};
+    uint64_t d_dropped{0};
+    bool d_stop{false};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_PVT_OUTPUT_DISPATCHER_H
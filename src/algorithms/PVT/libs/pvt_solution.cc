@@ -18,6 +18,7 @@
 #include "pvt_solution.h"
 #include "MATH_CONSTANTS.h"
 #include <glog/logging.h>
+#include <algorithm>  // for std::max
 #include <cmath>
 #include <cstddef>
 
@@ -72,6 +73,10 @@ int Pvt_Solution::cart2geo(double X, double Y, double Z, int elipsoid_selection)
 void Pvt_Solution::set_averaging_depth(int depth)
 {
     d_averaging_depth = depth;
+    const auto window = static_cast<size_t>(std::max(depth, 1));
+    d_hist_latitude_d.set_depth(window);
+    d_hist_longitude_d.set_depth(window);
+    d_hist_height_m.set_depth(window);
 }
 
 
@@ -81,45 +86,41 @@ void Pvt_Solution::set_averaging_flag(bool flag)
 }
 
 
+void Pvt_Solution::set_averaging_median(bool flag)
+{
+    d_flag_averaging_median = flag;
+}
+
+
 void Pvt_Solution::perform_pos_averaging()
 {
     // MOVING AVERAGE PVT
-    bool avg = d_flag_averaging;
-    if (avg == true)
+    if (d_flag_averaging)
         {
-            if (d_hist_longitude_d.size() == static_cast<unsigned int>(d_averaging_depth))
+            // the average is given once the window has been filled, from the
+            // next epoch on
+            const bool full_window = d_hist_longitude_d.full();
+            d_hist_latitude_d.push(d_latitude_d);
+            d_hist_longitude_d.push(d_longitude_d);
+            d_hist_height_m.push(d_height_m);
+            if (full_window)
                 {
-                    // Pop oldest value
-                    d_hist_longitude_d.pop_back();
-                    d_hist_latitude_d.pop_back();
-                    d_hist_height_m.pop_back();
-                    // Push new values
-                    d_hist_longitude_d.push_front(d_longitude_d);
-                    d_hist_latitude_d.push_front(d_latitude_d);
-                    d_hist_height_m.push_front(d_height_m);
-
-                    d_avg_latitude_d = 0.0;
-                    d_avg_longitude_d = 0.0;
-                    d_avg_height_m = 0.0;
-                    for (size_t i = 0; i < d_hist_longitude_d.size(); i++)
+                    if (d_flag_averaging_median)
                         {
-                            d_avg_latitude_d = d_avg_latitude_d + d_hist_latitude_d.at(i);
-                            d_avg_longitude_d = d_avg_longitude_d + d_hist_longitude_d.at(i);
-                            d_avg_height_m = d_avg_height_m + d_hist_height_m.at(i);
+                            d_avg_latitude_d = d_hist_latitude_d.median();
+                            d_avg_longitude_d = d_hist_longitude_d.median();
+                            d_avg_height_m = d_hist_height_m.median();
+                        }
+                    else
+                        {
+                            d_avg_latitude_d = d_hist_latitude_d.mean();
+                            d_avg_longitude_d = d_hist_longitude_d.mean();
+                            d_avg_height_m = d_hist_height_m.mean();
                         }
-                    d_avg_latitude_d = d_avg_latitude_d / static_cast<double>(d_averaging_depth);
-                    d_avg_longitude_d = d_avg_longitude_d / static_cast<double>(d_averaging_depth);
-                    d_avg_height_m = d_avg_height_m / static_cast<double>(d_averaging_depth);
                     d_valid_position = true;
                 }
             else
                 {
-                    // int current_depth=d_hist_longitude_d.size();
-                    // Push new values
-                    d_hist_longitude_d.push_front(d_longitude_d);
-                    d_hist_latitude_d.push_front(d_latitude_d);
-                    d_hist_height_m.push_front(d_height_m);
-
                     d_avg_latitude_d = d_latitude_d;
                     d_avg_longitude_d = d_longitude_d;
                     d_avg_height_m = d_height_m;
@@ -18,9 +18,9 @@
 #ifndef GNSS_SDR_PVT_SOLUTION_H
 #define GNSS_SDR_PVT_SOLUTION_H
 
+#include "moving_window_statistics.h"
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <array>
-#include <deque>
 
 /** \addtogroup PVT
  * \{ */
@@ -51,6 +51,7 @@ public:
     // averaging
     void set_averaging_depth(int depth);  //!< Set length of averaging window
     void set_averaging_flag(bool flag);
+    void set_averaging_median(bool flag);  //!< Average the position with the median of the window instead of the mean
     void perform_pos_averaging();
 
     std::array<double, 3> get_rx_pos() const;
@@ -98,9 +99,9 @@ private:
     std::array<double, 3> d_rx_vel{};
     boost::posix_time::ptime d_position_UTC_time;
 
-    std::deque<double> d_hist_latitude_d;
-    std::deque<double> d_hist_longitude_d;
-    std::deque<double> d_hist_height_m;
+    Moving_Window_Statistics d_hist_latitude_d;
+    Moving_Window_Statistics d_hist_longitude_d;
+    Moving_Window_Statistics d_hist_height_m;
 
     double d_latitude_d{0.0};             // RX position Latitude WGS84 [deg]
     double d_longitude_d{0.0};            // RX position Longitude WGS84 [deg]
@@ -120,6 +121,7 @@ private:
     bool d_pre_2009_file{false};  // Flag to correct week rollover in post processing mode for signals older than 2009
     bool d_valid_position{false};
     bool d_flag_averaging{false};
+    bool d_flag_averaging_median{false};
 };
 
 
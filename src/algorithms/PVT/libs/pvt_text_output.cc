@@ -0,0 +1,218 @@
+/*!
+ * \file pvt_text_output.cc
+ * \brief Line buffer with fast number formatting, and flush and rotation
+ * schedule, shared by the KML, GPX, GeoJSON and NMEA printers.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "pvt_text_output.h"
+#include <algorithm>  // for std::min
+#include <array>
+#include <cmath>
+#include <cstdio>  // for snprintf
+
+
+namespace
+{
+constexpr std::array<double, 16> POWERS_OF_TEN = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15};
+
+
+// Writes the digits of value, at least min_digits, ending at end. Returns
+// where the digits start.
+char* write_digits(char* end, uint64_t value, int min_digits)
+{
+    int digits = 0;
+    do
+        {
+            *--end = static_cast<char>('0' + value % 10);
+            value /= 10;
+            digits++;
+        }
+    while (value != 0);
+    while (digits++ < min_digits)
+        {
+            *--end = '0';
+        }
+    return end;
+}
+}  // namespace
+
+
+Pvt_Text_Buffer::Pvt_Text_Buffer(std::size_t capacity)
+{
+    d_text.reserve(capacity);
+}
+
+
+Pvt_Text_Buffer& Pvt_Text_Buffer::append(const std::string& text, int times)
+{
+    for (int i = 0; i < times; i++)
+        {
+            d_text.append(text);
+        }
+    return *this;
+}
+
+
+Pvt_Text_Buffer& Pvt_Text_Buffer::append_fixed(double value, int precision)
+{
+    const double magnitude = std::abs(value);
+    if (precision < 0 or precision >= static_cast<int>(POWERS_OF_TEN.size()) or !(magnitude < 1e15))
+        {
+            // out of the range of the integer digits below, or not finite
+            std::array<char, 512> text{};
+            const int length = std::snprintf(text.data(), text.size(), "%.*f", precision, value);
+            if (length > 0)
+                {
+                    d_text.append(text.data(), std::min<std::size_t>(length, text.size() - 1));
+                }
+            return *this;
+        }
+
+    // The digits are those of magnitude * 10^precision rounded to an integer.
+    // The integer part contributes an integer, and both the fraction and the
+    // power of ten are exact doubles, so the rounding only depends on the
+    // exact product fraction * 10^precision, which is scaled + error (the
+    // rounding error of the product, exact with a fused multiply-add). The
+    // error is at most half an ulp of scaled, which is at most 1/8, so it can
+    // only move the product across the midpoint when scaled is right on it.
+    const double integer_part = std::floor(magnitude);
+    const double fraction = magnitude - integer_part;
+    const double power = POWERS_OF_TEN[precision];
+    const double scaled = fraction * power;
+    const double error = std::fma(fraction, power, -scaled);
+    const double lower = std::floor(scaled);
+    const double remainder = scaled - lower;
+    auto integer_digits = static_cast<uint64_t>(integer_part);
+    auto fraction_digits = static_cast<uint64_t>(lower);
+    bool round_up = remainder > 0.5 or (remainder == 0.5 and error > 0.0);
+    if (remainder == 0.5 and error == 0.0)
+        {
+            // exact tie, rounded to the even last digit as printf does
+            round_up = precision > 0 ? (fraction_digits % 2 == 1) : (integer_digits % 2 == 1);
+        }
+    if (round_up)
+        {
+            fraction_digits++;
+            if (fraction_digits == static_cast<uint64_t>(power))
+                {
+                    fraction_digits = 0;
+                    integer_digits++;
+                }
+        }
+
+    std::array<char, 40> text{};
+    char* const end = text.data() + text.size();
+    char* begin = end;
+    if (precision > 0)
+        {
+            begin = write_digits(begin, fraction_digits, precision);
+            *--begin = '.';
+        }
+    begin = write_digits(begin, integer_digits, 1);
+    if (std::signbit(value))
+        {
+            *--begin = '-';
+        }
+    d_text.append(begin, end);
+    return *this;
+}
+
+
+Pvt_Text_Buffer& Pvt_Text_Buffer::append_uint(uint64_t value)
+{
+    std::array<char, 20> text{};
+    char* const end = text.data() + text.size();
+    d_text.append(write_digits(end, value, 1), end);
+    return *this;
+}
+
+
+Pvt_Text_Buffer& Pvt_Text_Buffer::append_iso_time(const boost::posix_time::ptime& time)
+{
+    if (time.is_special())
+        {
+            std::string text = to_iso_extended_string(time);
+            text.resize(23, '0');
+            d_text.append(text).append("Z");
+            return *this;
+        }
+    const auto date = time.date().year_month_day();
+    const boost::posix_time::time_duration td = time.time_of_day();
+    const auto milliseconds = static_cast<uint64_t>(td.total_milliseconds() - td.total_seconds() * 1000);
+    // YYYY-MM-DDTHH:MM:SS.sssZ
+    std::array<char, 24> text{};
+    char* const end = text.data() + text.size();
+    char* begin = end;
+    *--begin = 'Z';
+    begin = write_digits(begin, milliseconds, 3);
+    *--begin = '.';
+    begin = write_digits(begin, td.seconds(), 2);
+    *--begin = ':';
+    begin = write_digits(begin, td.minutes(), 2);
+    *--begin = ':';
+    begin = write_digits(begin, td.hours(), 2);
+    *--begin = 'T';
+    begin = write_digits(begin, date.day, 2);
+    *--begin = '-';
+    begin = write_digits(begin, date.month, 2);
+    *--begin = '-';
+    begin = write_digits(begin, date.year, 4);
+    d_text.append(begin, end);
+    return *this;
+}
+
+
+Pvt_Output_Schedule::Pvt_Output_Schedule(uint32_t flush_period_ms, uint32_t rotation_period_s)
+    : d_last_flush(std::chrono::steady_clock::now()),
+      d_flush_period(flush_period_ms),
+      d_rotation_period_s(rotation_period_s)
+{
+}
+
+
+bool Pvt_Output_Schedule::flush_due()
+{
+    if (d_flush_period.count() == 0)
+        {
+            return true;
+        }
+    const auto now = std::chrono::steady_clock::now();
+    if (now - d_last_flush >= d_flush_period)
+        {
+            d_last_flush = now;
+            return true;
+        }
+    return false;
+}
+
+
+bool Pvt_Output_Schedule::rotation_due(const boost::posix_time::ptime& time)
+{
+    if (d_rotation_period_s == 0 or time.is_special())
+        {
+            return false;
+        }
+    const boost::posix_time::ptime epoch(boost::gregorian::date(1970, 1, 1));
+    const int64_t rotation_index = static_cast<int64_t>((time - epoch).total_seconds()) / d_rotation_period_s;
+    if (d_rotation_index < 0)
+        {
+            d_rotation_index = rotation_index;
+            return false;
+        }
+    if (rotation_index != d_rotation_index)
+        {
+            d_rotation_index = rotation_index;
+            return true;
+        }
+    return false;
+}
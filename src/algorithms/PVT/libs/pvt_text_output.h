@@ -0,0 +1,121 @@
+/*!
+ * \file pvt_text_output.h
+ * \brief Line buffer with fast number formatting, and flush and rotation
+ * schedule, shared by the KML, GPX, GeoJSON and NMEA printers.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_PVT_TEXT_OUTPUT_H
+#define GNSS_SDR_PVT_TEXT_OUTPUT_H
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+/** \addtogroup PVT
+ * \{ */
+/** \addtogroup PVT_libs
+ * \{ */
+
+
+/*!
+ * \brief Text of an output record, built in a buffer that keeps its memory
+ * from one record to the next.
+ *
+ * The numbers are formatted without the locale machinery of the iostreams.
+ * append_fixed() gives the same text as a stream with std::fixed and
+ * std::setprecision(precision) in the "C" locale, that is, the decimal value
+ * of the double correctly rounded to precision digits.
+ */
+class Pvt_Text_Buffer
+{
+public:
+    explicit Pvt_Text_Buffer(std::size_t capacity = 4096);
+
+    void clear() { d_text.clear(); }
+
+    Pvt_Text_Buffer& append(char c)
+    {
+        d_text.push_back(c);
+        return *this;
+    }
+
+    Pvt_Text_Buffer& append(const char* text)
+    {
+        d_text.append(text);
+        return *this;
+    }
+
+    Pvt_Text_Buffer& append(const std::string& text)
+    {
+        d_text.append(text);
+        return *this;
+    }
+
+    Pvt_Text_Buffer& append(const std::string& text, int times);  //!< Appends text times times (e.g., indentation)
+    Pvt_Text_Buffer& append_fixed(double value, int precision);  //!< Appends value with precision decimal digits
+    Pvt_Text_Buffer& append_uint(uint64_t value);
+
+    /*!
+     * \brief Appends the time as YYYY-MM-DDTHH:MM:SS.sssZ, with the
+     * milliseconds truncated
+     */
+    Pvt_Text_Buffer& append_iso_time(const boost::posix_time::ptime& time);
+
+    void write_to(std::ostream& out) const { out.write(d_text.data(), static_cast<std::streamsize>(d_text.size())); }
+
+    const char* data() const { return d_text.data(); }
+    std::size_t size() const { return d_text.size(); }
+    const std::string& str() const { return d_text; }
+
+private:
+    std::string d_text;
+};
+
+
+/*!
+ * \brief Decides when a printer flushes its file, and when it starts a new
+ * file.
+ *
+ * The files are flushed every flush_period_ms milliseconds of wall clock
+ * time (0 flushes each record), so that they can be followed while the
+ * receiver runs, without a flush per record. If rotation_period_s is not
+ * zero, a new file is started each time the time of the solutions enters a
+ * new period of rotation_period_s seconds (e.g., 3600 for hourly files).
+ */
+class Pvt_Output_Schedule
+{
+public:
+    explicit Pvt_Output_Schedule(uint32_t flush_period_ms = 1000, uint32_t rotation_period_s = 0);
+
+    //! Returns true if the file has to be flushed after a record written now
+    bool flush_due();
+
+    //! Returns true if the record of a solution at time goes into a new file
+    bool rotation_due(const boost::posix_time::ptime& time);
+
+    uint32_t rotation_period_s() const { return d_rotation_period_s; }
+
+private:
+    std::chrono::steady_clock::time_point d_last_flush;
+    std::chrono::milliseconds d_flush_period;
+    int64_t d_rotation_index{-1};
+    uint32_t d_rotation_period_s;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_PVT_TEXT_OUTPUT_H
@@ -0,0 +1,429 @@
+/*!
+ * \file raw_obs_log.cc
+ * \brief Compact binary log of the observables and of the navigation data,
+ * written alongside the RINEX files and converted to RINEX offline
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "raw_obs_log.h"
+#include "beidou_dnav_ephemeris.h"
+#include "beidou_dnav_iono.h"
+#include "beidou_dnav_utc_model.h"
+#include "galileo_ephemeris.h"
+#include "galileo_iono.h"
+#include "galileo_utc_model.h"
+#include "glonass_gnav_ephemeris.h"
+#include "glonass_gnav_utc_model.h"
+#include "gnss_sdr_create_directory.h"
+#include "gnss_sdr_filesystem.h"
+#include "gps_cnav_ephemeris.h"
+#include "gps_cnav_iono.h"
+#include "gps_cnav_utc_model.h"
+#include "gps_ephemeris.h"
+#include "gps_iono.h"
+#include "gps_utc_model.h"
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <glog/logging.h>
+#include <array>      // for array
+#include <cstring>    // for memcpy
+#include <ctime>      // for tm, strftime
+#include <exception>  // for exception
+#include <iostream>   // for cout
+#include <memory>     // for make_shared
+#include <sstream>    // for ostringstream, istringstream
+
+
+namespace
+{
+// "GSOB" and the version of the layout of the records, which must be
+// incremented when the layout or any of the navigation data classes change
+const std::array<char, 8> RAW_OBS_LOG_MAGIC{'G', 'S', 'O', 'B', 0, 0, 0, 1};
+
+const uint32_t RAW_OBS_LOG_EPOCH = 1;        // double rx_time, uint32_t count, uint32_t reserved, count observables
+const uint32_t RAW_OBS_LOG_NAV_PRODUCT = 2;  // uint32_t type, uint32_t reserved, Boost binary archive without header
+
+
+// Observable of a satellite in an epoch record
+struct Raw_Obs_Log_Observable
+{
+    char System;
+    char Signal[3];
+    int32_t key;  // of the map of observables
+    int32_t Channel_ID;
+    uint32_t PRN;
+    uint32_t TOW_at_current_symbol_ms;
+    int32_t correlation_length_ms;
+    double Pseudorange_m;
+    double Carrier_phase_rads;
+    double Carrier_Doppler_hz;
+    double CN0_dB_hz;
+    double RX_time;
+    double interp_TOW_ms;
+    double Code_phase_samples;
+    uint64_t Tracking_sample_counter;
+    int64_t fs;
+    uint8_t flags;
+    uint8_t reserved[7];
+};
+
+static_assert(sizeof(Raw_Obs_Log_Observable) == 104, "The layout of the observables of the raw observation log has changed");
+
+const uint8_t RAW_OBS_LOG_VALID_ACQUISITION = 0x01;
+const uint8_t RAW_OBS_LOG_VALID_SYMBOL_OUTPUT = 0x02;
+const uint8_t RAW_OBS_LOG_VALID_WORD = 0x04;
+const uint8_t RAW_OBS_LOG_VALID_PSEUDORANGE = 0x08;
+const uint8_t RAW_OBS_LOG_PLL_180_DEG_PHASE_LOCKED = 0x10;
+
+
+template <typename T>
+void append(std::vector<char>& buffer, const T& value)
+{
+    const size_t size = buffer.size();
+    buffer.resize(size + sizeof(T));
+    std::memcpy(buffer.data() + size, &value, sizeof(T));
+}
+
+
+template <typename T>
+T extract(const char* data)
+{
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+
+template <typename T>
+bool save_nav_product(const Gnss_Nav_Product& product, std::ostream& os)
+{
+    boost::archive::binary_oarchive archive(os, boost::archive::no_header);
+    archive << *product.get<T>();
+    return true;
+}
+
+
+template <typename T>
+Gnss_Nav_Product load_nav_product(std::istream& is)
+{
+    const auto object = std::make_shared<T>();
+    boost::archive::binary_iarchive archive(is, boost::archive::no_header);
+    archive >> *object;
+    return Gnss_Nav_Product(object);
+}
+
+
+// Writes the products that the RINEX printer uses, returns false for the others
+bool save_nav_product(const Gnss_Nav_Product& product, std::ostream& os)
+{
+    switch (product.type())
+        {
+        case NAV_GPS_EPHEMERIS:
+            return save_nav_product<Gps_Ephemeris>(product, os);
+        case NAV_GPS_IONO:
+            return save_nav_product<Gps_Iono>(product, os);
+        case NAV_GPS_UTC_MODEL:
+            return save_nav_product<Gps_Utc_Model>(product, os);
+        case NAV_GPS_CNAV_EPHEMERIS:
+            return save_nav_product<Gps_CNAV_Ephemeris>(product, os);
+        case NAV_GPS_CNAV_IONO:
+            return save_nav_product<Gps_CNAV_Iono>(product, os);
+        case NAV_GPS_CNAV_UTC_MODEL:
+            return save_nav_product<Gps_CNAV_Utc_Model>(product, os);
+        case NAV_GALILEO_EPHEMERIS:
+            return save_nav_product<Galileo_Ephemeris>(product, os);
+        case NAV_GALILEO_IONO:
+            return save_nav_product<Galileo_Iono>(product, os);
+        case NAV_GALILEO_UTC_MODEL:
+            return save_nav_product<Galileo_Utc_Model>(product, os);
+        case NAV_GLONASS_GNAV_EPHEMERIS:
+            return save_nav_product<Glonass_Gnav_Ephemeris>(product, os);
+        case NAV_GLONASS_GNAV_UTC_MODEL:
+            return save_nav_product<Glonass_Gnav_Utc_Model>(product, os);
+        case NAV_BEIDOU_DNAV_EPHEMERIS:
+            return save_nav_product<Beidou_Dnav_Ephemeris>(product, os);
+        case NAV_BEIDOU_DNAV_IONO:
+            return save_nav_product<Beidou_Dnav_Iono>(product, os);
+        case NAV_BEIDOU_DNAV_UTC_MODEL:
+            return save_nav_product<Beidou_Dnav_Utc_Model>(product, os);
+        default:
+            return false;
+        }
+}
+
+
+// Reads a product written by save_nav_product(), or returns an empty product
+Gnss_Nav_Product load_nav_product(uint32_t type, std::istream& is)
+{
+    switch (type)
+        {
+        case NAV_GPS_EPHEMERIS:
+            return load_nav_product<Gps_Ephemeris>(is);
+        case NAV_GPS_IONO:
+            return load_nav_product<Gps_Iono>(is);
+        case NAV_GPS_UTC_MODEL:
+            return load_nav_product<Gps_Utc_Model>(is);
+        case NAV_GPS_CNAV_EPHEMERIS:
+            return load_nav_product<Gps_CNAV_Ephemeris>(is);
+        case NAV_GPS_CNAV_IONO:
+            return load_nav_product<Gps_CNAV_Iono>(is);
+        case NAV_GPS_CNAV_UTC_MODEL:
+            return load_nav_product<Gps_CNAV_Utc_Model>(is);
+        case NAV_GALILEO_EPHEMERIS:
+            return load_nav_product<Galileo_Ephemeris>(is);
+        case NAV_GALILEO_IONO:
+            return load_nav_product<Galileo_Iono>(is);
+        case NAV_GALILEO_UTC_MODEL:
+            return load_nav_product<Galileo_Utc_Model>(is);
+        case NAV_GLONASS_GNAV_EPHEMERIS:
+            return load_nav_product<Glonass_Gnav_Ephemeris>(is);
+        case NAV_GLONASS_GNAV_UTC_MODEL:
+            return load_nav_product<Glonass_Gnav_Utc_Model>(is);
+        case NAV_BEIDOU_DNAV_EPHEMERIS:
+            return load_nav_product<Beidou_Dnav_Ephemeris>(is);
+        case NAV_BEIDOU_DNAV_IONO:
+            return load_nav_product<Beidou_Dnav_Iono>(is);
+        case NAV_BEIDOU_DNAV_UTC_MODEL:
+            return load_nav_product<Beidou_Dnav_Utc_Model>(is);
+        default:
+            return Gnss_Nav_Product();
+        }
+}
+}  // namespace
+
+
+Raw_Obs_Log::Raw_Obs_Log(const std::string& base_path, const std::string& base_name, uint32_t type_of_rx)
+{
+    std::string path = base_path;
+    if (!gnss_sdr_create_directory(path))
+        {
+            std::cerr << "GNSS-SDR cannot create the folder " << path << " for the raw observation log. Wrong permissions?\n";
+            path = fs::current_path().string();
+        }
+    std::string name = base_name;
+    if (name == "-")
+        {
+            const tm timeinfo = boost::posix_time::to_tm(boost::posix_time::second_clock::local_time());
+            std::array<char, 16> stamp{};
+            std::strftime(stamp.data(), stamp.size(), "%y%m%d_%H%M%S", &timeinfo);
+            name = std::string("GSDR_") + stamp.data();
+        }
+    d_filename = path + fs::path::preferred_separator + name + ".gsob";
+    d_file.open(d_filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!d_file.is_open())
+        {
+            LOG(WARNING) << "Could not open the raw observation log " << d_filename;
+            return;
+        }
+    d_file.write(RAW_OBS_LOG_MAGIC.data(), RAW_OBS_LOG_MAGIC.size());
+    d_buffer.clear();
+    append(d_buffer, type_of_rx);
+    append(d_buffer, static_cast<uint32_t>(0));
+    d_file.write(d_buffer.data(), d_buffer.size());
+    std::cout << "Raw observation log will be stored at " << d_filename << '\n';
+}
+
+
+Raw_Obs_Log::~Raw_Obs_Log()
+{
+    if (d_file.is_open())
+        {
+            try
+                {
+                    d_file.close();
+                }
+            catch (const std::exception& e)
+                {
+                    LOG(WARNING) << "Problem closing the raw observation log: " << e.what();
+                }
+        }
+}
+
+
+void Raw_Obs_Log::write_record(uint32_t kind)
+{
+    // the kind and the length go before the payload, in the same write
+    const std::array<uint32_t, 2> header{kind, static_cast<uint32_t>(d_buffer.size() - 2 * sizeof(uint32_t))};
+    std::memcpy(d_buffer.data(), header.data(), sizeof(header));
+    d_file.write(d_buffer.data(), d_buffer.size());
+}
+
+
+void Raw_Obs_Log::log_epoch(double rx_time, const std::map<int, Gnss_Synchro>& observables)
+{
+    if (!d_file.is_open())
+        {
+            return;
+        }
+    d_buffer.assign(2 * sizeof(uint32_t), 0);
+    d_buffer.reserve(d_buffer.size() + 16 + observables.size() * sizeof(Raw_Obs_Log_Observable));
+    append(d_buffer, rx_time);
+    append(d_buffer, static_cast<uint32_t>(observables.size()));
+    append(d_buffer, static_cast<uint32_t>(0));
+    for (const auto& obs : observables)
+        {
+            const Gnss_Synchro& gs = obs.second;
+            Raw_Obs_Log_Observable record{};
+            record.System = gs.System;
+            std::memcpy(record.Signal, gs.Signal, sizeof(record.Signal));
+            record.key = obs.first;
+            record.Channel_ID = gs.Channel_ID;
+            record.PRN = gs.PRN;
+            record.TOW_at_current_symbol_ms = gs.TOW_at_current_symbol_ms;
+            record.correlation_length_ms = gs.correlation_length_ms;
+            record.Pseudorange_m = gs.Pseudorange_m;
+            record.Carrier_phase_rads = gs.Carrier_phase_rads;
+            record.Carrier_Doppler_hz = gs.Carrier_Doppler_hz;
+            record.CN0_dB_hz = gs.CN0_dB_hz;
+            record.RX_time = gs.RX_time;
+            record.interp_TOW_ms = gs.interp_TOW_ms;
+            record.Code_phase_samples = gs.Code_phase_samples;
+            record.Tracking_sample_counter = gs.Tracking_sample_counter;
+            record.fs = gs.fs;
+            record.flags = (gs.Flag_valid_acquisition ? RAW_OBS_LOG_VALID_ACQUISITION : 0) |
+                           (gs.Flag_valid_symbol_output ? RAW_OBS_LOG_VALID_SYMBOL_OUTPUT : 0) |
+                           (gs.Flag_valid_word ? RAW_OBS_LOG_VALID_WORD : 0) |
+                           (gs.Flag_valid_pseudorange ? RAW_OBS_LOG_VALID_PSEUDORANGE : 0) |
+                           (gs.Flag_PLL_180_deg_phase_locked ? RAW_OBS_LOG_PLL_180_DEG_PHASE_LOCKED : 0);
+            append(d_buffer, record);
+        }
+    write_record(RAW_OBS_LOG_EPOCH);
+}
+
+
+void Raw_Obs_Log::log_nav_product(const Gnss_Nav_Product& product)
+{
+    if (!d_file.is_open())
+        {
+            return;
+        }
+    std::ostringstream os;
+    try
+        {
+            if (!save_nav_product(product, os))
+                {
+                    return;
+                }
+        }
+    catch (const std::exception& e)
+        {
+            LOG(WARNING) << "Navigation data not written to the raw observation log: " << e.what();
+            return;
+        }
+    const std::string archive = os.str();
+    d_buffer.assign(2 * sizeof(uint32_t), 0);
+    append(d_buffer, static_cast<uint32_t>(product.type()));
+    append(d_buffer, static_cast<uint32_t>(0));
+    d_buffer.insert(d_buffer.end(), archive.cbegin(), archive.cend());
+    write_record(RAW_OBS_LOG_NAV_PRODUCT);
+}
+
+
+bool Raw_Obs_Log::read(const std::string& filename,
+    uint32_t& type_of_rx,
+    const std::function<void(double, const std::map<int, Gnss_Synchro>&)>& on_epoch,
+    const std::function<void(const Gnss_Nav_Product&)>& on_nav_product)
+{
+    std::ifstream ifs(filename, std::ios::in | std::ios::binary);
+    if (!ifs.is_open())
+        {
+            return false;
+        }
+    std::array<char, 8> magic{};
+    std::array<uint32_t, 2> file_header{};
+    ifs.read(magic.data(), magic.size());
+    ifs.read(reinterpret_cast<char*>(file_header.data()), sizeof(file_header));
+    if (!ifs or magic != RAW_OBS_LOG_MAGIC)
+        {
+            LOG(WARNING) << filename << " is not a raw observation log of this version";
+            return false;
+        }
+    type_of_rx = file_header[0];
+
+    std::vector<char> payload;
+    std::map<int, Gnss_Synchro> observables;
+    while (true)
+        {
+            std::array<uint32_t, 2> header{};
+            ifs.read(reinterpret_cast<char*>(header.data()), sizeof(header));
+            if (!ifs)
+                {
+                    break;
+                }
+            payload.resize(header[1]);
+            ifs.read(payload.data(), payload.size());
+            if (!ifs)
+                {
+                    LOG(WARNING) << "The last record of " << filename << " is truncated";
+                    break;
+                }
+            if (header[0] == RAW_OBS_LOG_EPOCH and payload.size() >= 16)
+                {
+                    const auto rx_time = extract<double>(payload.data());
+                    const auto count = extract<uint32_t>(payload.data() + 8);
+                    if (payload.size() < 16 + static_cast<size_t>(count) * sizeof(Raw_Obs_Log_Observable))
+                        {
+                            LOG(WARNING) << "Malformed epoch record in " << filename;
+                            continue;
+                        }
+                    observables.clear();
+                    for (uint32_t i = 0; i < count; i++)
+                        {
+                            const auto record = extract<Raw_Obs_Log_Observable>(payload.data() + 16 + i * sizeof(Raw_Obs_Log_Observable));
+                            Gnss_Synchro gs;
+                            gs.System = record.System;
+                            std::memcpy(gs.Signal, record.Signal, sizeof(gs.Signal));
+                            gs.Channel_ID = record.Channel_ID;
+                            gs.PRN = record.PRN;
+                            gs.TOW_at_current_symbol_ms = record.TOW_at_current_symbol_ms;
+                            gs.correlation_length_ms = record.correlation_length_ms;
+                            gs.Pseudorange_m = record.Pseudorange_m;
+                            gs.Carrier_phase_rads = record.Carrier_phase_rads;
+                            gs.Carrier_Doppler_hz = record.Carrier_Doppler_hz;
+                            gs.CN0_dB_hz = record.CN0_dB_hz;
+                            gs.RX_time = record.RX_time;
+                            gs.interp_TOW_ms = record.interp_TOW_ms;
+                            gs.Code_phase_samples = record.Code_phase_samples;
+                            gs.Tracking_sample_counter = record.Tracking_sample_counter;
+                            gs.fs = record.fs;
+                            gs.Flag_valid_acquisition = (record.flags & RAW_OBS_LOG_VALID_ACQUISITION) != 0;
+                            gs.Flag_valid_symbol_output = (record.flags & RAW_OBS_LOG_VALID_SYMBOL_OUTPUT) != 0;
+                            gs.Flag_valid_word = (record.flags & RAW_OBS_LOG_VALID_WORD) != 0;
+                            gs.Flag_valid_pseudorange = (record.flags & RAW_OBS_LOG_VALID_PSEUDORANGE) != 0;
+                            gs.Flag_PLL_180_deg_phase_locked = (record.flags & RAW_OBS_LOG_PLL_180_DEG_PHASE_LOCKED) != 0;
+                            observables[record.key] = gs;
+                        }
+                    on_epoch(rx_time, observables);
+                }
+            else if (header[0] == RAW_OBS_LOG_NAV_PRODUCT and payload.size() >= 8)
+                {
+                    const auto type = extract<uint32_t>(payload.data());
+                    std::istringstream is(std::string(payload.data() + 8, payload.size() - 8));
+                    Gnss_Nav_Product product;
+                    try
+                        {
+                            product = load_nav_product(type, is);
+                        }
+                    catch (const std::exception& e)
+                        {
+                            LOG(WARNING) << "Malformed navigation data record in " << filename << ": " << e.what();
+                            continue;
+                        }
+                    if (product.type() != NAV_NONE)
+                        {
+                            on_nav_product(product);
+                        }
+                }
+        }
+    return true;
+}
@@ -0,0 +1,106 @@
+/*!
+ * \file raw_obs_log.h
+ * \brief Compact binary log of the observables and of the navigation data,
+ * written alongside the RINEX files and converted to RINEX offline
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_RAW_OBS_LOG_H
+#define GNSS_SDR_RAW_OBS_LOG_H
+
+#include "gnss_nav_product_channel.h"
+#include "gnss_synchro.h"
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+/** \addtogroup PVT
+ * \{ */
+/** \addtogroup PVT_libs
+ * \{ */
+
+
+/*!
+ * \brief Writes the observables of the epochs and the navigation data
+ * decoded by the receiver to a binary file, and reads them back.
+ *
+ * Formatting the RINEX records costs far more than the processing of an
+ * epoch at high observation rates. The log stores the same information in
+ * fixed-size records, written with a single call per epoch, and the
+ * raw_obs2rinex tool converts it to RINEX files offline.
+ *
+ * The file starts with "GSOB" and the version of the layout, followed by
+ * the type of receiver. Each record is a kind, a length in bytes and the
+ * payload, so that readers skip the kinds they do not know and stop at a
+ * truncated tail. The values are in the byte order of the host that wrote
+ * the file.
+ */
+class Raw_Obs_Log
+{
+public:
+    /*!
+     * \brief Creates the file in base_path. It is named after base_name, or
+     * after the local time if base_name is "-", with the .gsob extension.
+     */
+    Raw_Obs_Log(const std::string& base_path, const std::string& base_name, uint32_t type_of_rx);
+    ~Raw_Obs_Log();
+
+    Raw_Obs_Log(const Raw_Obs_Log&) = delete;
+    Raw_Obs_Log& operator=(const Raw_Obs_Log&) = delete;
+
+    inline bool is_open() const
+    {
+        return d_file.is_open();
+    }
+
+    inline std::string get_filename() const
+    {
+        return d_filename;
+    }
+
+    /*!
+     * \brief Logs the observables of the epoch at receiver time rx_time [s]
+     */
+    void log_epoch(double rx_time, const std::map<int, Gnss_Synchro>& observables);
+
+    /*!
+     * \brief Logs an ephemeris, iono or UTC model. The almanacs are not
+     * logged, since the RINEX files do not carry them.
+     */
+    void log_nav_product(const Gnss_Nav_Product& product);
+
+    /*!
+     * \brief Reads the log in filename, calling on_epoch for each epoch and
+     * on_nav_product for each navigation product, in the order they were
+     * logged. Returns false if the file cannot be opened or it is not a log
+     * of this version. A truncated last record is ignored.
+     */
+    static bool read(const std::string& filename,
+        uint32_t& type_of_rx,
+        const std::function<void(double, const std::map<int, Gnss_Synchro>&)>& on_epoch,
+        const std::function<void(const Gnss_Nav_Product&)>& on_nav_product);
+
+private:
+    void write_record(uint32_t kind);
+
+    std::vector<char> d_buffer;  // record being assembled
+    std::ofstream d_file;
+    std::string d_filename;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_RAW_OBS_LOG_H
@@ -58,11 +58,15 @@
 
 Rinex_Printer::Rinex_Printer(int32_t conf_version,
     const std::string& base_path,
-    const std::string& base_name) : d_fake_cnav_iode(1),
-                                    d_numberTypesObservations(4),
-                                    d_rinex_header_updated(false),
-                                    d_rinex_header_written(false),
-                                    d_pre_2009_file(false)
+    const std::string& base_name,
+    uint32_t rotation_period_s) : d_base_name(base_name),
+                                  d_fake_cnav_iode(1),
+                                  d_rotation_index(0),
+                                  d_rotation_period_s(rotation_period_s),
+                                  d_numberTypesObservations(4),
+                                  d_rinex_header_updated(false),
+                                  d_rinex_header_written(false),
+                                  d_pre_2009_file(false)
 
 {
     // RINEX v3.02 codes
@@ -179,13 +183,38 @@ Rinex_Printer::Rinex_Printer(int32_t conf_version,
             std::cout << "RINEX files will be stored at " << base_rinex_path << '\n';
         }
 
-    navfilename = base_rinex_path + fs::path::preferred_separator + Rinex_Printer::createFilename("RINEX_FILE_TYPE_GPS_NAV", base_name);
-    obsfilename = base_rinex_path + fs::path::preferred_separator + Rinex_Printer::createFilename("RINEX_FILE_TYPE_OBS", base_name);
-    sbsfilename = base_rinex_path + fs::path::preferred_separator + Rinex_Printer::createFilename("RINEX_FILE_TYPE_SBAS", base_name);
-    navGalfilename = base_rinex_path + fs::path::preferred_separator + Rinex_Printer::createFilename("RINEX_FILE_TYPE_GAL_NAV", base_name);
-    navMixfilename = base_rinex_path + fs::path::preferred_separator + Rinex_Printer::createFilename("RINEX_FILE_TYPE_MIXED_NAV", base_name);
-    navGlofilename = base_rinex_path + fs::path::preferred_separator + Rinex_Printer::createFilename("RINEX_FILE_TYPE_GLO_NAV", base_name);
-    navBdsfilename = base_rinex_path + fs::path::preferred_separator + Rinex_Printer::createFilename("RINEX_FILE_TYPE_BDS_NAV", base_name);
+    d_base_path = base_rinex_path;
+    Rinex_Printer::open_files();
+
+    if (conf_version == 2)
+        {
+            d_version = 2;
+            d_stringVersion = "2.11";
+        }
+    else
+        {
+            d_version = 3;
+            d_stringVersion = "3.02";
+        }
+}
+
+
+Rinex_Printer::~Rinex_Printer()
+{
+    DLOG(INFO) << "RINEX printer destructor called.";
+    Rinex_Printer::close_files();
+}
+
+
+void Rinex_Printer::open_files()
+{
+    navfilename = d_base_path + fs::path::preferred_separator + Rinex_Printer::createFilename("RINEX_FILE_TYPE_GPS_NAV", d_base_name);
+    obsfilename = d_base_path + fs::path::preferred_separator + Rinex_Printer::createFilename("RINEX_FILE_TYPE_OBS", d_base_name);
+    sbsfilename = d_base_path + fs::path::preferred_separator + Rinex_Printer::createFilename("RINEX_FILE_TYPE_SBAS", d_base_name);
+    navGalfilename = d_base_path + fs::path::preferred_separator + Rinex_Printer::createFilename("RINEX_FILE_TYPE_GAL_NAV", d_base_name);
+    navMixfilename = d_base_path + fs::path::preferred_separator + Rinex_Printer::createFilename("RINEX_FILE_TYPE_MIXED_NAV", d_base_name);
+    navGlofilename = d_base_path + fs::path::preferred_separator + Rinex_Printer::createFilename("RINEX_FILE_TYPE_GLO_NAV", d_base_name);
+    navBdsfilename = d_base_path + fs::path::preferred_separator + Rinex_Printer::createFilename("RINEX_FILE_TYPE_BDS_NAV", d_base_name);
 
     Rinex_Printer::navFile.open(navfilename, std::ios::out | std::ios::in | std::ios::app);
     Rinex_Printer::obsFile.open(obsfilename, std::ios::out | std::ios::in | std::ios::app);
@@ -201,23 +230,11 @@ Rinex_Printer::Rinex_Printer(int32_t conf_version,
         {
             std::cout << "RINEX files cannot be saved. Wrong permissions?\n";
         }
-
-    if (conf_version == 2)
-        {
-            d_version = 2;
-            d_stringVersion = "2.11";
-        }
-    else
-        {
-            d_version = 3;
-            d_stringVersion = "3.02";
-        }
 }
 
 
-Rinex_Printer::~Rinex_Printer()
+void Rinex_Printer::close_files()
 {
-    DLOG(INFO) << "RINEX printer destructor called.";
     // close RINEX files
     const auto posn = navFile.tellp();
     const auto poso = obsFile.tellp();
@@ -233,6 +250,7 @@ Rinex_Printer::~Rinex_Printer()
             Rinex_Printer::obsFile.close();
             Rinex_Printer::sbsFile.close();
             Rinex_Printer::navGalFile.close();
+            Rinex_Printer::navMixFile.close();
             Rinex_Printer::navGloFile.close();
             Rinex_Printer::navBdsFile.close();
         }
@@ -301,6 +319,24 @@ Rinex_Printer::~Rinex_Printer()
 }
 
 
+void Rinex_Printer::rotate_files()
+{
+    const std::string new_obsfilename = d_base_path + fs::path::preferred_separator + Rinex_Printer::createFilename("RINEX_FILE_TYPE_OBS", d_base_name);
+    if (new_obsfilename == obsfilename)
+        {
+            // File names are given by the local time, keep on writing the current files
+            LOG(WARNING) << "RINEX file " << obsfilename << " already in use, the files are not rotated";
+            return;
+        }
+    Rinex_Printer::close_files();
+    output_navfilename.clear();
+    Rinex_Printer::open_files();
+    d_rinex_header_written = false;
+    d_rinex_header_updated = false;
+    LOG(INFO) << "New RINEX observation file: " << obsfilename;
+}
+
+
 void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, const std::map<int, Gnss_Synchro>& gnss_observables_map, double rx_time, int type_of_rx, bool flag_write_RINEX_obs_output)
 {
     std::map<int, Galileo_Ephemeris>::const_iterator galileo_ephemeris_iter;
@@ -308,8 +344,16 @@ void Rinex_Printer::print_rinex_annotation(const Rtklib_Solver* pvt_solver, cons
     std::map<int, Gps_CNAV_Ephemeris>::const_iterator gps_cnav_ephemeris_iter;
     std::map<int, Glonass_Gnav_Ephemeris>::const_iterator glonass_gnav_ephemeris_iter;
     std::map<int, Beidou_Dnav_Ephemeris>::const_iterator beidou_dnav_ephemeris_iter;
+    const int64_t rotation_index = d_rotation_period_s > 0 ? static_cast<int64_t>(std::floor(rx_time / static_cast<double>(d_rotation_period_s))) : 0;
+    if (d_rinex_header_written && (rotation_index != d_rotation_index))
+        {
+            // Start a new set of files, whose headers are written right below
+            d_rotation_index = rotation_index;
+            Rinex_Printer::rotate_files();
+        }
     if (!d_rinex_header_written)  // & we have utc data in nav message!
         {
+            d_rotation_index = rotation_index;
             galileo_ephemeris_iter = pvt_solver->galileo_ephemeris_map.cbegin();
             gps_ephemeris_iter = pvt_solver->gps_ephemeris_map.cbegin();
             gps_cnav_ephemeris_iter = pvt_solver->gps_cnav_ephemeris_map.cbegin();
@@ -1497,6 +1541,20 @@ std::string Rinex_Printer::createFilename(const std::string& type, const std::st
         {
             filename = stationName + dayOfTheYearTag + hourTag + minTag + "." + yearTag + typeOfFile;
         }
+    else if (d_rotation_period_s > 0)
+        {
+            // the name of each rotated file must be different
+            std::string sessionTag = hourTag + minTag;
+            if (d_rotation_period_s % 86400 == 0)
+                {
+                    sessionTag = "0";  // daily files
+                }
+            else if (d_rotation_period_s % 3600 == 0)
+                {
+                    sessionTag = hourTag;  // hourly files
+                }
+            filename = base_name + dayOfTheYearTag + sessionTag + "." + yearTag + typeOfFile;
+        }
     else
         {
             filename = base_name + "." + yearTag + typeOfFile;
@@ -1505,6 +1563,93 @@ std::string Rinex_Printer::createFilename(const std::string& type, const std::st
 }
 
 
+std::string Rinex_Printer::reserved_header_line() const
+{
+    std::string line;
+    line += std::string(60, ' ');
+    line += Rinex_Printer::leftJustify("COMMENT", 20);
+    return line;
+}
+
+
+void Rinex_Printer::rewrite_header(std::fstream& out, const std::string& filename, std::vector<std::string>& header) const
+{
+    // The reading stopped right after the END OF HEADER line
+    const int64_t old_size = out.tellg();
+    out.clear();
+    if (old_size <= 0)
+        {
+            LOG(WARNING) << "END OF HEADER not found in " << filename << ", the header is not updated";
+            out.seekp(0, std::ios_base::end);
+            return;
+        }
+
+    int64_t new_size = 0;
+    for (const auto& line : header)
+        {
+            new_size += static_cast<int64_t>(line.size()) + 1;
+        }
+
+    // Use the reserved lines to keep the size of the header
+    const std::string reserved = Rinex_Printer::reserved_header_line();
+    const int64_t reserved_size = static_cast<int64_t>(reserved.size()) + 1;
+    auto it = header.begin();
+    while (new_size > old_size && it != header.end())
+        {
+            if (*it == reserved)
+                {
+                    it = header.erase(it);
+                    new_size -= reserved_size;
+                }
+            else
+                {
+                    ++it;
+                }
+        }
+    while (new_size < old_size && (old_size - new_size) % reserved_size == 0)
+        {
+            header.insert(header.end() - 1, reserved);
+            new_size += reserved_size;
+        }
+
+    // Make sure that all the records are in the file before writing it
+    out.flush();
+    if (new_size == old_size)
+        {
+            // The records that follow the header are not touched
+            std::fstream header_file(filename, std::ios::out | std::ios::in);
+            for (const auto& line : header)
+                {
+                    header_file << line << '\n';
+                }
+            header_file.close();
+            out.seekp(0, std::ios_base::end);
+            return;
+        }
+
+    // The size of the header changes, the file must be copied
+    LOG(INFO) << "Not enough reserved lines in the header of " << filename << ", copying the file";
+    const std::string tmp_filename = filename + ".tmp";
+    std::ofstream tmp_file(tmp_filename, std::ios::out | std::ios::trunc);
+    for (const auto& line : header)
+        {
+            tmp_file << line << '\n';
+        }
+    out.seekg(old_size);
+    tmp_file << out.rdbuf();
+    tmp_file.close();
+    out.close();
+    errorlib::error_code ec;
+    fs::rename(fs::path(tmp_filename), fs::path(filename), ec);
+    if (ec)
+        {
+            LOG(WARNING) << "Error renaming " << tmp_filename << ": " << ec.message();
+        }
+    out.open(filename, std::ios::out | std::ios::in | std::ios::app);
+    out.seekp(0, std::ios_base::end);
+}
+
+
 std::string Rinex_Printer::getLocalTime() const
 {
     std::string line;
@@ -3644,52 +3789,40 @@ void Rinex_Printer::update_nav_header(std::fstream& out, const Glonass_Gnav_Utc_
     std::vector<std::string> data;
     std::string line_aux;
 
-    const int64_t pos = out.tellp();
-    out.seekp(0);
-    data.clear();
+    out.seekg(0);
 
-    bool no_more_finds = false;
     std::string line_str;
 
-    while (!out.eof())
+    while (std::getline(out, line_str))
         {
-            std::getline(out, line_str);
+            line_aux.clear();
 
-            if (!no_more_finds)
+            if ((line_str.find("GLUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
                 {
-                    line_aux.clear();
-
-                    if ((line_str.find("GLUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GLUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_c, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GLGP", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GLGP");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_gps, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
-                        }
-                    else
-                        {
-                            data.push_back(line_str);
-                        }
+                    line_aux += std::string("GLUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_c, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GLGP", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GLGP");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_gps, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("END OF HEADER", 59) != std::string::npos)
+                {
+                    data.push_back(line_str);
+                    break;
                 }
             else
                 {
@@ -3697,16 +3830,7 @@ void Rinex_Printer::update_nav_header(std::fstream& out, const Glonass_Gnav_Utc_
                 }
         }
 
-    out.close();
-    out.open(navGlofilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << '\n';
-        }
-    out.close();
-    out.open(navGlofilename, std::ios::out | std::ios::app);
-    out.seekp(pos);
+    Rinex_Printer::rewrite_header(out, navGlofilename, data);
     std::cout << "The RINEX Navigation file header has been updated with UTC info.\n";
 }
 
@@ -3716,75 +3840,63 @@ void Rinex_Printer::update_nav_header(std::fstream& out, const Galileo_Iono& gal
     std::vector<std::string> data;
     std::string line_aux;
 
-    const int64_t pos = out.tellp();
-    out.seekp(0);
-    data.clear();
+    out.seekg(0);
 
-    bool no_more_finds = false;
     std::string line_str;
 
-    while (!out.eof())
-        {
-            std::getline(out, line_str);
-
-            if (!no_more_finds)
+    while (std::getline(out, line_str))
+        {
+            line_aux.clear();
+
+            if ((line_str.find("GAL", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GAL ");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai2, 10, 2), 12);
+                    const double zero = 0.0;
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(zero, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GAUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GAUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A0, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A1, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.tot), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WNot), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GPGA", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GPGA");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A_0G, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A_1G, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.t_0G), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_0G), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
+                {
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.Delta_tLS), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.Delta_tLSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
+                    line_aux += std::string(36, ' ');
+                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("END OF HEADER", 59) != std::string::npos)
                 {
-                    line_aux.clear();
-
-                    if ((line_str.find("GAL", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GAL ");
-                            line_aux += std::string(1, ' ');
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai0, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai1, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai2, 10, 2), 12);
-                            const double zero = 0.0;
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(zero, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GAUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GAUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A0, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A1, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.tot), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WNot), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GPGA", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GPGA");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A_0G, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A_1G, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.t_0G), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_0G), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
-                        {
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.Delta_tLS), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.Delta_tLSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
-                            line_aux += std::string(36, ' ');
-                            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
-                        }
-                    else
-                        {
-                            data.push_back(line_str);
-                        }
+                    data.push_back(line_str);
+                    break;
                 }
             else
                 {
@@ -3792,16 +3904,7 @@ void Rinex_Printer::update_nav_header(std::fstream& out, const Galileo_Iono& gal
                 }
         }
 
-    out.close();
-    out.open(navGalfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << '\n';
-        }
-    out.close();
-    out.open(navGalfilename, std::ios::out | std::ios::app);
-    out.seekp(pos);
+    Rinex_Printer::rewrite_header(out, navGalfilename, data);
     std::cout << "The RINEX Navigation file header has been updated with UTC and IONO info.\n";
 }
 
@@ -3811,200 +3914,83 @@ void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_Utc_Model& ut
     std::vector<std::string> data;
     std::string line_aux;
 
-    int64_t pos = out.tellp();
-    out.seekp(0);
-    data.clear();
+    out.seekg(0);
 
-    bool no_more_finds = false;
     std::string line_str;
 
-    while (!out.eof())
+    while (std::getline(out, line_str))
         {
-            std::getline(out, line_str);
+            line_aux.clear();
 
-            if (!no_more_finds)
+            if (d_version == 2)
                 {
-                    line_aux.clear();
-
-                    if (d_version == 2)
+                    if (line_str.find("ION ALPHA", 59) != std::string::npos)
                         {
-                            if (line_str.find("ION ALPHA", 59) != std::string::npos)
-                                {
-                                    line_aux += std::string(2, ' ');
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha0, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha1, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha2, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha3, 10, 2), 12);
-                                    line_aux += std::string(10, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("ION ALPHA", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("ION BETA", 59) != std::string::npos)
-                                {
-                                    line_aux += std::string(2, ' ');
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta0, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta1, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta2, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta3, 10, 2), 12);
-                                    line_aux += std::string(10, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("ION BETA", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("DELTA-UTC", 59) != std::string::npos)
-                                {
-                                    line_aux += std::string(3, ' ');
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A0, 18, 2), 19);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A1, 18, 2), 19);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.tot), 9);
-                                    if (d_pre_2009_file == false)
-                                        {
-                                            if (eph.WN < 512)
-                                                {
-                                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T + (eph.WN / 256) * 256 + 2048), 9);  // valid from 2019 to 2029
-                                                }
-                                            else
-                                                {
-                                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T + (eph.WN / 256) * 256 + 1024), 9);  // valid from 2009 to 2019
-                                                }
-                                        }
-                                    else
-                                        {
-                                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T + (eph.WN / 256) * 256), 9);
-                                        }
-                                    line_aux += std::string(1, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("DELTA-UTC: A0,A1,T,W", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
-                                {
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
-                                    line_aux += std::string(54, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                                {
-                                    data.push_back(line_str);
-                                    no_more_finds = true;
-                                }
-                            else
-                                {
-                                    data.push_back(line_str);
-                                }
+                            line_aux += std::string(2, ' ');
+                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha0, 10, 2), 12);
+                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha1, 10, 2), 12);
+                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha2, 10, 2), 12);
+                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha3, 10, 2), 12);
+                            line_aux += std::string(10, ' ');
+                            line_aux += Rinex_Printer::leftJustify("ION ALPHA", 20);
+                            data.push_back(line_aux);
                         }
-
-                    if (d_version == 3)
+                    else if (line_str.find("ION BETA", 59) != std::string::npos)
                         {
-                            if (line_str.find("GPSA", 0) != std::string::npos)
-                                {
-                                    line_aux += std::string("GPSA");
-                                    line_aux += std::string(1, ' ');
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha0, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha1, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha2, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha3, 10, 2), 12);
-                                    line_aux += std::string(7, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("GPSB", 0) != std::string::npos)
-                                {
-                                    line_aux += std::string("GPSB");
-                                    line_aux += std::string(1, ' ');
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta0, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta1, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta2, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta3, 10, 2), 12);
-                                    line_aux += std::string(7, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("GPUT", 0) != std::string::npos)
+                            line_aux += std::string(2, ' ');
+                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta0, 10, 2), 12);
+                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta1, 10, 2), 12);
+                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta2, 10, 2), 12);
+                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta3, 10, 2), 12);
+                            line_aux += std::string(10, ' ');
+                            line_aux += Rinex_Printer::leftJustify("ION BETA", 20);
+                            data.push_back(line_aux);
+                        }
+                    else if (line_str.find("DELTA-UTC", 59) != std::string::npos)
+                        {
+                            line_aux += std::string(3, ' ');
+                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A0, 18, 2), 19);
+                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A1, 18, 2), 19);
+                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.tot), 9);
+                            if (d_pre_2009_file == false)
                                 {
-                                    line_aux += std::string("GPUT");
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A0, 16, 2), 18);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A1, 15, 2), 16);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.tot), 7);
-                                    if (d_pre_2009_file == false)
+                                    if (eph.WN < 512)
                                         {
-                                            if (eph.WN < 512)
-                                                {
-                                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T + (eph.WN / 256) * 256 + 2048), 5);  // valid from 2019 to 2029
-                                                }
-                                            else
-                                                {
-                                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T + (eph.WN / 256) * 256 + 1024), 5);  // valid from 2009 to 2019
-                                                }
+                                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T + (eph.WN / 256) * 256 + 2048), 9);  // valid from 2019 to 2029
                                         }
                                     else
                                         {
-                                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T + (eph.WN / 256) * 256 + 1024), 5);  // valid from 1999 to 2008
+                                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T + (eph.WN / 256) * 256 + 1024), 9);  // valid from 2009 to 2019
                                         }
-                                    line_aux += std::string(10, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
-                                {
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
-                                    line_aux += std::string(36, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                                {
-                                    data.push_back(line_str);
-                                    no_more_finds = true;
                                 }
                             else
                                 {
-                                    data.push_back(line_str);
+                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T + (eph.WN / 256) * 256), 9);
                                 }
+                            line_aux += std::string(1, ' ');
+                            line_aux += Rinex_Printer::leftJustify("DELTA-UTC: A0,A1,T,W", 20);
+                            data.push_back(line_aux);
+                        }
+                    else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
+                        {
+                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
+                            line_aux += std::string(54, ' ');
+                            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+                            data.push_back(line_aux);
+                        }
+                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
+                        {
+                            data.push_back(line_str);
+                            break;
+                        }
+                    else
+                        {
+                            data.push_back(line_str);
                         }
                 }
-            else
-                {
-                    data.push_back(line_str);
-                }
-        }
-
-    out.close();
-    out.open(navfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << '\n';
-        }
-    out.close();
-    out.open(navfilename, std::ios::out | std::ios::app);
-    out.seekp(pos);
-    std::cout << "The RINEX Navigation file header has been updated with UTC and IONO info.\n";
-}
-
-
-void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_CNAV_Utc_Model& utc_model, const Gps_CNAV_Iono& iono) const
-{
-    std::vector<std::string> data;
-    std::string line_aux;
 
-    const int64_t pos = out.tellp();
-    out.seekp(0);
-    data.clear();
-
-    bool no_more_finds = false;
-    std::string line_str;
-
-    while (!out.eof())
-        {
-            std::getline(out, line_str);
-
-            if (!no_more_finds)
+            if (d_version == 3)
                 {
-                    line_aux.clear();
-
                     if (line_str.find("GPSA", 0) != std::string::npos)
                         {
                             line_aux += std::string("GPSA");
@@ -4035,8 +4021,22 @@ void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_CNAV_Utc_Mode
                             line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A0, 16, 2), 18);
                             line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A1, 15, 2), 16);
                             line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.tot), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T), 5);
-                            line_aux += std::string(10, ' ');
+                            if (d_pre_2009_file == false)
+                                {
+                                    if (eph.WN < 512)
+                                        {
+                                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T + (eph.WN / 256) * 256 + 2048), 5);  // valid from 2019 to 2029
+                                        }
+                                    else
+                                        {
+                                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T + (eph.WN / 256) * 256 + 1024), 5);  // valid from 2009 to 2019
+                                        }
+                                }
+                            else
+                                {
+                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T + (eph.WN / 256) * 256 + 1024), 5);  // valid from 1999 to 2008
+                                }
+                            line_aux += std::string(10, ' ');
                             line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
                             data.push_back(line_aux);
                         }
@@ -4053,29 +4053,90 @@ void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_CNAV_Utc_Mode
                     else if (line_str.find("END OF HEADER", 59) != std::string::npos)
                         {
                             data.push_back(line_str);
-                            no_more_finds = true;
+                            break;
                         }
                     else
                         {
                             data.push_back(line_str);
                         }
                 }
+        }
+
+    Rinex_Printer::rewrite_header(out, navfilename, data);
+    std::cout << "The RINEX Navigation file header has been updated with UTC and IONO info.\n";
+}
+
+
+void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_CNAV_Utc_Model& utc_model, const Gps_CNAV_Iono& iono) const
+{
+    std::vector<std::string> data;
+    std::string line_aux;
+
+    out.seekg(0);
+
+    std::string line_str;
+
+    while (std::getline(out, line_str))
+        {
+            line_aux.clear();
+
+            if (line_str.find("GPSA", 0) != std::string::npos)
+                {
+                    line_aux += std::string("GPSA");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha2, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha3, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("GPSB", 0) != std::string::npos)
+                {
+                    line_aux += std::string("GPSB");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta2, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta3, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("GPUT", 0) != std::string::npos)
+                {
+                    line_aux += std::string("GPUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A0, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A1, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.tot), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
+                {
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
+                    line_aux += std::string(36, ' ');
+                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("END OF HEADER", 59) != std::string::npos)
+                {
+                    data.push_back(line_str);
+                    break;
+                }
             else
                 {
                     data.push_back(line_str);
                 }
         }
 
-    out.close();
-    out.open(navfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << '\n';
-        }
-    out.close();
-    out.open(navfilename, std::ios::out | std::ios::app);
-    out.seekp(pos);
+    Rinex_Printer::rewrite_header(out, navfilename, data);
     std::cout << "The RINEX Navigation file header has been updated with UTC and IONO info.\n";
 }
 
@@ -4085,126 +4146,105 @@ void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_CNAV_Utc_Mode
     std::vector<std::string> data;
     std::string line_aux;
 
-    const int64_t pos = out.tellp();
-    out.seekp(0);
-    data.clear();
+    out.seekg(0);
 
-    bool no_more_finds = false;
     std::string line_str;
 
-    while (!out.eof())
-        {
-            std::getline(out, line_str);
-
-            if (!no_more_finds)
+    while (std::getline(out, line_str))
+        {
+            line_aux.clear();
+            if ((line_str.find("GAL", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GAL ");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai2, 10, 2), 12);
+                    const double zero = 0.0;
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(zero, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GPSA", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GPSA");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha2, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha3, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GPSB", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GPSB");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta2, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta3, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    data.push_back(line_aux);
+                }
+
+            else if ((line_str.find("GAUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GAUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A0, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A1, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.tot), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WNot), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GPGA", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GPGA");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A_0G, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A_1G, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.t_0G), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WN_0G), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("GPUT", 0) != std::string::npos)
+                {
+                    line_aux += std::string("GPUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A0, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A1, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.tot), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
+                {
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
+                    line_aux += std::string(36, ' ');
+                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("END OF HEADER", 59) != std::string::npos)
                 {
-                    line_aux.clear();
-                    if ((line_str.find("GAL", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GAL ");
-                            line_aux += std::string(1, ' ');
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai0, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai1, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai2, 10, 2), 12);
-                            const double zero = 0.0;
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(zero, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GPSA", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GPSA");
-                            line_aux += std::string(1, ' ');
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha0, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha1, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha2, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha3, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GPSB", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GPSB");
-                            line_aux += std::string(1, ' ');
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta0, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta1, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta2, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta3, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
-                        }
-
-                    else if ((line_str.find("GAUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GAUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A0, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A1, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.tot), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WNot), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GPGA", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GPGA");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A_0G, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A_1G, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.t_0G), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WN_0G), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("GPUT", 0) != std::string::npos)
-                        {
-                            line_aux += std::string("GPUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A0, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A1, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.tot), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
-                        {
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
-                            line_aux += std::string(36, ' ');
-                            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
-                        }
-                    else
-                        {
-                            data.push_back(line_str);
-                        }
+                    data.push_back(line_str);
+                    break;
                 }
             else
                 {
                     data.push_back(line_str);
                 }
         }
-    out.close();
-    out.open(navfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << '\n';
-        }
-    out.close();
-    out.open(navfilename, std::ios::out | std::ios::app);
-    out.seekp(pos);
+    Rinex_Printer::rewrite_header(out, navfilename, data);
     std::cout << "The RINEX Navigation file header has been updated with UTC and IONO info.\n";
 }
 
@@ -4214,124 +4254,112 @@ void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_Iono& gps_ion
     std::vector<std::string> data;
     std::string line_aux;
 
-    const int64_t pos = out.tellp();
-    out.seekp(0);
-    data.clear();
+    out.seekg(0);
 
-    bool no_more_finds = false;
     std::string line_str;
 
-    while (!out.eof())
-        {
-            std::getline(out, line_str);
-
-            if (!no_more_finds)
-                {
-                    line_aux.clear();
-
-                    if (line_str.find("GPSA", 0) != std::string::npos)
-                        {
-                            line_aux += std::string("GPSA");
-                            line_aux += std::string(1, ' ');
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha0, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha1, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha2, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha3, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GAL", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GAL ");
-                            line_aux += std::string(1, ' ');
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai0, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai1, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai2, 10, 2), 12);
-                            const double zero = 0.0;
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(zero, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GPSB", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GPSB");
-                            line_aux += std::string(1, ' ');
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.beta0, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.beta1, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.beta2, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.beta3, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GPUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GPUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.A0, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.A1, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.tot), 7);
-                            if (d_pre_2009_file == false)
+    while (std::getline(out, line_str))
+        {
+            line_aux.clear();
+
+            if (line_str.find("GPSA", 0) != std::string::npos)
+                {
+                    line_aux += std::string("GPSA");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha2, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha3, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GAL", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GAL ");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai2, 10, 2), 12);
+                    const double zero = 0.0;
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(zero, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GPSB", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GPSB");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.beta0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.beta1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.beta2, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.beta3, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GPUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GPUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.A0, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.A1, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.tot), 7);
+                    if (d_pre_2009_file == false)
+                        {
+                            if (eph.WN < 512)
                                 {
-                                    if (eph.WN < 512)
-                                        {
-                                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_T + (eph.WN / 256) * 256 + 2048), 5);  // valid from 2019 to 2029
-                                        }
-                                    else
-                                        {
-                                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_T + (eph.WN / 256) * 256 + 1024), 5);  // valid from 2009 to 2019
-                                        }
+                                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_T + (eph.WN / 256) * 256 + 2048), 5);  // valid from 2019 to 2029
                                 }
                             else
                                 {
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_T + (eph.WN / 256) * 256 + 1024), 5);  // valid from 1999 to 2008
+                                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_T + (eph.WN / 256) * 256 + 1024), 5);  // valid from 2009 to 2019
                                 }
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GAUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GAUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A0, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A1, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.tot), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WNot), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GPGA", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GPGA");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A_0G, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A_1G, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.t_0G), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WN_0G), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
-                        {
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DeltaT_LS), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DeltaT_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DN), 6);
-                            line_aux += std::string(36, ' ');
-                            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
                         }
                     else
                         {
-                            data.push_back(line_str);
+                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_T + (eph.WN / 256) * 256 + 1024), 5);  // valid from 1999 to 2008
                         }
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GAUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GAUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A0, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A1, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.tot), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WNot), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GPGA", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GPGA");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A_0G, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A_1G, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.t_0G), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WN_0G), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
+                {
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DeltaT_LS), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DeltaT_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DN), 6);
+                    line_aux += std::string(36, ' ');
+                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("END OF HEADER", 59) != std::string::npos)
+                {
+                    data.push_back(line_str);
+                    break;
                 }
             else
                 {
@@ -4339,16 +4367,7 @@ void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_Iono& gps_ion
                 }
         }
 
-    out.close();
-    out.open(navMixfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << '\n';
-        }
-    out.close();
-    out.open(navMixfilename, std::ios::out | std::ios::app);
-    out.seekp(pos);
+    Rinex_Printer::rewrite_header(out, navMixfilename, data);
     std::cout << "The RINEX Navigation file header has been updated with UTC and IONO info.\n";
 }
 
@@ -4361,99 +4380,87 @@ void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_Iono& gps_ion
     std::vector<std::string> data;
     std::string line_aux;
 
-    const int64_t pos = out.tellp();
-    out.seekp(0);
-    data.clear();
+    out.seekg(0);
 
-    bool no_more_finds = false;
     std::string line_str;
 
-    while (!out.eof())
+    while (std::getline(out, line_str))
         {
-            std::getline(out, line_str);
+            line_aux.clear();
 
-            if (!no_more_finds)
+            if (line_str.find("GPSA", 0) != std::string::npos)
                 {
-                    line_aux.clear();
-
-                    if (line_str.find("GPSA", 0) != std::string::npos)
-                        {
-                            line_aux += std::string("GPSA");
-                            line_aux += std::string(1, ' ');
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha0, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha1, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha2, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha3, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GPUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                    line_aux += std::string("GPSA");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha2, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha3, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GPUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GPUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.A0, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.A1, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.tot), 7);
+                    if (d_pre_2009_file == false)
                         {
-                            line_aux += std::string("GPUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.A0, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.A1, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.tot), 7);
-                            if (d_pre_2009_file == false)
+                            if (eph.WN < 512)
                                 {
-                                    if (eph.WN < 512)
-                                        {
-                                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_T + (eph.WN / 256) * 256 + 2048), 5);  // valid from 2019 to 2029
-                                        }
-                                    else
-                                        {
-                                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_T + (eph.WN / 256) * 256 + 1024), 5);  // valid from 2009 to 2019
-                                        }
+                                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_T + (eph.WN / 256) * 256 + 2048), 5);  // valid from 2019 to 2029
                                 }
                             else
                                 {
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_T + (eph.WN / 256) * 256), 5);
+                                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_T + (eph.WN / 256) * 256 + 1024), 5);  // valid from 2009 to 2019
                                 }
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GLUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GLUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_c, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GLGP", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GLGP");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_gps, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
-                        {
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DeltaT_LS), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DeltaT_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DN), 6);
-                            line_aux += std::string(36, ' ');
-                            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
                         }
                     else
                         {
-                            data.push_back(line_str);
+                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_T + (eph.WN / 256) * 256), 5);
                         }
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GLUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GLUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_c, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GLGP", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GLGP");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_gps, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
+                {
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DeltaT_LS), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DeltaT_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DN), 6);
+                    line_aux += std::string(36, ' ');
+                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("END OF HEADER", 59) != std::string::npos)
+                {
+                    data.push_back(line_str);
+                    break;
                 }
             else
                 {
@@ -4461,16 +4468,7 @@ void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_Iono& gps_ion
                 }
         }
 
-    out.close();
-    out.open(navMixfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << '\n';
-        }
-    out.close();
-    out.open(navMixfilename, std::ios::out | std::ios::app);
-    out.seekp(pos);
+    Rinex_Printer::rewrite_header(out, navMixfilename, data);
     std::cout << "The RINEX Navigation file header has been updated with UTC and IONO info.\n";
 }
 
@@ -4481,87 +4479,75 @@ void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_CNAV_Iono& gp
         {
         }  // Avoid compiler warning
     std::vector<std::string> data;
-    std::string line_aux;
-
-    const int64_t pos = out.tellp();
-    out.seekp(0);
-    data.clear();
-
-    bool no_more_finds = false;
-    std::string line_str;
-
-    while (!out.eof())
-        {
-            std::getline(out, line_str);
-
-            if (!no_more_finds)
-                {
-                    line_aux.clear();
-
-                    if (line_str.find("GPSA", 0) != std::string::npos)
-                        {
-                            line_aux += std::string("GPSA");
-                            line_aux += std::string(1, ' ');
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha0, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha1, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha2, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha3, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GPUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GPUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.A0, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.A1, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.tot), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_T), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GLUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GLUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_c, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GLGP", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GLGP");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_gps, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
-                        {
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DeltaT_LS), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DeltaT_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DN), 6);
-                            line_aux += std::string(36, ' ');
-                            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
-                        }
-                    else
-                        {
-                            data.push_back(line_str);
-                        }
+    std::string line_aux;
+
+    out.seekg(0);
+
+    std::string line_str;
+
+    while (std::getline(out, line_str))
+        {
+            line_aux.clear();
+
+            if (line_str.find("GPSA", 0) != std::string::npos)
+                {
+                    line_aux += std::string("GPSA");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha2, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha3, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GPUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GPUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.A0, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.A1, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.tot), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_T), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GLUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GLUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_c, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GLGP", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GLGP");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_gps, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
+                {
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DeltaT_LS), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DeltaT_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DN), 6);
+                    line_aux += std::string(36, ' ');
+                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("END OF HEADER", 59) != std::string::npos)
+                {
+                    data.push_back(line_str);
+                    break;
                 }
             else
                 {
@@ -4569,16 +4555,7 @@ void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_CNAV_Iono& gp
                 }
         }
 
-    out.close();
-    out.open(navMixfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << '\n';
-        }
-    out.close();
-    out.open(navMixfilename, std::ios::out | std::ios::app);
-    out.seekp(pos);
+    Rinex_Printer::rewrite_header(out, navMixfilename, data);
     std::cout << "The RINEX Navigation file header has been updated with UTC and IONO info.\n";
 }
 
@@ -4595,75 +4572,63 @@ void Rinex_Printer::update_nav_header(std::fstream& out, const Galileo_Iono& gal
     std::vector<std::string> data;
     std::string line_aux;
 
-    const int64_t pos = out.tellp();
-    out.seekp(0);
-    data.clear();
+    out.seekg(0);
 
-    bool no_more_finds = false;
     std::string line_str;
 
-    while (!out.eof())
-        {
-            std::getline(out, line_str);
-
-            if (!no_more_finds)
+    while (std::getline(out, line_str))
+        {
+            line_aux.clear();
+
+            if ((line_str.find("GAL", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GAL ");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai2, 10, 2), 12);
+                    const double zero = 0.0;
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(zero, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GAUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GAUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A0, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A1, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.tot), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WNot), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if ((line_str.find("GLUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GLUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_c, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
+                {
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.Delta_tLS), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.Delta_tLSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WN_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.DN), 6);
+                    line_aux += std::string(36, ' ');
+                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("END OF HEADER", 59) != std::string::npos)
                 {
-                    line_aux.clear();
-
-                    if ((line_str.find("GAL", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GAL ");
-                            line_aux += std::string(1, ' ');
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai0, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai1, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai2, 10, 2), 12);
-                            const double zero = 0.0;
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(zero, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GAUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GAUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A0, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A1, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.tot), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WNot), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GLUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GLUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_c, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
-                        {
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.Delta_tLS), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.Delta_tLSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WN_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.DN), 6);
-                            line_aux += std::string(36, ' ');
-                            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
-                        }
-                    else
-                        {
-                            data.push_back(line_str);
-                        }
+                    data.push_back(line_str);
+                    break;
                 }
             else
                 {
@@ -4671,16 +4636,7 @@ void Rinex_Printer::update_nav_header(std::fstream& out, const Galileo_Iono& gal
                 }
         }
 
-    out.close();
-    out.open(navMixfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << '\n';
-        }
-    out.close();
-    out.open(navMixfilename, std::ios::out | std::ios::app);
-    out.seekp(pos);
+    Rinex_Printer::rewrite_header(out, navMixfilename, data);
     std::cout << "The RINEX Navigation file header has been updated with UTC and IONO info.\n";
 }
 
@@ -4690,73 +4646,61 @@ void Rinex_Printer::update_nav_header(std::fstream& out, const Beidou_Dnav_Utc_M
     std::vector<std::string> data;
     std::string line_aux;
 
-    const int64_t pos = out.tellp();
-    out.seekp(0);
-    data.clear();
+    out.seekg(0);
 
-    bool no_more_finds = false;
     std::string line_str;
 
-    while (!out.eof())
+    while (std::getline(out, line_str))
         {
-            std::getline(out, line_str);
+            line_aux.clear();
 
-            if (!no_more_finds)
+            if (line_str.find("BDSA", 0) != std::string::npos)
                 {
-                    line_aux.clear();
-
-                    if (line_str.find("BDSA", 0) != std::string::npos)
-                        {
-                            line_aux += std::string("BDSA");
-                            line_aux += std::string(1, ' ');
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha0, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha1, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha2, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha3, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("BDSB", 0) != std::string::npos)
-                        {
-                            line_aux += std::string("BDSB");
-                            line_aux += std::string(1, ' ');
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta0, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta1, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta2, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta3, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("BDUT", 0) != std::string::npos)
-                        {
-                            line_aux += std::string("BDUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A0_UTC, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A1_UTC, 15, 2), 16);
-                            line_aux += std::string(22, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
-                        {
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
-                            line_aux += std::string(36, ' ');
-                            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
-                        }
-                    else
-                        {
-                            data.push_back(line_str);
-                        }
+                    line_aux += std::string("BDSA");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha2, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha3, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("BDSB", 0) != std::string::npos)
+                {
+                    line_aux += std::string("BDSB");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta2, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta3, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("BDUT", 0) != std::string::npos)
+                {
+                    line_aux += std::string("BDUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A0_UTC, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A1_UTC, 15, 2), 16);
+                    line_aux += std::string(22, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
+                {
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
+                    line_aux += std::string(36, ' ');
+                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("END OF HEADER", 59) != std::string::npos)
+                {
+                    data.push_back(line_str);
+                    break;
                 }
             else
                 {
@@ -4764,16 +4708,7 @@ void Rinex_Printer::update_nav_header(std::fstream& out, const Beidou_Dnav_Utc_M
                 }
         }
 
-    out.close();
-    out.open(navfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << '\n';
-        }
-    out.close();
-    out.open(navfilename, std::ios::out | std::ios::app);
-    out.seekp(pos);
+    Rinex_Printer::rewrite_header(out, navfilename, data);
     std::cout << "The RINEX Navigation file header has been updated with UTC and IONO info.\n";
 }
 
@@ -5333,6 +5268,12 @@ void Rinex_Printer::log_rinex_nav(std::fstream& out, const std::map<int32_t, Gal
          galileo_ephemeris_iter != eph_map.cend();
          galileo_ephemeris_iter++)
         {
+            if (galileo_ephemeris_iter->second.flag_reduced_ced)
+                {
+                    // a reduced CED is not a broadcast ephemeris set, and the
+                    // header and rotated files are written from the whole map
+                    continue;
+                }
             // -------- SV / EPOCH / SV CLK
             const boost::posix_time::ptime p_utc_time = Rinex_Printer::compute_Galileo_time(galileo_ephemeris_iter->second, galileo_ephemeris_iter->second.toe);
             const std::string timestring = boost::posix_time::to_iso_string(p_utc_time);
@@ -6604,6 +6545,9 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_Ephemeris& gps
             out << line << '\n';
         }
 
+    // -------- reserved for the LEAP SECONDS record added by update_obs_header
+    out << Rinex_Printer::reserved_header_line() << '\n';
+
     // -------- end of header
     line.clear();
     line += std::string(60, ' ');
@@ -6928,6 +6872,9 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_CNAV_Ephemeris
     Rinex_Printer::lengthCheck(line);
     out << line << '\n';
 
+    // -------- reserved for the LEAP SECONDS record added by update_obs_header
+    out << Rinex_Printer::reserved_header_line() << '\n';
+
     // -------- end of header
     line.clear();
     line += std::string(60, ' ');
@@ -7252,6 +7199,9 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Galileo_Ephemeris&
     Rinex_Printer::lengthCheck(line);
     out << line << '\n';
 
+    // -------- reserved for the LEAP SECONDS record added by update_obs_header
+    out << Rinex_Printer::reserved_header_line() << '\n';
+
     // -------- end of header
     line.clear();
     line += std::string(60, ' ');
@@ -7520,6 +7470,9 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_Ephemeris& eph
 
     // -------- SYS /PHASE SHIFTS
 
+    // -------- reserved for the LEAP SECONDS record added by update_obs_header
+    out << Rinex_Printer::reserved_header_line() << '\n';
+
     // -------- end of header
     line.clear();
     line += std::string(60, ' ');
@@ -7772,6 +7725,9 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_CNAV_Ephemeris
 
     // -------- SYS /PHASE SHIFTS
 
+    // -------- reserved for the LEAP SECONDS record added by update_obs_header
+    out << Rinex_Printer::reserved_header_line() << '\n';
+
     // -------- end of header
     line.clear();
     line += std::string(60, ' ');
@@ -8051,6 +8007,9 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_Ephemeris& eph
 
     // -------- SYS /PHASE SHIFTS
 
+    // -------- reserved for the LEAP SECONDS record added by update_obs_header
+    out << Rinex_Printer::reserved_header_line() << '\n';
+
     // -------- end of header
     line.clear();
     line += std::string(60, ' ');
@@ -8406,6 +8365,9 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_Ephemeris& gps
     Rinex_Printer::lengthCheck(line);
     out << line << '\n';
 
+    // -------- reserved for the LEAP SECONDS record added by update_obs_header
+    out << Rinex_Printer::reserved_header_line() << '\n';
+
     // -------- end of header
     line.clear();
     line += std::string(60, ' ');
@@ -8731,6 +8693,9 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_CNAV_Ephemeris
     Rinex_Printer::lengthCheck(line);
     out << line << '\n';
 
+    // -------- reserved for the LEAP SECONDS record added by update_obs_header
+    out << Rinex_Printer::reserved_header_line() << '\n';
+
     // -------- end of header
     line.clear();
     line += std::string(60, ' ');
@@ -8999,6 +8964,9 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Galileo_Ephemeris&
 
     // -------- SYS /PHASE SHIFTS
 
+    // -------- reserved for the LEAP SECONDS record added by update_obs_header
+    out << Rinex_Printer::reserved_header_line() << '\n';
+
     // -------- end of header
     line.clear();
     line += std::string(60, ' ');
@@ -9296,6 +9264,9 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_Ephemeris& gps
     Rinex_Printer::lengthCheck(line);
     out << line << '\n';
 
+    // -------- reserved for the LEAP SECONDS record added by update_obs_header
+    out << Rinex_Printer::reserved_header_line() << '\n';
+
     // -------- end of header
     line.clear();
     line += std::string(60, ' ');
@@ -9532,6 +9503,9 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Beidou_Dnav_Epheme
 
     // -------- SYS /PHASE SHIFTS
 
+    // -------- reserved for the LEAP SECONDS record added by update_obs_header
+    out << Rinex_Printer::reserved_header_line() << '\n';
+
     // -------- end of header
     line.clear();
     line += std::string(60, ' ');
@@ -9555,102 +9529,37 @@ void Rinex_Printer::update_obs_header(std::fstream& out, const Gps_Utc_Model& ut
     std::vector<std::string> data;
     std::string line_aux;
 
-    out.seekp(0);
-    data.clear();
+    out.seekg(0);
 
-    bool no_more_finds = false;
     std::string line_str;
 
-    while (!out.eof())
+    while (std::getline(out, line_str))
         {
-            std::getline(out, line_str);
+            line_aux.clear();
 
-            if (!no_more_finds)
+            if (d_version == 2)
                 {
-                    line_aux.clear();
-
-                    if (d_version == 2)
+                    if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)  // TIME OF FIRST OBS last header annotation might change in the future
                         {
-                            if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)  // TIME OF FIRST OBS last header annotation might change in the future
-                                {
-                                    data.push_back(line_str);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
-                                    line_aux += std::string(54, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                                {
-                                    data.push_back(line_str);
-                                    no_more_finds = true;
-                                }
-                            else
-                                {
-                                    data.push_back(line_str);
-                                }
+                            data.push_back(line_str);
+                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
+                            line_aux += std::string(54, ' ');
+                            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+                            data.push_back(line_aux);
                         }
-
-                    if (d_version == 3)
+                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
                         {
-                            if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)
-                                {
-                                    data.push_back(line_str);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
-                                    line_aux += std::string(36, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                                {
-                                    data.push_back(line_str);
-                                    no_more_finds = true;
-                                }
-                            else
-                                {
-                                    data.push_back(line_str);
-                                }
+                            data.push_back(line_str);
+                            break;
+                        }
+                    else
+                        {
+                            data.push_back(line_str);
                         }
                 }
-            else
-                {
-                    data.push_back(line_str);
-                }
-        }
-
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << '\n';
-        }
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::in | std::ios::app);
-    out.seekp(0, std::ios_base::end);
-}
-
-
-void Rinex_Printer::update_obs_header(std::fstream& out, const Gps_CNAV_Utc_Model& utc_model) const
-{
-    std::vector<std::string> data;
-    std::string line_aux;
-
-    out.seekp(0);
-    data.clear();
 
-    bool no_more_finds = false;
-    std::string line_str;
-
-    while (!out.eof())
-        {
-            std::getline(out, line_str);
-
-            if (!no_more_finds)
+            if (d_version == 3)
                 {
-                    line_aux.clear();
                     if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)
                         {
                             data.push_back(line_str);
@@ -9665,29 +9574,54 @@ void Rinex_Printer::update_obs_header(std::fstream& out, const Gps_CNAV_Utc_Mode
                     else if (line_str.find("END OF HEADER", 59) != std::string::npos)
                         {
                             data.push_back(line_str);
-                            no_more_finds = true;
+                            break;
                         }
                     else
                         {
                             data.push_back(line_str);
                         }
                 }
+        }
+
+    Rinex_Printer::rewrite_header(out, obsfilename, data);
+}
+
+
+void Rinex_Printer::update_obs_header(std::fstream& out, const Gps_CNAV_Utc_Model& utc_model) const
+{
+    std::vector<std::string> data;
+    std::string line_aux;
+
+    out.seekg(0);
+
+    std::string line_str;
+
+    while (std::getline(out, line_str))
+        {
+            line_aux.clear();
+            if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)
+                {
+                    data.push_back(line_str);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
+                    line_aux += std::string(36, ' ');
+                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("END OF HEADER", 59) != std::string::npos)
+                {
+                    data.push_back(line_str);
+                    break;
+                }
             else
                 {
                     data.push_back(line_str);
                 }
         }
 
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << '\n';
-        }
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::in | std::ios::app);
-    out.seekp(0, std::ios_base::end);
+    Rinex_Printer::rewrite_header(out, obsfilename, data);
 }
 
 
@@ -9696,40 +9630,29 @@ void Rinex_Printer::update_obs_header(std::fstream& out, const Galileo_Utc_Model
     std::vector<std::string> data;
     std::string line_aux;
 
-    out.seekp(0);
-    data.clear();
+    out.seekg(0);
 
-    bool no_more_finds = false;
     std::string line_str;
 
-    while (!out.eof())
+    while (std::getline(out, line_str))
         {
-            std::getline(out, line_str);
+            line_aux.clear();
 
-            if (!no_more_finds)
+            if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)
                 {
-                    line_aux.clear();
-
-                    if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.Delta_tLS), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.Delta_tLSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WN_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.DN), 6);
-                            line_aux += std::string(36, ' ');
-                            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
-                        }
-                    else
-                        {
-                            data.push_back(line_str);
-                        }
+                    data.push_back(line_str);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.Delta_tLS), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.Delta_tLSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WN_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.DN), 6);
+                    line_aux += std::string(36, ' ');
+                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("END OF HEADER", 59) != std::string::npos)
+                {
+                    data.push_back(line_str);
+                    break;
                 }
             else
                 {
@@ -9737,16 +9660,7 @@ void Rinex_Printer::update_obs_header(std::fstream& out, const Galileo_Utc_Model
                 }
         }
 
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << '\n';
-        }
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::in | std::ios::app);
-    out.seekp(0, std::ios_base::end);
+    Rinex_Printer::rewrite_header(out, obsfilename, data);
 }
 
 
@@ -9755,40 +9669,29 @@ void Rinex_Printer::update_obs_header(std::fstream& out, const Beidou_Dnav_Utc_M
     std::vector<std::string> data;
     std::string line_aux;
 
-    out.seekp(0);
-    data.clear();
+    out.seekg(0);
 
-    bool no_more_finds = false;
     std::string line_str;
 
-    while (!out.eof())
+    while (std::getline(out, line_str))
         {
-            std::getline(out, line_str);
+            line_aux.clear();
 
-            if (!no_more_finds)
+            if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)
                 {
-                    line_aux.clear();
-
-                    if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
-                            line_aux += std::string(36, ' ');
-                            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
-                        }
-                    else
-                        {
-                            data.push_back(line_str);
-                        }
+                    data.push_back(line_str);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
+                    line_aux += std::string(36, ' ');
+                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+                    data.push_back(line_aux);
+                }
+            else if (line_str.find("END OF HEADER", 59) != std::string::npos)
+                {
+                    data.push_back(line_str);
+                    break;
                 }
             else
                 {
@@ -9796,16 +9699,7 @@ void Rinex_Printer::update_obs_header(std::fstream& out, const Beidou_Dnav_Utc_M
                 }
         }
 
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << '\n';
-        }
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::in | std::ios::app);
-    out.seekp(0, std::ios_base::end);
+    Rinex_Printer::rewrite_header(out, obsfilename, data);
 }
 
 
@@ -84,10 +84,14 @@ class Rinex_Printer
 public:
     /*!
      * \brief Constructor. Creates GNSS Navigation and Observables RINEX files.
+     * If rotation_period_s is not zero, a new set of files is started every
+     * rotation_period_s seconds of receiver time (e.g., 3600 for hourly files,
+     * 86400 for daily files).
      */
     explicit Rinex_Printer(int version = 0,
         const std::string& base_path = ".",
-        const std::string& base_name = "-");
+        const std::string& base_name = "-",
+        uint32_t rotation_period_s = 0);
 
     /*!
      * \brief Destructor. Removes created files if empty.
@@ -798,6 +802,37 @@ private:
      */
     std::string createFilename(const std::string& type, const std::string& base_name) const;
 
+    /*
+     * Creates the file names and opens the RINEX files
+     */
+    void open_files();
+
+    /*
+     * Closes the RINEX files, and removes those that are empty
+     */
+    void close_files();
+
+    /*
+     * Closes the current RINEX files and starts a new set. The headers are
+     * written again with the next annotation.
+     */
+    void rotate_files();
+
+    /*
+     * Writes again the header of a RINEX file, once updated. The header lines
+     * to be written are in header, and the stream must be positioned right
+     * after the END OF HEADER line of the file. If the new header has the
+     * same size as the old one (reserved blank COMMENT lines are used for
+     * that), it is overwritten in place. Otherwise, the file is copied.
+     */
+    void rewrite_header(std::fstream& out, const std::string& filename, std::vector<std::string>& header) const;
+
+    /*
+     * Blank COMMENT line, reserved in the observation headers for the records
+     * that are added by update_obs_header
+     */
+    std::string reserved_header_line() const;
+
     /*
      * Generates the data for the PGM / RUN BY / DATE line
      */
@@ -1006,7 +1041,12 @@ private:
 
     std::string d_stringVersion;  // RINEX version (2.10/2.11 or 3.01/3.02)
 
+    std::string d_base_path;  // Folder of the RINEX files
+    std::string d_base_name;  // Base name of the RINEX files, "-" for the default names
+
     double d_fake_cnav_iode;
+    int64_t d_rotation_index;      // Rotation period of the current files
+    uint32_t d_rotation_period_s;  // Period of the file rotation, in seconds. 0 if disabled
     int d_version;                  // RINEX version (2 for 2.10/2.11 and 3 for 3.01)
     int d_numberTypesObservations;  // Number of available types of observable in the system. Should be public?
     bool d_rinex_header_updated;
@@ -24,24 +24,26 @@
 #include "Galileo_FNAV.h"
 #include "Galileo_INAV.h"
 #include <boost/algorithm/string.hpp>  // for to_upper_copy
-#include <boost/crc.hpp>
 #include <boost/date_time/gregorian/gregorian.hpp>
 #include <boost/dynamic_bitset.hpp>
 #include <boost/exception/diagnostic_information.hpp>
 #include <algorithm>  // for std::reverse
 #include <cmath>      // for std::fmod, std::lround
-#include <cstdlib>    // for strtol
+#include <cstdlib>    // for strtol, strtoul
 #include <iostream>   // for cout
 #include <sstream>    // for std::stringstream
 
 
-Rtcm::Rtcm(uint16_t port) : RTCM_port(port), server_is_running(false)
+Rtcm::Rtcm(uint16_t port) : Rtcm(port, std::string())
+{
+}
+
+
+Rtcm::Rtcm(uint16_t port, const std::string& mount_points, std::size_t client_queue_size) : RTCM_port(port), server_is_running(false)
 {
-    preamble = std::bitset<8>("11010011");
-    reserved_field = std::bitset<6>("000000");
     rtcm_message_queue = std::make_shared<Concurrent_Queue<std::string>>();
     boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::tcp::v4(), RTCM_port);
-    servers.emplace_back(io_context, endpoint);
+    servers.emplace_back(io_context, endpoint, parse_mount_points(mount_points), client_queue_size);
 }
 
 
@@ -76,9 +78,10 @@ void Rtcm::run_server()
     std::cout << "Starting a TCP/IP server of RTCM messages on port " << RTCM_port << '\n';
     try
         {
-            tq = std::thread([&] { std::make_shared<Queue_Reader>(io_context, rtcm_message_queue, RTCM_port)->do_read_queue(); });
+            tq = std::thread([&] { std::make_shared<Queue_Reader>(io_context, rtcm_message_queue, servers)->do_read_queue(); });
             t = std::thread([&] { io_context.run(); });
             server_is_running = true;
+            std::cout << "The TCP/IP server of RTCM messages is up and running. Accepting connections ...\n";
         }
     catch (const std::exception& e)
         {
@@ -117,55 +120,45 @@ bool Rtcm::is_server_running() const
 }
 
 
+std::map<std::string, std::set<uint32_t>> Rtcm::parse_mount_points(const std::string& mount_points) const
+{
+    std::map<std::string, std::set<uint32_t>> parsed_mount_points;
+    std::stringstream ss(mount_points);
+    std::string mount_point;
+    while (ss >> mount_point)
+        {
+            const std::size_t colon = mount_point.find(':');
+            std::set<uint32_t>& types = parsed_mount_points[mount_point.substr(0, colon)];
+            if (colon != std::string::npos)
+                {
+                    std::stringstream types_ss(mount_point.substr(colon + 1));
+                    std::string type;
+                    while (std::getline(types_ss, type, ','))
+                        {
+                            if (!type.empty())
+                                {
+                                    types.insert(static_cast<uint32_t>(std::strtoul(type.c_str(), nullptr, 10)));
+                                }
+                        }
+                }
+        }
+    for (const auto& mp : parsed_mount_points)
+        {
+            LOG(INFO) << "RTCM mount point " << mp.first << " with " << (mp.second.empty() ? std::string("all") : std::to_string(mp.second.size())) << " message types";
+        }
+    return parsed_mount_points;
+}
+
+
 // *****************************************************************************************************
 //
 //   TRANSPORT LAYER AS DEFINED AT RTCM STANDARD 10403.2
 //
 // *****************************************************************************************************
 
-std::string Rtcm::add_CRC(const std::string& message_without_crc) const
-{
-    // ******  Computes Qualcomm CRC-24Q ******
-    boost::crc_optimal<24, 0x1864CFBU, 0x0, 0x0, false, false> CRC_RTCM;
-    // 1) Converts the string to a vector of uint8_t:
-    boost::dynamic_bitset<uint8_t> frame_bits(message_without_crc);
-    std::vector<uint8_t> bytes;
-    boost::to_block_range(frame_bits, std::back_inserter(bytes));
-    std::reverse(bytes.begin(), bytes.end());
-
-    // 2) Computes CRC
-    CRC_RTCM.process_bytes(bytes.data(), bytes.size());
-    const auto crc_frame = std::bitset<24>(CRC_RTCM.checksum());
-
-    // 3) Builds the complete message
-    const std::string complete_message = message_without_crc + crc_frame.to_string();
-    return bin_to_binary_data(complete_message);
-}
-
-
 bool Rtcm::check_CRC(const std::string& message) const
 {
-    boost::crc_optimal<24, 0x1864CFBU, 0x0, 0x0, false, false> CRC_RTCM_CHECK;
-    // Convert message to binary
-    const std::string message_bin = Rtcm::binary_data_to_bin(message);
-    // Check CRC
-    const std::string crc = message_bin.substr(message_bin.length() - 24, 24);
-    const auto read_crc = std::bitset<24>(crc);
-    const std::string msg_without_crc = message_bin.substr(0, message_bin.length() - 24);
-
-    boost::dynamic_bitset<uint8_t> frame_bits(msg_without_crc);
-    std::vector<uint8_t> bytes;
-    boost::to_block_range(frame_bits, std::back_inserter(bytes));
-    std::reverse(bytes.begin(), bytes.end());
-
-    CRC_RTCM_CHECK.process_bytes(bytes.data(), bytes.size());
-    const auto computed_crc = std::bitset<24>(CRC_RTCM_CHECK.checksum());
-    if (read_crc == computed_crc)
-        {
-            return true;
-        }
-
-    return false;
+    return Rtcm_Bit_Reader(message).check_CRC();
 }
 
 
@@ -399,17 +392,15 @@ int64_t Rtcm::hex_to_int(const std::string& s) const
 
 std::string Rtcm::build_message(const std::string& data) const
 {
-    const uint32_t msg_length_bits = data.length();
-    const uint32_t msg_length_bytes = std::ceil(static_cast<float>(msg_length_bits) / 8.0);
-    const auto message_length = std::bitset<10>(msg_length_bytes);
-    const uint32_t zeros_to_fill = 8 * msg_length_bytes - msg_length_bits;
-    const std::string b(zeros_to_fill, '0');
-    const std::string msg_content = data + b;
-    const std::string msg_without_crc = preamble.to_string() +
-                                        reserved_field.to_string() +
-                                        message_length.to_string() +
-                                        msg_content;
-    return Rtcm::add_CRC(msg_without_crc);
+    Rtcm_Bit_Writer writer(data.length());
+    writer.append(data);
+    return writer.frame();
+}
+
+
+std::string Rtcm::build_message(const Rtcm_Bit_Writer& data) const
+{
+    return data.frame();
 }
 
 
@@ -916,10 +907,9 @@ std::string Rtcm::print_MT1005(uint32_t ref_id, double ecef_x, double ecef_y, do
 
 int32_t Rtcm::read_MT1005(const std::string& message, uint32_t& ref_id, double& ecef_x, double& ecef_y, double& ecef_z, bool& gps, bool& glonass, bool& galileo)
 {
-    // Convert message to binary
-    const std::string message_bin = Rtcm::binary_data_to_bin(message);
+    Rtcm_Bit_Reader reader(message);
 
-    if (!Rtcm::check_CRC(message))
+    if (!reader.check_CRC())
         {
             LOG(WARNING) << " Bad CRC detected in RTCM message MT1005";
             return 1;
@@ -928,10 +918,9 @@ int32_t Rtcm::read_MT1005(const std::string& message, uint32_t& ref_id, double&
     // Check than the message number is correct
     const uint32_t preamble_length = 8;
     const uint32_t reserved_field_length = 6;
-    uint32_t index = preamble_length + reserved_field_length;
+    reader.skip(preamble_length + reserved_field_length);
 
-    uint32_t read_message_length = static_cast<uint32_t>(Rtcm::bin_to_uint(message_bin.substr(index, 10)));
-    index += 10;
+    uint32_t read_message_length = static_cast<uint32_t>(reader.get_uint(10));
     if (read_message_length != 19)
         {
             LOG(WARNING) << " Message MT1005 with wrong length (19 bytes expected, " << read_message_length << " received)";
@@ -940,8 +929,7 @@ int32_t Rtcm::read_MT1005(const std::string& message, uint32_t& ref_id, double&
 
     const uint32_t msg_number = 1005;
     Rtcm::set_DF002(msg_number);
-    std::bitset<12> read_msg_number(message_bin.substr(index, 12));
-    index += 12;
+    const std::bitset<12> read_msg_number(reader.get_uint(12));
 
     if (DF002 != read_msg_number)
         {
@@ -949,32 +937,26 @@ int32_t Rtcm::read_MT1005(const std::string& message, uint32_t& ref_id, double&
             return 1;
         }
 
-    ref_id = Rtcm::bin_to_uint(message_bin.substr(index, 12));
-    index += 12;
+    ref_id = static_cast<uint32_t>(reader.get_uint(12));
 
-    index += 6;  // ITRF year
-    gps = static_cast<bool>(Rtcm::bin_to_uint(message_bin.substr(index, 1)));
-    index += 1;
+    reader.skip(6);  // ITRF year
+    gps = static_cast<bool>(reader.get_uint(1));
 
-    glonass = static_cast<bool>(Rtcm::bin_to_uint(message_bin.substr(index, 1)));
-    index += 1;
+    glonass = static_cast<bool>(reader.get_uint(1));
 
-    galileo = static_cast<bool>(Rtcm::bin_to_uint(message_bin.substr(index, 1)));
-    index += 1;
+    galileo = static_cast<bool>(reader.get_uint(1));
 
-    index += 1;  // ref_station_indicator
+    reader.skip(1);  // ref_station_indicator
 
-    ecef_x = Rtcm::bin_to_double(message_bin.substr(index, 38)) / 10000.0;
-    index += 38;
+    ecef_x = static_cast<double>(reader.get_int(38)) / 10000.0;
 
-    index += 1;  // single rx oscillator
-    index += 1;  // reserved
+    reader.skip(1);  // single rx oscillator
+    reader.skip(1);  // reserved
 
-    ecef_y = Rtcm::bin_to_double(message_bin.substr(index, 38)) / 10000.0;
-    index += 38;
+    ecef_y = static_cast<double>(reader.get_int(38)) / 10000.0;
 
-    index += 2;  // quarter cycle indicator
-    ecef_z = Rtcm::bin_to_double(message_bin.substr(index, 38)) / 10000.0;
+    reader.skip(2);  // quarter cycle indicator
+    ecef_z = static_cast<double>(reader.get_int(38)) / 10000.0;
 
     return 0;
 }
@@ -1541,41 +1523,42 @@ std::string Rtcm::print_MT1019(const Gps_Ephemeris& gps_eph)
     Rtcm::set_DF103(gps_eph);
     Rtcm::set_DF137(gps_eph);
 
-    const std::string data = DF002.to_string() +
-                             DF009.to_string() +
-                             DF076.to_string() +
-                             DF077.to_string() +
-                             DF078.to_string() +
-                             DF079.to_string() +
-                             DF071.to_string() +
-                             DF081.to_string() +
-                             DF082.to_string() +
-                             DF083.to_string() +
-                             DF084.to_string() +
-                             DF085.to_string() +
-                             DF086.to_string() +
-                             DF087.to_string() +
-                             DF088.to_string() +
-                             DF089.to_string() +
-                             DF090.to_string() +
-                             DF091.to_string() +
-                             DF092.to_string() +
-                             DF093.to_string() +
-                             DF094.to_string() +
-                             DF095.to_string() +
-                             DF096.to_string() +
-                             DF097.to_string() +
-                             DF098.to_string() +
-                             DF099.to_string() +
-                             DF100.to_string() +
-                             DF101.to_string() +
-                             DF102.to_string() +
-                             DF103.to_string() +
-                             DF137.to_string();
-
-    if (data.length() != 488)
-        {
-            LOG(WARNING) << "Bad-formatted RTCM MT1019 (488 bits expected, found " << data.length() << ")";
+    Rtcm_Bit_Writer data;
+    data.append(DF002);
+    data.append(DF009);
+    data.append(DF076);
+    data.append(DF077);
+    data.append(DF078);
+    data.append(DF079);
+    data.append(DF071);
+    data.append(DF081);
+    data.append(DF082);
+    data.append(DF083);
+    data.append(DF084);
+    data.append(DF085);
+    data.append(DF086);
+    data.append(DF087);
+    data.append(DF088);
+    data.append(DF089);
+    data.append(DF090);
+    data.append(DF091);
+    data.append(DF092);
+    data.append(DF093);
+    data.append(DF094);
+    data.append(DF095);
+    data.append(DF096);
+    data.append(DF097);
+    data.append(DF098);
+    data.append(DF099);
+    data.append(DF100);
+    data.append(DF101);
+    data.append(DF102);
+    data.append(DF103);
+    data.append(DF137);
+
+    if (data.size() != 488)
+        {
+            LOG(WARNING) << "Bad-formatted RTCM MT1019 (488 bits expected, found " << data.size() << ")";
         }
 
     std::string msg = build_message(data);
@@ -1589,10 +1572,9 @@ std::string Rtcm::print_MT1019(const Gps_Ephemeris& gps_eph)
 
 int32_t Rtcm::read_MT1019(const std::string& message, Gps_Ephemeris& gps_eph) const
 {
-    // Convert message to binary
-    const std::string message_bin = Rtcm::binary_data_to_bin(message);
+    Rtcm_Bit_Reader reader(message);
 
-    if (!Rtcm::check_CRC(message))
+    if (!reader.check_CRC())
         {
             LOG(WARNING) << " Bad CRC detected in RTCM message MT1019";
             return 1;
@@ -1600,10 +1582,9 @@ int32_t Rtcm::read_MT1019(const std::string& message, Gps_Ephemeris& gps_eph) co
 
     const uint32_t preamble_length = 8;
     const uint32_t reserved_field_length = 6;
-    uint32_t index = preamble_length + reserved_field_length;
+    reader.skip(preamble_length + reserved_field_length);
 
-    const uint32_t read_message_length = static_cast<uint32_t>(Rtcm::bin_to_uint(message_bin.substr(index, 10)));
-    index += 10;
+    const uint32_t read_message_length = static_cast<uint32_t>(reader.get_uint(10));
 
     if (read_message_length != 61)
         {
@@ -1612,8 +1593,7 @@ int32_t Rtcm::read_MT1019(const std::string& message, Gps_Ephemeris& gps_eph) co
         }
 
     // Check than the message number is correct
-    const uint32_t read_msg_number = Rtcm::bin_to_uint(message_bin.substr(index, 12));
-    index += 12;
+    const auto read_msg_number = static_cast<uint32_t>(reader.get_uint(12));
 
     if (1019 != read_msg_number)
         {
@@ -1622,95 +1602,66 @@ int32_t Rtcm::read_MT1019(const std::string& message, Gps_Ephemeris& gps_eph) co
         }
 
     // Fill Gps Ephemeris with message data content
-    gps_eph.PRN = static_cast<uint32_t>(Rtcm::bin_to_uint(message_bin.substr(index, 6)));
-    index += 6;
+    gps_eph.PRN = static_cast<uint32_t>(reader.get_uint(6));
 
-    gps_eph.WN = static_cast<int32_t>(Rtcm::bin_to_uint(message_bin.substr(index, 10)));
-    index += 10;
+    gps_eph.WN = static_cast<int32_t>(reader.get_uint(10));
 
-    gps_eph.SV_accuracy = static_cast<int32_t>(Rtcm::bin_to_uint(message_bin.substr(index, 4)));
-    index += 4;
+    gps_eph.SV_accuracy = static_cast<int32_t>(reader.get_uint(4));
 
-    gps_eph.code_on_L2 = static_cast<int32_t>(Rtcm::bin_to_uint(message_bin.substr(index, 2)));
-    index += 2;
+    gps_eph.code_on_L2 = static_cast<int32_t>(reader.get_uint(2));
 
-    gps_eph.idot = static_cast<double>(Rtcm::bin_to_int(message_bin.substr(index, 14))) * I_DOT_LSB;
-    index += 14;
+    gps_eph.idot = static_cast<double>(reader.get_int(14)) * I_DOT_LSB;
 
-    gps_eph.IODE_SF2 = static_cast<double>(Rtcm::bin_to_uint(message_bin.substr(index, 8)));
-    gps_eph.IODE_SF3 = static_cast<double>(Rtcm::bin_to_uint(message_bin.substr(index, 8)));
-    index += 8;
+    gps_eph.IODE_SF2 = static_cast<double>(reader.get_uint(8));
+    gps_eph.IODE_SF3 = gps_eph.IODE_SF2;
 
-    gps_eph.toc = static_cast<double>(Rtcm::bin_to_uint(message_bin.substr(index, 16))) * T_OC_LSB;
-    index += 16;
+    gps_eph.toc = static_cast<double>(reader.get_uint(16)) * T_OC_LSB;
 
-    gps_eph.af2 = static_cast<double>(Rtcm::bin_to_int(message_bin.substr(index, 8))) * A_F2_LSB;
-    index += 8;
+    gps_eph.af2 = static_cast<double>(reader.get_int(8)) * A_F2_LSB;
 
-    gps_eph.af1 = static_cast<double>(Rtcm::bin_to_int(message_bin.substr(index, 16))) * A_F1_LSB;
-    index += 16;
+    gps_eph.af1 = static_cast<double>(reader.get_int(16)) * A_F1_LSB;
 
-    gps_eph.af0 = static_cast<double>(Rtcm::bin_to_int(message_bin.substr(index, 22))) * A_F0_LSB;
-    index += 22;
+    gps_eph.af0 = static_cast<double>(reader.get_int(22)) * A_F0_LSB;
 
-    gps_eph.IODC = static_cast<double>(Rtcm::bin_to_uint(message_bin.substr(index, 10)));
-    index += 10;
+    gps_eph.IODC = static_cast<double>(reader.get_uint(10));
 
-    gps_eph.Crs = static_cast<double>(Rtcm::bin_to_int(message_bin.substr(index, 16))) * C_RS_LSB;
-    index += 16;
+    gps_eph.Crs = static_cast<double>(reader.get_int(16)) * C_RS_LSB;
 
-    gps_eph.delta_n = static_cast<double>(Rtcm::bin_to_int(message_bin.substr(index, 16))) * DELTA_N_LSB;
-    index += 16;
+    gps_eph.delta_n = static_cast<double>(reader.get_int(16)) * DELTA_N_LSB;
 
-    gps_eph.M_0 = static_cast<double>(Rtcm::bin_to_int(message_bin.substr(index, 32))) * M_0_LSB;
-    index += 32;
+    gps_eph.M_0 = static_cast<double>(reader.get_int(32)) * M_0_LSB;
 
-    gps_eph.Cuc = static_cast<double>(Rtcm::bin_to_int(message_bin.substr(index, 16))) * C_UC_LSB;
-    index += 16;
+    gps_eph.Cuc = static_cast<double>(reader.get_int(16)) * C_UC_LSB;
 
-    gps_eph.ecc = static_cast<double>(Rtcm::bin_to_uint(message_bin.substr(index, 32))) * ECCENTRICITY_LSB;
-    index += 32;
+    gps_eph.ecc = static_cast<double>(reader.get_uint(32)) * ECCENTRICITY_LSB;
 
-    gps_eph.Cus = static_cast<double>(Rtcm::bin_to_int(message_bin.substr(index, 16))) * C_US_LSB;
-    index += 16;
+    gps_eph.Cus = static_cast<double>(reader.get_int(16)) * C_US_LSB;
 
-    gps_eph.sqrtA = static_cast<double>(Rtcm::bin_to_uint(message_bin.substr(index, 32))) * SQRT_A_LSB;
-    index += 32;
+    gps_eph.sqrtA = static_cast<double>(reader.get_uint(32)) * SQRT_A_LSB;
 
-    gps_eph.toe = static_cast<double>(Rtcm::bin_to_uint(message_bin.substr(index, 16))) * T_OE_LSB;
-    index += 16;
+    gps_eph.toe = static_cast<double>(reader.get_uint(16)) * T_OE_LSB;
 
-    gps_eph.Cic = static_cast<double>(Rtcm::bin_to_int(message_bin.substr(index, 16))) * C_IC_LSB;
-    index += 16;
+    gps_eph.Cic = static_cast<double>(reader.get_int(16)) * C_IC_LSB;
 
-    gps_eph.OMEGA_0 = static_cast<double>(Rtcm::bin_to_int(message_bin.substr(index, 32))) * OMEGA_0_LSB;
-    index += 32;
+    gps_eph.OMEGA_0 = static_cast<double>(reader.get_int(32)) * OMEGA_0_LSB;
 
-    gps_eph.Cis = static_cast<double>(Rtcm::bin_to_int(message_bin.substr(index, 16))) * C_IS_LSB;
-    index += 16;
+    gps_eph.Cis = static_cast<double>(reader.get_int(16)) * C_IS_LSB;
 
-    gps_eph.i_0 = static_cast<double>(Rtcm::bin_to_int(message_bin.substr(index, 32))) * I_0_LSB;
-    index += 32;
+    gps_eph.i_0 = static_cast<double>(reader.get_int(32)) * I_0_LSB;
 
-    gps_eph.Crc = static_cast<double>(Rtcm::bin_to_int(message_bin.substr(index, 16))) * C_RC_LSB;
-    index += 16;
+    gps_eph.Crc = static_cast<double>(reader.get_int(16)) * C_RC_LSB;
 
-    gps_eph.omega = static_cast<double>(Rtcm::bin_to_int(message_bin.substr(index, 32))) * OMEGA_LSB;
-    index += 32;
+    gps_eph.omega = static_cast<double>(reader.get_int(32)) * OMEGA_LSB;
 
-    gps_eph.OMEGAdot = static_cast<double>(Rtcm::bin_to_int(message_bin.substr(index, 24))) * OMEGA_DOT_LSB;
-    index += 24;
+    gps_eph.OMEGAdot = static_cast<double>(reader.get_int(24)) * OMEGA_DOT_LSB;
 
-    gps_eph.TGD = static_cast<double>(Rtcm::bin_to_int(message_bin.substr(index, 8))) * T_GD_LSB;
-    index += 8;
+    gps_eph.TGD = static_cast<double>(reader.get_int(8)) * T_GD_LSB;
 
-    gps_eph.SV_health = static_cast<int32_t>(Rtcm::bin_to_uint(message_bin.substr(index, 6)));
-    index += 6;
+    gps_eph.SV_health = static_cast<int32_t>(reader.get_uint(6));
 
-    gps_eph.L2_P_data_flag = static_cast<bool>(Rtcm::bin_to_uint(message_bin.substr(index, 1)));
-    index += 1;
+    gps_eph.L2_P_data_flag = static_cast<bool>(reader.get_uint(1));
 
-    gps_eph.fit_interval_flag = static_cast<bool>(Rtcm::bin_to_uint(message_bin.substr(index, 1)));
+    gps_eph.fit_interval_flag = static_cast<bool>(reader.get_uint(1));
 
     return 0;
 }
@@ -1766,47 +1717,48 @@ std::string Rtcm::print_MT1020(const Glonass_Gnav_Ephemeris& glonass_gnav_eph, c
     Rtcm::set_DF135(glonass_gnav_utc_model);
     Rtcm::set_DF136(glonass_gnav_eph);
 
-    const std::string data = DF002.to_string() +
-                             DF038.to_string() +
-                             DF040.to_string() +
-                             DF104.to_string() +
-                             DF105.to_string() +
-                             DF106.to_string() +
-                             DF107.to_string() +
-                             DF108.to_string() +
-                             DF109.to_string() +
-                             DF110.to_string() +
-                             DF111.to_string() +
-                             DF112.to_string() +
-                             DF113.to_string() +
-                             DF114.to_string() +
-                             DF115.to_string() +
-                             DF116.to_string() +
-                             DF117.to_string() +
-                             DF118.to_string() +
-                             DF119.to_string() +
-                             DF120.to_string() +
-                             DF121.to_string() +
-                             DF122.to_string() +
-                             DF123.to_string() +
-                             DF124.to_string() +
-                             DF125.to_string() +
-                             DF126.to_string() +
-                             DF127.to_string() +
-                             DF128.to_string() +
-                             DF129.to_string() +
-                             DF130.to_string() +
-                             DF131.to_string() +
-                             DF132.to_string() +
-                             DF133.to_string() +
-                             DF134.to_string() +
-                             DF135.to_string() +
-                             DF136.to_string() +
-                             std::bitset<7>().to_string();  // Reserved bits
-
-    if (data.length() != 360)
-        {
-            LOG(WARNING) << "Bad-formatted RTCM MT1020 (360 bits expected, found " << data.length() << ")";
+    Rtcm_Bit_Writer data;
+    data.append(DF002);
+    data.append(DF038);
+    data.append(DF040);
+    data.append(DF104);
+    data.append(DF105);
+    data.append(DF106);
+    data.append(DF107);
+    data.append(DF108);
+    data.append(DF109);
+    data.append(DF110);
+    data.append(DF111);
+    data.append(DF112);
+    data.append(DF113);
+    data.append(DF114);
+    data.append(DF115);
+    data.append(DF116);
+    data.append(DF117);
+    data.append(DF118);
+    data.append(DF119);
+    data.append(DF120);
+    data.append(DF121);
+    data.append(DF122);
+    data.append(DF123);
+    data.append(DF124);
+    data.append(DF125);
+    data.append(DF126);
+    data.append(DF127);
+    data.append(DF128);
+    data.append(DF129);
+    data.append(DF130);
+    data.append(DF131);
+    data.append(DF132);
+    data.append(DF133);
+    data.append(DF134);
+    data.append(DF135);
+    data.append(DF136);
+    data.append(std::bitset<7>());  // Reserved bits
+
+    if (data.size() != 360)
+        {
+            LOG(WARNING) << "Bad-formatted RTCM MT1020 (360 bits expected, found " << data.size() << ")";
         }
 
     std::string msg = build_message(data);
@@ -1820,13 +1772,12 @@ std::string Rtcm::print_MT1020(const Glonass_Gnav_Ephemeris& glonass_gnav_eph, c
 
 int32_t Rtcm::read_MT1020(const std::string& message, Glonass_Gnav_Ephemeris& glonass_gnav_eph, Glonass_Gnav_Utc_Model& glonass_gnav_utc_model) const
 {
-    // Convert message to binary
-    const std::string message_bin = Rtcm::binary_data_to_bin(message);
+    Rtcm_Bit_Reader reader(message);
     int32_t glonass_gnav_alm_health = 0;
     int32_t glonass_gnav_alm_health_ind = 0;
     int32_t fifth_str_additional_data_ind = 0;
 
-    if (!Rtcm::check_CRC(message))
+    if (!reader.check_CRC())
         {
             LOG(WARNING) << " Bad CRC detected in RTCM message MT1020";
             return 1;
@@ -1834,10 +1785,9 @@ int32_t Rtcm::read_MT1020(const std::string& message, Glonass_Gnav_Ephemeris& gl
 
     const uint32_t preamble_length = 8;
     const uint32_t reserved_field_length = 6;
-    uint32_t index = preamble_length + reserved_field_length;
+    reader.skip(preamble_length + reserved_field_length);
 
-    const uint32_t read_message_length = static_cast<uint32_t>(Rtcm::bin_to_uint(message_bin.substr(index, 10)));
-    index += 10;
+    const uint32_t read_message_length = static_cast<uint32_t>(reader.get_uint(10));
 
     if (read_message_length != 45)  // 360 bits = 45 bytes
         {
@@ -1846,8 +1796,7 @@ int32_t Rtcm::read_MT1020(const std::string& message, Glonass_Gnav_Ephemeris& gl
         }
 
     // Check than the message number is correct
-    const uint32_t read_msg_number = Rtcm::bin_to_uint(message_bin.substr(index, 12));
-    index += 12;
+    const auto read_msg_number = static_cast<uint32_t>(reader.get_uint(12));
 
     if (1020 != read_msg_number)
         {
@@ -1856,123 +1805,87 @@ int32_t Rtcm::read_MT1020(const std::string& message, Glonass_Gnav_Ephemeris& gl
         }
 
     // Fill Gps Ephemeris with message data content
-    glonass_gnav_eph.i_satellite_slot_number = static_cast<uint32_t>(Rtcm::bin_to_uint(message_bin.substr(index, 6)));
-    index += 6;
+    glonass_gnav_eph.i_satellite_slot_number = static_cast<uint32_t>(reader.get_uint(6));
 
-    glonass_gnav_eph.i_satellite_freq_channel = static_cast<int32_t>(Rtcm::bin_to_uint(message_bin.substr(index, 5)) - 7.0);
-    index += 5;
+    glonass_gnav_eph.i_satellite_freq_channel = static_cast<int32_t>(reader.get_uint(5) - 7.0);
 
-    glonass_gnav_alm_health = static_cast<int32_t>(Rtcm::bin_to_uint(message_bin.substr(index, 1)));
-    index += 1;
+    glonass_gnav_alm_health = static_cast<int32_t>(reader.get_uint(1));
     if (glonass_gnav_alm_health)
         {
         }  // Avoid compiler warning
 
-    glonass_gnav_alm_health_ind = static_cast<int32_t>(Rtcm::bin_to_uint(message_bin.substr(index, 1)));
-    index += 1;
+    glonass_gnav_alm_health_ind = static_cast<int32_t>(reader.get_uint(1));
     if (glonass_gnav_alm_health_ind)
         {
         }  // Avoid compiler warning
 
-    glonass_gnav_eph.d_P_1 = static_cast<double>(Rtcm::bin_to_uint(message_bin.substr(index, 2)));
+    glonass_gnav_eph.d_P_1 = static_cast<double>(reader.get_uint(2));
     glonass_gnav_eph.d_P_1 = (glonass_gnav_eph.d_P_1 + 1) * 15;
-    index += 2;
 
-    glonass_gnav_eph.d_t_k += static_cast<double>(Rtcm::bin_to_int(message_bin.substr(index, 5))) * 3600;
-    index += 5;
-    glonass_gnav_eph.d_t_k += static_cast<double>(Rtcm::bin_to_int(message_bin.substr(index, 6))) * 60;
-    index += 6;
-    glonass_gnav_eph.d_t_k += static_cast<double>(Rtcm::bin_to_int(message_bin.substr(index, 1))) * 30;
-    index += 1;
+    glonass_gnav_eph.d_t_k += static_cast<double>(reader.get_uint(5)) * 3600;
+    glonass_gnav_eph.d_t_k += static_cast<double>(reader.get_uint(6)) * 60;
+    glonass_gnav_eph.d_t_k += static_cast<double>(reader.get_uint(1)) * 30;
 
-    glonass_gnav_eph.d_B_n = static_cast<double>(Rtcm::bin_to_uint(message_bin.substr(index, 1)));
-    index += 1;
+    glonass_gnav_eph.d_B_n = static_cast<double>(reader.get_uint(1));
 
-    glonass_gnav_eph.d_P_2 = static_cast<bool>(Rtcm::bin_to_uint(message_bin.substr(index, 1)));
-    index += 1;
+    glonass_gnav_eph.d_P_2 = static_cast<bool>(reader.get_uint(1));
 
-    glonass_gnav_eph.d_t_b = static_cast<double>(Rtcm::bin_to_uint(message_bin.substr(index, 7))) * 15 * 60.0;
-    index += 7;
+    glonass_gnav_eph.d_t_b = static_cast<double>(reader.get_uint(7)) * 15 * 60.0;
 
     // TODO Check for type spec for intS24
-    glonass_gnav_eph.d_VXn = static_cast<double>(Rtcm::bin_to_sint(message_bin.substr(index, 24))) * TWO_N20;
-    index += 24;
+    glonass_gnav_eph.d_VXn = static_cast<double>(reader.get_sint(24)) * TWO_N20;
 
-    glonass_gnav_eph.d_Xn = static_cast<double>(Rtcm::bin_to_sint(message_bin.substr(index, 27))) * TWO_N11;
-    index += 27;
+    glonass_gnav_eph.d_Xn = static_cast<double>(reader.get_sint(27)) * TWO_N11;
 
-    glonass_gnav_eph.d_AXn = static_cast<double>(Rtcm::bin_to_sint(message_bin.substr(index, 5))) * TWO_N30;
-    index += 5;
+    glonass_gnav_eph.d_AXn = static_cast<double>(reader.get_sint(5)) * TWO_N30;
 
-    glonass_gnav_eph.d_VYn = static_cast<double>(Rtcm::bin_to_sint(message_bin.substr(index, 24))) * TWO_N20;
-    index += 24;
+    glonass_gnav_eph.d_VYn = static_cast<double>(reader.get_sint(24)) * TWO_N20;
 
-    glonass_gnav_eph.d_Yn = static_cast<double>(Rtcm::bin_to_sint(message_bin.substr(index, 27))) * TWO_N11;
-    index += 27;
+    glonass_gnav_eph.d_Yn = static_cast<double>(reader.get_sint(27)) * TWO_N11;
 
-    glonass_gnav_eph.d_AYn = static_cast<double>(Rtcm::bin_to_sint(message_bin.substr(index, 5))) * TWO_N30;
-    index += 5;
+    glonass_gnav_eph.d_AYn = static_cast<double>(reader.get_sint(5)) * TWO_N30;
 
-    glonass_gnav_eph.d_VZn = static_cast<double>(Rtcm::bin_to_sint(message_bin.substr(index, 24))) * TWO_N20;
-    index += 24;
+    glonass_gnav_eph.d_VZn = static_cast<double>(reader.get_sint(24)) * TWO_N20;
 
-    glonass_gnav_eph.d_Zn = static_cast<double>(Rtcm::bin_to_sint(message_bin.substr(index, 27))) * TWO_N11;
-    index += 27;
+    glonass_gnav_eph.d_Zn = static_cast<double>(reader.get_sint(27)) * TWO_N11;
 
-    glonass_gnav_eph.d_AZn = static_cast<double>(Rtcm::bin_to_sint(message_bin.substr(index, 5))) * TWO_N30;
-    index += 5;
+    glonass_gnav_eph.d_AZn = static_cast<double>(reader.get_sint(5)) * TWO_N30;
 
-    glonass_gnav_eph.d_P_3 = static_cast<bool>(Rtcm::bin_to_uint(message_bin.substr(index, 1)));
-    index += 1;
+    glonass_gnav_eph.d_P_3 = static_cast<bool>(reader.get_uint(1));
 
-    glonass_gnav_eph.d_gamma_n = static_cast<double>(Rtcm::bin_to_sint(message_bin.substr(index, 11))) * TWO_N30;
-    index += 11;
+    glonass_gnav_eph.d_gamma_n = static_cast<double>(reader.get_sint(11)) * TWO_N30;
 
-    glonass_gnav_eph.d_P = static_cast<double>(Rtcm::bin_to_uint(message_bin.substr(index, 2)));
-    index += 2;
+    glonass_gnav_eph.d_P = static_cast<double>(reader.get_uint(2));
 
-    glonass_gnav_eph.d_l3rd_n = static_cast<bool>(Rtcm::bin_to_uint(message_bin.substr(index, 1)));
-    index += 1;
+    glonass_gnav_eph.d_l3rd_n = static_cast<bool>(reader.get_uint(1));
 
-    glonass_gnav_eph.d_tau_n = static_cast<double>(Rtcm::bin_to_sint(message_bin.substr(index, 22))) * TWO_N30;
-    index += 22;
+    glonass_gnav_eph.d_tau_n = static_cast<double>(reader.get_sint(22)) * TWO_N30;
 
-    glonass_gnav_eph.d_Delta_tau_n = static_cast<double>(Rtcm::bin_to_sint(message_bin.substr(index, 5))) * TWO_N30;
-    index += 5;
+    glonass_gnav_eph.d_Delta_tau_n = static_cast<double>(reader.get_sint(5)) * TWO_N30;
 
-    glonass_gnav_eph.d_E_n = static_cast<double>(Rtcm::bin_to_uint(message_bin.substr(index, 5)));
-    index += 5;
+    glonass_gnav_eph.d_E_n = static_cast<double>(reader.get_uint(5));
 
-    glonass_gnav_eph.d_P_4 = static_cast<bool>(Rtcm::bin_to_uint(message_bin.substr(index, 1)));
-    index += 1;
+    glonass_gnav_eph.d_P_4 = static_cast<bool>(reader.get_uint(1));
 
-    glonass_gnav_eph.d_F_T = static_cast<double>(Rtcm::bin_to_uint(message_bin.substr(index, 4)));
-    index += 4;
+    glonass_gnav_eph.d_F_T = static_cast<double>(reader.get_uint(4));
 
-    glonass_gnav_eph.d_N_T = static_cast<double>(Rtcm::bin_to_uint(message_bin.substr(index, 11)));
-    index += 11;
+    glonass_gnav_eph.d_N_T = static_cast<double>(reader.get_uint(11));
 
-    glonass_gnav_eph.d_M = static_cast<double>(Rtcm::bin_to_uint(message_bin.substr(index, 2)));
-    index += 2;
+    glonass_gnav_eph.d_M = static_cast<double>(reader.get_uint(2));
 
-    fifth_str_additional_data_ind = static_cast<double>(Rtcm::bin_to_uint(message_bin.substr(index, 1)));
-    index += 1;
+    fifth_str_additional_data_ind = static_cast<double>(reader.get_uint(1));
 
     if (fifth_str_additional_data_ind == true)
         {
-            glonass_gnav_utc_model.d_N_A = static_cast<double>(Rtcm::bin_to_uint(message_bin.substr(index, 11)));
-            index += 11;
+            glonass_gnav_utc_model.d_N_A = static_cast<double>(reader.get_uint(11));
 
-            glonass_gnav_utc_model.d_tau_c = static_cast<double>(Rtcm::bin_to_sint(message_bin.substr(index, 32))) * TWO_N31;
-            index += 32;
+            glonass_gnav_utc_model.d_tau_c = static_cast<double>(reader.get_sint(32)) * TWO_N31;
 
-            glonass_gnav_utc_model.d_N_4 = static_cast<double>(Rtcm::bin_to_uint(message_bin.substr(index, 5)));
-            index += 5;
+            glonass_gnav_utc_model.d_N_4 = static_cast<double>(reader.get_uint(5));
 
-            glonass_gnav_utc_model.d_tau_gps = static_cast<double>(Rtcm::bin_to_sint(message_bin.substr(index, 22))) * TWO_N30;
-            index += 22;
+            glonass_gnav_utc_model.d_tau_gps = static_cast<double>(reader.get_sint(22)) * TWO_N30;
 
-            glonass_gnav_eph.d_l5th_n = static_cast<int32_t>(Rtcm::bin_to_uint(message_bin.substr(index, 1)));
+            glonass_gnav_eph.d_l5th_n = static_cast<int32_t>(reader.get_uint(1));
         }
 
     return 0;
@@ -2080,39 +1993,40 @@ std::string Rtcm::print_MT1045(const Galileo_Ephemeris& gal_eph)
     const uint32_t seven_zero = 0;
     const auto DF001_ = std::bitset<7>(seven_zero);
 
-    const std::string data = DF002.to_string() +
-                             DF252.to_string() +
-                             DF289.to_string() +
-                             DF290.to_string() +
-                             DF291.to_string() +
-                             DF292.to_string() +
-                             DF293.to_string() +
-                             DF294.to_string() +
-                             DF295.to_string() +
-                             DF296.to_string() +
-                             DF297.to_string() +
-                             DF298.to_string() +
-                             DF299.to_string() +
-                             DF300.to_string() +
-                             DF301.to_string() +
-                             DF302.to_string() +
-                             DF303.to_string() +
-                             DF304.to_string() +
-                             DF305.to_string() +
-                             DF306.to_string() +
-                             DF307.to_string() +
-                             DF308.to_string() +
-                             DF309.to_string() +
-                             DF310.to_string() +
-                             DF311.to_string() +
-                             DF312.to_string() +
-                             DF314.to_string() +
-                             DF315.to_string() +
-                             DF001_.to_string();
-
-    if (data.length() != 496)
-        {
-            LOG(WARNING) << "Bad-formatted RTCM MT1045 (496 bits expected, found " << data.length() << ")";
+    Rtcm_Bit_Writer data;
+    data.append(DF002);
+    data.append(DF252);
+    data.append(DF289);
+    data.append(DF290);
+    data.append(DF291);
+    data.append(DF292);
+    data.append(DF293);
+    data.append(DF294);
+    data.append(DF295);
+    data.append(DF296);
+    data.append(DF297);
+    data.append(DF298);
+    data.append(DF299);
+    data.append(DF300);
+    data.append(DF301);
+    data.append(DF302);
+    data.append(DF303);
+    data.append(DF304);
+    data.append(DF305);
+    data.append(DF306);
+    data.append(DF307);
+    data.append(DF308);
+    data.append(DF309);
+    data.append(DF310);
+    data.append(DF311);
+    data.append(DF312);
+    data.append(DF314);
+    data.append(DF315);
+    data.append(DF001_);
+
+    if (data.size() != 496)
+        {
+            LOG(WARNING) << "Bad-formatted RTCM MT1045 (496 bits expected, found " << data.size() << ")";
         }
 
     std::string msg = build_message(data);
@@ -2126,10 +2040,9 @@ std::string Rtcm::print_MT1045(const Galileo_Ephemeris& gal_eph)
 
 int32_t Rtcm::read_MT1045(const std::string& message, Galileo_Ephemeris& gal_eph) const
 {
-    // Convert message to binary
-    const std::string message_bin = Rtcm::binary_data_to_bin(message);
+    Rtcm_Bit_Reader reader(message);
 
-    if (!Rtcm::check_CRC(message))
+    if (!reader.check_CRC())
         {
             LOG(WARNING) << " Bad CRC detected in RTCM message MT1045";
             return 1;
@@ -2137,10 +2050,9 @@ int32_t Rtcm::read_MT1045(const std::string& message, Galileo_Ephemeris& gal_eph
 
     const uint32_t preamble_length = 8;
     const uint32_t reserved_field_length = 6;
-    uint32_t index = preamble_length + reserved_field_length;
+    reader.skip(preamble_length + reserved_field_length);
 
-    const uint32_t read_message_length = static_cast<uint32_t>(Rtcm::bin_to_uint(message_bin.substr(index, 10)));
-    index += 10;
+    const uint32_t read_message_length = static_cast<uint32_t>(reader.get_uint(10));
 
     if (read_message_length != 62)
         {
@@ -2149,8 +2061,7 @@ int32_t Rtcm::read_MT1045(const std::string& message, Galileo_Ephemeris& gal_eph
         }
 
     // Check than the message number is correct
-    const uint32_t read_msg_number = Rtcm::bin_to_uint(message_bin.substr(index, 12));
-    index += 12;
+    const auto read_msg_number = static_cast<uint32_t>(reader.get_uint(12));
 
     if (1045 != read_msg_number)
         {
@@ -2159,85 +2070,59 @@ int32_t Rtcm::read_MT1045(const std::string& message, Galileo_Ephemeris& gal_eph
         }
 
     // Fill Galileo Ephemeris with message data content
-    gal_eph.PRN = static_cast<uint32_t>(Rtcm::bin_to_uint(message_bin.substr(index, 6)));
-    index += 6;
+    gal_eph.PRN = static_cast<uint32_t>(reader.get_uint(6));
 
-    gal_eph.WN = static_cast<double>(Rtcm::bin_to_uint(message_bin.substr(index, 12)));
-    index += 12;
+    gal_eph.WN = static_cast<double>(reader.get_uint(12));
 
-    gal_eph.IOD_nav = static_cast<int32_t>(Rtcm::bin_to_uint(message_bin.substr(index, 10)));
-    index += 10;
+    gal_eph.IOD_nav = static_cast<int32_t>(reader.get_uint(10));
 
-    gal_eph.SISA = static_cast<double>(Rtcm::bin_to_uint(message_bin.substr(index, 8)));
-    index += 8;
+    gal_eph.SISA = static_cast<double>(reader.get_uint(8));
 
-    gal_eph.idot = static_cast<double>(Rtcm::bin_to_int(message_bin.substr(index, 14))) * I_DOT_2_LSB;
-    index += 14;
+    gal_eph.idot = static_cast<double>(reader.get_int(14)) * I_DOT_2_LSB;
 
-    gal_eph.toc = static_cast<double>(Rtcm::bin_to_uint(message_bin.substr(index, 14))) * T0C_4_LSB;
-    index += 14;
+    gal_eph.toc = static_cast<double>(reader.get_uint(14)) * T0C_4_LSB;
 
-    gal_eph.af2 = static_cast<double>(Rtcm::bin_to_int(message_bin.substr(index, 6))) * AF2_4_LSB;
-    index += 6;
+    gal_eph.af2 = static_cast<double>(reader.get_int(6)) * AF2_4_LSB;
 
-    gal_eph.af1 = static_cast<double>(Rtcm::bin_to_int(message_bin.substr(index, 21))) * AF1_4_LSB;
-    index += 21;
+    gal_eph.af1 = static_cast<double>(reader.get_int(21)) * AF1_4_LSB;
 
-    gal_eph.af0 = static_cast<double>(Rtcm::bin_to_int(message_bin.substr(index, 31))) * AF0_4_LSB;
-    index += 31;
+    gal_eph.af0 = static_cast<double>(reader.get_int(31)) * AF0_4_LSB;
 
-    gal_eph.Crs = static_cast<double>(Rtcm::bin_to_int(message_bin.substr(index, 16))) * C_RS_3_LSB;
-    index += 16;
+    gal_eph.Crs = static_cast<double>(reader.get_int(16)) * C_RS_3_LSB;
 
-    gal_eph.delta_n = static_cast<double>(Rtcm::bin_to_int(message_bin.substr(index, 16))) * DELTA_N_3_LSB;
-    index += 16;
+    gal_eph.delta_n = static_cast<double>(reader.get_int(16)) * DELTA_N_3_LSB;
 
-    gal_eph.M_0 = static_cast<double>(Rtcm::bin_to_int(message_bin.substr(index, 32))) * M0_1_LSB;
-    index += 32;
+    gal_eph.M_0 = static_cast<double>(reader.get_int(32)) * M0_1_LSB;
 
-    gal_eph.Cuc = static_cast<double>(Rtcm::bin_to_int(message_bin.substr(index, 16))) * C_UC_3_LSB;
-    index += 16;
+    gal_eph.Cuc = static_cast<double>(reader.get_int(16)) * C_UC_3_LSB;
 
-    gal_eph.ecc = static_cast<double>(Rtcm::bin_to_uint(message_bin.substr(index, 32))) * E_1_LSB;
-    index += 32;
+    gal_eph.ecc = static_cast<double>(reader.get_uint(32)) * E_1_LSB;
 
-    gal_eph.Cus = static_cast<double>(Rtcm::bin_to_int(message_bin.substr(index, 16))) * C_US_3_LSB;
-    index += 16;
+    gal_eph.Cus = static_cast<double>(reader.get_int(16)) * C_US_3_LSB;
 
-    gal_eph.sqrtA = static_cast<double>(Rtcm::bin_to_uint(message_bin.substr(index, 32))) * A_1_LSB_GAL;
-    index += 32;
+    gal_eph.sqrtA = static_cast<double>(reader.get_uint(32)) * A_1_LSB_GAL;
 
-    gal_eph.toe = static_cast<double>(Rtcm::bin_to_uint(message_bin.substr(index, 14))) * T0E_1_LSB;
-    index += 14;
+    gal_eph.toe = static_cast<double>(reader.get_uint(14)) * T0E_1_LSB;
 
-    gal_eph.Cic = static_cast<double>(Rtcm::bin_to_int(message_bin.substr(index, 16))) * C_IC_4_LSB;
-    index += 16;
+    gal_eph.Cic = static_cast<double>(reader.get_int(16)) * C_IC_4_LSB;
 
-    gal_eph.OMEGA_0 = static_cast<double>(Rtcm::bin_to_int(message_bin.substr(index, 32))) * OMEGA_0_2_LSB;
-    index += 32;
+    gal_eph.OMEGA_0 = static_cast<double>(reader.get_int(32)) * OMEGA_0_2_LSB;
 
-    gal_eph.Cis = static_cast<double>(Rtcm::bin_to_int(message_bin.substr(index, 16))) * C_IS_4_LSB;
-    index += 16;
+    gal_eph.Cis = static_cast<double>(reader.get_int(16)) * C_IS_4_LSB;
 
-    gal_eph.i_0 = static_cast<double>(Rtcm::bin_to_int(message_bin.substr(index, 32))) * I_0_2_LSB;
-    index += 32;
+    gal_eph.i_0 = static_cast<double>(reader.get_int(32)) * I_0_2_LSB;
 
-    gal_eph.Crc = static_cast<double>(Rtcm::bin_to_int(message_bin.substr(index, 16))) * C_RC_3_LSB;
-    index += 16;
+    gal_eph.Crc = static_cast<double>(reader.get_int(16)) * C_RC_3_LSB;
 
-    gal_eph.omega = static_cast<double>(Rtcm::bin_to_int(message_bin.substr(index, 32))) * OMEGA_2_LSB;
-    index += 32;
+    gal_eph.omega = static_cast<double>(reader.get_int(32)) * OMEGA_2_LSB;
 
-    gal_eph.OMEGAdot = static_cast<double>(Rtcm::bin_to_int(message_bin.substr(index, 24))) * OMEGA_DOT_3_LSB;
-    index += 24;
+    gal_eph.OMEGAdot = static_cast<double>(reader.get_int(24)) * OMEGA_DOT_3_LSB;
 
-    gal_eph.BGD_E1E5a = static_cast<double>(Rtcm::bin_to_int(message_bin.substr(index, 10)));
-    index += 10;
+    gal_eph.BGD_E1E5a = static_cast<double>(reader.get_int(10));
 
-    gal_eph.E5a_HS = static_cast<uint32_t>(Rtcm::bin_to_uint(message_bin.substr(index, 2)));
-    index += 2;
+    gal_eph.E5a_HS = static_cast<uint32_t>(reader.get_uint(2));
 
-    gal_eph.E5a_DVS = static_cast<bool>(Rtcm::bin_to_uint(message_bin.substr(index, 1)));
+    gal_eph.E5a_DVS = static_cast<bool>(reader.get_uint(1));
 
     return 0;
 }
@@ -2289,7 +2174,9 @@ std::string Rtcm::print_MSM_1(const Gps_Ephemeris& gps_eph,
             msg_number = 1071;
         }
 
-    const std::string header = Rtcm::get_MSM_header(msg_number,
+    Rtcm_Bit_Writer data;
+    Rtcm::add_MSM_header(data,
+        msg_number,
         obs_time,
         observables,
         ref_id,
@@ -2299,11 +2186,11 @@ std::string Rtcm::print_MSM_1(const Gps_Ephemeris& gps_eph,
         divergence_free,
         more_messages);
 
-    const std::string sat_data = Rtcm::get_MSM_1_content_sat_data(observables);
+    Rtcm::add_MSM_1_content_sat_data(data, observables);
 
-    const std::string signal_data = Rtcm::get_MSM_1_content_signal_data(observables);
+    Rtcm::add_MSM_1_content_signal_data(data, observables);
 
-    std::string message = build_message(header + sat_data + signal_data);
+    std::string message = build_message(data);
 
     if (server_is_running)
         {
@@ -2314,7 +2201,8 @@ std::string Rtcm::print_MSM_1(const Gps_Ephemeris& gps_eph,
 }
 
 
-std::string Rtcm::get_MSM_header(uint32_t msg_number,
+void Rtcm::add_MSM_header(Rtcm_Bit_Writer& data,
+    uint32_t msg_number,
     double obs_time,
     const std::map<int32_t, Gnss_Synchro>& observables,
     uint32_t ref_id,
@@ -2341,40 +2229,37 @@ std::string Rtcm::get_MSM_header(uint32_t msg_number,
     Rtcm::set_DF394(observables);
     Rtcm::set_DF395(observables);
 
-    std::string header = DF002.to_string() + DF003.to_string();
+    data.append(DF002);
+    data.append(DF003);
     // GNSS Epoch Time Specific to each constellation
     if ((sys == "R"))
         {
             // GLONASS Epoch Time
             Rtcm::set_DF034(obs_time);
-            header += DF034.to_string();
+            data.append(DF034);
         }
     else
         {
             // GPS, Galileo Epoch Time
             Rtcm::set_DF004(obs_time);
-            header += DF004.to_string();
+            data.append(DF004);
         }
 
-    header = header + DF393.to_string() +
-             DF409.to_string() +
-             DF001_.to_string() +
-             DF411.to_string() +
-             DF417.to_string() +
-             DF412.to_string() +
-             DF418.to_string() +
-             DF394.to_string() +
-             DF395.to_string() +
-             Rtcm::set_DF396(observables);
-
-    return header;
+    data.append(DF393);
+    data.append(DF409);
+    data.append(DF001_);
+    data.append(DF411);
+    data.append(DF417);
+    data.append(DF412);
+    data.append(DF418);
+    data.append(DF394);
+    data.append(DF395);
+    data.append(Rtcm::set_DF396(observables));
 }
 
 
-std::string Rtcm::get_MSM_1_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables)
+void Rtcm::add_MSM_1_content_sat_data(Rtcm_Bit_Writer& data, const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string sat_data;
-
     Rtcm::set_DF394(observables);
     const uint32_t num_satellites = DF394.count();
     const uint32_t numobs = observables.size();
@@ -2404,16 +2289,13 @@ std::string Rtcm::get_MSM_1_content_sat_data(const std::map<int32_t, Gnss_Synchr
     for (uint32_t nsat = 0; nsat < num_satellites; nsat++)
         {
             Rtcm::set_DF398(ordered_by_PRN_pos.at(nsat).second);
-            sat_data += DF398.to_string();
+            data.append(DF398);
         }
-
-    return sat_data;
 }
 
 
-std::string Rtcm::get_MSM_1_content_signal_data(const std::map<int32_t, Gnss_Synchro>& observables)
+void Rtcm::add_MSM_1_content_signal_data(Rtcm_Bit_Writer& data, const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string signal_data;
     const uint32_t Ncells = observables.size();
 
     auto observables_vector = std::vector<std::pair<int32_t, Gnss_Synchro>>();
@@ -2434,10 +2316,8 @@ std::string Rtcm::get_MSM_1_content_signal_data(const std::map<int32_t, Gnss_Syn
     for (uint32_t cell = 0; cell < Ncells; cell++)
         {
             Rtcm::set_DF400(ordered_by_PRN_pos.at(cell).second);
-            signal_data += DF400.to_string();
+            data.append(DF400);
         }
-
-    return signal_data;
 }
 
 
@@ -2487,7 +2367,9 @@ std::string Rtcm::print_MSM_2(const Gps_Ephemeris& gps_eph,
             msg_number = 1072;
         }
 
-    const std::string header = Rtcm::get_MSM_header(msg_number,
+    Rtcm_Bit_Writer data;
+    Rtcm::add_MSM_header(data,
+        msg_number,
         obs_time,
         observables,
         ref_id,
@@ -2497,11 +2379,11 @@ std::string Rtcm::print_MSM_2(const Gps_Ephemeris& gps_eph,
         divergence_free,
         more_messages);
 
-    const std::string sat_data = Rtcm::get_MSM_1_content_sat_data(observables);
+    Rtcm::add_MSM_1_content_sat_data(data, observables);
 
-    const std::string signal_data = Rtcm::get_MSM_2_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
+    Rtcm::add_MSM_2_content_signal_data(data, gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
 
-    std::string message = build_message(header + sat_data + signal_data);
+    std::string message = build_message(data);
     if (server_is_running)
         {
             rtcm_message_queue->push(message);
@@ -2511,17 +2393,17 @@ std::string Rtcm::print_MSM_2(const Gps_Ephemeris& gps_eph,
 }
 
 
-std::string Rtcm::get_MSM_2_content_signal_data(const Gps_Ephemeris& ephNAV,
+void Rtcm::add_MSM_2_content_signal_data(Rtcm_Bit_Writer& data,
+    const Gps_Ephemeris& ephNAV,
     const Gps_CNAV_Ephemeris& ephCNAV,
     const Galileo_Ephemeris& ephFNAV,
     const Glonass_Gnav_Ephemeris& ephGNAV,
     double obs_time,
     const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string signal_data;
-    std::string first_data_type;
-    std::string second_data_type;
-    std::string third_data_type;
+    Rtcm_Bit_Writer first_data_type;
+    Rtcm_Bit_Writer second_data_type;
+    Rtcm_Bit_Writer third_data_type;
 
     const uint32_t Ncells = observables.size();
 
@@ -2545,13 +2427,14 @@ std::string Rtcm::get_MSM_2_content_signal_data(const Gps_Ephemeris& ephNAV,
             Rtcm::set_DF401(ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF402(ephNAV, ephCNAV, ephFNAV, ephGNAV, obs_time, ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF420(ordered_by_PRN_pos.at(cell).second);
-            first_data_type += DF401.to_string();
-            second_data_type += DF402.to_string();
-            third_data_type += DF420.to_string();
+            first_data_type.append(DF401);
+            second_data_type.append(DF402);
+            third_data_type.append(DF420);
         }
 
-    signal_data = first_data_type + second_data_type + third_data_type;
-    return signal_data;
+    data.append(first_data_type);
+    data.append(second_data_type);
+    data.append(third_data_type);
 }
 
 
@@ -2601,7 +2484,9 @@ std::string Rtcm::print_MSM_3(const Gps_Ephemeris& gps_eph,
             msg_number = 1073;
         }
 
-    const std::string header = Rtcm::get_MSM_header(msg_number,
+    Rtcm_Bit_Writer data;
+    Rtcm::add_MSM_header(data,
+        msg_number,
         obs_time,
         observables,
         ref_id,
@@ -2611,11 +2496,11 @@ std::string Rtcm::print_MSM_3(const Gps_Ephemeris& gps_eph,
         divergence_free,
         more_messages);
 
-    const std::string sat_data = Rtcm::get_MSM_1_content_sat_data(observables);
+    Rtcm::add_MSM_1_content_sat_data(data, observables);
 
-    const std::string signal_data = Rtcm::get_MSM_3_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
+    Rtcm::add_MSM_3_content_signal_data(data, gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
 
-    std::string message = build_message(header + sat_data + signal_data);
+    std::string message = build_message(data);
     if (server_is_running)
         {
             rtcm_message_queue->push(message);
@@ -2625,18 +2510,18 @@ std::string Rtcm::print_MSM_3(const Gps_Ephemeris& gps_eph,
 }
 
 
-std::string Rtcm::get_MSM_3_content_signal_data(const Gps_Ephemeris& ephNAV,
+void Rtcm::add_MSM_3_content_signal_data(Rtcm_Bit_Writer& data,
+    const Gps_Ephemeris& ephNAV,
     const Gps_CNAV_Ephemeris& ephCNAV,
     const Galileo_Ephemeris& ephFNAV,
     const Glonass_Gnav_Ephemeris& ephGNAV,
     double obs_time,
     const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string signal_data;
-    std::string first_data_type;
-    std::string second_data_type;
-    std::string third_data_type;
-    std::string fourth_data_type;
+    Rtcm_Bit_Writer first_data_type;
+    Rtcm_Bit_Writer second_data_type;
+    Rtcm_Bit_Writer third_data_type;
+    Rtcm_Bit_Writer fourth_data_type;
 
     const uint32_t Ncells = observables.size();
 
@@ -2661,14 +2546,16 @@ std::string Rtcm::get_MSM_3_content_signal_data(const Gps_Ephemeris& ephNAV,
             Rtcm::set_DF401(ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF402(ephNAV, ephCNAV, ephFNAV, ephGNAV, obs_time, ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF420(ordered_by_PRN_pos.at(cell).second);
-            first_data_type += DF400.to_string();
-            second_data_type += DF401.to_string();
-            third_data_type += DF402.to_string();
-            fourth_data_type += DF420.to_string();
+            first_data_type.append(DF400);
+            second_data_type.append(DF401);
+            third_data_type.append(DF402);
+            fourth_data_type.append(DF420);
         }
 
-    signal_data = first_data_type + second_data_type + third_data_type + fourth_data_type;
-    return signal_data;
+    data.append(first_data_type);
+    data.append(second_data_type);
+    data.append(third_data_type);
+    data.append(fourth_data_type);
 }
 
 
@@ -2718,7 +2605,9 @@ std::string Rtcm::print_MSM_4(const Gps_Ephemeris& gps_eph,
             msg_number = 1074;
         }
 
-    const std::string header = Rtcm::get_MSM_header(msg_number,
+    Rtcm_Bit_Writer data;
+    Rtcm::add_MSM_header(data,
+        msg_number,
         obs_time,
         observables,
         ref_id,
@@ -2728,11 +2617,11 @@ std::string Rtcm::print_MSM_4(const Gps_Ephemeris& gps_eph,
         divergence_free,
         more_messages);
 
-    const std::string sat_data = Rtcm::get_MSM_4_content_sat_data(observables);
+    Rtcm::add_MSM_4_content_sat_data(data, observables);
 
-    const std::string signal_data = Rtcm::get_MSM_4_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
+    Rtcm::add_MSM_4_content_signal_data(data, gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
 
-    std::string message = build_message(header + sat_data + signal_data);
+    std::string message = build_message(data);
     if (server_is_running)
         {
             rtcm_message_queue->push(message);
@@ -2742,11 +2631,10 @@ std::string Rtcm::print_MSM_4(const Gps_Ephemeris& gps_eph,
 }
 
 
-std::string Rtcm::get_MSM_4_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables)
+void Rtcm::add_MSM_4_content_sat_data(Rtcm_Bit_Writer& data, const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string sat_data;
-    std::string first_data_type;
-    std::string second_data_type;
+    Rtcm_Bit_Writer first_data_type;
+    Rtcm_Bit_Writer second_data_type;
 
     Rtcm::set_DF394(observables);
     const uint32_t num_satellites = DF394.count();
@@ -2777,27 +2665,27 @@ std::string Rtcm::get_MSM_4_content_sat_data(const std::map<int32_t, Gnss_Synchr
         {
             Rtcm::set_DF397(ordered_by_PRN_pos.at(nsat).second);
             Rtcm::set_DF398(ordered_by_PRN_pos.at(nsat).second);
-            first_data_type += DF397.to_string();
-            second_data_type += DF398.to_string();
+            first_data_type.append(DF397);
+            second_data_type.append(DF398);
         }
-    sat_data = first_data_type + second_data_type;
-    return sat_data;
+    data.append(first_data_type);
+    data.append(second_data_type);
 }
 
 
-std::string Rtcm::get_MSM_4_content_signal_data(const Gps_Ephemeris& ephNAV,
+void Rtcm::add_MSM_4_content_signal_data(Rtcm_Bit_Writer& data,
+    const Gps_Ephemeris& ephNAV,
     const Gps_CNAV_Ephemeris& ephCNAV,
     const Galileo_Ephemeris& ephFNAV,
     const Glonass_Gnav_Ephemeris& ephGNAV,
     double obs_time,
     const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string signal_data;
-    std::string first_data_type;
-    std::string second_data_type;
-    std::string third_data_type;
-    std::string fourth_data_type;
-    std::string fifth_data_type;
+    Rtcm_Bit_Writer first_data_type;
+    Rtcm_Bit_Writer second_data_type;
+    Rtcm_Bit_Writer third_data_type;
+    Rtcm_Bit_Writer fourth_data_type;
+    Rtcm_Bit_Writer fifth_data_type;
 
     const uint32_t Ncells = observables.size();
 
@@ -2823,15 +2711,18 @@ std::string Rtcm::get_MSM_4_content_signal_data(const Gps_Ephemeris& ephNAV,
             Rtcm::set_DF402(ephNAV, ephCNAV, ephFNAV, ephGNAV, obs_time, ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF420(ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF403(ordered_by_PRN_pos.at(cell).second);
-            first_data_type += DF400.to_string();
-            second_data_type += DF401.to_string();
-            third_data_type += DF402.to_string();
-            fourth_data_type += DF420.to_string();
-            fifth_data_type += DF403.to_string();
+            first_data_type.append(DF400);
+            second_data_type.append(DF401);
+            third_data_type.append(DF402);
+            fourth_data_type.append(DF420);
+            fifth_data_type.append(DF403);
         }
 
-    signal_data = first_data_type + second_data_type + third_data_type + fourth_data_type + fifth_data_type;
-    return signal_data;
+    data.append(first_data_type);
+    data.append(second_data_type);
+    data.append(third_data_type);
+    data.append(fourth_data_type);
+    data.append(fifth_data_type);
 }
 
 
@@ -2881,7 +2772,9 @@ std::string Rtcm::print_MSM_5(const Gps_Ephemeris& gps_eph,
             msg_number = 1075;
         }
 
-    const std::string header = Rtcm::get_MSM_header(msg_number,
+    Rtcm_Bit_Writer data;
+    Rtcm::add_MSM_header(data,
+        msg_number,
         obs_time,
         observables,
         ref_id,
@@ -2891,11 +2784,11 @@ std::string Rtcm::print_MSM_5(const Gps_Ephemeris& gps_eph,
         divergence_free,
         more_messages);
 
-    const std::string sat_data = Rtcm::get_MSM_5_content_sat_data(observables);
+    Rtcm::add_MSM_5_content_sat_data(data, observables);
 
-    const std::string signal_data = Rtcm::get_MSM_5_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
+    Rtcm::add_MSM_5_content_signal_data(data, gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
 
-    std::string message = build_message(header + sat_data + signal_data);
+    std::string message = build_message(data);
     if (server_is_running)
         {
             rtcm_message_queue->push(message);
@@ -2905,13 +2798,12 @@ std::string Rtcm::print_MSM_5(const Gps_Ephemeris& gps_eph,
 }
 
 
-std::string Rtcm::get_MSM_5_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables)
+void Rtcm::add_MSM_5_content_sat_data(Rtcm_Bit_Writer& data, const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string sat_data;
-    std::string first_data_type;
-    std::string second_data_type;
-    std::string third_data_type;
-    std::string fourth_data_type;
+    Rtcm_Bit_Writer first_data_type;
+    Rtcm_Bit_Writer second_data_type;
+    Rtcm_Bit_Writer third_data_type;
+    Rtcm_Bit_Writer fourth_data_type;
 
     Rtcm::set_DF394(observables);
     const uint32_t num_satellites = DF394.count();
@@ -2944,30 +2836,32 @@ std::string Rtcm::get_MSM_5_content_sat_data(const std::map<int32_t, Gnss_Synchr
             Rtcm::set_DF398(ordered_by_PRN_pos.at(nsat).second);
             Rtcm::set_DF399(ordered_by_PRN_pos.at(nsat).second);
             auto reserved = std::bitset<4>("0000");
-            first_data_type += DF397.to_string();
-            second_data_type += reserved.to_string();
-            third_data_type += DF398.to_string();
-            fourth_data_type += DF399.to_string();
+            first_data_type.append(DF397);
+            second_data_type.append(reserved);
+            third_data_type.append(DF398);
+            fourth_data_type.append(DF399);
         }
-    sat_data = first_data_type + second_data_type + third_data_type + fourth_data_type;
-    return sat_data;
+    data.append(first_data_type);
+    data.append(second_data_type);
+    data.append(third_data_type);
+    data.append(fourth_data_type);
 }
 
 
-std::string Rtcm::get_MSM_5_content_signal_data(const Gps_Ephemeris& ephNAV,
+void Rtcm::add_MSM_5_content_signal_data(Rtcm_Bit_Writer& data,
+    const Gps_Ephemeris& ephNAV,
     const Gps_CNAV_Ephemeris& ephCNAV,
     const Galileo_Ephemeris& ephFNAV,
     const Glonass_Gnav_Ephemeris& ephGNAV,
     double obs_time,
     const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string signal_data;
-    std::string first_data_type;
-    std::string second_data_type;
-    std::string third_data_type;
-    std::string fourth_data_type;
-    std::string fifth_data_type;
-    std::string sixth_data_type;
+    Rtcm_Bit_Writer first_data_type;
+    Rtcm_Bit_Writer second_data_type;
+    Rtcm_Bit_Writer third_data_type;
+    Rtcm_Bit_Writer fourth_data_type;
+    Rtcm_Bit_Writer fifth_data_type;
+    Rtcm_Bit_Writer sixth_data_type;
 
     const uint32_t Ncells = observables.size();
 
@@ -2994,16 +2888,20 @@ std::string Rtcm::get_MSM_5_content_signal_data(const Gps_Ephemeris& ephNAV,
             Rtcm::set_DF420(ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF403(ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF404(ordered_by_PRN_pos.at(cell).second);
-            first_data_type += DF400.to_string();
-            second_data_type += DF401.to_string();
-            third_data_type += DF402.to_string();
-            fourth_data_type += DF420.to_string();
-            fifth_data_type += DF403.to_string();
-            sixth_data_type += DF404.to_string();
+            first_data_type.append(DF400);
+            second_data_type.append(DF401);
+            third_data_type.append(DF402);
+            fourth_data_type.append(DF420);
+            fifth_data_type.append(DF403);
+            sixth_data_type.append(DF404);
         }
 
-    signal_data = first_data_type + second_data_type + third_data_type + fourth_data_type + fifth_data_type + sixth_data_type;
-    return signal_data;
+    data.append(first_data_type);
+    data.append(second_data_type);
+    data.append(third_data_type);
+    data.append(fourth_data_type);
+    data.append(fifth_data_type);
+    data.append(sixth_data_type);
 }
 
 
@@ -3053,7 +2951,9 @@ std::string Rtcm::print_MSM_6(const Gps_Ephemeris& gps_eph,
             msg_number = 1076;
         }
 
-    const std::string header = Rtcm::get_MSM_header(msg_number,
+    Rtcm_Bit_Writer data;
+    Rtcm::add_MSM_header(data,
+        msg_number,
         obs_time,
         observables,
         ref_id,
@@ -3063,11 +2963,11 @@ std::string Rtcm::print_MSM_6(const Gps_Ephemeris& gps_eph,
         divergence_free,
         more_messages);
 
-    const std::string sat_data = Rtcm::get_MSM_4_content_sat_data(observables);
+    Rtcm::add_MSM_4_content_sat_data(data, observables);
 
-    const std::string signal_data = Rtcm::get_MSM_6_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
+    Rtcm::add_MSM_6_content_signal_data(data, gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
 
-    std::string message = build_message(header + sat_data + signal_data);
+    std::string message = build_message(data);
     if (server_is_running)
         {
             rtcm_message_queue->push(message);
@@ -3077,19 +2977,19 @@ std::string Rtcm::print_MSM_6(const Gps_Ephemeris& gps_eph,
 }
 
 
-std::string Rtcm::get_MSM_6_content_signal_data(const Gps_Ephemeris& ephNAV,
+void Rtcm::add_MSM_6_content_signal_data(Rtcm_Bit_Writer& data,
+    const Gps_Ephemeris& ephNAV,
     const Gps_CNAV_Ephemeris& ephCNAV,
     const Galileo_Ephemeris& ephFNAV,
     const Glonass_Gnav_Ephemeris& ephGNAV,
     double obs_time,
     const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string signal_data;
-    std::string first_data_type;
-    std::string second_data_type;
-    std::string third_data_type;
-    std::string fourth_data_type;
-    std::string fifth_data_type;
+    Rtcm_Bit_Writer first_data_type;
+    Rtcm_Bit_Writer second_data_type;
+    Rtcm_Bit_Writer third_data_type;
+    Rtcm_Bit_Writer fourth_data_type;
+    Rtcm_Bit_Writer fifth_data_type;
 
     const uint32_t Ncells = observables.size();
 
@@ -3115,15 +3015,18 @@ std::string Rtcm::get_MSM_6_content_signal_data(const Gps_Ephemeris& ephNAV,
             Rtcm::set_DF407(ephNAV, ephCNAV, ephFNAV, ephGNAV, obs_time, ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF420(ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF408(ordered_by_PRN_pos.at(cell).second);
-            first_data_type += DF405.to_string();
-            second_data_type += DF406.to_string();
-            third_data_type += DF407.to_string();
-            fourth_data_type += DF420.to_string();
-            fifth_data_type += DF408.to_string();
+            first_data_type.append(DF405);
+            second_data_type.append(DF406);
+            third_data_type.append(DF407);
+            fourth_data_type.append(DF420);
+            fifth_data_type.append(DF408);
         }
 
-    signal_data = first_data_type + second_data_type + third_data_type + fourth_data_type + fifth_data_type;
-    return signal_data;
+    data.append(first_data_type);
+    data.append(second_data_type);
+    data.append(third_data_type);
+    data.append(fourth_data_type);
+    data.append(fifth_data_type);
 }
 
 
@@ -3173,7 +3076,9 @@ std::string Rtcm::print_MSM_7(const Gps_Ephemeris& gps_eph,
             msg_number = 1076;
         }
 
-    const std::string header = Rtcm::get_MSM_header(msg_number,
+    Rtcm_Bit_Writer data;
+    Rtcm::add_MSM_header(data,
+        msg_number,
         obs_time,
         observables,
         ref_id,
@@ -3183,11 +3088,11 @@ std::string Rtcm::print_MSM_7(const Gps_Ephemeris& gps_eph,
         divergence_free,
         more_messages);
 
-    const std::string sat_data = Rtcm::get_MSM_5_content_sat_data(observables);
+    Rtcm::add_MSM_5_content_sat_data(data, observables);
 
-    const std::string signal_data = Rtcm::get_MSM_7_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
+    Rtcm::add_MSM_7_content_signal_data(data, gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
 
-    std::string message = build_message(header + sat_data + signal_data);
+    std::string message = build_message(data);
     if (server_is_running)
         {
             rtcm_message_queue->push(message);
@@ -3197,20 +3102,20 @@ std::string Rtcm::print_MSM_7(const Gps_Ephemeris& gps_eph,
 }
 
 
-std::string Rtcm::get_MSM_7_content_signal_data(const Gps_Ephemeris& ephNAV,
+void Rtcm::add_MSM_7_content_signal_data(Rtcm_Bit_Writer& data,
+    const Gps_Ephemeris& ephNAV,
     const Gps_CNAV_Ephemeris& ephCNAV,
     const Galileo_Ephemeris& ephFNAV,
     const Glonass_Gnav_Ephemeris& ephGNAV,
     double obs_time,
     const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string signal_data;
-    std::string first_data_type;
-    std::string second_data_type;
-    std::string third_data_type;
-    std::string fourth_data_type;
-    std::string fifth_data_type;
-    std::string sixth_data_type;
+    Rtcm_Bit_Writer first_data_type;
+    Rtcm_Bit_Writer second_data_type;
+    Rtcm_Bit_Writer third_data_type;
+    Rtcm_Bit_Writer fourth_data_type;
+    Rtcm_Bit_Writer fifth_data_type;
+    Rtcm_Bit_Writer sixth_data_type;
 
     const uint32_t Ncells = observables.size();
 
@@ -3237,16 +3142,20 @@ std::string Rtcm::get_MSM_7_content_signal_data(const Gps_Ephemeris& ephNAV,
             Rtcm::set_DF420(ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF408(ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF404(ordered_by_PRN_pos.at(cell).second);
-            first_data_type += DF405.to_string();
-            second_data_type += DF406.to_string();
-            third_data_type += DF407.to_string();
-            fourth_data_type += DF420.to_string();
-            fifth_data_type += DF408.to_string();
-            sixth_data_type += DF404.to_string();
-        }
-
-    signal_data = first_data_type + second_data_type + third_data_type + fourth_data_type + fifth_data_type + sixth_data_type;
-    return signal_data;
+            first_data_type.append(DF405);
+            second_data_type.append(DF406);
+            third_data_type.append(DF407);
+            fourth_data_type.append(DF420);
+            fifth_data_type.append(DF408);
+            sixth_data_type.append(DF404);
+        }
+
+    data.append(first_data_type);
+    data.append(second_data_type);
+    data.append(third_data_type);
+    data.append(fourth_data_type);
+    data.append(fifth_data_type);
+    data.append(sixth_data_type);
 }
 
 
@@ -26,6 +26,7 @@
 #include "gnss_synchro.h"
 #include "gps_cnav_ephemeris.h"
 #include "gps_ephemeris.h"
+#include "rtcm_bitstream.h"
 #include <boost/asio.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <glog/logging.h>
@@ -91,6 +92,17 @@ class Rtcm
 {
 public:
     explicit Rtcm(uint16_t port = 2101);  //!< Default constructor that sets TCP port of the RTCM message server and RTCM Station ID. 2101 is the standard RTCM port according to the Internet Assigned Numbers Authority (IANA). See https://www.iana.org/assignments/service-names-port-numbers/service-names-port-numbers.xml
+
+    /*!
+     * \brief Constructor of a NTRIP caster, if mount_points is not empty.
+     * mount_points is a list of mount points separated by spaces, each one
+     * optionally followed by the message types it serves, e.g.
+     * "EPH:1019,1020,1045 MSM:1077,1087,1097 ALL". Clients must request a
+     * mount point ("GET /EPH HTTP/1.0"). Each client has a queue of up to
+     * client_queue_size messages, and the oldest ones are discarded when
+     * the client does not keep up.
+     */
+    Rtcm(uint16_t port, const std::string& mount_points, std::size_t client_queue_size = 64);
     ~Rtcm();
 
     /*!
@@ -454,7 +466,8 @@ private:
      */
     std::bitset<130> get_MT1012_sat_content(const Glonass_Gnav_Ephemeris& ephL1, const Glonass_Gnav_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2);
 
-    std::string get_MSM_header(uint32_t msg_number,
+    void add_MSM_header(Rtcm_Bit_Writer& data,
+        uint32_t msg_number,
         double obs_time,
         const std::map<int32_t, Gnss_Synchro>& observables,
         uint32_t ref_id,
@@ -464,17 +477,17 @@ private:
         bool divergence_free,
         bool more_messages);
 
-    std::string get_MSM_1_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_4_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_5_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables);
+    void add_MSM_1_content_sat_data(Rtcm_Bit_Writer& data, const std::map<int32_t, Gnss_Synchro>& observables);
+    void add_MSM_4_content_sat_data(Rtcm_Bit_Writer& data, const std::map<int32_t, Gnss_Synchro>& observables);
+    void add_MSM_5_content_sat_data(Rtcm_Bit_Writer& data, const std::map<int32_t, Gnss_Synchro>& observables);
 
-    std::string get_MSM_1_content_signal_data(const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_2_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_3_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_4_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_5_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_6_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_7_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
+    void add_MSM_1_content_signal_data(Rtcm_Bit_Writer& data, const std::map<int32_t, Gnss_Synchro>& observables);
+    void add_MSM_2_content_signal_data(Rtcm_Bit_Writer& data, const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
+    void add_MSM_3_content_signal_data(Rtcm_Bit_Writer& data, const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
+    void add_MSM_4_content_signal_data(Rtcm_Bit_Writer& data, const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
+    void add_MSM_5_content_signal_data(Rtcm_Bit_Writer& data, const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
+    void add_MSM_6_content_signal_data(Rtcm_Bit_Writer& data, const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
+    void add_MSM_7_content_signal_data(Rtcm_Bit_Writer& data, const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
 
     //
     // Utilities
@@ -496,6 +509,7 @@ private:
     uint32_t lock_time_indicator(uint32_t lock_time_period_s);
     uint32_t msm_lock_time_indicator(uint32_t lock_time_period_s);
     uint32_t msm_extended_lock_time_indicator(uint32_t lock_time_period_s);
+    std::map<std::string, std::set<uint32_t>> parse_mount_points(const std::string& mount_points) const;
 
     //
     // Classes for TCP communication
@@ -505,88 +519,28 @@ private:
     class Rtcm_Message
     {
     public:
-        static const std::size_t header_length = 6;
-        static const std::size_t max_body_length = 1029;
-
-        Rtcm_Message()
-            : body_length_(0)
-        {
-        }
-
-        const char* data() const
-        {
-            return data_.data();
-        }
-
-        char* data()
-        {
-            return data_.data();
-        }
-
-        inline std::size_t length() const
-        {
-            return header_length + body_length_;
-        }
-
-        const char* body() const
-        {
-            return data_.data() + header_length;
-        }
-
-        char* body()
-        {
-            return data_.data() + header_length;
-        }
-
-        std::size_t body_length() const
-        {
-            return body_length_;
-        }
-
-        void body_length(std::size_t new_length)
+        explicit Rtcm_Message(std::string message) : data_(std::move(message))
         {
-            body_length_ = new_length;
-            if (body_length_ > max_body_length)
+            if (data_.length() > 4)
                 {
-                    body_length_ = max_body_length;
+                    // message number, in the first 12 bits of the data message
+                    type_ = (static_cast<uint32_t>(static_cast<uint8_t>(data_[3])) << 4) | (static_cast<uint32_t>(static_cast<uint8_t>(data_[4])) >> 4);
                 }
         }
 
-        inline bool decode_header()
+        inline const std::string& data() const
         {
-            char header[header_length + 1] = "";
-            std::strncat(header, data_.data(), header_length);
-            if (header[0] != 'G' || header[1] != 'S')
-                {
-                    return false;
-                }
-
-            char header2_[header_length - 1] = "";
-            std::strncat(header2_, data_.data() + 2, header_length - 2);
-            body_length_ = std::atoi(header2_);
-            if (body_length_ == 0)
-                {
-                    return false;
-                }
-
-            if (body_length_ > max_body_length)
-                {
-                    body_length_ = 0;
-                    return false;
-                }
-            return true;
+            return data_;
         }
 
-        inline void encode_header()
+        inline uint32_t type() const
         {
-            char header[header_length + 1] = "";
-            std::snprintf(header, header_length + 1, "GS%4d", std::max(std::min(static_cast<int>(body_length_), static_cast<int>(max_body_length)), 0));
-            std::memcpy(data_.data(), header, header_length);
+            return type_;
         }
 
     private:
-        std::array<char, header_length + max_body_length> data_{};
-        std::size_t body_length_;
+        std::string data_;
+        uint32_t type_{0};
     };
 
 
@@ -594,17 +548,22 @@ private:
     {
     public:
         virtual ~RtcmListener() = default;
-        virtual void deliver(const Rtcm_Message& msg) = 0;
+        virtual void deliver(const std::shared_ptr<const Rtcm_Message>& msg) = 0;
     };
 
 
     class Rtcm_Listener_Room
     {
     public:
+        Rtcm_Listener_Room(const std::map<std::string, std::set<uint32_t>>& mount_points, std::size_t client_queue_size)
+            : mount_points_(mount_points), client_queue_size_(client_queue_size)
+        {
+        }
+
         inline void join(const std::shared_ptr<RtcmListener>& participant)
         {
             participants_.insert(participant);
-            for (auto msg : recent_msgs_)
+            for (const auto& msg : recent_msgs_)
                 {
                     participant->deliver(msg);
                 }
@@ -615,7 +574,7 @@ private:
             participants_.erase(participant);
         }
 
-        inline void deliver(const Rtcm_Message& msg)
+        inline void deliver(const std::shared_ptr<const Rtcm_Message>& msg)
         {
             recent_msgs_.push_back(msg);
             while (recent_msgs_.size() > max_recent_msgs)
@@ -629,31 +588,95 @@ private:
                 }
         }
 
+        inline bool is_caster() const
+        {
+            return !mount_points_.empty();
+        }
+
+        inline std::size_t client_queue_size() const
+        {
+            return client_queue_size_;
+        }
+
+        // Message types of a mount point (all of them if empty), or nullptr if it does not exist
+        inline const std::set<uint32_t>* find_mount_point(const std::string& name) const
+        {
+            const auto it = mount_points_.find(name);
+            return it == mount_points_.cend() ? nullptr : &it->second;
+        }
+
+        inline std::string sourcetable() const
+        {
+            std::string table;
+            for (const auto& mount_point : mount_points_)
+                {
+                    std::string types;
+                    for (const auto type : mount_point.second)
+                        {
+                            types += (types.empty() ? "" : ",") + std::to_string(type);
+                        }
+                    table += "STR;" + mount_point.first + ";" + mount_point.first + ";RTCM 3.2;" + types + ";2;GPS+GLO+GAL;GNSS-SDR;;0.00;0.00;0;0;GNSS-SDR;none;N;N;0;\r\n";
+                }
+            table += "ENDSOURCETABLE\r\n";
+            return "SOURCETABLE 200 OK\r\nServer: GNSS-SDR\r\nContent-Type: text/plain\r\nContent-Length: " + std::to_string(table.length()) + "\r\n\r\n" + table;
+        }
+
     private:
         std::set<std::shared_ptr<RtcmListener>> participants_;
         enum
         {
             max_recent_msgs = 1
         };
-        std::deque<Rtcm_Message> recent_msgs_;
+        std::deque<std::shared_ptr<const Rtcm_Message>> recent_msgs_;
+        std::map<std::string, std::set<uint32_t>> mount_points_;
+        std::size_t client_queue_size_;
     };
 
 
+    /*
+     * A client session. The messages are shared with the other sessions and
+     * written as they are. The queue of messages waiting to be written is
+     * bounded: when the client is too slow, the oldest ones are discarded.
+     *
+     * If the server has mount points, the session waits for a NTRIP request
+     * ("GET /mount_point HTTP/1.x"), and sends the sourcetable for unknown
+     * mount points. Otherwise, all messages are sent from the start.
+     */
     class Rtcm_Session
         : public RtcmListener,
           public std::enable_shared_from_this<Rtcm_Session>
     {
     public:
-        Rtcm_Session(boost::asio::ip::tcp::socket socket, Rtcm_Listener_Room& room) : socket_(std::move(socket)), room_(room) {}
+        Rtcm_Session(boost::asio::ip::tcp::socket socket, Rtcm_Listener_Room& room)
+            : socket_(std::move(socket)), room_(room), max_write_msgs_(std::max(room.client_queue_size(), static_cast<std::size_t>(2)))
+        {
+        }
+
         inline void start()
         {
-            room_.join(shared_from_this());
-            do_read_message_header();
+            if (!room_.is_caster())
+                {
+                    room_.join(shared_from_this());
+                }
+            do_read();
         }
 
-        inline void deliver(const Rtcm_Message& msg)
+        inline void deliver(const std::shared_ptr<const Rtcm_Message>& msg) override
         {
-            bool write_in_progress = !write_msgs_.empty();
+            if (message_types_ != nullptr && !message_types_->empty() && message_types_->count(msg->type()) == 0)
+                {
+                    return;
+                }
+            if (write_msgs_.size() >= max_write_msgs_)
+                {
+                    // discard the oldest message that is not being written
+                    write_msgs_.erase(write_msgs_.begin() + 1);
+                    if (dropped_msgs_++ == 0)
+                        {
+                            LOG(WARNING) << "RTCM client too slow, discarding messages";
+                        }
+                }
+            const bool write_in_progress = !write_msgs_.empty();
             write_msgs_.push_back(msg);
             if (!write_in_progress)
                 {
@@ -662,159 +685,108 @@ private:
         }
 
     private:
-        inline void do_read_message_header()
+        inline void do_read()
         {
             auto self(shared_from_this());
-            boost::asio::async_read(socket_,
-                boost::asio::buffer(read_msg_.data(), Rtcm_Message::header_length),
-                [this, self](boost::system::error_code ec, std::size_t /*length*/) {
-                    if (!ec and read_msg_.decode_header())
-                        {
-                            do_read_message_body();
-                        }
-                    else if (!ec and !read_msg_.decode_header())
+            socket_.async_read_some(boost::asio::buffer(read_buffer_),
+                [this, self](boost::system::error_code ec, std::size_t length) {
+                    if (!ec)
                         {
-                            client_says += read_msg_.data();
-                            bool first = true;
-                            while (client_says.length() >= 80)
+                            client_says += std::string(read_buffer_.data(), length);
+                            if (room_.is_caster() && !request_read_)
                                 {
-                                    if (first == true)
-                                        {
-                                            LOG(INFO) << "Client says:";
-                                            first = false;
-                                        }
-                                    LOG(INFO) << client_says;
-                                    client_says = client_says.substr(80, client_says.length() - 80);
+                                    read_request();
                                 }
-                            do_read_message_header();
-                        }
-                    else
-                        {
-                            std::cout << "Closing connection with RTCM client\n";
-                            room_.leave(shared_from_this());
-                        }
-                });
-        }
-
-        inline void do_read_message_body()
-        {
-            auto self(shared_from_this());
-            boost::asio::async_read(socket_,
-                boost::asio::buffer(read_msg_.body(), read_msg_.body_length()),
-                [this, self](boost::system::error_code ec, std::size_t /*length*/) {
-                    if (!ec)
-                        {
-                            room_.deliver(read_msg_);
-                            // std::cout << "Delivered message (session): ";
-                            // std::cout.write(read_msg_.body(), read_msg_.body_length());
-                            // std::cout << '\n';
-                            do_read_message_header();
-                        }
-                    else
-                        {
-                            std::cout << "Closing connection with RTCM client\n";
-                            room_.leave(shared_from_this());
-                        }
-                });
-        }
-
-        inline void do_write()
-        {
-            auto self(shared_from_this());
-            boost::asio::async_write(socket_,
-                boost::asio::buffer(write_msgs_.front().body(), write_msgs_.front().body_length()),
-                [this, self](boost::system::error_code ec, std::size_t /*length*/) {
-                    if (!ec)
-                        {
-                            write_msgs_.pop_front();
-                            if (!write_msgs_.empty())
+                            else
                                 {
-                                    do_write();
+                                    log_client_says();
+                                }
+                            if (!closed_)
+                                {
+                                    do_read();
                                 }
                         }
                     else
                         {
-                            std::cout << "Closing connection with RTCM client\n";
-                            room_.leave(shared_from_this());
+                            close_session();
                         }
                 });
         }
 
-        boost::asio::ip::tcp::socket socket_;
-        Rtcm_Listener_Room& room_;
-        Rtcm_Message read_msg_;
-        std::deque<Rtcm_Message> write_msgs_;
-        std::string client_says;
-    };
-
-
-    class Tcp_Internal_Client
-        : public std::enable_shared_from_this<Tcp_Internal_Client>
-    {
-    public:
-        Tcp_Internal_Client(b_io_context& io_context,
-            boost::asio::ip::tcp::resolver::iterator endpoint_iterator)
-            : io_context_(io_context), socket_(io_context)
-        {
-            do_connect(std::move(endpoint_iterator));
-        }
-
-        inline void close()
+        inline void read_request()
         {
-            io_context_.post([this]() { socket_.close(); });
-        }
-
-        inline void write(const Rtcm_Message& msg)
-        {
-            io_context_.post(
-                [this, msg]() {
-                    bool write_in_progress = !write_msgs_.empty();
-                    write_msgs_.push_back(msg);
-                    if (!write_in_progress)
+            const std::size_t end = client_says.find("\r\n\r\n");
+            if (end == std::string::npos)
+                {
+                    if (client_says.length() > max_request_length)
                         {
-                            do_write();
+                            LOG(INFO) << "Bad NTRIP request from RTCM client";
+                            close_session();
                         }
-                });
+                    return;
+                }
+            // request line: GET /mount_point HTTP/1.x
+            const std::string request_line = client_says.substr(0, client_says.find("\r\n"));
+            client_says.erase(0, end + 4);
+            request_read_ = true;
+            const std::size_t method_end = request_line.find(' ');
+            const std::size_t resource_end = request_line.find(' ', method_end + 1);
+            const std::set<uint32_t>* message_types = nullptr;
+            if (request_line.compare(0, method_end, "GET") == 0 && method_end != std::string::npos && request_line.compare(method_end + 1, 1, "/") == 0)
+                {
+                    message_types = room_.find_mount_point(request_line.substr(method_end + 2, resource_end - method_end - 2));
+                }
+            if (message_types == nullptr)
+                {
+                    write_response(room_.sourcetable(), false);
+                }
+            else
+                {
+                    LOG(INFO) << "RTCM client request: " << request_line;
+                    message_types_ = message_types;
+                    write_response("ICY 200 OK\r\n\r\n", true);
+                }
         }
 
-    private:
-        inline void do_connect(boost::asio::ip::tcp::resolver::iterator endpoint_iterator)
+        inline void write_response(const std::string& response, bool start_stream)
         {
-            boost::asio::async_connect(socket_, std::move(endpoint_iterator),
-                [this](boost::system::error_code ec, boost::asio::ip::tcp::resolver::iterator) {
-                    if (!ec)
+            auto self(shared_from_this());
+            response_ = response;
+            boost::asio::async_write(socket_,
+                boost::asio::buffer(response_),
+                [this, self, start_stream](boost::system::error_code ec, std::size_t /*length*/) {
+                    if (!ec && start_stream)
                         {
-                            do_read_message();
+                            room_.join(shared_from_this());
                         }
                     else
                         {
-                            std::cout << "Server is down.\n";
+                            close_session();
                         }
                 });
         }
 
-        inline void do_read_message()
+        inline void log_client_says()
         {
-            boost::asio::async_read(socket_,
-                boost::asio::buffer(read_msg_.data(), 1029),
-                [this](boost::system::error_code ec, std::size_t /*length*/) {
-                    if (!ec)
-                        {
-                            do_read_message();
-                        }
-                    else
+            bool first = true;
+            while (client_says.length() >= 80)
+                {
+                    if (first == true)
                         {
-                            std::cout << "Error in client\n";
-                            socket_.close();
+                            LOG(INFO) << "Client says:";
+                            first = false;
                         }
-                });
+                    LOG(INFO) << client_says.substr(0, 80);
+                    client_says = client_says.substr(80, client_says.length() - 80);
+                }
         }
 
         inline void do_write()
         {
+            auto self(shared_from_this());
             boost::asio::async_write(socket_,
-                boost::asio::buffer(write_msgs_.front().data(), write_msgs_.front().length()),
-                [this](boost::system::error_code ec, std::size_t /*length*/) {
+                boost::asio::buffer(write_msgs_.front()->data()),
+                [this, self](boost::system::error_code ec, std::size_t /*length*/) {
                     if (!ec)
                         {
                             write_msgs_.pop_front();
@@ -825,61 +797,54 @@ private:
                         }
                     else
                         {
-                            socket_.close();
+                            close_session();
                         }
                 });
         }
 
-        b_io_context& io_context_;
-        boost::asio::ip::tcp::socket socket_;
-        Rtcm_Message read_msg_;
-        std::deque<Rtcm_Message> write_msgs_;
-    };
-
-
-    class Queue_Reader
-    {
-    public:
-        Queue_Reader(b_io_context& io_context, std::shared_ptr<Concurrent_Queue<std::string>>& queue, int32_t port) : queue_(queue)
+        inline void close_session()
         {
-            boost::asio::ip::tcp::resolver resolver(io_context);
-            std::string host("localhost");
-            std::string port_str = std::to_string(port);
-            auto queue_endpoint_iterator = resolver.resolve({host.c_str(), port_str.c_str()});
-            c = std::make_shared<Tcp_Internal_Client>(io_context, queue_endpoint_iterator);
-        }
-
-        inline void do_read_queue()
-        {
-            for (;;)
+            if (closed_)
                 {
-                    std::string message;
-                    Rtcm_Message msg;
-                    queue_->wait_and_pop(message);  // message += '\n';
-                    if (message == "Goodbye")
-                        {
-                            break;
-                        }
-
-                    const char* char_msg = message.c_str();
-                    msg.body_length(message.length());
-                    std::memcpy(msg.body(), char_msg, msg.body_length());
-                    msg.encode_header();
-                    c->write(msg);
+                    return;
+                }
+            closed_ = true;
+            std::cout << "Closing connection with RTCM client\n";
+            if (dropped_msgs_ > 0)
+                {
+                    LOG(WARNING) << "RTCM client session closed, " << dropped_msgs_ << " messages discarded";
                 }
+            room_.leave(shared_from_this());
+            boost::system::error_code ec;
+            socket_.close(ec);
         }
 
-    private:
-        std::shared_ptr<Tcp_Internal_Client> c;
-        std::shared_ptr<Concurrent_Queue<std::string>>& queue_;
+        enum
+        {
+            max_request_length = 4096
+        };
+        boost::asio::ip::tcp::socket socket_;
+        Rtcm_Listener_Room& room_;
+        std::array<char, 512> read_buffer_{};
+        std::deque<std::shared_ptr<const Rtcm_Message>> write_msgs_;
+        std::string client_says;
+        std::string response_;
+        const std::set<uint32_t>* message_types_{nullptr};
+        std::size_t max_write_msgs_;
+        uint64_t dropped_msgs_{0};
+        bool request_read_{false};
+        bool closed_{false};
     };
 
 
     class Tcp_Server
     {
     public:
-        Tcp_Server(b_io_context& io_context, const boost::asio::ip::tcp::endpoint& endpoint)
-            : acceptor_(io_context), socket_(io_context)
+        Tcp_Server(b_io_context& io_context,
+            const boost::asio::ip::tcp::endpoint& endpoint,
+            const std::map<std::string, std::set<uint32_t>>& mount_points,
+            std::size_t client_queue_size)
+            : acceptor_(io_context), socket_(io_context), room_(mount_points, client_queue_size)
         {
             acceptor_.open(endpoint.protocol());
             acceptor_.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true));
@@ -894,38 +859,32 @@ private:
             acceptor_.close();
         }
 
+        inline void deliver(const std::shared_ptr<const Rtcm_Message>& msg)
+        {
+            room_.deliver(msg);
+        }
+
     private:
         inline void do_accept()
         {
             acceptor_.async_accept(socket_, [this](boost::system::error_code ec) {
                 if (!ec)
                     {
-                        if (first_client)
+                        std::cout << "Starting RTCM TCP/IP server session...\n";
+                        boost::system::error_code ec2;
+                        boost::asio::ip::tcp::endpoint endpoint = socket_.remote_endpoint(ec2);
+                        if (ec2)
                             {
-                                std::cout << "The TCP/IP server of RTCM messages is up and running. Accepting connections ...\n";
-                                first_client = false;
+                                // Error creating remote_endpoint
+                                std::cout << "Error getting remote IP address, closing session.\n";
+                                LOG(INFO) << "Error getting remote IP address";
+                                socket_.close(ec2);
                             }
                         else
                             {
-                                std::cout << "Starting RTCM TCP/IP server session...\n";
-                                boost::system::error_code ec2;
-                                boost::asio::ip::tcp::endpoint endpoint = socket_.remote_endpoint(ec2);
-                                if (ec2)
-                                    {
-                                        // Error creating remote_endpoint
-                                        std::cout << "Error getting remote IP address, closing session.\n";
-                                        LOG(INFO) << "Error getting remote IP address";
-                                        start_session = false;
-                                    }
-                                else
-                                    {
-                                        std::string remote_addr = endpoint.address().to_string();
-                                        std::cout << "Serving client from " << remote_addr << '\n';
-                                        LOG(INFO) << "Serving client from " << remote_addr;
-                                    }
-                            }
-                        if (start_session)
-                            {
+                                std::string remote_addr = endpoint.address().to_string();
+                                std::cout << "Serving client from " << remote_addr << '\n';
+                                LOG(INFO) << "Serving client from " << remote_addr;
                                 std::make_shared<Rtcm_Session>(std::move(socket_), room_)->start();
                             }
                     }
@@ -933,7 +892,6 @@ private:
                     {
                         std::cout << "Error when invoking a RTCM session. " << ec << '\n';
                     }
-                start_session = true;
                 do_accept();
             });
         }
@@ -941,10 +899,49 @@ private:
         boost::asio::ip::tcp::acceptor acceptor_;
         boost::asio::ip::tcp::socket socket_;
         Rtcm_Listener_Room room_;
-        bool first_client = true;
-        bool start_session = true;
     };
 
+
+    /*
+     * Takes the messages from the queue, and hands them over to the servers
+     * in the thread of the io_context. Each message is copied once, and
+     * shared by all the client sessions.
+     */
+    class Queue_Reader
+    {
+    public:
+        Queue_Reader(b_io_context& io_context, std::shared_ptr<Concurrent_Queue<std::string>>& queue, std::list<Tcp_Server>& servers)
+            : io_context_(io_context), queue_(queue), servers_(servers)
+        {
+        }
+
+        inline void do_read_queue()
+        {
+            for (;;)
+                {
+                    std::string message;
+                    queue_->wait_and_pop(message);
+                    if (message == "Goodbye")
+                        {
+                            break;
+                        }
+
+                    const auto msg = std::make_shared<const Rtcm_Message>(std::move(message));
+                    for (auto& server : servers_)
+                        {
+                            Tcp_Server* s = &server;
+                            io_context_.post([s, msg]() { s->deliver(msg); });
+                        }
+                }
+        }
+
+    private:
+        b_io_context& io_context_;
+        std::shared_ptr<Concurrent_Queue<std::string>>& queue_;
+        std::list<Tcp_Server>& servers_;
+    };
+
+
     b_io_context io_context;
     std::shared_ptr<Concurrent_Queue<std::string>> rtcm_message_queue;
     std::thread t;
@@ -956,10 +953,8 @@ private:
     //
     // Transport Layer
     //
-    std::bitset<8> preamble;
-    std::bitset<6> reserved_field;
-    std::string add_CRC(const std::string& m) const;
-    std::string build_message(const std::string& data) const;  // adds 0s to complete a byte and adds the CRC
+    std::string build_message(const std::string& data) const;      // adds 0s to complete a byte and adds the CRC
+    std::string build_message(const Rtcm_Bit_Writer& data) const;  // adds the transport layer to a data message
 
     //
     // Data Fields
@@ -0,0 +1,190 @@
+/*!
+ * \file rtcm_bitstream.cc
+ * \brief Packed bit writer and reader for RTCM 3 messages
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "rtcm_bitstream.h"
+#include <array>
+
+
+uint32_t rtcm_crc24q(const uint8_t* buff, std::size_t length)
+{
+    // Table of the CRC-24Q generator polynomial 0x1864CFB
+    static const std::array<uint32_t, 256> table = [] {
+        std::array<uint32_t, 256> t{};
+        for (uint32_t i = 0; i < 256; i++)
+            {
+                uint32_t crc = i << 16;
+                for (int32_t j = 0; j < 8; j++)
+                    {
+                        crc <<= 1;
+                        if (crc & 0x1000000U)
+                            {
+                                crc ^= 0x1864CFBU;
+                            }
+                    }
+                t[i] = crc & 0xFFFFFFU;
+            }
+        return t;
+    }();
+
+    uint32_t crc = 0;
+    for (std::size_t i = 0; i < length; i++)
+        {
+            crc = ((crc << 8) & 0xFFFFFFU) ^ table[((crc >> 16) ^ buff[i]) & 0xFFU];
+        }
+    return crc;
+}
+
+
+Rtcm_Bit_Writer::Rtcm_Bit_Writer(std::size_t reserved_bits)
+{
+    d_bytes.reserve((reserved_bits + 7) / 8);
+}
+
+
+void Rtcm_Bit_Writer::append(uint64_t value, uint32_t nbits)
+{
+    if (nbits == 0)
+        {
+            return;
+        }
+    if (nbits < 64)
+        {
+            value &= (static_cast<uint64_t>(1) << nbits) - 1;
+        }
+    d_bytes.resize((d_bits + nbits + 7) / 8, 0);
+    while (nbits > 0)
+        {
+            // write as many bits as there are left in the current byte
+            const uint32_t free_bits = 8 - (d_bits % 8);
+            const uint32_t n = nbits < free_bits ? nbits : free_bits;
+            const auto chunk = static_cast<uint32_t>((value >> (nbits - n)) & ((1U << n) - 1));
+            d_bytes[d_bits / 8] |= static_cast<uint8_t>(chunk << (free_bits - n));
+            d_bits += n;
+            nbits -= n;
+        }
+}
+
+
+void Rtcm_Bit_Writer::append(const std::string& bits)
+{
+    // in chunks of up to 64 bits
+    std::size_t i = 0;
+    while (i < bits.size())
+        {
+            uint64_t value = 0;
+            uint32_t n = 0;
+            for (; i < bits.size() && n < 64; i++, n++)
+                {
+                    value = (value << 1) | (bits[i] == '1' ? 1 : 0);
+                }
+            append(value, n);
+        }
+}
+
+
+void Rtcm_Bit_Writer::append(const Rtcm_Bit_Writer& other)
+{
+    const std::size_t whole_bytes = other.d_bits / 8;
+    for (std::size_t i = 0; i < whole_bytes; i++)
+        {
+            append(other.d_bytes[i], 8);
+        }
+    const auto remaining_bits = static_cast<uint32_t>(other.d_bits % 8);
+    if (remaining_bits > 0)
+        {
+            append(other.d_bytes[whole_bytes] >> (8 - remaining_bits), remaining_bits);
+        }
+}
+
+
+std::string Rtcm_Bit_Writer::frame() const
+{
+    const std::size_t length = d_bytes.size();
+    std::string message(length + 6, '\0');
+    auto* buff = reinterpret_cast<uint8_t*>(&message[0]);
+    buff[0] = 0xD3;  // preamble
+    buff[1] = static_cast<uint8_t>((length >> 8) & 0x03U);  // 6 reserved bits, and the message length (10 bits)
+    buff[2] = static_cast<uint8_t>(length & 0xFFU);
+    for (std::size_t i = 0; i < length; i++)
+        {
+            buff[3 + i] = d_bytes[i];
+        }
+    const uint32_t crc = rtcm_crc24q(buff, length + 3);
+    buff[length + 3] = static_cast<uint8_t>((crc >> 16) & 0xFFU);
+    buff[length + 4] = static_cast<uint8_t>((crc >> 8) & 0xFFU);
+    buff[length + 5] = static_cast<uint8_t>(crc & 0xFFU);
+    return message;
+}
+
+
+Rtcm_Bit_Reader::Rtcm_Bit_Reader(const std::string& message) : d_data(reinterpret_cast<const uint8_t*>(message.data())),
+                                                                d_length(message.size())
+{
+}
+
+
+bool Rtcm_Bit_Reader::check_CRC() const
+{
+    if (d_length < 6)
+        {
+            return false;
+        }
+    const uint32_t read_crc = (static_cast<uint32_t>(d_data[d_length - 3]) << 16) |
+                              (static_cast<uint32_t>(d_data[d_length - 2]) << 8) |
+                              static_cast<uint32_t>(d_data[d_length - 1]);
+    return read_crc == rtcm_crc24q(d_data, d_length - 3);
+}
+
+
+uint64_t Rtcm_Bit_Reader::get_uint(uint32_t nbits)
+{
+    uint64_t value = 0;
+    while (nbits > 0)
+        {
+            // read as many bits as there are left in the current byte
+            const std::size_t byte = d_index / 8;
+            const uint32_t available_bits = 8 - (d_index % 8);
+            const uint32_t n = nbits < available_bits ? nbits : available_bits;
+            const uint32_t current = byte < d_length ? d_data[byte] : 0;
+            value = (value << n) | ((current >> (available_bits - n)) & ((1U << n) - 1));
+            d_index += n;
+            nbits -= n;
+        }
+    return value;
+}
+
+
+int64_t Rtcm_Bit_Reader::get_int(uint32_t nbits)
+{
+    const uint64_t value = get_uint(nbits);
+    if (nbits > 0 && nbits < 64 && ((value >> (nbits - 1)) & 1U))
+        {
+            // two's complement
+            return static_cast<int64_t>(value) - static_cast<int64_t>(static_cast<uint64_t>(1) << nbits);
+        }
+    return static_cast<int64_t>(value);
+}
+
+
+int64_t Rtcm_Bit_Reader::get_sint(uint32_t nbits)
+{
+    if (nbits == 0)
+        {
+            return 0;
+        }
+    const bool negative = get_uint(1) == 1;
+    const auto magnitude = static_cast<int64_t>(get_uint(nbits - 1));
+    return negative ? -magnitude : magnitude;
+}
@@ -0,0 +1,143 @@
+/*!
+ * \file rtcm_bitstream.h
+ * \brief Packed bit writer and reader for RTCM 3 messages
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_RTCM_BITSTREAM_H
+#define GNSS_SDR_RTCM_BITSTREAM_H
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/** \addtogroup PVT
+ * \{ */
+/** \addtogroup PVT_libs
+ * \{ */
+
+
+/*!
+ * \brief Computes the Qualcomm CRC-24Q of a byte buffer, as defined in the
+ * RTCM 10403 transport layer
+ */
+uint32_t rtcm_crc24q(const uint8_t* buff, std::size_t length);
+
+
+/*!
+ * \brief Writes the data fields of a RTCM message, most significant bit
+ * first, directly into a byte buffer.
+ */
+class Rtcm_Bit_Writer
+{
+public:
+    explicit Rtcm_Bit_Writer(std::size_t reserved_bits = 1024);
+
+    /*!
+     * \brief Appends the nbits (up to 64) least significant bits of value
+     */
+    void append(uint64_t value, uint32_t nbits);
+
+    /*!
+     * \brief Appends a data field. Fields are at most 64 bits long.
+     */
+    template <std::size_t N>
+    inline void append(const std::bitset<N>& field)
+    {
+        static_assert(N <= 64, "RTCM data fields are at most 64 bits long");
+        append(static_cast<uint64_t>(field.to_ullong()), N);
+    }
+
+    /*!
+     * \brief Appends a string of binary symbols ('0' and '1')
+     */
+    void append(const std::string& bits);
+
+    /*!
+     * \brief Appends the bits written in another writer
+     */
+    void append(const Rtcm_Bit_Writer& other);
+
+    /*!
+     * \brief Returns the number of bits written
+     */
+    inline std::size_t size() const
+    {
+        return d_bits;
+    }
+
+    /*!
+     * \brief Returns the complete message, as a string of binary data: the
+     * preamble, the reserved bits and the message length, the data padded
+     * with zeros to a whole number of bytes, and the CRC-24Q.
+     */
+    std::string frame() const;
+
+private:
+    std::vector<uint8_t> d_bytes;
+    std::size_t d_bits{0};
+};
+
+
+/*!
+ * \brief Reads the data fields of a RTCM message, given as a string of binary
+ * data (as returned by Rtcm_Bit_Writer::frame()). The message must outlive
+ * the reader. Reading past the end of the message returns zeros.
+ */
+class Rtcm_Bit_Reader
+{
+public:
+    explicit Rtcm_Bit_Reader(const std::string& message);
+
+    /*!
+     * \brief Returns true if the message is long enough for its CRC and the
+     * CRC-24Q of the message is correct
+     */
+    bool check_CRC() const;
+
+    uint64_t get_uint(uint32_t nbits);  //!< Reads an unsigned field of up to 64 bits
+    int64_t get_int(uint32_t nbits);    //!< Reads a two's complement field of up to 64 bits
+
+    /*!
+     * \brief Reads a sign-magnitude field of up to 64 bits, with the sign in
+     * its first bit (1 for negative values), as in the GLONASS data fields
+     */
+    int64_t get_sint(uint32_t nbits);
+
+    /*!
+     * \brief Skips nbits bits
+     */
+    inline void skip(uint32_t nbits)
+    {
+        d_index += nbits;
+    }
+
+    /*!
+     * \brief Returns the number of bits in the message
+     */
+    inline std::size_t size() const
+    {
+        return 8 * d_length;
+    }
+
+private:
+    const uint8_t* d_data;
+    std::size_t d_length;
+    std::size_t d_index{0};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_RTCM_BITSTREAM_H
@@ -46,12 +46,14 @@ Rtcm_Printer::Rtcm_Printer(const std::string& filename,
     uint16_t rtcm_station_id,
     const std::string& rtcm_dump_devname,
     bool time_tag_name,
-    const std::string& base_path) : rtcm_base_path(base_path),
-                                    rtcm_devname(rtcm_dump_devname),
-                                    port(rtcm_tcp_port),
-                                    station_id(rtcm_station_id),
-                                    d_rtcm_writing_started(false),
-                                    d_rtcm_file_dump(flag_rtcm_file_dump)
+    const std::string& base_path,
+    const std::string& rtcm_mount_points,
+    uint32_t rtcm_client_queue_size) : rtcm_base_path(base_path),
+                                       rtcm_devname(rtcm_dump_devname),
+                                       port(rtcm_tcp_port),
+                                       station_id(rtcm_station_id),
+                                       d_rtcm_writing_started(false),
+                                       d_rtcm_file_dump(flag_rtcm_file_dump)
 {
     const boost::posix_time::ptime pt = boost::posix_time::second_clock::local_time();
     const tm timeinfo = boost::posix_time::to_tm(pt);
@@ -158,7 +160,7 @@ Rtcm_Printer::Rtcm_Printer(const std::string& filename,
             rtcm_dev_descriptor = -1;
         }
 
-    rtcm = std::make_unique<Rtcm>(port);
+    rtcm = std::make_unique<Rtcm>(port, rtcm_mount_points, rtcm_client_queue_size);
 
     if (flag_rtcm_server)
         {
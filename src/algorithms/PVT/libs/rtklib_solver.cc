@@ -33,12 +33,17 @@
 #include "rtklib_solver.h"
 #include "Beidou_DNAV.h"
 #include "gnss_sdr_filesystem.h"
+#include "gnss_sdr_make_unique.h"
+#include "gnss_signal_id.h"
 #include "rtklib_conversions.h"
+#include "rtklib_ephemeris.h"
 #include "rtklib_rtkpos.h"
 #include "rtklib_solution.h"
 #include <glog/logging.h>
 #include <matio.h>
+#include <algorithm>
 #include <exception>
+#include <iterator>
 #include <utility>
 #include <vector>
 
@@ -46,12 +51,37 @@
 Rtklib_Solver::Rtklib_Solver(const rtk_t &rtk,
     const std::string &dump_filename,
     bool flag_dump_to_file,
-    bool flag_dump_to_mat) : d_rtk(rtk),
-                             d_dump_filename(dump_filename),
-                             d_flag_dump_enabled(flag_dump_to_file),
-                             d_flag_dump_mat_enabled(flag_dump_to_mat)
+    bool flag_dump_to_mat,
+    std::shared_ptr<Rtklib_Nav_Data> nav_data) : d_nav_data(nav_data ? std::move(nav_data) : std::make_shared<Rtklib_Nav_Data>()),
+                                                 galileo_ephemeris_map(d_nav_data->galileo_ephemeris_map),
+                                                 gps_ephemeris_map(d_nav_data->gps_ephemeris_map),
+                                                 gps_cnav_ephemeris_map(d_nav_data->gps_cnav_ephemeris_map),
+                                                 glonass_gnav_ephemeris_map(d_nav_data->glonass_gnav_ephemeris_map),
+                                                 beidou_dnav_ephemeris_map(d_nav_data->beidou_dnav_ephemeris_map),
+                                                 galileo_utc_model(d_nav_data->galileo_utc_model),
+                                                 galileo_iono(d_nav_data->galileo_iono),
+                                                 galileo_almanac_map(d_nav_data->galileo_almanac_map),
+                                                 gps_utc_model(d_nav_data->gps_utc_model),
+                                                 gps_iono(d_nav_data->gps_iono),
+                                                 gps_almanac_map(d_nav_data->gps_almanac_map),
+                                                 gps_cnav_iono(d_nav_data->gps_cnav_iono),
+                                                 gps_cnav_utc_model(d_nav_data->gps_cnav_utc_model),
+                                                 glonass_gnav_utc_model(d_nav_data->glonass_gnav_utc_model),
+                                                 glonass_gnav_almanac(d_nav_data->glonass_gnav_almanac),
+                                                 beidou_dnav_utc_model(d_nav_data->beidou_dnav_utc_model),
+                                                 beidou_dnav_iono(d_nav_data->beidou_dnav_iono),
+                                                 beidou_dnav_almanac_map(d_nav_data->beidou_dnav_almanac_map),
+                                                 d_rtk(rtk),
+                                                 d_dump_filename(dump_filename),
+                                                 d_flag_dump_enabled(flag_dump_to_file),
+                                                 d_flag_dump_mat_enabled(flag_dump_to_mat)
 {
     this->set_averaging_flag(false);
+    d_eph_data = std::vector<eph_t>(MAXOBS);
+    d_geph_data = std::vector<geph_t>(MAXOBS);
+    d_eph_cache = std::vector<Rtklib_Eph_Cache_Entry>(MAXSAT + 1);
+    d_cnav_eph_cache = std::vector<Rtklib_Eph_Cache_Entry>(MAXSAT + 1);
+    d_geph_cache = std::vector<Rtklib_Geph_Cache_Entry>(MAXSAT + 1);
 
     // ############# ENABLE DATA FILE LOG #################
     if (d_flag_dump_enabled == true)
@@ -76,6 +106,26 @@ Rtklib_Solver::Rtklib_Solver(const rtk_t &rtk,
 Rtklib_Solver::~Rtklib_Solver()
 {
     DLOG(INFO) << "Rtklib_Solver destructor called.";
+    if (d_positioning_thread.joinable())
+        {
+            try
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(d_positioning_mutex);
+                        d_positioning_stop = true;
+                    }
+                    d_positioning_cond.notify_one();
+                    d_positioning_thread.join();
+                    if (d_skipped_epochs > 0)
+                        {
+                            LOG(INFO) << "Decoupled positioning: " << d_skipped_epochs << " epochs skipped";
+                        }
+                }
+            catch (const std::exception &ex)
+                {
+                    LOG(WARNING) << "Exception in destructor stopping the positioning thread " << ex.what();
+                }
+        }
     if (d_dump_file.is_open() == true)
         {
             const auto pos = d_dump_file.tellp();
@@ -111,6 +161,282 @@ Rtklib_Solver::~Rtklib_Solver()
 }
 
 
+Rtklib_Solver::Rtklib_Solver(const Rtklib_Solver &other, Snapshot_Tag tag __attribute__((unused))) : Pvt_Solution(other),
+                                                                                                    pvt_sol(other.pvt_sol),
+                                                                                                    pvt_ssat(other.pvt_ssat),
+                                                                                                    d_nav_data(std::make_shared<Rtklib_Nav_Data>(*other.d_nav_data)),
+                                                                                                    galileo_ephemeris_map(d_nav_data->galileo_ephemeris_map),
+                                                                                                    gps_ephemeris_map(d_nav_data->gps_ephemeris_map),
+                                                                                                    gps_cnav_ephemeris_map(d_nav_data->gps_cnav_ephemeris_map),
+                                                                                                    glonass_gnav_ephemeris_map(d_nav_data->glonass_gnav_ephemeris_map),
+                                                                                                    beidou_dnav_ephemeris_map(d_nav_data->beidou_dnav_ephemeris_map),
+                                                                                                    galileo_utc_model(d_nav_data->galileo_utc_model),
+                                                                                                    galileo_iono(d_nav_data->galileo_iono),
+                                                                                                    galileo_almanac_map(d_nav_data->galileo_almanac_map),
+                                                                                                    gps_utc_model(d_nav_data->gps_utc_model),
+                                                                                                    gps_iono(d_nav_data->gps_iono),
+                                                                                                    gps_almanac_map(d_nav_data->gps_almanac_map),
+                                                                                                    gps_cnav_iono(d_nav_data->gps_cnav_iono),
+                                                                                                    gps_cnav_utc_model(d_nav_data->gps_cnav_utc_model),
+                                                                                                    glonass_gnav_utc_model(d_nav_data->glonass_gnav_utc_model),
+                                                                                                    glonass_gnav_almanac(d_nav_data->glonass_gnav_almanac),
+                                                                                                    beidou_dnav_utc_model(d_nav_data->beidou_dnav_utc_model),
+                                                                                                    beidou_dnav_iono(d_nav_data->beidou_dnav_iono),
+                                                                                                    beidou_dnav_almanac_map(d_nav_data->beidou_dnav_almanac_map),
+                                                                                                    d_dop(other.d_dop),
+                                                                                                    d_monitor_pvt(other.d_monitor_pvt),
+                                                                                                    d_flag_dump_enabled(false),
+                                                                                                    d_flag_dump_mat_enabled(false)
+{
+}
+
+
+std::shared_ptr<const Rtklib_Solver> Rtklib_Solver::snapshot() const
+{
+    return std::shared_ptr<const Rtklib_Solver>(new Rtklib_Solver(*this, Snapshot_Tag{}));
+}
+
+
+std::shared_ptr<Rtklib_Nav_Data> Rtklib_Solver::get_nav_data() const
+{
+    return d_nav_data;
+}
+
+
+void Rtklib_Solver::enable_decoupled_positioning()
+{
+    if (d_positioning_thread.joinable())
+        {
+            return;
+        }
+    for (auto *epoch : {&d_next_epoch, &d_queued_epoch, &d_working_epoch})
+        {
+            *epoch = std::make_unique<Positioning_Epoch>();
+            (*epoch)->eph = std::vector<eph_t>(MAXOBS);
+            (*epoch)->geph = std::vector<geph_t>(MAXOBS);
+        }
+    d_working_result = std::make_unique<Positioning_Result>();
+    d_ready_result = std::make_unique<Positioning_Result>();
+    d_taken_result = std::make_unique<Positioning_Result>();
+    d_positioning_thread = std::thread(&Rtklib_Solver::run_positioning, this);
+}
+
+
+uint64_t Rtklib_Solver::get_skipped_epochs() const
+{
+    std::lock_guard<std::mutex> lock(d_positioning_mutex);
+    return d_skipped_epochs;
+}
+
+
+void Rtklib_Solver::enable_pseudorange_rates()
+{
+    d_compute_pseudorange_rates = true;
+}
+
+
+void Rtklib_Solver::enable_high_rate(double anchor_period_s)
+{
+    if (d_rtk.opt.mode != PMODE_SINGLE)
+        {
+            LOG(WARNING) << "The high-rate PVT is only available in the Single positioning mode";
+            return;
+        }
+    d_high_rate_cache = std::make_unique<pntcache_t>();
+    initpntcache(d_high_rate_cache.get(), anchor_period_s);
+}
+
+
+int Rtklib_Solver::position(const obsd_t *obs, int n, const nav_t *nav)
+{
+    if (!d_high_rate_cache)
+        {
+            return rtkpos(&d_rtk, obs, n, nav);
+        }
+    // same as rtkpos in the Single mode
+    const gtime_t previous = d_rtk.sol.time;
+    char msg[128] = "";
+    if (!pntpos_hr(obs, n, nav, &d_rtk.opt, &d_rtk.sol, nullptr, d_rtk.ssat, msg, d_high_rate_cache.get()))
+        {
+            errmsg(&d_rtk, "point pos error (%s)\n", msg);
+            if (!d_rtk.opt.dynamics)
+                {
+                    outsolstat(&d_rtk);
+                    return 0;
+                }
+        }
+    if (previous.time != 0)
+        {
+            d_rtk.tt = timediff(d_rtk.sol.time, previous);
+        }
+    outsolstat(&d_rtk);
+    return 1;
+}
+
+
+bool Rtklib_Solver::get_pseudorange_rate(const Gnss_Synchro &gnss_synchro, double &rate_m_s) const
+{
+    int sys;
+    switch (gnss_synchro.System)
+        {
+        case 'G':
+            sys = SYS_GPS;
+            break;
+        case 'E':
+            sys = SYS_GAL;
+            break;
+        case 'R':
+            sys = SYS_GLO;
+            break;
+        case 'C':
+            sys = SYS_BDS;
+            break;
+        default:
+            return false;
+        }
+    const int sat = satno(sys, static_cast<int>(gnss_synchro.PRN));
+    if (!this->is_valid_position() or sat <= 0 or !d_pseudorange_rate_valid[sat - 1])
+        {
+            return false;
+        }
+    rate_m_s = d_pseudorange_rate[sat - 1];
+    return true;
+}
+
+
+void Rtklib_Solver::enable_epoch_observations()
+{
+    if (!d_epoch_nav)
+        {
+            d_epoch_nav = std::make_unique<nav_t>();
+        }
+}
+
+
+int Rtklib_Solver::get_epoch_observations(const obsd_t **obs, const nav_t **nav) const
+{
+    *obs = d_obs_data.data();
+    *nav = d_epoch_nav.get();
+    return d_epoch_observations;
+}
+
+
+void Rtklib_Solver::compute_pseudorange_rates(const nav_t &nav_data, int n)
+{
+    std::array<double, 6 * MAXOBS> rs{};
+    std::array<double, 2 * MAXOBS> dts{};
+    std::array<double, MAXOBS> var{};
+    std::array<int, MAXOBS> svh{};
+
+    d_pseudorange_rate_valid.fill(false);
+    if (!this->is_valid_position())
+        {
+            return;
+        }
+    satposs(d_obs_data[0].time, d_obs_data.data(), n, &nav_data, EPHOPT_BRDC, rs.data(), dts.data(), var.data(), svh.data());
+    const double *rr = pvt_sol.rr;  // receiver position and velocity
+    for (int i = 0; i < n; i++)
+        {
+            const double *rsi = &rs[6 * i];
+            std::array<double, 3> e{};
+            std::array<double, 3> vs{};
+            for (int j = 0; j < 3; j++)
+                {
+                    e[j] = rsi[j] - rr[j];
+                    vs[j] = rsi[j + 3] - rr[j + 3];
+                }
+            const double r = norm_rtk(e.data(), 3);
+            const int sat = d_obs_data[i].sat;
+            if (svh[i] < 0 or r <= 0.0 or sat <= 0 or sat > MAXSAT)
+                {
+                    continue;
+                }
+            for (int j = 0; j < 3; j++)
+                {
+                    e[j] /= r;
+                }
+            // range rate with earth rotation correction, as in the Doppler residuals of pntpos
+            const double rate = dot(vs.data(), e.data(), 3) + GNSS_OMEGA_EARTH_DOT / SPEED_OF_LIGHT_M_S * (rsi[4] * rr[0] + rsi[1] * rr[3] - rsi[3] * rr[1] - rsi[0] * rr[4]);
+            d_pseudorange_rate[sat - 1] = rate + pvt_sol.dtr[5] - SPEED_OF_LIGHT_M_S * dts[1 + 2 * i];
+            d_pseudorange_rate_valid[sat - 1] = true;
+        }
+}
+
+
+void Rtklib_Solver::queue_epoch(const nav_t &nav_data, int n, const Epoch_Tag &tag)
+{
+    // copy the epoch out of the lock, and then swap it with the queued one
+    Positioning_Epoch &epoch = *d_next_epoch;
+    std::copy(d_obs_data.cbegin(), d_obs_data.cbegin() + n, epoch.obs.begin());
+    std::copy(d_eph_data.cbegin(), d_eph_data.cbegin() + nav_data.n, epoch.eph.begin());
+    std::copy(d_geph_data.cbegin(), d_geph_data.cbegin() + nav_data.ng, epoch.geph.begin());
+    epoch.nav = nav_data;
+    epoch.nav.eph = epoch.eph.data();
+    epoch.nav.geph = epoch.geph.data();
+    epoch.n = n;
+    epoch.tag = tag;
+    {
+        std::lock_guard<std::mutex> lock(d_positioning_mutex);
+        if (d_epoch_queued)
+            {
+                d_skipped_epochs++;
+            }
+        std::swap(d_next_epoch, d_queued_epoch);
+        d_epoch_queued = true;
+    }
+    d_positioning_cond.notify_one();
+}
+
+
+bool Rtklib_Solver::take_result()
+{
+    std::lock_guard<std::mutex> lock(d_positioning_mutex);
+    if (!d_result_ready)
+        {
+            return false;
+        }
+    std::swap(d_ready_result, d_taken_result);
+    d_result_ready = false;
+    return true;
+}
+
+
+void Rtklib_Solver::run_positioning()
+{
+    // d_rtk is only used by this thread from now on
+    while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(d_positioning_mutex);
+                d_positioning_cond.wait(lock, [this] { return d_positioning_stop || d_epoch_queued; });
+                if (d_positioning_stop)
+                    {
+                        return;
+                    }
+                std::swap(d_queued_epoch, d_working_epoch);
+                d_epoch_queued = false;
+            }
+            Positioning_Epoch &epoch = *d_working_epoch;
+            Positioning_Result &result = *d_working_result;
+            result.status = position(epoch.obs.data(), epoch.n, &epoch.nav);
+            if (result.status == 0)
+                {
+                    LOG(INFO) << "RTKLIB rtkpos error: " << d_rtk.errbuf;
+                    d_rtk.neb = 0;  // clear error buffer to avoid repeating the error message
+                }
+            result.sol = d_rtk.sol;
+            std::copy(std::begin(d_rtk.ssat), std::end(d_rtk.ssat), result.ssat.begin());
+            result.mode = d_rtk.opt.mode;
+            result.tag = epoch.tag;
+            {
+                std::lock_guard<std::mutex> lock(d_positioning_mutex);
+                std::swap(d_working_result, d_ready_result);
+                d_result_ready = true;
+            }
+        }
+}
+
+
 bool Rtklib_Solver::save_matfile() const
 {
     // READ DUMP FILE
@@ -379,6 +705,112 @@ Monitor_Pvt Rtklib_Solver::get_monitor_pvt() const
 }
 
 
+eph_t Rtklib_Solver::rtklib_ephemeris(const Gps_Ephemeris &gps_eph)
+{
+    const int sat = static_cast<int>(gps_eph.PRN);
+    const std::array<double, 6> key{{static_cast<double>(gps_eph.WN), static_cast<double>(gps_eph.tow),
+        static_cast<double>(gps_eph.toe), static_cast<double>(gps_eph.toc),
+        static_cast<double>(gps_eph.IODE_SF2), this->is_pre_2009() ? 1.0 : 0.0}};
+    if (sat < 1 || sat > MAXSAT)
+        {
+            return eph_to_rtklib(gps_eph, this->is_pre_2009());
+        }
+    Rtklib_Eph_Cache_Entry &entry = d_eph_cache[sat];
+    if (!entry.valid || entry.key != key)
+        {
+            entry.eph = eph_to_rtklib(gps_eph, this->is_pre_2009());
+            entry.key = key;
+            entry.valid = true;
+        }
+    return entry.eph;
+}
+
+
+eph_t Rtklib_Solver::rtklib_ephemeris(const Gps_CNAV_Ephemeris &gps_cnav_eph)
+{
+    const int sat = static_cast<int>(gps_cnav_eph.PRN);
+    const std::array<double, 6> key{{static_cast<double>(gps_cnav_eph.WN), static_cast<double>(gps_cnav_eph.tow),
+        static_cast<double>(gps_cnav_eph.toe1), static_cast<double>(gps_cnav_eph.toe2),
+        static_cast<double>(gps_cnav_eph.toc), 0.0}};
+    if (sat < 1 || sat > MAXSAT)
+        {
+            return eph_to_rtklib(gps_cnav_eph);
+        }
+    Rtklib_Eph_Cache_Entry &entry = d_cnav_eph_cache[sat];
+    if (!entry.valid || entry.key != key)
+        {
+            entry.eph = eph_to_rtklib(gps_cnav_eph);
+            entry.key = key;
+            entry.valid = true;
+        }
+    return entry.eph;
+}
+
+
+eph_t Rtklib_Solver::rtklib_ephemeris(const Galileo_Ephemeris &gal_eph)
+{
+    const int sat = static_cast<int>(gal_eph.PRN + NSATGPS + NSATGLO);
+    const std::array<double, 6> key{{static_cast<double>(gal_eph.WN), static_cast<double>(gal_eph.tow),
+        static_cast<double>(gal_eph.toe), static_cast<double>(gal_eph.toc),
+        static_cast<double>(gal_eph.IOD_nav), 0.0}};
+    if (sat < 1 || sat > MAXSAT)
+        {
+            return eph_to_rtklib(gal_eph);
+        }
+    Rtklib_Eph_Cache_Entry &entry = d_eph_cache[sat];
+    if (!entry.valid || entry.key != key)
+        {
+            entry.eph = eph_to_rtklib(gal_eph);
+            entry.key = key;
+            entry.valid = true;
+        }
+    return entry.eph;
+}
+
+
+eph_t Rtklib_Solver::rtklib_ephemeris(const Beidou_Dnav_Ephemeris &bds_eph)
+{
+    const int sat = static_cast<int>(bds_eph.PRN + NSATGPS + NSATGLO + NSATGAL + NSATQZS);
+    const std::array<double, 6> key{{static_cast<double>(bds_eph.WN), static_cast<double>(bds_eph.tow),
+        static_cast<double>(bds_eph.toe), static_cast<double>(bds_eph.toc),
+        bds_eph.AODE, bds_eph.AODC}};
+    if (sat < 1 || sat > MAXSAT)
+        {
+            return eph_to_rtklib(bds_eph);
+        }
+    Rtklib_Eph_Cache_Entry &entry = d_eph_cache[sat];
+    if (!entry.valid || entry.key != key)
+        {
+            entry.eph = eph_to_rtklib(bds_eph);
+            entry.key = key;
+            entry.valid = true;
+        }
+    return entry.eph;
+}
+
+
+geph_t Rtklib_Solver::rtklib_ephemeris(const Glonass_Gnav_Ephemeris &glonass_gnav_eph, const Glonass_Gnav_Utc_Model &gnav_utc)
+{
+    const int sat = static_cast<int>(glonass_gnav_eph.i_satellite_slot_number + NSATGPS);
+    // toe and tof are converted from GLONASS time with the date and the UTC model
+    const std::array<double, 6> key{{glonass_gnav_eph.d_t_b, glonass_gnav_eph.d_t_k,
+        glonass_gnav_eph.d_N_T, glonass_gnav_eph.d_yr,
+        gnav_utc.d_tau_c, gnav_utc.d_tau_gps}};
+    if (sat < 1 || sat > MAXSAT)
+        {
+            return eph_to_rtklib(glonass_gnav_eph, gnav_utc);
+        }
+    Rtklib_Geph_Cache_Entry &entry = d_geph_cache[sat];
+    if (!entry.valid || entry.key != key)
+        {
+            entry.geph = eph_to_rtklib(glonass_gnav_eph, gnav_utc);
+            entry.key = key;
+            entry.valid = true;
+        }
+    return entry.geph;
+}
+
+
 bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_map, bool flag_averaging)
 {
     std::map<int, Gnss_Synchro>::const_iterator gnss_observables_iter;
@@ -399,8 +831,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
     int glo_valid_obs = 0;  // GLONASS L1/L2 valid observations counter
 
     d_obs_data.fill({});
-    std::vector<eph_t> eph_data(MAXOBS);
-    std::vector<geph_t> geph_data(MAXOBS);
+    d_epoch_observations = 0;
 
     // Workaround for NAV/CNAV clash problem
     bool gps_dual_band = false;
@@ -415,12 +846,12 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                 {
                 case 'G':
                     {
-                        const std::string sig_(gnss_observables_iter->second.Signal);
-                        if (sig_ == "1C")
+                        const Gnss_Signal_Id signal_id = gnss_signal_id(gnss_observables_iter->second);
+                        if (signal_id == SIGNAL_GPS_1C)
                             {
                                 band1 = true;
                             }
-                        if (sig_ == "2S")
+                        if (signal_id == SIGNAL_GPS_2S)
                             {
                                 band2 = true;
                             }
@@ -444,16 +875,16 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                 {
                 case 'E':
                     {
-                        const std::string sig_(gnss_observables_iter->second.Signal);
+                        const Gnss_Signal_Id signal_id = gnss_signal_id(gnss_observables_iter->second);
                         // Galileo E1
-                        if (sig_ == "1B")
+                        if (signal_id == SIGNAL_GAL_1B)
                             {
                                 // 1 Gal - find the ephemeris for the current GALILEO SV observation. The SV PRN ID is the map key
                                 galileo_ephemeris_iter = galileo_ephemeris_map.find(gnss_observables_iter->second.PRN);
                                 if (galileo_ephemeris_iter != galileo_ephemeris_map.cend())
                                     {
                                         // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                        eph_data[valid_obs] = eph_to_rtklib(galileo_ephemeris_iter->second);
+                                        d_eph_data[valid_obs] = rtklib_ephemeris(galileo_ephemeris_iter->second);
                                         // convert observation from GNSS-SDR class to RTKLIB structure
                                         obsd_t newobs{};
                                         d_obs_data[valid_obs + glo_valid_obs] = insert_obs_to_rtklib(newobs,
@@ -469,7 +900,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                             }
 
                         // Galileo E5
-                        if ((sig_ == "5X") || (sig_ == "7X"))
+                        if ((signal_id == SIGNAL_GAL_5X) || (signal_id == SIGNAL_GAL_7X))
                             {
                                 // 1 Gal - find the ephemeris for the current GALILEO SV observation. The SV PRN ID is the map key
                                 galileo_ephemeris_iter = galileo_ephemeris_map.find(gnss_observables_iter->second.PRN);
@@ -478,7 +909,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                         bool found_E1_obs = false;
                                         for (int i = 0; i < valid_obs; i++)
                                             {
-                                                if (eph_data[i].sat == (static_cast<int>(gnss_observables_iter->second.PRN + NSATGPS + NSATGLO)))
+                                                if (d_eph_data[i].sat == (static_cast<int>(gnss_observables_iter->second.PRN + NSATGPS + NSATGLO)))
                                                     {
                                                         d_obs_data[i + glo_valid_obs] = insert_obs_to_rtklib(d_obs_data[i + glo_valid_obs],
                                                             gnss_observables_iter->second,
@@ -492,7 +923,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                             {
                                                 // insert Galileo E5 obs as new obs and also insert its ephemeris
                                                 // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                                eph_data[valid_obs] = eph_to_rtklib(galileo_ephemeris_iter->second);
+                                                d_eph_data[valid_obs] = rtklib_ephemeris(galileo_ephemeris_iter->second);
                                                 // convert observation from GNSS-SDR class to RTKLIB structure
                                                 const auto default_code_ = static_cast<unsigned char>(CODE_NONE);
                                                 obsd_t newobs = {{0, 0}, '0', '0', {}, {},
@@ -509,7 +940,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                     {
                                         DLOG(INFO) << "No ephemeris data for SV " << gnss_observables_iter->second.PRN;
                                     }
-                                if (sig_ == "7X")
+                                if (signal_id == SIGNAL_GAL_7X)
                                     {
                                         gal_e5_is_e5b = true;
                                     }
@@ -520,14 +951,14 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                     {
                         // GPS L1
                         // 1 GPS - find the ephemeris for the current GPS SV observation. The SV PRN ID is the map key
-                        const std::string sig_(gnss_observables_iter->second.Signal);
-                        if (sig_ == "1C")
+                        const Gnss_Signal_Id signal_id = gnss_signal_id(gnss_observables_iter->second);
+                        if (signal_id == SIGNAL_GPS_1C)
                             {
                                 gps_ephemeris_iter = gps_ephemeris_map.find(gnss_observables_iter->second.PRN);
                                 if (gps_ephemeris_iter != gps_ephemeris_map.cend())
                                     {
                                         // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                        eph_data[valid_obs] = eph_to_rtklib(gps_ephemeris_iter->second, this->is_pre_2009());
+                                        d_eph_data[valid_obs] = rtklib_ephemeris(gps_ephemeris_iter->second);
                                         // convert observation from GNSS-SDR class to RTKLIB structure
                                         obsd_t newobs{};
                                         d_obs_data[valid_obs + glo_valid_obs] = insert_obs_to_rtklib(newobs,
@@ -543,7 +974,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                     }
                             }
                         // GPS L2 (todo: solve NAV/CNAV clash)
-                        if ((sig_ == "2S") and (gps_dual_band == false))
+                        if ((signal_id == SIGNAL_GPS_2S) and (gps_dual_band == false))
                             {
                                 gps_cnav_ephemeris_iter = gps_cnav_ephemeris_map.find(gnss_observables_iter->second.PRN);
                                 if (gps_cnav_ephemeris_iter != gps_cnav_ephemeris_map.cend())
@@ -557,12 +988,12 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                                 // (more precise!), and attach the L2 observation to the L1 observation in RTKLIB structure
                                                 for (int i = 0; i < valid_obs; i++)
                                                     {
-                                                        if (eph_data[i].sat == static_cast<int>(gnss_observables_iter->second.PRN))
+                                                        if (d_eph_data[i].sat == static_cast<int>(gnss_observables_iter->second.PRN))
                                                             {
-                                                                eph_data[i] = eph_to_rtklib(gps_cnav_ephemeris_iter->second);
+                                                                d_eph_data[i] = rtklib_ephemeris(gps_cnav_ephemeris_iter->second);
                                                                 d_obs_data[i + glo_valid_obs] = insert_obs_to_rtklib(d_obs_data[i + glo_valid_obs],
                                                                     gnss_observables_iter->second,
-                                                                    eph_data[i].week,
+                                                                    d_eph_data[i].week,
                                                                     1);  // Band 2 (L2)
                                                                 break;
                                                             }
@@ -573,7 +1004,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                             {
                                                 // 3. If not found, insert the GPS L2 ephemeris and the observation
                                                 // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                                eph_data[valid_obs] = eph_to_rtklib(gps_cnav_ephemeris_iter->second);
+                                                d_eph_data[valid_obs] = rtklib_ephemeris(gps_cnav_ephemeris_iter->second);
                                                 // convert observation from GNSS-SDR class to RTKLIB structure
                                                 const auto default_code_ = static_cast<unsigned char>(CODE_NONE);
                                                 obsd_t newobs = {{0, 0}, '0', '0', {}, {},
@@ -592,7 +1023,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                     }
                             }
                         // GPS L5
-                        if (sig_ == "L5")
+                        if (signal_id == SIGNAL_GPS_L5)
                             {
                                 gps_cnav_ephemeris_iter = gps_cnav_ephemeris_map.find(gnss_observables_iter->second.PRN);
                                 if (gps_cnav_ephemeris_iter != gps_cnav_ephemeris_map.cend())
@@ -605,9 +1036,9 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                                 // (more precise!), and attach the L5 observation to the L1 observation in RTKLIB structure
                                                 for (int i = 0; i < valid_obs; i++)
                                                     {
-                                                        if (eph_data[i].sat == static_cast<int>(gnss_observables_iter->second.PRN))
+                                                        if (d_eph_data[i].sat == static_cast<int>(gnss_observables_iter->second.PRN))
                                                             {
-                                                                eph_data[i] = eph_to_rtklib(gps_cnav_ephemeris_iter->second);
+                                                                d_eph_data[i] = rtklib_ephemeris(gps_cnav_ephemeris_iter->second);
                                                                 d_obs_data[i + glo_valid_obs] = insert_obs_to_rtklib(d_obs_data[i],
                                                                     gnss_observables_iter->second,
                                                                     gps_cnav_ephemeris_iter->second.WN,
@@ -620,7 +1051,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                             {
                                                 // 3. If not found, insert the GPS L5 ephemeris and the observation
                                                 // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                                eph_data[valid_obs] = eph_to_rtklib(gps_cnav_ephemeris_iter->second);
+                                                d_eph_data[valid_obs] = rtklib_ephemeris(gps_cnav_ephemeris_iter->second);
                                                 // convert observation from GNSS-SDR class to RTKLIB structure
                                                 const auto default_code_ = static_cast<unsigned char>(CODE_NONE);
                                                 obsd_t newobs = {{0, 0}, '0', '0', {}, {},
@@ -642,16 +1073,16 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                     }
                 case 'R':  // TODO This should be using rtk lib nomenclature
                     {
-                        const std::string sig_(gnss_observables_iter->second.Signal);
+                        const Gnss_Signal_Id signal_id = gnss_signal_id(gnss_observables_iter->second);
                         // GLONASS GNAV L1
-                        if (sig_ == "1G")
+                        if (signal_id == SIGNAL_GLO_1G)
                             {
                                 // 1 Glo - find the ephemeris for the current GLONASS SV observation. The SV Slot Number (PRN ID) is the map key
                                 glonass_gnav_ephemeris_iter = glonass_gnav_ephemeris_map.find(gnss_observables_iter->second.PRN);
                                 if (glonass_gnav_ephemeris_iter != glonass_gnav_ephemeris_map.cend())
                                     {
                                         // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                        geph_data[glo_valid_obs] = eph_to_rtklib(glonass_gnav_ephemeris_iter->second, gnav_utc);
+                                        d_geph_data[glo_valid_obs] = rtklib_ephemeris(glonass_gnav_ephemeris_iter->second, gnav_utc);
                                         // convert observation from GNSS-SDR class to RTKLIB structure
                                         obsd_t newobs{};
                                         d_obs_data[valid_obs + glo_valid_obs] = insert_obs_to_rtklib(newobs,
@@ -666,7 +1097,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                     }
                             }
                         // GLONASS GNAV L2
-                        if (sig_ == "2G")
+                        if (signal_id == SIGNAL_GLO_2G)
                             {
                                 // 1 GLONASS - find the ephemeris for the current GLONASS SV observation. The SV PRN ID is the map key
                                 glonass_gnav_ephemeris_iter = glonass_gnav_ephemeris_map.find(gnss_observables_iter->second.PRN);
@@ -675,7 +1106,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                         bool found_L1_obs = false;
                                         for (int i = 0; i < glo_valid_obs; i++)
                                             {
-                                                if (geph_data[i].sat == (static_cast<int>(gnss_observables_iter->second.PRN + NSATGPS)))
+                                                if (d_geph_data[i].sat == (static_cast<int>(gnss_observables_iter->second.PRN + NSATGPS)))
                                                     {
                                                         d_obs_data[i + valid_obs] = insert_obs_to_rtklib(d_obs_data[i + valid_obs],
                                                             gnss_observables_iter->second,
@@ -689,7 +1120,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                             {
                                                 // insert GLONASS GNAV L2 obs as new obs and also insert its ephemeris
                                                 // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                                geph_data[glo_valid_obs] = eph_to_rtklib(glonass_gnav_ephemeris_iter->second, gnav_utc);
+                                                d_geph_data[glo_valid_obs] = rtklib_ephemeris(glonass_gnav_ephemeris_iter->second, gnav_utc);
                                                 // convert observation from GNSS-SDR class to RTKLIB structure
                                                 obsd_t newobs{};
                                                 d_obs_data[valid_obs + glo_valid_obs] = insert_obs_to_rtklib(newobs,
@@ -710,14 +1141,14 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                     {
                         // BEIDOU B1I
                         //  - find the ephemeris for the current BEIDOU SV observation. The SV PRN ID is the map key
-                        const std::string sig_(gnss_observables_iter->second.Signal);
-                        if (sig_ == "B1")
+                        const Gnss_Signal_Id signal_id = gnss_signal_id(gnss_observables_iter->second);
+                        if (signal_id == SIGNAL_BDS_B1)
                             {
                                 beidou_ephemeris_iter = beidou_dnav_ephemeris_map.find(gnss_observables_iter->second.PRN);
                                 if (beidou_ephemeris_iter != beidou_dnav_ephemeris_map.cend())
                                     {
                                         // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                        eph_data[valid_obs] = eph_to_rtklib(beidou_ephemeris_iter->second);
+                                        d_eph_data[valid_obs] = rtklib_ephemeris(beidou_ephemeris_iter->second);
                                         // convert observation from GNSS-SDR class to RTKLIB structure
                                         obsd_t newobs{};
                                         d_obs_data[valid_obs + glo_valid_obs] = insert_obs_to_rtklib(newobs,
@@ -732,7 +1163,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                     }
                             }
                         // BeiDou B3
-                        if (sig_ == "B3")
+                        if (signal_id == SIGNAL_BDS_B3)
                             {
                                 beidou_ephemeris_iter = beidou_dnav_ephemeris_map.find(gnss_observables_iter->second.PRN);
                                 if (beidou_ephemeris_iter != beidou_dnav_ephemeris_map.cend())
@@ -740,7 +1171,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                         bool found_B1I_obs = false;
                                         for (int i = 0; i < valid_obs; i++)
                                             {
-                                                if (eph_data[i].sat == (static_cast<int>(gnss_observables_iter->second.PRN + NSATGPS + NSATGLO + NSATGAL + NSATQZS)))
+                                                if (d_eph_data[i].sat == (static_cast<int>(gnss_observables_iter->second.PRN + NSATGPS + NSATGLO + NSATGAL + NSATQZS)))
                                                     {
                                                         d_obs_data[i + glo_valid_obs] = insert_obs_to_rtklib(d_obs_data[i + glo_valid_obs],
                                                             gnss_observables_iter->second,
@@ -754,7 +1185,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                             {
                                                 // insert BeiDou B3I obs as new obs and also insert its ephemeris
                                                 // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                                eph_data[valid_obs] = eph_to_rtklib(beidou_ephemeris_iter->second);
+                                                d_eph_data[valid_obs] = rtklib_ephemeris(beidou_ephemeris_iter->second);
                                                 // convert observation from GNSS-SDR class to RTKLIB structure
                                                 const auto default_code_ = static_cast<unsigned char>(CODE_NONE);
                                                 obsd_t newobs = {{0, 0}, '0', '0', {}, {},
@@ -788,10 +1219,9 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
     this->set_valid_position(false);
     if ((valid_obs + glo_valid_obs) > 3)
         {
-            int result = 0;
             nav_t nav_data{};
-            nav_data.eph = eph_data.data();
-            nav_data.geph = geph_data.data();
+            nav_data.eph = d_eph_data.data();
+            nav_data.geph = d_geph_data.data();
             nav_data.n = valid_obs;
             nav_data.ng = glo_valid_obs;
             if (gps_iono.valid)
@@ -891,243 +1321,278 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                         }
                 }
 
-            result = rtkpos(&d_rtk, d_obs_data.data(), valid_obs + glo_valid_obs, &nav_data);
-
-            if (result == 0)
+            if (d_epoch_nav)
                 {
-                    LOG(INFO) << "RTKLIB rtkpos error: " << d_rtk.errbuf;
-                    d_rtk.neb = 0;                 // clear error buffer to avoid repeating the error message
-                    this->set_time_offset_s(0.0);  // reset rx time estimation
-                    this->set_num_valid_observations(0);
+                    *d_epoch_nav = nav_data;
+                    d_epoch_observations = valid_obs + glo_valid_obs;
                 }
-            else
+            Epoch_Tag tag;
+            tag.rx_time = gnss_observables_map.cbegin()->second.RX_time;
+            tag.tow_ms = gnss_observables_map.cbegin()->second.TOW_at_current_symbol_ms;
+            tag.week = nav_data.eph[0].week;
+            if (d_positioning_thread.joinable())
                 {
-                    this->set_num_valid_observations(d_rtk.sol.ns);  // record the number of valid satellites used by the PVT solver
-                    pvt_sol = d_rtk.sol;
-                    // DOP computation
-                    unsigned int used_sats = 0;
-                    for (unsigned int i = 0; i < MAXSAT; i++)
+                    queue_epoch(nav_data, valid_obs + glo_valid_obs, tag);
+                    if (take_result())
                         {
-                            pvt_ssat[i] = d_rtk.ssat[i];
-                            if (d_rtk.ssat[i].vs == 1)
-                                {
-                                    used_sats++;
-                                }
-                        }
-
-                    std::vector<double> azel(used_sats * 2);
-                    int index_aux = 0;
-                    for (auto &i : d_rtk.ssat)
-                        {
-                            if (i.vs == 1)
-                                {
-                                    azel[2 * index_aux] = i.azel[0];
-                                    azel[2 * index_aux + 1] = i.azel[1];
-                                    index_aux++;
-                                }
+                            const Positioning_Result &result = *d_taken_result;
+                            update_solution(result.status, result.sol, result.ssat.data(), result.mode, result.tag);
                         }
-
-                    if (index_aux > 0)
-                        {
-                            dops(index_aux, azel.data(), 0.0, d_dop.data());
-                        }
-                    this->set_valid_position(true);
-                    std::array<double, 4> rx_position_and_time{};
-                    rx_position_and_time[0] = pvt_sol.rr[0];  // [m]
-                    rx_position_and_time[1] = pvt_sol.rr[1];  // [m]
-                    rx_position_and_time[2] = pvt_sol.rr[2];  // [m]
-                    // todo: fix this ambiguity in the RTKLIB units in receiver clock offset!
-                    if (d_rtk.opt.mode == PMODE_SINGLE)
-                        {
-                            // if the RTKLIB solver is set to SINGLE, the dtr is already expressed in [s]
-                            // add also the clock offset from gps to galileo (pvt_sol.dtr[2])
-                            rx_position_and_time[3] = pvt_sol.dtr[0] + pvt_sol.dtr[2];
-                        }
-                    else
+                }
+            else
+                {
+                    const int result = position(d_obs_data.data(), valid_obs + glo_valid_obs, &nav_data);
+                    if (result == 0)
                         {
-                            // the receiver clock offset is expressed in [meters], so we convert it into [s]
-                            // add also the clock offset from gps to galileo (pvt_sol.dtr[2])
-                            rx_position_and_time[3] = pvt_sol.dtr[2] + pvt_sol.dtr[0] / SPEED_OF_LIGHT_M_S;
+                            LOG(INFO) << "RTKLIB rtkpos error: " << d_rtk.errbuf;
+                            d_rtk.neb = 0;  // clear error buffer to avoid repeating the error message
                         }
-                    this->set_rx_pos({rx_position_and_time[0], rx_position_and_time[1], rx_position_and_time[2]});  // save ECEF position for the next iteration
-
-                    // compute Ground speed and COG
-                    double ground_speed_ms = 0.0;
-                    std::array<double, 3> pos{};
-                    std::array<double, 3> enuv{};
-                    ecef2pos(pvt_sol.rr, pos.data());
-                    ecef2enu(pos.data(), &pvt_sol.rr[3], enuv.data());
-                    this->set_speed_over_ground(norm_rtk(enuv.data(), 2));
-                    double new_cog;
-                    if (ground_speed_ms >= 1.0)
+                    update_solution(result, d_rtk.sol, d_rtk.ssat, d_rtk.opt.mode, tag);
+                    if (d_compute_pseudorange_rates)
                         {
-                            new_cog = atan2(enuv[0], enuv[1]) * R2D;
-                            if (new_cog < 0.0)
-                                {
-                                    new_cog += 360.0;
-                                }
-                            this->set_course_over_ground(new_cog);
+                            compute_pseudorange_rates(nav_data, valid_obs + glo_valid_obs);
                         }
+                }
+        }
+    return this->is_valid_position();
+}
 
-                    this->set_time_offset_s(rx_position_and_time[3]);
-
-                    DLOG(INFO) << "RTKLIB Position at RX TOW = " << gnss_observables_map.cbegin()->second.RX_time
-                               << " in ECEF (X,Y,Z,t[meters]) = " << rx_position_and_time[0] << ", " << rx_position_and_time[1] << ", " << rx_position_and_time[2] << ", " << rx_position_and_time[3];
 
-                    // gtime_t rtklib_utc_time = gpst2utc(pvt_sol.time); // Corrected RX Time (Non integer multiply of 1 ms of granularity)
-                    // Uncorrected RX Time (integer multiply of 1 ms and the same observables time reported in RTCM and RINEX)
-                    const gtime_t rtklib_time = timeadd(pvt_sol.time, rx_position_and_time[3]);  // uncorrected rx time
-                    const gtime_t rtklib_utc_time = gpst2utc(rtklib_time);
-                    boost::posix_time::ptime p_time = boost::posix_time::from_time_t(rtklib_utc_time.time);
-                    p_time += boost::posix_time::microseconds(static_cast<long>(round(rtklib_utc_time.sec * 1e6)));  // NOLINT(google-runtime-int)
+void Rtklib_Solver::update_solution(int status, const sol_t &sol, const ssat_t *ssat, int mode, const Epoch_Tag &tag)
+{
+    if (status == 0)
+        {
+            this->set_valid_position(false);
+            this->set_time_offset_s(0.0);  // reset rx time estimation
+            this->set_num_valid_observations(0);
+            return;
+        }
+    this->set_num_valid_observations(sol.ns);  // record the number of valid satellites used by the PVT solver
+    pvt_sol = sol;
+    // DOP computation
+    unsigned int used_sats = 0;
+    for (unsigned int i = 0; i < MAXSAT; i++)
+        {
+            pvt_ssat[i] = ssat[i];
+            if (ssat[i].vs == 1)
+                {
+                    used_sats++;
+                }
+        }
 
-                    this->set_position_UTC_time(p_time);
+    std::vector<double> azel(used_sats * 2);
+    int index_aux = 0;
+    for (const auto &i : pvt_ssat)
+        {
+            if (i.vs == 1)
+                {
+                    azel[2 * index_aux] = i.azel[0];
+                    azel[2 * index_aux + 1] = i.azel[1];
+                    index_aux++;
+                }
+        }
 
-                    DLOG(INFO) << "RTKLIB Position at " << boost::posix_time::to_simple_string(p_time)
-                               << " is Lat = " << this->get_latitude() << " [deg], Long = " << this->get_longitude()
-                               << " [deg], Height= " << this->get_height() << " [m]"
-                               << " RX time offset= " << this->get_time_offset_s() << " [s]";
+    if (index_aux > 0)
+        {
+            dops(index_aux, azel.data(), 0.0, d_dop.data());
+        }
+    this->set_valid_position(true);
+    std::array<double, 4> rx_position_and_time{};
+    rx_position_and_time[0] = pvt_sol.rr[0];  // [m]
+    rx_position_and_time[1] = pvt_sol.rr[1];  // [m]
+    rx_position_and_time[2] = pvt_sol.rr[2];  // [m]
+    // todo: fix this ambiguity in the RTKLIB units in receiver clock offset!
+    if (mode == PMODE_SINGLE)
+        {
+            // if the RTKLIB solver is set to SINGLE, the dtr is already expressed in [s]
+            // add also the clock offset from gps to galileo (pvt_sol.dtr[2])
+            rx_position_and_time[3] = pvt_sol.dtr[0] + pvt_sol.dtr[2];
+        }
+    else
+        {
+            // the receiver clock offset is expressed in [meters], so we convert it into [s]
+            // add also the clock offset from gps to galileo (pvt_sol.dtr[2])
+            rx_position_and_time[3] = pvt_sol.dtr[2] + pvt_sol.dtr[0] / SPEED_OF_LIGHT_M_S;
+        }
+    this->set_rx_pos({rx_position_and_time[0], rx_position_and_time[1], rx_position_and_time[2]});  // save ECEF position for the next iteration
+
+    // compute Ground speed and COG
+    double ground_speed_ms = 0.0;
+    std::array<double, 3> pos{};
+    std::array<double, 3> enuv{};
+    ecef2pos(pvt_sol.rr, pos.data());
+    ecef2enu(pos.data(), &pvt_sol.rr[3], enuv.data());
+    this->set_speed_over_ground(norm_rtk(enuv.data(), 2));
+    double new_cog;
+    if (ground_speed_ms >= 1.0)
+        {
+            new_cog = atan2(enuv[0], enuv[1]) * R2D;
+            if (new_cog < 0.0)
+                {
+                    new_cog += 360.0;
+                }
+            this->set_course_over_ground(new_cog);
+        }
 
-                    // ######## PVT MONITOR #########
+    this->set_time_offset_s(rx_position_and_time[3]);
+
+    DLOG(INFO) << "RTKLIB Position at RX TOW = " << tag.rx_time
+               << " in ECEF (X,Y,Z,t[meters]) = " << rx_position_and_time[0] << ", " << rx_position_and_time[1] << ", " << rx_position_and_time[2] << ", " << rx_position_and_time[3];
+
+    // gtime_t rtklib_utc_time = gpst2utc(pvt_sol.time); // Corrected RX Time (Non integer multiply of 1 ms of granularity)
+    // Uncorrected RX Time (integer multiply of 1 ms and the same observables time reported in RTCM and RINEX)
+    const gtime_t rtklib_time = timeadd(pvt_sol.time, rx_position_and_time[3]);  // uncorrected rx time
+    const gtime_t rtklib_utc_time = gpst2utc(rtklib_time);
+    boost::posix_time::ptime p_time = boost::posix_time::from_time_t(rtklib_utc_time.time);
+    p_time += boost::posix_time::microseconds(static_cast<long>(round(rtklib_utc_time.sec * 1e6)));  // NOLINT(google-runtime-int)
+
+    this->set_position_UTC_time(p_time);
+
+    DLOG(INFO) << "RTKLIB Position at " << boost::posix_time::to_simple_string(p_time)
+               << " is Lat = " << this->get_latitude() << " [deg], Long = " << this->get_longitude()
+               << " [deg], Height= " << this->get_height() << " [m]"
+               << " RX time offset= " << this->get_time_offset_s() << " [s]";
+
+    // ######## PVT MONITOR #########
+    // TOW
+    d_monitor_pvt.TOW_at_current_symbol_ms = tag.tow_ms;
+    // WEEK
+    d_monitor_pvt.week = adjgpsweek(tag.week, this->is_pre_2009());
+    // PVT GPS time
+    d_monitor_pvt.RX_time = tag.rx_time;
+    // User clock offset [s]
+    d_monitor_pvt.user_clk_offset = rx_position_and_time[3];
+
+    // ECEF POS X,Y,X [m] + ECEF VEL X,Y,X [m/s] (6 x double)
+    d_monitor_pvt.pos_x = pvt_sol.rr[0];
+    d_monitor_pvt.pos_y = pvt_sol.rr[1];
+    d_monitor_pvt.pos_z = pvt_sol.rr[2];
+    d_monitor_pvt.vel_x = pvt_sol.rr[3];
+    d_monitor_pvt.vel_y = pvt_sol.rr[4];
+    d_monitor_pvt.vel_z = pvt_sol.rr[5];
+
+    // position variance/covariance (m^2) {c_xx,c_yy,c_zz,c_xy,c_yz,c_zx} (6 x double)
+    d_monitor_pvt.cov_xx = pvt_sol.qr[0];
+    d_monitor_pvt.cov_yy = pvt_sol.qr[1];
+    d_monitor_pvt.cov_zz = pvt_sol.qr[2];
+    d_monitor_pvt.cov_xy = pvt_sol.qr[3];
+    d_monitor_pvt.cov_yz = pvt_sol.qr[4];
+    d_monitor_pvt.cov_zx = pvt_sol.qr[5];
+
+    // GEO user position Latitude [deg]
+    d_monitor_pvt.latitude = this->get_latitude();
+    // GEO user position Longitude [deg]
+    d_monitor_pvt.longitude = this->get_longitude();
+    // GEO user position Height [m]
+    d_monitor_pvt.height = this->get_height();
+
+    // NUMBER OF VALID SATS
+    d_monitor_pvt.valid_sats = pvt_sol.ns;
+    // RTKLIB solution status
+    d_monitor_pvt.solution_status = pvt_sol.stat;
+    // RTKLIB solution type (0:xyz-ecef,1:enu-baseline)
+    d_monitor_pvt.solution_type = pvt_sol.type;
+    // AR ratio factor for validation
+    d_monitor_pvt.AR_ratio_factor = pvt_sol.ratio;
+    // AR ratio threshold for validation
+    d_monitor_pvt.AR_ratio_threshold = pvt_sol.thres;
+
+    // GDOP / PDOP/ HDOP/ VDOP
+    d_monitor_pvt.gdop = d_dop[0];
+    d_monitor_pvt.pdop = d_dop[1];
+    d_monitor_pvt.hdop = d_dop[2];
+    d_monitor_pvt.vdop = d_dop[3];
+
+    this->set_rx_vel({enuv[0], enuv[1], enuv[2]});
+
+    const double clock_drift_ppm = pvt_sol.dtr[5] / SPEED_OF_LIGHT_M_S * 1e6;
+
+    this->set_clock_drift_ppm(clock_drift_ppm);
+    // User clock drift [ppm]
+    d_monitor_pvt.user_clk_drift_ppm = clock_drift_ppm;
+    d_monitor_pvt.latency_ms = 0.0;
+    d_monitor_pvt.skipped_epochs = 0;
+
+    // ######## LOG FILE #########
+    if (d_flag_dump_enabled == true)
+        {
+            // MULTIPLEXED FILE RECORDING - Record results to file
+            try
+                {
+                    double tmp_double;
+                    uint32_t tmp_uint32;
                     // TOW
-                    d_monitor_pvt.TOW_at_current_symbol_ms = gnss_observables_map.cbegin()->second.TOW_at_current_symbol_ms;
+                    tmp_uint32 = tag.tow_ms;
+                    d_dump_file.write(reinterpret_cast<char *>(&tmp_uint32), sizeof(uint32_t));
                     // WEEK
-                    d_monitor_pvt.week = adjgpsweek(nav_data.eph[0].week, this->is_pre_2009());
+                    tmp_uint32 = adjgpsweek(tag.week, this->is_pre_2009());
+                    d_dump_file.write(reinterpret_cast<char *>(&tmp_uint32), sizeof(uint32_t));
                     // PVT GPS time
-                    d_monitor_pvt.RX_time = gnss_observables_map.cbegin()->second.RX_time;
+                    tmp_double = tag.rx_time;
+                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
                     // User clock offset [s]
-                    d_monitor_pvt.user_clk_offset = rx_position_and_time[3];
+                    tmp_double = rx_position_and_time[3];
+                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
 
                     // ECEF POS X,Y,X [m] + ECEF VEL X,Y,X [m/s] (6 x double)
-                    d_monitor_pvt.pos_x = pvt_sol.rr[0];
-                    d_monitor_pvt.pos_y = pvt_sol.rr[1];
-                    d_monitor_pvt.pos_z = pvt_sol.rr[2];
-                    d_monitor_pvt.vel_x = pvt_sol.rr[3];
-                    d_monitor_pvt.vel_y = pvt_sol.rr[4];
-                    d_monitor_pvt.vel_z = pvt_sol.rr[5];
+                    tmp_double = pvt_sol.rr[0];
+                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
+                    tmp_double = pvt_sol.rr[1];
+                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
+                    tmp_double = pvt_sol.rr[2];
+                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
+                    tmp_double = pvt_sol.rr[3];
+                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
+                    tmp_double = pvt_sol.rr[4];
+                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
+                    tmp_double = pvt_sol.rr[5];
+                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
 
                     // position variance/covariance (m^2) {c_xx,c_yy,c_zz,c_xy,c_yz,c_zx} (6 x double)
-                    d_monitor_pvt.cov_xx = pvt_sol.qr[0];
-                    d_monitor_pvt.cov_yy = pvt_sol.qr[1];
-                    d_monitor_pvt.cov_zz = pvt_sol.qr[2];
-                    d_monitor_pvt.cov_xy = pvt_sol.qr[3];
-                    d_monitor_pvt.cov_yz = pvt_sol.qr[4];
-                    d_monitor_pvt.cov_zx = pvt_sol.qr[5];
+                    tmp_double = pvt_sol.qr[0];
+                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
+                    tmp_double = pvt_sol.qr[1];
+                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
+                    tmp_double = pvt_sol.qr[2];
+                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
+                    tmp_double = pvt_sol.qr[3];
+                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
+                    tmp_double = pvt_sol.qr[4];
+                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
+                    tmp_double = pvt_sol.qr[5];
+                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
 
                     // GEO user position Latitude [deg]
-                    d_monitor_pvt.latitude = this->get_latitude();
+                    tmp_double = this->get_latitude();
+                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
                     // GEO user position Longitude [deg]
-                    d_monitor_pvt.longitude = this->get_longitude();
+                    tmp_double = this->get_longitude();
+                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
                     // GEO user position Height [m]
-                    d_monitor_pvt.height = this->get_height();
+                    tmp_double = this->get_height();
+                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
 
                     // NUMBER OF VALID SATS
-                    d_monitor_pvt.valid_sats = pvt_sol.ns;
+                    d_dump_file.write(reinterpret_cast<char *>(&pvt_sol.ns), sizeof(uint8_t));
                     // RTKLIB solution status
-                    d_monitor_pvt.solution_status = pvt_sol.stat;
+                    d_dump_file.write(reinterpret_cast<char *>(&pvt_sol.stat), sizeof(uint8_t));
                     // RTKLIB solution type (0:xyz-ecef,1:enu-baseline)
-                    d_monitor_pvt.solution_type = pvt_sol.type;
+                    d_dump_file.write(reinterpret_cast<char *>(&pvt_sol.type), sizeof(uint8_t));
                     // AR ratio factor for validation
-                    d_monitor_pvt.AR_ratio_factor = pvt_sol.ratio;
+                    d_dump_file.write(reinterpret_cast<char *>(&pvt_sol.ratio), sizeof(float));
                     // AR ratio threshold for validation
-                    d_monitor_pvt.AR_ratio_threshold = pvt_sol.thres;
-
-                    // GDOP / PDOP/ HDOP/ VDOP
-                    d_monitor_pvt.gdop = d_dop[0];
-                    d_monitor_pvt.pdop = d_dop[1];
-                    d_monitor_pvt.hdop = d_dop[2];
-                    d_monitor_pvt.vdop = d_dop[3];
+                    d_dump_file.write(reinterpret_cast<char *>(&pvt_sol.thres), sizeof(float));
 
-                    this->set_rx_vel({enuv[0], enuv[1], enuv[2]});
-
-                    const double clock_drift_ppm = pvt_sol.dtr[5] / SPEED_OF_LIGHT_M_S * 1e6;
-
-                    this->set_clock_drift_ppm(clock_drift_ppm);
-                    // User clock drift [ppm]
-                    d_monitor_pvt.user_clk_drift_ppm = clock_drift_ppm;
-
-                    // ######## LOG FILE #########
-                    if (d_flag_dump_enabled == true)
-                        {
-                            // MULTIPLEXED FILE RECORDING - Record results to file
-                            try
-                                {
-                                    double tmp_double;
-                                    uint32_t tmp_uint32;
-                                    // TOW
-                                    tmp_uint32 = gnss_observables_map.cbegin()->second.TOW_at_current_symbol_ms;
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_uint32), sizeof(uint32_t));
-                                    // WEEK
-                                    tmp_uint32 = adjgpsweek(nav_data.eph[0].week, this->is_pre_2009());
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_uint32), sizeof(uint32_t));
-                                    // PVT GPS time
-                                    tmp_double = gnss_observables_map.cbegin()->second.RX_time;
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    // User clock offset [s]
-                                    tmp_double = rx_position_and_time[3];
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-
-                                    // ECEF POS X,Y,X [m] + ECEF VEL X,Y,X [m/s] (6 x double)
-                                    tmp_double = pvt_sol.rr[0];
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = pvt_sol.rr[1];
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = pvt_sol.rr[2];
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = pvt_sol.rr[3];
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = pvt_sol.rr[4];
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = pvt_sol.rr[5];
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-
-                                    // position variance/covariance (m^2) {c_xx,c_yy,c_zz,c_xy,c_yz,c_zx} (6 x double)
-                                    tmp_double = pvt_sol.qr[0];
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = pvt_sol.qr[1];
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = pvt_sol.qr[2];
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = pvt_sol.qr[3];
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = pvt_sol.qr[4];
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = pvt_sol.qr[5];
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-
-                                    // GEO user position Latitude [deg]
-                                    tmp_double = this->get_latitude();
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    // GEO user position Longitude [deg]
-                                    tmp_double = this->get_longitude();
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    // GEO user position Height [m]
-                                    tmp_double = this->get_height();
-                                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-
-                                    // NUMBER OF VALID SATS
-                                    d_dump_file.write(reinterpret_cast<char *>(&pvt_sol.ns), sizeof(uint8_t));
-                                    // RTKLIB solution status
-                                    d_dump_file.write(reinterpret_cast<char *>(&pvt_sol.stat), sizeof(uint8_t));
-                                    // RTKLIB solution type (0:xyz-ecef,1:enu-baseline)
-                                    d_dump_file.write(reinterpret_cast<char *>(&pvt_sol.type), sizeof(uint8_t));
-                                    // AR ratio factor for validation
-                                    d_dump_file.write(reinterpret_cast<char *>(&pvt_sol.ratio), sizeof(float));
-                                    // AR ratio threshold for validation
-                                    d_dump_file.write(reinterpret_cast<char *>(&pvt_sol.thres), sizeof(float));
-
-                                    // GDOP / PDOP / HDOP / VDOP
-                                    d_dump_file.write(reinterpret_cast<char *>(&d_dop[0]), sizeof(double));
-                                    d_dump_file.write(reinterpret_cast<char *>(&d_dop[1]), sizeof(double));
-                                    d_dump_file.write(reinterpret_cast<char *>(&d_dop[2]), sizeof(double));
-                                    d_dump_file.write(reinterpret_cast<char *>(&d_dop[3]), sizeof(double));
-                                }
-                            catch (const std::ifstream::failure &e)
-                                {
-                                    LOG(WARNING) << "Exception writing RTKLIB dump file " << e.what();
-                                }
-                        }
+                    // GDOP / PDOP / HDOP / VDOP
+                    d_dump_file.write(reinterpret_cast<char *>(&d_dop[0]), sizeof(double));
+                    d_dump_file.write(reinterpret_cast<char *>(&d_dop[1]), sizeof(double));
+                    d_dump_file.write(reinterpret_cast<char *>(&d_dop[2]), sizeof(double));
+                    d_dump_file.write(reinterpret_cast<char *>(&d_dop[3]), sizeof(double));
+                }
+            catch (const std::ifstream::failure &e)
+                {
+                    LOG(WARNING) << "Exception writing RTKLIB dump file " << e.what();
                 }
         }
-    return this->is_valid_position();
 }
+
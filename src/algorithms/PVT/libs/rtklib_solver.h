@@ -57,10 +57,17 @@
 #include "monitor_pvt.h"
 #include "pvt_solution.h"
 #include "rtklib.h"
+#include "rtklib_pntpos.h"
 #include <array>
+#include <condition_variable>
+#include <cstdint>
 #include <fstream>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 /** \addtogroup PVT
  * \{ */
@@ -70,25 +77,13 @@
 
 
 /*!
- * \brief This class implements a PVT solution based on RTKLIB
+ * \brief Navigation data used by the PVT solutions. A store can be shared by
+ * several solvers, e.g. by the internal and the user solvers of the PVT
+ * block, which then see each update at once.
  */
-class Rtklib_Solver : public Pvt_Solution
+class Rtklib_Nav_Data
 {
 public:
-    Rtklib_Solver(const rtk_t& rtk, const std::string& dump_filename, bool flag_dump_to_file, bool flag_dump_to_mat);
-    ~Rtklib_Solver();
-
-    bool get_PVT(const std::map<int, Gnss_Synchro>& gnss_observables_map, bool flag_averaging);
-
-    double get_hdop() const override;
-    double get_vdop() const override;
-    double get_pdop() const override;
-    double get_gdop() const override;
-    Monitor_Pvt get_monitor_pvt() const;
-
-    sol_t pvt_sol{};
-    std::array<ssat_t, MAXSAT> pvt_ssat{};
-
     std::map<int, Galileo_Ephemeris> galileo_ephemeris_map;            //!< Map storing new Galileo_Ephemeris
     std::map<int, Gps_Ephemeris> gps_ephemeris_map;                    //!< Map storing new GPS_Ephemeris
     std::map<int, Gps_CNAV_Ephemeris> gps_cnav_ephemeris_map;          //!< Map storing new GPS_CNAV_Ephemeris
@@ -112,18 +107,236 @@ public:
     Beidou_Dnav_Utc_Model beidou_dnav_utc_model;
     Beidou_Dnav_Iono beidou_dnav_iono;
     std::map<int, Beidou_Dnav_Almanac> beidou_dnav_almanac_map;
+};
+
+
+/*!
+ * \brief This class implements a PVT solution based on RTKLIB
+ */
+class Rtklib_Solver : public Pvt_Solution
+{
+public:
+    /*!
+     * \brief The solver keeps its navigation data in nav_data, if given, so
+     * that several solvers can share a store. A new store is made otherwise.
+     */
+    Rtklib_Solver(const rtk_t& rtk, const std::string& dump_filename, bool flag_dump_to_file, bool flag_dump_to_mat, std::shared_ptr<Rtklib_Nav_Data> nav_data = nullptr);
+    ~Rtklib_Solver();
+
+    std::shared_ptr<Rtklib_Nav_Data> get_nav_data() const;  //!< Store of the navigation data of the solver
+
+    bool get_PVT(const std::map<int, Gnss_Synchro>& gnss_observables_map, bool flag_averaging);
+
+    /*!
+     * \brief Runs the RTKLIB positioning in a thread of its own, so that slow
+     * epochs (e.g. in PPP modes) do not stall the caller. get_PVT() then
+     * queues a snapshot of the observations and the navigation data, and
+     * returns true only if a new solution was computed since the previous
+     * call. If the thread is busy, the queued epoch is replaced by the newer
+     * one.
+     */
+    void enable_decoupled_positioning();
+
+    uint64_t get_skipped_epochs() const;  //!< Number of epochs replaced before the positioning thread processed them
+
+    /*!
+     * \brief Computes, at each epoch with a valid position, the pseudorange
+     * rate predicted for each observed satellite, for the aiding of the
+     * tracking loops. Not available with decoupled positioning.
+     */
+    void enable_pseudorange_rates();
+
+    /*!
+     * \brief Computes the Single positions for high output rates: the
+     * satellite positions, clocks and atmospheric corrections of each
+     * satellite are computed once every anchor_period_s seconds, and
+     * extrapolated in between, and the least squares start from the
+     * previous solution (see pntpos_hr). No effect out of the Single mode.
+     */
+    void enable_high_rate(double anchor_period_s);
+
+    /*!
+     * \brief Gets the pseudorange rate (line-of-sight range rate plus the
+     * receiver and satellite clock drifts) predicted for the satellite of
+     * gnss_synchro at the last epoch. Returns false if it is not available.
+     */
+    bool get_pseudorange_rate(const Gnss_Synchro& gnss_synchro, double& rate_m_s) const;
+
+    /*!
+     * \brief Keeps the observations and the navigation data given to the
+     * positioning at each call to get_PVT(), e.g. for the baselines to
+     * other antennas (see get_epoch_observations)
+     */
+    void enable_epoch_observations();
+
+    /*!
+     * \brief Gets the observations and the navigation data of the last call
+     * to get_PVT(). Returns the number of observations, 0 if the epoch had
+     * not enough of them or enable_epoch_observations() was not called.
+     */
+    int get_epoch_observations(const obsd_t** obs, const nav_t** nav) const;
+
+    double get_hdop() const override;
+    double get_vdop() const override;
+    double get_pdop() const override;
+    double get_gdop() const override;
+    Monitor_Pvt get_monitor_pvt() const;
+
+    /*!
+     * \brief Copy of the current solution and navigation data, for the
+     * output printers. It does not keep the RTKLIB processing state, and it
+     * does not write the dump files.
+     */
+    std::shared_ptr<const Rtklib_Solver> snapshot() const;
+
+    sol_t pvt_sol{};
+    std::array<ssat_t, MAXSAT> pvt_ssat{};
 
 private:
+    std::shared_ptr<Rtklib_Nav_Data> d_nav_data;  // before the references to its members below
+
+public:
+    // members of the navigation data store, kept by name for the printers
+    std::map<int, Galileo_Ephemeris>& galileo_ephemeris_map;            //!< Map storing new Galileo_Ephemeris
+    std::map<int, Gps_Ephemeris>& gps_ephemeris_map;                    //!< Map storing new GPS_Ephemeris
+    std::map<int, Gps_CNAV_Ephemeris>& gps_cnav_ephemeris_map;          //!< Map storing new GPS_CNAV_Ephemeris
+    std::map<int, Glonass_Gnav_Ephemeris>& glonass_gnav_ephemeris_map;  //!< Map storing new GLONASS GNAV Ephemeris
+    std::map<int, Beidou_Dnav_Ephemeris>& beidou_dnav_ephemeris_map;    //!< Map storing new BeiDou DNAV Ephmeris
+
+    Galileo_Utc_Model& galileo_utc_model;
+    Galileo_Iono& galileo_iono;
+    std::map<int, Galileo_Almanac>& galileo_almanac_map;
+
+    Gps_Utc_Model& gps_utc_model;
+    Gps_Iono& gps_iono;
+    std::map<int, Gps_Almanac>& gps_almanac_map;
+
+    Gps_CNAV_Iono& gps_cnav_iono;
+    Gps_CNAV_Utc_Model& gps_cnav_utc_model;
+
+    Glonass_Gnav_Utc_Model& glonass_gnav_utc_model;  //!< Map storing GLONASS GNAV UTC Model
+    Glonass_Gnav_Almanac& glonass_gnav_almanac;      //!< Map storing GLONASS GNAV Almanac Model
+
+    Beidou_Dnav_Utc_Model& beidou_dnav_utc_model;
+    Beidou_Dnav_Iono& beidou_dnav_iono;
+    std::map<int, Beidou_Dnav_Almanac>& beidou_dnav_almanac_map;
+
+private:
+    /*
+     * RTKLIB ephemeris of a satellite, with the fields of its source that
+     * identify the message and its reception
+     */
+    struct Rtklib_Eph_Cache_Entry
+    {
+        std::array<double, 6> key{};
+        eph_t eph{};
+        bool valid{false};
+    };
+
+    struct Rtklib_Geph_Cache_Entry
+    {
+        std::array<double, 6> key{};
+        geph_t geph{};
+        bool valid{false};
+    };
+
+    struct Snapshot_Tag
+    {
+    };
+
+    /*
+     * Observables of the epoch, for the solution outputs
+     */
+    struct Epoch_Tag
+    {
+        double rx_time{0.0};
+        uint32_t tow_ms{0};
+        int week{0};
+    };
+
+    /*
+     * Input and output of the decoupled positioning. The buffers are
+     * allocated once, and swapped between the caller and the thread.
+     */
+    struct Positioning_Epoch
+    {
+        std::array<obsd_t, MAXOBS> obs{};
+        std::vector<eph_t> eph;
+        std::vector<geph_t> geph;
+        nav_t nav{};
+        int n{0};
+        Epoch_Tag tag{};
+    };
+
+    struct Positioning_Result
+    {
+        sol_t sol{};
+        std::array<ssat_t, MAXSAT> ssat{};
+        Epoch_Tag tag{};
+        int mode{0};
+        int status{0};
+    };
+
+    Rtklib_Solver(const Rtklib_Solver& other, Snapshot_Tag tag);
+
     bool save_matfile() const;
 
+    /*
+     * Stores a solution computed by rtkpos, or clears it if status is 0
+     */
+    void update_solution(int status, const sol_t& sol, const ssat_t* ssat, int mode, const Epoch_Tag& tag);
+
+    void compute_pseudorange_rates(const nav_t& nav_data, int n);
+    int position(const obsd_t* obs, int n, const nav_t* nav);  // rtkpos, or pntpos_hr in the high-rate mode
+    void queue_epoch(const nav_t& nav_data, int n, const Epoch_Tag& tag);
+    bool take_result();
+    void run_positioning();
+
+    /*
+     * Conversions of the ephemerides to RTKLIB structures. The result is kept
+     * by satellite, and given again until a new ephemeris is stored in the maps.
+     */
+    eph_t rtklib_ephemeris(const Gps_Ephemeris& gps_eph);
+    eph_t rtklib_ephemeris(const Gps_CNAV_Ephemeris& gps_cnav_eph);
+    eph_t rtklib_ephemeris(const Galileo_Ephemeris& gal_eph);
+    eph_t rtklib_ephemeris(const Beidou_Dnav_Ephemeris& bds_eph);
+    geph_t rtklib_ephemeris(const Glonass_Gnav_Ephemeris& glonass_gnav_eph, const Glonass_Gnav_Utc_Model& gnav_utc);
+
     std::array<obsd_t, MAXOBS> d_obs_data{};
+    std::vector<eph_t> d_eph_data;
+    std::vector<geph_t> d_geph_data;
+    std::vector<Rtklib_Eph_Cache_Entry> d_eph_cache;       // by RTKLIB satellite number
+    std::vector<Rtklib_Eph_Cache_Entry> d_cnav_eph_cache;  // GPS CNAV, by RTKLIB satellite number
+    std::vector<Rtklib_Geph_Cache_Entry> d_geph_cache;     // by RTKLIB satellite number
     std::array<double, 4> d_dop{};
+    std::array<double, MAXSAT> d_pseudorange_rate{};  // by RTKLIB satellite number - 1
+    std::array<bool, MAXSAT> d_pseudorange_rate_valid{};
     rtk_t d_rtk{};
+    std::unique_ptr<pntcache_t> d_high_rate_cache;  // if the high-rate mode is enabled
+    std::unique_ptr<nav_t> d_epoch_nav;             // navigation data of the last epoch, if kept
     Monitor_Pvt d_monitor_pvt{};
     std::string d_dump_filename;
     std::ofstream d_dump_file;
+
+    // decoupled positioning
+    std::unique_ptr<Positioning_Epoch> d_next_epoch;       // filled by the caller
+    std::unique_ptr<Positioning_Epoch> d_queued_epoch;     // waiting for the thread
+    std::unique_ptr<Positioning_Epoch> d_working_epoch;    // processed by the thread
+    std::unique_ptr<Positioning_Result> d_working_result;  // filled by the thread
+    std::unique_ptr<Positioning_Result> d_ready_result;    // waiting for the caller
+    std::unique_ptr<Positioning_Result> d_taken_result;    // read by the caller
+    mutable std::mutex d_positioning_mutex;
+    std::condition_variable d_positioning_cond;
+    std::thread d_positioning_thread;
+    uint64_t d_skipped_epochs{0};
+    int d_epoch_observations{0};  // observations of the last epoch
+    bool d_epoch_queued{false};
+    bool d_result_ready{false};
+    bool d_positioning_stop{false};
+
     bool d_flag_dump_enabled;
     bool d_flag_dump_mat_enabled;
+    bool d_compute_pseudorange_rates{false};
 };
 
 
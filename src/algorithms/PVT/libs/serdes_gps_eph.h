@@ -73,8 +73,14 @@ public:
 
     inline std::string createProtobuffer(const std::shared_ptr<Gps_Ephemeris> monitor)  //!< Serialization into a string
     {
-        monitor_.Clear();
         std::string data;
+        createProtobuffer(monitor, data);
+        return data;
+    }
+
+    inline void createProtobuffer(const std::shared_ptr<Gps_Ephemeris>& monitor, std::string& data)  //!< Serialization appended to a string
+    {
+        monitor_.Clear();
 
         monitor_.set_prn(monitor->PRN);
         monitor_.set_m_0(monitor->M_0);
@@ -119,8 +125,7 @@ public:
         monitor_.set_alert_flag(monitor->alert_flag);
         monitor_.set_antispoofing_flag(monitor->antispoofing_flag);
 
-        monitor_.SerializeToString(&data);
-        return data;
+        monitor_.AppendToString(&data);
     }
 
     inline Gps_Ephemeris readProtobuffer(const gnss_sdr::GpsEphemeris& mon) const  //!< Deserialization
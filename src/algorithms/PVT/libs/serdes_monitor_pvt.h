@@ -74,9 +74,14 @@ public:
 
     inline std::string createProtobuffer(const Monitor_Pvt* const monitor)  //!< Serialization into a string
     {
-        monitor_.Clear();
-
         std::string data;
+        createProtobuffer(monitor, data);
+        return data;
+    }
+
+    inline void createProtobuffer(const Monitor_Pvt* const monitor, std::string& data)  //!< Serialization appended to a string
+    {
+        monitor_.Clear();
 
         monitor_.set_tow_at_current_symbol_ms(monitor->TOW_at_current_symbol_ms);
         monitor_.set_week(monitor->week);
@@ -107,9 +112,10 @@ public:
         monitor_.set_hdop(monitor->hdop);
         monitor_.set_vdop(monitor->vdop);
         monitor_.set_user_clk_drift_ppm(monitor->user_clk_drift_ppm);
+        monitor_.set_latency_ms(monitor->latency_ms);
+        monitor_.set_skipped_epochs(monitor->skipped_epochs);
 
-        monitor_.SerializeToString(&data);
-        return data;
+        monitor_.AppendToString(&data);
     }
 
     inline Monitor_Pvt readProtobuffer(const gnss_sdr::MonitorPvt& mon) const  //!< Deserialization
@@ -145,6 +151,8 @@ public:
         monitor.hdop = mon.hdop();
         monitor.vdop = mon.vdop();
         monitor.user_clk_drift_ppm = mon.user_clk_drift_ppm();
+        monitor.latency_ms = mon.latency_ms();
+        monitor.skipped_epochs = mon.skipped_epochs();
 
         return monitor;
     }
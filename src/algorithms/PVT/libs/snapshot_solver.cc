@@ -0,0 +1,191 @@
+/*!
+ * \file snapshot_solver.cc
+ * \brief Coarse-time navigation from the code phases of a short burst of
+ * samples.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "snapshot_solver.h"
+#include "MATH_CONSTANTS.h"
+#include "rtklib_conversions.h"
+#include "rtklib_ephemeris.h"
+#include "rtklib_rtkcmn.h"
+#include <glog/logging.h>
+#include <cmath>
+
+
+namespace
+{
+// The ambiguities are restored in milliseconds, the code period of GPS L1
+// C/A, which also divides the 4 ms of the Galileo E1 codes
+constexpr double SNAPSHOT_AMBIGUITY_S = 1e-3;
+constexpr int SNAPSHOT_STATES = 5;
+constexpr int SNAPSHOT_MAX_ITERATIONS = 10;
+}  // namespace
+
+
+Snapshot_Fix Snapshot_Solver::solve(const std::vector<Snapshot_Measurement>& measurements,
+    const gtime_t& coarse_time,
+    const std::array<double, 3>& reference_ecef) const
+{
+    Snapshot_Fix fix{};
+    fix.time = coarse_time;
+
+    std::vector<Satellite> satellites;
+    for (const auto& measurement : measurements)
+        {
+            Satellite sat{};
+            sat.system = measurement.system;
+            sat.code_phase_s = measurement.code_phase_s;
+            if (measurement.system == 'G')
+                {
+                    const auto eph = gps_ephemeris_map.find(static_cast<int>(measurement.prn));
+                    if (eph == gps_ephemeris_map.cend())
+                        {
+                            continue;
+                        }
+                    sat.eph = eph_to_rtklib(eph->second, false);
+                }
+            else if (measurement.system == 'E')
+                {
+                    const auto eph = galileo_ephemeris_map.find(static_cast<int>(measurement.prn));
+                    if (eph == galileo_ephemeris_map.cend())
+                        {
+                            continue;
+                        }
+                    sat.eph = eph_to_rtklib(eph->second);
+                }
+            else
+                {
+                    continue;
+                }
+            if (std::fabs(timediff(coarse_time, sat.eph.toe)) > max_ephemeris_age_s)
+                {
+                    DLOG(INFO) << "Snapshot: the ephemeris of " << measurement.system << measurement.prn << " is too old";
+                    continue;
+                }
+            satellites.push_back(sat);
+        }
+    fix.satellites = static_cast<uint32_t>(satellites.size());
+    if (satellites.size() < static_cast<size_t>(SNAPSHOT_STATES))
+        {
+            return fix;
+        }
+
+    std::array<double, 3> rr = reference_ecef;
+    double bias_m = 0.0;
+    double time_correction_s = 0.0;
+    const auto nsat = static_cast<int>(satellites.size());
+    std::vector<double> H(SNAPSHOT_STATES * nsat);  // transposed design matrix
+    std::vector<double> y(nsat);
+    std::array<double, SNAPSHOT_STATES> dx{};
+    std::array<double, SNAPSHOT_STATES * SNAPSHOT_STATES> Q{};
+    bool converged = false;
+    for (int iter = 0; iter < SNAPSHOT_MAX_ITERATIONS; iter++)
+        {
+            const gtime_t t0 = timeadd(coarse_time, time_correction_s);
+            std::array<double, 3> pos{};
+            ecef2pos(rr.data(), pos.data());
+            for (int i = 0; i < nsat; i++)
+                {
+                    Satellite& sat = satellites[i];
+                    const gtime_t t_rx = timeadd(t0, sat.code_phase_s);
+                    std::array<double, 6> rs{};
+                    std::array<double, 3> e{};
+                    double dts = 0.0;
+                    double var = 0.0;
+                    double range = 0.0;
+                    double travel_time_s = 0.075;
+                    gtime_t t_tx = t_rx;
+                    for (int light_iter = 0; light_iter < 3; light_iter++)
+                        {
+                            t_tx = timeadd(t_rx, -travel_time_s);
+                            eph2pos(t_tx, &sat.eph, rs.data(), &dts, &var);
+                            range = geodist(rs.data(), rr.data(), e.data());
+                            travel_time_s = range / SPEED_OF_LIGHT_M_S;
+                        }
+                    // the single-frequency clock of the satellite: TGD for GPS L1 C/A, BGD E1-E5b for the I/NAV
+                    dts -= (sat.system == 'G' ? sat.eph.tgd[0] : sat.eph.tgd[1]);
+
+                    // range rate, sensitivity of the pseudorange to the error of the coarse time
+                    std::array<double, 6> rs_after{};
+                    std::array<double, 6> rs_before{};
+                    double dts_tmp = 0.0;
+                    eph2pos(timeadd(t_tx, 0.5), &sat.eph, rs_after.data(), &dts_tmp, &var);
+                    eph2pos(timeadd(t_tx, -0.5), &sat.eph, rs_before.data(), &dts_tmp, &var);
+                    double range_rate = 0.0;
+                    for (int j = 0; j < 3; j++)
+                        {
+                            range_rate += e[j] * (rs_after[j] - rs_before[j]);
+                        }
+
+                    double trop = 0.0;
+                    if (pos[2] > -1000.0 and pos[2] < 10000.0)
+                        {
+                            std::array<double, 2> azel{};
+                            satazel(pos.data(), e.data(), azel.data());
+                            trop = (azel[1] > 0.0 ? tropmodel(t_tx, pos.data(), azel.data(), 0.7) : 0.0);
+                        }
+                    const double predicted = range - SPEED_OF_LIGHT_M_S * dts + trop;
+
+                    if (iter == 0)
+                        {
+                            // the first satellite sets the integer part of the bias
+                            if (i == 0)
+                                {
+                                    bias_m = SPEED_OF_LIGHT_M_S * sat.code_phase_s - predicted;
+                                }
+                            sat.ambiguity_s = SNAPSHOT_AMBIGUITY_S * std::round((sat.code_phase_s - (predicted + bias_m) / SPEED_OF_LIGHT_M_S) / SNAPSHOT_AMBIGUITY_S);
+                        }
+                    y[i] = SPEED_OF_LIGHT_M_S * (sat.code_phase_s - sat.ambiguity_s) - (predicted + bias_m);
+                    for (int j = 0; j < 3; j++)
+                        {
+                            H[j + i * SNAPSHOT_STATES] = -e[j];
+                        }
+                    H[3 + i * SNAPSHOT_STATES] = 1.0;
+                    H[4 + i * SNAPSHOT_STATES] = range_rate;
+                }
+
+            double sum_sq = 0.0;
+            for (int i = 0; i < nsat; i++)
+                {
+                    sum_sq += y[i] * y[i];
+                }
+            fix.residual_rms_m = std::sqrt(sum_sq / nsat);
+            fix.iterations = static_cast<uint32_t>(iter + 1);
+
+            if (lsq(H.data(), y.data(), SNAPSHOT_STATES, nsat, dx.data(), Q.data()) != 0)
+                {
+                    LOG(WARNING) << "Snapshot: singular geometry";
+                    return fix;
+                }
+            for (int j = 0; j < 3; j++)
+                {
+                    rr[j] += dx[j];
+                }
+            bias_m += dx[3];
+            time_correction_s += dx[4];
+            if (norm_rtk(dx.data(), 4) < 1e-3 and std::fabs(dx[4]) < 1e-6)
+                {
+                    converged = true;
+                    break;
+                }
+        }
+
+    fix.ecef = rr;
+    ecef2pos(rr.data(), fix.lla.data());
+    fix.time = timeadd(coarse_time, time_correction_s);
+    fix.time_correction_s = time_correction_s;
+    fix.clock_bias_m = bias_m;
+    fix.valid = converged and fix.residual_rms_m < max_residual_rms_m;
+    return fix;
+}
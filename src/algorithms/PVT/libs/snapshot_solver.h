@@ -0,0 +1,106 @@
+/*!
+ * \file snapshot_solver.h
+ * \brief Coarse-time navigation from the code phases of a short burst of
+ * samples.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_SNAPSHOT_SOLVER_H
+#define GNSS_SDR_SNAPSHOT_SOLVER_H
+
+#include "galileo_ephemeris.h"
+#include "gps_ephemeris.h"
+#include "rtklib.h"
+#include <array>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+/** \addtogroup PVT
+ * \{ */
+/** \addtogroup PVT_libs
+ * \{ */
+
+
+/*!
+ * \brief Code phase of a satellite found in the burst
+ */
+struct Snapshot_Measurement
+{
+    char system{'G'};          //!< 'G' for GPS L1 C/A, 'E' for Galileo E1
+    uint32_t prn{0};           //!< Satellite PRN
+    double code_phase_s{0.0};  //!< Time from the first sample of the burst to the next code epoch [s]
+};
+
+
+/*!
+ * \brief Position computed from a burst
+ */
+struct Snapshot_Fix
+{
+    std::array<double, 3> ecef{};    //!< Position [m]
+    std::array<double, 3> lla{};     //!< Latitude [rad], longitude [rad] and height [m]
+    gtime_t time{};                  //!< GPS time of the first sample of the burst
+    double time_correction_s{0.0};   //!< Correction applied to the coarse time [s]
+    double clock_bias_m{0.0};        //!< Receiver clock bias, modulo the code period [m]
+    double residual_rms_m{0.0};      //!< RMS of the pseudorange residuals [m]
+    uint32_t satellites{0};          //!< Satellites used in the solution
+    uint32_t iterations{0};          //!< Iterations of the least squares
+    bool valid{false};
+};
+
+
+/*!
+ * \brief Solves the position of a burst a few milliseconds long, whose
+ * satellites only give the code phases, without the time of transmission.
+ *
+ * The whole milliseconds of the pseudoranges are restored from an a priori
+ * position and a coarse time, which must be within some tens of kilometres
+ * and some tens of seconds of the true ones. The solution has five states:
+ * the position, the receiver clock bias and the error of the coarse time,
+ * observable through the motion of the satellites. The ephemerides can be
+ * those cached by a previous run of the receiver or assistance data.
+ */
+class Snapshot_Solver
+{
+public:
+    Snapshot_Solver() = default;
+
+    /*!
+     * \brief Computes the position of the burst whose first sample was taken
+     * at coarse_time, from at least five measurements with ephemeris.
+     * The fix is not valid if the solution does not converge or its
+     * residuals exceed max_residual_rms_m.
+     */
+    Snapshot_Fix solve(const std::vector<Snapshot_Measurement>& measurements,
+        const gtime_t& coarse_time,
+        const std::array<double, 3>& reference_ecef) const;
+
+    std::map<int, Gps_Ephemeris> gps_ephemeris_map;
+    std::map<int, Galileo_Ephemeris> galileo_ephemeris_map;
+    double max_ephemeris_age_s{14400.0};  //!< Older ephemerides are not used
+    double max_residual_rms_m{150.0};
+
+private:
+    struct Satellite
+    {
+        eph_t eph;
+        double code_phase_s;
+        double ambiguity_s;  // whole code periods restored from the a priori
+        char system;
+    };
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_SNAPSHOT_SOLVER_H
@@ -20,6 +20,7 @@
 #include "acq_conf.h"
 #include "configuration_interface.h"
 #include "galileo_e1_signal_replica.h"
+#include "gnss_replica_cache.h"
 #include "gnss_sdr_flags.h"
 #include <boost/math/distributions/exponential.hpp>
 #include <glog/logging.h>
@@ -72,12 +73,6 @@ GalileoE1PcpsAmbiguousAcquisition::GalileoE1PcpsAmbiguousAcquisition(
     acquisition_ = pcps_make_acquisition(acq_parameters_);
     DLOG(INFO) << "acquisition(" << acquisition_->unique_id() << ")";
 
-    if (item_type_ == "cbyte")
-        {
-            cbyte_to_float_x2_ = make_complex_byte_to_float_x2();
-            float_to_complex_ = gr::blocks::float_to_complex::make();
-        }
-
     if (in_streams_ > 1)
         {
             LOG(ERROR) << "This implementation only supports one input stream";
@@ -127,6 +122,12 @@ void GalileoE1PcpsAmbiguousAcquisition::set_doppler_center(int doppler_center)
 }
 
 
+void GalileoE1PcpsAmbiguousAcquisition::set_code_phase_assistance(double code_epoch_s, double code_period_s)
+{
+    acquisition_->set_code_phase_assistance(code_epoch_s, code_period_s);
+}
+
+
 void GalileoE1PcpsAmbiguousAcquisition::set_gnss_synchro(Gnss_Synchro* gnss_synchro)
 {
     gnss_synchro_ = gnss_synchro;
@@ -149,48 +150,24 @@ void GalileoE1PcpsAmbiguousAcquisition::init()
 
 void GalileoE1PcpsAmbiguousAcquisition::set_local_code()
 {
-    bool cboc = configuration_->property(
+    const bool cboc = configuration_->property(
         "Acquisition" + std::to_string(channel_) + ".cboc", false);
 
-    volk_gnsssdr::vector<std::complex<float>> code(code_length_);
-
-    if (acquire_pilot_ == true)
-        {
-            // set local signal generator to Galileo E1 pilot component (1C)
-            std::array<char, 3> pilot_signal = {{'1', 'C', '\0'}};
-            if (acq_parameters_.use_automatic_resampler)
-                {
-                    galileo_e1_code_gen_complex_sampled(code, pilot_signal,
-                        cboc, gnss_synchro_->PRN, acq_parameters_.resampled_fs, 0, false);
-                }
-            else
-                {
-                    galileo_e1_code_gen_complex_sampled(code, pilot_signal,
-                        cboc, gnss_synchro_->PRN, fs_in_, 0, false);
-                }
-        }
-    else
-        {
-            std::array<char, 3> Signal_{};
-            Signal_[0] = gnss_synchro_->Signal[0];
-            Signal_[1] = gnss_synchro_->Signal[1];
-            Signal_[2] = '\0';
-            if (acq_parameters_.use_automatic_resampler)
-                {
-                    galileo_e1_code_gen_complex_sampled(code, Signal_,
-                        cboc, gnss_synchro_->PRN, acq_parameters_.resampled_fs, 0, false);
-                }
-            else
-                {
-                    galileo_e1_code_gen_complex_sampled(code, Signal_,
-                        cboc, gnss_synchro_->PRN, fs_in_, 0, false);
-                }
-        }
+    // Galileo E1 pilot component (1C), or the searched one
+    std::array<char, 3> signal_id{};
+    signal_id[0] = '1';
+    signal_id[1] = acquire_pilot_ ? 'C' : gnss_synchro_->Signal[1];
+    signal_id[2] = '\0';
+    const uint32_t PRN = gnss_synchro_->PRN;
+    const int64_t fs = acq_parameters_.use_automatic_resampler ? acq_parameters_.resampled_fs : fs_in_;
+    const std::string variant = std::string(cboc ? "cboc " : "sinboc11 ") + (acquire_pilot_ ? "pilot" : "data");
+    const auto code = Gnss_Replica_Cache::get().get_complex("Galileo 1B", PRN, static_cast<double>(fs), variant, code_length_,
+        [signal_id, cboc, PRN, fs](own::span<std::complex<float>> replica) { galileo_e1_code_gen_complex_sampled(replica, signal_id, cboc, PRN, fs, 0, false); });
 
     own::span<gr_complex> code_span(code_.data(), vector_length_);
     for (unsigned int i = 0; i < sampled_ms_ / 4; i++)
         {
-            std::copy_n(code.data(), code_length_, code_span.subspan(i * code_length_, code_length_).data());
+            std::copy_n(code->data(), code_length_, code_span.subspan(i * code_length_, code_length_).data());
         }
 
     acquisition_->set_local_code(code_.data());
@@ -211,18 +188,10 @@ void GalileoE1PcpsAmbiguousAcquisition::set_state(int state)
 
 void GalileoE1PcpsAmbiguousAcquisition::connect(gr::top_block_sptr top_block)
 {
-    if (item_type_ == "gr_complex" || item_type_ == "cshort")
+    if (item_type_ == "gr_complex" || item_type_ == "cshort" || item_type_ == "cbyte")
         {
             // nothing to connect
         }
-    else if (item_type_ == "cbyte")
-        {
-            // Since a byte-based acq implementation is not available,
-            // we just convert cshorts to gr_complex
-            top_block->connect(cbyte_to_float_x2_, 0, float_to_complex_, 0);
-            top_block->connect(cbyte_to_float_x2_, 1, float_to_complex_, 1);
-            top_block->connect(float_to_complex_, 0, acquisition_, 0);
-        }
     else
         {
             LOG(WARNING) << item_type_ << " unknown acquisition item type";
@@ -232,16 +201,10 @@ void GalileoE1PcpsAmbiguousAcquisition::connect(gr::top_block_sptr top_block)
 
 void GalileoE1PcpsAmbiguousAcquisition::disconnect(gr::top_block_sptr top_block)
 {
-    if (item_type_ == "gr_complex" || item_type_ == "cshort")
+    if (item_type_ == "gr_complex" || item_type_ == "cshort" || item_type_ == "cbyte")
         {
             // nothing to disconnect
         }
-    else if (item_type_ == "cbyte")
-        {
-            top_block->disconnect(cbyte_to_float_x2_, 0, float_to_complex_, 0);
-            top_block->disconnect(cbyte_to_float_x2_, 1, float_to_complex_, 1);
-            top_block->disconnect(float_to_complex_, 0, acquisition_, 0);
-        }
     else
         {
             LOG(WARNING) << item_type_ << " unknown acquisition item type";
@@ -251,14 +214,10 @@ void GalileoE1PcpsAmbiguousAcquisition::disconnect(gr::top_block_sptr top_block)
 
 gr::basic_block_sptr GalileoE1PcpsAmbiguousAcquisition::get_left_block()
 {
-    if (item_type_ == "gr_complex" || item_type_ == "cshort")
+    if (item_type_ == "gr_complex" || item_type_ == "cshort" || item_type_ == "cbyte")
         {
             return acquisition_;
         }
-    if (item_type_ == "cbyte")
-        {
-            return cbyte_to_float_x2_;
-        }
 
     LOG(WARNING) << item_type_ << " unknown acquisition item type";
     return nullptr;
@@ -21,6 +21,7 @@
 #include "acq_conf.h"
 #include "configuration_interface.h"
 #include "galileo_e5_signal_replica.h"
+#include "gnss_replica_cache.h"
 #include "gnss_sdr_flags.h"
 #include <glog/logging.h>
 #include <volk_gnsssdr/volk_gnsssdr_complex.h>
@@ -122,6 +123,12 @@ void GalileoE5bPcpsAcquisition::set_doppler_center(int doppler_center)
 }
 
 
+void GalileoE5bPcpsAcquisition::set_code_phase_assistance(double code_epoch_s, double code_period_s)
+{
+    acquisition_->set_code_phase_assistance(code_epoch_s, code_period_s);
+}
+
+
 void GalileoE5bPcpsAcquisition::set_gnss_synchro(Gnss_Synchro* gnss_synchro)
 {
     gnss_synchro_ = gnss_synchro;
@@ -143,7 +150,6 @@ void GalileoE5bPcpsAcquisition::init()
 
 void GalileoE5bPcpsAcquisition::set_local_code()
 {
-    volk_gnsssdr::vector<std::complex<float>> code(code_length_);
     std::array<char, 3> signal_{};
     signal_[0] = '7';
     signal_[2] = '\0';
@@ -161,18 +167,15 @@ void GalileoE5bPcpsAcquisition::set_local_code()
             signal_[1] = 'I';
         }
 
-    if (acq_parameters_.use_automatic_resampler)
-        {
-            galileo_e5_b_code_gen_complex_sampled(code, gnss_synchro_->PRN, signal_, acq_parameters_.resampled_fs, 0);
-        }
-    else
-        {
-            galileo_e5_b_code_gen_complex_sampled(code, gnss_synchro_->PRN, signal_, fs_in_, 0);
-        }
+    const uint32_t PRN = gnss_synchro_->PRN;
+    const int64_t fs = acq_parameters_.use_automatic_resampler ? acq_parameters_.resampled_fs : fs_in_;
+    const auto code = Gnss_Replica_Cache::get().get_complex("Galileo 7X", PRN, static_cast<double>(fs), std::string("sampled ") + signal_.data(), code_length_,
+        [PRN, signal_, fs](own::span<std::complex<float>> replica) { galileo_e5_b_code_gen_complex_sampled(replica, PRN, signal_, fs, 0); });
+
     own::span<gr_complex> code_span(code_.data(), vector_length_);
     for (unsigned int i = 0; i < sampled_ms_; i++)
         {
-            std::copy_n(code.data(), code_length_, code_span.subspan(i * code_length_, code_length_).data());
+            std::copy_n(code->data(), code_length_, code_span.subspan(i * code_length_, code_length_).data());
         }
 
     acquisition_->set_local_code(code_.data());
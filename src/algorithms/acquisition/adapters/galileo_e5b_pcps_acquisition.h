@@ -141,6 +141,11 @@ public:
      */
     void set_doppler_center(int doppler_center) override;
 
+    /*!
+     * \brief Restrict the search to the code phases and Doppler bins predicted by the receiver
+     */
+    void set_code_phase_assistance(double code_epoch_s, double code_period_s) override;
+
     /*!
      * \brief Initializes acquisition algorithm.
      */
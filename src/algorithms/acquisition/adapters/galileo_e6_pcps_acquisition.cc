@@ -20,6 +20,7 @@
 #include "acq_conf.h"
 #include "configuration_interface.h"
 #include "galileo_e6_signal_replica.h"
+#include "gnss_replica_cache.h"
 #include "gnss_sdr_flags.h"
 #include <glog/logging.h>
 #include <algorithm>
@@ -70,12 +71,6 @@ GalileoE6PcpsAcquisition::GalileoE6PcpsAcquisition(
     acquisition_ = pcps_make_acquisition(acq_parameters_);
     DLOG(INFO) << "acquisition(" << acquisition_->unique_id() << ")";
 
-    if (item_type_ == "cbyte")
-        {
-            cbyte_to_float_x2_ = make_complex_byte_to_float_x2();
-            float_to_complex_ = gr::blocks::float_to_complex::make();
-        }
-
     if (in_streams_ > 1)
         {
             LOG(ERROR) << "This implementation only supports one input stream";
@@ -125,6 +120,12 @@ void GalileoE6PcpsAcquisition::set_doppler_center(int doppler_center)
 }
 
 
+void GalileoE6PcpsAcquisition::set_code_phase_assistance(double code_epoch_s, double code_period_s)
+{
+    acquisition_->set_code_phase_assistance(code_epoch_s, code_period_s);
+}
+
+
 void GalileoE6PcpsAcquisition::set_gnss_synchro(Gnss_Synchro* gnss_synchro)
 {
     gnss_synchro_ = gnss_synchro;
@@ -147,23 +148,15 @@ void GalileoE6PcpsAcquisition::init()
 
 void GalileoE6PcpsAcquisition::set_local_code()
 {
-    volk_gnsssdr::vector<std::complex<float>> code(code_length_);
-
-    if (acq_parameters_.use_automatic_resampler)
-        {
-            galileo_e6_b_code_gen_complex_sampled(code,
-                gnss_synchro_->PRN, acq_parameters_.resampled_fs, 0);
-        }
-    else
-        {
-            galileo_e6_b_code_gen_complex_sampled(code,
-                gnss_synchro_->PRN, fs_in_, 0);
-        }
+    const uint32_t PRN = gnss_synchro_->PRN;
+    const int64_t fs = acq_parameters_.use_automatic_resampler ? acq_parameters_.resampled_fs : fs_in_;
+    const auto code = Gnss_Replica_Cache::get().get_complex("Galileo E6", PRN, static_cast<double>(fs), "sampled data", code_length_,
+        [PRN, fs](own::span<std::complex<float>> replica) { galileo_e6_b_code_gen_complex_sampled(replica, PRN, fs, 0); });
 
     own::span<gr_complex> code_span(code_.data(), vector_length_);
     for (unsigned int i = 0; i < sampled_ms_; i++)
         {
-            std::copy_n(code.data(), code_length_, code_span.subspan(i * code_length_, code_length_).data());
+            std::copy_n(code->data(), code_length_, code_span.subspan(i * code_length_, code_length_).data());
         }
 
     acquisition_->set_local_code(code_.data());
@@ -184,18 +177,10 @@ void GalileoE6PcpsAcquisition::set_state(int state)
 
 void GalileoE6PcpsAcquisition::connect(gr::top_block_sptr top_block)
 {
-    if (item_type_ == "gr_complex" || item_type_ == "cshort")
+    if (item_type_ == "gr_complex" || item_type_ == "cshort" || item_type_ == "cbyte")
         {
             // nothing to connect
         }
-    else if (item_type_ == "cbyte")
-        {
-            // Since a byte-based acq implementation is not available,
-            // we just convert cshorts to gr_complex
-            top_block->connect(cbyte_to_float_x2_, 0, float_to_complex_, 0);
-            top_block->connect(cbyte_to_float_x2_, 1, float_to_complex_, 1);
-            top_block->connect(float_to_complex_, 0, acquisition_, 0);
-        }
     else
         {
             LOG(WARNING) << item_type_ << " unknown acquisition item type";
@@ -205,16 +190,10 @@ void GalileoE6PcpsAcquisition::connect(gr::top_block_sptr top_block)
 
 void GalileoE6PcpsAcquisition::disconnect(gr::top_block_sptr top_block)
 {
-    if (item_type_ == "gr_complex" || item_type_ == "cshort")
+    if (item_type_ == "gr_complex" || item_type_ == "cshort" || item_type_ == "cbyte")
         {
             // nothing to disconnect
         }
-    else if (item_type_ == "cbyte")
-        {
-            top_block->disconnect(cbyte_to_float_x2_, 0, float_to_complex_, 0);
-            top_block->disconnect(cbyte_to_float_x2_, 1, float_to_complex_, 1);
-            top_block->disconnect(float_to_complex_, 0, acquisition_, 0);
-        }
     else
         {
             LOG(WARNING) << item_type_ << " unknown acquisition item type";
@@ -224,14 +203,10 @@ void GalileoE6PcpsAcquisition::disconnect(gr::top_block_sptr top_block)
 
 gr::basic_block_sptr GalileoE6PcpsAcquisition::get_left_block()
 {
-    if (item_type_ == "gr_complex" || item_type_ == "cshort")
+    if (item_type_ == "gr_complex" || item_type_ == "cshort" || item_type_ == "cbyte")
         {
             return acquisition_;
         }
-    if (item_type_ == "cbyte")
-        {
-            return cbyte_to_float_x2_;
-        }
 
     LOG(WARNING) << item_type_ << " unknown acquisition item type";
     return nullptr;
@@ -22,6 +22,7 @@
 #include "acq_conf.h"
 #include "configuration_interface.h"
 #include "glonass_l1_signal_replica.h"
+#include "gnss_replica_cache.h"
 #include "gnss_sdr_flags.h"
 #include <glog/logging.h>
 #include <algorithm>
@@ -47,7 +48,9 @@ GlonassL1CaPcpsAcquisition::GlonassL1CaPcpsAcquisition(
                                 out_streams_(out_streams)
 {
     acq_parameters_.ms_per_code = 1;
-    acq_parameters_.SetFromConfiguration(configuration, role, GLONASS_L1_CA_CODE_RATE_CPS, 100e6);
+    // with the FDMA channelizer, the sub-band of the satellite is acquired at a lower rate
+    acq_parameters_.fdma_channelized = configuration->property("GNSS-SDR.use_glonass_fdma_channelizer", false);
+    acq_parameters_.SetFromConfiguration(configuration, role, GLONASS_L1_CA_CODE_RATE_CPS, acq_parameters_.fdma_channelized ? GLONASS_L1_CA_OPT_ACQ_FS_SPS : 100e6);
 
     DLOG(INFO) << "role " << role;
 
@@ -70,12 +73,6 @@ GlonassL1CaPcpsAcquisition::GlonassL1CaPcpsAcquisition(
     acquisition_ = pcps_make_acquisition(acq_parameters_);
     DLOG(INFO) << "acquisition(" << acquisition_->unique_id() << ")";
 
-    if (item_type_ == "cbyte")
-        {
-            cbyte_to_float_x2_ = make_complex_byte_to_float_x2();
-            float_to_complex_ = gr::blocks::float_to_complex::make();
-        }
-
     if (in_streams_ > 1)
         {
             LOG(ERROR) << "This implementation only supports one input stream";
@@ -141,14 +138,15 @@ void GlonassL1CaPcpsAcquisition::init()
 
 void GlonassL1CaPcpsAcquisition::set_local_code()
 {
-    volk_gnsssdr::vector<std::complex<float>> code(code_length_);
-
-    glonass_l1_ca_code_gen_complex_sampled(code, fs_in_, 0);
+    // all the satellites share the same code
+    const int64_t fs = acq_parameters_.use_automatic_resampler ? acq_parameters_.resampled_fs : fs_in_;
+    const auto code = Gnss_Replica_Cache::get().get_complex("Glonass 1G", 0, static_cast<double>(fs), "sampled", code_length_,
+        [fs](own::span<std::complex<float>> replica) { glonass_l1_ca_code_gen_complex_sampled(replica, fs, 0); });
 
     own::span<gr_complex> code_span(code_.data(), vector_length_);
     for (unsigned int i = 0; i < sampled_ms_; i++)
         {
-            std::copy_n(code.data(), code_length_, code_span.subspan(i * code_length_, code_length_).data());
+            std::copy_n(code->data(), code_length_, code_span.subspan(i * code_length_, code_length_).data());
         }
 
     acquisition_->set_local_code(code_.data());
@@ -169,16 +167,10 @@ void GlonassL1CaPcpsAcquisition::set_state(int state)
 
 void GlonassL1CaPcpsAcquisition::connect(gr::top_block_sptr top_block)
 {
-    if (item_type_ == "gr_complex" || item_type_ == "cshort")
+    if (item_type_ == "gr_complex" || item_type_ == "cshort" || item_type_ == "cbyte")
         {
             // nothing to connect
         }
-    else if (item_type_ == "cbyte")
-        {
-            top_block->connect(cbyte_to_float_x2_, 0, float_to_complex_, 0);
-            top_block->connect(cbyte_to_float_x2_, 1, float_to_complex_, 1);
-            top_block->connect(float_to_complex_, 0, acquisition_, 0);
-        }
     else
         {
             LOG(WARNING) << item_type_ << " unknown acquisition item type";
@@ -188,18 +180,10 @@ void GlonassL1CaPcpsAcquisition::connect(gr::top_block_sptr top_block)
 
 void GlonassL1CaPcpsAcquisition::disconnect(gr::top_block_sptr top_block)
 {
-    if (item_type_ == "gr_complex" || item_type_ == "cshort")
+    if (item_type_ == "gr_complex" || item_type_ == "cshort" || item_type_ == "cbyte")
         {
             // nothing to disconnect
         }
-    else if (item_type_ == "cbyte")
-        {
-            // Since a byte-based acq implementation is not available,
-            // we just convert cshorts to gr_complex
-            top_block->disconnect(cbyte_to_float_x2_, 0, float_to_complex_, 0);
-            top_block->disconnect(cbyte_to_float_x2_, 1, float_to_complex_, 1);
-            top_block->disconnect(float_to_complex_, 0, acquisition_, 0);
-        }
     else
         {
             LOG(WARNING) << item_type_ << " unknown acquisition item type";
@@ -209,14 +193,10 @@ void GlonassL1CaPcpsAcquisition::disconnect(gr::top_block_sptr top_block)
 
 gr::basic_block_sptr GlonassL1CaPcpsAcquisition::get_left_block()
 {
-    if (item_type_ == "gr_complex" || item_type_ == "cshort")
+    if (item_type_ == "gr_complex" || item_type_ == "cshort" || item_type_ == "cbyte")
         {
             return acquisition_;
         }
-    if (item_type_ == "cbyte")
-        {
-            return cbyte_to_float_x2_;
-        }
 
     LOG(WARNING) << item_type_ << " unknown acquisition item type";
     return nullptr;
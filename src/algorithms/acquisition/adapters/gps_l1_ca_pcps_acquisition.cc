@@ -23,6 +23,7 @@
 #include "GPS_L1_CA.h"
 #include "acq_conf.h"
 #include "configuration_interface.h"
+#include "gnss_replica_cache.h"
 #include "gnss_sdr_flags.h"
 #include "gps_sdr_signal_replica.h"
 #include <glog/logging.h>
@@ -73,12 +74,6 @@ GpsL1CaPcpsAcquisition::GpsL1CaPcpsAcquisition(
     acquisition_ = pcps_make_acquisition(acq_parameters_);
     DLOG(INFO) << "acquisition(" << acquisition_->unique_id() << ")";
 
-    if (item_type_ == "cbyte")
-        {
-            cbyte_to_float_x2_ = make_complex_byte_to_float_x2();
-            float_to_complex_ = gr::blocks::float_to_complex::make();
-        }
-
     if (in_streams_ > 1)
         {
             LOG(ERROR) << "This implementation only supports one input stream";
@@ -128,6 +123,12 @@ void GpsL1CaPcpsAcquisition::set_doppler_center(int doppler_center)
 }
 
 
+void GpsL1CaPcpsAcquisition::set_code_phase_assistance(double code_epoch_s, double code_period_s)
+{
+    acquisition_->set_code_phase_assistance(code_epoch_s, code_period_s);
+}
+
+
 void GpsL1CaPcpsAcquisition::set_gnss_synchro(Gnss_Synchro* gnss_synchro)
 {
     gnss_synchro_ = gnss_synchro;
@@ -150,20 +151,15 @@ void GpsL1CaPcpsAcquisition::init()
 
 void GpsL1CaPcpsAcquisition::set_local_code()
 {
-    volk_gnsssdr::vector<std::complex<float>> code(code_length_);
+    const uint32_t PRN = gnss_synchro_->PRN;
+    const int64_t fs = acq_parameters_.use_automatic_resampler ? acq_parameters_.resampled_fs : acq_parameters_.fs_in;
+    const auto code = Gnss_Replica_Cache::get().get_complex("GPS 1C", PRN, static_cast<double>(fs), "sampled", code_length_,
+        [PRN, fs](own::span<std::complex<float>> replica) { gps_l1_ca_code_gen_complex_sampled(replica, PRN, fs, 0); });
 
-    if (acq_parameters_.use_automatic_resampler)
-        {
-            gps_l1_ca_code_gen_complex_sampled(code, gnss_synchro_->PRN, acq_parameters_.resampled_fs, 0);
-        }
-    else
-        {
-            gps_l1_ca_code_gen_complex_sampled(code, gnss_synchro_->PRN, acq_parameters_.fs_in, 0);
-        }
     own::span<gr_complex> code_span(code_.data(), vector_length_);
     for (unsigned int i = 0; i < sampled_ms_; i++)
         {
-            std::copy_n(code.data(), code_length_, code_span.subspan(i * code_length_, code_length_).data());
+            std::copy_n(code->data(), code_length_, code_span.subspan(i * code_length_, code_length_).data());
         }
 
     acquisition_->set_local_code(code_.data());
@@ -184,18 +180,10 @@ void GpsL1CaPcpsAcquisition::set_state(int state)
 
 void GpsL1CaPcpsAcquisition::connect(gr::top_block_sptr top_block)
 {
-    if (item_type_ == "gr_complex" || item_type_ == "cshort")
+    if (item_type_ == "gr_complex" || item_type_ == "cshort" || item_type_ == "cbyte")
         {
             // nothing to connect
         }
-    else if (item_type_ == "cbyte")
-        {
-            // Since a byte-based acq implementation is not available,
-            // we just convert cshorts to gr_complex
-            top_block->connect(cbyte_to_float_x2_, 0, float_to_complex_, 0);
-            top_block->connect(cbyte_to_float_x2_, 1, float_to_complex_, 1);
-            top_block->connect(float_to_complex_, 0, acquisition_, 0);
-        }
     else
         {
             LOG(WARNING) << item_type_ << " unknown acquisition item type: " << item_type_;
@@ -205,16 +193,10 @@ void GpsL1CaPcpsAcquisition::connect(gr::top_block_sptr top_block)
 
 void GpsL1CaPcpsAcquisition::disconnect(gr::top_block_sptr top_block)
 {
-    if (item_type_ == "gr_complex" || item_type_ == "cshort")
+    if (item_type_ == "gr_complex" || item_type_ == "cshort" || item_type_ == "cbyte")
         {
             // nothing to disconnect
         }
-    else if (item_type_ == "cbyte")
-        {
-            top_block->disconnect(cbyte_to_float_x2_, 0, float_to_complex_, 0);
-            top_block->disconnect(cbyte_to_float_x2_, 1, float_to_complex_, 1);
-            top_block->disconnect(float_to_complex_, 0, acquisition_, 0);
-        }
     else
         {
             LOG(WARNING) << item_type_ << " unknown acquisition item type" << item_type_;
@@ -224,14 +206,10 @@ void GpsL1CaPcpsAcquisition::disconnect(gr::top_block_sptr top_block)
 
 gr::basic_block_sptr GpsL1CaPcpsAcquisition::get_left_block()
 {
-    if (item_type_ == "gr_complex" || item_type_ == "cshort")
+    if (item_type_ == "gr_complex" || item_type_ == "cshort" || item_type_ == "cbyte")
         {
             return acquisition_;
         }
-    if (item_type_ == "cbyte")
-        {
-            return cbyte_to_float_x2_;
-        }
 
     LOG(WARNING) << item_type_ << " unknown acquisition item type" << item_type_;
     return nullptr;
@@ -21,10 +21,8 @@
 #define GNSS_SDR_GPS_L2_M_PCPS_ACQUISITION_H
 
 #include "channel_fsm.h"
-#include "complex_byte_to_float_x2.h"
 #include "gnss_synchro.h"
 #include "pcps_acquisition.h"
-#include <gnuradio/blocks/float_to_complex.h>
 #include <volk_gnsssdr/volk_gnsssdr_alloc.h>
 #include <memory>
 #include <string>
@@ -121,6 +119,11 @@ public:
      */
     void set_doppler_center(int doppler_center) override;
 
+    /*!
+     * \brief Restrict the search to the code phases and Doppler bins predicted by the receiver
+     */
+    void set_code_phase_assistance(double code_epoch_s, double code_period_s) override;
+
     /*!
      * \brief Initializes acquisition algorithm.
      */
@@ -159,8 +162,6 @@ public:
 private:
     pcps_acquisition_sptr acquisition_;
     volk_gnsssdr::vector<std::complex<float>> code_;
-    gr::blocks::float_to_complex::sptr float_to_complex_;
-    complex_byte_to_float_x2_sptr cbyte_to_float_x2_;
     std::weak_ptr<ChannelFsm> channel_fsm_;
     Gnss_Synchro* gnss_synchro_;
     Acq_Conf acq_parameters_;
@@ -22,14 +22,16 @@
  */
 
 #include "galileo_e5a_noncoherent_iq_acquisition_caf_cc.h"
-#include "MATH_CONSTANTS.h"
 #include <glog/logging.h>
 #include <gnuradio/io_signature.h>
 #include <volk/volk.h>
 #include <volk_gnsssdr/volk_gnsssdr.h>
 #include <array>
+#include <cstring>
 #include <exception>
+#include <memory>
 #include <sstream>
+#include <vector>
 
 
 galileo_e5a_noncoherentIQ_acquisition_caf_cc_sptr galileo_e5a_noncoherentIQ_make_acquisition_caf_cc(
@@ -131,8 +133,7 @@ galileo_e5a_noncoherentIQ_acquisition_caf_cc::galileo_e5a_noncoherentIQ_acquisit
                 }
         }
 
-    d_fft_if = gnss_fft_fwd_make_unique(d_fft_size);
-    d_ifft = gnss_fft_rev_make_unique(d_fft_size);
+    d_engine = std::make_unique<Acq_Pcps_Engine>(d_fs_in, d_fft_size);
 }
 
 
@@ -160,48 +161,33 @@ void galileo_e5a_noncoherentIQ_acquisition_caf_cc::set_local_code(std::complex<f
 {
     // DATA SIGNAL
     // Three replicas of data primary code. CODE A: (1,1,1)
-    memcpy(d_fft_if->get_inbuf(), codeI, sizeof(gr_complex) * d_fft_size);
-
-    d_fft_if->execute();  // We need the FFT of local code
-
-    // Conjugate the local code
-    volk_32fc_conjugate_32fc(d_fft_code_I_A.data(), d_fft_if->get_outbuf(), d_fft_size);
+    d_engine->code_spectrum(codeI, d_fft_code_I_A.data());
 
     // SAME FOR PILOT SIGNAL
     if (d_both_signal_components == true)
         {
             // Three replicas of pilot primary code. CODE A: (1,1,1)
-            memcpy(d_fft_if->get_inbuf(), codeQ, sizeof(gr_complex) * d_fft_size);
-
-            d_fft_if->execute();  // We need the FFT of local code
-
-            // Conjugate the local code
-            volk_32fc_conjugate_32fc(d_fft_code_Q_A.data(), d_fft_if->get_outbuf(), d_fft_size);
+            d_engine->code_spectrum(codeQ, d_fft_code_Q_A.data());
         }
     // IF INTEGRATION TIME > 1 code, we need to evaluate the other possible combination
     // Note: max integration time allowed = 3ms (dealt in adapter)
     if (d_sampled_ms > 1)
         {
             // DATA CODE B: First replica is inverted (0,1,1)
-            volk_32fc_s32fc_multiply_32fc(&(d_fft_if->get_inbuf())[0],
+            std::vector<gr_complex> code_B(codeI, codeI + d_fft_size);
+            volk_32fc_s32fc_multiply_32fc(code_B.data(),
                 &codeI[0], gr_complex(-1, 0),
                 d_samples_per_code);
-
-            d_fft_if->execute();  // We need the FFT of local code
-
-            // Conjugate the local code
-            volk_32fc_conjugate_32fc(d_fft_code_I_B.data(), d_fft_if->get_outbuf(), d_fft_size);
+            d_engine->code_spectrum(code_B.data(), d_fft_code_I_B.data());
 
             if (d_both_signal_components == true)
                 {
                     // PILOT CODE B: First replica is inverted (0,1,1)
-                    volk_32fc_s32fc_multiply_32fc(&(d_fft_if->get_inbuf())[0],
+                    code_B.assign(codeQ, codeQ + d_fft_size);
+                    volk_32fc_s32fc_multiply_32fc(code_B.data(),
                         &codeQ[0], gr_complex(-1, 0),
                         d_samples_per_code);
-                    d_fft_if->execute();  // We need the FFT of local code
-
-                    // Conjugate the local code
-                    volk_32fc_conjugate_32fc(d_fft_code_Q_B.data(), d_fft_if->get_outbuf(), d_fft_size);
+                    d_engine->code_spectrum(code_B.data(), d_fft_code_Q_B.data());
                 }
         }
 }
@@ -221,24 +207,9 @@ void galileo_e5a_noncoherentIQ_acquisition_caf_cc::init()
     d_mag = 0.0;
     d_input_power = 0.0;
 
-    // Count the number of bins
-    d_num_doppler_bins = 0;
-    for (int doppler = -d_doppler_max;
-         doppler <= d_doppler_max;
-         doppler += d_doppler_step)
-        {
-            d_num_doppler_bins++;
-        }
-
-    // Create the carrier Doppler wipeoff signals
-    d_grid_doppler_wipeoffs = std::vector<std::vector<gr_complex>>(d_num_doppler_bins, std::vector<gr_complex>(d_fft_size));
-    for (int doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
-        {
-            int doppler = -d_doppler_max + d_doppler_step * doppler_index;
-            float phase_step_rad = static_cast<float>(TWO_PI) * static_cast<float>(doppler) / static_cast<float>(d_fs_in);
-            std::array<float, 1> _phase{};
-            volk_gnsssdr_s32f_sincos_32fc(d_grid_doppler_wipeoffs[doppler_index].data(), -phase_step_rad, _phase.data(), d_fft_size);
-        }
+    // Set the Doppler grid
+    d_engine->set_doppler_grid(std::string(d_gnss_synchro->Signal, 2), d_doppler_max, d_doppler_step);
+    d_num_doppler_bins = static_cast<int>(d_engine->num_doppler_bins());
 
     /* CAF Filtering to resolve doppler ambiguity. Phase and quadrature must be processed
      * separately before non-coherent integration */
@@ -391,24 +362,13 @@ int galileo_e5a_noncoherentIQ_acquisition_caf_cc::general_work(int noutput_items
                         // doppler search steps
                         doppler = -static_cast<int>(d_doppler_max) + d_doppler_step * doppler_index;
 
-                        volk_32fc_x2_multiply_32fc(d_fft_if->get_inbuf(), d_inbuffer.data(),
-                            d_grid_doppler_wipeoffs[doppler_index].data(), d_fft_size);
-
                         // 3- Perform the FFT-based convolution  (parallel time search)
-                        // Compute the FFT of the carrier wiped--off incoming signal
-                        d_fft_if->execute();
+                        // of the carrier wiped--off incoming signal with the local codes
+                        d_engine->input_spectrum(d_inbuffer.data(), d_sample_counter, doppler_index);
 
                         // CODE IA
-                        // Multiply carrier wiped--off, Fourier transformed incoming signal
-                        // with the local FFT'd code reference using SIMD operations with VOLK library
-                        volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(),
-                            d_fft_if->get_outbuf(), d_fft_code_I_A.data(), d_fft_size);
-
-                        // compute the inverse FFT
-                        d_ifft->execute();
-
                         // Search maximum
-                        volk_32fc_magnitude_squared_32f(d_magnitudeIA.data(), d_ifft->get_outbuf(), d_fft_size);
+                        volk_32fc_magnitude_squared_32f(d_magnitudeIA.data(), d_engine->correlate(d_fft_code_I_A.data()), d_fft_size);
                         volk_gnsssdr_32f_index_max_32u(&indext_IA, d_magnitudeIA.data(), d_fft_size);
                         // Normalize the maximum value to correct the scale factor introduced by FFTW
                         magt_IA = d_magnitudeIA[indext_IA] / (fft_normalization_factor * fft_normalization_factor);
@@ -416,30 +376,21 @@ int galileo_e5a_noncoherentIQ_acquisition_caf_cc::general_work(int noutput_items
                         if (d_both_signal_components == true)
                             {
                                 // REPEAT FOR ALL CODES. CODE_QA
-                                volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(),
-                                    d_fft_if->get_outbuf(), d_fft_code_Q_A.data(), d_fft_size);
-                                d_ifft->execute();
-                                volk_32fc_magnitude_squared_32f(d_magnitudeQA.data(), d_ifft->get_outbuf(), d_fft_size);
+                                volk_32fc_magnitude_squared_32f(d_magnitudeQA.data(), d_engine->correlate(d_fft_code_Q_A.data()), d_fft_size);
                                 volk_gnsssdr_32f_index_max_32u(&indext_QA, d_magnitudeQA.data(), d_fft_size);
                                 magt_QA = d_magnitudeQA[indext_QA] / (fft_normalization_factor * fft_normalization_factor);
                             }
                         if (d_sampled_ms > 1)  // If Integration time > 1 code
                             {
                                 // REPEAT FOR ALL CODES. CODE_IB
-                                volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(),
-                                    d_fft_if->get_outbuf(), d_fft_code_I_B.data(), d_fft_size);
-                                d_ifft->execute();
-                                volk_32fc_magnitude_squared_32f(d_magnitudeIB.data(), d_ifft->get_outbuf(), d_fft_size);
+                                volk_32fc_magnitude_squared_32f(d_magnitudeIB.data(), d_engine->correlate(d_fft_code_I_B.data()), d_fft_size);
                                 volk_gnsssdr_32f_index_max_32u(&indext_IB, d_magnitudeIB.data(), d_fft_size);
                                 magt_IB = d_magnitudeIB[indext_IB] / (fft_normalization_factor * fft_normalization_factor);
 
                                 if (d_both_signal_components == true)
                                     {
                                         // REPEAT FOR ALL CODES. CODE_QB
-                                        volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(),
-                                            d_fft_if->get_outbuf(), d_fft_code_Q_B.data(), d_fft_size);
-                                        d_ifft->execute();
-                                        volk_32fc_magnitude_squared_32f(d_magnitudeQB.data(), d_ifft->get_outbuf(), d_fft_size);
+                                        volk_32fc_magnitude_squared_32f(d_magnitudeQB.data(), d_engine->correlate(d_fft_code_Q_B.data()), d_fft_size);
                                         volk_gnsssdr_32f_index_max_32u(&indext_QB, d_magnitudeQB.data(), d_fft_size);
                                         magt_QB = d_magnitudeIB[indext_QB] / (fft_normalization_factor * fft_normalization_factor);
                                     }
@@ -16,14 +16,14 @@
  */
 
 #include "galileo_pcps_8ms_acquisition_cc.h"
-#include "MATH_CONSTANTS.h"
 #include <glog/logging.h>
 #include <gnuradio/io_signature.h>
 #include <volk/volk.h>
 #include <volk_gnsssdr/volk_gnsssdr.h>
-#include <array>
 #include <exception>
+#include <memory>
 #include <sstream>
+#include <vector>
 
 
 galileo_pcps_8ms_acquisition_cc_sptr galileo_pcps_8ms_make_acquisition_cc(
@@ -87,8 +87,7 @@ galileo_pcps_8ms_acquisition_cc::galileo_pcps_8ms_acquisition_cc(
     d_fft_code_A = std::vector<gr_complex>(d_fft_size, lv_cmake(0.0F, 0.0F));
     d_fft_code_B = std::vector<gr_complex>(d_fft_size, lv_cmake(0.0F, 0.0F));
     d_magnitude = std::vector<float>(d_fft_size, 0.0F);
-    d_fft_if = gnss_fft_fwd_make_unique(d_fft_size);
-    d_ifft = gnss_fft_rev_make_unique(d_fft_size);
+    d_engine = std::make_unique<Acq_Pcps_Engine>(d_fs_in, d_fft_size);
 }
 
 
@@ -115,22 +114,14 @@ galileo_pcps_8ms_acquisition_cc::~galileo_pcps_8ms_acquisition_cc()
 void galileo_pcps_8ms_acquisition_cc::set_local_code(std::complex<float> *code)
 {
     // code A: two replicas of a primary code
-    memcpy(d_fft_if->get_inbuf(), code, sizeof(gr_complex) * d_fft_size);
-
-    d_fft_if->execute();  // We need the FFT of local code
-
-    // Conjugate the local code
-    volk_32fc_conjugate_32fc(d_fft_code_A.data(), d_fft_if->get_outbuf(), d_fft_size);
+    d_engine->code_spectrum(code, d_fft_code_A.data());
 
     // code B: two replicas of a primary code; the second replica is inverted.
-    volk_32fc_s32fc_multiply_32fc(&(d_fft_if->get_inbuf())[d_samples_per_code],
+    std::vector<gr_complex> code_B(code, code + d_fft_size);
+    volk_32fc_s32fc_multiply_32fc(&code_B[d_samples_per_code],
         &code[d_samples_per_code], gr_complex(-1, 0),
         d_samples_per_code);
-
-    d_fft_if->execute();  // We need the FFT of local code
-
-    // Conjugate the local code
-    volk_32fc_conjugate_32fc(d_fft_code_B.data(), d_fft_if->get_outbuf(), d_fft_size);
+    d_engine->code_spectrum(code_B.data(), d_fft_code_B.data());
 }
 
 
@@ -147,23 +138,9 @@ void galileo_pcps_8ms_acquisition_cc::init()
     d_mag = 0.0;
     d_input_power = 0.0;
 
-    // Count the number of bins
-    d_num_doppler_bins = 0;
-    for (auto doppler = static_cast<int32_t>(-d_doppler_max);
-         doppler <= static_cast<int32_t>(d_doppler_max);
-         doppler += d_doppler_step)
-        {
-            d_num_doppler_bins++;
-        }
-    // Create the carrier Doppler wipeoff signals
-    d_grid_doppler_wipeoffs = std::vector<std::vector<gr_complex>>(d_num_doppler_bins, std::vector<gr_complex>(d_fft_size));
-    for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
-        {
-            int32_t doppler = -static_cast<int32_t>(d_doppler_max) + d_doppler_step * doppler_index;
-            float phase_step_rad = static_cast<float>(TWO_PI) * doppler / static_cast<float>(d_fs_in);
-            std::array<float, 1> _phase{};
-            volk_gnsssdr_s32f_sincos_32fc(d_grid_doppler_wipeoffs[doppler_index].data(), -phase_step_rad, _phase.data(), d_fft_size);
-        }
+    // Set the Doppler grid
+    d_engine->set_doppler_grid(std::string(d_gnss_synchro->Signal, 2), static_cast<int32_t>(d_doppler_max), static_cast<int32_t>(d_doppler_step));
+    d_num_doppler_bins = d_engine->num_doppler_bins();
 }
 
 
@@ -258,40 +235,23 @@ int galileo_pcps_8ms_acquisition_cc::general_work(int noutput_items,
                         // doppler search steps
                         doppler = -static_cast<int32_t>(d_doppler_max) + d_doppler_step * doppler_index;
 
-                        volk_32fc_x2_multiply_32fc(d_fft_if->get_inbuf(), in,
-                            d_grid_doppler_wipeoffs[doppler_index].data(), d_fft_size);
-
                         // 3- Perform the FFT-based convolution  (parallel time search)
-                        // Compute the FFT of the carrier wiped--off incoming signal
-                        d_fft_if->execute();
-
-                        // Multiply carrier wiped--off, Fourier transformed incoming signal
-                        // with the local FFT'd code A reference using SIMD operations with
-                        // VOLK library
-                        volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(),
-                            d_fft_if->get_outbuf(), d_fft_code_A.data(), d_fft_size);
-
-                        // compute the inverse FFT
-                        d_ifft->execute();
+                        // of the carrier wiped--off incoming signal with the local code A
+                        d_engine->input_spectrum(in, d_sample_counter, doppler_index);
+                        const gr_complex *correlation = d_engine->correlate(d_fft_code_A.data());
 
                         // Search maximum
-                        volk_32fc_magnitude_squared_32f(d_magnitude.data(), d_ifft->get_outbuf(), d_fft_size);
+                        volk_32fc_magnitude_squared_32f(d_magnitude.data(), correlation, d_fft_size);
                         volk_gnsssdr_32f_index_max_32u(&indext_A, d_magnitude.data(), d_fft_size);
 
                         // Normalize the maximum value to correct the scale factor introduced by FFTW
                         magt_A = d_magnitude[indext_A] / (fft_normalization_factor * fft_normalization_factor);
 
-                        // Multiply carrier wiped--off, Fourier transformed incoming signal
-                        // with the local FFT'd code B reference using SIMD operations with
-                        // VOLK library
-                        volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(),
-                            d_fft_if->get_outbuf(), d_fft_code_B.data(), d_fft_size);
-
-                        // compute the inverse FFT
-                        d_ifft->execute();
+                        // Correlate with the local code B
+                        correlation = d_engine->correlate(d_fft_code_B.data());
 
                         // Search maximum
-                        volk_32fc_magnitude_squared_32f(d_magnitude.data(), d_ifft->get_outbuf(), d_fft_size);
+                        volk_32fc_magnitude_squared_32f(d_magnitude.data(), correlation, d_fft_size);
                         volk_gnsssdr_32f_index_max_32u(&indext_B, d_magnitude.data(), d_fft_size);
 
                         // Normalize the maximum value to correct the scale factor introduced by FFTW
@@ -329,7 +289,7 @@ int galileo_pcps_8ms_acquisition_cc::general_work(int noutput_items,
                                          << "_" << d_gnss_synchro->Signal[0] << d_gnss_synchro->Signal[1] << "_sat_"
                                          << d_gnss_synchro->PRN << "_doppler_" << doppler << ".dat";
                                 d_dump_file.open(filename.str().c_str(), std::ios::out | std::ios::binary);
-                                d_dump_file.write(reinterpret_cast<char *>(d_ifft->get_outbuf()), n);  // write directly |abs(x)|^2 in this Doppler bin?
+                                d_dump_file.write(reinterpret_cast<const char *>(correlation), n);  // write directly |abs(x)|^2 in this Doppler bin?
                                 d_dump_file.close();
                             }
                     }
@@ -18,8 +18,8 @@
 #ifndef GNSS_SDR_PCPS_8MS_ACQUISITION_CC_H
 #define GNSS_SDR_PCPS_8MS_ACQUISITION_CC_H
 
+#include "acq_pcps_engine.h"
 #include "channel_fsm.h"
-#include "gnss_sdr_fft.h"
 #include "gnss_synchro.h"
 #include <gnuradio/block.h>
 #include <gnuradio/gr_complex.h>
@@ -190,10 +190,8 @@ private:
         int32_t doppler_offset);
 
     std::weak_ptr<ChannelFsm> d_channel_fsm;
-    std::unique_ptr<gnss_fft_complex_fwd> d_fft_if;
-    std::unique_ptr<gnss_fft_complex_rev> d_ifft;
+    std::unique_ptr<Acq_Pcps_Engine> d_engine;
 
-    std::vector<std::vector<gr_complex>> d_grid_doppler_wipeoffs;
     std::vector<gr_complex> d_fft_code_A;
     std::vector<gr_complex> d_fft_code_B;
     std::vector<float> d_magnitude;
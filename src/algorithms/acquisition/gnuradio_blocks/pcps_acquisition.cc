@@ -20,26 +20,33 @@
  */
 
 #include "pcps_acquisition.h"
-#include "GLONASS_L1_L2_CA.h"  // for GLONASS_PRN
-#include "MATH_CONSTANTS.h"    // for TWO_PI
+#include "GLONASS_L1_L2_CA.h"         // for GLONASS_PRN
+#include "MATH_CONSTANTS.h"           // for TWO_PI
+#include "acq_code_spectrum_cache.h"  // for Acq_Code_Spectrum_Cache
+#include "acq_workspace_pool.h"       // for Acq_Workspace_Pool
 #include "gnss_frequencies.h"
 #include "gnss_sdr_create_directory.h"
 #include "gnss_sdr_filesystem.h"
+#include "gnss_sdr_make_unique.h"
 #include "gnss_synchro.h"
+#include "gnss_trace.h"
 #include <boost/math/special_functions/gamma.hpp>
 #include <gnuradio/io_signature.h>
-#include <matio.h>
 #include <pmt/pmt.h>        // for from_long
 #include <pmt/pmt_sugar.h>  // for mp
 #include <volk/volk.h>
 #include <volk_gnsssdr/volk_gnsssdr.h>
-#include <algorithm>  // for fill_n, min
+#include <algorithm>  // for copy_n, fill_n, min
 #include <array>
 #include <cmath>    // for floor, fmod, rint, ceil
 #include <cstring>  // for memcpy
 #include <iostream>
 #include <map>
 
+#if OPENCL_BLOCKS
+#include "acq_opencl_engine.h"
+#endif
+
 
 pcps_acquisition_sptr pcps_make_acquisition(const Acq_Conf& conf_)
 {
@@ -49,14 +56,17 @@ pcps_acquisition_sptr pcps_make_acquisition(const Acq_Conf& conf_)
 
 pcps_acquisition::pcps_acquisition(const Acq_Conf& conf_)
     : gr::block("pcps_acquisition",
-          gr::io_signature::make(1, 1, conf_.it_size),
+          gr::io_signature::make(1, conf_.fdma_channelized ? GLONASS_MAX_FREQUENCY_NUMBER - GLONASS_MIN_FREQUENCY_NUMBER + 1 : 1, conf_.it_size),
           gr::io_signature::make(0, 1, sizeof(Gnss_Synchro))),
       d_acq_parameters(conf_),
       d_gnss_synchro(nullptr),
       d_dump_filename(conf_.dump_filename),
       d_dump_number(0LL),
       d_sample_counter(0ULL),
+      d_assist_code_epoch_s(0.0),
+      d_assist_code_period_s(0.0),
       d_threshold(0.0),
+      d_coarse_threshold(0.0),
       d_mag(0),
       d_input_power(0.0),
       d_test_statistics(0.0),
@@ -74,10 +84,25 @@ pcps_acquisition::pcps_acquisition(const Acq_Conf& conf_)
       d_num_doppler_bins_step2(conf_.num_doppler_bins_step2),
       d_dump_channel(conf_.dump_channel),
       d_buffer_count(0U),
+      d_fill_buffer(0U),
+      d_fdma_input(0U),
+      d_folding_factor(std::max(conf_.folding_factor, 1U)),
+      d_folded_fft_size(0U),
+      d_coarse_decimation(std::max(conf_.coarse_decimation, 1U)),
+      d_coarse_fft_size(0U),
+      d_code_window_half_samples(0U),
+      d_code_window_center(0U),
+      d_assist_first_bin(0U),
+      d_assist_num_bins(0U),
       d_active(false),
       d_worker_active(false),
+      d_prefetch_dwell(false),
       d_step_two(false),
       d_use_CFAR_algorithm_flag(conf_.use_CFAR_algorithm_flag),
+      d_batch_doppler_fft(conf_.batch_doppler_fft),
+      d_use_shared_front_end(conf_.shared_front_end),
+      d_pooled_workspace(conf_.pooled_workspace),
+      d_high_sensitivity(false),
       d_dump(conf_.dump)
 {
     this->message_port_register_out(pmt::mp("events"));
@@ -92,6 +117,33 @@ pcps_acquisition::pcps_acquisition(const Acq_Conf& conf_)
         }
     // d_fft_size = next power of two?  ////
 
+    // High sensitivity: the dwell is integrated coherently over its code
+    // periods by Acq_High_Sensitivity_Search, which only correlates one code
+    // period at a time
+    if (conf_.high_sensitivity)
+        {
+            const double code_periods = static_cast<double>(conf_.sampled_ms) / static_cast<double>(conf_.ms_per_code);
+            if (conf_.bit_transition_flag or !d_use_CFAR_algorithm_flag or conf_.make_2_steps or (d_folding_factor > 1) or (d_coarse_decimation > 1) or conf_.use_opencl or
+                (std::fabs(conf_.samples_per_code - std::round(conf_.samples_per_code)) > 1e-6) or (std::fabs(code_periods - std::round(code_periods)) > 1e-6) or (code_periods < 2.0))
+                {
+                    LOG(WARNING) << "Acquisition high_sensitivity=true ignored: it requires bit_transition_flag=false, pfa > 0, make_2_steps=false, "
+                                 << "folding_factor=1, coarse_decimation=1, use_opencl=false, a code period of a whole number of samples "
+                                 << "and coherent_integration_time_ms of two code periods or more";
+                }
+            else
+                {
+                    d_high_sensitivity = true;
+                    // the wipeoffs, grids and FFT plans of the block are only used for one code period
+                    d_fft_size = static_cast<uint32_t>(std::round(conf_.samples_per_code));
+                    if (d_batch_doppler_fft or d_use_shared_front_end)
+                        {
+                            LOG(WARNING) << "Acquisition batch_doppler_fft and shared_front_end are not used when high_sensitivity=true";
+                            d_batch_doppler_fft = false;
+                            d_use_shared_front_end = false;
+                        }
+                }
+        }
+
     // COD:
     // Experimenting with the overlap/save technique for handling bit trannsitions
     // The problem: Circular correlation is asynchronous with the received code.
@@ -108,28 +160,123 @@ pcps_acquisition::pcps_acquisition(const Acq_Conf& conf_)
     //  d_acq_parameters.max_dwells = 1;  // Activation of d_acq_parameters.bit_transition_flag invalidates the value of d_acq_parameters.max_dwells
     // }
 
-    d_tmp_buffer = volk_gnsssdr::vector<float>(d_fft_size);
     d_fft_codes = volk_gnsssdr::vector<std::complex<float>>(d_fft_size);
-    d_input_signal = volk_gnsssdr::vector<std::complex<float>>(d_fft_size);
-    d_fft_if = gnss_fft_fwd_make_unique(d_fft_size);
-    d_ifft = gnss_fft_rev_make_unique(d_fft_size);
+    if (!d_pooled_workspace)
+        {
+            d_tmp_buffer = volk_gnsssdr::vector<float>(d_fft_size);
+            d_fft_if = gnss_fft_fwd_make_unique(d_fft_size);
+            d_ifft = gnss_fft_rev_make_unique(d_fft_size);
+        }
+
+    // Folded (sparse-FFT) search: the input and the local code are folded
+    // into d_fft_size / d_folding_factor samples before the FFT-based correlation
+    if (d_folding_factor > 1)
+        {
+            if (d_acq_parameters.bit_transition_flag or !d_use_CFAR_algorithm_flag or (d_fft_size % d_folding_factor != 0))
+                {
+                    LOG(WARNING) << "Acquisition folding_factor=" << d_folding_factor << " ignored: it requires bit_transition_flag=false, "
+                                 << "pfa > 0 and an FFT size (" << d_fft_size << ") multiple of the folding factor";
+                    d_folding_factor = 1U;
+                }
+        }
+    if (d_folding_factor > 1)
+        {
+            if (d_batch_doppler_fft or d_use_shared_front_end)
+                {
+                    LOG(WARNING) << "Acquisition batch_doppler_fft and shared_front_end are not used when folding_factor > 1";
+                    d_batch_doppler_fft = false;
+                    d_use_shared_front_end = false;
+                }
+            d_folded_fft_size = d_fft_size / d_folding_factor;
+            d_local_code = volk_gnsssdr::vector<std::complex<float>>(d_fft_size);
+            d_wiped_signal = volk_gnsssdr::vector<std::complex<float>>(d_fft_size);
+            d_fft_codes_folded = volk_gnsssdr::vector<std::complex<float>>(d_folded_fft_size);
+            d_folded_magnitude = volk_gnsssdr::vector<float>(d_folded_fft_size);
+            d_fft_folded = gnss_fft_fwd_make_unique(d_folded_fft_size);
+            d_ifft_folded = gnss_fft_rev_make_unique(d_folded_fft_size);
+        }
 
-    d_grid = arma::fmat();
-    d_narrow_grid = arma::fmat();
+    // Integer samples are converted to float when they are stored in the dwell buffers
+    d_cshort = (conf_.it_size == sizeof(lv_16sc_t));
+    d_cbyte = (conf_.it_size == sizeof(lv_8sc_t));
 
-    if (conf_.it_size == sizeof(gr_complex))
+    // Native cshort search: the carrier wipeoff is done on the 16-bit samples
+    // (cbyte samples are widened to 16 bits), which are converted to float
+    // only at the FFT input
+    d_native_cshort = (d_cshort or d_cbyte) and conf_.native_cshort;
+    if (d_native_cshort and ((d_folding_factor > 1) or d_batch_doppler_fft or d_use_shared_front_end or d_high_sensitivity))
         {
-            d_cshort = false;
+            LOG(WARNING) << "Acquisition native_cshort is not used together with folding_factor, batch_doppler_fft, shared_front_end or high_sensitivity";
+            d_native_cshort = false;
         }
-    else
+
+    // Hierarchical search: a detection at the sample rate decimated by
+    // d_coarse_decimation selects the satellites worth the full search
+    if (d_coarse_decimation > 1)
         {
-            d_cshort = true;
+            if (d_acq_parameters.bit_transition_flag or !d_use_CFAR_algorithm_flag or (d_fft_size % d_coarse_decimation != 0) or (d_folding_factor > 1) or d_native_cshort)
+                {
+                    LOG(WARNING) << "Acquisition coarse_decimation=" << d_coarse_decimation << " ignored: it requires bit_transition_flag=false, "
+                                 << "pfa > 0, folding_factor=1, native_cshort=false and an FFT size (" << d_fft_size << ") multiple of the decimation";
+                    d_coarse_decimation = 1U;
+                }
+        }
+    if (d_coarse_decimation > 1)
+        {
+            d_coarse_fft_size = d_fft_size / d_coarse_decimation;
+            d_fft_codes_coarse = volk_gnsssdr::vector<std::complex<float>>(d_coarse_fft_size);
+            d_coarse_signal = volk_gnsssdr::vector<std::complex<float>>(d_coarse_fft_size);
+            d_coarse_magnitude = volk_gnsssdr::vector<float>(d_coarse_fft_size);
+            d_fft_coarse = gnss_fft_fwd_make_unique(d_coarse_fft_size);
+            d_ifft_coarse = gnss_fft_rev_make_unique(d_coarse_fft_size);
         }
 
-    d_data_buffer = volk_gnsssdr::vector<std::complex<float>>(d_consumed_samples);
-    if (d_cshort)
+    // OpenCL backend: the Doppler bins are searched in batches on a GPU
+    if (conf_.use_opencl)
         {
-            d_data_buffer_sc = volk_gnsssdr::vector<lv_16sc_t>(d_consumed_samples);
+#if OPENCL_BLOCKS
+            if ((d_folding_factor > 1) or d_native_cshort)
+                {
+                    LOG(WARNING) << "Acquisition use_opencl is not used together with folding_factor or native_cshort";
+                }
+            else
+                {
+                    d_opencl_engine = Acq_Opencl_Engine::make(d_fft_size, conf_.opencl_batch_bins);
+                }
+            if (d_opencl_engine)
+                {
+                    if (d_batch_doppler_fft or d_use_shared_front_end)
+                        {
+                            LOG(WARNING) << "Acquisition batch_doppler_fft and shared_front_end are not used when use_opencl=true";
+                            d_batch_doppler_fft = false;
+                            d_use_shared_front_end = false;
+                        }
+                }
+            else
+                {
+                    LOG(WARNING) << "Acquisition OpenCL backend not available, the search runs on the CPU";
+                }
+#else
+            LOG(WARNING) << "Acquisition use_opencl=true ignored: GNSS-SDR was built without OpenCL support (ENABLE_OPENCL=OFF)";
+#endif
+        }
+
+    // Dwells are written directly into FFT-sized, zero-padded buffers. While a
+    // non-blocking search runs on one of them, the next dwell can fill the other.
+    if (d_native_cshort)
+        {
+            for (auto& dwell_buffer : d_dwell_buffers_sc)
+                {
+                    dwell_buffer = volk_gnsssdr::vector<lv_16sc_t>(std::max(d_fft_size, d_consumed_samples));
+                }
+            d_wiped_signal_sc = volk_gnsssdr::vector<lv_16sc_t>(d_fft_size);
+        }
+    else
+        {
+            for (auto& dwell_buffer : d_dwell_buffers)
+                {
+                    dwell_buffer = volk_gnsssdr::vector<std::complex<float>>(std::max(d_fft_size, d_consumed_samples));
+                }
         }
 
     if (d_dump)
@@ -166,6 +313,17 @@ pcps_acquisition::pcps_acquisition(const Acq_Conf& conf_)
 }
 
 
+pcps_acquisition::~pcps_acquisition()
+{
+    // Make sure that no acquisition job referring to this block is left in the pool
+    const auto thread_pool = d_thread_pool.lock();
+    if (thread_pool)
+        {
+            thread_pool->cancel(this);
+        }
+}
+
+
 void pcps_acquisition::set_resampler_latency(uint32_t latency_samples)
 {
     gr::thread::scoped_lock lock(d_setlock);  // require mutex with work function called by the scheduler
@@ -185,6 +343,38 @@ void pcps_acquisition::set_local_code(std::complex<float>* code)
     // [ 0 0 0 ... 0 c_0 c_1 ... c_L]
     // where c_i is the local code and there are L zeros and L chips
     gr::thread::scoped_lock lock(d_setlock);  // require mutex with work function called by the scheduler
+    if (d_high_sensitivity_search)
+        {
+            // the first code period of the code
+            d_high_sensitivity_search->set_code(code);
+            return;
+        }
+    // with the pooled workspace, the FFT plans are only held while searching
+    const bool borrowed = d_pooled_workspace and !d_fft_if;
+    if (borrowed)
+        {
+            borrow_workspace();
+        }
+    compute_code_spectra(code);
+    if (borrowed)
+        {
+            give_back_workspace();
+        }
+}
+
+
+void pcps_acquisition::compute_code_spectra(const std::complex<float>* code)
+{
+    if (d_acq_parameters.fdma_channelized)
+        {
+            // the channelizer provides one input per FDMA sub-band, the one of this satellite is read
+            const int32_t frequency_number = GLONASS_PRN.at(d_gnss_synchro->PRN);
+            if (frequency_number < GLONASS_MIN_FREQUENCY_NUMBER or frequency_number > GLONASS_MAX_FREQUENCY_NUMBER)
+                {
+                    LOG(WARNING) << "Channel " << d_channel << ": no FDMA sub-band for the frequency number " << frequency_number << " of PRN " << d_gnss_synchro->PRN;
+                }
+            d_fdma_input = static_cast<uint32_t>(std::min(std::max(frequency_number, GLONASS_MIN_FREQUENCY_NUMBER), GLONASS_MAX_FREQUENCY_NUMBER) - GLONASS_MIN_FREQUENCY_NUMBER);
+        }
     if (d_acq_parameters.bit_transition_flag)
         {
             const int32_t offset = d_fft_size / 2;
@@ -204,8 +394,50 @@ void pcps_acquisition::set_local_code(std::complex<float>* code)
                 }
         }
 
+    if (d_folding_factor > 1)
+        {
+            // Keep the local code for the code phase disambiguation
+            memcpy(d_local_code.data(), d_fft_if->get_inbuf(), sizeof(gr_complex) * d_fft_size);
+        }
+
+    if (d_coarse_decimation > 1)
+        {
+            // FFT of the code decimated as the input of the coarse detection
+            decimate(d_fft_if->get_inbuf(), d_fft_coarse->get_inbuf());
+            d_fft_coarse->execute();
+            volk_32fc_conjugate_32fc(d_fft_codes_coarse.data(), d_fft_coarse->get_outbuf(), d_coarse_fft_size);
+        }
+
+#if OPENCL_BLOCKS
+    if (d_opencl_engine and !d_opencl_engine->set_local_code(d_fft_if->get_inbuf()))
+        {
+            LOG(WARNING) << "Channel " << d_channel << ": OpenCL acquisition failed, the search runs on the CPU";
+            d_opencl_engine.reset();
+        }
+#endif
+
+    // Other channels have likely computed the same spectra already
+    const uint32_t folded_fft_size = d_folding_factor > 1 ? d_folded_fft_size : 0U;
+    if (Acq_Code_Spectrum_Cache::get().fetch(d_fft_if->get_inbuf(), d_fft_size, folded_fft_size, d_fft_codes.data(), d_fft_codes_folded.data()))
+        {
+            return;
+        }
+
+    if (d_folding_factor > 1)
+        {
+            // FFT of the folded code
+            memcpy(d_fft_folded->get_inbuf(), d_local_code.data(), sizeof(gr_complex) * d_folded_fft_size);
+            for (uint32_t k = 1; k < d_folding_factor; k++)
+                {
+                    volk_32f_x2_add_32f(reinterpret_cast<float*>(d_fft_folded->get_inbuf()), reinterpret_cast<float*>(d_fft_folded->get_inbuf()), reinterpret_cast<float*>(d_local_code.data() + k * d_folded_fft_size), 2 * d_folded_fft_size);
+                }
+            d_fft_folded->execute();
+            volk_32fc_conjugate_32fc(d_fft_codes_folded.data(), d_fft_folded->get_outbuf(), d_folded_fft_size);
+        }
+
     d_fft_if->execute();  // We need the FFT of local code
     volk_32fc_conjugate_32fc(d_fft_codes.data(), d_fft_if->get_outbuf(), d_fft_size);
+    Acq_Code_Spectrum_Cache::get().store(d_fft_if->get_inbuf(), d_fft_size, folded_fft_size, d_fft_codes.data(), d_fft_codes_folded.data());
 }
 
 
@@ -213,6 +445,11 @@ bool pcps_acquisition::is_fdma()
 {
     // reset the intermediate frequency
     d_doppler_bias = 0;
+    if (d_acq_parameters.fdma_channelized)
+        {
+            // the channelizer has already brought the sub-band of the satellite to baseband
+            return false;
+        }
     // Dealing with FDMA system
     if (strcmp(d_gnss_synchro->Signal, "1G") == 0)
         {
@@ -246,6 +483,15 @@ void pcps_acquisition::update_local_carrier(own::span<gr_complex> carrier_vector
 }
 
 
+gr_complex pcps_acquisition::doppler_phase_increment(float freq) const
+{
+    // Per-sample phasor of the carrier generated by update_local_carrier()
+    const auto fs = static_cast<float>(d_acq_parameters.use_automatic_resampler ? d_acq_parameters.resampled_fs : d_acq_parameters.fs_in);
+    const float phase_step_rad = static_cast<float>(TWO_PI) * freq / fs;
+    return gr_complex(std::cos(phase_step_rad), -std::sin(phase_step_rad));
+}
+
+
 void pcps_acquisition::init()
 {
     d_gnss_synchro->Flag_valid_acquisition = false;
@@ -262,54 +508,229 @@ void pcps_acquisition::init()
     d_num_doppler_bins = static_cast<uint32_t>(std::ceil(static_cast<double>(static_cast<int32_t>(d_acq_parameters.doppler_max) - static_cast<int32_t>(-d_acq_parameters.doppler_max)) / static_cast<double>(d_doppler_step)));
 
     // Create the carrier Doppler wipeoff signals
-    if (d_grid_doppler_wipeoffs.empty())
+    // (shared among channels if a shared front end is used)
+    if (d_grid_doppler_wipeoffs.empty() and !d_use_shared_front_end and !d_native_cshort)
         {
             d_grid_doppler_wipeoffs = volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>>(d_num_doppler_bins, volk_gnsssdr::vector<std::complex<float>>(d_fft_size));
         }
-    if (d_acq_parameters.make_2_steps && (d_grid_doppler_wipeoffs_step_two.empty()))
+    if (d_acq_parameters.make_2_steps && (d_grid_doppler_wipeoffs_step_two.empty()) && !d_native_cshort)
         {
             d_grid_doppler_wipeoffs_step_two = volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>>(d_num_doppler_bins_step2, volk_gnsssdr::vector<std::complex<float>>(d_fft_size));
         }
-
-    if (d_magnitude_grid.empty())
+    if (d_coarse_decimation > 1 and d_grid_doppler_wipeoffs_coarse.size() != d_num_doppler_bins)
         {
-            d_magnitude_grid = volk_gnsssdr::vector<volk_gnsssdr::vector<float>>(d_num_doppler_bins, volk_gnsssdr::vector<float>(d_fft_size));
+            d_grid_doppler_wipeoffs_coarse = volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>>(d_num_doppler_bins, volk_gnsssdr::vector<std::complex<float>>(d_coarse_fft_size));
+            d_coarse_bin_max = std::vector<float>(d_num_doppler_bins);
+            d_coarse_bin_power = std::vector<float>(d_num_doppler_bins);
         }
 
-    for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
+    if (!d_acq_parameters.release_idle_grid and !d_pooled_workspace)
         {
-            std::fill(d_magnitude_grid[doppler_index].begin(), d_magnitude_grid[doppler_index].end(), 0.0);
+            // otherwise, acquisition_core() allocates it when searching
+            allocate_magnitude_grid();
         }
 
     update_grid_doppler_wipeoffs();
     d_worker_active = false;
 
+    if (d_high_sensitivity and !d_high_sensitivity_search)
+        {
+            const int64_t fs = (d_acq_parameters.use_automatic_resampler ? d_acq_parameters.resampled_fs : d_acq_parameters.fs_in);
+            const auto code_periods = static_cast<uint32_t>(std::round(static_cast<double>(d_acq_parameters.sampled_ms) / static_cast<double>(d_acq_parameters.ms_per_code)));
+            d_high_sensitivity_search = std::make_unique<Acq_High_Sensitivity_Search>(fs, d_fft_size, code_periods,
+                static_cast<int32_t>(d_acq_parameters.doppler_max), d_acq_parameters.doppler_rate_max, d_acq_parameters.doppler_rate_step);
+        }
+
     if (d_dump)
         {
             const uint32_t effective_fft_size = (d_acq_parameters.bit_transition_flag ? (d_fft_size / 2) : d_fft_size);
-            d_grid = arma::fmat(effective_fft_size, d_num_doppler_bins, arma::fill::zeros);
-            d_narrow_grid = arma::fmat(effective_fft_size, d_num_doppler_bins_step2, arma::fill::zeros);
+            d_dump_grid.assign(static_cast<size_t>(effective_fft_size) * d_num_doppler_bins, 0.0);
+            d_dump_narrow_grid.assign(static_cast<size_t>(effective_fft_size) * d_num_doppler_bins_step2, 0.0);
         }
 }
 
 
 void pcps_acquisition::update_grid_doppler_wipeoffs()
 {
+    std::vector<double> doppler_freqs(d_num_doppler_bins);
+    if (d_native_cshort)
+        {
+            d_doppler_phase_inc.resize(d_num_doppler_bins);
+        }
     for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
         {
             const int32_t doppler = -static_cast<int32_t>(d_acq_parameters.doppler_max) + d_doppler_center + d_doppler_step * doppler_index;
-            update_local_carrier(d_grid_doppler_wipeoffs[doppler_index], static_cast<float>(d_doppler_bias + doppler));
+            if (d_native_cshort)
+                {
+                    d_doppler_phase_inc[doppler_index] = doppler_phase_increment(static_cast<float>(d_doppler_bias + doppler));
+                }
+            else if (!d_use_shared_front_end)
+                {
+                    update_local_carrier(d_grid_doppler_wipeoffs[doppler_index], static_cast<float>(d_doppler_bias + doppler));
+                }
+            if (d_coarse_decimation > 1)
+                {
+                    // a carrier of f at fs / D has the phase steps of a carrier of D * f at fs
+                    update_local_carrier(d_grid_doppler_wipeoffs_coarse[doppler_index], static_cast<float>(d_coarse_decimation) * static_cast<float>(d_doppler_bias + doppler));
+                }
+            doppler_freqs[doppler_index] = static_cast<double>(d_doppler_bias + doppler);
+        }
+    if (d_batch_doppler_fft)
+        {
+            plan_doppler_batch(doppler_freqs, d_doppler_batch);
+        }
+#if OPENCL_BLOCKS
+    if (d_opencl_engine and !d_opencl_engine->set_wipeoffs(0U, d_grid_doppler_wipeoffs))
+        {
+            LOG(WARNING) << "Channel " << d_channel << ": OpenCL acquisition failed, the search runs on the CPU";
+            d_opencl_engine.reset();
+        }
+#endif
+    if (d_use_shared_front_end and d_num_doppler_bins > 0)
+        {
+            const std::string signal = (d_gnss_synchro == nullptr ? std::string() : std::string(d_gnss_synchro->Signal, 2));
+            const int64_t fs = d_acq_parameters.use_automatic_resampler ? d_acq_parameters.resampled_fs : d_acq_parameters.fs_in;
+            const uint32_t num_spectra = use_doppler_batch(d_doppler_batch, d_num_doppler_bins) ? static_cast<uint32_t>(d_doppler_batch.class_bin.size()) : d_num_doppler_bins;
+            d_shared_front_end = Acq_Shared_Front_End::get(signal, fs, d_fft_size, doppler_freqs, num_spectra);
         }
 }
 
 
 void pcps_acquisition::update_grid_doppler_wipeoffs_step2()
 {
+    std::vector<double> doppler_freqs(d_num_doppler_bins_step2);
+    if (d_native_cshort)
+        {
+            d_doppler_phase_inc_step_two.resize(d_num_doppler_bins_step2);
+        }
     for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins_step2; doppler_index++)
         {
             const float doppler = (static_cast<float>(doppler_index) - static_cast<float>(floor(d_num_doppler_bins_step2 / 2.0))) * d_acq_parameters.doppler_step2;
-            update_local_carrier(d_grid_doppler_wipeoffs_step_two[doppler_index], d_doppler_center_step_two + doppler);
+            if (d_native_cshort)
+                {
+                    d_doppler_phase_inc_step_two[doppler_index] = doppler_phase_increment(d_doppler_center_step_two + doppler);
+                }
+            else
+                {
+                    update_local_carrier(d_grid_doppler_wipeoffs_step_two[doppler_index], d_doppler_center_step_two + doppler);
+                }
+            doppler_freqs[doppler_index] = d_doppler_center_step_two + doppler;
+        }
+    if (d_batch_doppler_fft)
+        {
+            plan_doppler_batch(doppler_freqs, d_doppler_batch_step_two);
+        }
+#if OPENCL_BLOCKS
+    if (d_opencl_engine and !d_opencl_engine->set_wipeoffs(1U, d_grid_doppler_wipeoffs_step_two))
+        {
+            LOG(WARNING) << "Channel " << d_channel << ": OpenCL acquisition failed, the search runs on the CPU";
+            d_opencl_engine.reset();
+        }
+#endif
+}
+
+
+void pcps_acquisition::plan_doppler_batch(const std::vector<double>& doppler_freqs, Doppler_Batch_Plan& plan)
+{
+    // Multiplying the input by exp(-j*2*pi*m*n/N) shifts its N-point DFT by m bins,
+    // so Doppler bins separated by m * fs / N can reuse the same forward FFT.
+    // Frequencies are compared in mHz to absorb rounding errors.
+    const double fs = static_cast<double>(d_acq_parameters.use_automatic_resampler ? d_acq_parameters.resampled_fs : d_acq_parameters.fs_in);
+    const double fft_resolution_hz = fs / static_cast<double>(d_fft_size);
+    const auto fft_resolution_mhz = static_cast<int64_t>(std::llround(fft_resolution_hz * 1000.0));
+    const auto num_bins = static_cast<uint32_t>(doppler_freqs.size());
+
+    plan.bin_class = std::vector<uint32_t>(num_bins);
+    plan.bin_shift = std::vector<uint32_t>(num_bins);
+    plan.class_bin.clear();
+
+    std::map<int64_t, uint32_t> residual_to_class;
+    std::vector<int64_t> class_bin_offset;
+    for (uint32_t doppler_index = 0; doppler_index < num_bins; doppler_index++)
+        {
+            auto offset_bins = static_cast<int64_t>(std::floor(doppler_freqs[doppler_index] / fft_resolution_hz));
+            int64_t residual_mhz = std::llround((doppler_freqs[doppler_index] - static_cast<double>(offset_bins) * fft_resolution_hz) * 1000.0);
+            if (residual_mhz >= fft_resolution_mhz)
+                {
+                    residual_mhz -= fft_resolution_mhz;
+                    offset_bins++;
+                }
+            const auto it = residual_to_class.find(residual_mhz);
+            if (it == residual_to_class.end())
+                {
+                    residual_to_class[residual_mhz] = static_cast<uint32_t>(plan.class_bin.size());
+                    plan.bin_class[doppler_index] = static_cast<uint32_t>(plan.class_bin.size());
+                    plan.bin_shift[doppler_index] = 0U;
+                    plan.class_bin.push_back(doppler_index);
+                    class_bin_offset.push_back(offset_bins);
+                }
+            else
+                {
+                    const int64_t shift = (offset_bins - class_bin_offset[it->second]) % static_cast<int64_t>(d_fft_size);
+                    plan.bin_class[doppler_index] = it->second;
+                    plan.bin_shift[doppler_index] = static_cast<uint32_t>(shift < 0 ? shift + d_fft_size : shift);
+                }
         }
+
+    if (d_batch_spectra.size() < plan.class_bin.size())
+        {
+            d_batch_spectra.resize(plan.class_bin.size(), volk_gnsssdr::vector<std::complex<float>>(d_fft_size));
+        }
+    DLOG(INFO) << "Channel " << d_channel << ": " << num_bins << " Doppler bins served by "
+               << plan.class_bin.size() << " forward FFTs";
+}
+
+
+void pcps_acquisition::allocate_magnitude_grid()
+{
+    if (d_magnitude_grid.size() != d_num_doppler_bins)
+        {
+            d_magnitude_grid = volk_gnsssdr::vector<volk_gnsssdr::vector<float>>(d_num_doppler_bins, volk_gnsssdr::vector<float>(d_fft_size));
+        }
+    else
+        {
+            for (auto& magnitude : d_magnitude_grid)
+                {
+                    std::fill(magnitude.begin(), magnitude.end(), 0.0);
+                }
+        }
+}
+
+
+void pcps_acquisition::borrow_workspace()
+{
+    Acq_Workspace workspace = Acq_Workspace_Pool::get().borrow(d_fft_size);
+    d_fft_if = std::move(workspace.fft_if);
+    d_ifft = std::move(workspace.ifft);
+    d_magnitude_grid = std::move(workspace.magnitude_grid);
+    d_tmp_buffer = std::move(workspace.tmp_buffer);
+}
+
+
+void pcps_acquisition::give_back_workspace()
+{
+    Acq_Workspace workspace;
+    workspace.fft_if = std::move(d_fft_if);
+    workspace.ifft = std::move(d_ifft);
+    workspace.magnitude_grid = std::move(d_magnitude_grid);
+    workspace.tmp_buffer = std::move(d_tmp_buffer);
+    Acq_Workspace_Pool::get().give_back(d_fft_size, std::move(workspace));
+    // moved-from vectors are not guaranteed to be empty
+    d_magnitude_grid.clear();
+    d_tmp_buffer.clear();
+}
+
+
+pcps_acquisition::Search_Counts pcps_acquisition::search_counts() const
+{
+    Search_Counts counts{};
+    counts.dwells = d_dwells_searched.load();
+    counts.doppler_batched = d_dwells_doppler_batched.load();
+    counts.folded = d_dwells_folded.load();
+    counts.coarse = d_coarse_detections.load();
+    counts.opencl = d_dwells_opencl.load();
+    counts.code_window = d_dwells_code_window.load();
+    return counts;
 }
 
 
@@ -391,10 +812,40 @@ void pcps_acquisition::send_negative_acquisition()
 }
 
 
+void pcps_acquisition::stage_dump_grid(bool step_two)
+{
+    if (!d_dump or (d_channel != d_dump_channel))
+        {
+            return;
+        }
+    std::vector<float>& grid = (step_two ? d_dump_narrow_grid : d_dump_grid);
+    const uint32_t num_doppler_bins = (step_two ? d_num_doppler_bins_step2 : d_num_doppler_bins);
+    const size_t effective_fft_size = (d_acq_parameters.bit_transition_flag ? d_fft_size / 2 : d_fft_size);
+    for (uint32_t doppler_index = 0; doppler_index < num_doppler_bins; doppler_index++)
+        {
+            std::copy_n(d_magnitude_grid[doppler_index].data(), effective_fft_size, grid.data() + doppler_index * effective_fft_size);
+        }
+}
+
+
 void pcps_acquisition::dump_results(int32_t effective_fft_size)
 {
     d_dump_number++;
-    std::string filename = d_dump_filename;
+    if (!d_grid_recorder)
+        {
+            d_grid_recorder = std::make_unique<Acq_Grid_Recorder>(d_acq_parameters.dump_ring_size);
+        }
+    // The .mat file is written by the recorder thread. If it is lagging
+    // behind, this grid is dropped instead of stalling the acquisition.
+    Acq_Grid_Recorder::Record* record = d_grid_recorder->reserve();
+    if (record == nullptr)
+        {
+            LOG(WARNING) << "Acquisition dump ring is full, dropping grid " << d_dump_number << " of channel " << d_channel;
+            return;
+        }
+
+    std::string& filename = record->filename;
+    filename = d_dump_filename;
     filename.append("_");
     filename.append(1, d_gnss_synchro->System);
     filename.append("_");
@@ -408,93 +859,45 @@ void pcps_acquisition::dump_results(int32_t effective_fft_size)
     filename.append(std::to_string(d_gnss_synchro->PRN));
     filename.append(".mat");
 
-    mat_t* matfp = Mat_CreateVer(filename.c_str(), nullptr, MAT_FT_MAT73);
-    if (matfp == nullptr)
+    record->grid = d_dump_grid;
+    record->grid_rows = static_cast<size_t>(effective_fft_size);
+    record->grid_cols = static_cast<size_t>(d_num_doppler_bins);
+    record->doppler_max = d_acq_parameters.doppler_max;
+    record->doppler_step = static_cast<int32_t>(d_doppler_step);
+    record->positive_acq = d_positive_acq;
+    record->acq_doppler_hz = static_cast<float>(d_gnss_synchro->Acq_doppler_hz);
+    record->acq_delay_samples = static_cast<float>(d_gnss_synchro->Acq_delay_samples);
+    record->test_statistic = d_test_statistics;
+    record->threshold = d_threshold;
+    record->input_power = d_input_power;
+    record->sample_counter = d_sample_counter;
+    record->prn = d_gnss_synchro->PRN;
+    record->num_dwells = static_cast<int32_t>(d_num_noncoherent_integrations_counter);
+    record->two_steps = d_acq_parameters.make_2_steps;
+    if (record->two_steps)
         {
-            std::cout << "Unable to create or open Acquisition dump file\n";
-            // d_acq_parameters.dump = false;
+            record->narrow_grid = d_dump_narrow_grid;
+            record->narrow_grid_cols = static_cast<size_t>(d_num_doppler_bins_step2);
+            record->doppler_step_narrow = d_acq_parameters.doppler_step2;
+            record->doppler_grid_narrow_min = d_doppler_center_step_two - static_cast<float>(floor(d_num_doppler_bins_step2 / 2.0)) * d_acq_parameters.doppler_step2;
         }
-    else
-        {
-            std::array<size_t, 2> dims{static_cast<size_t>(effective_fft_size), static_cast<size_t>(d_num_doppler_bins)};
-            matvar_t* matvar = Mat_VarCreate("acq_grid", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims.data(), d_grid.memptr(), 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            dims[0] = static_cast<size_t>(1);
-            dims[1] = static_cast<size_t>(1);
-            matvar = Mat_VarCreate("doppler_max", MAT_C_INT32, MAT_T_INT32, 1, dims.data(), &d_acq_parameters.doppler_max, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("doppler_step", MAT_C_INT32, MAT_T_INT32, 1, dims.data(), &d_doppler_step, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("d_positive_acq", MAT_C_INT32, MAT_T_INT32, 1, dims.data(), &d_positive_acq, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            auto aux = static_cast<float>(d_gnss_synchro->Acq_doppler_hz);
-            matvar = Mat_VarCreate("acq_doppler_hz", MAT_C_SINGLE, MAT_T_SINGLE, 1, dims.data(), &aux, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            aux = static_cast<float>(d_gnss_synchro->Acq_delay_samples);
-            matvar = Mat_VarCreate("acq_delay_samples", MAT_C_SINGLE, MAT_T_SINGLE, 1, dims.data(), &aux, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("test_statistic", MAT_C_SINGLE, MAT_T_SINGLE, 1, dims.data(), &d_test_statistics, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("threshold", MAT_C_SINGLE, MAT_T_SINGLE, 1, dims.data(), &d_threshold, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("input_power", MAT_C_SINGLE, MAT_T_SINGLE, 1, dims.data(), &d_input_power, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("sample_counter", MAT_C_UINT64, MAT_T_UINT64, 1, dims.data(), &d_sample_counter, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("PRN", MAT_C_UINT32, MAT_T_UINT32, 1, dims.data(), &d_gnss_synchro->PRN, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            matvar = Mat_VarCreate("num_dwells", MAT_C_INT32, MAT_T_INT32, 1, dims.data(), &d_num_noncoherent_integrations_counter, 0);
-            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-            Mat_VarFree(matvar);
-
-            if (d_acq_parameters.make_2_steps)
-                {
-                    dims[0] = static_cast<size_t>(effective_fft_size);
-                    dims[1] = static_cast<size_t>(d_num_doppler_bins_step2);
-                    matvar = Mat_VarCreate("acq_grid_narrow", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims.data(), d_narrow_grid.memptr(), 0);
-                    Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-                    Mat_VarFree(matvar);
-
-                    dims[0] = static_cast<size_t>(1);
-                    dims[1] = static_cast<size_t>(1);
-                    matvar = Mat_VarCreate("doppler_step_narrow", MAT_C_SINGLE, MAT_T_SINGLE, 1, dims.data(), &d_acq_parameters.doppler_step2, 0);
-                    Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-                    Mat_VarFree(matvar);
+    d_grid_recorder->commit();
+}
 
-                    aux = d_doppler_center_step_two - static_cast<float>(floor(d_num_doppler_bins_step2 / 2.0)) * d_acq_parameters.doppler_step2;
-                    matvar = Mat_VarCreate("doppler_grid_narrow_min", MAT_C_SINGLE, MAT_T_SINGLE, 1, dims.data(), &aux, 0);
-                    Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
-                    Mat_VarFree(matvar);
-                }
 
-            Mat_Close(matfp);
+// Called by gnuradio when the flow graph stops
+bool pcps_acquisition::stop()
+{
+    // Make sure that the grids already recorded are on disk
+    if (d_grid_recorder)
+        {
+            d_grid_recorder->flush();
         }
+    return true;
 }
 
 
-float pcps_acquisition::max_to_input_power_statistic(uint32_t& indext, int32_t& doppler, uint32_t num_doppler_bins, int32_t doppler_max, int32_t doppler_step)
+float pcps_acquisition::max_to_input_power_statistic(uint32_t& indext, int32_t& doppler, uint32_t first_doppler_bin, uint32_t num_doppler_bins, int32_t doppler_max, int32_t doppler_step)
 {
     float grid_maximum = 0.0;
     uint32_t index_doppler = 0U;
@@ -503,9 +906,16 @@ float pcps_acquisition::max_to_input_power_statistic(uint32_t& indext, int32_t&
     const int32_t effective_fft_size = (d_acq_parameters.bit_transition_flag ? d_fft_size / 2 : d_fft_size);
 
     // Find the correlation peak and the carrier frequency
-    for (uint32_t i = 0; i < num_doppler_bins; i++)
+    for (uint32_t i = first_doppler_bin; i < first_doppler_bin + num_doppler_bins; i++)
         {
-            volk_gnsssdr_32f_index_max_32u(&tmp_intex_t, d_magnitude_grid[i].data(), effective_fft_size);
+            if (code_phase_assisted())
+                {
+                    tmp_intex_t = code_window_index_max(d_magnitude_grid[i].data());
+                }
+            else
+                {
+                    volk_gnsssdr_32f_index_max_32u(&tmp_intex_t, d_magnitude_grid[i].data(), effective_fft_size);
+                }
             if (d_magnitude_grid[i][tmp_intex_t] > grid_maximum)
                 {
                     grid_maximum = d_magnitude_grid[i][tmp_intex_t];
@@ -514,7 +924,24 @@ float pcps_acquisition::max_to_input_power_statistic(uint32_t& indext, int32_t&
                 }
         }
     indext = index_time;
-    if (!d_step_two)
+    if (!d_step_two and code_phase_assisted())
+        {
+            // The opposite Doppler bin has not been searched: estimate the
+            // noise from the code phases of the peak bin outside the window
+            float noise_sum = 0.0;
+            uint32_t noise_cells = 0U;
+            for (uint32_t i = 0; i < static_cast<uint32_t>(effective_fft_size); i++)
+                {
+                    if (!in_code_window(i))
+                        {
+                            noise_sum += d_magnitude_grid[index_doppler][i];
+                            noise_cells++;
+                        }
+                }
+            d_input_power = static_cast<float>(noise_sum / static_cast<float>(std::max(noise_cells, 1U)) / 2.0 / d_num_noncoherent_integrations_counter);
+            doppler = -static_cast<int32_t>(doppler_max) + d_doppler_center + doppler_step * static_cast<int32_t>(index_doppler);
+        }
+    else if (!d_step_two)
         {
             const auto index_opp = (index_doppler + d_num_doppler_bins / 2) % d_num_doppler_bins;
             d_input_power = static_cast<float>(std::accumulate(d_magnitude_grid[index_opp].data(), d_magnitude_grid[index_opp].data() + effective_fft_size, static_cast<float>(0.0)) / effective_fft_size / 2.0 / d_num_noncoherent_integrations_counter);
@@ -529,7 +956,7 @@ float pcps_acquisition::max_to_input_power_statistic(uint32_t& indext, int32_t&
 }
 
 
-float pcps_acquisition::first_vs_second_peak_statistic(uint32_t& indext, int32_t& doppler, uint32_t num_doppler_bins, int32_t doppler_max, int32_t doppler_step)
+float pcps_acquisition::first_vs_second_peak_statistic(uint32_t& indext, int32_t& doppler, uint32_t first_doppler_bin, uint32_t num_doppler_bins, int32_t doppler_max, int32_t doppler_step)
 {
     // Look for correlation peaks in the results
     // Find the highest peak and compare it to the second highest peak
@@ -541,9 +968,16 @@ float pcps_acquisition::first_vs_second_peak_statistic(uint32_t& indext, int32_t
     uint32_t index_time = 0U;
 
     // Find the correlation peak and the carrier frequency
-    for (uint32_t i = 0; i < num_doppler_bins; i++)
+    for (uint32_t i = first_doppler_bin; i < first_doppler_bin + num_doppler_bins; i++)
         {
-            volk_gnsssdr_32f_index_max_32u(&tmp_intex_t, d_magnitude_grid[i].data(), d_fft_size);
+            if (code_phase_assisted())
+                {
+                    tmp_intex_t = code_window_index_max(d_magnitude_grid[i].data());
+                }
+            else
+                {
+                    volk_gnsssdr_32f_index_max_32u(&tmp_intex_t, d_magnitude_grid[i].data(), d_fft_size);
+                }
             if (d_magnitude_grid[i][tmp_intex_t] > firstPeak)
                 {
                     firstPeak = d_magnitude_grid[i][tmp_intex_t];
@@ -590,7 +1024,14 @@ float pcps_acquisition::first_vs_second_peak_statistic(uint32_t& indext, int32_t
     while (idx != excludeRangeIndex2);
 
     // Find the second highest correlation peak in the same freq. bin ---
-    volk_gnsssdr_32f_index_max_32u(&tmp_intex_t, d_tmp_buffer.data(), d_fft_size);
+    if (code_phase_assisted())
+        {
+            tmp_intex_t = code_window_index_max(d_tmp_buffer.data());
+        }
+    else
+        {
+            volk_gnsssdr_32f_index_max_32u(&tmp_intex_t, d_tmp_buffer.data(), d_fft_size);
+        }
     const float secondPeak = d_tmp_buffer[tmp_intex_t];
 
     // Compute the test statistics and compare to the threshold
@@ -598,87 +1039,462 @@ float pcps_acquisition::first_vs_second_peak_statistic(uint32_t& indext, int32_t
 }
 
 
-void pcps_acquisition::acquisition_core(uint64_t samp_count)
+void pcps_acquisition::folded_correlation(const gr_complex* wiped_signal, float* magnitude)
 {
-    gr::thread::scoped_lock lk(d_setlock);
+    // Folding the input and the code by a factor p subsamples their spectra by p,
+    // so the d_folded_fft_size-point correlation is the full circular correlation
+    // aliased p times: corr_folded[m] = sum_k corr[m + k * d_folded_fft_size].
+    // The aliases of the folded peak are then resolved in the time domain.
+    const uint32_t folded_size = d_folded_fft_size;
+    memcpy(d_fft_folded->get_inbuf(), wiped_signal, sizeof(gr_complex) * folded_size);
+    for (uint32_t k = 1; k < d_folding_factor; k++)
+        {
+            volk_32f_x2_add_32f(reinterpret_cast<float*>(d_fft_folded->get_inbuf()), reinterpret_cast<float*>(d_fft_folded->get_inbuf()), reinterpret_cast<const float*>(wiped_signal + k * folded_size), 2 * folded_size);
+        }
+    d_fft_folded->execute();
+    volk_32fc_x2_multiply_32fc(d_ifft_folded->get_inbuf(), d_fft_folded->get_outbuf(), d_fft_codes_folded.data(), folded_size);
+    d_ifft_folded->execute();
+    volk_32fc_magnitude_squared_32f(d_folded_magnitude.data(), d_ifft_folded->get_outbuf(), folded_size);
+
+    // Each folded cell adds the noise of p cells: scale it to the noise level
+    // of the full-size search, so the CFAR statistic remains valid
+    volk_32f_s32f_multiply_32f(d_folded_magnitude.data(), d_folded_magnitude.data(), static_cast<float>(d_folding_factor), folded_size);
+    for (uint32_t k = 0; k < d_folding_factor; k++)
+        {
+            memcpy(magnitude + k * folded_size, d_folded_magnitude.data(), sizeof(float) * folded_size);
+        }
 
-    // Initialize acquisition algorithm
-    int32_t doppler = 0;
-    uint32_t indext = 0U;
-    const int32_t effective_fft_size = (d_acq_parameters.bit_transition_flag ? d_fft_size / 2 : d_fft_size);
+    // Evaluate the exact correlation at the p code phases aliased into the folded peak
+    uint32_t folded_index = 0U;
+    volk_gnsssdr_32f_index_max_32u(&folded_index, d_folded_magnitude.data(), folded_size);
+    const auto fft_size = static_cast<float>(d_fft_size);
+    for (uint32_t k = 0; k < d_folding_factor; k++)
+        {
+            const uint32_t code_phase = folded_index + k * folded_size;
+            gr_complex corr_head(0.0, 0.0);
+            gr_complex corr_tail(0.0, 0.0);
+            volk_32fc_x2_conjugate_dot_prod_32fc(&corr_head, wiped_signal + code_phase, d_local_code.data(), d_fft_size - code_phase);
+            if (code_phase > 0)
+                {
+                    volk_32fc_x2_conjugate_dot_prod_32fc(&corr_tail, wiped_signal, d_local_code.data() + (d_fft_size - code_phase), code_phase);
+                }
+            // Same scale as the (unnormalized) FFT-based correlation
+            magnitude[code_phase] = std::norm(corr_head + corr_tail) * fft_size * fft_size;
+        }
+}
+
+
+void pcps_acquisition::decimate(const gr_complex* in, gr_complex* out) const
+{
+    // Boxcar filter and decimation. The Doppler span is far below the
+    // decimated rate, so it is not attenuated.
+    const uint32_t decimation = d_coarse_decimation;
+    for (uint32_t k = 0; k < d_coarse_fft_size; k++)
+        {
+            const gr_complex* block = in + static_cast<size_t>(k) * decimation;
+            gr_complex sum = block[0];
+            for (uint32_t i = 1; i < decimation; i++)
+                {
+                    sum += block[i];
+                }
+            out[k] = sum;
+        }
+}
+
+
+bool pcps_acquisition::coarse_detection(const gr_complex* in)
+{
+    // Short search at the decimated rate: the FFTs are d_coarse_decimation
+    // times shorter than the ones of the full search, which is only run
+    // if the CFAR statistic of the coarse grid passes d_coarse_threshold
+    d_coarse_detections++;
+    decimate(in, d_coarse_signal.data());
+    uint32_t index_doppler = 0U;
+    for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
+        {
+            volk_32fc_x2_multiply_32fc(d_fft_coarse->get_inbuf(), d_coarse_signal.data(), d_grid_doppler_wipeoffs_coarse[doppler_index].data(), d_coarse_fft_size);
+            d_fft_coarse->execute();
+            volk_32fc_x2_multiply_32fc(d_ifft_coarse->get_inbuf(), d_fft_coarse->get_outbuf(), d_fft_codes_coarse.data(), d_coarse_fft_size);
+            d_ifft_coarse->execute();
+            volk_32fc_magnitude_squared_32f(d_coarse_magnitude.data(), d_ifft_coarse->get_outbuf(), d_coarse_fft_size);
+            uint32_t index_time = 0U;
+            volk_gnsssdr_32f_index_max_32u(&index_time, d_coarse_magnitude.data(), d_coarse_fft_size);
+            d_coarse_bin_max[doppler_index] = d_coarse_magnitude[index_time];
+            d_coarse_bin_power[doppler_index] = std::accumulate(d_coarse_magnitude.data(), d_coarse_magnitude.data() + d_coarse_fft_size, static_cast<float>(0.0)) / static_cast<float>(d_coarse_fft_size);
+            if (d_coarse_bin_max[doppler_index] > d_coarse_bin_max[index_doppler])
+                {
+                    index_doppler = doppler_index;
+                }
+        }
+
+    // Same noise estimate as max_to_input_power_statistic()
+    const auto index_opp = (index_doppler + d_num_doppler_bins / 2) % d_num_doppler_bins;
+    const float input_power = d_coarse_bin_power[index_opp] / static_cast<float>(2.0);
+    const bool candidate = (input_power > 0.0) and (d_coarse_bin_max[index_doppler] / input_power > d_coarse_threshold);
+    DLOG(INFO) << "Channel " << d_channel << ": coarse detection of " << d_gnss_synchro->System << " " << d_gnss_synchro->PRN
+               << (candidate ? " passed" : " failed") << ", test statistics value " << (input_power > 0.0 ? d_coarse_bin_max[index_doppler] / input_power : 0.0)
+               << ", threshold " << d_coarse_threshold;
+    return candidate;
+}
+
+
+uint32_t pcps_acquisition::fill_dwell_buffer(const void* input, int32_t ninput_items)
+{
+    const uint32_t buff_increment = std::min(static_cast<uint32_t>(ninput_items), d_consumed_samples - d_buffer_count);
+    if (d_native_cshort)
+        {
+            lv_16sc_t* out_sc = d_dwell_buffers_sc[d_fill_buffer].data() + d_buffer_count;
+            if (d_cbyte)
+                {
+                    volk_gnsssdr_8ic_convert_16ic(out_sc, reinterpret_cast<const lv_8sc_t*>(input), buff_increment);
+                }
+            else
+                {
+                    memcpy(out_sc, input, sizeof(lv_16sc_t) * buff_increment);
+                }
+            return buff_increment;
+        }
+    gr_complex* out = d_dwell_buffers[d_fill_buffer].data() + d_buffer_count;
     if (d_cshort)
         {
-            volk_gnsssdr_16ic_convert_32fc(d_data_buffer.data(), d_data_buffer_sc.data(), d_consumed_samples);
+            volk_gnsssdr_16ic_convert_32fc(out, reinterpret_cast<const lv_16sc_t*>(input), buff_increment);
+        }
+    else if (d_cbyte)
+        {
+            // the I and Q bytes are converted as a real vector of twice the length
+            volk_8i_s32f_convert_32f(reinterpret_cast<float*>(out), reinterpret_cast<const int8_t*>(input), 1.0F, 2 * buff_increment);
         }
-    memcpy(d_input_signal.data(), d_data_buffer.data(), d_consumed_samples * sizeof(gr_complex));
-    if (d_fft_size > d_consumed_samples)
+    else
         {
-            for (uint32_t i = d_consumed_samples; i < d_fft_size; i++)
+            memcpy(out, input, sizeof(gr_complex) * buff_increment);
+        }
+    return buff_increment;
+}
+
+
+bool pcps_acquisition::use_doppler_batch(const Doppler_Batch_Plan& plan, uint32_t num_doppler_bins) const
+{
+    return d_batch_doppler_fft and (plan.bin_class.size() == num_doppler_bins) and (plan.class_bin.size() < num_doppler_bins);
+}
+
+
+void pcps_acquisition::set_code_phase_assistance(double code_epoch_s, double code_period_s)
+{
+    gr::thread::scoped_lock lock(d_setlock);  // require mutex with work function called by the scheduler
+    d_assist_code_epoch_s = code_epoch_s;
+    d_assist_code_period_s = 0.0;
+    if (code_period_s > 0.0)
+        {
+            const auto samples_per_code = static_cast<uint32_t>(std::round(d_acq_parameters.samples_per_code));
+            const uint32_t effective_fft_size = (d_acq_parameters.bit_transition_flag ? d_fft_size / 2 : d_fft_size);
+            d_code_window_half_samples = static_cast<uint32_t>(std::ceil(static_cast<double>(d_acq_parameters.assisted_code_window_chips) * static_cast<double>(d_acq_parameters.resampled_fs) / static_cast<double>(d_acq_parameters.chips_per_second)));
+            if ((d_folding_factor > 1) or d_high_sensitivity or (effective_fft_size < samples_per_code) or (2 * d_code_window_half_samples + 1 >= samples_per_code / 2))
                 {
-                    d_input_signal[i] = gr_complex(0.0, 0.0);
+                    DLOG(INFO) << "Code phase assistance not used in channel " << d_channel;
+                }
+            else
+                {
+                    // Doppler bins within assisted_doppler_max of the Doppler center
+                    const int32_t min_offset = d_acq_parameters.doppler_max - static_cast<int32_t>(d_acq_parameters.assisted_doppler_max);
+                    const int32_t max_offset = d_acq_parameters.doppler_max + static_cast<int32_t>(d_acq_parameters.assisted_doppler_max);
+                    const auto first_bin = std::max(static_cast<int32_t>(std::ceil(static_cast<double>(min_offset) / static_cast<double>(d_doppler_step))), 0);
+                    const auto last_bin = std::min(static_cast<int32_t>(std::floor(static_cast<double>(max_offset) / static_cast<double>(d_doppler_step))), static_cast<int32_t>(d_num_doppler_bins) - 1);
+                    if (last_bin >= first_bin)
+                        {
+                            d_assist_first_bin = static_cast<uint32_t>(first_bin);
+                            d_assist_num_bins = static_cast<uint32_t>(last_bin - first_bin + 1);
+                            d_assist_code_period_s = code_period_s;
+                            DLOG(INFO) << "Code phase assistance for Channel: " << d_channel << " => code epoch: " << code_epoch_s
+                                       << " [s], window: +-" << d_code_window_half_samples << " samples, " << d_assist_num_bins << " Doppler bins";
+                        }
                 }
         }
-    const gr_complex* in = d_input_signal.data();  // Get the input samples pointer
+    calculate_threshold();
+}
 
-    d_mag = 0.0;
-    d_num_noncoherent_integrations_counter++;
 
-    DLOG(INFO) << "Channel: " << d_channel
-               << " , doing acquisition of satellite: " << d_gnss_synchro->System << " " << d_gnss_synchro->PRN
-               << " ,sample stamp: " << samp_count << ", threshold: "
-               << d_threshold << ", doppler_max: " << d_acq_parameters.doppler_max
-               << ", doppler_step: " << d_doppler_step
-               << ", use_CFAR_algorithm_flag: " << (d_use_CFAR_algorithm_flag ? "true" : "false");
+void pcps_acquisition::set_data_bit_aid(const Acq_Data_Bit_Aid& bit_aid)
+{
+    gr::thread::scoped_lock lock(d_setlock);  // require mutex with work function called by the scheduler
+    d_data_bit_aid = bit_aid;
+}
 
-    if (d_acq_parameters.blocking)
+
+void pcps_acquisition::update_code_window(uint64_t samp_count)
+{
+    // Time from the first sample of the dwell to the next predicted code epoch
+    const double resampler_ratio = (d_acq_parameters.use_automatic_resampler ? d_acq_parameters.resampler_ratio : 1.0);
+    const double dwell_time_s = static_cast<double>(samp_count) * resampler_ratio / static_cast<double>(d_acq_parameters.fs_in);
+    double delay_s = std::fmod(d_assist_code_epoch_s - dwell_time_s, d_assist_code_period_s);
+    if (delay_s < 0.0)
         {
-            lk.unlock();
+            delay_s += d_assist_code_period_s;
+        }
+    // Convert it to an index of the correlation output, which includes the resampler latency
+    double delay_samples = delay_s * static_cast<double>(d_acq_parameters.fs_in);
+    if (d_acq_parameters.use_automatic_resampler)
+        {
+            delay_samples = (delay_samples + static_cast<double>(d_acq_parameters.resampler_latency_samples)) / resampler_ratio;
         }
+    const auto samples_per_code = static_cast<uint32_t>(std::round(d_acq_parameters.samples_per_code));
+    d_code_window_center = static_cast<uint32_t>(std::lround(delay_samples)) % samples_per_code;
+}
 
-    // Doppler frequency grid loop
-    if (!d_step_two)
+
+uint32_t pcps_acquisition::code_window_index_max(const float* magnitude) const
+{
+    const auto samples_per_code = static_cast<int32_t>(std::round(d_acq_parameters.samples_per_code));
+    const auto half_window = static_cast<int32_t>(d_code_window_half_samples);
+    uint32_t index_max = d_code_window_center;
+    for (int32_t k = -half_window; k <= half_window; k++)
         {
-            for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
+            const auto index = static_cast<uint32_t>((static_cast<int32_t>(d_code_window_center) + k + samples_per_code) % samples_per_code);
+            if (magnitude[index] > magnitude[index_max])
                 {
-                    // Remove Doppler
-                    volk_32fc_x2_multiply_32fc(d_fft_if->get_inbuf(), in, d_grid_doppler_wipeoffs[doppler_index].data(), d_fft_size);
+                    index_max = index;
+                }
+        }
+    return index_max;
+}
 
-                    // Perform the FFT-based convolution  (parallel time search)
-                    // Compute the FFT of the carrier wiped--off incoming signal
-                    d_fft_if->execute();
 
-                    // Multiply carrier wiped--off, Fourier transformed incoming signal with the local FFT'd code reference
-                    volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(), d_fft_if->get_outbuf(), d_fft_codes.data(), d_fft_size);
+bool pcps_acquisition::in_code_window(uint32_t index) const
+{
+    const auto samples_per_code = static_cast<int32_t>(std::round(d_acq_parameters.samples_per_code));
+    int32_t distance = static_cast<int32_t>(index % samples_per_code) - static_cast<int32_t>(d_code_window_center);
+    if (distance > samples_per_code / 2)
+        {
+            distance -= samples_per_code;
+        }
+    else if (distance < -samples_per_code / 2)
+        {
+            distance += samples_per_code;
+        }
+    return std::abs(distance) <= static_cast<int32_t>(d_code_window_half_samples);
+}
 
-                    // Compute the inverse FFT
-                    d_ifft->execute();
 
-                    // Compute squared magnitude (and accumulate in case of non-coherent integration)
-                    const size_t offset = (d_acq_parameters.bit_transition_flag ? effective_fft_size : 0);
+void pcps_acquisition::doppler_grid_search(const gr_complex* in, const lv_16sc_t* in_sc, uint64_t samp_count, bool step_two)
+{
+    const auto& grid_doppler_wipeoffs = (step_two ? d_grid_doppler_wipeoffs_step_two : d_grid_doppler_wipeoffs);
+    const auto& doppler_phase_inc = (step_two ? d_doppler_phase_inc_step_two : d_doppler_phase_inc);
+    const Doppler_Batch_Plan& plan = (step_two ? d_doppler_batch_step_two : d_doppler_batch);
+    const uint32_t num_doppler_bins = (step_two ? d_num_doppler_bins_step2 : d_num_doppler_bins);
+    // With code phase assistance, only the bins close to the Doppler center are searched
+    const bool doppler_assisted = !step_two and code_phase_assisted();
+    const uint32_t first_bin = (doppler_assisted ? d_assist_first_bin : 0U);
+    const uint32_t last_bin = (doppler_assisted ? d_assist_first_bin + d_assist_num_bins : num_doppler_bins);
+    const int32_t effective_fft_size = (d_acq_parameters.bit_transition_flag ? d_fft_size / 2 : d_fft_size);
+    const size_t offset = (d_acq_parameters.bit_transition_flag ? effective_fft_size : 0);
+    const bool use_batch = !doppler_assisted and use_doppler_batch(plan, num_doppler_bins);
+    const std::shared_ptr<Acq_Shared_Front_End> shared_front_end = (step_two ? nullptr : d_shared_front_end);
+    const auto wipeoff = [&](uint32_t doppler_index) {
+        return (shared_front_end ? shared_front_end->wipeoff(doppler_index) : grid_doppler_wipeoffs[doppler_index].data());
+    };
+
+#if OPENCL_BLOCKS
+    if (d_opencl_engine)
+        {
+            const bool accumulate = (d_num_noncoherent_integrations_counter > 1);
+            if (d_opencl_engine->search(in, (step_two ? 1U : 0U), first_bin, last_bin - first_bin, static_cast<uint32_t>(offset), effective_fft_size, d_magnitude_grid, accumulate))
+                {
+                    d_dwells_opencl++;
+                    return;
+                }
+            LOG(WARNING) << "Channel " << d_channel << ": OpenCL acquisition failed, the search runs on the CPU";
+            d_opencl_engine.reset();
+        }
+#endif
+
+    if (d_folding_factor > 1)
+        {
+            d_dwells_folded++;
+            for (uint32_t doppler_index = first_bin; doppler_index < last_bin; doppler_index++)
+                {
+                    volk_32fc_x2_multiply_32fc(d_wiped_signal.data(), in, grid_doppler_wipeoffs[doppler_index].data(), d_fft_size);
                     if (d_num_noncoherent_integrations_counter == 1)
                         {
-                            volk_32fc_magnitude_squared_32f(d_magnitude_grid[doppler_index].data(), d_ifft->get_outbuf() + offset, effective_fft_size);
+                            folded_correlation(d_wiped_signal.data(), d_magnitude_grid[doppler_index].data());
                         }
                     else
                         {
-                            volk_32fc_magnitude_squared_32f(d_tmp_buffer.data(), d_ifft->get_outbuf() + offset, effective_fft_size);
+                            folded_correlation(d_wiped_signal.data(), d_tmp_buffer.data());
                             volk_32f_x2_add_32f(d_magnitude_grid[doppler_index].data(), d_magnitude_grid[doppler_index].data(), d_tmp_buffer.data(), effective_fft_size);
                         }
-                    // Record results to file if required
-                    if (d_dump and d_channel == d_dump_channel)
+                }
+            return;
+        }
+
+    if (use_batch)
+        {
+            d_dwells_doppler_batched++;
+            // Compute only one forward FFT per class of Doppler bins
+            for (uint32_t class_index = 0; class_index < static_cast<uint32_t>(plan.class_bin.size()); class_index++)
+                {
+                    if (shared_front_end and shared_front_end->fetch_spectrum(samp_count, class_index, in, d_batch_spectra[class_index].data()))
                         {
-                            memcpy(d_grid.colptr(doppler_index), d_magnitude_grid[doppler_index].data(), sizeof(float) * effective_fft_size);
+                            continue;
+                        }
+                    volk_32fc_x2_multiply_32fc(d_fft_if->get_inbuf(), in, wipeoff(plan.class_bin[class_index]), d_fft_size);
+                    d_fft_if->execute();
+                    memcpy(d_batch_spectra[class_index].data(), d_fft_if->get_outbuf(), sizeof(gr_complex) * d_fft_size);
+                    if (shared_front_end)
+                        {
+                            shared_front_end->store_spectrum(samp_count, class_index, in, d_batch_spectra[class_index].data());
                         }
                 }
+        }
 
-            // Compute the test statistic
-            if (d_use_CFAR_algorithm_flag)
+    for (uint32_t doppler_index = first_bin; doppler_index < last_bin; doppler_index++)
+        {
+            if (use_batch)
                 {
-                    d_test_statistics = max_to_input_power_statistic(indext, doppler, d_num_doppler_bins, d_acq_parameters.doppler_max, d_doppler_step);
+                    // Multiply the circularly shifted class spectrum with the local FFT'd code reference
+                    const gr_complex* spectrum = d_batch_spectra[plan.bin_class[doppler_index]].data();
+                    const uint32_t shift = plan.bin_shift[doppler_index];
+                    volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(), spectrum + shift, d_fft_codes.data(), d_fft_size - shift);
+                    if (shift > 0)
+                        {
+                            volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf() + (d_fft_size - shift), spectrum, d_fft_codes.data() + (d_fft_size - shift), shift);
+                        }
                 }
             else
                 {
-                    d_test_statistics = first_vs_second_peak_statistic(indext, doppler, d_num_doppler_bins, d_acq_parameters.doppler_max, d_doppler_step);
+                    if (in_sc != nullptr)
+                        {
+                            // Remove Doppler from the 16-bit samples, and convert them to float at the FFT input
+                            lv_32fc_t phase = lv_cmake(1.0F, 0.0F);
+                            volk_gnsssdr_16ic_s32fc_x2_rotator_16ic(d_wiped_signal_sc.data(), in_sc, doppler_phase_inc[doppler_index], &phase, d_fft_size);
+                            volk_gnsssdr_16ic_convert_32fc(d_fft_if->get_inbuf(), d_wiped_signal_sc.data(), d_fft_size);
+                            d_fft_if->execute();
+                        }
+                    else if (!shared_front_end or !shared_front_end->fetch_spectrum(samp_count, doppler_index, in, d_fft_if->get_outbuf()))
+                        {
+                            // Remove Doppler
+                            volk_32fc_x2_multiply_32fc(d_fft_if->get_inbuf(), in, wipeoff(doppler_index), d_fft_size);
+
+                            // Perform the FFT-based convolution  (parallel time search)
+                            // Compute the FFT of the carrier wiped--off incoming signal
+                            d_fft_if->execute();
+                            if (shared_front_end)
+                                {
+                                    shared_front_end->store_spectrum(samp_count, doppler_index, in, d_fft_if->get_outbuf());
+                                }
+                        }
+
+                    // Multiply carrier wiped--off, Fourier transformed incoming signal with the local FFT'd code reference
+                    volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(), d_fft_if->get_outbuf(), d_fft_codes.data(), d_fft_size);
+                }
+
+            // Compute the inverse FFT
+            d_ifft->execute();
+
+            // Compute squared magnitude (and accumulate in case of non-coherent integration)
+            if (d_num_noncoherent_integrations_counter == 1)
+                {
+                    volk_32fc_magnitude_squared_32f(d_magnitude_grid[doppler_index].data(), d_ifft->get_outbuf() + offset, effective_fft_size);
+                }
+            else
+                {
+                    volk_gnsssdr_32fc_32f_magnitude_squared_add_32f(d_magnitude_grid[doppler_index].data(), d_ifft->get_outbuf() + offset, d_magnitude_grid[doppler_index].data(), effective_fft_size);
+                }
+        }
+}
+
+
+void pcps_acquisition::acquisition_core(uint64_t samp_count, uint32_t dwell_buffer)
+{
+    gr::thread::scoped_lock lk(d_setlock);
+    static const char* const trace_names[] = {"prn", "step_two", nullptr};
+    const Gnss_Trace_Scope trace("acquisition_job", static_cast<int32_t>(d_channel), trace_names, d_gnss_synchro->PRN, d_step_two);
+
+    // Initialize acquisition algorithm
+    int32_t doppler = 0;
+    uint32_t indext = 0U;
+    const int32_t effective_fft_size = (d_acq_parameters.bit_transition_flag ? d_fft_size / 2 : d_fft_size);
+    // Get the input samples pointer
+    const gr_complex* in = (d_native_cshort ? nullptr : d_dwell_buffers[dwell_buffer].data());
+    const lv_16sc_t* in_sc = (d_native_cshort ? d_dwell_buffers_sc[dwell_buffer].data() : nullptr);
+    const bool searched_step_two = d_step_two;
+    // Release the lock during the search if general_work has to keep filling the next dwell
+    const bool unlock_search = d_acq_parameters.blocking or d_prefetch_dwell;
+    const Acq_Data_Bit_Aid bit_aid = (d_high_sensitivity_search ? d_data_bit_aid : Acq_Data_Bit_Aid());
+
+    d_mag = 0.0;
+    if (d_pooled_workspace and !d_fft_if)
+        {
+            // held until the acquisition ends
+            borrow_workspace();
+            allocate_magnitude_grid();
+        }
+    else if (d_magnitude_grid.empty())
+        {
+            allocate_magnitude_grid();
+        }
+    d_num_noncoherent_integrations_counter++;
+    d_dwells_searched++;
+    if (code_phase_assisted())
+        {
+            update_code_window(samp_count);
+            d_dwells_code_window++;
+        }
+
+    DLOG(INFO) << "Channel: " << d_channel
+               << " , doing acquisition of satellite: " << d_gnss_synchro->System << " " << d_gnss_synchro->PRN
+               << " ,sample stamp: " << samp_count << ", threshold: "
+               << d_threshold << ", doppler_max: " << d_acq_parameters.doppler_max
+               << ", doppler_step: " << d_doppler_step
+               << ", use_CFAR_algorithm_flag: " << (d_use_CFAR_algorithm_flag ? "true" : "false");
+
+    if (unlock_search)
+        {
+            lk.unlock();
+        }
+
+    // Without a coarse detection, the satellite is not searched at full rate
+    const bool coarse_rejected = (d_coarse_decimation > 1) and !d_step_two and (d_num_noncoherent_integrations_counter == 1) and !code_phase_assisted() and !coarse_detection(in);
+
+    // Doppler frequency grid loop
+    if (coarse_rejected)
+        {
+            d_test_statistics = 0.0;
+            d_num_noncoherent_integrations_counter = d_acq_parameters.max_dwells;  // no more dwells for this satellite
+            d_gnss_synchro->Acq_samplestamp_samples = samp_count;
+            if (d_dump)
+                {
+                    allocate_magnitude_grid();  // do not record the grid of the previous search
+                }
+        }
+    else if (!d_step_two)
+        {
+            const uint32_t first_doppler_bin = (code_phase_assisted() ? d_assist_first_bin : 0U);
+            const uint32_t num_doppler_bins = (code_phase_assisted() ? d_assist_num_bins : d_num_doppler_bins);
+            if (d_high_sensitivity_search)
+                {
+                    // samp_count is the sample counter at the end of the dwell
+                    const Acq_High_Sensitivity_Result result = d_high_sensitivity_search->search(in, samp_count - d_consumed_samples,
+                        static_cast<double>(d_doppler_center + d_doppler_bias), bit_aid.bits.empty() ? nullptr : &bit_aid);
+                    indext = result.code_phase_samples;
+                    doppler = static_cast<int32_t>(std::lround(result.doppler_hz)) - d_doppler_bias;
+                    d_mag = result.peak;
+                    d_input_power = result.noise_power;
+                    d_test_statistics = result.test_statistic;
+                    DLOG(INFO) << "Channel: " << d_channel << " , high sensitivity search of satellite " << d_gnss_synchro->PRN
+                               << ", Doppler rate: " << result.doppler_rate_hz_s << " [Hz/s]";
+                }
+            else
+                {
+                    doppler_grid_search(in, in_sc, samp_count, false);
+
+                    // Compute the test statistic
+                    if (d_use_CFAR_algorithm_flag)
+                        {
+                            d_test_statistics = max_to_input_power_statistic(indext, doppler, first_doppler_bin, num_doppler_bins, d_acq_parameters.doppler_max, d_doppler_step);
+                        }
+                    else
+                        {
+                            d_test_statistics = first_vs_second_peak_statistic(indext, doppler, first_doppler_bin, num_doppler_bins, d_acq_parameters.doppler_max, d_doppler_step);
+                        }
                 }
             if (d_acq_parameters.use_automatic_resampler)
                 {
@@ -697,45 +1513,16 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
         }
     else
         {
-            for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins_step2; doppler_index++)
-                {
-                    volk_32fc_x2_multiply_32fc(d_fft_if->get_inbuf(), in, d_grid_doppler_wipeoffs_step_two[doppler_index].data(), d_fft_size);
-
-                    // Perform the FFT-based convolution  (parallel time search)
-                    // Compute the FFT of the carrier wiped--off incoming signal
-                    d_fft_if->execute();
-
-                    // Multiply carrier wiped--off, Fourier transformed incoming signal
-                    // with the local FFT'd code reference using SIMD operations with VOLK library
-                    volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(), d_fft_if->get_outbuf(), d_fft_codes.data(), d_fft_size);
+            doppler_grid_search(in, in_sc, samp_count, true);
 
-                    // compute the inverse FFT
-                    d_ifft->execute();
-
-                    const size_t offset = (d_acq_parameters.bit_transition_flag ? effective_fft_size : 0);
-                    if (d_num_noncoherent_integrations_counter == 1)
-                        {
-                            volk_32fc_magnitude_squared_32f(d_magnitude_grid[doppler_index].data(), d_ifft->get_outbuf() + offset, effective_fft_size);
-                        }
-                    else
-                        {
-                            volk_32fc_magnitude_squared_32f(d_tmp_buffer.data(), d_ifft->get_outbuf() + offset, effective_fft_size);
-                            volk_32f_x2_add_32f(d_magnitude_grid[doppler_index].data(), d_magnitude_grid[doppler_index].data(), d_tmp_buffer.data(), effective_fft_size);
-                        }
-                    // Record results to file if required
-                    if (d_dump and d_channel == d_dump_channel)
-                        {
-                            memcpy(d_narrow_grid.colptr(doppler_index), d_magnitude_grid[doppler_index].data(), sizeof(float) * effective_fft_size);
-                        }
-                }
             // Compute the test statistic
             if (d_use_CFAR_algorithm_flag)
                 {
-                    d_test_statistics = max_to_input_power_statistic(indext, doppler, d_num_doppler_bins_step2, static_cast<int32_t>(d_doppler_center_step_two - (static_cast<float>(d_num_doppler_bins_step2) / 2.0) * d_acq_parameters.doppler_step2), d_acq_parameters.doppler_step2);
+                    d_test_statistics = max_to_input_power_statistic(indext, doppler, 0U, d_num_doppler_bins_step2, static_cast<int32_t>(d_doppler_center_step_two - (static_cast<float>(d_num_doppler_bins_step2) / 2.0) * d_acq_parameters.doppler_step2), d_acq_parameters.doppler_step2);
                 }
             else
                 {
-                    d_test_statistics = first_vs_second_peak_statistic(indext, doppler, d_num_doppler_bins_step2, static_cast<int32_t>(d_doppler_center_step_two - (static_cast<float>(d_num_doppler_bins_step2) / 2.0) * d_acq_parameters.doppler_step2), d_acq_parameters.doppler_step2);
+                    d_test_statistics = first_vs_second_peak_statistic(indext, doppler, 0U, d_num_doppler_bins_step2, static_cast<int32_t>(d_doppler_center_step_two - (static_cast<float>(d_num_doppler_bins_step2) / 2.0) * d_acq_parameters.doppler_step2), d_acq_parameters.doppler_step2);
                 }
 
             if (d_acq_parameters.use_automatic_resampler)
@@ -756,7 +1543,7 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
                 }
         }
 
-    if (d_acq_parameters.blocking)
+    if (unlock_search)
         {
             lk.lock();
         }
@@ -776,7 +1563,8 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
                                 }
                             else
                                 {
-                                    d_step_two = true;  // Clear input buffer and make small grid acquisition
+                                    stage_dump_grid(false);  // the narrow search reuses the magnitude grid
+                                    d_step_two = true;       // Clear input buffer and make small grid acquisition
                                     d_num_noncoherent_integrations_counter = 0;
                                     d_positive_acq = 0;
                                     d_state = 0;
@@ -791,8 +1579,11 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
                 }
             else
                 {
-                    d_buffer_count = 0;
-                    d_state = 1;
+                    if (!d_prefetch_dwell)
+                        {
+                            d_buffer_count = 0;
+                        }
+                    d_state = 1;  // the next dwell may be already (partially) filled
                 }
 
             if (d_num_noncoherent_integrations_counter == d_acq_parameters.max_dwells)
@@ -826,7 +1617,8 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
                                 }
                             else
                                 {
-                                    d_step_two = true;  // Clear input buffer and make small grid acquisition
+                                    stage_dump_grid(false);  // the narrow search reuses the magnitude grid
+                                    d_step_two = true;       // Clear input buffer and make small grid acquisition
                                     d_num_noncoherent_integrations_counter = 0U;
                                     d_state = 0;
                                 }
@@ -850,18 +1642,35 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
                     send_negative_acquisition();
                 }
         }
+    if (d_prefetch_dwell and (d_state != 1))
+        {
+            d_buffer_count = 0U;  // the prefetched dwell is not needed
+        }
     d_worker_active = false;
+    d_prefetch_dwell = false;
 
     if ((d_num_noncoherent_integrations_counter == d_acq_parameters.max_dwells) or (d_positive_acq == 1) or (d_acq_parameters.bit_transition_flag))
         {
             // Record results to file if required
             if (d_dump and d_channel == d_dump_channel)
                 {
+                    stage_dump_grid(searched_step_two);
                     pcps_acquisition::dump_results(effective_fft_size);
                 }
             d_num_noncoherent_integrations_counter = 0U;
             d_positive_acq = 0;
         }
+    if (!d_active and !d_step_two)
+        {
+            if (d_pooled_workspace)
+                {
+                    give_back_workspace();
+                }
+            else if (d_acq_parameters.release_idle_grid)
+                {
+                    volk_gnsssdr::vector<volk_gnsssdr::vector<float>>().swap(d_magnitude_grid);
+                }
+        }
 }
 
 
@@ -886,9 +1695,27 @@ void pcps_acquisition::calculate_threshold()
     const auto effective_fft_size = static_cast<int>(d_acq_parameters.bit_transition_flag ? (d_fft_size / 2) : d_fft_size);
     const int num_doppler_bins = (d_step_two ? d_num_doppler_bins_step2 : d_num_doppler_bins);
 
-    const int num_bins = effective_fft_size * num_doppler_bins;
+    int num_bins = effective_fft_size * num_doppler_bins;
+    if (code_phase_assisted())
+        {
+            // Only the cells within the code phase window are tested
+            num_bins = static_cast<int>(2 * d_code_window_half_samples + 1) * (d_step_two ? num_doppler_bins : static_cast<int>(d_assist_num_bins));
+        }
+
+    if (d_high_sensitivity_search)
+        {
+            // each dwell is tested alone, over the Doppler rate bins too
+            d_threshold = static_cast<float>(2.0 * boost::math::gamma_p_inv(2.0, std::pow(1.0 - pfa, 1.0 / static_cast<double>(d_high_sensitivity_search->num_cells()))));
+            return;
+        }
 
     d_threshold = static_cast<float>(2.0 * boost::math::gamma_p_inv(2.0 * (d_acq_parameters.bit_transition_flag ? 1 : d_acq_parameters.max_dwells), std::pow(1.0 - pfa, 1.0 / static_cast<float>(num_bins))));
+    if (d_coarse_decimation > 1)
+        {
+            // single dwell over the decimated grid
+            const int num_coarse_bins = static_cast<int>(d_coarse_fft_size) * static_cast<int>(d_num_doppler_bins);
+            d_coarse_threshold = static_cast<float>(2.0 * boost::math::gamma_p_inv(2.0, std::pow(1.0 - d_acq_parameters.pfa_coarse, 1.0 / static_cast<float>(num_coarse_bins))));
+        }
 }
 
 
@@ -907,13 +1734,28 @@ int pcps_acquisition::general_work(int noutput_items __attribute__((unused)),
      * 5. Compute the test statistics and compare to the threshold
      * 6. Declare positive or negative acquisition using a message port
      */
+    static const char* const trace_names[] = {"available", nullptr};
+    const Gnss_Trace_Scope trace("acquisition", static_cast<int32_t>(d_channel), trace_names, ninput_items[0]);
     gr::thread::scoped_lock lk(d_setlock);
+    // With the FDMA channelizer, the sub-band of the satellite is read and all
+    // of them are consumed together
+    const void* input = input_items[d_fdma_input < input_items.size() ? d_fdma_input : 0];
+    const int ninput = (input_items.size() > 1) ? *std::min_element(ninput_items.cbegin(), ninput_items.cend()) : ninput_items[0];
+    if (d_worker_active and d_prefetch_dwell and (d_buffer_count < d_consumed_samples))
+        {
+            // Fill the next dwell while the current one is being searched
+            const uint32_t buff_increment = fill_dwell_buffer(input, ninput);
+            d_buffer_count += buff_increment;
+            d_sample_counter += static_cast<uint64_t>(buff_increment);
+            consume_each(buff_increment);
+            return 0;
+        }
     if (!d_active or d_worker_active)
         {
             if (!d_acq_parameters.blocking_on_standby)
                 {
-                    d_sample_counter += static_cast<uint64_t>(ninput_items[0]);
-                    consume_each(ninput_items[0]);
+                    d_sample_counter += static_cast<uint64_t>(ninput);
+                    consume_each(ninput);
                 }
             if (d_step_two)
                 {
@@ -939,40 +1781,24 @@ int pcps_acquisition::general_work(int noutput_items __attribute__((unused)),
                 d_buffer_count = 0U;
                 if (!d_acq_parameters.blocking_on_standby)
                     {
-                        d_sample_counter += static_cast<uint64_t>(ninput_items[0]);  // sample counter
-                        consume_each(ninput_items[0]);
+                        d_sample_counter += static_cast<uint64_t>(ninput);  // sample counter
+                        consume_each(ninput);
                     }
                 break;
             }
         case 1:
             {
-                uint32_t buff_increment;
-                if (d_cshort)
+                if (d_use_shared_front_end and (d_buffer_count == 0U) and (d_sample_counter % d_consumed_samples != 0ULL))
                     {
-                        const auto* in = reinterpret_cast<const lv_16sc_t*>(input_items[0]);  // Get the input samples pointer
-                        if ((ninput_items[0] + d_buffer_count) <= d_consumed_samples)
-                            {
-                                buff_increment = ninput_items[0];
-                            }
-                        else
-                            {
-                                buff_increment = d_consumed_samples - d_buffer_count;
-                            }
-                        memcpy(&d_data_buffer_sc[d_buffer_count], in, sizeof(lv_16sc_t) * buff_increment);
-                    }
-                else
-                    {
-                        const auto* in = reinterpret_cast<const gr_complex*>(input_items[0]);  // Get the input samples pointer
-                        if ((ninput_items[0] + d_buffer_count) <= d_consumed_samples)
-                            {
-                                buff_increment = ninput_items[0];
-                            }
-                        else
-                            {
-                                buff_increment = d_consumed_samples - d_buffer_count;
-                            }
-                        memcpy(&d_data_buffer[d_buffer_count], in, sizeof(gr_complex) * buff_increment);
+                        // Align the start of the dwell with the blocks processed by
+                        // the other channels, so they can share the input FFTs
+                        const auto samples_to_boundary = static_cast<int>(d_consumed_samples - d_sample_counter % d_consumed_samples);
+                        const int skipped_samples = std::min(ninput, samples_to_boundary);
+                        d_sample_counter += static_cast<uint64_t>(skipped_samples);
+                        consume_each(skipped_samples);
+                        break;
                     }
+                const uint32_t buff_increment = fill_dwell_buffer(input, ninput);
 
                 // If buffer will be full in next iteration
                 if (d_buffer_count >= d_consumed_samples)
@@ -986,16 +1812,32 @@ int pcps_acquisition::general_work(int noutput_items __attribute__((unused)),
             }
         case 2:
             {
-                // Copy the data to the core and let it know that new data is available
+                // Let the core know that new data is available
+                const uint32_t dwell_buffer = d_fill_buffer;
+                d_fill_buffer = 1U - d_fill_buffer;
                 if (d_acq_parameters.blocking)
                     {
                         lk.unlock();
-                        acquisition_core(d_sample_counter);
+                        acquisition_core(d_sample_counter, dwell_buffer);
                     }
                 else
                     {
-                        gr::thread::thread d_worker(&pcps_acquisition::acquisition_core, this, d_sample_counter);
+                        const auto thread_pool = Acquisition_Thread_Pool::global_instance();
                         d_worker_active = true;
+                        // If more dwells may follow, start filling the next one
+                        // while this one is searched
+                        d_prefetch_dwell = !d_acq_parameters.bit_transition_flag and !d_step_two and ((d_num_noncoherent_integrations_counter + 1) < d_acq_parameters.max_dwells);
+                        if (thread_pool)
+                            {
+                                // Run the search in the receiver-wide acquisition thread pool
+                                d_thread_pool = thread_pool;
+                                const uint64_t sample_counter = d_sample_counter;
+                                thread_pool->submit(this, d_gnss_synchro->System, d_gnss_synchro->PRN, [this, sample_counter, dwell_buffer]() { acquisition_core(sample_counter, dwell_buffer); });
+                            }
+                        else
+                            {
+                                gr::thread::thread d_worker(&pcps_acquisition::acquisition_core, this, d_sample_counter, dwell_buffer);
+                            }
                     }
                 consume_each(0);
                 d_buffer_count = 0U;
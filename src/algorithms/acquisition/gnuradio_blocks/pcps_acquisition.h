@@ -43,9 +43,12 @@
 #endif
 
 #include "acq_conf.h"
+#include "acq_grid_recorder.h"
+#include "acq_high_sensitivity_search.h"
+#include "acq_shared_front_end.h"
+#include "acquisition_thread_pool.h"
 #include "channel_fsm.h"
 #include "gnss_sdr_fft.h"
-#include <armadillo>
 #include <glog/logging.h>
 #include <gnuradio/block.h>
 #include <gnuradio/gr_complex.h>              // for gr_complex
@@ -53,12 +56,15 @@
 #include <gnuradio/types.h>                   // for gr_vector_const_void_star
 #include <volk/volk_complex.h>                // for lv_16sc_t
 #include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <array>
+#include <atomic>
 #include <complex>
 #include <cstdint>
 #include <memory>
 #include <queue>
 #include <string>
 #include <utility>
+#include <vector>
 
 #if HAS_STD_SPAN
 #include <span>
@@ -76,6 +82,7 @@ namespace own = gsl;
  * \{ */
 
 
+class Acq_Opencl_Engine;
 class Gnss_Synchro;
 class pcps_acquisition;
 
@@ -92,7 +99,7 @@ pcps_acquisition_sptr pcps_make_acquisition(const Acq_Conf& conf_);
 class pcps_acquisition : public gr::block
 {
 public:
-    ~pcps_acquisition() override = default;
+    ~pcps_acquisition() override;
 
     /*!
      * \brief Initializes acquisition algorithm and reserves memory.
@@ -207,6 +214,56 @@ public:
             }
     }
 
+    /*!
+     * \brief Set the code phase assistance. The search is restricted to the
+     * code phases within assisted_code_window_chips of the predicted code
+     * epochs, and to the Doppler bins within assisted_doppler_max of the
+     * Doppler center.
+     * \param code_epoch_s - Receiver time (sample counter / fs_in) of a code epoch of the searched signal [s].
+     * \param code_period_s - Code period observed by the receiver, including code Doppler [s]. A value <= 0 disables the assistance.
+     */
+    void set_code_phase_assistance(double code_epoch_s, double code_period_s);
+
+    /*!
+     * \brief Set the data bits predicted for the searched signal, wiped off
+     * in the high_sensitivity mode. The sample counter of bit_aid is the one
+     * of this block. An empty bit_aid disables the wipe.
+     */
+    void set_data_bit_aid(const Acq_Data_Bit_Aid& bit_aid);
+
+    /*!
+     * \brief Number of dwells searched by each of the optional paths of the
+     * search since the block was created
+     */
+    struct Search_Counts
+    {
+        uint64_t dwells;           //!< Dwells searched
+        uint64_t doppler_batched;  //!< Dwells whose Doppler bins shared forward FFTs (batch_doppler_fft)
+        uint64_t folded;           //!< Dwells correlated with folded codes (folding_factor)
+        uint64_t coarse;           //!< Coarse detections at the decimated rate (coarse_decimation)
+        uint64_t opencl;           //!< Dwells searched on the OpenCL device (use_opencl)
+        uint64_t code_window;      //!< Dwells restricted to the assisted code phase window
+    };
+
+    Search_Counts search_counts() const;
+
+    /*!
+     * \brief True if the searches run on an OpenCL device
+     */
+    inline bool opencl_ready() const
+    {
+        return d_opencl_engine != nullptr;
+    }
+
+    /*!
+     * \brief True if the block holds its magnitude grid, which it does not
+     * between acquisitions with release_idle_grid or pooled_workspace
+     */
+    inline bool holds_magnitude_grid() const
+    {
+        return !d_magnitude_grid.empty();
+    }
+
     /*!
      * \brief Parallel Code Phase Search Acquisition signal processing.
      */
@@ -215,39 +272,99 @@ public:
         gr_vector_void_star& output_items) override;
 
 private:
+    /*
+     * Doppler bins whose frequencies differ by an integer multiple of the FFT
+     * bin spacing (fs / d_fft_size) share the same forward FFT: the spectrum
+     * of one of them is a circular shift of the spectrum of the other.
+     */
+    struct Doppler_Batch_Plan
+    {
+        std::vector<uint32_t> bin_class;  // spectrum (class) reused by each Doppler bin
+        std::vector<uint32_t> bin_shift;  // circular shift applied to the class spectrum for each Doppler bin
+        std::vector<uint32_t> class_bin;  // Doppler bin whose wipeoff generates each class spectrum
+    };
+
     friend pcps_acquisition_sptr pcps_make_acquisition(const Acq_Conf& conf_);
     explicit pcps_acquisition(const Acq_Conf& conf_);
 
     void update_local_carrier(own::span<gr_complex> carrier_vector, float freq) const;
+    gr_complex doppler_phase_increment(float freq) const;
     void update_grid_doppler_wipeoffs();
+    void allocate_magnitude_grid();
+    void borrow_workspace();
+    void give_back_workspace();
+    void compute_code_spectra(const std::complex<float>* code);
     void update_grid_doppler_wipeoffs_step2();
-    void acquisition_core(uint64_t samp_count);
+    void plan_doppler_batch(const std::vector<double>& doppler_freqs, Doppler_Batch_Plan& plan);
+    void doppler_grid_search(const gr_complex* in, const lv_16sc_t* in_sc, uint64_t samp_count, bool step_two);
+    void folded_correlation(const gr_complex* wiped_signal, float* magnitude);
+    void decimate(const gr_complex* in, gr_complex* out) const;
+    bool coarse_detection(const gr_complex* in);
+    bool use_doppler_batch(const Doppler_Batch_Plan& plan, uint32_t num_doppler_bins) const;
+    void update_code_window(uint64_t samp_count);
+    uint32_t code_window_index_max(const float* magnitude) const;
+    bool in_code_window(uint32_t index) const;
+    void acquisition_core(uint64_t samp_count, uint32_t dwell_buffer);
+    uint32_t fill_dwell_buffer(const void* input, int32_t ninput_items);
     void send_negative_acquisition();
     void send_positive_acquisition();
+    void stage_dump_grid(bool step_two);
     void dump_results(int32_t effective_fft_size);
     bool is_fdma();
     bool start() override;
+    bool stop() override;
     void calculate_threshold(void);
-    float first_vs_second_peak_statistic(uint32_t& indext, int32_t& doppler, uint32_t num_doppler_bins, int32_t doppler_max, int32_t doppler_step);
-    float max_to_input_power_statistic(uint32_t& indext, int32_t& doppler, uint32_t num_doppler_bins, int32_t doppler_max, int32_t doppler_step);
+    float first_vs_second_peak_statistic(uint32_t& indext, int32_t& doppler, uint32_t first_doppler_bin, uint32_t num_doppler_bins, int32_t doppler_max, int32_t doppler_step);
+    float max_to_input_power_statistic(uint32_t& indext, int32_t& doppler, uint32_t first_doppler_bin, uint32_t num_doppler_bins, int32_t doppler_max, int32_t doppler_step);
+
+    inline bool code_phase_assisted() const
+    {
+        return d_assist_code_period_s > 0.0;
+    }
 
     volk_gnsssdr::vector<volk_gnsssdr::vector<float>> d_magnitude_grid;
     volk_gnsssdr::vector<float> d_tmp_buffer;
-    volk_gnsssdr::vector<std::complex<float>> d_input_signal;
+    std::array<volk_gnsssdr::vector<std::complex<float>>, 2> d_dwell_buffers;  // filled by general_work, searched by acquisition_core
+    std::array<volk_gnsssdr::vector<lv_16sc_t>, 2> d_dwell_buffers_sc;        // same, for the native cshort search
+    volk_gnsssdr::vector<lv_16sc_t> d_wiped_signal_sc;
+    std::vector<gr_complex> d_doppler_phase_inc;
+    std::vector<gr_complex> d_doppler_phase_inc_step_two;
     volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>> d_grid_doppler_wipeoffs;
     volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>> d_grid_doppler_wipeoffs_step_two;
+    volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>> d_grid_doppler_wipeoffs_coarse;  // at the decimated rate
     volk_gnsssdr::vector<std::complex<float>> d_fft_codes;
-    volk_gnsssdr::vector<std::complex<float>> d_data_buffer;
-    volk_gnsssdr::vector<lv_16sc_t> d_data_buffer_sc;
+    volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>> d_batch_spectra;
+    volk_gnsssdr::vector<std::complex<float>> d_local_code;
+    volk_gnsssdr::vector<std::complex<float>> d_fft_codes_folded;
+    volk_gnsssdr::vector<std::complex<float>> d_wiped_signal;
+    volk_gnsssdr::vector<float> d_folded_magnitude;
+    volk_gnsssdr::vector<std::complex<float>> d_fft_codes_coarse;
+    volk_gnsssdr::vector<std::complex<float>> d_coarse_signal;
+    volk_gnsssdr::vector<float> d_coarse_magnitude;
+    std::vector<float> d_coarse_bin_max;    // correlation peak of each Doppler bin of the coarse detection
+    std::vector<float> d_coarse_bin_power;  // mean correlation power of each Doppler bin of the coarse detection
+
+    Doppler_Batch_Plan d_doppler_batch;
+    Doppler_Batch_Plan d_doppler_batch_step_two;
 
     std::unique_ptr<gnss_fft_complex_fwd> d_fft_if;
     std::unique_ptr<gnss_fft_complex_rev> d_ifft;
+    std::unique_ptr<gnss_fft_complex_fwd> d_fft_folded;
+    std::unique_ptr<gnss_fft_complex_rev> d_ifft_folded;
+    std::unique_ptr<gnss_fft_complex_fwd> d_fft_coarse;
+    std::unique_ptr<gnss_fft_complex_rev> d_ifft_coarse;
+    std::shared_ptr<Acq_Opencl_Engine> d_opencl_engine;  // only set in builds with ENABLE_OPENCL
+    std::shared_ptr<Acq_Shared_Front_End> d_shared_front_end;
+    std::weak_ptr<Acquisition_Thread_Pool> d_thread_pool;
     std::weak_ptr<ChannelFsm> d_channel_fsm;
 
     Acq_Conf d_acq_parameters;
     Gnss_Synchro* d_gnss_synchro;
-    arma::fmat d_grid;
-    arma::fmat d_narrow_grid;
+    std::unique_ptr<Acq_Grid_Recorder> d_grid_recorder;
+    std::unique_ptr<Acq_High_Sensitivity_Search> d_high_sensitivity_search;
+    Acq_Data_Bit_Aid d_data_bit_aid;
+    std::vector<float> d_dump_grid;         // last wide grid, column-major
+    std::vector<float> d_dump_narrow_grid;  // last narrow (step two) grid, column-major
 
     std::queue<Gnss_Synchro> d_monitor_queue;
     std::string d_dump_filename;
@@ -255,7 +372,11 @@ private:
     int64_t d_dump_number;
     uint64_t d_sample_counter;
 
+    double d_assist_code_epoch_s;
+    double d_assist_code_period_s;
+
     float d_threshold;
+    float d_coarse_threshold;
     float d_mag;
     float d_input_power;
     float d_test_statistics;
@@ -275,13 +396,38 @@ private:
     uint32_t d_num_doppler_bins_step2;
     uint32_t d_dump_channel;
     uint32_t d_buffer_count;
+    uint32_t d_fill_buffer;
+    uint32_t d_fdma_input;  // input of the FDMA sub-band of the satellite, with the channelizer
+    uint32_t d_folding_factor;
+    uint32_t d_folded_fft_size;
+    uint32_t d_coarse_decimation;
+    uint32_t d_coarse_fft_size;
+    uint32_t d_code_window_half_samples;  // half width of the assisted code phase window
+    uint32_t d_code_window_center;        // predicted code phase of the current dwell
+    uint32_t d_assist_first_bin;          // first Doppler bin searched with code phase assistance
+    uint32_t d_assist_num_bins;           // number of Doppler bins searched with code phase assistance
 
     bool d_active;
     bool d_worker_active;
+    bool d_prefetch_dwell;
     bool d_cshort;
+    bool d_cbyte;
+    bool d_native_cshort;
     bool d_step_two;
     bool d_use_CFAR_algorithm_flag;
+    bool d_batch_doppler_fft;
+    bool d_use_shared_front_end;
+    bool d_pooled_workspace;
+    bool d_high_sensitivity;
     bool d_dump;
+
+    // the searches may run in the thread pool, without the lock
+    std::atomic<uint64_t> d_dwells_searched{0};
+    std::atomic<uint64_t> d_dwells_doppler_batched{0};
+    std::atomic<uint64_t> d_dwells_folded{0};
+    std::atomic<uint64_t> d_coarse_detections{0};
+    std::atomic<uint64_t> d_dwells_opencl{0};
+    std::atomic<uint64_t> d_dwells_code_window{0};
 };
 
 
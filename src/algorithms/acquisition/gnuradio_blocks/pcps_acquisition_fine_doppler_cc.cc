@@ -25,8 +25,10 @@
 #include <gnuradio/io_signature.h>
 #include <matio.h>
 #include <volk/volk.h>
-#include <algorithm>  // std::rotate, std::fill_n
+#include <algorithm>  // std::rotate, std::min, std::max
 #include <array>
+#include <cmath>
+#include <complex>
 #include <sstream>
 #include <vector>
 
@@ -71,6 +73,8 @@ pcps_acquisition_fine_doppler_cc::pcps_acquisition_fine_doppler_cc(const Acq_Con
     d_fft_codes = volk_gnsssdr::vector<gr_complex>(d_fft_size);
     d_magnitude = volk_gnsssdr::vector<float>(d_fft_size);
     d_10_ms_buffer = volk_gnsssdr::vector<gr_complex>(50 * d_samples_per_ms);
+    d_code_replica = volk_gnsssdr::vector<gr_complex>(10 * d_fft_size);
+    d_fine_doppler_wipeoff = volk_gnsssdr::vector<gr_complex>(10 * d_fft_size);
     d_fft_if = gnss_fft_fwd_make_unique(d_fft_size);
     d_ifft = gnss_fft_rev_make_unique(d_fft_size);
 
@@ -306,8 +310,6 @@ int pcps_acquisition_fine_doppler_cc::compute_and_accumulate_grid(gr_vector_cons
                << ", doppler_step: " << d_doppler_step;
 
     // 2- Doppler frequency search loop
-    volk_gnsssdr::vector<float> p_tmp_vector(d_fft_size);
-
     for (int doppler_index = 0; doppler_index < d_num_doppler_points; doppler_index++)
         {
             // doppler search steps
@@ -326,9 +328,9 @@ int pcps_acquisition_fine_doppler_cc::compute_and_accumulate_grid(gr_vector_cons
             d_ifft->execute();
 
             // save the grid matrix delay file
-            volk_32fc_magnitude_squared_32f(p_tmp_vector.data(), d_ifft->get_outbuf(), d_fft_size);
+            volk_32fc_magnitude_squared_32f(d_magnitude.data(), d_ifft->get_outbuf(), d_fft_size);
             // accumulate grid values
-            volk_32f_x2_add_32f(d_grid_data[doppler_index].data(), d_grid_data[doppler_index].data(), p_tmp_vector.data(), d_fft_size);
+            volk_32f_x2_add_32f(d_grid_data[doppler_index].data(), d_grid_data[doppler_index].data(), d_magnitude.data(), d_fft_size);
         }
 
     return d_fft_size;
@@ -345,73 +347,91 @@ int pcps_acquisition_fine_doppler_cc::compute_and_accumulate_grid(gr_vector_cons
 
 int pcps_acquisition_fine_doppler_cc::estimate_Doppler()
 {
-    // Direct FFT
-    int zero_padding_factor = 8;
-    int prn_replicas = 10;
-    int signal_samples = prn_replicas * d_fft_size;
-    // int fft_size_extended = nextPowerOf2(signal_samples * zero_padding_factor);
-    int fft_size_extended = signal_samples * zero_padding_factor;
-
-    auto fft_operator = gnss_fft_fwd_make_unique(fft_size_extended);
-
-    // zero padding the entire vector
-    std::fill_n(fft_operator->get_inbuf(), fft_size_extended, gr_complex(0.0, 0.0));
+    // The Doppler is searched on the frequencies of a zero padded FFT of the
+    // code wiped-off signal, but only around the grid Doppler: the signal is
+    // moved to baseband with the grid Doppler and summed in short blocks, and
+    // its spectrum is computed on the few frequencies of the search window
+    const int zero_padding_factor = 8;
+    const int prn_replicas = 10;
+    const int signal_samples = prn_replicas * d_fft_size;
+    const double max_correction_hz = 1000.0;
+    const double block_rate_hz = 8.0 * max_correction_hz;
+    const auto fs = static_cast<double>(d_fs_in);
+    const double freq_bin_hz = fs / static_cast<double>(signal_samples * zero_padding_factor);
+    const double grid_doppler_hz = d_gnss_synchro->Acq_doppler_hz;
 
     // 1. generate local code aligned with the acquisition code phase estimation
-    volk_gnsssdr::vector<gr_complex> code_replica(signal_samples);
-
-    gps_l1_ca_code_gen_complex_sampled(code_replica, d_gnss_synchro->PRN, d_fs_in, 0);
+    gps_l1_ca_code_gen_complex_sampled(d_code_replica, d_gnss_synchro->PRN, d_fs_in, 0);
 
-    int shift_index = static_cast<int>(d_gnss_synchro->Acq_delay_samples);
+    const int shift_index = static_cast<int>(d_gnss_synchro->Acq_delay_samples);
 
     // Rotate to align the local code replica using acquisition time delay estimation
     if (shift_index != 0)
         {
-            std::rotate(code_replica.data(), code_replica.data() + (d_fft_size - shift_index), code_replica.data() + d_fft_size - 1);
+            std::rotate(d_code_replica.data(), d_code_replica.data() + (d_fft_size - shift_index), d_code_replica.data() + d_fft_size);
         }
 
     for (int n = 0; n < prn_replicas - 1; n++)
         {
-            memcpy(&code_replica[(n + 1) * d_fft_size], code_replica.data(), d_fft_size * sizeof(gr_complex));
+            memcpy(&d_code_replica[(n + 1) * d_fft_size], d_code_replica.data(), d_fft_size * sizeof(gr_complex));
         }
-    // 2. Perform code wipe-off
-    volk_32fc_x2_multiply_32fc(fft_operator->get_inbuf(), d_10_ms_buffer.data(), code_replica.data(), signal_samples);
-
-    // 3. Perform the FFT (zero padded!)
-    fft_operator->execute();
-
-    // 4. Compute the magnitude and find the maximum
-    volk_gnsssdr::vector<float> p_tmp_vector(fft_size_extended);
-    volk_32fc_magnitude_squared_32f(p_tmp_vector.data(), fft_operator->get_outbuf(), fft_size_extended);
-
-    uint32_t tmp_index_freq = 0;
-    volk_gnsssdr_32f_index_max_32u(&tmp_index_freq, p_tmp_vector.data(), fft_size_extended);
 
-    // case even
-    int counter = 0;
-    volk_gnsssdr::vector<float> fftFreqBins(fft_size_extended);
-
-    for (int k = 0; k < (fft_size_extended / 2); k++)
+    // 2. Perform code and grid Doppler wipe-off
+    const auto phase_step_rad = static_cast<float>(TWO_PI * grid_doppler_hz / fs);
+    float phase_rad = 0.0;
+    volk_gnsssdr_s32f_sincos_32fc(d_fine_doppler_wipeoff.data(), -phase_step_rad, &phase_rad, signal_samples);
+    volk_32fc_x2_multiply_32fc(d_fine_doppler_wipeoff.data(), d_fine_doppler_wipeoff.data(), d_code_replica.data(), signal_samples);
+    volk_32fc_x2_multiply_32fc(d_fine_doppler_wipeoff.data(), d_fine_doppler_wipeoff.data(), d_10_ms_buffer.data(), signal_samples);
+
+    // 3. Sum in blocks, short enough for the search window
+    const int block_samples = std::max(1, static_cast<int>(fs / block_rate_hz));
+    const int num_blocks = (signal_samples + block_samples - 1) / block_samples;
+    d_fine_doppler_blocks.assign(num_blocks, gr_complex(0.0, 0.0));
+    for (int b = 0; b < num_blocks; b++)
         {
-            fftFreqBins[counter] = ((static_cast<float>(d_fs_in) / 2.0) * static_cast<float>(k)) / (static_cast<float>(fft_size_extended) / 2.0);
-            counter++;
+            const int first = b * block_samples;
+            const int length = std::min(block_samples, signal_samples - first);
+            for (int n = first; n < first + length; n++)
+                {
+                    d_fine_doppler_blocks[b] += d_fine_doppler_wipeoff[n];
+                }
         }
 
-    for (int k = fft_size_extended / 2; k > 0; k--)
+    // 4. Evaluate the spectrum on the FFT frequencies of the window, and find the maximum
+    const auto first_bin = static_cast<int64_t>(std::ceil((grid_doppler_hz - max_correction_hz) / freq_bin_hz));
+    const auto last_bin = static_cast<int64_t>(std::floor((grid_doppler_hz + max_correction_hz) / freq_bin_hz));
+    int64_t max_bin = first_bin;
+    float max_power = -1.0;
+    for (int64_t k = first_bin; k <= last_bin; k++)
         {
-            fftFreqBins[counter] = ((-static_cast<float>(d_fs_in) / 2.0) * static_cast<float>(k)) / (static_cast<float>(fft_size_extended) / 2.0);
-            counter++;
+            const double offset_hz = static_cast<double>(k) * freq_bin_hz - grid_doppler_hz;
+            // the phase at the center of each block
+            const double block_phase_rad = -TWO_PI * offset_hz * static_cast<double>(block_samples) / fs;
+            const std::complex<double> rotation(std::cos(block_phase_rad), std::sin(block_phase_rad));
+            const double first_phase_rad = -TWO_PI * offset_hz * 0.5 * static_cast<double>(block_samples - 1) / fs;
+            std::complex<double> phasor(std::cos(first_phase_rad), std::sin(first_phase_rad));
+            std::complex<double> sum(0.0, 0.0);
+            for (int b = 0; b < num_blocks; b++)
+                {
+                    sum += std::complex<double>(d_fine_doppler_blocks[b]) * phasor;
+                    phasor *= rotation;
+                }
+            const auto power = static_cast<float>(std::norm(sum));
+            if (power > max_power)
+                {
+                    max_power = power;
+                    max_bin = k;
+                }
         }
 
-    // 5. Update the Doppler estimation in Hz
-    if (std::abs(fftFreqBins[tmp_index_freq] - d_gnss_synchro->Acq_doppler_hz) < 1000)
+    // 5. Update the Doppler estimation in Hz, unless the maximum is at the edge of the window
+    if (max_bin != first_bin && max_bin != last_bin)
         {
-            d_gnss_synchro->Acq_doppler_hz = static_cast<double>(fftFreqBins[tmp_index_freq]);
-            // std::cout << "FFT maximum present at " << fftFreqBins[tmp_index_freq] << " [Hz]\n";
+            d_gnss_synchro->Acq_doppler_hz = static_cast<double>(max_bin) * freq_bin_hz;
         }
     else
         {
-            DLOG(INFO) << "Abs(Grid Doppler - FFT Doppler)=" << std::abs(fftFreqBins[tmp_index_freq] - d_gnss_synchro->Acq_doppler_hz);
+            DLOG(INFO) << "Abs(Grid Doppler - FFT Doppler)>=" << max_correction_hz;
             DLOG(INFO) << "Error estimating fine frequency Doppler";
         }
 
@@ -52,6 +52,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 
 /** \addtogroup Acquisition
@@ -204,6 +205,9 @@ private:
     volk_gnsssdr::vector<volk_gnsssdr::vector<float>> d_grid_data;
     volk_gnsssdr::vector<gr_complex> d_fft_codes;
     volk_gnsssdr::vector<gr_complex> d_10_ms_buffer;
+    volk_gnsssdr::vector<gr_complex> d_code_replica;
+    volk_gnsssdr::vector<gr_complex> d_fine_doppler_wipeoff;
+    std::vector<gr_complex> d_fine_doppler_blocks;
     volk_gnsssdr::vector<float> d_magnitude;
 
     arma::fmat grid_;
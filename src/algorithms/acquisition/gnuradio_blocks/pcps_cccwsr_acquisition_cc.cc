@@ -21,12 +21,13 @@
  */
 
 #include "pcps_cccwsr_acquisition_cc.h"
-#include "MATH_CONSTANTS.h"  // TWO_PI
 #include <glog/logging.h>
 #include <gnuradio/io_signature.h>
 #include <volk/volk.h>
 #include <volk_gnsssdr/volk_gnsssdr.h>
+#include <cstring>
 #include <exception>
+#include <memory>
 #include <sstream>
 #include <utility>
 
@@ -92,13 +93,11 @@ pcps_cccwsr_acquisition_cc::pcps_cccwsr_acquisition_cc(
     d_fft_code_data = std::vector<gr_complex>(d_fft_size);
     d_fft_code_pilot = std::vector<gr_complex>(d_fft_size);
     d_data_correlation = std::vector<gr_complex>(d_fft_size);
-    d_pilot_correlation = std::vector<gr_complex>(d_fft_size);
     d_correlation_plus = std::vector<gr_complex>(d_fft_size);
     d_correlation_minus = std::vector<gr_complex>(d_fft_size);
     d_magnitude = std::vector<float>(d_fft_size);
 
-    d_fft_if = gnss_fft_fwd_make_unique(d_fft_size);
-    d_ifft = gnss_fft_rev_make_unique(d_fft_size);
+    d_engine = std::make_unique<Acq_Pcps_Engine>(d_fs_in, d_fft_size);
 }
 
 
@@ -126,20 +125,10 @@ void pcps_cccwsr_acquisition_cc::set_local_code(std::complex<float> *code_data,
     std::complex<float> *code_pilot)
 {
     // Data code (E1B)
-    memcpy(d_fft_if->get_inbuf(), code_data, sizeof(gr_complex) * d_fft_size);
-
-    d_fft_if->execute();  // We need the FFT of local code
-
-    // Conjugate the local code
-    volk_32fc_conjugate_32fc(d_fft_code_data.data(), d_fft_if->get_outbuf(), d_fft_size);
+    d_engine->code_spectrum(code_data, d_fft_code_data.data());
 
     // Pilot code (E1C)
-    memcpy(d_fft_if->get_inbuf(), code_pilot, sizeof(gr_complex) * d_fft_size);
-
-    d_fft_if->execute();  // We need the FFT of local code
-
-    // Conjugate the local code,
-    volk_32fc_conjugate_32fc(d_fft_code_pilot.data(), d_fft_if->get_outbuf(), d_fft_size);
+    d_engine->code_spectrum(code_pilot, d_fft_code_pilot.data());
 }
 
 
@@ -156,24 +145,9 @@ void pcps_cccwsr_acquisition_cc::init()
     d_mag = 0.0;
     d_input_power = 0.0;
 
-    // Count the number of bins
-    d_num_doppler_bins = 0;
-    for (auto doppler = static_cast<int32_t>(-d_doppler_max);
-         doppler <= static_cast<int32_t>(d_doppler_max);
-         doppler += d_doppler_step)
-        {
-            d_num_doppler_bins++;
-        }
-
-    // Create the carrier Doppler wipeoff signals
-    d_grid_doppler_wipeoffs = std::vector<std::vector<gr_complex>>(d_num_doppler_bins, std::vector<gr_complex>(d_fft_size));
-    for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
-        {
-            int32_t doppler = -static_cast<int32_t>(d_doppler_max) + d_doppler_step * doppler_index;
-            float phase_step_rad = static_cast<float>(TWO_PI) * doppler / static_cast<float>(d_fs_in);
-            std::array<float, 1> _phase{};
-            volk_gnsssdr_s32f_sincos_32fc(d_grid_doppler_wipeoffs[doppler_index].data(), -phase_step_rad, _phase.data(), d_fft_size);
-        }
+    // Set the Doppler grid
+    d_engine->set_doppler_grid(std::string(d_gnss_synchro->Signal, 2), static_cast<int32_t>(d_doppler_max), static_cast<int32_t>(d_doppler_step));
+    d_num_doppler_bins = d_engine->num_doppler_bins();
 }
 
 
@@ -266,48 +240,22 @@ int pcps_cccwsr_acquisition_cc::general_work(int noutput_items,
                         // doppler search steps
                         doppler = -static_cast<int32_t>(d_doppler_max) + d_doppler_step * doppler_index;
 
-                        volk_32fc_x2_multiply_32fc(d_fft_if->get_inbuf(), in,
-                            d_grid_doppler_wipeoffs[doppler_index].data(), d_fft_size);
-
                         // 3- Perform the FFT-based convolution  (parallel time search)
-                        // Compute the FFT of the carrier wiped--off incoming signal
-                        d_fft_if->execute();
-
-                        // Multiply carrier wiped--off, Fourier transformed incoming signal
-                        // with the local FFT'd data code reference (E1B) using SIMD operations
-                        // with VOLK library
-                        volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(),
-                            d_fft_if->get_outbuf(), d_fft_code_data.data(), d_fft_size);
-
-                        // compute the inverse FFT
-                        d_ifft->execute();
-
-                        // Copy the result of the correlation between wiped--off signal and data code in
-                        // d_data_correlation.
-                        memcpy(d_data_correlation.data(), d_ifft->get_outbuf(), sizeof(gr_complex) * d_fft_size);
-
-                        // Multiply carrier wiped--off, Fourier transformed incoming signal
-                        // with the local FFT'd pilot code reference (E1C) using SIMD operations
-                        // with VOLK library
-                        volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(),
-                            d_fft_if->get_outbuf(), d_fft_code_pilot.data(), d_fft_size);
-
-                        // Compute the inverse FFT
-                        d_ifft->execute();
-
-                        // Copy the result of the correlation between wiped--off signal and pilot code in
-                        // d_data_correlation.
-                        memcpy(d_pilot_correlation.data(), d_ifft->get_outbuf(), sizeof(gr_complex) * d_fft_size);
+                        // of the carrier wiped--off incoming signal with the local data
+                        // code reference (E1B) and the local pilot code reference (E1C)
+                        d_engine->input_spectrum(in, d_sample_counter, doppler_index);
+                        memcpy(d_data_correlation.data(), d_engine->correlate(d_fft_code_data.data()), sizeof(gr_complex) * d_fft_size);
+                        const gr_complex *pilot_correlation = d_engine->correlate(d_fft_code_pilot.data());
 
                         for (uint32_t i = 0; i < d_fft_size; i++)
                             {
                                 d_correlation_plus[i] = std::complex<float>(
-                                    d_data_correlation[i].real() - d_pilot_correlation[i].imag(),
-                                    d_data_correlation[i].imag() + d_pilot_correlation[i].real());
+                                    d_data_correlation[i].real() - pilot_correlation[i].imag(),
+                                    d_data_correlation[i].imag() + pilot_correlation[i].real());
 
                                 d_correlation_minus[i] = std::complex<float>(
-                                    d_data_correlation[i].real() + d_pilot_correlation[i].imag(),
-                                    d_data_correlation[i].imag() - d_pilot_correlation[i].real());
+                                    d_data_correlation[i].real() + pilot_correlation[i].imag(),
+                                    d_data_correlation[i].imag() - pilot_correlation[i].real());
                             }
 
                         volk_32fc_magnitude_squared_32f(d_magnitude.data(), d_correlation_plus.data(), d_fft_size);
@@ -349,7 +297,7 @@ int pcps_cccwsr_acquisition_cc::general_work(int noutput_items,
                                          << "_" << d_gnss_synchro->Signal[0] << d_gnss_synchro->Signal[1] << "_sat_"
                                          << d_gnss_synchro->PRN << "_doppler_" << doppler << ".dat";
                                 d_dump_file.open(filename.str().c_str(), std::ios::out | std::ios::binary);
-                                d_dump_file.write(reinterpret_cast<char *>(d_ifft->get_outbuf()), n);  // write directly |abs(x)|^2 in this Doppler bin?
+                                d_dump_file.write(reinterpret_cast<const char *>(pilot_correlation), n);  // write directly |abs(x)|^2 in this Doppler bin?
                                 d_dump_file.close();
                             }
                     }
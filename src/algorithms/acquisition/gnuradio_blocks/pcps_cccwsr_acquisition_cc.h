@@ -23,8 +23,8 @@
 #ifndef GNSS_SDR_PCPS_CCCWSR_ACQUISITION_CC_H
 #define GNSS_SDR_PCPS_CCCWSR_ACQUISITION_CC_H
 
+#include "acq_pcps_engine.h"
 #include "channel_fsm.h"
-#include "gnss_sdr_fft.h"
 #include "gnss_synchro.h"
 #include <gnuradio/block.h>
 #include <gnuradio/gr_complex.h>
@@ -183,14 +183,11 @@ private:
 
     std::weak_ptr<ChannelFsm> d_channel_fsm;
 
-    std::unique_ptr<gnss_fft_complex_fwd> d_fft_if;
-    std::unique_ptr<gnss_fft_complex_rev> d_ifft;
+    std::unique_ptr<Acq_Pcps_Engine> d_engine;
 
-    std::vector<std::vector<gr_complex>> d_grid_doppler_wipeoffs;
     std::vector<gr_complex> d_fft_code_data;
     std::vector<gr_complex> d_fft_code_pilot;
     std::vector<gr_complex> d_data_correlation;
-    std::vector<gr_complex> d_pilot_correlation;
     std::vector<gr_complex> d_correlation_plus;
     std::vector<gr_complex> d_correlation_minus;
     std::vector<float> d_magnitude;
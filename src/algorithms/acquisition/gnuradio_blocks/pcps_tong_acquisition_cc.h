@@ -37,8 +37,8 @@
 #ifndef GNSS_SDR_PCPS_TONG_ACQUISITION_CC_H
 #define GNSS_SDR_PCPS_TONG_ACQUISITION_CC_H
 
+#include "acq_pcps_engine.h"
 #include "channel_fsm.h"
-#include "gnss_sdr_fft.h"
 #include "gnss_synchro.h"
 #include <gnuradio/block.h>
 #include <gnuradio/gr_complex.h>
@@ -199,10 +199,8 @@ private:
         int32_t doppler_offset);
 
     std::weak_ptr<ChannelFsm> d_channel_fsm;
-    std::unique_ptr<gnss_fft_complex_fwd> d_fft_if;
-    std::unique_ptr<gnss_fft_complex_rev> d_ifft;
+    std::unique_ptr<Acq_Pcps_Engine> d_engine;
 
-    std::vector<std::vector<gr_complex>> d_grid_doppler_wipeoffs;
     std::vector<std::vector<float>> d_grid_data;
     std::vector<gr_complex> d_fft_codes;
     std::vector<float> d_magnitude;
@@ -0,0 +1,44 @@
+/*!
+ * \file sky_search_sink.cc
+ * \brief GNU Radio sink feeding an Acq_Sky_Search with the samples of a
+ * signal conditioner
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "sky_search_sink.h"
+#include "acq_sky_search.h"
+#include <gnuradio/gr_complex.h>
+#include <gnuradio/io_signature.h>
+#include <utility>
+
+
+sky_search_sink_sptr make_sky_search_sink(std::shared_ptr<Acq_Sky_Search> search)
+{
+    return sky_search_sink_sptr(new sky_search_sink(std::move(search)));
+}
+
+
+sky_search_sink::sky_search_sink(std::shared_ptr<Acq_Sky_Search> search) : gr::sync_block("sky_search_sink",
+                                                                                gr::io_signature::make(1, 1, sizeof(gr_complex)),
+                                                                                gr::io_signature::make(0, 0, 0)),
+                                                                            d_search(std::move(search))
+{
+}
+
+
+int sky_search_sink::work(int noutput_items,
+    gr_vector_const_void_star &input_items,
+    gr_vector_void_star &output_items __attribute__((unused)))
+{
+    d_search->push(static_cast<const gr_complex *>(input_items[0]), noutput_items);
+    return noutput_items;
+}
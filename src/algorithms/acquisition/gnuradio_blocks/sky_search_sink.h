@@ -0,0 +1,62 @@
+/*!
+ * \file sky_search_sink.h
+ * \brief GNU Radio sink feeding an Acq_Sky_Search with the samples of a
+ * signal conditioner
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_SKY_SEARCH_SINK_H
+#define GNSS_SDR_SKY_SEARCH_SINK_H
+
+#include "gnss_block_interface.h"
+#include <gnuradio/sync_block.h>
+#include <memory>
+
+/** \addtogroup Acquisition
+ * \{ */
+/** \addtogroup Acq_gnuradio_blocks acquisition_gr_blocks
+ * \{ */
+
+
+class Acq_Sky_Search;
+class sky_search_sink;
+
+using sky_search_sink_sptr = gnss_shared_ptr<sky_search_sink>;
+
+/*!
+ * \brief Creates a sink pushing its gr_complex input to search
+ */
+sky_search_sink_sptr make_sky_search_sink(std::shared_ptr<Acq_Sky_Search> search);
+
+/*!
+ * \brief This class taps the samples of a signal conditioner for the
+ * background sky search of a signal. It is connected from the start of the
+ * stream, so that its sample counter is the one of the tracking channels.
+ */
+class sky_search_sink : public gr::sync_block
+{
+public:
+    int work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+private:
+    friend sky_search_sink_sptr make_sky_search_sink(std::shared_ptr<Acq_Sky_Search> search);
+    explicit sky_search_sink(std::shared_ptr<Acq_Sky_Search> search);
+
+    std::shared_ptr<Acq_Sky_Search> d_search;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_SKY_SEARCH_SINK_H
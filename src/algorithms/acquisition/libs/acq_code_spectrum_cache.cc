@@ -0,0 +1,115 @@
+/*!
+ * \file acq_code_spectrum_cache.cc
+ * \brief Process-wide cache of the local code spectra computed by the PCPS
+ * acquisition blocks.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_code_spectrum_cache.h"
+#include <algorithm>  // for equal
+#include <cstring>    // for memcpy
+#include <utility>    // for move
+
+
+constexpr size_t Acq_Code_Spectrum_Cache::MAX_ENTRIES;
+
+
+Acq_Code_Spectrum_Cache& Acq_Code_Spectrum_Cache::get()
+{
+    static Acq_Code_Spectrum_Cache cache;
+    return cache;
+}
+
+
+uint64_t Acq_Code_Spectrum_Cache::hash(const gr_complex* code, uint32_t fft_size)
+{
+    // FNV-1a over the raw bytes of the samples
+    const auto* bytes = reinterpret_cast<const unsigned char*>(code);
+    const size_t length = sizeof(gr_complex) * fft_size;
+    uint64_t h = 14695981039346656037ULL;
+    for (size_t i = 0; i < length; i++)
+        {
+            h ^= bytes[i];
+            h *= 1099511628211ULL;
+        }
+    return h;
+}
+
+
+bool Acq_Code_Spectrum_Cache::fetch(const gr_complex* code,
+    uint32_t fft_size,
+    uint32_t folded_fft_size,
+    gr_complex* fft_codes,
+    gr_complex* fft_codes_folded)
+{
+    const Key key{hash(code, fft_size), fft_size, folded_fft_size};
+    std::lock_guard<std::mutex> lock(d_mutex);
+    const auto it = d_entries.find(key);
+    if (it == d_entries.cend() or !std::equal(code, code + fft_size, it->second.code.cbegin()))
+        {
+            return false;
+        }
+    memcpy(fft_codes, it->second.fft_codes.data(), sizeof(gr_complex) * fft_size);
+    if (folded_fft_size > 0)
+        {
+            memcpy(fft_codes_folded, it->second.fft_codes_folded.data(), sizeof(gr_complex) * folded_fft_size);
+        }
+    return true;
+}
+
+
+void Acq_Code_Spectrum_Cache::store(const gr_complex* code,
+    uint32_t fft_size,
+    uint32_t folded_fft_size,
+    const gr_complex* fft_codes,
+    const gr_complex* fft_codes_folded)
+{
+    const Key key{hash(code, fft_size), fft_size, folded_fft_size};
+    Entry entry;
+    entry.code.assign(code, code + fft_size);
+    entry.fft_codes.assign(fft_codes, fft_codes + fft_size);
+    if (folded_fft_size > 0)
+        {
+            entry.fft_codes_folded.assign(fft_codes_folded, fft_codes_folded + folded_fft_size);
+        }
+
+    std::lock_guard<std::mutex> lock(d_mutex);
+    const auto it = d_entries.find(key);
+    if (it != d_entries.end())
+        {
+            // Same key, but either the same code or a hash collision. Keep the latest.
+            it->second = std::move(entry);
+            return;
+        }
+    if (d_entries.size() >= MAX_ENTRIES)
+        {
+            d_entries.erase(d_insertion_order.front());
+            d_insertion_order.pop_front();
+        }
+    d_entries.emplace(key, std::move(entry));
+    d_insertion_order.push_back(key);
+}
+
+
+size_t Acq_Code_Spectrum_Cache::size()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_entries.size();
+}
+
+
+void Acq_Code_Spectrum_Cache::clear()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_entries.clear();
+    d_insertion_order.clear();
+}
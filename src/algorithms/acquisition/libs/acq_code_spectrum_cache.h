@@ -0,0 +1,110 @@
+/*!
+ * \file acq_code_spectrum_cache.h
+ * \brief Process-wide cache of the local code spectra computed by the PCPS
+ * acquisition blocks.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ACQ_CODE_SPECTRUM_CACHE_H
+#define GNSS_SDR_ACQ_CODE_SPECTRUM_CACHE_H
+
+#include <gnuradio/gr_complex.h>
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+/** \addtogroup Acquisition
+ * \{ */
+/** \addtogroup acquisition_libs
+ * \{ */
+
+
+/*!
+ * \brief Cache of the conjugated FFTs of the local codes, shared by all the
+ * acquisition channels.
+ *
+ * Every time a channel is assigned a new PRN, the acquisition block computes
+ * the FFT of the sampled local code. The spectra are the same for all the
+ * channels searching the same signal with the same sampling parameters, so
+ * they are computed once and then copied. Entries are looked up by the
+ * contents of the sampled code (not by the PRN), so any change in the code
+ * generation or in the sampling parameters just results in a cache miss.
+ */
+class Acq_Code_Spectrum_Cache
+{
+public:
+    /*!
+     * \brief Maximum number of cached spectra. The oldest ones are dropped first.
+     */
+    static constexpr size_t MAX_ENTRIES = 256;
+
+    /*!
+     * \brief Returns the process-wide instance
+     */
+    static Acq_Code_Spectrum_Cache& get();
+
+    /*!
+     * \brief Copies to fft_codes (fft_size samples) the cached spectrum of
+     * code, and to fft_codes_folded (folded_fft_size samples, if not zero)
+     * the spectrum of the folded code. Returns false on cache miss.
+     */
+    bool fetch(const gr_complex* code,
+        uint32_t fft_size,
+        uint32_t folded_fft_size,
+        gr_complex* fft_codes,
+        gr_complex* fft_codes_folded);
+
+    /*!
+     * \brief Stores the spectra computed for code
+     */
+    void store(const gr_complex* code,
+        uint32_t fft_size,
+        uint32_t folded_fft_size,
+        const gr_complex* fft_codes,
+        const gr_complex* fft_codes_folded);
+
+    /*!
+     * \brief Number of cached spectra
+     */
+    size_t size();
+
+    /*!
+     * \brief Drops all the cached spectra
+     */
+    void clear();
+
+private:
+    using Key = std::tuple<uint64_t, uint32_t, uint32_t>;  // code hash, FFT size, folded FFT size
+
+    struct Entry
+    {
+        volk_gnsssdr::vector<gr_complex> code;
+        volk_gnsssdr::vector<gr_complex> fft_codes;
+        volk_gnsssdr::vector<gr_complex> fft_codes_folded;
+    };
+
+    Acq_Code_Spectrum_Cache() = default;
+    static uint64_t hash(const gr_complex* code, uint32_t fft_size);
+
+    std::map<Key, Entry> d_entries;
+    std::deque<Key> d_insertion_order;
+    std::mutex d_mutex;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_ACQ_CODE_SPECTRUM_CACHE_H
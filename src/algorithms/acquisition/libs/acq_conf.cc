@@ -42,8 +42,22 @@ void Acq_Conf::SetFromConfiguration(const ConfigurationInterface *configuration,
     dump_channel = configuration->property(role + ".dump_channel", dump_channel);
     blocking = configuration->property(role + ".blocking", blocking);
     dump_filename = configuration->property(role + ".dump_filename", dump_filename);
+    dump_ring_size = configuration->property(role + ".dump_ring_size", dump_ring_size);
 
     use_automatic_resampler = configuration->property("GNSS-SDR.use_acquisition_resampler", use_automatic_resampler);
+    if (fdma_channelized)
+        {
+            // the flow graph splits the FDMA sub-bands at the optimal acquisition rate
+            if (item_type == "gr_complex")
+                {
+                    use_automatic_resampler = true;
+                }
+            else
+                {
+                    LOG(WARNING) << "The GLONASS FDMA channelizer requires gr_complex samples in " << role;
+                    fdma_channelized = false;
+                }
+        }
 
     if ((sampled_ms % ms_per_code) != 0)
         {
@@ -76,6 +90,40 @@ void Acq_Conf::SetFromConfiguration(const ConfigurationInterface *configuration,
         }
     make_2_steps = configuration->property(role + ".make_two_steps", make_2_steps);
     blocking_on_standby = configuration->property(role + ".blocking_on_standby", blocking_on_standby);
+    batch_doppler_fft = configuration->property(role + ".batch_doppler_fft", batch_doppler_fft);
+    // the low-memory profile shares the Doppler wipeoffs and allocates the
+    // magnitude grid only while searching
+    const bool low_memory = configuration->property("GNSS-SDR.low_memory", false);
+    shared_front_end = configuration->property(role + ".shared_front_end", shared_front_end or low_memory) and !fdma_channelized;  // the satellites do not share an input
+    release_idle_grid = configuration->property(role + ".release_idle_grid", release_idle_grid or low_memory);
+    pooled_workspace = configuration->property(role + ".pooled_workspace", pooled_workspace or low_memory);
+    native_cshort = configuration->property(role + ".native_cshort", native_cshort);
+    use_opencl = configuration->property(role + ".use_opencl", use_opencl);
+    opencl_batch_bins = configuration->property(role + ".opencl_batch_bins", opencl_batch_bins);
+    assisted_code_window_chips = configuration->property(role + ".assisted_code_window_chips", assisted_code_window_chips);
+    assisted_doppler_max = configuration->property(role + ".assisted_doppler_max", assisted_doppler_max);
+    folding_factor = configuration->property(role + ".folding_factor", folding_factor);
+    if (folding_factor == 0)
+        {
+            LOG(WARNING) << "Parameter folding_factor should be greater than 0. Setting it to 1";
+            folding_factor = 1U;
+        }
+    coarse_decimation = configuration->property(role + ".coarse_decimation", coarse_decimation);
+    if (coarse_decimation == 0)
+        {
+            LOG(WARNING) << "Parameter coarse_decimation should be greater than 0. Setting it to 1";
+            coarse_decimation = 1U;
+        }
+    pfa_coarse = configuration->property(role + ".pfa_coarse", pfa_coarse);
+    if ((pfa_coarse <= 0.0) or (pfa_coarse > 1.0))
+        {
+            LOG(WARNING) << "Parameter pfa_coarse should be between 0.0 and 1.0. Setting it to 0.1";
+            pfa_coarse = 0.1;
+        }
+
+    high_sensitivity = configuration->property(role + ".high_sensitivity", high_sensitivity);
+    doppler_rate_max = configuration->property(role + ".doppler_rate_max", doppler_rate_max);
+    doppler_rate_step = configuration->property(role + ".doppler_rate_step", doppler_rate_step);
 
     if (pfa <= 0.0)
         {
@@ -51,8 +51,11 @@ public:
     float doppler_step2{125.0};
     float pfa{0.0};
     float pfa2{0.0};
+    float pfa_coarse{0.1};  // false alarm probability of the decimated detection that precedes the full search
     float samples_per_code{0.0};
     float resampler_ratio{1.0};
+    float doppler_rate_max{0.0};   // half width of the Doppler rate span of the high-sensitivity search [Hz/s]
+    float doppler_rate_step{0.0};  // of the high-sensitivity search [Hz/s], 0 takes the inverse of the square of the coherent integration time
 
     uint32_t sampled_ms{1U};
     uint32_t ms_per_code{1U};
@@ -62,6 +65,12 @@ public:
     uint32_t num_doppler_bins_step2{4U};
     uint32_t resampler_latency_samples{0U};
     uint32_t dump_channel{0U};
+    uint32_t folding_factor{1U};                // correlate input and code folded by this factor (sparse-FFT search), 1 disables it
+    uint32_t coarse_decimation{1U};             // detect at the sample rate decimated by this factor before the full search, 1 disables it
+    uint32_t dump_ring_size{8U};                // acquisition grids waiting to be written to disk, the newest are dropped when full
+    uint32_t assisted_code_window_chips{100U};  // half width of the code phase window searched with code phase assistance
+    uint32_t assisted_doppler_max{500U};        // half width of the Doppler span searched with code phase assistance
+    uint32_t opencl_batch_bins{16U};            // Doppler bins correlated together by the OpenCL backend
     int32_t doppler_max{5000};
     int32_t doppler_min{-5000};
 
@@ -73,6 +82,14 @@ public:
     bool make_2_steps{false};
     bool use_automatic_resampler{false};
     bool enable_monitor_output{false};
+    bool batch_doppler_fft{false};  // share forward FFTs among Doppler bins spaced by multiples of the FFT resolution
+    bool shared_front_end{false};   // share Doppler wipeoffs and input FFTs among channels searching the same signal
+    bool release_idle_grid{false};  // free the magnitude grid between acquisitions
+    bool pooled_workspace{false};   // borrow the FFT plans and the magnitude grid from Acq_Workspace_Pool while searching
+    bool native_cshort{false};      // with cshort samples, do the Doppler wipeoff in 16-bit integers
+    bool use_opencl{false};         // search the Doppler bins on an OpenCL GPU (requires ENABLE_OPENCL)
+    bool fdma_channelized{false};   // GLONASS: one input per FDMA sub-band, decimated by the channelizer of the flow graph
+    bool high_sensitivity{false};   // coherent integration over the code periods of coherent_integration_time_ms with an FFT across them
 
 private:
     void SetDerivedParams();
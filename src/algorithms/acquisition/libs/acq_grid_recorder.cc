@@ -0,0 +1,188 @@
+/*!
+ * \file acq_grid_recorder.cc
+ * \brief Asynchronous recorder of acquisition grids. Grids are stored in a
+ * preallocated single-producer, single-consumer ring of records, and written
+ * to .mat files by a background thread.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_grid_recorder.h"
+#include "gnss_thread_sched.h"
+#include <glog/logging.h>
+#include <matio.h>
+#include <algorithm>  // for max
+#include <array>
+#include <chrono>
+
+
+Acq_Grid_Recorder::Acq_Grid_Recorder(size_t num_records) : d_records(std::max(num_records, static_cast<size_t>(1))),
+                                                           d_head(0ULL),
+                                                           d_tail(0ULL),
+                                                           d_dropped(0ULL),
+                                                           d_stop(false)
+{
+    d_writer = std::thread(&Acq_Grid_Recorder::run, this);
+}
+
+
+Acq_Grid_Recorder::~Acq_Grid_Recorder()
+{
+    d_stop.store(true, std::memory_order_release);
+    d_wakeup.notify_one();
+    if (d_writer.joinable())
+        {
+            d_writer.join();
+        }
+    if (d_dropped.load() > 0)
+        {
+            LOG(WARNING) << d_dropped.load() << " acquisition grids were not recorded because the dump ring was full";
+        }
+}
+
+
+Acq_Grid_Recorder::Record* Acq_Grid_Recorder::reserve()
+{
+    const uint64_t head = d_head.load(std::memory_order_relaxed);
+    if (head - d_tail.load(std::memory_order_acquire) >= d_records.size())
+        {
+            d_dropped.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+    return &d_records[head % d_records.size()];
+}
+
+
+void Acq_Grid_Recorder::commit()
+{
+    d_head.fetch_add(1, std::memory_order_release);
+    d_wakeup.notify_one();
+}
+
+
+void Acq_Grid_Recorder::flush()
+{
+    const uint64_t head = d_head.load(std::memory_order_acquire);
+    while (d_tail.load(std::memory_order_acquire) < head and d_writer.joinable())
+        {
+            d_wakeup.notify_one();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+}
+
+
+void Acq_Grid_Recorder::run()
+{
+    gnss_apply_helper_thread_sched("acquisition grid recorder");
+    while (true)
+        {
+            const uint64_t tail = d_tail.load(std::memory_order_relaxed);
+            if (tail == d_head.load(std::memory_order_acquire))
+                {
+                    if (d_stop.load(std::memory_order_acquire))
+                        {
+                            return;
+                        }
+                    // The producer does not take the mutex, so a notification
+                    // can be missed: the timeout bounds the latency in that case
+                    std::unique_lock<std::mutex> lock(d_wakeup_mutex);
+                    d_wakeup.wait_for(lock, std::chrono::milliseconds(100));
+                    continue;
+                }
+            write(d_records[tail % d_records.size()]);
+            d_tail.store(tail + 1, std::memory_order_release);
+        }
+}
+
+
+void Acq_Grid_Recorder::write(const Record& record)
+{
+    mat_t* matfp = Mat_CreateVer(record.filename.c_str(), nullptr, MAT_FT_MAT73);
+    if (matfp == nullptr)
+        {
+            LOG(WARNING) << "Unable to create or open Acquisition dump file " << record.filename;
+            return;
+        }
+
+    // Mat_VarCreate takes non-const pointers, but does not modify the data
+    Record& r = const_cast<Record&>(record);
+    std::array<size_t, 2> dims{r.grid_rows, r.grid_cols};
+    matvar_t* matvar = Mat_VarCreate("acq_grid", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims.data(), r.grid.data(), 0);
+    Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
+    Mat_VarFree(matvar);
+
+    dims[0] = static_cast<size_t>(1);
+    dims[1] = static_cast<size_t>(1);
+    matvar = Mat_VarCreate("doppler_max", MAT_C_INT32, MAT_T_INT32, 1, dims.data(), &r.doppler_max, 0);
+    Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);
+    Mat_VarFree(matvar);
+
+    matvar = Mat_VarCreate("doppler_step", MAT_C_INT32, MAT_T_INT32, 1, dims.data(), &r.doppler_step, 0);
+    Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);
+    Mat_VarFree(matvar);
+
+    matvar = Mat_VarCreate("d_positive_acq", MAT_C_INT32, MAT_T_INT32, 1, dims.data(), &r.positive_acq, 0);
+    Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);
+    Mat_VarFree(matvar);
+
+    matvar = Mat_VarCreate("acq_doppler_hz", MAT_C_SINGLE, MAT_T_SINGLE, 1, dims.data(), &r.acq_doppler_hz, 0);
+    Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);
+    Mat_VarFree(matvar);
+
+    matvar = Mat_VarCreate("acq_delay_samples", MAT_C_SINGLE, MAT_T_SINGLE, 1, dims.data(), &r.acq_delay_samples, 0);
+    Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);
+    Mat_VarFree(matvar);
+
+    matvar = Mat_VarCreate("test_statistic", MAT_C_SINGLE, MAT_T_SINGLE, 1, dims.data(), &r.test_statistic, 0);
+    Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);
+    Mat_VarFree(matvar);
+
+    matvar = Mat_VarCreate("threshold", MAT_C_SINGLE, MAT_T_SINGLE, 1, dims.data(), &r.threshold, 0);
+    Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);
+    Mat_VarFree(matvar);
+
+    matvar = Mat_VarCreate("input_power", MAT_C_SINGLE, MAT_T_SINGLE, 1, dims.data(), &r.input_power, 0);
+    Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);
+    Mat_VarFree(matvar);
+
+    matvar = Mat_VarCreate("sample_counter", MAT_C_UINT64, MAT_T_UINT64, 1, dims.data(), &r.sample_counter, 0);
+    Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);
+    Mat_VarFree(matvar);
+
+    matvar = Mat_VarCreate("PRN", MAT_C_UINT32, MAT_T_UINT32, 1, dims.data(), &r.prn, 0);
+    Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);
+    Mat_VarFree(matvar);
+
+    matvar = Mat_VarCreate("num_dwells", MAT_C_INT32, MAT_T_INT32, 1, dims.data(), &r.num_dwells, 0);
+    Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);
+    Mat_VarFree(matvar);
+
+    if (r.two_steps)
+        {
+            dims[0] = r.grid_rows;
+            dims[1] = r.narrow_grid_cols;
+            matvar = Mat_VarCreate("acq_grid_narrow", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims.data(), r.narrow_grid.data(), 0);
+            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);
+            Mat_VarFree(matvar);
+
+            dims[0] = static_cast<size_t>(1);
+            dims[1] = static_cast<size_t>(1);
+            matvar = Mat_VarCreate("doppler_step_narrow", MAT_C_SINGLE, MAT_T_SINGLE, 1, dims.data(), &r.doppler_step_narrow, 0);
+            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);
+            Mat_VarFree(matvar);
+
+            matvar = Mat_VarCreate("doppler_grid_narrow_min", MAT_C_SINGLE, MAT_T_SINGLE, 1, dims.data(), &r.doppler_grid_narrow_min, 0);
+            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);
+            Mat_VarFree(matvar);
+        }
+
+    Mat_Close(matfp);
+}
@@ -0,0 +1,126 @@
+/*!
+ * \file acq_grid_recorder.h
+ * \brief Asynchronous recorder of acquisition grids. Grids are stored in a
+ * preallocated single-producer, single-consumer ring of records, and written
+ * to .mat files by a background thread.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ACQ_GRID_RECORDER_H
+#define GNSS_SDR_ACQ_GRID_RECORDER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/** \addtogroup Acquisition
+ * \{ */
+/** \addtogroup acquisition_libs
+ * \{ */
+
+
+/*!
+ * \brief Writes acquisition grids to disk without blocking the acquisition.
+ *
+ * The producer (the acquisition block) gets a free record with reserve(),
+ * fills it and makes it available to the writer thread with commit(). If all
+ * the records are waiting to be written, reserve() returns nullptr and the
+ * grid is dropped, so that the acquisition is never stalled by the disk.
+ * reserve() and commit() must be called from a single thread at a time.
+ */
+class Acq_Grid_Recorder
+{
+public:
+    struct Record
+    {
+        std::string filename;
+        std::vector<float> grid;         // column-major, grid_rows x grid_cols
+        std::vector<float> narrow_grid;  // column-major, grid_rows x narrow_grid_cols
+        uint64_t sample_counter{0ULL};
+        size_t grid_rows{0};
+        size_t grid_cols{0};
+        size_t narrow_grid_cols{0};
+        float acq_doppler_hz{0.0};
+        float acq_delay_samples{0.0};
+        float test_statistic{0.0};
+        float threshold{0.0};
+        float input_power{0.0};
+        float doppler_step_narrow{0.0};
+        float doppler_grid_narrow_min{0.0};
+        int32_t doppler_max{0};
+        int32_t doppler_step{0};
+        int32_t positive_acq{0};
+        int32_t num_dwells{0};
+        uint32_t prn{0U};
+        bool two_steps{false};
+    };
+
+    /*!
+     * \brief Starts the writer thread, with room for num_records pending grids
+     */
+    explicit Acq_Grid_Recorder(size_t num_records);
+
+    /*!
+     * \brief Writes the pending grids and stops the writer thread
+     */
+    ~Acq_Grid_Recorder();
+
+    Acq_Grid_Recorder(const Acq_Grid_Recorder&) = delete;
+    Acq_Grid_Recorder& operator=(const Acq_Grid_Recorder&) = delete;
+
+    /*!
+     * \brief Returns the next free record, or nullptr if the ring is full.
+     * Calling it again before commit() returns the same record.
+     */
+    Record* reserve();
+
+    /*!
+     * \brief Queues the record returned by reserve() for writing
+     */
+    void commit();
+
+    /*!
+     * \brief Blocks until all the committed records have been written
+     */
+    void flush();
+
+    /*!
+     * \brief Number of grids dropped because the ring was full
+     */
+    inline uint64_t dropped() const
+    {
+        return d_dropped.load(std::memory_order_relaxed);
+    }
+
+private:
+    void run();
+    static void write(const Record& record);
+
+    std::vector<Record> d_records;
+    std::atomic<uint64_t> d_head;  // next record to be filled (producer)
+    std::atomic<uint64_t> d_tail;  // next record to be written (consumer)
+    std::atomic<uint64_t> d_dropped;
+    std::atomic<bool> d_stop;
+    std::mutex d_wakeup_mutex;  // only used to sleep while idle, never held while copying data
+    std::condition_variable d_wakeup;
+    std::thread d_writer;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_ACQ_GRID_RECORDER_H
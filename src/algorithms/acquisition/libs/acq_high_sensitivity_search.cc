@@ -0,0 +1,176 @@
+/*!
+ * \file acq_high_sensitivity_search.cc
+ * \brief Long coherent integration search of a weak signal, with per code
+ * period correlations transformed across the code periods.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_high_sensitivity_search.h"
+#include "MATH_CONSTANTS.h"
+#include <volk/volk.h>
+#include <algorithm>  // for fill, max, min
+#include <cmath>
+#include <complex>
+#include <cstring>  // for memcpy
+#include <utility>  // for move
+
+
+Acq_High_Sensitivity_Search::Acq_High_Sensitivity_Search(int64_t fs, uint32_t samples_per_code, uint32_t code_periods,
+    int32_t doppler_max, float doppler_rate_max, float doppler_rate_step)
+    : d_fft(gnss_fft_fwd_make_unique(samples_per_code)),
+      d_ifft(gnss_fft_rev_make_unique(samples_per_code)),
+      d_fft_code(samples_per_code),
+      d_wipeoff(samples_per_code),
+      d_fs(static_cast<double>(fs)),
+      d_code_period_s(static_cast<double>(samples_per_code) / static_cast<double>(fs)),
+      d_coarse_step_hz(0.5 * static_cast<double>(fs) / static_cast<double>(samples_per_code)),
+      d_samples_per_code(samples_per_code),
+      d_code_periods(std::max(code_periods, 1U)),
+      d_num_coarse_bins(0),
+      d_fine_fft_size(4)
+{
+    d_correlations.resize(static_cast<size_t>(d_samples_per_code) * d_code_periods);
+    // the fine bins are at most half the ones of the code periods apart
+    while (d_fine_fft_size < 2 * d_code_periods)
+        {
+            d_fine_fft_size *= 2;
+        }
+    d_fine_fft = gnss_fft_fwd_make_unique(d_fine_fft_size);
+    d_power.resize(d_fine_fft_size);
+    d_num_coarse_bins = 2 * static_cast<uint32_t>(std::ceil(static_cast<double>(std::max(doppler_max, 0)) / d_coarse_step_hz)) + 1;
+
+    // a quarter of a cycle of quadratic phase error at the ends of the block
+    // between two Doppler rate bins
+    const double block_s = d_code_period_s * d_code_periods;
+    const double rate_step = (doppler_rate_step > 0.0 ? doppler_rate_step : 1.0 / (block_s * block_s));
+    const auto half_rates = (doppler_rate_max > 0.0 ? static_cast<int32_t>(std::ceil(doppler_rate_max / rate_step - 1e-6)) : 0);
+    for (int32_t i = -half_rates; i <= half_rates; i++)
+        {
+            const double rate = static_cast<double>(i) * rate_step;
+            std::vector<gr_complex> rotation(d_code_periods);
+            for (uint32_t m = 0; m < d_code_periods; m++)
+                {
+                    const double t = (static_cast<double>(m) + 0.5) * d_code_period_s;
+                    rotation[m] = std::polar(1.0F, static_cast<float>(std::fmod(-GNSS_PI * rate * t * t, TWO_PI)));
+                }
+            d_doppler_rates.push_back(static_cast<float>(rate));
+            d_rate_rotations.push_back(std::move(rotation));
+        }
+}
+
+
+void Acq_High_Sensitivity_Search::set_code(const gr_complex* code)
+{
+    memcpy(d_fft->get_inbuf(), code, sizeof(gr_complex) * d_samples_per_code);
+    d_fft->execute();
+    volk_32fc_conjugate_32fc(d_fft_code.data(), d_fft->get_outbuf(), d_samples_per_code);
+}
+
+
+Acq_High_Sensitivity_Result Acq_High_Sensitivity_Search::search(const gr_complex* in, uint64_t first_sample, double doppler_center, const Acq_Data_Bit_Aid* bit_aid)
+{
+    const uint32_t n = d_samples_per_code;
+    const uint32_t fine_half = d_fine_fft_size / 4;  // fine bins at each side of the coarse bin
+    const double fine_step_hz = 1.0 / (static_cast<double>(d_fine_fft_size) * d_code_period_s);
+    Acq_High_Sensitivity_Result result{};
+    double grid_sum = 0.0;
+    float peak = -1.0F;
+    for (uint32_t coarse = 0; coarse < d_num_coarse_bins; coarse++)
+        {
+            const double coarse_hz = doppler_center + (static_cast<double>(coarse) - static_cast<double>(d_num_coarse_bins - 1) / 2.0) * d_coarse_step_hz;
+            const double phase_step = -TWO_PI * coarse_hz / d_fs;
+            for (uint32_t i = 0; i < n; i++)
+                {
+                    d_wipeoff[i] = std::polar(1.0F, static_cast<float>(std::fmod(phase_step * static_cast<double>(i), TWO_PI)));
+                }
+
+            // correlations of each code period, with the carrier phase
+            // continuous across them
+            for (uint32_t m = 0; m < d_code_periods; m++)
+                {
+                    volk_32fc_x2_multiply_32fc(d_fft->get_inbuf(), in + static_cast<size_t>(m) * n, d_wipeoff.data(), n);
+                    if (bit_aid != nullptr)
+                        {
+                            wipe_data_bits(d_fft->get_inbuf(), first_sample + static_cast<uint64_t>(m) * n, *bit_aid);
+                        }
+                    d_fft->execute();
+                    volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(), d_fft->get_outbuf(), d_fft_code.data(), n);
+                    d_ifft->execute();
+                    const gr_complex block_phase = std::polar(1.0F, static_cast<float>(std::fmod(phase_step * static_cast<double>(m) * static_cast<double>(n), TWO_PI)));
+                    volk_32fc_s32fc_multiply_32fc(d_correlations.data() + static_cast<size_t>(m) * n, d_ifft->get_outbuf(), block_phase, n);
+                }
+
+            // fine Doppler bins of each Doppler rate and code phase
+            for (size_t rate = 0; rate < d_doppler_rates.size(); rate++)
+                {
+                    const std::vector<gr_complex>& rotation = d_rate_rotations[rate];
+                    for (uint32_t code_phase = 0; code_phase < n; code_phase++)
+                        {
+                            gr_complex* fine_in = d_fine_fft->get_inbuf();
+                            for (uint32_t m = 0; m < d_code_periods; m++)
+                                {
+                                    fine_in[m] = d_correlations[static_cast<size_t>(m) * n + code_phase] * rotation[m];
+                                }
+                            std::fill(fine_in + d_code_periods, fine_in + d_fine_fft_size, gr_complex(0.0, 0.0));
+                            d_fine_fft->execute();
+                            volk_32fc_magnitude_squared_32f(d_power.data(), d_fine_fft->get_outbuf(), d_fine_fft_size);
+                            for (uint32_t j = 0; j < 2 * fine_half; j++)
+                                {
+                                    // from -fine_half to fine_half - 1
+                                    const uint32_t k = (j + d_fine_fft_size - fine_half) % d_fine_fft_size;
+                                    grid_sum += d_power[k];
+                                    if (d_power[k] > peak)
+                                        {
+                                            peak = d_power[k];
+                                            result.code_phase_samples = code_phase;
+                                            result.doppler_rate_hz_s = d_doppler_rates[rate];
+                                            result.doppler_hz = coarse_hz + (static_cast<double>(j) - static_cast<double>(fine_half)) * fine_step_hz;
+                                        }
+                                }
+                        }
+                }
+        }
+
+    // the fine bins give the Doppler at the start of the block
+    result.doppler_hz += result.doppler_rate_hz_s * d_code_period_s * d_code_periods;
+    result.peak = std::max(peak, 0.0F);
+    const double mean = grid_sum / static_cast<double>(std::max(num_cells(), static_cast<uint64_t>(1)));
+    result.noise_power = static_cast<float>(mean / 2.0);
+    result.test_statistic = (result.noise_power > 0.0 ? result.peak / result.noise_power : 0.0F);
+    return result;
+}
+
+
+void Acq_High_Sensitivity_Search::wipe_data_bits(gr_complex* samples, uint64_t first_sample, const Acq_Data_Bit_Aid& bit_aid) const
+{
+    // negates the samples of the bits predicted as -1
+    const double period = bit_aid.bit_period_samples;
+    if (period <= 0.0 or bit_aid.bits.empty())
+        {
+            return;
+        }
+    uint32_t i = 0;
+    while (i < d_samples_per_code)
+        {
+            const double bit = std::floor((static_cast<double>(first_sample + i) - static_cast<double>(bit_aid.first_bit_sample)) / period);
+            const double next_bit_start = std::ceil(static_cast<double>(bit_aid.first_bit_sample) + (bit + 1.0) * period - static_cast<double>(first_sample));
+            const uint32_t end = std::max(i + 1, static_cast<uint32_t>(std::min(next_bit_start, static_cast<double>(d_samples_per_code))));
+            if (bit >= 0.0 and bit < static_cast<double>(bit_aid.bits.size()) and bit_aid.bits[static_cast<size_t>(bit)] < 0)
+                {
+                    for (uint32_t s = i; s < end; s++)
+                        {
+                            samples[s] = -samples[s];
+                        }
+                }
+            i = end;
+        }
+}
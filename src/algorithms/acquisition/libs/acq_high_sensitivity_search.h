@@ -0,0 +1,144 @@
+/*!
+ * \file acq_high_sensitivity_search.h
+ * \brief Long coherent integration search of a weak signal, with per code
+ * period correlations transformed across the code periods.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ACQ_HIGH_SENSITIVITY_SEARCH_H
+#define GNSS_SDR_ACQ_HIGH_SENSITIVITY_SEARCH_H
+
+#include "gnss_sdr_fft.h"
+#include <gnuradio/gr_complex.h>
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/** \addtogroup Acquisition
+ * \{ */
+/** \addtogroup acquisition_libs
+ * \{ */
+
+
+/*!
+ * \brief Data bits predicted by an assistance source, wiped off the samples
+ * before the coherent integration
+ */
+struct Acq_Data_Bit_Aid
+{
+    std::vector<int8_t> bits;        //!< +1 or -1, 0 if unknown (left as is)
+    uint64_t first_bit_sample{0};    //!< Sample counter of the start of bits[0], at the code epochs of the received signal
+    double bit_period_samples{0.0};  //!< Duration of a bit [samples]
+};
+
+
+/*!
+ * \brief Result of the search of a block
+ */
+struct Acq_High_Sensitivity_Result
+{
+    uint32_t code_phase_samples{0};  //!< Code phase at the first sample
+    double doppler_hz{0.0};          //!< Doppler at the end of the block [Hz]
+    double doppler_rate_hz_s{0.0};   //!< Doppler rate [Hz/s]
+    float peak{0.0};                 //!< Highest power of the grid
+    float noise_power{0.0};          //!< Half the mean power of the grid, the noise variance of a cell
+    float test_statistic{0.0};       //!< peak / noise_power, chi-squared with 2 degrees of freedom without a signal
+};
+
+
+/*!
+ * \brief Searches a block of code_periods code periods, coherently, without
+ * the FFTs of the whole block.
+ *
+ * Each code period is wiped off with the coarse Doppler bins, spaced by
+ * half the inverse of the code period, and circularly correlated with the
+ * code. The correlations of each code phase are then transformed across the
+ * code periods, zero-padded to twice their number at least, which gives the
+ * fine Doppler bins within each coarse bin in one pass. The Doppler rate
+ * bins only rotate the correlations of each code period before that FFT,
+ * so the correlations are computed once for all of them.
+ *
+ * The cost grows with the number of code periods, instead of with the
+ * square of the length of the block as with one FFT of the block per
+ * Doppler bin. The code Doppler over the block is not compensated, so the
+ * block should not be much longer than the code period times the ratio of
+ * the carrier to the code frequency over the maximum Doppler, in samples.
+ */
+class Acq_High_Sensitivity_Search
+{
+public:
+    /*!
+     * \brief Searches the Doppler bins within doppler_max of the center, and
+     * the Doppler rates within doppler_rate_max. A doppler_rate_step <= 0
+     * takes the inverse of the square of the block duration.
+     */
+    Acq_High_Sensitivity_Search(int64_t fs, uint32_t samples_per_code, uint32_t code_periods,
+        int32_t doppler_max, float doppler_rate_max, float doppler_rate_step);
+
+    /*!
+     * \brief Sets the local code, one code period sampled at fs
+     */
+    void set_code(const gr_complex* code);
+
+    /*!
+     * \brief Searches the block in (code_periods code periods), whose first
+     * sample is first_sample in the sample counter of bit_aid, if any.
+     */
+    Acq_High_Sensitivity_Result search(const gr_complex* in, uint64_t first_sample, double doppler_center, const Acq_Data_Bit_Aid* bit_aid);
+
+    //! Cells tested in a search, for the detection threshold
+    inline uint64_t num_cells() const
+    {
+        return static_cast<uint64_t>(d_samples_per_code) * d_num_coarse_bins * (d_fine_fft_size / 2) * d_doppler_rates.size();
+    }
+
+    inline uint32_t num_coarse_bins() const
+    {
+        return d_num_coarse_bins;
+    }
+
+    inline uint32_t fine_fft_size() const
+    {
+        return d_fine_fft_size;
+    }
+
+    inline uint32_t num_doppler_rates() const
+    {
+        return static_cast<uint32_t>(d_doppler_rates.size());
+    }
+
+private:
+    void wipe_data_bits(gr_complex* samples, uint64_t first_sample, const Acq_Data_Bit_Aid& bit_aid) const;
+
+    std::unique_ptr<gnss_fft_complex_fwd> d_fft;
+    std::unique_ptr<gnss_fft_complex_rev> d_ifft;
+    std::unique_ptr<gnss_fft_complex_fwd> d_fine_fft;
+    volk_gnsssdr::vector<gr_complex> d_fft_code;
+    volk_gnsssdr::vector<gr_complex> d_wipeoff;
+    volk_gnsssdr::vector<gr_complex> d_correlations;  // of each code period (rows) and code phase
+    volk_gnsssdr::vector<float> d_power;
+    std::vector<std::vector<gr_complex>> d_rate_rotations;  // of each Doppler rate and code period
+    std::vector<float> d_doppler_rates;
+    double d_fs;
+    double d_code_period_s;
+    double d_coarse_step_hz;
+    uint32_t d_samples_per_code;
+    uint32_t d_code_periods;
+    uint32_t d_num_coarse_bins;
+    uint32_t d_fine_fft_size;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_ACQ_HIGH_SENSITIVITY_SEARCH_H
@@ -0,0 +1,372 @@
+/*!
+ * \file acq_opencl_engine.cc
+ * \brief OpenCL backend of the PCPS acquisition. It computes the Doppler
+ * wipeoff, the FFT-based correlation and the squared magnitude of a batch of
+ * Doppler bins on a GPU.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_opencl_engine.h"
+#include "gnss_sdr_make_unique.h"
+#include <glog/logging.h>
+#include <volk/volk.h>
+#include <algorithm>  // for fill_n, max, min
+#include <cstring>    // for memcpy
+#include <mutex>
+#include <string>
+#include <utility>  // for move
+#include <vector>
+
+
+namespace
+{
+// Complex samples are stored as float2 (interleaved real and imaginary parts)
+const char* const ACQ_OPENCL_KERNELS = R"(
+__kernel void wipeoff_batch(__global const float2* in,
+    __global const float2* wipeoffs,
+    __global float2* out,
+    const uint n,
+    const uint m,
+    const uint first_bin)
+{
+    const uint i = get_global_id(0);
+    const uint bin = get_global_id(1);
+    float2 v = (float2)(0.0f, 0.0f);
+    if (i < n)
+        {
+            const float2 a = in[i];
+            const float2 b = wipeoffs[(first_bin + bin) * n + i];
+            v = (float2)(a.x * b.x - a.y * b.y, a.x * b.y + a.y * b.x);
+        }
+    out[bin * m + i] = v;
+}
+
+__kernel void code_product_batch(__global float2* x,
+    __global const float2* code,
+    const uint m)
+{
+    const uint i = get_global_id(0);
+    const uint k = get_global_id(1) * m + i;
+    const float2 a = x[k];
+    const float2 b = code[i];
+    x[k] = (float2)(a.x * b.x - a.y * b.y, a.x * b.y + a.y * b.x);
+}
+
+__kernel void magnitude_squared_batch(__global const float2* x,
+    __global float* magnitude,
+    const uint m,
+    const uint offset,
+    const uint length,
+    const float scale)
+{
+    const uint i = get_global_id(0);
+    const uint bin = get_global_id(1);
+    const float2 a = x[bin * m + offset + i];
+    magnitude[bin * length + i] = scale * (a.x * a.x + a.y * a.y);
+}
+
+__kernel void conjugate(__global float2* x)
+{
+    const uint i = get_global_id(0);
+    x[i].y = -x[i].y;
+}
+)";
+
+
+uint32_t next_power_of_two(uint32_t n)
+{
+    uint32_t p = 1U;
+    while (p < n)
+        {
+            p <<= 1U;
+        }
+    return p;
+}
+}  // namespace
+
+
+struct Acq_Opencl_Engine::Device
+{
+    cl::Device device;
+    cl::Context context;
+    cl::Program program;
+};
+
+
+std::unique_ptr<Acq_Opencl_Engine> Acq_Opencl_Engine::make(uint32_t fft_size, uint32_t max_batch_bins)
+{
+    // The context and the program are built once, and shared while any engine is alive
+    static std::mutex device_mutex;
+    static std::weak_ptr<Device> shared_device;
+
+    std::shared_ptr<Device> device;
+    {
+        std::lock_guard<std::mutex> lock(device_mutex);
+        device = shared_device.lock();
+        if (!device)
+            {
+                std::vector<cl::Platform> platforms;
+                cl::Platform::get(&platforms);
+                if (platforms.empty())
+                    {
+                        LOG(WARNING) << "No OpenCL platforms found. Check OpenCL installation!";
+                        return nullptr;
+                    }
+                std::vector<cl::Device> gpu_devices;
+                platforms[0].getDevices(CL_DEVICE_TYPE_GPU, &gpu_devices);
+                if (gpu_devices.empty())
+                    {
+                        LOG(WARNING) << "No OpenCL GPU devices found. Check OpenCL installation!";
+                        return nullptr;
+                    }
+
+                device = std::make_shared<Device>();
+                device->device = gpu_devices[0];
+                const std::vector<cl::Device> devices(1, device->device);
+                cl_int err = CL_SUCCESS;
+                device->context = cl::Context(devices, nullptr, nullptr, nullptr, &err);
+                if (err != CL_SUCCESS)
+                    {
+                        LOG(WARNING) << "Error creating the OpenCL context: " << err;
+                        return nullptr;
+                    }
+                const std::string kernel_code(ACQ_OPENCL_KERNELS);
+                const cl::Program::Sources sources(1, std::make_pair(kernel_code.c_str(), kernel_code.length()));
+                device->program = cl::Program(device->context, sources);
+                if (device->program.build(devices) != CL_SUCCESS)
+                    {
+                        LOG(WARNING) << "Error building the OpenCL acquisition kernels: "
+                                     << device->program.getBuildInfo<CL_PROGRAM_BUILD_LOG>(device->device);
+                        return nullptr;
+                    }
+                shared_device = device;
+                LOG(INFO) << "Acquisition OpenCL device: " << device->device.getInfo<CL_DEVICE_NAME>()
+                          << " (" << platforms[0].getInfo<CL_PLATFORM_NAME>() << ")";
+            }
+    }
+
+    std::unique_ptr<Acq_Opencl_Engine> engine(new Acq_Opencl_Engine(std::move(device), fft_size, max_batch_bins));
+    if (!engine->create_resources())
+        {
+            return nullptr;
+        }
+    return engine;
+}
+
+
+Acq_Opencl_Engine::Acq_Opencl_Engine(std::shared_ptr<Device> device,
+    uint32_t fft_size,
+    uint32_t max_batch_bins) : d_device(std::move(device)),
+                               d_num_wipeoffs{0U, 0U},
+                               d_fft_plan(nullptr),
+                               d_scale(1.0),
+                               d_fft_size(fft_size),
+                               d_opencl_fft_size(next_power_of_two(2 * fft_size)),
+                               d_max_batch_bins(std::max(max_batch_bins, 1U))
+{
+    // The forward and inverse FFTs scale the correlation by d_opencl_fft_size
+    // instead of d_fft_size
+    const float ratio = static_cast<float>(d_fft_size) / static_cast<float>(d_opencl_fft_size);
+    d_scale = ratio * ratio;
+}
+
+
+Acq_Opencl_Engine::~Acq_Opencl_Engine()
+{
+    if (d_queue)
+        {
+            d_queue->finish();
+        }
+    if (d_fft_plan != nullptr)
+        {
+            clFFT_DestroyPlan(d_fft_plan);
+        }
+}
+
+
+bool Acq_Opencl_Engine::create_resources()
+{
+    cl_int err = CL_SUCCESS;
+    cl_int buffer_err = CL_SUCCESS;
+    const cl::Context& context = d_device->context;
+    const size_t batch_samples = static_cast<size_t>(d_opencl_fft_size) * d_max_batch_bins;
+
+    d_queue = std::make_unique<cl::CommandQueue>(context, d_device->device, 0, &err);
+    d_buffer_in = std::make_unique<cl::Buffer>(context, CL_MEM_READ_ONLY, sizeof(gr_complex) * d_fft_size, nullptr, &buffer_err);
+    err |= buffer_err;
+    d_buffer_code = std::make_unique<cl::Buffer>(context, CL_MEM_READ_WRITE, sizeof(gr_complex) * d_opencl_fft_size, nullptr, &buffer_err);
+    err |= buffer_err;
+    d_buffer_batch = std::make_unique<cl::Buffer>(context, CL_MEM_READ_WRITE, sizeof(gr_complex) * batch_samples, nullptr, &buffer_err);
+    err |= buffer_err;
+    d_buffer_magnitude = std::make_unique<cl::Buffer>(context, CL_MEM_WRITE_ONLY, sizeof(float) * d_fft_size * d_max_batch_bins, nullptr, &buffer_err);
+    err |= buffer_err;
+    if (err != CL_SUCCESS)
+        {
+            LOG(WARNING) << "Error creating the OpenCL acquisition buffers: " << err;
+            return false;
+        }
+
+    d_kernel_wipeoff = cl::Kernel(d_device->program, "wipeoff_batch", &err);
+    d_kernel_code_product = cl::Kernel(d_device->program, "code_product_batch", &buffer_err);
+    err |= buffer_err;
+    d_kernel_magnitude = cl::Kernel(d_device->program, "magnitude_squared_batch", &buffer_err);
+    err |= buffer_err;
+    d_kernel_conjugate = cl::Kernel(d_device->program, "conjugate", &buffer_err);
+    err |= buffer_err;
+    if (err != CL_SUCCESS)
+        {
+            LOG(WARNING) << "Error creating the OpenCL acquisition kernels: " << err;
+            return false;
+        }
+
+    const clFFT_Dim3 dim = {d_opencl_fft_size, 1, 1};
+    d_fft_plan = clFFT_CreatePlan(context(), dim, clFFT_1D, clFFT_InterleavedComplexFormat, &err);
+    if (err != CL_SUCCESS)
+        {
+            d_fft_plan = nullptr;
+            LOG(WARNING) << "Error creating the OpenCL FFT plan of size " << d_opencl_fft_size << ": " << err;
+            return false;
+        }
+
+    d_code_buffer = volk_gnsssdr::vector<gr_complex>(d_opencl_fft_size);
+    d_magnitude = volk_gnsssdr::vector<float>(static_cast<size_t>(d_fft_size) * d_max_batch_bins);
+    return true;
+}
+
+
+bool Acq_Opencl_Engine::set_local_code(const gr_complex* code)
+{
+    // With a copy of the code at the beginning and another one at the end of
+    // the padded buffer, the lags [0, d_fft_size) of the linear correlation
+    // are the circular correlation of d_fft_size samples
+    std::fill_n(d_code_buffer.begin(), d_opencl_fft_size, gr_complex(0.0, 0.0));
+    memcpy(d_code_buffer.data(), code, sizeof(gr_complex) * d_fft_size);
+    memcpy(d_code_buffer.data() + (d_opencl_fft_size - d_fft_size), code, sizeof(gr_complex) * d_fft_size);
+
+    cl_int err = d_queue->enqueueWriteBuffer(*d_buffer_code, CL_FALSE, 0, sizeof(gr_complex) * d_opencl_fft_size, d_code_buffer.data());
+    err |= clFFT_ExecuteInterleaved((*d_queue)(), d_fft_plan, 1, clFFT_Forward, (*d_buffer_code)(), (*d_buffer_code)(), 0, nullptr, nullptr);
+    err |= d_kernel_conjugate.setArg(0, *d_buffer_code);
+    err |= d_queue->enqueueNDRangeKernel(d_kernel_conjugate, cl::NullRange, cl::NDRange(d_opencl_fft_size), cl::NullRange);
+    err |= d_queue->finish();
+    if (err != CL_SUCCESS)
+        {
+            LOG(WARNING) << "Error computing the FFT of the local code on the OpenCL device: " << err;
+            return false;
+        }
+    return true;
+}
+
+
+bool Acq_Opencl_Engine::set_wipeoffs(uint32_t grid, const volk_gnsssdr::vector<volk_gnsssdr::vector<gr_complex>>& wipeoffs)
+{
+    const auto num_bins = static_cast<uint32_t>(wipeoffs.size());
+    cl_int err = CL_SUCCESS;
+    if (num_bins > d_num_wipeoffs[grid] or !d_buffer_wipeoffs[grid])
+        {
+            d_buffer_wipeoffs[grid] = std::make_unique<cl::Buffer>(d_device->context, CL_MEM_READ_ONLY, sizeof(gr_complex) * d_fft_size * std::max(num_bins, 1U), nullptr, &err);
+            if (err != CL_SUCCESS)
+                {
+                    d_buffer_wipeoffs[grid].reset();
+                    d_num_wipeoffs[grid] = 0U;
+                    LOG(WARNING) << "Error creating the OpenCL Doppler wipeoff buffer: " << err;
+                    return false;
+                }
+        }
+    d_num_wipeoffs[grid] = num_bins;
+    for (uint32_t doppler_index = 0; doppler_index < num_bins; doppler_index++)
+        {
+            err |= d_queue->enqueueWriteBuffer(*d_buffer_wipeoffs[grid], CL_FALSE, sizeof(gr_complex) * d_fft_size * doppler_index,
+                sizeof(gr_complex) * d_fft_size, wipeoffs[doppler_index].data());
+        }
+    err |= d_queue->finish();
+    if (err != CL_SUCCESS)
+        {
+            LOG(WARNING) << "Error uploading the Doppler wipeoffs to the OpenCL device: " << err;
+            return false;
+        }
+    return true;
+}
+
+
+bool Acq_Opencl_Engine::search(const gr_complex* in,
+    uint32_t grid,
+    uint32_t first_bin,
+    uint32_t num_bins,
+    uint32_t offset,
+    uint32_t length,
+    volk_gnsssdr::vector<volk_gnsssdr::vector<float>>& magnitude_grid,
+    bool accumulate)
+{
+    if (first_bin + num_bins > d_num_wipeoffs[grid] or offset + length > d_fft_size)
+        {
+            return false;
+        }
+
+    cl_int err = d_queue->enqueueWriteBuffer(*d_buffer_in, CL_FALSE, 0, sizeof(gr_complex) * d_fft_size, in);
+    err |= d_kernel_wipeoff.setArg(0, *d_buffer_in);
+    err |= d_kernel_wipeoff.setArg(1, *d_buffer_wipeoffs[grid]);
+    err |= d_kernel_wipeoff.setArg(2, *d_buffer_batch);
+    err |= d_kernel_wipeoff.setArg(3, d_fft_size);
+    err |= d_kernel_wipeoff.setArg(4, d_opencl_fft_size);
+    err |= d_kernel_code_product.setArg(0, *d_buffer_batch);
+    err |= d_kernel_code_product.setArg(1, *d_buffer_code);
+    err |= d_kernel_code_product.setArg(2, d_opencl_fft_size);
+    err |= d_kernel_magnitude.setArg(0, *d_buffer_batch);
+    err |= d_kernel_magnitude.setArg(1, *d_buffer_magnitude);
+    err |= d_kernel_magnitude.setArg(2, d_opencl_fft_size);
+    err |= d_kernel_magnitude.setArg(3, offset);
+    err |= d_kernel_magnitude.setArg(4, length);
+    err |= d_kernel_magnitude.setArg(5, d_scale);
+
+    for (uint32_t batch_start = 0; batch_start < num_bins and err == CL_SUCCESS; batch_start += d_max_batch_bins)
+        {
+            const uint32_t batch_bins = std::min(d_max_batch_bins, num_bins - batch_start);
+
+            // Doppler wipeoff and zero padding of the whole batch
+            err |= d_kernel_wipeoff.setArg(5, first_bin + batch_start);
+            err |= d_queue->enqueueNDRangeKernel(d_kernel_wipeoff, cl::NullRange, cl::NDRange(d_opencl_fft_size, batch_bins), cl::NullRange);
+
+            // FFT-based correlation of all the bins of the batch
+            err |= clFFT_ExecuteInterleaved((*d_queue)(), d_fft_plan, static_cast<cl_int>(batch_bins), clFFT_Forward, (*d_buffer_batch)(), (*d_buffer_batch)(), 0, nullptr, nullptr);
+            err |= d_queue->enqueueNDRangeKernel(d_kernel_code_product, cl::NullRange, cl::NDRange(d_opencl_fft_size, batch_bins), cl::NullRange);
+            err |= clFFT_ExecuteInterleaved((*d_queue)(), d_fft_plan, static_cast<cl_int>(batch_bins), clFFT_Inverse, (*d_buffer_batch)(), (*d_buffer_batch)(), 0, nullptr, nullptr);
+            err |= d_queue->enqueueNDRangeKernel(d_kernel_magnitude, cl::NullRange, cl::NDRange(length, batch_bins), cl::NullRange);
+
+            // Blocks until the batch is done
+            err |= d_queue->enqueueReadBuffer(*d_buffer_magnitude, CL_TRUE, 0, sizeof(float) * length * batch_bins, d_magnitude.data());
+            if (err != CL_SUCCESS)
+                {
+                    break;
+                }
+
+            for (uint32_t k = 0; k < batch_bins; k++)
+                {
+                    float* row = magnitude_grid[first_bin + batch_start + k].data();
+                    const float* batch_row = d_magnitude.data() + static_cast<size_t>(k) * length;
+                    if (accumulate)
+                        {
+                            volk_32f_x2_add_32f(row, row, batch_row, length);
+                        }
+                    else
+                        {
+                            memcpy(row, batch_row, sizeof(float) * length);
+                        }
+                }
+        }
+
+    if (err != CL_SUCCESS)
+        {
+            LOG(WARNING) << "Error running the acquisition search on the OpenCL device: " << err;
+            return false;
+        }
+    return true;
+}
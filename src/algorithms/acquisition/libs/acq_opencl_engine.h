@@ -0,0 +1,119 @@
+/*!
+ * \file acq_opencl_engine.h
+ * \brief OpenCL backend of the PCPS acquisition. It computes the Doppler
+ * wipeoff, the FFT-based correlation and the squared magnitude of a batch of
+ * Doppler bins on a GPU.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ACQ_OPENCL_ENGINE_H
+#define GNSS_SDR_ACQ_OPENCL_ENGINE_H
+
+#define CL_SILENCE_DEPRECATION
+#include "opencl/clFFT.h"
+#include <gnuradio/gr_complex.h>
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include "opencl/cl.hpp"
+#include <array>
+#include <cstdint>
+#include <memory>
+
+/** \addtogroup Acquisition
+ * \{ */
+/** \addtogroup acquisition_libs
+ * \{ */
+
+
+/*!
+ * \brief Computes the PCPS acquisition grid on an OpenCL device.
+ *
+ * All the engines share the same OpenCL context and program, but each one
+ * has its own command queue, FFT plan and device buffers, so that channels
+ * can search concurrently. The Doppler bins of a search are processed in
+ * batches of up to max_batch_bins bins: one kernel does the carrier wipeoff
+ * of the whole batch, and the forward and inverse FFTs are batched.
+ *
+ * The bundled clFFT only supports power-of-two sizes, so the circular
+ * correlation of fft_size samples is computed with FFTs of the next power of
+ * two not smaller than 2 * fft_size, with two copies of the local code.
+ *
+ * Methods return false on OpenCL errors, so that the caller can fall back to
+ * the CPU implementation.
+ */
+class Acq_Opencl_Engine
+{
+public:
+    /*!
+     * \brief Returns an engine on the first GPU of the first OpenCL platform,
+     * or nullptr if no GPU is available or the OpenCL resources cannot be created.
+     */
+    static std::unique_ptr<Acq_Opencl_Engine> make(uint32_t fft_size, uint32_t max_batch_bins);
+
+    ~Acq_Opencl_Engine();
+
+    /*!
+     * \brief Sets the local code (fft_size samples, time domain)
+     */
+    bool set_local_code(const gr_complex* code);
+
+    /*!
+     * \brief Uploads the Doppler wipeoffs of a grid (0: first step, 1: second step)
+     */
+    bool set_wipeoffs(uint32_t grid, const volk_gnsssdr::vector<volk_gnsssdr::vector<gr_complex>>& wipeoffs);
+
+    /*!
+     * \brief Searches num_bins Doppler bins of a grid, starting at first_bin.
+     * Writes (or adds, if accumulate is true) the squared magnitude of the
+     * correlation samples [offset, offset + length) of each bin to the
+     * corresponding row of magnitude_grid, with the same scale as the CPU search.
+     */
+    bool search(const gr_complex* in,
+        uint32_t grid,
+        uint32_t first_bin,
+        uint32_t num_bins,
+        uint32_t offset,
+        uint32_t length,
+        volk_gnsssdr::vector<volk_gnsssdr::vector<float>>& magnitude_grid,
+        bool accumulate);
+
+private:
+    struct Device;
+
+    Acq_Opencl_Engine(std::shared_ptr<Device> device, uint32_t fft_size, uint32_t max_batch_bins);
+
+    bool create_resources();
+
+    std::shared_ptr<Device> d_device;
+    std::unique_ptr<cl::CommandQueue> d_queue;
+    std::unique_ptr<cl::Buffer> d_buffer_in;
+    std::unique_ptr<cl::Buffer> d_buffer_code;
+    std::unique_ptr<cl::Buffer> d_buffer_batch;
+    std::unique_ptr<cl::Buffer> d_buffer_magnitude;
+    std::array<std::unique_ptr<cl::Buffer>, 2> d_buffer_wipeoffs;
+    std::array<uint32_t, 2> d_num_wipeoffs;
+    cl::Kernel d_kernel_wipeoff;
+    cl::Kernel d_kernel_code_product;
+    cl::Kernel d_kernel_magnitude;
+    cl::Kernel d_kernel_conjugate;
+    clFFT_Plan d_fft_plan;
+    volk_gnsssdr::vector<gr_complex> d_code_buffer;
+    volk_gnsssdr::vector<float> d_magnitude;
+    float d_scale;
+    uint32_t d_fft_size;
+    uint32_t d_opencl_fft_size;
+    uint32_t d_max_batch_bins;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_ACQ_OPENCL_ENGINE_H
@@ -0,0 +1,75 @@
+/*!
+ * \file acq_pcps_engine.cc
+ * \brief Doppler grid search of the PCPS acquisition algorithms, shared by
+ * the acquisition blocks that only differ in their test statistics.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_pcps_engine.h"
+#include "acq_code_spectrum_cache.h"
+#include <volk/volk.h>
+#include <cstring>  // for memcpy
+#include <vector>
+
+
+Acq_Pcps_Engine::Acq_Pcps_Engine(int64_t fs, uint32_t fft_size) : d_fft_if(gnss_fft_fwd_make_unique(fft_size)),
+                                                                   d_ifft(gnss_fft_rev_make_unique(fft_size)),
+                                                                   d_fs(fs),
+                                                                   d_fft_size(fft_size),
+                                                                   d_num_doppler_bins(0)
+{
+}
+
+
+void Acq_Pcps_Engine::set_doppler_grid(const std::string& signal, int32_t doppler_max, int32_t doppler_step)
+{
+    std::vector<double> doppler_freqs;
+    for (int32_t doppler = -doppler_max; doppler <= doppler_max; doppler += doppler_step)
+        {
+            doppler_freqs.push_back(static_cast<double>(doppler));
+        }
+    d_num_doppler_bins = static_cast<uint32_t>(doppler_freqs.size());
+    d_front_end = Acq_Shared_Front_End::get(signal, d_fs, d_fft_size, doppler_freqs, d_num_doppler_bins);
+}
+
+
+void Acq_Pcps_Engine::code_spectrum(const gr_complex* code, gr_complex* fft_code)
+{
+    if (Acq_Code_Spectrum_Cache::get().fetch(code, d_fft_size, 0U, fft_code, nullptr))
+        {
+            return;
+        }
+    memcpy(d_fft_if->get_inbuf(), code, sizeof(gr_complex) * d_fft_size);
+    d_fft_if->execute();
+    volk_32fc_conjugate_32fc(fft_code, d_fft_if->get_outbuf(), d_fft_size);
+    Acq_Code_Spectrum_Cache::get().store(code, d_fft_size, 0U, fft_code, nullptr);
+}
+
+
+const gr_complex* Acq_Pcps_Engine::input_spectrum(const gr_complex* in, uint64_t sample_stamp, uint32_t doppler_index)
+{
+    if (!d_front_end->fetch_spectrum(sample_stamp, doppler_index, in, d_fft_if->get_outbuf()))
+        {
+            volk_32fc_x2_multiply_32fc(d_fft_if->get_inbuf(), in, d_front_end->wipeoff(doppler_index), d_fft_size);
+            d_fft_if->execute();
+            d_front_end->store_spectrum(sample_stamp, doppler_index, in, d_fft_if->get_outbuf());
+        }
+    return d_fft_if->get_outbuf();
+}
+
+
+const gr_complex* Acq_Pcps_Engine::correlate(const gr_complex* fft_code)
+{
+    volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(), d_fft_if->get_outbuf(), fft_code, d_fft_size);
+    d_ifft->execute();
+    return d_ifft->get_outbuf();
+}
@@ -0,0 +1,89 @@
+/*!
+ * \file acq_pcps_engine.h
+ * \brief Doppler grid search of the PCPS acquisition algorithms, shared by
+ * the acquisition blocks that only differ in their test statistics.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ACQ_PCPS_ENGINE_H
+#define GNSS_SDR_ACQ_PCPS_ENGINE_H
+
+#include "acq_shared_front_end.h"
+#include "gnss_sdr_fft.h"
+#include <gnuradio/gr_complex.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/** \addtogroup Acquisition
+ * \{ */
+/** \addtogroup acquisition_libs
+ * \{ */
+
+
+/*!
+ * \brief Parallel code phase search over a Doppler grid.
+ *
+ * For each Doppler bin, the engine transforms the Doppler-wiped input block
+ * and correlates it with any number of local code spectra, leaving the test
+ * statistics to the acquisition block. The Doppler wipeoff tables and the
+ * transformed input blocks are shared with the other channels searching the
+ * same signal with the same grid (see Acq_Shared_Front_End), and the code
+ * spectra with all the channels (see Acq_Code_Spectrum_Cache).
+ */
+class Acq_Pcps_Engine
+{
+public:
+    Acq_Pcps_Engine(int64_t fs, uint32_t fft_size);
+
+    /*!
+     * \brief Sets the Doppler grid -doppler_max, -doppler_max + doppler_step,
+     * ... up to doppler_max, for the channels searching signal.
+     */
+    void set_doppler_grid(const std::string& signal, int32_t doppler_max, int32_t doppler_step);
+
+    inline uint32_t num_doppler_bins() const
+    {
+        return d_num_doppler_bins;
+    }
+
+    /*!
+     * \brief Computes in fft_code (fft_size samples) the conjugated FFT of code
+     */
+    void code_spectrum(const gr_complex* code, gr_complex* fft_code);
+
+    /*!
+     * \brief Transforms the input block ending at sample_stamp, wiped off
+     * with the Doppler bin doppler_index. Returns the spectrum, valid until
+     * the next call.
+     */
+    const gr_complex* input_spectrum(const gr_complex* in, uint64_t sample_stamp, uint32_t doppler_index);
+
+    /*!
+     * \brief Circular correlation of the last input spectrum with the code
+     * spectrum fft_code. Returns the correlation, valid until the next call.
+     */
+    const gr_complex* correlate(const gr_complex* fft_code);
+
+private:
+    std::unique_ptr<gnss_fft_complex_fwd> d_fft_if;
+    std::unique_ptr<gnss_fft_complex_rev> d_ifft;
+    std::shared_ptr<Acq_Shared_Front_End> d_front_end;
+    int64_t d_fs;
+    uint32_t d_fft_size;
+    uint32_t d_num_doppler_bins;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_ACQ_PCPS_ENGINE_H
@@ -0,0 +1,122 @@
+/*!
+ * \file acq_shared_front_end.cc
+ * \brief Doppler wipeoff tables and forward FFTs of the input signal shared
+ * by all the PCPS acquisition channels searching the same signal.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_shared_front_end.h"
+#include "MATH_CONSTANTS.h"  // for TWO_PI
+#include <glog/logging.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>  // for equal, max, min
+#include <cmath>      // for llround
+#include <cstring>    // for memcpy
+#include <map>
+
+
+std::shared_ptr<Acq_Shared_Front_End> Acq_Shared_Front_End::get(const std::string& signal,
+    int64_t fs,
+    uint32_t fft_size,
+    const std::vector<double>& doppler_freqs,
+    uint32_t num_spectra)
+{
+    static std::mutex registry_mutex;
+    static std::map<std::string, std::weak_ptr<Acq_Shared_Front_End>> registry;
+
+    // Doppler frequencies are compared in mHz
+    std::string key = signal + "_" + std::to_string(fs) + "_" + std::to_string(fft_size) + "_" + std::to_string(num_spectra);
+    for (const auto freq : doppler_freqs)
+        {
+            key += "_" + std::to_string(std::llround(freq * 1000.0));
+        }
+
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    for (auto it = registry.begin(); it != registry.end();)
+        {
+            if (it->second.expired())
+                {
+                    it = registry.erase(it);
+                }
+            else
+                {
+                    ++it;
+                }
+        }
+
+    auto front_end = registry[key].lock();
+    if (!front_end)
+        {
+            front_end = std::make_shared<Acq_Shared_Front_End>(fs, fft_size, doppler_freqs, num_spectra);
+            registry[key] = front_end;
+            DLOG(INFO) << "Created a shared acquisition front end for signal " << signal
+                       << " with " << doppler_freqs.size() << " Doppler bins";
+        }
+    return front_end;
+}
+
+
+Acq_Shared_Front_End::Acq_Shared_Front_End(int64_t fs,
+    uint32_t fft_size,
+    const std::vector<double>& doppler_freqs,
+    uint32_t num_spectra) : d_spectra_stamp(num_spectra, 0ULL),
+                            d_spectra_signature(num_spectra),
+                            d_spectra_valid(num_spectra, false),
+                            d_fft_size(fft_size)
+{
+    d_grid_doppler_wipeoffs = volk_gnsssdr::vector<volk_gnsssdr::vector<gr_complex>>(doppler_freqs.size(), volk_gnsssdr::vector<gr_complex>(fft_size));
+    for (size_t doppler_index = 0; doppler_index < doppler_freqs.size(); doppler_index++)
+        {
+            const float phase_step_rad = static_cast<float>(TWO_PI) * static_cast<float>(doppler_freqs[doppler_index]) / static_cast<float>(fs);
+            std::array<float, 1> _phase{};
+            volk_gnsssdr_s32f_sincos_32fc(d_grid_doppler_wipeoffs[doppler_index].data(), -phase_step_rad, _phase.data(), fft_size);
+        }
+    d_spectra = volk_gnsssdr::vector<volk_gnsssdr::vector<gr_complex>>(num_spectra, volk_gnsssdr::vector<gr_complex>(fft_size));
+}
+
+
+Acq_Shared_Front_End::Signature Acq_Shared_Front_End::signature(const gr_complex* in) const
+{
+    // The sample stamp alone does not guarantee that two channels got the
+    // same samples, so a few of them are also compared.
+    Signature sig{};
+    const uint32_t stride = std::max(d_fft_size / static_cast<uint32_t>(SIGNATURE_LENGTH), 1U);
+    for (size_t i = 0; i < SIGNATURE_LENGTH; i++)
+        {
+            sig[i] = in[std::min(static_cast<uint32_t>(i) * stride, d_fft_size - 1)];
+        }
+    return sig;
+}
+
+
+bool Acq_Shared_Front_End::fetch_spectrum(uint64_t sample_stamp, uint32_t spectrum_index, const gr_complex* in, gr_complex* out)
+{
+    const Signature sig = signature(in);
+    std::lock_guard<std::mutex> lock(d_mutex);
+    if (!d_spectra_valid[spectrum_index] or (d_spectra_stamp[spectrum_index] != sample_stamp) or !std::equal(sig.cbegin(), sig.cend(), d_spectra_signature[spectrum_index].cbegin()))
+        {
+            return false;
+        }
+    memcpy(out, d_spectra[spectrum_index].data(), sizeof(gr_complex) * d_fft_size);
+    return true;
+}
+
+
+void Acq_Shared_Front_End::store_spectrum(uint64_t sample_stamp, uint32_t spectrum_index, const gr_complex* in, const gr_complex* spectrum)
+{
+    const Signature sig = signature(in);
+    std::lock_guard<std::mutex> lock(d_mutex);
+    memcpy(d_spectra[spectrum_index].data(), spectrum, sizeof(gr_complex) * d_fft_size);
+    d_spectra_stamp[spectrum_index] = sample_stamp;
+    d_spectra_signature[spectrum_index] = sig;
+    d_spectra_valid[spectrum_index] = true;
+}
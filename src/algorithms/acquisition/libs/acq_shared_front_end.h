@@ -0,0 +1,97 @@
+/*!
+ * \file acq_shared_front_end.h
+ * \brief Doppler wipeoff tables and forward FFTs of the input signal shared
+ * by all the PCPS acquisition channels searching the same signal.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ACQ_SHARED_FRONT_END_H
+#define GNSS_SDR_ACQ_SHARED_FRONT_END_H
+
+#include <gnuradio/gr_complex.h>
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/** \addtogroup Acquisition
+ * \{ */
+/** \addtogroup acquisition_libs
+ * \{ */
+
+
+/*!
+ * \brief Acquisition front stage shared by all the channels searching the
+ * same signal with the same Doppler grid.
+ *
+ * It holds a single copy of the Doppler wipeoff tables, and caches the
+ * Doppler-wiped, Fourier-transformed input blocks so that channels processing
+ * the same input block (same sample stamp) only need to compute the code
+ * multiplication and the inverse FFT. All the channels sharing an instance
+ * must be fed from the same sample stream.
+ */
+class Acq_Shared_Front_End
+{
+public:
+    /*!
+     * \brief Returns the instance for the given signal and Doppler grid,
+     * creating it if no channel is currently using it.
+     */
+    static std::shared_ptr<Acq_Shared_Front_End> get(const std::string& signal,
+        int64_t fs,
+        uint32_t fft_size,
+        const std::vector<double>& doppler_freqs,
+        uint32_t num_spectra);
+
+    Acq_Shared_Front_End(int64_t fs, uint32_t fft_size, const std::vector<double>& doppler_freqs, uint32_t num_spectra);
+
+    /*!
+     * \brief Doppler wipeoff of bin doppler_index (read-only)
+     */
+    inline const gr_complex* wipeoff(uint32_t doppler_index) const
+    {
+        return d_grid_doppler_wipeoffs[doppler_index].data();
+    }
+
+    /*!
+     * \brief Copies to out the cached spectrum for the input block ending at
+     * sample_stamp, if available. Returns false on cache miss.
+     */
+    bool fetch_spectrum(uint64_t sample_stamp, uint32_t spectrum_index, const gr_complex* in, gr_complex* out);
+
+    /*!
+     * \brief Stores the spectrum computed for the input block ending at sample_stamp
+     */
+    void store_spectrum(uint64_t sample_stamp, uint32_t spectrum_index, const gr_complex* in, const gr_complex* spectrum);
+
+private:
+    static constexpr size_t SIGNATURE_LENGTH = 8;
+    using Signature = std::array<gr_complex, SIGNATURE_LENGTH>;
+
+    Signature signature(const gr_complex* in) const;
+
+    volk_gnsssdr::vector<volk_gnsssdr::vector<gr_complex>> d_grid_doppler_wipeoffs;
+    volk_gnsssdr::vector<volk_gnsssdr::vector<gr_complex>> d_spectra;
+    std::vector<uint64_t> d_spectra_stamp;
+    std::vector<Signature> d_spectra_signature;
+    std::vector<bool> d_spectra_valid;
+    std::mutex d_mutex;
+    uint32_t d_fft_size;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_ACQ_SHARED_FRONT_END_H
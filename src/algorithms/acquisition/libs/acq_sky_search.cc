@@ -0,0 +1,317 @@
+/*!
+ * \file acq_sky_search.cc
+ * \brief Background search of the satellites of a signal that no channel is
+ * tracking, on the idle CPU time, for the channels that become free.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_sky_search.h"
+#include "GPS_L1_CA.h"
+#include "Galileo_E1.h"
+#include "acq_snapshot_search.h"
+#include "galileo_e1_signal_replica.h"
+#include "gnss_replica_cache.h"
+#include "gps_sdr_signal_replica.h"
+#include <glog/logging.h>
+#include <algorithm>  // for min
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstring>    // for memcpy
+#include <stdexcept>  // for invalid_argument
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+
+namespace
+{
+// lowers the priority of the calling thread, so that it only runs when a
+// CPU would be idle otherwise
+void sky_search_lower_priority()
+{
+#if defined(__linux__)
+    sched_param param{};
+    param.sched_priority = 0;
+    if (pthread_setschedparam(pthread_self(), SCHED_IDLE, &param) == 0)
+        {
+            return;
+        }
+    // the nice value is per thread on Linux
+    if (setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), 19) != 0)
+        {
+            LOG(WARNING) << "The sky search runs at the priority of the receiver";
+        }
+#endif
+}
+
+
+double sky_search_code_period_s(const std::string& signal)
+{
+    if (signal == "1C")
+        {
+            return GPS_L1_CA_CODE_PERIOD_S;
+        }
+    if (signal == "1B")
+        {
+            return GALILEO_E1_CODE_PERIOD_S;
+        }
+    throw std::invalid_argument("the sky search does not support the signal " + signal);
+}
+}  // namespace
+
+
+Acq_Sky_Search::Acq_Sky_Search(const std::string& signal, int64_t fs, const std::vector<uint32_t>& prns,
+    int32_t doppler_max, int32_t doppler_step, uint32_t code_periods, float threshold,
+    uint32_t interval_ms, uint32_t max_age_ms)
+    : d_prns(prns),
+      d_signal(signal),
+      d_max_age_samples(static_cast<uint64_t>(static_cast<double>(max_age_ms) * 1e-3 * static_cast<double>(fs))),
+      d_fs(static_cast<double>(fs)),
+      d_samples_per_code(0),
+      d_interval_ms(interval_ms),
+      d_doppler_max(doppler_max),
+      d_doppler_step(doppler_step),
+      d_threshold(threshold)
+{
+    const double samples_per_code = d_fs * sky_search_code_period_s(signal);
+    if (fs <= 0 or std::fabs(samples_per_code - std::round(samples_per_code)) > 1e-6)
+        {
+            throw std::invalid_argument("the code period of the signal " + signal + " is not a whole number of samples");
+        }
+    d_samples_per_code = static_cast<uint32_t>(std::round(samples_per_code));
+    d_burst.resize(static_cast<size_t>(std::max(code_periods, 1U)) * d_samples_per_code);
+    std::lock_guard<std::mutex> lock(d_mutex);
+    request_burst();
+}
+
+
+Acq_Sky_Search::~Acq_Sky_Search()
+{
+    stop();
+}
+
+
+void Acq_Sky_Search::start()
+{
+    if (!d_thread.joinable())
+        {
+            {
+                std::lock_guard<std::mutex> lock(d_mutex);
+                d_stop = false;
+            }
+            d_thread = std::thread(&Acq_Sky_Search::run, this);
+        }
+}
+
+
+void Acq_Sky_Search::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_stop = true;
+    }
+    d_cond.notify_all();
+    if (d_thread.joinable())
+        {
+            d_thread.join();
+        }
+}
+
+
+void Acq_Sky_Search::push(const gr_complex* in, int32_t n)
+{
+    const uint64_t first_sample = d_samples.load(std::memory_order_relaxed);
+    if (n > 0 and d_wanted.load(std::memory_order_acquire))
+        {
+            bool complete = false;
+            {
+                std::lock_guard<std::mutex> lock(d_mutex);
+                if (d_filled == 0)
+                    {
+                        d_burst_samples = first_sample;
+                    }
+                const size_t count = std::min(static_cast<size_t>(n), d_burst.size() - d_filled);
+                std::memcpy(d_burst.data() + d_filled, in, count * sizeof(gr_complex));
+                d_filled += count;
+                if (d_filled == d_burst.size())
+                    {
+                        d_ready = true;
+                        d_wanted.store(false, std::memory_order_release);
+                        complete = true;
+                    }
+            }
+            if (complete)
+                {
+                    d_cond.notify_all();
+                }
+        }
+    d_samples.store(first_sample + static_cast<uint64_t>(std::max(n, 0)), std::memory_order_relaxed);
+}
+
+
+bool Acq_Sky_Search::process_pending()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        if (!d_ready)
+            {
+                return false;
+            }
+    }
+    search_burst();
+    std::lock_guard<std::mutex> lock(d_mutex);
+    request_burst();
+    return true;
+}
+
+
+void Acq_Sky_Search::set_busy(uint32_t prn, bool busy)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    if (busy)
+        {
+            d_busy.insert(prn);
+            d_candidates.erase(prn);
+        }
+    else
+        {
+            d_busy.erase(prn);
+        }
+}
+
+
+bool Acq_Sky_Search::take_candidate(uint32_t prn, Acq_Sky_Candidate& candidate)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    const auto it = d_candidates.find(prn);
+    if (it == d_candidates.end())
+        {
+            return false;
+        }
+    const bool fresh = d_samples.load(std::memory_order_relaxed) - it->second.burst_samples <= d_max_age_samples;
+    if (fresh)
+        {
+            candidate = it->second;
+        }
+    d_candidates.erase(it);
+    return fresh;
+}
+
+
+size_t Acq_Sky_Search::candidates() const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_candidates.size();
+}
+
+
+uint64_t Acq_Sky_Search::searches() const
+{
+    return d_searches.load();
+}
+
+
+void Acq_Sky_Search::request_burst()
+{
+    d_filled = 0;
+    d_ready = false;
+    d_wanted.store(true, std::memory_order_release);
+}
+
+
+void Acq_Sky_Search::run()
+{
+    sky_search_lower_priority();
+    std::unique_lock<std::mutex> lock(d_mutex);
+    while (!d_stop)
+        {
+            d_cond.wait(lock, [this] { return d_stop or d_ready; });
+            if (d_stop)
+                {
+                    break;
+                }
+            lock.unlock();
+            search_burst();
+            lock.lock();
+            if (d_cond.wait_for(lock, std::chrono::milliseconds(d_interval_ms), [this] { return d_stop; }))
+                {
+                    break;
+                }
+            request_burst();
+        }
+}
+
+
+void Acq_Sky_Search::search_burst()
+{
+    // push() leaves the burst alone until the next request
+    std::vector<uint32_t> prns;
+    uint64_t burst_samples;
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        for (const uint32_t prn : d_prns)
+            {
+                if (d_busy.count(prn) == 0)
+                    {
+                        prns.push_back(prn);
+                    }
+            }
+        burst_samples = d_burst_samples;
+    }
+
+    std::vector<Acq_Snapshot_Result> results;
+    if (!prns.empty())
+        {
+            const bool gps = (d_signal == "1C");
+            const auto fs = static_cast<int32_t>(d_fs);
+            Acq_Snapshot_Search search(d_signal, static_cast<int64_t>(d_fs), d_samples_per_code, d_doppler_max, d_doppler_step);
+            for (const uint32_t prn : prns)
+                {
+                    const auto code = Gnss_Replica_Cache::get().get_complex(gps ? "GPS 1C" : "Galileo 1B", prn, d_fs, "snapshot", d_samples_per_code,
+                        [gps, prn, fs](own::span<std::complex<float>> replica) {
+                            if (gps)
+                                {
+                                    gps_l1_ca_code_gen_complex_sampled(replica, prn, fs, 0);
+                                }
+                            else
+                                {
+                                    galileo_e1_code_gen_complex_sampled(replica, {'1', 'B', '\0'}, false, prn, fs, 0, false);
+                                }
+                        });
+                    search.add_satellite(gps ? 'G' : 'E', prn, code->data());
+                }
+            results = search.search(d_burst.data(), d_burst.size(), d_threshold);
+        }
+
+    std::lock_guard<std::mutex> lock(d_mutex);
+    for (const auto& result : results)
+        {
+            if (!result.detected or d_busy.count(result.prn) != 0)
+                {
+                    d_candidates.erase(result.prn);
+                    continue;
+                }
+            Acq_Sky_Candidate candidate;
+            candidate.burst_samples = burst_samples;
+            candidate.code_epoch_samples = burst_samples + static_cast<uint64_t>(std::llround(result.code_phase_s * d_fs));
+            candidate.doppler_hz = result.doppler_hz;
+            candidate.test_statistic = result.test_statistic;
+            d_candidates[result.prn] = candidate;
+        }
+    d_ready = false;
+    d_searches++;
+}
@@ -0,0 +1,144 @@
+/*!
+ * \file acq_sky_search.h
+ * \brief Background search of the satellites of a signal that no channel is
+ * tracking, on the idle CPU time, for the channels that become free.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ACQ_SKY_SEARCH_H
+#define GNSS_SDR_ACQ_SKY_SEARCH_H
+
+#include <gnuradio/gr_complex.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+/** \addtogroup Acquisition
+ * \{ */
+/** \addtogroup acquisition_libs
+ * \{ */
+
+
+/*!
+ * \brief Satellite found by the sky search, ready to be tracked
+ */
+struct Acq_Sky_Candidate
+{
+    uint64_t code_epoch_samples{0};  //!< Sample counter of a code epoch, in the stream given to push()
+    uint64_t burst_samples{0};       //!< Sample counter of the first sample of the burst searched
+    double doppler_hz{0.0};
+    float test_statistic{0.0};
+};
+
+
+/*!
+ * \brief Searches all the satellites of a signal that are not busy in a
+ * burst of samples (see Acq_Snapshot_Search), once every interval, and
+ * keeps the ones detected as candidates for the channels that become free:
+ * a channel can start tracking a candidate at its code epoch and Doppler,
+ * as in a tracking handover, instead of searching a satellite that may not
+ * be in view.
+ *
+ * push() only copies the samples of the next burst, when the thread asks
+ * for one. The thread runs at the lowest priority of the OS (SCHED_IDLE
+ * on Linux), so it only uses the CPU time left by the receiver, and the
+ * candidates older than max_age_ms are not given.
+ *
+ * The searches are owned by the flow graph, which feeds each one with the
+ * output of the signal conditioner of the channels of its signal.
+ */
+class Acq_Sky_Search
+{
+public:
+    /*!
+     * \brief Searches the satellites prns of signal ("1C" or "1B"), in
+     * bursts of code_periods code periods. Throws std::invalid_argument if
+     * the signal is not one of those, or if its code period is not a whole
+     * number of samples at fs.
+     */
+    Acq_Sky_Search(const std::string& signal, int64_t fs, const std::vector<uint32_t>& prns,
+        int32_t doppler_max, int32_t doppler_step, uint32_t code_periods, float threshold,
+        uint32_t interval_ms, uint32_t max_age_ms);
+    ~Acq_Sky_Search();
+
+    Acq_Sky_Search(const Acq_Sky_Search&) = delete;
+    Acq_Sky_Search& operator=(const Acq_Sky_Search&) = delete;
+
+    void start();  //!< Starts the thread that searches the bursts
+    void stop();   //!< Stops it, the bursts are then searched by process_pending()
+
+    //! Takes the next n samples of the stream
+    void push(const gr_complex* in, int32_t n);
+
+    /*!
+     * \brief Searches the burst copied in the calling thread (without a
+     * thread, and for testing). Returns false if there is no burst yet.
+     */
+    bool process_pending();
+
+    //! Busy satellites (e.g., being tracked) are not searched
+    void set_busy(uint32_t prn, bool busy);
+
+    /*!
+     * \brief Takes the candidate of prn, if there is one and it is not older
+     * than max_age_ms. Returns false otherwise.
+     */
+    bool take_candidate(uint32_t prn, Acq_Sky_Candidate& candidate);
+
+    inline const std::string& signal() const
+    {
+        return d_signal;
+    }
+
+    size_t candidates() const;  //!< Candidates kept, fresh or not
+    uint64_t searches() const;  //!< Bursts searched
+
+private:
+    void run();
+    void search_burst();
+    void request_burst();  // with d_mutex held
+
+    std::vector<gr_complex> d_burst;
+    std::vector<uint32_t> d_prns;
+    std::set<uint32_t> d_busy;
+    std::map<uint32_t, Acq_Sky_Candidate> d_candidates;
+    std::string d_signal;
+    std::thread d_thread;
+    mutable std::mutex d_mutex;
+    std::condition_variable d_cond;
+    std::atomic<uint64_t> d_samples{0};  // pushed
+    std::atomic<uint64_t> d_searches{0};
+    std::atomic<bool> d_wanted{false};  // the burst is being copied
+    uint64_t d_burst_samples{0};        // sample counter of the first sample of the burst
+    uint64_t d_max_age_samples;
+    double d_fs;
+    size_t d_filled{0};  // samples of the burst copied
+    uint32_t d_samples_per_code;
+    uint32_t d_interval_ms;
+    int32_t d_doppler_max;
+    int32_t d_doppler_step;
+    float d_threshold;
+    bool d_ready{false};  // the burst is complete
+    bool d_stop{false};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_ACQ_SKY_SEARCH_H
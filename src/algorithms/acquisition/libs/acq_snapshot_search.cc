@@ -0,0 +1,141 @@
+/*!
+ * \file acq_snapshot_search.cc
+ * \brief Batched acquisition of all the satellites in a short burst of
+ * samples, with interpolated code phases for snapshot positioning.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_snapshot_search.h"
+#include <volk/volk.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>  // for fill
+#include <cmath>
+#include <numeric>  // for accumulate
+#include <utility>  // for move
+
+
+namespace
+{
+// offset of the vertex of the parabola through (-1, a), (0, b) and (1, c)
+double parabolic_offset(double a, double b, double c)
+{
+    const double den = a - 2.0 * b + c;
+    return (den < 0.0 ? 0.5 * (a - c) / den : 0.0);
+}
+}  // namespace
+
+
+Acq_Snapshot_Search::Acq_Snapshot_Search(const std::string& signal, int64_t fs, uint32_t samples_per_code, int32_t doppler_max, int32_t doppler_step)
+    : d_engine(fs, samples_per_code),
+      d_power(samples_per_code),
+      d_fs(static_cast<double>(fs)),
+      d_samples_per_code(samples_per_code),
+      d_doppler_max(doppler_max),
+      d_doppler_step(doppler_step)
+{
+    // not shared with the channels of the receiver, fed from another stream
+    d_engine.set_doppler_grid("snapshot_" + signal, doppler_max, doppler_step);
+}
+
+
+void Acq_Snapshot_Search::add_satellite(char system, uint32_t prn, const gr_complex* code)
+{
+    Satellite sat{};
+    sat.fft_code.resize(d_samples_per_code);
+    d_engine.code_spectrum(code, sat.fft_code.data());
+    sat.row.resize(d_samples_per_code);
+    sat.prev_row.resize(d_samples_per_code);
+    sat.prn = prn;
+    sat.system = system;
+    d_satellites.push_back(std::move(sat));
+}
+
+
+std::vector<Acq_Snapshot_Result> Acq_Snapshot_Search::search(const gr_complex* samples, size_t nsamples, float threshold)
+{
+    const uint32_t n = d_samples_per_code;
+    const uint32_t num_bins = d_engine.num_doppler_bins();
+    const size_t num_blocks = nsamples / n;
+    for (auto& sat : d_satellites)
+        {
+            sat.grid_sum = 0.0;
+            sat.peak = -1.0F;
+        }
+    for (uint32_t doppler_index = 0; doppler_index < num_bins; doppler_index++)
+        {
+            for (auto& sat : d_satellites)
+                {
+                    sat.row.swap(sat.prev_row);
+                    std::fill(sat.row.begin(), sat.row.end(), 0.0F);
+                }
+            for (size_t block = 0; block < num_blocks; block++)
+                {
+                    d_engine.input_spectrum(samples + block * n, (block + 1) * n, doppler_index);
+                    for (auto& sat : d_satellites)
+                        {
+                            volk_32fc_magnitude_squared_32f(d_power.data(), d_engine.correlate(sat.fft_code.data()), n);
+                            volk_32f_x2_add_32f(sat.row.data(), sat.row.data(), d_power.data(), n);
+                        }
+                }
+            for (auto& sat : d_satellites)
+                {
+                    if (doppler_index > 0 and sat.peak_doppler_index == doppler_index - 1)
+                        {
+                            sat.peak_next_bin = sat.row[sat.peak_code_index];
+                        }
+                    uint32_t code_index = 0;
+                    volk_gnsssdr_32f_index_max_32u(&code_index, sat.row.data(), n);
+                    sat.grid_sum += std::accumulate(sat.row.cbegin(), sat.row.cend(), 0.0);
+                    if (sat.row[code_index] > sat.peak)
+                        {
+                            // the correlation is circular in the code phase
+                            sat.peak = sat.row[code_index];
+                            sat.peak_prev_code = sat.row[(code_index + n - 1) % n];
+                            sat.peak_next_code = sat.row[(code_index + 1) % n];
+                            sat.peak_prev_bin = (doppler_index > 0 ? sat.prev_row[code_index] : 0.0F);
+                            sat.peak_next_bin = 0.0F;
+                            sat.peak_code_index = code_index;
+                            sat.peak_doppler_index = doppler_index;
+                        }
+                }
+        }
+
+    std::vector<Acq_Snapshot_Result> results;
+    results.reserve(d_satellites.size());
+    for (const auto& sat : d_satellites)
+        {
+            Acq_Snapshot_Result result{};
+            result.system = sat.system;
+            result.prn = sat.prn;
+            if (num_blocks == 0 or num_bins == 0)
+                {
+                    results.push_back(result);
+                    continue;
+                }
+            const double peak = std::sqrt(sat.peak);
+            const double code_offset = parabolic_offset(std::sqrt(sat.peak_prev_code), peak, std::sqrt(sat.peak_next_code));
+            result.code_phase_s = std::fmod(static_cast<double>(sat.peak_code_index) + code_offset + n, n) / d_fs;
+
+            double doppler_offset = 0.0;
+            if (sat.peak_doppler_index > 0 and sat.peak_doppler_index + 1 < num_bins)
+                {
+                    doppler_offset = parabolic_offset(std::sqrt(sat.peak_prev_bin), peak, std::sqrt(sat.peak_next_bin));
+                }
+            result.doppler_hz = -d_doppler_max + (static_cast<double>(sat.peak_doppler_index) + doppler_offset) * d_doppler_step;
+
+            const double mean = sat.grid_sum / (static_cast<double>(num_bins) * n);
+            result.test_statistic = (mean > 0.0 ? static_cast<float>(sat.peak / mean) : 0.0F);
+            result.detected = result.test_statistic > threshold;
+            results.push_back(result);
+        }
+    return results;
+}
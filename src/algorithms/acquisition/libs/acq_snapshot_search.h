@@ -0,0 +1,108 @@
+/*!
+ * \file acq_snapshot_search.h
+ * \brief Batched acquisition of all the satellites in a short burst of
+ * samples, with interpolated code phases for snapshot positioning.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ACQ_SNAPSHOT_SEARCH_H
+#define GNSS_SDR_ACQ_SNAPSHOT_SEARCH_H
+
+#include "acq_pcps_engine.h"
+#include <gnuradio/gr_complex.h>
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/** \addtogroup Acquisition
+ * \{ */
+/** \addtogroup acquisition_libs
+ * \{ */
+
+
+/*!
+ * \brief Result of the search of a satellite
+ */
+struct Acq_Snapshot_Result
+{
+    char system{'G'};          //!< System of the satellite, as given to add_satellite
+    uint32_t prn{0};           //!< PRN of the satellite
+    double code_phase_s{0.0};  //!< Time from the first sample to the next code epoch, interpolated [s]
+    double doppler_hz{0.0};    //!< Doppler, interpolated between the bins [Hz]
+    float test_statistic{0.0};  //!< Peak power over the mean power of the grid
+    bool detected{false};       //!< Whether the test statistic exceeds the threshold
+};
+
+
+/*!
+ * \brief Searches all the satellites of a signal in a burst of samples.
+ *
+ * The burst is split in blocks of one code period, correlated coherently
+ * and accumulated non-coherently. Each block is Doppler-wiped and
+ * transformed once per Doppler bin, and correlated with the spectra of all
+ * the satellites (see Acq_Pcps_Engine), so adding satellites only costs the
+ * code multiplications and the inverse FFTs. The grid is searched one
+ * Doppler bin at a time, so each satellite only holds two rows of it. The
+ * code phase and the Doppler of the peak are refined by parabolic
+ * interpolation of the correlation amplitude. The code period must be a
+ * whole number of samples, so that the blocks are aligned with the code.
+ */
+class Acq_Snapshot_Search
+{
+public:
+    Acq_Snapshot_Search(const std::string& signal, int64_t fs, uint32_t samples_per_code, int32_t doppler_max, int32_t doppler_step);
+
+    /*!
+     * \brief Adds a satellite to the search. code is one period of its
+     * local replica, sampled at fs.
+     */
+    void add_satellite(char system, uint32_t prn, const gr_complex* code);
+
+    /*!
+     * \brief Searches the satellites in the first nsamples samples of the
+     * burst, all the whole code periods of them.
+     */
+    std::vector<Acq_Snapshot_Result> search(const gr_complex* samples, size_t nsamples, float threshold);
+
+private:
+    struct Satellite
+    {
+        volk_gnsssdr::vector<gr_complex> fft_code;
+        volk_gnsssdr::vector<float> row;       // power of the Doppler bin being searched, accumulated over the blocks
+        volk_gnsssdr::vector<float> prev_row;  // power of the previous Doppler bin
+        double grid_sum;                       // sum of the power of the grid
+        float peak;                            // highest power found
+        float peak_prev_code;                  // power at the neighbours of the peak, in code phase
+        float peak_next_code;
+        float peak_prev_bin;  // and in Doppler
+        float peak_next_bin;
+        uint32_t peak_code_index;
+        uint32_t peak_doppler_index;
+        uint32_t prn;
+        char system;
+    };
+
+    Acq_Pcps_Engine d_engine;
+    std::vector<Satellite> d_satellites;
+    volk_gnsssdr::vector<float> d_power;
+    double d_fs;
+    uint32_t d_samples_per_code;
+    int32_t d_doppler_max;
+    int32_t d_doppler_step;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_ACQ_SNAPSHOT_SEARCH_H
@@ -0,0 +1,65 @@
+/*!
+ * \file acq_workspace_pool.cc
+ * \brief Process-wide pool of the scratch buffers and FFT plans of the PCPS
+ * acquisition blocks.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_workspace_pool.h"
+#include <utility>  // for move
+
+
+Acq_Workspace_Pool& Acq_Workspace_Pool::get()
+{
+    static Acq_Workspace_Pool pool;
+    return pool;
+}
+
+
+Acq_Workspace Acq_Workspace_Pool::borrow(uint32_t fft_size)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    const auto it = d_idle.find(fft_size);
+    if (it != d_idle.end())
+        {
+            Acq_Workspace workspace = std::move(it->second);
+            d_idle.erase(it);
+            return workspace;
+        }
+    // the FFT plans are created with the pool locked, one at a time
+    Acq_Workspace workspace;
+    workspace.fft_if = gnss_fft_fwd_make_unique(fft_size);
+    workspace.ifft = gnss_fft_rev_make_unique(fft_size);
+    workspace.tmp_buffer = volk_gnsssdr::vector<float>(fft_size);
+    return workspace;
+}
+
+
+void Acq_Workspace_Pool::give_back(uint32_t fft_size, Acq_Workspace workspace)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_idle.emplace(fft_size, std::move(workspace));
+}
+
+
+size_t Acq_Workspace_Pool::idle()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_idle.size();
+}
+
+
+void Acq_Workspace_Pool::clear()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_idle.clear();
+}
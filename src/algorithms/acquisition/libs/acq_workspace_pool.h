@@ -0,0 +1,96 @@
+/*!
+ * \file acq_workspace_pool.h
+ * \brief Process-wide pool of the scratch buffers and FFT plans of the PCPS
+ * acquisition blocks.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ACQ_WORKSPACE_POOL_H
+#define GNSS_SDR_ACQ_WORKSPACE_POOL_H
+
+#include "gnss_sdr_fft.h"
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+
+/** \addtogroup Acquisition
+ * \{ */
+/** \addtogroup acquisition_libs
+ * \{ */
+
+
+/*!
+ * \brief Scratch memory of a search: the FFT plans, the magnitude grid
+ * (one row of fft_size samples per Doppler bin) and a temporary buffer.
+ */
+struct Acq_Workspace
+{
+    std::unique_ptr<gnss_fft_complex_fwd> fft_if;
+    std::unique_ptr<gnss_fft_complex_rev> ifft;
+    volk_gnsssdr::vector<volk_gnsssdr::vector<float>> magnitude_grid;
+    volk_gnsssdr::vector<float> tmp_buffer;
+};
+
+
+/*!
+ * \brief Pool of acquisition workspaces, shared by all the acquisition
+ * channels.
+ *
+ * A channel borrows a workspace only while it searches, and gives it back
+ * when the acquisition ends, so the number of workspaces is the largest
+ * number of simultaneous acquisitions (Channels.in_acquisition), not the
+ * number of channels. Workspaces are reused by FFT size, the magnitude grid
+ * of a reused workspace keeps the number of rows and the contents of its
+ * last search.
+ */
+class Acq_Workspace_Pool
+{
+public:
+    /*!
+     * \brief Returns the process-wide instance
+     */
+    static Acq_Workspace_Pool& get();
+
+    /*!
+     * \brief Takes an idle workspace for fft_size samples, or creates one
+     */
+    Acq_Workspace borrow(uint32_t fft_size);
+
+    /*!
+     * \brief Returns a workspace for fft_size samples to the pool
+     */
+    void give_back(uint32_t fft_size, Acq_Workspace workspace);
+
+    /*!
+     * \brief Number of idle workspaces
+     */
+    size_t idle();
+
+    /*!
+     * \brief Drops the idle workspaces
+     */
+    void clear();
+
+private:
+    Acq_Workspace_Pool() = default;
+
+    std::multimap<uint32_t, Acq_Workspace> d_idle;  // by FFT size
+    std::mutex d_mutex;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_ACQ_WORKSPACE_POOL_H
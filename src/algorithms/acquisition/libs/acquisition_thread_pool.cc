@@ -0,0 +1,166 @@
+/*!
+ * \file acquisition_thread_pool.cc
+ * \brief Bounded, receiver-wide pool of worker threads running the
+ * acquisition searches submitted by the channels.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acquisition_thread_pool.h"
+#include <glog/logging.h>
+#include <algorithm>  // for max
+#include <exception>
+
+
+namespace
+{
+std::mutex global_pool_mutex;
+std::shared_ptr<Acquisition_Thread_Pool> global_pool;
+}  // namespace
+
+
+Acquisition_Thread_Pool::Acquisition_Thread_Pool(uint32_t num_threads) : d_sequence(0ULL),
+                                                                         d_stop(false)
+{
+    if (num_threads == 0)
+        {
+            num_threads = std::max(std::thread::hardware_concurrency(), 1U);
+        }
+    d_workers.reserve(num_threads);
+    for (uint32_t i = 0; i < num_threads; i++)
+        {
+            d_workers.emplace_back(&Acquisition_Thread_Pool::run, this);
+        }
+    DLOG(INFO) << "Acquisition thread pool started with " << num_threads << " worker threads";
+}
+
+
+Acquisition_Thread_Pool::~Acquisition_Thread_Pool()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_stop = true;
+        d_jobs.clear();
+    }
+    d_job_available.notify_all();
+    for (auto& worker : d_workers)
+        {
+            if (worker.joinable())
+                {
+                    worker.join();
+                }
+        }
+}
+
+
+void Acquisition_Thread_Pool::submit(const void* owner, char system, uint32_t prn, std::function<void()> job)
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        int32_t priority = 0;
+        const auto it = d_priorities.find({system, prn});
+        if (it != d_priorities.end())
+            {
+                priority = it->second;
+            }
+        d_jobs[{-static_cast<int64_t>(priority), d_sequence++}] = Job{std::move(job), owner};
+    }
+    d_job_available.notify_one();
+}
+
+
+void Acquisition_Thread_Pool::cancel(const void* owner)
+{
+    std::unique_lock<std::mutex> lock(d_mutex);
+    for (auto it = d_jobs.begin(); it != d_jobs.end();)
+        {
+            if (it->second.owner == owner)
+                {
+                    it = d_jobs.erase(it);
+                }
+            else
+                {
+                    ++it;
+                }
+        }
+    d_job_done.wait(lock, [&] { return d_running.count(owner) == 0; });
+}
+
+
+void Acquisition_Thread_Pool::set_priority(char system, uint32_t prn, int32_t priority)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_priorities[{system, prn}] = priority;
+}
+
+
+void Acquisition_Thread_Pool::clear_priorities()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_priorities.clear();
+}
+
+
+size_t Acquisition_Thread_Pool::pending() const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_jobs.size();
+}
+
+
+void Acquisition_Thread_Pool::run()
+{
+    while (true)
+        {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(d_mutex);
+                d_job_available.wait(lock, [this] { return d_stop or !d_jobs.empty(); });
+                if (d_stop)
+                    {
+                        return;
+                    }
+                job = std::move(d_jobs.begin()->second);
+                d_jobs.erase(d_jobs.begin());
+                d_running[job.owner]++;
+            }
+            try
+                {
+                    job.task();
+                }
+            catch (const std::exception& e)
+                {
+                    LOG(ERROR) << "Exception in acquisition job: " << e.what();
+                }
+            {
+                std::lock_guard<std::mutex> lock(d_mutex);
+                if (--d_running[job.owner] == 0)
+                    {
+                        d_running.erase(job.owner);
+                    }
+            }
+            d_job_done.notify_all();
+        }
+}
+
+
+void Acquisition_Thread_Pool::set_global_instance(std::shared_ptr<Acquisition_Thread_Pool> pool)
+{
+    std::lock_guard<std::mutex> lock(global_pool_mutex);
+    global_pool = std::move(pool);
+}
+
+
+std::shared_ptr<Acquisition_Thread_Pool> Acquisition_Thread_Pool::global_instance()
+{
+    std::lock_guard<std::mutex> lock(global_pool_mutex);
+    return global_pool;
+}
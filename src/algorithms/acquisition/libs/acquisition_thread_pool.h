@@ -0,0 +1,126 @@
+/*!
+ * \file acquisition_thread_pool.h
+ * \brief Bounded, receiver-wide pool of worker threads running the
+ * acquisition searches submitted by the channels.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ACQUISITION_THREAD_POOL_H
+#define GNSS_SDR_ACQUISITION_THREAD_POOL_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/** \addtogroup Acquisition
+ * \{ */
+/** \addtogroup acquisition_libs
+ * \{ */
+
+
+/*!
+ * \brief Fixed-size pool of threads executing acquisition jobs.
+ *
+ * Jobs are served by priority (higher first) and, for equal priority, in
+ * submission order. The priority of a job is taken from the priority of its
+ * satellite at submission time (see set_priority()), so the satellites
+ * flagged as visible by the receiver are searched first.
+ *
+ * The pool is owned by the flow graph, which publishes it through
+ * set_global_instance() so that the acquisition blocks can find it.
+ */
+class Acquisition_Thread_Pool
+{
+public:
+    /*!
+     * \brief Creates the pool. If num_threads is 0, the number of
+     * hardware threads is used.
+     */
+    explicit Acquisition_Thread_Pool(uint32_t num_threads = 0);
+
+    /*!
+     * \brief Discards pending jobs and joins the worker threads.
+     */
+    ~Acquisition_Thread_Pool();
+
+    Acquisition_Thread_Pool(const Acquisition_Thread_Pool&) = delete;
+    Acquisition_Thread_Pool& operator=(const Acquisition_Thread_Pool&) = delete;
+
+    /*!
+     * \brief Queues a job. The owner pointer identifies who submitted it,
+     * which is used by cancel().
+     */
+    void submit(const void* owner, char system, uint32_t prn, std::function<void()> job);
+
+    /*!
+     * \brief Removes the pending jobs of owner and waits for its running
+     * jobs to finish. Must be called by the owner before being destroyed.
+     */
+    void cancel(const void* owner);
+
+    /*!
+     * \brief Sets the priority of the jobs of satellite (system, prn).
+     * Satellites without an explicit priority have priority 0.
+     */
+    void set_priority(char system, uint32_t prn, int32_t priority);
+
+    /*!
+     * \brief Resets the priority of all satellites to 0.
+     */
+    void clear_priorities();
+
+    inline uint32_t size() const
+    {
+        return static_cast<uint32_t>(d_workers.size());
+    }
+
+    /*!
+     * \brief Number of jobs waiting for a free worker
+     */
+    size_t pending() const;
+
+    static void set_global_instance(std::shared_ptr<Acquisition_Thread_Pool> pool);
+    static std::shared_ptr<Acquisition_Thread_Pool> global_instance();
+
+private:
+    struct Job
+    {
+        std::function<void()> task;
+        const void* owner;
+    };
+
+    // Key (-priority, sequence number): std::map keeps the next job first
+    using Job_Key = std::pair<int64_t, uint64_t>;
+
+    void run();
+
+    std::map<Job_Key, Job> d_jobs;
+    std::map<std::pair<char, uint32_t>, int32_t> d_priorities;
+    std::map<const void*, uint32_t> d_running;
+    std::vector<std::thread> d_workers;
+    mutable std::mutex d_mutex;
+    std::condition_variable d_job_available;
+    std::condition_variable d_job_done;
+    uint64_t d_sequence;
+    bool d_stop;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_ACQUISITION_THREAD_POOL_H
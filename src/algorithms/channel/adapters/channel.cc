@@ -242,6 +242,36 @@ void Channel::assist_acquisition_doppler(double Carrier_Doppler_hz)
 }
 
 
+void Channel::assist_acquisition_code_phase(double code_epoch_s, double code_period_s)
+{
+    acq_->set_code_phase_assistance(code_epoch_s, code_period_s);
+}
+
+
+bool Channel::start_tracking_handover(uint64_t sample_stamp, double Carrier_Doppler_hz)
+{
+    std::lock_guard<std::mutex> lk(mx_);
+    if (flag_enable_fpga_)
+        {
+            return false;
+        }
+    // the tracking block reads the initial code phase and Doppler as if they
+    // were the result of an acquisition
+    gnss_synchro_.Acq_delay_samples = 0.0;
+    gnss_synchro_.Acq_doppler_hz = Carrier_Doppler_hz;
+    gnss_synchro_.Acq_samplestamp_samples = sample_stamp;
+    gnss_synchro_.Acq_doppler_step = 0U;
+    gnss_synchro_.Flag_valid_acquisition = true;
+    if (!channel_fsm_->Event_start_tracking())
+        {
+            LOG(WARNING) << "Invalid channel event";
+            return false;
+        }
+    DLOG(INFO) << "Channel start_tracking_handover()";
+    return true;
+}
+
+
 void Channel::start_acquisition()
 {
     std::lock_guard<std::mutex> lk(mx_);
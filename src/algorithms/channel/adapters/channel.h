@@ -90,6 +90,8 @@ public:
     void set_signal(const Gnss_Signal& gnss_signal_) override;  //!< Sets the channel GNSS signal
 
     void assist_acquisition_doppler(double Carrier_Doppler_hz) override;
+    void assist_acquisition_code_phase(double code_epoch_s, double code_period_s) override;
+    bool start_tracking_handover(uint64_t sample_stamp, double Carrier_Doppler_hz) override;
 
     inline std::shared_ptr<AcquisitionInterface> acquisition() const { return acq_; }
     inline std::shared_ptr<TrackingInterface> tracking() const { return trk_; }
@@ -17,14 +17,30 @@
  */
 
 #include "channel_fsm.h"
-#include "channel_event.h"
+#include "control_event.h"
 #include <glog/logging.h>
+#include <thread>
 #include <utility>
 
+
+namespace
+{
+constexpr uint64_t CHANNEL_FSM_STATE_MASK = 0xFFU;
+constexpr uint64_t CHANNEL_FSM_EFFECT_MASK = 0xFFU;
+constexpr int CHANNEL_FSM_EFFECT_SHIFT = 8;
+constexpr uint32_t CHANNEL_FSM_STANDBY = 1U << 0U;
+constexpr uint32_t CHANNEL_FSM_ACQUISITION = 1U << 1U;
+constexpr uint32_t CHANNEL_FSM_TRACKING = 1U << 2U;
+constexpr uint32_t CHANNEL_FSM_WAITING = 1U << 3U;  // waiting for a new satellite
+}  // namespace
+
+
+constexpr uint32_t ChannelFsm::EFFECTS_RING;
+
+
 ChannelFsm::ChannelFsm()
     : queue_(nullptr),
-      channel_(0U),
-      state_(0U)
+      channel_(0U)
 {
     acq_ = nullptr;
     trk_ = nullptr;
@@ -34,44 +50,131 @@ ChannelFsm::ChannelFsm()
 ChannelFsm::ChannelFsm(std::shared_ptr<AcquisitionInterface> acquisition)
     : acq_(std::move(acquisition)),
       queue_(nullptr),
-      channel_(0U),
-      state_(0U)
+      channel_(0U)
 {
     trk_ = nullptr;
 }
 
 
-bool ChannelFsm::Event_stop_channel()
+bool ChannelFsm::transition(uint32_t from_states, uint32_t to_state)
 {
-    std::lock_guard<std::mutex> lk(mx_);
-    DLOG(INFO) << "CH = " << channel_ << ". Ev stop channel";
-    switch (state_)
+    uint64_t word = state_word_.load();
+    do
+        {
+            if ((from_states & (1U << static_cast<uint32_t>(word & CHANNEL_FSM_STATE_MASK))) == 0)
+                {
+                    return false;
+                }
+        }
+    while (!state_word_.compare_exchange_weak(word, (word & ~CHANNEL_FSM_STATE_MASK) | to_state));
+    return true;
+}
+
+
+bool ChannelFsm::transition(uint32_t from_states, uint32_t to_state, Effect effect)
+{
+    uint64_t word = state_word_.load();
+    uint64_t number;
+    do
+        {
+            if ((from_states & (1U << static_cast<uint32_t>(word & CHANNEL_FSM_STATE_MASK))) == 0)
+                {
+                    return false;
+                }
+            number = (word >> CHANNEL_FSM_EFFECT_SHIFT) + 1;
+        }
+    while (!state_word_.compare_exchange_weak(word, (number << CHANNEL_FSM_EFFECT_SHIFT) | to_state));
+
+    // the slot is free once the effect that used it before has been executed
+    while (number - executed_effects_.load() > EFFECTS_RING)
+        {
+            std::this_thread::yield();
+        }
+    effects_[number % EFFECTS_RING].store((number << CHANNEL_FSM_EFFECT_SHIFT) | static_cast<uint64_t>(effect));
+    run_effects();
+    return true;
+}
+
+
+void ChannelFsm::run_effects()
+{
+    while (!running_effects_.exchange(true))
+        {
+            {
+                std::lock_guard<std::mutex> lk(mx_);
+                while (executed_effects_.load() < (state_word_.load() >> CHANNEL_FSM_EFFECT_SHIFT))
+                    {
+                        const uint64_t number = executed_effects_.load() + 1;
+                        uint64_t slot = effects_[number % EFFECTS_RING].load();
+                        while ((slot >> CHANNEL_FSM_EFFECT_SHIFT) != number)
+                            {
+                                // the thread that made the transition is storing it
+                                std::this_thread::yield();
+                                slot = effects_[number % EFFECTS_RING].load();
+                            }
+                        apply(static_cast<Effect>(slot & CHANNEL_FSM_EFFECT_MASK));
+                        executed_effects_.store(number);
+                    }
+            }
+            running_effects_.store(false);
+            // a transition made before the flag was cleared is executed here
+            if (executed_effects_.load() == (state_word_.load() >> CHANNEL_FSM_EFFECT_SHIFT))
+                {
+                    return;
+                }
+        }
+}
+
+
+void ChannelFsm::apply(Effect effect)
+{
+    switch (effect)
         {
-        case 0:  // already in stanby
+        case Effect::start_acquisition:
+            start_acquisition();
             break;
-        case 1:  // acquisition
-            state_ = 0;
+        case Effect::stop_acquisition:
             stop_acquisition();
             break;
-        case 2:  // tracking
-            state_ = 0;
+        case Effect::reset_nav_and_start_tracking:
+            nav_->reset();
+            start_tracking();
+            break;
+        case Effect::start_tracking:
+            start_tracking();
+            break;
+        case Effect::stop_tracking:
             stop_tracking();
             break;
+        case Effect::request_satellite:
+            request_satellite();
+            break;
+        case Effect::notify_stop_tracking:
+            notify_stop_tracking();
+            break;
         default:
             break;
         }
+}
+
+
+bool ChannelFsm::Event_stop_channel()
+{
+    DLOG(INFO) << "CH = " << channel_ << ". Ev stop channel";
+    if (!transition(CHANNEL_FSM_ACQUISITION, 0, Effect::stop_acquisition))
+        {
+            transition(CHANNEL_FSM_TRACKING, 0, Effect::stop_tracking);
+        }
     return true;
 }
 
 
 bool ChannelFsm::Event_start_acquisition_fpga()
 {
-    std::lock_guard<std::mutex> lk(mx_);
-    if ((state_ == 1) || (state_ == 2))
+    if (!transition(CHANNEL_FSM_STANDBY | CHANNEL_FSM_WAITING, 1))
         {
             return false;
         }
-    state_ = 1;
     DLOG(INFO) << "CH = " << channel_ << ". Ev start acquisition FPGA";
     return true;
 }
@@ -79,27 +182,32 @@ bool ChannelFsm::Event_start_acquisition_fpga()
 
 bool ChannelFsm::Event_start_acquisition()
 {
-    std::lock_guard<std::mutex> lk(mx_);
-    if ((state_ == 1) || (state_ == 2))
+    if (!transition(CHANNEL_FSM_STANDBY | CHANNEL_FSM_WAITING, 1, Effect::start_acquisition))
         {
             return false;
         }
-    state_ = 1;
-    start_acquisition();
     DLOG(INFO) << "CH = " << channel_ << ". Ev start acquisition";
     return true;
 }
 
 
+bool ChannelFsm::Event_start_tracking()
+{
+    if (!transition(CHANNEL_FSM_STANDBY | CHANNEL_FSM_WAITING, 2, Effect::reset_nav_and_start_tracking))
+        {
+            return false;
+        }
+    DLOG(INFO) << "CH = " << channel_ << ". Ev start tracking";
+    return true;
+}
+
+
 bool ChannelFsm::Event_valid_acquisition()
 {
-    std::lock_guard<std::mutex> lk(mx_);
-    if (state_ != 1)
+    if (!transition(CHANNEL_FSM_ACQUISITION, 2, Effect::start_tracking))
         {
             return false;
         }
-    state_ = 2;
-    start_tracking();
     DLOG(INFO) << "CH = " << channel_ << ". Ev valid acquisition";
     return true;
 }
@@ -107,13 +215,10 @@ bool ChannelFsm::Event_valid_acquisition()
 
 bool ChannelFsm::Event_failed_acquisition_repeat()
 {
-    std::lock_guard<std::mutex> lk(mx_);
-    if (state_ != 1)
+    if (!transition(CHANNEL_FSM_ACQUISITION, 1, Effect::start_acquisition))
         {
             return false;
         }
-    state_ = 1;
-    start_acquisition();
     DLOG(INFO) << "CH = " << channel_ << ". Ev failed acquisition repeat";
     return true;
 }
@@ -121,13 +226,10 @@ bool ChannelFsm::Event_failed_acquisition_repeat()
 
 bool ChannelFsm::Event_failed_acquisition_no_repeat()
 {
-    std::lock_guard<std::mutex> lk(mx_);
-    if (state_ != 1)
+    if (!transition(CHANNEL_FSM_ACQUISITION, 3, Effect::request_satellite))
         {
             return false;
         }
-    state_ = 3;
-    request_satellite();
     DLOG(INFO) << "CH = " << channel_ << ". Ev failed acquisition no repeat";
     return true;
 }
@@ -135,13 +237,10 @@ bool ChannelFsm::Event_failed_acquisition_no_repeat()
 
 bool ChannelFsm::Event_failed_tracking_standby()
 {
-    std::lock_guard<std::mutex> lk(mx_);
-    if (state_ != 2)
+    if (!transition(CHANNEL_FSM_TRACKING, 0, Effect::notify_stop_tracking))
         {
             return false;
         }
-    state_ = 0U;
-    notify_stop_tracking();
     DLOG(INFO) << "CH = " << channel_ << ". Ev failed tracking standby";
     return true;
 }
@@ -204,17 +303,17 @@ void ChannelFsm::start_acquisition()
 void ChannelFsm::start_tracking()
 {
     trk_->start_tracking();
-    queue_->push(pmt::make_any(channel_event_make(channel_, 1)));
+    queue_->push(control_event_pmt(Control_Event::channel, channel_, 1));
 }
 
 
 void ChannelFsm::request_satellite()
 {
-    queue_->push(pmt::make_any(channel_event_make(channel_, 0)));
+    queue_->push(control_event_pmt(Control_Event::channel, channel_, 0));
 }
 
 
 void ChannelFsm::notify_stop_tracking()
 {
-    queue_->push(pmt::make_any(channel_event_make(channel_, 2)));
+    queue_->push(control_event_pmt(Control_Event::channel, channel_, 2));
 }
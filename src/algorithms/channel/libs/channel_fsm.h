@@ -24,6 +24,8 @@
 #include "telemetry_decoder_interface.h"
 #include "tracking_interface.h"
 #include <pmt/pmt.h>
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <mutex>
@@ -37,6 +39,14 @@
 
 /*!
  * \brief This class implements a State Machine for channel
+ *
+ * The events come from the acquisition threads, the tracking blocks and the
+ * control thread. The state changes with a compare-and-swap of an atomic
+ * word, so an event never waits for another one. The side effects of the
+ * transitions (starting the tracking, notifying the control thread...) are
+ * numbered in the same word and executed in that order by one of the
+ * threads at a time: if another thread is already executing them, the
+ * event returns at once and that thread executes its side effects too.
  */
 class ChannelFsm
 {
@@ -55,6 +65,7 @@ public:
     // FSM EVENTS
     bool Event_start_acquisition();
     bool Event_start_acquisition_fpga();
+    bool Event_start_tracking();
     bool Event_stop_channel();
     bool Event_failed_tracking_standby();
     virtual bool Event_valid_acquisition();
@@ -62,6 +73,23 @@ public:
     virtual bool Event_failed_acquisition_no_repeat();
 
 private:
+    enum class Effect : uint8_t
+    {
+        start_acquisition = 1,
+        stop_acquisition,
+        start_tracking,
+        reset_nav_and_start_tracking,
+        stop_tracking,
+        request_satellite,
+        notify_stop_tracking
+    };
+
+    // Changes the state if it is one of from_states (a bit per state)
+    bool transition(uint32_t from_states, uint32_t to_state, Effect effect);
+    bool transition(uint32_t from_states, uint32_t to_state);
+    void run_effects();
+    void apply(Effect effect);
+
     void start_tracking();
     void stop_acquisition();
     void stop_tracking();
@@ -72,12 +100,17 @@ private:
     std::shared_ptr<TrackingInterface> trk_;
     std::shared_ptr<TelemetryDecoderInterface> nav_;
 
-    std::mutex mx_;
+    std::mutex mx_;  // the blocks, held by the setters and while the side effects are executed
 
     Concurrent_Queue<pmt::pmt_t>* queue_;
 
     uint32_t channel_;
-    uint32_t state_;
+
+    static constexpr uint32_t EFFECTS_RING = 16;
+    std::atomic<uint64_t> state_word_{0};  // state in the lowest 8 bits, side effects numbered above
+    std::array<std::atomic<uint64_t>, EFFECTS_RING> effects_{};  // side effect of each number, with the number above 8 bits
+    std::atomic<uint64_t> executed_effects_{0};
+    std::atomic<bool> running_effects_{false};
 };
 
 
@@ -0,0 +1,188 @@
+/*!
+ * \file fused_signal_conditioner.cc
+ * \brief Signal conditioner that runs the data type adapter, the input filter
+ * and the resampler as a single block, when their configuration allows it.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "fused_signal_conditioner.h"
+#include "direct_resampler_conditioner.h"
+#include "fir_filter.h"
+#include "freq_xlating_fir_filter.h"
+#include "ibyte_to_complex.h"
+#include "ishort_to_complex.h"
+#include "pass_through.h"
+#include <glog/logging.h>
+#include <utility>
+
+
+FusedSignalConditioner::FusedSignalConditioner(std::shared_ptr<GNSSBlockInterface> data_type_adapt,
+    std::shared_ptr<GNSSBlockInterface> in_filt,
+    std::shared_ptr<GNSSBlockInterface> res,
+    std::string role) : data_type_adapt_(std::move(data_type_adapt)),
+                        in_filt_(std::move(in_filt)),
+                        res_(std::move(res)),
+                        role_(std::move(role)),
+                        item_size_(0)
+{
+    Fused_Conditioner_Conf conf;
+    if (get_conf(conf))
+        {
+            fused_conditioner_ = make_fused_conditioner_cc(conf);
+            item_size_ = data_type_adapt_->item_size();
+            DLOG(INFO) << role_ << ": fused_conditioner(" << fused_conditioner_->unique_id() << ")";
+        }
+    else
+        {
+            LOG(WARNING) << role_ << ": the configuration of the DataTypeAdapter, InputFilter and Resampler "
+                         << "cannot be fused, running them as a Signal_Conditioner";
+            reference_conditioner_ = std::make_unique<SignalConditioner>(data_type_adapt_, in_filt_, res_, role_);
+            if (data_type_adapt_ != nullptr)
+                {
+                    item_size_ = data_type_adapt_->item_size();
+                }
+        }
+}
+
+
+bool FusedSignalConditioner::get_conf(Fused_Conditioner_Conf& conf) const
+{
+    if (data_type_adapt_ == nullptr or in_filt_ == nullptr or res_ == nullptr)
+        {
+            return false;
+        }
+
+    if (const auto* pass_through = dynamic_cast<const Pass_Through*>(data_type_adapt_.get()))
+        {
+            if (pass_through->item_type() != "gr_complex")
+                {
+                    return false;
+                }
+            conf.input_item_type = "gr_complex";
+        }
+    else if (const auto* ishort = dynamic_cast<const IshortToComplex*>(data_type_adapt_.get()))
+        {
+            if (ishort->dump())
+                {
+                    return false;
+                }
+            conf.input_item_type = "short";
+            conf.inverted_spectrum = ishort->inverted_spectrum();
+        }
+    else if (const auto* ibyte = dynamic_cast<const IbyteToComplex*>(data_type_adapt_.get()))
+        {
+            if (ibyte->dump())
+                {
+                    return false;
+                }
+            conf.input_item_type = "byte";
+            conf.inverted_spectrum = ibyte->inverted_spectrum();
+        }
+    else
+        {
+            return false;
+        }
+
+    if (const auto* pass_through = dynamic_cast<const Pass_Through*>(in_filt_.get()))
+        {
+            if (pass_through->item_type() != "gr_complex")
+                {
+                    return false;
+                }
+        }
+    else if (const auto* fir = dynamic_cast<const FirFilter*>(in_filt_.get()))
+        {
+            if (fir->dump() or fir->input_item_type() != "gr_complex" or fir->output_item_type() != "gr_complex" or fir->taps_item_type() != "float")
+                {
+                    return false;
+                }
+            conf.taps = fir->taps();
+        }
+    else if (const auto* xlating = dynamic_cast<const FreqXlatingFirFilter*>(in_filt_.get()))
+        {
+            if (xlating->dump() or xlating->input_item_type() != "gr_complex" or xlating->output_item_type() != "gr_complex" or xlating->taps_item_type() != "float")
+                {
+                    return false;
+                }
+            conf.taps = xlating->taps();
+            conf.intermediate_freq = xlating->intermediate_freq();
+            conf.sampling_freq = xlating->sampling_freq();
+            conf.decimation_factor = xlating->decimation_factor();
+        }
+    else
+        {
+            return false;
+        }
+
+    if (const auto* pass_through = dynamic_cast<const Pass_Through*>(res_.get()))
+        {
+            if (pass_through->item_type() != "gr_complex")
+                {
+                    return false;
+                }
+        }
+    else if (const auto* resampler = dynamic_cast<const DirectResamplerConditioner*>(res_.get()))
+        {
+            if (resampler->dump() or resampler->item_type() != "gr_complex")
+                {
+                    return false;
+                }
+            conf.resample = true;
+            conf.sample_freq_in = resampler->sample_freq_in();
+            conf.sample_freq_out = resampler->sample_freq_out();
+        }
+    else
+        {
+            return false;
+        }
+
+    return true;
+}
+
+
+void FusedSignalConditioner::connect(gr::top_block_sptr top_block)
+{
+    if (reference_conditioner_ != nullptr)
+        {
+            reference_conditioner_->connect(std::move(top_block));
+        }
+    // A single block, nothing to connect internally
+}
+
+
+void FusedSignalConditioner::disconnect(gr::top_block_sptr top_block)
+{
+    if (reference_conditioner_ != nullptr)
+        {
+            reference_conditioner_->disconnect(std::move(top_block));
+        }
+}
+
+
+gr::basic_block_sptr FusedSignalConditioner::get_left_block()
+{
+    if (reference_conditioner_ != nullptr)
+        {
+            return reference_conditioner_->get_left_block();
+        }
+    return fused_conditioner_;
+}
+
+
+gr::basic_block_sptr FusedSignalConditioner::get_right_block()
+{
+    if (reference_conditioner_ != nullptr)
+        {
+            return reference_conditioner_->get_right_block();
+        }
+    return fused_conditioner_;
+}
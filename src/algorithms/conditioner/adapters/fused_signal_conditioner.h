@@ -0,0 +1,88 @@
+/*!
+ * \file fused_signal_conditioner.h
+ * \brief Signal conditioner that runs the data type adapter, the input filter
+ * and the resampler as a single block, when their configuration allows it.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_FUSED_SIGNAL_CONDITIONER_H
+#define GNSS_SDR_FUSED_SIGNAL_CONDITIONER_H
+
+#include "fused_conditioner_cc.h"
+#include "gnss_block_interface.h"
+#include "signal_conditioner.h"
+#include <gnuradio/block.h>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+/** \addtogroup Signal_Conditioner
+ * \{ */
+/** \addtogroup Signal_Conditioner_adapters
+ * \{ */
+
+
+/*!
+ * \brief Replaces the chain of data_type_adapter, input_filter and resampler
+ * blocks by a single fused_conditioner_cc block, which processes each chunk
+ * of samples while it is in cache and, when downsampling, only filters the
+ * samples that the resampler keeps.
+ *
+ * Supported stages:
+ * - DataTypeAdapter: Pass_Through (gr_complex), Ishort_To_Complex or Ibyte_To_Complex
+ * - InputFilter: Pass_Through, Fir_Filter or Freq_Xlating_Fir_Filter, from gr_complex to gr_complex
+ * - Resampler: Pass_Through or Direct_Resampler, with gr_complex items
+ *
+ * with no dump. Any other configuration is run as a SignalConditioner.
+ */
+class FusedSignalConditioner : public GNSSBlockInterface
+{
+public:
+    //! Constructor
+    FusedSignalConditioner(std::shared_ptr<GNSSBlockInterface> data_type_adapt,
+        std::shared_ptr<GNSSBlockInterface> in_filt,
+        std::shared_ptr<GNSSBlockInterface> res,
+        std::string role);
+
+    //! Destructor
+    ~FusedSignalConditioner() = default;
+
+    void connect(gr::top_block_sptr top_block) override;
+    void disconnect(gr::top_block_sptr top_block) override;
+    gr::basic_block_sptr get_left_block() override;
+    gr::basic_block_sptr get_right_block() override;
+
+    inline std::string role() override { return role_; }
+
+    inline std::string implementation() override { return "Fused_Signal_Conditioner"; }  //!< Returns "Fused_Signal_Conditioner"
+
+    inline size_t item_size() override { return item_size_; }
+
+    //! True if the stages run as a single fused block
+    inline bool fused() const { return fused_conditioner_ != nullptr; }
+
+private:
+    bool get_conf(Fused_Conditioner_Conf& conf) const;
+
+    std::shared_ptr<GNSSBlockInterface> data_type_adapt_;
+    std::shared_ptr<GNSSBlockInterface> in_filt_;
+    std::shared_ptr<GNSSBlockInterface> res_;
+    std::unique_ptr<SignalConditioner> reference_conditioner_;
+    fused_conditioner_cc_sptr fused_conditioner_;
+    std::string role_;
+    size_t item_size_;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_FUSED_SIGNAL_CONDITIONER_H
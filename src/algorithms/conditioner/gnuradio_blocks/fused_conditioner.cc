@@ -0,0 +1,241 @@
+/*!
+ * \file fused_conditioner.cc
+ * \brief Data type conversion, FIR filtering and direct resampling of a
+ * sample stream in a single pass.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "fused_conditioner.h"
+#include "MATH_CONSTANTS.h"
+#include <volk/volk.h>
+#include <algorithm>  // for copy_n, max, min, reverse_copy, transform
+#include <cmath>      // for floor
+#include <complex>    // for exp, conj, abs
+#include <stdexcept>  // for invalid_argument
+
+
+Fused_Conditioner::Fused_Conditioner(const Fused_Conditioner_Conf& conf)
+    : d_ntaps(conf.taps.empty() ? 1 : conf.taps.size()),
+      d_decimation(static_cast<std::size_t>(std::max(conf.decimation_factor, 1))),
+      d_inverted_spectrum(conf.inverted_spectrum),
+      d_xlating(!conf.taps.empty() and conf.intermediate_freq != 0.0),
+      d_resample(conf.resample)
+{
+    if (conf.input_item_type == "gr_complex")
+        {
+            d_input_type = Input_Type::COMPLEX;
+        }
+    else if (conf.input_item_type == "short")
+        {
+            d_input_type = Input_Type::SHORT;
+        }
+    else if (conf.input_item_type == "byte")
+        {
+            d_input_type = Input_Type::BYTE;
+        }
+    else
+        {
+            throw std::invalid_argument("Fused_Conditioner: unsupported input item type " + conf.input_item_type);
+        }
+    if (d_resample and (conf.sample_freq_in <= 0.0 or conf.sample_freq_out <= 0.0))
+        {
+            throw std::invalid_argument("Fused_Conditioner: invalid resampler frequencies");
+        }
+
+    if (!conf.taps.empty())
+        {
+            d_taps_reversed.resize(d_ntaps);
+            std::reverse_copy(conf.taps.cbegin(), conf.taps.cend(), d_taps_reversed.begin());
+        }
+    if (d_xlating)
+        {
+            // Same as gr::filter::freq_xlating_fir_filter: shift the taps to the
+            // intermediate frequency, and rotate the decimated output back
+            const double fwT0 = 2.0 * GNSS_PI * conf.intermediate_freq / conf.sampling_freq;
+            d_ctaps_reversed.resize(d_ntaps);
+            for (std::size_t i = 0; i < d_ntaps; i++)
+                {
+                    d_ctaps_reversed[d_ntaps - 1 - i] = conf.taps[i] * std::exp(gr_complex(0.0F, static_cast<float>(static_cast<double>(i) * fwT0)));
+                }
+            d_rotator_step = std::exp(gr_complex(0.0F, static_cast<float>(-fwT0 * static_cast<double>(d_decimation))));
+        }
+
+    d_rate = 1.0 / static_cast<double>(d_decimation);
+    if (d_resample)
+        {
+            // Same phase accumulator as direct_resampler_conditioner_cc
+            const double two_32 = 4294967296.0;
+            d_downsample = conf.sample_freq_in >= conf.sample_freq_out;
+            if (d_downsample)
+                {
+                    d_phase_step = static_cast<uint32_t>(std::floor(two_32 * conf.sample_freq_out / conf.sample_freq_in));
+                }
+            else
+                {
+                    d_phase_step = static_cast<uint32_t>(std::floor(two_32 * conf.sample_freq_in / conf.sample_freq_out));
+                }
+            d_rate *= conf.sample_freq_out / conf.sample_freq_in;
+        }
+    else
+        {
+            d_downsample = false;
+        }
+
+    // The filter starts with a zeroed history, as the GNU Radio filters
+    d_samples.assign(d_ntaps - 1, gr_complex(0.0F, 0.0F));
+}
+
+
+std::size_t Fused_Conditioner::items_per_sample() const
+{
+    return d_input_type == Input_Type::COMPLEX ? 1 : 2;
+}
+
+
+double Fused_Conditioner::rate() const
+{
+    return d_rate;
+}
+
+
+std::size_t Fused_Conditioner::stored_samples() const
+{
+    return d_samples.size() - std::min(d_samples.size(), d_next_window);
+}
+
+
+void Fused_Conditioner::push(const void* input, std::size_t n_samples)
+{
+    const std::size_t first = d_samples.size();
+    d_samples.resize(first + n_samples);
+    gr_complex* out = d_samples.data() + first;
+    switch (d_input_type)
+        {
+        case Input_Type::COMPLEX:
+            std::copy_n(static_cast<const gr_complex*>(input), n_samples, out);
+            break;
+        case Input_Type::SHORT:
+            volk_16i_s32f_convert_32f(reinterpret_cast<float*>(out), static_cast<const int16_t*>(input), 1.0F, 2 * n_samples);
+            break;
+        case Input_Type::BYTE:
+            volk_8i_s32f_convert_32f(reinterpret_cast<float*>(out), static_cast<const int8_t*>(input), 1.0F, 2 * n_samples);
+            break;
+        }
+    if (d_inverted_spectrum)
+        {
+            std::transform(out, out + n_samples, out, [](const gr_complex& s) { return std::conj(s); });
+        }
+}
+
+
+bool Fused_Conditioner::window_available() const
+{
+    return d_next_window + d_ntaps <= d_samples.size();
+}
+
+
+gr_complex Fused_Conditioner::filter_next()
+{
+    const gr_complex* window = d_samples.data() + d_next_window;
+    gr_complex result;
+    if (d_xlating)
+        {
+            volk_32fc_x2_dot_prod_32fc(&result, window, d_ctaps_reversed.data(), d_ntaps);
+            result *= d_rotator;
+        }
+    else if (!d_taps_reversed.empty())
+        {
+            volk_32fc_32f_dot_prod_32fc(&result, window, d_taps_reversed.data(), d_ntaps);
+        }
+    else
+        {
+            result = *window;
+        }
+    return result;
+}
+
+
+void Fused_Conditioner::next_filtered_sample()
+{
+    d_next_window += d_decimation;
+    if (d_xlating)
+        {
+            d_rotator *= d_rotator_step;
+            if (++d_rotations == 512)
+                {
+                    d_rotator /= std::abs(d_rotator);
+                    d_rotations = 0;
+                }
+        }
+}
+
+
+std::size_t Fused_Conditioner::pull(gr_complex* output, std::size_t max_output)
+{
+    std::size_t produced = 0;
+    if (!d_resample or d_downsample)
+        {
+            while (produced < max_output and window_available())
+                {
+                    // Without resampler all the filtered samples are kept
+                    bool keep = true;
+                    if (d_resample)
+                        {
+                            keep = (d_phase <= d_lphase);
+                            d_lphase = d_phase;
+                            d_phase += d_phase_step;
+                        }
+                    if (keep)
+                        {
+                            output[produced++] = filter_next();
+                        }
+                    next_filtered_sample();
+                }
+        }
+    else
+        {
+            // Upsampling: each filtered sample is repeated until the phase
+            // accumulator wraps
+            while (produced < max_output)
+                {
+                    if (!d_have_current)
+                        {
+                            if (!window_available())
+                                {
+                                    break;
+                                }
+                            d_current = filter_next();
+                            next_filtered_sample();
+                            d_have_current = true;
+                        }
+                    const uint32_t next_phase = d_phase + d_phase_step;
+                    if (next_phase <= d_phase)
+                        {
+                            if (!window_available())
+                                {
+                                    break;
+                                }
+                            d_current = filter_next();
+                            next_filtered_sample();
+                        }
+                    d_lphase = d_phase;
+                    d_phase = next_phase;
+                    output[produced++] = d_current;
+                }
+        }
+
+    // Keep only the samples that are still needed
+    const std::size_t used = std::min(d_next_window, d_samples.size());
+    d_samples.erase(d_samples.begin(), d_samples.begin() + static_cast<std::ptrdiff_t>(used));
+    d_next_window -= used;
+    return produced;
+}
@@ -0,0 +1,130 @@
+/*!
+ * \file fused_conditioner.h
+ * \brief Data type conversion, FIR filtering and direct resampling of a
+ * sample stream in a single pass.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_FUSED_CONDITIONER_H
+#define GNSS_SDR_FUSED_CONDITIONER_H
+
+#include <gnuradio/gr_complex.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/** \addtogroup Signal_Conditioner
+ * \{ */
+/** \addtogroup Signal_Conditioner_gnuradio_blocks conditioner_gr_blocks
+ * GNU Radio blocks for signal conditioning
+ * \{ */
+
+
+/*!
+ * \brief Parameters of the three stages of a Fused_Conditioner. They mirror
+ * the DataTypeAdapter, InputFilter and Resampler blocks that it replaces.
+ */
+class Fused_Conditioner_Conf
+{
+public:
+    std::string input_item_type = std::string("gr_complex");  //!< "gr_complex", "short" (interleaved I/Q) or "byte" (interleaved I/Q)
+    bool inverted_spectrum = false;                           //!< Conjugate the samples after the conversion
+    std::vector<float> taps;                                  //!< FIR filter taps. Empty for no filter
+    double intermediate_freq = 0.0;                           //!< Hz. If not zero, the filter translates this frequency to baseband, as Freq_Xlating_Fir_Filter
+    double sampling_freq = 4000000.0;                         //!< Hz, input sampling rate, for intermediate_freq
+    int decimation_factor = 1;                                //!< Filter decimation
+    bool resample = false;                                    //!< Apply a Direct_Resampler after the filter
+    double sample_freq_in = 4000000.0;                        //!< Hz, resampler input rate
+    double sample_freq_out = 4000000.0;                       //!< Hz, resampler output rate
+};
+
+
+/*!
+ * \brief Converts, filters, decimates and resamples a sample stream in one
+ * pass over a small, cache-resident buffer, with the same results as the
+ * chain of separate blocks (up to floating point rounding).
+ *
+ * When downsampling, the filter is only evaluated for the samples kept by the
+ * resampler.
+ */
+class Fused_Conditioner
+{
+public:
+    explicit Fused_Conditioner(const Fused_Conditioner_Conf& conf);
+
+    /*!
+     * \brief Number of input items per complex sample: 2 for the interleaved
+     * input types, 1 for gr_complex
+     */
+    std::size_t items_per_sample() const;
+
+    /*!
+     * \brief Output samples per input sample
+     */
+    double rate() const;
+
+    /*!
+     * \brief Converts and stores n_samples input samples
+     * (n_samples * items_per_sample() items)
+     */
+    void push(const void* input, std::size_t n_samples);
+
+    /*!
+     * \brief Writes up to max_output conditioned samples, as many as the
+     * stored input allows, and returns how many were written
+     */
+    std::size_t pull(gr_complex* output, std::size_t max_output);
+
+    /*!
+     * \brief Input samples stored and not used yet
+     */
+    std::size_t stored_samples() const;
+
+private:
+    enum class Input_Type
+    {
+        COMPLEX,
+        SHORT,
+        BYTE
+    };
+
+    bool window_available() const;
+    gr_complex filter_next();
+    void next_filtered_sample();
+
+    std::vector<gr_complex> d_samples;         // converted input samples, starting with the filter history
+    std::vector<float> d_taps_reversed;        // real taps, in dot product order
+    std::vector<gr_complex> d_ctaps_reversed;  // frequency shifted taps, in dot product order
+    std::size_t d_ntaps;
+    std::size_t d_next_window{0};  // first sample of the window of the next filtered sample
+    std::size_t d_decimation;
+    gr_complex d_rotator{1.0F, 0.0F};
+    gr_complex d_rotator_step{1.0F, 0.0F};
+    uint32_t d_rotations{0};
+    gr_complex d_current{0.0F, 0.0F};  // last filtered sample, repeated when upsampling
+    uint32_t d_phase{0};
+    uint32_t d_lphase{0};
+    uint32_t d_phase_step{0};
+    double d_rate;
+    Input_Type d_input_type;
+    bool d_inverted_spectrum;
+    bool d_xlating;
+    bool d_resample;
+    bool d_downsample;
+    bool d_have_current{false};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_FUSED_CONDITIONER_H
@@ -0,0 +1,84 @@
+/*!
+ * \file fused_conditioner_cc.cc
+ * \brief GNU Radio block that converts, filters and resamples the input
+ * samples in a single pass, instead of three separate blocks.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "fused_conditioner_cc.h"
+#include <gnuradio/io_signature.h>
+#include <algorithm>  // for max, min
+#include <cmath>      // for ceil
+#include <cstdint>    // for int8_t, int16_t
+
+
+namespace
+{
+// Samples converted per call, so that the working buffer stays in cache
+constexpr std::size_t FUSED_CONDITIONER_CHUNK = 8192;
+
+int fused_conditioner_input_item_size(const Fused_Conditioner_Conf& conf)
+{
+    if (conf.input_item_type == "short")
+        {
+            return sizeof(int16_t);
+        }
+    if (conf.input_item_type == "byte")
+        {
+            return sizeof(int8_t);
+        }
+    return sizeof(gr_complex);
+}
+}  // namespace
+
+
+fused_conditioner_cc_sptr make_fused_conditioner_cc(const Fused_Conditioner_Conf& conf)
+{
+    return fused_conditioner_cc_sptr(new fused_conditioner_cc(conf));
+}
+
+
+fused_conditioner_cc::fused_conditioner_cc(const Fused_Conditioner_Conf& conf)
+    : gr::block("fused_conditioner_cc",
+          gr::io_signature::make(1, 1, fused_conditioner_input_item_size(conf)),
+          gr::io_signature::make(1, 1, sizeof(gr_complex))),
+      d_conditioner(conf),
+      d_items_per_sample(d_conditioner.items_per_sample())
+{
+    set_relative_rate(d_conditioner.rate() / static_cast<double>(d_items_per_sample));
+}
+
+
+void fused_conditioner_cc::forecast(int noutput_items, gr_vector_int& ninput_items_required)
+{
+    const auto samples = static_cast<std::size_t>(std::ceil(static_cast<double>(noutput_items) / d_conditioner.rate()));
+    ninput_items_required[0] = static_cast<int>(d_items_per_sample * std::max<std::size_t>(1, std::min(samples, FUSED_CONDITIONER_CHUNK)));
+}
+
+
+int fused_conditioner_cc::general_work(int noutput_items, gr_vector_int& ninput_items,
+    gr_vector_const_void_star& input_items, gr_vector_void_star& output_items)
+{
+    auto* out = reinterpret_cast<gr_complex*>(output_items[0]);
+
+    // Do not store more than one chunk of input that cannot be output yet
+    std::size_t n_samples = static_cast<std::size_t>(ninput_items[0]) / d_items_per_sample;
+    const std::size_t stored = d_conditioner.stored_samples();
+    n_samples = stored >= FUSED_CONDITIONER_CHUNK ? 0 : std::min(n_samples, FUSED_CONDITIONER_CHUNK - stored);
+    if (n_samples > 0)
+        {
+            d_conditioner.push(input_items[0], n_samples);
+            consume_each(static_cast<int>(n_samples * d_items_per_sample));
+        }
+
+    return static_cast<int>(d_conditioner.pull(out, static_cast<std::size_t>(noutput_items)));
+}
@@ -0,0 +1,63 @@
+/*!
+ * \file fused_conditioner_cc.h
+ * \brief GNU Radio block that converts, filters and resamples the input
+ * samples in a single pass, instead of three separate blocks.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_FUSED_CONDITIONER_CC_H
+#define GNSS_SDR_FUSED_CONDITIONER_CC_H
+
+#include "fused_conditioner.h"
+#include "gnss_block_interface.h"
+#include <gnuradio/block.h>
+#include <cstddef>
+
+/** \addtogroup Signal_Conditioner
+ * \{ */
+/** \addtogroup Signal_Conditioner_gnuradio_blocks
+ * \{ */
+
+
+class fused_conditioner_cc;
+
+using fused_conditioner_cc_sptr = gnss_shared_ptr<fused_conditioner_cc>;
+
+fused_conditioner_cc_sptr make_fused_conditioner_cc(const Fused_Conditioner_Conf& conf);
+
+/*!
+ * \brief Runs a Fused_Conditioner on the input stream. The input items are
+ * gr_complex, or the interleaved I/Q short or byte components, and the
+ * output items are gr_complex.
+ */
+class fused_conditioner_cc : public gr::block
+{
+public:
+    ~fused_conditioner_cc() = default;
+
+    void forecast(int noutput_items, gr_vector_int& ninput_items_required);
+
+    int general_work(int noutput_items, gr_vector_int& ninput_items,
+        gr_vector_const_void_star& input_items, gr_vector_void_star& output_items);
+
+private:
+    friend fused_conditioner_cc_sptr make_fused_conditioner_cc(const Fused_Conditioner_Conf& conf);
+    explicit fused_conditioner_cc(const Fused_Conditioner_Conf& conf);
+
+    Fused_Conditioner d_conditioner;
+    std::size_t d_items_per_sample;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_FUSED_CONDITIONER_CC_H
@@ -0,0 +1,112 @@
+/*!
+ * \file bit_selection_to_cbyte.cc
+ * \brief Requantizes a gr_complex or std::complex<short> sample stream to a
+ * few bits, with automatic gain control, into a std::complex<signed char>
+ * stream
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "bit_selection_to_cbyte.h"
+#include "configuration_interface.h"
+#include "gnss_spectral_monitor.h"
+#include <glog/logging.h>
+#include <volk/volk.h>
+#include <algorithm>  // for min, max
+
+
+BitSelectionToCbyte::BitSelectionToCbyte(const ConfigurationInterface* configuration, const std::string& role,
+    unsigned int in_streams, unsigned int out_streams) : role_(role), in_streams_(in_streams), out_streams_(out_streams)
+{
+    const std::string default_input_item_type("gr_complex");
+    const std::string default_dump_filename("../data/data_type_adapter.dat");
+
+    DLOG(INFO) << "role " << role_;
+
+    input_item_type_ = configuration->property(role_ + ".input_item_type", default_input_item_type);
+    int bits = configuration->property(role_ + ".bits", 4);
+    int estimation_samples = configuration->property(role_ + ".estimation_samples", 10000);
+    dump_ = configuration->property(role_ + ".dump", false);
+    dump_filename_ = configuration->property(role_ + ".dump_filename", default_dump_filename);
+
+    if (bits < 2 or bits > 8)
+        {
+            LOG(WARNING) << role_ << ".bits must be between 2 and 8. It has been set to " << std::min(std::max(bits, 2), 8);
+            bits = std::min(std::max(bits, 2), 8);
+        }
+    if (estimation_samples < 1)
+        {
+            LOG(WARNING) << role_ << ".estimation_samples must be positive. It has been set to 10000";
+            estimation_samples = 10000;
+        }
+
+    size_t input_item_size = sizeof(gr_complex);
+    if (input_item_type_ == "cshort")
+        {
+            input_item_size = sizeof(lv_16sc_t);
+        }
+    else if (input_item_type_ != "gr_complex")
+        {
+            LOG(WARNING) << input_item_type_ << " unrecognized input item type for " << implementation() << ". Using gr_complex";
+        }
+
+    bit_selection_ = make_bit_selection_to_complex_byte(input_item_size, bits, estimation_samples, Gnss_Spectral_Monitor::rf_channel(role_));
+
+    DLOG(INFO) << "data_type_adapter_(" << bit_selection_->unique_id() << ")";
+
+    if (dump_)
+        {
+            DLOG(INFO) << "Dumping output into file " << dump_filename_;
+            file_sink_ = gr::blocks::file_sink::make(sizeof(lv_8sc_t), dump_filename_.c_str());
+        }
+    if (in_streams_ > 1)
+        {
+            LOG(ERROR) << "This implementation only supports one input stream";
+        }
+    if (out_streams_ > 1)
+        {
+            LOG(ERROR) << "This implementation only supports one output stream";
+        }
+}
+
+
+void BitSelectionToCbyte::connect(gr::top_block_sptr top_block)
+{
+    if (dump_)
+        {
+            top_block->connect(bit_selection_, 0, file_sink_, 0);
+        }
+    else
+        {
+            DLOG(INFO) << "Nothing to connect internally";
+        }
+}
+
+
+void BitSelectionToCbyte::disconnect(gr::top_block_sptr top_block)
+{
+    if (dump_)
+        {
+            top_block->disconnect(bit_selection_, 0, file_sink_, 0);
+        }
+}
+
+
+gr::basic_block_sptr BitSelectionToCbyte::get_left_block()
+{
+    return bit_selection_;
+}
+
+
+gr::basic_block_sptr BitSelectionToCbyte::get_right_block()
+{
+    return bit_selection_;
+}
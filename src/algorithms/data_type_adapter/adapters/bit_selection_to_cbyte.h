@@ -0,0 +1,84 @@
+/*!
+ * \file bit_selection_to_cbyte.h
+ * \brief Requantizes a gr_complex or std::complex<short> sample stream to a
+ * few bits, with automatic gain control, into a std::complex<signed char>
+ * stream
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_BIT_SELECTION_TO_CBYTE_H
+#define GNSS_SDR_BIT_SELECTION_TO_CBYTE_H
+
+#include "bit_selection_to_complex_byte.h"
+#include "gnss_block_interface.h"
+#include <gnuradio/blocks/file_sink.h>
+#include <cstdint>
+#include <string>
+
+/** \addtogroup Data_Type
+ * \{ */
+/** \addtogroup Data_type_adapters
+ * \{ */
+
+
+class ConfigurationInterface;
+
+/*!
+ * \brief Software dynamic bit selection: adapts a gr_complex or cshort
+ * sample stream (input_item_type) into a cbyte stream of bits bits, with the
+ * gain set from the input power estimated over estimation_samples samples.
+ */
+class BitSelectionToCbyte : public GNSSBlockInterface
+{
+public:
+    BitSelectionToCbyte(const ConfigurationInterface* configuration,
+        const std::string& role, unsigned int in_streams,
+        unsigned int out_streams);
+
+    ~BitSelectionToCbyte() = default;
+
+    inline std::string role() override
+    {
+        return role_;
+    }
+
+    //! Returns "Bit_Selection_To_Cbyte"
+    inline std::string implementation() override
+    {
+        return "Bit_Selection_To_Cbyte";
+    }
+
+    inline size_t item_size() override
+    {
+        return 2 * sizeof(int8_t);
+    }
+
+    void connect(gr::top_block_sptr top_block) override;
+    void disconnect(gr::top_block_sptr top_block) override;
+    gr::basic_block_sptr get_left_block() override;
+    gr::basic_block_sptr get_right_block() override;
+
+private:
+    bit_selection_to_complex_byte_sptr bit_selection_;
+    gr::blocks::file_sink::sptr file_sink_;
+    std::string dump_filename_;
+    std::string input_item_type_;
+    std::string role_;
+    unsigned int in_streams_;
+    unsigned int out_streams_;
+    bool dump_;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_BIT_SELECTION_TO_CBYTE_H
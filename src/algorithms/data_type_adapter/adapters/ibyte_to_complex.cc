@@ -32,7 +32,7 @@ IbyteToComplex::IbyteToComplex(const ConfigurationInterface* configuration, cons
 
     dump_ = configuration->property(role_ + ".dump", false);
     dump_filename_ = configuration->property(role_ + ".dump_filename", default_dump_filename);
-    inverted_spectrum = configuration->property(role + ".inverted_spectrum", false);
+    inverted_spectrum_ = configuration->property(role + ".inverted_spectrum", false);
 
     const size_t item_size = sizeof(gr_complex);
 
@@ -40,7 +40,7 @@ IbyteToComplex::IbyteToComplex(const ConfigurationInterface* configuration, cons
 
     DLOG(INFO) << "data_type_adapter_(" << gr_interleaved_char_to_complex_->unique_id() << ")";
 
-    if (inverted_spectrum)
+    if (inverted_spectrum_)
         {
             conjugate_cc_ = make_conjugate_cc();
         }
@@ -64,7 +64,7 @@ void IbyteToComplex::connect(gr::top_block_sptr top_block)
 {
     if (dump_)
         {
-            if (inverted_spectrum)
+            if (inverted_spectrum_)
                 {
                     top_block->connect(gr_interleaved_char_to_complex_, 0, conjugate_cc_, 0);
                     top_block->connect(conjugate_cc_, 0, file_sink_, 0);
@@ -76,7 +76,7 @@ void IbyteToComplex::connect(gr::top_block_sptr top_block)
         }
     else
         {
-            if (inverted_spectrum)
+            if (inverted_spectrum_)
                 {
                     top_block->connect(gr_interleaved_char_to_complex_, 0, conjugate_cc_, 0);
                 }
@@ -92,7 +92,7 @@ void IbyteToComplex::disconnect(gr::top_block_sptr top_block)
 {
     if (dump_)
         {
-            if (inverted_spectrum)
+            if (inverted_spectrum_)
                 {
                     top_block->disconnect(gr_interleaved_char_to_complex_, 0, conjugate_cc_, 0);
                     top_block->disconnect(conjugate_cc_, 0, file_sink_, 0);
@@ -104,7 +104,7 @@ void IbyteToComplex::disconnect(gr::top_block_sptr top_block)
         }
     else
         {
-            if (inverted_spectrum)
+            if (inverted_spectrum_)
                 {
                     top_block->disconnect(gr_interleaved_char_to_complex_, 0, conjugate_cc_, 0);
                 }
@@ -120,7 +120,7 @@ gr::basic_block_sptr IbyteToComplex::get_left_block()
 
 gr::basic_block_sptr IbyteToComplex::get_right_block()
 {
-    if (inverted_spectrum)
+    if (inverted_spectrum_)
         {
             return conjugate_cc_;
         }
@@ -61,6 +61,17 @@ public:
         return 2 * sizeof(int16_t);
     }
 
+    //! Conjugate the samples after the conversion
+    inline bool inverted_spectrum() const
+    {
+        return inverted_spectrum_;
+    }
+
+    inline bool dump() const
+    {
+        return dump_;
+    }
+
     void connect(gr::top_block_sptr top_block) override;
     void disconnect(gr::top_block_sptr top_block) override;
     gr::basic_block_sptr get_left_block() override;
@@ -76,7 +87,7 @@ private:
     std::string role_;
     unsigned int in_streams_;
     unsigned int out_streams_;
-    bool inverted_spectrum;
+    bool inverted_spectrum_;
     bool dump_;
 };
 
@@ -0,0 +1,66 @@
+/*!
+ * \file bit_selection_to_complex_byte.cc
+ * \brief Requantizes a gr_complex or std::complex<short> sample stream to a
+ * few bits, with automatic gain control, into a std::complex<signed char>
+ * stream
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "bit_selection_to_complex_byte.h"
+#include "gnss_spectral_monitor.h"
+#include <gnuradio/io_signature.h>
+#include <volk/volk.h>
+#include <algorithm>  // for max
+
+
+bit_selection_to_complex_byte_sptr make_bit_selection_to_complex_byte(size_t input_item_size, int32_t bits, int32_t estimation_samples, uint32_t rf_channel)
+{
+    return bit_selection_to_complex_byte_sptr(new bit_selection_to_complex_byte(input_item_size, bits, estimation_samples, rf_channel));
+}
+
+
+bit_selection_to_complex_byte::bit_selection_to_complex_byte(size_t input_item_size, int32_t bits, int32_t estimation_samples, uint32_t rf_channel)
+    : sync_block("bit_selection_to_complex_byte",
+          gr::io_signature::make(1, 1, input_item_size),
+          gr::io_signature::make(1, 1, sizeof(lv_8sc_t))),  // lv_8sc_t is a Volk's typedef for std::complex<signed char>
+      d_selector(bits, estimation_samples),
+      d_rf_channel(rf_channel),
+      d_short_input(input_item_size == sizeof(lv_16sc_t))
+{
+    const auto alignment_multiple = static_cast<int>(volk_get_alignment() / sizeof(lv_8sc_t));
+    set_alignment(std::max(1, alignment_multiple));
+}
+
+
+bool bit_selection_to_complex_byte::start()
+{
+    // the monitors are published by the flow graph after the blocks are made
+    d_selector.set_spectral_monitor(Gnss_Spectral_Monitor::instance(d_rf_channel));
+    return true;
+}
+
+
+int bit_selection_to_complex_byte::work(int noutput_items,
+    gr_vector_const_void_star &input_items,
+    gr_vector_void_star &output_items)
+{
+    auto *out = reinterpret_cast<lv_8sc_t *>(output_items[0]);
+    if (d_short_input)
+        {
+            d_selector.quantize(reinterpret_cast<const lv_16sc_t *>(input_items[0]), out, noutput_items);
+        }
+    else
+        {
+            d_selector.quantize(reinterpret_cast<const gr_complex *>(input_items[0]), out, noutput_items);
+        }
+    return noutput_items;
+}
@@ -0,0 +1,68 @@
+/*!
+ * \file bit_selection_to_complex_byte.h
+ * \brief Requantizes a gr_complex or std::complex<short> sample stream to a
+ * few bits, with automatic gain control, into a std::complex<signed char>
+ * stream
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_BIT_SELECTION_TO_COMPLEX_BYTE_H
+#define GNSS_SDR_BIT_SELECTION_TO_COMPLEX_BYTE_H
+
+#include "bit_selector.h"
+#include "gnss_block_interface.h"
+#include <gnuradio/sync_block.h>
+#include <cstddef>
+#include <cstdint>
+
+/** \addtogroup Data_Type
+ * \{ */
+/** \addtogroup data_type_gnuradio_blocks
+ * \{ */
+
+
+class bit_selection_to_complex_byte;
+
+using bit_selection_to_complex_byte_sptr = gnss_shared_ptr<bit_selection_to_complex_byte>;
+
+bit_selection_to_complex_byte_sptr make_bit_selection_to_complex_byte(size_t input_item_size, int32_t bits = 4, int32_t estimation_samples = 10000, uint32_t rf_channel = 0);
+
+/*!
+ * \brief This class requantizes a gr_complex (input_item_size of 8 bytes)
+ * or std::complex<short> (4 bytes) sample stream to bits bits in a
+ * std::complex<signed char> stream, so that the cbyte acquisition and
+ * tracking implementations can be used with any front end (see Bit_Selector).
+ * The power is taken from the Gnss_Spectral_Monitor of rf_channel, if the
+ * flow graph has one when the block starts.
+ */
+class bit_selection_to_complex_byte : public gr::sync_block
+{
+public:
+    bool start() override;
+
+    int work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+private:
+    friend bit_selection_to_complex_byte_sptr make_bit_selection_to_complex_byte(size_t input_item_size, int32_t bits, int32_t estimation_samples, uint32_t rf_channel);
+    bit_selection_to_complex_byte(size_t input_item_size, int32_t bits, int32_t estimation_samples, uint32_t rf_channel);
+
+    Bit_Selector d_selector;
+    uint32_t d_rf_channel;
+    bool d_short_input;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_BIT_SELECTION_TO_COMPLEX_BYTE_H
@@ -0,0 +1,168 @@
+/*!
+ * \file bit_selector.cc
+ * \brief Automatic gain control and requantization of complex samples to
+ * a few bits, stored in std::complex<signed char> samples.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "bit_selector.h"
+#include "gnss_spectral_monitor.h"
+#include <volk/volk.h>
+#include <algorithm>  // for min, max
+#include <array>
+#include <cmath>      // for floor, sqrt
+#include <stdexcept>  // for invalid_argument
+#include <utility>    // for move
+
+
+namespace
+{
+// Samples converted and quantized at a time
+const int32_t BIT_SELECTOR_BLOCK_SAMPLES = 4096;
+
+// Weight of the last estimation window in the smoothed power
+const float BIT_SELECTOR_POWER_SMOOTHING = 0.25;
+}  // namespace
+
+
+Bit_Selector::Bit_Selector(int32_t bits, int32_t estimation_samples)
+    : d_bits(bits),
+      d_estimation_samples(estimation_samples)
+{
+    if (bits < 2 or bits > 8)
+        {
+            throw std::invalid_argument("Bit_Selector: the number of bits must be between 2 and 8");
+        }
+    if (estimation_samples < 1)
+        {
+            throw std::invalid_argument("Bit_Selector: the estimation window must be positive");
+        }
+    d_max_level = static_cast<int8_t>(bits == 8 ? 127 : (1 << bits) - 1);
+    d_buffer.resize(2 * BIT_SELECTOR_BLOCK_SAMPLES);
+}
+
+
+int32_t Bit_Selector::bits() const
+{
+    return d_bits;
+}
+
+
+float Bit_Selector::power() const
+{
+    return d_power;
+}
+
+
+float Bit_Selector::optimal_step(int32_t bits)
+{
+    // Optimum uniform quantizer of a unit variance Gaussian input, 2^bits levels
+    const std::array<float, 7> steps{0.9957, 0.5860, 0.3352, 0.1881, 0.1041, 0.0569, 0.0308};
+    return steps[std::min(std::max(bits, 2), 8) - 2];
+}
+
+
+void Bit_Selector::set_spectral_monitor(std::shared_ptr<const Gnss_Spectral_Monitor> monitor)
+{
+    d_monitor = std::move(monitor);
+    d_monitor_sequence = 0;
+}
+
+
+void Bit_Selector::update_gain()
+{
+    if (d_power > 0.0F)
+        {
+            d_inv_step = 1.0F / (optimal_step(d_bits) * std::sqrt(d_power / 2.0F));
+        }
+}
+
+
+void Bit_Selector::quantize_levels(const float* in, int8_t* out, int32_t n_samples) const
+{
+    if (d_bits == 8)
+        {
+            // rounds and saturates to [-128, 127]
+            volk_32f_s32f_convert_8i(out, in, d_inv_step, 2 * static_cast<unsigned int>(n_samples));
+        }
+    else
+        {
+            const auto max_level = static_cast<float>(d_max_level);
+            for (int32_t k = 0; k < 2 * n_samples; k++)
+                {
+                    const float level = 2.0F * std::floor(in[k] * d_inv_step) + 1.0F;
+                    out[k] = static_cast<int8_t>(std::min(std::max(level, -max_level), max_level));
+                }
+        }
+}
+
+
+void Bit_Selector::quantize_block(const float* in, int8_t* out, int32_t n_samples)
+{
+    const uint64_t sequence = d_monitor != nullptr ? d_monitor->sequence() : 0;
+    if (sequence > 0)
+        {
+            if (sequence != d_monitor_sequence)
+                {
+                    d_monitor_sequence = sequence;
+                    d_power = d_monitor->total_power();
+                    update_gain();
+                }
+            quantize_levels(in, out, n_samples);
+            return;
+        }
+
+    float energy = 0.0;
+    volk_32f_x2_dot_prod_32f(&energy, in, in, 2 * static_cast<unsigned int>(n_samples));
+    if (d_power == 0.0F)
+        {
+            d_power = energy / static_cast<float>(n_samples);
+            update_gain();
+        }
+    quantize_levels(in, out, n_samples);
+
+    d_energy += static_cast<double>(energy);
+    d_accumulated_samples += n_samples;
+    if (d_accumulated_samples == d_estimation_samples)
+        {
+            const auto window_power = static_cast<float>(d_energy / static_cast<double>(d_accumulated_samples));
+            d_power += BIT_SELECTOR_POWER_SMOOTHING * (window_power - d_power);
+            update_gain();
+            d_energy = 0.0;
+            d_accumulated_samples = 0;
+        }
+}
+
+
+void Bit_Selector::quantize(const gr_complex* in, lv_8sc_t* out, int32_t n_samples)
+{
+    int32_t done = 0;
+    while (done < n_samples)
+        {
+            const int32_t block = std::min({n_samples - done, d_estimation_samples - d_accumulated_samples, BIT_SELECTOR_BLOCK_SAMPLES});
+            quantize_block(reinterpret_cast<const float*>(in + done), reinterpret_cast<int8_t*>(out + done), block);
+            done += block;
+        }
+}
+
+
+void Bit_Selector::quantize(const lv_16sc_t* in, lv_8sc_t* out, int32_t n_samples)
+{
+    int32_t done = 0;
+    while (done < n_samples)
+        {
+            const int32_t block = std::min({n_samples - done, d_estimation_samples - d_accumulated_samples, BIT_SELECTOR_BLOCK_SAMPLES});
+            volk_16i_s32f_convert_32f(d_buffer.data(), reinterpret_cast<const int16_t*>(in + done), 1.0, 2 * static_cast<unsigned int>(block));
+            quantize_block(d_buffer.data(), reinterpret_cast<int8_t*>(out + done), block);
+            done += block;
+        }
+}
@@ -0,0 +1,96 @@
+/*!
+ * \file bit_selector.h
+ * \brief Automatic gain control and requantization of complex samples to
+ * a few bits, stored in std::complex<signed char> samples.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_BIT_SELECTOR_H
+#define GNSS_SDR_BIT_SELECTOR_H
+
+#include <gnuradio/gr_complex.h>
+#include <volk/volk_complex.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/** \addtogroup Data_Type
+ * \{ */
+/** \addtogroup data_type_gnuradio_blocks
+ * \{ */
+
+
+class Gnss_Spectral_Monitor;
+
+/*!
+ * \brief Software counterpart of the FPGA dynamic bit selection: estimates
+ * the input power and requantizes the samples to bits() bits with the step
+ * that minimizes the quantization noise of a Gaussian input (Max, 1960).
+ *
+ * The noise dominated GNSS input is close to Gaussian, so the step is a
+ * constant fraction of the RMS value of each component, and the C/N0 loss is
+ * the one of the ideal uniform quantizer (about 0.55 dB for 2 bits and
+ * 0.05 dB for 4 bits).
+ *
+ * The power is estimated over windows of estimation_samples samples and
+ * smoothed from one window to the next, so the gain follows slow changes of
+ * the front end gain and temperature without modulating the signal. The
+ * first window is scaled with the power of its first samples.
+ *
+ * Up to 7 bits, the quantizer is mid-riser and its 2^bits levels are the odd
+ * integers between -(2^bits - 1) and 2^bits - 1. With 8 bits, it is mid-tread
+ * and the levels are the integers between -128 and 127.
+ */
+class Bit_Selector
+{
+public:
+    /*!
+     * \brief Throws std::invalid_argument if bits is not between 2 and 8, or
+     * estimation_samples is not positive.
+     */
+    Bit_Selector(int32_t bits, int32_t estimation_samples);
+
+    int32_t bits() const;
+
+    //! Power of the input samples, 0 until the first samples are processed
+    float power() const;
+
+    //! Quantization step, in units of the RMS value of each component
+    static float optimal_step(int32_t bits);
+
+    //! Takes the power from the estimates of monitor, or from the samples if it is null
+    void set_spectral_monitor(std::shared_ptr<const Gnss_Spectral_Monitor> monitor);
+
+    void quantize(const gr_complex* in, lv_8sc_t* out, int32_t n_samples);
+    void quantize(const lv_16sc_t* in, lv_8sc_t* out, int32_t n_samples);
+
+private:
+    void quantize_block(const float* in, int8_t* out, int32_t n_samples);
+    void quantize_levels(const float* in, int8_t* out, int32_t n_samples) const;
+    void update_gain();
+
+    std::shared_ptr<const Gnss_Spectral_Monitor> d_monitor;
+    std::vector<float> d_buffer;
+    uint64_t d_monitor_sequence{0};
+    double d_energy{0.0};
+    float d_power{0.0};
+    float d_inv_step{0.0};
+    int32_t d_bits;
+    int32_t d_estimation_samples;
+    int32_t d_accumulated_samples{0};
+    int8_t d_max_level;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_BIT_SELECTOR_H
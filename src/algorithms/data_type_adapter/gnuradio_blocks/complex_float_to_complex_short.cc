@@ -0,0 +1,49 @@
+/*!
+ * \file complex_float_to_complex_short.cc
+ * \brief Adapts a gr_complex sample stream into a std::complex<short> stream,
+ * scaling and saturating the samples
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "complex_float_to_complex_short.h"
+#include <gnuradio/io_signature.h>
+#include <volk/volk.h>
+#include <algorithm>  // for max
+
+
+complex_float_to_complex_short_sptr make_complex_float_to_complex_short(float scale)
+{
+    return complex_float_to_complex_short_sptr(new complex_float_to_complex_short(scale));
+}
+
+
+complex_float_to_complex_short::complex_float_to_complex_short(float scale)
+    : sync_block("complex_float_to_complex_short",
+          gr::io_signature::make(1, 1, sizeof(gr_complex)),
+          gr::io_signature::make(1, 1, sizeof(lv_16sc_t))),  // lv_16sc_t is a Volk's typedef for std::complex<short int>
+      d_scale(scale)
+{
+    const auto alignment_multiple = static_cast<int>(volk_get_alignment() / sizeof(gr_complex));
+    set_alignment(std::max(1, alignment_multiple));
+}
+
+
+int complex_float_to_complex_short::work(int noutput_items,
+    gr_vector_const_void_star &input_items,
+    gr_vector_void_star &output_items)
+{
+    const auto *in = reinterpret_cast<const float *>(input_items[0]);
+    auto *out = reinterpret_cast<int16_t *>(output_items[0]);
+    // scales, rounds and saturates the real and imaginary parts in a single pass
+    volk_32f_s32f_convert_16i(out, in, d_scale, 2 * noutput_items);
+    return noutput_items;
+}
@@ -0,0 +1,56 @@
+/*!
+ * \file complex_float_to_complex_short.h
+ * \brief Adapts a gr_complex sample stream into a std::complex<short> stream,
+ * scaling and saturating the samples
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_COMPLEX_FLOAT_TO_COMPLEX_SHORT_H
+#define GNSS_SDR_COMPLEX_FLOAT_TO_COMPLEX_SHORT_H
+
+#include "gnss_block_interface.h"
+#include <gnuradio/sync_block.h>
+
+/** \addtogroup Data_Type
+ * \{ */
+/** \addtogroup data_type_gnuradio_blocks
+ * \{ */
+
+
+class complex_float_to_complex_short;
+
+using complex_float_to_complex_short_sptr = gnss_shared_ptr<complex_float_to_complex_short>;
+
+complex_float_to_complex_short_sptr make_complex_float_to_complex_short(float scale = 1.0);
+
+/*!
+ * \brief This class adapts a gr_complex sample stream into a
+ * std::complex<short> stream, multiplying the samples by scale
+ */
+class complex_float_to_complex_short : public gr::sync_block
+{
+public:
+    int work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+private:
+    friend complex_float_to_complex_short_sptr make_complex_float_to_complex_short(float scale);
+    explicit complex_float_to_complex_short(float scale);
+
+    float d_scale;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_COMPLEX_FLOAT_TO_COMPLEX_SHORT_H
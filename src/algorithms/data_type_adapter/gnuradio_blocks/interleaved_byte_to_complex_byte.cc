@@ -19,6 +19,7 @@
 #include <gnuradio/io_signature.h>
 #include <volk/volk.h>
 #include <algorithm>  // for max
+#include <cstring>    // for memcpy
 
 
 interleaved_byte_to_complex_byte_sptr make_interleaved_byte_to_complex_byte()
@@ -42,17 +43,7 @@ int interleaved_byte_to_complex_byte::work(int noutput_items,
     gr_vector_const_void_star &input_items,
     gr_vector_void_star &output_items)
 {
-    const auto *in = reinterpret_cast<const int8_t *>(input_items[0]);
-    auto *out = reinterpret_cast<lv_8sc_t *>(output_items[0]);
-    // This could be put into a Volk kernel
-    int8_t real_part;
-    int8_t imag_part;
-    for (int number = 0; number < noutput_items; number++)
-        {
-            // lv_cmake(r, i) defined at volk/volk_complex.h
-            real_part = *in++;
-            imag_part = *in++;
-            *out++ = lv_cmake(real_part, imag_part);
-        }
+    // the interleaved bytes are already laid out as std::complex<signed char>
+    std::memcpy(output_items[0], input_items[0], noutput_items * sizeof(lv_8sc_t));
     return noutput_items;
 }
@@ -0,0 +1,135 @@
+/*!
+ * \file interleaved_channels_to_complex.cc
+ * \brief Splits a byte or short stream with the interleaved I/Q samples of
+ * several RF channels into one complex stream per channel
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "interleaved_channels_to_complex.h"
+#include <gnuradio/io_signature.h>
+#include <volk/volk.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>  // for max, min
+#include <stdexcept>  // for invalid_argument
+
+
+namespace
+{
+// Samples per channel deinterleaved at a time, so the input block stays in cache for all the channels
+const int INTERLEAVED_CHANNELS_BLOCK_SAMPLES = 2048;
+
+
+// The complex samples of a channel, taken as words of the size of a complex sample
+template <typename T>
+void interleaved_channels_deinterleave(const T *in, T *out, int32_t channels, int32_t channel, int n_samples)
+{
+    for (int k = 0; k < n_samples; k++)
+        {
+            out[k] = in[k * channels + channel];
+        }
+}
+}  // namespace
+
+
+interleaved_channels_to_complex_sptr make_interleaved_channels_to_complex(size_t input_item_size, size_t output_item_size, int32_t channels)
+{
+    return interleaved_channels_to_complex_sptr(new interleaved_channels_to_complex(input_item_size, output_item_size, channels));
+}
+
+
+interleaved_channels_to_complex::interleaved_channels_to_complex(size_t input_item_size, size_t output_item_size, int32_t channels)
+    : sync_decimator("interleaved_channels_to_complex",
+          gr::io_signature::make(1, 1, input_item_size),
+          gr::io_signature::make(std::max(channels, 1), std::max(channels, 1), output_item_size),
+          2 * std::max(channels, 1)),
+      d_input_item_size(input_item_size),
+      d_output_item_size(output_item_size),
+      d_channels(channels)
+{
+    if (channels < 1)
+        {
+            throw std::invalid_argument("interleaved_channels_to_complex: the number of channels must be positive");
+        }
+    if (input_item_size == sizeof(int8_t))
+        {
+            if (output_item_size != sizeof(lv_8sc_t) and output_item_size != sizeof(lv_16sc_t) and output_item_size != sizeof(gr_complex))
+                {
+                    throw std::invalid_argument("interleaved_channels_to_complex: unsupported output item size");
+                }
+            if (output_item_size != sizeof(lv_8sc_t))
+                {
+                    d_byte_buffer.resize(INTERLEAVED_CHANNELS_BLOCK_SAMPLES);
+                }
+        }
+    else if (input_item_size == sizeof(int16_t))
+        {
+            if (output_item_size != sizeof(lv_16sc_t) and output_item_size != sizeof(gr_complex))
+                {
+                    throw std::invalid_argument("interleaved_channels_to_complex: unsupported output item size");
+                }
+            if (output_item_size != sizeof(lv_16sc_t))
+                {
+                    d_short_buffer.resize(INTERLEAVED_CHANNELS_BLOCK_SAMPLES);
+                }
+        }
+    else
+        {
+            throw std::invalid_argument("interleaved_channels_to_complex: unsupported input item size");
+        }
+    const auto alignment_multiple = static_cast<int>(volk_get_alignment() / output_item_size);
+    set_alignment(std::max(1, alignment_multiple));
+}
+
+
+int interleaved_channels_to_complex::work(int noutput_items,
+    gr_vector_const_void_star &input_items,
+    gr_vector_void_star &output_items)
+{
+    for (int first = 0; first < noutput_items; first += INTERLEAVED_CHANNELS_BLOCK_SAMPLES)
+        {
+            const int n_samples = std::min(INTERLEAVED_CHANNELS_BLOCK_SAMPLES, noutput_items - first);
+            for (int32_t channel = 0; channel < d_channels; channel++)
+                {
+                    if (d_input_item_size == sizeof(int8_t))
+                        {
+                            const auto *in = reinterpret_cast<const lv_8sc_t *>(input_items[0]) + first * d_channels;
+                            if (d_output_item_size == sizeof(lv_8sc_t))
+                                {
+                                    interleaved_channels_deinterleave(in, reinterpret_cast<lv_8sc_t *>(output_items[channel]) + first, d_channels, channel, n_samples);
+                                    continue;
+                                }
+                            interleaved_channels_deinterleave(in, d_byte_buffer.data(), d_channels, channel, n_samples);
+                            if (d_output_item_size == sizeof(lv_16sc_t))
+                                {
+                                    volk_gnsssdr_8ic_convert_16ic(reinterpret_cast<lv_16sc_t *>(output_items[channel]) + first, d_byte_buffer.data(), n_samples);
+                                }
+                            else
+                                {
+                                    volk_8i_s32f_convert_32f(reinterpret_cast<float *>(reinterpret_cast<gr_complex *>(output_items[channel]) + first),
+                                        reinterpret_cast<const int8_t *>(d_byte_buffer.data()), 1.0, 2 * n_samples);
+                                }
+                        }
+                    else
+                        {
+                            const auto *in = reinterpret_cast<const lv_16sc_t *>(input_items[0]) + first * d_channels;
+                            if (d_output_item_size == sizeof(lv_16sc_t))
+                                {
+                                    interleaved_channels_deinterleave(in, reinterpret_cast<lv_16sc_t *>(output_items[channel]) + first, d_channels, channel, n_samples);
+                                    continue;
+                                }
+                            interleaved_channels_deinterleave(in, d_short_buffer.data(), d_channels, channel, n_samples);
+                            volk_gnsssdr_16ic_convert_32fc(reinterpret_cast<gr_complex *>(output_items[channel]) + first, d_short_buffer.data(), n_samples);
+                        }
+                }
+        }
+    return noutput_items;
+}
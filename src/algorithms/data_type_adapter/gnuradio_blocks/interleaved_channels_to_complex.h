@@ -0,0 +1,71 @@
+/*!
+ * \file interleaved_channels_to_complex.h
+ * \brief Splits a byte or short stream with the interleaved I/Q samples of
+ * several RF channels into one complex stream per channel
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_INTERLEAVED_CHANNELS_TO_COMPLEX_H
+#define GNSS_SDR_INTERLEAVED_CHANNELS_TO_COMPLEX_H
+
+#include "gnss_block_interface.h"
+#include <gnuradio/sync_decimator.h>
+#include <volk/volk_complex.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/** \addtogroup Data_Type
+ * \{ */
+/** \addtogroup data_type_gnuradio_blocks
+ * \{ */
+
+
+class interleaved_channels_to_complex;
+
+using interleaved_channels_to_complex_sptr = gnss_shared_ptr<interleaved_channels_to_complex>;
+
+interleaved_channels_to_complex_sptr make_interleaved_channels_to_complex(size_t input_item_size, size_t output_item_size, int32_t channels);
+
+/*!
+ * \brief This class splits a stream of bytes (input_item_size of 1) or
+ * shorts (2) ordered as I0 Q0 I1 Q1 ... I(N-1) Q(N-1), for each sample time
+ * of N = channels RF channels, into N streams of std::complex<signed char>
+ * (output_item_size of 2, only from bytes), std::complex<short> (4) or
+ * gr_complex (8).
+ *
+ * The samples are deinterleaved and converted in a single pass over each
+ * block of input, which replaces a gr::blocks::deinterleave followed by one
+ * data type adapter per channel.
+ */
+class interleaved_channels_to_complex : public gr::sync_decimator
+{
+public:
+    int work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+private:
+    friend interleaved_channels_to_complex_sptr make_interleaved_channels_to_complex(size_t input_item_size, size_t output_item_size, int32_t channels);
+    interleaved_channels_to_complex(size_t input_item_size, size_t output_item_size, int32_t channels);
+
+    std::vector<lv_8sc_t> d_byte_buffer;
+    std::vector<lv_16sc_t> d_short_buffer;
+    size_t d_input_item_size;
+    size_t d_output_item_size;
+    int32_t d_channels;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_INTERLEAVED_CHANNELS_TO_COMPLEX_H
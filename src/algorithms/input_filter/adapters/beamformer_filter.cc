@@ -16,9 +16,14 @@
 
 #include "beamformer_filter.h"
 #include "beamformer.h"
+#include "MATH_CONSTANTS.h"
 #include "configuration_interface.h"
+#include "gnss_frequencies.h"
 #include <glog/logging.h>
 #include <gnuradio/blocks/file_sink.h>
+#include <algorithm>  // for max
+#include <cstdint>
+#include <exception>
 
 
 BeamformerFilter::BeamformerFilter(
@@ -30,16 +35,66 @@ BeamformerFilter::BeamformerFilter(
 {
     const std::string default_item_type("gr_complex");
     const std::string default_dump_file("./data/input_filter.dat");
+    const std::string default_weights("fixed");
+    const double default_sampling_freq = 4000000.0;
+    const double default_carrier_freq = FREQ1;
+    const double default_update_period_ms = 1000.0;
+    const int default_snapshots = 1024;
+    const double default_diagonal_loading = 1e-3;
     item_type_ = configuration->property(role + ".item_type", default_item_type);
     dump_ = configuration->property(role + ".dump", false);
     dump_filename_ = configuration->property(role + ".dump_filename", default_dump_file);
+    const std::string weights = configuration->property(role + ".weights", default_weights);
+    const double sampling_freq = configuration->property(role + ".sampling_frequency", default_sampling_freq);
+    const double wavelength = SPEED_OF_LIGHT_M_S / configuration->property(role + ".carrier_frequency", default_carrier_freq);
+    const double update_period_ms = configuration->property(role + ".weights_update_period_ms", default_update_period_ms);
+
+    // One element per input stream. Element k (from 1) has the fixed or
+    // initial weight weight<k>_real + j weight<k>_imag, and its phase center
+    // at element<k>_east, element<k>_north, element<k>_up, in meters
+    Beamformer_Conf conf;
+    conf.elements = in_stream_ > 0 ? static_cast<int>(in_stream_) : GNSS_SDR_BEAMFORMER_CHANNELS;
+    for (int k = 1; k <= conf.elements; k++)
+        {
+            const std::string element = role + ".element" + std::to_string(k);
+            conf.weights.emplace_back(configuration->property(role + ".weight" + std::to_string(k) + "_real", 1.0F),
+                configuration->property(role + ".weight" + std::to_string(k) + "_imag", 0.0F));
+            conf.element_positions.push_back({configuration->property(element + "_east", 0.0) / wavelength,
+                configuration->property(element + "_north", 0.0) / wavelength,
+                configuration->property(element + "_up", 0.0) / wavelength});
+        }
+    if (weights == "power_inversion")
+        {
+            conf.mode = Beamformer_Conf::Weights_Mode::POWER_INVERSION;
+        }
+    else if (weights == "steered")
+        {
+            conf.mode = Beamformer_Conf::Weights_Mode::STEERED;
+        }
+    else if (weights != "fixed")
+        {
+            LOG(WARNING) << role << ".weights=" << weights << " is not valid (fixed, power_inversion or steered), using fixed";
+        }
+    conf.update_period_samples = static_cast<uint64_t>(std::max(update_period_ms, 0.0) * sampling_freq / 1000.0);
+    conf.snapshots = static_cast<size_t>(std::max(configuration->property(role + ".snapshots", default_snapshots), 1));
+    conf.diagonal_loading = configuration->property(role + ".diagonal_loading", default_diagonal_loading);
+    conf.reference_element = std::max(configuration->property(role + ".reference_element", 1), 1) - 1;
+
     DLOG(INFO) << "role " << role_;
     if (item_type_ == "gr_complex")
         {
-            item_size_ = sizeof(gr_complex);
-            beamformer_ = make_beamformer_sptr();
-            DLOG(INFO) << "Item size " << item_size_;
-            DLOG(INFO) << "resampler(" << beamformer_->unique_id() << ")";
+            try
+                {
+                    item_size_ = sizeof(gr_complex);
+                    beamformer_ = make_beamformer_sptr(conf);
+                    DLOG(INFO) << "Item size " << item_size_;
+                    DLOG(INFO) << "beamformer(" << beamformer_->unique_id() << ") with " << conf.elements << " elements and " << weights << " weights";
+                }
+            catch (const std::exception& e)
+                {
+                    LOG(ERROR) << role_ << ": " << e.what();
+                    item_size_ = 0;
+                }
         }
     else
         {
@@ -53,10 +108,6 @@ BeamformerFilter::BeamformerFilter(
             file_sink_ = gr::blocks::file_sink::make(item_size_, dump_filename_.c_str());
             DLOG(INFO) << "file_sink(" << file_sink_->unique_id() << ")";
         }
-    if (in_stream_ > 8)
-        {
-            LOG(ERROR) << "This implementation only supports eight input streams";
-        }
     if (out_stream_ > 1)
         {
             LOG(ERROR) << "This implementation only supports one output stream";
@@ -84,6 +84,31 @@ public:
         return item_size_;
     }
 
+    inline const std::vector<float>& taps() const
+    {
+        return taps_;
+    }
+
+    inline std::string input_item_type() const
+    {
+        return input_item_type_;
+    }
+
+    inline std::string output_item_type() const
+    {
+        return output_item_type_;
+    }
+
+    inline std::string taps_item_type() const
+    {
+        return taps_item_type_;
+    }
+
+    inline bool dump() const
+    {
+        return dump_;
+    }
+
     void connect(gr::top_block_sptr top_block) override;
     void disconnect(gr::top_block_sptr top_block) override;
     gr::basic_block_sptr get_left_block() override;
@@ -80,6 +80,46 @@ public:
         return input_size_;
     }
 
+    inline const std::vector<float>& taps() const
+    {
+        return taps_;
+    }
+
+    inline std::string input_item_type() const
+    {
+        return input_item_type_;
+    }
+
+    inline std::string output_item_type() const
+    {
+        return output_item_type_;
+    }
+
+    inline std::string taps_item_type() const
+    {
+        return taps_item_type_;
+    }
+
+    inline bool dump() const
+    {
+        return dump_;
+    }
+
+    inline double intermediate_freq() const
+    {
+        return intermediate_freq_;
+    }
+
+    inline double sampling_freq() const
+    {
+        return sampling_freq_;
+    }
+
+    inline int decimation_factor() const
+    {
+        return decimation_factor_;
+    }
+
     void connect(gr::top_block_sptr top_block) override;
     void disconnect(gr::top_block_sptr top_block) override;
     gr::basic_block_sptr get_left_block() override;
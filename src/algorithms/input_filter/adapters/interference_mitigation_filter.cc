@@ -0,0 +1,107 @@
+/*!
+ * \file interference_mitigation_filter.cc
+ * \brief Adapts the combined pulse blanking and notch filter block
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "interference_mitigation_filter.h"
+#include "configuration_interface.h"
+#include "gnss_spectral_monitor.h"
+#include <glog/logging.h>
+
+
+InterferenceMitigationFilter::InterferenceMitigationFilter(const ConfigurationInterface* configuration,
+    const std::string& role,
+    unsigned int in_streams,
+    unsigned int out_streams)
+    : role_(role),
+      in_streams_(in_streams),
+      out_streams_(out_streams)
+{
+    const std::string default_item_type("gr_complex");
+    const std::string default_dump_file("./data/input_filter.dat");
+    Interference_Mitigation_Conf conf;
+    conf.blanking_pfa = configuration->property(role + ".blanking_pfa", conf.blanking_pfa);
+    conf.notch_pfa = configuration->property(role + ".notch_pfa", conf.notch_pfa);
+    conf.p_c_factor = configuration->property(role + ".p_c_factor", conf.p_c_factor);
+    conf.length = configuration->property(role + ".length", conf.length);
+    conf.n_segments_est = configuration->property(role + ".segments_est", conf.n_segments_est);
+    conf.n_segments_reset = configuration->property(role + ".segments_reset", conf.n_segments_reset);
+    conf.rf_channel = Gnss_Spectral_Monitor::rf_channel(role);
+
+    dump_filename_ = configuration->property(role + ".dump_filename", default_dump_file);
+    item_type_ = configuration->property(role + ".item_type", default_item_type);
+    dump_ = configuration->property(role + ".dump", false);
+
+    DLOG(INFO) << "role " << role_;
+    if (item_type_ == "gr_complex")
+        {
+            item_size_ = sizeof(gr_complex);
+            interference_mitigation_ = make_interference_mitigation_cc(conf);
+            DLOG(INFO) << "Item size " << item_size_;
+            DLOG(INFO) << "input filter(" << interference_mitigation_->unique_id() << ")";
+        }
+    else
+        {
+            LOG(WARNING) << item_type_ << " unrecognized item type for interference mitigation filter";
+            item_size_ = 0;  // notify wrong configuration
+        }
+    if (dump_)
+        {
+            DLOG(INFO) << "Dumping output into file " << dump_filename_;
+            file_sink_ = gr::blocks::file_sink::make(item_size_, dump_filename_.c_str());
+            DLOG(INFO) << "file_sink(" << file_sink_->unique_id() << ")";
+        }
+    if (in_streams_ > 1)
+        {
+            LOG(ERROR) << "This implementation only supports one input stream";
+        }
+    if (out_streams_ > 1)
+        {
+            LOG(ERROR) << "This implementation only supports one output stream";
+        }
+}
+
+
+void InterferenceMitigationFilter::connect(gr::top_block_sptr top_block)
+{
+    if (dump_)
+        {
+            top_block->connect(interference_mitigation_, 0, file_sink_, 0);
+            DLOG(INFO) << "connected interference mitigation filter output to file sink";
+        }
+    else
+        {
+            DLOG(INFO) << "nothing to connect internally";
+        }
+}
+
+
+void InterferenceMitigationFilter::disconnect(gr::top_block_sptr top_block)
+{
+    if (dump_)
+        {
+            top_block->disconnect(interference_mitigation_, 0, file_sink_, 0);
+        }
+}
+
+
+gr::basic_block_sptr InterferenceMitigationFilter::get_left_block()
+{
+    return interference_mitigation_;
+}
+
+
+gr::basic_block_sptr InterferenceMitigationFilter::get_right_block()
+{
+    return interference_mitigation_;
+}
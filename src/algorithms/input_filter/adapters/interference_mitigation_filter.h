@@ -0,0 +1,83 @@
+/*!
+ * \file interference_mitigation_filter.h
+ * \brief Adapts the combined pulse blanking and notch filter block
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_INTERFERENCE_MITIGATION_FILTER_H
+#define GNSS_SDR_INTERFERENCE_MITIGATION_FILTER_H
+
+#include "gnss_block_interface.h"
+#include "interference_mitigation_cc.h"
+#include <gnuradio/blocks/file_sink.h>
+#include <string>
+
+/** \addtogroup Input_Filter
+ * \{ */
+/** \addtogroup Input_filter_adapters
+ * \{ */
+
+
+class ConfigurationInterface;
+
+/*!
+ * \brief Runs the pulse blanking and the notch filter in a single block.
+ * Equivalent to a Pulse_Blanking_Filter followed by a Notch_Filter, with the
+ * parameters blanking_pfa, notch_pfa and p_c_factor, and the length,
+ * segments_est and segments_reset shared by both.
+ */
+class InterferenceMitigationFilter : public GNSSBlockInterface
+{
+public:
+    InterferenceMitigationFilter(const ConfigurationInterface* configuration,
+        const std::string& role, unsigned int in_streams,
+        unsigned int out_streams);
+
+    ~InterferenceMitigationFilter() = default;
+
+    std::string role()
+    {
+        return role_;
+    }
+
+    //! Returns "Interference_Mitigation_Filter"
+    std::string implementation()
+    {
+        return "Interference_Mitigation_Filter";
+    }
+
+    size_t item_size()
+    {
+        return item_size_;
+    }
+
+    void connect(gr::top_block_sptr top_block);
+    void disconnect(gr::top_block_sptr top_block);
+    gr::basic_block_sptr get_left_block();
+    gr::basic_block_sptr get_right_block();
+
+private:
+    interference_mitigation_cc_sptr interference_mitigation_;
+    gr::blocks::file_sink::sptr file_sink_;
+    std::string dump_filename_;
+    std::string role_;
+    std::string item_type_;
+    size_t item_size_;
+    unsigned int in_streams_;
+    unsigned int out_streams_;
+    bool dump_;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_INTERFERENCE_MITIGATION_FILTER_H
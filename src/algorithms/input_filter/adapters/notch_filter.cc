@@ -17,6 +17,7 @@
 
 #include "notch_filter.h"
 #include "configuration_interface.h"
+#include "gnss_spectral_monitor.h"
 #include "notch_cc.h"
 #include <boost/lexical_cast.hpp>
 #include <glog/logging.h>
@@ -52,7 +53,7 @@ NotchFilter::NotchFilter(const ConfigurationInterface* configuration,
     if (item_type_ == "gr_complex")
         {
             item_size_ = sizeof(gr_complex);
-            notch_filter_ = make_notch_filter(pfa, p_c_factor, length_, n_segments_est, n_segments_reset);
+            notch_filter_ = make_notch_filter(pfa, p_c_factor, length_, n_segments_est, n_segments_reset, Gnss_Spectral_Monitor::rf_channel(role_));
             DLOG(INFO) << "Item size " << item_size_;
             DLOG(INFO) << "input filter(" << notch_filter_->unique_id() << ")";
         }
@@ -17,6 +17,7 @@
 
 #include "notch_filter_lite.h"
 #include "configuration_interface.h"
+#include "gnss_spectral_monitor.h"
 #include "notch_lite_cc.h"
 #include <boost/lexical_cast.hpp>
 #include <glog/logging.h>
@@ -59,7 +60,7 @@ NotchFilterLite::NotchFilterLite(const ConfigurationInterface* configuration,
     if (item_type_ == "gr_complex")
         {
             item_size_ = sizeof(gr_complex);
-            notch_filter_lite_ = make_notch_filter_lite(p_c_factor, pfa, length_, n_segments_est, n_segments_reset, n_segments_coeff);
+            notch_filter_lite_ = make_notch_filter_lite(p_c_factor, pfa, length_, n_segments_est, n_segments_reset, n_segments_coeff, Gnss_Spectral_Monitor::rf_channel(role_));
             DLOG(INFO) << "Item size " << item_size_;
             DLOG(INFO) << "input filter(" << notch_filter_lite_->unique_id() << ")";
         }
@@ -18,6 +18,7 @@
 
 #include "pulse_blanking_filter.h"
 #include "configuration_interface.h"
+#include "gnss_spectral_monitor.h"
 #include <boost/lexical_cast.hpp>
 #include <glog/logging.h>
 #include <gnuradio/filter/firdes.h>
@@ -58,7 +59,7 @@ PulseBlankingFilter::PulseBlankingFilter(const ConfigurationInterface* configura
         {
             item_size = sizeof(gr_complex);    // output
             input_size_ = sizeof(gr_complex);  // input
-            pulse_blanking_cc_ = make_pulse_blanking_cc(pfa, length_, n_segments_est, n_segments_reset);
+            pulse_blanking_cc_ = make_pulse_blanking_cc(pfa, length_, n_segments_est, n_segments_reset, Gnss_Spectral_Monitor::rf_channel(role_));
         }
     else
         {
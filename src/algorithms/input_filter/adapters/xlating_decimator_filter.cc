@@ -0,0 +1,159 @@
+/*!
+ * \file xlating_decimator_filter.cc
+ * \brief Adapts the xlating_decimator_cc block, a frequency translating and
+ * decimating FIR filter for one or several output bands, to a
+ * GNSSBlockInterface.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "xlating_decimator_filter.h"
+#include "configuration_interface.h"
+#include <glog/logging.h>
+#include <gnuradio/filter/firdes.h>
+#include <algorithm>  // for max
+#include <exception>
+#include <iostream>
+#include <utility>
+
+
+XlatingDecimatorFilter::XlatingDecimatorFilter(const ConfigurationInterface* configuration,
+    std::string role,
+    unsigned int in_streams,
+    unsigned int out_streams)
+    : role_(std::move(role)),
+      input_size_(0),
+      in_streams_(in_streams),
+      out_streams_(std::max(out_streams, 1U))
+{
+    const std::string default_item_type("gr_complex");
+    const std::string default_dump_filename("../data/input_filter.dat");
+    const std::string default_backend("auto");
+    const double default_intermediate_freq = 0.0;
+    const double default_sampling_freq = 4000000.0;
+    const int default_decimation_factor = 1;
+
+    item_type_ = configuration->property(role_ + ".item_type", default_item_type);
+    dump_filename_ = configuration->property(role_ + ".dump_filename", default_dump_filename);
+    dump_ = configuration->property(role_ + ".dump", false);
+    const double sampling_freq = configuration->property(role_ + ".sampling_frequency", default_sampling_freq);
+    const int decimation_factor = std::max(configuration->property(role_ + ".decimation_factor", default_decimation_factor), 1);
+    const std::string backend_name = configuration->property(role_ + ".backend", default_backend);
+    const auto fft_size = static_cast<size_t>(std::max(configuration->property(role_ + ".fft_size", 0), 0));
+
+    // Output k (from 1) is centered at output<k>_IF. .IF is the center of the first one
+    const double intermediate_freq = configuration->property(role_ + ".IF", default_intermediate_freq);
+    std::vector<double> center_freqs;
+    for (unsigned int k = 1; k <= out_streams_; k++)
+        {
+            const double output_if = configuration->property(role_ + ".output" + std::to_string(k) + "_IF", k == 1 ? intermediate_freq : default_intermediate_freq);
+            intermediate_freqs_.push_back(output_if);
+            center_freqs.push_back(output_if / sampling_freq);
+        }
+
+    // Low pass filter for the decimated rate, as Freq_Xlating_Fir_Filter with filter_type=lowpass
+    const double default_bw = (sampling_freq / decimation_factor) / 2;
+    const double bw = configuration->property(role_ + ".bw", default_bw);
+    const double default_tw = bw / 10.0;
+    const double tw = configuration->property(role_ + ".tw", default_tw);
+    const std::vector<float> taps = gr::filter::firdes::low_pass(1.0, sampling_freq, bw, tw);
+
+    Xlating_Decimator::Backend backend = Xlating_Decimator::Backend::AUTO;
+    if (backend_name == "polyphase")
+        {
+            backend = Xlating_Decimator::Backend::POLYPHASE;
+        }
+    else if (backend_name == "fft")
+        {
+            backend = Xlating_Decimator::Backend::FFT;
+        }
+    else if (backend_name != "auto")
+        {
+            LOG(WARNING) << role_ << ".backend=" << backend_name << " is not valid (auto, polyphase or fft), using auto";
+        }
+
+    DLOG(INFO) << "role " << role_;
+    if (item_type_ == "gr_complex")
+        {
+            try
+                {
+                    xlating_decimator_ = make_xlating_decimator_cc(taps, decimation_factor, center_freqs, backend, fft_size);
+                    input_size_ = sizeof(gr_complex);
+                    LOG(INFO) << "Created xlating_decimator with " << taps.size() << " taps, decimation factor " << decimation_factor
+                              << " and " << out_streams_ << " output(s), "
+                              << (xlating_decimator_->backend() == Xlating_Decimator::Backend::FFT ? "FFT size " + std::to_string(xlating_decimator_->fft_size()) : std::string("time-domain"));
+                    DLOG(INFO) << "input_filter(" << xlating_decimator_->unique_id() << ")";
+                }
+            catch (const std::exception& e)
+                {
+                    LOG(ERROR) << role_ << ": " << e.what();
+                    input_size_ = 0;  // notifies wrong configuration
+                }
+        }
+    else
+        {
+            LOG(ERROR) << " Unknown input filter input/output item type conversion";
+            input_size_ = 0;  // notifies wrong configuration
+        }
+
+    if (dump_ and xlating_decimator_ != nullptr)
+        {
+            // output k > 1 goes to <name>_<k><extension>
+            const size_t dot = dump_filename_.find_last_of('.');
+            const size_t slash = dump_filename_.find_last_of('/');
+            const bool has_extension = dot != std::string::npos and (slash == std::string::npos or dot > slash);
+            for (unsigned int k = 1; k <= out_streams_; k++)
+                {
+                    std::string filename = dump_filename_;
+                    if (k > 1)
+                        {
+                            filename = has_extension ? dump_filename_.substr(0, dot) + "_" + std::to_string(k) + dump_filename_.substr(dot) : dump_filename_ + "_" + std::to_string(k);
+                        }
+                    DLOG(INFO) << "Dumping output " << k << " into file " << filename;
+                    std::cout << "Dumping output into file " << filename << '\n';
+                    file_sinks_.push_back(gr::blocks::file_sink::make(sizeof(gr_complex), filename.c_str()));
+                }
+        }
+    if (in_streams_ > 1)
+        {
+            LOG(ERROR) << "This implementation only supports one input stream";
+        }
+}
+
+
+void XlatingDecimatorFilter::connect(gr::top_block_sptr top_block)
+{
+    for (size_t k = 0; k < file_sinks_.size(); k++)
+        {
+            top_block->connect(xlating_decimator_, static_cast<int>(k), file_sinks_[k], 0);
+        }
+}
+
+
+void XlatingDecimatorFilter::disconnect(gr::top_block_sptr top_block)
+{
+    for (size_t k = 0; k < file_sinks_.size(); k++)
+        {
+            top_block->disconnect(xlating_decimator_, static_cast<int>(k), file_sinks_[k], 0);
+        }
+}
+
+
+gr::basic_block_sptr XlatingDecimatorFilter::get_left_block()
+{
+    return xlating_decimator_;
+}
+
+
+gr::basic_block_sptr XlatingDecimatorFilter::get_right_block()
+{
+    return xlating_decimator_;
+}
@@ -0,0 +1,89 @@
+/*!
+ * \file xlating_decimator_filter.h
+ * \brief Adapts the xlating_decimator_cc block, a frequency translating and
+ * decimating FIR filter for one or several output bands, to a
+ * GNSSBlockInterface.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_XLATING_DECIMATOR_FILTER_H
+#define GNSS_SDR_XLATING_DECIMATOR_FILTER_H
+
+#include "gnss_block_interface.h"
+#include "xlating_decimator_cc.h"
+#include <gnuradio/blocks/file_sink.h>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/** \addtogroup Input_Filter
+ * \{ */
+/** \addtogroup Input_filter_adapters
+ * \{ */
+
+
+class ConfigurationInterface;
+
+/*!
+ * \brief Drop-in replacement of Freq_Xlating_Fir_Filter (with a low pass
+ * filter and gr_complex items) that chooses between a time-domain and an FFT
+ * overlap-save implementation. With out_streams > 1 it extracts several
+ * bands from the same input in one pass, output k being centered at
+ * role.output<k+1>_IF.
+ */
+class XlatingDecimatorFilter : public GNSSBlockInterface
+{
+public:
+    XlatingDecimatorFilter(const ConfigurationInterface* configuration,
+        std::string role, unsigned int in_streams,
+        unsigned int out_streams);
+
+    ~XlatingDecimatorFilter() = default;
+
+    inline std::string role() override
+    {
+        return role_;
+    }
+
+    //! Returns "Xlating_Decimator_Filter"
+    inline std::string implementation() override
+    {
+        return "Xlating_Decimator_Filter";
+    }
+
+    inline size_t item_size() override
+    {
+        return input_size_;
+    }
+
+    void connect(gr::top_block_sptr top_block) override;
+    void disconnect(gr::top_block_sptr top_block) override;
+    gr::basic_block_sptr get_left_block() override;
+    gr::basic_block_sptr get_right_block() override;
+
+private:
+    xlating_decimator_cc_sptr xlating_decimator_;
+    std::vector<gr::blocks::file_sink::sptr> file_sinks_;
+    std::vector<double> intermediate_freqs_;
+    std::string dump_filename_;
+    std::string item_type_;
+    std::string role_;
+    size_t input_size_;
+    unsigned int in_streams_;
+    unsigned int out_streams_;
+    bool dump_;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_XLATING_DECIMATOR_FILTER_H
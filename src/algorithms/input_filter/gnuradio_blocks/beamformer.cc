@@ -1,7 +1,7 @@
 /*!
  * \file beamformer.cc
  *
- * \brief Unpacks byte samples to NSR 2 bits samples
+ * \brief Simple spatial filter using RAW array input and beamforming coefficients
  * \author Javier Arribas jarribas (at) cttc.es
  * -----------------------------------------------------------------------------
  *
@@ -16,21 +16,191 @@
 
 
 #include "beamformer.h"
+#include <glog/logging.h>
 #include <gnuradio/io_signature.h>
-#include <cstddef>
+#include <pmt/pmt_sugar.h>  // for mp
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>  // for copy_n, max, min
+#include <exception>  // for exception
+#include <memory>     // for shared_ptr
+#include <utility>    // for swap
 
+#if HAS_GENERIC_LAMBDA
+#else
+#include <boost/bind/bind.hpp>
+#endif
 
-beamformer_sptr make_beamformer_sptr()
+#if PMT_USES_BOOST_ANY
+#include <boost/any.hpp>
+namespace wht = boost;
+#else
+#include <any>
+namespace wht = std;
+#endif
+
+
+namespace
+{
+std::vector<std::array<double, 3>> beamformer_element_positions(const Beamformer_Conf &conf)
 {
-    return beamformer_sptr(new beamformer());
+    std::vector<std::array<double, 3>> positions = conf.element_positions;
+    positions.resize(conf.elements, std::array<double, 3>{0.0, 0.0, 0.0});
+    return positions;
 }
+}  // namespace
 
 
-beamformer::beamformer()
+beamformer_sptr make_beamformer_sptr(const Beamformer_Conf &conf)
+{
+    return beamformer_sptr(new beamformer(conf));
+}
+
+
+beamformer::beamformer(const Beamformer_Conf &conf)
     : gr::sync_block("beamformer",
-          gr::io_signature::make(GNSS_SDR_BEAMFORMER_CHANNELS, GNSS_SDR_BEAMFORMER_CHANNELS, sizeof(gr_complex)),
-          gr::io_signature::make(1, 1, sizeof(gr_complex)))
+          gr::io_signature::make(conf.elements, conf.elements, sizeof(gr_complex)),
+          gr::io_signature::make(1, 1, sizeof(gr_complex))),
+      d_weights_calculator(beamformer_element_positions(conf), conf.diagonal_loading, conf.reference_element),
+      d_weights(conf.elements, gr_complex(1.0, 0.0)),
+      d_in(conf.elements),
+      d_snapshot_gap(conf.update_period_samples > conf.snapshots ? conf.update_period_samples - conf.snapshots : 0),
+      d_mode(conf.mode)
 {
+    std::copy_n(conf.weights.cbegin(), std::min(conf.weights.size(), d_weights.size()), d_weights.begin());
+
+    this->message_port_register_in(pmt::mp("pvt_to_beamformer"));
+    this->set_msg_handler(pmt::mp("pvt_to_beamformer"),
+#if HAS_GENERIC_LAMBDA
+        [this](auto &&PH1) { msg_handler_pvt_to_beamformer(PH1); });
+#else
+#if USE_BOOST_BIND_PLACEHOLDERS
+        boost::bind(&beamformer::msg_handler_pvt_to_beamformer, this, boost::placeholders::_1));
+#else
+        boost::bind(&beamformer::msg_handler_pvt_to_beamformer, this, _1));
+#endif
+#endif
+
+    if (d_mode != Beamformer_Conf::Weights_Mode::FIXED)
+        {
+            d_snapshots = std::vector<std::vector<gr_complex>>(conf.elements, std::vector<gr_complex>(std::max(conf.snapshots, static_cast<std::size_t>(1))));
+            d_worker_snapshots = d_snapshots;
+            d_thread = std::thread(&beamformer::run, this);
+        }
+}
+
+
+beamformer::~beamformer()
+{
+    if (d_thread.joinable())
+        {
+            {
+                std::lock_guard<std::mutex> lock(d_mutex);
+                d_stop = true;
+            }
+            d_cond.notify_one();
+            d_thread.join();
+        }
+}
+
+
+void beamformer::msg_handler_pvt_to_beamformer(const pmt::pmt_t &msg)
+{
+    try
+        {
+            const auto steering = wht::any_cast<std::shared_ptr<Beamformer_Steering>>(pmt::any_ref(msg));
+            std::lock_guard<std::mutex> lock(d_mutex);
+            d_directions = steering->directions;
+        }
+    catch (const wht::bad_any_cast &e)
+        {
+            LOG(WARNING) << "msg_handler_pvt_to_beamformer Bad any_cast: " << e.what();
+        }
+    catch (const std::exception &ex)
+        {
+            LOG(WARNING) << "msg_handler_pvt_to_beamformer Bad any_cast: " << ex.what();
+        }
+}
+
+
+void beamformer::run()
+{
+    std::vector<const gr_complex *> snapshots(d_worker_snapshots.size());
+    std::vector<gr_complex> weights;
+    std::vector<Beamformer_Steering::Direction> directions;
+    std::unique_lock<std::mutex> lock(d_mutex);
+    while (true)
+        {
+            d_cond.wait(lock, [this] { return d_stop or d_snapshots_ready; });
+            if (d_stop)
+                {
+                    break;
+                }
+            directions = d_directions;
+            for (std::size_t k = 0; k < snapshots.size(); k++)
+                {
+                    snapshots[k] = d_worker_snapshots[k].data();
+                }
+
+            // work() does not touch the snapshots until d_snapshots_ready is
+            // cleared, so they are read here without holding the lock
+            lock.unlock();
+            bool computed = false;
+            if (d_mode == Beamformer_Conf::Weights_Mode::STEERED and !directions.empty())
+                {
+                    computed = d_weights_calculator.steered(snapshots.data(), d_worker_snapshots[0].size(), directions, weights);
+                }
+            else
+                {
+                    computed = d_weights_calculator.power_inversion(snapshots.data(), d_worker_snapshots[0].size(), weights);
+                }
+            lock.lock();
+
+            if (computed)
+                {
+                    d_new_weights = weights;
+                    d_new_weights_available.store(true, std::memory_order_release);
+                }
+            d_snapshots_ready = false;
+        }
+}
+
+
+void beamformer::take_snapshots(const gr_vector_const_void_star &input_items, int noutput_items)
+{
+    const std::size_t snapshot_length = d_snapshots[0].size();
+    auto n = static_cast<std::size_t>(noutput_items);
+    std::size_t first = 0;
+    while (first < n)
+        {
+            if (d_samples_to_snapshot > 0)
+                {
+                    const auto skipped = static_cast<std::size_t>(std::min(d_samples_to_snapshot, static_cast<uint64_t>(n - first)));
+                    d_samples_to_snapshot -= skipped;
+                    first += skipped;
+                    continue;
+                }
+            const std::size_t copied = std::min(snapshot_length - d_snapshot_fill, n - first);
+            for (std::size_t k = 0; k < d_snapshots.size(); k++)
+                {
+                    std::copy_n(reinterpret_cast<const gr_complex *>(input_items[k]) + first, copied, d_snapshots[k].begin() + d_snapshot_fill);
+                }
+            d_snapshot_fill += copied;
+            first += copied;
+            if (d_snapshot_fill == snapshot_length)
+                {
+                    // If the weights thread is still busy, this block of
+                    // snapshots is dropped
+                    std::unique_lock<std::mutex> lock(d_mutex, std::try_to_lock);
+                    if (lock.owns_lock() and !d_snapshots_ready)
+                        {
+                            std::swap(d_snapshots, d_worker_snapshots);
+                            d_snapshots_ready = true;
+                            d_cond.notify_one();
+                        }
+                    d_snapshot_fill = 0;
+                    d_samples_to_snapshot = d_snapshot_gap;
+                }
+        }
 }
 
 
@@ -38,28 +208,23 @@ int beamformer::work(int noutput_items, gr_vector_const_void_star &input_items,
     gr_vector_void_star &output_items)
 {
     auto *out = reinterpret_cast<gr_complex *>(output_items[0]);
-    // channel output buffers
-    //  gr_complex *ch1 = (gr_complex *) input_items[0];
-    //  gr_complex *ch2 = (gr_complex *) input_items[1];
-    //  gr_complex *ch3 = (gr_complex *) input_items[2];
-    //  gr_complex *ch4 = (gr_complex *) input_items[3];
-    //  gr_complex *ch5 = (gr_complex *) input_items[4];
-    //  gr_complex *ch6 = (gr_complex *) input_items[5];
-    //  gr_complex *ch7 = (gr_complex *) input_items[6];
-    //  gr_complex *ch8 = (gr_complex *) input_items[7];
-
-    // NON-VOLK beamforming operation
-    // TODO: Implement VOLK SIMD-accelerated beamformer!
-    gr_complex sum;
-    for (int n = 0; n < noutput_items; n++)
+
+    if (d_new_weights_available.load(std::memory_order_acquire))
         {
-            sum = gr_complex(0, 0);
-            for (size_t i = 0; i < weight_vector.size(); i++)
-                {
-                    sum = sum + (reinterpret_cast<const gr_complex *>(input_items[i]))[n] * weight_vector[i];
-                }
-            out[n] = sum;
+            std::lock_guard<std::mutex> lock(d_mutex);
+            std::copy_n(d_new_weights.cbegin(), std::min(d_new_weights.size(), d_weights.size()), d_weights.begin());
+            d_new_weights_available.store(false, std::memory_order_relaxed);
+        }
+    if (!d_snapshots.empty())
+        {
+            take_snapshots(input_items, noutput_items);
+        }
+
+    for (std::size_t i = 0; i < d_in.size(); i++)
+        {
+            d_in[i] = reinterpret_cast<const gr_complex *>(input_items[i]);
         }
+    volk_gnsssdr_32fc_xn_weighted_sum_32fc(out, d_in.data(), d_weights.data(), static_cast<int>(d_in.size()), noutput_items);
 
     return noutput_items;
 }
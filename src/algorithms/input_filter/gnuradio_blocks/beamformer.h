@@ -18,8 +18,19 @@
 #ifndef GNSS_SDR_BEAMFORMER_H
 #define GNSS_SDR_BEAMFORMER_H
 
+#include "beamformer_steering.h"
+#include "beamformer_weights.h"
 #include "gnss_block_interface.h"
 #include <gnuradio/sync_block.h>
+#include <pmt/pmt.h>
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 /** \addtogroup Input_Filter
@@ -28,28 +39,86 @@
  * \{ */
 
 
+const int GNSS_SDR_BEAMFORMER_CHANNELS = 8;
+
+/*!
+ * \brief Parameters of the beamformer
+ */
+class Beamformer_Conf
+{
+public:
+    enum class Weights_Mode
+    {
+        FIXED,            //!< the weights below
+        POWER_INVERSION,  //!< adaptive, unit gain of the reference element
+        STEERED           //!< adaptive, unit gain towards the satellites reported by the PVT
+    };
+
+    int elements = GNSS_SDR_BEAMFORMER_CHANNELS;
+    std::vector<gr_complex> weights;  //!< fixed or initial weights, all ones if empty
+    std::vector<std::array<double, 3>> element_positions;  //!< East, North, Up, in carrier wavelengths
+    Weights_Mode mode = Weights_Mode::FIXED;
+    uint64_t update_period_samples = 4000000;  //!< samples between the starts of two weight updates
+    std::size_t snapshots = 1024;  //!< consecutive samples to estimate the covariance matrix
+    double diagonal_loading = 1e-3;
+    int reference_element = 0;
+};
+
+
 class beamformer;
 
 using beamformer_sptr = gnss_shared_ptr<beamformer>;
 
-beamformer_sptr make_beamformer_sptr();
-
-const int GNSS_SDR_BEAMFORMER_CHANNELS = 8;
+beamformer_sptr make_beamformer_sptr(const Beamformer_Conf& conf = Beamformer_Conf());
 
 /*!
  * \brief This class implements a real-time software-defined spatial filter using the CTTC GNSS experimental antenna array input and a set of dynamically reloadable weights
+ *
+ * With adaptive weights, work() copies a block of snapshots of the inputs
+ * every update period, and a background thread computes the new weights from
+ * them (see Beamformer_Weights), which work() picks up at the start of a
+ * later call. The signal path never waits for the weight computation: the
+ * snapshots taken while the previous ones are being processed are dropped.
+ *
+ * The steered weights use the directions of the satellites received in the
+ * "pvt_to_beamformer" message port, and power inversion until the first
+ * directions arrive.
  */
 class beamformer : public gr::sync_block
 {
 public:
-    ~beamformer() = default;
+    ~beamformer();
     int work(int noutput_items, gr_vector_const_void_star &input_items,
         gr_vector_void_star &output_items);
 
 private:
-    friend beamformer_sptr make_beamformer_sptr();
-    beamformer();
-    std::vector<gr_complex> weight_vector = std::vector<gr_complex>(GNSS_SDR_BEAMFORMER_CHANNELS, gr_complex(1.0, 0.0));
+    friend beamformer_sptr make_beamformer_sptr(const Beamformer_Conf& conf);
+    explicit beamformer(const Beamformer_Conf& conf);
+
+    void msg_handler_pvt_to_beamformer(const pmt::pmt_t &msg);
+    void take_snapshots(const gr_vector_const_void_star &input_items, int noutput_items);
+    void run();
+
+    Beamformer_Weights d_weights_calculator;
+    volk_gnsssdr::vector<gr_complex> d_weights;
+    std::vector<const gr_complex *> d_in;
+
+    // shared with the weights thread, protected by d_mutex
+    std::vector<gr_complex> d_new_weights;
+    std::vector<std::vector<gr_complex>> d_worker_snapshots;
+    std::vector<Beamformer_Steering::Direction> d_directions;
+    bool d_snapshots_ready{false};
+    bool d_stop{false};
+    std::mutex d_mutex;
+    std::condition_variable d_cond;
+    std::atomic<bool> d_new_weights_available{false};
+
+    std::vector<std::vector<gr_complex>> d_snapshots;  // being filled by work()
+    std::size_t d_snapshot_fill{0};
+    uint64_t d_samples_to_snapshot{0};
+    uint64_t d_snapshot_gap;
+    Beamformer_Conf::Weights_Mode d_mode;
+    std::thread d_thread;
 };
 
 
@@ -0,0 +1,260 @@
+/*!
+ * \file beamformer_weights.cc
+ * \brief Adaptive weights of an antenna array beamformer: power inversion,
+ * and minimum variance with unit gain towards the satellites in view.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "beamformer_weights.h"
+#include "MATH_CONSTANTS.h"
+#include <algorithm>  // for min
+#include <cmath>      // for cos, sin, sqrt
+#include <stdexcept>  // for invalid_argument
+
+
+namespace
+{
+/*
+ * Solves A X = B for a Hermitian positive definite n x n matrix A and the m
+ * columns of B, both row-major. A is overwritten by its Cholesky factor and B
+ * by the solution. Returns false if A is not positive definite.
+ */
+bool beamformer_cholesky_solve(std::vector<std::complex<double>>& A, std::size_t n, std::vector<std::complex<double>>& B, std::size_t m)
+{
+    // A = L L^H, with L stored in the lower triangle of A
+    for (std::size_t j = 0; j < n; j++)
+        {
+            double diagonal = A[j * n + j].real();
+            for (std::size_t k = 0; k < j; k++)
+                {
+                    diagonal -= std::norm(A[j * n + k]);
+                }
+            if (!(diagonal > 0.0))
+                {
+                    return false;
+                }
+            diagonal = std::sqrt(diagonal);
+            A[j * n + j] = diagonal;
+            for (std::size_t i = j + 1; i < n; i++)
+                {
+                    std::complex<double> sum = A[i * n + j];
+                    for (std::size_t k = 0; k < j; k++)
+                        {
+                            sum -= A[i * n + k] * std::conj(A[j * n + k]);
+                        }
+                    A[i * n + j] = sum / diagonal;
+                }
+        }
+
+    for (std::size_t c = 0; c < m; c++)
+        {
+            // L y = b
+            for (std::size_t i = 0; i < n; i++)
+                {
+                    std::complex<double> sum = B[i * m + c];
+                    for (std::size_t k = 0; k < i; k++)
+                        {
+                            sum -= A[i * n + k] * B[k * m + c];
+                        }
+                    B[i * m + c] = sum / A[i * n + i].real();
+                }
+            // L^H x = y
+            for (std::size_t i = n; i-- > 0;)
+                {
+                    std::complex<double> sum = B[i * m + c];
+                    for (std::size_t k = i + 1; k < n; k++)
+                        {
+                            sum -= std::conj(A[k * n + i]) * B[k * m + c];
+                        }
+                    B[i * m + c] = sum / A[i * n + i].real();
+                }
+        }
+    return true;
+}
+}  // namespace
+
+
+Beamformer_Weights::Beamformer_Weights(const std::vector<std::array<double, 3>>& element_positions,
+    double diagonal_loading,
+    int reference_element)
+    : d_element_positions(element_positions),
+      d_diagonal_loading(diagonal_loading),
+      d_reference_element(reference_element)
+{
+    if (d_element_positions.empty())
+        {
+            throw std::invalid_argument("Beamformer_Weights: no array elements");
+        }
+    if (d_reference_element < 0 or d_reference_element >= elements())
+        {
+            throw std::invalid_argument("Beamformer_Weights: invalid reference element");
+        }
+}
+
+
+int Beamformer_Weights::elements() const
+{
+    return static_cast<int>(d_element_positions.size());
+}
+
+
+std::vector<std::complex<double>> Beamformer_Weights::steering_vector(double azimuth_rad, double elevation_rad) const
+{
+    // unit vector towards the source, East-North-Up
+    const double east = std::cos(elevation_rad) * std::sin(azimuth_rad);
+    const double north = std::cos(elevation_rad) * std::cos(azimuth_rad);
+    const double up = std::sin(elevation_rad);
+    std::vector<std::complex<double>> steering(d_element_positions.size());
+    for (std::size_t k = 0; k < d_element_positions.size(); k++)
+        {
+            // the elements closer to the source receive the wavefront earlier
+            const double path = d_element_positions[k][0] * east + d_element_positions[k][1] * north + d_element_positions[k][2] * up;
+            steering[k] = std::polar(1.0, TWO_PI * path);
+        }
+    return steering;
+}
+
+
+std::vector<std::complex<double>> Beamformer_Weights::covariance(const gr_complex* const* snapshots, std::size_t n_snapshots) const
+{
+    const std::size_t n = d_element_positions.size();
+    std::vector<std::complex<double>> R(n * n, std::complex<double>(0.0, 0.0));
+    for (std::size_t i = 0; i < n; i++)
+        {
+            for (std::size_t j = 0; j <= i; j++)
+                {
+                    std::complex<double> sum(0.0, 0.0);
+                    for (std::size_t t = 0; t < n_snapshots; t++)
+                        {
+                            sum += std::complex<double>(snapshots[i][t]) * std::conj(std::complex<double>(snapshots[j][t]));
+                        }
+                    R[i * n + j] = sum / static_cast<double>(n_snapshots);
+                    R[j * n + i] = std::conj(R[i * n + j]);
+                }
+        }
+    double trace = 0.0;
+    for (std::size_t i = 0; i < n; i++)
+        {
+            trace += R[i * n + i].real();
+        }
+    for (std::size_t i = 0; i < n; i++)
+        {
+            R[i * n + i] += d_diagonal_loading * trace / static_cast<double>(n);
+        }
+    return R;
+}
+
+
+bool Beamformer_Weights::constrained(const gr_complex* const* snapshots, std::size_t n_snapshots,
+    const std::vector<std::vector<std::complex<double>>>& constraints, std::vector<gr_complex>& weights) const
+{
+    const std::size_t n = d_element_positions.size();
+    const std::size_t m = constraints.size();
+    if (n_snapshots == 0 or m == 0)
+        {
+            return false;
+        }
+
+    // V = R^-1 C, being the constraints the columns of C
+    std::vector<std::complex<double>> R = covariance(snapshots, n_snapshots);
+    std::vector<std::complex<double>> V(n * m);
+    for (std::size_t i = 0; i < n; i++)
+        {
+            for (std::size_t c = 0; c < m; c++)
+                {
+                    V[i * m + c] = constraints[c][i];
+                }
+        }
+    if (!beamformer_cholesky_solve(R, n, V, m))
+        {
+            return false;
+        }
+
+    // g = (C^H R^-1 C)^-1 f, with unit gains f
+    std::vector<std::complex<double>> G(m * m, std::complex<double>(0.0, 0.0));
+    for (std::size_t r = 0; r < m; r++)
+        {
+            for (std::size_t c = 0; c < m; c++)
+                {
+                    for (std::size_t i = 0; i < n; i++)
+                        {
+                            G[r * m + c] += std::conj(constraints[r][i]) * V[i * m + c];
+                        }
+                }
+        }
+    // with a slight loading, in case two directions are too close
+    double trace = 0.0;
+    for (std::size_t r = 0; r < m; r++)
+        {
+            trace += G[r * m + r].real();
+        }
+    for (std::size_t r = 0; r < m; r++)
+        {
+            G[r * m + r] += 1e-9 * trace / static_cast<double>(m);
+        }
+    std::vector<std::complex<double>> g(m, std::complex<double>(1.0, 0.0));
+    if (!beamformer_cholesky_solve(G, m, g, 1))
+        {
+            return false;
+        }
+
+    // The output is w^H x, with w = V g
+    weights.resize(n);
+    for (std::size_t i = 0; i < n; i++)
+        {
+            std::complex<double> w(0.0, 0.0);
+            for (std::size_t c = 0; c < m; c++)
+                {
+                    w += V[i * m + c] * g[c];
+                }
+            weights[i] = gr_complex(static_cast<float>(w.real()), static_cast<float>(-w.imag()));
+        }
+    return true;
+}
+
+
+bool Beamformer_Weights::power_inversion(const gr_complex* const* snapshots, std::size_t n_snapshots, std::vector<gr_complex>& weights) const
+{
+    std::vector<std::complex<double>> reference(d_element_positions.size(), std::complex<double>(0.0, 0.0));
+    reference[d_reference_element] = 1.0;
+    return constrained(snapshots, n_snapshots, {reference}, weights);
+}
+
+
+bool Beamformer_Weights::steered(const gr_complex* const* snapshots, std::size_t n_snapshots,
+    const std::vector<Beamformer_Steering::Direction>& directions, std::vector<gr_complex>& weights) const
+{
+    const std::size_t n_constraints = std::min(directions.size(), d_element_positions.size() - 1);
+    if (n_constraints == 0)
+        {
+            return power_inversion(snapshots, n_snapshots, weights);
+        }
+    std::vector<std::vector<std::complex<double>>> constraints;
+    constraints.reserve(n_constraints);
+    for (std::size_t k = 0; k < n_constraints; k++)
+        {
+            constraints.push_back(steering_vector(directions[k].azimuth_rad, directions[k].elevation_rad));
+        }
+    return constrained(snapshots, n_snapshots, constraints, weights);
+}
+
+
+gr_complex Beamformer_Weights::response(const std::vector<gr_complex>& weights, double azimuth_rad, double elevation_rad) const
+{
+    const std::vector<std::complex<double>> steering = steering_vector(azimuth_rad, elevation_rad);
+    std::complex<double> sum(0.0, 0.0);
+    for (std::size_t k = 0; k < std::min(weights.size(), steering.size()); k++)
+        {
+            sum += std::complex<double>(weights[k]) * steering[k];
+        }
+    return gr_complex(static_cast<float>(sum.real()), static_cast<float>(sum.imag()));
+}
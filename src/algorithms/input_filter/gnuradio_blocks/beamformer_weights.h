@@ -0,0 +1,92 @@
+/*!
+ * \file beamformer_weights.h
+ * \brief Adaptive weights of an antenna array beamformer: power inversion,
+ * and minimum variance with unit gain towards the satellites in view.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_BEAMFORMER_WEIGHTS_H
+#define GNSS_SDR_BEAMFORMER_WEIGHTS_H
+
+#include "beamformer_steering.h"
+#include <gnuradio/gr_complex.h>
+#include <array>
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+/** \addtogroup Input_Filter
+ * \{ */
+/** \addtogroup Input_filter_gnuradio_blocks
+ * \{ */
+
+
+/*!
+ * \brief Computes the weights of the array elements from a block of
+ * snapshots of their signals. The beamformer output is the sum of the
+ * element signals multiplied by the weights.
+ *
+ * The weights minimize the output power, so that the interference, much
+ * stronger than the GNSS signals below the noise floor, is nulled, subject to
+ * - power inversion: unit gain of the reference element.
+ * - steered: unit gain towards each of the given directions (a linearly
+ * constrained minimum variance beamformer, the MVDR beamformer for a single
+ * direction). At most elements() - 1 directions are constrained, the highest
+ * ones, so that the array keeps a degree of freedom to null the interference.
+ *
+ * The covariance matrix is loaded with diagonal_loading times its mean
+ * diagonal, which keeps the solution stable with few snapshots and limits
+ * the depth of the nulls on the noise.
+ */
+class Beamformer_Weights
+{
+public:
+    /*!
+     * \brief element_positions are the East, North and Up coordinates of the
+     * phase center of each element, in carrier wavelengths. Only needed for
+     * the steered weights.
+     */
+    Beamformer_Weights(const std::vector<std::array<double, 3>>& element_positions,
+        double diagonal_loading = 1e-3,
+        int reference_element = 0);
+
+    int elements() const;
+
+    //! Phase of a plane wave from the given direction at each element
+    std::vector<std::complex<double>> steering_vector(double azimuth_rad, double elevation_rad) const;
+
+    /*!
+     * \brief snapshots[k] points to n_snapshots samples of the element k.
+     * Returns false, leaving the weights untouched, if the covariance matrix
+     * is singular.
+     */
+    bool power_inversion(const gr_complex* const* snapshots, std::size_t n_snapshots, std::vector<gr_complex>& weights) const;
+    bool steered(const gr_complex* const* snapshots, std::size_t n_snapshots,
+        const std::vector<Beamformer_Steering::Direction>& directions, std::vector<gr_complex>& weights) const;
+
+    //! Gain of the beamformer with the given weights towards a direction
+    gr_complex response(const std::vector<gr_complex>& weights, double azimuth_rad, double elevation_rad) const;
+
+private:
+    std::vector<std::complex<double>> covariance(const gr_complex* const* snapshots, std::size_t n_snapshots) const;
+    bool constrained(const gr_complex* const* snapshots, std::size_t n_snapshots,
+        const std::vector<std::vector<std::complex<double>>>& constraints, std::vector<gr_complex>& weights) const;
+
+    std::vector<std::array<double, 3>> d_element_positions;
+    double d_diagonal_loading;
+    int d_reference_element;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_BEAMFORMER_WEIGHTS_H
@@ -0,0 +1,304 @@
+/*!
+ * \file interference_mitigation.cc
+ * \brief Segment by segment pulse blanking and notch filtering with
+ * preallocated buffers, shared by the pulse blanking, notch and interference
+ * mitigation blocks.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "interference_mitigation.h"
+#include "gnss_capture_trigger.h"
+#include "gnss_spectral_monitor.h"
+#include <boost/math/distributions/chi_squared.hpp>
+#include <volk/volk.h>
+#include <algorithm>  // for copy_n, fill_n
+#include <cmath>      // for log10, pow
+#include <cstring>    // for memcpy
+#include <utility>    // for move
+
+
+namespace
+{
+// Threshold of the segment energy, normalized by the noise power, for the given probability of false alarm
+float interference_mitigation_threshold(float pfa, int32_t n_deg_fred)
+{
+    boost::math::chi_squared_distribution<float> my_dist_(static_cast<float>(n_deg_fred));
+    return boost::math::quantile(boost::math::complement(my_dist_, pfa));
+}
+
+
+// The onset of an interference may trigger a capture of the last samples
+void interference_mitigation_onset()
+{
+    const std::shared_ptr<Gnss_Capture_Trigger> trigger = Gnss_Capture_Trigger::global_instance();
+    if (trigger != nullptr)
+        {
+            trigger->fire("interference");
+        }
+}
+
+
+// Noise power per degree of freedom of the segment energy (half the power of
+// the complex samples), from the noise floor or the total power of the last
+// estimate of the monitor. Returns false if there is no estimate yet
+bool interference_mitigation_monitored_power(const Gnss_Spectral_Monitor& monitor, bool noise_floor, uint64_t& sequence, float& noise_power)
+{
+    const uint64_t last_sequence = monitor.sequence();
+    if (last_sequence == 0)
+        {
+            return false;
+        }
+    if (last_sequence != sequence)
+        {
+            sequence = last_sequence;
+            noise_power = (noise_floor ? monitor.noise_variance() : monitor.total_power()) / 2.0F;
+        }
+    return true;
+}
+}  // namespace
+
+
+float interference_mitigation_energy(const gr_complex* in, int32_t length)
+{
+    // |x|^2 summed over the interleaved real and imaginary parts, without an intermediate buffer
+    float energy = 0.0;
+    const auto* in_float = reinterpret_cast<const float*>(in);
+    volk_32f_x2_dot_prod_32f(&energy, in_float, in_float, 2 * static_cast<unsigned int>(length));
+    return energy;
+}
+
+
+Pulse_Blanker::Pulse_Blanker(float pfa,
+    int32_t length,
+    int32_t n_segments_est,
+    int32_t n_segments_reset)
+    : d_thres(interference_mitigation_threshold(pfa, 2 * length)),
+      d_length(length),
+      d_n_segments_est(n_segments_est),
+      d_n_segments_reset(n_segments_reset),
+      d_n_deg_fred(2 * length)
+{
+}
+
+
+int32_t Pulse_Blanker::length() const
+{
+    return d_length;
+}
+
+
+void Pulse_Blanker::set_spectral_monitor(std::shared_ptr<const Gnss_Spectral_Monitor> monitor)
+{
+    d_monitor = std::move(monitor);
+    d_monitor_sequence = 0;
+}
+
+
+bool Pulse_Blanker::process(const gr_complex* in, gr_complex* out)
+{
+    const bool monitored = d_monitor != nullptr;
+    if (monitored and !interference_mitigation_monitored_power(*d_monitor, false, d_monitor_sequence, d_noise_power_estimation))
+        {
+            if (out != in)
+                {
+                    std::copy_n(in, d_length, out);
+                }
+            return false;
+        }
+    const float segment_energy = interference_mitigation_energy(in, d_length);
+    bool blanked = false;
+    if (!monitored && (d_n_segments < d_n_segments_est) && (d_last_filtered == false))
+        {
+            d_noise_power_estimation = (static_cast<float>(d_n_segments) * d_noise_power_estimation + segment_energy / static_cast<float>(d_n_deg_fred)) / static_cast<float>(d_n_segments + 1);
+        }
+    else
+        {
+            if ((segment_energy / d_noise_power_estimation) > d_thres)
+                {
+                    if (d_last_filtered == false)
+                        {
+                            interference_mitigation_onset();
+                        }
+                    blanked = true;
+                    d_last_filtered = true;
+                }
+            else
+                {
+                    d_last_filtered = false;
+                    if (d_n_segments > d_n_segments_reset)
+                        {
+                            d_n_segments = 0;
+                        }
+                }
+        }
+    d_n_segments++;
+
+    if (blanked)
+        {
+            std::fill_n(out, d_length, gr_complex(0.0, 0.0));
+        }
+    else if (out != in)
+        {
+            std::copy_n(in, d_length, out);
+        }
+    return blanked;
+}
+
+
+Notch_Canceller::Notch_Canceller(float pfa,
+    float p_c_factor,
+    int32_t length,
+    int32_t n_segments_est,
+    int32_t n_segments_reset)
+    : d_fft(gnss_fft_fwd_make_unique(length)),
+      d_z_0(length),
+      d_magnitude(length),
+      d_power_spect(length),
+      d_power_acc(length),
+      d_p_c_factor(p_c_factor),
+      d_thres(interference_mitigation_threshold(pfa, 2 * length)),
+      d_length(length),
+      d_n_deg_fred(2 * length),
+      d_n_segments_est(n_segments_est),
+      d_n_segments_reset(n_segments_reset)
+{
+}
+
+
+int32_t Notch_Canceller::length() const
+{
+    return d_length;
+}
+
+
+void Notch_Canceller::set_spectral_monitor(std::shared_ptr<const Gnss_Spectral_Monitor> monitor)
+{
+    d_monitor = std::move(monitor);
+    d_monitor_sequence = 0;
+}
+
+
+void Notch_Canceller::reset_history()
+{
+    d_last_in = gr_complex(0.0, 0.0);
+    d_last_out = gr_complex(0.0, 0.0);
+}
+
+
+void Notch_Canceller::accumulate_spectrum(const gr_complex* in)
+{
+    if (d_n_segments == 0)
+        {
+            d_n_accumulated = 0;
+        }
+    memcpy(d_fft->get_inbuf(), in, sizeof(gr_complex) * d_length);
+    d_fft->execute();
+    if (d_n_accumulated == 0)
+        {
+            volk_32fc_magnitude_squared_32f(d_power_acc.data(), d_fft->get_outbuf(), d_length);
+        }
+    else
+        {
+            volk_32fc_magnitude_squared_32f(d_power_spect.data(), d_fft->get_outbuf(), d_length);
+            volk_32f_x2_add_32f(d_power_acc.data(), d_power_acc.data(), d_power_spect.data(), d_length);
+        }
+    d_n_accumulated++;
+}
+
+
+void Notch_Canceller::estimate_noise_floor()
+{
+    // average power spectrum, in dB, of the estimation segments
+    const float scale = 1.0F / static_cast<float>(d_n_accumulated);
+    for (int32_t k = 0; k < d_length; k++)
+        {
+            d_power_spect[k] = 10.0F * std::log10(d_power_acc[k] * scale + 1e-20F);
+        }
+    float sig2dB = 0.0;
+    volk_32f_s32f_calc_spectral_noise_floor_32f(&sig2dB, d_power_spect.data(), 15.0, d_length);
+    d_noise_pow_est = std::pow(10.0F, (sig2dB / 10.0F)) / (static_cast<float>(d_n_deg_fred));
+}
+
+
+bool Notch_Canceller::process(const gr_complex* in, gr_complex* out)
+{
+    const bool monitored = d_monitor != nullptr;
+    if (monitored and !interference_mitigation_monitored_power(*d_monitor, true, d_monitor_sequence, d_noise_pow_est))
+        {
+            d_last_in = in[d_length - 1];
+            if (out != in)
+                {
+                    std::copy_n(in, d_length, out);
+                }
+            return false;
+        }
+    bool filtered = false;
+    if (!monitored && (d_n_segments < d_n_segments_est) && (d_filter_state == false))
+        {
+            accumulate_spectrum(in);
+            if (d_n_segments + 1 == d_n_segments_est)
+                {
+                    estimate_noise_floor();
+                }
+        }
+    else
+        {
+            const float segment_energy = interference_mitigation_energy(in, d_length);
+            if ((segment_energy / d_noise_pow_est) > d_thres)
+                {
+                    if (d_filter_state == false)
+                        {
+                            d_filter_state = true;
+                            d_last_out = gr_complex(0.0, 0.0);
+                            interference_mitigation_onset();
+                        }
+                    filtered = true;
+                }
+            else
+                {
+                    if (d_n_segments > d_n_segments_reset)
+                        {
+                            d_n_segments = 0;
+                        }
+                    d_filter_state = false;
+                }
+        }
+    d_n_segments++;
+
+    if (!filtered)
+        {
+            d_last_in = in[d_length - 1];
+            if (out != in)
+                {
+                    std::copy_n(in, d_length, out);
+                }
+            return false;
+        }
+
+    // in[n] conj(in[n-1]), and its magnitude to normalize it
+    d_z_0[0] = in[0] * std::conj(d_last_in);
+    volk_32fc_x2_multiply_conjugate_32fc(d_z_0.data() + 1, in + 1, in, d_length - 1);
+    volk_32fc_magnitude_32f(d_magnitude.data(), d_z_0.data(), d_length);
+    gr_complex previous_in = d_last_in;
+    gr_complex last_out = d_last_out;
+    for (int32_t n = 0; n < d_length; n++)
+        {
+            const gr_complex current_in = in[n];
+            const gr_complex z_0 = d_magnitude[n] > 0.0F ? d_z_0[n] / d_magnitude[n] : gr_complex(1.0, 0.0);
+            last_out = current_in + z_0 * (d_p_c_factor * last_out - previous_in);
+            out[n] = last_out;
+            previous_in = current_in;
+        }
+    d_last_in = previous_in;
+    d_last_out = last_out;
+    return true;
+}
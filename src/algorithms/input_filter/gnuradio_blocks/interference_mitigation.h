@@ -0,0 +1,141 @@
+/*!
+ * \file interference_mitigation.h
+ * \brief Segment by segment pulse blanking and notch filtering with
+ * preallocated buffers, shared by the pulse blanking, notch and interference
+ * mitigation blocks.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_INTERFERENCE_MITIGATION_H
+#define GNSS_SDR_INTERFERENCE_MITIGATION_H
+
+#include "gnss_sdr_fft.h"
+#include <gnuradio/gr_complex.h>
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <cstdint>
+#include <memory>
+
+/** \addtogroup Input_Filter
+ * \{ */
+/** \addtogroup Input_filter_gnuradio_blocks
+ * \{ */
+
+
+class Gnss_Spectral_Monitor;
+
+
+//! Energy of a segment of samples, in a single pass over them
+float interference_mitigation_energy(const gr_complex* in, int32_t length);
+
+
+/*!
+ * \brief Zeroes the segments of length samples whose energy exceeds the
+ * noise power estimated in the first n_segments_est segments with the given
+ * probability of false alarm. The estimation is restarted after
+ * n_segments_reset segments, at the end of a pulse.
+ *
+ * With a Gnss_Spectral_Monitor of the RF channel, the noise power is the
+ * total power of its last estimate instead, and the samples go through
+ * unchanged until its first estimate.
+ */
+class Pulse_Blanker
+{
+public:
+    Pulse_Blanker(float pfa, int32_t length, int32_t n_segments_est, int32_t n_segments_reset);
+
+    int32_t length() const;
+
+    //! Takes the noise power from the estimates of monitor, or from the samples if it is null
+    void set_spectral_monitor(std::shared_ptr<const Gnss_Spectral_Monitor> monitor);
+
+    //! Processes length() samples, in and out can be the same. Returns true if they were zeroed
+    bool process(const gr_complex* in, gr_complex* out);
+
+private:
+    std::shared_ptr<const Gnss_Spectral_Monitor> d_monitor;
+    uint64_t d_monitor_sequence{0};
+    float d_noise_power_estimation{0.0};
+    float d_thres;
+    int32_t d_length;
+    int32_t d_n_segments{0};
+    int32_t d_n_segments_est;
+    int32_t d_n_segments_reset;
+    int32_t d_n_deg_fred;
+    bool d_last_filtered{false};
+};
+
+
+/*!
+ * \brief Multi state notch filter. The noise floor is estimated from the
+ * power spectrum of the first n_segments_est segments, and the segments whose
+ * energy exceeds it with the given probability of false alarm are filtered by
+ * a notch following the instantaneous frequency of the interference:
+ *
+ * out[n] = in[n] - z0[n] in[n-1] + p_c_factor z0[n] out[n-1]
+ *
+ * with z0[n] = exp(j arg(in[n] conj(in[n-1]))), obtained by normalizing
+ * in[n] conj(in[n-1]) instead of evaluating the atan2 and the exponential.
+ *
+ * The power spectra of the estimation segments are accumulated as they
+ * arrive, and the noise floor is computed once from their average. The last
+ * input sample is kept from one call to the next, so the input does not need
+ * any history.
+ *
+ * With a Gnss_Spectral_Monitor of the RF channel, the noise floor is the one
+ * of its last estimate, so the filter does not compute any FFT, and the
+ * samples go through unchanged until its first estimate.
+ */
+class Notch_Canceller
+{
+public:
+    Notch_Canceller(float pfa, float p_c_factor, int32_t length, int32_t n_segments_est, int32_t n_segments_reset);
+
+    int32_t length() const;
+
+    //! Takes the noise floor from the estimates of monitor, or from the samples if it is null
+    void set_spectral_monitor(std::shared_ptr<const Gnss_Spectral_Monitor> monitor);
+
+    //! Processes length() samples, in and out can be the same. Returns true if they were filtered
+    bool process(const gr_complex* in, gr_complex* out);
+
+    //! Forgets the previous samples, for discontinuities such as a blanked segment
+    void reset_history();
+
+private:
+    void accumulate_spectrum(const gr_complex* in);
+    void estimate_noise_floor();
+
+    std::shared_ptr<const Gnss_Spectral_Monitor> d_monitor;
+    std::unique_ptr<gnss_fft_complex_fwd> d_fft;
+    volk_gnsssdr::vector<gr_complex> d_z_0;
+    volk_gnsssdr::vector<float> d_magnitude;
+    volk_gnsssdr::vector<float> d_power_spect;
+    volk_gnsssdr::vector<float> d_power_acc;
+    gr_complex d_last_in{0.0, 0.0};
+    gr_complex d_last_out{0.0, 0.0};
+    uint64_t d_monitor_sequence{0};
+    float d_p_c_factor;
+    float d_noise_pow_est{0.0};
+    float d_thres;
+    int32_t d_length;
+    int32_t d_n_deg_fred;
+    uint32_t d_n_segments{0};
+    uint32_t d_n_segments_est;
+    uint32_t d_n_segments_reset;
+    uint32_t d_n_accumulated{0};
+    bool d_filter_state{false};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_INTERFERENCE_MITIGATION_H
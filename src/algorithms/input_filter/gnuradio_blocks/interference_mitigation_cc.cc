@@ -0,0 +1,77 @@
+/*!
+ * \file interference_mitigation_cc.cc
+ * \brief Pulse blanking followed by a multi state notch filter, in a single
+ * pass over each segment of samples.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "interference_mitigation_cc.h"
+#include "gnss_spectral_monitor.h"
+#include <gnuradio/io_signature.h>
+#include <volk/volk.h>
+#include <algorithm>
+
+
+interference_mitigation_cc_sptr make_interference_mitigation_cc(const Interference_Mitigation_Conf &conf)
+{
+    return interference_mitigation_cc_sptr(new interference_mitigation_cc(conf));
+}
+
+
+interference_mitigation_cc::interference_mitigation_cc(const Interference_Mitigation_Conf &conf)
+    : gr::block("interference_mitigation_cc",
+          gr::io_signature::make(1, 1, sizeof(gr_complex)),
+          gr::io_signature::make(1, 1, sizeof(gr_complex))),
+      d_blanker(conf.blanking_pfa, conf.length, conf.n_segments_est, conf.n_segments_reset),
+      d_notch(conf.notch_pfa, conf.p_c_factor, conf.length, conf.n_segments_est, conf.n_segments_reset),
+      d_rf_channel(conf.rf_channel)
+{
+    const int32_t alignment_multiple = volk_get_alignment() / sizeof(gr_complex);
+    set_alignment(std::max(1, alignment_multiple));
+    set_output_multiple(conf.length);
+}
+
+
+bool interference_mitigation_cc::start()
+{
+    // the monitors are published by the flow graph after the blocks are made
+    const std::shared_ptr<Gnss_Spectral_Monitor> monitor = Gnss_Spectral_Monitor::instance(d_rf_channel);
+    d_blanker.set_spectral_monitor(monitor);
+    d_notch.set_spectral_monitor(monitor);
+    return true;
+}
+
+
+int interference_mitigation_cc::general_work(int noutput_items, gr_vector_int &ninput_items __attribute__((unused)),
+    gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
+{
+    const auto *in = reinterpret_cast<const gr_complex *>(input_items[0]);
+    auto *out = reinterpret_cast<gr_complex *>(output_items[0]);
+    const int32_t length = d_blanker.length();
+    int32_t index_out = 0;
+    while ((index_out + length) <= noutput_items)
+        {
+            if (d_blanker.process(in, out))
+                {
+                    d_notch.reset_history();
+                }
+            else
+                {
+                    d_notch.process(out, out);
+                }
+            index_out += length;
+            in += length;
+            out += length;
+        }
+    consume_each(index_out);
+    return index_out;
+}
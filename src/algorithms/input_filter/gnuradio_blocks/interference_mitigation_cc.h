@@ -0,0 +1,84 @@
+/*!
+ * \file interference_mitigation_cc.h
+ * \brief Pulse blanking followed by a multi state notch filter, in a single
+ * pass over each segment of samples.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_INTERFERENCE_MITIGATION_CC_H
+#define GNSS_SDR_INTERFERENCE_MITIGATION_CC_H
+
+#include "gnss_block_interface.h"
+#include "interference_mitigation.h"
+#include <gnuradio/block.h>
+#include <cstdint>
+
+/** \addtogroup Input_Filter
+ * \{ */
+/** \addtogroup Input_filter_gnuradio_blocks
+ * \{ */
+
+
+/*!
+ * \brief Parameters of the interference mitigation block
+ */
+class Interference_Mitigation_Conf
+{
+public:
+    float blanking_pfa = 0.04;
+    float notch_pfa = 0.001;
+    float p_c_factor = 0.9;
+    int32_t length = 32;
+    int32_t n_segments_est = 12500;
+    int32_t n_segments_reset = 5000000;
+    uint32_t rf_channel = 0;  // of the Gnss_Spectral_Monitor giving the noise power and floor, if any
+};
+
+
+class interference_mitigation_cc;
+
+using interference_mitigation_cc_sptr = gnss_shared_ptr<interference_mitigation_cc>;
+
+interference_mitigation_cc_sptr make_interference_mitigation_cc(const Interference_Mitigation_Conf &conf);
+
+/*!
+ * \brief Blanks the pulsed interference and filters the narrowband one, as a
+ * pulse_blanking_cc followed by a Notch, but processing each segment in
+ * place while it is in cache, and without a buffer between two blocks. The
+ * blanked segments are not seen by the notch filter, so they do not bias its
+ * noise floor estimation.
+ */
+class interference_mitigation_cc : public gr::block
+{
+public:
+    ~interference_mitigation_cc() = default;
+
+    //! Takes the noise power and floor from the Gnss_Spectral_Monitor of the RF channel, if the flow graph has one
+    bool start() override;
+
+    int general_work(int noutput_items, gr_vector_int &ninput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+private:
+    friend interference_mitigation_cc_sptr make_interference_mitigation_cc(const Interference_Mitigation_Conf &conf);
+    explicit interference_mitigation_cc(const Interference_Mitigation_Conf &conf);
+
+    Pulse_Blanker d_blanker;
+    Notch_Canceller d_notch;
+    uint32_t d_rf_channel;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_INTERFERENCE_MITIGATION_CC_H
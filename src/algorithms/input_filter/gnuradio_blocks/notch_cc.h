@@ -19,11 +19,9 @@
 #define GNSS_SDR_NOTCH_CC_H
 
 #include "gnss_block_interface.h"
-#include "gnss_sdr_fft.h"
+#include "interference_mitigation.h"
 #include <gnuradio/block.h>
-#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
 #include <cstdint>
-#include <memory>
 
 /** \addtogroup Input_Filter
  * \{ */
@@ -40,40 +38,31 @@ notch_sptr make_notch_filter(
     float p_c_factor,
     int32_t length,
     int32_t n_segments_est,
-    int32_t n_segments_reset);
+    int32_t n_segments_reset,
+    uint32_t rf_channel = 0);
 
 /*!
  * \brief This class implements a real-time software-defined multi state notch filter
+ * (see Notch_Canceller)
  */
 class Notch : public gr::block
 {
 public:
     ~Notch() = default;
 
+    //! Takes the noise floor from the Gnss_Spectral_Monitor of the RF channel, if the flow graph has one
+    bool start() override;
+
     int general_work(int noutput_items, gr_vector_int &ninput_items,
         gr_vector_const_void_star &input_items,
         gr_vector_void_star &output_items);
 
 private:
-    friend notch_sptr make_notch_filter(float pfa, float p_c_factor, int32_t length, int32_t n_segments_est, int32_t n_segments_reset);
-    Notch(float pfa, float p_c_factor, int32_t length, int32_t n_segments_est, int32_t n_segments_reset);
+    friend notch_sptr make_notch_filter(float pfa, float p_c_factor, int32_t length, int32_t n_segments_est, int32_t n_segments_reset, uint32_t rf_channel);
+    Notch(float pfa, float p_c_factor, int32_t length, int32_t n_segments_est, int32_t n_segments_reset, uint32_t rf_channel);
 
-    std::unique_ptr<gnss_fft_complex_fwd> d_fft_;
-    volk_gnsssdr::vector<gr_complex> c_samples_;
-    volk_gnsssdr::vector<float> angle_;
-    volk_gnsssdr::vector<float> power_spect_;
-    gr_complex last_out_;
-    gr_complex z_0_;
-    gr_complex p_c_factor_;
-    float pfa_;
-    float noise_pow_est_;
-    float thres_;
-    int32_t length_;
-    int32_t n_deg_fred_;
-    uint32_t n_segments_;
-    uint32_t n_segments_est_;
-    uint32_t n_segments_reset_;
-    bool filter_state_;
+    Notch_Canceller notch_;
+    uint32_t rf_channel_;
 };
 
 
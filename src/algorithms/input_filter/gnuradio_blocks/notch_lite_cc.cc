@@ -16,6 +16,7 @@
  */
 
 #include "notch_lite_cc.h"
+#include "gnss_spectral_monitor.h"
 #include <boost/math/distributions/chi_squared.hpp>
 #include <gnuradio/io_signature.h>
 #include <volk/volk.h>
@@ -24,9 +25,9 @@
 #include <cstring>
 
 
-notch_lite_sptr make_notch_filter_lite(float p_c_factor, float pfa, int32_t length, int32_t n_segments_est, int32_t n_segments_reset, int32_t n_segments_coeff)
+notch_lite_sptr make_notch_filter_lite(float p_c_factor, float pfa, int32_t length, int32_t n_segments_est, int32_t n_segments_reset, int32_t n_segments_coeff, uint32_t rf_channel)
 {
-    return notch_lite_sptr(new NotchLite(p_c_factor, pfa, length, n_segments_est, n_segments_reset, n_segments_coeff));
+    return notch_lite_sptr(new NotchLite(p_c_factor, pfa, length, n_segments_est, n_segments_reset, n_segments_coeff, rf_channel));
 }
 
 
@@ -35,7 +36,8 @@ NotchLite::NotchLite(float p_c_factor,
     int32_t length,
     int32_t n_segments_est,
     int32_t n_segments_reset,
-    int32_t n_segments_coeff)
+    int32_t n_segments_coeff,
+    uint32_t rf_channel)
     : gr::block("NotchLite",
           gr::io_signature::make(1, 1, sizeof(gr_complex)),
           gr::io_signature::make(1, 1, sizeof(gr_complex))),
@@ -44,6 +46,7 @@ NotchLite::NotchLite(float p_c_factor,
       p_c_factor_(gr_complex(p_c_factor, 0.0)),
       c_samples1_(gr_complex(0.0, 0.0)),
       c_samples2_(gr_complex(0.0, 0.0)),
+      monitor_sequence_(0),
       pfa_(pfa),
       noise_pow_est_(0.0),
       angle1_(0.0),
@@ -55,6 +58,7 @@ NotchLite::NotchLite(float p_c_factor,
       n_segments_coeff_reset_(n_segments_coeff),
       n_segments_coeff_(0),
       n_deg_fred_(2 * length),
+      rf_channel_(rf_channel),
       filter_state_(false)
 {
     const int32_t alignment_multiple = volk_get_alignment() / sizeof(gr_complex);
@@ -69,6 +73,15 @@ NotchLite::NotchLite(float p_c_factor,
 }
 
 
+bool NotchLite::start()
+{
+    // the monitors are published by the flow graph after the blocks are made
+    monitor_ = Gnss_Spectral_Monitor::instance(rf_channel_);
+    monitor_sequence_ = 0;
+    return true;
+}
+
+
 int NotchLite::general_work(int noutput_items, gr_vector_int &ninput_items __attribute__((unused)),
     gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
 {
@@ -79,9 +92,26 @@ int NotchLite::general_work(int noutput_items, gr_vector_int &ninput_items __att
     const auto *in = reinterpret_cast<const gr_complex *>(input_items[0]);
     auto *out = reinterpret_cast<gr_complex *>(output_items[0]);
     in++;
+    if (monitor_ != nullptr)
+        {
+            const uint64_t sequence = monitor_->sequence();
+            if (sequence == 0)
+                {
+                    // no noise floor yet
+                    const int32_t n_items = ((noutput_items - 1) / length_) * length_;
+                    memcpy(out, in, sizeof(gr_complex) * n_items);
+                    consume_each(n_items);
+                    return n_items;
+                }
+            if (sequence != monitor_sequence_)
+                {
+                    monitor_sequence_ = sequence;
+                    noise_pow_est_ = monitor_->noise_variance() / 2.0F;
+                }
+        }
     while ((index_out + length_) < noutput_items)
         {
-            if ((n_segments_ < n_segments_est_) && (filter_state_ == false))
+            if ((monitor_ == nullptr) && (n_segments_ < n_segments_est_) && (filter_state_ == false))
                 {
                     memcpy(d_fft_->get_inbuf(), in, sizeof(gr_complex) * length_);
                     d_fft_->execute();
@@ -31,6 +31,7 @@
  * \{ */
 
 
+class Gnss_Spectral_Monitor;
 class NotchLite;
 
 using notch_lite_sptr = gnss_shared_ptr<NotchLite>;
@@ -41,24 +42,33 @@ notch_lite_sptr make_notch_filter_lite(
     int32_t length,
     int32_t n_segments_est,
     int32_t n_segments_reset,
-    int32_t n_segments_coeff);
+    int32_t n_segments_coeff,
+    uint32_t rf_channel = 0);
 
 /*!
  * \brief This class implements a real-time software-defined multi state notch filter light version
+ *
+ * With a Gnss_Spectral_Monitor of the RF channel, the noise floor is the one
+ * of its last estimate, so the filter does not compute any FFT, and the
+ * samples go through unchanged until its first estimate.
  */
 class NotchLite : public gr::block
 {
 public:
     ~NotchLite() = default;
 
+    //! Takes the noise floor from the Gnss_Spectral_Monitor of the RF channel, if the flow graph has one
+    bool start() override;
+
     int general_work(int noutput_items, gr_vector_int &ninput_items,
         gr_vector_const_void_star &input_items,
         gr_vector_void_star &output_items);
 
 private:
-    friend notch_lite_sptr make_notch_filter_lite(float p_c_factor, float pfa, int32_t length, int32_t n_segments_est, int32_t n_segments_reset, int32_t n_segments_coeff);
-    NotchLite(float p_c_factor, float pfa, int32_t length, int32_t n_segments_est, int32_t n_segments_reset, int32_t n_segments_coeff);
+    friend notch_lite_sptr make_notch_filter_lite(float p_c_factor, float pfa, int32_t length, int32_t n_segments_est, int32_t n_segments_reset, int32_t n_segments_coeff, uint32_t rf_channel);
+    NotchLite(float p_c_factor, float pfa, int32_t length, int32_t n_segments_est, int32_t n_segments_reset, int32_t n_segments_coeff, uint32_t rf_channel);
 
+    std::shared_ptr<const Gnss_Spectral_Monitor> monitor_;
     std::unique_ptr<gnss_fft_complex_fwd> d_fft_;
     volk_gnsssdr::vector<float> power_spect_;
     gr_complex last_out_;
@@ -66,6 +76,7 @@ private:
     gr_complex p_c_factor_;
     gr_complex c_samples1_;
     gr_complex c_samples2_;
+    uint64_t monitor_sequence_;
     float pfa_;
     float thres_;
     float noise_pow_est_;
@@ -78,6 +89,7 @@ private:
     int32_t n_segments_coeff_reset_;
     int32_t n_segments_coeff_;
     int32_t n_deg_fred_;
+    uint32_t rf_channel_;
     bool filter_state_;
 };
 
@@ -17,40 +17,41 @@
  */
 
 #include "pulse_blanking_cc.h"
-#include <boost/math/distributions/chi_squared.hpp>
+#include "gnss_spectral_monitor.h"
 #include <gnuradio/io_signature.h>
 #include <volk/volk.h>
 #include <algorithm>
 
 
 pulse_blanking_cc_sptr make_pulse_blanking_cc(float pfa, int32_t length,
-    int32_t n_segments_est, int32_t n_segments_reset)
+    int32_t n_segments_est, int32_t n_segments_reset, uint32_t rf_channel)
 {
-    return pulse_blanking_cc_sptr(new pulse_blanking_cc(pfa, length, n_segments_est, n_segments_reset));
+    return pulse_blanking_cc_sptr(new pulse_blanking_cc(pfa, length, n_segments_est, n_segments_reset, rf_channel));
 }
 
 
 pulse_blanking_cc::pulse_blanking_cc(float pfa,
     int32_t length,
     int32_t n_segments_est,
-    int32_t n_segments_reset)
+    int32_t n_segments_reset,
+    uint32_t rf_channel)
     : gr::block("pulse_blanking_cc",
           gr::io_signature::make(1, 1, sizeof(gr_complex)),
           gr::io_signature::make(1, 1, sizeof(gr_complex))),
-      noise_power_estimation_(0.0),
-      pfa_(pfa),
-      length_(length),
-      n_segments_(0),
-      n_segments_est_(n_segments_est),
-      n_segments_reset_(n_segments_reset),
-      n_deg_fred_(2 * length),
-      last_filtered_(false)
+      blanker_(pfa, length, n_segments_est, n_segments_reset),
+      rf_channel_(rf_channel)
 {
     const int32_t alignment_multiple = volk_get_alignment() / sizeof(gr_complex);
     set_alignment(std::max(1, alignment_multiple));
-    boost::math::chi_squared_distribution<float> my_dist_(n_deg_fred_);
-    thres_ = boost::math::quantile(boost::math::complement(my_dist_, pfa_));
-    zeros_ = volk_gnsssdr::vector<gr_complex>(length_);
+    set_output_multiple(length);
+}
+
+
+bool pulse_blanking_cc::start()
+{
+    // the monitors are published by the flow graph after the blocks are made
+    blanker_.set_spectral_monitor(Gnss_Spectral_Monitor::instance(rf_channel_));
+    return true;
 }
 
 
@@ -59,39 +60,14 @@ int pulse_blanking_cc::general_work(int noutput_items, gr_vector_int &ninput_ite
 {
     const auto *in = reinterpret_cast<const gr_complex *>(input_items[0]);
     auto *out = reinterpret_cast<gr_complex *>(output_items[0]);
-    auto magnitude = volk_gnsssdr::vector<float>(noutput_items);
-    volk_32fc_magnitude_squared_32f(magnitude.data(), in, noutput_items);
+    const int32_t length = blanker_.length();
     int32_t sample_index = 0;
-    float segment_energy;
-    while ((sample_index + length_) < noutput_items)
+    while ((sample_index + length) <= noutput_items)
         {
-            volk_32f_accumulator_s32f(&segment_energy, (magnitude.data() + sample_index), length_);
-            if ((n_segments_ < n_segments_est_) && (last_filtered_ == false))
-                {
-                    noise_power_estimation_ = (static_cast<float>(n_segments_) * noise_power_estimation_ + segment_energy / static_cast<float>(n_deg_fred_)) / static_cast<float>(n_segments_ + 1);
-                    memcpy(out, in, sizeof(gr_complex) * length_);
-                }
-            else
-                {
-                    if ((segment_energy / noise_power_estimation_) > thres_)
-                        {
-                            memcpy(out, zeros_.data(), sizeof(gr_complex) * length_);
-                            last_filtered_ = true;
-                        }
-                    else
-                        {
-                            memcpy(out, in, sizeof(gr_complex) * length_);
-                            last_filtered_ = false;
-                            if (n_segments_ > n_segments_reset_)
-                                {
-                                    n_segments_ = 0;
-                                }
-                        }
-                }
-            in += length_;
-            out += length_;
-            sample_index += length_;
-            n_segments_++;
+            blanker_.process(in, out);
+            in += length;
+            out += length;
+            sample_index += length;
         }
     consume_each(sample_index);
     return sample_index;
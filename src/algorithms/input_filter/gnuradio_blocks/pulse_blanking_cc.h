@@ -20,8 +20,8 @@
 #define GNSS_SDR_PULSE_BLANKING_CC_H
 
 #include "gnss_block_interface.h"
+#include "interference_mitigation.h"
 #include <gnuradio/block.h>
-#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
 #include <cstdint>
 
 /** \addtogroup Input_Filter
@@ -39,29 +39,25 @@ pulse_blanking_cc_sptr make_pulse_blanking_cc(
     float pfa,
     int32_t length,
     int32_t n_segments_est,
-    int32_t n_segments_reset);
+    int32_t n_segments_reset,
+    uint32_t rf_channel = 0);
 
 class pulse_blanking_cc : public gr::block
 {
 public:
     ~pulse_blanking_cc() = default;
 
+    //! Takes the noise power from the Gnss_Spectral_Monitor of the RF channel, if the flow graph has one
+    bool start() override;
+
     int general_work(int noutput_items __attribute__((unused)), gr_vector_int &ninput_items __attribute__((unused)),
         gr_vector_const_void_star &input_items, gr_vector_void_star &output_items);
 
 private:
-    friend pulse_blanking_cc_sptr make_pulse_blanking_cc(float pfa, int32_t length, int32_t n_segments_est, int32_t n_segments_reset);
-    pulse_blanking_cc(float pfa, int32_t length, int32_t n_segments_est, int32_t n_segments_reset);
-    volk_gnsssdr::vector<gr_complex> zeros_;
-    float noise_power_estimation_;
-    float thres_;
-    float pfa_;
-    int32_t length_;
-    int32_t n_segments_;
-    int32_t n_segments_est_;
-    int32_t n_segments_reset_;
-    int32_t n_deg_fred_;
-    bool last_filtered_;
+    friend pulse_blanking_cc_sptr make_pulse_blanking_cc(float pfa, int32_t length, int32_t n_segments_est, int32_t n_segments_reset, uint32_t rf_channel);
+    pulse_blanking_cc(float pfa, int32_t length, int32_t n_segments_est, int32_t n_segments_reset, uint32_t rf_channel);
+    Pulse_Blanker blanker_;
+    uint32_t rf_channel_;
 };
 
 
@@ -0,0 +1,270 @@
+/*!
+ * \file xlating_decimator.cc
+ * \brief Frequency translating, decimating FIR filter for one or several
+ * output bands, with a time-domain and an FFT overlap-save implementation.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "xlating_decimator.h"
+#include "MATH_CONSTANTS.h"
+#include <volk/volk.h>
+#include <algorithm>  // for copy_n, fill, max, min
+#include <cmath>      // for log2
+#include <complex>    // for exp, abs
+#include <limits>     // for numeric_limits
+#include <stdexcept>  // for invalid_argument
+
+
+namespace
+{
+// Largest FFT size considered by the automatic choice
+constexpr std::size_t XLATING_DECIMATOR_MAX_FFT_SIZE = 65536;
+}  // namespace
+
+
+Xlating_Decimator::Xlating_Decimator(const std::vector<float>& taps,
+    int decimation,
+    const std::vector<double>& center_freqs,
+    Backend backend,
+    std::size_t fft_size)
+    : d_ntaps(taps.size()),
+      d_decimation(static_cast<std::size_t>(std::max(decimation, 1))),
+      d_backend(backend)
+{
+    if (taps.empty())
+        {
+            throw std::invalid_argument("Xlating_Decimator: no filter taps");
+        }
+    if (center_freqs.empty())
+        {
+            throw std::invalid_argument("Xlating_Decimator: no output bands");
+        }
+    const std::size_t n_bands = center_freqs.size();
+
+    if (d_backend == Backend::AUTO)
+        {
+            double best_cost = polyphase_cost(d_ntaps, d_decimation, n_bands);
+            d_backend = Backend::POLYPHASE;
+            for (std::size_t size = 2; size <= XLATING_DECIMATOR_MAX_FFT_SIZE; size *= 2)
+                {
+                    const double cost = fft_cost(d_ntaps, d_decimation, n_bands, size);
+                    if (cost < best_cost and (fft_size == 0 or fft_size == size))
+                        {
+                            best_cost = cost;
+                            d_backend = Backend::FFT;
+                            d_fft_size = size;
+                        }
+                }
+        }
+    else if (d_backend == Backend::FFT)
+        {
+            d_fft_size = fft_size;
+            if (d_fft_size == 0)
+                {
+                    double best_cost = std::numeric_limits<double>::infinity();
+                    for (std::size_t size = 2; size <= XLATING_DECIMATOR_MAX_FFT_SIZE; size *= 2)
+                        {
+                            const double cost = fft_cost(d_ntaps, d_decimation, n_bands, size);
+                            if (cost < best_cost)
+                                {
+                                    best_cost = cost;
+                                    d_fft_size = size;
+                                }
+                        }
+                }
+        }
+
+    // Same as gr::filter::freq_xlating_fir_filter: shift the taps to the
+    // center frequency, and rotate the decimated output back to baseband
+    std::vector<std::vector<gr_complex>> ctaps(n_bands, std::vector<gr_complex>(d_ntaps));
+    d_rotator = std::vector<std::complex<double>>(n_bands, std::complex<double>(1.0, 0.0));
+    d_rotator_step = std::vector<std::complex<double>>(n_bands);
+    for (std::size_t band = 0; band < n_bands; band++)
+        {
+            const double fwT0 = 2.0 * GNSS_PI * center_freqs[band];
+            for (std::size_t i = 0; i < d_ntaps; i++)
+                {
+                    ctaps[band][i] = taps[i] * std::exp(gr_complex(0.0F, static_cast<float>(static_cast<double>(i) * fwT0)));
+                }
+            d_rotator_step[band] = std::exp(std::complex<double>(0.0, -fwT0 * static_cast<double>(d_decimation)));
+        }
+
+    if (d_backend == Backend::POLYPHASE)
+        {
+            d_ctaps_reversed = std::vector<volk_gnsssdr::vector<gr_complex>>(n_bands, volk_gnsssdr::vector<gr_complex>(d_ntaps));
+            for (std::size_t band = 0; band < n_bands; band++)
+                {
+                    std::copy(ctaps[band].crbegin(), ctaps[band].crend(), d_ctaps_reversed[band].begin());
+                }
+            return;
+        }
+
+    // Overlap-save: each FFT block yields the full rate outputs from index
+    // ntaps - 1 on, of which the block keeps a whole number of decimated ones
+    if (d_fft_size < d_ntaps - 1 + d_decimation)
+        {
+            throw std::invalid_argument("Xlating_Decimator: FFT size too small for the filter length and decimation");
+        }
+    d_hop = ((d_fft_size - d_ntaps + 1) / d_decimation) * d_decimation;
+    d_fft = gnss_fft_fwd_make_unique(d_fft_size);
+    d_ifft = gnss_fft_rev_make_unique(d_fft_size);
+    d_ctaps_spectrum = std::vector<volk_gnsssdr::vector<gr_complex>>(n_bands, volk_gnsssdr::vector<gr_complex>(d_fft_size));
+    const float scale = 1.0F / static_cast<float>(d_fft_size);
+    for (std::size_t band = 0; band < n_bands; band++)
+        {
+            gr_complex* fft_in = d_fft->get_inbuf();
+            std::fill(fft_in, fft_in + d_fft_size, gr_complex(0.0F, 0.0F));
+            std::copy(ctaps[band].cbegin(), ctaps[band].cend(), fft_in);
+            d_fft->execute();
+            const gr_complex* fft_out = d_fft->get_outbuf();
+            for (std::size_t i = 0; i < d_fft_size; i++)
+                {
+                    d_ctaps_spectrum[band][i] = fft_out[i] * scale;
+                }
+        }
+}
+
+
+Xlating_Decimator::Backend Xlating_Decimator::backend() const
+{
+    return d_backend;
+}
+
+
+std::size_t Xlating_Decimator::ntaps() const
+{
+    return d_ntaps;
+}
+
+
+std::size_t Xlating_Decimator::decimation() const
+{
+    return d_decimation;
+}
+
+
+std::size_t Xlating_Decimator::outputs() const
+{
+    return d_rotator.size();
+}
+
+
+std::size_t Xlating_Decimator::fft_size() const
+{
+    return d_fft_size;
+}
+
+
+std::size_t Xlating_Decimator::output_multiple() const
+{
+    return d_backend == Backend::FFT ? d_hop / d_decimation : 1;
+}
+
+
+double Xlating_Decimator::polyphase_cost(std::size_t ntaps, std::size_t decimation __attribute__((unused)), std::size_t outputs)
+{
+    // a complex multiply-accumulate with a complex tap is 8 operations
+    return 8.0 * static_cast<double>(ntaps) * static_cast<double>(outputs);
+}
+
+
+double Xlating_Decimator::fft_cost(std::size_t ntaps, std::size_t decimation, std::size_t outputs, std::size_t fft_size)
+{
+    if (fft_size < ntaps - 1 + decimation)
+        {
+            return std::numeric_limits<double>::infinity();
+        }
+    const auto size = static_cast<double>(fft_size);
+    const auto hop = static_cast<double>((fft_size - ntaps + 1) / decimation);
+    // about 5 N log2(N) operations per FFT: one forward FFT shared by all the
+    // outputs, and a complex product and an inverse FFT per output
+    const double block = 5.0 * size * std::log2(size) * static_cast<double>(outputs + 1) + 6.0 * size * static_cast<double>(outputs);
+    return block / hop;
+}
+
+
+void Xlating_Decimator::filter(const gr_complex* in, std::size_t n_out, gr_complex* const* out)
+{
+    if (d_backend == Backend::FFT)
+        {
+            filter_fft(in, n_out, out);
+        }
+    else
+        {
+            filter_polyphase(in, n_out, out);
+        }
+    for (std::size_t band = 0; band < outputs(); band++)
+        {
+            rotate(band, out[band], n_out);
+        }
+}
+
+
+void Xlating_Decimator::filter_polyphase(const gr_complex* in, std::size_t n_out, gr_complex* const* out)
+{
+    const std::size_t n_bands = outputs();
+    for (std::size_t i = 0; i < n_out; i++)
+        {
+            const gr_complex* window = in + i * d_decimation;
+            for (std::size_t band = 0; band < n_bands; band++)
+                {
+                    volk_32fc_x2_dot_prod_32fc(&out[band][i], window, d_ctaps_reversed[band].data(), d_ntaps);
+                }
+        }
+}
+
+
+void Xlating_Decimator::filter_fft(const gr_complex* in, std::size_t n_out, gr_complex* const* out)
+{
+    const std::size_t n_bands = outputs();
+    const std::size_t per_block = d_hop / d_decimation;
+    const std::size_t available = (n_out - 1) * d_decimation + d_ntaps;
+    for (std::size_t first = 0; first < n_out; first += per_block)
+        {
+            // The input beyond the available samples only reaches the full
+            // rate outputs that are not kept, so it can be zero
+            const std::size_t start = first * d_decimation;
+            const std::size_t n_in = std::min(d_fft_size, available - start);
+            gr_complex* fft_in = d_fft->get_inbuf();
+            std::copy_n(in + start, n_in, fft_in);
+            std::fill(fft_in + n_in, fft_in + d_fft_size, gr_complex(0.0F, 0.0F));
+            d_fft->execute();
+
+            const std::size_t n_block = std::min(per_block, n_out - first);
+            for (std::size_t band = 0; band < n_bands; band++)
+                {
+                    volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(), d_fft->get_outbuf(), d_ctaps_spectrum[band].data(), d_fft_size);
+                    d_ifft->execute();
+                    const gr_complex* filtered = d_ifft->get_outbuf() + d_ntaps - 1;
+                    for (std::size_t i = 0; i < n_block; i++)
+                        {
+                            out[band][first + i] = filtered[i * d_decimation];
+                        }
+                }
+        }
+}
+
+
+void Xlating_Decimator::rotate(std::size_t band, gr_complex* out, std::size_t n_out)
+{
+    if (d_rotator_step[band] == std::complex<double>(1.0, 0.0))
+        {
+            return;
+        }
+    std::complex<double> rotator = d_rotator[band];
+    for (std::size_t i = 0; i < n_out; i++)
+        {
+            out[i] *= gr_complex(static_cast<float>(rotator.real()), static_cast<float>(rotator.imag()));
+            rotator *= d_rotator_step[band];
+        }
+    d_rotator[band] = rotator / std::abs(rotator);
+}
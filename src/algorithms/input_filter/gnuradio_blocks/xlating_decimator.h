@@ -0,0 +1,119 @@
+/*!
+ * \file xlating_decimator.h
+ * \brief Frequency translating, decimating FIR filter for one or several
+ * output bands, with a time-domain and an FFT overlap-save implementation.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_XLATING_DECIMATOR_H
+#define GNSS_SDR_XLATING_DECIMATOR_H
+
+#include "gnss_sdr_fft.h"
+#include <gnuradio/gr_complex.h>
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+/** \addtogroup Input_Filter
+ * \{ */
+/** \addtogroup Input_filter_gnuradio_blocks
+ * \{ */
+
+
+/*!
+ * \brief Filters the input with the same real low pass taps shifted to the
+ * center frequency of each output band, and decimates the result, as a bank
+ * of gr::filter::freq_xlating_fir_filter_ccf sharing the input.
+ *
+ * Two implementations:
+ * - POLYPHASE: in the time domain, only the decimated outputs are computed
+ * (ntaps complex multiply-accumulates per output and band, the cost of a
+ * polyphase decimator). Each input window is used for all the bands while it
+ * is in cache.
+ * - FFT: overlap-save. The spectrum of each input block is computed once and
+ * shared by all the bands, each band then costs a complex product and an
+ * inverse FFT. It is cheaper for long filters and several bands.
+ *
+ * AUTO picks the one with the lowest estimated number of operations per
+ * output, and the FFT size for the FFT implementation.
+ */
+class Xlating_Decimator
+{
+public:
+    enum class Backend
+    {
+        AUTO,
+        POLYPHASE,
+        FFT
+    };
+
+    /*!
+     * \brief taps are the low pass taps at the input rate, and center_freqs
+     * the center frequency of each output band divided by the input sampling
+     * frequency. fft_size is only used by the FFT implementation, 0 to
+     * choose it automatically. Throws std::invalid_argument for an empty
+     * filter or list of bands, or an FFT size too small for the filter.
+     */
+    Xlating_Decimator(const std::vector<float>& taps,
+        int decimation,
+        const std::vector<double>& center_freqs,
+        Backend backend = Backend::AUTO,
+        std::size_t fft_size = 0);
+
+    Backend backend() const;
+
+    std::size_t ntaps() const;
+    std::size_t decimation() const;
+    std::size_t outputs() const;
+
+    //! FFT size of the FFT implementation, 0 for POLYPHASE
+    std::size_t fft_size() const;
+
+    //! Number of outputs computed at once: filter() expects a multiple of it
+    std::size_t output_multiple() const;
+
+    /*!
+     * \brief Computes n_out samples of each output band, out[band]. in must
+     * hold (n_out - 1) * decimation() + ntaps() samples, the first
+     * ntaps() - 1 of them being the history, as a GNU Radio sync_decimator
+     * with set_history(ntaps()) provides them. The next call must start
+     * n_out * decimation() samples later.
+     */
+    void filter(const gr_complex* in, std::size_t n_out, gr_complex* const* out);
+
+    //! Estimated real floating point operations per output sample of all the bands
+    static double polyphase_cost(std::size_t ntaps, std::size_t decimation, std::size_t outputs);
+    static double fft_cost(std::size_t ntaps, std::size_t decimation, std::size_t outputs, std::size_t fft_size);
+
+private:
+    void filter_polyphase(const gr_complex* in, std::size_t n_out, gr_complex* const* out);
+    void filter_fft(const gr_complex* in, std::size_t n_out, gr_complex* const* out);
+    void rotate(std::size_t band, gr_complex* out, std::size_t n_out);
+
+    std::vector<volk_gnsssdr::vector<gr_complex>> d_ctaps_reversed;  // shifted taps of each band, in dot product order
+    std::vector<volk_gnsssdr::vector<gr_complex>> d_ctaps_spectrum;  // FFT of the shifted taps of each band, scaled by 1 / fft_size
+    std::vector<std::complex<double>> d_rotator;  // in double precision, so that the phase does not drift
+    std::vector<std::complex<double>> d_rotator_step;
+    gnss_fft_fwd_unique_ptr<gnss_fft_complex_fwd> d_fft;
+    gnss_fft_rev_unique_ptr<gnss_fft_complex_rev> d_ifft;
+    std::size_t d_ntaps;
+    std::size_t d_decimation;
+    std::size_t d_fft_size{0};
+    std::size_t d_hop{0};  // input samples per FFT block, a multiple of the decimation
+    Backend d_backend;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_XLATING_DECIMATOR_H
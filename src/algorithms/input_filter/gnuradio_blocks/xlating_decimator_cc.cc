@@ -0,0 +1,60 @@
+/*!
+ * \file xlating_decimator_cc.cc
+ * \brief GNU Radio block that translates, filters and decimates one or
+ * several bands of the input stream, with an Xlating_Decimator.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "xlating_decimator_cc.h"
+#include <gnuradio/io_signature.h>
+#include <algorithm>  // for max
+
+
+xlating_decimator_cc_sptr make_xlating_decimator_cc(const std::vector<float>& taps,
+    int decimation,
+    const std::vector<double>& center_freqs,
+    Xlating_Decimator::Backend backend,
+    std::size_t fft_size)
+{
+    return xlating_decimator_cc_sptr(new xlating_decimator_cc(taps, decimation, center_freqs, backend, fft_size));
+}
+
+
+xlating_decimator_cc::xlating_decimator_cc(const std::vector<float>& taps,
+    int decimation,
+    const std::vector<double>& center_freqs,
+    Xlating_Decimator::Backend backend,
+    std::size_t fft_size)
+    : gr::sync_decimator("xlating_decimator_cc",
+          gr::io_signature::make(1, 1, sizeof(gr_complex)),
+          gr::io_signature::make(static_cast<int>(center_freqs.size()), static_cast<int>(center_freqs.size()), sizeof(gr_complex)),
+          static_cast<unsigned int>(std::max(decimation, 1))),
+      d_decimator(taps, decimation, center_freqs, backend, fft_size),
+      d_out(center_freqs.size())
+{
+    set_history(static_cast<unsigned int>(d_decimator.ntaps()));
+    set_output_multiple(static_cast<int>(d_decimator.output_multiple()));
+}
+
+
+int xlating_decimator_cc::work(int noutput_items,
+    gr_vector_const_void_star& input_items,
+    gr_vector_void_star& output_items)
+{
+    const auto* in = reinterpret_cast<const gr_complex*>(input_items[0]);
+    for (std::size_t band = 0; band < d_out.size(); band++)
+        {
+            d_out[band] = reinterpret_cast<gr_complex*>(output_items[band]);
+        }
+    d_decimator.filter(in, static_cast<std::size_t>(noutput_items), d_out.data());
+    return noutput_items;
+}
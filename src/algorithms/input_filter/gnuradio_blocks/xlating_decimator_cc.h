@@ -0,0 +1,86 @@
+/*!
+ * \file xlating_decimator_cc.h
+ * \brief GNU Radio block that translates, filters and decimates one or
+ * several bands of the input stream, with an Xlating_Decimator.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_XLATING_DECIMATOR_CC_H
+#define GNSS_SDR_XLATING_DECIMATOR_CC_H
+
+#include "gnss_block_interface.h"
+#include "xlating_decimator.h"
+#include <gnuradio/sync_decimator.h>
+#include <cstddef>
+#include <vector>
+
+/** \addtogroup Input_Filter
+ * \{ */
+/** \addtogroup Input_filter_gnuradio_blocks
+ * \{ */
+
+
+class xlating_decimator_cc;
+
+using xlating_decimator_cc_sptr = gnss_shared_ptr<xlating_decimator_cc>;
+
+xlating_decimator_cc_sptr make_xlating_decimator_cc(const std::vector<float>& taps,
+    int decimation,
+    const std::vector<double>& center_freqs,
+    Xlating_Decimator::Backend backend = Xlating_Decimator::Backend::AUTO,
+    std::size_t fft_size = 0);
+
+/*!
+ * \brief One gr_complex input and one gr_complex output per band: output k
+ * is the band around center_freqs[k] (divided by the sampling frequency),
+ * low pass filtered with taps and decimated.
+ */
+class xlating_decimator_cc : public gr::sync_decimator
+{
+public:
+    ~xlating_decimator_cc() = default;
+
+    inline Xlating_Decimator::Backend backend() const
+    {
+        return d_decimator.backend();
+    }
+
+    inline std::size_t fft_size() const
+    {
+        return d_decimator.fft_size();
+    }
+
+    int work(int noutput_items,
+        gr_vector_const_void_star& input_items,
+        gr_vector_void_star& output_items);
+
+private:
+    friend xlating_decimator_cc_sptr make_xlating_decimator_cc(const std::vector<float>& taps,
+        int decimation,
+        const std::vector<double>& center_freqs,
+        Xlating_Decimator::Backend backend,
+        std::size_t fft_size);
+
+    xlating_decimator_cc(const std::vector<float>& taps,
+        int decimation,
+        const std::vector<double>& center_freqs,
+        Xlating_Decimator::Backend backend,
+        std::size_t fft_size);
+
+    Xlating_Decimator d_decimator;
+    std::vector<gr_complex*> d_out;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_XLATING_DECIMATOR_CC_H
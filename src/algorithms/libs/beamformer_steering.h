@@ -0,0 +1,51 @@
+/*!
+ * \file beamformer_steering.h
+ * \brief Directions of the satellites in view, sent by the PVT block to the
+ * beamformer to steer the antenna array
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_BEAMFORMER_STEERING_H
+#define GNSS_SDR_BEAMFORMER_STEERING_H
+
+#include <cstdint>
+#include <vector>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Azimuth and elevation of the satellites used in the last position
+ * fix, in the local East-North-Up frame of the receiver
+ */
+class Beamformer_Steering
+{
+public:
+    class Direction
+    {
+    public:
+        double azimuth_rad = 0.0;    //!< clockwise from the North
+        double elevation_rad = 0.0;  //!< above the horizon
+        uint32_t prn = 0U;
+        char system = ' ';  //!< 'G', 'E', 'R', 'C'
+    };
+
+    std::vector<Direction> directions;  //!< sorted by decreasing elevation
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_BEAMFORMER_STEERING_H
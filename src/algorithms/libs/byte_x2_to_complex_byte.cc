@@ -43,18 +43,9 @@ int byte_x2_to_complex_byte::work(int noutput_items,
     gr_vector_const_void_star &input_items,
     gr_vector_void_star &output_items)
 {
-    const auto *in0 = reinterpret_cast<const int8_t *>(input_items[0]);
-    const auto *in1 = reinterpret_cast<const int8_t *>(input_items[1]);
+    const auto *in0 = reinterpret_cast<const char *>(input_items[0]);
+    const auto *in1 = reinterpret_cast<const char *>(input_items[1]);
     auto *out = reinterpret_cast<lv_8sc_t *>(output_items[0]);
-    // This could be put into a volk kernel
-    int8_t real_part;
-    int8_t imag_part;
-    for (int number = 0; number < noutput_items; number++)
-        {
-            // lv_cmake(r, i) defined at volk/volk_complex.h
-            real_part = *in0++;
-            imag_part = *in1++;
-            *out++ = lv_cmake(real_part, imag_part);
-        }
+    volk_gnsssdr_8i_x2_interleave_8ic(out, in0, in1, noutput_items);
     return noutput_items;
 }
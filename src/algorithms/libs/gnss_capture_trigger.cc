@@ -0,0 +1,109 @@
+/*!
+ * \file gnss_capture_trigger.cc
+ * \brief Triggers the captures of raw samples when the receiver detects an
+ * anomaly.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_capture_trigger.h"
+#include <glog/logging.h>
+#include <sstream>
+#include <utility>
+
+namespace
+{
+std::mutex global_trigger_mutex;
+std::shared_ptr<Gnss_Capture_Trigger> global_trigger;
+}  // namespace
+
+
+Gnss_Capture_Trigger::Gnss_Capture_Trigger(std::chrono::steady_clock::duration holdoff, const std::string& reasons)
+    : d_holdoff(holdoff)
+{
+    std::stringstream ss(reasons);
+    std::string reason;
+    while (std::getline(ss, reason, ','))
+        {
+            reason.erase(0, reason.find_first_not_of(' '));
+            reason.erase(reason.find_last_not_of(' ') + 1);
+            if (!reason.empty())
+                {
+                    d_reasons.insert(reason);
+                }
+        }
+}
+
+
+void Gnss_Capture_Trigger::add_target(Target target)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_targets.push_back(std::move(target));
+}
+
+
+bool Gnss_Capture_Trigger::enabled(const std::string& reason) const
+{
+    return d_reasons.empty() or d_reasons.count(reason) > 0;
+}
+
+
+bool Gnss_Capture_Trigger::fire(const std::string& reason)
+{
+    return fire(reason, std::chrono::steady_clock::now());
+}
+
+
+bool Gnss_Capture_Trigger::fire(const std::string& reason, std::chrono::steady_clock::time_point now)
+{
+    if (!enabled(reason))
+        {
+            return false;
+        }
+    std::lock_guard<std::mutex> lock(d_mutex);
+    if (d_captures > 0 and now - d_last_capture < d_holdoff)
+        {
+            return false;
+        }
+    bool started = false;
+    for (const auto& target : d_targets)
+        {
+            started = target(reason) or started;
+        }
+    if (started)
+        {
+            LOG(INFO) << "Raw sample capture triggered by " << reason;
+            d_last_capture = now;
+            d_captures++;
+        }
+    return started;
+}
+
+
+uint32_t Gnss_Capture_Trigger::captures() const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_captures;
+}
+
+
+void Gnss_Capture_Trigger::set_global_instance(std::shared_ptr<Gnss_Capture_Trigger> trigger)
+{
+    std::lock_guard<std::mutex> lock(global_trigger_mutex);
+    global_trigger = std::move(trigger);
+}
+
+
+std::shared_ptr<Gnss_Capture_Trigger> Gnss_Capture_Trigger::global_instance()
+{
+    std::lock_guard<std::mutex> lock(global_trigger_mutex);
+    return global_trigger;
+}
@@ -0,0 +1,89 @@
+/*!
+ * \file gnss_capture_trigger.h
+ * \brief Triggers the captures of raw samples when the receiver detects an
+ * anomaly.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_CAPTURE_TRIGGER_H
+#define GNSS_SDR_GNSS_CAPTURE_TRIGGER_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Triggers the captures of all the sample rings of the receiver.
+ *
+ * The receiver fires a trigger when it detects an anomaly: a mass loss of
+ * lock ("lock_loss"), an interference detected by the input filters
+ * ("interference"), a jump of the PVT solution ("pvt_jump") or a
+ * telecommand ("telecommand"). Only the enabled reasons trigger captures,
+ * and the triggers fired within holdoff of the last capture are ignored.
+ *
+ * The object is owned by the flow graph, which publishes it through
+ * set_global_instance() so that the blocks can find it.
+ */
+class Gnss_Capture_Trigger
+{
+public:
+    /*!
+     * \brief Starts a capture for the given reason. Returns false if it is
+     * not started, e.g. because the previous one is still being written.
+     */
+    using Target = std::function<bool(const std::string& reason)>;
+
+    /*!
+     * \brief reasons is a comma-separated list of the reasons that trigger
+     * a capture, all of them if it is empty.
+     */
+    Gnss_Capture_Trigger(std::chrono::steady_clock::duration holdoff, const std::string& reasons);
+
+    void add_target(Target target);
+
+    bool enabled(const std::string& reason) const;
+
+    //! Returns true if a capture was started
+    bool fire(const std::string& reason);
+
+    //! Same as above, at the time now (for testing)
+    bool fire(const std::string& reason, std::chrono::steady_clock::time_point now);
+
+    uint32_t captures() const;  //!< Triggers that started captures
+
+    static void set_global_instance(std::shared_ptr<Gnss_Capture_Trigger> trigger);
+    static std::shared_ptr<Gnss_Capture_Trigger> global_instance();
+
+private:
+    std::vector<Target> d_targets;
+    std::set<std::string> d_reasons;
+    std::chrono::steady_clock::duration d_holdoff;
+    std::chrono::steady_clock::time_point d_last_capture{};
+    uint32_t d_captures{0};
+    mutable std::mutex d_mutex;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_CAPTURE_TRIGGER_H
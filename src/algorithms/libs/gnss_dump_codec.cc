@@ -0,0 +1,234 @@
+/*!
+ * \file gnss_dump_codec.cc
+ * \brief Columnar compression of the records of the dump files
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_dump_codec.h"
+#include <cstring>    // for memcpy
+#include <stdexcept>  // for invalid_argument
+
+
+namespace
+{
+bool dump_codec_is_float(char field)
+{
+    return field == 'f' or field == 'd';
+}
+
+
+// fields as unsigned integers of their size
+uint64_t dump_codec_load(const char* value, std::size_t size)
+{
+    uint64_t word = 0;
+    switch (size)
+        {
+        case 1:
+            {
+                uint8_t v;
+                std::memcpy(&v, value, 1);
+                word = v;
+                break;
+            }
+        case 2:
+            {
+                uint16_t v;
+                std::memcpy(&v, value, 2);
+                word = v;
+                break;
+            }
+        case 4:
+            {
+                uint32_t v;
+                std::memcpy(&v, value, 4);
+                word = v;
+                break;
+            }
+        default:
+            std::memcpy(&word, value, 8);
+        }
+    return word;
+}
+
+
+void dump_codec_store(uint64_t word, std::size_t size, char* value)
+{
+    switch (size)
+        {
+        case 1:
+            {
+                const auto v = static_cast<uint8_t>(word);
+                std::memcpy(value, &v, 1);
+                break;
+            }
+        case 2:
+            {
+                const auto v = static_cast<uint16_t>(word);
+                std::memcpy(value, &v, 2);
+                break;
+            }
+        case 4:
+            {
+                const auto v = static_cast<uint32_t>(word);
+                std::memcpy(value, &v, 4);
+                break;
+            }
+        default:
+            std::memcpy(value, &word, 8);
+        }
+}
+
+
+uint64_t dump_codec_mask(std::size_t size)
+{
+    return size == 8 ? ~uint64_t(0) : (uint64_t(1) << (8 * size)) - 1;
+}
+
+
+// maps small negative differences to small codes: 0, -1, 1, -2, 2...
+uint64_t dump_codec_zigzag(uint64_t diff, std::size_t size)
+{
+    const uint64_t sign = (diff >> (8 * size - 1)) & 1;
+    return ((diff << 1) ^ (sign != 0 ? ~uint64_t(0) : 0)) & dump_codec_mask(size);
+}
+
+
+uint64_t dump_codec_unzigzag(uint64_t code, std::size_t size)
+{
+    return ((code >> 1) ^ ((code & 1) != 0 ? ~uint64_t(0) : 0)) & dump_codec_mask(size);
+}
+
+
+unsigned int dump_codec_significant_bytes(uint64_t word)
+{
+    unsigned int n = 0;
+    while (word != 0)
+        {
+            n++;
+            word >>= 8;
+        }
+    return n;
+}
+}  // namespace
+
+
+std::vector<std::size_t> gnss_dump_codec_field_sizes(const std::string& layout)
+{
+    std::vector<std::size_t> sizes;
+    sizes.reserve(layout.size());
+    for (const char field : layout)
+        {
+            switch (field)
+                {
+                case 'b':
+                case 'B':
+                    sizes.push_back(1);
+                    break;
+                case 'h':
+                case 'H':
+                    sizes.push_back(2);
+                    break;
+                case 'i':
+                case 'I':
+                case 'f':
+                    sizes.push_back(4);
+                    break;
+                case 'q':
+                case 'Q':
+                case 'd':
+                    sizes.push_back(8);
+                    break;
+                default:
+                    throw std::invalid_argument(std::string("invalid field in the dump record layout: ") + field);
+                }
+        }
+    return sizes;
+}
+
+
+void gnss_dump_codec_encode(const char* records, uint32_t n_records, const std::string& layout, std::vector<char>& payload)
+{
+    const std::vector<std::size_t> sizes = gnss_dump_codec_field_sizes(layout);
+    std::size_t record_size = 0;
+    for (const auto size : sizes)
+        {
+            record_size += size;
+        }
+    payload.clear();
+    std::size_t offset = 0;
+    for (std::size_t field = 0; field < sizes.size(); field++)
+        {
+            const std::size_t size = sizes[field];
+            const bool is_float = dump_codec_is_float(layout[field]);
+            const std::size_t counts_pos = payload.size();
+            payload.resize(counts_pos + (n_records + 1) / 2, 0);
+            uint64_t previous = 0;
+            for (uint32_t r = 0; r < n_records; r++)
+                {
+                    const uint64_t word = dump_codec_load(records + r * record_size + offset, size);
+                    const uint64_t code = is_float ? word ^ previous : dump_codec_zigzag((word - previous) & dump_codec_mask(size), size);
+                    previous = word;
+                    const unsigned int n = dump_codec_significant_bytes(code);
+                    payload[counts_pos + r / 2] |= static_cast<char>(n << (4 * (r % 2)));
+                    for (unsigned int k = 0; k < n; k++)
+                        {
+                            payload.push_back(static_cast<char>((code >> (8 * k)) & 0xFF));
+                        }
+                }
+            offset += size;
+        }
+}
+
+
+bool gnss_dump_codec_decode(const char* payload, std::size_t payload_size, uint32_t n_records, const std::string& layout, char* records)
+{
+    const std::vector<std::size_t> sizes = gnss_dump_codec_field_sizes(layout);
+    std::size_t record_size = 0;
+    for (const auto size : sizes)
+        {
+            record_size += size;
+        }
+    const auto* bytes = reinterpret_cast<const unsigned char*>(payload);
+    std::size_t pos = 0;
+    std::size_t offset = 0;
+    for (std::size_t field = 0; field < sizes.size(); field++)
+        {
+            const std::size_t size = sizes[field];
+            const bool is_float = dump_codec_is_float(layout[field]);
+            const std::size_t counts_pos = pos;
+            pos += (n_records + 1) / 2;
+            if (pos > payload_size)
+                {
+                    return false;
+                }
+            uint64_t previous = 0;
+            for (uint32_t r = 0; r < n_records; r++)
+                {
+                    const unsigned int n = (bytes[counts_pos + r / 2] >> (4 * (r % 2))) & 0x0F;
+                    if (n > size or pos + n > payload_size)
+                        {
+                            return false;
+                        }
+                    uint64_t code = 0;
+                    for (unsigned int k = 0; k < n; k++)
+                        {
+                            code |= static_cast<uint64_t>(bytes[pos + k]) << (8 * k);
+                        }
+                    pos += n;
+                    const uint64_t word = is_float ? code ^ previous : (previous + dump_codec_unzigzag(code, size)) & dump_codec_mask(size);
+                    previous = word;
+                    dump_codec_store(word, size, records + r * record_size + offset);
+                }
+            offset += size;
+        }
+    return pos == payload_size;
+}
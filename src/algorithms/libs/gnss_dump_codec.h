@@ -0,0 +1,73 @@
+/*!
+ * \file gnss_dump_codec.h
+ * \brief Columnar compression of the records of the dump files
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_DUMP_CODEC_H
+#define GNSS_SDR_GNSS_DUMP_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*
+ * A compressed dump file, in the byte order of the host, is:
+ *
+ *   "GNSSDMPC" | uint32 layout length | layout | chunk | chunk | ...
+ *
+ * where the layout has a character per field of the records (see
+ * Gnss_Dump_Writer::set_record_layout()), and each chunk is:
+ *
+ *   uint32 records | uint64 index of the first record | uint32 payload size | payload
+ *
+ * so the chunks can be skipped without decoding them. The payload has a
+ * column per field: in each one, the value of each record is replaced by
+ * its XOR with the one of the previous record (floating point fields) or by
+ * the zigzag-encoded difference with it (integer fields), starting from 0 in
+ * each chunk. Slowly varying values have many null high-order bytes after
+ * that, so the column stores the number of low-order bytes kept for each
+ * record, two per byte, followed by those bytes.
+ */
+constexpr char GNSS_DUMP_CODEC_MAGIC[] = "GNSSDMPC";
+constexpr std::size_t GNSS_DUMP_CODEC_MAGIC_SIZE = 8;
+constexpr std::size_t GNSS_DUMP_CODEC_CHUNK_HEADER_SIZE = sizeof(uint32_t) + sizeof(uint64_t) + sizeof(uint32_t);
+
+
+/*!
+ * \brief Size in bytes of each field of layout. Throws std::invalid_argument
+ * if a field is not valid.
+ */
+std::vector<std::size_t> gnss_dump_codec_field_sizes(const std::string& layout);
+
+/*!
+ * \brief Compresses n_records records into payload
+ */
+void gnss_dump_codec_encode(const char* records, uint32_t n_records, const std::string& layout, std::vector<char>& payload);
+
+/*!
+ * \brief Decompresses the n_records records of payload into records.
+ * Returns false if the payload is not valid.
+ */
+bool gnss_dump_codec_decode(const char* payload, std::size_t payload_size, uint32_t n_records, const std::string& layout, char* records);
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_DUMP_CODEC_H
@@ -0,0 +1,181 @@
+/*!
+ * \file gnss_dump_reader.cc
+ * \brief Reads the records of a dump file, plain or compressed, a chunk at
+ * a time.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_dump_reader.h"
+#include "gnss_dump_codec.h"
+#include <algorithm>  // for min
+#include <array>
+#include <cstring>  // for memcpy, memcmp
+#include <stdexcept>
+
+
+void Gnss_Dump_Reader::open(const std::string& filename, std::size_t record_size)
+{
+    close();
+    d_file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+    d_file.open(filename.c_str(), std::ios::in | std::ios::binary);
+    d_file.exceptions(std::ifstream::badbit);
+    d_record_size = record_size;
+    d_compressed = false;
+    d_layout.clear();
+
+    std::array<char, GNSS_DUMP_CODEC_MAGIC_SIZE> magic{};
+    uint32_t layout_size = 0;
+    if (d_file.read(magic.data(), magic.size()) and std::memcmp(magic.data(), GNSS_DUMP_CODEC_MAGIC, magic.size()) == 0 and
+        d_file.read(reinterpret_cast<char*>(&layout_size), sizeof(layout_size)) and layout_size < 1024)
+        {
+            d_layout.resize(layout_size);
+            d_file.read(&d_layout[0], layout_size);
+            std::size_t size = 0;
+            try
+                {
+                    for (const auto field_size : gnss_dump_codec_field_sizes(d_layout))
+                        {
+                            size += field_size;
+                        }
+                }
+            catch (const std::invalid_argument&)
+                {
+                    size = 0;
+                }
+            if (!d_file or size != record_size)
+                {
+                    close();
+                    throw std::ios_base::failure("the records of " + filename + " do not have the expected layout");
+                }
+            d_compressed = true;
+            d_data_start = d_file.tellg();
+        }
+    else
+        {
+            // a plain file
+            d_layout.clear();
+            d_file.clear();
+            d_data_start = 0;
+            d_file.seekg(0, std::ios::beg);
+        }
+    d_chunk.clear();
+    d_chunk_pos = 0;
+}
+
+
+void Gnss_Dump_Reader::close()
+{
+    if (d_file.is_open())
+        {
+            d_file.close();
+        }
+    d_file.clear();
+}
+
+
+bool Gnss_Dump_Reader::is_compressed() const
+{
+    return d_compressed;
+}
+
+
+const std::string& Gnss_Dump_Reader::layout() const
+{
+    return d_layout;
+}
+
+
+uint64_t Gnss_Dump_Reader::records()
+{
+    const std::streamoff pos = d_file.tellg();
+    uint64_t n = 0;
+    if (!d_compressed)
+        {
+            d_file.seekg(0, std::ios::end);
+            n = static_cast<uint64_t>(d_file.tellg() - d_data_start) / d_record_size;
+        }
+    else
+        {
+            d_file.seekg(d_data_start, std::ios::beg);
+            uint32_t n_records = 0;
+            uint64_t first_record = 0;
+            uint32_t payload_size = 0;
+            while (d_file.read(reinterpret_cast<char*>(&n_records), sizeof(n_records)) and
+                   d_file.read(reinterpret_cast<char*>(&first_record), sizeof(first_record)) and
+                   d_file.read(reinterpret_cast<char*>(&payload_size), sizeof(payload_size)) and
+                   d_file.seekg(payload_size, std::ios::cur))
+                {
+                    n = first_record + n_records;
+                }
+        }
+    d_file.clear();
+    d_file.seekg(pos, std::ios::beg);
+    return n;
+}
+
+
+std::size_t Gnss_Dump_Reader::read(void* records, std::size_t max_records)
+{
+    auto* dest = static_cast<char*>(records);
+    if (!d_compressed)
+        {
+            d_file.read(dest, static_cast<std::streamsize>(max_records * d_record_size));
+            const auto n = static_cast<std::size_t>(d_file.gcount()) / d_record_size;
+            d_file.clear();
+            return n;
+        }
+    std::size_t n = 0;
+    while (n < max_records)
+        {
+            if (d_chunk_pos == d_chunk.size() and !read_chunk())
+                {
+                    break;
+                }
+            const std::size_t available = (d_chunk.size() - d_chunk_pos) / d_record_size;
+            const std::size_t m = std::min(available, max_records - n);
+            std::memcpy(dest + n * d_record_size, d_chunk.data() + d_chunk_pos, m * d_record_size);
+            d_chunk_pos += m * d_record_size;
+            n += m;
+        }
+    return n;
+}
+
+
+bool Gnss_Dump_Reader::read_chunk()
+{
+    uint32_t n_records = 0;
+    uint64_t first_record = 0;
+    uint32_t payload_size = 0;
+    if (!d_file.read(reinterpret_cast<char*>(&n_records), sizeof(n_records)) or
+        !d_file.read(reinterpret_cast<char*>(&first_record), sizeof(first_record)) or
+        !d_file.read(reinterpret_cast<char*>(&payload_size), sizeof(payload_size)))
+        {
+            d_file.clear();
+            return false;
+        }
+    d_payload.resize(payload_size);
+    d_chunk.resize(static_cast<std::size_t>(n_records) * d_record_size);
+    d_chunk_pos = 0;
+    if (!d_file.read(d_payload.data(), payload_size))
+        {
+            // the last chunk of a file still being written
+            d_file.clear();
+            d_chunk.clear();
+            return false;
+        }
+    if (!gnss_dump_codec_decode(d_payload.data(), d_payload.size(), n_records, d_layout, d_chunk.data()))
+        {
+            d_chunk.clear();
+            throw std::ios_base::failure("corrupt chunk in the dump file, starting at the record " + std::to_string(first_record));
+        }
+    return true;
+}
@@ -0,0 +1,90 @@
+/*!
+ * \file gnss_dump_reader.h
+ * \brief Reads the records of a dump file, plain or compressed, a chunk at
+ * a time.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_DUMP_READER_H
+#define GNSS_SDR_GNSS_DUMP_READER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Reader of the dump files written by Gnss_Dump_Writer.
+ *
+ * The records are returned as they were written, whether the file is plain
+ * or compressed (see gnss_dump_codec.h), and only a chunk of them is kept
+ * in memory, so files larger than the memory can be converted.
+ *
+ * Errors are reported as std::ios_base::failure exceptions.
+ */
+class Gnss_Dump_Reader
+{
+public:
+    Gnss_Dump_Reader() = default;
+
+    /*!
+     * \brief Opens the file, with records of record_size bytes. Throws if
+     * the file cannot be opened, or if it is compressed with records of
+     * another size.
+     */
+    void open(const std::string& filename, std::size_t record_size);
+
+    void close();
+
+    bool is_compressed() const;
+
+    /*!
+     * \brief Layout of the records of a compressed file, or empty
+     */
+    const std::string& layout() const;
+
+    /*!
+     * \brief Number of records in the file. For compressed files, the chunk
+     * headers are read without decoding them.
+     */
+    uint64_t records();
+
+    /*!
+     * \brief Copies to records up to max_records of the next records.
+     * Returns the number of records copied, 0 at the end of the file.
+     */
+    std::size_t read(void* records, std::size_t max_records);
+
+private:
+    bool read_chunk();
+
+    std::ifstream d_file;
+    std::string d_layout;
+    std::size_t d_record_size{0};
+    std::streamoff d_data_start{0};  // first record or chunk
+    std::vector<char> d_payload;
+    std::vector<char> d_chunk;  // decoded records of the current chunk
+    std::size_t d_chunk_pos{0};
+    bool d_compressed{false};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_DUMP_READER_H
@@ -0,0 +1,342 @@
+/*!
+ * \file gnss_dump_writer.cc
+ * \brief Buffered binary dump file, written to disk by a background thread
+ * shared by all the dump files of the receiver.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_dump_writer.h"
+#include "gnss_dump_codec.h"
+#include "gnss_thread_sched.h"
+#include <glog/logging.h>
+#include <algorithm>  // for std::min, std::max
+#include <cstring>    // for memcpy
+#include <exception>
+#include <thread>
+
+
+/*!
+ * \brief Background thread writing the full blocks of all the dump files
+ */
+class Gnss_Dump_Writer_Service
+{
+public:
+    /*!
+     * \brief Returns the service, which is created if it does not exist. It
+     * is destroyed when the last dump file using it is closed.
+     */
+    static std::shared_ptr<Gnss_Dump_Writer_Service> get();
+
+    Gnss_Dump_Writer_Service();
+    ~Gnss_Dump_Writer_Service();
+
+    Gnss_Dump_Writer_Service(const Gnss_Dump_Writer_Service&) = delete;
+    Gnss_Dump_Writer_Service& operator=(const Gnss_Dump_Writer_Service&) = delete;
+
+    void submit(Gnss_Dump_Writer* writer, std::size_t block, std::size_t size);
+
+private:
+    struct Job
+    {
+        Gnss_Dump_Writer* writer;
+        std::size_t block;
+        std::size_t size;
+    };
+
+    void run();
+
+    std::mutex d_mutex;
+    std::condition_variable d_cond;
+    std::vector<Job> d_jobs;
+    bool d_stop{false};
+    std::thread d_thread;
+};
+
+
+std::shared_ptr<Gnss_Dump_Writer_Service> Gnss_Dump_Writer_Service::get()
+{
+    static std::mutex service_mutex;
+    static std::weak_ptr<Gnss_Dump_Writer_Service> service;
+    std::lock_guard<std::mutex> lock(service_mutex);
+    auto s = service.lock();
+    if (s == nullptr)
+        {
+            s = std::make_shared<Gnss_Dump_Writer_Service>();
+            service = s;
+        }
+    return s;
+}
+
+
+Gnss_Dump_Writer_Service::Gnss_Dump_Writer_Service()
+    : d_thread(&Gnss_Dump_Writer_Service::run, this)
+{
+}
+
+
+Gnss_Dump_Writer_Service::~Gnss_Dump_Writer_Service()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_stop = true;
+    }
+    d_cond.notify_one();
+    d_thread.join();
+}
+
+
+void Gnss_Dump_Writer_Service::submit(Gnss_Dump_Writer* writer, std::size_t block, std::size_t size)
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_jobs.push_back({writer, block, size});
+    }
+    d_cond.notify_one();
+}
+
+
+void Gnss_Dump_Writer_Service::run()
+{
+    gnss_apply_helper_thread_sched("dump writer");
+    std::vector<Job> jobs;
+    while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(d_mutex);
+                d_cond.wait(lock, [this] { return d_stop or !d_jobs.empty(); });
+                if (d_jobs.empty())
+                    {
+                        return;
+                    }
+                jobs.swap(d_jobs);
+            }
+            for (const auto& job : jobs)
+                {
+                    // the processing thread does not use the file while it has pending blocks
+                    Gnss_Dump_Writer* w = job.writer;
+                    w->d_file.write(w->d_blocks[job.block].data(), static_cast<std::streamsize>(job.size));
+                    const bool error = !w->d_file;
+                    // (notified with the lock held, since the writer can be destroyed once it is released)
+                    std::lock_guard<std::mutex> lock(w->d_mutex);
+                    w->d_free_blocks.push_back(job.block);
+                    w->d_pending_blocks--;
+                    w->d_error = w->d_error or error;
+                    w->d_cond.notify_all();
+                }
+            jobs.clear();
+        }
+}
+
+
+Gnss_Dump_Writer::Gnss_Dump_Writer(std::size_t block_size, int n_blocks)
+    : d_block_size(std::max<std::size_t>(block_size, 1)),
+      d_n_blocks(std::max(n_blocks, 2))
+{
+}
+
+
+Gnss_Dump_Writer::~Gnss_Dump_Writer()
+{
+    try
+        {
+            close();
+        }
+    catch (const std::exception& e)
+        {
+            LOG(WARNING) << "Exception closing the dump file: " << e.what();
+        }
+}
+
+
+void Gnss_Dump_Writer::set_record_layout(const std::string& layout, uint32_t chunk_records)
+{
+    gnss_dump_codec_field_sizes(layout);  // throws if it is not valid
+    d_next_layout = layout;
+    d_next_chunk_records = std::max<uint32_t>(chunk_records, 1);
+}
+
+
+void Gnss_Dump_Writer::open(const std::string& filename)
+{
+    close();
+    d_file.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+    d_file.open(filename.c_str(), std::ios::out | std::ios::binary);
+    // the writes of the background thread are checked with the state of the stream
+    d_file.exceptions(std::ofstream::goodbit);
+
+    if (d_blocks.empty())
+        {
+            d_blocks.assign(d_n_blocks, std::vector<char>(d_block_size));
+            d_free_blocks.reserve(d_n_blocks);
+        }
+    d_free_blocks.clear();
+    for (int i = 1; i < d_n_blocks; i++)
+        {
+            d_free_blocks.push_back(i);
+        }
+    d_fill_block = 0;
+    d_fill_pos = 0;
+    d_bytes_written = 0;
+    d_error = false;
+    d_service = Gnss_Dump_Writer_Service::get();
+
+    d_layout = d_next_layout;
+    d_chunk_records = d_next_chunk_records;
+    d_record_size = 0;
+    for (const auto size : gnss_dump_codec_field_sizes(d_layout))
+        {
+            d_record_size += size;
+        }
+    d_chunk.clear();
+    d_first_record = 0;
+    if (!d_layout.empty())
+        {
+            d_chunk.reserve(d_record_size * d_chunk_records);
+            const auto layout_size = static_cast<uint32_t>(d_layout.size());
+            write_to_blocks(GNSS_DUMP_CODEC_MAGIC, GNSS_DUMP_CODEC_MAGIC_SIZE);
+            write_to_blocks(&layout_size, sizeof(layout_size));
+            write_to_blocks(d_layout.data(), d_layout.size());
+        }
+}
+
+
+bool Gnss_Dump_Writer::is_open() const
+{
+    return d_file.is_open();
+}
+
+
+void Gnss_Dump_Writer::close()
+{
+    if (!d_file.is_open())
+        {
+            return;
+        }
+    if (!d_chunk.empty())
+        {
+            write_chunk();
+        }
+    if (d_fill_pos > 0)
+        {
+            submit_block();
+        }
+    wait_pending_blocks();
+    d_file.close();
+    d_service.reset();
+    check_error();
+}
+
+
+void Gnss_Dump_Writer::write(const void* data, std::size_t size)
+{
+    if (!d_file.is_open())
+        {
+            throw std::ios_base::failure("the dump file is not open");
+        }
+    check_error();
+    d_bytes_written += size;
+    if (d_layout.empty())
+        {
+            write_to_blocks(data, size);
+            return;
+        }
+    const auto* bytes = static_cast<const char*>(data);
+    const std::size_t chunk_size = d_record_size * d_chunk_records;
+    while (size > 0)
+        {
+            const std::size_t n = std::min(size, chunk_size - d_chunk.size());
+            d_chunk.insert(d_chunk.end(), bytes, bytes + n);
+            bytes += n;
+            size -= n;
+            if (d_chunk.size() == chunk_size)
+                {
+                    write_chunk();
+                }
+        }
+}
+
+
+void Gnss_Dump_Writer::write_to_blocks(const void* data, std::size_t size)
+{
+    const auto* bytes = static_cast<const char*>(data);
+    while (size > 0)
+        {
+            if (d_fill_pos == d_block_size)
+                {
+                    submit_block();
+                }
+            const std::size_t n = std::min(size, d_block_size - d_fill_pos);
+            std::memcpy(d_blocks[d_fill_block].data() + d_fill_pos, bytes, n);
+            d_fill_pos += n;
+            bytes += n;
+            size -= n;
+        }
+}
+
+
+void Gnss_Dump_Writer::write_chunk()
+{
+    // (an incomplete record at the end of the file is dropped, as readers of plain files do)
+    const auto n_records = static_cast<uint32_t>(d_chunk.size() / d_record_size);
+    if (n_records > 0)
+        {
+            gnss_dump_codec_encode(d_chunk.data(), n_records, d_layout, d_encoded_chunk);
+            const auto payload_size = static_cast<uint32_t>(d_encoded_chunk.size());
+            write_to_blocks(&n_records, sizeof(n_records));
+            write_to_blocks(&d_first_record, sizeof(d_first_record));
+            write_to_blocks(&payload_size, sizeof(payload_size));
+            write_to_blocks(d_encoded_chunk.data(), d_encoded_chunk.size());
+            d_first_record += n_records;
+        }
+    d_chunk.clear();
+}
+
+
+uint64_t Gnss_Dump_Writer::bytes_written() const
+{
+    return d_bytes_written;
+}
+
+
+void Gnss_Dump_Writer::submit_block()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_pending_blocks++;
+    }
+    d_service->submit(this, d_fill_block, d_fill_pos);
+
+    // take a free block, waiting for the disk only if all of them are pending
+    std::unique_lock<std::mutex> lock(d_mutex);
+    d_cond.wait(lock, [this] { return !d_free_blocks.empty(); });
+    d_fill_block = d_free_blocks.back();
+    d_free_blocks.pop_back();
+    d_fill_pos = 0;
+}
+
+
+void Gnss_Dump_Writer::wait_pending_blocks()
+{
+    std::unique_lock<std::mutex> lock(d_mutex);
+    d_cond.wait(lock, [this] { return d_pending_blocks == 0; });
+}
+
+
+void Gnss_Dump_Writer::check_error()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    if (d_error)
+        {
+            d_error = false;
+            throw std::ios_base::failure("error writing the dump file");
+        }
+}
@@ -0,0 +1,136 @@
+/*!
+ * \file gnss_dump_writer.h
+ * \brief Buffered binary dump file, written to disk by a background thread
+ * shared by all the dump files of the receiver.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_DUMP_WRITER_H
+#define GNSS_SDR_GNSS_DUMP_WRITER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+class Gnss_Dump_Writer_Service;
+
+
+/*!
+ * \brief Binary dump file of a processing block.
+ *
+ * The values written are copied to a block of memory, and full blocks are
+ * written to the file by a background thread shared by all the dump files,
+ * so the processing thread never waits for the disk unless all the blocks
+ * of the file are pending. The contents of the file are the same as if the
+ * values were written one by one with std::ofstream::write().
+ *
+ * Errors are reported as std::ios_base::failure exceptions: open() throws if
+ * the file cannot be created, and write() and close() throw if a previous
+ * write to the disk failed.
+ *
+ * With a record layout, the file is instead written in the compressed
+ * format read by Gnss_Dump_Reader (see gnss_dump_reader.h).
+ */
+class Gnss_Dump_Writer
+{
+public:
+    explicit Gnss_Dump_Writer(std::size_t block_size = 32768, int n_blocks = 4);
+    ~Gnss_Dump_Writer();
+
+    Gnss_Dump_Writer(const Gnss_Dump_Writer&) = delete;
+    Gnss_Dump_Writer& operator=(const Gnss_Dump_Writer&) = delete;
+
+    /*!
+     * \brief Compresses the records of the files opened from now on. layout
+     * has a character per field of the records, in the order they are
+     * written, as in the Python struct module: 'b', 'B', 'h', 'H', 'i', 'I',
+     * 'q' and 'Q' for integers of 8, 16, 32 and 64 bits, 'f' for float and
+     * 'd' for double. An empty layout writes plain files again. Throws
+     * std::invalid_argument if a character is not one of those.
+     */
+    void set_record_layout(const std::string& layout, uint32_t chunk_records = 4096);
+
+    void open(const std::string& filename);
+    bool is_open() const;
+
+    /*!
+     * \brief Writes the pending blocks to the file and closes it
+     */
+    void close();
+
+    void write(const void* data, std::size_t size);
+
+    template <typename T>
+    void write(const T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable values can be dumped");
+        write(&value, sizeof(T));
+    }
+
+    /*!
+     * \brief Number of bytes written since the file was opened, including
+     * the ones still pending. With a record layout, these are the bytes of
+     * the records, before compression.
+     */
+    uint64_t bytes_written() const;
+
+private:
+    friend class Gnss_Dump_Writer_Service;
+    void write_to_blocks(const void* data, std::size_t size);
+    void write_chunk();
+    void submit_block();
+    void wait_pending_blocks();
+    void check_error();
+
+    std::shared_ptr<Gnss_Dump_Writer_Service> d_service;
+    std::ofstream d_file;
+    std::vector<std::vector<char>> d_blocks;  // allocated when the file is opened
+    std::size_t d_block_size;
+    int d_n_blocks;
+    std::size_t d_fill_block{0};
+    std::size_t d_fill_pos{0};
+    uint64_t d_bytes_written{0};
+
+    // records of the compressed files
+    std::string d_next_layout;  // for the next file opened
+    uint32_t d_next_chunk_records{0};
+    std::string d_layout;
+    std::size_t d_record_size{0};
+    uint32_t d_chunk_records{0};
+    std::vector<char> d_chunk;  // records not compressed yet
+    std::vector<char> d_encoded_chunk;
+    uint64_t d_first_record{0};
+
+    // blocks returned by the background thread
+    std::mutex d_mutex;
+    std::condition_variable d_cond;
+    std::vector<std::size_t> d_free_blocks;
+    int d_pending_blocks{0};
+    bool d_error{false};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_DUMP_WRITER_H
@@ -0,0 +1,186 @@
+/*!
+ * \file gnss_nav_product_channel.cc
+ * \brief Lock-free delivery of the navigation data decoded by the telemetry
+ * decoders (ephemeris, almanac, iono and UTC models) to the PVT block.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_nav_product_channel.h"
+#include <glog/logging.h>
+#include <algorithm>  // for std::remove_if
+#include <mutex>
+
+
+namespace
+{
+std::mutex registry_mutex;
+std::vector<std::weak_ptr<Gnss_Nav_Product_Channel>> registry;
+std::atomic<uint64_t> registry_generation{1};
+}  // namespace
+
+
+Gnss_Nav_Product_Channel::Gnss_Nav_Product_Channel(uint32_t capacity) : d_ring(capacity)
+{
+}
+
+
+std::shared_ptr<Gnss_Nav_Product_Channel> Gnss_Nav_Product_Channel::create(uint32_t capacity)
+{
+    auto channel = std::make_shared<Gnss_Nav_Product_Channel>(capacity);
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    registry.erase(std::remove_if(registry.begin(), registry.end(),
+                       [](const std::weak_ptr<Gnss_Nav_Product_Channel>& c) { return c.expired(); }),
+        registry.end());
+    registry.push_back(channel);
+    registry_generation.fetch_add(1, std::memory_order_release);
+    return channel;
+}
+
+
+void Gnss_Nav_Product_Channel::push(const Gnss_Nav_Product& product)
+{
+    if (!d_overflowed.load(std::memory_order_acquire))
+        {
+            const uint64_t head = d_head.load(std::memory_order_relaxed);
+            if (head - d_tail.load(std::memory_order_acquire) < d_ring.size())
+                {
+                    d_ring[head % d_ring.size()] = product;
+                    d_head.store(head + 1, std::memory_order_release);
+                    return;
+                }
+        }
+    push_overflow(product);
+}
+
+
+void Gnss_Nav_Product_Channel::push_overflow(const Gnss_Nav_Product& product)
+{
+    std::lock_guard<std::mutex> lock(d_overflow_mutex);
+    if (!d_overflowed.load(std::memory_order_relaxed))
+        {
+            // the consumer may have taken the overflow list in the meantime
+            const uint64_t head = d_head.load(std::memory_order_relaxed);
+            if (head - d_tail.load(std::memory_order_acquire) < d_ring.size())
+                {
+                    d_ring[head % d_ring.size()] = product;
+                    d_head.store(head + 1, std::memory_order_release);
+                    return;
+                }
+            LOG(WARNING) << "Navigation product channel full, the latest product of each type and satellite is kept until the PVT reads them";
+        }
+    const auto key = std::make_pair(product.type(), product.prn());
+    const auto pending = d_overflow_index.find(key);
+    if (pending != d_overflow_index.cend())
+        {
+            d_overflow[pending->second] = product;
+            d_replaced++;
+        }
+    else
+        {
+            d_overflow_index[key] = d_overflow.size();
+            d_overflow.push_back(product);
+        }
+    d_overflowed.store(true, std::memory_order_release);
+}
+
+
+bool Gnss_Nav_Product_Channel::pop(Gnss_Nav_Product& product)
+{
+    // the overflow list being read is older than what is in the ring
+    if (d_taken_next == d_taken.size())
+        {
+            if (pop_ring(product))
+                {
+                    return true;
+                }
+            if (!take_overflow())
+                {
+                    // the ring may have been filled in the meantime
+                    return pop_ring(product);
+                }
+        }
+    product = std::move(d_taken[d_taken_next]);
+    d_taken_next++;
+    if (d_taken_next == d_taken.size())
+        {
+            d_taken.clear();
+            d_taken_next = 0;
+        }
+    return true;
+}
+
+
+uint64_t Gnss_Nav_Product_Channel::replaced() const
+{
+    std::lock_guard<std::mutex> lock(d_overflow_mutex);
+    return d_replaced;
+}
+
+
+bool Gnss_Nav_Product_Channel::pop_ring(Gnss_Nav_Product& product)
+{
+    const uint64_t tail = d_tail.load(std::memory_order_relaxed);
+    if (tail == d_head.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+    product = std::move(d_ring[tail % d_ring.size()]);
+    d_ring[tail % d_ring.size()] = Gnss_Nav_Product();
+    d_tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+
+bool Gnss_Nav_Product_Channel::take_overflow()
+{
+    if (!d_overflowed.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+    std::lock_guard<std::mutex> lock(d_overflow_mutex);
+    // the producer does not add to the ring while the overflow list is
+    // pending, and what is left in the ring was pushed before it
+    if (d_tail.load(std::memory_order_relaxed) != d_head.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+    d_taken.swap(d_overflow);
+    d_taken_next = 0;
+    d_overflow_index.clear();
+    d_overflowed.store(false, std::memory_order_release);
+    return true;
+}
+
+
+void Gnss_Nav_Product_Reader::drain(std::vector<Gnss_Nav_Product>& products)
+{
+    const uint64_t generation = registry_generation.load(std::memory_order_acquire);
+    if (generation != d_generation)
+        {
+            // a channel was created since the last call
+            std::lock_guard<std::mutex> lock(registry_mutex);
+            d_channels = registry;
+            d_generation = registry_generation.load(std::memory_order_relaxed);
+        }
+    Gnss_Nav_Product product;
+    for (const auto& weak_channel : d_channels)
+        {
+            const auto channel = weak_channel.lock();
+            if (channel != nullptr)
+                {
+                    while (channel->pop(product))
+                        {
+                            products.push_back(std::move(product));
+                        }
+                }
+        }
+}
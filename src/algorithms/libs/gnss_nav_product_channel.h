@@ -0,0 +1,259 @@
+/*!
+ * \file gnss_nav_product_channel.h
+ * \brief Lock-free delivery of the navigation data decoded by the telemetry
+ * decoders (ephemeris, almanac, iono and UTC models) to the PVT block.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_NAV_PRODUCT_CHANNEL_H
+#define GNSS_SDR_GNSS_NAV_PRODUCT_CHANNEL_H
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+class Beidou_Dnav_Almanac;
+class Beidou_Dnav_Ephemeris;
+class Beidou_Dnav_Iono;
+class Beidou_Dnav_Utc_Model;
+class Galileo_Almanac;
+class Galileo_Almanac_Helper;
+class Galileo_Ephemeris;
+class Galileo_Iono;
+class Galileo_Utc_Model;
+class Glonass_Gnav_Almanac;
+class Glonass_Gnav_Ephemeris;
+class Glonass_Gnav_Utc_Model;
+class Gps_Almanac;
+class Gps_CNAV_Ephemeris;
+class Gps_CNAV_Iono;
+class Gps_CNAV_Utc_Model;
+class Gps_Ephemeris;
+class Gps_Iono;
+class Gps_Utc_Model;
+
+
+/*!
+ * \brief Types of navigation products
+ */
+enum Gnss_Nav_Product_Type
+{
+    NAV_NONE,
+    NAV_GPS_EPHEMERIS,
+    NAV_GPS_IONO,
+    NAV_GPS_UTC_MODEL,
+    NAV_GPS_CNAV_EPHEMERIS,
+    NAV_GPS_CNAV_IONO,
+    NAV_GPS_CNAV_UTC_MODEL,
+    NAV_GPS_ALMANAC,
+    NAV_GALILEO_EPHEMERIS,
+    NAV_GALILEO_IONO,
+    NAV_GALILEO_UTC_MODEL,
+    NAV_GALILEO_ALMANAC_HELPER,
+    NAV_GALILEO_ALMANAC,
+    NAV_GLONASS_GNAV_EPHEMERIS,
+    NAV_GLONASS_GNAV_UTC_MODEL,
+    NAV_GLONASS_GNAV_ALMANAC,
+    NAV_BEIDOU_DNAV_EPHEMERIS,
+    NAV_BEIDOU_DNAV_IONO,
+    NAV_BEIDOU_DNAV_UTC_MODEL,
+    NAV_BEIDOU_DNAV_ALMANAC
+};
+
+
+/*!
+ * \brief Compile-time type index of the navigation products
+ */
+template <typename T>
+struct Gnss_Nav_Product_Traits;
+
+// clang-format off
+template <> struct Gnss_Nav_Product_Traits<Gps_Ephemeris> { static constexpr Gnss_Nav_Product_Type type = NAV_GPS_EPHEMERIS; };
+template <> struct Gnss_Nav_Product_Traits<Gps_Iono> { static constexpr Gnss_Nav_Product_Type type = NAV_GPS_IONO; };
+template <> struct Gnss_Nav_Product_Traits<Gps_Utc_Model> { static constexpr Gnss_Nav_Product_Type type = NAV_GPS_UTC_MODEL; };
+template <> struct Gnss_Nav_Product_Traits<Gps_CNAV_Ephemeris> { static constexpr Gnss_Nav_Product_Type type = NAV_GPS_CNAV_EPHEMERIS; };
+template <> struct Gnss_Nav_Product_Traits<Gps_CNAV_Iono> { static constexpr Gnss_Nav_Product_Type type = NAV_GPS_CNAV_IONO; };
+template <> struct Gnss_Nav_Product_Traits<Gps_CNAV_Utc_Model> { static constexpr Gnss_Nav_Product_Type type = NAV_GPS_CNAV_UTC_MODEL; };
+template <> struct Gnss_Nav_Product_Traits<Gps_Almanac> { static constexpr Gnss_Nav_Product_Type type = NAV_GPS_ALMANAC; };
+template <> struct Gnss_Nav_Product_Traits<Galileo_Ephemeris> { static constexpr Gnss_Nav_Product_Type type = NAV_GALILEO_EPHEMERIS; };
+template <> struct Gnss_Nav_Product_Traits<Galileo_Iono> { static constexpr Gnss_Nav_Product_Type type = NAV_GALILEO_IONO; };
+template <> struct Gnss_Nav_Product_Traits<Galileo_Utc_Model> { static constexpr Gnss_Nav_Product_Type type = NAV_GALILEO_UTC_MODEL; };
+template <> struct Gnss_Nav_Product_Traits<Galileo_Almanac_Helper> { static constexpr Gnss_Nav_Product_Type type = NAV_GALILEO_ALMANAC_HELPER; };
+template <> struct Gnss_Nav_Product_Traits<Galileo_Almanac> { static constexpr Gnss_Nav_Product_Type type = NAV_GALILEO_ALMANAC; };
+template <> struct Gnss_Nav_Product_Traits<Glonass_Gnav_Ephemeris> { static constexpr Gnss_Nav_Product_Type type = NAV_GLONASS_GNAV_EPHEMERIS; };
+template <> struct Gnss_Nav_Product_Traits<Glonass_Gnav_Utc_Model> { static constexpr Gnss_Nav_Product_Type type = NAV_GLONASS_GNAV_UTC_MODEL; };
+template <> struct Gnss_Nav_Product_Traits<Glonass_Gnav_Almanac> { static constexpr Gnss_Nav_Product_Type type = NAV_GLONASS_GNAV_ALMANAC; };
+template <> struct Gnss_Nav_Product_Traits<Beidou_Dnav_Ephemeris> { static constexpr Gnss_Nav_Product_Type type = NAV_BEIDOU_DNAV_EPHEMERIS; };
+template <> struct Gnss_Nav_Product_Traits<Beidou_Dnav_Iono> { static constexpr Gnss_Nav_Product_Type type = NAV_BEIDOU_DNAV_IONO; };
+template <> struct Gnss_Nav_Product_Traits<Beidou_Dnav_Utc_Model> { static constexpr Gnss_Nav_Product_Type type = NAV_BEIDOU_DNAV_UTC_MODEL; };
+template <> struct Gnss_Nav_Product_Traits<Beidou_Dnav_Almanac> { static constexpr Gnss_Nav_Product_Type type = NAV_BEIDOU_DNAV_ALMANAC; };
+// clang-format on
+
+
+/*!
+ * \brief Navigation product, tagged with its type
+ */
+class Gnss_Nav_Product
+{
+public:
+    Gnss_Nav_Product() = default;
+
+    template <typename T>
+    explicit Gnss_Nav_Product(std::shared_ptr<T> object) : d_object(std::move(object)),
+                                                           d_type(Gnss_Nav_Product_Traits<T>::type),
+                                                           d_prn(d_object == nullptr ? 0U : prn_of(*static_cast<const T*>(d_object.get()), 0))
+    {
+    }
+
+    inline Gnss_Nav_Product_Type type() const
+    {
+        return d_type;
+    }
+
+    /*!
+     * \brief PRN of the satellite the product belongs to, or 0 for the
+     * products that are not of a satellite (iono and UTC models)
+     */
+    inline uint32_t prn() const
+    {
+        return d_prn;
+    }
+
+    /*!
+     * \brief Returns the product, or nullptr if it is not of type T
+     */
+    template <typename T>
+    inline std::shared_ptr<T> get() const
+    {
+        if (d_type != Gnss_Nav_Product_Traits<T>::type)
+            {
+                return nullptr;
+            }
+        return std::static_pointer_cast<T>(d_object);
+    }
+
+private:
+    template <typename T>
+    static auto prn_of(const T& object, int) -> decltype(static_cast<uint32_t>(object.PRN))
+    {
+        return static_cast<uint32_t>(object.PRN);
+    }
+
+    template <typename T>
+    static uint32_t prn_of(const T& /*object*/, long)
+    {
+        return 0;
+    }
+
+    std::shared_ptr<void> d_object;
+    Gnss_Nav_Product_Type d_type{NAV_NONE};
+    uint32_t d_prn{0};
+};
+
+
+/*!
+ * \brief Single-producer, single-consumer ring of navigation products.
+ *
+ * Each producer (a telemetry decoder, or the receiver control thread for
+ * assisted data) owns a channel, and the PVT block drains all of them through
+ * a Gnss_Nav_Product_Reader. push() and pop() take no locks and do not
+ * allocate memory while the ring has room.
+ *
+ * No product is discarded when the ring is full, since an ephemeris may not
+ * be broadcast again for tens of seconds. The products are then kept, under
+ * a lock, in an overflow list that holds the latest product of each type and
+ * satellite: a newer one replaces the pending one, as the PVT would do. The
+ * ring is not used again until the consumer has taken the overflow list, so
+ * that the products are read in the order they were pushed.
+ */
+class Gnss_Nav_Product_Channel
+{
+public:
+    explicit Gnss_Nav_Product_Channel(uint32_t capacity);
+
+    /*!
+     * \brief Creates a channel and registers it, so that the readers drain
+     * it. It is unregistered when it is destroyed.
+     */
+    static std::shared_ptr<Gnss_Nav_Product_Channel> create(uint32_t capacity = 64);
+
+    /*!
+     * \brief Adds a product. It must be called by the producer only.
+     */
+    void push(const Gnss_Nav_Product& product);
+
+    /*!
+     * \brief Takes the oldest product. It must be called by the consumer
+     * only. Returns false if the channel is empty.
+     */
+    bool pop(Gnss_Nav_Product& product);
+
+    /*!
+     * \brief Products replaced in the overflow list by a newer one of the
+     * same type and satellite
+     */
+    uint64_t replaced() const;
+
+private:
+    void push_overflow(const Gnss_Nav_Product& product);
+    bool pop_ring(Gnss_Nav_Product& product);
+    bool take_overflow();  // moves the overflow list to d_taken once the ring is empty
+
+    std::vector<Gnss_Nav_Product> d_ring;
+    std::atomic<uint64_t> d_head{0};  // written by the producer
+    std::atomic<uint64_t> d_tail{0};  // written by the consumer
+
+    // products pushed while the ring was full, by type and PRN
+    mutable std::mutex d_overflow_mutex;
+    std::vector<Gnss_Nav_Product> d_overflow;
+    std::map<std::pair<Gnss_Nav_Product_Type, uint32_t>, size_t> d_overflow_index;
+    std::atomic<bool> d_overflowed{false};  // set by the producer, cleared by the consumer
+    uint64_t d_replaced{0};
+
+    // overflow list being read by the consumer
+    std::vector<Gnss_Nav_Product> d_taken;
+    size_t d_taken_next{0};
+};
+
+
+/*!
+ * \brief Consumer of all the registered navigation product channels. There
+ * must be a single reader in the process, which is the PVT block.
+ */
+class Gnss_Nav_Product_Reader
+{
+public:
+    /*!
+     * \brief Appends the products waiting in all the channels to products,
+     * in the order they were pushed in each channel
+     */
+    void drain(std::vector<Gnss_Nav_Product>& products);
+
+private:
+    std::vector<std::weak_ptr<Gnss_Nav_Product_Channel>> d_channels;
+    uint64_t d_generation{0};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_NAV_PRODUCT_CHANNEL_H
@@ -0,0 +1,148 @@
+/*!
+ * \file gnss_navigation_state.cc
+ * \brief Navigation state published by the PVT block once per epoch, and read
+ * by the tracking channels for vector tracking aiding.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_navigation_state.h"
+#include <mutex>
+#include <thread>
+
+
+std::shared_ptr<Gnss_Navigation_State> Gnss_Navigation_State::get()
+{
+    static std::mutex state_mutex;
+    static std::weak_ptr<Gnss_Navigation_State> weak;
+    std::lock_guard<std::mutex> lock(state_mutex);
+    auto state = weak.lock();
+    if (state == nullptr)
+        {
+            state = std::make_shared<Gnss_Navigation_State>();
+            weak = state;
+        }
+    return state;
+}
+
+
+bool Gnss_Navigation_State::has_readers() const
+{
+    return d_readers.load(std::memory_order_relaxed) > 0;
+}
+
+
+void Gnss_Navigation_State::begin_epoch()
+{
+    const uint64_t sequence = d_sequence.load(std::memory_order_relaxed);
+    d_sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+
+void Gnss_Navigation_State::set_receiver(const Gnss_Receiver_State& receiver)
+{
+    for (int i = 0; i < 3; i++)
+        {
+            d_receiver[i].store(receiver.pos_ecef_m[i], std::memory_order_relaxed);
+            d_receiver[3 + i].store(receiver.vel_ecef_m_s[i], std::memory_order_relaxed);
+        }
+    d_receiver[6].store(receiver.clock_offset_s, std::memory_order_relaxed);
+    d_receiver[7].store(receiver.clock_drift_ppm, std::memory_order_relaxed);
+    d_receiver[8].store(receiver.rx_time_s, std::memory_order_relaxed);
+    d_sample_counter.store(receiver.sample_counter, std::memory_order_relaxed);
+}
+
+
+void Gnss_Navigation_State::set_channel(uint32_t channel, const Gnss_Channel_Assistance& assistance)
+{
+    if (channel >= max_channels)
+        {
+            return;
+        }
+    Channel_Slot& slot = d_channels[channel];
+    slot.pseudorange_rate_m_s.store(assistance.pseudorange_rate_m_s, std::memory_order_relaxed);
+    slot.PRN.store(assistance.PRN, std::memory_order_relaxed);
+    slot.System.store(assistance.System, std::memory_order_relaxed);
+    // number of the epoch being written
+    slot.epoch.store((d_sequence.load(std::memory_order_relaxed) + 1) / 2, std::memory_order_relaxed);
+}
+
+
+void Gnss_Navigation_State::end_epoch()
+{
+    d_sequence.store(d_sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+
+uint64_t Gnss_Navigation_State::read(uint32_t channel, Gnss_Receiver_State& receiver, Gnss_Channel_Assistance& assistance) const
+{
+    if (channel >= max_channels)
+        {
+            return 0;
+        }
+    const Channel_Slot& slot = d_channels[channel];
+    while (true)
+        {
+            const uint64_t sequence = d_sequence.load(std::memory_order_acquire);
+            if (sequence % 2 == 1)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+            const uint64_t epoch = sequence / 2;
+            if (epoch == 0 or slot.epoch.load(std::memory_order_relaxed) != epoch)
+                {
+                    return 0;
+                }
+            for (int i = 0; i < 3; i++)
+                {
+                    receiver.pos_ecef_m[i] = d_receiver[i].load(std::memory_order_relaxed);
+                    receiver.vel_ecef_m_s[i] = d_receiver[3 + i].load(std::memory_order_relaxed);
+                }
+            receiver.clock_offset_s = d_receiver[6].load(std::memory_order_relaxed);
+            receiver.clock_drift_ppm = d_receiver[7].load(std::memory_order_relaxed);
+            receiver.rx_time_s = d_receiver[8].load(std::memory_order_relaxed);
+            receiver.sample_counter = d_sample_counter.load(std::memory_order_relaxed);
+            assistance.pseudorange_rate_m_s = slot.pseudorange_rate_m_s.load(std::memory_order_relaxed);
+            assistance.PRN = slot.PRN.load(std::memory_order_relaxed);
+            assistance.System = slot.System.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (d_sequence.load(std::memory_order_relaxed) == sequence)
+                {
+                    return epoch;
+                }
+        }
+}
+
+
+Gnss_Navigation_State_Reader::Gnss_Navigation_State_Reader() : d_state(Gnss_Navigation_State::get())
+{
+    d_state->d_readers.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+Gnss_Navigation_State_Reader::~Gnss_Navigation_State_Reader()
+{
+    d_state->d_readers.fetch_sub(1, std::memory_order_relaxed);
+}
+
+
+bool Gnss_Navigation_State_Reader::next(uint32_t channel, Gnss_Receiver_State& receiver, Gnss_Channel_Assistance& assistance)
+{
+    const uint64_t epoch = d_state->read(channel, receiver, assistance);
+    if (epoch == 0 or epoch == d_last_epoch)
+        {
+            return false;
+        }
+    d_last_epoch = epoch;
+    return true;
+}
@@ -0,0 +1,143 @@
+/*!
+ * \file gnss_navigation_state.h
+ * \brief Navigation state published by the PVT block once per epoch, and read
+ * by the tracking channels for vector tracking aiding.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_NAVIGATION_STATE_H
+#define GNSS_SDR_GNSS_NAVIGATION_STATE_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Receiver position, velocity and clock of a PVT epoch
+ */
+struct Gnss_Receiver_State
+{
+    std::array<double, 3> pos_ecef_m{};
+    std::array<double, 3> vel_ecef_m_s{};
+    double clock_offset_s{0.0};
+    double clock_drift_ppm{0.0};
+    double rx_time_s{0.0};
+    uint64_t sample_counter{0};  //!< Sample counter of the observables of the epoch
+};
+
+
+/*!
+ * \brief Prediction for the satellite tracked by a channel
+ */
+struct Gnss_Channel_Assistance
+{
+    double pseudorange_rate_m_s{0.0};  //!< Line-of-sight range rate plus the receiver and satellite clock drifts
+    uint32_t PRN{0};
+    char System{0};
+};
+
+
+/*!
+ * \brief Navigation state of the receiver, written by the PVT block once per
+ * epoch and read by any number of tracking channels.
+ *
+ * There is one state in the process. The writer and the readers take no
+ * locks and do not allocate memory: the state is a sequence lock, and a
+ * reader that overlaps with the writer retries.
+ */
+class Gnss_Navigation_State
+{
+public:
+    static constexpr uint32_t max_channels = 512;
+
+    /*!
+     * \brief Returns the state of the process, which is created if it does
+     * not exist. It is destroyed when the last block using it releases it.
+     */
+    static std::shared_ptr<Gnss_Navigation_State> get();
+
+    /*!
+     * \brief Returns true if there is any Gnss_Navigation_State_Reader, so
+     * that the writer can skip the computation of the state otherwise
+     */
+    bool has_readers() const;
+
+    /*!
+     * \brief Starts an epoch. begin_epoch(), set_receiver(), set_channel()
+     * and end_epoch() must be called by a single writer. The channels not
+     * set in an epoch have no assistance in it.
+     */
+    void begin_epoch();
+    void set_receiver(const Gnss_Receiver_State& receiver);
+    void set_channel(uint32_t channel, const Gnss_Channel_Assistance& assistance);
+    void end_epoch();
+
+private:
+    friend class Gnss_Navigation_State_Reader;
+
+    struct Channel_Slot
+    {
+        std::atomic<double> pseudorange_rate_m_s{0.0};
+        std::atomic<uint64_t> epoch{0};
+        std::atomic<uint32_t> PRN{0};
+        std::atomic<char> System{0};
+    };
+
+    /*
+     * Reads the state of channel in the last epoch. Returns its number, or 0
+     * if the channel has no assistance in it.
+     */
+    uint64_t read(uint32_t channel, Gnss_Receiver_State& receiver, Gnss_Channel_Assistance& assistance) const;
+
+    std::array<Channel_Slot, max_channels> d_channels{};
+    std::array<std::atomic<double>, 9> d_receiver{};
+    std::atomic<uint64_t> d_sample_counter{0};
+    std::atomic<uint64_t> d_sequence{0};  // odd while the writer is in an epoch
+    std::atomic<uint32_t> d_readers{0};
+};
+
+
+/*!
+ * \brief Reader of the navigation state of the process, for a tracking
+ * channel
+ */
+class Gnss_Navigation_State_Reader
+{
+public:
+    Gnss_Navigation_State_Reader();
+    ~Gnss_Navigation_State_Reader();
+
+    Gnss_Navigation_State_Reader(const Gnss_Navigation_State_Reader&) = delete;
+    Gnss_Navigation_State_Reader& operator=(const Gnss_Navigation_State_Reader&) = delete;
+
+    /*!
+     * \brief Gets the state of channel, if a new epoch with assistance for it
+     * was published since the previous call. Returns false otherwise.
+     */
+    bool next(uint32_t channel, Gnss_Receiver_State& receiver, Gnss_Channel_Assistance& assistance);
+
+private:
+    std::shared_ptr<Gnss_Navigation_State> d_state;
+    uint64_t d_last_epoch{0};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_NAVIGATION_STATE_H
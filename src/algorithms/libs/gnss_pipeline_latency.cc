@@ -0,0 +1,127 @@
+/*!
+ * \file gnss_pipeline_latency.cc
+ * \brief Measures the time from the arrival of the samples of an epoch to
+ * the output of its solution.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_pipeline_latency.h"
+#include <sstream>
+#include <utility>
+
+namespace
+{
+std::mutex global_latency_mutex;
+std::shared_ptr<Gnss_Pipeline_Latency> global_latency;
+}  // namespace
+
+constexpr std::array<double, 10> Gnss_Pipeline_Latency::BUCKETS_MS;
+
+
+void Gnss_Pipeline_Latency::set_sample_time(uint64_t sample, double fs)
+{
+    set_sample_time(sample, fs, std::chrono::steady_clock::now());
+}
+
+
+void Gnss_Pipeline_Latency::set_sample_time(uint64_t sample, double fs, std::chrono::steady_clock::time_point now)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_reference_sample = sample;
+    d_reference_time = now;
+    d_fs = fs;
+}
+
+
+bool Gnss_Pipeline_Latency::elapsed_ms(uint64_t sample, double& latency_ms) const
+{
+    return elapsed_ms(sample, latency_ms, std::chrono::steady_clock::now());
+}
+
+
+bool Gnss_Pipeline_Latency::elapsed_ms(uint64_t sample, double& latency_ms, std::chrono::steady_clock::time_point now) const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    if (d_fs <= 0.0)
+        {
+            return false;
+        }
+    // the samples after the reference arrive at the sampling rate
+    const double samples_ahead = static_cast<double>(static_cast<int64_t>(sample - d_reference_sample));
+    latency_ms = std::chrono::duration<double, std::milli>(now - d_reference_time).count() - 1e3 * samples_ahead / d_fs;
+    return true;
+}
+
+
+void Gnss_Pipeline_Latency::record(double latency_ms)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    for (size_t i = 0; i < BUCKETS_MS.size(); i++)
+        {
+            if (latency_ms <= BUCKETS_MS[i])
+                {
+                    d_buckets[i]++;
+                }
+        }
+    d_count++;
+    d_sum_ms += latency_ms;
+    if (latency_ms > d_max_ms)
+        {
+            d_max_ms = latency_ms;
+        }
+}
+
+
+uint64_t Gnss_Pipeline_Latency::count() const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_count;
+}
+
+
+double Gnss_Pipeline_Latency::max_ms() const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_max_ms;
+}
+
+
+std::string Gnss_Pipeline_Latency::report() const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    std::stringstream report;
+    report << "# TYPE gnss_sdr_pvt_latency_ms histogram\n";
+    for (size_t i = 0; i < BUCKETS_MS.size(); i++)
+        {
+            report << "gnss_sdr_pvt_latency_ms_bucket{le=\"" << BUCKETS_MS[i] << "\"} " << d_buckets[i] << '\n';
+        }
+    report << "gnss_sdr_pvt_latency_ms_bucket{le=\"+Inf\"} " << d_count << '\n'
+           << "gnss_sdr_pvt_latency_ms_sum " << d_sum_ms << '\n'
+           << "gnss_sdr_pvt_latency_ms_count " << d_count << '\n'
+           << "# TYPE gnss_sdr_pvt_latency_max_ms gauge\n"
+           << "gnss_sdr_pvt_latency_max_ms " << d_max_ms << '\n';
+    return report.str();
+}
+
+
+void Gnss_Pipeline_Latency::set_global_instance(std::shared_ptr<Gnss_Pipeline_Latency> latency)
+{
+    std::lock_guard<std::mutex> lock(global_latency_mutex);
+    global_latency = std::move(latency);
+}
+
+
+std::shared_ptr<Gnss_Pipeline_Latency> Gnss_Pipeline_Latency::global_instance()
+{
+    std::lock_guard<std::mutex> lock(global_latency_mutex);
+    return global_latency;
+}
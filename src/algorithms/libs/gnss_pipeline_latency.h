@@ -0,0 +1,91 @@
+/*!
+ * \file gnss_pipeline_latency.h
+ * \brief Measures the time from the arrival of the samples of an epoch to
+ * the output of its solution.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_PIPELINE_LATENCY_H
+#define GNSS_SDR_GNSS_PIPELINE_LATENCY_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Latency of the receiver, from the samples to the PVT solutions.
+ *
+ * The sample counter reports when the samples reach the channels, and the
+ * arrival time of any other sample is extrapolated from the last report at
+ * the sampling rate. The PVT block then gets the latency of each solution
+ * from the sample counter of its epoch, and records it in a histogram.
+ *
+ * The object is owned by the flow graph, which publishes it through
+ * set_global_instance() so that the blocks can find it.
+ */
+class Gnss_Pipeline_Latency
+{
+public:
+    //! Upper bounds of the buckets of the histogram, in ms
+    static constexpr std::array<double, 10> BUCKETS_MS{{1.0, 2.0, 5.0, 10.0, 20.0, 50.0, 100.0, 200.0, 500.0, 1000.0}};
+
+    //! Samples up to sample, taken at fs samples per second, have just arrived
+    void set_sample_time(uint64_t sample, double fs);
+
+    //! Same as above, at the time now (for testing)
+    void set_sample_time(uint64_t sample, double fs, std::chrono::steady_clock::time_point now);
+
+    /*!
+     * \brief Time since the arrival of sample, in ms. Returns false if no
+     * arrival time has been set yet.
+     */
+    bool elapsed_ms(uint64_t sample, double& latency_ms) const;
+
+    //! Same as above, at the time now (for testing)
+    bool elapsed_ms(uint64_t sample, double& latency_ms, std::chrono::steady_clock::time_point now) const;
+
+    //! Adds the latency of a solution to the histogram
+    void record(double latency_ms);
+
+    uint64_t count() const;  //!< Solutions recorded
+    double max_ms() const;   //!< Highest latency recorded
+
+    //! Histogram, in the Prometheus text format
+    std::string report() const;
+
+    static void set_global_instance(std::shared_ptr<Gnss_Pipeline_Latency> latency);
+    static std::shared_ptr<Gnss_Pipeline_Latency> global_instance();
+
+private:
+    mutable std::mutex d_mutex;
+    std::chrono::steady_clock::time_point d_reference_time{};
+    std::array<uint64_t, BUCKETS_MS.size()> d_buckets{};
+    uint64_t d_reference_sample{0};
+    uint64_t d_count{0};
+    double d_fs{0.0};
+    double d_sum_ms{0.0};
+    double d_max_ms{0.0};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_PIPELINE_LATENCY_H
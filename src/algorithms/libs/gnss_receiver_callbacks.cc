@@ -0,0 +1,47 @@
+/*!
+ * \file gnss_receiver_callbacks.cc
+ * \brief Callbacks through which an application that embeds the receiver
+ * gets its observables, PVT solutions and navigation messages.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_receiver_callbacks.h"
+#include <map>
+#include <mutex>
+
+
+std::shared_ptr<Gnss_Receiver_Callbacks> Gnss_Receiver_Callbacks::get(const std::string& name)
+{
+    static std::mutex registry_mutex;
+    static std::map<std::string, std::weak_ptr<Gnss_Receiver_Callbacks>> registry;
+
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    for (auto it = registry.begin(); it != registry.end();)
+        {
+            if (it->second.expired())
+                {
+                    it = registry.erase(it);
+                }
+            else
+                {
+                    ++it;
+                }
+        }
+
+    auto callbacks = registry[name].lock();
+    if (!callbacks)
+        {
+            callbacks = std::make_shared<Gnss_Receiver_Callbacks>();
+            registry[name] = callbacks;
+        }
+    return callbacks;
+}
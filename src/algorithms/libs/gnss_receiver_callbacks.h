@@ -0,0 +1,62 @@
+/*!
+ * \file gnss_receiver_callbacks.h
+ * \brief Callbacks through which an application that embeds the receiver
+ * gets its observables, PVT solutions and navigation messages.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_RECEIVER_CALLBACKS_H
+#define GNSS_SDR_GNSS_RECEIVER_CALLBACKS_H
+
+#include <functional>
+#include <memory>
+#include <string>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+class Gnss_Synchro;
+class Monitor_Pvt;
+class Nav_Message_Packet;
+
+
+/*!
+ * \brief Set of callbacks of the outputs of a receiver, shared by name
+ * between the application and the blocks that produce them (the observables
+ * monitor, the PVT block and the navigation message monitor), as long as
+ * someone holds it.
+ *
+ * The callbacks are called from the threads of those blocks, with objects
+ * that are only valid during the call, so they must return quickly. They
+ * must be set before the receiver starts, and not changed while it runs.
+ */
+class Gnss_Receiver_Callbacks
+{
+public:
+    /*!
+     * \brief Returns the callbacks registered as name, creating an empty set
+     * if there is none
+     */
+    static std::shared_ptr<Gnss_Receiver_Callbacks> get(const std::string& name);
+
+    std::function<void(const Gnss_Synchro&)> observables;        //!< Each observable of each channel
+    std::function<void(const Monitor_Pvt&)> pvt;                 //!< Each position fix
+    std::function<void(const Nav_Message_Packet&)> nav_message;  //!< Each navigation message decoded
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_RECEIVER_CALLBACKS_H
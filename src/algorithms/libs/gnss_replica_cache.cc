@@ -0,0 +1,90 @@
+/*!
+ * \file gnss_replica_cache.cc
+ * \brief Process-wide cache of the local code replicas shared by the
+ * acquisition and tracking blocks of all the channels
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_replica_cache.h"
+#include <utility>  // for move
+
+
+namespace
+{
+// Generates the replica out of the lock, so channels asking for different
+// replicas do not wait for each other. If two channels generate the same
+// one, the first stored wins and the other copy is dropped.
+template <typename T>
+std::shared_ptr<const volk_gnsssdr::vector<T>> replica_cache_lookup(std::map<std::tuple<std::string, uint32_t, double, std::string, size_t>, std::shared_ptr<const volk_gnsssdr::vector<T>>>& replicas,
+    std::mutex& mutex,
+    const std::tuple<std::string, uint32_t, double, std::string, size_t>& key,
+    size_t length,
+    const std::function<void(own::span<T>)>& generate)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto it = replicas.find(key);
+        if (it != replicas.cend())
+            {
+                return it->second;
+            }
+    }
+    auto replica = std::make_shared<volk_gnsssdr::vector<T>>(length, T(0));
+    generate(own::span<T>(replica->data(), replica->size()));
+    std::lock_guard<std::mutex> lock(mutex);
+    return replicas.emplace(key, std::move(replica)).first->second;
+}
+}  // namespace
+
+
+Gnss_Replica_Cache& Gnss_Replica_Cache::get()
+{
+    static Gnss_Replica_Cache cache;
+    return cache;
+}
+
+
+Gnss_Replica_Cache::Float_Replica Gnss_Replica_Cache::get_float(const std::string& signal,
+    uint32_t PRN,
+    double sampling_freq,
+    const std::string& variant,
+    size_t length,
+    const std::function<void(own::span<float>)>& generate)
+{
+    return replica_cache_lookup(d_float_replicas, d_mutex, Key{signal, PRN, sampling_freq, variant, length}, length, generate);
+}
+
+
+Gnss_Replica_Cache::Complex_Replica Gnss_Replica_Cache::get_complex(const std::string& signal,
+    uint32_t PRN,
+    double sampling_freq,
+    const std::string& variant,
+    size_t length,
+    const std::function<void(own::span<std::complex<float>>)>& generate)
+{
+    return replica_cache_lookup(d_complex_replicas, d_mutex, Key{signal, PRN, sampling_freq, variant, length}, length, generate);
+}
+
+
+size_t Gnss_Replica_Cache::size()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_float_replicas.size() + d_complex_replicas.size();
+}
+
+
+void Gnss_Replica_Cache::clear()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_float_replicas.clear();
+    d_complex_replicas.clear();
+}
@@ -0,0 +1,109 @@
+/*!
+ * \file gnss_replica_cache.h
+ * \brief Process-wide cache of the local code replicas shared by the
+ * acquisition and tracking blocks of all the channels
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_REPLICA_CACHE_H
+#define GNSS_SDR_GNSS_REPLICA_CACHE_H
+
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#if HAS_STD_SPAN
+#include <span>
+namespace own = std;
+#else
+#include <gsl/gsl-lite.hpp>
+namespace own = gsl;
+#endif
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Replicas of the local codes, generated once per process and then
+ * shared, read-only, by all the channels that use them.
+ *
+ * A replica is identified by the signal (e.g. "GPS 1C"), the PRN, the
+ * sampling frequency (0 for replicas with a fixed number of samples per
+ * chip), a variant naming how it is generated (e.g. "cboc pilot") and its
+ * length. The first request generates it with the given function, in a
+ * zero-filled buffer of that length, and later requests return the same
+ * buffer. Replicas are never dropped, there is one per combination in use.
+ */
+class Gnss_Replica_Cache
+{
+public:
+    using Float_Replica = std::shared_ptr<const volk_gnsssdr::vector<float>>;
+    using Complex_Replica = std::shared_ptr<const volk_gnsssdr::vector<std::complex<float>>>;
+
+    /*!
+     * \brief Returns the process-wide instance
+     */
+    static Gnss_Replica_Cache& get();
+
+    /*!
+     * \brief Returns the real replica, generating it if it is not cached
+     */
+    Float_Replica get_float(const std::string& signal,
+        uint32_t PRN,
+        double sampling_freq,
+        const std::string& variant,
+        size_t length,
+        const std::function<void(own::span<float>)>& generate);
+
+    /*!
+     * \brief Returns the complex replica, generating it if it is not cached
+     */
+    Complex_Replica get_complex(const std::string& signal,
+        uint32_t PRN,
+        double sampling_freq,
+        const std::string& variant,
+        size_t length,
+        const std::function<void(own::span<std::complex<float>>)>& generate);
+
+    /*!
+     * \brief Number of cached replicas
+     */
+    size_t size();
+
+    /*!
+     * \brief Drops the cached replicas. Those in use stay valid.
+     */
+    void clear();
+
+private:
+    using Key = std::tuple<std::string, uint32_t, double, std::string, size_t>;
+
+    Gnss_Replica_Cache() = default;
+
+    std::map<Key, Float_Replica> d_float_replicas;
+    std::map<Key, Complex_Replica> d_complex_replicas;
+    std::mutex d_mutex;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_REPLICA_CACHE_H
@@ -0,0 +1,131 @@
+/*!
+ * \file gnss_sample_clock.cc
+ * \brief Receiver clock shared by the sample counter and the observables
+ * block, without a stream between them.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sample_clock.h"
+#include <utility>  // for std::move
+
+
+namespace
+{
+std::mutex global_clock_mutex;
+std::shared_ptr<Gnss_Sample_Clock> global_clock;
+}  // namespace
+
+constexpr uint64_t Gnss_Sample_Clock::capacity;
+constexpr std::chrono::milliseconds Gnss_Sample_Clock::throttle_timeout;
+
+
+void Gnss_Sample_Clock::publish(uint64_t sample_counter)
+{
+    const uint64_t count = d_count.load(std::memory_order_relaxed);
+    if (d_throttle.load(std::memory_order_relaxed) and count - d_read.load(std::memory_order_acquire) >= capacity and !d_reader_stalled.load(std::memory_order_relaxed))
+        {
+            wait_for_reader(count);
+        }
+    d_samples[count % capacity].store(sample_counter, std::memory_order_relaxed);
+    d_count.store(count + 1, std::memory_order_release);
+    {
+        // a reader checking the count under the lock either sees the new
+        // epoch or is already waiting, so the notification is not lost
+        std::lock_guard<std::mutex> lock(d_mutex);
+    }
+    d_epoch_published.notify_all();
+}
+
+
+void Gnss_Sample_Clock::set_throttle(bool throttle)
+{
+    d_throttle.store(throttle, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+    }
+    d_epoch_read.notify_all();
+}
+
+
+void Gnss_Sample_Clock::set_read_epochs(uint64_t epochs)
+{
+    d_read.store(epochs, std::memory_order_release);
+    d_reader_stalled.store(false, std::memory_order_relaxed);
+    if (d_throttle.load(std::memory_order_relaxed))
+        {
+            {
+                std::lock_guard<std::mutex> lock(d_mutex);
+            }
+            d_epoch_read.notify_all();
+        }
+}
+
+
+void Gnss_Sample_Clock::wait_for_reader(uint64_t count)
+{
+    std::unique_lock<std::mutex> lock(d_mutex);
+    const bool room = d_epoch_read.wait_for(lock, throttle_timeout, [this, count] {
+        return count - d_read.load(std::memory_order_acquire) < capacity or !d_throttle.load(std::memory_order_relaxed);
+    });
+    if (!room)
+        {
+            d_reader_stalled.store(true, std::memory_order_relaxed);
+        }
+}
+
+
+bool Gnss_Sample_Clock::epoch_sample(uint64_t epoch, uint64_t& sample_counter) const
+{
+    const uint64_t count = d_count.load(std::memory_order_acquire);
+    if (epoch >= count or count - epoch > capacity)
+        {
+            return false;
+        }
+    const uint64_t value = d_samples[epoch % capacity].load(std::memory_order_relaxed);
+    // the slot could have been overwritten while it was read
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (d_count.load(std::memory_order_relaxed) - epoch > capacity)
+        {
+            return false;
+        }
+    sample_counter = value;
+    return true;
+}
+
+
+bool Gnss_Sample_Clock::wait_for_epochs(uint64_t epochs, std::chrono::milliseconds timeout)
+{
+    if (d_count.load(std::memory_order_acquire) > epochs)
+        {
+            return true;
+        }
+    std::unique_lock<std::mutex> lock(d_mutex);
+    return d_epoch_published.wait_for(lock, timeout, [this, epochs] { return d_count.load(std::memory_order_acquire) > epochs; });
+}
+
+
+void Gnss_Sample_Clock::set_global_instance(std::shared_ptr<Gnss_Sample_Clock> clock)
+{
+    std::lock_guard<std::mutex> lock(global_clock_mutex);
+    global_clock = std::move(clock);
+}
+
+
+std::shared_ptr<Gnss_Sample_Clock> Gnss_Sample_Clock::global_instance()
+{
+    std::lock_guard<std::mutex> lock(global_clock_mutex);
+    if (global_clock == nullptr)
+        {
+            global_clock = std::make_shared<Gnss_Sample_Clock>();
+        }
+    return global_clock;
+}
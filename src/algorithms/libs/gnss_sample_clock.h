@@ -0,0 +1,124 @@
+/*!
+ * \file gnss_sample_clock.h
+ * \brief Receiver clock shared by the sample counter and the observables
+ * block, without a stream between them.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SAMPLE_CLOCK_H
+#define GNSS_SDR_GNSS_SAMPLE_CLOCK_H
+
+#include "gnss_time_tag_channel.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Epochs of the observables, published by the sample counter as the
+ * samples reach the channels, and read by the observables block.
+ *
+ * The sample counter of each epoch goes into a fixed-size ring, and the
+ * number of epochs published is an atomic counter, so that reading the
+ * clock does not take a lock. The time tags of the signal source, adjusted
+ * to each epoch, go into a Gnss_Time_Tag_Channel with the index of the epoch
+ * as offset. A reader can wait for the next epoch instead of polling.
+ *
+ * The reader reports the epochs it has read with set_read_epochs(). When the
+ * publisher runs more than capacity epochs ahead, the oldest epochs are
+ * overwritten and the reader counts them with add_skipped_epochs(). With
+ * set_throttle(true), used for the sources that can be read at any pace,
+ * such as files, publish() waits for the reader instead; if the reader does
+ * not read an epoch for throttle_timeout, publish() stops waiting until it
+ * reads again, so that a stopped reader does not block the flow graph.
+ *
+ * The object is owned by the flow graph, which publishes it through
+ * set_global_instance() so that the blocks can find it.
+ */
+class Gnss_Sample_Clock
+{
+public:
+    static constexpr uint64_t capacity = 1024;
+    static constexpr std::chrono::milliseconds throttle_timeout{1000};
+
+    /*!
+     * \brief A new epoch, at sample sample_counter, has been reached. If the
+     * clock is throttled, waits until the reader has room for it.
+     */
+    void publish(uint64_t sample_counter);
+
+    //! Whether publish() waits for the reader instead of overwriting unread epochs
+    void set_throttle(bool throttle);
+
+    bool throttled() const { return d_throttle.load(std::memory_order_relaxed); }
+
+    //! The reader has read the epochs before epochs
+    void set_read_epochs(uint64_t epochs);
+
+    //! The reader has lost epochs epochs, overwritten before it read them
+    void add_skipped_epochs(uint64_t epochs) { d_skipped.fetch_add(epochs, std::memory_order_relaxed); }
+
+    //! Number of epochs lost by the reader
+    uint64_t skipped_epochs() const { return d_skipped.load(std::memory_order_relaxed); }
+
+    //! Number of epochs published
+    uint64_t epochs() const { return d_count.load(std::memory_order_acquire); }
+
+    /*!
+     * \brief Gets the sample counter of the epoch with index epoch (0 for the
+     * first one). Returns false if the epoch has not been published yet, or
+     * if it is more than capacity epochs old.
+     */
+    bool epoch_sample(uint64_t epoch, uint64_t& sample_counter) const;
+
+    /*!
+     * \brief Waits until more than epochs epochs have been published, for at
+     * most timeout. Returns false on timeout.
+     */
+    bool wait_for_epochs(uint64_t epochs, std::chrono::milliseconds timeout);
+
+    //! Time tags of the epochs
+    std::shared_ptr<Gnss_Time_Tag_Channel> time_tags() const { return d_time_tags; }
+
+    static void set_global_instance(std::shared_ptr<Gnss_Sample_Clock> clock);
+
+    //! The global instance, which is created if there is none
+    static std::shared_ptr<Gnss_Sample_Clock> global_instance();
+
+private:
+    void wait_for_reader(uint64_t count);
+
+    std::mutex d_mutex;
+    std::condition_variable d_epoch_published;
+    std::condition_variable d_epoch_read;
+    std::array<std::atomic<uint64_t>, capacity> d_samples{};
+    std::atomic<uint64_t> d_count{0};
+    std::atomic<uint64_t> d_read{0};           // epochs read by the reader
+    std::atomic<uint64_t> d_skipped{0};        // epochs lost by the reader
+    std::atomic<bool> d_throttle{false};       // publish() waits for the reader
+    std::atomic<bool> d_reader_stalled{false}; // publish() gave up waiting, until the reader reads again
+    std::shared_ptr<Gnss_Time_Tag_Channel> d_time_tags{std::make_shared<Gnss_Time_Tag_Channel>()};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SAMPLE_CLOCK_H
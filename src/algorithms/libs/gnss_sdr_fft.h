@@ -23,6 +23,26 @@
 #include <memory>
 #include <utility>
 
+/*!
+ * \brief Settings of the FFT plans made by gnss_fft_fwd_make_unique() and
+ * gnss_fft_rev_make_unique(), shared by all the blocks of the receiver and
+ * set from the configuration before the blocks are created.
+ *
+ * The plans are made by GNU Radio, which imports and exports the FFTW
+ * wisdom file (~/.gr_fftw_wisdom) when planning, and allocates the buffers
+ * with the VOLK alignment.
+ */
+struct Gnss_Fft_Settings
+{
+    int nthreads{1};  // FFTW threads of each plan (GNSS-SDR.fft_threads)
+};
+
+inline Gnss_Fft_Settings& gnss_fft_settings()
+{
+    static Gnss_Fft_Settings settings;
+    return settings;
+}
+
 #if GNURADIO_FFT_USES_TEMPLATES
 using gnss_fft_complex_fwd = gr::fft::fft_complex_fwd;
 using gnss_fft_complex_rev = gr::fft::fft_complex_rev;
@@ -31,14 +51,14 @@ using gnss_fft_fwd_unique_ptr = std::unique_ptr<T>;
 template <typename... Args>
 gnss_fft_fwd_unique_ptr<gr::fft::fft_complex_fwd> gnss_fft_fwd_make_unique(Args&&... args)
 {
-    return std::make_unique<gr::fft::fft_complex_fwd>(std::forward<Args>(args)...);
+    return std::make_unique<gr::fft::fft_complex_fwd>(std::forward<Args>(args)..., gnss_fft_settings().nthreads);
 }
 template <typename T>
 using gnss_fft_rev_unique_ptr = std::unique_ptr<T>;
 template <typename... Args>
 gnss_fft_rev_unique_ptr<gr::fft::fft_complex_rev> gnss_fft_rev_make_unique(Args&&... args)
 {
-    return std::make_unique<gr::fft::fft_complex_rev>(std::forward<Args>(args)...);
+    return std::make_unique<gr::fft::fft_complex_rev>(std::forward<Args>(args)..., gnss_fft_settings().nthreads);
 }
 
 #else
@@ -50,14 +70,14 @@ using gnss_fft_fwd_unique_ptr = std::unique_ptr<T>;
 template <typename... Args>
 gnss_fft_fwd_unique_ptr<gr::fft::fft_complex> gnss_fft_fwd_make_unique(Args&&... args)
 {
-    return std::make_unique<gr::fft::fft_complex>(std::forward<Args>(args)..., true);
+    return std::make_unique<gr::fft::fft_complex>(std::forward<Args>(args)..., true, gnss_fft_settings().nthreads);
 }
 template <typename T>
 using gnss_fft_rev_unique_ptr = std::unique_ptr<T>;
 template <typename... Args>
 gnss_fft_rev_unique_ptr<gr::fft::fft_complex> gnss_fft_rev_make_unique(Args&&... args)
 {
-    return std::make_unique<gr::fft::fft_complex>(std::forward<Args>(args)..., false);
+    return std::make_unique<gr::fft::fft_complex>(std::forward<Args>(args)..., false, gnss_fft_settings().nthreads);
 }
 
 #endif
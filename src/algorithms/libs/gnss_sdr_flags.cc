@@ -65,6 +65,14 @@ DEFINE_string(RINEX_name, "-", "If defined, specifies the RINEX files base name"
 
 DEFINE_bool(keyboard, true, "If set to false, it disables the keyboard listener (so the receiver cannot be stopped with q+[Enter])");
 
+DEFINE_string(batch, "-", "If defined, path to a job file with a job per line: <configuration file> <recording> [<output folder>]. The jobs run one after the other in this process, which builds the code replicas and the FFT plans once.");
+
+DEFINE_string(batch_summary, "-", "If defined, path to a CSV file with the run time and the throughput of each job of --batch.");
+
+DEFINE_bool(capacity_plan, false, "If set to true, it prints the CPU, memory and buffers that the configuration needs, and whether it can run in real time on this machine, without starting the receiver.");
+
+DEFINE_string(capacity_calibration, "-", "If defined, path to a file with the Capacity.* costs of the target machine used by --capacity_plan, as written by gnss-sdr-capacity-calibrate.py. The costs are otherwise read from the configuration file.");
+
 #if GFLAGS_GREATER_2_0
 
 static bool ValidateC(const char* flagname, const std::string& value)
@@ -62,6 +62,14 @@ DECLARE_string(RINEX_version);  //!< If defined, specifies the RINEX version (2.
 DECLARE_string(RINEX_name);     //!< If defined, specifies the RINEX files base name
 DECLARE_bool(keyboard);         //!< If set to false, disables the keyboard listener. Only for debug purposes (e.g. ASAN mode termination)
 
+// Batch processing
+DECLARE_string(batch);          //!< Path to a job file, whose jobs run one after the other in the same process.
+DECLARE_string(batch_summary);  //!< Path to a CSV file with the run time and the throughput of each job.
+
+// Capacity planning
+DECLARE_bool(capacity_plan);           //!< If set to true, prints the needs of the configuration without starting the receiver.
+DECLARE_string(capacity_calibration);  //!< Path to a file with the Capacity.* costs of the target machine.
+
 /** \} */
 /** \} */
 #endif  // GNSS_SDR_GNSS_SDR_FLAGS_H
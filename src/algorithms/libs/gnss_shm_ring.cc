@@ -0,0 +1,293 @@
+/*!
+ * \file gnss_shm_ring.cc
+ * \brief Ring of fixed-size records in POSIX shared memory, written by one
+ * process and read by any number of processes in the same host.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_shm_ring.h"
+#include <fcntl.h>     // for O_CREAT, O_RDWR, O_RDONLY
+#include <sys/mman.h>  // for mmap, munmap, shm_open, shm_unlink
+#include <sys/stat.h>  // for fstat
+#include <unistd.h>    // for ftruncate, close
+#include <cerrno>      // for errno
+#include <cstring>     // for memcpy, strerror
+#include <new>         // for placement new
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "The shared memory ring requires lock-free 64-bit atomics");
+static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t), "Unexpected size of std::atomic<uint64_t>");
+
+constexpr uint32_t Gnss_Shm_Ring_Header::MAGIC;
+constexpr uint32_t Gnss_Shm_Ring_Header::VERSION;
+
+namespace
+{
+constexpr std::size_t SHM_RING_ALIGNMENT = 64;  // one cache line per slot at least
+
+constexpr std::size_t shm_ring_round_up(std::size_t size)
+{
+    return (size + SHM_RING_ALIGNMENT - 1) / SHM_RING_ALIGNMENT * SHM_RING_ALIGNMENT;
+}
+
+constexpr std::size_t SHM_RING_HEADER_SIZE = shm_ring_round_up(sizeof(Gnss_Shm_Ring_Header));
+
+std::string shm_ring_object_name(const std::string& name)
+{
+    return name.empty() or name[0] != '/' ? "/" + name : name;
+}
+
+inline uint8_t* shm_ring_slot(void* map, std::size_t slot_size, uint64_t index, uint32_t capacity)
+{
+    return static_cast<uint8_t*>(map) + SHM_RING_HEADER_SIZE + static_cast<std::size_t>(index % capacity) * slot_size;
+}
+}  // namespace
+
+
+Gnss_Shm_Ring_Writer::Gnss_Shm_Ring_Writer(const std::string& name,
+    uint32_t record_type,
+    std::size_t record_size,
+    std::size_t capacity)
+    : d_name(shm_ring_object_name(name)),
+      d_record_size(record_size)
+{
+    if (record_size == 0 or capacity == 0)
+        {
+            d_error = "invalid record size or capacity";
+            return;
+        }
+    const std::size_t slot_size = shm_ring_round_up(sizeof(std::atomic<uint64_t>) + record_size);
+    d_map_size = SHM_RING_HEADER_SIZE + capacity * slot_size;
+
+    // A receiver that crashed may have left the object behind
+    shm_unlink(d_name.c_str());
+    const int fd = shm_open(d_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0)
+        {
+            d_error = "shm_open " + d_name + ": " + std::strerror(errno);
+            return;
+        }
+    if (ftruncate(fd, static_cast<off_t>(d_map_size)) != 0)
+        {
+            d_error = "ftruncate " + d_name + ": " + std::strerror(errno);
+            close(fd);
+            shm_unlink(d_name.c_str());
+            return;
+        }
+    void* map = mmap(nullptr, d_map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        {
+            d_error = "mmap " + d_name + ": " + std::strerror(errno);
+            shm_unlink(d_name.c_str());
+            return;
+        }
+    d_map = map;
+
+    // ftruncate() zero-fills the object, so every slot starts with sequence 0
+    for (std::size_t slot = 0; slot < capacity; slot++)
+        {
+            new (shm_ring_slot(d_map, slot_size, slot, static_cast<uint32_t>(capacity))) std::atomic<uint64_t>(0);
+        }
+    d_header = new (d_map) Gnss_Shm_Ring_Header;
+    d_header->magic = Gnss_Shm_Ring_Header::MAGIC;
+    d_header->version = Gnss_Shm_Ring_Header::VERSION;
+    d_header->record_type = record_type;
+    d_header->record_size = static_cast<uint32_t>(record_size);
+    d_header->slot_size = static_cast<uint32_t>(slot_size);
+    d_header->capacity = static_cast<uint32_t>(capacity);
+    d_header->closed.store(0, std::memory_order_relaxed);
+    d_header->write_index.store(0, std::memory_order_release);
+}
+
+
+Gnss_Shm_Ring_Writer::~Gnss_Shm_Ring_Writer()
+{
+    if (d_map != nullptr)
+        {
+            d_header->closed.store(1, std::memory_order_release);
+            munmap(d_map, d_map_size);
+            shm_unlink(d_name.c_str());
+        }
+}
+
+
+bool Gnss_Shm_Ring_Writer::is_open() const
+{
+    return d_map != nullptr;
+}
+
+
+const std::string& Gnss_Shm_Ring_Writer::error() const
+{
+    return d_error;
+}
+
+
+void Gnss_Shm_Ring_Writer::publish(const void* record)
+{
+    if (d_map == nullptr)
+        {
+            return;
+        }
+    uint8_t* slot = shm_ring_slot(d_map, d_header->slot_size, d_write_index, d_header->capacity);
+    auto* sequence = reinterpret_cast<std::atomic<uint64_t>*>(slot);
+
+    sequence->store(2 * d_write_index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(slot + sizeof(std::atomic<uint64_t>), record, d_record_size);
+    sequence->store(2 * (d_write_index + 1), std::memory_order_release);
+
+    d_write_index++;
+    d_header->write_index.store(d_write_index, std::memory_order_release);
+}
+
+
+uint64_t Gnss_Shm_Ring_Writer::published() const
+{
+    return d_write_index;
+}
+
+
+Gnss_Shm_Ring_Reader::Gnss_Shm_Ring_Reader(const std::string& name, bool from_oldest)
+{
+    const std::string object_name = shm_ring_object_name(name);
+    const int fd = shm_open(object_name.c_str(), O_RDONLY, 0);
+    if (fd < 0)
+        {
+            d_error = "shm_open " + object_name + ": " + std::strerror(errno);
+            return;
+        }
+    struct stat object_stat
+    {
+    };
+    if (fstat(fd, &object_stat) != 0 or static_cast<std::size_t>(object_stat.st_size) < SHM_RING_HEADER_SIZE)
+        {
+            d_error = object_name + " is not a GNSS-SDR shared memory ring";
+            close(fd);
+            return;
+        }
+    d_map_size = static_cast<std::size_t>(object_stat.st_size);
+    void* map = mmap(nullptr, d_map_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        {
+            d_error = "mmap " + object_name + ": " + std::strerror(errno);
+            return;
+        }
+
+    const auto* header = static_cast<const Gnss_Shm_Ring_Header*>(map);
+    if (header->magic != Gnss_Shm_Ring_Header::MAGIC or header->version != Gnss_Shm_Ring_Header::VERSION or
+        header->capacity == 0 or SHM_RING_HEADER_SIZE + static_cast<std::size_t>(header->capacity) * header->slot_size > d_map_size)
+        {
+            d_error = object_name + " is not a GNSS-SDR shared memory ring, or its version is not supported";
+            munmap(map, d_map_size);
+            return;
+        }
+    d_map = map;
+    d_header = header;
+
+    d_read_index = d_header->write_index.load(std::memory_order_acquire);
+    if (from_oldest)
+        {
+            d_read_index = d_read_index > d_header->capacity ? d_read_index - d_header->capacity : 0;
+        }
+}
+
+
+Gnss_Shm_Ring_Reader::~Gnss_Shm_Ring_Reader()
+{
+    if (d_map != nullptr)
+        {
+            munmap(d_map, d_map_size);
+        }
+}
+
+
+bool Gnss_Shm_Ring_Reader::is_open() const
+{
+    return d_map != nullptr;
+}
+
+
+const std::string& Gnss_Shm_Ring_Reader::error() const
+{
+    return d_error;
+}
+
+
+uint32_t Gnss_Shm_Ring_Reader::record_type() const
+{
+    return d_header == nullptr ? 0 : d_header->record_type;
+}
+
+
+std::size_t Gnss_Shm_Ring_Reader::record_size() const
+{
+    return d_header == nullptr ? 0 : d_header->record_size;
+}
+
+
+const std::atomic<uint64_t>& Gnss_Shm_Ring_Reader::sequence(uint64_t index) const
+{
+    return *reinterpret_cast<const std::atomic<uint64_t>*>(shm_ring_slot(d_map, d_header->slot_size, index, d_header->capacity));
+}
+
+
+bool Gnss_Shm_Ring_Reader::read(void* record)
+{
+    if (d_map == nullptr)
+        {
+            return false;
+        }
+    while (true)
+        {
+            const uint64_t write_index = d_header->write_index.load(std::memory_order_acquire);
+            if (d_read_index >= write_index)
+                {
+                    return false;
+                }
+            if (write_index - d_read_index > d_header->capacity)
+                {
+                    // The writer went around the ring since the last read
+                    d_lost += write_index - d_read_index - d_header->capacity;
+                    d_read_index = write_index - d_header->capacity;
+                }
+
+            const std::atomic<uint64_t>& slot_sequence = sequence(d_read_index);
+            const uint64_t before = slot_sequence.load(std::memory_order_acquire);
+            if (before == 2 * (d_read_index + 1))
+                {
+                    std::memcpy(record, reinterpret_cast<const uint8_t*>(&slot_sequence) + sizeof(std::atomic<uint64_t>), d_header->record_size);
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if (slot_sequence.load(std::memory_order_relaxed) == before)
+                        {
+                            d_read_index++;
+                            return true;
+                        }
+                }
+            // The record was overwritten before or while it was copied
+            d_lost++;
+            d_read_index++;
+        }
+}
+
+
+uint64_t Gnss_Shm_Ring_Reader::lost() const
+{
+    return d_lost;
+}
+
+
+bool Gnss_Shm_Ring_Reader::writer_closed() const
+{
+    return d_header == nullptr or d_header->closed.load(std::memory_order_acquire) != 0;
+}
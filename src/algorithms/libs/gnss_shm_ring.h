@@ -0,0 +1,175 @@
+/*!
+ * \file gnss_shm_ring.h
+ * \brief Ring of fixed-size records in POSIX shared memory, written by one
+ * process and read by any number of processes in the same host.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SHM_RING_H
+#define GNSS_SDR_GNSS_SHM_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Types of the records published by the receiver monitors. The records
+ * are the objects themselves, so readers must be built with the same headers
+ * and compiler as the receiver, and should check record_size().
+ */
+enum Gnss_Shm_Record_Type : uint32_t
+{
+    SHM_RECORD_GNSS_SYNCHRO = 1,  // Gnss_Synchro
+    SHM_RECORD_MONITOR_PVT = 2,   // Monitor_Pvt
+    SHM_RECORD_NAV_MESSAGE = 3,   // Nav_Message_Shm_Record
+    SHM_RECORD_TRK_BATCH = 4      // Tcp_Batch_Header and correlator outputs
+};
+
+
+/*!
+ * \brief Layout of the beginning of the shared memory object. It is followed
+ * by capacity slots of slot_size bytes, each one made of a sequence number
+ * and the record.
+ *
+ * The writer never waits for the readers: it overwrites the oldest record
+ * when the ring is full. Each slot is protected by a seqlock: its sequence
+ * number is odd while the record is being written, and 2 * (index + 1) once
+ * the record with that index is complete, so a reader can tell whether the
+ * copy it made is consistent and whether it fell behind the writer.
+ */
+struct Gnss_Shm_Ring_Header
+{
+    static constexpr uint32_t MAGIC = 0x474E5352;  // "GNSR"
+    static constexpr uint32_t VERSION = 1;
+
+    uint32_t magic;
+    uint32_t version;
+    uint32_t record_type;  // set by the writer, to tell readers what the records are
+    uint32_t record_size;  // bytes
+    uint32_t slot_size;    // bytes, sequence number included
+    uint32_t capacity;     // number of slots
+    std::atomic<uint32_t> closed;
+    alignas(64) std::atomic<uint64_t> write_index;  // number of records published
+};
+
+
+/*!
+ * \brief Publishes fixed-size records in a shared memory ring. Publishing a
+ * record is one memcpy and a few atomic stores, with no system calls.
+ *
+ * The shared memory object is created (replacing any stale one with the same
+ * name) when the writer is constructed, and it is unlinked when the writer
+ * is destroyed. Only one thread may publish.
+ */
+class Gnss_Shm_Ring_Writer
+{
+public:
+    /*!
+     * \brief Creates the shared memory object /name. Check is_open()
+     * afterwards.
+     */
+    Gnss_Shm_Ring_Writer(const std::string& name, uint32_t record_type, std::size_t record_size, std::size_t capacity = 1024);
+    ~Gnss_Shm_Ring_Writer();
+
+    Gnss_Shm_Ring_Writer(const Gnss_Shm_Ring_Writer&) = delete;
+    Gnss_Shm_Ring_Writer& operator=(const Gnss_Shm_Ring_Writer&) = delete;
+
+    bool is_open() const;
+
+    /*!
+     * \brief Description of the last error, if is_open() is false
+     */
+    const std::string& error() const;
+
+    /*!
+     * \brief Copies record_size bytes from record into the next slot
+     */
+    void publish(const void* record);
+
+    uint64_t published() const;
+
+private:
+    std::string d_name;
+    std::string d_error;
+    void* d_map{nullptr};
+    std::size_t d_map_size{0};
+    Gnss_Shm_Ring_Header* d_header{nullptr};
+    std::size_t d_record_size{0};
+    uint64_t d_write_index{0};
+};
+
+
+/*!
+ * \brief Reads the records published by a Gnss_Shm_Ring_Writer. The shared
+ * memory object is mapped read-only, so readers cannot disturb the writer or
+ * each other, and a slow reader only loses the records that were overwritten
+ * before it could read them.
+ */
+class Gnss_Shm_Ring_Reader
+{
+public:
+    /*!
+     * \brief Maps the shared memory object /name. The first read() returns
+     * the next record published, or the oldest one still in the ring if
+     * from_oldest is true. Check is_open() afterwards.
+     */
+    explicit Gnss_Shm_Ring_Reader(const std::string& name, bool from_oldest = false);
+    ~Gnss_Shm_Ring_Reader();
+
+    Gnss_Shm_Ring_Reader(const Gnss_Shm_Ring_Reader&) = delete;
+    Gnss_Shm_Ring_Reader& operator=(const Gnss_Shm_Ring_Reader&) = delete;
+
+    bool is_open() const;
+    const std::string& error() const;
+
+    uint32_t record_type() const;
+    std::size_t record_size() const;
+
+    /*!
+     * \brief Copies the next record into record (record_size() bytes), without
+     * waiting. Returns false if there is no new record.
+     */
+    bool read(void* record);
+
+    /*!
+     * \brief Number of records overwritten by the writer before they were read
+     */
+    uint64_t lost() const;
+
+    /*!
+     * \brief True once the writer has been destroyed. The receiver creates a
+     * new object when it is restarted, so the reader must be created again.
+     */
+    bool writer_closed() const;
+
+private:
+    const std::atomic<uint64_t>& sequence(uint64_t index) const;
+
+    std::string d_error;
+    void* d_map{nullptr};
+    std::size_t d_map_size{0};
+    const Gnss_Shm_Ring_Header* d_header{nullptr};
+    uint64_t d_read_index{0};
+    uint64_t d_lost{0};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SHM_RING_H
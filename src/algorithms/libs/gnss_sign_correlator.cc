@@ -0,0 +1,103 @@
+/*!
+ * \file gnss_sign_correlator.cc
+ * \brief Correlation of the signs of the last symbols with a known pattern
+ * (preamble or secondary code), with the signs packed in machine words
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sign_correlator.h"
+#include <algorithm>  // for std::min, std::max, std::fill, std::transform
+#include <bitset>
+
+
+namespace
+{
+int32_t ones(uint64_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(word);
+#else
+    return static_cast<int32_t>(std::bitset<64>(word).count());
+#endif
+}
+}  // namespace
+
+
+Gnss_Sign_Correlator::Gnss_Sign_Correlator(const std::vector<int32_t>& pattern, std::size_t window_length)
+    : d_window_length(std::max(window_length, pattern.size())),
+      d_pattern_length(pattern.size())
+{
+    const std::size_t words = (d_window_length + 63) / 64;
+    d_register.assign(words, 0);
+    d_pattern.assign(words, 0);
+    d_mask.assign(words, 0);
+    d_top_word_mask = (d_window_length % 64 == 0) ? ~0ULL : ((1ULL << (d_window_length % 64)) - 1);
+    d_first_pattern_word = words;
+    for (std::size_t i = 0; i < d_pattern_length; i++)
+        {
+            // the i-th oldest symbol was pushed window_length - 1 - i pushes ago
+            const std::size_t bit = d_window_length - 1 - i;
+            d_mask[bit / 64] |= 1ULL << (bit % 64);
+            if (pattern[i] < 0)
+                {
+                    d_pattern[bit / 64] |= 1ULL << (bit % 64);
+                }
+            d_first_pattern_word = std::min(d_first_pattern_word, bit / 64);
+        }
+}
+
+
+Gnss_Sign_Correlator Gnss_Sign_Correlator::from_string(const std::string& pattern, std::size_t window_length)
+{
+    std::vector<int32_t> values(pattern.size());
+    std::transform(pattern.cbegin(), pattern.cend(), values.begin(), [](char c) { return c == '1' ? 1 : -1; });
+    return Gnss_Sign_Correlator(values, window_length);
+}
+
+
+void Gnss_Sign_Correlator::push(float symbol)
+{
+    if (d_register.empty())
+        {
+            return;
+        }
+    uint64_t carry = symbol < 0.0 ? 1ULL : 0ULL;
+    for (auto& word : d_register)
+        {
+            const uint64_t next_carry = word >> 63;
+            word = (word << 1) | carry;
+            carry = next_carry;
+        }
+    d_register.back() &= d_top_word_mask;
+    if (d_size < d_window_length)
+        {
+            d_size++;
+        }
+}
+
+
+void Gnss_Sign_Correlator::clear()
+{
+    std::fill(d_register.begin(), d_register.end(), 0);
+    d_size = 0;
+}
+
+
+int32_t Gnss_Sign_Correlator::correlation() const
+{
+    int32_t disagreements = 0;
+    for (std::size_t w = d_first_pattern_word; w < d_register.size(); w++)
+        {
+            disagreements += ones((d_register[w] ^ d_pattern[w]) & d_mask[w]);
+        }
+    return static_cast<int32_t>(d_pattern_length) - 2 * disagreements;
+}
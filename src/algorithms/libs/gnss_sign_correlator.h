@@ -0,0 +1,88 @@
+/*!
+ * \file gnss_sign_correlator.h
+ * \brief Correlation of the signs of the last symbols with a known pattern
+ * (preamble or secondary code), with the signs packed in machine words
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SIGN_CORRELATOR_H
+#define GNSS_SDR_GNSS_SIGN_CORRELATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Keeps the signs of the last window_length symbols in a shift
+ * register, and correlates the oldest of them with a pattern of +1 / -1.
+ *
+ * The correlation is the sum of pattern[i] * sign(symbol i), where symbol 0
+ * is the oldest symbol of the window and negative symbols count as -1 (zero
+ * counts as +1). This is what the tracking and telemetry blocks compute on
+ * their circular buffers of float symbols, but a push and a correlation
+ * take a few word operations (XOR and population count) instead of a loop
+ * over the symbols.
+ */
+class Gnss_Sign_Correlator
+{
+public:
+    Gnss_Sign_Correlator() = default;
+
+    /*!
+     * \brief The pattern is correlated with the oldest pattern.size()
+     * symbols of a window of window_length symbols (0 for pattern.size()).
+     */
+    explicit Gnss_Sign_Correlator(const std::vector<int32_t>& pattern, std::size_t window_length = 0);
+
+    /*!
+     * \brief Pattern given as a string of '0' and '1' (e.g., a secondary
+     * code), where '1' stands for +1 and '0' for -1.
+     */
+    static Gnss_Sign_Correlator from_string(const std::string& pattern, std::size_t window_length = 0);
+
+    void push(float symbol);
+    void clear();
+
+    std::size_t size() const { return d_size; }                          //!< Number of symbols in the window
+    std::size_t window_length() const { return d_window_length; }
+    std::size_t pattern_length() const { return d_pattern_length; }
+    bool full() const { return d_window_length > 0 and d_size == d_window_length; }
+
+    /*!
+     * \brief Correlation of the pattern with the window. Only meaningful
+     * when full().
+     */
+    int32_t correlation() const;
+
+private:
+    // bit k of the register is the sign of the symbol pushed k pushes ago
+    std::vector<uint64_t> d_register;
+    std::vector<uint64_t> d_pattern;  // 1 where the pattern is -1, at the bits of the oldest symbols
+    std::vector<uint64_t> d_mask;     // 1 at the bits of the oldest symbols
+    std::size_t d_first_pattern_word{0};
+    std::size_t d_window_length{0};
+    std::size_t d_pattern_length{0};
+    std::size_t d_size{0};
+    uint64_t d_top_word_mask{0};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SIGN_CORRELATOR_H
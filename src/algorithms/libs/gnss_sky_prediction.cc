@@ -0,0 +1,175 @@
+/*!
+ * \file gnss_sky_prediction.cc
+ * \brief Elevation, azimuth and Doppler shift predicted for each satellite,
+ * published by the control thread and read by the acquisition scheduler.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sky_prediction.h"
+#include <algorithm>
+#include <mutex>
+#include <thread>
+
+
+std::shared_ptr<Gnss_Sky_Prediction> Gnss_Sky_Prediction::get()
+{
+    static std::mutex prediction_mutex;
+    static std::weak_ptr<Gnss_Sky_Prediction> weak;
+    std::lock_guard<std::mutex> lock(prediction_mutex);
+    auto prediction = weak.lock();
+    if (prediction == nullptr)
+        {
+            prediction = std::make_shared<Gnss_Sky_Prediction>();
+            weak = prediction;
+        }
+    return prediction;
+}
+
+
+int32_t Gnss_Sky_Prediction::slot_index(char System, uint32_t PRN)
+{
+    if (PRN == 0 or PRN > max_prn)
+        {
+            return -1;
+        }
+    switch (System)
+        {
+        case 'G':
+            return static_cast<int32_t>(PRN - 1);
+        case 'E':
+            return static_cast<int32_t>(max_prn + PRN - 1);
+        case 'C':
+            return static_cast<int32_t>(2 * max_prn + PRN - 1);
+        default:
+            return -1;
+        }
+}
+
+
+char Gnss_Sky_Prediction::slot_system(int32_t index)
+{
+    const std::array<char, 3> systems{'G', 'E', 'C'};
+    return systems[index / max_prn];
+}
+
+
+void Gnss_Sky_Prediction::publish(const std::vector<Gnss_Sky_Satellite>& satellites, double time_s)
+{
+    const uint64_t sequence = d_sequence.load(std::memory_order_relaxed);
+    d_sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    // number of the table being written
+    const uint64_t table = sequence / 2 + 1;
+    for (const auto& satellite : satellites)
+        {
+            const int32_t index = slot_index(satellite.System, satellite.PRN);
+            if (index < 0)
+                {
+                    continue;
+                }
+            Slot& slot = d_slots[index];
+            slot.elevation_deg.store(satellite.elevation_deg, std::memory_order_relaxed);
+            slot.azimuth_deg.store(satellite.azimuth_deg, std::memory_order_relaxed);
+            slot.doppler_hz.store(satellite.doppler_hz, std::memory_order_relaxed);
+            slot.doppler_rate_hz_s.store(satellite.doppler_rate_hz_s, std::memory_order_relaxed);
+            slot.table.store(table, std::memory_order_relaxed);
+        }
+    d_time_s.store(time_s, std::memory_order_relaxed);
+
+    d_sequence.store(sequence + 2, std::memory_order_release);
+}
+
+
+bool Gnss_Sky_Prediction::predict(char System, uint32_t PRN, Gnss_Sky_Satellite& satellite) const
+{
+    const int32_t index = slot_index(System, PRN);
+    if (index < 0)
+        {
+            return false;
+        }
+    const Slot& slot = d_slots[index];
+    while (true)
+        {
+            const uint64_t sequence = d_sequence.load(std::memory_order_acquire);
+            if (sequence % 2 == 1)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+            const uint64_t table = sequence / 2;
+            if (table == 0 or slot.table.load(std::memory_order_relaxed) != table)
+                {
+                    return false;
+                }
+            satellite.elevation_deg = slot.elevation_deg.load(std::memory_order_relaxed);
+            satellite.azimuth_deg = slot.azimuth_deg.load(std::memory_order_relaxed);
+            satellite.doppler_hz = slot.doppler_hz.load(std::memory_order_relaxed);
+            satellite.doppler_rate_hz_s = slot.doppler_rate_hz_s.load(std::memory_order_relaxed);
+            satellite.PRN = PRN;
+            satellite.System = System;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (d_sequence.load(std::memory_order_relaxed) == sequence)
+                {
+                    return true;
+                }
+        }
+}
+
+
+double Gnss_Sky_Prediction::visible(std::vector<Gnss_Sky_Satellite>& satellites, double min_elevation_deg) const
+{
+    double time_s = 0.0;
+    while (true)
+        {
+            satellites.clear();
+            const uint64_t sequence = d_sequence.load(std::memory_order_acquire);
+            if (sequence % 2 == 1)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+            const uint64_t table = sequence / 2;
+            if (table == 0)
+                {
+                    return 0.0;
+                }
+            for (int32_t index = 0; index < static_cast<int32_t>(d_slots.size()); index++)
+                {
+                    const Slot& slot = d_slots[index];
+                    if (slot.table.load(std::memory_order_relaxed) != table)
+                        {
+                            continue;
+                        }
+                    Gnss_Sky_Satellite satellite;
+                    satellite.elevation_deg = slot.elevation_deg.load(std::memory_order_relaxed);
+                    if (satellite.elevation_deg < min_elevation_deg)
+                        {
+                            continue;
+                        }
+                    satellite.azimuth_deg = slot.azimuth_deg.load(std::memory_order_relaxed);
+                    satellite.doppler_hz = slot.doppler_hz.load(std::memory_order_relaxed);
+                    satellite.doppler_rate_hz_s = slot.doppler_rate_hz_s.load(std::memory_order_relaxed);
+                    satellite.PRN = static_cast<uint32_t>(index % max_prn) + 1;
+                    satellite.System = slot_system(index);
+                    satellites.push_back(satellite);
+                }
+            time_s = d_time_s.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (d_sequence.load(std::memory_order_relaxed) == sequence)
+                {
+                    break;
+                }
+        }
+    std::sort(satellites.begin(), satellites.end(), [](const Gnss_Sky_Satellite& a, const Gnss_Sky_Satellite& b) { return a.elevation_deg > b.elevation_deg; });
+    return time_s;
+}
@@ -0,0 +1,105 @@
+/*!
+ * \file gnss_sky_prediction.h
+ * \brief Elevation, azimuth and Doppler shift predicted for each satellite,
+ * published by the control thread and read by the acquisition scheduler.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SKY_PREDICTION_H
+#define GNSS_SDR_GNSS_SKY_PREDICTION_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Prediction for a satellite
+ */
+struct Gnss_Sky_Satellite
+{
+    double elevation_deg{0.0};
+    double azimuth_deg{0.0};
+    double doppler_hz{0.0};         //!< Doppler shift at the first carrier of the system (L1, E1, B1I), with the receiver clock drift
+    double doppler_rate_hz_s{0.0};  //!< Rate of change of doppler_hz
+    uint32_t PRN{0};
+    char System{0};  //!< As in Gnss_Satellite::get_system_short(): 'G', 'E' or 'C'
+};
+
+
+/*!
+ * \brief Table of predictions for all the satellites, written once per
+ * second by the control thread and read by the acquisition scheduler.
+ *
+ * There is one table in the process. As in Gnss_Navigation_State, the
+ * writer and the readers take no locks: the table is a sequence lock, and a
+ * reader that overlaps with the writer retries.
+ */
+class Gnss_Sky_Prediction
+{
+public:
+    static constexpr uint32_t max_prn = 64;  // per system
+
+    /*!
+     * \brief Returns the table of the process, which is created if it does
+     * not exist. It is destroyed when the last user releases it.
+     */
+    static std::shared_ptr<Gnss_Sky_Prediction> get();
+
+    /*!
+     * \brief Replaces the table with satellites, predicted at time_s. Must
+     * be called by a single writer.
+     */
+    void publish(const std::vector<Gnss_Sky_Satellite>& satellites, double time_s);
+
+    /*!
+     * \brief Gets the prediction of a satellite in the last table. Returns
+     * false if there is none.
+     */
+    bool predict(char System, uint32_t PRN, Gnss_Sky_Satellite& satellite) const;
+
+    /*!
+     * \brief Copies the satellites of the last table above
+     * min_elevation_deg to satellites, the highest first. Returns the time
+     * of the table, or 0 if no table was published.
+     */
+    double visible(std::vector<Gnss_Sky_Satellite>& satellites, double min_elevation_deg = 0.0) const;
+
+private:
+    struct Slot
+    {
+        std::atomic<double> elevation_deg{0.0};
+        std::atomic<double> azimuth_deg{0.0};
+        std::atomic<double> doppler_hz{0.0};
+        std::atomic<double> doppler_rate_hz_s{0.0};
+        std::atomic<uint64_t> table{0};
+    };
+
+    static int32_t slot_index(char System, uint32_t PRN);
+    static char slot_system(int32_t index);
+
+    std::array<Slot, 3 * max_prn> d_slots{};
+    std::atomic<double> d_time_s{0.0};
+    std::atomic<uint64_t> d_sequence{0};  // odd while the writer publishes a table
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SKY_PREDICTION_H
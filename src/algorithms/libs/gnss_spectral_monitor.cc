@@ -0,0 +1,436 @@
+/*!
+ * \file gnss_spectral_monitor.cc
+ * \brief Welch power spectral density of the samples of an RF channel,
+ * estimated on its own thread and shared by the input stages of the channel.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_spectral_monitor.h"
+#include "MATH_CONSTANTS.h"  // for TWO_PI
+#include "gnss_capture_trigger.h"
+#include <algorithm>  // for copy_n, count_if, fill, max_element, nth_element
+#include <array>
+#include <cctype>     // for isdigit
+#include <cmath>      // for cos, log10, pow
+#include <map>
+#include <sstream>
+#include <stdexcept>  // for invalid_argument
+#include <utility>
+
+
+namespace
+{
+std::mutex spectral_monitors_mutex;
+std::map<uint32_t, std::shared_ptr<Gnss_Spectral_Monitor>> spectral_monitors;
+
+// Metrics of report_all(), in the order of Gnss_Spectral_Monitor::metrics()
+const std::array<std::pair<const char*, const char*>, 7> SPECTRAL_MONITOR_METRICS{{{"gnss_sdr_spectral_total_power_db", "gauge"},
+    {"gnss_sdr_spectral_noise_floor_db", "gauge"},
+    {"gnss_sdr_spectral_peak_to_floor_db", "gauge"},
+    {"gnss_sdr_spectral_peak_offset_hz", "gauge"},
+    {"gnss_sdr_spectral_interference_bins", "gauge"},
+    {"gnss_sdr_spectral_dropped_segments", "counter"},
+    {"gnss_sdr_spectral_psd_db", "gauge"}}};
+
+
+float spectral_monitor_db(float power)
+{
+    return 10.0F * std::log10(power + 1e-30F);
+}
+}  // namespace
+
+
+Gnss_Spectral_Monitor::Gnss_Spectral_Monitor(int32_t fft_length,
+    int32_t decimation,
+    int32_t averages,
+    double sampling_frequency,
+    float threshold_db,
+    int32_t queue_segments)
+    : d_sampling_frequency(sampling_frequency),
+      d_window_power(0.0),
+      d_threshold(std::pow(10.0F, threshold_db / 10.0F)),
+      d_fft_length(fft_length),
+      d_decimation(decimation),
+      d_averages(averages)
+{
+    if (fft_length < 8)
+        {
+            throw std::invalid_argument("Gnss_Spectral_Monitor: the FFT length must be at least 8");
+        }
+    if (decimation < 1 or averages < 1 or queue_segments < 1)
+        {
+            throw std::invalid_argument("Gnss_Spectral_Monitor: the decimation, the averages and the queue length must be positive");
+        }
+    d_fft = gnss_fft_fwd_make_unique(fft_length);
+    d_segments = std::vector<std::vector<gr_complex>>(queue_segments, std::vector<gr_complex>(fft_length));
+    d_accumulated = std::vector<float>(fft_length, 0.0);
+    d_window = std::vector<float>(fft_length);
+    for (int32_t n = 0; n < fft_length; n++)
+        {
+            // Hann window
+            d_window[n] = 0.5F - 0.5F * static_cast<float>(std::cos(TWO_PI * static_cast<double>(n) / static_cast<double>(fft_length)));
+            d_window_power += d_window[n] * d_window[n];
+        }
+}
+
+
+Gnss_Spectral_Monitor::~Gnss_Spectral_Monitor()
+{
+    stop();
+}
+
+
+void Gnss_Spectral_Monitor::start()
+{
+    if (d_thread.joinable())
+        {
+            return;
+        }
+    {
+        std::lock_guard<std::mutex> lock(d_queue_mutex);
+        d_stop = false;
+    }
+    d_thread = std::thread(&Gnss_Spectral_Monitor::run, this);
+}
+
+
+void Gnss_Spectral_Monitor::stop()
+{
+    if (!d_thread.joinable())
+        {
+            return;
+        }
+    {
+        std::lock_guard<std::mutex> lock(d_queue_mutex);
+        d_stop = true;
+    }
+    d_queue_cv.notify_one();
+    d_thread.join();
+}
+
+
+void Gnss_Spectral_Monitor::push(const gr_complex* in, int32_t n)
+{
+    int32_t done = 0;
+    while (done < n)
+        {
+            if (d_skip > 0)
+                {
+                    const auto skipped = static_cast<int32_t>(std::min(d_skip, static_cast<int64_t>(n - done)));
+                    d_skip -= skipped;
+                    done += skipped;
+                    continue;
+                }
+            if (d_filling < 0)
+                {
+                    std::lock_guard<std::mutex> lock(d_queue_mutex);
+                    if (d_queued == static_cast<int32_t>(d_segments.size()))
+                        {
+                            // the thread is still busy with the previous segments
+                            d_dropped++;
+                            d_skip = static_cast<int64_t>(d_decimation) * d_fft_length;
+                            continue;
+                        }
+                    d_filling = (d_head + d_queued) % static_cast<int32_t>(d_segments.size());
+                }
+            const int32_t copied = std::min(n - done, d_fft_length - d_filled);
+            std::copy_n(in + done, copied, d_segments[d_filling].data() + d_filled);
+            d_filled += copied;
+            done += copied;
+            if (d_filled == d_fft_length)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(d_queue_mutex);
+                        d_queued++;
+                    }
+                    d_queue_cv.notify_one();
+                    d_filling = -1;
+                    d_filled = 0;
+                    d_skip = static_cast<int64_t>(d_decimation - 1) * d_fft_length;
+                }
+        }
+}
+
+
+void Gnss_Spectral_Monitor::process_pending()
+{
+    while (true)
+        {
+            int32_t segment = 0;
+            {
+                std::lock_guard<std::mutex> lock(d_queue_mutex);
+                if (d_queued == 0)
+                    {
+                        return;
+                    }
+                segment = d_head;
+            }
+            analyze(d_segments[segment].data());
+            std::lock_guard<std::mutex> lock(d_queue_mutex);
+            d_head = (d_head + 1) % static_cast<int32_t>(d_segments.size());
+            d_queued--;
+        }
+}
+
+
+void Gnss_Spectral_Monitor::run()
+{
+    std::unique_lock<std::mutex> lock(d_queue_mutex);
+    while (true)
+        {
+            d_queue_cv.wait(lock, [this] { return d_stop or d_queued > 0; });
+            if (d_stop)
+                {
+                    return;
+                }
+            // push() does not write the queued segments, so they are analyzed without the lock
+            const int32_t segment = d_head;
+            lock.unlock();
+            analyze(d_segments[segment].data());
+            lock.lock();
+            d_head = (d_head + 1) % static_cast<int32_t>(d_segments.size());
+            d_queued--;
+        }
+}
+
+
+void Gnss_Spectral_Monitor::analyze(const gr_complex* segment)
+{
+    gr_complex* fft_in = d_fft->get_inbuf();
+    for (int32_t n = 0; n < d_fft_length; n++)
+        {
+            fft_in[n] = segment[n] * d_window[n];
+        }
+    d_fft->execute();
+    const gr_complex* fft_out = d_fft->get_outbuf();
+    for (int32_t k = 0; k < d_fft_length; k++)
+        {
+            d_accumulated[k] += std::norm(fft_out[k]);
+        }
+    d_n_accumulated++;
+    if (d_n_accumulated == d_averages)
+        {
+            publish();
+            std::fill(d_accumulated.begin(), d_accumulated.end(), 0.0F);
+            d_n_accumulated = 0;
+        }
+}
+
+
+void Gnss_Spectral_Monitor::publish()
+{
+    Gnss_Spectral_Estimate estimate;
+    estimate.sampling_frequency = d_sampling_frequency;
+    estimate.psd = std::vector<float>(d_fft_length);
+    // white noise of power P gives P times the energy of the window in each bin
+    const float scale = 1.0F / (static_cast<float>(d_averages) * d_window_power);
+    const int32_t dc_bin = d_fft_length / 2;
+    double total_power = 0.0;
+    for (int32_t k = 0; k < d_fft_length; k++)
+        {
+            estimate.psd[k] = d_accumulated[(k + d_fft_length - dc_bin) % d_fft_length] * scale;
+            total_power += static_cast<double>(estimate.psd[k]);
+        }
+    estimate.total_power = static_cast<float>(total_power / static_cast<double>(d_fft_length));
+
+    // noise floor, without the bins well above the median
+    std::vector<float> sorted(estimate.psd);
+    std::nth_element(sorted.begin(), sorted.begin() + dc_bin, sorted.end());
+    const float ceiling = sorted[dc_bin] * d_threshold;
+    double floor_power = 0.0;
+    int32_t floor_bins = 0;
+    for (const float bin : estimate.psd)
+        {
+            if (bin <= ceiling)
+                {
+                    floor_power += static_cast<double>(bin);
+                    floor_bins++;
+                }
+        }
+    estimate.noise_variance = floor_bins > 0 ? static_cast<float>(floor_power / static_cast<double>(floor_bins)) : 0.0F;
+
+    const auto peak = std::max_element(estimate.psd.cbegin(), estimate.psd.cend());
+    estimate.peak_to_floor_db = spectral_monitor_db(*peak) - spectral_monitor_db(estimate.noise_variance);
+    estimate.peak_offset_hz = static_cast<float>(static_cast<double>(peak - estimate.psd.cbegin() - dc_bin) * d_sampling_frequency / static_cast<double>(d_fft_length));
+    const float interference_level = estimate.noise_variance * d_threshold;
+    estimate.interference_bins = static_cast<uint32_t>(std::count_if(estimate.psd.cbegin(), estimate.psd.cend(), [interference_level](float bin) { return bin > interference_level; }));
+    estimate.sequence = d_sequence.load() + 1;
+
+    const bool interference = estimate.interference_bins > 0;
+    {
+        std::lock_guard<std::mutex> lock(d_estimate_mutex);
+        d_estimate = std::move(estimate);
+    }
+    d_sequence++;
+
+    // the onset of an interference may trigger a capture of the last samples
+    if (interference and !d_interference)
+        {
+            const std::shared_ptr<Gnss_Capture_Trigger> trigger = Gnss_Capture_Trigger::global_instance();
+            if (trigger != nullptr)
+                {
+                    trigger->fire("interference");
+                }
+        }
+    d_interference = interference;
+}
+
+
+bool Gnss_Spectral_Monitor::estimate(Gnss_Spectral_Estimate& estimate) const
+{
+    std::lock_guard<std::mutex> lock(d_estimate_mutex);
+    if (d_estimate.sequence == 0)
+        {
+            return false;
+        }
+    estimate = d_estimate;
+    return true;
+}
+
+
+uint64_t Gnss_Spectral_Monitor::sequence() const
+{
+    return d_sequence.load();
+}
+
+
+float Gnss_Spectral_Monitor::noise_variance() const
+{
+    std::lock_guard<std::mutex> lock(d_estimate_mutex);
+    return d_estimate.noise_variance;
+}
+
+
+float Gnss_Spectral_Monitor::total_power() const
+{
+    std::lock_guard<std::mutex> lock(d_estimate_mutex);
+    return d_estimate.total_power;
+}
+
+
+uint64_t Gnss_Spectral_Monitor::dropped_segments() const
+{
+    return d_dropped.load();
+}
+
+
+std::vector<std::string> Gnss_Spectral_Monitor::metrics(uint32_t rf_channel, int32_t psd_bins) const
+{
+    std::vector<std::string> lines(SPECTRAL_MONITOR_METRICS.size());
+    Gnss_Spectral_Estimate last;
+    if (!estimate(last))
+        {
+            return lines;
+        }
+    const std::string label = "{rf_channel=\"" + std::to_string(rf_channel) + "\"}";
+    const std::array<double, 6> values{spectral_monitor_db(last.total_power), spectral_monitor_db(last.noise_variance),
+        last.peak_to_floor_db, last.peak_offset_hz, static_cast<double>(last.interference_bins), static_cast<double>(dropped_segments())};
+    for (size_t m = 0; m < values.size(); m++)
+        {
+            std::stringstream line;
+            line << SPECTRAL_MONITOR_METRICS[m].first << label << ' ' << values[m] << '\n';
+            lines[m] = line.str();
+        }
+
+    // power spectral density averaged over psd_bins groups of bins, at the frequency of their centers
+    const auto n_bins = static_cast<int32_t>(last.psd.size());
+    psd_bins = std::min(psd_bins, n_bins);
+    std::stringstream psd;
+    for (int32_t b = 0; b < psd_bins; b++)
+        {
+            const int32_t first = b * n_bins / psd_bins;
+            const int32_t last_bin = (b + 1) * n_bins / psd_bins;
+            double power = 0.0;
+            for (int32_t k = first; k < last_bin; k++)
+                {
+                    power += static_cast<double>(last.psd[k]);
+                }
+            const double center_bin = 0.5 * static_cast<double>(first + last_bin - 1) - static_cast<double>(n_bins / 2);
+            psd << SPECTRAL_MONITOR_METRICS.back().first << "{rf_channel=\"" << rf_channel << "\",offset_hz=\""
+                << static_cast<int64_t>(center_bin * last.sampling_frequency / static_cast<double>(n_bins)) << "\"} "
+                << spectral_monitor_db(static_cast<float>(power / static_cast<double>(last_bin - first))) << '\n';
+        }
+    lines.back() = psd.str();
+    return lines;
+}
+
+
+void Gnss_Spectral_Monitor::set_instance(uint32_t rf_channel, std::shared_ptr<Gnss_Spectral_Monitor> monitor)
+{
+    std::lock_guard<std::mutex> lock(spectral_monitors_mutex);
+    if (monitor == nullptr)
+        {
+            spectral_monitors.erase(rf_channel);
+            return;
+        }
+    spectral_monitors[rf_channel] = std::move(monitor);
+}
+
+
+std::shared_ptr<Gnss_Spectral_Monitor> Gnss_Spectral_Monitor::instance(uint32_t rf_channel)
+{
+    std::lock_guard<std::mutex> lock(spectral_monitors_mutex);
+    const auto it = spectral_monitors.find(rf_channel);
+    return it == spectral_monitors.cend() ? nullptr : it->second;
+}
+
+
+void Gnss_Spectral_Monitor::clear_instances()
+{
+    std::lock_guard<std::mutex> lock(spectral_monitors_mutex);
+    spectral_monitors.clear();
+}
+
+
+std::string Gnss_Spectral_Monitor::report_all(int32_t psd_bins)
+{
+    std::map<uint32_t, std::shared_ptr<Gnss_Spectral_Monitor>> monitors;
+    {
+        std::lock_guard<std::mutex> lock(spectral_monitors_mutex);
+        monitors = spectral_monitors;
+    }
+    if (monitors.empty())
+        {
+            return std::string();
+        }
+    // the samples of each metric follow its TYPE line
+    std::vector<std::string> families(SPECTRAL_MONITOR_METRICS.size());
+    for (const auto& monitor : monitors)
+        {
+            const std::vector<std::string> lines = monitor.second->metrics(monitor.first, psd_bins);
+            for (size_t m = 0; m < lines.size(); m++)
+                {
+                    families[m] += lines[m];
+                }
+        }
+    std::string report;
+    for (size_t m = 0; m < families.size(); m++)
+        {
+            report += std::string("# TYPE ") + SPECTRAL_MONITOR_METRICS[m].first + ' ' + SPECTRAL_MONITOR_METRICS[m].second + '\n' + families[m];
+        }
+    return report;
+}
+
+
+uint32_t Gnss_Spectral_Monitor::rf_channel(const std::string& role)
+{
+    size_t first_digit = role.size();
+    while (first_digit > 0 and std::isdigit(static_cast<unsigned char>(role[first_digit - 1])))
+        {
+            first_digit--;
+        }
+    if (first_digit == role.size())
+        {
+            return 0;
+        }
+    return static_cast<uint32_t>(std::stoul(role.substr(first_digit)));
+}
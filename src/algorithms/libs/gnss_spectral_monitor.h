@@ -0,0 +1,151 @@
+/*!
+ * \file gnss_spectral_monitor.h
+ * \brief Welch power spectral density of the samples of an RF channel,
+ * estimated on its own thread and shared by the input stages of the channel.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SPECTRAL_MONITOR_H
+#define GNSS_SDR_GNSS_SPECTRAL_MONITOR_H
+
+#include "gnss_sdr_fft.h"
+#include <gnuradio/gr_complex.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Power spectral density of an RF channel and the figures derived
+ * from it.
+ */
+struct Gnss_Spectral_Estimate
+{
+    std::vector<float> psd;          // power per bin, with the DC bin at psd.size() / 2, normalized so that white noise of power P gives P in each bin
+    double sampling_frequency{0.0};  // [Hz]
+    float total_power{0.0};          // power of the samples, mean of the bins
+    float noise_variance{0.0};       // power of the samples without the narrowband interferences, from the noise floor
+    float peak_to_floor_db{0.0};     // highest bin over the noise floor [dB]
+    float peak_offset_hz{0.0};       // frequency of the highest bin
+    uint32_t interference_bins{0};   // bins above the noise floor by more than the interference threshold
+    uint64_t sequence{0};            // number of the estimate, from 1
+};
+
+
+/*!
+ * \brief Estimates the power spectral density of the samples of an RF
+ * channel with the Welch method, on its own thread, for all the stages of
+ * the channel: the notch filters and the pulse blanker take their noise
+ * floor from it, the bit selection its power, and an interference monitor
+ * exports it, so that the samples go through a single FFT pipeline.
+ *
+ * One segment of fft_length samples out of every decimation segments is
+ * copied by push(), windowed (Hann) and transformed on the thread of the
+ * monitor, and the estimate is published after averaging averages of them.
+ * The segments that arrive while the thread is busy with queue_segments of
+ * them are dropped, so push() never waits for the analysis.
+ *
+ * The noise floor is the mean of the bins below the median raised by
+ * threshold_db, and the bins above the floor by more than threshold_db are
+ * counted as interference. The first estimate with interference bins after
+ * one without them fires an "interference" capture trigger.
+ *
+ * The monitors are owned by the flow graph, which publishes the one of each
+ * RF channel through set_instance() so that the blocks can find it.
+ */
+class Gnss_Spectral_Monitor
+{
+public:
+    /*!
+     * \brief Throws std::invalid_argument if fft_length is smaller than 8,
+     * or decimation, averages or queue_segments are not positive.
+     */
+    Gnss_Spectral_Monitor(int32_t fft_length, int32_t decimation, int32_t averages, double sampling_frequency, float threshold_db = 10.0, int32_t queue_segments = 4);
+    ~Gnss_Spectral_Monitor();
+
+    void start();  //!< Starts the thread that analyzes the segments
+    void stop();   //!< Stops it, the segments are then analyzed by process_pending()
+
+    //! Takes the next n samples of the RF channel
+    void push(const gr_complex* in, int32_t n);
+
+    //! Analyzes the queued segments in the calling thread (without a thread, and for testing)
+    void process_pending();
+
+    //! Copies the last estimate, returns false if there is none yet
+    bool estimate(Gnss_Spectral_Estimate& estimate) const;
+
+    uint64_t sequence() const;          //!< Number of the last estimate, 0 if there is none yet
+    float noise_variance() const;       //!< Of the last estimate
+    float total_power() const;          //!< Of the last estimate
+    uint64_t dropped_segments() const;  //!< Segments dropped because the thread was busy
+
+    static void set_instance(uint32_t rf_channel, std::shared_ptr<Gnss_Spectral_Monitor> monitor);
+    static std::shared_ptr<Gnss_Spectral_Monitor> instance(uint32_t rf_channel);  //!< null if the RF channel has no monitor
+    static void clear_instances();
+
+    /*!
+     * \brief Last estimates of all the monitors published, in the Prometheus
+     * text format, with psd_bins bins of their power spectral density.
+     */
+    static std::string report_all(int32_t psd_bins);
+
+    //! RF channel of a block role, from its trailing number ("InputFilter1" is 1, "InputFilter" is 0)
+    static uint32_t rf_channel(const std::string& role);
+
+private:
+    void run();
+    void analyze(const gr_complex* segment);
+    void publish();
+    std::vector<std::string> metrics(uint32_t rf_channel, int32_t psd_bins) const;  // the lines of each metric of report_all()
+
+    std::unique_ptr<gnss_fft_complex_fwd> d_fft;
+    std::vector<std::vector<gr_complex>> d_segments;  // queue of the segments to analyze
+    std::vector<float> d_window;
+    std::vector<float> d_accumulated;
+    Gnss_Spectral_Estimate d_estimate;
+    std::thread d_thread;
+    mutable std::mutex d_queue_mutex;
+    mutable std::mutex d_estimate_mutex;
+    std::condition_variable d_queue_cv;
+    std::atomic<uint64_t> d_sequence{0};
+    std::atomic<uint64_t> d_dropped{0};
+    double d_sampling_frequency;
+    float d_window_power;
+    float d_threshold;
+    int32_t d_fft_length;
+    int32_t d_decimation;
+    int32_t d_averages;
+    int32_t d_n_accumulated{0};
+    int32_t d_head{0};      // first segment queued
+    int32_t d_queued{0};    // segments queued
+    int32_t d_filling{-1};  // segment being copied by push(), -1 if none
+    int32_t d_filled{0};    // samples copied to it
+    int64_t d_skip{0};      // samples to skip before the next segment
+    bool d_stop{false};
+    bool d_interference{false};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SPECTRAL_MONITOR_H
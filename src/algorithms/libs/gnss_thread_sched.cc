@@ -0,0 +1,157 @@
+/*!
+ * \file gnss_thread_sched.cc
+ * \brief Scheduling classes of the threads of the receiver, and locking and
+ * huge pages of its memory, for the real-time operation on Linux.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_thread_sched.h"
+#include <glog/logging.h>
+#include <sched.h>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>  // for strerror
+#include <mutex>
+#if defined(__linux__)
+#include <malloc.h>
+#include <sys/mman.h>
+#endif
+
+
+namespace
+{
+std::mutex helper_sched_mutex;
+Gnss_Thread_Sched helper_sched;
+
+
+bool sched_policy_from_name(const std::string& name, int& policy)
+{
+    if (name == "other")
+        {
+            policy = SCHED_OTHER;
+        }
+    else if (name == "fifo")
+        {
+            policy = SCHED_FIFO;
+        }
+    else if (name == "rr")
+        {
+            policy = SCHED_RR;
+        }
+#if defined(__linux__)
+    else if (name == "batch")
+        {
+            policy = SCHED_BATCH;
+        }
+    else if (name == "idle")
+        {
+            policy = SCHED_IDLE;
+        }
+#endif
+    else
+        {
+            return false;
+        }
+    return true;
+}
+}  // namespace
+
+
+std::string gnss_set_thread_sched(pthread_t thread, const Gnss_Thread_Sched& sched)
+{
+    if (sched.policy.empty())
+        {
+            return std::string();
+        }
+    int policy = SCHED_OTHER;
+    if (!sched_policy_from_name(sched.policy, policy))
+        {
+            return "unknown scheduling policy " + sched.policy;
+        }
+    sched_param param{};
+    param.sched_priority = ((policy == SCHED_FIFO or policy == SCHED_RR) ? sched.priority : 0);
+    if ((policy == SCHED_FIFO or policy == SCHED_RR) and
+        (param.sched_priority < sched_get_priority_min(policy) or param.sched_priority > sched_get_priority_max(policy)))
+        {
+            return "priority " + std::to_string(sched.priority) + " out of the range of the policy " + sched.policy;
+        }
+    const int error = pthread_setschedparam(thread, policy, &param);
+    if (error != 0)
+        {
+            return std::strerror(error);
+        }
+    return std::string();
+}
+
+
+void gnss_set_helper_thread_sched(const Gnss_Thread_Sched& sched)
+{
+    std::lock_guard<std::mutex> lock(helper_sched_mutex);
+    helper_sched = sched;
+}
+
+
+void gnss_apply_helper_thread_sched(const std::string& thread_name)
+{
+    Gnss_Thread_Sched sched;
+    {
+        std::lock_guard<std::mutex> lock(helper_sched_mutex);
+        sched = helper_sched;
+    }
+    const std::string error = gnss_set_thread_sched(pthread_self(), sched);
+    if (!error.empty())
+        {
+            LOG(WARNING) << "The thread of the " << thread_name << " did not get the scheduling policy " << sched.policy << ": " << error;
+        }
+}
+
+
+std::string gnss_lock_memory()
+{
+#if defined(__linux__)
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+        {
+            return std::strerror(errno);
+        }
+    // the freed memory is reused without new page faults
+    mallopt(M_TRIM_THRESHOLD, -1);
+    return std::string();
+#else
+    return "memory locking is only supported on Linux";
+#endif
+}
+
+
+std::string gnss_advise_huge_pages(const void* base, size_t bytes, size_t& advised_bytes)
+{
+    advised_bytes = 0;
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    const uintptr_t huge_page = 2097152U;
+    const auto start = reinterpret_cast<uintptr_t>(base);
+    const uintptr_t first = (start + huge_page - 1U) / huge_page * huge_page;
+    const uintptr_t last = (start + bytes) / huge_page * huge_page;
+    if (base == nullptr or last <= first)
+        {
+            return "the memory does not hold a whole huge page";
+        }
+    if (madvise(reinterpret_cast<void*>(first), last - first, MADV_HUGEPAGE) != 0)
+        {
+            return std::strerror(errno);
+        }
+    advised_bytes = last - first;
+    return std::string();
+#else
+    static_cast<void>(base);
+    static_cast<void>(bytes);
+    return "transparent huge pages are only supported on Linux";
+#endif
+}
@@ -0,0 +1,91 @@
+/*!
+ * \file gnss_thread_sched.h
+ * \brief Scheduling classes of the threads of the receiver, and locking and
+ * huge pages of its memory, for the real-time operation on Linux.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_THREAD_SCHED_H
+#define GNSS_SDR_GNSS_THREAD_SCHED_H
+
+#include <pthread.h>
+#include <cstddef>
+#include <string>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Scheduling class of a thread.
+ *
+ * The policy is "other", "batch", "idle", "fifo" or "rr", as the SCHED_*
+ * policies of Linux. The priority (1 to 99) is only used by "fifo" and "rr".
+ * An empty policy leaves the thread as it is.
+ */
+struct Gnss_Thread_Sched
+{
+    std::string policy;
+    int priority{0};
+};
+
+
+/*!
+ * \brief Sets the scheduling class of thread. Returns an empty string, or
+ * the reason why the thread did not get it. The real-time policies need
+ * CAP_SYS_NICE, or an RLIMIT_RTPRIO of the user at least as high as the
+ * priority.
+ */
+std::string gnss_set_thread_sched(pthread_t thread, const Gnss_Thread_Sched& sched);
+
+/*!
+ * \brief Sets the class of the helper threads of the receiver (dump writers
+ * and recorders), which each of them takes when it starts.
+ */
+void gnss_set_helper_thread_sched(const Gnss_Thread_Sched& sched);
+
+/*!
+ * \brief Called by a helper thread when it starts. A failure is logged with
+ * the name of the thread.
+ */
+void gnss_apply_helper_thread_sched(const std::string& thread_name);
+
+/*!
+ * \brief Locks the current and future pages of the process in memory, so
+ * that each page is faulted in when it is mapped (buffers, heap and thread
+ * stacks) instead of when it is first touched, and freed heap memory is kept
+ * by the process. Returns an empty string, or the reason of the failure.
+ *
+ * Each new thread then holds its whole stack in memory, so the stack size
+ * (ulimit -s) should be reduced for a receiver with many channels.
+ */
+std::string gnss_lock_memory();
+
+/*!
+ * \brief Advises the kernel to back the memory from base to base + bytes
+ * with transparent huge pages, between the first and the last 2 MB boundary
+ * in it. advised_bytes is the memory advised. Returns an empty string, or the
+ * reason of the failure.
+ *
+ * The stream buffers of GNU Radio are shared memory, so the advice needs
+ * /sys/kernel/mm/transparent_hugepage/shmem_enabled set to advise (or /dev/shm
+ * mounted with huge=advise, for the shm_open buffers). The pages already
+ * faulted in are collapsed later by khugepaged.
+ */
+std::string gnss_advise_huge_pages(const void* base, size_t bytes, size_t& advised_bytes);
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_THREAD_SCHED_H
@@ -0,0 +1,111 @@
+/*!
+ * \file gnss_time_tag_channel.cc
+ * \brief Propagation of the GnssTime time tags between processing blocks,
+ * out of the GNU Radio tag system.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_time_tag_channel.h"
+#include <gnuradio/block_detail.h>
+#include <gnuradio/buffer.h>
+#include <iterator>  // for std::next
+#include <map>
+#include <utility>  // for std::move
+
+#if GNURADIO_HAS_BUFFER_READER
+#include <gnuradio/buffer_reader.h>
+#endif
+
+
+std::shared_ptr<Gnss_Time_Tag_Channel> Gnss_Time_Tag_Channel::get(const void* stream)
+{
+    static std::mutex channels_mutex;
+    static std::map<const void*, std::weak_ptr<Gnss_Time_Tag_Channel>> channels;
+    std::lock_guard<std::mutex> lock(channels_mutex);
+    for (auto it = channels.begin(); it != channels.end();)
+        {
+            it = it->second.expired() ? channels.erase(it) : std::next(it);
+        }
+    auto& weak = channels[stream];
+    auto channel = weak.lock();
+    if (channel == nullptr)
+        {
+            channel = std::make_shared<Gnss_Time_Tag_Channel>();
+            weak = channel;
+        }
+    return channel;
+}
+
+
+void Gnss_Time_Tag_Channel::push(uint64_t offset, const GnssTime& time)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    const uint64_t count = d_count.load(std::memory_order_relaxed);
+    d_tags[count % capacity] = Gnss_Time_Tag{offset, time};
+    d_count.store(count + 1, std::memory_order_release);
+}
+
+
+void Gnss_Time_Tag_Reader::attach(std::shared_ptr<Gnss_Time_Tag_Channel> channel)
+{
+    d_channel = std::move(channel);
+    d_next = 0;
+}
+
+
+bool Gnss_Time_Tag_Reader::attached() const
+{
+    return d_channel != nullptr;
+}
+
+
+bool Gnss_Time_Tag_Reader::next(uint64_t begin, uint64_t end, GnssTime& time)
+{
+    if (d_channel == nullptr or d_channel->d_count.load(std::memory_order_acquire) == d_next)
+        {
+            return false;
+        }
+    std::lock_guard<std::mutex> lock(d_channel->d_mutex);
+    const uint64_t count = d_channel->d_count.load(std::memory_order_relaxed);
+    if (count - d_next > Gnss_Time_Tag_Channel::capacity)
+        {
+            d_next = count - Gnss_Time_Tag_Channel::capacity;
+        }
+    while (d_next < count)
+        {
+            const Gnss_Time_Tag& tag = d_channel->d_tags[d_next % Gnss_Time_Tag_Channel::capacity];
+            if (tag.offset >= end)
+                {
+                    return false;
+                }
+            d_next++;
+            if (tag.offset >= begin)
+                {
+                    time = tag.time;
+                    return true;
+                }
+        }
+    return false;
+}
+
+
+std::shared_ptr<Gnss_Time_Tag_Channel> gnss_time_tag_output_channel(gr::block* block, unsigned int port)
+{
+    // the buffer of the stream identifies it for its producer and its consumers
+    return Gnss_Time_Tag_Channel::get(block->detail()->output(port).get());
+}
+
+
+std::shared_ptr<Gnss_Time_Tag_Channel> gnss_time_tag_input_channel(gr::block* block, unsigned int port)
+{
+    return Gnss_Time_Tag_Channel::get(block->detail()->input(port)->buffer().get());
+}
@@ -0,0 +1,113 @@
+/*!
+ * \file gnss_time_tag_channel.h
+ * \brief Propagation of the GnssTime time tags between processing blocks,
+ * out of the GNU Radio tag system.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_TIME_TAG_CHANNEL_H
+#define GNSS_SDR_GNSS_TIME_TAG_CHANNEL_H
+
+#include "gnss_time.h"
+#include <gnuradio/block.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Time tag attached to the item with index offset of a stream
+ */
+struct Gnss_Time_Tag
+{
+    uint64_t offset;
+    GnssTime time;
+};
+
+
+/*!
+ * \brief Fixed-size ring of the time tags of a stream, written by the block
+ * producing the stream and read by the blocks consuming it.
+ *
+ * The tags must be pushed in increasing order of offset. Readers that fall
+ * more than capacity tags behind lose the oldest ones. There are no memory
+ * allocations after the creation of the channel, and reading a stream
+ * without new tags does not take the lock.
+ */
+class Gnss_Time_Tag_Channel
+{
+public:
+    static constexpr uint64_t capacity = 64;
+
+    /*!
+     * \brief Returns the channel of the stream identified by stream, which
+     * is created if it does not exist. It is destroyed when the last block
+     * using it releases it.
+     */
+    static std::shared_ptr<Gnss_Time_Tag_Channel> get(const void* stream);
+
+    void push(uint64_t offset, const GnssTime& time);
+
+private:
+    friend class Gnss_Time_Tag_Reader;
+
+    std::mutex d_mutex;
+    std::array<Gnss_Time_Tag, capacity> d_tags{};
+    std::atomic<uint64_t> d_count{0};
+};
+
+
+/*!
+ * \brief Reader of a Gnss_Time_Tag_Channel, which keeps its own position
+ */
+class Gnss_Time_Tag_Reader
+{
+public:
+    void attach(std::shared_ptr<Gnss_Time_Tag_Channel> channel);
+    bool attached() const;
+
+    /*!
+     * \brief Gets the next tag with an offset in [begin, end). Older tags
+     * are discarded and newer tags are kept for the next calls. Returns
+     * false if there are no such tags.
+     */
+    bool next(uint64_t begin, uint64_t end, GnssTime& time);
+
+private:
+    std::shared_ptr<Gnss_Time_Tag_Channel> d_channel;
+    uint64_t d_next{0};
+};
+
+
+/*!
+ * \brief Channel of the output stream port of a block. It must be called
+ * from the work function, once the block is connected.
+ */
+std::shared_ptr<Gnss_Time_Tag_Channel> gnss_time_tag_output_channel(gr::block* block, unsigned int port);
+
+/*!
+ * \brief Channel of the input stream port of a block. It must be called from
+ * the work function, once the block is connected.
+ */
+std::shared_ptr<Gnss_Time_Tag_Channel> gnss_time_tag_input_channel(gr::block* block, unsigned int port);
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_TIME_TAG_CHANNEL_H
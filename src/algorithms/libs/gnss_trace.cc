@@ -0,0 +1,226 @@
+/*!
+ * \file gnss_trace.cc
+ * \brief Low-overhead trace of the scheduling of the receiver, written in the
+ * Chrome trace format (also read by Perfetto)
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_trace.h"
+#include <algorithm>  // for max
+#include <chrono>
+#include <cstdio>  // for snprintf
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+#if defined(__linux__)
+#include <pthread.h>  // for pthread_getname_np
+#endif
+
+
+std::atomic<bool> Gnss_Trace::s_enabled{false};
+
+
+namespace
+{
+// the oldest events of a full ring are not written, as a thread may be
+// overwriting them
+constexpr uint64_t TRACE_GUARD_EVENTS = 16;
+
+struct Trace_Thread_Buffer
+{
+    std::vector<Gnss_Trace_Event> events;
+    std::atomic<uint64_t> count{0};  // events recorded, published after each one
+    std::string thread_name;
+    uint64_t generation{0};
+    int tid{0};
+};
+
+struct Trace_State
+{
+    std::mutex mutex;
+    std::vector<std::shared_ptr<Trace_Thread_Buffer>> buffers;  // of the current generation
+    std::atomic<uint64_t> generation{0};
+    std::atomic<int64_t> start_ns{0};  // of the steady clock
+    size_t events_per_thread{65536};
+};
+
+
+int64_t trace_now_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+Trace_State& trace_state()
+{
+    static Trace_State state;
+    return state;
+}
+
+
+std::shared_ptr<Trace_Thread_Buffer> trace_register_thread(uint64_t generation)
+{
+    Trace_State& state = trace_state();
+    auto buffer = std::make_shared<Trace_Thread_Buffer>();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    buffer->events.resize(std::max<size_t>(state.events_per_thread, 2 * TRACE_GUARD_EVENTS));
+    buffer->generation = generation;
+#if defined(__linux__)
+    // the threads of the blocks are named after them
+    char name[64] = {};
+    if (pthread_getname_np(pthread_self(), name, sizeof(name)) == 0)
+        {
+            buffer->thread_name = name;
+        }
+#endif
+    if (generation == state.generation.load(std::memory_order_relaxed))
+        {
+            state.buffers.push_back(buffer);
+            buffer->tid = static_cast<int>(state.buffers.size());
+        }
+    return buffer;
+}
+
+
+void trace_write_string(std::ostream& output, const std::string& text)
+{
+    output << '"';
+    for (const char c : text)
+        {
+            if (c == '"' or c == '\\')
+                {
+                    output << '\\' << c;
+                }
+            else if (static_cast<unsigned char>(c) >= 0x20)
+                {
+                    output << c;
+                }
+        }
+    output << '"';
+}
+}  // namespace
+
+
+void Gnss_Trace::start(size_t events_per_thread)
+{
+    Trace_State& state = trace_state();
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.buffers.clear();
+        state.events_per_thread = events_per_thread;
+        state.start_ns.store(trace_now_ns(), std::memory_order_relaxed);
+        // the threads take a new ring at their next event
+        state.generation.fetch_add(1, std::memory_order_release);
+    }
+    s_enabled.store(true, std::memory_order_release);
+}
+
+
+void Gnss_Trace::stop()
+{
+    s_enabled.store(false, std::memory_order_release);
+}
+
+
+void Gnss_Trace::record_event(char phase, const char* name, int32_t id, const char* const* arg_names,
+    int64_t arg0, int64_t arg1, int64_t arg2)
+{
+    thread_local std::shared_ptr<Trace_Thread_Buffer> buffer;
+    Trace_State& state = trace_state();
+    const uint64_t generation = state.generation.load(std::memory_order_acquire);
+    if (buffer == nullptr or buffer->generation != generation)
+        {
+            buffer = trace_register_thread(generation);
+        }
+
+    const uint64_t count = buffer->count.load(std::memory_order_relaxed);
+    Gnss_Trace_Event& event = buffer->events[count % buffer->events.size()];
+    event.time_ns = static_cast<uint64_t>(trace_now_ns() - state.start_ns.load(std::memory_order_relaxed));
+    event.name = name;
+    event.arg_names = arg_names;
+    event.args[0] = arg0;
+    event.args[1] = arg1;
+    event.args[2] = arg2;
+    event.id = id;
+    event.phase = phase;
+    buffer->count.store(count + 1, std::memory_order_release);
+}
+
+
+bool Gnss_Trace::write_json(const std::string& filename, uint64_t& events)
+{
+    events = 0;
+    std::ofstream output(filename, std::ios::out | std::ios::trunc);
+    if (!output.is_open())
+        {
+            return false;
+        }
+
+    Trace_State& state = trace_state();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    output << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    output << R"({"name":"process_name","ph":"M","pid":1,"tid":0,"args":{"name":"gnss-sdr"}})";
+    char time_us[32];
+    for (const auto& buffer : state.buffers)
+        {
+            output << ",\n"
+                   << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << buffer->tid << R"(,"args":{"name":)";
+            trace_write_string(output, buffer->thread_name.empty() ? "thread " + std::to_string(buffer->tid) : buffer->thread_name);
+            output << "}}";
+
+            const uint64_t count = buffer->count.load(std::memory_order_acquire);
+            const uint64_t size = buffer->events.size();
+            const uint64_t first = count > size ? count - size + TRACE_GUARD_EVENTS : 0;
+            for (uint64_t n = first; n < count; n++)
+                {
+                    const Gnss_Trace_Event& event = buffer->events[n % size];
+                    std::snprintf(time_us, sizeof(time_us), "%.3f", static_cast<double>(event.time_ns) * 1e-3);
+                    output << ",\n{\"name\":\"" << event.name << "\",\"ph\":\"" << event.phase
+                           << "\",\"ts\":" << time_us << ",\"pid\":1,\"tid\":" << buffer->tid;
+                    if (event.phase == 'i')
+                        {
+                            output << ",\"s\":\"t\"";
+                        }
+                    output << ",\"args\":{";
+                    bool first_arg = true;
+                    if (event.id >= 0)
+                        {
+                            output << "\"id\":" << event.id;
+                            first_arg = false;
+                        }
+                    for (int a = 0; event.arg_names != nullptr and a < 3 and event.arg_names[a] != nullptr; a++)
+                        {
+                            output << (first_arg ? "" : ",") << '"' << event.arg_names[a] << "\":" << event.args[a];
+                            first_arg = false;
+                        }
+                    output << "}}";
+                    events++;
+                }
+        }
+    output << "\n]}\n";
+    return output.good();
+}
+
+
+uint64_t Gnss_Trace::overwritten()
+{
+    Trace_State& state = trace_state();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    uint64_t events = 0;
+    for (const auto& buffer : state.buffers)
+        {
+            const uint64_t count = buffer->count.load(std::memory_order_acquire);
+            events += count > buffer->events.size() ? count - buffer->events.size() : 0;
+        }
+    return events;
+}
@@ -0,0 +1,183 @@
+/*!
+ * \file gnss_trace.h
+ * \brief Low-overhead trace of the scheduling of the receiver, written in the
+ * Chrome trace format (also read by Perfetto)
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_TRACE_H
+#define GNSS_SDR_GNSS_TRACE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief One event of the trace. The names are string literals, so that
+ * recording an event copies no string.
+ */
+struct Gnss_Trace_Event
+{
+    uint64_t time_ns;              // since Gnss_Trace::start()
+    const char* name;              // nullptr for an empty slot
+    const char* const* arg_names;  // up to three, nullptr after the last one
+    int64_t args[3];
+    int32_t id;  // channel, or -1
+    char phase;  // 'B' (begin), 'E' (end) or 'i' (instant), as in the Chrome trace format
+};
+
+
+/*!
+ * \brief Trace of the work calls of the blocks, the acquisition jobs, the
+ * control events and the PVT epochs, to see which block waited for which one
+ * when the receiver falls behind.
+ *
+ * While the trace is stopped, recording costs a relaxed atomic load. Once it
+ * is started (with the trace telecommand), each thread records its events in
+ * a ring of its own, without locks nor system calls, so the last
+ * events_per_thread events of each thread are kept. write_json() writes them
+ * in the Chrome trace format, which chrome://tracing and
+ * https://ui.perfetto.dev open.
+ */
+class Gnss_Trace
+{
+public:
+    //! True while the trace is started
+    static bool enabled()
+    {
+        return s_enabled.load(std::memory_order_relaxed);
+    }
+
+    //! Forgets the events recorded before, and records the new ones
+    static void start(size_t events_per_thread = 65536);
+
+    //! Stops recording. The events are kept until the next start().
+    static void stop();
+
+    /*!
+     * \brief Records an event in the ring of the calling thread, if the trace
+     * is started. arg_names is a static array of up to three names for the
+     * arguments, or nullptr.
+     */
+    static void record(char phase, const char* name, int32_t id = -1, const char* const* arg_names = nullptr,
+        int64_t arg0 = 0, int64_t arg1 = 0, int64_t arg2 = 0)
+    {
+        if (enabled())
+            {
+                record_event(phase, name, id, arg_names, arg0, arg1, arg2);
+            }
+    }
+
+    /*!
+     * \brief Writes the events kept to filename, in the Chrome trace format.
+     * Returns false if the file cannot be written.
+     */
+    static bool write_json(const std::string& filename, uint64_t& events);
+
+    //! Events of all the threads overwritten since start()
+    static uint64_t overwritten();
+
+private:
+    static void record_event(char phase, const char* name, int32_t id, const char* const* arg_names,
+        int64_t arg0, int64_t arg1, int64_t arg2);
+
+    static std::atomic<bool> s_enabled;
+};
+
+
+/*!
+ * \brief Records the beginning and the end of its scope
+ */
+class Gnss_Trace_Scope
+{
+public:
+    explicit Gnss_Trace_Scope(const char* name, int32_t id = -1, const char* const* arg_names = nullptr,
+        int64_t arg0 = 0, int64_t arg1 = 0, int64_t arg2 = 0) : d_name(Gnss_Trace::enabled() ? name : nullptr),
+                                                                d_id(id)
+    {
+        if (d_name != nullptr)
+            {
+                Gnss_Trace::record('B', d_name, d_id, arg_names, arg0, arg1, arg2);
+            }
+    }
+
+    ~Gnss_Trace_Scope()
+    {
+        if (d_name != nullptr)
+            {
+                Gnss_Trace::record('E', d_name, d_id);
+            }
+    }
+
+    Gnss_Trace_Scope(const Gnss_Trace_Scope&) = delete;
+    Gnss_Trace_Scope& operator=(const Gnss_Trace_Scope&) = delete;
+
+private:
+    const char* d_name;
+    int32_t d_id;
+};
+
+
+/*!
+ * \brief Records a call to the work function of a block: at the beginning,
+ * the items available in its first input, the room in its first output and
+ * the items it has produced so far (the scheduler adds the ones of this
+ * call after it returns), and at the end the items consumed from its first
+ * input. Block is gr::block, which this header does not depend on, and the
+ * block must have an input and an output.
+ */
+template <typename Block>
+class Gnss_Trace_Work
+{
+public:
+    Gnss_Trace_Work(const char* name, int32_t id, Block* block, int available, int room) : d_block(Gnss_Trace::enabled() ? block : nullptr),
+                                                                                                 d_name(name),
+                                                                                                 d_id(id)
+    {
+        if (d_block != nullptr)
+            {
+                static const char* const names[] = {"available", "room", "produced", nullptr};
+                d_read = d_block->nitems_read(0);
+                Gnss_Trace::record('B', d_name, d_id, names, available, room, static_cast<int64_t>(d_block->nitems_written(0)));
+            }
+    }
+
+    ~Gnss_Trace_Work()
+    {
+        if (d_block != nullptr)
+            {
+                static const char* const names[] = {"consumed", nullptr};
+                Gnss_Trace::record('E', d_name, d_id, names, static_cast<int64_t>(d_block->nitems_read(0) - d_read));
+            }
+    }
+
+    Gnss_Trace_Work(const Gnss_Trace_Work&) = delete;
+    Gnss_Trace_Work& operator=(const Gnss_Trace_Work&) = delete;
+
+private:
+    Block* d_block;
+    const char* d_name;
+    uint64_t d_read{0};
+    int32_t d_id;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_TRACE_H
@@ -0,0 +1,323 @@
+/*!
+ * \file gnss_udp_sender.cc
+ * \brief Sends datagrams to one or multiple UDP endpoints from a background
+ * thread, batching them in as few system calls as possible.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_udp_sender.h"
+#include <arpa/inet.h>   // for inet_pton, htons
+#include <glog/logging.h>
+#include <netinet/in.h>  // for sockaddr_in, sockaddr_in6
+#include <sys/uio.h>     // for iovec
+#include <unistd.h>      // for close
+#include <algorithm>     // for max, min
+#include <cerrno>
+#include <cstring>  // for memset, memcpy, strerror
+
+
+namespace
+{
+// Maximum number of messages per sendmmsg() call (UIO_MAXIOV)
+constexpr std::size_t MAX_BATCH = 1024;
+}  // namespace
+
+
+Gnss_Udp_Sender::Gnss_Udp_Sender(const std::vector<std::string>& addresses,
+    uint16_t port,
+    std::size_t ring_size,
+    uint16_t local_port)
+    : d_ring(std::max<std::size_t>(ring_size, 2)),
+      d_ring_destination(d_ring.size())
+{
+    for (const auto& address : addresses)
+        {
+            Endpoint endpoint{};
+            sockaddr_in address_v4{};
+            sockaddr_in6 address_v6{};
+            int* sock = nullptr;
+            if (inet_pton(AF_INET, address.c_str(), &address_v4.sin_addr) == 1)
+                {
+                    address_v4.sin_family = AF_INET;
+                    address_v4.sin_port = htons(port);
+                    memcpy(&endpoint.address, &address_v4, sizeof(address_v4));
+                    endpoint.address_length = sizeof(address_v4);
+                    sock = &d_socket_v4;
+                }
+            else if (inet_pton(AF_INET6, address.c_str(), &address_v6.sin6_addr) == 1)
+                {
+                    address_v6.sin6_family = AF_INET6;
+                    address_v6.sin6_port = htons(port);
+                    memcpy(&endpoint.address, &address_v6, sizeof(address_v6));
+                    endpoint.address_length = sizeof(address_v6);
+                    sock = &d_socket_v6;
+                }
+            else
+                {
+                    LOG(WARNING) << "Invalid UDP address " << address << ", ignored";
+                    continue;
+                }
+            if (*sock < 0)
+                {
+                    *sock = socket(endpoint.address.ss_family, SOCK_DGRAM, 0);
+                    if (*sock < 0)
+                        {
+                            LOG(WARNING) << "Cannot open a UDP socket for " << address << ": " << strerror(errno);
+                            continue;
+                        }
+                }
+            endpoint.socket = *sock;
+            d_endpoints.push_back(endpoint);
+        }
+
+    if (local_port != 0)
+        {
+            if (d_socket_v4 < 0)
+                {
+                    d_socket_v4 = socket(AF_INET, SOCK_DGRAM, 0);
+                }
+            sockaddr_in local_address{};
+            local_address.sin_family = AF_INET;
+            local_address.sin_addr.s_addr = htonl(INADDR_ANY);
+            local_address.sin_port = htons(local_port);
+            if (d_socket_v4 >= 0 and bind(d_socket_v4, reinterpret_cast<const sockaddr*>(&local_address), sizeof(local_address)) == 0)
+                {
+                    d_bound = true;
+                }
+            else
+                {
+                    LOG(WARNING) << "Cannot bind a UDP socket to port " << local_port << ": " << strerror(errno);
+                }
+        }
+    d_thread = std::thread(&Gnss_Udp_Sender::run, this);
+}
+
+
+Gnss_Udp_Sender::~Gnss_Udp_Sender()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_stop = true;
+    }
+    d_cond.notify_one();
+    d_thread.join();
+    if (d_socket_v4 >= 0)
+        {
+            close(d_socket_v4);
+        }
+    if (d_socket_v6 >= 0)
+        {
+            close(d_socket_v6);
+        }
+}
+
+
+std::string* Gnss_Udp_Sender::next_datagram()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        if ((d_head + 1) % d_ring.size() == d_tail)
+            {
+                d_dropped++;
+                return nullptr;
+            }
+    }
+    // the background thread does not touch the slot being filled
+    d_ring[d_head].clear();
+    d_ring_destination[d_head].address_length = 0;
+    return &d_ring[d_head];
+}
+
+
+std::string* Gnss_Udp_Sender::next_datagram(const sockaddr_storage& destination, socklen_t destination_length)
+{
+    std::string* datagram = next_datagram();
+    if (datagram != nullptr)
+        {
+            d_ring_destination[d_head].address = destination;
+            d_ring_destination[d_head].address_length = destination_length;
+        }
+    return datagram;
+}
+
+
+void Gnss_Udp_Sender::submit()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_head = (d_head + 1) % d_ring.size();
+    }
+    d_cond.notify_one();
+}
+
+
+void Gnss_Udp_Sender::flush()
+{
+    std::unique_lock<std::mutex> lock(d_mutex);
+    d_sent_cond.wait(lock, [this] { return d_tail == d_head; });
+}
+
+
+std::size_t Gnss_Udp_Sender::endpoints() const
+{
+    return d_endpoints.size();
+}
+
+
+bool Gnss_Udp_Sender::receive(std::string& datagram, sockaddr_storage& source, socklen_t& source_length)
+{
+    if (!d_bound)
+        {
+            return false;
+        }
+    datagram.resize(2048);
+    source_length = sizeof(source);
+    const ssize_t length = recvfrom(d_socket_v4, &datagram[0], datagram.size(), MSG_DONTWAIT, reinterpret_cast<sockaddr*>(&source), &source_length);
+    if (length < 0)
+        {
+            datagram.clear();
+            return false;
+        }
+    datagram.resize(static_cast<std::size_t>(length));
+    return true;
+}
+
+
+uint64_t Gnss_Udp_Sender::dropped_datagrams() const
+{
+    return d_dropped.load();
+}
+
+
+int Gnss_Udp_Sender::socket_for(int family) const
+{
+    return family == AF_INET6 ? d_socket_v6 : d_socket_v4;
+}
+
+
+void Gnss_Udp_Sender::run()
+{
+    while (true)
+        {
+            std::size_t first;
+            std::size_t count;
+            {
+                std::unique_lock<std::mutex> lock(d_mutex);
+                d_cond.wait(lock, [this] { return d_stop or d_head != d_tail; });
+                if (d_head == d_tail)
+                    {
+                        return;
+                    }
+                first = d_tail;
+                count = (d_head + d_ring.size() - d_tail) % d_ring.size();
+            }
+            send_datagrams(first, count);
+            {
+                std::lock_guard<std::mutex> lock(d_mutex);
+                d_tail = (first + count) % d_ring.size();
+            }
+            d_sent_cond.notify_all();
+        }
+}
+
+
+void Gnss_Udp_Sender::send_datagrams(std::size_t first, std::size_t count)
+{
+    // (socket, datagram, destination) of every message, in order
+    struct Message
+    {
+        int socket;
+        std::string* datagram;
+        sockaddr_storage* address;
+        socklen_t address_length;
+    };
+    std::vector<Message> messages;
+    messages.reserve(count * std::max<std::size_t>(d_endpoints.size(), 1));
+    for (std::size_t i = 0; i < count; i++)
+        {
+            const std::size_t slot = (first + i) % d_ring.size();
+            Destination& destination = d_ring_destination[slot];
+            if (destination.address_length > 0)
+                {
+                    const int sock = socket_for(destination.address.ss_family);
+                    if (sock >= 0)
+                        {
+                            messages.push_back({sock, &d_ring[slot], &destination.address, destination.address_length});
+                        }
+                    continue;
+                }
+            for (auto& endpoint : d_endpoints)
+                {
+                    messages.push_back({endpoint.socket, &d_ring[slot], &endpoint.address, endpoint.address_length});
+                }
+        }
+
+#if defined(__linux__)
+    // consecutive messages through the same socket go in a single call
+    std::vector<mmsghdr> headers;
+    std::vector<iovec> buffers;
+    headers.reserve(std::min(messages.size(), MAX_BATCH));
+    buffers.reserve(headers.capacity());
+    std::size_t next = 0;
+    while (next < messages.size())
+        {
+            const int sock = messages[next].socket;
+            headers.clear();
+            buffers.clear();
+            for (; next < messages.size() and messages[next].socket == sock and headers.size() < MAX_BATCH; next++)
+                {
+                    buffers.push_back({&(*messages[next].datagram)[0], messages[next].datagram->size()});
+                    mmsghdr header{};
+                    header.msg_hdr.msg_name = messages[next].address;
+                    header.msg_hdr.msg_namelen = messages[next].address_length;
+                    headers.push_back(header);
+                }
+            for (std::size_t i = 0; i < headers.size(); i++)
+                {
+                    headers[i].msg_hdr.msg_iov = &buffers[i];
+                    headers[i].msg_hdr.msg_iovlen = 1;
+                }
+            std::size_t sent = 0;
+            while (sent < headers.size())
+                {
+                    const int ret = sendmmsg(sock, &headers[sent], static_cast<unsigned int>(headers.size() - sent), 0);
+                    if (ret < 0)
+                        {
+                            if (errno == EINTR)
+                                {
+                                    continue;
+                                }
+                            // skip the message that failed
+                            if (d_send_errors++ == 0)
+                                {
+                                    LOG(WARNING) << "Error sending UDP datagrams: " << strerror(errno);
+                                }
+                            sent++;
+                        }
+                    else
+                        {
+                            sent += static_cast<std::size_t>(ret);
+                        }
+                }
+        }
+#else
+    for (const auto& message : messages)
+        {
+            if (sendto(message.socket, message.datagram->data(), message.datagram->size(), 0,
+                    reinterpret_cast<const sockaddr*>(message.address), message.address_length) < 0 and
+                d_send_errors++ == 0)
+                {
+                    LOG(WARNING) << "Error sending UDP datagrams: " << strerror(errno);
+                }
+        }
+#endif
+}
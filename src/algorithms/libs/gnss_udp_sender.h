@@ -0,0 +1,140 @@
+/*!
+ * \file gnss_udp_sender.h
+ * \brief Sends datagrams to one or multiple UDP endpoints from a background
+ * thread, batching them in as few system calls as possible.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_UDP_SENDER_H
+#define GNSS_SDR_GNSS_UDP_SENDER_H
+
+#include <sys/socket.h>  // for sockaddr_storage, socklen_t
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Sends the same datagrams to a list of UDP endpoints.
+ *
+ * The datagrams are serialized by the caller into the slots of a ring, and
+ * a background thread sends all the pending datagrams to all the endpoints,
+ * with a single sendmmsg() call per address family where available. The
+ * sockets are opened once, when the sender is created. If the ring is full
+ * (the network is slower than the producer), the new datagrams are dropped,
+ * so the processing thread never waits for the network.
+ *
+ * A datagram can also be addressed to a single destination, for instance
+ * to reply to a client that sent a request to the local port of the sender.
+ *
+ * Only one thread may produce datagrams.
+ */
+class Gnss_Udp_Sender
+{
+public:
+    /*!
+     * \brief Creates a sender to the given addresses and port. If local_port
+     * is not zero, the IPv4 socket is bound to that port on all the
+     * interfaces, so that clients can send requests to it.
+     */
+    Gnss_Udp_Sender(const std::vector<std::string>& addresses, uint16_t port, std::size_t ring_size = 64, uint16_t local_port = 0);
+    ~Gnss_Udp_Sender();
+
+    Gnss_Udp_Sender(const Gnss_Udp_Sender&) = delete;
+    Gnss_Udp_Sender& operator=(const Gnss_Udp_Sender&) = delete;
+
+    /*!
+     * \brief Returns the (empty) buffer where the next datagram has to be
+     * serialized, or nullptr if the ring is full. The buffer keeps the
+     * capacity of the datagrams previously serialized in it.
+     */
+    std::string* next_datagram();
+
+    /*!
+     * \brief As above, but the datagram is only sent to the given destination
+     */
+    std::string* next_datagram(const sockaddr_storage& destination, socklen_t destination_length);
+
+    /*!
+     * \brief Queues for sending the datagram serialized in the buffer
+     * returned by the last call to next_datagram()
+     */
+    void submit();
+
+    /*!
+     * \brief Waits until all the queued datagrams have been sent
+     */
+    void flush();
+
+    std::size_t endpoints() const;
+
+    /*!
+     * \brief Reads a pending datagram received on the local port, without
+     * waiting. Returns false if there is none, or if no local port was bound.
+     */
+    bool receive(std::string& datagram, sockaddr_storage& source, socklen_t& source_length);
+
+    /*!
+     * \brief Number of datagrams dropped because the ring was full
+     */
+    uint64_t dropped_datagrams() const;
+
+private:
+    struct Endpoint
+    {
+        sockaddr_storage address;
+        socklen_t address_length;
+        int socket;
+    };
+
+    struct Destination
+    {
+        sockaddr_storage address;
+        socklen_t address_length;  // zero for all the endpoints
+    };
+
+    void run();
+    void send_datagrams(std::size_t first, std::size_t count);
+    int socket_for(int family) const;
+
+    std::vector<Endpoint> d_endpoints;
+    int d_socket_v4{-1};
+    int d_socket_v6{-1};
+    bool d_bound{false};
+
+    std::vector<std::string> d_ring;
+    std::vector<Destination> d_ring_destination;
+    std::size_t d_head{0};  // slot being filled by the producer
+    std::size_t d_tail{0};  // first slot not sent yet
+    std::mutex d_mutex;
+    std::condition_variable d_cond;
+    std::condition_variable d_sent_cond;
+    std::atomic<uint64_t> d_dropped{0};
+    uint64_t d_send_errors{0};
+    bool d_stop{false};
+    std::thread d_thread;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_UDP_SENDER_H
@@ -260,6 +260,8 @@ const double MAXGDOP = 300.0;        //!<    max GDOP
 const int MAXSBSURA = 8;  //!<    max URA of SBAS satellite
 const int MAXBAND = 10;   //!<    max SBAS band of IGP
 const int MAXNIGP = 201;  //!<    max number of IGP in SBAS band
+const int NIGPLAT = 35;   //!<    number of IGP grid latitudes (-85 to 85 deg, 5 deg step)
+const int NIGPLON = 72;   //!<    number of IGP grid longitudes (-180 to 175 deg, 5 deg step)
 const int MAXNGEO = 4;    //!<    max number of GEO satellites
 
 const int MAXSOLMSG = 8191;  //!<    max length of solution message
@@ -311,6 +313,7 @@ const int ARMODE_PPPAR = 4;      //!< AR mode: PPP-AR
 const int ARMODE_PPPAR_ILS = 5;  //!< AR mode: AR mode: PPP-AR ILS
 const int ARMODE_WLNL = 6;
 const int ARMODE_TCAR = 7;
+const int MAXPARCAND = 8;  //!< max number of ambiguity subsets searched in parallel by partial AR
 
 
 const int POSOPT_RINEX = 3;   //!< pos option: rinex header pos
@@ -608,6 +611,7 @@ typedef struct
     int nsat;              /* number of satellites */
     int tlat;              /* system latency (s) */
     sbssatp_t sat[MAXSAT]; /* satellite correction */
+    short satidx[MAXSAT];  /* index+1 in sat[] of each satellite (0:none) */
 } sbssat_t;
 
 
@@ -637,6 +641,12 @@ typedef struct
 } sbsion_t;
 
 
+typedef struct
+{                                   /* SBAS IGP grid index type */
+    short igp[NIGPLAT][NIGPLON][2]; /* band*MAXNIGP+index+1 in sbsion[] of the IGPs at each grid point (0:none) */
+} sbsigpidx_t;
+
+
 typedef struct
 {                /* DGPS/GNSS correction type */
     gtime_t t0;  /* correction time */
@@ -785,6 +795,7 @@ typedef struct
     pcv_t pcvs[MAXSAT];           /* satellite antenna pcv */
     sbssat_t sbssat;              /* SBAS satellite corrections */
     sbsion_t sbsion[MAXBAND + 1]; /* SBAS ionosphere corrections */
+    sbsigpidx_t sbsigpidx;        /* SBAS IGP grid index of sbsion */
     dgps_t dgps[MAXSAT];          /* DGPS corrections */
     ssr_t ssr[MAXSAT];            /* SSR corrections */
     lexeph_t lexeph[MAXSAT];      /* LEX ephemeris */
@@ -995,6 +1006,8 @@ typedef struct
     exterr_t exterr;              /* extended receiver error model */
     int freqopt;                  /* disable L2-AR */
     char pppopt[256];             /* ppp option */
+    int minfixamb;                /* min number of ambiguities fixed by partial AR (0:off) */
+    double tideint;               /* interval of the earth tide evaluations (s) (0:every epoch) */
 } prcopt_t;
 
 
@@ -1057,6 +1070,15 @@ typedef struct
 } ambc_t;
 
 
+typedef struct
+{                  /* lambda/mlambda workspace type */
+    int nmax;      /* max number of float parameters */
+    int mmax;      /* max number of fixed solutions */
+    double *buff;  /* work buffer */
+    int *ipiv;     /* pivot indices */
+} lambda_ws_t;
+
+
 typedef struct
 {                           /* RTK control/result type */
     sol_t sol;              /* RTK solution */
@@ -1071,6 +1093,7 @@ typedef struct
     int neb;                /* bytes in error message buffer */
     char errbuf[MAXERRMSG]; /* error message buffer */
     prcopt_t opt;           /* processing options */
+    lambda_ws_t *ws;        /* lambda workspaces (MAXPARCAND) */
 } rtk_t;
 
 
@@ -15,6 +15,7 @@
  */
 
 #include "rtklib_conversions.h"
+#include "Galileo_INAV.h"            // for CED_URA_INDEX
 #include "MATH_CONSTANTS.h"          // for GNSS_PI, TWO_PI
 #include "beidou_dnav_ephemeris.h"   // for Beidou_Dnav_Ephemeris
 #include "galileo_almanac.h"         // for Galileo_Almanac
@@ -202,6 +203,11 @@ eph_t eph_to_rtklib(const Galileo_Ephemeris& gal_eph)
     rtklib_sat.toes = gal_eph.toe;
     rtklib_sat.toc = gpst2time(rtklib_sat.week, gal_eph.toc);
     rtklib_sat.ttr = gpst2time(rtklib_sat.week, gal_eph.tow);
+    if (gal_eph.flag_reduced_ced)
+        {
+            // de-weighted in the solution until the full ephemeris arrives
+            rtklib_sat.sva = CED_URA_INDEX;
+        }
 
     /* adjustment for week handover */
     double tow;
@@ -769,20 +769,11 @@ int satpos_sbas(gtime_t time, gtime_t teph, int sat, const nav_t *nav,
     double *rs, double *dts, double *var, int *svh)
 {
     const sbssatp_t *sbs;
-    int i;
 
     trace(4, "satpos_sbas: time=%s sat=%2d\n", time_str(time, 3), sat);
 
     /* search sbas satellite correciton */
-    for (i = 0; i < nav->sbssat.nsat; i++)
-        {
-            sbs = nav->sbssat.sat + i;
-            if (sbs->sat == sat)
-                {
-                    break;
-                }
-        }
-    if (i >= nav->sbssat.nsat)
+    if (!(sbs = sbssatp(&nav->sbssat, sat)))
         {
             trace(2, "no sbas correction for orbit: %s sat=%2d\n", time_str(time, 0), sat);
             ephpos(time, teph, sat, nav, -1, rs, dts, var, svh);
@@ -594,17 +594,65 @@ int interptec(const tec_t *tec, int k, const double *posp, double *value,
 }
 
 
-/* ionosphere delay by tec grid data -----------------------------------------*/
-int iondelay(gtime_t time, const tec_t *tec, const double *pos,
-    const double *azel, int opt, double *delay, double *var)
+/* ionospheric delay of a layer of tec grid data ---------------------------
+ * accumulate the delay and the variance of layer k at the ionospheric pierce
+ * point posp, of mapping function fs. The pierce point only depends on the
+ * geometry of the grid, so it is shared by the maps of the same geometry
+ *-----------------------------------------------------------------------------*/
+int iondelaylayer(gtime_t time, const tec_t *tec, int k, const double *posp,
+    double fs, int opt, double *delay, double *var)
 {
     const double fact = 40.30E16 / FREQ1 / FREQ1; /* tecu->L1 iono (m) */
-    double fs;
-    double posp[3] = {0};
+    double posr[3] = {posp[0], posp[1], posp[2]};
     double vtec;
     double rms;
-    double hion;
+
+    if (opt & 1)
+        {
+            /* earth rotation correction (sun-fixed coordinate) */
+            posr[1] += 2.0 * GNSS_PI * timediff(time, tec->time) / 86400.0;
+        }
+    /* interpolate tec grid data */
+    if (!interptec(tec, k, posr, &vtec, &rms))
+        {
+            return 0;
+        }
+
+    *delay += fact * fs * vtec;
+    *var += fact * fact * fs * fs * rms * rms;
+    return 1;
+}
+
+
+/* ionospheric pierce point of a layer of tec grid data --------------------*/
+double ionlayerppp(const tec_t *tec, int k, const double *pos,
+    const double *azel, int opt, double *posp)
+{
+    const double hion = tec->hgts[0] + tec->hgts[2] * k;
+    double fs;
     double rp;
+
+    posp[0] = posp[1] = posp[2] = 0.0;
+
+    /* ionospheric pierce point position */
+    fs = ionppp(pos, azel, tec->rb, hion, posp);
+
+    if (opt & 2)
+        {
+            /* modified single layer mapping function (M-SLM) ref [2] */
+            rp = tec->rb / (tec->rb + hion) * sin(0.9782 * (GNSS_PI / 2.0 - azel[1]));
+            fs = 1.0 / sqrt(1.0 - rp * rp);
+        }
+    return fs;
+}
+
+
+/* ionosphere delay by tec grid data -----------------------------------------*/
+int iondelay(gtime_t time, const tec_t *tec, const double *pos,
+    const double *azel, int opt, double *delay, double *var)
+{
+    double fs;
+    double posp[3];
     int i;
 
     trace(3, "iondelay: time=%s pos=%.1f %.1f azel=%.1f %.1f\n", time_str(time, 0),
@@ -614,33 +662,63 @@ int iondelay(gtime_t time, const tec_t *tec, const double *pos,
 
     for (i = 0; i < tec->ndata[2]; i++)
         { /* for a layer */
-            hion = tec->hgts[0] + tec->hgts[2] * i;
-
-            /* ionospheric pierce point position */
-            fs = ionppp(pos, azel, tec->rb, hion, posp);
-
-            if (opt & 2)
+            fs = ionlayerppp(tec, i, pos, azel, opt, posp);
+            if (!iondelaylayer(time, tec, i, posp, fs, opt, delay, var))
                 {
-                    /* modified single layer mapping function (M-SLM) ref [2] */
-                    rp = tec->rb / (tec->rb + hion) * sin(0.9782 * (GNSS_PI / 2.0 - azel[1]));
-                    fs = 1.0 / sqrt(1.0 - rp * rp);
+                    return 0;
                 }
-            if (opt & 1)
+        }
+    trace(4, "iondelay: delay=%7.2f std=%6.2f\n", *delay, sqrt(*var));
+
+    return 1;
+}
+
+
+/* ionosphere delay by two tec grid maps of the same geometry ----------------
+ * as iondelay() for each of the maps, computing the pierce points only once
+ *-----------------------------------------------------------------------------*/
+void iondelay2(gtime_t time, const tec_t *tec, const double *pos,
+    const double *azel, int opt, double *delay, double *var, int *stat)
+{
+    double fs;
+    double posp[3];
+    int i;
+    int j;
+
+    for (j = 0; j < 2; j++)
+        {
+            delay[j] = var[j] = 0.0;
+            stat[j] = 1;
+        }
+    for (i = 0; i < tec[0].ndata[2] && (stat[0] || stat[1]); i++)
+        { /* for a layer */
+            fs = ionlayerppp(tec, i, pos, azel, opt, posp);
+            for (j = 0; j < 2; j++)
                 {
-                    /* earth rotation correction (sun-fixed coordinate) */
-                    posp[1] += 2.0 * GNSS_PI * timediff(time, tec->time) / 86400.0;
+                    if (stat[j] && !iondelaylayer(time, tec + j, i, posp, fs, opt, delay + j, var + j))
+                        {
+                            stat[j] = 0;
+                        }
                 }
-            /* interpolate tec grid data */
-            if (!interptec(tec, i, posp, &vtec, &rms))
+        }
+}
+
+
+/* same vertical layers and grid of tec grid maps --------------------------*/
+int samegeometry(const tec_t *tec1, const tec_t *tec2)
+{
+    int i;
+    if (tec1->rb != tec2->rb)
+        {
+            return 0;
+        }
+    for (i = 0; i < 3; i++)
+        {
+            if (tec1->hgts[i] != tec2->hgts[i] || tec1->ndata[i] != tec2->ndata[i])
                 {
                     return 0;
                 }
-
-            *delay += fact * fs * vtec;
-            *var += fact * fact * fs * fs * rms * rms;
         }
-    trace(4, "iondelay: delay=%7.2f std=%6.2f\n", *delay, sqrt(*var));
-
     return 1;
 }
 
@@ -668,6 +746,9 @@ int iontec(gtime_t time, const nav_t *nav, const double *pos,
     double a;
     double tt;
     int i;
+    int lo;
+    int hi;
+    int mid;
     int stat[2];
 
     trace(3, "iontec  : time=%s pos=%.1f %.1f azel=%.1f %.1f\n", time_str(time, 0),
@@ -679,13 +760,22 @@ int iontec(gtime_t time, const nav_t *nav, const double *pos,
             *var = VAR_NOTEC;
             return 1;
         }
-    for (i = 0; i < nav->nt; i++)
+    /* first map after time, by bisection of the maps sorted by combtec() */
+    lo = 0;
+    hi = nav->nt;
+    while (lo < hi)
         {
-            if (timediff(nav->tec[i].time, time) > 0.0)
+            mid = lo + (hi - lo) / 2;
+            if (timediff(nav->tec[mid].time, time) > 0.0)
                 {
-                    break;
+                    hi = mid;
+                }
+            else
+                {
+                    lo = mid + 1;
                 }
         }
+    i = lo;
     if (i == 0 || i >= nav->nt)
         {
             trace(2, "%s: tec grid out of period\n", time_str(time, 0));
@@ -697,8 +787,15 @@ int iontec(gtime_t time, const nav_t *nav, const double *pos,
             return 0;
         }
     /* ionospheric delay by tec grid data */
-    stat[0] = iondelay(time, nav->tec + i - 1, pos, azel, opt, dels, vars);
-    stat[1] = iondelay(time, nav->tec + i, pos, azel, opt, dels + 1, vars + 1);
+    if (samegeometry(nav->tec + i - 1, nav->tec + i))
+        {
+            iondelay2(time, nav->tec + i - 1, pos, azel, opt, dels, vars, stat);
+        }
+    else
+        {
+            stat[0] = iondelay(time, nav->tec + i - 1, pos, azel, opt, dels, vars);
+            stat[1] = iondelay(time, nav->tec + i, pos, azel, opt, dels + 1, vars + 1);
+        }
 
     if (!stat[0] && !stat[1])
         {
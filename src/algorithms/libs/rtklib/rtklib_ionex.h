@@ -62,8 +62,15 @@ void readtec(const char *file, nav_t *nav, int opt);
 int interptec(const tec_t *tec, int k, const double *posp, double *value,
     double *rms);
 
+int iondelaylayer(gtime_t time, const tec_t *tec, int k, const double *posp,
+    double fs, int opt, double *delay, double *var);
+double ionlayerppp(const tec_t *tec, int k, const double *pos,
+    const double *azel, int opt, double *posp);
 int iondelay(gtime_t time, const tec_t *tec, const double *pos,
     const double *azel, int opt, double *delay, double *var);
+void iondelay2(gtime_t time, const tec_t *tec, const double *pos,
+    const double *azel, int opt, double *delay, double *var, int *stat);
+int samegeometry(const tec_t *tec1, const tec_t *tec2);
 int iontec(gtime_t time, const nav_t *nav, const double *pos,
     const double *azel, int opt, double *delay, double *var);
 
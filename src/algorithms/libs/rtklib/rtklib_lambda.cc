@@ -34,15 +34,31 @@
 #include "rtklib_rtkcmn.h"
 #include <cstring>
 
+extern "C"
+{
+    extern void dgetrf_(int *, int *, double *, int *, int *, int *);
+    extern void dgetrs_(char *, int *, int *, double *, int *, int *, double *, int *, int *);
+}
+
+
 /* LD factorization (Q=L'*diag(D)*L) -----------------------------------------*/
 int LD(int n, const double *Q, double *L, double *D)
+{
+    double *A = mat(n, n);
+    int info = LD_work(n, Q, L, D, A);
+    free(A);
+    return info;
+}
+
+
+/* LD factorization with work buffer A (n x n) -------------------------------*/
+int LD_work(int n, const double *Q, double *L, double *D, double *A)
 {
     int i;
     int j;
     int k;
     int info = 0;
     double a;
-    double *A = mat(n, n);
 
     memcpy(A, Q, sizeof(double) * n * n);
     for (i = n - 1; i >= 0; i--)
@@ -69,7 +85,6 @@ int LD(int n, const double *Q, double *L, double *D)
                     L[i + j * n] /= L[i + i * n];
                 }
         }
-    free(A);
     if (info)
         {
             fprintf(stderr, "%s : LD factorization error\n", __FILE__);
@@ -167,6 +182,17 @@ void reduction(int n, double *L, double *D, double *Z)
 /* modified lambda (mlambda) search (ref. [2]) -------------------------------*/
 int search(int n, int m, const double *L, const double *D,
     const double *zs, double *zn, double *s)
+{
+    double *work = mat(n * n + 4 * n, 1);
+    int info = search_work(n, m, L, D, zs, zn, s, work);
+    free(work);
+    return info;
+}
+
+
+/* mlambda search with work buffer (n * n + 4 * n) ---------------------------*/
+int search_work(int n, int m, const double *L, const double *D,
+    const double *zs, double *zn, double *s, double *work)
 {
     int i;
     int j;
@@ -177,11 +203,13 @@ int search(int n, int m, const double *L, const double *D,
     double newdist;
     double maxdist = 1E99;
     double y;
-    double *S = zeros(n, n);
-    double *dist = mat(n, 1);
-    double *zb = mat(n, 1);
-    double *z = mat(n, 1);
-    double *step = mat(n, 1);
+    double *S = work;
+    double *dist = S + n * n;
+    double *zb = dist + n;
+    double *z = zb + n;
+    double *step = z + n;
+
+    memset(S, 0, sizeof(double) * n * n);
 
     k = n - 1;
     dist[k] = 0.0;
@@ -272,11 +300,6 @@ int search(int n, int m, const double *L, const double *D,
                         }
                 }
         }
-    free(S);
-    free(dist);
-    free(zb);
-    free(z);
-    free(step);
 
     if (c >= LOOPMAX)
         {
@@ -302,45 +325,97 @@ int search(int n, int m, const double *L, const double *D,
 int lambda(int n, int m, const double *a, const double *Q, double *F,
     double *s)
 {
+    lambda_ws_t ws = {0, 0, nullptr, nullptr};
+    int info = lambda_ws(&ws, n, m, a, Q, F, s);
+    lambda_ws_free(&ws);
+    return info;
+}
+
+
+/* lambda/mlambda integer least-square estimation with workspace ---------------
+ * same as lambda(), with the work buffers taken from a workspace, which is
+ * grown as needed and reused between calls
+ * args   : lambda_ws_t *ws IO workspace (initialized with zeros)
+ *          (other arguments as in lambda())
+ * return : status (0:ok,other:error)
+ * notes  : a workspace must not be used by two threads at the same time
+ *-----------------------------------------------------------------------------*/
+int lambda_ws(lambda_ws_t *ws, int n, int m, const double *a, const double *Q,
+    double *F, double *s)
+{
+    int i;
     int info;
     double *L;
     double *D;
     double *Z;
     double *z;
     double *E;
+    double *work;
+    char tr[] = "T";
 
     if (n <= 0 || m <= 0)
         {
             return -1;
         }
-    L = zeros(n, n);
-    D = mat(n, 1);
-    Z = eye(n);
-    z = mat(n, 1);
-    E = mat(n, m);
+    if (n > ws->nmax || m > ws->mmax)
+        {
+            const int nmax = n > ws->nmax ? n : ws->nmax;
+            const int mmax = m > ws->mmax ? m : ws->mmax;
+            lambda_ws_free(ws);
+            ws->nmax = nmax;
+            ws->mmax = mmax;
+            ws->buff = mat(3 * nmax * nmax + 6 * nmax + nmax * mmax, 1);
+            ws->ipiv = imat(nmax, 1);
+        }
+    L = ws->buff;
+    D = L + n * n;
+    Z = D + n;
+    z = Z + n * n;
+    E = z + n;
+    work = E + n * m; /* n * n + 4 * n */
+
+    memset(L, 0, sizeof(double) * n * n);
+    memset(Z, 0, sizeof(double) * n * n);
+    for (i = 0; i < n; i++)
+        {
+            Z[i + i * n] = 1.0;
+        }
 
     /* LD factorization */
-    if (!(info = LD(n, Q, L, D)))
+    if (!(info = LD_work(n, Q, L, D, work)))
         {
             /* lambda reduction */
             reduction(n, L, D, Z);
             matmul("TN", n, 1, n, 1.0, Z, a, 0.0, z); /* z=Z'*a */
 
             /* mlambda search */
-            if (!(info = search(n, m, L, D, z, E, s)))
+            if (!(info = search_work(n, m, L, D, z, E, s, work)))
                 {
-                    info = solve("T", Z, E, n, m, F); /* F=Z'\E */
+                    /* F=Z'\E */
+                    matcpy(work, Z, n, n);
+                    matcpy(F, E, n, m);
+                    dgetrf_(&n, &n, work, &n, ws->ipiv, &info);
+                    if (!info)
+                        {
+                            dgetrs_(tr, &n, &m, work, &n, ws->ipiv, F, &n, &info);
+                        }
                 }
         }
-    free(L);
-    free(D);
-    free(Z);
-    free(z);
-    free(E);
     return info;
 }
 
 
+/* free lambda workspace -----------------------------------------------------*/
+void lambda_ws_free(lambda_ws_t *ws)
+{
+    free(ws->buff);
+    free(ws->ipiv);
+    ws->buff = nullptr;
+    ws->ipiv = nullptr;
+    ws->nmax = ws->mmax = 0;
+}
+
+
 /* lambda reduction ------------------------------------------------------------
  * reduction by lambda (ref [1]) for integer least square
  * args   : int    n      I  number of float parameters
@@ -58,14 +58,22 @@ const int LOOPMAX = 10000; /* maximum count of search loop */
     while (0)
 
 int LD(int n, const double *Q, double *L, double *D);
+int LD_work(int n, const double *Q, double *L, double *D, double *A);
 void gauss(int n, double *L, double *Z, int i, int j);
 void perm(int n, double *L, double *D, int j, double del, double *Z);
 void reduction(int n, double *L, double *D, double *Z);
 int search(int n, int m, const double *L, const double *D,
     const double *zs, double *zn, double *s);
+int search_work(int n, int m, const double *L, const double *D,
+    const double *zs, double *zn, double *s, double *work);
 
 int lambda(int n, int m, const double *a, const double *Q, double *F, double *s);
 
+int lambda_ws(lambda_ws_t *ws, int n, int m, const double *a, const double *Q,
+    double *F, double *s);
+
+void lambda_ws_free(lambda_ws_t *ws);
+
 int lambda_reduction(int n, const double *Q, double *Z);
 
 int lambda_search(int n, int m, const double *a, const double *Q,
@@ -402,7 +402,7 @@ int rescode(int iter, const obsd_t *obs, int n, const double *rs,
     const double *dts, const double *vare, const int *svh,
     const nav_t *nav, const double *x, const prcopt_t *opt,
     double *v, double *H, double *var, double *azel, int *vsat,
-    double *resp, int *ns)
+    double *resp, int *ns, const double *atmos)
 {
     double r;
     double dion;
@@ -476,12 +476,35 @@ int rescode(int iter, const obsd_t *obs, int n, const double *rs,
                     continue;
                 }
 
-            /* ionospheric corrections */
-            if (!ionocorr(obs[i].time, nav, obs[i].sat, pos, azel + i * 2,
-                    iter > 0 ? opt->ionoopt : IONOOPT_BRDC, &dion, &vion))
+            if (atmos)
                 {
-                    trace(4, "ionocorr error\n");
-                    continue;
+                    /* given atmospheric corrections */
+                    dion = atmos[i * 4];
+                    vion = atmos[1 + i * 4];
+                    dtrp = atmos[2 + i * 4];
+                    vtrp = atmos[3 + i * 4];
+                    if (vion < 0.0 || vtrp < 0.0)
+                        {
+                            trace(4, "no atmospheric corrections\n");
+                            continue;
+                        }
+                }
+            else
+                {
+                    /* ionospheric corrections */
+                    if (!ionocorr(obs[i].time, nav, obs[i].sat, pos, azel + i * 2,
+                            iter > 0 ? opt->ionoopt : IONOOPT_BRDC, &dion, &vion))
+                        {
+                            trace(4, "ionocorr error\n");
+                            continue;
+                        }
+                    /* tropospheric corrections */
+                    if (!tropcorr(obs[i].time, nav, pos, azel + i * 2,
+                            iter > 0 ? opt->tropopt : TROPOPT_SAAS, &dtrp, &vtrp))
+                        {
+                            trace(4, "tropocorr error\n");
+                            continue;
+                        }
                 }
 
             /* GPS-L1 -> L1/B1 */
@@ -489,13 +512,6 @@ int rescode(int iter, const obsd_t *obs, int n, const double *rs,
                 {
                     dion *= std::pow(lam_L1 / LAM_CARR[0], 2.0);
                 }
-            /* tropospheric corrections */
-            if (!tropcorr(obs[i].time, nav, pos, azel + i * 2,
-                    iter > 0 ? opt->tropopt : TROPOPT_SAAS, &dtrp, &vtrp))
-                {
-                    trace(4, "tropocorr error\n");
-                    continue;
-                }
             /* pseudorange residual */
             v[nv] = P - (r + dtr - SPEED_OF_LIGHT_M_S * dts[i * 2] + dion + dtrp);
 
@@ -598,6 +614,33 @@ int valsol(const double *azel, const int *vsat, int n,
 }
 
 
+/* set the position of a solution from the estimated states -----------------*/
+static void setsolpos(const obsd_t *obs, const double *x, const double *Q, int ns, sol_t *sol)
+{
+    int j;
+
+    sol->type = 0;
+    sol->time = timeadd(obs[0].time, -x[3] / SPEED_OF_LIGHT_M_S);
+    sol->dtr[0] = x[3] / SPEED_OF_LIGHT_M_S; /* receiver clock bias (s) */
+    sol->dtr[1] = x[4] / SPEED_OF_LIGHT_M_S; /* glo-gps time offset (s) */
+    sol->dtr[2] = x[5] / SPEED_OF_LIGHT_M_S; /* gal-gps time offset (s) */
+    sol->dtr[3] = x[6] / SPEED_OF_LIGHT_M_S; /* bds-gps time offset (s) */
+    for (j = 0; j < 6; j++)
+        {
+            sol->rr[j] = j < 3 ? x[j] : 0.0;
+        }
+    for (j = 0; j < 3; j++)
+        {
+            sol->qr[j] = static_cast<float>(Q[j + j * NX]);
+        }
+    sol->qr[3] = static_cast<float>(Q[1]);      /* cov xy */
+    sol->qr[4] = static_cast<float>(Q[2 + NX]); /* cov yz */
+    sol->qr[5] = static_cast<float>(Q[2]);      /* cov zx */
+    sol->ns = static_cast<unsigned char>(ns);
+    sol->age = sol->ratio = 0.0;
+}
+
+
 /* estimate receiver position ------------------------------------------------*/
 int estpos(const obsd_t *obs, int n, const double *rs, const double *dts,
     const double *vare, const int *svh, const nav_t *nav,
@@ -664,25 +707,7 @@ int estpos(const obsd_t *obs, int n, const double *rs, const double *dts,
 
             if (norm_rtk(dx, NX) < 1e-4)
                 {
-                    sol->type = 0;
-                    sol->time = timeadd(obs[0].time, -x[3] / SPEED_OF_LIGHT_M_S);
-                    sol->dtr[0] = x[3] / SPEED_OF_LIGHT_M_S; /* receiver clock bias (s) */
-                    sol->dtr[1] = x[4] / SPEED_OF_LIGHT_M_S; /* glo-gps time offset (s) */
-                    sol->dtr[2] = x[5] / SPEED_OF_LIGHT_M_S; /* gal-gps time offset (s) */
-                    sol->dtr[3] = x[6] / SPEED_OF_LIGHT_M_S; /* bds-gps time offset (s) */
-                    for (j = 0; j < 6; j++)
-                        {
-                            sol->rr[j] = j < 3 ? x[j] : 0.0;
-                        }
-                    for (j = 0; j < 3; j++)
-                        {
-                            sol->qr[j] = static_cast<float>(Q[j + j * NX]);
-                        }
-                    sol->qr[3] = static_cast<float>(Q[1]);      /* cov xy */
-                    sol->qr[4] = static_cast<float>(Q[2 + NX]); /* cov yz */
-                    sol->qr[5] = static_cast<float>(Q[2]);      /* cov zx */
-                    sol->ns = static_cast<unsigned char>(ns);
-                    sol->age = sol->ratio = 0.0;
+                    setsolpos(obs, x, Q, ns, sol);
 
                     /* validate solution */
                     if ((stat = valsol(azel, vsat, n, opt, v, nv, NX, msg)))
@@ -960,6 +985,44 @@ void estvel(const obsd_t *obs, int n, const double *rs, const double *dts,
 }
 
 
+/* output the azimuth/elevation angles and the satellite status ---------------*/
+static void outsatstat(const obsd_t *obs, int n, const double *azel_, const int *vsat,
+    const double *resp, double *azel, ssat_t *ssat)
+{
+    int i;
+
+    if (azel)
+        {
+            for (i = 0; i < n * 2; i++)
+                {
+                    azel[i] = azel_[i];
+                }
+        }
+    if (ssat)
+        {
+            for (i = 0; i < MAXSAT; i++)
+                {
+                    ssat[i].vs = 0;
+                    ssat[i].azel[0] = ssat[i].azel[1] = 0.0;
+                    ssat[i].resp[0] = ssat[i].resc[0] = 0.0;
+                    ssat[i].snr[0] = 0;
+                }
+            for (i = 0; i < n; i++)
+                {
+                    ssat[obs[i].sat - 1].azel[0] = azel_[i * 2];
+                    ssat[obs[i].sat - 1].azel[1] = azel_[1 + i * 2];
+                    ssat[obs[i].sat - 1].snr[0] = obs[i].SNR[0];
+                    if (!vsat[i])
+                        {
+                            continue;
+                        }
+                    ssat[obs[i].sat - 1].vs = 1;
+                    ssat[obs[i].sat - 1].resp[0] = resp[i];
+                }
+        }
+}
+
+
 /* single-point positioning ----------------------------------------------------
  * compute receiver position, velocity, clock bias by single-point positioning
  * with pseudorange and doppler observables
@@ -986,7 +1049,6 @@ int pntpos(const obsd_t *obs, int n, const nav_t *nav,
     double *var;
     double *azel_;
     double *resp;
-    int i;
     int stat;
     int vsat[MAXOBS] = {0};
     int svh[MAXOBS];
@@ -1035,39 +1097,272 @@ int pntpos(const obsd_t *obs, int n, const nav_t *nav,
             estvel(obs, n, rs, dts, nav, &opt_, sol, azel_, vsat);
         }
 
-    if (azel)
+    outsatstat(obs, n, azel_, vsat, resp, azel, ssat);
+    free(rs);
+    free(dts);
+    free(var);
+    free(azel_);
+    free(resp);
+    return stat;
+}
+
+
+/* initialize the state of the high-rate single point positioning ------------*/
+void initpntcache(pntcache_t *cache, double period)
+{
+    *cache = pntcache_t{};
+    cache->period = period;
+}
+
+
+/* satellite acceleration ----------------------------------------------------*/
+void satacc(const double *rs, double *acc)
+{
+    const double r = norm_rtk(rs, 3);
+    const double w = GNSS_OMEGA_EARTH_DOT;
+    int i;
+
+    if (r <= 0.0)
         {
-            for (i = 0; i < n * 2; i++)
+            acc[0] = acc[1] = acc[2] = 0.0;
+            return;
+        }
+    for (i = 0; i < 3; i++)
+        {
+            acc[i] = -GPS_GM * rs[i] / (r * r * r);
+        }
+    /* centrifugal and coriolis accelerations of the ecef frame */
+    acc[0] += w * w * rs[0] + 2.0 * w * rs[4];
+    acc[1] += w * w * rs[1] - 2.0 * w * rs[3];
+}
+
+
+/* extrapolate satellite position and velocity -------------------------------*/
+void satposextr(const double *rs, const double *acc, double dt, double *rs_out)
+{
+    int i;
+
+    for (i = 0; i < 3; i++)
+        {
+            rs_out[i] = rs[i] + rs[i + 3] * dt + 0.5 * acc[i] * dt * dt;
+            rs_out[i + 3] = rs[i + 3] + acc[i] * dt;
+        }
+}
+
+
+/* first pseudorange of an observation, as in satposs ------------------------*/
+static double anypr(const obsd_t *obs)
+{
+    int j;
+
+    for (j = 0; j < NFREQ; j++)
+        {
+            if (obs->P[j] != 0.0)
                 {
-                    azel[i] = azel_[i];
+                    return obs->P[j];
                 }
         }
-    if (ssat)
+    return 0.0;
+}
+
+
+/* set the anchor of a satellite -----------------------------------------------
+ * x is the receiver position used for the atmospheric corrections
+ *-----------------------------------------------------------------------------*/
+static void setanchor(const obsd_t *obs, const nav_t *nav, const prcopt_t *opt,
+    const double *x, pntcache_t *cache)
+{
+    const int s = obs->sat - 1;
+    double pos[3];
+    double e[3];
+    double azel[2] = {0};
+    double *atmos = cache->atmos[s];
+
+    satposs(obs->time, obs, 1, nav, opt->sateph, cache->rs[s], cache->dts[s], cache->vare + s, cache->svh + s);
+    satacc(cache->rs[s], cache->acc[s]);
+    cache->time[s] = obs->time;
+    cache->pr[s] = anypr(obs);
+    cache->anchored[s] = 1;
+    cache->anchors++;
+
+    /* atmospheric corrections at the anchor */
+    atmos[1] = atmos[3] = -1.0;
+    ecef2pos(x, pos);
+    if (geodist(cache->rs[s], x, e) <= 0.0)
         {
-            for (i = 0; i < MAXSAT; i++)
+            return;
+        }
+    satazel(pos, e, azel);
+    if (!ionocorr(obs->time, nav, obs->sat, pos, azel, opt->ionoopt, atmos, atmos + 1))
+        {
+            atmos[1] = -1.0;
+            return;
+        }
+    if (!tropcorr(obs->time, nav, pos, azel, opt->tropopt, atmos + 2, atmos + 3))
+        {
+            atmos[1] = atmos[3] = -1.0;
+        }
+}
+
+
+/* single point positioning that starts the anchors ---------------------------*/
+static int pntpos_anchor(const obsd_t *obs, int n, const nav_t *nav,
+    const prcopt_t *opt, sol_t *sol, double *azel, ssat_t *ssat,
+    char *msg, pntcache_t *cache)
+{
+    int i;
+    int stat;
+
+    cache->xvalid = 0;
+    for (i = 0; i < MAXSAT; i++)
+        {
+            cache->anchored[i] = 0;
+        }
+    stat = pntpos(obs, n, nav, opt, sol, azel, ssat, msg);
+    if (stat && opt->mode == PMODE_SINGLE)
+        {
+            for (i = 0; i < 3; i++)
                 {
-                    ssat[i].vs = 0;
-                    ssat[i].azel[0] = ssat[i].azel[1] = 0.0;
-                    ssat[i].resp[0] = ssat[i].resc[0] = 0.0;
-                    ssat[i].snr[0] = 0;
+                    cache->x[i] = sol->rr[i];
                 }
-            for (i = 0; i < n; i++)
+            for (i = 0; i < 4; i++)
                 {
-                    ssat[obs[i].sat - 1].azel[0] = azel_[i * 2];
-                    ssat[obs[i].sat - 1].azel[1] = azel_[1 + i * 2];
-                    ssat[obs[i].sat - 1].snr[0] = obs[i].SNR[0];
-                    if (!vsat[i])
+                    cache->x[i + 3] = sol->dtr[i] * SPEED_OF_LIGHT_M_S;
+                }
+            cache->drift = sol->dtr[5];
+            cache->xtime = obs[0].time;
+            cache->xvalid = 1;
+        }
+    return stat;
+}
+
+
+/* high-rate single-point positioning ----------------------------------------*/
+int pntpos_hr(const obsd_t *obs, int n, const nav_t *nav,
+    const prcopt_t *opt, sol_t *sol, double *azel, ssat_t *ssat,
+    char *msg, pntcache_t *cache)
+{
+    double x[NX];
+    double dx[NX];
+    double Q[NX * NX];
+    double dt;
+    double pr;
+    double sig;
+    int i;
+    int j;
+    int k;
+    int nv;
+    int ns = 0;
+    int stat = 0;
+
+    if (n <= 0 || opt->mode != PMODE_SINGLE || !cache->xvalid ||
+        std::fabs(timediff(obs[0].time, cache->xtime)) > cache->period)
+        {
+            return pntpos_anchor(obs, n, nav, opt, sol, azel, ssat, msg, cache);
+        }
+    if (n > MAXOBS)
+        {
+            n = MAXOBS;
+        }
+    trace(3, "pntpos_hr: tobs=%s n=%d\n", time_str(obs[0].time, 3), n);
+
+    sol->stat = SOLQ_NONE;
+    sol->time = obs[0].time;
+    msg[0] = '\0';
+
+    /* satellite positions, velocities and clocks from the anchors */
+    for (i = 0; i < n; i++)
+        {
+            const int s = obs[i].sat - 1;
+            double *rs = cache->rs_obs + i * 6;
+
+            if ((pr = anypr(obs + i)) == 0.0)
+                {
+                    for (j = 0; j < 6; j++)
                         {
-                            continue;
+                            rs[j] = 0.0;
                         }
-                    ssat[obs[i].sat - 1].vs = 1;
-                    ssat[obs[i].sat - 1].resp[0] = resp[i];
+                    cache->dts_obs[i * 2] = cache->dts_obs[1 + i * 2] = 0.0;
+                    cache->vare_obs[i] = 0.0;
+                    cache->svh_obs[i] = 0;
+                    cache->atmos_obs[1 + i * 4] = cache->atmos_obs[3 + i * 4] = -1.0;
+                    continue;
+                }
+            if (!cache->anchored[s] || std::fabs(timediff(obs[i].time, cache->time[s])) > cache->period)
+                {
+                    setanchor(obs + i, nav, opt, cache->x, cache);
+                }
+            /* time from the anchor, at the transmission */
+            dt = timediff(obs[i].time, cache->time[s]) - (pr - cache->pr[s]) / SPEED_OF_LIGHT_M_S;
+            satposextr(cache->rs[s], cache->acc[s], dt, rs);
+            cache->dts_obs[i * 2] = cache->dts[s][0] + cache->dts[s][1] * dt;
+            cache->dts_obs[1 + i * 2] = cache->dts[s][1];
+            cache->vare_obs[i] = cache->vare[s];
+            cache->svh_obs[i] = cache->svh[s];
+            for (j = 0; j < 4; j++)
+                {
+                    cache->atmos_obs[j + i * 4] = cache->atmos[s][j];
                 }
         }
-    free(rs);
-    free(dts);
-    free(var);
-    free(azel_);
-    free(resp);
-    return stat;
+
+    /* least squares from the last solution, with its clock drift */
+    for (i = 0; i < NX; i++)
+        {
+            x[i] = cache->x[i];
+        }
+    x[3] += cache->drift * timediff(obs[0].time, cache->xtime);
+
+    for (i = 0; i < MAXITR; i++)
+        {
+            nv = rescode(1, obs, n, cache->rs_obs, cache->dts_obs, cache->vare_obs, cache->svh_obs, nav, x, opt,
+                cache->v, cache->H, cache->var, cache->azel, cache->vsat, cache->resp, &ns, cache->atmos_obs);
+            if (nv < NX)
+                {
+                    break;
+                }
+            /* weight by variance */
+            for (j = 0; j < nv; j++)
+                {
+                    sig = sqrt(cache->var[j]);
+                    cache->v[j] /= sig;
+                    for (k = 0; k < NX; k++)
+                        {
+                            cache->H[k + j * NX] /= sig;
+                        }
+                }
+            if (lsq(cache->H, cache->v, NX, nv, dx, Q))
+                {
+                    break;
+                }
+            for (j = 0; j < NX; j++)
+                {
+                    x[j] += dx[j];
+                }
+            if (norm_rtk(dx, NX) < 1e-4)
+                {
+                    setsolpos(obs, x, Q, ns, sol);
+                    stat = valsol(cache->azel, cache->vsat, n, opt, cache->v, nv, NX, msg);
+                    break;
+                }
+        }
+    if (!stat)
+        {
+            /* full single point positioning, with raim fde */
+            return pntpos_anchor(obs, n, nav, opt, sol, azel, ssat, msg, cache);
+        }
+    sol->stat = opt->sateph == EPHOPT_SBAS ? SOLQ_SBAS : SOLQ_SINGLE;
+
+    /* estimate receiver velocity with doppler */
+    estvel(obs, n, cache->rs_obs, cache->dts_obs, nav, opt, sol, cache->azel, cache->vsat);
+
+    for (i = 0; i < NX; i++)
+        {
+            cache->x[i] = x[i];
+        }
+    cache->drift = sol->dtr[5];
+    cache->xtime = obs[0].time;
+    cache->epochs++;
+
+    outsatstat(obs, n, cache->azel, cache->vsat, cache->resp, azel, ssat);
+    return 1;
 }
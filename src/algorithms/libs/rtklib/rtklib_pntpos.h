@@ -87,12 +87,16 @@ int ionocorr(gtime_t time, const nav_t *nav, int sat, const double *pos,
 int tropcorr(gtime_t time, const nav_t *nav, const double *pos,
     const double *azel, int tropopt, double *trp, double *var);
 
-/* pseudorange residuals -----------------------------------------------------*/
+/* pseudorange residuals -------------------------------------------------------
+ * atmos (optional) gives, for each observation, the ionospheric delay (L1),
+ * its variance, the tropospheric delay and its variance (m|m^2) to be used
+ * instead of the models (a negative variance excludes the satellite)
+ *-----------------------------------------------------------------------------*/
 int rescode(int iter, const obsd_t *obs, int n, const double *rs,
     const double *dts, const double *vare, const int *svh,
     const nav_t *nav, const double *x, const prcopt_t *opt,
     double *v, double *H, double *var, double *azel, int *vsat,
-    double *resp, int *ns);
+    double *resp, int *ns, const double *atmos = nullptr);
 
 /* validate solution ---------------------------------------------------------*/
 int valsol(const double *azel, const int *vsat, int n,
@@ -142,4 +146,76 @@ int pntpos(const obsd_t *obs, int n, const nav_t *nav,
     const prcopt_t *opt, sol_t *sol, double *azel, ssat_t *ssat,
     char *msg);
 
+/* state of the high-rate single point positioning ---------------------------
+ * the satellite positions, clocks and atmospheric corrections of each
+ * satellite are computed at an anchor epoch, and extrapolated to the epochs
+ * that follow it for up to period seconds
+ *-----------------------------------------------------------------------------*/
+typedef struct
+{
+    double period;            /* maximum time from the anchor of a satellite (s) */
+    gtime_t time[MAXSAT];     /* receiver time of the anchor of each satellite */
+    double rs[MAXSAT][6];     /* satellite position and velocity (ecef) at the anchor (m|m/s) */
+    double acc[MAXSAT][3];    /* satellite acceleration (ecef) at the anchor (m/s^2) */
+    double dts[MAXSAT][2];    /* satellite clock bias and drift at the anchor (s|s/s) */
+    double vare[MAXSAT];      /* satellite position and clock error variance (m^2) */
+    double pr[MAXSAT];        /* pseudorange at the anchor (m) */
+    double atmos[MAXSAT][4];  /* ionospheric and tropospheric delays and variances (m|m^2) */
+    int svh[MAXSAT];          /* satellite health flag (-1: no ephemeris) */
+    int anchored[MAXSAT];     /* anchor set */
+    double x[NX];             /* states of the last solution */
+    double drift;             /* receiver clock drift of the last solution (m/s) */
+    gtime_t xtime;            /* time of the last solution */
+    int xvalid;               /* last solution valid to start the next one */
+    unsigned long anchors;    /* number of anchors computed */
+    unsigned long epochs;     /* number of epochs solved from the anchors */
+    /* work arrays, by observation */
+    double rs_obs[6 * MAXOBS];
+    double dts_obs[2 * MAXOBS];
+    double vare_obs[MAXOBS];
+    double atmos_obs[4 * MAXOBS];
+    double azel[2 * MAXOBS];
+    double resp[MAXOBS];
+    double v[MAXOBS + 4];
+    double H[NX * (MAXOBS + 4)];
+    double var[MAXOBS + 4];
+    int svh_obs[MAXOBS];
+    int vsat[MAXOBS];
+} pntcache_t;
+
+/* initialize the state of the high-rate single point positioning ------------*/
+void initpntcache(pntcache_t *cache, double period);
+
+/* satellite acceleration ------------------------------------------------------
+ * acceleration in ecef of a satellite in a central gravity field, with the
+ * coriolis and centrifugal terms of the rotation of the earth
+ * args   : double *rs       I   satellite position and velocity (ecef) (m|m/s)
+ *          double *acc      O   satellite acceleration (ecef) (m/s^2)
+ *-----------------------------------------------------------------------------*/
+void satacc(const double *rs, double *acc);
+
+/* extrapolate satellite position and velocity ---------------------------------
+ * args   : double *rs       I   satellite position and velocity (ecef) (m|m/s)
+ *          double *acc      I   satellite acceleration (ecef) (m/s^2)
+ *          double dt        I   time from rs (s)
+ *          double *rs_out   O   satellite position and velocity at dt (m|m/s)
+ *-----------------------------------------------------------------------------*/
+void satposextr(const double *rs, const double *acc, double dt, double *rs_out);
+
+/*!
+ * \brief high-rate single-point positioning
+ * same as pntpos, but it starts the least squares from the last solution
+ * and extrapolates the satellite positions, clocks and atmospheric
+ * corrections from the anchors kept in cache. It falls back to pntpos at
+ * the first epoch, after a gap of more than cache->period seconds, out of
+ * PMODE_SINGLE, and if the solution is not valid (pntpos then also runs
+ * the raim fde, if enabled).
+ * args   : pntcache_t *cache IO state of the high-rate positioning
+ * (the others as in pntpos)
+ * return : status(1:ok,0:error)
+ */
+int pntpos_hr(const obsd_t *obs, int n, const nav_t *nav,
+    const prcopt_t *opt, sol_t *sol, double *azel, ssat_t *ssat,
+    char *msg, pntcache_t *cache);
+
 #endif  // GNSS_SDR_RTKLIB_PNTPOS_H
@@ -1593,8 +1593,8 @@ int res_ppp(int iter __attribute__((unused)), const obsd_t *obs, int n, const do
         {
             tideopt = opt->tidecorr == 1 ? 1 : 7; /* 1:solid, 2:solid+otl+pole */
 
-            tidedisp(gpst2utc(obs[0].time), rr, tideopt, &nav->erp, opt->odisp[0],
-                disp);
+            tidedisp_interp(gpst2utc(obs[0].time), rr, tideopt, &nav->erp, opt->odisp[0],
+                opt->tideint, disp);
             for (i = 0; i < 3; i++)
                 {
                     rr[i] += disp[i];
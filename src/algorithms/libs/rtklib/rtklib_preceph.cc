@@ -42,6 +42,7 @@
 
 #include "rtklib_preceph.h"
 #include "rtklib_rtkcmn.h"
+#include <cmath>
 #include <cstring>
 
 /* satellite code to satellite system ----------------------------------------*/
@@ -622,11 +623,86 @@ double interppol(const double *x, double *y, int n)
 }
 
 
+/* polynomial interpolation weights ------------------------------------------
+ * weights w of the Lagrange polynomial through the nodes x, so that its value
+ * at 0 is sum(w[i]*y[i]) for any values y at the nodes, as interppol(x,y,n)
+ *-----------------------------------------------------------------------------*/
+static void interpweights(const double *x, double *w, int n)
+{
+    int i;
+    int j;
+
+    for (i = 0; i < n; i++)
+        {
+            w[i] = 1.0;
+            for (j = 0; j < n; j++)
+                {
+                    if (j != i)
+                        {
+                            w[i] *= x[j] / (x[j] - x[i]);
+                        }
+                }
+        }
+}
+
+
+/* search precise epoch --------------------------------------------------------
+ * index of the last of the n epochs of data before time (0 if none, n-2 at
+ * most). The epochs of sp3 and clock files are evenly spaced, so the index is
+ * first guessed from the interval of the first and last epochs, and the
+ * binary search is only needed when the guess is wrong (gaps in the grid)
+ *-----------------------------------------------------------------------------*/
+template <typename T>
+static int searchepoch(gtime_t time, const T *data, int n)
+{
+    double tt;
+    double span;
+    int i;
+    int j;
+    int k;
+
+    if ((tt = timediff(time, data[0].time)) <= 0.0)
+        {
+            return 0;
+        }
+    if ((span = timediff(data[n - 1].time, data[0].time)) <= 0.0 ||
+        timediff(time, data[n - 1].time) >= 0.0)
+        {
+            return n - 2;
+        }
+    /* guess on an even grid */
+    k = static_cast<int>(std::ceil(tt / span * (n - 1))) - 1;
+    for (i = k - 1; i <= k + 1; i++)
+        {
+            if (i >= 0 && i < n - 1 && timediff(data[i].time, time) < 0.0 &&
+                timediff(data[i + 1].time, time) >= 0.0)
+                {
+                    return i;
+                }
+        }
+    /* binary search */
+    for (i = 0, j = n - 1; i < j;)
+        {
+            k = (i + j) / 2;
+            if (timediff(data[k].time, time) < 0.0)
+                {
+                    i = k + 1;
+                }
+            else
+                {
+                    j = k;
+                }
+        }
+    return i <= 0 ? 0 : i - 1;
+}
+
+
 /* satellite position by precise ephemeris -----------------------------------*/
 int pephpos(gtime_t time, int sat, const nav_t *nav, double *rs,
     double *dts, double *vare, double *varc)
 {
     double t[NMAX + 1];
+    double w[NMAX + 1];
     double p[3][NMAX + 1];
     double c[2];
     double *pos;
@@ -636,7 +712,6 @@ int pephpos(gtime_t time, int sat, const nav_t *nav, double *rs,
     double cosl;
     int i;
     int j;
-    int k;
     int index;
 
     trace(4, "pephpos : time=%s sat=%2d\n", time_str(time, 3), sat);
@@ -650,20 +725,7 @@ int pephpos(gtime_t time, int sat, const nav_t *nav, double *rs,
             trace(3, "no prec ephem %s sat=%2d\n", time_str(time, 0), sat);
             return 0;
         }
-    /* binary search */
-    for (i = 0, j = nav->ne - 1; i < j;)
-        {
-            k = (i + j) / 2;
-            if (timediff(nav->peph[k].time, time) < 0.0)
-                {
-                    i = k + 1;
-                }
-            else
-                {
-                    j = k;
-                }
-        }
-    index = i <= 0 ? 0 : i - 1;
+    index = searchepoch(time, nav->peph, nav->ne);
 
     /* polynomial interpolation for orbit */
     i = index - (NMAX + 1) / 2;
@@ -700,9 +762,11 @@ int pephpos(gtime_t time, int sat, const nav_t *nav, double *rs,
 #endif
             p[2][j] = pos[2];
         }
+    /* the same weights for the three coordinates */
+    interpweights(t, w, NMAX + 1);
     for (i = 0; i < 3; i++)
         {
-            rs[i] = interppol(t, p[i], NMAX + 1);
+            rs[i] = dot(w, p[i], NMAX + 1);
         }
     if (vare)
         {
@@ -769,8 +833,6 @@ int pephclk(gtime_t time, int sat, const nav_t *nav, double *dts,
     double c[2];
     double std;
     int i;
-    int j;
-    int k;
     int index;
 
     trace(4, "pephclk : time=%s sat=%2d\n", time_str(time, 3), sat);
@@ -782,20 +844,7 @@ int pephclk(gtime_t time, int sat, const nav_t *nav, double *dts,
             trace(3, "no prec clock %s sat=%2d\n", time_str(time, 0), sat);
             return 1;
         }
-    /* binary search */
-    for (i = 0, j = nav->nc - 1; i < j;)
-        {
-            k = (i + j) / 2;
-            if (timediff(nav->pclk[k].time, time) < 0.0)
-                {
-                    i = k + 1;
-                }
-            else
-                {
-                    j = k;
-                }
-        }
-    index = i <= 0 ? 0 : i - 1;
+    index = searchepoch(time, nav->pclk, nav->nc);
 
     /* linear interpolation for clock */
     t[0] = timediff(time, nav->pclk[index].time);
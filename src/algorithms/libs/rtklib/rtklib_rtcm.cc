@@ -33,6 +33,7 @@
 
 #include "rtklib_rtcm.h"
 #include "rtklib_rtkcmn.h"
+#include <cstring>
 
 // extern int encode_rtcm3(rtcm_t *rtcm, int type, int sync);
 
@@ -341,6 +342,74 @@ int input_rtcm3(rtcm_t *rtcm, unsigned char data)
 }
 
 
+/* input rtcm 3 messages from buffer -------------------------------------------
+ * input rtcm 3 messages from a buffer of stream data, as input_rtcm3() for
+ * each byte, but copying each frame at once after its preamble is found
+ * args   : rtcm_t *rtcm IO   rtcm control struct
+ *          unsigned char *buff I stream data
+ *          int    n     I    number of bytes of stream data
+ *          int    *nb   O    number of bytes input
+ * return : status of the first message with non-zero status, or 0 if all
+ *          the data were input (*nb = n) without any (same as above)
+ * notes  : call again with the rest of the buffer until *nb = n
+ *-----------------------------------------------------------------------------*/
+int input_rtcm3s(rtcm_t *rtcm, const unsigned char *buff, int n, int *nb)
+{
+    const void *p;
+    int i = 0;
+    int m;
+    int ret;
+
+    trace(5, "input_rtcm3s: n=%d\n", n);
+
+    while (i < n)
+        {
+            /* synchronize frame */
+            if (rtcm->nbyte == 0)
+                {
+                    if (!(p = memchr(buff + i, RTCM3PREAMB, n - i)))
+                        {
+                            i = n;
+                            break;
+                        }
+                    i = static_cast<int>(static_cast<const unsigned char *>(p) - buff);
+                    rtcm->buff[rtcm->nbyte++] = buff[i++];
+                    continue;
+                }
+            /* header, then message and parity */
+            m = (rtcm->nbyte < 3 ? 3 : rtcm->len + 3) - rtcm->nbyte;
+            m = m < n - i ? m : n - i;
+            memcpy(rtcm->buff + rtcm->nbyte, buff + i, m);
+            rtcm->nbyte += m;
+            i += m;
+            if (rtcm->nbyte == 3)
+                {
+                    rtcm->len = getbitu(rtcm->buff, 14, 10) + 3; /* length without parity */
+                }
+            if (rtcm->nbyte < rtcm->len + 3)
+                {
+                    continue;
+                }
+            rtcm->nbyte = 0;
+
+            /* check parity */
+            if (rtk_crc24q(rtcm->buff, rtcm->len) != getbitu(rtcm->buff, rtcm->len * 8, 24))
+                {
+                    trace(2, "rtcm3 parity error: len=%d\n", rtcm->len);
+                    continue;
+                }
+            /* decode rtcm3 message */
+            if ((ret = decode_rtcm3(rtcm)))
+                {
+                    *nb = i;
+                    return ret;
+                }
+        }
+    *nb = i;
+    return 0;
+}
+
+
 /* input rtcm 2 message from file ----------------------------------------------
  * fetch next rtcm 2 message and input a message from file
  * args   : rtcm_t *rtcm IO   rtcm control struct
@@ -47,6 +47,7 @@ int init_rtcm(rtcm_t *rtcm);
 void free_rtcm(rtcm_t *rtcm);
 int input_rtcm2(rtcm_t *rtcm, unsigned char data);
 int input_rtcm3(rtcm_t *rtcm, unsigned char data);
+int input_rtcm3s(rtcm_t *rtcm, const unsigned char *buff, int n, int *nb);
 int input_rtcm2f(rtcm_t *rtcm, FILE *fp);
 int input_rtcm3f(rtcm_t *rtcm, FILE *fp);
 int gen_rtcm2(rtcm_t *rtcm, int type, int sync);
@@ -3233,6 +3233,33 @@ void save_msm_obs(rtcm_t *rtcm, int sys, msm_h_t *h, const double *r,
 }
 
 
+/* decode msm bit mask --------------------------------------------------------
+ * set index to the numbers (1..len) of the bits set in a mask of len bits
+ * (len <= 64), and return how many, scanning 32 bits at a time
+ *-----------------------------------------------------------------------------*/
+static int decode_msm_mask(const unsigned char *buff, int pos, int len, unsigned char *index)
+{
+    unsigned int word;
+    int i;
+    int k;
+    int m;
+    int n = 0;
+
+    for (i = 0; i < len; i += 32)
+        {
+            m = len - i < 32 ? len - i : 32;
+            word = getbitu(buff, pos + i, m) << (32 - m);
+            while (word)
+                {
+                    k = __builtin_clz(word);
+                    index[n++] = static_cast<unsigned char>(i + k + 1);
+                    word &= ~(0x80000000U >> k);
+                }
+        }
+    return n;
+}
+
+
 /* decode type msm message header --------------------------------------------*/
 int decode_msm_head(rtcm_t *rtcm, int sys, int *sync, int *iod,
     msm_h_t *h, int *hsize)
@@ -3241,9 +3268,9 @@ int decode_msm_head(rtcm_t *rtcm, int sys, int *sync, int *iod,
     double tow;
     double tod;
     char *msg;
+    unsigned char cells[64];
     int i = 24;
     int j;
-    int mask;
     int staid;
     int type;
     int ncell = 0;
@@ -3291,24 +3318,10 @@ int decode_msm_head(rtcm_t *rtcm, int sys, int *sync, int *iod,
             i += 1;
             h->tint_s = getbitu(rtcm->buff, i, 3);
             i += 3;
-            for (j = 1; j <= 64; j++)
-                {
-                    mask = getbitu(rtcm->buff, i, 1);
-                    i += 1;
-                    if (mask)
-                        {
-                            h->sats[h->nsat++] = j;
-                        }
-                }
-            for (j = 1; j <= 32; j++)
-                {
-                    mask = getbitu(rtcm->buff, i, 1);
-                    i += 1;
-                    if (mask)
-                        {
-                            h->sigs[h->nsig++] = j;
-                        }
-                }
+            h->nsat = decode_msm_mask(rtcm->buff, i, 64, h->sats);
+            i += 64;
+            h->nsig = decode_msm_mask(rtcm->buff, i, 32, h->sigs);
+            i += 32;
         }
     else
         {
@@ -3333,15 +3346,12 @@ int decode_msm_head(rtcm_t *rtcm, int sys, int *sync, int *iod,
                 rtcm->len, h->nsat, h->nsig);
             return -1;
         }
-    for (j = 0; j < h->nsat * h->nsig; j++)
+    ncell = decode_msm_mask(rtcm->buff, i, h->nsat * h->nsig, cells);
+    for (j = 0; j < ncell; j++)
         {
-            h->cellmask[j] = getbitu(rtcm->buff, i, 1);
-            i += 1;
-            if (h->cellmask[j])
-                {
-                    ncell++;
-                }
+            h->cellmask[cells[j] - 1] = 1;
         }
+    i += h->nsat * h->nsig;
     *hsize = i;
 
     trace(4, "decode_head_msm: time=%s sys=%d staid=%d nsat=%d nsig=%d sync=%d iod=%d ncell=%d\n",
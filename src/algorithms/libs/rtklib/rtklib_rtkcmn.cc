@@ -32,6 +32,7 @@
 #include "rtklib_rtkcmn.h"
 #include <glog/logging.h>
 #include <cassert>
+#include <cstdint>
 #include <cstring>
 #include <dirent.h>
 #include <iostream>
@@ -40,6 +41,7 @@
 #include <sys/stat.h>
 #include <sys/time.h>
 #include <sys/types.h>
+#include <vector>
 
 
 const double GPST0[] = {1980, 1, 6, 0, 0, 0}; /* gps time reference */
@@ -210,6 +212,9 @@ extern "C"
     extern void dgetrf_(int *, int *, double *, int *, int *, int *);
     extern void dgetri_(int *, double *, int *, int *, double *, int *, int *);
     extern void dgetrs_(char *, int *, int *, double *, int *, int *, double *, int *, int *);
+    extern void dpotrf_(char *, int *, double *, int *, int *);
+    extern void dpotri_(char *, int *, double *, int *, int *);
+    extern void dpotrs_(char *, int *, int *, double *, int *, double *, int *, int *);
 }
 
 
@@ -773,13 +778,26 @@ int getcodepri(int sys, unsigned char code, const char *opt)
  *-----------------------------------------------------------------------------*/
 unsigned int getbitu(const unsigned char *buff, int pos, int len)
 {
-    unsigned int bits = 0;
+    uint64_t bits = 0;
     int i;
-    for (i = pos; i < pos + len; i++)
+    int last;
+    if (len <= 0)
         {
-            bits = (bits << 1) + ((buff[i / 8] >> (7 - i % 8)) & 1U);
+            return 0;
+        }
+    if (len > 32)
+        { /* only the last 32 bits fit */
+            pos += len - 32;
+            len = 32;
         }
-    return bits;
+    /* load the (up to 5) bytes holding the bits, and shift them into place */
+    last = (pos + len - 1) / 8;
+    for (i = pos / 8; i <= last; i++)
+        {
+            bits = (bits << 8) | buff[i];
+        }
+    bits >>= (last + 1) * 8 - pos - len;
+    return static_cast<unsigned int>(bits & (0xFFFFFFFFULL >> (32 - len)));
 }
 
 
@@ -1129,6 +1147,67 @@ void matcpy(double *A, const double *B, int n, int m)
 /* matrix routines -----------------------------------------------------------*/
 
 
+/* scratch buffers of the matrix routines --------------------------------------
+ * the buffers are kept between calls (one set per thread) and only grow, so
+ * that the routines called at every epoch do not allocate memory
+ *-----------------------------------------------------------------------------*/
+static double *scratch(std::vector<double> &buff, int n)
+{
+    if (buff.size() < static_cast<size_t>(n))
+        {
+            buff.resize(n);
+        }
+    return buff.data();
+}
+
+
+static int *iscratch(std::vector<int> &buff, int n)
+{
+    if (buff.size() < static_cast<size_t>(n))
+        {
+            buff.resize(n);
+        }
+    return buff.data();
+}
+
+
+/* inverse of symmetric positive definite matrix -------------------------------
+ * inverse of symmetric positive definite matrix by cholesky decomposition
+ * (A=A^-1), with LU decomposition (matinv) as fallback
+ * args   : double *A        IO  matrix (n x n)
+ *          int    n         I   size of matrix A
+ * return : status (0:ok,0>:error)
+ *-----------------------------------------------------------------------------*/
+static int matinvsym(double *A, int n)
+{
+    thread_local std::vector<double> buff;
+    double *B = scratch(buff, n * n);
+    char uplo[] = "L";
+    int i;
+    int j;
+    int info;
+
+    matcpy(B, A, n, n);
+    dpotrf_(uplo, &n, B, &n, &info);
+    if (!info)
+        {
+            dpotri_(uplo, &n, B, &n, &info);
+        }
+    if (info)
+        {
+            return matinv(A, n);
+        }
+    for (j = 0; j < n; j++)
+        {
+            for (i = j; i < n; i++)
+                {
+                    A[i + j * n] = A[j + i * n] = B[i + j * n];
+                }
+        }
+    return 0;
+}
+
+
 /* multiply matrix (wrapper of blas dgemm) -------------------------------------
  * multiply matrix by matrix (C=alpha*A*B+beta*C)
  * args   : char   *tr       I  transpose flags ("N":normal,"T":transpose)
@@ -1158,19 +1237,18 @@ void matmul(const char *tr, int n, int k, int m, double alpha,
  *-----------------------------------------------------------------------------*/
 int matinv(double *A, int n)
 {
-    double *work;
-    int info;
+    thread_local std::vector<double> work_buff;
+    thread_local std::vector<int> ipiv_buff;
     int lwork = n * 16;
-    int *ipiv = imat(n, 1);
+    double *work = scratch(work_buff, lwork);
+    int *ipiv = iscratch(ipiv_buff, n);
+    int info;
 
-    work = mat(lwork, 1);
     dgetrf_(&n, &n, A, &n, ipiv, &info);
     if (!info)
         {
             dgetri_(&n, A, &n, ipiv, work, &lwork, &info);
         }
-    free(ipiv);
-    free(work);
     return info;
 }
 
@@ -1189,9 +1267,11 @@ int matinv(double *A, int n)
 int solve(const char *tr, const double *A, const double *Y, int n,
     int m, double *X)
 {
-    double *B = mat(n, n);
+    thread_local std::vector<double> B_buff;
+    thread_local std::vector<int> ipiv_buff;
+    double *B = scratch(B_buff, n * n);
+    int *ipiv = iscratch(ipiv_buff, n);
     int info;
-    int *ipiv = imat(n, 1);
 
     matcpy(B, A, n, n);
     matcpy(X, Y, n, m);
@@ -1200,8 +1280,6 @@ int solve(const char *tr, const double *A, const double *Y, int n,
         {
             dgetrs_(const_cast<char *>(tr), &n, &m, B, &n, ipiv, X, &n, &info);
         }
-    free(ipiv);
-    free(B);
     return info;
 }
 
@@ -1222,6 +1300,7 @@ int solve(const char *tr, const double *A, const double *Y, int n,
 int lsq(const double *A, const double *y, int n, int m, double *x,
     double *Q)
 {
+    thread_local std::vector<double> Ay_buff;
     double *Ay;
     int info;
 
@@ -1229,14 +1308,13 @@ int lsq(const double *A, const double *y, int n, int m, double *x,
         {
             return -1;
         }
-    Ay = mat(n, 1);
+    Ay = scratch(Ay_buff, n);
     matmul("NN", n, 1, m, 1.0, A, y, 0.0, Ay); /* Ay=A*y */
     matmul("NT", n, n, m, 1.0, A, A, 0.0, Q);  /* Q=A*A' */
-    if (!(info = matinv(Q, n)))
+    if (!(info = matinvsym(Q, n)))
         {
             matmul("NN", n, 1, n, 1.0, Q, Ay, 0.0, x); /* x=Q^-1*Ay */
         }
-    free(Ay);
     return info;
 }
 
@@ -1257,32 +1335,55 @@ int lsq(const double *A, const double *y, int n, int m, double *x,
  * return : status (0:ok,<0:error)
  * notes  : matirix stored by column-major order (fortran convention)
  *          if state x[i]==0.0, not updates state x[i]/P[i+i*n]
+ *          K' is solved from Q*K'=(P*H)' by cholesky decomposition of Q, and
+ *          Pp=P-K*(P*H)' as P is symmetric, which takes n*n*m operations
+ *          instead of the n*n*n of (I-K*H')*P
  *-----------------------------------------------------------------------------*/
 int filter_(const double *x, const double *P, const double *H,
     const double *v, const double *R, int n, int m,
     double *xp, double *Pp)
 {
-    double *F = mat(n, m);
-    double *Q = mat(m, m);
-    double *K = mat(n, m);
-    double *I = eye(n);
+    thread_local std::vector<double> buff;
+    double *F = scratch(buff, n * m * 2 + m * m);
+    double *Kt = F + n * m;
+    double *Q = Kt + n * m;
+    char uplo[] = "L";
+    int i;
+    int j;
     int info;
 
     matcpy(Q, R, m, m);
     matcpy(xp, x, n, 1);
     matmul("NN", n, m, n, 1.0, P, H, 0.0, F); /* Q=H'*P*H+R */
     matmul("TN", m, m, n, 1.0, H, F, 1.0, Q);
-    if (!(info = matinv(Q, m)))
+    for (i = 0; i < n; i++)
         {
-            matmul("NN", n, m, m, 1.0, F, Q, 0.0, K);  /* K=P*H*Q^-1 */
-            matmul("NN", n, 1, m, 1.0, K, v, 1.0, xp); /* xp=x+K*v */
-            matmul("NT", n, n, m, -1.0, K, H, 1.0, I); /* Pp=(I-K*H')*P */
-            matmul("NN", n, n, n, 1.0, I, P, 0.0, Pp);
+            for (j = 0; j < m; j++)
+                {
+                    Kt[j + i * m] = F[i + j * n];
+                }
+        }
+    dpotrf_(uplo, &m, Q, &m, &info);
+    if (!info)
+        {
+            dpotrs_(uplo, &m, &n, Q, &m, Kt, &m, &info); /* K'=Q^-1*(P*H)' */
+        }
+    else
+        {
+            /* Q not positive definite: inverse by LU decomposition */
+            matcpy(Q, R, m, m);
+            matmul("TN", m, m, n, 1.0, H, F, 1.0, Q);
+            if (!(info = matinv(Q, m)))
+                {
+                    matmul("NT", m, n, m, 1.0, Q, F, 0.0, Kt);
+                }
+        }
+    if (!info)
+        {
+            matmul("TN", n, 1, m, 1.0, Kt, v, 1.0, xp); /* xp=x+K*v */
+            matcpy(Pp, P, n, n);
+            matmul("TT", n, n, m, -1.0, Kt, F, 1.0, Pp); /* Pp=P-K*(P*H)' */
         }
-    free(F);
-    free(Q);
-    free(K);
-    free(I);
     return info;
 }
 
@@ -1290,6 +1391,8 @@ int filter_(const double *x, const double *P, const double *H,
 int filter(double *x, double *P, const double *H, const double *v,
     const double *R, int n, int m)
 {
+    thread_local std::vector<double> buff;
+    thread_local std::vector<int> ix_buff;
     double *x_;
     double *xp_;
     double *P_;
@@ -1299,9 +1402,8 @@ int filter(double *x, double *P, const double *H, const double *v,
     int j;
     int k;
     int info;
-    int *ix;
+    int *ix = iscratch(ix_buff, n);
 
-    ix = imat(n, 1);
     for (i = k = 0; i < n; i++)
         {
             if (x[i] != 0.0 && P[i + i * n] > 0.0)
@@ -1309,18 +1411,11 @@ int filter(double *x, double *P, const double *H, const double *v,
                     ix[k++] = i;
                 }
         }
-    x_ = mat(k, 1);
-    xp_ = mat(k, 1);
-    P_ = mat(k, k);
-    Pp_ = mat(k, k);
-    for (i = 0; i < k; i++)
-        {
-            for (j = 0; j < k; j++)
-                {
-                    Pp_[i * k + j] = 0.0;
-                }
-        }
-    H_ = mat(k, m);
+    x_ = scratch(buff, k * 2 + k * k * 2 + k * m);
+    xp_ = x_ + k;
+    P_ = xp_ + k;
+    Pp_ = P_ + k * k;
+    H_ = Pp_ + k * k;
     for (i = 0; i < k; i++)
         {
             x_[i] = x[ix[i]];
@@ -1333,7 +1428,10 @@ int filter(double *x, double *P, const double *H, const double *v,
                     H_[i + j * k] = H[ix[i] + j * n];
                 }
         }
-    info = filter_(x_, P_, H_, v, R, k, m, xp_, Pp_);
+    if ((info = filter_(x_, P_, H_, v, R, k, m, xp_, Pp_)))
+        {
+            return info;
+        }
     for (i = 0; i < k; i++)
         {
             x[ix[i]] = xp_[i];
@@ -1342,12 +1440,6 @@ int filter(double *x, double *P, const double *H, const double *v,
                     P[ix[i] + ix[j] * n] = Pp_[i + j * k];
                 }
         }
-    free(ix);
-    free(x_);
-    free(xp_);
-    free(P_);
-    free(Pp_);
-    free(H_);
     return info;
 }
 
@@ -2073,7 +2165,7 @@ void time2str(gtime_t t, char *s, int n)
  *-----------------------------------------------------------------------------*/
 char *time_str(gtime_t t, int n)
 {
-    static char buff[64];
+    static thread_local char buff[64];
     time2str(t, buff, n);
     return buff;
 }
@@ -2548,14 +2640,14 @@ void nut_iau1980(double t, const double *f, double *dpsi, double *deps)
  *                               (NULL: no output)
  * return : none
  * note   : see ref [3] chap 5
- *          not thread-safe
+ *          the cached matrix is kept per thread
  *-----------------------------------------------------------------------------*/
 void eci2ecef(gtime_t tutc, const double *erpv, double *U, double *gmst)
 {
     const double ep2000[] = {2000, 1, 1, 12, 0, 0};
-    static gtime_t tutc_;
-    static double U_[9];
-    static double gmst_;
+    static thread_local gtime_t tutc_;
+    static thread_local double U_[9];
+    static thread_local double gmst_;
     gtime_t tgps;
     double eps;
     double ze;
@@ -4673,13 +4765,18 @@ double tropmodel(gtime_t time __attribute__((unused)), const double *pos, const
     double humi)
 {
     const double temp0 = 15.0; /* temparature at sea level */
+    /* the zenith delays only depend on the receiver position and the
+       humidity, so they are computed once for all the satellites of an epoch */
+    thread_local double zlat = 0.0;
+    thread_local double zhgt = -1.0;
+    thread_local double zhumi = -1.0;
+    thread_local double zhyd = 0.0;
+    thread_local double zwet = 0.0;
     double hgt;
     double pres;
     double temp;
     double e;
-    double z;
-    double trph;
-    double trpw;
+    double cosz;
 
     if (pos[2] < -100.0 || 1e4 < pos[2] || azel[1] <= 0)
         {
@@ -4689,15 +4786,22 @@ double tropmodel(gtime_t time __attribute__((unused)), const double *pos, const
     /* standard atmosphere */
     hgt = pos[2] < 0.0 ? 0.0 : pos[2];
 
-    pres = 1013.25 * pow(1.0 - 2.2557E-5 * hgt, 5.2568);
-    temp = temp0 - 6.5E-3 * hgt + 273.16;
-    e = 6.108 * humi * exp((17.15 * temp - 4684.0) / (temp - 38.45));
+    if (pos[0] != zlat || hgt != zhgt || humi != zhumi)
+        {
+            pres = 1013.25 * pow(1.0 - 2.2557E-5 * hgt, 5.2568);
+            temp = temp0 - 6.5E-3 * hgt + 273.16;
+            e = 6.108 * humi * exp((17.15 * temp - 4684.0) / (temp - 38.45));
+
+            zhyd = 0.0022768 * pres / (1.0 - 0.00266 * cos(2.0 * pos[0]) - 0.00028 * hgt / 1e3);
+            zwet = 0.002277 * (1255.0 / temp + 0.05) * e;
+            zlat = pos[0];
+            zhgt = hgt;
+            zhumi = humi;
+        }
 
     /* saastamoninen model */
-    z = GNSS_PI / 2.0 - azel[1];
-    trph = 0.0022768 * pres / (1.0 - 0.00266 * cos(2.0 * pos[0]) - 0.00028 * hgt / 1e3) / cos(z);
-    trpw = 0.002277 * (1255.0 / temp + 0.05) * e / cos(z);
-    return trph + trpw;
+    cosz = cos(GNSS_PI / 2.0 - azel[1]);
+    return zhyd / cosz + zwet / cosz;
 }
 #ifndef IERS_MODEL
 
@@ -35,8 +35,11 @@
 #include "rtklib_pntpos.h"
 #include "rtklib_ppp.h"
 #include "rtklib_tides.h"
+#include <algorithm>
 #include <cmath>
 #include <cstring>
+#include <thread>
+#include <vector>
 
 static int resamb_WLNL(rtk_t *rtk __attribute((unused)), const obsd_t *obs __attribute((unused)), const int *sat __attribute((unused)),
     const int *iu __attribute((unused)), const int *ir __attribute((unused)), int ns __attribute__((unused)), const nav_t *nav __attribute((unused)),
@@ -1333,8 +1336,8 @@ int zdres(int base, const obsd_t *obs, int n, const double *rs,
     /* earth tide correction */
     if (opt->tidecorr)
         {
-            tidedisp(gpst2utc(obs[0].time), rr_, opt->tidecorr, &nav->erp,
-                opt->odisp[base], disp);
+            tidedisp_interp(gpst2utc(obs[0].time), rr_, opt->tidecorr, &nav->erp,
+                opt->odisp[base], opt->tideint, disp);
             for (i = 0; i < 3; i++)
                 {
                     rr_[i] += disp[i];
@@ -2146,6 +2149,7 @@ int resamb_LAMBDA(rtk_t *rtk, double *bias, double *xa)
     int j;
     int ny;
     int nb;
+    int nk;
     int info;
     int nx = rtk->nx;
     int na = rtk->na;
@@ -2155,9 +2159,14 @@ int resamb_LAMBDA(rtk_t *rtk, double *bias, double *xa)
     double *Qy;
     double *b;
     double *db;
+    double *dy;
     double *Qb;
+    double *Qk;
     double *Qab;
+    double *Qak;
     double *QQ;
+    int *keep;
+    int *fixed;
     double s[2];
 
     trace(3, "resamb_LAMBDA : nx=%d\n", nx);
@@ -2183,9 +2192,14 @@ int resamb_LAMBDA(rtk_t *rtk, double *bias, double *xa)
     DP = mat(ny, nx);
     b = mat(nb, 2);
     db = mat(nb, 1);
+    dy = mat(nb, 1);
     Qb = mat(nb, nb);
+    Qk = mat(nb, nb);
     Qab = mat(na, nb);
+    Qak = mat(na, nb);
     QQ = mat(na, nb);
+    keep = imat(nb, 1);
+    fixed = imat(nb, 1);
 
     /* transform single to double-differenced phase-bias (y=D'*x, Qy=D'*P*D) */
     matmul("TN", ny, 1, nx, 1.0, D, rtk->x, 0.0, y);
@@ -2212,21 +2226,34 @@ int resamb_LAMBDA(rtk_t *rtk, double *bias, double *xa)
     tracemat(4, y + na, 1, nb, 10, 3);
 
     /* lambda/mlambda integer least-square estimation */
-    if (!(info = lambda(nb, 2, y + na, Qb, b, s)))
+    info = rtk->ws ? lambda_ws(rtk->ws, nb, 2, y + na, Qb, b, s) : lambda(nb, 2, y + na, Qb, b, s);
+    if (!info)
         {
             trace(4, "N(1)=");
             tracemat(4, b, 1, nb, 10, 3);
             trace(4, "N(2)=");
             tracemat(4, b + nb, 1, nb, 10, 3);
 
+            nk = nb;
+            for (i = 0; i < nb; i++)
+                {
+                    keep[i] = i;
+                }
+            /* validation by popular ratio-test, or else partial AR */
+            if (s[0] > 0.0 && s[1] / s[0] < opt->thresar[0] &&
+                !(nk = resamb_partial(rtk, nb, y + na, Qb, b, s, keep)))
+                {
+                    errmsg(rtk, "ambiguity validation failed (nb=%d ratio=%.2f s=%.2f/%.2f)\n",
+                        nb, s[1] / s[0], s[0], s[1]);
+                }
+
             rtk->sol.ratio = s[0] > 0 ? static_cast<float>(s[1] / s[0]) : 0.0F;
             if (rtk->sol.ratio > 999.9)
                 {
                     rtk->sol.ratio = 999.9F;
                 }
 
-            /* validation by popular ratio-test */
-            if (s[0] <= 0.0 || s[1] / s[0] >= opt->thresar[0])
+            if (nk > 0)
                 {
                     /* transform float to fixed solution (xa=xa-Qab*Qb\(b0-b)) */
                     for (i = 0; i < na; i++)
@@ -2237,25 +2264,53 @@ int resamb_LAMBDA(rtk_t *rtk, double *bias, double *xa)
                                     rtk->Pa[i + j * na] = rtk->P[i + j * nx];
                                 }
                         }
-                    for (i = 0; i < nb; i++)
+                    /* fixed ambiguities (all of them, or a subset by partial AR) */
+                    for (i = 0; i < nk; i++)
                         {
-                            bias[i] = b[i];
-                            y[na + i] -= b[i];
+                            dy[i] = y[na + keep[i]] - b[keep[i]];
+                            for (j = 0; j < nk; j++)
+                                {
+                                    Qk[i + j * nk] = Qb[keep[i] + keep[j] * nb];
+                                }
+                            for (j = 0; j < na; j++)
+                                {
+                                    Qak[j + i * na] = Qab[j + keep[i] * na];
+                                }
                         }
-                    if (!matinv(Qb, nb))
+                    if (!matinv(Qk, nk))
                         {
-                            matmul("NN", nb, 1, nb, 1.0, Qb, y + na, 0.0, db);
-                            matmul("NN", na, 1, nb, -1.0, Qab, db, 1.0, rtk->xa);
+                            matmul("NN", nk, 1, nk, 1.0, Qk, dy, 0.0, db);
+                            matmul("NN", na, 1, nk, -1.0, Qak, db, 1.0, rtk->xa);
 
                             /* covariance of fixed solution (Qa=Qa-Qab*Qb^-1*Qab') */
-                            matmul("NN", na, nb, nb, 1.0, Qab, Qb, 0.0, QQ);
-                            matmul("NT", na, na, nb, -1.0, QQ, Qab, 1.0, rtk->Pa);
+                            matmul("NN", na, nk, nk, 1.0, Qak, Qk, 0.0, QQ);
+                            matmul("NT", na, na, nk, -1.0, QQ, Qak, 1.0, rtk->Pa);
 
-                            trace(3, "resamb : validation ok (nb=%d ratio=%.2f s=%.2f/%.2f)\n",
-                                nb, s[0] == 0.0 ? 0.0 : s[1] / s[0], s[0], s[1]);
+                            trace(3, "resamb : validation ok (nb=%d nk=%d ratio=%.2f s=%.2f/%.2f)\n",
+                                nb, nk, s[0] == 0.0 ? 0.0 : s[1] / s[0], s[0], s[1]);
+
+                            /* ambiguities not fixed by partial AR are conditioned on the fixed ones */
+                            for (i = 0; i < nb; i++)
+                                {
+                                    fixed[i] = 0;
+                                    bias[i] = y[na + i];
+                                    for (j = 0; j < nk; j++)
+                                        {
+                                            bias[i] -= Qb[i + keep[j] * nb] * db[j];
+                                        }
+                                }
+                            for (i = 0; i < nk; i++)
+                                {
+                                    fixed[keep[i]] = 1;
+                                    bias[keep[i]] = b[keep[i]];
+                                }
 
                             /* restore single-differenced ambiguity */
                             restamb(rtk, bias, nb, xa);
+                            if (nk < nb)
+                                {
+                                    unfixamb(rtk, fixed);
+                                }
                         }
                     else
                         {
@@ -2264,8 +2319,6 @@ int resamb_LAMBDA(rtk_t *rtk, double *bias, double *xa)
                 }
             else
                 { /* validation failed */
-                    errmsg(rtk, "ambiguity validation failed (nb=%d ratio=%.2f s=%.2f/%.2f)\n",
-                        nb, s[1] / s[0], s[0], s[1]);
                     nb = 0;
                 }
         }
@@ -2279,14 +2332,169 @@ int resamb_LAMBDA(rtk_t *rtk, double *bias, double *xa)
     free(DP);
     free(b);
     free(db);
+    free(dy);
     free(Qb);
+    free(Qk);
     free(Qab);
+    free(Qak);
     free(QQ);
+    free(keep);
+    free(fixed);
 
     return nb; /* number of ambiguities */
 }
 
 
+/* partial ambiguity resolution ------------------------------------------------
+ * after the ratio test failed for the full set of ambiguities, search subsets
+ * excluding the 1, 2, ... ambiguities with the largest variances. The subsets
+ * are searched in parallel, each one with a lambda workspace of its own
+ * args   : rtk_t  *rtk   IO  rtk control/result struct
+ *          int    nb     I   number of double-differenced ambiguities
+ *          double *y     I   float double-differenced ambiguities (nb x 1)
+ *          double *Qb    I   covariance of the ambiguities (nb x nb)
+ *          double *b     O   fixed ambiguities of the subset (nb x 2)
+ *          double *s     O   sum of squared residuals of the subset (1 x 2)
+ *          int    *keep  O   indices of the ambiguities of the subset (nb x 1)
+ * return : number of ambiguities of the largest subset that passes the ratio
+ *          test (0: none)
+ *-----------------------------------------------------------------------------*/
+int resamb_partial(rtk_t *rtk, int nb, const double *y, const double *Qb,
+    double *b, double *s, int *keep)
+{
+    int i;
+    int j;
+    int c;
+    int nk;
+    int ncand = nb - rtk->opt.minfixamb;
+    int order[MAXSAT * NFREQ];
+    int info[MAXPARCAND];
+    double ss[MAXPARCAND][2];
+    double *yk[MAXPARCAND];
+    double *Qk[MAXPARCAND];
+    double *bk[MAXPARCAND];
+    std::vector<std::thread> threads;
+
+    if (rtk->opt.minfixamb <= 0 || !rtk->ws || ncand <= 0 || nb > MAXSAT * NFREQ)
+        {
+            return 0;
+        }
+    if (ncand > MAXPARCAND)
+        {
+            ncand = MAXPARCAND;
+        }
+    /* ambiguities sorted by variance */
+    for (i = 0; i < nb; i++)
+        {
+            order[i] = i;
+        }
+    std::sort(order, order + nb, [&](int a, int d) { return Qb[a + a * nb] < Qb[d + d * nb]; });
+
+    /* candidate c excludes the c+1 ambiguities with the largest variances */
+    auto search_subset = [&](int cand) {
+        const int n = nb - 1 - cand;
+        for (int k = 0; k < n; k++)
+            {
+                yk[cand][k] = y[order[k]];
+                for (int l = 0; l < n; l++)
+                    {
+                        Qk[cand][k + l * n] = Qb[order[k] + order[l] * nb];
+                    }
+            }
+        info[cand] = lambda_ws(rtk->ws + cand, n, 2, yk[cand], Qk[cand], bk[cand], ss[cand]);
+    };
+    for (c = 0; c < ncand; c++)
+        {
+            nk = nb - 1 - c;
+            yk[c] = mat(nk, 1);
+            Qk[c] = mat(nk, nk);
+            bk[c] = mat(nk, 2);
+        }
+    for (c = 1; c < ncand; c++)
+        {
+            threads.emplace_back(search_subset, c);
+        }
+    search_subset(0);
+    for (auto &thread : threads)
+        {
+            thread.join();
+        }
+
+    /* largest subset passing the ratio test */
+    nk = 0;
+    for (c = 0; c < ncand && nk == 0; c++)
+        {
+            if (info[c] || (ss[c][0] > 0.0 && ss[c][1] / ss[c][0] < rtk->opt.thresar[0]))
+                {
+                    continue;
+                }
+            nk = nb - 1 - c;
+            for (i = 0; i < nk; i++)
+                {
+                    keep[i] = order[i];
+                    for (j = 0; j < 2; j++)
+                        {
+                            b[order[i] + j * nb] = bk[c][i + j * nk];
+                        }
+                }
+            s[0] = ss[c][0];
+            s[1] = ss[c][1];
+            trace(3, "resamb_partial : %d of %d ambiguities fixed (ratio=%.2f)\n",
+                nk, nb, s[0] == 0.0 ? 0.0 : s[1] / s[0]);
+        }
+    for (c = 0; c < ncand; c++)
+        {
+            free(yk[c]);
+            free(Qk[c]);
+            free(bk[c]);
+        }
+    return nk;
+}
+
+
+/* remove the fix flag of the ambiguities not fixed by partial AR --------------
+ * args   : rtk_t  *rtk   IO  rtk control/result struct
+ *          int    *fixed I   fixed double-differenced ambiguities, in the
+ *                            order of ddmat() (1:fixed, 0:float) (nb x 1)
+ *-----------------------------------------------------------------------------*/
+void unfixamb(rtk_t *rtk, const int *fixed)
+{
+    int i;
+    int n;
+    int m;
+    int f;
+    int index[MAXSAT];
+    int nv = 0;
+    int nf = NF_RTK(&rtk->opt);
+
+    for (m = 0; m < 4; m++)
+        {
+            for (f = 0; f < nf; f++)
+                {
+                    for (n = i = 0; i < MAXSAT; i++)
+                        {
+                            if (!test_sys(rtk->ssat[i].sys, m) || rtk->ssat[i].fix[f] != 2)
+                                {
+                                    continue;
+                                }
+                            index[n++] = i;
+                        }
+                    if (n < 2)
+                        {
+                            continue;
+                        }
+                    for (i = 1; i < n; i++)
+                        {
+                            if (!fixed[nv++])
+                                {
+                                    rtk->ssat[index[i]].fix[f] = 1;
+                                }
+                        }
+                }
+        }
+}
+
+
 /* validation of solution ----------------------------------------------------*/
 int valpos(rtk_t *rtk, const double *v, const double *R, const int *vflg,
     int nv, double thres)
@@ -2344,15 +2552,17 @@ int valpos(rtk_t *rtk, const double *v, const double *R, const int *vflg,
 }
 
 
-/* relative positioning ------------------------------------------------------*/
-int relpos(rtk_t *rtk, const obsd_t *obs, int nu, int nr,
-    const nav_t *nav)
+/* relative positioning with given satellite positions/clocks ----------------
+ * rs, dts and svh are the satellite positions/velocities, clocks and health
+ * flags of obs, as given by satposs(). They may be shared by several rtk
+ * control structs processing the same satellites in the same epoch (e.g.,
+ * the baselines between the antennas of a vehicle).
+ *-----------------------------------------------------------------------------*/
+int relpos_geom(rtk_t *rtk, const obsd_t *obs, int nu, int nr,
+    const nav_t *nav, const double *rs, const double *dts, const int *svh)
 {
     prcopt_t *opt = &rtk->opt;
     gtime_t time = obs[0].time;
-    double *rs;
-    double *dts;
-    double *var;
     double *y;
     double *e;
     double *azel;
@@ -2377,7 +2587,6 @@ int relpos(rtk_t *rtk, const obsd_t *obs, int nu, int nr,
     int niter;
     int info;
     int vflg[MAXOBS * NFREQ * 2 + 1];
-    int svh[MAXOBS * 2];
     int stat = rtk->opt.mode <= PMODE_DGPS ? SOLQ_DGPS : SOLQ_FLOAT;
     int nf = opt->ionoopt == IONOOPT_IFLC ? 1 : opt->nf;
 
@@ -2385,9 +2594,6 @@ int relpos(rtk_t *rtk, const obsd_t *obs, int nu, int nr,
 
     dt = timediff(time, obs[nu].time);
 
-    rs = mat(6, n);
-    dts = mat(2, n);
-    var = mat(1, n);
     y = mat(nf * 2, n);
     e = mat(3, n);
     azel = zeros(2, n);
@@ -2400,18 +2606,12 @@ int relpos(rtk_t *rtk, const obsd_t *obs, int nu, int nr,
                     rtk->ssat[i].vsat[j] = rtk->ssat[i].snr[j] = 0;
                 }
         }
-    /* satellite positions/clocks */
-    satposs(time, obs, n, nav, opt->sateph, rs, dts, var, svh);
-
     /* undifferenced residuals for base station */
     if (!zdres(1, obs + nu, nr, rs + nu * 6, dts + nu * 2, svh + nu, nav, rtk->rb, opt, 1,
             y + nu * nf * 2, e + nu * 3, azel + nu * 2))
         {
             errmsg(rtk, "initial base station position error\n");
 
-            free(rs);
-            free(dts);
-            free(var);
             free(y);
             free(e);
             free(azel);
@@ -2427,9 +2627,6 @@ int relpos(rtk_t *rtk, const obsd_t *obs, int nu, int nr,
         {
             errmsg(rtk, "no common satellite\n");
 
-            free(rs);
-            free(dts);
-            free(var);
             free(y);
             free(e);
             free(azel);
@@ -2619,9 +2816,6 @@ int relpos(rtk_t *rtk, const obsd_t *obs, int nu, int nr,
                         }
                 }
         }
-    free(rs);
-    free(dts);
-    free(var);
     free(y);
     free(e);
     free(azel);
@@ -2642,6 +2836,33 @@ int relpos(rtk_t *rtk, const obsd_t *obs, int nu, int nr,
 }
 
 
+/* relative positioning ------------------------------------------------------*/
+int relpos(rtk_t *rtk, const obsd_t *obs, int nu, int nr,
+    const nav_t *nav)
+{
+    double *rs;
+    double *dts;
+    double *var;
+    int svh[MAXOBS * 2];
+    int n = nu + nr;
+    int stat;
+
+    rs = mat(6, n);
+    dts = mat(2, n);
+    var = mat(1, n);
+
+    /* satellite positions/clocks */
+    satposs(obs[0].time, obs, n, nav, rtk->opt.sateph, rs, dts, var, svh);
+
+    stat = relpos_geom(rtk, obs, nu, nr, nav, rs, dts, svh);
+
+    free(rs);
+    free(dts);
+    free(var);
+    return stat;
+}
+
+
 /* initialize rtk control ------------------------------------------------------
  * initialize rtk control struct
  * args   : rtk_t    *rtk    IO  rtk control/result struct
@@ -2680,6 +2901,7 @@ void rtkinit(rtk_t *rtk, const prcopt_t *opt)
             rtk->errbuf[i] = 0;
         }
     rtk->opt = *opt;
+    rtk->ws = static_cast<lambda_ws_t *>(calloc(MAXPARCAND, sizeof(lambda_ws_t)));
 }
 
 
@@ -2690,6 +2912,8 @@ void rtkinit(rtk_t *rtk, const prcopt_t *opt)
  *-----------------------------------------------------------------------------*/
 void rtkfree(rtk_t *rtk)
 {
+    int i;
+
     trace(3, "rtkfree :\n");
 
     rtk->nx = rtk->na = 0;
@@ -2701,6 +2925,15 @@ void rtkfree(rtk_t *rtk)
     rtk->xa = nullptr;
     free(rtk->Pa);
     rtk->Pa = nullptr;
+    if (rtk->ws)
+        {
+            for (i = 0; i < MAXPARCAND; i++)
+                {
+                    lambda_ws_free(rtk->ws + i);
+                }
+            free(rtk->ws);
+            rtk->ws = nullptr;
+        }
 }
 
 
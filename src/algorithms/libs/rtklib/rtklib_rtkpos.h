@@ -164,9 +164,17 @@ void holdamb(rtk_t *rtk, const double *xa);
 
 int resamb_LAMBDA(rtk_t *rtk, double *bias, double *xa);
 
+int resamb_partial(rtk_t *rtk, int nb, const double *y, const double *Qb,
+    double *b, double *s, int *keep);
+
+void unfixamb(rtk_t *rtk, const int *fixed);
+
 int valpos(rtk_t *rtk, const double *v, const double *R, const int *vflg,
     int nv, double thres);
 
+int relpos_geom(rtk_t *rtk, const obsd_t *obs, int nu, int nr,
+    const nav_t *nav, const double *rs, const double *dts, const int *svh);
+
 int relpos(rtk_t *rtk, const obsd_t *obs, int nu, int nr,
     const nav_t *nav);
 
@@ -378,6 +378,7 @@ int decoderaw(rtksvr_t *svr, int index)
     nav_t *nav;
     sbsmsg_t *sbsmsg = nullptr;
     int i;
+    int nb;
     int ret = 0;
     int sat;
     int fobs = 0;
@@ -398,7 +399,9 @@ int decoderaw(rtksvr_t *svr, int index)
                 }
             else if (svr->format[index] == STRFMT_RTCM3)
                 {
-                    ret = input_rtcm3(svr->rtcm + index, svr->buff[index][i]);
+                    /* frames are copied at once, up to the next message */
+                    ret = input_rtcm3s(svr->rtcm + index, svr->buff[index] + i, svr->nb[index] - i, &nb);
+                    i += nb - 1;
                     obs = &svr->rtcm[index].obs;
                     nav = &svr->rtcm[index].nav;
                     sat = svr->rtcm[index].ephsat;
@@ -528,13 +531,13 @@ void *rtksvrthread(void *arg)
     double tt;
     unsigned int tick;
     unsigned int ticknmea;
+    unsigned int ticknull;
     unsigned char *p;
     unsigned char *q;
     int i;
     int j;
     int n;
     int fobs[3] = {0};
-    int cycle;
     int cputime;
 
     tracet(3, "rtksvrthread:\n");
@@ -542,9 +545,9 @@ void *rtksvrthread(void *arg)
     svr->state = 1;
     obs.data = data;
     svr->tick = tickget();
-    ticknmea = svr->tick - 1000;
+    ticknmea = ticknull = svr->tick - 1000;
 
-    for (cycle = 0; svr->state; cycle++)
+    while (svr->state)
         {
             tick = tickget();
 
@@ -617,9 +620,10 @@ void *rtksvrthread(void *arg)
                         }
                 }
             /* send null solution if no solution (1hz) */
-            if (svr->rtk.sol.stat == SOLQ_NONE && cycle % (1000 / svr->cycle) == 0)
+            if (svr->rtk.sol.stat == SOLQ_NONE && static_cast<int>(tick - ticknull) >= 1000)
                 {
                     writesol(svr, 0);
+                    ticknull = tick;
                 }
             /* send nmea request to base/nrtk input stream */
             if (svr->nmeacycle > 0 && static_cast<int>(tick - ticknmea) >= svr->nmeacycle)
@@ -642,8 +646,8 @@ void *rtksvrthread(void *arg)
                     svr->cputime = cputime;
                 }
 
-            /* sleep until next cycle */
-            sleepms(svr->cycle - cputime);
+            /* wait for input data until next cycle */
+            strwait(svr->stream, 3, svr->cycle - cputime);
         }
     for (i = 0; i < MAXSTRRTK; i++)
         {
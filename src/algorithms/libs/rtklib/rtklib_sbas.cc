@@ -139,6 +139,17 @@ int decode_sbstype1(const sbsmsg_t *msg, sbssat_t *sbssat)
     sbssat->iodp = getbitu(msg->msg, 224, 2);
     sbssat->nsat = n;
 
+    /* index of the satellites in the mask */
+    memset(sbssat->satidx, 0, sizeof(sbssat->satidx));
+    for (i = 0; i < n; i++)
+        {
+            sat = sbssat->sat[i].sat;
+            if (0 < sat && sat <= MAXSAT && !sbssat->satidx[sat - 1])
+                {
+                    sbssat->satidx[sat - 1] = static_cast<short>(i + 1);
+                }
+        }
+
     trace(5, "decode_sbstype1: nprn=%d iodp=%d\n", n, sbssat->iodp);
     return 1;
 }
@@ -354,6 +365,60 @@ int decode_sbstype18(const sbsmsg_t *msg, sbsion_t *sbsion)
 }
 
 
+/* index igps by grid point --------------------------------------------------*/
+void sbsindexigp(const sbsion_t *sbsion, sbsigpidx_t *idx)
+{
+    const sbsigp_t *p;
+    short *q;
+    int i;
+    int j;
+    int ilat;
+    int ilon;
+
+    memset(idx, 0, sizeof(*idx));
+
+    for (i = 0; i <= MAXBAND; i++)
+        {
+            for (j = 0; j < sbsion[i].nigp; j++)
+                {
+                    p = sbsion[i].igp + j;
+                    if (p->lat % 5 || p->lon % 5)
+                        {
+                            continue;
+                        }
+                    ilat = (p->lat + 85) / 5;
+                    ilon = (p->lon + 180) / 5;
+                    if (ilat < 0 || NIGPLAT <= ilat || ilon < 0 || NIGPLON <= ilon)
+                        {
+                            continue;
+                        }
+                    q = idx->igp[ilat][ilon];
+                    if (!q[0])
+                        {
+                            q[0] = static_cast<short>(i * MAXNIGP + j + 1);
+                        }
+                    else if (!q[1])
+                        {
+                            q[1] = static_cast<short>(i * MAXNIGP + j + 1);
+                        }
+                }
+        }
+}
+
+
+/* satellite correction of a satellite ---------------------------------------*/
+const sbssatp_t *sbssatp(const sbssat_t *sbssat, int sat)
+{
+    int i;
+
+    if (sat <= 0 || MAXSAT < sat || !(i = sbssat->satidx[sat - 1]) || sbssat->nsat < i)
+        {
+            return nullptr;
+        }
+    return sbssat->sat + i - 1;
+}
+
+
 /* decode half long term correction (vel code=0) -----------------------------*/
 int decode_longcorr0(const sbsmsg_t *msg, int p, sbssat_t *sbssat)
 {
@@ -576,6 +641,7 @@ int sbsupdatecorr(const sbsmsg_t *msg, nav_t *nav)
             break;
         case 18:
             stat = decode_sbstype18(msg, nav->sbsion);
+            sbsindexigp(nav->sbsion, &nav->sbsigpidx);
             break;
         case 24:
             stat = decode_sbstype24(msg, &nav->sbssat);
@@ -836,16 +902,42 @@ void sbsoutmsg(FILE *fp, sbsmsg_t *sbsmsg)
 }
 
 
+/* igp with correction at a grid point ---------------------------------------*/
+const sbsigp_t *findigp(const sbsion_t *ion, const sbsigpidx_t *idx, int lat,
+    int lon)
+{
+    const sbsigp_t *p;
+    const short *q;
+    int i;
+    int ilat = (lat + 85) / 5;
+    int ilon = (lon + 180) / 5;
+
+    if (lat % 5 || lon % 5 || ilat < 0 || NIGPLAT <= ilat || ilon < 0 || NIGPLON <= ilon)
+        {
+            return nullptr;
+        }
+    q = idx->igp[ilat][ilon];
+    for (i = 0; i < 2 && q[i]; i++)
+        {
+            p = ion[(q[i] - 1) / MAXNIGP].igp + (q[i] - 1) % MAXNIGP;
+            if (p->t0.time != 0 && p->give > 0)
+                {
+                    return p;
+                }
+        }
+    return nullptr;
+}
+
+
 /* search igps ---------------------------------------------------------------*/
 void searchigp(gtime_t time __attribute__((unused)), const double *pos, const sbsion_t *ion,
-    const sbsigp_t **igp, double *x, double *y)
+    const sbsigpidx_t *idx, const sbsigp_t **igp, double *x, double *y)
 {
     int i;
     int latp[2];
     int lonp[4];
     double lat = pos[0] * R2D;
     double lon = pos[1] * R2D;
-    const sbsigp_t *p;
 
     trace(4, "searchigp: pos=%.3f %.3f\n", pos[0] * R2D, pos[1] * R2D);
 
@@ -902,36 +994,11 @@ void searchigp(gtime_t time __attribute__((unused)), const double *pos, const sb
                     lonp[i] = -180;
                 }
         }
-    for (i = 0; i <= MAXBAND; i++)
-        {
-            for (p = ion[i].igp; p < ion[i].igp + ion[i].nigp; p++)
-                {
-                    if (p->t0.time == 0)
-                        {
-                            continue;
-                        }
-                    if (p->lat == latp[0] && p->lon == lonp[0] && p->give > 0)
-                        {
-                            igp[0] = p;
-                        }
-                    else if (p->lat == latp[1] && p->lon == lonp[1] && p->give > 0)
-                        {
-                            igp[1] = p;
-                        }
-                    else if (p->lat == latp[0] && p->lon == lonp[2] && p->give > 0)
-                        {
-                            igp[2] = p;
-                        }
-                    else if (p->lat == latp[1] && p->lon == lonp[3] && p->give > 0)
-                        {
-                            igp[3] = p;
-                        }
-                    if (igp[0] && igp[1] && igp[2] && igp[3])
-                        {
-                            return;
-                        }
-                }
-        }
+    /* a grid point already searched for a previous corner is not used again */
+    igp[0] = findigp(ion, idx, latp[0], lonp[0]);
+    igp[1] = findigp(ion, idx, latp[1], lonp[1]);
+    igp[2] = lonp[2] == lonp[0] ? nullptr : findigp(ion, idx, latp[0], lonp[2]);
+    igp[3] = lonp[3] == lonp[1] ? nullptr : findigp(ion, idx, latp[1], lonp[3]);
 }
 
 
@@ -976,7 +1043,7 @@ int sbsioncorr(gtime_t time, const nav_t *nav, const double *pos,
     fp = ionppp(pos, azel, re, hion, posp);
 
     /* search igps around ipp */
-    searchigp(time, posp, nav->sbsion, igp, &x, &y);
+    searchigp(time, posp, nav->sbsion, &nav->sbsigpidx, igp, &x, &y);
 
     /* weight of igps */
     if (igp[0] && igp[1] && igp[2] && igp[3])
@@ -1106,9 +1173,9 @@ double sbstropcorr(gtime_t time, const double *pos, const double *azel,
     const double rd = 287.054;
     const double gm = 9.784;
     const double g = 9.80665;
-    static double pos_[3] = {};
-    static double zh = 0.0;
-    static double zw = 0.0;
+    static thread_local double pos_[3] = {};
+    static thread_local double zh = 0.0;
+    static thread_local double zw = 0.0;
     int i;
     double c;
     double met[10];
@@ -1158,12 +1225,8 @@ int sbslongcorr(gtime_t time, int sat, const sbssat_t *sbssat,
 
     trace(3, "sbslongcorr: sat=%2d\n", sat);
 
-    for (p = sbssat->sat; p < sbssat->sat + sbssat->nsat; p++)
+    if ((p = sbssatp(sbssat, sat)) && p->lcorr.t0.time != 0)
         {
-            if (p->sat != sat || p->lcorr.t0.time == 0)
-                {
-                    continue;
-                }
             t = timediff(time, p->lcorr.t0);
             if (fabs(t) > MAXSBSAGEL)
                 {
@@ -1202,22 +1265,15 @@ int sbsfastcorr(gtime_t time, int sat, const sbssat_t *sbssat,
 
     trace(3, "sbsfastcorr: sat=%2d\n", sat);
 
-    for (p = sbssat->sat; p < sbssat->sat + sbssat->nsat; p++)
+    if ((p = sbssatp(sbssat, sat)) && p->fcorr.t0.time != 0)
         {
-            if (p->sat != sat)
-                {
-                    continue;
-                }
-            if (p->fcorr.t0.time == 0)
-                {
-                    break;
-                }
             t = timediff(time, p->fcorr.t0) + sbssat->tlat;
 
             /* expire age of correction or UDRE==14 (not monitored) */
             if (fabs(t) > MAXSBSAGEF || p->fcorr.udre >= 15)
                 {
-                    continue;
+                    trace(2, "no sbas fast correction: %s sat=%2d\n", time_str(time, 0), sat);
+                    return 0;
                 }
             *prc = p->fcorr.prc;
 #ifdef RRCENA
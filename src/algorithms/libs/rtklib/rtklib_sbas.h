@@ -107,6 +107,8 @@ int decode_sbstype6(const sbsmsg_t *msg, sbssat_t *sbssat);
 int decode_sbstype7(const sbsmsg_t *msg, sbssat_t *sbssat);
 int decode_sbstype9(const sbsmsg_t *msg, nav_t *nav);
 int decode_sbstype18(const sbsmsg_t *msg, sbsion_t *sbsion);
+void sbsindexigp(const sbsion_t *sbsion, sbsigpidx_t *idx);
+const sbssatp_t *sbssatp(const sbssat_t *sbssat, int sat);
 int decode_longcorr0(const sbsmsg_t *msg, int p, sbssat_t *sbssat);
 int decode_longcorr1(const sbsmsg_t *msg, int p, sbssat_t *sbssat);
 int decode_longcorrh(const sbsmsg_t *msg, int p, sbssat_t *sbssat);
@@ -121,8 +123,10 @@ int sbsreadmsgt(const char *file, int sel, gtime_t ts, gtime_t te,
     sbs_t *sbs);
 int sbsreadmsg(const char *file, int sel, sbs_t *sbs);
 void sbsoutmsg(FILE *fp, sbsmsg_t *sbsmsg);
+const sbsigp_t *findigp(const sbsion_t *ion, const sbsigpidx_t *idx, int lat,
+    int lon);
 void searchigp(gtime_t time, const double *pos, const sbsion_t *ion,
-    const sbsigp_t **igp, double *x, double *y);
+    const sbsigpidx_t *idx, const sbsigp_t **igp, double *x, double *y);
 int sbsioncorr(gtime_t time, const nav_t *nav, const double *pos,
     const double *azel, double *delay, double *var);
 
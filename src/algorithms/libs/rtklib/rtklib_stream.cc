@@ -41,6 +41,7 @@
 #include <fcntl.h>
 #include <netdb.h>
 #include <netinet/tcp.h>
+#include <poll.h>
 #include <string>
 #include <sys/socket.h>
 #include <sys/stat.h>
@@ -2487,6 +2488,99 @@ int strread(stream_t *stream, unsigned char *buff, int n)
 }
 
 
+/* add socket of tcp to poll set ---------------------------------------------*/
+static void addpollsock(const tcp_t *tcp, struct pollfd *fds, int *nfds, int nmax)
+{
+    if (tcp->state == 2 && tcp->sock >= 0 && *nfds < nmax)
+        {
+            fds[*nfds].fd = tcp->sock;
+            fds[*nfds].events = POLLIN;
+            fds[*nfds].revents = 0;
+            (*nfds)++;
+        }
+}
+
+
+/* wait for input streams ------------------------------------------------------
+ * wait until any of the input streams has data to read, or timeout
+ * args   : stream_t *stream I  streams
+ *          int    n         I  number of streams
+ *          int    timeout   I  timeout (ms)
+ * return : status (1:data to read, 0:timeout)
+ * notes  : serial, tcp and ntrip streams wake the caller as soon as data
+ *          arrives. file and ftp streams, and tcp or ntrip streams still
+ *          connecting, have nothing to wait on, and are read after timeout
+ *-----------------------------------------------------------------------------*/
+int strwait(stream_t *stream, int n, int timeout)
+{
+    struct pollfd fds[MAXSTRRTK * (MAXCLI + 1)];
+    tcpsvr_t *tcpsvr;
+    ntrip_t *ntrip;
+    int i;
+    int j;
+    int nfds = 0;
+    int nmax = static_cast<int>(sizeof(fds) / sizeof(fds[0]));
+    int stat = 0;
+
+    tracet(5, "strwait: n=%d timeout=%d\n", n, timeout);
+
+    for (i = 0; i < n && !stat; i++)
+        {
+            if (!(stream[i].mode & STR_MODE_R) || !stream[i].port)
+                {
+                    continue;
+                }
+            strlock(stream + i);
+            switch (stream[i].type)
+                {
+                case STR_SERIAL:
+                    if (static_cast<serial_t *>(stream[i].port)->dev >= 0 && nfds < nmax)
+                        {
+                            fds[nfds].fd = static_cast<serial_t *>(stream[i].port)->dev;
+                            fds[nfds].events = POLLIN;
+                            fds[nfds].revents = 0;
+                            nfds++;
+                        }
+                    break;
+                case STR_TCPSVR:
+                    tcpsvr = static_cast<tcpsvr_t *>(stream[i].port);
+                    addpollsock(&tcpsvr->svr, fds, &nfds, nmax);
+                    for (j = 0; j < MAXCLI; j++)
+                        {
+                            addpollsock(tcpsvr->cli + j, fds, &nfds, nmax);
+                        }
+                    break;
+                case STR_TCPCLI:
+                    addpollsock(&static_cast<tcpcli_t *>(stream[i].port)->svr, fds, &nfds, nmax);
+                    break;
+                case STR_NTRIPCLI:
+                    ntrip = static_cast<ntrip_t *>(stream[i].port);
+                    if (ntrip->nb > 0)
+                        {
+                            stat = 1; /* response buffer not read yet */
+                        }
+                    if (ntrip->tcp)
+                        {
+                            addpollsock(&ntrip->tcp->svr, fds, &nfds, nmax);
+                        }
+                    break;
+                default:
+                    break;
+                }
+            strunlock(stream + i);
+        }
+    if (stat)
+        {
+            return 1;
+        }
+    if (timeout <= 0)
+        {
+            timeout = 0;
+        }
+    return poll(fds, nfds, timeout) > 0 ? 1 : 0;
+}
+
+
 /* write stream ----------------------------------------------------------------
  * write data to stream (unblocked)
  * args   : stream_t *stream I   stream
@@ -191,6 +191,8 @@ void strunlock(stream_t *stream);
 
 int strread(stream_t *stream, unsigned char *buff, int n);
 
+int strwait(stream_t *stream, int n, int timeout);
+
 int strwrite(stream_t *stream, unsigned char *buff, int n);
 
 int strstat(stream_t *stream, char *msg);
@@ -52,6 +52,8 @@ const double GME = 3.986004415E+14; /* earth gravitational constant */
 const double GMS = 1.327124E+20;    /* sun gravitational constant */
 const double GMM = 4.902801E+12;    /* moon gravitational constant */
 
+const double TIDE_INTERP_MAXDIST = 1.0; /* max site motion to reuse the tide evaluations (m) */
+
 void tide_pl(const double *eu, const double *rp, double GMp,
     const double *pos, double *dr);
 
@@ -69,4 +71,7 @@ void tide_pole(gtime_t tut, const double *pos, const double *erpv,
 
 void tidedisp(gtime_t tutc, const double *rr, int opt, const erp_t *erp,
     const double *odisp, double *dr);
+
+void tidedisp_interp(gtime_t tutc, const double *rr, int opt, const erp_t *erp,
+    const double *odisp, double tint, double *dr);
 #endif
@@ -9,9 +9,11 @@
 #include "volk_gnsssdr_profile.h"
 #include "kernel_tests.h"                       // for init_test_list
 #include "qa_utils.h"                           // for volk_gnsssdr_test_results_t
+#include "volk_gnsssdr/volk_gnsssdr.h"          // for volk_gnsssdr_get_machine
 #include "volk_gnsssdr/volk_gnsssdr_complex.h"  // for lv_32fc_t
 #include "volk_gnsssdr/volk_gnsssdr_prefs.h"    // for volk_gnsssdr_get_config_path
 #include "volk_gnsssdr_option_helpers.h"        // for option_list, option_t
+#include <volk_gnsssdr/constants.h>             // for volk_gnsssdr_c_compiler, volk_gnsssdr_version
 #if HAS_STD_FILESYSTEM
 #if HAS_STD_FILESYSTEM_EXPERIMENTAL
 #include <experimental/filesystem>
@@ -27,6 +29,7 @@
 #include <fstream>     // IWYU pragma: keep
 #include <iostream>    // for operator<<, basic_ostream
 #include <map>         // for map, map<>::iterator
+#include <sstream>     // for stringstream
 #include <sys/stat.h>  // for stat
 #include <utility>     // for pair
 #include <vector>      // for vector, vector<>::const_..
@@ -46,6 +49,8 @@ volk_gnsssdr_test_params_t test_params(1e-6f, 327.f, 8111, 1987, false, "");
 void set_benchmark(bool val) { test_params.set_benchmark(val); }
 void set_tolerance(float val) { test_params.set_tol(val); }
 void set_vlen(int val) { test_params.set_vlen((unsigned int)val); }
+std::string vlen_list("");
+void set_vlens(std::string val) { vlen_list = val; }
 void set_iter(int val) { test_params.set_iter((unsigned int)val); }
 void set_substr(std::string val) { test_params.set_regex(val); }
 bool update_mode = false;
@@ -63,6 +68,7 @@ int main(int argc, char *argv[])
     profile_options.add(option_t("benchmark", "b", "Run all kernels (benchmark mode)", set_benchmark));
     profile_options.add(option_t("tol", "t", "Set the default tolerance for all tests", set_tolerance));
     profile_options.add(option_t("vlen", "v", "Set the default vector length for tests", set_vlen));
+    profile_options.add((option_t("vlens", "V", "Run the tests for each vector length of a comma-separated list. The config is written for the first one", set_vlens)));
     profile_options.add((option_t("iter", "i", "Set the default number of test iterations per kernel", set_iter)));
     profile_options.add((option_t("tests-substr", "R", "Run tests matching substring", set_substr)));
     profile_options.add((option_t("update", "u", "Run only kernels missing from config", set_update)));
@@ -111,58 +117,93 @@ int main(int argc, char *argv[])
                 read_results(&results);
         }
 
-    // Initialize the list of tests
-    std::vector<volk_gnsssdr_test_case_t> test_cases = init_test_list(test_params);
+    // Vector lengths to test
+    std::vector<unsigned int> vlens;
+    std::stringstream vlen_stream(vlen_list);
+    std::string vlen_item;
+    while (std::getline(vlen_stream, vlen_item, ','))
+        {
+            if (!vlen_item.empty())
+                {
+                    vlens.push_back(static_cast<unsigned int>(std::stoul(vlen_item)));
+                }
+        }
+    if (vlens.empty())
+        {
+            vlens.push_back(test_params.vlen());
+        }
 
-    // Iterate through list of tests running each one
+    // Results of all the vector lengths, for the JSON file. The config only
+    // takes the results of the first one
+    std::vector<volk_gnsssdr_test_results_t> all_results;
+    const size_t previous_results = results.size();
     std::string substr_to_match(test_params.kernel_regex());
-    for (unsigned int ii = 0; ii < test_cases.size(); ++ii)
+    for (unsigned int vlen_index = 0; vlen_index < vlens.size(); ++vlen_index)
         {
-            bool regex_match = true;
+            test_params.set_vlen(vlens[vlen_index]);
+            std::vector<volk_gnsssdr_test_results_t> vlen_results;
+            std::vector<volk_gnsssdr_test_results_t> *output = vlen_index == 0 ? &results : &vlen_results;
 
-            volk_gnsssdr_test_case_t test_case = test_cases[ii];
-            // if the kernel name matches regex then do the test
-            std::string test_case_name = test_case.name();
-            if (test_case_name.find(substr_to_match) == std::string::npos)
-                {
-                    regex_match = false;
-                }
+            // Initialize the list of tests
+            std::vector<volk_gnsssdr_test_case_t> test_cases = init_test_list(test_params);
 
-            // if we are in update mode check if we've already got results
-            // if we have any, then no need to test that kernel
-            bool update = true;
-            if (update_mode)
+            // Iterate through list of tests running each one
+            for (unsigned int ii = 0; ii < test_cases.size(); ++ii)
                 {
-                    for (unsigned int jj = 0; jj < results.size(); ++jj)
+                    bool regex_match = true;
+
+                    volk_gnsssdr_test_case_t test_case = test_cases[ii];
+                    // if the kernel name matches regex then do the test
+                    std::string test_case_name = test_case.name();
+                    if (test_case_name.find(substr_to_match) == std::string::npos)
                         {
-                            if (results[jj].name == test_case.name() ||
-                                results[jj].name == test_case.puppet_master_name())
-                                {
-                                    update = false;
-                                    break;
-                                }
+                            regex_match = false;
                         }
-                }
 
-            if (regex_match && update)
-                {
-                    try
+                    // if we are in update mode check if we've already got results
+                    // from the config; if we have any, then no need to test that kernel
+                    bool update = true;
+                    if (update_mode)
                         {
-                            run_volk_gnsssdr_tests(test_case.desc(), test_case.kernel_ptr(), test_case.name(),
-                                test_case.test_parameters(), &results, test_case.puppet_master_name());
+                            for (unsigned int jj = 0; jj < previous_results; ++jj)
+                                {
+                                    if (results[jj].name == test_case.name() ||
+                                        results[jj].name == test_case.puppet_master_name())
+                                        {
+                                            update = false;
+                                            break;
+                                        }
+                                }
                         }
-                    catch (std::string &error)
+
+                    if (regex_match && update)
                         {
-                            std::cerr << "Caught Exception in 'run_volk_gnsssdr_tests': " << error << '\n';
+                            try
+                                {
+                                    run_volk_gnsssdr_tests(test_case.desc(), test_case.kernel_ptr(), test_case.name(),
+                                        test_case.test_parameters(), output, test_case.puppet_master_name());
+                                }
+                            catch (std::string &error)
+                                {
+                                    std::cerr << "Caught Exception in 'run_volk_gnsssdr_tests': " << error << '\n';
+                                }
                         }
                 }
+            if (vlen_index == 0)
+                {
+                    all_results.insert(all_results.end(), results.begin() + previous_results, results.end());
+                }
+            else
+                {
+                    all_results.insert(all_results.end(), vlen_results.begin(), vlen_results.end());
+                }
         }
 
 
     // Output results according to provided options
     if (json_filename != "")
         {
-            write_json(json_file, results);
+            write_json(json_file, all_results);
             json_file.close();
         }
 
@@ -318,6 +359,9 @@ void write_results(const std::vector<volk_gnsssdr_test_results_t> *results, bool
 void write_json(std::ofstream &json_file, std::vector<volk_gnsssdr_test_results_t> results)
 {
     json_file << "{\n";
+    json_file << " \"machine\": \"" << volk_gnsssdr_get_machine() << "\",\n";
+    json_file << " \"version\": \"" << volk_gnsssdr_version() << "\",\n";
+    json_file << " \"compiler\": \"" << volk_gnsssdr_c_compiler() << "\",\n";
     json_file << " \"volk_gnsssdr_tests\": [\n";
     size_t len = results.size();
     size_t i = 0;
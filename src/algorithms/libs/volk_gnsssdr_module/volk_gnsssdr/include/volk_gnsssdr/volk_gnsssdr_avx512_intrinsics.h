@@ -0,0 +1,54 @@
+/*!
+ * \file volk_gnsssdr_avx512_intrinsics.h
+ * \brief This file is intended to hold AVX-512F intrinsics of intrinsics.
+ * They should be used in VOLK kernels to avoid copy-paste.
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+
+#ifndef INCLUDED_VOLK_VOLK_AVX512_INTRINSICS_H
+#define INCLUDED_VOLK_VOLK_AVX512_INTRINSICS_H
+#include <immintrin.h>
+
+static inline __m512
+_mm512_complexmul_ps(__m512 x, __m512 y)
+{
+    __m512 yl, yh, tmp2;
+    yl = _mm512_moveldup_ps(y);              // Load yl with cr,cr,dr,dr ...
+    yh = _mm512_movehdup_ps(y);              // Load yh with ci,ci,di,di ...
+    tmp2 = _mm512_permute_ps(x, 0xB1);       // Re-arrange x to be ai,ar,bi,br ...
+    tmp2 = _mm512_mul_ps(tmp2, yh);          // tmp2 = ai*ci,ar*ci,bi*di,br*di
+    return _mm512_fmaddsub_ps(x, yl, tmp2);  // ar*cr-ai*ci, ai*cr+ar*ci, br*dr-bi*di, bi*dr+br*di
+}
+
+static inline __m512 _mm512_complexnormalise_ps(__m512 z)
+{
+    __m512 tmp1 = _mm512_mul_ps(z, z);                           // ar*ar,ai*ai,br*br,bi*bi ...
+    __m512 tmp2 = _mm512_add_ps(tmp1, _mm512_permute_ps(tmp1, 0xB1));  // |a|^2,|a|^2,|b|^2,|b|^2 ...
+    return _mm512_div_ps(z, _mm512_sqrt_ps(tmp2));
+}
+
+/*!
+ * \brief Duplicates each one of the first eight floats of x: x0,x0,x1,x1,...,x7,x7
+ */
+static inline __m512 _mm512_duplicate_lo_ps(__m512 x)
+{
+    const __m512i idx = _mm512_set_epi32(7, 7, 6, 6, 5, 5, 4, 4, 3, 3, 2, 2, 1, 1, 0, 0);
+    return _mm512_permutexvar_ps(idx, x);
+}
+
+/*!
+ * \brief Duplicates each one of the last eight floats of x: x8,x8,x9,x9,...,x15,x15
+ */
+static inline __m512 _mm512_duplicate_hi_ps(__m512 x)
+{
+    const __m512i idx = _mm512_set_epi32(15, 15, 14, 14, 13, 13, 12, 12, 11, 11, 10, 10, 9, 9, 8, 8);
+    return _mm512_permutexvar_ps(idx, x);
+}
+
+#endif /* INCLUDED_VOLK_VOLK_AVX512_INTRINSICS_H */
@@ -0,0 +1,152 @@
+/*!
+ * \file volk_gnsssdr_16i_x2_interleave_16ic.h
+ * \brief VOLK_GNSSSDR kernel: interleaves two 16-bit vectors into a 16-bit
+ * complex vector.
+ *
+ * VOLK_GNSSSDR kernel that takes the real parts from one 16-bit vector and
+ * the imaginary parts from another one.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_16i_x2_interleave_16ic
+ *
+ * \b Overview
+ *
+ * Computes cVector[i] = lv_cmake(aVector[i], bVector[i]).
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_16i_x2_interleave_16ic(lv_16sc_t* cVector, const int16_t* aVector, const int16_t* bVector, unsigned int num_points)
+ * \endcode
+ *
+ * \b Inputs
+ * \li aVector: The real parts.
+ * \li bVector: The imaginary parts.
+ * \li num_points: The number of complex data points.
+ *
+ * \b Outputs
+ * \li cVector: The complex 16-bit output vector.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_16i_x2_interleave_16ic_H
+#define INCLUDED_volk_gnsssdr_16i_x2_interleave_16ic_H
+
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_16i_x2_interleave_16ic_generic(lv_16sc_t* cVector, const int16_t* aVector, const int16_t* bVector, unsigned int num_points)
+{
+    int16_t* cPtr = (int16_t*)cVector;
+    unsigned int i;
+    for (i = 0; i < num_points; i++)
+        {
+            *cPtr++ = aVector[i];
+            *cPtr++ = bVector[i];
+        }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE2
+#include <emmintrin.h>
+
+static inline void volk_gnsssdr_16i_x2_interleave_16ic_u_sse2(lv_16sc_t* cVector, const int16_t* aVector, const int16_t* bVector, unsigned int num_points)
+{
+    const unsigned int sse_iters = num_points / 8;
+    int16_t* cPtr = (int16_t*)cVector;
+    __m128i a, b;
+    unsigned int i;
+
+    for (i = 0; i < sse_iters; i++)
+        {
+            a = _mm_loadu_si128((const __m128i*)(aVector + 8 * i));
+            b = _mm_loadu_si128((const __m128i*)(bVector + 8 * i));
+            _mm_storeu_si128((__m128i*)cPtr, _mm_unpacklo_epi16(a, b));
+            _mm_storeu_si128((__m128i*)(cPtr + 8), _mm_unpackhi_epi16(a, b));
+            cPtr += 16;
+        }
+
+    for (i = sse_iters * 8; i < num_points; i++)
+        {
+            *cPtr++ = aVector[i];
+            *cPtr++ = bVector[i];
+        }
+}
+
+#endif /* LV_HAVE_SSE2 */
+
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_16i_x2_interleave_16ic_u_avx2(lv_16sc_t* cVector, const int16_t* aVector, const int16_t* bVector, unsigned int num_points)
+{
+    const unsigned int avx2_iters = num_points / 16;
+    int16_t* cPtr = (int16_t*)cVector;
+    __m256i a, b, lo, hi;
+    unsigned int i;
+
+    for (i = 0; i < avx2_iters; i++)
+        {
+            a = _mm256_loadu_si256((const __m256i*)(aVector + 16 * i));
+            b = _mm256_loadu_si256((const __m256i*)(bVector + 16 * i));
+            // the unpacks work within each 128-bit lane, the permutes put the lanes in order
+            lo = _mm256_unpacklo_epi16(a, b);
+            hi = _mm256_unpackhi_epi16(a, b);
+            _mm256_storeu_si256((__m256i*)cPtr, _mm256_permute2x128_si256(lo, hi, 0x20));
+            _mm256_storeu_si256((__m256i*)(cPtr + 16), _mm256_permute2x128_si256(lo, hi, 0x31));
+            cPtr += 32;
+        }
+
+    for (i = avx2_iters * 16; i < num_points; i++)
+        {
+            *cPtr++ = aVector[i];
+            *cPtr++ = bVector[i];
+        }
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEON
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_16i_x2_interleave_16ic_neon(lv_16sc_t* cVector, const int16_t* aVector, const int16_t* bVector, unsigned int num_points)
+{
+    const unsigned int neon_iters = num_points / 8;
+    int16_t* cPtr = (int16_t*)cVector;
+    int16x8x2_t c;
+    unsigned int i;
+
+    for (i = 0; i < neon_iters; i++)
+        {
+            c.val[0] = vld1q_s16(aVector + 8 * i);
+            c.val[1] = vld1q_s16(bVector + 8 * i);
+            vst2q_s16(cPtr, c);
+            cPtr += 16;
+        }
+
+    for (i = neon_iters * 8; i < num_points; i++)
+        {
+            *cPtr++ = aVector[i];
+            *cPtr++ = bVector[i];
+        }
+}
+
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_16i_x2_interleave_16ic_H */
@@ -0,0 +1,444 @@
+/*!
+ * \file volk_gnsssdr_16ic_16i_nco_dot_prod_32fc_xn.h
+ * \brief VOLK_GNSSSDR kernel: multiplies N 16 bits vectors by a common 16 bits
+ * complex vector, wiped off by an integer NCO, and accumulates the results in
+ * N single-precision complex outputs.
+ *
+ * VOLK_GNSSSDR kernel that multiplies N 16 bits vectors by a common 16 bits
+ * complex vector, which is rotated by the quantized carrier of a 32-bit phase
+ * accumulator, and accumulates the results in N complex outputs.
+ * The carrier wipe-off is done with integers and the accumulation in single
+ * precision, so it reads half the bytes of a correlation of single-precision
+ * complex samples.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_16ic_16i_nco_dot_prod_32fc_xn
+ *
+ * \b Overview
+ *
+ * Rotates the reference complex vector with the carrier of a numerically
+ * controlled oscillator, multiplies it with an arbitrary number of integer
+ * vectors (typically, local codes of values -1 and +1), accumulates the
+ * results and stores them in the output vector.
+ * The carrier phase is a 32-bit accumulator (2^32 is one cycle), incremented
+ * by \p phase_inc at each sample. The carrier is read from the table of 64
+ * phases with an amplitude of 127 of volk_gnsssdr_8ic_16i_nco_dot_prod_32fc_xn,
+ * which is below the 8-10 bits of effective precision that the correlations
+ * need. The rotated samples are 32-bit integers, and they are accumulated in
+ * single precision, so there is no limit to \p num_points.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_16ic_16i_nco_dot_prod_32fc_xn(lv_32fc_t* result, const lv_16sc_t* in_common, const uint32_t phase_inc, uint32_t* phase, const int16_t** in_a, int num_a_vectors, unsigned int num_points);
+ * \endcode
+ *
+ * \b Inputs
+ * \li in_common:     Pointer to one of the vectors to be rotated, multiplied and accumulated (reference vector).
+ * \li phase_inc:     Phase increment = phase_step_rad / (2 * pi) * 2^32 (modulo 2^32).
+ * \li phase:         Initial phase = initial_phase_rad / (2 * pi) * 2^32 (modulo 2^32).
+ * \li in_a:          Pointer to an array of pointers to multiple vectors to be multiplied and accumulated.
+ * \li num_a_vectors: Number of vectors to be multiplied by the reference vector and accumulated.
+ * \li num_points:    Number of complex values to be multiplied together, accumulated and stored into \p result.
+ *
+ * \b Outputs
+ * \li phase:         Final phase.
+ * \li result:        Vector of \p num_a_vectors components with the multiple vectors of \p in_a multiplied by the rotated \p in_common and accumulated,
+ *                    scaled by the carrier amplitude (127).
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_16ic_16i_nco_dot_prod_32fc_xn_H
+#define INCLUDED_volk_gnsssdr_16ic_16i_nco_dot_prod_32fc_xn_H
+
+#include "volk_gnsssdr/volk_gnsssdr_8ic_16i_nco_dot_prod_32fc_xn.h"  // for the carrier tables
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
+#include <volk_gnsssdr/volk_gnsssdr_malloc.h>
+#include <stdint.h>
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_16ic_16i_nco_dot_prod_32fc_xn_generic(lv_32fc_t* result, const lv_16sc_t* in_common, const uint32_t phase_inc, uint32_t* phase, const int16_t** in_a, int num_a_vectors, unsigned int num_points)
+{
+    int64_t* accumulator = (int64_t*)volk_gnsssdr_malloc(2 * num_a_vectors * sizeof(int64_t), volk_gnsssdr_get_alignment());
+    uint32_t ph = *phase;
+    int n_vec;
+    unsigned int n;
+    for (n_vec = 0; n_vec < 2 * num_a_vectors; n_vec++)
+        {
+            accumulator[n_vec] = 0;
+        }
+    for (n = 0; n < num_points; n++)
+        {
+            const int16_t* carrier_re = &volk_gnsssdr_8ic_nco_carrier_re[2 * (ph >> 26)];
+            const int16_t* carrier_im = &volk_gnsssdr_8ic_nco_carrier_im[2 * (ph >> 26)];
+            const int32_t sample_re = lv_creal(in_common[n]);
+            const int32_t sample_im = lv_cimag(in_common[n]);
+            const int32_t re = sample_re * carrier_re[0] + sample_im * carrier_re[1];
+            const int32_t im = sample_re * carrier_im[0] + sample_im * carrier_im[1];
+            ph += phase_inc;
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    accumulator[2 * n_vec] += (int64_t)re * in_a[n_vec][n];
+                    accumulator[2 * n_vec + 1] += (int64_t)im * in_a[n_vec][n];
+                }
+        }
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            result[n_vec] = lv_cmake((float)accumulator[2 * n_vec], (float)accumulator[2 * n_vec + 1]);
+        }
+    *phase = ph;
+    volk_gnsssdr_free(accumulator);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+#ifdef LV_HAVE_SSE4_1
+#include <smmintrin.h>
+
+static inline void volk_gnsssdr_16ic_16i_nco_dot_prod_32fc_xn_u_sse4_1(lv_32fc_t* result, const lv_16sc_t* in_common, const uint32_t phase_inc, uint32_t* phase, const int16_t** in_a, int num_a_vectors, unsigned int num_points)
+{
+    const unsigned int eighth_points = num_points / 8;
+    __m128* accumulator = (__m128*)volk_gnsssdr_malloc(2 * num_a_vectors * sizeof(__m128), volk_gnsssdr_get_alignment());
+    __VOLK_ATTR_ALIGNED(16) int32_t index[8];
+    __VOLK_ATTR_ALIGNED(16) float lanes[4];
+    const int32_t* carrier_re = (const int32_t*)volk_gnsssdr_8ic_nco_carrier_re;
+    const int32_t* carrier_im = (const int32_t*)volk_gnsssdr_8ic_nco_carrier_im;
+    const __m128i phase_inc8 = _mm_set1_epi32((int32_t)(8 * phase_inc));
+    __m128i ph_lo = _mm_set_epi32((int32_t)(*phase + 3 * phase_inc), (int32_t)(*phase + 2 * phase_inc), (int32_t)(*phase + phase_inc), (int32_t)(*phase));
+    __m128i ph_hi = _mm_add_epi32(ph_lo, _mm_set1_epi32((int32_t)(4 * phase_inc)));
+    __m128i samples_lo, samples_hi, code;
+    __m128 re_lo, re_hi, im_lo, im_hi, code_lo, code_hi;
+    uint32_t ph = *phase;
+    int n_vec;
+    unsigned int n;
+    int k;
+    for (n_vec = 0; n_vec < 2 * num_a_vectors; n_vec++)
+        {
+            accumulator[n_vec] = _mm_setzero_ps();
+        }
+    for (n = 0; n < eighth_points; n++)
+        {
+            // carrier of the 8 samples
+            _mm_store_si128((__m128i*)index, _mm_srli_epi32(ph_lo, 26));
+            _mm_store_si128((__m128i*)&index[4], _mm_srli_epi32(ph_hi, 26));
+            ph_lo = _mm_add_epi32(ph_lo, phase_inc8);
+            ph_hi = _mm_add_epi32(ph_hi, phase_inc8);
+
+            // 8 complex samples, rotated as 32-bit integers and converted to float
+            samples_lo = _mm_loadu_si128((const __m128i*)&in_common[8 * n]);
+            samples_hi = _mm_loadu_si128((const __m128i*)&in_common[8 * n + 4]);
+            re_lo = _mm_cvtepi32_ps(_mm_madd_epi16(samples_lo, _mm_set_epi32(carrier_re[index[3]], carrier_re[index[2]], carrier_re[index[1]], carrier_re[index[0]])));
+            re_hi = _mm_cvtepi32_ps(_mm_madd_epi16(samples_hi, _mm_set_epi32(carrier_re[index[7]], carrier_re[index[6]], carrier_re[index[5]], carrier_re[index[4]])));
+            im_lo = _mm_cvtepi32_ps(_mm_madd_epi16(samples_lo, _mm_set_epi32(carrier_im[index[3]], carrier_im[index[2]], carrier_im[index[1]], carrier_im[index[0]])));
+            im_hi = _mm_cvtepi32_ps(_mm_madd_epi16(samples_hi, _mm_set_epi32(carrier_im[index[7]], carrier_im[index[6]], carrier_im[index[5]], carrier_im[index[4]])));
+
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    code = _mm_loadu_si128((const __m128i*)&in_a[n_vec][8 * n]);
+                    code_lo = _mm_cvtepi32_ps(_mm_cvtepi16_epi32(code));
+                    code_hi = _mm_cvtepi32_ps(_mm_cvtepi16_epi32(_mm_srli_si128(code, 8)));
+                    accumulator[2 * n_vec] = _mm_add_ps(accumulator[2 * n_vec], _mm_add_ps(_mm_mul_ps(re_lo, code_lo), _mm_mul_ps(re_hi, code_hi)));
+                    accumulator[2 * n_vec + 1] = _mm_add_ps(accumulator[2 * n_vec + 1], _mm_add_ps(_mm_mul_ps(im_lo, code_lo), _mm_mul_ps(im_hi, code_hi)));
+                }
+        }
+    ph += 8 * eighth_points * phase_inc;
+
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            float re = 0.0F;
+            float im = 0.0F;
+            _mm_store_ps(lanes, accumulator[2 * n_vec]);
+            for (k = 0; k < 4; k++)
+                {
+                    re += lanes[k];
+                }
+            _mm_store_ps(lanes, accumulator[2 * n_vec + 1]);
+            for (k = 0; k < 4; k++)
+                {
+                    im += lanes[k];
+                }
+            for (n = 8 * eighth_points; n < num_points; n++)
+                {
+                    // the phase goes on from the last vectorized sample
+                    const uint32_t tail_ph = ph + (n - 8 * eighth_points) * phase_inc;
+                    const int16_t* c_re = &volk_gnsssdr_8ic_nco_carrier_re[2 * (tail_ph >> 26)];
+                    const int16_t* c_im = &volk_gnsssdr_8ic_nco_carrier_im[2 * (tail_ph >> 26)];
+                    const int32_t sample_re = lv_creal(in_common[n]);
+                    const int32_t sample_im = lv_cimag(in_common[n]);
+                    re += (float)((sample_re * c_re[0] + sample_im * c_re[1]) * in_a[n_vec][n]);
+                    im += (float)((sample_re * c_im[0] + sample_im * c_im[1]) * in_a[n_vec][n]);
+                }
+            result[n_vec] = lv_cmake(re, im);
+        }
+    *phase = ph + (num_points - 8 * eighth_points) * phase_inc;
+    volk_gnsssdr_free(accumulator);
+}
+
+#endif /* LV_HAVE_SSE4_1 */
+
+#ifdef LV_HAVE_SSE4_1
+#include <smmintrin.h>
+
+static inline void volk_gnsssdr_16ic_16i_nco_dot_prod_32fc_xn_a_sse4_1(lv_32fc_t* result, const lv_16sc_t* in_common, const uint32_t phase_inc, uint32_t* phase, const int16_t** in_a, int num_a_vectors, unsigned int num_points)
+{
+    const unsigned int eighth_points = num_points / 8;
+    __m128* accumulator = (__m128*)volk_gnsssdr_malloc(2 * num_a_vectors * sizeof(__m128), volk_gnsssdr_get_alignment());
+    __VOLK_ATTR_ALIGNED(16) int32_t index[8];
+    __VOLK_ATTR_ALIGNED(16) float lanes[4];
+    const int32_t* carrier_re = (const int32_t*)volk_gnsssdr_8ic_nco_carrier_re;
+    const int32_t* carrier_im = (const int32_t*)volk_gnsssdr_8ic_nco_carrier_im;
+    const __m128i phase_inc8 = _mm_set1_epi32((int32_t)(8 * phase_inc));
+    __m128i ph_lo = _mm_set_epi32((int32_t)(*phase + 3 * phase_inc), (int32_t)(*phase + 2 * phase_inc), (int32_t)(*phase + phase_inc), (int32_t)(*phase));
+    __m128i ph_hi = _mm_add_epi32(ph_lo, _mm_set1_epi32((int32_t)(4 * phase_inc)));
+    __m128i samples_lo, samples_hi, code;
+    __m128 re_lo, re_hi, im_lo, im_hi, code_lo, code_hi;
+    uint32_t ph = *phase;
+    int n_vec;
+    unsigned int n;
+    int k;
+    for (n_vec = 0; n_vec < 2 * num_a_vectors; n_vec++)
+        {
+            accumulator[n_vec] = _mm_setzero_ps();
+        }
+    for (n = 0; n < eighth_points; n++)
+        {
+            // carrier of the 8 samples
+            _mm_store_si128((__m128i*)index, _mm_srli_epi32(ph_lo, 26));
+            _mm_store_si128((__m128i*)&index[4], _mm_srli_epi32(ph_hi, 26));
+            ph_lo = _mm_add_epi32(ph_lo, phase_inc8);
+            ph_hi = _mm_add_epi32(ph_hi, phase_inc8);
+
+            // 8 complex samples, rotated as 32-bit integers and converted to float
+            samples_lo = _mm_load_si128((const __m128i*)&in_common[8 * n]);
+            samples_hi = _mm_load_si128((const __m128i*)&in_common[8 * n + 4]);
+            re_lo = _mm_cvtepi32_ps(_mm_madd_epi16(samples_lo, _mm_set_epi32(carrier_re[index[3]], carrier_re[index[2]], carrier_re[index[1]], carrier_re[index[0]])));
+            re_hi = _mm_cvtepi32_ps(_mm_madd_epi16(samples_hi, _mm_set_epi32(carrier_re[index[7]], carrier_re[index[6]], carrier_re[index[5]], carrier_re[index[4]])));
+            im_lo = _mm_cvtepi32_ps(_mm_madd_epi16(samples_lo, _mm_set_epi32(carrier_im[index[3]], carrier_im[index[2]], carrier_im[index[1]], carrier_im[index[0]])));
+            im_hi = _mm_cvtepi32_ps(_mm_madd_epi16(samples_hi, _mm_set_epi32(carrier_im[index[7]], carrier_im[index[6]], carrier_im[index[5]], carrier_im[index[4]])));
+
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    code = _mm_load_si128((const __m128i*)&in_a[n_vec][8 * n]);
+                    code_lo = _mm_cvtepi32_ps(_mm_cvtepi16_epi32(code));
+                    code_hi = _mm_cvtepi32_ps(_mm_cvtepi16_epi32(_mm_srli_si128(code, 8)));
+                    accumulator[2 * n_vec] = _mm_add_ps(accumulator[2 * n_vec], _mm_add_ps(_mm_mul_ps(re_lo, code_lo), _mm_mul_ps(re_hi, code_hi)));
+                    accumulator[2 * n_vec + 1] = _mm_add_ps(accumulator[2 * n_vec + 1], _mm_add_ps(_mm_mul_ps(im_lo, code_lo), _mm_mul_ps(im_hi, code_hi)));
+                }
+        }
+    ph += 8 * eighth_points * phase_inc;
+
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            float re = 0.0F;
+            float im = 0.0F;
+            _mm_store_ps(lanes, accumulator[2 * n_vec]);
+            for (k = 0; k < 4; k++)
+                {
+                    re += lanes[k];
+                }
+            _mm_store_ps(lanes, accumulator[2 * n_vec + 1]);
+            for (k = 0; k < 4; k++)
+                {
+                    im += lanes[k];
+                }
+            for (n = 8 * eighth_points; n < num_points; n++)
+                {
+                    // the phase goes on from the last vectorized sample
+                    const uint32_t tail_ph = ph + (n - 8 * eighth_points) * phase_inc;
+                    const int16_t* c_re = &volk_gnsssdr_8ic_nco_carrier_re[2 * (tail_ph >> 26)];
+                    const int16_t* c_im = &volk_gnsssdr_8ic_nco_carrier_im[2 * (tail_ph >> 26)];
+                    const int32_t sample_re = lv_creal(in_common[n]);
+                    const int32_t sample_im = lv_cimag(in_common[n]);
+                    re += (float)((sample_re * c_re[0] + sample_im * c_re[1]) * in_a[n_vec][n]);
+                    im += (float)((sample_re * c_im[0] + sample_im * c_im[1]) * in_a[n_vec][n]);
+                }
+            result[n_vec] = lv_cmake(re, im);
+        }
+    *phase = ph + (num_points - 8 * eighth_points) * phase_inc;
+    volk_gnsssdr_free(accumulator);
+}
+
+#endif /* LV_HAVE_SSE4_1 */
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_16ic_16i_nco_dot_prod_32fc_xn_u_avx2(lv_32fc_t* result, const lv_16sc_t* in_common, const uint32_t phase_inc, uint32_t* phase, const int16_t** in_a, int num_a_vectors, unsigned int num_points)
+{
+    const unsigned int sixteenth_points = num_points / 16;
+    __m256* accumulator = (__m256*)volk_gnsssdr_malloc(2 * num_a_vectors * sizeof(__m256), volk_gnsssdr_get_alignment());
+    __VOLK_ATTR_ALIGNED(32) float lanes[8];
+    const int* carrier_re = (const int*)volk_gnsssdr_8ic_nco_carrier_re;
+    const int* carrier_im = (const int*)volk_gnsssdr_8ic_nco_carrier_im;
+    const __m256i phase_inc16 = _mm256_set1_epi32((int32_t)(16 * phase_inc));
+    __m256i ph_lo = _mm256_set_epi32((int32_t)(*phase + 7 * phase_inc), (int32_t)(*phase + 6 * phase_inc), (int32_t)(*phase + 5 * phase_inc), (int32_t)(*phase + 4 * phase_inc),
+        (int32_t)(*phase + 3 * phase_inc), (int32_t)(*phase + 2 * phase_inc), (int32_t)(*phase + phase_inc), (int32_t)(*phase));
+    __m256i ph_hi = _mm256_add_epi32(ph_lo, _mm256_set1_epi32((int32_t)(8 * phase_inc)));
+    __m256i samples_lo, samples_hi, index_lo, index_hi, code;
+    __m256 re_lo, re_hi, im_lo, im_hi, code_lo, code_hi;
+    uint32_t ph = *phase;
+    int n_vec;
+    unsigned int n;
+    int k;
+    for (n_vec = 0; n_vec < 2 * num_a_vectors; n_vec++)
+        {
+            accumulator[n_vec] = _mm256_setzero_ps();
+        }
+    for (n = 0; n < sixteenth_points; n++)
+        {
+            // carrier of the 16 samples
+            index_lo = _mm256_srli_epi32(ph_lo, 26);
+            index_hi = _mm256_srli_epi32(ph_hi, 26);
+            ph_lo = _mm256_add_epi32(ph_lo, phase_inc16);
+            ph_hi = _mm256_add_epi32(ph_hi, phase_inc16);
+
+            // 16 complex samples, rotated as 32-bit integers and converted to float
+            samples_lo = _mm256_loadu_si256((const __m256i*)&in_common[16 * n]);
+            samples_hi = _mm256_loadu_si256((const __m256i*)&in_common[16 * n + 8]);
+            re_lo = _mm256_cvtepi32_ps(_mm256_madd_epi16(samples_lo, _mm256_i32gather_epi32(carrier_re, index_lo, 4)));
+            re_hi = _mm256_cvtepi32_ps(_mm256_madd_epi16(samples_hi, _mm256_i32gather_epi32(carrier_re, index_hi, 4)));
+            im_lo = _mm256_cvtepi32_ps(_mm256_madd_epi16(samples_lo, _mm256_i32gather_epi32(carrier_im, index_lo, 4)));
+            im_hi = _mm256_cvtepi32_ps(_mm256_madd_epi16(samples_hi, _mm256_i32gather_epi32(carrier_im, index_hi, 4)));
+
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    code = _mm256_loadu_si256((const __m256i*)&in_a[n_vec][16 * n]);
+                    code_lo = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm256_castsi256_si128(code)));
+                    code_hi = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm256_extracti128_si256(code, 1)));
+                    accumulator[2 * n_vec] = _mm256_add_ps(accumulator[2 * n_vec], _mm256_add_ps(_mm256_mul_ps(re_lo, code_lo), _mm256_mul_ps(re_hi, code_hi)));
+                    accumulator[2 * n_vec + 1] = _mm256_add_ps(accumulator[2 * n_vec + 1], _mm256_add_ps(_mm256_mul_ps(im_lo, code_lo), _mm256_mul_ps(im_hi, code_hi)));
+                }
+        }
+    ph += 16 * sixteenth_points * phase_inc;
+
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            float re = 0.0F;
+            float im = 0.0F;
+            _mm256_store_ps(lanes, accumulator[2 * n_vec]);
+            for (k = 0; k < 8; k++)
+                {
+                    re += lanes[k];
+                }
+            _mm256_store_ps(lanes, accumulator[2 * n_vec + 1]);
+            for (k = 0; k < 8; k++)
+                {
+                    im += lanes[k];
+                }
+            for (n = 16 * sixteenth_points; n < num_points; n++)
+                {
+                    // the phase goes on from the last vectorized sample
+                    const uint32_t tail_ph = ph + (n - 16 * sixteenth_points) * phase_inc;
+                    const int16_t* c_re = &volk_gnsssdr_8ic_nco_carrier_re[2 * (tail_ph >> 26)];
+                    const int16_t* c_im = &volk_gnsssdr_8ic_nco_carrier_im[2 * (tail_ph >> 26)];
+                    const int32_t sample_re = lv_creal(in_common[n]);
+                    const int32_t sample_im = lv_cimag(in_common[n]);
+                    re += (float)((sample_re * c_re[0] + sample_im * c_re[1]) * in_a[n_vec][n]);
+                    im += (float)((sample_re * c_im[0] + sample_im * c_im[1]) * in_a[n_vec][n]);
+                }
+            result[n_vec] = lv_cmake(re, im);
+        }
+    *phase = ph + (num_points - 16 * sixteenth_points) * phase_inc;
+    volk_gnsssdr_free(accumulator);
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_16ic_16i_nco_dot_prod_32fc_xn_a_avx2(lv_32fc_t* result, const lv_16sc_t* in_common, const uint32_t phase_inc, uint32_t* phase, const int16_t** in_a, int num_a_vectors, unsigned int num_points)
+{
+    const unsigned int sixteenth_points = num_points / 16;
+    __m256* accumulator = (__m256*)volk_gnsssdr_malloc(2 * num_a_vectors * sizeof(__m256), volk_gnsssdr_get_alignment());
+    __VOLK_ATTR_ALIGNED(32) float lanes[8];
+    const int* carrier_re = (const int*)volk_gnsssdr_8ic_nco_carrier_re;
+    const int* carrier_im = (const int*)volk_gnsssdr_8ic_nco_carrier_im;
+    const __m256i phase_inc16 = _mm256_set1_epi32((int32_t)(16 * phase_inc));
+    __m256i ph_lo = _mm256_set_epi32((int32_t)(*phase + 7 * phase_inc), (int32_t)(*phase + 6 * phase_inc), (int32_t)(*phase + 5 * phase_inc), (int32_t)(*phase + 4 * phase_inc),
+        (int32_t)(*phase + 3 * phase_inc), (int32_t)(*phase + 2 * phase_inc), (int32_t)(*phase + phase_inc), (int32_t)(*phase));
+    __m256i ph_hi = _mm256_add_epi32(ph_lo, _mm256_set1_epi32((int32_t)(8 * phase_inc)));
+    __m256i samples_lo, samples_hi, index_lo, index_hi, code;
+    __m256 re_lo, re_hi, im_lo, im_hi, code_lo, code_hi;
+    uint32_t ph = *phase;
+    int n_vec;
+    unsigned int n;
+    int k;
+    for (n_vec = 0; n_vec < 2 * num_a_vectors; n_vec++)
+        {
+            accumulator[n_vec] = _mm256_setzero_ps();
+        }
+    for (n = 0; n < sixteenth_points; n++)
+        {
+            // carrier of the 16 samples
+            index_lo = _mm256_srli_epi32(ph_lo, 26);
+            index_hi = _mm256_srli_epi32(ph_hi, 26);
+            ph_lo = _mm256_add_epi32(ph_lo, phase_inc16);
+            ph_hi = _mm256_add_epi32(ph_hi, phase_inc16);
+
+            // 16 complex samples, rotated as 32-bit integers and converted to float
+            samples_lo = _mm256_load_si256((const __m256i*)&in_common[16 * n]);
+            samples_hi = _mm256_load_si256((const __m256i*)&in_common[16 * n + 8]);
+            re_lo = _mm256_cvtepi32_ps(_mm256_madd_epi16(samples_lo, _mm256_i32gather_epi32(carrier_re, index_lo, 4)));
+            re_hi = _mm256_cvtepi32_ps(_mm256_madd_epi16(samples_hi, _mm256_i32gather_epi32(carrier_re, index_hi, 4)));
+            im_lo = _mm256_cvtepi32_ps(_mm256_madd_epi16(samples_lo, _mm256_i32gather_epi32(carrier_im, index_lo, 4)));
+            im_hi = _mm256_cvtepi32_ps(_mm256_madd_epi16(samples_hi, _mm256_i32gather_epi32(carrier_im, index_hi, 4)));
+
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    code = _mm256_load_si256((const __m256i*)&in_a[n_vec][16 * n]);
+                    code_lo = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm256_castsi256_si128(code)));
+                    code_hi = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm256_extracti128_si256(code, 1)));
+                    accumulator[2 * n_vec] = _mm256_add_ps(accumulator[2 * n_vec], _mm256_add_ps(_mm256_mul_ps(re_lo, code_lo), _mm256_mul_ps(re_hi, code_hi)));
+                    accumulator[2 * n_vec + 1] = _mm256_add_ps(accumulator[2 * n_vec + 1], _mm256_add_ps(_mm256_mul_ps(im_lo, code_lo), _mm256_mul_ps(im_hi, code_hi)));
+                }
+        }
+    ph += 16 * sixteenth_points * phase_inc;
+
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            float re = 0.0F;
+            float im = 0.0F;
+            _mm256_store_ps(lanes, accumulator[2 * n_vec]);
+            for (k = 0; k < 8; k++)
+                {
+                    re += lanes[k];
+                }
+            _mm256_store_ps(lanes, accumulator[2 * n_vec + 1]);
+            for (k = 0; k < 8; k++)
+                {
+                    im += lanes[k];
+                }
+            for (n = 16 * sixteenth_points; n < num_points; n++)
+                {
+                    // the phase goes on from the last vectorized sample
+                    const uint32_t tail_ph = ph + (n - 16 * sixteenth_points) * phase_inc;
+                    const int16_t* c_re = &volk_gnsssdr_8ic_nco_carrier_re[2 * (tail_ph >> 26)];
+                    const int16_t* c_im = &volk_gnsssdr_8ic_nco_carrier_im[2 * (tail_ph >> 26)];
+                    const int32_t sample_re = lv_creal(in_common[n]);
+                    const int32_t sample_im = lv_cimag(in_common[n]);
+                    re += (float)((sample_re * c_re[0] + sample_im * c_re[1]) * in_a[n_vec][n]);
+                    im += (float)((sample_re * c_im[0] + sample_im * c_im[1]) * in_a[n_vec][n]);
+                }
+            result[n_vec] = lv_cmake(re, im);
+        }
+    *phase = ph + (num_points - 16 * sixteenth_points) * phase_inc;
+    volk_gnsssdr_free(accumulator);
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+#endif /* INCLUDED_volk_gnsssdr_16ic_16i_nco_dot_prod_32fc_xn_H */
@@ -782,4 +782,388 @@ static inline void volk_gnsssdr_16ic_16i_rotator_dot_prod_16ic_xn_u_avx2(lv_16sc
 }
 #endif /* LV_HAVE_AVX2 */
 
+
+#ifdef LV_HAVE_AVX512F
+#include <volk_gnsssdr/volk_gnsssdr_avx512_intrinsics.h>
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_16ic_16i_rotator_dot_prod_16ic_xn_u_avx512f(lv_16sc_t* result, const lv_16sc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const int16_t** in_a, int num_a_vectors, unsigned int num_points)
+{
+    const unsigned int avx512_iters = num_points / 8;
+    const int16_t** _in_a = in_a;
+    const lv_16sc_t* _in_common = in_common;
+    lv_16sc_t* _out = result;
+    int n_vec;
+    unsigned int number;
+    unsigned int n;
+
+    lv_16sc_t tmp16;
+    lv_32fc_t tmp32;
+
+    __VOLK_ATTR_ALIGNED(32)
+    lv_16sc_t dotProductVector[8];
+    lv_16sc_t dotProduct = lv_cmake(0, 0);
+
+    __m256i* cacc = (__m256i*)volk_gnsssdr_malloc(num_a_vectors * sizeof(__m256i), volk_gnsssdr_get_alignment());
+
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            cacc[n_vec] = _mm256_setzero_si256();
+        }
+
+    __m128i ain_128, ain_128_lo, ain_128_hi;
+    __m256i a2, b2, c;
+    __m512 a, b;
+
+    __m512 eight_phase_acc_reg, eight_phase_inc_reg;
+
+    lv_32fc_t _phase_inc = phase_inc * phase_inc;
+    _phase_inc *= _phase_inc;
+    _phase_inc *= _phase_inc;  // _phase_inc = phase_inc^8
+
+    // Normalise the 8*phase increment
+#ifdef __cplusplus
+    _phase_inc /= std::abs(_phase_inc);
+#else
+    _phase_inc /= hypotf(lv_creal(_phase_inc), lv_cimag(_phase_inc));
+#endif
+
+    __VOLK_ATTR_ALIGNED(64)
+    lv_32fc_t eight_phase_inc[8];
+    __VOLK_ATTR_ALIGNED(64)
+    lv_32fc_t eight_phase_acc[8];
+    for (n = 0; n < 8; ++n)
+        {
+            eight_phase_inc[n] = _phase_inc;
+            eight_phase_acc[n] = *phase;
+            *phase *= phase_inc;
+        }
+    eight_phase_acc_reg = _mm512_load_ps((float*)eight_phase_acc);
+    eight_phase_inc_reg = _mm512_load_ps((float*)eight_phase_inc);
+
+    for (number = 0; number < avx512_iters; number++)
+        {
+            // convert eight 16ic samples to 32fc
+            a = _mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(_mm256_loadu_si256((__m256i*)_in_common)));
+
+            // complex 32fc multiplication b=a*eight_phase_acc_reg
+            b = _mm512_complexmul_ps(a, eight_phase_acc_reg);
+
+            // convert from 32fc to 16ic with saturation
+            b2 = _mm512_cvtsepi32_epi16(_mm512_cvtps_epi32(b));
+
+            // complex 32fc multiplication eight_phase_acc_reg=eight_phase_acc_reg*eight_phase_inc_reg
+            eight_phase_acc_reg = _mm512_complexmul_ps(eight_phase_inc_reg, eight_phase_acc_reg);
+
+            __VOLK_GNSSSDR_PREFETCH(_in_common + 16);
+
+            _in_common += 8;
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    ain_128 = _mm_loadu_si128((__m128i*)&(_in_a[n_vec][number * 8]));
+
+                    ain_128_lo = _mm_unpacklo_epi16(ain_128, ain_128);
+                    ain_128_hi = _mm_unpackhi_epi16(ain_128, ain_128);
+
+                    a2 = _mm256_insertf128_si256(_mm256_castsi128_si256(ain_128_lo), ain_128_hi, 1);
+
+                    c = _mm256_mullo_epi16(a2, b2);
+
+                    cacc[n_vec] = _mm256_adds_epi16(cacc[n_vec], c);
+                }
+            // Regenerate phase
+            if ((number % 128) == 0)
+                {
+                    eight_phase_acc_reg = _mm512_complexnormalise_ps(eight_phase_acc_reg);
+                }
+        }
+
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            a2 = cacc[n_vec];
+
+            _mm256_store_si256((__m256i*)dotProductVector, a2);  // Store the results back into the dot product vector
+            dotProduct = lv_cmake(0, 0);
+            for (number = 0; number < 8; ++number)
+                {
+                    dotProduct = lv_cmake(sat_adds16i(lv_creal(dotProduct), lv_creal(dotProductVector[number])),
+                        sat_adds16i(lv_cimag(dotProduct), lv_cimag(dotProductVector[number])));
+                }
+            _out[n_vec] = dotProduct;
+        }
+
+    volk_gnsssdr_free(cacc);
+
+    _mm512_store_ps((float*)eight_phase_acc, eight_phase_acc_reg);
+    (*phase) = eight_phase_acc[0];
+
+    for (n = avx512_iters * 8; n < num_points; n++)
+        {
+            tmp16 = in_common[n];
+            tmp32 = lv_cmake((float)lv_creal(tmp16), (float)lv_cimag(tmp16)) * (*phase);
+            tmp16 = lv_cmake((int16_t)rintf(lv_creal(tmp32)), (int16_t)rintf(lv_cimag(tmp32)));
+            (*phase) *= phase_inc;
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    lv_16sc_t tmp = tmp16 * in_a[n_vec][n];
+                    _out[n_vec] = lv_cmake(sat_adds16i(lv_creal(_out[n_vec]), lv_creal(tmp)),
+                        sat_adds16i(lv_cimag(_out[n_vec]), lv_cimag(tmp)));
+                }
+        }
+}
+
+#endif /* LV_HAVE_AVX512F */
+
+
+#ifdef LV_HAVE_AVX512F
+#include <volk_gnsssdr/volk_gnsssdr_avx512_intrinsics.h>
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_16ic_16i_rotator_dot_prod_16ic_xn_a_avx512f(lv_16sc_t* result, const lv_16sc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const int16_t** in_a, int num_a_vectors, unsigned int num_points)
+{
+    const unsigned int avx512_iters = num_points / 8;
+    const int16_t** _in_a = in_a;
+    const lv_16sc_t* _in_common = in_common;
+    lv_16sc_t* _out = result;
+    int n_vec;
+    unsigned int number;
+    unsigned int n;
+
+    lv_16sc_t tmp16;
+    lv_32fc_t tmp32;
+
+    __VOLK_ATTR_ALIGNED(32)
+    lv_16sc_t dotProductVector[8];
+    lv_16sc_t dotProduct = lv_cmake(0, 0);
+
+    __m256i* cacc = (__m256i*)volk_gnsssdr_malloc(num_a_vectors * sizeof(__m256i), volk_gnsssdr_get_alignment());
+
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            cacc[n_vec] = _mm256_setzero_si256();
+        }
+
+    __m128i ain_128, ain_128_lo, ain_128_hi;
+    __m256i a2, b2, c;
+    __m512 a, b;
+
+    __m512 eight_phase_acc_reg, eight_phase_inc_reg;
+
+    lv_32fc_t _phase_inc = phase_inc * phase_inc;
+    _phase_inc *= _phase_inc;
+    _phase_inc *= _phase_inc;  // _phase_inc = phase_inc^8
+
+    // Normalise the 8*phase increment
+#ifdef __cplusplus
+    _phase_inc /= std::abs(_phase_inc);
+#else
+    _phase_inc /= hypotf(lv_creal(_phase_inc), lv_cimag(_phase_inc));
+#endif
+
+    __VOLK_ATTR_ALIGNED(64)
+    lv_32fc_t eight_phase_inc[8];
+    __VOLK_ATTR_ALIGNED(64)
+    lv_32fc_t eight_phase_acc[8];
+    for (n = 0; n < 8; ++n)
+        {
+            eight_phase_inc[n] = _phase_inc;
+            eight_phase_acc[n] = *phase;
+            *phase *= phase_inc;
+        }
+    eight_phase_acc_reg = _mm512_load_ps((float*)eight_phase_acc);
+    eight_phase_inc_reg = _mm512_load_ps((float*)eight_phase_inc);
+
+    for (number = 0; number < avx512_iters; number++)
+        {
+            // convert eight 16ic samples to 32fc
+            a = _mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(_mm256_load_si256((__m256i*)_in_common)));
+
+            // complex 32fc multiplication b=a*eight_phase_acc_reg
+            b = _mm512_complexmul_ps(a, eight_phase_acc_reg);
+
+            // convert from 32fc to 16ic with saturation
+            b2 = _mm512_cvtsepi32_epi16(_mm512_cvtps_epi32(b));
+
+            // complex 32fc multiplication eight_phase_acc_reg=eight_phase_acc_reg*eight_phase_inc_reg
+            eight_phase_acc_reg = _mm512_complexmul_ps(eight_phase_inc_reg, eight_phase_acc_reg);
+
+            __VOLK_GNSSSDR_PREFETCH(_in_common + 16);
+
+            _in_common += 8;
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    ain_128 = _mm_load_si128((__m128i*)&(_in_a[n_vec][number * 8]));
+
+                    ain_128_lo = _mm_unpacklo_epi16(ain_128, ain_128);
+                    ain_128_hi = _mm_unpackhi_epi16(ain_128, ain_128);
+
+                    a2 = _mm256_insertf128_si256(_mm256_castsi128_si256(ain_128_lo), ain_128_hi, 1);
+
+                    c = _mm256_mullo_epi16(a2, b2);
+
+                    cacc[n_vec] = _mm256_adds_epi16(cacc[n_vec], c);
+                }
+            // Regenerate phase
+            if ((number % 128) == 0)
+                {
+                    eight_phase_acc_reg = _mm512_complexnormalise_ps(eight_phase_acc_reg);
+                }
+        }
+
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            a2 = cacc[n_vec];
+
+            _mm256_store_si256((__m256i*)dotProductVector, a2);  // Store the results back into the dot product vector
+            dotProduct = lv_cmake(0, 0);
+            for (number = 0; number < 8; ++number)
+                {
+                    dotProduct = lv_cmake(sat_adds16i(lv_creal(dotProduct), lv_creal(dotProductVector[number])),
+                        sat_adds16i(lv_cimag(dotProduct), lv_cimag(dotProductVector[number])));
+                }
+            _out[n_vec] = dotProduct;
+        }
+
+    volk_gnsssdr_free(cacc);
+
+    _mm512_store_ps((float*)eight_phase_acc, eight_phase_acc_reg);
+    (*phase) = eight_phase_acc[0];
+
+    for (n = avx512_iters * 8; n < num_points; n++)
+        {
+            tmp16 = in_common[n];
+            tmp32 = lv_cmake((float)lv_creal(tmp16), (float)lv_cimag(tmp16)) * (*phase);
+            tmp16 = lv_cmake((int16_t)rintf(lv_creal(tmp32)), (int16_t)rintf(lv_cimag(tmp32)));
+            (*phase) *= phase_inc;
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    lv_16sc_t tmp = tmp16 * in_a[n_vec][n];
+                    _out[n_vec] = lv_cmake(sat_adds16i(lv_creal(_out[n_vec]), lv_creal(tmp)),
+                        sat_adds16i(lv_cimag(_out[n_vec]), lv_cimag(tmp)));
+                }
+        }
+}
+
+#endif /* LV_HAVE_AVX512F */
+
+
+#ifdef LV_HAVE_SVE
+#include <arm_sve.h>
+
+static inline void volk_gnsssdr_16ic_16i_rotator_dot_prod_16ic_xn_sve(lv_16sc_t* result, const lv_16sc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const int16_t** in_a, int num_a_vectors, unsigned int num_points)
+{
+    const unsigned int num_lanes = (unsigned int)svcntw();  // 32-bit lanes, holding num_lanes / 2 interleaved complex samples
+    const unsigned int num_complex = num_lanes / 2;
+    const unsigned int sve_iters = num_points / num_complex;
+    const svbool_t pg = svptrue_b32();
+    const svbool_t pg_taps = svwhilelt_b32_u32(0U, num_complex);
+    lv_16sc_t* _out = result;
+    int n_vec;
+    unsigned int number;
+    unsigned int n;
+
+    lv_16sc_t tmp16;
+    lv_32fc_t tmp32;
+    lv_16sc_t dotProduct;
+
+    // SVE registers cannot be stored in arrays, so the accumulators live in memory
+    int32_t* cacc = (int32_t*)volk_gnsssdr_malloc(num_a_vectors * num_lanes * sizeof(int32_t), volk_gnsssdr_get_alignment());
+    for (n = 0; n < num_a_vectors * num_lanes; n++)
+        {
+            cacc[n] = 0;
+        }
+
+    lv_32fc_t _phase_inc = lv_cmake(1.0f, 0.0f);
+    lv_32fc_t phase_acc[32];  // up to 2048-bit vectors
+    lv_32fc_t phase_inc_vec[32];
+    for (n = 0; n < num_complex; ++n)
+        {
+            phase_acc[n] = *phase;
+            *phase *= phase_inc;
+            _phase_inc *= phase_inc;  // _phase_inc = phase_inc^num_complex
+        }
+
+    // Normalise the phase increment
+#ifdef __cplusplus
+    _phase_inc /= std::abs(_phase_inc);
+#else
+    _phase_inc /= hypotf(lv_creal(_phase_inc), lv_cimag(_phase_inc));
+#endif
+    for (n = 0; n < num_complex; ++n)
+        {
+            phase_inc_vec[n] = _phase_inc;
+        }
+
+    svfloat32_t phase_acc_reg = svld1_f32(pg, (const float*)phase_acc);
+    const svfloat32_t phase_inc_reg = svld1_f32(pg, (const float*)phase_inc_vec);
+    const svfloat32_t zeros = svdup_n_f32(0.0f);
+
+    for (number = 0; number < sve_iters; number++)
+        {
+            // convert num_complex 16ic samples to 32fc
+            const svfloat32_t a = svcvt_f32_s32_x(pg, svld1sh_s32(pg, (const int16_t*)(in_common + number * num_complex)));
+
+            // complex 32fc multiplication b=a*phase_acc_reg
+            const svfloat32_t b = svcmla_f32_x(pg, svcmla_f32_x(pg, zeros, a, phase_acc_reg, 0), a, phase_acc_reg, 90);
+
+            // convert from 32fc to 16ic with saturation
+            const svint32_t b2 = svmax_n_s32_x(pg, svmin_n_s32_x(pg, svcvt_s32_f32_x(pg, svrintn_f32_x(pg, b)), 32767), -32768);
+
+            // complex 32fc multiplication phase_acc_reg=phase_acc_reg*phase_inc_reg
+            phase_acc_reg = svcmla_f32_x(pg, svcmla_f32_x(pg, zeros, phase_acc_reg, phase_inc_reg, 0), phase_acc_reg, phase_inc_reg, 90);
+
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    const svint32_t ain = svld1sh_s32(pg_taps, &(in_a[n_vec][number * num_complex]));  // t0|t1|...
+                    const svint32_t a2 = svzip1_s32(ain, ain);                                          // t0|t0|t1|t1|...
+
+                    // 16-bit product, and accumulation with 16-bit saturation
+                    const svint32_t c = svexth_s32_x(pg, svmul_s32_x(pg, a2, b2));
+                    int32_t* acc = cacc + n_vec * num_lanes;
+                    svst1_s32(pg, acc, svmax_n_s32_x(pg, svmin_n_s32_x(pg, svadd_s32_x(pg, svld1_s32(pg, acc), c), 32767), -32768));
+                }
+
+            // Regenerate phase
+            if ((number % 128) == 0)
+                {
+                    const svfloat32_t sq = svmul_f32_x(pg, phase_acc_reg, phase_acc_reg);
+                    const svfloat32_t mag2 = svadd_f32_x(pg, sq, svreinterpret_f32_u64(svrevw_u64_x(svptrue_b64(), svreinterpret_u64_f32(sq))));
+                    phase_acc_reg = svdiv_f32_x(pg, phase_acc_reg, svsqrt_f32_x(pg, mag2));
+                }
+        }
+
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            const int32_t* acc = cacc + n_vec * num_lanes;
+            dotProduct = lv_cmake(0, 0);
+            for (number = 0; number < num_complex; ++number)
+                {
+                    dotProduct = lv_cmake(sat_adds16i(lv_creal(dotProduct), (int16_t)acc[2 * number]),
+                        sat_adds16i(lv_cimag(dotProduct), (int16_t)acc[2 * number + 1]));
+                }
+            _out[n_vec] = dotProduct;
+        }
+
+    volk_gnsssdr_free(cacc);
+
+    svst1_f32(pg, (float*)phase_acc, phase_acc_reg);
+    (*phase) = phase_acc[0];
+
+    for (n = sve_iters * num_complex; n < num_points; n++)
+        {
+            tmp16 = in_common[n];
+            tmp32 = lv_cmake((float)lv_creal(tmp16), (float)lv_cimag(tmp16)) * (*phase);
+            tmp16 = lv_cmake((int16_t)rintf(lv_creal(tmp32)), (int16_t)rintf(lv_cimag(tmp32)));
+            (*phase) *= phase_inc;
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    lv_16sc_t tmp = tmp16 * in_a[n_vec][n];
+                    _out[n_vec] = lv_cmake(sat_adds16i(lv_creal(_out[n_vec]), lv_creal(tmp)),
+                        sat_adds16i(lv_cimag(_out[n_vec]), lv_cimag(tmp)));
+                }
+        }
+}
+
+#endif /* LV_HAVE_SVE */
+
 #endif /* INCLUDED_volk_gnsssdr_16ic_16i_dot_prod_16ic_xn_H */
@@ -0,0 +1,139 @@
+/*!
+ * \file volk_gnsssdr_32f_signed_gather_32f.h
+ * \brief VOLK_GNSSSDR kernel: gathers floats through an index table whose
+ * most significant bit flips the sign of the gathered value.
+ *
+ * VOLK_GNSSSDR kernel that permutes a vector of soft symbols and changes the
+ * signs of some of them in one pass, as in the deinterleaving of a page and
+ * the inversion of the symbols of a convolutional code with a NOT gate, or
+ * of a 180 degrees phase lock.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_32f_signed_gather_32f
+ *
+ * \b Overview
+ *
+ * Computes cVector[i] = aVector[indices[i] & 0x7FFFFFFF], with its sign
+ * flipped if the most significant bit of indices[i] is set. The sign is
+ * flipped on the bits of the float, so there are no branches.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_32f_signed_gather_32f(float* cVector, const float* aVector, const unsigned int* indices, unsigned int num_points)
+ * \endcode
+ *
+ * \b Inputs
+ * \li aVector: The input vector.
+ * \li indices: The index in aVector of each output value, with the most
+ * significant bit set to flip its sign.
+ * \li num_points: The number of output values.
+ *
+ * \b Outputs
+ * \li cVector: The gathered values.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_32f_signed_gather_32f_H
+#define INCLUDED_volk_gnsssdr_32f_signed_gather_32f_H
+
+#include <volk_gnsssdr/volk_gnsssdr_common.h>
+#include <string.h>
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_32f_signed_gather_32f_generic(float* cVector, const float* aVector, const unsigned int* indices, unsigned int num_points)
+{
+    unsigned int i;
+    unsigned int bits;
+    for (i = 0; i < num_points; i++)
+        {
+            memcpy(&bits, &aVector[indices[i] & 0x7FFFFFFFU], sizeof(bits));
+            bits ^= indices[i] & 0x80000000U;
+            memcpy(&cVector[i], &bits, sizeof(bits));
+        }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_32f_signed_gather_32f_u_avx2(float* cVector, const float* aVector, const unsigned int* indices, unsigned int num_points)
+{
+    const unsigned int avx2_iters = num_points / 8;
+    const __m256i index_mask = _mm256_set1_epi32(0x7FFFFFFF);
+    const __m256i sign_mask = _mm256_set1_epi32((int)0x80000000U);
+    __m256i index;
+    __m256 values;
+    unsigned int number;
+    unsigned int i;
+    unsigned int bits;
+
+    for (number = 0; number < avx2_iters; number++)
+        {
+            index = _mm256_loadu_si256((const __m256i*)(indices + 8 * number));
+            values = _mm256_i32gather_ps(aVector, _mm256_and_si256(index, index_mask), 4);
+            values = _mm256_xor_ps(values, _mm256_castsi256_ps(_mm256_and_si256(index, sign_mask)));
+            _mm256_storeu_ps(cVector + 8 * number, values);
+        }
+
+    for (i = avx2_iters * 8; i < num_points; i++)
+        {
+            memcpy(&bits, &aVector[indices[i] & 0x7FFFFFFFU], sizeof(bits));
+            bits ^= indices[i] & 0x80000000U;
+            memcpy(&cVector[i], &bits, sizeof(bits));
+        }
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEON
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_32f_signed_gather_32f_neon(float* cVector, const float* aVector, const unsigned int* indices, unsigned int num_points)
+{
+    // there is no gather, but the signs are flipped four at a time
+    const unsigned int neon_iters = num_points / 4;
+    const uint32x4_t sign_mask = vdupq_n_u32(0x80000000U);
+    const unsigned int* a = (const unsigned int*)aVector;
+    uint32x4_t index;
+    uint32_t gathered[4];
+    unsigned int number;
+    unsigned int i;
+    unsigned int bits;
+
+    for (number = 0; number < neon_iters; number++)
+        {
+            index = vld1q_u32(indices + 4 * number);
+            for (i = 0; i < 4; i++)
+                {
+                    gathered[i] = a[indices[4 * number + i] & 0x7FFFFFFFU];
+                }
+            vst1q_f32(cVector + 4 * number, vreinterpretq_f32_u32(veorq_u32(vld1q_u32(gathered), vandq_u32(index, sign_mask))));
+        }
+
+    for (i = neon_iters * 4; i < num_points; i++)
+        {
+            memcpy(&bits, &aVector[indices[i] & 0x7FFFFFFFU], sizeof(bits));
+            bits ^= indices[i] & 0x80000000U;
+            memcpy(&cVector[i], &bits, sizeof(bits));
+        }
+}
+
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_32f_signed_gather_32f_H */
@@ -0,0 +1,76 @@
+/*!
+ * \file volk_gnsssdr_32f_signed_gatherpuppet_32f.h
+ * \brief Volk puppet for the signed gather kernel.
+ *
+ * Volk puppet for integrating the signed gather kernel into volk's test
+ * system
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_32f_signed_gatherpuppet_32f_H
+#define INCLUDED_volk_gnsssdr_32f_signed_gatherpuppet_32f_H
+
+#include "volk_gnsssdr/volk_gnsssdr_32f_signed_gather_32f.h"
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <volk_gnsssdr/volk_gnsssdr_malloc.h>
+
+
+static inline unsigned int* volk_gnsssdr_32f_signed_gatherpuppet_32f_indices(unsigned int num_points)
+{
+    // the transposition of a block interleaver of 8 rows, with the odd
+    // outputs inverted, as in the deinterleaving of a Galileo page
+    unsigned int* indices = (unsigned int*)volk_gnsssdr_malloc(sizeof(unsigned int) * num_points, volk_gnsssdr_get_alignment());
+    const unsigned int rows = 8;
+    const unsigned int cols = num_points / rows;
+    unsigned int i;
+    for (i = 0; i < num_points; i++)
+        {
+            indices[i] = (i < rows * cols) ? ((i % rows) * cols + i / rows) : i;
+            indices[i] |= (i % 2) ? 0x80000000U : 0U;
+        }
+    return indices;
+}
+
+
+#ifdef LV_HAVE_GENERIC
+static inline void volk_gnsssdr_32f_signed_gatherpuppet_32f_generic(float* cVector, const float* aVector, unsigned int num_points)
+{
+    unsigned int* indices = volk_gnsssdr_32f_signed_gatherpuppet_32f_indices(num_points);
+    volk_gnsssdr_32f_signed_gather_32f_generic(cVector, aVector, indices, num_points);
+    volk_gnsssdr_free(indices);
+}
+
+#endif  // Generic
+
+
+#ifdef LV_HAVE_AVX2
+static inline void volk_gnsssdr_32f_signed_gatherpuppet_32f_u_avx2(float* cVector, const float* aVector, unsigned int num_points)
+{
+    unsigned int* indices = volk_gnsssdr_32f_signed_gatherpuppet_32f_indices(num_points);
+    volk_gnsssdr_32f_signed_gather_32f_u_avx2(cVector, aVector, indices, num_points);
+    volk_gnsssdr_free(indices);
+}
+
+#endif  // AVX2
+
+
+#ifdef LV_HAVE_NEON
+static inline void volk_gnsssdr_32f_signed_gatherpuppet_32f_neon(float* cVector, const float* aVector, unsigned int num_points)
+{
+    unsigned int* indices = volk_gnsssdr_32f_signed_gatherpuppet_32f_indices(num_points);
+    volk_gnsssdr_32f_signed_gather_32f_neon(cVector, aVector, indices, num_points);
+    volk_gnsssdr_free(indices);
+}
+
+#endif  // NEON
+
+#endif  // INCLUDED_volk_gnsssdr_32f_signed_gatherpuppet_32f_H
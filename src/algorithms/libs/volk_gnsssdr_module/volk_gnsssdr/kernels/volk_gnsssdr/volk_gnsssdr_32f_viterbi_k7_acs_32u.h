@@ -0,0 +1,321 @@
+/*!
+ * \file volk_gnsssdr_32f_viterbi_k7_acs_32u.h
+ * \brief VOLK_GNSSSDR kernel: add-compare-select steps of a Viterbi decoder
+ * for convolutional codes of constraint length 7 and rate 1/2.
+ *
+ * VOLK_GNSSSDR kernel that updates the 64 path metrics of the trellis with
+ * the soft symbols of num_bits data bits, and returns the survivor decisions.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_32f_viterbi_k7_acs_32u
+ *
+ * \b Overview
+ *
+ * Add-compare-select steps of a Viterbi decoder for a K=7, rate 1/2
+ * convolutional code whose two generator polynomials have their first and
+ * last taps set (as the codes used by Galileo, GPS L2C/L5 and SBAS).
+ *
+ * The state of the encoder is its 6 last input bits, the newest one in the
+ * least significant bit. The branch metric of butterfly i is
+ * bm = symbols[0] * branch_signs[i] + symbols[1] * branch_signs[32 + i],
+ * where branch_signs holds +1 or -1 for the two code bits produced by the
+ * register (i << 1) (input bit 0 after state i). The old states i and i + 32
+ * lead to the new states 2i (input bit 0) and 2i + 1 (input bit 1), and the
+ * path metrics are maximized. The metrics are normalized at each step by
+ * subtracting the metric of state 0.
+ *
+ * The decision of each new state s is stored in bit s % 32 of
+ * decisions[2 * n + s / 32]. It is 1 if the survivor comes from old state
+ * (s >> 1) + 32, and 0 if it comes from old state s >> 1.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_32f_viterbi_k7_acs_32u(uint32_t* decisions, float* metrics, const float* symbols, const float* branch_signs, unsigned int num_bits)
+ * \endcode
+ *
+ * \b Inputs
+ * \li metrics: The 64 path metrics before the first bit.
+ * \li symbols: 2 * num_bits soft symbols, positive for a code bit 1.
+ * \li branch_signs: The 64 signs of the branch metrics of the code.
+ * \li num_bits: The number of trellis steps.
+ *
+ * \b Outputs
+ * \li decisions: 2 * num_bits words of survivor decisions.
+ * \li metrics: The 64 path metrics after the last bit.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_32f_viterbi_k7_acs_32u_H
+#define INCLUDED_volk_gnsssdr_32f_viterbi_k7_acs_32u_H
+
+#include <volk_gnsssdr/volk_gnsssdr_common.h>
+#include <stdint.h>
+#include <string.h>
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_32f_viterbi_k7_acs_32u_generic(uint32_t* decisions, float* metrics, const float* symbols, const float* branch_signs, unsigned int num_bits)
+{
+    float buffer[64];
+    float* old_metrics = metrics;
+    float* new_metrics = buffer;
+    float* tmp;
+    float bias;
+    float bm;
+    float a;
+    float b;
+    float m0;
+    float m1;
+    unsigned int n;
+    unsigned int i;
+
+    for (n = 0; n < num_bits; n++)
+        {
+            uint32_t* d = decisions + 2 * n;
+            const float sym0 = symbols[2 * n];
+            const float sym1 = symbols[2 * n + 1];
+            d[0] = 0;
+            d[1] = 0;
+            bias = old_metrics[0];
+            for (i = 0; i < 32; i++)
+                {
+                    bm = sym0 * branch_signs[i] + sym1 * branch_signs[32 + i];
+                    a = old_metrics[i] - bias;
+                    b = old_metrics[i + 32] - bias;
+
+                    // input bit 0
+                    m0 = a + bm;
+                    m1 = b - bm;
+                    new_metrics[2 * i] = (m1 > m0) ? m1 : m0;
+                    d[i / 16] |= (uint32_t)(m1 > m0) << ((2 * i) & 31);
+
+                    // input bit 1
+                    m0 = a - bm;
+                    m1 = b + bm;
+                    new_metrics[2 * i + 1] = (m1 > m0) ? m1 : m0;
+                    d[i / 16] |= (uint32_t)(m1 > m0) << ((2 * i + 1) & 31);
+                }
+            tmp = old_metrics;
+            old_metrics = new_metrics;
+            new_metrics = tmp;
+        }
+    if (old_metrics != metrics)
+        {
+            memcpy(metrics, old_metrics, 64 * sizeof(float));
+        }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE
+#include <xmmintrin.h>
+
+static inline void volk_gnsssdr_32f_viterbi_k7_acs_32u_u_sse(uint32_t* decisions, float* metrics, const float* symbols, const float* branch_signs, unsigned int num_bits)
+{
+    __VOLK_ATTR_ALIGNED(16)
+    float buffer[64];
+    float* old_metrics = metrics;
+    float* new_metrics = buffer;
+    float* tmp;
+    __m128 sym0, sym1, bias, bm, a, b, m0, m1, even, odd, d_even, d_odd;
+    unsigned int n;
+    unsigned int i;
+    uint32_t bits;
+
+    for (n = 0; n < num_bits; n++)
+        {
+            uint32_t* d = decisions + 2 * n;
+            sym0 = _mm_set1_ps(symbols[2 * n]);
+            sym1 = _mm_set1_ps(symbols[2 * n + 1]);
+            bias = _mm_set1_ps(old_metrics[0]);
+            d[0] = 0;
+            d[1] = 0;
+            for (i = 0; i < 32; i += 4)
+                {
+                    bm = _mm_add_ps(_mm_mul_ps(sym0, _mm_loadu_ps(branch_signs + i)), _mm_mul_ps(sym1, _mm_loadu_ps(branch_signs + 32 + i)));
+                    a = _mm_sub_ps(_mm_loadu_ps(old_metrics + i), bias);
+                    b = _mm_sub_ps(_mm_loadu_ps(old_metrics + i + 32), bias);
+
+                    // input bit 0
+                    m0 = _mm_add_ps(a, bm);
+                    m1 = _mm_sub_ps(b, bm);
+                    even = _mm_max_ps(m0, m1);
+                    d_even = _mm_cmpgt_ps(m1, m0);
+
+                    // input bit 1
+                    m0 = _mm_sub_ps(a, bm);
+                    m1 = _mm_add_ps(b, bm);
+                    odd = _mm_max_ps(m0, m1);
+                    d_odd = _mm_cmpgt_ps(m1, m0);
+
+                    // interleave the even and odd new states
+                    _mm_storeu_ps(new_metrics + 2 * i, _mm_unpacklo_ps(even, odd));
+                    _mm_storeu_ps(new_metrics + 2 * i + 4, _mm_unpackhi_ps(even, odd));
+                    bits = (uint32_t)_mm_movemask_ps(_mm_unpacklo_ps(d_even, d_odd)) | ((uint32_t)_mm_movemask_ps(_mm_unpackhi_ps(d_even, d_odd)) << 4);
+                    d[i / 16] |= bits << ((2 * i) & 31);
+                }
+            tmp = old_metrics;
+            old_metrics = new_metrics;
+            new_metrics = tmp;
+        }
+    if (old_metrics != metrics)
+        {
+            memcpy(metrics, old_metrics, 64 * sizeof(float));
+        }
+}
+
+#endif /* LV_HAVE_SSE */
+
+
+#ifdef LV_HAVE_AVX
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_32f_viterbi_k7_acs_32u_u_avx(uint32_t* decisions, float* metrics, const float* symbols, const float* branch_signs, unsigned int num_bits)
+{
+    __VOLK_ATTR_ALIGNED(32)
+    float buffer[64];
+    float* old_metrics = metrics;
+    float* new_metrics = buffer;
+    float* tmp;
+    __m256 sym0, sym1, bias, bm, a, b, m0, m1, even, odd, d_even, d_odd, lo, hi;
+    unsigned int n;
+    unsigned int i;
+    uint32_t bits;
+
+    for (n = 0; n < num_bits; n++)
+        {
+            uint32_t* d = decisions + 2 * n;
+            sym0 = _mm256_set1_ps(symbols[2 * n]);
+            sym1 = _mm256_set1_ps(symbols[2 * n + 1]);
+            bias = _mm256_set1_ps(old_metrics[0]);
+            d[0] = 0;
+            d[1] = 0;
+            for (i = 0; i < 32; i += 8)
+                {
+                    bm = _mm256_add_ps(_mm256_mul_ps(sym0, _mm256_loadu_ps(branch_signs + i)), _mm256_mul_ps(sym1, _mm256_loadu_ps(branch_signs + 32 + i)));
+                    a = _mm256_sub_ps(_mm256_loadu_ps(old_metrics + i), bias);
+                    b = _mm256_sub_ps(_mm256_loadu_ps(old_metrics + i + 32), bias);
+
+                    // input bit 0
+                    m0 = _mm256_add_ps(a, bm);
+                    m1 = _mm256_sub_ps(b, bm);
+                    even = _mm256_max_ps(m0, m1);
+                    d_even = _mm256_cmp_ps(m1, m0, _CMP_GT_OQ);
+
+                    // input bit 1
+                    m0 = _mm256_sub_ps(a, bm);
+                    m1 = _mm256_add_ps(b, bm);
+                    odd = _mm256_max_ps(m0, m1);
+                    d_odd = _mm256_cmp_ps(m1, m0, _CMP_GT_OQ);
+
+                    // interleave the even and odd new states (unpack works within 128-bit lanes)
+                    lo = _mm256_unpacklo_ps(even, odd);
+                    hi = _mm256_unpackhi_ps(even, odd);
+                    _mm256_storeu_ps(new_metrics + 2 * i, _mm256_permute2f128_ps(lo, hi, 0x20));
+                    _mm256_storeu_ps(new_metrics + 2 * i + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+                    lo = _mm256_unpacklo_ps(d_even, d_odd);
+                    hi = _mm256_unpackhi_ps(d_even, d_odd);
+                    bits = (uint32_t)_mm256_movemask_ps(_mm256_permute2f128_ps(lo, hi, 0x20)) | ((uint32_t)_mm256_movemask_ps(_mm256_permute2f128_ps(lo, hi, 0x31)) << 8);
+                    d[i / 16] |= bits << ((2 * i) & 31);
+                }
+            tmp = old_metrics;
+            old_metrics = new_metrics;
+            new_metrics = tmp;
+        }
+    if (old_metrics != metrics)
+        {
+            memcpy(metrics, old_metrics, 64 * sizeof(float));
+        }
+    _mm256_zeroupper();
+}
+
+#endif /* LV_HAVE_AVX */
+
+
+#ifdef LV_HAVE_NEON
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_32f_viterbi_k7_acs_32u_neon(uint32_t* decisions, float* metrics, const float* symbols, const float* branch_signs, unsigned int num_bits)
+{
+    __VOLK_ATTR_ALIGNED(16)
+    float buffer[64];
+    float* old_metrics = metrics;
+    float* new_metrics = buffer;
+    float* tmp;
+    float32x4_t sym0, sym1, bias, bm, a, b, m0, m1, even, odd;
+    float32x4x2_t zipped;
+    uint32x4_t d_even, d_odd;
+    uint32x4x2_t d_zipped;
+    uint32x2_t sum;
+    const uint32_t weights[4] = {1, 2, 4, 8};
+    const uint32x4_t bit_weights = vld1q_u32(weights);
+    unsigned int n;
+    unsigned int i;
+    uint32_t bits;
+
+    for (n = 0; n < num_bits; n++)
+        {
+            uint32_t* d = decisions + 2 * n;
+            sym0 = vdupq_n_f32(symbols[2 * n]);
+            sym1 = vdupq_n_f32(symbols[2 * n + 1]);
+            bias = vdupq_n_f32(old_metrics[0]);
+            d[0] = 0;
+            d[1] = 0;
+            for (i = 0; i < 32; i += 4)
+                {
+                    bm = vaddq_f32(vmulq_f32(sym0, vld1q_f32(branch_signs + i)), vmulq_f32(sym1, vld1q_f32(branch_signs + 32 + i)));
+                    a = vsubq_f32(vld1q_f32(old_metrics + i), bias);
+                    b = vsubq_f32(vld1q_f32(old_metrics + i + 32), bias);
+
+                    // input bit 0
+                    m0 = vaddq_f32(a, bm);
+                    m1 = vsubq_f32(b, bm);
+                    even = vmaxq_f32(m0, m1);
+                    d_even = vcgtq_f32(m1, m0);
+
+                    // input bit 1
+                    m0 = vsubq_f32(a, bm);
+                    m1 = vaddq_f32(b, bm);
+                    odd = vmaxq_f32(m0, m1);
+                    d_odd = vcgtq_f32(m1, m0);
+
+                    // interleave the even and odd new states
+                    zipped = vzipq_f32(even, odd);
+                    vst1q_f32(new_metrics + 2 * i, zipped.val[0]);
+                    vst1q_f32(new_metrics + 2 * i + 4, zipped.val[1]);
+                    d_zipped = vzipq_u32(d_even, d_odd);
+                    // gather the sign bits of the eight decisions, as a movemask
+                    d_zipped.val[0] = vandq_u32(d_zipped.val[0], bit_weights);
+                    d_zipped.val[1] = vshlq_n_u32(vandq_u32(d_zipped.val[1], bit_weights), 4);
+                    d_zipped.val[0] = vorrq_u32(d_zipped.val[0], d_zipped.val[1]);
+                    sum = vpadd_u32(vget_low_u32(d_zipped.val[0]), vget_high_u32(d_zipped.val[0]));
+                    sum = vpadd_u32(sum, sum);
+                    bits = vget_lane_u32(sum, 0);
+                    d[i / 16] |= bits << ((2 * i) & 31);
+                }
+            tmp = old_metrics;
+            old_metrics = new_metrics;
+            new_metrics = tmp;
+        }
+    if (old_metrics != metrics)
+        {
+            memcpy(metrics, old_metrics, 64 * sizeof(float));
+        }
+}
+
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_32f_viterbi_k7_acs_32u_H */
@@ -0,0 +1,124 @@
+/*!
+ * \file volk_gnsssdr_32f_viterbi_k7_acspuppet_32u.h
+ * \brief Volk puppet for the add-compare-select kernel of the K=7, rate 1/2
+ * Viterbi decoder.
+ *
+ * Volk puppet for integrating the Viterbi add-compare-select kernel into
+ * volk's test system
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_32f_viterbi_k7_acspuppet_32u_H
+#define INCLUDED_volk_gnsssdr_32f_viterbi_k7_acspuppet_32u_H
+
+#include "volk_gnsssdr/volk_gnsssdr_32f_viterbi_k7_acs_32u.h"
+#include <stdint.h>
+
+
+static inline void volk_gnsssdr_32f_viterbi_k7_acspuppet_32u_init(float* metrics, float* branch_signs)
+{
+    // polynomials of the GPS L2C and L5 codes, newest bit in the LSB
+    const uint32_t polys[2] = {0x4f, 0x6d};
+    uint32_t i;
+    uint32_t k;
+    uint32_t reg;
+    uint32_t parity;
+    for (k = 0; k < 2; k++)
+        {
+            for (i = 0; i < 32; i++)
+                {
+                    reg = (2 * i) & polys[k];
+                    parity = 0;
+                    while (reg != 0)
+                        {
+                            parity ^= reg & 1;
+                            reg >>= 1;
+                        }
+                    branch_signs[32 * k + i] = parity ? 1.0F : -1.0F;
+                }
+        }
+    for (i = 0; i < 64; i++)
+        {
+            metrics[i] = -63.0F;
+        }
+    metrics[0] = 0.0F;
+}
+
+
+#ifdef LV_HAVE_GENERIC
+static inline void volk_gnsssdr_32f_viterbi_k7_acspuppet_32u_generic(uint32_t* decisions, const float* symbols, unsigned int num_points)
+{
+    float metrics[64];
+    float branch_signs[64];
+    volk_gnsssdr_32f_viterbi_k7_acspuppet_32u_init(metrics, branch_signs);
+    // two symbols and two decision words per bit
+    volk_gnsssdr_32f_viterbi_k7_acs_32u_generic(decisions, metrics, symbols, branch_signs, num_points / 2);
+    if (num_points % 2 != 0)
+        {
+            decisions[num_points - 1] = 0;
+        }
+}
+
+#endif  // Generic
+
+
+#ifdef LV_HAVE_SSE
+static inline void volk_gnsssdr_32f_viterbi_k7_acspuppet_32u_u_sse(uint32_t* decisions, const float* symbols, unsigned int num_points)
+{
+    float metrics[64];
+    float branch_signs[64];
+    volk_gnsssdr_32f_viterbi_k7_acspuppet_32u_init(metrics, branch_signs);
+    // two symbols and two decision words per bit
+    volk_gnsssdr_32f_viterbi_k7_acs_32u_u_sse(decisions, metrics, symbols, branch_signs, num_points / 2);
+    if (num_points % 2 != 0)
+        {
+            decisions[num_points - 1] = 0;
+        }
+}
+
+#endif  // SSE
+
+
+#ifdef LV_HAVE_AVX
+static inline void volk_gnsssdr_32f_viterbi_k7_acspuppet_32u_u_avx(uint32_t* decisions, const float* symbols, unsigned int num_points)
+{
+    float metrics[64];
+    float branch_signs[64];
+    volk_gnsssdr_32f_viterbi_k7_acspuppet_32u_init(metrics, branch_signs);
+    // two symbols and two decision words per bit
+    volk_gnsssdr_32f_viterbi_k7_acs_32u_u_avx(decisions, metrics, symbols, branch_signs, num_points / 2);
+    if (num_points % 2 != 0)
+        {
+            decisions[num_points - 1] = 0;
+        }
+}
+
+#endif  // AVX
+
+
+#ifdef LV_HAVE_NEON
+static inline void volk_gnsssdr_32f_viterbi_k7_acspuppet_32u_neon(uint32_t* decisions, const float* symbols, unsigned int num_points)
+{
+    float metrics[64];
+    float branch_signs[64];
+    volk_gnsssdr_32f_viterbi_k7_acspuppet_32u_init(metrics, branch_signs);
+    // two symbols and two decision words per bit
+    volk_gnsssdr_32f_viterbi_k7_acs_32u_neon(decisions, metrics, symbols, branch_signs, num_points / 2);
+    if (num_points % 2 != 0)
+        {
+            decisions[num_points - 1] = 0;
+        }
+}
+
+#endif  // NEON
+
+#endif  // INCLUDED_volk_gnsssdr_32f_viterbi_k7_acspuppet_32u_H
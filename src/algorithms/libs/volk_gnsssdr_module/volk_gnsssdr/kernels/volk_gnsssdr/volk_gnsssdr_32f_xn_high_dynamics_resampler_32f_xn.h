@@ -598,6 +598,214 @@ static inline void volk_gnsssdr_32f_xn_high_dynamics_resampler_32f_xn_u_avx(floa
 }
 
 #endif
+#ifdef LV_HAVE_AVX512F
+#include <immintrin.h>
+static inline void volk_gnsssdr_32f_xn_high_dynamics_resampler_32f_xn_a_avx512f(float** result, const float* local_code, float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips, float* shifts_chips, unsigned int code_length_chips, int num_out_vectors, unsigned int num_points)
+{
+    float** _result = result;
+    const unsigned int avx512_iters = num_points / 16;
+    int current_correlator_tap;
+    unsigned int n;
+    const __m512 sixteens = _mm512_set1_ps(16.0f);
+    const __m512 ones = _mm512_set1_ps(1.0f);
+    const __m512 rem_code_phase_chips_reg = _mm512_set1_ps(rem_code_phase_chips);
+    const __m512 code_phase_step_chips_reg = _mm512_set1_ps(code_phase_step_chips);
+    const __m512 code_phase_rate_step_chips_reg = _mm512_set1_ps(code_phase_rate_step_chips);
+
+    int local_code_chip_index_;
+
+    const __m512i zeros = _mm512_setzero_si512();
+    const __m512 code_length_chips_reg_f = _mm512_set1_ps((float)code_length_chips);
+    const __m512i code_length_chips_reg_i = _mm512_set1_epi32((int)code_length_chips);
+    const __m512 n0 = _mm512_set_ps(15.0f, 14.0f, 13.0f, 12.0f, 11.0f, 10.0f, 9.0f, 8.0f, 7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f);
+
+    __m512i local_code_chip_index_reg, i;
+    __m512 aux, aux2, aux3, shifts_chips_reg, c, cTrunc, base, indexn, indexnn;
+    __mmask16 negatives;
+
+    shifts_chips_reg = _mm512_set1_ps((float)shifts_chips[0]);
+    aux2 = _mm512_sub_ps(shifts_chips_reg, rem_code_phase_chips_reg);
+    indexn = n0;
+    for (n = 0; n < avx512_iters; n++)
+        {
+            __VOLK_GNSSSDR_PREFETCH_LOCALITY(&_result[0][16 * n + 15], 1, 0);
+            aux = _mm512_mul_ps(code_phase_step_chips_reg, indexn);
+            indexnn = _mm512_mul_ps(indexn, indexn);
+            aux3 = _mm512_mul_ps(code_phase_rate_step_chips_reg, indexnn);
+            aux = _mm512_add_ps(aux, aux3);
+            aux = _mm512_add_ps(aux, aux2);
+            // floor
+            aux = _mm512_roundscale_ps(aux, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+
+            // Correct negative shift
+            c = _mm512_div_ps(aux, code_length_chips_reg_f);
+            aux3 = _mm512_add_ps(c, ones);
+            i = _mm512_cvttps_epi32(aux3);
+            cTrunc = _mm512_cvtepi32_ps(i);
+            base = _mm512_mul_ps(cTrunc, code_length_chips_reg_f);
+            local_code_chip_index_reg = _mm512_cvttps_epi32(_mm512_sub_ps(aux, base));
+
+            negatives = _mm512_cmplt_epi32_mask(local_code_chip_index_reg, zeros);
+            local_code_chip_index_reg = _mm512_mask_add_epi32(local_code_chip_index_reg, negatives, local_code_chip_index_reg, code_length_chips_reg_i);
+
+            _mm512_store_ps(&_result[0][n * 16], _mm512_i32gather_ps(local_code_chip_index_reg, local_code, 4));
+            indexn = _mm512_add_ps(indexn, sixteens);
+        }
+
+    for (n = avx512_iters * 16; n < num_points; n++)
+        {
+            // resample code for first tap
+            local_code_chip_index_ = (int)floor(code_phase_step_chips * (float)n + code_phase_rate_step_chips * (float)(n * n) + shifts_chips[0] - rem_code_phase_chips);
+            // Take into account that in multitap correlators, the shifts can be negative!
+            if (local_code_chip_index_ < 0) local_code_chip_index_ += (int)code_length_chips * (abs(local_code_chip_index_) / code_length_chips + 1);
+            local_code_chip_index_ = local_code_chip_index_ % code_length_chips;
+            _result[0][n] = local_code[local_code_chip_index_];
+        }
+
+    // adjacent correlators
+    unsigned int shift_samples = 0;
+    for (current_correlator_tap = 1; current_correlator_tap < num_out_vectors; current_correlator_tap++)
+        {
+            shift_samples += (int)round((shifts_chips[current_correlator_tap] - shifts_chips[current_correlator_tap - 1]) / code_phase_step_chips);
+            memcpy(&_result[current_correlator_tap][0], &_result[0][shift_samples], (num_points - shift_samples) * sizeof(float));
+            memcpy(&_result[current_correlator_tap][num_points - shift_samples], &_result[0][0], shift_samples * sizeof(float));
+        }
+}
+
+#endif
+
+
+#ifdef LV_HAVE_AVX512F
+#include <immintrin.h>
+static inline void volk_gnsssdr_32f_xn_high_dynamics_resampler_32f_xn_u_avx512f(float** result, const float* local_code, float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips, float* shifts_chips, unsigned int code_length_chips, int num_out_vectors, unsigned int num_points)
+{
+    float** _result = result;
+    const unsigned int avx512_iters = num_points / 16;
+    int current_correlator_tap;
+    unsigned int n;
+    const __m512 sixteens = _mm512_set1_ps(16.0f);
+    const __m512 ones = _mm512_set1_ps(1.0f);
+    const __m512 rem_code_phase_chips_reg = _mm512_set1_ps(rem_code_phase_chips);
+    const __m512 code_phase_step_chips_reg = _mm512_set1_ps(code_phase_step_chips);
+    const __m512 code_phase_rate_step_chips_reg = _mm512_set1_ps(code_phase_rate_step_chips);
+
+    int local_code_chip_index_;
+
+    const __m512i zeros = _mm512_setzero_si512();
+    const __m512 code_length_chips_reg_f = _mm512_set1_ps((float)code_length_chips);
+    const __m512i code_length_chips_reg_i = _mm512_set1_epi32((int)code_length_chips);
+    const __m512 n0 = _mm512_set_ps(15.0f, 14.0f, 13.0f, 12.0f, 11.0f, 10.0f, 9.0f, 8.0f, 7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f);
+
+    __m512i local_code_chip_index_reg, i;
+    __m512 aux, aux2, aux3, shifts_chips_reg, c, cTrunc, base, indexn, indexnn;
+    __mmask16 negatives;
+
+    shifts_chips_reg = _mm512_set1_ps((float)shifts_chips[0]);
+    aux2 = _mm512_sub_ps(shifts_chips_reg, rem_code_phase_chips_reg);
+    indexn = n0;
+    for (n = 0; n < avx512_iters; n++)
+        {
+            __VOLK_GNSSSDR_PREFETCH_LOCALITY(&_result[0][16 * n + 15], 1, 0);
+            aux = _mm512_mul_ps(code_phase_step_chips_reg, indexn);
+            indexnn = _mm512_mul_ps(indexn, indexn);
+            aux3 = _mm512_mul_ps(code_phase_rate_step_chips_reg, indexnn);
+            aux = _mm512_add_ps(aux, aux3);
+            aux = _mm512_add_ps(aux, aux2);
+            // floor
+            aux = _mm512_roundscale_ps(aux, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+
+            // Correct negative shift
+            c = _mm512_div_ps(aux, code_length_chips_reg_f);
+            aux3 = _mm512_add_ps(c, ones);
+            i = _mm512_cvttps_epi32(aux3);
+            cTrunc = _mm512_cvtepi32_ps(i);
+            base = _mm512_mul_ps(cTrunc, code_length_chips_reg_f);
+            local_code_chip_index_reg = _mm512_cvttps_epi32(_mm512_sub_ps(aux, base));
+
+            negatives = _mm512_cmplt_epi32_mask(local_code_chip_index_reg, zeros);
+            local_code_chip_index_reg = _mm512_mask_add_epi32(local_code_chip_index_reg, negatives, local_code_chip_index_reg, code_length_chips_reg_i);
+
+            _mm512_storeu_ps(&_result[0][n * 16], _mm512_i32gather_ps(local_code_chip_index_reg, local_code, 4));
+            indexn = _mm512_add_ps(indexn, sixteens);
+        }
+
+    for (n = avx512_iters * 16; n < num_points; n++)
+        {
+            // resample code for first tap
+            local_code_chip_index_ = (int)floor(code_phase_step_chips * (float)n + code_phase_rate_step_chips * (float)(n * n) + shifts_chips[0] - rem_code_phase_chips);
+            // Take into account that in multitap correlators, the shifts can be negative!
+            if (local_code_chip_index_ < 0) local_code_chip_index_ += (int)code_length_chips * (abs(local_code_chip_index_) / code_length_chips + 1);
+            local_code_chip_index_ = local_code_chip_index_ % code_length_chips;
+            _result[0][n] = local_code[local_code_chip_index_];
+        }
+
+    // adjacent correlators
+    unsigned int shift_samples = 0;
+    for (current_correlator_tap = 1; current_correlator_tap < num_out_vectors; current_correlator_tap++)
+        {
+            shift_samples += (int)round((shifts_chips[current_correlator_tap] - shifts_chips[current_correlator_tap - 1]) / code_phase_step_chips);
+            memcpy(&_result[current_correlator_tap][0], &_result[0][shift_samples], (num_points - shift_samples) * sizeof(float));
+            memcpy(&_result[current_correlator_tap][num_points - shift_samples], &_result[0][0], shift_samples * sizeof(float));
+        }
+}
+
+#endif
+
+
+#ifdef LV_HAVE_SVE
+#include <arm_sve.h>
+
+static inline void volk_gnsssdr_32f_xn_high_dynamics_resampler_32f_xn_sve(float** result, const float* local_code, float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips, float* shifts_chips, unsigned int code_length_chips, int num_out_vectors, unsigned int num_points)
+{
+    float** _result = result;
+    const unsigned int num_lanes = (unsigned int)svcntw();
+    int current_correlator_tap;
+    unsigned int n;
+    svbool_t pg;
+
+    const svfloat32_t code_length_chips_reg_f = svdup_n_f32((float)code_length_chips);
+    const svint32_t code_length_chips_reg_i = svdup_n_s32((int32_t)code_length_chips);
+    const svfloat32_t n0 = svcvt_f32_s32_x(svptrue_b32(), svindex_s32(0, 1));
+    const svfloat32_t aux2 = svdup_n_f32(shifts_chips[0] - rem_code_phase_chips);
+    svint32_t local_code_chip_index_reg, i;
+    svfloat32_t aux, aux3, c, cTrunc, base, indexn;
+
+    // the last iteration is predicated, there is no scalar tail
+    for (n = 0; n < num_points; n += num_lanes)
+        {
+            pg = svwhilelt_b32_u32(n, num_points);
+            indexn = svadd_n_f32_x(pg, n0, (float)n);
+            aux = svmul_n_f32_x(pg, indexn, code_phase_step_chips);
+            aux3 = svmul_n_f32_x(pg, svmul_f32_x(pg, indexn, indexn), code_phase_rate_step_chips);
+            aux = svadd_f32_x(pg, aux, aux3);
+            aux = svadd_f32_x(pg, aux, aux2);
+            // floor
+            aux = svrintm_f32_x(pg, aux);
+
+            // Correct negative shift
+            c = svdiv_f32_x(pg, aux, code_length_chips_reg_f);
+            i = svcvt_s32_f32_x(pg, svadd_n_f32_x(pg, c, 1.0f));
+            cTrunc = svcvt_f32_s32_x(pg, i);
+            base = svmul_f32_x(pg, cTrunc, code_length_chips_reg_f);
+            local_code_chip_index_reg = svcvt_s32_f32_x(pg, svsub_f32_x(pg, aux, base));
+
+            local_code_chip_index_reg = svadd_s32_m(svcmplt_n_s32(pg, local_code_chip_index_reg, 0), local_code_chip_index_reg, code_length_chips_reg_i);
+
+            svst1_f32(pg, &_result[0][n], svld1_gather_s32index_f32(pg, local_code, local_code_chip_index_reg));
+        }
+
+    // adjacent correlators
+    unsigned int shift_samples = 0;
+    for (current_correlator_tap = 1; current_correlator_tap < num_out_vectors; current_correlator_tap++)
+        {
+            shift_samples += (int)round((shifts_chips[current_correlator_tap] - shifts_chips[current_correlator_tap - 1]) / code_phase_step_chips);
+            memcpy(&_result[current_correlator_tap][0], &_result[0][shift_samples], (num_points - shift_samples) * sizeof(float));
+            memcpy(&_result[current_correlator_tap][num_points - shift_samples], &_result[0][0], shift_samples * sizeof(float));
+        }
+}
+
+#endif
+
 //
 //
 // #ifdef LV_HAVE_NEON
@@ -599,4 +599,190 @@ static inline void volk_gnsssdr_32f_xn_resampler_32f_xn_neon(float** result, con
 
 #endif
 
+
+#ifdef LV_HAVE_AVX512F
+#include <immintrin.h>
+static inline void volk_gnsssdr_32f_xn_resampler_32f_xn_a_avx512f(float** result, const float* local_code, float rem_code_phase_chips, float code_phase_step_chips, float* shifts_chips, unsigned int code_length_chips, int num_out_vectors, unsigned int num_points)
+{
+    float** _result = result;
+    const unsigned int avx512_iters = num_points / 16;
+    int current_correlator_tap;
+    unsigned int n;
+    const __m512 sixteens = _mm512_set1_ps(16.0f);
+    const __m512 rem_code_phase_chips_reg = _mm512_set1_ps(rem_code_phase_chips);
+    const __m512 code_phase_step_chips_reg = _mm512_set1_ps(code_phase_step_chips);
+
+    int local_code_chip_index_;
+
+    const __m512i zeros = _mm512_setzero_si512();
+    const __m512 code_length_chips_reg_f = _mm512_set1_ps((float)code_length_chips);
+    const __m512i code_length_chips_reg_i = _mm512_set1_epi32((int)code_length_chips);
+    const __m512 n0 = _mm512_set_ps(15.0f, 14.0f, 13.0f, 12.0f, 11.0f, 10.0f, 9.0f, 8.0f, 7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f);
+
+    __m512i local_code_chip_index_reg, i;
+    __m512 aux, aux2, shifts_chips_reg, c, cTrunc, base, indexn;
+    __mmask16 negatives;
+
+    for (current_correlator_tap = 0; current_correlator_tap < num_out_vectors; current_correlator_tap++)
+        {
+            shifts_chips_reg = _mm512_set1_ps((float)shifts_chips[current_correlator_tap]);
+            aux2 = _mm512_sub_ps(shifts_chips_reg, rem_code_phase_chips_reg);
+            indexn = n0;
+            for (n = 0; n < avx512_iters; n++)
+                {
+                    __VOLK_GNSSSDR_PREFETCH_LOCALITY(&_result[current_correlator_tap][16 * n + 15], 1, 0);
+                    aux = _mm512_mul_ps(code_phase_step_chips_reg, indexn);
+                    aux = _mm512_add_ps(aux, aux2);
+                    // floor
+                    aux = _mm512_roundscale_ps(aux, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+
+                    // fmod
+                    c = _mm512_div_ps(aux, code_length_chips_reg_f);
+                    i = _mm512_cvttps_epi32(c);
+                    cTrunc = _mm512_cvtepi32_ps(i);
+                    base = _mm512_mul_ps(cTrunc, code_length_chips_reg_f);
+                    local_code_chip_index_reg = _mm512_cvttps_epi32(_mm512_sub_ps(aux, base));
+
+                    // no negatives
+                    negatives = _mm512_cmplt_epi32_mask(local_code_chip_index_reg, zeros);
+                    local_code_chip_index_reg = _mm512_mask_add_epi32(local_code_chip_index_reg, negatives, local_code_chip_index_reg, code_length_chips_reg_i);
+
+                    _mm512_store_ps(&_result[current_correlator_tap][n * 16], _mm512_i32gather_ps(local_code_chip_index_reg, local_code, 4));
+                    indexn = _mm512_add_ps(indexn, sixteens);
+                }
+        }
+
+    for (current_correlator_tap = 0; current_correlator_tap < num_out_vectors; current_correlator_tap++)
+        {
+            for (n = avx512_iters * 16; n < num_points; n++)
+                {
+                    // resample code for current tap
+                    local_code_chip_index_ = (int)floor(code_phase_step_chips * (float)n + shifts_chips[current_correlator_tap] - rem_code_phase_chips);
+                    // Take into account that in multitap correlators, the shifts can be negative!
+                    if (local_code_chip_index_ < 0) local_code_chip_index_ += (int)code_length_chips * (abs(local_code_chip_index_) / code_length_chips + 1);
+                    local_code_chip_index_ = local_code_chip_index_ % code_length_chips;
+                    _result[current_correlator_tap][n] = local_code[local_code_chip_index_];
+                }
+        }
+}
+
+#endif
+
+
+#ifdef LV_HAVE_AVX512F
+#include <immintrin.h>
+static inline void volk_gnsssdr_32f_xn_resampler_32f_xn_u_avx512f(float** result, const float* local_code, float rem_code_phase_chips, float code_phase_step_chips, float* shifts_chips, unsigned int code_length_chips, int num_out_vectors, unsigned int num_points)
+{
+    float** _result = result;
+    const unsigned int avx512_iters = num_points / 16;
+    int current_correlator_tap;
+    unsigned int n;
+    const __m512 sixteens = _mm512_set1_ps(16.0f);
+    const __m512 rem_code_phase_chips_reg = _mm512_set1_ps(rem_code_phase_chips);
+    const __m512 code_phase_step_chips_reg = _mm512_set1_ps(code_phase_step_chips);
+
+    int local_code_chip_index_;
+
+    const __m512i zeros = _mm512_setzero_si512();
+    const __m512 code_length_chips_reg_f = _mm512_set1_ps((float)code_length_chips);
+    const __m512i code_length_chips_reg_i = _mm512_set1_epi32((int)code_length_chips);
+    const __m512 n0 = _mm512_set_ps(15.0f, 14.0f, 13.0f, 12.0f, 11.0f, 10.0f, 9.0f, 8.0f, 7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f);
+
+    __m512i local_code_chip_index_reg, i;
+    __m512 aux, aux2, shifts_chips_reg, c, cTrunc, base, indexn;
+    __mmask16 negatives;
+
+    for (current_correlator_tap = 0; current_correlator_tap < num_out_vectors; current_correlator_tap++)
+        {
+            shifts_chips_reg = _mm512_set1_ps((float)shifts_chips[current_correlator_tap]);
+            aux2 = _mm512_sub_ps(shifts_chips_reg, rem_code_phase_chips_reg);
+            indexn = n0;
+            for (n = 0; n < avx512_iters; n++)
+                {
+                    __VOLK_GNSSSDR_PREFETCH_LOCALITY(&_result[current_correlator_tap][16 * n + 15], 1, 0);
+                    aux = _mm512_mul_ps(code_phase_step_chips_reg, indexn);
+                    aux = _mm512_add_ps(aux, aux2);
+                    // floor
+                    aux = _mm512_roundscale_ps(aux, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+
+                    // fmod
+                    c = _mm512_div_ps(aux, code_length_chips_reg_f);
+                    i = _mm512_cvttps_epi32(c);
+                    cTrunc = _mm512_cvtepi32_ps(i);
+                    base = _mm512_mul_ps(cTrunc, code_length_chips_reg_f);
+                    local_code_chip_index_reg = _mm512_cvttps_epi32(_mm512_sub_ps(aux, base));
+
+                    // no negatives
+                    negatives = _mm512_cmplt_epi32_mask(local_code_chip_index_reg, zeros);
+                    local_code_chip_index_reg = _mm512_mask_add_epi32(local_code_chip_index_reg, negatives, local_code_chip_index_reg, code_length_chips_reg_i);
+
+                    _mm512_storeu_ps(&_result[current_correlator_tap][n * 16], _mm512_i32gather_ps(local_code_chip_index_reg, local_code, 4));
+                    indexn = _mm512_add_ps(indexn, sixteens);
+                }
+        }
+
+    for (current_correlator_tap = 0; current_correlator_tap < num_out_vectors; current_correlator_tap++)
+        {
+            for (n = avx512_iters * 16; n < num_points; n++)
+                {
+                    // resample code for current tap
+                    local_code_chip_index_ = (int)floor(code_phase_step_chips * (float)n + shifts_chips[current_correlator_tap] - rem_code_phase_chips);
+                    // Take into account that in multitap correlators, the shifts can be negative!
+                    if (local_code_chip_index_ < 0) local_code_chip_index_ += (int)code_length_chips * (abs(local_code_chip_index_) / code_length_chips + 1);
+                    local_code_chip_index_ = local_code_chip_index_ % code_length_chips;
+                    _result[current_correlator_tap][n] = local_code[local_code_chip_index_];
+                }
+        }
+}
+
+#endif
+
+
+#ifdef LV_HAVE_SVE
+#include <arm_sve.h>
+
+static inline void volk_gnsssdr_32f_xn_resampler_32f_xn_sve(float** result, const float* local_code, float rem_code_phase_chips, float code_phase_step_chips, float* shifts_chips, unsigned int code_length_chips, int num_out_vectors, unsigned int num_points)
+{
+    float** _result = result;
+    const unsigned int num_lanes = (unsigned int)svcntw();
+    int current_correlator_tap;
+    unsigned int n;
+    svbool_t pg;
+
+    const svfloat32_t code_length_chips_reg_f = svdup_n_f32((float)code_length_chips);
+    const svint32_t code_length_chips_reg_i = svdup_n_s32((int32_t)code_length_chips);
+    const svfloat32_t n0 = svcvt_f32_s32_x(svptrue_b32(), svindex_s32(0, 1));
+    svint32_t local_code_chip_index_reg, i;
+    svfloat32_t aux, aux2, c, cTrunc, base, indexn;
+
+    for (current_correlator_tap = 0; current_correlator_tap < num_out_vectors; current_correlator_tap++)
+        {
+            aux2 = svdup_n_f32(shifts_chips[current_correlator_tap] - rem_code_phase_chips);
+            // the last iteration is predicated, there is no scalar tail
+            for (n = 0; n < num_points; n += num_lanes)
+                {
+                    pg = svwhilelt_b32_u32(n, num_points);
+                    indexn = svadd_n_f32_x(pg, n0, (float)n);
+                    aux = svmul_n_f32_x(pg, indexn, code_phase_step_chips);
+                    aux = svadd_f32_x(pg, aux, aux2);
+                    // floor
+                    aux = svrintm_f32_x(pg, aux);
+
+                    // fmod
+                    c = svdiv_f32_x(pg, aux, code_length_chips_reg_f);
+                    i = svcvt_s32_f32_x(pg, c);
+                    cTrunc = svcvt_f32_s32_x(pg, i);
+                    base = svmul_f32_x(pg, cTrunc, code_length_chips_reg_f);
+                    local_code_chip_index_reg = svcvt_s32_f32_x(pg, svsub_f32_x(pg, aux, base));
+
+                    // no negatives
+                    local_code_chip_index_reg = svadd_s32_m(svcmplt_n_s32(pg, local_code_chip_index_reg, 0), local_code_chip_index_reg, code_length_chips_reg_i);
+
+                    svst1_f32(pg, &_result[current_correlator_tap][n], svld1_gather_s32index_f32(pg, local_code, local_code_chip_index_reg));
+                }
+        }
+}
+
+#endif
+
 #endif /*INCLUDED_volk_gnsssdr_32f_xn_resampler_32f_xn_H*/
@@ -62,6 +62,139 @@
 #include <volk_gnsssdr/volk_gnsssdr_malloc.h>
 #include <math.h>
 
+/*
+ * Helpers of the SIMD implementations. For m >= 1, the phase of sample m is
+ * phase(m) = phase(0) * phase_inc^m * phase_inc_rate^((m - 1)^2), which is
+ * what the generic implementation computes. The SIMD implementations process
+ * blocks of num_lanes samples with rotators z_k = phase(m0 + k), updated on
+ * each block as z_k *= dz_k and dz_k *= phase_inc_rate^(2 * num_lanes^2).
+ * In order to not accumulate the rounding errors of this second order
+ * recursion, the rotators are regenerated in double precision every period
+ * of samples (a multiple of num_lanes).
+ */
+typedef struct
+{
+    double re;
+    double im;
+} volk_gnsssdr_chirp_complex_t;
+
+typedef struct
+{
+    volk_gnsssdr_chirp_complex_t phase;    // phase(m0)
+    volk_gnsssdr_chirp_complex_t s;        // phase_inc_rate^(2 * (m0 - 1))
+    volk_gnsssdr_chirp_complex_t t;        // phase_inc_rate^(2 * period * (m0 - 1))
+    volk_gnsssdr_chirp_complex_t a;        // phase_inc^period * phase_inc_rate^(period^2)
+    volk_gnsssdr_chirp_complex_t b;        // phase_inc_rate^(2 * period)
+    volk_gnsssdr_chirp_complex_t c;        // phase_inc_rate^(2 * period^2)
+    volk_gnsssdr_chirp_complex_t j;        // phase_inc^num_lanes * phase_inc_rate^(num_lanes^2)
+    volk_gnsssdr_chirp_complex_t w[64];    // phase_inc^k * phase_inc_rate^(k^2)
+    volk_gnsssdr_chirp_complex_t v[64];    // phase_inc_rate^(2 * num_lanes * k)
+    lv_32fc_t dz_rate;                     // phase_inc_rate^(2 * num_lanes^2)
+    unsigned int num_lanes;
+} volk_gnsssdr_chirp_t;
+
+static inline volk_gnsssdr_chirp_complex_t volk_gnsssdr_chirp_mul(volk_gnsssdr_chirp_complex_t x, volk_gnsssdr_chirp_complex_t y)
+{
+    volk_gnsssdr_chirp_complex_t z;
+    z.re = x.re * y.re - x.im * y.im;
+    z.im = x.re * y.im + x.im * y.re;
+    return z;
+}
+
+static inline volk_gnsssdr_chirp_complex_t volk_gnsssdr_chirp_pow(volk_gnsssdr_chirp_complex_t x, unsigned long n)
+{
+    volk_gnsssdr_chirp_complex_t y = {1.0, 0.0};
+    while (n)
+        {
+            if (n & 1UL)
+                {
+                    y = volk_gnsssdr_chirp_mul(y, x);
+                }
+            x = volk_gnsssdr_chirp_mul(x, x);
+            n >>= 1;
+        }
+    return y;
+}
+
+static inline volk_gnsssdr_chirp_complex_t volk_gnsssdr_chirp_unit(lv_32fc_t x)
+{
+    volk_gnsssdr_chirp_complex_t y;
+    const double mag = sqrt((double)lv_creal(x) * (double)lv_creal(x) + (double)lv_cimag(x) * (double)lv_cimag(x));
+    y.re = (double)lv_creal(x) / mag;
+    y.im = (double)lv_cimag(x) / mag;
+    return y;
+}
+
+static inline lv_32fc_t volk_gnsssdr_chirp_to_32fc(volk_gnsssdr_chirp_complex_t x)
+{
+    return lv_cmake((float)x.re, (float)x.im);
+}
+
+/*
+ * Sets up the lane generation for num_lanes lanes (at most 64) starting at
+ * sample m0 = 0, and with a regeneration period of period samples.
+ */
+static inline void volk_gnsssdr_chirp_init(volk_gnsssdr_chirp_t* chirp, lv_32fc_t phase, lv_32fc_t phase_inc, lv_32fc_t phase_inc_rate, unsigned int num_lanes, unsigned int period)
+{
+    const volk_gnsssdr_chirp_complex_t inc = volk_gnsssdr_chirp_unit(phase_inc);
+    const volk_gnsssdr_chirp_complex_t rate = volk_gnsssdr_chirp_unit(phase_inc_rate);
+    const volk_gnsssdr_chirp_complex_t rate_conj = {rate.re, -rate.im};
+    volk_gnsssdr_chirp_complex_t rate_2l;
+    unsigned int k;
+
+    chirp->num_lanes = num_lanes;
+    // phase(0) as given by the formula, phase_inc_rate times the actual phase(0)
+    chirp->phase = volk_gnsssdr_chirp_mul(volk_gnsssdr_chirp_unit(phase), rate);
+    chirp->s = volk_gnsssdr_chirp_mul(rate_conj, rate_conj);
+    chirp->t = volk_gnsssdr_chirp_pow(rate_conj, 2UL * period);
+    chirp->a = volk_gnsssdr_chirp_mul(volk_gnsssdr_chirp_pow(inc, period), volk_gnsssdr_chirp_pow(rate, (unsigned long)period * period));
+    chirp->b = volk_gnsssdr_chirp_pow(rate, 2UL * period);
+    chirp->c = volk_gnsssdr_chirp_pow(rate, 2UL * period * period);
+    chirp->j = volk_gnsssdr_chirp_mul(volk_gnsssdr_chirp_pow(inc, num_lanes), volk_gnsssdr_chirp_pow(rate, (unsigned long)num_lanes * num_lanes));
+    rate_2l = volk_gnsssdr_chirp_pow(rate, 2UL * num_lanes);
+    chirp->v[0].re = 1.0;
+    chirp->v[0].im = 0.0;
+    for (k = 1; k < num_lanes; k++)
+        {
+            chirp->v[k] = volk_gnsssdr_chirp_mul(chirp->v[k - 1], rate_2l);
+        }
+    for (k = 0; k < num_lanes; k++)
+        {
+            chirp->w[k] = volk_gnsssdr_chirp_mul(volk_gnsssdr_chirp_pow(inc, k), volk_gnsssdr_chirp_pow(rate, (unsigned long)k * k));
+        }
+    chirp->dz_rate = volk_gnsssdr_chirp_to_32fc(volk_gnsssdr_chirp_pow(rate, 2UL * num_lanes * num_lanes));
+}
+
+/*
+ * Writes the rotators z_k = phase(m0 + k) and their increments dz_k = phase(m0 + k + num_lanes) / phase(m0 + k)
+ */
+static inline void volk_gnsssdr_chirp_lanes(const volk_gnsssdr_chirp_t* chirp, lv_32fc_t* z, lv_32fc_t* dz)
+{
+    volk_gnsssdr_chirp_complex_t s_k = {1.0, 0.0};
+    volk_gnsssdr_chirp_complex_t j_s_l;
+    unsigned int k;
+    for (k = 0; k < chirp->num_lanes; k++)
+        {
+            z[k] = volk_gnsssdr_chirp_to_32fc(volk_gnsssdr_chirp_mul(volk_gnsssdr_chirp_mul(chirp->phase, chirp->w[k]), s_k));
+            s_k = volk_gnsssdr_chirp_mul(s_k, chirp->s);
+        }
+    j_s_l = volk_gnsssdr_chirp_mul(chirp->j, s_k);
+    for (k = 0; k < chirp->num_lanes; k++)
+        {
+            dz[k] = volk_gnsssdr_chirp_to_32fc(volk_gnsssdr_chirp_mul(j_s_l, chirp->v[k]));
+        }
+}
+
+/*
+ * Moves m0 one period forward
+ */
+static inline void volk_gnsssdr_chirp_advance(volk_gnsssdr_chirp_t* chirp)
+{
+    chirp->phase = volk_gnsssdr_chirp_mul(volk_gnsssdr_chirp_mul(chirp->phase, chirp->a), chirp->t);
+    chirp->s = volk_gnsssdr_chirp_mul(chirp->s, chirp->b);
+    chirp->t = volk_gnsssdr_chirp_mul(chirp->t, chirp->c);
+}
+
 
 #ifdef LV_HAVE_GENERIC
 
@@ -148,4 +281,373 @@ static inline void volk_gnsssdr_32fc_32f_high_dynamic_rotator_dot_prod_32fc_xn_g
 }
 #endif
 
+
+#ifdef LV_HAVE_AVX512F
+#include <volk_gnsssdr/volk_gnsssdr_avx512_intrinsics.h>
+#include <immintrin.h>
+static inline void volk_gnsssdr_32fc_32f_high_dynamic_rotator_dot_prod_32fc_xn_u_avx512f(lv_32fc_t* result, const lv_32fc_t* in_common, const lv_32fc_t phase_inc, const lv_32fc_t phase_inc_rate, lv_32fc_t* phase, const float** in_a, int num_a_vectors, unsigned int num_points)
+{
+    const unsigned int ROTATOR_RELOAD = 256;
+    unsigned int number = 0;
+    unsigned int block = 0;
+    int vec_ind = 0;
+    unsigned int i = 0;
+
+    lv_32fc_t _phase = (*phase);
+    lv_32fc_t wo;
+#ifdef __cplusplus
+    _phase /= std::abs(_phase);
+#else
+    _phase /= hypotf(lv_creal(_phase), lv_cimag(_phase));
+#endif
+
+    __m512 a0Val, a1Val, xVal;
+    __m512* dotProdVal = (__m512*)volk_gnsssdr_malloc(2 * num_a_vectors * sizeof(__m512), volk_gnsssdr_get_alignment());
+
+    for (vec_ind = 0; vec_ind < 2 * num_a_vectors; vec_ind++)
+        {
+            dotProdVal[vec_ind] = _mm512_setzero_ps();
+        }
+
+    // Set up the complex rotators of sixteen consecutive samples
+    volk_gnsssdr_chirp_t chirp;
+    volk_gnsssdr_chirp_init(&chirp, _phase, phase_inc, phase_inc_rate, 16, ROTATOR_RELOAD);
+
+    __m512 z0, z1, dz0, dz1;
+    __VOLK_ATTR_ALIGNED(64)
+    lv_32fc_t phase_vec[16];
+    __VOLK_ATTR_ALIGNED(64)
+    lv_32fc_t dz_vec[16];
+    volk_gnsssdr_chirp_lanes(&chirp, phase_vec, dz_vec);
+    z0 = _mm512_load_ps((float*)phase_vec);
+    z1 = _mm512_load_ps((float*)(phase_vec + 8));
+    dz0 = _mm512_load_ps((float*)dz_vec);
+    dz1 = _mm512_load_ps((float*)(dz_vec + 8));
+
+    // The first sample is rotated by the initial phase
+    phase_vec[0] = _phase;
+    const __m512 z0_first = _mm512_load_ps((float*)phase_vec);
+
+    for (i = 0; i < 8; ++i)
+        {
+            dz_vec[i] = chirp.dz_rate;
+        }
+    const __m512 dz_rate_reg = _mm512_load_ps((float*)dz_vec);
+
+    for (; number + 16 <= num_points; number += 16)
+        {
+            if (block == ROTATOR_RELOAD / 16)
+                {
+                    // Regenerate the rotators
+                    volk_gnsssdr_chirp_advance(&chirp);
+                    volk_gnsssdr_chirp_lanes(&chirp, phase_vec, dz_vec);
+                    z0 = _mm512_load_ps((float*)phase_vec);
+                    z1 = _mm512_load_ps((float*)(phase_vec + 8));
+                    dz0 = _mm512_load_ps((float*)dz_vec);
+                    dz1 = _mm512_load_ps((float*)(dz_vec + 8));
+                    block = 0;
+                }
+
+            a0Val = _mm512_loadu_ps((const float*)(in_common + number));
+            a1Val = _mm512_loadu_ps((const float*)(in_common + number + 8));
+
+            a0Val = _mm512_complexmul_ps(a0Val, number == 0 ? z0_first : z0);
+            a1Val = _mm512_complexmul_ps(a1Val, z1);
+
+            z0 = _mm512_complexmul_ps(z0, dz0);
+            z1 = _mm512_complexmul_ps(z1, dz1);
+            dz0 = _mm512_complexmul_ps(dz0, dz_rate_reg);
+            dz1 = _mm512_complexmul_ps(dz1, dz_rate_reg);
+
+            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                {
+                    xVal = _mm512_loadu_ps(in_a[vec_ind] + number);  // t0|t1|...|t15
+                    dotProdVal[2 * vec_ind] = _mm512_fmadd_ps(a0Val, _mm512_duplicate_lo_ps(xVal), dotProdVal[2 * vec_ind]);          // t0|t0|...|t7|t7
+                    dotProdVal[2 * vec_ind + 1] = _mm512_fmadd_ps(a1Val, _mm512_duplicate_hi_ps(xVal), dotProdVal[2 * vec_ind + 1]);  // t8|t8|...|t15|t15
+                }
+            block++;
+        }
+    __VOLK_ATTR_ALIGNED(64)
+    lv_32fc_t dotProductVector[8];
+
+    for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+        {
+            _mm512_store_ps((float*)dotProductVector, _mm512_add_ps(dotProdVal[2 * vec_ind], dotProdVal[2 * vec_ind + 1]));  // Store the results back into the dot product vector
+
+            result[vec_ind] = lv_cmake(0.0f, 0.0f);
+            for (i = 0; i < 8; ++i)
+                {
+                    result[vec_ind] += dotProductVector[i];
+                }
+        }
+    volk_gnsssdr_free(dotProdVal);
+
+    // The rotators hold the phases of the remaining samples
+    _mm512_store_ps((float*)phase_vec, z0);
+    _mm512_store_ps((float*)(phase_vec + 8), z1);
+    if (number == 0)
+        {
+            phase_vec[0] = _phase;
+        }
+
+    for (i = 0; number + i < num_points; i++)
+        {
+            wo = in_common[number + i] * phase_vec[i];
+            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                {
+                    result[vec_ind] += wo * in_a[vec_ind][number + i];
+                }
+        }
+
+    *phase = phase_vec[num_points - number];
+}
+
+#endif /* LV_HAVE_AVX512F */
+
+
+#ifdef LV_HAVE_AVX512F
+#include <volk_gnsssdr/volk_gnsssdr_avx512_intrinsics.h>
+#include <immintrin.h>
+static inline void volk_gnsssdr_32fc_32f_high_dynamic_rotator_dot_prod_32fc_xn_a_avx512f(lv_32fc_t* result, const lv_32fc_t* in_common, const lv_32fc_t phase_inc, const lv_32fc_t phase_inc_rate, lv_32fc_t* phase, const float** in_a, int num_a_vectors, unsigned int num_points)
+{
+    const unsigned int ROTATOR_RELOAD = 256;
+    unsigned int number = 0;
+    unsigned int block = 0;
+    int vec_ind = 0;
+    unsigned int i = 0;
+
+    lv_32fc_t _phase = (*phase);
+    lv_32fc_t wo;
+#ifdef __cplusplus
+    _phase /= std::abs(_phase);
+#else
+    _phase /= hypotf(lv_creal(_phase), lv_cimag(_phase));
+#endif
+
+    __m512 a0Val, a1Val, xVal;
+    __m512* dotProdVal = (__m512*)volk_gnsssdr_malloc(2 * num_a_vectors * sizeof(__m512), volk_gnsssdr_get_alignment());
+
+    for (vec_ind = 0; vec_ind < 2 * num_a_vectors; vec_ind++)
+        {
+            dotProdVal[vec_ind] = _mm512_setzero_ps();
+        }
+
+    // Set up the complex rotators of sixteen consecutive samples
+    volk_gnsssdr_chirp_t chirp;
+    volk_gnsssdr_chirp_init(&chirp, _phase, phase_inc, phase_inc_rate, 16, ROTATOR_RELOAD);
+
+    __m512 z0, z1, dz0, dz1;
+    __VOLK_ATTR_ALIGNED(64)
+    lv_32fc_t phase_vec[16];
+    __VOLK_ATTR_ALIGNED(64)
+    lv_32fc_t dz_vec[16];
+    volk_gnsssdr_chirp_lanes(&chirp, phase_vec, dz_vec);
+    z0 = _mm512_load_ps((float*)phase_vec);
+    z1 = _mm512_load_ps((float*)(phase_vec + 8));
+    dz0 = _mm512_load_ps((float*)dz_vec);
+    dz1 = _mm512_load_ps((float*)(dz_vec + 8));
+
+    // The first sample is rotated by the initial phase
+    phase_vec[0] = _phase;
+    const __m512 z0_first = _mm512_load_ps((float*)phase_vec);
+
+    for (i = 0; i < 8; ++i)
+        {
+            dz_vec[i] = chirp.dz_rate;
+        }
+    const __m512 dz_rate_reg = _mm512_load_ps((float*)dz_vec);
+
+    for (; number + 16 <= num_points; number += 16)
+        {
+            if (block == ROTATOR_RELOAD / 16)
+                {
+                    // Regenerate the rotators
+                    volk_gnsssdr_chirp_advance(&chirp);
+                    volk_gnsssdr_chirp_lanes(&chirp, phase_vec, dz_vec);
+                    z0 = _mm512_load_ps((float*)phase_vec);
+                    z1 = _mm512_load_ps((float*)(phase_vec + 8));
+                    dz0 = _mm512_load_ps((float*)dz_vec);
+                    dz1 = _mm512_load_ps((float*)(dz_vec + 8));
+                    block = 0;
+                }
+
+            a0Val = _mm512_load_ps((const float*)(in_common + number));
+            a1Val = _mm512_load_ps((const float*)(in_common + number + 8));
+
+            a0Val = _mm512_complexmul_ps(a0Val, number == 0 ? z0_first : z0);
+            a1Val = _mm512_complexmul_ps(a1Val, z1);
+
+            z0 = _mm512_complexmul_ps(z0, dz0);
+            z1 = _mm512_complexmul_ps(z1, dz1);
+            dz0 = _mm512_complexmul_ps(dz0, dz_rate_reg);
+            dz1 = _mm512_complexmul_ps(dz1, dz_rate_reg);
+
+            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                {
+                    xVal = _mm512_load_ps(in_a[vec_ind] + number);  // t0|t1|...|t15
+                    dotProdVal[2 * vec_ind] = _mm512_fmadd_ps(a0Val, _mm512_duplicate_lo_ps(xVal), dotProdVal[2 * vec_ind]);          // t0|t0|...|t7|t7
+                    dotProdVal[2 * vec_ind + 1] = _mm512_fmadd_ps(a1Val, _mm512_duplicate_hi_ps(xVal), dotProdVal[2 * vec_ind + 1]);  // t8|t8|...|t15|t15
+                }
+            block++;
+        }
+    __VOLK_ATTR_ALIGNED(64)
+    lv_32fc_t dotProductVector[8];
+
+    for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+        {
+            _mm512_store_ps((float*)dotProductVector, _mm512_add_ps(dotProdVal[2 * vec_ind], dotProdVal[2 * vec_ind + 1]));  // Store the results back into the dot product vector
+
+            result[vec_ind] = lv_cmake(0.0f, 0.0f);
+            for (i = 0; i < 8; ++i)
+                {
+                    result[vec_ind] += dotProductVector[i];
+                }
+        }
+    volk_gnsssdr_free(dotProdVal);
+
+    // The rotators hold the phases of the remaining samples
+    _mm512_store_ps((float*)phase_vec, z0);
+    _mm512_store_ps((float*)(phase_vec + 8), z1);
+    if (number == 0)
+        {
+            phase_vec[0] = _phase;
+        }
+
+    for (i = 0; number + i < num_points; i++)
+        {
+            wo = in_common[number + i] * phase_vec[i];
+            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                {
+                    result[vec_ind] += wo * in_a[vec_ind][number + i];
+                }
+        }
+
+    *phase = phase_vec[num_points - number];
+}
+
+#endif /* LV_HAVE_AVX512F */
+
+
+#ifdef LV_HAVE_SVE
+#include <arm_sve.h>
+static inline void volk_gnsssdr_32fc_32f_high_dynamic_rotator_dot_prod_32fc_xn_sve(lv_32fc_t* result, const lv_32fc_t* in_common, const lv_32fc_t phase_inc, const lv_32fc_t phase_inc_rate, lv_32fc_t* phase, const float** in_a, int num_a_vectors, unsigned int num_points)
+{
+    const unsigned int num_lanes = (unsigned int)svcntw();  // complex samples per iteration
+    const unsigned int blocks_per_reload = num_lanes < 256 ? 256 / num_lanes : 1;
+    const svbool_t pg = svptrue_b32();
+    svbool_t first_sample = svwhilelt_b32_u32(0U, 1U);
+    unsigned int number = 0;
+    unsigned int block = 0;
+    unsigned int i;
+    int vec_ind;
+
+    lv_32fc_t _phase = (*phase);
+    lv_32fc_t wo;
+#ifdef __cplusplus
+    _phase /= std::abs(_phase);
+#else
+    _phase /= hypotf(lv_creal(_phase), lv_cimag(_phase));
+#endif
+
+    // SVE registers cannot be stored in arrays, so the accumulators live in memory
+    float* acc = (float*)volk_gnsssdr_malloc(2 * num_a_vectors * num_lanes * sizeof(float), volk_gnsssdr_get_alignment());
+    for (i = 0; i < 2 * num_a_vectors * num_lanes; i++)
+        {
+            acc[i] = 0.0f;
+        }
+
+    // Set up the complex rotators of num_lanes consecutive samples (up to 2048-bit vectors)
+    volk_gnsssdr_chirp_t chirp;
+    volk_gnsssdr_chirp_init(&chirp, _phase, phase_inc, phase_inc_rate, num_lanes, blocks_per_reload * num_lanes);
+
+    lv_32fc_t phase_vec[64];
+    lv_32fc_t dz_vec[64];
+    volk_gnsssdr_chirp_lanes(&chirp, phase_vec, dz_vec);
+    svfloat32x2_t zVal = svld2_f32(pg, (const float*)phase_vec);
+    svfloat32x2_t dzVal = svld2_f32(pg, (const float*)dz_vec);
+    svfloat32_t z_re = svget2_f32(zVal, 0);
+    svfloat32_t z_im = svget2_f32(zVal, 1);
+    svfloat32_t dz_re = svget2_f32(dzVal, 0);
+    svfloat32_t dz_im = svget2_f32(dzVal, 1);
+    const svfloat32_t dz_rate_re = svdup_n_f32(lv_creal(chirp.dz_rate));
+    const svfloat32_t dz_rate_im = svdup_n_f32(lv_cimag(chirp.dz_rate));
+    const svfloat32_t phase_re = svdup_n_f32(lv_creal(_phase));
+    const svfloat32_t phase_im = svdup_n_f32(lv_cimag(_phase));
+
+    for (; number + num_lanes <= num_points; number += num_lanes)
+        {
+            if (block == blocks_per_reload)
+                {
+                    // Regenerate the rotators
+                    volk_gnsssdr_chirp_advance(&chirp);
+                    volk_gnsssdr_chirp_lanes(&chirp, phase_vec, dz_vec);
+                    zVal = svld2_f32(pg, (const float*)phase_vec);
+                    dzVal = svld2_f32(pg, (const float*)dz_vec);
+                    z_re = svget2_f32(zVal, 0);
+                    z_im = svget2_f32(zVal, 1);
+                    dz_re = svget2_f32(dzVal, 0);
+                    dz_im = svget2_f32(dzVal, 1);
+                    block = 0;
+                }
+
+            const svfloat32x2_t aVal = svld2_f32(pg, (const float*)(in_common + number));
+            const svfloat32_t a_re = svget2_f32(aVal, 0);
+            const svfloat32_t a_im = svget2_f32(aVal, 1);
+
+            // The first sample is rotated by the initial phase
+            const svfloat32_t r_re = svsel_f32(first_sample, phase_re, z_re);
+            const svfloat32_t r_im = svsel_f32(first_sample, phase_im, z_im);
+            first_sample = svpfalse_b();
+
+            // b = a * r
+            const svfloat32_t b_re = svmls_f32_x(pg, svmul_f32_x(pg, a_re, r_re), a_im, r_im);
+            const svfloat32_t b_im = svmla_f32_x(pg, svmul_f32_x(pg, a_re, r_im), a_im, r_re);
+
+            // z = z * dz, dz = dz * dz_rate
+            svfloat32_t tmp = svmls_f32_x(pg, svmul_f32_x(pg, z_re, dz_re), z_im, dz_im);
+            z_im = svmla_f32_x(pg, svmul_f32_x(pg, z_re, dz_im), z_im, dz_re);
+            z_re = tmp;
+            tmp = svmls_f32_x(pg, svmul_f32_x(pg, dz_re, dz_rate_re), dz_im, dz_rate_im);
+            dz_im = svmla_f32_x(pg, svmul_f32_x(pg, dz_re, dz_rate_im), dz_im, dz_rate_re);
+            dz_re = tmp;
+
+            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                {
+                    const svfloat32_t tVal = svld1_f32(pg, in_a[vec_ind] + number);
+                    float* acc_re = acc + 2 * vec_ind * num_lanes;
+                    float* acc_im = acc_re + num_lanes;
+                    svst1_f32(pg, acc_re, svmla_f32_x(pg, svld1_f32(pg, acc_re), b_re, tVal));
+                    svst1_f32(pg, acc_im, svmla_f32_x(pg, svld1_f32(pg, acc_im), b_im, tVal));
+                }
+            block++;
+        }
+
+    for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+        {
+            const float* acc_re = acc + 2 * vec_ind * num_lanes;
+            result[vec_ind] = lv_cmake(svaddv_f32(pg, svld1_f32(pg, acc_re)), svaddv_f32(pg, svld1_f32(pg, acc_re + num_lanes)));
+        }
+    volk_gnsssdr_free(acc);
+
+    // The rotators hold the phases of the remaining samples
+    svst2_f32(pg, (float*)phase_vec, svcreate2_f32(z_re, z_im));
+    if (number == 0)
+        {
+            phase_vec[0] = _phase;
+        }
+
+    for (i = 0; number + i < num_points; i++)
+        {
+            wo = in_common[number + i] * phase_vec[i];
+            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                {
+                    result[vec_ind] += wo * in_a[vec_ind][number + i];
+                }
+        }
+
+    *phase = phase_vec[num_points - number];
+}
+
+#endif /* LV_HAVE_SVE */
+
 #endif /* INCLUDED_volk_gnsssdr_32fc_32f_high_dynamic_rotator_dot_prod_32fc_xn_H */
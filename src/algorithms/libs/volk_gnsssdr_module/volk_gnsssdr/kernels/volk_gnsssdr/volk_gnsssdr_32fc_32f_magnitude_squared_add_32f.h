@@ -0,0 +1,266 @@
+/*!
+ * \file volk_gnsssdr_32fc_32f_magnitude_squared_add_32f.h
+ * \brief VOLK_GNSSSDR kernel: adds the magnitude squared of a 32 bits float
+ * complex vector to a 32 bits float vector.
+ *
+ * VOLK_GNSSSDR kernel that computes, in a single pass,
+ * result[i] = accumulator[i] + real(complexVector[i])^2 + imag(complexVector[i])^2
+ * It is intended for non-coherent integration of correlation results.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_32fc_32f_magnitude_squared_add_32f
+ *
+ * \b Overview
+ *
+ * Adds the magnitude squared of the complex data items in \p complexVector to
+ * the real values in \p accumulator, and stores the results in \p result.
+ * \p result and \p accumulator can point to the same buffer.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_32fc_32f_magnitude_squared_add_32f(float* result, const lv_32fc_t* complexVector, const float* accumulator, unsigned int num_points);
+ * \endcode
+ *
+ * \b Inputs
+ * \li complexVector: The vector containing the complex input values.
+ * \li accumulator:   The vector containing the real values to be added.
+ * \li num_points:    The number of data points.
+ *
+ * \b Outputs
+ * \li result: The vector containing the real output values.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_32fc_32f_magnitude_squared_add_32f_H
+#define INCLUDED_volk_gnsssdr_32fc_32f_magnitude_squared_add_32f_H
+
+#include <volk_gnsssdr/volk_gnsssdr_common.h>
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_32fc_32f_magnitude_squared_add_32f_generic(float* result, const lv_32fc_t* complexVector, const float* accumulator, unsigned int num_points)
+{
+    const float* complexVectorPtr = (const float*)complexVector;
+    unsigned int number;
+    for (number = 0; number < num_points; number++)
+        {
+            const float real = *complexVectorPtr++;
+            const float imag = *complexVectorPtr++;
+            result[number] = accumulator[number] + ((real * real) + (imag * imag));
+        }
+}
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE3
+#include <pmmintrin.h>
+
+static inline void volk_gnsssdr_32fc_32f_magnitude_squared_add_32f_u_sse3(float* result, const lv_32fc_t* complexVector, const float* accumulator, unsigned int num_points)
+{
+    const unsigned int sse_iters = num_points / 4;
+    unsigned int number;
+    const float* complexVectorPtr = (const float*)complexVector;
+    const float* accumulatorPtr = accumulator;
+    float* resultPtr = result;
+
+    __m128 cplxValue1, cplxValue2, accValue, magnitude;
+
+    for (number = 0; number < sse_iters; number++)
+        {
+            cplxValue1 = _mm_loadu_ps(complexVectorPtr);
+            cplxValue2 = _mm_loadu_ps(complexVectorPtr + 4);
+            complexVectorPtr += 8;
+
+            cplxValue1 = _mm_mul_ps(cplxValue1, cplxValue1);
+            cplxValue2 = _mm_mul_ps(cplxValue2, cplxValue2);
+            magnitude = _mm_hadd_ps(cplxValue1, cplxValue2);
+
+            accValue = _mm_loadu_ps(accumulatorPtr);
+            accumulatorPtr += 4;
+            _mm_storeu_ps(resultPtr, _mm_add_ps(accValue, magnitude));
+            resultPtr += 4;
+        }
+
+    for (number = sse_iters * 4; number < num_points; number++)
+        {
+            const float real = *complexVectorPtr++;
+            const float imag = *complexVectorPtr++;
+            *resultPtr++ = (*accumulatorPtr++) + ((real * real) + (imag * imag));
+        }
+}
+#endif /* LV_HAVE_SSE3 */
+
+
+#ifdef LV_HAVE_SSE3
+#include <pmmintrin.h>
+
+static inline void volk_gnsssdr_32fc_32f_magnitude_squared_add_32f_a_sse3(float* result, const lv_32fc_t* complexVector, const float* accumulator, unsigned int num_points)
+{
+    const unsigned int sse_iters = num_points / 4;
+    unsigned int number;
+    const float* complexVectorPtr = (const float*)complexVector;
+    const float* accumulatorPtr = accumulator;
+    float* resultPtr = result;
+
+    __m128 cplxValue1, cplxValue2, accValue, magnitude;
+
+    for (number = 0; number < sse_iters; number++)
+        {
+            cplxValue1 = _mm_load_ps(complexVectorPtr);
+            cplxValue2 = _mm_load_ps(complexVectorPtr + 4);
+            complexVectorPtr += 8;
+
+            cplxValue1 = _mm_mul_ps(cplxValue1, cplxValue1);
+            cplxValue2 = _mm_mul_ps(cplxValue2, cplxValue2);
+            magnitude = _mm_hadd_ps(cplxValue1, cplxValue2);
+
+            accValue = _mm_load_ps(accumulatorPtr);
+            accumulatorPtr += 4;
+            _mm_store_ps(resultPtr, _mm_add_ps(accValue, magnitude));
+            resultPtr += 4;
+        }
+
+    for (number = sse_iters * 4; number < num_points; number++)
+        {
+            const float real = *complexVectorPtr++;
+            const float imag = *complexVectorPtr++;
+            *resultPtr++ = (*accumulatorPtr++) + ((real * real) + (imag * imag));
+        }
+}
+#endif /* LV_HAVE_SSE3 */
+
+
+#ifdef LV_HAVE_AVX
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_32fc_32f_magnitude_squared_add_32f_u_avx(float* result, const lv_32fc_t* complexVector, const float* accumulator, unsigned int num_points)
+{
+    const unsigned int avx_iters = num_points / 8;
+    unsigned int number;
+    const float* complexVectorPtr = (const float*)complexVector;
+    const float* accumulatorPtr = accumulator;
+    float* resultPtr = result;
+
+    __m256 cplxValue1, cplxValue2, complex1, complex2, accValue, magnitude;
+
+    for (number = 0; number < avx_iters; number++)
+        {
+            cplxValue1 = _mm256_loadu_ps(complexVectorPtr);
+            cplxValue2 = _mm256_loadu_ps(complexVectorPtr + 8);
+            complexVectorPtr += 16;
+
+            // Reorder the 128-bit lanes so that the horizontal add keeps the sample order
+            complex1 = _mm256_permute2f128_ps(cplxValue1, cplxValue2, 0x20);
+            complex2 = _mm256_permute2f128_ps(cplxValue1, cplxValue2, 0x31);
+            complex1 = _mm256_mul_ps(complex1, complex1);
+            complex2 = _mm256_mul_ps(complex2, complex2);
+            magnitude = _mm256_hadd_ps(complex1, complex2);
+
+            accValue = _mm256_loadu_ps(accumulatorPtr);
+            accumulatorPtr += 8;
+            _mm256_storeu_ps(resultPtr, _mm256_add_ps(accValue, magnitude));
+            resultPtr += 8;
+        }
+
+    for (number = avx_iters * 8; number < num_points; number++)
+        {
+            const float real = *complexVectorPtr++;
+            const float imag = *complexVectorPtr++;
+            *resultPtr++ = (*accumulatorPtr++) + ((real * real) + (imag * imag));
+        }
+}
+#endif /* LV_HAVE_AVX */
+
+
+#ifdef LV_HAVE_AVX
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_32fc_32f_magnitude_squared_add_32f_a_avx(float* result, const lv_32fc_t* complexVector, const float* accumulator, unsigned int num_points)
+{
+    const unsigned int avx_iters = num_points / 8;
+    unsigned int number;
+    const float* complexVectorPtr = (const float*)complexVector;
+    const float* accumulatorPtr = accumulator;
+    float* resultPtr = result;
+
+    __m256 cplxValue1, cplxValue2, complex1, complex2, accValue, magnitude;
+
+    for (number = 0; number < avx_iters; number++)
+        {
+            cplxValue1 = _mm256_load_ps(complexVectorPtr);
+            cplxValue2 = _mm256_load_ps(complexVectorPtr + 8);
+            complexVectorPtr += 16;
+
+            // Reorder the 128-bit lanes so that the horizontal add keeps the sample order
+            complex1 = _mm256_permute2f128_ps(cplxValue1, cplxValue2, 0x20);
+            complex2 = _mm256_permute2f128_ps(cplxValue1, cplxValue2, 0x31);
+            complex1 = _mm256_mul_ps(complex1, complex1);
+            complex2 = _mm256_mul_ps(complex2, complex2);
+            magnitude = _mm256_hadd_ps(complex1, complex2);
+
+            accValue = _mm256_load_ps(accumulatorPtr);
+            accumulatorPtr += 8;
+            _mm256_store_ps(resultPtr, _mm256_add_ps(accValue, magnitude));
+            resultPtr += 8;
+        }
+
+    for (number = avx_iters * 8; number < num_points; number++)
+        {
+            const float real = *complexVectorPtr++;
+            const float imag = *complexVectorPtr++;
+            *resultPtr++ = (*accumulatorPtr++) + ((real * real) + (imag * imag));
+        }
+}
+#endif /* LV_HAVE_AVX */
+
+
+#ifdef LV_HAVE_NEON
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_32fc_32f_magnitude_squared_add_32f_neon(float* result, const lv_32fc_t* complexVector, const float* accumulator, unsigned int num_points)
+{
+    const unsigned int neon_iters = num_points / 4;
+    unsigned int number;
+    const float* complexVectorPtr = (const float*)complexVector;
+    const float* accumulatorPtr = accumulator;
+    float* resultPtr = result;
+
+    float32x4x2_t cplxValue;
+    float32x4_t accValue;
+
+    for (number = 0; number < neon_iters; number++)
+        {
+            cplxValue = vld2q_f32((const float32_t*)complexVectorPtr);  // deinterleave real and imaginary parts
+            __VOLK_GNSSSDR_PREFETCH(complexVectorPtr + 16);
+            complexVectorPtr += 8;
+            accValue = vld1q_f32((const float32_t*)accumulatorPtr);
+            accumulatorPtr += 4;
+            accValue = vmlaq_f32(accValue, cplxValue.val[0], cplxValue.val[0]);
+            accValue = vmlaq_f32(accValue, cplxValue.val[1], cplxValue.val[1]);
+            vst1q_f32((float32_t*)resultPtr, accValue);
+            resultPtr += 4;
+        }
+
+    for (number = neon_iters * 4; number < num_points; number++)
+        {
+            const float real = *complexVectorPtr++;
+            const float imag = *complexVectorPtr++;
+            *resultPtr++ = (*accumulatorPtr++) + ((real * real) + (imag * imag));
+        }
+}
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_32fc_32f_magnitude_squared_add_32f_H */
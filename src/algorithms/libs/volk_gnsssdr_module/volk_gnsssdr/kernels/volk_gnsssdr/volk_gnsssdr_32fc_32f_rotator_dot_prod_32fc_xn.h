@@ -483,4 +483,340 @@ static inline void volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn_a_avx(lv_32fc_
 
 #endif /* LV_HAVE_AVX */
 
+
+#ifdef LV_HAVE_AVX512F
+#include <volk_gnsssdr/volk_gnsssdr_avx512_intrinsics.h>
+#include <immintrin.h>
+static inline void volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn_u_avx512f(lv_32fc_t* result, const lv_32fc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const float** in_a, int num_a_vectors, unsigned int num_points)
+{
+    unsigned int number = 0;
+    int vec_ind = 0;
+    unsigned int i = 0;
+    const unsigned int sixteenthPoints = num_points / 16;
+
+    const float* aPtr = (const float*)in_common;
+
+    lv_32fc_t _phase = (*phase);
+    lv_32fc_t wo;
+
+    __m512 a0Val, a1Val, xVal;
+    __m512* dotProdVal = (__m512*)volk_gnsssdr_malloc(2 * num_a_vectors * sizeof(__m512), volk_gnsssdr_get_alignment());
+
+    for (vec_ind = 0; vec_ind < 2 * num_a_vectors; vec_ind++)
+        {
+            dotProdVal[vec_ind] = _mm512_setzero_ps();
+        }
+
+    // Set up the complex rotator
+    __m512 z0, z1;
+    __VOLK_ATTR_ALIGNED(64)
+    lv_32fc_t phase_vec[16];
+    for (i = 0; i < 16; ++i)
+        {
+            phase_vec[i] = _phase;
+            _phase *= phase_inc;
+        }
+
+    z0 = _mm512_load_ps((float*)phase_vec);
+    z1 = _mm512_load_ps((float*)(phase_vec + 8));
+
+    lv_32fc_t dz = phase_inc;
+    dz *= dz;
+    dz *= dz;
+    dz *= dz;
+    dz *= dz;  // dz = phase_inc^16;
+
+    for (i = 0; i < 8; ++i)
+        {
+            phase_vec[i] = dz;
+        }
+
+    __m512 dz_reg = _mm512_load_ps((float*)phase_vec);
+    dz_reg = _mm512_complexnormalise_ps(dz_reg);
+
+    for (; number < sixteenthPoints; number++)
+        {
+            a0Val = _mm512_loadu_ps(aPtr);
+            a1Val = _mm512_loadu_ps(aPtr + 16);
+
+            a0Val = _mm512_complexmul_ps(a0Val, z0);
+            a1Val = _mm512_complexmul_ps(a1Val, z1);
+
+            z0 = _mm512_complexmul_ps(z0, dz_reg);
+            z1 = _mm512_complexmul_ps(z1, dz_reg);
+
+            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                {
+                    xVal = _mm512_loadu_ps(in_a[vec_ind] + 16 * number);  // t0|t1|...|t15
+                    dotProdVal[2 * vec_ind] = _mm512_fmadd_ps(a0Val, _mm512_duplicate_lo_ps(xVal), dotProdVal[2 * vec_ind]);          // t0|t0|...|t7|t7
+                    dotProdVal[2 * vec_ind + 1] = _mm512_fmadd_ps(a1Val, _mm512_duplicate_hi_ps(xVal), dotProdVal[2 * vec_ind + 1]);  // t8|t8|...|t15|t15
+                }
+
+            // Force the rotators back onto the unit circle
+            if ((number % 64) == 0)
+                {
+                    z0 = _mm512_complexnormalise_ps(z0);
+                    z1 = _mm512_complexnormalise_ps(z1);
+                }
+
+            aPtr += 32;
+        }
+    __VOLK_ATTR_ALIGNED(64)
+    lv_32fc_t dotProductVector[8];
+
+    for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+        {
+            _mm512_store_ps((float*)dotProductVector, _mm512_add_ps(dotProdVal[2 * vec_ind], dotProdVal[2 * vec_ind + 1]));  // Store the results back into the dot product vector
+
+            result[vec_ind] = lv_cmake(0.0f, 0.0f);
+            for (i = 0; i < 8; ++i)
+                {
+                    result[vec_ind] += dotProductVector[i];
+                }
+        }
+    volk_gnsssdr_free(dotProdVal);
+
+    z0 = _mm512_complexnormalise_ps(z0);
+    _mm512_store_ps((float*)phase_vec, z0);
+    _phase = phase_vec[0];
+
+    number = sixteenthPoints * 16;
+    for (; number < num_points; number++)
+        {
+            wo = in_common[number] * _phase;
+            _phase *= phase_inc;
+
+            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                {
+                    result[vec_ind] += wo * in_a[vec_ind][number];
+                }
+        }
+
+    *phase = _phase;
+}
+
+#endif /* LV_HAVE_AVX512F */
+
+
+#ifdef LV_HAVE_AVX512F
+#include <volk_gnsssdr/volk_gnsssdr_avx512_intrinsics.h>
+#include <immintrin.h>
+static inline void volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn_a_avx512f(lv_32fc_t* result, const lv_32fc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const float** in_a, int num_a_vectors, unsigned int num_points)
+{
+    unsigned int number = 0;
+    int vec_ind = 0;
+    unsigned int i = 0;
+    const unsigned int sixteenthPoints = num_points / 16;
+
+    const float* aPtr = (const float*)in_common;
+
+    lv_32fc_t _phase = (*phase);
+    lv_32fc_t wo;
+
+    __m512 a0Val, a1Val, xVal;
+    __m512* dotProdVal = (__m512*)volk_gnsssdr_malloc(2 * num_a_vectors * sizeof(__m512), volk_gnsssdr_get_alignment());
+
+    for (vec_ind = 0; vec_ind < 2 * num_a_vectors; vec_ind++)
+        {
+            dotProdVal[vec_ind] = _mm512_setzero_ps();
+        }
+
+    // Set up the complex rotator
+    __m512 z0, z1;
+    __VOLK_ATTR_ALIGNED(64)
+    lv_32fc_t phase_vec[16];
+    for (i = 0; i < 16; ++i)
+        {
+            phase_vec[i] = _phase;
+            _phase *= phase_inc;
+        }
+
+    z0 = _mm512_load_ps((float*)phase_vec);
+    z1 = _mm512_load_ps((float*)(phase_vec + 8));
+
+    lv_32fc_t dz = phase_inc;
+    dz *= dz;
+    dz *= dz;
+    dz *= dz;
+    dz *= dz;  // dz = phase_inc^16;
+
+    for (i = 0; i < 8; ++i)
+        {
+            phase_vec[i] = dz;
+        }
+
+    __m512 dz_reg = _mm512_load_ps((float*)phase_vec);
+    dz_reg = _mm512_complexnormalise_ps(dz_reg);
+
+    for (; number < sixteenthPoints; number++)
+        {
+            a0Val = _mm512_load_ps(aPtr);
+            a1Val = _mm512_load_ps(aPtr + 16);
+
+            a0Val = _mm512_complexmul_ps(a0Val, z0);
+            a1Val = _mm512_complexmul_ps(a1Val, z1);
+
+            z0 = _mm512_complexmul_ps(z0, dz_reg);
+            z1 = _mm512_complexmul_ps(z1, dz_reg);
+
+            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                {
+                    xVal = _mm512_load_ps(in_a[vec_ind] + 16 * number);  // t0|t1|...|t15
+                    dotProdVal[2 * vec_ind] = _mm512_fmadd_ps(a0Val, _mm512_duplicate_lo_ps(xVal), dotProdVal[2 * vec_ind]);          // t0|t0|...|t7|t7
+                    dotProdVal[2 * vec_ind + 1] = _mm512_fmadd_ps(a1Val, _mm512_duplicate_hi_ps(xVal), dotProdVal[2 * vec_ind + 1]);  // t8|t8|...|t15|t15
+                }
+
+            // Force the rotators back onto the unit circle
+            if ((number % 64) == 0)
+                {
+                    z0 = _mm512_complexnormalise_ps(z0);
+                    z1 = _mm512_complexnormalise_ps(z1);
+                }
+
+            aPtr += 32;
+        }
+    __VOLK_ATTR_ALIGNED(64)
+    lv_32fc_t dotProductVector[8];
+
+    for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+        {
+            _mm512_store_ps((float*)dotProductVector, _mm512_add_ps(dotProdVal[2 * vec_ind], dotProdVal[2 * vec_ind + 1]));  // Store the results back into the dot product vector
+
+            result[vec_ind] = lv_cmake(0.0f, 0.0f);
+            for (i = 0; i < 8; ++i)
+                {
+                    result[vec_ind] += dotProductVector[i];
+                }
+        }
+    volk_gnsssdr_free(dotProdVal);
+
+    z0 = _mm512_complexnormalise_ps(z0);
+    _mm512_store_ps((float*)phase_vec, z0);
+    _phase = phase_vec[0];
+
+    number = sixteenthPoints * 16;
+    for (; number < num_points; number++)
+        {
+            wo = in_common[number] * _phase;
+            _phase *= phase_inc;
+
+            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                {
+                    result[vec_ind] += wo * in_a[vec_ind][number];
+                }
+        }
+
+    *phase = _phase;
+}
+
+#endif /* LV_HAVE_AVX512F */
+
+
+#ifdef LV_HAVE_SVE
+#include <arm_sve.h>
+static inline void volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn_sve(lv_32fc_t* result, const lv_32fc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const float** in_a, int num_a_vectors, unsigned int num_points)
+{
+    const unsigned int num_lanes = (unsigned int)svcntw();  // complex samples per iteration
+    const unsigned int sve_iters = num_points / num_lanes;
+    const svbool_t pg = svptrue_b32();
+    unsigned int number;
+    unsigned int i;
+    int vec_ind;
+
+    lv_32fc_t _phase = (*phase);
+    lv_32fc_t wo;
+
+    // SVE registers cannot be stored in arrays, so the accumulators live in memory
+    float* acc = (float*)volk_gnsssdr_malloc(2 * num_a_vectors * num_lanes * sizeof(float), volk_gnsssdr_get_alignment());
+    for (i = 0; i < 2 * num_a_vectors * num_lanes; i++)
+        {
+            acc[i] = 0.0f;
+        }
+
+    // Set up the complex rotator, split into real and imaginary parts (up to 2048-bit vectors)
+    float phase_re[64];
+    float phase_im[64];
+    lv_32fc_t dz = lv_cmake(1.0f, 0.0f);
+    for (i = 0; i < num_lanes; ++i)
+        {
+            phase_re[i] = lv_creal(_phase);
+            phase_im[i] = lv_cimag(_phase);
+            _phase *= phase_inc;
+            dz *= phase_inc;  // dz = phase_inc^num_lanes
+        }
+#ifdef __cplusplus
+    dz /= std::abs(dz);
+#else
+    dz /= hypotf(lv_creal(dz), lv_cimag(dz));
+#endif
+    svfloat32_t z_re = svld1_f32(pg, phase_re);
+    svfloat32_t z_im = svld1_f32(pg, phase_im);
+    const svfloat32_t dz_re = svdup_n_f32(lv_creal(dz));
+    const svfloat32_t dz_im = svdup_n_f32(lv_cimag(dz));
+
+    for (number = 0; number < sve_iters; number++)
+        {
+            const svfloat32x2_t aVal = svld2_f32(pg, (const float*)(in_common + number * num_lanes));
+            const svfloat32_t a_re = svget2_f32(aVal, 0);
+            const svfloat32_t a_im = svget2_f32(aVal, 1);
+
+            // b = a * z
+            const svfloat32_t b_re = svmls_f32_x(pg, svmul_f32_x(pg, a_re, z_re), a_im, z_im);
+            const svfloat32_t b_im = svmla_f32_x(pg, svmul_f32_x(pg, a_re, z_im), a_im, z_re);
+
+            // z = z * dz
+            const svfloat32_t z_tmp = svmls_f32_x(pg, svmul_f32_x(pg, z_re, dz_re), z_im, dz_im);
+            z_im = svmla_f32_x(pg, svmul_f32_x(pg, z_re, dz_im), z_im, dz_re);
+            z_re = z_tmp;
+
+            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                {
+                    const svfloat32_t tVal = svld1_f32(pg, in_a[vec_ind] + number * num_lanes);
+                    float* acc_re = acc + 2 * vec_ind * num_lanes;
+                    float* acc_im = acc_re + num_lanes;
+                    svst1_f32(pg, acc_re, svmla_f32_x(pg, svld1_f32(pg, acc_re), b_re, tVal));
+                    svst1_f32(pg, acc_im, svmla_f32_x(pg, svld1_f32(pg, acc_im), b_im, tVal));
+                }
+
+            // Force the rotators back onto the unit circle
+            if ((number % 64) == 0)
+                {
+                    const svfloat32_t mag = svsqrt_f32_x(pg, svmla_f32_x(pg, svmul_f32_x(pg, z_re, z_re), z_im, z_im));
+                    z_re = svdiv_f32_x(pg, z_re, mag);
+                    z_im = svdiv_f32_x(pg, z_im, mag);
+                }
+        }
+
+    for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+        {
+            const float* acc_re = acc + 2 * vec_ind * num_lanes;
+            result[vec_ind] = lv_cmake(svaddv_f32(pg, svld1_f32(pg, acc_re)), svaddv_f32(pg, svld1_f32(pg, acc_re + num_lanes)));
+        }
+    volk_gnsssdr_free(acc);
+
+    svst1_f32(pg, phase_re, z_re);
+    svst1_f32(pg, phase_im, z_im);
+    _phase = lv_cmake(phase_re[0], phase_im[0]);
+#ifdef __cplusplus
+    _phase /= std::abs(_phase);
+#else
+    _phase /= hypotf(lv_creal(_phase), lv_cimag(_phase));
+#endif
+
+    for (number = sve_iters * num_lanes; number < num_points; number++)
+        {
+            wo = in_common[number] * _phase;
+            _phase *= phase_inc;
+
+            for (vec_ind = 0; vec_ind < num_a_vectors; ++vec_ind)
+                {
+                    result[vec_ind] += wo * in_a[vec_ind][number];
+                }
+        }
+
+    *phase = _phase;
+}
+
+#endif /* LV_HAVE_SVE */
+
 #endif /* INCLUDED_volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn_H */
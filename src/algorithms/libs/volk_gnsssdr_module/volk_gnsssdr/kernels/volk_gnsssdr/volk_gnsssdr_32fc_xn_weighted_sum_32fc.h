@@ -0,0 +1,216 @@
+/*!
+ * \file volk_gnsssdr_32fc_xn_weighted_sum_32fc.h
+ * \brief VOLK_GNSSSDR kernel: weighted sum of N 32 bits float complex
+ * vectors.
+ *
+ * VOLK_GNSSSDR kernel that computes, in a single pass,
+ * result[i] = in[0][i] * weights[0] + ... + in[N-1][i] * weights[N-1]
+ * It is intended for the spatial filtering of the signals of an antenna array.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_32fc_xn_weighted_sum_32fc
+ *
+ * \b Overview
+ *
+ * Multiplies each of the \p num_inputs complex vectors in \p in by its complex
+ * weight in \p weights, and stores the sum of the products in \p result.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_32fc_xn_weighted_sum_32fc(lv_32fc_t* result, const lv_32fc_t** in, const lv_32fc_t* weights, int num_inputs, unsigned int num_points);
+ * \endcode
+ *
+ * \b Inputs
+ * \li in:         Pointers to the \p num_inputs input vectors.
+ * \li weights:    The complex weight of each input vector.
+ * \li num_inputs: The number of input vectors.
+ * \li num_points: The number of data points of each vector.
+ *
+ * \b Outputs
+ * \li result: The vector containing the weighted sum.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_32fc_xn_weighted_sum_32fc_H
+#define INCLUDED_volk_gnsssdr_32fc_xn_weighted_sum_32fc_H
+
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <volk_gnsssdr/volk_gnsssdr_common.h>
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
+#include <volk_gnsssdr/volk_gnsssdr_malloc.h>
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_32fc_xn_weighted_sum_32fc_generic(lv_32fc_t* result, const lv_32fc_t** in, const lv_32fc_t* weights, int num_inputs, unsigned int num_points)
+{
+    unsigned int number;
+    int n_vec;
+    for (number = 0; number < num_points; number++)
+        {
+            lv_32fc_t sum = lv_cmake(0.0f, 0.0f);
+            for (n_vec = 0; n_vec < num_inputs; n_vec++)
+                {
+                    sum += in[n_vec][number] * weights[n_vec];
+                }
+            result[number] = sum;
+        }
+}
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE3
+#include <pmmintrin.h>
+
+static inline void volk_gnsssdr_32fc_xn_weighted_sum_32fc_u_sse3(lv_32fc_t* result, const lv_32fc_t** in, const lv_32fc_t* weights, int num_inputs, unsigned int num_points)
+{
+    const unsigned int sse_iters = num_points / 2;
+    unsigned int number;
+    int n_vec;
+    lv_32fc_t sum;
+    __m128 x, acc_real, acc_imag;
+
+    // real and imaginary part of each weight, repeated in all the lanes
+    __m128* weights_real = (__m128*)volk_gnsssdr_malloc(num_inputs * sizeof(__m128), volk_gnsssdr_get_alignment());
+    __m128* weights_imag = (__m128*)volk_gnsssdr_malloc(num_inputs * sizeof(__m128), volk_gnsssdr_get_alignment());
+    for (n_vec = 0; n_vec < num_inputs; n_vec++)
+        {
+            weights_real[n_vec] = _mm_set1_ps(lv_creal(weights[n_vec]));
+            weights_imag[n_vec] = _mm_set1_ps(lv_cimag(weights[n_vec]));
+        }
+
+    for (number = 0; number < sse_iters; number++)
+        {
+            acc_real = _mm_setzero_ps();
+            acc_imag = _mm_setzero_ps();
+            for (n_vec = 0; n_vec < num_inputs; n_vec++)
+                {
+                    x = _mm_loadu_ps((const float*)(in[n_vec] + 2 * number));  // ar,ai,br,bi
+                    acc_real = _mm_add_ps(acc_real, _mm_mul_ps(x, weights_real[n_vec]));
+                    x = _mm_shuffle_ps(x, x, 0xB1);  // ai,ar,bi,br
+                    acc_imag = _mm_add_ps(acc_imag, _mm_mul_ps(x, weights_imag[n_vec]));
+                }
+            // the complex products are linear in the accumulators, so the
+            // subtraction and addition of the cross terms is done only once
+            _mm_storeu_ps((float*)(result + 2 * number), _mm_addsub_ps(acc_real, acc_imag));
+        }
+
+    volk_gnsssdr_free(weights_real);
+    volk_gnsssdr_free(weights_imag);
+
+    for (number = sse_iters * 2; number < num_points; number++)
+        {
+            sum = lv_cmake(0.0f, 0.0f);
+            for (n_vec = 0; n_vec < num_inputs; n_vec++)
+                {
+                    sum += in[n_vec][number] * weights[n_vec];
+                }
+            result[number] = sum;
+        }
+}
+#endif /* LV_HAVE_SSE3 */
+
+
+#ifdef LV_HAVE_AVX
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_32fc_xn_weighted_sum_32fc_u_avx(lv_32fc_t* result, const lv_32fc_t** in, const lv_32fc_t* weights, int num_inputs, unsigned int num_points)
+{
+    const unsigned int avx_iters = num_points / 4;
+    unsigned int number;
+    int n_vec;
+    lv_32fc_t sum;
+    __m256 x, acc_real, acc_imag;
+
+    // real and imaginary part of each weight, repeated in all the lanes
+    __m256* weights_real = (__m256*)volk_gnsssdr_malloc(num_inputs * sizeof(__m256), volk_gnsssdr_get_alignment());
+    __m256* weights_imag = (__m256*)volk_gnsssdr_malloc(num_inputs * sizeof(__m256), volk_gnsssdr_get_alignment());
+    for (n_vec = 0; n_vec < num_inputs; n_vec++)
+        {
+            weights_real[n_vec] = _mm256_set1_ps(lv_creal(weights[n_vec]));
+            weights_imag[n_vec] = _mm256_set1_ps(lv_cimag(weights[n_vec]));
+        }
+
+    for (number = 0; number < avx_iters; number++)
+        {
+            acc_real = _mm256_setzero_ps();
+            acc_imag = _mm256_setzero_ps();
+            for (n_vec = 0; n_vec < num_inputs; n_vec++)
+                {
+                    x = _mm256_loadu_ps((const float*)(in[n_vec] + 4 * number));
+                    acc_real = _mm256_add_ps(acc_real, _mm256_mul_ps(x, weights_real[n_vec]));
+                    x = _mm256_shuffle_ps(x, x, 0xB1);
+                    acc_imag = _mm256_add_ps(acc_imag, _mm256_mul_ps(x, weights_imag[n_vec]));
+                }
+            _mm256_storeu_ps((float*)(result + 4 * number), _mm256_addsub_ps(acc_real, acc_imag));
+        }
+
+    volk_gnsssdr_free(weights_real);
+    volk_gnsssdr_free(weights_imag);
+
+    for (number = avx_iters * 4; number < num_points; number++)
+        {
+            sum = lv_cmake(0.0f, 0.0f);
+            for (n_vec = 0; n_vec < num_inputs; n_vec++)
+                {
+                    sum += in[n_vec][number] * weights[n_vec];
+                }
+            result[number] = sum;
+        }
+}
+#endif /* LV_HAVE_AVX */
+
+
+#ifdef LV_HAVE_NEON
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_32fc_xn_weighted_sum_32fc_neon(lv_32fc_t* result, const lv_32fc_t** in, const lv_32fc_t* weights, int num_inputs, unsigned int num_points)
+{
+    const unsigned int neon_iters = num_points / 4;
+    unsigned int number;
+    int n_vec;
+    lv_32fc_t sum;
+    float32x4x2_t x, acc;
+    float32_t w_real, w_imag;
+
+    for (number = 0; number < neon_iters; number++)
+        {
+            acc.val[0] = vdupq_n_f32(0.0f);
+            acc.val[1] = vdupq_n_f32(0.0f);
+            for (n_vec = 0; n_vec < num_inputs; n_vec++)
+                {
+                    x = vld2q_f32((const float32_t*)(in[n_vec] + 4 * number));  // deinterleave real and imaginary parts
+                    w_real = lv_creal(weights[n_vec]);
+                    w_imag = lv_cimag(weights[n_vec]);
+                    acc.val[0] = vmlaq_n_f32(acc.val[0], x.val[0], w_real);
+                    acc.val[0] = vmlsq_n_f32(acc.val[0], x.val[1], w_imag);
+                    acc.val[1] = vmlaq_n_f32(acc.val[1], x.val[0], w_imag);
+                    acc.val[1] = vmlaq_n_f32(acc.val[1], x.val[1], w_real);
+                }
+            vst2q_f32((float32_t*)(result + 4 * number), acc);
+        }
+
+    for (number = neon_iters * 4; number < num_points; number++)
+        {
+            sum = lv_cmake(0.0f, 0.0f);
+            for (n_vec = 0; n_vec < num_inputs; n_vec++)
+                {
+                    sum += in[n_vec][number] * weights[n_vec];
+                }
+            result[number] = sum;
+        }
+}
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_32fc_xn_weighted_sum_32fc_H */
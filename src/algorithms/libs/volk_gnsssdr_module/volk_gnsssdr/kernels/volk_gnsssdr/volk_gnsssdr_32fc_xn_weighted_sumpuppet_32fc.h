@@ -0,0 +1,102 @@
+/*!
+ * \file volk_gnsssdr_32fc_xn_weighted_sumpuppet_32fc.h
+ * \brief Volk puppet for the weighted sum of N complex vectors kernel.
+ *
+ * Volk puppet for integrating the weighted sum kernel into volk's test system
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_32fc_xn_weighted_sumpuppet_32fc_H
+#define INCLUDED_volk_gnsssdr_32fc_xn_weighted_sumpuppet_32fc_H
+
+#include "volk_gnsssdr/volk_gnsssdr_32fc_xn_weighted_sum_32fc.h"
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <volk_gnsssdr/volk_gnsssdr_malloc.h>
+
+// number of array elements of the test, not a multiple of the SIMD width
+#define VOLK_GNSSSDR_WEIGHTED_SUM_PUPPET_INPUTS 7
+
+
+static inline lv_32fc_t** volk_gnsssdr_32fc_xn_weighted_sumpuppet_32fc_inputs(const lv_32fc_t* in, lv_32fc_t* weights, unsigned int num_points)
+{
+    int n;
+    unsigned int i;
+    lv_32fc_t** in_a = (lv_32fc_t**)volk_gnsssdr_malloc(sizeof(lv_32fc_t*) * VOLK_GNSSSDR_WEIGHTED_SUM_PUPPET_INPUTS, volk_gnsssdr_get_alignment());
+    for (n = 0; n < VOLK_GNSSSDR_WEIGHTED_SUM_PUPPET_INPUTS; n++)
+        {
+            // each element sees the input delayed by n samples
+            in_a[n] = (lv_32fc_t*)volk_gnsssdr_malloc(sizeof(lv_32fc_t) * num_points, volk_gnsssdr_get_alignment());
+            for (i = 0; i < num_points; i++)
+                {
+                    in_a[n][i] = in[(i + (unsigned int)n) % num_points];
+                }
+            weights[n] = lv_cmake(1.0f - 0.25f * (float)n, 0.1f * (float)n - 0.3f);
+        }
+    return in_a;
+}
+
+
+static inline void volk_gnsssdr_32fc_xn_weighted_sumpuppet_32fc_free(lv_32fc_t** in_a)
+{
+    int n;
+    for (n = 0; n < VOLK_GNSSSDR_WEIGHTED_SUM_PUPPET_INPUTS; n++)
+        {
+            volk_gnsssdr_free(in_a[n]);
+        }
+    volk_gnsssdr_free(in_a);
+}
+
+
+#ifdef LV_HAVE_GENERIC
+static inline void volk_gnsssdr_32fc_xn_weighted_sumpuppet_32fc_generic(lv_32fc_t* result, const lv_32fc_t* in, unsigned int num_points)
+{
+    lv_32fc_t weights[VOLK_GNSSSDR_WEIGHTED_SUM_PUPPET_INPUTS];
+    lv_32fc_t** in_a = volk_gnsssdr_32fc_xn_weighted_sumpuppet_32fc_inputs(in, weights, num_points);
+    volk_gnsssdr_32fc_xn_weighted_sum_32fc_generic(result, (const lv_32fc_t**)in_a, weights, VOLK_GNSSSDR_WEIGHTED_SUM_PUPPET_INPUTS, num_points);
+    volk_gnsssdr_32fc_xn_weighted_sumpuppet_32fc_free(in_a);
+}
+#endif  // Generic
+
+
+#ifdef LV_HAVE_SSE3
+static inline void volk_gnsssdr_32fc_xn_weighted_sumpuppet_32fc_u_sse3(lv_32fc_t* result, const lv_32fc_t* in, unsigned int num_points)
+{
+    lv_32fc_t weights[VOLK_GNSSSDR_WEIGHTED_SUM_PUPPET_INPUTS];
+    lv_32fc_t** in_a = volk_gnsssdr_32fc_xn_weighted_sumpuppet_32fc_inputs(in, weights, num_points);
+    volk_gnsssdr_32fc_xn_weighted_sum_32fc_u_sse3(result, (const lv_32fc_t**)in_a, weights, VOLK_GNSSSDR_WEIGHTED_SUM_PUPPET_INPUTS, num_points);
+    volk_gnsssdr_32fc_xn_weighted_sumpuppet_32fc_free(in_a);
+}
+#endif  // SSE3
+
+
+#ifdef LV_HAVE_AVX
+static inline void volk_gnsssdr_32fc_xn_weighted_sumpuppet_32fc_u_avx(lv_32fc_t* result, const lv_32fc_t* in, unsigned int num_points)
+{
+    lv_32fc_t weights[VOLK_GNSSSDR_WEIGHTED_SUM_PUPPET_INPUTS];
+    lv_32fc_t** in_a = volk_gnsssdr_32fc_xn_weighted_sumpuppet_32fc_inputs(in, weights, num_points);
+    volk_gnsssdr_32fc_xn_weighted_sum_32fc_u_avx(result, (const lv_32fc_t**)in_a, weights, VOLK_GNSSSDR_WEIGHTED_SUM_PUPPET_INPUTS, num_points);
+    volk_gnsssdr_32fc_xn_weighted_sumpuppet_32fc_free(in_a);
+}
+#endif  // AVX
+
+
+#ifdef LV_HAVE_NEON
+static inline void volk_gnsssdr_32fc_xn_weighted_sumpuppet_32fc_neon(lv_32fc_t* result, const lv_32fc_t* in, unsigned int num_points)
+{
+    lv_32fc_t weights[VOLK_GNSSSDR_WEIGHTED_SUM_PUPPET_INPUTS];
+    lv_32fc_t** in_a = volk_gnsssdr_32fc_xn_weighted_sumpuppet_32fc_inputs(in, weights, num_points);
+    volk_gnsssdr_32fc_xn_weighted_sum_32fc_neon(result, (const lv_32fc_t**)in_a, weights, VOLK_GNSSSDR_WEIGHTED_SUM_PUPPET_INPUTS, num_points);
+    volk_gnsssdr_32fc_xn_weighted_sumpuppet_32fc_free(in_a);
+}
+#endif  // NEON
+
+#endif  // INCLUDED_volk_gnsssdr_32fc_xn_weighted_sumpuppet_32fc_H
@@ -0,0 +1,152 @@
+/*!
+ * \file volk_gnsssdr_8i_x2_interleave_8ic.h
+ * \brief VOLK_GNSSSDR kernel: interleaves two 8-bit vectors into an 8-bit
+ * complex vector.
+ *
+ * VOLK_GNSSSDR kernel that takes the real parts from one 8-bit vector and
+ * the imaginary parts from another one.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_8i_x2_interleave_8ic
+ *
+ * \b Overview
+ *
+ * Computes cVector[i] = lv_cmake(aVector[i], bVector[i]).
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_8i_x2_interleave_8ic(lv_8sc_t* cVector, const char* aVector, const char* bVector, unsigned int num_points)
+ * \endcode
+ *
+ * \b Inputs
+ * \li aVector: The real parts.
+ * \li bVector: The imaginary parts.
+ * \li num_points: The number of complex data points.
+ *
+ * \b Outputs
+ * \li cVector: The complex 8-bit output vector.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8i_x2_interleave_8ic_H
+#define INCLUDED_volk_gnsssdr_8i_x2_interleave_8ic_H
+
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_8i_x2_interleave_8ic_generic(lv_8sc_t* cVector, const char* aVector, const char* bVector, unsigned int num_points)
+{
+    char* cPtr = (char*)cVector;
+    unsigned int i;
+    for (i = 0; i < num_points; i++)
+        {
+            *cPtr++ = aVector[i];
+            *cPtr++ = bVector[i];
+        }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE2
+#include <emmintrin.h>
+
+static inline void volk_gnsssdr_8i_x2_interleave_8ic_u_sse2(lv_8sc_t* cVector, const char* aVector, const char* bVector, unsigned int num_points)
+{
+    const unsigned int sse_iters = num_points / 16;
+    char* cPtr = (char*)cVector;
+    __m128i a, b;
+    unsigned int i;
+
+    for (i = 0; i < sse_iters; i++)
+        {
+            a = _mm_loadu_si128((const __m128i*)(aVector + 16 * i));
+            b = _mm_loadu_si128((const __m128i*)(bVector + 16 * i));
+            _mm_storeu_si128((__m128i*)cPtr, _mm_unpacklo_epi8(a, b));
+            _mm_storeu_si128((__m128i*)(cPtr + 16), _mm_unpackhi_epi8(a, b));
+            cPtr += 32;
+        }
+
+    for (i = sse_iters * 16; i < num_points; i++)
+        {
+            *cPtr++ = aVector[i];
+            *cPtr++ = bVector[i];
+        }
+}
+
+#endif /* LV_HAVE_SSE2 */
+
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_8i_x2_interleave_8ic_u_avx2(lv_8sc_t* cVector, const char* aVector, const char* bVector, unsigned int num_points)
+{
+    const unsigned int avx2_iters = num_points / 32;
+    char* cPtr = (char*)cVector;
+    __m256i a, b, lo, hi;
+    unsigned int i;
+
+    for (i = 0; i < avx2_iters; i++)
+        {
+            a = _mm256_loadu_si256((const __m256i*)(aVector + 32 * i));
+            b = _mm256_loadu_si256((const __m256i*)(bVector + 32 * i));
+            // the unpacks work within each 128-bit lane, the permutes put the lanes in order
+            lo = _mm256_unpacklo_epi8(a, b);
+            hi = _mm256_unpackhi_epi8(a, b);
+            _mm256_storeu_si256((__m256i*)cPtr, _mm256_permute2x128_si256(lo, hi, 0x20));
+            _mm256_storeu_si256((__m256i*)(cPtr + 32), _mm256_permute2x128_si256(lo, hi, 0x31));
+            cPtr += 64;
+        }
+
+    for (i = avx2_iters * 32; i < num_points; i++)
+        {
+            *cPtr++ = aVector[i];
+            *cPtr++ = bVector[i];
+        }
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEON
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_8i_x2_interleave_8ic_neon(lv_8sc_t* cVector, const char* aVector, const char* bVector, unsigned int num_points)
+{
+    const unsigned int neon_iters = num_points / 16;
+    char* cPtr = (char*)cVector;
+    int8x16x2_t c;
+    unsigned int i;
+
+    for (i = 0; i < neon_iters; i++)
+        {
+            c.val[0] = vld1q_s8((const int8_t*)(aVector + 16 * i));
+            c.val[1] = vld1q_s8((const int8_t*)(bVector + 16 * i));
+            vst2q_s8((int8_t*)cPtr, c);
+            cPtr += 32;
+        }
+
+    for (i = neon_iters * 16; i < num_points; i++)
+        {
+            *cPtr++ = aVector[i];
+            *cPtr++ = bVector[i];
+        }
+}
+
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_8i_x2_interleave_8ic_H */
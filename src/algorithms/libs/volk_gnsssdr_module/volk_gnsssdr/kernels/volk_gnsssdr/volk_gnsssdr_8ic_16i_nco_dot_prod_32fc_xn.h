@@ -0,0 +1,470 @@
+/*!
+ * \file volk_gnsssdr_8ic_16i_nco_dot_prod_32fc_xn.h
+ * \brief VOLK_GNSSSDR kernel: multiplies N 16 bits vectors by a common 8 bits
+ * complex vector, wiped off by an integer NCO, and accumulates the results in
+ * N single-precision complex outputs.
+ *
+ * VOLK_GNSSSDR kernel that multiplies N 16 bits vectors by a common 8 bits
+ * complex vector, which is rotated by the quantized carrier of a 32-bit phase
+ * accumulator, and accumulates the results in N complex outputs.
+ * All the arithmetic is done with integers, so it is suited to the
+ * correlators of receivers with low-bit front ends.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_8ic_16i_nco_dot_prod_32fc_xn
+ *
+ * \b Overview
+ *
+ * Rotates the reference complex vector with the carrier of a numerically
+ * controlled oscillator, multiplies it with an arbitrary number of integer
+ * vectors (typically, local codes of values -1 and +1), accumulates the
+ * results and stores them in the output vector.
+ * The carrier phase is a 32-bit accumulator (2^32 is one cycle), incremented
+ * by \p phase_inc at each sample. The carrier is read from a table of 64
+ * phases with an amplitude of 127, and the products are accumulated in
+ * 32-bit integers, so \p num_points must not exceed 2^16 samples for inputs
+ * of full 8-bit scale (it is virtually unlimited for 1-bit and 2-bit samples).
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_8ic_16i_nco_dot_prod_32fc_xn(lv_32fc_t* result, const lv_8sc_t* in_common, const uint32_t phase_inc, uint32_t* phase, const int16_t** in_a, int num_a_vectors, unsigned int num_points);
+ * \endcode
+ *
+ * \b Inputs
+ * \li in_common:     Pointer to one of the vectors to be rotated, multiplied and accumulated (reference vector).
+ * \li phase_inc:     Phase increment = phase_step_rad / (2 * pi) * 2^32 (modulo 2^32).
+ * \li phase:         Initial phase = initial_phase_rad / (2 * pi) * 2^32 (modulo 2^32).
+ * \li in_a:          Pointer to an array of pointers to multiple vectors to be multiplied and accumulated.
+ * \li num_a_vectors: Number of vectors to be multiplied by the reference vector and accumulated.
+ * \li num_points:    Number of complex values to be multiplied together, accumulated and stored into \p result.
+ *
+ * \b Outputs
+ * \li phase:         Final phase.
+ * \li result:        Vector of \p num_a_vectors components with the multiple vectors of \p in_a multiplied by the rotated \p in_common and accumulated,
+ *                    scaled by the carrier amplitude (127).
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8ic_16i_nco_dot_prod_32fc_xn_H
+#define INCLUDED_volk_gnsssdr_8ic_16i_nco_dot_prod_32fc_xn_H
+
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
+#include <volk_gnsssdr/volk_gnsssdr_malloc.h>
+#include <stdint.h>
+
+
+/*
+ * Carrier of the NCO, as pairs of 16-bit integers, so that the real and
+ * imaginary parts of the product of a sample (re, im) and the carrier are the
+ * dot products of two pairs: re = (re, im) . (cos, -sin) and
+ * im = (re, im) . (sin, cos). Each entry is the carrier at the center of 1/64
+ * of a cycle, and the tables are indexed with the 6 most significant bits of
+ * the phase accumulator.
+ */
+__VOLK_ATTR_ALIGNED(16) static const int16_t volk_gnsssdr_8ic_nco_carrier_re[128] = {
+    127, -6, 126, -19, 123, -31, 120, -43, 115, -54, 109, -65, 102, -76, 94, -85,
+    85, -94, 76, -102, 65, -109, 54, -115, 43, -120, 31, -123, 19, -126, 6, -127,
+    -6, -127, -19, -126, -31, -123, -43, -120, -54, -115, -65, -109, -76, -102, -85, -94,
+    -94, -85, -102, -76, -109, -65, -115, -54, -120, -43, -123, -31, -126, -19, -127, -6,
+    -127, 6, -126, 19, -123, 31, -120, 43, -115, 54, -109, 65, -102, 76, -94, 85,
+    -85, 94, -76, 102, -65, 109, -54, 115, -43, 120, -31, 123, -19, 126, -6, 127,
+    6, 127, 19, 126, 31, 123, 43, 120, 54, 115, 65, 109, 76, 102, 85, 94,
+    94, 85, 102, 76, 109, 65, 115, 54, 120, 43, 123, 31, 126, 19, 127, 6};
+
+__VOLK_ATTR_ALIGNED(16) static const int16_t volk_gnsssdr_8ic_nco_carrier_im[128] = {
+    6, 127, 19, 126, 31, 123, 43, 120, 54, 115, 65, 109, 76, 102, 85, 94,
+    94, 85, 102, 76, 109, 65, 115, 54, 120, 43, 123, 31, 126, 19, 127, 6,
+    127, -6, 126, -19, 123, -31, 120, -43, 115, -54, 109, -65, 102, -76, 94, -85,
+    85, -94, 76, -102, 65, -109, 54, -115, 43, -120, 31, -123, 19, -126, 6, -127,
+    -6, -127, -19, -126, -31, -123, -43, -120, -54, -115, -65, -109, -76, -102, -85, -94,
+    -94, -85, -102, -76, -109, -65, -115, -54, -120, -43, -123, -31, -126, -19, -127, -6,
+    -127, 6, -126, 19, -123, 31, -120, 43, -115, 54, -109, 65, -102, 76, -94, 85,
+    -85, 94, -76, 102, -65, 109, -54, 115, -43, 120, -31, 123, -19, 126, -6, 127};
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_8ic_16i_nco_dot_prod_32fc_xn_generic(lv_32fc_t* result, const lv_8sc_t* in_common, const uint32_t phase_inc, uint32_t* phase, const int16_t** in_a, int num_a_vectors, unsigned int num_points)
+{
+    int32_t* accumulator = (int32_t*)volk_gnsssdr_malloc(2 * num_a_vectors * sizeof(int32_t), volk_gnsssdr_get_alignment());
+    uint32_t ph = *phase;
+    int n_vec;
+    unsigned int n;
+    for (n_vec = 0; n_vec < 2 * num_a_vectors; n_vec++)
+        {
+            accumulator[n_vec] = 0;
+        }
+    for (n = 0; n < num_points; n++)
+        {
+            const int16_t* carrier_re = &volk_gnsssdr_8ic_nco_carrier_re[2 * (ph >> 26)];
+            const int16_t* carrier_im = &volk_gnsssdr_8ic_nco_carrier_im[2 * (ph >> 26)];
+            const int32_t sample_re = (int8_t)lv_creal(in_common[n]);
+            const int32_t sample_im = (int8_t)lv_cimag(in_common[n]);
+            const int32_t re = sample_re * carrier_re[0] + sample_im * carrier_re[1];
+            const int32_t im = sample_re * carrier_im[0] + sample_im * carrier_im[1];
+            ph += phase_inc;
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    accumulator[2 * n_vec] += re * in_a[n_vec][n];
+                    accumulator[2 * n_vec + 1] += im * in_a[n_vec][n];
+                }
+        }
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            result[n_vec] = lv_cmake((float)accumulator[2 * n_vec], (float)accumulator[2 * n_vec + 1]);
+        }
+    *phase = ph;
+    volk_gnsssdr_free(accumulator);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+#ifdef LV_HAVE_SSE4_1
+#include <smmintrin.h>
+
+static inline void volk_gnsssdr_8ic_16i_nco_dot_prod_32fc_xn_u_sse4_1(lv_32fc_t* result, const lv_8sc_t* in_common, const uint32_t phase_inc, uint32_t* phase, const int16_t** in_a, int num_a_vectors, unsigned int num_points)
+{
+    const unsigned int eighth_points = num_points / 8;
+    __m128i* accumulator = (__m128i*)volk_gnsssdr_malloc(2 * num_a_vectors * sizeof(__m128i), volk_gnsssdr_get_alignment());
+    __VOLK_ATTR_ALIGNED(16) int32_t index[8];
+    __VOLK_ATTR_ALIGNED(16) int32_t lanes[4];
+    const int32_t* carrier_re = (const int32_t*)volk_gnsssdr_8ic_nco_carrier_re;
+    const int32_t* carrier_im = (const int32_t*)volk_gnsssdr_8ic_nco_carrier_im;
+    const __m128i phase_inc8 = _mm_set1_epi32((int32_t)(8 * phase_inc));
+    __m128i ph_lo = _mm_set_epi32((int32_t)(*phase + 3 * phase_inc), (int32_t)(*phase + 2 * phase_inc), (int32_t)(*phase + phase_inc), (int32_t)(*phase));
+    __m128i ph_hi = _mm_add_epi32(ph_lo, _mm_set1_epi32((int32_t)(4 * phase_inc)));
+    __m128i samples, samples_lo, samples_hi, re_lo, re_hi, im_lo, im_hi, code;
+    uint32_t ph = *phase;
+    int n_vec;
+    unsigned int n;
+    int k;
+    for (n_vec = 0; n_vec < 2 * num_a_vectors; n_vec++)
+        {
+            accumulator[n_vec] = _mm_setzero_si128();
+        }
+    for (n = 0; n < eighth_points; n++)
+        {
+            // carrier of the 8 samples
+            _mm_store_si128((__m128i*)index, _mm_srli_epi32(ph_lo, 26));
+            _mm_store_si128((__m128i*)&index[4], _mm_srli_epi32(ph_hi, 26));
+            ph_lo = _mm_add_epi32(ph_lo, phase_inc8);
+            ph_hi = _mm_add_epi32(ph_hi, phase_inc8);
+
+            // 8 complex samples, as 16-bit pairs
+            samples = _mm_loadu_si128((const __m128i*)&in_common[8 * n]);
+            samples_lo = _mm_cvtepi8_epi16(samples);
+            samples_hi = _mm_cvtepi8_epi16(_mm_srli_si128(samples, 8));
+            re_lo = _mm_madd_epi16(samples_lo, _mm_set_epi32(carrier_re[index[3]], carrier_re[index[2]], carrier_re[index[1]], carrier_re[index[0]]));
+            re_hi = _mm_madd_epi16(samples_hi, _mm_set_epi32(carrier_re[index[7]], carrier_re[index[6]], carrier_re[index[5]], carrier_re[index[4]]));
+            im_lo = _mm_madd_epi16(samples_lo, _mm_set_epi32(carrier_im[index[3]], carrier_im[index[2]], carrier_im[index[1]], carrier_im[index[0]]));
+            im_hi = _mm_madd_epi16(samples_hi, _mm_set_epi32(carrier_im[index[7]], carrier_im[index[6]], carrier_im[index[5]], carrier_im[index[4]]));
+
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    code = _mm_loadu_si128((const __m128i*)&in_a[n_vec][8 * n]);
+                    const __m128i code_lo = _mm_cvtepi16_epi32(code);
+                    const __m128i code_hi = _mm_cvtepi16_epi32(_mm_srli_si128(code, 8));
+                    accumulator[2 * n_vec] = _mm_add_epi32(accumulator[2 * n_vec], _mm_add_epi32(_mm_mullo_epi32(re_lo, code_lo), _mm_mullo_epi32(re_hi, code_hi)));
+                    accumulator[2 * n_vec + 1] = _mm_add_epi32(accumulator[2 * n_vec + 1], _mm_add_epi32(_mm_mullo_epi32(im_lo, code_lo), _mm_mullo_epi32(im_hi, code_hi)));
+                }
+        }
+    ph += 8 * eighth_points * phase_inc;
+
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            int32_t re = 0;
+            int32_t im = 0;
+            _mm_store_si128((__m128i*)lanes, accumulator[2 * n_vec]);
+            for (k = 0; k < 4; k++)
+                {
+                    re += lanes[k];
+                }
+            _mm_store_si128((__m128i*)lanes, accumulator[2 * n_vec + 1]);
+            for (k = 0; k < 4; k++)
+                {
+                    im += lanes[k];
+                }
+            for (n = 8 * eighth_points; n < num_points; n++)
+                {
+                    // the phase goes on from the last vectorized sample
+                    const uint32_t tail_ph = ph + (n - 8 * eighth_points) * phase_inc;
+                    const int16_t* c_re = &volk_gnsssdr_8ic_nco_carrier_re[2 * (tail_ph >> 26)];
+                    const int16_t* c_im = &volk_gnsssdr_8ic_nco_carrier_im[2 * (tail_ph >> 26)];
+                    const int32_t sample_re = (int8_t)lv_creal(in_common[n]);
+                    const int32_t sample_im = (int8_t)lv_cimag(in_common[n]);
+                    re += (sample_re * c_re[0] + sample_im * c_re[1]) * in_a[n_vec][n];
+                    im += (sample_re * c_im[0] + sample_im * c_im[1]) * in_a[n_vec][n];
+                }
+            result[n_vec] = lv_cmake((float)re, (float)im);
+        }
+    *phase = ph + (num_points - 8 * eighth_points) * phase_inc;
+    volk_gnsssdr_free(accumulator);
+}
+
+#endif /* LV_HAVE_SSE4_1 */
+
+#ifdef LV_HAVE_SSE4_1
+#include <smmintrin.h>
+
+static inline void volk_gnsssdr_8ic_16i_nco_dot_prod_32fc_xn_a_sse4_1(lv_32fc_t* result, const lv_8sc_t* in_common, const uint32_t phase_inc, uint32_t* phase, const int16_t** in_a, int num_a_vectors, unsigned int num_points)
+{
+    const unsigned int eighth_points = num_points / 8;
+    __m128i* accumulator = (__m128i*)volk_gnsssdr_malloc(2 * num_a_vectors * sizeof(__m128i), volk_gnsssdr_get_alignment());
+    __VOLK_ATTR_ALIGNED(16) int32_t index[8];
+    __VOLK_ATTR_ALIGNED(16) int32_t lanes[4];
+    const int32_t* carrier_re = (const int32_t*)volk_gnsssdr_8ic_nco_carrier_re;
+    const int32_t* carrier_im = (const int32_t*)volk_gnsssdr_8ic_nco_carrier_im;
+    const __m128i phase_inc8 = _mm_set1_epi32((int32_t)(8 * phase_inc));
+    __m128i ph_lo = _mm_set_epi32((int32_t)(*phase + 3 * phase_inc), (int32_t)(*phase + 2 * phase_inc), (int32_t)(*phase + phase_inc), (int32_t)(*phase));
+    __m128i ph_hi = _mm_add_epi32(ph_lo, _mm_set1_epi32((int32_t)(4 * phase_inc)));
+    __m128i samples, samples_lo, samples_hi, re_lo, re_hi, im_lo, im_hi, code;
+    uint32_t ph = *phase;
+    int n_vec;
+    unsigned int n;
+    int k;
+    for (n_vec = 0; n_vec < 2 * num_a_vectors; n_vec++)
+        {
+            accumulator[n_vec] = _mm_setzero_si128();
+        }
+    for (n = 0; n < eighth_points; n++)
+        {
+            // carrier of the 8 samples
+            _mm_store_si128((__m128i*)index, _mm_srli_epi32(ph_lo, 26));
+            _mm_store_si128((__m128i*)&index[4], _mm_srli_epi32(ph_hi, 26));
+            ph_lo = _mm_add_epi32(ph_lo, phase_inc8);
+            ph_hi = _mm_add_epi32(ph_hi, phase_inc8);
+
+            // 8 complex samples, as 16-bit pairs
+            samples = _mm_load_si128((const __m128i*)&in_common[8 * n]);
+            samples_lo = _mm_cvtepi8_epi16(samples);
+            samples_hi = _mm_cvtepi8_epi16(_mm_srli_si128(samples, 8));
+            re_lo = _mm_madd_epi16(samples_lo, _mm_set_epi32(carrier_re[index[3]], carrier_re[index[2]], carrier_re[index[1]], carrier_re[index[0]]));
+            re_hi = _mm_madd_epi16(samples_hi, _mm_set_epi32(carrier_re[index[7]], carrier_re[index[6]], carrier_re[index[5]], carrier_re[index[4]]));
+            im_lo = _mm_madd_epi16(samples_lo, _mm_set_epi32(carrier_im[index[3]], carrier_im[index[2]], carrier_im[index[1]], carrier_im[index[0]]));
+            im_hi = _mm_madd_epi16(samples_hi, _mm_set_epi32(carrier_im[index[7]], carrier_im[index[6]], carrier_im[index[5]], carrier_im[index[4]]));
+
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    code = _mm_load_si128((const __m128i*)&in_a[n_vec][8 * n]);
+                    const __m128i code_lo = _mm_cvtepi16_epi32(code);
+                    const __m128i code_hi = _mm_cvtepi16_epi32(_mm_srli_si128(code, 8));
+                    accumulator[2 * n_vec] = _mm_add_epi32(accumulator[2 * n_vec], _mm_add_epi32(_mm_mullo_epi32(re_lo, code_lo), _mm_mullo_epi32(re_hi, code_hi)));
+                    accumulator[2 * n_vec + 1] = _mm_add_epi32(accumulator[2 * n_vec + 1], _mm_add_epi32(_mm_mullo_epi32(im_lo, code_lo), _mm_mullo_epi32(im_hi, code_hi)));
+                }
+        }
+    ph += 8 * eighth_points * phase_inc;
+
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            int32_t re = 0;
+            int32_t im = 0;
+            _mm_store_si128((__m128i*)lanes, accumulator[2 * n_vec]);
+            for (k = 0; k < 4; k++)
+                {
+                    re += lanes[k];
+                }
+            _mm_store_si128((__m128i*)lanes, accumulator[2 * n_vec + 1]);
+            for (k = 0; k < 4; k++)
+                {
+                    im += lanes[k];
+                }
+            for (n = 8 * eighth_points; n < num_points; n++)
+                {
+                    // the phase goes on from the last vectorized sample
+                    const uint32_t tail_ph = ph + (n - 8 * eighth_points) * phase_inc;
+                    const int16_t* c_re = &volk_gnsssdr_8ic_nco_carrier_re[2 * (tail_ph >> 26)];
+                    const int16_t* c_im = &volk_gnsssdr_8ic_nco_carrier_im[2 * (tail_ph >> 26)];
+                    const int32_t sample_re = (int8_t)lv_creal(in_common[n]);
+                    const int32_t sample_im = (int8_t)lv_cimag(in_common[n]);
+                    re += (sample_re * c_re[0] + sample_im * c_re[1]) * in_a[n_vec][n];
+                    im += (sample_re * c_im[0] + sample_im * c_im[1]) * in_a[n_vec][n];
+                }
+            result[n_vec] = lv_cmake((float)re, (float)im);
+        }
+    *phase = ph + (num_points - 8 * eighth_points) * phase_inc;
+    volk_gnsssdr_free(accumulator);
+}
+
+#endif /* LV_HAVE_SSE4_1 */
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_8ic_16i_nco_dot_prod_32fc_xn_u_avx2(lv_32fc_t* result, const lv_8sc_t* in_common, const uint32_t phase_inc, uint32_t* phase, const int16_t** in_a, int num_a_vectors, unsigned int num_points)
+{
+    const unsigned int sixteenth_points = num_points / 16;
+    __m256i* accumulator = (__m256i*)volk_gnsssdr_malloc(2 * num_a_vectors * sizeof(__m256i), volk_gnsssdr_get_alignment());
+    __VOLK_ATTR_ALIGNED(32) int32_t lanes[8];
+    const int* carrier_re = (const int*)volk_gnsssdr_8ic_nco_carrier_re;
+    const int* carrier_im = (const int*)volk_gnsssdr_8ic_nco_carrier_im;
+    const __m256i phase_inc16 = _mm256_set1_epi32((int32_t)(16 * phase_inc));
+    __m256i ph_lo = _mm256_set_epi32((int32_t)(*phase + 7 * phase_inc), (int32_t)(*phase + 6 * phase_inc), (int32_t)(*phase + 5 * phase_inc), (int32_t)(*phase + 4 * phase_inc),
+        (int32_t)(*phase + 3 * phase_inc), (int32_t)(*phase + 2 * phase_inc), (int32_t)(*phase + phase_inc), (int32_t)(*phase));
+    __m256i ph_hi = _mm256_add_epi32(ph_lo, _mm256_set1_epi32((int32_t)(8 * phase_inc)));
+    __m256i samples, samples_lo, samples_hi, index_lo, index_hi, re_lo, re_hi, im_lo, im_hi, code;
+    uint32_t ph = *phase;
+    int n_vec;
+    unsigned int n;
+    int k;
+    for (n_vec = 0; n_vec < 2 * num_a_vectors; n_vec++)
+        {
+            accumulator[n_vec] = _mm256_setzero_si256();
+        }
+    for (n = 0; n < sixteenth_points; n++)
+        {
+            // carrier of the 16 samples
+            index_lo = _mm256_srli_epi32(ph_lo, 26);
+            index_hi = _mm256_srli_epi32(ph_hi, 26);
+            ph_lo = _mm256_add_epi32(ph_lo, phase_inc16);
+            ph_hi = _mm256_add_epi32(ph_hi, phase_inc16);
+
+            // 16 complex samples, as 16-bit pairs
+            samples = _mm256_loadu_si256((const __m256i*)&in_common[16 * n]);
+            samples_lo = _mm256_cvtepi8_epi16(_mm256_castsi256_si128(samples));
+            samples_hi = _mm256_cvtepi8_epi16(_mm256_extracti128_si256(samples, 1));
+            re_lo = _mm256_madd_epi16(samples_lo, _mm256_i32gather_epi32(carrier_re, index_lo, 4));
+            re_hi = _mm256_madd_epi16(samples_hi, _mm256_i32gather_epi32(carrier_re, index_hi, 4));
+            im_lo = _mm256_madd_epi16(samples_lo, _mm256_i32gather_epi32(carrier_im, index_lo, 4));
+            im_hi = _mm256_madd_epi16(samples_hi, _mm256_i32gather_epi32(carrier_im, index_hi, 4));
+
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    code = _mm256_loadu_si256((const __m256i*)&in_a[n_vec][16 * n]);
+                    const __m256i code_lo = _mm256_cvtepi16_epi32(_mm256_castsi256_si128(code));
+                    const __m256i code_hi = _mm256_cvtepi16_epi32(_mm256_extracti128_si256(code, 1));
+                    accumulator[2 * n_vec] = _mm256_add_epi32(accumulator[2 * n_vec], _mm256_add_epi32(_mm256_mullo_epi32(re_lo, code_lo), _mm256_mullo_epi32(re_hi, code_hi)));
+                    accumulator[2 * n_vec + 1] = _mm256_add_epi32(accumulator[2 * n_vec + 1], _mm256_add_epi32(_mm256_mullo_epi32(im_lo, code_lo), _mm256_mullo_epi32(im_hi, code_hi)));
+                }
+        }
+    ph += 16 * sixteenth_points * phase_inc;
+
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            int32_t re = 0;
+            int32_t im = 0;
+            _mm256_store_si256((__m256i*)lanes, accumulator[2 * n_vec]);
+            for (k = 0; k < 8; k++)
+                {
+                    re += lanes[k];
+                }
+            _mm256_store_si256((__m256i*)lanes, accumulator[2 * n_vec + 1]);
+            for (k = 0; k < 8; k++)
+                {
+                    im += lanes[k];
+                }
+            for (n = 16 * sixteenth_points; n < num_points; n++)
+                {
+                    // the phase goes on from the last vectorized sample
+                    const uint32_t tail_ph = ph + (n - 16 * sixteenth_points) * phase_inc;
+                    const int16_t* c_re = &volk_gnsssdr_8ic_nco_carrier_re[2 * (tail_ph >> 26)];
+                    const int16_t* c_im = &volk_gnsssdr_8ic_nco_carrier_im[2 * (tail_ph >> 26)];
+                    const int32_t sample_re = (int8_t)lv_creal(in_common[n]);
+                    const int32_t sample_im = (int8_t)lv_cimag(in_common[n]);
+                    re += (sample_re * c_re[0] + sample_im * c_re[1]) * in_a[n_vec][n];
+                    im += (sample_re * c_im[0] + sample_im * c_im[1]) * in_a[n_vec][n];
+                }
+            result[n_vec] = lv_cmake((float)re, (float)im);
+        }
+    *phase = ph + (num_points - 16 * sixteenth_points) * phase_inc;
+    volk_gnsssdr_free(accumulator);
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_8ic_16i_nco_dot_prod_32fc_xn_a_avx2(lv_32fc_t* result, const lv_8sc_t* in_common, const uint32_t phase_inc, uint32_t* phase, const int16_t** in_a, int num_a_vectors, unsigned int num_points)
+{
+    const unsigned int sixteenth_points = num_points / 16;
+    __m256i* accumulator = (__m256i*)volk_gnsssdr_malloc(2 * num_a_vectors * sizeof(__m256i), volk_gnsssdr_get_alignment());
+    __VOLK_ATTR_ALIGNED(32) int32_t lanes[8];
+    const int* carrier_re = (const int*)volk_gnsssdr_8ic_nco_carrier_re;
+    const int* carrier_im = (const int*)volk_gnsssdr_8ic_nco_carrier_im;
+    const __m256i phase_inc16 = _mm256_set1_epi32((int32_t)(16 * phase_inc));
+    __m256i ph_lo = _mm256_set_epi32((int32_t)(*phase + 7 * phase_inc), (int32_t)(*phase + 6 * phase_inc), (int32_t)(*phase + 5 * phase_inc), (int32_t)(*phase + 4 * phase_inc),
+        (int32_t)(*phase + 3 * phase_inc), (int32_t)(*phase + 2 * phase_inc), (int32_t)(*phase + phase_inc), (int32_t)(*phase));
+    __m256i ph_hi = _mm256_add_epi32(ph_lo, _mm256_set1_epi32((int32_t)(8 * phase_inc)));
+    __m256i samples, samples_lo, samples_hi, index_lo, index_hi, re_lo, re_hi, im_lo, im_hi, code;
+    uint32_t ph = *phase;
+    int n_vec;
+    unsigned int n;
+    int k;
+    for (n_vec = 0; n_vec < 2 * num_a_vectors; n_vec++)
+        {
+            accumulator[n_vec] = _mm256_setzero_si256();
+        }
+    for (n = 0; n < sixteenth_points; n++)
+        {
+            // carrier of the 16 samples
+            index_lo = _mm256_srli_epi32(ph_lo, 26);
+            index_hi = _mm256_srli_epi32(ph_hi, 26);
+            ph_lo = _mm256_add_epi32(ph_lo, phase_inc16);
+            ph_hi = _mm256_add_epi32(ph_hi, phase_inc16);
+
+            // 16 complex samples, as 16-bit pairs
+            samples = _mm256_load_si256((const __m256i*)&in_common[16 * n]);
+            samples_lo = _mm256_cvtepi8_epi16(_mm256_castsi256_si128(samples));
+            samples_hi = _mm256_cvtepi8_epi16(_mm256_extracti128_si256(samples, 1));
+            re_lo = _mm256_madd_epi16(samples_lo, _mm256_i32gather_epi32(carrier_re, index_lo, 4));
+            re_hi = _mm256_madd_epi16(samples_hi, _mm256_i32gather_epi32(carrier_re, index_hi, 4));
+            im_lo = _mm256_madd_epi16(samples_lo, _mm256_i32gather_epi32(carrier_im, index_lo, 4));
+            im_hi = _mm256_madd_epi16(samples_hi, _mm256_i32gather_epi32(carrier_im, index_hi, 4));
+
+            for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+                {
+                    code = _mm256_load_si256((const __m256i*)&in_a[n_vec][16 * n]);
+                    const __m256i code_lo = _mm256_cvtepi16_epi32(_mm256_castsi256_si128(code));
+                    const __m256i code_hi = _mm256_cvtepi16_epi32(_mm256_extracti128_si256(code, 1));
+                    accumulator[2 * n_vec] = _mm256_add_epi32(accumulator[2 * n_vec], _mm256_add_epi32(_mm256_mullo_epi32(re_lo, code_lo), _mm256_mullo_epi32(re_hi, code_hi)));
+                    accumulator[2 * n_vec + 1] = _mm256_add_epi32(accumulator[2 * n_vec + 1], _mm256_add_epi32(_mm256_mullo_epi32(im_lo, code_lo), _mm256_mullo_epi32(im_hi, code_hi)));
+                }
+        }
+    ph += 16 * sixteenth_points * phase_inc;
+
+    for (n_vec = 0; n_vec < num_a_vectors; n_vec++)
+        {
+            int32_t re = 0;
+            int32_t im = 0;
+            _mm256_store_si256((__m256i*)lanes, accumulator[2 * n_vec]);
+            for (k = 0; k < 8; k++)
+                {
+                    re += lanes[k];
+                }
+            _mm256_store_si256((__m256i*)lanes, accumulator[2 * n_vec + 1]);
+            for (k = 0; k < 8; k++)
+                {
+                    im += lanes[k];
+                }
+            for (n = 16 * sixteenth_points; n < num_points; n++)
+                {
+                    // the phase goes on from the last vectorized sample
+                    const uint32_t tail_ph = ph + (n - 16 * sixteenth_points) * phase_inc;
+                    const int16_t* c_re = &volk_gnsssdr_8ic_nco_carrier_re[2 * (tail_ph >> 26)];
+                    const int16_t* c_im = &volk_gnsssdr_8ic_nco_carrier_im[2 * (tail_ph >> 26)];
+                    const int32_t sample_re = (int8_t)lv_creal(in_common[n]);
+                    const int32_t sample_im = (int8_t)lv_cimag(in_common[n]);
+                    re += (sample_re * c_re[0] + sample_im * c_re[1]) * in_a[n_vec][n];
+                    im += (sample_re * c_im[0] + sample_im * c_im[1]) * in_a[n_vec][n];
+                }
+            result[n_vec] = lv_cmake((float)re, (float)im);
+        }
+    *phase = ph + (num_points - 16 * sixteenth_points) * phase_inc;
+    volk_gnsssdr_free(accumulator);
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+#endif /* INCLUDED_volk_gnsssdr_8ic_16i_nco_dot_prod_32fc_xn_H */
@@ -0,0 +1,180 @@
+/*!
+ * \file volk_gnsssdr_8ic_16i_nco_dotprodxnpuppet_32fc.h
+ * \brief Volk puppet for the multiple 8-bit complex dot product kernel with an integer NCO.
+ *
+ * Volk puppet for integrating the multiple dot product into volk's test system
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8ic_16i_nco_dotprodxnpuppet_32fc_H
+#define INCLUDED_volk_gnsssdr_8ic_16i_nco_dotprodxnpuppet_32fc_H
+
+#include "volk_gnsssdr/volk_gnsssdr_8ic_16i_nco_dot_prod_32fc_xn.h"
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <volk_gnsssdr/volk_gnsssdr_malloc.h>
+
+
+#ifdef LV_HAVE_GENERIC
+static inline void volk_gnsssdr_8ic_16i_nco_dotprodxnpuppet_32fc_generic(lv_32fc_t* result, const lv_8sc_t* local_code, const int16_t* in, unsigned int num_points)
+{
+    uint32_t phase[1] = {0x3876e1c2};
+    const uint32_t phase_inc = 0x0f5c28f6;  // 0.06 cycles per sample
+    int n;
+    unsigned int k;
+    int num_a_vectors = 3;
+    int16_t** in_a = (int16_t**)volk_gnsssdr_malloc(sizeof(int16_t*) * num_a_vectors, volk_gnsssdr_get_alignment());
+    for (n = 0; n < num_a_vectors; n++)
+        {
+            // local codes of values -1 and +1
+            in_a[n] = (int16_t*)volk_gnsssdr_malloc(sizeof(int16_t) * num_points, volk_gnsssdr_get_alignment());
+            for (k = 0; k < num_points; k++)
+                {
+                    in_a[n][k] = (in[(k + n) % num_points] < 0) ? -1 : 1;
+                }
+        }
+
+    volk_gnsssdr_8ic_16i_nco_dot_prod_32fc_xn_generic(result, local_code, phase_inc, phase, (const int16_t**)in_a, num_a_vectors, num_points);
+
+    for (n = 0; n < num_a_vectors; n++)
+        {
+            volk_gnsssdr_free(in_a[n]);
+        }
+    volk_gnsssdr_free(in_a);
+}
+
+#endif  // Generic
+
+
+#ifdef LV_HAVE_SSE4_1
+static inline void volk_gnsssdr_8ic_16i_nco_dotprodxnpuppet_32fc_u_sse4_1(lv_32fc_t* result, const lv_8sc_t* local_code, const int16_t* in, unsigned int num_points)
+{
+    uint32_t phase[1] = {0x3876e1c2};
+    const uint32_t phase_inc = 0x0f5c28f6;  // 0.06 cycles per sample
+    int n;
+    unsigned int k;
+    int num_a_vectors = 3;
+    int16_t** in_a = (int16_t**)volk_gnsssdr_malloc(sizeof(int16_t*) * num_a_vectors, volk_gnsssdr_get_alignment());
+    for (n = 0; n < num_a_vectors; n++)
+        {
+            // local codes of values -1 and +1
+            in_a[n] = (int16_t*)volk_gnsssdr_malloc(sizeof(int16_t) * num_points, volk_gnsssdr_get_alignment());
+            for (k = 0; k < num_points; k++)
+                {
+                    in_a[n][k] = (in[(k + n) % num_points] < 0) ? -1 : 1;
+                }
+        }
+
+    volk_gnsssdr_8ic_16i_nco_dot_prod_32fc_xn_u_sse4_1(result, local_code, phase_inc, phase, (const int16_t**)in_a, num_a_vectors, num_points);
+
+    for (n = 0; n < num_a_vectors; n++)
+        {
+            volk_gnsssdr_free(in_a[n]);
+        }
+    volk_gnsssdr_free(in_a);
+}
+
+#endif  // SSE4_1
+
+
+#ifdef LV_HAVE_SSE4_1
+static inline void volk_gnsssdr_8ic_16i_nco_dotprodxnpuppet_32fc_a_sse4_1(lv_32fc_t* result, const lv_8sc_t* local_code, const int16_t* in, unsigned int num_points)
+{
+    uint32_t phase[1] = {0x3876e1c2};
+    const uint32_t phase_inc = 0x0f5c28f6;  // 0.06 cycles per sample
+    int n;
+    unsigned int k;
+    int num_a_vectors = 3;
+    int16_t** in_a = (int16_t**)volk_gnsssdr_malloc(sizeof(int16_t*) * num_a_vectors, volk_gnsssdr_get_alignment());
+    for (n = 0; n < num_a_vectors; n++)
+        {
+            // local codes of values -1 and +1
+            in_a[n] = (int16_t*)volk_gnsssdr_malloc(sizeof(int16_t) * num_points, volk_gnsssdr_get_alignment());
+            for (k = 0; k < num_points; k++)
+                {
+                    in_a[n][k] = (in[(k + n) % num_points] < 0) ? -1 : 1;
+                }
+        }
+
+    volk_gnsssdr_8ic_16i_nco_dot_prod_32fc_xn_a_sse4_1(result, local_code, phase_inc, phase, (const int16_t**)in_a, num_a_vectors, num_points);
+
+    for (n = 0; n < num_a_vectors; n++)
+        {
+            volk_gnsssdr_free(in_a[n]);
+        }
+    volk_gnsssdr_free(in_a);
+}
+
+#endif  // SSE4_1
+
+
+#ifdef LV_HAVE_AVX2
+static inline void volk_gnsssdr_8ic_16i_nco_dotprodxnpuppet_32fc_u_avx2(lv_32fc_t* result, const lv_8sc_t* local_code, const int16_t* in, unsigned int num_points)
+{
+    uint32_t phase[1] = {0x3876e1c2};
+    const uint32_t phase_inc = 0x0f5c28f6;  // 0.06 cycles per sample
+    int n;
+    unsigned int k;
+    int num_a_vectors = 3;
+    int16_t** in_a = (int16_t**)volk_gnsssdr_malloc(sizeof(int16_t*) * num_a_vectors, volk_gnsssdr_get_alignment());
+    for (n = 0; n < num_a_vectors; n++)
+        {
+            // local codes of values -1 and +1
+            in_a[n] = (int16_t*)volk_gnsssdr_malloc(sizeof(int16_t) * num_points, volk_gnsssdr_get_alignment());
+            for (k = 0; k < num_points; k++)
+                {
+                    in_a[n][k] = (in[(k + n) % num_points] < 0) ? -1 : 1;
+                }
+        }
+
+    volk_gnsssdr_8ic_16i_nco_dot_prod_32fc_xn_u_avx2(result, local_code, phase_inc, phase, (const int16_t**)in_a, num_a_vectors, num_points);
+
+    for (n = 0; n < num_a_vectors; n++)
+        {
+            volk_gnsssdr_free(in_a[n]);
+        }
+    volk_gnsssdr_free(in_a);
+}
+
+#endif  // AVX2
+
+
+#ifdef LV_HAVE_AVX2
+static inline void volk_gnsssdr_8ic_16i_nco_dotprodxnpuppet_32fc_a_avx2(lv_32fc_t* result, const lv_8sc_t* local_code, const int16_t* in, unsigned int num_points)
+{
+    uint32_t phase[1] = {0x3876e1c2};
+    const uint32_t phase_inc = 0x0f5c28f6;  // 0.06 cycles per sample
+    int n;
+    unsigned int k;
+    int num_a_vectors = 3;
+    int16_t** in_a = (int16_t**)volk_gnsssdr_malloc(sizeof(int16_t*) * num_a_vectors, volk_gnsssdr_get_alignment());
+    for (n = 0; n < num_a_vectors; n++)
+        {
+            // local codes of values -1 and +1
+            in_a[n] = (int16_t*)volk_gnsssdr_malloc(sizeof(int16_t) * num_points, volk_gnsssdr_get_alignment());
+            for (k = 0; k < num_points; k++)
+                {
+                    in_a[n][k] = (in[(k + n) % num_points] < 0) ? -1 : 1;
+                }
+        }
+
+    volk_gnsssdr_8ic_16i_nco_dot_prod_32fc_xn_a_avx2(result, local_code, phase_inc, phase, (const int16_t**)in_a, num_a_vectors, num_points);
+
+    for (n = 0; n < num_a_vectors; n++)
+        {
+            volk_gnsssdr_free(in_a[n]);
+        }
+    volk_gnsssdr_free(in_a);
+}
+
+#endif  // AVX2
+
+#endif  // INCLUDED_volk_gnsssdr_8ic_16i_nco_dotprodxnpuppet_32fc_H
@@ -0,0 +1,148 @@
+/*!
+ * \file volk_gnsssdr_8ic_convert_16ic.h
+ * \brief VOLK_GNSSSDR kernel: converts 8-bit complex samples to 16-bit
+ * complex samples.
+ *
+ * VOLK_GNSSSDR kernel that sign extends the real and imaginary parts of a
+ * vector of 8-bit complex samples to 16 bits, without scaling them.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_8ic_convert_16ic
+ *
+ * \b Overview
+ *
+ * Converts a complex 8-bit vector to a complex 16-bit vector with the same
+ * values.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_8ic_convert_16ic(lv_16sc_t* outputVector, const lv_8sc_t* inputVector, unsigned int num_points)
+ * \endcode
+ *
+ * \b Inputs
+ * \li inputVector: The complex 8-bit input data buffer.
+ * \li num_points: The number of complex data values to be converted.
+ *
+ * \b Outputs
+ * \li outputVector: The complex 16-bit output data buffer.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8ic_convert_16ic_H
+#define INCLUDED_volk_gnsssdr_8ic_convert_16ic_H
+
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_8ic_convert_16ic_generic(lv_16sc_t* outputVector, const lv_8sc_t* inputVector, unsigned int num_points)
+{
+    const int8_t* inputVectorPtr = (const int8_t*)inputVector;
+    int16_t* outputVectorPtr = (int16_t*)outputVector;
+    unsigned int i;
+    for (i = 0; i < 2 * num_points; i++)
+        {
+            *outputVectorPtr++ = (int16_t)(*inputVectorPtr++);
+        }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE4_1
+#include <smmintrin.h>
+
+static inline void volk_gnsssdr_8ic_convert_16ic_u_sse4_1(lv_16sc_t* outputVector, const lv_8sc_t* inputVector, unsigned int num_points)
+{
+    const unsigned int sse_iters = num_points / 8;
+    const int8_t* inputVectorPtr = (const int8_t*)inputVector;
+    int16_t* outputVectorPtr = (int16_t*)outputVector;
+    __m128i input;
+    unsigned int i;
+
+    for (i = 0; i < sse_iters; i++)
+        {
+            input = _mm_loadu_si128((const __m128i*)inputVectorPtr);
+            _mm_storeu_si128((__m128i*)outputVectorPtr, _mm_cvtepi8_epi16(input));
+            _mm_storeu_si128((__m128i*)(outputVectorPtr + 8), _mm_cvtepi8_epi16(_mm_srli_si128(input, 8)));
+            inputVectorPtr += 16;
+            outputVectorPtr += 16;
+        }
+
+    for (i = sse_iters * 16; i < 2 * num_points; i++)
+        {
+            *outputVectorPtr++ = (int16_t)(*inputVectorPtr++);
+        }
+}
+
+#endif /* LV_HAVE_SSE4_1 */
+
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_8ic_convert_16ic_u_avx2(lv_16sc_t* outputVector, const lv_8sc_t* inputVector, unsigned int num_points)
+{
+    const unsigned int avx2_iters = num_points / 16;
+    const int8_t* inputVectorPtr = (const int8_t*)inputVector;
+    int16_t* outputVectorPtr = (int16_t*)outputVector;
+    unsigned int i;
+
+    for (i = 0; i < avx2_iters; i++)
+        {
+            _mm256_storeu_si256((__m256i*)outputVectorPtr, _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)inputVectorPtr)));
+            _mm256_storeu_si256((__m256i*)(outputVectorPtr + 16), _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(inputVectorPtr + 16))));
+            inputVectorPtr += 32;
+            outputVectorPtr += 32;
+        }
+
+    for (i = avx2_iters * 32; i < 2 * num_points; i++)
+        {
+            *outputVectorPtr++ = (int16_t)(*inputVectorPtr++);
+        }
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEON
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_8ic_convert_16ic_neon(lv_16sc_t* outputVector, const lv_8sc_t* inputVector, unsigned int num_points)
+{
+    const unsigned int neon_iters = num_points / 8;
+    const int8_t* inputVectorPtr = (const int8_t*)inputVector;
+    int16_t* outputVectorPtr = (int16_t*)outputVector;
+    int8x16_t input;
+    unsigned int i;
+
+    for (i = 0; i < neon_iters; i++)
+        {
+            input = vld1q_s8(inputVectorPtr);
+            vst1q_s16(outputVectorPtr, vmovl_s8(vget_low_s8(input)));
+            vst1q_s16(outputVectorPtr + 8, vmovl_s8(vget_high_s8(input)));
+            inputVectorPtr += 16;
+            outputVectorPtr += 16;
+        }
+
+    for (i = neon_iters * 16; i < 2 * num_points; i++)
+        {
+            *outputVectorPtr++ = (int16_t)(*inputVectorPtr++);
+        }
+}
+
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_8ic_convert_16ic_H */
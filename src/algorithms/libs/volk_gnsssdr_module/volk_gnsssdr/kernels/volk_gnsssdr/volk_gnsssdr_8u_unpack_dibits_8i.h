@@ -0,0 +1,227 @@
+/*!
+ * \file volk_gnsssdr_8u_unpack_dibits_8i.h
+ * \brief VOLK_GNSSSDR kernel: unpacks 2-bit samples packed in bytes, using
+ * nibble lookup tables.
+ *
+ * VOLK_GNSSSDR kernel that unpacks the four 2-bit samples of each byte into
+ * four 8-bit samples. The values and the order of the samples are given by
+ * lookup tables, so it serves any 2-bit sample format.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_8u_unpack_dibits_8i
+ *
+ * \b Overview
+ *
+ * Computes cChar[4 * i + k] = tables[32 * k + (aChar[i] & 15)] |
+ * tables[32 * k + 16 + (aChar[i] >> 4)], for k = 0, 1, 2, 3.
+ * For each of the four output samples of a byte, the first 16 values of its
+ * table are indexed by the low nibble and the next 16 values by the high
+ * nibble, so the table of the nibble that does not contain the sample has to
+ * be filled with zeros.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_8u_unpack_dibits_8i(char* cChar, const unsigned char* aChar, const char* tables, unsigned int num_points)
+ * \endcode
+ *
+ * \b Inputs
+ * \li aChar: The packed samples, four per byte.
+ * \li tables: The 128 values of the lookup tables.
+ * \li num_points: The number of unpacked samples.
+ *
+ * \b Outputs
+ * \li cChar: The vector where the unpacked samples will be stored.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8u_unpack_dibits_8i_H
+#define INCLUDED_volk_gnsssdr_8u_unpack_dibits_8i_H
+
+#include <volk_gnsssdr/volk_gnsssdr_common.h>
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_8u_unpack_dibits_8i_generic(char* cChar, const unsigned char* aChar, const char* tables, unsigned int num_points)
+{
+    unsigned int i;
+    unsigned int k;
+    unsigned char a;
+    for (i = 0; i < num_points; i++)
+        {
+            a = aChar[i / 4];
+            k = 32 * (i % 4);
+            cChar[i] = tables[k + (a & 15)] | tables[k + 16 + (a >> 4)];
+        }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSSE3
+#include <tmmintrin.h>
+
+static inline void volk_gnsssdr_8u_unpack_dibits_8i_u_ssse3(char* cChar, const unsigned char* aChar, const char* tables, unsigned int num_points)
+{
+    const unsigned int sse_iters = num_points / 64;
+    __m128i table_lo[4];
+    __m128i table_hi[4];
+    const __m128i mask = _mm_set1_epi8(0x0F);
+    __m128i a, lo, hi, s0, s1, s2, s3, p01_lo, p01_hi, p23_lo, p23_hi;
+    unsigned int number;
+    unsigned int i;
+    unsigned int k;
+    unsigned char c;
+
+    for (k = 0; k < 4; k++)
+        {
+            table_lo[k] = _mm_loadu_si128((const __m128i*)(tables + 32 * k));
+            table_hi[k] = _mm_loadu_si128((const __m128i*)(tables + 32 * k + 16));
+        }
+
+    for (number = 0; number < sse_iters; number++)
+        {
+            a = _mm_loadu_si128((const __m128i*)(aChar + 16 * number));
+            lo = _mm_and_si128(a, mask);
+            hi = _mm_and_si128(_mm_srli_epi16(a, 4), mask);
+            s0 = _mm_or_si128(_mm_shuffle_epi8(table_lo[0], lo), _mm_shuffle_epi8(table_hi[0], hi));
+            s1 = _mm_or_si128(_mm_shuffle_epi8(table_lo[1], lo), _mm_shuffle_epi8(table_hi[1], hi));
+            s2 = _mm_or_si128(_mm_shuffle_epi8(table_lo[2], lo), _mm_shuffle_epi8(table_hi[2], hi));
+            s3 = _mm_or_si128(_mm_shuffle_epi8(table_lo[3], lo), _mm_shuffle_epi8(table_hi[3], hi));
+            // interleave the samples 0, 1 and 2, 3 of each byte, and then the pairs
+            p01_lo = _mm_unpacklo_epi8(s0, s1);
+            p01_hi = _mm_unpackhi_epi8(s0, s1);
+            p23_lo = _mm_unpacklo_epi8(s2, s3);
+            p23_hi = _mm_unpackhi_epi8(s2, s3);
+            _mm_storeu_si128((__m128i*)(cChar + 64 * number), _mm_unpacklo_epi16(p01_lo, p23_lo));
+            _mm_storeu_si128((__m128i*)(cChar + 64 * number + 16), _mm_unpackhi_epi16(p01_lo, p23_lo));
+            _mm_storeu_si128((__m128i*)(cChar + 64 * number + 32), _mm_unpacklo_epi16(p01_hi, p23_hi));
+            _mm_storeu_si128((__m128i*)(cChar + 64 * number + 48), _mm_unpackhi_epi16(p01_hi, p23_hi));
+        }
+
+    for (i = sse_iters * 64; i < num_points; i++)
+        {
+            c = aChar[i / 4];
+            k = 32 * (i % 4);
+            cChar[i] = tables[k + (c & 15)] | tables[k + 16 + (c >> 4)];
+        }
+}
+
+#endif /* LV_HAVE_SSSE3 */
+
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_8u_unpack_dibits_8i_u_avx2(char* cChar, const unsigned char* aChar, const char* tables, unsigned int num_points)
+{
+    const unsigned int avx2_iters = num_points / 128;
+    __m256i table_lo[4];
+    __m256i table_hi[4];
+    const __m256i mask = _mm256_set1_epi8(0x0F);
+    __m256i a, lo, hi, s0, s1, s2, s3, p01_lo, p01_hi, p23_lo, p23_hi, q0, q1, q2, q3;
+    unsigned int number;
+    unsigned int i;
+    unsigned int k;
+    unsigned char c;
+
+    for (k = 0; k < 4; k++)
+        {
+            table_lo[k] = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(tables + 32 * k)));
+            table_hi[k] = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(tables + 32 * k + 16)));
+        }
+
+    for (number = 0; number < avx2_iters; number++)
+        {
+            a = _mm256_loadu_si256((const __m256i*)(aChar + 32 * number));
+            lo = _mm256_and_si256(a, mask);
+            hi = _mm256_and_si256(_mm256_srli_epi16(a, 4), mask);
+            s0 = _mm256_or_si256(_mm256_shuffle_epi8(table_lo[0], lo), _mm256_shuffle_epi8(table_hi[0], hi));
+            s1 = _mm256_or_si256(_mm256_shuffle_epi8(table_lo[1], lo), _mm256_shuffle_epi8(table_hi[1], hi));
+            s2 = _mm256_or_si256(_mm256_shuffle_epi8(table_lo[2], lo), _mm256_shuffle_epi8(table_hi[2], hi));
+            s3 = _mm256_or_si256(_mm256_shuffle_epi8(table_lo[3], lo), _mm256_shuffle_epi8(table_hi[3], hi));
+            // the unpacks work within each 128-bit lane
+            p01_lo = _mm256_unpacklo_epi8(s0, s1);
+            p01_hi = _mm256_unpackhi_epi8(s0, s1);
+            p23_lo = _mm256_unpacklo_epi8(s2, s3);
+            p23_hi = _mm256_unpackhi_epi8(s2, s3);
+            q0 = _mm256_unpacklo_epi16(p01_lo, p23_lo);
+            q1 = _mm256_unpackhi_epi16(p01_lo, p23_lo);
+            q2 = _mm256_unpacklo_epi16(p01_hi, p23_hi);
+            q3 = _mm256_unpackhi_epi16(p01_hi, p23_hi);
+            _mm256_storeu_si256((__m256i*)(cChar + 128 * number), _mm256_permute2x128_si256(q0, q1, 0x20));
+            _mm256_storeu_si256((__m256i*)(cChar + 128 * number + 32), _mm256_permute2x128_si256(q2, q3, 0x20));
+            _mm256_storeu_si256((__m256i*)(cChar + 128 * number + 64), _mm256_permute2x128_si256(q0, q1, 0x31));
+            _mm256_storeu_si256((__m256i*)(cChar + 128 * number + 96), _mm256_permute2x128_si256(q2, q3, 0x31));
+        }
+
+    for (i = avx2_iters * 128; i < num_points; i++)
+        {
+            c = aChar[i / 4];
+            k = 32 * (i % 4);
+            cChar[i] = tables[k + (c & 15)] | tables[k + 16 + (c >> 4)];
+        }
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEON
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_8u_unpack_dibits_8i_neon(char* cChar, const unsigned char* aChar, const char* tables, unsigned int num_points)
+{
+    const unsigned int neon_iters = num_points / 32;
+    const unsigned char* t = (const unsigned char*)tables;
+    uint8x8x2_t table_lo[4];
+    uint8x8x2_t table_hi[4];
+    const uint8x8_t mask = vdup_n_u8(0x0F);
+    uint8x8_t a, lo, hi;
+    uint8x8x4_t s;
+    unsigned int number;
+    unsigned int i;
+    unsigned int k;
+    unsigned char c;
+
+    for (k = 0; k < 4; k++)
+        {
+            table_lo[k].val[0] = vld1_u8(t + 32 * k);
+            table_lo[k].val[1] = vld1_u8(t + 32 * k + 8);
+            table_hi[k].val[0] = vld1_u8(t + 32 * k + 16);
+            table_hi[k].val[1] = vld1_u8(t + 32 * k + 24);
+        }
+
+    for (number = 0; number < neon_iters; number++)
+        {
+            a = vld1_u8(aChar + 8 * number);
+            lo = vand_u8(a, mask);
+            hi = vshr_n_u8(a, 4);
+            for (k = 0; k < 4; k++)
+                {
+                    s.val[k] = vorr_u8(vtbl2_u8(table_lo[k], lo), vtbl2_u8(table_hi[k], hi));
+                }
+            vst4_u8((unsigned char*)(cChar + 32 * number), s);
+        }
+
+    for (i = neon_iters * 32; i < num_points; i++)
+        {
+            c = aChar[i / 4];
+            k = 32 * (i % 4);
+            cChar[i] = tables[k + (c & 15)] | tables[k + 16 + (c >> 4)];
+        }
+}
+
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_8u_unpack_dibits_8i_H */
@@ -0,0 +1,93 @@
+/*!
+ * \file volk_gnsssdr_8u_unpack_dibitspuppet_8i.h
+ * \brief Volk puppet for the 2-bit unpacking kernel.
+ *
+ * Volk puppet for integrating the 2-bit unpacking kernel into volk's test
+ * system
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8u_unpack_dibitspuppet_8i_H
+#define INCLUDED_volk_gnsssdr_8u_unpack_dibitspuppet_8i_H
+
+#include "volk_gnsssdr/volk_gnsssdr_8u_unpack_dibits_8i.h"
+
+
+static inline char volk_gnsssdr_8u_unpack_dibitspuppet_8i_value(int dibit)
+{
+    // two's complement samples mapped to 2 * x + 1
+    return (char)(2 * (dibit >= 2 ? dibit - 4 : dibit) + 1);
+}
+
+
+static inline void volk_gnsssdr_8u_unpack_dibitspuppet_8i_init(char* tables)
+{
+    // least significant bits first
+    int x;
+    for (x = 0; x < 16; x++)
+        {
+            tables[x] = volk_gnsssdr_8u_unpack_dibitspuppet_8i_value(x & 3);
+            tables[16 + x] = 0;
+            tables[32 + x] = volk_gnsssdr_8u_unpack_dibitspuppet_8i_value(x >> 2);
+            tables[48 + x] = 0;
+            tables[64 + x] = 0;
+            tables[80 + x] = volk_gnsssdr_8u_unpack_dibitspuppet_8i_value(x & 3);
+            tables[96 + x] = 0;
+            tables[112 + x] = volk_gnsssdr_8u_unpack_dibitspuppet_8i_value(x >> 2);
+        }
+}
+
+
+#ifdef LV_HAVE_GENERIC
+static inline void volk_gnsssdr_8u_unpack_dibitspuppet_8i_generic(char* cChar, const unsigned char* aChar, unsigned int num_points)
+{
+    char tables[128];
+    volk_gnsssdr_8u_unpack_dibitspuppet_8i_init(tables);
+    volk_gnsssdr_8u_unpack_dibits_8i_generic(cChar, aChar, tables, num_points);
+}
+
+#endif  // Generic
+
+
+#ifdef LV_HAVE_SSSE3
+static inline void volk_gnsssdr_8u_unpack_dibitspuppet_8i_u_ssse3(char* cChar, const unsigned char* aChar, unsigned int num_points)
+{
+    char tables[128];
+    volk_gnsssdr_8u_unpack_dibitspuppet_8i_init(tables);
+    volk_gnsssdr_8u_unpack_dibits_8i_u_ssse3(cChar, aChar, tables, num_points);
+}
+
+#endif  // SSSE3
+
+
+#ifdef LV_HAVE_AVX2
+static inline void volk_gnsssdr_8u_unpack_dibitspuppet_8i_u_avx2(char* cChar, const unsigned char* aChar, unsigned int num_points)
+{
+    char tables[128];
+    volk_gnsssdr_8u_unpack_dibitspuppet_8i_init(tables);
+    volk_gnsssdr_8u_unpack_dibits_8i_u_avx2(cChar, aChar, tables, num_points);
+}
+
+#endif  // AVX2
+
+
+#ifdef LV_HAVE_NEON
+static inline void volk_gnsssdr_8u_unpack_dibitspuppet_8i_neon(char* cChar, const unsigned char* aChar, unsigned int num_points)
+{
+    char tables[128];
+    volk_gnsssdr_8u_unpack_dibitspuppet_8i_init(tables);
+    volk_gnsssdr_8u_unpack_dibits_8i_neon(cChar, aChar, tables, num_points);
+}
+
+#endif  // NEON
+
+#endif  // INCLUDED_volk_gnsssdr_8u_unpack_dibitspuppet_8i_H
@@ -0,0 +1,84 @@
+/*!
+ * \file volk_gnsssdr_8u_unpack_nibblespuppet_8i.h
+ * \brief Volk puppet for the 4-bit unpacking kernel.
+ *
+ * Volk puppet for integrating the 4-bit unpacking kernel into volk's test
+ * system
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8u_unpack_nibblespuppet_8i_H
+#define INCLUDED_volk_gnsssdr_8u_unpack_nibblespuppet_8i_H
+
+#include "volk_gnsssdr/volk_gnsssdr_8u_unpack_nibbles_8i.h"
+
+
+static inline void volk_gnsssdr_8u_unpack_nibblespuppet_8i_init(char* tables)
+{
+    // two's complement samples, low nibble first, mapped to 2 * x + 1
+    int x;
+    int v;
+    for (x = 0; x < 16; x++)
+        {
+            v = x >= 8 ? x - 16 : x;
+            tables[x] = (char)(2 * v + 1);
+            tables[16 + x] = 0;
+            tables[32 + x] = 0;
+            tables[48 + x] = (char)(2 * v + 1);
+        }
+}
+
+
+#ifdef LV_HAVE_GENERIC
+static inline void volk_gnsssdr_8u_unpack_nibblespuppet_8i_generic(char* cChar, const unsigned char* aChar, unsigned int num_points)
+{
+    char tables[64];
+    volk_gnsssdr_8u_unpack_nibblespuppet_8i_init(tables);
+    volk_gnsssdr_8u_unpack_nibbles_8i_generic(cChar, aChar, tables, num_points);
+}
+
+#endif  // Generic
+
+
+#ifdef LV_HAVE_SSSE3
+static inline void volk_gnsssdr_8u_unpack_nibblespuppet_8i_u_ssse3(char* cChar, const unsigned char* aChar, unsigned int num_points)
+{
+    char tables[64];
+    volk_gnsssdr_8u_unpack_nibblespuppet_8i_init(tables);
+    volk_gnsssdr_8u_unpack_nibbles_8i_u_ssse3(cChar, aChar, tables, num_points);
+}
+
+#endif  // SSSE3
+
+
+#ifdef LV_HAVE_AVX2
+static inline void volk_gnsssdr_8u_unpack_nibblespuppet_8i_u_avx2(char* cChar, const unsigned char* aChar, unsigned int num_points)
+{
+    char tables[64];
+    volk_gnsssdr_8u_unpack_nibblespuppet_8i_init(tables);
+    volk_gnsssdr_8u_unpack_nibbles_8i_u_avx2(cChar, aChar, tables, num_points);
+}
+
+#endif  // AVX2
+
+
+#ifdef LV_HAVE_NEON
+static inline void volk_gnsssdr_8u_unpack_nibblespuppet_8i_neon(char* cChar, const unsigned char* aChar, unsigned int num_points)
+{
+    char tables[64];
+    volk_gnsssdr_8u_unpack_nibblespuppet_8i_init(tables);
+    volk_gnsssdr_8u_unpack_nibbles_8i_neon(cChar, aChar, tables, num_points);
+}
+
+#endif  // NEON
+
+#endif  // INCLUDED_volk_gnsssdr_8u_unpack_nibblespuppet_8i_H
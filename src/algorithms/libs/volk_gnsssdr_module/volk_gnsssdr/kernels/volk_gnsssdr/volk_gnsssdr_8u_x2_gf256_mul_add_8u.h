@@ -0,0 +1,174 @@
+/*!
+ * \file volk_gnsssdr_8u_x2_gf256_mul_add_8u.h
+ * \brief VOLK_GNSSSDR kernel: multiply-and-add of GF(2^8) elements by a
+ * constant, using nibble lookup tables.
+ *
+ * VOLK_GNSSSDR kernel that adds a vector of GF(2^8) elements to another one
+ * multiplied by a constant. It is the Horner step of the syndrome computation
+ * of the Reed-Solomon decoder, applied to several codewords at once.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_8u_x2_gf256_mul_add_8u
+ *
+ * \b Overview
+ *
+ * Computes cChar[i] = aChar[i] + k * bChar[i] in GF(2^8), where the addition
+ * is a XOR and the multiplication by the constant k is given by two nibble
+ * tables: k * x = mul_tables[x & 15] ^ mul_tables[16 + (x >> 4)].
+ * They are the products of k by the 16 values of the low nibble and by the
+ * 16 values of the high nibble, so they define the field (primitive
+ * polynomial) and the constant. cChar can be the same vector as bChar.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_8u_x2_gf256_mul_add_8u(unsigned char* cChar, const unsigned char* aChar, const unsigned char* bChar, const unsigned char* mul_tables, unsigned int num_points)
+ * \endcode
+ *
+ * \b Inputs
+ * \li aChar: The vector to be added.
+ * \li bChar: The vector to be multiplied by the constant.
+ * \li mul_tables: The 32 nibble products of the constant.
+ * \li num_points: The number of elements.
+ *
+ * \b Outputs
+ * \li cChar: The vector where the result will be stored.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8u_x2_gf256_mul_add_8u_H
+#define INCLUDED_volk_gnsssdr_8u_x2_gf256_mul_add_8u_H
+
+#include <volk_gnsssdr/volk_gnsssdr_common.h>
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_8u_x2_gf256_mul_add_8u_generic(unsigned char* cChar, const unsigned char* aChar, const unsigned char* bChar, const unsigned char* mul_tables, unsigned int num_points)
+{
+    unsigned int i;
+    unsigned char b;
+    for (i = 0; i < num_points; i++)
+        {
+            b = bChar[i];
+            cChar[i] = aChar[i] ^ mul_tables[b & 15] ^ mul_tables[16 + (b >> 4)];
+        }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSSE3
+#include <tmmintrin.h>
+
+static inline void volk_gnsssdr_8u_x2_gf256_mul_add_8u_u_ssse3(unsigned char* cChar, const unsigned char* aChar, const unsigned char* bChar, const unsigned char* mul_tables, unsigned int num_points)
+{
+    const unsigned int sse_iters = num_points / 16;
+    const __m128i table_lo = _mm_loadu_si128((const __m128i*)mul_tables);
+    const __m128i table_hi = _mm_loadu_si128((const __m128i*)(mul_tables + 16));
+    const __m128i mask = _mm_set1_epi8(0x0F);
+    __m128i a, b, lo, hi;
+    unsigned int number;
+    unsigned int i;
+    unsigned char c;
+
+    for (number = 0; number < sse_iters; number++)
+        {
+            a = _mm_loadu_si128((const __m128i*)(aChar + 16 * number));
+            b = _mm_loadu_si128((const __m128i*)(bChar + 16 * number));
+            lo = _mm_shuffle_epi8(table_lo, _mm_and_si128(b, mask));
+            hi = _mm_shuffle_epi8(table_hi, _mm_and_si128(_mm_srli_epi16(b, 4), mask));
+            _mm_storeu_si128((__m128i*)(cChar + 16 * number), _mm_xor_si128(a, _mm_xor_si128(lo, hi)));
+        }
+
+    for (i = sse_iters * 16; i < num_points; i++)
+        {
+            c = bChar[i];
+            cChar[i] = aChar[i] ^ mul_tables[c & 15] ^ mul_tables[16 + (c >> 4)];
+        }
+}
+
+#endif /* LV_HAVE_SSSE3 */
+
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_8u_x2_gf256_mul_add_8u_u_avx2(unsigned char* cChar, const unsigned char* aChar, const unsigned char* bChar, const unsigned char* mul_tables, unsigned int num_points)
+{
+    const unsigned int avx2_iters = num_points / 32;
+    const __m256i table_lo = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)mul_tables));
+    const __m256i table_hi = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(mul_tables + 16)));
+    const __m256i mask = _mm256_set1_epi8(0x0F);
+    __m256i a, b, lo, hi;
+    unsigned int number;
+    unsigned int i;
+    unsigned char c;
+
+    for (number = 0; number < avx2_iters; number++)
+        {
+            a = _mm256_loadu_si256((const __m256i*)(aChar + 32 * number));
+            b = _mm256_loadu_si256((const __m256i*)(bChar + 32 * number));
+            lo = _mm256_shuffle_epi8(table_lo, _mm256_and_si256(b, mask));
+            hi = _mm256_shuffle_epi8(table_hi, _mm256_and_si256(_mm256_srli_epi16(b, 4), mask));
+            _mm256_storeu_si256((__m256i*)(cChar + 32 * number), _mm256_xor_si256(a, _mm256_xor_si256(lo, hi)));
+        }
+
+    for (i = avx2_iters * 32; i < num_points; i++)
+        {
+            c = bChar[i];
+            cChar[i] = aChar[i] ^ mul_tables[c & 15] ^ mul_tables[16 + (c >> 4)];
+        }
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEON
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_8u_x2_gf256_mul_add_8u_neon(unsigned char* cChar, const unsigned char* aChar, const unsigned char* bChar, const unsigned char* mul_tables, unsigned int num_points)
+{
+    const unsigned int neon_iters = num_points / 8;
+    uint8x8x2_t table_lo;
+    uint8x8x2_t table_hi;
+    const uint8x8_t mask = vdup_n_u8(0x0F);
+    uint8x8_t a, b, lo, hi;
+    unsigned int number;
+    unsigned int i;
+    unsigned char c;
+
+    table_lo.val[0] = vld1_u8(mul_tables);
+    table_lo.val[1] = vld1_u8(mul_tables + 8);
+    table_hi.val[0] = vld1_u8(mul_tables + 16);
+    table_hi.val[1] = vld1_u8(mul_tables + 24);
+
+    for (number = 0; number < neon_iters; number++)
+        {
+            a = vld1_u8(aChar + 8 * number);
+            b = vld1_u8(bChar + 8 * number);
+            lo = vtbl2_u8(table_lo, vand_u8(b, mask));
+            hi = vtbl2_u8(table_hi, vshr_n_u8(b, 4));
+            vst1_u8(cChar + 8 * number, veor_u8(a, veor_u8(lo, hi)));
+        }
+
+    for (i = neon_iters * 8; i < num_points; i++)
+        {
+            c = bChar[i];
+            cChar[i] = aChar[i] ^ mul_tables[c & 15] ^ mul_tables[16 + (c >> 4)];
+        }
+}
+
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_8u_x2_gf256_mul_add_8u_H */
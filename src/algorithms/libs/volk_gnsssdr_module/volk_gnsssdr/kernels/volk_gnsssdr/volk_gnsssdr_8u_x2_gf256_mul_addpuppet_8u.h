@@ -0,0 +1,101 @@
+/*!
+ * \file volk_gnsssdr_8u_x2_gf256_mul_addpuppet_8u.h
+ * \brief Volk puppet for the GF(2^8) multiply-and-add kernel.
+ *
+ * Volk puppet for integrating the GF(2^8) multiply-and-add kernel into volk's
+ * test system
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_8u_x2_gf256_mul_addpuppet_8u_H
+#define INCLUDED_volk_gnsssdr_8u_x2_gf256_mul_addpuppet_8u_H
+
+#include "volk_gnsssdr/volk_gnsssdr_8u_x2_gf256_mul_add_8u.h"
+
+
+static inline unsigned char volk_gnsssdr_8u_x2_gf256_mul_addpuppet_8u_mul(unsigned int a, unsigned int b)
+{
+    // field of the Galileo Reed-Solomon codes, x^8 + x^4 + x^3 + x^2 + 1
+    unsigned int p = 0;
+    while (b != 0)
+        {
+            if (b & 1)
+                {
+                    p ^= a;
+                }
+            a <<= 1;
+            if (a & 0x100)
+                {
+                    a ^= 0x11D;
+                }
+            b >>= 1;
+        }
+    return (unsigned char)p;
+}
+
+
+static inline void volk_gnsssdr_8u_x2_gf256_mul_addpuppet_8u_init(unsigned char* mul_tables)
+{
+    const unsigned int k = 0x8E;
+    unsigned int x;
+    for (x = 0; x < 16; x++)
+        {
+            mul_tables[x] = volk_gnsssdr_8u_x2_gf256_mul_addpuppet_8u_mul(x, k);
+            mul_tables[16 + x] = volk_gnsssdr_8u_x2_gf256_mul_addpuppet_8u_mul(x << 4, k);
+        }
+}
+
+
+#ifdef LV_HAVE_GENERIC
+static inline void volk_gnsssdr_8u_x2_gf256_mul_addpuppet_8u_generic(unsigned char* cChar, const unsigned char* aChar, const unsigned char* bChar, unsigned int num_points)
+{
+    unsigned char mul_tables[32];
+    volk_gnsssdr_8u_x2_gf256_mul_addpuppet_8u_init(mul_tables);
+    volk_gnsssdr_8u_x2_gf256_mul_add_8u_generic(cChar, aChar, bChar, mul_tables, num_points);
+}
+
+#endif  // Generic
+
+
+#ifdef LV_HAVE_SSSE3
+static inline void volk_gnsssdr_8u_x2_gf256_mul_addpuppet_8u_u_ssse3(unsigned char* cChar, const unsigned char* aChar, const unsigned char* bChar, unsigned int num_points)
+{
+    unsigned char mul_tables[32];
+    volk_gnsssdr_8u_x2_gf256_mul_addpuppet_8u_init(mul_tables);
+    volk_gnsssdr_8u_x2_gf256_mul_add_8u_u_ssse3(cChar, aChar, bChar, mul_tables, num_points);
+}
+
+#endif  // SSSE3
+
+
+#ifdef LV_HAVE_AVX2
+static inline void volk_gnsssdr_8u_x2_gf256_mul_addpuppet_8u_u_avx2(unsigned char* cChar, const unsigned char* aChar, const unsigned char* bChar, unsigned int num_points)
+{
+    unsigned char mul_tables[32];
+    volk_gnsssdr_8u_x2_gf256_mul_addpuppet_8u_init(mul_tables);
+    volk_gnsssdr_8u_x2_gf256_mul_add_8u_u_avx2(cChar, aChar, bChar, mul_tables, num_points);
+}
+
+#endif  // AVX2
+
+
+#ifdef LV_HAVE_NEON
+static inline void volk_gnsssdr_8u_x2_gf256_mul_addpuppet_8u_neon(unsigned char* cChar, const unsigned char* aChar, const unsigned char* bChar, unsigned int num_points)
+{
+    unsigned char mul_tables[32];
+    volk_gnsssdr_8u_x2_gf256_mul_addpuppet_8u_init(mul_tables);
+    volk_gnsssdr_8u_x2_gf256_mul_add_8u_neon(cChar, aChar, bChar, mul_tables, num_points);
+}
+
+#endif  // NEON
+
+#endif  // INCLUDED_volk_gnsssdr_8u_x2_gf256_mul_addpuppet_8u_H
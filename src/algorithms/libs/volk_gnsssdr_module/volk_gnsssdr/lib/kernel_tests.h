@@ -57,6 +57,8 @@ std::vector<volk_gnsssdr_test_case_t> init_test_list(volk_gnsssdr_test_params_t
     QA(VOLK_INIT_TEST(volk_gnsssdr_8i_index_max_16u, test_params_more_iters))
     QA(VOLK_INIT_TEST(volk_gnsssdr_8i_max_s8i, test_params_more_iters))
     QA(VOLK_INIT_TEST(volk_gnsssdr_8i_x2_add_8i, test_params_more_iters))
+    QA(VOLK_INIT_TEST(volk_gnsssdr_8i_x2_interleave_8ic, test_params_more_iters))
+    QA(VOLK_INIT_TEST(volk_gnsssdr_8ic_convert_16ic, test_params_more_iters))
     QA(VOLK_INIT_TEST(volk_gnsssdr_8ic_conjugate_8ic, test_params_more_iters))
     QA(VOLK_INIT_TEST(volk_gnsssdr_8ic_magnitude_squared_8i, test_params_more_iters))
     QA(VOLK_INIT_TEST(volk_gnsssdr_8ic_x2_dot_prod_8ic, test_params))
@@ -68,10 +70,12 @@ std::vector<volk_gnsssdr_test_case_t> init_test_list(volk_gnsssdr_test_params_t
     QA(VOLK_INIT_TEST(volk_gnsssdr_32f_index_max_32u, test_params))
     QA(VOLK_INIT_TEST(volk_gnsssdr_32fc_convert_8ic, test_params))
     QA(VOLK_INIT_TEST(volk_gnsssdr_32fc_convert_16ic, test_params_more_iters))
+    QA(VOLK_INIT_TEST(volk_gnsssdr_32fc_32f_magnitude_squared_add_32f, test_params))
     QA(VOLK_INIT_TEST(volk_gnsssdr_16ic_x2_dot_prod_16ic, test_params))
     QA(VOLK_INIT_TEST(volk_gnsssdr_16ic_x2_multiply_16ic, test_params_more_iters))
     QA(VOLK_INIT_TEST(volk_gnsssdr_16ic_convert_32fc, test_params_more_iters))
     QA(VOLK_INIT_TEST(volk_gnsssdr_16ic_conjugate_16ic, test_params_more_iters))
+    QA(VOLK_INIT_TEST(volk_gnsssdr_16i_x2_interleave_16ic, test_params_more_iters))
     QA(VOLK_INIT_PUPP(volk_gnsssdr_s32f_sincospuppet_32fc, volk_gnsssdr_s32f_sincos_32fc, test_params_inacc2))
     QA(VOLK_INIT_PUPP(volk_gnsssdr_16ic_rotatorpuppet_16ic, volk_gnsssdr_16ic_s32fc_x2_rotator_16ic, test_params_int1))
     QA(VOLK_INIT_PUPP(volk_gnsssdr_16ic_resamplerfastpuppet_16ic, volk_gnsssdr_16ic_resampler_fast_16ic, test_params))
@@ -81,9 +85,17 @@ std::vector<volk_gnsssdr_test_case_t> init_test_list(volk_gnsssdr_test_params_t
     QA(VOLK_INIT_PUPP(volk_gnsssdr_32fc_resamplerxnpuppet_32fc, volk_gnsssdr_32fc_xn_resampler_32fc_xn, test_params))
     QA(VOLK_INIT_PUPP(volk_gnsssdr_32f_resamplerxnpuppet_32f, volk_gnsssdr_32f_xn_resampler_32f_xn, test_params))
     QA(VOLK_INIT_PUPP(volk_gnsssdr_32f_high_dynamics_resamplerxnpuppet_32f, volk_gnsssdr_32f_xn_high_dynamics_resampler_32f_xn, test_params))
+    QA(VOLK_INIT_PUPP(volk_gnsssdr_32f_viterbi_k7_acspuppet_32u, volk_gnsssdr_32f_viterbi_k7_acs_32u, test_params))
+    QA(VOLK_INIT_PUPP(volk_gnsssdr_8u_x2_gf256_mul_addpuppet_8u, volk_gnsssdr_8u_x2_gf256_mul_add_8u, test_params_more_iters))
+    QA(VOLK_INIT_PUPP(volk_gnsssdr_8u_unpack_nibblespuppet_8i, volk_gnsssdr_8u_unpack_nibbles_8i, test_params_more_iters))
+    QA(VOLK_INIT_PUPP(volk_gnsssdr_8u_unpack_dibitspuppet_8i, volk_gnsssdr_8u_unpack_dibits_8i, test_params_more_iters))
+    QA(VOLK_INIT_PUPP(volk_gnsssdr_32f_signed_gatherpuppet_32f, volk_gnsssdr_32f_signed_gather_32f, test_params_more_iters))
+    QA(VOLK_INIT_PUPP(volk_gnsssdr_32fc_xn_weighted_sumpuppet_32fc, volk_gnsssdr_32fc_xn_weighted_sum_32fc, test_params_inacc))
     QA(VOLK_INIT_PUPP(volk_gnsssdr_16ic_x2_dotprodxnpuppet_16ic, volk_gnsssdr_16ic_x2_dot_prod_16ic_xn, test_params))
     QA(VOLK_INIT_PUPP(volk_gnsssdr_16ic_x2_rotator_dotprodxnpuppet_16ic, volk_gnsssdr_16ic_x2_rotator_dot_prod_16ic_xn, test_params_int16))
     QA(VOLK_INIT_PUPP(volk_gnsssdr_16ic_16i_rotator_dotprodxnpuppet_16ic, volk_gnsssdr_16ic_16i_rotator_dot_prod_16ic_xn, test_params_int16))
+    QA(VOLK_INIT_PUPP(volk_gnsssdr_8ic_16i_nco_dotprodxnpuppet_32fc, volk_gnsssdr_8ic_16i_nco_dot_prod_32fc_xn, test_params))
+    QA(VOLK_INIT_PUPP(volk_gnsssdr_16ic_16i_nco_dotprodxnpuppet_32fc, volk_gnsssdr_16ic_16i_nco_dot_prod_32fc_xn, test_params_inacc))
     QA(VOLK_INIT_PUPP(volk_gnsssdr_32fc_x2_rotator_dotprodxnpuppet_32fc, volk_gnsssdr_32fc_x2_rotator_dot_prod_32fc_xn, test_params_inacc))
     QA(VOLK_INIT_PUPP(volk_gnsssdr_32fc_32f_rotator_dotprodxnpuppet_32fc, volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn, test_params_inacc));
     QA(VOLK_INIT_PUPP(volk_gnsssdr_32fc_32f_high_dynamic_rotator_dotprodxnpuppet_32fc, volk_gnsssdr_32fc_32f_high_dynamic_rotator_dot_prod_32fc_xn, test_params_inacc));
@@ -197,6 +197,30 @@ void ${kern.name}_manual(${kern.arglist_full}, const char* impl_name)
 
 
 
+${kern.pname} ${kern.name}_get_impl(const char* impl_name, bool aligned)
+{
+    const char **impl_names = get_machine()->${kern.name}_impl_names;
+    const int *impl_deps = get_machine()->${kern.name}_impl_deps;
+    const bool *alignment = get_machine()->${kern.name}_impl_alignment;
+    const size_t n_impls = get_machine()->${kern.name}_n_impls;
+    size_t i;
+    if (impl_name != NULL && impl_name[0] != '\0')
+        {
+            for (i = 0; i < n_impls; i++)
+                {
+                    // an implementation for aligned buffers is only given to callers that align them
+                    if (!strncmp(impl_names[i], impl_name, 20) && (aligned || !alignment[i]))
+                        {
+                            return get_machine()->${kern.name}_impls[i];
+                        }
+                }
+            fprintf(stderr, "VOLK_GNSSSDR warning: %s is not available for ${kern.name}, using the fastest implementation\n", impl_name);
+        }
+    return get_machine()->${kern.name}_impls[volk_gnsssdr_rank_archs(get_machine()->${kern.name}_name, impl_names, impl_deps, alignment, n_impls, aligned)];
+}
+
+
+
 volk_gnsssdr_func_desc_t ${kern.name}_get_func_desc(void) {
     const char **impl_names = get_machine()->${kern.name}_impl_names;
     const int *impl_deps = get_machine()->${kern.name}_impl_deps;
@@ -73,6 +73,10 @@ extern VOLK_API ${kern.pname} ${kern.name}_u;
 //! Call into a specific implementation given by name
 extern VOLK_API void ${kern.name}_manual(${kern.arglist_full}, const char* impl_name);
 
+//! Resolve once the implementation to call: impl_name if it is available, or else the fastest one.
+//! Implementations for aligned buffers are only returned if aligned is true
+extern VOLK_API ${kern.pname} ${kern.name}_get_impl(const char* impl_name, bool aligned);
+
 //! Get description parameters for this kernel
 extern VOLK_API volk_gnsssdr_func_desc_t ${kern.name}_get_func_desc(void);
 %endfor
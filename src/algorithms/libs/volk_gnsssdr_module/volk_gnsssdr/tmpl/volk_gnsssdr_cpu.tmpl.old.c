@@ -195,6 +195,32 @@ static int has_neonv8(void)
 #endif
 }
 
+static int has_sve(void)
+{
+#if defined(VOLK_CPU_ARMV8) && defined(HWCAP_SVE)
+    FILE *auxvec_f;
+    unsigned long auxvec[2];
+    unsigned int found_sve = 0;
+    auxvec_f = fopen("/proc/self/auxv", "rb");
+    if (!auxvec_f) return 0;
+
+    size_t r = 1;
+    // so auxv is basically 32b of ID and 32b of value
+    // so it goes like this
+    while (!found_sve && r)
+        {
+            r = fread(auxvec, sizeof(unsigned long), 2, auxvec_f);
+            if ((auxvec[0] == AT_HWCAP) && (auxvec[1] & HWCAP_SVE))
+                found_sve = 1;
+        }
+
+    fclose(auxvec_f);
+    return found_sve;
+#else
+    return 0;
+#endif
+}
+
 static int has_neon(void)
 {
 #if defined(VOLK_CPU_ARMV8) || defined(VOLK_CPU_ARMV7)
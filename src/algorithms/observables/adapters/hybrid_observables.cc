@@ -20,7 +20,8 @@
 #include "gnss_sdr_flags.h"
 #include "obs_conf.h"
 #include <glog/logging.h>
-#include <ostream>  // for operator<<
+#include <algorithm>  // for max
+#include <ostream>    // for operator<<
 
 HybridObservables::HybridObservables(const ConfigurationInterface* configuration,
     const std::string& role, unsigned int in_streams, unsigned int out_streams) : role_(role), in_streams_(in_streams), out_streams_(out_streams)
@@ -41,6 +42,18 @@ HybridObservables::HybridObservables(const ConfigurationInterface* configuration
     conf.observable_interval_ms = configuration->property("GNSS-SDR.observable_interval_ms", conf.observable_interval_ms);
     conf.enable_carrier_smoothing = configuration->property(role + ".enable_carrier_smoothing", conf.enable_carrier_smoothing);
     conf.always_output_gs = configuration->property("PVT.an_output_enabled", conf.always_output_gs) || configuration->property(role + ".always_output_gs", conf.always_output_gs);
+    conf.low_latency = configuration->property("PVT.low_latency", conf.low_latency) || configuration->property(role + ".low_latency", conf.low_latency);
+    conf.epoch_synchronous = configuration->property(role + ".epoch_synchronous", conf.epoch_synchronous);
+    // the PVT block takes the first outputs at pvt_interval_ms (rounded up to
+    // a multiple of observable_interval_ms), the monitors take a second group
+    // at observable_interval_ms
+    const uint32_t step_ms = std::max(conf.observable_interval_ms, 1U);
+    const uint32_t pvt_interval_ms = (std::max(configuration->property(role + ".pvt_interval_ms", 0U), 1U) + step_ms - 1U) / step_ms * step_ms;
+    if (pvt_interval_ms > conf.observable_interval_ms)
+        {
+            conf.output_intervals_ms = {pvt_interval_ms, conf.observable_interval_ms};
+            LOG(INFO) << "Observables output to PVT every " << pvt_interval_ms << " ms, and to the monitors every " << conf.observable_interval_ms << " ms";
+        }
 
     if (FLAGS_carrier_smoothing_factor == DEFAULT_CARRIER_SMOOTHING_FACTOR)
         {
@@ -51,6 +64,10 @@ HybridObservables::HybridObservables(const ConfigurationInterface* configuration
         {
             LOG(INFO) << "Observables carrier smoothing enabled with smoothing factor " << conf.smoothing_factor;
         }
+    if (conf.epoch_synchronous == true)
+        {
+            LOG(INFO) << "Observables gathered at the epochs of the receiver clock, without interpolation";
+        }
     observables_ = hybrid_observables_gs_make(conf);
     DLOG(INFO) << "Observables block ID (" << observables_->unique_id() << ")";
 }
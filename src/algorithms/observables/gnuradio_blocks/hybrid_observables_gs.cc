@@ -17,22 +17,25 @@
 
 #include "hybrid_observables_gs.h"
 #include "MATH_CONSTANTS.h"  // for SPEED_OF_LIGHT_M_S, TWO_PI
-#include "gnss_circular_deque.h"
 #include "gnss_frequencies.h"
 #include "gnss_sdr_create_directory.h"
 #include "gnss_sdr_filesystem.h"
 #include "gnss_sdr_make_unique.h"
 #include "gnss_synchro.h"
+#include "gnss_synchro_epoch_gather.h"
+#include "gnss_synchro_history.h"
+#include "gnss_trace.h"
+#include "obs_kernels.h"
 #include <glog/logging.h>
 #include <gnuradio/io_signature.h>
 #include <matio.h>
-#include <algorithm>  // for std::min
+#include <algorithm>  // for std::min, std::max
 #include <array>
+#include <chrono>
 #include <cmath>      // for round
-#include <cstdlib>    // for size_t, llabs
+#include <cstdlib>    // for size_t
 #include <exception>  // for exception
 #include <iostream>   // for cerr, cout
-#include <limits>     // for numeric_limits
 #include <utility>    // for move
 
 #if PMT_USES_BOOST_ANY
@@ -58,7 +61,7 @@ hybrid_observables_gs_sptr hybrid_observables_gs_make(const Obs_Conf &conf_)
 hybrid_observables_gs::hybrid_observables_gs(const Obs_Conf &conf_)
     : gr::block("hybrid_observables_gs",
           gr::io_signature::make(conf_.nchannels_in, conf_.nchannels_in, sizeof(Gnss_Synchro)),
-          gr::io_signature::make(conf_.nchannels_out, conf_.nchannels_out, sizeof(Gnss_Synchro))),
+          gr::io_signature::make(conf_.nchannels_out, conf_.nchannels_out * std::max(static_cast<uint32_t>(conf_.output_intervals_ms.size()), 1U), sizeof(Gnss_Synchro))),
       d_conf(conf_),
       d_dump_filename(conf_.dump_filename),
       d_smooth_filter_M(static_cast<double>(conf_.smoothing_factor)),
@@ -71,6 +74,8 @@ hybrid_observables_gs::hybrid_observables_gs(const Obs_Conf &conf_)
       d_nchannels_out(conf_.nchannels_out),
       d_T_rx_TOW_set(false),
       d_always_output_gs(conf_.always_output_gs),
+      d_low_latency(conf_.low_latency),
+      d_epoch_synchronous(conf_.epoch_synchronous),
       d_dump(conf_.dump),
       d_dump_mat(conf_.dump_mat && d_dump)
 {
@@ -90,14 +95,46 @@ hybrid_observables_gs::hybrid_observables_gs(const Obs_Conf &conf_)
     // Send Channel status to gnss_flowgraph
     this->message_port_register_out(pmt::mp("status"));
 
-    d_gnss_synchro_history = std::make_unique<Gnss_circular_deque<Gnss_Synchro>>(1000, d_nchannels_out);
+    if (d_epoch_synchronous)
+        {
+            // the observables of each epoch are gathered from the latest tracking observables, no history is needed
+            d_epoch_gather = std::make_unique<Gnss_Synchro_Epoch_Gather>(d_nchannels_out);
+            d_channel_items_read = std::vector<int32_t>(d_nchannels_out, 0);
+        }
+    else
+        {
+            d_gnss_synchro_history = std::make_unique<Gnss_Synchro_History>(1000, d_nchannels_out);
+        }
 
     d_Rx_clock_buffer.set_capacity(std::min(std::max(200U / d_T_rx_step_ms, 3U), 10U));
     d_Rx_clock_buffer.clear();
 
-    d_channel_last_pll_lock = std::vector<bool>(d_nchannels_out, false);
+    d_sample_clock = Gnss_Sample_Clock::global_instance();
+    d_TimeChannelTagReader.attach(d_sample_clock->time_tags());
+    d_pipeline_latency = Gnss_Pipeline_Latency::global_instance();
+
+    d_epoch_data = std::vector<Gnss_Synchro>(d_nchannels_out);
+    d_epoch_interp_TOW_ms = std::vector<double>(d_nchannels_out, 0.0);
+    d_epoch_pseudorange_m = std::vector<double>(d_nchannels_out, 0.0);
+    d_epoch_carrier_phase_rads = std::vector<double>(d_nchannels_out, 0.0);
+    d_epoch_valid_word = std::vector<uint8_t>(d_nchannels_out, 0);
+    d_epoch_valid_pseudorange = std::vector<uint8_t>(d_nchannels_out, 0);
+
+    d_channel_last_pll_lock = std::vector<uint8_t>(d_nchannels_out, 0);
     d_channel_last_pseudorange_smooth = std::vector<double>(d_nchannels_out, 0.0);
     d_channel_last_carrier_phase_rads = std::vector<double>(d_nchannels_out, 0.0);
+    d_channel_wavelength_m = std::vector<double>(d_nchannels_out, 0.0);
+
+    // the groups after the first one are optional outputs
+    for (const uint32_t interval_ms : d_conf.output_intervals_ms)
+        {
+            d_output_decimation.push_back(std::max(interval_ms / std::max(d_T_rx_step_ms, 1U), 1U));
+        }
+    if (d_output_decimation.empty())
+        {
+            d_output_decimation.push_back(1U);
+        }
+    d_group_produced = std::vector<int32_t>(d_output_decimation.size(), 0);
 
     d_mapStringValues["1C"] = evGPS_1C;
     d_mapStringValues["2S"] = evGPS_2S;
@@ -221,7 +258,14 @@ void hybrid_observables_gs::msg_handler_pvt_to_observables(const pmt::pmt_t &msg
                     // d_Rx_clock_buffer.clear();  // Clear all the elements in the buffer
                     for (uint32_t n = 0; n < d_nchannels_out; n++)
                         {
-                            d_gnss_synchro_history->clear(n);
+                            if (d_epoch_synchronous)
+                                {
+                                    d_epoch_gather->clear(n);
+                                }
+                            else
+                                {
+                                    d_gnss_synchro_history->clear(n);
+                                }
                         }
 
                     LOG(INFO) << "Corrected new RX Time offset: " << static_cast<int>(round(new_rx_clock_offset_s * 1000.0)) << "[ms]";
@@ -379,106 +423,49 @@ double hybrid_observables_gs::compute_T_rx_s(const Gnss_Synchro &a) const
 
 bool hybrid_observables_gs::interp_trk_obs(Gnss_Synchro &interpolated_obs, uint32_t ch, uint64_t rx_clock) const
 {
-    int32_t nearest_element = -1;
-    int64_t old_abs_diff = std::numeric_limits<int64_t>::max();
-    for (uint32_t i = 0; i < d_gnss_synchro_history->size(ch); i++)
+    if (d_epoch_synchronous)
         {
-            const int64_t abs_diff = llabs(static_cast<int64_t>(rx_clock) - static_cast<int64_t>(d_gnss_synchro_history->get(ch, i).Tracking_sample_counter));
-            if (old_abs_diff > abs_diff)
-                {
-                    old_abs_diff = abs_diff;
-                    nearest_element = static_cast<int32_t>(i);
-                }
+            const double carrier_freq_hz = (d_channel_wavelength_m[ch] > 0.0) ? SPEED_OF_LIGHT_M_S / d_channel_wavelength_m[ch] : 0.0;
+            return d_epoch_gather->propagate(ch, rx_clock, d_T_rx_step_s, carrier_freq_hz, interpolated_obs);
         }
+    return d_gnss_synchro_history->interpolate(ch, rx_clock, d_T_rx_step_s, interpolated_obs);
+}
+
 
-    if (nearest_element != -1 and nearest_element != static_cast<int32_t>(d_gnss_synchro_history->size(ch)))
+bool hybrid_observables_gs::epoch_ready() const
+{
+    if (d_epoch_synchronous)
         {
-            if ((static_cast<double>(old_abs_diff) / static_cast<double>(d_gnss_synchro_history->get(ch, nearest_element).fs)) < d_T_rx_step_s)
+            // the epochs are pushed once all the channels have reached them
+            return !d_Rx_clock_buffer.empty();
+        }
+    if (d_Rx_clock_buffer.full())
+        {
+            return true;
+        }
+    if (!d_low_latency or d_Rx_clock_buffer.empty())
+        {
+            return false;
+        }
+    // in low latency mode, the epoch goes out as soon as no channel can change its observables
+    for (uint32_t n = 0; n < d_nchannels_out; n++)
+        {
+            if (!d_gnss_synchro_history->is_complete(n, d_Rx_clock_buffer.front(), d_T_rx_step_s))
                 {
-                    int32_t neighbor_element;
-                    if (rx_clock > d_gnss_synchro_history->get(ch, nearest_element).Tracking_sample_counter)
-                        {
-                            neighbor_element = nearest_element + 1;
-                        }
-                    else
-                        {
-                            neighbor_element = nearest_element - 1;
-                        }
-                    if (neighbor_element < static_cast<int32_t>(d_gnss_synchro_history->size(ch)) and neighbor_element >= 0)
-                        {
-                            int32_t t1_idx;
-                            int32_t t2_idx;
-                            if (rx_clock > d_gnss_synchro_history->get(ch, nearest_element).Tracking_sample_counter)
-                                {
-                                    // std::cout << "S1= " << d_gnss_synchro_history->get(ch, nearest_element).Tracking_sample_counter
-                                    //           << " Si=" << rx_clock << " S2=" << d_gnss_synchro_history->get(ch, neighbor_element).Tracking_sample_counter << '\n';
-                                    t1_idx = nearest_element;
-                                    t2_idx = neighbor_element;
-                                }
-                            else
-                                {
-                                    // std::cout << "inv S1= " << d_gnss_synchro_history->get(ch, neighbor_element).Tracking_sample_counter
-                                    //           << " Si=" << rx_clock << " S2=" << d_gnss_synchro_history->get(ch, nearest_element).Tracking_sample_counter << '\n';
-                                    t1_idx = neighbor_element;
-                                    t2_idx = nearest_element;
-                                }
-
-                            // 1st: copy the nearest gnss_synchro data for that channel
-                            interpolated_obs = d_gnss_synchro_history->get(ch, nearest_element);
-
-                            // 2nd: Linear interpolation: y(t) = y(t1) + (y(t2) - y(t1)) * (t - t1) / (t2 - t1)
-                            const double T_rx_s = static_cast<double>(rx_clock) / static_cast<double>(interpolated_obs.fs);
-
-                            const double time_factor = (T_rx_s - d_gnss_synchro_history->get(ch, t1_idx).RX_time) /
-                                                       (d_gnss_synchro_history->get(ch, t2_idx).RX_time -
-                                                           d_gnss_synchro_history->get(ch, t1_idx).RX_time);
-
-                            // CARRIER PHASE INTERPOLATION
-                            interpolated_obs.Carrier_phase_rads = d_gnss_synchro_history->get(ch, t1_idx).Carrier_phase_rads + (d_gnss_synchro_history->get(ch, t2_idx).Carrier_phase_rads - d_gnss_synchro_history->get(ch, t1_idx).Carrier_phase_rads) * time_factor;
-                            // CARRIER DOPPLER INTERPOLATION
-                            interpolated_obs.Carrier_Doppler_hz = d_gnss_synchro_history->get(ch, t1_idx).Carrier_Doppler_hz + (d_gnss_synchro_history->get(ch, t2_idx).Carrier_Doppler_hz - d_gnss_synchro_history->get(ch, t1_idx).Carrier_Doppler_hz) * time_factor;
-                            // TOW INTERPOLATION
-                            // check TOW rollover
-                            if ((d_gnss_synchro_history->get(ch, t2_idx).TOW_at_current_symbol_ms - d_gnss_synchro_history->get(ch, t1_idx).TOW_at_current_symbol_ms) > 0)
-                                {
-                                    interpolated_obs.interp_TOW_ms = static_cast<double>(d_gnss_synchro_history->get(ch, t1_idx).TOW_at_current_symbol_ms) + (static_cast<double>(d_gnss_synchro_history->get(ch, t2_idx).TOW_at_current_symbol_ms) - static_cast<double>(d_gnss_synchro_history->get(ch, t1_idx).TOW_at_current_symbol_ms)) * time_factor;
-                                }
-                            else
-                                {
-                                    // TOW rollover situation
-                                    interpolated_obs.interp_TOW_ms = static_cast<double>(d_gnss_synchro_history->get(ch, t1_idx).TOW_at_current_symbol_ms) + (static_cast<double>(d_gnss_synchro_history->get(ch, t2_idx).TOW_at_current_symbol_ms + 604800000) - static_cast<double>(d_gnss_synchro_history->get(ch, t1_idx).TOW_at_current_symbol_ms)) * time_factor;
-                                }
-
-                            // LOG(INFO) << "Channel " << ch << " int idx: " << t1_idx << " TOW Int: " << interpolated_obs.interp_TOW_ms
-                            //           << " TOW p1 : " << d_gnss_synchro_history->get(ch, t1_idx).TOW_at_current_symbol_ms
-                            //           << " TOW p2: "
-                            //           << d_gnss_synchro_history->get(ch, t2_idx).TOW_at_current_symbol_ms
-                            //           << " t2-t1: "
-                            //           << d_gnss_synchro_history->get(ch, t2_idx).RX_time - d_gnss_synchro_history->get(ch, t1_idx).RX_time
-                            //           << " trx - t1: "
-                            //           << T_rx_s - d_gnss_synchro_history->get(ch, t1_idx).RX_time;
-                            // std::cout << "Rx samplestamp: " << T_rx_s << " Channel " << ch << " interp buff idx " << nearest_element
-                            //           << " ,diff: " << old_abs_diff << " samples (" << static_cast<double>(old_abs_diff) / static_cast<double>(d_gnss_synchro_history->get(ch, nearest_element).fs) << " s)\n";
-                            return true;
-                        }
                     return false;
                 }
-            // std::cout << "ALERT: Channel " << ch << " interp buff idx " << nearest_element
-            //           << " ,diff: " << old_abs_diff << " samples (" << static_cast<double>(old_abs_diff) / static_cast<double>(d_gnss_synchro_history->get(ch, nearest_element).fs) << " s)\n";
-            // usleep(1000);
         }
-    return false;
+    return true;
 }
 
 
 void hybrid_observables_gs::forecast(int noutput_items __attribute__((unused)), gr_vector_int &ninput_items_required)
 {
-    for (int32_t n = 0; n < static_cast<int32_t>(d_nchannels_in) - 1; n++)
+    // the epochs come from the sample clock, so that no input is required
+    for (uint32_t n = 0; n < d_nchannels_in; n++)
         {
             ninput_items_required[n] = 0;
         }
-    // last input channel is the sample counter, triggered each ms
-    ninput_items_required[d_nchannels_in - 1] = 1;
 }
 
 
@@ -523,107 +510,71 @@ void hybrid_observables_gs::update_TOW(const std::vector<Gnss_Synchro> &data)
 }
 
 
-void hybrid_observables_gs::compute_pranges(std::vector<Gnss_Synchro> &data) const
+void hybrid_observables_gs::compute_pranges()
 {
-    // std::cout.precision(17);
-    // std::cout << " d_T_rx_TOW_ms: " << static_cast<double>(d_T_rx_TOW_ms) << '\n';
-    std::vector<Gnss_Synchro>::iterator it;
-    const auto current_T_rx_TOW_ms = static_cast<double>(d_T_rx_TOW_ms);
-    const double current_T_rx_TOW_s = current_T_rx_TOW_ms / 1000.0;
-    for (it = data.begin(); it != data.end(); it++)
-        {
-            if (it->Flag_valid_word)
-                {
-                    double traveltime_ms = current_T_rx_TOW_ms - it->interp_TOW_ms;
-                    if (fabs(traveltime_ms) > 302400)  // check TOW roll over
-                        {
-                            traveltime_ms = 604800000.0 + current_T_rx_TOW_ms - it->interp_TOW_ms;
-                        }
-                    it->RX_time = current_T_rx_TOW_s;
-                    it->Pseudorange_m = traveltime_ms * SPEED_OF_LIGHT_M_MS;
-                    it->Flag_valid_pseudorange = true;
-                    // debug code
-                    // std::cout << "[" << it->Channel_ID << "] interp_TOW_ms: " << it->interp_TOW_ms << '\n';
-                    // std::cout << "[" << it->Channel_ID << "] Diff d_T_rx_TOW_ms - interp_TOW_ms: " << static_cast<double>(d_T_rx_TOW_ms) - it->interp_TOW_ms << '\n';
-                }
-            else
-                {
-                    it->RX_time = current_T_rx_TOW_s;
-                }
-        }
+    obs_compute_pseudoranges(static_cast<double>(d_T_rx_TOW_ms),
+        d_epoch_valid_word.data(),
+        d_epoch_interp_TOW_ms.data(),
+        d_epoch_pseudorange_m.data(),
+        d_epoch_valid_pseudorange.data(),
+        d_nchannels_out);
 }
 
 
-void hybrid_observables_gs::smooth_pseudoranges(std::vector<Gnss_Synchro> &data)
+double hybrid_observables_gs::compute_wavelength_m(const Gnss_Synchro &a) const
 {
-    std::vector<Gnss_Synchro>::iterator it;
-    for (it = data.begin(); it != data.end(); it++)
+    // get wavelength for the signal
+    const auto it = d_mapStringValues.find(std::string(a.Signal));
+    if (it == d_mapStringValues.cend())
         {
-            if (it->Flag_valid_pseudorange)
-                {
-                    // 0. get wavelength for the current signal
-                    double wavelength_m = 0;
-                    switch (d_mapStringValues[it->Signal])
-                        {
-                        case evGPS_1C:
-                        case evSBAS_1C:
-                        case evGAL_1B:
-                            wavelength_m = SPEED_OF_LIGHT_M_S / FREQ1;
-                            break;
-                        case evGPS_L5:
-                        case evGAL_5X:
-                            wavelength_m = SPEED_OF_LIGHT_M_S / FREQ5;
-                            break;
-                        case evGAL_E6:
-                            wavelength_m = SPEED_OF_LIGHT_M_S / FREQ6;
-                            break;
-                        case evGAL_7X:
-                            wavelength_m = SPEED_OF_LIGHT_M_S / FREQ7;
-                            break;
-                        case evGPS_2S:
-                            wavelength_m = SPEED_OF_LIGHT_M_S / FREQ2;
-                            break;
-                        case evBDS_B3:
-                            wavelength_m = SPEED_OF_LIGHT_M_S / FREQ3_BDS;
-                            break;
-                        case evGLO_1G:
-                            wavelength_m = SPEED_OF_LIGHT_M_S / FREQ1_GLO;
-                            break;
-                        case evGLO_2G:
-                            wavelength_m = SPEED_OF_LIGHT_M_S / FREQ2_GLO;
-                            break;
-                        case evBDS_B1:
-                            wavelength_m = SPEED_OF_LIGHT_M_S / FREQ1_BDS;
-                            break;
-                        case evBDS_B2:
-                            wavelength_m = SPEED_OF_LIGHT_M_S / FREQ2_BDS;
-                            break;
-                        default:
-                            break;
-                        }
-
-                    // todo: propagate the PLL lock status in Gnss_Synchro
-                    // 1. check if last PLL lock status was false and initialize last d_channel_last_pseudorange_smooth
-                    if (d_channel_last_pll_lock[it->Channel_ID] == true)
-                        {
-                            // 2. Compute the smoothed pseudorange for this channel
-                            // Hatch filter algorithm (https://insidegnss.com/can-you-list-all-the-properties-of-the-carrier-smoothing-filter/)
-                            const double r_sm = d_channel_last_pseudorange_smooth[it->Channel_ID];
-                            const double factor = ((d_smooth_filter_M - 1.0) / d_smooth_filter_M);
-                            it->Pseudorange_m = factor * r_sm + (1.0 / d_smooth_filter_M) * it->Pseudorange_m + wavelength_m * (factor / TWO_PI) * (it->Carrier_phase_rads - d_channel_last_carrier_phase_rads[it->Channel_ID]);
-                        }
-                    d_channel_last_pseudorange_smooth[it->Channel_ID] = it->Pseudorange_m;
-                    d_channel_last_carrier_phase_rads[it->Channel_ID] = it->Carrier_phase_rads;
-                    d_channel_last_pll_lock[it->Channel_ID] = it->Flag_valid_pseudorange;
-                }
-            else
-                {
-                    d_channel_last_pll_lock[it->Channel_ID] = false;
-                }
+            return 0.0;
+        }
+    switch (it->second)
+        {
+        case evGPS_1C:
+        case evSBAS_1C:
+        case evGAL_1B:
+            return SPEED_OF_LIGHT_M_S / FREQ1;
+        case evGPS_L5:
+        case evGAL_5X:
+            return SPEED_OF_LIGHT_M_S / FREQ5;
+        case evGAL_E6:
+            return SPEED_OF_LIGHT_M_S / FREQ6;
+        case evGAL_7X:
+            return SPEED_OF_LIGHT_M_S / FREQ7;
+        case evGPS_2S:
+            return SPEED_OF_LIGHT_M_S / FREQ2;
+        case evBDS_B3:
+            return SPEED_OF_LIGHT_M_S / FREQ3_BDS;
+        case evGLO_1G:
+            return SPEED_OF_LIGHT_M_S / FREQ1_GLO;
+        case evGLO_2G:
+            return SPEED_OF_LIGHT_M_S / FREQ2_GLO;
+        case evBDS_B1:
+            return SPEED_OF_LIGHT_M_S / FREQ1_BDS;
+        case evBDS_B2:
+            return SPEED_OF_LIGHT_M_S / FREQ2_BDS;
+        default:
+            return 0.0;
         }
 }
 
 
+void hybrid_observables_gs::smooth_pseudoranges()
+{
+    // todo: propagate the PLL lock status in Gnss_Synchro
+    obs_smooth_pseudoranges(d_smooth_filter_M,
+        d_epoch_valid_pseudorange.data(),
+        d_channel_wavelength_m.data(),
+        d_epoch_carrier_phase_rads.data(),
+        d_epoch_pseudorange_m.data(),
+        d_channel_last_pll_lock.data(),
+        d_channel_last_pseudorange_smooth.data(),
+        d_channel_last_carrier_phase_rads.data(),
+        d_nchannels_out);
+}
+
+
 void hybrid_observables_gs::set_tag_timestamp_in_sdr_timeframe(const std::vector<Gnss_Synchro> &data, uint64_t rx_clock)
 {
     // it transforms the HW sample tag timestamp from a relative samplestamp (from receiver start)
@@ -661,57 +612,36 @@ void hybrid_observables_gs::set_tag_timestamp_in_sdr_timeframe(const std::vector
                     //           << ", TOW: " << current_tag.tow_ms
                     //           << " [ms], TOW fraction: " << current_tag.tow_ms_fraction
                     //           << " [ms], DELTA TLM TOW: " << d_last_rx_clock_round20ms_error + delta_rxtime_to_tag * 1000.0 + static_cast<double>(current_tag.tow_ms) - static_cast<double>(d_T_rx_TOW_ms) + current_tag.tow_ms_fraction << " [ms] \n";
-                    const std::shared_ptr<GnssTime> tmp_obj = std::make_shared<GnssTime>(GnssTime());
-                    *tmp_obj = current_tag;
+                    GnssTime timetag = current_tag;
                     double intpart;
-                    tmp_obj->tow_ms_fraction = tmp_obj->tow_ms_fraction + modf(delta_rxtime_to_tag * 1000.0, &intpart);
-                    tmp_obj->tow_ms = current_tag.tow_ms + static_cast<int>(intpart);
-                    tmp_obj->rx_time = static_cast<double>(d_T_rx_TOW_ms);  // new TAG samplestamp in absolute RX time (GPS TOW frame) same as the pseudorange set
-                    add_item_tag(0, this->nitems_written(0) + 1, pmt::mp("timetag"), pmt::make_any(tmp_obj));
+                    timetag.tow_ms_fraction = timetag.tow_ms_fraction + modf(delta_rxtime_to_tag * 1000.0, &intpart);
+                    timetag.tow_ms = current_tag.tow_ms + static_cast<int>(intpart);
+                    timetag.rx_time = static_cast<double>(d_T_rx_TOW_ms);  // new TAG samplestamp in absolute RX time (GPS TOW frame) same as the pseudorange set
+                    if (d_PvtTimeTagChannel == nullptr)
+                        {
+                            d_PvtTimeTagChannel = gnss_time_tag_output_channel(this, 0);
+                        }
+                    d_PvtTimeTagChannel->push(this->nitems_written(0) + 1, timetag);
                 }
         }
 }
 
 
-int hybrid_observables_gs::general_work(int noutput_items __attribute__((unused)),
+int hybrid_observables_gs::general_work(int noutput_items,
     gr_vector_int &ninput_items, gr_vector_const_void_star &input_items,
     gr_vector_void_star &output_items)
 {
+    const Gnss_Trace_Work<gr::block> trace("observables", -1, this, ninput_items[0], noutput_items);
     const auto **in = reinterpret_cast<const Gnss_Synchro **>(&input_items[0]);
     auto **out = reinterpret_cast<Gnss_Synchro **>(&output_items[0]);
+    d_output_groups = std::max(static_cast<uint32_t>(output_items.size()) / std::max(d_nchannels_out, 1U), 1U);
+    std::fill(d_group_produced.begin(), d_group_produced.end(), 0);
 
-    // Push receiver clock into history buffer (connected to the last of the input channels)
-    // The clock buffer gives time to the channels to compute the tracking observables
-    if (ninput_items[d_nchannels_in - 1] > 0)
+    if (d_epoch_synchronous)
         {
-            d_Rx_clock_buffer.push_back(in[d_nchannels_in - 1][0].Tracking_sample_counter);
-
-            // time tags
-            std::vector<gr::tag_t> tags_vec;
-            this->get_tags_in_range(tags_vec, d_nchannels_in - 1, this->nitems_read(d_nchannels_in - 1), this->nitems_read(d_nchannels_in - 1) + 1);
-            for (const auto &it : tags_vec)
-                {
-                    try
-                        {
-                            if (pmt::any_ref(it.value).type().hash_code() == typeid(const std::shared_ptr<GnssTime>).hash_code())
-                                {
-                                    const auto timetag = boost::any_cast<const std::shared_ptr<GnssTime>>(pmt::any_ref(it.value));
-                                    // std::cout << "[Time ch ] timetag: " << timetag->rx_time << "\n";
-                                    d_TimeChannelTagTimestamps.push(*timetag);
-                                }
-                            else
-                                {
-                                    std::cout << "hash code not match\n";
-                                }
-                        }
-                    catch (const boost::bad_any_cast &e)
-                        {
-                            std::cout << "msg Bad any_cast: " << e.what();
-                        }
-                }
-
-            // Consume one item from the clock channel (last of the input channels)
-            consume(static_cast<int32_t>(d_nchannels_in) - 1, 1);
+            gather_epochs(ninput_items, in, out, noutput_items);
+            d_sample_clock->set_read_epochs(d_next_epoch);
+            return produce_outputs();
         }
 
     // Push the tracking observables into buffers to allow the observable interpolation at the desired Rx clock
@@ -756,21 +686,146 @@ int hybrid_observables_gs::general_work(int noutput_items __attribute__((unused)
                                             // LOG(INFO) << "Channel " << d_gnss_synchro_history->front(n).Channel_ID << " changed satellite to PRN " << in[n][m].PRN;
                                         }
                                 }
-                            d_gnss_synchro_history->push_back(n, in[n][m]);
-                            d_gnss_synchro_history->back(n).RX_time = compute_T_rx_s(in[n][m]);
+                            if (d_gnss_synchro_history->size(n) == 0)
+                                {
+                                    d_channel_wavelength_m[n] = compute_wavelength_m(in[n][m]);
+                                }
+                            d_gnss_synchro_history->push_back(n, in[n][m], compute_T_rx_s(in[n][m]));
                         }
                 }
             consume(n, ninput_items[n]);
         }
 
-    if (d_Rx_clock_buffer.size() == d_Rx_clock_buffer.capacity())
+    bool tracking_input = false;
+    for (uint32_t n = 0; n < d_nchannels_in; n++)
+        {
+            tracking_input = tracking_input or ninput_items[n] > 0;
+        }
+    if (!tracking_input)
+        {
+            // wait for the next epoch instead of polling the inputs
+            d_sample_clock->wait_for_epochs(d_next_epoch, std::chrono::milliseconds(std::max(d_T_rx_step_ms, 1U)));
+        }
+
+    int32_t produced = 0;
+    if (d_low_latency)
+        {
+            // epochs completed by the tracking observables just received
+            produced = output_epochs(out, produced, noutput_items);
+        }
+
+    // Push each new receiver clock epoch into the history buffer
+    // The clock buffer gives time to the channels to compute the tracking observables
+    skip_lost_epochs();
+    uint64_t rx_clock = 0;
+    while (produced < noutput_items and d_sample_clock->epoch_sample(d_next_epoch, rx_clock))
+        {
+            push_epoch(rx_clock);
+
+            const int32_t epoch_produced = output_epochs(out, produced, noutput_items);
+            if (epoch_produced == 0 and d_always_output_gs)
+                {
+                    write_epoch(out, std::vector<Gnss_Synchro>(d_nchannels_out), false, rx_clock);
+                    produced++;
+                }
+            produced += epoch_produced;
+        }
+    d_sample_clock->set_read_epochs(d_next_epoch);
+    return produce_outputs();
+}
+
+
+int32_t hybrid_observables_gs::gather_epochs(const gr_vector_int &ninput_items, const Gnss_Synchro **in, Gnss_Synchro **out, int32_t noutput_items)
+{
+    if (d_sample_clock->epochs() <= d_next_epoch)
+        {
+            // wait for the next epoch; the tracking observables after the last one stay in the input buffers
+            d_sample_clock->wait_for_epochs(d_next_epoch, std::chrono::milliseconds(std::max(d_T_rx_step_ms, 1U)));
+        }
+    skip_lost_epochs();
+    const uint64_t published_epochs = d_sample_clock->epochs();
+
+    std::fill(d_channel_items_read.begin(), d_channel_items_read.end(), 0);
+    int32_t produced = 0;
+    uint64_t rx_clock = 0;
+    while (produced < noutput_items and d_sample_clock->epoch_sample(d_next_epoch, rx_clock))
+        {
+            // each channel reads its tracking observables up to the epoch, and keeps the nearest ones
+            bool ready = true;
+            for (uint32_t n = 0; n < d_nchannels_out; n++)
+                {
+                    bool complete = false;
+                    d_channel_items_read[n] += d_epoch_gather->read(n, in[n] + d_channel_items_read[n], ninput_items[n] - d_channel_items_read[n], rx_clock, d_T_rx_step_s, complete);
+                    if (d_channel_wavelength_m[n] == 0.0 and d_epoch_gather->has_synchro(n))
+                        {
+                            d_channel_wavelength_m[n] = compute_wavelength_m(d_epoch_gather->latest(n));
+                        }
+                    ready = ready and complete;
+                }
+            // a channel does not hold the epoch longer than the clock buffer of the interpolation mode
+            if (!ready and published_epochs - d_next_epoch < d_Rx_clock_buffer.capacity())
+                {
+                    break;
+                }
+            push_epoch(rx_clock);
+
+            const int32_t epoch_produced = output_epochs(out, produced, noutput_items);
+            if (epoch_produced == 0 and d_always_output_gs)
+                {
+                    write_epoch(out, std::vector<Gnss_Synchro>(d_nchannels_out), false, rx_clock);
+                    produced++;
+                }
+            produced += epoch_produced;
+        }
+    for (uint32_t n = 0; n < d_nchannels_out; n++)
+        {
+            consume(n, d_channel_items_read[n]);
+        }
+    return produced;
+}
+
+
+void hybrid_observables_gs::skip_lost_epochs()
+{
+    const uint64_t published_epochs = d_sample_clock->epochs();
+    if (published_epochs - d_next_epoch > Gnss_Sample_Clock::capacity)
+        {
+            const uint64_t lost_epochs = published_epochs - Gnss_Sample_Clock::capacity - d_next_epoch;
+            LOG(WARNING) << "Observables lost " << lost_epochs << " epochs of the receiver clock";
+            d_sample_clock->add_skipped_epochs(lost_epochs);
+            d_next_epoch = published_epochs - Gnss_Sample_Clock::capacity;
+        }
+}
+
+
+void hybrid_observables_gs::push_epoch(uint64_t rx_clock)
+{
+    d_Rx_clock_buffer.push_back(rx_clock);
+
+    // time tags
+    GnssTime timetag{};
+    while (d_TimeChannelTagReader.next(d_next_epoch, d_next_epoch + 1, timetag))
         {
-            std::vector<Gnss_Synchro> epoch_data(d_nchannels_out);
+            d_TimeChannelTagTimestamps.push(timetag);
+        }
+    d_next_epoch++;
+}
+
+
+int32_t hybrid_observables_gs::output_epochs(Gnss_Synchro **out, int32_t produced, int32_t noutput_items)
+{
+    const int32_t first_output = produced;
+    // Each epoch goes out once: the oldest clock is overwritten by the next one
+    // or, in low latency mode, removed after its output
+    while (produced < noutput_items and epoch_ready())
+        {
+            const uint64_t rx_clock = d_Rx_clock_buffer.front();
+            std::vector<Gnss_Synchro> &epoch_data = d_epoch_data;
             int32_t n_valid = 0;
             for (uint32_t n = 0; n < d_nchannels_out; n++)
                 {
-                    Gnss_Synchro interpolated_gnss_synchro{};
-                    if (!interp_trk_obs(interpolated_gnss_synchro, n, d_Rx_clock_buffer.front()))
+                    Gnss_Synchro &interpolated_gnss_synchro = epoch_data[n];
+                    if (!interp_trk_obs(interpolated_gnss_synchro, n, rx_clock))
                         {
                             // Produce an empty observation
                             interpolated_gnss_synchro = Gnss_Synchro();
@@ -784,7 +839,11 @@ int hybrid_observables_gs::general_work(int noutput_items __attribute__((unused)
                         {
                             n_valid++;
                         }
-                    epoch_data[n] = interpolated_gnss_synchro;
+                    d_epoch_interp_TOW_ms[n] = interpolated_gnss_synchro.interp_TOW_ms;
+                    d_epoch_pseudorange_m[n] = interpolated_gnss_synchro.Pseudorange_m;
+                    d_epoch_carrier_phase_rads[n] = interpolated_gnss_synchro.Carrier_phase_rads;
+                    d_epoch_valid_word[n] = interpolated_gnss_synchro.Flag_valid_word;
+                    d_epoch_valid_pseudorange[n] = interpolated_gnss_synchro.Flag_valid_pseudorange;
                 }
 
             if (d_T_rx_TOW_set)
@@ -799,23 +858,34 @@ int hybrid_observables_gs::general_work(int noutput_items __attribute__((unused)
                         }
                 }
 
+            // pseudoranges and carrier smoothing of all the channels, over the epoch columns
             if (n_valid > 0)
                 {
-                    compute_pranges(epoch_data);
-                    set_tag_timestamp_in_sdr_timeframe(epoch_data, d_Rx_clock_buffer.front());
+                    compute_pranges();
                 }
 
             // Carrier smoothing (optional)
             if (d_conf.enable_carrier_smoothing == true)
                 {
-                    smooth_pseudoranges(epoch_data);
+                    smooth_pseudoranges();
                 }
 
-            // output the observables set to the PVT block
+            const double current_T_rx_TOW_s = static_cast<double>(d_T_rx_TOW_ms) / 1000.0;
             for (uint32_t n = 0; n < d_nchannels_out; n++)
                 {
-                    out[n][0] = epoch_data[n];
+                    if (n_valid > 0)
+                        {
+                            epoch_data[n].RX_time = current_T_rx_TOW_s;
+                        }
+                    epoch_data[n].Pseudorange_m = d_epoch_pseudorange_m[n];
+                    epoch_data[n].Flag_valid_pseudorange = d_epoch_valid_pseudorange[n];
+                }
+
+            if (n_valid > 0)
+                {
+                    set_tag_timestamp_in_sdr_timeframe(epoch_data, rx_clock);
                 }
+
             // report channel status every second
             d_T_status_report_timer_ms += d_T_rx_step_ms;
             if (d_T_status_report_timer_ms >= 1000)
@@ -837,19 +907,19 @@ int hybrid_observables_gs::general_work(int noutput_items __attribute__((unused)
                             double tmp_double;
                             for (uint32_t i = 0; i < d_nchannels_out; i++)
                                 {
-                                    tmp_double = out[i][0].RX_time;
+                                    tmp_double = epoch_data[i].RX_time;
                                     d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = out[i][0].interp_TOW_ms / 1000.0;
+                                    tmp_double = epoch_data[i].interp_TOW_ms / 1000.0;
                                     d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = out[i][0].Carrier_Doppler_hz;
+                                    tmp_double = epoch_data[i].Carrier_Doppler_hz;
                                     d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = out[i][0].Carrier_phase_rads / TWO_PI;
+                                    tmp_double = epoch_data[i].Carrier_phase_rads / TWO_PI;
                                     d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = out[i][0].Pseudorange_m;
+                                    tmp_double = epoch_data[i].Pseudorange_m;
                                     d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = static_cast<double>(out[i][0].PRN);
+                                    tmp_double = static_cast<double>(epoch_data[i].PRN);
                                     d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                                    tmp_double = static_cast<double>(out[i][0].Flag_valid_pseudorange);
+                                    tmp_double = static_cast<double>(epoch_data[i].Flag_valid_pseudorange);
                                     d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
                                 }
                         }
@@ -864,17 +934,68 @@ int hybrid_observables_gs::general_work(int noutput_items __attribute__((unused)
                 {
                     // LOG(INFO) << "OBS: diff time: " << out[0][0].RX_time * 1000.0 - old_time_debug;
                     // old_time_debug = out[0][0].RX_time * 1000.0;
-                    return 1;
+                    // output the observables set to the PVT block and the monitors
+                    write_epoch(out, epoch_data, d_pipeline_latency != nullptr, rx_clock);
+                    produced++;
+                }
+            if (!d_low_latency and !d_epoch_synchronous)
+                {
+                    break;
                 }
+            d_Rx_clock_buffer.pop_front();
         }
-    if (d_always_output_gs)
+    return produced - first_output;
+}
+
+
+void hybrid_observables_gs::write_epoch(Gnss_Synchro **out, const std::vector<Gnss_Synchro> &epoch_data, bool tag_rx_clock, uint64_t rx_clock)
+{
+    for (uint32_t group = 0; group < d_output_groups; group++)
         {
-            Gnss_Synchro empty_gs{};
+            if (!group_takes_epoch(group))
+                {
+                    continue;
+                }
+            const uint32_t first_output = group * d_nchannels_out;
             for (uint32_t n = 0; n < d_nchannels_out; n++)
                 {
-                    out[n][0] = empty_gs;
+                    out[first_output + n][d_group_produced[group]] = epoch_data[n];
                 }
-            return 1;
+            if (tag_rx_clock and group == 0)
+                {
+                    this->add_item_tag(0, this->nitems_written(0) + d_group_produced[group], pmt::mp("rx_sample"), pmt::from_uint64(rx_clock));
+                }
+            d_group_produced[group]++;
         }
-    return 0;
+    d_epochs_written++;
+}
+
+
+bool hybrid_observables_gs::group_takes_epoch(uint32_t group) const
+{
+    const uint32_t decimation = d_output_decimation[group];
+    if (decimation == 1)
+        {
+            return true;
+        }
+    // aligned to the receiver time, once it is set
+    if (d_T_rx_TOW_set)
+        {
+            return d_T_rx_TOW_ms % (decimation * d_T_rx_step_ms) == 0;
+        }
+    return d_epochs_written % decimation == 0;
+}
+
+
+int hybrid_observables_gs::produce_outputs()
+{
+    // each group produces the epochs of its own interval
+    for (uint32_t group = 0; group < d_output_groups; group++)
+        {
+            for (uint32_t n = 0; n < d_nchannels_out; n++)
+                {
+                    produce(static_cast<int>(group * d_nchannels_out + n), d_group_produced[group]);
+                }
+        }
+    return this->WORK_CALLED_PRODUCE;
 }
@@ -21,7 +21,10 @@
 #define GNSS_SDR_HYBRID_OBSERVABLES_GS_H
 
 #include "gnss_block_interface.h"
+#include "gnss_pipeline_latency.h"
+#include "gnss_sample_clock.h"
 #include "gnss_time.h"  // for timetags produced by Tracking
+#include "gnss_time_tag_channel.h"
 #include "obs_conf.h"
 #include <boost/circular_buffer.hpp>  // for boost::circular_buffer
 #include <gnuradio/block.h>           // for block
@@ -44,11 +47,10 @@
 
 
 class Gnss_Synchro;
+class Gnss_Synchro_Epoch_Gather;
+class Gnss_Synchro_History;
 class hybrid_observables_gs;
 
-template <class T>
-class Gnss_circular_deque;
-
 using hybrid_observables_gs_sptr = gnss_shared_ptr<hybrid_observables_gs>;
 
 hybrid_observables_gs_sptr hybrid_observables_gs_make(const Obs_Conf& conf_);
@@ -74,9 +76,18 @@ private:
     void msg_handler_pvt_to_observables(const pmt::pmt_t& msg);
     double compute_T_rx_s(const Gnss_Synchro& a) const;
     bool interp_trk_obs(Gnss_Synchro& interpolated_obs, uint32_t ch, uint64_t rx_clock) const;
+    bool epoch_ready() const;
+    int32_t output_epochs(Gnss_Synchro** out, int32_t produced, int32_t noutput_items);
+    void write_epoch(Gnss_Synchro** out, const std::vector<Gnss_Synchro>& epoch_data, bool tag_rx_clock, uint64_t rx_clock);
+    bool group_takes_epoch(uint32_t group) const;
+    int produce_outputs();
+    int32_t gather_epochs(const gr_vector_int& ninput_items, const Gnss_Synchro** in, Gnss_Synchro** out, int32_t noutput_items);
+    void skip_lost_epochs();
+    void push_epoch(uint64_t rx_clock);
+    double compute_wavelength_m(const Gnss_Synchro& a) const;
     void update_TOW(const std::vector<Gnss_Synchro>& data);
-    void compute_pranges(std::vector<Gnss_Synchro>& data) const;
-    void smooth_pseudoranges(std::vector<Gnss_Synchro>& data);
+    void compute_pranges();
+    void smooth_pseudoranges();
 
     void set_tag_timestamp_in_sdr_timeframe(const std::vector<Gnss_Synchro>& data, uint64_t rx_clock);
     int32_t save_matfile() const;
@@ -101,16 +112,38 @@ private:
     };
     std::map<std::string, StringValue_> d_mapStringValues;
 
-    std::unique_ptr<Gnss_circular_deque<Gnss_Synchro>> d_gnss_synchro_history;  // Tracking observable history
+    std::unique_ptr<Gnss_Synchro_History> d_gnss_synchro_history;  // Tracking observable history
+    std::unique_ptr<Gnss_Synchro_Epoch_Gather> d_epoch_gather;     // Latest tracking observables, in epoch-synchronous mode
+    std::vector<int32_t> d_channel_items_read;                     // tracking observables read from each input in epoch-synchronous mode
 
     boost::circular_buffer<uint64_t> d_Rx_clock_buffer;  // time history
+    std::shared_ptr<Gnss_Sample_Clock> d_sample_clock;   // epochs published by the sample counter
+    uint64_t d_next_epoch{0};                            // index of the next epoch to read from d_sample_clock
 
     std::vector<std::queue<GnssTime>> d_SourceTagTimestamps;
     std::queue<GnssTime> d_TimeChannelTagTimestamps;
-
-    std::vector<bool> d_channel_last_pll_lock;
+    Gnss_Time_Tag_Reader d_TimeChannelTagReader;                 // time tags of the epochs, produced by the sample counter
+    std::shared_ptr<Gnss_Time_Tag_Channel> d_PvtTimeTagChannel;  // time tags for the PVT block
+    std::shared_ptr<Gnss_Pipeline_Latency> d_pipeline_latency;   // if set, the epochs are tagged with their sample counter
+
+    // observables of the current epoch, and the columns used by the pseudorange and smoothing kernels
+    std::vector<Gnss_Synchro> d_epoch_data;
+    std::vector<double> d_epoch_interp_TOW_ms;
+    std::vector<double> d_epoch_pseudorange_m;
+    std::vector<double> d_epoch_carrier_phase_rads;
+    std::vector<uint8_t> d_epoch_valid_word;
+    std::vector<uint8_t> d_epoch_valid_pseudorange;
+
+    std::vector<uint8_t> d_channel_last_pll_lock;
     std::vector<double> d_channel_last_pseudorange_smooth;
     std::vector<double> d_channel_last_carrier_phase_rads;
+    std::vector<double> d_channel_wavelength_m;
+
+    // groups of d_nchannels_out outputs, each one at its own interval
+    std::vector<uint32_t> d_output_decimation;  // epochs of the receiver clock per output epoch of each group
+    std::vector<int32_t> d_group_produced;      // epochs written to each group in the current call
+    uint64_t d_epochs_written{0};               // epochs given to the groups
+    uint32_t d_output_groups{1};                // groups connected to other blocks
 
     std::string d_dump_filename;
 
@@ -128,6 +161,8 @@ private:
 
     bool d_T_rx_TOW_set;  // rx time follow GPST
     bool d_always_output_gs;
+    bool d_low_latency;
+    bool d_epoch_synchronous;
     bool d_dump;
     bool d_dump_mat;
 };
@@ -0,0 +1,128 @@
+/*!
+ * \file gnss_synchro_epoch_gather.cc
+ * \brief Latest tracking observables of each channel, propagated with their
+ * NCO state to the epochs of the receiver clock.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_synchro_epoch_gather.h"
+#include "MATH_CONSTANTS.h"  // for TWO_PI
+#include <cmath>             // for std::fabs
+
+
+namespace
+{
+// receiver time of the tracking observables [s]
+double rx_time_s(const Gnss_Synchro& synchro)
+{
+    return (static_cast<double>(synchro.Tracking_sample_counter) + synchro.Code_phase_samples) / static_cast<double>(synchro.fs);
+}
+}  // namespace
+
+
+Gnss_Synchro_Epoch_Gather::Gnss_Synchro_Epoch_Gather(uint32_t nchann)
+    : d_synchro(nchann),
+      d_valid(nchann, 0)
+{
+}
+
+
+bool Gnss_Synchro_Epoch_Gather::has_synchro(uint32_t ch) const
+{
+    return d_valid[ch] != 0;
+}
+
+
+const Gnss_Synchro& Gnss_Synchro_Epoch_Gather::latest(uint32_t ch) const
+{
+    return d_synchro[ch];
+}
+
+
+void Gnss_Synchro_Epoch_Gather::clear(uint32_t ch)
+{
+    d_valid[ch] = 0;
+}
+
+
+int32_t Gnss_Synchro_Epoch_Gather::read(uint32_t ch, const Gnss_Synchro* in, int32_t n, uint64_t rx_clock, double max_distance_s, bool& complete)
+{
+    for (int32_t m = 0; m < n; m++)
+        {
+            const Gnss_Synchro& synchro = in[m];
+            if (!synchro.Flag_valid_word)
+                {
+                    continue;
+                }
+            if (d_valid[ch] and (d_synchro[ch].PRN != synchro.PRN or synchro.Tracking_sample_counter < d_synchro[ch].Tracking_sample_counter))
+                {
+                    // new satellite, or new tracking of the satellite
+                    d_valid[ch] = 0;
+                }
+            const double rx_time = rx_time_s(synchro);
+            const double epoch_s = static_cast<double>(rx_clock) / static_cast<double>(synchro.fs);
+            if (rx_time > epoch_s)
+                {
+                    // first observables after the epoch: keep them if they are the nearest ones
+                    complete = true;
+                    if (d_valid[ch] and epoch_s - d_synchro[ch].RX_time <= rx_time - epoch_s)
+                        {
+                            return m;
+                        }
+                    d_synchro[ch] = synchro;
+                    d_synchro[ch].RX_time = rx_time;
+                    d_valid[ch] = 1;
+                    return m + 1;
+                }
+            d_synchro[ch] = synchro;
+            d_synchro[ch].RX_time = rx_time;
+            d_valid[ch] = 1;
+        }
+    if (!d_valid[ch])
+        {
+            complete = true;
+            return n;
+        }
+    const double epoch_s = static_cast<double>(rx_clock) / static_cast<double>(d_synchro[ch].fs);
+    complete = d_synchro[ch].RX_time >= epoch_s or epoch_s - d_synchro[ch].RX_time > max_distance_s;
+    return n;
+}
+
+
+bool Gnss_Synchro_Epoch_Gather::propagate(uint32_t ch, uint64_t rx_clock, double max_distance_s, double carrier_freq_hz, Gnss_Synchro& obs) const
+{
+    if (!d_valid[ch])
+        {
+            return false;
+        }
+    const Gnss_Synchro& synchro = d_synchro[ch];
+    const double dt_s = static_cast<double>(rx_clock) / static_cast<double>(synchro.fs) - synchro.RX_time;
+    if (std::fabs(dt_s) >= max_distance_s)
+        {
+            return false;
+        }
+    obs = synchro;
+    // the carrier NCO accumulates the phase with the opposite sign of the Doppler
+    obs.Carrier_phase_rads = synchro.Carrier_phase_rads - TWO_PI * synchro.Carrier_Doppler_hz * dt_s;
+    // with carrier aiding, the code runs faster than nominal by the Doppler over the carrier frequency
+    const double code_rate = (carrier_freq_hz > 0.0) ? 1.0 + synchro.Carrier_Doppler_hz / carrier_freq_hz : 1.0;
+    obs.interp_TOW_ms = static_cast<double>(synchro.TOW_at_current_symbol_ms) + dt_s * 1000.0 * code_rate;
+    if (obs.interp_TOW_ms < 0.0)
+        {
+            obs.interp_TOW_ms += 604800000.0;
+        }
+    else if (obs.interp_TOW_ms >= 604800000.0)
+        {
+            obs.interp_TOW_ms -= 604800000.0;
+        }
+    return true;
+}
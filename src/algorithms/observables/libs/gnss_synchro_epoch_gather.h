@@ -0,0 +1,78 @@
+/*!
+ * \file gnss_synchro_epoch_gather.h
+ * \brief Latest tracking observables of each channel, propagated with their
+ * NCO state to the epochs of the receiver clock.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SYNCHRO_EPOCH_GATHER_H
+#define GNSS_SDR_GNSS_SYNCHRO_EPOCH_GATHER_H
+
+#include "gnss_synchro.h"
+#include <cstdint>
+#include <vector>
+
+/** \addtogroup Observables
+ * \{ */
+/** \addtogroup Observables_libs observables_libs
+ * \{ */
+
+
+/*!
+ * \brief Gathers the observables of the channels at the epochs of the
+ * receiver clock, without a history.
+ *
+ * All the channels run on the same sample clock, so the observables of a
+ * channel at an epoch follow from its tracking observables nearest to the
+ * epoch, and the carrier Doppler of its NCO, which is constant over an
+ * integration. Each channel keeps a single Gnss_Synchro object, and the
+ * tracking observables after the epoch are left in the input buffer of the
+ * block until the next one.
+ */
+class Gnss_Synchro_Epoch_Gather
+{
+public:
+    explicit Gnss_Synchro_Epoch_Gather(uint32_t nchann);  //!< nchann = number of channels
+
+    bool has_synchro(uint32_t ch) const;           //!< Returns true if channel ch has tracking observables
+    const Gnss_Synchro& latest(uint32_t ch) const;  //!< Returns the tracking observables kept for channel ch
+    void clear(uint32_t ch);                       //!< Removes the tracking observables of a channel
+
+    /*!
+     * \brief Reads the tracking observables in[0], ..., in[n - 1] of channel
+     * ch, in order, up to the receiver sample counter rx_clock, and keeps the
+     * nearest one to rx_clock. Returns the number of them read; the others
+     * must be read again for the next epoch. complete is set to true if the
+     * channel cannot get a nearer one: it has one after rx_clock, it has
+     * none, or its latest one is more than max_distance_s seconds before
+     * rx_clock.
+     */
+    int32_t read(uint32_t ch, const Gnss_Synchro* in, int32_t n, uint64_t rx_clock, double max_distance_s, bool& complete);
+
+    /*!
+     * \brief Propagates the tracking observables of channel ch, of carrier
+     * frequency carrier_freq_hz, to the receiver sample counter rx_clock: the
+     * carrier phase and the TOW advance with the carrier Doppler. Returns
+     * false if the channel has no tracking observables, or if they are more
+     * than max_distance_s seconds away.
+     */
+    bool propagate(uint32_t ch, uint64_t rx_clock, double max_distance_s, double carrier_freq_hz, Gnss_Synchro& obs) const;
+
+private:
+    std::vector<Gnss_Synchro> d_synchro;  // RX_time holds the receiver time of the observables [s]
+    std::vector<uint8_t> d_valid;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SYNCHRO_EPOCH_GATHER_H
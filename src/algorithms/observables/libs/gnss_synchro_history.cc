@@ -0,0 +1,186 @@
+/*!
+ * \file gnss_synchro_history.cc
+ * \brief History of the tracking observables of each channel, stored by
+ * columns, with the interpolation of the observables at a receiver time.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_synchro_history.h"
+#include <cstdlib>  // for llabs
+
+
+Gnss_Synchro_History::Gnss_Synchro_History(uint32_t max_size, uint32_t nchann)
+    : d_synchro(static_cast<std::size_t>(max_size) * nchann),
+      d_sample_counter(static_cast<std::size_t>(max_size) * nchann),
+      d_rx_time(static_cast<std::size_t>(max_size) * nchann),
+      d_carrier_phase_rads(static_cast<std::size_t>(max_size) * nchann),
+      d_carrier_doppler_hz(static_cast<std::size_t>(max_size) * nchann),
+      d_tow_ms(static_cast<std::size_t>(max_size) * nchann),
+      d_head(nchann, 0U),
+      d_size(nchann, 0U),
+      d_max_size(max_size)
+{
+}
+
+
+uint32_t Gnss_Synchro_History::slot(uint32_t ch, uint32_t pos) const
+{
+    uint32_t p = d_head[ch] + pos;
+    if (p >= d_max_size)
+        {
+            p -= d_max_size;
+        }
+    return ch * d_max_size + p;
+}
+
+
+uint32_t Gnss_Synchro_History::size(uint32_t ch) const
+{
+    return d_size[ch];
+}
+
+
+const Gnss_Synchro& Gnss_Synchro_History::front(uint32_t ch) const
+{
+    return d_synchro[slot(ch, 0)];
+}
+
+
+void Gnss_Synchro_History::clear(uint32_t ch)
+{
+    d_head[ch] = 0;
+    d_size[ch] = 0;
+}
+
+
+void Gnss_Synchro_History::push_back(uint32_t ch, const Gnss_Synchro& synchro, double rx_time)
+{
+    if (d_max_size == 0)
+        {
+            return;
+        }
+    // the binary search requires increasing sample counters
+    if (d_size[ch] > 0 and synchro.Tracking_sample_counter < d_sample_counter[slot(ch, d_size[ch] - 1)])
+        {
+            clear(ch);
+        }
+    uint32_t s;
+    if (d_size[ch] == d_max_size)
+        {
+            // overwrite the oldest element
+            s = slot(ch, 0);
+            d_head[ch] = (d_head[ch] + 1 == d_max_size) ? 0 : d_head[ch] + 1;
+        }
+    else
+        {
+            s = slot(ch, d_size[ch]);
+            d_size[ch]++;
+        }
+    d_synchro[s] = synchro;
+    d_synchro[s].RX_time = rx_time;
+    d_sample_counter[s] = synchro.Tracking_sample_counter;
+    d_rx_time[s] = rx_time;
+    d_carrier_phase_rads[s] = synchro.Carrier_phase_rads;
+    d_carrier_doppler_hz[s] = synchro.Carrier_Doppler_hz;
+    d_tow_ms[s] = synchro.TOW_at_current_symbol_ms;
+}
+
+
+bool Gnss_Synchro_History::interpolate(uint32_t ch, uint64_t rx_clock, double max_distance_s, Gnss_Synchro& interpolated_obs) const
+{
+    const auto n = static_cast<int32_t>(d_size[ch]);
+    if (n == 0)
+        {
+            return false;
+        }
+
+    // first element with a sample counter not lower than rx_clock
+    int32_t lo = 0;
+    int32_t hi = n;
+    while (lo < hi)
+        {
+            const int32_t mid = lo + (hi - lo) / 2;
+            if (d_sample_counter[slot(ch, mid)] < rx_clock)
+                {
+                    lo = mid + 1;
+                }
+            else
+                {
+                    hi = mid;
+                }
+        }
+
+    // nearest element (the oldest one, if two of them are at the same distance)
+    int32_t nearest_element = lo;
+    if (lo == n or (lo > 0 and rx_clock - d_sample_counter[slot(ch, lo - 1)] <= d_sample_counter[slot(ch, lo)] - rx_clock))
+        {
+            nearest_element = lo - 1;
+            while (nearest_element > 0 and d_sample_counter[slot(ch, nearest_element - 1)] == d_sample_counter[slot(ch, nearest_element)])
+                {
+                    nearest_element--;
+                }
+        }
+    const uint32_t nearest = slot(ch, nearest_element);
+    const int64_t abs_diff = llabs(static_cast<int64_t>(rx_clock) - static_cast<int64_t>(d_sample_counter[nearest]));
+    if ((static_cast<double>(abs_diff) / static_cast<double>(d_synchro[nearest].fs)) >= max_distance_s)
+        {
+            return false;
+        }
+
+    const int32_t neighbor_element = (rx_clock > d_sample_counter[nearest]) ? nearest_element + 1 : nearest_element - 1;
+    if (neighbor_element >= n or neighbor_element < 0)
+        {
+            return false;
+        }
+    const uint32_t neighbor = slot(ch, neighbor_element);
+    const uint32_t t1 = (rx_clock > d_sample_counter[nearest]) ? nearest : neighbor;
+    const uint32_t t2 = (rx_clock > d_sample_counter[nearest]) ? neighbor : nearest;
+
+    // 1st: copy the nearest gnss_synchro data for that channel
+    interpolated_obs = d_synchro[nearest];
+
+    // 2nd: Linear interpolation: y(t) = y(t1) + (y(t2) - y(t1)) * (t - t1) / (t2 - t1)
+    const double T_rx_s = static_cast<double>(rx_clock) / static_cast<double>(interpolated_obs.fs);
+    const double time_factor = (T_rx_s - d_rx_time[t1]) / (d_rx_time[t2] - d_rx_time[t1]);
+
+    // CARRIER PHASE INTERPOLATION
+    interpolated_obs.Carrier_phase_rads = d_carrier_phase_rads[t1] + (d_carrier_phase_rads[t2] - d_carrier_phase_rads[t1]) * time_factor;
+    // CARRIER DOPPLER INTERPOLATION
+    interpolated_obs.Carrier_Doppler_hz = d_carrier_doppler_hz[t1] + (d_carrier_doppler_hz[t2] - d_carrier_doppler_hz[t1]) * time_factor;
+    // TOW INTERPOLATION
+    // check TOW rollover
+    if ((d_tow_ms[t2] - d_tow_ms[t1]) > 0)
+        {
+            interpolated_obs.interp_TOW_ms = static_cast<double>(d_tow_ms[t1]) + (static_cast<double>(d_tow_ms[t2]) - static_cast<double>(d_tow_ms[t1])) * time_factor;
+        }
+    else
+        {
+            // TOW rollover situation
+            interpolated_obs.interp_TOW_ms = static_cast<double>(d_tow_ms[t1]) + (static_cast<double>(d_tow_ms[t2] + 604800000) - static_cast<double>(d_tow_ms[t1])) * time_factor;
+        }
+    return true;
+}
+
+
+bool Gnss_Synchro_History::is_complete(uint32_t ch, uint64_t rx_clock, double max_distance_s) const
+{
+    if (d_size[ch] == 0)
+        {
+            return true;
+        }
+    const uint32_t newest = slot(ch, d_size[ch] - 1);
+    if (d_sample_counter[newest] >= rx_clock)
+        {
+            return true;
+        }
+    return static_cast<double>(rx_clock - d_sample_counter[newest]) / static_cast<double>(d_synchro[newest].fs) > max_distance_s;
+}
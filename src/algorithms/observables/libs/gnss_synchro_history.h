@@ -0,0 +1,83 @@
+/*!
+ * \file gnss_synchro_history.h
+ * \brief History of the tracking observables of each channel, stored by
+ * columns, with the interpolation of the observables at a receiver time.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SYNCHRO_HISTORY_H
+#define GNSS_SDR_GNSS_SYNCHRO_HISTORY_H
+
+#include "gnss_synchro.h"
+#include <cstdint>
+#include <vector>
+
+/** \addtogroup Observables
+ * \{ */
+/** \addtogroup Observables_libs observables_libs
+ * \{ */
+
+
+/*!
+ * \brief Fixed-capacity history of the Gnss_Synchro objects of each channel.
+ *
+ * The fields used to interpolate the observables (sample counter, receiver
+ * time, carrier phase, Doppler and TOW) are kept in contiguous rings, apart
+ * from the full objects, so the interpolation only reads a few cache lines
+ * and copies a single Gnss_Synchro object. The elements of a channel must be
+ * pushed in increasing order of Tracking_sample_counter; the nearest element
+ * to a receiver time is found by binary search.
+ */
+class Gnss_Synchro_History
+{
+public:
+    Gnss_Synchro_History(uint32_t max_size, uint32_t nchann);  //!< nchann = number of channels; max_size = channel capacity
+
+    uint32_t size(uint32_t ch) const;                //!< Returns the number of available elements in a channel
+    const Gnss_Synchro& front(uint32_t ch) const;    //!< Returns the oldest element of a channel
+    void clear(uint32_t ch);                         //!< Removes all the elements of a channel
+    void push_back(uint32_t ch, const Gnss_Synchro& synchro, double rx_time);  //!< Inserts an element, with its receiver time [s], replacing the oldest one if the channel is full
+
+    /*!
+     * \brief Interpolates the observables of channel ch at the receiver
+     * sample counter rx_clock, between the two elements around it. Returns
+     * false if there are no such elements, or if the nearest one is more than
+     * max_distance_s seconds away.
+     */
+    bool interpolate(uint32_t ch, uint64_t rx_clock, double max_distance_s, Gnss_Synchro& interpolated_obs) const;
+
+    /*!
+     * \brief Returns true if channel ch cannot get any element that changes
+     * its interpolation at rx_clock: it is empty, it already has an element
+     * at or after rx_clock, or its newest element is more than
+     * max_distance_s seconds before rx_clock.
+     */
+    bool is_complete(uint32_t ch, uint64_t rx_clock, double max_distance_s) const;
+
+private:
+    uint32_t slot(uint32_t ch, uint32_t pos) const;  // position in the rings of the element pos of channel ch
+
+    std::vector<Gnss_Synchro> d_synchro;
+    std::vector<uint64_t> d_sample_counter;
+    std::vector<double> d_rx_time;
+    std::vector<double> d_carrier_phase_rads;
+    std::vector<double> d_carrier_doppler_hz;
+    std::vector<uint32_t> d_tow_ms;
+    std::vector<uint32_t> d_head;
+    std::vector<uint32_t> d_size;
+    uint32_t d_max_size;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SYNCHRO_HISTORY_H
@@ -20,6 +20,7 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
 
 /** \addtogroup Observables
  * \{ */
@@ -37,8 +38,11 @@ public:
     uint32_t nchannels_in{0U};
     uint32_t nchannels_out{0U};
     uint32_t observable_interval_ms{20U};
+    std::vector<uint32_t> output_intervals_ms;  // of each group of nchannels_out outputs, multiples of observable_interval_ms (a single group at observable_interval_ms if empty)
     bool enable_carrier_smoothing{false};
     bool always_output_gs{false};
+    bool low_latency{false};
+    bool epoch_synchronous{false};
     bool dump{false};
     bool dump_mat{false};
 };
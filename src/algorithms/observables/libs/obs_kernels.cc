@@ -0,0 +1,61 @@
+/*!
+ * \file obs_kernels.cc
+ * \brief Computation of the pseudoranges and carrier smoothing of all the
+ * channels of an observables epoch, over contiguous arrays.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "obs_kernels.h"
+#include "MATH_CONSTANTS.h"  // for SPEED_OF_LIGHT_M_MS, TWO_PI
+#include <cmath>             // for std::fabs
+
+
+void obs_compute_pseudoranges(double rx_tow_ms,
+    const uint8_t* valid_word,
+    const double* interp_tow_ms,
+    double* pseudorange_m,
+    uint8_t* valid_pseudorange,
+    uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++)
+        {
+            const double traveltime_ms = rx_tow_ms - interp_tow_ms[i];
+            // check TOW roll over
+            const double pseudorange = ((std::fabs(traveltime_ms) > 302400) ? 604800000.0 + rx_tow_ms - interp_tow_ms[i] : traveltime_ms) * SPEED_OF_LIGHT_M_MS;
+            pseudorange_m[i] = valid_word[i] ? pseudorange : pseudorange_m[i];
+            valid_pseudorange[i] = valid_pseudorange[i] | valid_word[i];
+        }
+}
+
+
+void obs_smooth_pseudoranges(double M,
+    const uint8_t* valid_pseudorange,
+    const double* wavelength_m,
+    const double* carrier_phase_rads,
+    double* pseudorange_m,
+    uint8_t* last_valid,
+    double* last_pseudorange_m,
+    double* last_carrier_phase_rads,
+    uint32_t n)
+{
+    // Hatch filter algorithm (https://insidegnss.com/can-you-list-all-the-properties-of-the-carrier-smoothing-filter/)
+    const double factor = ((M - 1.0) / M);
+    for (uint32_t i = 0; i < n; i++)
+        {
+            const double smoothed = factor * last_pseudorange_m[i] + (1.0 / M) * pseudorange_m[i] + wavelength_m[i] * (factor / TWO_PI) * (carrier_phase_rads[i] - last_carrier_phase_rads[i]);
+            const bool valid = valid_pseudorange[i] != 0;
+            pseudorange_m[i] = (valid_pseudorange[i] & last_valid[i]) ? smoothed : pseudorange_m[i];
+            last_pseudorange_m[i] = valid ? pseudorange_m[i] : last_pseudorange_m[i];
+            last_carrier_phase_rads[i] = valid ? carrier_phase_rads[i] : last_carrier_phase_rads[i];
+            last_valid[i] = valid_pseudorange[i];
+        }
+}
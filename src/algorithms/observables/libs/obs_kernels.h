@@ -0,0 +1,68 @@
+/*!
+ * \file obs_kernels.h
+ * \brief Computation of the pseudoranges and carrier smoothing of all the
+ * channels of an observables epoch, over contiguous arrays.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_OBS_KERNELS_H
+#define GNSS_SDR_OBS_KERNELS_H
+
+#include <cstdint>
+
+/** \addtogroup Observables
+ * \{ */
+/** \addtogroup Observables_libs
+ * \{ */
+
+
+/*!
+ * \brief Computes the pseudorange [m] of the n channels with a valid word,
+ * from their interpolated TOW [ms] and the receiver TOW [ms], and flags them
+ * as valid pseudoranges. The other channels are not modified.
+ *
+ * The channels are independent, and they are selected without branches, so
+ * the compiler can vectorize the loop if the floating point model allows it
+ * (e.g., with -fno-trapping-math).
+ */
+void obs_compute_pseudoranges(double rx_tow_ms,
+    const uint8_t* valid_word,
+    const double* interp_tow_ms,
+    double* pseudorange_m,
+    uint8_t* valid_pseudorange,
+    uint32_t n);
+
+
+/*!
+ * \brief Hatch filter of the pseudoranges of n channels with a smoothing
+ * factor M. The pseudorange of the channels that had a valid pseudorange in
+ * the previous epoch is smoothed with the carrier phase increment, and the
+ * filter state (last_*) is updated.
+ *
+ * The channels are independent, and they are selected without branches, so
+ * the compiler can vectorize the loop if the floating point model allows it
+ * (e.g., with -fno-trapping-math).
+ */
+void obs_smooth_pseudoranges(double M,
+    const uint8_t* valid_pseudorange,
+    const double* wavelength_m,
+    const double* carrier_phase_rads,
+    double* pseudorange_m,
+    uint8_t* last_valid,
+    double* last_pseudorange_m,
+    double* last_carrier_phase_rads,
+    uint32_t n);
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_OBS_KERNELS_H
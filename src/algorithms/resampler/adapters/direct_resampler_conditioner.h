@@ -60,6 +60,26 @@ public:
         return item_size_;
     }
 
+    inline std::string item_type() const
+    {
+        return item_type_;
+    }
+
+    inline double sample_freq_in() const
+    {
+        return sample_freq_in_;
+    }
+
+    inline double sample_freq_out() const
+    {
+        return sample_freq_out_;
+    }
+
+    inline bool dump() const
+    {
+        return dump_;
+    }
+
     void connect(gr::top_block_sptr top_block) override;
     void disconnect(gr::top_block_sptr top_block) override;
     gr::basic_block_sptr get_left_block() override;
@@ -0,0 +1,236 @@
+/*!
+ * \file rational_resampler.cc
+ * \brief Polyphase rational resampler with a linear phase anti-aliasing
+ * filter and an exact, integer group delay.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "rational_resampler.h"
+#include "MATH_CONSTANTS.h"
+#include <volk/volk.h>
+#include <algorithm>  // for max, min
+#include <cmath>      // for ceil, pow, sin, sqrt
+#include <map>        // for map
+#include <mutex>      // for mutex, lock_guard
+#include <stdexcept>  // for invalid_argument
+#include <tuple>      // for tuple
+
+
+namespace
+{
+const std::size_t RATIONAL_RESAMPLER_MAX_PHASES = 4096;
+
+
+uint64_t rational_resampler_gcd(uint64_t a, uint64_t b)
+{
+    while (b != 0)
+        {
+            const uint64_t r = a % b;
+            a = b;
+            b = r;
+        }
+    return a;
+}
+
+
+// Modified Bessel function of the first kind and order zero
+double rational_resampler_bessel_i0(double x)
+{
+    double sum = 1.0;
+    double term = 1.0;
+    for (int k = 1; k < 50; k++)
+        {
+            term *= (x / (2.0 * k)) * (x / (2.0 * k));
+            sum += term;
+            if (term < 1e-12 * sum)
+                {
+                    break;
+                }
+        }
+    return sum;
+}
+}  // namespace
+
+
+// The phases of the prototype filter, each one reversed, in dot product order
+class Rational_Resampler::Bank
+{
+public:
+    std::vector<volk_gnsssdr::vector<float>> phases;
+    std::size_t taps_per_phase{0};
+    uint32_t latency_samples{0};
+};
+
+
+std::vector<float> Rational_Resampler::design_taps(std::size_t interpolation, std::size_t decimation, double bandwidth, double attenuation_db)
+{
+    // Frequencies normalized to the interpolated rate. The lower Nyquist band
+    // is 1 / (2 max(L, M)), and the stop band starts where its aliases or
+    // images would reach the pass band.
+    const double lower_rate = 1.0 / static_cast<double>(std::max(interpolation, decimation));
+    const double pass_edge = bandwidth * lower_rate / 2.0;
+    const double stop_edge = lower_rate - pass_edge;
+    const double transition = stop_edge - pass_edge;
+    const double cutoff = (pass_edge + stop_edge) / 2.0;
+
+    // Kaiser's estimates of the window length and shape
+    const double attenuation = std::max(attenuation_db, 21.0);
+    const auto min_length = static_cast<std::size_t>(std::ceil((attenuation - 7.95) / (14.36 * transition))) + 1;
+    double beta = 0.0;
+    if (attenuation > 50.0)
+        {
+            beta = 0.1102 * (attenuation - 8.7);
+        }
+    else
+        {
+            beta = 0.5842 * std::pow(attenuation - 21.0, 0.4) + 0.07886 * (attenuation - 21.0);
+        }
+
+    // 2 K L + 1 taps, a group delay of K input samples
+    const std::size_t half_inputs = std::max(static_cast<std::size_t>(1), (min_length - 1 + 2 * interpolation - 1) / (2 * interpolation));
+    const std::size_t ntaps = 2 * half_inputs * interpolation + 1;
+    const double center = static_cast<double>(ntaps - 1) / 2.0;
+    const double i0_beta = rational_resampler_bessel_i0(beta);
+    std::vector<float> taps(ntaps);
+    double dc_gain = 0.0;
+    std::vector<double> h(ntaps);
+    for (std::size_t n = 0; n < ntaps; n++)
+        {
+            const double t = static_cast<double>(n) - center;
+            const double sinc = (t == 0.0) ? 2.0 * cutoff : std::sin(2.0 * GNSS_PI * cutoff * t) / (GNSS_PI * t);
+            const double r = t / center;
+            const double window = rational_resampler_bessel_i0(beta * std::sqrt(std::max(0.0, 1.0 - r * r))) / i0_beta;
+            h[n] = sinc * window;
+            dc_gain += h[n];
+        }
+    for (std::size_t n = 0; n < ntaps; n++)
+        {
+            taps[n] = static_cast<float>(h[n] * static_cast<double>(interpolation) / dc_gain);
+        }
+    return taps;
+}
+
+
+std::shared_ptr<const Rational_Resampler::Bank> Rational_Resampler::get_bank(std::size_t interpolation, std::size_t decimation, double bandwidth, double attenuation_db)
+{
+    using Key = std::tuple<std::size_t, std::size_t, double, double>;
+    static std::mutex banks_mutex;
+    static std::map<Key, std::weak_ptr<const Bank>> banks;
+
+    const Key key(interpolation, decimation, bandwidth, attenuation_db);
+    std::lock_guard<std::mutex> lock(banks_mutex);
+    std::shared_ptr<const Bank> bank = banks[key].lock();
+    if (bank)
+        {
+            return bank;
+        }
+
+    const std::vector<float> taps = design_taps(interpolation, decimation, bandwidth, attenuation_db);
+    auto new_bank = std::make_shared<Bank>();
+    new_bank->taps_per_phase = (taps.size() + interpolation - 1) / interpolation;
+    new_bank->latency_samples = static_cast<uint32_t>((taps.size() - 1) / (2 * interpolation));
+    new_bank->phases.resize(interpolation);
+    for (std::size_t p = 0; p < interpolation; p++)
+        {
+            new_bank->phases[p] = volk_gnsssdr::vector<float>(new_bank->taps_per_phase, 0.0F);
+            for (std::size_t j = 0; j < new_bank->taps_per_phase; j++)
+                {
+                    const std::size_t n = p + j * interpolation;
+                    if (n < taps.size())
+                        {
+                            new_bank->phases[p][new_bank->taps_per_phase - 1 - j] = taps[n];
+                        }
+                }
+        }
+    banks[key] = new_bank;
+    return new_bank;
+}
+
+
+Rational_Resampler::Rational_Resampler(uint64_t sample_freq_in,
+    uint64_t sample_freq_out,
+    double bandwidth,
+    double attenuation_db)
+{
+    if (sample_freq_in == 0 or sample_freq_out == 0)
+        {
+            throw std::invalid_argument("Rational_Resampler: the sampling frequencies must be positive");
+        }
+    if (!(bandwidth > 0.0) or bandwidth >= 1.0)
+        {
+            throw std::invalid_argument("Rational_Resampler: the bandwidth must be between 0 and 1");
+        }
+    const uint64_t divisor = rational_resampler_gcd(sample_freq_in, sample_freq_out);
+    d_interpolation = static_cast<std::size_t>(sample_freq_out / divisor);
+    d_decimation = static_cast<std::size_t>(sample_freq_in / divisor);
+    if (d_interpolation > RATIONAL_RESAMPLER_MAX_PHASES)
+        {
+            throw std::invalid_argument("Rational_Resampler: the resampling ratio needs too many filter phases");
+        }
+    d_bank = get_bank(d_interpolation, d_decimation, bandwidth, attenuation_db);
+}
+
+
+std::size_t Rational_Resampler::interpolation() const
+{
+    return d_interpolation;
+}
+
+
+std::size_t Rational_Resampler::decimation() const
+{
+    return d_decimation;
+}
+
+
+std::size_t Rational_Resampler::taps_per_phase() const
+{
+    return d_bank->taps_per_phase;
+}
+
+
+uint32_t Rational_Resampler::latency_samples() const
+{
+    return d_bank->latency_samples;
+}
+
+
+std::size_t Rational_Resampler::input_required(std::size_t n_out) const
+{
+    if (n_out == 0)
+        {
+            return 0;
+        }
+    return (d_position + (n_out - 1) * d_decimation) / d_interpolation + 1;
+}
+
+
+std::size_t Rational_Resampler::resample(const gr_complex* in, std::size_t n_in, gr_complex* out, std::size_t max_out, std::size_t& consumed)
+{
+    const std::size_t ntaps = d_bank->taps_per_phase;
+    std::size_t n_out = 0;
+    while (n_out < max_out)
+        {
+            const std::size_t input = d_position / d_interpolation;
+            if (input >= n_in)
+                {
+                    break;
+                }
+            const float* phase = d_bank->phases[d_position - input * d_interpolation].data();
+            volk_32fc_32f_dot_prod_32fc(&out[n_out], in + input, phase, static_cast<unsigned int>(ntaps));
+            d_position += d_decimation;
+            n_out++;
+        }
+    consumed = std::min(d_position / d_interpolation, n_in);
+    d_position -= consumed * d_interpolation;
+    return n_out;
+}
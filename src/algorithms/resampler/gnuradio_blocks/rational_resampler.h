@@ -0,0 +1,98 @@
+/*!
+ * \file rational_resampler.h
+ * \brief Polyphase rational resampler with a linear phase anti-aliasing
+ * filter and an exact, integer group delay.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_RATIONAL_RESAMPLER_H
+#define GNSS_SDR_RATIONAL_RESAMPLER_H
+
+#include <gnuradio/gr_complex.h>
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/** \addtogroup Resampler
+ * \{ */
+/** \addtogroup Resampler_gnuradio_blocks
+ * \{ */
+
+
+/*!
+ * \brief Resamples by interpolation() / decimation(), the ratio of the
+ * output and input sampling frequencies reduced to lowest terms (e.g. 2 / 13
+ * from 26 MHz to 4 MHz, 1 / 3 from 30.69 MHz to 10.23 MHz).
+ *
+ * The low pass filter, designed at the input rate times interpolation()
+ * with a Kaiser window, keeps bandwidth times the lower of the two Nyquist
+ * bands and attenuates by attenuation_db everything that would alias into
+ * it. It is split in interpolation() phases, and only the needed output
+ * samples are computed, each one a SIMD dot product of taps_per_phase() input
+ * samples with one phase.
+ *
+ * The filter length is rounded up to 2 K interpolation() + 1 taps, so that
+ * its group delay is exactly K = latency_samples() input samples.
+ *
+ * The filter banks are computed once per set of parameters and shared by
+ * all the resamplers using them.
+ */
+class Rational_Resampler
+{
+public:
+    /*!
+     * \brief Throws std::invalid_argument for non-positive frequencies or
+     * bandwidth, or a ratio needing more than 4096 filter phases.
+     */
+    Rational_Resampler(uint64_t sample_freq_in,
+        uint64_t sample_freq_out,
+        double bandwidth = 0.8,
+        double attenuation_db = 60.0);
+
+    std::size_t interpolation() const;
+    std::size_t decimation() const;
+    std::size_t taps_per_phase() const;
+
+    //! Group delay, in input samples
+    uint32_t latency_samples() const;
+
+    //! New input samples needed by the next n_out output samples
+    std::size_t input_required(std::size_t n_out) const;
+
+    /*!
+     * \brief Computes up to max_out output samples from n_in new input
+     * samples. in must start with taps_per_phase() - 1 samples of history, as
+     * a GNU Radio block with set_history(taps_per_phase()) provides them.
+     * Returns the number of output samples, and the number of new input
+     * samples to consume in consumed.
+     */
+    std::size_t resample(const gr_complex* in, std::size_t n_in, gr_complex* out, std::size_t max_out, std::size_t& consumed);
+
+    //! Prototype filter at the input rate times interpolation(), with a DC gain of interpolation()
+    static std::vector<float> design_taps(std::size_t interpolation, std::size_t decimation, double bandwidth, double attenuation_db);
+
+private:
+    class Bank;
+    static std::shared_ptr<const Bank> get_bank(std::size_t interpolation, std::size_t decimation, double bandwidth, double attenuation_db);
+
+    std::shared_ptr<const Bank> d_bank;
+    std::size_t d_interpolation;
+    std::size_t d_decimation;
+    std::size_t d_position{0};  // of the next output, in interpolated samples from the first new input sample
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_RATIONAL_RESAMPLER_H
@@ -0,0 +1,74 @@
+/*!
+ * \file rational_resampler_cc.cc
+ * \brief GNU Radio block wrapping Rational_Resampler, with gr_complex input
+ * and output
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "rational_resampler_cc.h"
+#include <gnuradio/io_signature.h>
+#include <algorithm>  // for max
+#include <cstddef>
+
+
+rational_resampler_cc_sptr make_rational_resampler_cc(
+    uint64_t sample_freq_in,
+    uint64_t sample_freq_out,
+    double bandwidth,
+    double attenuation_db)
+{
+    return rational_resampler_cc_sptr(new rational_resampler_cc(sample_freq_in, sample_freq_out, bandwidth, attenuation_db));
+}
+
+
+rational_resampler_cc::rational_resampler_cc(
+    uint64_t sample_freq_in,
+    uint64_t sample_freq_out,
+    double bandwidth,
+    double attenuation_db)
+    : gr::block("rational_resampler_cc",
+          gr::io_signature::make(1, 1, sizeof(gr_complex)),
+          gr::io_signature::make(1, 1, sizeof(gr_complex))),
+      d_resampler(sample_freq_in, sample_freq_out, bandwidth, attenuation_db)
+{
+    set_history(static_cast<unsigned int>(d_resampler.taps_per_phase()));
+    set_relative_rate(static_cast<double>(d_resampler.interpolation()) / static_cast<double>(d_resampler.decimation()));
+}
+
+
+uint32_t rational_resampler_cc::latency_samples() const
+{
+    return d_resampler.latency_samples();
+}
+
+
+void rational_resampler_cc::forecast(int noutput_items,
+    gr_vector_int &ninput_items_required)
+{
+    // the input items include the history
+    ninput_items_required[0] = static_cast<int>(d_resampler.input_required(static_cast<std::size_t>(noutput_items)) + history() - 1);
+}
+
+
+int rational_resampler_cc::general_work(int noutput_items,
+    gr_vector_int &ninput_items, gr_vector_const_void_star &input_items,
+    gr_vector_void_star &output_items)
+{
+    const auto *in = reinterpret_cast<const gr_complex *>(input_items[0]);
+    auto *out = reinterpret_cast<gr_complex *>(output_items[0]);
+    const int history_items = static_cast<int>(history()) - 1;
+    const auto new_items = static_cast<std::size_t>(std::max(ninput_items[0] - history_items, 0));
+    std::size_t consumed = 0;
+    const std::size_t produced = d_resampler.resample(in, new_items, out, static_cast<std::size_t>(noutput_items), consumed);
+    consume_each(static_cast<int>(consumed));
+    return static_cast<int>(produced);
+}
@@ -0,0 +1,77 @@
+/*!
+ * \file rational_resampler_cc.h
+ * \brief GNU Radio block wrapping Rational_Resampler, with gr_complex input
+ * and output
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_RATIONAL_RESAMPLER_CC_H
+#define GNSS_SDR_RATIONAL_RESAMPLER_CC_H
+
+#include "gnss_block_interface.h"
+#include "rational_resampler.h"
+#include <gnuradio/block.h>
+#include <cstdint>
+
+/** \addtogroup Resampler
+ * \{ */
+/** \addtogroup Resampler_gnuradio_blocks
+ * \{ */
+
+
+class rational_resampler_cc;
+
+using rational_resampler_cc_sptr = gnss_shared_ptr<rational_resampler_cc>;
+
+rational_resampler_cc_sptr make_rational_resampler_cc(
+    uint64_t sample_freq_in,
+    uint64_t sample_freq_out,
+    double bandwidth = 0.8,
+    double attenuation_db = 60.0);
+
+/*!
+ * \brief Polyphase rational resampler for complex data (see Rational_Resampler)
+ */
+class rational_resampler_cc : public gr::block
+{
+public:
+    ~rational_resampler_cc() = default;
+
+    //! Group delay, in input samples
+    uint32_t latency_samples() const;
+
+    void forecast(int noutput_items, gr_vector_int &ninput_items_required);
+
+    int general_work(int noutput_items, gr_vector_int &ninput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+private:
+    friend rational_resampler_cc_sptr make_rational_resampler_cc(
+        uint64_t sample_freq_in,
+        uint64_t sample_freq_out,
+        double bandwidth,
+        double attenuation_db);
+
+    rational_resampler_cc(
+        uint64_t sample_freq_in,
+        uint64_t sample_freq_out,
+        double bandwidth,
+        double attenuation_db);
+
+    Rational_Resampler d_resampler;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_RATIONAL_RESAMPLER_CC_H
@@ -49,6 +49,7 @@ SignalGenerator::SignalGenerator(const ConfigurationInterface* configuration,
     const bool noise_flag = configuration->property("SignalSource.noise_flag", false);
     const float BW_BB = configuration->property("SignalSource.BW_BB", static_cast<float>(1.0));
     const unsigned int num_satellites = configuration->property("SignalSource.num_satellites", 1);
+    const unsigned int num_threads = configuration->property("SignalSource.num_threads", 1);
 
     std::vector<std::string> signal1;
     std::vector<std::string> system;
@@ -126,7 +127,7 @@ SignalGenerator::SignalGenerator(const ConfigurationInterface* configuration,
             item_size_ = sizeof(gr_complex);
             DLOG(INFO) << "Item size " << item_size_;
             gen_source_ = signal_make_generator_c(signal1, system, PRN, CN0_dB, doppler_Hz, delay_chips, delay_sec,
-                data_flag, noise_flag, fs_in, vector_length, BW_BB);
+                data_flag, noise_flag, fs_in, vector_length, BW_BB, num_threads);
 
             vector_to_stream_ = gr::blocks::vector_to_stream::make(item_size_, vector_length);
 
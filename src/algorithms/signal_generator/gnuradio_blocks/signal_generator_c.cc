@@ -27,13 +27,38 @@
 #include "glonass_l1_signal_replica.h"
 #include "gps_sdr_signal_replica.h"
 #include <gnuradio/io_signature.h>
+#include <volk/volk.h>
 #include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <fstream>
 #include <utility>
 
 
+namespace
+{
+// Adds sign * in[first, first + count) to acc[first, first + count), sign being +1 or -1
+void signal_generator_accumulate(gr_complex *acc, const gr_complex *in, unsigned int first, unsigned int count, float sign)
+{
+    if (count == 0)
+        {
+            return;
+        }
+    auto *acc_ptr = reinterpret_cast<float *>(acc + first);
+    const auto *in_ptr = reinterpret_cast<const float *>(in + first);
+    if (sign > 0)
+        {
+            volk_32f_x2_add_32f(acc_ptr, acc_ptr, in_ptr, 2 * count);
+        }
+    else
+        {
+            volk_32f_x2_subtract_32f(acc_ptr, acc_ptr, in_ptr, 2 * count);
+        }
+}
+}  // namespace
+
+
 /*
  * Create a new instance of signal_generator_c and return
  * a boost shared_ptr. This is effectively the public constructor.
@@ -42,10 +67,10 @@ signal_generator_c_sptr
 signal_make_generator_c(const std::vector<std::string> &signal1, const std::vector<std::string> &system, const std::vector<unsigned int> &PRN,
     const std::vector<float> &CN0_dB, const std::vector<float> &doppler_Hz,
     const std::vector<unsigned int> &delay_chips, const std::vector<unsigned int> &delay_sec, bool data_flag, bool noise_flag,
-    unsigned int fs_in, unsigned int vector_length, float BW_BB)
+    unsigned int fs_in, unsigned int vector_length, float BW_BB, unsigned int num_threads)
 {
     return gnuradio::get_initial_sptr(new signal_generator_c(signal1, system, PRN, CN0_dB, doppler_Hz, delay_chips, delay_sec,
-        data_flag, noise_flag, fs_in, vector_length, BW_BB));
+        data_flag, noise_flag, fs_in, vector_length, BW_BB, num_threads));
 }
 
 
@@ -63,7 +88,8 @@ signal_generator_c::signal_generator_c(std::vector<std::string> signal1,
     bool noise_flag,
     unsigned int fs_in,
     unsigned int vector_length,
-    float BW_BB) : gr::block("signal_gen_cc", gr::io_signature::make(0, 0, sizeof(gr_complex)), gr::io_signature::make(1, 1, static_cast<int>(sizeof(gr_complex) * vector_length))),
+    float BW_BB,
+    unsigned int num_threads) : gr::block("signal_gen_cc", gr::io_signature::make(0, 0, sizeof(gr_complex)), gr::io_signature::make(1, 1, static_cast<int>(sizeof(gr_complex) * vector_length))),
                    signal_(std::move(signal1)),
                    system_(std::move(system)),
                    CN0_dB_(std::move(CN0_dB)),
@@ -75,11 +101,30 @@ signal_generator_c::signal_generator_c(std::vector<std::string> signal1,
                    fs_in_(fs_in),
                    num_sats_(PRN.size()),
                    vector_length_(vector_length),
+                   num_threads_(std::max(1U, std::min(num_threads, static_cast<unsigned int>(PRN.size())))),
                    data_flag_(data_flag),
                    noise_flag_(noise_flag)
 {
     init();
     generate_codes();
+    for (unsigned int thread = 1; thread < num_threads_; thread++)
+        {
+            workers_.emplace_back(&signal_generator_c::run_worker, this, thread);
+        }
+}
+
+
+signal_generator_c::~signal_generator_c()
+{
+    {
+        std::lock_guard<std::mutex> lock(workers_mutex_);
+        workers_stop_ = true;
+    }
+    workers_start_.notify_all();
+    for (auto &worker : workers_)
+        {
+            worker.join();
+        }
 }
 
 
@@ -87,7 +132,23 @@ void signal_generator_c::init()
 {
     work_counter_ = 0;
 
-    complex_phase_ = std::vector<gr_complex>(vector_length_);
+    noise_engine_.seed(r());
+    noise_radius_ = std::vector<float>(vector_length_);
+    noise_angle_ = std::vector<float>(vector_length_);
+    noise_cos_ = std::vector<float>(vector_length_);
+    noise_sin_ = std::vector<float>(vector_length_);
+    noise_ = std::vector<gr_complex>(vector_length_);
+    buffers_ = std::vector<Synthesis_Buffers>(num_threads_);
+    for (unsigned int thread = 0; thread < num_threads_; thread++)
+        {
+            if (thread > 0)
+                {
+                    buffers_[thread].accumulator = std::vector<gr_complex>(vector_length_);
+                }
+            buffers_[thread].complex_phase = std::vector<gr_complex>(vector_length_);
+            buffers_[thread].product = std::vector<gr_complex>(vector_length_);
+            buffers_[thread].product_2 = std::vector<gr_complex>(vector_length_);
+        }
     start_phase_rad_.reserve(num_sats_);
     current_data_bit_int_.reserve(num_sats_);
     ms_counter_.reserve(num_sats_);
@@ -102,6 +163,7 @@ void signal_generator_c::init()
 
     for (unsigned int sat = 0; sat < num_sats_; sat++)
         {
+            data_bit_engine_.emplace_back(r());
             start_phase_rad_.push_back(0);
             current_data_bit_int_.push_back(1);
             current_data_bits_.emplace_back(1, 0);
@@ -322,228 +384,231 @@ void signal_generator_c::generate_codes()
 }
 
 
-int signal_generator_c::general_work(int noutput_items __attribute__((unused)),
-    gr_vector_int &ninput_items __attribute__((unused)),
-    gr_vector_const_void_star &input_items __attribute__((unused)),
-    gr_vector_void_star &output_items)
+void signal_generator_c::synthesize_satellite(unsigned int sat, Synthesis_Buffers &buffers, gr_complex *acc)
 {
-    auto *out = reinterpret_cast<gr_complex *>(output_items[0]);
-
-    work_counter_++;
-
-    std::default_random_engine e1(r());
-    std::default_random_engine e2(r());
-    unsigned int out_idx = 0;
-    unsigned int i = 0;
-    unsigned int k = 0;
+    gr_complex *phase = buffers.complex_phase.data();
+    gr_complex *product = buffers.product.data();
+    gr_complex *product_2 = buffers.product_2.data();
+    std::uniform_int_distribution<int> bit_dist(0, 1);
     // the intermediate frequency must be set by the user
     unsigned int freq = 4e6;
 
-    for (out_idx = 0; out_idx < vector_length_; out_idx++)
-        {
-            out[out_idx] = gr_complex(0.0, 0.0);
-        }
-
-    for (unsigned int sat = 0; sat < num_sats_; sat++)
-        {
-            float phase_step_rad = -static_cast<float>(TWO_PI) * doppler_Hz_[sat] / static_cast<float>(fs_in_);
-            std::array<float, 1> _phase{};
-            _phase[0] = -start_phase_rad_[sat];
-            volk_gnsssdr_s32f_sincos_32fc(complex_phase_.data(), -phase_step_rad, _phase.data(), vector_length_);
-            start_phase_rad_[sat] += static_cast<float>(vector_length_) * phase_step_rad;
+    float phase_step_rad = -static_cast<float>(TWO_PI) * doppler_Hz_[sat] / static_cast<float>(fs_in_);
+    std::array<float, 1> _phase{};
+    _phase[0] = -start_phase_rad_[sat];
+    volk_gnsssdr_s32f_sincos_32fc(phase, -phase_step_rad, _phase.data(), vector_length_);
+    start_phase_rad_[sat] += static_cast<float>(vector_length_) * phase_step_rad;
 
-            out_idx = 0;
+    unsigned int out_idx = 0;
 
+    if (system_[sat] == "G" or system_[sat] == "R")
+        {
+            unsigned int delay_samples;
+            int code_period_ms;
             if (system_[sat] == "G")
                 {
-                    auto delay_samples = static_cast<unsigned int>((delay_chips_[sat] % static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS)) * samples_per_code_[sat] / GPS_L1_CA_CODE_LENGTH_CHIPS);
-
-                    for (i = 0; i < num_of_codes_per_vector_[sat]; i++)
-                        {
-                            for (k = 0; k < delay_samples; k++)
-                                {
-                                    out[out_idx] += sampled_code_data_[sat][out_idx] * current_data_bits_[sat] * complex_phase_[out_idx];
-                                    out_idx++;
-                                }
-
-                            if (ms_counter_[sat] == 0 && data_flag_)
-                                {
-                                    // New random data bit
-                                    current_data_bits_[sat] = gr_complex((uniform_dist(e1) % 2) == 0 ? 1 : -1, 0);
-                                }
-
-                            for (k = delay_samples; k < samples_per_code_[sat]; k++)
-                                {
-                                    out[out_idx] += sampled_code_data_[sat][out_idx] * current_data_bits_[sat] * complex_phase_[out_idx];
-                                    out_idx++;
-                                }
-
-                            ms_counter_[sat] = (ms_counter_[sat] + static_cast<int>(round(1e3 * GPS_L1_CA_CODE_PERIOD_S))) % data_bit_duration_ms_[sat];
-                        }
+                    delay_samples = static_cast<unsigned int>((delay_chips_[sat] % static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS)) * samples_per_code_[sat] / GPS_L1_CA_CODE_LENGTH_CHIPS);
+                    code_period_ms = static_cast<int>(round(1e3 * GPS_L1_CA_CODE_PERIOD_S));
                 }
-
-            else if (system_[sat] == "R")
+            else
                 {
                     phase_step_rad = -static_cast<float>(TWO_PI) * (static_cast<float>(freq) + (static_cast<float>(DFRQ1_GLO) * GLONASS_PRN.at(PRN_[sat])) + doppler_Hz_[sat]) / static_cast<float>(fs_in_);
-                    // std::cout << "sat " << PRN_[sat] << " SG - Freq = " << (freq + (DFRQ1_GLO * GLONASS_PRN.at(PRN_[sat]))) << " Doppler = " << doppler_Hz_[sat] << '\n';
                     _phase[0] = -start_phase_rad_[sat];
-                    volk_gnsssdr_s32f_sincos_32fc(complex_phase_.data(), -phase_step_rad, _phase.data(), vector_length_);
+                    volk_gnsssdr_s32f_sincos_32fc(phase, -phase_step_rad, _phase.data(), vector_length_);
+                    delay_samples = static_cast<unsigned int>((delay_chips_[sat] % static_cast<int>(GLONASS_L1_CA_CODE_LENGTH_CHIPS)) * samples_per_code_[sat] / GLONASS_L1_CA_CODE_LENGTH_CHIPS);
+                    code_period_ms = static_cast<int>(round(1e3 * GLONASS_L1_CA_CODE_PERIOD_S));
+                }
 
-                    auto delay_samples = static_cast<unsigned int>((delay_chips_[sat] % static_cast<int>(GLONASS_L1_CA_CODE_LENGTH_CHIPS)) * samples_per_code_[sat] / GLONASS_L1_CA_CODE_LENGTH_CHIPS);
+            volk_32fc_x2_multiply_32fc(product, sampled_code_data_[sat].data(), phase, vector_length_);
+            for (unsigned int i = 0; i < num_of_codes_per_vector_[sat]; i++)
+                {
+                    signal_generator_accumulate(acc, product, out_idx, delay_samples, current_data_bits_[sat].real());
+                    out_idx += delay_samples;
 
-                    for (i = 0; i < num_of_codes_per_vector_[sat]; i++)
+                    if (ms_counter_[sat] == 0 && data_flag_)
                         {
-                            for (k = 0; k < delay_samples; k++)
-                                {
-                                    out[out_idx] += sampled_code_data_[sat][out_idx] * current_data_bits_[sat] * complex_phase_[out_idx];
-                                    out_idx++;
-                                }
-
-                            if (ms_counter_[sat] == 0 && data_flag_)
-                                {
-                                    // New random data bit
-                                    current_data_bits_[sat] = gr_complex((uniform_dist(e1) % 2) == 0 ? 1 : -1, 0);
-                                }
+                            // New random data bit
+                            current_data_bits_[sat] = gr_complex(bit_dist(data_bit_engine_[sat]) == 0 ? 1 : -1, 0);
+                        }
 
-                            for (k = delay_samples; k < samples_per_code_[sat]; k++)
-                                {
-                                    out[out_idx] += sampled_code_data_[sat][out_idx] * current_data_bits_[sat] * complex_phase_[out_idx];
-                                    out_idx++;
-                                }
+                    signal_generator_accumulate(acc, product, out_idx, samples_per_code_[sat] - delay_samples, current_data_bits_[sat].real());
+                    out_idx += samples_per_code_[sat] - delay_samples;
 
-                            ms_counter_[sat] = (ms_counter_[sat] + static_cast<int>(round(1e3 * GLONASS_L1_CA_CODE_PERIOD_S))) % data_bit_duration_ms_[sat];
-                        }
+                    ms_counter_[sat] = (ms_counter_[sat] + code_period_ms) % data_bit_duration_ms_[sat];
                 }
+        }
 
-            else if (system_[sat] == "E")
+    else if (system_[sat] == "E")
+        {
+            if (signal_[sat].at(0) == '5' or signal_[sat].at(0) == '7')
                 {
-                    if (signal_[sat].at(0) == '5')
-                        {
-                            // EACH WORK outputs 1 modulated primary code
-                            int codelen = static_cast<int>(GALILEO_E5A_CODE_LENGTH_CHIPS);
-                            unsigned int delay_samples = (delay_chips_[sat] % codelen) * samples_per_code_[sat] / codelen;
-                            for (k = 0; k < delay_samples; k++)
-                                {
-                                    out[out_idx] += (gr_complex(sampled_code_data_[sat][out_idx].real() * data_modulation_[sat],
-                                                        sampled_code_data_[sat][out_idx].imag() * pilot_modulation_[sat])) *
-                                                    complex_phase_[out_idx];
-                                    out_idx++;
-                                }
+                    // EACH WORK outputs 1 modulated primary code
+                    const bool e5a = signal_[sat].at(0) == '5';
+                    int codelen = static_cast<int>(e5a ? GALILEO_E5A_CODE_LENGTH_CHIPS : GALILEO_E5B_CODE_LENGTH_CHIPS);
+                    unsigned int delay_samples = (delay_chips_[sat] % codelen) * samples_per_code_[sat] / codelen;
 
-                            if (ms_counter_[sat] % data_bit_duration_ms_[sat] == 0 && data_flag_)
-                                {
-                                    // New random data bit
-                                    current_data_bit_int_[sat] = (uniform_dist(e1) % 2) == 0 ? 1 : -1;
-                                }
+                    // (I * data + j * Q * pilot) is data * code if both symbols are equal, and data * conj(code) otherwise
+                    volk_32fc_x2_multiply_32fc(product, sampled_code_data_[sat].data(), phase, vector_length_);
+                    volk_32fc_x2_multiply_conjugate_32fc(product_2, phase, sampled_code_data_[sat].data(), vector_length_);
+
+                    signal_generator_accumulate(acc, data_modulation_[sat] == pilot_modulation_[sat] ? product : product_2, out_idx, delay_samples, static_cast<float>(data_modulation_[sat]));
+                    out_idx += delay_samples;
+
+                    if (ms_counter_[sat] % data_bit_duration_ms_[sat] == 0 && data_flag_)
+                        {
+                            // New random data bit
+                            current_data_bit_int_[sat] = bit_dist(data_bit_engine_[sat]) == 0 ? 1 : -1;
+                        }
+                    if (e5a)
+                        {
                             data_modulation_[sat] = current_data_bit_int_[sat] * (GALILEO_E5A_I_SECONDARY_CODE[(ms_counter_[sat] + delay_sec_[sat]) % 20] == '0' ? 1 : -1);
                             pilot_modulation_[sat] = (GALILEO_E5A_Q_SECONDARY_CODE[PRN_[sat] - 1][((ms_counter_[sat] + delay_sec_[sat]) % 100)] == '0' ? 1 : -1);
-
                             ms_counter_[sat] = ms_counter_[sat] + static_cast<int>(round(1e3 * GALILEO_E5A_CODE_PERIOD_S));
-
-                            for (k = delay_samples; k < samples_per_code_[sat]; k++)
-                                {
-                                    out[out_idx] += (gr_complex(sampled_code_data_[sat][out_idx].real() * data_modulation_[sat],
-                                                        sampled_code_data_[sat][out_idx].imag() * pilot_modulation_[sat])) *
-                                                    complex_phase_[out_idx];
-                                    out_idx++;
-                                }
                         }
-                    else if (signal_[sat].at(0) == '7')
+                    else
                         {
-                            // EACH WORK outputs 1 modulated primary code
-                            int codelen = static_cast<int>(GALILEO_E5B_CODE_LENGTH_CHIPS);
-                            unsigned int delay_samples = (delay_chips_[sat] % codelen) * samples_per_code_[sat] / codelen;
-                            for (k = 0; k < delay_samples; k++)
-                                {
-                                    out[out_idx] += (gr_complex(sampled_code_data_[sat][out_idx].real() * data_modulation_[sat],
-                                                        sampled_code_data_[sat][out_idx].imag() * pilot_modulation_[sat])) *
-                                                    complex_phase_[out_idx];
-                                    out_idx++;
-                                }
-
-                            if (ms_counter_[sat] % data_bit_duration_ms_[sat] == 0 && data_flag_)
-                                {
-                                    // New random data bit
-                                    current_data_bit_int_[sat] = (uniform_dist(e1) % 2) == 0 ? 1 : -1;
-                                }
                             data_modulation_[sat] = current_data_bit_int_[sat] * (GALILEO_E5B_I_SECONDARY_CODE[((ms_counter_[sat] + delay_sec_[sat]) % 4)] == '0' ? 1 : -1);
                             pilot_modulation_[sat] = (GALILEO_E5B_Q_SECONDARY_CODE[PRN_[sat] - 1][((ms_counter_[sat] + delay_sec_[sat]) % 100)] == '0' ? 1 : -1);
-
                             ms_counter_[sat] = ms_counter_[sat] + static_cast<int>(round(1e3 * GALILEO_E5B_CODE_PERIOD_S));
-
-                            for (k = delay_samples; k < samples_per_code_[sat]; k++)
-                                {
-                                    out[out_idx] += (gr_complex(sampled_code_data_[sat][out_idx].real() * data_modulation_[sat],
-                                                        sampled_code_data_[sat][out_idx].imag() * pilot_modulation_[sat])) *
-                                                    complex_phase_[out_idx];
-                                    out_idx++;
-                                }
                         }
-                    else if (signal_[sat].at(1) == '6')
+
+                    signal_generator_accumulate(acc, data_modulation_[sat] == pilot_modulation_[sat] ? product : product_2, out_idx, samples_per_code_[sat] - delay_samples, static_cast<float>(data_modulation_[sat]));
+                }
+            else
+                {
+                    unsigned int delay_samples;
+                    int code_period_ms;
+                    if (signal_[sat].at(1) == '6')
                         {
-                            // EACH WORK outputs 1 modulated primary code
                             int codelen = static_cast<int>(GALILEO_E6_C_CODE_LENGTH_CHIPS);
-                            unsigned int delay_samples = (delay_chips_[sat] % codelen) * samples_per_code_[sat] / codelen;
-                            for (i = 0; i < num_of_codes_per_vector_[sat]; i++)
-                                {
-                                    for (k = 0; k < delay_samples; k++)
-                                        {
-                                            out[out_idx] += (sampled_code_data_[sat][out_idx] * current_data_bits_[sat] - sampled_code_pilot_[sat][out_idx]) * complex_phase_[out_idx];
-                                            out_idx++;
-                                        }
-
-                                    if (ms_counter_[sat] == 0 && data_flag_)
-                                        {
-                                            // New random data bit
-                                            current_data_bits_[sat] = gr_complex((uniform_dist(e1) % 2) == 0 ? 1 : -1, 0);
-                                        }
-
-                                    for (k = delay_samples; k < samples_per_code_[sat]; k++)
-                                        {
-                                            out[out_idx] += (sampled_code_data_[sat][out_idx] * current_data_bits_[sat] - sampled_code_pilot_[sat][out_idx]) * complex_phase_[out_idx];
-                                            out_idx++;
-                                        }
-                                    ms_counter_[sat] = (ms_counter_[sat] + 1) % data_bit_duration_ms_[sat];
-                                }
+                            delay_samples = (delay_chips_[sat] % codelen) * samples_per_code_[sat] / codelen;
+                            code_period_ms = 1;
                         }
                     else
                         {
-                            auto delay_samples = static_cast<unsigned int>((delay_chips_[sat] % static_cast<int>(GALILEO_E1_B_CODE_LENGTH_CHIPS)) * samples_per_code_[sat] / GALILEO_E1_B_CODE_LENGTH_CHIPS);
+                            delay_samples = static_cast<unsigned int>((delay_chips_[sat] % static_cast<int>(GALILEO_E1_B_CODE_LENGTH_CHIPS)) * samples_per_code_[sat] / GALILEO_E1_B_CODE_LENGTH_CHIPS);
+                            code_period_ms = static_cast<int>(round(1e3 * GALILEO_E1_CODE_PERIOD_S));
+                        }
 
-                            for (i = 0; i < num_of_codes_per_vector_[sat]; i++)
-                                {
-                                    for (k = 0; k < delay_samples; k++)
-                                        {
-                                            out[out_idx] += (sampled_code_data_[sat][out_idx] * current_data_bits_[sat] - sampled_code_pilot_[sat][out_idx]) * complex_phase_[out_idx];
-                                            out_idx++;
-                                        }
+                    // (data * bit - pilot) * phase
+                    volk_32fc_x2_multiply_32fc(product, sampled_code_data_[sat].data(), phase, vector_length_);
+                    volk_32fc_x2_multiply_32fc(product_2, sampled_code_pilot_[sat].data(), phase, vector_length_);
+                    for (unsigned int i = 0; i < num_of_codes_per_vector_[sat]; i++)
+                        {
+                            signal_generator_accumulate(acc, product, out_idx, delay_samples, current_data_bits_[sat].real());
+                            signal_generator_accumulate(acc, product_2, out_idx, delay_samples, -1.0F);
+                            out_idx += delay_samples;
 
-                                    if (ms_counter_[sat] == 0 && data_flag_)
-                                        {
-                                            // New random data bit
-                                            current_data_bits_[sat] = gr_complex((uniform_dist(e1) % 2) == 0 ? 1 : -1, 0);
-                                        }
+                            if (ms_counter_[sat] == 0 && data_flag_)
+                                {
+                                    // New random data bit
+                                    current_data_bits_[sat] = gr_complex(bit_dist(data_bit_engine_[sat]) == 0 ? 1 : -1, 0);
+                                }
 
-                                    for (k = delay_samples; k < samples_per_code_[sat]; k++)
-                                        {
-                                            out[out_idx] += (sampled_code_data_[sat][out_idx] * current_data_bits_[sat] - sampled_code_pilot_[sat][out_idx]) * complex_phase_[out_idx];
-                                            out_idx++;
-                                        }
+                            signal_generator_accumulate(acc, product, out_idx, samples_per_code_[sat] - delay_samples, current_data_bits_[sat].real());
+                            signal_generator_accumulate(acc, product_2, out_idx, samples_per_code_[sat] - delay_samples, -1.0F);
+                            out_idx += samples_per_code_[sat] - delay_samples;
 
-                                    ms_counter_[sat] = (ms_counter_[sat] + static_cast<int>(round(1e3 * GALILEO_E1_CODE_PERIOD_S))) % data_bit_duration_ms_[sat];
-                                }
+                            ms_counter_[sat] = (ms_counter_[sat] + code_period_ms) % data_bit_duration_ms_[sat];
                         }
                 }
         }
+}
 
-    if (noise_flag_)
+
+void signal_generator_c::synthesize_satellites(unsigned int thread, Synthesis_Buffers &buffers, gr_complex *acc)
+{
+    std::fill_n(acc, vector_length_, gr_complex(0.0, 0.0));
+    for (unsigned int sat = thread; sat < num_sats_; sat += num_threads_)
+        {
+            synthesize_satellite(sat, buffers, acc);
+        }
+}
+
+
+void signal_generator_c::add_noise(gr_complex *out)
+{
+    // u1 in (0, 1] and u2 in [0, 1), from the 24 most significant bits of each draw
+    const float two_minus_24 = 1.0F / 16777216.0F;
+    for (unsigned int i = 0; i < vector_length_; i++)
+        {
+            noise_radius_[i] = static_cast<float>((noise_engine_() >> 8U) + 1U) * two_minus_24;
+            noise_angle_[i] = static_cast<float>(noise_engine_() >> 8U) * two_minus_24;
+        }
+    // sqrt(-2 ln(u1)) * exp(j 2 pi u2), with unit variance in each component
+    volk_32f_log2_32f(noise_radius_.data(), noise_radius_.data(), vector_length_);
+    volk_32f_s32f_multiply_32f(noise_radius_.data(), noise_radius_.data(), static_cast<float>(-2.0 * M_LN2), vector_length_);
+    volk_32f_sqrt_32f(noise_radius_.data(), noise_radius_.data(), vector_length_);
+    volk_32f_s32f_multiply_32f(noise_angle_.data(), noise_angle_.data(), static_cast<float>(TWO_PI), vector_length_);
+    volk_32f_cos_32f(noise_cos_.data(), noise_angle_.data(), vector_length_);
+    volk_32f_sin_32f(noise_sin_.data(), noise_angle_.data(), vector_length_);
+    volk_32f_x2_interleave_32fc(noise_.data(), noise_cos_.data(), noise_sin_.data(), vector_length_);
+    volk_32fc_32f_multiply_32fc(noise_.data(), noise_.data(), noise_radius_.data(), vector_length_);
+    signal_generator_accumulate(out, noise_.data(), 0, vector_length_, 1.0F);
+}
+
+
+void signal_generator_c::run_worker(unsigned int thread)
+{
+    uint64_t generation = 0;
+    while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(workers_mutex_);
+                workers_start_.wait(lock, [this, generation]() { return workers_stop_ or workers_generation_ != generation; });
+                if (workers_stop_)
+                    {
+                        return;
+                    }
+                generation = workers_generation_;
+            }
+            synthesize_satellites(thread, buffers_[thread], buffers_[thread].accumulator.data());
+            {
+                std::lock_guard<std::mutex> lock(workers_mutex_);
+                workers_pending_--;
+            }
+            workers_done_.notify_one();
+        }
+}
+
+
+int signal_generator_c::general_work(int noutput_items __attribute__((unused)),
+    gr_vector_int &ninput_items __attribute__((unused)),
+    gr_vector_const_void_star &input_items __attribute__((unused)),
+    gr_vector_void_star &output_items)
+{
+    auto *out = reinterpret_cast<gr_complex *>(output_items[0]);
+
+    work_counter_++;
+
+    if (num_threads_ > 1)
+        {
+            {
+                std::lock_guard<std::mutex> lock(workers_mutex_);
+                workers_generation_++;
+                workers_pending_ = num_threads_ - 1;
+            }
+            workers_start_.notify_all();
+        }
+
+    synthesize_satellites(0, buffers_[0], out);
+
+    if (num_threads_ > 1)
         {
-            for (out_idx = 0; out_idx < vector_length_; out_idx++)
+            std::unique_lock<std::mutex> lock(workers_mutex_);
+            workers_done_.wait(lock, [this]() { return workers_pending_ == 0; });
+            lock.unlock();
+            for (unsigned int thread = 1; thread < num_threads_; thread++)
                 {
-                    out[out_idx] += gr_complex(normal_dist(e1), normal_dist(e2));
+                    signal_generator_accumulate(out, buffers_[thread].accumulator.data(), 0, vector_length_, 1.0F);
                 }
         }
 
+    if (noise_flag_)
+        {
+            add_noise(out);
+        }
+
     // Tell runtime system how many output items we produced.
     return 1;
 }
@@ -19,8 +19,12 @@
 
 #include "gnss_block_interface.h"
 #include <gnuradio/block.h>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
 #include <random>
 #include <string>
+#include <thread>
 #include <vector>
 
 
@@ -47,18 +51,23 @@ signal_generator_c_sptr signal_make_generator_c(
     bool noise_flag,
     unsigned int fs_in,
     unsigned int vector_length,
-    float BW_BB);
+    float BW_BB,
+    unsigned int num_threads = 1);
 
 /*!
  * \brief This class generates synthesized GNSS signal.
  * \ingroup block
  *
+ * Each satellite is synthesized as whole segments of samples with the same
+ * data and secondary code symbols, with VOLK kernels, and the satellites are
+ * shared among num_threads threads that add them into their own buffers.
+ *
  * \sa gen_source for a version that subclasses gr_block.
  */
 class signal_generator_c : public gr::block
 {
 public:
-    ~signal_generator_c() = default;  // public destructor
+    ~signal_generator_c();  // public destructor
 
     // Where all the action really happens
     int general_work(int noutput_items,
@@ -79,7 +88,8 @@ private:
         bool noise_flag,
         unsigned int fs_in,
         unsigned int vector_length,
-        float BW_BB);
+        float BW_BB,
+        unsigned int num_threads);
 
     signal_generator_c(
         std::vector<std::string> signal1,
@@ -93,21 +103,54 @@ private:
         bool noise_flag,
         unsigned int fs_in,
         unsigned int vector_length,
-        float BW_BB);
+        float BW_BB,
+        unsigned int num_threads);
+
+    // Working buffers of a thread
+    struct Synthesis_Buffers
+    {
+        std::vector<gr_complex> accumulator;  // not used by the thread of general_work, which adds into the output
+        std::vector<gr_complex> complex_phase;
+        std::vector<gr_complex> product;
+        std::vector<gr_complex> product_2;
+    };
 
     void init();
 
     void generate_codes();
 
+    // Adds the vector of satellite sat to acc
+    void synthesize_satellite(unsigned int sat, Synthesis_Buffers &buffers, gr_complex *acc);
+
+    // Synthesizes the satellites thread, thread + num_threads, ... into acc, which is set to zero first
+    void synthesize_satellites(unsigned int thread, Synthesis_Buffers &buffers, gr_complex *acc);
+
+    // Adds unit variance complex Gaussian noise to out, with the Box-Muller transform
+    void add_noise(gr_complex *out);
+
+    void run_worker(unsigned int thread);
+
     std::random_device r;
-    std::uniform_int_distribution<int> uniform_dist;
-    std::normal_distribution<float> normal_dist;
+    std::mt19937 noise_engine_;
+    std::vector<std::default_random_engine> data_bit_engine_;
+    std::vector<Synthesis_Buffers> buffers_;
+    std::vector<float> noise_radius_;
+    std::vector<float> noise_angle_;
+    std::vector<float> noise_cos_;
+    std::vector<float> noise_sin_;
+    std::vector<gr_complex> noise_;
+    std::vector<std::thread> workers_;
+    std::mutex workers_mutex_;
+    std::condition_variable workers_start_;
+    std::condition_variable workers_done_;
+    uint64_t workers_generation_{};
+    unsigned int workers_pending_{};
+    bool workers_stop_{};
     std::vector<std::string> signal_;
     std::vector<std::string> system_;
     std::vector<std::vector<gr_complex>> sampled_code_data_;
     std::vector<std::vector<gr_complex>> sampled_code_pilot_;
     std::vector<gr_complex> current_data_bits_;
-    std::vector<gr_complex> complex_phase_;
     std::vector<float> CN0_dB_;
     std::vector<float> doppler_Hz_;
     std::vector<float> start_phase_rad_;
@@ -126,6 +169,7 @@ private:
     unsigned int fs_in_;
     unsigned int num_sats_;
     unsigned int vector_length_;
+    unsigned int num_threads_;
     bool data_flag_;
     bool noise_flag_;
 };
@@ -26,8 +26,8 @@
 #include "GPS_L1_CA.h"
 #include "GPS_L5.h"
 #include "ad9361_manager.h"
-#include "command_event.h"
 #include "configuration_interface.h"
+#include "control_event.h"
 #include "gnss_sdr_flags.h"
 #include "gnss_sdr_string_literals.h"
 #include "uio_fpga.h"
@@ -539,7 +539,7 @@ void Ad9361FpgaSignalSource::run_DMA_process(const std::string &filename0, const
         {
             std::cerr << "Exception opening file " << filename0 << '\n';
             // stop the receiver
-            queue->push(pmt::make_any(command_event_make(200, 0)));
+            queue->push(control_event_pmt(Control_Event::command, 200, 0));
             return;
         }
 
@@ -555,7 +555,7 @@ void Ad9361FpgaSignalSource::run_DMA_process(const std::string &filename0, const
                 {
                     std::cerr << "Exception opening file " << filename1 << '\n';
                     // stop the receiver
-                    queue->push(pmt::make_any(command_event_make(200, 0)));
+                    queue->push(control_event_pmt(Control_Event::command, 200, 0));
                     return;
                 }
         }
@@ -570,7 +570,7 @@ void Ad9361FpgaSignalSource::run_DMA_process(const std::string &filename0, const
         {
             std::cerr << "Exception skipping initial samples file " << filename0 << '\n';
             // stop the receiver
-            queue->push(pmt::make_any(command_event_make(200, 0)));
+            queue->push(control_event_pmt(Control_Event::command, 200, 0));
             return;
         }
 
@@ -584,7 +584,7 @@ void Ad9361FpgaSignalSource::run_DMA_process(const std::string &filename0, const
                 {
                     std::cerr << "Exception skipping initial samples file " << filename1 << '\n';
                     // stop the receiver
-                    queue->push(pmt::make_any(command_event_make(200, 0)));
+                    queue->push(control_event_pmt(Control_Event::command, 200, 0));
                     return;
                 }
         }
@@ -603,7 +603,7 @@ void Ad9361FpgaSignalSource::run_DMA_process(const std::string &filename0, const
         {
             std::cerr << "Cannot open loop device\n";
             // stop the receiver
-            queue->push(pmt::make_any(command_event_make(200, 0)));
+            queue->push(control_event_pmt(Control_Event::command, 200, 0));
             return;
         }
     // note: a problem was identified with the DMA: when switching from tx to rx or rx to tx mode
@@ -619,7 +619,7 @@ void Ad9361FpgaSignalSource::run_DMA_process(const std::string &filename0, const
         {
             std::cerr << "Cannot open loop device\n";
             // stop the receiver
-            queue->push(pmt::make_any(command_event_make(200, 0)));
+            queue->push(control_event_pmt(Control_Event::command, 200, 0));
             return;
         }
 
@@ -816,7 +816,7 @@ void Ad9361FpgaSignalSource::run_DMA_process(const std::string &filename0, const
         }
 
     // Stop the receiver
-    queue->push(pmt::make_any(command_event_make(200, 0)));
+    queue->push(control_event_pmt(Control_Event::command, 200, 0));
 }
 
 
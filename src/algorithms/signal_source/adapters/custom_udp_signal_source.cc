@@ -46,6 +46,8 @@ CustomUDPSignalSource::CustomUDPSignalSource(const ConfigurationInterface* confi
     std::string capture_device = configuration->property(role + ".capture_device", default_capture_device);
     int port = configuration->property(role + ".port", default_port);
     int payload_bytes = configuration->property(role + ".payload_bytes", 1024);
+    // "pcap" for the raw packet capture, "socket" for batched reads of the UDP socket (Linux only)
+    const std::string capture_backend = configuration->property(role + ".capture_backend", std::string("pcap"));
 
     RF_channels_ = configuration->property(role + ".RF_channels", 1);
     channels_in_udp_ = configuration->property(role + ".channels_in_udp", 1);
@@ -62,7 +64,8 @@ CustomUDPSignalSource::CustomUDPSignalSource(const ConfigurationInterface* confi
         channels_in_udp_,
         sample_type,
         item_size_,
-        IQ_swap_);
+        IQ_swap_,
+        capture_backend == "socket");
 
     if (channels_in_udp_ >= RF_channels_)
         {
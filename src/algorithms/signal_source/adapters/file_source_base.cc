@@ -24,7 +24,9 @@
 #include "Galileo_E5a.h"
 #include "Galileo_E5b.h"
 #include "Galileo_E6.h"
+#include "capture_file_sink.h"
 #include "configuration_interface.h"
+#include "gnss_capture_file.h"
 #include "gnss_sdr_filesystem.h"
 #include "gnss_sdr_flags.h"
 #include "gnss_sdr_string_literals.h"
@@ -46,16 +48,20 @@ FileSourceBase::FileSourceBase(ConfigurationInterface const* configuration, std:
       role_(role),
       filename_(configuration->property(role_ + ".filename"s, "../data/example_capture.dat"s)),
       dump_filename_(configuration->property(role_ + ".dump_filename"s, "../data/my_capture.dat"s)),
+      dump_format_(configuration->property(role_ + ".dump_format"s, "raw"s)),
       item_type_(configuration->property(role_ + ".item_type"s, std::move(default_item_type))),
       item_size_(0),
       header_size_(configuration->property(role_ + ".header_size"s, uint64_t(0))),
       samples_(configuration->property(role_ + ".samples"s, uint64_t(0))),
+      samples_to_skip_(configuration->property(role_ + ".samples_to_skip"s, uint64_t(0))),
       sampling_frequency_(configuration->property(role_ + ".sampling_frequency"s, int64_t(0))),
       minimum_tail_s_(0.1),
       seconds_to_skip_(configuration->property(role_ + ".seconds_to_skip"s, 0.0)),
+      dump_intermediate_frequency_(configuration->property(role_ + ".dump_intermediate_frequency"s, 0.0)),
       is_complex_(false),
       repeat_(configuration->property(role_ + ".repeat"s, false)),
       enable_throttle_control_(configuration->property(role_ + ".enable_throttle_control"s, false)),
+      use_mmap_(configuration->property(role_ + ".use_mmap"s, false)),
       dump_(configuration->property(role_ + ".dump"s, false))
 {
     minimum_tail_s_ = std::max(configuration->property("Acquisition_1C.coherent_integration_time_ms", 0.0) * 0.001 * 2.0, minimum_tail_s_);
@@ -85,14 +91,21 @@ FileSourceBase::FileSourceBase(ConfigurationInterface const* configuration, std:
     if (repeat())
         {
             minimum_tail_s_ = 0.0;
-            if (seconds_to_skip_ != 0.0)
+            if (seconds_to_skip_ != 0.0 or samples_to_skip_ != 0)
                 {
                     seconds_to_skip_ = 0.0;
+                    samples_to_skip_ = 0;
                     std::cout << "Warning: since " << role_ << ".repeat is set to true, "
-                              << role_ << ".seconds_to_skip parameter will be ignored.\n";
+                              << role_ << ".seconds_to_skip and " << role_ << ".samples_to_skip parameters will be ignored.\n";
                 }
         }
 
+    if (dump_format_ != "raw" and dump_format_ != "capture")
+        {
+            std::cout << "Warning: unknown " << role_ << ".dump_format " << dump_format_ << ", the raw format will be used.\n";
+            dump_format_ = "raw";
+        }
+
     // override value with commandline flag, if present
     if (FLAGS_signal_source != "-")
         {
@@ -354,12 +367,12 @@ size_t FileSourceBase::samplesToSkip() const
 {
     auto samples_to_skip = size_t(0);
 
-    if (seconds_to_skip_ > 0)
+    if (seconds_to_skip_ > 0 or samples_to_skip_ > 0)
         {
             // sampling_frequency is in terms of actual samples (output packets). If this source is
             // compressed, there may be multiple packets per file (read) sample. First compute the
             // actual number of samples to skip (function of time and sample rate)
-            samples_to_skip = static_cast<size_t>(seconds_to_skip_ * sampling_frequency_);
+            samples_to_skip = samples_to_skip_ > 0 ? static_cast<size_t>(samples_to_skip_) : static_cast<size_t>(seconds_to_skip_ * sampling_frequency_);
 
             // convert from sample to input items, scaling this value to input item space
             // (rounding up)
@@ -386,7 +399,8 @@ size_t FileSourceBase::computeSamplesInFile() const
     auto n_samples = static_cast<size_t>(samples());
 
     // this could throw, but the existence of the file has been proven before we get here.
-    const auto size = fs::file_size(filename());
+    // The items of a capture file are counted in its header
+    const auto size = capture_file_source_ ? capture_file_source_->header().items * item_size() : fs::file_size(filename());
 
     const auto to_skip = samplesToSkip();
 
@@ -465,26 +479,62 @@ gnss_shared_ptr<gr::block> FileSourceBase::throttle() const { return throttle_;
 gnss_shared_ptr<gr::block> FileSourceBase::sink() const { return sink_; }
 
 
-gr::blocks::file_source::sptr FileSourceBase::create_file_source()
+gnss_shared_ptr<gr::block> FileSourceBase::create_file_source()
 {
+    const bool is_capture_file = Gnss_Capture_Reader::is_capture_file(filename());
+    if (is_capture_file)
+        {
+            // the item type is taken from the header of the file
+            const Gnss_Capture_Header header = Gnss_Capture_Reader(filename()).header();
+            if (header.item_type != item_type_)
+                {
+                    std::cout << "Warning: " << filename() << " is a capture file of " << header.item_type << " items, "
+                              << role_ << ".item_type=" << item_type_ << " will be ignored.\n";
+                    item_type_ = header.item_type;
+                }
+            if (header.sampling_frequency > 0.0 and static_cast<int64_t>(header.sampling_frequency) != sampling_frequency_)
+                {
+                    std::cout << "Warning: " << filename() << " was recorded at " << header.sampling_frequency << " sps, but "
+                              << role_ << ".sampling_frequency is set to " << sampling_frequency_ << ".\n";
+                }
+        }
+
     auto item_tuple = itemTypeToSize();
     item_size_ = std::get<0>(item_tuple);
     is_complex_ = std::get<1>(item_tuple);
 
     try
         {
-            // TODO: why are we manually seeking, instead of passing the samples_to_skip to the file_source factory?
             auto samples_to_skip = samplesToSkip();
 
-            file_source_ = gr::blocks::file_source::make(item_size(), filename().data(), repeat());
-
-            if (samples_to_skip > 0)
+            if (is_capture_file)
+                {
+                    // the capture file source seeks the block of samples_to_skip through the index
+                    LOG(INFO) << "Skipping " << samples_to_skip << " samples of the input capture file";
+                    capture_file_source_ = make_capture_file_source(filename(), repeat(), samples_to_skip);
+                    file_source_ = capture_file_source_;
+                }
+            else if (use_mmap_)
+                {
+                    // the mapped file source starts reading at samples_to_skip
+                    LOG(INFO) << "Skipping " << samples_to_skip << " samples of the memory-mapped input file";
+                    mmap_file_source_ = make_mmap_file_source(item_size(), filename(), repeat(), samples_to_skip);
+                    file_source_ = mmap_file_source_;
+                }
+            else
                 {
-                    LOG(INFO) << "Skipping " << samples_to_skip << " samples of the input file";
-                    if (!file_source_->seek(samples_to_skip, SEEK_SET))
+                    // TODO: why are we manually seeking, instead of passing the samples_to_skip to the file_source factory?
+                    auto file_source = gr::blocks::file_source::make(item_size(), filename().data(), repeat());
+
+                    if (samples_to_skip > 0)
                         {
-                            LOG(ERROR) << "Error skipping bytes!";
+                            LOG(INFO) << "Skipping " << samples_to_skip << " samples of the input file";
+                            if (!file_source->seek(samples_to_skip, SEEK_SET))
+                                {
+                                    LOG(ERROR) << "Error skipping bytes!";
+                                }
                         }
+                    file_source_ = file_source;
                 }
         }
     catch (const std::exception& e)
@@ -534,6 +584,22 @@ gnss_shared_ptr<gr::block> FileSourceBase::create_valve()
 {
     if (samples() > 0)
         {
+            if (mmap_file_source_ && source() == file_source())
+                {
+                    // the memory-mapped file source counts the samples itself, so
+                    // that they are not copied by a valve
+                    mmap_file_source_->set_item_limit(samples(), queue_);
+                    DLOG(INFO) << "Item limit of " << samples() << " samples set in the memory-mapped file source";
+                    return valve_;
+                }
+            if (capture_file_source_ && source() == file_source())
+                {
+                    // and so does the capture file source
+                    capture_file_source_->set_item_limit(samples(), queue_);
+                    DLOG(INFO) << "Item limit of " << samples() << " samples set in the capture file source";
+                    return valve_;
+                }
+
             // if a number of samples is specified, honor it by creating a valve
             // in practice, this is always true
             valve_ = gnss_sdr_make_valve(source_item_size(), samples(), queue_);
@@ -546,11 +612,32 @@ gnss_shared_ptr<gr::block> FileSourceBase::create_valve()
 }
 
 
-gr::blocks::file_sink::sptr FileSourceBase::create_sink()
+gnss_shared_ptr<gr::block> FileSourceBase::create_sink()
 {
     if (dump_)
         {
-            sink_ = gr::blocks::file_sink::make(source_item_size(), dump_filename_.c_str());
+            if (dump_format_ == "capture")
+                {
+                    Gnss_Capture_Header header;
+                    header.item_size = static_cast<uint32_t>(source_item_size());
+                    header.item_type = item_type_;
+                    if (source_item_size() != item_size())
+                        {
+                            // the source decodes the items of the file
+                            header.item_type = source_item_size() == sizeof(gr_complex) ? "gr_complex" : "float";
+                        }
+                    header.sampling_frequency = static_cast<double>(sampling_frequency_);
+                    header.intermediate_frequency = dump_intermediate_frequency_;
+                    if (header.intermediate_frequency == 0.0 and capture_file_source_)
+                        {
+                            header.intermediate_frequency = capture_file_source_->header().intermediate_frequency;
+                        }
+                    sink_ = make_capture_file_sink(dump_filename_, header);
+                }
+            else
+                {
+                    sink_ = gr::blocks::file_sink::make(source_item_size(), dump_filename_.c_str());
+                }
             DLOG(INFO) << "file_sink(" << sink_->unique_id() << ")";
 
             // enable subclass hooks
@@ -18,7 +18,9 @@
 #ifndef GNSS_SDR_FILE_SOURCE_BASE_H
 #define GNSS_SDR_FILE_SOURCE_BASE_H
 
+#include "capture_file_source.h"
 #include "concurrent_queue.h"
+#include "mmap_file_source.h"
 #include "signal_source_base.h"
 #include <gnuradio/blocks/file_sink.h>  // for dump
 #include <gnuradio/blocks/file_source.h>
@@ -42,6 +44,8 @@ class ConfigurationInterface;
 //!
 //!   .filename - the path to the input file
 //!             - may be overridden by the -signal_source or -s command-line arguments
+//!             - capture files, written with .dump_format=capture, are detected from their
+//!               header, which gives the item type and the number of samples
 //!
 //!   .samples  - number of samples to process (default 0)
 //!             - if not specified or 0, read the entire file; otherwise stop after that many samples
@@ -54,15 +58,28 @@ class ConfigurationInterface;
 //!
 //!   .seconds_to_skip - number of seconds of lead-in data to skip over (default 0)
 //!
+//!   .samples_to_skip - number of samples of lead-in data to skip over, exactly, instead of
+//!               seconds_to_skip (default 0). A run resumed from a checkpoint sets it
+//!
 //!   .enable_throttle_control - whether to stop reading if the upstream buffer is full (default false)
 //!
 //!   .repeat   - whether to rewind and continue at end of file (default false)
 //!
+//!   .use_mmap - whether to read the file through a memory mapping instead of buffered reads
+//!               (default false). The mapped file source also counts the samples, so no valve
+//!               is needed after it
+//!
 //! (probably abstracted to the base class)
 //!
 //!   .dump     - whether to archive input data
 //!
 //!   .dump_filename - if dumping, path to file for output
+//!
+//!   .dump_format - "raw" (default) to archive the samples as they are, or "capture" to write
+//!                  a capture file, with blocks of losslessly packed samples and an index
+//!
+//!   .dump_intermediate_frequency - intermediate frequency of the samples, stored in the
+//!                  header of the capture file (default 0, or the one of the input capture file)
 class FileSourceBase : public SignalSourceBase
 {
 public:
@@ -134,10 +151,10 @@ protected:
 
     // The methods create the various blocks, if enabled, and return access to them. The created
     // object is also held in this class
-    gr::blocks::file_source::sptr create_file_source();
+    gnss_shared_ptr<gr::block> create_file_source();
     gr::blocks::throttle::sptr create_throttle();
     gnss_shared_ptr<gr::block> create_valve();
-    gr::blocks::file_sink::sptr create_sink();
+    gnss_shared_ptr<gr::block> create_sink();
 
     // Subclass hooks to augment created objects, as required
     virtual void create_file_source_hook();
@@ -152,9 +169,11 @@ protected:
     virtual void post_disconnect_hook(gr::top_block_sptr top_block);
 
 private:
-    gr::blocks::file_source::sptr file_source_;
+    gnss_shared_ptr<gr::block> file_source_;
+    mmap_file_source_sptr mmap_file_source_;        // same as file_source_, if the file is memory-mapped
+    capture_file_source_sptr capture_file_source_;  // same as file_source_, if it is a capture file
     gr::blocks::throttle::sptr throttle_;
-    gr::blocks::file_sink::sptr sink_;
+    gnss_shared_ptr<gr::block> sink_;
 
     // The valve allows only the configured number of samples through, then it closes.
 
@@ -168,16 +187,20 @@ private:
     std::string role_;
     std::string filename_;
     std::string dump_filename_;
+    std::string dump_format_;
     std::string item_type_;
     size_t item_size_;
     size_t header_size_;  // length (in samples) of the header (if any)
     uint64_t samples_;
+    uint64_t samples_to_skip_;
     int64_t sampling_frequency_;  // why is this signed
     double minimum_tail_s_;
     double seconds_to_skip_;
+    double dump_intermediate_frequency_;
     bool is_complex_;  // a misnomer; if I/Q are interleaved as integer values
     bool repeat_;
     bool enable_throttle_control_;
+    bool use_mmap_;
     bool dump_;
 };
 
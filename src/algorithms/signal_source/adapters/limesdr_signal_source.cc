@@ -17,6 +17,7 @@
 #include "limesdr_signal_source.h"
 #include "configuration_interface.h"
 #include "gnss_frequencies.h"
+#include "gnss_sdr_rx_time_timestamp.h"
 #include "gnss_sdr_string_literals.h"
 #include "gnss_sdr_valve.h"
 #include <boost/exception/diagnostic_information.hpp>
@@ -37,6 +38,8 @@ LimesdrSignalSource::LimesdrSignalSource(const ConfigurationInterface* configura
       limesdr_serial_(configuration->property(role + ".limesdr_serial", std::string())),
       limesdr_file_(configuration->property(role + ".limesdr_file", std::string())),
       sample_rate_(configuration->property(role + ".sampling_frequency", 2.0e6)),
+      hw_timestamp_offset_s_(configuration->property(role + ".hw_timestamp_offset_s", 0.0)),
+      hw_timestamp_period_ms_(configuration->property(role + ".hw_timestamp_period_ms", 1000.0)),
       freq_(configuration->property(role + ".freq", FREQ1)),
       gain_(configuration->property(role + ".gain", 40.0)),
       analog_bw_hz_(configuration->property(role + ".analog_bw", sample_rate_ / 2.0)),  // LPF analog filters in I,Q branches
@@ -49,6 +52,7 @@ LimesdrSignalSource::LimesdrSignalSource(const ConfigurationInterface* configura
       antenna_(configuration->property(role + ".antenna", 255)),
       channel_(configuration->property(role + ".channel", 0)),
       PPS_mode_(configuration->property(role + ".PPS_mode", false)),
+      hw_timestamps_(configuration->property(role + ".hw_timestamps", false)),
       dump_(configuration->property(role + ".dump", false))
 {
     if ((limechannel_mode_ < 0) || (limechannel_mode_ > 2))
@@ -153,6 +157,13 @@ LimesdrSignalSource::LimesdrSignalSource(const ConfigurationInterface* configura
             item_size_ = sizeof(int16_t);
         }
 
+    if (hw_timestamps_)
+        {
+            // samples timestamped by the device, with its rx_time tags
+            timestamp_ = gnss_sdr_make_rx_time_timestamp(item_size_, sample_rate_, hw_timestamp_offset_s_, hw_timestamp_period_ms_);
+            DLOG(INFO) << "timestamp(" << timestamp_->unique_id() << ")";
+        }
+
     if (samples_ != 0)
         {
             DLOG(INFO) << "Send STOP signal after " << samples_ << " samples";
@@ -180,9 +191,16 @@ LimesdrSignalSource::LimesdrSignalSource(const ConfigurationInterface* configura
 
 void LimesdrSignalSource::connect(gr::top_block_sptr top_block)
 {
+    gr::basic_block_sptr output = limesdr_source_;
+    if (hw_timestamps_)
+        {
+            top_block->connect(limesdr_source_, 0, timestamp_, 0);
+            DLOG(INFO) << "connected limesdr source to timestamp";
+            output = timestamp_;
+        }
     if (samples_ != 0)
         {
-            top_block->connect(limesdr_source_, 0, valve_, 0);
+            top_block->connect(output, 0, valve_, 0);
             DLOG(INFO) << "connected limesdr source to valve";
             if (dump_)
                 {
@@ -194,7 +212,7 @@ void LimesdrSignalSource::connect(gr::top_block_sptr top_block)
         {
             if (dump_)
                 {
-                    top_block->connect(limesdr_source_, 0, file_sink_, 0);
+                    top_block->connect(output, 0, file_sink_, 0);
                     DLOG(INFO) << "connected limesdr source to file sink";
                 }
         }
@@ -203,9 +221,15 @@ void LimesdrSignalSource::connect(gr::top_block_sptr top_block)
 
 void LimesdrSignalSource::disconnect(gr::top_block_sptr top_block)
 {
+    gr::basic_block_sptr output = limesdr_source_;
+    if (hw_timestamps_)
+        {
+            top_block->disconnect(limesdr_source_, 0, timestamp_, 0);
+            output = timestamp_;
+        }
     if (samples_ != 0)
         {
-            top_block->disconnect(limesdr_source_, 0, valve_, 0);
+            top_block->disconnect(output, 0, valve_, 0);
             if (dump_)
                 {
                     top_block->disconnect(valve_, 0, file_sink_, 0);
@@ -215,7 +239,7 @@ void LimesdrSignalSource::disconnect(gr::top_block_sptr top_block)
         {
             if (dump_)
                 {
-                    top_block->disconnect(limesdr_source_, 0, file_sink_, 0);
+                    top_block->disconnect(output, 0, file_sink_, 0);
                 }
         }
 }
@@ -234,8 +258,9 @@ gr::basic_block_sptr LimesdrSignalSource::get_right_block()
         {
             return valve_;
         }
-    else
+    if (hw_timestamps_)
         {
-            return limesdr_source_;
+            return timestamp_;
         }
+    return limesdr_source_;
 }
@@ -60,6 +60,7 @@ public:
 
 private:
     gr::limesdr::source::sptr limesdr_source_;
+    gnss_shared_ptr<gr::block> timestamp_;
     gnss_shared_ptr<gr::block> valve_;
     gr::blocks::file_sink::sptr file_sink_;
 
@@ -70,6 +71,8 @@ private:
 
     // Front-end settings
     double sample_rate_;
+    double hw_timestamp_offset_s_;
+    double hw_timestamp_period_ms_;
     double freq_;
     double gain_;
     double analog_bw_hz_;
@@ -86,6 +89,7 @@ private:
     int channel_;
 
     bool PPS_mode_;
+    bool hw_timestamps_;
     bool dump_;
 };
 
@@ -20,6 +20,7 @@
 #include "gnss_sdr_flags.h"
 #include "gnss_sdr_string_literals.h"
 #include "gnss_sdr_valve.h"
+#include "mmap_file_source.h"
 #include <glog/logging.h>
 #include <exception>
 #include <fstream>
@@ -52,6 +53,7 @@ MultichannelFileSignalSource::MultichannelFileSignalSource(const ConfigurationIn
     item_type_ = configuration->property(role + ".item_type", default_item_type);
     repeat_ = configuration->property(role + ".repeat", false);
     enable_throttle_control_ = configuration->property(role + ".enable_throttle_control", false);
+    use_mmap_ = configuration->property(role + ".use_mmap", false);
 
     const double seconds_to_skip = configuration->property(role + ".seconds_to_skip", default_seconds_to_skip);
     size_t header_size = configuration->property(role + ".header_size", 0);
@@ -91,33 +93,42 @@ MultichannelFileSignalSource::MultichannelFileSignalSource(const ConfigurationIn
                          << " unrecognized item type. Using gr_complex.";
             item_size_ = sizeof(gr_complex);
         }
+    if (seconds_to_skip > 0)
+        {
+            samples_to_skip = static_cast<int64_t>(seconds_to_skip * sampling_frequency_);
+
+            if (is_complex)
+                {
+                    samples_to_skip *= 2;
+                }
+        }
+    if (header_size > 0)
+        {
+            samples_to_skip += header_size;
+        }
+
     try
         {
             for (int32_t n = 0; n < n_channels_; n++)
                 {
-                    file_source_vec_.push_back(gr::blocks::file_source::make(item_size_, filename_vec_.at(n).c_str(), repeat_));
-
-                    if (seconds_to_skip > 0)
+                    if (use_mmap_)
                         {
-                            samples_to_skip = static_cast<int64_t>(seconds_to_skip * sampling_frequency_);
-
-                            if (is_complex)
-                                {
-                                    samples_to_skip *= 2;
-                                }
+                            // the mapped file sources start reading at samples_to_skip
+                            LOG(INFO) << "Skipping " << samples_to_skip << " samples of the memory-mapped input file #" << n;
+                            file_source_vec_.push_back(make_mmap_file_source(item_size_, filename_vec_.at(n), repeat_, samples_to_skip));
                         }
-                    if (header_size > 0)
-                        {
-                            samples_to_skip += header_size;
-                        }
-
-                    if (samples_to_skip > 0)
+                    else
                         {
-                            LOG(INFO) << "Skipping " << samples_to_skip << " samples of the input file #" << n;
-                            if (not file_source_vec_.back()->seek(samples_to_skip, SEEK_SET))
+                            auto file_source = gr::blocks::file_source::make(item_size_, filename_vec_.at(n).c_str(), repeat_);
+                            if (samples_to_skip > 0)
                                 {
-                                    LOG(INFO) << "Error skipping bytes!";
+                                    LOG(INFO) << "Skipping " << samples_to_skip << " samples of the input file #" << n;
+                                    if (not file_source->seek(samples_to_skip, SEEK_SET))
+                                        {
+                                            LOG(INFO) << "Error skipping bytes!";
+                                        }
                                 }
+                            file_source_vec_.push_back(file_source);
                         }
                 }
         }
@@ -18,6 +18,7 @@
 #include "osmosdr_signal_source.h"
 #include "GPS_L1_CA.h"
 #include "configuration_interface.h"
+#include "gnss_sdr_rx_time_timestamp.h"
 #include "gnss_sdr_string_literals.h"
 #include "gnss_sdr_valve.h"
 #include <boost/exception/diagnostic_information.hpp>
@@ -38,6 +39,8 @@ OsmosdrSignalSource::OsmosdrSignalSource(const ConfigurationInterface* configura
       osmosdr_args_(configuration->property(role + ".osmosdr_args", std::string())),
       antenna_(configuration->property(role + ".antenna", std::string())),
       sample_rate_(configuration->property(role + ".sampling_frequency", 2.0e6)),
+      hw_timestamp_offset_s_(configuration->property(role + ".hw_timestamp_offset_s", 0.0)),
+      hw_timestamp_period_ms_(configuration->property(role + ".hw_timestamp_period_ms", 1000.0)),
       freq_(configuration->property(role + ".freq", GPS_L1_FREQ_HZ)),
       gain_(configuration->property(role + ".gain", 40.0)),
       if_gain_(configuration->property(role + ".if_gain", 40.0)),
@@ -46,6 +49,7 @@ OsmosdrSignalSource::OsmosdrSignalSource(const ConfigurationInterface* configura
       in_stream_(in_stream),
       out_stream_(out_stream),
       AGC_enabled_(configuration->property(role + ".AGC_enabled", true)),
+      hw_timestamps_(configuration->property(role + ".hw_timestamps", false)),
       dump_(configuration->property(role + ".dump", false))
 {
     if (item_type_ == "short")
@@ -115,6 +119,13 @@ OsmosdrSignalSource::OsmosdrSignalSource(const ConfigurationInterface* configura
             item_size_ = sizeof(int16_t);
         }
 
+    if (hw_timestamps_)
+        {
+            // samples timestamped by the device, with its rx_time tags
+            timestamp_ = gnss_sdr_make_rx_time_timestamp(item_size_, sample_rate_, hw_timestamp_offset_s_, hw_timestamp_period_ms_);
+            DLOG(INFO) << "timestamp(" << timestamp_->unique_id() << ")";
+        }
+
     if (samples_ != 0)
         {
             DLOG(INFO) << "Send STOP signal after " << samples_ << " samples";
@@ -160,9 +171,16 @@ void OsmosdrSignalSource::driver_instance()
 
 void OsmosdrSignalSource::connect(gr::top_block_sptr top_block)
 {
+    gr::basic_block_sptr output = osmosdr_source_;
+    if (hw_timestamps_)
+        {
+            top_block->connect(osmosdr_source_, 0, timestamp_, 0);
+            DLOG(INFO) << "connected osmosdr source to timestamp";
+            output = timestamp_;
+        }
     if (samples_ != 0)
         {
-            top_block->connect(osmosdr_source_, 0, valve_, 0);
+            top_block->connect(output, 0, valve_, 0);
             DLOG(INFO) << "connected osmosdr source to valve";
             if (dump_)
                 {
@@ -174,7 +192,7 @@ void OsmosdrSignalSource::connect(gr::top_block_sptr top_block)
         {
             if (dump_)
                 {
-                    top_block->connect(osmosdr_source_, 0, file_sink_, 0);
+                    top_block->connect(output, 0, file_sink_, 0);
                     DLOG(INFO) << "connected osmosdr source to file sink";
                 }
         }
@@ -183,9 +201,15 @@ void OsmosdrSignalSource::connect(gr::top_block_sptr top_block)
 
 void OsmosdrSignalSource::disconnect(gr::top_block_sptr top_block)
 {
+    gr::basic_block_sptr output = osmosdr_source_;
+    if (hw_timestamps_)
+        {
+            top_block->disconnect(osmosdr_source_, 0, timestamp_, 0);
+            output = timestamp_;
+        }
     if (samples_ != 0)
         {
-            top_block->disconnect(osmosdr_source_, 0, valve_, 0);
+            top_block->disconnect(output, 0, valve_, 0);
             if (dump_)
                 {
                     top_block->disconnect(valve_, 0, file_sink_, 0);
@@ -195,7 +219,7 @@ void OsmosdrSignalSource::disconnect(gr::top_block_sptr top_block)
         {
             if (dump_)
                 {
-                    top_block->disconnect(osmosdr_source_, 0, file_sink_, 0);
+                    top_block->disconnect(output, 0, file_sink_, 0);
                 }
         }
 }
@@ -214,8 +238,9 @@ gr::basic_block_sptr OsmosdrSignalSource::get_right_block()
         {
             return valve_;
         }
-    else
+    if (hw_timestamps_)
         {
-            return osmosdr_source_;
+            return timestamp_;
         }
+    return osmosdr_source_;
 }
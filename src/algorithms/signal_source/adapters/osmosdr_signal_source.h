@@ -65,6 +65,7 @@ private:
     void driver_instance();
 
     osmosdr::source::sptr osmosdr_source_;
+    gnss_shared_ptr<gr::block> timestamp_;
     gnss_shared_ptr<gr::block> valve_;
     gr::blocks::file_sink::sptr file_sink_;
 
@@ -75,6 +76,8 @@ private:
 
     // Front-end settings
     double sample_rate_;
+    double hw_timestamp_offset_s_;
+    double hw_timestamp_period_ms_;
     double freq_;
     double gain_;
     double if_gain_;
@@ -87,6 +90,7 @@ private:
     unsigned int out_stream_;
 
     bool AGC_enabled_;
+    bool hw_timestamps_;
     bool dump_;
 };
 
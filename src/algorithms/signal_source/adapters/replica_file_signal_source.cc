@@ -0,0 +1,112 @@
+/*!
+ * \file replica_file_signal_source.cc
+ * \brief Signal source that feeds a single recording to several virtual RF
+ * channels, for scaling tests
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "replica_file_signal_source.h"
+#include "configuration_interface.h"
+#include "gnss_sdr_string_literals.h"
+#include <glog/logging.h>
+#include <gnuradio/gr_complex.h>
+
+using namespace std::string_literals;
+
+ReplicaFileSignalSource::ReplicaFileSignalSource(ConfigurationInterface const* configuration,
+    std::string const& role, unsigned int in_streams, unsigned int out_streams,
+    Concurrent_Queue<pmt::pmt_t>* queue)
+    : FileSourceBase(configuration, role, "Replica_File_Signal_Source"s, queue, "gr_complex"s)
+{
+    const auto doppler_step_hz = configuration->property(role + ".doppler_step_hz"s, 0.0);
+    const auto delay_step_samples = configuration->property(role + ".delay_step_samples"s, uint64_t(0));
+    // the RF channel 0 is the recording itself
+    doppler_hz_vec_.push_back(0.0);
+    delay_samples_vec_.push_back(0);
+    for (size_t k = 1; k < getRfChannels(); k++)
+        {
+            const auto default_doppler_hz = static_cast<double>(k) * doppler_step_hz;
+            const auto default_delay_samples = static_cast<uint64_t>(k) * delay_step_samples;
+            doppler_hz_vec_.push_back(configuration->property(role + ".doppler_hz"s + std::to_string(k), default_doppler_hz));
+            delay_samples_vec_.push_back(configuration->property(role + ".delay_samples"s + std::to_string(k), default_delay_samples));
+        }
+
+    if (in_streams > 0)
+        {
+            LOG(ERROR) << "A signal source does not have an input stream";
+        }
+    if (out_streams > 1)
+        {
+            LOG(ERROR) << "This implementation only supports one output stream";
+        }
+}
+
+
+gr::basic_block_sptr ReplicaFileSignalSource::get_right_block(int RF_channel)
+{
+    if (RF_channel > 0 and static_cast<size_t>(RF_channel) < replica_vec_.size() and replica_vec_.at(RF_channel))
+        {
+            return replica_vec_.at(RF_channel);
+        }
+    return get_right_block();
+}
+
+
+void ReplicaFileSignalSource::post_connect_hook(gr::top_block_sptr top_block)
+{
+    // the item size is known once the file source is created
+    const auto output = get_right_block();
+    const auto output_item_size = static_cast<size_t>(output->output_signature()->sizeof_stream_item(0));
+    if (replica_vec_.empty())
+        {
+            for (size_t k = 0; k < doppler_hz_vec_.size(); k++)
+                {
+                    if (doppler_hz_vec_[k] != 0.0 and output_item_size != sizeof(gr_complex))
+                        {
+                            LOG(WARNING) << "The RF channel " << k << " of " << role() << " cannot be shifted in frequency with item type "
+                                         << item_type() << ". Using a frequency shift of 0 Hz.";
+                            doppler_hz_vec_[k] = 0.0;
+                        }
+                    if (doppler_hz_vec_[k] == 0.0 and delay_samples_vec_[k] == 0)
+                        {
+                            replica_vec_.emplace_back(nullptr);
+                            continue;
+                        }
+                    replica_vec_.push_back(make_signal_replica(output_item_size, static_cast<double>(sampling_frequency()), doppler_hz_vec_[k], delay_samples_vec_[k]));
+                    DLOG(INFO) << "signal_replica(" << replica_vec_.back()->unique_id() << ") for RF channel " << k
+                               << ": " << doppler_hz_vec_[k] << " [Hz], " << delay_samples_vec_[k] << " [samples]";
+                }
+        }
+
+    for (size_t k = 0; k < replica_vec_.size(); k++)
+        {
+            if (replica_vec_[k])
+                {
+                    top_block->connect(output, 0, replica_vec_[k], 0);
+                    DLOG(INFO) << "connected file source output to the replica of RF channel " << k;
+                }
+        }
+}
+
+
+void ReplicaFileSignalSource::pre_disconnect_hook(gr::top_block_sptr top_block)
+{
+    const auto output = get_right_block();
+    for (size_t k = 0; k < replica_vec_.size(); k++)
+        {
+            if (replica_vec_[k])
+                {
+                    top_block->disconnect(output, 0, replica_vec_[k], 0);
+                    DLOG(INFO) << "disconnected file source output from the replica of RF channel " << k;
+                }
+        }
+}
@@ -0,0 +1,78 @@
+/*!
+ * \file replica_file_signal_source.h
+ * \brief Signal source that feeds a single recording to several virtual RF
+ * channels, for scaling tests
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_REPLICA_FILE_SIGNAL_SOURCE_H
+#define GNSS_SDR_REPLICA_FILE_SIGNAL_SOURCE_H
+
+#include "file_source_base.h"
+#include "signal_replica.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_adapters
+ * \{ */
+
+
+class ConfigurationInterface;
+
+//! \brief Class that reads signal samples from a file, as FileSignalSource
+//! does, and outputs them in .RF_channels virtual RF channels.
+//!
+//! The RF channel 0 is the recording itself. The RF channel k can be delayed
+//! and shifted in frequency, so that the channels do not track the same
+//! samples. The RF channels without offsets read the output buffer of the file
+//! source, without copies.
+//!
+//! In addition to the properties of FileSourceBase, it supports:
+//!
+//!   .RF_channels - number of virtual RF channels (default 1)
+//!
+//!   .doppler_step_hz - frequency shift of the RF channel k is k times this value (default 0)
+//!
+//!   .delay_step_samples - delay of the RF channel k is k times this value (default 0)
+//!
+//!   .doppler_hzk, .delay_samplesk - frequency shift and delay of the RF channel k > 0, if set
+//!
+//! Frequency shifts need .item_type=gr_complex.
+class ReplicaFileSignalSource : public FileSourceBase
+{
+public:
+    ReplicaFileSignalSource(ConfigurationInterface const* configuration, std::string const& role,
+        unsigned int in_streams, unsigned int out_streams,
+        Concurrent_Queue<pmt::pmt_t>* queue);
+
+    ~ReplicaFileSignalSource() = default;
+
+    using FileSourceBase::get_right_block;
+    gr::basic_block_sptr get_right_block(int RF_channel) override;
+
+protected:
+    void post_connect_hook(gr::top_block_sptr top_block) override;
+    void pre_disconnect_hook(gr::top_block_sptr top_block) override;
+
+private:
+    std::vector<signal_replica_sptr> replica_vec_;  // nullptr for the RF channels without offsets
+    std::vector<double> doppler_hz_vec_;
+    std::vector<uint64_t> delay_samples_vec_;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_REPLICA_FILE_SIGNAL_SOURCE_H
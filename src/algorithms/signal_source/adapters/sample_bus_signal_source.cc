@@ -0,0 +1,103 @@
+/*!
+ * \file sample_bus_signal_source.cc
+ * \brief Signal source reading the samples that another receiver of the same
+ * host writes to a shared memory sample bus
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "sample_bus_signal_source.h"
+#include "configuration_interface.h"
+#include "gnss_sdr_string_literals.h"
+#include <glog/logging.h>
+#include <cstdint>
+
+using namespace std::string_literals;
+
+
+SampleBusSignalSource::SampleBusSignalSource(const ConfigurationInterface* configuration,
+    const std::string& role,
+    unsigned int in_stream,
+    unsigned int out_stream,
+    [[maybe_unused]] Concurrent_Queue<pmt::pmt_t>* queue)
+    : SignalSourceBase(configuration, role, "Sample_Bus_Signal_Source"s),
+      dump_filename_(configuration->property(role + ".dump_filename"s, "./data/signal_source.dat"s)),
+      item_size_(sizeof(gr_complex)),
+      dump_(configuration->property(role + ".dump"s, false))
+{
+    const std::string item_type = configuration->property(role + ".item_type"s, "gr_complex"s);
+    if (item_type == "cshort")
+        {
+            item_size_ = 2 * sizeof(int16_t);
+        }
+    else if (item_type == "cbyte")
+        {
+            item_size_ = 2 * sizeof(int8_t);
+        }
+    else if (item_type != "gr_complex")
+        {
+            LOG(WARNING) << item_type << " unrecognized item type for the sample bus, using gr_complex";
+        }
+
+    const std::string bus_name = configuration->property(role + ".bus_name"s, "gnss-sdr-samples"s);
+    const auto fs = static_cast<uint64_t>(configuration->property("GNSS-SDR.internal_fs_sps"s, 0.0));
+    const uint64_t max_gap_samples = configuration->property(role + ".max_gap_samples"s, fs);
+
+    source_ = make_sample_bus_source(item_size_, bus_name, max_gap_samples);
+    DLOG(INFO) << "sample_bus_source(" << source_->unique_id() << ")";
+
+    if (dump_)
+        {
+            DLOG(INFO) << "Dumping output into file " << dump_filename_;
+            file_sink_ = gr::blocks::file_sink::make(item_size_, dump_filename_.c_str());
+        }
+
+    if (in_stream > 0)
+        {
+            LOG(ERROR) << "A signal source does not have an input stream";
+        }
+    if (out_stream > 1)
+        {
+            LOG(ERROR) << "This implementation only supports one output stream";
+        }
+}
+
+
+void SampleBusSignalSource::connect(gr::top_block_sptr top_block)
+{
+    if (dump_)
+        {
+            top_block->connect(source_, 0, file_sink_, 0);
+            DLOG(INFO) << "connected sample bus source to file sink";
+        }
+}
+
+
+void SampleBusSignalSource::disconnect(gr::top_block_sptr top_block)
+{
+    if (dump_)
+        {
+            top_block->disconnect(source_, 0, file_sink_, 0);
+        }
+}
+
+
+gr::basic_block_sptr SampleBusSignalSource::get_left_block()
+{
+    LOG(WARNING) << "Left block of a signal source should not be retrieved";
+    return gr::block_sptr();
+}
+
+
+gr::basic_block_sptr SampleBusSignalSource::get_right_block()
+{
+    return source_;
+}
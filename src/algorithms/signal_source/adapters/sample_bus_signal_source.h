@@ -0,0 +1,81 @@
+/*!
+ * \file sample_bus_signal_source.h
+ * \brief Signal source reading the samples that another receiver of the same
+ * host writes to a shared memory sample bus
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_SAMPLE_BUS_SIGNAL_SOURCE_H
+#define GNSS_SDR_SAMPLE_BUS_SIGNAL_SOURCE_H
+
+#include "concurrent_queue.h"
+#include "sample_bus_source.h"
+#include "signal_source_base.h"
+#include <gnuradio/blocks/file_sink.h>
+#include <pmt/pmt.h>
+#include <cstddef>
+#include <string>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_adapters
+ * \{ */
+
+class ConfigurationInterface;
+
+/*!
+ * \brief This class reads the samples that a receiver of the same host writes
+ * from the output of its Signal Conditioner to a shared memory sample bus
+ * (property distribute_bus_name of the conditioner), so that several
+ * receivers share the channels of a single front-end without copying the
+ * samples over the network stack.
+ *
+ * This class supports the following properties:
+ *
+ *   .item_type            - gr_complex, cshort or cbyte, the item type of the samples of the bus
+ *   .bus_name             - name of the sample bus (default: gnss-sdr-samples)
+ *   .max_gap_samples      - longest overrun filled with zeros (default: internal_fs_sps, one second)
+ *   .dump, .dump_filename - whether and where to write the samples read
+ */
+class SampleBusSignalSource : public SignalSourceBase
+{
+public:
+    SampleBusSignalSource(const ConfigurationInterface* configuration,
+        const std::string& role,
+        unsigned int in_stream,
+        unsigned int out_stream,
+        Concurrent_Queue<pmt::pmt_t>* queue);
+
+    ~SampleBusSignalSource() = default;
+
+    inline size_t item_size() override
+    {
+        return item_size_;
+    }
+
+    void connect(gr::top_block_sptr top_block) override;
+    void disconnect(gr::top_block_sptr top_block) override;
+    gr::basic_block_sptr get_left_block() override;
+    gr::basic_block_sptr get_right_block() override;
+
+private:
+    sample_bus_source_sptr source_;
+    gr::blocks::file_sink::sptr file_sink_;
+    std::string dump_filename_;
+    size_t item_size_;
+    bool dump_;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_SAMPLE_BUS_SIGNAL_SOURCE_H
@@ -0,0 +1,99 @@
+/*!
+ * \file sample_push_signal_source.cc
+ * \brief Signal source reading the sample buffers pushed by the application
+ * that embeds the receiver
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "sample_push_signal_source.h"
+#include "configuration_interface.h"
+#include "gnss_sdr_string_literals.h"
+#include <glog/logging.h>
+#include <cstdint>
+
+using namespace std::string_literals;
+
+
+SamplePushSignalSource::SamplePushSignalSource(const ConfigurationInterface* configuration,
+    const std::string& role,
+    unsigned int in_stream,
+    unsigned int out_stream,
+    [[maybe_unused]] Concurrent_Queue<pmt::pmt_t>* queue)
+    : SignalSourceBase(configuration, role, "Sample_Push_Signal_Source"s),
+      dump_filename_(configuration->property(role + ".dump_filename"s, "./data/signal_source.dat"s)),
+      item_size_(sizeof(gr_complex)),
+      dump_(configuration->property(role + ".dump"s, false))
+{
+    const std::string item_type = configuration->property(role + ".item_type"s, "gr_complex"s);
+    if (item_type == "cshort")
+        {
+            item_size_ = 2 * sizeof(int16_t);
+        }
+    else if (item_type == "cbyte")
+        {
+            item_size_ = 2 * sizeof(int8_t);
+        }
+    else if (item_type != "gr_complex")
+        {
+            LOG(WARNING) << item_type << " unrecognized item type for the pushed samples, using gr_complex";
+        }
+
+    source_ = make_sample_push_source(item_size_, configuration->property(role + ".channel_name"s, "samples"s));
+    DLOG(INFO) << "sample_push_source(" << source_->unique_id() << ")";
+
+    if (dump_)
+        {
+            DLOG(INFO) << "Dumping output into file " << dump_filename_;
+            file_sink_ = gr::blocks::file_sink::make(item_size_, dump_filename_.c_str());
+        }
+
+    if (in_stream > 0)
+        {
+            LOG(ERROR) << "A signal source does not have an input stream";
+        }
+    if (out_stream > 1)
+        {
+            LOG(ERROR) << "This implementation only supports one output stream";
+        }
+}
+
+
+void SamplePushSignalSource::connect(gr::top_block_sptr top_block)
+{
+    if (dump_)
+        {
+            top_block->connect(source_, 0, file_sink_, 0);
+            DLOG(INFO) << "connected sample push source to file sink";
+        }
+}
+
+
+void SamplePushSignalSource::disconnect(gr::top_block_sptr top_block)
+{
+    if (dump_)
+        {
+            top_block->disconnect(source_, 0, file_sink_, 0);
+        }
+}
+
+
+gr::basic_block_sptr SamplePushSignalSource::get_left_block()
+{
+    LOG(WARNING) << "Left block of a signal source should not be retrieved";
+    return gr::block_sptr();
+}
+
+
+gr::basic_block_sptr SamplePushSignalSource::get_right_block()
+{
+    return source_;
+}
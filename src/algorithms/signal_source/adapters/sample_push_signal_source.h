@@ -0,0 +1,79 @@
+/*!
+ * \file sample_push_signal_source.h
+ * \brief Signal source reading the sample buffers pushed by the application
+ * that embeds the receiver
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_SAMPLE_PUSH_SIGNAL_SOURCE_H
+#define GNSS_SDR_SAMPLE_PUSH_SIGNAL_SOURCE_H
+
+#include "concurrent_queue.h"
+#include "sample_push_source.h"
+#include "signal_source_base.h"
+#include <gnuradio/blocks/file_sink.h>
+#include <pmt/pmt.h>
+#include <cstddef>
+#include <string>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_adapters
+ * \{ */
+
+class ConfigurationInterface;
+
+/*!
+ * \brief This class reads the sample buffers that an application running
+ * the receiver in its own process pushes through a Gnss_Sample_Push_Channel
+ * (see Gnss_Sdr_Receiver::push_samples), without pipes nor sockets.
+ *
+ * This class supports the following properties:
+ *
+ *   .item_type            - gr_complex, cshort or cbyte, the item type of the pushed samples
+ *   .channel_name         - name of the push channel (default: samples)
+ *   .max_buffers          - buffers waiting to be read before the application waits (default: 64)
+ *   .dump, .dump_filename - whether and where to write the pushed samples
+ */
+class SamplePushSignalSource : public SignalSourceBase
+{
+public:
+    SamplePushSignalSource(const ConfigurationInterface* configuration,
+        const std::string& role,
+        unsigned int in_stream,
+        unsigned int out_stream,
+        Concurrent_Queue<pmt::pmt_t>* queue);
+
+    ~SamplePushSignalSource() = default;
+
+    inline size_t item_size() override
+    {
+        return item_size_;
+    }
+
+    void connect(gr::top_block_sptr top_block) override;
+    void disconnect(gr::top_block_sptr top_block) override;
+    gr::basic_block_sptr get_left_block() override;
+    gr::basic_block_sptr get_right_block() override;
+
+private:
+    sample_push_source_sptr source_;
+    gr::blocks::file_sink::sptr file_sink_;
+    std::string dump_filename_;
+    size_t item_size_;
+    bool dump_;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_SAMPLE_PUSH_SIGNAL_SOURCE_H
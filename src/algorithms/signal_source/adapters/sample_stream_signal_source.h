@@ -0,0 +1,82 @@
+/*!
+ * \file sample_stream_signal_source.h
+ * \brief Signal source receiving the samples distributed by another receiver
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_SAMPLE_STREAM_SIGNAL_SOURCE_H
+#define GNSS_SDR_SAMPLE_STREAM_SIGNAL_SOURCE_H
+
+#include "concurrent_queue.h"
+#include "sample_stream_source.h"
+#include "signal_source_base.h"
+#include <gnuradio/blocks/file_sink.h>
+#include <pmt/pmt.h>
+#include <cstddef>
+#include <string>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_adapters
+ * \{ */
+
+class ConfigurationInterface;
+
+/*!
+ * \brief This class receives the samples that a receiver distributes from
+ * the output of its Signal Conditioner (property distribute_address of the
+ * conditioner), so that several receivers share the channels of a single
+ * front-end.
+ *
+ * This class supports the following properties:
+ *
+ *   .item_type            - gr_complex, cshort or cbyte, the item type of the distributed samples
+ *   .address              - multicast group, or any address for unicast (default: 239.255.0.1)
+ *   .port                 - UDP port (default: 1234)
+ *   .interface_address    - address of the network interface joining the group (default: any)
+ *   .receive_buffer_bytes - size of the socket receive buffer (default: 8388608)
+ *   .max_gap_samples      - longest gap filled with zeros (default: internal_fs_sps, one second)
+ *   .dump, .dump_filename - whether and where to write the received samples
+ */
+class SampleStreamSignalSource : public SignalSourceBase
+{
+public:
+    SampleStreamSignalSource(const ConfigurationInterface* configuration,
+        const std::string& role,
+        unsigned int in_stream,
+        unsigned int out_stream,
+        Concurrent_Queue<pmt::pmt_t>* queue);
+
+    ~SampleStreamSignalSource() = default;
+
+    inline size_t item_size() override
+    {
+        return item_size_;
+    }
+
+    void connect(gr::top_block_sptr top_block) override;
+    void disconnect(gr::top_block_sptr top_block) override;
+    gr::basic_block_sptr get_left_block() override;
+    gr::basic_block_sptr get_right_block() override;
+
+private:
+    sample_stream_source_sptr source_;
+    gr::blocks::file_sink::sptr file_sink_;
+    std::string dump_filename_;
+    size_t item_size_;
+    bool dump_;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_SAMPLE_STREAM_SIGNAL_SOURCE_H
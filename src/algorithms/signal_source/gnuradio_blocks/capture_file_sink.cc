@@ -0,0 +1,72 @@
+/*!
+ * \file capture_file_sink.cc
+ * \brief Writes samples to a capture file
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "capture_file_sink.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+#include <chrono>
+
+
+capture_file_sink_sptr make_capture_file_sink(const std::string &filename,
+    const Gnss_Capture_Header &header)
+{
+    return capture_file_sink_sptr(new capture_file_sink(filename, header));
+}
+
+
+capture_file_sink::capture_file_sink(const std::string &filename,
+    const Gnss_Capture_Header &header) : gr::sync_block("capture_file_sink",
+                                             gr::io_signature::make(1, 1, header.item_size),
+                                             gr::io_signature::make(0, 0, 0)),
+                                         d_writer(filename, header),
+                                         d_rx_time_key(pmt::mp("rx_time"))
+{
+    DLOG(INFO) << "Writing the capture file " << filename;
+}
+
+
+bool capture_file_sink::stop()
+{
+    d_writer.close();
+    LOG(INFO) << "Capture file written with " << d_writer.items() << " items in " << d_writer.bytes() << " bytes";
+    return true;
+}
+
+
+int capture_file_sink::work(int noutput_items,
+    gr_vector_const_void_star &input_items,
+    gr_vector_void_star &output_items __attribute__((unused)))
+{
+    const uint64_t first_item = nitems_read(0);
+    get_tags_in_range(d_tags, 0, first_item, first_item + noutput_items, d_rx_time_key);
+    for (const auto &tag : d_tags)
+        {
+            // rx_time is a tuple of the integer seconds and the fractional seconds
+            if (pmt::is_tuple(tag.value) and pmt::length(tag.value) == 2)
+                {
+                    d_writer.set_time(tag.offset, static_cast<double>(pmt::to_uint64(pmt::tuple_ref(tag.value, 0))) +
+                                                      pmt::to_double(pmt::tuple_ref(tag.value, 1)));
+                }
+        }
+    if (!d_writer.has_time())
+        {
+            // the stream is not timestamped
+            const auto now = std::chrono::system_clock::now().time_since_epoch();
+            d_writer.set_time(first_item, std::chrono::duration<double>(now).count());
+        }
+
+    d_writer.write(input_items[0], noutput_items);
+    return noutput_items;
+}
@@ -0,0 +1,76 @@
+/*!
+ * \file capture_file_sink.h
+ * \brief Writes samples to a capture file
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_CAPTURE_FILE_SINK_H
+#define GNSS_SDR_CAPTURE_FILE_SINK_H
+
+#include "gnss_block_interface.h"
+#include "gnss_capture_file.h"
+#include <gnuradio/sync_block.h>
+#include <pmt/pmt.h>
+#include <string>
+#include <vector>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_gnuradio_blocks
+ * \{ */
+
+
+class capture_file_sink;
+
+using capture_file_sink_sptr = gnss_shared_ptr<capture_file_sink>;
+
+/*!
+ * \brief Creates a sink writing the items described by header to the
+ * capture file filename. Throws std::runtime_error if the file cannot be
+ * written.
+ */
+capture_file_sink_sptr make_capture_file_sink(const std::string &filename,
+    const Gnss_Capture_Header &header);
+
+/*!
+ * \brief This class writes its input to a capture file, instead of the raw
+ * file written by gr::blocks::file_sink.
+ *
+ * The items are timestamped with the rx_time tags of the stream, if any, or
+ * otherwise with the system time at the start.
+ */
+class capture_file_sink : public gr::sync_block
+{
+public:
+    //! Writes the last block and the index of the file
+    bool stop();
+
+    int work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+private:
+    friend capture_file_sink_sptr make_capture_file_sink(const std::string &filename,
+        const Gnss_Capture_Header &header);
+
+    capture_file_sink(const std::string &filename,
+        const Gnss_Capture_Header &header);
+
+    Gnss_Capture_Writer d_writer;
+    std::vector<gr::tag_t> d_tags;
+    pmt::pmt_t d_rx_time_key;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_CAPTURE_FILE_SINK_H
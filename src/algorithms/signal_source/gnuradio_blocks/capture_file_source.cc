@@ -0,0 +1,122 @@
+/*!
+ * \file capture_file_source.cc
+ * \brief Reads samples from a capture file
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "capture_file_source.h"
+#include "control_event.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+#include <algorithm>  // for std::min
+#include <cmath>      // for floor, isnan
+
+
+capture_file_source_sptr make_capture_file_source(const std::string &filename,
+    bool repeat,
+    uint64_t offset_items)
+{
+    return capture_file_source_sptr(new capture_file_source(filename, repeat, offset_items));
+}
+
+
+capture_file_source::capture_file_source(const std::string &filename,
+    bool repeat,
+    uint64_t offset_items) : gr::sync_block("capture_file_source",
+                                 gr::io_signature::make(0, 0, 0),
+                                 gr::io_signature::make(1, 1, Gnss_Capture_Reader(filename).header().item_size)),
+                             d_reader(filename),
+                             d_queue(nullptr),
+                             d_nitems(0),
+                             d_produced(0),
+                             d_repeat(repeat),
+                             d_tag_pending(true)
+{
+    d_reader.seek(offset_items);
+    DLOG(INFO) << "Reading the capture file " << filename << ", starting at item " << d_reader.tell();
+}
+
+
+const Gnss_Capture_Header &capture_file_source::header() const
+{
+    return d_reader.header();
+}
+
+
+void capture_file_source::set_item_limit(uint64_t nitems, Concurrent_Queue<pmt::pmt_t> *queue)
+{
+    d_nitems = nitems;
+    d_queue = queue;
+}
+
+
+void capture_file_source::add_time_tag(uint64_t item)
+{
+    const double time_s = d_reader.time_of(d_reader.tell());
+    if (!std::isnan(time_s))
+        {
+            const double full_secs = std::floor(time_s);
+            add_item_tag(0, item, pmt::mp("rx_time"),
+                pmt::make_tuple(pmt::from_uint64(static_cast<uint64_t>(full_secs)), pmt::from_double(time_s - full_secs)));
+        }
+    d_tag_pending = false;
+}
+
+
+int capture_file_source::work(int noutput_items,
+    gr_vector_const_void_star &input_items __attribute__((unused)),
+    gr_vector_void_star &output_items)
+{
+    if (d_nitems > 0)
+        {
+            if (d_produced >= d_nitems)
+                {
+                    LOG(INFO) << "Stopping receiver, " << d_produced << " samples processed";
+                    if (d_queue != nullptr)
+                        {
+                            d_queue->push(control_event_pmt(Control_Event::command, 200, 0));
+                        }
+                    return WORK_DONE;
+                }
+            noutput_items = static_cast<int>(std::min(d_nitems - d_produced, static_cast<uint64_t>(noutput_items)));
+        }
+
+    auto *out = static_cast<uint8_t *>(output_items[0]);
+    const size_t item_size = header().item_size;
+    size_t copied = 0;
+    while (copied < static_cast<size_t>(noutput_items))
+        {
+            if (d_tag_pending)
+                {
+                    add_time_tag(nitems_written(0) + copied);
+                }
+            const size_t n = d_reader.read(out + copied * item_size, noutput_items - copied);
+            if (n == 0)
+                {
+                    if (!d_repeat or d_reader.tell() == 0)
+                        {
+                            break;
+                        }
+                    // rewind to the beginning of the file
+                    d_reader.seek(0);
+                    d_tag_pending = true;
+                }
+            copied += n;
+        }
+
+    if (copied == 0)
+        {
+            return WORK_DONE;  // end of file
+        }
+    d_produced += copied;
+    return static_cast<int>(copied);
+}
@@ -0,0 +1,92 @@
+/*!
+ * \file capture_file_source.h
+ * \brief Reads samples from a capture file
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_CAPTURE_FILE_SOURCE_H
+#define GNSS_SDR_CAPTURE_FILE_SOURCE_H
+
+#include "concurrent_queue.h"
+#include "gnss_block_interface.h"
+#include "gnss_capture_file.h"
+#include <gnuradio/sync_block.h>
+#include <pmt/pmt.h>
+#include <cstdint>
+#include <string>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_gnuradio_blocks
+ * \{ */
+
+
+class capture_file_source;
+
+using capture_file_source_sptr = gnss_shared_ptr<capture_file_source>;
+
+/*!
+ * \brief Creates a source reading the items of the capture file filename,
+ * starting at item number offset_items. Throws std::runtime_error if it is
+ * not a capture file.
+ */
+capture_file_source_sptr make_capture_file_source(const std::string &filename,
+    bool repeat,
+    uint64_t offset_items = 0);
+
+/*!
+ * \brief This class reads the items of a capture file, written by
+ * capture_file_sink or by the dump of a file signal source.
+ *
+ * The first item, and the first item after each rewind, are tagged with the
+ * rx_time of the recording, if it is timestamped. As mmap_file_source, the
+ * source can also stop the receiver after a given number of items.
+ */
+class capture_file_source : public gr::sync_block
+{
+public:
+    //! Description of the samples, from the header of the file
+    const Gnss_Capture_Header &header() const;
+
+    /*!
+     * \brief Sends a STOP message to queue, and ends the stream, after nitems
+     * items were produced. 0 means no limit.
+     */
+    void set_item_limit(uint64_t nitems, Concurrent_Queue<pmt::pmt_t> *queue);
+
+    int work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+private:
+    friend capture_file_source_sptr make_capture_file_source(const std::string &filename,
+        bool repeat,
+        uint64_t offset_items);
+
+    capture_file_source(const std::string &filename,
+        bool repeat,
+        uint64_t offset_items);
+
+    void add_time_tag(uint64_t item);
+
+    Gnss_Capture_Reader d_reader;
+    Concurrent_Queue<pmt::pmt_t> *d_queue;
+    uint64_t d_nitems;    // 0 for no limit
+    uint64_t d_produced;  // items produced
+    bool d_repeat;
+    bool d_tag_pending;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_CAPTURE_FILE_SOURCE_H
@@ -17,6 +17,7 @@
 
 #include "fifo_reader.h"
 #include <glog/logging.h>
+#include <cstring>  // for memcpy
 
 // initial construction; pass to private constructor
 FifoReader::sptr FifoReader::make(const std::string &file_name, const std::string &sample_type)
@@ -30,8 +31,16 @@ FifoReader::FifoReader(const std::string &file_name, const std::string &sample_t
           gr::io_signature::make(0, 0, 0),                    // no input
           gr::io_signature::make(1, 1, sizeof(gr_complex))),  // <+MIN_OUT+>, <+MAX_OUT+>, sizeof(<+OTYPE+>)
       file_name_(file_name),
-      sample_type_(sample_type)
+      sample_type_(sample_type),
+      item_size_(sizeof(gr_complex))
 {
+    // ishort == int16_t and ibyte == int8_t, stored as interleaved I/Q
+    if (sample_type_ == "ishort" || sample_type_ == "ibyte")
+        {
+            const std::string interleaved_type = sample_type_ == "ishort" ? "cshort" : "cbyte";
+            converter_ = make_vector_converter(interleaved_type, "gr_complex");
+            item_size_ = item_type_size(interleaved_type);
+        }
     DLOG(INFO) << "Starting FifoReader";
 }
 
@@ -59,20 +68,9 @@ int FifoReader::work(int noutput_items,
 
     // read samples out
     size_t items_retrieved = 0;
-    if (sample_type_ == "ishort")
-        {
-            // ishort == int16_t
-            items_retrieved = read_interleaved<int16_t>(noutput_items, output_items);
-        }
-    else if (sample_type_ == "ibyte")  // Does this also work with cbyte?
-        {
-            // ibyte == int8_t
-            items_retrieved = read_interleaved<int8_t>(noutput_items, output_items);
-        }
-    else if (sample_type_ == "gr_complex")
+    if (sample_type_ == "ishort" || sample_type_ == "ibyte" || sample_type_ == "gr_complex")
         {
-            // gr_complex == complex<float>
-            items_retrieved = read_gr_complex(noutput_items, output_items);
+            items_retrieved = read_items(noutput_items, static_cast<gr_complex *>(output_items[0]));
         }
     else
         {
@@ -86,30 +84,39 @@ int FifoReader::work(int noutput_items,
 }
 
 
-// read gr_complex items from fifo
-// this fct has duplicate code with the templated read_interleaved fct in header
-size_t FifoReader::read_gr_complex(int noutput_items, gr_vector_void_star &output_items)
+size_t FifoReader::read_items(int noutput_items, gr_complex *out)
 {
-    size_t items_retrieved = 0;
-    for (int n = 0; n < noutput_items; n++)
+    const size_t nbytes = static_cast<size_t>(noutput_items) * item_size_;
+    char *staging = reinterpret_cast<char *>(out);
+    if (converter_)
         {
-            gr_complex sample;
-            fifo_.read(reinterpret_cast<char *>(&sample), sizeof(sample));
-            if (fifo_.good())
-                {
-                    static_cast<gr_complex *>(output_items.at(0))[n] = sample;
-                    items_retrieved++;
-                }
-            else if (fifo_.eof())
-                {
-                    fifo_.clear();
-                    break;
-                }
-            else
+            if (buffer_.size() < nbytes)
                 {
-                    fifo_error_output();
-                    break;
+                    buffer_.resize(nbytes);
                 }
+            staging = buffer_.data();
+        }
+
+    // a single read of the whole chunk, instead of one read per item
+    std::memcpy(staging, partial_.data(), partial_bytes_);
+    fifo_.read(staging + partial_bytes_, static_cast<std::streamsize>(nbytes - partial_bytes_));
+    const size_t bytes_read = partial_bytes_ + static_cast<size_t>(fifo_.gcount());
+    if (fifo_.eof())
+        {
+            fifo_.clear();
+        }
+    else if (!fifo_.good())
+        {
+            fifo_error_output();
+        }
+
+    const size_t items_retrieved = bytes_read / item_size_;
+    partial_bytes_ = bytes_read - items_retrieved * item_size_;
+    std::memcpy(partial_.data(), staging + items_retrieved * item_size_, partial_bytes_);
+
+    if (converter_ && items_retrieved > 0)
+        {
+            converter_(out, staging, static_cast<uint32_t>(items_retrieved));
         }
     return items_retrieved;
 }
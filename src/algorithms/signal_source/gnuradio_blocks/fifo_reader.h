@@ -19,7 +19,11 @@
 #define GNSS_SDR_FIFO_READER_H_
 
 #include "gnss_block_interface.h"
+#include "item_type_helpers.h"
 #include <gnuradio/sync_block.h>
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <array>
+#include <cstddef>
 #include <fstream>  // std::ifstream
 #include <string>
 
@@ -50,42 +54,10 @@ private:
     //! (gr handles this with public and private header pair)
     FifoReader(const std::string &file_name, const std::string &sample_type);
 
-    size_t read_gr_complex(int noutput_items, gr_vector_void_star &output_items);
-
-    //! function to read data out of FIFO which is stored as interleaved I/Q stream.
-    //! template argument determines sample_type
-    // Note: template definition necessary in header file
-    // See also: https://stackoverflow.com/questions/495021/why-can-templates-only-be-implemented-in-the-header-file
-    template <typename Type>
-    size_t read_interleaved(int noutput_items, gr_vector_void_star &output_items)
-    {
-        size_t items_retrieved = 0;
-        for (int n = 0; n < noutput_items; n++)
-            {
-                // TODO: try if performance increases if we copy larger chunks to vector.
-                // how to read from stream: https://en.cppreference.com/w/cpp/io/basic_ifstream
-                std::array<char, 2 * sizeof(Type)> buffer;
-                fifo_.read(reinterpret_cast<char *>(buffer.data()), buffer.size());
-                if (fifo_.good())
-                    {
-                        auto real = reinterpret_cast<Type const *>(&buffer[0]);
-                        auto imag = reinterpret_cast<Type const *>(&buffer[sizeof(Type)]);
-                        static_cast<gr_complex *>(output_items[0])[n] = gr_complex(*real, *imag);
-                        items_retrieved++;
-                    }
-                else if (fifo_.eof())
-                    {
-                        fifo_.clear();
-                        break;
-                    }
-                else
-                    {
-                        fifo_error_output();
-                        break;
-                    }
-            }
-        return items_retrieved;
-    }
+    //! reads as many items as fit in the output buffer with a single block
+    //! read, and converts them to gr_complex if the sample type is not
+    //! gr_complex. Bytes of an incomplete item are kept for the next call.
+    size_t read_items(int noutput_items, gr_complex *out);
 
     //! this function moves logging output from this header into the source file
     //! thereby eliminating the need to include glog/logging.h in this header
@@ -94,6 +66,12 @@ private:
     const std::string file_name_;
     const std::string sample_type_;
     std::ifstream fifo_;
+
+    item_type_converter_t converter_;                 // empty for gr_complex samples, which are read in place
+    volk_gnsssdr::vector<char> buffer_;               // staging buffer of the converted sample types
+    std::array<char, sizeof(gr_complex)> partial_{};  // bytes of an incomplete item
+    size_t item_size_;
+    size_t partial_bytes_{0};
 };
 
 /** \} */
@@ -19,9 +19,15 @@
 
 #include "gr_complex_ip_packet_source.h"
 #include <gnuradio/io_signature.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <algorithm>
 #include <array>
+#include <cerrno>
 #include <cstdint>
 #include <utility>
+#include <vector>
 #if HAS_GENERIC_LAMBDA
 #else
 #include <boost/bind/bind.hpp>
@@ -75,7 +81,8 @@ Gr_Complex_Ip_Packet_Source::make(std::string src_device,
     int n_baseband_channels,
     const std::string &wire_sample_type,
     size_t item_size,
-    bool IQ_swap_)
+    bool IQ_swap_,
+    bool socket_capture)
 {
     return gnuradio::get_initial_sptr(new Gr_Complex_Ip_Packet_Source(std::move(src_device),
         origin_address,
@@ -84,7 +91,8 @@ Gr_Complex_Ip_Packet_Source::make(std::string src_device,
         n_baseband_channels,
         wire_sample_type,
         item_size,
-        IQ_swap_));
+        IQ_swap_,
+        socket_capture));
 }
 
 
@@ -94,11 +102,12 @@ Gr_Complex_Ip_Packet_Source::make(std::string src_device,
 Gr_Complex_Ip_Packet_Source::Gr_Complex_Ip_Packet_Source(std::string src_device,
     __attribute__((unused)) const std::string &origin_address,
     int udp_port,
-    int udp_packet_size __attribute__((unused)),
+    int udp_packet_size,
     int n_baseband_channels,
     const std::string &wire_sample_type,
     size_t item_size,
-    bool IQ_swap_)
+    bool IQ_swap_,
+    bool socket_capture)
     : gr::sync_block("gr_complex_ip_packet_source",
           gr::io_signature::make(0, 0, 0),
           gr::io_signature::make(1, 4, item_size)),  // 1 to 4 baseband complex channels
@@ -112,8 +121,17 @@ Gr_Complex_Ip_Packet_Source::Gr_Complex_Ip_Packet_Source(std::string src_device,
       d_sock_raw(0),
       d_udp_port(udp_port),
       d_n_baseband_channels(n_baseband_channels),
-      d_IQ_swap(IQ_swap_)
+      d_payload_bytes(std::max(udp_packet_size, 1)),
+      d_IQ_swap(IQ_swap_),
+      d_socket_capture(socket_capture)
 {
+#if !defined(__linux__)
+    if (d_socket_capture)
+        {
+            std::cout << "The UDP socket capture is only available on Linux, using the raw packet capture\n";
+            d_socket_capture = false;
+        }
+#endif
     memset(reinterpret_cast<char *>(&si_me), 0, sizeof(si_me));
     if (wire_sample_type == "cbyte")
         {
@@ -140,7 +158,7 @@ Gr_Complex_Ip_Packet_Source::Gr_Complex_Ip_Packet_Source(std::string src_device,
             std::cout << "Unknown wire sample type\n";
             exit(0);
         }
-    std::cout << "Start Ethernet packet capture\n";
+    std::cout << (d_socket_capture ? "Start UDP socket capture\n" : "Start Ethernet packet capture\n");
     std::cout << "Overflow events will be indicated by o's\n";
     std::cout << "d_wire_sample_type:" << d_wire_sample_type << '\n';
 }
@@ -153,6 +171,18 @@ bool Gr_Complex_Ip_Packet_Source::start()
     // open the ethernet device
     if (open() == true)
         {
+            d_stop_capture = false;
+            if (d_socket_capture)
+                {
+                    // start socket capture thread
+                    d_pcap_thread = new boost::thread(
+#if HAS_GENERIC_LAMBDA
+                        [this] { socket_loop_thread(); });
+#else
+                        boost::bind(&Gr_Complex_Ip_Packet_Source::socket_loop_thread, this));
+#endif
+                    return true;
+                }
             // start pcap capture thread
             d_pcap_thread = new boost::thread(
 #if HAS_GENERIC_LAMBDA
@@ -170,12 +200,26 @@ bool Gr_Complex_Ip_Packet_Source::start()
 bool Gr_Complex_Ip_Packet_Source::stop()
 {
     std::cout << "gr_complex_ip_packet_source STOP\n";
-    if (descr != nullptr)
+    if (d_socket_capture)
+        {
+            d_stop_capture = true;
+            if (d_pcap_thread != nullptr)
+                {
+                    d_pcap_thread->join();
+                }
+        }
+    else if (descr != nullptr)
         {
             pcap_breakloop(descr);
             d_pcap_thread->join();
             pcap_close(descr);
         }
+    if (d_overflow_packets > 0 || d_kernel_drops > 0 || d_truncated_packets > 0)
+        {
+            std::cout << "UDP source: " << d_overflow_packets << " packets discarded (FIFO overflow), "
+                      << d_kernel_drops << " packets dropped by the kernel, "
+                      << d_truncated_packets << " packets truncated\n";
+        }
     return true;
 }
 
@@ -184,13 +228,16 @@ bool Gr_Complex_Ip_Packet_Source::open()
 {
     std::array<char, PCAP_ERRBUF_SIZE> errbuf{};
     boost::mutex::scoped_lock lock(d_mutex);  // hold mutex for duration of this function
-    // open device for reading
-    descr = pcap_open_live(d_src_device.c_str(), 1500, 1, 1000, errbuf.data());
-    if (descr == nullptr)
+    if (!d_socket_capture)
         {
-            std::cout << "Error opening Ethernet device " << d_src_device << '\n';
-            std::cout << "Fatal Error in pcap_open_live(): " << std::string(errbuf.data()) << '\n';
-            return false;
+            // open device for reading
+            descr = pcap_open_live(d_src_device.c_str(), 1500, 1, 1000, errbuf.data());
+            if (descr == nullptr)
+                {
+                    std::cout << "Error opening Ethernet device " << d_src_device << '\n';
+                    std::cout << "Fatal Error in pcap_open_live(): " << std::string(errbuf.data()) << '\n';
+                    return false;
+                }
         }
     // bind UDP port to avoid automatic reply with ICMP port unreachable packets from kernel
     d_sock_raw = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
@@ -213,6 +260,23 @@ bool Gr_Complex_Ip_Packet_Source::open()
             std::cout << "Error opening UDP socket\n";
             return false;
         }
+
+#if defined(__linux__)
+    if (d_socket_capture)
+        {
+            // large kernel buffer, timeout to check for stop requests, and
+            // the count of packets dropped by the kernel in each datagram
+            const int rcvbuf_bytes = 32 * 1024 * 1024;
+            setsockopt(d_sock_raw, SOL_SOCKET, SO_RCVBUF, &rcvbuf_bytes, sizeof(rcvbuf_bytes));
+            struct timeval timeout
+            {
+            };
+            timeout.tv_usec = 100000;
+            setsockopt(d_sock_raw, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+            const int enable = 1;
+            setsockopt(d_sock_raw, SOL_SOCKET, SO_RXQ_OVFL, &enable, sizeof(enable));
+        }
+#endif
     return true;
 }
 
@@ -306,6 +370,7 @@ void Gr_Complex_Ip_Packet_Source::pcap_callback(__attribute__((unused)) u_char *
                     else
                         {
                             // notify overflow
+                            d_overflow_packets++;
                             std::cout << "o" << std::flush;
                         }
                 }
@@ -319,6 +384,94 @@ void Gr_Complex_Ip_Packet_Source::my_pcap_loop_thread(pcap_t *pcap_handle)
 }
 
 
+void Gr_Complex_Ip_Packet_Source::socket_loop_thread()
+{
+#if defined(__linux__)
+    constexpr int batch_size = 64;
+    std::array<struct mmsghdr, batch_size> msgs{};
+    std::array<std::array<struct iovec, 2>, batch_size> iovecs{};
+    std::array<std::array<char, CMSG_SPACE(sizeof(uint32_t))>, batch_size> controls{};
+    std::vector<char> discard_buff(d_payload_bytes);
+    while (!d_stop_capture)
+        {
+            // the free space of the FIFO is only written by this thread
+            int write_ptr;
+            int free_bytes;
+            {
+                boost::mutex::scoped_lock lock(d_mutex);
+                write_ptr = fifo_write_ptr;
+                free_bytes = FIFO_SIZE - fifo_items;
+            }
+            const int n_msgs = std::min(batch_size, free_bytes / d_payload_bytes);
+            if (n_msgs == 0)
+                {
+                    // FIFO full, discard a packet
+                    if (recv(d_sock_raw, discard_buff.data(), discard_buff.size(), 0) > 0)
+                        {
+                            d_overflow_packets++;
+                        }
+                    continue;
+                }
+
+            // the payloads are received directly into consecutive FIFO slots
+            for (int i = 0; i < n_msgs; i++)
+                {
+                    const int slot = (write_ptr + i * d_payload_bytes) % FIFO_SIZE;
+                    const int first_part = std::min(d_payload_bytes, FIFO_SIZE - slot);
+                    iovecs[i][0].iov_base = &fifo_buff[slot];
+                    iovecs[i][0].iov_len = first_part;
+                    iovecs[i][1].iov_base = &fifo_buff[0];
+                    iovecs[i][1].iov_len = d_payload_bytes - first_part;
+                    msgs[i].msg_hdr.msg_iov = iovecs[i].data();
+                    msgs[i].msg_hdr.msg_iovlen = first_part < d_payload_bytes ? 2 : 1;
+                    msgs[i].msg_hdr.msg_control = controls[i].data();
+                    msgs[i].msg_hdr.msg_controllen = controls[i].size();
+                    msgs[i].msg_hdr.msg_flags = 0;
+                }
+            const int received = recvmmsg(d_sock_raw, msgs.data(), n_msgs, MSG_WAITFORONE, nullptr);
+            if (received <= 0)
+                {
+                    continue;  // timeout
+                }
+
+            int bytes = 0;
+            for (int i = 0; i < received; i++)
+                {
+                    const int length = std::min(static_cast<int>(msgs[i].msg_len), d_payload_bytes);
+                    if (msgs[i].msg_hdr.msg_flags & MSG_TRUNC)
+                        {
+                            d_truncated_packets++;
+                        }
+                    if (bytes != i * d_payload_bytes)
+                        {
+                            // a shorter packet before this one left a gap in the FIFO
+                            const int from = (write_ptr + i * d_payload_bytes) % FIFO_SIZE;
+                            const int to = (write_ptr + bytes) % FIFO_SIZE;
+                            for (int b = 0; b < length; b++)
+                                {
+                                    fifo_buff[(to + b) % FIFO_SIZE] = fifo_buff[(from + b) % FIFO_SIZE];
+                                }
+                        }
+                    bytes += length;
+                    for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msgs[i].msg_hdr); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msgs[i].msg_hdr, cmsg))
+                        {
+                            if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SO_RXQ_OVFL)
+                                {
+                                    uint32_t drops;
+                                    memcpy(&drops, CMSG_DATA(cmsg), sizeof(drops));
+                                    d_kernel_drops = drops;  // cumulative count
+                                }
+                        }
+                }
+
+            boost::mutex::scoped_lock lock(d_mutex);
+            fifo_write_ptr = (write_ptr + bytes) % FIFO_SIZE;
+            fifo_items += bytes;
+        }
+#endif
+}
+
+
 void Gr_Complex_Ip_Packet_Source::demux_samples(const gr_vector_void_star &output_items, int num_samples_readed)
 {
     for (int n = 0; n < num_samples_readed; n++)
@@ -24,6 +24,8 @@
 #include <boost/thread.hpp>
 #include <gnuradio/sync_block.h>
 #include <arpa/inet.h>
+#include <atomic>
+#include <cstdint>
 #include <net/ethernet.h>
 #include <net/if.h>
 #include <netinet/if_ether.h>
@@ -49,7 +51,8 @@ public:
         int n_baseband_channels,
         const std::string &wire_sample_type,
         size_t item_size,
-        bool IQ_swap_);
+        bool IQ_swap_,
+        bool socket_capture = false);
     Gr_Complex_Ip_Packet_Source(std::string src_device,
         const std::string &origin_address,
         int udp_port,
@@ -57,7 +60,8 @@ public:
         int n_baseband_channels,
         const std::string &wire_sample_type,
         size_t item_size,
-        bool IQ_swap_);
+        bool IQ_swap_,
+        bool socket_capture = false);
     ~Gr_Complex_Ip_Packet_Source();
 
     // Called by gnuradio to enable drivers, etc for i/o devices.
@@ -76,6 +80,12 @@ private:
     void my_pcap_loop_thread(pcap_t *pcap_handle);
     void pcap_callback(u_char *args, const struct pcap_pkthdr *pkthdr, const u_char *packet);
     static void static_pcap_callback(u_char *args, const struct pcap_pkthdr *pkthdr, const u_char *packet);
+
+    /*
+     * Receives the UDP payloads in batches directly into the FIFO, from the
+     * bound UDP socket instead of a raw capture (Linux only)
+     */
+    void socket_loop_thread();
     /*
      * Opens the ethernet device using libpcap raw capture mode
      * If any of these fail, the function returns the error and exits.
@@ -99,7 +109,13 @@ private:
     int d_n_baseband_channels;
     int d_wire_sample_type;
     int d_bytes_per_sample;
+    int d_payload_bytes;
+    std::atomic<uint64_t> d_overflow_packets{0};   // discarded because the FIFO was full
+    std::atomic<uint64_t> d_kernel_drops{0};       // dropped by the kernel, socket capture only
+    std::atomic<uint64_t> d_truncated_packets{0};  // longer than payload_bytes, socket capture only
+    std::atomic<bool> d_stop_capture{false};
     bool d_IQ_swap;
+    bool d_socket_capture;
 };
 
 
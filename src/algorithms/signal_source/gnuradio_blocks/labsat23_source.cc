@@ -19,12 +19,11 @@
 
 #include "labsat23_source.h"
 #include "INIReader.h"
-#include "command_event.h"
+#include "control_event.h"
 #include "gnss_sdr_make_unique.h"
 #include <gnuradio/io_signature.h>
 #include <algorithm>
 #include <array>
-#include <bitset>
 #include <exception>
 #include <iomanip>
 #include <iostream>
@@ -325,6 +324,7 @@ int labsat23_source::parse_header()
 
                     // end of header
                     d_header_parsed = true;
+                    init_lookup_table();
                     // seek file to the first signal sample
                     binary_input_file.clear();
                     binary_input_file.seekg(header_bytes, binary_input_file.beg);
@@ -357,77 +357,49 @@ int labsat23_source::parse_header()
 }
 
 
-void labsat23_source::decode_samples_one_channel(int16_t input_short, gr_complex *out, int type)
+void labsat23_source::init_lookup_table()
 {
-    std::bitset<16> bs(input_short);
-    switch (type)
+    // Each int16 of the file holds 8 samples of 1 bit I + 1 bit Q, or 4
+    // samples of 2 bits I + 2 bits Q, from the most significant bit. The
+    // samples of each value of a byte are computed once.
+    d_samples_per_byte = 8 / d_bits_per_sample;
+    d_lookup_table.assign(256 * d_samples_per_byte, gr_complex(0.0, 0.0));
+    for (int byte = 0; byte < 256; byte++)
         {
-        case 2:
-            // two bits per sample, 8 samples per int16
-            for (int i = 0; i < 8; i++)
-                {
-                    out[i] = gr_complex(static_cast<float>(bs[15 - (2 * i)]),
-                        static_cast<float>(bs[14 - (2 * i)]));
-                    out[i] = out[i] * gr_complex(2, 0) - gr_complex(1, 1);
-                }
-            break;
-        case 4:
-            //  bits per sample, 4 samples per int16
-            for (int i = 0; i < 4; i++)
+            for (int i = 0; i < d_samples_per_byte; i++)
                 {
-                    // out[i] = gr_complex(0.0, 0.0);
-                    // In-Phase
-                    if (bs[15 - 4 * i])
+                    gr_complex &sample = d_lookup_table[byte * d_samples_per_byte + i];
+                    if (d_bits_per_sample == 2)
                         {
-                            if (bs[13 - 4 * i])  // 11
-                                {
-                                    out[i] = gr_complex(-1, 0);
-                                }
-                            else  // 10
-                                {
-                                    out[i] = gr_complex(-2, 0);
-                                }
+                            const int bit_i = (byte >> (7 - 2 * i)) & 0x01;
+                            const int bit_q = (byte >> (6 - 2 * i)) & 0x01;
+                            sample = gr_complex(static_cast<float>(2 * bit_i - 1), static_cast<float>(2 * bit_q - 1));
                         }
                     else
                         {
-                            if (bs[13 - 4 * i])  // 01
-                                {
-                                    out[i] = gr_complex(2, 0);
-                                }
-                            else
-                                {
-                                    out[i] = gr_complex(1, 0);
-                                }
+                            // sign and magnitude bits: 00 -> 1, 01 -> 2, 10 -> -2, 11 -> -1
+                            const std::array<float, 4> levels{{1.0, 2.0, -2.0, -1.0}};
+                            const int sign_i = (byte >> (7 - 4 * i)) & 0x01;
+                            const int sign_q = (byte >> (6 - 4 * i)) & 0x01;
+                            const int magnitude_i = (byte >> (5 - 4 * i)) & 0x01;
+                            const int magnitude_q = (byte >> (4 - 4 * i)) & 0x01;
+                            sample = gr_complex(levels[2 * sign_i + magnitude_i], levels[2 * sign_q + magnitude_q]);
                         }
-
-                    // Quadrature
-                    if (bs[14 - 4 * i])
-                        {
-                            if (bs[12 - 4 * i])  // 11
-                                {
-                                    out[i] += gr_complex(0, -1);
-                                }
-                            else  // 10
-                                {
-                                    out[i] += gr_complex(0, -2);
-                                }
-                        }
-                    else
-                        {
-                            if (bs[12 - 4 * i])  // 01
-                                {
-                                    out[i] += gr_complex(0, 2);
-                                }
-                            else
-                                {
-                                    out[i] += gr_complex(0, 1);
-                                }
-                        }
-                    // out[i] += gr_complex(0.5, 0.5);
                 }
-            break;
-        default:
-            break;
+        }
+}
+
+
+void labsat23_source::decode_samples_one_channel(const uint8_t *input, std::size_t n_words, gr_complex *out) const
+{
+    // the int16 words are little endian, the samples of the high byte go first
+    const std::size_t samples_per_byte = d_samples_per_byte;
+    for (std::size_t w = 0; w < n_words; w++)
+        {
+            const gr_complex *high = &d_lookup_table[input[2 * w + 1] * samples_per_byte];
+            const gr_complex *low = &d_lookup_table[input[2 * w] * samples_per_byte];
+            out = std::copy(high, high + samples_per_byte, out);
+            out = std::copy(low, low + samples_per_byte, out);
         }
 }
 
@@ -641,15 +613,47 @@ int labsat23_source::read_ls3w_ini(const std::string &filename)
     std::cout << '\n';
 
     d_ls3w_samples_per_register = this->number_of_samples_per_ls3w_register();
-    d_ls3w_spare_bits = 64 - d_ls3w_samples_per_register * d_ls3w_QUA * 2;
+    // the samples of all the RF channels share the register
+    d_ls3w_spare_bits = 64 - d_ls3w_samples_per_register * d_ls3w_CHN * d_ls3w_QUA * 2;
     for (auto ch_select : d_channel_selector_config)
         {
             d_ls3w_selected_channel_offset.push_back((ch_select - 1) * d_ls3w_QUA * 2);
         }
+    init_ls3w_lookup_table();
     return 0;
 }
 
 
+void labsat23_source::init_ls3w_lookup_table()
+{
+    // Levels of the QUA bits of I or Q, from the most significant bit
+    const std::array<float, 2> levels_1_bit{{1.0, -1.0}};
+    const std::array<float, 4> levels_2_bits{{0.5, 1.0, -1.0, -0.5}};
+    const std::array<float, 8> levels_3_bits{{0.25, 0.5, 0.75, 1.0, -1.0, -0.75, -0.5, -0.25}};
+    const float *levels = nullptr;
+    switch (d_ls3w_QUA)
+        {
+        case 1:
+            levels = levels_1_bit.data();
+            break;
+        case 2:
+            levels = levels_2_bits.data();
+            break;
+        case 3:
+            levels = levels_3_bits.data();
+            break;
+        default:
+            return;
+        }
+    const int values = 1 << d_ls3w_QUA;
+    for (int value = 0; value < values * values; value++)
+        {
+            // the bits of I go before those of Q
+            d_ls3w_lookup_table[value] = gr_complex(levels[value / values], levels[value % values]);
+        }
+}
+
+
 int labsat23_source::number_of_samples_per_ls3w_register() const
 {
     int number_samples = 0;
@@ -733,192 +737,52 @@ int labsat23_source::number_of_samples_per_ls3w_register() const
 }
 
 
-void labsat23_source::decode_ls3w_register(uint64_t input, std::vector<gr_complex *> &out, size_t output_pointer) const
+void labsat23_source::decode_ls3w_register(uint64_t input, std::vector<gr_complex *> &out, std::size_t output_pointer) const
 {
-    std::bitset<64> bs(input);
-
-    // Reverse, since register are written to file as 64-bit little endian words
-    for (std::size_t i = 0; i < 32; ++i)
-        {
-            bool t = bs[i];
-            bs[i] = bs[64 - i - 1];
-            bs[64 - i - 1] = t;
-        }
-
+    // The bits of the register are numbered from the most significant one,
+    // since registers are written to file as 64-bit little endian words
+    const int sample_bits = 2 * d_ls3w_QUA;
+    const uint64_t mask = (1ULL << sample_bits) - 1;
     int output_chan = 0;
     for (auto channel_offset : d_ls3w_selected_channel_offset)
         {
+            gr_complex *aux = out[output_chan] + output_pointer;
             for (int i = 0; i < d_ls3w_samples_per_register; i++)
                 {
-                    float sampleI = 0.0;
-                    float sampleQ = 0.0;
-
                     const int bit_offset = d_ls3w_spare_bits + i * d_ls3w_SFT + channel_offset;
-                    switch (d_ls3w_QUA)
-                        {
-                        case 1:
-                            sampleI = bs[bit_offset] ? -1.0 : 1.0;
-                            sampleQ = bs[bit_offset + 1] ? -1.0 : 1.0;
-                            break;
-                        case 2:
-                            if (bs[bit_offset])
-                                {
-                                    if (bs[bit_offset + 1])  // 11
-                                        {
-                                            sampleI = -0.5;
-                                        }
-                                    else  // 10
-                                        {
-                                            sampleI = -1.0;
-                                        }
-                                }
-                            else
-                                {
-                                    if (bs[bit_offset + 1])  // 01
-                                        {
-                                            sampleI = 1.0;
-                                        }
-                                    else  // 00
-                                        {
-                                            sampleI = 0.5;
-                                        }
-                                }
-                            if (bs[bit_offset + 2])
-                                {
-                                    if (bs[bit_offset + 3])  // 11
-                                        {
-                                            sampleQ = -0.5;
-                                        }
-                                    else  // 10
-                                        {
-                                            sampleQ = -1.0;
-                                        }
-                                }
-                            else
-                                {
-                                    if (bs[bit_offset + 3])  // 01
-                                        {
-                                            sampleQ = 1.0;
-                                        }
-                                    else  // 00
-                                        {
-                                            sampleQ = 0.5;
-                                        }
-                                }
-                            break;
+                    aux[i] = d_ls3w_lookup_table[(input >> (64 - bit_offset - sample_bits)) & mask];
+                }
+            output_chan++;
+        }
+}
 
-                        case 3:
-                            if (bs[bit_offset])
-                                {
-                                    if (bs[bit_offset + 1])
-                                        {
-                                            if (bs[bit_offset + 2])  // 111
-                                                {
-                                                    sampleI = -0.25;
-                                                }
-                                            else  // 110
-                                                {
-                                                    sampleI = -0.5;
-                                                }
-                                        }
-                                    else
-                                        {
-                                            if (bs[bit_offset + 2])  // 101
-                                                {
-                                                    sampleI = -0.75;
-                                                }
-                                            else  // 100
-                                                {
-                                                    sampleI = -1.0;
-                                                }
-                                        }
-                                }
-                            else
-                                {
-                                    if (bs[bit_offset + 1])
-                                        {
-                                            if (bs[bit_offset + 2])  // 011
-                                                {
-                                                    sampleI = 1;
-                                                }
-                                            else  // 010
-                                                {
-                                                    sampleI = 0.75;
-                                                }
-                                        }
-                                    else
-                                        {
-                                            if (bs[bit_offset + 2])  // 001
-                                                {
-                                                    sampleI = 0.5;
-                                                }
-                                            else  // 000
-                                                {
-                                                    sampleI = 0.25;
-                                                }
-                                        }
-                                }
-                            if (bs[bit_offset + 3])
-                                {
-                                    if (bs[bit_offset + 4])
-                                        {
-                                            if (bs[bit_offset + 5])  // 111
-                                                {
-                                                    sampleQ = -0.25;
-                                                }
-                                            else  // 110
-                                                {
-                                                    sampleQ = -0.5;
-                                                }
-                                        }
-                                    else
-                                        {
-                                            if (bs[bit_offset + 5])  // 101
-                                                {
-                                                    sampleQ = -0.75;
-                                                }
-                                            else  // 100
-                                                {
-                                                    sampleQ = -1.0;
-                                                }
-                                        }
-                                }
-                            else
-                                {
-                                    if (bs[bit_offset + 4])
-                                        {
-                                            if (bs[bit_offset + 5])  // 011
-                                                {
-                                                    sampleQ = 1;
-                                                }
-                                            else  // 010
-                                                {
-                                                    sampleQ = 0.75;
-                                                }
-                                        }
-                                    else
-                                        {
-                                            if (bs[bit_offset + 5])  // 001
-                                                {
-                                                    sampleQ = 0.5;
-                                                }
-                                            else  // 000
-                                                {
-                                                    sampleQ = 0.25;
-                                                }
-                                        }
-                                }
 
-                            break;
+int labsat23_source::open_next_file()
+{
+    // trigger the read of the next file in the sequence
+    d_current_file_number++;
+    if (d_labsat_version == 3)
+        {
+            std::cout << "End of current file, reading the next LabSat file in sequence: " << generate_filename() << '\n';
+        }
+    binary_input_file.close();
+    binary_input_file.open(generate_filename().c_str(), std::ios::in | std::ios::binary);
+    if (binary_input_file.is_open())
+        {
+            std::cout << "LabSat file source is reading samples from " << generate_filename() << '\n';
+            return 0;
+        }
 
-                        default:
-                            break;
-                        }
-                    gr_complex *aux = out[output_chan];
-                    aux[output_pointer + i] = gr_complex(sampleI, sampleQ);
-                }
-            output_chan++;
+    if (d_labsat_version == 3)
+        {
+            std::cout << "Last file reached, LabSat source stop\n";
         }
+    else
+        {
+            std::cout << "End of file reached, LabSat source stop\n";
+        }
+    d_queue->push(control_event_pmt(Control_Event::command, 200, 0));
+    return -1;
 }
 
 
@@ -939,172 +803,70 @@ int labsat23_source::general_work(int noutput_items,
                     return parse_header();
                 }
 
-            // ready to start reading samples
-            switch (d_bits_per_sample)
+            if (d_bits_per_sample != 2 and d_bits_per_sample != 4)
                 {
-                case 2:
-                    switch (d_channel_selector)
-                        {
-                        case 0:
-                            // dual channel 2 bits per complex sample
-                            // todo: implement dual channel reader
-                            break;
-                        default:
-                            // single channel 2 bits per complex sample (1 bit I + 1 bit Q, 8 samples per int16)
-                            int n_int16_to_read = noutput_items / 8;
-                            if (n_int16_to_read > 0)
-                                {
-                                    std::vector<int16_t> memblock(n_int16_to_read);
-                                    binary_input_file.read(reinterpret_cast<char *>(memblock.data()), n_int16_to_read * 2);
-                                    n_int16_to_read = static_cast<int>(binary_input_file.gcount()) / 2;  // from bytes to int16
-                                    if (n_int16_to_read > 0)
-                                        {
-                                            int output_pointer = 0;
-                                            for (int i = 0; i < n_int16_to_read; i++)
-                                                {
-                                                    decode_samples_one_channel(memblock[i], out[0] + output_pointer, d_bits_per_sample);
-                                                    output_pointer += 8;
-                                                }
-                                            return output_pointer;
-                                        }
-
-                                    // trigger the read of the next file in the sequence
-                                    d_current_file_number++;
-                                    if (d_labsat_version == 3)
-                                        {
-                                            std::cout << "End of current file, reading the next LabSat file in sequence: " << generate_filename() << '\n';
-                                        }
-                                    binary_input_file.close();
-                                    binary_input_file.open(generate_filename().c_str(), std::ios::in | std::ios::binary);
-                                    if (binary_input_file.is_open())
-                                        {
-                                            std::cout << "LabSat file source is reading samples from " << generate_filename() << '\n';
-                                            return 0;
-                                        }
-
-                                    if (d_labsat_version == 3)
-                                        {
-                                            std::cout << "Last file reached, LabSat source stop\n";
-                                        }
-                                    else
-                                        {
-                                            std::cout << "End of file reached, LabSat source stop\n";
-                                        }
-
-                                    d_queue->push(pmt::make_any(command_event_make(200, 0)));
-                                    return -1;
-                                }
-                            else
-                                {
-                                    return 0;
-                                }
-                        }
-                    break;
-                case 4:
-                    switch (d_channel_selector)
-                        {
-                        case 0:
-                            // dual channel
-                            // todo: implement dual channel reader
-                            break;
-                        default:
-                            // single channel 4 bits per complex sample (2 bit I + 2 bit Q, 4 samples per int16)
-                            int n_int16_to_read = noutput_items / 4;
-                            if (n_int16_to_read > 0)
-                                {
-                                    std::vector<int16_t> memblock(n_int16_to_read);
-                                    binary_input_file.read(reinterpret_cast<char *>(memblock.data()), n_int16_to_read * 2);
-                                    n_int16_to_read = static_cast<int>(binary_input_file.gcount()) / 2;  // from bytes to int16
-                                    if (n_int16_to_read > 0)
-                                        {
-                                            int output_pointer = 0;
-                                            for (int i = 0; i < n_int16_to_read; i++)
-                                                {
-                                                    decode_samples_one_channel(memblock[i], out[0] + output_pointer, d_bits_per_sample);
-                                                    output_pointer += 4;
-                                                }
-                                            return output_pointer;
-                                        }
-
-                                    // trigger the read of the next file in the sequence
-                                    d_current_file_number++;
-                                    if (d_labsat_version == 3)
-                                        {
-                                            std::cout << "End of current file, reading the next Labsat file in sequence: " << generate_filename() << '\n';
-                                        }
-                                    binary_input_file.close();
-                                    binary_input_file.open(generate_filename().c_str(), std::ios::in | std::ios::binary);
-                                    if (binary_input_file.is_open())
-                                        {
-                                            std::cout << "Labsat file source is reading samples from " << generate_filename() << '\n';
-                                            return 0;
-                                        }
-
-                                    if (d_labsat_version == 3)
-                                        {
-                                            std::cout << "Last file reached, LabSat source stop\n";
-                                        }
-                                    else
-                                        {
-                                            std::cout << "End of file reached, LabSat source stop\n";
-                                        }
-                                    d_queue->push(pmt::make_any(command_event_make(200, 0)));
-                                    return -1;
-                                }
-                            else
-                                {
-                                    return 0;
-                                }
-                        }
-                    break;
-                default:
                     return -1;
                 }
+            if (d_channel_selector == 0)
+                {
+                    // dual channel
+                    // todo: implement dual channel reader
+                    std::cout << "Warning!!\n";
+                    return 0;
+                }
+
+            // single channel, 2 bits per complex sample (1 bit I + 1 bit Q,
+            // 8 samples per int16) or 4 bits per complex sample (2 bit I +
+            // 2 bit Q, 4 samples per int16), read in a single call
+            const int samples_per_int16 = 2 * d_samples_per_byte;
+            std::size_t n_int16_to_read = noutput_items / samples_per_int16;
+            if (n_int16_to_read == 0)
+                {
+                    return 0;
+                }
+            d_read_buffer.resize(std::max(d_read_buffer.size(), 2 * n_int16_to_read));
+            binary_input_file.read(reinterpret_cast<char *>(d_read_buffer.data()), static_cast<std::streamsize>(2 * n_int16_to_read));
+            n_int16_to_read = static_cast<std::size_t>(binary_input_file.gcount()) / 2;  // from bytes to int16
+            if (n_int16_to_read > 0)
+                {
+                    decode_samples_one_channel(d_read_buffer.data(), n_int16_to_read, out[0]);
+                    return static_cast<int>(n_int16_to_read) * samples_per_int16;
+                }
+            return open_next_file();
         }
-    else  // Labsat 3 Wideband
+
+    // Labsat 3 Wideband
+    if (binary_input_file.eof() == false)
         {
-            if (binary_input_file.eof() == false)
+            // Integer division, any fractional part of the answer is discarded
+            const int registers_to_read = noutput_items / d_ls3w_samples_per_register;
+            if (registers_to_read < 1)
                 {
-                    // Integer division, any fractional part of the answer is discarded
-                    int registers_to_read = noutput_items / d_ls3w_samples_per_register;
-                    if (registers_to_read < 1)
-                        {
-                            return 0;
-                        }
-                    std::size_t output_pointer = 0;
-                    for (int i = 0; i < registers_to_read; i++)
+                    return 0;
+                }
+            d_read_buffer.resize(std::max<std::size_t>(d_read_buffer.size(), 8 * registers_to_read));
+            binary_input_file.read(reinterpret_cast<char *>(d_read_buffer.data()), static_cast<std::streamsize>(8) * registers_to_read);
+            const auto registers_read = static_cast<std::size_t>(binary_input_file.gcount()) / 8;
+            std::size_t output_pointer = 0;
+            const uint8_t *memory_block = d_read_buffer.data();
+            for (std::size_t i = 0; i < registers_read; i++)
+                {
+                    uint64_t read_register = 0ULL;
+                    for (int k = 7; k >= 0; --k)
                         {
-                            std::array<char, 8> memory_block{};
-                            binary_input_file.read(memory_block.data(), 8);
-                            uint64_t read_register = 0ULL;
-                            for (int k = 7; k >= 0; --k)
-                                {
-                                    read_register <<= 8;
-                                    read_register |= uint64_t(memory_block[k]);
-                                }
-
-                            if (binary_input_file.gcount() == 8)
-                                {
-                                    decode_ls3w_register(read_register, out, output_pointer);
-                                    output_pointer += d_ls3w_samples_per_register;
-                                }
-                            else
-                                {
-                                    std::cout << "End of file reached, LabSat source stop.\n";
-                                    d_queue->push(pmt::make_any(command_event_make(200, 0)));
-                                    return -1;
-                                }
+                            read_register <<= 8;
+                            read_register |= static_cast<uint64_t>(memory_block[k]);
                         }
-                    return output_pointer;
+                    memory_block += 8;
+                    decode_ls3w_register(read_register, out, output_pointer);
+                    output_pointer += d_ls3w_samples_per_register;
                 }
-            else
+            if (output_pointer > 0)
                 {
-                    std::cout << "End of file reached, LabSat source stop.\n";
-                    d_queue->push(pmt::make_any(command_event_make(200, 0)));
-                    return -1;
+                    return static_cast<int>(output_pointer);
                 }
         }
-
-    std::cout << "Warning!!\n";
-    return 0;
+    std::cout << "End of file reached, LabSat source stop.\n";
+    d_queue->push(control_event_pmt(Control_Event::command, 200, 0));
+    return -1;
 }
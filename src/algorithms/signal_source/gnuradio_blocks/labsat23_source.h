@@ -23,6 +23,7 @@
 #include "gnss_block_interface.h"
 #include <gnuradio/block.h>
 #include <pmt/pmt.h>
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <fstream>
@@ -78,10 +79,16 @@ private:
     int read_ls3w_ini(const std::string &filename);
     int number_of_samples_per_ls3w_register() const;
 
-    void decode_samples_one_channel(int16_t input_short, gr_complex *out, int type);
+    void init_lookup_table();
+    void init_ls3w_lookup_table();
+    void decode_samples_one_channel(const uint8_t *input, std::size_t n_words, gr_complex *out) const;
     void decode_ls3w_register(uint64_t input, std::vector<gr_complex *> &out, std::size_t output_pointer) const;
+    int open_next_file();
 
     std::ifstream binary_input_file;
+    std::vector<uint8_t> d_read_buffer;  // file contents, kept from one call to the next
+    std::vector<gr_complex> d_lookup_table;  // samples of each byte value, for LabSat 2 and 3
+    std::array<gr_complex, 64> d_ls3w_lookup_table{};  // sample of each value of the I and Q bits, for LabSat 3 Wideband
     std::string d_signal_file_basename;
     Concurrent_Queue<pmt::pmt_t> *d_queue;
     std::vector<int> d_channel_selector_config;
@@ -107,6 +114,7 @@ private:
     int32_t d_ls3w_BWC{};
     int d_ls3w_spare_bits{};
     int d_ls3w_samples_per_register{};
+    int d_samples_per_byte{};
     bool d_is_ls3w = false;
     bool d_ls3w_digital_io_enabled = false;
 };
@@ -0,0 +1,187 @@
+/*!
+ * \file mmap_file_source.cc
+ * \brief Reads samples from a memory-mapped file
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "mmap_file_source.h"
+#include "control_event.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+#include <fcntl.h>     // for open
+#include <sys/mman.h>  // for mmap, madvise
+#include <sys/stat.h>  // for fstat
+#include <unistd.h>    // for close, sysconf
+#include <algorithm>   // for std::min
+#include <cerrno>      // for errno
+#include <cstring>     // for memcpy, strerror
+#include <stdexcept>
+
+namespace
+{
+// Size of the window of pages prefetched ahead of the read position
+constexpr size_t PREFETCH_BYTES = 64 * 1024 * 1024;
+}  // namespace
+
+
+mmap_file_source_sptr make_mmap_file_source(size_t item_size,
+    const std::string &filename,
+    bool repeat,
+    uint64_t offset_items)
+{
+    return mmap_file_source_sptr(new mmap_file_source(item_size, filename, repeat, offset_items));
+}
+
+
+mmap_file_source::mmap_file_source(size_t item_size,
+    const std::string &filename,
+    bool repeat,
+    uint64_t offset_items) : gr::sync_block("mmap_file_source",
+                                 gr::io_signature::make(0, 0, 0),
+                                 gr::io_signature::make(1, 1, item_size)),
+                             d_map(nullptr),
+                             d_queue(nullptr),
+                             d_nitems(0),
+                             d_produced(0),
+                             d_map_size(0),
+                             d_item_size(item_size),
+                             d_position(0),
+                             d_prefetched(0),
+                             d_released(0),
+                             d_page_size(static_cast<size_t>(sysconf(_SC_PAGESIZE))),
+                             d_fd(-1),
+                             d_repeat(repeat)
+{
+    d_fd = open(filename.c_str(), O_RDONLY);
+    if (d_fd < 0)
+        {
+            throw std::runtime_error("mmap_file_source: cannot open " + filename + ": " + std::strerror(errno));
+        }
+    struct stat file_status
+    {
+    };
+    if (fstat(d_fd, &file_status) != 0)
+        {
+            close(d_fd);
+            throw std::runtime_error("mmap_file_source: cannot read the size of " + filename);
+        }
+    d_map_size = (static_cast<size_t>(file_status.st_size) / d_item_size) * d_item_size;
+    if (d_map_size == 0)
+        {
+            close(d_fd);
+            throw std::runtime_error("mmap_file_source: " + filename + " does not contain any item");
+        }
+    void *map = mmap(nullptr, d_map_size, PROT_READ, MAP_SHARED, d_fd, 0);
+    if (map == MAP_FAILED)
+        {
+            close(d_fd);
+            throw std::runtime_error("mmap_file_source: cannot map " + filename + ": " + std::strerror(errno));
+        }
+    d_map = static_cast<const uint8_t *>(map);
+    madvise(map, d_map_size, MADV_SEQUENTIAL);
+
+    d_position = std::min(static_cast<size_t>(offset_items) * d_item_size, d_map_size);
+    d_released = (d_position / d_page_size) * d_page_size;
+    d_prefetched = d_released;
+    advise(d_position);
+    DLOG(INFO) << "Mapped " << d_map_size << " bytes of " << filename << ", starting at byte " << d_position;
+}
+
+
+mmap_file_source::~mmap_file_source()
+{
+    if (d_map != nullptr)
+        {
+            munmap(const_cast<uint8_t *>(d_map), d_map_size);
+        }
+    if (d_fd >= 0)
+        {
+            close(d_fd);
+        }
+}
+
+
+void mmap_file_source::set_item_limit(uint64_t nitems, Concurrent_Queue<pmt::pmt_t> *queue)
+{
+    d_nitems = nitems;
+    d_queue = queue;
+}
+
+
+void mmap_file_source::advise(size_t position)
+{
+    // prefetch the next window when half of it was read
+    if (d_prefetched < d_map_size && position + PREFETCH_BYTES / 2 >= d_prefetched)
+        {
+            const size_t length = std::min(PREFETCH_BYTES, d_map_size - d_prefetched);
+            madvise(const_cast<uint8_t *>(d_map) + d_prefetched, length, MADV_WILLNEED);
+            d_prefetched += length;
+        }
+
+    // release the pages already read
+    const size_t read_pages_end = (position / d_page_size) * d_page_size;
+    if (read_pages_end >= d_released + PREFETCH_BYTES)
+        {
+            madvise(const_cast<uint8_t *>(d_map) + d_released, read_pages_end - d_released, MADV_DONTNEED);
+            d_released = read_pages_end;
+        }
+}
+
+
+int mmap_file_source::work(int noutput_items,
+    gr_vector_const_void_star &input_items __attribute__((unused)),
+    gr_vector_void_star &output_items)
+{
+    if (d_nitems > 0)
+        {
+            if (d_produced >= d_nitems)
+                {
+                    LOG(INFO) << "Stopping receiver, " << d_produced << " samples processed";
+                    if (d_queue != nullptr)
+                        {
+                            d_queue->push(control_event_pmt(Control_Event::command, 200, 0));
+                        }
+                    return WORK_DONE;
+                }
+            noutput_items = static_cast<int>(std::min(d_nitems - d_produced, static_cast<uint64_t>(noutput_items)));
+        }
+
+    auto *out = static_cast<uint8_t *>(output_items[0]);
+    const size_t requested_bytes = static_cast<size_t>(noutput_items) * d_item_size;
+    size_t copied_bytes = 0;
+    while (copied_bytes < requested_bytes)
+        {
+            if (d_position == d_map_size)
+                {
+                    if (!d_repeat)
+                        {
+                            break;
+                        }
+                    // rewind to the beginning of the file
+                    d_position = 0;
+                    d_released = 0;
+                    d_prefetched = 0;
+                }
+            const size_t n = std::min(requested_bytes - copied_bytes, d_map_size - d_position);
+            std::memcpy(out + copied_bytes, d_map + d_position, n);
+            copied_bytes += n;
+            d_position += n;
+            advise(d_position);
+        }
+
+    if (copied_bytes == 0)
+        {
+            return WORK_DONE;  // end of file
+        }
+    d_produced += copied_bytes / d_item_size;
+    return static_cast<int>(copied_bytes / d_item_size);
+}
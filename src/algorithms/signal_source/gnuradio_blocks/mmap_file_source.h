@@ -0,0 +1,104 @@
+/*!
+ * \file mmap_file_source.h
+ * \brief Reads samples from a memory-mapped file
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_MMAP_FILE_SOURCE_H
+#define GNSS_SDR_MMAP_FILE_SOURCE_H
+
+#include "concurrent_queue.h"
+#include "gnss_block_interface.h"
+#include <gnuradio/sync_block.h>
+#include <pmt/pmt.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_gnuradio_blocks
+ * \{ */
+
+
+class mmap_file_source;
+
+using mmap_file_source_sptr = gnss_shared_ptr<mmap_file_source>;
+
+/*!
+ * \brief Creates a source reading items of item_size bytes from filename,
+ * starting at item number offset_items. Throws std::runtime_error if the file
+ * cannot be mapped.
+ */
+mmap_file_source_sptr make_mmap_file_source(size_t item_size,
+    const std::string &filename,
+    bool repeat,
+    uint64_t offset_items = 0);
+
+/*!
+ * \brief This class reads a file through a read-only memory mapping, instead
+ * of the buffered reads of gr::blocks::file_source.
+ *
+ * The kernel is advised of the sequential access, the pages ahead of the read
+ * position are prefetched, and the pages already read are released, so that
+ * the memory used does not grow with the size of the file.
+ *
+ * The source can also stop the receiver after a given number of items, as
+ * Gnss_Sdr_Valve does, so that no valve copying the samples is needed after
+ * it.
+ */
+class mmap_file_source : public gr::sync_block
+{
+public:
+    ~mmap_file_source();
+
+    /*!
+     * \brief Sends a STOP message to queue, and ends the stream, after nitems
+     * items were produced. 0 means no limit.
+     */
+    void set_item_limit(uint64_t nitems, Concurrent_Queue<pmt::pmt_t> *queue);
+
+    int work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+private:
+    friend mmap_file_source_sptr make_mmap_file_source(size_t item_size,
+        const std::string &filename,
+        bool repeat,
+        uint64_t offset_items);
+
+    mmap_file_source(size_t item_size,
+        const std::string &filename,
+        bool repeat,
+        uint64_t offset_items);
+
+    void advise(size_t position);
+
+    const uint8_t *d_map;
+    Concurrent_Queue<pmt::pmt_t> *d_queue;
+    uint64_t d_nitems;    // 0 for no limit
+    uint64_t d_produced;  // items produced
+    size_t d_map_size;    // bytes mapped, a whole number of items
+    size_t d_item_size;
+    size_t d_position;    // read position, in bytes
+    size_t d_prefetched;  // end of the prefetched pages, in bytes
+    size_t d_released;    // end of the released pages, in bytes
+    size_t d_page_size;
+    int d_fd;
+    bool d_repeat;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_MMAP_FILE_SOURCE_H
@@ -21,6 +21,7 @@
 #include <boost/bind/bind.hpp>
 #include <boost/thread/thread.hpp>
 #include <glog/logging.h>
+#include <algorithm>
 #include <map>
 
 
@@ -31,10 +32,14 @@ using boost::asio::ip::tcp;
 // TODO: Make these configurable
 enum
 {
-    RTL_TCP_BUFFER_SIZE = 1024 * 16,  // 16 KB
-    RTL_TCP_PAYLOAD_SIZE = 1024 * 4   //  4 KB
+    RTL_TCP_BUFFER_SIZE = 1024 * 256,  // 256 KB, an even number of bytes
+    RTL_TCP_PAYLOAD_SIZE = 1024 * 16   //  16 KB
 };
 
+// The dongle samples are unsigned bytes centered at 127.4
+constexpr float RTL_TCP_SAMPLE_SCALE = 1.0F / 128.0F;
+constexpr float RTL_TCP_SAMPLE_OFFSET = -127.4F / 128.0F;
+
 rtl_tcp_signal_source_c_sptr rtl_tcp_make_signal_source_c(
     const std::string &address,
     int16_t port,
@@ -52,21 +57,13 @@ rtl_tcp_signal_source_c::rtl_tcp_signal_source_c(const std::string &address,
     : gr::sync_block("rtl_tcp_signal_source_c",
           gr::io_signature::make(0, 0, 0),
           gr::io_signature::make(1, 1, sizeof(gr_complex))),
-      buffer_(RTL_TCP_BUFFER_SIZE),
+      ring_(RTL_TCP_BUFFER_SIZE),
       socket_(io_context_),
-      data_(RTL_TCP_PAYLOAD_SIZE),
-      unread_(0),
       flip_iq_(flip_iq)
 {
     boost::system::error_code ec;
 
-    // 1. Setup lookup table
-    for (unsigned i = 0; i < 0xff; i++)
-        {
-            lookup_[i] = (static_cast<float>(i & 0xff) - 127.4F) * (1.0F / 128.0F);
-        }
-
-    // 2. Set socket options
+    // 1. Set socket options
     ip::address addr = ip::address::from_string(address, ec);
     if (ec)
         {
@@ -95,7 +92,7 @@ rtl_tcp_signal_source_c::rtl_tcp_signal_source_c(const std::string &address,
             LOG(WARNING) << "Failed to set linger option";
         }
 
-    // 3. Connect socket
+    // 2. Connect socket
 
     socket_.connect(ep, ec);
     if (ec)
@@ -109,7 +106,7 @@ rtl_tcp_signal_source_c::rtl_tcp_signal_source_c(const std::string &address,
     std::cout << "Connected to " << addr << ":" << port << '\n';
     LOG(INFO) << "Connected to " << addr << ":" << port;
 
-    // 4. Set nodelay
+    // 3. Set nodelay
     socket_.set_option(tcp::no_delay(true), ec);
     if (ec)
         {
@@ -117,7 +114,7 @@ rtl_tcp_signal_source_c::rtl_tcp_signal_source_c(const std::string &address,
             LOG(WARNING) << "Failed to set no delay option";
         }
 
-    // 5. Receive dongle info
+    // 4. Receive dongle info
     ec = info_.read(socket_);
     if (ec)
         {
@@ -130,14 +127,8 @@ rtl_tcp_signal_source_c::rtl_tcp_signal_source_c(const std::string &address,
             LOG(INFO) << "Found " << info_.get_type_name() << " tuner.";
         }
 
-// 6. Start reading
-#if USE_BOOST_BIND_PLACEHOLDERS
-    boost::asio::async_read(socket_, boost::asio::buffer(data_),
-        boost::bind(&rtl_tcp_signal_source_c::handle_read, this, boost::placeholders::_1, boost::placeholders::_2));  // NOLINT(modernize-avoid-bind)
-#else
-    boost::asio::async_read(socket_, boost::asio::buffer(data_),
-        boost::bind(&rtl_tcp_signal_source_c::handle_read, this, _1, _2));  // NOLINT(modernize-avoid-bind)
-#endif
+    // 5. Start reading
+    start_read();
 
     boost::thread(
 #if HAS_GENERIC_LAMBDA
@@ -150,8 +141,8 @@ rtl_tcp_signal_source_c::rtl_tcp_signal_source_c(const std::string &address,
 
 rtl_tcp_signal_source_c::~rtl_tcp_signal_source_c()  // NOLINT(modernize-use-equals-default)
 {
-    mutex_.unlock();
     io_context_.stop();
+    boost::mutex::scoped_lock lock(mutex_);
     not_empty_.notify_one();
     not_full_.notify_one();
 }
@@ -279,6 +270,37 @@ void rtl_tcp_signal_source_c::set_if_gain(int gain)
 }
 
 
+void rtl_tcp_signal_source_c::start_read()
+{
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+    uint64_t used = head - tail_.load(std::memory_order_acquire);
+    if (used == ring_.size())
+        {
+            // uh-oh, buffer overflow
+            // wait until there's space for more
+            boost::mutex::scoped_lock lock(mutex_);
+            not_full_.wait(lock,
+                boost::bind(&rtl_tcp_signal_source_c::not_full, this));  // NOLINT(modernize-avoid-bind)
+            if (io_context_.stopped())
+                {
+                    return;
+                }
+            used = head - tail_.load(std::memory_order_acquire);
+        }
+
+    // the contiguous free space after the head, up to one payload
+    const size_t offset = head % ring_.size();
+    const size_t length = std::min<size_t>({ring_.size() - used, ring_.size() - offset, RTL_TCP_PAYLOAD_SIZE});
+#if USE_BOOST_BIND_PLACEHOLDERS
+    socket_.async_read_some(boost::asio::buffer(&ring_[offset], length),
+        boost::bind(&rtl_tcp_signal_source_c::handle_read, this, boost::placeholders::_1, boost::placeholders::_2));  // NOLINT(modernize-avoid-bind)
+#else
+    socket_.async_read_some(boost::asio::buffer(&ring_[offset], length),
+        boost::bind(&rtl_tcp_signal_source_c::handle_read, this, _1, _2));  // NOLINT(modernize-avoid-bind)
+#endif
+}
+
+
 void rtl_tcp_signal_source_c::handle_read(const boost::system::error_code &ec,
     size_t bytes_transferred)
 {
@@ -286,45 +308,20 @@ void rtl_tcp_signal_source_c::handle_read(const boost::system::error_code &ec,
         {
             std::cout << "Error during read: " << ec << '\n';
             LOG(WARNING) << "Error during read: " << ec;
-            boost::mutex::scoped_lock lock(mutex_);
             io_context_.stop();
+            boost::mutex::scoped_lock lock(mutex_);
             not_empty_.notify_one();
         }
     else
         {
+            head_.store(head_.load(std::memory_order_relaxed) + bytes_transferred, std::memory_order_release);
             {
-                // Unpack read data
+                // let worker know that more data is available
                 boost::mutex::scoped_lock lock(mutex_);
-                not_full_.wait(lock,
-                    boost::bind(&rtl_tcp_signal_source_c::not_full, this));  // NOLINT(modernize-avoid-bind)
-
-                for (size_t i = 0; i < bytes_transferred; i++)
-                    {
-                        while (!not_full())
-                            {
-                                // uh-oh, buffer overflow
-                                // wait until there's space for more
-                                not_empty_.notify_one();  // needed?
-                                not_full_.wait(lock,
-                                    boost::bind(&rtl_tcp_signal_source_c::not_full, this));  // NOLINT(modernize-avoid-bind)
-                            }
-
-                        buffer_.push_front(lookup_[data_[i]]);
-                        unread_++;
-                    }
+                not_empty_.notify_one();
             }
-            // let woker know that more data is available
-            not_empty_.notify_one();
-// Read some more
-#if USE_BOOST_BIND_PLACEHOLDERS
-            boost::asio::async_read(socket_,
-                boost::asio::buffer(data_),
-                boost::bind(&rtl_tcp_signal_source_c::handle_read, this, boost::placeholders::_1, boost::placeholders::_2));  // NOLINT(modernize-avoid-bind)
-#else
-            boost::asio::async_read(socket_,
-                boost::asio::buffer(data_),
-                boost::bind(&rtl_tcp_signal_source_c::handle_read, this, _1, _2));  // NOLINT(modernize-avoid-bind)
-#endif
+            // Read some more
+            start_read();
         }
 }
 
@@ -333,32 +330,43 @@ int rtl_tcp_signal_source_c::work(int noutput_items,
     gr_vector_const_void_star & /*input_items*/,
     gr_vector_void_star &output_items)
 {
-    auto *out = reinterpret_cast<gr_complex *>(output_items[0]);
-    int i = 0;
+    auto *out = reinterpret_cast<float *>(output_items[0]);
     if (io_context_.stopped())
         {
             return -1;
         }
 
+    if (!not_empty())
+        {
+            boost::mutex::scoped_lock lock(mutex_);
+            not_empty_.wait(lock,
+                boost::bind(&rtl_tcp_signal_source_c::not_empty, this));  // NOLINT(modernize-avoid-bind)
+        }
+
+    // The tail is always even, and so is the ring size, so that no sample is
+    // split by the end of the ring
+    const uint64_t tail = tail_.load(std::memory_order_relaxed);
+    const uint64_t available = (head_.load(std::memory_order_acquire) - tail) / 2;
+    const size_t items = std::min<uint64_t>(available, static_cast<uint64_t>(noutput_items));
+    const size_t re = flip_iq_ ? 1 : 0;
+    const size_t im = 1 - re;
+    size_t i = 0;
+    while (i < items)
+        {
+            const unsigned char *in = &ring_[(tail + 2 * i) % ring_.size()];
+            const size_t chunk = std::min(items - i, (ring_.size() - (tail + 2 * i) % ring_.size()) / 2);
+            float *dst = out + 2 * i;
+            for (size_t n = 0; n < chunk; n++)
+                {
+                    dst[2 * n] = static_cast<float>(in[2 * n + re]) * RTL_TCP_SAMPLE_SCALE + RTL_TCP_SAMPLE_OFFSET;
+                    dst[2 * n + 1] = static_cast<float>(in[2 * n + im]) * RTL_TCP_SAMPLE_SCALE + RTL_TCP_SAMPLE_OFFSET;
+                }
+            i += chunk;
+        }
+    tail_.store(tail + 2 * items, std::memory_order_release);
     {
         boost::mutex::scoped_lock lock(mutex_);
-        not_empty_.wait(lock,
-            boost::bind(&rtl_tcp_signal_source_c::not_empty, this));  // NOLINT(modernize-avoid-bind)
-
-        for (; i < noutput_items && unread_ > 1; i++)
-            {
-                float re = buffer_[--unread_];
-                float im = buffer_[--unread_];
-                if (flip_iq_)
-                    {
-                        out[i] = gr_complex(im, re);
-                    }
-                else
-                    {
-                        out[i] = gr_complex(re, im);
-                    }
-            }
+        not_full_.notify_one();
     }
-    not_full_.notify_one();
-    return i == 0 ? -1 : i;
+    return items == 0 ? -1 : static_cast<int>(items);
 }
@@ -26,12 +26,11 @@
 
 #include "gnss_block_interface.h"
 #include "rtl_tcp_dongle_info.h"
-#include <boost/array.hpp>
 #include <boost/asio.hpp>
-#include <boost/circular_buffer.hpp>
 #include <boost/thread/condition.hpp>
 #include <boost/thread/mutex.hpp>
 #include <gnuradio/sync_block.h>
+#include <atomic>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -91,32 +90,34 @@ private:
     void handle_read(const boost::system::error_code &ec,
         size_t bytes_transferred);
 
+    // reads from the socket into the free space of the ring
+    void start_read();
+
     inline bool not_full() const
     {
-        return unread_ < buffer_.capacity();
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire) < ring_.size() || io_context_.stopped();
     }
 
     inline bool not_empty() const
     {
-        return unread_ > 0 || io_context_.stopped();
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire) > 1 || io_context_.stopped();
     }
 
-    boost::circular_buffer_space_optimized<float> buffer_;
-    // producer-consumer helpers
+    // single-producer, single-consumer ring of the received bytes. The socket
+    // reads straight into it and work() converts straight out of it; the
+    // mutex and conditions are only taken to sleep when it is full or empty.
+    std::vector<unsigned char> ring_;
+    std::atomic<uint64_t> head_{0};  // written by the reader thread
+    std::atomic<uint64_t> tail_{0};  // written by work()
     boost::mutex mutex_;
     boost::condition not_full_;
     boost::condition not_empty_;
 
-    // lookup for scaling data
-    boost::array<float, 0xff> lookup_{};
-
     // IO members
     b_io_context io_context_;
     boost::asio::ip::tcp::socket socket_;
-    std::vector<unsigned char> data_;
 
     Rtl_Tcp_Dongle_Info info_;
-    size_t unread_;
     bool flip_iq_;
 };
 
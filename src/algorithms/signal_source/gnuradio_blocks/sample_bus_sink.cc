@@ -0,0 +1,62 @@
+/*!
+ * \file sample_bus_sink.cc
+ * \brief Writes samples, stamped with their sample number, to a shared memory
+ * sample bus
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "sample_bus_sink.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+
+
+sample_bus_sink_sptr make_sample_bus_sink(size_t item_size,
+    const std::string &name,
+    uint64_t capacity,
+    bool huge_pages)
+{
+    return sample_bus_sink_sptr(new sample_bus_sink(item_size, name, capacity, huge_pages));
+}
+
+
+sample_bus_sink::sample_bus_sink(size_t item_size,
+    const std::string &name,
+    uint64_t capacity,
+    bool huge_pages) : gr::sync_block("sample_bus_sink",
+                           gr::io_signature::make(1, 1, item_size),
+                           gr::io_signature::make(0, 0, 0)),
+                       d_writer(name, item_size, capacity, huge_pages)
+{
+    LOG(INFO) << "Writing the samples to the sample bus " << name << ", " << capacity << " items"
+              << (d_writer.huge_pages() ? " in huge pages" : "");
+    if (huge_pages and !d_writer.huge_pages())
+        {
+            LOG(WARNING) << "The sample bus " << name << " is not backed by huge pages. Check /sys/kernel/mm/transparent_hugepage/shmem_enabled";
+        }
+}
+
+
+bool sample_bus_sink::stop()
+{
+    d_writer.close();
+    LOG(INFO) << "Sample bus: " << d_writer.written() << " items written";
+    return true;
+}
+
+
+int sample_bus_sink::work(int noutput_items,
+    gr_vector_const_void_star &input_items,
+    gr_vector_void_star &output_items __attribute__((unused)))
+{
+    d_writer.write(input_items[0], noutput_items, nitems_read(0));
+    return noutput_items;
+}
@@ -0,0 +1,81 @@
+/*!
+ * \file sample_bus_sink.h
+ * \brief Writes samples, stamped with their sample number, to a shared memory
+ * sample bus
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_SAMPLE_BUS_SINK_H
+#define GNSS_SDR_SAMPLE_BUS_SINK_H
+
+#include "gnss_block_interface.h"
+#include "gnss_sample_bus.h"
+#include <gnuradio/sync_block.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_gnuradio_blocks
+ * \{ */
+
+
+class sample_bus_sink;
+
+using sample_bus_sink_sptr = gnss_shared_ptr<sample_bus_sink>;
+
+/*!
+ * \brief Creates a sink writing its items to the sample bus name, a ring of
+ * capacity items. Throws std::runtime_error if the shared memory object
+ * cannot be created.
+ */
+sample_bus_sink_sptr make_sample_bus_sink(size_t item_size,
+    const std::string &name,
+    uint64_t capacity,
+    bool huge_pages = true);
+
+/*!
+ * \brief This class shares the samples of a receiver with the receivers of
+ * the same host running sample_bus_source, so that several receiver
+ * instances consume a single front-end with one copy of the samples.
+ *
+ * The items are stamped with their number in the stream of this receiver, so
+ * that the consumers keep their sample counters aligned with its one.
+ */
+class sample_bus_sink : public gr::sync_block
+{
+public:
+    bool stop();
+
+    int work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+private:
+    friend sample_bus_sink_sptr make_sample_bus_sink(size_t item_size,
+        const std::string &name,
+        uint64_t capacity,
+        bool huge_pages);
+
+    sample_bus_sink(size_t item_size,
+        const std::string &name,
+        uint64_t capacity,
+        bool huge_pages);
+
+    Gnss_Sample_Bus_Writer d_writer;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_SAMPLE_BUS_SINK_H
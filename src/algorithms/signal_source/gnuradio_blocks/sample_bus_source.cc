@@ -0,0 +1,64 @@
+/*!
+ * \file sample_bus_source.cc
+ * \brief Reads the samples of a shared memory sample bus
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "sample_bus_source.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+
+namespace
+{
+// so that the scheduler can stop the block while the bus is idle
+constexpr int BUS_TIMEOUT_MS = 100;
+}  // namespace
+
+
+sample_bus_source_sptr make_sample_bus_source(size_t item_size,
+    const std::string &name,
+    uint64_t max_gap_samples)
+{
+    return sample_bus_source_sptr(new sample_bus_source(item_size, name, max_gap_samples));
+}
+
+
+sample_bus_source::sample_bus_source(size_t item_size,
+    const std::string &name,
+    uint64_t max_gap_samples) : gr::sync_block("sample_bus_source",
+                                    gr::io_signature::make(0, 0, 0),
+                                    gr::io_signature::make(1, 1, item_size)),
+                                d_reader(name, item_size, max_gap_samples)
+{
+    LOG(INFO) << "Reading the samples of the sample bus " << name << " from sample " << d_reader.next_sample();
+}
+
+
+bool sample_bus_source::stop()
+{
+    LOG(INFO) << "Sample bus: " << d_reader.lost_samples() << " samples lost in "
+              << d_reader.overruns() << " overruns, " << d_reader.resyncs() << " resyncs";
+    return true;
+}
+
+
+int sample_bus_source::work(int noutput_items,
+    gr_vector_const_void_star &input_items __attribute__((unused)),
+    gr_vector_void_star &output_items)
+{
+    const size_t nitems = d_reader.read(output_items[0], noutput_items, BUS_TIMEOUT_MS);
+    if (nitems == 0 and d_reader.finished())
+        {
+            return WORK_DONE;
+        }
+    return static_cast<int>(nitems);
+}
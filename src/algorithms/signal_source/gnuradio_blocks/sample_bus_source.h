@@ -0,0 +1,79 @@
+/*!
+ * \file sample_bus_source.h
+ * \brief Reads the samples of a shared memory sample bus
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_SAMPLE_BUS_SOURCE_H
+#define GNSS_SDR_SAMPLE_BUS_SOURCE_H
+
+#include "gnss_block_interface.h"
+#include "gnss_sample_bus.h"
+#include <gnuradio/sync_block.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_gnuradio_blocks
+ * \{ */
+
+
+class sample_bus_source;
+
+using sample_bus_source_sptr = gnss_shared_ptr<sample_bus_source>;
+
+/*!
+ * \brief Creates a source reading the items of the sample bus name. Throws
+ * std::runtime_error if there is no such bus, or its items are not of
+ * item_size bytes.
+ */
+sample_bus_source_sptr make_sample_bus_source(size_t item_size,
+    const std::string &name,
+    uint64_t max_gap_samples);
+
+/*!
+ * \brief This class produces the samples written by a sample_bus_sink of
+ * another receiver of the same host, from the newest one when the flowgraph
+ * starts. The samples overwritten before they are read are replaced by
+ * zeros, up to max_gap_samples at once (see Gnss_Sample_Bus_Reader). It
+ * finishes when the receiver that writes the bus stops.
+ */
+class sample_bus_source : public gr::sync_block
+{
+public:
+    uint64_t get_lost_samples() const { return d_reader.lost_samples(); }
+    uint64_t get_overruns() const { return d_reader.overruns(); }
+
+    bool stop();
+
+    int work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+private:
+    friend sample_bus_source_sptr make_sample_bus_source(size_t item_size,
+        const std::string &name,
+        uint64_t max_gap_samples);
+
+    sample_bus_source(size_t item_size,
+        const std::string &name,
+        uint64_t max_gap_samples);
+
+    Gnss_Sample_Bus_Reader d_reader;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_SAMPLE_BUS_SOURCE_H
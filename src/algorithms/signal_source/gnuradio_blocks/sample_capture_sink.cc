@@ -0,0 +1,86 @@
+/*!
+ * \file sample_capture_sink.cc
+ * \brief Keeps the last samples of a stream in memory, to be written to a
+ * capture file when an anomaly triggers a capture
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "sample_capture_sink.h"
+#include <glog/logging.h>
+#include <gnuradio/gr_complex.h>
+#include <gnuradio/io_signature.h>
+#include <volk/volk.h>
+
+
+namespace
+{
+Gnss_Capture_Header capture_header(const std::string &item_type, size_t item_size, double sampling_frequency, bool reduce_to_bytes)
+{
+    Gnss_Capture_Header header;
+    header.item_type = reduce_to_bytes ? "cbyte" : item_type;
+    header.item_size = static_cast<uint32_t>(reduce_to_bytes ? 2 * sizeof(int8_t) : item_size);
+    header.sampling_frequency = sampling_frequency;
+    return header;
+}
+}  // namespace
+
+
+sample_capture_sink_sptr make_sample_capture_sink(const std::string &name,
+    const std::string &item_type,
+    size_t item_size,
+    double sampling_frequency,
+    size_t capacity_items,
+    float byte_gain,
+    const std::string &filename_prefix)
+{
+    return sample_capture_sink_sptr(new sample_capture_sink(name, item_type, item_size, sampling_frequency, capacity_items, byte_gain, filename_prefix));
+}
+
+
+sample_capture_sink::sample_capture_sink(const std::string &name,
+    const std::string &item_type,
+    size_t item_size,
+    double sampling_frequency,
+    size_t capacity_items,
+    float byte_gain,
+    const std::string &filename_prefix) : gr::sync_block("sample_capture_sink",
+                                              gr::io_signature::make(1, 1, item_size),
+                                              gr::io_signature::make(0, 0, 0)),
+                                          d_byte_gain(item_size == sizeof(gr_complex) ? byte_gain : 0.0F)
+{
+    const Gnss_Capture_Header header = capture_header(item_type, item_size, sampling_frequency, d_byte_gain > 0.0F);
+    d_ring = std::make_shared<Gnss_Capture_Ring>(name, header, capacity_items, filename_prefix);
+    LOG(INFO) << "The last " << capacity_items << " samples of " << name << " are kept for the captures, "
+              << capacity_items * header.item_size << " bytes";
+}
+
+
+int sample_capture_sink::work(int noutput_items,
+    gr_vector_const_void_star &input_items,
+    gr_vector_void_star &output_items __attribute__((unused)))
+{
+    if (d_byte_gain > 0.0F)
+        {
+            const auto nvalues = static_cast<size_t>(2 * noutput_items);
+            if (d_bytes.size() < nvalues)
+                {
+                    d_bytes.resize(nvalues);
+                }
+            volk_32f_s32f_convert_8i(d_bytes.data(), static_cast<const float *>(input_items[0]), d_byte_gain, static_cast<unsigned int>(nvalues));
+            d_ring->push(d_bytes.data(), noutput_items);
+        }
+    else
+        {
+            d_ring->push(input_items[0], noutput_items);
+        }
+    return noutput_items;
+}
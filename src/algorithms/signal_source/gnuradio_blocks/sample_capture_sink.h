@@ -0,0 +1,95 @@
+/*!
+ * \file sample_capture_sink.h
+ * \brief Keeps the last samples of a stream in memory, to be written to a
+ * capture file when an anomaly triggers a capture
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_SAMPLE_CAPTURE_SINK_H
+#define GNSS_SDR_SAMPLE_CAPTURE_SINK_H
+
+#include "gnss_block_interface.h"
+#include "gnss_capture_ring.h"
+#include <gnuradio/sync_block.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_gnuradio_blocks
+ * \{ */
+
+
+class sample_capture_sink;
+
+using sample_capture_sink_sptr = gnss_shared_ptr<sample_capture_sink>;
+
+/*!
+ * \brief Creates a sink keeping the last capacity_items items of its input,
+ * items of item_type, sampled at sampling_frequency. If byte_gain is greater
+ * than 0 and the items are gr_complex, they are kept as cbyte, multiplied by
+ * byte_gain and saturated to 8 bits.
+ */
+sample_capture_sink_sptr make_sample_capture_sink(const std::string &name,
+    const std::string &item_type,
+    size_t item_size,
+    double sampling_frequency,
+    size_t capacity_items,
+    float byte_gain,
+    const std::string &filename_prefix);
+
+/*!
+ * \brief This class feeds a Gnss_Capture_Ring with the samples of a signal
+ * conditioner, so that the last seconds of samples can be written to disk
+ * when the receiver detects an anomaly, instead of dumping all of them.
+ */
+class sample_capture_sink : public gr::sync_block
+{
+public:
+    inline const std::shared_ptr<Gnss_Capture_Ring> &ring() const
+    {
+        return d_ring;
+    }
+
+    int work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+private:
+    friend sample_capture_sink_sptr make_sample_capture_sink(const std::string &name,
+        const std::string &item_type,
+        size_t item_size,
+        double sampling_frequency,
+        size_t capacity_items,
+        float byte_gain,
+        const std::string &filename_prefix);
+
+    sample_capture_sink(const std::string &name,
+        const std::string &item_type,
+        size_t item_size,
+        double sampling_frequency,
+        size_t capacity_items,
+        float byte_gain,
+        const std::string &filename_prefix);
+
+    std::shared_ptr<Gnss_Capture_Ring> d_ring;
+    std::vector<int8_t> d_bytes;  // items reduced to 8 bits
+    float d_byte_gain;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_SAMPLE_CAPTURE_SINK_H
@@ -0,0 +1,64 @@
+/*!
+ * \file sample_push_source.cc
+ * \brief GNU Radio source producing the sample buffers pushed by the
+ * application that embeds the receiver
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "sample_push_source.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+
+namespace
+{
+// so that the scheduler can stop the block while no buffer is pushed
+constexpr int PUSH_TIMEOUT_MS = 100;
+}  // namespace
+
+
+sample_push_source_sptr make_sample_push_source(size_t item_size, const std::string &channel_name)
+{
+    return sample_push_source_sptr(new sample_push_source(item_size, channel_name));
+}
+
+
+sample_push_source::sample_push_source(size_t item_size, const std::string &channel_name) : gr::sync_block("sample_push_source",
+                                                                                                gr::io_signature::make(0, 0, 0),
+                                                                                                gr::io_signature::make(1, 1, item_size)),
+                                                                                            d_channel(Gnss_Sample_Push_Channel::get(channel_name)),
+                                                                                            d_item_size(item_size)
+{
+    LOG(INFO) << "Reading the samples pushed to the channel " << channel_name;
+}
+
+
+bool sample_push_source::stop()
+{
+    // the application must not wait for buffers that will never be read
+    d_channel->close();
+    d_channel->flush();
+    LOG(INFO) << "Sample push source: " << d_channel->pushed_bytes() / d_item_size << " items pushed";
+    return true;
+}
+
+
+int sample_push_source::work(int noutput_items,
+    gr_vector_const_void_star &input_items __attribute__((unused)),
+    gr_vector_void_star &output_items)
+{
+    const size_t nitems = d_channel->read(output_items[0], noutput_items, d_item_size, PUSH_TIMEOUT_MS);
+    if (nitems == 0 and d_channel->finished())
+        {
+            return WORK_DONE;
+        }
+    return static_cast<int>(nitems);
+}
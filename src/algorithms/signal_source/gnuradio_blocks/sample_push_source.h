@@ -0,0 +1,68 @@
+/*!
+ * \file sample_push_source.h
+ * \brief GNU Radio source producing the sample buffers pushed by the
+ * application that embeds the receiver
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_SAMPLE_PUSH_SOURCE_H
+#define GNSS_SDR_SAMPLE_PUSH_SOURCE_H
+
+#include "gnss_block_interface.h"
+#include "gnss_sample_push_channel.h"
+#include <gnuradio/sync_block.h>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_gnuradio_blocks
+ * \{ */
+
+
+class sample_push_source;
+
+using sample_push_source_sptr = gnss_shared_ptr<sample_push_source>;
+
+/*!
+ * \brief Creates a source reading the buffers pushed to the
+ * Gnss_Sample_Push_Channel registered as channel_name
+ */
+sample_push_source_sptr make_sample_push_source(size_t item_size, const std::string &channel_name);
+
+/*!
+ * \brief This class produces the items of the buffers pushed to a
+ * Gnss_Sample_Push_Channel, read straight into its output buffer. The
+ * flowgraph finishes when the channel is closed and drained.
+ */
+class sample_push_source : public gr::sync_block
+{
+public:
+    bool stop();
+
+    int work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+private:
+    friend sample_push_source_sptr make_sample_push_source(size_t item_size, const std::string &channel_name);
+    sample_push_source(size_t item_size, const std::string &channel_name);
+
+    std::shared_ptr<Gnss_Sample_Push_Channel> d_channel;
+    size_t d_item_size;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_SAMPLE_PUSH_SOURCE_H
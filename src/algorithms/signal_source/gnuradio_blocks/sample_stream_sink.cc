@@ -0,0 +1,57 @@
+/*!
+ * \file sample_stream_sink.cc
+ * \brief Sends samples, stamped with their sample number, to a UDP address
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "sample_stream_sink.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+
+
+sample_stream_sink_sptr make_sample_stream_sink(size_t item_size,
+    const std::string &address,
+    uint16_t port,
+    size_t payload_bytes,
+    int multicast_ttl)
+{
+    return sample_stream_sink_sptr(new sample_stream_sink(item_size, address, port, payload_bytes, multicast_ttl));
+}
+
+
+sample_stream_sink::sample_stream_sink(size_t item_size,
+    const std::string &address,
+    uint16_t port,
+    size_t payload_bytes,
+    int multicast_ttl) : gr::sync_block("sample_stream_sink",
+                             gr::io_signature::make(1, 1, item_size),
+                             gr::io_signature::make(0, 0, 0)),
+                         d_sender(address, port, item_size, payload_bytes, multicast_ttl)
+{
+    LOG(INFO) << "Distributing the samples to " << address << ":" << port;
+}
+
+
+bool sample_stream_sink::stop()
+{
+    LOG(INFO) << "Sample stream: " << d_sender.datagrams() << " datagrams sent, " << d_sender.errors() << " send errors";
+    return true;
+}
+
+
+int sample_stream_sink::work(int noutput_items,
+    gr_vector_const_void_star &input_items,
+    gr_vector_void_star &output_items __attribute__((unused)))
+{
+    d_sender.send(input_items[0], noutput_items, nitems_read(0));
+    return noutput_items;
+}
@@ -0,0 +1,83 @@
+/*!
+ * \file sample_stream_sink.h
+ * \brief Sends samples, stamped with their sample number, to a UDP address
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_SAMPLE_STREAM_SINK_H
+#define GNSS_SDR_SAMPLE_STREAM_SINK_H
+
+#include "gnss_block_interface.h"
+#include "gnss_sample_stream.h"
+#include <gnuradio/sync_block.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_gnuradio_blocks
+ * \{ */
+
+
+class sample_stream_sink;
+
+using sample_stream_sink_sptr = gnss_shared_ptr<sample_stream_sink>;
+
+/*!
+ * \brief Creates a sink sending its items to address:port, which can be a
+ * multicast group. Throws std::runtime_error if the socket cannot be opened.
+ */
+sample_stream_sink_sptr make_sample_stream_sink(size_t item_size,
+    const std::string &address,
+    uint16_t port,
+    size_t payload_bytes = 1440,
+    int multicast_ttl = 1);
+
+/*!
+ * \brief This class distributes the samples of a receiver to the receivers
+ * running sample_stream_source, so that several hosts can share the
+ * channels of a single front-end.
+ *
+ * Each datagram carries the number of its first item in the stream, so that
+ * the receivers keep their sample counters aligned with the sender's one
+ * over the datagrams lost.
+ */
+class sample_stream_sink : public gr::sync_block
+{
+public:
+    bool stop();
+
+    int work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+private:
+    friend sample_stream_sink_sptr make_sample_stream_sink(size_t item_size,
+        const std::string &address,
+        uint16_t port,
+        size_t payload_bytes,
+        int multicast_ttl);
+
+    sample_stream_sink(size_t item_size,
+        const std::string &address,
+        uint16_t port,
+        size_t payload_bytes,
+        int multicast_ttl);
+
+    Gnss_Sample_Stream_Sender d_sender;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_SAMPLE_STREAM_SINK_H
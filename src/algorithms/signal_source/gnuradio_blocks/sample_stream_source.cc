@@ -0,0 +1,65 @@
+/*!
+ * \file sample_stream_source.cc
+ * \brief Receives the samples sent by a sample_stream_sink
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "sample_stream_source.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>
+
+namespace
+{
+// so that the scheduler can stop the block while no datagram arrives
+constexpr int RECEIVE_TIMEOUT_MS = 100;
+}  // namespace
+
+
+sample_stream_source_sptr make_sample_stream_source(size_t item_size,
+    const std::string &address,
+    uint16_t port,
+    uint64_t max_gap_samples,
+    int receive_buffer_bytes,
+    const std::string &interface_address)
+{
+    return sample_stream_source_sptr(new sample_stream_source(item_size, address, port, max_gap_samples, receive_buffer_bytes, interface_address));
+}
+
+
+sample_stream_source::sample_stream_source(size_t item_size,
+    const std::string &address,
+    uint16_t port,
+    uint64_t max_gap_samples,
+    int receive_buffer_bytes,
+    const std::string &interface_address) : gr::sync_block("sample_stream_source",
+                                                gr::io_signature::make(0, 0, 0),
+                                                gr::io_signature::make(1, 1, item_size)),
+                                            d_receiver(address, port, item_size, max_gap_samples, receive_buffer_bytes, interface_address)
+{
+    LOG(INFO) << "Receiving the samples distributed to " << address << ":" << port;
+}
+
+
+bool sample_stream_source::stop()
+{
+    LOG(INFO) << "Sample stream: " << d_receiver.lost_samples() << " samples lost, "
+              << d_receiver.late_datagrams() << " datagrams dropped, " << d_receiver.resyncs() << " resyncs";
+    return true;
+}
+
+
+int sample_stream_source::work(int noutput_items,
+    gr_vector_const_void_star &input_items __attribute__((unused)),
+    gr_vector_void_star &output_items)
+{
+    return static_cast<int>(d_receiver.read(output_items[0], noutput_items, RECEIVE_TIMEOUT_MS));
+}
@@ -0,0 +1,87 @@
+/*!
+ * \file sample_stream_source.h
+ * \brief Receives the samples sent by a sample_stream_sink
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_SAMPLE_STREAM_SOURCE_H
+#define GNSS_SDR_SAMPLE_STREAM_SOURCE_H
+
+#include "gnss_block_interface.h"
+#include "gnss_sample_stream.h"
+#include <gnuradio/sync_block.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_gnuradio_blocks
+ * \{ */
+
+
+class sample_stream_source;
+
+using sample_stream_source_sptr = gnss_shared_ptr<sample_stream_source>;
+
+/*!
+ * \brief Creates a source receiving the items sent to address:port, which
+ * can be a multicast group. Throws std::runtime_error if the socket cannot
+ * be opened.
+ */
+sample_stream_source_sptr make_sample_stream_source(size_t item_size,
+    const std::string &address,
+    uint16_t port,
+    uint64_t max_gap_samples,
+    int receive_buffer_bytes = 8388608,
+    const std::string &interface_address = std::string(""));
+
+/*!
+ * \brief This class produces the samples distributed by a sample_stream_sink.
+ *
+ * The samples of the datagrams lost are replaced by zeros, up to
+ * max_gap_samples at once (see Gnss_Sample_Stream_Receiver).
+ */
+class sample_stream_source : public gr::sync_block
+{
+public:
+    uint64_t get_lost_samples() const { return d_receiver.lost_samples(); }
+    uint64_t get_late_datagrams() const { return d_receiver.late_datagrams(); }
+
+    bool stop();
+
+    int work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+private:
+    friend sample_stream_source_sptr make_sample_stream_source(size_t item_size,
+        const std::string &address,
+        uint16_t port,
+        uint64_t max_gap_samples,
+        int receive_buffer_bytes,
+        const std::string &interface_address);
+
+    sample_stream_source(size_t item_size,
+        const std::string &address,
+        uint16_t port,
+        uint64_t max_gap_samples,
+        int receive_buffer_bytes,
+        const std::string &interface_address);
+
+    Gnss_Sample_Stream_Receiver d_receiver;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_SAMPLE_STREAM_SOURCE_H
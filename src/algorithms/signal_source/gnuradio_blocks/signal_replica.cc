@@ -0,0 +1,116 @@
+/*!
+ * \file signal_replica.cc
+ * \brief Delays a stream of samples and shifts its frequency, to make a
+ * virtual antenna out of a recording
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "signal_replica.h"
+#include "MATH_CONSTANTS.h"
+#include <gnuradio/io_signature.h>
+#include <volk/volk.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>  // for min
+#include <cmath>      // for remainder
+#include <cstring>    // for memcpy, memset
+#include <stdexcept>  // for invalid_argument
+
+
+namespace
+{
+// Samples shifted at a time, so the carrier buffer stays in cache
+const int SIGNAL_REPLICA_BLOCK_SAMPLES = 4096;
+}  // namespace
+
+
+signal_replica_sptr make_signal_replica(size_t item_size,
+    double sampling_frequency,
+    double doppler_hz,
+    uint64_t delay_samples)
+{
+    return signal_replica_sptr(new signal_replica(item_size, sampling_frequency, doppler_hz, delay_samples));
+}
+
+
+signal_replica::signal_replica(size_t item_size,
+    double sampling_frequency,
+    double doppler_hz,
+    uint64_t delay_samples)
+    : gr::block("signal_replica",
+          gr::io_signature::make(1, 1, item_size),
+          gr::io_signature::make(1, 1, item_size)),
+      d_item_size(item_size),
+      d_pending_zeros(delay_samples),
+      d_phase_step_rad(0.0),
+      d_phase_rad(0.0)
+{
+    if (sampling_frequency <= 0.0)
+        {
+            throw std::invalid_argument("signal_replica: the sampling frequency must be positive");
+        }
+    if (doppler_hz != 0.0)
+        {
+            if (item_size != sizeof(gr_complex))
+                {
+                    throw std::invalid_argument("signal_replica: a frequency shift needs gr_complex items");
+                }
+            d_phase_step_rad = TWO_PI * doppler_hz / sampling_frequency;
+            d_carrier.resize(SIGNAL_REPLICA_BLOCK_SAMPLES);
+        }
+    const auto alignment_multiple = static_cast<int>(volk_get_alignment() / item_size);
+    set_alignment(std::max(1, alignment_multiple));
+}
+
+
+void signal_replica::forecast(int noutput_items, gr_vector_int &ninput_items_required)
+{
+    // the delay is produced without reading the input
+    ninput_items_required[0] = d_pending_zeros > 0 ? 0 : noutput_items;
+}
+
+
+int signal_replica::general_work(int noutput_items,
+    gr_vector_int &ninput_items,
+    gr_vector_const_void_star &input_items,
+    gr_vector_void_star &output_items)
+{
+    auto *out = reinterpret_cast<uint8_t *>(output_items[0]);
+    if (d_pending_zeros > 0)
+        {
+            const int n_zeros = static_cast<int>(std::min<uint64_t>(d_pending_zeros, noutput_items));
+            std::memset(out, 0, n_zeros * d_item_size);
+            d_pending_zeros -= n_zeros;
+            return n_zeros;
+        }
+
+    const int n_items = std::min(noutput_items, ninput_items[0]);
+    if (d_carrier.empty())
+        {
+            std::memcpy(out, input_items[0], n_items * d_item_size);
+        }
+    else
+        {
+            const auto *in = reinterpret_cast<const gr_complex *>(input_items[0]);
+            auto *out_c = reinterpret_cast<gr_complex *>(out);
+            for (int first = 0; first < n_items; first += SIGNAL_REPLICA_BLOCK_SAMPLES)
+                {
+                    const int n_samples = std::min(SIGNAL_REPLICA_BLOCK_SAMPLES, n_items - first);
+                    // the kernel accumulates the phase in single precision, so it starts each block from the exact one
+                    auto phase_rad = static_cast<float>(d_phase_rad);
+                    volk_gnsssdr_s32f_sincos_32fc(d_carrier.data(), static_cast<float>(d_phase_step_rad), &phase_rad, n_samples);
+                    volk_32fc_x2_multiply_32fc(out_c + first, in + first, d_carrier.data(), n_samples);
+                    d_phase_rad = std::remainder(d_phase_rad + d_phase_step_rad * static_cast<double>(n_samples), TWO_PI);
+                }
+        }
+    consume_each(n_items);
+    return n_items;
+}
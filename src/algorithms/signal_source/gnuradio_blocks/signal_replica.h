@@ -0,0 +1,88 @@
+/*!
+ * \file signal_replica.h
+ * \brief Delays a stream of samples and shifts its frequency, to make a
+ * virtual antenna out of a recording
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_SIGNAL_REPLICA_H
+#define GNSS_SDR_SIGNAL_REPLICA_H
+
+#include "gnss_block_interface.h"
+#include <gnuradio/block.h>
+#include <gnuradio/gr_complex.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_gnuradio_blocks
+ * \{ */
+
+
+class signal_replica;
+
+using signal_replica_sptr = gnss_shared_ptr<signal_replica>;
+
+/*!
+ * \brief Creates a replica of a stream of items of item_size bytes, delayed
+ * by delay_samples items and, for gr_complex items, shifted by doppler_hz at
+ * sampling_frequency. Throws std::invalid_argument if a frequency shift is
+ * requested for items other than gr_complex.
+ */
+signal_replica_sptr make_signal_replica(size_t item_size,
+    double sampling_frequency,
+    double doppler_hz,
+    uint64_t delay_samples);
+
+/*!
+ * \brief This class outputs delay_samples zero items, and then the input
+ * stream multiplied by a carrier of doppler_hz.
+ *
+ * It lets a single recording feed several RF channels that do not see the
+ * same samples, for scaling tests. A replica without delay nor frequency
+ * shift is not needed, since the blocks of a flow graph can read the same
+ * output buffer.
+ */
+class signal_replica : public gr::block
+{
+public:
+    void forecast(int noutput_items, gr_vector_int &ninput_items_required);
+
+    int general_work(int noutput_items,
+        gr_vector_int &ninput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+private:
+    friend signal_replica_sptr make_signal_replica(size_t item_size,
+        double sampling_frequency,
+        double doppler_hz,
+        uint64_t delay_samples);
+
+    signal_replica(size_t item_size,
+        double sampling_frequency,
+        double doppler_hz,
+        uint64_t delay_samples);
+
+    std::vector<gr_complex> d_carrier;
+    size_t d_item_size;
+    uint64_t d_pending_zeros;  // items of the delay not produced yet
+    double d_phase_step_rad;
+    double d_phase_rad;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_SIGNAL_REPLICA_H
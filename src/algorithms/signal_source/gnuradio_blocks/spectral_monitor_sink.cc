@@ -0,0 +1,71 @@
+/*!
+ * \file spectral_monitor_sink.cc
+ * \brief Feeds the Gnss_Spectral_Monitor of an RF channel with its samples
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "spectral_monitor_sink.h"
+#include "gnss_spectral_monitor.h"
+#include <gnuradio/io_signature.h>
+#include <volk/volk.h>
+#include <algorithm>  // for min
+#include <cstdint>
+#include <utility>
+
+
+namespace
+{
+// cshort samples converted at a time
+const int32_t SPECTRAL_MONITOR_SINK_BLOCK_SAMPLES = 4096;
+}  // namespace
+
+
+spectral_monitor_sink_sptr make_spectral_monitor_sink(size_t item_size, std::shared_ptr<Gnss_Spectral_Monitor> monitor)
+{
+    return spectral_monitor_sink_sptr(new spectral_monitor_sink(item_size, std::move(monitor)));
+}
+
+
+spectral_monitor_sink::spectral_monitor_sink(size_t item_size,
+    std::shared_ptr<Gnss_Spectral_Monitor> monitor) : gr::sync_block("spectral_monitor_sink",
+                                                          gr::io_signature::make(1, 1, item_size),
+                                                          gr::io_signature::make(0, 0, 0)),
+                                                      d_monitor(std::move(monitor)),
+                                                      d_short_input(item_size == 2 * sizeof(int16_t))
+{
+    if (d_short_input)
+        {
+            d_converted.resize(SPECTRAL_MONITOR_SINK_BLOCK_SAMPLES);
+        }
+}
+
+
+int spectral_monitor_sink::work(int noutput_items,
+    gr_vector_const_void_star &input_items,
+    gr_vector_void_star &output_items __attribute__((unused)))
+{
+    if (!d_short_input)
+        {
+            d_monitor->push(static_cast<const gr_complex *>(input_items[0]), noutput_items);
+            return noutput_items;
+        }
+    const auto *in = static_cast<const int16_t *>(input_items[0]);
+    int32_t done = 0;
+    while (done < noutput_items)
+        {
+            const int32_t block = std::min(noutput_items - done, SPECTRAL_MONITOR_SINK_BLOCK_SAMPLES);
+            volk_16i_s32f_convert_32f(reinterpret_cast<float *>(d_converted.data()), in + 2 * done, 1.0, 2 * static_cast<unsigned int>(block));
+            d_monitor->push(d_converted.data(), block);
+            done += block;
+        }
+    return noutput_items;
+}
@@ -0,0 +1,69 @@
+/*!
+ * \file spectral_monitor_sink.h
+ * \brief Feeds the Gnss_Spectral_Monitor of an RF channel with its samples
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_SPECTRAL_MONITOR_SINK_H
+#define GNSS_SDR_SPECTRAL_MONITOR_SINK_H
+
+#include "gnss_block_interface.h"
+#include <gnuradio/gr_complex.h>
+#include <gnuradio/sync_block.h>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_gnuradio_blocks
+ * \{ */
+
+
+class Gnss_Spectral_Monitor;
+class spectral_monitor_sink;
+
+using spectral_monitor_sink_sptr = gnss_shared_ptr<spectral_monitor_sink>;
+
+/*!
+ * \brief Creates a sink pushing its input, gr_complex or cshort items of
+ * item_size bytes, to monitor.
+ */
+spectral_monitor_sink_sptr make_spectral_monitor_sink(size_t item_size, std::shared_ptr<Gnss_Spectral_Monitor> monitor);
+
+/*!
+ * \brief This class taps the samples of an RF channel for its
+ * Gnss_Spectral_Monitor. It only copies the segments that the monitor
+ * analyzes, so it does not slow down the signal conditioner it runs beside.
+ * The cshort samples are converted to gr_complex without scaling, as the
+ * data type adapters do.
+ */
+class spectral_monitor_sink : public gr::sync_block
+{
+public:
+    int work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items);
+
+private:
+    friend spectral_monitor_sink_sptr make_spectral_monitor_sink(size_t item_size, std::shared_ptr<Gnss_Spectral_Monitor> monitor);
+    spectral_monitor_sink(size_t item_size, std::shared_ptr<Gnss_Spectral_Monitor> monitor);
+
+    std::shared_ptr<Gnss_Spectral_Monitor> d_monitor;
+    std::vector<gr_complex> d_converted;  // cshort items converted to gr_complex
+    bool d_short_input;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_SPECTRAL_MONITOR_SINK_H
@@ -18,6 +18,7 @@
 
 #include "unpack_2bit_samples.h"
 #include <gnuradio/io_signature.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
 
 struct byte_2bit_struct
 {
@@ -117,6 +118,64 @@ unpack_2bit_samples::unpack_2bit_samples(bool big_endian_bytes,
     bool big_endian_bytes_system = systemBytesAreBigEndian();
 
     swap_endian_bytes_ = (big_endian_bytes_system != big_endian_bytes_);
+
+    // Order of the samples of a byte in the output
+    std::array<int, 4> order{0, 1, 2, 3};
+    if (!reverse_interleaving_)
+        {
+            if (swap_endian_bytes_)
+                {
+                    order = {{3, 2, 1, 0}};
+                }
+        }
+    else
+        {
+            if (swap_endian_bytes_)
+                {
+                    order = {{2, 3, 0, 1}};
+                }
+            else
+                {
+                    order = {{1, 0, 3, 2}};
+                }
+        }
+
+    // Position of each sample in the byte, for any bit field layout
+    std::array<int, 4> shifts{};
+    for (int j = 0; j < 4; j++)
+        {
+            byte_and_samples raw_byte{};
+            switch (j)
+                {
+                case 0:
+                    raw_byte.samples.sample_0 = 1;
+                    break;
+                case 1:
+                    raw_byte.samples.sample_1 = 1;
+                    break;
+                case 2:
+                    raw_byte.samples.sample_2 = 1;
+                    break;
+                default:
+                    raw_byte.samples.sample_3 = 1;
+                }
+            const auto bits = static_cast<uint8_t>(raw_byte.byte);
+            while ((bits >> shifts[j]) > 1)
+                {
+                    shifts[j] += 2;
+                }
+        }
+
+    // two's complement samples mapped to 2 * x + 1
+    for (int k = 0; k < 4; k++)
+        {
+            const int shift = shifts[order[k]];
+            for (int x = 0; x < 16; x++)
+                {
+                    const int sample = (x >> (shift % 4)) & 3;
+                    tables_[32 * k + (shift >= 4 ? 16 : 0) + x] = static_cast<char>(2 * (sample >= 2 ? sample - 4 : sample) + 1);
+                }
+        }
 }
 
 
@@ -140,71 +199,8 @@ int unpack_2bit_samples::work(int noutput_items,
         }
 
     // Here the in pointer can be interpreted as a stream of bytes to be
-    // converted. But we now have two possibilities:
-    // 1) The samples in a byte are in big endian order
-    // 2) The samples in a byte are in little endian order
-
-    byte_and_samples raw_byte{};
-    int n = 0;
-
-    if (!reverse_interleaving_)
-        {
-            if (swap_endian_bytes_)
-                {
-                    for (size_t i = 0; i < ninput_bytes; ++i)
-                        {
-                            // Read packed input sample (1 byte = 4 samples)
-                            raw_byte.byte = in[i];
-
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_3 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_2 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_1 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_0 + 1);
-                        }
-                }
-            else
-                {
-                    for (size_t i = 0; i < ninput_bytes; ++i)
-                        {
-                            // Read packed input sample (1 byte = 4 samples)
-                            raw_byte.byte = in[i];
-
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_0 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_1 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_2 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_3 + 1);
-                        }
-                }
-        }
-    else
-        {
-            if (swap_endian_bytes_)
-                {
-                    for (size_t i = 0; i < ninput_bytes; ++i)
-                        {
-                            // Read packed input sample (1 byte = 4 samples)
-                            raw_byte.byte = in[i];
-
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_2 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_3 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_0 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_1 + 1);
-                        }
-                }
-            else
-                {
-                    for (size_t i = 0; i < ninput_bytes; ++i)
-                        {
-                            // Read packed input sample (1 byte = 4 samples)
-                            raw_byte.byte = in[i];
-
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_1 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_0 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_3 + 1);
-                            out[n++] = static_cast<int8_t>(2 * raw_byte.samples.sample_2 + 1);
-                        }
-                }
-        }
+    // converted. The order of the samples in a byte is given by the tables.
+    volk_gnsssdr_8u_unpack_dibits_8i(reinterpret_cast<char *>(out), reinterpret_cast<const unsigned char *>(in), tables_.data(), noutput_items);
 
     return noutput_items;
 }
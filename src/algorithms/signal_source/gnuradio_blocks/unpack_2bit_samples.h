@@ -57,6 +57,7 @@
 
 #include "gnss_block_interface.h"
 #include <gnuradio/sync_interpolator.h>
+#include <array>
 #include <cstdint>
 #include <vector>
 
@@ -102,6 +103,7 @@ private:
         bool big_endian_items,
         bool reverse_interleaving);
 
+    std::array<char, 128> tables_{};  // lookup tables of volk_gnsssdr_8u_unpack_dibits_8i
     std::vector<int8_t> work_buffer_;
     size_t item_size_;
     bool big_endian_bytes_;
@@ -21,14 +21,10 @@
 
 #include "unpack_byte_2bit_cpx_samples.h"
 #include <gnuradio/io_signature.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>
 #include <cstdint>
 
-struct byte_2bit_struct
-{
-    signed two_bit_sample : 2;  // <- 2 bits wide only
-};
-
-
 unpack_byte_2bit_cpx_samples_sptr make_unpack_byte_2bit_cpx_samples()
 {
     return unpack_byte_2bit_cpx_samples_sptr(new unpack_byte_2bit_cpx_samples());
@@ -38,8 +34,20 @@ unpack_byte_2bit_cpx_samples_sptr make_unpack_byte_2bit_cpx_samples()
 unpack_byte_2bit_cpx_samples::unpack_byte_2bit_cpx_samples() : sync_interpolator("unpack_byte_2bit_cpx_samples",
                                                                    gr::io_signature::make(1, 1, sizeof(int8_t)),
                                                                    gr::io_signature::make(1, 1, sizeof(int16_t)),
-                                                                   4)
+                                                                   4),
+                                                               d_buffer(4096)
 {
+    // Packing order in Nibble Q1 Q0 I1 I0, with the I/Q swap:
+    // I[n] = bits 4-5, Q[n] = bits 6-7, I[n+1] = bits 0-1, Q[n+1] = bits 2-3
+    const std::array<int, 4> shifts{4, 6, 0, 2};
+    for (int k = 0; k < 4; k++)
+        {
+            for (int x = 0; x < 16; x++)
+                {
+                    const int dibit = (x >> (shifts[k] % 4)) & 3;
+                    d_tables[32 * k + (shifts[k] >= 4 ? 16 : 0) + x] = static_cast<char>(2 * (dibit >= 2 ? dibit - 4 : dibit) + 1);
+                }
+        }
 }
 
 
@@ -47,47 +55,19 @@ int unpack_byte_2bit_cpx_samples::work(int noutput_items,
     gr_vector_const_void_star &input_items,
     gr_vector_void_star &output_items)
 {
-    const auto *in = reinterpret_cast<const int8_t *>(input_items[0]);
+    const auto *in = reinterpret_cast<const unsigned char *>(input_items[0]);
     auto *out = reinterpret_cast<int16_t *>(output_items[0]);
 
-    byte_2bit_struct sample{};
-    int n = 0;
-    for (int i = 0; i < noutput_items / 4; i++)
+    // 1 byte = 2 complex samples, unpacked in blocks that stay in the cache
+    const auto block_size = static_cast<int>(d_buffer.size());
+    for (int n = 0; n < noutput_items; n += block_size)
         {
-            // Read packed input sample (1 byte = 2 complex samples)
-            // *     Packing Order
-            // *     Most Significant Nibble  - Sample n
-            // *     Least Significant Nibble - Sample n+1
-            // *     Packing order in Nibble Q1 Q0 I1 I0
-            // normal
-            //  int8_t c = in[i];
-            //  //Q[n]
-            //  sample.two_bit_sample = (c>>6) & 3;
-            //  out[n++] = (2*(int16_t)sample.two_bit_sample+1);
-            //  //I[n]
-            //  sample.two_bit_sample = (c>>4) & 3;
-            //  out[n++] = (2*(int16_t)sample.two_bit_sample+1);
-            //  //Q[n+1]
-            //  sample.two_bit_sample = (c>>2) & 3;
-            //  out[n++] = (2*(int16_t)sample.two_bit_sample+1);
-            //  //I[n+1]
-            //  sample.two_bit_sample = c & 3;
-            //  out[n++] = (2*(int16_t)sample.two_bit_sample+1);
-
-            // I/Q swap
-            int8_t c = in[i];
-            // I[n]
-            sample.two_bit_sample = (c >> 4) & 3;
-            out[n++] = (2 * static_cast<int16_t>(sample.two_bit_sample) + 1);
-            // Q[n]
-            sample.two_bit_sample = (c >> 6) & 3;
-            out[n++] = (2 * static_cast<int16_t>(sample.two_bit_sample) + 1);
-            // I[n+1]
-            sample.two_bit_sample = c & 3;
-            out[n++] = (2 * static_cast<int16_t>(sample.two_bit_sample) + 1);
-            // Q[n+1]
-            sample.two_bit_sample = (c >> 2) & 3;
-            out[n++] = (2 * static_cast<int16_t>(sample.two_bit_sample) + 1);
+            const int samples = std::min(block_size, noutput_items - n);
+            volk_gnsssdr_8u_unpack_dibits_8i(d_buffer.data(), &in[n / 4], d_tables.data(), samples);
+            for (int i = 0; i < samples; i++)
+                {
+                    out[n + i] = static_cast<int16_t>(d_buffer[i]);
+                }
         }
     return noutput_items;
 }
@@ -24,6 +24,8 @@
 
 #include "gnss_block_interface.h"
 #include <gnuradio/sync_interpolator.h>
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <array>
 
 /** \addtogroup Signal_Source
  * \{ */
@@ -52,6 +54,8 @@ public:
 
 private:
     friend unpack_byte_2bit_cpx_samples_sptr make_unpack_byte_2bit_cpx_samples_sptr();
+    std::array<char, 128> d_tables{};  // lookup tables of volk_gnsssdr_8u_unpack_dibits_8i
+    volk_gnsssdr::vector<char> d_buffer;
 };
 
 
@@ -17,12 +17,8 @@
 
 #include "unpack_byte_2bit_samples.h"
 #include <gnuradio/io_signature.h>
-
-struct byte_2bit_struct
-{
-    signed two_bit_sample : 2;  // <- 2 bits wide only
-};
-
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>
 
 unpack_byte_2bit_samples_sptr make_unpack_byte_2bit_samples()
 {
@@ -33,8 +29,18 @@ unpack_byte_2bit_samples_sptr make_unpack_byte_2bit_samples()
 unpack_byte_2bit_samples::unpack_byte_2bit_samples() : sync_interpolator("unpack_byte_2bit_samples",
                                                            gr::io_signature::make(1, 1, sizeof(signed char)),
                                                            gr::io_signature::make(1, 1, sizeof(float)),
-                                                           4)
+                                                           4),
+                                                       d_buffer(4096)
 {
+    // least significant bits first, two's complement samples
+    for (int k = 0; k < 4; k++)
+        {
+            for (int x = 0; x < 16; x++)
+                {
+                    const int dibit = (x >> (2 * (k % 2))) & 3;
+                    d_tables[32 * k + (k >= 2 ? 16 : 0) + x] = static_cast<char>(dibit >= 2 ? dibit - 4 : dibit);
+                }
+        }
 }
 
 
@@ -42,26 +48,19 @@ int unpack_byte_2bit_samples::work(int noutput_items,
     gr_vector_const_void_star &input_items,
     gr_vector_void_star &output_items)
 {
-    const auto *in = reinterpret_cast<const signed char *>(input_items[0]);
+    const auto *in = reinterpret_cast<const unsigned char *>(input_items[0]);
     auto *out = reinterpret_cast<float *>(output_items[0]);
 
-    byte_2bit_struct sample{};
-    int n = 0;
-    for (int i = 0; i < noutput_items / 4; i++)
+    // unpacked in blocks that stay in the cache
+    const auto block_size = static_cast<int>(d_buffer.size());
+    for (int n = 0; n < noutput_items; n += block_size)
         {
-            // Read packed input sample (1 byte = 4 samples)
-            signed char c = in[i];
-            sample.two_bit_sample = c & 3;
-            out[n++] = static_cast<float>(sample.two_bit_sample);
-
-            sample.two_bit_sample = (c >> 2) & 3;
-            out[n++] = static_cast<float>(sample.two_bit_sample);
-
-            sample.two_bit_sample = (c >> 4) & 3;
-            out[n++] = static_cast<float>(sample.two_bit_sample);
-
-            sample.two_bit_sample = (c >> 6) & 3;
-            out[n++] = static_cast<float>(sample.two_bit_sample);
+            const int samples = std::min(block_size, noutput_items - n);
+            volk_gnsssdr_8u_unpack_dibits_8i(d_buffer.data(), &in[n / 4], d_tables.data(), samples);
+            for (int i = 0; i < samples; i++)
+                {
+                    out[n + i] = static_cast<float>(d_buffer[i]);
+                }
         }
     return noutput_items;
 }
@@ -18,6 +18,7 @@
 
 #include "unpack_byte_4bit_samples.h"
 #include <gnuradio/io_signature.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
 
 unpack_byte_4bit_samples_sptr make_unpack_byte_4bit_samples()
 {
@@ -30,6 +31,13 @@ unpack_byte_4bit_samples::unpack_byte_4bit_samples() : sync_interpolator("unpack
                                                            gr::io_signature::make(1, 1, sizeof(signed char)),
                                                            2)
 {
+    // low nibble first, two's complement samples mapped to 2 * x + 1
+    for (int x = 0; x < 16; x++)
+        {
+            const auto value = static_cast<char>(2 * (x >= 8 ? x - 16 : x) + 1);
+            d_tables[x] = value;
+            d_tables[48 + x] = value;
+        }
 }
 
 
@@ -37,31 +45,8 @@ int unpack_byte_4bit_samples::work(int noutput_items,
     gr_vector_const_void_star &input_items,
     gr_vector_void_star &output_items)
 {
-    const auto *in = reinterpret_cast<const signed char *>(input_items[0]);
-    auto *out = reinterpret_cast<signed char *>(output_items[0]);
-    int n = 0;
-    unsigned char tmp_char2;
-    for (int i = 0; i < noutput_items / 2; i++)
-        {
-            tmp_char2 = in[i] & 0x0F;
-            if (tmp_char2 >= 8)
-                {
-                    out[n++] = 2 * (tmp_char2 - 16) + 1;
-                }
-            else
-                {
-                    out[n++] = 2 * tmp_char2 + 1;
-                }
-            tmp_char2 = in[i] >> 4;
-            tmp_char2 = tmp_char2 & 0x0F;
-            if (tmp_char2 >= 8)
-                {
-                    out[n++] = 2 * (tmp_char2 - 16) + 1;
-                }
-            else
-                {
-                    out[n++] = 2 * tmp_char2 + 1;
-                }
-        }
+    const auto *in = reinterpret_cast<const unsigned char *>(input_items[0]);
+    auto *out = reinterpret_cast<char *>(output_items[0]);
+    volk_gnsssdr_8u_unpack_nibbles_8i(out, in, d_tables.data(), noutput_items);
     return noutput_items;
 }
@@ -21,6 +21,7 @@
 #define GNSS_SDR_UNPACK_BYTE_4BIT_SAMPLES_H
 
 #include <gnuradio/sync_interpolator.h>
+#include <array>
 #include <memory>
 
 /** \addtogroup Signal_Source
@@ -50,6 +51,7 @@ public:
 
 private:
     friend unpack_byte_4bit_samples_sptr make_unpack_byte_4bit_samples_sptr();
+    std::array<char, 64> d_tables{};  // lookup tables of volk_gnsssdr_8u_unpack_nibbles_8i
 };
 
 
@@ -0,0 +1,524 @@
+/*!
+ * \file gnss_capture_file.cc
+ * \brief Writer and reader of capture files: recordings of samples split in
+ * blocks, losslessly packed, and indexed for seeking.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_capture_file.h"
+#include <glog/logging.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>  // for std::min, std::minmax_element, std::fill
+#include <cstring>    // for memcpy, memcmp
+#include <limits>
+#include <stdexcept>
+
+
+namespace
+{
+constexpr std::array<char, 8> CAPTURE_MAGIC{{'G', 'N', 'S', 'S', 'C', 'A', 'P', 'T'}};
+constexpr std::array<char, 4> BLOCK_MAGIC{{'G', 'C', 'B', 'K'}};
+constexpr uint32_t CAPTURE_VERSION = 1;
+constexpr size_t HEADER_BYTES = 128;
+constexpr size_t ITEM_TYPE_BYTES = 32;
+constexpr size_t BLOCK_HEADER_BYTES = 24;
+constexpr size_t INDEX_ENTRY_BYTES = 24;
+
+// The fields are copied in the byte order of the host, which is little-endian
+// in all the platforms supported
+template <typename T>
+void put(uint8_t* buffer, size_t position, T value)
+{
+    std::memcpy(buffer + position, &value, sizeof(T));
+}
+
+
+template <typename T>
+T get(const uint8_t* buffer, size_t position)
+{
+    T value;
+    std::memcpy(&value, buffer + position, sizeof(T));
+    return value;
+}
+
+
+// Bytes of the integer values of an item type, 0 if its items are not packed
+size_t value_size(const std::string& item_type)
+{
+    if (item_type == "byte" or item_type == "ibyte" or item_type == "cbyte")
+        {
+            return 1;
+        }
+    if (item_type == "short" or item_type == "ishort" or item_type == "cshort")
+        {
+            return 2;
+        }
+    return 0;
+}
+
+
+// Smallest width, in bits, that holds all the values, or 0 if none is
+// narrower than the values
+template <typename T>
+uint32_t packed_bits(const T* values, size_t nvalues)
+{
+    const auto range = std::minmax_element(values, values + nvalues);
+    for (const int bits : {2, 4, 8})
+        {
+            if (bits < static_cast<int>(8 * sizeof(T)) and
+                *range.first >= -(1 << (bits - 1)) and
+                *range.second < (1 << (bits - 1)))
+                {
+                    return static_cast<uint32_t>(bits);
+                }
+        }
+    return 0;
+}
+
+
+// Stores the values in bits bits each, the first one in the least
+// significant bits of the first byte
+template <typename T>
+void pack_values(const T* values, size_t nvalues, uint32_t bits, uint8_t* out)
+{
+    if (bits == 8)
+        {
+            for (size_t i = 0; i < nvalues; i++)
+                {
+                    out[i] = static_cast<uint8_t>(values[i]);
+                }
+            return;
+        }
+    const auto mask = static_cast<uint8_t>((1U << bits) - 1);
+    const size_t per_byte = 8 / bits;
+    std::fill(out, out + (nvalues * bits + 7) / 8, 0);
+    for (size_t i = 0; i < nvalues; i++)
+        {
+            out[i / per_byte] |= static_cast<uint8_t>((static_cast<uint8_t>(values[i]) & mask) << (bits * (i % per_byte)));
+        }
+}
+}  // namespace
+
+
+Gnss_Capture_Writer::Gnss_Capture_Writer(const std::string& filename, const Gnss_Capture_Header& header)
+    : d_header(header),
+      d_position(HEADER_BYTES),
+      d_time_item(0),
+      d_time_s(0.0),
+      d_block_items(0),
+      d_value_size(value_size(header.item_type)),
+      d_has_time(false),
+      d_closed(false)
+{
+    if (d_header.item_size == 0 or d_header.items_per_block == 0 or d_header.item_type.size() >= ITEM_TYPE_BYTES)
+        {
+            throw std::runtime_error("Gnss_Capture_Writer: wrong description of the items of " + filename);
+        }
+    if (d_value_size != 0 and d_header.item_size % d_value_size != 0)
+        {
+            d_value_size = 0;
+        }
+    d_header.items = 0;
+    d_block = std::vector<uint8_t>(static_cast<size_t>(d_header.items_per_block) * d_header.item_size);
+    d_stored = std::vector<uint8_t>(BLOCK_HEADER_BYTES + d_block.size());
+
+    d_file.open(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!d_file.is_open())
+        {
+            throw std::runtime_error("Gnss_Capture_Writer: cannot open " + filename);
+        }
+    // the header is written again when the file is closed
+    std::array<uint8_t, HEADER_BYTES> bytes{};
+    d_file.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+}
+
+
+Gnss_Capture_Writer::~Gnss_Capture_Writer()
+{
+    close();
+}
+
+
+void Gnss_Capture_Writer::set_time(uint64_t item, double time_s)
+{
+    d_time_item = item;
+    d_time_s = time_s;
+    d_has_time = true;
+}
+
+
+void Gnss_Capture_Writer::write(const void* items, size_t nitems)
+{
+    const auto* in = static_cast<const uint8_t*>(items);
+    while (nitems > 0)
+        {
+            const size_t n = std::min(nitems, static_cast<size_t>(d_header.items_per_block) - d_block_items);
+            std::memcpy(d_block.data() + d_block_items * d_header.item_size, in, n * d_header.item_size);
+            d_block_items += n;
+            in += n * d_header.item_size;
+            nitems -= n;
+            if (d_block_items == d_header.items_per_block)
+                {
+                    write_block();
+                }
+        }
+}
+
+
+void Gnss_Capture_Writer::write_block()
+{
+    if (d_block_items == 0)
+        {
+            return;
+        }
+    double time_s = std::numeric_limits<double>::quiet_NaN();
+    if (d_has_time)
+        {
+            time_s = d_time_s;
+            if (d_header.sampling_frequency > 0.0)
+                {
+                    time_s += (static_cast<double>(d_header.items) - static_cast<double>(d_time_item)) / d_header.sampling_frequency;
+                }
+        }
+
+    uint32_t bits = 0;
+    size_t bytes = d_block_items * d_header.item_size;
+    uint8_t* data = d_stored.data() + BLOCK_HEADER_BYTES;
+    if (d_value_size == 1)
+        {
+            const auto* values = reinterpret_cast<const int8_t*>(d_block.data());
+            bits = packed_bits(values, bytes);
+            if (bits != 0)
+                {
+                    pack_values(values, bytes, bits, data);
+                    bytes = (bytes * bits + 7) / 8;
+                }
+        }
+    else if (d_value_size == 2)
+        {
+            const auto* values = reinterpret_cast<const int16_t*>(d_block.data());
+            const size_t nvalues = bytes / 2;
+            bits = packed_bits(values, nvalues);
+            if (bits != 0)
+                {
+                    pack_values(values, nvalues, bits, data);
+                    bytes = (nvalues * bits + 7) / 8;
+                }
+        }
+    if (bits == 0)
+        {
+            std::memcpy(data, d_block.data(), bytes);
+        }
+
+    std::memcpy(d_stored.data(), BLOCK_MAGIC.data(), BLOCK_MAGIC.size());
+    put(d_stored.data(), 4, bits);
+    put(d_stored.data(), 8, static_cast<uint32_t>(d_block_items));
+    put(d_stored.data(), 12, static_cast<uint32_t>(bytes));
+    put(d_stored.data(), 16, time_s);
+    d_file.write(reinterpret_cast<const char*>(d_stored.data()), static_cast<std::streamsize>(BLOCK_HEADER_BYTES + bytes));
+
+    std::array<uint8_t, INDEX_ENTRY_BYTES> entry{};
+    put(entry.data(), 0, d_position);
+    put(entry.data(), 8, bits);
+    put(entry.data(), 12, static_cast<uint32_t>(bytes));
+    put(entry.data(), 16, time_s);
+    d_index.push_back(entry);
+
+    d_position += BLOCK_HEADER_BYTES + bytes;
+    d_header.items += d_block_items;
+    d_block_items = 0;
+}
+
+
+void Gnss_Capture_Writer::close()
+{
+    if (d_closed)
+        {
+            return;
+        }
+    d_closed = true;
+    write_block();
+
+    const uint64_t index_position = d_position;
+    for (const auto& entry : d_index)
+        {
+            d_file.write(reinterpret_cast<const char*>(entry.data()), entry.size());
+        }
+    d_position += d_index.size() * INDEX_ENTRY_BYTES;
+
+    std::array<uint8_t, HEADER_BYTES> bytes{};
+    std::memcpy(bytes.data(), CAPTURE_MAGIC.data(), CAPTURE_MAGIC.size());
+    put(bytes.data(), 8, CAPTURE_VERSION);
+    put(bytes.data(), 12, d_header.item_size);
+    std::memcpy(bytes.data() + 16, d_header.item_type.data(), d_header.item_type.size());
+    put(bytes.data(), 48, d_header.items_per_block);
+    put(bytes.data(), 56, d_header.sampling_frequency);
+    put(bytes.data(), 64, d_header.intermediate_frequency);
+    put(bytes.data(), 72, d_header.items);
+    put(bytes.data(), 80, static_cast<uint64_t>(d_index.size()));
+    put(bytes.data(), 88, index_position);
+    d_file.seekp(0);
+    d_file.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    d_file.close();
+    DLOG(INFO) << "Capture file closed with " << d_header.items << " items in " << d_index.size() << " blocks";
+}
+
+
+uint64_t Gnss_Capture_Writer::items() const
+{
+    return d_header.items + d_block_items;
+}
+
+
+uint64_t Gnss_Capture_Writer::bytes() const
+{
+    return d_position;
+}
+
+
+bool Gnss_Capture_Writer::has_time() const
+{
+    return d_has_time;
+}
+
+
+Gnss_Capture_Reader::Gnss_Capture_Reader(const std::string& filename)
+    : d_position(0),
+      d_block_number(std::numeric_limits<uint64_t>::max()),
+      d_block_items(0),
+      d_value_size(0)
+{
+    d_file.open(filename, std::ios::in | std::ios::binary);
+    std::array<uint8_t, HEADER_BYTES> bytes{};
+    if (!d_file.is_open() or !d_file.read(reinterpret_cast<char*>(bytes.data()), bytes.size()) or
+        std::memcmp(bytes.data(), CAPTURE_MAGIC.data(), CAPTURE_MAGIC.size()) != 0)
+        {
+            throw std::runtime_error("Gnss_Capture_Reader: " + filename + " is not a capture file");
+        }
+    if (get<uint32_t>(bytes.data(), 8) != CAPTURE_VERSION)
+        {
+            throw std::runtime_error("Gnss_Capture_Reader: unsupported version of the capture file " + filename);
+        }
+    d_header.item_size = get<uint32_t>(bytes.data(), 12);
+    d_header.item_type = std::string(reinterpret_cast<const char*>(bytes.data()) + 16,
+        strnlen(reinterpret_cast<const char*>(bytes.data()) + 16, ITEM_TYPE_BYTES));
+    d_header.items_per_block = get<uint32_t>(bytes.data(), 48);
+    d_header.sampling_frequency = get<double>(bytes.data(), 56);
+    d_header.intermediate_frequency = get<double>(bytes.data(), 64);
+    d_header.items = get<uint64_t>(bytes.data(), 72);
+    const auto blocks = get<uint64_t>(bytes.data(), 80);
+    const auto index_position = get<uint64_t>(bytes.data(), 88);
+
+    if (index_position == 0)
+        {
+            // the recording was interrupted before the file was closed
+            rebuild_index();
+        }
+    else
+        {
+            if (d_header.item_size == 0 or d_header.items_per_block == 0)
+                {
+                    throw std::runtime_error("Gnss_Capture_Reader: wrong header in the capture file " + filename);
+                }
+            std::vector<uint8_t> index(blocks * INDEX_ENTRY_BYTES);
+            d_file.seekg(static_cast<std::streamoff>(index_position));
+            if (!d_file.read(reinterpret_cast<char*>(index.data()), static_cast<std::streamsize>(index.size())))
+                {
+                    throw std::runtime_error("Gnss_Capture_Reader: cannot read the index of " + filename);
+                }
+            d_index.reserve(blocks);
+            for (size_t i = 0; i < index.size(); i += INDEX_ENTRY_BYTES)
+                {
+                    d_index.push_back({get<uint64_t>(index.data(), i), get<uint32_t>(index.data(), i + 8),
+                        get<uint32_t>(index.data(), i + 12), get<double>(index.data(), i + 16)});
+                }
+        }
+
+    d_value_size = value_size(d_header.item_type);
+    if (d_value_size != 0 and d_header.item_size % d_value_size != 0)
+        {
+            d_value_size = 0;
+        }
+    d_block = std::vector<uint8_t>(static_cast<size_t>(d_header.items_per_block) * d_header.item_size);
+    d_stored = std::vector<uint8_t>(d_block.size());
+    if (d_value_size == 2)
+        {
+            d_values = std::vector<char>(d_block.size() / 2);
+        }
+
+    // two's complement values, the first one in the least significant bits
+    for (int x = 0; x < 16; x++)
+        {
+            d_nibble_tables[x] = static_cast<char>(x >= 8 ? x - 16 : x);
+            d_nibble_tables[48 + x] = d_nibble_tables[x];
+            for (int k = 0; k < 2; k++)
+                {
+                    const int dibit = (x >> (2 * k)) & 3;
+                    d_dibit_tables[32 * k + x] = static_cast<char>(dibit >= 2 ? dibit - 4 : dibit);
+                    d_dibit_tables[32 * (k + 2) + 16 + x] = d_dibit_tables[32 * k + x];
+                }
+        }
+    DLOG(INFO) << "Capture file " << filename << " with " << d_header.items << " items of type "
+               << d_header.item_type << " in " << d_index.size() << " blocks";
+}
+
+
+bool Gnss_Capture_Reader::is_capture_file(const std::string& filename)
+{
+    std::ifstream file(filename, std::ios::in | std::ios::binary);
+    std::array<char, 8> magic{};
+    return file.read(magic.data(), magic.size()) and magic == CAPTURE_MAGIC;
+}
+
+
+void Gnss_Capture_Reader::rebuild_index()
+{
+    LOG(WARNING) << "The capture file was not closed, rebuilding its index";
+    d_file.clear();
+    d_file.seekg(0, std::ios::end);
+    const auto file_size = static_cast<uint64_t>(d_file.tellg());
+    if (d_header.item_size == 0 or d_header.items_per_block == 0)
+        {
+            throw std::runtime_error("Gnss_Capture_Reader: wrong header in the capture file");
+        }
+
+    uint64_t position = HEADER_BYTES;
+    d_header.items = 0;
+    std::array<uint8_t, BLOCK_HEADER_BYTES> bytes{};
+    while (position + BLOCK_HEADER_BYTES <= file_size)
+        {
+            d_file.seekg(static_cast<std::streamoff>(position));
+            if (!d_file.read(reinterpret_cast<char*>(bytes.data()), bytes.size()) or
+                std::memcmp(bytes.data(), BLOCK_MAGIC.data(), BLOCK_MAGIC.size()) != 0)
+                {
+                    break;
+                }
+            const auto items = get<uint32_t>(bytes.data(), 8);
+            const auto block_bytes = get<uint32_t>(bytes.data(), 12);
+            if (items > d_header.items_per_block or position + BLOCK_HEADER_BYTES + block_bytes > file_size)
+                {
+                    break;  // truncated block
+                }
+            d_index.push_back({position, get<uint32_t>(bytes.data(), 4), block_bytes, get<double>(bytes.data(), 16)});
+            d_header.items += items;
+            position += BLOCK_HEADER_BYTES + block_bytes;
+            if (items < d_header.items_per_block)
+                {
+                    break;  // last block
+                }
+        }
+    d_file.clear();
+}
+
+
+const Gnss_Capture_Header& Gnss_Capture_Reader::header() const
+{
+    return d_header;
+}
+
+
+void Gnss_Capture_Reader::load_block(uint64_t block)
+{
+    const Block_Entry& entry = d_index.at(block);
+    d_block_items = static_cast<size_t>(std::min(d_header.items - block * d_header.items_per_block,
+        static_cast<uint64_t>(d_header.items_per_block)));
+    const size_t bytes = d_block_items * d_header.item_size;
+    const size_t nvalues = d_value_size == 0 ? 0 : bytes / d_value_size;
+    uint8_t* data = entry.encoding == 0 ? d_block.data() : d_stored.data();
+    if (entry.bytes > d_stored.size() or
+        (entry.encoding == 0 and entry.bytes != bytes) or
+        (entry.encoding != 0 and static_cast<size_t>(entry.bytes) * 8 < nvalues * entry.encoding) or
+        (entry.encoding != 0 and d_value_size == 0))
+        {
+            throw std::runtime_error("Gnss_Capture_Reader: wrong block in the capture file");
+        }
+    d_file.seekg(static_cast<std::streamoff>(entry.position + BLOCK_HEADER_BYTES));
+    if (!d_file.read(reinterpret_cast<char*>(data), entry.bytes))
+        {
+            throw std::runtime_error("Gnss_Capture_Reader: cannot read a block of the capture file");
+        }
+    d_block_number = block;
+    if (entry.encoding == 0)
+        {
+            return;
+        }
+
+    char* values = d_value_size == 1 ? reinterpret_cast<char*>(d_block.data()) : d_values.data();
+    switch (entry.encoding)
+        {
+        case 2:
+            volk_gnsssdr_8u_unpack_dibits_8i(values, d_stored.data(), d_dibit_tables.data(), nvalues);
+            break;
+        case 4:
+            volk_gnsssdr_8u_unpack_nibbles_8i(values, d_stored.data(), d_nibble_tables.data(), nvalues);
+            break;
+        default:
+            std::memcpy(values, d_stored.data(), nvalues);
+        }
+    if (d_value_size == 2)
+        {
+            auto* out = reinterpret_cast<int16_t*>(d_block.data());
+            for (size_t i = 0; i < nvalues; i++)
+                {
+                    out[i] = values[i];
+                }
+        }
+}
+
+
+size_t Gnss_Capture_Reader::read(void* items, size_t nitems)
+{
+    auto* out = static_cast<uint8_t*>(items);
+    size_t copied = 0;
+    while (copied < nitems and d_position < d_header.items)
+        {
+            const uint64_t block = d_position / d_header.items_per_block;
+            if (block != d_block_number)
+                {
+                    load_block(block);
+                }
+            const auto offset = static_cast<size_t>(d_position - block * d_header.items_per_block);
+            const size_t n = std::min(nitems - copied, d_block_items - offset);
+            std::memcpy(out + copied * d_header.item_size, d_block.data() + offset * d_header.item_size, n * d_header.item_size);
+            copied += n;
+            d_position += n;
+        }
+    return copied;
+}
+
+
+void Gnss_Capture_Reader::seek(uint64_t item)
+{
+    d_position = std::min(item, d_header.items);
+}
+
+
+uint64_t Gnss_Capture_Reader::tell() const
+{
+    return d_position;
+}
+
+
+double Gnss_Capture_Reader::time_of(uint64_t item) const
+{
+    if (d_index.empty())
+        {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+    const uint64_t block = std::min(item / d_header.items_per_block, static_cast<uint64_t>(d_index.size() - 1));
+    double time_s = d_index[block].time_s;
+    if (d_header.sampling_frequency > 0.0)
+        {
+            time_s += static_cast<double>(item - block * d_header.items_per_block) / d_header.sampling_frequency;
+        }
+    return time_s;
+}
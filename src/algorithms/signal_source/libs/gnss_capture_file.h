@@ -0,0 +1,171 @@
+/*!
+ * \file gnss_capture_file.h
+ * \brief Writer and reader of capture files: recordings of samples split in
+ * blocks, losslessly packed, and indexed for seeking.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_CAPTURE_FILE_H
+#define GNSS_SDR_GNSS_CAPTURE_FILE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_libs
+ * \{ */
+
+
+/*!
+ * \brief Description of the samples of a capture file, stored in its header.
+ */
+struct Gnss_Capture_Header
+{
+    std::string item_type;               //!< Item type of the samples, as in the item_type properties
+    uint32_t item_size{0};               //!< Bytes per item
+    uint32_t items_per_block{65536};     //!< Items of each block, except the last one
+    double sampling_frequency{0.0};      //!< Sampling frequency [Hz]
+    double intermediate_frequency{0.0};  //!< Intermediate frequency [Hz]
+    uint64_t items{0};                   //!< Items in the file
+};
+
+
+/*!
+ * \brief Writes a capture file.
+ *
+ * A capture file starts with a header of 128 bytes, followed by the blocks of
+ * items and by an index with the position of each block, all in
+ * little-endian. Each block has a header of 24 bytes with its encoding, its
+ * number of items and bytes, and the time of its first item.
+ *
+ * The values of the integer item types (byte, ibyte, cbyte, short, ishort and
+ * cshort) of each block are stored with the smallest width of 2, 4 or 8 bits
+ * that holds all of them, so the packing is lossless. Recordings of 2-bit
+ * and 4-bit front-ends written as bytes or shorts take a fraction of their
+ * raw size. The blocks of other item types are stored as they are.
+ *
+ * The index and the number of items are written to the header when the file
+ * is closed. If the recording is interrupted, the reader rebuilds the index
+ * from the headers of the blocks.
+ */
+class Gnss_Capture_Writer
+{
+public:
+    /*!
+     * \brief Creates the file. Throws std::runtime_error if it cannot be
+     * written.
+     */
+    Gnss_Capture_Writer(const std::string& filename, const Gnss_Capture_Header& header);
+    ~Gnss_Capture_Writer();
+
+    /*!
+     * \brief Sets the time, in seconds, of the item number item. The time of
+     * the following items is computed from the sampling frequency.
+     */
+    void set_time(uint64_t item, double time_s);
+
+    void write(const void* items, size_t nitems);  //!< Appends nitems items
+    void close();                                  //!< Writes the last block and the index
+
+    uint64_t items() const;  //!< Items written
+    uint64_t bytes() const;  //!< Bytes written to the file
+    bool has_time() const;   //!< Whether the items are timestamped
+
+private:
+    void write_block();
+
+    Gnss_Capture_Header d_header;
+    std::vector<uint8_t> d_block;   // items of the block being filled
+    std::vector<uint8_t> d_stored;  // encoded block
+    std::vector<std::array<uint8_t, 24>> d_index;
+    std::ofstream d_file;
+    uint64_t d_position;   // bytes written
+    uint64_t d_time_item;  // reference of the time of the items
+    double d_time_s;
+    size_t d_block_items;  // items in d_block
+    size_t d_value_size;   // bytes per integer value, 0 if the items are not packed
+    bool d_has_time;
+    bool d_closed;
+};
+
+
+/*!
+ * \brief Reads a capture file.
+ *
+ * Since all the blocks except the last one have the same number of items,
+ * the block of any item is found in the index without reading the previous
+ * ones, so seeking is O(1).
+ */
+class Gnss_Capture_Reader
+{
+public:
+    /*!
+     * \brief Opens the file. Throws std::runtime_error if it is not a
+     * capture file.
+     */
+    explicit Gnss_Capture_Reader(const std::string& filename);
+
+    //! Whether filename is a capture file
+    static bool is_capture_file(const std::string& filename);
+
+    const Gnss_Capture_Header& header() const;
+
+    /*!
+     * \brief Copies up to nitems items to items, and returns the number of
+     * items copied, 0 at the end of the file.
+     */
+    size_t read(void* items, size_t nitems);
+
+    void seek(uint64_t item);  //!< Moves the read position to the item number item
+    uint64_t tell() const;     //!< Item at the read position
+
+    /*!
+     * \brief Time of the item number item, in seconds, or NaN if the file is
+     * not timestamped.
+     */
+    double time_of(uint64_t item) const;
+
+private:
+    struct Block_Entry
+    {
+        uint64_t position;
+        uint32_t encoding;
+        uint32_t bytes;
+        double time_s;
+    };
+
+    void rebuild_index();
+    void load_block(uint64_t block);
+
+    Gnss_Capture_Header d_header;
+    std::vector<Block_Entry> d_index;
+    std::vector<uint8_t> d_stored;  // encoded block
+    std::vector<uint8_t> d_block;   // decoded block
+    std::vector<char> d_values;     // unpacked values of the shorts
+    std::array<char, 64> d_nibble_tables{};
+    std::array<char, 128> d_dibit_tables{};
+    std::ifstream d_file;
+    uint64_t d_position;      // item at the read position
+    uint64_t d_block_number;  // block loaded in d_block
+    size_t d_block_items;     // items of the block loaded
+    size_t d_value_size;      // bytes per integer value, 0 if the items are not packed
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_CAPTURE_FILE_H
@@ -0,0 +1,194 @@
+/*!
+ * \file gnss_capture_ring.cc
+ * \brief In-memory ring of the last samples of a stream, written to a
+ * capture file only when an anomaly triggers a capture.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_capture_ring.h"
+#include <glog/logging.h>
+#include <algorithm>  // for min, max
+#include <chrono>
+#include <cstring>  // for memcpy
+#include <exception>
+#include <sstream>
+
+
+Gnss_Capture_Ring::Gnss_Capture_Ring(const std::string& name, const Gnss_Capture_Header& header, size_t capacity_items, const std::string& filename_prefix)
+    : d_header(header),
+      d_ring(std::max(capacity_items, static_cast<size_t>(1)) * header.item_size),
+      d_name(name),
+      d_filename_prefix(filename_prefix),
+      d_item_size(header.item_size),
+      d_capacity(std::max(capacity_items, static_cast<size_t>(1))),
+      d_thread(&Gnss_Capture_Ring::run, this)
+{
+}
+
+
+Gnss_Capture_Ring::~Gnss_Capture_Ring()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_stop = true;
+    }
+    d_cond.notify_all();
+    d_thread.join();
+}
+
+
+void Gnss_Capture_Ring::push(const void* items, size_t nitems)
+{
+    const auto* in = static_cast<const uint8_t*>(items);
+    std::lock_guard<std::mutex> lock(d_mutex);
+    if (nitems > d_capacity)
+        {
+            // only the last items fit
+            in += (nitems - d_capacity) * d_item_size;
+            d_items_pushed += nitems - d_capacity;
+            nitems = d_capacity;
+        }
+    const auto pos = static_cast<size_t>(d_items_pushed % d_capacity);
+    const size_t first = std::min(nitems, d_capacity - pos);
+    memcpy(d_ring.data() + pos * d_item_size, in, first * d_item_size);
+    memcpy(d_ring.data(), in + first * d_item_size, (nitems - first) * d_item_size);
+    d_items_pushed += nitems;
+}
+
+
+bool Gnss_Capture_Ring::trigger(const std::string& reason)
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        if (d_pending or d_items_pushed == 0)
+            {
+                return false;
+            }
+        d_pending = true;
+        d_end_item = d_items_pushed;
+        d_end_time_s = std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+        d_reason = reason;
+    }
+    d_cond.notify_all();
+    return true;
+}
+
+
+void Gnss_Capture_Ring::wait_idle()
+{
+    std::unique_lock<std::mutex> lock(d_mutex);
+    d_cond.wait(lock, [this] { return !d_pending; });
+}
+
+
+uint64_t Gnss_Capture_Ring::items_pushed() const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_items_pushed;
+}
+
+
+uint32_t Gnss_Capture_Ring::captures() const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_captures;
+}
+
+
+std::string Gnss_Capture_Ring::last_filename() const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_last_filename;
+}
+
+
+void Gnss_Capture_Ring::run()
+{
+    std::unique_lock<std::mutex> lock(d_mutex);
+    while (true)
+        {
+            d_cond.wait(lock, [this] { return d_pending or d_stop; });
+            if (d_pending)
+                {
+                    const uint64_t end_item = d_end_item;
+                    const double end_time_s = d_end_time_s;
+                    const std::string reason = d_reason;
+                    lock.unlock();
+                    write_capture(end_item, end_time_s, reason);
+                    lock.lock();
+                    d_pending = false;
+                    d_cond.notify_all();
+                }
+            else
+                {
+                    return;
+                }
+        }
+}
+
+
+void Gnss_Capture_Ring::write_capture(uint64_t end_item, double end_time_s, const std::string& reason)
+{
+    // The stream overwrites the oldest items while they are copied: start a
+    // chunk later, and start over if it still catches up with the copy
+    const size_t chunk = std::max(d_capacity / 64, static_cast<size_t>(1));
+    uint64_t begin_item = (end_item > d_capacity ? end_item - d_capacity + chunk : 0);
+    begin_item = std::min(begin_item, end_item);
+    std::vector<uint8_t> capture(static_cast<size_t>(end_item - begin_item) * d_item_size);
+    size_t copied = 0;
+    while (begin_item + copied < end_item)
+        {
+            std::lock_guard<std::mutex> lock(d_mutex);
+            const uint64_t oldest_item = (d_items_pushed > d_capacity ? d_items_pushed - d_capacity : 0);
+            if (begin_item + copied < oldest_item)
+                {
+                    begin_item = std::min(oldest_item + chunk, end_item);
+                    copied = 0;
+                    continue;
+                }
+            const auto nitems = static_cast<size_t>(std::min(static_cast<uint64_t>(chunk), end_item - begin_item - copied));
+            copy_items(begin_item + copied, nitems, capture.data() + copied * d_item_size);
+            copied += nitems;
+        }
+
+    std::stringstream filename;
+    filename << d_filename_prefix << '_' << d_name << '_' << captures() + 1 << '_' << reason << ".dat";
+    try
+        {
+            Gnss_Capture_Writer writer(filename.str(), d_header);
+            if (d_header.sampling_frequency > 0.0)
+                {
+                    // the last item was pushed when the capture was triggered
+                    writer.set_time(0, end_time_s - static_cast<double>(copied) / d_header.sampling_frequency);
+                }
+            writer.write(capture.data(), copied);
+            writer.close();
+        }
+    catch (const std::exception& e)
+        {
+            LOG(WARNING) << "The capture of " << d_name << " cannot be written to " << filename.str() << ": " << e.what();
+            return;
+        }
+    LOG(INFO) << "Capture of " << copied << " items of " << d_name << " (" << reason << ") written to " << filename.str();
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_captures++;
+    d_last_filename = filename.str();
+}
+
+
+void Gnss_Capture_Ring::copy_items(uint64_t first_item, size_t nitems, uint8_t* out) const
+{
+    const auto pos = static_cast<size_t>(first_item % d_capacity);
+    const size_t first = std::min(nitems, d_capacity - pos);
+    memcpy(out, d_ring.data() + pos * d_item_size, first * d_item_size);
+    memcpy(out + first * d_item_size, d_ring.data(), (nitems - first) * d_item_size);
+}
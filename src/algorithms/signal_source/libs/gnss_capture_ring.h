@@ -0,0 +1,102 @@
+/*!
+ * \file gnss_capture_ring.h
+ * \brief In-memory ring of the last samples of a stream, written to a
+ * capture file only when an anomaly triggers a capture.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_CAPTURE_RING_H
+#define GNSS_SDR_GNSS_CAPTURE_RING_H
+
+#include "gnss_capture_file.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_libs
+ * \{ */
+
+
+/*!
+ * \brief Keeps the last capacity items of a stream in memory.
+ *
+ * When triggered, the items in the ring at that moment are written by a
+ * background thread to the capture file prefix_name_N_reason.dat (see
+ * Gnss_Capture_Writer), timestamped with the system time, while the stream
+ * keeps filling the ring. The thread copies the ring in short chunks, so
+ * that the stream is only held for one chunk at a time. The oldest items
+ * may be overwritten before they are copied: the capture then starts a bit
+ * later, but it never has a gap.
+ */
+class Gnss_Capture_Ring
+{
+public:
+    /*!
+     * \brief header describes the items pushed, header.item_size bytes each
+     */
+    Gnss_Capture_Ring(const std::string& name, const Gnss_Capture_Header& header, size_t capacity_items, const std::string& filename_prefix);
+    ~Gnss_Capture_Ring();  //!< Writes the pending capture, if any
+
+    Gnss_Capture_Ring(const Gnss_Capture_Ring&) = delete;
+    Gnss_Capture_Ring& operator=(const Gnss_Capture_Ring&) = delete;
+
+    void push(const void* items, size_t nitems);
+
+    /*!
+     * \brief Writes the items in the ring to a file in background. Returns
+     * false, ignoring the request, if the previous capture is still being
+     * written or there is nothing to write.
+     */
+    bool trigger(const std::string& reason);
+
+    //! Waits until the pending capture has been written
+    void wait_idle();
+
+    uint64_t items_pushed() const;
+    uint32_t captures() const;          //!< Files written
+    std::string last_filename() const;  //!< File of the last capture written
+
+private:
+    void run();
+    void write_capture(uint64_t end_item, double end_time_s, const std::string& reason);
+    void copy_items(uint64_t first_item, size_t nitems, uint8_t* out) const;
+
+    Gnss_Capture_Header d_header;
+    std::vector<uint8_t> d_ring;
+    std::string d_name;
+    std::string d_filename_prefix;
+    std::string d_reason;
+    std::string d_last_filename;
+    size_t d_item_size;
+    size_t d_capacity;
+    uint64_t d_items_pushed{0};
+    uint64_t d_end_item{0};  // items in the stream when the pending capture was triggered
+    double d_end_time_s{0.0};
+    uint32_t d_captures{0};
+    bool d_pending{false};
+    bool d_stop{false};
+
+    mutable std::mutex d_mutex;
+    std::condition_variable d_cond;
+    std::thread d_thread;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_CAPTURE_RING_H
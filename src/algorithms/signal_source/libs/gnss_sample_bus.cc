@@ -0,0 +1,320 @@
+/*!
+ * \file gnss_sample_bus.cc
+ * \brief Shared memory ring of samples, written by one receiver and read by
+ * the other receivers of the same host
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sample_bus.h"
+#include <fcntl.h>     // for O_CREAT, O_RDWR, O_RDONLY
+#include <sys/mman.h>  // for mmap, madvise, munmap, shm_open, shm_unlink
+#include <sys/stat.h>  // for fstat
+#include <unistd.h>    // for ftruncate, close
+#include <algorithm>   // for min
+#include <cerrno>      // for errno
+#include <chrono>
+#include <cstring>  // for memcpy, memset, strerror
+#include <new>      // for placement new
+#include <stdexcept>
+#include <thread>
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "The sample bus requires lock-free 64-bit atomics");
+
+constexpr uint32_t Gnss_Sample_Bus_Header::MAGIC;
+constexpr uint32_t Gnss_Sample_Bus_Header::VERSION;
+
+namespace
+{
+constexpr size_t SAMPLE_BUS_DATA_OFFSET = 4096;  // the items start on a page of their own
+constexpr size_t SAMPLE_BUS_HUGE_PAGE_SIZE = 2097152;
+constexpr int SAMPLE_BUS_POLL_INTERVAL_US = 250;  // the writer does not wake the readers up
+
+static_assert(sizeof(Gnss_Sample_Bus_Header) <= SAMPLE_BUS_DATA_OFFSET, "The header of the sample bus does not fit in its page");
+
+std::string sample_bus_object_name(const std::string& name)
+{
+    return name.empty() or name[0] != '/' ? "/" + name : name;
+}
+}  // namespace
+
+
+Gnss_Sample_Bus_Writer::Gnss_Sample_Bus_Writer(const std::string& name,
+    size_t item_size,
+    uint64_t capacity,
+    bool huge_pages)
+    : d_name(sample_bus_object_name(name)),
+      d_item_size(item_size),
+      d_capacity(capacity)
+{
+    if (item_size == 0 or capacity == 0)
+        {
+            throw std::runtime_error("Invalid item size or capacity for the sample bus " + d_name);
+        }
+    d_map_size = SAMPLE_BUS_DATA_OFFSET + static_cast<size_t>(capacity) * item_size;
+    if (huge_pages)
+        {
+            d_map_size = (d_map_size + SAMPLE_BUS_HUGE_PAGE_SIZE - 1) / SAMPLE_BUS_HUGE_PAGE_SIZE * SAMPLE_BUS_HUGE_PAGE_SIZE;
+        }
+
+    // A receiver that crashed may have left the object behind
+    shm_unlink(d_name.c_str());
+    const int fd = shm_open(d_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0)
+        {
+            throw std::runtime_error("shm_open " + d_name + ": " + std::strerror(errno));
+        }
+    if (ftruncate(fd, static_cast<off_t>(d_map_size)) != 0)
+        {
+            const std::string error(std::strerror(errno));
+            ::close(fd);
+            shm_unlink(d_name.c_str());
+            throw std::runtime_error("ftruncate " + d_name + ": " + error);
+        }
+    void* map = mmap(nullptr, d_map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED)
+        {
+            const std::string error(std::strerror(errno));
+            shm_unlink(d_name.c_str());
+            throw std::runtime_error("mmap " + d_name + ": " + error);
+        }
+    d_map = map;
+#ifdef MADV_HUGEPAGE
+    d_huge_pages = huge_pages and madvise(d_map, d_map_size, MADV_HUGEPAGE) == 0;
+#endif
+    // touch the whole ring once, so that the writes of the flowgraph do not
+    // take page faults
+    d_data = static_cast<uint8_t*>(d_map) + SAMPLE_BUS_DATA_OFFSET;
+    std::memset(d_data, 0, d_map_size - SAMPLE_BUS_DATA_OFFSET);
+
+    d_header = new (d_map) Gnss_Sample_Bus_Header;
+    d_header->version = Gnss_Sample_Bus_Header::VERSION;
+    d_header->item_size = static_cast<uint32_t>(item_size);
+    d_header->data_offset = static_cast<uint32_t>(SAMPLE_BUS_DATA_OFFSET);
+    d_header->capacity = capacity;
+    d_header->first_sample.store(0, std::memory_order_relaxed);
+    d_header->closed.store(0, std::memory_order_relaxed);
+    d_header->write_begin.store(0, std::memory_order_relaxed);
+    d_header->write_count.store(0, std::memory_order_relaxed);
+    // readers check the magic number first
+    std::atomic_thread_fence(std::memory_order_release);
+    d_header->magic = Gnss_Sample_Bus_Header::MAGIC;
+}
+
+
+Gnss_Sample_Bus_Writer::~Gnss_Sample_Bus_Writer()
+{
+    if (d_map != nullptr)
+        {
+            close();
+            munmap(d_map, d_map_size);
+            shm_unlink(d_name.c_str());
+        }
+}
+
+
+void Gnss_Sample_Bus_Writer::write(const void* items, size_t nitems, uint64_t first_sample)
+{
+    if (nitems == 0)
+        {
+            return;
+        }
+    if (d_write_count == 0)
+        {
+            d_header->first_sample.store(first_sample, std::memory_order_relaxed);
+        }
+    else if (first_sample != d_header->first_sample.load(std::memory_order_relaxed) + d_write_count)
+        {
+            d_discontinuities++;
+        }
+
+    const auto* input = static_cast<const uint8_t*>(items);
+    if (nitems > d_capacity)
+        {
+            // only the newest items would stay in the ring
+            const uint64_t skipped = nitems - d_capacity;
+            input += skipped * d_item_size;
+            d_write_count += skipped;
+            nitems = static_cast<size_t>(d_capacity);
+        }
+
+    d_header->write_begin.store(d_write_count + nitems, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    const auto position = static_cast<size_t>(d_write_count % d_capacity);
+    const size_t first_part = std::min<size_t>(nitems, static_cast<size_t>(d_capacity) - position);
+    std::memcpy(d_data + position * d_item_size, input, first_part * d_item_size);
+    std::memcpy(d_data, input + first_part * d_item_size, (nitems - first_part) * d_item_size);
+    d_write_count += nitems;
+    d_header->write_count.store(d_write_count, std::memory_order_release);
+}
+
+
+void Gnss_Sample_Bus_Writer::close()
+{
+    d_header->closed.store(1, std::memory_order_release);
+}
+
+
+Gnss_Sample_Bus_Reader::Gnss_Sample_Bus_Reader(const std::string& name,
+    size_t item_size,
+    uint64_t max_gap_samples)
+    : d_item_size(item_size),
+      d_max_gap_samples(max_gap_samples)
+{
+    const std::string object_name = sample_bus_object_name(name);
+    const int fd = shm_open(object_name.c_str(), O_RDONLY, 0);
+    if (fd < 0)
+        {
+            throw std::runtime_error("shm_open " + object_name + ": " + std::strerror(errno));
+        }
+    struct stat object_stat
+    {
+    };
+    if (fstat(fd, &object_stat) != 0 or static_cast<size_t>(object_stat.st_size) < SAMPLE_BUS_DATA_OFFSET)
+        {
+            ::close(fd);
+            throw std::runtime_error(object_name + " is not a GNSS-SDR sample bus");
+        }
+    d_map_size = static_cast<size_t>(object_stat.st_size);
+    void* map = mmap(nullptr, d_map_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED)
+        {
+            throw std::runtime_error("mmap " + object_name + ": " + std::strerror(errno));
+        }
+
+    const auto* header = static_cast<const Gnss_Sample_Bus_Header*>(map);
+    if (header->magic != Gnss_Sample_Bus_Header::MAGIC or header->version != Gnss_Sample_Bus_Header::VERSION or
+        header->capacity == 0 or header->data_offset < sizeof(Gnss_Sample_Bus_Header) or
+        header->data_offset + header->capacity * header->item_size > d_map_size)
+        {
+            munmap(map, d_map_size);
+            throw std::runtime_error(object_name + " is not a GNSS-SDR sample bus, or its version is not supported");
+        }
+    if (header->item_size != item_size)
+        {
+            const uint32_t bus_item_size = header->item_size;
+            munmap(map, d_map_size);
+            throw std::runtime_error("The items of the sample bus " + object_name + " take " + std::to_string(bus_item_size) +
+                                     " bytes, not " + std::to_string(item_size));
+        }
+    d_map = map;
+    d_header = header;
+    d_data = static_cast<const uint8_t*>(map) + header->data_offset;
+
+    d_start_count = d_header->write_count.load(std::memory_order_acquire);
+    d_read_count = d_start_count;
+}
+
+
+Gnss_Sample_Bus_Reader::~Gnss_Sample_Bus_Reader()
+{
+    munmap(d_map, d_map_size);
+}
+
+
+void Gnss_Sample_Bus_Reader::overrun(uint64_t write_count)
+{
+    // go on from the middle of the ring, to leave room for the writer
+    const uint64_t next = write_count - d_header->capacity / 2;
+    const uint64_t missed = next - d_read_count;
+    d_overruns++;
+    d_lost_samples += missed;
+    if (d_gap + missed > d_max_gap_samples)
+        {
+            d_resyncs++;
+            d_gap = 0;
+        }
+    else
+        {
+            d_gap += missed;
+        }
+    d_read_count = next;
+}
+
+
+size_t Gnss_Sample_Bus_Reader::read(void* out, size_t max_items, int timeout_ms)
+{
+    const uint64_t capacity = d_header->capacity;
+    uint64_t write_count = d_header->write_count.load(std::memory_order_acquire);
+    if (d_gap == 0 and write_count <= d_read_count)
+        {
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+            while (write_count <= d_read_count)
+                {
+                    if (d_header->closed.load(std::memory_order_acquire) != 0 or std::chrono::steady_clock::now() >= deadline)
+                        {
+                            return 0;
+                        }
+                    std::this_thread::sleep_for(std::chrono::microseconds(SAMPLE_BUS_POLL_INTERVAL_US));
+                    write_count = d_header->write_count.load(std::memory_order_acquire);
+                }
+        }
+
+    auto* output = static_cast<uint8_t*>(out);
+    size_t written = 0;
+    while (written < max_items)
+        {
+            if (write_count > d_read_count + capacity)
+                {
+                    overrun(write_count);
+                }
+            if (d_gap > 0)
+                {
+                    const auto n = static_cast<size_t>(std::min<uint64_t>(d_gap, max_items - written));
+                    std::memset(output + written * d_item_size, 0, n * d_item_size);
+                    d_gap -= n;
+                    written += n;
+                    continue;
+                }
+            if (write_count <= d_read_count)
+                {
+                    break;
+                }
+            const auto n = static_cast<size_t>(std::min<uint64_t>(write_count - d_read_count, max_items - written));
+            const auto position = static_cast<size_t>(d_read_count % capacity);
+            const size_t first_part = std::min<size_t>(n, static_cast<size_t>(capacity) - position);
+            std::memcpy(output + written * d_item_size, d_data + position * d_item_size, first_part * d_item_size);
+            std::memcpy(output + (written + first_part) * d_item_size, d_data, (n - first_part) * d_item_size);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const uint64_t write_begin = d_header->write_begin.load(std::memory_order_relaxed);
+            if (write_begin > d_read_count + capacity)
+                {
+                    // the writer overwrote some of the items while they were copied
+                    overrun(write_begin);
+                    write_count = d_header->write_count.load(std::memory_order_acquire);
+                    continue;
+                }
+            d_read_count += n;
+            written += n;
+        }
+    return written;
+}
+
+
+bool Gnss_Sample_Bus_Reader::finished() const
+{
+    return d_gap == 0 and d_header->closed.load(std::memory_order_acquire) != 0 and
+           d_read_count >= d_header->write_count.load(std::memory_order_acquire);
+}
+
+
+uint64_t Gnss_Sample_Bus_Reader::first_sample() const
+{
+    return d_header->first_sample.load(std::memory_order_relaxed) + d_start_count;
+}
+
+
+uint64_t Gnss_Sample_Bus_Reader::next_sample() const
+{
+    return d_header->first_sample.load(std::memory_order_relaxed) + d_read_count - d_gap;
+}
@@ -0,0 +1,173 @@
+/*!
+ * \file gnss_sample_bus.h
+ * \brief Shared memory ring of samples, written by one receiver and read by
+ * the other receivers of the same host
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SAMPLE_BUS_H
+#define GNSS_SDR_GNSS_SAMPLE_BUS_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_libs
+ * \{ */
+
+
+/*!
+ * \brief Layout of the beginning of the shared memory object of a sample
+ * bus. The items follow, from the offset data_offset, as a ring of capacity
+ * items.
+ *
+ * The item number n of the stream, whose sample stamp is first_sample + n,
+ * is at the position n % capacity of the ring. The writer never waits for
+ * the readers: it stores write_begin before copying new items, overwriting
+ * the oldest ones, and write_count once they are complete, so a reader can
+ * tell whether the items it copied were overwritten meanwhile.
+ */
+struct Gnss_Sample_Bus_Header
+{
+    static constexpr uint32_t MAGIC = 0x31425347;  // "GSB1"
+    static constexpr uint32_t VERSION = 1;
+
+    uint32_t magic;
+    uint32_t version;
+    uint32_t item_size;     // bytes
+    uint32_t data_offset;   // bytes from the beginning of the object
+    uint64_t capacity;      // items
+    std::atomic<uint64_t> first_sample;  // sample stamp of the first item of the stream, set by the first write
+    std::atomic<uint32_t> closed;
+    alignas(64) std::atomic<uint64_t> write_begin;  // items written, or being written
+    alignas(64) std::atomic<uint64_t> write_count;  // items written
+};
+
+
+/*!
+ * \brief Writes a stream of items to the shared memory object /name, so that
+ * any number of Gnss_Sample_Bus_Reader in other processes read it. Writing
+ * is a memcpy and two atomic stores, with no system calls, and it never
+ * waits for the readers. Throws std::runtime_error if the object cannot be
+ * created.
+ *
+ * The object is created, replacing any stale one with the same name, when
+ * the writer is constructed, and it is unlinked when the writer is
+ * destroyed. If huge_pages is true, the kernel is asked to back the ring with
+ * transparent huge pages (it does if
+ * /sys/kernel/mm/transparent_hugepage/shmem_enabled is advise or always), which
+ * removes most of the TLB misses of the readers and the writer when the ring
+ * takes hundreds of megabytes. Only one thread may write.
+ */
+class Gnss_Sample_Bus_Writer
+{
+public:
+    Gnss_Sample_Bus_Writer(const std::string& name, size_t item_size, uint64_t capacity, bool huge_pages = true);
+    ~Gnss_Sample_Bus_Writer();
+
+    Gnss_Sample_Bus_Writer(const Gnss_Sample_Bus_Writer&) = delete;
+    Gnss_Sample_Bus_Writer& operator=(const Gnss_Sample_Bus_Writer&) = delete;
+
+    /*!
+     * \brief Writes nitems items, the first one with the sample stamp
+     * first_sample. The stamps of consecutive writes must be contiguous: the
+     * stamp of the first write sets the one of the first item of the bus, and
+     * the later ones are only checked.
+     */
+    void write(const void* items, size_t nitems, uint64_t first_sample);
+
+    //! Tells the readers that the stream ended. The destructor does it too.
+    void close();
+
+    uint64_t written() const { return d_write_count; }  //!< Items written
+    bool huge_pages() const { return d_huge_pages; }    //!< Whether the kernel accepted the huge pages advice
+    uint64_t discontinuities() const { return d_discontinuities; }  //!< Writes whose stamp was not the expected one
+
+private:
+    std::string d_name;
+    void* d_map{nullptr};
+    size_t d_map_size{0};
+    Gnss_Sample_Bus_Header* d_header{nullptr};
+    uint8_t* d_data{nullptr};
+    size_t d_item_size;
+    uint64_t d_capacity;
+    uint64_t d_write_count{0};
+    uint64_t d_discontinuities{0};
+    bool d_huge_pages{false};
+};
+
+
+/*!
+ * \brief Reads the stream of items of a Gnss_Sample_Bus_Writer, from the
+ * newest item written when it is constructed. The object is mapped
+ * read-only, and each reader keeps its own position, so readers cannot
+ * disturb the writer or each other. Throws std::runtime_error if the object
+ * does not exist, is not a sample bus or its items are not of item_size
+ * bytes.
+ *
+ * A reader that falls more than the capacity of the ring behind the writer
+ * is overrun: it goes on from the newest item, and the items it missed are
+ * replaced by zeros, so the number of each output item keeps the same
+ * difference with its sample stamp, as with Gnss_Sample_Stream_Receiver. If
+ * more than max_gap_samples items are missed at once, they are skipped
+ * instead.
+ */
+class Gnss_Sample_Bus_Reader
+{
+public:
+    Gnss_Sample_Bus_Reader(const std::string& name, size_t item_size, uint64_t max_gap_samples);
+    ~Gnss_Sample_Bus_Reader();
+
+    Gnss_Sample_Bus_Reader(const Gnss_Sample_Bus_Reader&) = delete;
+    Gnss_Sample_Bus_Reader& operator=(const Gnss_Sample_Bus_Reader&) = delete;
+
+    /*!
+     * \brief Writes up to max_items items to out, and returns how many. It
+     * waits up to timeout_ms for new items, and returns 0 if none arrives.
+     */
+    size_t read(void* out, size_t max_items, int timeout_ms);
+
+    //! True once the writer closed the bus and all its items are read
+    bool finished() const;
+
+    uint64_t first_sample() const;  //!< Sample stamp of the first output item
+    uint64_t next_sample() const;   //!< Sample stamp of the next output item
+
+    uint64_t capacity() const { return d_header->capacity; }  //!< Items of the ring
+    uint64_t lost_samples() const { return d_lost_samples; }  //!< Items replaced by zeros or skipped
+    uint64_t overruns() const { return d_overruns; }          //!< Times the writer overtook the reader
+    uint64_t resyncs() const { return d_resyncs; }            //!< Overruns longer than max_gap_samples
+
+private:
+    void overrun(uint64_t write_count);
+
+    void* d_map{nullptr};
+    size_t d_map_size{0};
+    const Gnss_Sample_Bus_Header* d_header{nullptr};
+    const uint8_t* d_data{nullptr};
+    size_t d_item_size;
+    uint64_t d_start_count{0};  // number of the first item read
+    uint64_t d_read_count{0};   // number of the next item of the ring to read
+    uint64_t d_gap{0};          // zeros to write before it
+    uint64_t d_max_gap_samples;
+    uint64_t d_lost_samples{0};
+    uint64_t d_overruns{0};
+    uint64_t d_resyncs{0};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SAMPLE_BUS_H
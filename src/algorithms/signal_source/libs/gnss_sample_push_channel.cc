@@ -0,0 +1,169 @@
+/*!
+ * \file gnss_sample_push_channel.cc
+ * \brief Hands over the sample buffers of an application that embeds the
+ * receiver to the Sample_Push_Signal_Source, without copying them.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sample_push_channel.h"
+#include <algorithm>  // for min
+#include <chrono>
+#include <cstring>  // for memcpy
+#include <map>
+#include <utility>  // for move
+
+
+Gnss_Sample_Push_Channel::Gnss_Sample_Push_Channel(size_t max_buffers) : d_max_buffers(std::max<size_t>(max_buffers, 1))
+{
+    d_released.reserve(d_max_buffers);
+}
+
+
+std::shared_ptr<Gnss_Sample_Push_Channel> Gnss_Sample_Push_Channel::get(const std::string& name, size_t max_buffers)
+{
+    static std::mutex registry_mutex;
+    static std::map<std::string, std::weak_ptr<Gnss_Sample_Push_Channel>> registry;
+
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    for (auto it = registry.begin(); it != registry.end();)
+        {
+            if (it->second.expired())
+                {
+                    it = registry.erase(it);
+                }
+            else
+                {
+                    ++it;
+                }
+        }
+
+    auto channel = registry[name].lock();
+    if (!channel)
+        {
+            channel = std::make_shared<Gnss_Sample_Push_Channel>(max_buffers);
+            registry[name] = channel;
+        }
+    return channel;
+}
+
+
+bool Gnss_Sample_Push_Channel::push(const void* data, size_t bytes, Release_Callback release)
+{
+    std::unique_lock<std::mutex> lock(d_mutex);
+    d_not_full.wait(lock, [this] { return d_closed or d_buffers.size() < d_max_buffers; });
+    if (d_closed)
+        {
+            return false;
+        }
+    d_buffers.push_back(Buffer{static_cast<const uint8_t*>(data), bytes, std::move(release)});
+    d_queued_bytes += bytes;
+    d_pushed_bytes += bytes;
+    lock.unlock();
+    d_not_empty.notify_one();
+    return true;
+}
+
+
+void Gnss_Sample_Push_Channel::close()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_closed = true;
+    }
+    d_not_empty.notify_all();
+    d_not_full.notify_all();
+}
+
+
+size_t Gnss_Sample_Push_Channel::read(void* out, size_t max_items, size_t item_size, int timeout_ms)
+{
+    size_t nitems = 0;
+    bool popped = false;
+    {
+        std::unique_lock<std::mutex> lock(d_mutex);
+        d_not_empty.wait_for(lock, std::chrono::milliseconds(timeout_ms), [this, item_size] { return d_closed or d_queued_bytes >= item_size; });
+        nitems = std::min(max_items, d_queued_bytes / item_size);
+        // an incomplete item at the end of the stream is dropped
+        const bool drop_tail = (nitems == 0 and d_closed);
+        size_t remaining = (drop_tail ? d_queued_bytes : nitems * item_size);
+
+        // the items can straddle the buffers
+        auto* dest = static_cast<uint8_t*>(out);
+        while (!d_buffers.empty() and (remaining > 0 or d_consumed == d_buffers.front().bytes))
+            {
+                Buffer& front = d_buffers.front();
+                const size_t bytes = std::min(remaining, front.bytes - d_consumed);
+                if (!drop_tail)
+                    {
+                        std::memcpy(dest, front.data + d_consumed, bytes);
+                        dest += bytes;
+                    }
+                d_consumed += bytes;
+                d_queued_bytes -= bytes;
+                remaining -= bytes;
+                if (d_consumed == front.bytes)
+                    {
+                        if (front.release)
+                            {
+                                d_released.push_back(std::move(front.release));
+                            }
+                        d_buffers.pop_front();
+                        d_consumed = 0;
+                        popped = true;
+                    }
+            }
+    }
+    if (popped)
+        {
+            d_not_full.notify_all();
+            for (auto& release : d_released)
+                {
+                    release();
+                }
+            d_released.clear();
+        }
+    return nitems;
+}
+
+
+bool Gnss_Sample_Push_Channel::finished() const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_closed and d_buffers.empty();
+}
+
+
+void Gnss_Sample_Push_Channel::flush()
+{
+    std::deque<Buffer> buffers;
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        buffers.swap(d_buffers);
+        d_consumed = 0;
+        d_queued_bytes = 0;
+    }
+    d_not_full.notify_all();
+    for (auto& buffer : buffers)
+        {
+            if (buffer.release)
+                {
+                    buffer.release();
+                }
+        }
+}
+
+
+uint64_t Gnss_Sample_Push_Channel::pushed_bytes() const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_pushed_bytes;
+}
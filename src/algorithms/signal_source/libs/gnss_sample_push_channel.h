@@ -0,0 +1,115 @@
+/*!
+ * \file gnss_sample_push_channel.h
+ * \brief Hands over the sample buffers of an application that embeds the
+ * receiver to the Sample_Push_Signal_Source, without copying them.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SAMPLE_PUSH_CHANNEL_H
+#define GNSS_SDR_GNSS_SAMPLE_PUSH_CHANNEL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_libs
+ * \{ */
+
+
+/*!
+ * \brief Queue of sample buffers pushed by an application, and read by the
+ * signal source of a receiver running in the same process.
+ *
+ * The buffers are not copied when they are pushed: the source reads the
+ * samples straight from them into its output buffer, and calls the release
+ * callback of each buffer once all its bytes are read, so the application
+ * can reuse it. Up to max_buffers buffers wait in the queue; push() waits
+ * for room, which paces an application that pushes faster than the receiver
+ * processes. Channels are shared by name, as long as someone holds them.
+ */
+class Gnss_Sample_Push_Channel
+{
+public:
+    using Release_Callback = std::function<void()>;
+
+    explicit Gnss_Sample_Push_Channel(size_t max_buffers = 64);
+
+    /*!
+     * \brief Returns the channel registered as name, creating it if there is
+     * none
+     */
+    static std::shared_ptr<Gnss_Sample_Push_Channel> get(const std::string& name, size_t max_buffers = 64);
+
+    /*!
+     * \brief Queues bytes bytes at data, which must stay valid until release
+     * is called, from the thread of the source. It waits while the queue is
+     * full, and returns false, without calling release, if the channel is
+     * closed.
+     */
+    bool push(const void* data, size_t bytes, Release_Callback release = nullptr);
+
+    /*!
+     * \brief Ends the stream: the source finishes after the queued buffers
+     */
+    void close();
+
+    /*!
+     * \brief Copies up to max_items whole items from the queued buffers to
+     * out, and returns how many. It waits up to timeout_ms for samples, and
+     * returns 0 if none arrives.
+     */
+    size_t read(void* out, size_t max_items, size_t item_size, int timeout_ms);
+
+    /*!
+     * \brief True once the channel is closed and all its items are read
+     */
+    bool finished() const;
+
+    /*!
+     * \brief Releases the queued buffers without reading them
+     */
+    void flush();
+
+    uint64_t pushed_bytes() const;  //!< Bytes pushed since the channel was created
+
+private:
+    struct Buffer
+    {
+        const uint8_t* data;
+        size_t bytes;
+        Release_Callback release;
+    };
+
+    mutable std::mutex d_mutex;
+    std::condition_variable d_not_empty;
+    std::condition_variable d_not_full;
+    std::deque<Buffer> d_buffers;
+    std::vector<Release_Callback> d_released;  // read by the reader, called out of the lock
+    size_t d_max_buffers;
+    size_t d_consumed{0};      // bytes of the front buffer already read
+    size_t d_queued_bytes{0};  // bytes of the queue not read yet
+    uint64_t d_pushed_bytes{0};
+    bool d_closed{false};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SAMPLE_PUSH_CHANNEL_H
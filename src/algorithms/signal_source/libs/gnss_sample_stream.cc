@@ -0,0 +1,306 @@
+/*!
+ * \file gnss_sample_stream.cc
+ * \brief Sends and receives blocks of samples, stamped with their sample
+ * number, in UDP datagrams.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sample_stream.h"
+#include <arpa/inet.h>   // for inet_pton, htons
+#include <glog/logging.h>
+#include <poll.h>        // for poll
+#include <sys/socket.h>  // for socket, sendto, recv, setsockopt
+#include <unistd.h>      // for close
+#include <algorithm>     // for std::min, std::max
+#include <cerrno>
+#include <cstring>  // for memcpy, memset, strerror
+#include <stdexcept>
+
+
+namespace
+{
+constexpr uint8_t STREAM_VERSION = 1;
+
+// The fields are copied in the byte order of the host, which is little-endian
+// in all the platforms supported
+template <typename T>
+void put(uint8_t* buffer, size_t position, T value)
+{
+    std::memcpy(buffer + position, &value, sizeof(T));
+}
+
+
+template <typename T>
+T get(const uint8_t* buffer, size_t position)
+{
+    T value;
+    std::memcpy(&value, buffer + position, sizeof(T));
+    return value;
+}
+
+
+in_addr parse_address(const std::string& address)
+{
+    in_addr parsed{};
+    if (inet_pton(AF_INET, address.c_str(), &parsed) != 1)
+        {
+            throw std::runtime_error("Invalid IPv4 address for a sample stream: " + address);
+        }
+    return parsed;
+}
+
+
+int open_socket()
+{
+    const int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0)
+        {
+            throw std::runtime_error(std::string("Cannot open the socket of a sample stream: ") + std::strerror(errno));
+        }
+    return fd;
+}
+}  // namespace
+
+
+void Gnss_Sample_Stream_Header::encode(uint8_t* buffer) const
+{
+    put<uint32_t>(buffer, 0, MAGIC);
+    put<uint8_t>(buffer, 4, STREAM_VERSION);
+    put<uint8_t>(buffer, 5, 0);
+    put<uint16_t>(buffer, 6, item_size);
+    put<uint32_t>(buffer, 8, sequence);
+    put<uint32_t>(buffer, 12, items);
+    put<uint64_t>(buffer, 16, first_sample);
+}
+
+
+bool Gnss_Sample_Stream_Header::decode(const uint8_t* buffer, size_t bytes)
+{
+    if (bytes < SIZE or get<uint32_t>(buffer, 0) != MAGIC or get<uint8_t>(buffer, 4) != STREAM_VERSION)
+        {
+            return false;
+        }
+    item_size = get<uint16_t>(buffer, 6);
+    sequence = get<uint32_t>(buffer, 8);
+    items = get<uint32_t>(buffer, 12);
+    first_sample = get<uint64_t>(buffer, 16);
+    return bytes >= SIZE + static_cast<size_t>(items) * item_size;
+}
+
+
+Gnss_Sample_Stream_Sender::Gnss_Sample_Stream_Sender(const std::string& address,
+    uint16_t port,
+    size_t item_size,
+    size_t payload_bytes,
+    int multicast_ttl)
+    : d_item_size(item_size),
+      d_items_per_datagram(std::max<size_t>(1, payload_bytes / std::max<size_t>(1, item_size))),
+      d_socket(-1)
+{
+    if (item_size == 0 or item_size > 65535)
+        {
+            throw std::runtime_error("Invalid item size for a sample stream: " + std::to_string(item_size));
+        }
+    d_destination.sin_family = AF_INET;
+    d_destination.sin_port = htons(port);
+    d_destination.sin_addr = parse_address(address);
+    d_socket = open_socket();
+    if (IN_MULTICAST(ntohl(d_destination.sin_addr.s_addr)))
+        {
+            const auto ttl = static_cast<unsigned char>(std::min(std::max(multicast_ttl, 0), 255));
+            if (setsockopt(d_socket, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl)) != 0)
+                {
+                    LOG(WARNING) << "Cannot set the multicast TTL of the sample stream to " << address << ": " << std::strerror(errno);
+                }
+        }
+    d_datagram.resize(Gnss_Sample_Stream_Header::SIZE + d_items_per_datagram * d_item_size);
+}
+
+
+Gnss_Sample_Stream_Sender::~Gnss_Sample_Stream_Sender()
+{
+    if (d_socket >= 0)
+        {
+            close(d_socket);
+        }
+}
+
+
+void Gnss_Sample_Stream_Sender::send(const void* items, size_t nitems, uint64_t first_sample)
+{
+    const auto* in = static_cast<const uint8_t*>(items);
+    Gnss_Sample_Stream_Header header;
+    header.item_size = static_cast<uint16_t>(d_item_size);
+    for (size_t sent = 0; sent < nitems; sent += header.items)
+        {
+            header.sequence = d_sequence++;
+            header.items = static_cast<uint32_t>(std::min(d_items_per_datagram, nitems - sent));
+            header.first_sample = first_sample + sent;
+            header.encode(d_datagram.data());
+            const size_t payload = static_cast<size_t>(header.items) * d_item_size;
+            std::memcpy(d_datagram.data() + Gnss_Sample_Stream_Header::SIZE, in + sent * d_item_size, payload);
+            if (sendto(d_socket, d_datagram.data(), Gnss_Sample_Stream_Header::SIZE + payload, 0,
+                    reinterpret_cast<const sockaddr*>(&d_destination), sizeof(d_destination)) < 0)
+                {
+                    if (d_errors++ == 0)
+                        {
+                            LOG(WARNING) << "Cannot send a datagram of the sample stream: " << std::strerror(errno);
+                        }
+                }
+        }
+}
+
+
+Gnss_Sample_Stream_Receiver::Gnss_Sample_Stream_Receiver(const std::string& address,
+    uint16_t port,
+    size_t item_size,
+    uint64_t max_gap_samples,
+    int receive_buffer_bytes,
+    const std::string& interface_address)
+    : d_item_size(item_size),
+      d_max_gap_samples(max_gap_samples),
+      d_socket(-1)
+{
+    if (item_size == 0 or item_size > 65535)
+        {
+            throw std::runtime_error("Invalid item size for a sample stream: " + std::to_string(item_size));
+        }
+    const in_addr group = parse_address(address);
+    d_socket = open_socket();
+    const int reuse = 1;
+    setsockopt(d_socket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    if (receive_buffer_bytes > 0 and setsockopt(d_socket, SOL_SOCKET, SO_RCVBUF, &receive_buffer_bytes, sizeof(receive_buffer_bytes)) != 0)
+        {
+            LOG(WARNING) << "Cannot set the receive buffer of the sample stream to " << receive_buffer_bytes << " bytes";
+        }
+
+    sockaddr_in local{};
+    local.sin_family = AF_INET;
+    local.sin_port = htons(port);
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (bind(d_socket, reinterpret_cast<const sockaddr*>(&local), sizeof(local)) != 0)
+        {
+            const std::string error(std::strerror(errno));
+            close(d_socket);
+            throw std::runtime_error("Cannot bind the sample stream to port " + std::to_string(port) + ": " + error);
+        }
+
+    if (IN_MULTICAST(ntohl(group.s_addr)))
+        {
+            ip_mreq membership{};
+            membership.imr_multiaddr = group;
+            membership.imr_interface.s_addr = interface_address.empty() ? htonl(INADDR_ANY) : parse_address(interface_address).s_addr;
+            if (setsockopt(d_socket, IPPROTO_IP, IP_ADD_MEMBERSHIP, &membership, sizeof(membership)) != 0)
+                {
+                    const std::string error(std::strerror(errno));
+                    close(d_socket);
+                    throw std::runtime_error("Cannot join the multicast group " + address + " of the sample stream: " + error);
+                }
+        }
+    d_datagram.resize(65536);
+}
+
+
+Gnss_Sample_Stream_Receiver::~Gnss_Sample_Stream_Receiver()
+{
+    if (d_socket >= 0)
+        {
+            close(d_socket);
+        }
+}
+
+
+bool Gnss_Sample_Stream_Receiver::receive(int timeout_ms)
+{
+    pollfd event{};
+    event.fd = d_socket;
+    event.events = POLLIN;
+    while (poll(&event, 1, timeout_ms) > 0)
+        {
+            timeout_ms = 0;
+            const auto bytes = recv(d_socket, d_datagram.data(), d_datagram.size(), MSG_DONTWAIT);
+            if (bytes <= 0)
+                {
+                    continue;
+                }
+            if (!d_header.decode(d_datagram.data(), static_cast<size_t>(bytes)) or d_header.item_size != d_item_size or d_header.items == 0)
+                {
+                    d_late_datagrams++;
+                    continue;
+                }
+            if (!d_started)
+                {
+                    d_started = true;
+                    d_first_sample = d_header.first_sample;
+                    d_next_sample = d_header.first_sample;
+                }
+            if (d_header.first_sample + d_header.items <= d_next_sample)
+                {
+                    d_late_datagrams++;
+                    continue;
+                }
+            d_consumed = 0;
+            d_gap = 0;
+            if (d_header.first_sample < d_next_sample)
+                {
+                    d_consumed = static_cast<size_t>(d_next_sample - d_header.first_sample);
+                }
+            else
+                {
+                    d_gap = d_header.first_sample - d_next_sample;
+                    d_lost_samples += d_gap;
+                    if (d_gap > d_max_gap_samples)
+                        {
+                            d_resyncs++;
+                            LOG(WARNING) << "Sample stream: " << d_gap << " samples lost after sample "
+                                         << d_next_sample << ", the stream goes on from sample " << d_header.first_sample;
+                            d_next_sample = d_header.first_sample;
+                            d_gap = 0;
+                        }
+                }
+            d_pending = true;
+            return true;
+        }
+    return false;
+}
+
+
+size_t Gnss_Sample_Stream_Receiver::read(void* out, size_t max_items, int timeout_ms)
+{
+    auto* output = static_cast<uint8_t*>(out);
+    size_t written = 0;
+    while (written < max_items)
+        {
+            if (!d_pending and !receive(written == 0 ? timeout_ms : 0))
+                {
+                    break;
+                }
+            size_t n;
+            if (d_gap > 0)
+                {
+                    n = static_cast<size_t>(std::min<uint64_t>(d_gap, max_items - written));
+                    std::memset(output + written * d_item_size, 0, n * d_item_size);
+                    d_gap -= n;
+                }
+            else
+                {
+                    n = std::min<size_t>(d_header.items - d_consumed, max_items - written);
+                    std::memcpy(output + written * d_item_size,
+                        d_datagram.data() + Gnss_Sample_Stream_Header::SIZE + d_consumed * d_item_size, n * d_item_size);
+                    d_consumed += n;
+                    d_pending = d_consumed < d_header.items;
+                }
+            written += n;
+            d_next_sample += n;
+        }
+    return written;
+}
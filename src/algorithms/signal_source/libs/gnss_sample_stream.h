@@ -0,0 +1,134 @@
+/*!
+ * \file gnss_sample_stream.h
+ * \brief Sends and receives blocks of samples, stamped with their sample
+ * number, in UDP datagrams.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SAMPLE_STREAM_H
+#define GNSS_SDR_GNSS_SAMPLE_STREAM_H
+
+#include <netinet/in.h>  // for sockaddr_in
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_libs
+ * \{ */
+
+
+/*!
+ * \brief Header of each datagram of a sample stream. It takes 24 bytes, in
+ * little-endian, and it is followed by the items.
+ */
+struct Gnss_Sample_Stream_Header
+{
+    static constexpr uint32_t MAGIC = 0x31535347;  //!< "GSS1"
+    static constexpr size_t SIZE = 24;             //!< Bytes of the header
+
+    uint32_t sequence{0};      //!< Number of the datagram
+    uint32_t items{0};         //!< Items in the datagram
+    uint64_t first_sample{0};  //!< Number of the first item in the stream of the sender
+    uint16_t item_size{0};     //!< Bytes per item
+
+    void encode(uint8_t* buffer) const;
+
+    //! Returns false if buffer is not the header of a sample stream datagram
+    bool decode(const uint8_t* buffer, size_t bytes);
+};
+
+
+/*!
+ * \brief Sends a stream of items to a unicast or multicast UDP address, in
+ * datagrams of up to payload_bytes bytes of items. Throws
+ * std::runtime_error if the socket cannot be opened.
+ */
+class Gnss_Sample_Stream_Sender
+{
+public:
+    Gnss_Sample_Stream_Sender(const std::string& address, uint16_t port, size_t item_size, size_t payload_bytes = 1440, int multicast_ttl = 1);
+    ~Gnss_Sample_Stream_Sender();
+
+    //! Sends nitems items, the first one being the item number first_sample of the stream
+    void send(const void* items, size_t nitems, uint64_t first_sample);
+
+    uint64_t datagrams() const { return d_sequence; }  //!< Datagrams sent
+    uint64_t errors() const { return d_errors; }       //!< Datagrams that could not be sent
+
+private:
+    std::vector<uint8_t> d_datagram;
+    sockaddr_in d_destination{};
+    size_t d_item_size;
+    size_t d_items_per_datagram;
+    uint64_t d_errors{0};
+    uint32_t d_sequence{0};
+    int d_socket;
+};
+
+
+/*!
+ * \brief Receives the stream of items of a Gnss_Sample_Stream_Sender, on a
+ * UDP port and, if address is a multicast group, as a member of the group.
+ * Throws std::runtime_error if the socket cannot be opened.
+ *
+ * The output starts with the first datagram received. The items of the
+ * datagrams lost afterwards are replaced by zeros, so the number of each
+ * output item keeps the same difference with its number in the stream of
+ * the sender, and the tracking loops of the receivers of a stream coast over
+ * the losses instead of slipping. If more than max_gap_samples items are
+ * lost at once, the stream goes on from the next datagram. Late or repeated
+ * datagrams are dropped.
+ */
+class Gnss_Sample_Stream_Receiver
+{
+public:
+    Gnss_Sample_Stream_Receiver(const std::string& address, uint16_t port, size_t item_size,
+        uint64_t max_gap_samples, int receive_buffer_bytes = 8388608, const std::string& interface_address = std::string(""));
+    ~Gnss_Sample_Stream_Receiver();
+
+    /*!
+     * \brief Writes up to max_items items to out, and returns how many. It
+     * waits up to timeout_ms for a datagram, and returns 0 if none arrives.
+     */
+    size_t read(void* out, size_t max_items, int timeout_ms);
+
+    uint64_t first_sample() const { return d_first_sample; }      //!< Number in the stream of the sender of the first output item
+    uint64_t lost_samples() const { return d_lost_samples; }      //!< Items replaced by zeros or skipped
+    uint64_t late_datagrams() const { return d_late_datagrams; }  //!< Datagrams dropped
+    uint64_t resyncs() const { return d_resyncs; }                //!< Gaps longer than max_gap_samples
+
+private:
+    bool receive(int timeout_ms);
+
+    std::vector<uint8_t> d_datagram;
+    Gnss_Sample_Stream_Header d_header;
+    size_t d_item_size;
+    size_t d_consumed{0};     // items of d_datagram already written
+    uint64_t d_next_sample{0};  // number, in the stream of the sender, of the next output item
+    uint64_t d_gap{0};          // zeros to write before the items of d_datagram
+    uint64_t d_max_gap_samples;
+    uint64_t d_first_sample{0};
+    uint64_t d_lost_samples{0};
+    uint64_t d_late_datagrams{0};
+    uint64_t d_resyncs{0};
+    int d_socket;
+    bool d_started{false};
+    bool d_pending{false};  // d_datagram has items to write
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SAMPLE_STREAM_H
@@ -0,0 +1,208 @@
+/*!
+ * \file gnss_sdr_ingest_monitor.cc
+ * \brief GNU Radio block that detects the samples lost by a signal source,
+ * from the rx_time tags of its RF channels.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_ingest_monitor.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>  // for io_signature
+#include <cmath>                    // for llround, fabs
+#include <iostream>
+#include <utility>
+
+
+gnss_shared_ptr<Gnss_Sdr_Ingest_Monitor> gnss_sdr_make_ingest_monitor(size_t sizeof_stream_item,
+    unsigned int rf_channels,
+    double sampling_frequency,
+    std::string role,
+    double host_clock_tolerance_s)
+{
+    gnss_shared_ptr<Gnss_Sdr_Ingest_Monitor> monitor(new Gnss_Sdr_Ingest_Monitor(sizeof_stream_item, rf_channels, sampling_frequency, std::move(role), host_clock_tolerance_s));
+    return monitor;
+}
+
+
+Gnss_Sdr_Ingest_Monitor::Gnss_Sdr_Ingest_Monitor(size_t sizeof_stream_item,
+    unsigned int rf_channels,
+    double sampling_frequency,
+    std::string role,
+    double host_clock_tolerance_s)
+    : gr::sync_block("Ingest_Monitor",
+          gr::io_signature::make(static_cast<int>(rf_channels), static_cast<int>(rf_channels), sizeof_stream_item),
+          gr::io_signature::make(0, 0, 0)),
+      d_clocks(rf_channels),
+      d_role(std::move(role)),
+      d_rx_time_key(pmt::mp("rx_time")),
+      d_fs(sampling_frequency),
+      d_max_skew_s(0.0),
+      d_host_clock_tolerance_s(host_clock_tolerance_s),
+      d_host_started(false)
+{
+}
+
+
+void Gnss_Sdr_Ingest_Monitor::process_tag(unsigned int rf_channel, uint64_t item, double time_s)
+{
+    Channel_Clock& clock = d_clocks[rf_channel];
+    if (clock.valid)
+        {
+            const double expected_time_s = clock.tag_time_s + static_cast<double>(item - clock.tag_item) / d_fs;
+            const int64_t lost = std::llround((time_s - expected_time_s) * d_fs);
+            if (lost > 0)
+                {
+                    clock.overflows++;
+                    clock.lost_samples += static_cast<uint64_t>(lost);
+                    LOG(WARNING) << d_role << " RF channel " << rf_channel << ": " << lost
+                                 << " samples lost before sample " << item;
+                }
+        }
+    clock.tag_item = item;
+    clock.tag_time_s = time_s;
+    clock.start_time_s = time_s - static_cast<double>(item) / d_fs;
+    clock.valid = true;
+
+    // skew of the RF channels with respect to the first one
+    if (d_clocks[0].valid)
+        {
+            for (unsigned int ch = 1; ch < d_clocks.size(); ch++)
+                {
+                    if (d_clocks[ch].valid)
+                        {
+                            const double skew_s = std::fabs(d_clocks[ch].start_time_s - d_clocks[0].start_time_s);
+                            if (skew_s > d_max_skew_s)
+                                {
+                                    d_max_skew_s = skew_s;
+                                }
+                        }
+                }
+        }
+}
+
+
+void Gnss_Sdr_Ingest_Monitor::check_host_clock(unsigned int rf_channel, uint64_t items, double elapsed_s)
+{
+    // a delay that grows beyond the buffering is made of lost samples
+    Channel_Clock& clock = d_clocks[rf_channel];
+    const int64_t lost = std::llround((elapsed_s - d_host_clock_tolerance_s) * d_fs) - static_cast<int64_t>(items - clock.host_start_item + clock.lost_samples);
+    if (lost > 0)
+        {
+            if (!clock.behind_host_clock)
+                {
+                    clock.overflows++;
+                    LOG(WARNING) << d_role << " RF channel " << rf_channel << ": samples lost before sample " << items
+                                 << ", " << elapsed_s - static_cast<double>(items - clock.host_start_item) / d_fs << " s behind the host clock";
+                }
+            clock.lost_samples += static_cast<uint64_t>(lost);
+            clock.behind_host_clock = true;
+        }
+    else
+        {
+            clock.behind_host_clock = false;
+        }
+}
+
+
+int Gnss_Sdr_Ingest_Monitor::work(int noutput_items,
+    gr_vector_const_void_star& input_items,
+    gr_vector_void_star& output_items __attribute__((unused)))
+{
+    for (unsigned int ch = 0; ch < input_items.size(); ch++)
+        {
+            const uint64_t first_item = nitems_read(ch);
+            get_tags_in_range(d_tags, ch, first_item, first_item + noutput_items, d_rx_time_key);
+            for (const auto& tag : d_tags)
+                {
+                    // rx_time is a tuple of the integer seconds and the fractional seconds
+                    if (pmt::is_tuple(tag.value) and pmt::length(tag.value) == 2)
+                        {
+                            const double time_s = static_cast<double>(pmt::to_uint64(pmt::tuple_ref(tag.value, 0))) +
+                                                  pmt::to_double(pmt::tuple_ref(tag.value, 1));
+                            process_tag(ch, tag.offset, time_s);
+                        }
+                }
+        }
+
+    if (d_host_clock_tolerance_s > 0.0)
+        {
+            const auto now = std::chrono::steady_clock::now();
+            if (!d_host_started)
+                {
+                    // the host clock starts with the first samples received
+                    d_host_start = now;
+                    d_host_started = true;
+                    for (unsigned int ch = 0; ch < input_items.size(); ch++)
+                        {
+                            d_clocks[ch].host_start_item = nitems_read(ch) + noutput_items;
+                        }
+                }
+            else
+                {
+                    const double elapsed_s = std::chrono::duration<double>(now - d_host_start).count();
+                    for (unsigned int ch = 0; ch < input_items.size(); ch++)
+                        {
+                            check_host_clock(ch, nitems_read(ch) + noutput_items, elapsed_s);
+                        }
+                }
+        }
+    return noutput_items;
+}
+
+
+bool Gnss_Sdr_Ingest_Monitor::stop()
+{
+    for (unsigned int ch = 0; ch < d_clocks.size(); ch++)
+        {
+            if (d_clocks[ch].overflows > 0)
+                {
+                    std::cout << d_role << " RF channel " << ch << ": " << d_clocks[ch].overflows << " overflows, "
+                              << d_clocks[ch].lost_samples << " samples lost\n";
+                }
+            LOG(INFO) << d_role << " RF channel " << ch << ": " << d_clocks[ch].overflows << " overflows, "
+                      << d_clocks[ch].lost_samples << " samples lost";
+        }
+    if (d_clocks.size() > 1)
+        {
+            LOG(INFO) << d_role << ": maximum skew between RF channels " << d_max_skew_s << " s";
+        }
+    return true;
+}
+
+
+uint64_t Gnss_Sdr_Ingest_Monitor::get_overflows(unsigned int rf_channel) const
+{
+    return d_clocks.at(rf_channel).overflows;
+}
+
+
+uint64_t Gnss_Sdr_Ingest_Monitor::get_lost_samples(unsigned int rf_channel) const
+{
+    return d_clocks.at(rf_channel).lost_samples;
+}
+
+
+uint64_t Gnss_Sdr_Ingest_Monitor::get_lost_samples() const
+{
+    uint64_t lost_samples = 0;
+    for (const auto& clock : d_clocks)
+        {
+            lost_samples += clock.lost_samples;
+        }
+    return lost_samples;
+}
+
+
+double Gnss_Sdr_Ingest_Monitor::get_max_skew_s() const
+{
+    return d_max_skew_s;
+}
@@ -0,0 +1,125 @@
+/*!
+ * \file gnss_sdr_ingest_monitor.h
+ * \brief GNU Radio block that detects the samples lost by a signal source,
+ * from the rx_time tags of its RF channels.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SDR_INGEST_MONITOR_H
+#define GNSS_SDR_GNSS_SDR_INGEST_MONITOR_H
+
+#include "gnss_block_interface.h"
+#include <gnuradio/sync_block.h>  // for sync_block
+#include <gnuradio/types.h>       // for gr_vector_const_void_star
+#include <pmt/pmt.h>
+#include <chrono>
+#include <cstddef>  // for size_t
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_libs
+ * \{ */
+
+
+class Gnss_Sdr_Ingest_Monitor;
+
+gnss_shared_ptr<Gnss_Sdr_Ingest_Monitor> gnss_sdr_make_ingest_monitor(
+    size_t sizeof_stream_item,
+    unsigned int rf_channels,
+    double sampling_frequency,
+    std::string role,
+    double host_clock_tolerance_s = 0.0);
+
+
+/*!
+ * \brief Sink connected, next to the signal conditioners, to the outputs of
+ * a signal source whose device timestamps the samples with rx_time tags, as
+ * the UHD source does after the start and after each overflow.
+ *
+ * The time of each tag is compared with the time expected from the number of
+ * samples received since the previous tag, so the overflows of every RF
+ * channel are counted with the number of samples lost, instead of showing up
+ * later as a loss of lock. The time of the first sample of each RF channel,
+ * shared by all the channels of a synchronized device, is compared with the
+ * one of the first RF channel to report their maximum skew.
+ *
+ * The devices that do not timestamp their samples, such as the IIO sources
+ * (PlutoSDR, FMCOMMS2), drop them silently when their kernel buffers
+ * overflow. With a host_clock_tolerance_s greater than zero, the samples
+ * received are also compared with the time elapsed in the host since the
+ * first one, and the delay beyond that tolerance, which must cover the
+ * buffering of the device and of the flowgraph, is counted as lost.
+ */
+class Gnss_Sdr_Ingest_Monitor : public gr::sync_block
+{
+public:
+    int work(int noutput_items,
+        gr_vector_const_void_star& input_items,
+        gr_vector_void_star& output_items);
+
+    /*!
+     * \brief Reports the overflows of each RF channel.
+     */
+    bool stop();
+
+    uint64_t get_overflows(unsigned int rf_channel) const;     //!< Number of discontinuities of the timestamps
+    uint64_t get_lost_samples(unsigned int rf_channel) const;  //!< Number of samples lost in them
+    uint64_t get_lost_samples() const;                         //!< Number of samples lost in all the RF channels
+    double get_max_skew_s() const;                             //!< Maximum skew between the RF channels, in seconds
+
+private:
+    friend gnss_shared_ptr<Gnss_Sdr_Ingest_Monitor> gnss_sdr_make_ingest_monitor(
+        size_t sizeof_stream_item,
+        unsigned int rf_channels,
+        double sampling_frequency,
+        std::string role,
+        double host_clock_tolerance_s);
+
+    Gnss_Sdr_Ingest_Monitor(size_t sizeof_stream_item,
+        unsigned int rf_channels,
+        double sampling_frequency,
+        std::string role,
+        double host_clock_tolerance_s);
+
+    struct Channel_Clock
+    {
+        uint64_t tag_item{0};      // item of the last rx_time tag
+        double tag_time_s{0.0};    // and its time
+        double start_time_s{0.0};  // time of the item 0, from the last tag
+        uint64_t overflows{0};
+        uint64_t lost_samples{0};
+        bool valid{false};
+        uint64_t host_start_item{0};  // items received when the host clock started
+        bool behind_host_clock{false};
+    };
+
+    void process_tag(unsigned int rf_channel, uint64_t item, double time_s);
+    void check_host_clock(unsigned int rf_channel, uint64_t items, double elapsed_s);
+
+    std::vector<Channel_Clock> d_clocks;
+    std::vector<gr::tag_t> d_tags;
+    std::string d_role;
+    pmt::pmt_t d_rx_time_key;
+    std::chrono::steady_clock::time_point d_host_start;
+    double d_fs;
+    double d_max_skew_s;
+    double d_host_clock_tolerance_s;
+    bool d_host_started;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SDR_INGEST_MONITOR_H
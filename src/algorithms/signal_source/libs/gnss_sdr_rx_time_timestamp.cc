@@ -0,0 +1,122 @@
+/*!
+ * \file gnss_sdr_rx_time_timestamp.cc
+ * \brief GNU Radio block that turns the hardware timestamps (rx_time tags)
+ * of a signal source into the GnssTime time tags read by the tracking blocks.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_rx_time_timestamp.h"
+#include <gnuradio/io_signature.h>  // for io_signature
+#include <pmt/pmt_sugar.h>          // for mp
+#include <algorithm>                // for max
+#include <cmath>                    // for floor, llround
+#include <cstring>                  // for memcpy
+#include <memory>
+
+
+namespace
+{
+const double GPS_WEEK_S = 604800.0;
+}
+
+
+gnss_shared_ptr<Gnss_Sdr_Rx_Time_Timestamp> gnss_sdr_make_rx_time_timestamp(size_t sizeof_stream_item,
+    double sampling_frequency,
+    double clock_offset_s,
+    double period_ms)
+{
+    gnss_shared_ptr<Gnss_Sdr_Rx_Time_Timestamp> timestamp(new Gnss_Sdr_Rx_Time_Timestamp(sizeof_stream_item, sampling_frequency, clock_offset_s, period_ms));
+    return timestamp;
+}
+
+
+Gnss_Sdr_Rx_Time_Timestamp::Gnss_Sdr_Rx_Time_Timestamp(size_t sizeof_stream_item,
+    double sampling_frequency,
+    double clock_offset_s,
+    double period_ms)
+    : gr::sync_block("Rx_Time_Timestamp",
+          gr::io_signature::make(1, 20, sizeof_stream_item),
+          gr::io_signature::make(1, 20, sizeof_stream_item)),
+      d_rx_time_key(pmt::mp("rx_time")),
+      d_timetag_key(pmt::mp("timetag")),
+      d_fs(sampling_frequency),
+      d_clock_offset_s(clock_offset_s),
+      d_period_items(std::max<uint64_t>(static_cast<uint64_t>(std::llround(period_ms * 1e-3 * sampling_frequency)), 1))
+{
+}
+
+
+GnssTime Gnss_Sdr_Rx_Time_Timestamp::gps_time(double time_s)
+{
+    GnssTime time{};
+    time.rx_time = time_s;
+    time.week = static_cast<int>(std::floor(time_s / GPS_WEEK_S));
+    const double tow_ms = (time_s - static_cast<double>(time.week) * GPS_WEEK_S) * 1000.0;
+    time.tow_ms = static_cast<int>(std::floor(tow_ms));
+    time.tow_ms_fraction = tow_ms - static_cast<double>(time.tow_ms);
+    return time;
+}
+
+
+void Gnss_Sdr_Rx_Time_Timestamp::add_time_tag(unsigned int port, uint64_t item, double time_s)
+{
+    const std::shared_ptr<GnssTime> time = std::make_shared<GnssTime>(gps_time(time_s + d_clock_offset_s));
+    add_item_tag(port, item, d_timetag_key, pmt::make_any(time));
+}
+
+
+void Gnss_Sdr_Rx_Time_Timestamp::add_extrapolated_tags(unsigned int port, uint64_t end_item)
+{
+    Port_Clock& clock = d_clocks[port];
+    while (clock.valid and clock.next_item < end_item)
+        {
+            add_time_tag(port, clock.next_item, clock.tag_time_s + static_cast<double>(clock.next_item - clock.tag_item) / d_fs);
+            clock.next_item += d_period_items;
+        }
+}
+
+
+int Gnss_Sdr_Rx_Time_Timestamp::work(int noutput_items,
+    gr_vector_const_void_star& input_items,
+    gr_vector_void_star& output_items)
+{
+    if (d_clocks.size() < output_items.size())
+        {
+            d_clocks.resize(output_items.size());
+        }
+    for (unsigned int ch = 0; ch < output_items.size(); ch++)
+        {
+            std::memcpy(output_items[ch], input_items[ch], noutput_items * input_signature()->sizeof_stream_item(ch));
+
+            const uint64_t first_item = nitems_read(ch);
+            const uint64_t end_item = first_item + noutput_items;
+            get_tags_in_range(d_tags, ch, first_item, end_item, d_rx_time_key);
+            for (const auto& tag : d_tags)
+                {
+                    add_extrapolated_tags(ch, tag.offset);
+                    // rx_time is a tuple of the integer seconds and the fractional seconds
+                    if (pmt::is_tuple(tag.value) and pmt::length(tag.value) == 2)
+                        {
+                            // a device timestamp restarts the extrapolation
+                            Port_Clock& clock = d_clocks[ch];
+                            clock.tag_item = tag.offset;
+                            clock.tag_time_s = static_cast<double>(pmt::to_uint64(pmt::tuple_ref(tag.value, 0))) +
+                                               pmt::to_double(pmt::tuple_ref(tag.value, 1));
+                            clock.next_item = tag.offset + d_period_items;
+                            clock.valid = true;
+                            add_time_tag(ch, tag.offset, clock.tag_time_s);
+                        }
+                }
+            add_extrapolated_tags(ch, end_item);
+        }
+    return noutput_items;
+}
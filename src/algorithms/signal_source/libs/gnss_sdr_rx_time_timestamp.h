@@ -0,0 +1,103 @@
+/*!
+ * \file gnss_sdr_rx_time_timestamp.h
+ * \brief GNU Radio block that turns the hardware timestamps (rx_time tags)
+ * of a signal source into the GnssTime time tags read by the tracking blocks.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SDR_RX_TIME_TIMESTAMP_H
+#define GNSS_SDR_GNSS_SDR_RX_TIME_TIMESTAMP_H
+
+#include "gnss_block_interface.h"
+#include "gnss_time.h"
+#include <gnuradio/sync_block.h>  // for sync_block
+#include <gnuradio/types.h>       // for gr_vector_const_void_star
+#include <pmt/pmt.h>
+#include <cstddef>  // for size_t
+#include <cstdint>
+#include <vector>
+
+/** \addtogroup Signal_Source
+ * \{ */
+/** \addtogroup Signal_Source_libs
+ * \{ */
+
+
+class Gnss_Sdr_Rx_Time_Timestamp;
+
+gnss_shared_ptr<Gnss_Sdr_Rx_Time_Timestamp> gnss_sdr_make_rx_time_timestamp(
+    size_t sizeof_stream_item,
+    double sampling_frequency,
+    double clock_offset_s,
+    double period_ms);
+
+
+/*!
+ * \brief Pass-through block placed after a device source that timestamps its
+ * samples with rx_time tags, such as the LimeSDR source or the UHD devices of
+ * gr-osmosdr.
+ *
+ * The device time of each rx_time tag, plus clock_offset_s, is taken as GPS
+ * time, and a "timetag" GnssTime tag is added at the same sample. As the
+ * devices only tag the first sample and the samples after an overflow, the
+ * time of the last rx_time tag is extrapolated with the sample count to add a
+ * time tag every period_ms, so that the tracking blocks, which start later,
+ * get them too.
+ */
+class Gnss_Sdr_Rx_Time_Timestamp : public gr::sync_block
+{
+public:
+    int work(int noutput_items,
+        gr_vector_const_void_star& input_items,
+        gr_vector_void_star& output_items);
+
+    /*!
+     * \brief Time tag of a device time in seconds, taken as GPS time
+     */
+    static GnssTime gps_time(double time_s);
+
+private:
+    friend gnss_shared_ptr<Gnss_Sdr_Rx_Time_Timestamp> gnss_sdr_make_rx_time_timestamp(
+        size_t sizeof_stream_item,
+        double sampling_frequency,
+        double clock_offset_s,
+        double period_ms);
+
+    Gnss_Sdr_Rx_Time_Timestamp(size_t sizeof_stream_item,
+        double sampling_frequency,
+        double clock_offset_s,
+        double period_ms);
+
+    void add_time_tag(unsigned int port, uint64_t item, double time_s);
+    void add_extrapolated_tags(unsigned int port, uint64_t end_item);
+
+    struct Port_Clock
+    {
+        uint64_t tag_item{0};    // item of the last rx_time tag
+        double tag_time_s{0.0};  // and its device time
+        uint64_t next_item{0};   // item of the next extrapolated time tag
+        bool valid{false};
+    };
+
+    std::vector<Port_Clock> d_clocks;
+    std::vector<gr::tag_t> d_tags;
+    pmt::pmt_t d_rx_time_key;
+    pmt::pmt_t d_timetag_key;
+    double d_fs;
+    double d_clock_offset_s;
+    uint64_t d_period_items;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SDR_RX_TIME_TIMESTAMP_H
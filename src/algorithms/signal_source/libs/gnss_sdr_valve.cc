@@ -18,7 +18,7 @@
  */
 
 #include "gnss_sdr_valve.h"
-#include "command_event.h"
+#include "control_event.h"
 #include <glog/logging.h>           // for LOG
 #include <gnuradio/io_signature.h>  // for io_signature
 #include <algorithm>                // for min
@@ -68,7 +68,7 @@ int Gnss_Sdr_Valve::work(int noutput_items,
             if (d_ncopied_items >= d_nitems)
                 {
                     LOG(INFO) << "Stopping receiver, " << d_ncopied_items << " samples processed";
-                    d_queue->push(pmt::make_any(command_event_make(200, 0)));
+                    d_queue->push(control_event_pmt(Control_Event::command, 200, 0));
                     if (d_stop_flowgraph)
                         {
                             return -1;  // Done!
@@ -22,6 +22,7 @@
 #include "beidou_dnav_ephemeris.h"
 #include "beidou_dnav_iono.h"
 #include "beidou_dnav_utc_model.h"
+#include "beidou_dnav_word_decoder.h"
 #include "display.h"
 #include "gnss_sdr_make_unique.h"  // for std::make_unique in C++11
 #include "gnss_synchro.h"
@@ -30,10 +31,12 @@
 #include <gnuradio/io_signature.h>
 #include <pmt/pmt.h>        // for make_any
 #include <pmt/pmt_sugar.h>  // for mp
+#include <algorithm>        // for copy
 #include <cstddef>          // for size_t
 #include <cstdlib>          // for abs
 #include <exception>        // for exception
 #include <iostream>         // for cout
+#include <iterator>         // for next
 #include <memory>           // for shared_ptr, make_shared
 
 #define CRC_ERROR_LIMIT 8
@@ -78,8 +81,8 @@ beidou_b1i_telemetry_decoder_gs::beidou_b1i_telemetry_decoder_gs(
 {
     // prevent telemetry symbols accumulation in output buffers
     this->set_max_noutput_items(1);
-    // Ephemeris data port out
-    this->message_port_register_out(pmt::mp("telemetry"));
+    // Ephemeris data channel out
+    d_nav_product_channel = Gnss_Nav_Product_Channel::create();
     // Control messages to tracking block
     this->message_port_register_out(pmt::mp("telemetry_to_trk"));
 
@@ -108,6 +111,7 @@ beidou_b1i_telemetry_decoder_gs::beidou_b1i_telemetry_decoder_gs(
         }
 
     d_symbol_history.set_capacity(d_required_symbols);
+    d_preamble_correlator = Gnss_Sign_Correlator(std::vector<int32_t>(d_preamble_samples.cbegin(), d_preamble_samples.cend()), d_required_symbols);
 
     if (d_dump_crc_stats)
         {
@@ -128,7 +132,7 @@ beidou_b1i_telemetry_decoder_gs::~beidou_b1i_telemetry_decoder_gs()
     size_t pos = 0;
     if (d_dump_file.is_open() == true)
         {
-            pos = d_dump_file.tellp();
+            pos = d_dump_file.bytes_written();
             try
                 {
                     d_dump_file.close();
@@ -159,104 +163,16 @@ beidou_b1i_telemetry_decoder_gs::~beidou_b1i_telemetry_decoder_gs()
 }
 
 
-void beidou_b1i_telemetry_decoder_gs::decode_bch15_11_01(const int32_t *bits, std::array<int32_t, 15> &decbits)
+void beidou_b1i_telemetry_decoder_gs::decode_subframe(const float *frame_symbols, bool inverted)
 {
-    int32_t bit;
-    int32_t err;
-    std::array<int32_t, 4> reg{-1, -1, -1, -1};
-    const std::array<int32_t, 15> errind{14, 13, 10, 12, 6, 9, 4, 11, 0, 5, 7, 8, 1, 3, 2};
-
-    for (uint32_t i = 0; i < 15; i++)
-        {
-            decbits[i] = bits[i];
-        }
-
-    for (uint32_t i = 0; i < 15; i++)
-        {
-            bit = reg[3];
-            reg[3] = reg[2];
-            reg[2] = reg[1];
-            reg[1] = reg[0];
-            reg[0] = bits[i] * bit;
-            reg[1] *= bit;
-        }
-
-    for (uint32_t i = 0; i < 4; ++i)
-        {
-            reg[i] = (reg[i] + 1) / 2;
-        }
-
-    err = reg[0] + reg[1] * 2 + reg[2] * 4 + reg[3] * 8;
-
-    if (err > 0 && err < 16)
-        {
-            decbits[errind[err - 1]] *= -1;
-        }
-}
-
-
-void beidou_b1i_telemetry_decoder_gs::decode_word(
-    int32_t word_counter,
-    const float *enc_word_symbols,
-    int32_t *dec_word_symbols)
-{
-    std::array<int32_t, 30> bitsbch{};
-    std::array<int32_t, 15> first_branch{};
-    std::array<int32_t, 15> second_branch{};
-
-    if (word_counter == 1)
-        {
-            for (uint32_t j = 0; j < 30; j++)
-                {
-                    dec_word_symbols[j] = static_cast<int32_t>(enc_word_symbols[j] > 0) ? (1) : (-1);
-                }
-        }
-    else
-        {
-            for (uint32_t r = 0; r < 2; r++)
-                {
-                    for (uint32_t c = 0; c < 15; c++)
-                        {
-                            bitsbch[r * 15 + c] = static_cast<int32_t>(enc_word_symbols[c * 2 + r] > 0) ? (1) : (-1);
-                        }
-                }
-
-            decode_bch15_11_01(&bitsbch[0], first_branch);
-            decode_bch15_11_01(&bitsbch[15], second_branch);
-
-            for (uint32_t j = 0; j < 11; j++)
-                {
-                    dec_word_symbols[j] = first_branch[j];
-                    dec_word_symbols[j + 11] = second_branch[j];
-                }
-
-            for (uint32_t j = 0; j < 4; j++)
-                {
-                    dec_word_symbols[j + 22] = first_branch[11 + j];
-                    dec_word_symbols[j + 26] = second_branch[11 + j];
-                }
-        }
-}
-
-
-void beidou_b1i_telemetry_decoder_gs::decode_subframe(float *frame_symbols)
-{
-    // 1. Transform from symbols to bits
-    std::string data_bits;
-    data_bits.reserve(BEIDOU_DNAV_WORDS_SUBFRAME * BEIDOU_DNAV_WORD_LENGTH_BITS);
-    std::array<int32_t, 30> dec_word_bits{};
+    // 1. Transform from symbols to bits, correcting the 180 deg. inverted carrier phase PLL lock in the slicing
+    std::string data_bits(BEIDOU_DNAV_WORDS_SUBFRAME * BEIDOU_DNAV_WORD_LENGTH_BITS, '0');
+    const float polarity = inverted ? -1.0F : 1.0F;
 
     // Decode each word in subframe
     for (uint32_t ii = 0; ii < BEIDOU_DNAV_WORDS_SUBFRAME; ii++)
         {
-            // decode the word
-            decode_word((ii + 1), &frame_symbols[ii * 30], dec_word_bits.data());
-
-            // Save word to string format
-            for (uint32_t jj = 0; jj < (BEIDOU_DNAV_WORD_LENGTH_BITS); jj++)
-                {
-                    data_bits.push_back((dec_word_bits[jj] > 0) ? ('1') : ('0'));
-                }
+            beidou_dnav_decode_word(ii == 0, &frame_symbols[ii * BEIDOU_DNAV_WORD_LENGTH_BITS], polarity, &data_bits[ii * BEIDOU_DNAV_WORD_LENGTH_BITS]);
         }
 
     if (d_enable_navdata_monitor)
@@ -295,7 +211,7 @@ void beidou_b1i_telemetry_decoder_gs::decode_subframe(float *frame_symbols)
         {
             // get object for this SV (mandatory)
             const std::shared_ptr<Beidou_Dnav_Ephemeris> tmp_obj = std::make_shared<Beidou_Dnav_Ephemeris>(d_nav.get_ephemeris());
-            this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+            d_nav_product_channel->push(Gnss_Nav_Product(tmp_obj));
             LOG(INFO) << "BEIDOU DNAV Ephemeris have been received in channel" << d_channel << " from satellite " << d_satellite;
             std::cout << "New BEIDOU B1I DNAV message received in channel " << d_channel << ": ephemeris from satellite " << d_satellite << '\n';
         }
@@ -303,7 +219,7 @@ void beidou_b1i_telemetry_decoder_gs::decode_subframe(float *frame_symbols)
         {
             // get object for this SV (mandatory)
             const std::shared_ptr<Beidou_Dnav_Utc_Model> tmp_obj = std::make_shared<Beidou_Dnav_Utc_Model>(d_nav.get_utc_model());
-            this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+            d_nav_product_channel->push(Gnss_Nav_Product(tmp_obj));
             LOG(INFO) << "BEIDOU DNAV UTC Model data have been received in channel" << d_channel << " from satellite " << d_satellite;
             std::cout << "New BEIDOU B1I DNAV utc model message received in channel " << d_channel << ": UTC model parameters from satellite " << d_satellite << '\n';
         }
@@ -311,7 +227,7 @@ void beidou_b1i_telemetry_decoder_gs::decode_subframe(float *frame_symbols)
         {
             // get object for this SV (mandatory)
             const std::shared_ptr<Beidou_Dnav_Iono> tmp_obj = std::make_shared<Beidou_Dnav_Iono>(d_nav.get_iono());
-            this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+            d_nav_product_channel->push(Gnss_Nav_Product(tmp_obj));
             LOG(INFO) << "BEIDOU DNAV Iono data have been received in channel" << d_channel << " from satellite " << d_satellite;
             std::cout << "New BEIDOU B1I DNAV Iono message received in channel " << d_channel << ": Iono model parameters from satellite " << d_satellite << '\n';
         }
@@ -319,7 +235,7 @@ void beidou_b1i_telemetry_decoder_gs::decode_subframe(float *frame_symbols)
         {
             // uint32_t slot_nbr = d_nav.i_alm_satellite_PRN;
             // std::shared_ptr<Beidou_Dnav_Almanac> tmp_obj = std::make_shared<Beidou_Dnav_Almanac>(d_nav.get_almanac(slot_nbr));
-            // this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+            // d_nav_product_channel->push(Gnss_Nav_Product(tmp_obj));
             LOG(INFO) << "BEIDOU DNAV Almanac data have been received in channel" << d_channel << " from satellite " << d_satellite << '\n';
             std::cout << "New BEIDOU B1I DNAV almanac received in channel " << d_channel << " from satellite " << d_satellite << '\n';
         }
@@ -386,6 +302,13 @@ void beidou_b1i_telemetry_decoder_gs::set_satellite(const Gnss_Satellite &satell
             d_required_symbols = BEIDOU_DNAV_SUBFRAME_SYMBOLS + d_samples_per_preamble;
             d_symbol_history.set_capacity(d_required_symbols);
         }
+
+    // the signs of the symbols kept in the history, against the new preamble
+    d_preamble_correlator = Gnss_Sign_Correlator(std::vector<int32_t>(d_preamble_samples.cbegin(), d_preamble_samples.cend()), d_required_symbols);
+    for (const float symbol : d_symbol_history)
+        {
+            d_preamble_correlator.push(symbol);
+        }
 }
 
 
@@ -402,8 +325,7 @@ void beidou_b1i_telemetry_decoder_gs::set_channel(int32_t channel)
                         {
                             d_dump_filename.append(std::to_string(d_channel));
                             d_dump_filename.append(".dat");
-                            d_dump_file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-                            d_dump_file.open(d_dump_filename.c_str(), std::ios::out | std::ios::binary);
+                            d_dump_file.open(d_dump_filename);
                             LOG(INFO) << "Telemetry decoder dump enabled on channel " << d_channel << " Log file: " << d_dump_filename.c_str();
                         }
                     catch (const std::ifstream::failure &e)
@@ -431,37 +353,24 @@ void beidou_b1i_telemetry_decoder_gs::reset()
 }
 
 
-int beidou_b1i_telemetry_decoder_gs::general_work(int noutput_items __attribute__((unused)), gr_vector_int &ninput_items __attribute__((unused)),
-    gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
+bool beidou_b1i_telemetry_decoder_gs::decode_symbol(const Gnss_Synchro &in_symbol, Gnss_Synchro &out_symbol)
 {
     int32_t corr_value = 0;
     int32_t preamble_diff = 0;
 
-    auto **out = reinterpret_cast<Gnss_Synchro **>(&output_items[0]);            // Get the output buffer pointer
-    const auto **in = reinterpret_cast<const Gnss_Synchro **>(&input_items[0]);  // Get the input buffer pointer
 
     Gnss_Synchro current_symbol{};  // structure to save the synchronization information and send the output object to the next block
     // 1. Copy the current tracking output
-    current_symbol = in[0][0];
+    current_symbol = in_symbol;
     d_symbol_history.push_back(current_symbol.Prompt_I);  // add new symbol to the symbol queue
+    d_preamble_correlator.push(current_symbol.Prompt_I);
     d_sample_counter++;                                   // count for the processed samples
-    consume_each(1);
     d_flag_preamble = false;
 
     if (d_symbol_history.size() >= d_required_symbols)
         {
             // ******* preamble correlation ********
-            for (int32_t i = 0; i < d_samples_per_preamble; i++)
-                {
-                    if (d_symbol_history[i] < 0)  // symbols clipping
-                        {
-                            corr_value -= d_preamble_samples[i];
-                        }
-                    else
-                        {
-                            corr_value += d_preamble_samples[i];
-                        }
-                }
+            corr_value = d_preamble_correlator.correlation();
         }
     // ******* frame sync ******************
     if (d_stat == 0)  // no preamble information
@@ -490,23 +399,11 @@ int beidou_b1i_telemetry_decoder_gs::general_work(int noutput_items __attribute_
                             d_stat = 2;
 
                             // ******* SAMPLES TO SYMBOLS *******
-                            if (corr_value > 0)  // normal PLL lock
-                                {
-                                    for (uint32_t i = 0; i < BEIDOU_DNAV_PREAMBLE_PERIOD_SYMBOLS; i++)
-                                        {
-                                            d_subframe_symbols[i] = d_symbol_history[i];
-                                        }
-                                }
-                            else  // 180 deg. inverted carrier phase PLL lock
-                                {
-                                    for (uint32_t i = 0; i < BEIDOU_DNAV_PREAMBLE_PERIOD_SYMBOLS; i++)
-                                        {
-                                            d_subframe_symbols[i] = -d_symbol_history[i];
-                                        }
-                                }
+                            // the polarity of the PLL lock is corrected in the decoding of the words
+                            std::copy(d_symbol_history.begin(), std::next(d_symbol_history.begin(), BEIDOU_DNAV_PREAMBLE_PERIOD_SYMBOLS), d_subframe_symbols.begin());
 
                             // call the decoder
-                            decode_subframe(d_subframe_symbols.data());
+                            decode_subframe(d_subframe_symbols.data(), corr_value <= 0);
 
                             if (d_nav.get_flag_CRC_test() == true)
                                 {
@@ -547,23 +444,11 @@ int beidou_b1i_telemetry_decoder_gs::general_work(int noutput_items __attribute_
             if (d_sample_counter == d_preamble_index + static_cast<uint64_t>(d_preamble_period_samples))
                 {
                     // ******* SAMPLES TO SYMBOLS *******
-                    if (corr_value > 0)  // normal PLL lock
-                        {
-                            for (uint32_t i = 0; i < BEIDOU_DNAV_PREAMBLE_PERIOD_SYMBOLS; i++)
-                                {
-                                    d_subframe_symbols[i] = d_symbol_history[i];
-                                }
-                        }
-                    else  // 180 deg. inverted carrier phase PLL lock
-                        {
-                            for (uint32_t i = 0; i < BEIDOU_DNAV_PREAMBLE_PERIOD_SYMBOLS; i++)
-                                {
-                                    d_subframe_symbols[i] = -d_symbol_history[i];
-                                }
-                        }
+                    // the polarity of the PLL lock is corrected in the decoding of the words
+                    std::copy(d_symbol_history.begin(), std::next(d_symbol_history.begin(), BEIDOU_DNAV_PREAMBLE_PERIOD_SYMBOLS), d_subframe_symbols.begin());
 
                     // call the decoder
-                    decode_subframe(d_subframe_symbols.data());
+                    decode_subframe(d_subframe_symbols.data(), corr_value <= 0);
 
                     if (d_nav.get_flag_CRC_test() == true)
                         {
@@ -653,15 +538,15 @@ int beidou_b1i_telemetry_decoder_gs::general_work(int noutput_items __attribute_
                             uint64_t tmp_ulong_int;
                             int32_t tmp_int;
                             tmp_double = static_cast<double>(d_TOW_at_current_symbol_ms) / 1000.0;
-                            d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
+                            d_dump_file.write(tmp_double);
                             tmp_ulong_int = current_symbol.Tracking_sample_counter;
-                            d_dump_file.write(reinterpret_cast<char *>(&tmp_ulong_int), sizeof(uint64_t));
+                            d_dump_file.write(tmp_ulong_int);
                             tmp_double = static_cast<double>(d_TOW_at_Preamble_ms) / 1000.0;
-                            d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
+                            d_dump_file.write(tmp_double);
                             tmp_int = (current_symbol.Prompt_I > 0.0 ? 1 : -1);
-                            d_dump_file.write(reinterpret_cast<char *>(&tmp_int), sizeof(int32_t));
+                            d_dump_file.write(tmp_int);
                             tmp_int = static_cast<int32_t>(current_symbol.PRN);
-                            d_dump_file.write(reinterpret_cast<char *>(&tmp_int), sizeof(int32_t));
+                            d_dump_file.write(tmp_int);
                         }
                     catch (const std::ifstream::failure &e)
                         {
@@ -670,8 +555,30 @@ int beidou_b1i_telemetry_decoder_gs::general_work(int noutput_items __attribute_
                 }
 
             // 3. Make the output (copy the object contents to the GNURadio reserved memory)
-            *out[0] = current_symbol;
-            return 1;
+            out_symbol = current_symbol;
+            return true;
+        }
+    return false;
+}
+
+
+int beidou_b1i_telemetry_decoder_gs::general_work(int noutput_items, gr_vector_int &ninput_items,
+    gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
+{
+    auto **out = reinterpret_cast<Gnss_Synchro **>(&output_items[0]);            // Get the output buffer pointer
+    const auto **in = reinterpret_cast<const Gnss_Synchro **>(&input_items[0]);  // Get the input buffer pointer
+
+    // decode all the available symbols, each one producing at most one output
+    int32_t n_consumed = 0;
+    int32_t n_produced = 0;
+    while (n_consumed < ninput_items[0] && n_produced < noutput_items)
+        {
+            if (decode_symbol(in[0][n_consumed], out[0][n_produced]))
+                {
+                    n_produced++;
+                }
+            n_consumed++;
         }
-    return 0;
+    consume_each(n_consumed);
+    return n_produced;
 }
@@ -19,7 +19,11 @@
 
 #include "beidou_dnav_navigation_message.h"
 #include "gnss_block_interface.h"
+#include "gnss_dump_writer.h"
+#include "gnss_nav_product_channel.h"
 #include "gnss_satellite.h"
+#include "gnss_sign_correlator.h"
+#include "gnss_synchro.h"
 #include "nav_message_packet.h"
 #include "tlm_conf.h"
 #include "tlm_crc_stats.h"
@@ -29,7 +33,7 @@
 #include <array>
 #include <cstdint>
 #include <fstream>
-#include <memory>  // for std::unique_ptr
+#include <memory>  // for std::shared_ptr, std::unique_ptr
 #include <string>
 
 
@@ -72,11 +76,9 @@ private:
         const Tlm_Conf &conf);
 
     beidou_b3i_telemetry_decoder_gs(const Gnss_Satellite &satellite, const Tlm_Conf &conf);
+    bool decode_symbol(const Gnss_Synchro &in_symbol, Gnss_Synchro &out_symbol);  //!< Decodes one symbol. Returns true if out_symbol is produced
 
-    void decode_subframe(float *symbols);
-    void decode_word(int32_t word_counter, const float *enc_word_symbols,
-        int32_t *dec_word_symbols);
-    void decode_bch15_11_01(const int32_t *bits, std::array<int32_t, 15> &decbits);
+    void decode_subframe(const float *symbols, bool inverted);
 
     // Preamble decoding
     std::array<int32_t, BEIDOU_DNAV_PREAMBLE_LENGTH_SYMBOLS> d_preamble_samples{};
@@ -84,6 +86,7 @@ private:
 
     // Storage for incoming data
     boost::circular_buffer<float> d_symbol_history;
+    Gnss_Sign_Correlator d_preamble_correlator;  // signs of d_symbol_history
 
     // Navigation Message variable
     Beidou_Dnav_Navigation_Message d_nav;
@@ -91,9 +94,10 @@ private:
 
     Nav_Message_Packet d_nav_msg_packet;
     std::unique_ptr<Tlm_CRC_Stats> d_Tlm_CRC_Stats;
+    std::shared_ptr<Gnss_Nav_Product_Channel> d_nav_product_channel;  // navigation data delivered to the PVT block
 
     std::string d_dump_filename;
-    std::ofstream d_dump_file;
+    Gnss_Dump_Writer d_dump_file;
 
     uint64_t d_sample_counter;  // Sample counter as an index (1,2,3,..etc) indicating number of samples processed
     uint64_t d_preamble_index;  // Index of sample number where preamble was found
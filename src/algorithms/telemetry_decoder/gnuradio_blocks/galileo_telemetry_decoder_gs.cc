@@ -32,17 +32,20 @@
 #include "gnss_sdr_make_unique.h"    // for std::make_unique in C++11
 #include "gnss_synchro.h"            // for Gnss_Synchro
 #include "tlm_crc_stats.h"           // for Tlm_CRC_Stats
+#include "tlm_deinterleaver.h"       // for Tlm_Deinterleaver
 #include "tlm_utils.h"               // for save_tlm_matfile, tlm_remove_file
 #include "viterbi_decoder.h"         // for Viterbi_Decoder
 #include <glog/logging.h>            // for LOG, DLOG
 #include <gnuradio/io_signature.h>   // for gr::io_signature::make
 #include <pmt/pmt.h>                 // for pmt::make_any
 #include <pmt/pmt_sugar.h>           // for pmt::mp
+#include <algorithm>                 // for std::copy
 #include <array>                     // for std::array
 #include <cmath>                     // for std::fmod, std::abs
 #include <cstddef>                   // for size_t
 #include <exception>                 // for std::exception
 #include <iostream>                  // for std::cout
+#include <iterator>                  // for std::next
 
 #define CRC_ERROR_LIMIT 6
 
@@ -89,8 +92,8 @@ galileo_telemetry_decoder_gs::galileo_telemetry_decoder_gs(
 {
     // prevent telemetry symbols accumulation in output buffers
     this->set_max_noutput_items(1);
-    // Ephemeris data port out
-    this->message_port_register_out(pmt::mp("telemetry"));
+    // Ephemeris data channel out
+    d_nav_product_channel = Gnss_Nav_Product_Channel::create();
     // Control messages to tracking block
     this->message_port_register_out(pmt::mp("telemetry_to_trk"));
     // register Gal E6 messages HAS out
@@ -139,6 +142,7 @@ galileo_telemetry_decoder_gs::galileo_telemetry_decoder_gs(
                 d_codelength = static_cast<int32_t>(d_frame_length_symbols);
                 d_datalength = (d_codelength / nn) - d_mm;
                 d_max_symbols_without_valid_frame = GALILEO_INAV_PAGE_SYMBOLS * 30;  // rise alarm 60 seconds without valid tlm
+                d_deinterleaver = std::make_unique<Tlm_Deinterleaver>(GALILEO_INAV_INTERLEAVER_ROWS, GALILEO_INAV_INTERLEAVER_COLS, true);
                 if (conf.enable_reed_solomon == true)
                     {
                         d_enable_reed_solomon_inav = true;
@@ -160,6 +164,7 @@ galileo_telemetry_decoder_gs::galileo_telemetry_decoder_gs(
                 d_codelength = static_cast<int32_t>(d_frame_length_symbols);
                 d_datalength = (d_codelength / nn) - d_mm;
                 d_max_symbols_without_valid_frame = GALILEO_FNAV_SYMBOLS_PER_PAGE * 5;  // rise alarm 100 seconds without valid tlm
+                d_deinterleaver = std::make_unique<Tlm_Deinterleaver>(GALILEO_FNAV_INTERLEAVER_ROWS, GALILEO_FNAV_INTERLEAVER_COLS, true);
                 break;
             }
         case 3:  // CNAV
@@ -174,6 +179,7 @@ galileo_telemetry_decoder_gs::galileo_telemetry_decoder_gs(
                 d_codelength = static_cast<int32_t>(d_frame_length_symbols);
                 d_datalength = (d_codelength / nn) - d_mm;
                 d_max_symbols_without_valid_frame = GALILEO_CNAV_SYMBOLS_PER_PAGE * 60;
+                d_deinterleaver = std::make_unique<Tlm_Deinterleaver>(GALILEO_CNAV_INTERLEAVER_ROWS, GALILEO_CNAV_INTERLEAVER_COLS, true);
                 break;
             }
         default:
@@ -235,6 +241,7 @@ galileo_telemetry_decoder_gs::galileo_telemetry_decoder_gs(
         }
 
     d_symbol_history.set_capacity(d_required_symbols + 1);
+    d_preamble_correlator = Gnss_Sign_Correlator(d_preamble_samples, d_required_symbols + 1);
 
     d_inav_nav.init_PRN(d_satellite.get_PRN());
 
@@ -249,7 +256,7 @@ galileo_telemetry_decoder_gs::~galileo_telemetry_decoder_gs()
     size_t pos = 0;
     if (d_dump_file.is_open() == true)
         {
-            pos = d_dump_file.tellp();
+            pos = d_dump_file.bytes_written();
             try
                 {
                     d_dump_file.close();
@@ -280,61 +287,41 @@ galileo_telemetry_decoder_gs::~galileo_telemetry_decoder_gs()
 }
 
 
-void galileo_telemetry_decoder_gs::deinterleaver(int32_t rows, int32_t cols, const float *in, float *out)
+void galileo_telemetry_decoder_gs::deinterleave(const float *page_symbols, int32_t frame_length)
 {
-    for (int32_t r = 0; r < rows; r++)
-        {
-            for (int32_t c = 0; c < cols; c++)
-                {
-                    out[c * rows + r] = in[r * cols + c];
-                }
-        }
+    // 1. De-interleave, taking into account the NOT gate in G2 polynomial (Galileo ICD Figure 13, FEC encoder)
+    // and the polarity of the PLL lock in the signs of the permutation table
+    d_page_part_symbols_soft_value.resize(frame_length);
+    d_deinterleaver->deinterleave(page_symbols, d_page_part_symbols_soft_value.data(), d_flag_PLL_180_deg_phase_locked);
+
+    // 2. Viterbi decoder
+    d_page_part_bits.resize(frame_length / 2);
+    d_viterbi->decode(d_page_part_bits, d_page_part_symbols_soft_value);
 }
 
 
-void galileo_telemetry_decoder_gs::decode_INAV_word(float *page_part_symbols, int32_t frame_length)
+void galileo_telemetry_decoder_gs::decode_INAV_word(const float *page_part_symbols, int32_t frame_length)
 {
-    // 1. De-interleave
-    std::vector<float> page_part_symbols_soft_value(frame_length);
-    deinterleaver(GALILEO_INAV_INTERLEAVER_ROWS, GALILEO_INAV_INTERLEAVER_COLS, page_part_symbols, page_part_symbols_soft_value.data());
-
-    // 2. Viterbi decoder
-    // 2.1 Take into account the NOT gate in G2 polynomial (Galileo ICD Figure 13, FEC encoder)
-    for (int32_t i = 0; i < frame_length; i++)
-        {
-            if ((i + 1) % 2 == 0)
-                {
-                    page_part_symbols_soft_value[i] = -page_part_symbols_soft_value[i];
-                }
-        }
+    // 1. De-interleave and 2. Viterbi decoder
+    deinterleave(page_part_symbols, frame_length);
     const int32_t decoded_length = frame_length / 2;
-    std::vector<int32_t> page_part_bits(decoded_length);
-    d_viterbi->decode(page_part_bits, page_part_symbols_soft_value);
 
     // 3. Call the Galileo page decoder
-    std::string page_String;
-    page_String.reserve(decoded_length);
+    Galileo_Inav_Page_Part page_part;
     for (int32_t i = 0; i < decoded_length; i++)
         {
-            if (page_part_bits[i] > 0)
-                {
-                    page_String.push_back('1');
-                }
-            else
-                {
-                    page_String.push_back('0');
-                }
+            page_part.push_back(d_page_part_bits[i] > 0);
         }
 
     if (d_enable_navdata_monitor)
         {
-            d_nav_msg_packet.nav_message = page_String;
+            d_nav_msg_packet.nav_message = page_part.to_string();
         }
 
-    if (page_part_bits[0] == 1)
+    if (d_page_part_bits[0] == 1)
         {
             // DECODE COMPLETE WORD (even + odd) and TEST CRC
-            d_inav_nav.split_page(page_String, d_flag_even_word_arrived);
+            d_inav_nav.split_page(page_part, d_flag_even_word_arrived);
             if (d_inav_nav.get_flag_CRC_test() == true)
                 {
                     if (d_band == '1')
@@ -362,7 +349,7 @@ void galileo_telemetry_decoder_gs::decode_INAV_word(float *page_part_symbols, in
     else
         {
             // STORE HALF WORD (even page)
-            d_inav_nav.split_page(page_String, d_flag_even_word_arrived);
+            d_inav_nav.split_page(page_part, d_flag_even_word_arrived);
             d_flag_even_word_arrived = 1;
         }
 
@@ -379,7 +366,7 @@ void galileo_telemetry_decoder_gs::decode_INAV_word(float *page_part_symbols, in
                 {
                     std::cout << TEXT_BLUE << "New Galileo E5b I/NAV message received in channel " << d_channel << ": ephemeris from satellite " << d_satellite << TEXT_RESET << '\n';
                 }
-            this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+            d_nav_product_channel->push(Gnss_Nav_Product(tmp_obj));
             d_first_eph_sent = true;  // do not send reduced CED anymore, since we have the full ephemeris set
         }
     else
@@ -389,7 +376,7 @@ void galileo_telemetry_decoder_gs::decode_INAV_word(float *page_part_symbols, in
                 {
                     const std::shared_ptr<Galileo_Ephemeris> tmp_obj = std::make_shared<Galileo_Ephemeris>(d_inav_nav.get_reduced_ced());
                     std::cout << "New Galileo E1 I/NAV reduced CED message received in channel " << d_channel << " from satellite " << d_satellite << '\n';
-                    this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+                    d_nav_product_channel->push(Gnss_Nav_Product(tmp_obj));
                 }
         }
 
@@ -405,7 +392,7 @@ void galileo_telemetry_decoder_gs::decode_INAV_word(float *page_part_symbols, in
                 {
                     std::cout << TEXT_BLUE << "New Galileo E5b I/NAV message received in channel " << d_channel << ": iono/GST model parameters from satellite " << d_satellite << TEXT_RESET << '\n';
                 }
-            this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+            d_nav_product_channel->push(Gnss_Nav_Product(tmp_obj));
         }
     if (d_inav_nav.have_new_utc_model() == true)
         {
@@ -419,14 +406,14 @@ void galileo_telemetry_decoder_gs::decode_INAV_word(float *page_part_symbols, in
                 {
                     std::cout << TEXT_BLUE << "New Galileo E5b I/NAV message received in channel " << d_channel << ": UTC model parameters from satellite " << d_satellite << TEXT_RESET << '\n';
                 }
-            this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+            d_nav_product_channel->push(Gnss_Nav_Product(tmp_obj));
             d_delta_t = tmp_obj->A_0G + tmp_obj->A_1G * (static_cast<double>(d_TOW_at_current_symbol_ms) / 1000.0 - tmp_obj->t_0G + 604800 * (std::fmod(static_cast<float>(d_inav_nav.get_Galileo_week() - tmp_obj->WN_0G), 64.0)));
             DLOG(INFO) << "delta_t=" << d_delta_t << "[s]";
         }
     if (d_inav_nav.have_new_almanac() == true)
         {
             const std::shared_ptr<Galileo_Almanac_Helper> tmp_obj = std::make_shared<Galileo_Almanac_Helper>(d_inav_nav.get_almanac());
-            this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+            d_nav_product_channel->push(Gnss_Nav_Product(tmp_obj));
             // debug
             if (d_band == '1')
                 {
@@ -443,39 +430,19 @@ void galileo_telemetry_decoder_gs::decode_INAV_word(float *page_part_symbols, in
 }
 
 
-void galileo_telemetry_decoder_gs::decode_FNAV_word(float *page_symbols, int32_t frame_length)
+void galileo_telemetry_decoder_gs::decode_FNAV_word(const float *page_symbols, int32_t frame_length)
 {
-    // 1. De-interleave
-    std::vector<float> page_symbols_soft_value(frame_length);
-    deinterleaver(GALILEO_FNAV_INTERLEAVER_ROWS, GALILEO_FNAV_INTERLEAVER_COLS, page_symbols, page_symbols_soft_value.data());
-
-    // 2. Viterbi decoder
-    // 2.1 Take into account the NOT gate in G2 polynomial (Galileo ICD Figure 13, FEC encoder)
-    for (int32_t i = 0; i < frame_length; i++)
-        {
-            if ((i + 1) % 2 == 0)
-                {
-                    page_symbols_soft_value[i] = -page_symbols_soft_value[i];
-                }
-        }
+    // 1. De-interleave and 2. Viterbi decoder
+    deinterleave(page_symbols, frame_length);
 
     const int32_t decoded_length = frame_length / 2;
-    std::vector<int32_t> page_bits(decoded_length);
-    d_viterbi->decode(page_bits, page_symbols_soft_value);
 
     // 3. Call the Galileo page decoder
     std::string page_String;
     page_String.reserve(decoded_length);
     for (int32_t i = 0; i < decoded_length; i++)
         {
-            if (page_bits[i] > 0)
-                {
-                    page_String.push_back('1');
-                }
-            else
-                {
-                    page_String.push_back('0');
-                }
+            page_String.push_back(static_cast<char>('0' + (d_page_part_bits[i] > 0)));
         }
 
     if (d_enable_navdata_monitor)
@@ -499,55 +466,35 @@ void galileo_telemetry_decoder_gs::decode_FNAV_word(float *page_symbols, int32_t
         {
             const std::shared_ptr<Galileo_Ephemeris> tmp_obj = std::make_shared<Galileo_Ephemeris>(d_fnav_nav.get_ephemeris());
             std::cout << TEXT_MAGENTA << "New Galileo E5a F/NAV message received in channel " << d_channel << ": ephemeris from satellite " << d_satellite << TEXT_RESET << '\n';
-            this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+            d_nav_product_channel->push(Gnss_Nav_Product(tmp_obj));
         }
     if (d_fnav_nav.have_new_iono_and_GST() == true)
         {
             const std::shared_ptr<Galileo_Iono> tmp_obj = std::make_shared<Galileo_Iono>(d_fnav_nav.get_iono());
             std::cout << TEXT_MAGENTA << "New Galileo E5a F/NAV message received in channel " << d_channel << ": iono/GST model parameters from satellite " << d_satellite << TEXT_RESET << '\n';
-            this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+            d_nav_product_channel->push(Gnss_Nav_Product(tmp_obj));
         }
     if (d_fnav_nav.have_new_utc_model() == true)
         {
             const std::shared_ptr<Galileo_Utc_Model> tmp_obj = std::make_shared<Galileo_Utc_Model>(d_fnav_nav.get_utc_model());
             std::cout << TEXT_MAGENTA << "New Galileo E5a F/NAV message received in channel " << d_channel << ": UTC model parameters from satellite " << d_satellite << TEXT_RESET << '\n';
-            this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+            d_nav_product_channel->push(Gnss_Nav_Product(tmp_obj));
         }
 }
 
 
-void galileo_telemetry_decoder_gs::decode_CNAV_word(float *page_symbols, int32_t page_length)
+void galileo_telemetry_decoder_gs::decode_CNAV_word(const float *page_symbols, int32_t page_length)
 {
-    // 1. De-interleave
-    std::vector<float> page_symbols_soft_value(page_length);
-    deinterleaver(GALILEO_CNAV_INTERLEAVER_ROWS, GALILEO_CNAV_INTERLEAVER_COLS, page_symbols, page_symbols_soft_value.data());
-
-    // 2. Viterbi decoder
-    // 2.1 Take into account the NOT gate in G2 polynomial (Galileo ICD Figure 13, FEC encoder)
-    for (int32_t i = 0; i < page_length; i++)
-        {
-            if ((i + 1) % 2 == 0)
-                {
-                    page_symbols_soft_value[i] = -page_symbols_soft_value[i];
-                }
-        }
+    // 1. De-interleave and 2. Viterbi decoder
+    deinterleave(page_symbols, page_length);
     const int32_t decoded_length = page_length / 2;
-    std::vector<int32_t> page_bits(decoded_length);
-    d_viterbi->decode(page_bits, page_symbols_soft_value);
 
     // 3. Call the Galileo page decoder
     std::string page_String;
     page_String.reserve(decoded_length);
     for (int32_t i = 0; i < decoded_length; i++)
         {
-            if (page_bits[i] > 0)
-                {
-                    page_String.push_back('1');
-                }
-            else
-                {
-                    page_String.push_back('0');
-                }
+            page_String.push_back(static_cast<char>('0' + (d_page_part_bits[i] > 0)));
         }
     d_cnav_nav.read_HAS_page(page_String);
 
@@ -630,8 +577,7 @@ void galileo_telemetry_decoder_gs::set_channel(int32_t channel)
                         {
                             d_dump_filename.append(std::to_string(d_channel));
                             d_dump_filename.append(".dat");
-                            d_dump_file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-                            d_dump_file.open(d_dump_filename.c_str(), std::ios::out | std::ios::binary);
+                            d_dump_file.open(d_dump_filename);
                             LOG(INFO) << "Telemetry decoder dump enabled on channel " << d_channel << " Log file: " << d_dump_filename.c_str();
                         }
                     catch (const std::ifstream::failure &e)
@@ -650,50 +596,34 @@ void galileo_telemetry_decoder_gs::set_channel(int32_t channel)
 }
 
 
-int galileo_telemetry_decoder_gs::general_work(int noutput_items __attribute__((unused)), gr_vector_int &ninput_items __attribute__((unused)),
-    gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
+int32_t galileo_telemetry_decoder_gs::decode_symbol(const Gnss_Synchro &in_symbol, Gnss_Synchro &out_symbol, uint64_t in_offset, uint64_t out_offset)
 {
-    auto **out = reinterpret_cast<Gnss_Synchro **>(&output_items[0]);            // Get the output buffer pointer
-    const auto **in = reinterpret_cast<const Gnss_Synchro **>(&input_items[0]);  // Get the input buffer pointer
-
     Gnss_Synchro current_symbol{};  // structure to save the synchronization information and send the output object to the next block
     // 1. Copy the current tracking output
-    current_symbol = in[0][0];
+    current_symbol = in_symbol;
     d_band = current_symbol.Signal[0];
 
     // add new symbol to the symbol queue
     d_symbol_history.push_back(current_symbol.Prompt_I);
+    d_preamble_correlator.push(current_symbol.Prompt_I);
 
     d_sample_counter++;  // count for the processed symbols
 
     // Time Tags from signal source (optional feature)
-    std::vector<gr::tag_t> tags_vec;
-    this->get_tags_in_range(tags_vec, 0, this->nitems_read(0), this->nitems_read(0) + 1);  // telemetry decoder consumes symbols one-by-one
-    if (!tags_vec.empty())
+    if (!d_timetag_reader.attached())
         {
-            for (const auto &it : tags_vec)
-                {
-                    try
-                        {
-                            if (pmt::any_ref(it.value).type().hash_code() == typeid(const std::shared_ptr<GnssTime>).hash_code())
-                                {
-                                    const auto timetag = boost::any_cast<const std::shared_ptr<GnssTime>>(pmt::any_ref(it.value));
-                                    // std::cout << "Old tow: " << d_current_timetag.tow_ms << " new tow: " << timetag->tow_ms << "\n";
-                                    d_current_timetag = *timetag;
-                                    d_valid_timetag = true;
-                                }
-                            else
-                                {
-                                    std::cout << "hash code not match\n";
-                                }
-                        }
-                    catch (const boost::bad_any_cast &e)
-                        {
-                            std::cout << "msg Bad any_cast: " << e.what();
-                        }
-                }
+            d_timetag_reader.attach(gnss_time_tag_input_channel(this, 0));
         }
-    else
+    GnssTime timetag{};
+    bool new_timetag = false;
+    while (d_timetag_reader.next(in_offset, in_offset + 1, timetag))  // tags of the current symbol only
+        {
+            // std::cout << "Old tow: " << d_current_timetag.tow_ms << " new tow: " << timetag.tow_ms << "\n";
+            d_current_timetag = timetag;
+            d_valid_timetag = true;
+            new_timetag = true;
+        }
+    if (!new_timetag)
         {
             if (d_valid_timetag == true)
                 {
@@ -709,7 +639,6 @@ int galileo_telemetry_decoder_gs::general_work(int noutput_items __attribute__((
                 }
         }
 
-    consume_each(1);
     d_flag_preamble = false;
 
     // check if there is a problem with the telemetry of the current satellite
@@ -734,17 +663,7 @@ int galileo_telemetry_decoder_gs::general_work(int noutput_items __attribute__((
                 if (d_symbol_history.size() > d_required_symbols)
                     {
                         // ******* preamble correlation ********
-                        for (int32_t i = 0; i < d_samples_per_preamble; i++)
-                            {
-                                if (d_symbol_history[i] < 0.0)  // symbols clipping
-                                    {
-                                        corr_value -= d_preamble_samples[i];
-                                    }
-                                else
-                                    {
-                                        corr_value += d_preamble_samples[i];
-                                    }
-                            }
+                        corr_value = d_preamble_correlator.correlation();
                         if (std::abs(corr_value) >= d_samples_per_preamble)
                             {
                                 d_preamble_index = d_sample_counter;  // record the preamble sample stamp
@@ -762,17 +681,7 @@ int galileo_telemetry_decoder_gs::general_work(int noutput_items __attribute__((
                 if (d_symbol_history.size() > d_required_symbols)
                     {
                         // ******* preamble correlation ********
-                        for (int32_t i = 0; i < d_samples_per_preamble; i++)
-                            {
-                                if (d_symbol_history[i] < 0.0)  // symbols clipping
-                                    {
-                                        corr_value -= d_preamble_samples[i];
-                                    }
-                                else
-                                    {
-                                        corr_value += d_preamble_samples[i];
-                                    }
-                            }
+                        corr_value = d_preamble_correlator.correlation();
                         if (std::abs(corr_value) >= d_samples_per_preamble)
                             {
                                 // check preamble separation
@@ -810,21 +719,10 @@ int galileo_telemetry_decoder_gs::general_work(int noutput_items __attribute__((
                     {
                         // call the decoder
                         // NEW Galileo page part is received
-                        // 0. fetch the symbols into an array
-                        if (d_flag_PLL_180_deg_phase_locked == false)  // normal PLL lock
-                            {
-                                for (uint32_t i = 0; i < d_frame_length_symbols; i++)
-                                    {
-                                        d_page_part_symbols[i] = d_symbol_history[i + d_samples_per_preamble];  // because last symbol of the preamble is just received now!
-                                    }
-                            }
-                        else  // 180 deg. inverted carrier phase PLL lock
-                            {
-                                for (uint32_t i = 0; i < d_frame_length_symbols; i++)
-                                    {
-                                        d_page_part_symbols[i] = -d_symbol_history[i + d_samples_per_preamble];  // because last symbol of the preamble is just received now!
-                                    }
-                            }
+                        // 0. fetch the symbols into an array, because last symbol of the preamble is just received now!
+                        // The 180 deg. inverted carrier phase PLL lock is corrected in the deinterleaving
+                        const auto first_symbol = std::next(d_symbol_history.begin(), d_samples_per_preamble);
+                        std::copy(first_symbol, std::next(first_symbol, d_frame_length_symbols), d_page_part_symbols.begin());
                         switch (d_frame_type)
                             {
                             case 1:  // INAV
@@ -1108,11 +1006,11 @@ int galileo_telemetry_decoder_gs::general_work(int noutput_items __attribute__((
                             uint64_t tmp_ulong_int;
                             int32_t tmp_int;
                             tmp_double = static_cast<double>(d_TOW_at_current_symbol_ms) / 1000.0;
-                            d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
+                            d_dump_file.write(tmp_double);
                             tmp_ulong_int = current_symbol.Tracking_sample_counter;
-                            d_dump_file.write(reinterpret_cast<char *>(&tmp_ulong_int), sizeof(uint64_t));
+                            d_dump_file.write(tmp_ulong_int);
                             tmp_double = static_cast<double>(d_TOW_at_Preamble_ms) / 1000.0;
-                            d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
+                            d_dump_file.write(tmp_double);
                             switch (d_frame_type)
                                 {
                                 case 1:
@@ -1128,9 +1026,9 @@ int galileo_telemetry_decoder_gs::general_work(int noutput_items __attribute__((
                                     tmp_int = 0;
                                     break;
                                 }
-                            d_dump_file.write(reinterpret_cast<char *>(&tmp_int), sizeof(int32_t));
+                            d_dump_file.write(tmp_int);
                             tmp_int = static_cast<int32_t>(current_symbol.PRN);
-                            d_dump_file.write(reinterpret_cast<char *>(&tmp_int), sizeof(int32_t));
+                            d_dump_file.write(tmp_int);
                         }
                     catch (const std::ifstream::failure &e)
                         {
@@ -1138,8 +1036,35 @@ int galileo_telemetry_decoder_gs::general_work(int noutput_items __attribute__((
                         }
                 }
             // 3. Make the output (copy the object contents to the GNURadio reserved memory)
-            *out[0] = current_symbol;
+            out_symbol = current_symbol;
             return 1;
         }
     return 0;
 }
+
+
+int galileo_telemetry_decoder_gs::general_work(int noutput_items, gr_vector_int &ninput_items,
+    gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
+{
+    auto **out = reinterpret_cast<Gnss_Synchro **>(&output_items[0]);            // Get the output buffer pointer
+    const auto **in = reinterpret_cast<const Gnss_Synchro **>(&input_items[0]);  // Get the input buffer pointer
+    const uint64_t first_in_offset = this->nitems_read(0);
+    const uint64_t first_out_offset = this->nitems_written(0);
+
+    // decode all the available symbols, each one producing at most one output
+    int32_t n_consumed = 0;
+    int32_t n_produced = 0;
+    while (n_consumed < ninput_items[0] && n_produced < noutput_items)
+        {
+            const int32_t produced = decode_symbol(in[0][n_consumed], out[0][n_produced], first_in_offset + n_consumed, first_out_offset + n_produced);
+            n_consumed++;
+            if (produced < 0)
+                {
+                    consume_each(n_consumed);
+                    return produced;
+                }
+            n_produced += produced;
+        }
+    consume_each(n_consumed);
+    return n_produced;
+}
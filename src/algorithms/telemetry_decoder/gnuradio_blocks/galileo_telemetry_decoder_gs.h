@@ -21,22 +21,27 @@
 #ifndef GNSS_SDR_GALILEO_TELEMETRY_DECODER_GS_H
 #define GNSS_SDR_GALILEO_TELEMETRY_DECODER_GS_H
 
-#include "galileo_cnav_message.h"     // for Galileo_Cnav_Message
-#include "galileo_fnav_message.h"     // for Galileo_Fnav_Message
-#include "galileo_inav_message.h"     // for Galileo_Inav_Message
-#include "gnss_block_interface.h"     // for gnss_shared_ptr (adapts smart pointer type to GNU Radio version)
-#include "gnss_satellite.h"           // for Gnss_Satellite
-#include "gnss_time.h"                // for GnssTime
-#include "nav_message_packet.h"       // for Nav_Message_Packet
-#include "tlm_conf.h"                 // for Tlm_Conf
-#include <boost/circular_buffer.hpp>  // for boost::circular_buffer
-#include <gnuradio/block.h>           // for block
-#include <gnuradio/types.h>           // for gr_vector_const_void_star
-#include <cstdint>                    // for int32_t, uint32_t
-#include <fstream>                    // for std::ofstream
-#include <memory>                     // for std::unique_ptr
-#include <string>                     // for std::string
-#include <vector>                     // for std::vector
+#include "galileo_cnav_message.h"      // for Galileo_Cnav_Message
+#include "galileo_fnav_message.h"      // for Galileo_Fnav_Message
+#include "galileo_inav_message.h"      // for Galileo_Inav_Message
+#include "gnss_block_interface.h"      // for gnss_shared_ptr (adapts smart pointer type to GNU Radio version)
+#include "gnss_dump_writer.h"          // for Gnss_Dump_Writer
+#include "gnss_nav_product_channel.h"  // for Gnss_Nav_Product_Channel
+#include "gnss_satellite.h"            // for Gnss_Satellite
+#include "gnss_sign_correlator.h"      // for Gnss_Sign_Correlator
+#include "gnss_synchro.h"              // for Gnss_Synchro
+#include "gnss_time.h"                 // for GnssTime
+#include "gnss_time_tag_channel.h"     // for Gnss_Time_Tag_Reader
+#include "nav_message_packet.h"        // for Nav_Message_Packet
+#include "tlm_conf.h"                  // for Tlm_Conf
+#include <boost/circular_buffer.hpp>   // for boost::circular_buffer
+#include <gnuradio/block.h>            // for block
+#include <gnuradio/types.h>            // for gr_vector_const_void_star
+#include <cstdint>                     // for int32_t, uint32_t
+#include <fstream>                     // for std::ofstream
+#include <memory>                      // for std::shared_ptr, std::unique_ptr
+#include <string>                      // for std::string
+#include <vector>                      // for std::vector
 
 /** \addtogroup Telemetry_Decoder
  * \{ */
@@ -45,6 +50,7 @@
 
 class Viterbi_Decoder;               // forward declaration
 class Tlm_CRC_Stats;                 // forward declaration
+class Tlm_Deinterleaver;             // forward declaration
 class galileo_telemetry_decoder_gs;  // forward declaration
 
 using galileo_telemetry_decoder_gs_sptr = gnss_shared_ptr<galileo_telemetry_decoder_gs>;
@@ -79,20 +85,25 @@ private:
         int frame_type);
 
     galileo_telemetry_decoder_gs(const Gnss_Satellite &satellite, const Tlm_Conf &conf, int frame_type);
+    int32_t decode_symbol(const Gnss_Synchro &in_symbol, Gnss_Synchro &out_symbol, uint64_t in_offset, uint64_t out_offset);  //!< Decodes one symbol. Returns 1 if out_symbol is produced, 0 if not, -1 on error
 
-    void deinterleaver(int32_t rows, int32_t cols, const float *in, float *out);
-    void decode_INAV_word(float *page_part_symbols, int32_t frame_length);
-    void decode_FNAV_word(float *page_symbols, int32_t frame_length);
-    void decode_CNAV_word(float *page_symbols, int32_t page_length);
+    void deinterleave(const float *page_symbols, int32_t frame_length);
+    void decode_INAV_word(const float *page_part_symbols, int32_t frame_length);
+    void decode_FNAV_word(const float *page_symbols, int32_t frame_length);
+    void decode_CNAV_word(const float *page_symbols, int32_t page_length);
 
     std::unique_ptr<Viterbi_Decoder> d_viterbi;
+    std::unique_ptr<Tlm_Deinterleaver> d_deinterleaver;
     std::vector<int32_t> d_preamble_samples;
     std::vector<float> d_page_part_symbols;
+    std::vector<float> d_page_part_symbols_soft_value;
+    std::vector<int32_t> d_page_part_bits;
 
     std::string d_dump_filename;
-    std::ofstream d_dump_file;
+    Gnss_Dump_Writer d_dump_file;
 
     boost::circular_buffer<float> d_symbol_history;
+    Gnss_Sign_Correlator d_preamble_correlator;  // signs of d_symbol_history
 
     Gnss_Satellite d_satellite;
 
@@ -103,8 +114,10 @@ private:
 
     Nav_Message_Packet d_nav_msg_packet;
     GnssTime d_current_timetag{};
+    Gnss_Time_Tag_Reader d_timetag_reader;  // time tags produced by Tracking
 
     std::unique_ptr<Tlm_CRC_Stats> d_Tlm_CRC_Stats;
+    std::shared_ptr<Gnss_Nav_Product_Channel> d_nav_product_channel;  // navigation data delivered to the PVT block
 
     double d_delta_t;  // GPS-GALILEO time offset
 
@@ -65,8 +65,8 @@ glonass_l1_ca_telemetry_decoder_gs::glonass_l1_ca_telemetry_decoder_gs(
 {
     // prevent telemetry symbols accumulation in output buffers
     this->set_max_noutput_items(1);
-    // Ephemeris data port out
-    this->message_port_register_out(pmt::mp("telemetry"));
+    // Ephemeris data channel out
+    d_nav_product_channel = Gnss_Nav_Product_Channel::create();
     // Control messages to tracking block
     this->message_port_register_out(pmt::mp("telemetry_to_trk"));
 
@@ -120,7 +120,7 @@ glonass_l1_ca_telemetry_decoder_gs::~glonass_l1_ca_telemetry_decoder_gs()
     size_t pos = 0;
     if (d_dump_file.is_open() == true)
         {
-            pos = d_dump_file.tellp();
+            pos = d_dump_file.bytes_written();
             try
                 {
                     d_dump_file.close();
@@ -235,7 +235,7 @@ void glonass_l1_ca_telemetry_decoder_gs::decode_string(const double *frame_symbo
             // get object for this SV (mandatory)
             d_nav.set_rf_link(d_satellite.get_rf_link());
             const std::shared_ptr<Glonass_Gnav_Ephemeris> tmp_obj = std::make_shared<Glonass_Gnav_Ephemeris>(d_nav.get_ephemeris());
-            this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+            d_nav_product_channel->push(Gnss_Nav_Product(tmp_obj));
             LOG(INFO) << "GLONASS GNAV Ephemeris have been received in channel" << d_channel << " from satellite " << d_satellite;
             std::cout << "New GLONASS L1 GNAV message received in channel " << d_channel << ": ephemeris from satellite " << d_satellite << '\n';
         }
@@ -243,7 +243,7 @@ void glonass_l1_ca_telemetry_decoder_gs::decode_string(const double *frame_symbo
         {
             // get object for this SV (mandatory)
             const std::shared_ptr<Glonass_Gnav_Utc_Model> tmp_obj = std::make_shared<Glonass_Gnav_Utc_Model>(d_nav.get_utc_model());
-            this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+            d_nav_product_channel->push(Gnss_Nav_Product(tmp_obj));
             LOG(INFO) << "GLONASS GNAV UTC Model data have been received in channel" << d_channel << " from satellite " << d_satellite;
             std::cout << "New GLONASS L1 GNAV message received in channel " << d_channel << ": UTC model parameters from satellite " << d_satellite << '\n';
         }
@@ -252,7 +252,7 @@ void glonass_l1_ca_telemetry_decoder_gs::decode_string(const double *frame_symbo
             const uint32_t slot_nbr = d_nav.get_alm_satellite_slot_number();
             const std::shared_ptr<Glonass_Gnav_Almanac>
                 tmp_obj = std::make_shared<Glonass_Gnav_Almanac>(d_nav.get_almanac(slot_nbr));
-            this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+            d_nav_product_channel->push(Gnss_Nav_Product(tmp_obj));
             LOG(INFO) << "GLONASS GNAV Almanac data have been received in channel" << d_channel << " in slot number " << slot_nbr;
             std::cout << "New GLONASS L1 GNAV almanac received in channel " << d_channel << " from satellite " << d_satellite << '\n';
         }
@@ -288,8 +288,7 @@ void glonass_l1_ca_telemetry_decoder_gs::set_channel(int32_t channel)
                         {
                             d_dump_filename.append(std::to_string(d_channel));
                             d_dump_filename.append(".dat");
-                            d_dump_file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-                            d_dump_file.open(d_dump_filename.c_str(), std::ios::out | std::ios::binary);
+                            d_dump_file.open(d_dump_filename);
                             LOG(INFO) << "Telemetry decoder dump enabled on channel " << d_channel << " Log file: " << d_dump_filename.c_str();
                         }
                     catch (const std::ifstream::failure &e)
@@ -307,21 +306,17 @@ void glonass_l1_ca_telemetry_decoder_gs::set_channel(int32_t channel)
 }
 
 
-int glonass_l1_ca_telemetry_decoder_gs::general_work(int noutput_items __attribute__((unused)), gr_vector_int &ninput_items __attribute__((unused)),
-    gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
+bool glonass_l1_ca_telemetry_decoder_gs::decode_symbol(const Gnss_Synchro &in_symbol, Gnss_Synchro &out_symbol)
 {
     int32_t corr_value = 0;
     int32_t preamble_diff = 0;
 
-    auto **out = reinterpret_cast<Gnss_Synchro **>(&output_items[0]);            // Get the output buffer pointer
-    const auto **in = reinterpret_cast<const Gnss_Synchro **>(&input_items[0]);  // Get the input buffer pointer
 
     Gnss_Synchro current_symbol{};  // structure to save the synchronization information and send the output object to the next block
     // 1. Copy the current tracking output
-    current_symbol = in[0][0];
+    current_symbol = in_symbol;
     d_symbol_history.push_back(current_symbol);  // add new symbol to the symbol queue
     d_sample_counter++;                          // count for the processed samples
-    consume_each(1);
 
     d_flag_preamble = false;
 
@@ -483,15 +478,15 @@ int glonass_l1_ca_telemetry_decoder_gs::general_work(int noutput_items __attribu
                     uint64_t tmp_ulong_int;
                     int32_t tmp_int;
                     tmp_double = d_TOW_at_current_symbol;
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
+                    d_dump_file.write(tmp_double);
                     tmp_ulong_int = current_symbol.Tracking_sample_counter;
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_ulong_int), sizeof(uint64_t));
+                    d_dump_file.write(tmp_ulong_int);
                     tmp_double = 0;
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
+                    d_dump_file.write(tmp_double);
                     tmp_int = (current_symbol.Prompt_I > 0.0 ? 1 : -1);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_int), sizeof(int32_t));
+                    d_dump_file.write(tmp_int);
                     tmp_int = static_cast<int32_t>(current_symbol.PRN);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_int), sizeof(int32_t));
+                    d_dump_file.write(tmp_int);
                 }
             catch (const std::ifstream::failure &e)
                 {
@@ -500,7 +495,29 @@ int glonass_l1_ca_telemetry_decoder_gs::general_work(int noutput_items __attribu
         }
 
     // 3. Make the output (copy the object contents to the GNURadio reserved memory)
-    *out[0] = current_symbol;
+    out_symbol = current_symbol;
+
+    return true;
+}
+
 
-    return 1;
+int glonass_l1_ca_telemetry_decoder_gs::general_work(int noutput_items, gr_vector_int &ninput_items,
+    gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
+{
+    auto **out = reinterpret_cast<Gnss_Synchro **>(&output_items[0]);            // Get the output buffer pointer
+    const auto **in = reinterpret_cast<const Gnss_Synchro **>(&input_items[0]);  // Get the input buffer pointer
+
+    // decode all the available symbols, each one producing at most one output
+    int32_t n_consumed = 0;
+    int32_t n_produced = 0;
+    while (n_consumed < ninput_items[0] && n_produced < noutput_items)
+        {
+            if (decode_symbol(in[0][n_consumed], out[0][n_produced]))
+                {
+                    n_produced++;
+                }
+            n_consumed++;
+        }
+    consume_each(n_consumed);
+    return n_produced;
 }
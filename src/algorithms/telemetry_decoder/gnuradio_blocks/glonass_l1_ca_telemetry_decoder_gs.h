@@ -22,6 +22,8 @@
 #include "GLONASS_L1_L2_CA.h"
 #include "glonass_gnav_navigation_message.h"
 #include "gnss_block_interface.h"
+#include "gnss_dump_writer.h"
+#include "gnss_nav_product_channel.h"
 #include "gnss_satellite.h"
 #include "gnss_synchro.h"
 #include "nav_message_packet.h"
@@ -33,7 +35,7 @@
 #include <array>
 #include <cstdint>
 #include <fstream>  // for ofstream
-#include <memory>   // for std::unique_ptr
+#include <memory>   // for std::shared_ptr, std::unique_ptr
 #include <string>
 
 /** \addtogroup Telemetry_Decoder
@@ -76,6 +78,7 @@ private:
         const Tlm_Conf &conf);
 
     glonass_l1_ca_telemetry_decoder_gs(const Gnss_Satellite &satellite, const Tlm_Conf &conf);
+    bool decode_symbol(const Gnss_Synchro &in_symbol, Gnss_Synchro &out_symbol);  //!< Decodes one symbol. Returns true if out_symbol is produced
 
     const std::array<uint16_t, GLONASS_GNAV_PREAMBLE_LENGTH_BITS> d_preambles_bits{GLONASS_GNAV_PREAMBLE};
 
@@ -98,9 +101,10 @@ private:
 
     Nav_Message_Packet d_nav_msg_packet;
     std::unique_ptr<Tlm_CRC_Stats> d_Tlm_CRC_Stats;
+    std::shared_ptr<Gnss_Nav_Product_Channel> d_nav_product_channel;  // navigation data delivered to the PVT block
 
     std::string d_dump_filename;
-    std::ofstream d_dump_file;
+    Gnss_Dump_Writer d_dump_file;
 
     double d_preamble_time_samples;
     double d_TOW_at_current_symbol;
@@ -90,8 +90,8 @@ gps_l1_ca_telemetry_decoder_gs::gps_l1_ca_telemetry_decoder_gs(
 {
     // prevent telemetry symbols accumulation in output buffers
     this->set_max_noutput_items(1);
-    // Ephemeris data port out
-    this->message_port_register_out(pmt::mp("telemetry"));
+    // Ephemeris data channel out
+    d_nav_product_channel = Gnss_Nav_Product_Channel::create();
     // Control messages to tracking block
     this->message_port_register_out(pmt::mp("telemetry_to_trk"));
 
@@ -124,6 +124,7 @@ gps_l1_ca_telemetry_decoder_gs::gps_l1_ca_telemetry_decoder_gs(
         }
 
     d_symbol_history.set_capacity(d_required_symbols);
+    d_preamble_correlator = Gnss_Sign_Correlator(std::vector<int32_t>(d_preamble_samples.cbegin(), d_preamble_samples.cend()), d_required_symbols);
 
     set_tag_propagation_policy(TPP_DONT);  // no tag propagation, the time tag will be adjusted and regenerated in work()
 
@@ -146,7 +147,7 @@ gps_l1_ca_telemetry_decoder_gs::~gps_l1_ca_telemetry_decoder_gs()
     size_t pos = 0;
     if (d_dump_file.is_open() == true)
         {
-            pos = d_dump_file.tellp();
+            pos = d_dump_file.bytes_written();
             try
                 {
                     d_dump_file.close();
@@ -227,8 +228,7 @@ void gps_l1_ca_telemetry_decoder_gs::set_channel(int32_t channel)
                         {
                             d_dump_filename.append(std::to_string(d_channel));
                             d_dump_filename.append(".dat");
-                            d_dump_file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-                            d_dump_file.open(d_dump_filename.c_str(), std::ios::out | std::ios::binary);
+                            d_dump_file.open(d_dump_filename);
                             LOG(INFO) << "Telemetry decoder dump enabled on channel " << d_channel
                                       << " Log file: " << d_dump_filename.c_str();
                         }
@@ -355,7 +355,7 @@ bool gps_l1_ca_telemetry_decoder_gs::decode_subframe(bool flag_invert)
                                 {
                                     // get ephemeris object for this SV (mandatory)
                                     const std::shared_ptr<Gps_Ephemeris> tmp_obj = std::make_shared<Gps_Ephemeris>(d_nav.get_ephemeris());
-                                    this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+                                    d_nav_product_channel->push(Gnss_Nav_Product(tmp_obj));
                                 }
 
                             break;
@@ -364,7 +364,7 @@ bool gps_l1_ca_telemetry_decoder_gs::decode_subframe(bool flag_invert)
                                 {
                                     // get ephemeris object for this SV (mandatory)
                                     const std::shared_ptr<Gps_Ephemeris> tmp_obj = std::make_shared<Gps_Ephemeris>(d_nav.get_ephemeris());
-                                    this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+                                    d_nav_product_channel->push(Gnss_Nav_Product(tmp_obj));
                                 }
 
                             break;
@@ -373,19 +373,19 @@ bool gps_l1_ca_telemetry_decoder_gs::decode_subframe(bool flag_invert)
                                 {
                                     // get ephemeris object for this SV (mandatory)
                                     const std::shared_ptr<Gps_Ephemeris> tmp_obj = std::make_shared<Gps_Ephemeris>(d_nav.get_ephemeris());
-                                    this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+                                    d_nav_product_channel->push(Gnss_Nav_Product(tmp_obj));
                                 }
                             break;
                         case 4:  // Possible IONOSPHERE and UTC model update (page 18)
                             if (d_nav.get_flag_iono_valid() == true)
                                 {
                                     const std::shared_ptr<Gps_Iono> tmp_obj = std::make_shared<Gps_Iono>(d_nav.get_iono());
-                                    this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+                                    d_nav_product_channel->push(Gnss_Nav_Product(tmp_obj));
                                 }
                             if (d_nav.get_flag_utc_model_valid() == true)
                                 {
                                     const std::shared_ptr<Gps_Utc_Model> tmp_obj = std::make_shared<Gps_Utc_Model>(d_nav.get_utc_model());
-                                    this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+                                    d_nav_product_channel->push(Gnss_Nav_Product(tmp_obj));
                                 }
                             break;
                         case 5:
@@ -408,20 +408,17 @@ void gps_l1_ca_telemetry_decoder_gs::reset()
     d_sent_tlm_failed_msg = false;
     d_flag_TOW_set = false;
     d_symbol_history.clear();
+    d_preamble_correlator.clear();
     d_stat = 0;
     DLOG(INFO) << "Telemetry decoder reset for satellite " << d_satellite;
 }
 
 
-int gps_l1_ca_telemetry_decoder_gs::general_work(int noutput_items __attribute__((unused)), gr_vector_int &ninput_items __attribute__((unused)),
-    gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
+bool gps_l1_ca_telemetry_decoder_gs::decode_symbol(const Gnss_Synchro &in_symbol, Gnss_Synchro &out_symbol, uint64_t in_offset, uint64_t out_offset)
 {
-    auto **out = reinterpret_cast<Gnss_Synchro **>(&output_items[0]);            // Get the output buffer pointer
-    const auto **in = reinterpret_cast<const Gnss_Synchro **>(&input_items[0]);  // Get the input buffer pointer
-
     Gnss_Synchro current_symbol{};
     // 1. Copy the current tracking output
-    current_symbol = in[0][0];
+    current_symbol = in_symbol;
     if (d_symbol_history.empty())
         {
             // Tracking synchronizes the tlm bit boundaries by acquiring the preamble
@@ -432,19 +429,21 @@ int gps_l1_ca_telemetry_decoder_gs::general_work(int noutput_items __attribute__
                     if (current_symbol.Flag_PLL_180_deg_phase_locked == true)
                         {
                             d_symbol_history.push_back(static_cast<float>(-d_preamble_samples[i]));
+                            d_preamble_correlator.push(static_cast<float>(-d_preamble_samples[i]));
                         }
                     else
                         {
                             d_symbol_history.push_back(static_cast<float>(d_preamble_samples[i]));
+                            d_preamble_correlator.push(static_cast<float>(d_preamble_samples[i]));
                         }
                     d_sample_counter++;
                 }
         }
     // add new symbol to the symbol queue
     d_symbol_history.push_back(current_symbol.Prompt_I);
+    d_preamble_correlator.push(current_symbol.Prompt_I);
 
     d_sample_counter++;  // count for the processed symbols
-    consume_each(1);
     d_flag_preamble = false;
     // check if there is a problem with the telemetry of the current satellite
     if (d_stat < 2 && d_sent_tlm_failed_msg == false)
@@ -467,17 +466,7 @@ int gps_l1_ca_telemetry_decoder_gs::general_work(int noutput_items __attribute__
                 if (d_symbol_history.size() >= d_required_symbols)
                     {
                         // ******* preamble correlation ********
-                        for (int32_t i = 0; i < GPS_CA_PREAMBLE_LENGTH_BITS; i++)
-                            {
-                                if (d_symbol_history[i] < 0.0)  // symbols clipping
-                                    {
-                                        corr_value -= d_preamble_samples[i];
-                                    }
-                                else
-                                    {
-                                        corr_value += d_preamble_samples[i];
-                                    }
-                            }
+                        corr_value = d_preamble_correlator.correlation();
                     }
                 if (abs(corr_value) >= d_samples_per_preamble)
                     {
@@ -597,28 +586,17 @@ int gps_l1_ca_telemetry_decoder_gs::general_work(int noutput_items __attribute__
                 }
 
             // time tags
-            std::vector<gr::tag_t> tags_vec;
-            this->get_tags_in_range(tags_vec, 0, this->nitems_read(0), this->nitems_read(0) + 1);
-            for (const auto &it : tags_vec)
+            if (!d_timetag_reader.attached())
                 {
-                    try
-                        {
-                            if (pmt::any_ref(it.value).type().hash_code() == typeid(const std::shared_ptr<GnssTime>).hash_code())
-                                {
-                                    const auto timetag = boost::any_cast<const std::shared_ptr<GnssTime>>(pmt::any_ref(it.value));
-                                    // std::cout << "[" << this->nitems_written(0) + 1 << "] TLM RX TimeTag Week: " << timetag->week << ", TOW: " << timetag->tow_ms << " [ms], TOW fraction: " << timetag->tow_ms_fraction
-                                    //           << " [ms], DELTA TLM TOW: " << static_cast<double>(timetag->tow_ms - current_symbol.TOW_at_current_symbol_ms) + timetag->tow_ms_fraction << " [ms] \n";
-                                    add_item_tag(0, this->nitems_written(0) + 1, pmt::mp("timetag"), pmt::make_any(timetag));
-                                }
-                            else
-                                {
-                                    std::cout << "hash code not match\n";
-                                }
-                        }
-                    catch (const boost::bad_any_cast &e)
-                        {
-                            std::cout << "msg Bad any_cast: " << e.what();
-                        }
+                    d_timetag_reader.attach(gnss_time_tag_input_channel(this, 0));
+                    d_timetag_channel = gnss_time_tag_output_channel(this, 0);
+                }
+            GnssTime timetag{};
+            while (d_timetag_reader.next(in_offset, in_offset + 1, timetag))
+                {
+                    // std::cout << "[" << out_offset + 1 << "] TLM RX TimeTag Week: " << timetag.week << ", TOW: " << timetag.tow_ms << " [ms], TOW fraction: " << timetag.tow_ms_fraction
+                    //           << " [ms], DELTA TLM TOW: " << static_cast<double>(timetag.tow_ms - current_symbol.TOW_at_current_symbol_ms) + timetag.tow_ms_fraction << " [ms] \n";
+                    d_timetag_channel->push(out_offset + 1, timetag);
                 }
 
             if (d_dump == true)
@@ -630,15 +608,15 @@ int gps_l1_ca_telemetry_decoder_gs::general_work(int noutput_items __attribute__
                             uint64_t tmp_ulong_int;
                             int32_t tmp_int;
                             tmp_double = static_cast<double>(d_TOW_at_current_symbol_ms) / 1000.0;
-                            d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
+                            d_dump_file.write(tmp_double);
                             tmp_ulong_int = current_symbol.Tracking_sample_counter;
-                            d_dump_file.write(reinterpret_cast<char *>(&tmp_ulong_int), sizeof(uint64_t));
+                            d_dump_file.write(tmp_ulong_int);
                             tmp_double = static_cast<double>(d_TOW_at_Preamble_ms) / 1000.0;
-                            d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
+                            d_dump_file.write(tmp_double);
                             tmp_int = (current_symbol.Prompt_I > 0.0 ? 1 : -1);
-                            d_dump_file.write(reinterpret_cast<char *>(&tmp_int), sizeof(int32_t));
+                            d_dump_file.write(tmp_int);
                             tmp_int = static_cast<int32_t>(current_symbol.PRN);
-                            d_dump_file.write(reinterpret_cast<char *>(&tmp_int), sizeof(int32_t));
+                            d_dump_file.write(tmp_int);
                         }
                     catch (const std::ifstream::failure &e)
                         {
@@ -647,10 +625,34 @@ int gps_l1_ca_telemetry_decoder_gs::general_work(int noutput_items __attribute__
                 }
 
             // 3. Make the output (copy the object contents to the GNU Radio reserved memory)
-            *out[0] = current_symbol;
+            out_symbol = current_symbol;
 
-            return 1;
+            return true;
         }
 
-    return 0;
+    return false;
+}
+
+
+int gps_l1_ca_telemetry_decoder_gs::general_work(int noutput_items, gr_vector_int &ninput_items,
+    gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
+{
+    auto **out = reinterpret_cast<Gnss_Synchro **>(&output_items[0]);            // Get the output buffer pointer
+    const auto **in = reinterpret_cast<const Gnss_Synchro **>(&input_items[0]);  // Get the input buffer pointer
+    const uint64_t first_in_offset = this->nitems_read(0);
+    const uint64_t first_out_offset = this->nitems_written(0);
+
+    // decode all the available symbols, each one producing at most one output
+    int32_t n_consumed = 0;
+    int32_t n_produced = 0;
+    while (n_consumed < ninput_items[0] && n_produced < noutput_items)
+        {
+            if (decode_symbol(in[0][n_consumed], out[0][n_produced], first_in_offset + n_consumed, first_out_offset + n_produced))
+                {
+                    n_produced++;
+                }
+            n_consumed++;
+        }
+    consume_each(n_consumed);
+    return n_produced;
 }
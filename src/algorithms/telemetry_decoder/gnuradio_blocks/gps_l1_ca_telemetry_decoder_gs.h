@@ -18,9 +18,13 @@
 #define GNSS_SDR_GPS_L1_CA_TELEMETRY_DECODER_GS_H
 #include "GPS_L1_CA.h"
 #include "gnss_block_interface.h"
+#include "gnss_dump_writer.h"
+#include "gnss_nav_product_channel.h"
 #include "gnss_satellite.h"
+#include "gnss_sign_correlator.h"
 #include "gnss_synchro.h"
 #include "gnss_time.h"  // for timetags produced by Tracking
+#include "gnss_time_tag_channel.h"
 #include "gps_navigation_message.h"
 #include "nav_message_packet.h"
 #include "tlm_conf.h"
@@ -31,7 +35,7 @@
 #include <array>             // for array
 #include <cstdint>           // for int32_t
 #include <fstream>           // for ofstream
-#include <memory>            // for std::unique_ptr
+#include <memory>            // for std::shared_ptr, std::unique_ptr
 #include <string>            // for string
 
 /** \addtogroup Telemetry_Decoder
@@ -72,6 +76,7 @@ private:
         const Tlm_Conf &conf);
 
     gps_l1_ca_telemetry_decoder_gs(const Gnss_Satellite &satellite, const Tlm_Conf &conf);
+    bool decode_symbol(const Gnss_Synchro &in_symbol, Gnss_Synchro &out_symbol, uint64_t in_offset, uint64_t out_offset);  //!< Decodes one symbol. Returns true if out_symbol is produced
 
     bool gps_word_parityCheck(uint32_t gpsword);
     bool decode_subframe(bool flag_invert);
@@ -80,13 +85,18 @@ private:
     Gnss_Satellite d_satellite;
     Nav_Message_Packet d_nav_msg_packet;
     std::unique_ptr<Tlm_CRC_Stats> d_Tlm_CRC_Stats;
+    std::shared_ptr<Gnss_Nav_Product_Channel> d_nav_product_channel;  // navigation data delivered to the PVT block
 
     std::array<int32_t, GPS_CA_PREAMBLE_LENGTH_BITS> d_preamble_samples{};
 
     std::string d_dump_filename;
-    std::ofstream d_dump_file;
+    Gnss_Dump_Writer d_dump_file;
 
     boost::circular_buffer<float> d_symbol_history;
+    Gnss_Sign_Correlator d_preamble_correlator;  // signs of d_symbol_history
+
+    Gnss_Time_Tag_Reader d_timetag_reader;                    // time tags produced by Tracking
+    std::shared_ptr<Gnss_Time_Tag_Channel> d_timetag_channel;  // time tags propagated to the output
 
     uint64_t d_sample_counter;
     uint64_t d_preamble_index;
@@ -19,7 +19,10 @@
 
 
 #include "gnss_block_interface.h"
+#include "gnss_dump_writer.h"
+#include "gnss_nav_product_channel.h"
 #include "gnss_satellite.h"
+#include "gnss_synchro.h"
 #include "gps_cnav_navigation_message.h"
 #include "nav_message_packet.h"
 #include "tlm_conf.h"
@@ -28,8 +31,9 @@
 #include <gnuradio/types.h>  // for gr_vector_const_void_star
 #include <cstdint>
 #include <fstream>
-#include <memory>  // for std::unique_ptr
+#include <memory>  // for std::shared_ptr, std::unique_ptr
 #include <string>
+#include <vector>
 
 extern "C"
 {
@@ -73,18 +77,21 @@ private:
         const Tlm_Conf &conf);
 
     gps_l2c_telemetry_decoder_gs(const Gnss_Satellite &satellite, const Tlm_Conf &conf);
+    bool decode_symbol(const Gnss_Synchro &in_symbol, Gnss_Synchro &out_symbol, bool flag_new_cnav_frame, const cnav_msg_t &msg, uint32_t delay);  //!< Processes one symbol already fed to the decoder. Returns true if out_symbol is produced
 
     Gnss_Satellite d_satellite;
 
     cnav_msg_decoder_t d_cnav_decoder{};
+    std::vector<uint8_t> d_symbols;  // hard symbols of the items of the current general_work call
 
     Gps_CNAV_Navigation_Message d_CNAV_Message;
 
     Nav_Message_Packet d_nav_msg_packet;
     std::unique_ptr<Tlm_CRC_Stats> d_Tlm_CRC_Stats;
+    std::shared_ptr<Gnss_Nav_Product_Channel> d_nav_product_channel;  // navigation data delivered to the PVT block
 
     std::string d_dump_filename;
-    std::ofstream d_dump_file;
+    Gnss_Dump_Writer d_dump_file;
 
     double d_TOW_at_current_symbol;
     double d_TOW_at_Preamble;
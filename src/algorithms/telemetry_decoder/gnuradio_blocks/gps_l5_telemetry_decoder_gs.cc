@@ -27,6 +27,7 @@
 #include <gnuradio/io_signature.h>
 #include <pmt/pmt.h>        // for make_any
 #include <pmt/pmt_sugar.h>  // for mp
+#include <algorithm>        // for std::min
 #include <bitset>           // for std::bitset
 #include <cstddef>          // for size_t
 #include <cstdlib>          // for std::llabs
@@ -62,8 +63,8 @@ gps_l5_telemetry_decoder_gs::gps_l5_telemetry_decoder_gs(
 {
     // prevent telemetry symbols accumulation in output buffers
     this->set_max_noutput_items(1);
-    // Ephemeris data port out
-    this->message_port_register_out(pmt::mp("telemetry"));
+    // Ephemeris data channel out
+    d_nav_product_channel = Gnss_Nav_Product_Channel::create();
     // Control messages to tracking block
     this->message_port_register_out(pmt::mp("telemetry_to_trk"));
 
@@ -102,7 +103,7 @@ gps_l5_telemetry_decoder_gs::~gps_l5_telemetry_decoder_gs()
     size_t pos = 0;
     if (d_dump_file.is_open() == true)
         {
-            pos = d_dump_file.tellp();
+            pos = d_dump_file.bytes_written();
             try
                 {
                     d_dump_file.close();
@@ -155,8 +156,7 @@ void gps_l5_telemetry_decoder_gs::set_channel(int32_t channel)
                         {
                             d_dump_filename.append(std::to_string(d_channel));
                             d_dump_filename.append(".dat");
-                            d_dump_file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-                            d_dump_file.open(d_dump_filename.c_str(), std::ios::out | std::ios::binary);
+                            d_dump_file.open(d_dump_filename);
                             LOG(INFO) << "Telemetry decoder dump enabled on channel " << d_channel
                                       << " Log file: " << d_dump_filename.c_str();
                         }
@@ -186,18 +186,12 @@ void gps_l5_telemetry_decoder_gs::reset()
 }
 
 
-int gps_l5_telemetry_decoder_gs::general_work(int noutput_items __attribute__((unused)), gr_vector_int &ninput_items __attribute__((unused)),
-    gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
+bool gps_l5_telemetry_decoder_gs::decode_symbol(const Gnss_Synchro &in_symbol, Gnss_Synchro &out_symbol, bool flag_new_cnav_frame, const cnav_msg_t &msg, uint32_t delay)
 {
-    // get pointers on in- and output gnss-synchro objects
-    auto *out = reinterpret_cast<Gnss_Synchro *>(output_items[0]);            // Get the output buffer pointer
-    const auto *in = reinterpret_cast<const Gnss_Synchro *>(input_items[0]);  // Get the input buffer pointer
-
     // UPDATE GNSS SYNCHRO DATA
     Gnss_Synchro current_synchro_data{};  // structure to save the synchronization information and send the output object to the next block
     // 1. Copy the current tracking output
-    current_synchro_data = in[0];
-    consume_each(1);  // one by one
+    current_synchro_data = in_symbol;
 
     // check if there is a problem with the telemetry of the current satellite
     d_sample_counter++;  // count for the processed symbols
@@ -211,21 +205,9 @@ int gps_l5_telemetry_decoder_gs::general_work(int noutput_items __attribute__((u
                 }
         }
 
-    cnav_msg_t msg;
-    uint32_t delay;
-    const auto symbol_clip = static_cast<uint8_t>(current_synchro_data.Prompt_Q > 0) * 255;
     // 2. Add the telemetry decoder information
     // check if new CNAV frame is available
-    bool new_page = cnav_msg_decoder_add_symbol(&d_cnav_decoder, symbol_clip, &msg, &delay);
-    if (d_dump_crc_stats && (d_cnav_decoder.part1.message_lock || d_cnav_decoder.part2.message_lock))
-        {
-            // update CRC statistics
-            d_Tlm_CRC_Stats->update_CRC_stats((d_cnav_decoder.part1.crc_ok || d_cnav_decoder.part2.crc_ok));
-            d_cnav_decoder.part1.message_lock = false;
-            d_cnav_decoder.part2.message_lock = false;
-        }
-
-    if (new_page)
+    if (flag_new_cnav_frame)
         {
             if (d_cnav_decoder.part1.invert == true || d_cnav_decoder.part2.invert == true)
                 {
@@ -255,20 +237,20 @@ int gps_l5_telemetry_decoder_gs::general_work(int noutput_items __attribute__((u
                     // get ephemeris object for this SV
                     const std::shared_ptr<Gps_CNAV_Ephemeris> tmp_obj = std::make_shared<Gps_CNAV_Ephemeris>(d_CNAV_Message.get_ephemeris());
                     std::cout << TEXT_MAGENTA << "New GPS L5 CNAV message received in channel " << d_channel << ": ephemeris from satellite " << d_satellite << TEXT_RESET << '\n';
-                    this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+                    d_nav_product_channel->push(Gnss_Nav_Product(tmp_obj));
                 }
             if (d_CNAV_Message.have_new_iono() == true)
                 {
                     const std::shared_ptr<Gps_CNAV_Iono> tmp_obj = std::make_shared<Gps_CNAV_Iono>(d_CNAV_Message.get_iono());
                     std::cout << TEXT_MAGENTA << "New GPS L5 CNAV message received in channel " << d_channel << ": iono model parameters from satellite " << d_satellite << TEXT_RESET << '\n';
-                    this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+                    d_nav_product_channel->push(Gnss_Nav_Product(tmp_obj));
                 }
 
             if (d_CNAV_Message.have_new_utc_model() == true)
                 {
                     const std::shared_ptr<Gps_CNAV_Utc_Model> tmp_obj = std::make_shared<Gps_CNAV_Utc_Model>(d_CNAV_Message.get_utc_model());
                     std::cout << TEXT_MAGENTA << "New GPS L5 CNAV message received in channel " << d_channel << ": UTC model parameters from satellite " << d_satellite << TEXT_RESET << '\n';
-                    this->message_port_pub(pmt::mp("telemetry"), pmt::make_any(tmp_obj));
+                    d_nav_product_channel->push(Gnss_Nav_Product(tmp_obj));
                 }
 
             // update TOW at the preamble instant
@@ -342,15 +324,15 @@ int gps_l5_telemetry_decoder_gs::general_work(int noutput_items __attribute__((u
                             uint64_t tmp_ulong_int;
                             int32_t tmp_int;
                             tmp_double = static_cast<double>(d_TOW_at_current_symbol_ms) / 1000.0;
-                            d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
+                            d_dump_file.write(tmp_double);
                             tmp_ulong_int = current_synchro_data.Tracking_sample_counter;
-                            d_dump_file.write(reinterpret_cast<char *>(&tmp_ulong_int), sizeof(uint64_t));
+                            d_dump_file.write(tmp_ulong_int);
                             tmp_double = static_cast<double>(d_TOW_at_Preamble_ms) / 1000.0;
-                            d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
+                            d_dump_file.write(tmp_double);
                             tmp_int = (current_synchro_data.Prompt_Q > 0.0 ? 1 : -1);
-                            d_dump_file.write(reinterpret_cast<char *>(&tmp_int), sizeof(int32_t));
+                            d_dump_file.write(tmp_int);
                             tmp_int = static_cast<int32_t>(current_synchro_data.PRN);
-                            d_dump_file.write(reinterpret_cast<char *>(&tmp_int), sizeof(int32_t));
+                            d_dump_file.write(tmp_int);
                         }
                     catch (const std::ifstream::failure &e)
                         {
@@ -359,8 +341,55 @@ int gps_l5_telemetry_decoder_gs::general_work(int noutput_items __attribute__((u
                 }
 
             // 3. Make the output (copy the object contents to the GNURadio reserved memory)
-            out[0] = current_synchro_data;
-            return 1;
+            out_symbol = current_synchro_data;
+            return true;
+        }
+    return false;
+}
+
+
+int gps_l5_telemetry_decoder_gs::general_work(int noutput_items, gr_vector_int &ninput_items,
+    gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
+{
+    auto **out = reinterpret_cast<Gnss_Synchro **>(&output_items[0]);            // Get the output buffer pointer
+    const auto **in = reinterpret_cast<const Gnss_Synchro **>(&input_items[0]);  // Get the input buffer pointer
+
+    // the decoder takes the symbols in runs, up to the next decoding block,
+    // and each symbol produces at most one output
+    const int32_t n_available = ninput_items[0];
+    d_symbols.resize(n_available);
+    for (int32_t i = 0; i < n_available; i++)
+        {
+            d_symbols[i] = static_cast<uint8_t>(in[0][i].Prompt_Q > 0) * 255;
+        }
+
+    int32_t n_consumed = 0;
+    int32_t n_produced = 0;
+    while (n_consumed < n_available && n_produced < noutput_items)
+        {
+            cnav_msg_t msg{};
+            uint32_t delay = 0;
+            bool flag_new_cnav_frame = false;
+            const int32_t n_symbols = std::min(n_available - n_consumed, noutput_items - n_produced);
+            const auto n_run = static_cast<int32_t>(cnav_msg_decoder_add_symbols(&d_cnav_decoder,
+                &d_symbols[n_consumed], n_symbols, &msg, &delay, &flag_new_cnav_frame));
+            if (d_dump_crc_stats && (d_cnav_decoder.part1.message_lock || d_cnav_decoder.part2.message_lock))
+                {
+                    // update CRC statistics
+                    d_Tlm_CRC_Stats->update_CRC_stats((d_cnav_decoder.part1.crc_ok || d_cnav_decoder.part2.crc_ok));
+                    d_cnav_decoder.part1.message_lock = false;
+                    d_cnav_decoder.part2.message_lock = false;
+                }
+            // only the last symbol of the run can complete a message
+            for (int32_t i = 0; i < n_run; i++)
+                {
+                    if (decode_symbol(in[0][n_consumed], out[0][n_produced], flag_new_cnav_frame && i == n_run - 1, msg, delay))
+                        {
+                            n_produced++;
+                        }
+                    n_consumed++;
+                }
         }
-    return 0;
+    consume_each(n_consumed);
+    return n_produced;
 }
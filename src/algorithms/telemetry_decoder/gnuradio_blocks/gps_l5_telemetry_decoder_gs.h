@@ -19,7 +19,10 @@
 
 #include "GPS_L5.h"  // for GPS_L5I_NH_CODE_LENGTH
 #include "gnss_block_interface.h"
+#include "gnss_dump_writer.h"
+#include "gnss_nav_product_channel.h"
 #include "gnss_satellite.h"               // for Gnss_Satellite
+#include "gnss_synchro.h"                 // for Gnss_Synchro
 #include "gps_cnav_navigation_message.h"  // for Gps_CNAV_Navigation_Message
 #include "nav_message_packet.h"
 #include "tlm_conf.h"
@@ -29,8 +32,9 @@
 #include <gnuradio/types.h>  // for gr_vector_const_void_star
 #include <cstdint>
 #include <fstream>
-#include <memory>  // for std::unique_ptr
+#include <memory>  // for std::shared_ptr, std::unique_ptr
 #include <string>
+#include <vector>
 
 extern "C"
 {
@@ -71,8 +75,10 @@ private:
         const Tlm_Conf &conf);
 
     gps_l5_telemetry_decoder_gs(const Gnss_Satellite &satellite, const Tlm_Conf &conf);
+    bool decode_symbol(const Gnss_Synchro &in_symbol, Gnss_Synchro &out_symbol, bool flag_new_cnav_frame, const cnav_msg_t &msg, uint32_t delay);  //!< Processes one symbol already fed to the decoder. Returns true if out_symbol is produced
 
     cnav_msg_decoder_t d_cnav_decoder{};
+    std::vector<uint8_t> d_symbols;  // hard symbols of the items of the current general_work call
 
     Gnss_Satellite d_satellite;
 
@@ -80,9 +86,10 @@ private:
 
     Nav_Message_Packet d_nav_msg_packet;
     std::unique_ptr<Tlm_CRC_Stats> d_Tlm_CRC_Stats;
+    std::shared_ptr<Gnss_Nav_Product_Channel> d_nav_product_channel;  // navigation data delivered to the PVT block
 
     std::string d_dump_filename;
-    std::ofstream d_dump_file;
+    Gnss_Dump_Writer d_dump_file;
 
     uint64_t d_sample_counter;
     uint64_t d_last_valid_preamble;
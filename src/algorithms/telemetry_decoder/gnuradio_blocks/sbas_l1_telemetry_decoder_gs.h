@@ -19,6 +19,7 @@
 
 #include "gnss_block_interface.h"
 #include "gnss_satellite.h"
+#include "gnss_synchro.h"
 #include <boost/crc.hpp>  // for crc_optimal
 #include <gnuradio/block.h>
 #include <gnuradio/types.h>  // for gr_vector_const_void_star
@@ -71,6 +72,7 @@ private:
         bool dump);
 
     sbas_l1_telemetry_decoder_gs(const Gnss_Satellite &satellite, bool dump);
+    bool decode_symbol(const Gnss_Synchro &in_symbol, Gnss_Synchro &out_symbol);  //!< Decodes one symbol. Returns true if out_symbol is produced
 
     void viterbi_decoder(double *page_part_symbols, int32_t *page_part_bits);
     void align_samples();
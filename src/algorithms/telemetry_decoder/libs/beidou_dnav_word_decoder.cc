@@ -0,0 +1,116 @@
+/*!
+ * \file beidou_dnav_word_decoder.cc
+ * \brief Branch-free decoder of the BCH(15,11,1) words of the BeiDou D1 and
+ * D2 navigation messages.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "beidou_dnav_word_decoder.h"
+#include <array>
+
+
+namespace
+{
+struct Bch15_11_Tables
+{
+    uint32_t syndrome_of_zero;
+    std::array<uint32_t, 15> syndrome_of_bit;  // syndrome of each bit set, without that of zero
+    std::array<uint32_t, 16> error_of_syndrome;
+};
+
+
+// syndrome of the division by x^4 + x + 1 in a register initialized
+// to all ones, with the bits read as in the BeiDou ICD, where a 0 in the
+// register means a 1 in the syndrome
+uint32_t lfsr_syndrome(uint32_t codeword)
+{
+    uint32_t reg = 0xFU;
+    for (uint32_t i = 0; i < 15; i++)
+        {
+            const uint32_t feedback = (reg >> 3U) & 1U;
+            const uint32_t bit = ((codeword >> i) & 1U) ^ 1U;
+            reg = ((reg << 1U) & 0xEU) | (bit ^ feedback);
+            reg ^= feedback << 1U;
+        }
+    return ~reg & 0xFU;
+}
+
+
+Bch15_11_Tables make_bch15_11_tables()
+{
+    const std::array<uint32_t, 15> error_position{14, 13, 10, 12, 6, 9, 4, 11, 0, 5, 7, 8, 1, 3, 2};
+    Bch15_11_Tables tables{};
+    // the syndrome is affine in the codeword
+    tables.syndrome_of_zero = lfsr_syndrome(0U);
+    for (uint32_t i = 0; i < 15; i++)
+        {
+            tables.syndrome_of_bit[i] = lfsr_syndrome(1U << i) ^ tables.syndrome_of_zero;
+            tables.error_of_syndrome[i + 1] = 1U << error_position[i];
+        }
+    return tables;
+}
+
+
+const Bch15_11_Tables BCH15_11_TABLES = make_bch15_11_tables();
+
+
+inline uint32_t slice(float symbol, float polarity)
+{
+    return static_cast<uint32_t>(symbol * polarity > 0.0F);
+}
+}  // namespace
+
+
+uint32_t beidou_bch15_11_01_correct(uint32_t codeword)
+{
+    uint32_t syndrome = BCH15_11_TABLES.syndrome_of_zero;
+    for (uint32_t i = 0; i < 15; i++)
+        {
+            syndrome ^= BCH15_11_TABLES.syndrome_of_bit[i] & (0U - ((codeword >> i) & 1U));
+        }
+    return codeword ^ BCH15_11_TABLES.error_of_syndrome[syndrome];
+}
+
+
+void beidou_dnav_decode_word(bool first_word, const float* symbols, float polarity, char* bits)
+{
+    if (first_word)
+        {
+            for (uint32_t j = 0; j < 30; j++)
+                {
+                    bits[j] = static_cast<char>('0' + slice(symbols[j], polarity));
+                }
+            return;
+        }
+
+    // the two codewords are interleaved symbol by symbol
+    uint32_t first_branch = 0;
+    uint32_t second_branch = 0;
+    for (uint32_t c = 0; c < 15; c++)
+        {
+            first_branch |= slice(symbols[2 * c], polarity) << c;
+            second_branch |= slice(symbols[2 * c + 1], polarity) << c;
+        }
+    first_branch = beidou_bch15_11_01_correct(first_branch);
+    second_branch = beidou_bch15_11_01_correct(second_branch);
+
+    for (uint32_t j = 0; j < 11; j++)
+        {
+            bits[j] = static_cast<char>('0' + ((first_branch >> j) & 1U));
+            bits[j + 11] = static_cast<char>('0' + ((second_branch >> j) & 1U));
+        }
+    for (uint32_t j = 0; j < 4; j++)
+        {
+            bits[j + 22] = static_cast<char>('0' + ((first_branch >> (11 + j)) & 1U));
+            bits[j + 26] = static_cast<char>('0' + ((second_branch >> (11 + j)) & 1U));
+        }
+}
@@ -0,0 +1,54 @@
+/*!
+ * \file beidou_dnav_word_decoder.h
+ * \brief Branch-free decoder of the BCH(15,11,1) words of the BeiDou D1 and
+ * D2 navigation messages.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_BEIDOU_DNAV_WORD_DECODER_H
+#define GNSS_SDR_BEIDOU_DNAV_WORD_DECODER_H
+
+#include <cstdint>
+
+/** \addtogroup Telemetry_Decoder
+ * \{ */
+/** \addtogroup Telemetry_Decoder_libs
+ * \{ */
+
+
+/*!
+ * \brief Corrects a BCH(15,11,1) codeword, with its first bit in the least
+ * significant bit. The syndrome is the XOR of a precomputed pattern for each
+ * bit set, and the error is flipped with a table indexed by the syndrome, so
+ * there are no branches on the data.
+ */
+uint32_t beidou_bch15_11_01_correct(uint32_t codeword);
+
+
+/*!
+ * \brief Decodes a word of 30 symbols of a BeiDou DNAV subframe into 30
+ * characters '0' or '1', as the subframe decoders of Beidou_Dnav_Navigation_Message
+ * read them.
+ *
+ * The first word is not interleaved nor encoded except for its first 15 bits,
+ * so it is only sliced. The other words are deinterleaved into two codewords,
+ * which are corrected, and their information bits are placed before their
+ * parity bits. The polarity (1 or -1 with a 180 degrees phase lock) is applied
+ * to the symbols in the slicing, so the symbols do not have to be inverted
+ * before.
+ */
+void beidou_dnav_decode_word(bool first_word, const float* symbols, float polarity, char* bits);
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_BEIDOU_DNAV_WORD_DECODER_H
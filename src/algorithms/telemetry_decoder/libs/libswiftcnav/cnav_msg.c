@@ -439,6 +439,103 @@ bool cnav_msg_decoder_add_symbol(cnav_msg_decoder_t *dec,
 }
 
 
+/**
+ * Number of symbols the part can take before the one that completes its
+ * decoding block.
+ *
+ * \param[in] part Decoder component.
+ *
+ * \return Number of symbols that only go into the symbol buffer.
+ *
+ * \private
+ */
+static size_t cnav_symbols_to_block_(const cnav_v27_part_t *part)
+{
+    const size_t block = part->init ? (GPS_L2C_V27_INIT_BITS + GPS_L2C_V27_DECODE_BITS) * 2 : GPS_L2C_V27_DECODE_BITS * 2;
+    return block - part->n_symbols - 1;
+}
+
+
+/**
+ * Adds a run of received symbols to decoder.
+ *
+ * The result is the same as calling cnav_msg_decoder_add_symbol() for each
+ * symbol, but the symbols that do not complete a decoding block of any of the
+ * decoder components are copied into the symbol buffers at once. The method
+ * returns after the first symbol that completes a decoding block, which is
+ * the only kind of symbol that can produce a message or change the message
+ * lock, so the caller can compute the time of that symbol and check the
+ * decoder state as it would do after cnav_msg_decoder_add_symbol().
+ *
+ * \param[in,out] dec       Decoder object.
+ * \param[in]     symbols   Symbol values, as in cnav_msg_decoder_add_symbol().
+ * \param[in]     n_symbols Number of symbols in \a symbols.
+ * \param[out]    msg       Buffer for decoded message.
+ * \param[out]    pdelay    Delay of message generation in symbols.
+ * \param[out]    decoded   Set to true if the last consumed symbol produced
+ *                          a message, to false otherwise.
+ *
+ * \return Number of symbols consumed, at least one if \a n_symbols > 0.
+ */
+size_t cnav_msg_decoder_add_symbols(cnav_msg_decoder_t *dec,
+    const uint8_t *symbols,
+    size_t n_symbols,
+    cnav_msg_t *msg,
+    uint32_t *pdelay,
+    bool *decoded)
+{
+    *decoded = false;
+    if (n_symbols == 0)
+        {
+            return 0;
+        }
+
+    /* While one component has message lock, the other one is flushed after
+     * every symbol, so it never completes a decoding block. */
+    size_t run = n_symbols;
+    if (!dec->part2.message_lock || dec->part1.message_lock)
+        {
+            const size_t free1 = cnav_symbols_to_block_(&dec->part1);
+            run = run < free1 ? run : free1;
+        }
+    if (!dec->part1.message_lock)
+        {
+            const size_t free2 = cnav_symbols_to_block_(&dec->part2);
+            run = run < free2 ? run : free2;
+        }
+
+    if (run == 0)
+        {
+            *decoded = cnav_msg_decoder_add_symbol(dec, symbols[0], msg, pdelay);
+            return 1;
+        }
+
+    if (dec->part1.message_lock)
+        {
+            memcpy(dec->part1.symbols + dec->part1.n_symbols, symbols, run);
+            dec->part1.n_symbols += run;
+            dec->part2.n_decoded = 0;
+            dec->part2.n_symbols = 0;
+        }
+    else if (dec->part2.message_lock)
+        {
+            memcpy(dec->part2.symbols + dec->part2.n_symbols, symbols, run);
+            dec->part2.n_symbols += run;
+            dec->part1.n_decoded = 0;
+            dec->part1.n_symbols = 0;
+        }
+    else
+        {
+            memcpy(dec->part1.symbols + dec->part1.n_symbols, symbols, run);
+            dec->part1.n_symbols += run;
+            memcpy(dec->part2.symbols + dec->part2.n_symbols, symbols, run);
+            dec->part2.n_symbols += run;
+        }
+
+    return run;
+}
+
+
 /**
  * Provides a singleton polynomial object.
  *
@@ -104,6 +104,12 @@ bool cnav_msg_decoder_add_symbol(cnav_msg_decoder_t *dec,
     unsigned char symbol,
     cnav_msg_t *msg,
     uint32_t *delay);
+size_t cnav_msg_decoder_add_symbols(cnav_msg_decoder_t *dec,
+    const uint8_t *symbols,
+    size_t n_symbols,
+    cnav_msg_t *msg,
+    uint32_t *pdelay,
+    bool *decoded);
 
 /** \} */
 /** \} */
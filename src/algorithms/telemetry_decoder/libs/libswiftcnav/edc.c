@@ -62,6 +62,47 @@ static const uint32_t CRC24QTAB[256] = {
     0xE37B16, 0x6537ED, 0x69AE1B, 0xEFE2E0, 0x709DF7, 0xF6D10C, 0xFA48FA, 0x7C0401,
     0x42FA2F, 0xC4B6D4, 0xC82F22, 0x4E63D9, 0xD11CCE, 0x575035, 0x5BC9C3, 0xDD8538};
 
+/** Slicing tables of the CRC-24Q, computed from CRC24QTAB on the first use.
+ *
+ * The CRC register is kept in the 24 most significant bits of a 32-bit word,
+ * so that CRC24QSLICE[k][b] is the contribution of the byte b followed by k
+ * zero bytes, and eight bytes are folded into the register at a time.
+ */
+static uint32_t CRC24QSLICE[8][256];
+
+
+/** Fills CRC24QSLICE.
+ *
+ * Racing condition handling: the tables can be initialized more than once if
+ * multiple threads request concurrent access, but every initialization writes
+ * the same values.
+ */
+static const uint32_t (*crc24q_slice_tables(void))[256]
+{
+    static bool initialized = false;
+
+    if (!initialized)
+        {
+            uint32_t b = 0;
+            uint32_t k = 0;
+            for (b = 0; b < 256; b++)
+                {
+                    CRC24QSLICE[0][b] = CRC24QTAB[b] << 8U;
+                }
+            for (k = 1; k < 8; k++)
+                {
+                    for (b = 0; b < 256; b++)
+                        {
+                            const uint32_t prev = CRC24QSLICE[k - 1][b];
+                            CRC24QSLICE[k][b] = (prev << 8U) ^ CRC24QSLICE[0][prev >> 24U];
+                        }
+                }
+            initialized = true;
+        }
+    return (const uint32_t(*)[256])CRC24QSLICE;
+}
+
+
 /** Calculate Qualcomm 24-bit Cyclical Redundancy Check (CRC-24Q).
  *
  * The CRC polynomial used is:
@@ -71,6 +112,9 @@ static const uint32_t CRC24QTAB[256] = {
  * \f]
  * Mask 0x1864CFB, not reversed, not XOR'd
  *
+ * Blocks of eight bytes are processed with slicing tables, and the remaining
+ * bytes with the byte-wise table.
+ *
  * \param buf Array of data to calculate CRC for
  * \param len Length of data array
  * \param crc Initial CRC value
@@ -80,7 +124,22 @@ static const uint32_t CRC24QTAB[256] = {
 uint32_t crc24q(const uint8_t *buf, uint32_t len, uint32_t crc)
 {
     uint32_t i = 0;
-    for (i = 0; i < len; i++)
+    if (len >= 8)
+        {
+            const uint32_t(*t)[256] = crc24q_slice_tables();
+            uint32_t c = (crc & 0xFFFFFFU) << 8U;
+            for (; i + 8 <= len; i += 8)
+                {
+                    c ^= ((uint32_t)buf[i] << 24U) | ((uint32_t)buf[i + 1] << 16U) |
+                         ((uint32_t)buf[i + 2] << 8U) | (uint32_t)buf[i + 3];
+                    c = t[7][c >> 24U] ^ t[6][(c >> 16U) & 0xFFU] ^
+                        t[5][(c >> 8U) & 0xFFU] ^ t[4][c & 0xFFU] ^
+                        t[3][buf[i + 4]] ^ t[2][buf[i + 5]] ^
+                        t[1][buf[i + 6]] ^ t[0][buf[i + 7]];
+                }
+            crc = c >> 8U;
+        }
+    for (; i < len; i++)
         {
             crc = ((crc << 8U) & 0xFFFFFFU) ^ CRC24QTAB[((crc >> 16U) ^ buf[i]) & 0xFFU];
         }
@@ -95,6 +154,9 @@ uint32_t crc24q(const uint8_t *buf, uint32_t len, uint32_t crc)
  * 8-bit bytes, and when computing CRC the message has to be padded with zero
  * bits.
  *
+ * The padded bytes are realigned into a local buffer, which is then fed to
+ * crc24q().
+ *
  * \param[in] crc    Initial CRC value
  * \param[in] buf    Pointer to MSB-aligned data.
  * \param[in] n_bits Number of bits in the data buffer.
@@ -104,30 +166,27 @@ uint32_t crc24q(const uint8_t *buf, uint32_t len, uint32_t crc)
  */
 uint32_t crc24q_bits(uint32_t crc, const uint8_t *buf, uint32_t n_bits, bool invert)
 {
+    uint8_t aligned[64];
+    uint32_t n_aligned = 0;
     uint16_t acc = 0;
-    uint8_t b = 0;
     const uint32_t shift = 8 - n_bits % 8;
 
     uint32_t i = 0;
-    for (i = 0; i < n_bits / 8; ++i)
+    for (i = 0; i <= n_bits / 8; ++i)
         {
             acc = (acc << 8U) | *buf++;
             if (invert)
                 {
                     acc ^= 0xFFU;
                 }
-            b = (acc >> shift) & 0xFFU;
-            crc = ((crc << 8U) & 0xFFFFFFU) ^ CRC24QTAB[((crc >> 16U) ^ b) & 0xFFU];
-        }
-    acc = (acc << 8U) | *buf;
-    if (invert)
-        {
-            acc ^= 0xFFU;
+            aligned[n_aligned++] = (acc >> shift) & 0xFFU;
+            if (n_aligned == sizeof(aligned))
+                {
+                    crc = crc24q(aligned, n_aligned, crc);
+                    n_aligned = 0;
+                }
         }
-    b = (acc >> shift) & 0xFFU;
-    crc = ((crc << 8U) & 0xFFFFFFU) ^ CRC24QTAB[((crc >> 16U) ^ b) & 0xFFU];
-
-    return crc;
+    return crc24q(aligned, n_aligned, crc);
 }
 
 
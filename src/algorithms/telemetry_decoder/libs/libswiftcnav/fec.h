@@ -44,10 +44,8 @@ typedef struct
  */
 typedef struct
 {
-    unsigned int metrics1[64]; /* Path metric buffer 1 */
-    unsigned int metrics2[64]; /* Path metric buffer 2 */
-    /* Pointers to path metrics, swapped on every bit */
-    unsigned int *old_metrics, *new_metrics;
+    float metrics[64];            /* Path metrics, updated on every bit */
+    float branch_signs[64];       /* Expected symbols (+1 or -1) of the 32 butterflies */
     const v27_poly_t *poly;       /* Polynomial to use */
     v27_decision_t *decisions;    /* Beginning of decisions for block */
     unsigned int decisions_index; /* Index of current decision */
@@ -20,6 +20,8 @@
 
 
 #include "fec.h"
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <stdint.h>
 #include <stdlib.h>
 
 static inline unsigned int parity(unsigned int x)
@@ -65,42 +67,26 @@ void v27_init(v27_t *v, v27_decision_t *decisions, unsigned int decisions_count,
 {
     int i;
 
-    v->old_metrics = v->metrics1;
-    v->new_metrics = v->metrics2;
     v->poly = poly;
     v->decisions = decisions;
     v->decisions_index = 0;
     v->decisions_count = decisions_count;
 
+    for (i = 0; i < 32; i++)
+        {
+            v->branch_signs[i] = poly->c0[i] ? 1.0F : -1.0F;
+            v->branch_signs[32 + i] = poly->c1[i] ? 1.0F : -1.0F;
+        }
+
     for (i = 0; i < 64; i++)
         {
-            v->old_metrics[i] = 63;
+            v->metrics[i] = -63.0F;
         }
 
-    v->old_metrics[initial_state & 63] = 0; /* Bias known start state */
+    v->metrics[initial_state & 63] = 0.0F; /* Bias known start state */
 }
 
 
-/* C-language butterfly */
-#define BFLY(i)                                                     \
-    {                                                               \
-        unsigned int metric;                                        \
-        unsigned int m0;                                            \
-        unsigned int m1;                                            \
-        unsigned int decision;                                      \
-        metric = (v->poly->c0[i] ^ sym0) + (v->poly->c1[i] ^ sym1); \
-        m0 = v->old_metrics[i] + metric;                            \
-        m1 = v->old_metrics[(i) + 32] + (510 - metric);             \
-        decision = (signed int)(m0 - m1) > 0;                       \
-        v->new_metrics[2 * (i)] = decision ? m1 : m0;               \
-        d->w[(i) / 16] |= decision << ((2U * (i)) & 31U);           \
-        m0 -= (metric + metric - 510);                              \
-        m1 += (metric + metric - 510);                              \
-        decision = (signed int)(m0 - m1) > 0;                       \
-        v->new_metrics[2 * (i) + 1] = decision ? m1 : m0;           \
-        d->w[(i) / 16] |= decision << ((2U * (i) + 1U) & 31U);      \
-    }
-
 /** Update a v27_t decoder with a block of symbols.
  *
  * \param v Structure to update.
@@ -110,81 +96,38 @@ void v27_init(v27_t *v, v27_decision_t *decisions, unsigned int decisions_count,
  */
 void v27_update(v27_t *v, const unsigned char *syms, int nbits)
 {
-    unsigned char sym0;
-    unsigned char sym1;
-    unsigned int *tmp;
-
-    while (nbits--)
+    /* The symbols are converted to soft values centered at zero, and the
+     * add-compare-select of the 64 states is done by a SIMD kernel, in
+     * chunks that do not go past the end of the decisions history */
+    float soft_syms[2 * 64];
+    unsigned int n;
+    unsigned int i;
+
+    while (nbits > 0)
         {
-            v27_decision_t *d = &v->decisions[v->decisions_index];
-
-            d->w[0] = d->w[1] = 0;
-            sym0 = *syms++;
-            sym1 = *syms++;
-
-            BFLY(0U);
-            BFLY(1U);
-            BFLY(2U);
-            BFLY(3U);
-            BFLY(4U);
-            BFLY(5U);
-            BFLY(6U);
-            BFLY(7U);
-            BFLY(8U);
-            BFLY(9U);
-            BFLY(10U);
-            BFLY(11U);
-            BFLY(12U);
-            BFLY(13U);
-            BFLY(14U);
-            BFLY(15U);
-            BFLY(16U);
-            BFLY(17U);
-            BFLY(18U);
-            BFLY(19U);
-            BFLY(20U);
-            BFLY(21U);
-            BFLY(22U);
-            BFLY(23U);
-            BFLY(24U);
-            BFLY(25U);
-            BFLY(26U);
-            BFLY(27U);
-            BFLY(28U);
-            BFLY(29U);
-            BFLY(30U);
-            BFLY(31U);
-
-            /* Normalize metrics if they are nearing overflow */
-            if (v->new_metrics[0] > (1U << 30U))
+            n = (unsigned int)nbits;
+            if (n > 64)
                 {
-                    int i;
-                    unsigned int minmetric = 1U << 31U;
-
-                    for (i = 0; i < 64; i++)
-                        {
-                            if (v->new_metrics[i] < minmetric)
-                                {
-                                    minmetric = v->new_metrics[i];
-                                }
-                        }
-
-                    for (i = 0; i < 64; i++)
-                        {
-                            v->new_metrics[i] -= minmetric;
-                        }
+                    n = 64;
                 }
+            if (n > v->decisions_count - v->decisions_index)
+                {
+                    n = v->decisions_count - v->decisions_index;
+                }
+            for (i = 0; i < 2 * n; i++)
+                {
+                    soft_syms[i] = (float)syms[i] - 127.5F;
+                }
+            volk_gnsssdr_32f_viterbi_k7_acs_32u((uint32_t *)v->decisions[v->decisions_index].w, v->metrics, soft_syms, v->branch_signs, n);
+            syms += 2 * n;
+            nbits -= (int)n;
 
             /* Advance decision index */
-            if (++v->decisions_index >= v->decisions_count)
+            v->decisions_index += n;
+            if (v->decisions_index >= v->decisions_count)
                 {
                     v->decisions_index = 0;
                 }
-
-            /* Swap pointers to old and new metrics */
-            tmp = v->old_metrics;
-            v->old_metrics = v->new_metrics;
-            v->new_metrics = tmp;
         }
 }
 
@@ -231,16 +174,16 @@ void v27_chainback_fixed(v27_t *v, unsigned char *data, unsigned int nbits,
  */
 void v27_chainback_likely(v27_t *v, unsigned char *data, unsigned int nbits)
 {
-    /* Determine state with minimum metric */
+    /* Determine state with maximum metric */
 
     int i;
-    unsigned int best_metric = 0xffffffff;
+    float best_metric = v->metrics[0];
     unsigned char best_state = 0;
-    for (i = 0; i < 64; i++)
+    for (i = 1; i < 64; i++)
         {
-            if (v->new_metrics[i] < best_metric)
+            if (v->metrics[i] > best_metric)
                 {
-                    best_metric = v->new_metrics[i];
+                    best_metric = v->metrics[i];
                     best_state = i;
                 }
         }
@@ -28,8 +28,8 @@ void Tlm_CRC_Stats::initialize(std::string dump_crc_stats_filename_)
     d_dump_crc_stats_filename = std::move(dump_crc_stats_filename_);
 
     enable_crc_stats = true;
-    num_crc_ok = 0;
-    num_crc_not_ok = 0;
+    num_crc_ok.store(0, std::memory_order_relaxed);
+    num_crc_not_ok.store(0, std::memory_order_relaxed);
 }
 
 
@@ -82,27 +82,15 @@ bool Tlm_CRC_Stats::set_channel(int32_t channel_)
 }
 
 
-void Tlm_CRC_Stats::update_CRC_stats(bool CRC)
-{
-    if (CRC)
-        {
-            num_crc_ok++;
-        }
-    else
-        {
-            num_crc_not_ok++;
-        }
-}
-
-
 Tlm_CRC_Stats::~Tlm_CRC_Stats()
 {
-    uint32_t num_crc_tests = num_crc_ok + num_crc_not_ok;
+    const uint32_t num_ok = crc_ok();
+    const uint32_t num_crc_tests = num_ok + crc_not_ok();
     float success_rate = 0.0;
 
     if (num_crc_tests > 0)
         {
-            success_rate = static_cast<float>(num_crc_ok) / static_cast<float>(num_crc_tests);
+            success_rate = static_cast<float>(num_ok) / static_cast<float>(num_crc_tests);
         }
     std::string txt_num_crc_tests("Num CRC Tests");
     uint32_t align_num_crc_tests = txt_num_crc_tests.length();
@@ -118,7 +106,7 @@ Tlm_CRC_Stats::~Tlm_CRC_Stats()
             try
                 {
                     d_dump_file << txt_num_crc_tests << txt_success_tests << txt_success_rate << std::endl;
-                    d_dump_file << std::setw(align_num_crc_tests) << num_crc_tests << txt_delimiter << std::setw(align_success_tests - align_delimiter) << num_crc_ok << txt_delimiter << std::setw(align_success_rate - align_delimiter) << std::setprecision(4) << success_rate << std::endl;
+                    d_dump_file << std::setw(align_num_crc_tests) << num_crc_tests << txt_delimiter << std::setw(align_success_tests - align_delimiter) << num_ok << txt_delimiter << std::setw(align_success_rate - align_delimiter) << std::setprecision(4) << success_rate << std::endl;
                 }
             catch (const std::exception &ex)
                 {
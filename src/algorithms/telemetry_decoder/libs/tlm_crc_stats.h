@@ -17,6 +17,7 @@
 #ifndef GNSS_SDR_CRC_STATS_H
 #define GNSS_SDR_CRC_STATS_H
 
+#include <atomic>
 #include <cstdint>
 #include <fstream>  // for std::ofstream
 #include <string>   // for std::string
@@ -28,6 +29,10 @@
 
 /*!
  * \brief Class that computes the telemetry CRC statistics
+ *
+ * The counters are updated by the telemetry decoder without locks, and can
+ * be read at any time from other threads. The statistics are written to the
+ * output file when the object is destroyed.
  */
 class Tlm_CRC_Stats
 {
@@ -49,13 +54,28 @@ public:
     /*!
      * \brief Update the CRC statistics
      */
-    void update_CRC_stats(bool CRC);
+    inline void update_CRC_stats(bool CRC)
+    {
+        auto& counter = CRC ? num_crc_ok : num_crc_not_ok;
+        // only the decoder thread writes the counters
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    /*!
+     * \brief Number of CRC checks that passed
+     */
+    inline uint32_t crc_ok() const { return num_crc_ok.load(std::memory_order_relaxed); }
+
+    /*!
+     * \brief Number of CRC checks that failed
+     */
+    inline uint32_t crc_not_ok() const { return num_crc_not_ok.load(std::memory_order_relaxed); }
 
 private:
     std::ofstream d_dump_file;
     std::string d_dump_crc_stats_filename;
-    uint32_t num_crc_ok{0};
-    uint32_t num_crc_not_ok{0};
+    std::atomic<uint32_t> num_crc_ok{0};
+    std::atomic<uint32_t> num_crc_not_ok{0};
     int32_t channel{0};
     bool enable_crc_stats{false};
 };
@@ -0,0 +1,51 @@
+/*!
+ * \file tlm_deinterleaver.cc
+ * \brief Block deinterleaver of soft symbols with a precomputed permutation
+ * table, fused with the sign corrections of the symbols.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "tlm_deinterleaver.h"
+#include <volk_gnsssdr/volk_gnsssdr.h>  // for volk_gnsssdr_32f_signed_gather_32f
+
+
+namespace
+{
+const uint32_t SIGN_FLIP = 0x80000000U;
+}  // namespace
+
+
+Tlm_Deinterleaver::Tlm_Deinterleaver(int32_t rows, int32_t cols, bool invert_odd_symbols)
+{
+    const auto length = static_cast<uint32_t>(rows * cols);
+    d_indices[0].resize(length);
+    d_indices[1].resize(length);
+    for (uint32_t i = 0; i < length; i++)
+        {
+            // out[c * rows + r] = in[r * cols + c]
+            const uint32_t r = i % static_cast<uint32_t>(rows);
+            const uint32_t c = i / static_cast<uint32_t>(rows);
+            d_indices[0][i] = r * static_cast<uint32_t>(cols) + c;
+            if (invert_odd_symbols && (i % 2 == 1))
+                {
+                    d_indices[0][i] |= SIGN_FLIP;
+                }
+            d_indices[1][i] = d_indices[0][i] ^ SIGN_FLIP;
+        }
+}
+
+
+void Tlm_Deinterleaver::deinterleave(const float* in, float* out, bool inverted) const
+{
+    const std::vector<uint32_t>& indices = d_indices[inverted ? 1 : 0];
+    volk_gnsssdr_32f_signed_gather_32f(out, in, indices.data(), static_cast<unsigned int>(indices.size()));
+}
@@ -0,0 +1,70 @@
+/*!
+ * \file tlm_deinterleaver.h
+ * \brief Block deinterleaver of soft symbols with a precomputed permutation
+ * table, fused with the sign corrections of the symbols.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_TLM_DEINTERLEAVER_H
+#define GNSS_SDR_TLM_DEINTERLEAVER_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/** \addtogroup Telemetry_Decoder
+ * \{ */
+/** \addtogroup Telemetry_Decoder_libs
+ * \{ */
+
+
+/*!
+ * \brief Block deinterleaver of rows x cols soft symbols, written by rows and
+ * read by columns, built on the kernel volk_gnsssdr_32f_signed_gather_32f.
+ *
+ * The permutation is precomputed in a table of indices whose most
+ * significant bit flips the sign of the symbol, so the inversion of the odd
+ * symbols by the NOT gate of the G2 polynomial of the Galileo FEC encoder
+ * and the inversion of all the symbols of a 180 degrees phase lock are done
+ * in the same pass, without branches. There is a table for each polarity.
+ */
+class Tlm_Deinterleaver
+{
+public:
+    /*!
+     * \brief Constructor
+     * \param[in] rows, cols  Size of the interleaver block
+     * \param[in] invert_odd_symbols  Flip the sign of the odd deinterleaved
+     * symbols (the second symbol of each bit, for the G2 NOT gate)
+     */
+    Tlm_Deinterleaver(int32_t rows, int32_t cols, bool invert_odd_symbols);
+
+    /*!
+     * \brief Deinterleaves size() symbols of in into out, which must not
+     * overlap, with all the signs flipped if inverted is true
+     */
+    void deinterleave(const float* in, float* out, bool inverted) const;
+
+    //! Number of symbols of the interleaver block
+    inline int32_t size() const
+    {
+        return static_cast<int32_t>(d_indices[0].size());
+    }
+
+private:
+    std::array<std::vector<uint32_t>, 2> d_indices;  // for the normal and the inverted polarity
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_TLM_DEINTERLEAVER_H
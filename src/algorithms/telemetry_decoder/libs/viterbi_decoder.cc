@@ -16,18 +16,20 @@
 
 #include "viterbi_decoder.h"
 #include <volk_gnsssdr/volk_gnsssdr.h>  // for volk_gnsssdr_32f_index_max_32u
-#include <algorithm>                    // for std::copy
+#include <algorithm>                    // for std::copy, std::fill
 
 Viterbi_Decoder::Viterbi_Decoder(int32_t KK,
     int32_t nn,
     int32_t LL,
     const std::array<int32_t, 2>& g) : d_g(g),
+                                       d_k7_engine(g),
                                        d_KK(KK),
                                        d_nn(nn),
                                        d_LL(LL),
                                        d_mm(KK - 1),
-                                       d_states(1 << d_mm),       //  2^d_mm
-                                       d_number_symbols(1 << nn)  //  2^d_nn
+                                       d_states(1 << d_mm),        //  2^d_mm
+                                       d_number_symbols(1 << nn),  //  2^d_nn
+                                       d_use_k7_engine(Viterbi_K7_Engine::supports(KK, nn, g.data()))
 {
     d_prev_section = std::vector<float>(d_states, -d_MAXLOG);
     d_next_section = std::vector<float>(d_states, -d_MAXLOG);
@@ -53,12 +55,22 @@ void Viterbi_Decoder::decode(std::vector<int32_t>& output_u_int, const std::vect
     float metric;
     float max_val;
 
+    if (d_use_k7_engine)
+        {
+            // zero-tail terminated block: start and end in the all-zeros state
+            d_k7_engine.reset();
+            d_k7_engine.update(input_c.data(), d_LL + d_mm);
+            d_k7_engine.traceback(0, d_mm, d_LL, output_u_int.data());
+            return;
+        }
+
+    std::fill(d_prev_section.begin(), d_prev_section.end(), -d_MAXLOG);
     d_prev_section[0] = 0.0;  //  start in all-zeros state
 
     // go through trellis
     for (t = 0; t < d_LL + d_mm; t++)
         {
-            std::copy(input_c.begin() + d_nn * t, input_c.begin() + d_nn * t + (d_nn - 1), d_rec_array.begin());
+            std::copy(input_c.begin() + d_nn * t, input_c.begin() + d_nn * t + d_nn, d_rec_array.begin());
 
             // precompute all possible branch metrics
             for (i = 0; i < d_number_symbols; i++)
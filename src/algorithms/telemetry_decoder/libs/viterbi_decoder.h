@@ -17,6 +17,7 @@
 #ifndef GNSS_SDR_VITERBI_DECODER_H
 #define GNSS_SDR_VITERBI_DECODER_H
 
+#include "viterbi_k7_engine.h"
 #include <array>
 #include <cstdint>
 #include <vector>
@@ -29,7 +30,8 @@
 
 
 /*!
- * \brief Class that implements a Viterbi decoder
+ * \brief Class that implements a Viterbi decoder. The K=7, rate 1/2 codes
+ * are decoded by a Viterbi_K7_Engine.
  */
 class Viterbi_Decoder
 {
@@ -115,6 +117,8 @@ private:
     std::vector<int32_t> d_state0;
     std::vector<int32_t> d_state1;
 
+    Viterbi_K7_Engine d_k7_engine;
+
     float d_MAXLOG = 1e7;  // Define infinity
     int32_t d_KK{};
     int32_t d_nn{};
@@ -123,6 +127,7 @@ private:
     int32_t d_mm{};
     int32_t d_states{};
     int32_t d_number_symbols{};
+    bool d_use_k7_engine{};
 };
 
 /** \} */
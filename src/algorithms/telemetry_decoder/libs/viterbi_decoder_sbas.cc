@@ -16,9 +16,11 @@
  */
 
 #include "viterbi_decoder_sbas.h"
+#include "gnss_sdr_make_unique.h"  // for std::make_unique in C++11
 #include <glog/logging.h>
-#include <algorithm>  // for fill_n
-#include <ostream>    // for operator<<, basic_ostream, char_traits
+#include <algorithm>  // for fill_n, min, max
+#include <array>
+#include <ostream>  // for operator<<, basic_ostream, char_traits
 
 // logging
 #define EVENT 2   // logs important events which don't occur every block
@@ -48,6 +50,11 @@ Viterbi_Decoder_Sbas::Viterbi_Decoder_Sbas(const int g_encoder[],
     nsc_transit(d_out0.data(), d_state0.data(), 0, g_encoder, d_KK, d_nn);
     nsc_transit(d_out1.data(), d_state1.data(), 1, g_encoder, d_KK, d_nn);
 
+    if (Viterbi_K7_Engine::supports(d_KK, d_nn, g_encoder))
+        {
+            d_k7_engine = std::make_unique<Viterbi_K7_Engine>(std::array<int32_t, 2>{g_encoder[0], g_encoder[1]});
+        }
+
     // initialise trellis state
     Viterbi_Decoder_Sbas::init_trellis_state();
 }
@@ -56,6 +63,10 @@ Viterbi_Decoder_Sbas::Viterbi_Decoder_Sbas(const int g_encoder[],
 void Viterbi_Decoder_Sbas::reset()
 {
     init_trellis_state();
+    if (d_k7_engine)
+        {
+            d_k7_engine->reset();
+        }
 }
 
 
@@ -71,6 +82,14 @@ float Viterbi_Decoder_Sbas::decode_block(const double input_c[], int output_u_in
 {
     VLOG(FLOW) << "decode_block(): LL=" << LL;
 
+    if (d_k7_engine)
+        {
+            d_k7_engine->reset();
+            k7_update(input_c, LL + d_mm);
+            // tail, no need to output -> traceback, but don't decode
+            return k7_tb_and_decode(d_mm, LL, output_u_int);
+        }
+
     // init
     init_trellis_state();
     // do add compare select
@@ -94,6 +113,22 @@ float Viterbi_Decoder_Sbas::decode_continuous(const double sym[],
 {
     VLOG(FLOW) << "decode_continuous(): nbits_requested=" << nbits_requested;
 
+    if (d_k7_engine)
+        {
+            k7_update(sym, nbits_requested);
+            // the newest traceback_depth bits can not be decoded yet, and the
+            // bits in excess of nbits_requested are overstepped
+            const auto size = static_cast<int>(d_k7_engine->size());
+            const int decoding_length_mismatch = size - (traceback_depth + nbits_requested);
+            const int skip = std::min(traceback_depth + std::max(decoding_length_mismatch, 0), size);
+            nbits_decoded = size - skip;
+            VLOG(FLOW) << "decoding length mismatch (continuous decoding): " << decoding_length_mismatch;
+            k7_tb_and_decode(skip, nbits_decoded, bits);
+            // remove the decoded states
+            d_k7_engine->discard(nbits_decoded);
+            return d_indicator_metric;
+        }
+
     // do add compare select
     do_acs(sym, nbits_requested);
     // the ML sequence in the newest part of the trellis can not be decoded
@@ -305,6 +340,38 @@ int Viterbi_Decoder_Sbas::do_tb_and_decode(int traceback_length, int requested_d
 }
 
 
+void Viterbi_Decoder_Sbas::k7_update(const double sym[], int nbits)
+{
+    d_k7_symbols.resize(d_nn * nbits);
+    for (int i = 0; i < d_nn * nbits; i++)
+        {
+            d_k7_symbols[i] = static_cast<float>(sym[i]);
+        }
+    d_k7_engine->update(d_k7_symbols.data(), nbits);
+}
+
+
+float Viterbi_Decoder_Sbas::k7_tb_and_decode(uint32_t skip, uint32_t nbits, int output_u_int[])
+{
+    const uint32_t n_of_branches_for_indicator_metric = 500;
+    d_k7_branch_metrics.resize(nbits);
+    d_k7_engine->traceback(0, skip, nbits, output_u_int, d_k7_branch_metrics.data());
+    // average of the survivor branch metrics of the newest decoded bits
+    const uint32_t n_im = std::min(nbits, n_of_branches_for_indicator_metric);
+    d_indicator_metric = 0;
+    for (uint32_t i = nbits - n_im; i < nbits; i++)
+        {
+            d_indicator_metric += d_k7_branch_metrics[i];
+        }
+    if (n_im > 0)
+        {
+            d_indicator_metric /= static_cast<float>(n_im);
+        }
+    VLOG(BLOCK) << "indicator metric: " << d_indicator_metric;
+    return d_indicator_metric;
+}
+
+
 /* function Gamma()
 
  Description: Computes the branch metric used for decoding.
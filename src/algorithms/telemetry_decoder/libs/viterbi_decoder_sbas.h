@@ -18,8 +18,11 @@
 #ifndef GNSS_SDR_VITERBI_DECODER_SBAS_H
 #define GNSS_SDR_VITERBI_DECODER_SBAS_H
 
+#include "viterbi_k7_engine.h"
 #include <cstddef>  // for size_t
+#include <cstdint>
 #include <deque>
+#include <memory>
 #include <vector>
 
 /** \addtogroup Telemetry_Decoder
@@ -29,7 +32,8 @@
 
 
 /*!
- * \brief Class that implements a Viterbi decoder
+ * \brief Class that implements a Viterbi decoder. The K=7, rate 1/2 codes
+ * are decoded by a Viterbi_K7_Engine.
  */
 class Viterbi_Decoder_Sbas
 {
@@ -91,6 +95,10 @@ private:
     int nsc_enc_bit(int state_out_p[], int input, int state_in, const int g[], int KK, int nn);
     int parity_counter(int symbol, int length);
 
+    // decoding with the K=7 engine
+    float k7_tb_and_decode(uint32_t skip, uint32_t nbits, int output_u_int[]);
+    void k7_update(const double sym[], int nbits);
+
     // trellis state
     std::deque<Prev> d_trellis_paths;
     std::vector<float> d_pm_t;
@@ -103,6 +111,11 @@ private:
     std::vector<int> d_out1;
     std::vector<int> d_state1;
 
+    // K=7 engine, and its symbol and branch metric buffers
+    std::unique_ptr<Viterbi_K7_Engine> d_k7_engine;
+    std::vector<float> d_k7_symbols;
+    std::vector<float> d_k7_branch_metrics;
+
     // measures
     float d_indicator_metric;
 
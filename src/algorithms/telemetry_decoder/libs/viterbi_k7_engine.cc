@@ -0,0 +1,151 @@
+/*!
+ * \file viterbi_k7_engine.cc
+ * \brief Viterbi decoder of the K=7, rate 1/2 convolutional codes, with a
+ * sliding window of survivor decisions for streaming.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "viterbi_k7_engine.h"
+#include <volk_gnsssdr/volk_gnsssdr.h>  // for volk_gnsssdr_32f_viterbi_k7_acs_32u
+#include <algorithm>                    // for std::copy, std::max, std::max_element, std::min
+
+
+namespace
+{
+const float MAXLOG = 1e7;  // Define infinity
+
+uint32_t parity(uint32_t word)
+{
+    uint32_t p = 0;
+    while (word != 0)
+        {
+            p ^= word & 1U;
+            word >>= 1U;
+        }
+    return p;
+}
+
+
+// the kernel takes the polynomials with the newest input bit in the LSB
+uint32_t reverse_7_bits(uint32_t word)
+{
+    uint32_t reversed = 0;
+    for (int32_t i = 0; i < 7; i++)
+        {
+            reversed = (reversed << 1U) | ((word >> i) & 1U);
+        }
+    return reversed;
+}
+}  // namespace
+
+
+Viterbi_K7_Engine::Viterbi_K7_Engine(const std::array<int32_t, 2>& g)
+{
+    for (int32_t k = 0; k < 2; k++)
+        {
+            const uint32_t poly = reverse_7_bits(static_cast<uint32_t>(g[k]));
+            for (uint32_t i = 0; i < 32; i++)
+                {
+                    d_branch_signs[32 * k + i] = parity((2 * i) & poly) ? 1.0F : -1.0F;
+                }
+        }
+    Viterbi_K7_Engine::reset();
+}
+
+
+bool Viterbi_K7_Engine::supports(int32_t KK, int32_t nn, const int32_t* g)
+{
+    return KK == 7 && nn == 2 && (g[0] & 0x41) == 0x41 && (g[1] & 0x41) == 0x41;
+}
+
+
+void Viterbi_K7_Engine::reset()
+{
+    d_metrics.fill(-MAXLOG);
+    d_metrics[0] = 0.0;  // start in all-zeros state
+    d_begin = 0;
+    d_end = 0;
+}
+
+
+void Viterbi_K7_Engine::update(const float* symbols, uint32_t nbits)
+{
+    reserve(nbits);
+    std::copy(symbols, symbols + 2 * nbits, d_symbols.begin() + 2 * d_end);
+    volk_gnsssdr_32f_viterbi_k7_acs_32u(d_decisions.data() + 2 * d_end, d_metrics.data(), symbols, d_branch_signs.data(), nbits);
+    d_end += nbits;
+}
+
+
+uint32_t Viterbi_K7_Engine::size() const
+{
+    return d_end - d_begin;
+}
+
+
+int32_t Viterbi_K7_Engine::best_state() const
+{
+    return static_cast<int32_t>(std::max_element(d_metrics.cbegin(), d_metrics.cend()) - d_metrics.cbegin());
+}
+
+
+void Viterbi_K7_Engine::traceback(int32_t state, uint32_t skip, uint32_t nbits, int32_t* bits, float* branch_metrics) const
+{
+    auto s = static_cast<uint32_t>(state) & 63U;
+    uint32_t t = d_end;
+    for (uint32_t k = 0; k < skip; k++)
+        {
+            t--;
+            const uint32_t decision = (d_decisions[2 * t + (s >> 5U)] >> (s & 31U)) & 1U;
+            s = (s >> 1U) | (decision << 5U);
+        }
+    for (uint32_t k = nbits; k > 0; k--)
+        {
+            t--;
+            const uint32_t decision = (d_decisions[2 * t + (s >> 5U)] >> (s & 31U)) & 1U;
+            bits[k - 1] = static_cast<int32_t>(s & 1U);
+            if (branch_metrics != nullptr)
+                {
+                    // +bm from state s >> 1 with input 0 and from state (s >> 1) + 32 with input 1, -bm otherwise
+                    const uint32_t i = s >> 1U;
+                    const float bm = d_symbols[2 * t] * d_branch_signs[i] + d_symbols[2 * t + 1] * d_branch_signs[32 + i];
+                    branch_metrics[k - 1] = ((s & 1U) ^ decision) ? -bm : bm;
+                }
+            s = (s >> 1U) | (decision << 5U);
+        }
+}
+
+
+void Viterbi_K7_Engine::discard(uint32_t nbits)
+{
+    d_begin += std::min(nbits, size());
+}
+
+
+void Viterbi_K7_Engine::reserve(uint32_t nbits)
+{
+    if (d_end + nbits <= d_decisions.size() / 2)
+        {
+            return;
+        }
+    // slide the window to the beginning of the buffers, and grow them if needed
+    std::copy(d_decisions.begin() + 2 * d_begin, d_decisions.begin() + 2 * d_end, d_decisions.begin());
+    std::copy(d_symbols.begin() + 2 * d_begin, d_symbols.begin() + 2 * d_end, d_symbols.begin());
+    d_end -= d_begin;
+    d_begin = 0;
+    if (d_end + nbits > d_decisions.size() / 2)
+        {
+            const size_t capacity = std::max(static_cast<size_t>(d_end + nbits), d_decisions.size());
+            d_decisions.resize(2 * capacity);
+            d_symbols.resize(2 * capacity);
+        }
+}
@@ -0,0 +1,106 @@
+/*!
+ * \file viterbi_k7_engine.h
+ * \brief Viterbi decoder of the K=7, rate 1/2 convolutional codes, with a
+ * sliding window of survivor decisions for streaming.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_VITERBI_K7_ENGINE_H
+#define GNSS_SDR_VITERBI_K7_ENGINE_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/** \addtogroup Telemetry_Decoder
+ * \{ */
+/** \addtogroup Telemetry_Decoder_libs
+ * \{ */
+
+
+/*!
+ * \brief Viterbi decoder of K=7, rate 1/2 convolutional codes, built on the
+ * SIMD add-compare-select kernel volk_gnsssdr_32f_viterbi_k7_acs_32u.
+ *
+ * The trellis sections are appended with update(), and their decisions are
+ * kept until they are discarded, so the same object can decode blocks
+ * (reset, update, traceback) or streams (update, traceback with a
+ * traceback depth, discard). There are no memory allocations once the
+ * history has grown to its working size.
+ */
+class Viterbi_K7_Engine
+{
+public:
+    /*!
+     * \brief Constructor
+     * \param[in] g  Generator polynomials G1 and G2, with the newest input bit
+     * in the most significant bit, as in Viterbi_Decoder (e.g., {121, 91})
+     */
+    explicit Viterbi_K7_Engine(const std::array<int32_t, 2>& g);
+
+    /*!
+     * \brief Returns true if the engine can decode the code of constraint
+     * length KK, rate 1/nn and polynomials g, which must have their first and
+     * last taps set.
+     */
+    static bool supports(int32_t KK, int32_t nn, const int32_t* g);
+
+    /*!
+     * \brief Clears the history and starts the trellis in the all-zeros state
+     */
+    void reset();
+
+    /*!
+     * \brief Appends nbits trellis sections
+     * \param[in] symbols 2 * nbits soft symbols in LLR form (positive for a code bit 1)
+     */
+    void update(const float* symbols, uint32_t nbits);
+
+    /*!
+     * \brief Number of trellis sections in the history
+     */
+    uint32_t size() const;
+
+    /*!
+     * \brief State with the largest path metric in the newest section
+     */
+    int32_t best_state() const;
+
+    /*!
+     * \brief Traces back the survivor path that ends at state in the newest
+     * section. The skip newest sections are not decoded, and the nbits
+     * previous ones are decoded into bits, oldest first. If branch_metrics is
+     * not null, it gets the branch metric of the survivor path at each
+     * decoded bit.
+     */
+    void traceback(int32_t state, uint32_t skip, uint32_t nbits, int32_t* bits, float* branch_metrics = nullptr) const;
+
+    /*!
+     * \brief Removes the nbits oldest sections from the history
+     */
+    void discard(uint32_t nbits);
+
+private:
+    void reserve(uint32_t nbits);
+
+    std::array<float, 64> d_branch_signs{};
+    std::array<float, 64> d_metrics{};
+    std::vector<uint32_t> d_decisions;  // two words per section
+    std::vector<float> d_symbols;       // two symbols per section
+    uint32_t d_begin{0};                // oldest section in the history
+    uint32_t d_end{0};                  // one past the newest section
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_VITERBI_K7_ENGINE_H
@@ -26,6 +26,7 @@
 #include "configuration_interface.h"
 #include "gnss_sdr_flags.h"
 #include <glog/logging.h>
+#include <algorithm>
 #include <utility>
 
 
@@ -53,6 +54,9 @@ GalileoE1TcpConnectorTracking::GalileoE1TcpConnectorTracking(
     float early_late_space_chips = configuration->property(role + ".early_late_space_chips", static_cast<float>(0.15));
     float very_early_late_space_chips = configuration->property(role + ".very_early_late_space_chips", static_cast<float>(0.5));
     size_t port_ch0 = configuration->property(role + ".port_ch0", 2060);
+    // 0: a connection per channel; > 0: one pipelined connection, with the periods of latency of the loop filter
+    const auto loop_latency = static_cast<uint32_t>(std::max(configuration->property(role + ".loop_latency", 0), 0));
+    const std::string shm_name = configuration->property(role + ".shm_name", std::string(""));  // pipelined connection in shared memory, if set
     const std::string default_dump_filename("./track_ch");
     std::string dump_filename = configuration->property(role + ".dump_filename", default_dump_filename);
     const auto vector_length = static_cast<int>(std::round(fs_in / (GALILEO_E1_CODE_CHIP_RATE_CPS / GALILEO_E1_B_CODE_LENGTH_CHIPS)));
@@ -70,7 +74,9 @@ GalileoE1TcpConnectorTracking::GalileoE1TcpConnectorTracking(
                 dll_bw_hz,
                 early_late_space_chips,
                 very_early_late_space_chips,
-                port_ch0);
+                port_ch0,
+                loop_latency,
+                shm_name);
         }
     else
         {
@@ -25,6 +25,7 @@
 #include "GPS_L1_CA.h"
 #include "configuration_interface.h"
 #include <glog/logging.h>
+#include <algorithm>
 #include <utility>
 
 
@@ -42,6 +43,9 @@ GpsL1CaTcpConnectorTracking::GpsL1CaTcpConnectorTracking(
     bool dump = configuration->property(role + ".dump", false);
     float early_late_space_chips = configuration->property(role + ".early_late_space_chips", static_cast<float>(0.5));
     size_t port_ch0 = configuration->property(role + ".port_ch0", 2060);
+    // 0: a connection per channel; > 0: one pipelined connection, with the periods of latency of the loop filter
+    const auto loop_latency = static_cast<uint32_t>(std::max(configuration->property(role + ".loop_latency", 0), 0));
+    const std::string shm_name = configuration->property(role + ".shm_name", std::string(""));  // pipelined connection in shared memory, if set
     const std::string default_dump_filename("./track_ch");
     std::string dump_filename = configuration->property(role + ".dump_filename", default_dump_filename);
     const auto vector_length = static_cast<int>(std::round(fs_in / (GPS_L1_CA_CODE_RATE_CPS / GPS_L1_CA_CODE_LENGTH_CHIPS)));
@@ -56,7 +60,9 @@ GpsL1CaTcpConnectorTracking::GpsL1CaTcpConnectorTracking(
                 dump,
                 dump_filename,
                 early_late_space_chips,
-                port_ch0);
+                port_ch0,
+                loop_latency,
+                shm_name);
         }
     else
         {
@@ -36,24 +36,30 @@
 #include "galileo_e1_signal_replica.h"
 #include "galileo_e5_signal_replica.h"
 #include "galileo_e6_signal_replica.h"
+#include "gnss_dump_reader.h"
+#include "gnss_replica_cache.h"
 #include "gnss_satellite.h"
 #include "gnss_sdr_create_directory.h"
 #include "gnss_sdr_filesystem.h"
 #include "gnss_synchro.h"
+#include "gnss_trace.h"
 #include "gps_l2c_signal_replica.h"
 #include "gps_l5_signal_replica.h"
 #include "gps_sdr_signal_replica.h"
 #include "lock_detectors.h"
 #include "tracking_discriminators.h"
 #include <glog/logging.h>
+#include <gnuradio/block_detail.h>   // for block_detail
+#include <gnuradio/buffer.h>         // for buffer_reader
 #include <gnuradio/io_signature.h>   // for io_signature
 #include <gnuradio/thread/thread.h>  // for scoped_lock
 #include <matio.h>                   // for Mat_VarCreate
 #include <pmt/pmt_sugar.h>           // for mp
 #include <volk_gnsssdr/volk_gnsssdr.h>
-#include <algorithm>  // for fill_n
+#include <algorithm>  // for fill_n, max
 #include <array>
 #include <cmath>      // for fmod, round, floor
+#include <cstring>    // for memcpy
 #include <exception>  // for exception
 #include <iostream>   // for cout, cerr
 #include <map>
@@ -61,6 +67,10 @@
 #include <numeric>
 #include <vector>
 
+#if GNURADIO_HAS_BUFFER_READER
+#include <gnuradio/buffer_reader.h>
+#endif
+
 #if HAS_GENERIC_LAMBDA
 #else
 #include <boost/bind/bind.hpp>
@@ -74,6 +84,17 @@ namespace wht = boost;
 namespace wht = std;
 #endif
 
+namespace
+{
+// Fields of the records written by log_data(), in the codes of gnss_dump_codec.h
+// (the tracking schema of src/utils/python/gnss_sdr_dump.py)
+const char *const TRACKING_DUMP_RECORD_LAYOUT = "fffffffQffffffffffffdI";
+
+// Epochs decoded at a time by save_matfile()
+const int32_t DUMP_READ_BLOCK_EPOCHS = 4096;
+}  // namespace
+
+
 dll_pll_veml_tracking_sptr dll_pll_veml_make_tracking(const Dll_Pll_Conf &conf_)
 {
     return dll_pll_veml_tracking_sptr(new dll_pll_veml_tracking(conf_));
@@ -81,7 +102,7 @@ dll_pll_veml_tracking_sptr dll_pll_veml_make_tracking(const Dll_Pll_Conf &conf_)
 
 
 dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_)
-    : gr::block("dll_pll_veml_tracking", gr::io_signature::make(1, 1, sizeof(gr_complex)),
+    : gr::block("dll_pll_veml_tracking", gr::io_signature::make(1, 1, conf_.item_type == "cbyte" ? sizeof(lv_8sc_t) : (conf_.item_type == "cshort" ? sizeof(lv_16sc_t) : conf_.array_elements * sizeof(gr_complex))),
           gr::io_signature::make(1, 1, sizeof(Gnss_Synchro))),
       d_trk_parameters(conf_),
       d_acquisition_gnss_synchro(nullptr),
@@ -104,14 +125,24 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_)
       d_code_phase_step_chips(0.0),
       d_code_phase_rate_step_chips(0.0),
       d_rem_code_phase_samples(0.0),  // Residual code phase (in chips)
+      d_sqm_delta(0.0),
+      d_sqm_ratio(0.0),
+      d_sqm_asymmetry(0.0),
+      d_run_dll_pll(&dll_pll_veml_tracking::run_dll_pll_kernel<false>),
+      d_save_correlation_results(&dll_pll_veml_tracking::save_correlation_results_kernel<false, false, false>),
       d_acq_sample_stamp(0ULL),
       d_rem_carr_phase_rad(0.0),  // Residual carrier phase
       d_state(0),                 // initial state: standby
       d_current_prn_length_samples(static_cast<int32_t>(d_trk_parameters.vector_length)),
       d_extend_correlation_symbols_count(0),
+      d_adaptive_lock_count(0),
+      d_adaptive_hold_count(1),
+      d_adaptive_period_count(0),
+      d_sqm_count(0),
       d_cn0_estimation_counter(0),
       d_carrier_lock_fail_counter(0),
       d_code_lock_fail_counter(0),
+      d_park_items(0),
       d_channel(0),
       d_secondary_code_length(0U),
       d_data_secondary_code_length(0U),
@@ -123,11 +154,19 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_)
       d_dump(d_trk_parameters.dump),
       d_dump_mat(d_trk_parameters.dump_mat && d_dump),
       d_acc_carrier_phase_initialized(false),
-      d_Flag_PLL_180_deg_phase_locked(false)
+      d_extended_integration(false),
+      d_Flag_PLL_180_deg_phase_locked(false),
+      d_tracking_bank_member(false),
+      d_integer_correlator(conf_.item_type == "cbyte" or conf_.item_type == "cshort"),
+      d_integer_correlator_16ic(conf_.item_type == "cshort"),
+      d_cuda_correlator(false)
 {
     // prevent telemetry symbols accumulation in output buffers
     this->set_max_noutput_items(1);
 
+    // bounds the number of channels running at a time, if the receiver sets it
+    d_worker_pool = Tracking_Worker_Pool::global_instance();
+
     // Telemetry bit synchronization message port input
     this->message_port_register_out(pmt::mp("events"));
     this->set_relative_rate(1.0 / static_cast<double>(d_trk_parameters.vector_length));
@@ -460,9 +499,6 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_)
     d_code_loop_filter = Tracking_loop_filter(static_cast<float>(d_code_period), d_trk_parameters.dll_bw_hz, d_trk_parameters.dll_filter_order, false);
     d_carrier_loop_filter.set_params(d_trk_parameters.fll_bw_hz, d_trk_parameters.pll_bw_hz, d_trk_parameters.pll_filter_order);
 
-    // Initialization of local code replica
-    // Get space for a vector with the sinboc(1,1) replica sampled 2x/chip
-    d_tracking_code.resize(2 * d_code_length_chips, 0.0);
     // correlator outputs (scalar)
     if (d_veml)
         {
@@ -505,7 +541,87 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_)
             d_prompt_data_shift = &d_local_code_shift_chips[1];
         }
 
-    d_multicorrelator_cpu.init(static_cast<int>(2 * d_trk_parameters.vector_length), d_n_correlator_taps);
+    if (d_trk_parameters.correlator_backend == "cuda")
+        {
+#if CUDA_GPU_ACCEL
+            if (d_integer_correlator)
+                {
+                    LOG(WARNING) << "The CUDA correlators do not support " << d_trk_parameters.item_type << " samples. Using the CPU correlators";
+                }
+            else
+                {
+                    d_cuda_correlator = true;
+                }
+#else
+            LOG(WARNING) << "GNSS-SDR was built without CUDA support. Using the CPU correlators";
+#endif
+        }
+
+    if (d_trk_parameters.array_elements > 1 and d_integer_correlator)
+        {
+            LOG(WARNING) << "The antenna array correlators do not support " << d_trk_parameters.item_type << " samples. Tracking a single element";
+            d_trk_parameters.array_elements = 1;
+        }
+
+    // If tracking uses the pilot signal, an extra prompt correlator for the data component shares the carrier wipe-off
+    if (d_trk_parameters.array_elements > 1)
+        {
+            // the samples of all the elements are correlated in one pass, and combined in the beam of the satellite
+            const auto n_elements = static_cast<int>(d_trk_parameters.array_elements);
+            d_multicorrelator_array.init(static_cast<int>(2 * d_trk_parameters.vector_length), d_n_correlator_taps, n_elements, d_trk_parameters.track_pilot ? 1 : 0);
+            d_array_steering = std::make_unique<Array_Beam_Steering>(n_elements, d_trk_parameters.array_steering_alpha);
+            d_element_correlator_outs = volk_gnsssdr::vector<gr_complex>(n_elements * d_n_correlator_taps);
+            d_element_Prompt_Data = volk_gnsssdr::vector<gr_complex>(n_elements);
+            if (d_cuda_correlator or d_trk_parameters.tracking_bank)
+                {
+                    LOG(WARNING) << "The antenna array correlators are computed by each channel. The CUDA correlators and the tracking correlator bank have been disabled";
+                    d_cuda_correlator = false;
+                    d_trk_parameters.tracking_bank = false;
+                }
+        }
+    else if (d_integer_correlator)
+        {
+            d_multicorrelator_8ic.init(static_cast<int>(2 * d_trk_parameters.vector_length), d_n_correlator_taps, d_trk_parameters.track_pilot ? 1 : 0);
+            if (d_trk_parameters.tracking_bank)
+                {
+                    LOG(WARNING) << "The tracking correlator bank does not support " << d_trk_parameters.item_type << " samples. It has been disabled";
+                    d_trk_parameters.tracking_bank = false;
+                }
+        }
+#if CUDA_GPU_ACCEL
+    else if (d_cuda_correlator)
+        {
+            // the channels of the receiver share a GPU correlator bank, so the CPU correlator bank is not used
+            d_multicorrelator_cuda.init(static_cast<int>(2 * d_trk_parameters.vector_length), d_n_correlator_taps, d_trk_parameters.track_pilot ? 1 : 0, d_trk_parameters.tracking_bank_max_wait_us);
+            d_trk_parameters.tracking_bank = false;
+        }
+#endif
+    else
+        {
+            d_multicorrelator_cpu.init(static_cast<int>(2 * d_trk_parameters.vector_length), d_n_correlator_taps, d_trk_parameters.track_pilot ? 1 : 0);
+        }
+
+    // signal quality monitoring correlators, at multiples of the tap spacing from the prompt one
+    if (d_trk_parameters.sqm_taps > 0)
+        {
+            if (d_array_steering != nullptr or d_integer_correlator or d_cuda_correlator)
+                {
+                    LOG(WARNING) << "The signal quality monitoring correlators are only computed by the CPU correlators of gr_complex samples. They have been disabled";
+                }
+            else
+                {
+                    // the taps are read from the prompt local code at integer sample shifts
+                    const auto n_pairs = static_cast<int32_t>(d_trk_parameters.sqm_taps);
+                    const int spacing_samples = std::max(static_cast<int>(std::round(d_trk_parameters.sqm_tap_spacing_chips * d_trk_parameters.fs_in / d_code_chip_rate)), 1);
+                    std::vector<int> sqm_shifts_samples(2 * n_pairs + 1);
+                    for (int32_t k = -n_pairs; k <= n_pairs; k++)
+                        {
+                            sqm_shifts_samples[k + n_pairs] = k * spacing_samples;
+                        }
+                    d_sqm_outs = volk_gnsssdr::vector<gr_complex>(2 * n_pairs + 1);
+                    d_multicorrelator_cpu.set_sqm_taps(2 * n_pairs + 1, sqm_shifts_samples.data(), d_sqm_outs.data());
+                }
+        }
 
     if (d_trk_parameters.extend_correlation_symbols > 1)
         {
@@ -516,22 +632,30 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_)
             d_enable_extended_integration = false;
             d_trk_parameters.extend_correlation_symbols = 1;
         }
-
-    // Enable Data component prompt correlator (slave to Pilot prompt) if tracking uses Pilot signal
-    if (d_trk_parameters.track_pilot)
+    if (d_trk_parameters.adaptive_integration)
         {
-            // Extra correlator for the data component
-            d_correlator_data_cpu.init(static_cast<int>(2 * d_trk_parameters.vector_length), 1);
-            d_correlator_data_cpu.set_high_dynamics_resampler(d_trk_parameters.high_dyn);
-            d_data_code.resize(2 * d_code_length_chips, 0.0);
+            if (d_enable_extended_integration)
+                {
+                    d_adaptive_hold_count = std::max(static_cast<int32_t>(std::round(d_trk_parameters.adaptive_integration_hold_time_s / d_code_period)), 1);
+                }
+            else
+                {
+                    LOG(WARNING) << "Adaptive integration requires extend_correlation_symbols bigger than 1. It has been disabled";
+                    d_trk_parameters.adaptive_integration = false;
+                }
         }
 
     // --- Initializations ---
-    d_Prompt_circular_buffer.set_capacity(d_secondary_code_length);
+    d_secondary_correlator = Gnss_Sign_Correlator::from_string(d_secondary_code_string.substr(0, d_secondary_code_length));
     d_multicorrelator_cpu.set_high_dynamics_resampler(d_trk_parameters.high_dyn);
+    d_multicorrelator_cpu.set_kernel_implementations(d_trk_parameters.volk_rotator_impl, d_trk_parameters.volk_resampler_impl);
+    if (d_trk_parameters.code_replica_cache)
+        {
+            d_multicorrelator_cpu.set_code_replica_cache(static_cast<int>(d_trk_parameters.code_replica_phases_per_chip));
+        }
 
     // CN0 estimation and lock detector buffers
-    d_Prompt_buffer = volk_gnsssdr::vector<gr_complex>(d_trk_parameters.cn0_samples);
+    d_cn0_estimator = Cn0_M2M4_Estimator(d_trk_parameters.cn0_samples);
     d_Prompt_Data = volk_gnsssdr::vector<gr_complex>(1);
     d_cn0_smoother = Exponential_Smoother();
     d_cn0_smoother.set_alpha(d_trk_parameters.cn0_smoother_alpha);
@@ -595,6 +719,7 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_)
         }
     d_last_timetag_samplecounter = 0;
     d_timetag_waiting = false;
+    d_timetag_key = pmt::mp("timetag");
     set_tag_propagation_policy(TPP_DONT);  // no tag propagation, the time tag will be adjusted and regenerated in work()
 }
 
@@ -605,6 +730,11 @@ void dll_pll_veml_tracking::forecast(int noutput_items,
     if (noutput_items != 0)
         {
             ninput_items_required[0] = static_cast<int32_t>(d_trk_parameters.vector_length) * 2;
+            if (d_state == 0 and d_park_items > ninput_items_required[0])
+                {
+                    // Parked: wait until a quarter of the input buffer is filled
+                    ninput_items_required[0] = d_park_items;
+                }
         }
 }
 
@@ -653,109 +783,115 @@ void dll_pll_veml_tracking::start_tracking()
     Signal_[1] = d_acquisition_gnss_synchro->Signal[1];
     Signal_[2] = d_acquisition_gnss_synchro->Signal[2];
 
+    // The replicas are shared by all the channels tracking the same signal.
+    // There is room for the sinboc(1,1) replica sampled 2x/chip
+    Gnss_Replica_Cache& replicas = Gnss_Replica_Cache::get();
+    const uint32_t PRN = d_acquisition_gnss_synchro->PRN;
+    const auto code_size = static_cast<size_t>(2 * d_code_length_chips);
     if (d_systemName == "GPS" and d_signal_type == "1C")
         {
-            gps_l1_ca_code_gen_float(d_tracking_code, d_acquisition_gnss_synchro->PRN, 0);
+            d_tracking_code = replicas.get_float("GPS 1C", PRN, 0.0, "chips", code_size,
+                [PRN](own::span<float> code) { gps_l1_ca_code_gen_float(code, PRN, 0); });
         }
     else if (d_systemName == "GPS" and d_signal_type == "2S")
         {
-            gps_l2c_m_code_gen_float(d_tracking_code, d_acquisition_gnss_synchro->PRN);
+            d_tracking_code = replicas.get_float("GPS 2S", PRN, 0.0, "chips", code_size,
+                [PRN](own::span<float> code) { gps_l2c_m_code_gen_float(code, PRN); });
         }
     else if (d_systemName == "GPS" and d_signal_type == "L5")
         {
+            const auto data_code = replicas.get_float("GPS L5", PRN, 0.0, "chips data", code_size,
+                [PRN](own::span<float> code) { gps_l5i_code_gen_float(code, PRN); });
             if (d_trk_parameters.track_pilot)
                 {
-                    gps_l5q_code_gen_float(d_tracking_code, d_acquisition_gnss_synchro->PRN);
-                    gps_l5i_code_gen_float(d_data_code, d_acquisition_gnss_synchro->PRN);
+                    d_tracking_code = replicas.get_float("GPS L5", PRN, 0.0, "chips pilot", code_size,
+                        [PRN](own::span<float> code) { gps_l5q_code_gen_float(code, PRN); });
+                    d_data_code = data_code;
                     d_Prompt_Data[0] = gr_complex(0.0, 0.0);
-                    d_correlator_data_cpu.set_local_code_and_taps(d_code_length_chips, d_data_code.data(), d_prompt_data_shift);
+                    set_data_local_code_and_taps(d_code_length_chips, d_data_code->data(), d_prompt_data_shift);
                 }
             else
                 {
-                    gps_l5i_code_gen_float(d_tracking_code, d_acquisition_gnss_synchro->PRN);
+                    d_tracking_code = data_code;
                 }
         }
     else if (d_systemName == "Galileo" and d_signal_type == "1B")
         {
+            const std::array<char, 3> data_signal = Signal_;
+            const auto data_code = replicas.get_float("Galileo 1B", PRN, 0.0, "sinboc11 data", code_size,
+                [data_signal, PRN](own::span<float> code) { galileo_e1_code_gen_sinboc11_float(code, data_signal, PRN); });
             if (d_trk_parameters.track_pilot)
                 {
-                    const std::array<char, 3> pilot_signal = {{'1', 'C', '\0'}};
-                    galileo_e1_code_gen_sinboc11_float(d_tracking_code, pilot_signal, d_acquisition_gnss_synchro->PRN);
-                    galileo_e1_code_gen_sinboc11_float(d_data_code, Signal_, d_acquisition_gnss_synchro->PRN);
+                    d_tracking_code = replicas.get_float("Galileo 1B", PRN, 0.0, "sinboc11 pilot", code_size,
+                        [PRN](own::span<float> code) { galileo_e1_code_gen_sinboc11_float(code, {{'1', 'C', '\0'}}, PRN); });
+                    d_data_code = data_code;
                     d_Prompt_Data[0] = gr_complex(0.0, 0.0);
-                    d_correlator_data_cpu.set_local_code_and_taps(d_code_samples_per_chip * d_code_length_chips, d_data_code.data(), d_prompt_data_shift);
+                    set_data_local_code_and_taps(d_code_samples_per_chip * d_code_length_chips, d_data_code->data(), d_prompt_data_shift);
                 }
             else
                 {
-                    galileo_e1_code_gen_sinboc11_float(d_tracking_code, Signal_, d_acquisition_gnss_synchro->PRN);
+                    d_tracking_code = data_code;
                 }
         }
-    else if (d_systemName == "Galileo" and d_signal_type == "5X")
+    else if (d_systemName == "Galileo" and (d_signal_type == "5X" or d_signal_type == "7X"))
         {
-            volk_gnsssdr::vector<gr_complex> aux_code(d_code_length_chips);
-            const std::array<char, 3> signal_type_ = {{'5', 'X', '\0'}};
-            galileo_e5_a_code_gen_complex_primary(aux_code, d_acquisition_gnss_synchro->PRN, signal_type_);
-            if (d_trk_parameters.track_pilot)
-                {
-                    d_secondary_code_string = GALILEO_E5A_Q_SECONDARY_CODE[d_acquisition_gnss_synchro->PRN - 1];
-                    for (int32_t i = 0; i < d_code_length_chips; i++)
-                        {
-                            d_tracking_code[i] = aux_code[i].imag();
-                            d_data_code[i] = aux_code[i].real();  // the same because it is generated the full signal (E5aI + E5aQ)
-                        }
-                    d_Prompt_Data[0] = gr_complex(0.0, 0.0);
-                    d_correlator_data_cpu.set_local_code_and_taps(d_code_length_chips, d_data_code.data(), d_prompt_data_shift);
-                }
-            else
-                {
-                    for (int32_t i = 0; i < d_code_length_chips; i++)
-                        {
-                            d_tracking_code[i] = aux_code[i].real();
-                        }
-                }
-        }
-    else if (d_systemName == "Galileo" and d_signal_type == "7X")
-        {
-            volk_gnsssdr::vector<gr_complex> aux_code(d_code_length_chips);
-            const std::array<char, 3> signal_type_ = {{'7', 'X', '\0'}};
-            galileo_e5_b_code_gen_complex_primary(aux_code, d_acquisition_gnss_synchro->PRN, signal_type_);
+            // the complex primary codes have the data (I) component in the real part and the pilot (Q) one in the imaginary part
+            const std::string signal = "Galileo " + d_signal_type;
+            const bool e5a = d_signal_type == "5X";
+            const int32_t code_length_chips = d_code_length_chips;
+            auto primary_component = [e5a, PRN, code_length_chips](own::span<float> code, bool pilot) {
+                volk_gnsssdr::vector<gr_complex> aux_code(code_length_chips);
+                if (e5a)
+                    {
+                        galileo_e5_a_code_gen_complex_primary(aux_code, PRN, {{'5', 'X', '\0'}});
+                    }
+                else
+                    {
+                        galileo_e5_b_code_gen_complex_primary(aux_code, PRN, {{'7', 'X', '\0'}});
+                    }
+                for (int32_t i = 0; i < code_length_chips; i++)
+                    {
+                        code[i] = pilot ? aux_code[i].imag() : aux_code[i].real();
+                    }
+            };
+            const auto data_code = replicas.get_float(signal, PRN, 0.0, "chips data", code_size,
+                [&primary_component](own::span<float> code) { primary_component(code, false); });
             if (d_trk_parameters.track_pilot)
                 {
-                    d_secondary_code_string = GALILEO_E5B_Q_SECONDARY_CODE[d_acquisition_gnss_synchro->PRN - 1];
-                    for (int32_t i = 0; i < d_code_length_chips; i++)
-                        {
-                            d_tracking_code[i] = aux_code[i].imag();
-                            d_data_code[i] = aux_code[i].real();  // the same because it is generated the full signal (E5bI + E5bsQ)
-                        }
+                    d_secondary_code_string = e5a ? GALILEO_E5A_Q_SECONDARY_CODE[PRN - 1] : GALILEO_E5B_Q_SECONDARY_CODE[PRN - 1];
+                    d_tracking_code = replicas.get_float(signal, PRN, 0.0, "chips pilot", code_size,
+                        [&primary_component](own::span<float> code) { primary_component(code, true); });
+                    d_data_code = data_code;
                     d_Prompt_Data[0] = gr_complex(0.0, 0.0);
-                    d_correlator_data_cpu.set_local_code_and_taps(d_code_length_chips, d_data_code.data(), d_prompt_data_shift);
+                    set_data_local_code_and_taps(d_code_length_chips, d_data_code->data(), d_prompt_data_shift);
                 }
             else
                 {
-                    for (int32_t i = 0; i < d_code_length_chips; i++)
-                        {
-                            d_tracking_code[i] = aux_code[i].real();
-                        }
+                    d_tracking_code = data_code;
                 }
         }
     else if (d_systemName == "Galileo" and d_signal_type == "E6")
         {
+            const auto data_code = replicas.get_float("Galileo E6", PRN, 0.0, "chips data", code_size,
+                [PRN](own::span<float> code) { galileo_e6_b_code_gen_float_primary(code, PRN); });
             if (d_trk_parameters.track_pilot)
                 {
-                    d_secondary_code_string = galileo_e6_c_secondary_code(d_acquisition_gnss_synchro->PRN);
-                    galileo_e6_b_code_gen_float_primary(d_data_code, d_acquisition_gnss_synchro->PRN);
-                    galileo_e6_c_code_gen_float_primary(d_tracking_code, d_acquisition_gnss_synchro->PRN);
+                    d_secondary_code_string = galileo_e6_c_secondary_code(PRN);
+                    d_tracking_code = replicas.get_float("Galileo E6", PRN, 0.0, "chips pilot", code_size,
+                        [PRN](own::span<float> code) { galileo_e6_c_code_gen_float_primary(code, PRN); });
+                    d_data_code = data_code;
                     d_Prompt_Data[0] = gr_complex(0.0, 0.0);
-                    d_correlator_data_cpu.set_local_code_and_taps(d_code_samples_per_chip * d_code_length_chips, d_data_code.data(), d_prompt_data_shift);
+                    set_data_local_code_and_taps(d_code_samples_per_chip * d_code_length_chips, d_data_code->data(), d_prompt_data_shift);
                 }
             else
                 {
-                    galileo_e6_b_code_gen_float_primary(d_tracking_code, d_acquisition_gnss_synchro->PRN);
+                    d_tracking_code = data_code;
                 }
         }
     else if (d_systemName == "Beidou" and d_signal_type == "B1")
         {
-            beidou_b1i_code_gen_float(d_tracking_code, d_acquisition_gnss_synchro->PRN, 0);
+            d_tracking_code = replicas.get_float("Beidou B1", PRN, 0.0, "chips", code_size,
+                [PRN](own::span<float> code) { beidou_b1i_code_gen_float(code, PRN, 0); });
             // GEO Satellites use different secondary code
             if (d_acquisition_gnss_synchro->PRN > 0 and d_acquisition_gnss_synchro->PRN < 6)
                 {
@@ -768,7 +904,6 @@ void dll_pll_veml_tracking::start_tracking()
                     d_secondary_code_length = static_cast<uint32_t>(BEIDOU_B1I_GEO_PREAMBLE_LENGTH_SYMBOLS);
                     d_secondary_code_string = BEIDOU_B1I_GEO_PREAMBLE_SYMBOLS_STR;
                     d_data_secondary_code_length = 0;
-                    d_Prompt_circular_buffer.set_capacity(d_secondary_code_length);
                 }
             else
                 {
@@ -782,13 +917,13 @@ void dll_pll_veml_tracking::start_tracking()
                     d_secondary_code_string = BEIDOU_B1I_SECONDARY_CODE_STR;
                     d_data_secondary_code_length = static_cast<uint32_t>(BEIDOU_B1I_SECONDARY_CODE_LENGTH);
                     d_data_secondary_code_string = BEIDOU_B1I_SECONDARY_CODE_STR;
-                    d_Prompt_circular_buffer.set_capacity(d_secondary_code_length);
                 }
         }
 
     else if (d_systemName == "Beidou" and d_signal_type == "B3")
         {
-            beidou_b3i_code_gen_float(d_tracking_code, d_acquisition_gnss_synchro->PRN, 0);
+            d_tracking_code = replicas.get_float("Beidou B3", PRN, 0.0, "chips", code_size,
+                [PRN](own::span<float> code) { beidou_b3i_code_gen_float(code, PRN, 0); });
             // Update secondary code settings for geo satellites
             if (d_acquisition_gnss_synchro->PRN > 0 and d_acquisition_gnss_synchro->PRN < 6)
                 {
@@ -801,7 +936,6 @@ void dll_pll_veml_tracking::start_tracking()
                     d_secondary_code_length = static_cast<uint32_t>(BEIDOU_B3I_GEO_PREAMBLE_LENGTH_SYMBOLS);
                     d_secondary_code_string = BEIDOU_B3I_GEO_PREAMBLE_SYMBOLS_STR;
                     d_data_secondary_code_length = 0;
-                    d_Prompt_circular_buffer.set_capacity(d_secondary_code_length);
                 }
             else
                 {
@@ -815,11 +949,34 @@ void dll_pll_veml_tracking::start_tracking()
                     d_secondary_code_string = BEIDOU_B3I_SECONDARY_CODE_STR;
                     d_data_secondary_code_length = static_cast<uint32_t>(BEIDOU_B3I_SECONDARY_CODE_LENGTH);
                     d_data_secondary_code_string = BEIDOU_B3I_SECONDARY_CODE_STR;
-                    d_Prompt_circular_buffer.set_capacity(d_secondary_code_length);
                 }
         }
 
-    d_multicorrelator_cpu.set_local_code_and_taps(d_code_samples_per_chip * d_code_length_chips, d_tracking_code.data(), d_local_code_shift_chips.data());
+    if (d_tracking_code == nullptr)
+        {
+            // invalid signal, already reported when instantiating the block
+            d_tracking_code = replicas.get_float(d_systemName + " " + d_signal_type, PRN, 0.0, "zeros", code_size, [](own::span<float> /*code*/) {});
+        }
+
+    if (d_array_steering != nullptr)
+        {
+            d_multicorrelator_array.set_local_code_and_taps(d_code_samples_per_chip * d_code_length_chips, d_tracking_code->data(), d_local_code_shift_chips.data());
+            d_array_steering->reset();
+        }
+    else if (d_integer_correlator)
+        {
+            d_multicorrelator_8ic.set_local_code_and_taps(d_code_samples_per_chip * d_code_length_chips, d_tracking_code->data(), d_local_code_shift_chips.data());
+        }
+#if CUDA_GPU_ACCEL
+    else if (d_cuda_correlator)
+        {
+            d_multicorrelator_cuda.set_local_code_and_taps(d_code_samples_per_chip * d_code_length_chips, d_tracking_code->data(), d_local_code_shift_chips.data());
+        }
+#endif
+    else
+        {
+            d_multicorrelator_cpu.set_local_code_and_taps(d_code_samples_per_chip * d_code_length_chips, d_tracking_code->data(), d_local_code_shift_chips.data());
+        }
     std::fill_n(d_correlator_outs.begin(), d_n_correlator_taps, gr_complex(0.0, 0.0));
 
     d_carrier_lock_fail_counter = 0;
@@ -829,6 +986,7 @@ void dll_pll_veml_tracking::start_tracking()
     d_rem_code_phase_chips = 0.0;
     d_acc_carrier_phase_rad = 0.0;
     d_cn0_estimation_counter = 0;
+    d_cn0_estimator.reset();
     d_carrier_lock_test = 1.0;
     d_CN0_SNV_dB_Hz = 0.0;
 
@@ -846,6 +1004,7 @@ void dll_pll_veml_tracking::start_tracking()
         }
 
     d_current_correlation_time_s = d_code_period;
+    d_extended_integration = false;
 
     // Initialize tracking  ==========================================
     d_carrier_loop_filter.set_params(d_trk_parameters.fll_bw_hz, d_trk_parameters.pll_bw_hz, d_trk_parameters.pll_filter_order);
@@ -863,9 +1022,10 @@ void dll_pll_veml_tracking::start_tracking()
     d_state = 1;
     d_cloop = true;
     d_pull_in_transitory = true;
-    d_Prompt_circular_buffer.clear();
+    d_secondary_correlator = Gnss_Sign_Correlator::from_string(d_secondary_code_string.substr(0, d_secondary_code_length));
     d_corrected_doppler = false;
     d_acc_carrier_phase_initialized = false;
+    select_tracking_kernels();
 }
 
 
@@ -895,11 +1055,16 @@ dll_pll_veml_tracking::~dll_pll_veml_tracking()
         }
     try
         {
-            if (d_trk_parameters.track_pilot)
+            d_multicorrelator_cpu.free();
+            d_multicorrelator_8ic.free();
+            d_multicorrelator_array.free();
+#if CUDA_GPU_ACCEL
+            d_multicorrelator_cuda.free();
+#endif
+            if (d_tracking_bank_member and d_tracking_bank != nullptr)
                 {
-                    d_correlator_data_cpu.free();
+                    d_tracking_bank->leave();
                 }
-            d_multicorrelator_cpu.free();
         }
     catch (const std::exception &ex)
         {
@@ -911,32 +1076,7 @@ dll_pll_veml_tracking::~dll_pll_veml_tracking()
 bool dll_pll_veml_tracking::acquire_secondary()
 {
     // ******* preamble correlation ********
-    int32_t corr_value = 0;
-    for (uint32_t i = 0; i < d_secondary_code_length; i++)
-        {
-            if (d_Prompt_circular_buffer[i].real() < 0.0)  // symbols clipping
-                {
-                    if (d_secondary_code_string[i] == '0')
-                        {
-                            corr_value++;
-                        }
-                    else
-                        {
-                            corr_value--;
-                        }
-                }
-            else
-                {
-                    if (d_secondary_code_string[i] == '0')
-                        {
-                            corr_value--;
-                        }
-                    else
-                        {
-                            corr_value++;
-                        }
-                }
-        }
+    const int32_t corr_value = d_secondary_correlator.correlation();
 
     if (abs(corr_value) == static_cast<int32_t>(d_secondary_code_length))
         {
@@ -958,21 +1098,20 @@ bool dll_pll_veml_tracking::acquire_secondary()
 bool dll_pll_veml_tracking::cn0_and_tracking_lock_status(double coh_integration_time_s)
 {
     // ####### CN0 ESTIMATION AND LOCK DETECTORS ######
+    // the estimator keeps the last cn0_samples prompt correlator outputs
+    d_cn0_estimator.update(d_P_accu);
     if (d_cn0_estimation_counter < d_trk_parameters.cn0_samples)
         {
-            // fill buffer with prompt correlator output values
-            d_Prompt_buffer[d_cn0_estimation_counter] = d_P_accu;
             d_cn0_estimation_counter++;
             return true;
         }
 
-    d_Prompt_buffer[d_cn0_estimation_counter % d_trk_parameters.cn0_samples] = d_P_accu;
     d_cn0_estimation_counter++;
     // Code lock indicator
-    const float d_CN0_SNV_dB_Hz_raw = cn0_m2m4_estimator(d_Prompt_buffer.data(), d_trk_parameters.cn0_samples, static_cast<float>(coh_integration_time_s));
+    const float d_CN0_SNV_dB_Hz_raw = d_cn0_estimator.cn0(static_cast<float>(coh_integration_time_s));
     d_CN0_SNV_dB_Hz = d_cn0_smoother.smooth(d_CN0_SNV_dB_Hz_raw);
     // Carrier lock indicator
-    d_carrier_lock_test = d_carrier_lock_test_smoother.smooth(carrier_lock_detector(d_Prompt_buffer.data(), 1));
+    d_carrier_lock_test = d_carrier_lock_test_smoother.smooth(carrier_lock_detector(d_cn0_estimator.window(), 1));
     // Loss of lock detection
     if (!d_pull_in_transitory)
         {
@@ -1015,16 +1154,219 @@ bool dll_pll_veml_tracking::cn0_and_tracking_lock_status(double coh_integration_
 }
 
 
+void dll_pll_veml_tracking::set_extended_integration(bool extended)
+{
+    d_extended_integration = extended;
+    d_extend_correlation_symbols_count = 0;
+    const int32_t integration_periods = extended ? d_trk_parameters.extend_correlation_symbols : 1;
+    d_current_correlation_time_s = static_cast<float>(integration_periods) * static_cast<float>(d_code_period);
+    if (extended)
+        {
+            LOG(INFO) << "Enabled " << integration_periods * static_cast<int32_t>(d_code_period * 1000.0) << " ms extended correlator in channel "
+                      << d_channel
+                      << " for satellite " << Gnss_Satellite(d_systemName, d_acquisition_gnss_synchro->PRN);
+            if (!d_trk_parameters.adaptive_integration)
+                {
+                    std::cout << "Enabled " << integration_periods * static_cast<int32_t>(d_code_period * 1000.0) << " ms extended correlator in channel "
+                              << d_channel
+                              << " for satellite " << Gnss_Satellite(d_systemName, d_acquisition_gnss_synchro->PRN) << '\n';
+                }
+        }
+    else
+        {
+            LOG(INFO) << "Disabled the extended correlator in channel " << d_channel
+                      << " for satellite " << Gnss_Satellite(d_systemName, d_acquisition_gnss_synchro->PRN)
+                      << " (C/N0 = " << d_CN0_SNV_dB_Hz << " dB-Hz)";
+        }
+
+    // Set narrow (extended) or wide taps delay values [chips] and loop bandwidths
+    const float early_late_space_chips = extended ? d_trk_parameters.early_late_space_narrow_chips : d_trk_parameters.early_late_space_chips;
+    const float very_early_late_space_chips = extended ? d_trk_parameters.very_early_late_space_narrow_chips : d_trk_parameters.very_early_late_space_chips;
+    d_code_loop_filter.set_update_interval(static_cast<float>(d_current_correlation_time_s));
+    d_code_loop_filter.set_noise_bandwidth(extended ? d_trk_parameters.dll_bw_narrow_hz : d_trk_parameters.dll_bw_hz);
+    d_carrier_loop_filter.set_params(d_trk_parameters.fll_bw_hz, extended ? d_trk_parameters.pll_bw_narrow_hz : d_trk_parameters.pll_bw_hz, d_trk_parameters.pll_filter_order);
+    if (d_veml)
+        {
+            d_local_code_shift_chips[0] = -very_early_late_space_chips * static_cast<float>(d_code_samples_per_chip);
+            d_local_code_shift_chips[1] = -early_late_space_chips * static_cast<float>(d_code_samples_per_chip);
+            d_local_code_shift_chips[3] = early_late_space_chips * static_cast<float>(d_code_samples_per_chip);
+            d_local_code_shift_chips[4] = very_early_late_space_chips * static_cast<float>(d_code_samples_per_chip);
+            // if (std::string(d_trk_parameters.signal) == "E1")
+            //    {
+            //        d_trk_parameters.slope = -CalculateSlopeAbs(&SinBocCorrelationFunction<1, 1>, d_trk_parameters.spc);
+            //        d_trk_parameters.y_intercept = GetYInterceptAbs(&SinBocCorrelationFunction<1, 1>, d_trk_parameters.spc);
+            //    }
+        }
+    else
+        {
+            d_local_code_shift_chips[0] = -early_late_space_chips * static_cast<float>(d_code_samples_per_chip);
+            d_local_code_shift_chips[2] = early_late_space_chips * static_cast<float>(d_code_samples_per_chip);
+        }
+    d_trk_parameters.spc = early_late_space_chips;
+}
+
+
+void dll_pll_veml_tracking::update_adaptive_integration()
+{
+    // called at the end of each integration period of the narrow tracking state
+    if (d_extended_integration)
+        {
+            // fall back to the short integration on lock stress
+            if (d_CN0_SNV_dB_Hz < d_trk_parameters.adaptive_integration_cn0_db_hz - d_trk_parameters.adaptive_integration_hysteresis_db or d_carrier_lock_fail_counter > 0)
+                {
+                    set_extended_integration(false);
+                    d_adaptive_lock_count = 0;
+                    d_adaptive_period_count = 0;
+                    // the C/N0 estimator window must not mix prompts of different integration times
+                    d_cn0_estimator.reset();
+                    d_cn0_estimation_counter = 0;
+                }
+            return;
+        }
+
+    if (d_CN0_SNV_dB_Hz >= d_trk_parameters.adaptive_integration_cn0_db_hz and d_carrier_lock_fail_counter == 0 and d_code_lock_fail_counter == 0)
+        {
+            d_adaptive_lock_count++;
+        }
+    else
+        {
+            d_adaptive_lock_count = 0;
+        }
+    // the extended integration periods must start at the same symbols as if they had been enabled after the bit synchronization
+    d_adaptive_period_count = (d_adaptive_period_count + 1) % d_trk_parameters.extend_correlation_symbols;
+    if (d_adaptive_lock_count >= d_adaptive_hold_count and d_adaptive_period_count == 0)
+        {
+            set_extended_integration(true);
+            d_cn0_estimator.reset();
+            d_cn0_estimation_counter = 0;
+        }
+}
+
+
 // correlation requires:
 // - updated remnant carrier phase in radians (rem_carr_phase_rad)
 // - updated remnant code phase in samples (d_rem_code_phase_samples)
 // - d_code_freq_chips
 // - d_carrier_doppler_hz
-void dll_pll_veml_tracking::do_correlation_step(const gr_complex *input_samples)
+void dll_pll_veml_tracking::set_data_local_code_and_taps(int32_t code_length_chips, const float *local_code_in, float *shifts_chips)
+{
+    if (d_array_steering != nullptr)
+        {
+            d_multicorrelator_array.set_data_local_code_and_taps(code_length_chips, local_code_in, shifts_chips);
+        }
+    else if (d_integer_correlator)
+        {
+            d_multicorrelator_8ic.set_data_local_code_and_taps(code_length_chips, local_code_in, shifts_chips);
+        }
+#if CUDA_GPU_ACCEL
+    else if (d_cuda_correlator)
+        {
+            d_multicorrelator_cuda.set_data_local_code_and_taps(code_length_chips, local_code_in, shifts_chips);
+        }
+#endif
+    else
+        {
+            d_multicorrelator_cpu.set_data_local_code_and_taps(code_length_chips, local_code_in, shifts_chips);
+        }
+}
+
+
+void dll_pll_veml_tracking::do_correlation_step(const void *input_samples)
 {
     // ################# CARRIER WIPEOFF AND CORRELATORS ##############################
-    // perform carrier wipe-off and compute Early, Prompt and Late correlation
-    d_multicorrelator_cpu.set_input_output_vectors(d_correlator_outs.data(), input_samples);
+    // perform carrier wipe-off and compute Early, Prompt and Late correlation,
+    // and the DATA prompt correlation (if tracking tracks the pilot signal)
+    if (d_array_steering != nullptr)
+        {
+            // correlations of the elements, combined with the weights of the previous integrations
+            d_multicorrelator_array.set_input_output_vectors(d_element_correlator_outs.data(), static_cast<const gr_complex *>(input_samples));
+            if (d_trk_parameters.track_pilot)
+                {
+                    d_multicorrelator_array.set_data_output_vector(d_element_Prompt_Data.data());
+                }
+            d_multicorrelator_array.Carrier_wipeoff_multicorrelator_resampler(
+                d_rem_carr_phase_rad,
+                static_cast<float>(d_carrier_phase_step_rad), static_cast<float>(d_carrier_phase_rate_step_rad),
+                static_cast<float>(d_rem_code_phase_chips) * static_cast<float>(d_code_samples_per_chip),
+                static_cast<float>(d_code_phase_step_chips) * static_cast<float>(d_code_samples_per_chip),
+                static_cast<float>(d_code_phase_rate_step_chips) * static_cast<float>(d_code_samples_per_chip),
+                d_trk_parameters.vector_length);
+            d_array_steering->combine(d_element_correlator_outs.data(), d_n_correlator_taps, d_correlator_outs.data());
+            if (d_trk_parameters.track_pilot)
+                {
+                    d_array_steering->combine(d_element_Prompt_Data.data(), 1, d_Prompt_Data.data());
+                }
+            d_array_steering->update(d_element_correlator_outs.data(), d_n_correlator_taps, static_cast<int>(d_Prompt - d_correlator_outs.data()));
+            return;
+        }
+    if (d_integer_correlator)
+        {
+            if (d_integer_correlator_16ic)
+                {
+                    d_multicorrelator_8ic.set_input_output_vectors(d_correlator_outs.data(), static_cast<const lv_16sc_t *>(input_samples));
+                }
+            else
+                {
+                    d_multicorrelator_8ic.set_input_output_vectors(d_correlator_outs.data(), static_cast<const lv_8sc_t *>(input_samples));
+                }
+            if (d_trk_parameters.track_pilot)
+                {
+                    d_multicorrelator_8ic.set_data_output_vector(d_Prompt_Data.data());
+                }
+            d_multicorrelator_8ic.Carrier_wipeoff_multicorrelator_resampler(
+                d_rem_carr_phase_rad,
+                static_cast<float>(d_carrier_phase_step_rad), static_cast<float>(d_carrier_phase_rate_step_rad),
+                static_cast<float>(d_rem_code_phase_chips) * static_cast<float>(d_code_samples_per_chip),
+                static_cast<float>(d_code_phase_step_chips) * static_cast<float>(d_code_samples_per_chip),
+                static_cast<float>(d_code_phase_rate_step_chips) * static_cast<float>(d_code_samples_per_chip),
+                d_trk_parameters.vector_length);
+            return;
+        }
+    const auto *in = static_cast<const gr_complex *>(input_samples);
+#if CUDA_GPU_ACCEL
+    if (d_cuda_correlator)
+        {
+            d_multicorrelator_cuda.set_input_output_vectors(d_correlator_outs.data(), in);
+            if (d_trk_parameters.track_pilot)
+                {
+                    d_multicorrelator_cuda.set_data_output_vector(d_Prompt_Data.data());
+                }
+            d_multicorrelator_cuda.Carrier_wipeoff_multicorrelator_resampler(
+                d_rem_carr_phase_rad,
+                static_cast<float>(d_carrier_phase_step_rad), static_cast<float>(d_carrier_phase_rate_step_rad),
+                static_cast<float>(d_rem_code_phase_chips) * static_cast<float>(d_code_samples_per_chip),
+                static_cast<float>(d_code_phase_step_chips) * static_cast<float>(d_code_samples_per_chip),
+                static_cast<float>(d_code_phase_rate_step_chips) * static_cast<float>(d_code_samples_per_chip),
+                d_trk_parameters.vector_length);
+            return;
+        }
+#endif
+    d_multicorrelator_cpu.set_input_output_vectors(d_correlator_outs.data(), in);
+    if (d_trk_parameters.track_pilot)
+        {
+            d_multicorrelator_cpu.set_data_output_vector(d_Prompt_Data.data());
+        }
+    // signal quality monitoring correlators, every sqm_decimation integrations once the tracking is synchronized
+    bool sqm = false;
+    if (!d_sqm_outs.empty() and d_state > 2 and ++d_sqm_count >= static_cast<int32_t>(d_trk_parameters.sqm_decimation))
+        {
+            d_sqm_count = 0;
+            d_multicorrelator_cpu.request_sqm();
+            sqm = true;
+        }
+    if (d_tracking_bank != nullptr and !sqm)
+        {
+            // the correlator bank computes the correlations of this channel together with those of the other channels
+            const Tracking_Bank::Correlation correlation{&d_multicorrelator_cpu, in,
+                d_rem_carr_phase_rad,
+                static_cast<float>(d_carrier_phase_step_rad), static_cast<float>(d_carrier_phase_rate_step_rad),
+                static_cast<float>(d_rem_code_phase_chips) * static_cast<float>(d_code_samples_per_chip),
+                static_cast<float>(d_code_phase_step_chips) * static_cast<float>(d_code_samples_per_chip),
+                static_cast<float>(d_code_phase_rate_step_chips) * static_cast<float>(d_code_samples_per_chip),
+                static_cast<int>(d_trk_parameters.vector_length)};
+            d_tracking_bank->correlate(&correlation, 1);
+            return;
+        }
     d_multicorrelator_cpu.Carrier_wipeoff_multicorrelator_resampler(
         d_rem_carr_phase_rad,
         static_cast<float>(d_carrier_phase_step_rad), static_cast<float>(d_carrier_phase_rate_step_rad),
@@ -1032,23 +1374,15 @@ void dll_pll_veml_tracking::do_correlation_step(const gr_complex *input_samples)
         static_cast<float>(d_code_phase_step_chips) * static_cast<float>(d_code_samples_per_chip),
         static_cast<float>(d_code_phase_rate_step_chips) * static_cast<float>(d_code_samples_per_chip),
         d_trk_parameters.vector_length);
-
-    // DATA CORRELATOR (if tracking tracks the pilot signal)
-    if (d_trk_parameters.track_pilot)
+    if (d_multicorrelator_cpu.take_sqm())
         {
-            d_correlator_data_cpu.set_input_output_vectors(d_Prompt_Data.data(), input_samples);
-            d_correlator_data_cpu.Carrier_wipeoff_multicorrelator_resampler(
-                d_rem_carr_phase_rad,
-                static_cast<float>(d_carrier_phase_step_rad), static_cast<float>(d_carrier_phase_rate_step_rad),
-                static_cast<float>(d_rem_code_phase_chips) * static_cast<float>(d_code_samples_per_chip),
-                static_cast<float>(d_code_phase_step_chips) * static_cast<float>(d_code_samples_per_chip),
-                static_cast<float>(d_code_phase_rate_step_chips) * static_cast<float>(d_code_samples_per_chip),
-                d_trk_parameters.vector_length);
+            sqm_metrics(d_sqm_outs.data(), static_cast<int>(d_sqm_outs.size() / 2), d_sqm_delta, d_sqm_ratio, d_sqm_asymmetry);
         }
 }
 
 
-void dll_pll_veml_tracking::run_dll_pll()
+template <bool veml>
+void dll_pll_veml_tracking::run_dll_pll_kernel()
 {
     // ################## PLL ##########################################################
     // PLL discriminator
@@ -1097,7 +1431,7 @@ void dll_pll_veml_tracking::run_dll_pll()
 
     // ################## DLL ##########################################################
     // DLL discriminator
-    if (d_veml)
+    if (veml)
         {
             d_code_error_chips = dll_nc_vemlp_normalized(d_VE_accu, d_E_accu, d_L_accu, d_VL_accu);  // [chips/Ti]
         }
@@ -1164,11 +1498,15 @@ void dll_pll_veml_tracking::clear_tracking_vars()
     d_code_error_filt_chips = 0.0;
     d_current_symbol = 0;
     d_current_data_symbol = 0;
-    d_Prompt_circular_buffer.clear();
+    d_secondary_correlator.clear();
     d_carrier_phase_rate_step_rad = 0.0;
     d_code_phase_rate_step_chips = 0.0;
     d_carr_ph_history.clear();
     d_code_ph_history.clear();
+    d_sqm_count = 0;
+    d_sqm_delta = 0.0;
+    d_sqm_ratio = 0.0;
+    d_sqm_asymmetry = 0.0;
 }
 
 
@@ -1246,13 +1584,14 @@ void dll_pll_veml_tracking::update_tracking_vars()
 }
 
 
-void dll_pll_veml_tracking::save_correlation_results()
+template <bool veml, bool secondary, bool pilot>
+void dll_pll_veml_tracking::save_correlation_results_kernel()
 {
-    if (d_secondary)
+    if (secondary)
         {
             if (d_secondary_code_string[d_current_symbol] == '0')
                 {
-                    if (d_veml)
+                    if (veml)
                         {
                             d_VE_accu += *d_Very_Early;
                             d_VL_accu += *d_Very_Late;
@@ -1263,7 +1602,7 @@ void dll_pll_veml_tracking::save_correlation_results()
                 }
             else
                 {
-                    if (d_veml)
+                    if (veml)
                         {
                             d_VE_accu -= *d_Very_Early;
                             d_VL_accu -= *d_Very_Late;
@@ -1278,7 +1617,7 @@ void dll_pll_veml_tracking::save_correlation_results()
         }
     else
         {
-            if (d_veml)
+            if (veml)
                 {
                     d_VE_accu += *d_Very_Early;
                     d_VL_accu += *d_Very_Late;
@@ -1293,7 +1632,7 @@ void dll_pll_veml_tracking::save_correlation_results()
         {
             if (d_data_secondary_code_length > 0)
                 {
-                    if (d_trk_parameters.track_pilot)
+                    if (pilot)
                         {
                             if (d_data_secondary_code_string[d_current_data_symbol] == '0')
                                 {
@@ -1322,7 +1661,7 @@ void dll_pll_veml_tracking::save_correlation_results()
                 }
             else
                 {
-                    if (d_trk_parameters.track_pilot)
+                    if (pilot)
                         {
                             d_P_data_accu += d_Prompt_Data[0];
                         }
@@ -1337,7 +1676,7 @@ void dll_pll_veml_tracking::save_correlation_results()
         }
     else
         {
-            if (d_trk_parameters.track_pilot)
+            if (pilot)
                 {
                     d_P_data_accu = d_Prompt_Data[0];
                 }
@@ -1347,14 +1686,38 @@ void dll_pll_veml_tracking::save_correlation_results()
                 }
         }
 
-    if (d_trk_parameters.track_pilot)
+    // If tracking pilot, disable Costas loop
+    d_cloop = !pilot;
+}
+
+
+template <bool veml>
+dll_pll_veml_tracking::Tracking_Kernel dll_pll_veml_tracking::save_correlation_results_kernel(bool secondary, bool pilot)
+{
+    if (secondary)
         {
-            // If tracking pilot, disable Costas loop
-            d_cloop = false;
+            return pilot ? &dll_pll_veml_tracking::save_correlation_results_kernel<veml, true, true> : &dll_pll_veml_tracking::save_correlation_results_kernel<veml, true, false>;
+        }
+    return pilot ? &dll_pll_veml_tracking::save_correlation_results_kernel<veml, false, true> : &dll_pll_veml_tracking::save_correlation_results_kernel<veml, false, false>;
+}
+
+
+void dll_pll_veml_tracking::select_tracking_kernels()
+{
+    // GPS L1 C/A, L2C and GLONASS: EPL, no secondary code, no pilot
+    // Galileo E1: VEML, with the pilot and its secondary code if track_pilot
+    // GPS L5, Galileo E5a and E5b: EPL, secondary code, and the pilot if track_pilot
+    // Galileo E6: EPL, with the pilot and its secondary code if track_pilot
+    // BeiDou B1I and B3I: EPL, NH code of the MEO/IGSO satellites on the data component
+    if (d_veml)
+        {
+            d_run_dll_pll = &dll_pll_veml_tracking::run_dll_pll_kernel<true>;
+            d_save_correlation_results = save_correlation_results_kernel<true>(d_secondary, d_trk_parameters.track_pilot);
         }
     else
         {
-            d_cloop = true;
+            d_run_dll_pll = &dll_pll_veml_tracking::run_dll_pll_kernel<false>;
+            d_save_correlation_results = save_correlation_results_kernel<false>(d_secondary, d_trk_parameters.track_pilot);
         }
 }
 
@@ -1401,54 +1764,54 @@ void dll_pll_veml_tracking::log_data()
             try
                 {
                     // Dump correlators output
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_VE), sizeof(float));
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_E), sizeof(float));
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_P), sizeof(float));
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_L), sizeof(float));
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_VL), sizeof(float));
+                    d_dump_file.write(tmp_VE);
+                    d_dump_file.write(tmp_E);
+                    d_dump_file.write(tmp_P);
+                    d_dump_file.write(tmp_L);
+                    d_dump_file.write(tmp_VL);
                     // PROMPT I and Q (to analyze navigation symbols)
-                    d_dump_file.write(reinterpret_cast<char *>(&prompt_I), sizeof(float));
-                    d_dump_file.write(reinterpret_cast<char *>(&prompt_Q), sizeof(float));
+                    d_dump_file.write(prompt_I);
+                    d_dump_file.write(prompt_Q);
                     // PRN start sample stamp
                     tmp_long_int = this->nitems_read(0) + static_cast<uint64_t>(d_current_prn_length_samples);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_long_int), sizeof(uint64_t));
+                    d_dump_file.write(tmp_long_int);
                     // accumulated carrier phase
                     tmp_float = static_cast<float>(d_acc_carrier_phase_rad);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
+                    d_dump_file.write(tmp_float);
                     // carrier and code frequency
                     tmp_float = static_cast<float>(d_carrier_doppler_hz);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
+                    d_dump_file.write(tmp_float);
                     // carrier phase rate [Hz/s]
                     tmp_float = static_cast<float>(d_carrier_phase_rate_step_rad * d_trk_parameters.fs_in * d_trk_parameters.fs_in / TWO_PI);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
+                    d_dump_file.write(tmp_float);
                     tmp_float = static_cast<float>(d_code_freq_chips);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
+                    d_dump_file.write(tmp_float);
                     // code phase rate [chips/s^2]
                     tmp_float = static_cast<float>(d_code_phase_rate_step_chips * d_trk_parameters.fs_in * d_trk_parameters.fs_in);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
+                    d_dump_file.write(tmp_float);
                     // PLL commands
                     tmp_float = static_cast<float>(d_carr_phase_error_hz);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
+                    d_dump_file.write(tmp_float);
                     tmp_float = static_cast<float>(d_carr_error_filt_hz);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
+                    d_dump_file.write(tmp_float);
                     // DLL commands
                     tmp_float = static_cast<float>(d_code_error_chips);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
+                    d_dump_file.write(tmp_float);
                     tmp_float = static_cast<float>(d_code_error_filt_chips);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
+                    d_dump_file.write(tmp_float);
                     // CN0 and carrier lock test
                     tmp_float = static_cast<float>(d_CN0_SNV_dB_Hz);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
+                    d_dump_file.write(tmp_float);
                     tmp_float = static_cast<float>(d_carrier_lock_test);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
+                    d_dump_file.write(tmp_float);
                     // AUX vars (for debug purposes)
                     tmp_float = static_cast<float>(d_rem_code_phase_samples);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
+                    d_dump_file.write(tmp_float);
                     tmp_double = static_cast<double>(this->nitems_read(0) + d_current_prn_length_samples);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
+                    d_dump_file.write(tmp_double);
                     // PRN
                     uint32_t prn_ = d_acquisition_gnss_synchro->PRN;
-                    d_dump_file.write(reinterpret_cast<char *>(&prn_), sizeof(uint32_t));
+                    d_dump_file.write(prn_);
                 }
             catch (const std::ifstream::failure &e)
                 {
@@ -1461,40 +1824,28 @@ void dll_pll_veml_tracking::log_data()
 int32_t dll_pll_veml_tracking::save_matfile() const
 {
     // READ DUMP FILE
-    std::ifstream::pos_type size;
     const int32_t number_of_double_vars = 1;
     const int32_t number_of_float_vars = 19;
     const int32_t epoch_size_bytes = sizeof(uint64_t) + sizeof(double) * number_of_double_vars +
                                      sizeof(float) * number_of_float_vars + sizeof(uint32_t);
-    std::ifstream dump_file;
+    Gnss_Dump_Reader dump_file;
     std::string dump_filename_ = d_dump_filename;
     // add channel number to the filename
     dump_filename_.append(std::to_string(d_channel));
     // add extension
     dump_filename_.append(".dat");
     std::cout << "Generating .mat file for " << dump_filename_ << '\n';
-    dump_file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
     try
         {
-            dump_file.open(dump_filename_.c_str(), std::ios::binary | std::ios::ate);
+            dump_file.open(dump_filename_, epoch_size_bytes);
         }
     catch (const std::ifstream::failure &e)
         {
             std::cerr << "Problem opening dump file:" << e.what() << '\n';
             return 1;
         }
-    // count number of epochs and rewind
-    int64_t num_epoch = 0;
-    if (dump_file.is_open())
-        {
-            size = dump_file.tellg();
-            num_epoch = static_cast<int64_t>(size) / static_cast<int64_t>(epoch_size_bytes);
-            dump_file.seekg(0, std::ios::beg);
-        }
-    else
-        {
-            return 1;
-        }
+    // count number of epochs
+    const auto num_epoch = static_cast<int64_t>(dump_file.records());
     auto abs_VE = std::vector<float>(num_epoch);
     auto abs_E = std::vector<float>(num_epoch);
     auto abs_P = std::vector<float>(num_epoch);
@@ -1519,32 +1870,41 @@ int32_t dll_pll_veml_tracking::save_matfile() const
     auto PRN = std::vector<uint32_t>(num_epoch);
     try
         {
-            if (dump_file.is_open())
+            // the file is read a block of epochs at a time, since it may be compressed
+            std::vector<char> records(static_cast<size_t>(DUMP_READ_BLOCK_EPOCHS) * epoch_size_bytes);
+            int64_t i = 0;
+            size_t n_records = 0;
+            while (i < num_epoch and (n_records = dump_file.read(records.data(), DUMP_READ_BLOCK_EPOCHS)) > 0)
                 {
-                    for (int64_t i = 0; i < num_epoch; i++)
+                    for (size_t k = 0; k < n_records and i < num_epoch; k++, i++)
                         {
-                            dump_file.read(reinterpret_cast<char *>(&abs_VE[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&abs_E[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&abs_P[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&abs_L[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&abs_VL[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&Prompt_I[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&Prompt_Q[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&PRN_start_sample_count[i]), sizeof(uint64_t));
-                            dump_file.read(reinterpret_cast<char *>(&acc_carrier_phase_rad[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&carrier_doppler_hz[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&carrier_doppler_rate_hz[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&code_freq_chips[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&code_freq_rate_chips[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&carr_error_hz[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&carr_error_filt_hz[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&code_error_chips[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&code_error_filt_chips[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&CN0_SNV_dB_Hz[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&carrier_lock_test[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&aux1[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&aux2[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&PRN[i]), sizeof(uint32_t));
+                            const char *record = records.data() + k * epoch_size_bytes;
+                            const auto read_field = [&record](void *field, size_t field_size) {
+                                std::memcpy(field, record, field_size);
+                                record += field_size;
+                            };
+                            read_field(&abs_VE[i], sizeof(float));
+                            read_field(&abs_E[i], sizeof(float));
+                            read_field(&abs_P[i], sizeof(float));
+                            read_field(&abs_L[i], sizeof(float));
+                            read_field(&abs_VL[i], sizeof(float));
+                            read_field(&Prompt_I[i], sizeof(float));
+                            read_field(&Prompt_Q[i], sizeof(float));
+                            read_field(&PRN_start_sample_count[i], sizeof(uint64_t));
+                            read_field(&acc_carrier_phase_rad[i], sizeof(float));
+                            read_field(&carrier_doppler_hz[i], sizeof(float));
+                            read_field(&carrier_doppler_rate_hz[i], sizeof(float));
+                            read_field(&code_freq_chips[i], sizeof(float));
+                            read_field(&code_freq_rate_chips[i], sizeof(float));
+                            read_field(&carr_error_hz[i], sizeof(float));
+                            read_field(&carr_error_filt_hz[i], sizeof(float));
+                            read_field(&code_error_chips[i], sizeof(float));
+                            read_field(&code_error_filt_chips[i], sizeof(float));
+                            read_field(&CN0_SNV_dB_Hz[i], sizeof(float));
+                            read_field(&carrier_lock_test[i], sizeof(float));
+                            read_field(&aux1[i], sizeof(float));
+                            read_field(&aux2[i], sizeof(double));
+                            read_field(&PRN[i], sizeof(uint32_t));
                         }
                 }
             dump_file.close();
@@ -1663,6 +2023,16 @@ void dll_pll_veml_tracking::set_channel(uint32_t channel)
     gr::thread::scoped_lock l(d_setlock);
     d_channel = channel;
     LOG(INFO) << "Tracking Channel set to " << d_channel;
+    if (d_trk_parameters.tracking_bank)
+        {
+            if (d_tracking_bank_member)
+                {
+                    d_tracking_bank->leave();
+                    d_tracking_bank_member = false;
+                }
+            d_tracking_bank = Tracking_Bank::get(d_channel / d_trk_parameters.tracking_bank_channels, d_trk_parameters.tracking_bank_max_wait_us);
+            LOG(INFO) << "Channel " << d_channel << " uses the tracking correlator bank " << d_channel / d_trk_parameters.tracking_bank_channels;
+        }
     // ############# ENABLE DATA FILE LOG #################
     if (d_dump)
         {
@@ -1676,8 +2046,11 @@ void dll_pll_veml_tracking::set_channel(uint32_t channel)
                 {
                     try
                         {
-                            d_dump_file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-                            d_dump_file.open(dump_filename_.c_str(), std::ios::out | std::ios::binary);
+                            if (d_trk_parameters.dump_compressed)
+                                {
+                                    d_dump_file.set_record_layout(TRACKING_DUMP_RECORD_LAYOUT);
+                                }
+                            d_dump_file.open(dump_filename_);
                             LOG(INFO) << "Tracking dump enabled on channel " << d_channel << " Log file: " << dump_filename_.c_str();
                         }
                     catch (const std::ifstream::failure &e)
@@ -1711,16 +2084,47 @@ int64_t dll_pll_veml_tracking::uint64diff(uint64_t first, uint64_t second)
 }
 
 
-int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)), gr_vector_int &ninput_items,
+int dll_pll_veml_tracking::general_work(int noutput_items, gr_vector_int &ninput_items,
     gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
 {
+    const Gnss_Trace_Work<gr::block> trace("tracking", static_cast<int32_t>(d_channel), this, ninput_items[0], noutput_items);
+    // taken before the lock, so that the messages to the channel are not
+    // delayed while it waits for a worker
+    const Tracking_Worker_Pool::Slot worker_slot(d_worker_pool.get());
     gr::thread::scoped_lock l(d_setlock);
-    const auto *in = reinterpret_cast<const gr_complex *>(input_items[0]);
+    const void *in = input_items[0];  // gr_complex or, with the integer correlators, lv_8sc_t or lv_16sc_t samples
     auto **out = reinterpret_cast<Gnss_Synchro **>(&output_items[0]);
     Gnss_Synchro current_synchro_data = Gnss_Synchro();
     current_synchro_data.Flag_valid_symbol_output = false;
     bool loss_of_lock = false;
 
+    // only the channels that are tracking a signal are waited for by the correlator bank
+    if (d_tracking_bank != nullptr and (d_state > 1) != d_tracking_bank_member)
+        {
+            d_tracking_bank_member = d_state > 1;
+            if (d_tracking_bank_member)
+                {
+                    d_tracking_bank->join();
+                }
+            else
+                {
+                    d_tracking_bank->leave();
+                }
+        }
+#if CUDA_GPU_ACCEL
+    if (d_cuda_correlator)
+        {
+            if (d_state > 1)
+                {
+                    d_multicorrelator_cuda.join_bank();
+                }
+            else
+                {
+                    d_multicorrelator_cuda.leave_bank();
+                }
+        }
+#endif
+
     if (d_pull_in_transitory == true)
         {
             // if (d_trk_parameters.pull_in_time_s < (d_sample_counter - d_acq_sample_stamp) / static_cast<int>(d_trk_parameters.fs_in))
@@ -1736,6 +2140,14 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
         case 0:  // Standby - Consume samples at full throttle, do nothing
             {
                 // d_sample_counter += static_cast<uint64_t>(ninput_items[0]);
+                // The samples are skipped in bulk, start_tracking() realigns
+                // with nitems_read(0) whatever the number of skipped samples.
+                // A quarter of the buffer keeps the upstream writer from
+                // being throttled by the parked readers.
+                if (d_park_items == 0 and d_trk_parameters.park_idle_channels and this->detail())
+                    {
+                        d_park_items = static_cast<int32_t>(this->detail()->input(0)->max_possible_items_available() / 4);
+                    }
                 consume_each(ninput_items[0]);
                 return 0;
                 break;
@@ -1754,8 +2166,12 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                 const double T_chip_mod_seconds = 1.0 / d_code_freq_chips;
                 const double T_prn_mod_seconds = T_chip_mod_seconds * static_cast<double>(d_code_length_chips);
                 const double T_prn_mod_samples = T_prn_mod_seconds * d_trk_parameters.fs_in;
+                // The code epochs are extrapolated with the code Doppler, which
+                // matters when the code phase was predicted long ago (e.g. in a
+                // handover from the tracking of another signal)
+                const double T_prn_doppler_samples = (d_signal_carrier_freq > 0.0 ? T_prn_mod_samples / (1.0 + d_carrier_doppler_hz / d_signal_carrier_freq) : T_prn_mod_samples);
 
-                d_acq_code_phase_samples = T_prn_mod_samples - std::fmod(delta_trk_to_acq_prn_start_samples, T_prn_mod_samples);
+                d_acq_code_phase_samples = T_prn_doppler_samples - std::fmod(delta_trk_to_acq_prn_start_samples, T_prn_doppler_samples);
                 d_current_prn_length_samples = round(T_prn_mod_samples);
 
                 const int32_t samples_offset = round(d_acq_code_phase_samples);
@@ -1769,6 +2185,8 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                 DLOG(INFO) << "PULL-IN Doppler [Hz] = " << d_carrier_doppler_hz
                            << ". PULL-IN Code Phase [samples] = " << d_acq_code_phase_samples;
 
+                // the pull-in and synchronization time limits count from here
+                d_acq_sample_stamp = this->nitems_read(0);
                 consume_each(samples_offset);  // shift input to perform alignment with local replica
                 return 0;
             }
@@ -1822,8 +2240,8 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                                 if (d_secondary)
                                     {
                                         // ####### SECONDARY CODE LOCK #####
-                                        d_Prompt_circular_buffer.push_back(*d_Prompt);
-                                        if (d_Prompt_circular_buffer.size() == d_secondary_code_length)
+                                        d_secondary_correlator.push(d_Prompt->real());
+                                        if (d_secondary_correlator.size() == d_secondary_code_length)
                                             {
                                                 next_state = acquire_secondary();
                                                 if (next_state)
@@ -1838,8 +2256,8 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                                 else if (d_symbols_per_bit > 1)  // Signal does not have secondary code. Search a bit transition by sign change
                                     {
                                         // ******* preamble correlation ********
-                                        d_Prompt_circular_buffer.push_back(*d_Prompt);
-                                        if (d_Prompt_circular_buffer.size() == d_secondary_code_length)
+                                        d_secondary_correlator.push(d_Prompt->real());
+                                        if (d_secondary_correlator.size() == d_secondary_code_length)
                                             {
                                                 next_state = acquire_secondary();
                                                 if (next_state)
@@ -1868,48 +2286,20 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                                 d_P_data_accu = gr_complex(0.0, 0.0);
                                 d_L_accu = gr_complex(0.0, 0.0);
                                 d_VL_accu = gr_complex(0.0, 0.0);
-                                d_Prompt_circular_buffer.clear();
+                                d_secondary_correlator.clear();
                                 d_current_symbol = 0;
                                 d_current_data_symbol = 0;
 
-                                if (d_enable_extended_integration)
+                                d_adaptive_lock_count = 0;
+                                d_adaptive_period_count = 0;
+                                if (d_enable_extended_integration and !d_trk_parameters.adaptive_integration)
                                     {
-                                        // UPDATE INTEGRATION TIME
-                                        d_extend_correlation_symbols_count = 0;
-                                        d_current_correlation_time_s = static_cast<float>(d_trk_parameters.extend_correlation_symbols) * static_cast<float>(d_code_period);
+                                        set_extended_integration(true);
                                         d_state = 3;  // next state is the extended correlator integrator
-                                        LOG(INFO) << "Enabled " << d_trk_parameters.extend_correlation_symbols * static_cast<int32_t>(d_code_period * 1000.0) << " ms extended correlator in channel "
-                                                  << d_channel
-                                                  << " for satellite " << Gnss_Satellite(d_systemName, d_acquisition_gnss_synchro->PRN);
-                                        std::cout << "Enabled " << d_trk_parameters.extend_correlation_symbols * static_cast<int32_t>(d_code_period * 1000.0) << " ms extended correlator in channel "
-                                                  << d_channel
-                                                  << " for satellite " << Gnss_Satellite(d_systemName, d_acquisition_gnss_synchro->PRN) << '\n';
-                                        // Set narrow taps delay values [chips]
-                                        d_code_loop_filter.set_update_interval(static_cast<float>(d_current_correlation_time_s));
-                                        d_code_loop_filter.set_noise_bandwidth(d_trk_parameters.dll_bw_narrow_hz);
-                                        d_carrier_loop_filter.set_params(d_trk_parameters.fll_bw_hz, d_trk_parameters.pll_bw_narrow_hz, d_trk_parameters.pll_filter_order);
-                                        if (d_veml)
-                                            {
-                                                d_local_code_shift_chips[0] = -d_trk_parameters.very_early_late_space_narrow_chips * static_cast<float>(d_code_samples_per_chip);
-                                                d_local_code_shift_chips[1] = -d_trk_parameters.early_late_space_narrow_chips * static_cast<float>(d_code_samples_per_chip);
-                                                d_local_code_shift_chips[3] = d_trk_parameters.early_late_space_narrow_chips * static_cast<float>(d_code_samples_per_chip);
-                                                d_local_code_shift_chips[4] = d_trk_parameters.very_early_late_space_narrow_chips * static_cast<float>(d_code_samples_per_chip);
-                                                d_trk_parameters.spc = d_trk_parameters.early_late_space_narrow_chips;
-                                                // if (std::string(d_trk_parameters.signal) == "E1")
-                                                //    {
-                                                //        d_trk_parameters.slope = -CalculateSlopeAbs(&SinBocCorrelationFunction<1, 1>, d_trk_parameters.spc);
-                                                //        d_trk_parameters.y_intercept = GetYInterceptAbs(&SinBocCorrelationFunction<1, 1>, d_trk_parameters.spc);
-                                                //    }
-                                            }
-                                        else
-                                            {
-                                                d_local_code_shift_chips[0] = -d_trk_parameters.early_late_space_narrow_chips * static_cast<float>(d_code_samples_per_chip);
-                                                d_local_code_shift_chips[2] = d_trk_parameters.early_late_space_narrow_chips * static_cast<float>(d_code_samples_per_chip);
-                                                d_trk_parameters.spc = d_trk_parameters.early_late_space_narrow_chips;
-                                            }
                                     }
                                 else
                                     {
+                                        // with adaptive integration, the extended correlator is enabled once the lock is stable
                                         d_state = 4;
                                     }
                             }
@@ -1943,6 +2333,9 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                         current_synchro_data.Carrier_Doppler_hz = d_carrier_doppler_hz;
                         current_synchro_data.CN0_dB_hz = d_CN0_SNV_dB_Hz;
                         current_synchro_data.correlation_length_ms = d_correlation_length_ms;
+                        current_synchro_data.SQM_delta = static_cast<float>(d_sqm_delta);
+                        current_synchro_data.SQM_ratio = static_cast<float>(d_sqm_ratio);
+                        current_synchro_data.SQM_asymmetry = static_cast<float>(d_sqm_asymmetry);
                         current_synchro_data.Flag_valid_symbol_output = true;
                         d_P_data_accu = gr_complex(0.0, 0.0);
                     }
@@ -1961,7 +2354,7 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                 save_correlation_results();
 
                 // check lock status
-                if (!cn0_and_tracking_lock_status(d_code_period * static_cast<double>(d_trk_parameters.extend_correlation_symbols)))
+                if (!cn0_and_tracking_lock_status(d_code_period * static_cast<double>(d_extended_integration ? d_trk_parameters.extend_correlation_symbols : 1)))
                     {
                         clear_tracking_vars();
                         d_state = 0;                                         // loss-of-lock detected
@@ -1995,6 +2388,9 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                                 current_synchro_data.Carrier_Doppler_hz = d_carrier_doppler_hz;
                                 current_synchro_data.CN0_dB_hz = d_CN0_SNV_dB_Hz;
                                 current_synchro_data.correlation_length_ms = d_correlation_length_ms;
+                                current_synchro_data.SQM_delta = static_cast<float>(d_sqm_delta);
+                                current_synchro_data.SQM_ratio = static_cast<float>(d_sqm_ratio);
+                                current_synchro_data.SQM_asymmetry = static_cast<float>(d_sqm_asymmetry);
                                 current_synchro_data.Flag_valid_symbol_output = true;
                                 d_P_data_accu = gr_complex(0.0, 0.0);
                             }
@@ -2005,7 +2401,11 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                         d_P_accu = gr_complex(0.0, 0.0);
                         d_L_accu = gr_complex(0.0, 0.0);
                         d_VL_accu = gr_complex(0.0, 0.0);
-                        if (d_enable_extended_integration)
+                        if (d_trk_parameters.adaptive_integration)
+                            {
+                                update_adaptive_integration();
+                            }
+                        if (d_extended_integration)
                             {
                                 d_state = 3;  // new coherent integration (correlation time extension) cycle
                             }
@@ -2014,9 +2414,9 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
         }
 
     // time tags
-    std::vector<gr::tag_t> tags_vec;
-    this->get_tags_in_range(tags_vec, 0, this->nitems_read(0), this->nitems_read(0) + d_current_prn_length_samples);
-    for (const auto &it : tags_vec)
+    d_tags_vec.clear();
+    this->get_tags_in_range(d_tags_vec, 0, this->nitems_read(0), this->nitems_read(0) + d_current_prn_length_samples, d_timetag_key);
+    for (const auto &it : d_tags_vec)
         {
             try
                 {
@@ -2063,12 +2463,16 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                     double intpart;
                     d_last_timetag.tow_ms_fraction = d_last_timetag.tow_ms_fraction + modf(1000.0 * static_cast<double>(diff_samplecount) / d_trk_parameters.fs_in, &intpart);
 
-                    const std::shared_ptr<GnssTime> tmp_obj = std::make_shared<GnssTime>(GnssTime());
-                    tmp_obj->week = d_last_timetag.week;
-                    tmp_obj->tow_ms = d_last_timetag.tow_ms + static_cast<int>(intpart);
-                    tmp_obj->tow_ms_fraction = d_last_timetag.tow_ms_fraction;
-                    tmp_obj->rx_time = static_cast<double>(current_synchro_data.Tracking_sample_counter) / d_trk_parameters.fs_in;
-                    add_item_tag(0, this->nitems_written(0) + 1, pmt::mp("timetag"), pmt::make_any(tmp_obj));
+                    GnssTime timetag{};
+                    timetag.week = d_last_timetag.week;
+                    timetag.tow_ms = d_last_timetag.tow_ms + static_cast<int>(intpart);
+                    timetag.tow_ms_fraction = d_last_timetag.tow_ms_fraction;
+                    timetag.rx_time = static_cast<double>(current_synchro_data.Tracking_sample_counter) / d_trk_parameters.fs_in;
+                    if (d_timetag_channel == nullptr)
+                        {
+                            d_timetag_channel = gnss_time_tag_output_channel(this, 0);
+                        }
+                    d_timetag_channel->push(this->nitems_written(0) + 1, timetag);
 
                     // std::cout << "[" << this->nitems_written(0) + 1 << "][diff_time: " << 1000.0 * static_cast<double>(diff_samplecount) / d_trk_parameters.fs_in << "] Sent TimeTag Week: " << d_last_timetag.week << ", TOW: " << d_last_timetag.tow_ms << " [ms], TOW fraction: " << d_last_timetag.tow_ms_fraction << " [ms] \n";
                     d_timetag_waiting = false;
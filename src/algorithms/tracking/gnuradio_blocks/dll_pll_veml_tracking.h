@@ -18,13 +18,23 @@
 #ifndef GNSS_SDR_DLL_PLL_VEML_TRACKING_H
 #define GNSS_SDR_DLL_PLL_VEML_TRACKING_H
 
+#include "array_beam_steering.h"
+#include "cpu_multicorrelator_8ic.h"
+#include "cpu_multicorrelator_array.h"
 #include "cpu_multicorrelator_real_codes.h"
 #include "dll_pll_conf.h"
 #include "exponential_smoother.h"
 #include "gnss_block_interface.h"
+#include "gnss_dump_writer.h"         // for Gnss_Dump_Writer
+#include "gnss_replica_cache.h"       // for Gnss_Replica_Cache
+#include "gnss_sign_correlator.h"     // for Gnss_Sign_Correlator
 #include "gnss_time.h"                // for timetags produced by File_Timestamp_Signal_Source
+#include "gnss_time_tag_channel.h"    // for Gnss_Time_Tag_Channel
+#include "lock_detectors.h"           // for Cn0_M2M4_Estimator
 #include "tracking_FLL_PLL_filter.h"  // for PLL/FLL filter
+#include "tracking_bank.h"            // for Tracking_Bank
 #include "tracking_loop_filter.h"     // for DLL filter
+#include "tracking_worker_pool.h"     // for Tracking_Worker_Pool
 #include <boost/circular_buffer.hpp>
 #include <gnuradio/block.h>                   // for block
 #include <gnuradio/gr_complex.h>              // for gr_complex
@@ -34,10 +44,15 @@
 #include <cstddef>                            // for size_t
 #include <cstdint>                            // for int32_t
 #include <fstream>                            // for ofstream
+#include <memory>                             // for shared_ptr
 #include <string>                             // for string
 #include <typeinfo>                           // for typeid
 #include <utility>                            // for pair
 
+#if CUDA_GPU_ACCEL
+#include "cuda_multicorrelator_bank.h"
+#endif
+
 /** \addtogroup Tracking
  * \{ */
 /** \addtogroup Tracking_gnuradio_blocks tracking_gr_blocks
@@ -75,42 +90,75 @@ private:
     explicit dll_pll_veml_tracking(const Dll_Pll_Conf &conf_);
 
     void msg_handler_telemetry_to_trk(const pmt::pmt_t &msg);
-    void do_correlation_step(const gr_complex *input_samples);
-    void run_dll_pll();
+    void do_correlation_step(const void *input_samples);
+    void set_data_local_code_and_taps(int32_t code_length_chips, const float *local_code_in, float *shifts_chips);
+    void run_dll_pll() { (this->*d_run_dll_pll)(); }
     void check_carrier_phase_coherent_initialization();
     void update_tracking_vars();
     void clear_tracking_vars();
-    void save_correlation_results();
+    void save_correlation_results() { (this->*d_save_correlation_results)(); }
     void log_data();
     bool cn0_and_tracking_lock_status(double coh_integration_time_s);
+    void set_extended_integration(bool extended);
+    void update_adaptive_integration();
     bool acquire_secondary();
     int64_t uint64diff(uint64_t first, uint64_t second);
     int32_t save_matfile() const;
 
-    Cpu_Multicorrelator_Real_Codes d_multicorrelator_cpu;
-    Cpu_Multicorrelator_Real_Codes d_correlator_data_cpu;  // for data channel
+    /*
+     * Per-epoch steps of the loop, specialized for the correlator taps (VEML
+     * or EPL), the secondary code and the pilot of each signal family, so
+     * that these branches are resolved at compile time. The ones of the
+     * signal being tracked are selected by select_tracking_kernels().
+     */
+    using Tracking_Kernel = void (dll_pll_veml_tracking::*)();
+    template <bool veml>
+    void run_dll_pll_kernel();
+    template <bool veml, bool secondary, bool pilot>
+    void save_correlation_results_kernel();
+    template <bool veml>
+    static Tracking_Kernel save_correlation_results_kernel(bool secondary, bool pilot);
+    void select_tracking_kernels();
+
+    Cpu_Multicorrelator_Real_Codes d_multicorrelator_cpu;  // pilot (and data, if tracking the pilot) correlators
+    Cpu_Multicorrelator_8ic d_multicorrelator_8ic;         // integer correlators, for 8-bit and 16-bit complex samples
+    Cpu_Multicorrelator_Array d_multicorrelator_array;     // correlators of the elements of an antenna array
+#if CUDA_GPU_ACCEL
+    Cuda_Multicorrelator_Real_Codes d_multicorrelator_cuda;  // GPU correlators, computed for all the channels at once
+#endif
 
     Dll_Pll_Conf d_trk_parameters;
 
     Exponential_Smoother d_cn0_smoother;
     Exponential_Smoother d_carrier_lock_test_smoother;
+    Cn0_M2M4_Estimator d_cn0_estimator;
 
     Tracking_loop_filter d_code_loop_filter;
     Tracking_FLL_PLL_filter d_carrier_loop_filter;
 
+    std::shared_ptr<Tracking_Bank> d_tracking_bank;
+    std::shared_ptr<Tracking_Worker_Pool> d_worker_pool;  // null if each channel runs freely in its own thread
+    std::unique_ptr<Array_Beam_Steering> d_array_steering;  // null if the input samples are not the ones of an antenna array
+
     Gnss_Synchro *d_acquisition_gnss_synchro;
 
-    volk_gnsssdr::vector<float> d_tracking_code;
-    volk_gnsssdr::vector<float> d_data_code;
+    Gnss_Replica_Cache::Float_Replica d_tracking_code;  // shared with the other channels
+    Gnss_Replica_Cache::Float_Replica d_data_code;
     volk_gnsssdr::vector<float> d_local_code_shift_chips;
     volk_gnsssdr::vector<gr_complex> d_correlator_outs;
     volk_gnsssdr::vector<gr_complex> d_Prompt_Data;
-    volk_gnsssdr::vector<gr_complex> d_Prompt_buffer;
+    volk_gnsssdr::vector<gr_complex> d_element_correlator_outs;  // of each element of the antenna array
+    volk_gnsssdr::vector<gr_complex> d_element_Prompt_Data;
+    volk_gnsssdr::vector<gr_complex> d_sqm_outs;  // signal quality monitoring correlators, from the earliest to the latest
 
     boost::circular_buffer<float> d_dll_filt_history;
     boost::circular_buffer<std::pair<double, double>> d_code_ph_history;
     boost::circular_buffer<std::pair<double, double>> d_carr_ph_history;
-    boost::circular_buffer<gr_complex> d_Prompt_circular_buffer;
+    Gnss_Sign_Correlator d_secondary_correlator;  // signs of the last prompt symbols
+
+    std::vector<gr::tag_t> d_tags_vec;
+    pmt::pmt_t d_timetag_key;
+    std::shared_ptr<Gnss_Time_Tag_Channel> d_timetag_channel;  // time tags for the telemetry decoder
 
     const size_t int_type_hash_code = typeid(int).hash_code();
 
@@ -141,6 +189,9 @@ private:
     double d_code_phase_step_chips;
     double d_code_phase_rate_step_chips;
     double d_rem_code_phase_samples;
+    double d_sqm_delta;
+    double d_sqm_ratio;
+    double d_sqm_asymmetry;
 
     gr_complex *d_Very_Early;
     gr_complex *d_Early;
@@ -163,7 +214,10 @@ private:
     std::string d_signal_pretty_name;
     std::string d_dump_filename;
 
-    std::ofstream d_dump_file;
+    Gnss_Dump_Writer d_dump_file;
+
+    Tracking_Kernel d_run_dll_pll;
+    Tracking_Kernel d_save_correlation_results;
 
     // uint64_t d_sample_counter;
     uint64_t d_acq_sample_stamp;
@@ -180,6 +234,10 @@ private:
     int32_t d_n_correlator_taps;
     int32_t d_current_prn_length_samples;
     int32_t d_extend_correlation_symbols_count;
+    int32_t d_adaptive_lock_count;    // consecutive short integration periods with stable lock
+    int32_t d_adaptive_hold_count;    // periods of stable lock required to extend the integration
+    int32_t d_adaptive_period_count;  // short integration periods since the symbol boundary (modulo extend_correlation_symbols)
+    int32_t d_sqm_count;              // integrations since the last signal quality monitoring correlators
     int32_t d_current_symbol;
     int32_t d_current_data_symbol;
     int32_t d_cn0_estimation_counter;
@@ -187,6 +245,7 @@ private:
     int32_t d_code_lock_fail_counter;
     int32_t d_code_samples_per_chip;  // All signals have 1 sample per chip code except Gal. E1 which has 2 (CBOC disabled) or 12 (CBOC enabled)
     int32_t d_code_length_chips;
+    int32_t d_park_items;  // input items awaited by a standby channel, 0 until the input buffer is known
 
     uint32_t d_channel;
     uint32_t d_secondary_code_length;
@@ -202,7 +261,12 @@ private:
     bool d_dump_mat;
     bool d_acc_carrier_phase_initialized;
     bool d_enable_extended_integration;
+    bool d_extended_integration;  // extended integration currently in use
     bool d_Flag_PLL_180_deg_phase_locked;
+    bool d_tracking_bank_member;
+    bool d_integer_correlator;
+    bool d_integer_correlator_16ic;  // the integer correlators read 16-bit samples
+    bool d_cuda_correlator;
 };
 
 
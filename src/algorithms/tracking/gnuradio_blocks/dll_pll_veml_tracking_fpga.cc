@@ -393,7 +393,7 @@ dll_pll_veml_tracking_fpga::dll_pll_veml_tracking_fpga(const Dll_Pll_Conf_Fpga &
         }
 
     // --- Initializations ---
-    d_Prompt_circular_buffer.set_capacity(d_secondary_code_length);
+    d_secondary_correlator = Gnss_Sign_Correlator::from_string(d_secondary_code_string.substr(0, d_secondary_code_length));
 
     // Initial code frequency basis of NCO
     d_code_freq_chips = d_code_chip_rate;
@@ -556,32 +556,7 @@ dll_pll_veml_tracking_fpga::~dll_pll_veml_tracking_fpga()
 bool dll_pll_veml_tracking_fpga::acquire_secondary()
 {
     // ******* preamble correlation ********
-    int32_t corr_value = 0;
-    for (uint32_t i = 0; i < d_secondary_code_length; i++)
-        {
-            if (d_Prompt_circular_buffer[i].real() < 0.0)  // symbols clipping
-                {
-                    if (d_secondary_code_string[i] == '0')
-                        {
-                            corr_value++;
-                        }
-                    else
-                        {
-                            corr_value--;
-                        }
-                }
-            else
-                {
-                    if (d_secondary_code_string[i] == '0')
-                        {
-                            corr_value--;
-                        }
-                    else
-                        {
-                            corr_value++;
-                        }
-                }
-        }
+    const int32_t corr_value = d_secondary_correlator.correlation();
 
     if (abs(corr_value) == static_cast<int32_t>(d_secondary_code_length))
         {
@@ -796,7 +771,7 @@ void dll_pll_veml_tracking_fpga::clear_tracking_vars()
     d_code_error_filt_chips = 0.0;
     d_current_symbol = 0;
     d_current_data_symbol = 0;
-    d_Prompt_circular_buffer.clear();
+    d_secondary_correlator.clear();
     d_carrier_phase_rate_step_rad = 0.0;
     d_code_phase_rate_step_chips = 0.0;
     d_carr_ph_history.clear();
@@ -1456,7 +1431,7 @@ void dll_pll_veml_tracking_fpga::set_gnss_synchro(Gnss_Synchro *p_gnss_synchro)
 
             d_cloop = true;
 
-            d_Prompt_circular_buffer.clear();
+            d_secondary_correlator = Gnss_Sign_Correlator::from_string(d_secondary_code_string.substr(0, d_secondary_code_length));
 
             d_T_chip_seconds = 1.0 / d_code_freq_chips;
             d_T_prn_seconds = d_T_chip_seconds * static_cast<double>(d_code_length_chips);
@@ -1646,9 +1621,9 @@ int dll_pll_veml_tracking_fpga::general_work(int noutput_items __attribute__((un
                                         if (d_secondary)
                                             {
                                                 // ####### SECONDARY CODE LOCK #####
-                                                d_Prompt_circular_buffer.push_back(*d_Prompt);
+                                                d_secondary_correlator.push(d_Prompt->real());
 
-                                                if (d_Prompt_circular_buffer.size() == d_secondary_code_length)
+                                                if (d_secondary_correlator.size() == d_secondary_code_length)
                                                     {
                                                         next_state = acquire_secondary();
 
@@ -1664,8 +1639,8 @@ int dll_pll_veml_tracking_fpga::general_work(int noutput_items __attribute__((un
                                         else if (d_symbols_per_bit > 1)  // Signal does not have secondary code. Search a bit transition by sign change
                                             {
                                                 // ******* preamble correlation ********
-                                                d_Prompt_circular_buffer.push_back(*d_Prompt);
-                                                if (d_Prompt_circular_buffer.size() == d_secondary_code_length)
+                                                d_secondary_correlator.push(d_Prompt->real());
+                                                if (d_secondary_correlator.size() == d_secondary_code_length)
                                                     {
                                                         next_state = acquire_secondary();
                                                         if (next_state)
@@ -1695,7 +1670,7 @@ int dll_pll_veml_tracking_fpga::general_work(int noutput_items __attribute__((un
                                         d_P_data_accu = gr_complex(0.0, 0.0);
                                         d_L_accu = gr_complex(0.0, 0.0);
                                         d_VL_accu = gr_complex(0.0, 0.0);
-                                        d_Prompt_circular_buffer.clear();
+                                        d_secondary_correlator.clear();
                                         d_current_symbol = 0;
                                         d_current_data_symbol = 0;
 
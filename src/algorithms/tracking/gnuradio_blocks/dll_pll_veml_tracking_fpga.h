@@ -21,6 +21,7 @@
 #include "dll_pll_conf_fpga.h"
 #include "exponential_smoother.h"
 #include "gnss_block_interface.h"
+#include "gnss_sign_correlator.h"
 #include "tracking_FLL_PLL_filter.h"  // for PLL/FLL filter
 #include "tracking_loop_filter.h"     // for DLL filter
 #include <boost/circular_buffer.hpp>
@@ -134,7 +135,7 @@ private:
     boost::circular_buffer<float> d_dll_filt_history;
     boost::circular_buffer<std::pair<double, double>> d_code_ph_history;
     boost::circular_buffer<std::pair<double, double>> d_carr_ph_history;
-    boost::circular_buffer<gr_complex> d_Prompt_circular_buffer;
+    Gnss_Sign_Correlator d_secondary_correlator;  // signs of the last prompt symbols
 
     std::string d_systemName;
     std::string d_signal_type;
@@ -52,10 +52,12 @@ galileo_e1_tcp_connector_tracking_cc_sptr galileo_e1_tcp_connector_make_tracking
     float dll_bw_hz,
     float early_late_space_chips,
     float very_early_late_space_chips,
-    size_t port_ch0)
+    size_t port_ch0,
+    uint32_t loop_latency,
+    const std::string &shm_name)
 {
     return galileo_e1_tcp_connector_tracking_cc_sptr(new Galileo_E1_Tcp_Connector_Tracking_cc(
-        fs_in, vector_length, dump, dump_filename, pll_bw_hz, dll_bw_hz, early_late_space_chips, very_early_late_space_chips, port_ch0));
+        fs_in, vector_length, dump, dump_filename, pll_bw_hz, dll_bw_hz, early_late_space_chips, very_early_late_space_chips, port_ch0, loop_latency, shm_name));
 }
 
 
@@ -78,7 +80,9 @@ Galileo_E1_Tcp_Connector_Tracking_cc::Galileo_E1_Tcp_Connector_Tracking_cc(
     float dll_bw_hz __attribute__((unused)),
     float early_late_space_chips,
     float very_early_late_space_chips,
-    size_t port_ch0)
+    size_t port_ch0,
+    uint32_t loop_latency,
+    const std::string &shm_name)
     : gr::block("Galileo_E1_Tcp_Connector_Tracking_cc", gr::io_signature::make(1, 1, sizeof(gr_complex)),
           gr::io_signature::make(1, 1, sizeof(Gnss_Synchro))),
       d_vector_length(vector_length),
@@ -104,6 +108,8 @@ Galileo_E1_Tcp_Connector_Tracking_cc::Galileo_E1_Tcp_Connector_Tracking_cc(
       d_port(0),
       d_listen_connection(true),
       d_control_id(0),
+      d_shm_name(shm_name),
+      d_loop_latency(loop_latency),
       d_current_prn_length_samples(static_cast<int32_t>(d_vector_length)),
       d_next_prn_length_samples(0),
       d_sample_counter(0ULL),
@@ -184,6 +190,10 @@ void Galileo_E1_Tcp_Connector_Tracking_cc::start_tracking()
     std::cout << "Tracking of Galileo E1 signal started on channel " << d_channel << " for satellite " << Gnss_Satellite(systemName[sys], d_acquisition_gnss_synchro->PRN) << '\n';
     LOG(INFO) << "Tracking of Galileo E1 signal for satellite " << Gnss_Satellite(systemName[sys], d_acquisition_gnss_synchro->PRN) << " on channel " << d_channel;
 
+    // the command of the loop filter until its first reply
+    d_loop_command = Tcp_Packet_Data();
+    d_loop_command.proc_pack_carrier_doppler_hz = d_acq_carrier_doppler_hz;
+
     // enable tracking
     d_pull_in = true;
     d_enable_tracking = true;
@@ -207,7 +217,14 @@ Galileo_E1_Tcp_Connector_Tracking_cc::~Galileo_E1_Tcp_Connector_Tracking_cc()
         }
     try
         {
-            d_tcp_com.close_tcp_connection(d_port);
+            if (d_batch_com)
+                {
+                    d_batch_com->remove_channel(d_channel);
+                }
+            else
+                {
+                    d_tcp_com.close_tcp_connection(d_port);
+                }
             multicorrelator_cpu.free();
         }
     catch (const std::exception &ex)
@@ -230,8 +247,7 @@ void Galileo_E1_Tcp_Connector_Tracking_cc::set_channel(uint32_t channel)
                         {
                             d_dump_filename.append(std::to_string(d_channel));
                             d_dump_filename.append(".dat");
-                            d_dump_file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-                            d_dump_file.open(d_dump_filename.c_str(), std::ios::out | std::ios::binary);
+                            d_dump_file.open(d_dump_filename);
                             LOG(INFO) << "Tracking dump enabled on channel " << d_channel << " Log file: " << d_dump_filename.c_str();
                         }
                     catch (const std::ifstream::failure &e)
@@ -242,7 +258,13 @@ void Galileo_E1_Tcp_Connector_Tracking_cc::set_channel(uint32_t channel)
         }
 
     //! Listen for connections on a TCP port
-    if (d_listen_connection == true)
+    if (d_loop_latency > 0)
+        {
+            // all the channels share a pipelined connection on port_ch0
+            d_batch_com = Tcp_Batch_Communication::get_shared(d_port_ch0, d_shm_name);
+            d_batch_com->add_channel(d_channel, d_loop_latency);
+        }
+    else if (d_listen_connection == true)
         {
             d_port = d_port_ch0 + d_channel;
             d_listen_connection = d_tcp_com.listen_tcp_connection(d_port, d_port_ch0);
@@ -326,7 +348,15 @@ int Galileo_E1_Tcp_Connector_Tracking_cc::general_work(int noutput_items __attri
                 (*d_Prompt).imag(),
                 d_acq_carrier_doppler_hz,
                 1}};
-            d_tcp_com.send_receive_tcp_packet_galileo_e1(tx_variables_array, &tcp_data);
+            if (d_batch_com)
+                {
+                    d_batch_com->exchange(d_channel, TCP_BATCH_SIGNAL_GALILEO_E1, tx_variables_array.data(), tx_variables_array.size(), true, &d_loop_command);
+                    tcp_data = d_loop_command;
+                }
+            else
+                {
+                    d_tcp_com.send_receive_tcp_packet_galileo_e1(tx_variables_array, &tcp_data);
+                }
 
             // ################## PLL ##########################################################
             // PLL discriminator, carrier loop filter implementation and NCO command generation (TCP_connector)
@@ -425,7 +455,14 @@ int Galileo_E1_Tcp_Connector_Tracking_cc::general_work(int noutput_items __attri
             current_synchro_data.Tracking_sample_counter = d_sample_counter + static_cast<uint64_t>(d_current_prn_length_samples);
             // When tracking is disabled an array of 1's is sent to maintain the TCP connection
             boost::array<float, NUM_TX_VARIABLES_GALILEO_E1> tx_variables_array = {{1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0}};
-            d_tcp_com.send_receive_tcp_packet_galileo_e1(tx_variables_array, &tcp_data);
+            if (d_batch_com)
+                {
+                    d_batch_com->exchange(d_channel, TCP_BATCH_SIGNAL_GALILEO_E1, tx_variables_array.data(), tx_variables_array.size(), false, &tcp_data);
+                }
+            else
+                {
+                    d_tcp_com.send_receive_tcp_packet_galileo_e1(tx_variables_array, &tcp_data);
+                }
         }
     // assign the GNU Radio block output data
     current_synchro_data.System = {'E'};
@@ -455,47 +492,47 @@ int Galileo_E1_Tcp_Connector_Tracking_cc::general_work(int noutput_items __attri
             try
                 {
                     // Dump correlators output
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_VE), sizeof(float));
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_E), sizeof(float));
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_P), sizeof(float));
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_L), sizeof(float));
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_VL), sizeof(float));
+                    d_dump_file.write(tmp_VE);
+                    d_dump_file.write(tmp_E);
+                    d_dump_file.write(tmp_P);
+                    d_dump_file.write(tmp_L);
+                    d_dump_file.write(tmp_VL);
                     // PROMPT I and Q (to analyze navigation symbols)
-                    d_dump_file.write(reinterpret_cast<char *>(&prompt_I), sizeof(float));
-                    d_dump_file.write(reinterpret_cast<char *>(&prompt_Q), sizeof(float));
+                    d_dump_file.write(prompt_I);
+                    d_dump_file.write(prompt_Q);
                     // PRN start sample stamp
-                    d_dump_file.write(reinterpret_cast<char *>(&d_sample_counter), sizeof(uint64_t));
+                    d_dump_file.write(d_sample_counter);
                     // accumulated carrier phase
                     tmp_float = static_cast<float>(d_acc_carrier_phase_rad);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
+                    d_dump_file.write(tmp_float);
                     // carrier and code frequency
                     tmp_float = static_cast<float>(d_carrier_doppler_hz);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
+                    d_dump_file.write(tmp_float);
                     tmp_float = static_cast<float>(d_code_freq_chips);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
+                    d_dump_file.write(tmp_float);
                     // PLL commands
                     tmp_float = 0.0;
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
+                    d_dump_file.write(tmp_float);
                     tmp_float = static_cast<float>(carr_error_filt_hz);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
+                    d_dump_file.write(tmp_float);
                     // DLL commands
                     tmp_float = 0.0;
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
+                    d_dump_file.write(tmp_float);
                     tmp_float = static_cast<float>(code_error_filt_chips);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
+                    d_dump_file.write(tmp_float);
                     // CN0 and carrier lock test
                     tmp_float = static_cast<float>(d_CN0_SNV_dB_Hz);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
+                    d_dump_file.write(tmp_float);
                     tmp_float = static_cast<float>(d_carrier_lock_test);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
+                    d_dump_file.write(tmp_float);
                     // AUX vars (for debug purposes)
                     tmp_float = 0.0;
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
+                    d_dump_file.write(tmp_float);
                     auto tmp_double = static_cast<double>(d_sample_counter + d_correlation_length_samples);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
+                    d_dump_file.write(tmp_double);
                     // PRN
                     uint32_t prn_ = d_acquisition_gnss_synchro->PRN;
-                    d_dump_file.write(reinterpret_cast<char *>(&prn_), sizeof(uint32_t));
+                    d_dump_file.write(prn_);
                 }
             catch (const std::ifstream::failure &e)
                 {
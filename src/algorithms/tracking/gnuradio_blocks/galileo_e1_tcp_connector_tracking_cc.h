@@ -27,12 +27,14 @@
 
 #include "cpu_multicorrelator.h"
 #include "gnss_block_interface.h"
+#include "gnss_dump_writer.h"
 #include "gnss_synchro.h"
+#include "tcp_batch_communication.h"
 #include "tcp_communication.h"
 #include <gnuradio/block.h>
 #include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
-#include <fstream>
 #include <map>
+#include <memory>
 #include <string>
 
 /** \addtogroup Tracking
@@ -54,7 +56,9 @@ galileo_e1_tcp_connector_make_tracking_cc(
     float dll_bw_hz,
     float early_late_space_chips,
     float very_early_late_space_chips,
-    size_t port_ch0);
+    size_t port_ch0,
+    uint32_t loop_latency,
+    const std::string &shm_name);
 
 /*!
  * \brief This class implements a code DLL + carrier PLL VEML (Very Early
@@ -84,7 +88,9 @@ private:
         float dll_bw_hz,
         float early_late_space_chips,
         float very_early_late_space_chips,
-        size_t port_ch0);
+        size_t port_ch0,
+        uint32_t loop_latency,
+        const std::string &shm_name);
 
     Galileo_E1_Tcp_Connector_Tracking_cc(
         int64_t fs_in, uint32_t vector_length,
@@ -94,7 +100,9 @@ private:
         float dll_bw_hz,
         float early_late_space_chips,
         float very_early_late_space_chips,
-        size_t port_ch0);
+        size_t port_ch0,
+        uint32_t loop_latency,
+        const std::string &shm_name);
 
     void update_local_code();
 
@@ -147,6 +155,10 @@ private:
     int32_t d_listen_connection;
     float d_control_id;
     Tcp_Communication d_tcp_com;
+    std::shared_ptr<Tcp_Batch_Communication> d_batch_com;  // if d_loop_latency > 0
+    Tcp_Packet_Data d_loop_command;                        // last command of the loop filter, if d_loop_latency > 0
+    std::string d_shm_name;
+    uint32_t d_loop_latency;
 
     // PRN period in samples
     int32_t d_current_prn_length_samples;
@@ -170,7 +182,7 @@ private:
 
     // file dump
     std::string d_dump_filename;
-    std::ofstream d_dump_file;
+    Gnss_Dump_Writer d_dump_file;
 
     std::map<std::string, std::string> systemName;
     std::string sys;
@@ -36,6 +36,7 @@
 #include "gnss_synchro.h"
 #include "tracking_2nd_DLL_filter.h"
 #include "tracking_2nd_PLL_filter.h"
+#include "tracking_kalman_filter.h"
 #include <armadillo>
 #include <gnuradio/block.h>
 #include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
@@ -132,21 +133,14 @@ private:
     double d_rem_code_phase_chips;
     float d_rem_carr_phase_rad;
 
-    // Kalman filter variables
-    arma::mat kf_P_x_ini;  // initial state error covariance matrix
-    arma::mat kf_P_x;      // state error covariance matrix
-    arma::mat kf_P_x_pre;  // Predicted state error covariance matrix
-    arma::mat kf_P_y;      // innovation covariance matrix
-
-    arma::mat kf_F;  // state transition matrix
-    arma::mat kf_H;  // system matrix
-    arma::mat kf_R;  // measurement error covariance matrix
-    arma::mat kf_Q;  // system error covariance matrix
-
-    arma::colvec kf_x;      // state vector
-    arma::colvec kf_x_pre;  // predicted state vector
-    arma::colvec kf_y;      // measurement vector
-    arma::mat kf_K;         // Kalman gain matrix
+    // Kalman filter variables. The state is the carrier phase, Doppler and
+    // Doppler rate. The second order filter keeps the Doppler rate at zero,
+    // with zero variance, which gives the same estimates as a filter of two
+    // states.
+    Tracking_Kalman_Filter<3, 1> kf_filter;
+    arma::mat::fixed<3, 3> kf_P_x_ini;  // initial state error covariance matrix
+    arma::mat::fixed<1, 1> kf_P_y;      // innovation covariance matrix
+    arma::vec::fixed<1> kf_y;           // measurement vector
 
     // Bayesian estimator
     Bayesian_estimator bayes_estimator;
@@ -25,12 +25,14 @@
 
 #include "cpu_multicorrelator.h"
 #include "gnss_block_interface.h"
+#include "gnss_dump_writer.h"
 #include "gnss_synchro.h"
+#include "tcp_batch_communication.h"
 #include "tcp_communication.h"
 #include <gnuradio/block.h>
 #include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
-#include <fstream>
 #include <map>
+#include <memory>
 #include <string>
 
 /** \addtogroup Tracking
@@ -49,7 +51,9 @@ gps_l1_ca_tcp_connector_make_tracking_cc(
     bool dump,
     const std::string &dump_filename,
     float early_late_space_chips,
-    size_t port_ch0);
+    size_t port_ch0,
+    uint32_t loop_latency,
+    const std::string &shm_name);
 
 
 /*!
@@ -81,14 +85,18 @@ private:
         bool dump,
         const std::string &dump_filename,
         float early_late_space_chips,
-        size_t port_ch0);
+        size_t port_ch0,
+        uint32_t loop_latency,
+        const std::string &shm_name);
 
     Gps_L1_Ca_Tcp_Connector_Tracking_cc(
         int64_t fs_in, uint32_t vector_length,
         bool dump,
         const std::string &dump_filename,
         float early_late_space_chips,
-        size_t port_ch0);
+        size_t port_ch0,
+        uint32_t loop_latency,
+        const std::string &shm_name);
 
     volk_gnsssdr::vector<gr_complex> d_ca_code;
     // correlator
@@ -97,6 +105,10 @@ private:
     volk_gnsssdr::vector<gr_complex> d_Prompt_buffer;
     Cpu_Multicorrelator multicorrelator_cpu;
     Tcp_Communication d_tcp_com;
+    std::shared_ptr<Tcp_Batch_Communication> d_batch_com;  // if d_loop_latency > 0
+    Tcp_Packet_Data d_loop_command;                        // last command of the loop filter, if d_loop_latency > 0
+    std::string d_shm_name;
+    uint32_t d_loop_latency;
     Gnss_Synchro *d_acquisition_gnss_synchro;
     // tracking configuration vars
 
@@ -106,7 +118,7 @@ private:
 
     // file dump
     std::string d_dump_filename;
-    std::ofstream d_dump_file;
+    Gnss_Dump_Writer d_dump_file;
 
     std::map<std::string, std::string> systemName;
     std::string sys;
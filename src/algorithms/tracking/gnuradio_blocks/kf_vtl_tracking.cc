@@ -36,6 +36,7 @@
 #include "gnss_satellite.h"
 #include "gnss_sdr_create_directory.h"
 #include "gnss_sdr_filesystem.h"
+#include "gnss_sdr_make_unique.h"
 #include "gnss_synchro.h"
 #include "gps_l2c_signal_replica.h"
 #include "gps_l5_signal_replica.h"
@@ -165,6 +166,11 @@ kf_vtl_tracking::kf_vtl_tracking(const Kf_Conf &conf_)
 #endif
 #endif
 
+    if (d_trk_parameters.enable_pvt_aiding)
+        {
+            d_navigation_state_reader = std::make_unique<Gnss_Navigation_State_Reader>();
+        }
+
     // initialize internal vars
     std::map<std::string, std::string> map_signal_pretty_name;
     map_signal_pretty_name["1C"] = "L1 C/A";
@@ -511,7 +517,7 @@ kf_vtl_tracking::kf_vtl_tracking(const Kf_Conf &conf_)
         }
 
     // --- Initializations ---
-    d_Prompt_circular_buffer.set_capacity(d_secondary_code_length);
+    d_secondary_correlator = Gnss_Sign_Correlator::from_string(d_secondary_code_string.substr(0, d_secondary_code_length));
     d_multicorrelator_cpu.set_high_dynamics_resampler(d_trk_parameters.high_dyn);
 
     // Initial code frequency basis of NCO
@@ -743,7 +749,6 @@ void kf_vtl_tracking::start_tracking()
                     d_secondary_code_length = static_cast<uint32_t>(BEIDOU_B1I_GEO_PREAMBLE_LENGTH_SYMBOLS);
                     d_secondary_code_string = BEIDOU_B1I_GEO_PREAMBLE_SYMBOLS_STR;
                     d_data_secondary_code_length = 0;
-                    d_Prompt_circular_buffer.set_capacity(d_secondary_code_length);
                 }
             else
                 {
@@ -757,7 +762,6 @@ void kf_vtl_tracking::start_tracking()
                     d_secondary_code_string = BEIDOU_B1I_SECONDARY_CODE_STR;
                     d_data_secondary_code_length = static_cast<uint32_t>(BEIDOU_B1I_SECONDARY_CODE_LENGTH);
                     d_data_secondary_code_string = BEIDOU_B1I_SECONDARY_CODE_STR;
-                    d_Prompt_circular_buffer.set_capacity(d_secondary_code_length);
                 }
         }
 
@@ -776,7 +780,6 @@ void kf_vtl_tracking::start_tracking()
                     d_secondary_code_length = static_cast<uint32_t>(BEIDOU_B3I_GEO_PREAMBLE_LENGTH_SYMBOLS);
                     d_secondary_code_string = BEIDOU_B3I_GEO_PREAMBLE_SYMBOLS_STR;
                     d_data_secondary_code_length = 0;
-                    d_Prompt_circular_buffer.set_capacity(d_secondary_code_length);
                 }
             else
                 {
@@ -790,7 +793,6 @@ void kf_vtl_tracking::start_tracking()
                     d_secondary_code_string = BEIDOU_B3I_SECONDARY_CODE_STR;
                     d_data_secondary_code_length = static_cast<uint32_t>(BEIDOU_B3I_SECONDARY_CODE_LENGTH);
                     d_data_secondary_code_string = BEIDOU_B3I_SECONDARY_CODE_STR;
-                    d_Prompt_circular_buffer.set_capacity(d_secondary_code_length);
                 }
         }
 
@@ -832,7 +834,7 @@ void kf_vtl_tracking::start_tracking()
     d_state = 1;
     d_cloop = true;
     d_pull_in_transitory = true;
-    d_Prompt_circular_buffer.clear();
+    d_secondary_correlator = Gnss_Sign_Correlator::from_string(d_secondary_code_string.substr(0, d_secondary_code_length));
     d_corrected_doppler = false;
     d_acc_carrier_phase_initialized = false;
 }
@@ -843,8 +845,7 @@ void kf_vtl_tracking::init_kf(double acq_code_phase_chips, double acq_doppler_hz
     // Kalman Filter class variables
     const double Ti = d_correlation_length_ms * 0.001;
     // state vector: code_phase_chips, carrier_phase_rads, carrier_freq_hz,carrier_freq_rate_hz, code_freq_chips_s
-    d_F = arma::mat(5, 5);
-    d_F << 1 << 0 << 0 << 0 << Ti << arma::endr
+    d_kf.F << 1 << 0 << 0 << 0 << Ti << arma::endr
         << 0 << 1 << 2.0 * GNSS_PI * Ti << GNSS_PI * (Ti * Ti) << 0 << arma::endr
         << 0 << 0 << 1 << Ti << 0 << arma::endr
         << 0 << 0 << 0 << 1 << 0 << arma::endr
@@ -852,8 +853,7 @@ void kf_vtl_tracking::init_kf(double acq_code_phase_chips, double acq_doppler_hz
 
     const double B = d_code_chip_rate / d_signal_carrier_freq;  // carrier to code rate factor
 
-    d_H = arma::mat(2, 5);
-    d_H << 1 << 0 << -B * Ti / 2.0 << B * (Ti * Ti) / 6.0 << 0 << arma::endr
+    d_kf.H << 1 << 0 << -B * Ti / 2.0 << B * (Ti * Ti) / 6.0 << 0 << arma::endr
         << 0 << 1 << -GNSS_PI * Ti << GNSS_PI * (Ti * Ti) / 3.0 << 0 << arma::endr;
 
     // Phase noise variance
@@ -863,41 +863,36 @@ void kf_vtl_tracking::init_kf(double acq_code_phase_chips, double acq_doppler_hz
     // const double Sigma2_Phase = 1.0 / (2.0 * CN0_lin * Ti) * (1.0 + 1.0 / (2.0 * CN0_lin * Ti));
 
     // measurement covariance matrix (static)
-    d_R = arma::mat(2, 2);
     //    d_R << Sigma2_Tau << 0 << arma::endr
     //      << 0 << Sigma2_Phase << arma::endr;
 
-    d_R << pow(d_trk_parameters.code_disc_sd_chips, 2.0) << 0 << arma::endr
+    d_kf.R << pow(d_trk_parameters.code_disc_sd_chips, 2.0) << 0 << arma::endr
         << 0 << pow(d_trk_parameters.carrier_disc_sd_rads, 2.0) << arma::endr;
 
     // system covariance matrix (static)
-    d_Q = arma::mat(5, 5);
-    d_Q << pow(d_trk_parameters.code_phase_sd_chips, 2.0) << 0 << 0 << 0 << 0 << arma::endr
+    d_kf.Q << pow(d_trk_parameters.code_phase_sd_chips, 2.0) << 0 << 0 << 0 << 0 << arma::endr
         << 0 << pow(d_trk_parameters.carrier_phase_sd_rad, 2.0) << 0 << 0 << 0 << arma::endr
         << 0 << 0 << pow(d_trk_parameters.carrier_freq_sd_hz, 2.0) << 0 << 0 << arma::endr
         << 0 << 0 << 0 << pow(d_trk_parameters.carrier_freq_rate_sd_hz_s, 2.0) << 0 << arma::endr
         << 0 << 0 << 0 << 0 << pow(d_trk_parameters.code_rate_sd_chips_s, 2.0) << arma::endr;
 
     // initial Kalman covariance matrix
-    d_P_old_old = arma::mat(5, 5);
-
-    d_P_old_old << pow(d_trk_parameters.init_code_phase_sd_chips, 2.0) << 0 << 0 << 0 << 0 << arma::endr
+    d_kf.P << pow(d_trk_parameters.init_code_phase_sd_chips, 2.0) << 0 << 0 << 0 << 0 << arma::endr
                 << 0 << pow(d_trk_parameters.init_carrier_phase_sd_rad, 2.0) << 0 << 0 << 0 << arma::endr
                 << 0 << 0 << pow(d_trk_parameters.init_carrier_freq_sd_hz, 2.0) << 0 << 0 << arma::endr
                 << 0 << 0 << 0 << pow(d_trk_parameters.init_carrier_freq_rate_sd_hz_s, 2.0) << 0 << arma::endr
                 << 0 << 0 << 0 << 0 << pow(d_trk_parameters.init_code_rate_sd_chips_s, 2.0) << arma::endr;
 
     // init state vector
-    d_x_old_old = arma::vec(5);
     // states: code_phase_chips, carrier_phase_rads, carrier_freq_hz, carrier_freq_rate_hz_s, code_freq_rate_chips_s
-    d_x_old_old << acq_code_phase_chips << 0 << acq_doppler_hz << 0 << 0 << arma::endr;
-
-    //    std::cout << "F: " << d_F << "\n";
-    //    std::cout << "H: " << d_H << "\n";
-    //    std::cout << "R: " << d_R << "\n";
-    //    std::cout << "Q: " << d_Q << "\n";
-    //    std::cout << "P: " << d_P_old_old << "\n";
-    //    std::cout << "x: " << d_x_old_old << "\n";
+    d_kf.x << acq_code_phase_chips << 0 << acq_doppler_hz << 0 << 0 << arma::endr;
+
+    //    std::cout << "F: " << d_kf.F << "\n";
+    //    std::cout << "H: " << d_kf.H << "\n";
+    //    std::cout << "R: " << d_kf.R << "\n";
+    //    std::cout << "Q: " << d_kf.Q << "\n";
+    //    std::cout << "P: " << d_kf.P << "\n";
+    //    std::cout << "x: " << d_kf.x << "\n";
 }
 
 
@@ -907,7 +902,7 @@ void kf_vtl_tracking::update_kf_narrow_integration_time()
     const double Ti = d_current_correlation_time_s;
 
     // state vector: code_phase_chips, carrier_phase_rads, carrier_freq_hz,carrier_freq_rate_hz, code_freq_chips_s
-    d_F << 1 << 0 << 0 << 0 << Ti << arma::endr
+    d_kf.F << 1 << 0 << 0 << 0 << Ti << arma::endr
         << 0 << 1 << 2.0 * GNSS_PI * Ti << GNSS_PI * (Ti * Ti) << 0 << arma::endr
         << 0 << 0 << 1 << Ti << 0 << arma::endr
         << 0 << 0 << 0 << 1 << 0 << arma::endr
@@ -915,15 +910,15 @@ void kf_vtl_tracking::update_kf_narrow_integration_time()
 
     const double B = d_code_chip_rate / d_signal_carrier_freq;  // carrier to code rate factor
 
-    d_H << 1 << 0 << -B * Ti / 2.0 << B * (Ti * Ti) / 6.0 << 0 << arma::endr
+    d_kf.H << 1 << 0 << -B * Ti / 2.0 << B * (Ti * Ti) / 6.0 << 0 << arma::endr
         << 0 << 1 << -GNSS_PI * Ti << GNSS_PI * (Ti * Ti) / 3.0 << 0 << arma::endr;
 
     // measurement covariance matrix (static)
-    d_R << pow(d_trk_parameters.code_disc_sd_chips, 2.0) << 0 << arma::endr
+    d_kf.R << pow(d_trk_parameters.code_disc_sd_chips, 2.0) << 0 << arma::endr
         << 0 << pow(d_trk_parameters.carrier_disc_sd_rads, 2.0) << arma::endr;
 
     // system covariance matrix (static)
-    d_Q << pow(d_trk_parameters.narrow_code_phase_sd_chips, 2.0) << 0 << 0 << 0 << 0 << arma::endr
+    d_kf.Q << pow(d_trk_parameters.narrow_code_phase_sd_chips, 2.0) << 0 << 0 << 0 << 0 << arma::endr
         << 0 << pow(d_trk_parameters.narrow_carrier_phase_sd_rad, 2.0) << 0 << 0 << 0 << arma::endr
         << 0 << 0 << pow(d_trk_parameters.narrow_carrier_freq_sd_hz, 2.0) << 0 << 0 << arma::endr
         << 0 << 0 << 0 << pow(d_trk_parameters.narrow_carrier_freq_rate_sd_hz_s, 2.0) << 0 << arma::endr
@@ -937,8 +932,7 @@ void kf_vtl_tracking::update_kf_cn0(double current_cn0_dbhz)
     const double Ti = d_correlation_length_ms * 0.001;
     const double B = d_code_chip_rate / d_signal_carrier_freq;  // carrier to code rate factor
 
-    d_H = arma::mat(2, 5);
-    d_H << 1 << 0 << -B * Ti / 2.0 << B * (Ti * Ti) / 6.0 << 0 << arma::endr
+    d_kf.H << 1 << 0 << -B * Ti / 2.0 << B * (Ti * Ti) / 6.0 << 0 << arma::endr
         << 0 << 1 << -GNSS_PI * Ti << GNSS_PI * (Ti * Ti) / 3.0 << 0 << arma::endr;
 
     // Phase noise variance
@@ -948,8 +942,7 @@ void kf_vtl_tracking::update_kf_cn0(double current_cn0_dbhz)
     const double Sigma2_Phase = 1.0 / (2.0 * CN0_lin * Ti) * (1.0 + 1.0 / (2.0 * CN0_lin * Ti));
 
     // measurement covariance matrix (static)
-    d_R = arma::mat(2, 2);
-    d_R << Sigma2_Tau << 0 << arma::endr
+    d_kf.R << Sigma2_Tau << 0 << arma::endr
         << 0 << Sigma2_Phase << arma::endr;
 }
 
@@ -996,32 +989,7 @@ kf_vtl_tracking::~kf_vtl_tracking()
 bool kf_vtl_tracking::acquire_secondary()
 {
     // ******* preamble correlation ********
-    int32_t corr_value = 0;
-    for (uint32_t i = 0; i < d_secondary_code_length; i++)
-        {
-            if (d_Prompt_circular_buffer[i].real() < 0.0)  // symbols clipping
-                {
-                    if (d_secondary_code_string[i] == '0')
-                        {
-                            corr_value++;
-                        }
-                    else
-                        {
-                            corr_value--;
-                        }
-                }
-            else
-                {
-                    if (d_secondary_code_string[i] == '0')
-                        {
-                            corr_value--;
-                        }
-                    else
-                        {
-                            corr_value++;
-                        }
-                }
-        }
+    const int32_t corr_value = d_secondary_correlator.correlation();
 
     if (abs(corr_value) == static_cast<int32_t>(d_secondary_code_length))
         {
@@ -1152,30 +1120,40 @@ void kf_vtl_tracking::run_Kf()
     // Kalman loop
 
     // Prediction
-    d_x_new_old = d_F * d_x_old_old;
-    d_P_new_old = d_F * d_P_old_old * d_F.t() + d_Q;
+    d_kf.predict();
 
     // Innovation
-    arma::vec z = {d_code_error_disc_chips, d_carr_phase_error_disc_hz * TWO_PI};
+    const arma::vec::fixed<2> z = {d_code_error_disc_chips, d_carr_phase_error_disc_hz * TWO_PI};
 
     // Measurement update
-    arma::mat K = d_P_new_old * d_H.t() * arma::inv(d_H * d_P_new_old * d_H.t() + d_R);  // Kalman gain
+    d_kf.update(z);
 
-    d_x_new_new = d_x_new_old + K * z;
-
-    d_P_new_new = (arma::eye(5, 5) - K * d_H) * d_P_new_old;
+    // Doppler aiding: the pseudorange rate predicted by the PVT solution is
+    // an additional measurement of the carrier Doppler state
+    if (d_navigation_state_reader)
+        {
+            Gnss_Receiver_State receiver;
+            Gnss_Channel_Assistance assistance;
+            if (d_navigation_state_reader->next(d_channel, receiver, assistance) &&
+                assistance.PRN == d_acquisition_gnss_synchro->PRN &&
+                assistance.System == d_acquisition_gnss_synchro->System)
+                {
+                    const double doppler_hz = -assistance.pseudorange_rate_m_s * d_signal_carrier_freq / SPEED_OF_LIGHT_M_S;
+                    d_kf.update_state(2, doppler_hz, d_trk_parameters.pvt_aiding_doppler_sd_hz * d_trk_parameters.pvt_aiding_doppler_sd_hz);
+                }
+        }
 
     // new code phase estimation
-    d_code_error_kf_chips = d_x_new_new(0);
-    d_x_new_new(0) = 0;  // reset error estimation because the NCO corrects the code phase
+    d_code_error_kf_chips = d_kf.x(0);
+    d_kf.x(0) = 0;  // reset error estimation because the NCO corrects the code phase
 
     // new carrier phase estimation
-    d_carrier_phase_kf_rad = d_x_new_new(1);
+    d_carrier_phase_kf_rad = d_kf.x(1);
 
     // New carrier Doppler frequency estimation
-    d_carrier_doppler_kf_hz = d_x_new_new(2);  // d_carrier_loop_filter.get_carrier_error(0, static_cast<float>(d_carr_phase_error_hz), static_cast<float>(d_current_correlation_time_s));
+    d_carrier_doppler_kf_hz = d_kf.x(2);  // d_carrier_loop_filter.get_carrier_error(0, static_cast<float>(d_carr_phase_error_hz), static_cast<float>(d_current_correlation_time_s));
 
-    d_carrier_doppler_rate_kf_hz_s = d_x_new_new(3);
+    d_carrier_doppler_rate_kf_hz_s = d_kf.x(3);
 
     // New code Doppler frequency estimation
     if (d_trk_parameters.carrier_aiding)
@@ -1186,9 +1164,9 @@ void kf_vtl_tracking::run_Kf()
     else
         {
             // use its own KF code rate estimation
-            d_code_freq_kf_chips_s -= d_x_new_new(4);
+            d_code_freq_kf_chips_s -= d_kf.x(4);
         }
-    d_x_new_new(4) = 0;
+    d_kf.x(4) = 0;
     // Experimental: detect Carrier Doppler vs. Code Doppler incoherence and correct the Carrier Doppler
     //    if (d_trk_parameters.enable_doppler_correction == true)
     //        {
@@ -1201,10 +1179,6 @@ void kf_vtl_tracking::run_Kf()
     // correct code and carrier phase
     d_rem_code_phase_samples += d_trk_parameters.fs_in * d_code_error_kf_chips / d_code_freq_kf_chips_s;
     d_rem_carr_phase_rad = d_carrier_phase_kf_rad;
-
-    // prepare data for next KF epoch
-    d_x_old_old = d_x_new_new;
-    d_P_old_old = d_P_new_new;
 }
 
 
@@ -1229,7 +1203,7 @@ void kf_vtl_tracking::clear_tracking_vars()
     d_P_accu_old = gr_complex(0.0, 0.0);
     d_current_symbol = 0;
     d_current_data_symbol = 0;
-    d_Prompt_circular_buffer.clear();
+    d_secondary_correlator.clear();
     d_carrier_phase_rate_step_rad = 0.0;
     d_code_phase_rate_step_chips = 0.0;
 }
@@ -1475,7 +1449,7 @@ void kf_vtl_tracking::log_data()
                     // Carrier estimation
                     tmp_float = static_cast<float>(d_carr_phase_error_disc_hz);
                     d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    tmp_float = static_cast<float>(d_x_new_new(2));
+                    tmp_float = static_cast<float>(d_kf.x(2));
                     d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
                     // code estimation
                     tmp_float = static_cast<float>(d_code_error_disc_chips);
@@ -1867,8 +1841,8 @@ int kf_vtl_tracking::general_work(int noutput_items __attribute__((unused)), gr_
                                 if (d_secondary)
                                     {
                                         // ####### SECONDARY CODE LOCK #####
-                                        d_Prompt_circular_buffer.push_back(*d_Prompt);
-                                        if (d_Prompt_circular_buffer.size() == d_secondary_code_length)
+                                        d_secondary_correlator.push(d_Prompt->real());
+                                        if (d_secondary_correlator.size() == d_secondary_code_length)
                                             {
                                                 next_state = acquire_secondary();
                                                 if (next_state)
@@ -1883,8 +1857,8 @@ int kf_vtl_tracking::general_work(int noutput_items __attribute__((unused)), gr_
                                 else if (d_symbols_per_bit > 1)  // Signal does not have secondary code. Search a bit transition by sign change
                                     {
                                         // ******* preamble correlation ********
-                                        d_Prompt_circular_buffer.push_back(*d_Prompt);
-                                        if (d_Prompt_circular_buffer.size() == d_secondary_code_length)
+                                        d_secondary_correlator.push(d_Prompt->real());
+                                        if (d_secondary_correlator.size() == d_secondary_code_length)
                                             {
                                                 next_state = acquire_secondary();
                                                 if (next_state)
@@ -1913,7 +1887,7 @@ int kf_vtl_tracking::general_work(int noutput_items __attribute__((unused)), gr_
                                 d_P_data_accu = gr_complex(0.0, 0.0);
                                 d_L_accu = gr_complex(0.0, 0.0);
                                 d_VL_accu = gr_complex(0.0, 0.0);
-                                d_Prompt_circular_buffer.clear();
+                                d_secondary_correlator.clear();
                                 d_current_symbol = 0;
                                 d_current_data_symbol = 0;
 
@@ -28,12 +28,14 @@
 #include "cpu_multicorrelator_real_codes.h"
 #include "exponential_smoother.h"
 #include "gnss_block_interface.h"
+#include "gnss_navigation_state.h"
+#include "gnss_sign_correlator.h"
 #include "gnss_time.h"  // for timetags produced by File_Timestamp_Signal_Source
 #include "kf_conf.h"
 #include "tracking_FLL_PLL_filter.h"  // for PLL/FLL filter
+#include "tracking_kalman_filter.h"
 #include "tracking_loop_filter.h"     // for DLL filter
 #include <armadillo>
-#include <boost/circular_buffer.hpp>
 #include <gnuradio/block.h>                   // for block
 #include <gnuradio/gr_complex.h>              // for gr_complex
 #include <gnuradio/types.h>                   // for gr_vector_int, gr_vector...
@@ -104,6 +106,8 @@ private:
 
     Gnss_Synchro *d_acquisition_gnss_synchro;
 
+    std::unique_ptr<Gnss_Navigation_State_Reader> d_navigation_state_reader;  // Doppler aiding from the PVT
+
     volk_gnsssdr::vector<float> d_tracking_code;
     volk_gnsssdr::vector<float> d_data_code;
     volk_gnsssdr::vector<float> d_local_code_shift_chips;
@@ -111,21 +115,13 @@ private:
     volk_gnsssdr::vector<gr_complex> d_Prompt_Data;
     volk_gnsssdr::vector<gr_complex> d_Prompt_buffer;
 
-    boost::circular_buffer<gr_complex> d_Prompt_circular_buffer;
+    Gnss_Sign_Correlator d_secondary_correlator;  // signs of the last prompt symbols
 
     const size_t d_int_type_hash_code = typeid(int).hash_code();
 
-    // Kalman Filter class variables
-    arma::mat d_F;
-    arma::mat d_H;
-    arma::mat d_R;
-    arma::mat d_Q;
-    arma::mat d_P_old_old;
-    arma::mat d_P_new_old;
-    arma::mat d_P_new_new;
-    arma::vec d_x_old_old;
-    arma::vec d_x_new_old;
-    arma::vec d_x_new_new;
+    // Kalman Filter of the code phase, carrier phase, carrier frequency and
+    // rate and code frequency, with the code and carrier discriminators
+    Tracking_Kalman_Filter<5, 2> d_kf;
 
     std::string d_secondary_code_string;
     std::string d_data_secondary_code_string;
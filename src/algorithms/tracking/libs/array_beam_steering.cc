@@ -0,0 +1,75 @@
+/*!
+ * \file array_beam_steering.cc
+ * \brief Digital beam of the elements of an antenna array, steered to the
+ * satellite tracked by a channel
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "array_beam_steering.h"
+#include <algorithm>
+#include <cmath>
+
+
+Array_Beam_Steering::Array_Beam_Steering(int n_elements, float alpha, int reference_element)
+    : d_weights(std::max(n_elements, 1)),
+      d_cross_prompt(std::max(n_elements, 1)),
+      d_alpha(std::min(std::max(alpha, 1e-6F), 1.0F)),
+      d_n_elements(std::max(n_elements, 1)),
+      d_reference_element(std::min(std::max(reference_element, 0), std::max(n_elements, 1) - 1))
+{
+    reset();
+}
+
+
+void Array_Beam_Steering::reset()
+{
+    const float weight = 1.0F / std::sqrt(static_cast<float>(d_n_elements));
+    std::fill(d_weights.begin(), d_weights.end(), std::complex<float>(weight, 0.0));
+    std::fill(d_cross_prompt.begin(), d_cross_prompt.end(), std::complex<float>(0.0, 0.0));
+    d_initialized = false;
+}
+
+
+void Array_Beam_Steering::update(const std::complex<float>* element_corr, int n_correlators, int prompt_index)
+{
+    const std::complex<float> reference = std::conj(element_corr[d_reference_element * n_correlators + prompt_index]);
+    const float alpha = d_initialized ? d_alpha : 1.0F;
+    float norm = 0.0;
+    for (int e = 0; e < d_n_elements; e++)
+        {
+            d_cross_prompt[e] += alpha * (element_corr[e * n_correlators + prompt_index] * reference - d_cross_prompt[e]);
+            norm += std::norm(d_cross_prompt[e]);
+        }
+    if (norm > 0.0)
+        {
+            const float scale = 1.0F / std::sqrt(norm);
+            for (int e = 0; e < d_n_elements; e++)
+                {
+                    d_weights[e] = d_cross_prompt[e] * scale;
+                }
+            d_initialized = true;
+        }
+}
+
+
+void Array_Beam_Steering::combine(const std::complex<float>* element_corr, int n_correlators, std::complex<float>* beam_corr) const
+{
+    for (int k = 0; k < n_correlators; k++)
+        {
+            std::complex<float> beam(0.0, 0.0);
+            for (int e = 0; e < d_n_elements; e++)
+                {
+                    beam += std::conj(d_weights[e]) * element_corr[e * n_correlators + k];
+                }
+            beam_corr[k] = beam;
+        }
+}
@@ -0,0 +1,87 @@
+/*!
+ * \file array_beam_steering.h
+ * \brief Digital beam of the elements of an antenna array, steered to the
+ * satellite tracked by a channel
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ARRAY_BEAM_STEERING_H
+#define GNSS_SDR_ARRAY_BEAM_STEERING_H
+
+#include <complex>
+#include <vector>
+
+/** \addtogroup Tracking
+ * \{ */
+/** \addtogroup Tracking_libs
+ * \{ */
+
+
+/*!
+ * \brief Combines the correlations of the elements of an antenna array in a
+ * beam steered to the satellite of a channel.
+ *
+ * The weights are the smoothed prompt correlations of the elements,
+ * referred to the phase of the prompt correlation of the reference element
+ * (maximal ratio combining), so they follow the direction of the satellite
+ * and the phase and gain mismatches of the elements without any calibration
+ * nor attitude. The carrier phase of the reference element cancels in the
+ * weights, so they converge even before the carrier is locked, and the
+ * beam keeps the carrier phase of the reference element. The weights have
+ * unit norm, so the noise power of the beam is the one of an element, and
+ * its signal power is up to n_elements times bigger.
+ *
+ * Until the first update, the weights are the same for all the elements,
+ * as the broadside beam of the acquisition.
+ */
+class Array_Beam_Steering
+{
+public:
+    /*!
+     * \brief alpha is the weight of the last prompt correlations in the
+     * smoothed ones, in (0, 1]
+     */
+    Array_Beam_Steering(int n_elements, float alpha, int reference_element = 0);
+
+    //! Back to the broadside beam, for a new satellite
+    void reset();
+
+    /*!
+     * \brief Updates the weights with the prompt correlations of the
+     * elements, at element_corr[e * n_correlators + prompt_index]
+     */
+    void update(const std::complex<float>* element_corr, int n_correlators, int prompt_index);
+
+    /*!
+     * \brief Writes in beam_corr the n_correlators correlations of the
+     * beam, from the ones of the elements at element_corr[e * n_correlators + k]
+     */
+    void combine(const std::complex<float>* element_corr, int n_correlators, std::complex<float>* beam_corr) const;
+
+    inline const std::vector<std::complex<float>>& weights() const
+    {
+        return d_weights;
+    }
+
+private:
+    std::vector<std::complex<float>> d_weights;
+    std::vector<std::complex<float>> d_cross_prompt;  // smoothed prompt correlations, referred to the reference element
+    float d_alpha;
+    int d_n_elements;
+    int d_reference_element;
+    bool d_initialized{false};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_ARRAY_BEAM_STEERING_H
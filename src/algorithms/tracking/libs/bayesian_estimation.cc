@@ -86,8 +86,7 @@ void Bayesian_estimator::init(const arma::mat& mu_prior_0, int kappa_prior_0, in
  */
 void Bayesian_estimator::update_sequential(const arma::vec& data)
 {
-    int K = data.n_cols;
-    int ny = data.n_rows;
+    const auto ny = static_cast<int>(data.n_rows);
 
     if (mu_prior.is_empty())
         {
@@ -99,33 +98,35 @@ void Bayesian_estimator::update_sequential(const arma::vec& data)
             Psi_prior = arma::zeros(ny, ny);
         }
 
-    arma::vec y_mean = arma::mean(data, 1);
-    arma::mat Psi_N = arma::zeros(ny, ny);
-
-    for (int kk = 0; kk < K; kk++)
+    // A vector holds a single sample, so the scatter matrix of the data around
+    // its mean is zero and the posteriors only depend on the deviation of the
+    // sample from the prior mean. They are computed in place, element by
+    // element, so that the update does not allocate memory.
+    const float weight = static_cast<float>(kappa_prior) / (static_cast<float>(kappa_prior) + 1.0F);
+    for (arma::uword j = 0; j < data.n_rows; j++)
         {
-            Psi_N = Psi_N + (data.col(kk) - y_mean) * ((data.col(kk) - y_mean).t());
+            const double deviation_j = data(j) - mu_prior(j);
+            for (arma::uword i = 0; i < data.n_rows; i++)
+                {
+                    Psi_prior(i, j) += weight * (data(i) - mu_prior(i)) * deviation_j;
+                }
         }
+    for (arma::uword i = 0; i < data.n_rows; i++)
+        {
+            mu_prior(i) = (kappa_prior * mu_prior(i) + data(i)) / (kappa_prior + 1);
+        }
+    kappa_prior++;
+    nu_prior++;
 
-    arma::vec mu_posterior = (kappa_prior * mu_prior + K * y_mean) / (kappa_prior + K);
-    int kappa_posterior = kappa_prior + K;
-    int nu_posterior = nu_prior + K;
-    arma::mat Psi_posterior = Psi_prior + Psi_N + (static_cast<float>(kappa_prior) * static_cast<float>(K)) / (static_cast<float>(kappa_prior) + static_cast<float>(K)) * (y_mean - mu_prior) * ((y_mean - mu_prior).t());
-
-    mu_est = mu_posterior;
-    if ((nu_posterior - ny - 1) > 0)
+    mu_est = mu_prior;
+    if ((nu_prior - ny - 1) > 0)
         {
-            Psi_est = Psi_posterior / (nu_posterior - ny - 1);
+            Psi_est = Psi_prior / (nu_prior - ny - 1);
         }
     else
         {
-            Psi_est = Psi_posterior / (nu_posterior + ny + 1);
+            Psi_est = Psi_prior / (nu_prior + ny + 1);
         }
-
-    mu_prior = mu_posterior;
-    kappa_prior = kappa_posterior;
-    nu_prior = nu_posterior;
-    Psi_prior = Psi_posterior;
 }
 
 
@@ -168,13 +169,13 @@ void Bayesian_estimator::update_sequential(const arma::vec& data, const arma::ve
 }
 
 
-arma::mat Bayesian_estimator::get_mu_est() const
+const arma::mat& Bayesian_estimator::get_mu_est() const
 {
     return mu_est;
 }
 
 
-arma::mat Bayesian_estimator::get_Psi_est() const
+const arma::mat& Bayesian_estimator::get_Psi_est() const
 {
     return Psi_est;
 }
@@ -67,11 +67,15 @@ public:
 
     void init(const arma::mat& mu_prior_0, int kappa_prior_0, int nu_prior_0, const arma::mat& Psi_prior_0);
 
+    /*!
+     * \brief Updates the estimates with the sample data, in place and without
+     * allocating memory once the dimension of the samples is set
+     */
     void update_sequential(const arma::vec& data);
     void update_sequential(const arma::vec& data, const arma::vec& mu_prior_0, int kappa_prior_0, int nu_prior_0, const arma::mat& Psi_prior_0);
 
-    arma::mat get_mu_est() const;
-    arma::mat get_Psi_est() const;
+    const arma::mat& get_mu_est() const;
+    const arma::mat& get_Psi_est() const;
 
 private:
     arma::vec mu_est;
@@ -0,0 +1,124 @@
+/*!
+ * \file code_replica_cache.cc
+ * \brief Tables of local code replicas pre-sampled at quantized code phases,
+ * shared by all the tracking channels of the same signal and PRN.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "code_replica_cache.h"
+#include <cmath>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+// The replica length is rounded up to a multiple of this number of samples,
+// so that the replicas are aligned and the length changes of the
+// integration period do not require a new table
+constexpr int CODE_REPLICA_LENGTH_QUANTUM = 256;
+
+// step bin, first phase, last phase, phases per chip, length, local code
+using Code_Replica_Key = std::tuple<int64_t, int, int, int, int, std::vector<float>>;
+}  // namespace
+
+
+std::shared_ptr<const Code_Replica_Cache> Code_Replica_Cache::get(const float *local_code,
+    int code_length_chips,
+    float code_phase_step_chips,
+    int first_phase_chips,
+    int last_phase_chips,
+    int phases_per_chip,
+    int length_samples)
+{
+    // leave some room for the length changes of the integration period
+    const int length = ((length_samples + length_samples / 16) / CODE_REPLICA_LENGTH_QUANTUM + 1) * CODE_REPLICA_LENGTH_QUANTUM;
+
+    // With bins of 1 / (2 * phases_per_chip * length) chips per sample, the
+    // code phase step of the table drifts less than 1 / (4 * phases_per_chip)
+    // chips from the requested one over the whole replica
+    const double step_bin_width = 1.0 / (2.0 * static_cast<double>(phases_per_chip) * static_cast<double>(length));
+    const auto step_bin = static_cast<int64_t>(std::llround(static_cast<double>(code_phase_step_chips) / step_bin_width));
+
+    static std::mutex cache_mutex;
+    static std::map<Code_Replica_Key, std::weak_ptr<const Code_Replica_Cache>> cache;
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    for (auto it = cache.begin(); it != cache.end();)
+        {
+            // forget the tables not used anymore
+            it = it->second.expired() ? cache.erase(it) : std::next(it);
+        }
+    Code_Replica_Key key{step_bin, first_phase_chips, last_phase_chips, phases_per_chip, length, std::vector<float>(local_code, local_code + code_length_chips)};
+    std::shared_ptr<const Code_Replica_Cache> table = cache[key].lock();
+    if (table == nullptr)
+        {
+            table = std::make_shared<const Code_Replica_Cache>(local_code, code_length_chips, static_cast<double>(step_bin) * step_bin_width,
+                first_phase_chips, last_phase_chips, phases_per_chip, length);
+            cache[key] = table;
+        }
+    return table;
+}
+
+
+Code_Replica_Cache::Code_Replica_Cache(const float *local_code,
+    int code_length_chips,
+    double code_phase_step_chips,
+    int first_phase_chips,
+    int last_phase_chips,
+    int phases_per_chip,
+    int length_samples) : d_code_phase_step_chips(code_phase_step_chips),
+                          d_first_phase_chips(first_phase_chips),
+                          d_phases_per_chip(phases_per_chip),
+                          d_n_replicas((last_phase_chips - first_phase_chips) * phases_per_chip + 1),
+                          d_length_samples(length_samples)
+{
+    d_replicas = volk_gnsssdr::vector<float>(static_cast<size_t>(d_n_replicas) * static_cast<size_t>(d_length_samples));
+    for (int r = 0; r < d_n_replicas; r++)
+        {
+            const double first_phase = static_cast<double>(d_first_phase_chips) + static_cast<double>(r) / static_cast<double>(d_phases_per_chip);
+            float *replica = &d_replicas[static_cast<size_t>(r) * static_cast<size_t>(d_length_samples)];
+            for (int n = 0; n < d_length_samples; n++)
+                {
+                    int chip = static_cast<int>(std::floor(first_phase + d_code_phase_step_chips * static_cast<double>(n))) % code_length_chips;
+                    if (chip < 0)
+                        {
+                            chip += code_length_chips;
+                        }
+                    replica[n] = local_code[chip];
+                }
+        }
+}
+
+
+const float *Code_Replica_Cache::replica(float code_phase_chips) const
+{
+    const auto r = static_cast<int>(std::lround((static_cast<double>(code_phase_chips) - static_cast<double>(d_first_phase_chips)) * static_cast<double>(d_phases_per_chip)));
+    if (r < 0 or r >= d_n_replicas)
+        {
+            return nullptr;
+        }
+    return &d_replicas[static_cast<size_t>(r) * static_cast<size_t>(d_length_samples)];
+}
+
+
+bool Code_Replica_Cache::fits(float code_phase_step_chips, float code_phase_rate_step_chips, int length_samples) const
+{
+    if (length_samples > d_length_samples)
+        {
+            return false;
+        }
+    const auto n = static_cast<double>(length_samples - 1);
+    const double drift_chips = std::abs(static_cast<double>(code_phase_step_chips) - d_code_phase_step_chips) * n + std::abs(static_cast<double>(code_phase_rate_step_chips)) * n * n;
+    return drift_chips <= 0.5 / static_cast<double>(d_phases_per_chip);
+}
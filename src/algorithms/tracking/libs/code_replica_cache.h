@@ -0,0 +1,102 @@
+/*!
+ * \file code_replica_cache.h
+ * \brief Tables of local code replicas pre-sampled at quantized code phases,
+ * shared by all the tracking channels of the same signal and PRN.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_CODE_REPLICA_CACHE_H
+#define GNSS_SDR_CODE_REPLICA_CACHE_H
+
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <cstdint>
+#include <memory>
+
+/** \addtogroup Tracking
+ * \{ */
+/** \addtogroup Tracking_libs
+ * \{ */
+
+
+/*!
+ * \brief Table of replicas of a local code, sampled at a fixed code phase
+ * step and starting at code phases spaced 1 / phases_per_chip chips.
+ *
+ * Once a tracking loop is settled, each integration period starts within
+ * one sample of the beginning of the code, and the code phase step only
+ * changes with the code Doppler. The resampled code of a correlator tap is
+ * then one of the replicas of the table, and the correlators can be computed
+ * with the samples of the table instead of resampling the local code at each
+ * integration period.
+ *
+ * The tables are computed on first use and shared through a global cache by
+ * all the correlators with the same local code (that is, the same signal and
+ * PRN), code phase step bin, code phase range and replica length. A table
+ * is released when the last correlator using it does not need it anymore.
+ */
+class Code_Replica_Cache
+{
+public:
+    /*!
+     * \brief Returns the table of local_code replicas for code phases in
+     * [first_phase_chips, last_phase_chips] with, at least, length_samples
+     * samples. The code phase step of the table is the center of the bin
+     * of code_phase_step_chips.
+     */
+    static std::shared_ptr<const Code_Replica_Cache> get(const float *local_code,
+        int code_length_chips,
+        float code_phase_step_chips,
+        int first_phase_chips,
+        int last_phase_chips,
+        int phases_per_chip,
+        int length_samples);
+
+    Code_Replica_Cache(const float *local_code,
+        int code_length_chips,
+        double code_phase_step_chips,
+        int first_phase_chips,
+        int last_phase_chips,
+        int phases_per_chip,
+        int length_samples);
+
+    /*!
+     * \brief Returns the replica nearest to the code phase at the first
+     * sample, or nullptr if it is out of the range of the table.
+     */
+    const float *replica(float code_phase_chips) const;
+
+    /*!
+     * \brief Returns true if the replicas of the table are within
+     * 1 / (2 * phases_per_chip) chips of the local code resampled with
+     * code_phase_step_chips and code_phase_rate_step_chips over
+     * length_samples samples.
+     */
+    bool fits(float code_phase_step_chips, float code_phase_rate_step_chips, int length_samples) const;
+
+    inline int length_samples() const
+    {
+        return d_length_samples;
+    }
+
+private:
+    volk_gnsssdr::vector<float> d_replicas;
+    double d_code_phase_step_chips;
+    int d_first_phase_chips;
+    int d_phases_per_chip;
+    int d_n_replicas;
+    int d_length_samples;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_CODE_REPLICA_CACHE_H
@@ -0,0 +1,236 @@
+/*!
+ * \file cpu_multicorrelator_8ic.cc
+ * \brief Integer CPU vector multiTAP correlator class for 8-bit and 16-bit
+ * complex samples
+ *
+ * Class that implements a vector multiTAP correlator for CPUs working with
+ * integers on the samples of low-bit front ends
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "cpu_multicorrelator_8ic.h"
+#include "MATH_CONSTANTS.h"
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+// Samples correlated with the same NCO state. The carrier and code phase
+// rates are applied between blocks, and the integer accumulators of the
+// correlation kernel cannot overflow within a block.
+constexpr int MULTICORRELATOR_8IC_BLOCK_SAMPLES = 4096;
+
+// Amplitude of the carrier of the correlation kernel
+constexpr float MULTICORRELATOR_8IC_CARRIER_AMPLITUDE = 127.0;
+
+
+void quantize_local_code(volk_gnsssdr::vector<int16_t>& quantized_code, const float* local_code, int code_length_chips)
+{
+    quantized_code.resize(code_length_chips);
+    for (int n = 0; n < code_length_chips; n++)
+        {
+            quantized_code[n] = local_code[n] < 0.0 ? -1 : 1;
+        }
+}
+
+
+uint32_t carrier_phase_to_nco(double phase_rad)
+{
+    // the correlation kernel rotates the samples by the phase of the NCO, so it is the opposite of the carrier phase
+    return static_cast<uint32_t>(static_cast<int64_t>(std::llround(-std::fmod(phase_rad, TWO_PI) / TWO_PI * 4294967296.0)));
+}
+}  // namespace
+
+
+Cpu_Multicorrelator_8ic::~Cpu_Multicorrelator_8ic()
+{
+    if (d_local_codes_resampled != nullptr)
+        {
+            Cpu_Multicorrelator_8ic::free();
+        }
+}
+
+
+bool Cpu_Multicorrelator_8ic::init(
+    int max_signal_length_samples,
+    int n_correlators,
+    int n_data_correlators)
+{
+    // ALLOCATE MEMORY FOR INTERNAL vectors
+    size_t size = std::min(max_signal_length_samples, MULTICORRELATOR_8IC_BLOCK_SAMPLES) * sizeof(int16_t);
+    const int n_vectors = n_correlators + n_data_correlators;
+
+    d_local_codes_resampled = static_cast<int16_t**>(volk_gnsssdr_malloc(n_vectors * sizeof(int16_t*), volk_gnsssdr_get_alignment()));
+    for (int n = 0; n < n_vectors; n++)
+        {
+            d_local_codes_resampled[n] = static_cast<int16_t*>(volk_gnsssdr_malloc(size, volk_gnsssdr_get_alignment()));
+        }
+    d_corr_block = volk_gnsssdr::vector<std::complex<float>>(n_vectors);
+    d_n_correlators = n_correlators;
+    d_n_data_correlators = n_data_correlators;
+    return true;
+}
+
+
+bool Cpu_Multicorrelator_8ic::set_local_code_and_taps(
+    int code_length_chips,
+    const float* local_code_in,
+    float* shifts_chips)
+{
+    // the local codes are quantized at the next correlation, when they have been generated
+    d_local_code_in = local_code_in;
+    d_shifts_chips = shifts_chips;
+    d_code_length_chips = code_length_chips;
+    d_local_codes_quantized = false;
+    return true;
+}
+
+
+bool Cpu_Multicorrelator_8ic::set_data_local_code_and_taps(
+    int code_length_chips,
+    const float* local_code_in,
+    float* shifts_chips)
+{
+    d_data_local_code_in = local_code_in;
+    d_data_shifts_chips = shifts_chips;
+    d_data_code_length_chips = code_length_chips;
+    d_local_codes_quantized = false;
+    return true;
+}
+
+
+bool Cpu_Multicorrelator_8ic::set_input_output_vectors(std::complex<float>* corr_out, const lv_8sc_t* sig_in)
+{
+    // Save CPU pointers
+    d_sig_in = sig_in;
+    d_sig_in_16ic = nullptr;
+    d_corr_out = corr_out;
+    return true;
+}
+
+
+bool Cpu_Multicorrelator_8ic::set_input_output_vectors(std::complex<float>* corr_out, const lv_16sc_t* sig_in)
+{
+    // Save CPU pointers
+    d_sig_in = nullptr;
+    d_sig_in_16ic = sig_in;
+    d_corr_out = corr_out;
+    return true;
+}
+
+
+bool Cpu_Multicorrelator_8ic::set_data_output_vector(std::complex<float>* corr_data_out)
+{
+    d_corr_data_out = corr_data_out;
+    return true;
+}
+
+
+void Cpu_Multicorrelator_8ic::update_local_code(int correlator_length_samples, float rem_code_phase_chips, float code_phase_step_chips)
+{
+    volk_gnsssdr_16i_xn_resampler_16i_xn(d_local_codes_resampled,
+        d_local_code.data(),
+        rem_code_phase_chips,
+        code_phase_step_chips,
+        d_shifts_chips,
+        d_code_length_chips,
+        d_n_correlators,
+        correlator_length_samples);
+    if (d_n_data_correlators > 0)
+        {
+            volk_gnsssdr_16i_xn_resampler_16i_xn(d_local_codes_resampled + d_n_correlators,
+                d_data_local_code.data(),
+                rem_code_phase_chips,
+                code_phase_step_chips,
+                d_data_shifts_chips,
+                d_data_code_length_chips,
+                d_n_data_correlators,
+                correlator_length_samples);
+        }
+}
+
+
+bool Cpu_Multicorrelator_8ic::Carrier_wipeoff_multicorrelator_resampler(
+    float rem_carrier_phase_in_rad,
+    float phase_step_rad,
+    float phase_rate_step_rad,
+    float rem_code_phase_chips,
+    float code_phase_step_chips,
+    float code_phase_rate_step_chips,
+    int signal_length_samples)
+{
+    if (!d_local_codes_quantized)
+        {
+            quantize_local_code(d_local_code, d_local_code_in, d_code_length_chips);
+            if (d_n_data_correlators > 0)
+                {
+                    quantize_local_code(d_data_local_code, d_data_local_code_in, d_data_code_length_chips);
+                }
+            d_local_codes_quantized = true;
+        }
+
+    const int n_vectors = d_n_correlators + d_n_data_correlators;
+    const float scale = 1.0F / MULTICORRELATOR_8IC_CARRIER_AMPLITUDE;
+    for (int first_sample = 0; first_sample < signal_length_samples; first_sample += MULTICORRELATOR_8IC_BLOCK_SAMPLES)
+        {
+            const int num_samples = std::min(MULTICORRELATOR_8IC_BLOCK_SAMPLES, signal_length_samples - first_sample);
+            const auto n = static_cast<double>(first_sample);
+
+            // code NCO at the first sample of the block
+            const double block_code_phase_chips = static_cast<double>(code_phase_step_chips) * n + static_cast<double>(code_phase_rate_step_chips) * n * n;
+            const auto block_rem_code_phase_chips = static_cast<float>(std::fmod(static_cast<double>(rem_code_phase_chips) - block_code_phase_chips, static_cast<double>(d_code_length_chips)));
+            const auto block_code_phase_step_chips = static_cast<float>(static_cast<double>(code_phase_step_chips) + 2.0 * static_cast<double>(code_phase_rate_step_chips) * n);
+            update_local_code(num_samples, block_rem_code_phase_chips, block_code_phase_step_chips);
+
+            // carrier NCO at the first sample of the block
+            const double block_carrier_phase_rad = static_cast<double>(rem_carrier_phase_in_rad) + static_cast<double>(phase_step_rad) * n + static_cast<double>(phase_rate_step_rad) * n * n;
+            uint32_t nco_phase[1];
+            nco_phase[0] = carrier_phase_to_nco(block_carrier_phase_rad);
+            const uint32_t nco_phase_inc = carrier_phase_to_nco(static_cast<double>(phase_step_rad) + 2.0 * static_cast<double>(phase_rate_step_rad) * n);
+
+            // call VOLK_GNSSSDR kernel
+            if (d_sig_in_16ic != nullptr)
+                {
+                    volk_gnsssdr_16ic_16i_nco_dot_prod_32fc_xn(d_corr_block.data(), d_sig_in_16ic + first_sample, nco_phase_inc, nco_phase, const_cast<const int16_t**>(d_local_codes_resampled), n_vectors, num_samples);
+                }
+            else
+                {
+                    volk_gnsssdr_8ic_16i_nco_dot_prod_32fc_xn(d_corr_block.data(), d_sig_in + first_sample, nco_phase_inc, nco_phase, const_cast<const int16_t**>(d_local_codes_resampled), n_vectors, num_samples);
+                }
+            for (int k = 0; k < d_n_correlators; k++)
+                {
+                    d_corr_out[k] = (first_sample == 0 ? std::complex<float>(0.0, 0.0) : d_corr_out[k]) + d_corr_block[k] * scale;
+                }
+            for (int k = 0; k < d_n_data_correlators; k++)
+                {
+                    d_corr_data_out[k] = (first_sample == 0 ? std::complex<float>(0.0, 0.0) : d_corr_data_out[k]) + d_corr_block[d_n_correlators + k] * scale;
+                }
+        }
+    return true;
+}
+
+
+bool Cpu_Multicorrelator_8ic::free()
+{
+    // Free memory
+    if (d_local_codes_resampled != nullptr)
+        {
+            for (int n = 0; n < d_n_correlators + d_n_data_correlators; n++)
+                {
+                    volk_gnsssdr_free(d_local_codes_resampled[n]);
+                }
+            volk_gnsssdr_free(d_local_codes_resampled);
+            d_local_codes_resampled = nullptr;
+        }
+    return true;
+}
@@ -0,0 +1,90 @@
+/*!
+ * \file cpu_multicorrelator_8ic.h
+ * \brief Integer CPU vector multiTAP correlator class for 8-bit and 16-bit
+ * complex samples
+ *
+ * Class that implements a vector multiTAP correlator for CPUs working with
+ * integers on the samples of low-bit front ends
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_CPU_MULTICORRELATOR_8IC_H
+#define GNSS_SDR_CPU_MULTICORRELATOR_8IC_H
+
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
+#include <complex>
+#include <cstdint>
+
+/** \addtogroup Tracking
+ * \{ */
+/** \addtogroup Tracking_libs
+ * \{ */
+
+
+/*!
+ * \brief Class that implements carrier wipe-off and correlators of 8-bit
+ * complex samples (for instance, the unpacked samples of 1-bit, 2-bit or
+ * 4-bit front ends) or 16-bit complex samples with integer arithmetic.
+ *
+ * The local codes are quantized to their signs and resampled as 16-bit
+ * integers, and the carrier is generated by a 32-bit numerically controlled
+ * oscillator and a 64-phase table (see volk_gnsssdr_8ic_16i_nco_dot_prod_32fc_xn),
+ * so the correlation reads one byte (or two, for 16-bit samples, see
+ * volk_gnsssdr_16ic_16i_nco_dot_prod_32fc_xn) per sample component instead
+ * of the four of a single-precision float sample. The correlations are scaled back to the
+ * amplitude of the input samples, so they can be used in place of the ones
+ * of Cpu_Multicorrelator_Real_Codes.
+ *
+ * The carrier and code phase rates are applied by updating the NCOs every
+ * 4096 samples.
+ */
+class Cpu_Multicorrelator_8ic
+{
+public:
+    Cpu_Multicorrelator_8ic() = default;
+    ~Cpu_Multicorrelator_8ic();
+    bool init(int max_signal_length_samples, int n_correlators, int n_data_correlators = 0);
+    bool set_local_code_and_taps(int code_length_chips, const float *local_code_in, float *shifts_chips);
+    bool set_data_local_code_and_taps(int code_length_chips, const float *local_code_in, float *shifts_chips);
+    bool set_input_output_vectors(std::complex<float> *corr_out, const lv_8sc_t *sig_in);
+    bool set_input_output_vectors(std::complex<float> *corr_out, const lv_16sc_t *sig_in);
+    bool set_data_output_vector(std::complex<float> *corr_data_out);
+    bool Carrier_wipeoff_multicorrelator_resampler(float rem_carrier_phase_in_rad, float phase_step_rad, float phase_rate_step_rad, float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips, int signal_length_samples);
+    bool free();
+
+private:
+    void update_local_code(int correlator_length_samples, float rem_code_phase_chips, float code_phase_step_chips);
+
+    volk_gnsssdr::vector<int16_t> d_local_code;
+    volk_gnsssdr::vector<int16_t> d_data_local_code;
+    volk_gnsssdr::vector<std::complex<float>> d_corr_block;
+    const lv_8sc_t *d_sig_in{nullptr};
+    const lv_16sc_t *d_sig_in_16ic{nullptr};
+    const float *d_local_code_in{nullptr};
+    const float *d_data_local_code_in{nullptr};
+    std::complex<float> *d_corr_out{nullptr};
+    std::complex<float> *d_corr_data_out{nullptr};
+    int16_t **d_local_codes_resampled{nullptr};
+    float *d_shifts_chips{nullptr};
+    float *d_data_shifts_chips{nullptr};
+    int d_code_length_chips{0};
+    int d_data_code_length_chips{0};
+    int d_n_correlators{0};
+    int d_n_data_correlators{0};
+    bool d_local_codes_quantized{false};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_CPU_MULTICORRELATOR_8IC_H
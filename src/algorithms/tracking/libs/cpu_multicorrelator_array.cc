@@ -0,0 +1,230 @@
+/*!
+ * \file cpu_multicorrelator_array.cc
+ * \brief Carrier wipe-off and correlators of the elements of an antenna
+ * array, in one pass over their interleaved samples
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "cpu_multicorrelator_array.h"
+#include "MATH_CONSTANTS.h"
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+// Samples correlated with the same code and carrier phase steps. The local
+// code and carrier replicas of a block stay in the cache while the elements
+// are correlated.
+constexpr int MULTICORRELATOR_ARRAY_BLOCK_SAMPLES = 4096;
+}  // namespace
+
+
+Cpu_Multicorrelator_Array::~Cpu_Multicorrelator_Array()
+{
+    if (d_local_codes_resampled != nullptr)
+        {
+            Cpu_Multicorrelator_Array::free();
+        }
+}
+
+
+bool Cpu_Multicorrelator_Array::init(
+    int max_signal_length_samples,
+    int n_correlators,
+    int n_elements,
+    int n_data_correlators)
+{
+    // ALLOCATE MEMORY FOR INTERNAL vectors
+    const int block_samples = std::min(max_signal_length_samples, MULTICORRELATOR_ARRAY_BLOCK_SAMPLES);
+    const size_t size = block_samples * sizeof(float);
+    const int n_vectors = n_correlators + n_data_correlators;
+
+    d_local_codes_resampled = static_cast<float**>(volk_gnsssdr_malloc(n_vectors * sizeof(float*), volk_gnsssdr_get_alignment()));
+    for (int n = 0; n < n_vectors; n++)
+        {
+            d_local_codes_resampled[n] = static_cast<float*>(volk_gnsssdr_malloc(size, volk_gnsssdr_get_alignment()));
+        }
+    d_carrier = volk_gnsssdr::vector<std::complex<float>>(block_samples);
+    d_corr_block = volk_gnsssdr::vector<float>(2 * n_vectors * n_elements);
+    d_n_correlators = n_correlators;
+    d_n_data_correlators = n_data_correlators;
+    d_n_elements = n_elements;
+    return true;
+}
+
+
+bool Cpu_Multicorrelator_Array::set_local_code_and_taps(
+    int code_length_chips,
+    const float* local_code_in,
+    float* shifts_chips)
+{
+    d_local_code_in = local_code_in;
+    d_shifts_chips = shifts_chips;
+    d_code_length_chips = code_length_chips;
+    return true;
+}
+
+
+bool Cpu_Multicorrelator_Array::set_data_local_code_and_taps(
+    int code_length_chips,
+    const float* local_code_in,
+    float* shifts_chips)
+{
+    d_data_local_code_in = local_code_in;
+    d_data_shifts_chips = shifts_chips;
+    d_data_code_length_chips = code_length_chips;
+    return true;
+}
+
+
+bool Cpu_Multicorrelator_Array::set_input_output_vectors(std::complex<float>* corr_out, const std::complex<float>* sig_in)
+{
+    // Save CPU pointers
+    d_sig_in = sig_in;
+    d_corr_out = corr_out;
+    return true;
+}
+
+
+bool Cpu_Multicorrelator_Array::set_data_output_vector(std::complex<float>* corr_data_out)
+{
+    d_corr_data_out = corr_data_out;
+    return true;
+}
+
+
+void Cpu_Multicorrelator_Array::update_local_code(int correlator_length_samples, float rem_code_phase_chips, float code_phase_step_chips)
+{
+    volk_gnsssdr_32f_xn_resampler_32f_xn(d_local_codes_resampled,
+        d_local_code_in,
+        rem_code_phase_chips,
+        code_phase_step_chips,
+        d_shifts_chips,
+        d_code_length_chips,
+        d_n_correlators,
+        correlator_length_samples);
+    if (d_n_data_correlators > 0)
+        {
+            volk_gnsssdr_32f_xn_resampler_32f_xn(d_local_codes_resampled + d_n_correlators,
+                d_data_local_code_in,
+                rem_code_phase_chips,
+                code_phase_step_chips,
+                d_data_shifts_chips,
+                d_data_code_length_chips,
+                d_n_data_correlators,
+                correlator_length_samples);
+        }
+}
+
+
+void Cpu_Multicorrelator_Array::update_carrier(int num_samples, double phase_rad, double phase_step_rad)
+{
+    // the carrier is wiped off by rotating the samples by the opposite of its phase
+    std::complex<double> phase(std::cos(phase_rad), -std::sin(phase_rad));
+    const std::complex<double> phase_inc(std::cos(phase_step_rad), -std::sin(phase_step_rad));
+    for (int n = 0; n < num_samples; n++)
+        {
+            d_carrier[n] = std::complex<float>(phase);
+            phase *= phase_inc;
+        }
+}
+
+
+bool Cpu_Multicorrelator_Array::Carrier_wipeoff_multicorrelator_resampler(
+    float rem_carrier_phase_in_rad,
+    float phase_step_rad,
+    float phase_rate_step_rad,
+    float rem_code_phase_chips,
+    float code_phase_step_chips,
+    float code_phase_rate_step_chips,
+    int signal_length_samples)
+{
+    const int n_vectors = d_n_correlators + d_n_data_correlators;
+    const int n_elements = d_n_elements;
+    const float* const* local_codes = d_local_codes_resampled;
+    float* corr = d_corr_block.data();
+
+    for (int first_sample = 0; first_sample < signal_length_samples; first_sample += MULTICORRELATOR_ARRAY_BLOCK_SAMPLES)
+        {
+            const int num_samples = std::min(MULTICORRELATOR_ARRAY_BLOCK_SAMPLES, signal_length_samples - first_sample);
+            const auto n = static_cast<double>(first_sample);
+
+            // local codes at the first sample of the block
+            const double block_code_phase_chips = static_cast<double>(code_phase_step_chips) * n + static_cast<double>(code_phase_rate_step_chips) * n * n;
+            const auto block_rem_code_phase_chips = static_cast<float>(std::fmod(static_cast<double>(rem_code_phase_chips) - block_code_phase_chips, static_cast<double>(d_code_length_chips)));
+            const auto block_code_phase_step_chips = static_cast<float>(static_cast<double>(code_phase_step_chips) + 2.0 * static_cast<double>(code_phase_rate_step_chips) * n);
+            update_local_code(num_samples, block_rem_code_phase_chips, block_code_phase_step_chips);
+
+            // carrier at the first sample of the block
+            const double block_carrier_phase_rad = std::fmod(static_cast<double>(rem_carrier_phase_in_rad) + static_cast<double>(phase_step_rad) * n + static_cast<double>(phase_rate_step_rad) * n * n, TWO_PI);
+            update_carrier(num_samples, block_carrier_phase_rad, static_cast<double>(phase_step_rad) + 2.0 * static_cast<double>(phase_rate_step_rad) * n);
+
+            // one pass over the samples of all the elements, each one wiped
+            // off once and correlated with all the local codes
+            std::fill(d_corr_block.begin(), d_corr_block.end(), 0.0F);
+            const std::complex<float>* in = d_sig_in + static_cast<size_t>(first_sample) * n_elements;
+            for (int s = 0; s < num_samples; s++)
+                {
+                    const float carrier_re = d_carrier[s].real();
+                    const float carrier_im = d_carrier[s].imag();
+                    for (int e = 0; e < n_elements; e++)
+                        {
+                            const float in_re = in[e].real();
+                            const float in_im = in[e].imag();
+                            const float wiped_re = in_re * carrier_re - in_im * carrier_im;
+                            const float wiped_im = in_re * carrier_im + in_im * carrier_re;
+                            float* element_corr = corr + 2 * n_vectors * e;
+                            for (int k = 0; k < n_vectors; k++)
+                                {
+                                    const float code = local_codes[k][s];
+                                    element_corr[2 * k] += wiped_re * code;
+                                    element_corr[2 * k + 1] += wiped_im * code;
+                                }
+                        }
+                    in += n_elements;
+                }
+
+            for (int e = 0; e < n_elements; e++)
+                {
+                    const float* element_corr = corr + 2 * n_vectors * e;
+                    for (int k = 0; k < d_n_correlators; k++)
+                        {
+                            std::complex<float>& out = d_corr_out[e * d_n_correlators + k];
+                            out = (first_sample == 0 ? std::complex<float>(0.0, 0.0) : out) + std::complex<float>(element_corr[2 * k], element_corr[2 * k + 1]);
+                        }
+                    for (int k = 0; k < d_n_data_correlators; k++)
+                        {
+                            const int v = d_n_correlators + k;
+                            std::complex<float>& out = d_corr_data_out[e * d_n_data_correlators + k];
+                            out = (first_sample == 0 ? std::complex<float>(0.0, 0.0) : out) + std::complex<float>(element_corr[2 * v], element_corr[2 * v + 1]);
+                        }
+                }
+        }
+    return true;
+}
+
+
+bool Cpu_Multicorrelator_Array::free()
+{
+    // Free memory
+    if (d_local_codes_resampled != nullptr)
+        {
+            for (int n = 0; n < d_n_correlators + d_n_data_correlators; n++)
+                {
+                    volk_gnsssdr_free(d_local_codes_resampled[n]);
+                }
+            volk_gnsssdr_free(d_local_codes_resampled);
+            d_local_codes_resampled = nullptr;
+        }
+    return true;
+}
@@ -0,0 +1,88 @@
+/*!
+ * \file cpu_multicorrelator_array.h
+ * \brief Carrier wipe-off and correlators of the elements of an antenna
+ * array, in one pass over their interleaved samples
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_CPU_MULTICORRELATOR_ARRAY_H
+#define GNSS_SDR_CPU_MULTICORRELATOR_ARRAY_H
+
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <complex>
+
+/** \addtogroup Tracking
+ * \{ */
+/** \addtogroup Tracking_libs
+ * \{ */
+
+
+/*!
+ * \brief Class that implements carrier wipe-off and correlators of the
+ * samples of the n_elements elements of an antenna array, interleaved as
+ * in a stream of vectors of n_elements samples (sample n of element e at
+ * sig_in[n * n_elements + e]).
+ *
+ * The elements share the local code replicas, resampled once, and the
+ * carrier replica, generated once, so an array channel costs the carrier
+ * wipe-off and the correlation of the elements, but not n_elements times
+ * the resampling of the local codes. The correlations of element e are
+ * written to corr_out[e * n_correlators, (e + 1) * n_correlators), and the
+ * data ones to corr_data_out[e * n_data_correlators, ...), as the ones of
+ * Cpu_Multicorrelator_Real_Codes for a single element.
+ *
+ * The carrier and code phase rates are applied between blocks of 4096
+ * samples.
+ */
+class Cpu_Multicorrelator_Array
+{
+public:
+    Cpu_Multicorrelator_Array() = default;
+    ~Cpu_Multicorrelator_Array();
+    bool init(int max_signal_length_samples, int n_correlators, int n_elements, int n_data_correlators = 0);
+    bool set_local_code_and_taps(int code_length_chips, const float *local_code_in, float *shifts_chips);
+    bool set_data_local_code_and_taps(int code_length_chips, const float *local_code_in, float *shifts_chips);
+    bool set_input_output_vectors(std::complex<float> *corr_out, const std::complex<float> *sig_in);
+    bool set_data_output_vector(std::complex<float> *corr_data_out);
+    bool Carrier_wipeoff_multicorrelator_resampler(float rem_carrier_phase_in_rad, float phase_step_rad, float phase_rate_step_rad, float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips, int signal_length_samples);
+    bool free();
+
+    inline int n_elements() const
+    {
+        return d_n_elements;
+    }
+
+private:
+    void update_local_code(int correlator_length_samples, float rem_code_phase_chips, float code_phase_step_chips);
+    void update_carrier(int num_samples, double phase_rad, double phase_step_rad);
+
+    volk_gnsssdr::vector<std::complex<float>> d_carrier;
+    volk_gnsssdr::vector<float> d_corr_block;  // real and imaginary parts of the correlations of a block
+    const std::complex<float> *d_sig_in{nullptr};
+    const float *d_local_code_in{nullptr};
+    const float *d_data_local_code_in{nullptr};
+    std::complex<float> *d_corr_out{nullptr};
+    std::complex<float> *d_corr_data_out{nullptr};
+    float **d_local_codes_resampled{nullptr};
+    float *d_shifts_chips{nullptr};
+    float *d_data_shifts_chips{nullptr};
+    int d_code_length_chips{0};
+    int d_data_code_length_chips{0};
+    int d_n_correlators{0};
+    int d_n_data_correlators{0};
+    int d_n_elements{0};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_CPU_MULTICORRELATOR_ARRAY_H
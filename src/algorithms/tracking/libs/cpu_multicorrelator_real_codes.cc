@@ -20,8 +20,11 @@
  */
 
 #include "cpu_multicorrelator_real_codes.h"
+#include "MATH_CONSTANTS.h"
 #include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>
 #include <cmath>
+#include <cstdlib>
 
 
 Cpu_Multicorrelator_Real_Codes::~Cpu_Multicorrelator_Real_Codes()
@@ -35,21 +38,76 @@ Cpu_Multicorrelator_Real_Codes::~Cpu_Multicorrelator_Real_Codes()
 
 bool Cpu_Multicorrelator_Real_Codes::init(
     int max_signal_length_samples,
-    int n_correlators)
+    int n_correlators,
+    int n_data_correlators)
 {
     // ALLOCATE MEMORY FOR INTERNAL vectors
     size_t size = max_signal_length_samples * sizeof(float);
+    const int n_vectors = n_correlators + n_data_correlators;
 
-    d_local_codes_resampled = static_cast<float**>(volk_gnsssdr_malloc(n_correlators * sizeof(float*), volk_gnsssdr_get_alignment()));
-    for (int n = 0; n < n_correlators; n++)
+    d_local_codes_resampled = static_cast<float**>(volk_gnsssdr_malloc(n_vectors * sizeof(float*), volk_gnsssdr_get_alignment()));
+    for (int n = 0; n < n_vectors; n++)
         {
             d_local_codes_resampled[n] = static_cast<float*>(volk_gnsssdr_malloc(size, volk_gnsssdr_get_alignment()));
         }
+    d_local_codes = static_cast<const float**>(volk_gnsssdr_malloc(n_vectors * sizeof(float*), volk_gnsssdr_get_alignment()));
+    d_local_codes_segment = static_cast<const float**>(volk_gnsssdr_malloc(n_vectors * sizeof(float*), volk_gnsssdr_get_alignment()));
+    d_corr_buffer = static_cast<std::complex<float>*>(volk_gnsssdr_malloc(n_vectors * sizeof(std::complex<float>), volk_gnsssdr_get_alignment()));
     d_n_correlators = n_correlators;
+    d_n_data_correlators = n_data_correlators;
+    d_max_signal_length_samples = max_signal_length_samples;
+    resolve_kernels();
     return true;
 }
 
 
+void Cpu_Multicorrelator_Real_Codes::resolve_kernels()
+{
+    // The implementations for aligned buffers (a_ prefix) are not given for unaligned samples
+    const char* rotator_impl_u = d_rotator_impl.compare(0, 2, "a_") == 0 ? "" : d_rotator_impl.c_str();
+    d_rotator_dot_prod_a = volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn_get_impl(d_rotator_impl.c_str(), true);
+    d_rotator_dot_prod_u = volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn_get_impl(rotator_impl_u, false);
+    if (d_use_high_dynamics_resampler)
+        {
+            d_high_dynamic_rotator_dot_prod_a = volk_gnsssdr_32fc_32f_high_dynamic_rotator_dot_prod_32fc_xn_get_impl(d_rotator_impl.c_str(), true);
+            d_high_dynamic_rotator_dot_prod_u = volk_gnsssdr_32fc_32f_high_dynamic_rotator_dot_prod_32fc_xn_get_impl(rotator_impl_u, false);
+            d_high_dynamics_resampler = volk_gnsssdr_32f_xn_high_dynamics_resampler_32f_xn_get_impl(d_resampler_impl.c_str(), true);
+        }
+    else
+        {
+            d_resampler = volk_gnsssdr_32f_xn_resampler_32f_xn_get_impl(d_resampler_impl.c_str(), true);
+        }
+}
+
+
+void Cpu_Multicorrelator_Real_Codes::rotator_dot_prod(bool high_dynamics,
+    std::complex<float>* corr,
+    const std::complex<float>* sig_in,
+    float phase_step_rad,
+    float phase_rate_step_rad,
+    lv_32fc_t* phase,
+    const float** local_codes,
+    int n_vectors,
+    int num_samples) const
+{
+    // The kernels read the samples and the local codes, which can be cached replicas or segments, with aligned loads
+    const void* pointers = sig_in;
+    for (int k = 0; k < n_vectors; k++)
+        {
+            pointers = VOLK_OR_PTR(pointers, local_codes[k]);
+        }
+    const bool aligned = volk_gnsssdr_is_aligned(pointers);
+    if (high_dynamics)
+        {
+            (aligned ? d_high_dynamic_rotator_dot_prod_a : d_high_dynamic_rotator_dot_prod_u)(corr, sig_in, std::exp(lv_32fc_t(0.0, -phase_step_rad)), std::exp(lv_32fc_t(0.0, -phase_rate_step_rad)), phase, local_codes, n_vectors, num_samples);
+        }
+    else
+        {
+            (aligned ? d_rotator_dot_prod_a : d_rotator_dot_prod_u)(corr, sig_in, std::exp(lv_32fc_t(0.0, -phase_step_rad)), phase, local_codes, n_vectors, num_samples);
+        }
+}
+
+
 bool Cpu_Multicorrelator_Real_Codes::set_local_code_and_taps(
     int code_length_chips,
     const float* local_code_in,
@@ -58,6 +116,21 @@ bool Cpu_Multicorrelator_Real_Codes::set_local_code_and_taps(
     d_local_code_in = local_code_in;
     d_shifts_chips = shifts_chips;
     d_code_length_chips = code_length_chips;
+    d_code_replicas.reset();
+
+    return true;
+}
+
+
+bool Cpu_Multicorrelator_Real_Codes::set_data_local_code_and_taps(
+    int code_length_chips,
+    const float* local_code_in,
+    float* shifts_chips)
+{
+    d_data_local_code_in = local_code_in;
+    d_data_shifts_chips = shifts_chips;
+    d_data_code_length_chips = code_length_chips;
+    d_data_code_replicas.reset();
 
     return true;
 }
@@ -72,11 +145,72 @@ bool Cpu_Multicorrelator_Real_Codes::set_input_output_vectors(std::complex<float
 }
 
 
+bool Cpu_Multicorrelator_Real_Codes::set_data_output_vector(std::complex<float>* corr_data_out)
+{
+    d_corr_data_out = corr_data_out;
+    return true;
+}
+
+
+bool Cpu_Multicorrelator_Real_Codes::use_code_replicas(std::shared_ptr<const Code_Replica_Cache>& replicas,
+    const float* local_code,
+    int code_length_chips,
+    const float* shifts_chips,
+    int n_correlators,
+    const float** local_codes,
+    float rem_code_phase_chips,
+    float code_phase_step_chips,
+    float code_phase_rate_step_chips,
+    int correlator_length_samples) const
+{
+    if (replicas == nullptr or !replicas->fits(code_phase_step_chips, code_phase_rate_step_chips, correlator_length_samples))
+        {
+            // do not compute tables that would not fit the code phase rate
+            const auto n = static_cast<float>(correlator_length_samples);
+            if (std::abs(code_phase_rate_step_chips) * n * n > 0.25F / static_cast<float>(d_code_replica_phases_per_chip))
+                {
+                    return false;
+                }
+            // the table covers the code phases of the taps for any remnant code phase in [0, 1) chips
+            const auto shifts = std::minmax_element(shifts_chips, shifts_chips + n_correlators);
+            replicas = Code_Replica_Cache::get(local_code, code_length_chips, code_phase_step_chips,
+                static_cast<int>(std::floor(*shifts.first)) - 1, static_cast<int>(std::ceil(*shifts.second)) + 1,
+                d_code_replica_phases_per_chip, correlator_length_samples);
+            if (!replicas->fits(code_phase_step_chips, code_phase_rate_step_chips, correlator_length_samples))
+                {
+                    return false;
+                }
+        }
+    for (int k = 0; k < n_correlators; k++)
+        {
+            local_codes[k] = replicas->replica(shifts_chips[k] - rem_code_phase_chips);
+            if (local_codes[k] == nullptr)
+                {
+                    return false;
+                }
+        }
+    return true;
+}
+
+
 void Cpu_Multicorrelator_Real_Codes::update_local_code(int correlator_length_samples, float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips)
 {
+    if (d_code_replica_phases_per_chip > 0 and
+        use_code_replicas(d_code_replicas, d_local_code_in, d_code_length_chips, d_shifts_chips, d_n_correlators, d_local_codes,
+            rem_code_phase_chips, code_phase_step_chips, code_phase_rate_step_chips, correlator_length_samples) and
+        (d_n_data_correlators == 0 or use_code_replicas(d_data_code_replicas, d_data_local_code_in, d_data_code_length_chips, d_data_shifts_chips, d_n_data_correlators, d_local_codes + d_n_correlators,
+                                          rem_code_phase_chips, code_phase_step_chips, code_phase_rate_step_chips, correlator_length_samples)))
+        {
+            // correlate with the cached replicas
+            return;
+        }
+    for (int k = 0; k < d_n_correlators + d_n_data_correlators; k++)
+        {
+            d_local_codes[k] = d_local_codes_resampled[k];
+        }
     if (d_use_high_dynamics_resampler)
         {
-            volk_gnsssdr_32f_xn_high_dynamics_resampler_32f_xn(d_local_codes_resampled,
+            d_high_dynamics_resampler(d_local_codes_resampled,
                 d_local_code_in,
                 rem_code_phase_chips,
                 code_phase_step_chips,
@@ -85,10 +219,22 @@ void Cpu_Multicorrelator_Real_Codes::update_local_code(int correlator_length_sam
                 d_code_length_chips,
                 d_n_correlators,
                 correlator_length_samples);
+            if (d_n_data_correlators > 0)
+                {
+                    d_high_dynamics_resampler(d_local_codes_resampled + d_n_correlators,
+                        d_data_local_code_in,
+                        rem_code_phase_chips,
+                        code_phase_step_chips,
+                        code_phase_rate_step_chips,
+                        d_data_shifts_chips,
+                        d_data_code_length_chips,
+                        d_n_data_correlators,
+                        correlator_length_samples);
+                }
         }
     else
         {
-            volk_gnsssdr_32f_xn_resampler_32f_xn(d_local_codes_resampled,
+            d_resampler(d_local_codes_resampled,
                 d_local_code_in,
                 rem_code_phase_chips,
                 code_phase_step_chips,
@@ -96,11 +242,35 @@ void Cpu_Multicorrelator_Real_Codes::update_local_code(int correlator_length_sam
                 d_code_length_chips,
                 d_n_correlators,
                 correlator_length_samples);
+            if (d_n_data_correlators > 0)
+                {
+                    d_resampler(d_local_codes_resampled + d_n_correlators,
+                        d_data_local_code_in,
+                        rem_code_phase_chips,
+                        code_phase_step_chips,
+                        d_data_shifts_chips,
+                        d_data_code_length_chips,
+                        d_n_data_correlators,
+                        correlator_length_samples);
+                }
         }
 }
 
 
-bool Cpu_Multicorrelator_Real_Codes::Carrier_wipeoff_multicorrelator_resampler(
+void Cpu_Multicorrelator_Real_Codes::write_correlator_outputs(const std::complex<float>* corr, bool accumulate)
+{
+    for (int k = 0; k < d_n_correlators; k++)
+        {
+            d_corr_out[k] = accumulate ? d_corr_out[k] + corr[k] : corr[k];
+        }
+    for (int k = 0; k < d_n_data_correlators; k++)
+        {
+            d_corr_data_out[k] = accumulate ? d_corr_data_out[k] + corr[d_n_correlators + k] : corr[d_n_correlators + k];
+        }
+}
+
+
+void Cpu_Multicorrelator_Real_Codes::correlate(bool high_dynamics,
     float rem_carrier_phase_in_rad,
     float phase_step_rad,
     float phase_rate_step_rad,
@@ -113,15 +283,38 @@ bool Cpu_Multicorrelator_Real_Codes::Carrier_wipeoff_multicorrelator_resampler(
     // Regenerate phase at each call in order to avoid numerical issues
     lv_32fc_t phase_offset_as_complex[1];
     phase_offset_as_complex[0] = lv_cmake(std::cos(rem_carrier_phase_in_rad), -std::sin(rem_carrier_phase_in_rad));
-    // call VOLK_GNSSSDR kernel
-    if (d_use_high_dynamics_resampler)
+    if (d_sqm_requested and signal_length_samples <= d_max_signal_length_samples)
         {
-            volk_gnsssdr_32fc_32f_high_dynamic_rotator_dot_prod_32fc_xn(d_corr_out, d_sig_in, std::exp(lv_32fc_t(0.0, -phase_step_rad)), std::exp(lv_32fc_t(0.0, -phase_rate_step_rad)), phase_offset_as_complex, const_cast<const float**>(d_local_codes_resampled), d_n_correlators, signal_length_samples);
+            // The SQM correlators share the carrier wipe-off of the others
+            const int n_vectors = add_sqm_codes(rem_code_phase_chips, code_phase_step_chips, code_phase_rate_step_chips, signal_length_samples);
+            rotator_dot_prod(high_dynamics, d_sqm_corr, d_sig_in, phase_step_rad, phase_rate_step_rad, phase_offset_as_complex, d_sqm_codes, n_vectors, signal_length_samples);
+            write_correlator_outputs(d_sqm_corr, false);
+            std::copy(d_sqm_corr + n_vectors - d_n_sqm, d_sqm_corr + n_vectors, d_sqm_out);
+            d_sqm_requested = false;
+            d_sqm_done = true;
+            return;
         }
-    else
+    // The pilot and data correlators share the carrier wipe-off
+    std::complex<float>* corr_out = d_n_data_correlators > 0 ? d_corr_buffer : d_corr_out;
+    // call VOLK_GNSSSDR kernel
+    rotator_dot_prod(high_dynamics, corr_out, d_sig_in, phase_step_rad, phase_rate_step_rad, phase_offset_as_complex, d_local_codes, d_n_correlators + d_n_data_correlators, signal_length_samples);
+    if (d_n_data_correlators > 0)
         {
-            volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn(d_corr_out, d_sig_in, std::exp(lv_32fc_t(0.0, -phase_step_rad)), phase_offset_as_complex, const_cast<const float**>(d_local_codes_resampled), d_n_correlators, signal_length_samples);
+            write_correlator_outputs(d_corr_buffer, false);
         }
+}
+
+
+bool Cpu_Multicorrelator_Real_Codes::Carrier_wipeoff_multicorrelator_resampler(
+    float rem_carrier_phase_in_rad,
+    float phase_step_rad,
+    float phase_rate_step_rad,
+    float rem_code_phase_chips,
+    float code_phase_step_chips,
+    float code_phase_rate_step_chips,
+    int signal_length_samples)
+{
+    correlate(d_use_high_dynamics_resampler, rem_carrier_phase_in_rad, phase_step_rad, phase_rate_step_rad, rem_code_phase_chips, code_phase_step_chips, code_phase_rate_step_chips, signal_length_samples);
     return true;
 }
 
@@ -134,12 +327,32 @@ bool Cpu_Multicorrelator_Real_Codes::Carrier_wipeoff_multicorrelator_resampler(
     float code_phase_rate_step_chips,
     int signal_length_samples)
 {
-    update_local_code(signal_length_samples, rem_code_phase_chips, code_phase_step_chips, code_phase_rate_step_chips);
-    // Regenerate phase at each call in order to avoid numerical issues
+    correlate(false, rem_carrier_phase_in_rad, phase_step_rad, 0.0, rem_code_phase_chips, code_phase_step_chips, code_phase_rate_step_chips, signal_length_samples);
+    return true;
+}
+
+
+bool Cpu_Multicorrelator_Real_Codes::Carrier_wipeoff_multicorrelator_segment(
+    float rem_carrier_phase_in_rad,
+    float phase_step_rad,
+    float phase_rate_step_rad,
+    int first_sample,
+    int num_samples)
+{
+    // Carrier phase and phase step at the first sample of the segment
+    const auto n = static_cast<double>(first_sample);
+    const double segment_phase_rad = std::fmod(static_cast<double>(rem_carrier_phase_in_rad) + static_cast<double>(phase_step_rad) * n + static_cast<double>(phase_rate_step_rad) * n * n, TWO_PI);
+    const auto segment_phase_step_rad = static_cast<float>(static_cast<double>(phase_step_rad) + 2.0 * static_cast<double>(phase_rate_step_rad) * n);
     lv_32fc_t phase_offset_as_complex[1];
-    phase_offset_as_complex[0] = lv_cmake(std::cos(rem_carrier_phase_in_rad), -std::sin(rem_carrier_phase_in_rad));
+    phase_offset_as_complex[0] = lv_cmake(static_cast<float>(std::cos(segment_phase_rad)), static_cast<float>(-std::sin(segment_phase_rad)));
+    const int n_vectors = d_n_correlators + d_n_data_correlators;
+    for (int k = 0; k < n_vectors; k++)
+        {
+            d_local_codes_segment[k] = d_local_codes[k] + first_sample;
+        }
     // call VOLK_GNSSSDR kernel
-    volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn(d_corr_out, d_sig_in, std::exp(lv_32fc_t(0.0, -phase_step_rad)), phase_offset_as_complex, const_cast<const float**>(d_local_codes_resampled), d_n_correlators, signal_length_samples);
+    rotator_dot_prod(d_use_high_dynamics_resampler, d_corr_buffer, d_sig_in + first_sample, segment_phase_step_rad, phase_rate_step_rad, phase_offset_as_complex, d_local_codes_segment, n_vectors, num_samples);
+    write_correlator_outputs(d_corr_buffer, first_sample != 0);
     return true;
 }
 
@@ -149,13 +362,22 @@ bool Cpu_Multicorrelator_Real_Codes::free()
     // Free memory
     if (d_local_codes_resampled != nullptr)
         {
-            for (int n = 0; n < d_n_correlators; n++)
+            for (int n = 0; n < d_n_correlators + d_n_data_correlators; n++)
                 {
                     volk_gnsssdr_free(d_local_codes_resampled[n]);
                 }
             volk_gnsssdr_free(d_local_codes_resampled);
             d_local_codes_resampled = nullptr;
+            volk_gnsssdr_free(d_local_codes);
+            d_local_codes = nullptr;
+            volk_gnsssdr_free(d_local_codes_segment);
+            d_local_codes_segment = nullptr;
+            volk_gnsssdr_free(d_corr_buffer);
+            d_corr_buffer = nullptr;
         }
+    free_sqm();
+    d_code_replicas.reset();
+    d_data_code_replicas.reset();
     return true;
 }
 
@@ -164,4 +386,98 @@ void Cpu_Multicorrelator_Real_Codes::set_high_dynamics_resampler(
     bool use_high_dynamics_resampler)
 {
     d_use_high_dynamics_resampler = use_high_dynamics_resampler;
+    resolve_kernels();
+}
+
+
+void Cpu_Multicorrelator_Real_Codes::set_kernel_implementations(const std::string& rotator_impl, const std::string& resampler_impl)
+{
+    d_rotator_impl = rotator_impl;
+    d_resampler_impl = resampler_impl;
+    resolve_kernels();
+}
+
+
+void Cpu_Multicorrelator_Real_Codes::set_code_replica_cache(int phases_per_chip)
+{
+    d_code_replica_phases_per_chip = phases_per_chip;
+}
+
+
+bool Cpu_Multicorrelator_Real_Codes::set_sqm_taps(int n_sqm, const int* sqm_shifts_samples, std::complex<float>* sqm_out)
+{
+    free_sqm();
+    if (n_sqm <= 0)
+        {
+            return true;
+        }
+    d_sqm_shifts_samples.assign(sqm_shifts_samples, sqm_shifts_samples + n_sqm);
+    for (const int shift : d_sqm_shifts_samples)
+        {
+            d_sqm_max_shift = std::max(d_sqm_max_shift, std::abs(shift));
+        }
+    const int n_vectors = d_n_correlators + d_n_data_correlators + n_sqm;
+    d_sqm_code = static_cast<float*>(volk_gnsssdr_malloc((d_max_signal_length_samples + 2 * d_sqm_max_shift) * sizeof(float), volk_gnsssdr_get_alignment()));
+    d_sqm_codes = static_cast<const float**>(volk_gnsssdr_malloc(n_vectors * sizeof(float*), volk_gnsssdr_get_alignment()));
+    d_sqm_corr = static_cast<std::complex<float>*>(volk_gnsssdr_malloc(n_vectors * sizeof(std::complex<float>), volk_gnsssdr_get_alignment()));
+    d_sqm_out = sqm_out;
+    d_n_sqm = n_sqm;
+    return true;
+}
+
+
+void Cpu_Multicorrelator_Real_Codes::request_sqm()
+{
+    d_sqm_requested = d_n_sqm > 0;
+}
+
+
+bool Cpu_Multicorrelator_Real_Codes::take_sqm()
+{
+    const bool done = d_sqm_done;
+    d_sqm_done = false;
+    return done;
+}
+
+
+int Cpu_Multicorrelator_Real_Codes::add_sqm_codes(float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips, int correlator_length_samples)
+{
+    // prompt local code from d_sqm_max_shift samples before the first sample of the integration
+    float shift_chips = -static_cast<float>(d_sqm_max_shift) * code_phase_step_chips;
+    const int length = correlator_length_samples + 2 * d_sqm_max_shift;
+    if (d_use_high_dynamics_resampler)
+        {
+            d_high_dynamics_resampler(&d_sqm_code, d_local_code_in, rem_code_phase_chips, code_phase_step_chips, code_phase_rate_step_chips, &shift_chips, d_code_length_chips, 1, length);
+        }
+    else
+        {
+            d_resampler(&d_sqm_code, d_local_code_in, rem_code_phase_chips, code_phase_step_chips, &shift_chips, d_code_length_chips, 1, length);
+        }
+    const int n_vectors = d_n_correlators + d_n_data_correlators;
+    std::copy(d_local_codes, d_local_codes + n_vectors, d_sqm_codes);
+    for (int k = 0; k < d_n_sqm; k++)
+        {
+            // a tap delayed by s samples reads the prompt local code from sample s
+            d_sqm_codes[n_vectors + k] = d_sqm_code + d_sqm_max_shift + d_sqm_shifts_samples[k];
+        }
+    return n_vectors + d_n_sqm;
+}
+
+
+void Cpu_Multicorrelator_Real_Codes::free_sqm()
+{
+    if (d_sqm_code != nullptr)
+        {
+            volk_gnsssdr_free(d_sqm_code);
+            d_sqm_code = nullptr;
+            volk_gnsssdr_free(d_sqm_codes);
+            d_sqm_codes = nullptr;
+            volk_gnsssdr_free(d_sqm_corr);
+            d_sqm_corr = nullptr;
+        }
+    d_sqm_shifts_samples.clear();
+    d_n_sqm = 0;
+    d_sqm_max_shift = 0;
+    d_sqm_requested = false;
+    d_sqm_done = false;
 }
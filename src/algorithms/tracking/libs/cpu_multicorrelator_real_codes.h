@@ -23,7 +23,12 @@
 #define GNSS_SDR_CPU_MULTICORRELATOR_REAL_CODES_H
 
 
+#include "code_replica_cache.h"
+#include <volk_gnsssdr/volk_gnsssdr.h>
 #include <complex>
+#include <memory>
+#include <string>
+#include <vector>
 
 /** \addtogroup Tracking
  * \{ */
@@ -40,23 +45,130 @@ public:
     Cpu_Multicorrelator_Real_Codes() = default;
     void set_high_dynamics_resampler(bool use_high_dynamics_resampler);
     ~Cpu_Multicorrelator_Real_Codes();
-    bool init(int max_signal_length_samples, int n_correlators);
+    bool init(int max_signal_length_samples, int n_correlators, int n_data_correlators = 0);
     bool set_local_code_and_taps(int code_length_chips, const float *local_code_in, float *shifts_chips);
     bool set_input_output_vectors(std::complex<float> *corr_out, const std::complex<float> *sig_in);
+
+    /*!
+     * \brief Sets the local code and taps of the data component, for correlators
+     * initialized with n_data_correlators > 0. The input is rotated once and
+     * correlated with both the pilot and the data local codes, and the data
+     * correlations are written to corr_data_out.
+     */
+    bool set_data_local_code_and_taps(int code_length_chips, const float *local_code_in, float *shifts_chips);
+    bool set_data_output_vector(std::complex<float> *corr_data_out);
+
+    /*!
+     * \brief Enables the correlation with local code replicas pre-sampled at
+     * code phases spaced 1 / phases_per_chip chips (see Code_Replica_Cache),
+     * instead of resampling the local codes at each integration period.
+     * The code phase error of the replicas is below 1 / phases_per_chip
+     * chips. The local codes are resampled as usual when no replica of the
+     * table is close enough to the requested code phases. A value of 0
+     * disables the cached replicas.
+     */
+    void set_code_replica_cache(int phases_per_chip);
+
+    /*!
+     * \brief Sets n_sqm signal quality monitoring (SQM) correlators, whose
+     * local codes are the prompt one (without code phase shift) delayed by
+     * sqm_shifts_samples[k] samples (negative for the early ones), and whose
+     * outputs are written to sqm_out.
+     *
+     * The SQM correlators are computed only in the integrations requested
+     * with request_sqm(), in the same carrier wipe-off and dot product pass
+     * as the other correlators. Their local codes are all read from a single
+     * resampled prompt local code, extended by the largest shift at both
+     * ends, so that a tap costs a dot product but no resampling. The shifts
+     * are integer numbers of samples, so they are quantized to the sample
+     * period.
+     */
+    bool set_sqm_taps(int n_sqm, const int *sqm_shifts_samples, std::complex<float> *sqm_out);
+
+    //! The next call to Carrier_wipeoff_multicorrelator_resampler() also computes the SQM correlators
+    void request_sqm();
+
+    //! Returns true if the SQM correlators requested have been computed, and clears the request
+    bool take_sqm();
+
+    /*!
+     * \brief Selects the VOLK_GNSSSDR implementations (for instance, u_avx2)
+     * of the carrier wipe-off and correlation kernels and of the local code
+     * resamplers. An empty name, or one that is not available in this
+     * machine, selects the fastest implementation (see volk_gnsssdr_profile).
+     *
+     * The implementations are resolved once, and not at each call by the
+     * VOLK_GNSSSDR dispatcher. The resampled local codes are always aligned,
+     * so the resamplers for aligned buffers are used. The correlators use
+     * the implementation for aligned buffers whenever the input samples are
+     * aligned.
+     */
+    void set_kernel_implementations(const std::string &rotator_impl, const std::string &resampler_impl);
     void update_local_code(int correlator_length_samples, float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips = 0.0);
     bool Carrier_wipeoff_multicorrelator_resampler(float rem_carrier_phase_in_rad, float phase_step_rad, float phase_rate_step_rad, float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips, int signal_length_samples);
     bool Carrier_wipeoff_multicorrelator_resampler(float rem_carrier_phase_in_rad, float phase_step_rad, float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips, int signal_length_samples);
+
+    /*!
+     * \brief Carrier wipe-off and correlation of the input samples [first_sample, first_sample + num_samples)
+     * with the local codes resampled by the last call to update_local_code().
+     * The carrier phase is the one of the whole correlation at first_sample.
+     * The results are written to the output vector if first_sample is 0,
+     * and are added to it otherwise, so that a correlation can be computed by segments.
+     */
+    bool Carrier_wipeoff_multicorrelator_segment(float rem_carrier_phase_in_rad, float phase_step_rad, float phase_rate_step_rad, int first_sample, int num_samples);
     bool free();
 
 private:
+    void write_correlator_outputs(const std::complex<float> *corr, bool accumulate);
+    void correlate(bool high_dynamics, float rem_carrier_phase_in_rad, float phase_step_rad, float phase_rate_step_rad, float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips, int signal_length_samples);
+    int add_sqm_codes(float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips, int correlator_length_samples);
+    void free_sqm();
+    void resolve_kernels();
+    void rotator_dot_prod(bool high_dynamics, std::complex<float> *corr, const std::complex<float> *sig_in, float phase_step_rad, float phase_rate_step_rad, lv_32fc_t *phase, const float **local_codes, int n_vectors, int num_samples) const;
+    bool use_code_replicas(std::shared_ptr<const Code_Replica_Cache> &replicas, const float *local_code, int code_length_chips, const float *shifts_chips, int n_correlators, const float **local_codes, float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips, int correlator_length_samples) const;
+
+    std::shared_ptr<const Code_Replica_Cache> d_code_replicas;
+    std::shared_ptr<const Code_Replica_Cache> d_data_code_replicas;
+
+    // Kernel implementations, resolved by resolve_kernels()
+    std::string d_rotator_impl;
+    std::string d_resampler_impl;
+    p_32fc_32f_rotator_dot_prod_32fc_xn d_rotator_dot_prod_a{nullptr};
+    p_32fc_32f_rotator_dot_prod_32fc_xn d_rotator_dot_prod_u{nullptr};
+    p_32fc_32f_high_dynamic_rotator_dot_prod_32fc_xn d_high_dynamic_rotator_dot_prod_a{nullptr};
+    p_32fc_32f_high_dynamic_rotator_dot_prod_32fc_xn d_high_dynamic_rotator_dot_prod_u{nullptr};
+    p_32f_xn_resampler_32f_xn d_resampler{nullptr};
+    p_32f_xn_high_dynamics_resampler_32f_xn d_high_dynamics_resampler{nullptr};
+
     // Allocate the device input vectors
     const std::complex<float> *d_sig_in{nullptr};
     const float *d_local_code_in{nullptr};
+    const float *d_data_local_code_in{nullptr};
     std::complex<float> *d_corr_out{nullptr};
+    std::complex<float> *d_corr_data_out{nullptr};
     float **d_local_codes_resampled{nullptr};
+    const float **d_local_codes{nullptr};
+    const float **d_local_codes_segment{nullptr};
+    std::complex<float> *d_corr_buffer{nullptr};
     float *d_shifts_chips{nullptr};
+    float *d_data_shifts_chips{nullptr};
     int d_code_length_chips{0};
+    int d_data_code_length_chips{0};
     int d_n_correlators{0};
+    int d_n_data_correlators{0};
+    int d_code_replica_phases_per_chip{0};
+
+    // Signal quality monitoring correlators
+    std::complex<float> *d_sqm_out{nullptr};
+    float *d_sqm_code{nullptr};           // prompt local code, from d_sqm_max_shift samples before the integration to d_sqm_max_shift samples after it
+    const float **d_sqm_codes{nullptr};   // local codes of all the correlators, and then of the SQM ones
+    std::complex<float> *d_sqm_corr{nullptr};
+    std::vector<int> d_sqm_shifts_samples;
+    int d_n_sqm{0};
+    int d_sqm_max_shift{0};
+    int d_max_signal_length_samples{0};
+    bool d_sqm_requested{false};
+    bool d_sqm_done{false};
     bool d_use_high_dynamics_resampler{true};
 };
 
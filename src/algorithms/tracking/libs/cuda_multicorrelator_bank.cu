@@ -0,0 +1,488 @@
+/*!
+ * \file cuda_multicorrelator_bank.cu
+ * \brief CUDA GPU correlators of the tracking channels, computed for all the
+ * channels in a single kernel launch per integration period.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "cuda_multicorrelator_bank.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <map>
+
+namespace
+{
+// Threads per block, and samples correlated by each thread of a block
+constexpr int CUDA_BANK_THREADS_PER_BLOCK = 128;
+constexpr int CUDA_BANK_SAMPLES_PER_THREAD = 16;
+
+// Correlations of a channel, as read by the kernel
+struct Cuda_Correlation_Job
+{
+    const float *local_code;
+    const float *data_local_code;
+    int code_length_chips;
+    int data_code_length_chips;
+    int n_correlators;
+    int n_data_correlators;
+    int sig_offset;  // first sample of the channel in the input buffer
+    int corr_offset;  // first correlator of the channel in the output buffer
+    int signal_length_samples;
+    float shifts_chips[CUDA_MULTICORRELATOR_MAX_VECTORS];
+    float rem_carrier_phase_in_rad;
+    float phase_step_rad;
+    float phase_rate_step_rad;
+    float rem_code_phase_chips;
+    float code_phase_step_chips;
+    float code_phase_rate_step_chips;
+};
+
+
+bool cuda_check(cudaError_t code, const char *what)
+{
+    if (code != cudaSuccess)
+        {
+            std::cerr << "CUDA error in the correlator bank (" << what << "): " << cudaGetErrorString(code) << '\n';
+            return false;
+        }
+    return true;
+}
+
+
+// Each row of blocks of the grid computes the correlators of a channel.
+// Every thread wipes off the carrier of its samples once and correlates them
+// with all the local codes of the channel, and the partial sums of the block
+// are reduced in shared memory and added to the outputs.
+__global__ void cuda_bank_multicorrelator_kernel(
+    float2 *corr_out,
+    const float2 *sig_in,
+    const Cuda_Correlation_Job *jobs)
+{
+    __shared__ float2 partial_sums[CUDA_BANK_THREADS_PER_BLOCK];
+    const Cuda_Correlation_Job &job = jobs[blockIdx.y];
+    const int n_vectors = job.n_correlators + job.n_data_correlators;
+
+    float2 sums[CUDA_MULTICORRELATOR_MAX_VECTORS];
+#pragma unroll
+    for (int v = 0; v < CUDA_MULTICORRELATOR_MAX_VECTORS; v++)
+        {
+            sums[v] = make_float2(0.0F, 0.0F);
+        }
+
+    for (int n = blockIdx.x * blockDim.x + threadIdx.x; n < job.signal_length_samples; n += blockDim.x * gridDim.x)
+        {
+            const auto fn = static_cast<float>(n);
+            float sin_phase;
+            float cos_phase;
+            sincosf(job.rem_carrier_phase_in_rad + (job.phase_step_rad + job.phase_rate_step_rad * fn) * fn, &sin_phase, &cos_phase);
+            const float2 sample = sig_in[job.sig_offset + n];
+            const float2 wiped = make_float2(sample.x * cos_phase + sample.y * sin_phase, sample.y * cos_phase - sample.x * sin_phase);
+            const float code_phase_chips = (job.code_phase_step_chips + job.code_phase_rate_step_chips * fn) * fn - job.rem_code_phase_chips;
+#pragma unroll
+            for (int v = 0; v < CUDA_MULTICORRELATOR_MAX_VECTORS; v++)
+                {
+                    if (v < n_vectors)
+                        {
+                            const bool data = v >= job.n_correlators;
+                            const int code_length_chips = data ? job.data_code_length_chips : job.code_length_chips;
+                            int chip = __float2int_rd(code_phase_chips + job.shifts_chips[v]) % code_length_chips;
+                            if (chip < 0)
+                                {
+                                    chip += code_length_chips;
+                                }
+                            const float code = data ? job.data_local_code[chip] : job.local_code[chip];
+                            sums[v].x = fmaf(wiped.x, code, sums[v].x);
+                            sums[v].y = fmaf(wiped.y, code, sums[v].y);
+                        }
+                }
+        }
+
+    for (int v = 0; v < n_vectors; v++)
+        {
+            partial_sums[threadIdx.x] = sums[v];
+            __syncthreads();
+            for (unsigned int stride = CUDA_BANK_THREADS_PER_BLOCK / 2; stride > 0; stride >>= 1)
+                {
+                    if (threadIdx.x < stride)
+                        {
+                            partial_sums[threadIdx.x].x += partial_sums[threadIdx.x + stride].x;
+                            partial_sums[threadIdx.x].y += partial_sums[threadIdx.x + stride].y;
+                        }
+                    __syncthreads();
+                }
+            if (threadIdx.x == 0)
+                {
+                    atomicAdd(&corr_out[job.corr_offset + v].x, partial_sums[0].x);
+                    atomicAdd(&corr_out[job.corr_offset + v].y, partial_sums[0].y);
+                }
+            __syncthreads();
+        }
+}
+}  // namespace
+
+
+Cuda_Multicorrelator_Real_Codes::~Cuda_Multicorrelator_Real_Codes()
+{
+    Cuda_Multicorrelator_Real_Codes::free();
+}
+
+
+bool Cuda_Multicorrelator_Real_Codes::init(
+    int max_signal_length_samples __attribute__((unused)),
+    int n_correlators,
+    int n_data_correlators,
+    uint32_t max_wait_us)
+{
+    if (n_correlators + n_data_correlators > CUDA_MULTICORRELATOR_MAX_VECTORS)
+        {
+            std::cerr << "The CUDA correlators support up to " << CUDA_MULTICORRELATOR_MAX_VECTORS << " correlators per channel\n";
+            return false;
+        }
+    d_n_correlators = n_correlators;
+    d_n_data_correlators = n_data_correlators;
+    d_bank = Cuda_Multicorrelator_Bank::get(max_wait_us);
+    return true;
+}
+
+
+bool Cuda_Multicorrelator_Real_Codes::copy_local_code(float **gpu_local_code, int *gpu_local_code_length, int code_length_chips, const float *local_code_in)
+{
+    if (*gpu_local_code_length < code_length_chips)
+        {
+            if (*gpu_local_code != nullptr)
+                {
+                    cudaFree(*gpu_local_code);
+                    *gpu_local_code = nullptr;
+                }
+            if (!cuda_check(cudaMalloc(reinterpret_cast<void **>(gpu_local_code), sizeof(float) * code_length_chips), "cudaMalloc"))
+                {
+                    *gpu_local_code_length = 0;
+                    return false;
+                }
+            *gpu_local_code_length = code_length_chips;
+        }
+    return cuda_check(cudaMemcpy(*gpu_local_code, local_code_in, sizeof(float) * code_length_chips, cudaMemcpyHostToDevice), "cudaMemcpy");
+}
+
+
+bool Cuda_Multicorrelator_Real_Codes::set_local_code_and_taps(
+    int code_length_chips,
+    const float *local_code_in,
+    float *shifts_chips)
+{
+    // the shifts are read at each correlation, since the tracking loops can change the correlator spacing
+    d_shifts_chips = shifts_chips;
+    d_code_length_chips = code_length_chips;
+    return copy_local_code(&d_local_code_gpu, &d_local_code_gpu_length, code_length_chips, local_code_in);
+}
+
+
+bool Cuda_Multicorrelator_Real_Codes::set_data_local_code_and_taps(
+    int code_length_chips,
+    const float *local_code_in,
+    float *shifts_chips)
+{
+    d_data_shifts_chips = shifts_chips;
+    d_data_code_length_chips = code_length_chips;
+    return copy_local_code(&d_data_local_code_gpu, &d_data_local_code_gpu_length, code_length_chips, local_code_in);
+}
+
+
+bool Cuda_Multicorrelator_Real_Codes::set_input_output_vectors(std::complex<float> *corr_out, const std::complex<float> *sig_in)
+{
+    d_sig_in = sig_in;
+    d_corr_out = corr_out;
+    return true;
+}
+
+
+bool Cuda_Multicorrelator_Real_Codes::set_data_output_vector(std::complex<float> *corr_data_out)
+{
+    d_corr_data_out = corr_data_out;
+    return true;
+}
+
+
+void Cuda_Multicorrelator_Real_Codes::join_bank()
+{
+    if (d_bank != nullptr and !d_bank_member)
+        {
+            d_bank->join();
+            d_bank_member = true;
+        }
+}
+
+
+void Cuda_Multicorrelator_Real_Codes::leave_bank()
+{
+    if (d_bank != nullptr and d_bank_member)
+        {
+            d_bank->leave();
+            d_bank_member = false;
+        }
+}
+
+
+bool Cuda_Multicorrelator_Real_Codes::Carrier_wipeoff_multicorrelator_resampler(
+    float rem_carrier_phase_in_rad,
+    float phase_step_rad,
+    float phase_rate_step_rad,
+    float rem_code_phase_chips,
+    float code_phase_step_chips,
+    float code_phase_rate_step_chips,
+    int signal_length_samples)
+{
+    if (d_bank == nullptr or d_local_code_gpu == nullptr or (d_n_data_correlators > 0 and d_data_local_code_gpu == nullptr))
+        {
+            return false;
+        }
+    const Cuda_Multicorrelator_Bank::Correlation correlation{this,
+        rem_carrier_phase_in_rad, phase_step_rad, phase_rate_step_rad,
+        rem_code_phase_chips, code_phase_step_chips, code_phase_rate_step_chips,
+        signal_length_samples};
+    return d_bank->correlate(&correlation);
+}
+
+
+bool Cuda_Multicorrelator_Real_Codes::free()
+{
+    leave_bank();
+    if (d_local_code_gpu != nullptr)
+        {
+            cudaFree(d_local_code_gpu);
+            d_local_code_gpu = nullptr;
+            d_local_code_gpu_length = 0;
+        }
+    if (d_data_local_code_gpu != nullptr)
+        {
+            cudaFree(d_data_local_code_gpu);
+            d_data_local_code_gpu = nullptr;
+            d_data_local_code_gpu_length = 0;
+        }
+    d_bank.reset();
+    return true;
+}
+
+
+std::shared_ptr<Cuda_Multicorrelator_Bank> Cuda_Multicorrelator_Bank::get(uint32_t max_wait_us)
+{
+    static std::mutex registry_mutex;
+    static std::map<int, std::weak_ptr<Cuda_Multicorrelator_Bank>> registry;
+    int device = 0;
+    cudaGetDevice(&device);
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    std::shared_ptr<Cuda_Multicorrelator_Bank> bank = registry[device].lock();
+    if (bank == nullptr)
+        {
+            bank = std::make_shared<Cuda_Multicorrelator_Bank>(max_wait_us);
+            registry[device] = bank;
+        }
+    return bank;
+}
+
+
+Cuda_Multicorrelator_Bank::Cuda_Multicorrelator_Bank(uint32_t max_wait_us) : d_max_wait(max_wait_us)
+{
+    cuda_check(cudaStreamCreateWithFlags(&d_stream, cudaStreamNonBlocking), "cudaStreamCreate");
+}
+
+
+Cuda_Multicorrelator_Bank::~Cuda_Multicorrelator_Bank()
+{
+    cudaFreeHost(d_sig_host);
+    cudaFree(d_sig_gpu);
+    cudaFreeHost(d_jobs_host);
+    cudaFree(d_jobs_gpu);
+    cudaFreeHost(d_corr_host);
+    cudaFree(d_corr_gpu);
+    if (d_stream != nullptr)
+        {
+            cudaStreamDestroy(d_stream);
+        }
+}
+
+
+void Cuda_Multicorrelator_Bank::join()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_members++;
+}
+
+
+void Cuda_Multicorrelator_Bank::leave()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    if (d_members > 0)
+        {
+            d_members--;
+        }
+    // the channels waiting for this one can go on
+    d_cond.notify_all();
+}
+
+
+bool Cuda_Multicorrelator_Bank::correlate(const Correlation *correlation)
+{
+    Request request{correlation, false, false, false};
+    std::unique_lock<std::mutex> lock(d_mutex);
+    d_pending.push_back(&request);
+    d_cond.wait_for(lock, d_max_wait, [&] { return request.taken or static_cast<int32_t>(d_pending.size()) >= d_members; });
+    if (request.taken)
+        {
+            // another channel is running this request
+            d_cond.wait(lock, [&] { return request.done; });
+            return request.ok;
+        }
+
+    // all the channels have arrived, or the time is up: run the pending requests
+    // (the vectors are reused, so that the steady state does not allocate memory)
+    thread_local std::vector<Request *> requests;
+    requests.clear();
+    requests.swap(d_pending);
+    for (auto *r : requests)
+        {
+            r->taken = true;
+        }
+    lock.unlock();
+    const bool ok = launch(requests);
+    lock.lock();
+    for (auto *r : requests)
+        {
+            r->ok = ok;
+            r->done = true;
+        }
+    d_cond.notify_all();
+    return ok;
+}
+
+
+bool Cuda_Multicorrelator_Bank::reserve(std::size_t n_samples, std::size_t n_jobs, std::size_t n_outputs)
+{
+    // the buffers only grow, so the steady state does not allocate memory
+    bool ok = true;
+    if (n_samples > d_sig_capacity)
+        {
+            cudaFreeHost(d_sig_host);
+            cudaFree(d_sig_gpu);
+            d_sig_host = nullptr;
+            d_sig_gpu = nullptr;
+            ok = ok and cuda_check(cudaHostAlloc(reinterpret_cast<void **>(&d_sig_host), n_samples * sizeof(std::complex<float>), cudaHostAllocDefault), "cudaHostAlloc");
+            ok = ok and cuda_check(cudaMalloc(reinterpret_cast<void **>(&d_sig_gpu), n_samples * sizeof(std::complex<float>)), "cudaMalloc");
+            d_sig_capacity = ok ? n_samples : 0;
+        }
+    if (n_jobs > d_jobs_capacity)
+        {
+            cudaFreeHost(d_jobs_host);
+            cudaFree(d_jobs_gpu);
+            d_jobs_host = nullptr;
+            d_jobs_gpu = nullptr;
+            ok = ok and cuda_check(cudaHostAlloc(&d_jobs_host, n_jobs * sizeof(Cuda_Correlation_Job), cudaHostAllocDefault), "cudaHostAlloc");
+            ok = ok and cuda_check(cudaMalloc(&d_jobs_gpu, n_jobs * sizeof(Cuda_Correlation_Job)), "cudaMalloc");
+            d_jobs_capacity = ok ? n_jobs : 0;
+        }
+    if (n_outputs > d_corr_capacity)
+        {
+            cudaFreeHost(d_corr_host);
+            cudaFree(d_corr_gpu);
+            d_corr_host = nullptr;
+            d_corr_gpu = nullptr;
+            ok = ok and cuda_check(cudaHostAlloc(reinterpret_cast<void **>(&d_corr_host), n_outputs * sizeof(std::complex<float>), cudaHostAllocDefault), "cudaHostAlloc");
+            ok = ok and cuda_check(cudaMalloc(reinterpret_cast<void **>(&d_corr_gpu), n_outputs * sizeof(std::complex<float>)), "cudaMalloc");
+            d_corr_capacity = ok ? n_outputs : 0;
+        }
+    return ok;
+}
+
+
+bool Cuda_Multicorrelator_Bank::launch(const std::vector<Request *> &requests)
+{
+    std::lock_guard<std::mutex> lock(d_launch_mutex);
+    std::size_t n_samples = 0;
+    std::size_t n_outputs = 0;
+    int max_signal_length_samples = 0;
+    for (const auto *r : requests)
+        {
+            const Correlation *c = r->correlation;
+            n_samples += static_cast<std::size_t>(std::max(c->signal_length_samples, 0));
+            n_outputs += static_cast<std::size_t>(c->correlator->d_n_correlators + c->correlator->d_n_data_correlators);
+            max_signal_length_samples = std::max(max_signal_length_samples, c->signal_length_samples);
+        }
+    if (!reserve(n_samples, requests.size(), n_outputs))
+        {
+            return false;
+        }
+
+    // gather the input samples of all the channels in a single transfer
+    auto *jobs = static_cast<Cuda_Correlation_Job *>(d_jobs_host);
+    int sig_offset = 0;
+    int corr_offset = 0;
+    for (std::size_t j = 0; j < requests.size(); j++)
+        {
+            const Correlation *c = requests[j]->correlation;
+            const Cuda_Multicorrelator_Real_Codes *correlator = c->correlator;
+            const int signal_length_samples = std::max(c->signal_length_samples, 0);
+            std::memcpy(d_sig_host + sig_offset, correlator->d_sig_in, signal_length_samples * sizeof(std::complex<float>));
+            Cuda_Correlation_Job &job = jobs[j];
+            job.local_code = correlator->d_local_code_gpu;
+            job.data_local_code = correlator->d_data_local_code_gpu;
+            job.code_length_chips = correlator->d_code_length_chips;
+            job.data_code_length_chips = correlator->d_data_code_length_chips;
+            job.n_correlators = correlator->d_n_correlators;
+            job.n_data_correlators = correlator->d_n_data_correlators;
+            job.sig_offset = sig_offset;
+            job.corr_offset = corr_offset;
+            job.signal_length_samples = signal_length_samples;
+            std::copy(correlator->d_shifts_chips, correlator->d_shifts_chips + job.n_correlators, job.shifts_chips);
+            std::copy(correlator->d_data_shifts_chips, correlator->d_data_shifts_chips + job.n_data_correlators, job.shifts_chips + job.n_correlators);
+            job.rem_carrier_phase_in_rad = c->rem_carrier_phase_in_rad;
+            job.phase_step_rad = c->phase_step_rad;
+            job.phase_rate_step_rad = c->phase_rate_step_rad;
+            job.rem_code_phase_chips = c->rem_code_phase_chips;
+            job.code_phase_step_chips = c->code_phase_step_chips;
+            job.code_phase_rate_step_chips = c->code_phase_rate_step_chips;
+            sig_offset += signal_length_samples;
+            corr_offset += job.n_correlators + job.n_data_correlators;
+        }
+
+    cudaMemcpyAsync(d_sig_gpu, d_sig_host, n_samples * sizeof(std::complex<float>), cudaMemcpyHostToDevice, d_stream);
+    cudaMemcpyAsync(d_jobs_gpu, d_jobs_host, requests.size() * sizeof(Cuda_Correlation_Job), cudaMemcpyHostToDevice, d_stream);
+    cudaMemsetAsync(d_corr_gpu, 0, n_outputs * sizeof(std::complex<float>), d_stream);
+    const int samples_per_block = CUDA_BANK_THREADS_PER_BLOCK * CUDA_BANK_SAMPLES_PER_THREAD;
+    const dim3 blocks_per_grid(std::max((max_signal_length_samples + samples_per_block - 1) / samples_per_block, 1), static_cast<unsigned int>(requests.size()));
+    cuda_bank_multicorrelator_kernel<<<blocks_per_grid, CUDA_BANK_THREADS_PER_BLOCK, 0, d_stream>>>(
+        reinterpret_cast<float2 *>(d_corr_gpu),
+        reinterpret_cast<const float2 *>(d_sig_gpu),
+        static_cast<const Cuda_Correlation_Job *>(d_jobs_gpu));
+    if (!cuda_check(cudaPeekAtLastError(), "kernel launch"))
+        {
+            return false;
+        }
+    cudaMemcpyAsync(d_corr_host, d_corr_gpu, n_outputs * sizeof(std::complex<float>), cudaMemcpyDeviceToHost, d_stream);
+    if (!cuda_check(cudaStreamSynchronize(d_stream), "cudaStreamSynchronize"))
+        {
+            return false;
+        }
+
+    // scatter the results to the channels
+    for (std::size_t j = 0; j < requests.size(); j++)
+        {
+            const Cuda_Multicorrelator_Real_Codes *correlator = requests[j]->correlation->correlator;
+            const std::complex<float> *corr = d_corr_host + jobs[j].corr_offset;
+            std::copy(corr, corr + correlator->d_n_correlators, correlator->d_corr_out);
+            if (correlator->d_n_data_correlators > 0)
+                {
+                    std::copy(corr + correlator->d_n_correlators, corr + correlator->d_n_correlators + correlator->d_n_data_correlators, correlator->d_corr_data_out);
+                }
+        }
+    return true;
+}
@@ -0,0 +1,178 @@
+/*!
+ * \file cuda_multicorrelator_bank.h
+ * \brief CUDA GPU correlators of the tracking channels, computed for all the
+ * channels in a single kernel launch per integration period.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_CUDA_MULTICORRELATOR_BANK_H
+#define GNSS_SDR_CUDA_MULTICORRELATOR_BANK_H
+
+#include <cuda_runtime.h>
+#include <chrono>
+#include <complex>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/** \addtogroup Tracking
+ * \{ */
+/** \addtogroup Tracking_libs
+ * \{ */
+
+
+// Maximum number of pilot plus data correlators of a channel
+constexpr int CUDA_MULTICORRELATOR_MAX_VECTORS = 8;
+
+class Cuda_Multicorrelator_Bank;
+
+
+/*!
+ * \brief Correlators of a tracking channel computed by a NVIDIA CUDA GPU.
+ *
+ * It has the interface of Cpu_Multicorrelator_Real_Codes, so it can be used
+ * by the same tracking blocks. The local codes are copied to the GPU memory
+ * when they are set, and each call to Carrier_wipeoff_multicorrelator_resampler()
+ * submits the correlation to a Cuda_Multicorrelator_Bank shared by all the
+ * channels of the receiver, which computes the correlations of all the
+ * channels in a single kernel launch.
+ */
+class Cuda_Multicorrelator_Real_Codes
+{
+public:
+    Cuda_Multicorrelator_Real_Codes() = default;
+    ~Cuda_Multicorrelator_Real_Codes();
+    bool init(int max_signal_length_samples, int n_correlators, int n_data_correlators = 0, uint32_t max_wait_us = 1000);
+    bool set_local_code_and_taps(int code_length_chips, const float *local_code_in, float *shifts_chips);
+    bool set_data_local_code_and_taps(int code_length_chips, const float *local_code_in, float *shifts_chips);
+    bool set_input_output_vectors(std::complex<float> *corr_out, const std::complex<float> *sig_in);
+    bool set_data_output_vector(std::complex<float> *corr_data_out);
+
+    /*!
+     * \brief Only the channels that have joined the bank (that is, the ones
+     * tracking a signal) are waited for before launching the correlations
+     */
+    void join_bank();
+    void leave_bank();
+
+    bool Carrier_wipeoff_multicorrelator_resampler(float rem_carrier_phase_in_rad, float phase_step_rad, float phase_rate_step_rad, float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips, int signal_length_samples);
+    bool free();
+
+private:
+    friend class Cuda_Multicorrelator_Bank;
+    bool copy_local_code(float **gpu_local_code, int *gpu_local_code_length, int code_length_chips, const float *local_code_in);
+
+    std::shared_ptr<Cuda_Multicorrelator_Bank> d_bank;
+    const std::complex<float> *d_sig_in{nullptr};
+    std::complex<float> *d_corr_out{nullptr};
+    std::complex<float> *d_corr_data_out{nullptr};
+    const float *d_shifts_chips{nullptr};
+    const float *d_data_shifts_chips{nullptr};
+    float *d_local_code_gpu{nullptr};
+    float *d_data_local_code_gpu{nullptr};
+    int d_local_code_gpu_length{0};
+    int d_data_local_code_gpu_length{0};
+    int d_code_length_chips{0};
+    int d_data_code_length_chips{0};
+    int d_n_correlators{0};
+    int d_n_data_correlators{0};
+    bool d_bank_member{false};
+};
+
+
+/*!
+ * \brief Computes the correlations of the tracking channels of the receiver
+ * on a NVIDIA CUDA GPU.
+ *
+ * Launching a kernel per channel is dominated by the launch and transfer
+ * latencies at integration periods of 1 ms, so the channels submit their
+ * correlations and the last channel to arrive (or the first one to wait
+ * longer than max_wait_us) copies the input samples of all of them to the
+ * GPU, runs all the correlations in a single kernel launch and copies their
+ * results back.
+ */
+class Cuda_Multicorrelator_Bank
+{
+public:
+    /*!
+     * \brief Correlation request of a channel
+     */
+    struct Correlation
+    {
+        const Cuda_Multicorrelator_Real_Codes *correlator;
+        float rem_carrier_phase_in_rad;
+        float phase_step_rad;
+        float phase_rate_step_rad;
+        float rem_code_phase_chips;
+        float code_phase_step_chips;
+        float code_phase_rate_step_chips;
+        int signal_length_samples;
+    };
+
+    /*!
+     * \brief Returns the bank of the current CUDA device, which is created if
+     * it does not exist
+     */
+    static std::shared_ptr<Cuda_Multicorrelator_Bank> get(uint32_t max_wait_us);
+
+    explicit Cuda_Multicorrelator_Bank(uint32_t max_wait_us);
+    ~Cuda_Multicorrelator_Bank();
+
+    Cuda_Multicorrelator_Bank(const Cuda_Multicorrelator_Bank &) = delete;
+    Cuda_Multicorrelator_Bank &operator=(const Cuda_Multicorrelator_Bank &) = delete;
+
+    void join();
+    void leave();
+
+    /*!
+     * \brief Computes the correlations of a channel. Returns when they are done.
+     */
+    bool correlate(const Correlation *correlation);
+
+private:
+    struct Request
+    {
+        const Correlation *correlation;
+        bool taken;
+        bool done;
+        bool ok;
+    };
+
+    bool launch(const std::vector<Request *> &requests);
+    bool reserve(std::size_t n_samples, std::size_t n_jobs, std::size_t n_outputs);
+
+    std::mutex d_mutex;
+    std::condition_variable d_cond;
+    std::vector<Request *> d_pending;
+    std::chrono::microseconds d_max_wait;
+    int32_t d_members{0};
+
+    // launches are serialized, since they share the transfer buffers
+    std::mutex d_launch_mutex;
+    cudaStream_t d_stream{nullptr};
+    std::complex<float> *d_sig_host{nullptr};  // pinned host memory
+    std::complex<float> *d_sig_gpu{nullptr};
+    void *d_jobs_host{nullptr};
+    void *d_jobs_gpu{nullptr};
+    std::complex<float> *d_corr_host{nullptr};
+    std::complex<float> *d_corr_gpu{nullptr};
+    std::size_t d_sig_capacity{0};
+    std::size_t d_jobs_capacity{0};
+    std::size_t d_corr_capacity{0};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_CUDA_MULTICORRELATOR_BANK_H
@@ -49,6 +49,7 @@ void Dll_Pll_Conf::SetFromConfiguration(const ConfigurationInterface *configurat
     dump = configuration->property(role + ".dump", dump);
     dump_filename = configuration->property(role + ".dump_filename", dump_filename);
     dump_mat = configuration->property(role + ".dump_mat", dump_mat);
+    dump_compressed = configuration->property(role + ".dump_compressed", dump_compressed);
     pll_bw_hz = configuration->property(role + ".pll_bw_hz", pll_bw_hz);
     if (FLAGS_pll_bw_hz != 0.0)
         {
@@ -112,6 +113,80 @@ void Dll_Pll_Conf::SetFromConfiguration(const ConfigurationInterface *configurat
     carrier_lock_th = configuration->property(role + ".carrier_lock_th", carrier_lock_th);
     carrier_aiding = configuration->property(role + ".carrier_aiding", carrier_aiding);
 
+    // extended integration enabled and disabled at runtime, depending on the C/N0 and the lock status
+    adaptive_integration = configuration->property(role + ".adaptive_integration", adaptive_integration);
+    adaptive_integration_cn0_db_hz = configuration->property(role + ".adaptive_integration_cn0_db_hz", adaptive_integration_cn0_db_hz);
+    adaptive_integration_hysteresis_db = configuration->property(role + ".adaptive_integration_hysteresis_db", adaptive_integration_hysteresis_db);
+    if (adaptive_integration_hysteresis_db < 0.0)
+        {
+            adaptive_integration_hysteresis_db = 0.0;
+            LOG(WARNING) << "adaptive_integration_hysteresis_db must not be negative. It has been set to 0";
+        }
+    adaptive_integration_hold_time_s = configuration->property(role + ".adaptive_integration_hold_time_s", adaptive_integration_hold_time_s);
+
+    // standby channels consume the input in large chunks instead of one per upstream call
+    park_idle_channels = configuration->property(role + ".park_idle_channels", park_idle_channels);
+
+    // correlator bank shared by several channels
+    tracking_bank = configuration->property(role + ".tracking_bank", tracking_bank);
+    tracking_bank_channels = configuration->property(role + ".tracking_bank_channels", tracking_bank_channels);
+    if (tracking_bank_channels < 1)
+        {
+            tracking_bank_channels = 1;
+            LOG(WARNING) << "tracking_bank_channels must be bigger than 0. It has been set to 1";
+        }
+    tracking_bank_max_wait_us = configuration->property(role + ".tracking_bank_max_wait_us", tracking_bank_max_wait_us);
+
+    // correlators computed by the CPU or, for all the channels at once, by a CUDA GPU
+    correlator_backend = configuration->property(role + ".correlator_backend", correlator_backend);
+    if (correlator_backend != "cpu" and correlator_backend != "cuda")
+        {
+            LOG(WARNING) << "Unknown correlator backend: " << correlator_backend << ". Set to cpu";
+            correlator_backend = "cpu";
+        }
+
+    // implementations of the CPU correlator kernels (for instance, u_avx2), instead of the fastest ones
+    volk_rotator_impl = configuration->property(role + ".volk_rotator_impl", volk_rotator_impl);
+    volk_resampler_impl = configuration->property(role + ".volk_resampler_impl", volk_resampler_impl);
+
+    // local code replicas pre-sampled at quantized code phases
+    code_replica_cache = configuration->property(role + ".code_replica_cache", code_replica_cache);
+    code_replica_phases_per_chip = configuration->property(role + ".code_replica_phases_per_chip", code_replica_phases_per_chip);
+    if (code_replica_phases_per_chip < 1)
+        {
+            code_replica_phases_per_chip = 1;
+            LOG(WARNING) << "code_replica_phases_per_chip must be bigger than 0. It has been set to 1";
+        }
+
+    // elements of the antenna array in each input sample, correlated in one pass and combined in a beam steered to the satellite
+    array_elements = configuration->property(role + ".array_elements", array_elements);
+    if (array_elements < 1)
+        {
+            array_elements = 1;
+            LOG(WARNING) << "array_elements must be bigger than 0. It has been set to 1";
+        }
+    array_steering_alpha = configuration->property(role + ".array_steering_alpha", array_steering_alpha);
+    if (array_steering_alpha <= 0.0 or array_steering_alpha > 1.0)
+        {
+            array_steering_alpha = 0.05;
+            LOG(WARNING) << "array_steering_alpha must be in (0, 1]. It has been set to 0.05";
+        }
+
+    // pairs of early and late signal quality monitoring correlators, computed every sqm_decimation integrations
+    sqm_taps = configuration->property(role + ".sqm_taps", sqm_taps);
+    sqm_tap_spacing_chips = configuration->property(role + ".sqm_tap_spacing_chips", sqm_tap_spacing_chips);
+    if (sqm_tap_spacing_chips <= 0.0)
+        {
+            sqm_tap_spacing_chips = 0.1;
+            LOG(WARNING) << "sqm_tap_spacing_chips must be bigger than 0. It has been set to 0.1";
+        }
+    sqm_decimation = configuration->property(role + ".sqm_decimation", sqm_decimation);
+    if (sqm_decimation < 1)
+        {
+            sqm_decimation = 1;
+            LOG(WARNING) << "sqm_decimation must be bigger than 0. It has been set to 1";
+        }
+
     // tracking lock tests smoother parameters
     cn0_smoother_samples = configuration->property(role + ".cn0_smoother_samples", cn0_smoother_samples);
     cn0_smoother_alpha = configuration->property(role + ".cn0_smoother_alpha", cn0_smoother_alpha);
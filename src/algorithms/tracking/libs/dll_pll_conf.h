@@ -37,7 +37,10 @@ public:
 
     /* DLL/PLL tracking configuration */
     std::string item_type{"gr_complex"};
+    std::string correlator_backend{"cpu"};
     std::string dump_filename{"./dll_pll_dump.dat"};
+    std::string volk_rotator_impl;
+    std::string volk_resampler_impl;
     double fs_in{2000000.0};
     double carrier_lock_th{0.0};
     float pll_pull_in_bw_hz{50.0};
@@ -56,10 +59,21 @@ public:
     float y_intercept{1.0};
     float cn0_smoother_alpha{0.002};
     float carrier_lock_test_smoother_alpha{0.002};
+    float adaptive_integration_cn0_db_hz{40.0};
+    float adaptive_integration_hysteresis_db{3.0};
+    float adaptive_integration_hold_time_s{1.0};
+    float array_steering_alpha{0.05};
+    float sqm_tap_spacing_chips{0.1};
     uint32_t pull_in_time_s{10U};
     uint32_t bit_synchronization_time_limit_s{20U};
     uint32_t vector_length{0U};
     uint32_t smoother_length{10U};
+    uint32_t tracking_bank_channels{8U};
+    uint32_t tracking_bank_max_wait_us{200U};
+    uint32_t code_replica_phases_per_chip{16U};
+    uint32_t array_elements{1U};
+    uint32_t sqm_taps{0U};
+    uint32_t sqm_decimation{10U};
     int32_t fll_filter_order{1};
     int32_t pll_filter_order{3};
     int32_t dll_filter_order{2};
@@ -78,8 +92,13 @@ public:
     bool enable_doppler_correction{false};
     bool carrier_aiding{true};
     bool high_dyn{false};
+    bool tracking_bank{false};
+    bool park_idle_channels{true};
+    bool code_replica_cache{false};
+    bool adaptive_integration{false};
     bool dump{false};
     bool dump_mat{true};
+    bool dump_compressed{false};
 };
 
 
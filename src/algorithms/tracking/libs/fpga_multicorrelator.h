@@ -36,6 +36,16 @@
 
 /*!
  * \brief Class that implements carrier wipe-off and correlators.
+ *
+ * Each channel has its own UIO device, with its register map and interrupt
+ * line, so each integration costs its channel a write() to re-enable the
+ * interrupt and a read() to wait for it, while the results are read from
+ * the mapped registers without syscalls. A readout of all the channels with
+ * one interrupt per integration period would need the tracking IP and its
+ * driver to place the results of all the channels in a shared DMA buffer,
+ * which they do not provide: moving the per-channel waits to a dispatcher
+ * thread would keep the same interrupts and syscalls, and add a thread
+ * handoff per channel and period.
  */
 class Fpga_Multicorrelator_8sc
 {
@@ -0,0 +1,58 @@
+/*!
+ * \file glonass_ca_tracking_signal.cc
+ * \brief Parameters of the GLONASS C/A signals used by the GLONASS tracking
+ * loops, so that the same loop tracks the L1 and the L2 signals.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "glonass_ca_tracking_signal.h"
+#include "GLONASS_L1_L2_CA.h"
+#include "glonass_l1_signal_replica.h"
+#include "glonass_l2_signal_replica.h"
+
+
+double Glonass_Ca_Tracking_Signal::channel_freq_hz(uint32_t PRN) const
+{
+    return carrier_freq_hz + channel_offset_hz(PRN);
+}
+
+
+double Glonass_Ca_Tracking_Signal::channel_offset_hz(uint32_t PRN) const
+{
+    return channel_spacing_hz * static_cast<double>(GLONASS_PRN.at(PRN));
+}
+
+
+Glonass_Ca_Tracking_Signal glonass_l1_ca_tracking_signal()
+{
+    return Glonass_Ca_Tracking_Signal{
+        "L1 C/A",
+        GLONASS_L1_CA_FREQ_HZ,
+        GLONASS_L1_CA_DFREQ_HZ,
+        GLONASS_L1_CA_CODE_RATE_CPS,
+        GLONASS_L1_CA_CODE_LENGTH_CHIPS,
+        GLONASS_L1_CA_CODE_PERIOD_S,
+        &glonass_l1_ca_code_gen_complex};
+}
+
+
+Glonass_Ca_Tracking_Signal glonass_l2_ca_tracking_signal()
+{
+    return Glonass_Ca_Tracking_Signal{
+        "L2 C/A",
+        GLONASS_L2_CA_FREQ_HZ,
+        GLONASS_L2_CA_DFREQ_HZ,
+        GLONASS_L2_CA_CODE_RATE_CPS,
+        GLONASS_L2_CA_CODE_LENGTH_CHIPS,
+        GLONASS_L2_CA_CODE_PERIOD_S,
+        &glonass_l2_ca_code_gen_complex};
+}
@@ -0,0 +1,69 @@
+/*!
+ * \file glonass_ca_tracking_signal.h
+ * \brief Parameters of the GLONASS C/A signals used by the GLONASS tracking
+ * loops, so that the same loop tracks the L1 and the L2 signals.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GLONASS_CA_TRACKING_SIGNAL_H
+#define GNSS_SDR_GLONASS_CA_TRACKING_SIGNAL_H
+
+#include <complex>
+#include <cstdint>
+#include <string>
+#if HAS_STD_SPAN
+#include <span>
+namespace own = std;
+#else
+#include <gsl/gsl-lite.hpp>
+namespace own = gsl;
+#endif
+
+/** \addtogroup Tracking
+ * \{ */
+/** \addtogroup Tracking_libs
+ * \{ */
+
+
+/*!
+ * \brief The GLONASS L1 and L2 C/A signals only differ in the carrier
+ * frequency, the FDMA channel spacing and the code generator.
+ */
+struct Glonass_Ca_Tracking_Signal
+{
+    //! Generates the code replica, sampled 1x/chip, starting at chip_shift
+    using Code_Generator = void (*)(own::span<std::complex<float>> dest, uint32_t chip_shift);
+
+    std::string name;            //!< "L1 C/A" or "L2 C/A", for the log messages
+    double carrier_freq_hz;      //!< Carrier frequency of the frequency channel 0 [Hz]
+    double channel_spacing_hz;   //!< Spacing between FDMA frequency channels [Hz]
+    double code_rate_cps;        //!< Code rate [chips/s]
+    double code_length_chips;    //!< Code length [chips]
+    double code_period_s;        //!< Code period [s]
+    Code_Generator code_gen;
+
+    //! Carrier frequency of the FDMA frequency channel of the satellite PRN
+    double channel_freq_hz(uint32_t PRN) const;
+
+    //! Offset of the FDMA frequency channel of the satellite PRN from the nominal carrier
+    double channel_offset_hz(uint32_t PRN) const;
+};
+
+
+Glonass_Ca_Tracking_Signal glonass_l1_ca_tracking_signal();
+
+Glonass_Ca_Tracking_Signal glonass_l2_ca_tracking_signal();
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GLONASS_CA_TRACKING_SIGNAL_H
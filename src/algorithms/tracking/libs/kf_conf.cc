@@ -31,6 +31,7 @@ Kf_Conf::Kf_Conf() : item_type("gr_complex"),
                      expected_cn0_dbhz(42.0),
                      code_disc_sd_chips(0.01),
                      carrier_disc_sd_rads(0.1),
+                     pvt_aiding_doppler_sd_hz(5.0),
                      code_phase_sd_chips(0.001),
                      code_rate_sd_chips_s(0.001),
                      carrier_phase_sd_rad(0.001),
@@ -74,7 +75,8 @@ Kf_Conf::Kf_Conf() : item_type("gr_complex"),
                      dump(false),
                      dump_mat(true),
                      enable_dynamic_measurement_covariance(false),
-                     use_estimated_cn0(false)
+                     use_estimated_cn0(false),
+                     enable_pvt_aiding(false)
 {
     signal[0] = '1';
     signal[1] = 'C';
@@ -137,6 +139,10 @@ void Kf_Conf::SetFromConfiguration(const ConfigurationInterface *configuration,
     enable_dynamic_measurement_covariance = configuration->property(role + ".enable_dynamic_measurement_covariance", enable_dynamic_measurement_covariance);
     use_estimated_cn0 = configuration->property(role + ".use_estimated_cn0", use_estimated_cn0);
 
+    // Doppler aiding from the PVT solution
+    enable_pvt_aiding = configuration->property(role + ".enable_pvt_aiding", enable_pvt_aiding);
+    pvt_aiding_doppler_sd_hz = configuration->property(role + ".pvt_aiding_doppler_sd_hz", pvt_aiding_doppler_sd_hz);
+
     // System covariances (Q)
     code_phase_sd_chips = configuration->property(role + ".code_phase_sd_chips", code_phase_sd_chips);
     code_rate_sd_chips_s = configuration->property(role + ".code_rate_sd_chips_s", code_rate_sd_chips_s);
@@ -44,6 +44,7 @@ public:
 
     double code_disc_sd_chips;
     double carrier_disc_sd_rads;
+    double pvt_aiding_doppler_sd_hz;
 
     // System covariances (Q)
     double code_phase_sd_chips;
@@ -100,6 +101,7 @@ public:
 
     bool enable_dynamic_measurement_covariance;
     bool use_estimated_cn0;
+    bool enable_pvt_aiding;
 };
 
 #endif
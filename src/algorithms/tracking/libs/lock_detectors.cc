@@ -26,14 +26,35 @@
  * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
  * This file is part of GNSS-SDR.
  *
- * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
  * SPDX-License-Identifier: GPL-3.0-or-later
  *
  * -----------------------------------------------------------------------------
  */
 
 #include "lock_detectors.h"
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
+
+namespace
+{
+float m2m4_snr_to_cn0(float Psig, float m_2, float m_4, float coh_integration_time_s)
+{
+    float SNR_aux = 0.0;
+    const float aux = std::sqrt(2.0F * m_2 * m_2 - m_4);
+    if (std::isnan(aux))
+        {
+            SNR_aux = Psig / (m_2 - Psig);
+        }
+    else
+        {
+            SNR_aux = aux / (m_2 - aux);
+        }
+    return 10.0F * std::log10(SNR_aux) - 10.0F * std::log10(coh_integration_time_s);
+}
+}  // namespace
+
 
 /*
  * Signal-to-Noise (SNR) (\f$\rho\f$) estimator using the Signal-to-Noise Variance (SNV) estimator:
@@ -89,8 +110,6 @@ float cn0_svn_estimator(const gr_complex* Prompt_buffer, int length, float coh_i
  */
 float cn0_m2m4_estimator(const gr_complex* Prompt_buffer, int length, float coh_integration_time_s)
 {
-    float SNR_aux = 0.0;
-    float SNR_dB_Hz = 0.0;
     float Psig = 0.0;
     float m_2 = 0.0;
     float m_4 = 0.0;
@@ -107,18 +126,7 @@ float cn0_m2m4_estimator(const gr_complex* Prompt_buffer, int length, float coh_
     Psig = Psig * Psig;
     m_2 /= n;
     m_4 /= n;
-    aux = std::sqrt(2.0F * m_2 * m_2 - m_4);
-    if (std::isnan(aux))
-        {
-            SNR_aux = Psig / (m_2 - Psig);
-        }
-    else
-        {
-            SNR_aux = aux / (m_2 - aux);
-        }
-    SNR_dB_Hz = 10.0F * std::log10(SNR_aux) - 10.0F * std::log10(coh_integration_time_s);
-
-    return SNR_dB_Hz;
+    return m2m4_snr_to_cn0(Psig, m_2, m_4, coh_integration_time_s);
 }
 
 
@@ -131,7 +139,7 @@ float cn0_m2m4_estimator(const gr_complex* Prompt_buffer, int length, float coh_
  *  \f$NBP=(\sum^{N-1}_{i=0}Im(Pc(i)))^2+(\sum^{N-1}_{i=0}Re(Pc(i)))^2\f$, and
  *  \f$Pc(i)\f$ is the prompt correlator output for the sample index i.
  */
-float carrier_lock_detector(gr_complex* Prompt_buffer, int length)
+float carrier_lock_detector(const gr_complex* Prompt_buffer, int length)
 {
     float tmp_sum_I = 0.0;
     float tmp_sum_Q = 0.0;
@@ -146,3 +154,122 @@ float carrier_lock_detector(gr_complex* Prompt_buffer, int length)
     NBD = tmp_sum_I * tmp_sum_I - tmp_sum_Q * tmp_sum_Q;
     return NBD / NBP;
 }
+
+
+void cn0_m2m4_estimator_batch(const gr_complex* Prompt_buffers, int n_channels, int length, float coh_integration_time_s, float* cn0_dB_Hz)
+{
+    std::vector<float> Psig(n_channels, 0.0);
+    std::vector<float> m_2(n_channels, 0.0);
+    std::vector<float> m_4(n_channels, 0.0);
+    for (int i = 0; i < length; i++)
+        {
+            const gr_complex* prompts = Prompt_buffers + static_cast<std::ptrdiff_t>(i) * n_channels;
+            // independent channels in the inner loop, so that it is vectorized
+            for (int ch = 0; ch < n_channels; ch++)
+                {
+                    const float re = prompts[ch].real();
+                    const float im = prompts[ch].imag();
+                    const float aux = re * re + im * im;
+                    Psig[ch] += std::abs(re);
+                    m_2[ch] += aux;
+                    m_4[ch] += aux * aux;
+                }
+        }
+    const auto n = static_cast<float>(length);
+    for (int ch = 0; ch < n_channels; ch++)
+        {
+            const float psig = Psig[ch] / n;
+            cn0_dB_Hz[ch] = m2m4_snr_to_cn0(psig * psig, m_2[ch] / n, m_4[ch] / n, coh_integration_time_s);
+        }
+}
+
+
+void carrier_lock_detector_batch(const gr_complex* Prompt_buffers, int n_channels, int length, float* lock_test)
+{
+    std::vector<float> tmp_sum_I(n_channels, 0.0);
+    std::vector<float> tmp_sum_Q(n_channels, 0.0);
+    for (int i = 0; i < length; i++)
+        {
+            const gr_complex* prompts = Prompt_buffers + static_cast<std::ptrdiff_t>(i) * n_channels;
+            for (int ch = 0; ch < n_channels; ch++)
+                {
+                    tmp_sum_I[ch] += prompts[ch].real();
+                    tmp_sum_Q[ch] += prompts[ch].imag();
+                }
+        }
+    for (int ch = 0; ch < n_channels; ch++)
+        {
+            const float NBP = tmp_sum_I[ch] * tmp_sum_I[ch] + tmp_sum_Q[ch] * tmp_sum_Q[ch];
+            const float NBD = tmp_sum_I[ch] * tmp_sum_I[ch] - tmp_sum_Q[ch] * tmp_sum_Q[ch];
+            lock_test[ch] = NBD / NBP;
+        }
+}
+
+
+Cn0_M2M4_Estimator::Cn0_M2M4_Estimator(int length) : d_window(std::max(length, 1)),
+                                                      d_length(std::max(length, 1))
+{
+}
+
+
+void Cn0_M2M4_Estimator::reset()
+{
+    std::fill(d_window.begin(), d_window.end(), gr_complex(0.0, 0.0));
+    d_sum_abs_real = 0.0;
+    d_sum_m2 = 0.0;
+    d_sum_m4 = 0.0;
+    d_next = 0;
+    d_count = 0;
+}
+
+
+void Cn0_M2M4_Estimator::update(const gr_complex& prompt)
+{
+    if (d_count == d_length)
+        {
+            // remove the oldest prompt of the window
+            const gr_complex& oldest = d_window[d_next];
+            const double aux = static_cast<double>(std::norm(oldest));
+            d_sum_abs_real -= std::abs(static_cast<double>(oldest.real()));
+            d_sum_m2 -= aux;
+            d_sum_m4 -= aux * aux;
+        }
+    else
+        {
+            d_count++;
+        }
+    d_window[d_next] = prompt;
+    const double aux = static_cast<double>(std::norm(prompt));
+    d_sum_abs_real += std::abs(static_cast<double>(prompt.real()));
+    d_sum_m2 += aux;
+    d_sum_m4 += aux * aux;
+    d_next++;
+    if (d_next == d_length)
+        {
+            d_next = 0;
+            recompute_sums();
+        }
+}
+
+
+void Cn0_M2M4_Estimator::recompute_sums()
+{
+    d_sum_abs_real = 0.0;
+    d_sum_m2 = 0.0;
+    d_sum_m4 = 0.0;
+    for (int i = 0; i < d_count; i++)
+        {
+            const double aux = static_cast<double>(std::norm(d_window[i]));
+            d_sum_abs_real += std::abs(static_cast<double>(d_window[i].real()));
+            d_sum_m2 += aux;
+            d_sum_m4 += aux * aux;
+        }
+}
+
+
+float Cn0_M2M4_Estimator::cn0(float coh_integration_time_s) const
+{
+    const auto n = static_cast<double>(d_count);
+    const double Psig = d_sum_abs_real / n;
+    return m2m4_snr_to_cn0(static_cast<float>(Psig * Psig), static_cast<float>(d_sum_m2 / n), static_cast<float>(d_sum_m4 / n), coh_integration_time_s);
+}
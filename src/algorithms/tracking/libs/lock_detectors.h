@@ -36,6 +36,7 @@
 #define GNSS_SDR_LOCK_DETECTORS_H
 
 #include <gnuradio/gr_complex.h>
+#include <vector>
 
 /** \addtogroup Tracking
  * \{ */
@@ -106,7 +107,74 @@ float cn0_m2m4_estimator(const gr_complex* Prompt_buffer, int length, float coh_
  * Volume I, Chapter 8: GPS Receivers, AJ Systems, Los Altos, CA 94024.
  * Inc.: 329-407.
  */
-float carrier_lock_detector(gr_complex* Prompt_buffer, int length);
+float carrier_lock_detector(const gr_complex* Prompt_buffer, int length);
+
+
+/*! \brief Evaluates cn0_m2m4_estimator for several channels at once
+ *
+ * The prompt buffers are interleaved: Prompt_buffers[i * n_channels + ch] is
+ * the sample i of the channel ch, so the moments of all the channels are
+ * accumulated in a single vectorizable pass over the buffers. The estimates,
+ * in dB-Hz, are written to cn0_dB_Hz[ch].
+ */
+void cn0_m2m4_estimator_batch(const gr_complex* Prompt_buffers, int n_channels, int length, float coh_integration_time_s, float* cn0_dB_Hz);
+
+
+/*! \brief Evaluates carrier_lock_detector for several channels at once
+ *
+ * The prompt buffers are interleaved as in cn0_m2m4_estimator_batch(), and
+ * the lock tests are written to lock_test[ch].
+ */
+void carrier_lock_detector_batch(const gr_complex* Prompt_buffers, int n_channels, int length, float* lock_test);
+
+
+/*! \brief Incremental cn0_m2m4_estimator over the last length prompt
+ * correlator outputs
+ *
+ * It keeps the sums of the moments of the window, so each new prompt
+ * updates the estimation in O(1) instead of recomputing it over the whole
+ * window. The sums are recomputed from the window each time it wraps
+ * around, so that rounding errors do not accumulate.
+ */
+class Cn0_M2M4_Estimator
+{
+public:
+    explicit Cn0_M2M4_Estimator(int length = 20);
+    void reset();
+    void update(const gr_complex& prompt);
+
+    /*!
+     * \brief True when the window is full
+     */
+    inline bool ready() const
+    {
+        return d_count == d_length;
+    }
+
+    /*!
+     * \brief Returns the CN0 estimation [dB-Hz] of the prompts of the window
+     */
+    float cn0(float coh_integration_time_s) const;
+
+    /*!
+     * \brief Returns the prompts of the window, in ring buffer order
+     */
+    inline const gr_complex* window() const
+    {
+        return d_window.data();
+    }
+
+private:
+    void recompute_sums();
+
+    std::vector<gr_complex> d_window;
+    double d_sum_abs_real{0.0};
+    double d_sum_m2{0.0};
+    double d_sum_m4{0.0};
+    int d_length;
+    int d_next{0};
+    int d_count{0};
+};
 
 
 /** \} */
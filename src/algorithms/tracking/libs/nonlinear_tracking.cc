@@ -27,6 +27,29 @@
  */
 
 #include "nonlinear_tracking.h"
+#include <stdexcept>
+
+
+namespace
+{
+// Evaluates fcn at each column of points, and stores the results in the columns
+// of values. The columns are handed to fcn without copying them, and values is only
+// reallocated when its dimensions change.
+void evaluate_points(ModelFunction* fcn, arma::mat& points, arma::mat& values)
+{
+    for (arma::uword i = 0; i < points.n_cols; i++)
+        {
+            const arma::vec point(points.colptr(i), points.n_rows, false, true);
+            const arma::vec value = (*fcn)(point);
+            if (i == 0)
+                {
+                    values.set_size(value.n_elem, points.n_cols);
+                }
+            values.col(i) = value;
+        }
+}
+}  // namespace
+
 
 /***************** CUBATURE KALMAN FILTER *****************/
 
@@ -73,39 +96,30 @@ void CubatureFilter::initialize(const arma::mat& x_pred_0, const arma::mat& P_x_
 void CubatureFilter::predict_sequential(const arma::vec& x_post, const arma::mat& P_x_post, ModelFunction* transition_fcn, const arma::mat& noise_covariance)
 {
     // Compute number of cubature points
-    int nx = x_post.n_elem;
-    int np = 2 * nx;
-
-    // Generator Matrix
-    arma::mat gen_one = arma::join_horiz(arma::eye(nx, nx), -1.0 * arma::eye(nx, nx));
-
-    // Initialize predicted mean and covariance
-    arma::vec x_pred = arma::zeros(nx, 1);
-    arma::mat P_x_pred = arma::zeros(nx, nx);
+    const int nx = x_post.n_elem;
+    const int np = 2 * nx;
 
     // Factorize posterior covariance
-    arma::mat Sm_post = arma::chol(P_x_post, "lower");
-
-    // Propagate and evaluate cubature points
-    arma::vec Xi_post;
-    arma::vec Xi_pred;
-
-    for (int i = 0; i < np; i++)
+    if (!arma::chol(Sm_work, P_x_post, "lower"))
         {
-            Xi_post = Sm_post * (std::sqrt(static_cast<float>(np) / 2.0) * gen_one.col(i)) + x_post;
-            Xi_pred = (*transition_fcn)(Xi_post);
+            throw std::runtime_error("chol(): decomposition failed");
+        }
 
-            x_pred = x_pred + Xi_pred;
-            P_x_pred = P_x_pred + Xi_pred * Xi_pred.t();
+    // Generate cubature points, at +/- sqrt(nx) along each column of the factor
+    const double scale = std::sqrt(static_cast<float>(np) / 2.0);
+    Xi_work.set_size(nx, np);
+    for (int i = 0; i < nx; i++)
+        {
+            Xi_work.col(i) = x_post + scale * Sm_work.col(i);
+            Xi_work.col(i + nx) = x_post - scale * Sm_work.col(i);
         }
 
-    // Compute predicted mean and error covariance
-    x_pred = x_pred / static_cast<float>(np);
-    P_x_pred = P_x_pred / static_cast<float>(np) - x_pred * x_pred.t() + noise_covariance;
+    // Propagate cubature points
+    evaluate_points(transition_fcn, Xi_work, Yi_work);
 
-    // Store predicted mean and error covariance
-    x_pred_out = x_pred;
-    P_x_pred_out = P_x_pred;
+    // Compute and store predicted mean and error covariance
+    x_pred_out = arma::sum(Yi_work, 1) / static_cast<float>(np);
+    P_x_pred_out = Yi_work * Yi_work.t() / static_cast<float>(np) - x_pred_out * x_pred_out.t() + noise_covariance;
 }
 
 
@@ -115,38 +129,31 @@ void CubatureFilter::predict_sequential(const arma::vec& x_post, const arma::mat
 void CubatureFilter::update_sequential(const arma::vec& z_upd, const arma::vec& x_pred, const arma::mat& P_x_pred, ModelFunction* measurement_fcn, const arma::mat& noise_covariance)
 {
     // Compute number of cubature points
-    int nx = x_pred.n_elem;
-    int nz = z_upd.n_elem;
-    int np = 2 * nx;
-
-    // Generator Matrix
-    arma::mat gen_one = arma::join_horiz(arma::eye(nx, nx), -1.0 * arma::eye(nx, nx));
-
-    // Initialize estimated predicted measurement and covariances
-    arma::mat z_pred = arma::zeros(nz, 1);
-    arma::mat P_zz_pred = arma::zeros(nz, nz);
-    arma::mat P_xz_pred = arma::zeros(nx, nz);
+    const int nx = x_pred.n_elem;
+    const int np = 2 * nx;
 
     // Factorize predicted covariance
-    arma::mat Sm_pred = arma::chol(P_x_pred, "lower");
-
-    // Propagate and evaluate cubature points
-    arma::vec Xi_pred;
-    arma::vec Zi_pred;
-    for (int i = 0; i < np; i++)
+    if (!arma::chol(Sm_work, P_x_pred, "lower"))
         {
-            Xi_pred = Sm_pred * (std::sqrt(static_cast<float>(np) / 2.0) * gen_one.col(i)) + x_pred;
-            Zi_pred = (*measurement_fcn)(Xi_pred);
+            throw std::runtime_error("chol(): decomposition failed");
+        }
 
-            z_pred = z_pred + Zi_pred;
-            P_zz_pred = P_zz_pred + Zi_pred * Zi_pred.t();
-            P_xz_pred = P_xz_pred + Xi_pred * Zi_pred.t();
+    // Generate cubature points, at +/- sqrt(nx) along each column of the factor
+    const double scale = std::sqrt(static_cast<float>(np) / 2.0);
+    Xi_work.set_size(nx, np);
+    for (int i = 0; i < nx; i++)
+        {
+            Xi_work.col(i) = x_pred + scale * Sm_work.col(i);
+            Xi_work.col(i + nx) = x_pred - scale * Sm_work.col(i);
         }
 
+    // Evaluate the measurements at the cubature points
+    evaluate_points(measurement_fcn, Xi_work, Yi_work);
+
     // Compute measurement mean, covariance and cross covariance
-    z_pred = z_pred / static_cast<float>(np);
-    P_zz_pred = P_zz_pred / static_cast<float>(np) - z_pred * z_pred.t() + noise_covariance;
-    P_xz_pred = P_xz_pred / static_cast<float>(np) - x_pred * z_pred.t();
+    const arma::vec z_pred = arma::sum(Yi_work, 1) / static_cast<float>(np);
+    const arma::mat P_zz_pred = Yi_work * Yi_work.t() / static_cast<float>(np) - z_pred * z_pred.t() + noise_covariance;
+    const arma::mat P_xz_pred = Xi_work * Yi_work.t() / static_cast<float>(np) - x_pred * z_pred.t();
 
     // Compute cubature Kalman gain
     arma::mat W_k = P_xz_pred * arma::inv(P_zz_pred);
@@ -241,37 +248,29 @@ void UnscentedFilter::predict_sequential(const arma::vec& x_post, const arma::ma
     float W0_c = lambda / (static_cast<float>(nx) + lambda) + (1 - std::pow(alpha, 2.0F) + beta);
     float Wi_m = 1.0F / (2.0F * (static_cast<float>(nx) + lambda));
 
-    // Propagate and evaluate sigma points
-    arma::mat Xi_fact = arma::zeros(nx, nx);
-    arma::mat Xi_post = arma::zeros(nx, np);
-    arma::mat Xi_pred = arma::zeros(nx, np);
-
-    Xi_post.col(0) = x_post;
-    Xi_pred.col(0) = (*transition_fcn)(Xi_post.col(0));
+    // Generate sigma points, from a single square root of the covariance
+    if (!arma::sqrtmat_sympd(Sm_work, P_x_post))
+        {
+            throw std::runtime_error("sqrtmat_sympd(): transformation failed");
+        }
+    Sm_work *= std::sqrt(static_cast<float>(nx) + lambda);
+    Xi_work.set_size(nx, np);
+    Xi_work.col(0) = x_post;
     for (int i = 1; i <= nx; i++)
         {
-            Xi_fact = std::sqrt(static_cast<float>(nx) + lambda) * arma::sqrtmat_sympd(P_x_post);
-            Xi_post.col(i) = x_post + Xi_fact.col(i - 1);
-            Xi_post.col(i + nx) = x_post - Xi_fact.col(i - 1);
-
-            Xi_pred.col(i) = (*transition_fcn)(Xi_post.col(i));
-            Xi_pred.col(i + nx) = (*transition_fcn)(Xi_post.col(i + nx));
+            Xi_work.col(i) = x_post + Sm_work.col(i - 1);
+            Xi_work.col(i + nx) = x_post - Sm_work.col(i - 1);
         }
 
-    // Compute predicted mean
-    arma::vec x_pred = W0_m * Xi_pred.col(0) + Wi_m * arma::sum(Xi_pred.cols(1, np - 1), 1);
+    // Propagate sigma points
+    evaluate_points(transition_fcn, Xi_work, Yi_work);
 
-    // Compute predicted error covariance
-    arma::mat P_x_pred = W0_c * ((Xi_pred.col(0) - x_pred) * (Xi_pred.col(0).t() - x_pred.t()));
-    for (int i = 1; i < np; i++)
-        {
-            P_x_pred = P_x_pred + Wi_m * ((Xi_pred.col(i) - x_pred) * (Xi_pred.col(i).t() - x_pred.t()));
-        }
-    P_x_pred = P_x_pred + noise_covariance;
+    // Compute and store predicted mean
+    x_pred_out = W0_m * Yi_work.col(0) + Wi_m * arma::sum(Yi_work.cols(1, np - 1), 1);
 
-    // Store predicted mean and error covariance
-    x_pred_out = x_pred;
-    P_x_pred_out = P_x_pred;
+    // Compute and store predicted error covariance, from the deviations of the points
+    Yi_work.each_col() -= x_pred_out;
+    P_x_pred_out = W0_c * (Yi_work.col(0) * Yi_work.col(0).t()) + Wi_m * (Yi_work.cols(1, np - 1) * Yi_work.cols(1, np - 1).t()) + noise_covariance;
 }
 
 
@@ -282,7 +281,6 @@ void UnscentedFilter::update_sequential(const arma::vec& z_upd, const arma::vec&
 {
     // Compute number of sigma points
     int nx = x_pred.n_elem;
-    int nz = z_upd.n_elem;
     int np = 2 * nx + 1;
 
     float alpha = 0.001;
@@ -296,34 +294,32 @@ void UnscentedFilter::update_sequential(const arma::vec& z_upd, const arma::vec&
     float W0_c = lambda / (static_cast<float>(nx) + lambda) + (1.0F - std::pow(alpha, 2.0F) + beta);
     float Wi_m = 1.0F / (2.0F * (static_cast<float>(nx) + lambda));
 
-    // Propagate and evaluate sigma points
-    arma::mat Xi_fact = arma::zeros(nx, nx);
-    arma::mat Xi_pred = arma::zeros(nx, np);
-    arma::mat Zi_pred = arma::zeros(nz, np);
-
-    Xi_pred.col(0) = x_pred;
-    Zi_pred.col(0) = (*measurement_fcn)(Xi_pred.col(0));
+    // Generate sigma points, from a single square root of the covariance
+    if (!arma::sqrtmat_sympd(Sm_work, P_x_pred))
+        {
+            throw std::runtime_error("sqrtmat_sympd(): transformation failed");
+        }
+    Sm_work *= std::sqrt(static_cast<float>(nx) + lambda);
+    Xi_work.set_size(nx, np);
+    Xi_work.col(0) = x_pred;
     for (int i = 1; i <= nx; i++)
         {
-            Xi_fact = std::sqrt(static_cast<float>(nx) + lambda) * arma::sqrtmat_sympd(P_x_pred);
-            Xi_pred.col(i) = x_pred + Xi_fact.col(i - 1);
-            Xi_pred.col(i + nx) = x_pred - Xi_fact.col(i - 1);
-
-            Zi_pred.col(i) = (*measurement_fcn)(Xi_pred.col(i));
-            Zi_pred.col(i + nx) = (*measurement_fcn)(Xi_pred.col(i + nx));
+            Xi_work.col(i) = x_pred + Sm_work.col(i - 1);
+            Xi_work.col(i + nx) = x_pred - Sm_work.col(i - 1);
         }
 
-    // Compute measurement mean
-    arma::mat z_pred = W0_m * Zi_pred.col(0) + Wi_m * arma::sum(Zi_pred.cols(1, np - 1), 1);
+    // Evaluate the measurements at the sigma points
+    evaluate_points(measurement_fcn, Xi_work, Yi_work);
 
-    // Compute measurement covariance and cross covariance
-    arma::mat P_zz_pred = W0_c * ((Zi_pred.col(0) - z_pred) * (Zi_pred.col(0).t() - z_pred.t()));
-    arma::mat P_xz_pred = W0_c * ((Xi_pred.col(0) - x_pred) * (Zi_pred.col(0).t() - z_pred.t()));
-    for (int i = 0; i < np; i++)
-        {
-            P_zz_pred = P_zz_pred + Wi_m * ((Zi_pred.col(i) - z_pred) * (Zi_pred.col(i).t() - z_pred.t()));
-            P_xz_pred = P_xz_pred + Wi_m * ((Xi_pred.col(i) - x_pred) * (Zi_pred.col(i).t() - z_pred.t()));
-        }
+    // Compute measurement mean
+    const arma::vec z_pred = W0_m * Yi_work.col(0) + Wi_m * arma::sum(Yi_work.cols(1, np - 1), 1);
+
+    // Compute measurement covariance and cross covariance, from the deviations
+    // of the points (the central point is weighted by W0_c + Wi_m)
+    Xi_work.each_col() -= x_pred;
+    Yi_work.each_col() -= z_pred;
+    arma::mat P_zz_pred = W0_c * (Yi_work.col(0) * Yi_work.col(0).t()) + Wi_m * (Yi_work * Yi_work.t());
+    const arma::mat P_xz_pred = W0_c * (Xi_work.col(0) * Yi_work.col(0).t()) + Wi_m * (Xi_work * Yi_work.t());
     P_zz_pred = P_zz_pred + noise_covariance;
 
     // Estimate cubature Kalman gain
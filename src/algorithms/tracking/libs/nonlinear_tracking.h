@@ -78,6 +78,11 @@ private:
     arma::mat P_x_pred_out;
     arma::vec x_est;
     arma::mat P_x_est;
+
+    // Work matrices, kept between calls so that they are only reallocated when the dimensions change
+    arma::mat Sm_work;  // square root of the covariance
+    arma::mat Xi_work;  // points, one per column
+    arma::mat Yi_work;  // model function at each point
 };
 
 class UnscentedFilter
@@ -107,6 +112,11 @@ private:
     arma::mat P_x_pred_out;
     arma::vec x_est;
     arma::mat P_x_est;
+
+    // Work matrices, kept between calls so that they are only reallocated when the dimensions change
+    arma::mat Sm_work;  // square root of the covariance
+    arma::mat Xi_work;  // points, one per column
+    arma::mat Yi_work;  // model function at each point
 };
 
 
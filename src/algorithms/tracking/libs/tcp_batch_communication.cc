@@ -0,0 +1,372 @@
+/*!
+ * \file tcp_batch_communication.cc
+ * \brief Pipelined exchange of the correlator outputs of all the TCP
+ * connector tracking channels with an external loop filter, in batches
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "tcp_batch_communication.h"
+#include "gnss_shm_ring.h"
+#include <glog/logging.h>
+#include <algorithm>  // for min, all_of
+#include <chrono>     // for milliseconds, microseconds
+#include <cstring>    // for memcpy
+#include <exception>  // for exception
+#include <iostream>   // for cout
+#include <utility>    // for move
+
+static_assert(sizeof(Tcp_Batch_Header) == 16, "Unexpected size of Tcp_Batch_Header");
+static_assert(sizeof(Tcp_Batch_Correlators) == 16 + 4 * NUM_TX_VARIABLES_GALILEO_E1, "Unexpected size of Tcp_Batch_Correlators");
+static_assert(sizeof(Tcp_Batch_Command) == 8 + 4 * NUM_RX_VARIABLES, "Unexpected size of Tcp_Batch_Command");
+
+constexpr uint32_t Tcp_Batch_Header::MAGIC;
+
+namespace
+{
+constexpr std::size_t TCP_BATCH_CORRELATORS_MESSAGE_SIZE = sizeof(Tcp_Batch_Header) + TCP_BATCH_MAX_RECORDS * sizeof(Tcp_Batch_Correlators);
+constexpr std::size_t TCP_BATCH_COMMANDS_MESSAGE_SIZE = sizeof(Tcp_Batch_Header) + TCP_BATCH_MAX_RECORDS * sizeof(Tcp_Batch_Command);
+constexpr std::size_t TCP_BATCH_SHM_CAPACITY = 64;                    // messages in the ring of the receiver
+const auto TCP_BATCH_TIMEOUT = std::chrono::milliseconds(10);         // for the records of the slower channels
+const auto TCP_BATCH_COMMAND_TIMEOUT = std::chrono::milliseconds(1000);  // for a command of the loop filter
+const auto TCP_BATCH_SHM_POLL = std::chrono::microseconds(20);
+}  // namespace
+
+
+std::shared_ptr<Tcp_Batch_Communication> Tcp_Batch_Communication::get_shared(std::size_t port, const std::string& shm_name)
+{
+    static std::mutex registry_mutex;
+    static std::map<std::string, std::weak_ptr<Tcp_Batch_Communication>> registry;
+
+    const std::string key = shm_name.empty() ? "tcp:" + std::to_string(port) : "shm:" + shm_name;
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    auto shared = registry[key].lock();
+    if (!shared)
+        {
+            shared = std::make_shared<Tcp_Batch_Communication>(port, shm_name);
+            registry[key] = shared;
+        }
+    return shared;
+}
+
+
+Tcp_Batch_Communication::Tcp_Batch_Communication(std::size_t port, const std::string& shm_name)
+    : d_tx_message(TCP_BATCH_CORRELATORS_MESSAGE_SIZE),
+      d_rx_message(TCP_BATCH_COMMANDS_MESSAGE_SIZE)
+{
+    if (!shm_name.empty())
+        {
+            d_name = "/" + shm_name + "_correlators";
+            d_shm_writer = std::make_unique<Gnss_Shm_Ring_Writer>(shm_name + "_correlators", SHM_RECORD_TRK_BATCH, TCP_BATCH_CORRELATORS_MESSAGE_SIZE, TCP_BATCH_SHM_CAPACITY);
+            if (!d_shm_writer->is_open())
+                {
+                    LOG(WARNING) << "Cannot create the shared memory ring of the tracking loops: " << d_shm_writer->error();
+                    std::cerr << "Cannot create the shared memory ring of the tracking loops: " << d_shm_writer->error() << '\n';
+                    return;
+                }
+            std::cout << "Waiting for the loop filter to create the shared memory ring /" << shm_name << "_commands...\n";
+            while (true)
+                {
+                    auto reader = std::make_unique<Gnss_Shm_Ring_Reader>(shm_name + "_commands");
+                    if (reader->is_open() and !reader->writer_closed())
+                        {
+                            if (reader->record_type() != SHM_RECORD_TRK_BATCH or reader->record_size() != TCP_BATCH_COMMANDS_MESSAGE_SIZE)
+                                {
+                                    LOG(WARNING) << "The shared memory ring /" << shm_name << "_commands does not hold loop filter commands";
+                                    std::cerr << "The shared memory ring /" << shm_name << "_commands does not hold loop filter commands\n";
+                                    return;
+                                }
+                            d_shm_reader = std::move(reader);
+                            break;
+                        }
+                    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                }
+        }
+    else
+        {
+            d_name = "port " + std::to_string(port);
+            try
+                {
+                    d_io_context = std::make_unique<b_io_context>();
+                    d_socket = std::make_unique<boost::asio::ip::tcp::socket>(*d_io_context);
+                    boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::tcp::v4(), port);
+                    boost::asio::ip::tcp::acceptor acceptor(*d_io_context, endpoint);
+                    acceptor.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true));
+                    std::cout << "Server ready. Listening for the TCP connection of the loop filter on port " << port << "...\n";
+                    acceptor.listen(1);
+                    acceptor.accept(*d_socket);
+                    d_socket->set_option(boost::asio::ip::tcp::no_delay(true));
+                }
+            catch (const std::exception& e)
+                {
+                    LOG(WARNING) << "Cannot accept the TCP connection of the loop filter on port " << port << ": " << e.what();
+                    std::cerr << "Exception: " << e.what() << '\n';
+                    return;
+                }
+        }
+    std::cout << "Loop filter connected on " << (d_shm_reader ? "the shared memory ring " : "") << d_name << '\n';
+    d_connected = true;
+    d_sender = std::thread(&Tcp_Batch_Communication::run_sender, this);
+    d_receiver = std::thread(&Tcp_Batch_Communication::run_receiver, this);
+}
+
+
+Tcp_Batch_Communication::~Tcp_Batch_Communication()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_stop = true;
+    }
+    d_pending_cond.notify_all();
+    d_command_cond.notify_all();
+    if (d_socket)
+        {
+            boost::system::error_code ec;
+            d_socket->shutdown(boost::asio::ip::tcp::socket::shutdown_both, ec);  // unblocks the receiver
+        }
+    try
+        {
+            if (d_sender.joinable())
+                {
+                    d_sender.join();
+                }
+            if (d_receiver.joinable())
+                {
+                    d_receiver.join();
+                }
+            if (d_socket)
+                {
+                    d_socket->close();
+                    std::cout << "Socket closed on " << d_name << '\n';
+                }
+        }
+    catch (const std::exception& e)
+        {
+            LOG(WARNING) << "Exception closing the connection of the loop filter: " << e.what();
+        }
+}
+
+
+bool Tcp_Batch_Communication::is_connected() const
+{
+    return d_connected;
+}
+
+
+void Tcp_Batch_Communication::add_channel(uint32_t channel, uint32_t loop_latency)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_channels[channel].loop_latency = loop_latency;
+}
+
+
+void Tcp_Batch_Communication::remove_channel(uint32_t channel)
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_channels.erase(channel);
+    }
+    d_pending_cond.notify_one();  // the batch may be complete without it
+}
+
+
+void Tcp_Batch_Communication::exchange(uint32_t channel, uint32_t signal, const float* tx, std::size_t values, bool tracking, Tcp_Packet_Data* tcp_data)
+{
+    std::unique_lock<std::mutex> lock(d_mutex);
+    const auto it = d_channels.find(channel);
+    if (!d_connected or it == d_channels.end())
+        {
+            return;
+        }
+    Channel_State& state = it->second;
+
+    Tcp_Batch_Correlators record{};
+    record.channel = channel;
+    record.signal = signal;
+    record.values = static_cast<uint32_t>(std::min<std::size_t>(values, NUM_TX_VARIABLES_GALILEO_E1));
+    std::memcpy(record.tx, tx, record.values * sizeof(float));
+    if (tracking)
+        {
+            state.control_id++;
+            if (!state.tracking)
+                {
+                    state.first_control_id = state.control_id;
+                    state.tracking = true;
+                }
+            record.control_id = state.control_id;
+        }
+    else
+        {
+            state.tracking = false;
+        }
+    state.pending.push_back(record);
+    d_pending_cond.notify_one();
+
+    if (!tracking or state.control_id - state.first_control_id < state.loop_latency)
+        {
+            return;
+        }
+    const uint32_t wanted = state.control_id - state.loop_latency;
+    if (!d_command_cond.wait_for(lock, TCP_BATCH_COMMAND_TIMEOUT, [&] { return d_stop or !d_connected or state.command.control_id >= wanted; }) and d_connected)
+        {
+            LOG(WARNING) << "No command of the loop filter for channel " << channel << " after " << TCP_BATCH_COMMAND_TIMEOUT.count() << " ms";
+        }
+    if (state.command.control_id >= wanted and state.command.control_id >= state.first_control_id)
+        {
+            tcp_data->proc_pack_code_error = state.command.rx[1];
+            tcp_data->proc_pack_carr_error = state.command.rx[2];
+            tcp_data->proc_pack_carrier_doppler_hz = state.command.rx[3];
+        }
+}
+
+
+bool Tcp_Batch_Communication::batch_complete() const
+{
+    return !d_channels.empty() and std::all_of(d_channels.cbegin(), d_channels.cend(), [](const std::pair<const uint32_t, Channel_State>& ch) { return !ch.second.pending.empty(); });
+}
+
+
+void Tcp_Batch_Communication::run_sender()
+{
+    std::unique_lock<std::mutex> lock(d_mutex);
+    while (!d_stop)
+        {
+            d_pending_cond.wait_for(lock, TCP_BATCH_TIMEOUT, [this] { return d_stop or batch_complete(); });
+            if (d_stop)
+                {
+                    break;
+                }
+            // one record per channel, the oldest one
+            uint32_t records = 0;
+            for (auto& ch : d_channels)
+                {
+                    if (!ch.second.pending.empty() and records < TCP_BATCH_MAX_RECORDS)
+                        {
+                            std::memcpy(d_tx_message.data() + sizeof(Tcp_Batch_Header) + records * sizeof(Tcp_Batch_Correlators), &ch.second.pending.front(), sizeof(Tcp_Batch_Correlators));
+                            ch.second.pending.pop_front();
+                            records++;
+                        }
+                }
+            if (records == 0)
+                {
+                    continue;
+                }
+            const Tcp_Batch_Header header{Tcp_Batch_Header::MAGIC, d_batch++, records, 0};
+            std::memcpy(d_tx_message.data(), &header, sizeof(Tcp_Batch_Header));
+
+            lock.unlock();
+            const bool sent = write_message(sizeof(Tcp_Batch_Header) + records * sizeof(Tcp_Batch_Correlators));
+            lock.lock();
+            if (!sent)
+                {
+                    d_connected = false;
+                    d_command_cond.notify_all();
+                    break;
+                }
+        }
+}
+
+
+void Tcp_Batch_Communication::run_receiver()
+{
+    while (!d_stop)
+        {
+            if (!read_message())
+                {
+                    if (!d_stop)
+                        {
+                            LOG(WARNING) << "The loop filter on " << d_name << " is gone";
+                            std::cerr << "The loop filter on " << d_name << " is gone\n";
+                        }
+                    std::lock_guard<std::mutex> lock(d_mutex);
+                    d_connected = false;
+                    d_command_cond.notify_all();
+                    break;
+                }
+            Tcp_Batch_Header header{};
+            std::memcpy(&header, d_rx_message.data(), sizeof(Tcp_Batch_Header));
+            {
+                std::lock_guard<std::mutex> lock(d_mutex);
+                for (uint32_t i = 0; i < header.records; i++)
+                    {
+                        Tcp_Batch_Command command{};
+                        std::memcpy(&command, d_rx_message.data() + sizeof(Tcp_Batch_Header) + i * sizeof(Tcp_Batch_Command), sizeof(Tcp_Batch_Command));
+                        const auto it = d_channels.find(command.channel);
+                        // the replies to the records sent while not tracking are not commands
+                        if (it != d_channels.end() and command.control_id != 0 and command.control_id >= it->second.command.control_id)
+                            {
+                                it->second.command = command;
+                            }
+                    }
+            }
+            d_command_cond.notify_all();
+        }
+}
+
+
+bool Tcp_Batch_Communication::write_message(std::size_t bytes)
+{
+    if (d_shm_writer)
+        {
+            d_shm_writer->publish(d_tx_message.data());
+            return true;
+        }
+    boost::system::error_code ec;
+    boost::asio::write(*d_socket, boost::asio::buffer(d_tx_message.data(), bytes), ec);
+    if (ec)
+        {
+            LOG(WARNING) << "Error sending the correlator outputs on " << d_name << ": " << ec.message();
+            return false;
+        }
+    return true;
+}
+
+
+bool Tcp_Batch_Communication::read_message()
+{
+    Tcp_Batch_Header header{};
+    if (d_shm_reader)
+        {
+            while (!d_shm_reader->read(d_rx_message.data()))
+                {
+                    if (d_stop or d_shm_reader->writer_closed())
+                        {
+                            return false;
+                        }
+                    std::this_thread::sleep_for(TCP_BATCH_SHM_POLL);
+                }
+            std::memcpy(&header, d_rx_message.data(), sizeof(Tcp_Batch_Header));
+        }
+    else
+        {
+            boost::system::error_code ec;
+            boost::asio::read(*d_socket, boost::asio::buffer(d_rx_message.data(), sizeof(Tcp_Batch_Header)), ec);
+            if (ec)
+                {
+                    return false;
+                }
+            std::memcpy(&header, d_rx_message.data(), sizeof(Tcp_Batch_Header));
+            if (header.magic == Tcp_Batch_Header::MAGIC and header.records <= TCP_BATCH_MAX_RECORDS)
+                {
+                    boost::asio::read(*d_socket, boost::asio::buffer(d_rx_message.data() + sizeof(Tcp_Batch_Header), header.records * sizeof(Tcp_Batch_Command)), ec);
+                    if (ec)
+                        {
+                            return false;
+                        }
+                }
+        }
+    if (header.magic != Tcp_Batch_Header::MAGIC or header.records > TCP_BATCH_MAX_RECORDS)
+        {
+            LOG(WARNING) << "Message of the loop filter on " << d_name << " not valid";
+            return false;
+        }
+    return true;
+}
@@ -0,0 +1,182 @@
+/*!
+ * \file tcp_batch_communication.h
+ * \brief Pipelined exchange of the correlator outputs of all the TCP
+ * connector tracking channels with an external loop filter, in batches
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_TCP_BATCH_COMMUNICATION_H
+#define GNSS_SDR_TCP_BATCH_COMMUNICATION_H
+
+#include "tcp_communication.h"
+#include "tcp_packet_data.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/** \addtogroup Tracking
+ * \{ */
+/** \addtogroup Tracking_libs
+ * \{ */
+
+
+class Gnss_Shm_Ring_Reader;
+class Gnss_Shm_Ring_Writer;
+
+#define TCP_BATCH_MAX_RECORDS 256
+#define TCP_BATCH_SIGNAL_GPS_L1_CA 1
+#define TCP_BATCH_SIGNAL_GALILEO_E1 2
+
+/*!
+ * \brief Beginning of each message, in both directions. It is followed by
+ * records Tcp_Batch_Correlators (to the loop filter) or Tcp_Batch_Command
+ * (from the loop filter). All the fields are in the byte order of the host.
+ */
+struct Tcp_Batch_Header
+{
+    static constexpr uint32_t MAGIC = 0x47534C42;  // "GSLB"
+
+    uint32_t magic;
+    uint32_t batch;    // number of the message, from 0
+    uint32_t records;  // that follow, at most TCP_BATCH_MAX_RECORDS
+    uint32_t reserved;
+};
+
+
+/*!
+ * \brief Correlator outputs of a channel in an integration period. tx holds
+ * the packet of the non-pipelined exchange of the signal (see
+ * Tcp_Communication), padded with zeros.
+ */
+struct Tcp_Batch_Correlators
+{
+    uint32_t channel;
+    uint32_t control_id;  // from 1 in each channel, 0 while it is not tracking
+    uint32_t signal;      // TCP_BATCH_SIGNAL_GPS_L1_CA or TCP_BATCH_SIGNAL_GALILEO_E1
+    uint32_t values;      // used in tx
+    float tx[NUM_TX_VARIABLES_GALILEO_E1];
+};
+
+
+/*!
+ * \brief Reply of the loop filter to a Tcp_Batch_Correlators record, with
+ * its channel and control_id. rx is the packet of the non-pipelined
+ * exchange: control identifier, code error, carrier error and carrier
+ * Doppler [Hz].
+ */
+struct Tcp_Batch_Command
+{
+    uint32_t channel;
+    uint32_t control_id;
+    float rx[NUM_RX_VARIABLES];
+};
+
+
+/*!
+ * \brief Exchanges the correlator outputs of all the channels with an
+ * external loop filter, without waiting for each reply.
+ *
+ * The records of the channels of an integration period are sent in one
+ * message, once every channel has submitted one or after a timeout. A
+ * sender thread writes the messages and a receiver thread reads the replies,
+ * so a channel only waits if the command of loop_latency periods before is
+ * not back yet: the loop filter has loop_latency periods to reply.
+ *
+ * The transport is a TCP connection on a port, to which the loop filter
+ * connects, or a pair of shared memory rings (see Gnss_Shm_Ring_Writer) if
+ * the loop filter runs in the same host. The receiver writes the messages
+ * to /<shm_name>_correlators, and reads the replies from
+ * /<shm_name>_commands, which the loop filter creates with the same
+ * layout. In the rings, each message is a record of type
+ * SHM_RECORD_TRK_BATCH, made of a header and room for
+ * TCP_BATCH_MAX_RECORDS records.
+ */
+class Tcp_Batch_Communication
+{
+public:
+    /*!
+     * \brief Connection shared by all the channels of the same port, or of
+     * the same shm_name if it is not empty. The first call waits for the loop
+     * filter to connect (TCP) or to create its ring (shared memory).
+     */
+    static std::shared_ptr<Tcp_Batch_Communication> get_shared(std::size_t port, const std::string& shm_name);
+
+    Tcp_Batch_Communication(std::size_t port, const std::string& shm_name);
+    ~Tcp_Batch_Communication();
+
+    Tcp_Batch_Communication(const Tcp_Batch_Communication&) = delete;
+    Tcp_Batch_Communication& operator=(const Tcp_Batch_Communication&) = delete;
+
+    bool is_connected() const;
+
+    /*!
+     * \brief The messages wait for the records of the channels added
+     */
+    void add_channel(uint32_t channel, uint32_t loop_latency);
+    void remove_channel(uint32_t channel);
+
+    /*!
+     * \brief Submits the tx packet of channel for the current period. If the
+     * channel is tracking, tcp_data is then given the command of the record
+     * sent loop_latency periods before, waiting for it if needed. It is left
+     * as it is in the first loop_latency periods of the tracking, or if the
+     * loop filter does not reply.
+     */
+    void exchange(uint32_t channel, uint32_t signal, const float* tx, std::size_t values, bool tracking, Tcp_Packet_Data* tcp_data);
+
+private:
+    struct Channel_State
+    {
+        std::deque<Tcp_Batch_Correlators> pending;
+        Tcp_Batch_Command command{};  // last command received
+        uint32_t loop_latency{1};
+        uint32_t control_id{0};        // of the last record submitted
+        uint32_t first_control_id{0};  // of the current tracking
+        bool tracking{false};
+    };
+
+    bool batch_complete() const;
+    void run_sender();
+    void run_receiver();
+    bool write_message(std::size_t bytes);  // of d_tx_message
+    bool read_message();                    // into d_rx_message
+
+    std::vector<uint8_t> d_tx_message;
+    std::vector<uint8_t> d_rx_message;
+    std::map<uint32_t, Channel_State> d_channels;
+    std::unique_ptr<Gnss_Shm_Ring_Writer> d_shm_writer;
+    std::unique_ptr<Gnss_Shm_Ring_Reader> d_shm_reader;
+    std::unique_ptr<b_io_context> d_io_context;
+    std::unique_ptr<boost::asio::ip::tcp::socket> d_socket;
+    std::string d_name;
+    mutable std::mutex d_mutex;
+    std::condition_variable d_pending_cond;
+    std::condition_variable d_command_cond;
+    std::thread d_sender;
+    std::thread d_receiver;
+    uint32_t d_batch{0};
+    std::atomic<bool> d_connected{false};
+    std::atomic<bool> d_stop{false};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_TCP_BATCH_COMMUNICATION_H
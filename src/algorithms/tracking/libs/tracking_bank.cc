@@ -0,0 +1,163 @@
+/*!
+ * \file tracking_bank.cc
+ * \brief Correlator engine shared by several tracking channels. It computes
+ * the correlations of all the channels in a single pass over the input samples.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "tracking_bank.h"
+#include <algorithm>
+#include <cstddef>
+#include <map>
+
+namespace
+{
+// Samples of each block of the sweep (16 KB of gr_complex samples)
+constexpr std::uintptr_t TRACKING_BANK_BLOCK_SAMPLES = 2048;
+
+struct Bank_Job
+{
+    const Tracking_Bank::Correlation *correlation;
+    std::uintptr_t begin;  // address of the first and
+    std::uintptr_t end;    // past-the-last input samples
+    int processed;
+};
+}  // namespace
+
+
+std::shared_ptr<Tracking_Bank> Tracking_Bank::get(uint32_t bank_id, uint32_t max_wait_us)
+{
+    static std::mutex registry_mutex;
+    static std::map<uint32_t, std::weak_ptr<Tracking_Bank>> registry;
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    std::shared_ptr<Tracking_Bank> bank = registry[bank_id].lock();
+    if (bank == nullptr)
+        {
+            bank = std::make_shared<Tracking_Bank>(max_wait_us);
+            registry[bank_id] = bank;
+        }
+    return bank;
+}
+
+
+Tracking_Bank::Tracking_Bank(uint32_t max_wait_us) : d_max_wait(max_wait_us)
+{
+}
+
+
+void Tracking_Bank::join()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_members++;
+}
+
+
+void Tracking_Bank::leave()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    if (d_members > 0)
+        {
+            d_members--;
+        }
+    // the channels waiting for this one can go on
+    d_cond.notify_all();
+}
+
+
+void Tracking_Bank::correlate(const Correlation *correlations, int n_correlations)
+{
+    Request request{correlations, n_correlations, false, false};
+    std::unique_lock<std::mutex> lock(d_mutex);
+    d_pending.push_back(&request);
+    d_cond.wait_for(lock, d_max_wait, [&] { return request.taken or static_cast<int32_t>(d_pending.size()) >= d_members; });
+    if (request.taken)
+        {
+            // another channel is running this request
+            d_cond.wait(lock, [&] { return request.done; });
+            return;
+        }
+
+    // all the channels have arrived, or the time is up: run the pending requests
+    // (the vectors are reused, so that the steady state does not allocate memory)
+    thread_local std::vector<Request *> requests;
+    requests.clear();
+    requests.swap(d_pending);
+    for (auto *r : requests)
+        {
+            r->taken = true;
+        }
+    lock.unlock();
+    sweep(requests);
+    lock.lock();
+    for (auto *r : requests)
+        {
+            r->done = true;
+        }
+    d_cond.notify_all();
+}
+
+
+void Tracking_Bank::sweep(const std::vector<Request *> &requests)
+{
+    thread_local std::vector<Bank_Job> jobs;
+    jobs.clear();
+    for (const auto *r : requests)
+        {
+            for (int n = 0; n < r->n_correlations; n++)
+                {
+                    const Correlation *c = &r->correlations[n];
+                    if (c->signal_length_samples <= 0)
+                        {
+                            continue;
+                        }
+                    c->correlator->update_local_code(c->signal_length_samples, c->rem_code_phase_chips, c->code_phase_step_chips, c->code_phase_rate_step_chips);
+                    const auto begin = reinterpret_cast<std::uintptr_t>(c->sig_in);
+                    jobs.push_back({c, begin, begin + static_cast<std::uintptr_t>(c->signal_length_samples) * sizeof(std::complex<float>), 0});
+                }
+        }
+    std::sort(jobs.begin(), jobs.end(), [](const Bank_Job &a, const Bank_Job &b) { return a.begin < b.begin; });
+
+    // Sweep the input in blocks, starting each block at the first sample
+    // not processed yet, so that the gaps between input buffers are skipped
+    const std::uintptr_t block_bytes = TRACKING_BANK_BLOCK_SAMPLES * sizeof(std::complex<float>);
+    std::size_t first_pending_job = 0;
+    while (first_pending_job < jobs.size())
+        {
+            std::uintptr_t block_begin = UINTPTR_MAX;
+            for (std::size_t j = first_pending_job; j < jobs.size() and jobs[j].begin < block_begin; j++)
+                {
+                    const std::uintptr_t next_sample = jobs[j].begin + static_cast<std::uintptr_t>(jobs[j].processed) * sizeof(std::complex<float>);
+                    if (next_sample < jobs[j].end)
+                        {
+                            block_begin = std::min(block_begin, next_sample);
+                        }
+                }
+            const std::uintptr_t block_end = block_begin + block_bytes;
+            for (std::size_t j = first_pending_job; j < jobs.size() and jobs[j].begin < block_end; j++)
+                {
+                    Bank_Job &job = jobs[j];
+                    const std::uintptr_t next_sample = job.begin + static_cast<std::uintptr_t>(job.processed) * sizeof(std::complex<float>);
+                    if (next_sample >= job.end)
+                        {
+                            continue;
+                        }
+                    const auto num_samples = static_cast<int>((std::min(job.end, block_end) - next_sample) / sizeof(std::complex<float>));
+                    const Correlation *c = job.correlation;
+                    c->correlator->Carrier_wipeoff_multicorrelator_segment(c->rem_carrier_phase_in_rad, c->phase_step_rad, c->phase_rate_step_rad, job.processed, num_samples);
+                    job.processed += num_samples;
+                }
+            while (first_pending_job < jobs.size() and jobs[first_pending_job].processed == jobs[first_pending_job].correlation->signal_length_samples)
+                {
+                    first_pending_job++;
+                }
+        }
+}
@@ -0,0 +1,113 @@
+/*!
+ * \file tracking_bank.h
+ * \brief Correlator engine shared by several tracking channels. It computes
+ * the correlations of all the channels in a single pass over the input samples.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_TRACKING_BANK_H
+#define GNSS_SDR_TRACKING_BANK_H
+
+#include "cpu_multicorrelator_real_codes.h"
+#include <chrono>
+#include <complex>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/** \addtogroup Tracking
+ * \{ */
+/** \addtogroup Tracking_libs
+ * \{ */
+
+
+/*!
+ * \brief Computes the correlations of a group of tracking channels in a single
+ * cache-blocked sweep over their input samples.
+ *
+ * Each tracking channel computes its correlators over the same input stream,
+ * so with many channels the same samples are read from memory once per
+ * channel. The channels of a bank submit their correlations (correlator and
+ * NCO state) at each integration period, and the last channel to arrive runs
+ * all of them: the local codes are resampled first, and then the input is
+ * swept in blocks of 2048 samples, correlating every channel whose
+ * integration period covers the block while it is in the cache.
+ *
+ * A channel does not wait more than max_wait_us for the others: after that
+ * time, it runs the correlations submitted so far.
+ */
+class Tracking_Bank
+{
+public:
+    /*!
+     * \brief Correlation request of a channel. The input and output vectors
+     * of the correlator must have been set with set_input_output_vectors().
+     */
+    struct Correlation
+    {
+        Cpu_Multicorrelator_Real_Codes *correlator;
+        const std::complex<float> *sig_in;
+        float rem_carrier_phase_in_rad;
+        float phase_step_rad;
+        float phase_rate_step_rad;
+        float rem_code_phase_chips;
+        float code_phase_step_chips;
+        float code_phase_rate_step_chips;
+        int signal_length_samples;
+    };
+
+    /*!
+     * \brief Returns the bank bank_id, which is created if it does not exist
+     */
+    static std::shared_ptr<Tracking_Bank> get(uint32_t bank_id, uint32_t max_wait_us);
+
+    explicit Tracking_Bank(uint32_t max_wait_us);
+
+    /*!
+     * \brief A channel joins the bank when it starts tracking
+     */
+    void join();
+
+    /*!
+     * \brief A channel leaves the bank when it stops tracking
+     */
+    void leave();
+
+    /*!
+     * \brief Computes the correlations of a channel. Returns when they are done.
+     */
+    void correlate(const Correlation *correlations, int n_correlations);
+
+private:
+    struct Request
+    {
+        const Correlation *correlations;
+        int n_correlations;
+        bool taken;
+        bool done;
+    };
+
+    void sweep(const std::vector<Request *> &requests);
+
+    std::mutex d_mutex;
+    std::condition_variable d_cond;
+    std::vector<Request *> d_pending;
+    std::chrono::microseconds d_max_wait;
+    int32_t d_members{0};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_TRACKING_BANK_H
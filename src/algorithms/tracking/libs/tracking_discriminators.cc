@@ -147,3 +147,44 @@ double dll_nc_vemlp_normalized(gr_complex very_early_s1, gr_complex early_s1, gr
         }
     return (Early - Late) / E_plus_L;
 }
+
+
+/*
+ * Signal quality monitoring (SQM) metrics, from the outputs of 2 n_pairs + 1
+ * correlators at symmetric code phase shifts:
+ * \f{equation}
+ *     \Delta=\frac{I_{E}-I_{L}}{I_{P}},\quad R=\frac{I_{E}+I_{L}}{2I_{P}},\quad A=\frac{\sum|L_k|-\sum|E_k|}{\sum|L_k|+\sum|E_k|}.
+ * \f}
+ */
+void sqm_metrics(const gr_complex *taps, int n_pairs, double &delta, double &ratio, double &asymmetry)
+{
+    delta = 0.0;
+    ratio = 0.0;
+    asymmetry = 0.0;
+    if (n_pairs < 1)
+        {
+            return;
+        }
+    const gr_complex prompt = taps[n_pairs];
+    const double abs_prompt = std::abs(prompt);
+    if (abs_prompt == 0.0)
+        {
+            return;
+        }
+    // in-phase components in the carrier phase of the prompt correlator
+    const double early = static_cast<double>((taps[0] * std::conj(prompt)).real()) / abs_prompt;
+    const double late = static_cast<double>((taps[2 * n_pairs] * std::conj(prompt)).real()) / abs_prompt;
+    delta = (early - late) / abs_prompt;
+    ratio = (early + late) / (2.0 * abs_prompt);
+    double sum_early = 0.0;
+    double sum_late = 0.0;
+    for (int k = 0; k < n_pairs; k++)
+        {
+            sum_early += std::abs(taps[k]);
+            sum_late += std::abs(taps[2 * n_pairs - k]);
+        }
+    if (sum_early + sum_late > 0.0)
+        {
+            asymmetry = (sum_late - sum_early) / (sum_late + sum_early);
+        }
+}
@@ -108,6 +108,21 @@ double dll_nc_e_minus_l_normalized(gr_complex early_s1, gr_complex late_s1, floa
 double dll_nc_vemlp_normalized(gr_complex very_early_s1, gr_complex early_s1, gr_complex late_s1, gr_complex very_late_s1);
 
 
+/*! \brief Signal quality monitoring (SQM) metrics
+ *
+ * Metrics of the distortion of the correlation function, from the outputs of
+ * 2 n_pairs + 1 correlators at symmetric code phase shifts, from the earliest
+ * (taps[0]) to the latest (taps[2 n_pairs]), with the prompt one in the middle:
+ * \f{equation}
+ *     \Delta=\frac{I_{E}-I_{L}}{I_{P}},\quad R=\frac{I_{E}+I_{L}}{2I_{P}},\quad A=\frac{\sum|L_k|-\sum|E_k|}{\sum|L_k|+\sum|E_k|},
+ * \f}
+ * where \f$I_{E}\f$ and \f$I_{L}\f$ are the in-phase components of the widest
+ * early and late correlators in the carrier phase of the prompt one, and
+ * \f$I_{P}=|P|\f$. The metrics are set to 0 if the prompt correlator output is 0.
+ */
+void sqm_metrics(const gr_complex *taps, int n_pairs, double &delta, double &ratio, double &asymmetry);
+
+
 template <typename Fun>
 double CalculateSlope(Fun &&f, double x)
 {
@@ -0,0 +1,121 @@
+/*!
+ * \file tracking_kalman_filter.h
+ * \brief Linear Kalman filter of fixed dimensions for the Kalman filter based
+ * tracking loops.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_TRACKING_KALMAN_FILTER_H
+#define GNSS_SDR_TRACKING_KALMAN_FILTER_H
+
+#if ARMA_NO_BOUND_CHECKING
+#define ARMA_NO_DEBUG 1
+#endif
+
+#include <armadillo>
+
+/** \addtogroup Tracking
+ * \{ */
+/** \addtogroup Tracking_libs
+ * \{ */
+
+
+/*!
+ * \brief Kalman filter with NX states and NZ measurements, run once per
+ * integration period by each tracking channel.
+ *
+ * The matrices have their dimensions fixed at compile time, and each step is
+ * computed one product at a time into members of the filter, so that neither
+ * the filter nor the Armadillo temporaries allocate memory. The innovation
+ * covariance is inverted by division for a single measurement, and with the
+ * closed-form inverse of Armadillo for small matrices otherwise.
+ */
+template <arma::uword NX, arma::uword NZ>
+class Tracking_Kalman_Filter
+{
+public:
+    arma::mat::fixed<NX, NX> F;  //!< State transition matrix
+    arma::mat::fixed<NZ, NX> H;  //!< Measurement matrix
+    arma::mat::fixed<NX, NX> Q;  //!< Process noise covariance
+    arma::mat::fixed<NZ, NZ> R;  //!< Measurement noise covariance
+    arma::vec::fixed<NX> x;      //!< State
+    arma::mat::fixed<NX, NX> P;  //!< State error covariance
+
+    //! Time update of x and P
+    void predict()
+    {
+        d_x = F * x;
+        x = d_x;
+        d_FP = F * P;
+        P = d_FP * F.t();
+        P += Q;
+    }
+
+    //! Innovation covariance H * P * H' + R of the predicted state
+    const arma::mat::fixed<NZ, NZ>& innovation_covariance()
+    {
+        d_HP = H * P;
+        d_S = d_HP * H.t();
+        d_S += R;
+        return d_S;
+    }
+
+    //! Measurement update with the innovation y (the discriminator outputs)
+    void update(const arma::vec::fixed<NZ>& y)
+    {
+        update(y, innovation_covariance());
+    }
+
+    //! Measurement update with the innovation y, of covariance S
+    void update(const arma::vec::fixed<NZ>& y, const arma::mat::fixed<NZ, NZ>& S)
+    {
+        d_PHt = P * H.t();
+        if (NZ == 1)
+            {
+                d_K = d_PHt * (1.0 / S(0, 0));
+            }
+        else
+            {
+                arma::inv(d_Sinv, S);
+                d_K = d_PHt * d_Sinv;
+            }
+        d_x = d_K * y;
+        x += d_x;
+        d_HP = H * P;
+        d_FP = d_K * d_HP;
+        P -= d_FP;  // (I - K * H) * P
+    }
+
+    //! Measurement update with a direct measurement of the state i
+    void update_state(arma::uword i, double measurement, double variance)
+    {
+        const double innovation = measurement - x(i);
+        d_x = P.col(i) * (1.0 / (P(i, i) + variance));
+        x += d_x * innovation;
+        d_FP = d_x * P.row(i);
+        P -= d_FP;
+    }
+
+private:
+    arma::vec::fixed<NX> d_x;
+    arma::mat::fixed<NX, NX> d_FP;
+    arma::mat::fixed<NZ, NX> d_HP;
+    arma::mat::fixed<NX, NZ> d_PHt;
+    arma::mat::fixed<NX, NZ> d_K;
+    arma::mat::fixed<NZ, NZ> d_S;
+    arma::mat::fixed<NZ, NZ> d_Sinv;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_TRACKING_KALMAN_FILTER_H
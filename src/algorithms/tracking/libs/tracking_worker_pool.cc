@@ -0,0 +1,114 @@
+/*!
+ * \file tracking_worker_pool.cc
+ * \brief Fixed number of worker slots shared by the tracking channels, which
+ * bounds how many of them run at the same time.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "tracking_worker_pool.h"
+#include <thread>
+#include <utility>
+
+namespace
+{
+std::mutex global_pool_mutex;
+std::shared_ptr<Tracking_Worker_Pool> global_pool;
+}  // namespace
+
+
+Tracking_Worker_Pool::Slot::Slot(Tracking_Worker_Pool *pool) : d_pool(pool)
+{
+    if (d_pool != nullptr)
+        {
+            d_pool->acquire();
+        }
+}
+
+
+Tracking_Worker_Pool::Slot::~Slot()
+{
+    if (d_pool != nullptr)
+        {
+            d_pool->release();
+        }
+}
+
+
+Tracking_Worker_Pool::Tracking_Worker_Pool(uint32_t num_workers)
+{
+    if (num_workers == 0)
+        {
+            num_workers = std::thread::hardware_concurrency();
+        }
+    d_size = num_workers == 0 ? 1 : num_workers;
+    d_free = d_size;
+}
+
+
+void Tracking_Worker_Pool::acquire()
+{
+    std::unique_lock<std::mutex> lock(d_mutex);
+    if (d_free > 0 and d_waiters.empty())
+        {
+            d_free--;
+            return;
+        }
+    Waiter waiter;
+    d_waiters.push_back(&waiter);
+    d_waits++;
+    waiter.cond.wait(lock, [&waiter] { return waiter.granted; });
+}
+
+
+void Tracking_Worker_Pool::release()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    if (d_waiters.empty())
+        {
+            d_free++;
+            return;
+        }
+    // the slot goes straight to the oldest waiter, so that it cannot be
+    // taken by a channel that arrives later
+    Waiter *next = d_waiters.front();
+    d_waiters.pop_front();
+    next->granted = true;
+    next->cond.notify_one();
+}
+
+
+size_t Tracking_Worker_Pool::waiting() const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_waiters.size();
+}
+
+
+uint64_t Tracking_Worker_Pool::waits() const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_waits;
+}
+
+
+void Tracking_Worker_Pool::set_global_instance(std::shared_ptr<Tracking_Worker_Pool> pool)
+{
+    std::lock_guard<std::mutex> lock(global_pool_mutex);
+    global_pool = std::move(pool);
+}
+
+
+std::shared_ptr<Tracking_Worker_Pool> Tracking_Worker_Pool::global_instance()
+{
+    std::lock_guard<std::mutex> lock(global_pool_mutex);
+    return global_pool;
+}
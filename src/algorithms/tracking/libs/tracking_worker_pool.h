@@ -0,0 +1,112 @@
+/*!
+ * \file tracking_worker_pool.h
+ * \brief Fixed number of worker slots shared by the tracking channels, which
+ * bounds how many of them run at the same time.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_TRACKING_WORKER_POOL_H
+#define GNSS_SDR_TRACKING_WORKER_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+/** \addtogroup Tracking
+ * \{ */
+/** \addtogroup Tracking_libs
+ * \{ */
+
+
+/*!
+ * \brief Pool of worker slots of the tracking channels.
+ *
+ * The GNU Radio scheduler runs each tracking block in its own thread, so
+ * with hundreds of channels there are many more runnable threads than
+ * cores, and the kernel preempts channels in the middle of their
+ * integration periods. A channel holds a slot of the pool while it
+ * processes its input, so that at most size() channels run at a time, each
+ * one until it finishes its work, and the others sleep. The slots are
+ * handed over in the order in which they were requested.
+ *
+ * The pool is owned by the flow graph, which publishes it through
+ * set_global_instance() so that the tracking blocks can find it.
+ */
+class Tracking_Worker_Pool
+{
+public:
+    /*!
+     * \brief Holds a slot of pool during its lifetime. A null pool does
+     * nothing.
+     */
+    class Slot
+    {
+    public:
+        explicit Slot(Tracking_Worker_Pool *pool);
+        ~Slot();
+        Slot(const Slot &) = delete;
+        Slot &operator=(const Slot &) = delete;
+
+    private:
+        Tracking_Worker_Pool *d_pool;
+    };
+
+    /*!
+     * \brief Creates the pool. If num_workers is 0, the number of
+     * hardware threads is used.
+     */
+    explicit Tracking_Worker_Pool(uint32_t num_workers = 0);
+
+    Tracking_Worker_Pool(const Tracking_Worker_Pool &) = delete;
+    Tracking_Worker_Pool &operator=(const Tracking_Worker_Pool &) = delete;
+
+    //! Waits for a free slot
+    void acquire();
+
+    //! Frees a slot, or hands it over to the oldest waiting channel
+    void release();
+
+    inline uint32_t size() const
+    {
+        return d_size;
+    }
+
+    //! Channels waiting for a slot
+    size_t waiting() const;
+
+    //! Times a channel had to wait for a slot
+    uint64_t waits() const;
+
+    static void set_global_instance(std::shared_ptr<Tracking_Worker_Pool> pool);
+    static std::shared_ptr<Tracking_Worker_Pool> global_instance();
+
+private:
+    struct Waiter
+    {
+        std::condition_variable cond;
+        bool granted{false};
+    };
+
+    std::deque<Waiter *> d_waiters;
+    mutable std::mutex d_mutex;
+    uint64_t d_waits{0};
+    uint32_t d_size;
+    uint32_t d_free;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_TRACKING_WORKER_POOL_H
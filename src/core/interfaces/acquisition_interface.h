@@ -60,6 +60,10 @@ public:
     {
         return;
     }
+    virtual void set_code_phase_assistance(double code_epoch_s __attribute__((unused)), double code_period_s __attribute__((unused)))
+    {
+        return;
+    }
     virtual void init() = 0;
     virtual void set_local_code() = 0;
     virtual void set_state(int state) = 0;
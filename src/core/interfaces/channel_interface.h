@@ -25,6 +25,7 @@
 
 #include "gnss_block_interface.h"
 #include "gnss_signal.h"
+#include <cstdint>
 
 /** \addtogroup Core
  * \{ */
@@ -52,6 +53,16 @@ public:
     virtual Gnss_Signal get_signal() const = 0;
     virtual void start_acquisition() = 0;
     virtual void assist_acquisition_doppler(double Carrier_Doppler_hz) = 0;
+    virtual void assist_acquisition_code_phase(double code_epoch_s, double code_period_s) = 0;
+    /*!
+     * \brief Starts tracking without acquisition, at a code epoch predicted
+     * at sample_stamp with a carrier Doppler of Carrier_Doppler_hz. Returns
+     * false if the channel cannot do it.
+     */
+    virtual bool start_tracking_handover(uint64_t sample_stamp __attribute__((unused)), double Carrier_Doppler_hz __attribute__((unused)))
+    {
+        return false;
+    }
     virtual void stop_channel() = 0;
     virtual void set_signal(const Gnss_Signal&) = 0;
 };
@@ -26,6 +26,7 @@
 #include "galileo_almanac.h"
 #include "galileo_ephemeris.h"
 #include "gnss_block_interface.h"
+#include "gnss_receiver_snapshot.h"
 #include "gps_almanac.h"
 #include "gps_ephemeris.h"
 #include <map>
@@ -61,6 +62,12 @@ public:
         double* ground_speed_kmh,
         double* course_over_ground_deg,
         time_t* UTC_time) = 0;
+
+    /*!
+     * \brief Copies the navigation data, the last position fix and the
+     * receiver clock drift to snapshot
+     */
+    virtual void get_receiver_snapshot(Gnss_Receiver_Snapshot& snapshot) const = 0;
 };
 
 
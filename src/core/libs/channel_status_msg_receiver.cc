@@ -71,9 +71,11 @@ void channel_status_msg_receiver::msg_handler_channel_status(const pmt::pmt_t& m
             if (msg_type_hash_code == typeid(std::shared_ptr<Gnss_Synchro>).hash_code())
                 {
                     const auto gnss_synchro_obj = wht::any_cast<std::shared_ptr<Gnss_Synchro>>(pmt::any_ref(msg));
+                    unindex_channel(gnss_synchro_obj->Channel_ID);
                     if (gnss_synchro_obj->Flag_valid_pseudorange == true)
                         {
                             d_channel_status_map[gnss_synchro_obj->Channel_ID] = gnss_synchro_obj;
+                            d_signal_channels[signal_key(gnss_synchro_obj->System, gnss_synchro_obj->Signal, gnss_synchro_obj->PRN)].insert(gnss_synchro_obj->Channel_ID);
                         }
                     else
                         {
@@ -116,8 +118,47 @@ std::map<int, std::shared_ptr<Gnss_Synchro>> channel_status_msg_receiver::get_cu
 }
 
 
+bool channel_status_msg_receiver::get_signal_status(char system, const std::string& signal, uint32_t prn, Gnss_Synchro& status)
+{
+    gr::thread::scoped_lock lock(d_setlock);  // require mutex with msg_handler_channel_status function called by the scheduler
+    const auto channels = d_signal_channels.find(signal_key(system, signal.c_str(), prn));
+    if (channels == d_signal_channels.end())
+        {
+            return false;
+        }
+    status = *d_channel_status_map.at(*channels->second.begin());
+    return true;
+}
+
+
 Monitor_Pvt channel_status_msg_receiver::get_current_status_pvt()
 {
     gr::thread::scoped_lock lock(d_setlock);  // require mutex with msg_handler_channel_status function called by the scheduler
     return d_pvt_status;
 }
+
+
+void channel_status_msg_receiver::unindex_channel(int channel_id)
+{
+    const auto current_status = d_channel_status_map.find(channel_id);
+    if (current_status == d_channel_status_map.end())
+        {
+            return;
+        }
+    const auto& gnss_synchro = current_status->second;
+    const auto channels = d_signal_channels.find(signal_key(gnss_synchro->System, gnss_synchro->Signal, gnss_synchro->PRN));
+    if (channels != d_signal_channels.end())
+        {
+            channels->second.erase(channel_id);
+            if (channels->second.empty())
+                {
+                    d_signal_channels.erase(channels);
+                }
+        }
+}
+
+
+std::pair<std::string, uint32_t> channel_status_msg_receiver::signal_key(char system, const char* signal, uint32_t prn)
+{
+    return {std::string(1, system) + std::string(signal), prn};
+}
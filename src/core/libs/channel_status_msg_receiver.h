@@ -23,8 +23,12 @@
 #include "monitor_pvt.h"
 #include <gnuradio/block.h>
 #include <pmt/pmt.h>
+#include <cstdint>
 #include <map>
 #include <memory>
+#include <set>
+#include <string>
+#include <utility>
 
 /** \addtogroup Core
  * \{ */
@@ -51,6 +55,13 @@ public:
      */
     std::map<int, std::shared_ptr<Gnss_Synchro>> get_current_status_map();
 
+    /*!
+     * \brief Copies to status the current status of a channel with valid
+     * telemetry of the signal (e.g., "1C") of the satellite, and returns
+     * whether there is any, without copying the status map
+     */
+    bool get_signal_status(char system, const std::string& signal, uint32_t prn, Gnss_Synchro& status);
+
     /*!
      * \brief return the current receiver PVT
      */
@@ -60,8 +71,11 @@ private:
     friend channel_status_msg_receiver_sptr channel_status_msg_receiver_make();
     channel_status_msg_receiver();
     void msg_handler_channel_status(const pmt::pmt_t& msg);
+    void unindex_channel(int channel_id);
+    static std::pair<std::string, uint32_t> signal_key(char system, const char* signal, uint32_t prn);
     Monitor_Pvt d_pvt_status{};
     std::map<int, std::shared_ptr<Gnss_Synchro>> d_channel_status_map;
+    std::map<std::pair<std::string, uint32_t>, std::set<int>> d_signal_channels;  // channels of each system, signal and PRN
 };
 
 
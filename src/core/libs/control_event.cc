@@ -0,0 +1,42 @@
+/*!
+ * \file control_event.cc
+ * \brief Compact event of the receiver control plane, carried by the
+ * control queue without allocating objects for each event
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "control_event.h"
+#include <unordered_map>
+
+
+constexpr uint16_t Control_Event::tag;
+
+
+pmt::pmt_t control_event_pmt(Control_Event::Kind kind, uint32_t id, uint16_t event_type)
+{
+    // the pmt objects are immutable, so the consumer can hold them while
+    // the producer pushes them again
+    thread_local std::unordered_map<uint64_t, pmt::pmt_t> messages;
+    const uint64_t packed = Control_Event{kind, id, event_type}.pack();
+    auto it = messages.find(packed);
+    if (it == messages.end())
+        {
+            it = messages.emplace(packed, pmt::from_uint64(packed)).first;
+        }
+    return it->second;
+}
+
+
+bool control_event_from_pmt(const pmt::pmt_t& msg, Control_Event& event)
+{
+    return pmt::is_uint64(msg) and Control_Event::unpack(pmt::to_uint64(msg), event);
+}
@@ -0,0 +1,86 @@
+/*!
+ * \file control_event.h
+ * \brief Compact event of the receiver control plane, carried by the
+ * control queue without allocating objects for each event
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_CONTROL_EVENT_H
+#define GNSS_SDR_CONTROL_EVENT_H
+
+#include <pmt/pmt.h>
+#include <cstdint>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver_Library core_libs
+ * \{ */
+
+
+/*!
+ * \brief Event of the control plane: a channel event (same meaning as
+ * Channel_Event) or a command event (same meaning as Command_Event).
+ *
+ * The event is packed in 64 bits: a tag and the kind in the upper 16 bits,
+ * the event type in the next 16 bits and the channel or command id in the
+ * lower 32 bits.
+ */
+struct Control_Event
+{
+    enum Kind : uint8_t
+    {
+        channel = 1,
+        command = 2
+    };
+
+    Kind kind;
+    uint32_t id;          //!< Channel id or command id
+    uint16_t event_type;  //!< What happened, see GNSSFlowgraph::apply_action
+
+    uint64_t pack() const
+    {
+        return (static_cast<uint64_t>(tag | kind) << 48) | (static_cast<uint64_t>(event_type) << 32) | id;
+    }
+
+    //! Returns false if packed is not a packed event
+    static bool unpack(uint64_t packed, Control_Event& event)
+    {
+        const auto upper = static_cast<uint16_t>(packed >> 48);
+        if ((upper & 0xFF00U) != tag or ((upper & 0xFFU) != channel and (upper & 0xFFU) != command))
+            {
+                return false;
+            }
+        event.kind = static_cast<Kind>(upper & 0xFFU);
+        event.event_type = static_cast<uint16_t>(packed >> 32);
+        event.id = static_cast<uint32_t>(packed);
+        return true;
+    }
+
+    static constexpr uint16_t tag = 0xCE00U;
+};
+
+
+/*!
+ * \brief Message of the control queue for the event. The messages of each
+ * event are created once per thread and shared by all its pushes, so
+ * sending the same event again does not allocate anything but the queue
+ * node.
+ */
+pmt::pmt_t control_event_pmt(Control_Event::Kind kind, uint32_t id, uint16_t event_type);
+
+//! Returns false if msg is not a control event message
+bool control_event_from_pmt(const pmt::pmt_t& msg, Control_Event& event);
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_CONTROL_EVENT_H
@@ -25,7 +25,8 @@
 #include "reed_solomon.h"           // for ReedSolomon
 #include <glog/logging.h>           // for DLOG
 #include <gnuradio/io_signature.h>  // for gr::io_signature::make
-#include <algorithm>                // for std::find, std::count
+#include <algorithm>                // for std::find, std::count, std::copy, std::equal
+#include <array>                    // for std::array
 #include <cstddef>                  // for size_t
 #include <iterator>                 // for std::back_inserter
 #include <sstream>                  // for std::stringstream
@@ -76,6 +77,7 @@ galileo_e6_has_msg_receiver::galileo_e6_has_msg_receiver() : gr::block("galileo_
 
     // Reserve memory for decoding matrices and received PIDs
     d_C_matrix = std::vector<std::vector<std::vector<uint8_t>>>(GALILEO_CNAV_INFORMATION_VECTOR_LENGTH, std::vector<std::vector<uint8_t>>(GALILEO_CNAV_MAX_NUMBER_SYMBOLS_ENCODED_BLOCK, std::vector<uint8_t>(GALILEO_CNAV_OCTETS_IN_SUBPAGE)));  // 32 x 255 x 53
+    d_decoded_C_matrix = std::vector<std::vector<std::vector<uint8_t>>>(HAS_MSG_NUMBER_MESSAGE_IDS);
     d_M_matrix = std::vector<std::vector<uint8_t>>(GALILEO_CNAV_INFORMATION_VECTOR_LENGTH, std::vector<uint8_t>(GALILEO_CNAV_OCTETS_IN_SUBPAGE));                                                                                                 // HAS message matrix 32 x 53
     d_received_pids = std::vector<std::vector<uint8_t>>(HAS_MSG_NUMBER_MESSAGE_IDS, std::vector<uint8_t>());
 
@@ -94,6 +96,30 @@ galileo_e6_has_msg_receiver::galileo_e6_has_msg_receiver() : gr::block("galileo_
     d_nav_msg_packet.signal = std::string("E6");
     d_nav_msg_packet.prn = 0;
     d_nav_msg_packet.tow_at_current_symbol_ms = 0;
+
+    // HAS pages are assembled and decoded out of the message handler
+    d_worker = std::thread(&galileo_e6_has_msg_receiver::run_worker, this);
+}
+
+
+galileo_e6_has_msg_receiver::~galileo_e6_has_msg_receiver()
+{
+    try
+        {
+            {
+                std::lock_guard<std::mutex> lock(d_pending_pages_mutex);
+                d_stop_worker = true;
+            }
+            d_pending_pages_cond.notify_one();
+            if (d_worker.joinable())
+                {
+                    d_worker.join();
+                }
+        }
+    catch (const std::exception& e)
+        {
+            LOG(WARNING) << "Error stopping the HAS decoding thread: " << e.what();
+        }
 }
 
 
@@ -105,8 +131,6 @@ void galileo_e6_has_msg_receiver::set_enable_navdata_monitor(bool enable)
 
 void galileo_e6_has_msg_receiver::msg_handler_galileo_e6_has(const pmt::pmt_t& msg)
 {
-    gr::thread::scoped_lock lock(d_setlock);  // require mutex with msg_handler_galileo_e6_has function called by the scheduler
-
     try
         {
             const size_t msg_type_hash_code = pmt::any_ref(msg).type().hash_code();
@@ -119,9 +143,12 @@ void galileo_e6_has_msg_receiver::msg_handler_galileo_e6_has(const pmt::pmt_t& m
                                << "MID: " << static_cast<float>(HAS_data_page->message_id) << ", "
                                << "MS: " << static_cast<float>(HAS_data_page->message_size) << ", "
                                << "PID: " << static_cast<float>(HAS_data_page->message_page_id);
-                    d_current_has_status = HAS_data_page->has_status;
-                    d_current_message_id = HAS_data_page->message_id;
-                    process_HAS_page(*HAS_data_page.get());
+                    // queue the page for the worker thread
+                    {
+                        std::lock_guard<std::mutex> lock(d_pending_pages_mutex);
+                        d_pending_pages.push_back(HAS_data_page);
+                    }
+                    d_pending_pages_cond.notify_one();
                 }
             else
                 {
@@ -132,42 +159,82 @@ void galileo_e6_has_msg_receiver::msg_handler_galileo_e6_has(const pmt::pmt_t& m
         {
             LOG(WARNING) << "galileo_e6_has_msg_receiver Bad any_cast: " << e.what();
         }
+}
+
 
-    //  Send the resulting decoded HAS data (if available) to PVT
-    if (d_new_message == true)
+void galileo_e6_has_msg_receiver::run_worker()
+{
+    while (true)
         {
-            d_HAS_data.has_status = d_current_has_status;
-            d_HAS_data.message_id = d_current_message_id;
-            auto has_data_ptr = std::make_shared<Galileo_HAS_data>(d_HAS_data);
-            this->message_port_pub(pmt::mp("E6_HAS_to_PVT"), pmt::make_any(has_data_ptr));
-            d_new_message = false;
-            DLOG(INFO) << "HAS message sent to the PVT block through the E6_HAS_to_PVT async message port";
+            std::shared_ptr<Galileo_HAS_page> has_page;
+            {
+                std::unique_lock<std::mutex> lock(d_pending_pages_mutex);
+                d_pending_pages_cond.wait(lock, [this] { return d_stop_worker || !d_pending_pages.empty(); });
+                if (d_stop_worker)
+                    {
+                        return;
+                    }
+                has_page = std::move(d_pending_pages.front());
+                d_pending_pages.pop_front();
+            }
+            d_current_has_status = has_page->has_status;
+            d_current_message_id = has_page->message_id;
+            process_HAS_page(*has_page);
+
+            //  Send the resulting decoded HAS data (if available) to PVT
+            if (d_new_message == true)
+                {
+                    d_HAS_data.has_status = d_current_has_status;
+                    d_HAS_data.message_id = d_current_message_id;
+                    auto has_data_ptr = std::make_shared<Galileo_HAS_data>(d_HAS_data);
+                    this->message_port_pub(pmt::mp("E6_HAS_to_PVT"), pmt::make_any(has_data_ptr));
+                    d_new_message = false;
+                    DLOG(INFO) << "HAS message sent to the PVT block through the E6_HAS_to_PVT async message port";
+                }
         }
 }
 
 
 void galileo_e6_has_msg_receiver::process_HAS_page(const Galileo_HAS_page& has_page)
 {
-    if (has_page.has_status == 0 || has_page.has_status == 1)
+    constexpr int bits_in_octet = 8;
+    const std::string& page_string = has_page.has_message_string;
+    if ((has_page.has_status == 0 || has_page.has_status == 1) && page_string.size() >= GALILEO_CNAV_OCTETS_IN_SUBPAGE * bits_in_octet)
         {
-            std::string page_string(has_page.has_message_string);
             if (has_page.message_page_id != 0)  // PID=0 is reserved, ignore it
                 {
                     if (has_page.message_type == 1)  // contains satellite corrections
                         {
                             if (has_page.message_id < HAS_MSG_NUMBER_MESSAGE_IDS)  // MID range is from 0 to 31
                                 {
+                                    std::array<uint8_t, GALILEO_CNAV_OCTETS_IN_SUBPAGE> page_octets{};
+                                    for (int k = 0; k < GALILEO_CNAV_OCTETS_IN_SUBPAGE; k++)
+                                        {
+                                            uint8_t octet = 0;
+                                            for (int b = 0; b < bits_in_octet; b++)
+                                                {
+                                                    octet = static_cast<uint8_t>((octet << 1) | (page_string[k * bits_in_octet + b] == '1' ? 1 : 0));
+                                                }
+                                            page_octets[k] = octet;
+                                        }
+
+                                    // A message is broadcast again until its content changes. Its pages are
+                                    // compared to the last decoded codewords of that message ID, which are
+                                    // reused if all of them are the same.
+                                    auto& decoded = d_decoded_C_matrix[has_page.message_id];
+                                    if (!decoded.empty() && !std::equal(page_octets.begin(), page_octets.end(), decoded[has_page.message_page_id - 1].begin()))
+                                        {
+                                            // New message content, start again
+                                            decoded.clear();
+                                            d_received_pids[has_page.message_id].clear();
+                                            d_C_matrix[has_page.message_id] = std::vector<std::vector<uint8_t>>(GALILEO_CNAV_MAX_NUMBER_SYMBOLS_ENCODED_BLOCK, std::vector<uint8_t>(GALILEO_CNAV_OCTETS_IN_SUBPAGE));
+                                        }
+
                                     if (std::find(d_received_pids[has_page.message_id].begin(), d_received_pids[has_page.message_id].end(), has_page.message_page_id) == d_received_pids[has_page.message_id].end())
                                         {
                                             // New pid! Annotate it.
                                             d_received_pids[has_page.message_id].push_back(has_page.message_page_id);
-                                            for (int k = 0; k < GALILEO_CNAV_OCTETS_IN_SUBPAGE; k++)
-                                                {
-                                                    constexpr int bits_in_octet = 8;
-                                                    std::string bits8 = page_string.substr(k * bits_in_octet, bits_in_octet);
-                                                    std::bitset<bits_in_octet> bs(bits8);
-                                                    d_C_matrix[has_page.message_id][has_page.message_page_id - 1][k] = static_cast<uint8_t>(bs.to_ulong());
-                                                }
+                                            std::copy(page_octets.begin(), page_octets.end(), d_C_matrix[has_page.message_id][has_page.message_page_id - 1].begin());
                                         }
                                 }
                         }
@@ -235,6 +302,7 @@ int galileo_e6_has_msg_receiver::decode_message_type1(uint8_t message_id, uint8_
             LOG(ERROR) << msg;
             d_received_pids[message_id].clear();
             d_C_matrix[message_id] = {GALILEO_CNAV_MAX_NUMBER_SYMBOLS_ENCODED_BLOCK, std::vector<uint8_t>(GALILEO_CNAV_OCTETS_IN_SUBPAGE)};
+            d_decoded_C_matrix[message_id].clear();
             return -1;
         }
 
@@ -242,36 +310,31 @@ int galileo_e6_has_msg_receiver::decode_message_type1(uint8_t message_id, uint8_
     DLOG(INFO) << debug_print_vector("erasure_positions", erasure_positions);
     DLOG(INFO) << debug_print_matrix("C_matrix", d_C_matrix[message_id]);
 
-    // Reset HAS decoded message matrix
-    d_M_matrix = std::vector<std::vector<uint8_t>>(GALILEO_CNAV_INFORMATION_VECTOR_LENGTH, std::vector<uint8_t>(GALILEO_CNAV_OCTETS_IN_SUBPAGE));
-
-    // Vertical decoding of d_C_matrix
-    for (int col = 0; col < GALILEO_CNAV_OCTETS_IN_SUBPAGE; col++)
+    std::vector<std::vector<uint8_t>> C_matrix;
+    if (!d_decoded_C_matrix[message_id].empty())
         {
-            std::vector<uint8_t> C_column(GALILEO_CNAV_MAX_NUMBER_SYMBOLS_ENCODED_BLOCK);
-            for (auto pid : d_received_pids[message_id])
-                {
-                    C_column[pid - 1] = d_C_matrix[message_id][pid - 1][col];
-                }
-
-            int result = d_rs->decode(C_column, erasure_positions);
-
+            // All the pages are those of the last message decoded with this ID
+            C_matrix = d_decoded_C_matrix[message_id];
+        }
+    else
+        {
+            // Vertical decoding of d_C_matrix. The rows of the pages not received are zeros.
+            C_matrix = std::move(d_C_matrix[message_id]);
+            const int result = d_rs->decode_columns(C_matrix, erasure_positions);
             if (result < 0)
                 {
                     DLOG(ERROR) << "Decoding of HAS page failed";
+                    d_C_matrix[message_id] = std::vector<std::vector<uint8_t>>(GALILEO_CNAV_MAX_NUMBER_SYMBOLS_ENCODED_BLOCK, std::vector<uint8_t>(GALILEO_CNAV_OCTETS_IN_SUBPAGE));
+                    d_received_pids[message_id].clear();
                     return -1;
                 }
-
-            std::vector<uint8_t> M_column(C_column.begin(), C_column.begin() + GALILEO_CNAV_INFORMATION_VECTOR_LENGTH);
-            for (int i = 0; i < GALILEO_CNAV_INFORMATION_VECTOR_LENGTH; i++)
-                {
-                    d_M_matrix[i][col] = M_column[i];
-                }
-
-            DLOG(INFO) << debug_print_vector("C_column entering the decoder", C_column);
             DLOG(INFO) << "Successful HAS page decoding";
+            d_decoded_C_matrix[message_id] = C_matrix;
         }
 
+    // The HAS decoded message matrix is made of the first rows
+    d_M_matrix = std::vector<std::vector<uint8_t>>(C_matrix.begin(), C_matrix.begin() + GALILEO_CNAV_INFORMATION_VECTOR_LENGTH);
+
     DLOG(INFO) << debug_print_matrix("M_matrix", d_M_matrix);
 
     // Form the decoded HAS message by reading rows of d_M_matrix
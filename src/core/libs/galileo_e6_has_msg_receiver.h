@@ -27,9 +27,13 @@
 #include <gnuradio/block.h>        // for gr::block
 #include <pmt/pmt.h>               // for pmt::pmt_t
 #include <bitset>
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
 #include <memory>  // for std::unique_ptr
+#include <mutex>
 #include <string>
+#include <thread>
 #include <utility>  // std::pair
 #include <vector>
 
@@ -50,12 +54,13 @@ galileo_e6_has_msg_receiver_sptr galileo_e6_has_msg_receiver_make();
  * \brief GNU Radio block that receives asynchronous Galileo HAS message pages
  * from the telemetry blocks, stores them in memory, and decodes HAS messages
  * when enough data have been received.
- * The decoded HAS message is sent to the PVT block.
+ * The pages are assembled and decoded in a worker thread, so the message
+ * handler only queues them. The decoded HAS message is sent to the PVT block.
  */
 class galileo_e6_has_msg_receiver : public gr::block
 {
 public:
-    ~galileo_e6_has_msg_receiver() = default;  //!< Default destructor
+    ~galileo_e6_has_msg_receiver();  //!< Destructor, stops the worker thread
     void set_enable_navdata_monitor(bool enable);
 
 private:
@@ -63,6 +68,7 @@ private:
     galileo_e6_has_msg_receiver();
 
     void msg_handler_galileo_e6_has(const pmt::pmt_t& msg);
+    void run_worker();
     void process_HAS_page(const Galileo_HAS_page& has_page);
     void read_MT1_header(const std::string& message_header);
     void read_MT1_body(const std::string& message_body);
@@ -90,6 +96,7 @@ private:
 
     // Store decoding matrices and received PIDs
     std::vector<std::vector<std::vector<uint8_t>>> d_C_matrix;
+    std::vector<std::vector<std::vector<uint8_t>>> d_decoded_C_matrix;  // last decoded codewords of each message ID, empty if none
     std::vector<std::vector<uint8_t>> d_M_matrix;
     std::vector<std::vector<uint8_t>> d_received_pids;
 
@@ -103,10 +110,17 @@ private:
     std::vector<uint8_t> d_nsys_in_mask;
     std::vector<std::vector<uint8_t>> d_nav_message_mask;
 
+    // Pages waiting for the worker thread
+    std::deque<std::shared_ptr<Galileo_HAS_page>> d_pending_pages;
+    std::mutex d_pending_pages_mutex;
+    std::condition_variable d_pending_pages_cond;
+    std::thread d_worker;
+
     uint8_t d_current_has_status{};
     uint8_t d_current_message_id{};
     bool d_new_message{};
     bool d_enable_navdata_monitor{};
+    bool d_stop_worker{};
 };
 
 
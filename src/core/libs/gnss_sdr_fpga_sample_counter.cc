@@ -68,6 +68,7 @@ gnss_sdr_fpga_sample_counter::gnss_sdr_fpga_sample_counter(
 {
     message_port_register_out(pmt::mp("fpga_sample_counter"));
     set_max_noutput_items(1);
+    sample_clock = Gnss_Sample_Clock::global_instance();
     samples_per_output = std::round(fs * static_cast<double>(interval_ms) / 1e3);
     samples_per_report = std::round(fs * static_cast<double>(report_interval_ms) / 1e3);
     open_device();
@@ -268,6 +269,7 @@ int gnss_sdr_fpga_sample_counter::general_work(int noutput_items __attribute__((
         }
     out[0].Tracking_sample_counter = sample_counter;
     current_T_rx_ms = interval_ms * (sample_counter) / samples_per_output;
+    sample_clock->publish(sample_counter);
     return 1;
 }
 
@@ -20,9 +20,11 @@
 #define GNSS_SDR_GNSS_SDR_FPGA_SAMPLE_COUNTER_H
 
 #include "gnss_block_interface.h"
+#include "gnss_sample_clock.h"
 #include <gnuradio/block.h>
 #include <gnuradio/types.h>  // for gr_vector_const_void_star
 #include <cstdint>
+#include <memory>
 #include <string>
 
 /** \addtogroup Core
@@ -64,6 +66,8 @@ private:
 
     volatile uint32_t *map_base;  // driver memory map
 
+    std::shared_ptr<Gnss_Sample_Clock> sample_clock;  // epochs for the observables block
+
     double fs;
     uint64_t sample_counter;
     uint64_t last_sample_counter;
@@ -16,11 +16,12 @@
  */
 
 #include "gnss_sdr_sample_counter.h"
-#include "gnss_synchro.h"
 #include "gnss_time.h"
 #include <gnuradio/io_signature.h>
 #include <pmt/pmt.h>        // for from_double
 #include <pmt/pmt_sugar.h>  // for mp
+#include <algorithm>        // for std::lower_bound
+#include <cassert>          // for assert
 #include <cmath>            // for round
 #include <iostream>         // for operator<<
 #include <memory>
@@ -32,10 +33,10 @@ gnss_sdr_sample_counter::gnss_sdr_sample_counter(
     double _fs,
     int32_t _interval_ms,
     size_t _size)
-    : gr::sync_decimator("sample_counter",
+    : gr::sync_block("sample_counter",
           gr::io_signature::make(1, 1, _size),
-          gr::io_signature::make(1, 1, sizeof(Gnss_Synchro)),
-          static_cast<uint32_t>(std::round(_fs * static_cast<double>(_interval_ms) / 1e3))),
+          gr::io_signature::make(0, 0, 0)),
+      timetag_key(pmt::mp("timetag")),
       fs(_fs),
       current_T_rx_ms(0),
       sample_counter(0),
@@ -52,8 +53,9 @@ gnss_sdr_sample_counter::gnss_sdr_sample_counter(
       flag_enable_send_msg(false)  // enable it for reporting time with asynchronous message
 {
     message_port_register_out(pmt::mp("sample_counter"));
-    set_max_noutput_items(1);
-    set_tag_propagation_policy(TPP_DONT);  // no tag propagation, the time tag will be adjusted and regenerated in work()
+    set_tag_propagation_policy(TPP_DONT);  // no tag propagation, the time tags go to the observables block through the sample clock
+    sample_clock = Gnss_Sample_Clock::global_instance();
+    latency = Gnss_Pipeline_Latency::global_instance();
 }
 
 
@@ -72,16 +74,8 @@ int64_t gnss_sdr_sample_counter::uint64diff(uint64_t first, uint64_t second)
 }
 
 
-int gnss_sdr_sample_counter::work(int noutput_items __attribute__((unused)),
-    gr_vector_const_void_star &input_items __attribute__((unused)),
-    gr_vector_void_star &output_items)
+void gnss_sdr_sample_counter::report_time()
 {
-    auto *out = reinterpret_cast<Gnss_Synchro *>(output_items[0]);
-    out[0] = Gnss_Synchro();
-    out[0].Flag_valid_symbol_output = false;
-    out[0].Flag_valid_word = false;
-    out[0].Channel_ID = -1;
-    out[0].fs = fs;
     if ((current_T_rx_ms % report_interval_ms) == 0)
         {
             current_s++;
@@ -140,32 +134,30 @@ int gnss_sdr_sample_counter::work(int noutput_items __attribute__((unused)),
                     message_port_pub(pmt::mp("receiver_time"), pmt::from_double(static_cast<double>(current_T_rx_ms) / 1000.0));
                 }
         }
-    sample_counter += samples_per_output;
-    out[0].Tracking_sample_counter = sample_counter;
-    current_T_rx_ms += interval_ms;
-
-    //**************** time tags ****************
-    std::vector<gr::tag_t> tags_vec;
-    // notice that nitems_read is updated in decimation blocks after leaving work() with return 1, equivalent to call consume_each
-    this->get_tags_in_range(tags_vec, 0, this->nitems_read(0), this->nitems_read(0) + samples_per_output);
-    for (const auto &it : tags_vec)
+}
+
+
+void gnss_sdr_sample_counter::push_time_tags()
+{
+    // the time tags of the samples of the epoch that ends at sample_counter
+    const auto end = std::lower_bound(tags_vec.begin(), tags_vec.end(), sample_counter, [](const gr::tag_t &tag, uint64_t sample) { return tag.offset < sample; });
+    for (auto it = tags_vec.begin(); it != end; ++it)
         {
             try
                 {
-                    if (pmt::any_ref(it.value).type().hash_code() == typeid(const std::shared_ptr<GnssTime>).hash_code())
+                    if (pmt::any_ref(it->value).type().hash_code() == typeid(const std::shared_ptr<GnssTime>).hash_code())
                         {
-                            // recompute timestamp to match the last sample in the consumed samples in this batch
-                            int64_t diff_samplecount = uint64diff(out[0].Tracking_sample_counter, it.offset);
-                            const auto last_timetag = boost::any_cast<const std::shared_ptr<GnssTime>>(pmt::any_ref(it.value));
+                            // recompute timestamp to match the last sample of the epoch
+                            // (on a copy, since the tag of the signal source is shared with the tracking blocks)
+                            int64_t diff_samplecount = uint64diff(sample_counter, it->offset);
+                            GnssTime last_timetag = *boost::any_cast<const std::shared_ptr<GnssTime>>(pmt::any_ref(it->value));
                             double intpart;
-                            last_timetag->tow_ms_fraction += modf(1000.0 * static_cast<double>(diff_samplecount) / fs, &intpart);
-
-                            last_timetag->tow_ms = last_timetag->tow_ms + static_cast<int>(intpart);
-                            last_timetag->rx_time = static_cast<double>(out[0].Tracking_sample_counter) / fs;
-                            add_item_tag(0, this->nitems_written(0) + 1, pmt::mp("timetag"), pmt::make_any(last_timetag));
-                            // std::cout << "COUNTER TAG: this->nitems_read(0):" << this->nitems_read(0) << " sample_counter:" << sample_counter
-                            //          << " it->offset:" << it->offset << " diff:" << diff_samplecount << "\n";
-                            // getchar();
+                            last_timetag.tow_ms_fraction += modf(1000.0 * static_cast<double>(diff_samplecount) / fs, &intpart);
+
+                            last_timetag.tow_ms = last_timetag.tow_ms + static_cast<int>(intpart);
+                            last_timetag.rx_time = static_cast<double>(sample_counter) / fs;
+                            // delivered with the epoch that follows, as with the former stream of epochs
+                            sample_clock->time_tags()->push(sample_clock->epochs() + 1, last_timetag);
                         }
                     else
                         {
@@ -178,11 +170,35 @@ int gnss_sdr_sample_counter::work(int noutput_items __attribute__((unused)),
                 }
             catch (const std::exception &ee)
                 {
-                    return 1;
+                    break;
                 }
         }
+    tags_vec.erase(tags_vec.begin(), end);
+}
 
-    //************* end time tags **************
 
-    return 1;
+int gnss_sdr_sample_counter::work(int noutput_items,
+    gr_vector_const_void_star &input_items __attribute__((unused)),
+    gr_vector_void_star &output_items __attribute__((unused)))
+{
+    const uint64_t first_sample = this->nitems_read(0);
+    const uint64_t end_sample = first_sample + static_cast<uint64_t>(noutput_items);
+    this->get_tags_in_range(work_tags, 0, first_sample, end_sample, timetag_key);
+    tags_vec.insert(tags_vec.end(), work_tags.begin(), work_tags.end());
+
+    // one epoch each samples_per_output samples, published as soon as its last
+    // sample has arrived
+    while (samples_per_output > 0 and sample_counter + samples_per_output <= end_sample)
+        {
+            report_time();
+            sample_counter += samples_per_output;
+            current_T_rx_ms += interval_ms;
+            if (latency)
+                {
+                    latency->set_sample_time(sample_counter, fs);
+                }
+            push_time_tags();
+            sample_clock->publish(sample_counter);
+        }
+    return noutput_items;
 }
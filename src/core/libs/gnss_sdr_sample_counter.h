@@ -19,10 +19,16 @@
 #define GNSS_SDR_GNSS_SDR_SAMPLE_COUNTER_H
 
 #include "gnss_block_interface.h"
-#include <gnuradio/sync_decimator.h>
+#include "gnss_pipeline_latency.h"
+#include "gnss_sample_clock.h"
+#include <gnuradio/sync_block.h>
+#include <gnuradio/tags.h>   // for gr::tag_t
 #include <gnuradio/types.h>  // for gr_vector_const_void_star
-#include <cstddef>           // for size_t
+#include <pmt/pmt.h>
+#include <cstddef>  // for size_t
 #include <cstdint>
+#include <memory>
+#include <vector>
 
 /** \addtogroup Core
  * \{ */
@@ -40,7 +46,14 @@ gnss_sdr_sample_counter_sptr gnss_sdr_make_sample_counter(
     int32_t _interval_ms,
     size_t _size);
 
-class gnss_sdr_sample_counter : public gr::sync_decimator
+/*!
+ * \brief Counts the samples that reach the channels, and publishes an epoch
+ * of the observables every interval_ms in the Gnss_Sample_Clock, with the
+ * time tags of the signal source adjusted to it. If the clock is throttled,
+ * the block waits for the observables to read the epochs, holding back the
+ * samples of the signal source.
+ */
+class gnss_sdr_sample_counter : public gr::sync_block
 {
 public:
     ~gnss_sdr_sample_counter() = default;
@@ -59,6 +72,14 @@ private:
         size_t _size);
 
     int64_t uint64diff(uint64_t first, uint64_t second);
+    void report_time();
+    void push_time_tags();
+
+    std::vector<gr::tag_t> tags_vec;  // time tags of the samples of the next epoch
+    std::vector<gr::tag_t> work_tags;
+    const pmt::pmt_t timetag_key;
+    std::shared_ptr<Gnss_Sample_Clock> sample_clock;  // epochs and time tags for the observables block
+    std::shared_ptr<Gnss_Pipeline_Latency> latency;   // arrival time of the samples, if measured
 
     double fs;
     int64_t current_T_rx_ms;  // Receiver time in ms since the beginning of the run
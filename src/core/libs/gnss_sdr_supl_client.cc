@@ -20,7 +20,7 @@
 #include "gnss_sdr_supl_client.h"
 #include "GPS_L1_CA.h"
 #include "MATH_CONSTANTS.h"
-#include <boost/archive/xml_iarchive.hpp>
+#include "gnss_nav_data_store.h"
 #include <boost/archive/xml_oarchive.hpp>
 #include <boost/serialization/map.hpp>
 #include <glog/logging.h>
@@ -28,9 +28,26 @@
 #include <cmath>      // for pow
 #include <exception>  // for exception
 #include <iostream>   // for cerr
+#include <stdexcept>  // for runtime_error
 #include <utility>    // for pair
 #include <vector>
 
+namespace
+{
+// The assistance files are XML archives, versioned binary files as written by
+// the PVT block and by rinex2assist --binary, or the binary archives of their
+// former versions. Throws if the file is none of them.
+template <typename T>
+void load_assistance_archive(const std::string& file_name, const char* name, T& object)
+{
+    if (!Gnss_Nav_Data_Store::load_file(file_name, name, object))
+        {
+            throw std::runtime_error("Cannot read the assistance data. ");
+        }
+}
+}  // namespace
+
+
 Gnss_Sdr_Supl_Client::Gnss_Sdr_Supl_Client()
     : server_port(0), request(0), mcc(0), mns(0), lac(0), ci(0)
 {
@@ -359,13 +376,10 @@ void Gnss_Sdr_Supl_Client::read_supl_data()
 
 bool Gnss_Sdr_Supl_Client::load_ephemeris_xml(const std::string& file_name)
 {
-    std::ifstream ifs;
     try
         {
-            ifs.open(file_name.c_str(), std::ifstream::binary | std::ifstream::in);
-            boost::archive::xml_iarchive xml(ifs);
             gps_ephemeris_map.clear();
-            xml >> boost::serialization::make_nvp("GNSS-SDR_ephemeris_map", this->gps_ephemeris_map);
+            load_assistance_archive(file_name, "GNSS-SDR_ephemeris_map", this->gps_ephemeris_map);
             LOG(INFO) << "Loaded Ephemeris map data with " << this->gps_ephemeris_map.size() << " satellites";
         }
     catch (std::exception& e)
@@ -406,13 +420,10 @@ bool Gnss_Sdr_Supl_Client::save_ephemeris_map_xml(const std::string& file_name,
 
 bool Gnss_Sdr_Supl_Client::load_gal_ephemeris_xml(const std::string& file_name)
 {
-    std::ifstream ifs;
     try
         {
-            ifs.open(file_name.c_str(), std::ifstream::binary | std::ifstream::in);
-            boost::archive::xml_iarchive xml(ifs);
             gal_ephemeris_map.clear();
-            xml >> boost::serialization::make_nvp("GNSS-SDR_gal_ephemeris_map", this->gal_ephemeris_map);
+            load_assistance_archive(file_name, "GNSS-SDR_gal_ephemeris_map", this->gal_ephemeris_map);
             LOG(INFO) << "Loaded Ephemeris map data with " << this->gal_ephemeris_map.size() << " satellites";
         }
     catch (std::exception& e)
@@ -453,13 +464,10 @@ bool save_gal_ephemeris_map_xml(const std::string& file_name, std::map<int, Gali
 
 bool Gnss_Sdr_Supl_Client::load_cnav_ephemeris_xml(const std::string& file_name)
 {
-    std::ifstream ifs;
     try
         {
-            ifs.open(file_name.c_str(), std::ifstream::binary | std::ifstream::in);
-            boost::archive::xml_iarchive xml(ifs);
             gps_cnav_ephemeris_map.clear();
-            xml >> boost::serialization::make_nvp("GNSS-SDR_cnav_ephemeris_map", this->gps_cnav_ephemeris_map);
+            load_assistance_archive(file_name, "GNSS-SDR_cnav_ephemeris_map", this->gps_cnav_ephemeris_map);
             LOG(INFO) << "Loaded Ephemeris map data with " << this->gps_cnav_ephemeris_map.size() << " satellites";
         }
     catch (std::exception& e)
@@ -500,13 +508,10 @@ bool save_cnav_ephemeris_map_xml(const std::string& file_name, std::map<int, Gps
 
 bool Gnss_Sdr_Supl_Client::load_gnav_ephemeris_xml(const std::string& file_name)
 {
-    std::ifstream ifs;
     try
         {
-            ifs.open(file_name.c_str(), std::ifstream::binary | std::ifstream::in);
-            boost::archive::xml_iarchive xml(ifs);
             gps_cnav_ephemeris_map.clear();
-            xml >> boost::serialization::make_nvp("GNSS-SDR_gnav_ephemeris_map", this->glonass_gnav_ephemeris_map);
+            load_assistance_archive(file_name, "GNSS-SDR_gnav_ephemeris_map", this->glonass_gnav_ephemeris_map);
             LOG(INFO) << "Loaded GLONASS ephemeris map data with " << this->gps_cnav_ephemeris_map.size() << " satellites";
         }
     catch (std::exception& e)
@@ -547,12 +552,9 @@ bool save_gnav_ephemeris_map_xml(const std::string& file_name, std::map<int, Glo
 
 bool Gnss_Sdr_Supl_Client::load_utc_xml(const std::string& file_name)
 {
-    std::ifstream ifs;
     try
         {
-            ifs.open(file_name.c_str(), std::ifstream::binary | std::ifstream::in);
-            boost::archive::xml_iarchive xml(ifs);
-            xml >> boost::serialization::make_nvp("GNSS-SDR_utc_model", this->gps_utc);
+            load_assistance_archive(file_name, "GNSS-SDR_utc_model", this->gps_utc);
             LOG(INFO) << "Loaded UTC model data";
         }
     catch (std::exception& e)
@@ -593,12 +595,9 @@ bool Gnss_Sdr_Supl_Client::save_utc_xml(const std::string& file_name, Gps_Utc_Mo
 
 bool Gnss_Sdr_Supl_Client::load_cnav_utc_xml(const std::string& file_name)
 {
-    std::ifstream ifs;
     try
         {
-            ifs.open(file_name.c_str(), std::ifstream::binary | std::ifstream::in);
-            boost::archive::xml_iarchive xml(ifs);
-            xml >> boost::serialization::make_nvp("GNSS-SDR_cnav_utc_model", this->gps_cnav_utc);
+            load_assistance_archive(file_name, "GNSS-SDR_cnav_utc_model", this->gps_cnav_utc);
             LOG(INFO) << "Loaded CNAV UTC model data";
         }
     catch (std::exception& e)
@@ -639,12 +638,9 @@ bool Gnss_Sdr_Supl_Client::save_cnav_utc_xml(const std::string& file_name, Gps_C
 
 bool Gnss_Sdr_Supl_Client::load_gal_utc_xml(const std::string& file_name)
 {
-    std::ifstream ifs;
     try
         {
-            ifs.open(file_name.c_str(), std::ifstream::binary | std::ifstream::in);
-            boost::archive::xml_iarchive xml(ifs);
-            xml >> boost::serialization::make_nvp("GNSS-SDR_gal_utc_model", this->gal_utc);
+            load_assistance_archive(file_name, "GNSS-SDR_gal_utc_model", this->gal_utc);
             LOG(INFO) << "Loaded Galileo UTC model data";
         }
     catch (std::exception& e)
@@ -685,12 +681,9 @@ bool Gnss_Sdr_Supl_Client::save_gal_utc_xml(const std::string& file_name, Galile
 
 bool Gnss_Sdr_Supl_Client::load_iono_xml(const std::string& file_name)
 {
-    std::ifstream ifs;
     try
         {
-            ifs.open(file_name.c_str(), std::ifstream::binary | std::ifstream::in);
-            boost::archive::xml_iarchive xml(ifs);
-            xml >> boost::serialization::make_nvp("GNSS-SDR_iono_model", this->gps_iono);
+            load_assistance_archive(file_name, "GNSS-SDR_iono_model", this->gps_iono);
             LOG(INFO) << "Loaded IONO model data";
         }
     catch (std::exception& e)
@@ -731,12 +724,9 @@ bool Gnss_Sdr_Supl_Client::save_iono_xml(const std::string& file_name, Gps_Iono&
 
 bool Gnss_Sdr_Supl_Client::load_gal_iono_xml(const std::string& file_name)
 {
-    std::ifstream ifs;
     try
         {
-            ifs.open(file_name.c_str(), std::ifstream::binary | std::ifstream::in);
-            boost::archive::xml_iarchive xml(ifs);
-            xml >> boost::serialization::make_nvp("GNSS-SDR_gal_iono_model", this->gal_iono);
+            load_assistance_archive(file_name, "GNSS-SDR_gal_iono_model", this->gal_iono);
             LOG(INFO) << "Loaded Galileo IONO model data";
         }
     catch (std::exception& e)
@@ -777,13 +767,10 @@ bool Gnss_Sdr_Supl_Client::save_gal_iono_xml(const std::string& file_name, Galil
 
 bool Gnss_Sdr_Supl_Client::load_gps_almanac_xml(const std::string& file_name)
 {
-    std::ifstream ifs;
     try
         {
-            ifs.open(file_name.c_str(), std::ifstream::binary | std::ifstream::in);
-            boost::archive::xml_iarchive xml(ifs);
             gps_almanac_map.clear();
-            xml >> boost::serialization::make_nvp("GNSS-SDR_gps_almanac_map", this->gps_almanac_map);
+            load_assistance_archive(file_name, "GNSS-SDR_gps_almanac_map", this->gps_almanac_map);
             LOG(INFO) << "Loaded GPS almanac map data with " << this->gps_almanac_map.size() << " satellites";
         }
     catch (std::exception& e)
@@ -824,13 +811,10 @@ bool Gnss_Sdr_Supl_Client::save_gps_almanac_xml(const std::string& file_name, st
 
 bool Gnss_Sdr_Supl_Client::load_gal_almanac_xml(const std::string& file_name)
 {
-    std::ifstream ifs;
     try
         {
-            ifs.open(file_name.c_str(), std::ifstream::binary | std::ifstream::in);
-            boost::archive::xml_iarchive xml(ifs);
             gal_almanac_map.clear();
-            xml >> boost::serialization::make_nvp("GNSS-SDR_gal_almanac_map", this->gal_almanac_map);
+            load_assistance_archive(file_name, "GNSS-SDR_gal_almanac_map", this->gal_almanac_map);
         }
     catch (std::exception& e)
         {
@@ -922,12 +906,9 @@ bool Gnss_Sdr_Supl_Client::save_gal_almanac_xml(const std::string& file_name, st
 
 bool Gnss_Sdr_Supl_Client::load_glo_utc_xml(const std::string& file_name)
 {
-    std::ifstream ifs;
     try
         {
-            ifs.open(file_name.c_str(), std::ifstream::binary | std::ifstream::in);
-            boost::archive::xml_iarchive xml(ifs);
-            xml >> boost::serialization::make_nvp("GNSS-SDR_glo_utc_model", this->glo_gnav_utc);
+            load_assistance_archive(file_name, "GNSS-SDR_glo_utc_model", this->glo_gnav_utc);
             LOG(INFO) << "Loaded UTC model data";
         }
     catch (std::exception& e)
@@ -968,12 +949,9 @@ bool Gnss_Sdr_Supl_Client::save_glo_utc_xml(const std::string& file_name, Glonas
 
 bool Gnss_Sdr_Supl_Client::load_ref_time_xml(const std::string& file_name)
 {
-    std::ifstream ifs;
     try
         {
-            ifs.open(file_name.c_str(), std::ifstream::binary | std::ifstream::in);
-            boost::archive::xml_iarchive xml(ifs);
-            xml >> boost::serialization::make_nvp("GNSS-SDR_ref_time", this->gps_time);
+            load_assistance_archive(file_name, "GNSS-SDR_ref_time", this->gps_time);
             LOG(INFO) << "Loaded Ref Time data";
         }
     catch (std::exception& e)
@@ -1014,12 +992,9 @@ bool Gnss_Sdr_Supl_Client::save_ref_time_xml(const std::string& file_name, Agnss
 
 bool Gnss_Sdr_Supl_Client::load_ref_location_xml(const std::string& file_name)
 {
-    std::ifstream ifs;
     try
         {
-            ifs.open(file_name.c_str(), std::ifstream::binary | std::ifstream::in);
-            boost::archive::xml_iarchive xml(ifs);
-            xml >> boost::serialization::make_nvp("GNSS-SDR_ref_location", this->gps_ref_loc);
+            load_assistance_archive(file_name, "GNSS-SDR_ref_location", this->gps_ref_loc);
             LOG(INFO) << "Loaded Ref Location data";
         }
     catch (std::exception& e)
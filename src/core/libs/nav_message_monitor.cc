@@ -16,10 +16,13 @@
  */
 
 #include "nav_message_monitor.h"
+#include "gnss_receiver_callbacks.h"
 #include "gnss_sdr_make_unique.h"
 #include <glog/logging.h>
 #include <gnuradio/io_signature.h>
 #include <cstddef>   // size_t
+#include <cstdio>    // snprintf
+#include <cstring>   // memcpy
 #include <typeinfo>  // typeid
 
 #if HAS_GENERIC_LAMBDA
@@ -35,13 +38,13 @@ namespace wht = boost;
 namespace wht = std;
 #endif
 
-nav_message_monitor_sptr nav_message_monitor_make(const std::vector<std::string>& addresses, uint16_t port)
+nav_message_monitor_sptr nav_message_monitor_make(const std::vector<std::string>& addresses, uint16_t port, const std::string& shm_name, const std::string& callbacks_name)
 {
-    return nav_message_monitor_sptr(new nav_message_monitor(addresses, port));
+    return nav_message_monitor_sptr(new nav_message_monitor(addresses, port, shm_name, callbacks_name));
 }
 
 
-nav_message_monitor::nav_message_monitor(const std::vector<std::string>& addresses, uint16_t port) : gr::block("nav_message_monitor", gr::io_signature::make(0, 0, 0), gr::io_signature::make(0, 0, 0))
+nav_message_monitor::nav_message_monitor(const std::vector<std::string>& addresses, uint16_t port, const std::string& shm_name, const std::string& callbacks_name) : gr::block("nav_message_monitor", gr::io_signature::make(0, 0, 0), gr::io_signature::make(0, 0, 0))
 {
     // register Nav_msg_from_TLM input message port from telemetry blocks
     this->message_port_register_in(pmt::mp("Nav_msg_from_TLM"));
@@ -56,6 +59,27 @@ nav_message_monitor::nav_message_monitor(const std::vector<std::string>& address
 #endif
 #endif
     nav_message_udp_sink_ = std::make_unique<Nav_Message_Udp_Sink>(addresses, port);
+    if (!shm_name.empty())
+        {
+            shm_ring_ = std::make_unique<Gnss_Shm_Ring_Writer>(shm_name, SHM_RECORD_NAV_MESSAGE, sizeof(Nav_Message_Shm_Record), 256);
+            if (shm_ring_->is_open())
+                {
+                    shm_record_ = std::make_unique<Nav_Message_Shm_Record>();
+                }
+            else
+                {
+                    LOG(WARNING) << "Error creating the navigation message shared memory: " << shm_ring_->error();
+                    shm_ring_ = nullptr;
+                }
+        }
+    if (!callbacks_name.empty())
+        {
+            callbacks_ = Gnss_Receiver_Callbacks::get(callbacks_name);
+            if (!callbacks_->nav_message)
+                {
+                    callbacks_ = nullptr;
+                }
+        }
 }
 
 
@@ -70,6 +94,14 @@ void nav_message_monitor::msg_handler_nav_message(const pmt::pmt_t& msg)
                 {
                     const auto nav_message_packet = wht::any_cast<std::shared_ptr<Nav_Message_Packet>>(pmt::any_ref(msg));
                     nav_message_udp_sink_->write_nav_message(nav_message_packet);
+                    if (shm_ring_)
+                        {
+                            publish_nav_message(*nav_message_packet);
+                        }
+                    if (callbacks_)
+                        {
+                            callbacks_->nav_message(*nav_message_packet);
+                        }
                 }
             else
                 {
@@ -81,3 +113,22 @@ void nav_message_monitor::msg_handler_nav_message(const pmt::pmt_t& msg)
             LOG(WARNING) << "nav_message_monitor Bad any_cast: " << e.what();
         }
 }
+
+
+void nav_message_monitor::publish_nav_message(const Nav_Message_Packet& nav_message_packet)
+{
+    if (nav_message_packet.nav_message.size() > Nav_Message_Shm_Record::MAX_NAV_MESSAGE_LENGTH)
+        {
+            LOG(WARNING) << "Navigation message of " << nav_message_packet.nav_message.size() << " bits not published in shared memory";
+            return;
+        }
+    Nav_Message_Shm_Record& record = *shm_record_;
+    std::snprintf(record.system, sizeof(record.system), "%s", nav_message_packet.system.c_str());
+    std::snprintf(record.signal, sizeof(record.signal), "%s", nav_message_packet.signal.c_str());
+    record.prn = nav_message_packet.prn;
+    record.tow_at_current_symbol_ms = nav_message_packet.tow_at_current_symbol_ms;
+    record.nav_message_length = static_cast<uint32_t>(nav_message_packet.nav_message.size());
+    std::memcpy(record.nav_message, nav_message_packet.nav_message.data(), record.nav_message_length);
+    record.nav_message[record.nav_message_length] = '\0';
+    shm_ring_->publish(&record);
+}
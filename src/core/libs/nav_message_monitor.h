@@ -19,6 +19,8 @@
 #define GNSS_SDR_NAV_MESSAGE_MONITOR_H
 
 #include "gnss_block_interface.h"
+#include "gnss_shm_ring.h"
+#include "nav_message_shm_record.h"
 #include "nav_message_udp_sink.h"
 #include <gnuradio/block.h>
 #include <pmt/pmt.h>
@@ -32,15 +34,19 @@
 /** \addtogroup Core_Receiver_Library
  * \{ */
 
+class Gnss_Receiver_Callbacks;
 class nav_message_monitor;
 
 using nav_message_monitor_sptr = gnss_shared_ptr<nav_message_monitor>;
 
-nav_message_monitor_sptr nav_message_monitor_make(const std::vector<std::string>& addresses, uint16_t port);
+nav_message_monitor_sptr nav_message_monitor_make(const std::vector<std::string>& addresses, uint16_t port, const std::string& shm_name = std::string(""), const std::string& callbacks_name = std::string(""));
 
 /*!
  * \brief GNU Radio block that receives asynchronous Nav_Message_Packet obkects
- * from the telemetry blocks and sends them via UDP
+ * from the telemetry blocks and sends them via UDP and, if shm_name is not
+ * empty, publishes them in a shared memory ring as Nav_Message_Shm_Record
+ * objects. If callbacks_name is not empty, they are also given to the
+ * nav_message callback of the Gnss_Receiver_Callbacks of that name.
  */
 class nav_message_monitor : public gr::block
 {
@@ -48,10 +54,14 @@ public:
     ~nav_message_monitor() = default;  //!< Default destructor
 
 private:
-    friend nav_message_monitor_sptr nav_message_monitor_make(const std::vector<std::string>& addresses, uint16_t port);
-    nav_message_monitor(const std::vector<std::string>& addresses, uint16_t port);
+    friend nav_message_monitor_sptr nav_message_monitor_make(const std::vector<std::string>& addresses, uint16_t port, const std::string& shm_name, const std::string& callbacks_name);
+    nav_message_monitor(const std::vector<std::string>& addresses, uint16_t port, const std::string& shm_name, const std::string& callbacks_name);
     void msg_handler_nav_message(const pmt::pmt_t& msg);
+    void publish_nav_message(const Nav_Message_Packet& nav_message_packet);
     std::unique_ptr<Nav_Message_Udp_Sink> nav_message_udp_sink_;
+    std::unique_ptr<Gnss_Shm_Ring_Writer> shm_ring_;
+    std::unique_ptr<Nav_Message_Shm_Record> shm_record_;
+    std::shared_ptr<Gnss_Receiver_Callbacks> callbacks_;
 };
 
 
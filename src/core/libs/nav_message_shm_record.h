@@ -0,0 +1,48 @@
+/*!
+ * \file nav_message_shm_record.h
+ * \brief Fixed-layout version of Nav_Message_Packet, for the shared memory
+ * output of the navigation message monitor.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_NAV_MESSAGE_SHM_RECORD_H
+#define GNSS_SDR_NAV_MESSAGE_SHM_RECORD_H
+
+#include <cstdint>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver_Library
+ * \{ */
+
+/*!
+ * \brief Navigation message, as published in shared memory. The strings are
+ * null-terminated. nav_message holds the bits as '0' and '1' characters, as
+ * in Nav_Message_Packet; the longest one, a full Galileo HAS message, has
+ * 32 pages of 424 bits.
+ */
+struct Nav_Message_Shm_Record
+{
+    static constexpr uint32_t MAX_NAV_MESSAGE_LENGTH = 16383;
+
+    char system[4];                                //!< GNSS constellation, as in Nav_Message_Packet
+    char signal[4];                                //!< GNSS signal, as in Nav_Message_Packet
+    int32_t prn;                                   //!< SV ID
+    int32_t tow_at_current_symbol_ms;              //!< Time of week of the current symbol, in ms
+    uint32_t nav_message_length;                   //!< Number of characters in nav_message
+    char nav_message[MAX_NAV_MESSAGE_LENGTH + 1];  //!< Content of the navigation page
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_NAV_MESSAGE_SHM_RECORD_H
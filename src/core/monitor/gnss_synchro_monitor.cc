@@ -17,6 +17,7 @@
  */
 
 #include "gnss_synchro_monitor.h"
+#include "gnss_receiver_callbacks.h"
 #include "gnss_sdr_make_unique.h"
 #include "gnss_synchro.h"
 #include <algorithm>
@@ -28,13 +29,19 @@ gnss_synchro_monitor_sptr gnss_synchro_make_monitor(int n_channels,
     int decimation_factor,
     int udp_port,
     const std::vector<std::string>& udp_addresses,
-    bool enable_protobuf)
+    bool enable_protobuf,
+    int subscription_port,
+    const std::string& shm_name,
+    const std::string& callbacks_name)
 {
     return gnss_synchro_monitor_sptr(new gnss_synchro_monitor(n_channels,
         decimation_factor,
         udp_port,
         udp_addresses,
-        enable_protobuf));
+        enable_protobuf,
+        subscription_port,
+        shm_name,
+        callbacks_name));
 }
 
 
@@ -42,14 +49,40 @@ gnss_synchro_monitor::gnss_synchro_monitor(int n_channels,
     int decimation_factor,
     int udp_port,
     const std::vector<std::string>& udp_addresses,
-    bool enable_protobuf)
+    bool enable_protobuf,
+    int subscription_port,
+    const std::string& shm_name,
+    const std::string& callbacks_name)
     : gr::block("gnss_synchro_monitor",
           gr::io_signature::make(n_channels, n_channels, sizeof(Gnss_Synchro)),
           gr::io_signature::make(0, 0, 0)),
+      d_stocks(1),
+      d_count(n_channels, 0),
       d_nchannels(n_channels),
       d_decimation_factor(decimation_factor)
 {
-    udp_sink_ptr = std::make_unique<Gnss_Synchro_Udp_Sink>(udp_addresses, udp_port, enable_protobuf);
+    udp_sink_ptr = std::make_unique<Gnss_Synchro_Udp_Sink>(udp_addresses, udp_port, enable_protobuf, static_cast<uint16_t>(subscription_port));
+    if (subscription_port > 0)
+        {
+            d_subscriptions = std::make_unique<Monitor_Subscriptions>(n_channels);
+        }
+    if (!shm_name.empty())
+        {
+            d_shm_ring = std::make_unique<Gnss_Shm_Ring_Writer>(shm_name, SHM_RECORD_GNSS_SYNCHRO, sizeof(Gnss_Synchro));
+            if (!d_shm_ring->is_open())
+                {
+                    std::cerr << "Error creating the monitor shared memory: " << d_shm_ring->error() << '\n';
+                    d_shm_ring = nullptr;
+                }
+        }
+    if (!callbacks_name.empty())
+        {
+            d_callbacks = Gnss_Receiver_Callbacks::get(callbacks_name);
+            if (!d_callbacks->observables)
+                {
+                    d_callbacks = nullptr;
+                }
+        }
 }
 
 
@@ -69,29 +102,94 @@ int gnss_synchro_monitor::general_work(int noutput_items __attribute__((unused))
     // Get the input buffer pointer
     const auto** in = reinterpret_cast<const Gnss_Synchro**>(&input_items[0]);
 
+    if (d_subscriptions)
+        {
+            handle_subscription_requests();
+        }
+
+    const int decimation_factor = d_decimation_factor * d_decimation_scale.load(std::memory_order_relaxed);
+
     // Loop through each input stream channel
     for (int channel_index = 0; channel_index < d_nchannels; channel_index++)
         {
             // Loop through each item in each input stream channel
-            int count = 0;
             for (int item_index = 0; item_index < ninput_items[channel_index]; item_index++)
                 {
-                    // Use the count variable to limit how many items are sent per channel
-                    count++;
-                    if (count >= d_decimation_factor)
+                    // Use the count of each channel to limit how many items are sent
+                    d_count[channel_index]++;
+                    if (d_count[channel_index] >= decimation_factor)
+                        {
+                            // Write to the UDP sink
+                            d_stocks[0] = in[channel_index][item_index];
+                            udp_sink_ptr->write_gnss_synchro(d_stocks);
+                            if (d_shm_ring)
+                                {
+                                    d_shm_ring->publish(&in[channel_index][item_index]);
+                                }
+                            if (d_callbacks)
+                                {
+                                    d_callbacks->observables(in[channel_index][item_index]);
+                                }
+                            d_count[channel_index] = 0;
+                        }
+                    if (d_subscriptions and !d_subscriptions->empty())
                         {
-                            // Convert to a vector and write to the UDP sink
-                            std::vector<Gnss_Synchro> stocks;
-                            stocks.push_back(in[channel_index][item_index]);
-                            udp_sink_ptr->write_gnss_synchro(stocks);
-                            // Reset count variable
-                            count = 0;
-                            // Consume the number of items for the input stream channel
-                            consume(channel_index, ninput_items[channel_index]);
+                            d_subscriptions->push(channel_index, in[channel_index][item_index]);
                         }
                 }
+            // Consume the number of items for the input stream channel
+            consume(channel_index, ninput_items[channel_index]);
+        }
+
+    if (d_subscriptions and !d_subscriptions->empty())
+        {
+            send_to_subscribers();
         }
 
     // Not producing any outputs
     return 0;
 }
+
+
+void gnss_synchro_monitor::set_decimation_scale(int scale)
+{
+    d_decimation_scale.store(scale < 1 ? 1 : scale, std::memory_order_relaxed);
+}
+
+
+void gnss_synchro_monitor::handle_subscription_requests()
+{
+    // Requests are rare, there is no need to look for them on every call
+    const auto now = std::chrono::steady_clock::now();
+    if (now < d_next_request_poll)
+        {
+            return;
+        }
+    d_next_request_poll = now + std::chrono::milliseconds(100);
+
+    sockaddr_storage source{};
+    socklen_t source_length = 0;
+    while (udp_sink_ptr->read_request(d_request, source, source_length))
+        {
+            const std::string reply = d_subscriptions->handle_request(d_request, source, source_length, now);
+            udp_sink_ptr->write_reply(reply, source, source_length);
+        }
+    d_subscriptions->remove_expired(now);
+}
+
+
+void gnss_synchro_monitor::send_to_subscribers()
+{
+    for (auto& subscriber : d_subscriptions->subscribers())
+        {
+            const auto& pending = subscriber.pending;
+            for (size_t first = 0; first < pending.size(); first += Monitor_Subscriptions::MAX_ITEMS_PER_DATAGRAM)
+                {
+                    const size_t last = std::min(first + Monitor_Subscriptions::MAX_ITEMS_PER_DATAGRAM, pending.size());
+                    d_stocks.assign(pending.cbegin() + first, pending.cbegin() + last);
+                    udp_sink_ptr->write_gnss_synchro(d_stocks, subscriber.address, subscriber.address_length, subscriber.subscription.fields);
+                }
+            subscriber.pending.clear();
+        }
+    d_stocks.resize(1);
+}
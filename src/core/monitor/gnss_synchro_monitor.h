@@ -21,9 +21,13 @@
 #define GNSS_SDR_GNSS_SYNCHRO_MONITOR_H
 
 #include "gnss_block_interface.h"
+#include "gnss_shm_ring.h"
 #include "gnss_synchro_udp_sink.h"
+#include "monitor_subscriptions.h"
 #include <gnuradio/block.h>
 #include <gnuradio/runtime_types.h>  // for gr_vector_void_star
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <string>
 #include <vector>
@@ -35,6 +39,7 @@
  * \{ */
 
 
+class Gnss_Receiver_Callbacks;
 class gnss_synchro_monitor;
 
 using gnss_synchro_monitor_sptr = gnss_shared_ptr<gnss_synchro_monitor>;
@@ -43,12 +48,24 @@ gnss_synchro_monitor_sptr gnss_synchro_make_monitor(int n_channels,
     int decimation_factor,
     int udp_port,
     const std::vector<std::string>& udp_addresses,
-    bool enable_protobuf);
+    bool enable_protobuf,
+    int subscription_port = 0,
+    const std::string& shm_name = std::string(""),
+    const std::string& callbacks_name = std::string(""));
 
 /*!
  * \brief This class implements a monitoring block which allows sending
  * a data stream with the receiver internal parameters (Gnss_Synchro objects)
  * to local or remote clients over UDP.
+ *
+ * The configured clients get all the items, decimated by decimation_factor.
+ * If subscription_port is not zero, other clients can also subscribe to the
+ * channels, satellites, fields and rates they need (see Monitor_Subscriptions).
+ * If shm_name is not empty, the items sent to the configured clients are also
+ * published in a shared memory ring (see Gnss_Shm_Ring_Writer) for the
+ * consumers running in the same host. If callbacks_name is not empty, they
+ * are also given to the observables callback of the Gnss_Receiver_Callbacks
+ * of that name, for an application running the receiver in its process.
  */
 class gnss_synchro_monitor : public gr::block
 {
@@ -58,22 +75,45 @@ public:
     int general_work(int noutput_items, gr_vector_int& ninput_items,
         gr_vector_const_void_star& input_items, gr_vector_void_star& output_items);
 
+    /*!
+     * \brief Multiplies the decimation factor of the configured clients, for
+     * instance to shed load when the receiver falls behind real time
+     */
+    void set_decimation_scale(int scale);
+
 private:
     friend gnss_synchro_monitor_sptr gnss_synchro_make_monitor(int n_channels,
         int decimation_factor,
         int udp_port,
         const std::vector<std::string>& udp_addresses,
-        bool enable_protobuf);
+        bool enable_protobuf,
+        int subscription_port,
+        const std::string& shm_name,
+        const std::string& callbacks_name);
 
     gnss_synchro_monitor(int n_channels,
         int decimation_factor,
         int udp_port,
         const std::vector<std::string>& udp_addresses,
-        bool enable_protobuf);
+        bool enable_protobuf,
+        int subscription_port,
+        const std::string& shm_name,
+        const std::string& callbacks_name);
+
+    void handle_subscription_requests();
+    void send_to_subscribers();
 
+    std::vector<Gnss_Synchro> d_stocks;
+    std::vector<int> d_count;
     int d_nchannels;
     int d_decimation_factor;
+    std::atomic<int> d_decimation_scale{1};
     std::unique_ptr<Gnss_Synchro_Udp_Sink> udp_sink_ptr;
+    std::unique_ptr<Monitor_Subscriptions> d_subscriptions;  // if the subscription port is enabled
+    std::unique_ptr<Gnss_Shm_Ring_Writer> d_shm_ring;        // if a shared memory name is set
+    std::shared_ptr<Gnss_Receiver_Callbacks> d_callbacks;    // if a callbacks name is set
+    std::chrono::steady_clock::time_point d_next_request_poll;
+    std::string d_request;
 };
 
 
@@ -17,59 +17,90 @@
 
 #include "gnss_synchro_udp_sink.h"
 #include <boost/archive/binary_oarchive.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/stream.hpp>
 #include <boost/serialization/vector.hpp>
-#include <iostream>
-#include <sstream>
 
 Gnss_Synchro_Udp_Sink::Gnss_Synchro_Udp_Sink(const std::vector<std::string>& addresses,
     const uint16_t& port,
-    bool enable_protobuf)
-    : socket{io_context},
+    bool enable_protobuf,
+    uint16_t subscription_port)
+    : sender(addresses, port, 1024, subscription_port),
       use_protobuf(enable_protobuf)
 {
     if (enable_protobuf)
         {
             serdes = Serdes_Gnss_Synchro();
         }
-    for (const auto& address : addresses)
-        {
-            boost::asio::ip::udp::endpoint endpoint(boost::asio::ip::address::from_string(address, error), port);
-            endpoints.push_back(endpoint);
-        }
 }
 
 
 bool Gnss_Synchro_Udp_Sink::write_gnss_synchro(const std::vector<Gnss_Synchro>& stocks)
 {
-    std::string outbound_data;
-    if (use_protobuf == false)
+    if (sender.endpoints() == 0)
         {
-            std::ostringstream archive_stream;
-            boost::archive::binary_oarchive oa{archive_stream};
-            oa << stocks;
-            outbound_data = archive_stream.str();
+            return true;
         }
-    else
+    // The datagram is serialized in place, and sent by the sender thread
+    std::string* outbound_data = sender.next_datagram();
+    if (outbound_data == nullptr)
         {
-            outbound_data = serdes.createProtobuffer(stocks);
+            return false;
         }
-    for (const auto& endpoint : endpoints)
+    serialize(stocks, *outbound_data, Serdes_Gnss_Synchro::ALL_FIELDS);
+    sender.submit();
+    return true;
+}
+
+
+bool Gnss_Synchro_Udp_Sink::write_gnss_synchro(const std::vector<Gnss_Synchro>& stocks,
+    const sockaddr_storage& destination,
+    socklen_t destination_length,
+    uint64_t fields)
+{
+    std::string* outbound_data = sender.next_datagram(destination, destination_length);
+    if (outbound_data == nullptr)
         {
-            socket.open(endpoint.protocol(), error);
-            socket.connect(endpoint, error);
+            return false;
+        }
+    serialize(stocks, *outbound_data, fields);
+    sender.submit();
+    return true;
+}
 
-            try
-                {
-                    if (socket.send(boost::asio::buffer(outbound_data)) == 0)
-                        {
-                            std::cerr << "Gnss_Synchro_Udp_Sink sent 0 bytes\n";
-                        }
-                }
-            catch (boost::system::system_error const& e)
-                {
-                    std::cerr << e.what() << '\n';
-                    return false;
-                }
+
+bool Gnss_Synchro_Udp_Sink::read_request(std::string& request, sockaddr_storage& source, socklen_t& source_length)
+{
+    return sender.receive(request, source, source_length);
+}
+
+
+bool Gnss_Synchro_Udp_Sink::write_reply(const std::string& reply, const sockaddr_storage& destination, socklen_t destination_length)
+{
+    std::string* outbound_data = sender.next_datagram(destination, destination_length);
+    if (outbound_data == nullptr)
+        {
+            return false;
         }
+    *outbound_data = reply;
+    sender.submit();
     return true;
 }
+
+
+void Gnss_Synchro_Udp_Sink::serialize(const std::vector<Gnss_Synchro>& stocks, std::string& outbound_data, uint64_t fields)
+{
+    if (use_protobuf == false)
+        {
+            boost::iostreams::stream<boost::iostreams::back_insert_device<std::string>> archive_stream(outbound_data);
+            {
+                boost::archive::binary_oarchive oa{archive_stream};
+                oa << stocks;
+            }
+            archive_stream.flush();
+        }
+    else
+        {
+            serdes.createProtobuffer(stocks, outbound_data, fields);
+        }
+}
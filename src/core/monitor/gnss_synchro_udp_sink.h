@@ -19,9 +19,8 @@
 #define GNSS_SDR_GNSS_SYNCHRO_UDP_SINK_H
 
 #include "gnss_synchro.h"
+#include "gnss_udp_sender.h"
 #include "serdes_gnss_synchro.h"
-#include <boost/asio.hpp>
-#include <boost/system/error_code.hpp>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -32,12 +31,6 @@
  * \{ */
 
 
-#if USE_BOOST_ASIO_IO_CONTEXT
-using b_io_context = boost::asio::io_context;
-#else
-using b_io_context = boost::asio::io_service;
-#endif
-
 /*!
  * \brief This class sends serialized Gnss_Synchro objects
  * over UDP to one or multiple endpoints.
@@ -45,14 +38,29 @@ using b_io_context = boost::asio::io_service;
 class Gnss_Synchro_Udp_Sink
 {
 public:
-    Gnss_Synchro_Udp_Sink(const std::vector<std::string>& addresses, const uint16_t& port, bool enable_protobuf);
+    Gnss_Synchro_Udp_Sink(const std::vector<std::string>& addresses, const uint16_t& port, bool enable_protobuf, uint16_t subscription_port = 0);
     bool write_gnss_synchro(const std::vector<Gnss_Synchro>& stocks);
 
+    /*!
+     * \brief Sends stocks to a subscribed client, with only the fields in
+     * the fields mask (if Protocol Buffers are enabled)
+     */
+    bool write_gnss_synchro(const std::vector<Gnss_Synchro>& stocks,
+        const sockaddr_storage& destination,
+        socklen_t destination_length,
+        uint64_t fields);
+
+    /*!
+     * \brief Reads a pending request received on the subscription port, if any
+     */
+    bool read_request(std::string& request, sockaddr_storage& source, socklen_t& source_length);
+
+    bool write_reply(const std::string& reply, const sockaddr_storage& destination, socklen_t destination_length);
+
 private:
-    b_io_context io_context;
-    boost::asio::ip::udp::socket socket;
-    boost::system::error_code error;
-    std::vector<boost::asio::ip::udp::endpoint> endpoints;
+    void serialize(const std::vector<Gnss_Synchro>& stocks, std::string& outbound_data, uint64_t fields);
+
+    Gnss_Udp_Sender sender;
     Serdes_Gnss_Synchro serdes;
     bool use_protobuf;
 };
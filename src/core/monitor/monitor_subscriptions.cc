@@ -0,0 +1,271 @@
+/*!
+ * \file monitor_subscriptions.cc
+ * \brief Clients subscribed to a Gnss_Synchro monitor stream, with the
+ * channels, satellites, fields and rate that each one of them requested.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "monitor_subscriptions.h"
+#include "serdes_gnss_synchro.h"
+#include <algorithm>  // for find_if, remove_if, min
+#include <cstring>    // for memcmp
+#include <exception>
+#include <sstream>
+
+
+namespace
+{
+// Splits "a,b,c" into its elements
+std::vector<std::string> split_list(const std::string& list)
+{
+    std::vector<std::string> elements;
+    std::stringstream ss(list);
+    std::string element;
+    while (std::getline(ss, element, ','))
+        {
+            if (!element.empty())
+                {
+                    elements.push_back(element);
+                }
+        }
+    return elements;
+}
+
+
+// Parses "0-3,7" into {0, 1, 2, 3, 7}
+template <typename T>
+bool parse_ranges(const std::string& list, std::set<T>& values)
+{
+    try
+        {
+            for (const auto& element : split_list(list))
+                {
+                    const auto dash = element.find('-', 1);
+                    const int64_t first = std::stoll(element.substr(0, dash));
+                    const int64_t last = (dash == std::string::npos) ? first : std::stoll(element.substr(dash + 1));
+                    if (first < 0 or last < first or last - first > 1023)
+                        {
+                            return false;
+                        }
+                    for (int64_t v = first; v <= last; v++)
+                        {
+                            values.insert(static_cast<T>(v));
+                        }
+                }
+        }
+    catch (const std::exception&)
+        {
+            return false;
+        }
+    return !values.empty();
+}
+
+
+bool same_address(const sockaddr_storage& a, socklen_t a_length, const sockaddr_storage& b, socklen_t b_length)
+{
+    return a_length == b_length and memcmp(&a, &b, a_length) == 0;
+}
+}  // namespace
+
+
+constexpr std::size_t Monitor_Subscriptions::MAX_SUBSCRIBERS;
+constexpr std::size_t Monitor_Subscriptions::MAX_ITEMS_PER_DATAGRAM;
+constexpr int Monitor_Subscriptions::MAX_LIFETIME_S;
+
+
+bool Monitor_Subscription::matches(const Gnss_Synchro& gs) const
+{
+    if (!channels.empty() and channels.count(gs.Channel_ID) == 0)
+        {
+            return false;
+        }
+    if (!prns.empty() and prns.count(gs.PRN) == 0)
+        {
+            return false;
+        }
+    if (!signals.empty() and signals.count(std::string(gs.Signal, 2)) == 0)
+        {
+            return false;
+        }
+    return true;
+}
+
+
+Monitor_Subscriptions::Monitor_Subscriptions(int n_channels) : d_nchannels(n_channels)
+{
+    d_subscribers.reserve(MAX_SUBSCRIBERS);
+}
+
+
+bool Monitor_Subscriptions::parse(const std::string& request, Monitor_Subscription& subscription, std::string& error)
+{
+    subscription = Monitor_Subscription();
+    std::stringstream ss(request);
+    std::string command;
+    ss >> command;
+    if (command != "subscribe")
+        {
+            error = "unknown command";
+            return false;
+        }
+    std::string option;
+    while (ss >> option)
+        {
+            const auto equal = option.find('=');
+            if (equal == std::string::npos)
+                {
+                    error = "malformed option " + option;
+                    return false;
+                }
+            const std::string key = option.substr(0, equal);
+            const std::string value = option.substr(equal + 1);
+            bool valid = true;
+            if (key == "channels")
+                {
+                    valid = parse_ranges(value, subscription.channels);
+                }
+            else if (key == "prns")
+                {
+                    valid = parse_ranges(value, subscription.prns);
+                }
+            else if (key == "signals")
+                {
+                    for (const auto& signal : split_list(value))
+                        {
+                            valid = valid and (signal.size() == 2);
+                            subscription.signals.insert(signal);
+                        }
+                }
+            else if (key == "fields")
+                {
+                    valid = Serdes_Gnss_Synchro::field_mask(split_list(value), subscription.fields);
+                }
+            else if (key == "decimation" or key == "lifetime")
+                {
+                    int number = 0;
+                    try
+                        {
+                            number = std::stoi(value);
+                        }
+                    catch (const std::exception&)
+                        {
+                            valid = false;
+                        }
+                    valid = valid and number > 0;
+                    if (key == "decimation")
+                        {
+                            subscription.decimation = number;
+                        }
+                    else
+                        {
+                            subscription.lifetime_s = std::min(number, MAX_LIFETIME_S);
+                        }
+                }
+            else
+                {
+                    valid = false;
+                }
+            if (!valid)
+                {
+                    error = "invalid option " + option;
+                    return false;
+                }
+        }
+    return true;
+}
+
+
+std::string Monitor_Subscriptions::handle_request(const std::string& request,
+    const sockaddr_storage& source,
+    socklen_t source_length,
+    std::chrono::steady_clock::time_point now)
+{
+    auto subscriber = std::find_if(d_subscribers.begin(), d_subscribers.end(), [&](const Subscriber& s) {
+        return same_address(s.address, s.address_length, source, source_length);
+    });
+
+    std::stringstream ss(request);
+    std::string command;
+    ss >> command;
+    if (command == "unsubscribe")
+        {
+            if (subscriber != d_subscribers.end())
+                {
+                    d_subscribers.erase(subscriber);
+                }
+            return "OK";
+        }
+
+    Monitor_Subscription subscription;
+    std::string error;
+    if (!parse(request, subscription, error))
+        {
+            return "ERROR " + error;
+        }
+    if (subscriber == d_subscribers.end())
+        {
+            if (d_subscribers.size() >= MAX_SUBSCRIBERS)
+                {
+                    return "ERROR too many subscribers";
+                }
+            d_subscribers.emplace_back();
+            subscriber = d_subscribers.end() - 1;
+            subscriber->address = source;
+            subscriber->address_length = source_length;
+        }
+    subscriber->subscription = subscription;
+    subscriber->expiration = now + std::chrono::seconds(subscription.lifetime_s);
+    subscriber->count.assign(d_nchannels, subscription.decimation - 1);  // the first item of each channel is sent
+    subscriber->pending.clear();
+    return "OK";
+}
+
+
+void Monitor_Subscriptions::remove_expired(std::chrono::steady_clock::time_point now)
+{
+    d_subscribers.erase(std::remove_if(d_subscribers.begin(), d_subscribers.end(), [now](const Subscriber& s) { return s.expiration <= now; }),
+        d_subscribers.end());
+}
+
+
+void Monitor_Subscriptions::push(int channel, const Gnss_Synchro& gs)
+{
+    if (channel < 0 or channel >= d_nchannels)
+        {
+            return;
+        }
+    for (auto& subscriber : d_subscribers)
+        {
+            if (!subscriber.subscription.matches(gs))
+                {
+                    continue;
+                }
+            subscriber.count[channel]++;
+            if (subscriber.count[channel] >= subscriber.subscription.decimation)
+                {
+                    subscriber.count[channel] = 0;
+                    subscriber.pending.push_back(gs);
+                }
+        }
+}
+
+
+std::vector<Monitor_Subscriptions::Subscriber>& Monitor_Subscriptions::subscribers()
+{
+    return d_subscribers;
+}
+
+
+bool Monitor_Subscriptions::empty() const
+{
+    return d_subscribers.empty();
+}
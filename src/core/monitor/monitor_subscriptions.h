@@ -0,0 +1,122 @@
+/*!
+ * \file monitor_subscriptions.h
+ * \brief Clients subscribed to a Gnss_Synchro monitor stream, with the
+ * channels, satellites, fields and rate that each one of them requested.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_MONITOR_SUBSCRIPTIONS_H
+#define GNSS_SDR_MONITOR_SUBSCRIPTIONS_H
+
+#include "gnss_synchro.h"
+#include <sys/socket.h>  // for sockaddr_storage, socklen_t
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <vector>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Gnss_Synchro_Monitor
+ * \{ */
+
+
+/*!
+ * \brief What a client wants to receive. Empty sets mean no filtering.
+ */
+struct Monitor_Subscription
+{
+    std::set<int32_t> channels;
+    std::set<uint32_t> prns;
+    std::set<std::string> signals;
+    uint64_t fields{~0ULL};  // mask of the GnssSynchro protobuf field numbers
+    int decimation{1};       // one item out of decimation, in each channel
+    int lifetime_s{60};      // the subscription expires if not renewed
+
+    bool matches(const Gnss_Synchro& gs) const;
+};
+
+
+/*!
+ * \brief Subscriptions of the clients of a monitor.
+ *
+ * Clients send text requests to the subscription port of the monitor, one
+ * per datagram:
+ *
+ *     subscribe [channels=0-3,7] [prns=1,5,10-12] [signals=1C,1B]
+ *               [fields=cn0_db_hz,carrier_doppler_hz] [decimation=N]
+ *               [lifetime=S]
+ *     unsubscribe
+ *
+ * and get "OK" or "ERROR <reason>" as a reply. Then the monitor sends to
+ * the address and port the request came from only the items that pass the
+ * filters, one out of every decimation items of each channel, with only the
+ * requested fields (with Protocol Buffers), and several items per datagram.
+ * A new subscribe request from the same client replaces the previous one,
+ * and renews it for lifetime seconds (60 by default).
+ */
+class Monitor_Subscriptions
+{
+public:
+    static constexpr std::size_t MAX_SUBSCRIBERS = 32;
+    static constexpr std::size_t MAX_ITEMS_PER_DATAGRAM = 16;
+    static constexpr int MAX_LIFETIME_S = 3600;
+
+    struct Subscriber
+    {
+        sockaddr_storage address;
+        socklen_t address_length;
+        Monitor_Subscription subscription;
+        std::chrono::steady_clock::time_point expiration;
+        std::vector<int> count;             // items since the last one sent, per channel
+        std::vector<Gnss_Synchro> pending;  // items to be sent
+    };
+
+    explicit Monitor_Subscriptions(int n_channels);
+
+    /*!
+     * \brief Parses the options of a subscribe request. Returns false, with
+     * the reason in error, if the request is not valid.
+     */
+    static bool parse(const std::string& request, Monitor_Subscription& subscription, std::string& error);
+
+    /*!
+     * \brief Handles a request from a client and returns the reply
+     */
+    std::string handle_request(const std::string& request,
+        const sockaddr_storage& source,
+        socklen_t source_length,
+        std::chrono::steady_clock::time_point now);
+
+    void remove_expired(std::chrono::steady_clock::time_point now);
+
+    /*!
+     * \brief Adds the item of channel to the pending items of the
+     * subscribers that want it
+     */
+    void push(int channel, const Gnss_Synchro& gs);
+
+    std::vector<Subscriber>& subscribers();
+
+    bool empty() const;
+
+private:
+    std::vector<Subscriber> d_subscribers;
+    int d_nchannels;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_MONITOR_SUBSCRIPTIONS_H
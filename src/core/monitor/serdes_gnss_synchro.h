@@ -20,7 +20,9 @@
 
 #include "gnss_synchro.h"
 #include "gnss_synchro.pb.h"  // file created by Protocol Buffers at compile time
-#include <array>
+#include <google/protobuf/arena.h>
+#include <google/protobuf/descriptor.h>
+#include <cstdint>
 #include <string>
 #include <utility>
 #include <vector>
@@ -28,11 +30,16 @@
 /*!
  * \brief This class implements serialization and deserialization of
  * Gnss_Synchro objects using Protocol Buffers.
+ *
+ * The message used for serialization lives in an arena owned by the object
+ * and is reused on every call, so that its sub-messages and strings are
+ * allocated only the first time that the given number of observables is
+ * serialized.
  */
 class Serdes_Gnss_Synchro
 {
 public:
-    Serdes_Gnss_Synchro()
+    Serdes_Gnss_Synchro() : observables(google::protobuf::Arena::CreateMessage<gnss_sdr::Observables>(&arena))
     {
         // Verify that the version of the library that we linked against is
         // compatible with the version of the headers we compiled against.
@@ -44,48 +51,79 @@ public:
         google::protobuf::ShutdownProtobufLibrary();
     }
 
-    inline Serdes_Gnss_Synchro(const Serdes_Gnss_Synchro& other) noexcept  //!< Copy constructor
+    inline Serdes_Gnss_Synchro(const Serdes_Gnss_Synchro& other) noexcept : Serdes_Gnss_Synchro()  //!< Copy constructor
     {
-        this->observables = other.observables;
+        this->observables->CopyFrom(*other.observables);
     }
 
     inline Serdes_Gnss_Synchro& operator=(const Serdes_Gnss_Synchro& rhs) noexcept  //!< Copy assignment operator
     {
-        this->observables = rhs.observables;
+        if (this != &rhs)
+            {
+                this->observables->CopyFrom(*rhs.observables);
+            }
         return *this;
     }
 
-    inline Serdes_Gnss_Synchro(Serdes_Gnss_Synchro&& other) noexcept  //!< Move constructor
+    // Messages cannot be moved between arenas, they are copied
+    inline Serdes_Gnss_Synchro(Serdes_Gnss_Synchro&& other) noexcept : Serdes_Gnss_Synchro()  //!< Move constructor
     {
-        this->observables = std::move(other.observables);
+        this->observables->CopyFrom(*other.observables);
     }
 
     inline Serdes_Gnss_Synchro& operator=(Serdes_Gnss_Synchro&& other) noexcept  //!< Move assignment operator
     {
         if (this != &other)
             {
-                this->observables = std::move(other.observables);
+                this->observables->CopyFrom(*other.observables);
             }
         return *this;
     }
 
     inline std::string createProtobuffer(const std::vector<Gnss_Synchro>& vgs)  //!< Serialization into a string
     {
-        observables.Clear();
         std::string data;
-        for (auto gs : vgs)
-            {
-                gnss_sdr::GnssSynchro* obs = observables.add_observable();
-                char c = gs.System;
-                const std::string sys(1, c);
+        createProtobuffer(vgs, data);
+        return data;
+    }
 
-                std::array<char, 2> cc;
-                cc[0] = gs.Signal[0];
-                cc[1] = gs.Signal[1];
-                const std::string sig(cc.cbegin(), cc.cend());
+    static constexpr uint64_t ALL_FIELDS = ~0ULL;  //!< Mask of all the fields, bit n is the field with number n
+
+    /*!
+     * \brief Computes in fields the mask of the GnssSynchro fields with the
+     * given names. The system, signal, prn and channel_id fields are always
+     * included. Returns false if a name is not a field.
+     */
+    static inline bool field_mask(const std::vector<std::string>& names, uint64_t& fields)
+    {
+        fields = (1ULL << gnss_sdr::GnssSynchro::kSystemFieldNumber) |
+                 (1ULL << gnss_sdr::GnssSynchro::kSignalFieldNumber) |
+                 (1ULL << gnss_sdr::GnssSynchro::kPrnFieldNumber) |
+                 (1ULL << gnss_sdr::GnssSynchro::kChannelIdFieldNumber);
+        for (const auto& name : names)
+            {
+                const google::protobuf::FieldDescriptor* field = gnss_sdr::GnssSynchro::descriptor()->FindFieldByName(name);
+                if (field == nullptr)
+                    {
+                        return false;
+                    }
+                fields |= 1ULL << field->number();
+            }
+        return true;
+    }
 
-                obs->set_system(sys);
-                obs->set_signal(sig);
+    /*!
+     * \brief Serialization appended to a string. Only the fields in the
+     * fields mask are encoded.
+     */
+    inline void createProtobuffer(const std::vector<Gnss_Synchro>& vgs, std::string& data, uint64_t fields = ALL_FIELDS)
+    {
+        observables->Clear();
+        for (const auto& gs : vgs)
+            {
+                gnss_sdr::GnssSynchro* obs = observables->add_observable();
+                obs->set_system(&gs.System, 1);
+                obs->set_signal(gs.Signal, 2);
                 obs->set_prn(gs.PRN);
                 obs->set_channel_id(gs.Channel_ID);
 
@@ -114,9 +152,27 @@ public:
                 obs->set_flag_valid_pseudorange(gs.Flag_valid_pseudorange);
                 obs->set_flag_pll_180_deg_phase_locked(gs.Flag_PLL_180_deg_phase_locked);
                 obs->set_interp_tow_ms(gs.interp_TOW_ms);
+
+                obs->set_sqm_delta(gs.SQM_delta);
+                obs->set_sqm_ratio(gs.SQM_ratio);
+                obs->set_sqm_asymmetry(gs.SQM_asymmetry);
+                if (fields != ALL_FIELDS)
+                    {
+                        // fields with default values are not encoded
+                        const google::protobuf::Descriptor* descriptor = obs->GetDescriptor();
+                        const google::protobuf::Reflection* reflection = obs->GetReflection();
+                        for (int f = 0; f < descriptor->field_count(); f++)
+                            {
+                                const google::protobuf::FieldDescriptor* field = descriptor->field(f);
+                                if (((fields >> field->number()) & 1ULL) == 0)
+                                    {
+                                        reflection->ClearField(obs, field);
+                                    }
+                            }
+                    }
             }
-        observables.SerializeToString(&data);
-        return data;
+        // (the observables are serialized in place, at the end of data)
+        observables->AppendToString(&data);
     }
 
     inline std::vector<Gnss_Synchro> readProtobuffer(const gnss_sdr::Observables& obs) const  //!< Deserialization
@@ -160,13 +216,18 @@ public:
                 gs.Flag_PLL_180_deg_phase_locked = gs_read.flag_pll_180_deg_phase_locked();
                 gs.interp_TOW_ms = gs_read.interp_tow_ms();
 
+                gs.SQM_delta = static_cast<float>(gs_read.sqm_delta());
+                gs.SQM_ratio = static_cast<float>(gs_read.sqm_ratio());
+                gs.SQM_asymmetry = static_cast<float>(gs_read.sqm_asymmetry());
+
                 vgs.push_back(gs);
             }
         return vgs;
     }
 
 private:
-    gnss_sdr::Observables observables{};
+    google::protobuf::Arena arena;
+    gnss_sdr::Observables* observables;
 };
 
 #endif  // GNSS_SDR_SERDES_GNSS_SYNCHRO_H
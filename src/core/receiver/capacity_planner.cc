@@ -0,0 +1,453 @@
+/*!
+ * \file capacity_planner.cc
+ * \brief Estimates the CPU, memory and buffers that a configuration needs,
+ * before running it.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "capacity_planner.h"
+#include "gnss_synchro.h"
+#include "stream_buffer_policy.h"
+#include <gnuradio/gr_complex.h>
+#include <algorithm>  // for max, min, find_if
+#include <array>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <thread>
+
+
+namespace
+{
+struct Capacity_Signal
+{
+    const char* signal;
+    uint32_t code_ms;  // code period [ms]
+    bool veml;         // very early and very late correlators
+    bool pilot;        // a pilot component, tracked with track_pilot=true
+};
+
+
+const std::array<Capacity_Signal, 11> CAPACITY_SIGNALS = {{
+    {"1C", 1U, false, false},
+    {"2S", 20U, false, false},
+    {"L5", 1U, false, true},
+    {"1B", 4U, true, true},
+    {"5X", 1U, false, true},
+    {"7X", 1U, false, true},
+    {"E6", 1U, false, false},
+    {"1G", 1U, false, false},
+    {"2G", 1U, false, false},
+    {"B1", 1U, false, false},
+    {"B3", 1U, false, false}}};
+
+// Bytes of a record of the dump of a tracking block, written every integration period
+constexpr double TRACKING_DUMP_RECORD_BYTES = 200.0;
+
+// Memory of the decoder and of the state of a block, besides its vectors
+constexpr uint64_t BLOCK_BASE_BYTES = 65536U;
+
+
+// Output buffer that GNU Radio allocates for a reader of up to items items:
+// room for twice the request, not below the default size, in whole pages
+uint64_t gr_buffer_bytes(uint64_t items, uint64_t item_size)
+{
+    const uint64_t bytes = std::max(static_cast<uint64_t>(32768U), 2U * items * item_size);
+    return (bytes + 4095U) / 4096U * 4096U;
+}
+
+
+uint64_t item_size_of(const std::string& item_type)
+{
+    if (item_type == "cshort" or item_type == "ishort")
+        {
+            return 4U;
+        }
+    if (item_type == "cbyte" or item_type == "short")
+        {
+            return 2U;
+        }
+    if (item_type == "byte" or item_type == "ibyte")
+        {
+            return 1U;
+        }
+    return 8U;  // gr_complex
+}
+
+
+// Role of the block ID, as the block factory finds it: "Base" if there is
+// no "Base0" for the first one
+std::string planner_role(const ConfigurationInterface* configuration, const std::string& base, int ID)
+{
+    const std::string role = base + std::to_string(ID);
+    if (ID < 1 and configuration->property(role + ".implementation", std::string()).empty())
+        {
+            return base;
+        }
+    return role;
+}
+
+
+double fft_ns(const Capacity_Cost_Model& costs, uint64_t n)
+{
+    return costs.fft_ns_per_point_log2 * static_cast<double>(n) * std::log2(static_cast<double>(std::max(n, static_cast<uint64_t>(2U))));
+}
+
+
+std::string mib(uint64_t bytes)
+{
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1) << static_cast<double>(bytes) / 1048576.0;
+    return out.str();
+}
+}  // namespace
+
+
+void Capacity_Cost_Model::SetFromConfiguration(const ConfigurationInterface* calibration)
+{
+    fft_ns_per_point_log2 = calibration->property("Capacity.fft_ns_per_point_log2", fft_ns_per_point_log2);
+    multiply_ns_per_sample = calibration->property("Capacity.multiply_ns_per_sample", multiply_ns_per_sample);
+    peak_search_ns_per_sample = calibration->property("Capacity.peak_search_ns_per_sample", peak_search_ns_per_sample);
+    source_ns_per_sample = calibration->property("Capacity.source_ns_per_sample", source_ns_per_sample);
+    conditioner_ns_per_sample = calibration->property("Capacity.conditioner_ns_per_sample", conditioner_ns_per_sample);
+    correlator_ns_per_sample = calibration->property("Capacity.correlator_ns_per_sample", correlator_ns_per_sample);
+    telemetry_cores_per_channel = calibration->property("Capacity.telemetry_cores_per_channel", telemetry_cores_per_channel);
+    observables_ns_per_channel_epoch = calibration->property("Capacity.observables_ns_per_channel_epoch", observables_ns_per_channel_epoch);
+    pvt_ns_per_fix = calibration->property("Capacity.pvt_ns_per_fix", pvt_ns_per_fix);
+}
+
+
+Capacity_Planner::Capacity_Planner(const ConfigurationInterface* configuration, const ConfigurationInterface* calibration, unsigned int cpus)
+    : d_cpus(cpus)
+{
+    if (calibration != nullptr)
+        {
+            d_costs.SetFromConfiguration(calibration);
+            if (d_cpus == 0)
+                {
+                    d_cpus = calibration->property("Capacity.cpus", 0U);
+                }
+        }
+    if (d_cpus == 0)
+        {
+            d_cpus = std::max(std::thread::hardware_concurrency(), 1U);
+        }
+    d_fs = configuration->property("GNSS-SDR.internal_fs_sps", 0.0);
+
+    // the channels first, since their requests size the buffers of the
+    // conditioners
+    int32_t channels = 0;
+    for (const auto& sig : CAPACITY_SIGNALS)
+        {
+            const int32_t count = configuration->property("Channels_" + std::string(sig.signal) + ".count", 0);
+            if (count > 0)
+                {
+                    plan_channels(configuration, sig.signal, count);
+                    channels += count;
+                }
+        }
+    plan_sources(configuration);
+    plan_observables_pvt(configuration, channels);
+}
+
+
+void Capacity_Planner::plan_sources(const ConfigurationInterface* configuration)
+{
+    std::vector<Capacity_Stage> stages;
+    const Stream_Buffer_Policy buffer_policy(configuration, largest_request_s());
+    const int sources_count = configuration->property("GNSS-SDR.num_sources", configuration->property("Receiver.sources_count", 1));
+    int conditioner_ID = 0;
+    for (int i = 0; i < sources_count; i++)
+        {
+            const std::string role = planner_role(configuration, "SignalSource", i);
+            const double fs = configuration->property(role + ".sampling_frequency", d_fs);
+            const auto rf_channels = std::max(configuration->property(role + ".RF_channels", 1U), 1U);
+            const uint64_t item_size = item_size_of(configuration->property(role + ".item_type", std::string("gr_complex")));
+            const auto ingest_samples = static_cast<uint64_t>(std::max(configuration->property(role + ".ingest_buffer_samples", static_cast<int64_t>(0)), static_cast<int64_t>(0)));
+            Capacity_Stage source;
+            source.name = role;
+            source.note = configuration->property(role + ".implementation", std::string()) + ", " + std::to_string(rf_channels) + " RF channel(s) at " + std::to_string(static_cast<int64_t>(fs)) + " sps";
+            source.cores = static_cast<double>(rf_channels) * fs * d_costs.source_ns_per_sample * 1e-9;
+            source.thread_cores = source.cores;
+            source.memory_bytes = BLOCK_BASE_BYTES;
+            // the ingest buffer takes precedence over the buffer policy
+            const Stream_Buffer source_buffer = buffer_policy.buffer(role, fs, item_size);
+            const uint64_t policy_bytes = (ingest_samples > 0 ? 0U : static_cast<uint64_t>(source_buffer.items) * item_size);
+            source.buffer_bytes = rf_channels * std::max(gr_buffer_bytes(std::max(ingest_samples, d_acq_max_samples), item_size), policy_bytes);
+            if (configuration->property(role + ".dump", false))
+                {
+                    source.dump_bytes_per_s = static_cast<double>(rf_channels) * fs * static_cast<double>(item_size);
+                }
+            stages.push_back(source);
+
+            for (uint32_t j = 0; j < rf_channels; j++)
+                {
+                    const std::string conditioner_role = planner_role(configuration, "SignalConditioner", conditioner_ID);
+                    const std::string implementation = configuration->property(conditioner_role + ".implementation", std::string("Pass_Through"));
+                    Capacity_Stage conditioner;
+                    conditioner.name = conditioner_role;
+                    conditioner.note = implementation;
+                    conditioner.memory_bytes = BLOCK_BASE_BYTES;
+                    // the buffer policy sizes the output read by the channels
+                    const uint64_t block_buffer_bytes = gr_buffer_bytes(d_acq_max_samples, sizeof(gr_complex));
+                    const Stream_Buffer output_buffer = buffer_policy.buffer(conditioner_role, d_fs, sizeof(gr_complex));
+                    conditioner.buffer_bytes = std::max(block_buffer_bytes, static_cast<uint64_t>(output_buffer.items) * sizeof(gr_complex));
+                    if (implementation != "Pass_Through")
+                        {
+                            conditioner.cores = fs * d_costs.conditioner_ns_per_sample * 1e-9;
+                            // Signal_Conditioner runs the adapter, the filter
+                            // and the resampler in their own threads
+                            conditioner.thread_cores = (implementation == "Fused_Signal_Conditioner" ? conditioner.cores : conditioner.cores / 3.0);
+                            conditioner.buffer_bytes += (implementation == "Fused_Signal_Conditioner" ? 0U : 2U * block_buffer_bytes);
+                        }
+                    stages.push_back(conditioner);
+                    conditioner_ID++;
+                }
+        }
+    d_stages.insert(d_stages.begin(), stages.begin(), stages.end());
+}
+
+
+void Capacity_Planner::plan_channels(const ConfigurationInterface* configuration, const std::string& signal, int32_t count)
+{
+    const auto sig = std::find_if(CAPACITY_SIGNALS.cbegin(), CAPACITY_SIGNALS.cend(), [&signal](const Capacity_Signal& s) { return signal == s.signal; });
+    const double code_s = static_cast<double>(sig->code_ms) / 1000.0;
+    const auto samples_per_code = static_cast<uint64_t>(std::round(d_fs * code_s));
+    const auto channels = static_cast<double>(count);
+
+    // acquisition, every channel searching
+    const std::string acq_role = "Acquisition_" + signal;
+    const uint32_t sampled_ms = std::max(configuration->property(acq_role + ".coherent_integration_time_ms", 1U), 1U);
+    const bool bit_transition = configuration->property(acq_role + ".bit_transition_flag", false);
+    const int32_t doppler_max = configuration->property(acq_role + ".doppler_max", 5000);
+    const float doppler_step = std::max(configuration->property(acq_role + ".doppler_step", 250.0F), 1.0F);
+    const uint32_t max_dwells = std::max(configuration->property(acq_role + ".max_dwells", 1U), 1U);
+    const auto consumed = static_cast<uint64_t>(std::round(d_fs * sampled_ms / 1000.0 * (bit_transition ? 2.0 : 1.0)));
+    double dwell_ns = 0.0;
+    uint64_t acq_memory = 0;
+    if (configuration->property(acq_role + ".high_sensitivity", false) and sampled_ms >= 2 * sig->code_ms)
+        {
+            // correlations of each code period, and an FFT across them per
+            // code phase and Doppler rate (see Acq_High_Sensitivity_Search)
+            const uint32_t code_periods = sampled_ms / sig->code_ms;
+            const double coarse_step = 0.5 / code_s;
+            const double coarse_bins = 2.0 * std::ceil(std::max(doppler_max, 0) / coarse_step) + 1.0;
+            uint64_t fine_fft_size = 4;
+            while (fine_fft_size < 2U * code_periods)
+                {
+                    fine_fft_size *= 2;
+                }
+            const double block_s = code_s * code_periods;
+            const double rate_max = configuration->property(acq_role + ".doppler_rate_max", 0.0);
+            double rate_step = configuration->property(acq_role + ".doppler_rate_step", 0.0);
+            rate_step = (rate_step > 0.0 ? rate_step : 1.0 / (block_s * block_s));
+            const double rates = (rate_max > 0.0 ? 2.0 * std::ceil(rate_max / rate_step - 1e-6) + 1.0 : 1.0);
+            const double periods_ns = code_periods * (2.0 * fft_ns(d_costs, samples_per_code) + 3.0 * d_costs.multiply_ns_per_sample * static_cast<double>(samples_per_code));
+            const double fine_ns = rates * static_cast<double>(samples_per_code) * (fft_ns(d_costs, fine_fft_size) + (code_periods + fine_fft_size) * d_costs.multiply_ns_per_sample);
+            dwell_ns = coarse_bins * (periods_ns + fine_ns);
+            acq_memory = (static_cast<uint64_t>(code_periods) + 4U) * samples_per_code * sizeof(gr_complex) + std::max(consumed, samples_per_code) * sizeof(gr_complex);
+        }
+    else
+        {
+            const uint64_t fft_size = (sampled_ms == sig->code_ms ? consumed : 2U * consumed);
+            const double bins = std::ceil(2.0 * doppler_max / doppler_step) + 1.0;
+            dwell_ns = bins * (2.0 * fft_ns(d_costs, fft_size) + static_cast<double>(fft_size) * (2.0 * d_costs.multiply_ns_per_sample + d_costs.peak_search_ns_per_sample));
+            // Doppler wipeoffs and magnitudes of the grid, and the FFT buffers
+            acq_memory = static_cast<uint64_t>(bins) * fft_size * (sizeof(gr_complex) + sizeof(float)) + 5U * fft_size * sizeof(gr_complex);
+        }
+    d_acq_max_samples = std::max(d_acq_max_samples, consumed);
+    const double dwell_s = static_cast<double>(consumed) / std::max(d_fs, 1.0);
+    Capacity_Stage acquisition;
+    acquisition.name = acq_role;
+    std::ostringstream acq_note;
+    acq_note << count << " channel(s), " << std::fixed << std::setprecision(1) << dwell_ns * 1e-6 * max_dwells << " ms of CPU per satellite searched";
+    acquisition.note = acq_note.str();
+    // with blocking, a search takes the core of the channel while the samples pass
+    acquisition.thread_cores = std::min(dwell_ns * 1e-9 / std::max(dwell_s, 1e-9), 1.0);
+    acquisition.cores = channels * acquisition.thread_cores;
+    acquisition.memory_bytes = static_cast<uint64_t>(count) * (acq_memory + BLOCK_BASE_BYTES);
+    acquisition.realtime = false;
+    d_stages.push_back(acquisition);
+
+    // tracking
+    const std::string trk_role = "Tracking_" + signal;
+    uint32_t correlators = (sig->veml ? 5U : 3U);
+    // the prompt correlator of the data component
+    correlators += ((sig->pilot and configuration->property(trk_role + ".track_pilot", true)) ? 1U : 0U);
+    correlators += configuration->property(trk_role + ".sqm_taps", 0U);
+    const auto elements = static_cast<double>(std::max(configuration->property(trk_role + ".array_elements", 1U), 1U));
+    Capacity_Stage tracking;
+    tracking.name = trk_role;
+    tracking.note = std::to_string(count) + " channel(s), " + std::to_string(correlators) + " correlators";
+    tracking.thread_cores = elements * d_fs * (correlators * d_costs.correlator_ns_per_sample + d_costs.multiply_ns_per_sample) * 1e-9;
+    tracking.cores = channels * tracking.thread_cores;
+    // local code replicas of an integration period
+    tracking.memory_bytes = static_cast<uint64_t>(count) * ((correlators + 1U) * samples_per_code * sizeof(gr_complex) + BLOCK_BASE_BYTES);
+    tracking.buffer_bytes = static_cast<uint64_t>(count) * gr_buffer_bytes(1U, sizeof(Gnss_Synchro));
+    if (configuration->property(trk_role + ".dump", false))
+        {
+            tracking.dump_bytes_per_s = channels * TRACKING_DUMP_RECORD_BYTES / code_s;
+        }
+    d_stages.push_back(tracking);
+
+    Capacity_Stage telemetry;
+    telemetry.name = "TelemetryDecoder_" + signal;
+    telemetry.note = std::to_string(count) + " channel(s)";
+    telemetry.thread_cores = d_costs.telemetry_cores_per_channel;
+    telemetry.cores = channels * telemetry.thread_cores;
+    telemetry.memory_bytes = static_cast<uint64_t>(count) * BLOCK_BASE_BYTES;
+    telemetry.buffer_bytes = static_cast<uint64_t>(count) * gr_buffer_bytes(1U, sizeof(Gnss_Synchro));
+    d_stages.push_back(telemetry);
+}
+
+
+void Capacity_Planner::plan_observables_pvt(const ConfigurationInterface* configuration, int32_t channels)
+{
+    const uint32_t interval_ms = std::max(configuration->property("GNSS-SDR.observable_interval_ms", 20U), 1U);
+    const uint32_t pvt_interval_ms = std::max(configuration->property("Observables.pvt_interval_ms", 0U), interval_ms);
+    Capacity_Stage observables;
+    observables.name = "Observables";
+    observables.note = "an epoch every " + std::to_string(interval_ms) + " ms";
+    observables.cores = static_cast<double>(channels) * d_costs.observables_ns_per_channel_epoch * 1e-9 * 1000.0 / interval_ms;
+    observables.thread_cores = observables.cores;
+    observables.memory_bytes = BLOCK_BASE_BYTES;
+    observables.buffer_bytes = static_cast<uint64_t>(channels) * gr_buffer_bytes(1U, sizeof(Gnss_Synchro)) * (pvt_interval_ms > interval_ms ? 2U : 1U);
+    if (configuration->property("Observables.dump", false))
+        {
+            observables.dump_bytes_per_s = static_cast<double>(channels) * 7.0 * sizeof(double) * 1000.0 / interval_ms;
+        }
+    d_stages.push_back(observables);
+
+    const int32_t output_rate_ms = std::max(configuration->property("PVT.output_rate_ms", 500), static_cast<int32_t>(pvt_interval_ms));
+    Capacity_Stage pvt;
+    pvt.name = "PVT";
+    pvt.note = "a fix every " + std::to_string(output_rate_ms) + " ms";
+    // the observables of every epoch are processed, even without a fix
+    pvt.cores = d_costs.pvt_ns_per_fix * 1e-9 * 1000.0 / output_rate_ms + static_cast<double>(channels) * d_costs.observables_ns_per_channel_epoch * 1e-9 * 1000.0 / pvt_interval_ms;
+    pvt.thread_cores = pvt.cores;
+    pvt.memory_bytes = 4U * 1048576U;
+    d_stages.push_back(pvt);
+}
+
+
+double Capacity_Planner::realtime_cores() const
+{
+    double cores = 0.0;
+    for (const auto& stage : d_stages)
+        {
+            cores += (stage.realtime ? stage.cores : 0.0);
+        }
+    return cores;
+}
+
+
+double Capacity_Planner::headroom() const
+{
+    bool cpus_bound = false;
+    const std::string stage = saturating_stage(cpus_bound);
+    if (cpus_bound or stage.empty())
+        {
+            const double cores = realtime_cores();
+            return (cores > 0.0 ? static_cast<double>(d_cpus) / cores : std::numeric_limits<double>::infinity());
+        }
+    const auto it = std::find_if(d_stages.cbegin(), d_stages.cend(), [&stage](const Capacity_Stage& s) { return s.name == stage; });
+    return 1.0 / it->thread_cores;
+}
+
+
+std::string Capacity_Planner::saturating_stage(bool& cpus_bound) const
+{
+    const Capacity_Stage* largest = nullptr;
+    const Capacity_Stage* busiest = nullptr;
+    for (const auto& stage : d_stages)
+        {
+            if (!stage.realtime)
+                {
+                    continue;
+                }
+            if (largest == nullptr or stage.cores > largest->cores)
+                {
+                    largest = &stage;
+                }
+            if (busiest == nullptr or stage.thread_cores > busiest->thread_cores)
+                {
+                    busiest = &stage;
+                }
+        }
+    if (largest == nullptr)
+        {
+            cpus_bound = false;
+            return std::string();
+        }
+    // the CPUs saturate first if the load reaches them before a block fills its core
+    cpus_bound = (realtime_cores() / static_cast<double>(d_cpus) >= busiest->thread_cores);
+    return (cpus_bound ? largest->name : busiest->name);
+}
+
+
+uint64_t Capacity_Planner::total_memory_bytes() const
+{
+    uint64_t bytes = 0;
+    for (const auto& stage : d_stages)
+        {
+            bytes += stage.memory_bytes + stage.buffer_bytes;
+        }
+    return bytes;
+}
+
+
+double Capacity_Planner::largest_request_s() const
+{
+    return (d_fs > 0.0 ? static_cast<double>(d_acq_max_samples) / d_fs : 0.0);
+}
+
+
+std::string Capacity_Planner::report() const
+{
+    std::ostringstream out;
+    out << std::fixed;
+    out << std::left << std::setw(22) << "Stage" << std::right << std::setw(8) << "Cores" << std::setw(10) << "Busiest"
+        << std::setw(12) << "Memory MiB" << std::setw(13) << "Buffers MiB" << std::setw(11) << "Dump MB/s" << "  Details\n";
+    double acquisition_cores = 0.0;
+    double dump_bytes_per_s = 0.0;
+    for (const auto& stage : d_stages)
+        {
+            out << std::left << std::setw(22) << stage.name << std::right << std::setprecision(3) << std::setw(8) << stage.cores
+                << std::setw(10) << stage.thread_cores << std::setw(12) << mib(stage.memory_bytes) << std::setw(13) << mib(stage.buffer_bytes)
+                << std::setprecision(2) << std::setw(11) << stage.dump_bytes_per_s / 1e6 << "  " << stage.note
+                << (stage.realtime ? "" : " (not realtime)") << '\n';
+            acquisition_cores += (stage.realtime ? 0.0 : stage.cores);
+            dump_bytes_per_s += stage.dump_bytes_per_s;
+        }
+    out << std::setprecision(2);
+    out << "Realtime stages: " << realtime_cores() << " cores of " << d_cpus << " CPUs. Acquisition with every channel searching: "
+        << acquisition_cores << " cores, with " << std::max(static_cast<double>(d_cpus) - realtime_cores(), 0.0) << " spare.\n";
+    out << "Memory: " << mib(total_memory_bytes()) << " MiB. Dumps: " << dump_bytes_per_s / 1e6 << " MB/s.\n";
+    bool cpus_bound = false;
+    const std::string stage = saturating_stage(cpus_bound);
+    if (stage.empty())
+        {
+            out << "No realtime stage is configured.\n";
+            return out.str();
+        }
+    out << (realtime_achievable() ? "Real time is achievable" : "Real time is NOT achievable") << ", with a headroom of " << headroom() << "x. ";
+    if (cpus_bound)
+        {
+            out << "The CPUs saturate first, and " << stage << " is the largest stage.\n";
+        }
+    else
+        {
+            out << stage << " saturates first, when its busiest block fills a core.\n";
+        }
+    return out.str();
+}
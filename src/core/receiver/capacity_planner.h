@@ -0,0 +1,156 @@
+/*!
+ * \file capacity_planner.h
+ * \brief Estimates the CPU, memory and buffers that a configuration needs,
+ * before running it.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_CAPACITY_PLANNER_H
+#define GNSS_SDR_CAPACITY_PLANNER_H
+
+#include "configuration_interface.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver
+ * \{ */
+
+
+/*!
+ * \brief Costs of the processing on the target machine.
+ *
+ * The defaults are those of a recent x86-64 core with AVX2. They are
+ * replaced by the Capacity.* properties, which
+ * src/utils/scripts/gnss-sdr-capacity-calibrate.py writes from the results
+ * of the benchmarks of src/tests/benchmarks run on the target machine.
+ */
+struct Capacity_Cost_Model
+{
+    double fft_ns_per_point_log2{0.25};         //!< FFT time over N log2(N) (bm_stage_fft, bm_stage_ifft)
+    double multiply_ns_per_sample{0.3};         //!< Complex vector multiplication (bm_stage_wipeoff, bm_stage_multiply)
+    double peak_search_ns_per_sample{0.4};      //!< Magnitude and maximum of a correlation (bm_stage_peak_search)
+    double source_ns_per_sample{1.0};           //!< Unpacking of the samples of a source (bm_unpacker)
+    double conditioner_ns_per_sample{5.0};      //!< Signal conditioner chain (bm_fused_signal_conditioner)
+    double correlator_ns_per_sample{0.8};       //!< Tracking, per correlator and per sample, including the code resampling
+    double telemetry_cores_per_channel{0.002};  //!< Telemetry decoder of a channel (bm_telemetry_decoder)
+    double observables_ns_per_channel_epoch{5000.0};
+    double pvt_ns_per_fix{500000.0};
+
+    void SetFromConfiguration(const ConfigurationInterface* calibration);
+};
+
+
+/*!
+ * \brief Estimated needs of a stage of the flowgraph
+ */
+struct Capacity_Stage
+{
+    std::string name;
+    std::string note;              //!< Details of the blocks of the stage
+    double cores{0.0};             //!< CPU load of all the blocks of the stage [cores]
+    double thread_cores{0.0};      //!< CPU load of its busiest block, which runs in one thread [cores]
+    uint64_t memory_bytes{0};      //!< Memory of the blocks
+    uint64_t buffer_bytes{0};      //!< Output buffers of the blocks
+    double dump_bytes_per_s{0.0};  //!< Written to the dump files
+    bool realtime{true};           //!< It has to keep up with the samples
+};
+
+
+/*!
+ * \brief Pre-flight capacity planner.
+ *
+ * The stages are those that the flowgraph builds for the configuration
+ * (signal sources, signal conditioners, acquisition, tracking and telemetry
+ * decoding of the channels of each signal, observables and PVT), read from
+ * the same properties, but without creating the blocks, so no device is
+ * opened and no file is read. The load of each stage is the product of its
+ * operations per second and the costs of the model.
+ *
+ * Real time is achievable if the realtime stages fit in the CPUs, and each
+ * of their blocks in a core, since each block runs in its own thread. The
+ * acquisition does not have to keep up with the samples (with blocking=true
+ * it skips them while it searches), so its load is reported as the load of
+ * all the channels searching at the same time, as after the start.
+ */
+class Capacity_Planner
+{
+public:
+    /*!
+     * \brief Plans the configuration for cpus CPUs (0 for the CPUs of this
+     * machine) with the costs of the calibration, which can be the
+     * configuration itself or nullptr for the default costs.
+     */
+    Capacity_Planner(const ConfigurationInterface* configuration, const ConfigurationInterface* calibration, unsigned int cpus = 0);
+
+    inline const std::vector<Capacity_Stage>& stages() const
+    {
+        return d_stages;
+    }
+
+    inline unsigned int cpus() const
+    {
+        return d_cpus;
+    }
+
+    //! Load of the realtime stages [cores]
+    double realtime_cores() const;
+
+    /*!
+     * \brief Factor by which the load of the realtime stages can grow until
+     * a block fills its core or the stages fill the CPUs. Real time is
+     * achievable if it is above 1.
+     */
+    double headroom() const;
+
+    inline bool realtime_achievable() const
+    {
+        return headroom() > 1.0;
+    }
+
+    /*!
+     * \brief Stage that saturates first when the load grows, and whether it
+     * is because of the CPUs (the largest stage then) or of its busiest
+     * block.
+     */
+    std::string saturating_stage(bool& cpus_bound) const;
+
+    //! Memory of the blocks and buffers [bytes]
+    uint64_t total_memory_bytes() const;
+
+    /*!
+     * \brief Longest span of samples that a consumer of the outputs of the
+     * signal conditioners reads at once (the dwell of an acquisition) [s]
+     */
+    double largest_request_s() const;
+
+    //! Table of the stages and verdict, for the console
+    std::string report() const;
+
+private:
+    void plan_sources(const ConfigurationInterface* configuration);
+    void plan_channels(const ConfigurationInterface* configuration, const std::string& signal, int32_t count);
+    void plan_observables_pvt(const ConfigurationInterface* configuration, int32_t channels);
+
+    Capacity_Cost_Model d_costs;
+    std::vector<Capacity_Stage> d_stages;
+    double d_fs{0.0};
+    uint64_t d_acq_max_samples{0};  // largest request of an acquisition to the conditioner buffers
+    unsigned int d_cpus;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_CAPACITY_PLANNER_H
@@ -1,6 +1,6 @@
 /*!
  * \file concurrent_queue.h
- * \brief Interface of a thread-safe std::queue
+ * \brief Interface of a thread-safe queue with lock-free producers
  * \author Javier Arribas, 2011. jarribas(at)cttc.es
  *
  * -----------------------------------------------------------------------------
@@ -8,7 +8,7 @@
  * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
  * This file is part of GNSS-SDR.
  *
- * Copyright (C) 2010-2020  (see AUTHORS file for a list of contributors)
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
  * SPDX-License-Identifier: GPL-3.0-or-later
  *
  * -----------------------------------------------------------------------------
@@ -17,11 +17,15 @@
 #ifndef GNSS_SDR_CONCURRENT_QUEUE_H
 #define GNSS_SDR_CONCURRENT_QUEUE_H
 
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <cstddef>
+#include <deque>
 #include <mutex>
-#include <queue>
 #include <thread>
+#include <utility>
+#include <vector>
 
 /** \addtogroup Core
  * \{ */
@@ -32,70 +36,203 @@
 template <typename Data>
 
 /*!
- * \brief This class implements a thread-safe std::queue
+ * \brief This class implements a thread-safe FIFO queue
  *
- * Thread-safe object queue which uses the library
- * boost_thread to perform MUTEX based on the code available at
+ * Many threads (the channels, the PVT block, the telecommand interface...)
+ * push messages to the control queue, and usually a single thread pops them.
+ * The producers push to a lock-free stack with a single compare-and-swap,
+ * so they never wait for each other nor for the consumer. The consumer takes
+ * the whole stack at once and restores the FIFO order, so the items can be
+ * also popped in batches with try_pop_all() and timed_wait_and_pop_all().
+ *
+ * The producers only lock the mutex to wake up a consumer that is waiting
+ * for an empty queue, based on the condition variable scheme described in
  * https://www.justsoftwaresolutions.co.uk/threading/implementing-a-thread-safe-queue-using-condition-variables.html
  */
 class Concurrent_Queue
 {
 public:
+    Concurrent_Queue() = default;
+
+    ~Concurrent_Queue()
+    {
+        Node* node = the_stack.load(std::memory_order_acquire);
+        while (node != nullptr)
+            {
+                Node* next = node->next;
+                delete node;
+                node = next;
+            }
+    }
+
+    Concurrent_Queue(const Concurrent_Queue&) = delete;
+    Concurrent_Queue& operator=(const Concurrent_Queue&) = delete;
+
     void push(Data const& data)
     {
-        std::unique_lock<std::mutex> lock(the_mutex);
-        the_queue.push(data);
-        lock.unlock();
-        the_condition_variable.notify_one();
+        Node* node = new Node(data);
+        node->next = the_stack.load(std::memory_order_relaxed);
+        while (!the_stack.compare_exchange_weak(node->next, node))
+            {
+            }
+        if (the_waiting_consumers.load() > 0)
+            {
+                std::lock_guard<std::mutex> lock(the_mutex);
+                the_condition_variable.notify_one();
+            }
     }
 
     bool empty() const
     {
         std::unique_lock<std::mutex> lock(the_mutex);
-        return the_queue.empty();
+        return !has_items_locked();
     }
 
     bool try_pop(Data& popped_value)
     {
         std::unique_lock<std::mutex> lock(the_mutex);
-        if (the_queue.empty())
-            {
-                return false;
-            }
-        popped_value = the_queue.front();
-        the_queue.pop();
-        return true;
+        return pop_locked(popped_value);
+    }
+
+    /*!
+     * \brief Moves all the items in the queue to popped_values, in FIFO
+     * order, and returns how many there were
+     */
+    size_t try_pop_all(std::vector<Data>& popped_values)
+    {
+        std::unique_lock<std::mutex> lock(the_mutex);
+        return pop_all_locked(popped_values);
     }
 
     void wait_and_pop(Data& popped_value)
     {
         std::unique_lock<std::mutex> lock(the_mutex);
-        while (the_queue.empty())
+        while (!pop_locked(popped_value))
             {
-                the_condition_variable.wait(lock);
+                the_waiting_consumers++;
+                the_condition_variable.wait(lock, [this] { return has_items_locked(); });
+                the_waiting_consumers--;
             }
-        popped_value = the_queue.front();
-        the_queue.pop();
     }
 
     bool timed_wait_and_pop(Data& popped_value, int wait_ms)
     {
         std::unique_lock<std::mutex> lock(the_mutex);
-        if (the_queue.empty())
+        if (pop_locked(popped_value))
             {
-                the_condition_variable.wait_for(lock, std::chrono::milliseconds(wait_ms));
-                if (the_queue.empty())
+                return true;
+            }
+        wait_locked(lock, wait_ms);
+        return pop_locked(popped_value);
+    }
+
+    /*!
+     * \brief Waits up to wait_ms ms for the queue to have any item, then
+     * moves all of them to popped_values and returns how many there were
+     */
+    size_t timed_wait_and_pop_all(std::vector<Data>& popped_values, int wait_ms)
+    {
+        std::unique_lock<std::mutex> lock(the_mutex);
+        if (!has_items_locked())
+            {
+                wait_locked(lock, wait_ms);
+            }
+        return pop_all_locked(popped_values);
+    }
+
+    /*!
+     * \brief Waits until the deadline for the queue to have any item, then
+     * moves all of them to popped_values and returns how many there were
+     */
+    size_t wait_until_and_pop_all(std::vector<Data>& popped_values, std::chrono::steady_clock::time_point deadline)
+    {
+        std::unique_lock<std::mutex> lock(the_mutex);
+        if (!has_items_locked())
+            {
+                the_waiting_consumers++;
+                the_condition_variable.wait_until(lock, deadline, [this] { return has_items_locked(); });
+                the_waiting_consumers--;
+            }
+        return pop_all_locked(popped_values);
+    }
+
+private:
+    struct Node
+    {
+        explicit Node(Data const& d) : data(d) {}
+        Data data;
+        Node* next{nullptr};
+    };
+
+    // Another consumer may have already taken pushed items to the_items,
+    // so both have to be checked to wait only for an empty queue
+    bool has_items_locked() const
+    {
+        return !the_items.empty() || the_stack.load() != nullptr;
+    }
+
+    // Moves the pushed items to the_items, restoring the FIFO order
+    void take_pushed_locked()
+    {
+        Node* node = the_stack.exchange(nullptr);
+        Node* reversed = nullptr;
+        while (node != nullptr)
+            {
+                Node* next = node->next;
+                node->next = reversed;
+                reversed = node;
+                node = next;
+            }
+        while (reversed != nullptr)
+            {
+                Node* next = reversed->next;
+                the_items.push_back(std::move(reversed->data));
+                delete reversed;
+                reversed = next;
+            }
+    }
+
+    bool pop_locked(Data& popped_value)
+    {
+        if (the_items.empty())
+            {
+                take_pushed_locked();
+                if (the_items.empty())
                     {
                         return false;
                     }
             }
-        popped_value = the_queue.front();
-        the_queue.pop();
+        popped_value = std::move(the_items.front());
+        the_items.pop_front();
         return true;
     }
 
-private:
-    std::queue<Data> the_queue;
+    size_t pop_all_locked(std::vector<Data>& popped_values)
+    {
+        take_pushed_locked();
+        popped_values.clear();
+        popped_values.reserve(the_items.size());
+        for (auto& item : the_items)
+            {
+                popped_values.push_back(std::move(item));
+            }
+        the_items.clear();
+        return popped_values.size();
+    }
+
+    void wait_locked(std::unique_lock<std::mutex>& lock, int wait_ms)
+    {
+        // the producers check the_waiting_consumers after pushing, and this
+        // thread checks the stack after incrementing it (both sequentially
+        // consistent), so a push cannot be missed
+        the_waiting_consumers++;
+        the_condition_variable.wait_for(lock, std::chrono::milliseconds(wait_ms), [this] { return has_items_locked(); });
+        the_waiting_consumers--;
+    }
+
+    std::atomic<Node*> the_stack{nullptr};  // items pushed, in LIFO order
+    std::atomic<int> the_waiting_consumers{0};
+    std::deque<Data> the_items;  // items taken from the_stack, in FIFO order
     mutable std::mutex the_mutex;
     std::condition_variable the_condition_variable;
 };
@@ -34,8 +34,11 @@
 #include "glonass_gnav_ephemeris.h"
 #include "glonass_gnav_utc_model.h"
 #include "gnss_flowgraph.h"
+#include "gnss_frequencies.h"
+#include "gnss_nav_product_channel.h"
 #include "gnss_satellite.h"
 #include "gnss_sdr_flags.h"
+#include "gnss_trace.h"
 #include "gps_acq_assist.h"        // for Gps_Acq_Assist
 #include "gps_almanac.h"           // for Gps_Almanac
 #include "gps_cnav_ephemeris.h"    // for Gps_CNAV_Ephemeris
@@ -46,13 +49,14 @@
 #include "pvt_interface.h"         // for PvtInterface
 #include "rtklib.h"                // for gtime_t, alm_t
 #include "rtklib_conversions.h"    // for alm_to_rtklib
-#include "rtklib_ephemeris.h"      // for alm2pos, eph2pos
+#include "rtklib_ephemeris.h"      // for alm2pos
 #include "rtklib_rtkcmn.h"         // for utc2gpst
 #include <armadillo>               // for interaction with geofunctions
 #include <boost/lexical_cast.hpp>  // for bad_lexical_cast
 #include <glog/logging.h>          // for LOG
 #include <pmt/pmt.h>               // for make_any
-#include <algorithm>               // for find, min
+#include <algorithm>               // for equal, find, min, stable_sort
+#include <cerrno>                  // for errno
 #include <chrono>                  // for milliseconds
 #include <cmath>                   // for floor, fmod, log
 #include <ctime>                   // for time_t, gmtime, strftime
@@ -60,10 +64,13 @@
 #include <iostream>                // for operator<<
 #include <limits>                  // for numeric_limits
 #include <map>                     // for map
+#include <poll.h>                  // for poll
 #include <pthread.h>               // for pthread_cancel
 #include <stdexcept>               // for invalid_argument
 #include <sys/ipc.h>               // for IPC_CREAT
 #include <sys/msg.h>               // for msgctl, msgget
+#include <sys/stat.h>              // for stat
+#include <unistd.h>                // for pipe, read, write, close
 
 #ifdef ENABLE_FPGA
 #include <boost/chrono.hpp>  // for steady_clock
@@ -83,12 +90,13 @@ ControlThread::ControlThread()
 {
     if (FLAGS_c == "-")
         {
-            configuration_ = std::make_shared<FileConfiguration>(FLAGS_config_file);
+            config_file_ = FLAGS_config_file;
         }
     else
         {
-            configuration_ = std::make_shared<FileConfiguration>(FLAGS_c);
+            config_file_ = FLAGS_c;
         }
+    configuration_ = std::make_shared<FileConfiguration>(config_file_);
     // Basic configuration checks
     auto aux = std::dynamic_pointer_cast<FileConfiguration>(configuration_);
     conf_file_has_section_ = aux->has_section();
@@ -145,6 +153,8 @@ ControlThread::ControlThread(std::shared_ptr<ConfigurationInterface> configurati
 void ControlThread::init()
 {
     telecommand_enabled_ = configuration_->property("GNSS-SDR.telecommand_enabled", false);
+    // an application embedding the receiver keeps its standard input
+    keyboard_enabled_ = FLAGS_keyboard and configuration_->property("GNSS-SDR.keyboard", true);
     // OPTIONAL: specify a custom year to override the system time in order to postprocess old gnss records and avoid wrong week rollover
     pre_2009_file_ = configuration_->property("GNSS-SDR.pre_2009_file", false);
     // Instantiates a control queue, a GNSS flowgraph, and a control message factory
@@ -152,6 +162,7 @@ void ControlThread::init()
     cmd_interface_.set_msg_queue(control_queue_);  // set also the queue pointer for the telecommand thread
     if (well_formatted_configuration_)
         {
+            prepare_checkpoint_resume();
             try
                 {
                     flowgraph_ = std::make_shared<GNSSFlowgraph>(configuration_, control_queue_);
@@ -173,9 +184,22 @@ void ControlThread::init()
     supl_mns_ = 0;
     supl_lac_ = 0;
     supl_ci_ = 0;
+    supl_refresh_period_ = std::chrono::steady_clock::duration::zero();
+    supl_request_pending_ = false;
     msqid_ = -1;
     agnss_ref_location_ = Agnss_Ref_Location();
     agnss_ref_time_ = Agnss_Ref_Time();
+    snapshot_file_ = configuration_->property("GNSS-SDR.snapshot_file", std::string(""));
+    snapshot_period_ = std::chrono::seconds(configuration_->property("GNSS-SDR.snapshot_period_s", 60));
+    last_snapshot_time_ = std::chrono::steady_clock::now();
+    last_checkpoint_time_ = std::chrono::steady_clock::now();
+    sky_prediction_period_ = std::chrono::milliseconds(configuration_->property("GNSS-SDR.sky_prediction_period_ms", 1000));
+    telecommand_status_period_ = std::chrono::milliseconds(configuration_->property("GNSS-SDR.telecommand_status_period_ms", 1000));
+    last_telecommand_status_time_ = std::chrono::steady_clock::now();
+    last_sky_prediction_time_ = std::chrono::steady_clock::now();
+    pvt_jump_threshold_m_ = std::max(configuration_->property("GNSS-SDR.capture_pvt_jump_m", 0.0), 0.0);
+    last_pvt_jump_check_time_ = std::chrono::steady_clock::now();
+    sky_prediction_ = Gnss_Sky_Prediction::get();
 
     const std::string empty_string;
     const std::string ref_location_str = configuration_->property("GNSS-SDR.AGNSS_ref_location", empty_string);
@@ -263,6 +287,11 @@ ControlThread::~ControlThread()  // NOLINT(modernize-use-equals-default)
         {
             cmd_interface_thread_.join();
         }
+
+    if (supl_thread_.joinable())
+        {
+            supl_thread_.join();
+        }
 }
 
 
@@ -281,35 +310,30 @@ void ControlThread::event_dispatcher(bool &valid_event, pmt::pmt_t &msg)
     if (valid_event)
         {
             processed_control_messages_++;
-            const size_t msg_type_hash_code = pmt::any_ref(msg).type().hash_code();
-            if (msg_type_hash_code == channel_event_type_hash_code_)
+            Control_Event event{};
+            if (control_event_from_pmt(msg, event))
                 {
-                    if (receiver_on_standby_ == false)
+                    if (event.kind == Control_Event::channel)
+                        {
+                            dispatch_channel_event(static_cast<int>(event.id), event.event_type);
+                        }
+                    else
                         {
-                            const auto new_event = wht::any_cast<channel_event_sptr>(pmt::any_ref(msg));
-                            DLOG(INFO) << "New channel event rx from ch id: " << new_event->channel_id
-                                       << " what: " << new_event->event_type;
-                            flowgraph_->apply_action(new_event->channel_id, new_event->event_type);
+                            dispatch_command_event(static_cast<int>(event.id), event.event_type);
                         }
+                    return;
+                }
+            // events boxed by the code that does not use Control_Event yet
+            const size_t msg_type_hash_code = pmt::any_ref(msg).type().hash_code();
+            if (msg_type_hash_code == channel_event_type_hash_code_)
+                {
+                    const auto new_event = wht::any_cast<channel_event_sptr>(pmt::any_ref(msg));
+                    dispatch_channel_event(new_event->channel_id, new_event->event_type);
                 }
             else if (msg_type_hash_code == command_event_type_hash_code_)
                 {
                     const auto new_event = wht::any_cast<command_event_sptr>(pmt::any_ref(msg));
-                    DLOG(INFO) << "New command event rx from ch id: " << new_event->command_id
-                               << " what: " << new_event->event_type;
-
-                    if (new_event->command_id == 200)
-                        {
-                            apply_action(new_event->event_type);
-                        }
-                    else
-                        {
-                            if (new_event->command_id == 300)  // some TC commands require also actions from control_thread
-                                {
-                                    apply_action(new_event->event_type);
-                                }
-                            flowgraph_->apply_action(new_event->command_id, new_event->event_type);
-                        }
+                    dispatch_command_event(new_event->command_id, new_event->event_type);
                 }
             else
                 {
@@ -327,6 +351,64 @@ void ControlThread::event_dispatcher(bool &valid_event, pmt::pmt_t &msg)
 }
 
 
+void ControlThread::dispatch_channel_event(int channel_id, int what)
+{
+    static const char* const trace_names[] = {"what", nullptr};
+    const Gnss_Trace_Scope trace("channel_event", channel_id, trace_names, what);
+    if (receiver_on_standby_ == false)
+        {
+            DLOG(INFO) << "New channel event rx from ch id: " << channel_id
+                       << " what: " << what;
+            flowgraph_->apply_action(channel_id, what);
+        }
+}
+
+
+void ControlThread::dispatch_command_event(int command_id, int what)
+{
+    static const char* const trace_names[] = {"who", "what", nullptr};
+    const Gnss_Trace_Scope trace("command_event", -1, trace_names, command_id, what);
+    DLOG(INFO) << "New command event rx from ch id: " << command_id
+               << " what: " << what;
+    if (command_id == 200)
+        {
+            apply_action(what);
+        }
+    else if (command_id >= 400 and what == 22)
+        {
+            reconfigure_channel(command_id - 400);
+        }
+    else
+        {
+            if (command_id == 300)  // some TC commands require also actions from control_thread
+                {
+                    apply_action(what);
+                }
+            flowgraph_->apply_action(command_id, what);
+        }
+}
+
+
+void ControlThread::event_dispatcher(std::vector<pmt::pmt_t> &msgs)
+{
+    bool valid_event = !msgs.empty();
+    if (!valid_event)
+        {
+            pmt::pmt_t msg;
+            event_dispatcher(valid_event, msg);
+            return;
+        }
+    for (auto &msg : msgs)
+        {
+            event_dispatcher(valid_event, msg);
+            if (stop_)
+                {
+                    break;
+                }
+        }
+}
+
+
 /*
  * Runs the control thread that manages the receiver control plane
  *
@@ -344,6 +426,18 @@ int ControlThread::run()
             print_help_at_exit();
             return 0;
         }
+    if (resume_checkpoint_)
+        {
+            // the satellites of the checkpoint are assigned first to the
+            // channels, which start tracking them without acquisition
+            std::vector<std::pair<int, Gnss_Satellite>> tracked_sats;
+            for (const auto &channel : resume_checkpoint_->channels)
+                {
+                    tracked_sats.emplace_back(static_cast<int>(channel.CN0_dB_hz), Gnss_Satellite(channel.System, channel.PRN));
+                }
+            flowgraph_->priorize_satellites(tracked_sats);
+            flowgraph_->set_tracking_hints(resume_checkpoint_->channels, checkpoint_sample_offset_);
+        }
     try
         {
             flowgraph_->connect();
@@ -374,9 +468,25 @@ int ControlThread::run()
 
     // launch GNSS assistance process AFTER the flowgraph is running because the GNU Radio asynchronous queues must be already running to transport msgs
     assist_GNSS();
+    if (resume_checkpoint_)
+        {
+            if (!send_navigation_data(resume_checkpoint_->state))
+                {
+                    LOG(WARNING) << "Some navigation data of the checkpoint could not be delivered to PVT";
+                }
+            resume_checkpoint_.reset();
+        }
+    else if (!snapshot_file_.empty())
+        {
+            restore_receiver_snapshot();
+        }
     // start the keyboard_listener thread
-    if (FLAGS_keyboard)
+    if (keyboard_enabled_)
         {
+            if (pipe(keyboard_wakeup_pipe_.data()) != 0)
+                {
+                    keyboard_wakeup_pipe_ = {-1, -1};
+                }
             keyboard_thread_ = std::thread(&ControlThread::keyboard_listener, this);
         }
     sysv_queue_thread_ = std::thread(&ControlThread::sysv_queue_listener, this);
@@ -391,18 +501,57 @@ int ControlThread::run()
         flowgraph_);
 #endif
     // Main loop to read and process the control messages
-    pmt::pmt_t msg;
+    std::vector<pmt::pmt_t> msgs;
     while (flowgraph_->running() && !stop_)
         {
-            // read event messages, triggered by event signaling with a 100 ms timeout to perform low priority receiver management tasks
-            bool valid_event = control_queue_->timed_wait_and_pop(msg, 100);
+            // read all the pending event messages at once, or wake up when the
+            // next periodic task is due, without any fixed polling period
+            control_queue_->wait_until_and_pop_all(msgs, next_wakeup_time());
             // call the new sat dispatcher and receiver controller
-            event_dispatcher(valid_event, msg);
+            event_dispatcher(msgs);
+            flowgraph_->update_realtime_budget();
+            flowgraph_->update_instrumentation();
+            if (!snapshot_file_.empty() and std::chrono::steady_clock::now() - last_snapshot_time_ >= snapshot_period_)
+                {
+                    save_receiver_snapshot();
+                }
+            if (!checkpoint_file_.empty() and std::chrono::steady_clock::now() - last_checkpoint_time_ >= checkpoint_period_)
+                {
+                    save_receiver_checkpoint();
+                }
+            if (sky_prediction_period_.count() > 0 and std::chrono::steady_clock::now() - last_sky_prediction_time_ >= sky_prediction_period_)
+                {
+                    update_sky_prediction();
+                }
+            if (pvt_jump_threshold_m_ > 0.0 and std::chrono::steady_clock::now() - last_pvt_jump_check_time_ >= std::chrono::seconds(1))
+                {
+                    check_pvt_jump();
+                }
+            if (supl_refresh_period_.count() > 0 and std::chrono::steady_clock::now() - last_supl_request_time_ >= supl_refresh_period_)
+                {
+                    start_supl_request();
+                }
+            if (telecommand_enabled_ and cmd_interface_.has_status_subscribers() and std::chrono::steady_clock::now() - last_telecommand_status_time_ >= telecommand_status_period_)
+                {
+                    publish_telecommand_status();
+                }
         }
     std::cout << "Stopping GNSS-SDR, please wait!\n";
+    if (!snapshot_file_.empty())
+        {
+            save_receiver_snapshot();
+        }
+    if (!checkpoint_file_.empty())
+        {
+            save_receiver_checkpoint();
+        }
     flowgraph_->stop();
     stop_ = true;
     flowgraph_->disconnect();
+    if (supl_thread_.joinable())
+        {
+            supl_thread_.join();
+        }
 
 #ifdef ENABLE_FPGA
     // trigger a HW reset
@@ -413,16 +562,30 @@ int ControlThread::run()
     fpga_helper_thread_.try_join_until(boost::chrono::steady_clock::now() + boost::chrono::milliseconds(1000));
 #endif
 
-    // Terminate keyboard thread
-    if (FLAGS_keyboard && keyboard_thread_.joinable())
+    // Terminate keyboard thread, which waits for the keys or for the wake-up pipe
+    if (keyboard_enabled_ && keyboard_thread_.joinable())
         {
-            pthread_t id = keyboard_thread_.native_handle();
-            keyboard_thread_.detach();
+            const char wakeup = 'q';
+            if (keyboard_wakeup_pipe_[1] != -1 and write(keyboard_wakeup_pipe_[1], &wakeup, 1) == 1)
+                {
+                    keyboard_thread_.join();
+                }
+            else
+                {
+                    pthread_t id = keyboard_thread_.native_handle();
+                    keyboard_thread_.detach();
 #ifndef ANDROID
-            pthread_cancel(id);
-#else
-            // todo: find alternative
+                    pthread_cancel(id);
 #endif
+                }
+            for (int& fd : keyboard_wakeup_pipe_)
+                {
+                    if (fd != -1)
+                        {
+                            close(fd);
+                            fd = -1;
+                        }
+                }
         }
 
     // Terminate telecommand thread
@@ -448,6 +611,12 @@ int ControlThread::run()
 }
 
 
+void ControlThread::request_stop()
+{
+    control_queue_->push(control_event_pmt(Control_Event::command, 200, 0));
+}
+
+
 void ControlThread::set_control_queue(std::shared_ptr<Concurrent_Queue<pmt::pmt_t>> control_queue)
 {
     if (flowgraph_->running())
@@ -514,7 +683,7 @@ bool ControlThread::read_assistance_from_XML()
                         {
                             std::cout << "From XML file: Read NAV ephemeris for satellite " << Gnss_Satellite("GPS", gps_eph_iter->second.PRN) << '\n';
                             const std::shared_ptr<Gps_Ephemeris> tmp_obj = std::make_shared<Gps_Ephemeris>(gps_eph_iter->second);
-                            flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                            flowgraph_->send_telemetry_msg(Gnss_Nav_Product(tmp_obj));
                         }
                     ret = true;
                 }
@@ -522,7 +691,7 @@ bool ControlThread::read_assistance_from_XML()
             if (supl_client_acquisition_.load_utc_xml(utc_xml_filename) == true)
                 {
                     const std::shared_ptr<Gps_Utc_Model> tmp_obj = std::make_shared<Gps_Utc_Model>(supl_client_acquisition_.gps_utc);
-                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                    flowgraph_->send_telemetry_msg(Gnss_Nav_Product(tmp_obj));
                     std::cout << "From XML file: Read GPS UTC model parameters.\n";
                     ret = true;
                 }
@@ -530,7 +699,7 @@ bool ControlThread::read_assistance_from_XML()
             if (supl_client_acquisition_.load_iono_xml(iono_xml_filename) == true)
                 {
                     const std::shared_ptr<Gps_Iono> tmp_obj = std::make_shared<Gps_Iono>(supl_client_acquisition_.gps_iono);
-                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                    flowgraph_->send_telemetry_msg(Gnss_Nav_Product(tmp_obj));
                     std::cout << "From XML file: Read GPS ionosphere model parameters.\n";
                     ret = true;
                 }
@@ -544,7 +713,7 @@ bool ControlThread::read_assistance_from_XML()
                         {
                             std::cout << "From XML file: Read GPS almanac for satellite " << Gnss_Satellite("GPS", gps_alm_iter->second.PRN) << '\n';
                             const std::shared_ptr<Gps_Almanac> tmp_obj = std::make_shared<Gps_Almanac>(gps_alm_iter->second);
-                            flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                            flowgraph_->send_telemetry_msg(Gnss_Nav_Product(tmp_obj));
                         }
                     ret = true;
                 }
@@ -561,7 +730,7 @@ bool ControlThread::read_assistance_from_XML()
                         {
                             std::cout << "From XML file: Read ephemeris for satellite " << Gnss_Satellite("Galileo", gal_eph_iter->second.PRN) << '\n';
                             const std::shared_ptr<Galileo_Ephemeris> tmp_obj = std::make_shared<Galileo_Ephemeris>(gal_eph_iter->second);
-                            flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                            flowgraph_->send_telemetry_msg(Gnss_Nav_Product(tmp_obj));
                         }
                     ret = true;
                 }
@@ -569,7 +738,7 @@ bool ControlThread::read_assistance_from_XML()
             if (supl_client_acquisition_.load_gal_iono_xml(gal_iono_xml_filename) == true)
                 {
                     const std::shared_ptr<Galileo_Iono> tmp_obj = std::make_shared<Galileo_Iono>(supl_client_acquisition_.gal_iono);
-                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                    flowgraph_->send_telemetry_msg(Gnss_Nav_Product(tmp_obj));
                     std::cout << "From XML file: Read Galileo ionosphere model parameters.\n";
                     ret = true;
                 }
@@ -577,7 +746,7 @@ bool ControlThread::read_assistance_from_XML()
             if (supl_client_acquisition_.load_gal_utc_xml(gal_utc_xml_filename) == true)
                 {
                     const std::shared_ptr<Galileo_Utc_Model> tmp_obj = std::make_shared<Galileo_Utc_Model>(supl_client_acquisition_.gal_utc);
-                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                    flowgraph_->send_telemetry_msg(Gnss_Nav_Product(tmp_obj));
                     std::cout << "From XML file: Read Galileo UTC model parameters.\n";
                     ret = true;
                 }
@@ -591,7 +760,7 @@ bool ControlThread::read_assistance_from_XML()
                         {
                             std::cout << "From XML file: Read Galileo almanac for satellite " << Gnss_Satellite("Galileo", gal_alm_iter->second.PRN) << '\n';
                             const std::shared_ptr<Galileo_Almanac> tmp_obj = std::make_shared<Galileo_Almanac>(gal_alm_iter->second);
-                            flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                            flowgraph_->send_telemetry_msg(Gnss_Nav_Product(tmp_obj));
                         }
                     ret = true;
                 }
@@ -608,7 +777,7 @@ bool ControlThread::read_assistance_from_XML()
                         {
                             std::cout << "From XML file: Read CNAV ephemeris for satellite " << Gnss_Satellite("GPS", gps_cnav_eph_iter->second.PRN) << '\n';
                             const std::shared_ptr<Gps_CNAV_Ephemeris> tmp_obj = std::make_shared<Gps_CNAV_Ephemeris>(gps_cnav_eph_iter->second);
-                            flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                            flowgraph_->send_telemetry_msg(Gnss_Nav_Product(tmp_obj));
                         }
                     ret = true;
                 }
@@ -616,7 +785,7 @@ bool ControlThread::read_assistance_from_XML()
             if (supl_client_acquisition_.load_cnav_utc_xml(cnav_utc_xml_filename) == true)
                 {
                     const std::shared_ptr<Gps_CNAV_Utc_Model> tmp_obj = std::make_shared<Gps_CNAV_Utc_Model>(supl_client_acquisition_.gps_cnav_utc);
-                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                    flowgraph_->send_telemetry_msg(Gnss_Nav_Product(tmp_obj));
                     std::cout << "From XML file: Read GPS CNAV UTC model parameters.\n";
                     ret = true;
                 }
@@ -633,7 +802,7 @@ bool ControlThread::read_assistance_from_XML()
                         {
                             std::cout << "From XML file: Read GLONASS GNAV ephemeris for satellite " << Gnss_Satellite("GLONASS", glo_gnav_eph_iter->second.PRN) << '\n';
                             const std::shared_ptr<Glonass_Gnav_Ephemeris> tmp_obj = std::make_shared<Glonass_Gnav_Ephemeris>(glo_gnav_eph_iter->second);
-                            flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                            flowgraph_->send_telemetry_msg(Gnss_Nav_Product(tmp_obj));
                         }
                     ret = true;
                 }
@@ -641,7 +810,7 @@ bool ControlThread::read_assistance_from_XML()
             if (supl_client_acquisition_.load_glo_utc_xml(glo_utc_xml_filename) == true)
                 {
                     const std::shared_ptr<Glonass_Gnav_Utc_Model> tmp_obj = std::make_shared<Glonass_Gnav_Utc_Model>(supl_client_acquisition_.glo_gnav_utc);
-                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
+                    flowgraph_->send_telemetry_msg(Gnss_Nav_Product(tmp_obj));
                     std::cout << "From XML file: Read GLONASS UTC model parameters.\n";
                     ret = true;
                 }
@@ -661,8 +830,6 @@ bool ControlThread::read_assistance_from_XML()
             if (supl_client_acquisition_.load_ref_time_xml(ref_time_xml_filename) == true)
                 {
                     LOG(INFO) << "SUPL: Read XML Ref Time";
-                    const std::shared_ptr<Agnss_Ref_Time> tmp_obj = std::make_shared<Agnss_Ref_Time>(supl_client_acquisition_.gps_time);
-                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
                 }
             else
                 {
@@ -673,8 +840,6 @@ bool ControlThread::read_assistance_from_XML()
             if (supl_client_acquisition_.load_ref_location_xml(ref_location_xml_filename) == true)
                 {
                     LOG(INFO) << "SUPL: Read XML Ref Location";
-                    const std::shared_ptr<Agnss_Ref_Location> tmp_obj = std::make_shared<Agnss_Ref_Location>(supl_client_acquisition_.gps_ref_loc);
-                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
                 }
             else
                 {
@@ -749,134 +914,13 @@ void ControlThread::assist_GNSS()
                 }
             else
                 {
-                    // Request ephemeris from SUPL server
-                    supl_client_ephemeris_.request = 1;
-                    std::cout << "SUPL: Try to read GPS ephemeris data from SUPL server...\n";
-                    int error = supl_client_ephemeris_.get_assistance(supl_mcc_, supl_mns_, supl_lac_, supl_ci_);
-                    if (error == 0)
-                        {
-                            std::map<int, Gps_Ephemeris>::const_iterator gps_eph_iter;
-                            for (gps_eph_iter = supl_client_ephemeris_.gps_ephemeris_map.cbegin();
-                                 gps_eph_iter != supl_client_ephemeris_.gps_ephemeris_map.cend();
-                                 gps_eph_iter++)
-                                {
-                                    std::cout << "SUPL: Received ephemeris data for satellite " << Gnss_Satellite("GPS", gps_eph_iter->second.PRN) << '\n';
-                                    const std::shared_ptr<Gps_Ephemeris> tmp_obj = std::make_shared<Gps_Ephemeris>(gps_eph_iter->second);
-                                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
-                                }
-                            // Save ephemeris to XML file
-                            const std::string eph_xml_filename = configuration_->property("GNSS-SDR.SUPL_gps_ephemeris_xml", eph_default_xml_filename_);
-                            if (supl_client_ephemeris_.save_ephemeris_map_xml(eph_xml_filename, supl_client_ephemeris_.gps_ephemeris_map) == true)
-                                {
-                                    std::cout << "SUPL: XML ephemeris data file created\n";
-                                }
-                            else
-                                {
-                                    std::cout << "SUPL: Failed to create XML ephemeris data file\n";
-                                }
-                        }
-                    else
-                        {
-                            std::cout << "ERROR: SUPL client request for ephemeris data returned " << error << '\n';
-                            std::cout << "Please check your network connectivity and SUPL server configuration\n";
-                            std::cout << "Trying to read AGNSS data from local XML file(s)...\n";
-                            if (read_assistance_from_XML() == false)
-                                {
-                                    std::cout << "ERROR: Could not read XML files: Disabling SUPL assistance.\n";
-                                }
-                        }
-
-                    // Request almanac, IONO and UTC Model data
-                    supl_client_ephemeris_.request = 0;
-                    std::cout << "SUPL: Try to read Almanac, Iono, Utc Model, Ref Time and Ref Location data from SUPL server...\n";
-                    error = supl_client_ephemeris_.get_assistance(supl_mcc_, supl_mns_, supl_lac_, supl_ci_);
-                    if (error == 0)
-                        {
-                            std::map<int, Gps_Almanac>::const_iterator gps_alm_iter;
-                            for (gps_alm_iter = supl_client_ephemeris_.gps_almanac_map.cbegin();
-                                 gps_alm_iter != supl_client_ephemeris_.gps_almanac_map.cend();
-                                 gps_alm_iter++)
-                                {
-                                    std::cout << "SUPL: Received almanac data for satellite " << Gnss_Satellite("GPS", gps_alm_iter->second.PRN) << '\n';
-                                    const std::shared_ptr<Gps_Almanac> tmp_obj = std::make_shared<Gps_Almanac>(gps_alm_iter->second);
-                                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
-                                }
-                            supl_client_ephemeris_.save_gps_almanac_xml("gps_almanac_map.xml", supl_client_ephemeris_.gps_almanac_map);
-                            if (supl_client_ephemeris_.gps_iono.valid == true)
-                                {
-                                    std::cout << "SUPL: Received GPS Ionosphere model parameters\n";
-                                    const std::shared_ptr<Gps_Iono> tmp_obj = std::make_shared<Gps_Iono>(supl_client_ephemeris_.gps_iono);
-                                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
-                                }
-                            if (supl_client_ephemeris_.gps_utc.valid == true)
-                                {
-                                    std::cout << "SUPL: Received GPS UTC model parameters\n";
-                                    const std::shared_ptr<Gps_Utc_Model> tmp_obj = std::make_shared<Gps_Utc_Model>(supl_client_ephemeris_.gps_utc);
-                                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
-                                }
-                            // Save iono and UTC model data to xml file
-                            const std::string iono_xml_filename = configuration_->property("GNSS-SDR.SUPL_gps_iono_xml", iono_default_xml_filename_);
-                            if (supl_client_ephemeris_.save_iono_xml(iono_xml_filename, supl_client_ephemeris_.gps_iono) == true)
-                                {
-                                    std::cout << "SUPL: Iono data file created\n";
-                                }
-                            else
-                                {
-                                    std::cout << "SUPL: Failed to create Iono data file\n";
-                                }
-                            const std::string utc_xml_filename = configuration_->property("GNSS-SDR.SUPL_gps_utc_model_xml", utc_default_xml_filename_);
-                            if (supl_client_ephemeris_.save_utc_xml(utc_xml_filename, supl_client_ephemeris_.gps_utc) == true)
-                                {
-                                    std::cout << "SUPL: UTC model data file created\n";
-                                }
-                            else
-                                {
-                                    std::cout << "SUPL: Failed to create UTC model data file\n";
-                                }
-                        }
-                    else
-                        {
-                            std::cout << "ERROR: SUPL client for almanac data returned " << error << '\n';
-                            std::cout << "Please check your network connectivity and SUPL server configuration\n";
-                        }
-
-                    // Request acquisition assistance
-                    supl_client_acquisition_.request = 2;
-                    std::cout << "SUPL: Try to read acquisition assistance data from SUPL server...\n";
-                    error = supl_client_acquisition_.get_assistance(supl_mcc_, supl_mns_, supl_lac_, supl_ci_);
-                    if (error == 0)
-                        {
-                            std::map<int, Gps_Acq_Assist>::const_iterator gps_acq_iter;
-                            for (gps_acq_iter = supl_client_acquisition_.gps_acq_map.cbegin();
-                                 gps_acq_iter != supl_client_acquisition_.gps_acq_map.cend();
-                                 gps_acq_iter++)
-                                {
-                                    std::cout << "SUPL: Received acquisition assistance data for satellite " << Gnss_Satellite("GPS", gps_acq_iter->second.PRN) << '\n';
-                                    global_gps_acq_assist_map.write(gps_acq_iter->second.PRN, gps_acq_iter->second);
-                                }
-                            if (supl_client_acquisition_.gps_ref_loc.valid == true)
-                                {
-                                    std::cout << "SUPL: Received Ref Location data (Acquisition Assistance)\n";
-                                    agnss_ref_location_ = supl_client_acquisition_.gps_ref_loc;
-                                    const std::shared_ptr<Agnss_Ref_Location> tmp_obj = std::make_shared<Agnss_Ref_Location>(agnss_ref_location_);
-                                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
-                                    supl_client_acquisition_.save_ref_location_xml("agnss_ref_location.xml", agnss_ref_location_);
-                                }
-                            if (supl_client_acquisition_.gps_time.valid == true)
-                                {
-                                    std::cout << "SUPL: Received Ref Time data (Acquisition Assistance)\n";
-                                    agnss_ref_time_ = supl_client_acquisition_.gps_time;
-                                    const std::shared_ptr<Agnss_Ref_Time> tmp_obj = std::make_shared<Agnss_Ref_Time>(agnss_ref_time_);
-                                    flowgraph_->send_telemetry_msg(pmt::make_any(tmp_obj));
-                                    supl_client_acquisition_.save_ref_time_xml("agnss_ref_time.xml", agnss_ref_time_);
-                                }
-                        }
-                    else
+                    // Use the cached assistance right away, and refresh it in the background
+                    supl_refresh_period_ = std::chrono::seconds(configuration_->property("GNSS-SDR.SUPL_refresh_period_s", 0));
+                    if (supl_cache_is_fresh() and read_assistance_from_XML())
                         {
-                            std::cout << "ERROR: SUPL client for acquisition assistance returned " << error << '\n';
-                            std::cout << "Please check your network connectivity and SUPL server configuration\n";
-                            std::cout << "Disabling SUPL acquisition assistance.\n";
+                            std::cout << "SUPL: GNSS assistance data loaded from the cached XML file(s).\n";
                         }
+                    start_supl_request();
                 }
         }
 
@@ -890,19 +934,486 @@ void ControlThread::assist_GNSS()
         }
 
     // If AGNSS is enabled, make use of it
-    if ((agnss_ref_location_.valid == true) and ((enable_gps_supl_assistance == true) or (enable_agnss_xml == true)))
+    if ((enable_gps_supl_assistance == true) or (enable_agnss_xml == true))
         {
-            // Get the list of visible satellites
-            std::array<float, 3> ref_LLH{};
-            ref_LLH[0] = agnss_ref_location_.lat;
-            ref_LLH[1] = agnss_ref_location_.lon;
-            time_t ref_rx_utc_time = 0;
-            if (agnss_ref_time_.valid == true)
+            prioritize_assisted_satellites();
+        }
+}
+
+
+void ControlThread::prioritize_assisted_satellites()
+{
+    if (agnss_ref_location_.valid == false)
+        {
+            return;
+        }
+    // Get the list of visible satellites
+    std::array<float, 3> ref_LLH{};
+    ref_LLH[0] = agnss_ref_location_.lat;
+    ref_LLH[1] = agnss_ref_location_.lon;
+    time_t ref_rx_utc_time = 0;
+    if (agnss_ref_time_.valid == true)
+        {
+            ref_rx_utc_time = static_cast<time_t>(agnss_ref_time_.seconds);
+        }
+
+    const std::vector<std::pair<int, Gnss_Satellite>> visible_sats = get_visible_sats(ref_rx_utc_time, ref_LLH);
+    // Set the receiver in Standby mode
+    flowgraph_->apply_action(0, 10);
+    // Give priority to visible satellites in the search list
+    flowgraph_->priorize_satellites(visible_sats);
+    // Hot Start
+    flowgraph_->apply_action(0, 12);
+}
+
+
+bool ControlThread::supl_cache_is_fresh() const
+{
+    const int max_age_s = configuration_->property("GNSS-SDR.SUPL_cache_max_age_s", 7200);
+    const std::string eph_xml_filename = configuration_->property("GNSS-SDR.SUPL_gps_ephemeris_xml", eph_default_xml_filename_);
+    struct stat file_status
+    {
+    };
+    if (stat(eph_xml_filename.c_str(), &file_status) != 0)
+        {
+            return false;
+        }
+    return std::difftime(std::time(nullptr), file_status.st_mtime) <= static_cast<double>(max_age_s);
+}
+
+
+void ControlThread::start_supl_request()
+{
+    if (supl_request_pending_)
+        {
+            return;
+        }
+    // the requests use their own clients, so that the control thread can
+    // keep reading the XML files while they are in progress
+    supl_request_ = std::make_unique<Supl_Request>();
+    supl_request_->ephemeris.server_name = supl_client_ephemeris_.server_name;
+    supl_request_->ephemeris.server_port = supl_client_ephemeris_.server_port;
+    supl_request_->almanac.server_name = supl_client_ephemeris_.server_name;
+    supl_request_->almanac.server_port = supl_client_ephemeris_.server_port;
+    supl_request_->acquisition.server_name = supl_client_acquisition_.server_name;
+    supl_request_->acquisition.server_port = supl_client_acquisition_.server_port;
+    supl_request_pending_ = true;
+    supl_request_done_ = false;
+    last_supl_request_time_ = std::chrono::steady_clock::now();
+    if (supl_thread_.joinable())
+        {
+            supl_thread_.join();
+        }
+    supl_thread_ = std::thread(&ControlThread::supl_request, this);
+}
+
+
+void ControlThread::supl_request()
+{
+    // Request ephemeris from SUPL server
+    std::cout << "SUPL: Try to read GPS ephemeris data from SUPL server...\n";
+    supl_request_->ephemeris.request = 1;
+    supl_request_->ephemeris_error = supl_request_->ephemeris.get_assistance(supl_mcc_, supl_mns_, supl_lac_, supl_ci_);
+    if (supl_request_->ephemeris_error == 0)
+        {
+            // Save ephemeris to XML file
+            const std::string eph_xml_filename = configuration_->property("GNSS-SDR.SUPL_gps_ephemeris_xml", eph_default_xml_filename_);
+            if (supl_request_->ephemeris.save_ephemeris_map_xml(eph_xml_filename, supl_request_->ephemeris.gps_ephemeris_map) == true)
+                {
+                    std::cout << "SUPL: XML ephemeris data file created\n";
+                }
+            else
+                {
+                    std::cout << "SUPL: Failed to create XML ephemeris data file\n";
+                }
+        }
+
+    // Request almanac, IONO and UTC Model data
+    std::cout << "SUPL: Try to read Almanac, Iono, Utc Model, Ref Time and Ref Location data from SUPL server...\n";
+    supl_request_->almanac.request = 0;
+    supl_request_->almanac_error = supl_request_->almanac.get_assistance(supl_mcc_, supl_mns_, supl_lac_, supl_ci_);
+    if (supl_request_->almanac_error == 0)
+        {
+            supl_request_->almanac.save_gps_almanac_xml("gps_almanac_map.xml", supl_request_->almanac.gps_almanac_map);
+            // Save iono and UTC model data to xml file
+            const std::string iono_xml_filename = configuration_->property("GNSS-SDR.SUPL_gps_iono_xml", iono_default_xml_filename_);
+            if (supl_request_->almanac.save_iono_xml(iono_xml_filename, supl_request_->almanac.gps_iono) == true)
+                {
+                    std::cout << "SUPL: Iono data file created\n";
+                }
+            else
+                {
+                    std::cout << "SUPL: Failed to create Iono data file\n";
+                }
+            const std::string utc_xml_filename = configuration_->property("GNSS-SDR.SUPL_gps_utc_model_xml", utc_default_xml_filename_);
+            if (supl_request_->almanac.save_utc_xml(utc_xml_filename, supl_request_->almanac.gps_utc) == true)
+                {
+                    std::cout << "SUPL: UTC model data file created\n";
+                }
+            else
+                {
+                    std::cout << "SUPL: Failed to create UTC model data file\n";
+                }
+        }
+
+    // Request acquisition assistance
+    std::cout << "SUPL: Try to read acquisition assistance data from SUPL server...\n";
+    supl_request_->acquisition.request = 2;
+    supl_request_->acquisition_error = supl_request_->acquisition.get_assistance(supl_mcc_, supl_mns_, supl_lac_, supl_ci_);
+    if (supl_request_->acquisition_error == 0)
+        {
+            if (supl_request_->acquisition.gps_ref_loc.valid == true)
+                {
+                    supl_request_->acquisition.save_ref_location_xml("agnss_ref_location.xml", supl_request_->acquisition.gps_ref_loc);
+                }
+            if (supl_request_->acquisition.gps_time.valid == true)
                 {
-                    ref_rx_utc_time = static_cast<time_t>(agnss_ref_time_.seconds);
+                    supl_request_->acquisition.save_ref_time_xml("agnss_ref_time.xml", supl_request_->acquisition.gps_time);
                 }
+        }
+
+    // the control thread applies the assistance
+    supl_request_done_ = true;
+    control_queue_->push(control_event_pmt(Control_Event::command, 200, 14));
+}
+
+
+void ControlThread::apply_supl_assistance()
+{
+    if (!supl_request_pending_ or !supl_request_done_)
+        {
+            return;
+        }
+    if (supl_thread_.joinable())
+        {
+            supl_thread_.join();
+        }
+    supl_request_pending_ = false;
+
+    if (supl_request_->ephemeris_error == 0)
+        {
+            for (const auto &it : supl_request_->ephemeris.gps_ephemeris_map)
+                {
+                    std::cout << "SUPL: Received ephemeris data for satellite " << Gnss_Satellite("GPS", it.second.PRN) << '\n';
+                    const std::shared_ptr<Gps_Ephemeris> tmp_obj = std::make_shared<Gps_Ephemeris>(it.second);
+                    flowgraph_->send_telemetry_msg(Gnss_Nav_Product(tmp_obj));
+                }
+        }
+    else
+        {
+            std::cout << "ERROR: SUPL client request for ephemeris data returned " << supl_request_->ephemeris_error << '\n';
+            std::cout << "Please check your network connectivity and SUPL server configuration\n";
+            if (!supl_cache_is_fresh())
+                {
+                    std::cout << "Trying to read AGNSS data from local XML file(s)...\n";
+                    if (read_assistance_from_XML() == false)
+                        {
+                            std::cout << "ERROR: Could not read XML files: Disabling SUPL assistance.\n";
+                        }
+                }
+        }
+
+    if (supl_request_->almanac_error == 0)
+        {
+            for (const auto &it : supl_request_->almanac.gps_almanac_map)
+                {
+                    std::cout << "SUPL: Received almanac data for satellite " << Gnss_Satellite("GPS", it.second.PRN) << '\n';
+                    const std::shared_ptr<Gps_Almanac> tmp_obj = std::make_shared<Gps_Almanac>(it.second);
+                    flowgraph_->send_telemetry_msg(Gnss_Nav_Product(tmp_obj));
+                }
+            if (supl_request_->almanac.gps_iono.valid == true)
+                {
+                    std::cout << "SUPL: Received GPS Ionosphere model parameters\n";
+                    const std::shared_ptr<Gps_Iono> tmp_obj = std::make_shared<Gps_Iono>(supl_request_->almanac.gps_iono);
+                    flowgraph_->send_telemetry_msg(Gnss_Nav_Product(tmp_obj));
+                }
+            if (supl_request_->almanac.gps_utc.valid == true)
+                {
+                    std::cout << "SUPL: Received GPS UTC model parameters\n";
+                    const std::shared_ptr<Gps_Utc_Model> tmp_obj = std::make_shared<Gps_Utc_Model>(supl_request_->almanac.gps_utc);
+                    flowgraph_->send_telemetry_msg(Gnss_Nav_Product(tmp_obj));
+                }
+        }
+    else
+        {
+            std::cout << "ERROR: SUPL client for almanac data returned " << supl_request_->almanac_error << '\n';
+            std::cout << "Please check your network connectivity and SUPL server configuration\n";
+        }
+
+    if (supl_request_->acquisition_error == 0)
+        {
+            for (const auto &it : supl_request_->acquisition.gps_acq_map)
+                {
+                    std::cout << "SUPL: Received acquisition assistance data for satellite " << Gnss_Satellite("GPS", it.second.PRN) << '\n';
+                    global_gps_acq_assist_map.write(it.second.PRN, it.second);
+                }
+            if (supl_request_->acquisition.gps_ref_loc.valid == true)
+                {
+                    std::cout << "SUPL: Received Ref Location data (Acquisition Assistance)\n";
+                    agnss_ref_location_ = supl_request_->acquisition.gps_ref_loc;
+                }
+            if (supl_request_->acquisition.gps_time.valid == true)
+                {
+                    std::cout << "SUPL: Received Ref Time data (Acquisition Assistance)\n";
+                    agnss_ref_time_ = supl_request_->acquisition.gps_time;
+                }
+        }
+    else
+        {
+            std::cout << "ERROR: SUPL client for acquisition assistance returned " << supl_request_->acquisition_error << '\n';
+            std::cout << "Please check your network connectivity and SUPL server configuration\n";
+            std::cout << "Disabling SUPL acquisition assistance.\n";
+        }
+    supl_request_.reset();
+
+    // search first for the satellites visible at the new reference location
+    prioritize_assisted_satellites();
+}
 
-            const std::vector<std::pair<int, Gnss_Satellite>> visible_sats = get_visible_sats(ref_rx_utc_time, ref_LLH);
+
+std::chrono::steady_clock::time_point ControlThread::next_wakeup_time() const
+{
+    auto next = flowgraph_->next_housekeeping_time();
+    if (!snapshot_file_.empty())
+        {
+            next = std::min(next, last_snapshot_time_ + snapshot_period_);
+        }
+    if (!checkpoint_file_.empty())
+        {
+            next = std::min(next, last_checkpoint_time_ + checkpoint_period_);
+        }
+    if (sky_prediction_period_.count() > 0)
+        {
+            next = std::min(next, last_sky_prediction_time_ + sky_prediction_period_);
+        }
+    if (pvt_jump_threshold_m_ > 0.0)
+        {
+            next = std::min(next, last_pvt_jump_check_time_ + std::chrono::seconds(1));
+        }
+    if (supl_refresh_period_.count() > 0)
+        {
+            next = std::min(next, last_supl_request_time_ + supl_refresh_period_);
+        }
+    if (telecommand_enabled_ and cmd_interface_.has_status_subscribers())
+        {
+            next = std::min(next, last_telecommand_status_time_ + telecommand_status_period_);
+        }
+    return next;
+}
+
+
+void ControlThread::check_pvt_jump()
+{
+    last_pvt_jump_check_time_ = std::chrono::steady_clock::now();
+    const std::shared_ptr<PvtInterface> pvt_ptr = flowgraph_->get_pvt();
+    if (pvt_ptr == nullptr)
+        {
+            return;
+        }
+    Gnss_Receiver_Snapshot snapshot;
+    pvt_ptr->get_receiver_snapshot(snapshot);
+    if (!snapshot.pvt_valid)
+        {
+            last_pvt_valid_ = false;
+            return;
+        }
+    const std::array<double, 3> pos{snapshot.latitude_deg * D2R, snapshot.longitude_deg * D2R, snapshot.height_m};
+    std::array<double, 3> ecef_m{};
+    pos2ecef(pos.data(), ecef_m.data());
+    if (last_pvt_valid_)
+        {
+            const double jump_m = std::sqrt((ecef_m[0] - last_pvt_ecef_m_[0]) * (ecef_m[0] - last_pvt_ecef_m_[0]) +
+                                            (ecef_m[1] - last_pvt_ecef_m_[1]) * (ecef_m[1] - last_pvt_ecef_m_[1]) +
+                                            (ecef_m[2] - last_pvt_ecef_m_[2]) * (ecef_m[2] - last_pvt_ecef_m_[2]));
+            if (jump_m > pvt_jump_threshold_m_ and flowgraph_->trigger_capture("pvt_jump"))
+                {
+                    LOG(INFO) << "The position fix jumped " << jump_m << " m, capturing the last samples";
+                }
+        }
+    last_pvt_ecef_m_ = ecef_m;
+    last_pvt_valid_ = true;
+}
+
+
+void ControlThread::update_sky_prediction()
+{
+    last_sky_prediction_time_ = std::chrono::steady_clock::now();
+    const std::shared_ptr<PvtInterface> pvt_ptr = flowgraph_->get_pvt();
+    if (pvt_ptr == nullptr)
+        {
+            return;
+        }
+    Gnss_Receiver_Snapshot snapshot;
+    pvt_ptr->get_receiver_snapshot(snapshot);
+
+    // position and time of the last fix, or the reference location and the system time
+    double lat_deg;
+    double lon_deg;
+    double height_m;
+    time_t rx_utc_time;
+    if (snapshot.pvt_valid)
+        {
+            lat_deg = snapshot.latitude_deg;
+            lon_deg = snapshot.longitude_deg;
+            height_m = snapshot.height_m;
+            rx_utc_time = static_cast<time_t>(snapshot.pvt_utc_time);
+        }
+    else if (agnss_ref_location_.valid)
+        {
+            lat_deg = agnss_ref_location_.lat;
+            lon_deg = agnss_ref_location_.lon;
+            height_m = 0.0;
+            rx_utc_time = std::time(nullptr);
+        }
+    else
+        {
+            sky_prediction_->publish({}, 0.0);
+            return;
+        }
+
+    std::vector<const Gnss_Ephemeris *> ephemerides;
+    for (const auto &it : snapshot.gps_ephemeris_map)
+        {
+            ephemerides.push_back(&it.second);
+        }
+    for (const auto &it : snapshot.galileo_ephemeris_map)
+        {
+            ephemerides.push_back(&it.second);
+        }
+    visible_sats_orbits_.set_ephemerides(ephemerides);
+
+    gtime_t utc_gtime;
+    utc_gtime.time = rx_utc_time;
+    utc_gtime.sec = 0.0;
+    int week;
+    const double tow = time2gpst(utc2gpst(utc_gtime), &week);
+    // the Doppler rate is the difference of the Doppler shifts one second apart, the receiver is static
+    const std::vector<double> doppler = visible_sats_orbits_.predicted_doppler(tow, lat_deg, lon_deg, height_m, 0.0, 0.0, 0.0, 1);
+    const std::vector<double> next_doppler = visible_sats_orbits_.predicted_doppler(tow + 1.0, lat_deg, lon_deg, height_m, 0.0, 0.0, 0.0, 1);
+    const auto orbits = visible_sats_orbits_.compute(tow);
+
+    const arma::vec LLH_rad = arma::vec{degtorad(lat_deg), degtorad(lon_deg), height_m};
+    arma::mat C_tmp = arma::zeros(3, 3);
+    arma::vec r_eb_e = arma::zeros(3, 1);
+    arma::vec v_eb_e = arma::zeros(3, 1);
+    Geo_to_ECEF(LLH_rad, arma::vec{0, 0, 0}, C_tmp, r_eb_e, v_eb_e, C_tmp);
+
+    // the measured Doppler shift includes the frequency offset of the receiver clock
+    const double clock_doppler_hz = snapshot.pvt_valid ? -snapshot.clock_drift_ppm * 1e-6 * FREQ1 : 0.0;
+    std::vector<Gnss_Sky_Satellite> satellites(ephemerides.size());
+    std::vector<std::pair<int, Gnss_Satellite>> priorities;
+    for (size_t k = 0; k < ephemerides.size(); k++)
+        {
+            double dist_m;
+            const arma::vec dx = arma::vec{orbits->pos_X[k], orbits->pos_Y[k], orbits->pos_Z[k]} - r_eb_e;
+            topocent(&satellites[k].azimuth_deg, &satellites[k].elevation_deg, &dist_m, r_eb_e, dx);
+            satellites[k].doppler_hz = doppler[k] + clock_doppler_hz;
+            satellites[k].doppler_rate_hz_s = next_doppler[k] - doppler[k];
+            satellites[k].PRN = ephemerides[k]->PRN;
+            const bool gps = k < snapshot.gps_ephemeris_map.size();
+            satellites[k].System = gps ? 'G' : 'E';
+            if (satellites[k].elevation_deg > 0)
+                {
+                    priorities.emplace_back(floor(satellites[k].elevation_deg),
+                        Gnss_Satellite(std::string(gps ? "GPS" : "Galileo"), satellites[k].PRN));
+                }
+        }
+    sky_prediction_->publish(satellites, tow);
+
+    // highest first, and only when the order changes
+    std::stable_sort(priorities.begin(), priorities.end(), [](const std::pair<int, Gnss_Satellite> &a, const std::pair<int, Gnss_Satellite> &b) { return a.first > b.first; });
+    const bool same_order = priorities.size() == sky_prediction_priorities_.size() and
+                            std::equal(priorities.cbegin(), priorities.cend(), sky_prediction_priorities_.cbegin(),
+                                [](const std::pair<int, Gnss_Satellite> &a, const std::pair<int, Gnss_Satellite> &b) { return a.second == b.second; });
+    if (!priorities.empty() and !same_order)
+        {
+            flowgraph_->priorize_satellites(priorities);
+            sky_prediction_priorities_ = std::move(priorities);
+        }
+}
+
+
+void ControlThread::publish_telecommand_status()
+{
+    last_telecommand_status_time_ = std::chrono::steady_clock::now();
+    Gnss_Receiver_Snapshot snapshot;
+    flowgraph_->get_receiver_snapshot(snapshot);
+    snapshot.time_s = std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+    cmd_interface_.publish_status(snapshot);
+}
+
+
+void ControlThread::save_receiver_snapshot()
+{
+    last_snapshot_time_ = std::chrono::steady_clock::now();
+    Gnss_Receiver_Snapshot snapshot;
+    flowgraph_->get_receiver_snapshot(snapshot);
+    snapshot.time_s = std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+    if (snapshot.save(snapshot_file_))
+        {
+            DLOG(INFO) << "Receiver snapshot written to " << snapshot_file_ << " with " << snapshot.channels.size() << " tracked satellites";
+        }
+    else
+        {
+            LOG(WARNING) << "Unable to write the receiver snapshot to " << snapshot_file_;
+        }
+}
+
+
+bool ControlThread::restore_receiver_snapshot()
+{
+    Gnss_Receiver_Snapshot snapshot;
+    if (!snapshot.load(snapshot_file_))
+        {
+            LOG(INFO) << "No receiver snapshot found in " << snapshot_file_;
+            return false;
+        }
+    // the ephemerides are valid for a few hours, and the Doppler shifts of
+    // the satellites change up to about 1 Hz/s
+    const double age_s = snapshot.age_s();
+    if (age_s < 0.0 or age_s > configuration_->property("GNSS-SDR.snapshot_max_age_s", 14400.0))
+        {
+            LOG(INFO) << "Discarding the receiver snapshot in " << snapshot_file_ << ", " << age_s << " s old";
+            return false;
+        }
+    std::cout << "Restoring the receiver snapshot of " << age_s << " s ago from " << snapshot_file_ << '\n';
+
+    if (!send_navigation_data(snapshot))
+        {
+            LOG(WARNING) << "Some navigation data of the receiver snapshot could not be delivered to PVT";
+        }
+
+    // the acquisitions of the satellites tracked in the last run start at
+    // their last Doppler shift
+    if (age_s <= configuration_->property("GNSS-SDR.snapshot_max_doppler_age_s", 300.0))
+        {
+            flowgraph_->set_doppler_hints(snapshot.channels);
+        }
+
+    // search first the satellites visible from the last position, or else
+    // the ones tracked in the last run
+    std::vector<std::pair<int, Gnss_Satellite>> visible_sats;
+    if (snapshot.pvt_valid)
+        {
+            LOG(INFO) << "Last position fix: " << snapshot.latitude_deg << " [deg], " << snapshot.longitude_deg << " [deg], "
+                      << snapshot.height_m << " [m], receiver clock drift " << snapshot.clock_drift_ppm << " [ppm]";
+            const std::array<float, 3> LLH{static_cast<float>(snapshot.latitude_deg), static_cast<float>(snapshot.longitude_deg), static_cast<float>(snapshot.height_m)};
+            visible_sats = get_visible_sats(std::time(nullptr), LLH, snapshot.gps_ephemeris_map, snapshot.galileo_ephemeris_map,
+                snapshot.gps_almanac_map, snapshot.galileo_almanac_map);
+        }
+    if (visible_sats.empty())
+        {
+            for (const auto &channel : snapshot.channels)
+                {
+                    const Gnss_Satellite sat(channel.System, channel.PRN);
+                    if (std::none_of(visible_sats.cbegin(), visible_sats.cend(), [&sat](const std::pair<int, Gnss_Satellite> &visible) { return visible.second == sat; }))
+                        {
+                            visible_sats.emplace_back(static_cast<int>(channel.CN0_dB_hz), sat);
+                        }
+                }
+        }
+    if (!visible_sats.empty())
+        {
             // Set the receiver in Standby mode
             flowgraph_->apply_action(0, 10);
             // Give priority to visible satellites in the search list
@@ -910,6 +1421,178 @@ void ControlThread::assist_GNSS()
             // Hot Start
             flowgraph_->apply_action(0, 12);
         }
+    return true;
+}
+
+
+bool ControlThread::send_navigation_data(const Gnss_Receiver_Snapshot &snapshot)
+{
+    // as if they were decoded by the telemetry decoders
+    bool sent = true;
+    for (const auto &eph : snapshot.gps_ephemeris_map)
+        {
+            sent &= flowgraph_->send_telemetry_msg(Gnss_Nav_Product(std::make_shared<Gps_Ephemeris>(eph.second)));
+        }
+    for (const auto &eph : snapshot.gps_cnav_ephemeris_map)
+        {
+            sent &= flowgraph_->send_telemetry_msg(Gnss_Nav_Product(std::make_shared<Gps_CNAV_Ephemeris>(eph.second)));
+        }
+    for (const auto &alm : snapshot.gps_almanac_map)
+        {
+            sent &= flowgraph_->send_telemetry_msg(Gnss_Nav_Product(std::make_shared<Gps_Almanac>(alm.second)));
+        }
+    if (snapshot.gps_iono.valid)
+        {
+            sent &= flowgraph_->send_telemetry_msg(Gnss_Nav_Product(std::make_shared<Gps_Iono>(snapshot.gps_iono)));
+        }
+    if (snapshot.gps_utc_model.valid)
+        {
+            sent &= flowgraph_->send_telemetry_msg(Gnss_Nav_Product(std::make_shared<Gps_Utc_Model>(snapshot.gps_utc_model)));
+        }
+    for (const auto &eph : snapshot.galileo_ephemeris_map)
+        {
+            sent &= flowgraph_->send_telemetry_msg(Gnss_Nav_Product(std::make_shared<Galileo_Ephemeris>(eph.second)));
+        }
+    for (const auto &alm : snapshot.galileo_almanac_map)
+        {
+            sent &= flowgraph_->send_telemetry_msg(Gnss_Nav_Product(std::make_shared<Galileo_Almanac>(alm.second)));
+        }
+    if (!snapshot.galileo_ephemeris_map.empty())
+        {
+            sent &= flowgraph_->send_telemetry_msg(Gnss_Nav_Product(std::make_shared<Galileo_Iono>(snapshot.galileo_iono)));
+            sent &= flowgraph_->send_telemetry_msg(Gnss_Nav_Product(std::make_shared<Galileo_Utc_Model>(snapshot.galileo_utc_model)));
+        }
+    for (const auto &eph : snapshot.glonass_gnav_ephemeris_map)
+        {
+            sent &= flowgraph_->send_telemetry_msg(Gnss_Nav_Product(std::make_shared<Glonass_Gnav_Ephemeris>(eph.second)));
+        }
+    if (snapshot.glonass_gnav_utc_model.valid)
+        {
+            sent &= flowgraph_->send_telemetry_msg(Gnss_Nav_Product(std::make_shared<Glonass_Gnav_Utc_Model>(snapshot.glonass_gnav_utc_model)));
+        }
+    for (const auto &eph : snapshot.beidou_dnav_ephemeris_map)
+        {
+            sent &= flowgraph_->send_telemetry_msg(Gnss_Nav_Product(std::make_shared<Beidou_Dnav_Ephemeris>(eph.second)));
+        }
+    for (const auto &alm : snapshot.beidou_dnav_almanac_map)
+        {
+            sent &= flowgraph_->send_telemetry_msg(Gnss_Nav_Product(std::make_shared<Beidou_Dnav_Almanac>(alm.second)));
+        }
+    if (snapshot.beidou_dnav_utc_model.valid)
+        {
+            sent &= flowgraph_->send_telemetry_msg(Gnss_Nav_Product(std::make_shared<Beidou_Dnav_Utc_Model>(snapshot.beidou_dnav_utc_model)));
+        }
+    return sent;
+}
+
+
+void ControlThread::prepare_checkpoint_resume()
+{
+    checkpoint_file_ = configuration_->property("GNSS-SDR.checkpoint_file", std::string(""));
+    checkpoint_period_ = std::chrono::seconds(configuration_->property("GNSS-SDR.checkpoint_period_s", 600));
+    if (checkpoint_file_.empty())
+        {
+            return;
+        }
+    const std::string empty_implementation;
+    const int src_count = configuration_->property("GNSS-SDR.num_sources", configuration_->property("Receiver.sources_count", 1));
+    const bool single_source = !configuration_->property("SignalSource.implementation", empty_implementation).empty();
+    const std::string first_role = single_source ? std::string("SignalSource") : std::string("SignalSource0");
+    checkpoint_source_filename_ = configuration_->property(first_role + ".filename", std::string(""));
+    const double fs_in = configuration_->property("GNSS-SDR.internal_fs_sps", 0.0);
+    checkpoint_sample_offset_ = static_cast<uint64_t>(std::max(configuration_->property(first_role + ".seconds_to_skip", 0.0), 0.0) * fs_in);
+    if (!configuration_->property("GNSS-SDR.resume_from_checkpoint", false))
+        {
+            return;
+        }
+
+    auto checkpoint = std::make_unique<Gnss_Receiver_Checkpoint>();
+    if (!checkpoint->load(checkpoint_file_))
+        {
+            std::cout << "No checkpoint found in " << checkpoint_file_ << ", processing from the start\n";
+            return;
+        }
+    if (checkpoint->source_filename != checkpoint_source_filename_)
+        {
+            std::cout << "The checkpoint in " << checkpoint_file_ << " is of " << checkpoint->source_filename
+                      << ", not of " << checkpoint_source_filename_ << ", processing from the start\n";
+            return;
+        }
+    // the checkpoint counts the samples at the rate of the tracking, and the
+    // sources may be decimated before it
+    std::vector<std::pair<std::string, uint64_t>> samples_to_skip;
+    for (int i = 0; i < src_count; i++)
+        {
+            const std::string role = single_source ? first_role : "SignalSource" + std::to_string(i);
+            const double fs_source = configuration_->property(role + ".sampling_frequency", fs_in);
+            const double ratio = std::round(fs_source / static_cast<double>(checkpoint->fs));
+            if (checkpoint->fs <= 0 or ratio < 1.0 or std::abs(ratio * static_cast<double>(checkpoint->fs) - fs_source) > 1e-6 * fs_source)
+                {
+                    std::cout << "The checkpoint in " << checkpoint_file_ << " is of another sampling rate, processing from the start\n";
+                    return;
+                }
+            samples_to_skip.emplace_back(role, checkpoint->sample_stamp * static_cast<uint64_t>(ratio));
+            if (single_source)
+                {
+                    break;
+                }
+        }
+    for (const auto &skip : samples_to_skip)
+        {
+            configuration_->set_property(skip.first + ".samples_to_skip", std::to_string(skip.second));
+        }
+    checkpoint_sample_offset_ = checkpoint->sample_stamp;
+    std::cout << "Resuming the processing of " << checkpoint_source_filename_ << " from the checkpoint at "
+              << static_cast<double>(checkpoint->sample_stamp) / static_cast<double>(checkpoint->fs) << " s, with "
+              << checkpoint->channels.size() << " tracked satellites\n";
+    resume_checkpoint_ = std::move(checkpoint);
+}
+
+
+void ControlThread::save_receiver_checkpoint()
+{
+    last_checkpoint_time_ = std::chrono::steady_clock::now();
+    Gnss_Receiver_Checkpoint checkpoint;
+    if (!flowgraph_->get_receiver_checkpoint(checkpoint, checkpoint_sample_offset_))
+        {
+            // nothing tracked yet: a resumed run would have nothing to skip
+            return;
+        }
+    checkpoint.source_filename = checkpoint_source_filename_;
+    checkpoint.state.time_s = std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+    if (checkpoint.save(checkpoint_file_))
+        {
+            DLOG(INFO) << "Checkpoint written to " << checkpoint_file_ << " at sample " << checkpoint.sample_stamp
+                       << " with " << checkpoint.channels.size() << " tracked satellites";
+        }
+    else
+        {
+            LOG(WARNING) << "Unable to write the checkpoint to " << checkpoint_file_;
+        }
+}
+
+
+void ControlThread::reconfigure_channel(unsigned int channel_id)
+{
+    // the channel is rebuilt from the current contents of the configuration
+    // file, so its blocks can be tuned without restarting the receiver
+    std::shared_ptr<ConfigurationInterface> configuration = configuration_;
+    if (!config_file_.empty())
+        {
+            auto file_configuration = std::make_shared<FileConfiguration>(config_file_);
+            if (file_configuration->has_section())
+                {
+                    configuration = file_configuration;
+                }
+            else
+                {
+                    LOG(WARNING) << "Unable to read " << config_file_ << ", reconfiguring channel " << channel_id << " with the current configuration";
+                }
+        }
+    if (flowgraph_->reconfigure_channel(channel_id, configuration))
+        {
+            applied_actions_++;
+        }
 }
 
 
@@ -966,6 +1649,15 @@ void ControlThread::apply_action(unsigned int what)
             // start again the satellite acquisitions
             receiver_on_standby_ = false;
             break;
+        case 14:
+            LOG(INFO) << "Received SUPL assistance";
+            apply_supl_assistance();
+            break;
+        case 15:  // a telecommand client subscribed to the status, published from now on
+            break;
+        case 30:  // the flowgraph writes the capture
+            LOG(INFO) << "TC request capture";
+            break;
         default:
             LOG(INFO) << "Unrecognized action.";
             break;
@@ -974,6 +1666,18 @@ void ControlThread::apply_action(unsigned int what)
 
 
 std::vector<std::pair<int, Gnss_Satellite>> ControlThread::get_visible_sats(time_t rx_utc_time, const std::array<float, 3> &LLH)
+{
+    const std::shared_ptr<PvtInterface> pvt_ptr = flowgraph_->get_pvt();
+    return get_visible_sats(rx_utc_time, LLH, pvt_ptr->get_gps_ephemeris(), pvt_ptr->get_galileo_ephemeris(),
+        pvt_ptr->get_gps_almanac(), pvt_ptr->get_galileo_almanac());
+}
+
+
+std::vector<std::pair<int, Gnss_Satellite>> ControlThread::get_visible_sats(time_t rx_utc_time, const std::array<float, 3> &LLH,
+    const std::map<int, Gps_Ephemeris> &gps_eph_map,
+    const std::map<int, Galileo_Ephemeris> &gal_eph_map,
+    const std::map<int, Gps_Almanac> &gps_alm_map,
+    const std::map<int, Galileo_Almanac> &gal_alm_map) const
 {
     // 1. Compute rx ECEF position from LLH WGS84
     const arma::vec LLH_rad = arma::vec{degtorad(LLH[0]), degtorad(LLH[1]), LLH[2]};
@@ -993,7 +1697,6 @@ std::vector<std::pair<int, Gnss_Satellite>> ControlThread::get_visible_sats(time
     std::vector<std::pair<int, Gnss_Satellite>> available_satellites;
     std::vector<unsigned int> visible_gps;
     std::vector<unsigned int> visible_gal;
-    const std::shared_ptr<PvtInterface> pvt_ptr = flowgraph_->get_pvt();
     struct tm tstruct
     {
     };
@@ -1004,57 +1707,48 @@ std::vector<std::pair<int, Gnss_Satellite>> ControlThread::get_visible_sats(time
     std::cout << "Get visible satellites at " << str_time
               << "UTC, assuming RX position " << LLH[0] << " [deg], " << LLH[1] << " [deg], " << LLH[2] << " [m]\n";
 
-    const std::map<int, Gps_Ephemeris> gps_eph_map = pvt_ptr->get_gps_ephemeris();
+    // all the ephemerides are evaluated at once
+    std::vector<const Gnss_Ephemeris *> ephemerides;
     for (const auto &it : gps_eph_map)
         {
-            const eph_t rtklib_eph = eph_to_rtklib(it.second, pre_2009_file_);
-            std::array<double, 3> r_sat{};
-            double clock_bias_s;
-            double sat_pos_variance_m2;
-            eph2pos(gps_gtime, &rtklib_eph, r_sat.data(), &clock_bias_s,
-                &sat_pos_variance_m2);
-            double Az;
-            double El;
-            double dist_m;
-            const arma::vec r_sat_eb_e = arma::vec{r_sat[0], r_sat[1], r_sat[2]};
-            const arma::vec dx = r_sat_eb_e - r_eb_e;
-            topocent(&Az, &El, &dist_m, r_eb_e, dx);
-            // push sat
-            if (El > 0)
-                {
-                    std::cout << "Using GPS Ephemeris: Sat " << it.second.PRN << " Az: " << Az << " El: " << El << '\n';
-                    available_satellites.emplace_back(floor(El),
-                        (Gnss_Satellite(std::string("GPS"), it.second.PRN)));
-                    visible_gps.push_back(it.second.PRN);
-                }
+            ephemerides.push_back(&it.second);
         }
-
-    const std::map<int, Galileo_Ephemeris> gal_eph_map = pvt_ptr->get_galileo_ephemeris();
     for (const auto &it : gal_eph_map)
         {
-            const eph_t rtklib_eph = eph_to_rtklib(it.second);
-            std::array<double, 3> r_sat{};
-            double clock_bias_s;
-            double sat_pos_variance_m2;
-            eph2pos(gps_gtime, &rtklib_eph, r_sat.data(), &clock_bias_s,
-                &sat_pos_variance_m2);
+            ephemerides.push_back(&it.second);
+        }
+    visible_sats_orbits_.set_ephemerides(ephemerides);
+    int week;
+    const auto orbits = visible_sats_orbits_.compute(time2gpst(gps_gtime, &week));
+    for (size_t k = 0; k < ephemerides.size(); k++)
+        {
             double Az;
             double El;
             double dist_m;
-            const arma::vec r_sat_eb_e = arma::vec{r_sat[0], r_sat[1], r_sat[2]};
+            const arma::vec r_sat_eb_e = arma::vec{orbits->pos_X[k], orbits->pos_Y[k], orbits->pos_Z[k]};
             const arma::vec dx = r_sat_eb_e - r_eb_e;
             topocent(&Az, &El, &dist_m, r_eb_e, dx);
             // push sat
             if (El > 0)
                 {
-                    std::cout << "Using Galileo Ephemeris: Sat " << it.second.PRN << " Az: " << Az << " El: " << El << '\n';
-                    available_satellites.emplace_back(floor(El),
-                        (Gnss_Satellite(std::string("Galileo"), it.second.PRN)));
-                    visible_gal.push_back(it.second.PRN);
+                    const uint32_t PRN = ephemerides[k]->PRN;
+                    if (k < gps_eph_map.size())
+                        {
+                            std::cout << "Using GPS Ephemeris: Sat " << PRN << " Az: " << Az << " El: " << El << '\n';
+                            available_satellites.emplace_back(floor(El),
+                                (Gnss_Satellite(std::string("GPS"), PRN)));
+                            visible_gps.push_back(PRN);
+                        }
+                    else
+                        {
+                            std::cout << "Using Galileo Ephemeris: Sat " << PRN << " Az: " << Az << " El: " << El << '\n';
+                            available_satellites.emplace_back(floor(El),
+                                (Gnss_Satellite(std::string("Galileo"), PRN)));
+                            visible_gal.push_back(PRN);
+                        }
                 }
         }
 
-    const std::map<int, Gps_Almanac> gps_alm_map = pvt_ptr->get_gps_almanac();
     for (const auto &it : gps_alm_map)
         {
             const alm_t rtklib_alm = alm_to_rtklib(it.second);
@@ -1084,7 +1778,6 @@ std::vector<std::pair<int, Gnss_Satellite>> ControlThread::get_visible_sats(time
                 }
         }
 
-    const std::map<int, Galileo_Almanac> gal_alm_map = pvt_ptr->get_galileo_almanac();
     for (const auto &it : gal_alm_map)
         {
             const alm_t rtklib_alm = alm_to_rtklib(it.second);
@@ -1188,7 +1881,7 @@ void ControlThread::sysv_queue_listener()
                     if ((std::abs(received_message - (-200.0)) < 10 * std::numeric_limits<double>::epsilon()))
                         {
                             std::cout << "Quit order received, stopping GNSS-SDR !!\n";
-                            control_queue_->push(pmt::make_any(command_event_make(200, 0)));
+                            control_queue_->push(control_event_pmt(Control_Event::command, 200, 0));
                             read_queue = false;
                         }
                 }
@@ -1198,21 +1891,39 @@ void ControlThread::sysv_queue_listener()
 
 void ControlThread::keyboard_listener()
 {
-    bool read_keys = true;
-    char c = '0';
-    while (read_keys && !stop_)
+    // sleep until a key is pressed or the control thread stops, without polling
+    std::array<pollfd, 2> fds{};
+    fds[0].fd = STDIN_FILENO;
+    fds[0].events = POLLIN;
+    fds[1].fd = keyboard_wakeup_pipe_[0];
+    fds[1].events = POLLIN;
+    const nfds_t nfds = (keyboard_wakeup_pipe_[0] != -1 ? 2 : 1);
+    while (!stop_)
         {
-            std::cin.get(c);
+            if (poll(fds.data(), nfds, -1) < 0)
+                {
+                    if (errno == EINTR)
+                        {
+                            continue;
+                        }
+                    return;
+                }
+            if (fds[1].revents != 0)
+                {
+                    return;
+                }
+            char c = '0';
+            const ssize_t keys = read(STDIN_FILENO, &c, 1);
+            if (keys <= 0)
+                {
+                    return;  // end of the input
+                }
             if (c == 'q')
                 {
                     std::cout << "Quit keystroke order received, stopping GNSS-SDR !!\n";
-                    control_queue_->push(pmt::make_any(command_event_make(200, 0)));
+                    control_queue_->push(control_event_pmt(Control_Event::command, 200, 0));
                     stop_ = true;
-                    read_keys = false;
-                }
-            else
-                {
-                    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                    return;
                 }
         }
 }
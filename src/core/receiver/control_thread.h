@@ -21,17 +21,26 @@
 #ifndef GNSS_SDR_CONTROL_THREAD_H
 #define GNSS_SDR_CONTROL_THREAD_H
 
-#include "agnss_ref_location.h"    // for Agnss_Ref_Location
-#include "agnss_ref_time.h"        // for Agnss_Ref_Time
-#include "channel_event.h"         // for channel_event_sptr
-#include "command_event.h"         // for command_event_sptr
-#include "concurrent_queue.h"      // for Concurrent_Queue
-#include "gnss_sdr_supl_client.h"  // for Gnss_Sdr_Supl_Client
-#include "tcp_cmd_interface.h"     // for TcpCmdInterface
+#include "agnss_ref_location.h"      // for Agnss_Ref_Location
+#include "agnss_ref_time.h"          // for Agnss_Ref_Time
+#include "channel_event.h"           // for channel_event_sptr
+#include "command_event.h"           // for command_event_sptr
+#include "concurrent_queue.h"        // for Concurrent_Queue
+#include "control_event.h"           // for Control_Event
+#include "gnss_ephemeris_batch.h"      // for Gnss_Ephemeris_Batch
+#include "gnss_receiver_checkpoint.h"  // for Gnss_Receiver_Checkpoint
+#include "gnss_receiver_snapshot.h"    // for Gnss_Receiver_Snapshot
+#include "gnss_sdr_supl_client.h"      // for Gnss_Sdr_Supl_Client
+#include "gnss_sky_prediction.h"       // for Gnss_Sky_Prediction
+#include "tcp_cmd_interface.h"         // for TcpCmdInterface
 #include <pmt/pmt.h>
 #include <array>     // for array
+#include <atomic>    // for atomic
+#include <chrono>    // for steady_clock
 #include <cstddef>   // for size_t
-#include <memory>    // for shared_ptr
+#include <cstdint>   // for uint64_t
+#include <map>       // for map
+#include <memory>    // for shared_ptr, unique_ptr
 #include <string>    // for string
 #include <thread>    // for std::thread
 #include <typeinfo>  // for std::type_info, typeid
@@ -94,6 +103,12 @@ public:
      */
     int run();
 
+    /*!
+     * \brief Asks the main loop of run() to stop the receiver. It can be
+     * called from any thread.
+     */
+    void request_stop();
+
     /*!
      * \brief Sets the control_queue
      *
@@ -126,11 +141,26 @@ private:
 
     void apply_action(unsigned int what);
 
+    /*
+     * Rebuilds the blocks of a channel from the configuration file
+     */
+    void reconfigure_channel(unsigned int channel_id);
+
     /*
      * New receiver event dispatcher
      */
     void event_dispatcher(bool &valid_event, pmt::pmt_t &msg);
 
+    /*
+     * Dispatches a batch of events popped at once from the control queue, or
+     * performs the low priority tasks if it is empty
+     */
+    void event_dispatcher(std::vector<pmt::pmt_t> &msgs);
+
+    // Applies the channel and command events, whatever their message type
+    void dispatch_channel_event(int channel_id, int what);
+    void dispatch_command_event(int command_id, int what);
+
     // Read {ephemeris, iono, utc, ref loc, ref time} assistance from a local XML file previously recorded
     bool read_assistance_from_XML();
 
@@ -144,12 +174,86 @@ private:
      * returns a vector filled with the available satellites ordered from high elevation to low elevation angle.
      */
     std::vector<std::pair<int, Gnss_Satellite>> get_visible_sats(time_t rx_utc_time, const std::array<float, 3> &LLH);
+    std::vector<std::pair<int, Gnss_Satellite>> get_visible_sats(time_t rx_utc_time, const std::array<float, 3> &LLH,
+        const std::map<int, Gps_Ephemeris> &gps_eph_map,
+        const std::map<int, Galileo_Ephemeris> &gal_eph_map,
+        const std::map<int, Gps_Almanac> &gps_alm_map,
+        const std::map<int, Galileo_Almanac> &gal_alm_map) const;
+
+    /*
+     * Writes the navigation data, the last position fix and the tracked
+     * satellites to GNSS-SDR.snapshot_file
+     */
+    void save_receiver_snapshot();
+
+    /*
+     * Sends the tracked satellites and the last position fix to the
+     * telecommand clients subscribed to the status
+     */
+    void publish_telecommand_status();
+
+    /*
+     * Assists the receiver with the snapshot of the last run, if it is
+     * recent enough
+     */
+    bool restore_receiver_snapshot();
+
+    // Sends the navigation data of a snapshot to PVT
+    bool send_navigation_data(const Gnss_Receiver_Snapshot& snapshot);
+
+    /*
+     * Reads GNSS-SDR.checkpoint_file and, if GNSS-SDR.resume_from_checkpoint,
+     * makes the signal sources skip the samples already processed. Called
+     * before the flowgraph is built.
+     */
+    void prepare_checkpoint_resume();
+
+    /*
+     * Writes the navigation data and the code epochs of the tracked
+     * satellites, at a sample of the recording, to GNSS-SDR.checkpoint_file
+     */
+    void save_receiver_checkpoint();
+
+    /*
+     * Publishes the elevation, azimuth and Doppler shift of the satellites
+     * with ephemeris, and gives priority to the highest ones in the search
+     */
+    void update_sky_prediction();
+
+    /*
+     * Triggers a capture of the last samples if the position fix moved more
+     * than GNSS-SDR.capture_pvt_jump_m since the previous check
+     */
+    void check_pvt_jump();
+
+    // Time at which the next periodic task of the main loop is due
+    std::chrono::steady_clock::time_point next_wakeup_time() const;
 
     /*
      * Read initial GNSS assistance from SUPL server or local XML files
      */
     void assist_GNSS();
 
+    /*
+     * Requests the SUPL assistance in a background thread. The control
+     * thread applies it when it arrives, with apply_supl_assistance().
+     */
+    void start_supl_request();
+    void supl_request();
+    void apply_supl_assistance();
+
+    /*
+     * True if the cached XML assistance is recent enough to be used while
+     * the SUPL request is in progress
+     */
+    bool supl_cache_is_fresh() const;
+
+    /*
+     * Gives priority to the satellites visible at the assisted reference
+     * location and time
+     */
+    void prioritize_assisted_satellites();
+
     void telecommand_listener();
     void keyboard_listener();
     void sysv_queue_listener();
@@ -174,14 +278,34 @@ private:
     const size_t channel_event_type_hash_code_ = typeid(channel_event_sptr).hash_code();
     const size_t command_event_type_hash_code_ = typeid(command_event_sptr).hash_code();
 
+    std::string config_file_;    // empty if the configuration was not read from a file
+    std::string snapshot_file_;  // empty if the snapshots are disabled
+    std::chrono::steady_clock::time_point last_snapshot_time_;
+    std::chrono::steady_clock::duration snapshot_period_;
+    std::string checkpoint_file_;  // empty if the checkpoints are disabled
+    std::string checkpoint_source_filename_;
+    std::chrono::steady_clock::time_point last_checkpoint_time_;
+    std::chrono::steady_clock::duration checkpoint_period_;
+    std::unique_ptr<Gnss_Receiver_Checkpoint> resume_checkpoint_;  // nullptr if not resuming
+    uint64_t checkpoint_sample_offset_{0};                          // samples of the recording skipped at the start of the run
+    std::chrono::steady_clock::time_point last_sky_prediction_time_;
+    std::chrono::steady_clock::duration sky_prediction_period_;  // zero if the sky prediction is disabled
+    std::chrono::steady_clock::time_point last_pvt_jump_check_time_;
+    std::array<double, 3> last_pvt_ecef_m_{};  // position fix of the previous check
+    double pvt_jump_threshold_m_;               // zero if the PVT jumps do not trigger captures
+    bool last_pvt_valid_{false};
+    std::chrono::steady_clock::time_point last_telecommand_status_time_;
+    std::chrono::steady_clock::duration telecommand_status_period_;
     std::shared_ptr<ConfigurationInterface> configuration_;
     std::shared_ptr<Concurrent_Queue<pmt::pmt_t>> control_queue_;
     std::shared_ptr<GNSSFlowgraph> flowgraph_;
 
     std::thread cmd_interface_thread_;
     std::thread keyboard_thread_;
+    std::array<int, 2> keyboard_wakeup_pipe_{{-1, -1}};  // written to stop the keyboard thread
     std::thread sysv_queue_thread_;
     std::thread gps_acq_assist_data_collector_thread_;
+    std::thread supl_thread_;
 
 #ifdef ENABLE_FPGA
     boost::thread fpga_helper_thread_;
@@ -197,9 +321,31 @@ private:
     int supl_lac_;  // Current network LAC (Location area code),16 bits, 1-65520 are valid values.
     int supl_ci_;   // Cell Identity (16 bits, 0-65535 are valid values).
 
+    // Background SUPL request, with its own clients
+    struct Supl_Request
+    {
+        Gnss_Sdr_Supl_Client ephemeris;
+        Gnss_Sdr_Supl_Client almanac;
+        Gnss_Sdr_Supl_Client acquisition;
+        int ephemeris_error{0};
+        int almanac_error{0};
+        int acquisition_error{0};
+    };
+    std::unique_ptr<Supl_Request> supl_request_;
+    std::chrono::steady_clock::time_point last_supl_request_time_;
+    std::chrono::steady_clock::duration supl_refresh_period_;  // zero if the assistance is not refreshed
+    std::atomic<bool> supl_request_done_{false};
+    bool supl_request_pending_;
+
     Agnss_Ref_Location agnss_ref_location_;
     Agnss_Ref_Time agnss_ref_time_;
 
+    // Orbits of the ephemerides used by get_visible_sats, kept between calls
+    mutable Gnss_Ephemeris_Batch visible_sats_orbits_;
+
+    std::shared_ptr<Gnss_Sky_Prediction> sky_prediction_;
+    std::vector<std::pair<int, Gnss_Satellite>> sky_prediction_priorities_;  // last order given to the flowgraph
+
     unsigned int processed_control_messages_;
     unsigned int applied_actions_;
     int msqid_;
@@ -214,6 +360,7 @@ private:
     bool stop_;
     bool restart_;
     bool telecommand_enabled_;
+    bool keyboard_enabled_;  // FLAGS_keyboard, unless GNSS-SDR.keyboard is false
     bool pre_2009_file_;  // to override the system time to postprocess old gnss records and avoid wrong week rollover
 };
 
@@ -0,0 +1,53 @@
+/*!
+ * \file flowgraph_conf.cc
+ * \brief Class that contains the configuration parameters read by the
+ * receiver flowgraph while it is running.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "flowgraph_conf.h"
+#include <glog/logging.h>
+#include <exception>
+#include <string>
+
+
+void Flowgraph_Conf::SetFromConfiguration(const ConfigurationInterface* configuration, int channels_count, bool multiband)
+{
+    channels_satellite.assign(channels_count > 0 ? channels_count : 0, 0U);
+    for (int i = 0; i < channels_count; i++)
+        {
+            try
+                {
+                    channels_satellite[i] = configuration->property("Channel" + std::to_string(i) + ".satellite", 0U);
+                }
+            catch (const std::exception& e)
+                {
+                    LOG(WARNING) << e.what();
+                }
+        }
+
+    channels_1C = configuration->property("Channels_1C.count", 0);
+    channels_1B = configuration->property("Channels_1B.count", 0);
+    assist_dual_frequency_acq = configuration->property("GNSS-SDR.assist_dual_frequency_acq", multiband);
+    assist_code_phase_acq = configuration->property("GNSS-SDR.assist_code_phase_acq", false);
+    dual_frequency_handover = configuration->property("GNSS-SDR.dual_frequency_handover", false);
+}
+
+
+uint32_t Flowgraph_Conf::channel_satellite(int channel) const
+{
+    if (channel < 0 || channel >= static_cast<int>(channels_satellite.size()))
+        {
+            return 0U;
+        }
+    return channels_satellite[channel];
+}
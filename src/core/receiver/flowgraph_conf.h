@@ -0,0 +1,62 @@
+/*!
+ * \file flowgraph_conf.h
+ * \brief Class that contains the configuration parameters read by the
+ * receiver flowgraph while it is running.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_FLOWGRAPH_CONF_H
+#define GNSS_SDR_FLOWGRAPH_CONF_H
+
+#include "configuration_interface.h"
+#include <cstdint>
+#include <vector>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver
+ * \{ */
+
+
+/*!
+ * \brief Snapshot of the configuration parameters used by the acquisition
+ * manager and the satellite assignment of the flowgraph.
+ *
+ * These parameters are consulted on every acquisition event, so they are
+ * read once when the flowgraph is configured instead of looking up their
+ * string keys each time.
+ */
+class Flowgraph_Conf
+{
+public:
+    Flowgraph_Conf() = default;
+
+    void SetFromConfiguration(const ConfigurationInterface* configuration, int channels_count, bool multiband);
+
+    /*!
+     * \brief Satellite to which the channel is fixed (ChannelN.satellite),
+     * 0 if it is free to search any satellite
+     */
+    uint32_t channel_satellite(int channel) const;
+
+    std::vector<uint32_t> channels_satellite;
+    int32_t channels_1C{0};
+    int32_t channels_1B{0};
+    bool assist_dual_frequency_acq{false};
+    bool assist_code_phase_acq{false};
+    bool dual_frequency_handover{false};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_FLOWGRAPH_CONF_H
@@ -0,0 +1,158 @@
+/*!
+ * \file flowgraph_instrumentation.cc
+ * \brief Collects the performance counters of the blocks of the receiver
+ * flowgraph, and exports them in the Prometheus text format.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "flowgraph_instrumentation.h"
+#include <glog/logging.h>
+#include <gnuradio/block_detail.h>    // for block_detail
+#include <gnuradio/high_res_timer.h>  // for high_res_timer_tps
+#include <cmath>                      // for sqrt
+#include <cstdio>                     // for rename
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+
+FlowgraphInstrumentation::FlowgraphInstrumentation(std::string filename, int interval_ms)
+    : d_filename(std::move(filename)),
+      d_interval(interval_ms),
+      d_sampled(false)
+{
+}
+
+
+void FlowgraphInstrumentation::add_block(const std::string& role, const gr::block_sptr& block)
+{
+    for (const auto& counters : d_blocks)
+        {
+            if (counters.block == block)
+                {
+                    return;
+                }
+        }
+    Block_Counters counters;
+    counters.role = role;
+    counters.block = block;
+    d_blocks.push_back(counters);
+}
+
+
+void FlowgraphInstrumentation::update(size_t acquisition_jobs, int channels_in_acquisition)
+{
+    if (!d_sampled or std::chrono::steady_clock::now() - d_last_sample >= d_interval)
+        {
+            sample(acquisition_jobs, channels_in_acquisition);
+        }
+}
+
+
+std::chrono::steady_clock::time_point FlowgraphInstrumentation::next_sample_time() const
+{
+    return d_sampled ? d_last_sample + d_interval : std::chrono::steady_clock::time_point();
+}
+
+
+void FlowgraphInstrumentation::sample(size_t acquisition_jobs, int channels_in_acquisition)
+{
+    const auto now = std::chrono::steady_clock::now();
+    const double elapsed_s = std::chrono::duration<double>(now - d_last_sample).count();
+    const double ticks_per_s = static_cast<double>(gr::high_res_timer_tps());
+
+    std::stringstream items;
+    std::stringstream rate;
+    std::stringstream work_time;
+    std::stringstream work_time_stddev;
+    std::stringstream work_time_total;
+    std::stringstream input_fill;
+    std::stringstream output_fill;
+    for (auto& counters : d_blocks)
+        {
+            const gr::block_detail_sptr detail = counters.block->detail();
+            if (detail == nullptr)
+                {
+                    continue;  // not running
+                }
+            // items produced, or consumed by the sinks
+            const uint64_t n = detail->noutputs() > 0 ? counters.block->nitems_written(0) : counters.block->nitems_read(0);
+            const std::string labels = "{role=\"" + counters.role + "\",block=\"" + counters.block->identifier() + "\"}";
+            items << "gnss_sdr_block_items_total" << labels << ' ' << n << '\n';
+            if (d_sampled and elapsed_s > 0.0)
+                {
+                    rate << "gnss_sdr_block_items_per_second" << labels << ' ' << static_cast<double>(n - counters.items) / elapsed_s << '\n';
+                }
+            counters.items = n;
+            work_time << "gnss_sdr_block_work_time_avg_seconds" << labels << ' ' << counters.block->pc_work_time_avg() / ticks_per_s << '\n';
+            work_time_stddev << "gnss_sdr_block_work_time_stddev_seconds" << labels << ' ' << std::sqrt(counters.block->pc_work_time_var()) / ticks_per_s << '\n';
+            work_time_total << "gnss_sdr_block_work_time_seconds_total" << labels << ' ' << counters.block->pc_work_time_total() / ticks_per_s << '\n';
+            if (detail->ninputs() > 0)
+                {
+                    input_fill << "gnss_sdr_block_input_buffer_fill" << labels << ' ' << counters.block->pc_input_buffers_full_avg(0) << '\n';
+                }
+            if (detail->noutputs() > 0)
+                {
+                    output_fill << "gnss_sdr_block_output_buffer_fill" << labels << ' ' << counters.block->pc_output_buffers_full_avg(0) << '\n';
+                }
+        }
+
+    std::stringstream report;
+    report << "# TYPE gnss_sdr_block_items_total counter\n"
+           << items.str()
+           << "# TYPE gnss_sdr_block_items_per_second gauge\n"
+           << rate.str()
+           << "# TYPE gnss_sdr_block_work_time_avg_seconds gauge\n"
+           << work_time.str()
+           << "# TYPE gnss_sdr_block_work_time_stddev_seconds gauge\n"
+           << work_time_stddev.str()
+           << "# TYPE gnss_sdr_block_work_time_seconds_total counter\n"
+           << work_time_total.str()
+           << "# TYPE gnss_sdr_block_input_buffer_fill gauge\n"
+           << input_fill.str()
+           << "# TYPE gnss_sdr_block_output_buffer_fill gauge\n"
+           << output_fill.str()
+           << "# TYPE gnss_sdr_acquisition_queue_depth gauge\n"
+           << "gnss_sdr_acquisition_queue_depth " << acquisition_jobs << '\n'
+           << "# TYPE gnss_sdr_channels_in_acquisition gauge\n"
+           << "gnss_sdr_channels_in_acquisition " << channels_in_acquisition << '\n'
+           << d_extra_metrics;
+    d_report = report.str();
+    d_last_sample = now;
+    d_sampled = true;
+
+    if (!d_filename.empty())
+        {
+            // written to a temporary file and renamed, so that readers never
+            // see a partial sample
+            const std::string tmp_filename = d_filename + ".tmp";
+            std::ofstream file(tmp_filename, std::ios::out | std::ios::trunc);
+            file << d_report;
+            file.close();
+            if (!file or std::rename(tmp_filename.c_str(), d_filename.c_str()) != 0)
+                {
+                    LOG(WARNING) << "Cannot write the instrumentation file " << d_filename;
+                }
+        }
+}
+
+
+std::string FlowgraphInstrumentation::report() const
+{
+    return d_report;
+}
+
+
+void FlowgraphInstrumentation::set_extra_metrics(std::string metrics)
+{
+    d_extra_metrics = std::move(metrics);
+}
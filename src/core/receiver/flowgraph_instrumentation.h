@@ -0,0 +1,91 @@
+/*!
+ * \file flowgraph_instrumentation.h
+ * \brief Collects the performance counters of the blocks of the receiver
+ * flowgraph, and exports them in the Prometheus text format.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_FLOWGRAPH_INSTRUMENTATION_H
+#define GNSS_SDR_FLOWGRAPH_INSTRUMENTATION_H
+
+#include <gnuradio/block.h>  // for block_sptr
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver
+ * \{ */
+
+
+/*!
+ * \brief Samples, at a fixed interval, the items processed by each block of
+ * the flowgraph, and the work() time and buffer fill levels measured by the
+ * GNU Radio performance counters, along with the depth of the acquisition
+ * queue.
+ *
+ * Each sample is written to a file in the Prometheus text exposition format,
+ * replaced atomically, so it can be served by the textfile collector of the
+ * node exporter, or just read to find the block that keeps the receiver
+ * behind real time. Only the counters are read, so the overhead in the
+ * processing threads is the one of the performance counters themselves.
+ *
+ * The work() times and buffer fill levels are only available if GNU Radio
+ * was built with performance counters.
+ */
+class FlowgraphInstrumentation
+{
+public:
+    FlowgraphInstrumentation(std::string filename, int interval_ms);
+
+    //! Adds a block, to be reported with its role in the receiver
+    void add_block(const std::string& role, const gr::block_sptr& block);
+
+    //! Samples the counters if the interval has elapsed since the last sample
+    void update(size_t acquisition_jobs, int channels_in_acquisition);
+
+    //! Time at which update() samples the counters again
+    std::chrono::steady_clock::time_point next_sample_time() const;
+
+    //! Samples the counters and writes the file
+    void sample(size_t acquisition_jobs, int channels_in_acquisition);
+
+    //! Last sample, in the Prometheus text format
+    std::string report() const;
+
+    //! Metrics of other parts of the receiver, appended to the next samples
+    void set_extra_metrics(std::string metrics);
+
+private:
+    struct Block_Counters
+    {
+        std::string role;
+        gr::block_sptr block;
+        uint64_t items{0};  // items at the previous sample
+    };
+
+    std::vector<Block_Counters> d_blocks;
+    std::string d_filename;
+    std::string d_report;
+    std::string d_extra_metrics;
+    std::chrono::steady_clock::time_point d_last_sample;
+    std::chrono::milliseconds d_interval;
+    bool d_sampled;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_FLOWGRAPH_INSTRUMENTATION_H
@@ -33,6 +33,7 @@
 #include "beidou_b3i_dll_pll_tracking.h"
 #include "beidou_b3i_pcps_acquisition.h"
 #include "beidou_b3i_telemetry_decoder.h"
+#include "bit_selection_to_cbyte.h"
 #include "byte_to_short.h"
 #include "channel.h"
 #include "configuration_interface.h"
@@ -42,6 +43,7 @@
 #include "file_timestamp_signal_source.h"
 #include "fir_filter.h"
 #include "freq_xlating_fir_filter.h"
+#include "fused_signal_conditioner.h"
 #include "galileo_e1_dll_pll_veml_tracking.h"
 #include "galileo_e1_pcps_8ms_ambiguous_acquisition.h"
 #include "galileo_e1_pcps_ambiguous_acquisition.h"
@@ -92,6 +94,7 @@
 #include "ibyte_to_complex.h"
 #include "ibyte_to_cshort.h"
 #include "in_memory_configuration.h"
+#include "interference_mitigation_filter.h"
 #include "ishort_to_complex.h"
 #include "ishort_to_cshort.h"
 #include "labsat_signal_source.h"
@@ -102,8 +105,13 @@
 #include "nsr_file_signal_source.h"
 #include "pass_through.h"
 #include "pulse_blanking_filter.h"
+#include "rational_resampler_conditioner.h"
+#include "replica_file_signal_source.h"
 #include "rtklib_pvt.h"
 #include "rtl_tcp_signal_source.h"
+#include "sample_bus_signal_source.h"
+#include "sample_push_signal_source.h"
+#include "sample_stream_signal_source.h"
 #include "sbas_l1_telemetry_decoder.h"
 #include "signal_conditioner.h"
 #include "spir_file_signal_source.h"
@@ -112,10 +120,15 @@
 #include "tracking_interface.h"
 #include "two_bit_cpx_file_signal_source.h"
 #include "two_bit_packed_file_signal_source.h"
+#include "xlating_decimator_filter.h"
 #include <glog/logging.h>
+#include <algorithm>  // for max, min
+#include <atomic>     // for atomic
 #include <exception>  // for exception
 #include <iostream>   // for cerr
-#include <utility>    // for move
+#include <thread>     // for thread
+#include <utility>    // for move, pair
+#include <vector>     // for vector
 
 #if RAW_UDP
 #include "custom_udp_signal_source.h"
@@ -223,6 +236,22 @@ std::unique_ptr<SignalSourceInterface> GNSSBlockFactory::GetSignalSource(
 }
 
 
+std::unique_ptr<GNSSBlockInterface> GNSSBlockFactory::GetChannelizer(
+    const ConfigurationInterface* configuration, int ID)
+{
+    auto role = findRole(configuration, "Channelizer"s, ID);
+    auto implementation = configuration->property(role + impl_prop, ""s);
+    if (implementation.empty())
+        {
+            return nullptr;
+        }
+    const auto outputs = static_cast<unsigned int>(std::max(configuration->property(role + ".outputs", 1), 1));
+    LOG(INFO) << "Getting " << role << " with implementation " << implementation << " and " << outputs << " output(s)";
+
+    return GetBlock(configuration, role, 1, outputs);
+}
+
+
 std::unique_ptr<GNSSBlockInterface> GNSSBlockFactory::GetSignalConditioner(
     const ConfigurationInterface* configuration, int ID)
 {
@@ -287,6 +316,17 @@ std::unique_ptr<GNSSBlockInterface> GNSSBlockFactory::GetSignalConditioner(
             return conditioner_;
         }
 
+    if (signal_conditioner == "Fused_Signal_Conditioner")
+        {
+            // single-antenna version, with the three stages in one block if possible
+            std::unique_ptr<GNSSBlockInterface> conditioner_ = std::make_unique<FusedSignalConditioner>(
+                GetBlock(configuration, role_datatypeadapter, 1, 1),
+                GetBlock(configuration, role_inputfilter, 1, 1),
+                GetBlock(configuration, role_resampler, 1, 1),
+                role_conditioner);
+            return conditioner_;
+        }
+
     if (signal_conditioner != "Signal_Conditioner")
         {
             std::cerr << "Error in configuration file: SignalConditioner.implementation=" << signal_conditioner << " is not a valid value.\n";
@@ -324,13 +364,12 @@ std::unique_ptr<GNSSBlockInterface> GNSSBlockFactory::GetObservables(const Confi
     Glonass_channels += configuration->property("Channels_2G.count", 0);
     unsigned int Beidou_channels = configuration->property("Channels_B1.count", 0);
     Beidou_channels += configuration->property("Channels_B3.count", 0);
-    unsigned int extra_channels = 1;  // For monitor channel sample counter
+    // the receiver clock comes from the sample counter through the sample clock, not as an extra input
     return GetBlock(configuration, "Observables",
         Galileo_channels +
             GPS_channels +
             Glonass_channels +
-            Beidou_channels +
-            extra_channels,
+            Beidou_channels,
         Galileo_channels +
             GPS_channels +
             Glonass_channels +
@@ -440,8 +479,6 @@ std::unique_ptr<std::vector<std::unique_ptr<GNSSBlockInterface>>> GNSSBlockFacto
     const ConfigurationInterface* configuration,
     Concurrent_Queue<pmt::pmt_t>* queue)
 {
-    int channel_absolute_id = 0;
-
     const unsigned int Channels_1C_count = configuration->property("Channels_1C.count", 0);
     const unsigned int Channels_1B_count = configuration->property("Channels_1B.count", 0);
     const unsigned int Channels_1G_count = configuration->property("Channels_1G.count", 0);
@@ -466,155 +503,68 @@ std::unique_ptr<std::vector<std::unique_ptr<GNSSBlockInterface>>> GNSSBlockFacto
                                         Channels_7X_count +
                                         Channels_E6_count;
 
-    auto channels = std::make_unique<std::vector<std::unique_ptr<GNSSBlockInterface>>>(total_channels);
-    try
-        {
-            // **************** GPS L1 C/A CHANNELS ****************************
-            LOG(INFO) << "Getting " << Channels_1C_count << " GPS L1 C/A channels";
-
-            for (unsigned int i = 0; i < Channels_1C_count; i++)
-                {
-                    // Store the channel into the vector of channels
-                    channels->at(channel_absolute_id) = GetChannel(configuration,
-                        std::string("1C"),
-                        channel_absolute_id,
-                        queue);
-                    channel_absolute_id++;
-                }
-
-            // **************** GPS L2C (M) CHANNELS ***************************
-            LOG(INFO) << "Getting " << Channels_2S_count << " GPS L2C (M) channels";
-
-            for (unsigned int i = 0; i < Channels_2S_count; i++)
-                {
-                    // Store the channel into the vector of channels
-                    channels->at(channel_absolute_id) = GetChannel(configuration,
-                        std::string("2S"),
-                        channel_absolute_id,
-                        queue);
-                    channel_absolute_id++;
-                }
-
-            // **************** GPS L5 CHANNELS ********************************
-            LOG(INFO) << "Getting " << Channels_L5_count << " GPS L5 channels";
-
-            for (unsigned int i = 0; i < Channels_L5_count; i++)
-                {
-                    // Store the channel into the vector of channels
-                    channels->at(channel_absolute_id) = GetChannel(configuration,
-                        std::string("L5"),
-                        channel_absolute_id,
-                        queue);
-                    channel_absolute_id++;
-                }
-
-            // **************** GALILEO E1 B (I/NAV OS) CHANNELS ***************
-            LOG(INFO) << "Getting " << Channels_1B_count << " GALILEO E1 B (I/NAV OS) channels";
-
-            for (unsigned int i = 0; i < Channels_1B_count; i++)
-                {
-                    // Store the channel into the vector of channels
-                    channels->at(channel_absolute_id) = GetChannel(configuration,
-                        std::string("1B"),
-                        channel_absolute_id,
-                        queue);
-                    channel_absolute_id++;
-                }
-
-            // **************** GALILEO E5a I (F/NAV OS) CHANNELS **************
-            LOG(INFO) << "Getting " << Channels_5X_count << " GALILEO E5a I (F/NAV OS) channels";
-
-            for (unsigned int i = 0; i < Channels_5X_count; i++)
-                {
-                    // Store the channel into the vector of channels
-                    channels->at(channel_absolute_id) = GetChannel(configuration,
-                        std::string("5X"),
-                        channel_absolute_id,
-                        queue);
-                    channel_absolute_id++;
-                }
-
-            // **************** GALILEO E6 (B/C HAS) CHANNELS **************
-            LOG(INFO) << "Getting " << Channels_E6_count << " GALILEO E6 (B/C HAS) channels";
-
-            for (unsigned int i = 0; i < Channels_E6_count; i++)
-                {
-                    // Store the channel into the vector of channels
-                    channels->at(channel_absolute_id) = GetChannel(configuration,
-                        std::string("E6"),
-                        channel_absolute_id,
-                        queue);
-                    channel_absolute_id++;
-                }
-
-            // **************** GLONASS L1 C/A CHANNELS ************************
-            LOG(INFO) << "Getting " << Channels_1G_count << " GLONASS L1 C/A channels";
-
-            for (unsigned int i = 0; i < Channels_1G_count; i++)
-                {
-                    // Store the channel into the vector of channels
-                    channels->at(channel_absolute_id) = GetChannel(configuration,
-                        std::string("1G"),
-                        channel_absolute_id,
-                        queue);
-                    channel_absolute_id++;
-                }
-
-            // **************** GLONASS L2 C/A CHANNELS ************************
-            LOG(INFO) << "Getting " << Channels_2G_count << " GLONASS L2 C/A channels";
-
-            for (unsigned int i = 0; i < Channels_2G_count; i++)
-                {
-                    // Store the channel into the vector of channels
-                    channels->at(channel_absolute_id) = GetChannel(configuration,
-                        std::string("2G"),
-                        channel_absolute_id,
-                        queue);
-                    channel_absolute_id++;
-                }
-
-            // **************** BEIDOU B1I CHANNELS ****************************
-            LOG(INFO) << "Getting " << Channels_B1_count << " BEIDOU B1I channels";
-
-            for (unsigned int i = 0; i < Channels_B1_count; i++)
-                {
-                    // Store the channel into the vector of channels
-                    channels->at(channel_absolute_id) = GetChannel(configuration,
-                        std::string("B1"),
-                        channel_absolute_id,
-                        queue);
-                    channel_absolute_id++;
-                }
-
-            // **************** BEIDOU B3I CHANNELS ****************************
-            LOG(INFO) << "Getting " << Channels_B3_count << " BEIDOU B3I channels";
-
-            for (unsigned int i = 0; i < Channels_B3_count; i++)
-                {
-                    // Store the channel into the vector of channels
-                    channels->at(channel_absolute_id) = GetChannel(configuration,
-                        std::string("B3"),
-                        channel_absolute_id,
-                        queue);
-                    channel_absolute_id++;
-                }
+    // Signal of each channel, in the order of the channel IDs
+    const std::vector<std::pair<std::string, unsigned int>> signal_channels{
+        {"1C", Channels_1C_count},
+        {"2S", Channels_2S_count},
+        {"L5", Channels_L5_count},
+        {"1B", Channels_1B_count},
+        {"5X", Channels_5X_count},
+        {"E6", Channels_E6_count},
+        {"1G", Channels_1G_count},
+        {"2G", Channels_2G_count},
+        {"B1", Channels_B1_count},
+        {"B3", Channels_B3_count},
+        {"7X", Channels_7X_count}};
+    std::vector<std::string> signals;
+    signals.reserve(total_channels);
+    for (const auto& signal_channel : signal_channels)
+        {
+            LOG(INFO) << "Getting " << signal_channel.second << " " << signal_channel.first << " channels";
+            signals.insert(signals.end(), signal_channel.second, signal_channel.first);
+        }
 
-            // **************** GALILEO E5b I (I/NAV OS) CHANNELS **************
-            LOG(INFO) << "Getting " << Channels_7X_count << " GALILEO E5b I (I/NAV OS) channels";
+    auto channels = std::make_unique<std::vector<std::unique_ptr<GNSSBlockInterface>>>(total_channels);
 
-            for (unsigned int i = 0; i < Channels_7X_count; i++)
-                {
-                    // Store the channel into the vector of channels
-                    channels->at(channel_absolute_id) = GetChannel(configuration,
-                        std::string("7X"),
-                        channel_absolute_id,
-                        queue);
-                    channel_absolute_id++;
-                }
+    // The blocks of each channel only read the configuration, so the channels
+    // can be built concurrently. Most of the startup time is spent there, in
+    // the generation of the local codes and the Doppler wipeoffs.
+    std::atomic<unsigned int> next_channel{0};
+    const auto build_channels = [&]() {
+        for (unsigned int channel = next_channel++; channel < total_channels; channel = next_channel++)
+            {
+                try
+                    {
+                        // Store the channel into the vector of channels
+                        channels->at(channel) = GetChannel(configuration,
+                            signals[channel],
+                            static_cast<int>(channel),
+                            queue);
+                    }
+                catch (const std::exception& e)
+                    {
+                        LOG(WARNING) << e.what();
+                    }
+            }
+    };
+    unsigned int construction_threads = configuration->property("GNSS-SDR.block_construction_threads", 1U);
+#if ENABLE_FPGA
+    construction_threads = 1U;  // the FPGA devices are opened one after the other
+#endif
+    if (construction_threads == 0U)
+        {
+            construction_threads = std::max(std::thread::hardware_concurrency(), 1U);
         }
-    catch (const std::exception& e)
+    construction_threads = std::min(construction_threads, std::max(total_channels, 1U));
+    std::vector<std::thread> threads;
+    for (unsigned int t = 1; t < construction_threads; t++)
         {
-            LOG(WARNING) << e.what();
+            threads.emplace_back(build_channels);
+        }
+    build_channels();
+    for (auto& thread : threads)
+        {
+            thread.join();
         }
 
     return channels;
@@ -656,6 +606,24 @@ std::unique_ptr<GNSSBlockInterface> GNSSBlockFactory::GetBlock(
                         out_streams, queue);
                     block = std::move(block_);
                 }
+            else if (implementation == "Sample_Push_Signal_Source")
+                {
+                    std::unique_ptr<GNSSBlockInterface> block_ = std::make_unique<SamplePushSignalSource>(configuration, role, in_streams,
+                        out_streams, queue);
+                    block = std::move(block_);
+                }
+            else if (implementation == "Sample_Bus_Signal_Source")
+                {
+                    std::unique_ptr<GNSSBlockInterface> block_ = std::make_unique<SampleBusSignalSource>(configuration, role, in_streams,
+                        out_streams, queue);
+                    block = std::move(block_);
+                }
+            else if (implementation == "Sample_Stream_Signal_Source")
+                {
+                    std::unique_ptr<GNSSBlockInterface> block_ = std::make_unique<SampleStreamSignalSource>(configuration, role, in_streams,
+                        out_streams, queue);
+                    block = std::move(block_);
+                }
             else if (implementation == "File_Signal_Source")
                 {
                     std::unique_ptr<GNSSBlockInterface> block_ = std::make_unique<FileSignalSource>(configuration, role, in_streams,
@@ -674,6 +642,12 @@ std::unique_ptr<GNSSBlockInterface> GNSSBlockFactory::GetBlock(
                         out_streams, queue);
                     block = std::move(block_);
                 }
+            else if (implementation == "Replica_File_Signal_Source")
+                {
+                    std::unique_ptr<GNSSBlockInterface> block_ = std::make_unique<ReplicaFileSignalSource>(configuration, role, in_streams,
+                        out_streams, queue);
+                    block = std::move(block_);
+                }
 #if RAW_UDP
             else if (implementation == "Custom_UDP_Signal_Source")
                 {
@@ -800,6 +774,12 @@ std::unique_ptr<GNSSBlockInterface> GNSSBlockFactory::GetBlock(
 #endif
 
             // DATA TYPE ADAPTER -----------------------------------------------------------
+            else if (implementation == "Bit_Selection_To_Cbyte")
+                {
+                    std::unique_ptr<GNSSBlockInterface> block_ = std::make_unique<BitSelectionToCbyte>(configuration, role, in_streams,
+                        out_streams);
+                    block = std::move(block_);
+                }
             else if (implementation == "Byte_To_Short")
                 {
                     std::unique_ptr<GNSSBlockInterface> block_ = std::make_unique<ByteToShort>(configuration, role, in_streams,
@@ -850,6 +830,12 @@ std::unique_ptr<GNSSBlockInterface> GNSSBlockFactory::GetBlock(
                         out_streams);
                     block = std::move(block_);
                 }
+            else if (implementation == "Xlating_Decimator_Filter")
+                {
+                    std::unique_ptr<GNSSBlockInterface> block_ = std::make_unique<XlatingDecimatorFilter>(configuration, role, in_streams,
+                        out_streams);
+                    block = std::move(block_);
+                }
             else if (implementation == "Beamformer_Filter")
                 {
                     std::unique_ptr<GNSSBlockInterface> block_ = std::make_unique<BeamformerFilter>(configuration, role, in_streams,
@@ -874,6 +860,12 @@ std::unique_ptr<GNSSBlockInterface> GNSSBlockFactory::GetBlock(
                         out_streams);
                     block = std::move(block_);
                 }
+            else if (implementation == "Interference_Mitigation_Filter")
+                {
+                    std::unique_ptr<GNSSBlockInterface> block_ = std::make_unique<InterferenceMitigationFilter>(configuration, role, in_streams,
+                        out_streams);
+                    block = std::move(block_);
+                }
 
             // RESAMPLER ---------------------------------------------------------------
             else if (implementation == "Direct_Resampler")
@@ -890,6 +882,13 @@ std::unique_ptr<GNSSBlockInterface> GNSSBlockFactory::GetBlock(
                     block = std::move(block_);
                 }
 
+            else if (implementation == "Rational_Resampler")
+                {
+                    std::unique_ptr<GNSSBlockInterface> block_ = std::make_unique<RationalResamplerConditioner>(configuration, role,
+                        in_streams, out_streams);
+                    block = std::move(block_);
+                }
+
             // ACQUISITION BLOCKS ------------------------------------------------------
             else if (implementation == "GPS_L1_CA_PCPS_Acquisition")
                 {
@@ -57,9 +57,25 @@ public:
 
     std::unique_ptr<GNSSBlockInterface> GetSignalConditioner(const ConfigurationInterface* configuration, int ID = -1);
 
+    /*!
+     * \brief Returns the Channelizer of the signal source number ID, which
+     * splits its output into Channelizer.outputs bands, each one feeding a
+     * signal conditioner, or nullptr if there is none
+     */
+    std::unique_ptr<GNSSBlockInterface> GetChannelizer(const ConfigurationInterface* configuration, int ID = -1);
+
     std::unique_ptr<std::vector<std::unique_ptr<GNSSBlockInterface>>> GetChannels(const ConfigurationInterface* configuration,
         Concurrent_Queue<pmt::pmt_t>* queue);
 
+    /*!
+     * \brief Returns the channel number channel of the signal signal
+     */
+    std::unique_ptr<GNSSBlockInterface> GetChannel(
+        const ConfigurationInterface* configuration,
+        const std::string& signal,
+        int channel,
+        Concurrent_Queue<pmt::pmt_t>* queue);
+
     std::unique_ptr<GNSSBlockInterface> GetObservables(const ConfigurationInterface* configuration);
 
     std::unique_ptr<GNSSBlockInterface> GetPVT(const ConfigurationInterface* configuration);
@@ -74,12 +90,6 @@ public:
         Concurrent_Queue<pmt::pmt_t>* queue = nullptr);
 
 private:
-    std::unique_ptr<GNSSBlockInterface> GetChannel(
-        const ConfigurationInterface* configuration,
-        const std::string& signal,
-        int channel,
-        Concurrent_Queue<pmt::pmt_t>* queue);
-
     std::unique_ptr<AcquisitionInterface> GetAcqBlock(
         const ConfigurationInterface* configuration,
         const std::string& role,
@@ -20,6 +20,9 @@
  */
 
 #include "gnss_flowgraph.h"
+#include "Beidou_B1I.h"
+#include "Beidou_B3I.h"
+#include "GLONASS_L1_L2_CA.h"
 #include "GPS_L1_CA.h"
 #include "GPS_L2C.h"
 #include "GPS_L5.h"
@@ -27,44 +30,60 @@
 #include "Galileo_E5a.h"
 #include "Galileo_E5b.h"
 #include "Galileo_E6.h"
+#include "acq_sky_search.h"
+#include "capacity_planner.h"
 #include "channel.h"
 #include "channel_fsm.h"
 #include "channel_interface.h"
+#include "complex_float_to_complex_short.h"
 #include "configuration_interface.h"
+#include "file_source_base.h"
 #include "gnss_block_factory.h"
 #include "gnss_block_interface.h"
+#include "gnss_nav_product_channel.h"
 #include "gnss_satellite.h"
+#include "gnss_sdr_fft.h"
+#include "gnss_sdr_ingest_monitor.h"
 #include "gnss_sdr_make_unique.h"
+#include "gnss_spectral_monitor.h"
 #include "gnss_synchro_monitor.h"
 #include "nav_message_monitor.h"
+#include "rational_resampler.h"
+#include "rational_resampler_cc.h"
+#include "sample_bus_sink.h"
+#include "sample_capture_sink.h"
+#include "sample_stream_sink.h"
+#include "signal_conditioner.h"
 #include "signal_source_interface.h"
+#include "sky_search_sink.h"
+#include "spectral_monitor_sink.h"
+#include "xlating_decimator_cc.h"
 #include <boost/lexical_cast.hpp>    // for boost::lexical_cast
 #include <boost/tokenizer.hpp>       // for boost::tokenizer
 #include <glog/logging.h>            // for LOG
 #include <gnuradio/basic_block.h>    // for basic_block
-#include <gnuradio/filter/firdes.h>  // for gr::filter::firdes
+#include <gnuradio/block.h>          // for block, cast_to_block_sptr
+#include <gnuradio/block_detail.h>   // for block_detail
+#include <gnuradio/blocks/streams_to_vector.h>
+#include <gnuradio/buffer.h>         // for buffer
 #include <gnuradio/io_signature.h>   // for io_signature
+#include <gnuradio/prefs.h>          // for prefs
 #include <gnuradio/top_block.h>      // for top_block, make_top_block
 #include <pmt/pmt_sugar.h>           // for mp
-#include <algorithm>                 // for transform, sort, unique
+#include <algorithm>                 // for max, transform, sort, unique
 #include <cmath>                     // for floor
+#include <complex>                   // for complex
 #include <cstddef>                   // for size_t
 #include <exception>                 // for exception
+#include <fstream>                   // for ifstream
 #include <iostream>                  // for operator<<
 #include <iterator>                  // for insert_iterator, inserter
 #include <memory>                    // for std::shared_ptr
 #include <set>                       // for set
 #include <sstream>                   // for std::stringstream
 #include <stdexcept>                 // for invalid_argument
-#include <thread>                    // for std::thread
 #include <utility>                   // for std::move
 
-#ifdef GR_GREATER_38
-#include <gnuradio/filter/fir_filter_blk.h>
-#else
-#include <gnuradio/filter/fir_filter_ccf.h>
-#endif
-
 
 #define GNSS_SDR_ARRAY_SIGNAL_CONDITIONER_CHANNELS 8
 
@@ -79,6 +98,9 @@ GNSSFlowgraph::GNSSFlowgraph(std::shared_ptr<ConfigurationInterface> configurati
       enable_e6_has_rx_(false)
 {
     enable_fpga_offloading_ = configuration_->property("GNSS-SDR.enable_FPGA", false);
+    sky_prediction_ = Gnss_Sky_Prediction::get();
+    // the FFT plans are made when init() creates the blocks
+    gnss_fft_settings().nthreads = std::max(configuration_->property("GNSS-SDR.fft_threads", 1), 1);
     init();
 }
 
@@ -90,6 +112,30 @@ GNSSFlowgraph::~GNSSFlowgraph()
         {
             GNSSFlowgraph::disconnect();
         }
+    if (Acquisition_Thread_Pool::global_instance() == acquisition_thread_pool_)
+        {
+            Acquisition_Thread_Pool::set_global_instance(nullptr);
+        }
+    if (tracking_worker_pool_ != nullptr and Tracking_Worker_Pool::global_instance() == tracking_worker_pool_)
+        {
+            Tracking_Worker_Pool::set_global_instance(nullptr);
+        }
+    if (pipeline_latency_ != nullptr and Gnss_Pipeline_Latency::global_instance() == pipeline_latency_)
+        {
+            Gnss_Pipeline_Latency::set_global_instance(nullptr);
+        }
+    if (Gnss_Sample_Clock::global_instance() == sample_clock_)
+        {
+            Gnss_Sample_Clock::set_global_instance(nullptr);
+        }
+    if (capture_trigger_ != nullptr and Gnss_Capture_Trigger::global_instance() == capture_trigger_)
+        {
+            Gnss_Capture_Trigger::set_global_instance(nullptr);
+        }
+    if (!spectral_monitors_.empty())
+        {
+            Gnss_Spectral_Monitor::clear_instances();
+        }
 }
 
 
@@ -100,6 +146,50 @@ void GNSSFlowgraph::init()
      */
     auto block_factory = std::make_unique<GNSSBlockFactory>();
 
+    // Scheduling class of the dump writers and recorders, taken by their
+    // threads when they start (for instance, GNSS-SDR.dump_sched_policy=idle)
+    Gnss_Thread_Sched dump_sched;
+    dump_sched.policy = configuration_->property("GNSS-SDR.dump_sched_policy", std::string(""));
+    dump_sched.priority = configuration_->property("GNSS-SDR.dump_sched_priority", 0);
+    gnss_set_helper_thread_sched(dump_sched);
+
+    // Pool of threads shared by all the non-blocking acquisition searches.
+    // GNSS-SDR.acquisition_threads = 0 means one thread per hardware thread.
+    acquisition_thread_pool_ = std::make_shared<Acquisition_Thread_Pool>(configuration_->property("GNSS-SDR.acquisition_threads", 0U));
+    Acquisition_Thread_Pool::set_global_instance(acquisition_thread_pool_);
+
+    // Worker slots shared by the tracking channels, created before them.
+    // GNSS-SDR.tracking_workers = 0 (default) lets all the channels run at once.
+    const auto tracking_workers = configuration_->property("GNSS-SDR.tracking_workers", 0U);
+    if (tracking_workers > 0)
+        {
+            tracking_worker_pool_ = std::make_shared<Tracking_Worker_Pool>(tracking_workers);
+            LOG(INFO) << "At most " << tracking_workers << " tracking channels run at a time";
+        }
+    Tracking_Worker_Pool::set_global_instance(tracking_worker_pool_);
+
+    // Latency from the samples to the PVT solutions, measured by default in the
+    // low latency mode, in which the observables do not wait for a fixed history
+    if (configuration_->property("GNSS-SDR.measure_latency", configuration_->property("PVT.low_latency", false)))
+        {
+            pipeline_latency_ = std::make_shared<Gnss_Pipeline_Latency>();
+        }
+    Gnss_Pipeline_Latency::set_global_instance(pipeline_latency_);
+
+    // Receiver clock of the sample counter, read by the observables block
+    sample_clock_ = std::make_shared<Gnss_Sample_Clock>();
+    Gnss_Sample_Clock::set_global_instance(sample_clock_);
+
+    const int instrumentation_interval_ms = configuration_->property("GNSS-SDR.instrumentation_interval_ms", 0);
+    if (instrumentation_interval_ms > 0)
+        {
+            // the block executors enable the performance counters when the flowgraph is started
+            gr::prefs::singleton()->set_bool("PerfCounters", "on", true);
+            instrumentation_ = std::make_unique<FlowgraphInstrumentation>(
+                configuration_->property("GNSS-SDR.instrumentation_file", std::string("./gnss-sdr-metrics.prom")),
+                instrumentation_interval_ms);
+        }
+
     channels_status_ = channel_status_msg_receiver_make();
 
     if (configuration_->property("Channels_E6.count", 0) > 0)
@@ -126,6 +216,20 @@ void GNSSFlowgraph::init()
                 {
                     auto& src = sig_source_.back();
                     auto RF_Channels = src->getRfChannels();
+                    channelizer_.push_back(block_factory->GetChannelizer(configuration_.get(), i));
+                    if (channelizer_.back() != nullptr)
+                        {
+                            if (RF_Channels > 1)
+                                {
+                                    LOG(WARNING) << channelizer_.back()->role() << " ignored: it needs a signal source with a single RF channel";
+                                    channelizer_.back() = nullptr;
+                                }
+                            else
+                                {
+                                    // each band of the channelizer feeds a signal conditioner
+                                    RF_Channels = channelizer_outputs(i);
+                                }
+                        }
                     if (sources_count_ == 1)
                         {
                             std::cout << "RF Channels: " << RF_Channels << '\n';
@@ -158,6 +262,7 @@ void GNSSFlowgraph::init()
             std::shared_ptr<GNSSBlockInterface> chan_ = std::move(channels->at(i));
             channels_.push_back(std::dynamic_pointer_cast<ChannelInterface>(chan_));
         }
+    conf_.SetFromConfiguration(configuration_.get(), channels_count_, multiband_);
 
     top_block_ = gr::make_top_block("GNSSFlowgraph");
 
@@ -178,11 +283,30 @@ void GNSSFlowgraph::init()
     set_channels_state();
     DLOG(INFO) << "Blocks instantiated. " << channels_count_ << " channels.";
 
+    // load shedding when the receiver falls behind real time
+    if (configuration_->property("GNSS-SDR.realtime_budget", false) and !enable_fpga_offloading_)
+        {
+            const int max_stopped_channels = std::max(configuration_->property("GNSS-SDR.realtime_budget_max_stopped_channels", channels_count_ / 2), 0);
+            realtime_budget_ = std::make_unique<RealtimeBudget>(2 + max_stopped_channels,
+                configuration_->property("GNSS-SDR.realtime_budget_recovery_periods", 10),
+                configuration_->property("GNSS-SDR.realtime_budget_buffer_fill", 0.9));
+            budget_period_ = std::chrono::milliseconds(std::max(configuration_->property("GNSS-SDR.realtime_budget_period_ms", 1000), 1));
+            budget_monitor_decimation_ = std::max(configuration_->property("GNSS-SDR.realtime_budget_monitor_decimation", 10), 1);
+            // the fill levels of the buffers are read from the performance counters
+            gr::prefs::singleton()->set_bool("PerfCounters", "on", true);
+        }
+
+    // buffers of the high-rate connections, sized for the longest read of
+    // the channels (see Stream_Buffer_Policy)
+    stream_buffer_policy_ = std::make_unique<Stream_Buffer_Policy>(configuration_.get(), Capacity_Planner(configuration_.get(), nullptr).largest_request_s());
+
     /*
      * Instantiate the receiver monitor block, if required
      */
+    // an application embedding the receiver can also take the observables without the UDP clients
     enable_monitor_ = configuration_->property("Monitor.enable_monitor", false);
-    if (enable_monitor_)
+    const std::string monitor_callbacks_name = configuration_->property("Monitor.callbacks_name", std::string(""));
+    if (enable_monitor_ or !monitor_callbacks_name.empty())
         {
             // Retrieve monitor properties
             bool enable_protobuf = configuration_->property("Monitor.enable_protobuf", true);
@@ -190,16 +314,26 @@ void GNSSFlowgraph::init()
                 {
                     enable_protobuf = true;
                 }
-            std::string address_string = configuration_->property("Monitor.client_addresses", std::string("127.0.0.1"));
-            std::vector<std::string> udp_addr_vec = split_string(address_string, '_');
-            std::sort(udp_addr_vec.begin(), udp_addr_vec.end());
-            udp_addr_vec.erase(std::unique(udp_addr_vec.begin(), udp_addr_vec.end()), udp_addr_vec.end());
+            std::vector<std::string> udp_addr_vec;
+            if (enable_monitor_)
+                {
+                    std::string address_string = configuration_->property("Monitor.client_addresses", std::string("127.0.0.1"));
+                    udp_addr_vec = split_string(address_string, '_');
+                    std::sort(udp_addr_vec.begin(), udp_addr_vec.end());
+                    udp_addr_vec.erase(std::unique(udp_addr_vec.begin(), udp_addr_vec.end()), udp_addr_vec.end());
+                }
 
             // Instantiate monitor object
-            GnssSynchroMonitor_ = gnss_synchro_make_monitor(channels_count_,
+            const gnss_synchro_monitor_sptr monitor = gnss_synchro_make_monitor(channels_count_,
                 configuration_->property("Monitor.decimation_factor", 1),
                 configuration_->property("Monitor.udp_port", 1234),
-                udp_addr_vec, enable_protobuf);
+                udp_addr_vec, enable_protobuf,
+                configuration_->property("Monitor.subscription_port", 0),
+                configuration_->property("Monitor.shm_name", std::string("")),
+                monitor_callbacks_name);
+            GnssSynchroMonitor_ = monitor;
+            synchro_monitors_.push_back(monitor);
+            enable_monitor_ = true;
         }
 
     /*
@@ -219,10 +353,14 @@ void GNSSFlowgraph::init()
             std::sort(udp_addr_vec.begin(), udp_addr_vec.end());
             udp_addr_vec.erase(std::unique(udp_addr_vec.begin(), udp_addr_vec.end()), udp_addr_vec.end());
 
-            GnssSynchroAcquisitionMonitor_ = gnss_synchro_make_monitor(channels_count_,
+            const gnss_synchro_monitor_sptr monitor = gnss_synchro_make_monitor(channels_count_,
                 configuration_->property("AcquisitionMonitor.decimation_factor", 1),
                 configuration_->property("AcquisitionMonitor.udp_port", 1235),
-                udp_addr_vec, enable_protobuf);
+                udp_addr_vec, enable_protobuf,
+                configuration_->property("AcquisitionMonitor.subscription_port", 0),
+                configuration_->property("AcquisitionMonitor.shm_name", std::string("")));
+            GnssSynchroAcquisitionMonitor_ = monitor;
+            synchro_monitors_.push_back(monitor);
         }
 
     /*
@@ -242,24 +380,35 @@ void GNSSFlowgraph::init()
             std::sort(udp_addr_vec.begin(), udp_addr_vec.end());
             udp_addr_vec.erase(std::unique(udp_addr_vec.begin(), udp_addr_vec.end()), udp_addr_vec.end());
 
-            GnssSynchroTrackingMonitor_ = gnss_synchro_make_monitor(channels_count_,
+            const gnss_synchro_monitor_sptr monitor = gnss_synchro_make_monitor(channels_count_,
                 configuration_->property("TrackingMonitor.decimation_factor", 1),
                 configuration_->property("TrackingMonitor.udp_port", 1236),
-                udp_addr_vec, enable_protobuf);
+                udp_addr_vec, enable_protobuf,
+                configuration_->property("TrackingMonitor.subscription_port", 0),
+                configuration_->property("TrackingMonitor.shm_name", std::string("")));
+            GnssSynchroTrackingMonitor_ = monitor;
+            synchro_monitors_.push_back(monitor);
         }
 
     /*
      * Instantiate the receiver av message monitor block, if required
      */
     enable_navdata_monitor_ = configuration_->property("NavDataMonitor.enable_monitor", false);
-    if (enable_navdata_monitor_)
+    const std::string navdata_callbacks_name = configuration_->property("NavDataMonitor.callbacks_name", std::string(""));
+    if (enable_navdata_monitor_ or !navdata_callbacks_name.empty())
         {
             // Retrieve monitor properties
-            std::string address_string = configuration_->property("NavDataMonitor.client_addresses", std::string("127.0.0.1"));
-            std::vector<std::string> udp_addr_vec = split_string(address_string, '_');
-            std::sort(udp_addr_vec.begin(), udp_addr_vec.end());
-            udp_addr_vec.erase(std::unique(udp_addr_vec.begin(), udp_addr_vec.end()), udp_addr_vec.end());
-            NavDataMonitor_ = nav_message_monitor_make(udp_addr_vec, configuration_->property("NavDataMonitor.port", 1237));
+            std::vector<std::string> udp_addr_vec;
+            if (enable_navdata_monitor_)
+                {
+                    std::string address_string = configuration_->property("NavDataMonitor.client_addresses", std::string("127.0.0.1"));
+                    udp_addr_vec = split_string(address_string, '_');
+                    std::sort(udp_addr_vec.begin(), udp_addr_vec.end());
+                    udp_addr_vec.erase(std::unique(udp_addr_vec.begin(), udp_addr_vec.end()), udp_addr_vec.end());
+                }
+            NavDataMonitor_ = nav_message_monitor_make(udp_addr_vec, configuration_->property("NavDataMonitor.port", 1237),
+                configuration_->property("NavDataMonitor.shm_name", std::string("")), navdata_callbacks_name);
+            enable_navdata_monitor_ = true;
         }
 }
 
@@ -272,6 +421,21 @@ void GNSSFlowgraph::start()
             return;
         }
 
+    if (configuration_->property("GNSS-SDR.lock_memory", false))
+        {
+            // the buffers allocated by GNU Radio at start are faulted in now
+            const std::string error = gnss_lock_memory();
+            if (error.empty())
+                {
+                    LOG(INFO) << "Memory of the receiver locked";
+                }
+            else
+                {
+                    LOG(WARNING) << "GNSS-SDR.lock_memory=true: the memory of the receiver could not be locked: " << error;
+                    std::cerr << "The memory of the receiver could not be locked: " << error << '\n';
+                }
+        }
+
     try
         {
             top_block_->start();
@@ -282,6 +446,8 @@ void GNSSFlowgraph::start()
             print_help();
             return;
         }
+    apply_thread_scheduling();
+    advise_huge_pages();
 
     if (enable_fpga_offloading_ == true)
         {
@@ -293,6 +459,58 @@ void GNSSFlowgraph::start()
         }
 
     running_ = true;
+    report_buffer_memory();
+}
+
+
+/*
+ * Logs the memory of the output buffers that GNU Radio has allocated to the
+ * blocks of the receiver, which is only known once the flow graph runs. The
+ * total is also printed in the low-memory profile (GNSS-SDR.low_memory).
+ */
+void GNSSFlowgraph::report_buffer_memory() const
+{
+    std::vector<gr::basic_block_sptr> blocks;
+    for (const auto& source : sig_source_)
+        {
+            blocks.push_back(source->get_right_block());
+        }
+    for (const auto& conditioner : sig_conditioner_)
+        {
+            blocks.push_back(conditioner->get_right_block());
+        }
+    for (const auto& channel : channels_)
+        {
+            blocks.push_back(channel->get_right_block_trk());
+            blocks.push_back(channel->get_right_block());
+        }
+    if (observables_ != nullptr)
+        {
+            blocks.push_back(observables_->get_right_block());
+        }
+
+    std::set<gr::basic_block_sptr> reported;
+    size_t total_bytes = 0;
+    for (const auto& basic_block : blocks)
+        {
+            const gr::block_sptr block = gr::cast_to_block_sptr(basic_block);
+            if (block == nullptr or block->detail() == nullptr or !reported.insert(basic_block).second)
+                {
+                    continue;
+                }
+            size_t block_bytes = 0;
+            for (int output = 0; output < block->detail()->noutputs(); output++)
+                {
+                    block_bytes += static_cast<size_t>(block->detail()->output(output)->bufsize()) * static_cast<size_t>(block->output_signature()->sizeof_stream_item(output));
+                }
+            total_bytes += block_bytes;
+            LOG(INFO) << "Output buffers of " << block->alias() << ": " << block_bytes / 1024 << " KiB";
+        }
+    LOG(INFO) << "Output buffers of the receiver blocks: " << total_bytes / 1024 << " KiB";
+    if (configuration_->property("GNSS-SDR.low_memory", false))
+        {
+            std::cout << "Low-memory profile: " << total_bytes / 1024 << " KiB in the output buffers of the receiver blocks\n";
+        }
 }
 
 
@@ -380,6 +598,10 @@ void GNSSFlowgraph::disconnect()
             return;
         }
     connected_ = false;
+    for (const auto& search : sky_searches_)
+        {
+            search.second->stop();
+        }
     try
         {
             top_block_->disconnect_all();
@@ -441,6 +663,26 @@ int GNSSFlowgraph::connect_desktop_flowgraph()
             return 1;
         }
 
+    if (connect_sample_distributors() != 0)
+        {
+            return 1;
+        }
+
+    if (connect_capture_rings() != 0)
+        {
+            return 1;
+        }
+
+    if (connect_spectral_monitors() != 0)
+        {
+            return 1;
+        }
+
+    if (connect_sky_searches() != 0)
+        {
+            return 1;
+        }
+
     if (connect_signal_conditioners_to_channels() != 0)
         {
             return 1;
@@ -475,15 +717,28 @@ int GNSSFlowgraph::connect_desktop_flowgraph()
                     return 1;
                 }
         }
+
+    set_processor_affinities();
+    set_thread_scheduling();
+    set_stream_buffers();
+
     // Activate acquisition in enabled channels
     for (int i = 0; i < channels_count_; i++)
         {
             LOG(INFO) << "Channel " << i << " assigned to " << channels_.at(i)->get_signal();
-            if (channels_state_[i] == 1)
+            if (channels_state_[i] == 1 and resume_tracking(i))
+                {
+                    LOG(INFO) << "Channel " << i << " connected to observables and resuming the tracking of a checkpoint";
+                }
+            else if (channels_state_[i] == 1)
                 {
                     channels_.at(i)->start_acquisition();
                     LOG(INFO) << "Channel " << i << " connected to observables and ready for acquisition";
                 }
+            else if (channels_state_[i] == 3)
+                {
+                    LOG(INFO) << "Channel " << i << " connected to observables and out of service";
+                }
             else
                 {
                     LOG(INFO) << "Channel " << i << " connected to observables in standby mode";
@@ -771,7 +1026,7 @@ int GNSSFlowgraph::connect_pvt()
 int GNSSFlowgraph::connect_sample_counter()
 {
     // connect the sample counter to the Signal Conditioner
-    // connect the sample counter to Observables
+    // the sample counter publishes the epochs of Observables in sample_clock_
     try
         {
             const double fs = static_cast<double>(configuration_->property("GNSS-SDR.internal_fs_sps", 0));
@@ -784,8 +1039,17 @@ int GNSSFlowgraph::connect_sample_counter()
 
             const int observable_interval_ms = configuration_->property("GNSS-SDR.observable_interval_ms", 20);
             ch_out_sample_counter_ = gnss_sdr_make_sample_counter(fs, observable_interval_ms, sig_conditioner_.at(0)->get_right_block()->output_signature()->sizeof_stream_item(0));
-            top_block_->connect(sig_conditioner_.at(0)->get_right_block(), 0, ch_out_sample_counter_, 0);
-            top_block_->connect(ch_out_sample_counter_, 0, observables_->get_left_block(), channels_count_);  // extra port for the sample counter pulse
+            top_block_->connect(sig_conditioner_.at(0)->get_right_block(), 0, ch_out_sample_counter_, 0);  // publishes the epochs in sample_clock_
+
+            // the samples of a file can be read at any pace, so the sample counter
+            // waits for the observables instead of overwriting the epochs they
+            // have not read yet, which would lose a part of a run that can be repeated
+            const bool file_source = std::any_of(sig_source_.cbegin(), sig_source_.cend(), [](const std::shared_ptr<SignalSourceInterface>& src) {
+                return src != nullptr and (dynamic_cast<const FileSourceBase*>(src.get()) != nullptr or
+                                              src->implementation() == "Multichannel_File_Signal_Source" or
+                                              src->implementation() == "Labsat_Signal_Source");
+            });
+            sample_clock_->set_throttle(configuration_->property("GNSS-SDR.throttle_sample_clock", file_source));
         }
     catch (const std::exception& e)
         {
@@ -793,11 +1057,251 @@ int GNSSFlowgraph::connect_sample_counter()
             top_block_->disconnect_all();
             return 1;
         }
-    DLOG(INFO) << "sample counter successfully connected to Signal Conditioner and Observables blocks";
+    DLOG(INFO) << "sample counter successfully connected to Signal Conditioner";
+    return 0;
+}
+
+
+int GNSSFlowgraph::connect_sample_distributors()
+{
+    // distribute the output of the Signal Conditioners to the receivers
+    // running a Sample_Stream_Signal_Source or, on the same host, a
+    // Sample_Bus_Signal_Source, which track other channels
+    try
+        {
+            const double fs = static_cast<double>(configuration_->property("GNSS-SDR.internal_fs_sps", 0));
+            for (const auto& conditioner : sig_conditioner_)
+                {
+                    const std::string role = conditioner->role();
+                    const gr::basic_block_sptr output = conditioner->get_right_block();
+                    const size_t item_size = output->output_signature()->sizeof_stream_item(0);
+                    const std::string bus_name = configuration_->property(role + ".distribute_bus_name", std::string(""));
+                    if (!bus_name.empty())
+                        {
+                            const double seconds = configuration_->property(role + ".distribute_bus_seconds", 1.0);
+                            const auto capacity = static_cast<uint64_t>(std::max(seconds * fs, 1048576.0));
+                            const bool huge_pages = configuration_->property(role + ".distribute_bus_huge_pages", true);
+                            sample_stream_sinks_.push_back(make_sample_bus_sink(item_size, bus_name, capacity, huge_pages));
+                            top_block_->connect(output, 0, sample_stream_sinks_.back(), 0);
+                            LOG(INFO) << "The samples of " << role << " are written to the sample bus " << bus_name;
+                        }
+
+                    const std::string address = configuration_->property(role + ".distribute_address", std::string(""));
+                    if (address.empty())
+                        {
+                            continue;
+                        }
+                    const auto port = static_cast<uint16_t>(configuration_->property(role + ".distribute_port", 1234));
+                    const auto payload_bytes = static_cast<size_t>(configuration_->property(role + ".distribute_payload_bytes", 1440));
+                    const int ttl = configuration_->property(role + ".distribute_ttl", 1);
+                    sample_stream_sinks_.push_back(make_sample_stream_sink(item_size, address, port, payload_bytes, ttl));
+                    top_block_->connect(output, 0, sample_stream_sinks_.back(), 0);
+                    LOG(INFO) << "The samples of " << role << " are distributed to " << address << ":" << port;
+                }
+        }
+    catch (const std::exception& e)
+        {
+            LOG(ERROR) << "Can't connect sample distributor: " << e.what();
+            help_hint_ += " * The samples of a Signal Conditioner cannot be distributed: " + std::string(e.what()) + '\n';
+            top_block_->disconnect_all();
+            return 1;
+        }
+    return 0;
+}
+
+
+int GNSSFlowgraph::connect_capture_rings()
+{
+    // keep the last <role>.capture_seconds of the output of the Signal
+    // Conditioners in memory, and write them to capture files on anomalies
+    try
+        {
+            const double fs = static_cast<double>(configuration_->property("GNSS-SDR.internal_fs_sps", 0));
+            const std::string filename_prefix = configuration_->property("GNSS-SDR.capture_filename", std::string("./capture"));
+            for (const auto& conditioner : sig_conditioner_)
+                {
+                    const std::string role = conditioner->role();
+                    const double seconds = configuration_->property(role + ".capture_seconds", 0.0);
+                    if (seconds <= 0.0 or fs <= 0.0)
+                        {
+                            continue;
+                        }
+                    const gr::basic_block_sptr output = conditioner->get_right_block();
+                    const auto item_size = static_cast<size_t>(output->output_signature()->sizeof_stream_item(0));
+                    std::string item_type("gr_complex");
+                    if (item_size == 2 * sizeof(int16_t))
+                        {
+                            item_type = "cshort";
+                        }
+                    else if (item_size == 2 * sizeof(int8_t))
+                        {
+                            item_type = "cbyte";
+                        }
+                    // gr_complex samples can be kept with 8 bits to save memory
+                    const float byte_gain = configuration_->property(role + ".capture_8bit", false) ? configuration_->property(role + ".capture_gain", 127.0F) : 0.0F;
+                    const auto capacity = static_cast<size_t>(seconds * fs);
+                    sample_capture_sinks_.push_back(make_sample_capture_sink(role, item_type, item_size, fs, capacity, byte_gain, filename_prefix));
+                    top_block_->connect(output, 0, sample_capture_sinks_.back(), 0);
+                }
+        }
+    catch (const std::exception& e)
+        {
+            LOG(ERROR) << "Can't connect sample capture ring: " << e.what();
+            help_hint_ += " * The samples of a Signal Conditioner cannot be kept for the captures: " + std::string(e.what()) + '\n';
+            top_block_->disconnect_all();
+            return 1;
+        }
+    if (sample_capture_sinks_.empty())
+        {
+            return 0;
+        }
+
+    const auto holdoff = std::chrono::milliseconds(static_cast<int64_t>(1000.0 * configuration_->property("GNSS-SDR.capture_holdoff_s", 60.0)));
+    capture_trigger_ = std::make_shared<Gnss_Capture_Trigger>(holdoff, configuration_->property("GNSS-SDR.capture_triggers", std::string("")));
+    for (const auto& sink : sample_capture_sinks_)
+        {
+            const std::shared_ptr<Gnss_Capture_Ring> ring = sink->ring();
+            capture_trigger_->add_target([ring](const std::string& reason) { return ring->trigger(reason); });
+        }
+    capture_lock_loss_count_ = std::max(configuration_->property("GNSS-SDR.capture_lock_loss_count", 4U), 1U);
+    capture_lock_loss_window_ = std::chrono::milliseconds(configuration_->property("GNSS-SDR.capture_lock_loss_window_ms", 1000U));
+    Gnss_Capture_Trigger::set_global_instance(capture_trigger_);
+    return 0;
+}
+
+
+int GNSSFlowgraph::connect_spectral_monitors()
+{
+    // estimate the power spectral density of the input of the Signal
+    // Conditioners with <role>.spectral_monitor=true, for their notch
+    // filters, pulse blankers and bit selection, and for the monitoring
+    try
+        {
+            const auto default_fs = static_cast<double>(configuration_->property("GNSS-SDR.internal_fs_sps", 0));
+            for (size_t id = 0; id < sig_conditioner_.size() and id < conditioner_inputs_.size(); id++)
+                {
+                    const std::string role = sig_conditioner_[id]->role();
+                    const auto& input = conditioner_inputs_[id];
+                    if (!configuration_->property(role + ".spectral_monitor", false) or input.first == nullptr)
+                        {
+                            continue;
+                        }
+                    const auto item_size = static_cast<size_t>(input.first->output_signature()->sizeof_stream_item(input.second));
+                    if (item_size != sizeof(gr_complex) and item_size != 2 * sizeof(int16_t))
+                        {
+                            LOG(WARNING) << role << ": the spectral monitor needs gr_complex or cshort samples, it has been disabled";
+                            continue;
+                        }
+                    const int fft_length = configuration_->property(role + ".spectral_monitor_fft_length", 1024);
+                    const int decimation = configuration_->property(role + ".spectral_monitor_decimation", 64);
+                    const int averages = configuration_->property(role + ".spectral_monitor_averages", 16);
+                    const float threshold_db = configuration_->property(role + ".spectral_monitor_threshold_db", 10.0F);
+                    const double fs = configuration_->property(role + ".spectral_monitor_sampling_frequency", default_fs);
+                    spectral_monitors_.push_back(std::make_shared<Gnss_Spectral_Monitor>(fft_length, decimation, averages, fs, threshold_db));
+                    spectral_monitors_.back()->start();
+                    Gnss_Spectral_Monitor::set_instance(static_cast<uint32_t>(id), spectral_monitors_.back());
+                    spectral_monitor_sinks_.push_back(make_spectral_monitor_sink(item_size, spectral_monitors_.back()));
+                    top_block_->connect(input.first, input.second, spectral_monitor_sinks_.back(), 0);
+                    LOG(INFO) << role << ": spectral monitor of " << fft_length << " bins, one segment out of " << decimation;
+                }
+        }
+    catch (const std::exception& e)
+        {
+            LOG(ERROR) << "Can't connect spectral monitor: " << e.what();
+            help_hint_ += " * The spectral monitor of a Signal Conditioner cannot be connected: " + std::string(e.what()) + '\n';
+            top_block_->disconnect_all();
+            return 1;
+        }
+    return 0;
+}
+
+
+int GNSSFlowgraph::connect_sky_searches()
+{
+    // search the satellites of the signals with
+    // Acquisition_<signal>.sky_search=true that no channel is tracking, on
+    // the idle CPU time, in the output of the Signal Conditioner of their
+    // first channel
+    const auto fs = static_cast<int64_t>(configuration_->property("GNSS-SDR.internal_fs_sps", 0));
+    try
+        {
+            for (const std::string signal : {"1C", "1B"})
+                {
+                    const std::string role = "Acquisition_" + signal;
+                    if (!configuration_->property(role + ".sky_search", false) or fs <= 0)
+                        {
+                            continue;
+                        }
+                    int channel = -1;
+                    for (int i = 0; i < channels_count_ and channel < 0; i++)
+                        {
+                            if (channels_.at(i)->get_signal().get_signal_str() == signal)
+                                {
+                                    channel = i;
+                                }
+                        }
+                    if (channel < 0)
+                        {
+                            continue;
+                        }
+                    const auto conditioner = static_cast<size_t>(configuration_->property("Channel" + std::to_string(channel) + ".RF_channel_ID", 0));
+                    const gr::basic_block_sptr output = sig_conditioner_.at(conditioner)->get_right_block();
+                    if (output->output_signature()->sizeof_stream_item(0) != static_cast<int>(sizeof(gr_complex)))
+                        {
+                            LOG(WARNING) << role << ": the sky search needs gr_complex samples, it has been disabled";
+                            continue;
+                        }
+                    const bool gps = (signal == "1C");
+                    std::vector<uint32_t> prns;
+                    for (uint32_t prn = 1; prn <= (gps ? 32U : 36U); prn++)
+                        {
+                            prns.push_back(prn);
+                        }
+                    const double code_period_s = gps ? GPS_L1_CA_CODE_PERIOD_S : GALILEO_E1_CODE_PERIOD_S;
+                    const int32_t doppler_max = configuration_->property(role + ".doppler_max", 5000);
+                    const int32_t doppler_step = configuration_->property(role + ".sky_search_doppler_step", static_cast<int32_t>(std::round(0.25 / code_period_s)));
+                    const uint32_t code_periods = configuration_->property(role + ".sky_search_code_periods", gps ? 10U : 4U);
+                    const float threshold = configuration_->property(role + ".sky_search_threshold", 3.0F);
+                    const uint32_t interval_ms = configuration_->property(role + ".sky_search_interval_ms", 1000U);
+                    const uint32_t max_age_ms = configuration_->property(role + ".sky_search_max_age_ms", 1000U);
+                    std::shared_ptr<Acq_Sky_Search> search;
+                    try
+                        {
+                            search = std::make_shared<Acq_Sky_Search>(signal, fs, prns, doppler_max, doppler_step, code_periods, threshold, interval_ms, max_age_ms);
+                        }
+                    catch (const std::invalid_argument& e)
+                        {
+                            LOG(WARNING) << role << ": " << e.what() << ", the sky search has been disabled";
+                            continue;
+                        }
+                    sky_searches_[signal] = search;
+                    sky_search_sinks_.push_back(make_sky_search_sink(search));
+                    top_block_->connect(output, 0, sky_search_sinks_.back(), 0);
+                    search->start();
+                    LOG(INFO) << role << ": sky search of " << prns.size() << " satellites every " << interval_ms << " ms";
+                }
+        }
+    catch (const std::exception& e)
+        {
+            LOG(ERROR) << "Can't connect the sky search: " << e.what();
+            help_hint_ += " * The sky search of a signal cannot be connected: " + std::string(e.what()) + '\n';
+            top_block_->disconnect_all();
+            return 1;
+        }
     return 0;
 }
 
 
+bool GNSSFlowgraph::trigger_capture(const std::string& reason)
+{
+    if (capture_trigger_ == nullptr)
+        {
+            return false;
+        }
+    return capture_trigger_->fire(reason);
+}
+
+
 #if ENABLE_FPGA
 int GNSSFlowgraph::connect_fpga_sample_counter()
 {
@@ -813,7 +1317,9 @@ int GNSSFlowgraph::connect_fpga_sample_counter()
                 }
             const int observable_interval_ms = configuration_->property("GNSS-SDR.observable_interval_ms", 20);
             ch_out_fpga_sample_counter_ = gnss_sdr_make_fpga_sample_counter(fs, observable_interval_ms);
-            top_block_->connect(ch_out_fpga_sample_counter_, 0, observables_->get_left_block(), channels_count_);  // extra port for the sample counter pulse
+            // the epochs go to the observables through sample_clock_, the pulses are discarded
+            null_sinks_.push_back(gr::blocks::null_sink::make(sizeof(Gnss_Synchro)));
+            top_block_->connect(ch_out_fpga_sample_counter_, 0, null_sinks_.back(), 0);
         }
     catch (const std::exception& e)
         {
@@ -846,6 +1352,7 @@ int GNSSFlowgraph::connect_signal_sources_to_signal_conditioners()
             return 1;
         }
     unsigned int signal_conditioner_ID = 0;
+    conditioner_inputs_ = std::vector<std::pair<gr::basic_block_sptr, int>>(sig_conditioner_.size(), std::make_pair(nullptr, 0));
     for (int i = 0; i < sources_count_; i++)
         {
             try
@@ -864,9 +1371,18 @@ int GNSSFlowgraph::connect_signal_sources_to_signal_conditioners()
                                     top_block_->connect(src->get_right_block(), j, sig_conditioner_.at(i)->get_left_block(), j);
                                 }
                         }
+                    else if (channelizer_.at(i) != nullptr)
+                        {
+                            if (connect_signal_source_to_channelizer(i, signal_conditioner_ID) != 0)
+                                {
+                                    top_block_->disconnect_all();
+                                    return 1;
+                                }
+                        }
                     else
                         {
                             auto RF_Channels = src->getRfChannels();
+                            std::vector<std::pair<gr::basic_block_sptr, int>> rf_channel_outputs;
 
                             for (auto j = 0U; j < RF_Channels; ++j)
                                 {
@@ -892,6 +1408,8 @@ int GNSSFlowgraph::connect_signal_sources_to_signal_conditioners()
                                                 {
                                                     LOG(INFO) << "connecting sig_source_ " << i << " stream " << j << " to conditioner " << signal_conditioner_ID;
                                                     top_block_->connect(src->get_right_block(), j, sig_conditioner_.at(signal_conditioner_ID)->get_left_block(), 0);
+                                                    rf_channel_outputs.emplace_back(src->get_right_block(), j);
+                                                    conditioner_inputs_.at(signal_conditioner_ID) = rf_channel_outputs.back();
                                                 }
                                         }
                                     else
@@ -901,16 +1419,21 @@ int GNSSFlowgraph::connect_signal_sources_to_signal_conditioners()
                                                     // RF_channel 0 backward compatibility with single channel sources
                                                     LOG(INFO) << "connecting sig_source_ " << i << " stream " << 0 << " to conditioner " << signal_conditioner_ID;
                                                     top_block_->connect(src->get_right_block(), 0, sig_conditioner_.at(signal_conditioner_ID)->get_left_block(), 0);
+                                                    rf_channel_outputs.emplace_back(src->get_right_block(), 0);
+                                                    conditioner_inputs_.at(signal_conditioner_ID) = rf_channel_outputs.back();
                                                 }
                                             else
                                                 {
                                                     // Multiple channel sources using multiple output blocks of single channel (requires RF_channel selector in call)
                                                     LOG(INFO) << "connecting sig_source_ " << i << " stream " << j << " to conditioner " << signal_conditioner_ID;
                                                     top_block_->connect(src->get_right_block(j), 0, sig_conditioner_.at(signal_conditioner_ID)->get_left_block(), 0);
+                                                    rf_channel_outputs.emplace_back(src->get_right_block(j), 0);
+                                                    conditioner_inputs_.at(signal_conditioner_ID) = rf_channel_outputs.back();
                                                 }
                                         }
                                     signal_conditioner_ID++;
                                 }
+                            configure_signal_source_ingest(i, rf_channel_outputs);
                         }
                 }
             catch (const std::exception& e)
@@ -940,145 +1463,856 @@ int GNSSFlowgraph::connect_signal_sources_to_signal_conditioners()
 }
 
 
-int GNSSFlowgraph::connect_signal_conditioners_to_channels()
+unsigned int GNSSFlowgraph::channelizer_outputs(int source_ID) const
 {
-    for (int i = 0; i < channels_count_; i++)
+    const auto& channelizer = channelizer_.at(source_ID);
+    if (channelizer == nullptr)
         {
-            int selected_signal_conditioner_ID = 0;
-            const bool use_acq_resampler = configuration_->property("GNSS-SDR.use_acquisition_resampler", false);
-            const uint32_t fs = configuration_->property("GNSS-SDR.internal_fs_sps", 0);
+            return 0;
+        }
+    return static_cast<unsigned int>(std::max(configuration_->property(channelizer->role() + ".outputs", 1), 1));
+}
 
-            try
+
+int GNSSFlowgraph::connect_signal_source_to_channelizer(int source_ID, unsigned int& signal_conditioner_ID)
+{
+    // The Channelizer extracts several bands from the single output of the
+    // signal source in one pass, and each band feeds a signal conditioner
+    auto& src = sig_source_.at(source_ID);
+    auto& channelizer = channelizer_.at(source_ID);
+    if (channelizer->item_size() == 0)
+        {
+            help_hint_ += " * Check the configuration of the " + channelizer->role() + " block.\n";
+            return 1;
+        }
+    const size_t output_size = src->get_right_block()->output_signature()->sizeof_stream_item(0);
+    const size_t input_size = channelizer->get_left_block()->input_signature()->sizeof_stream_item(0);
+    if (output_size != input_size)
+        {
+            help_hint_ += " * The Signal Source implementation " + src->implementation() + " has an output with a ";
+            help_hint_ += src->role() + ".item_size of " + std::to_string(output_size);
+            help_hint_ += " bytes, but it is connected to the " + channelizer->role() + " implementation ";
+            help_hint_ += channelizer->implementation() + " with input item size of " + std::to_string(input_size) + " bytes.\n";
+            return 1;
+        }
+
+    channelizer->connect(top_block_);
+    top_block_->connect(src->get_right_block(), 0, channelizer->get_left_block(), 0);
+    LOG(INFO) << "connecting sig_source_ " << source_ID << " stream 0 to " << channelizer->role();
+    const unsigned int outputs = channelizer_outputs(source_ID);
+    for (unsigned int band = 0; band < outputs; band++)
+        {
+            if (sig_conditioner_.size() > signal_conditioner_ID)
                 {
-                    selected_signal_conditioner_ID = configuration_->property("Channel" + std::to_string(i) + ".RF_channel_ID", 0);
+                    LOG(INFO) << "connecting " << channelizer->role() << " output " << band << " to conditioner " << signal_conditioner_ID;
+                    top_block_->connect(channelizer->get_right_block(), static_cast<int>(band), sig_conditioner_.at(signal_conditioner_ID)->get_left_block(), 0);
+                    conditioner_inputs_.at(signal_conditioner_ID) = std::make_pair(channelizer->get_right_block(), static_cast<int>(band));
                 }
-            catch (const std::exception& e)
+            signal_conditioner_ID++;
+        }
+    configure_signal_source_ingest(source_ID, {std::make_pair(src->get_right_block(), 0)});
+    return 0;
+}
+
+
+void GNSSFlowgraph::configure_signal_source_ingest(int source_ID, const std::vector<std::pair<gr::basic_block_sptr, int>>& rf_channel_outputs)
+{
+    // Buffers and thread of the blocks that deliver the samples of each RF
+    // channel. The default buffers of GNU Radio can be too small to absorb
+    // the scheduling latencies of the receiver without device overflows.
+    const std::string role = sig_source_.at(source_ID)->role();
+    const int64_t buffer_samples = configuration_->property(role + ".ingest_buffer_samples", static_cast<int64_t>(0));
+    const int cpu = configuration_->property(role + ".ingest_cpu", -1);
+    const int thread_priority = configuration_->property(role + ".ingest_thread_priority", -1);
+    for (const auto& output : rf_channel_outputs)
+        {
+            const gr::block_sptr block = gr::cast_to_block_sptr(output.first);
+            if (block == nullptr)
                 {
-                    LOG(WARNING) << e.what();
+                    if (buffer_samples > 0 or cpu >= 0 or thread_priority >= 0)
+                        {
+                            LOG(WARNING) << role << ": the ingest buffer, CPU and priority cannot be set in the block " << output.first->name();
+                        }
+                    continue;
                 }
-            try
+            configure_stream_buffer(block, output.second, role, configuration_->property(role + ".sampling_frequency", configuration_->property("GNSS-SDR.internal_fs_sps", 0.0)), buffer_samples);
+            if (cpu >= 0)
                 {
-                    // Enable automatic resampler for the acquisition, if required
-                    if (use_acq_resampler == true)
-                        {
-                            // create acquisition resamplers if required
-                            double resampler_ratio = 1.0;
-                            double acq_fs = fs;
-                            // find the signal associated to this channel
-                            switch (mapStringValues_[channels_.at(i)->get_signal().get_signal_str()])
-                                {
-                                case evGPS_1C:
-                                    acq_fs = GPS_L1_CA_OPT_ACQ_FS_SPS;
-                                    break;
-                                case evGPS_2S:
-                                    acq_fs = GPS_L2C_OPT_ACQ_FS_SPS;
-                                    break;
-                                case evGPS_L5:
-                                    acq_fs = GPS_L5_OPT_ACQ_FS_SPS;
-                                    break;
-                                case evSBAS_1C:
-                                    acq_fs = GPS_L1_CA_OPT_ACQ_FS_SPS;
-                                    break;
-                                case evGAL_1B:
-                                    acq_fs = GALILEO_E1_OPT_ACQ_FS_SPS;
-                                    break;
-                                case evGAL_5X:
-                                    acq_fs = GALILEO_E5A_OPT_ACQ_FS_SPS;
-                                    break;
-                                case evGAL_7X:
-                                    acq_fs = GALILEO_E5B_OPT_ACQ_FS_SPS;
-                                    break;
-                                case evGAL_E6:
-                                    acq_fs = GALILEO_E6_OPT_ACQ_FS_SPS;
-                                    break;
-                                case evGLO_1G:
-                                case evGLO_2G:
-                                case evBDS_B1:
-                                case evBDS_B3:
-                                    acq_fs = fs;
-                                    break;
-                                default:
-                                    break;
-                                }
-
-                            if (acq_fs < fs)
-                                {
-                                    // check if the resampler is already created for the channel system/signal and for the specific RF Channel
-                                    const std::string map_key = channels_.at(i)->get_signal().get_signal_str() + std::to_string(selected_signal_conditioner_ID);
-                                    resampler_ratio = static_cast<double>(fs) / acq_fs;
-                                    int decimation = floor(resampler_ratio);
-                                    while (fs % decimation > 0)
-                                        {
-                                            decimation--;
-                                        };
-                                    const double acq_fs_decimated = static_cast<double>(fs) / static_cast<double>(decimation);
-
-                                    if (decimation > 1)
-                                        {
-                                            // create a FIR low pass filter
-                                            std::vector<float> taps = gr::filter::firdes::low_pass(1.0,
-                                                fs,
-                                                acq_fs_decimated / 2.1,
-                                                acq_fs_decimated / 2);
+                    block->set_processor_affinity(std::vector<int>{cpu});
+                    LOG(INFO) << role << ": " << block->name() << " pinned to CPU " << cpu;
+                }
+            if (thread_priority >= 0)
+                {
+                    // a real-time priority keeps the device buffers drained
+                    // while the rest of the receiver is busy
+                    block->set_thread_priority(thread_priority);
+                    LOG(INFO) << role << ": " << block->name() << " runs with thread priority " << thread_priority;
+                }
+        }
 
-                                            gr::basic_block_sptr fir_filter_ccf_ = gr::filter::fir_filter_ccf::make(decimation, taps);
+    for (const auto& output : rf_channel_outputs)
+        {
+            const gr::block_sptr block = gr::cast_to_block_sptr(output.first);
+            if (block != nullptr)
+                {
+                    source_outputs_.emplace_back(block, output.second);
+                }
+        }
 
-                                            std::pair<std::map<std::string, gr::basic_block_sptr>::iterator, bool> ret;
-                                            ret = acq_resamplers_.insert(std::pair<std::string, gr::basic_block_sptr>(map_key, fir_filter_ccf_));
-                                            if (ret.second == true)
-                                                {
-                                                    top_block_->connect(sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block(), 0,
-                                                        acq_resamplers_.at(map_key), 0);
-                                                    LOG(INFO) << "Created "
-                                                              << channels_.at(i)->get_signal().get_signal_str()
-                                                              << " acquisition resampler for RF channel " << std::to_string(selected_signal_conditioner_ID) << " with " << taps.size() << " taps and decimation factor of " << decimation;
-                                                }
-                                            else
-                                                {
-                                                    LOG(INFO) << "Found existing "
-                                                              << channels_.at(i)->get_signal().get_signal_str()
-                                                              << " acquisition resampler for RF channel " << std::to_string(selected_signal_conditioner_ID) << " with " << taps.size() << " taps and decimation factor of " << decimation;
-                                                }
+    if (configuration_->property(role + ".ingest_monitor", false) and !rf_channel_outputs.empty())
+        {
+            const double fs = configuration_->property(role + ".sampling_frequency", 2048000.0);
+            const double host_clock_tolerance_s = configuration_->property(role + ".ingest_host_clock_tolerance_s", 0.0);
+            const auto& first = rf_channel_outputs.front();
+            const size_t item_size = first.first->output_signature()->sizeof_stream_item(first.second);
+            auto monitor = gnss_sdr_make_ingest_monitor(item_size, static_cast<unsigned int>(rf_channel_outputs.size()), fs, role, host_clock_tolerance_s);
+            for (size_t j = 0; j < rf_channel_outputs.size(); j++)
+                {
+                    top_block_->connect(rf_channel_outputs[j].first, rf_channel_outputs[j].second, monitor, static_cast<int>(j));
+                }
+            ingest_monitors_.push_back(monitor);
+            LOG(INFO) << role << ": monitoring the rx_time tags of " << rf_channel_outputs.size() << " RF channel(s)";
+        }
+}
 
-                                            top_block_->connect(acq_resamplers_.at(map_key), 0,
-                                                channels_.at(i)->get_left_block_acq(), 0);
 
-                                            std::shared_ptr<Channel> channel_ptr = std::dynamic_pointer_cast<Channel>(channels_.at(i));
-                                            channel_ptr->acquisition()->set_resampler_latency((taps.size() - 1) / 2);
-                                        }
-                                    else
-                                        {
-                                            LOG(INFO) << "Disabled acquisition resampler because the input sampling frequency is too low";
-                                            // resampler not required!
-                                            top_block_->connect(sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block(), 0,
-                                                channels_.at(i)->get_left_block_acq(), 0);
-                                        }
-                                }
-                            else
-                                {
-                                    LOG(INFO) << "Disabled acquisition resampler because the input sampling frequency is too low";
-                                    top_block_->connect(sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block(), 0,
-                                        channels_.at(i)->get_left_block_acq(), 0);
-                                }
+void GNSSFlowgraph::set_processor_affinities()
+{
+    // With GNSS-SDR.affinity_policy=numa, each signal conditioner is placed
+    // on a NUMA node, in turn, together with the signal source that feeds it
+    // and with the channels that it feeds. Since both ends of each buffer
+    // then run on the same node, the pages of the buffer are first touched
+    // there. The <role>.affinity lists of CPUs take precedence.
+    std::vector<std::vector<int>> nodes_cpus;
+    const std::string policy = configuration_->property("GNSS-SDR.affinity_policy", std::string("none"));
+    if (policy == "numa")
+        {
+            nodes_cpus = get_numa_nodes_cpus();
+            if (nodes_cpus.size() < 2)
+                {
+                    LOG(INFO) << "GNSS-SDR.affinity_policy=numa: " << nodes_cpus.size() << " NUMA node(s) found, the blocks are not placed";
+                    nodes_cpus.clear();
+                }
+        }
+    else if (policy != "none")
+        {
+            LOG(WARNING) << "Unknown GNSS-SDR.affinity_policy " << policy;
+        }
+
+    std::vector<std::vector<int>> conditioner_cpus(sig_conditioner_.size());
+    for (size_t k = 0; k < sig_conditioner_.size(); k++)
+        {
+            if (!nodes_cpus.empty())
+                {
+                    conditioner_cpus[k] = nodes_cpus[k % nodes_cpus.size()];
+                }
+            const std::string role = sig_conditioner_[k]->role();
+            const std::vector<int> cpus = parse_cpu_list(configuration_->property(role + ".affinity", std::string("")));
+            if (!cpus.empty())
+                {
+                    conditioner_cpus[k] = cpus;
+                }
+            configure_block(sig_conditioner_[k]->get_left_block(), conditioner_cpus[k], role);
+            configure_block(sig_conditioner_[k]->get_right_block(), conditioner_cpus[k], role);
+        }
+
+    size_t first_conditioner = 0;
+    for (size_t i = 0; i < sig_source_.size(); i++)
+        {
+            const auto& src = sig_source_[i];
+            const std::string role = src->role();
+            std::vector<int> cpus = parse_cpu_list(configuration_->property(role + ".affinity", std::string("")));
+            if (cpus.empty() and first_conditioner < conditioner_cpus.size())
+                {
+                    cpus = conditioner_cpus[first_conditioner];
+                }
+            // the CPU of the blocks that deliver the samples has already been set
+            if (configuration_->property(role + ".ingest_cpu", -1) < 0)
+                {
+                    configure_block(src->get_right_block(), cpus, role);
+                }
+            if (i < channelizer_.size() and channelizer_[i] != nullptr)
+                {
+                    const std::string channelizer_role = channelizer_[i]->role();
+                    std::vector<int> channelizer_cpus = parse_cpu_list(configuration_->property(channelizer_role + ".affinity", std::string("")));
+                    if (channelizer_cpus.empty())
+                        {
+                            channelizer_cpus = cpus;
                         }
-                    else
+                    configure_block(channelizer_[i]->get_right_block(), channelizer_cpus, channelizer_role);
+                    first_conditioner += channelizer_outputs(static_cast<int>(i));
+                    continue;
+                }
+            first_conditioner += std::max(src->getRfChannels(), static_cast<size_t>(1));
+        }
+
+    const std::vector<int> all_channels_cpus = parse_cpu_list(configuration_->property("Channel.affinity", std::string("")));
+    for (int i = 0; i < channels_count_; i++)
+        {
+            const std::string role = "Channel" + std::to_string(i);
+            std::vector<int> cpus = parse_cpu_list(configuration_->property(role + ".affinity", std::string("")));
+            if (cpus.empty())
+                {
+                    cpus = all_channels_cpus;
+                }
+            const auto conditioner = static_cast<size_t>(configuration_->property(role + ".RF_channel_ID", 0));
+            if (cpus.empty() and conditioner < conditioner_cpus.size())
+                {
+                    cpus = conditioner_cpus[conditioner];
+                }
+            configure_block(channels_.at(i)->get_left_block_acq(), cpus, role);
+            configure_block(channels_.at(i)->get_left_block_trk(), cpus, role);
+            configure_block(channels_.at(i)->get_right_block(), cpus, role);
+        }
+
+    configure_block(observables_->get_left_block(), parse_cpu_list(configuration_->property("Observables.affinity", std::string(""))), "Observables");
+    configure_block(pvt_->get_left_block(), parse_cpu_list(configuration_->property("PVT.affinity", std::string(""))), "PVT");
+}
+
+
+void GNSSFlowgraph::configure_block(const gr::basic_block_sptr& block, const std::vector<int>& cpus, const std::string& role)
+{
+    if (block == nullptr)
+        {
+            return;
+        }
+    const gr::block_sptr gr_block = gr::cast_to_block_sptr(block);
+    if (gr_block == nullptr)
+        {
+            DLOG(INFO) << role << ": the hierarchical block " << block->name() << " cannot be pinned nor instrumented";
+            return;
+        }
+    if (instrumentation_)
+        {
+            instrumentation_->add_block(role, gr_block);
+        }
+    if (cpus.empty())
+        {
+            return;
+        }
+    gr_block->set_processor_affinity(cpus);
+    LOG(INFO) << role << ": " << gr_block->name() << " pinned to " << cpus.size() << " CPU(s), starting at CPU " << cpus.front();
+}
+
+
+/*
+ * Scheduling classes of the threads of the blocks, from <role>.sched_policy
+ * (other, batch, idle, fifo or rr) and <role>.sched_priority. The classes are
+ * set once the threads run, at start(). In the channels, they apply to the
+ * tracking and telemetry decoder blocks, and the Channel<i> role takes
+ * precedence over Channel.
+ */
+void GNSSFlowgraph::set_thread_scheduling()
+{
+    thread_scheds_.clear();
+    for (const auto& source : sig_source_)
+        {
+            add_thread_sched(source->get_right_block(), source->role(), source->role());
+        }
+    for (const auto& conditioner : sig_conditioner_)
+        {
+            add_thread_sched(conditioner->get_left_block(), conditioner->role(), conditioner->role());
+            add_thread_sched(conditioner->get_right_block(), conditioner->role(), conditioner->role());
+        }
+    for (int i = 0; i < channels_count_; i++)
+        {
+            const std::string role = "Channel" + std::to_string(i);
+            const std::string class_role = (configuration_->property(role + ".sched_policy", std::string("")).empty() ? std::string("Channel") : role);
+            add_thread_sched(channels_.at(i)->get_left_block_trk(), role, class_role);
+            add_thread_sched(channels_.at(i)->get_right_block(), role, class_role);
+        }
+    add_thread_sched(observables_->get_left_block(), "Observables", "Observables");
+    add_thread_sched(pvt_->get_left_block(), "PVT", "PVT");
+    for (const auto& monitor : synchro_monitors_)
+        {
+            add_thread_sched(monitor, "Monitor", "Monitor");
+        }
+}
+
+
+void GNSSFlowgraph::add_thread_sched(const gr::basic_block_sptr& block, const std::string& role, const std::string& class_role)
+{
+    Gnss_Thread_Sched sched;
+    sched.policy = configuration_->property(class_role + ".sched_policy", std::string(""));
+    sched.priority = configuration_->property(class_role + ".sched_priority", 0);
+    if (block == nullptr or sched.policy.empty())
+        {
+            return;
+        }
+    const gr::block_sptr gr_block = gr::cast_to_block_sptr(block);
+    if (gr_block == nullptr)
+        {
+            LOG(WARNING) << role << ": the hierarchical block " << block->name() << " has no thread of its own to schedule";
+            return;
+        }
+    for (const auto& thread_sched : thread_scheds_)
+        {
+            if (thread_sched.first == gr_block)
+                {
+                    return;
+                }
+        }
+    thread_scheds_.emplace_back(gr_block, std::make_pair(role, sched));
+}
+
+
+/*
+ * Output buffers of the signal conditioners, read by the channels. Those of
+ * the signal sources are set with their ingest.
+ */
+void GNSSFlowgraph::set_stream_buffers()
+{
+    const double fs = configuration_->property("GNSS-SDR.internal_fs_sps", 0.0);
+    for (const auto& conditioner : sig_conditioner_)
+        {
+            const gr::block_sptr block = gr::cast_to_block_sptr(conditioner->get_right_block());
+            if (block == nullptr)
+                {
+                    if (stream_buffer_policy_->buffer(conditioner->role(), fs, sizeof(gr_complex)).items > 0)
                         {
-                            top_block_->connect(sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block(), 0,
-                                channels_.at(i)->get_left_block_acq(), 0);
+                            LOG(WARNING) << conditioner->role() << ": the output buffer cannot be set in the hierarchical block " << conditioner->get_right_block()->name();
                         }
-                    top_block_->connect(sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block(), 0,
-                        channels_.at(i)->get_left_block_trk(), 0);
+                    continue;
                 }
-            catch (const std::exception& e)
+            configure_stream_buffer(block, 0, conditioner->role(), fs, 0);
+        }
+}
+
+
+void GNSSFlowgraph::configure_stream_buffer(const gr::block_sptr& block, int port, const std::string& role, double items_per_s, int64_t buffer_items)
+{
+    const auto item_size = static_cast<size_t>(block->output_signature()->sizeof_stream_item(port));
+    const Stream_Buffer stream_buffer = stream_buffer_policy_->buffer(role, items_per_s, item_size);
+    // an explicit size takes precedence over the policy
+    const int64_t items = (buffer_items > 0 ? buffer_items : stream_buffer.items);
+    if (items > 0)
+        {
+            block->set_min_output_buffer(port, items);
+            LOG(INFO) << role << ": buffer of " << items << " samples at the output " << port << " of " << block->name();
+        }
+    // a soft alignment of the work calls, which does not override the
+    // output multiple that a block needs
+    if (!block->output_multiple_set() and block->alignment() < stream_buffer.alignment)
+        {
+            block->set_alignment(stream_buffer.alignment);
+            LOG(INFO) << role << ": " << block->name() << " produces items in multiples of " << stream_buffer.alignment;
+        }
+    if (stream_buffer.huge_pages)
+        {
+            huge_page_outputs_.emplace_back(block, std::make_pair(port, role));
+        }
+}
+
+
+void GNSSFlowgraph::advise_huge_pages()
+{
+    // GNU Radio has allocated the buffers once start() returns. They are
+    // mapped twice in a row, so the advice covers both copies.
+    size_t total_advised = 0;
+    for (const auto& output : huge_page_outputs_)
+        {
+            const gr::block_sptr& block = output.first;
+            const int port = output.second.first;
+            const std::string& role = output.second.second;
+            if (block->detail() == nullptr or block->detail()->noutputs() <= port)
+                {
+                    continue;
+                }
+            const gr::buffer_sptr buffer = block->detail()->output(port);
+            const auto bytes = static_cast<size_t>(buffer->bufsize()) * static_cast<size_t>(block->output_signature()->sizeof_stream_item(port));
+            size_t advised = 0;
+            const std::string error = gnss_advise_huge_pages(static_cast<const void*>(buffer->base()), 2 * bytes, advised);
+            if (!error.empty())
+                {
+                    LOG(WARNING) << role << ": the buffer of " << bytes << " bytes at the output " << port << " of " << block->name() << " is not backed by huge pages: " << error;
+                }
+            total_advised += advised;
+        }
+    if (!huge_page_outputs_.empty())
+        {
+            LOG(INFO) << total_advised / Stream_Buffer_Policy::HUGE_PAGE_BYTES << " huge pages advised for the buffers of " << huge_page_outputs_.size() << " output(s)";
+        }
+}
+
+
+void GNSSFlowgraph::apply_thread_scheduling()
+{
+    // GNU Radio has set the thread handle of each block once start() returns
+    int failed = 0;
+    for (const auto& thread_sched : thread_scheds_)
+        {
+            const gr::block_sptr& block = thread_sched.first;
+            const std::string& role = thread_sched.second.first;
+            const Gnss_Thread_Sched& sched = thread_sched.second.second;
+            const std::string error = (block->detail() ? gnss_set_thread_sched(block->detail()->thread, sched) : std::string("the block is not running"));
+            if (error.empty())
+                {
+                    LOG(INFO) << role << ": " << block->name() << " runs with the scheduling policy " << sched.policy << " and priority " << sched.priority;
+                }
+            else
+                {
+                    failed++;
+                    LOG(WARNING) << role << ": " << block->name() << " did not get the scheduling policy " << sched.policy << " and priority " << sched.priority << ": " << error;
+                    std::cerr << "The thread of " << role << " (" << block->name() << ") did not get the scheduling policy " << sched.policy << ": " << error << '\n';
+                }
+        }
+    if (failed > 0)
+        {
+            std::cerr << failed << " of " << thread_scheds_.size() << " threads did not get their scheduling class. "
+                      << "The real-time policies require CAP_SYS_NICE or a high enough RLIMIT_RTPRIO\n";
+        }
+}
+
+
+void GNSSFlowgraph::update_instrumentation()
+{
+    if (instrumentation_ == nullptr or !running_)
+        {
+            return;
+        }
+    int64_t channels_in_acquisition = 0;
+    {
+        std::lock_guard<std::mutex> lock(signal_list_mutex_);
+        channels_in_acquisition = std::count(channels_state_.cbegin(), channels_state_.cend(), 1U);
+    }
+    std::string extra_metrics;
+    if (realtime_budget_)
+        {
+            extra_metrics += realtime_budget_->report();
+        }
+    if (pipeline_latency_)
+        {
+            extra_metrics += pipeline_latency_->report();
+        }
+    if (!spectral_monitors_.empty())
+        {
+            extra_metrics += Gnss_Spectral_Monitor::report_all(configuration_->property("GNSS-SDR.spectral_monitor_psd_bins", 32));
+        }
+    instrumentation_->set_extra_metrics(std::move(extra_metrics));
+    instrumentation_->update(acquisition_thread_pool_->pending(), static_cast<int>(channels_in_acquisition));
+}
+
+
+void GNSSFlowgraph::update_realtime_budget()
+{
+    if (realtime_budget_ == nullptr or !running_)
+        {
+            return;
+        }
+    const auto now = std::chrono::steady_clock::now();
+    if (now - last_budget_update_ < budget_period_)
+        {
+            return;
+        }
+    last_budget_update_ = now;
+
+    uint64_t lost_samples = 0;
+    for (const auto& monitor : ingest_monitors_)
+        {
+            lost_samples += monitor->get_lost_samples();
+        }
+    // a source whose buffers stay full is waiting for the blocks downstream
+    float buffer_fill = 0.0;
+    for (const auto& output : source_outputs_)
+        {
+            if (output.first->detail() != nullptr)
+                {
+                    buffer_fill = std::max(buffer_fill, output.first->pc_output_buffers_full(output.second));
+                }
+        }
+    const int level = realtime_budget_->update(lost_samples, static_cast<double>(buffer_fill));
+    if (level != budget_level_)
+        {
+            std::lock_guard<std::mutex> lock(signal_list_mutex_);
+            apply_realtime_budget_level(level);
+        }
+}
+
+
+std::chrono::steady_clock::time_point GNSSFlowgraph::next_housekeeping_time()
+{
+    // with nothing pending, an hour away: some implementations of
+    // condition_variable::wait_until overflow with time_point::max()
+    auto next = std::chrono::steady_clock::now() + std::chrono::hours(1);
+    if (!running_)
+        {
+            return next;
+        }
+    if (realtime_budget_ != nullptr)
+        {
+            next = std::min(next, last_budget_update_ + budget_period_);
+        }
+    if (instrumentation_ != nullptr)
+        {
+            next = std::min(next, instrumentation_->next_sample_time());
+        }
+    // the idle channels wait for a signal, which may be returned to the
+    // list without any event
+    std::lock_guard<std::mutex> lock(signal_list_mutex_);
+    if (!idle_channels_.empty() and acq_channels_count_ < max_acq_channels_)
+        {
+            next = std::min(next, std::chrono::steady_clock::now() + std::chrono::milliseconds(100));
+        }
+    return next;
+}
+
+
+void GNSSFlowgraph::apply_realtime_budget_level(int level)
+{
+    // the actions of each level are taken, or undone, one level at a time
+    while (budget_level_ < level)
+        {
+            budget_level_++;
+            if (budget_level_ == 1)
+                {
+                    max_acq_channels_ = std::min(configured_max_acq_channels_, 1);
+                    realtime_budget_->record_action("acquisition limited to " + std::to_string(max_acq_channels_) + " channel(s) at a time");
+                }
+            else if (budget_level_ == 2)
+                {
+                    for (const auto& monitor : synchro_monitors_)
+                        {
+                            monitor->set_decimation_scale(budget_monitor_decimation_);
+                        }
+                    if (!synchro_monitors_.empty())
+                        {
+                            realtime_budget_->record_action("monitors decimated by " + std::to_string(budget_monitor_decimation_));
+                        }
+                }
+            else
+                {
+                    const int channel = lowest_elevation_tracking_channel();
+                    if (channel >= 0)
+                        {
+                            const Gnss_Signal signal = channels_[channel]->get_signal();
+                            take_channel_out_of_service(static_cast<unsigned int>(channel));
+                            budget_stopped_channels_.push_back(static_cast<unsigned int>(channel));
+                            std::stringstream action;
+                            action << "channel " << channel << " (" << signal.get_satellite() << ", signal " << signal.get_signal_str() << ") stopped";
+                            realtime_budget_->record_action(action.str());
+                        }
+                }
+        }
+    while (budget_level_ > level)
+        {
+            if (budget_level_ == 1)
+                {
+                    max_acq_channels_ = configured_max_acq_channels_;
+                    realtime_budget_->record_action("acquisition restored to " + std::to_string(max_acq_channels_) + " channel(s) at a time");
+                    acquisition_manager(static_cast<unsigned int>(channels_count_ - 1));
+                }
+            else if (budget_level_ == 2)
+                {
+                    for (const auto& monitor : synchro_monitors_)
+                        {
+                            monitor->set_decimation_scale(1);
+                        }
+                    if (!synchro_monitors_.empty())
+                        {
+                            realtime_budget_->record_action("monitors decimation restored");
+                        }
+                }
+            else if (!budget_stopped_channels_.empty())
+                {
+                    const unsigned int channel = budget_stopped_channels_.back();
+                    budget_stopped_channels_.pop_back();
+                    return_channel_to_service(channel);
+                    realtime_budget_->record_action("channel " + std::to_string(channel) + " returned to service");
+                }
+            budget_level_--;
+        }
+}
+
+
+int GNSSFlowgraph::lowest_elevation_tracking_channel() const
+{
+    // satellites without a predicted elevation go last, and then the
+    // channels with the highest IDs go first
+    int lowest_channel = -1;
+    int lowest_elevation = 0;
+    for (int ch = 0; ch < channels_count_; ch++)
+        {
+            if (channels_state_[ch] != 2)
+                {
+                    continue;
+                }
+            const Gnss_Satellite satellite = channels_[ch]->get_signal().get_satellite();
+            const auto elevation = satellite_elevations_.find(std::make_pair(satellite.get_system_short()[0], satellite.get_PRN()));
+            const int elevation_deg = elevation == satellite_elevations_.cend() ? 90 : elevation->second;
+            if (lowest_channel < 0 or elevation_deg <= lowest_elevation)
+                {
+                    lowest_channel = ch;
+                    lowest_elevation = elevation_deg;
+                }
+        }
+    return lowest_channel;
+}
+
+
+int GNSSFlowgraph::connect_signal_conditioners_to_channels()
+{
+    for (int i = 0; i < channels_count_; i++)
+        {
+            if (connect_signal_conditioner_to_channel(i) != 0)
                 {
-                    LOG(ERROR) << "Can't connect signal conditioner " << selected_signal_conditioner_ID << " to channel " << i << ": " << e.what();
                     top_block_->disconnect_all();
                     return 1;
                 }
+        }
+    return 0;
+}
+
 
-            signal_conditioner_connected_.at(selected_signal_conditioner_ID) = true;  // annotate that this signal conditioner is connected
-            DLOG(INFO) << "Signal conditioner " << selected_signal_conditioner_ID << " successfully connected to channel " << i;
+gr::basic_block_sptr GNSSFlowgraph::acquisition_branch(int i, int signal_conditioner_ID)
+{
+    const bool use_acq_resampler = configuration_->property("GNSS-SDR.use_acquisition_resampler", false);
+    const uint32_t fs = configuration_->property("GNSS-SDR.internal_fs_sps", 0);
+    const gr::basic_block_sptr conditioner_output = sig_conditioner_.at(signal_conditioner_ID)->get_right_block();
+    const std::string signal_str = channels_.at(i)->get_signal().get_signal_str();
+    std::shared_ptr<Channel> channel_ptr = std::dynamic_pointer_cast<Channel>(channels_.at(i));
+
+    // Decimation to the optimal acquisition sampling rate of the signal, if required
+    int decimation = 1;
+    if (use_acq_resampler == true)
+        {
+            double acq_fs = fs;
+            // find the signal associated to this channel
+            switch (mapStringValues_[signal_str])
+                {
+                case evGPS_1C:
+                    acq_fs = GPS_L1_CA_OPT_ACQ_FS_SPS;
+                    break;
+                case evGPS_2S:
+                    acq_fs = GPS_L2C_OPT_ACQ_FS_SPS;
+                    break;
+                case evGPS_L5:
+                    acq_fs = GPS_L5_OPT_ACQ_FS_SPS;
+                    break;
+                case evSBAS_1C:
+                    acq_fs = GPS_L1_CA_OPT_ACQ_FS_SPS;
+                    break;
+                case evGAL_1B:
+                    acq_fs = GALILEO_E1_OPT_ACQ_FS_SPS;
+                    break;
+                case evGAL_5X:
+                    acq_fs = GALILEO_E5A_OPT_ACQ_FS_SPS;
+                    break;
+                case evGAL_7X:
+                    acq_fs = GALILEO_E5B_OPT_ACQ_FS_SPS;
+                    break;
+                case evGAL_E6:
+                    acq_fs = GALILEO_E6_OPT_ACQ_FS_SPS;
+                    break;
+                case evGLO_1G:
+                case evGLO_2G:
+                case evBDS_B1:
+                case evBDS_B3:
+                    acq_fs = fs;
+                    break;
+                default:
+                    break;
+                }
+
+            if (acq_fs < fs)
+                {
+                    decimation = floor(static_cast<double>(fs) / acq_fs);
+                    while (fs % decimation > 0)
+                        {
+                            decimation--;
+                        };
+                }
+            if (decimation <= 1)
+                {
+                    LOG(INFO) << "Disabled acquisition resampler because the input sampling frequency is too low";
+                }
+        }
+
+    // Bit reduction, if the acquisition takes 16 bits samples and the tracking floating point ones
+    const bool to_cshort = channel_ptr != nullptr and
+                           channel_ptr->tracking()->item_size() == sizeof(gr_complex) and
+                           channel_ptr->acquisition()->item_size() == sizeof(std::complex<int16_t>);
+
+    if (decimation <= 1 and !to_cshort)
+        {
+            return conditioner_output;
+        }
+
+    uint32_t latency_samples = 0;
+    if (decimation > 1)
+        {
+            // polyphase decimator, with the same loose low pass filter for all
+            // the channels of a signal, and an exact latency
+            latency_samples = Rational_Resampler(fs, fs / decimation, 0.5, 50.0).latency_samples();
+            if (channel_ptr != nullptr)
+                {
+                    channel_ptr->acquisition()->set_resampler_latency(latency_samples);
+                }
+        }
+
+    // check if the branch is already created for the channel system/signal and for the specific RF Channel
+    const std::string map_key = signal_str + std::to_string(signal_conditioner_ID) + (to_cshort ? "cshort" : "");
+    auto branch = acq_resamplers_.find(map_key);
+    if (branch != acq_resamplers_.end())
+        {
+            LOG(INFO) << "Found existing " << signal_str << " acquisition branch for RF channel " << signal_conditioner_ID
+                      << " with a decimation factor of " << decimation << (to_cshort ? " and 16 bits samples" : "");
+            return branch->second;
+        }
+
+    gr::basic_block_sptr tail = conditioner_output;
+    if (decimation > 1)
+        {
+            auto resampler = make_rational_resampler_cc(fs, fs / decimation, 0.5, 50.0);
+            top_block_->connect(tail, 0, resampler, 0);
+            tail = resampler;
+        }
+    if (to_cshort)
+        {
+            const float scale = configuration_->property("GNSS-SDR.acquisition_branch_scale", 1.0F);
+            auto converter = make_complex_float_to_complex_short(scale);
+            top_block_->connect(tail, 0, converter, 0);
+            tail = converter;
+        }
+    acq_resamplers_.insert(std::pair<std::string, gr::basic_block_sptr>(map_key, tail));
+    LOG(INFO) << "Created " << signal_str << " acquisition branch for RF channel " << signal_conditioner_ID
+              << " with a decimation factor of " << decimation << ", a latency of " << latency_samples << " samples"
+              << (to_cshort ? " and 16 bits samples" : "");
+    return tail;
+}
+
+
+gr::basic_block_sptr GNSSFlowgraph::glonass_acquisition_branch(int i, int signal_conditioner_ID)
+{
+    const std::string signal_str = channels_.at(i)->get_signal().get_signal_str();
+    std::shared_ptr<Channel> channel_ptr = std::dynamic_pointer_cast<Channel>(channels_.at(i));
+    if (!configuration_->property("GNSS-SDR.use_glonass_fdma_channelizer", false) or
+        (signal_str != "1G" and signal_str != "2G") or
+        channel_ptr == nullptr or channel_ptr->acquisition()->item_size() != sizeof(gr_complex))
+        {
+            return nullptr;
+        }
+
+    // Decimation to the acquisition sampling rate of the sub-bands, as in the acquisition
+    const uint32_t fs = configuration_->property("GNSS-SDR.internal_fs_sps", 0);
+    const bool is_l1 = (signal_str == "1G");
+    const double acq_fs = is_l1 ? GLONASS_L1_CA_OPT_ACQ_FS_SPS : GLONASS_L2_CA_OPT_ACQ_FS_SPS;
+    int decimation = 1;
+    if (acq_fs < fs)
+        {
+            decimation = floor(static_cast<double>(fs) / acq_fs);
+            while (fs % decimation > 0)
+                {
+                    decimation--;
+                };
         }
+
+    // the loose low pass filter of the acquisition resampler, shifted to
+    // each sub-band, with an exact latency
+    const std::vector<float> taps = Rational_Resampler::design_taps(1, decimation, 0.5, 50.0);
+    const auto latency_samples = static_cast<uint32_t>((taps.size() - 1) / 2);
+    channel_ptr->acquisition()->set_resampler_latency(latency_samples);
+
+    // all the acquisitions of the signal on the RF channel share the channelizer
+    const std::string map_key = signal_str + std::to_string(signal_conditioner_ID) + "fdma";
+    auto branch = acq_resamplers_.find(map_key);
+    if (branch != acq_resamplers_.end())
+        {
+            return branch->second;
+        }
+
+    std::vector<double> center_freqs;
+    for (int32_t k = GLONASS_MIN_FREQUENCY_NUMBER; k <= GLONASS_MAX_FREQUENCY_NUMBER; k++)
+        {
+            center_freqs.push_back(static_cast<double>(k) * (is_l1 ? DFRQ1_GLO : DFRQ2_GLO) / static_cast<double>(fs));
+        }
+    auto channelizer = make_xlating_decimator_cc(taps, decimation, center_freqs);
+    top_block_->connect(sig_conditioner_.at(signal_conditioner_ID)->get_right_block(), 0, channelizer, 0);
+    acq_resamplers_.insert(std::pair<std::string, gr::basic_block_sptr>(map_key, channelizer));
+    LOG(INFO) << "Created " << signal_str << " FDMA channelizer for RF channel " << signal_conditioner_ID
+              << " with " << center_freqs.size() << " sub-bands, a decimation factor of " << decimation
+              << " and a latency of " << latency_samples << " samples";
+    return channelizer;
+}
+
+
+gr::basic_block_sptr GNSSFlowgraph::tracking_branch(int i, int signal_conditioner_ID)
+{
+    // a tracking with an input item bigger than a sample of the array signal
+    // conditioner takes the samples of the elements of the antenna array,
+    // interleaved, ahead of the conditioner
+    const auto& conditioner = sig_conditioner_.at(signal_conditioner_ID);
+    const size_t trk_item_size = channels_.at(i)->get_left_block_trk()->input_signature()->sizeof_stream_item(0);
+    if (conditioner->implementation() != "Array_Signal_Conditioner" or trk_item_size <= sizeof(gr_complex))
+        {
+            return conditioner->get_right_block();
+        }
+    const auto elements = static_cast<int>(trk_item_size / sizeof(gr_complex));
+    if (elements > GNSS_SDR_ARRAY_SIGNAL_CONDITIONER_CHANNELS)
+        {
+            throw std::runtime_error("the antenna array has " + std::to_string(GNSS_SDR_ARRAY_SIGNAL_CONDITIONER_CHANNELS) + " elements, not " + std::to_string(elements));
+        }
+
+    auto interleaver = array_interleavers_.find(signal_conditioner_ID);
+    if (interleaver != array_interleavers_.end())
+        {
+            if (interleaver->second->output_signature()->sizeof_stream_item(0) != trk_item_size)
+                {
+                    throw std::runtime_error("the channels of an antenna array must track the same number of elements");
+                }
+            return interleaver->second;
+        }
+    auto streams_to_vector = gr::blocks::streams_to_vector::make(sizeof(gr_complex), elements);
+    for (int j = 0; j < elements; j++)
+        {
+            top_block_->connect(sig_source_.at(signal_conditioner_ID)->get_right_block(), j, streams_to_vector, j);
+        }
+    array_interleavers_.insert(std::pair<int, gr::basic_block_sptr>(signal_conditioner_ID, streams_to_vector));
+    LOG(INFO) << "Created the tracking branch of the " << elements << " elements of the antenna array of RF channel " << signal_conditioner_ID;
+    return streams_to_vector;
+}
+
+
+int GNSSFlowgraph::connect_signal_conditioner_to_channel(int i)
+{
+    int selected_signal_conditioner_ID = 0;
+    try
+        {
+            selected_signal_conditioner_ID = configuration_->property("Channel" + std::to_string(i) + ".RF_channel_ID", 0);
+        }
+    catch (const std::exception& e)
+        {
+            LOG(WARNING) << e.what();
+        }
+    try
+        {
+            // All the acquisitions of a signal share a branch of the
+            // conditioner output, decimated and bit reduced if required,
+            // while the tracking stays on the full rate stream
+            const gr::basic_block_sptr channelizer = glonass_acquisition_branch(i, selected_signal_conditioner_ID);
+            if (channelizer != nullptr)
+                {
+                    // one acquisition input per GLONASS FDMA sub-band
+                    for (int k = 0; k <= GLONASS_MAX_FREQUENCY_NUMBER - GLONASS_MIN_FREQUENCY_NUMBER; k++)
+                        {
+                            top_block_->connect(channelizer, k, channels_.at(i)->get_left_block_acq(), k);
+                        }
+                }
+            else
+                {
+                    top_block_->connect(acquisition_branch(i, selected_signal_conditioner_ID), 0,
+                        channels_.at(i)->get_left_block_acq(), 0);
+                }
+            top_block_->connect(tracking_branch(i, selected_signal_conditioner_ID), 0,
+                channels_.at(i)->get_left_block_trk(), 0);
+        }
+    catch (const std::exception& e)
+        {
+            LOG(ERROR) << "Can't connect signal conditioner " << selected_signal_conditioner_ID << " to channel " << i << ": " << e.what();
+            return 1;
+        }
+
+    signal_conditioner_connected_.at(selected_signal_conditioner_ID) = true;  // annotate that this signal conditioner is connected
+    DLOG(INFO) << "Signal conditioner " << selected_signal_conditioner_ID << " successfully connected to channel " << i;
     return 0;
 }
 
@@ -1112,18 +2346,12 @@ int GNSSFlowgraph::connect_observables_to_pvt()
             for (int i = 0; i < channels_count_; i++)
                 {
                     top_block_->connect(observables_->get_right_block(), i, pvt_->get_left_block(), i);
-                    top_block_->msg_connect(channels_.at(i)->get_right_block(), pmt::mp("telemetry"), pvt_->get_left_block(), pmt::mp("telemetry"));
                     // experimental Vector Tracking Loop (VTL) messages from PVT to Tracking blocks
                     // not supported by all tracking algorithms
-                    pmt::pmt_t ports_in = channels_.at(i)->get_left_block_trk()->message_ports_in();
-                    for (size_t n = 0; n < pmt::length(ports_in); n++)
+                    if (has_pvt_to_trk_port(channels_.at(i)))
                         {
-                            // std::cout << "pmt: " << pmt::symbol_to_string(pmt::vector_ref(ports_in, n)) << "\n";
-                            if (pmt::symbol_to_string(pmt::vector_ref(ports_in, n)) == "pvt_to_trk")
-                                {
-                                    top_block_->msg_connect(pvt_->get_left_block(), pmt::mp("pvt_to_trk"), channels_.at(i)->get_left_block_trk(), pmt::mp("pvt_to_trk"));
-                                    LOG(INFO) << "pvt_to_trk message port connected in " << channels_.at(i)->implementation();
-                                }
+                            top_block_->msg_connect(pvt_->get_left_block(), pmt::mp("pvt_to_trk"), channels_.at(i)->get_left_block_trk(), pmt::mp("pvt_to_trk"));
+                            LOG(INFO) << "pvt_to_trk message port connected in " << channels_.at(i)->implementation();
                         }
                 }
 
@@ -1131,6 +2359,17 @@ int GNSSFlowgraph::connect_observables_to_pvt()
 
             top_block_->msg_connect(pvt_->get_left_block(), pmt::mp("pvt_to_observables"), observables_->get_right_block(), pmt::mp("pvt_to_observables"));
             top_block_->msg_connect(pvt_->get_left_block(), pmt::mp("status"), channels_status_, pmt::mp("status"));
+
+            // directions of the satellites to the antenna array beamformers, if any
+            for (const auto& conditioner : sig_conditioner_)
+                {
+                    const gr::basic_block_sptr beamformer = pvt_to_beamformer_block(conditioner);
+                    if (beamformer != nullptr)
+                        {
+                            top_block_->msg_connect(pvt_->get_left_block(), pmt::mp("pvt_to_beamformer"), beamformer, pmt::mp("pvt_to_beamformer"));
+                            LOG(INFO) << "pvt_to_beamformer message port connected in " << conditioner->role();
+                        }
+                }
         }
     catch (const std::exception& e)
         {
@@ -1143,13 +2382,54 @@ int GNSSFlowgraph::connect_observables_to_pvt()
 }
 
 
+bool GNSSFlowgraph::has_pvt_to_trk_port(const std::shared_ptr<ChannelInterface>& channel) const
+{
+    const pmt::pmt_t ports_in = channel->get_left_block_trk()->message_ports_in();
+    for (size_t n = 0; n < pmt::length(ports_in); n++)
+        {
+            if (pmt::symbol_to_string(pmt::vector_ref(ports_in, n)) == "pvt_to_trk")
+                {
+                    return true;
+                }
+        }
+    return false;
+}
+
+
+gr::basic_block_sptr GNSSFlowgraph::pvt_to_beamformer_block(const std::shared_ptr<GNSSBlockInterface>& conditioner) const
+{
+    const auto signal_conditioner = std::dynamic_pointer_cast<SignalConditioner>(conditioner);
+    if (signal_conditioner == nullptr or signal_conditioner->input_filter() == nullptr)
+        {
+            return nullptr;
+        }
+    const gr::basic_block_sptr input_filter = signal_conditioner->input_filter()->get_left_block();
+    if (input_filter == nullptr)
+        {
+            return nullptr;
+        }
+    const pmt::pmt_t ports_in = input_filter->message_ports_in();
+    for (size_t n = 0; n < pmt::length(ports_in); n++)
+        {
+            if (pmt::symbol_to_string(pmt::vector_ref(ports_in, n)) == "pvt_to_beamformer")
+                {
+                    return input_filter;
+                }
+        }
+    return nullptr;
+}
+
+
 int GNSSFlowgraph::connect_gnss_synchro_monitor()
 {
     try
         {
+            // with Observables.pvt_interval_ms, the outputs after the ones of
+            // the PVT block keep the rate of the receiver clock
+            const int first_output = (observables_->get_right_block()->output_signature()->max_streams() > channels_count_ ? channels_count_ : 0);
             for (int i = 0; i < channels_count_; i++)
                 {
-                    top_block_->connect(observables_->get_right_block(), i, GnssSynchroMonitor_, i);
+                    top_block_->connect(observables_->get_right_block(), first_output + i, GnssSynchroMonitor_, i);
                 }
         }
     catch (const std::exception& e)
@@ -1328,15 +2608,7 @@ int GNSSFlowgraph::assign_channels()
     std::vector<unsigned int> vector_of_channels;
     for (int i = 0; i < channels_count_; i++)
         {
-            unsigned int sat = 0;
-            try
-                {
-                    sat = configuration_->property("Channel" + std::to_string(i) + ".satellite", 0);
-                }
-            catch (const std::exception& e)
-                {
-                    LOG(WARNING) << e.what();
-                }
+            const unsigned int sat = conf_.channel_satellite(i);
             if (sat == 0)
                 {
                     vector_of_channels.push_back(i);
@@ -1441,15 +2713,7 @@ int GNSSFlowgraph::assign_channels()
     for (unsigned int& i : vector_of_channels)
         {
             const std::string gnss_signal_str = channels_.at(i)->get_signal().get_signal_str();  // use channel's implicit signal
-            unsigned int sat = 0;
-            try
-                {
-                    sat = configuration_->property("Channel" + std::to_string(i) + ".satellite", 0);
-                }
-            catch (const std::exception& e)
-                {
-                    LOG(WARNING) << e.what();
-                }
+            const unsigned int sat = conf_.channel_satellite(i);
             if (sat == 0)
                 {
                     bool assistance_available;
@@ -1574,11 +2838,15 @@ void GNSSFlowgraph::check_desktop_conf_in_fpga_env()
 }
 
 
-bool GNSSFlowgraph::send_telemetry_msg(const pmt::pmt_t& msg)
+bool GNSSFlowgraph::send_telemetry_msg(const Gnss_Nav_Product& product)
 {
-    // Push ephemeris to PVT telemetry msg in port using a channel out port
-    // it uses the first channel as a message producer (it is already connected to PVT)
-    channels_.at(0)->get_right_block()->message_port_pub(pmt::mp("telemetry"), msg);
+    // Push ephemeris to PVT through a channel of its own, which PVT drains
+    // together with the channels of the telemetry decoders
+    if (assistance_nav_products_ == nullptr)
+        {
+            assistance_nav_products_ = Gnss_Nav_Product_Channel::create(1024);
+        }
+    assistance_nav_products_->push(product);
     return true;
 }
 
@@ -1588,57 +2856,46 @@ void GNSSFlowgraph::push_back_signal(const Gnss_Signal& gs)
     switch (mapStringValues_[gs.get_signal_str()])
         {
         case evGPS_1C:
-            available_GPS_1C_signals_.remove(gs);
             available_GPS_1C_signals_.push_back(gs);
             break;
 
         case evGPS_2S:
-            available_GPS_2S_signals_.remove(gs);
             available_GPS_2S_signals_.push_back(gs);
             break;
 
         case evGPS_L5:
-            available_GPS_L5_signals_.remove(gs);
             available_GPS_L5_signals_.push_back(gs);
             break;
 
         case evGAL_1B:
-            available_GAL_1B_signals_.remove(gs);
             available_GAL_1B_signals_.push_back(gs);
             break;
 
         case evGAL_5X:
-            available_GAL_5X_signals_.remove(gs);
             available_GAL_5X_signals_.push_back(gs);
             break;
 
         case evGAL_7X:
-            available_GAL_7X_signals_.remove(gs);
             available_GAL_7X_signals_.push_back(gs);
             break;
 
         case evGAL_E6:
-            available_GAL_E6_signals_.remove(gs);
             available_GAL_E6_signals_.push_back(gs);
             break;
 
         case evGLO_1G:
-            available_GLO_1G_signals_.remove(gs);
             available_GLO_1G_signals_.push_back(gs);
             break;
 
         case evGLO_2G:
-            available_GLO_2G_signals_.remove(gs);
             available_GLO_2G_signals_.push_back(gs);
             break;
 
         case evBDS_B1:
-            available_BDS_B1_signals_.remove(gs);
             available_BDS_B1_signals_.push_back(gs);
             break;
 
         case evBDS_B3:
-            available_BDS_B3_signals_.remove(gs);
             available_BDS_B3_signals_.push_back(gs);
             break;
 
@@ -1728,78 +2985,278 @@ double GNSSFlowgraph::project_doppler(const std::string& searched_signal, double
 }
 
 
+bool GNSSFlowgraph::signal_code_parameters(const std::string& signal, double& code_period_s, double& carrier_freq_hz)
+{
+    const auto it = mapStringValues_.find(signal);
+    if (it == mapStringValues_.end())
+        {
+            return false;
+        }
+    switch (it->second)
+        {
+        case evGPS_1C:
+            code_period_s = GPS_L1_CA_CODE_PERIOD_S;
+            carrier_freq_hz = FREQ1;
+            break;
+        case evGPS_2S:
+            code_period_s = GPS_L2_M_PERIOD_S;
+            carrier_freq_hz = FREQ2;
+            break;
+        case evGPS_L5:
+            code_period_s = GPS_L5I_PERIOD_S;
+            carrier_freq_hz = FREQ5;
+            break;
+        case evGAL_1B:
+            code_period_s = GALILEO_E1_CODE_PERIOD_S;
+            carrier_freq_hz = FREQ1;
+            break;
+        case evGAL_5X:
+            code_period_s = GALILEO_E5A_CODE_PERIOD_S;
+            carrier_freq_hz = FREQ5;
+            break;
+        case evGAL_7X:
+            code_period_s = GALILEO_E5B_CODE_PERIOD_S;
+            carrier_freq_hz = FREQ7;
+            break;
+        case evGAL_E6:
+            code_period_s = GALILEO_E6_CODE_PERIOD_S;
+            carrier_freq_hz = FREQ6;
+            break;
+        case evGLO_1G:
+            code_period_s = GLONASS_L1_CA_CODE_PERIOD_S;
+            carrier_freq_hz = FREQ1_GLO;
+            break;
+        case evGLO_2G:
+            code_period_s = GLONASS_L2_CA_CODE_PERIOD_S;
+            carrier_freq_hz = FREQ2_GLO;
+            break;
+        case evBDS_B1:
+            code_period_s = BEIDOU_B1I_CODE_PERIOD_S;
+            carrier_freq_hz = FREQ1_BDS;
+            break;
+        case evBDS_B3:
+            code_period_s = BEIDOU_B3I_CODE_PERIOD_S;
+            carrier_freq_hz = FREQ3_BDS;
+            break;
+        default:
+            return false;
+        }
+    return true;
+}
+
+
+bool GNSSFlowgraph::find_tracking_reference(const Gnss_Signal& gnss_signal, const std::string& reference_signal, Gnss_Synchro& reference)
+{
+    const std::map<int, std::shared_ptr<Gnss_Synchro>> current_channels_status = channels_status_->get_current_status_map();
+    for (const auto& current_status : current_channels_status)
+        {
+            if ((current_status.second->System == gnss_signal.get_satellite().get_system_short()[0]) and
+                (current_status.second->PRN == gnss_signal.get_satellite().get_PRN()) and
+                (std::string(current_status.second->Signal) == reference_signal))
+                {
+                    reference = *current_status.second;
+                    return true;
+                }
+        }
+    return false;
+}
+
+
+/*
+ * Predicts the code epochs of searched_signal from the last tracking state
+ * of a signal of the same satellite. Code epochs are expressed in receiver
+ * time (sample counter / sampling rate), so all the signal sources are
+ * assumed to be sampled synchronously. The code epochs of the reference are
+ * also code epochs of the searched signal (the signals of a satellite are
+ * transmitted synchronously) if its code period is a multiple of the code
+ * period of the searched signal.
+ */
+bool GNSSFlowgraph::predict_code_epoch(const std::string& searched_signal, const Gnss_Synchro& reference, double& code_epoch_s, double& code_period_s)
+{
+    double reference_code_period_s = 0.0;
+    double reference_carrier_freq_hz = 0.0;
+    double carrier_freq_hz = 0.0;
+    if ((reference.fs <= 0) or
+        !signal_code_parameters(std::string(reference.Signal), reference_code_period_s, reference_carrier_freq_hz) or
+        !signal_code_parameters(searched_signal, code_period_s, carrier_freq_hz))
+        {
+            return false;
+        }
+    const double code_periods = reference_code_period_s / code_period_s;
+    if ((code_periods < 1.0) or (std::abs(code_periods - std::round(code_periods)) > 1e-6))
+        {
+            return false;
+        }
+    // Tracking reports the sample counter at the start of a prompt code period
+    code_epoch_s = static_cast<double>(reference.Tracking_sample_counter) / static_cast<double>(reference.fs);
+    // The code Doppler, relative to the code rate, is the same for all the signals of a satellite
+    code_period_s /= (1.0 + reference.Carrier_Doppler_hz / reference_carrier_freq_hz);
+    return true;
+}
+
+
+/*
+ * Starts tracking the secondary signal assigned to channel at the code epoch
+ * and Doppler predicted from the tracking state of the primary signal of the
+ * same satellite, skipping its acquisition. The channel notifies the start of
+ * tracking as a successful acquisition, so it takes an acquisition slot until
+ * then. If it loses lock, it is reacquired as any other channel.
+ */
+bool GNSSFlowgraph::handover_tracking(unsigned int channel)
+{
+    const Gnss_Signal searched_signal = channels_[channel]->get_signal();
+    const std::string primary_signal = (searched_signal.get_satellite().get_system() == "Galileo" ? "1B" : "1C");
+    Gnss_Synchro reference;
+    double code_epoch_s = 0.0;
+    double code_period_s = 0.0;
+    if (!find_tracking_reference(searched_signal, primary_signal, reference) or
+        !predict_code_epoch(searched_signal.get_signal_str(), reference, code_epoch_s, code_period_s))
+        {
+            return false;
+        }
+    // the code epoch of the primary signal is also a code epoch of the
+    // secondary one, and the inter-signal delays are a fraction of a sample
+    if (!channels_[channel]->start_tracking_handover(reference.Tracking_sample_counter,
+            project_doppler(searched_signal.get_signal_str(), reference.Carrier_Doppler_hz)))
+        {
+            return false;
+        }
+    set_channel_state(channel, 1);
+    acq_channels_count_++;
+    DLOG(INFO) << "Channel " << channel
+               << " Tracking handover " << searched_signal.get_satellite()
+               << ", Signal " << searched_signal.get_signal_str() << " from Signal " << primary_signal;
+    return true;
+}
+
+
+/*
+ * Starts tracking the signal assigned to channel at the code epoch and
+ * Doppler of a checkpoint, skipping its acquisition as in a handover. The
+ * tracking pull-in extrapolates the code epoch to the current sample with
+ * the code Doppler.
+ */
+bool GNSSFlowgraph::resume_tracking(unsigned int channel)
+{
+    if (tracking_hints_.empty())
+        {
+            return false;
+        }
+    const Gnss_Signal gnss_signal = channels_[channel]->get_signal();
+    const auto hint = tracking_hints_.find(std::make_pair(gnss_signal.get_signal_str(), gnss_signal.get_satellite().get_PRN()));
+    if (hint == tracking_hints_.end())
+        {
+            return false;
+        }
+    const uint64_t code_epoch_samples = hint->second.first;
+    const double doppler_hz = hint->second.second;
+    tracking_hints_.erase(hint);
+    if (!channels_[channel]->start_tracking_handover(code_epoch_samples, doppler_hz))
+        {
+            return false;
+        }
+    DLOG(INFO) << "Channel " << channel
+               << " Resuming the tracking of " << gnss_signal.get_satellite()
+               << ", Signal " << gnss_signal.get_signal_str() << " at sample " << code_epoch_samples;
+    return true;
+}
+
+
 void GNSSFlowgraph::acquisition_manager(unsigned int who)
 {
-    unsigned int current_channel;
-    for (int i = 0; i < channels_count_; i++)
+    // Visit the idle channels in round-robin order, starting after who, only
+    // while there are acquisition slots available
+    auto next_channel = idle_channels_.upper_bound(who);
+    size_t pending_channels = idle_channels_.size();
+    while (pending_channels > 0 && acq_channels_count_ < max_acq_channels_)
         {
-            current_channel = (i + who + 1) % channels_count_;
-            unsigned int sat_ = 0;
-            try
+            if (next_channel == idle_channels_.end())
                 {
-                    sat_ = configuration_->property("Channel" + std::to_string(current_channel) + ".satellite", 0);
+                    next_channel = idle_channels_.begin();
                 }
-            catch (const std::exception& e)
+            const unsigned int current_channel = *next_channel;
+            ++next_channel;
+            pending_channels--;
+            const unsigned int sat_ = conf_.channel_satellite(current_channel);
+            bool is_primary_freq = true;
+            bool assistance_available = false;
+            bool start_acquisition = false;
+            Gnss_Signal gnss_signal;
+            float estimated_doppler;
+            double RX_time;
+
+            if (sat_ == 0)
                 {
-                    LOG(WARNING) << e.what();
+                    gnss_signal = search_next_signal(channels_[current_channel]->get_signal().get_signal_str(),
+                        is_primary_freq,
+                        assistance_available,
+                        estimated_doppler,
+                        RX_time);
+                    channels_[current_channel]->set_signal(gnss_signal);
+                    start_acquisition = is_primary_freq or assistance_available or !conf_.assist_dual_frequency_acq;
                 }
-            if ((acq_channels_count_ < max_acq_channels_) && (channels_state_[current_channel] == 0))
+            else
                 {
-                    bool is_primary_freq = true;
-                    bool assistance_available = false;
-                    bool start_acquisition = false;
-                    Gnss_Signal gnss_signal;
-                    float estimated_doppler;
-                    double RX_time;
+                    channels_[current_channel]->set_signal(channels_[current_channel]->get_signal());
+                    start_acquisition = true;
+                }
 
-                    if (sat_ == 0)
+            // with the handover, an assisted secondary signal starts tracking without acquisition
+            const bool handover = start_acquisition and assistance_available and conf_.assist_dual_frequency_acq and
+                                  conf_.dual_frequency_handover and handover_tracking(current_channel);
+            // and so do the satellites of a checkpoint
+            const bool resumed = start_acquisition and !handover and resume_tracking(current_channel);
+            if (resumed)
+                {
+                    set_channel_state(current_channel, 1);
+                    acq_channels_count_++;
+                }
+            if (start_acquisition == true and !handover and !resumed)
+                {
+                    set_channel_state(current_channel, 1);
+                    acq_channels_count_++;
+                    DLOG(INFO) << "Channel " << current_channel
+                               << " Starting acquisition " << channels_[current_channel]->get_signal().get_satellite()
+                               << ", Signal " << channels_[current_channel]->get_signal().get_signal_str();
+                    double code_epoch_s = 0.0;
+                    double code_period_s = 0.0;
+                    if (assistance_available == true and conf_.assist_dual_frequency_acq)
                         {
-                            gnss_signal = search_next_signal(channels_[current_channel]->get_signal().get_signal_str(),
-                                is_primary_freq,
-                                assistance_available,
-                                estimated_doppler,
-                                RX_time);
-                            channels_[current_channel]->set_signal(gnss_signal);
-                            start_acquisition = is_primary_freq or assistance_available or !configuration_->property("GNSS-SDR.assist_dual_frequency_acq", multiband_);
+                            channels_[current_channel]->assist_acquisition_doppler(project_doppler(channels_[current_channel]->get_signal().get_signal_str(), estimated_doppler));
+                            Gnss_Synchro reference;
+                            const Gnss_Signal searched_signal = channels_[current_channel]->get_signal();
+                            const std::string primary_signal = (searched_signal.get_satellite().get_system() == "Galileo" ? "1B" : "1C");
+                            if (!conf_.assist_code_phase_acq or
+                                !find_tracking_reference(searched_signal, primary_signal, reference) or
+                                !predict_code_epoch(searched_signal.get_signal_str(), reference, code_epoch_s, code_period_s))
+                                {
+                                    code_period_s = 0.0;
+                                }
                         }
                     else
                         {
-                            channels_[current_channel]->set_signal(channels_[current_channel]->get_signal());
-                            start_acquisition = true;
+                            // set Doppler center to the one of the last run, the predicted one, or 0 Hz
+                            channels_[current_channel]->assist_acquisition_doppler(take_doppler_hint(channels_[current_channel]->get_signal()));
                         }
-
-                    if (start_acquisition == true)
-                        {
-                            channels_state_[current_channel] = 1;
-                            acq_channels_count_++;
-                            DLOG(INFO) << "Channel " << current_channel
-                                       << " Starting acquisition " << channels_[current_channel]->get_signal().get_satellite()
-                                       << ", Signal " << channels_[current_channel]->get_signal().get_signal_str();
-                            if (assistance_available == true and configuration_->property("GNSS-SDR.assist_dual_frequency_acq", multiband_))
-                                {
-                                    channels_[current_channel]->assist_acquisition_doppler(project_doppler(channels_[current_channel]->get_signal().get_signal_str(), estimated_doppler));
-                                }
-                            else
-                                {
-                                    // set Doppler center to 0 Hz
-                                    channels_[current_channel]->assist_acquisition_doppler(0);
-                                }
+                    channels_[current_channel]->assist_acquisition_code_phase(code_epoch_s, code_period_s);
 #if ENABLE_FPGA
-                            // create a task for the FPGA such that it doesn't stop the flow
-                            std::thread tmp_thread(&ChannelInterface::start_acquisition, channels_[current_channel]);
-                            tmp_thread.detach();
+                    // create a task for the FPGA such that it doesn't stop the flow
+                    {
+                        const std::shared_ptr<ChannelInterface> channel = channels_[current_channel];
+                        const Gnss_Satellite sat = channel->get_signal().get_satellite();
+                        acquisition_thread_pool_->submit(channel.get(), sat.get_system_short()[0], sat.get_PRN(), [channel]() { channel->start_acquisition(); });
+                    }
 #else
-                            channels_[current_channel]->start_acquisition();
+                    channels_[current_channel]->start_acquisition();
 #endif
-                        }
-                    else
-                        {
-                            push_back_signal(gnss_signal);
-                            DLOG(INFO) << "Channel " << current_channel
-                                       << " secondary frequency acquisition assistance not available in "
-                                       << channels_[current_channel]->get_signal().get_satellite()
-                                       << ", Signal " << channels_[current_channel]->get_signal().get_signal_str();
-                        }
+                }
+            else if (start_acquisition == false)
+                {
+                    push_back_signal(gnss_signal);
+                    DLOG(INFO) << "Channel " << current_channel
+                               << " secondary frequency acquisition assistance not available in "
+                               << channels_[current_channel]->get_signal().get_satellite()
+                               << ", Signal " << channels_[current_channel]->get_signal().get_signal_str();
                 }
             DLOG(INFO) << "Channel " << current_channel << " in state " << channels_state_[current_channel];
         }
@@ -1813,7 +3270,7 @@ void GNSSFlowgraph::acquisition_manager(unsigned int who)
  *  -> 0-199 are the channels IDs
  *  -> 200 is the control_thread dispatched by the control_thread apply_action
  *  -> 300 is the telecommand system (TC) for receiver control
- *  -> 400 - 599 is the TC channel control for channels 0-199
+ *  -> 400 + N is the TC channel control for the channel N
  * \param[in] what  What is the action:
  * --- actions from channels ---
  * -> 0 acquisition failed
@@ -1825,8 +3282,11 @@ void GNSSFlowgraph::acquisition_manager(unsigned int who)
  * -> 12 TC request hotstart
  * -> 13 TC request warmstart
  * --- actions from TC channel control ---
- * -> 20 stop channel
- * -> 21 start channel
+ * -> 20 stop channel, taking it out of service
+ * -> 21 start channel, returning it to service
+ * -> 22 reconfigure channel, applied by the control thread with reconfigure_channel()
+ * --- actions from TC receiver control ---
+ * -> 30 TC request capture of the last samples
  */
 void GNSSFlowgraph::apply_action(unsigned int who, unsigned int what)
 {
@@ -1837,21 +3297,19 @@ void GNSSFlowgraph::apply_action(unsigned int who, unsigned int what)
     Gnss_Signal gs;
     if (who < 200)
         {
-            try
-                {
-                    sat = configuration_->property("Channel" + std::to_string(who) + ".satellite", 0);
-                }
-            catch (const std::exception& e)
-                {
-                    LOG(WARNING) << e.what();
-                }
+            sat = conf_.channel_satellite(who);
+        }
+    if (what <= 2 and who < channels_state_.size() and channels_state_[who] == 3)
+        {
+            DLOG(INFO) << "Ignoring event " << what << " of channel " << who << ", which is out of service";
+            return;
         }
     switch (what)
         {
         case 0:
             gs = channels_[who]->get_signal();
             DLOG(INFO) << "Channel " << who << " ACQ FAILED satellite " << gs.get_satellite() << ", Signal " << gs.get_signal_str();
-            channels_state_[who] = 0;
+            set_channel_state(who, 0);
             if (acq_channels_count_ > 0)
                 {
                     acq_channels_count_--;
@@ -1869,8 +3327,9 @@ void GNSSFlowgraph::apply_action(unsigned int who, unsigned int what)
             DLOG(INFO) << "Channel " << who << " ACQ SUCCESS satellite " << gs.get_satellite();
             // If the satellite is in the list of available ones, remove it.
             remove_signal(gs);
+            set_sky_search_busy(gs, true);
 
-            channels_state_[who] = 2;
+            set_channel_state(who, 2);
             if (acq_channels_count_ > 0)
                 {
                     acq_channels_count_--;
@@ -1882,25 +3341,59 @@ void GNSSFlowgraph::apply_action(unsigned int who, unsigned int what)
         case 2:
             gs = channels_[who]->get_signal();
             DLOG(INFO) << "Channel " << who << " TRK FAILED satellite " << gs.get_satellite();
+            set_sky_search_busy(gs, false);
+            if (capture_trigger_ != nullptr)
+                {
+                    // many channels losing the lock at once point to the front-end
+                    const auto now = std::chrono::steady_clock::now();
+                    lock_losses_.push_back(now);
+                    while (now - lock_losses_.front() > capture_lock_loss_window_)
+                        {
+                            lock_losses_.pop_front();
+                        }
+                    if (lock_losses_.size() >= capture_lock_loss_count_ and capture_trigger_->fire("lock_loss"))
+                        {
+                            lock_losses_.clear();
+                        }
+                }
             if (acq_channels_count_ < max_acq_channels_)
                 {
                     // try to acquire the same satellite
-                    channels_state_[who] = 1;
+                    set_channel_state(who, 1);
                     acq_channels_count_++;
                     DLOG(INFO) << "Channel " << who << " Starting acquisition " << gs.get_satellite() << ", Signal " << gs.get_signal_str();
                     channels_[who]->set_signal(channels_[who]->get_signal());
+                    if (conf_.assist_code_phase_acq)
+                        {
+                            // Reacquire the satellite around its last tracked code phase and Doppler
+                            Gnss_Synchro reference;
+                            double code_epoch_s = 0.0;
+                            double code_period_s = 0.0;
+                            if (find_tracking_reference(gs, gs.get_signal_str(), reference) and
+                                predict_code_epoch(gs.get_signal_str(), reference, code_epoch_s, code_period_s))
+                                {
+                                    channels_[who]->assist_acquisition_doppler(reference.Carrier_Doppler_hz);
+                                }
+                            else
+                                {
+                                    code_period_s = 0.0;
+                                }
+                            channels_[who]->assist_acquisition_code_phase(code_epoch_s, code_period_s);
+                        }
 
 #if ENABLE_FPGA
                     // create a task for the FPGA such that it doesn't stop the flow
-                    std::thread tmp_thread(&ChannelInterface::start_acquisition, channels_[who]);
-                    tmp_thread.detach();
+                    {
+                        const std::shared_ptr<ChannelInterface> channel = channels_[who];
+                        acquisition_thread_pool_->submit(channel.get(), gs.get_satellite().get_system_short()[0], gs.get_satellite().get_PRN(), [channel]() { channel->start_acquisition(); });
+                    }
 #else
                     channels_[who]->start_acquisition();
 #endif
                 }
             else
                 {
-                    channels_state_[who] = 0;
+                    set_channel_state(who, 0);
                     LOG(INFO) << "Channel " << who << " Idle state";
                     if (sat == 0)
                         {
@@ -1916,84 +3409,331 @@ void GNSSFlowgraph::apply_action(unsigned int who, unsigned int what)
                             // recover the satellite assigned
                             Gnss_Signal gs_assigned = channels_[n]->get_signal();
                             push_back_signal(gs_assigned);
+                            set_sky_search_busy(gs_assigned, false);
 
                             channels_[n]->stop_channel();  // stop the acquisition or tracking operation
-                            channels_state_[n] = 0;
+                            set_channel_state(static_cast<unsigned int>(n), 0);
                         }
                 }
             acq_channels_count_ = 0;  // all channels are in standby now and no new acquisition should be started
             break;
+        case 20:  // TC stop channel
+            if (who >= 400)
+                {
+                    take_channel_out_of_service(who - 400);
+                }
+            break;
+        case 21:  // TC start channel
+            if (who >= 400)
+                {
+                    return_channel_to_service(who - 400);
+                }
+            break;
+        case 30:  // TC request capture
+            if (!trigger_capture("telecommand"))
+                {
+                    LOG(INFO) << "TC request capture: no capture started";
+                }
+            break;
         default:
             break;
         }
 }
 
 
-void GNSSFlowgraph::priorize_satellites(const std::vector<std::pair<int, Gnss_Satellite>>& visible_satellites)
+void GNSSFlowgraph::take_channel_out_of_service(unsigned int channel)
 {
-    size_t old_size;
-    Gnss_Signal gs;
-    for (const auto& visible_satellite : visible_satellites)
+    if (channel >= channels_state_.size() or channels_state_[channel] == 3)
         {
-            if (visible_satellite.second.get_system() == "GPS")
+            return;
+        }
+    const unsigned int state = channels_state_[channel];
+    if (state == 1 or state == 2)
+        {
+            channels_[channel]->stop_channel();  // stop the acquisition or tracking operation
+            if (conf_.channel_satellite(channel) == 0)
                 {
-                    gs = Gnss_Signal(visible_satellite.second, "1C");
-                    old_size = available_GPS_1C_signals_.size();
-                    available_GPS_1C_signals_.remove(gs);
-                    if (old_size > available_GPS_1C_signals_.size())
-                        {
-                            available_GPS_1C_signals_.push_front(gs);
-                        }
+                    push_back_signal(channels_[channel]->get_signal());
+                }
+        }
+    set_channel_state(channel, 3);
+    LOG(INFO) << "Channel " << channel << " out of service";
+    if (state == 1)
+        {
+            if (acq_channels_count_ > 0)
+                {
+                    acq_channels_count_--;
+                }
+            // give the acquisition slot to another channel
+            acquisition_manager(channel);
+        }
+}
 
-                    gs = Gnss_Signal(visible_satellite.second, "2S");
-                    old_size = available_GPS_2S_signals_.size();
-                    available_GPS_2S_signals_.remove(gs);
-                    if (old_size > available_GPS_2S_signals_.size())
-                        {
-                            available_GPS_2S_signals_.push_front(gs);
-                        }
 
-                    gs = Gnss_Signal(visible_satellite.second, "L5");
-                    old_size = available_GPS_L5_signals_.size();
-                    available_GPS_L5_signals_.remove(gs);
-                    if (old_size > available_GPS_L5_signals_.size())
-                        {
-                            available_GPS_L5_signals_.push_front(gs);
-                        }
+void GNSSFlowgraph::return_channel_to_service(unsigned int channel)
+{
+    if (channel >= channels_state_.size() or channels_state_[channel] != 3)
+        {
+            return;
+        }
+    set_channel_state(channel, 0);
+    LOG(INFO) << "Channel " << channel << " in service";
+    // start with this channel, if there is an acquisition slot available
+    acquisition_manager(channel == 0 ? channels_count_ - 1 : channel - 1);
+}
+
+
+bool GNSSFlowgraph::reconfigure_channel(unsigned int channel_id, const std::shared_ptr<ConfigurationInterface>& configuration)
+{
+    std::lock_guard<std::mutex> lock(signal_list_mutex_);
+    if (!running_ or channel_id >= channels_.size() or enable_fpga_offloading_)
+        {
+            LOG(WARNING) << "Unable to reconfigure channel " << channel_id;
+            return false;
+        }
+    const int i = static_cast<int>(channel_id);
+    const std::shared_ptr<ChannelInterface> old_channel = channels_.at(i);
+    const Gnss_Signal gnss_signal = old_channel->get_signal();
+    const std::string signal_str = gnss_signal.get_signal_str();
+
+    // build the new blocks before touching the running flowgraph, so that a
+    // configuration error leaves the channel as it was
+    auto block_factory = std::make_unique<GNSSBlockFactory>();
+    std::shared_ptr<GNSSBlockInterface> new_block = block_factory->GetChannel(configuration.get(), signal_str, i, queue_.get());
+    const std::shared_ptr<ChannelInterface> new_channel = std::dynamic_pointer_cast<ChannelInterface>(new_block);
+    if (new_channel == nullptr)
+        {
+            LOG(ERROR) << "Unable to reconfigure channel " << channel_id << ": check the configuration of its blocks";
+            return false;
+        }
+
+    const bool in_service = channels_state_[i] != 3;
+    take_channel_out_of_service(channel_id);
+    acquisition_thread_pool_->cancel(old_channel.get());
+
+    // the other channels keep their state, the scheduler just pauses while
+    // the edges of this channel are replaced
+    top_block_->lock();
+    bool success = true;
+    try
+        {
+            if (has_pvt_to_trk_port(old_channel))
+                {
+                    top_block_->msg_disconnect(pvt_->get_left_block(), pmt::mp("pvt_to_trk"), old_channel->get_left_block_trk(), pmt::mp("pvt_to_trk"));
                 }
-            else if (visible_satellite.second.get_system() == "Galileo")
+            if (enable_navdata_monitor_)
                 {
-                    gs = Gnss_Signal(visible_satellite.second, "1B");
-                    old_size = available_GAL_1B_signals_.size();
-                    available_GAL_1B_signals_.remove(gs);
-                    if (old_size > available_GAL_1B_signals_.size())
-                        {
-                            available_GAL_1B_signals_.push_front(gs);
-                        }
+                    top_block_->msg_disconnect(old_channel->get_right_block(), pmt::mp("Nav_msg_from_TLM"), NavDataMonitor_, pmt::mp("Nav_msg_from_TLM"));
+                }
+            if (enable_e6_has_rx_ and signal_str == "E6")
+                {
+                    top_block_->msg_disconnect(old_channel->get_right_block(), pmt::mp("E6_HAS_from_TLM"), gal_e6_has_rx_, pmt::mp("E6_HAS_from_TLM"));
+                }
+            old_channel->disconnect(top_block_);
+            // remove the edges from the signal conditioner (or the acquisition
+            // resampler) and to the observables and the monitors
+            top_block_->disconnect(old_channel->get_left_block_acq());
+            top_block_->disconnect(old_channel->get_left_block_trk());
+            top_block_->disconnect(old_channel->get_right_block_acq());
+            top_block_->disconnect(old_channel->get_right_block_trk());
+            top_block_->disconnect(old_channel->get_right_block());
+
+            channels_.at(i) = new_channel;
+            if (conf_.channel_satellite(i) != 0)
+                {
+                    new_channel->set_signal(gnss_signal);
+                }
+            new_channel->connect(top_block_);
+            if (connect_signal_conditioner_to_channel(i) != 0)
+                {
+                    throw std::runtime_error("cannot connect the signal conditioner");
+                }
+            top_block_->connect(new_channel->get_right_block(), 0, observables_->get_left_block(), i);
+            if (has_pvt_to_trk_port(new_channel))
+                {
+                    top_block_->msg_connect(pvt_->get_left_block(), pmt::mp("pvt_to_trk"), new_channel->get_left_block_trk(), pmt::mp("pvt_to_trk"));
+                }
+            if (enable_acquisition_monitor_)
+                {
+                    top_block_->connect(new_channel->get_right_block_acq(), 0, GnssSynchroAcquisitionMonitor_, i);
+                }
+            if (enable_tracking_monitor_)
+                {
+                    top_block_->connect(new_channel->get_right_block_trk(), 0, GnssSynchroTrackingMonitor_, i);
+                }
+            if (enable_navdata_monitor_)
+                {
+                    top_block_->msg_connect(new_channel->get_right_block(), pmt::mp("Nav_msg_from_TLM"), NavDataMonitor_, pmt::mp("Nav_msg_from_TLM"));
+                }
+            if (enable_e6_has_rx_ and signal_str == "E6")
+                {
+                    top_block_->msg_connect(new_channel->get_right_block(), pmt::mp("E6_HAS_from_TLM"), gal_e6_has_rx_, pmt::mp("E6_HAS_from_TLM"));
+                }
+        }
+    catch (const std::exception& e)
+        {
+            LOG(ERROR) << "Unable to reconfigure channel " << channel_id << ": " << e.what();
+            success = false;
+        }
+    top_block_->unlock();
 
-                    gs = Gnss_Signal(visible_satellite.second, "5X");
-                    old_size = available_GAL_5X_signals_.size();
-                    available_GAL_5X_signals_.remove(gs);
-                    if (old_size > available_GAL_5X_signals_.size())
-                        {
-                            available_GAL_5X_signals_.push_front(gs);
-                        }
+    if (success)
+        {
+            LOG(INFO) << "Channel " << channel_id << " reconfigured with " << new_channel->implementation();
+            if (in_service)
+                {
+                    return_channel_to_service(channel_id);
+                }
+        }
+    return success;
+}
 
-                    gs = Gnss_Signal(visible_satellite.second, "7X");
-                    old_size = available_GAL_7X_signals_.size();
-                    available_GAL_7X_signals_.remove(gs);
-                    if (old_size > available_GAL_7X_signals_.size())
+
+void GNSSFlowgraph::get_receiver_snapshot(Gnss_Receiver_Snapshot& snapshot)
+{
+    snapshot.channels.clear();
+    if (channels_status_ != nullptr)
+        {
+            const std::map<int, std::shared_ptr<Gnss_Synchro>> current_status = channels_status_->get_current_status_map();
+            for (const auto& status : current_status)
+                {
+                    if (status.first < 0 or status.first >= channels_count_)
                         {
-                            available_GAL_7X_signals_.push_front(gs);
+                            continue;
                         }
+                    Gnss_Channel_Snapshot channel;
+                    channel.System = channels_.at(status.first)->get_signal().get_satellite().get_system();
+                    channel.Signal = std::string(status.second->Signal);
+                    channel.PRN = status.second->PRN;
+                    channel.Carrier_Doppler_hz = status.second->Carrier_Doppler_hz;
+                    channel.CN0_dB_hz = status.second->CN0_dB_hz;
+                    snapshot.channels.push_back(channel);
+                }
+        }
+    const std::shared_ptr<PvtInterface> pvt = get_pvt();
+    if (pvt != nullptr)
+        {
+            pvt->get_receiver_snapshot(snapshot);
+        }
+}
+
+
+void GNSSFlowgraph::set_doppler_hints(const std::vector<Gnss_Channel_Snapshot>& channels)
+{
+    std::lock_guard<std::mutex> lock(signal_list_mutex_);
+    doppler_hints_.clear();
+    for (const auto& channel : channels)
+        {
+            doppler_hints_[std::make_pair(channel.Signal, channel.PRN)] = static_cast<float>(channel.Carrier_Doppler_hz);
+        }
+}
 
-                    gs = Gnss_Signal(visible_satellite.second, "E6");
-                    old_size = available_GAL_E6_signals_.size();
-                    available_GAL_E6_signals_.remove(gs);
-                    if (old_size > available_GAL_E6_signals_.size())
+
+bool GNSSFlowgraph::get_receiver_checkpoint(Gnss_Receiver_Checkpoint& checkpoint, uint64_t sample_offset)
+{
+    checkpoint.channels.clear();
+    checkpoint.fs = 0;
+    if (channels_status_ != nullptr)
+        {
+            const std::map<int, std::shared_ptr<Gnss_Synchro>> current_status = channels_status_->get_current_status_map();
+            for (const auto& status : current_status)
+                {
+                    // a single sample counter for all the channels
+                    if (status.first < 0 or status.first >= channels_count_ or status.second->fs <= 0 or
+                        (checkpoint.fs != 0 and status.second->fs != checkpoint.fs))
                         {
-                            available_GAL_E6_signals_.push_front(gs);
+                            continue;
                         }
+                    Gnss_Channel_Checkpoint channel;
+                    channel.System = channels_.at(status.first)->get_signal().get_satellite().get_system();
+                    channel.Signal = std::string(status.second->Signal);
+                    channel.PRN = status.second->PRN;
+                    // Tracking reports the sample counter at the start of a prompt code period
+                    channel.code_epoch_samples = sample_offset + status.second->Tracking_sample_counter;
+                    channel.Carrier_Doppler_hz = status.second->Carrier_Doppler_hz;
+                    channel.CN0_dB_hz = status.second->CN0_dB_hz;
+                    checkpoint.fs = status.second->fs;
+                    checkpoint.channels.push_back(channel);
+                }
+        }
+    if (checkpoint.channels.empty())
+        {
+            return false;
+        }
+    checkpoint.sample_stamp = std::min_element(checkpoint.channels.cbegin(), checkpoint.channels.cend(),
+        [](const Gnss_Channel_Checkpoint& a, const Gnss_Channel_Checkpoint& b) { return a.code_epoch_samples < b.code_epoch_samples; })
+                                  ->code_epoch_samples;
+    get_receiver_snapshot(checkpoint.state);
+    return true;
+}
+
+
+void GNSSFlowgraph::set_tracking_hints(const std::vector<Gnss_Channel_Checkpoint>& channels, uint64_t sample_offset)
+{
+    std::lock_guard<std::mutex> lock(signal_list_mutex_);
+    tracking_hints_.clear();
+    for (const auto& channel : channels)
+        {
+            if (channel.code_epoch_samples >= sample_offset)
+                {
+                    tracking_hints_[std::make_pair(channel.Signal, channel.PRN)] = std::make_pair(channel.code_epoch_samples - sample_offset, channel.Carrier_Doppler_hz);
+                }
+        }
+}
+
+
+float GNSSFlowgraph::take_doppler_hint(const Gnss_Signal& gnss_signal)
+{
+    const auto hint = doppler_hints_.find(std::make_pair(gnss_signal.get_signal_str(), gnss_signal.get_satellite().get_PRN()));
+    if (hint != doppler_hints_.end())
+        {
+            const float doppler_hz = hint->second;
+            doppler_hints_.erase(hint);
+            return doppler_hz;
+        }
+    // otherwise, the Doppler predicted from the ephemerides, if any
+    Gnss_Sky_Satellite predicted;
+    if (sky_prediction_->predict(gnss_signal.get_satellite().get_system_short()[0], gnss_signal.get_satellite().get_PRN(), predicted))
+        {
+            return static_cast<float>(project_doppler(gnss_signal.get_signal_str(), predicted.doppler_hz));
+        }
+    return 0.0;
+}
+
+
+void GNSSFlowgraph::priorize_satellites(const std::vector<std::pair<int, Gnss_Satellite>>& visible_satellites)
+{
+    // Searches for visible satellites go first in the acquisition thread pool,
+    // in the same order as in visible_satellites
+    std::lock_guard<std::mutex> lock(signal_list_mutex_);
+    acquisition_thread_pool_->clear_priorities();
+    satellite_elevations_.clear();
+    for (const auto& visible_satellite : visible_satellites)
+        {
+            satellite_elevations_[std::make_pair(visible_satellite.second.get_system_short()[0], visible_satellite.second.get_PRN())] = visible_satellite.first;
+        }
+    auto priority = static_cast<int32_t>(visible_satellites.size());
+    for (const auto& visible_satellite : visible_satellites)
+        {
+            acquisition_thread_pool_->set_priority(visible_satellite.second.get_system_short()[0], visible_satellite.second.get_PRN(), priority--);
+        }
+    // and they are also the next candidates of the channels, in the same
+    // order, so they are moved to the front starting from the last one
+    for (auto visible_satellite = visible_satellites.crbegin(); visible_satellite != visible_satellites.crend(); ++visible_satellite)
+        {
+            const Gnss_Satellite& sat = visible_satellite->second;
+            if (sat.get_system() == "GPS")
+                {
+                    available_GPS_1C_signals_.move_to_front(Gnss_Signal(sat, "1C"));
+                    available_GPS_2S_signals_.move_to_front(Gnss_Signal(sat, "2S"));
+                    available_GPS_L5_signals_.move_to_front(Gnss_Signal(sat, "L5"));
+                }
+            else if (sat.get_system() == "Galileo")
+                {
+                    available_GAL_1B_signals_.move_to_front(Gnss_Signal(sat, "1B"));
+                    available_GAL_5X_signals_.move_to_front(Gnss_Signal(sat, "5X"));
+                    available_GAL_7X_signals_.move_to_front(Gnss_Signal(sat, "7X"));
+                    available_GAL_E6_signals_.move_to_front(Gnss_Signal(sat, "E6"));
                 }
         }
 }
@@ -2011,6 +3751,7 @@ void GNSSFlowgraph::set_configuration(const std::shared_ptr<ConfigurationInterfa
             LOG(WARNING) << "Unable to update configuration while flowgraph connected";
         }
     configuration_ = configuration;
+    conf_.SetFromConfiguration(configuration_.get(), channels_count_, multiband_);
 }
 
 
@@ -2061,6 +3802,49 @@ std::vector<std::string> GNSSFlowgraph::split_string(const std::string& s, char
 }
 
 
+std::vector<int> GNSSFlowgraph::parse_cpu_list(const std::string& cpu_list)
+{
+    // comma-separated CPUs and ranges of CPUs, as in "0-3,8,10-11"
+    std::vector<int> cpus;
+    for (const auto& item : split_string(cpu_list, ','))
+        {
+            try
+                {
+                    const size_t dash = item.find('-');
+                    const int first = std::stoi(item.substr(0, dash));
+                    const int last = dash == std::string::npos ? first : std::stoi(item.substr(dash + 1));
+                    for (int cpu = first; cpu <= last; cpu++)
+                        {
+                            cpus.push_back(cpu);
+                        }
+                }
+            catch (const std::exception&)
+                {
+                    LOG(WARNING) << "Wrong list of CPUs " << cpu_list;
+                    return {};
+                }
+        }
+    return cpus;
+}
+
+
+std::vector<std::vector<int>> GNSSFlowgraph::get_numa_nodes_cpus()
+{
+    std::vector<std::vector<int>> nodes_cpus;
+    for (int node = 0;; node++)
+        {
+            std::ifstream cpulist("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+            std::string cpus;
+            if (!cpulist.is_open() or !std::getline(cpulist, cpus))
+                {
+                    break;
+                }
+            nodes_cpus.push_back(parse_cpu_list(cpus));
+        }
+    return nodes_cpus;
+}
+
+
 void GNSSFlowgraph::set_signals_list()
 {
     // Set a sequential list of GNSS satellites
@@ -2292,9 +4076,9 @@ void GNSSFlowgraph::set_signals_list()
                  available_gnss_prn_iter != available_gps_prn.cend();
                  available_gnss_prn_iter++)
                 {
-                    available_GPS_1C_signals_.emplace_back(
+                    available_GPS_1C_signals_.push_back(Gnss_Signal(
                         Gnss_Satellite(std::string("GPS"), *available_gnss_prn_iter),
-                        std::string("1C"));
+                        std::string("1C")));
                 }
         }
 
@@ -2305,9 +4089,9 @@ void GNSSFlowgraph::set_signals_list()
                  available_gnss_prn_iter != available_gps_prn.cend();
                  available_gnss_prn_iter++)
                 {
-                    available_GPS_2S_signals_.emplace_back(
+                    available_GPS_2S_signals_.push_back(Gnss_Signal(
                         Gnss_Satellite(std::string("GPS"), *available_gnss_prn_iter),
-                        std::string("2S"));
+                        std::string("2S")));
                 }
         }
 
@@ -2318,9 +4102,9 @@ void GNSSFlowgraph::set_signals_list()
                  available_gnss_prn_iter != available_gps_prn.cend();
                  available_gnss_prn_iter++)
                 {
-                    available_GPS_L5_signals_.emplace_back(
+                    available_GPS_L5_signals_.push_back(Gnss_Signal(
                         Gnss_Satellite(std::string("GPS"), *available_gnss_prn_iter),
-                        std::string("L5"));
+                        std::string("L5")));
                 }
         }
 
@@ -2331,9 +4115,9 @@ void GNSSFlowgraph::set_signals_list()
                  available_gnss_prn_iter != available_sbas_prn.cend();
                  available_gnss_prn_iter++)
                 {
-                    available_SBAS_1C_signals_.emplace_back(
+                    available_SBAS_1C_signals_.push_back(Gnss_Signal(
                         Gnss_Satellite(std::string("SBAS"), *available_gnss_prn_iter),
-                        std::string("1C"));
+                        std::string("1C")));
                 }
         }
 
@@ -2344,9 +4128,9 @@ void GNSSFlowgraph::set_signals_list()
                  available_gnss_prn_iter != available_galileo_prn.cend();
                  available_gnss_prn_iter++)
                 {
-                    available_GAL_1B_signals_.emplace_back(
+                    available_GAL_1B_signals_.push_back(Gnss_Signal(
                         Gnss_Satellite(std::string("Galileo"), *available_gnss_prn_iter),
-                        std::string("1B"));
+                        std::string("1B")));
                 }
         }
 
@@ -2357,9 +4141,9 @@ void GNSSFlowgraph::set_signals_list()
                  available_gnss_prn_iter != available_galileo_prn.cend();
                  available_gnss_prn_iter++)
                 {
-                    available_GAL_5X_signals_.emplace_back(
+                    available_GAL_5X_signals_.push_back(Gnss_Signal(
                         Gnss_Satellite(std::string("Galileo"), *available_gnss_prn_iter),
-                        std::string("5X"));
+                        std::string("5X")));
                 }
         }
 
@@ -2370,9 +4154,9 @@ void GNSSFlowgraph::set_signals_list()
                  available_gnss_prn_iter != available_galileo_prn.cend();
                  available_gnss_prn_iter++)
                 {
-                    available_GAL_7X_signals_.emplace_back(
+                    available_GAL_7X_signals_.push_back(Gnss_Signal(
                         Gnss_Satellite(std::string("Galileo"), *available_gnss_prn_iter),
-                        std::string("7X"));
+                        std::string("7X")));
                 }
         }
 
@@ -2383,9 +4167,9 @@ void GNSSFlowgraph::set_signals_list()
                  available_gnss_prn_iter != available_galileo_prn.cend();
                  available_gnss_prn_iter++)
                 {
-                    available_GAL_E6_signals_.emplace_back(
+                    available_GAL_E6_signals_.push_back(Gnss_Signal(
                         Gnss_Satellite(std::string("Galileo"), *available_gnss_prn_iter),
-                        std::string("E6"));
+                        std::string("E6")));
                 }
         }
 
@@ -2396,9 +4180,9 @@ void GNSSFlowgraph::set_signals_list()
                  available_gnss_prn_iter != available_glonass_prn.cend();
                  available_gnss_prn_iter++)
                 {
-                    available_GLO_1G_signals_.emplace_back(
+                    available_GLO_1G_signals_.push_back(Gnss_Signal(
                         Gnss_Satellite(std::string("Glonass"), *available_gnss_prn_iter),
-                        std::string("1G"));
+                        std::string("1G")));
                 }
         }
 
@@ -2409,9 +4193,9 @@ void GNSSFlowgraph::set_signals_list()
                  available_gnss_prn_iter != available_glonass_prn.cend();
                  available_gnss_prn_iter++)
                 {
-                    available_GLO_2G_signals_.emplace_back(
+                    available_GLO_2G_signals_.push_back(Gnss_Signal(
                         Gnss_Satellite(std::string("Glonass"), *available_gnss_prn_iter),
-                        std::string("2G"));
+                        std::string("2G")));
                 }
         }
 
@@ -2422,9 +4206,9 @@ void GNSSFlowgraph::set_signals_list()
                  available_gnss_prn_iter != available_beidou_prn.cend();
                  available_gnss_prn_iter++)
                 {
-                    available_BDS_B1_signals_.emplace_back(
+                    available_BDS_B1_signals_.push_back(Gnss_Signal(
                         Gnss_Satellite(std::string("Beidou"), *available_gnss_prn_iter),
-                        std::string("B1"));
+                        std::string("B1")));
                 }
         }
 
@@ -2435,9 +4219,9 @@ void GNSSFlowgraph::set_signals_list()
                  available_gnss_prn_iter != available_beidou_prn.cend();
                  available_gnss_prn_iter++)
                 {
-                    available_BDS_B3_signals_.emplace_back(
+                    available_BDS_B3_signals_.push_back(Gnss_Signal(
                         Gnss_Satellite(std::string("Beidou"), *available_gnss_prn_iter),
-                        std::string("B3"));
+                        std::string("B3")));
                 }
         }
 }
@@ -2452,24 +4236,58 @@ void GNSSFlowgraph::set_channels_state()
             max_acq_channels_ = channels_count_;
             LOG(WARNING) << "Channels_in_acquisition is bigger than number of channels. Variable acq_channels_count_ is set to " << channels_count_;
         }
+    configured_max_acq_channels_ = max_acq_channels_;
     channels_state_.reserve(channels_count_);
+    idle_channels_.clear();
+    // The channels of each signal beyond Channels_XX.in_service are created
+    // and connected, but kept out of service until a telecommand starts them
+    std::map<std::string, int> channels_in_service;
+    int channels_in_acquisition = 0;
     for (int i = 0; i < channels_count_; i++)
         {
-            if (i < max_acq_channels_)
+            const std::string signal = channels_.at(i)->get_signal().get_signal_str();
+            auto in_service = channels_in_service.find(signal);
+            if (in_service == channels_in_service.end())
+                {
+                    in_service = channels_in_service.emplace(signal, configuration_->property("Channels_" + signal + ".in_service", channels_count_)).first;
+                }
+            if (in_service->second <= 0)
+                {
+                    channels_state_.push_back(3);
+                }
+            else if (channels_in_acquisition < max_acq_channels_)
                 {
+                    in_service->second--;
                     channels_state_.push_back(1);
+                    channels_in_acquisition++;
                 }
             else
                 {
+                    in_service->second--;
                     channels_state_.push_back(0);
+                    idle_channels_.insert(i);
                 }
             DLOG(INFO) << "Channel " << i << " in state " << channels_state_[i];
         }
-    acq_channels_count_ = max_acq_channels_;
+    acq_channels_count_ = channels_in_acquisition;
     DLOG(INFO) << acq_channels_count_ << " channels in acquisition state";
 }
 
 
+void GNSSFlowgraph::set_channel_state(unsigned int channel, unsigned int state)
+{
+    channels_state_[channel] = state;
+    if (state == 0)
+        {
+            idle_channels_.insert(channel);
+        }
+    else
+        {
+            idle_channels_.erase(channel);
+        }
+}
+
+
 bool GNSSFlowgraph::is_multiband() const
 {
     bool multiband = false;
@@ -2526,248 +4344,155 @@ Gnss_Signal GNSSFlowgraph::search_next_signal(const std::string& searched_signal
     is_primary_frequency = false;
     assistance_available = false;
     Gnss_Signal result{};
-    bool found_signal = false;
     switch (mapStringValues_[searched_signal])
         {
         case evGPS_1C:
             // todo: assist the satellite selection with almanac and current PVT here (reuse priorize_satellite function used in control_thread)
-            result = available_GPS_1C_signals_.front();
-            available_GPS_1C_signals_.pop_front();
-            available_GPS_1C_signals_.push_back(result);
+            if (!take_sky_candidate(available_GPS_1C_signals_, "1C", result))
+                {
+                    result = available_GPS_1C_signals_.next();
+                }
             is_primary_frequency = true;  // indicate that the searched satellite signal belongs to "primary" link (L1, E1, B1, etc..)
             break;
 
         case evGPS_2S:
-            if (configuration_->property("Channels_1C.count", 0) > 0)
-                {
-                    // 1. Get the current channel status map
-                    std::map<int, std::shared_ptr<Gnss_Synchro>> current_channels_status = channels_status_->get_current_status_map();
-                    // 2. search the currently tracked GPS L1 satellites and assist the GPS L2 acquisition if the satellite is not tracked on L2
-                    for (auto& current_status : current_channels_status)
-                        {
-                            if (std::string(current_status.second->Signal) == "1C")
-                                {
-                                    std::list<Gnss_Signal>::iterator it2;
-                                    it2 = std::find_if(std::begin(available_GPS_2S_signals_), std::end(available_GPS_2S_signals_),
-                                        [&](Gnss_Signal const& sig) { return sig.get_satellite().get_PRN() == current_status.second->PRN; });
-
-                                    if (it2 != available_GPS_2S_signals_.end())
-                                        {
-                                            estimated_doppler = static_cast<float>(current_status.second->Carrier_Doppler_hz);
-                                            RX_time = current_status.second->RX_time;
-                                            // 3. return the GPS L2 satellite and remove it from list
-                                            result = *it2;
-                                            available_GPS_2S_signals_.erase(it2);
-                                            found_signal = true;
-                                            assistance_available = true;
-                                            break;
-                                        }
-                                }
-                        }
-                }
-            // fallback: pick the front satellite because there is no tracked satellites in L1 to assist L2
-            if (found_signal == false)
+            // assist the GPS L2 acquisition with a satellite tracked in GPS L1, if any
+            assistance_available = conf_.channels_1C > 0 and take_assisted_signal(available_GPS_2S_signals_, "1C", result, estimated_doppler, RX_time);
+            if (!assistance_available)
                 {
-                    result = available_GPS_2S_signals_.front();
-                    available_GPS_2S_signals_.pop_front();
-                    available_GPS_2S_signals_.push_back(result);
+                    result = available_GPS_2S_signals_.next();
                 }
             break;
 
         case evGPS_L5:
-            if (configuration_->property("Channels_1C.count", 0) > 0)
-                {
-                    // 1. Get the current channel status map
-                    std::map<int, std::shared_ptr<Gnss_Synchro>> current_channels_status = channels_status_->get_current_status_map();
-                    // 2. search the currently tracked GPS L1 satellites and assist the GPS L5 acquisition if the satellite is not tracked on L5
-                    for (auto& current_status : current_channels_status)
-                        {
-                            if (std::string(current_status.second->Signal) == "1C")
-                                {
-                                    std::list<Gnss_Signal>::iterator it2;
-                                    it2 = std::find_if(std::begin(available_GPS_L5_signals_), std::end(available_GPS_L5_signals_),
-                                        [&](Gnss_Signal const& sig) { return sig.get_satellite().get_PRN() == current_status.second->PRN; });
-
-                                    if (it2 != available_GPS_L5_signals_.end())
-                                        {
-                                            estimated_doppler = static_cast<float>(current_status.second->Carrier_Doppler_hz);
-                                            RX_time = current_status.second->RX_time;
-                                            // std::cout << " Channel: " << it->first << " => Doppler: " << estimated_doppler << "[Hz] \n";
-                                            // 3. return the GPS L5 satellite and remove it from list
-                                            result = *it2;
-                                            available_GPS_L5_signals_.erase(it2);
-                                            found_signal = true;
-                                            assistance_available = true;
-                                            break;
-                                        }
-                                }
-                        }
-                }
-            // fallback: pick the front satellite because there is no tracked satellites in L1 to assist L5
-            if (found_signal == false)
+            // assist the GPS L5 acquisition with a satellite tracked in GPS L1, if any
+            assistance_available = conf_.channels_1C > 0 and take_assisted_signal(available_GPS_L5_signals_, "1C", result, estimated_doppler, RX_time);
+            if (!assistance_available)
                 {
-                    result = available_GPS_L5_signals_.front();
-                    available_GPS_L5_signals_.pop_front();
-                    available_GPS_L5_signals_.push_back(result);
+                    result = available_GPS_L5_signals_.next();
                 }
             break;
 
         case evGAL_1B:
-            result = available_GAL_1B_signals_.front();
-            available_GAL_1B_signals_.pop_front();
-            available_GAL_1B_signals_.push_back(result);
+            if (!take_sky_candidate(available_GAL_1B_signals_, "1B", result))
+                {
+                    result = available_GAL_1B_signals_.next();
+                }
             is_primary_frequency = true;  // indicate that the searched satellite signal belongs to "primary" link (L1, E1, B1, etc..)
             break;
 
         case evGAL_5X:
-            if (configuration_->property("Channels_1B.count", 0) > 0)
-                {
-                    // 1. Get the current channel status map
-                    std::map<int, std::shared_ptr<Gnss_Synchro>> current_channels_status = channels_status_->get_current_status_map();
-                    // 2. search the currently tracked Galileo E1 satellites and assist the Galileo E5 acquisition if the satellite is not tracked on E5
-                    for (auto& current_status : current_channels_status)
-                        {
-                            if (std::string(current_status.second->Signal) == "1B")
-                                {
-                                    std::list<Gnss_Signal>::iterator it2;
-                                    it2 = std::find_if(std::begin(available_GAL_5X_signals_), std::end(available_GAL_5X_signals_),
-                                        [&](Gnss_Signal const& sig) { return sig.get_satellite().get_PRN() == current_status.second->PRN; });
-
-                                    if (it2 != available_GAL_5X_signals_.end())
-                                        {
-                                            estimated_doppler = static_cast<float>(current_status.second->Carrier_Doppler_hz);
-                                            RX_time = current_status.second->RX_time;
-                                            // std::cout << " Channel: " << it->first << " => Doppler: " << estimated_doppler << "[Hz] \n";
-                                            // 3. return the Gal 5X satellite and remove it from list
-                                            result = *it2;
-                                            available_GAL_5X_signals_.erase(it2);
-                                            found_signal = true;
-                                            assistance_available = true;
-                                            break;
-                                        }
-                                }
-                        }
-                }
-            // fallback: pick the front satellite because there is no tracked satellites in E1 to assist E5
-            if (found_signal == false)
+            // assist the Galileo E5a acquisition with a satellite tracked in Galileo E1, if any
+            assistance_available = conf_.channels_1B > 0 and take_assisted_signal(available_GAL_5X_signals_, "1B", result, estimated_doppler, RX_time);
+            if (!assistance_available)
                 {
-                    result = available_GAL_5X_signals_.front();
-                    available_GAL_5X_signals_.pop_front();
-                    available_GAL_5X_signals_.push_back(result);
+                    result = available_GAL_5X_signals_.next();
                 }
             break;
 
         case evGAL_7X:
-            if (configuration_->property("Channels_1B.count", 0) > 0)
-                {
-                    // 1. Get the current channel status map
-                    std::map<int, std::shared_ptr<Gnss_Synchro>> current_channels_status = channels_status_->get_current_status_map();
-                    // 2. search the currently tracked Galileo E1 satellites and assist the Galileo E5 acquisition if the satellite is not tracked on E5
-                    for (auto& current_status : current_channels_status)
-                        {
-                            if (std::string(current_status.second->Signal) == "1B")
-                                {
-                                    std::list<Gnss_Signal>::iterator it2;
-                                    it2 = std::find_if(std::begin(available_GAL_7X_signals_), std::end(available_GAL_7X_signals_),
-                                        [&](Gnss_Signal const& sig) { return sig.get_satellite().get_PRN() == current_status.second->PRN; });
-
-                                    if (it2 != available_GAL_7X_signals_.end())
-                                        {
-                                            estimated_doppler = static_cast<float>(current_status.second->Carrier_Doppler_hz);
-                                            RX_time = current_status.second->RX_time;
-                                            // std::cout << " Channel: " << it->first << " => Doppler: " << estimated_doppler << "[Hz] \n";
-                                            // 3. return the Gal 7X satellite and remove it from list
-                                            result = *it2;
-                                            available_GAL_7X_signals_.erase(it2);
-                                            found_signal = true;
-                                            assistance_available = true;
-                                            break;
-                                        }
-                                }
-                        }
-                }
-            // fallback: pick the front satellite because there is no tracked satellites in E1 to assist E5
-            if (found_signal == false)
+            // assist the Galileo E5b acquisition with a satellite tracked in Galileo E1, if any
+            assistance_available = conf_.channels_1B > 0 and take_assisted_signal(available_GAL_7X_signals_, "1B", result, estimated_doppler, RX_time);
+            if (!assistance_available)
                 {
-                    result = available_GAL_7X_signals_.front();
-                    available_GAL_7X_signals_.pop_front();
-                    available_GAL_7X_signals_.push_back(result);
+                    result = available_GAL_7X_signals_.next();
                 }
             break;
 
         case evGAL_E6:
-            if (configuration_->property("Channels_1B.count", 0) > 0)
+            // assist the Galileo E6 acquisition with a satellite tracked in Galileo E1, if any
+            assistance_available = conf_.channels_1B > 0 and take_assisted_signal(available_GAL_E6_signals_, "1B", result, estimated_doppler, RX_time);
+            if (!assistance_available)
                 {
-                    // 1. Get the current channel status map
-                    std::map<int, std::shared_ptr<Gnss_Synchro>> current_channels_status = channels_status_->get_current_status_map();
-                    // 2. search the currently tracked Galileo E1 satellites and assist the Galileo E5 acquisition if the satellite is not tracked on E5
-                    for (auto& current_status : current_channels_status)
-                        {
-                            if (std::string(current_status.second->Signal) == "1B")
-                                {
-                                    std::list<Gnss_Signal>::iterator it2;
-                                    it2 = std::find_if(std::begin(available_GAL_E6_signals_), std::end(available_GAL_E6_signals_),
-                                        [&](Gnss_Signal const& sig) { return sig.get_satellite().get_PRN() == current_status.second->PRN; });
-
-                                    if (it2 != available_GAL_E6_signals_.end())
-                                        {
-                                            estimated_doppler = static_cast<float>(current_status.second->Carrier_Doppler_hz);
-                                            RX_time = current_status.second->RX_time;
-                                            // std::cout << " Channel: " << it->first << " => Doppler: " << estimated_doppler << "[Hz] \n";
-                                            // 3. return the Gal E6 satellite and remove it from list
-                                            result = *it2;
-                                            available_GAL_E6_signals_.erase(it2);
-                                            found_signal = true;
-                                            assistance_available = true;
-                                            break;
-                                        }
-                                }
-                        }
-                }
-            // fallback: pick the front satellite because there is no tracked satellites in E1 to assist E6
-            if (found_signal == false)
-                {
-                    result = available_GAL_E6_signals_.front();
-                    available_GAL_E6_signals_.pop_front();
-                    available_GAL_E6_signals_.push_back(result);
+                    result = available_GAL_E6_signals_.next();
                 }
             break;
 
         case evGLO_1G:
-            result = available_GLO_1G_signals_.front();
-            available_GLO_1G_signals_.pop_front();
-            available_GLO_1G_signals_.push_back(result);
+            result = available_GLO_1G_signals_.next();
             is_primary_frequency = true;  // indicate that the searched satellite signal belongs to "primary" link (L1, E1, B1, etc..)
             break;
 
         case evGLO_2G:
-            result = available_GLO_2G_signals_.front();
-            available_GLO_2G_signals_.pop_front();
-            available_GLO_2G_signals_.push_back(result);
+            result = available_GLO_2G_signals_.next();
             break;
 
         case evBDS_B1:
-            result = available_BDS_B1_signals_.front();
-            available_BDS_B1_signals_.pop_front();
-            available_BDS_B1_signals_.push_back(result);
+            result = available_BDS_B1_signals_.next();
             is_primary_frequency = true;  // indicate that the searched satellite signal belongs to "primary" link (L1, E1, B1, etc..)
             break;
 
         case evBDS_B3:
-            result = available_BDS_B3_signals_.front();
-            available_BDS_B3_signals_.pop_front();
-            available_BDS_B3_signals_.push_back(result);
+            result = available_BDS_B3_signals_.next();
             break;
 
         default:
             LOG(ERROR) << "This should not happen :-(";
             if (!available_GPS_1C_signals_.empty())
                 {
-                    result = available_GPS_1C_signals_.front();
-                    available_GPS_1C_signals_.pop_front();
-                    available_GPS_1C_signals_.push_back(result);
+                    result = available_GPS_1C_signals_.next();
                 }
             break;
         }
     return result;
 }
+
+
+/*
+ * Takes the first satellite of candidates found by the sky search of signal,
+ * moving it to the back of the queue as next() does, and leaves its code
+ * epoch and Doppler to resume_tracking(), so that the channel starts tracking
+ * it without an acquisition.
+ */
+bool GNSSFlowgraph::take_sky_candidate(Gnss_Signal_Queue& candidates, const std::string& signal, Gnss_Signal& result)
+{
+    const auto search = sky_searches_.find(signal);
+    if (search == sky_searches_.end())
+        {
+            return false;
+        }
+    Acq_Sky_Candidate candidate;
+    if (!candidates.take_first_if([&](const Gnss_Signal& sig) { return search->second->take_candidate(sig.get_satellite().get_PRN(), candidate); }, result))
+        {
+            return false;
+        }
+    candidates.push_back(result);
+    tracking_hints_[std::make_pair(signal, result.get_satellite().get_PRN())] = std::make_pair(candidate.code_epoch_samples, candidate.doppler_hz);
+    DLOG(INFO) << "Sky search candidate " << result.get_satellite() << ", Signal " << signal << ", Doppler " << candidate.doppler_hz << " Hz";
+    return true;
+}
+
+
+// the satellites tracked are not searched by the sky search of their signal
+void GNSSFlowgraph::set_sky_search_busy(const Gnss_Signal& gs, bool busy)
+{
+    const auto search = sky_searches_.find(gs.get_signal_str());
+    if (search != sky_searches_.end())
+        {
+            search->second->set_busy(gs.get_satellite().get_PRN(), busy);
+        }
+}
+
+
+bool GNSSFlowgraph::take_assisted_signal(Gnss_Signal_Queue& candidates,
+    const std::string& primary_signal,
+    Gnss_Signal& result,
+    float& estimated_doppler,
+    double& RX_time)
+{
+    // The candidates are visited in queue order, and looked up by PRN among
+    // the signals with valid telemetry, so the cost does not depend on the
+    // number of channels
+    Gnss_Synchro reference{};
+    const bool found = candidates.take_first_if([&](const Gnss_Signal& sig) {
+        const Gnss_Satellite sat = sig.get_satellite();
+        return channels_status_->get_signal_status(sat.get_system_short()[0], primary_signal, sat.get_PRN(), reference);
+    },
+        result);
+    if (found)
+        {
+            estimated_doppler = static_cast<float>(reference.Carrier_Doppler_hz);
+            RX_time = reference.RX_time;
+        }
+    return found;
+}
@@ -24,19 +24,36 @@
 #ifndef GNSS_SDR_GNSS_FLOWGRAPH_H
 #define GNSS_SDR_GNSS_FLOWGRAPH_H
 
+#include "acquisition_thread_pool.h"
 #include "channel_status_msg_receiver.h"
 #include "concurrent_queue.h"
+#include "flowgraph_conf.h"
+#include "flowgraph_instrumentation.h"
 #include "galileo_e6_has_msg_receiver.h"
+#include "gnss_block_interface.h"
+#include "gnss_capture_trigger.h"
+#include "gnss_pipeline_latency.h"
+#include "gnss_receiver_checkpoint.h"
+#include "gnss_receiver_snapshot.h"
+#include "gnss_sample_clock.h"
 #include "gnss_sdr_sample_counter.h"
 #include "gnss_signal.h"
+#include "gnss_signal_queue.h"
+#include "gnss_sky_prediction.h"
+#include "gnss_thread_sched.h"
 #include "pvt_interface.h"
+#include "realtime_budget.h"
+#include "stream_buffer_policy.h"
+#include "tracking_worker_pool.h"
 #include <gnuradio/blocks/null_sink.h>  // for null_sink
 #include <gnuradio/runtime_types.h>     // for basic_block_sptr, top_block_sptr
 #include <pmt/pmt.h>                    // for pmt_t
-#include <list>                         // for list
+#include <chrono>                       // for steady_clock
+#include <deque>                        // for deque
 #include <map>                          // for map
 #include <memory>                       // for for shared_ptr, dynamic_pointer_cast
 #include <mutex>                        // for mutex
+#include <set>                          // for set
 #include <string>                       // for string
 #include <utility>                      // for pair
 #include <vector>                       // for vector
@@ -50,11 +67,20 @@
  * \{ */
 
 
+class Acq_Sky_Search;
 class ChannelInterface;
 class ConfigurationInterface;
 class GNSSBlockInterface;
+class Gnss_Sdr_Ingest_Monitor;
+class Gnss_Nav_Product;
+class Gnss_Nav_Product_Channel;
 class Gnss_Satellite;
+class Gnss_Spectral_Monitor;
 class SignalSourceInterface;
+class gnss_synchro_monitor;
+class sample_capture_sink;
+class sky_search_sink;
+class spectral_monitor_sink;
 
 /*! \brief This class represents a GNSS flow graph.
  *
@@ -120,6 +146,55 @@ public:
      */
     void apply_action(unsigned int who, unsigned int what);
 
+    /*!
+     * \brief Writes the last samples of the signal conditioners that keep
+     * them (<role>.capture_seconds) to capture files. Returns false if no
+     * capture was started.
+     */
+    bool trigger_capture(const std::string& reason);
+
+    /*!
+     * \brief Replaces the blocks of a channel by new ones built from
+     * configuration, while the flowgraph is running
+     *
+     * The other channels keep tracking. The channel keeps its signal and its
+     * ports, so only the implementations and parameters of its blocks can
+     * change (e.g., Acquisition_1C5.implementation for the channel 5).
+     *
+     * \param[in] channel_id     Channel ID
+     * \param[in] configuration  Configuration of the new blocks
+     */
+    bool reconfigure_channel(unsigned int channel_id, const std::shared_ptr<ConfigurationInterface>& configuration);
+
+    /*!
+     * \brief Samples the performance counters of the blocks, if
+     * GNSS-SDR.instrumentation_interval_ms has elapsed since the last sample,
+     * along with the metrics of the real-time budget and of the latency
+     */
+    void update_instrumentation();
+
+    /*!
+     * \brief Sheds load if the receiver falls behind real time, and restores
+     * it when it catches up, once every GNSS-SDR.realtime_budget_period_ms
+     *
+     * The samples lost by the signal sources with an ingest monitor and the
+     * fill level of the output buffers of the sources are evaluated by
+     * RealtimeBudget. Each level adds an action to the ones of the previous
+     * level: 1, acquisition limited to one channel at a time; 2, monitor
+     * clients decimated by GNSS-SDR.realtime_budget_monitor_decimation; 3 and
+     * above, one more tracking channel stopped, the one with the satellite at
+     * the lowest elevation, up to GNSS-SDR.realtime_budget_max_stopped_channels.
+     */
+    void update_realtime_budget();
+
+    /*!
+     * \brief Time at which the control thread has to call the housekeeping
+     * tasks (update_realtime_budget(), update_instrumentation() and the retry
+     * of the acquisition of idle channels), or an hour from now if none of
+     * them is pending.
+     */
+    std::chrono::steady_clock::time_point next_housekeeping_time();
+
     /*!
      * \brief Set flow graph configuratiob
      */
@@ -136,11 +211,12 @@ public:
     }
 
     /*!
-     * \brief Sends a GNU Radio asynchronous message from telemetry to PVT
+     * \brief Delivers navigation data to PVT, as the telemetry decoders do
      *
-     * It is used to assist the receiver with external ephemeris data
+     * It is used to assist the receiver with external ephemeris data. It must
+     * be called from a single thread.
      */
-    bool send_telemetry_msg(const pmt::pmt_t& msg);
+    bool send_telemetry_msg(const Gnss_Nav_Product& product);
 
     /*!
      * \brief Returns a smart pointer to the PVT object
@@ -155,6 +231,35 @@ public:
      */
     void priorize_satellites(const std::vector<std::pair<int, Gnss_Satellite>>& visible_satellites);
 
+    /*!
+     * \brief Copies the satellites being tracked and the state of PVT to
+     * snapshot
+     */
+    void get_receiver_snapshot(Gnss_Receiver_Snapshot& snapshot);
+
+    /*!
+     * \brief Sets the Doppler shifts around which the next searches of the
+     * satellites in channels start, instead of 0 Hz. Each one is used once.
+     */
+    void set_doppler_hints(const std::vector<Gnss_Channel_Snapshot>& channels);
+
+    /*!
+     * \brief Copies the state of the receiver to checkpoint, at the earliest
+     * code epoch of the tracked satellites. sample_offset is the number of
+     * samples of the recording skipped by this run, at the sampling rate of
+     * the tracking. Returns false if no satellite is being tracked.
+     */
+    bool get_receiver_checkpoint(Gnss_Receiver_Checkpoint& checkpoint, uint64_t sample_offset);
+
+    /*!
+     * \brief Sets the code epochs and Doppler shifts at which the satellites
+     * of a checkpoint start tracking, without acquisition, in a run that
+     * skipped the first sample_offset samples of the recording. Each one is
+     * used once. Called before connect(), it applies to the first
+     * assignments of the channels.
+     */
+    void set_tracking_hints(const std::vector<Gnss_Channel_Checkpoint>& channels, uint64_t sample_offset);
+
 #if ENABLE_FPGA
     void start_acquisition_helper();
 
@@ -171,9 +276,20 @@ private:
     int connect_observables();
     int connect_pvt();
     int connect_sample_counter();
+    int connect_sample_distributors();
+    int connect_capture_rings();
+    int connect_spectral_monitors();
+    int connect_sky_searches();
 
     int connect_signal_sources_to_signal_conditioners();
+    void configure_signal_source_ingest(int source_ID, const std::vector<std::pair<gr::basic_block_sptr, int>>& rf_channel_outputs);
+    int connect_signal_source_to_channelizer(int source_ID, unsigned int& signal_conditioner_ID);
+    unsigned int channelizer_outputs(int source_ID) const;
     int connect_signal_conditioners_to_channels();
+    int connect_signal_conditioner_to_channel(int i);
+    gr::basic_block_sptr acquisition_branch(int i, int signal_conditioner_ID);
+    gr::basic_block_sptr glonass_acquisition_branch(int i, int signal_conditioner_ID);
+    gr::basic_block_sptr tracking_branch(int i, int signal_conditioner_ID);
     int connect_channels_to_observables();
     int connect_observables_to_pvt();
     int connect_monitors();
@@ -190,15 +306,31 @@ private:
 
     int assign_channels();
     void check_signal_conditioners();
+    void set_processor_affinities();
+    void configure_block(const gr::basic_block_sptr& block, const std::vector<int>& cpus, const std::string& role);
+    void set_thread_scheduling();
+    void add_thread_sched(const gr::basic_block_sptr& block, const std::string& role, const std::string& class_role);
+    void apply_thread_scheduling();
+    void set_stream_buffers();
+    void configure_stream_buffer(const gr::block_sptr& block, int port, const std::string& role, double items_per_s, int64_t buffer_items);
+    void advise_huge_pages();
 
     void set_signals_list();
     void set_channels_state();  // Initializes the channels state (start acquisition or keep standby)
                                 // using the configuration parameters (number of channels and max channels in acquisition)
+    void set_channel_state(unsigned int channel, unsigned int state);
     Gnss_Signal search_next_signal(const std::string& searched_signal,
         bool& is_primary_frequency,
         bool& assistance_available,
         float& estimated_doppler,
         double& RX_time);
+    bool take_assisted_signal(Gnss_Signal_Queue& candidates,
+        const std::string& primary_signal,
+        Gnss_Signal& result,
+        float& estimated_doppler,
+        double& RX_time);
+    bool take_sky_candidate(Gnss_Signal_Queue& candidates, const std::string& signal, Gnss_Signal& result);
+    void set_sky_search_busy(const Gnss_Signal& gs, bool busy);
 
     void push_back_signal(const Gnss_Signal& gs);
     void remove_signal(const Gnss_Signal& gs);
@@ -206,24 +338,73 @@ private:
     void check_desktop_conf_in_fpga_env();
 
     double project_doppler(const std::string& searched_signal, double primary_freq_doppler_hz);
+    bool signal_code_parameters(const std::string& signal, double& code_period_s, double& carrier_freq_hz);
+    bool find_tracking_reference(const Gnss_Signal& gnss_signal, const std::string& reference_signal, Gnss_Synchro& reference);
+    bool predict_code_epoch(const std::string& searched_signal, const Gnss_Synchro& reference, double& code_epoch_s, double& code_period_s);
+    bool handover_tracking(unsigned int channel);
+    bool resume_tracking(unsigned int channel);
+    void report_buffer_memory() const;
     bool is_multiband() const;
+    bool has_pvt_to_trk_port(const std::shared_ptr<ChannelInterface>& channel) const;
+    gr::basic_block_sptr pvt_to_beamformer_block(const std::shared_ptr<GNSSBlockInterface>& conditioner) const;
+    float take_doppler_hint(const Gnss_Signal& gnss_signal);
+    void take_channel_out_of_service(unsigned int channel);
+    void return_channel_to_service(unsigned int channel);
+    void apply_realtime_budget_level(int level);
+    int lowest_elevation_tracking_channel() const;
 
     std::vector<std::string> split_string(const std::string& s, char delim);
+    std::vector<int> parse_cpu_list(const std::string& cpu_list);
+    std::vector<std::vector<int>> get_numa_nodes_cpus();
     std::vector<bool> signal_conditioner_connected_;
 
     gr::top_block_sptr top_block_;
 
     std::shared_ptr<ConfigurationInterface> configuration_;
+    Flowgraph_Conf conf_;  // parameters read on every acquisition event
     std::shared_ptr<Concurrent_Queue<pmt::pmt_t>> queue_;
 
     std::vector<std::shared_ptr<SignalSourceInterface>> sig_source_;
     std::vector<std::shared_ptr<GNSSBlockInterface>> sig_conditioner_;
+    std::vector<std::shared_ptr<GNSSBlockInterface>> channelizer_;  // one per signal source, nullptr if it has none
+    std::vector<std::pair<gr::basic_block_sptr, int>> conditioner_inputs_;  // output feeding each signal conditioner, by signal conditioner ID
     std::vector<std::shared_ptr<ChannelInterface>> channels_;
     std::shared_ptr<GNSSBlockInterface> observables_;
     std::shared_ptr<GNSSBlockInterface> pvt_;
-
-    std::map<std::string, gr::basic_block_sptr> acq_resamplers_;
+    std::shared_ptr<Gnss_Nav_Product_Channel> assistance_nav_products_;  // external navigation data delivered to PVT
+
+    std::shared_ptr<Acquisition_Thread_Pool> acquisition_thread_pool_;
+    std::shared_ptr<Tracking_Worker_Pool> tracking_worker_pool_;  // null if the tracking channels run freely
+    std::shared_ptr<Gnss_Pipeline_Latency> pipeline_latency_;     // null if the latency is not measured
+    std::shared_ptr<Gnss_Sample_Clock> sample_clock_;             // epochs of the observables, from the sample counter
+    std::unique_ptr<FlowgraphInstrumentation> instrumentation_;
+    std::unique_ptr<RealtimeBudget> realtime_budget_;  // if GNSS-SDR.realtime_budget=true
+    std::unique_ptr<Stream_Buffer_Policy> stream_buffer_policy_;
+    std::vector<gnss_shared_ptr<Gnss_Sdr_Ingest_Monitor>> ingest_monitors_;
+    std::vector<std::pair<gr::block_sptr, int>> source_outputs_;  // outputs of the signal sources, for the fill level of their buffers
+    std::vector<gnss_shared_ptr<gnss_synchro_monitor>> synchro_monitors_;
+    std::vector<std::pair<gr::block_sptr, std::pair<std::string, Gnss_Thread_Sched>>> thread_scheds_;  // scheduling class of the threads of the blocks, with their role
+    std::vector<std::pair<gr::block_sptr, std::pair<int, std::string>>> huge_page_outputs_;           // outputs whose buffers get huge pages at start, with their role
+    std::vector<unsigned int> budget_stopped_channels_;          // channels stopped by the real-time budget, in order
+    std::map<std::pair<char, uint32_t>, int> satellite_elevations_;  // elevation [deg] of (system, PRN), from priorize_satellites
+    std::chrono::steady_clock::time_point last_budget_update_;
+    std::chrono::milliseconds budget_period_{1000};
+    int budget_level_{0};  // level whose actions are applied
+    int budget_monitor_decimation_{10};
+
+    std::map<std::string, gr::basic_block_sptr> acq_resamplers_;  // acquisition branches, by signal and RF channel
+    std::map<int, gr::basic_block_sptr> array_interleavers_;       // samples of the elements of the antenna arrays, by RF channel
     std::vector<gr::blocks::null_sink::sptr> null_sinks_;
+    std::vector<gr::basic_block_sptr> sample_stream_sinks_;  // samples of the signal conditioners distributed to other receivers
+    std::vector<gnss_shared_ptr<sample_capture_sink>> sample_capture_sinks_;  // last samples of the signal conditioners, written on anomalies
+    std::shared_ptr<Gnss_Capture_Trigger> capture_trigger_;                    // null if no signal conditioner keeps its samples
+    std::deque<std::chrono::steady_clock::time_point> lock_losses_;            // within the lock loss window of the captures
+    std::vector<std::shared_ptr<Gnss_Spectral_Monitor>> spectral_monitors_;   // of the RF channels with <conditioner role>.spectral_monitor=true
+    std::vector<gnss_shared_ptr<spectral_monitor_sink>> spectral_monitor_sinks_;
+    std::map<std::string, std::shared_ptr<Acq_Sky_Search>> sky_searches_;  // of the signals with Acquisition_<signal>.sky_search=true
+    std::vector<gnss_shared_ptr<sky_search_sink>> sky_search_sinks_;
+    std::chrono::milliseconds capture_lock_loss_window_{1000};
+    size_t capture_lock_loss_count_{4};
 
     gr::basic_block_sptr GnssSynchroMonitor_;
     gr::basic_block_sptr GnssSynchroAcquisitionMonitor_;
@@ -237,20 +418,24 @@ private:
     gnss_sdr_fpga_sample_counter_sptr ch_out_fpga_sample_counter_;
 #endif
 
-    std::vector<unsigned int> channels_state_;
-
-    std::list<Gnss_Signal> available_GPS_1C_signals_;
-    std::list<Gnss_Signal> available_GPS_2S_signals_;
-    std::list<Gnss_Signal> available_GPS_L5_signals_;
-    std::list<Gnss_Signal> available_SBAS_1C_signals_;
-    std::list<Gnss_Signal> available_GAL_1B_signals_;
-    std::list<Gnss_Signal> available_GAL_5X_signals_;
-    std::list<Gnss_Signal> available_GAL_7X_signals_;
-    std::list<Gnss_Signal> available_GAL_E6_signals_;
-    std::list<Gnss_Signal> available_GLO_1G_signals_;
-    std::list<Gnss_Signal> available_GLO_2G_signals_;
-    std::list<Gnss_Signal> available_BDS_B1_signals_;
-    std::list<Gnss_Signal> available_BDS_B3_signals_;
+    std::vector<unsigned int> channels_state_;  // 0: idle; 1: in acquisition; 2: in tracking; 3: out of service
+    std::map<std::pair<std::string, uint32_t>, float> doppler_hints_;  // Doppler [Hz] of (signal, PRN)
+    std::map<std::pair<std::string, uint32_t>, std::pair<uint64_t, double>> tracking_hints_;  // code epoch [samples] and Doppler [Hz] of (signal, PRN)
+    std::shared_ptr<Gnss_Sky_Prediction> sky_prediction_;              // Doppler predicted by the control thread
+    std::set<unsigned int> idle_channels_;      // channels in state 0, waiting for a signal to acquire
+
+    Gnss_Signal_Queue available_GPS_1C_signals_;
+    Gnss_Signal_Queue available_GPS_2S_signals_;
+    Gnss_Signal_Queue available_GPS_L5_signals_;
+    Gnss_Signal_Queue available_SBAS_1C_signals_;
+    Gnss_Signal_Queue available_GAL_1B_signals_;
+    Gnss_Signal_Queue available_GAL_5X_signals_;
+    Gnss_Signal_Queue available_GAL_7X_signals_;
+    Gnss_Signal_Queue available_GAL_E6_signals_;
+    Gnss_Signal_Queue available_GLO_1G_signals_;
+    Gnss_Signal_Queue available_GLO_2G_signals_;
+    Gnss_Signal_Queue available_BDS_B1_signals_;
+    Gnss_Signal_Queue available_BDS_B3_signals_;
 
     enum StringValue
     {
@@ -278,6 +463,7 @@ private:
     int channels_count_;
     int acq_channels_count_;
     int max_acq_channels_;
+    int configured_max_acq_channels_;  // Channels.in_acquisition, before the real-time budget limits it
 
     bool connected_;
     bool running_;
@@ -0,0 +1,98 @@
+/*!
+ * \file gnss_signal_queue.cc
+ * \brief Queue of the satellite signals available for acquisition.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_signal_queue.h"
+
+
+bool Gnss_Signal_Queue::empty() const
+{
+    return d_queue.empty();
+}
+
+
+size_t Gnss_Signal_Queue::size() const
+{
+    return d_queue.size();
+}
+
+
+bool Gnss_Signal_Queue::contains(uint32_t prn) const
+{
+    return d_positions.count(prn) != 0;
+}
+
+
+Gnss_Signal Gnss_Signal_Queue::next()
+{
+    if (d_queue.empty())
+        {
+            return Gnss_Signal{};
+        }
+    const Gnss_Signal gs = d_queue.begin()->second;
+    push_back(gs);
+    return gs;
+}
+
+
+void Gnss_Signal_Queue::push_back(const Gnss_Signal& gs)
+{
+    remove(gs);
+    const uint32_t prn = gs.get_satellite().get_PRN();
+    d_queue.emplace(d_back_sequence, gs);
+    d_positions[prn] = d_back_sequence;
+    d_back_sequence++;
+}
+
+
+bool Gnss_Signal_Queue::move_to_front(const Gnss_Signal& gs)
+{
+    if (!remove(gs))
+        {
+            return false;
+        }
+    const uint32_t prn = gs.get_satellite().get_PRN();
+    d_queue.emplace(d_front_sequence, gs);
+    d_positions[prn] = d_front_sequence;
+    d_front_sequence--;
+    return true;
+}
+
+
+bool Gnss_Signal_Queue::remove(const Gnss_Signal& gs)
+{
+    const auto position = d_positions.find(gs.get_satellite().get_PRN());
+    if (position == d_positions.end())
+        {
+            return false;
+        }
+    d_queue.erase(position->second);
+    d_positions.erase(position);
+    return true;
+}
+
+
+bool Gnss_Signal_Queue::take_first_if(const std::function<bool(const Gnss_Signal&)>& pred, Gnss_Signal& gs)
+{
+    for (const auto& candidate : d_queue)
+        {
+            if (pred(candidate.second))
+                {
+                    gs = candidate.second;
+                    remove(gs);
+                    return true;
+                }
+        }
+    return false;
+}
@@ -0,0 +1,75 @@
+/*!
+ * \file gnss_signal_queue.h
+ * \brief Queue of the satellite signals available for acquisition.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SIGNAL_QUEUE_H
+#define GNSS_SDR_GNSS_SIGNAL_QUEUE_H
+
+#include "gnss_signal.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver
+ * \{ */
+
+
+/*!
+ * \brief Queue of the candidate signals of one signal type, in the order in
+ * which they are assigned to the channels.
+ *
+ * Each satellite is in the queue at most once. The signals are ordered by a
+ * sequence number, and indexed by PRN, so that taking the next candidate,
+ * moving a satellite to the front or to the back, and removing it are all
+ * O(log n), instead of the linear search of a list.
+ */
+class Gnss_Signal_Queue
+{
+public:
+    Gnss_Signal_Queue() = default;
+
+    bool empty() const;
+    size_t size() const;
+    bool contains(uint32_t prn) const;
+
+    /*!
+     * \brief Returns the signal at the front, and moves it to the back. It
+     * returns an empty signal if the queue is empty.
+     */
+    Gnss_Signal next();
+
+    void push_back(const Gnss_Signal& gs);      //!< Inserts gs, or moves it, to the back
+    bool move_to_front(const Gnss_Signal& gs);  //!< Moves gs to the front, if it is in the queue
+    bool remove(const Gnss_Signal& gs);         //!< Removes gs, if it is in the queue
+
+    /*!
+     * \brief Removes the first signal, in queue order, for which pred is
+     * true, and copies it to gs.
+     */
+    bool take_first_if(const std::function<bool(const Gnss_Signal&)>& pred, Gnss_Signal& gs);
+
+private:
+    std::map<int64_t, Gnss_Signal> d_queue;   // signals by sequence number
+    std::map<uint32_t, int64_t> d_positions;  // sequence number of each PRN
+    int64_t d_front_sequence{0};
+    int64_t d_back_sequence{1};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SIGNAL_QUEUE_H
@@ -0,0 +1,80 @@
+/*!
+ * \file realtime_budget.cc
+ * \brief Detects that the receiver falls behind real time and decides how
+ * much load it has to shed.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "realtime_budget.h"
+#include <glog/logging.h>
+#include <iostream>
+#include <sstream>
+
+
+RealtimeBudget::RealtimeBudget(int max_level, int recovery_periods, double max_buffer_fill)
+    : d_max_buffer_fill(max_buffer_fill),
+      d_max_level(max_level),
+      d_recovery_periods(recovery_periods < 1 ? 1 : recovery_periods)
+{
+}
+
+
+int RealtimeBudget::update(uint64_t lost_samples, double buffer_fill)
+{
+    const bool samples_lost = lost_samples > d_lost_samples;
+    const bool overloaded = samples_lost or buffer_fill > d_max_buffer_fill;
+    d_lost_samples = lost_samples;
+    d_buffer_fill = buffer_fill;
+    if (overloaded)
+        {
+            d_overloaded_periods++;
+            d_healthy_periods = 0;
+            if (d_level < d_max_level)
+                {
+                    d_level++;
+                    LOG(WARNING) << "Receiver behind real time (" << (samples_lost ? "samples lost" : "source buffers full")
+                                 << "), load shedding level " << d_level;
+                }
+        }
+    else if (d_level > 0 and ++d_healthy_periods >= d_recovery_periods)
+        {
+            d_healthy_periods = 0;
+            d_level--;
+            LOG(INFO) << "Receiver back within the real-time budget, load shedding level " << d_level;
+        }
+    return d_level;
+}
+
+
+void RealtimeBudget::record_action(const std::string& action)
+{
+    d_actions++;
+    LOG(WARNING) << "Real-time budget: " << action;
+    std::cout << "Real-time budget: " << action << '\n';
+}
+
+
+std::string RealtimeBudget::report() const
+{
+    std::stringstream report;
+    report << "# TYPE gnss_sdr_realtime_budget_level gauge\n"
+           << "gnss_sdr_realtime_budget_level " << d_level << '\n'
+           << "# TYPE gnss_sdr_realtime_budget_lost_samples_total counter\n"
+           << "gnss_sdr_realtime_budget_lost_samples_total " << d_lost_samples << '\n'
+           << "# TYPE gnss_sdr_realtime_budget_source_buffer_fill gauge\n"
+           << "gnss_sdr_realtime_budget_source_buffer_fill " << d_buffer_fill << '\n'
+           << "# TYPE gnss_sdr_realtime_budget_overloaded_periods_total counter\n"
+           << "gnss_sdr_realtime_budget_overloaded_periods_total " << d_overloaded_periods << '\n'
+           << "# TYPE gnss_sdr_realtime_budget_actions_total counter\n"
+           << "gnss_sdr_realtime_budget_actions_total " << d_actions << '\n';
+    return report.str();
+}
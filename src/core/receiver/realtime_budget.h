@@ -0,0 +1,78 @@
+/*!
+ * \file realtime_budget.h
+ * \brief Detects that the receiver falls behind real time and decides how
+ * much load it has to shed.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_REALTIME_BUDGET_H
+#define GNSS_SDR_REALTIME_BUDGET_H
+
+#include <cstdint>
+#include <string>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver
+ * \{ */
+
+
+/*!
+ * \brief Load shedding level of the receiver, from the samples lost by the
+ * signal sources and the fill level of their output buffers.
+ *
+ * It is evaluated once per period: the level goes up by one in each period
+ * in which samples were lost or the buffers of the sources were fuller than
+ * max_buffer_fill, and it goes down by one after recovery_periods periods in
+ * a row without any of them, so the receiver degrades and recovers one step
+ * at a time instead of oscillating. What each level sheds is decided by the
+ * flowgraph (see GNSSFlowgraph::update_realtime_budget), which reports each
+ * action to be logged and counted.
+ */
+class RealtimeBudget
+{
+public:
+    RealtimeBudget(int max_level, int recovery_periods, double max_buffer_fill);
+
+    /*!
+     * \brief Evaluates a period, and returns the new level.
+     *
+     * \param[in] lost_samples  Samples lost by all the sources since the start
+     * \param[in] buffer_fill   Maximum fill level (0 to 1) of the output
+     *                          buffers of the sources, or 0 if unknown
+     */
+    int update(uint64_t lost_samples, double buffer_fill);
+
+    //! Logs and counts an action taken because of the level
+    void record_action(const std::string& action);
+
+    int level() const { return d_level; }
+
+    //! State and actions, in the Prometheus text format
+    std::string report() const;
+
+private:
+    uint64_t d_lost_samples{0};
+    uint64_t d_overloaded_periods{0};
+    uint64_t d_actions{0};
+    double d_max_buffer_fill;
+    double d_buffer_fill{0.0};
+    int d_max_level;
+    int d_recovery_periods;
+    int d_healthy_periods{0};
+    int d_level{0};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_REALTIME_BUDGET_H
@@ -0,0 +1,62 @@
+/*!
+ * \file stream_buffer_policy.cc
+ * \brief Sizes, alignment and huge pages of the stream buffers of the
+ * high-rate connections of the flowgraph.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "stream_buffer_policy.h"
+#include <algorithm>  // for std::max
+#include <cmath>      // for std::ceil
+
+
+constexpr size_t Stream_Buffer_Policy::HUGE_PAGE_BYTES;
+constexpr size_t Stream_Buffer_Policy::PAGE_BYTES;
+constexpr size_t Stream_Buffer_Policy::CACHE_LINE_BYTES;
+
+
+Stream_Buffer_Policy::Stream_Buffer_Policy(const ConfigurationInterface* configuration, double consumer_request_s)
+    : d_configuration(configuration),
+      d_consumer_request_s(std::max(consumer_request_s, 0.0)),
+      d_high_rate_sps(configuration->property("GNSS-SDR.stream_buffers_high_rate_sps", 10e6)),
+      d_buffer_ms(std::max(configuration->property("GNSS-SDR.stream_buffers_ms", 20.0), 0.0)),
+      d_huge_pages(configuration->property("GNSS-SDR.stream_buffers_huge_pages", true)),
+      d_enabled(configuration->property("GNSS-SDR.stream_buffers", std::string("auto")) != "gnuradio")
+{
+}
+
+
+Stream_Buffer Stream_Buffer_Policy::buffer(const std::string& role, double items_per_s, size_t item_size) const
+{
+    Stream_Buffer stream_buffer;
+    if (!d_enabled or items_per_s <= 0.0 or item_size == 0)
+        {
+            return stream_buffer;
+        }
+    const double buffer_ms = d_configuration->property(role + ".output_buffer_ms", 0.0);
+    if (buffer_ms <= 0.0 and items_per_s < d_high_rate_sps)
+        {
+            return stream_buffer;
+        }
+
+    stream_buffer.huge_pages = d_configuration->property(role + ".output_buffer_huge_pages", d_huge_pages);
+    const double items = std::max(items_per_s * (buffer_ms > 0.0 ? buffer_ms : d_buffer_ms) / 1000.0, 2.0 * items_per_s * d_consumer_request_s);
+    const size_t page = (stream_buffer.huge_pages ? HUGE_PAGE_BYTES : PAGE_BYTES);
+    uint64_t bytes = static_cast<uint64_t>(std::ceil(items)) * item_size;
+    bytes = std::max((bytes + page - 1) / page, static_cast<uint64_t>(1U)) * page;
+    stream_buffer.items = static_cast<int64_t>((bytes + item_size - 1) / item_size);
+    if (item_size < CACHE_LINE_BYTES and CACHE_LINE_BYTES % item_size == 0)
+        {
+            stream_buffer.alignment = static_cast<int32_t>(CACHE_LINE_BYTES / item_size);
+        }
+    return stream_buffer;
+}
@@ -0,0 +1,101 @@
+/*!
+ * \file stream_buffer_policy.h
+ * \brief Sizes, alignment and huge pages of the stream buffers of the
+ * high-rate connections of the flowgraph.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_STREAM_BUFFER_POLICY_H
+#define GNSS_SDR_STREAM_BUFFER_POLICY_H
+
+#include "configuration_interface.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver
+ * \{ */
+
+
+/*!
+ * \brief Output buffer of a stream connection
+ */
+struct Stream_Buffer
+{
+    int64_t items{0};        //!< Minimum size of the output buffer [items], 0 for the default of GNU Radio
+    int32_t alignment{1};    //!< Alignment of the items produced by each call to work [items]
+    bool huge_pages{false};  //!< Advise the kernel to back the buffer with transparent huge pages
+};
+
+
+/*!
+ * \brief Buffer policy of the outputs of the signal sources and of the
+ * signal conditioners, which carry the samples to the channels.
+ *
+ * GNU Radio sizes its buffers from the item size (32 KB per output by
+ * default, mapped twice in 4 KB pages), which at tens of Msps means a
+ * wraparound every fraction of a millisecond and a TLB miss every few
+ * hundred samples, for the output of a conditioner read by all the tracking
+ * channels. With GNSS-SDR.stream_buffers=auto (the default), the outputs of
+ * at least GNSS-SDR.stream_buffers_high_rate_sps get:
+ *  - room for GNSS-SDR.stream_buffers_ms of samples, and at least twice the
+ *    longest read of a consumer (the dwell of the acquisition), in whole
+ *    huge pages of 2 MB,
+ *  - work calls that produce whole cache lines (64 bytes), so the readers of
+ *    the buffer get the pointers that the aligned volk_gnsssdr kernels need,
+ *  - and, after the start, the advice to back them with transparent huge
+ *    pages (GNSS-SDR.stream_buffers_huge_pages, true by default).
+ *
+ * Each connection is configured by the role of the block that writes it:
+ * <role>.output_buffer_ms sets its time span (and applies the policy to a
+ * connection at any rate), and <role>.output_buffer_huge_pages its huge
+ * pages. GNSS-SDR.stream_buffers=gnuradio leaves all the buffers to GNU Radio.
+ */
+class Stream_Buffer_Policy
+{
+public:
+    static constexpr size_t HUGE_PAGE_BYTES = 2097152;
+    static constexpr size_t PAGE_BYTES = 4096;
+    static constexpr size_t CACHE_LINE_BYTES = 64;
+
+    /*!
+     * \brief Policy of the configuration, whose consumers read at most
+     * consumer_request_s seconds of samples at once
+     */
+    Stream_Buffer_Policy(const ConfigurationInterface* configuration, double consumer_request_s);
+
+    /*!
+     * \brief Buffer of the output of role, carrying items_per_s items of
+     * item_size bytes
+     */
+    Stream_Buffer buffer(const std::string& role, double items_per_s, size_t item_size) const;
+
+    inline bool enabled() const
+    {
+        return d_enabled;
+    }
+
+private:
+    const ConfigurationInterface* d_configuration;
+    double d_consumer_request_s;
+    double d_high_rate_sps;
+    double d_buffer_ms;
+    bool d_huge_pages;
+    bool d_enabled;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_STREAM_BUFFER_POLICY_H
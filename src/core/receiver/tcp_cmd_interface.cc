@@ -16,12 +16,21 @@
  */
 
 #include "tcp_cmd_interface.h"
-#include "command_event.h"
+#include "control_event.h"
+#include "gnss_receiver_snapshot.h"
+#include "gnss_trace.h"
 #include "pvt_interface.h"
 #include <boost/asio.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <algorithm>  // for max
+#include <chrono>     // for milliseconds
 #include <cmath>      // for isnan
+#include <cstring>    // for memcpy
+#include <deque>      // for deque
 #include <exception>  // for exception
 #include <iomanip>    // for setprecision
+#include <iostream>   // for cout, cerr
+#include <iterator>   // for istream_iterator
 #include <sstream>    // for stringstream
 #include <utility>    // for move
 
@@ -31,6 +40,233 @@ using b_io_context = boost::asio::io_context;
 using b_io_context = boost::asio::io_service;
 #endif
 
+
+namespace
+{
+template <typename T>
+void append_value(std::string &frame, T value)
+{
+    frame.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+
+char system_letter(const std::string &system)
+{
+    if (system == "GPS")
+        {
+            return 'G';
+        }
+    if (system == "Glonass")
+        {
+            return 'R';
+        }
+    if (system == "Galileo")
+        {
+            return 'E';
+        }
+    if (system == "Beidou")
+        {
+            return 'C';
+        }
+    return '?';
+}
+}  // namespace
+
+
+/*
+ * Telecommand session of a client. The handlers of all the sessions run in
+ * the thread of run_cmd_server(), one at a time.
+ */
+class TcpCmdInterface::Session : public std::enable_shared_from_this<TcpCmdInterface::Session>
+{
+public:
+    Session(TcpCmdInterface *server, b_io_context &context, boost::asio::ip::tcp::socket socket)
+        : server_(server),
+          socket_(std::move(socket)),
+          timer_(context)
+    {
+    }
+
+    void start()
+    {
+        read_command();
+    }
+
+private:
+    // unsent status frames after which the next ones are dropped, so that a
+    // slow client only gets the latest ones
+    static constexpr size_t max_pending_frames = 4;
+
+    void read_command()
+    {
+        auto self(shared_from_this());
+        boost::asio::async_read_until(socket_, input_, '\n',
+            [this, self](const boost::system::error_code &error, size_t /*bytes_transferred*/) {
+                handle_command(error);
+            });
+    }
+
+    void handle_command(const boost::system::error_code &error)
+    {
+        if (error)
+            {
+                if (error == boost::asio::error::eof)
+                    {
+                        std::cerr << "TcpCmdInterface: EOF detected\n";
+                    }
+                else if (error != boost::asio::error::operation_aborted)
+                    {
+                        std::cerr << "TcpCmdInterface: Error reading messages: " << error.message() << '\n';
+                    }
+                stop();
+                return;
+            }
+        std::istream is(&input_);
+        std::string line;
+        std::getline(is, line);
+        std::istringstream iss(line);
+        const std::vector<std::string> cmd_vector(std::istream_iterator<std::string>{iss},
+            std::istream_iterator<std::string>());
+
+        if (cmd_vector.empty())
+            {
+                send(std::make_shared<const std::string>("ERROR: empty command\n"));
+            }
+        else if (cmd_vector.at(0) == "exit")
+            {
+                closing_ = true;
+                send(std::make_shared<const std::string>("OK\n"));
+                return;
+            }
+        else if (cmd_vector.at(0) == "subscribe")
+            {
+                subscribe(cmd_vector);
+            }
+        else if (cmd_vector.at(0) == "unsubscribe")
+            {
+                unsubscribe();
+                send(std::make_shared<const std::string>("OK\n"));
+            }
+        else
+            {
+                send(std::make_shared<const std::string>(server_->execute(cmd_vector)));
+            }
+        read_command();
+    }
+
+    void subscribe(const std::vector<std::string> &commandLine)
+    {
+        int period_ms = 1000;
+        if (commandLine.size() > 1)
+            {
+                try
+                    {
+                        period_ms = std::stoi(commandLine.at(1));
+                    }
+                catch (const std::exception &ex)
+                    {
+                        send(std::make_shared<const std::string>("ERROR: period malformed\n"));
+                        return;
+                    }
+            }
+        status_period_ = std::chrono::milliseconds(std::max(period_ms, 10));
+        if (!subscribed_)
+            {
+                subscribed_ = true;
+                if (server_->status_subscribers_++ == 0 and server_->control_queue_ != nullptr)
+                    {
+                        // wake up the control thread, which only publishes the status while there are subscribers
+                        server_->control_queue_->push(control_event_pmt(Control_Event::command, 200, 15));
+                    }
+                send(std::make_shared<const std::string>("OK\n"));
+                send_status();
+            }
+        else
+            {
+                send(std::make_shared<const std::string>("OK\n"));
+            }
+    }
+
+    void unsubscribe()
+    {
+        if (subscribed_)
+            {
+                subscribed_ = false;
+                server_->status_subscribers_--;
+                boost::system::error_code not_throw;
+                timer_.cancel(not_throw);
+            }
+    }
+
+    void send_status()
+    {
+        const std::shared_ptr<const std::string> frame = server_->latest_status();
+        if (frame != nullptr and output_.size() < max_pending_frames)
+            {
+                send(frame);
+            }
+#if USE_BOOST_ASIO_IO_CONTEXT
+        timer_.expires_after(status_period_);
+#else
+        timer_.expires_from_now(status_period_);
+#endif
+        auto self(shared_from_this());
+        timer_.async_wait([this, self](const boost::system::error_code &error) {
+            if (!error and subscribed_)
+                {
+                    send_status();
+                }
+        });
+    }
+
+    void send(std::shared_ptr<const std::string> message)
+    {
+        output_.push_back(std::move(message));
+        if (output_.size() == 1)
+            {
+                write_next();
+            }
+    }
+
+    void write_next()
+    {
+        auto self(shared_from_this());
+        boost::asio::async_write(socket_, boost::asio::buffer(*output_.front()),
+            [this, self](const boost::system::error_code &error, size_t /*bytes_transferred*/) {
+                output_.pop_front();
+                if (error)
+                    {
+                        std::cerr << "Error sending(" << error.value() << "): " << error.message() << '\n';
+                        stop();
+                    }
+                else if (!output_.empty())
+                    {
+                        write_next();
+                    }
+                else if (closing_)
+                    {
+                        stop();
+                    }
+            });
+    }
+
+    void stop()
+    {
+        unsubscribe();
+        boost::system::error_code not_throw;
+        socket_.close(not_throw);
+    }
+
+    TcpCmdInterface *server_;
+    boost::asio::ip::tcp::socket socket_;
+    boost::asio::steady_timer timer_;
+    boost::asio::streambuf input_;
+    std::deque<std::shared_ptr<const std::string>> output_;
+    std::chrono::milliseconds status_period_{1000};
+    bool subscribed_{false};
+    bool closing_{false};
+};
+
 TcpCmdInterface::TcpCmdInterface()
     : rx_latitude_(0.0),
       rx_longitude_(0.0),
@@ -52,7 +288,12 @@ void TcpCmdInterface::register_functions()
     functions_["hotstart"] = [&](auto &s) { return TcpCmdInterface::hotstart(s); };
     functions_["warmstart"] = [&](auto &s) { return TcpCmdInterface::warmstart(s); };
     functions_["coldstart"] = [&](auto &s) { return TcpCmdInterface::coldstart(s); };
+    functions_["capture"] = [&](auto &s) { return TcpCmdInterface::capture(s); };
     functions_["set_ch_satellite"] = [&](auto &s) { return TcpCmdInterface::set_ch_satellite(s); };
+    functions_["stop_channel"] = [&](auto &s) { return TcpCmdInterface::stop_channel(s); };
+    functions_["start_channel"] = [&](auto &s) { return TcpCmdInterface::start_channel(s); };
+    functions_["reconfigure_channel"] = [&](auto &s) { return TcpCmdInterface::reconfigure_channel(s); };
+    functions_["trace"] = [&](auto &s) { return TcpCmdInterface::trace(s); };
 #else
     functions_["status"] = std::bind(&TcpCmdInterface::status, this, std::placeholders::_1);
     functions_["standby"] = std::bind(&TcpCmdInterface::standby, this, std::placeholders::_1);
@@ -60,7 +301,12 @@ void TcpCmdInterface::register_functions()
     functions_["hotstart"] = std::bind(&TcpCmdInterface::hotstart, this, std::placeholders::_1);
     functions_["warmstart"] = std::bind(&TcpCmdInterface::warmstart, this, std::placeholders::_1);
     functions_["coldstart"] = std::bind(&TcpCmdInterface::coldstart, this, std::placeholders::_1);
+    functions_["capture"] = std::bind(&TcpCmdInterface::capture, this, std::placeholders::_1);
     functions_["set_ch_satellite"] = std::bind(&TcpCmdInterface::set_ch_satellite, this, std::placeholders::_1);
+    functions_["stop_channel"] = std::bind(&TcpCmdInterface::stop_channel, this, std::placeholders::_1);
+    functions_["start_channel"] = std::bind(&TcpCmdInterface::start_channel, this, std::placeholders::_1);
+    functions_["reconfigure_channel"] = std::bind(&TcpCmdInterface::reconfigure_channel, this, std::placeholders::_1);
+    functions_["trace"] = std::bind(&TcpCmdInterface::trace, this, std::placeholders::_1);
 #endif
 }
 
@@ -71,6 +317,72 @@ void TcpCmdInterface::set_pvt(std::shared_ptr<PvtInterface> PVT_sptr)
 }
 
 
+void TcpCmdInterface::publish_status(const Gnss_Receiver_Snapshot &snapshot)
+{
+    auto frame = std::make_shared<const std::string>(encode_status(snapshot));
+    std::lock_guard<std::mutex> lock(status_mutex_);
+    status_frame_ = std::move(frame);
+}
+
+
+bool TcpCmdInterface::has_status_subscribers() const
+{
+    return status_subscribers_ > 0;
+}
+
+
+std::shared_ptr<const std::string> TcpCmdInterface::latest_status() const
+{
+    std::lock_guard<std::mutex> lock(status_mutex_);
+    return status_frame_;
+}
+
+
+std::string TcpCmdInterface::encode_status(const Gnss_Receiver_Snapshot &snapshot)
+{
+    std::string frame("GSTS");
+    append_value<uint32_t>(frame, 0);  // size, filled at the end
+    append_value<uint16_t>(frame, 1);
+    append_value<uint16_t>(frame, static_cast<uint16_t>(snapshot.channels.size()));
+    append_value<uint8_t>(frame, snapshot.pvt_valid ? 1 : 0);
+    append_value<double>(frame, snapshot.time_s);
+    append_value<double>(frame, snapshot.latitude_deg);
+    append_value<double>(frame, snapshot.longitude_deg);
+    append_value<double>(frame, snapshot.height_m);
+    append_value<int64_t>(frame, snapshot.pvt_utc_time);
+    append_value<double>(frame, snapshot.clock_drift_ppm);
+    for (const auto &channel : snapshot.channels)
+        {
+            frame.push_back(system_letter(channel.System));
+            frame.append((channel.Signal + "  ").substr(0, 2));
+            append_value<uint32_t>(frame, channel.PRN);
+            append_value<float>(frame, static_cast<float>(channel.Carrier_Doppler_hz));
+            append_value<float>(frame, static_cast<float>(channel.CN0_dB_hz));
+        }
+    const auto size = static_cast<uint32_t>(frame.size() - 8);
+    std::memcpy(&frame[4], &size, sizeof(size));
+    return frame;
+}
+
+
+std::string TcpCmdInterface::execute(const std::vector<std::string> &commandLine)
+{
+    const auto function = functions_.find(commandLine.at(0));
+    if (function == functions_.end())
+        {
+            return "ERROR: command not found \n ";
+        }
+    try
+        {
+            return function->second(commandLine);
+        }
+    catch (const std::exception &ex)
+        {
+            return "ERROR: command execution error: " + std::string(ex.what()) + "\n";
+        }
+}
+
+
 time_t TcpCmdInterface::get_utc_time() const
 {
     return receiver_utc_time_;
@@ -88,8 +400,7 @@ std::string TcpCmdInterface::reset(const std::vector<std::string> &commandLine _
     std::string response;
     if (control_queue_ != nullptr)
         {
-            const command_event_sptr new_evnt = command_event_make(200, 1);  // send the restart message (who=200,what=1)
-            control_queue_->push(pmt::make_any(new_evnt));
+            control_queue_->push(control_event_pmt(Control_Event::command, 200, 1));  // send the restart message (who=200,what=1)
             response = "OK\n";
         }
     else
@@ -105,8 +416,7 @@ std::string TcpCmdInterface::standby(const std::vector<std::string> &commandLine
     std::string response;
     if (control_queue_ != nullptr)
         {
-            const command_event_sptr new_evnt = command_event_make(300, 10);  // send the standby message (who=300,what=10)
-            control_queue_->push(pmt::make_any(new_evnt));
+            control_queue_->push(control_event_pmt(Control_Event::command, 300, 10));  // send the standby message (who=300,what=10)
             response = "OK\n";
         }
     else
@@ -173,6 +483,22 @@ std::string TcpCmdInterface::status(const std::vector<std::string> &commandLine
 }
 
 
+std::string TcpCmdInterface::capture(const std::vector<std::string> &commandLine __attribute__((unused)))
+{
+    std::string response;
+    if (control_queue_ != nullptr)
+        {
+            control_queue_->push(control_event_pmt(Control_Event::command, 300, 30));  // send the capture message (who=300,what=30)
+            response = "OK\n";
+        }
+    else
+        {
+            response = "ERROR\n";
+        }
+    return response;
+}
+
+
 std::string TcpCmdInterface::hotstart(const std::vector<std::string> &commandLine)
 {
     std::string response;
@@ -203,8 +529,7 @@ std::string TcpCmdInterface::hotstart(const std::vector<std::string> &commandLin
                 {
                     if (control_queue_ != nullptr)
                         {
-                            const command_event_sptr new_evnt = command_event_make(300, 12);  // send the standby message (who=300,what=12)
-                            control_queue_->push(pmt::make_any(new_evnt));
+                            control_queue_->push(control_event_pmt(Control_Event::command, 300, 12));  // send the standby message (who=300,what=12)
                             response = "OK\n";
                         }
                     else
@@ -251,8 +576,7 @@ std::string TcpCmdInterface::warmstart(const std::vector<std::string> &commandLi
                 {
                     if (control_queue_ != nullptr)
                         {
-                            const command_event_sptr new_evnt = command_event_make(300, 13);  // send the warmstart message (who=300,what=13)
-                            control_queue_->push(pmt::make_any(new_evnt));
+                            control_queue_->push(control_event_pmt(Control_Event::command, 300, 13));  // send the warmstart message (who=300,what=13)
                             response = "OK\n";
                         }
                     else
@@ -274,8 +598,7 @@ std::string TcpCmdInterface::coldstart(const std::vector<std::string> &commandLi
     std::string response;
     if (control_queue_ != nullptr)
         {
-            const command_event_sptr new_evnt = command_event_make(300, 11);  // send the coldstart message (who=300,what=11)
-            control_queue_->push(pmt::make_any(new_evnt));
+            control_queue_->push(control_event_pmt(Control_Event::command, 300, 11));  // send the coldstart message (who=300,what=11)
             response = "OK\n";
         }
     else
@@ -296,6 +619,111 @@ std::string TcpCmdInterface::set_ch_satellite(const std::vector<std::string> &co
 }
 
 
+std::string TcpCmdInterface::stop_channel(const std::vector<std::string> &commandLine)
+{
+    return channel_command(commandLine, 20);  // send the stop channel message (who=400+N,what=20)
+}
+
+
+std::string TcpCmdInterface::start_channel(const std::vector<std::string> &commandLine)
+{
+    return channel_command(commandLine, 21);  // send the start channel message (who=400+N,what=21)
+}
+
+
+std::string TcpCmdInterface::reconfigure_channel(const std::vector<std::string> &commandLine)
+{
+    return channel_command(commandLine, 22);  // send the reconfigure channel message (who=400+N,what=22)
+}
+
+
+std::string TcpCmdInterface::channel_command(const std::vector<std::string> &commandLine, int what)
+{
+    std::string response;
+    if (commandLine.size() < 2)
+        {
+            response = "ERROR: channel not found, please use " + commandLine.at(0) + " <first channel>[-<last channel>]\n";
+            return response;
+        }
+    // Read the channel range
+    unsigned long first;
+    unsigned long last;
+    try
+        {
+            const std::string &range = commandLine.at(1);
+            const size_t dash = range.find('-');
+            first = std::stoul(range.substr(0, dash));
+            last = (dash == std::string::npos) ? first : std::stoul(range.substr(dash + 1));
+        }
+    catch (const std::exception &e)
+        {
+            response = "ERROR: channel malformed\n";
+            return response;
+        }
+    if (last < first or last >= 200)
+        {
+            response = "ERROR: channel out of range\n";
+        }
+    else if (control_queue_ != nullptr)
+        {
+            for (unsigned long channel = first; channel <= last; channel++)
+                {
+                    control_queue_->push(control_event_pmt(Control_Event::command, static_cast<uint32_t>(400 + channel), static_cast<uint16_t>(what)));
+                }
+            response = "OK\n";
+        }
+    else
+        {
+            response = "ERROR\n";
+        }
+    return response;
+}
+
+
+std::string TcpCmdInterface::trace(const std::vector<std::string> &commandLine)
+{
+    // trace start [events per thread] | trace stop [filename]
+    const std::string action = commandLine.size() > 1 ? commandLine.at(1) : std::string("");
+    std::string response;
+    if (action == "start")
+        {
+            size_t events_per_thread = 65536;
+            try
+                {
+                    if (commandLine.size() > 2)
+                        {
+                            events_per_thread = std::stoul(commandLine.at(2));
+                        }
+                }
+            catch (const std::exception &e)
+                {
+                    return "ERROR: events per thread malformed\n";
+                }
+            Gnss_Trace::start(events_per_thread);
+            response = "OK\n";
+        }
+    else if (action == "stop")
+        {
+            Gnss_Trace::stop();
+            const std::string filename = commandLine.size() > 2 ? commandLine.at(2) : std::string("./gnss-sdr-trace.json");
+            uint64_t events = 0;
+            if (Gnss_Trace::write_json(filename, events))
+                {
+                    response = "OK: " + std::to_string(events) + " events written to " + filename + "\n";
+                }
+            else
+                {
+                    response = "ERROR: cannot write " + filename + "\n";
+                }
+        }
+    else
+        {
+            response = "ERROR: please use trace start [events per thread] or trace stop [filename]\n";
+        }
+    return response;
+}
+
+
 void TcpCmdInterface::set_msg_queue(std::shared_ptr<Concurrent_Queue<pmt::pmt_t>> control_queue)
 {
     control_queue_ = std::move(control_queue);
@@ -307,115 +735,40 @@ void TcpCmdInterface::run_cmd_server(int tcp_port)
     // Get the port from the parameters
     const uint16_t port = tcp_port;
 
-    // Error to not throw exception
-    boost::system::error_code not_throw;
-
     // Socket and acceptor
     b_io_context context;
     try
         {
             boost::asio::ip::tcp::acceptor acceptor(context, boost::asio::ip::tcp::endpoint(boost::asio::ip::tcp::v4(), port));
+            std::cout << "TcpCmdInterface: Telecommand TCP interface listening on port " << tcp_port << '\n';
 
-            while (keep_running_)
-                {
-                    try
+            // each client gets a session, and the acceptor waits for the next one
+            std::function<void()> accept_client = [&]() {
+                auto socket = std::make_shared<boost::asio::ip::tcp::socket>(context);
+                acceptor.async_accept(*socket, [&, socket](const boost::system::error_code &error) {
+                    if (error)
                         {
-                            std::cout << "TcpCmdInterface: Telecommand TCP interface listening on port " << tcp_port << '\n';
-
-                            boost::asio::ip::tcp::socket socket(context);
-                            acceptor.accept(socket, not_throw);
-                            if (not_throw)
-                                {
-                                    std::cerr << "TcpCmdInterface: Error when binding the port in the socket\n";
-                                    continue;
-                                }
-
-                            // Read a message
-                            boost::system::error_code error = boost::asio::error::eof;
-                            do
-                                {
-                                    std::string response;
-                                    boost::asio::streambuf b;
-                                    if (boost::asio::read_until(socket, b, '\n', error) == 0)
-                                        {
-                                            std::cerr << "TcpCmdInterface: Error reading messages: " << error.message() << '\n';
-                                        }
-                                    std::istream is(&b);
-                                    std::string line;
-                                    std::getline(is, line);
-                                    std::istringstream iss(line);
-                                    const std::vector<std::string> cmd_vector(std::istream_iterator<std::string>{iss},
-                                        std::istream_iterator<std::string>());
-
-                                    if (!cmd_vector.empty())
-                                        {
-                                            try
-                                                {
-                                                    if (cmd_vector.at(0) == "exit")
-                                                        {
-                                                            error = boost::asio::error::eof;
-                                                            // send cmd response
-                                                            if (socket.write_some(boost::asio::buffer("OK\n"), not_throw) == 0)
-                                                                {
-                                                                    std::cerr << "Error: 0 bytes sent in cmd response\n";
-                                                                }
-                                                        }
-                                                    else
-                                                        {
-                                                            response = functions_[cmd_vector.at(0)](cmd_vector);
-                                                        }
-                                                }
-                                            catch (const std::bad_function_call &ex)
-                                                {
-                                                    response = "ERROR: command not found \n ";
-                                                }
-                                            catch (const std::exception &ex)
-                                                {
-                                                    response = "ERROR: command execution error: " + std::string(ex.what()) + "\n";
-                                                }
-                                        }
-                                    else
-                                        {
-                                            response = "ERROR: empty command\n";
-                                        }
-
-                                    // send cmd response
-                                    if (socket.write_some(boost::asio::buffer(response), not_throw) == 0)
-                                        {
-                                            std::cerr << "Error: 0 bytes sent in cmd response\n";
-                                        }
-                                    if (not_throw)
-                                        {
-                                            std::cerr << "Error sending(" << not_throw.value() << "): " << not_throw.message() << '\n';
-                                            break;
-                                        }
-                                }
-                            while (error != boost::asio::error::eof);
-
-                            if (error == boost::asio::error::eof)
-                                {
-                                    std::cerr << "TcpCmdInterface: EOF detected\n";
-                                }
-                            else
-                                {
-                                    std::cerr << "TcpCmdInterface unexpected error: " << error << '\n';
-                                }
-
-                            // Close socket
-                            socket.close();
+                            std::cerr << "TcpCmdInterface: Error when accepting a client: " << error.message() << '\n';
                         }
-                    catch (const boost::exception &e)
+                    else
                         {
-                            std::cerr << "TcpCmdInterface: Boost exception\n";
+                            std::make_shared<Session>(this, context, std::move(*socket))->start();
                         }
-                    catch (const std::exception &ex)
+                    if (keep_running_)
                         {
-                            std::cerr << "TcpCmdInterface: Exception " << ex.what() << '\n';
+                            accept_client();
                         }
-                }
+                });
+            };
+            accept_client();
+            context.run();
         }
     catch (const boost::exception &e)
         {
             std::cerr << "TCP Command Interface exception: address already in use\n";
         }
+    catch (const std::exception &ex)
+        {
+            std::cerr << "TcpCmdInterface: Exception " << ex.what() << '\n';
+        }
 }
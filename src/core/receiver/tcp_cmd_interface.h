@@ -22,10 +22,12 @@
 #include "concurrent_queue.h"
 #include <pmt/pmt.h>
 #include <array>
+#include <atomic>
 #include <cstdint>
 #include <ctime>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -36,8 +38,19 @@
  * \{ */
 
 
+class Gnss_Receiver_Snapshot;
 class PvtInterface;
 
+/*!
+ * \brief Telecommand server. It serves any number of clients at the same
+ * time, from a single thread, with one command per line and a text response
+ * to each command.
+ *
+ * The command "subscribe <period_ms>" streams to the client, every period,
+ * the last receiver status published with publish_status(), in the binary
+ * frames of encode_status(), until "unsubscribe" or the end of the session.
+ */
+
 class TcpCmdInterface
 {
 public:
@@ -58,7 +71,35 @@ public:
 
     void set_pvt(std::shared_ptr<PvtInterface> PVT_sptr);
 
+    /*!
+     * \brief Publishes the receiver status streamed to the subscribed clients
+     */
+    void publish_status(const Gnss_Receiver_Snapshot &snapshot);
+
+    /*!
+     * \brief Whether any client is subscribed to the receiver status
+     */
+    bool has_status_subscribers() const;
+
+    /*!
+     * \brief Binary status frame of a snapshot, in the byte order of the host
+     * (little-endian on x86 and ARM): the characters "GSTS", the number of
+     * bytes that follow (uint32), the version (uint16, 1), the number of
+     * channels (uint16), whether there is a position fix (uint8), the
+     * snapshot time (double, s since the Unix epoch), latitude and longitude
+     * (double, deg), height (double, m), UTC time of the fix (int64, s since
+     * the Unix epoch) and clock drift (double, ppm), and for each tracked
+     * satellite its system letter (G, R, E or C), signal (2 characters), PRN
+     * (uint32), Doppler (float, Hz) and C/N0 (float, dB-Hz).
+     */
+    static std::string encode_status(const Gnss_Receiver_Snapshot &snapshot);
+
 private:
+    class Session;
+
+    std::string execute(const std::vector<std::string> &commandLine);
+    std::shared_ptr<const std::string> latest_status() const;
+
     std::unordered_map<std::string, std::function<std::string(const std::vector<std::string> &)>>
         functions_;
     std::string status(const std::vector<std::string> &commandLine);
@@ -67,13 +108,23 @@ private:
     std::string hotstart(const std::vector<std::string> &commandLine);
     std::string warmstart(const std::vector<std::string> &commandLine);
     std::string coldstart(const std::vector<std::string> &commandLine);
+    std::string capture(const std::vector<std::string> &commandLine);
     std::string set_ch_satellite(const std::vector<std::string> &commandLine);
+    std::string stop_channel(const std::vector<std::string> &commandLine);
+    std::string start_channel(const std::vector<std::string> &commandLine);
+    std::string reconfigure_channel(const std::vector<std::string> &commandLine);
+    std::string channel_command(const std::vector<std::string> &commandLine, int what);
+    std::string trace(const std::vector<std::string> &commandLine);
 
     void register_functions();
 
     std::shared_ptr<Concurrent_Queue<pmt::pmt_t>> control_queue_;
     std::shared_ptr<PvtInterface> PVT_sptr_;
 
+    mutable std::mutex status_mutex_;
+    std::shared_ptr<const std::string> status_frame_;  // last published status
+    std::atomic<int> status_subscribers_{0};
+
     float rx_latitude_;
     float rx_longitude_;
     float rx_altitude_;
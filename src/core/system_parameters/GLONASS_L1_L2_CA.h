@@ -83,6 +83,12 @@ constexpr double GLONASS_L1_CA_SYMBOL_RATE_BPS = 1000.0;
 
 constexpr int32_t GLONASS_CA_NBR_SATS = 24;  // STRING DATA WITHOUT PREAMBLE
 
+// FDMA CHANNELS
+constexpr int32_t GLONASS_MIN_FREQUENCY_NUMBER = -7;        //!< Lowest FDMA frequency number
+constexpr int32_t GLONASS_MAX_FREQUENCY_NUMBER = 6;         //!< Highest FDMA frequency number
+constexpr uint32_t GLONASS_L1_CA_OPT_ACQ_FS_SPS = 2000000;  //!< Sampling frequency of the FDMA sub-bands for the acquisition
+constexpr uint32_t GLONASS_L2_CA_OPT_ACQ_FS_SPS = 2000000;  //!< Sampling frequency of the FDMA sub-bands for the acquisition
+
 // OBSERVABLE HISTORY DEEP FOR INTERPOLATION
 constexpr int32_t GLONASS_L1_CA_HISTORY_DEEP = 100;
 
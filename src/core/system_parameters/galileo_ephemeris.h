@@ -21,6 +21,7 @@
 
 #include "gnss_ephemeris.h"
 #include <boost/serialization/nvp.hpp>
+#include <boost/serialization/version.hpp>
 #include <cstdint>
 
 /** \addtogroup Core
@@ -61,6 +62,7 @@ public:
     double BGD_E1E5b{};  //!< E1-E5b Broadcast Group Delay [s]
 
     bool flag_all_ephemeris{};
+    bool flag_reduced_ced{};  //!< Computed from a reduced CED (I/NAV word 16): a coarser orbit and clock, to be replaced by the full ephemeris
 
     template <class Archive>
 
@@ -70,10 +72,6 @@ public:
      */
     inline void serialize(Archive& archive, const uint32_t version)
     {
-        if (version)
-            {
-            };
-
         archive& BOOST_SERIALIZATION_NVP(PRN);
         archive& BOOST_SERIALIZATION_NVP(M_0);
         archive& BOOST_SERIALIZATION_NVP(delta_n);
@@ -112,9 +110,16 @@ public:
         archive& BOOST_SERIALIZATION_NVP(BGD_E1E5a);
         archive& BOOST_SERIALIZATION_NVP(BGD_E1E5b);
         archive& BOOST_SERIALIZATION_NVP(flag_all_ephemeris);
+        // appended in version 1
+        if (version > 0)
+            {
+                archive& BOOST_SERIALIZATION_NVP(flag_reduced_ced);
+            }
     }
 };
 
+BOOST_CLASS_VERSION(Galileo_Ephemeris, 1)
+
 
 /** \} */
 /** \} */
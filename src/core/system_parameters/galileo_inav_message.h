@@ -24,12 +24,11 @@
 #include "galileo_ephemeris.h"
 #include "galileo_iono.h"
 #include "galileo_utc_model.h"
+#include "gnss_bit_stream.h"
 #include "gnss_sdr_make_unique.h"  // for std::unique_ptr in C++11
-#include <bitset>
 #include <cstdint>
 #include <memory>
 #include <string>
-#include <utility>
 #include <vector>
 
 class ReedSolomon;  // Forward declaration of the ReedSolomon class
@@ -40,6 +39,10 @@ class ReedSolomon;  // Forward declaration of the ReedSolomon class
  * \{ */
 
 
+using Galileo_Inav_Page_Part = Gnss_Bit_Stream<GALILEO_INAV_PAGE_PART_BITS>;  //!< Decoded bits of an even or odd page part
+using Galileo_Inav_Data_Jk = Gnss_Bit_Stream<GALILEO_DATA_JK_BITS>;             //!< Data_k followed by Data_j
+
+
 /*!
  * \brief This class handles the Galileo I/NAV Data message, as described in the
  * Galileo Open Service Signal in Space Interface Control Document (OS SIS ICD), Issue 2.0 (Jan. 2021).
@@ -55,13 +58,23 @@ public:
     /*
      * \brief Takes in input a page (Odd or Even) of 120 bit, split it according ICD 4.3.2.3 and join Data_k with Data_j
      */
-    void split_page(std::string page_string, int32_t flag_even_word);
+    void split_page(const Galileo_Inav_Page_Part& page_part, int32_t flag_even_word);
+
+    /*
+     * \brief Same as above, with the page given as a string of '0' and '1' characters
+     */
+    void split_page(const std::string& page_string, int32_t flag_even_word);
 
     /*
      * \brief Takes in input Data_jk (128 bit) and split it in ephemeris parameters according ICD 4.3.5
      *
      * Takes in input Data_jk (128 bit) and split it in ephemeris parameters according ICD 4.3.5
      */
+    int32_t page_jk_decoder(const Galileo_Inav_Data_Jk& data_jk_bits);
+
+    /*
+     * \brief Same as above, with Data_jk given as a string of '0' and '1' characters
+     */
     int32_t page_jk_decoder(const char* data_jk);
 
     /*
@@ -221,22 +234,20 @@ public:
     }
 
 private:
-    bool CRC_test(const std::bitset<GALILEO_DATA_FRAME_BITS>& bits, uint32_t checksum) const;
-    bool read_navigation_bool(const std::bitset<GALILEO_DATA_JK_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const;
-    uint64_t read_navigation_unsigned(const std::bitset<GALILEO_DATA_JK_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const;
-    uint64_t read_page_type_unsigned(const std::bitset<GALILEO_PAGE_TYPE_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const;
-    int64_t read_navigation_signed(const std::bitset<GALILEO_DATA_JK_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const;
-    uint8_t read_octet_unsigned(const std::bitset<GALILEO_DATA_JK_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const;
-    void read_page_1(const std::bitset<GALILEO_DATA_JK_BITS>& data_bits);
-    void read_page_2(const std::bitset<GALILEO_DATA_JK_BITS>& data_bits);
-    void read_page_3(const std::bitset<GALILEO_DATA_JK_BITS>& data_bits);
-    void read_page_4(const std::bitset<GALILEO_DATA_JK_BITS>& data_bits);
-    std::bitset<GALILEO_DATA_JK_BITS> regenerate_page_1(const std::vector<uint8_t>& decoded) const;
-    std::bitset<GALILEO_DATA_JK_BITS> regenerate_page_2(const std::vector<uint8_t>& decoded) const;
-    std::bitset<GALILEO_DATA_JK_BITS> regenerate_page_3(const std::vector<uint8_t>& decoded) const;
-    std::bitset<GALILEO_DATA_JK_BITS> regenerate_page_4(const std::vector<uint8_t>& decoded) const;
-
-    std::string page_Even{};
+    bool read_navigation_bool(const Galileo_Inav_Data_Jk& bits, const Gnss_Bit_Field& parameter) const;
+    uint64_t read_navigation_unsigned(const Galileo_Inav_Data_Jk& bits, const Gnss_Bit_Field& parameter) const;
+    int64_t read_navigation_signed(const Galileo_Inav_Data_Jk& bits, const Gnss_Bit_Field& parameter) const;
+    uint8_t read_octet_unsigned(const Galileo_Inav_Data_Jk& bits, const Gnss_Bit_Field& parameter) const;
+    void read_page_1(const Galileo_Inav_Data_Jk& data_bits);
+    void read_page_2(const Galileo_Inav_Data_Jk& data_bits);
+    void read_page_3(const Galileo_Inav_Data_Jk& data_bits);
+    void read_page_4(const Galileo_Inav_Data_Jk& data_bits);
+    Galileo_Inav_Data_Jk regenerate_page_1(const std::vector<uint8_t>& decoded) const;
+    Galileo_Inav_Data_Jk regenerate_page_2(const std::vector<uint8_t>& decoded) const;
+    Galileo_Inav_Data_Jk regenerate_page_3(const std::vector<uint8_t>& decoded) const;
+    Galileo_Inav_Data_Jk regenerate_page_4(const std::vector<uint8_t>& decoded) const;
+
+    Galileo_Inav_Page_Part page_Even{};
 
     std::vector<uint8_t> rs_buffer;   // Reed-Solomon buffer
     std::unique_ptr<ReedSolomon> rs;  // The Reed-Solomon decoder
@@ -0,0 +1,49 @@
+/*!
+ * \file gnss_bit_stream.cc
+ * \brief Fixed-capacity stream of navigation message bits packed in 64-bit
+ * words, with field extraction and CRC-24Q computation.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_bit_stream.h"
+
+
+namespace
+{
+std::array<uint32_t, 256> make_crc24q_table()
+{
+    std::array<uint32_t, 256> table{};
+    for (uint32_t i = 0; i < 256; i++)
+        {
+            uint32_t crc = i << 16U;
+            for (int32_t k = 0; k < 8; k++)
+                {
+                    crc <<= 1U;
+                    if ((crc & 0x1000000U) != 0)
+                        {
+                            crc ^= 0x1864CFBU;
+                        }
+                }
+            table[i] = crc & 0xFFFFFFU;
+        }
+    return table;
+}
+
+
+const std::array<uint32_t, 256> CRC24Q_TABLE = make_crc24q_table();
+}  // namespace
+
+
+uint32_t gnss_crc24q_update(uint32_t crc, uint8_t byte)
+{
+    return ((crc << 8U) & 0xFFFFFFU) ^ CRC24Q_TABLE[((crc >> 16U) ^ byte) & 0xFFU];
+}
@@ -0,0 +1,245 @@
+/*!
+ * \file gnss_bit_stream.h
+ * \brief Fixed-capacity stream of navigation message bits packed in 64-bit
+ * words, with field extraction and CRC-24Q computation.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_BIT_STREAM_H
+#define GNSS_SDR_GNSS_BIT_STREAM_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup System_Parameters
+ * \{ */
+
+
+/*!
+ * \brief Position and length of a field of a navigation message. As in the
+ * ICDs, the first bit of the message is bit 1.
+ */
+struct Gnss_Bit_Field
+{
+    constexpr Gnss_Bit_Field(int32_t first_bit, int32_t num_bits) : first(first_bit), length(num_bits) {}
+    int32_t first;   //!< Position of the first (most significant) bit of the field
+    int32_t length;  //!< Number of bits of the field, up to 64
+};
+
+
+/*!
+ * \brief Updates a CRC-24Q (polynomial 0x1864CFB, zero initial value) with
+ * the next byte of a message.
+ */
+uint32_t gnss_crc24q_update(uint32_t crc, uint8_t byte);
+
+
+/*!
+ * \brief Stream of up to N bits, stored in 64-bit words with the first bit in
+ * the most significant bit of the first word. It holds no dynamic memory, so
+ * a navigation message page can be stored, checked and decoded without any
+ * allocation.
+ */
+template <std::size_t N>
+class Gnss_Bit_Stream
+{
+public:
+    Gnss_Bit_Stream() = default;
+
+    /*!
+     * \brief Builds the stream from a string of '0' and '1' characters
+     */
+    explicit Gnss_Bit_Stream(const std::string& bits)
+    {
+        for (const auto c : bits)
+            {
+                push_back(c == '1');
+            }
+    }
+
+    /*!
+     * \brief Removes all the bits
+     */
+    inline void clear()
+    {
+        d_words.fill(0ULL);
+        d_size = 0;
+    }
+
+    /*!
+     * \brief Number of bits in the stream
+     */
+    inline std::size_t size() const
+    {
+        return d_size;
+    }
+
+    /*!
+     * \brief Appends a bit. Bits beyond the capacity N are ignored.
+     */
+    inline void push_back(bool bit)
+    {
+        if (d_size < N)
+            {
+                set(d_size, bit);
+                d_size++;
+            }
+    }
+
+    /*!
+     * \brief Appends the nbits least significant bits of value, most
+     * significant first
+     */
+    inline void append(uint64_t value, std::size_t nbits)
+    {
+        for (std::size_t i = nbits; i > 0; i--)
+            {
+                push_back(((value >> (i - 1)) & 1ULL) == 1ULL);
+            }
+    }
+
+    /*!
+     * \brief Appends nbits bits of another stream, starting at its position pos
+     */
+    template <std::size_t M>
+    inline void append(const Gnss_Bit_Stream<M>& other, std::size_t pos, std::size_t nbits)
+    {
+        while (nbits > 0)
+            {
+                const std::size_t chunk = nbits < 64 ? nbits : 64;
+                append(other.read(pos, chunk), chunk);
+                pos += chunk;
+                nbits -= chunk;
+            }
+    }
+
+    /*!
+     * \brief Sets the bit at position pos, starting at 0
+     */
+    inline void set(std::size_t pos, bool bit)
+    {
+        const uint64_t mask = 1ULL << (63U - pos % 64U);
+        if (bit)
+            {
+                d_words[pos / 64U] |= mask;
+            }
+        else
+            {
+                d_words[pos / 64U] &= ~mask;
+            }
+    }
+
+    /*!
+     * \brief Returns the bit at position pos, starting at 0
+     */
+    inline bool test(std::size_t pos) const
+    {
+        return ((d_words[pos / 64U] >> (63U - pos % 64U)) & 1ULL) == 1ULL;
+    }
+
+    /*!
+     * \brief Returns the nbits (up to 64) bits starting at position pos
+     * (starting at 0) as an unsigned integer, the first bit being the most
+     * significant one
+     */
+    inline uint64_t read(std::size_t pos, std::size_t nbits) const
+    {
+        if (nbits == 0)
+            {
+                return 0ULL;
+            }
+        const std::size_t word = pos / 64U;
+        const std::size_t offset = pos % 64U;
+        uint64_t value = d_words[word] << offset;
+        if (offset != 0 && offset + nbits > 64U && word + 1 < d_words.size())
+            {
+                value |= d_words[word + 1] >> (64U - offset);
+            }
+        return value >> (64U - nbits);
+    }
+
+    /*!
+     * \brief Reads a field as an unsigned integer
+     */
+    inline uint64_t read_unsigned(const Gnss_Bit_Field& field) const
+    {
+        return read(field.first - 1, field.length);
+    }
+
+    /*!
+     * \brief Reads a field as a two's complement signed integer
+     */
+    inline int64_t read_signed(const Gnss_Bit_Field& field) const
+    {
+        const uint64_t value = read_unsigned(field);
+        if (field.length < 64 && test(field.first - 1))
+            {
+                return static_cast<int64_t>(value | (~0ULL << field.length));  // sign extension
+            }
+        return static_cast<int64_t>(value);
+    }
+
+    /*!
+     * \brief Reads the first bit of a field as a boolean
+     */
+    inline bool read_bool(const Gnss_Bit_Field& field) const
+    {
+        return test(field.first - 1);
+    }
+
+    /*!
+     * \brief Computes the CRC-24Q of the first nbits bits
+     */
+    inline uint32_t crc24q(std::size_t nbits) const
+    {
+        // leading zeros do not change a CRC with zero initial value, so the
+        // first bits are processed as a zero-padded byte
+        uint32_t crc = 0;
+        std::size_t pos = nbits % 8U;
+        if (pos != 0)
+            {
+                crc = gnss_crc24q_update(crc, static_cast<uint8_t>(read(0, pos)));
+            }
+        for (; pos < nbits; pos += 8U)
+            {
+                crc = gnss_crc24q_update(crc, static_cast<uint8_t>(read(pos, 8U)));
+            }
+        return crc;
+    }
+
+    /*!
+     * \brief Returns the bits as a string of '0' and '1' characters
+     */
+    std::string to_string() const
+    {
+        std::string bits;
+        bits.reserve(d_size);
+        for (std::size_t i = 0; i < d_size; i++)
+            {
+                bits.push_back(test(i) ? '1' : '0');
+            }
+        return bits;
+    }
+
+private:
+    std::array<uint64_t, (N + 63U) / 64U> d_words{};
+    std::size_t d_size{0};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_BIT_STREAM_H
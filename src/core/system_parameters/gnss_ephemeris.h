@@ -109,6 +109,7 @@ public:
     double satvel_Z{};  //!< Earth-fixed velocity coordinate z of the satellite [m]
 
 protected:
+    friend class Gnss_Ephemeris_Batch;
     char System{};  //!< Character ID of the GNSS system. 'G': GPS.  'E': Galileo.  'B': BeiDou
 
 private:
@@ -0,0 +1,369 @@
+/*!
+ * \file gnss_ephemeris_batch.cc
+ * \brief Computes the positions, velocities and clock corrections of a set of
+ * satellites from their broadcast ephemerides, for all of them at once
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_ephemeris_batch.h"
+#include "MATH_CONSTANTS.h"
+#include "gnss_frequencies.h"
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+double ephemeris_batch_check_t(double time)
+{
+    const double half_week = 302400.0;  // seconds
+    double corrTime = time;
+    if (time > half_week)
+        {
+            corrTime = time - 2.0 * half_week;
+        }
+    else if (time < -half_week)
+        {
+            corrTime = time + 2.0 * half_week;
+        }
+    return corrTime;
+}
+
+
+// Carrier frequency of a band, as in Gnss_Ephemeris::predicted_doppler, or 0
+double ephemeris_batch_band_frequency(char system, int band)
+{
+    if (system == 'E')  // Galileo
+        {
+            switch (band)
+                {
+                case 1:
+                    return FREQ1;
+                case 5:
+                    return FREQ5;
+                case 6:
+                    return FREQ6;
+                case 7:
+                    return FREQ7;
+                case 8:
+                    return FREQ8;
+                default:
+                    return 0.0;
+                }
+        }
+    if (system == 'G')  // GPS
+        {
+            switch (band)
+                {
+                case 1:
+                    return FREQ1;
+                case 2:
+                    return FREQ2;
+                case 5:
+                    return FREQ5;
+                default:
+                    return 0.0;
+                }
+        }
+    if (system == 'B')  // Beidou
+        {
+            switch (band)
+                {
+                case 1:
+                    return FREQ1_BDS;
+                case 2:
+                    return FREQ2_BDS;
+                case 3:
+                    return FREQ3_BDS;
+                default:
+                    return 0.0;
+                }
+        }
+    return 0.0;
+}
+}  // namespace
+
+
+Gnss_Ephemeris_Batch::Gnss_Ephemeris_Batch(size_t cached_epochs)
+    : d_cached_epochs(std::max<size_t>(cached_epochs, 1))
+{
+}
+
+
+bool Gnss_Ephemeris_Batch::set_ephemerides(const std::vector<const Gnss_Ephemeris*>& ephemerides)
+{
+    const std::lock_guard<std::mutex> lock(d_mutex);
+    if (ephemerides.size() == d_prn.size())
+        {
+            bool same = true;
+            for (size_t k = 0; k < ephemerides.size() and same; k++)
+                {
+                    const Gnss_Ephemeris& eph = *ephemerides[k];
+                    same = eph.PRN == d_prn[k] and eph.System == d_system[k] and static_cast<double>(eph.toe) == d_toe[k] and
+                           static_cast<double>(eph.toc) == d_toc[k] and eph.M_0 == d_M_0[k] and eph.af0 == d_af0[k];
+                }
+            if (same)
+                {
+                    return false;
+                }
+        }
+
+    d_cache.clear();
+    for (auto* v : {&d_a, &d_n, &d_M_0, &d_ecc, &d_sq1e2, &d_omega, &d_OMEGA_0, &d_Omega_dot, &d_earth_rotation_toe, &d_i_0, &d_idot,
+             &d_Cuc, &d_Cus, &d_Crc, &d_Crs, &d_Cic, &d_Cis, &d_toe, &d_toc, &d_af0, &d_af1, &d_af2, &d_relativistic})
+        {
+            v->clear();
+        }
+    d_prn.clear();
+    d_system.clear();
+    for (const Gnss_Ephemeris* eph : ephemerides)
+        {
+            double gm = GPS_GM;
+            double earth_rotation = GNSS_OMEGA_EARTH_DOT;
+            if (eph->System == 'E')
+                {
+                    gm = GALILEO_GM;
+                }
+            else if (eph->System == 'B')
+                {
+                    gm = BEIDOU_GM;
+                    earth_rotation = BEIDOU_OMEGA_EARTH_DOT;
+                }
+            const double a = eph->sqrtA * eph->sqrtA;
+            d_prn.push_back(eph->PRN);
+            d_system.push_back(eph->System);
+            d_a.push_back(a);
+            d_n.push_back(sqrt(gm / (a * a * a)) + eph->delta_n);
+            d_M_0.push_back(eph->M_0);
+            d_ecc.push_back(eph->ecc);
+            d_sq1e2.push_back(sqrt(1.0 - eph->ecc * eph->ecc));
+            d_omega.push_back(eph->omega);
+            d_OMEGA_0.push_back(eph->OMEGA_0);
+            d_Omega_dot.push_back(eph->OMEGAdot - earth_rotation);
+            d_earth_rotation_toe.push_back(earth_rotation * static_cast<double>(eph->toe));
+            d_i_0.push_back(eph->i_0);
+            d_idot.push_back(eph->idot);
+            d_Cuc.push_back(eph->Cuc);
+            d_Cus.push_back(eph->Cus);
+            d_Crc.push_back(eph->Crc);
+            d_Crs.push_back(eph->Crs);
+            d_Cic.push_back(eph->Cic);
+            d_Cis.push_back(eph->Cis);
+            d_toe.push_back(static_cast<double>(eph->toe));
+            d_toc.push_back(static_cast<double>(eph->toc));
+            d_af0.push_back(eph->af0);
+            d_af1.push_back(eph->af1);
+            d_af2.push_back(eph->af2);
+            d_relativistic.push_back(2.0 * sqrt(gm * a));
+        }
+    return true;
+}
+
+
+std::shared_ptr<const Gnss_Ephemeris_Batch::Epoch> Gnss_Ephemeris_Batch::compute(double transmitTime)
+{
+    const std::lock_guard<std::mutex> lock(d_mutex);
+    for (const auto& cached : d_cache)
+        {
+            if (cached->time == transmitTime)
+                {
+                    return cached;
+                }
+        }
+    auto epoch = std::make_shared<Epoch>();
+    propagate(transmitTime, *epoch);
+    d_cache.push_front(epoch);
+    if (d_cache.size() > d_cached_epochs)
+        {
+            d_cache.pop_back();
+        }
+    return epoch;
+}
+
+
+std::vector<std::shared_ptr<const Gnss_Ephemeris_Batch::Epoch>> Gnss_Ephemeris_Batch::compute(const std::vector<double>& transmitTimes)
+{
+    std::vector<std::shared_ptr<const Epoch>> epochs;
+    epochs.reserve(transmitTimes.size());
+    for (const double transmitTime : transmitTimes)
+        {
+            epochs.push_back(compute(transmitTime));
+        }
+    return epochs;
+}
+
+
+std::vector<double> Gnss_Ephemeris_Batch::predicted_doppler(double rx_time_s,
+    double lat,
+    double lon,
+    double h,
+    double ve,
+    double vn,
+    double vu,
+    int band)
+{
+    const double RE_WGS84 = 6378137.0;              //!< earth semimajor axis (WGS84) (m)
+    const double FE_WGS84 = (1.0 / 298.257223563);  //!< earth flattening (WGS84)
+    const double lat_rad = lat * D2R;
+    const double lon_rad = lon * D2R;
+
+    const double sinp = sin(lat_rad);
+    const double cosp = cos(lat_rad);
+    const double sinl = sin(lon_rad);
+    const double cosl = cos(lon_rad);
+
+    const double e2 = FE_WGS84 * (2.0 - FE_WGS84);
+    const double v = RE_WGS84 / std::sqrt(1.0 - e2 * sinp * sinp);
+
+    // Position and velocity in EFEF
+    const double pos_rx_X = (v + h) * cosp * cosl;
+    const double pos_rx_Y = (v + h) * cosp * sinl;
+    const double pos_rx_Z = (v * (1.0 - e2) + h) * sinp;
+    const double t = cosp * vu - sinp * vn;
+    const double vel_rx_X = cosl * t - sinl * ve;
+    const double vel_rx_Y = sinl * t + cosl * ve;
+    const double vel_rx_Z = sinp * vu + cosp * vn;
+
+    const std::shared_ptr<const Epoch> epoch = compute(rx_time_s);
+    const size_t n_sats = epoch->pos_X.size();
+    std::vector<double> doppler(n_sats);
+    for (size_t k = 0; k < n_sats; k++)
+        {
+            const double x = epoch->pos_X[k] - pos_rx_X;
+            const double y = epoch->pos_Y[k] - pos_rx_Y;
+            const double z = epoch->pos_Z[k] - pos_rx_Z;
+            const double radial_vel = ((epoch->vel_X[k] - vel_rx_X) * x + (epoch->vel_Y[k] - vel_rx_Y) * y + (epoch->vel_Z[k] - vel_rx_Z) * z) / std::sqrt(x * x + y * y + z * z);
+            doppler[k] = -(radial_vel / SPEED_OF_LIGHT_M_S) * ephemeris_batch_band_frequency(d_system[k], band);
+        }
+    return doppler;
+}
+
+
+size_t Gnss_Ephemeris_Batch::size() const
+{
+    const std::lock_guard<std::mutex> lock(d_mutex);
+    return d_prn.size();
+}
+
+
+uint32_t Gnss_Ephemeris_Batch::prn(size_t k) const
+{
+    const std::lock_guard<std::mutex> lock(d_mutex);
+    return d_prn.at(k);
+}
+
+
+char Gnss_Ephemeris_Batch::system(size_t k) const
+{
+    const std::lock_guard<std::mutex> lock(d_mutex);
+    return d_system.at(k);
+}
+
+
+void Gnss_Ephemeris_Batch::propagate(double transmitTime, Epoch& epoch) const
+{
+    // Same computation as Gnss_Ephemeris::satellitePosVelComputation, one step at a time for all the satellites
+    const size_t n_sats = d_prn.size();
+    epoch.time = transmitTime;
+    for (auto* v : {&epoch.pos_X, &epoch.pos_Y, &epoch.pos_Z, &epoch.vel_X, &epoch.vel_Y, &epoch.vel_Z, &epoch.clock_s})
+        {
+            v->resize(n_sats);
+        }
+
+    // Time from ephemeris reference epoch, and mean anomaly
+    std::vector<double> tk(n_sats);
+    std::vector<double> M(n_sats);
+    for (size_t k = 0; k < n_sats; k++)
+        {
+            tk[k] = ephemeris_batch_check_t(transmitTime - d_toe[k]);
+            M[k] = d_M_0[k] + d_n[k] * tk[k];
+        }
+
+    // --- Iteratively compute eccentric anomaly -------------------------------
+    // the satellites that reached the necessary precision keep their value
+    std::vector<double> E(M);
+    std::vector<char> converged(n_sats, 0);
+    for (int32_t ii = 1; ii < 20; ii++)
+        {
+            size_t n_converged = 0;
+            for (size_t k = 0; k < n_sats; k++)
+                {
+                    const double E_old = E[k];
+                    const double E_new = M[k] + d_ecc[k] * sin(E_old);
+                    const bool done = converged[k] != 0;
+                    E[k] = done ? E_old : E_new;
+                    converged[k] = done or fabs(fmod(E_new - E_old, 2.0 * GNSS_PI)) < 1e-12;
+                    n_converged += converged[k];
+                }
+            if (n_converged == n_sats)
+                {
+                    break;
+                }
+        }
+
+    for (size_t k = 0; k < n_sats; k++)
+        {
+            const double a = d_a[k];
+            const double ecc = d_ecc[k];
+            const double sek = sin(E[k]);
+            const double cek = cos(E[k]);
+            const double OneMinusecosE = 1.0 - ecc * cek;
+            const double sq1e2 = d_sq1e2[k];
+            const double ekdot = d_n[k] / OneMinusecosE;
+
+            // Compute the true anomaly, and the argument of latitude
+            const double nu = atan2(sq1e2 * sek, cek - ecc);
+            const double phi = nu + d_omega[k];
+            const double s2pk = sin(2.0 * phi);
+            const double c2pk = cos(2.0 * phi);
+            const double pkdot = sq1e2 * ekdot / OneMinusecosE;
+
+            // Correct argument of latitude, radius and inclination
+            const double u = phi + d_Cuc[k] * c2pk + d_Cus[k] * s2pk;
+            const double suk = sin(u);
+            const double cuk = cos(u);
+            const double ukdot = pkdot * (1.0 + 2.0 * (d_Cus[k] * c2pk - d_Cuc[k] * s2pk));
+            const double r = a * OneMinusecosE + d_Crc[k] * c2pk + d_Crs[k] * s2pk;
+            const double rkdot = a * ecc * sek * ekdot + 2.0 * pkdot * (d_Crs[k] * c2pk - d_Crc[k] * s2pk);
+            const double i = d_i_0[k] + d_idot[k] * tk[k] + d_Cic[k] * c2pk + d_Cis[k] * s2pk;
+            const double sik = sin(i);
+            const double cik = cos(i);
+            const double ikdot = d_idot[k] + 2.0 * pkdot * (d_Cis[k] * c2pk - d_Cic[k] * s2pk);
+
+            // Compute the angle between the ascending node and the Greenwich meridian
+            const double Omega_dot = d_Omega_dot[k];
+            const double Omega = d_OMEGA_0[k] + Omega_dot * tk[k] - d_earth_rotation_toe[k];
+            const double sok = sin(Omega);
+            const double cok = cos(Omega);
+
+            // --- Compute satellite coordinates and velocity in Earth-fixed coordinates
+            const double xprime = r * cuk;
+            const double yprime = r * suk;
+            const double pos_X = xprime * cok - yprime * cik * sok;
+            const double pos_Y = xprime * sok + yprime * cik * cok;
+            const double pos_Z = yprime * sik;
+            const double xpkdot = rkdot * cuk - yprime * ukdot;
+            const double ypkdot = rkdot * suk + xprime * ukdot;
+            const double tmp = ypkdot * cik - pos_Z * ikdot;
+            epoch.pos_X[k] = pos_X;
+            epoch.pos_Y[k] = pos_Y;
+            epoch.pos_Z[k] = pos_Z;
+            epoch.vel_X[k] = -Omega_dot * pos_Y + xpkdot * cok - tmp * sok;
+            epoch.vel_Y[k] = Omega_dot * pos_X + xpkdot * sok + tmp * cok;
+            epoch.vel_Z[k] = yprime * cik * ikdot + ypkdot * sik;
+
+            // Time from ephemeris reference clock
+            const double tc = ephemeris_batch_check_t(transmitTime - d_toc[k]);
+            epoch.clock_s[k] = d_af0[k] + d_af1[k] * tc + d_af2[k] * tc * tc;
+            epoch.clock_s[k] -= d_relativistic[k] * ecc * sek / (SPEED_OF_LIGHT_M_S * SPEED_OF_LIGHT_M_S);
+        }
+}
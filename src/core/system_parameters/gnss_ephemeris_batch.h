@@ -0,0 +1,132 @@
+/*!
+ * \file gnss_ephemeris_batch.h
+ * \brief Computes the positions, velocities and clock corrections of a set of
+ * satellites from their broadcast ephemerides, for all of them at once
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_EPHEMERIS_BATCH_H
+#define GNSS_SDR_GNSS_EPHEMERIS_BATCH_H
+
+#include "gnss_ephemeris.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup System_Parameters
+ * \{ */
+
+
+/*!
+ * \brief Evaluates the orbits of all the satellites of a set of
+ * Keplerian ephemerides (GPS, Galileo, BeiDou) at a time of week.
+ *
+ * The ephemeris parameters are stored as one array per parameter, and each
+ * step of the computation, including the iterative solution of Kepler's
+ * equation, runs over all the satellites, so that the compiler can vectorize
+ * it. The results are the same as Gnss_Ephemeris::satellitePosition.
+ *
+ * The results of the last epochs are kept, so that the users of the same
+ * ephemerides (acquisition assistance, PVT, visibility prediction) compute
+ * each epoch only once. The methods can be called from several threads.
+ */
+class Gnss_Ephemeris_Batch
+{
+public:
+    /*!
+     * \brief Results of an epoch, index k for the satellite of prn(k)
+     */
+    struct Epoch
+    {
+        double time{};               //!< Time of week of the epoch [s]
+        std::vector<double> pos_X;   //!< Earth-fixed coordinate x of the satellite [m]
+        std::vector<double> pos_Y;   //!< Earth-fixed coordinate y of the satellite [m]
+        std::vector<double> pos_Z;   //!< Earth-fixed coordinate z of the satellite [m]
+        std::vector<double> vel_X;   //!< Earth-fixed velocity coordinate x of the satellite [m/s]
+        std::vector<double> vel_Y;   //!< Earth-fixed velocity coordinate y of the satellite [m/s]
+        std::vector<double> vel_Z;   //!< Earth-fixed velocity coordinate z of the satellite [m/s]
+        std::vector<double> clock_s;  //!< SV clock correction, with the relativistic term [s]
+    };
+
+    explicit Gnss_Ephemeris_Batch(size_t cached_epochs = 8);
+
+    /*!
+     * \brief Sets the ephemerides of the satellites. The cache is kept if
+     * they are the same ones as before. Returns true if they changed.
+     */
+    bool set_ephemerides(const std::vector<const Gnss_Ephemeris*>& ephemerides);
+
+    /*!
+     * \brief Shares the results of all the satellites at the time of week
+     * transmitTime, computing them if they are not cached.
+     */
+    std::shared_ptr<const Epoch> compute(double transmitTime);
+
+    /*!
+     * \brief Same as compute, for several times of week at once.
+     */
+    std::vector<std::shared_ptr<const Epoch>> compute(const std::vector<double>& transmitTimes);
+
+    /*!
+     * \brief Doppler shifts of all the satellites, as computed by
+     * Gnss_Ephemeris::predicted_doppler.
+     */
+    std::vector<double> predicted_doppler(double rx_time_s, double lat, double lon, double h, double ve, double vn, double vu, int band);
+
+    size_t size() const;           //!< Number of satellites
+    uint32_t prn(size_t k) const;  //!< PRN of the satellite k
+    char system(size_t k) const;   //!< System of the satellite k ('G', 'E' or 'B')
+
+private:
+    void propagate(double transmitTime, Epoch& epoch) const;
+
+    std::deque<std::shared_ptr<const Epoch>> d_cache;  // the most recent epoch first
+    mutable std::mutex d_mutex;
+    size_t d_cached_epochs;
+
+    // One element per satellite
+    std::vector<uint32_t> d_prn;
+    std::vector<char> d_system;
+    std::vector<double> d_a;  // semi-major axis [m]
+    std::vector<double> d_n;  // corrected mean motion [rad/s]
+    std::vector<double> d_M_0;
+    std::vector<double> d_ecc;
+    std::vector<double> d_sq1e2;  // sqrt(1 - ecc^2)
+    std::vector<double> d_omega;
+    std::vector<double> d_OMEGA_0;
+    std::vector<double> d_Omega_dot;           // OMEGAdot minus the Earth rotation rate
+    std::vector<double> d_earth_rotation_toe;  // Earth rotation rate times toe
+    std::vector<double> d_i_0;
+    std::vector<double> d_idot;
+    std::vector<double> d_Cuc;
+    std::vector<double> d_Cus;
+    std::vector<double> d_Crc;
+    std::vector<double> d_Crs;
+    std::vector<double> d_Cic;
+    std::vector<double> d_Cis;
+    std::vector<double> d_toe;
+    std::vector<double> d_toc;
+    std::vector<double> d_af0;
+    std::vector<double> d_af1;
+    std::vector<double> d_af2;
+    std::vector<double> d_relativistic;  // 2 sqrt(GM a)
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_EPHEMERIS_BATCH_H
@@ -0,0 +1,286 @@
+/*!
+ * \file gnss_nav_data_store.cc
+ * \brief Storage of the navigation data (ephemeris, almanac, iono and UTC
+ * models) in files, written on a background thread and read from a
+ * memory-mapped file
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_nav_data_store.h"
+#include <glog/logging.h>
+#include <array>        // for array
+#include <cstdio>       // for rename, remove
+#include <cstring>      // for memcmp
+#include <exception>    // for exception
+#include <fcntl.h>      // for open
+#include <fstream>      // for ofstream
+#include <streambuf>    // for streambuf
+#include <sys/mman.h>   // for mmap, munmap
+#include <sys/stat.h>   // for fstat
+#include <sys/types.h>  // for off_t
+#include <unistd.h>     // for close, read
+#include <vector>       // for vector
+
+namespace
+{
+// "GSND" and the version of the layout of the files, which must be
+// incremented when any of the navigation data classes change
+const std::array<char, 8> NAV_DATA_STORE_MAGIC{'G', 'S', 'N', 'D', 0, 0, 0, 2};
+
+
+// Read-only stream buffer over a file mapped in memory, or read into memory
+// if it cannot be mapped
+class Nav_Data_Store_Mapped_File : public std::streambuf
+{
+public:
+    explicit Nav_Data_Store_Mapped_File(const std::string& filename)
+    {
+        const int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0)
+            {
+                return;
+            }
+        struct stat st
+        {
+        };
+        if (::fstat(fd, &st) == 0 and st.st_size > 0)
+            {
+                d_size = static_cast<size_t>(st.st_size);
+                void* map = ::mmap(nullptr, d_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (map != MAP_FAILED)
+                    {
+                        d_map = map;
+                        d_data = static_cast<char*>(map);
+                    }
+                else
+                    {
+                        d_buffer.resize(d_size);
+                        size_t done = 0;
+                        while (done < d_size)
+                            {
+                                const ssize_t n = ::read(fd, d_buffer.data() + done, d_size - done);
+                                if (n <= 0)
+                                    {
+                                        break;
+                                    }
+                                done += static_cast<size_t>(n);
+                            }
+                        d_size = done;
+                        d_data = d_buffer.data();
+                    }
+            }
+        ::close(fd);
+        if (d_data != nullptr)
+            {
+                setg(d_data, d_data, d_data + d_size);
+            }
+    }
+
+    ~Nav_Data_Store_Mapped_File() override
+    {
+        if (d_map != nullptr)
+            {
+                ::munmap(d_map, d_size);
+            }
+    }
+
+    Nav_Data_Store_Mapped_File(const Nav_Data_Store_Mapped_File&) = delete;
+    Nav_Data_Store_Mapped_File& operator=(const Nav_Data_Store_Mapped_File&) = delete;
+
+    const char* data() const { return d_data; }
+    size_t size() const { return d_data == nullptr ? 0 : d_size; }
+
+    // starts the stream at offset
+    void skip(size_t offset) { setg(d_data, d_data + offset, d_data + d_size); }
+
+private:
+    std::vector<char> d_buffer;
+    void* d_map{nullptr};
+    char* d_data{nullptr};
+    size_t d_size{0};
+};
+}  // namespace
+
+
+Gnss_Nav_Data_Store::Gnss_Nav_Data_Store(bool binary)
+    : d_binary(binary)
+{
+    d_thread = std::thread(&Gnss_Nav_Data_Store::run, this);
+}
+
+
+Gnss_Nav_Data_Store::~Gnss_Nav_Data_Store()
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_stop = true;
+    }
+    d_cv.notify_one();
+    if (d_thread.joinable())
+        {
+            d_thread.join();
+        }
+}
+
+
+void Gnss_Nav_Data_Store::enqueue(const std::string& filename, std::function<bool()> job)
+{
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        auto& pending = d_pending[filename];
+        if (pending)
+            {
+                d_coalesced++;
+            }
+        pending = std::move(job);
+    }
+    d_cv.notify_one();
+}
+
+
+void Gnss_Nav_Data_Store::flush()
+{
+    std::unique_lock<std::mutex> lock(d_mutex);
+    d_idle_cv.wait(lock, [this] { return d_pending.empty() and !d_writing; });
+}
+
+
+uint64_t Gnss_Nav_Data_Store::written() const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_written;
+}
+
+
+uint64_t Gnss_Nav_Data_Store::failed() const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_failed;
+}
+
+
+uint64_t Gnss_Nav_Data_Store::coalesced() const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_coalesced;
+}
+
+
+void Gnss_Nav_Data_Store::run()
+{
+    std::unique_lock<std::mutex> lock(d_mutex);
+    while (true)
+        {
+            d_cv.wait(lock, [this] { return d_stop or !d_pending.empty(); });
+            if (d_pending.empty())
+                {
+                    // stopped, and all the files written
+                    break;
+                }
+            const auto next = d_pending.begin();
+            const std::string filename = next->first;
+            const std::function<bool()> job = std::move(next->second);
+            d_pending.erase(next);
+            d_writing = true;
+            lock.unlock();
+            const bool ok = job();
+            if (!ok)
+                {
+                    LOG(WARNING) << "Failed to store the navigation data in " << filename;
+                }
+            lock.lock();
+            d_writing = false;
+            if (ok)
+                {
+                    d_written++;
+                }
+            else
+                {
+                    d_failed++;
+                }
+            if (d_pending.empty())
+                {
+                    d_idle_cv.notify_all();
+                }
+        }
+    d_idle_cv.notify_all();
+}
+
+
+bool Gnss_Nav_Data_Store::write_file(const std::string& filename, bool binary, const std::function<void(std::ostream&)>& writer)
+{
+    // write a temporary file and rename it, so that a power cut while
+    // writing never leaves a truncated file
+    const std::string tmp_filename = filename + ".tmp";
+    try
+        {
+            std::ofstream ofs(tmp_filename, std::ofstream::binary | std::ofstream::trunc);
+            if (!ofs.is_open())
+                {
+                    return false;
+                }
+            if (binary)
+                {
+                    ofs.write(NAV_DATA_STORE_MAGIC.data(), NAV_DATA_STORE_MAGIC.size());
+                }
+            writer(ofs);
+            ofs.close();
+            if (ofs.fail())
+                {
+                    std::remove(tmp_filename.c_str());
+                    return false;
+                }
+        }
+    catch (const std::exception& e)
+        {
+            LOG(WARNING) << "Navigation data not written to " << filename << ": " << e.what();
+            std::remove(tmp_filename.c_str());
+            return false;
+        }
+    return std::rename(tmp_filename.c_str(), filename.c_str()) == 0;
+}
+
+
+bool Gnss_Nav_Data_Store::read_file(const std::string& filename, const std::function<void(std::istream&, Gnss_Nav_Data_Encoding)>& reader)
+{
+    Nav_Data_Store_Mapped_File file(filename);
+    if (file.size() == 0)
+        {
+            return false;
+        }
+    Gnss_Nav_Data_Encoding encoding = Gnss_Nav_Data_Encoding::boost_binary;
+    if (file.size() >= NAV_DATA_STORE_MAGIC.size() and std::memcmp(file.data(), NAV_DATA_STORE_MAGIC.data(), 4) == 0)
+        {
+            if (std::memcmp(file.data(), NAV_DATA_STORE_MAGIC.data(), NAV_DATA_STORE_MAGIC.size()) != 0)
+                {
+                    LOG(WARNING) << "The navigation data in " << filename << " are of another version";
+                    return false;
+                }
+            encoding = Gnss_Nav_Data_Encoding::binary;
+            file.skip(NAV_DATA_STORE_MAGIC.size());
+        }
+    else if (file.data()[0] == '<')
+        {
+            encoding = Gnss_Nav_Data_Encoding::xml;
+        }
+    std::istream is(&file);
+    try
+        {
+            reader(is, encoding);
+        }
+    catch (const std::exception& e)
+        {
+            LOG(WARNING) << "Navigation data not read from " << filename << ": " << e.what();
+            return false;
+        }
+    return true;
+}
@@ -0,0 +1,197 @@
+/*!
+ * \file gnss_nav_data_store.h
+ * \brief Storage of the navigation data (ephemeris, almanac, iono and UTC
+ * models) in files, written on a background thread and read from a
+ * memory-mapped file
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_GNSS_NAV_DATA_STORE_H
+#define GNSS_SDR_GNSS_NAV_DATA_STORE_H
+
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/archive/xml_iarchive.hpp>
+#include <boost/archive/xml_oarchive.hpp>
+#include <boost/serialization/map.hpp>
+#include <boost/serialization/nvp.hpp>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <utility>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup System_Parameters
+ * \{ */
+
+
+/*!
+ * \brief Encodings of the navigation data files
+ */
+enum class Gnss_Nav_Data_Encoding
+{
+    xml,           //!< Boost XML archive, as written by the former versions
+    binary,        //!< "GSND" and the version of the layout, followed by a Boost binary archive without header
+    boost_binary,  //!< Boost binary archive with its header, as written by the former rinex2assist --binary
+};
+
+
+/*!
+ * \brief Writes the navigation data to files and reads them back.
+ *
+ * The versioned binary encoding is several times smaller and faster to
+ * write and read than the XML archives. Its magic word carries the version
+ * of the layout of the navigation data classes, and the files of any other
+ * version are rejected instead of being misread. The binary files are not
+ * portable between hosts of different endianness; use the XML encoding to
+ * exchange them.
+ *
+ * store() copies the data and returns: the file is written by the thread of
+ * the store, which keeps only the latest copy of each file pending, so that
+ * a burst of updates costs a single write. The files are replaced
+ * atomically, and the destructor writes the pending ones.
+ *
+ * load_file() reads any of the encodings from a memory-mapped file.
+ */
+class Gnss_Nav_Data_Store
+{
+public:
+    //! Stores the files in the versioned binary encoding, or in XML
+    explicit Gnss_Nav_Data_Store(bool binary = true);
+    ~Gnss_Nav_Data_Store();
+
+    Gnss_Nav_Data_Store(const Gnss_Nav_Data_Store&) = delete;
+    Gnss_Nav_Data_Store& operator=(const Gnss_Nav_Data_Store&) = delete;
+
+    /*!
+     * \brief Writes a copy of data to filename, with the nvp name, on the
+     * thread of the store. Replaces any pending copy of the same file.
+     */
+    template <class T>
+    void store(const std::string& filename, const std::string& name, const T& data)
+    {
+        const auto copy = std::make_shared<const T>(data);
+        const bool binary = d_binary;
+        enqueue(filename, [filename, name, copy, binary]() { return save_file(filename, name.c_str(), *copy, binary); });
+    }
+
+    void flush();  //!< Waits until the pending files are written
+
+    bool binary() const { return d_binary; }
+    uint64_t written() const;    //!< Files written
+    uint64_t failed() const;     //!< Files that could not be written
+    uint64_t coalesced() const;  //!< Copies replaced by a newer one before being written
+
+    /*!
+     * \brief Writes data to filename, replacing it atomically, in the
+     * calling thread. Returns false on error.
+     */
+    template <class T>
+    static bool save_file(const std::string& filename, const char* name, const T& data, bool binary)
+    {
+        return write_file(filename, binary, [&](std::ostream& os) {
+            if (binary)
+                {
+                    boost::archive::binary_oarchive archive(os, boost::archive::no_header);
+                    archive << boost::serialization::make_nvp(name, data);
+                }
+            else
+                {
+                    boost::archive::xml_oarchive archive(os);
+                    archive << boost::serialization::make_nvp(name, data);
+                }
+        });
+    }
+
+    /*!
+     * \brief Reads data from filename, in any of the encodings. Returns
+     * false if the file does not exist, cannot be decoded or is a binary
+     * file of another version, leaving data untouched.
+     */
+    template <class T>
+    static bool load_file(const std::string& filename, const char* name, T& data)
+    {
+        T loaded{};
+        const bool ok = read_file(filename, [&](std::istream& is, Gnss_Nav_Data_Encoding encoding) {
+            switch (encoding)
+                {
+                case Gnss_Nav_Data_Encoding::xml:
+                    {
+                        boost::archive::xml_iarchive archive(is);
+                        archive >> boost::serialization::make_nvp(name, loaded);
+                        break;
+                    }
+                case Gnss_Nav_Data_Encoding::binary:
+                    {
+                        boost::archive::binary_iarchive archive(is, boost::archive::no_header);
+                        archive >> boost::serialization::make_nvp(name, loaded);
+                        break;
+                    }
+                case Gnss_Nav_Data_Encoding::boost_binary:
+                    {
+                        boost::archive::binary_iarchive archive(is);
+                        archive >> boost::serialization::make_nvp(name, loaded);
+                        break;
+                    }
+                }
+        });
+        if (ok)
+            {
+                data = std::move(loaded);
+            }
+        return ok;
+    }
+
+    /*!
+     * \brief Replaces filename atomically with what writer writes, after the
+     * magic word of the versioned binary encoding if binary. Returns false on
+     * error, or if writer throws.
+     */
+    static bool write_file(const std::string& filename, bool binary, const std::function<void(std::ostream&)>& writer);
+
+    /*!
+     * \brief Maps filename in memory, detects its encoding and calls reader
+     * with a stream over the archive. Returns false on error, or if reader
+     * throws.
+     */
+    static bool read_file(const std::string& filename, const std::function<void(std::istream&, Gnss_Nav_Data_Encoding)>& reader);
+
+private:
+    void enqueue(const std::string& filename, std::function<bool()> job);
+    void run();
+
+    std::map<std::string, std::function<bool()>> d_pending;  // by file name
+    std::thread d_thread;
+    mutable std::mutex d_mutex;
+    std::condition_variable d_cv;
+    std::condition_variable d_idle_cv;
+    uint64_t d_written{0};
+    uint64_t d_failed{0};
+    uint64_t d_coalesced{0};
+    bool d_binary;
+    bool d_writing{false};
+    bool d_stop{false};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_NAV_DATA_STORE_H
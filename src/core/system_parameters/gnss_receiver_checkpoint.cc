@@ -0,0 +1,65 @@
+/*!
+ * \file gnss_receiver_checkpoint.cc
+ * \brief Checkpoint of the receiver state at a sample of a recording, to
+ * resume its processing from there
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_receiver_checkpoint.h"
+#include "gnss_nav_data_store.h"
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <array>    // for array
+#include <istream>  // for istream
+#include <ostream>  // for ostream
+#include <utility>  // for move
+
+namespace
+{
+// "GSRC" and the version of the checkpoint layout, which must be incremented
+// when the layout or any of the navigation data classes change
+const std::array<char, 8> RECEIVER_CHECKPOINT_MAGIC{'G', 'S', 'R', 'C', 0, 0, 0, 2};
+}  // namespace
+
+
+bool Gnss_Receiver_Checkpoint::save(const std::string& filename) const
+{
+    return Gnss_Nav_Data_Store::write_file(filename, false, [this](std::ostream& os) {
+        os.write(RECEIVER_CHECKPOINT_MAGIC.data(), RECEIVER_CHECKPOINT_MAGIC.size());
+        boost::archive::binary_oarchive archive(os, boost::archive::no_header);
+        archive << *this;
+    });
+}
+
+
+bool Gnss_Receiver_Checkpoint::load(const std::string& filename)
+{
+    Gnss_Receiver_Checkpoint checkpoint;
+    bool is_checkpoint = false;
+    const bool ok = Gnss_Nav_Data_Store::read_file(filename, [&checkpoint, &is_checkpoint](std::istream& is, Gnss_Nav_Data_Encoding /*encoding*/) {
+        std::array<char, 8> magic{};
+        is.read(magic.data(), magic.size());
+        if (!is or magic != RECEIVER_CHECKPOINT_MAGIC)
+            {
+                return;
+            }
+        boost::archive::binary_iarchive archive(is, boost::archive::no_header);
+        archive >> checkpoint;
+        is_checkpoint = true;
+    });
+    if (!ok or !is_checkpoint)
+        {
+            return false;
+        }
+    *this = std::move(checkpoint);
+    return true;
+}
@@ -0,0 +1,119 @@
+/*!
+ * \file gnss_receiver_checkpoint.h
+ * \brief Checkpoint of the receiver state at a sample of a recording, to
+ * resume its processing from there
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_GNSS_RECEIVER_CHECKPOINT_H
+#define GNSS_SDR_GNSS_RECEIVER_CHECKPOINT_H
+
+#include "gnss_receiver_snapshot.h"
+#include <boost/serialization/nvp.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/vector.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup System_Parameters
+ * \{ */
+
+
+/*!
+ * \brief Tracking state of a channel at the checkpoint
+ */
+class Gnss_Channel_Checkpoint
+{
+public:
+    Gnss_Channel_Checkpoint() = default;
+
+    std::string System;             //!< System, as in Gnss_Satellite::get_system()
+    std::string Signal;             //!< Signal, as in Gnss_Signal::get_signal_str()
+    uint32_t PRN{};                 //!< PRN of the satellite
+    uint64_t code_epoch_samples{};  //!< Start of a code period [samples since the start of the recording]
+    double Carrier_Doppler_hz{};    //!< Carrier Doppler shift [Hz], including the receiver clock drift
+    double CN0_dB_hz{};             //!< Carrier-to-noise density ratio [dB-Hz]
+
+    template <class Archive>
+    void serialize(Archive& archive, const unsigned int version)
+    {
+        if (version)
+            {
+            };
+        archive& BOOST_SERIALIZATION_NVP(System);
+        archive& BOOST_SERIALIZATION_NVP(Signal);
+        archive& BOOST_SERIALIZATION_NVP(PRN);
+        archive& BOOST_SERIALIZATION_NVP(code_epoch_samples);
+        archive& BOOST_SERIALIZATION_NVP(Carrier_Doppler_hz);
+        archive& BOOST_SERIALIZATION_NVP(CN0_dB_hz);
+    }
+};
+
+
+/*!
+ * \brief Checkpoint of the processing of a recording: the receiver snapshot
+ * (navigation data, last position fix and receiver clock drift) and the
+ * code epochs and Doppler shifts of the tracked satellites, at a sample of
+ * the recording.
+ *
+ * A run resumed from the checkpoint skips the samples before sample_stamp
+ * and starts tracking the satellites at their code epochs, without
+ * acquisition. The tracking loops, the bit synchronization and the
+ * observables start again from there, so the resumed run only has to wait
+ * for the time of week of the navigation messages, not for the
+ * acquisitions and the ephemerides.
+ */
+class Gnss_Receiver_Checkpoint
+{
+public:
+    Gnss_Receiver_Checkpoint() = default;
+
+    /*!
+     * \brief Writes the checkpoint to filename, replacing it atomically.
+     * Returns false on error.
+     */
+    bool save(const std::string& filename) const;
+
+    /*!
+     * \brief Reads the checkpoint from filename. Returns false if the file
+     * does not exist or it is not a checkpoint of this version.
+     */
+    bool load(const std::string& filename);
+
+    Gnss_Receiver_Snapshot state;                   //!< Navigation data, last position fix and receiver clock drift
+    std::vector<Gnss_Channel_Checkpoint> channels;  //!< Tracked satellites
+    std::string source_filename;                    //!< Recording
+    int64_t fs{};                                   //!< Sampling rate of the tracking [Hz]
+    uint64_t sample_stamp{};                        //!< Where the processing resumes [samples at fs since the start of the recording], not after any code epoch of the channels
+
+    template <class Archive>
+    void serialize(Archive& archive, const unsigned int version)
+    {
+        if (version)
+            {
+            };
+        archive& BOOST_SERIALIZATION_NVP(source_filename);
+        archive& BOOST_SERIALIZATION_NVP(fs);
+        archive& BOOST_SERIALIZATION_NVP(sample_stamp);
+        archive& BOOST_SERIALIZATION_NVP(channels);
+        archive& BOOST_SERIALIZATION_NVP(state);
+    }
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_RECEIVER_CHECKPOINT_H
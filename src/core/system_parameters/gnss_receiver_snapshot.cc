@@ -0,0 +1,73 @@
+/*!
+ * \file gnss_receiver_snapshot.cc
+ * \brief Snapshot of the navigation data, the last position and the tracked
+ * satellites of the receiver, stored to speed up the next startup
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_receiver_snapshot.h"
+#include "gnss_nav_data_store.h"
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <array>    // for array
+#include <chrono>   // for system_clock
+#include <istream>  // for istream
+#include <ostream>  // for ostream
+#include <utility>  // for move
+
+namespace
+{
+// "GSRS" and the version of the snapshot layout, which must be incremented
+// when the layout or any of the navigation data classes change
+const std::array<char, 8> RECEIVER_SNAPSHOT_MAGIC{'G', 'S', 'R', 'S', 0, 0, 0, 2};
+}  // namespace
+
+
+bool Gnss_Receiver_Snapshot::save(const std::string& filename) const
+{
+    return Gnss_Nav_Data_Store::write_file(filename, false, [this](std::ostream& os) {
+        os.write(RECEIVER_SNAPSHOT_MAGIC.data(), RECEIVER_SNAPSHOT_MAGIC.size());
+        boost::archive::binary_oarchive archive(os, boost::archive::no_header);
+        archive << *this;
+    });
+}
+
+
+bool Gnss_Receiver_Snapshot::load(const std::string& filename)
+{
+    Gnss_Receiver_Snapshot state;
+    bool is_snapshot = false;
+    const bool ok = Gnss_Nav_Data_Store::read_file(filename, [&state, &is_snapshot](std::istream& is, Gnss_Nav_Data_Encoding /*encoding*/) {
+        std::array<char, 8> magic{};
+        is.read(magic.data(), magic.size());
+        if (!is or magic != RECEIVER_SNAPSHOT_MAGIC)
+            {
+                return;
+            }
+        boost::archive::binary_iarchive archive(is, boost::archive::no_header);
+        archive >> state;
+        is_snapshot = true;
+    });
+    if (!ok or !is_snapshot)
+        {
+            return false;
+        }
+    *this = std::move(state);
+    return true;
+}
+
+
+double Gnss_Receiver_Snapshot::age_s() const
+{
+    const double now_s = std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+    return now_s - time_s;
+}
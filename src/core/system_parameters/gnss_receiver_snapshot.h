@@ -0,0 +1,170 @@
+/*!
+ * \file gnss_receiver_snapshot.h
+ * \brief Snapshot of the navigation data, the last position and the tracked
+ * satellites of the receiver, stored to speed up the next startup
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_GNSS_RECEIVER_SNAPSHOT_H
+#define GNSS_SDR_GNSS_RECEIVER_SNAPSHOT_H
+
+#include "beidou_dnav_almanac.h"
+#include "beidou_dnav_ephemeris.h"
+#include "beidou_dnav_utc_model.h"
+#include "galileo_almanac.h"
+#include "galileo_ephemeris.h"
+#include "galileo_iono.h"
+#include "galileo_utc_model.h"
+#include "glonass_gnav_ephemeris.h"
+#include "glonass_gnav_utc_model.h"
+#include "gps_almanac.h"
+#include "gps_cnav_ephemeris.h"
+#include "gps_ephemeris.h"
+#include "gps_iono.h"
+#include "gps_utc_model.h"
+#include <boost/serialization/map.hpp>
+#include <boost/serialization/nvp.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/vector.hpp>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup System_Parameters
+ * \{ */
+
+
+/*!
+ * \brief Satellite tracked by a channel when the snapshot was taken
+ */
+class Gnss_Channel_Snapshot
+{
+public:
+    Gnss_Channel_Snapshot() = default;
+
+    std::string System;           //!< System, as in Gnss_Satellite::get_system()
+    std::string Signal;           //!< Signal, as in Gnss_Signal::get_signal_str()
+    uint32_t PRN{};               //!< PRN of the satellite
+    double Carrier_Doppler_hz{};  //!< Carrier Doppler shift [Hz], including the receiver clock drift
+    double CN0_dB_hz{};           //!< Carrier-to-noise density ratio [dB-Hz]
+
+    template <class Archive>
+    void serialize(Archive& archive, const unsigned int version)
+    {
+        if (version)
+            {
+            };
+        archive& BOOST_SERIALIZATION_NVP(System);
+        archive& BOOST_SERIALIZATION_NVP(Signal);
+        archive& BOOST_SERIALIZATION_NVP(PRN);
+        archive& BOOST_SERIALIZATION_NVP(Carrier_Doppler_hz);
+        archive& BOOST_SERIALIZATION_NVP(CN0_dB_hz);
+    }
+};
+
+
+/*!
+ * \brief Snapshot of the state of the receiver: navigation data, last
+ * position fix, receiver clock drift and tracked satellites.
+ *
+ * It is stored in a binary file, which is read in a few milliseconds at
+ * startup to assist the acquisition and the PVT solver.
+ */
+class Gnss_Receiver_Snapshot
+{
+public:
+    Gnss_Receiver_Snapshot() = default;
+
+    /*!
+     * \brief Writes the snapshot to filename, replacing it atomically.
+     * Returns false on error.
+     */
+    bool save(const std::string& filename) const;
+
+    /*!
+     * \brief Reads the snapshot from filename. Returns false if the file
+     * does not exist or it is not a snapshot of this version.
+     */
+    bool load(const std::string& filename);
+
+    /*!
+     * \brief Age of the snapshot [s], with respect to the system clock
+     */
+    double age_s() const;
+
+    std::map<int, Gps_Ephemeris> gps_ephemeris_map;
+    std::map<int, Gps_CNAV_Ephemeris> gps_cnav_ephemeris_map;
+    std::map<int, Gps_Almanac> gps_almanac_map;
+    Gps_Iono gps_iono;
+    Gps_Utc_Model gps_utc_model;
+
+    std::map<int, Galileo_Ephemeris> galileo_ephemeris_map;
+    std::map<int, Galileo_Almanac> galileo_almanac_map;
+    Galileo_Iono galileo_iono;
+    Galileo_Utc_Model galileo_utc_model;
+
+    std::map<int, Glonass_Gnav_Ephemeris> glonass_gnav_ephemeris_map;
+    Glonass_Gnav_Utc_Model glonass_gnav_utc_model;
+
+    std::map<int, Beidou_Dnav_Ephemeris> beidou_dnav_ephemeris_map;
+    std::map<int, Beidou_Dnav_Almanac> beidou_dnav_almanac_map;
+    Beidou_Dnav_Utc_Model beidou_dnav_utc_model;
+
+    std::vector<Gnss_Channel_Snapshot> channels;  //!< Tracked satellites
+
+    double time_s{};           //!< System time of the snapshot [s since the Unix epoch]
+    double latitude_deg{};     //!< Latitude of the last position fix [deg]
+    double longitude_deg{};    //!< Longitude of the last position fix [deg]
+    double height_m{};         //!< Height of the last position fix [m]
+    int64_t pvt_utc_time{};    //!< UTC time of the last position fix [s since the Unix epoch]
+    double clock_drift_ppm{};  //!< Receiver clock drift [ppm]
+    bool pvt_valid{};          //!< Whether there is a position fix
+
+    template <class Archive>
+    void serialize(Archive& archive, const unsigned int version)
+    {
+        if (version)
+            {
+            };
+        archive& BOOST_SERIALIZATION_NVP(time_s);
+        archive& BOOST_SERIALIZATION_NVP(pvt_valid);
+        archive& BOOST_SERIALIZATION_NVP(latitude_deg);
+        archive& BOOST_SERIALIZATION_NVP(longitude_deg);
+        archive& BOOST_SERIALIZATION_NVP(height_m);
+        archive& BOOST_SERIALIZATION_NVP(pvt_utc_time);
+        archive& BOOST_SERIALIZATION_NVP(clock_drift_ppm);
+        archive& BOOST_SERIALIZATION_NVP(gps_ephemeris_map);
+        archive& BOOST_SERIALIZATION_NVP(gps_cnav_ephemeris_map);
+        archive& BOOST_SERIALIZATION_NVP(gps_almanac_map);
+        archive& BOOST_SERIALIZATION_NVP(gps_iono);
+        archive& BOOST_SERIALIZATION_NVP(gps_utc_model);
+        archive& BOOST_SERIALIZATION_NVP(galileo_ephemeris_map);
+        archive& BOOST_SERIALIZATION_NVP(galileo_almanac_map);
+        archive& BOOST_SERIALIZATION_NVP(galileo_iono);
+        archive& BOOST_SERIALIZATION_NVP(galileo_utc_model);
+        archive& BOOST_SERIALIZATION_NVP(glonass_gnav_ephemeris_map);
+        archive& BOOST_SERIALIZATION_NVP(glonass_gnav_utc_model);
+        archive& BOOST_SERIALIZATION_NVP(beidou_dnav_ephemeris_map);
+        archive& BOOST_SERIALIZATION_NVP(beidou_dnav_almanac_map);
+        archive& BOOST_SERIALIZATION_NVP(beidou_dnav_utc_model);
+        archive& BOOST_SERIALIZATION_NVP(channels);
+    }
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_RECEIVER_SNAPSHOT_H
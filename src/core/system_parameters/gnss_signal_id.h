@@ -0,0 +1,139 @@
+/*!
+ * \file gnss_signal_id.h
+ * \brief Numeric identifiers of the signals processed by the receiver
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+
+#ifndef GNSS_SDR_GNSS_SIGNAL_ID_H
+#define GNSS_SDR_GNSS_SIGNAL_ID_H
+
+#include "gnss_synchro.h"
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup System_Parameters
+ * \{ */
+
+
+/*!
+ * \brief Signals processed by the receiver, identified by their system and
+ * their two-character signal code
+ */
+enum Gnss_Signal_Id
+{
+    SIGNAL_UNKNOWN,
+    SIGNAL_GPS_1C,
+    SIGNAL_GPS_2S,
+    SIGNAL_GPS_L5,
+    SIGNAL_SBAS_1C,
+    SIGNAL_GAL_1B,
+    SIGNAL_GAL_5X,
+    SIGNAL_GAL_E6,
+    SIGNAL_GAL_7X,
+    SIGNAL_GLO_1G,
+    SIGNAL_GLO_2G,
+    SIGNAL_BDS_B1,
+    SIGNAL_BDS_B2,
+    SIGNAL_BDS_B3
+};
+
+
+/*!
+ * \brief Returns the identifier of the signal given by its system ('G', 'S',
+ * 'E', 'R' or 'C') and its signal code (e.g., "1C"), without building any
+ * string
+ */
+inline Gnss_Signal_Id gnss_signal_id(char system, const char* signal)
+{
+    switch (system)
+        {
+        case 'G':
+            if (signal[0] == '1' && signal[1] == 'C')
+                {
+                    return SIGNAL_GPS_1C;
+                }
+            if (signal[0] == '2' && signal[1] == 'S')
+                {
+                    return SIGNAL_GPS_2S;
+                }
+            if (signal[0] == 'L' && signal[1] == '5')
+                {
+                    return SIGNAL_GPS_L5;
+                }
+            return SIGNAL_UNKNOWN;
+        case 'S':
+            if (signal[0] == '1' && signal[1] == 'C')
+                {
+                    return SIGNAL_SBAS_1C;
+                }
+            return SIGNAL_UNKNOWN;
+        case 'E':
+            if (signal[0] == '1' && signal[1] == 'B')
+                {
+                    return SIGNAL_GAL_1B;
+                }
+            if (signal[0] == '5' && signal[1] == 'X')
+                {
+                    return SIGNAL_GAL_5X;
+                }
+            if (signal[0] == 'E' && signal[1] == '6')
+                {
+                    return SIGNAL_GAL_E6;
+                }
+            if (signal[0] == '7' && signal[1] == 'X')
+                {
+                    return SIGNAL_GAL_7X;
+                }
+            return SIGNAL_UNKNOWN;
+        case 'R':
+            if (signal[0] == '1' && signal[1] == 'G')
+                {
+                    return SIGNAL_GLO_1G;
+                }
+            if (signal[0] == '2' && signal[1] == 'G')
+                {
+                    return SIGNAL_GLO_2G;
+                }
+            return SIGNAL_UNKNOWN;
+        case 'C':
+            if (signal[0] == 'B' && signal[1] == '1')
+                {
+                    return SIGNAL_BDS_B1;
+                }
+            if (signal[0] == 'B' && signal[1] == '2')
+                {
+                    return SIGNAL_BDS_B2;
+                }
+            if (signal[0] == 'B' && signal[1] == '3')
+                {
+                    return SIGNAL_BDS_B3;
+                }
+            return SIGNAL_UNKNOWN;
+        default:
+            return SIGNAL_UNKNOWN;
+        }
+}
+
+
+/*!
+ * \brief Returns the identifier of the signal of a Gnss_Synchro object
+ */
+inline Gnss_Signal_Id gnss_signal_id(const Gnss_Synchro& gnss_synchro)
+{
+    return gnss_signal_id(gnss_synchro.System, gnss_synchro.Signal);
+}
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SIGNAL_ID_H
@@ -21,6 +21,7 @@
 #define GNSS_SDR_GNSS_SYNCHRO_H
 
 #include <boost/serialization/nvp.hpp>
+#include <boost/serialization/version.hpp>
 #include <cstdint>
 #include <utility>
 
@@ -34,6 +35,11 @@
 /*!
  * \brief This is the class that contains the information that is shared
  * by the processing blocks.
+ *
+ * It is trivially copyable, so that the copies made at each stage of the
+ * processing chain (GNU Radio buffers, histories, maps) are plain memory
+ * copies, and its members are ordered so that there is no padding between
+ * them (160 bytes in the platforms supported).
  */
 class Gnss_Synchro
 {
@@ -49,10 +55,10 @@ public:
     int32_t Channel_ID{};  //!< Set by Channel constructor
 
     // Acquisition
+    uint32_t Acq_doppler_step{};         //!< Set by Acquisition processing block
     double Acq_delay_samples{};          //!< Set by Acquisition processing block
     double Acq_doppler_hz{};             //!< Set by Acquisition processing block
     uint64_t Acq_samplestamp_samples{};  //!< Set by Acquisition processing block
-    uint32_t Acq_doppler_step{};         //!< Set by Acquisition processing block
 
     // Tracking
     int64_t fs{};                        //!< Set by Tracking processing block
@@ -73,6 +79,11 @@ public:
     double RX_time{};        //!< Set by Observables processing block
     double interp_TOW_ms{};  //!< Set by Observables processing block
 
+    // Signal quality monitoring, if enabled (single precision fills the slack before the flags)
+    float SQM_delta{};      //!< Set by Tracking processing block
+    float SQM_ratio{};      //!< Set by Tracking processing block
+    float SQM_asymmetry{};  //!< Set by Tracking processing block
+
     // Flags
     bool Flag_valid_acquisition{};         //!< Set by Acquisition processing block
     bool Flag_valid_symbol_output{};       //!< Set by Tracking processing block
@@ -80,93 +91,6 @@ public:
     bool Flag_valid_pseudorange{};         //!< Set by Observables processing block
     bool Flag_PLL_180_deg_phase_locked{};  //!< Set by Telemetry Decoder processing block
 
-    /// Copy constructor
-    Gnss_Synchro(const Gnss_Synchro& other) noexcept
-    {
-        *this = other;
-    };
-
-    /// Copy assignment operator
-    Gnss_Synchro& operator=(const Gnss_Synchro& rhs) noexcept
-    {
-        // Only do assignment if RHS is a different object from this.
-        if (this != &rhs)
-            {
-                this->System = rhs.System;
-                this->Signal[0] = rhs.Signal[0];
-                this->Signal[1] = rhs.Signal[1];
-                this->Signal[2] = rhs.Signal[2];
-                this->PRN = rhs.PRN;
-                this->Channel_ID = rhs.Channel_ID;
-                this->Acq_delay_samples = rhs.Acq_delay_samples;
-                this->Acq_doppler_hz = rhs.Acq_doppler_hz;
-                this->Acq_samplestamp_samples = rhs.Acq_samplestamp_samples;
-                this->Acq_doppler_step = rhs.Acq_doppler_step;
-                this->fs = rhs.fs;
-                this->Prompt_I = rhs.Prompt_I;
-                this->Prompt_Q = rhs.Prompt_Q;
-                this->CN0_dB_hz = rhs.CN0_dB_hz;
-                this->Carrier_Doppler_hz = rhs.Carrier_Doppler_hz;
-                this->Carrier_phase_rads = rhs.Carrier_phase_rads;
-                this->Code_phase_samples = rhs.Code_phase_samples;
-                this->Tracking_sample_counter = rhs.Tracking_sample_counter;
-                this->correlation_length_ms = rhs.correlation_length_ms;
-                this->TOW_at_current_symbol_ms = rhs.TOW_at_current_symbol_ms;
-                this->Pseudorange_m = rhs.Pseudorange_m;
-                this->RX_time = rhs.RX_time;
-                this->interp_TOW_ms = rhs.interp_TOW_ms;
-                this->Flag_valid_acquisition = rhs.Flag_valid_acquisition;
-                this->Flag_valid_symbol_output = rhs.Flag_valid_symbol_output;
-                this->Flag_valid_word = rhs.Flag_valid_word;
-                this->Flag_valid_pseudorange = rhs.Flag_valid_pseudorange;
-                this->Flag_PLL_180_deg_phase_locked = rhs.Flag_PLL_180_deg_phase_locked;
-            }
-        return *this;
-    };
-
-    /// Move constructor
-    Gnss_Synchro(Gnss_Synchro&& other) noexcept
-    {
-        *this = std::move(other);
-    };
-
-    /// Move assignment operator
-    Gnss_Synchro& operator=(Gnss_Synchro&& other) noexcept
-    {
-        if (this != &other)
-            {
-                this->System = other.System;
-                this->Signal[0] = other.Signal[0];
-                this->Signal[1] = other.Signal[1];
-                this->Signal[2] = other.Signal[2];
-                this->PRN = other.PRN;
-                this->Channel_ID = other.Channel_ID;
-                this->Acq_delay_samples = other.Acq_delay_samples;
-                this->Acq_doppler_hz = other.Acq_doppler_hz;
-                this->Acq_samplestamp_samples = other.Acq_samplestamp_samples;
-                this->Acq_doppler_step = other.Acq_doppler_step;
-                this->fs = other.fs;
-                this->Prompt_I = other.Prompt_I;
-                this->Prompt_Q = other.Prompt_Q;
-                this->CN0_dB_hz = other.CN0_dB_hz;
-                this->Carrier_Doppler_hz = other.Carrier_Doppler_hz;
-                this->Carrier_phase_rads = other.Carrier_phase_rads;
-                this->Code_phase_samples = other.Code_phase_samples;
-                this->Tracking_sample_counter = other.Tracking_sample_counter;
-                this->correlation_length_ms = other.correlation_length_ms;
-                this->TOW_at_current_symbol_ms = other.TOW_at_current_symbol_ms;
-                this->Pseudorange_m = other.Pseudorange_m;
-                this->RX_time = other.RX_time;
-                this->interp_TOW_ms = other.interp_TOW_ms;
-                this->Flag_valid_acquisition = other.Flag_valid_acquisition;
-                this->Flag_valid_symbol_output = other.Flag_valid_symbol_output;
-                this->Flag_valid_word = other.Flag_valid_word;
-                this->Flag_valid_pseudorange = other.Flag_valid_pseudorange;
-                this->Flag_PLL_180_deg_phase_locked = other.Flag_PLL_180_deg_phase_locked;
-            }
-        return *this;
-    };
-
     /*!
      * \brief This member function serializes and restores
      * Gnss_Synchro objects from a byte stream.
@@ -175,9 +99,6 @@ public:
 
     void serialize(Archive& ar, const unsigned int version)
     {
-        if (version)
-            {
-            };
         // Satellite and signal info
         ar& BOOST_SERIALIZATION_NVP(System);
         ar& BOOST_SERIALIZATION_NVP(Signal);
@@ -210,9 +131,18 @@ public:
         ar& BOOST_SERIALIZATION_NVP(Flag_valid_word);
         ar& BOOST_SERIALIZATION_NVP(Flag_valid_pseudorange);
         ar& BOOST_SERIALIZATION_NVP(Flag_PLL_180_deg_phase_locked);
+        // Signal quality monitoring, appended in version 1
+        if (version > 0)
+            {
+                ar& BOOST_SERIALIZATION_NVP(SQM_delta);
+                ar& BOOST_SERIALIZATION_NVP(SQM_ratio);
+                ar& BOOST_SERIALIZATION_NVP(SQM_asymmetry);
+            }
     }
 };
 
+BOOST_CLASS_VERSION(Gnss_Synchro, 1)
+
 
 /** \} */
 /** \} */
@@ -16,9 +16,10 @@
  */
 
 #include "reed_solomon.h"
-#include <algorithm>
-#include <cstring>
-#include <iostream>
+#include <volk_gnsssdr/volk_gnsssdr.h>  // for volk_gnsssdr_8u_x2_gf256_mul_add_8u
+#include <algorithm>                    // for std::copy, std::fill
+#include <cstring>                      // for memcpy, memmove
+#include <iostream>                     // for std::cerr
 
 
 ReedSolomon::ReedSolomon(const std::string& gnss_signal)
@@ -648,6 +649,8 @@ void ReedSolomon::init_log_tables()
 
 void ReedSolomon::init_alpha_tables()
 {
+    d_syndrome_tables = std::vector<uint8_t>(32 * d_nroots, 0);
+
     // Generate Galois field lookup tables
     d_index_of[0] = d_a0;
     d_alpha_to[d_a0] = 0;
@@ -682,6 +685,12 @@ void ReedSolomon::init_alpha_tables()
         {
             d_genpoly_index[i] = d_index_of[d_genpoly_coeff[i]];
         }
+
+    // products by the roots of g(x), split in low and high nibbles
+    for (int i = 0; i < d_nroots; i++)
+        {
+            init_mul_table(d_alpha_to[mod255((d_fcr + i) * d_prim)], &d_syndrome_tables[32 * i]);
+        }
 }
 
 
@@ -808,84 +817,284 @@ int ReedSolomon::decode(std::vector<uint8_t>& data_to_decode, const std::vector<
 }
 
 
-int ReedSolomon::decode_rs_8(uint8_t* data, const int* eras_pos, int no_eras) const
+int ReedSolomon::decode_columns(std::vector<std::vector<uint8_t>>& matrix, const std::vector<int>& erasure_positions) const
 {
-    int deg_lambda;
-    int el;
-    int deg_omega;
-    int i;
-    int j;
-    int r;
-    int k;
-    int syn_error;
-    int count;
+    int result = -1;
+    if (erasure_positions.size() > std::size_t(d_nroots))
+        {
+            std::cerr << "Reed Solomon usage error: too much erasure positions.\n";
+            return result;
+        }
+    const size_t rows = matrix.size();
+    if ((rows != d_data_symbols_shortened) && (rows != static_cast<size_t>(d_symbols_per_block)))
+        {
+            std::cerr << "Reed Solomon usage error: wrong matrix size in decode_columns method.\n";
+            return result;
+        }
+    const size_t columns = matrix[0].size();
+    for (const auto& row : matrix)
+        {
+            if (row.size() != columns)
+                {
+                    std::cerr << "Reed Solomon usage error: wrong matrix size in decode_columns method.\n";
+                    return result;
+                }
+        }
 
-    uint8_t u;
-    uint8_t q;
-    uint8_t tmp;
-    uint8_t num1;
-    uint8_t num2;
-    uint8_t den;
-    uint8_t discr_r;
+    // Rows of the unshortened code, the shortened symbols being zeros
+    const std::vector<uint8_t> zeros(columns, 0);
+    std::vector<uint8_t*> code_rows(d_symbols_per_block, nullptr);
+    const bool shortened = (d_shortening != 0) && (rows != static_cast<size_t>(d_symbols_per_block));
+    for (size_t j = 0; j < rows; j++)
+        {
+            const size_t pos = (shortened && j >= d_info_symbols_shortened) ? j + d_shortening : j;
+            code_rows[pos] = matrix[j].data();
+        }
+    auto code_row = [&](int j) -> const uint8_t* { return code_rows[j] != nullptr ? code_rows[j] : zeros.data(); };
 
-    std::vector<uint8_t> lambda(d_nroots + 1);  // Err+Eras Locator poly
-    std::vector<uint8_t> s(d_nroots);           // syndrome poly
-    std::vector<uint8_t> b(d_nroots + 1);
-    std::vector<uint8_t> t(d_nroots + 1);
-    std::vector<uint8_t> omega(d_nroots + 1);
-    std::vector<uint8_t> root(d_nroots);
-    std::vector<uint8_t> reg(d_nroots + 1);
-    std::vector<uint8_t> loc(d_nroots);
+    // Syndromes of all the columns at once, one row per root of g(x). The
+    // multiplication by the root is the same for all the columns.
+    std::vector<uint8_t> syndromes(d_nroots * columns);
+    for (int i = 0; i < d_nroots; i++)
+        {
+            uint8_t* s = &syndromes[i * columns];
+            std::copy(code_row(0), code_row(0) + columns, s);
+            for (int j = 1; j < d_symbols_per_block - d_pad; j++)
+                {
+                    volk_gnsssdr_8u_x2_gf256_mul_add_8u(s, code_row(j), s, &d_syndrome_tables[32 * i], columns);
+                }
+        }
 
-    // Syndrome computation
-    // form the syndromes; i.e., evaluate data(x) at roots of g(x)
-    for (i = 0; i < d_nroots; i++)
+    // The erasure locator polynomial is shared by all the columns
+    const int no_eras = erasure_positions.size();
+    std::array<uint8_t, d_symbols_per_block + 1> eras_lambda{};
+    compute_erasure_locator(erasure_positions.data(), no_eras, eras_lambda.data());
+
+    // Columns with nonzero syndromes
+    std::vector<uint8_t> syn_error(columns, 0);
+    for (int i = 0; i < d_nroots; i++)
         {
-            s[i] = data[0];
+            for (size_t col = 0; col < columns; col++)
+                {
+                    syn_error[col] |= syndromes[i * columns + col];
+                }
         }
 
-    for (j = 1; j < d_symbols_per_block - d_pad; j++)
+    // The columns whose errors are all at the erasure positions have the
+    // erasure locator as error locator: all their discrepancies in the
+    // Berlekamp-Massey algorithm are zero. Their roots and error
+    // evaluator denominators are common, and their error values are linear
+    // in the syndromes, so they are computed in batch.
+    std::vector<uint8_t> erasures_only(columns, 0);
+    std::array<uint8_t, d_symbols_per_block + 1> lambda{};  // index form
+    std::array<uint8_t, d_symbols_per_block> root{};
+    std::array<uint8_t, d_symbols_per_block> loc{};
+    int deg_lambda = 0;
+    int count = 0;
+    std::vector<uint8_t> mul_tables(32 * (d_nroots + 1));
+    if (no_eras > 0)
         {
-            for (i = 0; i < d_nroots; i++)
+            for (int i = 0; i <= no_eras; i++)
+                {
+                    init_mul_table(eras_lambda[i], &mul_tables[32 * i]);
+                }
+            std::vector<uint8_t> discrepancies(columns, 0);
+            std::vector<uint8_t> discr_r(columns);
+            for (int r = no_eras + 1; r <= d_nroots; r++)
                 {
-                    if (s[i] == 0)
+                    std::copy(&syndromes[(r - 1) * columns], &syndromes[r * columns], discr_r.begin());
+                    for (int i = 1; i <= no_eras && i < r; i++)
                         {
-                            s[i] = data[j];
+                            volk_gnsssdr_8u_x2_gf256_mul_add_8u(discr_r.data(), discr_r.data(), &syndromes[(r - i - 1) * columns], &mul_tables[32 * i], columns);
                         }
-                    else
+                    for (size_t col = 0; col < columns; col++)
+                        {
+                            discrepancies[col] |= discr_r[col];
+                        }
+                }
+
+            // Find roots of the erasure locator polynomial by Chien search
+            std::array<uint8_t, d_symbols_per_block + 1> reg{};
+            for (int i = 0; i < d_nroots + 1; i++)
+                {
+                    lambda[i] = d_index_of[eras_lambda[i]];
+                    if (lambda[i] != d_a0)
+                        {
+                            deg_lambda = i;
+                        }
+                }
+            memcpy(&reg[1], &lambda[1], d_nroots * sizeof(reg[0]));
+            for (int i = 1, k = d_iprim - 1; i <= d_symbols_per_block; i++, k = mod255(k + d_iprim))
+                {
+                    uint8_t q = 1;  // lambda[0] is always 0
+                    for (int j = deg_lambda; j > 0; j--)
+                        {
+                            if (reg[j] != d_a0)
+                                {
+                                    reg[j] = mod255(reg[j] + j);
+                                    q ^= d_alpha_to[reg[j]];
+                                }
+                        }
+                    if (q != 0)
+                        {
+                            continue;
+                        }
+                    root[count] = i;
+                    loc[count] = k;
+                    if (++count == deg_lambda)
+                        {
+                            break;
+                        }
+                }
+            if (deg_lambda == count)
+                {
+                    for (size_t col = 0; col < columns; col++)
                         {
-                            s[i] = data[j] ^ d_alpha_to[mod255(d_index_of[s[i]] + (d_fcr + i) * d_prim)];
+                            erasures_only[col] = (syn_error[col] != 0) && (discrepancies[col] == 0);
                         }
                 }
         }
 
-    // Convert syndromes to index form, checking for nonzero condition
-    syn_error = 0;
-    for (i = 0; i < d_nroots; i++)
+    result = 0;
+    if (std::find(erasures_only.begin(), erasures_only.end(), 1) != erasures_only.end())
         {
-            syn_error |= s[i];
-            s[i] = d_index_of[s[i]];
+            // Error evaluator omega(x) = s(x) * lambda(x) (modulo x**d_nroots)
+            const int deg_omega = deg_lambda - 1;
+            std::vector<uint8_t> omega((deg_omega + 1) * columns);
+            for (int i = 0; i <= deg_omega; i++)
+                {
+                    uint8_t* omega_i = &omega[i * columns];
+                    std::copy(&syndromes[i * columns], &syndromes[(i + 1) * columns], omega_i);
+                    for (int j = 1; j <= i; j++)
+                        {
+                            volk_gnsssdr_8u_x2_gf256_mul_add_8u(omega_i, omega_i, &syndromes[(i - j) * columns], &mul_tables[32 * j], columns);
+                        }
+                }
+
+            // Error values, num1 = omega(inv(X(l))) evaluated with the Horner scheme
+            std::vector<uint8_t> num1(columns);
+            std::array<uint8_t, 32> root_table{};
+            for (int j = count - 1; j >= 0; j--)
+                {
+                    init_mul_table(d_alpha_to[mod255(root[j])], root_table.data());
+                    std::copy(&omega[deg_omega * columns], &omega[(deg_omega + 1) * columns], num1.begin());
+                    for (int i = deg_omega - 1; i >= 0; i--)
+                        {
+                            volk_gnsssdr_8u_x2_gf256_mul_add_8u(num1.data(), &omega[i * columns], num1.data(), root_table.data(), columns);
+                        }
+
+                    const uint8_t num2 = d_alpha_to[mod255(root[j] * (d_fcr - 1) + d_symbols_per_block)];
+                    uint8_t den = 0;
+                    // lambda[i+1] for i even is the formal derivative lambda_pr of lambda[i]
+                    for (int i = rs_min(deg_lambda, d_nroots - 1) & ~1; i >= 0; i -= 2)
+                        {
+                            if (lambda[i + 1] != d_a0)
+                                {
+                                    den ^= d_alpha_to[mod255(lambda[i + 1] + i * root[j])];
+                                }
+                        }
+
+                    // Apply error to data
+                    if (loc[j] < d_pad || code_rows[loc[j] - d_pad] == nullptr)
+                        {
+                            continue;
+                        }
+                    const int factor = mod255(d_index_of[num2] + d_symbols_per_block - d_index_of[den]);
+                    uint8_t* row = code_rows[loc[j] - d_pad];
+                    for (size_t col = 0; col < columns; col++)
+                        {
+                            if (erasures_only[col] && num1[col] != 0)
+                                {
+                                    row[col] ^= d_alpha_to[mod255(d_index_of[num1[col]] + factor)];
+                                }
+                        }
+                }
+            result += count * static_cast<int>(std::count(erasures_only.begin(), erasures_only.end(), 1));
         }
 
-    if (!syn_error)
+    // The other columns are decoded one by one
+    std::array<uint8_t, d_symbols_per_block> codeword{};
+    std::array<uint8_t, d_symbols_per_block> s{};
+    for (size_t col = 0; col < columns; col++)
         {
-            // if syndrome is zero, data[] is a codeword and there are no
-            // errors to correct. So return data[] unmodified
-            return 0;
+            if (erasures_only[col] || !syn_error[col])
+                {
+                    continue;
+                }
+            for (int i = 0; i < d_nroots; i++)
+                {
+                    s[i] = syndromes[i * columns + col];
+                }
+            for (int j = 0; j < d_symbols_per_block - d_pad; j++)
+                {
+                    codeword[j] = code_row(j)[col];
+                }
+            const int corrected = correct_rs_8(codeword.data(), s.data(), eras_lambda.data(), no_eras);
+            if (corrected < 0)
+                {
+                    return -1;
+                }
+            for (int j = 0; j < d_symbols_per_block - d_pad; j++)
+                {
+                    if (code_rows[j] != nullptr)
+                        {
+                            code_rows[j][col] = codeword[j];
+                        }
+                }
+            result += corrected;
+        }
+    return result;
+}
+
+
+void ReedSolomon::init_mul_table(uint8_t factor, uint8_t* table) const
+{
+    // products by factor of the low and high nibbles
+    table[0] = 0;
+    table[16] = 0;
+    for (int x = 1; x < 16; x++)
+        {
+            table[x] = (factor == 0) ? 0 : d_alpha_to[mod255(d_index_of[x] + d_index_of[factor])];
+            table[16 + x] = (factor == 0) ? 0 : d_alpha_to[mod255(d_index_of[x << 4] + d_index_of[factor])];
+        }
+}
+
+
+void ReedSolomon::compute_syndromes(const uint8_t* data, uint8_t* s) const
+{
+    // form the syndromes; i.e., evaluate data(x) at roots of g(x)
+    for (int i = 0; i < d_nroots; i++)
+        {
+            s[i] = data[0];
         }
 
+    for (int j = 1; j < d_symbols_per_block - d_pad; j++)
+        {
+            for (int i = 0; i < d_nroots; i++)
+                {
+                    // Horner step: s[i] = data[j] + s[i] * alpha^((d_fcr + i) * d_prim)
+                    const uint8_t* mul = &d_syndrome_tables[32 * i];
+                    s[i] = data[j] ^ mul[s[i] & 15] ^ mul[16 + (s[i] >> 4)];
+                }
+        }
+}
+
+
+void ReedSolomon::compute_erasure_locator(const int* eras_pos, int no_eras, uint8_t* lambda) const
+{
+    std::fill(lambda, lambda + d_nroots + 1, 0);
     lambda[0] = 1;
 
     if (no_eras > 0)
         {
             // Init lambda to be the erasure locator polynomial
             lambda[1] = d_alpha_to[mod255(d_prim * (d_symbols_per_block - 1 - eras_pos[0]))];
-            for (i = 1; i < no_eras; i++)
+            for (int i = 1; i < no_eras; i++)
                 {
-                    u = mod255(d_prim * (d_symbols_per_block - 1 - eras_pos[i]));
-                    for (j = i + 1; j > 0; j--)
+                    const uint8_t u = mod255(d_prim * (d_symbols_per_block - 1 - eras_pos[i]));
+                    for (int j = i + 1; j > 0; j--)
                         {
-                            tmp = d_index_of[lambda[j - 1]];
+                            const uint8_t tmp = d_index_of[lambda[j - 1]];
                             if (tmp != d_a0)
                                 {
                                     lambda[j] ^= d_alpha_to[mod255(u + tmp)];
@@ -893,6 +1102,65 @@ int ReedSolomon::decode_rs_8(uint8_t* data, const int* eras_pos, int no_eras) co
                         }
                 }
         }
+}
+
+
+int ReedSolomon::decode_rs_8(uint8_t* data, const int* eras_pos, int no_eras) const
+{
+    std::array<uint8_t, d_symbols_per_block> s{};                // syndrome poly
+    std::array<uint8_t, d_symbols_per_block + 1> eras_lambda{};  // Eras Locator poly
+
+    compute_syndromes(data, s.data());
+    compute_erasure_locator(eras_pos, no_eras, eras_lambda.data());
+
+    return correct_rs_8(data, s.data(), eras_lambda.data(), no_eras);
+}
+
+
+int ReedSolomon::correct_rs_8(uint8_t* data, uint8_t* s, const uint8_t* eras_lambda, int no_eras) const
+{
+    int deg_lambda;
+    int el;
+    int deg_omega;
+    int i;
+    int j;
+    int r;
+    int k;
+    int syn_error;
+    int count;
+
+    uint8_t q;
+    uint8_t tmp;
+    uint8_t num1;
+    uint8_t num2;
+    uint8_t den;
+    uint8_t discr_r;
+
+    // d_nroots < d_symbols_per_block, so all the polynomials fit in these arrays
+    std::array<uint8_t, d_symbols_per_block + 1> lambda{};  // Err+Eras Locator poly
+    std::array<uint8_t, d_symbols_per_block + 1> b{};
+    std::array<uint8_t, d_symbols_per_block + 1> t{};
+    std::array<uint8_t, d_symbols_per_block + 1> omega{};
+    std::array<uint8_t, d_symbols_per_block> root{};
+    std::array<uint8_t, d_symbols_per_block + 1> reg{};
+    std::array<uint8_t, d_symbols_per_block> loc{};
+
+    // Convert syndromes to index form, checking for nonzero condition
+    syn_error = 0;
+    for (i = 0; i < d_nroots; i++)
+        {
+            syn_error |= s[i];
+            s[i] = d_index_of[s[i]];
+        }
+
+    if (!syn_error)
+        {
+            // if syndrome is zero, data[] is a codeword and there are no
+            // errors to correct. So return data[] unmodified
+            return 0;
+        }
+
+    std::copy(eras_lambda, eras_lambda + d_nroots + 1, lambda.begin());
 
     for (i = 0; i < d_nroots + 1; i++)
         {
@@ -917,8 +1185,9 @@ int ReedSolomon::decode_rs_8(uint8_t* data, const int* eras_pos, int no_eras) co
             discr_r = d_index_of[discr_r];  // Index form
             if (discr_r == d_a0)
                 {
-                    // line below: B(x) <-- x*B(x)
-                    b.insert(b.begin(), d_a0);
+                    // 2 lines below: B(x) <-- x*B(x)
+                    memmove(&b[1], &b[0], d_nroots * sizeof(b[0]));
+                    b[0] = d_a0;
                 }
             else
                 {
@@ -946,8 +1215,9 @@ int ReedSolomon::decode_rs_8(uint8_t* data, const int* eras_pos, int no_eras) co
                         }
                     else
                         {
-                            // line below: B(x) <-- x*B(x)
-                            b.insert(b.begin(), d_a0);
+                            // 2 lines below: B(x) <-- x*B(x)
+                            memmove(&b[1], &b[0], d_nroots * sizeof(b[0]));
+                            b[0] = d_a0;
                         }
                     memcpy(&lambda[0], t.data(), (d_nroots + 1) * sizeof(t[0]));
                 }
@@ -101,6 +101,21 @@ public:
     int decode(std::vector<uint8_t>& data_to_decode,
         const std::vector<int>& erasure_positions = std::vector<int>{}) const;
 
+    /*!
+     * \brief Decode a batch of encoded blocks, stored as the columns of a
+     * matrix with 255 or 255-shortening rows, all with the same erasure
+     * positions (e.g., the pages of a Galileo HAS message).
+     *
+     * The syndromes of all the columns are computed at once with SIMD
+     * instructions, and the erasure locator polynomial is shared. The
+     * decoded symbols are at the first 255-nroots-shortening rows.
+     *
+     * Returns the total number of corrected errors, or -1 if the decoding
+     * of any column failed.
+     */
+    int decode_columns(std::vector<std::vector<uint8_t>>& matrix,
+        const std::vector<int>& erasure_positions = std::vector<int>{}) const;
+
     /*!
      * \brief Encode data with the generator matrix (for testing purposes)
      *
@@ -124,6 +139,10 @@ private:
     int mod255(int x) const;
     int rs_min(int a, int b) const;
     int decode_rs_8(uint8_t* data, const int* eras_pos, int no_eras) const;
+    int correct_rs_8(uint8_t* data, uint8_t* s, const uint8_t* eras_lambda, int no_eras) const;
+    void compute_syndromes(const uint8_t* data, uint8_t* s) const;
+    void compute_erasure_locator(const int* eras_pos, int no_eras, uint8_t* lambda) const;
+    void init_mul_table(uint8_t factor, uint8_t* table) const;  // nibble products for volk_gnsssdr_8u_x2_gf256_mul_add_8u
 
     uint8_t galois_mul(uint8_t a, uint8_t b) const;
     uint8_t galois_add(uint8_t a, uint8_t b) const;
@@ -141,6 +160,7 @@ private:
     std::vector<std::vector<uint8_t>> d_genmatrix;  // used for encoding
     std::vector<uint8_t> d_genpoly_coeff;           // used for encoding
     std::vector<uint8_t> d_genpoly_index;           // used for encoding
+    std::vector<uint8_t> d_syndrome_tables;         // used for decoding: products by the roots of g(x), 32 nibble products per root
 
     size_t d_data_in_block{};           // number of information symbols in a block
     size_t d_rows_G{};                  // number of rows of the generator matrix
@@ -0,0 +1,203 @@
+/*!
+ * \file gnss_sdr_batch.cc
+ * \brief Runs a queue of recordings through the receiver in a single process
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_batch.h"
+#include "control_thread.h"
+#include "file_configuration.h"
+#include "gnss_sdr_create_directory.h"
+#include "gnss_sdr_filesystem.h"
+#include <glog/logging.h>
+#include <chrono>     // for steady_clock
+#include <exception>  // for exception
+#include <fstream>    // for ifstream, ofstream
+#include <iomanip>    // for setw, setprecision
+#include <iostream>   // for cout, cerr
+#include <memory>     // for make_shared, unique_ptr
+#include <sstream>    // for istringstream
+
+
+namespace
+{
+double batch_seconds_since(const std::chrono::steady_clock::time_point& start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+
+double batch_throughput_mb_s(uint64_t bytes, double seconds)
+{
+    return seconds > 0.0 ? static_cast<double>(bytes) / 1e6 / seconds : 0.0;
+}
+}  // namespace
+
+
+bool Gnss_Sdr_Batch::read_job_file(const std::string& job_file)
+{
+    std::ifstream ifs(job_file);
+    if (!ifs.is_open())
+        {
+            std::cerr << "Cannot open the job file " << job_file << '\n';
+            return false;
+        }
+    jobs_.clear();
+    std::string line;
+    int line_number = 0;
+    while (std::getline(ifs, line))
+        {
+            line_number++;
+            std::istringstream iss(line);
+            Gnss_Sdr_Batch_Job job;
+            if (!(iss >> job.configuration_file) or job.configuration_file[0] == '#')
+                {
+                    continue;
+                }
+            if (!(iss >> job.recording))
+                {
+                    std::cerr << "Line " << line_number << " of " << job_file << " is not a job: <configuration file> <recording> [<output folder>]\n";
+                    return false;
+                }
+            if (!(iss >> job.output_path))
+                {
+                    job.output_path = "job_" + std::to_string(line_number) + "_" + fs::path(job.recording).stem().string();
+                }
+            jobs_.push_back(job);
+        }
+    return true;
+}
+
+
+void Gnss_Sdr_Batch::run_job(Gnss_Sdr_Batch_Job& job) const
+{
+    const auto start = std::chrono::steady_clock::now();
+    auto configuration = std::make_shared<FileConfiguration>(job.configuration_file);
+    if (!configuration->has_section())
+        {
+            std::cerr << "The configuration file " << job.configuration_file << " has no [GNSS-SDR] section\n";
+            return;
+        }
+
+    // the same role as GNSSBlockFactory::GetSignalSource for the first source
+    std::string role = "SignalSource";
+    if (configuration->property(role + ".implementation", std::string("")).empty())
+        {
+            role = "SignalSource0";
+        }
+    configuration->set_property(role + ".filename", job.recording);
+    if (!job.output_path.empty())
+        {
+            if (!gnss_sdr_create_directory(job.output_path))
+                {
+                    std::cerr << "Cannot create the output folder " << job.output_path << '\n';
+                    return;
+                }
+            configuration->set_property("PVT.output_path", job.output_path);
+        }
+    // the standard input stays with the batch
+    configuration->set_property("GNSS-SDR.keyboard", "false");
+
+    errorlib::error_code ec;
+    const auto bytes = fs::file_size(job.recording, ec);
+    job.recording_bytes = ec ? 0 : static_cast<uint64_t>(bytes);
+
+    try
+        {
+            auto control_thread = std::make_unique<ControlThread>(configuration);
+            if (!control_thread->flowgraph())
+                {
+                    std::cerr << "The configuration file " << job.configuration_file << " is not valid\n";
+                    return;
+                }
+            job.startup_s = batch_seconds_since(start);
+            const auto run_start = std::chrono::steady_clock::now();
+            job.return_code = control_thread->run();
+            job.run_s = batch_seconds_since(run_start);
+        }
+    catch (const std::exception& e)
+        {
+            LOG(WARNING) << "The job of " << job.recording << " stopped with an exception: " << e.what();
+            std::cerr << "The job of " << job.recording << " stopped with an exception: " << e.what() << '\n';
+            job.return_code = -1;
+        }
+}
+
+
+int Gnss_Sdr_Batch::run()
+{
+    const auto start = std::chrono::steady_clock::now();
+    int failed = 0;
+    for (size_t i = 0; i < jobs_.size(); i++)
+        {
+            Gnss_Sdr_Batch_Job& job = jobs_[i];
+            std::cout << "Batch job " << i + 1 << " of " << jobs_.size() << ": " << job.recording
+                      << " with " << job.configuration_file << '\n';
+            run_job(job);
+            if (job.return_code != 0)
+                {
+                    failed++;
+                }
+            std::cout << "Batch job " << i + 1 << (job.return_code == 0 ? " done" : " failed")
+                      << " in " << job.startup_s + job.run_s << " s\n";
+        }
+    total_s_ = batch_seconds_since(start);
+    print_summary(std::cout);
+    return failed;
+}
+
+
+void Gnss_Sdr_Batch::print_summary(std::ostream& os) const
+{
+    uint64_t total_bytes = 0;
+    double startup_s = 0.0;
+    int failed = 0;
+    os << "\n   # | result | startup [s] |    run [s] | size [MB] | [MB/s] | recording\n";
+    for (size_t i = 0; i < jobs_.size(); i++)
+        {
+            const Gnss_Sdr_Batch_Job& job = jobs_[i];
+            os << std::setw(4) << i + 1 << " | " << std::setw(6) << (job.return_code == 0 ? "ok" : "failed")
+               << std::fixed << std::setprecision(2)
+               << " | " << std::setw(11) << job.startup_s
+               << " | " << std::setw(10) << job.run_s
+               << " | " << std::setw(9) << static_cast<double>(job.recording_bytes) / 1e6
+               << " | " << std::setw(6) << batch_throughput_mb_s(job.recording_bytes, job.startup_s + job.run_s)
+               << " | " << job.recording << '\n';
+            total_bytes += job.recording_bytes;
+            startup_s += job.startup_s;
+            failed += (job.return_code != 0);
+        }
+    os << jobs_.size() << " jobs (" << failed << " failed) in " << std::fixed << std::setprecision(2) << total_s_ << " s, "
+       << startup_s << " s of them building the flowgraphs, "
+       << batch_throughput_mb_s(total_bytes, total_s_) << " MB/s\n";
+    os.unsetf(std::ios::floatfield);
+}
+
+
+bool Gnss_Sdr_Batch::write_summary(const std::string& filename) const
+{
+    std::ofstream ofs(filename, std::ios::out | std::ios::trunc);
+    if (!ofs.is_open())
+        {
+            return false;
+        }
+    ofs << "job,configuration_file,recording,output_path,return_code,recording_bytes,startup_s,run_s,throughput_mb_s\n";
+    ofs << std::setprecision(6);
+    for (size_t i = 0; i < jobs_.size(); i++)
+        {
+            const Gnss_Sdr_Batch_Job& job = jobs_[i];
+            ofs << i + 1 << ',' << job.configuration_file << ',' << job.recording << ',' << job.output_path << ','
+                << job.return_code << ',' << job.recording_bytes << ',' << job.startup_s << ',' << job.run_s << ','
+                << batch_throughput_mb_s(job.recording_bytes, job.startup_s + job.run_s) << '\n';
+        }
+    return !ofs.fail();
+}
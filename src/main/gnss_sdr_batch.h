@@ -0,0 +1,103 @@
+/*!
+ * \file gnss_sdr_batch.h
+ * \brief Runs a queue of recordings through the receiver in a single process
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SDR_BATCH_H
+#define GNSS_SDR_GNSS_SDR_BATCH_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver
+ * \{ */
+
+
+/*!
+ * \brief Job of a batch: a recording processed with a configuration file
+ */
+class Gnss_Sdr_Batch_Job
+{
+public:
+    std::string configuration_file;
+    std::string recording;    //!< Replaces the file name of the first signal source
+    std::string output_path;  //!< Replaces PVT.output_path, if not empty
+
+    // filled by Gnss_Sdr_Batch::run()
+    uint64_t recording_bytes{0};
+    double startup_s{0.0};  //!< Construction of the flowgraph [s]
+    double run_s{0.0};      //!< Processing of the recording [s]
+    int return_code{-1};    //!< Of ControlThread::run(), or -1 if the job could not start
+};
+
+
+/*!
+ * \brief Runs the jobs of a batch one after the other, in this process.
+ *
+ * A launch of the receiver per recording pays for the code replicas, the
+ * FFT plans and the VOLK profile every time, which dominate the run time of
+ * short recordings. The jobs of a batch share them: the replicas are kept
+ * by Gnss_Replica_Cache, FFTW keeps the wisdom of the plans made, and the
+ * volk_gnsssdr profile is loaded once.
+ *
+ * The job file has a job per line, with a configuration file, a recording
+ * and, optionally, the folder of its outputs, separated by spaces. Empty
+ * lines and lines starting with # are ignored.
+ *
+ * The jobs run one at a time: the flowgraph publishes its thread pools and
+ * sample clock as process-wide instances, so two flowgraphs cannot run at
+ * the same time. The parallelism is the one of each job (see
+ * GNSS-SDR.acquisition_threads and GNSS-SDR.tracking_workers).
+ */
+class Gnss_Sdr_Batch
+{
+public:
+    /*!
+     * \brief Reads the jobs of job_file. The jobs without an output folder
+     * are given one named after their line number and recording. Returns
+     * false if the file cannot be read or a line is not a job.
+     */
+    bool read_job_file(const std::string& job_file);
+
+    /*!
+     * \brief Runs the jobs, prints their results and returns the number of
+     * jobs that failed
+     */
+    int run();
+
+    //! Prints a table with the run time and the throughput of each job
+    void print_summary(std::ostream& os) const;
+
+    //! Writes the results of the jobs to a CSV file. Returns false on error.
+    bool write_summary(const std::string& filename) const;
+
+    inline const std::vector<Gnss_Sdr_Batch_Job>& jobs() const
+    {
+        return jobs_;
+    }
+
+private:
+    void run_job(Gnss_Sdr_Batch_Job& job) const;
+
+    std::vector<Gnss_Sdr_Batch_Job> jobs_;
+    double total_s_{0.0};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SDR_BATCH_H
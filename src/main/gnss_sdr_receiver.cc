@@ -0,0 +1,194 @@
+/*!
+ * \file gnss_sdr_receiver.cc
+ * \brief Interface of the receiver for the applications that run it in their
+ * own process (libgnss-sdr-receiver)
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_receiver.h"
+#include "control_thread.h"
+#include "gnss_receiver_callbacks.h"
+#include "gnss_sample_push_channel.h"
+#include "in_memory_configuration.h"
+#include <glog/logging.h>
+#include <exception>
+#include <stdexcept>  // for runtime_error
+#include <utility>    // for move
+
+
+namespace
+{
+// the registries of navigation products, the sample clock and the
+// assistance queues are global, so they can only serve one receiver
+std::atomic<bool> receiver_in_process{false};
+}  // namespace
+
+
+Gnss_Sdr_Receiver::Gnss_Sdr_Receiver(std::shared_ptr<InMemoryConfiguration> configuration, const std::string& name)
+    : configuration_(std::move(configuration)),
+      callbacks_(Gnss_Receiver_Callbacks::get(name)),
+      name_(name)
+{
+    if (receiver_in_process.exchange(true))
+        {
+            throw std::runtime_error("there is already a GNSS-SDR receiver in this process");
+        }
+}
+
+
+Gnss_Sdr_Receiver::~Gnss_Sdr_Receiver()
+{
+    stop();
+    wait();
+    receiver_in_process = false;
+}
+
+
+void Gnss_Sdr_Receiver::on_observables(std::function<void(const Gnss_Synchro&)> callback)
+{
+    callbacks_->observables = std::move(callback);
+}
+
+
+void Gnss_Sdr_Receiver::on_pvt(std::function<void(const Monitor_Pvt&)> callback)
+{
+    callbacks_->pvt = std::move(callback);
+}
+
+
+void Gnss_Sdr_Receiver::on_nav_message(std::function<void(const Nav_Message_Packet&)> callback)
+{
+    callbacks_->nav_message = std::move(callback);
+}
+
+
+bool Gnss_Sdr_Receiver::start()
+{
+    if (thread_.joinable())
+        {
+            LOG(WARNING) << "The receiver " << name_ << " is already started";
+            return false;
+        }
+
+    // the receiver is connected to this object through named callbacks and push channels
+    configuration_->supersede_property("GNSS-SDR.keyboard", "false");
+    if (callbacks_->observables)
+        {
+            configuration_->supersede_property("Monitor.callbacks_name", name_);
+        }
+    if (callbacks_->pvt)
+        {
+            configuration_->supersede_property("PVT.monitor_callbacks_name", name_);
+        }
+    if (callbacks_->nav_message)
+        {
+            configuration_->supersede_property("NavDataMonitor.callbacks_name", name_);
+        }
+
+    channels_.clear();
+    const int num_sources = configuration_->property("GNSS-SDR.num_sources", configuration_->property("Receiver.sources_count", 1));
+    for (int i = 0; i < num_sources; i++)
+        {
+            // the same roles as GNSSBlockFactory::GetSignalSource
+            std::string role = "SignalSource" + std::to_string(i);
+            if (i == 0 and !configuration_->is_present(role + ".implementation"))
+                {
+                    role = "SignalSource";
+                }
+            if (configuration_->property(role + ".implementation", std::string("")) != "Sample_Push_Signal_Source")
+                {
+                    channels_.push_back(nullptr);
+                    continue;
+                }
+            if (!configuration_->is_present(role + ".channel_name"))
+                {
+                    configuration_->set_property(role + ".channel_name", name_ + "_" + role);
+                }
+            const auto max_buffers = static_cast<size_t>(configuration_->property(role + ".max_buffers", 64));
+            channels_.push_back(Gnss_Sample_Push_Channel::get(configuration_->property(role + ".channel_name", std::string("")), max_buffers));
+        }
+
+    control_thread_ = std::make_unique<ControlThread>(configuration_);
+    if (!control_thread_->flowgraph())
+        {
+            LOG(WARNING) << "The configuration of the receiver " << name_ << " is not valid";
+            control_thread_ = nullptr;
+            channels_.clear();
+            return false;
+        }
+
+    running_ = true;
+    thread_ = std::thread([this]() {
+        try
+            {
+                return_code_ = control_thread_->run();
+            }
+        catch (const std::exception& e)
+            {
+                LOG(WARNING) << "The receiver " << name_ << " stopped with an exception: " << e.what();
+                return_code_ = 1;
+            }
+        // the application must not wait for buffers that will never be read
+        for (auto& channel : channels_)
+            {
+                if (channel)
+                    {
+                        channel->close();
+                        channel->flush();
+                    }
+            }
+        running_ = false;
+    });
+    return true;
+}
+
+
+bool Gnss_Sdr_Receiver::push_samples(const void* samples, size_t bytes, std::function<void()> release, unsigned int source)
+{
+    if (!running_ or source >= channels_.size() or !channels_[source])
+        {
+            return false;
+        }
+    return channels_[source]->push(samples, bytes, std::move(release));
+}
+
+
+void Gnss_Sdr_Receiver::end_of_samples()
+{
+    for (auto& channel : channels_)
+        {
+            if (channel)
+                {
+                    channel->close();
+                }
+        }
+}
+
+
+void Gnss_Sdr_Receiver::stop()
+{
+    if (running_ and control_thread_)
+        {
+            control_thread_->request_stop();
+        }
+}
+
+
+int Gnss_Sdr_Receiver::wait()
+{
+    if (thread_.joinable())
+        {
+            thread_.join();
+        }
+    control_thread_ = nullptr;
+    return return_code_;
+}
@@ -0,0 +1,159 @@
+/*!
+ * \file gnss_sdr_receiver.h
+ * \brief Interface of the receiver for the applications that run it in their
+ * own process (libgnss-sdr-receiver)
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_SDR_RECEIVER_H
+#define GNSS_SDR_GNSS_SDR_RECEIVER_H
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+/** \addtogroup Core
+ * \{ */
+/** \addtogroup Core_Receiver
+ * \{ */
+
+
+class ControlThread;
+class Gnss_Receiver_Callbacks;
+class Gnss_Sample_Push_Channel;
+class Gnss_Synchro;
+class InMemoryConfiguration;
+class Monitor_Pvt;
+class Nav_Message_Packet;
+
+
+/*!
+ * \brief A GNSS-SDR receiver running in the process of an application.
+ *
+ * The receiver is built from an InMemoryConfiguration with the same
+ * properties as a configuration file. Its signal sources whose
+ * implementation is Sample_Push_Signal_Source read the sample buffers
+ * given to push_samples(), and the observables, the position fixes and the
+ * navigation messages are given to the callbacks set before start(), from
+ * the threads of the blocks that produce them, without sockets, files nor
+ * serialization in between:
+ *
+ * \code
+ * auto configuration = std::make_shared<InMemoryConfiguration>();
+ * configuration->set_property("SignalSource.implementation", "Sample_Push_Signal_Source");
+ * ... // the rest of the receiver
+ * Gnss_Sdr_Receiver receiver(configuration);
+ * receiver.on_pvt([](const Monitor_Pvt& pvt) { ... });
+ * receiver.start();
+ * while (...)
+ *     {
+ *         receiver.push_samples(buffer, bytes, [buffer] { ... });  // buffer can be reused after the callback
+ *     }
+ * receiver.end_of_samples();
+ * receiver.wait();
+ * \endcode
+ *
+ * There can be only one receiver in the process at a time: the navigation
+ * products read by the PVT block, the sample clock, the pipeline latency and
+ * the assistance queues are shared by all the flowgraphs of the process, so
+ * the constructor throws std::runtime_error if another Gnss_Sdr_Receiver
+ * exists. The name identifies the callbacks and the push channels of the
+ * receiver.
+ */
+class Gnss_Sdr_Receiver
+{
+public:
+    /*!
+     * \brief Receiver with the given configuration, which is completed with
+     * the properties that connect it to this object when it starts. Throws
+     * std::runtime_error if there is another receiver in the process.
+     */
+    explicit Gnss_Sdr_Receiver(std::shared_ptr<InMemoryConfiguration> configuration, const std::string& name = std::string("gnss-sdr"));
+
+    /*!
+     * \brief Stops the receiver, if it is running, and waits for it
+     */
+    ~Gnss_Sdr_Receiver();
+
+    Gnss_Sdr_Receiver(const Gnss_Sdr_Receiver&) = delete;
+    Gnss_Sdr_Receiver& operator=(const Gnss_Sdr_Receiver&) = delete;
+
+    //! Sets the callback of each observable of each channel (see Monitor.decimation_factor)
+    void on_observables(std::function<void(const Gnss_Synchro&)> callback);
+
+    //! Sets the callback of each position fix
+    void on_pvt(std::function<void(const Monitor_Pvt&)> callback);
+
+    //! Sets the callback of each navigation message decoded
+    void on_nav_message(std::function<void(const Nav_Message_Packet&)> callback);
+
+    /*!
+     * \brief Builds the flowgraph and runs the receiver in a thread of its
+     * own. Returns false if the configuration is not valid. It throws the
+     * exceptions of the construction of the blocks.
+     */
+    bool start();
+
+    /*!
+     * \brief Gives bytes bytes of samples, of the item type of the source, to
+     * the push signal source number source (in the order of the signal
+     * sources of the configuration). They are read from samples, which must
+     * stay valid until release is called. It waits while the source has
+     * max_buffers (SignalSource.max_buffers, 64 by default) buffers to read,
+     * and returns false if the receiver is not running or the source is not
+     * a push signal source.
+     */
+    bool push_samples(const void* samples, size_t bytes, std::function<void()> release = nullptr, unsigned int source = 0);
+
+    /*!
+     * \brief Tells the push signal sources that there are no more samples:
+     * the receiver stops after processing the ones pushed
+     */
+    void end_of_samples();
+
+    /*!
+     * \brief Asks the receiver to stop. The samples not processed yet are
+     * released.
+     */
+    void stop();
+
+    /*!
+     * \brief Waits for the receiver to stop, and returns the result of
+     * ControlThread::run()
+     */
+    int wait();
+
+    //! True from start() until the receiver stops
+    bool running() const
+    {
+        return running_.load();
+    }
+
+private:
+    std::shared_ptr<InMemoryConfiguration> configuration_;
+    std::shared_ptr<Gnss_Receiver_Callbacks> callbacks_;
+    std::vector<std::shared_ptr<Gnss_Sample_Push_Channel>> channels_;  // nullptr for other sources
+    std::unique_ptr<ControlThread> control_thread_;
+    std::thread thread_;
+    std::string name_;
+    std::atomic<bool> running_{false};
+    int return_code_{0};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_SDR_RECEIVER_H
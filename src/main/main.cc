@@ -25,9 +25,13 @@
 #define GOOGLE_STRIP_LOG 0
 #endif
 
+#include "capacity_planner.h"
 #include "concurrent_map.h"
 #include "concurrent_queue.h"
 #include "control_thread.h"
+#include "file_configuration.h"
+#include "gnss_sdr_batch.h"
+#include "gnss_sdr_flags.h"
 #include "gnss_sdr_filesystem.h"
 #include "gnss_sdr_make_unique.h"
 #include "gps_acq_assist.h"
@@ -124,10 +128,60 @@ int main(int argc, char** argv)
     int return_code = 0;
     try
         {
-            auto control_thread = std::make_unique<ControlThread>();
-            // record startup time
-            start = std::chrono::system_clock::now();
-            return_code = control_thread->run();
+            if (FLAGS_batch != "-")
+                {
+                    // the recordings are given by the job file
+                    if (FLAGS_s != "-" or FLAGS_signal_source != "-")
+                        {
+                            std::cerr << "The --batch jobs give their recordings, --signal_source cannot be used with them.\n";
+                            gflags::ShutDownCommandLineFlags();
+                            return 1;
+                        }
+                    Gnss_Sdr_Batch batch;
+                    if (!batch.read_job_file(FLAGS_batch))
+                        {
+                            gflags::ShutDownCommandLineFlags();
+                            return 1;
+                        }
+                    return_code = batch.run() == 0 ? 0 : 1;
+                    if (FLAGS_batch_summary != "-" and !batch.write_summary(FLAGS_batch_summary))
+                        {
+                            std::cerr << "Cannot write the batch summary to " << FLAGS_batch_summary << '\n';
+                        }
+                }
+            else if (FLAGS_capacity_plan)
+                {
+                    // the blocks are not created, so the receiver does not start
+                    const std::string config_file = (FLAGS_c == "-" ? FLAGS_config_file : FLAGS_c);
+                    const auto configuration = std::make_unique<FileConfiguration>(config_file);
+                    if (!configuration->has_section())
+                        {
+                            std::cerr << "Cannot read the configuration file " << config_file << '\n';
+                            gflags::ShutDownCommandLineFlags();
+                            return 1;
+                        }
+                    std::unique_ptr<FileConfiguration> calibration;
+                    if (FLAGS_capacity_calibration != "-")
+                        {
+                            calibration = std::make_unique<FileConfiguration>(FLAGS_capacity_calibration);
+                            if (!calibration->has_section())
+                                {
+                                    std::cerr << "Cannot read the calibration file " << FLAGS_capacity_calibration << '\n';
+                                    gflags::ShutDownCommandLineFlags();
+                                    return 1;
+                                }
+                        }
+                    const Capacity_Planner planner(configuration.get(), calibration ? calibration.get() : configuration.get());
+                    std::cout << planner.report();
+                    return_code = planner.realtime_achievable() ? 0 : 1;
+                }
+            else
+                {
+                    auto control_thread = std::make_unique<ControlThread>();
+                    // record startup time
+                    start = std::chrono::system_clock::now();
+                    return_code = control_thread->run();
+                }
         }
     catch (const boost::thread_resource_error& e)
         {
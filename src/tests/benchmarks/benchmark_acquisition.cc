@@ -0,0 +1,368 @@
+/*!
+ * \file benchmark_acquisition.cc
+ * \brief Benchmark of the acquisition blocks and of the stages of the
+ * FFT-based parallel code phase search, at the FFT sizes of each signal
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "MATH_CONSTANTS.h"
+#include "beidou_b1i_pcps_acquisition.h"
+#include "beidou_b3i_pcps_acquisition.h"
+#include "galileo_e1_pcps_ambiguous_acquisition.h"
+#include "galileo_e1_pcps_quicksync_ambiguous_acquisition.h"
+#include "galileo_e1_pcps_tong_ambiguous_acquisition.h"
+#include "galileo_e5a_pcps_acquisition.h"
+#include "galileo_e5b_pcps_acquisition.h"
+#include "galileo_e6_pcps_acquisition.h"
+#include "glonass_l1_ca_pcps_acquisition.h"
+#include "gnss_sdr_fft.h"
+#include "gnss_synchro.h"
+#include "gps_l1_ca_pcps_acquisition.h"
+#include "gps_l1_ca_pcps_quicksync_acquisition.h"
+#include "gps_l1_ca_pcps_tong_acquisition.h"
+#include "gps_l2_m_pcps_acquisition.h"
+#include "gps_l5i_pcps_acquisition.h"
+#include "in_memory_configuration.h"
+#include <benchmark/benchmark.h>
+#include <gnuradio/blocks/head.h>
+#include <gnuradio/top_block.h>
+#include <volk/volk.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>
+#include <algorithm>  // for std::generate
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#ifdef GR_GREATER_38
+#include <gnuradio/blocks/vector_source.h>
+#else
+#include <gnuradio/blocks/vector_source_c.h>
+#endif
+
+namespace
+{
+struct Acq_Benchmark_Signal
+{
+    const char* signal;
+    char system;
+    int64_t fs;                    // sampling rate [sps]
+    uint32_t integration_time_ms;  // coherent integration time, one code period
+    uint32_t doppler_step;         // Doppler bin width [Hz], about 2 / (3 * integration time)
+    uint32_t doppler_max;          // half width of the Doppler search [Hz]
+};
+
+
+// Sampling rates commonly used for each signal. The FFT size is fs * integration_time_ms / 1000
+const std::array<Acq_Benchmark_Signal, 10> ACQ_SIGNALS = {{
+    {"1C", 'G', 4000000LL, 1U, 250U, 5000U},
+    {"2S", 'G', 4000000LL, 20U, 50U, 5000U},
+    {"L5", 'G', 20000000LL, 1U, 250U, 5000U},
+    {"1B", 'E', 4000000LL, 4U, 125U, 5000U},
+    {"5X", 'E', 20000000LL, 1U, 250U, 5000U},
+    {"7X", 'E', 20000000LL, 1U, 250U, 5000U},
+    {"E6", 'E', 12000000LL, 1U, 250U, 5000U},
+    {"B1", 'C', 4000000LL, 1U, 250U, 5000U},
+    {"B3", 'C', 20000000LL, 1U, 250U, 5000U},
+    {"1G", 'R', 4000000LL, 1U, 250U, 5000U}}};
+
+// Dwells processed per benchmark iteration, to amortize the flowgraph start
+constexpr uint32_t DWELLS_PER_ITERATION = 4U;
+
+
+enum class Acq_Benchmark_Block
+{
+    pcps,
+    quicksync,
+    tong
+};
+
+
+uint32_t fft_size(const Acq_Benchmark_Signal& sig)
+{
+    return static_cast<uint32_t>(sig.fs * sig.integration_time_ms / 1000);
+}
+
+
+uint32_t num_doppler_bins(const Acq_Benchmark_Signal& sig)
+{
+    return 2U * sig.doppler_max / sig.doppler_step;
+}
+
+
+std::vector<gr_complex> noise(uint32_t num_samples)
+{
+    std::vector<gr_complex> samples(num_samples);
+    std::default_random_engine e2(1);
+    std::normal_distribution<float> dist(0.0, 1.0);
+    std::generate(samples.begin(), samples.end(), [&dist, &e2]() { return gr_complex(dist(e2), dist(e2)); });
+    return samples;
+}
+
+
+std::shared_ptr<AcquisitionInterface> make_acquisition(const Acq_Benchmark_Signal& sig, Acq_Benchmark_Block block, const ConfigurationInterface* config)
+{
+    const std::string signal(sig.signal);
+    const std::string role = "Acquisition_" + signal;
+    if (block == Acq_Benchmark_Block::quicksync)
+        {
+            if (signal == "1C")
+                {
+                    return std::make_shared<GpsL1CaPcpsQuickSyncAcquisition>(config, role, 1, 0);
+                }
+            return std::make_shared<GalileoE1PcpsQuickSyncAmbiguousAcquisition>(config, role, 1, 0);
+        }
+    if (block == Acq_Benchmark_Block::tong)
+        {
+            if (signal == "1C")
+                {
+                    return std::make_shared<GpsL1CaPcpsTongAcquisition>(config, role, 1, 0);
+                }
+            return std::make_shared<GalileoE1PcpsTongAmbiguousAcquisition>(config, role, 1, 0);
+        }
+    if (signal == "1C")
+        {
+            return std::make_shared<GpsL1CaPcpsAcquisition>(config, role, 1, 0);
+        }
+    if (signal == "2S")
+        {
+            return std::make_shared<GpsL2MPcpsAcquisition>(config, role, 1, 0);
+        }
+    if (signal == "L5")
+        {
+            return std::make_shared<GpsL5iPcpsAcquisition>(config, role, 1, 0);
+        }
+    if (signal == "1B")
+        {
+            return std::make_shared<GalileoE1PcpsAmbiguousAcquisition>(config, role, 1, 0);
+        }
+    if (signal == "5X")
+        {
+            return std::make_shared<GalileoE5aPcpsAcquisition>(config, role, 1, 0);
+        }
+    if (signal == "7X")
+        {
+            return std::make_shared<GalileoE5bPcpsAcquisition>(config, role, 1, 0);
+        }
+    if (signal == "E6")
+        {
+            return std::make_shared<GalileoE6PcpsAcquisition>(config, role, 1, 0);
+        }
+    if (signal == "B1")
+        {
+            return std::make_shared<BeidouB1iPcpsAcquisition>(config, role, 1, 0);
+        }
+    if (signal == "B3")
+        {
+            return std::make_shared<BeidouB3iPcpsAcquisition>(config, role, 1, 0);
+        }
+    return std::make_shared<GlonassL1CaPcpsAcquisition>(config, role, 1, 0);
+}
+
+
+/*
+ * Runs the acquisition block on noise, with a threshold that is never
+ * exceeded, so that every dwell searches the whole Doppler grid.
+ */
+void bm_acquisition_block(benchmark::State& state, Acq_Benchmark_Block block)
+{
+    const Acq_Benchmark_Signal& sig = ACQ_SIGNALS[state.range(0)];
+    const std::string role = "Acquisition_" + std::string(sig.signal);
+    const uint32_t samples_per_dwell = fft_size(sig);
+    state.SetLabel(sig.signal);
+
+    auto config = std::make_shared<InMemoryConfiguration>();
+    config->set_property("GNSS-SDR.internal_fs_sps", std::to_string(sig.fs));
+    config->set_property(role + ".item_type", "gr_complex");
+    config->set_property(role + ".coherent_integration_time_ms", std::to_string(sig.integration_time_ms));
+    config->set_property(role + ".doppler_max", std::to_string(sig.doppler_max));
+    config->set_property(role + ".doppler_step", std::to_string(sig.doppler_step));
+    config->set_property(role + ".max_dwells", "1000000000");
+    config->set_property(role + ".tong_init_val", "500000000");
+    config->set_property(role + ".tong_max_val", "1000000000");
+    config->set_property(role + ".tong_max_dwells", "1000000000");
+    config->set_property(role + ".blocking", "true");
+    config->set_property(role + ".dump", "false");
+
+    Gnss_Synchro gnss_synchro{};
+    gnss_synchro.System = sig.system;
+    std::string(sig.signal).copy(gnss_synchro.Signal, 2, 0);
+    gnss_synchro.PRN = 1;
+
+    auto top_block = gr::make_top_block("Acquisition benchmark");
+    auto acquisition = make_acquisition(sig, block, config.get());
+    acquisition->set_channel(0);
+    acquisition->set_gnss_synchro(&gnss_synchro);
+    acquisition->set_threshold(1e9);
+    acquisition->set_doppler_max(sig.doppler_max);
+    acquisition->set_doppler_step(sig.doppler_step);
+    acquisition->connect(top_block);
+
+    // One extra dwell lets the block search the last full dwell
+    auto source = gr::blocks::vector_source_c::make(noise(samples_per_dwell), true);
+    auto head = gr::blocks::head::make(sizeof(gr_complex), static_cast<uint64_t>(samples_per_dwell) * (DWELLS_PER_ITERATION + 1));
+    top_block->connect(source, 0, head, 0);
+    top_block->connect(head, 0, acquisition->get_left_block(), 0);
+
+    acquisition->set_local_code();
+    acquisition->init();
+
+    while (state.KeepRunning())
+        {
+            acquisition->set_state(1);
+            head->reset();
+            top_block->run();
+        }
+
+    state.counters["dwells_per_second"] = benchmark::Counter(static_cast<double>(state.iterations()) * DWELLS_PER_ITERATION, benchmark::Counter::kIsRate);
+    state.counters["fft_size"] = samples_per_dwell;
+    state.counters["doppler_bins"] = num_doppler_bins(sig);
+}
+
+
+void bm_pcps_acquisition(benchmark::State& state)
+{
+    bm_acquisition_block(state, Acq_Benchmark_Block::pcps);
+}
+
+
+void bm_pcps_quicksync_acquisition(benchmark::State& state)
+{
+    bm_acquisition_block(state, Acq_Benchmark_Block::quicksync);
+}
+
+
+void bm_pcps_tong_acquisition(benchmark::State& state)
+{
+    bm_acquisition_block(state, Acq_Benchmark_Block::tong);
+}
+
+
+/*
+ * Per-stage benchmarks. Each iteration processes one Doppler bin, so the
+ * time of a dwell is about the sum of the stages times the number of
+ * Doppler bins.
+ */
+void set_stage_counters(benchmark::State& state, const Acq_Benchmark_Signal& sig)
+{
+    state.SetLabel(sig.signal);
+    state.SetItemsProcessed(state.iterations() * fft_size(sig));
+    state.counters["fft_size"] = fft_size(sig);
+    state.counters["bins_per_dwell"] = num_doppler_bins(sig);
+}
+
+
+void bm_stage_wipeoff(benchmark::State& state)
+{
+    const Acq_Benchmark_Signal& sig = ACQ_SIGNALS[state.range(0)];
+    const uint32_t n = fft_size(sig);
+    const std::vector<gr_complex> in_noise = noise(n);
+    volk_gnsssdr::vector<gr_complex> in(in_noise.begin(), in_noise.end());
+    volk_gnsssdr::vector<gr_complex> carrier(n);
+    volk_gnsssdr::vector<gr_complex> out(n);
+    std::array<float, 1> phase{};
+    volk_gnsssdr_s32f_sincos_32fc(carrier.data(), -static_cast<float>(TWO_PI) * 1000.0F / static_cast<float>(sig.fs), phase.data(), n);
+
+    while (state.KeepRunning())
+        {
+            volk_32fc_x2_multiply_32fc(out.data(), in.data(), carrier.data(), n);
+            benchmark::DoNotOptimize(out.data());
+        }
+    set_stage_counters(state, sig);
+}
+
+
+void bm_stage_fft(benchmark::State& state)
+{
+    const Acq_Benchmark_Signal& sig = ACQ_SIGNALS[state.range(0)];
+    const uint32_t n = fft_size(sig);
+    auto fft = gnss_fft_fwd_make_unique(n);
+    const std::vector<gr_complex> in = noise(n);
+    std::copy(in.begin(), in.end(), fft->get_inbuf());
+
+    while (state.KeepRunning())
+        {
+            fft->execute();
+            benchmark::DoNotOptimize(fft->get_outbuf());
+        }
+    set_stage_counters(state, sig);
+}
+
+
+void bm_stage_multiply(benchmark::State& state)
+{
+    const Acq_Benchmark_Signal& sig = ACQ_SIGNALS[state.range(0)];
+    const uint32_t n = fft_size(sig);
+    const std::vector<gr_complex> in_noise = noise(n);
+    volk_gnsssdr::vector<gr_complex> spectrum(in_noise.begin(), in_noise.end());
+    volk_gnsssdr::vector<gr_complex> code(in_noise.rbegin(), in_noise.rend());
+    volk_gnsssdr::vector<gr_complex> out(n);
+
+    while (state.KeepRunning())
+        {
+            volk_32fc_x2_multiply_32fc(out.data(), spectrum.data(), code.data(), n);
+            benchmark::DoNotOptimize(out.data());
+        }
+    set_stage_counters(state, sig);
+}
+
+
+void bm_stage_ifft(benchmark::State& state)
+{
+    const Acq_Benchmark_Signal& sig = ACQ_SIGNALS[state.range(0)];
+    const uint32_t n = fft_size(sig);
+    auto ifft = gnss_fft_rev_make_unique(n);
+    const std::vector<gr_complex> in = noise(n);
+    std::copy(in.begin(), in.end(), ifft->get_inbuf());
+
+    while (state.KeepRunning())
+        {
+            ifft->execute();
+            benchmark::DoNotOptimize(ifft->get_outbuf());
+        }
+    set_stage_counters(state, sig);
+}
+
+
+void bm_stage_peak_search(benchmark::State& state)
+{
+    const Acq_Benchmark_Signal& sig = ACQ_SIGNALS[state.range(0)];
+    const uint32_t n = fft_size(sig);
+    const std::vector<gr_complex> in_noise = noise(n);
+    volk_gnsssdr::vector<gr_complex> correlation(in_noise.begin(), in_noise.end());
+    volk_gnsssdr::vector<float> magnitude(n);
+    uint32_t index = 0;
+
+    while (state.KeepRunning())
+        {
+            volk_32fc_magnitude_squared_32f(magnitude.data(), correlation.data(), n);
+            volk_gnsssdr_32f_index_max_32u(&index, magnitude.data(), n);
+            benchmark::DoNotOptimize(index);
+        }
+    set_stage_counters(state, sig);
+}
+}  // namespace
+
+
+// Argument: index in ACQ_SIGNALS (1C, 2S, L5, 1B, 5X, 7X, E6, B1, B3, 1G)
+BENCHMARK(bm_stage_wipeoff)->DenseRange(0, ACQ_SIGNALS.size() - 1);
+BENCHMARK(bm_stage_fft)->DenseRange(0, ACQ_SIGNALS.size() - 1);
+BENCHMARK(bm_stage_multiply)->DenseRange(0, ACQ_SIGNALS.size() - 1);
+BENCHMARK(bm_stage_ifft)->DenseRange(0, ACQ_SIGNALS.size() - 1);
+BENCHMARK(bm_stage_peak_search)->DenseRange(0, ACQ_SIGNALS.size() - 1);
+BENCHMARK(bm_pcps_acquisition)->DenseRange(0, ACQ_SIGNALS.size() - 1)->Unit(benchmark::kMillisecond)->UseRealTime();
+// quicksync and tong blocks only have GPS L1 C/A (0) and Galileo E1 (3) adapters
+BENCHMARK(bm_pcps_quicksync_acquisition)->Arg(0)->Arg(3)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(bm_pcps_tong_acquisition)->Arg(0)->Arg(3)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_MAIN();
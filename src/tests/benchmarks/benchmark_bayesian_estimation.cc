@@ -0,0 +1,118 @@
+/*!
+ * \file benchmark_bayesian_estimation.cc
+ * \brief Benchmark of the sequential update of the Bayesian estimator of the
+ * measurement noise of the Kalman filter based tracking loops
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "bayesian_estimation.h"
+#include <armadillo>
+#include <benchmark/benchmark.h>
+#include <random>
+
+
+namespace
+{
+// The update with Armadillo expressions, as done before the in place update
+// of Bayesian_estimator
+struct Expression_Estimator
+{
+    arma::vec mu_est;
+    arma::mat Psi_est;
+    arma::vec mu_prior;
+    arma::mat Psi_prior;
+    int kappa_prior;
+    int nu_prior;
+
+    void update_sequential(const arma::vec& data)
+    {
+        const int K = data.n_cols;
+        const int ny = data.n_rows;
+        arma::vec y_mean = arma::mean(data, 1);
+        arma::mat Psi_N = arma::zeros(ny, ny);
+        for (int kk = 0; kk < K; kk++)
+            {
+                Psi_N = Psi_N + (data.col(kk) - y_mean) * ((data.col(kk) - y_mean).t());
+            }
+        arma::vec mu_posterior = (kappa_prior * mu_prior + K * y_mean) / (kappa_prior + K);
+        const int kappa_posterior = kappa_prior + K;
+        const int nu_posterior = nu_prior + K;
+        arma::mat Psi_posterior = Psi_prior + Psi_N + (static_cast<float>(kappa_prior) * static_cast<float>(K)) / (static_cast<float>(kappa_prior) + static_cast<float>(K)) * (y_mean - mu_prior) * ((y_mean - mu_prior).t());
+        mu_est = mu_posterior;
+        if ((nu_posterior - ny - 1) > 0)
+            {
+                Psi_est = Psi_posterior / (nu_posterior - ny - 1);
+            }
+        else
+            {
+                Psi_est = Psi_posterior / (nu_posterior + ny + 1);
+            }
+        mu_prior = mu_posterior;
+        kappa_prior = kappa_posterior;
+        nu_prior = nu_posterior;
+        Psi_prior = Psi_posterior;
+    }
+};
+
+
+// discriminator outputs of a channel, for one update per iteration
+arma::mat bayesian_benchmark_samples(int ny)
+{
+    std::default_random_engine generator(42);
+    std::normal_distribution<double> normal_dist(0.0, 0.1);
+    arma::mat samples(ny, 1000);
+    for (auto& sample : samples)
+        {
+            sample = normal_dist(generator);
+        }
+    return samples;
+}
+}  // namespace
+
+
+void bm_update_expressions(benchmark::State& state)
+{
+    const int ny = state.range(0);
+    const arma::mat samples = bayesian_benchmark_samples(ny);
+    Expression_Estimator estimator{arma::zeros(ny, 1), arma::eye(ny, ny), arma::zeros(ny, 1), arma::eye(ny, ny), 0, 0};
+    arma::vec data(ny);
+    arma::uword k = 0;
+    for (auto _ : state)
+        {
+            data = samples.col(k++ % samples.n_cols);
+            estimator.update_sequential(data);
+            benchmark::DoNotOptimize(estimator.Psi_est.memptr());
+        }
+    state.SetItemsProcessed(state.iterations());
+}
+
+
+void bm_update_in_place(benchmark::State& state)
+{
+    const int ny = state.range(0);
+    const arma::mat samples = bayesian_benchmark_samples(ny);
+    Bayesian_estimator estimator(ny);
+    arma::vec data(ny);
+    arma::uword k = 0;
+    for (auto _ : state)
+        {
+            data = samples.col(k++ % samples.n_cols);
+            estimator.update_sequential(data);
+            benchmark::DoNotOptimize(estimator.get_Psi_est().memptr());
+        }
+    state.SetItemsProcessed(state.iterations());
+}
+
+
+BENCHMARK(bm_update_expressions)->Arg(1)->Arg(2);
+BENCHMARK(bm_update_in_place)->Arg(1)->Arg(2);
+BENCHMARK_MAIN();
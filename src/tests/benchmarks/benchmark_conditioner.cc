@@ -0,0 +1,362 @@
+/*!
+ * \file benchmark_conditioner.cc
+ * \brief Benchmark of the throughput of the data type adapters, input filters,
+ * resamplers, sample unpackers and whole signal conditioner chains
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_block_factory.h"
+#include "gnss_block_interface.h"
+#include "in_memory_configuration.h"
+#include "unpack_2bit_samples.h"
+#include "unpack_byte_2bit_cpx_samples.h"
+#include "unpack_byte_2bit_samples.h"
+#include "unpack_byte_4bit_samples.h"
+#include "unpack_intspir_1bit_samples.h"
+#include <benchmark/benchmark.h>
+#include <gnuradio/blocks/head.h>
+#include <gnuradio/blocks/null_sink.h>
+#include <gnuradio/top_block.h>
+#include <algorithm>  // for std::generate, std::min, std::max
+#include <array>
+#include <cstdint>
+#include <cstring>  // for std::memcpy
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#ifdef GR_GREATER_38
+#include <gnuradio/blocks/vector_source.h>
+#else
+#include <gnuradio/blocks/vector_source_b.h>
+#endif
+
+namespace
+{
+using Cond_Benchmark_Properties = std::vector<std::pair<std::string, std::string>>;
+
+struct Cond_Benchmark_Stage
+{
+    const char* label;
+    const char* role;              // DataTypeAdapter, InputFilter or Resampler
+    const char* implementation;
+    const char* input_item_type;   // type of the synthetic input samples
+    size_t output_item_size;       // [bytes]
+    double samples_per_item;       // samples in each input item, 0.5 for interleaved I and Q items
+    Cond_Benchmark_Properties properties;
+};
+
+
+// Rate of the synthetic input [sps], used by the blocks that need one
+constexpr double COND_FS = 4000000.0;
+
+// Input items pushed through the block in each benchmark iteration, to amortize the flowgraph start
+constexpr uint64_t ITEMS_PER_ITERATION = 1U << 22U;
+
+// Items of the repeated input vector
+constexpr uint32_t INPUT_VECTOR_ITEMS = 1U << 16U;
+
+
+const Cond_Benchmark_Properties FIR_PROPERTIES = {
+    {"taps_item_type", "float"},
+    {"number_of_taps", "11"},
+    {"number_of_bands", "2"},
+    {"band1_begin", "0.0"},
+    {"band1_end", "0.45"},
+    {"band2_begin", "0.55"},
+    {"band2_end", "1.0"},
+    {"ampl1_begin", "1.0"},
+    {"ampl1_end", "1.0"},
+    {"ampl2_begin", "0.0"},
+    {"ampl2_end", "0.0"},
+    {"band1_error", "1.0"},
+    {"band2_error", "1.0"},
+    {"filter_type", "bandpass"},
+    {"grid_density", "16"}};
+
+
+Cond_Benchmark_Properties with_properties(Cond_Benchmark_Properties properties, const Cond_Benchmark_Properties& more)
+{
+    properties.insert(properties.end(), more.cbegin(), more.cend());
+    return properties;
+}
+
+
+const std::vector<Cond_Benchmark_Stage>& stages()
+{
+    static const std::string fs = std::to_string(COND_FS);
+    static const std::vector<Cond_Benchmark_Stage> table = {
+        {"Byte_To_Short", "DataTypeAdapter", "Byte_To_Short", "byte", sizeof(int16_t), 1.0, {{"input_item_type", "byte"}}},
+        {"Ibyte_To_Cbyte", "DataTypeAdapter", "Ibyte_To_Cbyte", "byte", 2 * sizeof(int8_t), 0.5, {{"input_item_type", "byte"}}},
+        {"Ibyte_To_Cshort", "DataTypeAdapter", "Ibyte_To_Cshort", "byte", 2 * sizeof(int16_t), 0.5, {{"input_item_type", "byte"}}},
+        {"Ibyte_To_Complex", "DataTypeAdapter", "Ibyte_To_Complex", "byte", sizeof(gr_complex), 0.5, {{"input_item_type", "byte"}}},
+        {"Ishort_To_Cshort", "DataTypeAdapter", "Ishort_To_Cshort", "short", 2 * sizeof(int16_t), 0.5, {{"input_item_type", "short"}}},
+        {"Ishort_To_Complex", "DataTypeAdapter", "Ishort_To_Complex", "short", sizeof(gr_complex), 0.5, {{"input_item_type", "short"}}},
+        {"Bit_Selection_To_Cbyte gr_complex", "DataTypeAdapter", "Bit_Selection_To_Cbyte", "gr_complex", 2 * sizeof(int8_t), 1.0, {{"input_item_type", "gr_complex"}, {"bits", "4"}}},
+        {"Bit_Selection_To_Cbyte cshort", "DataTypeAdapter", "Bit_Selection_To_Cbyte", "cshort", 2 * sizeof(int8_t), 1.0, {{"input_item_type", "cshort"}, {"bits", "4"}}},
+        {"Fir_Filter gr_complex", "InputFilter", "Fir_Filter", "gr_complex", sizeof(gr_complex), 1.0, with_properties(FIR_PROPERTIES, {{"input_item_type", "gr_complex"}, {"output_item_type", "gr_complex"}})},
+        {"Fir_Filter cshort", "InputFilter", "Fir_Filter", "cshort", 2 * sizeof(int16_t), 1.0, with_properties(FIR_PROPERTIES, {{"input_item_type", "cshort"}, {"output_item_type", "cshort"}})},
+        {"Fir_Filter cbyte", "InputFilter", "Fir_Filter", "cbyte", sizeof(gr_complex), 1.0, with_properties(FIR_PROPERTIES, {{"input_item_type", "cbyte"}, {"output_item_type", "gr_complex"}})},
+        {"Freq_Xlating_Fir_Filter gr_complex", "InputFilter", "Freq_Xlating_Fir_Filter", "gr_complex", sizeof(gr_complex), 1.0,
+            with_properties(FIR_PROPERTIES, {{"input_item_type", "gr_complex"}, {"output_item_type", "gr_complex"}, {"IF", "1000000"}, {"sampling_frequency", fs}, {"decimation_factor", "1"}})},
+        {"Freq_Xlating_Fir_Filter short", "InputFilter", "Freq_Xlating_Fir_Filter", "short", sizeof(gr_complex), 1.0,
+            with_properties(FIR_PROPERTIES, {{"input_item_type", "short"}, {"output_item_type", "gr_complex"}, {"IF", "1000000"}, {"sampling_frequency", fs}, {"decimation_factor", "1"}})},
+        {"Xlating_Decimator_Filter", "InputFilter", "Xlating_Decimator_Filter", "gr_complex", sizeof(gr_complex), 1.0,
+            {{"item_type", "gr_complex"}, {"IF", "1000000"}, {"sampling_frequency", fs}, {"decimation_factor", "2"}}},
+        {"Pulse_Blanking_Filter", "InputFilter", "Pulse_Blanking_Filter", "gr_complex", sizeof(gr_complex), 1.0, {{"item_type", "gr_complex"}}},
+        {"Notch_Filter", "InputFilter", "Notch_Filter", "gr_complex", sizeof(gr_complex), 1.0, {{"item_type", "gr_complex"}}},
+        {"Notch_Filter_Lite", "InputFilter", "Notch_Filter_Lite", "gr_complex", sizeof(gr_complex), 1.0, {{"item_type", "gr_complex"}}},
+        {"Interference_Mitigation_Filter", "InputFilter", "Interference_Mitigation_Filter", "gr_complex", sizeof(gr_complex), 1.0, {{"item_type", "gr_complex"}}},
+        {"Direct_Resampler gr_complex", "Resampler", "Direct_Resampler", "gr_complex", sizeof(gr_complex), 1.0,
+            {{"item_type", "gr_complex"}, {"sample_freq_in", fs}, {"sample_freq_out", "2046000"}}},
+        {"Direct_Resampler cshort", "Resampler", "Direct_Resampler", "cshort", 2 * sizeof(int16_t), 1.0,
+            {{"item_type", "cshort"}, {"sample_freq_in", fs}, {"sample_freq_out", "2046000"}}},
+        {"Mmse_Resampler", "Resampler", "Mmse_Resampler", "gr_complex", sizeof(gr_complex), 1.0,
+            {{"item_type", "gr_complex"}, {"sample_freq_in", fs}, {"sample_freq_out", "2046000"}}},
+        {"Rational_Resampler", "Resampler", "Rational_Resampler", "gr_complex", sizeof(gr_complex), 1.0,
+            {{"item_type", "gr_complex"}, {"sample_freq_in", fs}, {"sample_freq_out", "2000000"}}}};
+    return table;
+}
+
+
+struct Cond_Benchmark_Unpacker
+{
+    const char* label;
+    const char* input_item_type;
+    size_t output_item_size;   // [bytes]
+    double samples_per_item;   // unpacked values in each input item
+    std::function<gr::basic_block_sptr()> make;
+};
+
+
+const std::vector<Cond_Benchmark_Unpacker>& unpackers()
+{
+    static const std::vector<Cond_Benchmark_Unpacker> table = {
+        {"unpack_byte_2bit_samples", "byte", sizeof(float), 4.0, []() -> gr::basic_block_sptr { return make_unpack_byte_2bit_samples(); }},
+        {"unpack_byte_2bit_cpx_samples", "byte", sizeof(int16_t), 4.0, []() -> gr::basic_block_sptr { return make_unpack_byte_2bit_cpx_samples(); }},
+        {"unpack_byte_4bit_samples", "byte", sizeof(int8_t), 2.0, []() -> gr::basic_block_sptr { return make_unpack_byte_4bit_samples(); }},
+        {"unpack_intspir_1bit_samples", "int", sizeof(float), 2.0, []() -> gr::basic_block_sptr { return make_unpack_intspir_1bit_samples(); }},
+        {"unpack_2bit_samples byte", "byte", sizeof(int8_t), 4.0, []() -> gr::basic_block_sptr { return make_unpack_2bit_samples(false, 1, false); }},
+        {"unpack_2bit_samples short", "short", sizeof(int8_t), 8.0, []() -> gr::basic_block_sptr { return make_unpack_2bit_samples(false, 2, true); }}};
+    return table;
+}
+
+
+// Whole chains, in the order DataTypeAdapter, InputFilter, Resampler
+struct Cond_Benchmark_Chain
+{
+    const char* label;
+    const char* input_item_type;
+    double samples_per_item;
+    std::array<Cond_Benchmark_Properties, 3> properties;
+};
+
+
+const std::vector<Cond_Benchmark_Chain>& chains()
+{
+    static const std::string fs = std::to_string(COND_FS);
+    static const std::vector<Cond_Benchmark_Chain> table = {
+        {"ishort xlating direct", "short", 0.5,
+            {{{{"implementation", "Ishort_To_Complex"}, {"input_item_type", "short"}},
+                with_properties(FIR_PROPERTIES, {{"implementation", "Freq_Xlating_Fir_Filter"}, {"input_item_type", "gr_complex"}, {"output_item_type", "gr_complex"},
+                                         {"IF", "1000000"}, {"sampling_frequency", fs}, {"decimation_factor", "1"}}),
+                {{"implementation", "Direct_Resampler"}, {"item_type", "gr_complex"}, {"sample_freq_in", fs}, {"sample_freq_out", "2046000"}}}}},
+        {"ibyte fir pass", "byte", 0.5,
+            {{{{"implementation", "Ibyte_To_Complex"}, {"input_item_type", "byte"}},
+                with_properties(FIR_PROPERTIES, {{"implementation", "Fir_Filter"}, {"input_item_type", "gr_complex"}, {"output_item_type", "gr_complex"}}),
+                {{"implementation", "Pass_Through"}, {"item_type", "gr_complex"}}}}},
+        {"complex pass direct", "gr_complex", 1.0,
+            {{{{"implementation", "Pass_Through"}, {"item_type", "gr_complex"}},
+                {{"implementation", "Pass_Through"}, {"item_type", "gr_complex"}},
+                {{"implementation", "Direct_Resampler"}, {"item_type", "gr_complex"}, {"sample_freq_in", fs}, {"sample_freq_out", "2046000"}}}}}};
+    return table;
+}
+
+
+size_t input_item_size(const std::string& item_type)
+{
+    if (item_type == "gr_complex")
+        {
+            return sizeof(gr_complex);
+        }
+    if (item_type == "cshort" or item_type == "int")
+        {
+            return sizeof(int32_t);
+        }
+    if (item_type == "cbyte" or item_type == "short")
+        {
+            return sizeof(int16_t);
+        }
+    return sizeof(int8_t);
+}
+
+
+/*
+ * Gaussian noise in the given item type, as raw bytes. The integer types use
+ * a deviation of a quarter of their range, as an AGC would set it, and the
+ * packed bit types are uniformly distributed.
+ */
+std::vector<unsigned char> noise(const std::string& item_type, uint32_t num_items)
+{
+    std::default_random_engine e2(1);
+    std::normal_distribution<float> dist(0.0, 1.0);
+    std::vector<unsigned char> bytes(static_cast<size_t>(num_items) * input_item_size(item_type));
+    if (item_type == "gr_complex")
+        {
+            std::vector<gr_complex> samples(num_items);
+            std::generate(samples.begin(), samples.end(), [&dist, &e2]() { return gr_complex(dist(e2), dist(e2)); });
+            std::memcpy(bytes.data(), samples.data(), bytes.size());
+        }
+    else if (item_type == "cshort" or item_type == "short")
+        {
+            std::vector<int16_t> samples(bytes.size() / sizeof(int16_t));
+            std::generate(samples.begin(), samples.end(), [&dist, &e2]() { return static_cast<int16_t>(std::max(-32767.0F, std::min(32767.0F, 8192.0F * dist(e2)))); });
+            std::memcpy(bytes.data(), samples.data(), bytes.size());
+        }
+    else if (item_type == "cbyte")
+        {
+            std::generate(bytes.begin(), bytes.end(), [&dist, &e2]() { return static_cast<unsigned char>(static_cast<int8_t>(std::max(-127.0F, std::min(127.0F, 32.0F * dist(e2))))); });
+        }
+    else
+        {
+            std::uniform_int_distribution<int> uniform(0, 255);
+            std::generate(bytes.begin(), bytes.end(), [&uniform, &e2]() { return static_cast<unsigned char>(uniform(e2)); });
+        }
+    return bytes;
+}
+
+
+/*
+ * Pushes ITEMS_PER_ITERATION input items from a repeated vector through the
+ * block. The block runs in its own thread, so the MSps counter is the
+ * throughput of one core. The bytes_per_sample counter is the memory traffic
+ * of the block, its input and output bytes per input sample.
+ */
+void run_block(benchmark::State& state, const std::string& item_type, double samples_per_item, size_t output_item_size,
+    const gr::basic_block_sptr& left_block, const gr::basic_block_sptr& right_block, const std::function<void(gr::top_block_sptr)>& connect)
+{
+    const size_t item_size = input_item_size(item_type);
+    auto top_block = gr::make_top_block("Conditioner benchmark");
+    auto source = gr::blocks::vector_source_b::make(noise(item_type, INPUT_VECTOR_ITEMS), true, item_size);
+    auto head = gr::blocks::head::make(item_size, ITEMS_PER_ITERATION);
+    auto sink = gr::blocks::null_sink::make(output_item_size);
+    connect(top_block);
+    top_block->connect(source, 0, head, 0);
+    top_block->connect(head, 0, left_block, 0);
+    top_block->connect(right_block, 0, sink, 0);
+
+    while (state.KeepRunning())
+        {
+            head->reset();
+            top_block->run();
+        }
+
+    const double samples = static_cast<double>(ITEMS_PER_ITERATION) * samples_per_item;
+    const auto output_items = static_cast<double>(sink->nitems_read(0));
+    state.counters["MSps"] = benchmark::Counter(static_cast<double>(state.iterations()) * samples / 1e6, benchmark::Counter::kIsRate);
+    state.counters["bytes_per_sample"] = (static_cast<double>(ITEMS_PER_ITERATION * item_size) + output_items * static_cast<double>(output_item_size)) / samples;
+}
+
+
+void bm_stage(benchmark::State& state)
+{
+    const Cond_Benchmark_Stage& stage = stages()[state.range(0)];
+    const std::string role(stage.role);
+    state.SetLabel(stage.label);
+
+    auto config = std::make_shared<InMemoryConfiguration>();
+    config->set_property("GNSS-SDR.internal_fs_sps", std::to_string(COND_FS));
+    config->set_property(role + ".implementation", stage.implementation);
+    config->set_property(role + ".dump", "false");
+    for (const auto& property : stage.properties)
+        {
+            config->set_property(role + "." + property.first, property.second);
+        }
+
+    GNSSBlockFactory factory;
+    auto block = factory.GetBlock(config.get(), role, 1, 1);
+    if (block == nullptr)
+        {
+            state.SkipWithError("the block could not be created");
+            return;
+        }
+    run_block(state, stage.input_item_type, stage.samples_per_item, stage.output_item_size, block->get_left_block(), block->get_right_block(),
+        [&block](gr::top_block_sptr top_block) { block->connect(std::move(top_block)); });
+}
+
+
+void bm_unpacker(benchmark::State& state)
+{
+    const Cond_Benchmark_Unpacker& unpacker = unpackers()[state.range(0)];
+    state.SetLabel(unpacker.label);
+    const gr::basic_block_sptr block = unpacker.make();
+    run_block(state, unpacker.input_item_type, unpacker.samples_per_item, unpacker.output_item_size, block, block,
+        [](const gr::top_block_sptr&) {});
+}
+
+
+/*
+ * Runs a chain as the receiver builds it, with the given
+ * SignalConditioner.implementation. With Signal_Conditioner each stage runs
+ * in its own thread, so MSps is not the throughput of one core.
+ */
+void bm_conditioner_chain(benchmark::State& state, const std::string& implementation)
+{
+    const Cond_Benchmark_Chain& chain = chains()[state.range(0)];
+    state.SetLabel(chain.label);
+
+    auto config = std::make_shared<InMemoryConfiguration>();
+    config->set_property("GNSS-SDR.internal_fs_sps", "2046000");
+    config->set_property("SignalConditioner.implementation", implementation);
+    const std::array<std::string, 3> roles = {"DataTypeAdapter", "InputFilter", "Resampler"};
+    for (size_t i = 0; i < roles.size(); i++)
+        {
+            config->set_property(roles[i] + ".dump", "false");
+            for (const auto& property : chain.properties[i])
+                {
+                    config->set_property(roles[i] + "." + property.first, property.second);
+                }
+        }
+
+    GNSSBlockFactory factory;
+    auto conditioner = factory.GetSignalConditioner(config.get());
+    if (conditioner == nullptr)
+        {
+            state.SkipWithError("the signal conditioner could not be created");
+            return;
+        }
+    run_block(state, chain.input_item_type, chain.samples_per_item, sizeof(gr_complex), conditioner->get_left_block(), conditioner->get_right_block(),
+        [&conditioner](gr::top_block_sptr top_block) { conditioner->connect(std::move(top_block)); });
+}
+
+
+void bm_signal_conditioner(benchmark::State& state)
+{
+    bm_conditioner_chain(state, "Signal_Conditioner");
+}
+
+
+void bm_fused_signal_conditioner(benchmark::State& state)
+{
+    bm_conditioner_chain(state, "Fused_Signal_Conditioner");
+}
+}  // namespace
+
+
+// Argument: index in the stages(), unpackers() and chains() tables, shown as the label of the result
+BENCHMARK(bm_stage)->DenseRange(0, stages().size() - 1)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(bm_unpacker)->DenseRange(0, unpackers().size() - 1)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(bm_signal_conditioner)->DenseRange(0, chains().size() - 1)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(bm_fused_signal_conditioner)->DenseRange(0, chains().size() - 1)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_MAIN();
@@ -0,0 +1,511 @@
+/*!
+ * \file benchmark_telemetry_decoder.cc
+ * \brief Benchmark of the telemetry decoder blocks, replaying recorded or
+ * synthetic symbol streams, and of the stages of the Galileo I/NAV decoding
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "Beidou_DNAV.h"
+#include "GLONASS_L1_L2_CA.h"
+#include "GPS_L1_CA.h"
+#include "GPS_L2C.h"
+#include "GPS_L5.h"
+#include "Galileo_CNAV.h"
+#include "Galileo_E5a.h"
+#include "Galileo_INAV.h"
+#include "beidou_b1i_telemetry_decoder_gs.h"
+#include "beidou_b3i_telemetry_decoder_gs.h"
+#include "beidou_dnav_word_decoder.h"
+#include "galileo_inav_message.h"
+#include "galileo_telemetry_decoder_gs.h"
+#include "glonass_l1_ca_telemetry_decoder_gs.h"
+#include "glonass_l2_ca_telemetry_decoder_gs.h"
+#include "gnss_bit_stream.h"
+#include "gnss_nav_product_channel.h"
+#include "gnss_satellite.h"
+#include "gnss_sign_correlator.h"
+#include "gnss_synchro.h"
+#include "gps_l1_ca_telemetry_decoder_gs.h"
+#include "gps_l2c_telemetry_decoder_gs.h"
+#include "gps_l5_telemetry_decoder_gs.h"
+#include "sbas_l1_telemetry_decoder_gs.h"
+#include "tlm_conf.h"
+#include "tlm_deinterleaver.h"
+#include "tlm_dump_reader.h"
+#include "viterbi_decoder.h"
+#include <benchmark/benchmark.h>
+#include <boost/circular_buffer.hpp>
+#include <gnuradio/top_block.h>
+#include <array>
+#include <cstdint>
+#include <cstring>  // for std::memcpy
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#ifdef GR_GREATER_38
+#include <gnuradio/blocks/vector_sink.h>
+#include <gnuradio/blocks/vector_source.h>
+#else
+#include <gnuradio/blocks/vector_sink_b.h>
+#include <gnuradio/blocks/vector_source_b.h>
+#endif
+
+namespace
+{
+struct Tlm_Benchmark_Signal
+{
+    const char* signal;
+    const char* system;
+    char system_id;  // as in Gnss_Synchro::System
+    int32_t prn;
+    int32_t symbols_per_second;  // rate of the symbols delivered by tracking
+    int32_t symbols_per_page;    // symbols of a page, subframe or string
+};
+
+
+const std::array<Tlm_Benchmark_Signal, 12> TLM_SIGNALS = {{
+    {"1C", "GPS", 'G', 1, 1000 / static_cast<int32_t>(GPS_L1_CA_BIT_PERIOD_MS), GPS_SUBFRAME_BITS},
+    {"2S", "GPS", 'G', 1, GPS_L2_CNAV_DATA_PAGE_SYMBOLS / GPS_L2_CNAV_DATA_PAGE_DURATION_S, GPS_L2_CNAV_DATA_PAGE_SYMBOLS},
+    {"L5", "GPS", 'G', 1, GPS_L5_CNAV_DATA_PAGE_SYMBOLS / GPS_L5_CNAV_DATA_PAGE_DURATION_S, GPS_L5_CNAV_DATA_PAGE_SYMBOLS},
+    {"1B", "Galileo", 'E', 1, 250, GALILEO_INAV_PAGE_SYMBOLS},
+    {"5X", "Galileo", 'E', 1, 50, GALILEO_FNAV_SYMBOLS_PER_PAGE},
+    {"7X", "Galileo", 'E', 1, 250, GALILEO_INAV_PAGE_SYMBOLS},
+    {"E6", "Galileo", 'E', 1, 1000, GALILEO_CNAV_SYMBOLS_PER_PAGE},
+    {"B1", "Beidou", 'C', 6, 50, BEIDOU_DNAV_SUBFRAME_SYMBOLS},  // MEO/IGSO satellite, D1 message
+    {"B3", "Beidou", 'C', 6, 50, BEIDOU_DNAV_SUBFRAME_SYMBOLS},
+    {"1G", "Glonass", 'R', 1, 1000, GLONASS_GNAV_STRING_SYMBOLS},
+    {"2G", "Glonass", 'R', 1, 1000, GLONASS_GNAV_STRING_SYMBOLS},
+    {"SBAS", "SBAS", 'S', 120, 500, 500}}};
+
+// Pages of the synthetic stream used when there is no recording
+constexpr int32_t SYNTHETIC_PAGES = 30;
+
+// Recordings given in the command line, by signal
+std::map<std::string, std::string> tlm_dump_files;
+
+
+gr::basic_block_sptr make_telemetry_decoder(const Tlm_Benchmark_Signal& sig, const Gnss_Satellite& satellite)
+{
+    const std::string signal(sig.signal);
+    const Tlm_Conf conf;
+    if (signal == "1C")
+        {
+            return gps_l1_ca_make_telemetry_decoder_gs(satellite, conf);
+        }
+    if (signal == "2S")
+        {
+            return gps_l2c_make_telemetry_decoder_gs(satellite, conf);
+        }
+    if (signal == "L5")
+        {
+            return gps_l5_make_telemetry_decoder_gs(satellite, conf);
+        }
+    if (signal == "1B" || signal == "7X")
+        {
+            return galileo_make_telemetry_decoder_gs(satellite, conf, 1);  // INAV
+        }
+    if (signal == "5X")
+        {
+            return galileo_make_telemetry_decoder_gs(satellite, conf, 2);  // FNAV
+        }
+    if (signal == "E6")
+        {
+            return galileo_make_telemetry_decoder_gs(satellite, conf, 3);  // CNAV
+        }
+    if (signal == "B1")
+        {
+            return beidou_b1i_make_telemetry_decoder_gs(satellite, conf);
+        }
+    if (signal == "B3")
+        {
+            return beidou_b3i_make_telemetry_decoder_gs(satellite, conf);
+        }
+    if (signal == "1G")
+        {
+            return glonass_l1_ca_make_telemetry_decoder_gs(satellite, conf);
+        }
+    if (signal == "2G")
+        {
+            return glonass_l2_ca_make_telemetry_decoder_gs(satellite, conf);
+        }
+    return sbas_l1_make_telemetry_decoder_gs(satellite, false);
+}
+
+
+/*
+ * Symbol stream fed to the decoder. It is read from a telemetry decoder dump
+ * (as read by Tlm_Dump_Reader) if one was given for the signal, or made of
+ * random symbols otherwise. The symbols are set both in Prompt_I and in
+ * Prompt_Q, since the Galileo E5a decoder reads the latter.
+ */
+std::vector<Gnss_Synchro> symbol_stream(const Tlm_Benchmark_Signal& sig, bool& recorded)
+{
+    const auto fs = 4.0e6;
+    const auto samples_per_symbol = static_cast<uint64_t>(fs) / static_cast<uint64_t>(sig.symbols_per_second);
+    Gnss_Synchro symbol{};
+    symbol.System = sig.system_id;
+    std::string(sig.signal).copy(symbol.Signal, 2, 0);
+    symbol.PRN = sig.prn;
+    symbol.fs = static_cast<int64_t>(fs);
+    symbol.Flag_valid_symbol_output = true;
+
+    std::vector<Gnss_Synchro> stream;
+    recorded = false;
+    const auto file = tlm_dump_files.find(sig.signal);
+    if (file != tlm_dump_files.end())
+        {
+            Tlm_Dump_Reader reader;
+            if (reader.open_obs_file(file->second))
+                {
+                    const int64_t n = reader.num_epochs();
+                    stream.reserve(n);
+                    for (int64_t k = 0; k < n && reader.read_binary_obs(); k++)
+                        {
+                            symbol.PRN = static_cast<uint32_t>(reader.prn);
+                            symbol.Tracking_sample_counter = reader.Tracking_sample_counter;
+                            symbol.Prompt_I = static_cast<double>(reader.nav_symbol);
+                            symbol.Prompt_Q = symbol.Prompt_I;
+                            stream.push_back(symbol);
+                        }
+                    recorded = !stream.empty();
+                }
+        }
+    if (!recorded)
+        {
+            const int32_t n = SYNTHETIC_PAGES * sig.symbols_per_page;
+            std::default_random_engine e2(1);
+            std::uniform_int_distribution<int32_t> dist(0, 1);
+            stream.reserve(n);
+            for (int32_t k = 0; k < n; k++)
+                {
+                    symbol.Tracking_sample_counter = static_cast<uint64_t>(k) * samples_per_symbol;
+                    symbol.Prompt_I = dist(e2) ? 1.0 : -1.0;
+                    symbol.Prompt_Q = symbol.Prompt_I;
+                    stream.push_back(symbol);
+                }
+        }
+    return stream;
+}
+
+
+/*
+ * Replays the symbol stream through the telemetry decoder block, in a GNU
+ * Radio flowgraph. Each iteration replays the whole stream.
+ */
+void bm_telemetry_decoder(benchmark::State& state)
+{
+    const Tlm_Benchmark_Signal& sig = TLM_SIGNALS[state.range(0)];
+    bool recorded = false;
+    const std::vector<Gnss_Synchro> stream = symbol_stream(sig, recorded);
+    state.SetLabel(std::string(sig.signal) + (recorded ? " recorded" : " synthetic"));
+    if (stream.empty())
+        {
+            state.SkipWithError("Empty symbol stream");
+            return;
+        }
+
+    std::vector<uint8_t> stream_bytes(stream.size() * sizeof(Gnss_Synchro));
+    std::memcpy(stream_bytes.data(), stream.data(), stream_bytes.size());
+
+    const Gnss_Satellite satellite(sig.system, stream[0].PRN);
+    auto top_block = gr::make_top_block("Telemetry decoder benchmark");
+    auto decoder = make_telemetry_decoder(sig, satellite);
+    auto source = gr::blocks::vector_source_b::make(stream_bytes, false, sizeof(Gnss_Synchro));
+    auto sink = gr::blocks::vector_sink_b::make(sizeof(Gnss_Synchro));
+    top_block->connect(source, 0, decoder, 0);
+    top_block->connect(decoder, 0, sink, 0);
+
+    // The decoders deliver their navigation data to PVT through the product channels
+    Gnss_Nav_Product_Reader nav_product_reader;
+    std::vector<Gnss_Nav_Product> nav_products;
+
+    uint64_t valid_words = 0;
+    uint64_t output_symbols = 0;
+    while (state.KeepRunning())
+        {
+            source->rewind();
+            sink->reset();
+            top_block->run();
+
+            state.PauseTiming();
+            const std::vector<uint8_t> out_bytes = sink->data();
+            const size_t n_out = out_bytes.size() / sizeof(Gnss_Synchro);
+            const auto* out_symbols = reinterpret_cast<const Gnss_Synchro*>(out_bytes.data());
+            for (size_t k = 0; k < n_out; k++)
+                {
+                    if (out_symbols[k].Flag_valid_word)
+                        {
+                            valid_words++;
+                        }
+                }
+            output_symbols += n_out;
+            nav_products.clear();
+            nav_product_reader.drain(nav_products);
+            state.ResumeTiming();
+        }
+
+    const auto symbols = static_cast<double>(state.iterations()) * static_cast<double>(stream.size());
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(stream.size()));
+    state.counters["pages_per_second"] = benchmark::Counter(symbols / sig.symbols_per_page, benchmark::Counter::kIsRate);
+    // Number of channels of this signal that the decoder can keep up with in real time
+    state.counters["realtime_channels"] = benchmark::Counter(symbols / sig.symbols_per_second, benchmark::Counter::kIsRate);
+    // Fraction of the input symbols delivered with a valid TOW. It is zero for
+    // a synthetic stream, which never passes the CRC / parity checks.
+    state.counters["synced_fraction"] = valid_words / symbols;
+    state.counters["output_fraction"] = output_symbols / symbols;
+}
+
+
+/*
+ * Per-stage benchmarks of the Galileo I/NAV decoding (E1B and E5b). Each
+ * iteration processes one page part (250 symbols), except the preamble
+ * correlation, which runs once per symbol, and the message parse, which runs
+ * once per word.
+ */
+constexpr int32_t INAV_FRAME_SYMBOLS = GALILEO_INAV_PAGE_PART_SYMBOLS - GALILEO_INAV_PREAMBLE_LENGTH_BITS;
+
+
+std::vector<float> random_symbols(int32_t n)
+{
+    std::vector<float> symbols(n);
+    std::default_random_engine e2(1);
+    std::normal_distribution<float> dist(1.0, 0.5);
+    std::uniform_int_distribution<int32_t> sign(0, 1);
+    for (auto& s : symbols)
+        {
+            s = sign(e2) ? dist(e2) : -dist(e2);
+        }
+    return symbols;
+}
+
+
+void bm_stage_preamble_correlation(benchmark::State& state)
+{
+    std::array<int32_t, GALILEO_INAV_PREAMBLE_LENGTH_BITS> preamble_samples{};
+    for (int32_t i = 0; i < GALILEO_INAV_PREAMBLE_LENGTH_BITS; i++)
+        {
+            preamble_samples[i] = (GALILEO_INAV_PREAMBLE[i] == '1') ? 1 : -1;
+        }
+    const std::vector<float> symbols = random_symbols(GALILEO_INAV_PAGE_SYMBOLS);
+    boost::circular_buffer<float> symbol_history(GALILEO_INAV_PAGE_SYMBOLS + GALILEO_INAV_PREAMBLE_LENGTH_BITS + 1);
+    size_t k = 0;
+    while (state.KeepRunning())
+        {
+            // as in the decoder, with the history full: one new symbol, one correlation
+            symbol_history.push_back(symbols[k]);
+            k = (k + 1) % symbols.size();
+            int32_t corr_value = 0;
+            for (int32_t i = 0; i < GALILEO_INAV_PREAMBLE_LENGTH_BITS; i++)
+                {
+                    if (symbol_history[i] < 0.0)
+                        {
+                            corr_value -= preamble_samples[i];
+                        }
+                    else
+                        {
+                            corr_value += preamble_samples[i];
+                        }
+                }
+            benchmark::DoNotOptimize(corr_value);
+        }
+    state.SetItemsProcessed(state.iterations());
+}
+
+
+void bm_stage_preamble_correlation_packed(benchmark::State& state)
+{
+    std::vector<int32_t> preamble_samples(GALILEO_INAV_PREAMBLE_LENGTH_BITS);
+    for (int32_t i = 0; i < GALILEO_INAV_PREAMBLE_LENGTH_BITS; i++)
+        {
+            preamble_samples[i] = (GALILEO_INAV_PREAMBLE[i] == '1') ? 1 : -1;
+        }
+    const std::vector<float> symbols = random_symbols(GALILEO_INAV_PAGE_SYMBOLS);
+    Gnss_Sign_Correlator correlator(preamble_samples, GALILEO_INAV_PAGE_SYMBOLS + GALILEO_INAV_PREAMBLE_LENGTH_BITS + 1);
+    size_t k = 0;
+    while (state.KeepRunning())
+        {
+            // the same, with the signs of the history packed in words
+            correlator.push(symbols[k]);
+            k = (k + 1) % symbols.size();
+            const int32_t corr_value = correlator.correlation();
+            benchmark::DoNotOptimize(corr_value);
+        }
+    state.SetItemsProcessed(state.iterations());
+}
+
+
+void bm_stage_deinterleave(benchmark::State& state)
+{
+    const std::vector<float> in = random_symbols(INAV_FRAME_SYMBOLS);
+    std::vector<float> out(INAV_FRAME_SYMBOLS);
+    while (state.KeepRunning())
+        {
+            for (int32_t r = 0; r < GALILEO_INAV_INTERLEAVER_ROWS; r++)
+                {
+                    for (int32_t c = 0; c < GALILEO_INAV_INTERLEAVER_COLS; c++)
+                        {
+                            out[c * GALILEO_INAV_INTERLEAVER_ROWS + r] = in[r * GALILEO_INAV_INTERLEAVER_COLS + c];
+                        }
+                }
+            // NOT gate in G2 polynomial
+            for (int32_t i = 0; i < INAV_FRAME_SYMBOLS; i++)
+                {
+                    if ((i + 1) % 2 == 0)
+                        {
+                            out[i] = -out[i];
+                        }
+                }
+            benchmark::DoNotOptimize(out.data());
+        }
+    state.SetItemsProcessed(state.iterations() * INAV_FRAME_SYMBOLS);
+}
+
+
+void bm_stage_deinterleave_table(benchmark::State& state)
+{
+    // the same, with the permutation and the signs in a table
+    const Tlm_Deinterleaver deinterleaver(GALILEO_INAV_INTERLEAVER_ROWS, GALILEO_INAV_INTERLEAVER_COLS, true);
+    const std::vector<float> in = random_symbols(INAV_FRAME_SYMBOLS);
+    std::vector<float> out(INAV_FRAME_SYMBOLS);
+    while (state.KeepRunning())
+        {
+            deinterleaver.deinterleave(in.data(), out.data(), false);
+            benchmark::DoNotOptimize(out.data());
+        }
+    state.SetItemsProcessed(state.iterations() * INAV_FRAME_SYMBOLS);
+}
+
+
+void bm_stage_beidou_words(benchmark::State& state)
+{
+    // slicing and BCH(15,11) correction of the words of a BeiDou DNAV subframe
+    const std::vector<float> symbols = random_symbols(BEIDOU_DNAV_WORDS_SUBFRAME * BEIDOU_DNAV_WORD_LENGTH_BITS);
+    std::string bits(BEIDOU_DNAV_WORDS_SUBFRAME * BEIDOU_DNAV_WORD_LENGTH_BITS, '0');
+    while (state.KeepRunning())
+        {
+            for (uint32_t i = 0; i < BEIDOU_DNAV_WORDS_SUBFRAME; i++)
+                {
+                    beidou_dnav_decode_word(i == 0, &symbols[i * BEIDOU_DNAV_WORD_LENGTH_BITS], 1.0F, &bits[i * BEIDOU_DNAV_WORD_LENGTH_BITS]);
+                }
+            benchmark::DoNotOptimize(&bits[0]);
+        }
+    state.SetItemsProcessed(state.iterations() * BEIDOU_DNAV_WORDS_SUBFRAME * BEIDOU_DNAV_WORD_LENGTH_BITS);
+}
+
+
+void bm_stage_viterbi(benchmark::State& state)
+{
+    // same code and block length as the Galileo I/NAV decoder
+    const int32_t KK = 7;
+    const int32_t nn = 2;
+    const std::array<int32_t, 2> g_encoder{{121, 91}};
+    Viterbi_Decoder viterbi(KK, nn, (INAV_FRAME_SYMBOLS / nn) - (KK - 1), g_encoder);
+    const std::vector<float> symbols = random_symbols(INAV_FRAME_SYMBOLS);
+    std::vector<int32_t> bits(INAV_FRAME_SYMBOLS / nn);
+    while (state.KeepRunning())
+        {
+            viterbi.decode(bits, symbols);
+            benchmark::DoNotOptimize(bits.data());
+        }
+    state.SetItemsProcessed(state.iterations() * INAV_FRAME_SYMBOLS);
+}
+
+
+void bm_stage_crc(benchmark::State& state)
+{
+    // CRC-24Q of the even and odd page parts, as checked by Galileo_Inav_Message
+    constexpr std::size_t crc_bits = 196;
+    std::default_random_engine e2(1);
+    std::uniform_int_distribution<int32_t> dist(0, 1);
+    Gnss_Bit_Stream<crc_bits> bits;
+    for (std::size_t i = 0; i < crc_bits; i++)
+        {
+            bits.push_back(dist(e2) == 1);
+        }
+    while (state.KeepRunning())
+        {
+            benchmark::DoNotOptimize(bits.crc24q(crc_bits));
+        }
+    state.SetItemsProcessed(state.iterations() * INAV_FRAME_SYMBOLS);
+}
+
+
+void bm_stage_message_parse(benchmark::State& state)
+{
+    // Data_jk of the ephemeris words 1 to 5, with random contents
+    std::default_random_engine e2(1);
+    std::uniform_int_distribution<int32_t> dist(0, 1);
+    std::array<Galileo_Inav_Data_Jk, 5> words;
+    for (uint64_t w = 0; w < words.size(); w++)
+        {
+            words[w].append(w + 1, 6);  // word type
+            for (int32_t i = 6; i < GALILEO_DATA_JK_BITS; i++)
+                {
+                    words[w].push_back(dist(e2) == 1);
+                }
+        }
+    Galileo_Inav_Message inav_message;
+    size_t k = 0;
+    while (state.KeepRunning())
+        {
+            benchmark::DoNotOptimize(inav_message.page_jk_decoder(words[k]));
+            k = (k + 1) % words.size();
+        }
+    state.SetItemsProcessed(state.iterations());
+}
+}  // namespace
+
+
+// Argument: index in TLM_SIGNALS (1C, 2S, L5, 1B, 5X, 7X, E6, B1, B3, 1G, 2G, SBAS)
+BENCHMARK(bm_telemetry_decoder)->DenseRange(0, TLM_SIGNALS.size() - 1)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(bm_stage_preamble_correlation);
+BENCHMARK(bm_stage_preamble_correlation_packed);
+BENCHMARK(bm_stage_deinterleave);
+BENCHMARK(bm_stage_deinterleave_table);
+BENCHMARK(bm_stage_viterbi);
+BENCHMARK(bm_stage_crc);
+BENCHMARK(bm_stage_message_parse);
+BENCHMARK(bm_stage_beidou_words);
+
+
+/*
+ * --tlm_dump_<signal>=<file> replays a telemetry decoder dump of that signal
+ * (e.g., --tlm_dump_1B=telemetry3.dat). The other options are those of
+ * Benchmark.
+ */
+int main(int argc, char** argv)
+{
+    const std::string dump_option("--tlm_dump_");
+    std::vector<char*> benchmark_args;
+    for (int i = 0; i < argc; i++)
+        {
+            const std::string arg(argv[i]);
+            const size_t equal = arg.find('=');
+            if (i > 0 && arg.compare(0, dump_option.size(), dump_option) == 0 && equal != std::string::npos)
+                {
+                    tlm_dump_files[arg.substr(dump_option.size(), equal - dump_option.size())] = arg.substr(equal + 1);
+                }
+            else
+                {
+                    benchmark_args.push_back(argv[i]);
+                }
+        }
+    int benchmark_argc = static_cast<int>(benchmark_args.size());
+    benchmark::Initialize(&benchmark_argc, benchmark_args.data());
+    if (benchmark::ReportUnrecognizedArguments(benchmark_argc, benchmark_args.data()))
+        {
+            return 1;
+        }
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
@@ -54,13 +54,32 @@ DECLARE_string(log_dir);
 #include "unit-tests/arithmetic/magnitude_squared_test.cc"
 #include "unit-tests/arithmetic/multiply_test.cc"
 #include "unit-tests/arithmetic/preamble_correlator_test.cc"
+#include "unit-tests/control-plane/capacity_planner_test.cc"
+#include "unit-tests/control-plane/concurrent_queue_test.cc"
+#include "unit-tests/control-plane/control_event_test.cc"
 #include "unit-tests/control-plane/control_thread_test.cc"
 #include "unit-tests/control-plane/file_configuration_test.cc"
+#include "unit-tests/control-plane/flowgraph_conf_test.cc"
+#include "unit-tests/control-plane/flowgraph_instrumentation_test.cc"
 #include "unit-tests/control-plane/gnss_block_factory_test.cc"
 #include "unit-tests/control-plane/gnss_flowgraph_test.cc"
+#include "unit-tests/control-plane/gnss_signal_queue_test.cc"
 #include "unit-tests/control-plane/in_memory_configuration_test.cc"
+#include "unit-tests/control-plane/monitor_subscriptions_test.cc"
 #include "unit-tests/control-plane/protobuf_test.cc"
+#include "unit-tests/control-plane/realtime_budget_test.cc"
+#include "unit-tests/control-plane/stream_buffer_policy_test.cc"
 #include "unit-tests/control-plane/string_converter_test.cc"
+#include "unit-tests/control-plane/tcp_cmd_interface_test.cc"
+#include "unit-tests/signal-processing-blocks/acquisition/acq_code_spectrum_cache_test.cc"
+#include "unit-tests/signal-processing-blocks/acquisition/acq_grid_recorder_test.cc"
+#include "unit-tests/signal-processing-blocks/acquisition/acq_high_sensitivity_search_test.cc"
+#include "unit-tests/signal-processing-blocks/acquisition/acq_pcps_engine_test.cc"
+#include "unit-tests/signal-processing-blocks/acquisition/acq_shared_front_end_test.cc"
+#include "unit-tests/signal-processing-blocks/acquisition/acq_sky_search_test.cc"
+#include "unit-tests/signal-processing-blocks/acquisition/acq_snapshot_search_test.cc"
+#include "unit-tests/signal-processing-blocks/acquisition/acq_workspace_pool_test.cc"
+#include "unit-tests/signal-processing-blocks/acquisition/acquisition_thread_pool_test.cc"
 #include "unit-tests/signal-processing-blocks/acquisition/galileo_e1_pcps_8ms_ambiguous_acquisition_gsoc2013_test.cc"
 #include "unit-tests/signal-processing-blocks/acquisition/galileo_e1_pcps_ambiguous_acquisition_gsoc2013_test.cc"
 #include "unit-tests/signal-processing-blocks/acquisition/galileo_e1_pcps_ambiguous_acquisition_gsoc_test.cc"
@@ -77,18 +96,57 @@ DECLARE_string(log_dir);
 #include "unit-tests/signal-processing-blocks/acquisition/gps_l1_ca_pcps_quicksync_acquisition_gsoc2014_test.cc"
 #include "unit-tests/signal-processing-blocks/acquisition/gps_l1_ca_pcps_tong_acquisition_gsoc2013_test.cc"
 #include "unit-tests/signal-processing-blocks/adapter/adapter_test.cc"
+#include "unit-tests/signal-processing-blocks/adapter/bit_selector_test.cc"
 #include "unit-tests/signal-processing-blocks/adapter/pass_through_test.cc"
+#include "unit-tests/signal-processing-blocks/filter/beamformer_weights_test.cc"
 #include "unit-tests/signal-processing-blocks/filter/fir_filter_test.cc"
+#include "unit-tests/signal-processing-blocks/filter/fused_conditioner_test.cc"
+#include "unit-tests/signal-processing-blocks/filter/interference_mitigation_test.cc"
 #include "unit-tests/signal-processing-blocks/filter/notch_filter_lite_test.cc"
 #include "unit-tests/signal-processing-blocks/filter/notch_filter_test.cc"
 #include "unit-tests/signal-processing-blocks/filter/pulse_blanking_filter_test.cc"
+#include "unit-tests/signal-processing-blocks/filter/xlating_decimator_test.cc"
 #include "unit-tests/signal-processing-blocks/resampler/direct_resampler_conditioner_cc_test.cc"
 #include "unit-tests/signal-processing-blocks/resampler/mmse_resampler_test.cc"
+#include "unit-tests/signal-processing-blocks/resampler/rational_resampler_test.cc"
+#include "unit-tests/signal-processing-blocks/sources/capture_file_source_test.cc"
 #include "unit-tests/signal-processing-blocks/sources/file_signal_source_test.cc"
+#include "unit-tests/signal-processing-blocks/sources/gnss_capture_ring_test.cc"
+#include "unit-tests/signal-processing-blocks/sources/gnss_sdr_ingest_monitor_test.cc"
+#include "unit-tests/signal-processing-blocks/sources/gnss_sdr_rx_time_timestamp_test.cc"
 #include "unit-tests/signal-processing-blocks/sources/gnss_sdr_valve_test.cc"
+#include "unit-tests/signal-processing-blocks/sources/mmap_file_source_test.cc"
+#include "unit-tests/signal-processing-blocks/sources/sample_bus_source_test.cc"
+#include "unit-tests/signal-processing-blocks/sources/sample_push_source_test.cc"
+#include "unit-tests/signal-processing-blocks/sources/sample_stream_source_test.cc"
+#include "unit-tests/signal-processing-blocks/sources/signal_generator_c_test.cc"
+#include "unit-tests/signal-processing-blocks/sources/signal_replica_test.cc"
 #include "unit-tests/signal-processing-blocks/sources/unpack_2bit_samples_test.cc"
 // #include "unit-tests/signal-processing-blocks/acquisition/glonass_l2_ca_pcps_acquisition_test.cc"
+#include "unit-tests/signal-processing-blocks/libs/channel_fsm_test.cc"
+#include "unit-tests/signal-processing-blocks/libs/gnss_dump_writer_test.cc"
+#include "unit-tests/signal-processing-blocks/libs/gnss_nav_product_channel_test.cc"
+#include "unit-tests/signal-processing-blocks/libs/gnss_navigation_state_test.cc"
+#include "unit-tests/signal-processing-blocks/libs/gnss_pipeline_latency_test.cc"
+#include "unit-tests/signal-processing-blocks/libs/gnss_replica_cache_test.cc"
+#include "unit-tests/signal-processing-blocks/libs/gnss_sample_clock_test.cc"
+#include "unit-tests/signal-processing-blocks/libs/gnss_shm_ring_test.cc"
+#include "unit-tests/signal-processing-blocks/libs/gnss_sign_correlator_test.cc"
+#include "unit-tests/signal-processing-blocks/libs/gnss_sky_prediction_test.cc"
+#include "unit-tests/signal-processing-blocks/libs/gnss_spectral_monitor_test.cc"
+#include "unit-tests/signal-processing-blocks/libs/gnss_time_tag_channel_test.cc"
+#include "unit-tests/signal-processing-blocks/libs/gnss_trace_test.cc"
+#include "unit-tests/signal-processing-blocks/libs/gnss_udp_sender_test.cc"
 #include "unit-tests/signal-processing-blocks/libs/item_type_helpers_test.cc"
+#include "unit-tests/signal-processing-blocks/libs/rtklib_lambda_test.cc"
+#include "unit-tests/signal-processing-blocks/libs/rtklib_pntpos_test.cc"
+#include "unit-tests/signal-processing-blocks/libs/rtklib_preceph_test.cc"
+#include "unit-tests/signal-processing-blocks/libs/rtklib_rtcm_test.cc"
+#include "unit-tests/signal-processing-blocks/libs/rtklib_rtkcmn_test.cc"
+#include "unit-tests/signal-processing-blocks/libs/rtklib_sbas_test.cc"
+#include "unit-tests/signal-processing-blocks/observables/gnss_synchro_epoch_gather_test.cc"
+#include "unit-tests/signal-processing-blocks/observables/gnss_synchro_history_test.cc"
+#include "unit-tests/signal-processing-blocks/observables/obs_kernels_test.cc"
 
 #if OPENCL_BLOCKS_TEST
 #include "unit-tests/signal-processing-blocks/acquisition/gps_l1_ca_pcps_opencl_acquisition_gsoc2013_test.cc"
@@ -99,6 +157,8 @@ DECLARE_string(log_dir);
 #include "unit-tests/signal-processing-blocks/tracking/cubature_filter_test.cc"
 // #include "unit-tests/signal-processing-blocks/tracking/unscented_filter_test.cc"
 #endif
+#include "unit-tests/signal-processing-blocks/tracking/cpu_multicorrelator_8ic_test.cc"
+#include "unit-tests/signal-processing-blocks/tracking/cpu_multicorrelator_array_test.cc"
 #include "unit-tests/signal-processing-blocks/tracking/cpu_multicorrelator_real_codes_test.cc"
 #include "unit-tests/signal-processing-blocks/tracking/cpu_multicorrelator_test.cc"
 #include "unit-tests/signal-processing-blocks/tracking/discriminator_test.cc"
@@ -107,10 +167,15 @@ DECLARE_string(log_dir);
 #include "unit-tests/signal-processing-blocks/tracking/galileo_e5b_dll_pll_tracking_test.cc"
 #include "unit-tests/signal-processing-blocks/tracking/glonass_l1_ca_dll_pll_c_aid_tracking_test.cc"
 #include "unit-tests/signal-processing-blocks/tracking/glonass_l1_ca_dll_pll_tracking_test.cc"
+#include "unit-tests/signal-processing-blocks/tracking/lock_detectors_test.cc"
+#include "unit-tests/signal-processing-blocks/tracking/tcp_batch_communication_test.cc"
+#include "unit-tests/signal-processing-blocks/tracking/tracking_bank_test.cc"
 #include "unit-tests/signal-processing-blocks/tracking/tracking_loop_filter_test.cc"
+#include "unit-tests/signal-processing-blocks/tracking/tracking_worker_pool_test.cc"
 
 
 #if CUDA_BLOCKS_TEST
+#include "unit-tests/signal-processing-blocks/tracking/cuda_multicorrelator_bank_test.cc"
 #include "unit-tests/signal-processing-blocks/tracking/gpu_multicorrelator_test.cc"
 #endif
 
@@ -120,17 +185,36 @@ DECLARE_string(log_dir);
 #include "unit-tests/signal-processing-blocks/tracking/gps_l1_ca_dll_pll_tracking_test_fpga.cc"
 #endif
 
+#include "unit-tests/signal-processing-blocks/pvt/attitude_solver_test.cc"
+#include "unit-tests/signal-processing-blocks/pvt/monitor_pvt_packet_test.cc"
+#include "unit-tests/signal-processing-blocks/pvt/moving_window_statistics_test.cc"
+#include "unit-tests/signal-processing-blocks/pvt/pvt_text_output_test.cc"
 #include "unit-tests/signal-processing-blocks/pvt/nmea_printer_test.cc"
+#include "unit-tests/signal-processing-blocks/pvt/pvt_output_dispatcher_test.cc"
+#include "unit-tests/signal-processing-blocks/pvt/raw_obs_log_test.cc"
 #include "unit-tests/signal-processing-blocks/pvt/rinex_printer_test.cc"
+#include "unit-tests/signal-processing-blocks/pvt/rtcm_bitstream_test.cc"
 #include "unit-tests/signal-processing-blocks/pvt/rtcm_printer_test.cc"
 #include "unit-tests/signal-processing-blocks/pvt/rtcm_test.cc"
+#include "unit-tests/signal-processing-blocks/pvt/rtklib_corrections_test.cc"
 #include "unit-tests/signal-processing-blocks/pvt/serdes_monitor_pvt_test.cc"
+#include "unit-tests/signal-processing-blocks/pvt/snapshot_solver_test.cc"
 #include "unit-tests/signal-processing-blocks/telemetry_decoder/galileo_fnav_inav_decoder_test.cc"
+#include "unit-tests/signal-processing-blocks/telemetry_decoder/tlm_deinterleaver_test.cc"
+#include "unit-tests/signal-processing-blocks/telemetry_decoder/viterbi_k7_engine_test.cc"
 #include "unit-tests/system-parameters/galileo_e1b_reed_solomon_test.cc"
 #include "unit-tests/system-parameters/galileo_e6b_reed_solomon_test.cc"
+#include "unit-tests/system-parameters/galileo_reduced_ced_test.cc"
 #include "unit-tests/system-parameters/glonass_gnav_crc_test.cc"
 #include "unit-tests/system-parameters/glonass_gnav_ephemeris_test.cc"
 #include "unit-tests/system-parameters/glonass_gnav_nav_message_test.cc"
+#include "unit-tests/system-parameters/gnss_bit_stream_test.cc"
+#include "unit-tests/system-parameters/gnss_ephemeris_batch_test.cc"
+#include "unit-tests/system-parameters/gnss_nav_data_store_test.cc"
+#include "unit-tests/system-parameters/gnss_receiver_checkpoint_test.cc"
+#include "unit-tests/system-parameters/gnss_receiver_snapshot_test.cc"
+#include "unit-tests/system-parameters/gnss_signal_id_test.cc"
+#include "unit-tests/system-parameters/gnss_synchro_test.cc"
 
 #if EXTRA_TESTS
 #include "unit-tests/signal-processing-blocks/acquisition/acq_performance_test.cc"
@@ -21,8 +21,10 @@
 #include "test_flags.h"
 #include <algorithm>
 #include <chrono>
+#include <complex>
 #include <functional>
 #include <random>
+#include <vector>
 
 
 DEFINE_int32(fft_iterations_test, 1000, "Number of averaged iterations in FFT length timing test");
@@ -146,3 +148,28 @@ TEST(FFTLengthTest, MeasureExecutionTime)
                 }
         }
 }
+
+
+TEST(FFTLengthTest, ThreadedPlansGiveTheSameSpectrum)
+{
+    const unsigned int fft_size = 4000;
+    std::vector<gr_complex> signal(fft_size);
+    for (unsigned int n = 0; n < fft_size; n++)
+        {
+            signal[n] = gr_complex(static_cast<float>(n % 7) - 3.0F, static_cast<float>(n % 5) - 2.0F);
+        }
+
+    auto single_thread_fft = gnss_fft_fwd_make_unique(fft_size);
+    gnss_fft_settings().nthreads = 2;
+    auto threaded_fft = gnss_fft_fwd_make_unique(fft_size);
+    gnss_fft_settings().nthreads = 1;
+
+    std::copy(signal.cbegin(), signal.cend(), single_thread_fft->get_inbuf());
+    std::copy(signal.cbegin(), signal.cend(), threaded_fft->get_inbuf());
+    single_thread_fft->execute();
+    threaded_fft->execute();
+    for (unsigned int k = 0; k < fft_size; k++)
+        {
+            EXPECT_NEAR(std::abs(threaded_fft->get_outbuf()[k] - single_thread_fft->get_outbuf()[k]), 0.0, 1e-2);
+        }
+}
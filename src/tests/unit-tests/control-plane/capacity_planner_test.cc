@@ -0,0 +1,96 @@
+/*!
+ * \file capacity_planner_test.cc
+ * \brief Implements Unit Tests for the estimates of the CPU, memory and
+ * buffers that a configuration needs.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "capacity_planner.h"
+#include "in_memory_configuration.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+#include <string>
+
+
+namespace
+{
+std::unique_ptr<InMemoryConfiguration> capacity_test_configuration(const std::string& fs, const std::string& conditioner)
+{
+    auto configuration = std::make_unique<InMemoryConfiguration>();
+    configuration->set_property("GNSS-SDR.internal_fs_sps", fs);
+    configuration->set_property("SignalSource.implementation", "File_Signal_Source");
+    configuration->set_property("SignalConditioner.implementation", conditioner);
+    configuration->set_property("Channels_1C.count", "8");
+    configuration->set_property("Acquisition_1C.doppler_max", "5000");
+    configuration->set_property("Acquisition_1C.doppler_step", "250");
+    configuration->set_property("Capacity.correlator_ns_per_sample", "0.8");
+    configuration->set_property("Capacity.multiply_ns_per_sample", "0.3");
+    configuration->set_property("Capacity.conditioner_ns_per_sample", "20");
+    return configuration;
+}
+
+
+const Capacity_Stage& capacity_test_stage(const Capacity_Planner& planner, const std::string& name)
+{
+    const auto& stages = planner.stages();
+    return *std::find_if(stages.cbegin(), stages.cend(), [&name](const Capacity_Stage& stage) { return stage.name == name; });
+}
+}  // namespace
+
+
+TEST(CapacityPlannerTest, EstimatesTheStagesOfTheConfiguration)
+{
+    const auto configuration = capacity_test_configuration("4000000", "Pass_Through");
+    const Capacity_Planner planner(configuration.get(), configuration.get(), 4);
+    ASSERT_EQ(planner.stages().size(), 7U);
+    EXPECT_EQ(planner.stages().front().name, "SignalSource");
+    EXPECT_EQ(planner.stages()[1].name, "SignalConditioner");
+
+    // 3 correlators and the carrier wipeoff of each sample
+    const Capacity_Stage& tracking = capacity_test_stage(planner, "Tracking_1C");
+    EXPECT_NEAR(tracking.thread_cores, 4e6 * (3 * 0.8 + 0.3) * 1e-9, 1e-9);
+    EXPECT_NEAR(tracking.cores, 8 * tracking.thread_cores, 1e-9);
+    EXPECT_TRUE(tracking.realtime);
+
+    // the buffers of the conditioner hold twice the samples of a dwell
+    EXPECT_EQ(capacity_test_stage(planner, "SignalConditioner").buffer_bytes, 65536U);
+    const Capacity_Stage& acquisition = capacity_test_stage(planner, "Acquisition_1C");
+    EXPECT_FALSE(acquisition.realtime);
+    EXPECT_GT(acquisition.memory_bytes, 8U * 41U * 4000U * 12U);
+
+    EXPECT_TRUE(planner.realtime_achievable());
+    EXPECT_GT(planner.total_memory_bytes(), 0U);
+    EXPECT_NE(planner.report().find("Real time is achievable"), std::string::npos);
+}
+
+
+TEST(CapacityPlannerTest, FindsTheStageThatSaturatesFirst)
+{
+    // the tracking of 8 channels at 100 Msps does not fit in one CPU
+    const auto configuration = capacity_test_configuration("100000000", "Pass_Through");
+    const Capacity_Planner one_cpu(configuration.get(), configuration.get(), 1);
+    bool cpus_bound = false;
+    EXPECT_FALSE(one_cpu.realtime_achievable());
+    EXPECT_EQ(one_cpu.saturating_stage(cpus_bound), "Tracking_1C");
+    EXPECT_TRUE(cpus_bound);
+    EXPECT_NEAR(one_cpu.headroom(), 1.0 / one_cpu.realtime_cores(), 1e-9);
+    EXPECT_NE(one_cpu.report().find("Real time is NOT achievable"), std::string::npos);
+
+    // with many CPUs, the fused conditioner fills its core first
+    const auto fused = capacity_test_configuration("100000000", "Fused_Signal_Conditioner");
+    const Capacity_Planner many_cpus(fused.get(), fused.get(), 16);
+    EXPECT_EQ(many_cpus.saturating_stage(cpus_bound), "SignalConditioner");
+    EXPECT_FALSE(cpus_bound);
+    EXPECT_NEAR(many_cpus.headroom(), 1.0 / (100e6 * 20e-9), 1e-9);
+    EXPECT_FALSE(many_cpus.realtime_achievable());
+}
@@ -0,0 +1,164 @@
+/*!
+ * \file concurrent_queue_test.cc
+ * \brief Implements Unit Tests for the thread-safe queue of the control
+ * plane.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "concurrent_queue.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+TEST(ConcurrentQueueTest, FifoOrder)
+{
+    Concurrent_Queue<int> queue;
+    int value = 0;
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.try_pop(value));
+    EXPECT_FALSE(queue.timed_wait_and_pop(value, 1));
+    for (int i = 0; i < 5; i++)
+        {
+            queue.push(i);
+        }
+    EXPECT_FALSE(queue.empty());
+    EXPECT_TRUE(queue.try_pop(value));
+    EXPECT_EQ(value, 0);
+    queue.push(5);
+
+    std::vector<int> values;
+    EXPECT_EQ(queue.try_pop_all(values), 5U);
+    EXPECT_EQ(values, std::vector<int>({1, 2, 3, 4, 5}));
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.timed_wait_and_pop_all(values, 1), 0U);
+    EXPECT_TRUE(values.empty());
+}
+
+
+TEST(ConcurrentQueueTest, ManyProducers)
+{
+    const int producers = 8;
+    const int items_per_producer = 10000;
+    Concurrent_Queue<std::pair<int, int>> queue;
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++)
+        {
+            threads.emplace_back([&queue, p] {
+                for (int i = 0; i < items_per_producer; i++)
+                    {
+                        queue.push(std::make_pair(p, i));
+                    }
+            });
+        }
+
+    // the items of each producer are popped in the order in which they were pushed
+    std::vector<int> next_item(producers, 0);
+    std::vector<std::pair<int, int>> batch;
+    int popped = 0;
+    while (popped < producers * items_per_producer)
+        {
+            queue.timed_wait_and_pop_all(batch, 1000);
+            ASSERT_FALSE(batch.empty());
+            for (const auto& item : batch)
+                {
+                    ASSERT_EQ(item.second, next_item[item.first]);
+                    next_item[item.first]++;
+                }
+            popped += static_cast<int>(batch.size());
+        }
+    for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    EXPECT_TRUE(queue.empty());
+}
+
+
+TEST(ConcurrentQueueTest, WakeUpWaitingConsumer)
+{
+    Concurrent_Queue<int> queue;
+    std::thread producer([&queue] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        queue.push(7);
+    });
+    int value = 0;
+    queue.wait_and_pop(value);
+    EXPECT_EQ(value, 7);
+    producer.join();
+}
+
+
+TEST(ConcurrentQueueTest, ManyWaitingConsumers)
+{
+    // a consumer that takes all the pushed items leaves the rest to the
+    // other ones, which have to wake up for them
+    const int consumers = 2;
+    const int rounds = 1000;
+    Concurrent_Queue<int> queue;
+    for (int r = 0; r < rounds; r++)
+        {
+            std::atomic<int> popped{0};
+            std::vector<std::thread> threads;
+            for (int c = 0; c < consumers; c++)
+                {
+                    threads.emplace_back([&queue, &popped] {
+                        int value = 0;
+                        queue.wait_and_pop(value);
+                        popped++;
+                    });
+                }
+            for (int c = 0; c < consumers; c++)
+                {
+                    queue.push(c);
+                }
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+            while (popped.load() < consumers && std::chrono::steady_clock::now() < deadline)
+                {
+                    std::this_thread::yield();
+                }
+            const int popped_in_time = popped.load();
+            for (int c = popped_in_time; c < consumers; c++)
+                {
+                    queue.push(-1);  // releases a stalled consumer
+                }
+            for (auto& thread : threads)
+                {
+                    thread.join();
+                }
+            ASSERT_EQ(popped_in_time, consumers) << "in round " << r;
+            ASSERT_TRUE(queue.empty());
+        }
+}
+
+
+TEST(ConcurrentQueueTest, WaitUntilDeadline)
+{
+    Concurrent_Queue<int> queue;
+    std::vector<int> values;
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(queue.wait_until_and_pop_all(values, start + std::chrono::milliseconds(30)), 0U);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(30));
+
+    // a push wakes up the consumer long before the deadline
+    std::thread producer([&queue] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        queue.push(3);
+        queue.push(4);
+    });
+    EXPECT_GE(queue.wait_until_and_pop_all(values, std::chrono::steady_clock::now() + std::chrono::seconds(10)), 1U);
+    producer.join();
+    EXPECT_EQ(values.front(), 3);
+}
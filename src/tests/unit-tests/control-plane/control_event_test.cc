@@ -0,0 +1,52 @@
+/*!
+ * \file control_event_test.cc
+ * \brief Tests of the compact events of the control queue
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "command_event.h"
+#include "control_event.h"
+#include <gtest/gtest.h>
+#include <pmt/pmt.h>
+#include <cstdint>
+
+
+TEST(ControlEventTest, PackAndUnpack)
+{
+    const Control_Event event{Control_Event::command, 412, 21};
+    Control_Event unpacked{};
+    ASSERT_TRUE(Control_Event::unpack(event.pack(), unpacked));
+    EXPECT_EQ(unpacked.kind, Control_Event::command);
+    EXPECT_EQ(unpacked.id, 412U);
+    EXPECT_EQ(unpacked.event_type, 21U);
+
+    EXPECT_FALSE(Control_Event::unpack(3, unpacked));
+    EXPECT_FALSE(Control_Event::unpack(static_cast<uint64_t>(Control_Event::tag | 7U) << 48, unpacked));
+}
+
+
+TEST(ControlEventTest, MessagesAreShared)
+{
+    const pmt::pmt_t msg = control_event_pmt(Control_Event::channel, 5, 2);
+    EXPECT_TRUE(pmt::eq(msg, control_event_pmt(Control_Event::channel, 5, 2)));
+    EXPECT_FALSE(pmt::eq(msg, control_event_pmt(Control_Event::channel, 5, 1)));
+
+    Control_Event event{};
+    ASSERT_TRUE(control_event_from_pmt(msg, event));
+    EXPECT_EQ(event.kind, Control_Event::channel);
+    EXPECT_EQ(event.id, 5U);
+    EXPECT_EQ(event.event_type, 2U);
+
+    // the other messages are not taken for events
+    EXPECT_FALSE(control_event_from_pmt(pmt::from_uint64(5), event));
+    EXPECT_FALSE(control_event_from_pmt(pmt::make_any(command_event_make(200, 0)), event));
+}
@@ -0,0 +1,62 @@
+/*!
+ * \file flowgraph_conf_test.cc
+ * \brief Implements Unit Tests for the snapshot of the configuration
+ * parameters read by the flowgraph while it is running.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "flowgraph_conf.h"
+#include "in_memory_configuration.h"
+#include <gtest/gtest.h>
+#include <memory>
+
+
+TEST(FlowgraphConfTest, Defaults)
+{
+    auto configuration = std::make_unique<InMemoryConfiguration>();
+    Flowgraph_Conf conf;
+    conf.SetFromConfiguration(configuration.get(), 4, true);
+    EXPECT_EQ(conf.channels_satellite.size(), 4U);
+    EXPECT_EQ(conf.channel_satellite(2), 0U);
+    EXPECT_EQ(conf.channels_1C, 0);
+    EXPECT_EQ(conf.channels_1B, 0);
+    // assistance of the secondary frequencies is enabled by default in multiband receivers
+    EXPECT_TRUE(conf.assist_dual_frequency_acq);
+    EXPECT_FALSE(conf.assist_code_phase_acq);
+    EXPECT_FALSE(conf.dual_frequency_handover);
+}
+
+
+TEST(FlowgraphConfTest, FixedSatellites)
+{
+    auto configuration = std::make_unique<InMemoryConfiguration>();
+    configuration->set_property("Channels_1C.count", "3");
+    configuration->set_property("Channel1.satellite", "22");
+    configuration->set_property("GNSS-SDR.assist_dual_frequency_acq", "false");
+    configuration->set_property("GNSS-SDR.assist_code_phase_acq", "true");
+    configuration->set_property("GNSS-SDR.dual_frequency_handover", "true");
+    Flowgraph_Conf conf;
+    conf.SetFromConfiguration(configuration.get(), 3, true);
+    EXPECT_EQ(conf.channel_satellite(0), 0U);
+    EXPECT_EQ(conf.channel_satellite(1), 22U);
+    EXPECT_EQ(conf.channel_satellite(3), 0U);  // out of range
+    EXPECT_EQ(conf.channels_1C, 3);
+    EXPECT_FALSE(conf.assist_dual_frequency_acq);
+    EXPECT_TRUE(conf.assist_code_phase_acq);
+    EXPECT_TRUE(conf.dual_frequency_handover);
+
+    // the snapshot is not updated until it is loaded again
+    configuration->supersede_property("Channel1.satellite", "5");
+    EXPECT_EQ(conf.channel_satellite(1), 22U);
+    conf.SetFromConfiguration(configuration.get(), 3, true);
+    EXPECT_EQ(conf.channel_satellite(1), 5U);
+}
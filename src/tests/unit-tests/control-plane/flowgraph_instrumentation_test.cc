@@ -0,0 +1,61 @@
+/*!
+ * \file flowgraph_instrumentation_test.cc
+ * \brief Implements Unit Tests for the instrumentation of the flowgraph
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "flowgraph_instrumentation.h"
+#include <gnuradio/blocks/head.h>
+#include <gnuradio/blocks/null_sink.h>
+#include <gnuradio/blocks/null_source.h>
+#include <gnuradio/top_block.h>
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+
+TEST(FlowgraphInstrumentationTest, ItemsAndQueueDepth)
+{
+    const std::string filename("./flowgraph_instrumentation_test.prom");
+    auto top_block = gr::make_top_block("FlowgraphInstrumentationTest");
+    auto source = gr::blocks::null_source::make(sizeof(float));
+    auto head = gr::blocks::head::make(sizeof(float), 10000);
+    auto sink = gr::blocks::null_sink::make(sizeof(float));
+    top_block->connect(source, 0, head, 0);
+    top_block->connect(head, 0, sink, 0);
+
+    FlowgraphInstrumentation instrumentation(filename, 1000);
+    instrumentation.add_block("Head", head);
+    instrumentation.add_block("Sink", sink);
+    instrumentation.add_block("Sink", sink);  // added only once
+    top_block->run();
+    instrumentation.sample(3, 2);
+
+    const std::string report = instrumentation.report();
+    EXPECT_NE(report.find("gnss_sdr_block_items_total{role=\"Head\",block=\"" + head->identifier() + "\"} 10000\n"), std::string::npos);
+    EXPECT_NE(report.find("gnss_sdr_block_items_total{role=\"Sink\",block=\"" + sink->identifier() + "\"} 10000\n"), std::string::npos);
+    EXPECT_EQ(report.find("gnss_sdr_block_items_total{role=\"Sink\""), report.rfind("gnss_sdr_block_items_total{role=\"Sink\""));
+    EXPECT_NE(report.find("gnss_sdr_acquisition_queue_depth 3\n"), std::string::npos);
+    EXPECT_NE(report.find("gnss_sdr_channels_in_acquisition 2\n"), std::string::npos);
+    // no rate before the second sample
+    EXPECT_EQ(report.find("gnss_sdr_block_items_per_second{"), std::string::npos);
+    instrumentation.sample(0, 0);
+    EXPECT_NE(instrumentation.report().find("gnss_sdr_block_items_per_second{role=\"Head\""), std::string::npos);
+
+    std::ifstream file(filename);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    EXPECT_EQ(contents.str(), instrumentation.report());
+    std::remove(filename.c_str());
+}
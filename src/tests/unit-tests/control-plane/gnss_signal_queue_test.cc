@@ -0,0 +1,72 @@
+/*!
+ * \file gnss_signal_queue_test.cc
+ * \brief Implements Unit Tests for the queue of the satellite signals
+ * available for acquisition.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_signal_queue.h"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <string>
+
+
+Gnss_Signal make_gps_l1_signal(uint32_t prn)
+{
+    return Gnss_Signal(Gnss_Satellite(std::string("GPS"), prn), std::string("1C"));
+}
+
+
+TEST(GnssSignalQueueTest, RoundRobin)
+{
+    Gnss_Signal_Queue queue;
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.next().get_satellite().get_PRN(), 0U);
+    for (uint32_t prn = 1; prn <= 3; prn++)
+        {
+            queue.push_back(make_gps_l1_signal(prn));
+        }
+    queue.push_back(make_gps_l1_signal(2));  // already in the queue, moved to the back
+    EXPECT_EQ(queue.size(), 3U);
+    EXPECT_EQ(queue.next().get_satellite().get_PRN(), 1U);
+    EXPECT_EQ(queue.next().get_satellite().get_PRN(), 3U);
+    EXPECT_EQ(queue.next().get_satellite().get_PRN(), 2U);
+    EXPECT_EQ(queue.next().get_satellite().get_PRN(), 1U);  // the signals are not consumed
+    EXPECT_EQ(queue.size(), 3U);
+}
+
+
+TEST(GnssSignalQueueTest, PriorizeAndRemove)
+{
+    Gnss_Signal_Queue queue;
+    for (uint32_t prn = 1; prn <= 5; prn++)
+        {
+            queue.push_back(make_gps_l1_signal(prn));
+        }
+    EXPECT_TRUE(queue.move_to_front(make_gps_l1_signal(4)));
+    EXPECT_FALSE(queue.move_to_front(make_gps_l1_signal(9)));  // not in the queue, so it is not inserted
+    EXPECT_TRUE(queue.remove(make_gps_l1_signal(1)));
+    EXPECT_FALSE(queue.remove(make_gps_l1_signal(1)));
+    EXPECT_FALSE(queue.contains(1));
+    EXPECT_TRUE(queue.contains(4));
+
+    Gnss_Signal gs;
+    EXPECT_TRUE(queue.take_first_if([](const Gnss_Signal& sig) { return sig.get_satellite().get_PRN() % 2 == 1; }, gs));
+    EXPECT_EQ(gs.get_satellite().get_PRN(), 3U);
+    EXPECT_FALSE(queue.contains(3));
+    EXPECT_FALSE(queue.take_first_if([](const Gnss_Signal& sig) { return sig.get_satellite().get_PRN() > 10; }, gs));
+
+    EXPECT_EQ(queue.next().get_satellite().get_PRN(), 4U);
+    EXPECT_EQ(queue.next().get_satellite().get_PRN(), 2U);
+    EXPECT_EQ(queue.next().get_satellite().get_PRN(), 5U);
+    EXPECT_EQ(queue.size(), 3U);
+}
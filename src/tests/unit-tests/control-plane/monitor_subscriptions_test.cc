@@ -0,0 +1,135 @@
+/*!
+ * \file monitor_subscriptions_test.cc
+ * \brief  This file implements unit tests for the Monitor_Subscriptions class
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "monitor_subscriptions.h"
+#include "serdes_gnss_synchro.h"
+#include <gtest/gtest.h>
+#include <netinet/in.h>
+#include <chrono>
+#include <cstring>
+#include <string>
+
+
+namespace
+{
+sockaddr_storage subscription_test_address(uint16_t port)
+{
+    sockaddr_storage address{};
+    auto* address_v4 = reinterpret_cast<sockaddr_in*>(&address);
+    address_v4->sin_family = AF_INET;
+    address_v4->sin_port = htons(port);
+    address_v4->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    return address;
+}
+
+
+Gnss_Synchro subscription_test_item(int32_t channel, uint32_t prn, const char* signal)
+{
+    Gnss_Synchro gs{};
+    gs.Channel_ID = channel;
+    gs.PRN = prn;
+    gs.System = 'G';
+    std::memcpy(static_cast<void*>(gs.Signal), signal, 3);
+    return gs;
+}
+}  // namespace
+
+
+TEST(MonitorSubscriptionsTest, ParseRequests)
+{
+    Monitor_Subscription subscription;
+    std::string error;
+    EXPECT_TRUE(Monitor_Subscriptions::parse("subscribe", subscription, error));
+    EXPECT_TRUE(subscription.channels.empty());
+    const uint64_t all_fields = Serdes_Gnss_Synchro::ALL_FIELDS;
+    EXPECT_EQ(subscription.fields, all_fields);
+
+    EXPECT_TRUE(Monitor_Subscriptions::parse("subscribe channels=0-2,7 prns=5 signals=1C,1B fields=cn0_db_hz decimation=10 lifetime=30", subscription, error));
+    EXPECT_EQ(subscription.channels, (std::set<int32_t>{0, 1, 2, 7}));
+    EXPECT_EQ(subscription.prns, (std::set<uint32_t>{5}));
+    EXPECT_EQ(subscription.signals, (std::set<std::string>{"1C", "1B"}));
+    EXPECT_EQ(subscription.decimation, 10);
+    EXPECT_EQ(subscription.lifetime_s, 30);
+    EXPECT_TRUE((subscription.fields >> gnss_sdr::GnssSynchro::kCn0DbHzFieldNumber) & 1ULL);
+    EXPECT_TRUE((subscription.fields >> gnss_sdr::GnssSynchro::kPrnFieldNumber) & 1ULL);
+    EXPECT_FALSE((subscription.fields >> gnss_sdr::GnssSynchro::kPromptIFieldNumber) & 1ULL);
+
+    EXPECT_FALSE(Monitor_Subscriptions::parse("subscribe fields=no_such_field", subscription, error));
+    EXPECT_FALSE(Monitor_Subscriptions::parse("subscribe channels=3-1", subscription, error));
+    EXPECT_FALSE(Monitor_Subscriptions::parse("subscribe decimation=0", subscription, error));
+    EXPECT_FALSE(Monitor_Subscriptions::parse("subscribe color=blue", subscription, error));
+    EXPECT_FALSE(Monitor_Subscriptions::parse("publish", subscription, error));
+}
+
+
+TEST(MonitorSubscriptionsTest, FilterDecimateAndExpire)
+{
+    Monitor_Subscriptions subscriptions(4);
+    const auto now = std::chrono::steady_clock::now();
+    const sockaddr_storage client_1 = subscription_test_address(5001);
+    const sockaddr_storage client_2 = subscription_test_address(5002);
+
+    EXPECT_EQ(subscriptions.handle_request("subscribe channels=1 decimation=2", client_1, sizeof(sockaddr_in), now), "OK");
+    EXPECT_EQ(subscriptions.handle_request("subscribe prns=9 lifetime=10", client_2, sizeof(sockaddr_in), now), "OK");
+    EXPECT_EQ(subscriptions.handle_request("subscribe prns=x", client_2, sizeof(sockaddr_in), now).substr(0, 5), "ERROR");
+    ASSERT_EQ(subscriptions.subscribers().size(), 2U);
+
+    for (int i = 0; i < 4; i++)
+        {
+            subscriptions.push(0, subscription_test_item(0, 9, "1C"));
+            subscriptions.push(1, subscription_test_item(1, 3, "1C"));
+        }
+    // the first item of channel 1, and then one out of two
+    EXPECT_EQ(subscriptions.subscribers()[0].pending.size(), 2U);
+    // all the items of PRN 9
+    EXPECT_EQ(subscriptions.subscribers()[1].pending.size(), 4U);
+
+    // renewing a subscription replaces it
+    EXPECT_EQ(subscriptions.handle_request("subscribe channels=1 decimation=2", client_1, sizeof(sockaddr_in), now), "OK");
+    EXPECT_EQ(subscriptions.subscribers().size(), 2U);
+    EXPECT_TRUE(subscriptions.subscribers()[0].pending.empty());
+
+    subscriptions.remove_expired(now + std::chrono::seconds(20));
+    ASSERT_EQ(subscriptions.subscribers().size(), 1U);
+    EXPECT_EQ(subscriptions.subscribers()[0].subscription.decimation, 2);
+
+    EXPECT_EQ(subscriptions.handle_request("unsubscribe", client_1, sizeof(sockaddr_in), now), "OK");
+    EXPECT_TRUE(subscriptions.empty());
+}
+
+
+TEST(MonitorSubscriptionsTest, SerializeSelectedFields)
+{
+    Serdes_Gnss_Synchro serdes;
+    std::vector<Gnss_Synchro> vgs{subscription_test_item(2, 7, "1C")};
+    vgs[0].CN0_dB_hz = 45.0;
+    vgs[0].Prompt_I = 1000.0;
+
+    uint64_t fields = 0;
+    ASSERT_TRUE(Serdes_Gnss_Synchro::field_mask({"cn0_db_hz"}, fields));
+    std::string all;
+    std::string selected;
+    serdes.createProtobuffer(vgs, all);
+    serdes.createProtobuffer(vgs, selected, fields);
+    EXPECT_LT(selected.size(), all.size());
+
+    gnss_sdr::Observables obs;
+    ASSERT_TRUE(obs.ParseFromString(selected));
+    ASSERT_EQ(obs.observable_size(), 1);
+    EXPECT_EQ(obs.observable(0).prn(), 7U);
+    EXPECT_EQ(obs.observable(0).channel_id(), 2);
+    EXPECT_DOUBLE_EQ(obs.observable(0).cn0_db_hz(), 45.0);
+    EXPECT_DOUBLE_EQ(obs.observable(0).prompt_i(), 0.0);
+}
@@ -96,3 +96,36 @@ TEST(Protobuf, Works)
     EXPECT_EQ(prn_read, prn_read3);
     EXPECT_EQ(2, obs_size);
 }
+
+
+TEST(Protobuf, ReusedBuffer)
+{
+    Serdes_Gnss_Synchro serdes = Serdes_Gnss_Synchro();
+    std::vector<Gnss_Synchro> vgs(4);
+    for (size_t i = 0; i < vgs.size(); i++)
+        {
+            vgs[i].System = 'E';
+            std::memcpy(static_cast<void*>(vgs[i].Signal), "1B", 3);
+            vgs[i].PRN = static_cast<uint32_t>(i + 1);
+        }
+    const std::string serialized_data = serdes.createProtobuffer(vgs);
+
+    // the same message, serialized again in a buffer that keeps its capacity
+    std::string buffer;
+    for (int n = 0; n < 3; n++)
+        {
+            buffer.clear();
+            serdes.createProtobuffer(vgs, buffer);
+            EXPECT_EQ(serialized_data, buffer);
+        }
+
+    // fewer observables than in the previous call
+    vgs.resize(1);
+    buffer.clear();
+    serdes.createProtobuffer(vgs, buffer);
+    gnss_sdr::Observables obs;
+    obs.ParseFromString(buffer);
+    EXPECT_EQ(1, obs.observable_size());
+    EXPECT_EQ("E", obs.observable(0).system());
+    EXPECT_EQ("1B", obs.observable(0).signal());
+}
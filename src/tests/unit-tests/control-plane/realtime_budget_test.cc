@@ -0,0 +1,51 @@
+/*!
+ * \file realtime_budget_test.cc
+ * \brief Implements Unit Tests for the load shedding levels of the receiver
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "realtime_budget.h"
+#include <gtest/gtest.h>
+#include <string>
+
+
+TEST(RealtimeBudgetTest, ShedsAndRecoversOneLevelAtATime)
+{
+    RealtimeBudget budget(3, 2, 0.9);
+    EXPECT_EQ(budget.update(0, 0.5), 0);
+
+    // samples lost, and then full source buffers
+    EXPECT_EQ(budget.update(100, 0.5), 1);
+    EXPECT_EQ(budget.update(100, 0.95), 2);
+    EXPECT_EQ(budget.update(250, 1.0), 3);
+    EXPECT_EQ(budget.update(300, 1.0), 3);  // maximum level
+
+    // two periods in a row within the budget for each level down
+    EXPECT_EQ(budget.update(300, 0.5), 3);
+    EXPECT_EQ(budget.update(300, 0.5), 2);
+    EXPECT_EQ(budget.update(300, 0.5), 2);
+    EXPECT_EQ(budget.update(400, 0.5), 3);  // the count starts again
+    EXPECT_EQ(budget.update(400, 0.5), 3);
+    EXPECT_EQ(budget.update(400, 0.5), 2);
+    EXPECT_EQ(budget.update(400, 0.5), 2);
+    EXPECT_EQ(budget.update(400, 0.5), 1);
+    EXPECT_EQ(budget.update(400, 0.5), 1);
+    EXPECT_EQ(budget.update(400, 0.5), 0);
+    EXPECT_EQ(budget.level(), 0);
+
+    budget.record_action("test action");
+    const std::string report = budget.report();
+    EXPECT_NE(report.find("gnss_sdr_realtime_budget_level 0\n"), std::string::npos);
+    EXPECT_NE(report.find("gnss_sdr_realtime_budget_lost_samples_total 400\n"), std::string::npos);
+    EXPECT_NE(report.find("gnss_sdr_realtime_budget_overloaded_periods_total 5\n"), std::string::npos);
+    EXPECT_NE(report.find("gnss_sdr_realtime_budget_actions_total 1\n"), std::string::npos);
+}
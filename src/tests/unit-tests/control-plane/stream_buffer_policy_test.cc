@@ -0,0 +1,88 @@
+/*!
+ * \file stream_buffer_policy_test.cc
+ * \brief Implements Unit Tests for the buffer policy of the high-rate
+ * connections of the flowgraph.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "capacity_planner.h"
+#include "in_memory_configuration.h"
+#include "stream_buffer_policy.h"
+#include <gtest/gtest.h>
+#include <memory>
+
+
+TEST(StreamBufferPolicyTest, SizesTheHighRateConnections)
+{
+    auto configuration = std::make_unique<InMemoryConfiguration>();
+    const Stream_Buffer_Policy policy(configuration.get(), 0.004);
+
+    // low-rate connections keep the buffers of GNU Radio
+    const Stream_Buffer low_rate = policy.buffer("SignalConditioner", 4e6, 8);
+    EXPECT_EQ(low_rate.items, 0);
+    EXPECT_EQ(low_rate.alignment, 1);
+    EXPECT_FALSE(low_rate.huge_pages);
+
+    // 20 ms at 25 Msps of gr_complex (4 MB) in whole huge pages, and whole
+    // cache lines per work call
+    const Stream_Buffer high_rate = policy.buffer("SignalConditioner", 25e6, 8);
+    EXPECT_EQ(high_rate.items * 8, 2 * static_cast<int64_t>(Stream_Buffer_Policy::HUGE_PAGE_BYTES));
+    EXPECT_EQ(high_rate.alignment, 8);
+    EXPECT_TRUE(high_rate.huge_pages);
+
+    // twice the longest read of a consumer, if it is longer
+    const Stream_Buffer_Policy long_reads(configuration.get(), 0.1);
+    EXPECT_GE(long_reads.buffer("SignalConditioner", 25e6, 8).items, static_cast<int64_t>(2 * 0.1 * 25e6));
+}
+
+
+TEST(StreamBufferPolicyTest, IsConfiguredPerConnection)
+{
+    auto configuration = std::make_unique<InMemoryConfiguration>();
+    configuration->set_property("SignalSource.output_buffer_ms", "10");
+    configuration->set_property("SignalSource.output_buffer_huge_pages", "false");
+    const Stream_Buffer_Policy policy(configuration.get(), 0.0);
+
+    // the policy applies to a configured connection at any rate, in 4 KB pages
+    const Stream_Buffer source = policy.buffer("SignalSource", 4e6, 4);
+    EXPECT_EQ(source.items, 40960);
+    EXPECT_EQ(source.alignment, 16);
+    EXPECT_FALSE(source.huge_pages);
+
+    configuration->set_property("GNSS-SDR.stream_buffers", "gnuradio");
+    const Stream_Buffer_Policy gnuradio(configuration.get(), 0.0);
+    EXPECT_FALSE(gnuradio.enabled());
+    EXPECT_EQ(gnuradio.buffer("SignalSource", 4e6, 4).items, 0);
+    EXPECT_EQ(gnuradio.buffer("SignalConditioner", 100e6, 8).items, 0);
+}
+
+
+TEST(StreamBufferPolicyTest, IsPlannedByTheCapacityPlanner)
+{
+    auto configuration = std::make_unique<InMemoryConfiguration>();
+    configuration->set_property("GNSS-SDR.internal_fs_sps", "25000000");
+    configuration->set_property("SignalSource.implementation", "File_Signal_Source");
+    configuration->set_property("SignalConditioner.implementation", "Pass_Through");
+    configuration->set_property("Channels_1C.count", "8");
+    configuration->set_property("Acquisition_1C.coherent_integration_time_ms", "4");
+    const Capacity_Planner planner(configuration.get(), nullptr, 4);
+    EXPECT_DOUBLE_EQ(planner.largest_request_s(), 0.004);
+
+    // the output of the conditioner read by the channels
+    for (const auto& stage : planner.stages())
+        {
+            if (stage.name == "SignalConditioner")
+                {
+                    EXPECT_EQ(stage.buffer_bytes, 2U * Stream_Buffer_Policy::HUGE_PAGE_BYTES);
+                }
+        }
+}
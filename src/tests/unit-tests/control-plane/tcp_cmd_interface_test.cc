@@ -0,0 +1,95 @@
+/*!
+ * \file tcp_cmd_interface_test.cc
+ * \brief Tests of the status frames sent by the telecommand interface
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_receiver_snapshot.h"
+#include "tcp_cmd_interface.h"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+
+namespace
+{
+template <typename T>
+T frame_value(const std::string& frame, size_t offset)
+{
+    T value{};
+    std::memcpy(&value, frame.data() + offset, sizeof(T));
+    return value;
+}
+}  // namespace
+
+
+TEST(TcpCmdInterfaceTest, EncodesTheStatusFrame)
+{
+    Gnss_Receiver_Snapshot snapshot;
+    snapshot.time_s = 1.6e9;
+    snapshot.pvt_valid = true;
+    snapshot.latitude_deg = 41.27;
+    snapshot.longitude_deg = 1.98;
+    snapshot.height_m = 50.0;
+    snapshot.pvt_utc_time = 1600000000;
+    snapshot.clock_drift_ppm = 0.5;
+    Gnss_Channel_Snapshot channel;
+    channel.System = "Galileo";
+    channel.Signal = "1B";
+    channel.PRN = 11;
+    channel.Carrier_Doppler_hz = -1250.0;
+    channel.CN0_dB_hz = 45.5;
+    snapshot.channels.push_back(channel);
+    channel.System = "GPS";
+    channel.Signal = "1C";
+    channel.PRN = 3;
+    snapshot.channels.push_back(channel);
+
+    const std::string frame = TcpCmdInterface::encode_status(snapshot);
+    const size_t header_size = 8 + 2 + 2 + 1 + 5 * 8 + 8;
+    const size_t channel_size = 1 + 2 + 4 + 4 + 4;
+    ASSERT_EQ(frame.size(), header_size + 2 * channel_size);
+    EXPECT_EQ(frame.substr(0, 4), "GSTS");
+    EXPECT_EQ(frame_value<uint32_t>(frame, 4), frame.size() - 8);
+    EXPECT_EQ(frame_value<uint16_t>(frame, 8), 1);
+    EXPECT_EQ(frame_value<uint16_t>(frame, 10), 2);
+    EXPECT_EQ(frame_value<uint8_t>(frame, 12), 1);
+    EXPECT_DOUBLE_EQ(frame_value<double>(frame, 13), 1.6e9);
+    EXPECT_DOUBLE_EQ(frame_value<double>(frame, 21), 41.27);
+    EXPECT_DOUBLE_EQ(frame_value<double>(frame, 29), 1.98);
+    EXPECT_DOUBLE_EQ(frame_value<double>(frame, 37), 50.0);
+    EXPECT_EQ(frame_value<int64_t>(frame, 45), 1600000000);
+    EXPECT_DOUBLE_EQ(frame_value<double>(frame, 53), 0.5);
+
+    EXPECT_EQ(frame.substr(header_size, 3), "E1B");
+    EXPECT_EQ(frame_value<uint32_t>(frame, header_size + 3), 11U);
+    EXPECT_FLOAT_EQ(frame_value<float>(frame, header_size + 7), -1250.0F);
+    EXPECT_FLOAT_EQ(frame_value<float>(frame, header_size + 11), 45.5F);
+    EXPECT_EQ(frame.substr(header_size + channel_size, 3), "G1C");
+    EXPECT_EQ(frame_value<uint32_t>(frame, header_size + channel_size + 3), 3U);
+}
+
+
+TEST(TcpCmdInterfaceTest, EncodesASnapshotWithoutChannels)
+{
+    // no client has subscribed, so the control thread does not publish
+    TcpCmdInterface cmd_interface;
+    EXPECT_FALSE(cmd_interface.has_status_subscribers());
+
+    const Gnss_Receiver_Snapshot snapshot;
+    const std::string frame = TcpCmdInterface::encode_status(snapshot);
+    ASSERT_EQ(frame.size(), 8U + 2 + 2 + 1 + 5 * 8 + 8);
+    EXPECT_EQ(frame_value<uint32_t>(frame, 4), frame.size() - 8);
+    EXPECT_EQ(frame_value<uint16_t>(frame, 10), 0);
+    EXPECT_EQ(frame_value<uint8_t>(frame, 12), 0);
+}
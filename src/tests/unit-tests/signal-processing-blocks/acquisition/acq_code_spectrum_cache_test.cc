@@ -0,0 +1,80 @@
+/*!
+ * \file acq_code_spectrum_cache_test.cc
+ * \brief  This file implements unit tests for the Acq_Code_Spectrum_Cache class
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_code_spectrum_cache.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+
+TEST(AcqCodeSpectrumCacheTest, StoreAndFetch)
+{
+    auto& cache = Acq_Code_Spectrum_Cache::get();
+    cache.clear();
+
+    const uint32_t fft_size = 64;
+    const uint32_t folded_fft_size = 16;
+    std::vector<gr_complex> code(fft_size);
+    std::vector<gr_complex> spectrum(fft_size);
+    std::vector<gr_complex> folded_spectrum(folded_fft_size);
+    for (uint32_t i = 0; i < fft_size; i++)
+        {
+            code[i] = gr_complex((i % 3 == 0) ? 1.0 : -1.0, 0.0);
+            spectrum[i] = gr_complex(1.0, static_cast<float>(i));
+        }
+    for (uint32_t i = 0; i < folded_fft_size; i++)
+        {
+            folded_spectrum[i] = gr_complex(static_cast<float>(i), 2.0);
+        }
+
+    std::vector<gr_complex> out(fft_size);
+    std::vector<gr_complex> folded_out(folded_fft_size);
+    EXPECT_FALSE(cache.fetch(code.data(), fft_size, folded_fft_size, out.data(), folded_out.data()));
+    cache.store(code.data(), fft_size, folded_fft_size, spectrum.data(), folded_spectrum.data());
+    EXPECT_EQ(cache.size(), 1U);
+    EXPECT_TRUE(cache.fetch(code.data(), fft_size, folded_fft_size, out.data(), folded_out.data()));
+    EXPECT_EQ(spectrum, out);
+    EXPECT_EQ(folded_spectrum, folded_out);
+
+    // another folding or another code are cache misses
+    EXPECT_FALSE(cache.fetch(code.data(), fft_size, 0, out.data(), nullptr));
+    code[10] = -code[10];
+    EXPECT_FALSE(cache.fetch(code.data(), fft_size, folded_fft_size, out.data(), folded_out.data()));
+    cache.clear();
+}
+
+
+TEST(AcqCodeSpectrumCacheTest, BoundedSize)
+{
+    auto& cache = Acq_Code_Spectrum_Cache::get();
+    cache.clear();
+
+    const uint32_t fft_size = 8;
+    std::vector<gr_complex> code(fft_size);
+    std::vector<gr_complex> spectrum(fft_size);
+    std::vector<gr_complex> out(fft_size);
+    for (size_t n = 0; n < Acq_Code_Spectrum_Cache::MAX_ENTRIES + 10; n++)
+        {
+            code[0] = gr_complex(static_cast<float>(n), 0.0);
+            cache.store(code.data(), fft_size, 0, spectrum.data(), nullptr);
+        }
+    EXPECT_EQ(cache.size(), Acq_Code_Spectrum_Cache::MAX_ENTRIES);
+
+    // the oldest entries are dropped first
+    code[0] = gr_complex(0.0, 0.0);
+    EXPECT_FALSE(cache.fetch(code.data(), fft_size, 0, out.data(), nullptr));
+    code[0] = gr_complex(static_cast<float>(Acq_Code_Spectrum_Cache::MAX_ENTRIES + 9), 0.0);
+    EXPECT_TRUE(cache.fetch(code.data(), fft_size, 0, out.data(), nullptr));
+    cache.clear();
+}
@@ -0,0 +1,75 @@
+/*!
+ * \file acq_grid_recorder_test.cc
+ * \brief  This file implements unit tests for the Acq_Grid_Recorder class
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_grid_recorder.h"
+#include <gtest/gtest.h>
+#include <matio.h>
+#include <cstdio>
+#include <string>
+
+
+TEST(AcqGridRecorderTest, WritesCommittedGrids)
+{
+    const size_t rows = 16;
+    const size_t cols = 3;
+    const std::string filename_base("./acq_grid_recorder_test_");
+    {
+        Acq_Grid_Recorder recorder(2);
+        for (int n = 0; n < 2; n++)
+            {
+                Acq_Grid_Recorder::Record* record = recorder.reserve();
+                ASSERT_NE(record, nullptr);
+                record->filename = filename_base + std::to_string(n) + ".mat";
+                record->grid_rows = rows;
+                record->grid_cols = cols;
+                record->grid.assign(rows * cols, 0.0);
+                for (size_t i = 0; i < rows * cols; i++)
+                    {
+                        record->grid[i] = static_cast<float>(n * 1000 + i);
+                    }
+                record->prn = 10 + n;
+                record->two_steps = false;
+                recorder.commit();
+            }
+        recorder.flush();
+        EXPECT_EQ(recorder.dropped(), 0ULL);
+    }
+
+    for (int n = 0; n < 2; n++)
+        {
+            const std::string filename = filename_base + std::to_string(n) + ".mat";
+            mat_t* matfile = Mat_Open(filename.c_str(), MAT_ACC_RDONLY);
+            ASSERT_NE(matfile, nullptr);
+            matvar_t* var = Mat_VarRead(matfile, "acq_grid");
+            ASSERT_NE(var, nullptr);
+            EXPECT_EQ(var->dims[0], rows);
+            EXPECT_EQ(var->dims[1], cols);
+            const auto* data = static_cast<const float*>(var->data);
+            EXPECT_FLOAT_EQ(data[0], static_cast<float>(n * 1000));
+            EXPECT_FLOAT_EQ(data[rows * cols - 1], static_cast<float>(n * 1000 + rows * cols - 1));
+            Mat_VarFree(var);
+
+            var = Mat_VarRead(matfile, "PRN");
+            ASSERT_NE(var, nullptr);
+            EXPECT_EQ(*static_cast<const uint32_t*>(var->data), static_cast<uint32_t>(10 + n));
+            Mat_VarFree(var);
+
+            // Single-step grids do not have a narrow grid
+            var = Mat_VarRead(matfile, "acq_grid_narrow");
+            EXPECT_EQ(var, nullptr);
+            Mat_Close(matfile);
+            std::remove(filename.c_str());
+        }
+}
@@ -0,0 +1,144 @@
+/*!
+ * \file acq_high_sensitivity_search_test.cc
+ * \brief This file implements unit tests for the high-sensitivity search
+ * with long coherent integration
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "GPS_L1_CA.h"
+#include "acq_high_sensitivity_search.h"
+#include "gps_sdr_signal_replica.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+
+namespace
+{
+const int32_t HS_TEST_FS = 2048000;
+const uint32_t HS_TEST_CODE_LENGTH = 2048;  // 1 ms
+const uint32_t HS_TEST_DELAY = 700;         // code phase of the signal [samples]
+const uint32_t HS_TEST_BIT_PERIODS = 20;    // code periods of a data bit
+
+
+// noise and a GPS L1 C/A signal of cn0_db_hz, whose Doppler starts at
+// doppler_hz and changes at rate_hz_s, with a data bit every
+// HS_TEST_BIT_PERIODS code periods after the code epoch at HS_TEST_DELAY
+std::vector<gr_complex> hs_test_stream(uint32_t code_periods, double cn0_db_hz, double doppler_hz, double rate_hz_s, const std::vector<int8_t>& bits)
+{
+    const size_t nsamples = static_cast<size_t>(code_periods) * HS_TEST_CODE_LENGTH;
+    std::vector<gr_complex> stream(nsamples);
+    std::mt19937 gen(1234);
+    std::normal_distribution<float> noise(0.0, 1.0);
+    for (auto& sample : stream)
+        {
+            sample = gr_complex(noise(gen), noise(gen));
+        }
+    // the noise power is 2, so N0 = 2 / fs
+    const auto amplitude = static_cast<float>(std::sqrt(std::pow(10.0, cn0_db_hz / 10.0) * 2.0 / HS_TEST_FS));
+    std::vector<std::complex<float>> chips(static_cast<size_t>(GPS_L1_CA_CODE_LENGTH_CHIPS));
+    gps_l1_ca_code_gen_complex(chips, 1, 0);
+    for (size_t m = 0; m < nsamples; m++)
+        {
+            const double t_code = (static_cast<double>(m) + 1.0 - HS_TEST_DELAY) / HS_TEST_FS;
+            auto chip = static_cast<int64_t>(std::ceil(t_code * GPS_L1_CA_CODE_RATE_CPS) - 1.0) % static_cast<int64_t>(GPS_L1_CA_CODE_LENGTH_CHIPS);
+            chip += (chip < 0 ? static_cast<int64_t>(GPS_L1_CA_CODE_LENGTH_CHIPS) : 0);
+            const double t = static_cast<double>(m) / HS_TEST_FS;
+            const double phase = 2.0 * M_PI * (doppler_hz * t + 0.5 * rate_hz_s * t * t);
+            float bit = 1.0;
+            if (m >= HS_TEST_DELAY and !bits.empty())
+                {
+                    const size_t index = (m - HS_TEST_DELAY) / (HS_TEST_BIT_PERIODS * HS_TEST_CODE_LENGTH);
+                    bit = static_cast<float>(bits[std::min(index, bits.size() - 1)]);
+                }
+            stream[m] += amplitude * bit * chips[chip] * gr_complex(static_cast<float>(std::cos(phase)), static_cast<float>(std::sin(phase)));
+        }
+    return stream;
+}
+
+
+Acq_High_Sensitivity_Result hs_test_search(const std::vector<gr_complex>& stream, uint32_t code_periods, float rate_max, float rate_step, const Acq_Data_Bit_Aid* bit_aid, uint64_t& num_cells)
+{
+    Acq_High_Sensitivity_Search search(HS_TEST_FS, HS_TEST_CODE_LENGTH, code_periods, 2500, rate_max, rate_step);
+    std::vector<std::complex<float>> code(HS_TEST_CODE_LENGTH);
+    gps_l1_ca_code_gen_complex_sampled(code, 1, HS_TEST_FS, 0);
+    search.set_code(code.data());
+    num_cells = search.num_cells();
+    return search.search(stream.data(), 0, 0.0, bit_aid);
+}
+
+
+// CFAR threshold of the test statistic over num_cells cells
+float hs_test_threshold(uint64_t num_cells, double pfa)
+{
+    return static_cast<float>(-2.0 * std::log(-std::expm1(std::log1p(-pfa) / static_cast<double>(num_cells))));
+}
+}  // namespace
+
+
+TEST(AcqHighSensitivitySearchTest, DetectsAWeakSignalWithLongCoherentIntegration)
+{
+    const std::vector<gr_complex> stream = hs_test_stream(100, 25.0, 1234.0, 0.0, {});
+    uint64_t num_cells = 0;
+    const Acq_High_Sensitivity_Result result = hs_test_search(stream, 100, 0.0, 0.0, nullptr, num_cells);
+    EXPECT_EQ(num_cells, 2048U * 11U * 128U);
+    EXPECT_GT(result.test_statistic, hs_test_threshold(num_cells, 0.01));
+    EXPECT_EQ(result.code_phase_samples, HS_TEST_DELAY);
+    EXPECT_NEAR(result.doppler_hz, 1234.0, 5.0);
+
+    // 4 ms are not enough at 25 dB-Hz
+    const Acq_High_Sensitivity_Result short_result = hs_test_search(stream, 4, 0.0, 0.0, nullptr, num_cells);
+    EXPECT_LT(short_result.test_statistic, hs_test_threshold(num_cells, 0.01));
+}
+
+
+TEST(AcqHighSensitivitySearchTest, CompensatesTheDopplerRate)
+{
+    const std::vector<gr_complex> stream = hs_test_stream(100, 32.0, -1500.0, 400.0, {});
+    uint64_t num_cells = 0;
+    const Acq_High_Sensitivity_Result result = hs_test_search(stream, 100, 400.0, 200.0, nullptr, num_cells);
+    EXPECT_EQ(num_cells, 2048U * 11U * 128U * 5U);
+    EXPECT_EQ(result.code_phase_samples, HS_TEST_DELAY);
+    EXPECT_FLOAT_EQ(result.doppler_rate_hz_s, 400.0);
+    EXPECT_NEAR(result.doppler_hz, -1500.0 + 400.0 * 0.1, 5.0);  // at the end of the block
+
+    const Acq_High_Sensitivity_Result uncompensated = hs_test_search(stream, 100, 0.0, 0.0, nullptr, num_cells);
+    EXPECT_GT(result.peak, 1.5F * uncompensated.peak);
+
+    // by default, a quarter of a cycle apart at the ends of the block
+    const Acq_High_Sensitivity_Search search(HS_TEST_FS, HS_TEST_CODE_LENGTH, 100, 2500, 100.0, 0.0);
+    EXPECT_EQ(search.num_doppler_rates(), 3U);
+}
+
+
+TEST(AcqHighSensitivitySearchTest, WipesOffTheAssistedDataBits)
+{
+    const std::vector<int8_t> bits = {1, -1, 1, -1, 1};
+    const std::vector<gr_complex> stream = hs_test_stream(100, 30.0, 500.0, 0.0, bits);
+    Acq_Data_Bit_Aid bit_aid;
+    bit_aid.bits = bits;
+    bit_aid.first_bit_sample = HS_TEST_DELAY;
+    bit_aid.bit_period_samples = HS_TEST_BIT_PERIODS * HS_TEST_CODE_LENGTH;
+    uint64_t num_cells = 0;
+    const Acq_High_Sensitivity_Result result = hs_test_search(stream, 100, 0.0, 0.0, &bit_aid, num_cells);
+    EXPECT_GT(result.test_statistic, hs_test_threshold(num_cells, 0.01));
+    EXPECT_EQ(result.code_phase_samples, HS_TEST_DELAY);
+    EXPECT_NEAR(result.doppler_hz, 500.0, 5.0);
+
+    // the bit transitions spread the power of the signal without the aid
+    const Acq_High_Sensitivity_Result unaided = hs_test_search(stream, 100, 0.0, 0.0, nullptr, num_cells);
+    EXPECT_GT(result.peak, 2.0F * unaided.peak);
+}
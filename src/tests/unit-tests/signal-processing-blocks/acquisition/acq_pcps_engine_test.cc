@@ -0,0 +1,131 @@
+/*!
+ * \file acq_pcps_engine_test.cc
+ * \brief Tests of the Doppler grid search shared by the PCPS acquisition
+ * blocks
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_pcps_engine.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+
+namespace
+{
+const int64_t ENGINE_TEST_FS = 256000;
+const uint32_t ENGINE_TEST_FFT_SIZE = 256;
+
+
+std::vector<gr_complex> engine_test_code()
+{
+    // a maximal length sequence, so that the correlation has a single peak
+    std::vector<gr_complex> code(ENGINE_TEST_FFT_SIZE);
+    uint32_t lfsr = 0x5AU;
+    for (auto& chip : code)
+        {
+            const uint32_t bit = ((lfsr >> 7) ^ (lfsr >> 5) ^ (lfsr >> 4) ^ (lfsr >> 3)) & 1U;
+            lfsr = ((lfsr << 1) | bit) & 0xFFU;
+            chip = gr_complex(bit ? 1.0F : -1.0F, 0.0F);
+        }
+    return code;
+}
+
+
+// the code delayed by delay samples, with a carrier of doppler_hz
+std::vector<gr_complex> engine_test_signal(const std::vector<gr_complex>& code, uint32_t delay, double doppler_hz)
+{
+    std::vector<gr_complex> signal(ENGINE_TEST_FFT_SIZE);
+    for (uint32_t n = 0; n < ENGINE_TEST_FFT_SIZE; n++)
+        {
+            const double phase = 2.0 * M_PI * doppler_hz * static_cast<double>(n) / static_cast<double>(ENGINE_TEST_FS);
+            signal[n] = code[(n + ENGINE_TEST_FFT_SIZE - delay) % ENGINE_TEST_FFT_SIZE] * gr_complex(static_cast<float>(std::cos(phase)), static_cast<float>(std::sin(phase)));
+        }
+    return signal;
+}
+
+
+void engine_test_search(Acq_Pcps_Engine& engine, const std::vector<gr_complex>& signal, const std::vector<gr_complex>& fft_code, uint64_t sample_stamp, uint32_t& best_bin, uint32_t& best_delay)
+{
+    float best = -1.0;
+    for (uint32_t doppler_index = 0; doppler_index < engine.num_doppler_bins(); doppler_index++)
+        {
+            engine.input_spectrum(signal.data(), sample_stamp, doppler_index);
+            const gr_complex* correlation = engine.correlate(fft_code.data());
+            for (uint32_t n = 0; n < ENGINE_TEST_FFT_SIZE; n++)
+                {
+                    if (std::norm(correlation[n]) > best)
+                        {
+                            best = std::norm(correlation[n]);
+                            best_bin = doppler_index;
+                            best_delay = n;
+                        }
+                }
+        }
+}
+}  // namespace
+
+
+TEST(AcqPcpsEngineTest, FindsTheCodePhaseAndTheDoppler)
+{
+    Acq_Pcps_Engine engine(ENGINE_TEST_FS, ENGINE_TEST_FFT_SIZE);
+    engine.set_doppler_grid("XX", 2000, 500);
+    ASSERT_EQ(engine.num_doppler_bins(), 9U);
+
+    const std::vector<gr_complex> code = engine_test_code();
+    std::vector<gr_complex> fft_code(ENGINE_TEST_FFT_SIZE);
+    engine.code_spectrum(code.data(), fft_code.data());
+
+    const std::vector<gr_complex> signal = engine_test_signal(code, 37, 1000.0);
+    uint32_t best_bin = 0;
+    uint32_t best_delay = 0;
+    engine_test_search(engine, signal, fft_code, 1000, best_bin, best_delay);
+    EXPECT_EQ(best_bin, 6U);  // -2000 + 6 * 500 Hz
+    EXPECT_EQ(best_delay, 37U);
+}
+
+
+TEST(AcqPcpsEngineTest, ChannelsShareTheInputSpectra)
+{
+    Acq_Pcps_Engine engine_1(ENGINE_TEST_FS, ENGINE_TEST_FFT_SIZE);
+    Acq_Pcps_Engine engine_2(ENGINE_TEST_FS, ENGINE_TEST_FFT_SIZE);
+    engine_1.set_doppler_grid("YY", 1000, 500);
+    engine_2.set_doppler_grid("YY", 1000, 500);
+
+    const std::vector<gr_complex> code = engine_test_code();
+    std::vector<gr_complex> fft_code_1(ENGINE_TEST_FFT_SIZE);
+    std::vector<gr_complex> fft_code_2(ENGINE_TEST_FFT_SIZE);
+    engine_1.code_spectrum(code.data(), fft_code_1.data());
+    engine_2.code_spectrum(code.data(), fft_code_2.data());
+    EXPECT_EQ(fft_code_1, fft_code_2);
+
+    // the second channel gets the spectra of the first one, and the same result
+    const std::vector<gr_complex> signal = engine_test_signal(code, 12, -500.0);
+    uint32_t best_bin_1 = 0;
+    uint32_t best_delay_1 = 0;
+    uint32_t best_bin_2 = 0;
+    uint32_t best_delay_2 = 0;
+    engine_test_search(engine_1, signal, fft_code_1, 5000, best_bin_1, best_delay_1);
+    engine_test_search(engine_2, signal, fft_code_2, 5000, best_bin_2, best_delay_2);
+    EXPECT_EQ(best_bin_1, 1U);
+    EXPECT_EQ(best_delay_1, 12U);
+    EXPECT_EQ(best_bin_2, best_bin_1);
+    EXPECT_EQ(best_delay_2, best_delay_1);
+
+    // a different input block is transformed again
+    const std::vector<gr_complex> other_signal = engine_test_signal(code, 200, 500.0);
+    engine_test_search(engine_2, other_signal, fft_code_2, 6000, best_bin_2, best_delay_2);
+    EXPECT_EQ(best_bin_2, 3U);
+    EXPECT_EQ(best_delay_2, 200U);
+}
@@ -0,0 +1,63 @@
+/*!
+ * \file acq_shared_front_end_test.cc
+ * \brief  This file implements unit tests for the Acq_Shared_Front_End class
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_shared_front_end.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+
+TEST(AcqSharedFrontEndTest, SameGridSharesInstance)
+{
+    const std::vector<double> freqs = {-1000.0, -500.0, 0.0, 500.0, 1000.0};
+    auto front_end_1 = Acq_Shared_Front_End::get("1C", 4000000, 4000, freqs, 5);
+    auto front_end_2 = Acq_Shared_Front_End::get("1C", 4000000, 4000, freqs, 5);
+    auto front_end_3 = Acq_Shared_Front_End::get("1C", 4000000, 4000, std::vector<double>{-750.0, 0.0, 750.0}, 3);
+    auto front_end_4 = Acq_Shared_Front_End::get("5X", 4000000, 4000, freqs, 5);
+
+    EXPECT_EQ(front_end_1.get(), front_end_2.get());
+    EXPECT_NE(front_end_1.get(), front_end_3.get());
+    EXPECT_NE(front_end_1.get(), front_end_4.get());
+
+    // the central bin has no Doppler to wipe off
+    EXPECT_NEAR(front_end_1->wipeoff(2)[100].real(), 1.0, 1e-5);
+    EXPECT_NEAR(front_end_1->wipeoff(2)[100].imag(), 0.0, 1e-5);
+}
+
+
+TEST(AcqSharedFrontEndTest, SpectrumCache)
+{
+    const uint32_t fft_size = 64;
+    Acq_Shared_Front_End front_end(64000, fft_size, std::vector<double>{0.0, 1000.0}, 2);
+
+    std::vector<gr_complex> in(fft_size);
+    std::vector<gr_complex> spectrum(fft_size);
+    std::vector<gr_complex> out(fft_size);
+    for (uint32_t i = 0; i < fft_size; i++)
+        {
+            in[i] = gr_complex(static_cast<float>(i), -static_cast<float>(i));
+            spectrum[i] = gr_complex(1.0, static_cast<float>(i));
+        }
+
+    EXPECT_FALSE(front_end.fetch_spectrum(1000, 0, in.data(), out.data()));
+    front_end.store_spectrum(1000, 0, in.data(), spectrum.data());
+    EXPECT_TRUE(front_end.fetch_spectrum(1000, 0, in.data(), out.data()));
+    EXPECT_EQ(spectrum, out);
+
+    // different bin, stamp or input samples are cache misses
+    EXPECT_FALSE(front_end.fetch_spectrum(1000, 1, in.data(), out.data()));
+    EXPECT_FALSE(front_end.fetch_spectrum(2000, 0, in.data(), out.data()));
+    in[0] = gr_complex(5.0, 5.0);
+    EXPECT_FALSE(front_end.fetch_spectrum(1000, 0, in.data(), out.data()));
+}
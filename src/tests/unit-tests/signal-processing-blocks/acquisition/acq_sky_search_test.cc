@@ -0,0 +1,146 @@
+/*!
+ * \file acq_sky_search_test.cc
+ * \brief This file implements unit tests for the background sky search
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "GPS_L1_CA.h"
+#include "acq_sky_search.h"
+#include "gps_sdr_signal_replica.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+const int32_t SKY_SEARCH_TEST_FS = 2048000;
+const uint32_t SKY_SEARCH_TEST_CODE_LENGTH = 2048;  // 1 ms
+
+
+// noise and GPS L1 C/A signals, the code epochs of prn at delays[i] samples
+// modulo the code period
+std::vector<gr_complex> sky_search_test_stream(size_t nsamples, const std::vector<uint32_t>& prns, const std::vector<double>& delays, const std::vector<double>& dopplers)
+{
+    std::vector<gr_complex> stream(nsamples);
+    std::mt19937 gen(4321);
+    std::normal_distribution<float> noise(0.0, 1.0);
+    for (auto& sample : stream)
+        {
+            sample = gr_complex(noise(gen), noise(gen));
+        }
+    std::vector<std::complex<float>> chips(static_cast<size_t>(GPS_L1_CA_CODE_LENGTH_CHIPS));
+    for (size_t i = 0; i < prns.size(); i++)
+        {
+            gps_l1_ca_code_gen_complex(chips, static_cast<int32_t>(prns[i]), 0);
+            for (size_t m = 0; m < stream.size(); m++)
+                {
+                    const double t = (static_cast<double>(m) + 1.0 - delays[i]) / SKY_SEARCH_TEST_FS;
+                    auto chip = static_cast<int64_t>(std::ceil(t * GPS_L1_CA_CODE_RATE_CPS) - 1.0) % static_cast<int64_t>(GPS_L1_CA_CODE_LENGTH_CHIPS);
+                    chip += (chip < 0 ? static_cast<int64_t>(GPS_L1_CA_CODE_LENGTH_CHIPS) : 0);
+                    const double phase = 2.0 * M_PI * dopplers[i] * static_cast<double>(m) / SKY_SEARCH_TEST_FS;
+                    stream[m] += 0.3F * chips[chip] * gr_complex(static_cast<float>(std::cos(phase)), static_cast<float>(std::sin(phase)));
+                }
+        }
+    return stream;
+}
+
+
+void sky_search_test_push(Acq_Sky_Search& search, const gr_complex* samples, size_t nsamples)
+{
+    for (size_t done = 0; done < nsamples; done += 1000)
+        {
+            search.push(samples + done, static_cast<int32_t>(std::min<size_t>(1000, nsamples - done)));
+        }
+}
+
+
+// distance of a sample counter to the code epochs at delay samples
+double sky_search_test_epoch_error(uint64_t code_epoch_samples, double delay)
+{
+    const double error = std::fmod(static_cast<double>(code_epoch_samples) - delay, SKY_SEARCH_TEST_CODE_LENGTH);
+    return std::min(std::fabs(error), SKY_SEARCH_TEST_CODE_LENGTH - std::fabs(error));
+}
+}  // namespace
+
+
+TEST(AcqSkySearchTest, KeepsTheSatellitesFoundForTheFreeChannels)
+{
+    const std::vector<gr_complex> stream = sky_search_test_stream(30 * SKY_SEARCH_TEST_CODE_LENGTH, {3, 17}, {123.4, 1500.7}, {1000.0, -2250.0});
+    Acq_Sky_Search search("1C", SKY_SEARCH_TEST_FS, {3, 9, 17}, 5000, 250, 10, 4.0F, 0, 1000);
+    search.set_busy(17, true);  // already tracked
+    EXPECT_FALSE(search.process_pending());
+
+    // the first burst starts with the stream
+    sky_search_test_push(search, stream.data(), 15 * SKY_SEARCH_TEST_CODE_LENGTH);
+    ASSERT_TRUE(search.process_pending());
+    EXPECT_EQ(search.searches(), 1U);
+    EXPECT_EQ(search.candidates(), 1U);
+
+    Acq_Sky_Candidate candidate;
+    EXPECT_FALSE(search.take_candidate(9, candidate));
+    EXPECT_FALSE(search.take_candidate(17, candidate));
+    ASSERT_TRUE(search.take_candidate(3, candidate));
+    EXPECT_EQ(candidate.burst_samples, 0U);
+    EXPECT_LT(sky_search_test_epoch_error(candidate.code_epoch_samples, 123.4), 1.0);
+    EXPECT_NEAR(candidate.doppler_hz, 1000.0, 125.0);
+    EXPECT_FALSE(search.take_candidate(3, candidate));  // taken
+
+    // the next burst starts at the samples pushed after the request
+    search.set_busy(17, false);
+    sky_search_test_push(search, stream.data() + 15 * SKY_SEARCH_TEST_CODE_LENGTH, 15 * SKY_SEARCH_TEST_CODE_LENGTH);
+    ASSERT_TRUE(search.process_pending());
+    EXPECT_EQ(search.candidates(), 2U);
+    ASSERT_TRUE(search.take_candidate(17, candidate));
+    EXPECT_EQ(candidate.burst_samples, 15U * SKY_SEARCH_TEST_CODE_LENGTH);
+    EXPECT_LT(sky_search_test_epoch_error(candidate.code_epoch_samples, 1500.7), 1.0);
+    EXPECT_NEAR(candidate.doppler_hz, -2250.0, 125.0);
+
+    // and its candidates are too old after max_age_ms
+    const std::vector<gr_complex> zeros(SKY_SEARCH_TEST_FS, gr_complex(0.0, 0.0));
+    sky_search_test_push(search, zeros.data(), zeros.size());
+    EXPECT_FALSE(search.take_candidate(3, candidate));
+}
+
+
+TEST(AcqSkySearchTest, SearchesOnItsThread)
+{
+    const std::vector<gr_complex> stream = sky_search_test_stream(10 * SKY_SEARCH_TEST_CODE_LENGTH, {28}, {2047.5}, {3100.0});
+    Acq_Sky_Search search("1C", SKY_SEARCH_TEST_FS, {28}, 5000, 250, 10, 4.0F, 10, 1000);
+    search.start();
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(20);
+    while (search.searches() == 0 and std::chrono::steady_clock::now() < deadline)
+        {
+            sky_search_test_push(search, stream.data(), stream.size());
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    search.stop();
+    ASSERT_GT(search.searches(), 0U);
+    Acq_Sky_Candidate candidate;
+    ASSERT_TRUE(search.take_candidate(28, candidate));
+    EXPECT_NEAR(candidate.doppler_hz, 3100.0, 125.0);
+}
+
+
+TEST(AcqSkySearchTest, RejectsUnsupportedSignals)
+{
+    EXPECT_THROW(Acq_Sky_Search("5X", SKY_SEARCH_TEST_FS, {1}, 5000, 250, 10, 4.0F, 0, 1000), std::invalid_argument);
+    // 1 ms is not a whole number of samples
+    EXPECT_THROW(Acq_Sky_Search("1C", 2048500, {1}, 5000, 250, 10, 4.0F, 0, 1000), std::invalid_argument);
+}
@@ -0,0 +1,98 @@
+/*!
+ * \file acq_snapshot_search_test.cc
+ * \brief Tests of the batched acquisition of a burst for snapshot
+ * positioning
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "GPS_L1_CA.h"
+#include "acq_snapshot_search.h"
+#include "gps_sdr_signal_replica.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+
+namespace
+{
+const int32_t SNAPSHOT_TEST_FS = 2048000;
+const uint32_t SNAPSHOT_TEST_CODE_LENGTH = 2048;  // 1 ms
+
+
+// adds the GPS L1 C/A signal of prn, whose code epochs start delay samples after the first one
+void snapshot_test_add_signal(std::vector<gr_complex>& burst, uint32_t prn, double delay, double doppler_hz, float amplitude)
+{
+    std::vector<std::complex<float>> chips(static_cast<size_t>(GPS_L1_CA_CODE_LENGTH_CHIPS));
+    gps_l1_ca_code_gen_complex(chips, static_cast<int32_t>(prn), 0);
+    for (size_t m = 0; m < burst.size(); m++)
+        {
+            // the chip at the end of the sample, as gps_l1_ca_code_gen_complex_sampled does
+            const double t = (static_cast<double>(m) + 1.0 - delay) / SNAPSHOT_TEST_FS;
+            auto chip = static_cast<int64_t>(std::ceil(t * GPS_L1_CA_CODE_RATE_CPS) - 1.0) % static_cast<int64_t>(GPS_L1_CA_CODE_LENGTH_CHIPS);
+            chip += (chip < 0 ? static_cast<int64_t>(GPS_L1_CA_CODE_LENGTH_CHIPS) : 0);
+            const double phase = 2.0 * M_PI * doppler_hz * static_cast<double>(m) / SNAPSHOT_TEST_FS;
+            burst[m] += amplitude * chips[chip] * gr_complex(static_cast<float>(std::cos(phase)), static_cast<float>(std::sin(phase)));
+        }
+}
+}  // namespace
+
+
+TEST(AcqSnapshotSearchTest, FindsAllTheSatellitesOfTheBurst)
+{
+    std::vector<gr_complex> burst(10 * SNAPSHOT_TEST_CODE_LENGTH);
+    std::mt19937 gen(1234);
+    std::normal_distribution<float> noise(0.0, 1.0);
+    for (auto& sample : burst)
+        {
+            sample = gr_complex(noise(gen), noise(gen));
+        }
+    snapshot_test_add_signal(burst, 3, 123.4, 1000.0, 0.3F);
+    snapshot_test_add_signal(burst, 17, 1500.7, -2250.0, 0.3F);
+    snapshot_test_add_signal(burst, 28, 2047.5, 3100.0, 0.3F);
+
+    Acq_Snapshot_Search search("1C", SNAPSHOT_TEST_FS, SNAPSHOT_TEST_CODE_LENGTH, 5000, 250);
+    for (uint32_t prn : {3U, 17U, 28U, 9U})
+        {
+            std::vector<std::complex<float>> code(SNAPSHOT_TEST_CODE_LENGTH);
+            gps_l1_ca_code_gen_complex_sampled(code, prn, SNAPSHOT_TEST_FS, 0);
+            search.add_satellite('G', prn, code.data());
+        }
+    const std::vector<Acq_Snapshot_Result> results = search.search(burst.data(), burst.size(), 4.0F);
+    ASSERT_EQ(results.size(), 4U);
+
+    const std::vector<double> delays = {123.4, 1500.7, 2047.5};
+    const std::vector<double> dopplers = {1000.0, -2250.0, 3100.0};
+    for (size_t i = 0; i < 3; i++)
+        {
+            EXPECT_EQ(results[i].system, 'G');
+            EXPECT_TRUE(results[i].detected) << "PRN " << results[i].prn;
+            // interpolated between the samples, and circular
+            const double delay = results[i].code_phase_s * SNAPSHOT_TEST_FS;
+            const double error = std::remainder(delay - delays[i], SNAPSHOT_TEST_CODE_LENGTH);
+            EXPECT_LT(std::fabs(error), 0.35) << "PRN " << results[i].prn;
+            EXPECT_LT(std::fabs(results[i].doppler_hz - dopplers[i]), 125.0) << "PRN " << results[i].prn;
+        }
+    EXPECT_EQ(results[3].prn, 9U);
+    EXPECT_FALSE(results[3].detected);
+
+    // the same burst searched again gives the same results
+    const std::vector<Acq_Snapshot_Result> again = search.search(burst.data(), burst.size(), 4.0F);
+    ASSERT_EQ(again.size(), results.size());
+    for (size_t i = 0; i < results.size(); i++)
+        {
+            EXPECT_DOUBLE_EQ(again[i].code_phase_s, results[i].code_phase_s);
+            EXPECT_EQ(again[i].detected, results[i].detected);
+        }
+}
@@ -0,0 +1,52 @@
+/*!
+ * \file acq_workspace_pool_test.cc
+ * \brief Tests of the pool of acquisition workspaces
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_workspace_pool.h"
+#include <gtest/gtest.h>
+#include <utility>
+
+
+TEST(AcqWorkspacePoolTest, ReusesTheWorkspacesBySize)
+{
+    auto& pool = Acq_Workspace_Pool::get();
+    pool.clear();
+
+    Acq_Workspace first = pool.borrow(128);
+    Acq_Workspace second = pool.borrow(128);
+    ASSERT_NE(first.fft_if, nullptr);
+    ASSERT_NE(first.ifft, nullptr);
+    EXPECT_EQ(first.tmp_buffer.size(), 128U);
+    EXPECT_NE(first.fft_if.get(), second.fft_if.get());
+    EXPECT_EQ(pool.idle(), 0U);
+
+    const auto* fft_plan = first.fft_if.get();
+    first.magnitude_grid = volk_gnsssdr::vector<volk_gnsssdr::vector<float>>(3, volk_gnsssdr::vector<float>(128));
+    pool.give_back(128, std::move(first));
+    pool.give_back(128, std::move(second));
+    EXPECT_EQ(pool.idle(), 2U);
+
+    // a workspace of another size is created
+    Acq_Workspace other = pool.borrow(256);
+    EXPECT_EQ(other.tmp_buffer.size(), 256U);
+    EXPECT_EQ(pool.idle(), 2U);
+
+    // the idle ones are taken first, with their grid
+    Acq_Workspace reused = pool.borrow(128);
+    Acq_Workspace reused_2 = pool.borrow(128);
+    EXPECT_EQ(pool.idle(), 0U);
+    EXPECT_TRUE(reused.fft_if.get() == fft_plan or reused_2.fft_if.get() == fft_plan);
+    EXPECT_EQ(reused.magnitude_grid.size() + reused_2.magnitude_grid.size(), 3U);
+    pool.clear();
+}
@@ -0,0 +1,114 @@
+/*!
+ * \file acquisition_thread_pool_test.cc
+ * \brief  This file implements unit tests for the Acquisition_Thread_Pool class
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acquisition_thread_pool.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+TEST(AcquisitionThreadPoolTest, RunsAllJobs)
+{
+    std::atomic<int> done{0};
+    {
+        Acquisition_Thread_Pool pool(3);
+        EXPECT_EQ(pool.size(), 3U);
+        int owner = 0;
+        for (int i = 0; i < 50; i++)
+            {
+                pool.submit(&owner, 'G', 1, [&done]() { done++; });
+            }
+        while (pool.pending() > 0)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        pool.cancel(&owner);  // waits for the running jobs
+    }
+    EXPECT_EQ(done.load(), 50);
+}
+
+
+TEST(AcquisitionThreadPoolTest, PriorityOrder)
+{
+    Acquisition_Thread_Pool pool(1);
+    std::mutex mtx;
+    std::condition_variable cv;
+    bool release = false;
+    std::vector<uint32_t> order;
+    int owner = 0;
+
+    // Keep the only worker busy while queueing the jobs
+    pool.submit(&owner, 'G', 0, [&]() {
+        std::unique_lock<std::mutex> lock(mtx);
+        cv.wait(lock, [&] { return release; });
+    });
+    while (pool.pending() > 0)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+    pool.set_priority('G', 7, 10);
+    pool.set_priority('E', 3, 5);
+    for (uint32_t prn : {1U, 3U, 7U, 2U})
+        {
+            const char system = (prn == 3U ? 'E' : 'G');
+            pool.submit(&owner, system, prn, [&order, &mtx, prn]() {
+                std::lock_guard<std::mutex> lock(mtx);
+                order.push_back(prn);
+            });
+        }
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        release = true;
+    }
+    cv.notify_all();
+    while (pool.pending() > 0)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    pool.cancel(&owner);
+
+    const std::vector<uint32_t> expected = {7U, 3U, 1U, 2U};
+    EXPECT_EQ(order, expected);
+}
+
+
+TEST(AcquisitionThreadPoolTest, CancelPendingJobs)
+{
+    Acquisition_Thread_Pool pool(1);
+    std::atomic<int> done{0};
+    std::atomic<bool> release{false};
+    int busy_owner = 0;
+    int owner = 0;
+    pool.submit(&busy_owner, 'G', 1, [&release]() {
+        while (!release)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+    });
+    for (int i = 0; i < 10; i++)
+        {
+            pool.submit(&owner, 'G', 1, [&done]() { done++; });
+        }
+    pool.cancel(&owner);
+    release = true;
+    pool.cancel(&busy_owner);
+    EXPECT_EQ(done.load(), 0);
+    EXPECT_EQ(pool.pending(), 0U);
+}
@@ -18,6 +18,7 @@
 
 
 #include "GPS_L1_CA.h"
+#include "acq_workspace_pool.h"
 #include "acquisition_dump_reader.h"
 #include "concurrent_queue.h"
 #include "gnss_block_interface.h"
@@ -27,6 +28,7 @@
 #include "gnuplot_i.h"
 #include "gps_l1_ca_pcps_acquisition.h"
 #include "in_memory_configuration.h"
+#include "pcps_acquisition.h"
 #include "test_flags.h"
 #include <glog/logging.h>
 #include <gnuradio/analog/sig_source_waveform.h>
@@ -135,13 +137,21 @@ protected:
 
     void init();
     void plot_grid() const;
+    void connect_acquisition();
+    void run_acquisition();
+    void check_acquisition_results() const;
+    pcps_acquisition* search_block() const;
 
     gr::top_block_sptr top_block;
+    gnss_shared_ptr<GpsL1CaPcpsAcquisition> acq_adapter;  // set by connect_acquisition()
+    GpsL1CaPcpsAcquisitionTest_msg_rx_sptr acq_msg_rx;
     std::shared_ptr<InMemoryConfiguration> config;
     Gnss_Synchro gnss_synchro{};
     size_t item_size;
     unsigned int doppler_max{5000};
     unsigned int doppler_step{100};
+    double expected_delay_samples{524};
+    double expected_doppler_hz{1680};
 };
 
 
@@ -240,6 +250,65 @@ void GpsL1CaPcpsAcquisitionTest::plot_grid() const
 }
 
 
+// Connects the acquisition of the configuration to the file of samples of PRN 1
+void GpsL1CaPcpsAcquisitionTest::connect_acquisition()
+{
+    top_block = gr::make_top_block("Acquisition test");
+    acq_adapter = gnss_make_shared<GpsL1CaPcpsAcquisition>(config.get(), "Acquisition_1C", 1, 0);
+    acq_msg_rx = GpsL1CaPcpsAcquisitionTest_msg_rx_make();
+
+    ASSERT_NO_THROW({
+        acq_adapter->set_channel(1);
+        acq_adapter->set_gnss_synchro(&gnss_synchro);
+        acq_adapter->set_threshold(0.001);
+        acq_adapter->set_doppler_max(doppler_max);
+        acq_adapter->set_doppler_step(doppler_step);
+        acq_adapter->connect(top_block);
+    }) << "Failure setting up the acquisition block.";
+
+    ASSERT_NO_THROW({
+        std::string path = std::string(TEST_PATH);
+        std::string file = path + "signal_samples/GPS_L1_CA_ID_1_Fs_4Msps_2ms.dat";
+        const char *file_name = file.c_str();
+        gr::blocks::file_source::sptr file_source = gr::blocks::file_source::make(sizeof(gr_complex), file_name, false);
+        top_block->connect(file_source, 0, acq_adapter->get_left_block(), 0);
+        top_block->msg_connect(acq_adapter->get_right_block(), pmt::mp("events"), acq_msg_rx, pmt::mp("events"));
+    }) << "Failure connecting the blocks of acquisition test.";
+
+    acq_adapter->set_local_code();
+    acq_adapter->set_state(1);  // Ensure that acquisition starts at the first sample
+    acq_adapter->init();
+}
+
+
+void GpsL1CaPcpsAcquisitionTest::run_acquisition()
+{
+    EXPECT_NO_THROW({
+        top_block->run();  // Start threads and wait
+    }) << "Failure running the top_block.";
+}
+
+
+void GpsL1CaPcpsAcquisitionTest::check_acquisition_results() const
+{
+    ASSERT_EQ(1, acq_msg_rx->rx_message) << "Acquisition failure. Expected message: 1=ACQ SUCCESS.";
+
+    double delay_error_samples = std::abs(expected_delay_samples - gnss_synchro.Acq_delay_samples);
+    auto delay_error_chips = static_cast<float>(delay_error_samples * 1023 / 4000);
+    double doppler_error_hz = std::abs(expected_doppler_hz - gnss_synchro.Acq_doppler_hz);
+
+    EXPECT_LE(doppler_error_hz, 666) << "Doppler error exceeds the expected value: 666 Hz = 2/(3*integration period)";
+    EXPECT_LT(delay_error_chips, 0.5) << "Delay error exceeds the expected value: 0.5 chips";
+}
+
+
+// The GNU Radio block of the acquisition, which counts the dwells of each search path
+pcps_acquisition* GpsL1CaPcpsAcquisitionTest::search_block() const
+{
+    return dynamic_cast<pcps_acquisition*>(acq_adapter->get_right_block().get());
+}
+
+
 TEST_F(GpsL1CaPcpsAcquisitionTest /*unused*/, Instantiate /*unused*/)
 {
     std::shared_ptr<GpsL1CaPcpsAcquisition> acquisition = std::make_shared<GpsL1CaPcpsAcquisition>(config.get(), "Acquisition_1C", 1, 0);
@@ -287,9 +356,6 @@ TEST_F(GpsL1CaPcpsAcquisitionTest /*unused*/, ValidationOfResults /*unused*/)
     std::chrono::duration<double> elapsed_seconds(0.0);
     top_block = gr::make_top_block("Acquisition test");
 
-    double expected_delay_samples = 524;
-    double expected_doppler_hz = 1680;
-
     init();
 
     if (FLAGS_plot_acq_grid == true)
@@ -365,3 +431,117 @@ TEST_F(GpsL1CaPcpsAcquisitionTest /*unused*/, ValidationOfResults /*unused*/)
             plot_grid();
         }
 }
+
+
+TEST_F(GpsL1CaPcpsAcquisitionTest /*unused*/, ValidationOfResultsBatchedDopplerFFT /*unused*/)
+{
+    init();
+    config->set_property("Acquisition_1C.batch_doppler_fft", "true");
+    ASSERT_NO_FATAL_FAILURE(connect_acquisition());
+    run_acquisition();
+    ASSERT_NO_FATAL_FAILURE(check_acquisition_results());
+    EXPECT_GT(search_block()->search_counts().doppler_batched, 0U) << "The Doppler bins did not share forward FFTs.";
+}
+
+
+TEST_F(GpsL1CaPcpsAcquisitionTest /*unused*/, ValidationOfResultsLowMemory /*unused*/)
+{
+    init();
+    config->set_property("GNSS-SDR.low_memory", "true");  // magnitude grid allocated only while searching
+    ASSERT_NO_FATAL_FAILURE(connect_acquisition());
+    EXPECT_FALSE(search_block()->holds_magnitude_grid()) << "The magnitude grid was allocated before searching.";
+    run_acquisition();
+    ASSERT_NO_FATAL_FAILURE(check_acquisition_results());
+    EXPECT_FALSE(search_block()->holds_magnitude_grid()) << "The magnitude grid was kept after the acquisition.";
+}
+
+
+TEST_F(GpsL1CaPcpsAcquisitionTest /*unused*/, ValidationOfResultsPooledWorkspace /*unused*/)
+{
+    init();
+    config->set_property("Acquisition_1C.pooled_workspace", "true");
+    ASSERT_NO_FATAL_FAILURE(connect_acquisition());
+    run_acquisition();
+    ASSERT_NO_FATAL_FAILURE(check_acquisition_results());
+    // the workspace is back in the pool
+    EXPECT_GE(Acq_Workspace_Pool::get().idle(), 1U);
+    EXPECT_FALSE(search_block()->holds_magnitude_grid());
+}
+
+
+TEST_F(GpsL1CaPcpsAcquisitionTest /*unused*/, ValidationOfResultsFoldedSearch /*unused*/)
+{
+    init();
+    config->set_property("Acquisition_1C.folding_factor", "2");
+    config->set_property("Acquisition_1C.pfa", "0.01");  // the folded search requires the CFAR test statistic
+    ASSERT_NO_FATAL_FAILURE(connect_acquisition());
+    run_acquisition();
+    ASSERT_NO_FATAL_FAILURE(check_acquisition_results());
+    EXPECT_GT(search_block()->search_counts().folded, 0U) << "The code was not folded.";
+}
+
+
+TEST_F(GpsL1CaPcpsAcquisitionTest /*unused*/, ValidationOfResultsCoarseDetection /*unused*/)
+{
+    init();
+    config->set_property("Acquisition_1C.coarse_decimation", "2");  // detection at 2 Msps before the full search
+    config->set_property("Acquisition_1C.pfa_coarse", "0.1");
+    config->set_property("Acquisition_1C.pfa", "0.01");  // the coarse detection requires the CFAR test statistic
+    ASSERT_NO_FATAL_FAILURE(connect_acquisition());
+    run_acquisition();
+    ASSERT_NO_FATAL_FAILURE(check_acquisition_results());
+    EXPECT_GT(search_block()->search_counts().coarse, 0U) << "There was no coarse detection.";
+}
+
+
+#if OPENCL_BLOCKS_TEST
+TEST_F(GpsL1CaPcpsAcquisitionTest /*unused*/, ValidationOfResultsOpenCL /*unused*/)
+{
+    init();
+    config->set_property("Acquisition_1C.use_opencl", "true");
+    config->set_property("Acquisition_1C.opencl_batch_bins", "4");  // several batches per search
+    ASSERT_NO_FATAL_FAILURE(connect_acquisition());
+    if (!search_block()->opencl_ready())
+        {
+            // the search would run on the CPU
+#ifdef GTEST_SKIP
+            GTEST_SKIP() << "OpenCL device is not available.";
+#else
+            std::cout << "OpenCL device is not available.\n";
+            return;
+#endif
+        }
+    run_acquisition();
+    ASSERT_NO_FATAL_FAILURE(check_acquisition_results());
+    const auto counts = search_block()->search_counts();
+    EXPECT_EQ(counts.opencl, counts.dwells) << "Some dwells were searched on the CPU.";
+}
+#endif
+
+
+TEST_F(GpsL1CaPcpsAcquisitionTest /*unused*/, ValidationOfResultsCodePhaseAssisted /*unused*/)
+{
+    init();
+    config->set_property("Acquisition_1C.pfa", "0.01");
+    ASSERT_NO_FATAL_FAILURE(connect_acquisition());
+    // Code epoch predicted three code periods later, as if propagated from a previous fix
+    acq_adapter->set_doppler_center(1700);
+    acq_adapter->set_code_phase_assistance((expected_delay_samples + 3 * 4000) / 4e6, 1e-3);
+    run_acquisition();
+    ASSERT_NO_FATAL_FAILURE(check_acquisition_results());
+    EXPECT_GT(search_block()->search_counts().code_window, 0U) << "The search was not restricted to the code phase window.";
+}
+
+
+TEST_F(GpsL1CaPcpsAcquisitionTest /*unused*/, CodePhaseAssistedWrongWindow /*unused*/)
+{
+    init();
+    config->set_property("Acquisition_1C.pfa", "0.01");
+    ASSERT_NO_FATAL_FAILURE(connect_acquisition());
+    // The window does not contain the true code phase
+    acq_adapter->set_doppler_center(1700);
+    acq_adapter->set_code_phase_assistance((expected_delay_samples + 2000) / 4e6, 1e-3);
+    run_acquisition();
+    EXPECT_EQ(2, acq_msg_rx->rx_message) << "Acquisition failure. Expected message: 2=ACQ FAIL.";
+    EXPECT_GT(search_block()->search_counts().code_window, 0U) << "The search was not restricted to the code phase window.";
+}
@@ -0,0 +1,128 @@
+/*!
+ * \file bit_selector_test.cc
+ * \brief Checks the levels, the gain and the quantization loss of the
+ * software dynamic bit selection.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "bit_selector.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <complex>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+
+namespace
+{
+std::vector<gr_complex> bit_selector_test_noise(size_t n, float sigma)
+{
+    std::mt19937 generator(5);
+    std::normal_distribution<float> noise(0.0, sigma);
+    std::vector<gr_complex> samples(n);
+    for (auto& sample : samples)
+        {
+            sample = gr_complex(noise(generator), noise(generator));
+        }
+    return samples;
+}
+
+
+// Normalized correlation of the quantized samples with the input, its square is the SNR loss
+double bit_selector_test_correlation(const std::vector<gr_complex>& in, const std::vector<lv_8sc_t>& out)
+{
+    double cross = 0.0;
+    double in_power = 0.0;
+    double out_power = 0.0;
+    for (size_t k = 0; k < in.size(); k++)
+        {
+            const std::complex<double> x(in[k].real(), in[k].imag());
+            const std::complex<double> y(out[k].real(), out[k].imag());
+            cross += (x * std::conj(y)).real();
+            in_power += std::norm(x);
+            out_power += std::norm(y);
+        }
+    return cross / std::sqrt(in_power * out_power);
+}
+}  // namespace
+
+
+TEST(BitSelectorTest, QuantizationLoss)
+{
+    // SNR loss of the optimum uniform quantizers of a Gaussian input, in dB
+    const std::vector<double> expected_loss_db{0.55, 0.17, 0.05};
+    const std::vector<gr_complex> in = bit_selector_test_noise(100000, 300.0);
+    for (int32_t bits = 2; bits <= 4; bits++)
+        {
+            Bit_Selector selector(bits, 4000);
+            std::vector<lv_8sc_t> out(in.size());
+            selector.quantize(in.data(), out.data(), static_cast<int32_t>(in.size()));
+            const int max_level = (1 << bits) - 1;
+            for (const auto& sample : out)
+                {
+                    ASSERT_EQ(std::abs(sample.real()) % 2, 1);
+                    ASSERT_LE(std::abs(sample.real()), max_level);
+                    ASSERT_LE(std::abs(sample.imag()), max_level);
+                }
+            const double correlation = bit_selector_test_correlation(in, out);
+            EXPECT_NEAR(-20.0 * std::log10(correlation), expected_loss_db[bits - 2], 0.03);
+        }
+}
+
+
+TEST(BitSelectorTest, FollowsGainChanges)
+{
+    Bit_Selector selector(8, 1000);
+    std::vector<gr_complex> in = bit_selector_test_noise(20000, 0.01);
+    std::vector<lv_8sc_t> out(in.size());
+    selector.quantize(in.data(), out.data(), 10000);
+    EXPECT_NEAR(selector.power(), 2.0e-4, 2.0e-5);
+
+    // 20 dB more at the front end, the RMS of each output component comes back to 1 / 0.0308
+    for (size_t k = 10000; k < in.size(); k++)
+        {
+            in[k] *= 10.0F;
+        }
+    selector.quantize(in.data() + 10000, out.data() + 10000, 10000);
+    EXPECT_NEAR(selector.power(), 2.0e-2, 2.0e-3);
+    double out_power = 0.0;
+    for (size_t k = 18000; k < out.size(); k++)
+        {
+            out_power += std::norm(std::complex<double>(out[k].real(), out[k].imag()));
+        }
+    EXPECT_NEAR(std::sqrt(out_power / 4000.0) * Bit_Selector::optimal_step(8), 1.0, 0.1);
+}
+
+
+TEST(BitSelectorTest, ShortInputMatchesFloatInput)
+{
+    const std::vector<gr_complex> in = bit_selector_test_noise(9000, 500.0);
+    std::vector<lv_16sc_t> in_short(in.size());
+    std::vector<gr_complex> in_rounded(in.size());
+    for (size_t k = 0; k < in.size(); k++)
+        {
+            in_short[k] = lv_16sc_t(static_cast<int16_t>(std::round(in[k].real())), static_cast<int16_t>(std::round(in[k].imag())));
+            in_rounded[k] = gr_complex(in_short[k].real(), in_short[k].imag());
+        }
+    Bit_Selector selector_float(3, 5000);
+    Bit_Selector selector_short(3, 5000);
+    std::vector<lv_8sc_t> out_float(in.size());
+    std::vector<lv_8sc_t> out_short(in.size());
+    selector_float.quantize(in_rounded.data(), out_float.data(), static_cast<int32_t>(in.size()));
+    selector_short.quantize(in_short.data(), out_short.data(), static_cast<int32_t>(in.size()));
+    EXPECT_EQ(out_float, out_short);
+
+    EXPECT_THROW(Bit_Selector(1, 1000), std::invalid_argument);
+    EXPECT_THROW(Bit_Selector(9, 1000), std::invalid_argument);
+    EXPECT_THROW(Bit_Selector(4, 0), std::invalid_argument);
+}
@@ -0,0 +1,148 @@
+/*!
+ * \file beamformer_weights_test.cc
+ * \brief Checks that the adaptive beamformer weights null a strong
+ * interference while keeping the gain towards the reference element or the
+ * satellites.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "beamformer_weights.h"
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+
+namespace
+{
+// 2 x 2 array, half a wavelength between elements
+std::vector<std::array<double, 3>> beamformer_weights_test_array()
+{
+    return {{0.0, 0.0, 0.0}, {0.5, 0.0, 0.0}, {0.0, 0.5, 0.0}, {0.5, 0.5, 0.0}};
+}
+
+
+// Unit power noise in each element plus a 40 dB interference from the given direction
+std::vector<std::vector<gr_complex>> beamformer_weights_test_snapshots(const Beamformer_Weights& calculator, size_t n, double azimuth_rad, double elevation_rad)
+{
+    const std::vector<std::complex<double>> steering = calculator.steering_vector(azimuth_rad, elevation_rad);
+    std::vector<std::vector<gr_complex>> snapshots(calculator.elements(), std::vector<gr_complex>(n));
+    std::mt19937 generator(11);
+    std::normal_distribution<float> noise(0.0, std::sqrt(0.5));
+    std::uniform_real_distribution<double> phase(0.0, 2.0 * 3.1415926535898);
+    for (size_t t = 0; t < n; t++)
+        {
+            const std::complex<double> interference = std::polar(100.0, phase(generator));
+            for (int k = 0; k < calculator.elements(); k++)
+                {
+                    const std::complex<double> sample = interference * steering[k];
+                    snapshots[k][t] = gr_complex(static_cast<float>(sample.real()) + noise(generator), static_cast<float>(sample.imag()) + noise(generator));
+                }
+        }
+    return snapshots;
+}
+
+
+double beamformer_weights_test_output_power(const std::vector<std::vector<gr_complex>>& snapshots, const std::vector<gr_complex>& weights)
+{
+    double power = 0.0;
+    for (size_t t = 0; t < snapshots[0].size(); t++)
+        {
+            gr_complex sum(0.0, 0.0);
+            for (size_t k = 0; k < snapshots.size(); k++)
+                {
+                    sum += snapshots[k][t] * weights[k];
+                }
+            power += std::norm(sum);
+        }
+    return power / static_cast<double>(snapshots[0].size());
+}
+}  // namespace
+
+
+TEST(BeamformerWeightsTest, PowerInversionNullsInterference)
+{
+    const Beamformer_Weights calculator(beamformer_weights_test_array(), 1e-4);
+    const double azimuth = 1.0;
+    const double elevation = 0.2;
+    const std::vector<std::vector<gr_complex>> snapshots = beamformer_weights_test_snapshots(calculator, 2048, azimuth, elevation);
+    std::vector<const gr_complex*> pointers;
+    for (const auto& element : snapshots)
+        {
+            pointers.push_back(element.data());
+        }
+
+    std::vector<gr_complex> weights;
+    ASSERT_TRUE(calculator.power_inversion(pointers.data(), snapshots[0].size(), weights));
+    ASSERT_EQ(weights.size(), 4U);
+
+    // about 10^4 at the input, the noise of a few elements at the output
+    EXPECT_LT(beamformer_weights_test_output_power(snapshots, weights), 5.0);
+    EXPECT_LT(std::abs(calculator.response(weights, azimuth, elevation)), 1e-2);
+}
+
+
+TEST(BeamformerWeightsTest, SteeredKeepsSatelliteGains)
+{
+    const Beamformer_Weights calculator(beamformer_weights_test_array(), 1e-4);
+    const double azimuth = -2.0;
+    const double elevation = 0.1;
+    const std::vector<std::vector<gr_complex>> snapshots = beamformer_weights_test_snapshots(calculator, 2048, azimuth, elevation);
+    std::vector<const gr_complex*> pointers;
+    for (const auto& element : snapshots)
+        {
+            pointers.push_back(element.data());
+        }
+
+    std::vector<Beamformer_Steering::Direction> directions(2);
+    directions[0].azimuth_rad = 0.5;
+    directions[0].elevation_rad = 1.2;
+    directions[1].azimuth_rad = 2.5;
+    directions[1].elevation_rad = 0.7;
+    std::vector<gr_complex> weights;
+    ASSERT_TRUE(calculator.steered(pointers.data(), snapshots[0].size(), directions, weights));
+    for (const auto& direction : directions)
+        {
+            const gr_complex gain = calculator.response(weights, direction.azimuth_rad, direction.elevation_rad);
+            EXPECT_NEAR(gain.real(), 1.0, 1e-3);
+            EXPECT_NEAR(gain.imag(), 0.0, 1e-3);
+        }
+    EXPECT_LT(std::abs(calculator.response(weights, azimuth, elevation)), 1e-2);
+
+    // Beyond elements() - 1 directions, only the highest ones are constrained
+    for (int k = 0; k < 4; k++)
+        {
+            Beamformer_Steering::Direction low;
+            low.azimuth_rad = 1.5 * k;
+            low.elevation_rad = 0.5 - 0.1 * k;
+            directions.push_back(low);
+        }
+    ASSERT_TRUE(calculator.steered(pointers.data(), snapshots[0].size(), directions, weights));
+    EXPECT_LT(beamformer_weights_test_output_power(snapshots, weights), 20.0);
+}
+
+
+TEST(BeamformerWeightsTest, InvalidInput)
+{
+    EXPECT_THROW(Beamformer_Weights(std::vector<std::array<double, 3>>()), std::invalid_argument);
+    EXPECT_THROW(Beamformer_Weights(beamformer_weights_test_array(), 1e-3, 4), std::invalid_argument);
+
+    const Beamformer_Weights calculator(beamformer_weights_test_array(), 0.0);
+    const std::vector<gr_complex> zeros(16, gr_complex(0.0, 0.0));
+    const std::vector<const gr_complex*> pointers(4, zeros.data());
+    std::vector<gr_complex> weights(4, gr_complex(1.0, 0.0));
+    EXPECT_FALSE(calculator.power_inversion(pointers.data(), zeros.size(), weights));
+    EXPECT_EQ(weights[0], gr_complex(1.0, 0.0));
+}
@@ -0,0 +1,230 @@
+/*!
+ * \file fused_conditioner_test.cc
+ * \brief Checks that the Fused_Conditioner produces the same samples as the
+ * data type adapter, input filter and direct resampler chain.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "fused_conditioner.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+
+namespace
+{
+// Stage by stage, as the separate GNU Radio blocks do it
+std::vector<gr_complex> fused_conditioner_test_reference(const Fused_Conditioner_Conf& conf, const std::vector<gr_complex>& converted)
+{
+    std::vector<gr_complex> samples = converted;
+    if (conf.inverted_spectrum)
+        {
+            for (auto& sample : samples)
+                {
+                    sample = std::conj(sample);
+                }
+        }
+
+    std::vector<gr_complex> filtered;
+    if (conf.taps.empty())
+        {
+            filtered = samples;
+        }
+    else
+        {
+            const size_t ntaps = conf.taps.size();
+            const double fwT0 = 2.0 * 3.1415926535898 * conf.intermediate_freq / conf.sampling_freq;
+            std::vector<gr_complex> padded(ntaps - 1, gr_complex(0.0, 0.0));
+            padded.insert(padded.end(), samples.cbegin(), samples.cend());
+            for (size_t n = 0; n * conf.decimation_factor + ntaps <= padded.size(); n++)
+                {
+                    std::complex<double> acc(0.0, 0.0);
+                    for (size_t k = 0; k < ntaps; k++)
+                        {
+                            const std::complex<double> tap = static_cast<double>(conf.taps[k]) * std::exp(std::complex<double>(0.0, static_cast<double>(k) * fwT0));
+                            const gr_complex x = padded[n * conf.decimation_factor + ntaps - 1 - k];
+                            acc += tap * std::complex<double>(x.real(), x.imag());
+                        }
+                    acc *= std::exp(std::complex<double>(0.0, -fwT0 * static_cast<double>(conf.decimation_factor * n)));
+                    filtered.emplace_back(static_cast<float>(acc.real()), static_cast<float>(acc.imag()));
+                }
+        }
+    if (!conf.resample)
+        {
+            return filtered;
+        }
+
+    std::vector<gr_complex> resampled;
+    const double two_32 = 4294967296.0;
+    uint32_t phase = 0;
+    uint32_t lphase = 0;
+    if (conf.sample_freq_in >= conf.sample_freq_out)
+        {
+            const auto phase_step = static_cast<uint32_t>(std::floor(two_32 * conf.sample_freq_out / conf.sample_freq_in));
+            for (const auto& sample : filtered)
+                {
+                    if (phase <= lphase)
+                        {
+                            resampled.push_back(sample);
+                        }
+                    lphase = phase;
+                    phase += phase_step;
+                }
+        }
+    else
+        {
+            const auto phase_step = static_cast<uint32_t>(std::floor(two_32 * conf.sample_freq_in / conf.sample_freq_out));
+            size_t index = 0;
+            while (true)
+                {
+                    lphase = phase;
+                    phase += phase_step;
+                    if (phase <= lphase)
+                        {
+                            index++;
+                        }
+                    if (index >= filtered.size())
+                        {
+                            break;
+                        }
+                    resampled.push_back(filtered[index]);
+                }
+        }
+    return resampled;
+}
+
+
+// Feeds the input in chunks of random size and pulls the output in chunks of
+// random size
+std::vector<gr_complex> fused_conditioner_test_run(const Fused_Conditioner_Conf& conf, const void* input, size_t n_samples, size_t sample_size)
+{
+    Fused_Conditioner conditioner(conf);
+    std::mt19937 generator(1234);
+    std::uniform_int_distribution<size_t> chunk(1, 700);
+    std::vector<gr_complex> output;
+    std::vector<gr_complex> buffer(1000);
+    size_t pushed = 0;
+    while (pushed < n_samples)
+        {
+            const size_t n = std::min(chunk(generator), n_samples - pushed);
+            conditioner.push(static_cast<const uint8_t*>(input) + pushed * sample_size, n);
+            pushed += n;
+            size_t produced = 0;
+            do
+                {
+                    produced = conditioner.pull(buffer.data(), chunk(generator));
+                    output.insert(output.end(), buffer.cbegin(), buffer.cbegin() + produced);
+                }
+            while (produced > 0);
+        }
+    return output;
+}
+
+
+void fused_conditioner_test_compare(const std::vector<gr_complex>& expected, const std::vector<gr_complex>& actual)
+{
+    ASSERT_GT(expected.size(), 0U);
+    // The fused conditioner keeps the last samples until more input arrives
+    ASSERT_LE(actual.size(), expected.size());
+    ASSERT_GE(actual.size() + 2, expected.size());
+    for (size_t i = 0; i < actual.size(); i++)
+        {
+            ASSERT_NEAR(actual[i].real(), expected[i].real(), 1e-3 * (1.0 + std::abs(expected[i]))) << "at sample " << i;
+            ASSERT_NEAR(actual[i].imag(), expected[i].imag(), 1e-3 * (1.0 + std::abs(expected[i]))) << "at sample " << i;
+        }
+}
+}  // namespace
+
+
+TEST(FusedConditionerTest, ShortInputXlatingFilterAndDownsampling)
+{
+    const size_t n_samples = 20000;
+    std::vector<int16_t> input(2 * n_samples);
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int16_t> value(-2048, 2047);
+    for (auto& item : input)
+        {
+            item = value(generator);
+        }
+    std::vector<gr_complex> converted(n_samples);
+    for (size_t i = 0; i < n_samples; i++)
+        {
+            converted[i] = gr_complex(input[2 * i], input[2 * i + 1]);
+        }
+
+    Fused_Conditioner_Conf conf;
+    conf.input_item_type = "short";
+    conf.inverted_spectrum = true;
+    conf.taps = {0.05F, -0.1F, 0.2F, 0.5F, 0.7F, 0.5F, 0.2F, -0.1F, 0.05F, 0.01F, -0.02F};
+    conf.intermediate_freq = 1.25e6;
+    conf.sampling_freq = 8e6;
+    conf.decimation_factor = 2;
+    conf.resample = true;
+    conf.sample_freq_in = 4e6;
+    conf.sample_freq_out = 3e6;
+
+    Fused_Conditioner conditioner(conf);
+    EXPECT_EQ(conditioner.items_per_sample(), 2U);
+    EXPECT_DOUBLE_EQ(conditioner.rate(), 0.375);
+
+    fused_conditioner_test_compare(fused_conditioner_test_reference(conf, converted),
+        fused_conditioner_test_run(conf, input.data(), n_samples, 2 * sizeof(int16_t)));
+}
+
+
+TEST(FusedConditionerTest, ComplexInputFilterAndUpsampling)
+{
+    const size_t n_samples = 10000;
+    std::vector<gr_complex> input(n_samples);
+    std::mt19937 generator(43);
+    std::normal_distribution<float> value(0.0, 1.0);
+    for (auto& sample : input)
+        {
+            sample = gr_complex(value(generator), value(generator));
+        }
+
+    Fused_Conditioner_Conf conf;
+    conf.taps = {0.1F, 0.3F, 0.5F, 0.3F, 0.1F};
+    conf.resample = true;
+    conf.sample_freq_in = 2e6;
+    conf.sample_freq_out = 2.6e6;
+
+    fused_conditioner_test_compare(fused_conditioner_test_reference(conf, input),
+        fused_conditioner_test_run(conf, input.data(), n_samples, sizeof(gr_complex)));
+}
+
+
+TEST(FusedConditionerTest, ByteInputWithoutFilter)
+{
+    const size_t n_samples = 5000;
+    std::vector<int8_t> input(2 * n_samples);
+    std::vector<gr_complex> converted(n_samples);
+    for (size_t i = 0; i < n_samples; i++)
+        {
+            input[2 * i] = static_cast<int8_t>(i % 255 - 127);
+            input[2 * i + 1] = static_cast<int8_t>(127 - (3 * i) % 255);
+            converted[i] = gr_complex(input[2 * i], input[2 * i + 1]);
+        }
+
+    Fused_Conditioner_Conf conf;
+    conf.input_item_type = "byte";
+    const std::vector<gr_complex> output = fused_conditioner_test_run(conf, input.data(), n_samples, 2 * sizeof(int8_t));
+    ASSERT_EQ(output.size(), n_samples);
+    for (size_t i = 0; i < n_samples; i++)
+        {
+            ASSERT_EQ(output[i], converted[i]);
+        }
+}
@@ -0,0 +1,142 @@
+/*!
+ * \file interference_mitigation_test.cc
+ * \brief Checks that the pulse blanker zeroes the pulses and that the notch
+ * canceller removes a narrowband interference, also in place and with the
+ * noise floor of a spectral monitor.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_spectral_monitor.h"
+#include "interference_mitigation.h"
+#include <gtest/gtest.h>
+#include <complex>
+#include <memory>
+#include <random>
+#include <vector>
+
+
+namespace
+{
+// Unit power noise, plus a chirp of amplitude 20 after the first n_clean samples
+std::vector<gr_complex> interference_mitigation_test_signal(int n, int n_clean)
+{
+    std::vector<gr_complex> signal(n);
+    std::mt19937 generator(3);
+    std::normal_distribution<float> noise(0.0, std::sqrt(0.5));
+    for (int k = 0; k < n; k++)
+        {
+            signal[k] = gr_complex(noise(generator), noise(generator));
+            if (k >= n_clean)
+                {
+                    signal[k] += std::polar(20.0F, 0.3F * static_cast<float>(k) + 1e-6F * static_cast<float>(k) * static_cast<float>(k));
+                }
+        }
+    return signal;
+}
+
+
+double interference_mitigation_test_power(const std::vector<gr_complex>& signal, int first, int last)
+{
+    double power = 0.0;
+    for (int k = first; k < last; k++)
+        {
+            power += std::norm(signal[k]);
+        }
+    return power / static_cast<double>(last - first);
+}
+}  // namespace
+
+
+TEST(InterferenceMitigationTest, BlankerZeroesPulses)
+{
+    const int length = 32;
+    const int n_est = 100;
+    std::vector<gr_complex> signal = interference_mitigation_test_signal(length * 400, length * 400);
+    for (int k = length * 200; k < length * 210; k++)
+        {
+            signal[k] *= 100.0F;
+        }
+    Pulse_Blanker blanker(0.001, length, n_est, 5000000);
+    std::vector<gr_complex> out(signal.size());
+    int blanked = 0;
+    for (size_t k = 0; k < signal.size(); k += length)
+        {
+            if (blanker.process(&signal[k], &out[k]))
+                {
+                    blanked++;
+                    EXPECT_EQ(out[k], gr_complex(0.0, 0.0));
+                }
+        }
+    EXPECT_GE(blanked, 10);
+    EXPECT_LE(blanked, 12);
+    EXPECT_EQ(out[length * 300], signal[length * 300]);
+}
+
+
+TEST(InterferenceMitigationTest, NotchRemovesNarrowbandInterference)
+{
+    const int length = 32;
+    const int n_est = 100;
+    const int n = length * 2000;
+    const std::vector<gr_complex> signal = interference_mitigation_test_signal(n, length * n_est);
+    Notch_Canceller notch(0.001, 0.9, length, n_est, 5000000);
+    std::vector<gr_complex> out(n);
+    for (int k = 0; k < n; k += length)
+        {
+            notch.process(&signal[k], &out[k]);
+        }
+    // untouched while estimating the noise floor
+    EXPECT_EQ(out[length], signal[length]);
+    // 400 at the input
+    EXPECT_LT(interference_mitigation_test_power(out, n / 2, n), 5.0);
+
+    // same output in place
+    std::vector<gr_complex> in_place = signal;
+    Notch_Canceller notch_in_place(0.001, 0.9, length, n_est, 5000000);
+    for (int k = 0; k < n; k += length)
+        {
+            notch_in_place.process(&in_place[k], &in_place[k]);
+        }
+    EXPECT_EQ(in_place, out);
+}
+
+
+TEST(InterferenceMitigationTest, NotchUsesTheSpectralMonitor)
+{
+    const int length = 32;
+    const int n = length * 2000;
+    const std::vector<gr_complex> signal = interference_mitigation_test_signal(n, length * 100);
+    // the notch never estimates the noise floor by itself
+    Notch_Canceller notch(0.001, 0.9, length, 1000000000, 1000000000);
+    auto monitor = std::make_shared<Gnss_Spectral_Monitor>(256, 1, 8, 4e6);
+    notch.set_spectral_monitor(monitor);
+    std::vector<gr_complex> out(n);
+
+    // untouched until the first estimate
+    notch.process(&signal[length * 150], &out[0]);
+    EXPECT_EQ(out[0], signal[length * 150]);
+
+    // estimate of the noise without the chirp
+    for (int k = 0; k < 100; k++)
+        {
+            monitor->push(&signal[k * length], length);
+            monitor->process_pending();
+        }
+    ASSERT_EQ(monitor->sequence(), 1U);
+    EXPECT_NEAR(monitor->noise_variance(), 1.0, 0.15);
+    for (int k = 0; k < n; k += length)
+        {
+            notch.process(&signal[k], &out[k]);
+        }
+    EXPECT_EQ(out[length], signal[length]);
+    EXPECT_LT(interference_mitigation_test_power(out, n / 2, n), 5.0);
+}
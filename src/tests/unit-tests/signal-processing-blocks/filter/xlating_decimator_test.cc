@@ -0,0 +1,234 @@
+/*!
+ * \file xlating_decimator_test.cc
+ * \brief Checks the time-domain and FFT implementations of the
+ * Xlating_Decimator against a direct frequency translating FIR filter.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "xlating_decimator.h"
+#include "GLONASS_L1_L2_CA.h"
+#include "rational_resampler.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+
+namespace
+{
+std::vector<gr_complex> xlating_decimator_test_input(size_t n_samples)
+{
+    std::vector<gr_complex> input(n_samples);
+    std::mt19937 generator(7);
+    std::normal_distribution<float> value(0.0, 1.0);
+    for (auto& sample : input)
+        {
+            sample = gr_complex(value(generator), value(generator));
+        }
+    return input;
+}
+
+
+std::vector<float> xlating_decimator_test_taps(size_t ntaps)
+{
+    // Hamming windowed sinc with the cutoff at 1/16 of the sampling rate
+    std::vector<float> taps(ntaps);
+    const double middle = static_cast<double>(ntaps - 1) / 2.0;
+    for (size_t k = 0; k < ntaps; k++)
+        {
+            const double t = static_cast<double>(k) - middle;
+            const double sinc = (t == 0.0) ? 1.0 : std::sin(3.1415926535898 * t / 8.0) / (3.1415926535898 * t / 8.0);
+            const double window = 0.54 - 0.46 * std::cos(2.0 * 3.1415926535898 * static_cast<double>(k) / static_cast<double>(ntaps - 1));
+            taps[k] = static_cast<float>(sinc * window / 8.0);
+        }
+    return taps;
+}
+
+
+// A freq_xlating_fir_filter_ccf per band, starting with zeroed history
+std::vector<gr_complex> xlating_decimator_test_reference(const std::vector<gr_complex>& input, const std::vector<float>& taps, size_t decimation, double center_freq)
+{
+    const size_t ntaps = taps.size();
+    const double fwT0 = 2.0 * 3.1415926535898 * center_freq;
+    std::vector<gr_complex> padded(ntaps - 1, gr_complex(0.0, 0.0));
+    padded.insert(padded.end(), input.cbegin(), input.cend());
+    std::vector<gr_complex> output;
+    for (size_t n = 0; n * decimation + ntaps <= padded.size(); n++)
+        {
+            std::complex<double> acc(0.0, 0.0);
+            for (size_t k = 0; k < ntaps; k++)
+                {
+                    const std::complex<double> tap = static_cast<double>(taps[k]) * std::exp(std::complex<double>(0.0, static_cast<double>(k) * fwT0));
+                    const gr_complex x = padded[n * decimation + ntaps - 1 - k];
+                    acc += tap * std::complex<double>(x.real(), x.imag());
+                }
+            acc *= std::exp(std::complex<double>(0.0, -fwT0 * static_cast<double>(decimation * n)));
+            output.emplace_back(static_cast<float>(acc.real()), static_cast<float>(acc.imag()));
+        }
+    return output;
+}
+
+
+// Runs the decimator as a sync_decimator with history would, in calls of
+// random size
+std::vector<std::vector<gr_complex>> xlating_decimator_test_run(Xlating_Decimator& decimator, const std::vector<gr_complex>& input)
+{
+    const size_t ntaps = decimator.ntaps();
+    const size_t decimation = decimator.decimation();
+    const size_t multiple = decimator.output_multiple();
+    std::vector<gr_complex> padded(ntaps - 1, gr_complex(0.0, 0.0));
+    padded.insert(padded.end(), input.cbegin(), input.cend());
+
+    std::vector<std::vector<gr_complex>> output(decimator.outputs());
+    std::vector<std::vector<gr_complex>> buffers(decimator.outputs());
+    std::vector<gr_complex*> out(decimator.outputs());
+    std::mt19937 generator(99);
+    std::uniform_int_distribution<size_t> calls(1, 5);
+    size_t position = 0;
+    while (true)
+        {
+            const size_t available = (padded.size() - position < ntaps) ? 0 : (padded.size() - position - ntaps) / decimation + 1;
+            const size_t n_out = std::min(calls(generator), available / multiple) * multiple;
+            if (n_out == 0)
+                {
+                    break;
+                }
+            for (size_t band = 0; band < out.size(); band++)
+                {
+                    buffers[band].assign(n_out, gr_complex(0.0, 0.0));
+                    out[band] = buffers[band].data();
+                }
+            decimator.filter(padded.data() + position, n_out, out.data());
+            for (size_t band = 0; band < out.size(); band++)
+                {
+                    output[band].insert(output[band].end(), buffers[band].cbegin(), buffers[band].cend());
+                }
+            position += n_out * decimation;
+        }
+    return output;
+}
+
+
+void xlating_decimator_test_compare(const std::vector<gr_complex>& input, const std::vector<float>& taps, size_t decimation,
+    const std::vector<double>& center_freqs, const std::vector<std::vector<gr_complex>>& output)
+{
+    ASSERT_EQ(output.size(), center_freqs.size());
+    for (size_t band = 0; band < center_freqs.size(); band++)
+        {
+            const std::vector<gr_complex> expected = xlating_decimator_test_reference(input, taps, decimation, center_freqs[band]);
+            ASSERT_GT(output[band].size(), expected.size() / 2);
+            ASSERT_LE(output[band].size(), expected.size());
+            for (size_t i = 0; i < output[band].size(); i++)
+                {
+                    ASSERT_NEAR(output[band][i].real(), expected[i].real(), 1e-3) << "band " << band << ", sample " << i;
+                    ASSERT_NEAR(output[band][i].imag(), expected[i].imag(), 1e-3) << "band " << band << ", sample " << i;
+                }
+        }
+}
+}  // namespace
+
+
+TEST(XlatingDecimatorTest, PolyphaseMatchesReference)
+{
+    const std::vector<gr_complex> input = xlating_decimator_test_input(20000);
+    const std::vector<float> taps = xlating_decimator_test_taps(31);
+    const std::vector<double> center_freqs = {0.0, 0.21, -0.3};
+    Xlating_Decimator decimator(taps, 4, center_freqs, Xlating_Decimator::Backend::POLYPHASE);
+    EXPECT_EQ(decimator.backend(), Xlating_Decimator::Backend::POLYPHASE);
+    EXPECT_EQ(decimator.output_multiple(), 1U);
+    xlating_decimator_test_compare(input, taps, 4, center_freqs, xlating_decimator_test_run(decimator, input));
+}
+
+
+TEST(XlatingDecimatorTest, FftMatchesReference)
+{
+    const std::vector<gr_complex> input = xlating_decimator_test_input(40000);
+    const std::vector<float> taps = xlating_decimator_test_taps(127);
+    const std::vector<double> center_freqs = {0.125, -0.0625, 0.33};
+    Xlating_Decimator decimator(taps, 6, center_freqs, Xlating_Decimator::Backend::FFT);
+    EXPECT_EQ(decimator.backend(), Xlating_Decimator::Backend::FFT);
+    EXPECT_GE(decimator.fft_size(), 127U + 5U);
+    xlating_decimator_test_compare(input, taps, 6, center_freqs, xlating_decimator_test_run(decimator, input));
+
+    Xlating_Decimator small(taps, 6, center_freqs, Xlating_Decimator::Backend::FFT, 256);
+    EXPECT_EQ(small.fft_size(), 256U);
+    EXPECT_EQ(small.output_multiple(), (256U - 126U) / 6U);
+    xlating_decimator_test_compare(input, taps, 6, center_freqs, xlating_decimator_test_run(small, input));
+}
+
+
+TEST(XlatingDecimatorTest, AutomaticBackend)
+{
+    const Xlating_Decimator short_filter(xlating_decimator_test_taps(11), 2, {0.1});
+    EXPECT_EQ(short_filter.backend(), Xlating_Decimator::Backend::POLYPHASE);
+
+    const Xlating_Decimator long_filter(xlating_decimator_test_taps(1023), 4, {0.1, 0.2, 0.3});
+    EXPECT_EQ(long_filter.backend(), Xlating_Decimator::Backend::FFT);
+    EXPECT_LT(Xlating_Decimator::fft_cost(1023, 4, 3, long_filter.fft_size()), Xlating_Decimator::polyphase_cost(1023, 4, 3));
+
+    EXPECT_THROW(Xlating_Decimator(xlating_decimator_test_taps(127), 2, {0.0}, Xlating_Decimator::Backend::FFT, 64), std::invalid_argument);
+    EXPECT_THROW(Xlating_Decimator(std::vector<float>(), 2, {0.0}), std::invalid_argument);
+}
+
+
+TEST(XlatingDecimatorTest, GlonassFdmaSubBands)
+{
+    // the acquisition channelizer of the flow graph, from 8 MHz to 2 MHz
+    const double fs = 8e6;
+    const int decimation = 4;
+    const std::vector<float> taps = Rational_Resampler::design_taps(1, decimation, 0.5, 50.0);
+    std::vector<double> center_freqs;
+    for (int32_t k = GLONASS_MIN_FREQUENCY_NUMBER; k <= GLONASS_MAX_FREQUENCY_NUMBER; k++)
+        {
+            center_freqs.push_back(static_cast<double>(k) * DFRQ1_GLO / fs);
+        }
+    Xlating_Decimator channelizer(taps, decimation, center_freqs);
+    ASSERT_EQ(channelizer.outputs(), 14U);
+
+    // a satellite of frequency number 3 with a Doppler shift of 2 kHz
+    const double doppler_hz = 2000.0;
+    std::vector<gr_complex> input(40000);
+    for (size_t n = 0; n < input.size(); n++)
+        {
+            const double phase = 2.0 * 3.1415926535898 * (3.0 * DFRQ1_GLO + doppler_hz) * static_cast<double>(n) / fs;
+            input[n] = gr_complex(static_cast<float>(std::cos(phase)), static_cast<float>(std::sin(phase)));
+        }
+    const std::vector<std::vector<gr_complex>> output = xlating_decimator_test_run(channelizer, input);
+    const size_t settle = taps.size();
+    for (int32_t k = GLONASS_MIN_FREQUENCY_NUMBER; k <= GLONASS_MAX_FREQUENCY_NUMBER; k++)
+        {
+            const std::vector<gr_complex>& sub_band = output[k - GLONASS_MIN_FREQUENCY_NUMBER];
+            ASSERT_GT(sub_band.size(), settle);
+            double power = 0.0;
+            std::complex<double> rotation(0.0, 0.0);
+            for (size_t i = settle; i < sub_band.size(); i++)
+                {
+                    power += std::norm(sub_band[i]);
+                    rotation += std::complex<double>(sub_band[i].real(), sub_band[i].imag()) * std::conj(std::complex<double>(sub_band[i - 1].real(), sub_band[i - 1].imag()));
+                }
+            power /= static_cast<double>(sub_band.size() - settle);
+            if (k == 3)
+                {
+                    // at baseband, with its Doppler shift
+                    EXPECT_NEAR(power, 1.0, 0.01);
+                    EXPECT_NEAR(std::arg(rotation) * fs / decimation / (2.0 * 3.1415926535898), doppler_hz, 1.0);
+                }
+            else if (std::abs(k - 3) >= 3)
+                {
+                    // beyond the transition band of the filter
+                    EXPECT_LT(power, 1e-4) << "frequency number " << k;
+                }
+        }
+}
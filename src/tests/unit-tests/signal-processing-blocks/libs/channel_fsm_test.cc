@@ -0,0 +1,233 @@
+/*!
+ * \file channel_fsm_test.cc
+ * \brief Tests of the transitions and side effects of the channel state
+ * machine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acquisition_interface.h"
+#include "channel_fsm.h"
+#include "concurrent_queue.h"
+#include "control_event.h"
+#include "telemetry_decoder_interface.h"
+#include "tracking_interface.h"
+#include <gtest/gtest.h>
+#include <pmt/pmt.h>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+// counts the calls, and the calls that overlap with another one
+struct Fsm_Test_Calls
+{
+    void enter()
+    {
+        if (inside.fetch_add(1) != 0)
+            {
+                overlaps++;
+            }
+    }
+    void leave()
+    {
+        inside--;
+    }
+    std::atomic<int> inside{0};
+    std::atomic<int> overlaps{0};
+    std::atomic<int> acq_resets{0};
+    std::atomic<int> acq_stops{0};
+    std::atomic<int> trk_starts{0};
+    std::atomic<int> trk_stops{0};
+};
+
+
+// the methods that the state machine does not call do nothing
+class Fsm_Test_Acquisition : public AcquisitionInterface
+{
+public:
+    explicit Fsm_Test_Acquisition(Fsm_Test_Calls* calls) : d_calls(calls) {}
+    std::string role() override { return "Acquisition"; }
+    std::string implementation() override { return "Fsm_Test"; }
+    size_t item_size() override { return 0; }
+    void connect(gr::top_block_sptr top_block __attribute__((unused))) override {}
+    void disconnect(gr::top_block_sptr top_block __attribute__((unused))) override {}
+    gr::basic_block_sptr get_left_block() override { return nullptr; }
+    gr::basic_block_sptr get_right_block() override { return nullptr; }
+    void set_gnss_synchro(Gnss_Synchro* gnss_synchro __attribute__((unused))) override {}
+    void set_channel(unsigned int channel_id __attribute__((unused))) override {}
+    void set_channel_fsm(std::weak_ptr<ChannelFsm> channel_fsm __attribute__((unused))) override {}
+    void set_threshold(float threshold __attribute__((unused))) override {}
+    void set_doppler_max(unsigned int doppler_max __attribute__((unused))) override {}
+    void set_doppler_step(unsigned int doppler_step __attribute__((unused))) override {}
+    void init() override {}
+    void set_local_code() override {}
+    void set_state(int state __attribute__((unused))) override {}
+    signed int mag() override { return 0; }
+    void reset() override
+    {
+        d_calls->enter();
+        d_calls->acq_resets++;
+        d_calls->leave();
+    }
+    void stop_acquisition() override
+    {
+        d_calls->enter();
+        d_calls->acq_stops++;
+        d_calls->leave();
+    }
+    void set_resampler_latency(uint32_t latency_samples __attribute__((unused))) override {}
+
+private:
+    Fsm_Test_Calls* d_calls;
+};
+
+
+class Fsm_Test_Tracking : public TrackingInterface
+{
+public:
+    explicit Fsm_Test_Tracking(Fsm_Test_Calls* calls) : d_calls(calls) {}
+    std::string role() override { return "Tracking"; }
+    std::string implementation() override { return "Fsm_Test"; }
+    size_t item_size() override { return 0; }
+    void connect(gr::top_block_sptr top_block __attribute__((unused))) override {}
+    void disconnect(gr::top_block_sptr top_block __attribute__((unused))) override {}
+    gr::basic_block_sptr get_left_block() override { return nullptr; }
+    gr::basic_block_sptr get_right_block() override { return nullptr; }
+    void start_tracking() override
+    {
+        d_calls->enter();
+        d_calls->trk_starts++;
+        d_calls->leave();
+    }
+    void stop_tracking() override
+    {
+        d_calls->enter();
+        d_calls->trk_stops++;
+        d_calls->leave();
+    }
+    void set_gnss_synchro(Gnss_Synchro* gnss_synchro __attribute__((unused))) override {}
+    void set_channel(unsigned int channel __attribute__((unused))) override {}
+
+private:
+    Fsm_Test_Calls* d_calls;
+};
+
+
+class Fsm_Test_Telemetry : public TelemetryDecoderInterface
+{
+public:
+    std::string role() override { return "TelemetryDecoder"; }
+    std::string implementation() override { return "Fsm_Test"; }
+    size_t item_size() override { return 0; }
+    void connect(gr::top_block_sptr top_block __attribute__((unused))) override {}
+    void disconnect(gr::top_block_sptr top_block __attribute__((unused))) override {}
+    gr::basic_block_sptr get_left_block() override { return nullptr; }
+    gr::basic_block_sptr get_right_block() override { return nullptr; }
+    void reset() override {}
+    void set_satellite(const Gnss_Satellite& sat __attribute__((unused))) override {}
+    void set_channel(int channel __attribute__((unused))) override {}
+};
+
+
+// number of events of each type in the queue
+std::vector<int> fsm_test_queued_events(Concurrent_Queue<pmt::pmt_t>& queue)
+{
+    std::vector<int> events(3, 0);
+    pmt::pmt_t msg;
+    while (queue.try_pop(msg))
+        {
+            Control_Event event{};
+            if (control_event_from_pmt(msg, event) and event.event_type < 3)
+                {
+                    events[event.event_type]++;
+                }
+        }
+    return events;
+}
+}  // namespace
+
+
+class ChannelFsmTest : public ::testing::Test
+{
+protected:
+    ChannelFsmTest()
+    {
+        fsm->set_acquisition(std::make_shared<Fsm_Test_Acquisition>(&calls));
+        fsm->set_tracking(std::make_shared<Fsm_Test_Tracking>(&calls));
+        fsm->set_telemetry(std::make_shared<Fsm_Test_Telemetry>());
+        fsm->set_queue(&queue);
+        fsm->set_channel(3);
+    }
+
+    Fsm_Test_Calls calls;
+    Concurrent_Queue<pmt::pmt_t> queue;
+    std::shared_ptr<ChannelFsm> fsm = std::make_shared<ChannelFsm>();
+};
+
+
+TEST_F(ChannelFsmTest, TransitionsAndSideEffects)
+{
+    EXPECT_FALSE(fsm->Event_valid_acquisition());  // not in acquisition
+    EXPECT_TRUE(fsm->Event_start_acquisition());
+    EXPECT_FALSE(fsm->Event_start_acquisition());
+    EXPECT_EQ(calls.acq_resets, 1);
+    EXPECT_TRUE(fsm->Event_failed_acquisition_repeat());
+    EXPECT_EQ(calls.acq_resets, 2);
+    EXPECT_TRUE(fsm->Event_valid_acquisition());
+    EXPECT_EQ(calls.trk_starts, 1);
+    EXPECT_TRUE(fsm->Event_stop_channel());
+    EXPECT_EQ(calls.trk_stops, 1);
+    EXPECT_FALSE(fsm->Event_failed_tracking_standby());  // already stopped
+    EXPECT_TRUE(fsm->Event_start_acquisition());
+    EXPECT_TRUE(fsm->Event_failed_acquisition_no_repeat());
+
+    const std::vector<int> events = fsm_test_queued_events(queue);
+    EXPECT_EQ(events[0], 1);  // satellite requested
+    EXPECT_EQ(events[1], 1);  // tracking started
+    EXPECT_EQ(events[2], 0);
+}
+
+
+TEST_F(ChannelFsmTest, ConcurrentEvents)
+{
+    // the acquisition and the tracking threads report their results while
+    // the control thread restarts and stops the channel
+    const int cycles = 20000;
+    std::thread worker([this]() {
+        for (int i = 0; i < cycles; i++)
+            {
+                fsm->Event_valid_acquisition();
+                fsm->Event_failed_tracking_standby();
+            }
+    });
+    for (int i = 0; i < cycles; i++)
+        {
+            fsm->Event_start_acquisition();
+            if (i % 3 == 0)
+                {
+                    fsm->Event_stop_channel();
+                }
+        }
+    worker.join();
+    fsm->Event_stop_channel();
+
+    // the side effects never overlap, and every tracking started was stopped
+    EXPECT_EQ(calls.overlaps, 0);
+    const std::vector<int> events = fsm_test_queued_events(queue);
+    EXPECT_EQ(events[1], calls.trk_starts);
+    EXPECT_EQ(calls.trk_starts, calls.trk_stops + events[2]);
+    EXPECT_FALSE(fsm->Event_failed_tracking_standby());
+}
@@ -0,0 +1,193 @@
+/*!
+ * \file gnss_dump_writer_test.cc
+ * \brief  Tests of the buffered dump files written by a background thread
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_dump_reader.h"
+#include "gnss_dump_writer.h"
+#include "gnss_sdr_filesystem.h"
+#include <gtest/gtest.h>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+TEST(GnssDumpWriterTest, SameContentsAsOfstream)
+{
+    const int n_files = 3;
+    const int n_records = 1000;
+    std::array<std::string, n_files> filenames;
+    std::array<std::vector<char>, n_files> expected;
+    {
+        // small blocks, so that the records are split between blocks
+        std::vector<std::unique_ptr<Gnss_Dump_Writer>> writers;
+        for (int f = 0; f < n_files; f++)
+            {
+                filenames[f] = "./gnss_dump_writer_test_" + std::to_string(f) + ".dat";
+                writers.emplace_back(new Gnss_Dump_Writer(50, 2));
+                writers[f]->open(filenames[f]);
+                EXPECT_TRUE(writers[f]->is_open());
+            }
+        for (int n = 0; n < n_records; n++)
+            {
+                for (int f = 0; f < n_files; f++)
+                    {
+                        const auto tmp_double = static_cast<double>(n) / 1000.0;
+                        const auto tmp_ulong_int = static_cast<uint64_t>(n * (f + 1));
+                        const auto tmp_int = static_cast<int32_t>(-n);
+                        writers[f]->write(tmp_double);
+                        writers[f]->write(tmp_ulong_int);
+                        writers[f]->write(tmp_int);
+                        for (const auto *p : {reinterpret_cast<const char *>(&tmp_double), reinterpret_cast<const char *>(&tmp_ulong_int)})
+                            {
+                                expected[f].insert(expected[f].end(), p, p + 8);
+                            }
+                        expected[f].insert(expected[f].end(), reinterpret_cast<const char *>(&tmp_int), reinterpret_cast<const char *>(&tmp_int) + 4);
+                    }
+            }
+        for (int f = 0; f < n_files; f++)
+            {
+                EXPECT_EQ(writers[f]->bytes_written(), expected[f].size());
+            }
+        // the first file is closed explicitly, the others when destroyed
+        writers[0]->close();
+        EXPECT_FALSE(writers[0]->is_open());
+        EXPECT_THROW(writers[0]->write(0), std::ios_base::failure);
+    }
+
+    for (int f = 0; f < n_files; f++)
+        {
+            std::ifstream file(filenames[f], std::ios::binary);
+            const std::vector<char> contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            EXPECT_EQ(contents, expected[f]) << "file " << f;
+            file.close();
+            errorlib::error_code ec;
+            fs::remove(fs::path(filenames[f]), ec);
+        }
+}
+
+
+TEST(GnssDumpWriterTest, OpenFailureThrows)
+{
+    Gnss_Dump_Writer writer;
+    EXPECT_THROW(writer.open("./this_directory_does_not_exist/dump.dat"), std::ios_base::failure);
+    EXPECT_FALSE(writer.is_open());
+}
+
+
+TEST(GnssDumpWriterTest, CompressedRecordsReadBack)
+{
+    // records like the ones of the tracking blocks: slowly varying floats, a sample counter and a PRN
+    struct Record
+    {
+        float correlation;
+        float doppler;
+        uint64_t sample_count;
+        double phase;
+        int16_t error;
+        uint32_t prn;
+    };
+    const std::string layout = "ffQdhI";
+    const std::size_t record_size = 4 + 4 + 8 + 8 + 2 + 4;
+    const int n_records = 10000;
+    const std::string filename = "./gnss_dump_writer_test_compressed.dat";
+    std::vector<char> expected;
+    {
+        Gnss_Dump_Writer writer(1000, 2);
+        writer.set_record_layout(layout, 777);
+        writer.open(filename);
+        for (int n = 0; n < n_records; n++)
+            {
+                Record r{};
+                r.correlation = 1000.0F + static_cast<float>(n % 17);
+                r.doppler = -1250.5F;
+                r.sample_count = 4000000ULL + 4000ULL * static_cast<uint64_t>(n);
+                r.phase = 0.01 * static_cast<double>(n);
+                r.error = static_cast<int16_t>(n % 2 == 0 ? -3 : 5);
+                r.prn = 7;
+                writer.write(r.correlation);
+                writer.write(r.doppler);
+                writer.write(r.sample_count);
+                writer.write(r.phase);
+                writer.write(r.error);
+                writer.write(r.prn);
+                for (const auto &field : std::vector<std::pair<const void *, std::size_t>>{{&r.correlation, 4}, {&r.doppler, 4}, {&r.sample_count, 8}, {&r.phase, 8}, {&r.error, 2}, {&r.prn, 4}})
+                    {
+                        const auto *p = static_cast<const char *>(field.first);
+                        expected.insert(expected.end(), p, p + field.second);
+                    }
+            }
+        EXPECT_EQ(writer.bytes_written(), expected.size());
+    }
+
+    EXPECT_LT(fs::file_size(fs::path(filename)), expected.size() / 2);
+
+    Gnss_Dump_Reader reader;
+    EXPECT_THROW(reader.open(filename, record_size + 1), std::ios_base::failure);
+    reader.open(filename, record_size);
+    EXPECT_TRUE(reader.is_compressed());
+    EXPECT_EQ(reader.layout(), layout);
+    EXPECT_EQ(reader.records(), static_cast<uint64_t>(n_records));
+    // blocks that do not match the chunks
+    std::vector<char> contents;
+    std::vector<char> records(1000 * record_size);
+    std::size_t n = 0;
+    while ((n = reader.read(records.data(), 1000)) > 0)
+        {
+            contents.insert(contents.end(), records.begin(), records.begin() + n * record_size);
+        }
+    EXPECT_TRUE(contents == expected);
+    reader.close();
+    errorlib::error_code ec;
+    fs::remove(fs::path(filename), ec);
+}
+
+
+TEST(GnssDumpWriterTest, PlainRecordsReadBack)
+{
+    const std::string filename = "./gnss_dump_writer_test_plain.dat";
+    {
+        Gnss_Dump_Writer writer;
+        writer.open(filename);
+        for (int32_t n = 0; n < 100; n++)
+            {
+                writer.write(n);
+                writer.write(static_cast<double>(n));
+            }
+    }
+    Gnss_Dump_Reader reader;
+    reader.open(filename, 12);
+    EXPECT_FALSE(reader.is_compressed());
+    EXPECT_EQ(reader.records(), 100U);
+    std::array<char, 12> record{};
+    for (int32_t n = 0; n < 100; n++)
+        {
+            ASSERT_EQ(reader.read(record.data(), 1), 1U);
+            int32_t i;
+            double d;
+            std::memcpy(&i, record.data(), 4);
+            std::memcpy(&d, record.data() + 4, 8);
+            EXPECT_EQ(i, n);
+            EXPECT_EQ(d, static_cast<double>(n));
+        }
+    EXPECT_EQ(reader.read(record.data(), 1), 0U);
+    reader.close();
+    errorlib::error_code ec;
+    fs::remove(fs::path(filename), ec);
+}
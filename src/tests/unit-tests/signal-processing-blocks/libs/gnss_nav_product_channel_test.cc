@@ -0,0 +1,152 @@
+/*!
+ * \file gnss_nav_product_channel_test.cc
+ * \brief  Tests of the delivery of navigation data from the telemetry
+ * decoders to PVT
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_nav_product_channel.h"
+#include "gps_ephemeris.h"
+#include "gps_iono.h"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+TEST(GnssNavProductChannelTest, TypedProducts)
+{
+    auto eph = std::make_shared<Gps_Ephemeris>();
+    eph->PRN = 7;
+    const Gnss_Nav_Product product(eph);
+    EXPECT_EQ(product.type(), NAV_GPS_EPHEMERIS);
+    ASSERT_NE(product.get<Gps_Ephemeris>(), nullptr);
+    EXPECT_EQ(product.get<Gps_Ephemeris>()->PRN, 7U);
+    EXPECT_EQ(product.get<Gps_Iono>(), nullptr);
+    EXPECT_EQ(Gnss_Nav_Product().type(), NAV_NONE);
+}
+
+
+TEST(GnssNavProductChannelTest, ReaderDrainsAllChannels)
+{
+    auto channel1 = Gnss_Nav_Product_Channel::create();
+    auto channel2 = Gnss_Nav_Product_Channel::create();
+    Gnss_Nav_Product_Reader reader;
+    std::vector<Gnss_Nav_Product> products;
+    reader.drain(products);
+    products.clear();
+
+    for (uint32_t prn = 1; prn <= 3; prn++)
+        {
+            auto eph = std::make_shared<Gps_Ephemeris>();
+            eph->PRN = prn;
+            channel1->push(Gnss_Nav_Product(eph));
+        }
+    channel2->push(Gnss_Nav_Product(std::make_shared<Gps_Iono>()));
+
+    // a channel created after the first call is also drained
+    auto channel3 = Gnss_Nav_Product_Channel::create();
+    channel3->push(Gnss_Nav_Product(std::make_shared<Gps_Iono>()));
+
+    reader.drain(products);
+    ASSERT_EQ(products.size(), 5U);
+    for (uint32_t i = 0; i < 3; i++)
+        {
+            ASSERT_EQ(products[i].type(), NAV_GPS_EPHEMERIS);
+            EXPECT_EQ(products[i].get<Gps_Ephemeris>()->PRN, i + 1);
+        }
+    EXPECT_EQ(products[3].type(), NAV_GPS_IONO);
+    EXPECT_EQ(products[4].type(), NAV_GPS_IONO);
+
+    products.clear();
+    reader.drain(products);
+    EXPECT_TRUE(products.empty());
+}
+
+
+TEST(GnssNavProductChannelTest, FullChannelKeepsTheLatestProducts)
+{
+    Gnss_Nav_Product_Channel channel(4);
+    auto push_eph = [&channel](uint32_t prn, int32_t toe) {
+        auto eph = std::make_shared<Gps_Ephemeris>();
+        eph->PRN = prn;
+        eph->toe = toe;
+        channel.push(Gnss_Nav_Product(eph));
+    };
+    for (uint32_t prn = 1; prn <= 4; prn++)
+        {
+            push_eph(prn, 100);
+        }
+    // the ring is full: nothing is discarded, and a newer product of the
+    // same type and satellite replaces the pending one
+    push_eph(5, 100);
+    push_eph(1, 200);
+    auto iono = std::make_shared<Gps_Iono>();
+    iono->alpha0 = 1.0;
+    channel.push(Gnss_Nav_Product(iono));
+    push_eph(5, 300);
+    iono = std::make_shared<Gps_Iono>();
+    iono->alpha0 = 2.0;
+    channel.push(Gnss_Nav_Product(iono));
+    EXPECT_EQ(channel.replaced(), 2U);
+
+    // the products in the ring, then the ones kept while it was full
+    const std::vector<std::pair<uint32_t, int32_t>> expected{{1, 100}, {2, 100}, {3, 100}, {4, 100}, {5, 300}, {1, 200}};
+    Gnss_Nav_Product product;
+    for (const auto& eph : expected)
+        {
+            ASSERT_TRUE(channel.pop(product));
+            ASSERT_EQ(product.type(), NAV_GPS_EPHEMERIS);
+            EXPECT_EQ(product.prn(), eph.first);
+            EXPECT_EQ(product.get<Gps_Ephemeris>()->toe, eph.second);
+        }
+    ASSERT_TRUE(channel.pop(product));
+    ASSERT_EQ(product.type(), NAV_GPS_IONO);
+    EXPECT_EQ(product.prn(), 0U);
+    EXPECT_DOUBLE_EQ(product.get<Gps_Iono>()->alpha0, 2.0);
+    EXPECT_FALSE(channel.pop(product));
+
+    // and the ring is used again
+    push_eph(6, 100);
+    ASSERT_TRUE(channel.pop(product));
+    EXPECT_EQ(product.prn(), 6U);
+    EXPECT_FALSE(channel.pop(product));
+}
+
+
+TEST(GnssNavProductChannelTest, ConcurrentProducer)
+{
+    Gnss_Nav_Product_Channel channel(8);
+    const uint32_t n_products = 20000;
+    std::thread producer([&channel]() {
+        for (uint32_t prn = 0; prn < n_products; prn++)
+            {
+                auto eph = std::make_shared<Gps_Ephemeris>();
+                eph->PRN = prn;
+                channel.push(Gnss_Nav_Product(eph));
+            }
+    });
+    uint32_t expected = 0;
+    Gnss_Nav_Product product;
+    while (expected < n_products)
+        {
+            if (channel.pop(product))
+                {
+                    ASSERT_EQ(product.get<Gps_Ephemeris>()->PRN, expected);
+                    expected++;
+                }
+        }
+    producer.join();
+    EXPECT_FALSE(channel.pop(product));
+}
@@ -0,0 +1,127 @@
+/*!
+ * \file gnss_navigation_state_test.cc
+ * \brief Tests of the navigation state published by PVT for the tracking
+ * channels
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_navigation_state.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+
+TEST(GnssNavigationStateTest, PublishAndRead)
+{
+    auto state = Gnss_Navigation_State::get();
+    EXPECT_FALSE(state->has_readers());
+    Gnss_Navigation_State_Reader reader;
+    EXPECT_TRUE(state->has_readers());
+    EXPECT_EQ(Gnss_Navigation_State::get(), state);
+
+    Gnss_Receiver_State receiver;
+    Gnss_Channel_Assistance assistance;
+    EXPECT_FALSE(reader.next(3, receiver, assistance));
+
+    Gnss_Receiver_State rx;
+    rx.pos_ecef_m = {1.0, 2.0, 3.0};
+    rx.vel_ecef_m_s = {4.0, 5.0, 6.0};
+    rx.clock_offset_s = 1e-3;
+    rx.sample_counter = 123456;
+    state->begin_epoch();
+    state->set_receiver(rx);
+    state->set_channel(3, Gnss_Channel_Assistance{-250.5, 7, 'G'});
+    state->set_channel(Gnss_Navigation_State::max_channels, Gnss_Channel_Assistance{});  // ignored
+    state->end_epoch();
+
+    ASSERT_TRUE(reader.next(3, receiver, assistance));
+    EXPECT_DOUBLE_EQ(receiver.pos_ecef_m[2], 3.0);
+    EXPECT_DOUBLE_EQ(receiver.vel_ecef_m_s[0], 4.0);
+    EXPECT_DOUBLE_EQ(receiver.clock_offset_s, 1e-3);
+    EXPECT_EQ(receiver.sample_counter, 123456U);
+    EXPECT_DOUBLE_EQ(assistance.pseudorange_rate_m_s, -250.5);
+    EXPECT_EQ(assistance.PRN, 7U);
+    EXPECT_EQ(assistance.System, 'G');
+
+    // the same epoch is read once
+    EXPECT_FALSE(reader.next(3, receiver, assistance));
+
+    // a channel not set in the last epoch has no assistance
+    state->begin_epoch();
+    state->set_receiver(rx);
+    state->set_channel(4, Gnss_Channel_Assistance{10.0, 8, 'E'});
+    state->end_epoch();
+    EXPECT_FALSE(reader.next(3, receiver, assistance));
+    Gnss_Navigation_State_Reader reader2;
+    ASSERT_TRUE(reader2.next(4, receiver, assistance));
+    EXPECT_EQ(assistance.System, 'E');
+}
+
+
+TEST(GnssNavigationStateTest, ConsistentEpochs)
+{
+    auto state = Gnss_Navigation_State::get();
+    const uint32_t nchannels = 60;
+    const int epochs = 20000;
+    std::atomic<bool> done{false};
+    std::atomic<int> inconsistent{0};
+    std::atomic<int> reads{0};
+    std::vector<std::thread> readers;
+    for (uint32_t ch = 0; ch < 4; ch++)
+        {
+            readers.emplace_back([&, ch] {
+                Gnss_Navigation_State_Reader reader;
+                Gnss_Receiver_State receiver;
+                Gnss_Channel_Assistance assistance;
+                while (!done.load())
+                    {
+                        if (reader.next(ch * 15, receiver, assistance))
+                            {
+                                // all the fields of an epoch are written with the same value
+                                const auto value = static_cast<double>(receiver.sample_counter);
+                                if (receiver.pos_ecef_m[0] != value or receiver.vel_ecef_m_s[2] != value or
+                                    assistance.pseudorange_rate_m_s != value + ch * 15 or assistance.PRN != receiver.sample_counter % 32)
+                                    {
+                                        inconsistent++;
+                                    }
+                                reads++;
+                            }
+                    }
+            });
+        }
+
+    for (int epoch = 1; epoch <= epochs; epoch++)
+        {
+            Gnss_Receiver_State rx;
+            const auto value = static_cast<double>(epoch);
+            rx.pos_ecef_m = {value, value, value};
+            rx.vel_ecef_m_s = {value, value, value};
+            rx.sample_counter = epoch;
+            state->begin_epoch();
+            state->set_receiver(rx);
+            for (uint32_t ch = 0; ch < nchannels; ch++)
+                {
+                    state->set_channel(ch, Gnss_Channel_Assistance{value + ch, static_cast<uint32_t>(epoch % 32), 'G'});
+                }
+            state->end_epoch();
+        }
+    done = true;
+    for (auto& t : readers)
+        {
+            t.join();
+        }
+    EXPECT_EQ(inconsistent.load(), 0);
+    EXPECT_GT(reads.load(), 0);
+}
@@ -0,0 +1,55 @@
+/*!
+ * \file gnss_pipeline_latency_test.cc
+ * \brief Tests of the latency measured from the samples to the PVT solutions
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_pipeline_latency.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <string>
+
+
+TEST(GnssPipelineLatencyTest, ElapsedFromSampleCounter)
+{
+    Gnss_Pipeline_Latency latency;
+    double latency_ms = 0.0;
+    const auto t0 = std::chrono::steady_clock::now();
+    EXPECT_FALSE(latency.elapsed_ms(0, latency_ms, t0));
+
+    // 4 Msps: sample 4000000 arrives at t0, so sample 3996000 arrived 1 ms before
+    latency.set_sample_time(4000000, 4e6, t0);
+    ASSERT_TRUE(latency.elapsed_ms(3996000, latency_ms, t0 + std::chrono::milliseconds(5)));
+    EXPECT_NEAR(latency_ms, 6.0, 1e-6);
+    ASSERT_TRUE(latency.elapsed_ms(4000000, latency_ms, t0 + std::chrono::milliseconds(5)));
+    EXPECT_NEAR(latency_ms, 5.0, 1e-6);
+}
+
+
+TEST(GnssPipelineLatencyTest, Histogram)
+{
+    Gnss_Pipeline_Latency latency;
+    latency.record(0.5);
+    latency.record(7.0);
+    latency.record(7.5);
+    latency.record(2000.0);
+    EXPECT_EQ(latency.count(), 4U);
+    EXPECT_DOUBLE_EQ(latency.max_ms(), 2000.0);
+
+    const std::string report = latency.report();
+    EXPECT_NE(report.find("gnss_sdr_pvt_latency_ms_bucket{le=\"1\"} 1\n"), std::string::npos);
+    EXPECT_NE(report.find("gnss_sdr_pvt_latency_ms_bucket{le=\"5\"} 1\n"), std::string::npos);
+    EXPECT_NE(report.find("gnss_sdr_pvt_latency_ms_bucket{le=\"10\"} 3\n"), std::string::npos);
+    EXPECT_NE(report.find("gnss_sdr_pvt_latency_ms_bucket{le=\"1000\"} 3\n"), std::string::npos);
+    EXPECT_NE(report.find("gnss_sdr_pvt_latency_ms_bucket{le=\"+Inf\"} 4\n"), std::string::npos);
+    EXPECT_NE(report.find("gnss_sdr_pvt_latency_ms_count 4\n"), std::string::npos);
+}
@@ -0,0 +1,72 @@
+/*!
+ * \file gnss_replica_cache_test.cc
+ * \brief Tests of the cache of local code replicas shared by the channels
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_replica_cache.h"
+#include "gps_sdr_signal_replica.h"
+#include <gtest/gtest.h>
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+
+TEST(GnssReplicaCacheTest, SameReplicaIsShared)
+{
+    Gnss_Replica_Cache& cache = Gnss_Replica_Cache::get();
+    cache.clear();
+    int generated = 0;
+    const auto count_and_generate = [&generated](own::span<std::complex<float>> code) {
+        generated++;
+        gps_l1_ca_code_gen_complex_sampled(code, 7, 4000000, 0);
+    };
+    const auto first = cache.get_complex("GPS 1C", 7, 4e6, "sampled", 4000, count_and_generate);
+    const auto second = cache.get_complex("GPS 1C", 7, 4e6, "sampled", 4000, count_and_generate);
+    EXPECT_EQ(generated, 1);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(cache.size(), 1U);
+
+    // the same as generated by each channel
+    std::vector<std::complex<float>> code(4000);
+    gps_l1_ca_code_gen_complex_sampled(code, 7, 4000000, 0);
+    ASSERT_EQ(first->size(), code.size());
+    for (size_t i = 0; i < code.size(); i++)
+        {
+            EXPECT_EQ((*first)[i], code[i]);
+        }
+
+    // any difference in the key is another replica
+    cache.get_complex("GPS 1C", 8, 4e6, "sampled", 4000, count_and_generate);
+    cache.get_complex("GPS 1C", 7, 8e6, "sampled", 4000, count_and_generate);
+    cache.get_complex("GPS 1C", 7, 4e6, "sampled", 8000, count_and_generate);
+    EXPECT_EQ(generated, 4);
+    EXPECT_EQ(cache.size(), 4U);
+
+    // replicas in use survive clear()
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0U);
+    EXPECT_EQ((*first)[0], code[0]);
+}
+
+
+TEST(GnssReplicaCacheTest, ZeroPadded)
+{
+    Gnss_Replica_Cache& cache = Gnss_Replica_Cache::get();
+    const auto code = cache.get_float("GPS 1C", 3, 0.0, "chips", 2046,
+        [](own::span<float> replica) { gps_l1_ca_code_gen_float(replica, 3, 0); });
+    ASSERT_EQ(code->size(), 2046U);
+    EXPECT_EQ(std::abs((*code)[0]), 1.0F);
+    EXPECT_EQ((*code)[1023], 0.0F);
+    EXPECT_EQ((*code)[2045], 0.0F);
+    cache.clear();
+}
@@ -0,0 +1,156 @@
+/*!
+ * \file gnss_sample_clock_test.cc
+ * \brief  This file implements unit tests for the receiver clock shared by
+ * the sample counter and the observables block
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sample_clock.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+
+TEST(GnssSampleClockTest, KeepsTheLastEpochs)
+{
+    Gnss_Sample_Clock clock;
+    uint64_t sample = 0;
+    EXPECT_EQ(clock.epochs(), 0U);
+    EXPECT_FALSE(clock.epoch_sample(0, sample));
+
+    for (uint64_t epoch = 0; epoch < Gnss_Sample_Clock::capacity + 10; epoch++)
+        {
+            clock.publish((epoch + 1) * 80000);
+        }
+    EXPECT_EQ(clock.epochs(), Gnss_Sample_Clock::capacity + 10);
+
+    // the oldest epochs have been overwritten
+    EXPECT_FALSE(clock.epoch_sample(9, sample));
+    ASSERT_TRUE(clock.epoch_sample(10, sample));
+    EXPECT_EQ(sample, 11U * 80000);
+    ASSERT_TRUE(clock.epoch_sample(Gnss_Sample_Clock::capacity + 9, sample));
+    EXPECT_EQ(sample, (Gnss_Sample_Clock::capacity + 10) * 80000);
+    EXPECT_FALSE(clock.epoch_sample(Gnss_Sample_Clock::capacity + 10, sample));
+}
+
+
+TEST(GnssSampleClockTest, WaitsForTheNextEpoch)
+{
+    Gnss_Sample_Clock clock;
+    EXPECT_FALSE(clock.wait_for_epochs(0, std::chrono::milliseconds(1)));
+
+    std::thread counter([&clock] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        clock.publish(4000);
+    });
+    EXPECT_TRUE(clock.wait_for_epochs(0, std::chrono::milliseconds(5000)));
+    counter.join();
+    uint64_t sample = 0;
+    ASSERT_TRUE(clock.epoch_sample(0, sample));
+    EXPECT_EQ(sample, 4000U);
+
+    // already there
+    EXPECT_TRUE(clock.wait_for_epochs(0, std::chrono::milliseconds(0)));
+}
+
+
+TEST(GnssSampleClockTest, ThrottledPublisherWaitsForTheReader)
+{
+    Gnss_Sample_Clock clock;
+    clock.set_throttle(true);
+    EXPECT_TRUE(clock.throttled());
+    clock.set_read_epochs(0);
+    for (uint64_t epoch = 0; epoch < Gnss_Sample_Clock::capacity; epoch++)
+        {
+            clock.publish(epoch);
+        }
+
+    std::atomic<bool> published{false};
+    std::thread counter([&clock, &published] {
+        clock.publish(Gnss_Sample_Clock::capacity);
+        published = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(published);
+    EXPECT_EQ(clock.epochs(), Gnss_Sample_Clock::capacity);
+    clock.set_read_epochs(1);
+    counter.join();
+    EXPECT_TRUE(published);
+    EXPECT_EQ(clock.epochs(), Gnss_Sample_Clock::capacity + 1);
+
+    // nothing has been overwritten before it was read
+    uint64_t sample = 0;
+    ASSERT_TRUE(clock.epoch_sample(1, sample));
+    EXPECT_EQ(sample, 1U);
+    EXPECT_EQ(clock.skipped_epochs(), 0U);
+}
+
+
+TEST(GnssSampleClockTest, ThrottledPublisherStopsWaitingForAStalledReader)
+{
+    Gnss_Sample_Clock clock;
+    clock.set_throttle(true);
+    for (uint64_t epoch = 0; epoch < Gnss_Sample_Clock::capacity; epoch++)
+        {
+            clock.publish(epoch);
+        }
+    const auto start = std::chrono::steady_clock::now();
+    for (uint64_t epoch = Gnss_Sample_Clock::capacity; epoch < Gnss_Sample_Clock::capacity + 10; epoch++)
+        {
+            clock.publish(epoch);
+        }
+    const auto waited = std::chrono::steady_clock::now() - start;
+    // a single timeout, then the epochs are overwritten until the reader reads again
+    EXPECT_GE(waited, Gnss_Sample_Clock::throttle_timeout);
+    EXPECT_LT(waited, 5 * Gnss_Sample_Clock::throttle_timeout);
+    EXPECT_EQ(clock.epochs(), Gnss_Sample_Clock::capacity + 10);
+
+    // the reader counts the epochs it lost
+    clock.add_skipped_epochs(10);
+    EXPECT_EQ(clock.skipped_epochs(), 10U);
+}
+
+
+TEST(GnssSampleClockTest, DeliversTheTimeTagsOfEachEpoch)
+{
+    Gnss_Sample_Clock clock;
+    Gnss_Time_Tag_Reader reader;
+    reader.attach(clock.time_tags());
+
+    GnssTime time{};
+    time.tow_ms = 1000;
+    clock.time_tags()->push(1, time);
+    clock.publish(4000);
+    clock.publish(8000);
+
+    GnssTime read_time{};
+    EXPECT_FALSE(reader.next(0, 1, read_time));
+    ASSERT_TRUE(reader.next(1, 2, read_time));
+    EXPECT_EQ(read_time.tow_ms, 1000);
+    EXPECT_FALSE(reader.next(1, 2, read_time));
+}
+
+
+TEST(GnssSampleClockTest, GlobalInstance)
+{
+    auto clock = std::make_shared<Gnss_Sample_Clock>();
+    Gnss_Sample_Clock::set_global_instance(clock);
+    EXPECT_EQ(Gnss_Sample_Clock::global_instance(), clock);
+    Gnss_Sample_Clock::set_global_instance(nullptr);
+    // a new one is created for the blocks that run without a flow graph
+    EXPECT_NE(Gnss_Sample_Clock::global_instance(), nullptr);
+    EXPECT_NE(Gnss_Sample_Clock::global_instance(), clock);
+    Gnss_Sample_Clock::set_global_instance(nullptr);
+}
@@ -0,0 +1,159 @@
+/*!
+ * \file gnss_shm_ring_test.cc
+ * \brief  This file implements unit tests for the shared memory ring
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_shm_ring.h"
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+
+
+namespace
+{
+struct Shm_Ring_Test_Record
+{
+    uint64_t index;
+    double values[7];
+};
+
+std::string shm_ring_test_name()
+{
+    return "/gnss-sdr-shm-ring-test-" + std::to_string(getpid());
+}
+}  // namespace
+
+
+TEST(GnssShmRingTest, ReadsPublishedRecords)
+{
+    Gnss_Shm_Ring_Writer writer(shm_ring_test_name(), 7, sizeof(Shm_Ring_Test_Record), 16);
+    ASSERT_TRUE(writer.is_open()) << writer.error();
+
+    Gnss_Shm_Ring_Reader reader(shm_ring_test_name());
+    ASSERT_TRUE(reader.is_open()) << reader.error();
+    EXPECT_EQ(reader.record_type(), 7U);
+    EXPECT_EQ(reader.record_size(), sizeof(Shm_Ring_Test_Record));
+
+    Shm_Ring_Test_Record record{};
+    EXPECT_FALSE(reader.read(&record));
+
+    for (uint64_t i = 0; i < 10; i++)
+        {
+            record.index = i;
+            record.values[6] = static_cast<double>(i) / 2.0;
+            writer.publish(&record);
+        }
+    EXPECT_EQ(writer.published(), 10U);
+
+    for (uint64_t i = 0; i < 10; i++)
+        {
+            ASSERT_TRUE(reader.read(&record));
+            EXPECT_EQ(record.index, i);
+            EXPECT_DOUBLE_EQ(record.values[6], static_cast<double>(i) / 2.0);
+        }
+    EXPECT_FALSE(reader.read(&record));
+    EXPECT_EQ(reader.lost(), 0U);
+    EXPECT_FALSE(reader.writer_closed());
+}
+
+
+TEST(GnssShmRingTest, SlowReaderLosesOldestRecords)
+{
+    auto writer = std::make_unique<Gnss_Shm_Ring_Writer>(shm_ring_test_name(), 0, sizeof(Shm_Ring_Test_Record), 8);
+    ASSERT_TRUE(writer->is_open()) << writer->error();
+    Gnss_Shm_Ring_Reader reader(shm_ring_test_name());
+    ASSERT_TRUE(reader.is_open()) << reader.error();
+
+    Shm_Ring_Test_Record record{};
+    for (uint64_t i = 0; i < 20; i++)
+        {
+            record.index = i;
+            writer->publish(&record);
+        }
+
+    // Only the last 8 records are still in the ring
+    for (uint64_t i = 12; i < 20; i++)
+        {
+            ASSERT_TRUE(reader.read(&record));
+            EXPECT_EQ(record.index, i);
+        }
+    EXPECT_FALSE(reader.read(&record));
+    EXPECT_EQ(reader.lost(), 12U);
+
+    Gnss_Shm_Ring_Reader late_reader(shm_ring_test_name(), true);
+    ASSERT_TRUE(late_reader.read(&record));
+    EXPECT_EQ(record.index, 12U);
+
+    writer.reset();
+    EXPECT_TRUE(reader.writer_closed());
+    Gnss_Shm_Ring_Reader no_reader(shm_ring_test_name());
+    EXPECT_FALSE(no_reader.is_open());
+}
+
+
+TEST(GnssShmRingTest, ConcurrentReaderGetsConsistentRecords)
+{
+    Gnss_Shm_Ring_Writer writer(shm_ring_test_name(), 0, sizeof(Shm_Ring_Test_Record), 4);
+    ASSERT_TRUE(writer.is_open()) << writer.error();
+    Gnss_Shm_Ring_Reader reader(shm_ring_test_name());
+    ASSERT_TRUE(reader.is_open()) << reader.error();
+
+    const uint64_t n_records = 200000;
+    std::atomic<bool> done{false};
+    std::thread producer([&]() {
+        Shm_Ring_Test_Record record{};
+        for (uint64_t i = 0; i < n_records; i++)
+            {
+                record.index = i;
+                for (double& value : record.values)
+                    {
+                        value = static_cast<double>(i);
+                    }
+                writer.publish(&record);
+            }
+        done = true;
+    });
+
+    uint64_t received = 0;
+    uint64_t last_index = 0;
+    bool inconsistent = false;
+    Shm_Ring_Test_Record record{};
+    while (true)
+        {
+            const bool finished = done;
+            if (!reader.read(&record))
+                {
+                    if (finished)
+                        {
+                            break;
+                        }
+                    continue;
+                }
+            for (const double value : record.values)
+                {
+                    inconsistent |= (value != static_cast<double>(record.index));
+                }
+            inconsistent |= (received > 0 and record.index <= last_index);
+            last_index = record.index;
+            received++;
+        }
+    producer.join();
+
+    EXPECT_FALSE(inconsistent);
+    EXPECT_GT(received, 0U);
+    EXPECT_LE(received + reader.lost(), n_records);
+}
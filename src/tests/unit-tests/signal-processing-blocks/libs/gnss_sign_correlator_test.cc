@@ -0,0 +1,125 @@
+/*!
+ * \file gnss_sign_correlator_test.cc
+ * \brief  This file implements unit tests for the correlation of symbol signs
+ * with a preamble or a secondary code
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sign_correlator.h"
+#include <boost/circular_buffer.hpp>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace
+{
+// The correlation as computed by the trackers and telemetry decoders on
+// their circular buffers of symbols
+int32_t sign_correlator_test_reference(const boost::circular_buffer<float>& history, const std::vector<int32_t>& pattern)
+{
+    int32_t corr_value = 0;
+    for (size_t i = 0; i < pattern.size(); i++)
+        {
+            if (history[i] < 0.0)
+                {
+                    corr_value -= pattern[i];
+                }
+            else
+                {
+                    corr_value += pattern[i];
+                }
+        }
+    return corr_value;
+}
+}  // namespace
+
+
+TEST(GnssSignCorrelatorTest, MatchesScalarCorrelation)
+{
+    std::default_random_engine generator(17);
+    std::normal_distribution<float> symbol_dist(0.0, 1.0);
+    std::bernoulli_distribution bit_dist(0.5);
+    // windows within a word, of exactly one word, and across several words
+    const std::vector<std::pair<size_t, size_t>> lengths = {{8, 0}, {10, 300}, {20, 20}, {25, 25}, {64, 64}, {100, 0}, {11, 310}, {16, 128}};
+    for (const auto& length : lengths)
+        {
+            std::vector<int32_t> pattern(length.first);
+            for (auto& p : pattern)
+                {
+                    p = bit_dist(generator) ? 1 : -1;
+                }
+            Gnss_Sign_Correlator correlator(pattern, length.second);
+            const size_t window = std::max(length.first, length.second);
+            EXPECT_EQ(correlator.window_length(), window);
+            EXPECT_EQ(correlator.pattern_length(), length.first);
+            boost::circular_buffer<float> history(window);
+            for (size_t n = 0; n < 3 * window + 5; n++)
+                {
+                    const float symbol = (n % 13 == 0) ? 0.0F : symbol_dist(generator);
+                    history.push_back(symbol);
+                    correlator.push(symbol);
+                    EXPECT_EQ(correlator.size(), history.size());
+                    EXPECT_EQ(correlator.full(), history.full());
+                    if (history.full())
+                        {
+                            EXPECT_EQ(correlator.correlation(), sign_correlator_test_reference(history, pattern)) << "pattern " << length.first << ", window " << window << ", symbol " << n;
+                        }
+                }
+            correlator.clear();
+            history.clear();
+            EXPECT_EQ(correlator.size(), 0U);
+            for (size_t n = 0; n < window; n++)
+                {
+                    const float symbol = symbol_dist(generator);
+                    history.push_back(symbol);
+                    correlator.push(symbol);
+                }
+            EXPECT_EQ(correlator.correlation(), sign_correlator_test_reference(history, pattern));
+        }
+}
+
+
+TEST(GnssSignCorrelatorTest, DetectsCode)
+{
+    // GPS L5 Neuman-Hofman code of the data component
+    const std::string code("0000110101");
+    Gnss_Sign_Correlator correlator = Gnss_Sign_Correlator::from_string(code);
+    ASSERT_EQ(correlator.window_length(), code.size());
+    for (int repetition = 0; repetition < 2; repetition++)
+        {
+            for (size_t offset = 0; offset < code.size(); offset++)
+                {
+                    correlator.clear();
+                    for (size_t i = 0; i < code.size(); i++)
+                        {
+                            const char bit = code[(i + offset) % code.size()];
+                            const float symbol = (bit == '1') ? 0.5F : -0.5F;
+                            correlator.push(repetition == 0 ? symbol : -symbol);
+                        }
+                    if (offset == 0)
+                        {
+                            EXPECT_EQ(correlator.correlation(), repetition == 0 ? 10 : -10);
+                        }
+                    else
+                        {
+                            EXPECT_LT(std::abs(correlator.correlation()), 10) << "offset " << offset;
+                        }
+                }
+        }
+}
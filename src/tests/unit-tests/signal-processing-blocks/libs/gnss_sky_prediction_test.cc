@@ -0,0 +1,110 @@
+/*!
+ * \file gnss_sky_prediction_test.cc
+ * \brief Tests of the satellite predictions published by the control thread
+ * for the acquisition scheduler
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sky_prediction.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+
+TEST(GnssSkyPredictionTest, PublishAndPredict)
+{
+    auto prediction = Gnss_Sky_Prediction::get();
+    EXPECT_EQ(Gnss_Sky_Prediction::get(), prediction);
+
+    std::vector<Gnss_Sky_Satellite> satellites(3);
+    satellites[0] = Gnss_Sky_Satellite{35.0, 120.0, -1500.0, 0.5, 7, 'G'};
+    satellites[1] = Gnss_Sky_Satellite{70.0, 10.0, 250.0, -0.2, 11, 'E'};
+    satellites[2] = Gnss_Sky_Satellite{-5.0, 300.0, 3000.0, 0.1, 12, 'G'};
+    prediction->publish(satellites, 345600.0);
+
+    Gnss_Sky_Satellite satellite;
+    ASSERT_TRUE(prediction->predict('G', 7, satellite));
+    EXPECT_DOUBLE_EQ(satellite.elevation_deg, 35.0);
+    EXPECT_DOUBLE_EQ(satellite.azimuth_deg, 120.0);
+    EXPECT_DOUBLE_EQ(satellite.doppler_hz, -1500.0);
+    EXPECT_DOUBLE_EQ(satellite.doppler_rate_hz_s, 0.5);
+    EXPECT_EQ(satellite.PRN, 7U);
+    EXPECT_EQ(satellite.System, 'G');
+    EXPECT_FALSE(prediction->predict('E', 7, satellite));
+    EXPECT_FALSE(prediction->predict('G', 0, satellite));
+    EXPECT_FALSE(prediction->predict('R', 7, satellite));
+
+    // above the horizon, the highest first
+    std::vector<Gnss_Sky_Satellite> visible;
+    EXPECT_DOUBLE_EQ(prediction->visible(visible), 345600.0);
+    ASSERT_EQ(visible.size(), 2U);
+    EXPECT_EQ(visible[0].System, 'E');
+    EXPECT_EQ(visible[0].PRN, 11U);
+    EXPECT_EQ(visible[1].PRN, 7U);
+
+    // a satellite not in the last table has no prediction
+    prediction->publish(std::vector<Gnss_Sky_Satellite>(1, satellites[1]), 345601.0);
+    EXPECT_FALSE(prediction->predict('G', 7, satellite));
+    EXPECT_TRUE(prediction->predict('E', 11, satellite));
+    prediction->publish({}, 0.0);
+    EXPECT_FALSE(prediction->predict('E', 11, satellite));
+}
+
+
+TEST(GnssSkyPredictionTest, ConsistentTables)
+{
+    auto prediction = Gnss_Sky_Prediction::get();
+    const int tables = 20000;
+    std::atomic<bool> done{false};
+    std::atomic<int> inconsistent{0};
+
+    // in table n, all the fields of all the satellites are n
+    std::thread reader([&]() {
+        std::vector<Gnss_Sky_Satellite> visible;
+        while (!done.load())
+            {
+                const double time_s = prediction->visible(visible);
+                for (const auto& satellite : visible)
+                    {
+                        if (satellite.elevation_deg != time_s or satellite.doppler_hz != time_s or satellite.doppler_rate_hz_s != time_s)
+                            {
+                                inconsistent++;
+                            }
+                    }
+            }
+    });
+    std::vector<Gnss_Sky_Satellite> satellites;
+    for (uint32_t PRN = 1; PRN <= 32; PRN++)
+        {
+            satellites.push_back(Gnss_Sky_Satellite{0.0, 0.0, 0.0, 0.0, PRN, 'G'});
+            satellites.push_back(Gnss_Sky_Satellite{0.0, 0.0, 0.0, 0.0, PRN, 'C'});
+        }
+    for (int n = 1; n <= tables; n++)
+        {
+            for (auto& satellite : satellites)
+                {
+                    satellite.elevation_deg = n;
+                    satellite.doppler_hz = n;
+                    satellite.doppler_rate_hz_s = n;
+                }
+            prediction->publish(satellites, n);
+        }
+    done = true;
+    reader.join();
+    EXPECT_EQ(inconsistent.load(), 0);
+    std::vector<Gnss_Sky_Satellite> visible;
+    EXPECT_DOUBLE_EQ(prediction->visible(visible), tables);
+    EXPECT_EQ(visible.size(), satellites.size());
+}
@@ -0,0 +1,151 @@
+/*!
+ * \file gnss_spectral_monitor_test.cc
+ * \brief Tests the Welch power spectral density shared by the input stages
+ * of an RF channel, its decimation and its Prometheus export.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "MATH_CONSTANTS.h"
+#include "gnss_spectral_monitor.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+// Noise of power 2, plus a tone of amplitude 3 at tone_bin bins of an FFT of fft_length
+std::vector<gr_complex> spectral_monitor_test_signal(int n, int fft_length, int tone_bin)
+{
+    std::vector<gr_complex> signal(n);
+    std::mt19937 generator(5);
+    std::normal_distribution<float> noise(0.0, 1.0);
+    for (int k = 0; k < n; k++)
+        {
+            const double phase = TWO_PI * static_cast<double>(tone_bin) * static_cast<double>(k) / static_cast<double>(fft_length);
+            signal[k] = gr_complex(noise(generator), noise(generator)) + std::polar(3.0F, static_cast<float>(phase));
+        }
+    return signal;
+}
+}  // namespace
+
+
+TEST(GnssSpectralMonitorTest, NoiseFloorAndTone)
+{
+    const int fft_length = 256;
+    const int averages = 64;
+    const double fs = 4e6;
+    const std::vector<gr_complex> signal = spectral_monitor_test_signal(fft_length * averages, fft_length, 40);
+    Gnss_Spectral_Monitor monitor(fft_length, 1, averages, fs);
+    Gnss_Spectral_Estimate estimate;
+    EXPECT_FALSE(monitor.estimate(estimate));
+
+    // in pieces that do not match the segments, analyzed before the queue is full
+    for (int k = 0; k < static_cast<int>(signal.size()); k += 300)
+        {
+            monitor.push(&signal[k], std::min(300, static_cast<int>(signal.size()) - k));
+            monitor.process_pending();
+        }
+    ASSERT_TRUE(monitor.estimate(estimate));
+    EXPECT_EQ(estimate.sequence, 1U);
+    EXPECT_EQ(monitor.sequence(), 1U);
+    ASSERT_EQ(estimate.psd.size(), static_cast<size_t>(fft_length));
+    EXPECT_NEAR(estimate.noise_variance, 2.0, 0.1);
+    EXPECT_NEAR(estimate.total_power, 11.0, 0.3);
+    EXPECT_FLOAT_EQ(estimate.peak_offset_hz, static_cast<float>(40.0 * fs / fft_length));
+    EXPECT_GT(estimate.peak_to_floor_db, 25.0);
+    // the tone and the side bins of the Hann window
+    EXPECT_EQ(estimate.interference_bins, 3U);
+    EXPECT_EQ(monitor.dropped_segments(), 0U);
+}
+
+
+TEST(GnssSpectralMonitorTest, DecimationAndDrops)
+{
+    const int fft_length = 64;
+    const std::vector<gr_complex> signal = spectral_monitor_test_signal(16 * fft_length, fft_length, 0);
+    // one segment out of 4, and up to 2 segments queued
+    Gnss_Spectral_Monitor monitor(fft_length, 4, 1, 1e6, 10.0, 2);
+    monitor.push(signal.data(), static_cast<int>(signal.size()));
+    // segments 0 and 4 are queued, 8 and 12 are dropped
+    EXPECT_EQ(monitor.dropped_segments(), 2U);
+    monitor.process_pending();
+    EXPECT_EQ(monitor.sequence(), 2U);
+    // processed in time
+    for (int k = 0; k < 16; k += 4)
+        {
+            monitor.push(&signal[k * fft_length], 4 * fft_length);
+            monitor.process_pending();
+        }
+    EXPECT_EQ(monitor.sequence(), 6U);
+    EXPECT_EQ(monitor.dropped_segments(), 2U);
+
+    EXPECT_THROW(Gnss_Spectral_Monitor(4, 1, 1, 1e6), std::invalid_argument);
+    EXPECT_THROW(Gnss_Spectral_Monitor(64, 0, 1, 1e6), std::invalid_argument);
+}
+
+
+TEST(GnssSpectralMonitorTest, Thread)
+{
+    const int fft_length = 128;
+    const int n_segments = 200;
+    const std::vector<gr_complex> signal = spectral_monitor_test_signal(n_segments * fft_length, fft_length, 10);
+    Gnss_Spectral_Monitor monitor(fft_length, 1, 1, 1e6);
+    monitor.start();
+    for (int k = 0; k < n_segments; k++)
+        {
+            monitor.push(&signal[k * fft_length], fft_length);
+        }
+    monitor.stop();
+    monitor.process_pending();
+    // each segment is either analyzed or dropped
+    EXPECT_EQ(monitor.sequence() + monitor.dropped_segments(), static_cast<uint64_t>(n_segments));
+    EXPECT_GT(monitor.sequence(), 0U);
+}
+
+
+TEST(GnssSpectralMonitorTest, InstancesAndReport)
+{
+    EXPECT_EQ(Gnss_Spectral_Monitor::rf_channel("InputFilter"), 0U);
+    EXPECT_EQ(Gnss_Spectral_Monitor::rf_channel("InputFilter1"), 1U);
+    EXPECT_EQ(Gnss_Spectral_Monitor::rf_channel("DataTypeAdapter12"), 12U);
+
+    const int fft_length = 256;
+    const std::vector<gr_complex> signal = spectral_monitor_test_signal(fft_length * 16, fft_length, -40);
+    auto monitor = std::make_shared<Gnss_Spectral_Monitor>(fft_length, 1, 16, 4e6);
+    Gnss_Spectral_Monitor::set_instance(3, monitor);
+    EXPECT_EQ(Gnss_Spectral_Monitor::instance(3), monitor);
+    EXPECT_EQ(Gnss_Spectral_Monitor::instance(4), nullptr);
+    // no estimate yet
+    EXPECT_EQ(Gnss_Spectral_Monitor::report_all(8).find("rf_channel"), std::string::npos);
+
+    for (int k = 0; k < 16; k++)
+        {
+            monitor->push(&signal[k * fft_length], fft_length);
+            monitor->process_pending();
+        }
+    const std::string report = Gnss_Spectral_Monitor::report_all(8);
+    EXPECT_NE(report.find("# TYPE gnss_sdr_spectral_noise_floor_db gauge\ngnss_sdr_spectral_noise_floor_db{rf_channel=\"3\"} 3"), std::string::npos);
+    EXPECT_NE(report.find("gnss_sdr_spectral_interference_bins{rf_channel=\"3\"} 3\n"), std::string::npos);
+    EXPECT_NE(report.find("gnss_sdr_spectral_peak_offset_hz{rf_channel=\"3\"} -625000\n"), std::string::npos);
+    EXPECT_NE(report.find("gnss_sdr_spectral_psd_db{rf_channel=\"3\",offset_hz=\"-1757812\"}"), std::string::npos);
+
+    Gnss_Spectral_Monitor::clear_instances();
+    EXPECT_EQ(Gnss_Spectral_Monitor::instance(3), nullptr);
+    EXPECT_TRUE(Gnss_Spectral_Monitor::report_all(8).empty());
+}
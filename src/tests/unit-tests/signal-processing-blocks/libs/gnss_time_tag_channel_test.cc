@@ -0,0 +1,108 @@
+/*!
+ * \file gnss_time_tag_channel_test.cc
+ * \brief  Tests of the propagation of time tags between processing blocks
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_time_tag_channel.h"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <memory>
+
+
+namespace
+{
+GnssTime make_timetag(int tow_ms)
+{
+    GnssTime t{};
+    t.week = 2200;
+    t.tow_ms = tow_ms;
+    t.tow_ms_fraction = 0.25;
+    t.rx_time = 1.5;
+    return t;
+}
+}  // namespace
+
+
+TEST(GnssTimeTagChannelTest, SameChannelForTheSameStream)
+{
+    const int stream_a = 0;
+    const int stream_b = 0;
+    auto a = Gnss_Time_Tag_Channel::get(&stream_a);
+    EXPECT_EQ(a, Gnss_Time_Tag_Channel::get(&stream_a));
+    EXPECT_NE(a, Gnss_Time_Tag_Channel::get(&stream_b));
+}
+
+
+TEST(GnssTimeTagChannelTest, ReadersGetTheTagsOfTheirRange)
+{
+    const int stream = 0;
+    auto channel = Gnss_Time_Tag_Channel::get(&stream);
+    Gnss_Time_Tag_Reader reader1;
+    Gnss_Time_Tag_Reader reader2;
+    GnssTime t{};
+    EXPECT_FALSE(reader1.attached());
+    EXPECT_FALSE(reader1.next(0, 100, t));
+    reader1.attach(channel);
+    reader2.attach(channel);
+    EXPECT_TRUE(reader1.attached());
+    EXPECT_FALSE(reader1.next(0, 100, t));
+
+    channel->push(10, make_timetag(1000));
+    channel->push(20, make_timetag(2000));
+    channel->push(30, make_timetag(3000));
+
+    // the tag at 20 is in the future
+    EXPECT_TRUE(reader1.next(0, 11, t));
+    EXPECT_EQ(t.tow_ms, 1000);
+    EXPECT_EQ(t.week, 2200);
+    EXPECT_DOUBLE_EQ(t.tow_ms_fraction, 0.25);
+    EXPECT_FALSE(reader1.next(0, 11, t));
+    EXPECT_TRUE(reader1.next(11, 31, t));
+    EXPECT_EQ(t.tow_ms, 2000);
+    EXPECT_TRUE(reader1.next(11, 31, t));
+    EXPECT_EQ(t.tow_ms, 3000);
+    EXPECT_FALSE(reader1.next(11, 31, t));
+
+    // the other reader keeps its own position, and the tags at 10 and 20 are too old
+    EXPECT_TRUE(reader2.next(25, 35, t));
+    EXPECT_EQ(t.tow_ms, 3000);
+    EXPECT_FALSE(reader2.next(25, 35, t));
+}
+
+
+TEST(GnssTimeTagChannelTest, SlowReadersLoseTheOldestTags)
+{
+    const int stream = 0;
+    auto channel = Gnss_Time_Tag_Channel::get(&stream);
+    Gnss_Time_Tag_Reader reader;
+    reader.attach(channel);
+    const uint64_t n_tags = Gnss_Time_Tag_Channel::capacity + 10;
+    for (uint64_t i = 0; i < n_tags; i++)
+        {
+            channel->push(i, make_timetag(static_cast<int>(i)));
+        }
+    GnssTime t{};
+    uint64_t n_read = 0;
+    int first_tow_ms = -1;
+    while (reader.next(0, n_tags, t))
+        {
+            if (first_tow_ms < 0)
+                {
+                    first_tow_ms = t.tow_ms;
+                }
+            n_read++;
+        }
+    EXPECT_EQ(n_read, Gnss_Time_Tag_Channel::capacity);
+    EXPECT_EQ(first_tow_ms, 10);
+    EXPECT_EQ(t.tow_ms, static_cast<int>(n_tags) - 1);
+}
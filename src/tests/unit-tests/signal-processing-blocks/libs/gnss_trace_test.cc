@@ -0,0 +1,135 @@
+/*!
+ * \file gnss_trace_test.cc
+ * \brief Tests of the trace of the scheduling of the receiver
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_trace.h"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+
+
+namespace
+{
+const std::string TRACE_TEST_FILENAME("./gnss_trace_test.json");
+
+// the counters of a gr::block that Gnss_Trace_Work reads
+struct Trace_Test_Block
+{
+    uint64_t read{0};
+    uint64_t written{0};
+    uint64_t nitems_read(unsigned int) const { return read; }
+    uint64_t nitems_written(unsigned int) const { return written; }
+};
+
+
+std::string trace_test_dump(uint64_t& events)
+{
+    EXPECT_TRUE(Gnss_Trace::write_json(TRACE_TEST_FILENAME, events));
+    std::ifstream input(TRACE_TEST_FILENAME);
+    std::string json((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    std::remove(TRACE_TEST_FILENAME.c_str());
+    return json;
+}
+
+
+size_t trace_test_count(const std::string& text, const std::string& pattern)
+{
+    size_t count = 0;
+    for (size_t position = text.find(pattern); position != std::string::npos; position = text.find(pattern, position + 1))
+        {
+            count++;
+        }
+    return count;
+}
+}  // namespace
+
+
+TEST(GnssTraceTest, RecordsOnlyWhileStarted)
+{
+    Gnss_Trace::start();
+    Gnss_Trace::stop();
+    Gnss_Trace::record('i', "ignored");
+    uint64_t events = 0;
+    const std::string json = trace_test_dump(events);
+    EXPECT_EQ(events, 0U);
+    EXPECT_EQ(json.find("ignored"), std::string::npos);
+}
+
+
+TEST(GnssTraceTest, WritesWorkCallsAndInstants)
+{
+    Gnss_Trace::start();
+    Trace_Test_Block block;
+    block.written = 40;
+    {
+        const Gnss_Trace_Work<Trace_Test_Block> work("tracking", 3, &block, 4000, 5);
+        block.read += 3990;  // consume_each()
+    }
+    static const char* const names[] = {"who", "what", nullptr};
+    Gnss_Trace::record('i', "control_event", -1, names, 300, 30);
+    {
+        const Gnss_Trace_Scope scope("acquisition_job", 7);
+    }
+    Gnss_Trace::stop();
+
+    uint64_t events = 0;
+    const std::string json = trace_test_dump(events);
+    EXPECT_EQ(events, 5U);
+    EXPECT_EQ(json.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["), 0U);
+    EXPECT_NE(json.find(R"("name":"tracking","ph":"B")"), std::string::npos);
+    EXPECT_NE(json.find(R"("args":{"id":3,"available":4000,"room":5,"produced":40}})"), std::string::npos);
+    EXPECT_NE(json.find(R"("args":{"id":3,"consumed":3990}})"), std::string::npos);
+    EXPECT_NE(json.find(R"("name":"control_event","ph":"i")"), std::string::npos);
+    EXPECT_NE(json.find(R"("s":"t","args":{"who":300,"what":30}})"), std::string::npos);
+    EXPECT_EQ(trace_test_count(json, R"("name":"acquisition_job")"), 2U);
+    EXPECT_EQ(trace_test_count(json, R"("name":"thread_name")"), 1U);
+}
+
+
+TEST(GnssTraceTest, KeepsTheLastEventsOfEachThread)
+{
+    Gnss_Trace::start(100);
+    std::thread other([]() {
+        for (int i = 0; i < 10; i++)
+            {
+                Gnss_Trace::record('i', "other");
+            }
+    });
+    other.join();
+    for (int i = 0; i < 250; i++)
+        {
+            Gnss_Trace::record('i', "epoch", i);
+        }
+    Gnss_Trace::stop();
+
+    EXPECT_EQ(Gnss_Trace::overwritten(), 150U);
+    uint64_t events = 0;
+    const std::string json = trace_test_dump(events);
+    // the guard events of a full ring are not written
+    EXPECT_EQ(events, 10U + 100U - 16U);
+    EXPECT_EQ(trace_test_count(json, R"("name":"thread_name")"), 2U);
+    EXPECT_EQ(json.find(R"("id":165})"), std::string::npos);
+    EXPECT_NE(json.find(R"("id":166})"), std::string::npos);
+    EXPECT_NE(json.find(R"("id":249})"), std::string::npos);
+
+    // a new start forgets them
+    Gnss_Trace::start(100);
+    Gnss_Trace::stop();
+    trace_test_dump(events);
+    EXPECT_EQ(events, 0U);
+}
@@ -0,0 +1,154 @@
+/*!
+ * \file gnss_udp_sender_test.cc
+ * \brief  This file implements unit tests for the Gnss_Udp_Sender class
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_udp_sender.h"
+#include <arpa/inet.h>
+#include <gtest/gtest.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <array>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+// Opens a UDP socket bound to a free port of the loopback interface
+int open_udp_sender_test_socket(uint16_t& port)
+{
+    const int sock = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = 0;
+    inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+    bind(sock, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    socklen_t length = sizeof(address);
+    getsockname(sock, reinterpret_cast<sockaddr*>(&address), &length);
+    port = ntohs(address.sin_port);
+    timeval timeout{1, 0};
+    setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    return sock;
+}
+}  // namespace
+
+
+TEST(GnssUdpSenderTest, SendsAllDatagramsInOrder)
+{
+    uint16_t port = 0;
+    const int sock = open_udp_sender_test_socket(port);
+    ASSERT_GE(sock, 0);
+
+    const int n_datagrams = 20;
+    {
+        Gnss_Udp_Sender sender({"127.0.0.1", "not an address"}, port, 32);
+        EXPECT_EQ(sender.endpoints(), 1U);
+        for (int i = 0; i < n_datagrams; i++)
+            {
+                std::string* datagram = sender.next_datagram();
+                ASSERT_NE(datagram, nullptr);
+                EXPECT_TRUE(datagram->empty());
+                *datagram = "datagram " + std::to_string(i);
+                sender.submit();
+            }
+        sender.flush();
+        EXPECT_EQ(sender.dropped_datagrams(), 0U);
+    }
+
+    std::array<char, 256> buffer{};
+    for (int i = 0; i < n_datagrams; i++)
+        {
+            const ssize_t length = recv(sock, buffer.data(), buffer.size(), 0);
+            ASSERT_GT(length, 0);
+            EXPECT_EQ(std::string(buffer.data(), length), "datagram " + std::to_string(i));
+        }
+    close(sock);
+}
+
+
+TEST(GnssUdpSenderTest, SendsToAllEndpoints)
+{
+    uint16_t port = 0;
+    const int sock = open_udp_sender_test_socket(port);
+    ASSERT_GE(sock, 0);
+
+    {
+        Gnss_Udp_Sender sender({"127.0.0.1", "127.0.0.1"}, port);
+        EXPECT_EQ(sender.endpoints(), 2U);
+        std::string* datagram = sender.next_datagram();
+        ASSERT_NE(datagram, nullptr);
+        *datagram = "epoch";
+        sender.submit();
+    }  // the pending datagrams are sent before the sender is destroyed
+
+    std::array<char, 256> buffer{};
+    for (int i = 0; i < 2; i++)
+        {
+            const ssize_t length = recv(sock, buffer.data(), buffer.size(), 0);
+            ASSERT_GT(length, 0);
+            EXPECT_EQ(std::string(buffer.data(), length), "epoch");
+        }
+    close(sock);
+}
+
+
+TEST(GnssUdpSenderTest, RepliesToRequests)
+{
+    uint16_t client_port = 0;
+    const int client = open_udp_sender_test_socket(client_port);
+    ASSERT_GE(client, 0);
+
+    // find a free local port for the sender
+    uint16_t local_port = 0;
+    close(open_udp_sender_test_socket(local_port));
+
+    Gnss_Udp_Sender sender({}, 0, 8, local_port);
+    std::string request;
+    sockaddr_storage source{};
+    socklen_t source_length = 0;
+    EXPECT_FALSE(sender.receive(request, source, source_length));
+
+    sockaddr_in sender_address{};
+    sender_address.sin_family = AF_INET;
+    sender_address.sin_port = htons(local_port);
+    inet_pton(AF_INET, "127.0.0.1", &sender_address.sin_addr);
+    const std::string hello("hello");
+    ASSERT_EQ(sendto(client, hello.data(), hello.size(), 0, reinterpret_cast<sockaddr*>(&sender_address), sizeof(sender_address)), static_cast<ssize_t>(hello.size()));
+
+    bool received = false;
+    for (int i = 0; i < 100 and !received; i++)
+        {
+            received = sender.receive(request, source, source_length);
+            if (!received)
+                {
+                    usleep(10000);
+                }
+        }
+    ASSERT_TRUE(received);
+    EXPECT_EQ(request, hello);
+
+    std::string* reply = sender.next_datagram(source, source_length);
+    ASSERT_NE(reply, nullptr);
+    *reply = "OK";
+    sender.submit();
+    sender.flush();
+
+    std::array<char, 256> buffer{};
+    const ssize_t length = recv(client, buffer.data(), buffer.size(), 0);
+    ASSERT_GT(length, 0);
+    EXPECT_EQ(std::string(buffer.data(), length), "OK");
+    close(client);
+}
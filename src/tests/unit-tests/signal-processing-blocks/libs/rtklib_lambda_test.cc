@@ -0,0 +1,118 @@
+/*!
+ * \file rtklib_lambda_test.cc
+ * \brief Implements Unit Tests for the LAMBDA integer ambiguity resolution
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "rtklib_lambda.h"
+#include "rtklib_rtkpos.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+
+
+TEST(RtklibLambdaTest, Workspace)
+{
+    // Float ambiguities and covariance of the example of Teunissen's LAMBDA
+    const std::vector<double> a = {5.45, 3.10, 2.97};
+    const std::vector<double> Q = {6.290, 5.978, 0.544,
+        5.978, 6.292, 2.340,
+        0.544, 2.340, 6.288};
+    std::vector<double> F(3 * 2);
+    std::vector<double> s(2);
+    ASSERT_EQ(lambda(3, 2, a.data(), Q.data(), F.data(), s.data()), 0);
+    EXPECT_DOUBLE_EQ(F[0], 5.0);
+    EXPECT_DOUBLE_EQ(F[1], 3.0);
+    EXPECT_DOUBLE_EQ(F[2], 4.0);
+    EXPECT_LE(s[0], s[1]);
+
+    // The workspace gives the same results, for growing and shrinking sizes
+    lambda_ws_t ws = {0, 0, nullptr, nullptr};
+    for (int n = 1; n <= 3; n++)
+        {
+            for (int iter = 0; iter < 2; iter++)
+                {
+                    std::vector<double> Qn(n * n);
+                    for (int i = 0; i < n; i++)
+                        {
+                            for (int j = 0; j < n; j++)
+                                {
+                                    Qn[i + j * n] = Q[i + j * 3];
+                                }
+                        }
+                    std::vector<double> F1(n * 2);
+                    std::vector<double> s1(2);
+                    std::vector<double> F2(n * 2);
+                    std::vector<double> s2(2);
+                    ASSERT_EQ(lambda(n, 2, a.data(), Qn.data(), F1.data(), s1.data()), 0);
+                    ASSERT_EQ(lambda_ws(&ws, n, 2, a.data(), Qn.data(), F2.data(), s2.data()), 0);
+                    EXPECT_EQ(F1, F2);
+                    EXPECT_EQ(s1, s2);
+                }
+        }
+    EXPECT_EQ(ws.nmax, 3);
+    std::vector<double> F1(2);
+    std::vector<double> s1(2);
+    ASSERT_EQ(lambda_ws(&ws, 1, 2, a.data(), Q.data(), F1.data(), s1.data()), 0);
+    EXPECT_EQ(ws.nmax, 3);
+    EXPECT_DOUBLE_EQ(F1[0], 5.0);
+    lambda_ws_free(&ws);
+    EXPECT_EQ(ws.buff, nullptr);
+
+    // Not a covariance matrix
+    const std::vector<double> Qbad = {-1.0};
+    EXPECT_NE(lambda(1, 2, a.data(), Qbad.data(), F.data(), s.data()), 0);
+}
+
+
+TEST(RtklibLambdaTest, PartialAmbiguityResolution)
+{
+    // The last ambiguity cannot be fixed, the others can
+    const int nb = 4;
+    const std::vector<double> y = {1.02, 2.01, -0.99, 0.5};
+    const std::vector<double> Qb = {0.001, 0.0, 0.0, 0.0,
+        0.0, 0.001, 0.0, 0.0,
+        0.0, 0.0, 0.001, 0.0,
+        0.0, 0.0, 0.0, 10.0};
+    rtk_t rtk{};
+    rtk.opt.thresar[0] = 3.0;
+    std::vector<lambda_ws_t> ws(MAXPARCAND, lambda_ws_t{0, 0, nullptr, nullptr});
+    rtk.ws = ws.data();
+
+    std::vector<double> b(nb * 2);
+    std::vector<double> s(2);
+    std::vector<int> keep(nb);
+    ASSERT_EQ(lambda(nb, 2, y.data(), Qb.data(), b.data(), s.data()), 0);
+    EXPECT_LT(s[1] / s[0], rtk.opt.thresar[0]);
+
+    // disabled
+    EXPECT_EQ(resamb_partial(&rtk, nb, y.data(), Qb.data(), b.data(), s.data(), keep.data()), 0);
+
+    rtk.opt.minfixamb = 2;
+    ASSERT_EQ(resamb_partial(&rtk, nb, y.data(), Qb.data(), b.data(), s.data(), keep.data()), 3);
+    EXPECT_GE(s[1] / s[0], rtk.opt.thresar[0]);
+    std::vector<int> kept(keep.begin(), keep.begin() + 3);
+    std::sort(kept.begin(), kept.end());
+    EXPECT_EQ(kept, std::vector<int>({0, 1, 2}));
+    EXPECT_DOUBLE_EQ(b[0], 1.0);
+    EXPECT_DOUBLE_EQ(b[1], 2.0);
+    EXPECT_DOUBLE_EQ(b[2], -1.0);
+
+    // a subset cannot have less than minfixamb ambiguities
+    rtk.opt.minfixamb = 4;
+    EXPECT_EQ(resamb_partial(&rtk, nb, y.data(), Qb.data(), b.data(), s.data(), keep.data()), 0);
+
+    for (auto& w : ws)
+        {
+            lambda_ws_free(&w);
+        }
+}
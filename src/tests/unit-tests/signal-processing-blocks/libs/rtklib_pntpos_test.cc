@@ -0,0 +1,196 @@
+/*!
+ * \file rtklib_pntpos_test.cc
+ * \brief Tests of the extrapolation of the satellite positions of the
+ * high-rate single point positioning
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "rtklib_ephemeris.h"
+#include "rtklib_pntpos.h"
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+
+namespace
+{
+// position and velocity in ECEF of a satellite in a circular orbit, at time t
+std::array<double, 6> circular_orbit_ecef(double t)
+{
+    const double radius = 26560e3;
+    const double inclination = 55.0 * D2R;
+    const double n = std::sqrt(GPS_GM / (radius * radius * radius));
+    const auto position = [&](double time) {
+        const double u = n * time;
+        const double x = radius * std::cos(u);
+        const double y = radius * std::sin(u) * std::cos(inclination);
+        const double z = radius * std::sin(u) * std::sin(inclination);
+        const double theta = GNSS_OMEGA_EARTH_DOT * time;
+        return std::array<double, 3>{std::cos(theta) * x + std::sin(theta) * y, -std::sin(theta) * x + std::cos(theta) * y, z};
+    };
+    const double h = 1e-3;
+    const auto p = position(t);
+    const auto p1 = position(t + h);
+    const auto p0 = position(t - h);
+    return {p[0], p[1], p[2], (p1[0] - p0[0]) / (2.0 * h), (p1[1] - p0[1]) / (2.0 * h), (p1[2] - p0[2]) / (2.0 * h)};
+}
+
+
+// GPS L1 C/A pseudoranges, without atmospheric delays, of a receiver at rr
+// with a clock bias of bias_m at time
+void simulate_observations(const nav_t& nav, gtime_t time, const double* rr, double bias_m, const prcopt_t& opt, std::vector<obsd_t>& obs)
+{
+    std::array<double, 3> pos{};
+    ecef2pos(rr, pos.data());
+    obs.clear();
+    for (int i = 0; i < nav.n; i++)
+        {
+            obsd_t o{};
+            o.time = time;
+            o.sat = static_cast<unsigned char>(nav.eph[i].sat);
+            o.rcv = 1;
+            o.code[0] = CODE_L1C;
+            o.SNR[0] = 45 * 4;
+            o.P[0] = 2.2e7;
+            std::array<double, 6> rs{};
+            std::array<double, 2> dts{};
+            std::array<double, 3> e{};
+            std::array<double, 2> azel{};
+            double var;
+            int svh;
+            for (int iter = 0; iter < 4; iter++)
+                {
+                    satposs(time, &o, 1, &nav, EPHOPT_BRDC, rs.data(), dts.data(), &var, &svh);
+                    o.P[0] = geodist(rs.data(), rr, e.data()) + bias_m - SPEED_OF_LIGHT_M_S * dts[0];
+                }
+            if (satazel(pos.data(), e.data(), azel.data()) > opt.elmin)
+                {
+                    obs.push_back(o);
+                }
+        }
+}
+}  // namespace
+
+
+TEST(RtklibPntposTest, SatellitePositionExtrapolation)
+{
+    const double t0 = 1000.0;
+    const auto anchor = circular_orbit_ecef(t0);
+    std::array<double, 3> acc{};
+    satacc(anchor.data(), acc.data());
+
+    for (const double dt : {-0.5, 0.01, 0.5, 1.0})
+        {
+            const auto truth = circular_orbit_ecef(t0 + dt);
+            std::array<double, 6> extrapolated{};
+            satposextr(anchor.data(), acc.data(), dt, extrapolated.data());
+            std::array<double, 3> position_error{};
+            std::array<double, 3> velocity_error{};
+            for (int i = 0; i < 3; i++)
+                {
+                    position_error[i] = extrapolated[i] - truth[i];
+                    velocity_error[i] = extrapolated[i + 3] - truth[i + 3];
+                }
+            EXPECT_LT(norm_rtk(position_error.data(), 3), 1e-3) << "dt = " << dt;
+            EXPECT_LT(norm_rtk(velocity_error.data(), 3), 1e-3) << "dt = " << dt;
+        }
+
+    // without the acceleration, the error after 1 s is of tens of cm
+    const std::array<double, 3> no_acc{};
+    const auto truth = circular_orbit_ecef(t0 + 1.0);
+    std::array<double, 6> extrapolated{};
+    satposextr(anchor.data(), no_acc.data(), 1.0, extrapolated.data());
+    std::array<double, 3> position_error{};
+    for (int i = 0; i < 3; i++)
+        {
+            position_error[i] = extrapolated[i] - truth[i];
+        }
+    EXPECT_GT(norm_rtk(position_error.data(), 3), 0.1);
+}
+
+
+TEST(RtklibPntposTest, HighRateSameAsPntpos)
+{
+    // 24 GPS satellites in 6 planes
+    const int week = 2200;
+    const double toe = 345600.0;
+    std::vector<eph_t> eph(24);
+    auto nav = std::make_unique<nav_t>();
+    for (int i = 0; i < 24; i++)
+        {
+            eph_t& e = eph[i];
+            e.sat = satno(SYS_GPS, i + 1);
+            e.iode = e.iodc = 1;
+            e.week = week;
+            e.toe = e.toc = e.ttr = gpst2time(week, toe);
+            e.toes = toe;
+            e.fit = 4.0;
+            e.A = 26560e3;
+            e.e = 0.01;
+            e.i0 = 55.0 * D2R;
+            e.OMG0 = (i / 4) * 60.0 * D2R;
+            e.omg = 0.3;
+            e.M0 = (i % 4) * 90.0 * D2R + (i / 4) * 15.0 * D2R;
+            e.OMGd = -8e-9;
+            e.f0 = 1e-5 * (i - 12);
+            e.f1 = 1e-12;
+            nav->lam[e.sat - 1][0] = LAM_CARR[0];
+            nav->lam[e.sat - 1][1] = LAM_CARR[1];
+        }
+    nav->eph = eph.data();
+    nav->n = nav->nmax = static_cast<int>(eph.size());
+
+    prcopt_t opt{};
+    opt.mode = PMODE_SINGLE;
+    opt.navsys = SYS_GPS;
+    opt.sateph = EPHOPT_BRDC;
+    opt.ionoopt = IONOOPT_OFF;
+    opt.tropopt = TROPOPT_OFF;
+    opt.elmin = 10.0 * D2R;
+    opt.maxgdop = 30.0;
+    opt.err[0] = 100.0;
+    opt.err[1] = opt.err[2] = 0.003;
+
+    const std::array<double, 3> llh{{40.0 * D2R, 2.0 * D2R, 100.0}};
+    std::array<double, 3> rr{};
+    pos2ecef(llh.data(), rr.data());
+
+    auto cache = std::make_unique<pntcache_t>();
+    initpntcache(cache.get(), 1.0);
+    sol_t sol_hr{};
+    std::vector<obsd_t> obs;
+    char msg[128] = "";
+    const int epochs = 250;  // 2.5 s at 100 Hz
+    for (int k = 0; k < epochs; k++)
+        {
+            const double t = toe + 600.0 + 0.01 * k;
+            const double bias_m = 3000.0 + 150.0 * 0.01 * k;
+            simulate_observations(*nav, gpst2time(week, t), rr.data(), bias_m, opt, obs);
+            ASSERT_GE(obs.size(), 5U);
+
+            sol_t sol{};
+            ASSERT_EQ(pntpos(obs.data(), static_cast<int>(obs.size()), nav.get(), &opt, &sol, nullptr, nullptr, msg), 1) << msg;
+            ASSERT_EQ(pntpos_hr(obs.data(), static_cast<int>(obs.size()), nav.get(), &opt, &sol_hr, nullptr, nullptr, msg, cache.get()), 1) << msg;
+            for (int i = 0; i < 3; i++)
+                {
+                    EXPECT_NEAR(sol_hr.rr[i], sol.rr[i], 0.01) << "epoch " << k;
+                    EXPECT_NEAR(sol_hr.rr[i], rr[i], 0.01) << "epoch " << k;
+                }
+            EXPECT_NEAR(sol_hr.dtr[0] * SPEED_OF_LIGHT_M_S, bias_m, 0.01) << "epoch " << k;
+        }
+    // all the epochs but the first one are solved from the anchors, which are
+    // computed about once per second
+    EXPECT_EQ(cache->epochs, static_cast<unsigned long>(epochs - 1));
+    EXPECT_LE(cache->anchors, 3 * obs.size() + 3);
+}
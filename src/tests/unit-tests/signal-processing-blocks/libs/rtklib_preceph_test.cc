@@ -0,0 +1,123 @@
+/*!
+ * \file rtklib_preceph_test.cc
+ * \brief Tests of the interpolation of precise ephemeris and clocks
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "rtklib_preceph.h"
+#include "rtklib_rtkcmn.h"
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+
+namespace
+{
+// position in ECEF, at t seconds from the start, of a satellite in a circular orbit
+std::array<double, 3> precise_orbit_ecef(double t)
+{
+    const double radius = 26560e3;
+    const double inclination = 55.0 * D2R;
+    const double u = std::sqrt(GPS_GM / (radius * radius * radius)) * t + 0.3;
+    const double x = radius * std::cos(u);
+    const double y = radius * std::sin(u) * std::cos(inclination);
+    const double z = radius * std::sin(u) * std::sin(inclination);
+    const double theta = GNSS_OMEGA_EARTH_DOT * t;
+    return {std::cos(theta) * x + std::sin(theta) * y, -std::sin(theta) * x + std::cos(theta) * y, z};
+}
+
+
+double precise_clock(double t)
+{
+    return 1e-4 + 1e-11 * t;
+}
+
+
+// precise ephemeris and clocks of satellite 1 at the epochs t (s from start)
+void fill_precise_products(const gtime_t& start, const std::vector<double>& epochs, std::vector<peph_t>& peph, std::vector<pclk_t>& pclk, nav_t& nav)
+{
+    peph.assign(epochs.size(), peph_t{});
+    pclk.assign(epochs.size(), pclk_t{});
+    for (size_t i = 0; i < epochs.size(); i++)
+        {
+            const auto p = precise_orbit_ecef(epochs[i]);
+            peph[i].time = timeadd(start, epochs[i]);
+            pclk[i].time = peph[i].time;
+            for (int j = 0; j < 3; j++)
+                {
+                    peph[i].pos[0][j] = p[j];
+                    peph[i].std[0][j] = 0.01;
+                }
+            peph[i].pos[0][3] = precise_clock(epochs[i]);
+            pclk[i].clk[0][0] = precise_clock(epochs[i]);
+        }
+    nav.peph = peph.data();
+    nav.ne = nav.nemax = static_cast<int>(peph.size());
+    nav.pclk = pclk.data();
+    nav.nc = nav.ncmax = static_cast<int>(pclk.size());
+}
+}  // namespace
+
+
+TEST(RtklibPrecephTest, EvenAndUnevenGrids)
+{
+    const gtime_t start = gpst2time(2200, 86400.0);
+    std::vector<double> even;
+    for (int i = 0; i < 96; i++)
+        {
+            even.push_back(900.0 * i);
+        }
+    // the same grid with gaps, so that the epochs have to be searched
+    std::vector<double> uneven;
+    for (const double t : even)
+        {
+            if (std::fmod(t, 8100.0) != 900.0)
+                {
+                    uneven.push_back(t);
+                }
+        }
+
+    for (const auto& epochs : {even, uneven})
+        {
+            auto nav = std::make_unique<nav_t>();
+            std::vector<peph_t> peph;
+            std::vector<pclk_t> pclk;
+            fill_precise_products(start, epochs, peph, pclk, *nav);
+            for (double t = 0.0; t <= epochs.back(); t += 337.1)
+                {
+                    const gtime_t time = timeadd(start, t);
+                    std::array<double, 3> rs{};
+                    double dts = 0.0;
+                    double vare = 0.0;
+                    double varc = 0.0;
+                    ASSERT_EQ(pephpos(time, 1, nav.get(), rs.data(), &dts, &vare, &varc), 1);
+                    const auto truth = precise_orbit_ecef(t);
+                    for (int j = 0; j < 3; j++)
+                        {
+                            EXPECT_NEAR(rs[j], truth[j], 1e-3) << "t=" << t;
+                        }
+                    EXPECT_NEAR(dts, precise_clock(t), 1e-15) << "t=" << t;
+                    EXPECT_GT(vare, 0.0);
+                    dts = 0.0;
+                    ASSERT_EQ(pephclk(time, 1, nav.get(), &dts, &varc), 1);
+                    EXPECT_NEAR(dts, precise_clock(t), 1e-15) << "t=" << t;
+                }
+            // out of the span of the products
+            std::array<double, 3> rs{};
+            double dts = 0.0;
+            EXPECT_EQ(pephpos(timeadd(start, epochs.back() + 2.0 * MAXDTE), 1, nav.get(), rs.data(), &dts, nullptr, nullptr), 0);
+            nav->peph = nullptr;
+            nav->pclk = nullptr;
+        }
+}
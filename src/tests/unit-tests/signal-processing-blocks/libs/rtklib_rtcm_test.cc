@@ -0,0 +1,130 @@
+/*!
+ * \file rtklib_rtcm_test.cc
+ * \brief Tests of the input of RTCM 3 messages from buffers of stream data
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "rtklib_rtcm.h"
+#include "rtklib_rtkcmn.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+
+namespace
+{
+// RTCM 3 frame of a message type 1005 with the station position rr (m)
+std::vector<unsigned char> rtcm3_type1005_frame(int staid, const std::array<double, 3>& rr)
+{
+    std::vector<unsigned char> frame(3 + 19 + 3, 0);
+    int i = 0;
+    setbitu(frame.data(), i, 8, RTCM3PREAMB);
+    i += 8 + 6;
+    setbitu(frame.data(), i, 10, 19);
+    i += 10;
+    setbitu(frame.data(), i, 12, 1005);
+    i += 12;
+    setbitu(frame.data(), i, 12, staid);
+    i += 12 + 6 + 4;
+    for (int j = 0; j < 3; j++)
+        {
+            const double value = std::round(rr[j] * 1e4);
+            const double high = std::floor(value / 64.0);
+            setbits(frame.data(), i, 32, static_cast<int>(high));
+            setbitu(frame.data(), i + 32, 6, static_cast<unsigned int>(value - high * 64.0));
+            i += 38 + 2;
+        }
+    setbitu(frame.data(), 3 * 8 + 19 * 8, 24, rtk_crc24q(frame.data(), 3 + 19));
+    return frame;
+}
+
+
+struct Rtcm3_Event
+{
+    int status;
+    double x;
+};
+}  // namespace
+
+
+TEST(RtklibRtcmTest, BufferInputSameAsByteInput)
+{
+    std::mt19937 gen(2022);
+    std::uniform_int_distribution<int> byte(0, 255);
+    std::vector<unsigned char> stream;
+    for (int k = 0; k < 50; k++)
+        {
+            // garbage between frames, and a false frame with a parity error
+            for (int j = byte(gen) % 20; j > 0; j--)
+                {
+                    stream.push_back(static_cast<unsigned char>(byte(gen) % 0x80));
+                }
+            if (k % 3 == 0)
+                {
+                    const std::array<unsigned char, 7> false_frame{RTCM3PREAMB, 0, 1, 0x55, 0x55, 0x55, 0x55};
+                    stream.insert(stream.end(), false_frame.begin(), false_frame.end());
+                }
+            auto frame = rtcm3_type1005_frame(100, {4e6 + k, 3e5 - k, 4.9e6 + 0.5 * k});
+            if (k % 9 == 4)
+                {
+                    frame[10] ^= 0x10;  // parity error
+                }
+            stream.insert(stream.end(), frame.begin(), frame.end());
+        }
+
+    auto by_byte = std::make_unique<rtcm_t>();
+    auto by_buffer = std::make_unique<rtcm_t>();
+    ASSERT_EQ(init_rtcm(by_byte.get()), 1);
+    ASSERT_EQ(init_rtcm(by_buffer.get()), 1);
+
+    std::vector<Rtcm3_Event> expected;
+    for (const auto data : stream)
+        {
+            const int ret = input_rtcm3(by_byte.get(), data);
+            if (ret)
+                {
+                    expected.push_back({ret, by_byte->sta.pos[0]});
+                }
+        }
+    EXPECT_EQ(expected.size(), 44U);
+
+    // the stream in chunks of random sizes, as read from an input stream
+    std::vector<Rtcm3_Event> events;
+    for (size_t start = 0; start < stream.size();)
+        {
+            const int n = std::min<int>(1 + byte(gen), static_cast<int>(stream.size() - start));
+            for (int i = 0; i < n;)
+                {
+                    int nb = 0;
+                    const int ret = input_rtcm3s(by_buffer.get(), stream.data() + start + i, n - i, &nb);
+                    ASSERT_GT(nb, 0);
+                    i += nb;
+                    if (ret)
+                        {
+                            events.push_back({ret, by_buffer->sta.pos[0]});
+                        }
+                }
+            start += n;
+        }
+    ASSERT_EQ(events.size(), expected.size());
+    for (size_t k = 0; k < events.size(); k++)
+        {
+            EXPECT_EQ(events[k].status, expected[k].status);
+            EXPECT_EQ(events[k].x, expected[k].x);
+        }
+    free_rtcm(by_byte.get());
+    free_rtcm(by_buffer.get());
+}
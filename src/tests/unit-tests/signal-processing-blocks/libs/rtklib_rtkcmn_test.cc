@@ -0,0 +1,148 @@
+/*!
+ * \file rtklib_rtkcmn_test.cc
+ * \brief Implements Unit Tests for the RTKLIB matrix routines
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "rtklib_rtkcmn.h"
+#include <gtest/gtest.h>
+#include <array>
+#include <random>
+#include <vector>
+
+
+TEST(RtklibRtkcmnTest, KalmanFilter)
+{
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    for (int n = 4; n <= 40; n += 12)
+        {
+            const int m = n / 2;
+            std::vector<double> x(n), P(n * n), H(n * m), v(m), R(m * m, 0.0);
+            std::vector<double> G(n * n);
+            for (auto& g : G)
+                {
+                    g = dist(gen);
+                }
+            matmul("NT", n, n, n, 1.0, G.data(), G.data(), 0.0, P.data());  // P=G*G'
+            for (int i = 0; i < n; i++)
+                {
+                    x[i] = 1.0 + i;
+                    P[i + i * n] += 1.0;
+                }
+            for (auto& h : H)
+                {
+                    h = dist(gen);
+                }
+            for (int j = 0; j < m; j++)
+                {
+                    v[j] = dist(gen);
+                    R[j + j * m] = 0.01 * (j + 1);
+                }
+
+            // Reference: K=P*H*(H'*P*H+R)^-1, xp=x+K*v, Pp=(I-K*H')*P
+            std::vector<double> F(n * m), Q(R), K(n * m), I(n * n, 0.0);
+            std::vector<double> xr(x), Pr(n * n);
+            for (int i = 0; i < n; i++)
+                {
+                    I[i + i * n] = 1.0;
+                }
+            matmul("NN", n, m, n, 1.0, P.data(), H.data(), 0.0, F.data());
+            matmul("TN", m, m, n, 1.0, H.data(), F.data(), 1.0, Q.data());
+            ASSERT_EQ(matinv(Q.data(), m), 0);
+            matmul("NN", n, m, m, 1.0, F.data(), Q.data(), 0.0, K.data());
+            matmul("NN", n, 1, m, 1.0, K.data(), v.data(), 1.0, xr.data());
+            matmul("NT", n, n, m, -1.0, K.data(), H.data(), 1.0, I.data());
+            matmul("NN", n, n, n, 1.0, I.data(), P.data(), 0.0, Pr.data());
+
+            std::vector<double> xp(n), Pp(n * n);
+            ASSERT_EQ(filter_(x.data(), P.data(), H.data(), v.data(), R.data(), n, m, xp.data(), Pp.data()), 0);
+            for (int i = 0; i < n; i++)
+                {
+                    EXPECT_NEAR(xp[i], xr[i], 1e-8);
+                }
+            for (int i = 0; i < n * n; i++)
+                {
+                    EXPECT_NEAR(Pp[i], Pr[i], 1e-8);
+                }
+
+            // filter() does not update the states with x[i]==0.0
+            x[1] = 0.0;
+            std::vector<double> P1(P);
+            ASSERT_EQ(filter(x.data(), P1.data(), H.data(), v.data(), R.data(), n, m), 0);
+            EXPECT_DOUBLE_EQ(x[1], 0.0);
+            for (int i = 0; i < n; i++)
+                {
+                    EXPECT_DOUBLE_EQ(P1[1 + i * n], P[1 + i * n]);
+                }
+        }
+}
+
+
+TEST(RtklibRtkcmnTest, LeastSquares)
+{
+    // y=A'*x for x=(1,-2,3), with more measurements than parameters
+    const int n = 3;
+    const int m = 5;
+    const std::vector<double> A = {1.0, 0.0, 0.0,
+        0.0, 1.0, 0.0,
+        0.0, 0.0, 1.0,
+        1.0, 1.0, 0.0,
+        0.0, 1.0, 1.0};
+    const std::vector<double> y = {1.0, -2.0, 3.0, -1.0, 1.0};
+    std::vector<double> x(n), Q(n * n);
+    ASSERT_EQ(lsq(A.data(), y.data(), n, m, x.data(), Q.data()), 0);
+    EXPECT_NEAR(x[0], 1.0, 1e-12);
+    EXPECT_NEAR(x[1], -2.0, 1e-12);
+    EXPECT_NEAR(x[2], 3.0, 1e-12);
+    for (int i = 0; i < n; i++)
+        {
+            for (int j = 0; j < n; j++)
+                {
+                    EXPECT_DOUBLE_EQ(Q[i + j * n], Q[j + i * n]);
+                }
+        }
+
+    // A*A' is singular: error
+    const std::vector<double> B(n * m, 1.0);
+    EXPECT_NE(lsq(B.data(), y.data(), n, m, x.data(), Q.data()), 0);
+    EXPECT_EQ(lsq(A.data(), y.data(), n, 2, x.data(), Q.data()), -1);
+}
+
+
+TEST(RtklibRtkcmnTest, GetBits)
+{
+    std::mt19937 gen(4321);
+    std::uniform_int_distribution<int> byte(0, 255);
+    std::array<unsigned char, 16> buff{};
+    for (auto& b : buff)
+        {
+            b = static_cast<unsigned char>(byte(gen));
+        }
+    for (int pos = 0; pos < 64; pos++)
+        {
+            for (int len = 0; len <= 32; len++)
+                {
+                    unsigned int expected = 0;
+                    for (int i = pos; i < pos + len; i++)
+                        {
+                            expected = (expected << 1) + ((buff[i / 8] >> (7 - i % 8)) & 1U);
+                        }
+                    ASSERT_EQ(getbitu(buff.data(), pos, len), expected) << "pos=" << pos << " len=" << len;
+                    if (len > 0 && len < 32)
+                        {
+                            const int sign = static_cast<int>(expected >> (len - 1));
+                            ASSERT_EQ(getbits(buff.data(), pos, len), static_cast<int>(expected) - (sign << len)) << "pos=" << pos << " len=" << len;
+                        }
+                }
+        }
+}
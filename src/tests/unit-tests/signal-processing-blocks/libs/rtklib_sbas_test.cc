@@ -0,0 +1,221 @@
+/*!
+ * \file rtklib_sbas_test.cc
+ * \brief Tests of the indexed lookup of the SBAS corrections
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "rtklib_rtkcmn.h"
+#include "rtklib_sbas.h"
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include <memory>
+
+
+namespace
+{
+sbsmsg_t sbas_message(int type)
+{
+    sbsmsg_t msg{};
+    msg.week = 2200;
+    msg.tow = 3600;
+    msg.prn = 133;
+    setbitu(msg.msg, 8, 6, static_cast<unsigned int>(type));
+    return msg;
+}
+
+
+// the IGPs around pos, searched over all the IGPs of all the bands, as
+// searchigp() did before the IGP grid index
+void search_igp_by_scan(const double* pos, const sbsion_t* ion, const sbsigp_t** igp, double* x, double* y)
+{
+    std::array<int, 2> latp{};
+    std::array<int, 4> lonp{};
+    const double lat = pos[0] * R2D;
+    double lon = pos[1] * R2D;
+    if (lon >= 180.0)
+        {
+            lon -= 360.0;
+        }
+    if (-55.0 <= lat && lat < 55.0)
+        {
+            latp[0] = static_cast<int>(std::floor(lat / 5.0)) * 5;
+            latp[1] = latp[0] + 5;
+            lonp[0] = lonp[1] = static_cast<int>(std::floor(lon / 5.0)) * 5;
+            lonp[2] = lonp[3] = lonp[0] + 5;
+            *x = (lon - lonp[0]) / 5.0;
+            *y = (lat - latp[0]) / 5.0;
+        }
+    else
+        {
+            latp[0] = static_cast<int>(std::floor((lat - 5.0) / 10.0)) * 10 + 5;
+            latp[1] = latp[0] + 10;
+            lonp[0] = lonp[1] = static_cast<int>(std::floor(lon / 10.0)) * 10;
+            lonp[2] = lonp[3] = lonp[0] + 10;
+            *x = (lon - lonp[0]) / 10.0;
+            *y = (lat - latp[0]) / 10.0;
+            if (75.0 <= lat && lat < 85.0)
+                {
+                    lonp[1] = static_cast<int>(std::floor(lon / 90.0)) * 90;
+                    lonp[3] = lonp[1] + 90;
+                }
+            else if (-85.0 <= lat && lat < -75.0)
+                {
+                    lonp[0] = static_cast<int>(std::floor((lon - 50.0) / 90.0)) * 90 + 40;
+                    lonp[2] = lonp[0] + 90;
+                }
+            else if (lat >= 85.0)
+                {
+                    lonp.fill(static_cast<int>(std::floor(lon / 90.0)) * 90);
+                }
+            else if (lat < -85.0)
+                {
+                    lonp.fill(static_cast<int>(std::floor((lon - 50.0) / 90.0)) * 90 + 40);
+                }
+        }
+    for (auto& l : lonp)
+        {
+            if (l == 180)
+                {
+                    l = -180;
+                }
+        }
+    for (int band = 0; band <= MAXBAND; band++)
+        {
+            for (const sbsigp_t* p = ion[band].igp; p < ion[band].igp + ion[band].nigp; p++)
+                {
+                    if (p->t0.time == 0)
+                        {
+                            continue;
+                        }
+                    if (p->lat == latp[0] && p->lon == lonp[0] && p->give > 0)
+                        {
+                            igp[0] = p;
+                        }
+                    else if (p->lat == latp[1] && p->lon == lonp[1] && p->give > 0)
+                        {
+                            igp[1] = p;
+                        }
+                    else if (p->lat == latp[0] && p->lon == lonp[2] && p->give > 0)
+                        {
+                            igp[2] = p;
+                        }
+                    else if (p->lat == latp[1] && p->lon == lonp[3] && p->give > 0)
+                        {
+                            igp[3] = p;
+                        }
+                    if (igp[0] && igp[1] && igp[2] && igp[3])
+                        {
+                            return;
+                        }
+                }
+        }
+}
+}  // namespace
+
+
+TEST(RtklibSbasTest, FindsTheSatelliteCorrectionsOfTheMask)
+{
+    auto nav = std::make_unique<nav_t>();
+    sbsmsg_t msg = sbas_message(1);
+    const std::array<int, 4> prns = {3, 17, 40, 133};  // GPS 3 and 17, GLONASS 3, SBAS 133
+    for (const int prn : prns)
+        {
+            setbitu(msg.msg, 13 + prn, 1, 1);
+        }
+    ASSERT_EQ(sbsupdatecorr(&msg, nav.get()), 1);
+    ASSERT_EQ(nav->sbssat.nsat, 4);
+
+    EXPECT_EQ(sbssatp(&nav->sbssat, satno(SYS_GPS, 3)), &nav->sbssat.sat[0]);
+    EXPECT_EQ(sbssatp(&nav->sbssat, satno(SYS_GPS, 17)), &nav->sbssat.sat[1]);
+    EXPECT_EQ(sbssatp(&nav->sbssat, satno(SYS_GLO, 3)), &nav->sbssat.sat[2]);
+    EXPECT_EQ(sbssatp(&nav->sbssat, satno(SYS_SBS, 133)), &nav->sbssat.sat[3]);
+    EXPECT_EQ(sbssatp(&nav->sbssat, satno(SYS_GPS, 4)), nullptr);
+    EXPECT_EQ(sbssatp(&nav->sbssat, 0), nullptr);
+
+    // long-term correction of GPS 17
+    const gtime_t t0 = gpst2time(msg.week, msg.tow);
+    nav->sbssat.sat[1].lcorr.t0 = t0;
+    nav->sbssat.sat[1].lcorr.dpos[0] = 1.5;
+    nav->sbssat.sat[1].lcorr.dvel[0] = 0.01;
+    std::array<double, 3> drs{};
+    double ddts = 0.0;
+    EXPECT_EQ(sbslongcorr(timeadd(t0, 10.0), satno(SYS_GPS, 17), &nav->sbssat, drs.data(), &ddts), 1);
+    EXPECT_DOUBLE_EQ(drs[0], 1.6);
+    EXPECT_EQ(sbslongcorr(timeadd(t0, 10.0), satno(SYS_GPS, 3), &nav->sbssat, drs.data(), &ddts), 0);
+
+    // a new mask replaces the index
+    sbsmsg_t msg2 = sbas_message(1);
+    setbitu(msg2.msg, 13 + 17, 1, 1);
+    ASSERT_EQ(sbsupdatecorr(&msg2, nav.get()), 1);
+    EXPECT_EQ(sbssatp(&nav->sbssat, satno(SYS_GPS, 17)), &nav->sbssat.sat[0]);
+    EXPECT_EQ(sbssatp(&nav->sbssat, satno(SYS_GPS, 3)), nullptr);
+}
+
+
+TEST(RtklibSbasTest, IndexedIgpSearchMatchesTheScan)
+{
+    auto nav = std::make_unique<nav_t>();
+    for (int band = 0; band <= MAXBAND; band++)
+        {
+            sbsmsg_t msg = sbas_message(18);
+            setbitu(msg.msg, 18, 4, static_cast<unsigned int>(band));
+            for (int i = 1; i <= 201; i++)
+                {
+                    setbitu(msg.msg, 23 + i, 1, 1);
+                }
+            ASSERT_EQ(sbsupdatecorr(&msg, nav.get()), 18);
+            ASSERT_GT(nav->sbsion[band].nigp, 0);
+        }
+
+    // corrections that only depend on the grid point, some of them not monitored
+    const gtime_t t0 = gpst2time(2200, 3600);
+    for (int band = 0; band <= MAXBAND; band++)
+        {
+            for (int i = 0; i < nav->sbsion[band].nigp; i++)
+                {
+                    sbsigp_t& igp = nav->sbsion[band].igp[i];
+                    igp.t0 = t0;
+                    igp.give = static_cast<short>(((igp.lat + 90) * 7 + (igp.lon + 180) * 3) % 16);
+                    igp.delay = static_cast<float>(igp.lat + 0.01 * igp.lon);
+                }
+        }
+
+    for (double lat = -89.5; lat < 90.0; lat += 1.7)
+        {
+            for (double lon = -179.5; lon < 180.0; lon += 2.3)
+                {
+                    const std::array<double, 2> pos = {lat * D2R, lon * D2R};
+                    const sbsigp_t* igp[4] = {};
+                    const sbsigp_t* expected[4] = {};
+                    double x = 0.0;
+                    double y = 0.0;
+                    double expected_x = 0.0;
+                    double expected_y = 0.0;
+                    searchigp(t0, pos.data(), nav->sbsion, &nav->sbsigpidx, igp, &x, &y);
+                    search_igp_by_scan(pos.data(), nav->sbsion, expected, &expected_x, &expected_y);
+                    EXPECT_DOUBLE_EQ(x, expected_x);
+                    EXPECT_DOUBLE_EQ(y, expected_y);
+                    for (int i = 0; i < 4; i++)
+                        {
+                            ASSERT_EQ(igp[i] == nullptr, expected[i] == nullptr) << "lat " << lat << " lon " << lon << " corner " << i;
+                            if (igp[i] != nullptr)
+                                {
+                                    // the bands that share a grid point carry the same correction
+                                    EXPECT_EQ(igp[i]->lat, expected[i]->lat);
+                                    EXPECT_EQ(igp[i]->lon, expected[i]->lon);
+                                    EXPECT_EQ(igp[i]->delay, expected[i]->delay);
+                                }
+                        }
+                }
+        }
+}
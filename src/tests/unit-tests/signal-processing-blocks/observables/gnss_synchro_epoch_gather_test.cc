@@ -0,0 +1,122 @@
+/*!
+ * \file gnss_synchro_epoch_gather_test.cc
+ * \brief Tests the observables gathered at the epochs of the receiver clock
+ * from the latest tracking observables of each channel.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "MATH_CONSTANTS.h"
+#include "gnss_frequencies.h"
+#include "gnss_synchro.h"
+#include "gnss_synchro_epoch_gather.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+
+namespace
+{
+// tracking observables of a satellite of constant Doppler, one per code period of 1 ms
+std::vector<Gnss_Synchro> epoch_gather_test_symbols(int64_t fs, double doppler_hz, double t0_s, int n)
+{
+    std::vector<Gnss_Synchro> symbols(n);
+    const double period_s = 1e-3 / (1.0 + doppler_hz / FREQ1);
+    for (int k = 0; k < n; k++)
+        {
+            const double t_s = t0_s + k * period_s;
+            Gnss_Synchro& synchro = symbols[k];
+            synchro.fs = fs;
+            synchro.PRN = 7;
+            synchro.Tracking_sample_counter = static_cast<uint64_t>(std::floor(t_s * static_cast<double>(fs)));
+            synchro.Code_phase_samples = t_s * static_cast<double>(fs) - static_cast<double>(synchro.Tracking_sample_counter);
+            synchro.Carrier_phase_rads = -TWO_PI * doppler_hz * (t_s - t0_s);
+            synchro.Carrier_Doppler_hz = doppler_hz;
+            synchro.TOW_at_current_symbol_ms = 345600000 + k;
+            synchro.Flag_valid_word = true;
+        }
+    return symbols;
+}
+}  // namespace
+
+
+TEST(GnssSynchroEpochGatherTest, PropagatesToTheEpochs)
+{
+    const int64_t fs = 4000000;
+    const double doppler_hz = 3250.0;
+    const double max_distance_s = 0.02;
+    const std::vector<Gnss_Synchro> symbols = epoch_gather_test_symbols(fs, doppler_hz, 1.0003, 100);
+    Gnss_Synchro_Epoch_Gather gather(1);
+
+    int32_t read = 0;
+    for (uint64_t rx_clock = 4004000; rx_clock < 4080000; rx_clock += 20000)
+        {
+            bool complete = false;
+            read += gather.read(0, symbols.data() + read, static_cast<int32_t>(symbols.size()) - read, rx_clock, max_distance_s, complete);
+            EXPECT_TRUE(complete);
+            // the observables after the nearest ones are left for the next epoch
+            ASSERT_LT(read, static_cast<int32_t>(symbols.size()));
+            const double epoch_s = static_cast<double>(rx_clock) / static_cast<double>(fs);
+            const double rx_time_s = gather.latest(0).RX_time;
+            const Gnss_Synchro& next = symbols[read];
+            const double next_rx_time_s = (static_cast<double>(next.Tracking_sample_counter) + next.Code_phase_samples) / static_cast<double>(fs);
+            EXPECT_LE(std::fabs(epoch_s - rx_time_s), std::fabs(next_rx_time_s - epoch_s));
+            EXPECT_LE(std::fabs(epoch_s - rx_time_s), 0.5e-3);
+
+            Gnss_Synchro obs{};
+            ASSERT_TRUE(gather.propagate(0, rx_clock, max_distance_s, FREQ1, obs));
+            EXPECT_EQ(obs.PRN, 7U);
+            EXPECT_DOUBLE_EQ(obs.Carrier_Doppler_hz, doppler_hz);
+            EXPECT_NEAR(obs.Carrier_phase_rads, -TWO_PI * doppler_hz * (epoch_s - 1.0003), 1e-6);
+            EXPECT_NEAR(obs.interp_TOW_ms, 345600000.0 + (epoch_s - 1.0003) * 1e3 * (1.0 + doppler_hz / FREQ1), 1e-7);
+        }
+
+    // too far from the epoch
+    Gnss_Synchro obs{};
+    EXPECT_FALSE(gather.propagate(0, 4000000 + 2 * static_cast<uint64_t>(max_distance_s * fs), max_distance_s, FREQ1, obs));
+    gather.clear(0);
+    EXPECT_FALSE(gather.has_synchro(0));
+    EXPECT_FALSE(gather.propagate(0, 4004000, max_distance_s, FREQ1, obs));
+}
+
+
+TEST(GnssSynchroEpochGatherTest, EpochComplete)
+{
+    const int64_t fs = 4000000;
+    const double max_distance_s = 0.02;
+    std::vector<Gnss_Synchro> symbols = epoch_gather_test_symbols(fs, 0.0, 0.009, 4);
+    Gnss_Synchro_Epoch_Gather gather(2);
+
+    // a channel without tracking observables does not hold the epoch
+    bool complete = false;
+    EXPECT_EQ(gather.read(1, nullptr, 0, 50000, max_distance_s, complete), 0);
+    EXPECT_TRUE(complete);
+
+    // the next observables can still be nearer to the epoch
+    complete = false;
+    EXPECT_EQ(gather.read(0, symbols.data(), 4, 50000, max_distance_s, complete), 4);
+    EXPECT_FALSE(complete);
+    // the channel is too far behind to ever reach the epoch
+    EXPECT_EQ(gather.read(0, nullptr, 0, 50000 + 2 * static_cast<uint64_t>(max_distance_s * fs), max_distance_s, complete), 0);
+    EXPECT_TRUE(complete);
+
+    // invalid words are skipped, and a new satellite replaces the old one
+    symbols = epoch_gather_test_symbols(fs, 0.0, 0.0115, 3);
+    symbols[0].Flag_valid_word = false;
+    symbols[1].PRN = 9;
+    symbols[2].PRN = 9;
+    complete = false;
+    EXPECT_EQ(gather.read(0, symbols.data(), 3, 50000, max_distance_s, complete), 2);
+    EXPECT_TRUE(complete);
+    EXPECT_EQ(gather.latest(0).PRN, 9U);
+    EXPECT_EQ(gather.latest(0).Tracking_sample_counter, symbols[1].Tracking_sample_counter);
+}
@@ -0,0 +1,152 @@
+/*!
+ * \file gnss_synchro_history_test.cc
+ * \brief  Tests the interpolation of the observables history against a
+ * linear search in a Gnss_circular_deque of Gnss_Synchro objects.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_circular_deque.h"
+#include "gnss_synchro.h"
+#include "gnss_synchro_history.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <vector>
+
+
+namespace
+{
+// nearest element and its neighbor, searched as the observables block did
+bool linear_search_neighbors(const Gnss_circular_deque<Gnss_Synchro> &history, uint32_t ch, uint64_t rx_clock, double max_distance_s, int32_t &t1_idx, int32_t &t2_idx, int32_t &nearest_element)
+{
+    nearest_element = -1;
+    int64_t old_abs_diff = std::numeric_limits<int64_t>::max();
+    for (uint32_t i = 0; i < history.size(ch); i++)
+        {
+            const int64_t abs_diff = llabs(static_cast<int64_t>(rx_clock) - static_cast<int64_t>(history.get(ch, i).Tracking_sample_counter));
+            if (old_abs_diff > abs_diff)
+                {
+                    old_abs_diff = abs_diff;
+                    nearest_element = static_cast<int32_t>(i);
+                }
+        }
+    if (nearest_element == -1 or (static_cast<double>(old_abs_diff) / static_cast<double>(history.get(ch, nearest_element).fs)) >= max_distance_s)
+        {
+            return false;
+        }
+    const bool after = rx_clock > history.get(ch, nearest_element).Tracking_sample_counter;
+    const int32_t neighbor_element = after ? nearest_element + 1 : nearest_element - 1;
+    if (neighbor_element >= static_cast<int32_t>(history.size(ch)) or neighbor_element < 0)
+        {
+            return false;
+        }
+    t1_idx = after ? nearest_element : neighbor_element;
+    t2_idx = after ? neighbor_element : nearest_element;
+    return true;
+}
+}  // namespace
+
+
+TEST(GnssSynchroHistoryTest, SameResultsAsLinearSearch)
+{
+    const uint32_t n_channels = 3;
+    const uint32_t max_size = 50;
+    const double max_distance_s = 0.02;
+    const int64_t fs = 4000000;
+    std::default_random_engine e1(1234);
+    std::uniform_int_distribution<int64_t> step(fs / 1000 - 10, fs / 1000 + 10);
+    std::uniform_int_distribution<int64_t> offset(-fs / 100, 3 * fs / 100);
+
+    Gnss_Synchro_History history(max_size, n_channels);
+    Gnss_circular_deque<Gnss_Synchro> reference(max_size, n_channels);
+    std::vector<uint64_t> sample_counter(n_channels, 0);
+    for (int epoch = 0; epoch < 300; epoch++)
+        {
+            for (uint32_t ch = 0; ch < n_channels; ch++)
+                {
+                    // the channels have different symbol rates
+                    if (epoch % (ch + 1) != 0)
+                        {
+                            continue;
+                        }
+                    sample_counter[ch] += static_cast<uint64_t>(step(e1) * (ch + 1));
+                    Gnss_Synchro synchro{};
+                    synchro.fs = fs;
+                    synchro.PRN = ch + 1;
+                    synchro.Tracking_sample_counter = sample_counter[ch];
+                    synchro.Code_phase_samples = 0.25 * ch;
+                    synchro.Carrier_phase_rads = 0.1 * epoch;
+                    synchro.Carrier_Doppler_hz = 1000.0 + epoch;
+                    synchro.TOW_at_current_symbol_ms = 100 * epoch;
+                    const double rx_time = (static_cast<double>(synchro.Tracking_sample_counter) + synchro.Code_phase_samples) / static_cast<double>(fs);
+                    history.push_back(ch, synchro, rx_time);
+                    reference.push_back(ch, synchro);
+                    reference.back(ch).RX_time = rx_time;
+                    ASSERT_EQ(history.size(ch), reference.size(ch));
+                    EXPECT_EQ(history.front(ch).Tracking_sample_counter, reference.front(ch).Tracking_sample_counter);
+                }
+
+            for (uint32_t ch = 0; ch < n_channels; ch++)
+                {
+                    const auto rx_clock = static_cast<uint64_t>(std::max<int64_t>(static_cast<int64_t>(sample_counter[0]) + offset(e1), 0));
+                    Gnss_Synchro interpolated{};
+                    int32_t t1;
+                    int32_t t2;
+                    int32_t nearest;
+                    const bool expected = linear_search_neighbors(reference, ch, rx_clock, max_distance_s, t1, t2, nearest);
+                    ASSERT_EQ(history.interpolate(ch, rx_clock, max_distance_s, interpolated), expected);
+                    if (expected)
+                        {
+                            const Gnss_Synchro &s1 = reference.get(ch, t1);
+                            const Gnss_Synchro &s2 = reference.get(ch, t2);
+                            const double time_factor = (static_cast<double>(rx_clock) / static_cast<double>(fs) - s1.RX_time) / (s2.RX_time - s1.RX_time);
+                            EXPECT_EQ(interpolated.Tracking_sample_counter, reference.get(ch, nearest).Tracking_sample_counter);
+                            EXPECT_DOUBLE_EQ(interpolated.Carrier_phase_rads, s1.Carrier_phase_rads + (s2.Carrier_phase_rads - s1.Carrier_phase_rads) * time_factor);
+                            EXPECT_DOUBLE_EQ(interpolated.Carrier_Doppler_hz, s1.Carrier_Doppler_hz + (s2.Carrier_Doppler_hz - s1.Carrier_Doppler_hz) * time_factor);
+                            EXPECT_DOUBLE_EQ(interpolated.interp_TOW_ms, s1.TOW_at_current_symbol_ms + (static_cast<double>(s2.TOW_at_current_symbol_ms) - s1.TOW_at_current_symbol_ms) * time_factor);
+                        }
+                }
+        }
+
+    history.clear(1);
+    EXPECT_EQ(history.size(1), 0U);
+    Gnss_Synchro interpolated{};
+    EXPECT_FALSE(history.interpolate(1, sample_counter[1], max_distance_s, interpolated));
+}
+
+
+TEST(GnssSynchroHistoryTest, EpochComplete)
+{
+    const int64_t fs = 4000000;
+    const double max_distance_s = 0.02;
+    Gnss_Synchro_History history(100, 2);
+    EXPECT_TRUE(history.is_complete(0, 40000, max_distance_s));
+
+    Gnss_Synchro synchro{};
+    synchro.fs = fs;
+    synchro.Tracking_sample_counter = 36000;
+    history.push_back(0, synchro, static_cast<double>(synchro.Tracking_sample_counter) / fs);
+    // the next element can still arrive
+    EXPECT_FALSE(history.is_complete(0, 40000, max_distance_s));
+    // the epoch is covered
+    EXPECT_TRUE(history.is_complete(0, 36000, max_distance_s));
+    // the channel is too far behind to ever interpolate the epoch
+    EXPECT_TRUE(history.is_complete(0, 36000 + 2 * static_cast<uint64_t>(max_distance_s * fs), max_distance_s));
+    EXPECT_TRUE(history.is_complete(1, 40000, max_distance_s));
+
+    synchro.Tracking_sample_counter = 40000;
+    history.push_back(0, synchro, static_cast<double>(synchro.Tracking_sample_counter) / fs);
+    EXPECT_TRUE(history.is_complete(0, 40000, max_distance_s));
+}
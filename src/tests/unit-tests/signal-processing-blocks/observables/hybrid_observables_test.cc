@@ -30,6 +30,7 @@
 #include "gnss_block_factory.h"
 #include "gnss_block_interface.h"
 #include "gnss_satellite.h"
+#include "gnss_sample_clock.h"
 #include "gnss_sdr_sample_counter.h"
 #include "gnss_synchro.h"
 #include "gnuplot_i.h"
@@ -1845,8 +1846,9 @@ TEST_F(HybridObservablesTest, ValidationOfResults)
     auto top_block_tlm = gr::make_top_block("Telemetry_Decoder test");
     auto dummy_msg_rx_trk = HybridObservablesTest_msg_rx_make();
     auto dummy_tlm_msg_rx = HybridObservablesTest_tlm_msg_rx_make();
-    // Observables
-    std::shared_ptr<ObservablesInterface> observables = std::make_shared<HybridObservables>(config.get(), "Observables", tracking_ch_vec.size() + 1, tracking_ch_vec.size());
+    // Observables, with the epochs of the sample counter created below
+    Gnss_Sample_Clock::set_global_instance(std::make_shared<Gnss_Sample_Clock>());
+    std::shared_ptr<ObservablesInterface> observables = std::make_shared<HybridObservables>(config.get(), "Observables", tracking_ch_vec.size(), tracking_ch_vec.size());
 
     for (auto& n : tracking_ch_vec)
         {
@@ -1881,8 +1883,6 @@ TEST_F(HybridObservablesTest, ValidationOfResults)
                 top_block_tlm->msg_connect(tracking_ch_vec.at(n)->get_right_block(), pmt::mp("events"), dummy_msg_rx_trk, pmt::mp("events"));
                 top_block_tlm->connect(observables->get_right_block(), n, null_sink_vec.at(n), 0);
             }
-        // connect sample counter and timmer to the last channel in observables block (extra channel)
-        top_block_tlm->connect(samp_counter, 0, observables->get_left_block(), tracking_ch_vec.size());
 
         file_source->seek(2 * FLAGS_skip_samples, 0);  // skip head. ibyte, two bytes per complex sample
     }) << "Failure connecting the blocks.";
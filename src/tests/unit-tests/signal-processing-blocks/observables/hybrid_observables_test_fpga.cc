@@ -30,6 +30,7 @@
 #include "gnss_block_factory.h"
 #include "gnss_block_interface.h"
 #include "gnss_satellite.h"
+#include "gnss_sample_clock.h"
 #include "gnss_sdr_sample_counter.h"
 #include "gnss_synchro.h"
 #include "gnuplot_i.h"
@@ -1980,8 +1981,9 @@ TEST_F(HybridObservablesTestFpga, ValidationOfResults)
     top_block = gr::make_top_block("Telemetry_Decoder test");
     auto dummy_msg_rx_trk = HybridObservablesTest_msg_rx_Fpga_make();
     auto dummy_tlm_msg_rx = HybridObservablesTest_tlm_msg_rx_Fpga_make();
-    // Observables
-    std::shared_ptr<ObservablesInterface> observables(new HybridObservables(config.get(), "Observables", tracking_ch_vec.size() + 1, tracking_ch_vec.size()));
+    // Observables, with the epochs of the sample counter created below
+    Gnss_Sample_Clock::set_global_instance(std::make_shared<Gnss_Sample_Clock>());
+    std::shared_ptr<ObservablesInterface> observables(new HybridObservables(config.get(), "Observables", tracking_ch_vec.size(), tracking_ch_vec.size()));
 
     for (auto& n : tracking_ch_vec)
         {
@@ -2016,8 +2018,8 @@ TEST_F(HybridObservablesTestFpga, ValidationOfResults)
                 top_block->msg_connect(tracking_ch_vec.at(n)->get_right_block(), pmt::mp("events"), dummy_msg_rx_trk, pmt::mp("events"));
                 top_block->connect(observables->get_right_block(), n, null_sink_vec.at(n), 0);
             }
-        // connect sample counter and timmer to the last channel in observables block (extra channel)
-        top_block->connect(ch_out_fpga_sample_counter, 0, observables->get_left_block(), tracking_ch_vec.size());  // extra port for the sample counter pulse
+        // the sample counter publishes the epochs of the observables, its pulses are discarded
+        top_block->connect(ch_out_fpga_sample_counter, 0, gr::blocks::null_sink::make(sizeof(Gnss_Synchro)), 0);
     }) << "Failure connecting the blocks.";
 
     top_block->start();
@@ -0,0 +1,99 @@
+/*!
+ * \file obs_kernels_test.cc
+ * \brief  Tests the pseudorange and carrier smoothing kernels against the
+ * computation of the observables block, made channel by channel.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "MATH_CONSTANTS.h"
+#include "obs_kernels.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+
+TEST(ObsKernelsTest, SameResultsAsScalarCode)
+{
+    const uint32_t n_channels = 37;
+    const double M = 100.0;
+    std::default_random_engine e1(4321);
+    std::uniform_real_distribution<double> traveltime_ms(65.0, 85.0);
+    std::uniform_real_distribution<double> phase_step(-1000.0, 1000.0);
+    std::bernoulli_distribution valid(0.8);
+
+    std::vector<double> wavelength_m(n_channels);
+    std::vector<double> carrier_phase(n_channels, 0.0);
+    std::vector<double> last_pseudorange(n_channels, 0.0);
+    std::vector<double> last_phase(n_channels, 0.0);
+    std::vector<uint8_t> last_valid(n_channels, 0);
+    std::vector<double> ref_last_pseudorange(n_channels, 0.0);
+    std::vector<double> ref_last_phase(n_channels, 0.0);
+    std::vector<bool> ref_last_valid(n_channels, false);
+    for (uint32_t i = 0; i < n_channels; i++)
+        {
+            wavelength_m[i] = SPEED_OF_LIGHT_M_S / (1.2e9 + 1.0e7 * i);
+        }
+
+    uint32_t rx_tow_ms = 604800000 - 2000;
+    for (int epoch = 0; epoch < 200; epoch++)
+        {
+            std::vector<double> interp_tow_ms(n_channels);
+            std::vector<uint8_t> valid_word(n_channels);
+            std::vector<uint8_t> valid_pseudorange(n_channels, 0);
+            std::vector<double> pseudorange(n_channels, -1.0);
+            for (uint32_t i = 0; i < n_channels; i++)
+                {
+                    interp_tow_ms[i] = std::fmod(rx_tow_ms - traveltime_ms(e1) + 604800000.0, 604800000.0);
+                    valid_word[i] = valid(e1);
+                    carrier_phase[i] += phase_step(e1);
+                }
+            std::vector<double> ref_pseudorange = pseudorange;
+            std::vector<uint8_t> ref_valid_pseudorange = valid_pseudorange;
+
+            obs_compute_pseudoranges(static_cast<double>(rx_tow_ms), valid_word.data(), interp_tow_ms.data(), pseudorange.data(), valid_pseudorange.data(), n_channels);
+            obs_smooth_pseudoranges(M, valid_pseudorange.data(), wavelength_m.data(), carrier_phase.data(), pseudorange.data(), last_valid.data(), last_pseudorange.data(), last_phase.data(), n_channels);
+
+            for (uint32_t i = 0; i < n_channels; i++)
+                {
+                    if (valid_word[i])
+                        {
+                            double ref_traveltime_ms = static_cast<double>(rx_tow_ms) - interp_tow_ms[i];
+                            if (std::fabs(ref_traveltime_ms) > 302400)
+                                {
+                                    ref_traveltime_ms = 604800000.0 + static_cast<double>(rx_tow_ms) - interp_tow_ms[i];
+                                }
+                            ref_pseudorange[i] = ref_traveltime_ms * SPEED_OF_LIGHT_M_MS;
+                            ref_valid_pseudorange[i] = true;
+                        }
+                    if (ref_valid_pseudorange[i])
+                        {
+                            if (ref_last_valid[i])
+                                {
+                                    const double factor = ((M - 1.0) / M);
+                                    ref_pseudorange[i] = factor * ref_last_pseudorange[i] + (1.0 / M) * ref_pseudorange[i] + wavelength_m[i] * (factor / TWO_PI) * (carrier_phase[i] - ref_last_phase[i]);
+                                }
+                            ref_last_pseudorange[i] = ref_pseudorange[i];
+                            ref_last_phase[i] = carrier_phase[i];
+                            ref_last_valid[i] = true;
+                        }
+                    else
+                        {
+                            ref_last_valid[i] = false;
+                        }
+                    EXPECT_EQ(valid_pseudorange[i], ref_valid_pseudorange[i]);
+                    EXPECT_DOUBLE_EQ(pseudorange[i], ref_pseudorange[i]) << "epoch " << epoch << ", channel " << i;
+                }
+            rx_tow_ms = (rx_tow_ms + 20) % 604800000;
+        }
+}
@@ -0,0 +1,255 @@
+/*!
+ * \file attitude_solver_test.cc
+ * \brief Tests of the heading and pitch from the baselines between the
+ * antennas of a receiver
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "MATH_CONSTANTS.h"
+#include "attitude_solver.h"
+#include "gnss_frequencies.h"
+#include "gnss_synchro.h"
+#include "gps_ephemeris.h"
+#include "rtklib_conversions.h"
+#include "rtklib_ephemeris.h"
+#include "rtklib_rtkcmn.h"
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <vector>
+
+
+namespace
+{
+const int ATTITUDE_TEST_WEEK = 2200;
+const double ATTITUDE_TEST_TOW = 345600.0;
+
+
+// 24 satellites in 6 circular orbital planes
+std::vector<eph_t> attitude_test_constellation()
+{
+    std::vector<eph_t> constellation;
+    for (int prn = 1; prn <= 24; prn++)
+        {
+            Gps_Ephemeris eph;
+            eph.PRN = static_cast<uint32_t>(prn);
+            eph.sqrtA = std::sqrt(26560000.0);
+            eph.i_0 = 55.0 * D2R;
+            eph.OMEGA_0 = ((prn - 1) % 6) * 60.0 * D2R;
+            eph.M_0 = ((prn - 1) / 6) * 90.0 * D2R + ((prn - 1) % 6) * 15.0 * D2R;
+            eph.af0 = 1e-5 * (prn % 7);
+            eph.WN = ATTITUDE_TEST_WEEK;
+            eph.toe = 345600;
+            eph.toc = 345600;
+            eph.tow = 345000;
+            constellation.push_back(eph_to_rtklib(eph, false));
+        }
+    return constellation;
+}
+
+
+// pseudorange from the satellite of eph to rr, received at t, and elevation of the satellite
+double attitude_test_pseudorange(const eph_t& eph, const gtime_t& t, const double* rr, double* elevation)
+{
+    std::array<double, 6> rs{};
+    std::array<double, 3> e{};
+    std::array<double, 3> pos{};
+    std::array<double, 2> azel{};
+    double dts = 0.0;
+    double var = 0.0;
+    double range = 0.0;
+    double travel_time_s = 0.075;
+    for (int i = 0; i < 5; i++)
+        {
+            eph2pos(timeadd(t, -travel_time_s), &eph, rs.data(), &dts, &var);
+            range = geodist(rs.data(), rr, e.data());
+            travel_time_s = range / SPEED_OF_LIGHT_M_S + dts;
+        }
+    ecef2pos(rr, pos.data());
+    satazel(pos.data(), e.data(), azel.data());
+    *elevation = azel[1];
+    return range - SPEED_OF_LIGHT_M_S * dts;
+}
+
+
+// processing options of a single-frequency GPS receiver
+prcopt_t attitude_test_options()
+{
+    prcopt_t opt{};
+    opt.mode = PMODE_KINEMA;
+    opt.nf = 1;
+    opt.navsys = SYS_GPS;
+    opt.elmin = 10.0 * D2R;
+    opt.modear = ARMODE_CONT;
+    opt.maxout = 5;
+    opt.minfix = 10;
+    opt.armaxiter = 1;
+    opt.niter = 1;
+    opt.eratio[0] = 100.0;
+    opt.err[0] = 100.0;
+    opt.err[1] = 0.003;
+    opt.err[2] = 0.003;
+    opt.err[4] = 1.0;
+    opt.std[0] = 30.0;
+    opt.std[1] = 0.03;
+    opt.std[2] = 0.3;
+    opt.prn[0] = 1e-4;
+    opt.prn[1] = 1e-3;
+    opt.prn[2] = 1e-4;
+    opt.prn[3] = 10.0;
+    opt.prn[4] = 10.0;
+    opt.sclkstab = 5e-12;
+    opt.thresar[0] = 3.0;
+    opt.thresar[1] = 0.9999;
+    opt.thresar[2] = 0.25;
+    opt.thresar[3] = 0.1;
+    opt.thresar[4] = 0.05;
+    opt.thresslip = 0.05;
+    opt.maxtdiff = 30.0;
+    opt.maxinno = 30.0;
+    opt.maxgdop = 30.0;
+    return opt;
+}
+
+
+// ECEF baseline of the given heading, pitch and length at the position of lla
+std::array<double, 3> attitude_test_baseline(const std::array<double, 3>& lla, double heading_deg, double pitch_deg, double length_m)
+{
+    const std::array<double, 3> enu{length_m * std::cos(pitch_deg * D2R) * std::sin(heading_deg * D2R),
+        length_m * std::cos(pitch_deg * D2R) * std::cos(heading_deg * D2R),
+        length_m * std::sin(pitch_deg * D2R)};
+    std::array<double, 3> ecef{};
+    enu2ecef(lla.data(), enu.data(), ecef.data());
+    return ecef;
+}
+}  // namespace
+
+
+TEST(AttitudeSolverTest, HeadingAndPitchOfTheBaseline)
+{
+    const std::array<double, 3> lla{41.2750 * D2R, 1.9875 * D2R, 50.0};
+    std::array<double, 3> rb{};
+    pos2ecef(lla.data(), rb.data());
+
+    const std::array<std::array<double, 3>, 4> cases{{{30.0, 0.0, 1.0}, {135.0, 10.0, 2.5}, {270.0, -5.0, 0.8}, {359.0, 45.0, 1.5}}};
+    for (const auto& c : cases)
+        {
+            Attitude_Solution solution;
+            solution.baseline_ecef = attitude_test_baseline(lla, c[0], c[1], c[2]);
+            Attitude_Solver::baseline_attitude(rb.data(), solution);
+            EXPECT_NEAR(solution.heading_deg, c[0], 1e-6);
+            EXPECT_NEAR(solution.pitch_deg, c[1], 1e-6);
+            EXPECT_NEAR(solution.length_m, c[2], 1e-9);
+            EXPECT_NEAR(solution.baseline_enu[2], c[2] * std::sin(c[1] * D2R), 1e-9);
+        }
+}
+
+
+TEST(AttitudeSolverTest, FixesTheBaselinesOfTwoAntennas)
+{
+    std::vector<eph_t> constellation = attitude_test_constellation();
+    nav_t nav{};
+    nav.eph = constellation.data();
+    nav.n = static_cast<int>(constellation.size());
+    for (int i = 0; i < MAXSAT; i++)
+        {
+            nav.lam[i][0] = SPEED_OF_LIGHT_M_S / FREQ1;
+        }
+
+    const std::array<double, 3> lla{41.2750 * D2R, 1.9875 * D2R, 50.0};
+    sol_t base_sol{};
+    pos2ecef(lla.data(), base_sol.rr);
+    const std::array<double, 3> heading_deg{0.0, 30.0, 300.0};
+    const std::array<double, 3> pitch_deg{0.0, 0.0, 5.0};
+    const std::array<double, 3> length_m{0.0, 1.2, 0.8};
+
+    Attitude_Solver solver(attitude_test_options(), 3);
+    EXPECT_EQ(solver.n_antennas(), 3U);
+
+    std::vector<Attitude_Solution> solutions;
+    for (int epoch = 0; epoch < 20; epoch++)
+        {
+            const double tow = ATTITUDE_TEST_TOW + 0.05 * epoch;
+            const gtime_t t = gpst2time(ATTITUDE_TEST_WEEK, tow);
+            std::vector<obsd_t> base_obs;
+            std::vector<std::map<int, Gnss_Synchro>> antenna_observables(2);
+            for (const auto& eph : constellation)
+                {
+                    for (int a = 0; a < 3; a++)
+                        {
+                            const std::array<double, 3> baseline = attitude_test_baseline(lla, heading_deg[a], pitch_deg[a], length_m[a]);
+                            const std::array<double, 3> rr{base_sol.rr[0] + baseline[0], base_sol.rr[1] + baseline[1], base_sol.rr[2] + baseline[2]};
+                            double elevation = 0.0;
+                            const double pseudorange_m = attitude_test_pseudorange(eph, t, rr.data(), &elevation);
+                            const double carrier_phase_cycles = pseudorange_m / nav.lam[0][0] + 1000.0 * eph.sat + 17.0 * a;  // integer ambiguities
+                            if (elevation < 15.0 * D2R)
+                                {
+                                    break;
+                                }
+                            if (a == 0)
+                                {
+                                    obsd_t obs{};
+                                    obs.time = t;
+                                    obs.sat = static_cast<unsigned char>(eph.sat);
+                                    obs.rcv = 1;
+                                    obs.P[0] = pseudorange_m;
+                                    obs.L[0] = carrier_phase_cycles;
+                                    obs.SNR[0] = static_cast<unsigned char>(45.0 / 0.25);
+                                    obs.code[0] = CODE_L1C;
+                                    base_obs.push_back(obs);
+                                }
+                            else
+                                {
+                                    Gnss_Synchro synchro{};
+                                    synchro.System = 'G';
+                                    std::strcpy(synchro.Signal, "1C");
+                                    synchro.PRN = static_cast<uint32_t>(eph.sat);
+                                    synchro.Pseudorange_m = pseudorange_m;
+                                    synchro.Carrier_phase_rads = carrier_phase_cycles * TWO_PI;
+                                    synchro.CN0_dB_hz = 45.0;
+                                    synchro.RX_time = tow;
+                                    synchro.Flag_valid_pseudorange = true;
+                                    antenna_observables[a - 1][eph.sat] = synchro;
+                                }
+                        }
+                }
+            ASSERT_GE(base_obs.size(), 6U);
+            solutions = solver.solve(base_obs.data(), static_cast<int>(base_obs.size()), &nav, base_sol, antenna_observables);
+        }
+
+    ASSERT_EQ(solutions.size(), 2U);
+    for (const auto& solution : solutions)
+        {
+            const uint32_t a = solution.antenna;
+            ASSERT_TRUE(a == 1 || a == 2);
+            EXPECT_EQ(solution.status, SOLQ_FIX) << "antenna " << a;
+            EXPECT_NEAR(solution.length_m, length_m[a], 0.005) << "antenna " << a;
+            EXPECT_NEAR(solution.heading_deg, heading_deg[a], 0.5) << "antenna " << a;
+            EXPECT_NEAR(solution.pitch_deg, pitch_deg[a], 0.5) << "antenna " << a;
+            EXPECT_GE(solution.satellites, 5U);
+        }
+}
+
+
+TEST(AttitudeSolverTest, NoSolutionWithoutTheMainAntenna)
+{
+    Attitude_Solver solver(attitude_test_options(), 2);
+    nav_t nav{};
+    sol_t base_sol{};
+    std::vector<std::map<int, Gnss_Synchro>> antenna_observables(1);
+    const std::vector<Attitude_Solution>& solutions = solver.solve(nullptr, 0, &nav, base_sol, antenna_observables);
+    ASSERT_EQ(solutions.size(), 1U);
+    EXPECT_EQ(solutions[0].status, SOLQ_NONE);
+    EXPECT_EQ(solutions[0].antenna, 1U);
+}
@@ -0,0 +1,112 @@
+/*!
+ * \file monitor_pvt_packet_test.cc
+ * \brief Implements Unit Tests for the binary packets of Monitor_Pvt
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "monitor_pvt_packet.h"
+#include <array>
+#include <cstring>
+#include <vector>
+
+
+namespace
+{
+Monitor_Pvt monitor_pvt_packet_sample()
+{
+    Monitor_Pvt monitor_pvt{};
+    monitor_pvt.TOW_at_current_symbol_ms = 345600123;
+    monitor_pvt.week = 2200;
+    monitor_pvt.RX_time = 345600.123;
+    monitor_pvt.user_clk_offset = -1.25e-4;
+    monitor_pvt.pos_x = 4796983.5;
+    monitor_pvt.pos_y = 160308.75;
+    monitor_pvt.pos_z = 4187663.125;
+    monitor_pvt.vel_z = -0.03;
+    monitor_pvt.cov_xy = 2.5;
+    monitor_pvt.latitude = 41.27;
+    monitor_pvt.longitude = 1.98;
+    monitor_pvt.height = 82.5;
+    monitor_pvt.valid_sats = 11;
+    monitor_pvt.solution_status = 5;
+    monitor_pvt.solution_type = 1;
+    monitor_pvt.AR_ratio_factor = 3.5F;
+    monitor_pvt.AR_ratio_threshold = 3.0F;
+    monitor_pvt.gdop = 1.9;
+    monitor_pvt.vdop = 1.4;
+    monitor_pvt.user_clk_drift_ppm = -0.2;
+    monitor_pvt.latency_ms = 12.5;
+    monitor_pvt.skipped_epochs = 0x0102030405060708ULL;
+    return monitor_pvt;
+}
+}  // namespace
+
+
+TEST(MonitorPvtPacketTest, EncodeDecode)
+{
+    const Monitor_Pvt monitor_pvt = monitor_pvt_packet_sample();
+    std::vector<uint8_t> packet(Monitor_Pvt_Packet::LENGTH + 1, 0xEE);
+    Monitor_Pvt_Packet::encode(monitor_pvt, packet.data());
+    EXPECT_EQ(packet.back(), 0xEE);  // nothing written after the packet
+    EXPECT_EQ(packet[0], 0x47);
+    EXPECT_EQ(packet[1], 0x53);
+    EXPECT_EQ(packet[2], Monitor_Pvt_Packet::VERSION);
+    EXPECT_EQ(packet[3] + 256 * packet[4], static_cast<int>(Monitor_Pvt_Packet::PAYLOAD_LENGTH));
+    // first field, little endian
+    EXPECT_EQ(packet[5] + (packet[6] << 8) + (packet[7] << 16) + (packet[8] << 24), 345600123);
+
+    Monitor_Pvt decoded{};
+    ASSERT_TRUE(Monitor_Pvt_Packet::decode(packet.data(), Monitor_Pvt_Packet::LENGTH, decoded));
+    EXPECT_EQ(decoded.TOW_at_current_symbol_ms, monitor_pvt.TOW_at_current_symbol_ms);
+    EXPECT_EQ(decoded.week, monitor_pvt.week);
+    EXPECT_EQ(decoded.RX_time, monitor_pvt.RX_time);
+    EXPECT_EQ(decoded.user_clk_offset, monitor_pvt.user_clk_offset);
+    EXPECT_EQ(decoded.pos_x, monitor_pvt.pos_x);
+    EXPECT_EQ(decoded.pos_y, monitor_pvt.pos_y);
+    EXPECT_EQ(decoded.pos_z, monitor_pvt.pos_z);
+    EXPECT_EQ(decoded.vel_z, monitor_pvt.vel_z);
+    EXPECT_EQ(decoded.cov_xy, monitor_pvt.cov_xy);
+    EXPECT_EQ(decoded.latitude, monitor_pvt.latitude);
+    EXPECT_EQ(decoded.longitude, monitor_pvt.longitude);
+    EXPECT_EQ(decoded.height, monitor_pvt.height);
+    EXPECT_EQ(decoded.valid_sats, monitor_pvt.valid_sats);
+    EXPECT_EQ(decoded.solution_status, monitor_pvt.solution_status);
+    EXPECT_EQ(decoded.solution_type, monitor_pvt.solution_type);
+    EXPECT_EQ(decoded.AR_ratio_factor, monitor_pvt.AR_ratio_factor);
+    EXPECT_EQ(decoded.AR_ratio_threshold, monitor_pvt.AR_ratio_threshold);
+    EXPECT_EQ(decoded.gdop, monitor_pvt.gdop);
+    EXPECT_EQ(decoded.vdop, monitor_pvt.vdop);
+    EXPECT_EQ(decoded.user_clk_drift_ppm, monitor_pvt.user_clk_drift_ppm);
+    EXPECT_EQ(decoded.latency_ms, monitor_pvt.latency_ms);
+    EXPECT_EQ(decoded.skipped_epochs, monitor_pvt.skipped_epochs);
+    // last field, little endian
+    EXPECT_EQ(packet[Monitor_Pvt_Packet::HEADER_LENGTH + Monitor_Pvt_Packet::PAYLOAD_LENGTH - 1], 0x01);
+}
+
+
+TEST(MonitorPvtPacketTest, RejectsCorruptedPackets)
+{
+    const std::array<uint8_t, 9> check_string = {{'1', '2', '3', '4', '5', '6', '7', '8', '9'}};
+    EXPECT_EQ(Monitor_Pvt_Packet::crc16(check_string.data(), check_string.size()), 0x29B1);
+
+    std::vector<uint8_t> packet(Monitor_Pvt_Packet::LENGTH);
+    Monitor_Pvt_Packet::encode(monitor_pvt_packet_sample(), packet.data());
+    Monitor_Pvt decoded{};
+    EXPECT_FALSE(Monitor_Pvt_Packet::decode(packet.data(), packet.size() - 1, decoded));
+    for (const std::size_t byte : {std::size_t(0), std::size_t(2), std::size_t(3), std::size_t(100), Monitor_Pvt_Packet::LENGTH - 1})
+        {
+            std::vector<uint8_t> corrupted = packet;
+            corrupted[byte] ^= 0x10;
+            EXPECT_FALSE(Monitor_Pvt_Packet::decode(corrupted.data(), corrupted.size(), decoded));
+        }
+    EXPECT_EQ(decoded.TOW_at_current_symbol_ms, 0U);  // unchanged
+}
@@ -0,0 +1,75 @@
+/*!
+ * \file moving_window_statistics_test.cc
+ * \brief Implements Unit Tests for the moving window mean and median
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "moving_window_statistics.h"
+#include <algorithm>
+#include <deque>
+#include <numeric>
+#include <random>
+#include <vector>
+
+
+TEST(MovingWindowStatisticsTest, SameAsRecomputed)
+{
+    std::default_random_engine generator(3);
+    std::normal_distribution<double> normal_dist(41.27, 1e-5);
+    std::uniform_int_distribution<int> repeated(0, 9);
+    for (const size_t depth : {1, 2, 5, 100})
+        {
+            Moving_Window_Statistics statistics(depth);
+            std::deque<double> window;
+            double previous = 0.0;
+            for (int n = 0; n < 1000; n++)
+                {
+                    // some repeated values, to check the removal of duplicates
+                    const double value = repeated(generator) == 0 ? previous : normal_dist(generator);
+                    previous = value;
+                    statistics.push(value);
+                    window.push_back(value);
+                    if (window.size() > depth)
+                        {
+                            window.pop_front();
+                        }
+                    ASSERT_EQ(statistics.size(), window.size());
+                    EXPECT_EQ(statistics.full(), window.size() == depth);
+
+                    const double mean = std::accumulate(window.begin(), window.end(), 0.0) / static_cast<double>(window.size());
+                    EXPECT_NEAR(statistics.mean(), mean, 1e-12);
+
+                    std::vector<double> sorted(window.begin(), window.end());
+                    std::sort(sorted.begin(), sorted.end());
+                    const size_t middle = sorted.size() / 2;
+                    const double median = sorted.size() % 2 == 1 ? sorted[middle] : (sorted[middle - 1] + sorted[middle]) / 2.0;
+                    EXPECT_EQ(statistics.median(), median);
+                }
+        }
+}
+
+
+TEST(MovingWindowStatisticsTest, MedianRejectsOutliers)
+{
+    Moving_Window_Statistics statistics(9);
+    for (int n = 0; n < 9; n++)
+        {
+            statistics.push(n % 3 == 0 ? 1000.0 : 10.0 + n);
+        }
+    EXPECT_DOUBLE_EQ(statistics.median(), 17.0);
+    EXPECT_GT(statistics.mean(), 300.0);
+
+    statistics.set_depth(3);
+    EXPECT_EQ(statistics.size(), 0U);
+    EXPECT_EQ(statistics.median(), 0.0);
+    EXPECT_EQ(statistics.mean(), 0.0);
+}
@@ -0,0 +1,64 @@
+/*!
+ * \file pvt_output_dispatcher_test.cc
+ * \brief Tests of the writer thread of the PVT output printers
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "pvt_output_dispatcher.h"
+#include <gtest/gtest.h>
+#include <future>
+#include <memory>
+#include <vector>
+
+
+TEST(PvtOutputDispatcherTest, WritesInOrder)
+{
+    std::vector<int> written;
+    {
+        Pvt_Output_Dispatcher dispatcher(100);
+        for (int i = 0; i < 50; i++)
+            {
+                EXPECT_TRUE(dispatcher.push([&written, i]() { written.push_back(i); }));
+            }
+        // the destructor writes the pending outputs
+    }
+    ASSERT_EQ(written.size(), 50U);
+    for (int i = 0; i < 50; i++)
+        {
+            EXPECT_EQ(written[i], i);
+        }
+}
+
+
+TEST(PvtOutputDispatcherTest, DropsWhenFull)
+{
+    std::promise<void> release;
+    std::shared_future<void> released(release.get_future());
+    std::promise<void> started;
+    int written = 0;
+    {
+        Pvt_Output_Dispatcher dispatcher(4);
+        // a slow output keeps the writer busy
+        EXPECT_TRUE(dispatcher.push([&started, released]() { started.set_value(); released.wait(); }));
+        started.get_future().wait();
+        for (int i = 0; i < 4; i++)
+            {
+                EXPECT_TRUE(dispatcher.push([&written]() { written++; }));
+            }
+        EXPECT_FALSE(dispatcher.push([&written]() { written++; }));
+        EXPECT_FALSE(dispatcher.push([&written]() { written++; }));
+        EXPECT_EQ(dispatcher.get_dropped(), 2U);
+        EXPECT_EQ(dispatcher.get_max_depth(), 4U);
+        release.set_value();
+    }
+    EXPECT_EQ(written, 4);
+}
@@ -0,0 +1,110 @@
+/*!
+ * \file pvt_text_output_test.cc
+ * \brief Implements Unit Tests for the line buffer and the output schedule of
+ * the KML, GPX, GeoJSON and NMEA printers
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "pvt_text_output.h"
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <array>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <string>
+
+
+namespace
+{
+std::string pvt_text_printf_fixed(double value, int precision)
+{
+    std::array<char, 512> text{};
+    std::snprintf(text.data(), text.size(), "%.*f", precision, value);
+    return std::string(text.data());
+}
+}  // namespace
+
+
+TEST(PvtTextOutputTest, FixedSameAsPrintf)
+{
+    std::default_random_engine generator(5);
+    std::uniform_real_distribution<double> degrees(-180.0, 180.0);
+    std::uniform_real_distribution<double> heights(-100.0, 10000.0);
+    std::uniform_int_distribution<int> precisions(0, 16);
+    Pvt_Text_Buffer buffer;
+    for (int n = 0; n < 100000; n++)
+        {
+            const int precision = precisions(generator);
+            for (const double value : {degrees(generator), heights(generator)})
+                {
+                    buffer.clear();
+                    buffer.append_fixed(value, precision);
+                    ASSERT_EQ(buffer.str(), pvt_text_printf_fixed(value, precision));
+                }
+        }
+
+    // ties, carries, signed zeros, and values handled by the fallback
+    for (const double value : {0.0, -0.0, 0.5, 1.5, 2.5, -2.5, 0.125, 9.9999999999999999, 0.999999999999999, 1e15, -3e20, std::numeric_limits<double>::infinity(), std::numeric_limits<double>::quiet_NaN()})
+        {
+            for (const int precision : {0, 1, 2, 14, 20})
+                {
+                    buffer.clear();
+                    buffer.append_fixed(value, precision);
+                    EXPECT_EQ(buffer.str(), pvt_text_printf_fixed(value, precision));
+                }
+        }
+}
+
+
+TEST(PvtTextOutputTest, IntegersAndAppends)
+{
+    Pvt_Text_Buffer buffer;
+    buffer.append("  ", 3).append('[').append_uint(0).append(", ").append_uint(18446744073709551615ULL).append(std::string("]"));
+    EXPECT_EQ(buffer.str(), "      [0, 18446744073709551615]");
+    EXPECT_EQ(buffer.size(), buffer.str().size());
+}
+
+
+TEST(PvtTextOutputTest, IsoTime)
+{
+    Pvt_Text_Buffer buffer;
+    const boost::posix_time::ptime time(boost::gregorian::date(2022, 3, 7), boost::posix_time::time_duration(4, 5, 6) + boost::posix_time::microseconds(789999));
+    buffer.append_iso_time(time);
+    EXPECT_EQ(buffer.str(), "2022-03-07T04:05:06.789Z");
+
+    buffer.clear();
+    buffer.append_iso_time(boost::posix_time::ptime(boost::gregorian::date(2022, 12, 31), boost::posix_time::time_duration(23, 59, 59)));
+    EXPECT_EQ(buffer.str(), "2022-12-31T23:59:59.000Z");
+}
+
+
+TEST(PvtTextOutputTest, Schedule)
+{
+    Pvt_Output_Schedule always(0, 0);
+    EXPECT_TRUE(always.flush_due());
+    EXPECT_TRUE(always.flush_due());
+    Pvt_Output_Schedule rarely(3600000, 0);
+    EXPECT_FALSE(rarely.flush_due());
+
+    const boost::posix_time::ptime start(boost::gregorian::date(2022, 3, 7), boost::posix_time::time_duration(10, 59, 0));
+    EXPECT_FALSE(always.rotation_due(start));
+    EXPECT_FALSE(always.rotation_due(start + boost::posix_time::hours(5)));
+
+    Pvt_Output_Schedule hourly(1000, 3600);
+    EXPECT_EQ(hourly.rotation_period_s(), 3600U);
+    EXPECT_FALSE(hourly.rotation_due(start));
+    EXPECT_FALSE(hourly.rotation_due(start + boost::posix_time::seconds(59)));
+    EXPECT_TRUE(hourly.rotation_due(start + boost::posix_time::seconds(60)));
+    EXPECT_FALSE(hourly.rotation_due(start + boost::posix_time::seconds(61)));
+    EXPECT_FALSE(hourly.rotation_due(boost::posix_time::ptime(boost::posix_time::not_a_date_time)));
+    EXPECT_TRUE(hourly.rotation_due(start + boost::posix_time::hours(2)));
+}
@@ -0,0 +1,135 @@
+/*!
+ * \file raw_obs_log_test.cc
+ * \brief Tests of the binary log of the observables and of the navigation data
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "galileo_utc_model.h"
+#include "gps_ephemeris.h"
+#include "raw_obs_log.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+TEST(RawObsLogTest, WriteAndRead)
+{
+    std::string filename;
+    {
+        Raw_Obs_Log log(".", "raw_obs_log_test", 7);
+        ASSERT_TRUE(log.is_open());
+        filename = log.get_filename();
+
+        auto eph = std::make_shared<Gps_Ephemeris>();
+        eph->PRN = 5;
+        eph->toe = 345600;
+        eph->sqrtA = 5153.7;
+        log.log_nav_product(Gnss_Nav_Product(eph));
+
+        for (int epoch = 0; epoch < 3; epoch++)
+            {
+                std::map<int, Gnss_Synchro> observables;
+                for (int ch = 0; ch < 4; ch++)
+                    {
+                        Gnss_Synchro gs;
+                        gs.System = 'G';
+                        std::memcpy(gs.Signal, "1C", 3);
+                        gs.PRN = ch + 1;
+                        gs.Channel_ID = ch;
+                        gs.Pseudorange_m = 2.0e7 + epoch * 100.0 + ch;
+                        gs.Carrier_phase_rads = -1.25e6 + ch;
+                        gs.Carrier_Doppler_hz = 1234.5;
+                        gs.CN0_dB_hz = 45.0;
+                        gs.Tracking_sample_counter = 4000000ULL * epoch + ch;
+                        gs.fs = 4000000;
+                        gs.Flag_valid_pseudorange = true;
+                        gs.Flag_PLL_180_deg_phase_locked = (ch == 2);
+                        observables[ch * 10] = gs;
+                    }
+                log.log_epoch(345600.0 + epoch, observables);
+            }
+
+        auto utc = std::make_shared<Galileo_Utc_Model>();
+        utc->A0 = 2.5e-9;
+        log.log_nav_product(Gnss_Nav_Product(utc));
+    }
+
+    uint32_t type_of_rx = 0;
+    std::vector<double> epochs;
+    std::map<int, Gnss_Synchro> last;
+    std::vector<Gnss_Nav_Product_Type> products;
+    std::shared_ptr<Gps_Ephemeris> eph;
+    const auto on_epoch = [&](double rx_time, const std::map<int, Gnss_Synchro>& observables) {
+        epochs.push_back(rx_time);
+        last = observables;
+        EXPECT_EQ(products.size(), 1U);  // in the order of the log
+    };
+    const auto on_nav_product = [&](const Gnss_Nav_Product& product) {
+        products.push_back(product.type());
+        if (product.type() == NAV_GPS_EPHEMERIS)
+            {
+                eph = product.get<Gps_Ephemeris>();
+            }
+    };
+    ASSERT_TRUE(Raw_Obs_Log::read(filename, type_of_rx, on_epoch, on_nav_product));
+    EXPECT_EQ(type_of_rx, 7U);
+    ASSERT_EQ(epochs.size(), 3U);
+    EXPECT_DOUBLE_EQ(epochs[2], 345602.0);
+    ASSERT_EQ(last.size(), 4U);
+    const Gnss_Synchro& gs = last.at(20);
+    EXPECT_EQ(gs.System, 'G');
+    EXPECT_STREQ(gs.Signal, "1C");
+    EXPECT_EQ(gs.PRN, 3U);
+    EXPECT_EQ(gs.Channel_ID, 2);
+    EXPECT_DOUBLE_EQ(gs.Pseudorange_m, 2.0e7 + 202.0);
+    EXPECT_DOUBLE_EQ(gs.Carrier_phase_rads, -1.25e6 + 2.0);
+    EXPECT_EQ(gs.Tracking_sample_counter, 8000002ULL);
+    EXPECT_EQ(gs.fs, 4000000);
+    EXPECT_TRUE(gs.Flag_valid_pseudorange);
+    EXPECT_TRUE(gs.Flag_PLL_180_deg_phase_locked);
+    EXPECT_FALSE(gs.Flag_valid_word);
+    ASSERT_EQ(products.size(), 2U);
+    EXPECT_EQ(products[1], NAV_GALILEO_UTC_MODEL);
+    ASSERT_NE(eph, nullptr);
+    EXPECT_EQ(eph->PRN, 5U);
+    EXPECT_DOUBLE_EQ(eph->sqrtA, 5153.7);
+
+    // a truncated tail is ignored
+    {
+        std::ifstream ifs(filename, std::ios::binary | std::ios::ate);
+        const auto size = static_cast<size_t>(ifs.tellg());
+        ifs.seekg(0);
+        std::vector<char> content(size);
+        ifs.read(content.data(), size);
+        std::ofstream ofs(filename, std::ios::binary | std::ios::trunc);
+        ofs.write(content.data(), size - 10);
+    }
+    epochs.clear();
+    products.clear();
+    EXPECT_TRUE(Raw_Obs_Log::read(filename, type_of_rx, on_epoch, on_nav_product));
+    EXPECT_EQ(epochs.size(), 3U);
+    EXPECT_EQ(products.size(), 1U);
+
+    // something else
+    {
+        std::ofstream ofs(filename, std::ios::binary | std::ios::trunc);
+        ofs << "not a raw observation log";
+    }
+    EXPECT_FALSE(Raw_Obs_Log::read(filename, type_of_rx, on_epoch, on_nav_product));
+    std::remove(filename.c_str());
+    EXPECT_FALSE(Raw_Obs_Log::read(filename, type_of_rx, on_epoch, on_nav_product));
+}
@@ -132,7 +132,8 @@ void RinexPrinterTest::conf()
         {{}, {}},                                                                          /*  odisp[2][6*11] ocean tide loading parameters {rov,base} */
         {{}, {{}, {}}, {{}, {}}, {}, {}},                                                  /*  exterr_t exterr   extended receiver error model */
         0,                                                                                 /* disable L2-AR */
-        {}                                                                                 /* char pppopt[256]   ppp option   "-GAP_RESION="  default gap to reset iono parameters (ep) */
+        {},                                                                                /* char pppopt[256]   ppp option   "-GAP_RESION="  default gap to reset iono parameters (ep) */
+        0                                                                                  /* min number of ambiguities fixed by partial AR (0:off) */
     };
 
     rtkinit(&rtk, &rtklib_configuration_options);
@@ -497,6 +498,63 @@ TEST_F(RinexPrinterTest, GalileoObsLog)
 }
 
 
+TEST_F(RinexPrinterTest, GalileoNavSkipsReducedCed)
+{
+    auto pvt_solution = std::make_shared<Rtklib_Solver>(rtk, "filename", false, false);
+    auto eph = Galileo_Ephemeris();
+    eph.PRN = 1;
+    pvt_solution->galileo_ephemeris_map[1] = eph;
+    // the reduced CED that gives the first fix
+    eph.PRN = 2;
+    eph.flag_reduced_ced = true;
+    pvt_solution->galileo_ephemeris_map[2] = eph;
+    std::map<int, Gnss_Synchro> gnss_observables_map;
+
+    Gnss_Synchro gs1 = Gnss_Synchro();
+    gs1.System = 'E';
+    std::string sig = "1B";
+    std::memcpy(static_cast<void*>(gs1.Signal), sig.c_str(), 3);
+    gs1.PRN = 1;
+    gs1.Pseudorange_m = 22000000;
+    gnss_observables_map.insert(std::pair<int, Gnss_Synchro>(1, gs1));
+
+    auto rp = std::make_shared<Rinex_Printer>();
+    rp->print_rinex_annotation(pvt_solution.get(),
+        gnss_observables_map,
+        0.0,
+        4,
+        true);
+
+    std::string obsfile = rp->get_obsfilename();
+    std::string navfile = rp->get_navfilename()[0];
+
+    rp = nullptr;  // close the RINEX files so we can inspect them
+
+    std::fstream fstr(navfile.c_str(), std::fstream::in);
+    std::string line_str;
+    int full_records = 0;
+    int reduced_records = 0;
+    while (std::getline(fstr, line_str))
+        {
+            if (line_str.find("E01", 0) == 0)
+                {
+                    full_records++;
+                }
+            if (line_str.find("E02", 0) == 0)
+                {
+                    reduced_records++;
+                }
+        }
+
+    // the header write logs the whole map, but not the reduced CED
+    EXPECT_EQ(1, full_records);
+    EXPECT_EQ(0, reduced_records);
+    fstr.close();
+    fs::remove(obsfile);
+    fs::remove(navfile);
+}
+
+
 TEST_F(RinexPrinterTest, GlonassObsLog)
 {
     std::string line_aux;
@@ -1010,3 +1068,75 @@ TEST_F(RinexPrinterTest, MixedObsLogGpsGlo)
     fs::remove(navfile);
     fs::remove(obsfile);
 }
+
+
+TEST_F(RinexPrinterTest, GpsObsHeaderUpdate)
+{
+    auto eph = Gps_Ephemeris();
+    eph.PRN = 1;
+    auto pvt_solution = std::make_shared<Rtklib_Solver>(rtk, "filename", false, false);
+    pvt_solution->gps_ephemeris_map[1] = eph;
+    std::map<int, Gnss_Synchro> gnss_observables_map;
+
+    Gnss_Synchro gs1 = Gnss_Synchro();
+    gs1.System = 'G';
+    std::string sig = "1C";
+    std::memcpy(static_cast<void*>(gs1.Signal), sig.c_str(), 3);
+    gs1.PRN = 3;
+    gs1.Pseudorange_m = 22000002.1;
+    gs1.Carrier_phase_rads = 45.4;
+    gs1.Carrier_Doppler_hz = 321;
+    gs1.CN0_dB_hz = 39;
+    gnss_observables_map.insert(std::pair<int, Gnss_Synchro>(1, gs1));
+
+    auto rp = std::make_shared<Rinex_Printer>();
+    rp->print_rinex_annotation(pvt_solution.get(),
+        gnss_observables_map,
+        0.0,
+        1,
+        true);
+
+    // The UTC model arrives after the header was written
+    pvt_solution->gps_utc_model.A0 = 1e-9;
+    pvt_solution->gps_utc_model.DeltaT_LS = 18;
+    rp->print_rinex_annotation(pvt_solution.get(),
+        gnss_observables_map,
+        1.0,
+        1,
+        true);
+
+    std::string obsfile = rp->get_obsfilename();
+    std::string navfile = rp->get_navfilename()[0];
+
+    rp = nullptr;  // close the RINEX files so we can inspect them
+
+    std::fstream fstr(obsfile.c_str(), std::fstream::in);
+    std::string line_str;
+    std::string leap_seconds_line;
+    int reserved_lines = 0;
+    int records = 0;
+    while (std::getline(fstr, line_str))
+        {
+            if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
+                {
+                    leap_seconds_line = line_str;
+                }
+            if (line_str == std::string(60, ' ') + "COMMENT             ")
+                {
+                    reserved_lines++;
+                }
+            if (line_str.find("G03", 0) == 0)
+                {
+                    records++;
+                }
+        }
+
+    // The reserved line was used for the LEAP SECONDS record, and the
+    // records that followed the header are kept
+    EXPECT_EQ(0, leap_seconds_line.compare(0, 6, "    18"));
+    EXPECT_EQ(0, reserved_lines);
+    EXPECT_EQ(2, records);
+    fstr.close();
+    fs::remove(navfile);
+    fs::remove(obsfile);
+}
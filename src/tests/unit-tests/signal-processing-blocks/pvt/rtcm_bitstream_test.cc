@@ -0,0 +1,107 @@
+/*!
+ * \file rtcm_bitstream_test.cc
+ * \brief Implements Unit Tests for the RTCM bit writer and reader
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "rtcm_bitstream.h"
+#include <bitset>
+#include <cstdint>
+#include <string>
+
+
+TEST(RtcmBitstreamTest, KnownFrame)
+{
+    // MT1005 example of the RTCM 10403.2 standard
+    const std::string data_hex("3ED7D30202980EDEEF34B4BD62AC0941986F33");
+    Rtcm_Bit_Writer writer;
+    for (std::size_t i = 0; i < data_hex.size(); i += 2)
+        {
+            writer.append(std::stoul(data_hex.substr(i, 2), nullptr, 16), 8);
+        }
+    EXPECT_EQ(writer.size(), 8 * data_hex.size() / 2);
+
+    const std::string message = writer.frame();
+    const std::string expected_hex("D300133ED7D30202980EDEEF34B4BD62AC0941986F33360B98");
+    ASSERT_EQ(message.size(), expected_hex.size() / 2);
+    for (std::size_t i = 0; i < message.size(); i++)
+        {
+            EXPECT_EQ(static_cast<uint8_t>(message[i]), std::stoul(expected_hex.substr(2 * i, 2), nullptr, 16));
+        }
+
+    Rtcm_Bit_Reader reader(message);
+    EXPECT_TRUE(reader.check_CRC());
+    std::string bad_message(message);
+    bad_message[bad_message.size() - 1] ^= 0x01;
+    EXPECT_FALSE(Rtcm_Bit_Reader(bad_message).check_CRC());
+    EXPECT_FALSE(Rtcm_Bit_Reader(std::string("\xD3\x00", 2)).check_CRC());
+
+    EXPECT_EQ(reader.get_uint(8), 0xD3U);
+    reader.skip(6);
+    EXPECT_EQ(reader.get_uint(10), 19U);
+    EXPECT_EQ(reader.get_uint(12), 1005U);
+}
+
+
+TEST(RtcmBitstreamTest, WriteAndRead)
+{
+    Rtcm_Bit_Writer writer;
+    writer.append(std::bitset<12>(1019));
+    writer.append(static_cast<uint64_t>(-5), 14);        // two's complement
+    writer.append(std::string("1") + std::string(4, '0') + "11");  // sign-magnitude -3
+    writer.append(0x123456789ABCDEF0ULL, 64);
+    writer.append(1, 1);
+    writer.append(std::string("0101"));
+    EXPECT_EQ(writer.size(), 12U + 14U + 7U + 64U + 1U + 4U);
+
+    const std::string message = writer.frame();
+    // The data is padded to 13 bytes
+    EXPECT_EQ(message.size(), 3U + 13U + 3U);
+
+    Rtcm_Bit_Reader reader(message);
+    EXPECT_TRUE(reader.check_CRC());
+    reader.skip(14);
+    EXPECT_EQ(reader.get_uint(10), 13U);
+    EXPECT_EQ(reader.get_uint(12), 1019U);
+    EXPECT_EQ(reader.get_int(14), -5);
+    EXPECT_EQ(reader.get_sint(7), -3);
+    EXPECT_EQ(reader.get_uint(64), 0x123456789ABCDEF0ULL);
+    EXPECT_EQ(reader.get_uint(1), 1U);
+    EXPECT_EQ(reader.get_uint(4), 5U);
+    EXPECT_EQ(reader.get_uint(2), 0U);  // padding
+
+    // Past the end of the message
+    reader.skip(static_cast<uint32_t>(reader.size()));
+    EXPECT_EQ(reader.get_uint(32), 0U);
+}
+
+
+TEST(RtcmBitstreamTest, AppendWriter)
+{
+    Rtcm_Bit_Writer column;
+    column.append(0x5, 3);
+    column.append(0x1FF, 9);
+    Rtcm_Bit_Writer writer;
+    writer.append(1, 1);
+    writer.append(column);
+    writer.append(column);
+    EXPECT_EQ(writer.size(), 25U);
+
+    const std::string message = writer.frame();
+    Rtcm_Bit_Reader reader(message);
+    reader.skip(24);
+    EXPECT_EQ(reader.get_uint(1), 1U);
+    EXPECT_EQ(reader.get_uint(3), 5U);
+    EXPECT_EQ(reader.get_uint(9), 0x1FFU);
+    EXPECT_EQ(reader.get_uint(3), 5U);
+    EXPECT_EQ(reader.get_uint(9), 0x1FFU);
+}
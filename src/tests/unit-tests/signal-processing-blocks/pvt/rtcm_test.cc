@@ -18,6 +18,9 @@
 
 #include "Galileo_INAV.h"
 #include "rtcm.h"
+#include "rtcm_bitstream.h"
+#include <boost/asio.hpp>
+#include <chrono>
 #include <memory>
 #include <thread>
 
@@ -628,3 +631,53 @@ TEST(RtcmTest, InstantiateServerWithoutClosing)
     std::string test3_bin = rtcm->hex_to_bin(test3);
     EXPECT_EQ(0, test3_bin.compare("11111111"));
 }
+
+
+TEST(RtcmTest, NtripCaster)
+{
+    const uint16_t port = 2102;
+    auto rtcm = std::make_shared<Rtcm>(port, "EPH:1019,1045 ALL", 4);
+    rtcm->run_server();
+
+    b_io_context io_context;
+    boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::address::from_string("127.0.0.1"), port);
+
+    // Unknown mount point: the caster sends the sourcetable and closes the connection
+    boost::asio::ip::tcp::socket table_socket(io_context);
+    table_socket.connect(endpoint);
+    boost::asio::write(table_socket, boost::asio::buffer(std::string("GET / HTTP/1.0\r\n\r\n")));
+    boost::asio::streambuf table_buf;
+    boost::system::error_code ec;
+    boost::asio::read(table_socket, table_buf, ec);
+    EXPECT_EQ(ec, boost::asio::error::eof);
+    const std::string table(boost::asio::buffers_begin(table_buf.data()), boost::asio::buffers_end(table_buf.data()));
+    EXPECT_EQ(table.compare(0, 18, "SOURCETABLE 200 OK"), 0);
+    EXPECT_NE(table.find("STR;ALL;ALL;RTCM 3.2;;"), std::string::npos);
+    EXPECT_NE(table.find("STR;EPH;EPH;RTCM 3.2;1019,1045;"), std::string::npos);
+    EXPECT_NE(table.find("ENDSOURCETABLE\r\n"), std::string::npos);
+
+    // The EPH mount point only serves messages of type 1019 and 1045
+    boost::asio::ip::tcp::socket socket(io_context);
+    socket.connect(endpoint);
+    boost::asio::write(socket, boost::asio::buffer(std::string("GET /EPH HTTP/1.0\r\nUser-Agent: NTRIP test\r\n\r\n")));
+    std::string response(14, '\0');
+    boost::asio::read(socket, boost::asio::buffer(&response[0], response.size()));
+    EXPECT_EQ(response, "ICY 200 OK\r\n\r\n");
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    Rtcm_Bit_Writer mt1020;
+    mt1020.append(1020, 12);
+    Rtcm_Bit_Writer mt1019;
+    mt1019.append(1019, 12);
+    mt1019.append(0xABCD, 16);
+    rtcm->send_message(mt1020.frame());
+    rtcm->send_message(mt1019.frame());
+
+    const std::string expected = mt1019.frame();
+    std::string received(expected.size(), '\0');
+    boost::asio::read(socket, boost::asio::buffer(&received[0], received.size()));
+    EXPECT_EQ(received, expected);
+
+    socket.close();
+    rtcm->stop_server();
+}
@@ -0,0 +1,113 @@
+/*!
+ * \file rtklib_corrections_test.cc
+ * \brief Tests of the reuse of the ionospheric grid, tropospheric and earth
+ * tide corrections of RTKLIB
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "rtklib_ionex.h"
+#include "rtklib_rtkcmn.h"
+#include "rtklib_tides.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdlib>
+
+
+TEST(RtklibCorrectionsTest, TidesInterpolation)
+{
+    const double rr[3] = {4789032.0, 176595.0, 4195013.0};
+    const double ep[6] = {2022, 3, 1, 10, 0, 0};
+    const gtime_t t0 = epoch2time(ep);
+    for (int k = 0; k < 3600; k += 7)
+        {
+            const gtime_t t = timeadd(t0, k + 0.25);
+            double dr[3];
+            double dr_interp[3];
+            tidedisp(t, rr, 1, nullptr, nullptr, dr);
+            tidedisp_interp(t, rr, 1, nullptr, nullptr, 30.0, dr_interp);
+            for (int i = 0; i < 3; i++)
+                {
+                    EXPECT_NEAR(dr_interp[i], dr[i], 1e-6);
+                }
+            // every epoch
+            tidedisp_interp(t, rr, 1, nullptr, nullptr, 0.0, dr_interp);
+            for (int i = 0; i < 3; i++)
+                {
+                    EXPECT_EQ(dr_interp[i], dr[i]);
+                }
+        }
+}
+
+
+TEST(RtklibCorrectionsTest, IonexMaps)
+{
+    nav_t nav{};
+    const double lats[3] = {87.5, -87.5, -2.5};
+    const double lons[3] = {-180.0, 180.0, 5.0};
+    const double hgts[3] = {450.0, 450.0, 0.0};
+    const double ep[6] = {2022, 3, 1, 0, 0, 0};
+    for (int m = 0; m < 13; m++)
+        {
+            tec_t *tec = addtec(lats, lons, hgts, 6371.0, &nav);
+            ASSERT_NE(tec, nullptr);
+            tec->time = timeadd(epoch2time(ep), 7200.0 * m);
+            const int n = tec->ndata[0] * tec->ndata[1] * tec->ndata[2];
+            for (int j = 0; j < n; j++)
+                {
+                    tec->data[j] = 10.0 + (j * 37 + m * 11) % 50;
+                    tec->rms[j] = 1.0F + static_cast<float>(j % 5);
+                }
+        }
+    const double pos[3] = {0.72, 0.035, 80.0};
+    for (int k = 0; k < 2000; k++)
+        {
+            const double azel[2] = {0.003 * k, 0.2 + 0.0005 * k};
+            const gtime_t t = timeadd(epoch2time(ep), 43.0 * k);
+            double delay;
+            double var;
+            ASSERT_EQ(iontec(t, &nav, pos, azel, 1, &delay, &var), 1);
+
+            // the same as the linear interpolation of the delays of each map
+            const int i = static_cast<int>(std::floor(43.0 * k / 7200.0)) + 1;
+            double dels[2];
+            double vars[2];
+            ASSERT_EQ(iondelay(t, nav.tec + i - 1, pos, azel, 1, dels, vars), 1);
+            ASSERT_EQ(iondelay(t, nav.tec + i, pos, azel, 1, dels + 1, vars + 1), 1);
+            const double a = timediff(t, nav.tec[i - 1].time) / 7200.0;
+            EXPECT_DOUBLE_EQ(delay, dels[0] * (1.0 - a) + dels[1] * a);
+        }
+    const gtime_t after = timeadd(epoch2time(ep), 7200.0 * 13);
+    const double azel[2] = {0.0, 1.0};
+    double delay;
+    double var;
+    EXPECT_EQ(iontec(after, &nav, pos, azel, 1, &delay, &var), 0);
+    for (int m = 0; m < nav.nt; m++)
+        {
+            free(nav.tec[m].data);
+            free(nav.tec[m].rms);
+        }
+    free(nav.tec);
+}
+
+
+TEST(RtklibCorrectionsTest, TroposphereOfEachSatellite)
+{
+    const double pos[3] = {0.72, 0.035, 80.0};
+    const gtime_t t{};
+    double azel[2] = {0.0, GNSS_PI / 2.0};
+    const double zenith = tropmodel(t, pos, azel, 0.7);
+    azel[1] = GNSS_PI / 6.0;
+    // the zenith delays are reused, and scaled by the elevation
+    EXPECT_NEAR(tropmodel(t, pos, azel, 0.7), zenith * 2.0, 1e-12);
+    const double other_pos[3] = {0.72, 0.035, 1080.0};
+    EXPECT_LT(tropmodel(t, other_pos, azel, 0.7), zenith * 2.0);
+}
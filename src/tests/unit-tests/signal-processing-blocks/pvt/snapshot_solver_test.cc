@@ -0,0 +1,184 @@
+/*!
+ * \file snapshot_solver_test.cc
+ * \brief Tests of the coarse-time navigation of snapshot positioning
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "MATH_CONSTANTS.h"
+#include "rtklib_conversions.h"
+#include "rtklib_ephemeris.h"
+#include "rtklib_rtkcmn.h"
+#include "snapshot_solver.h"
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include <map>
+#include <vector>
+
+
+namespace
+{
+const int SNAPSHOT_TEST_WEEK = 2200;
+const double SNAPSHOT_TEST_TOW = 345600.0123456;
+
+
+// 24 satellites in 6 circular orbital planes
+std::map<int, Gps_Ephemeris> snapshot_test_constellation()
+{
+    std::map<int, Gps_Ephemeris> constellation;
+    for (int prn = 1; prn <= 24; prn++)
+        {
+            Gps_Ephemeris eph;
+            eph.PRN = static_cast<uint32_t>(prn);
+            eph.sqrtA = std::sqrt(26560000.0);
+            eph.ecc = 0.001 * (prn % 5);
+            eph.i_0 = 55.0 * D2R;
+            eph.OMEGA_0 = ((prn - 1) % 6) * 60.0 * D2R;
+            eph.M_0 = ((prn - 1) / 6) * 90.0 * D2R + ((prn - 1) % 6) * 15.0 * D2R;
+            eph.OMEGAdot = -8.0e-9;
+            eph.af0 = 1e-5 * (prn % 7);
+            eph.af1 = 1e-12;
+            eph.TGD = -5e-9;
+            eph.WN = SNAPSHOT_TEST_WEEK;
+            eph.toe = 345600;
+            eph.toc = 345600;
+            eph.tow = 345000;
+            constellation[prn] = eph;
+        }
+    return constellation;
+}
+
+
+// time from the first sample of the burst, taken at t, to the next code epoch of eph
+double snapshot_test_code_phase(const eph_t& eph, const gtime_t& t, const double* rr)
+{
+    const double code_period_s = 1e-3;
+    std::array<double, 3> pos{};
+    ecef2pos(rr, pos.data());
+    double code_phase_s = 0.0;
+    for (int pass = 0; pass < 2; pass++)
+        {
+            const gtime_t t_rx = timeadd(t, code_phase_s);
+            double travel_time_s = 0.075;
+            std::array<double, 6> rs{};
+            std::array<double, 3> e{};
+            std::array<double, 2> azel{};
+            double dts = 0.0;
+            double var = 0.0;
+            double range = 0.0;
+            for (int i = 0; i < 5; i++)
+                {
+                    eph2pos(timeadd(t_rx, -travel_time_s), &eph, rs.data(), &dts, &var);
+                    range = geodist(rs.data(), rr, e.data());
+                    satazel(pos.data(), e.data(), azel.data());
+                    range += tropmodel(timeadd(t_rx, -travel_time_s), pos.data(), azel.data(), 0.7);
+                    travel_time_s = range / SPEED_OF_LIGHT_M_S;
+                }
+            dts -= eph.tgd[0];
+            // the epoch transmitted at the whole millisecond s of the satellite clock arrives at s - dts + travel_time_s
+            double tow = time2gpst(t, nullptr);
+            code_phase_s = std::fmod(travel_time_s - dts - std::fmod(tow, code_period_s), code_period_s);
+            code_phase_s += (code_phase_s < 0.0 ? code_period_s : 0.0);
+        }
+    return code_phase_s;
+}
+
+
+double snapshot_test_elevation(const eph_t& eph, const gtime_t& t, const double* rr)
+{
+    std::array<double, 6> rs{};
+    std::array<double, 3> e{};
+    std::array<double, 3> pos{};
+    std::array<double, 2> azel{};
+    double dts = 0.0;
+    double var = 0.0;
+    eph2pos(timeadd(t, -0.075), &eph, rs.data(), &dts, &var);
+    geodist(rs.data(), rr, e.data());
+    ecef2pos(rr, pos.data());
+    satazel(pos.data(), e.data(), azel.data());
+    return azel[1];
+}
+}  // namespace
+
+
+TEST(SnapshotSolverTest, SolvesPositionAndCoarseTime)
+{
+    Snapshot_Solver solver;
+    solver.gps_ephemeris_map = snapshot_test_constellation();
+
+    const std::array<double, 3> true_lla{41.2750 * D2R, 1.9875 * D2R, 50.0};
+    std::array<double, 3> true_ecef{};
+    pos2ecef(true_lla.data(), true_ecef.data());
+    const gtime_t true_time = gpst2time(SNAPSHOT_TEST_WEEK, SNAPSHOT_TEST_TOW);
+
+    std::vector<Snapshot_Measurement> measurements;
+    for (const auto& eph : solver.gps_ephemeris_map)
+        {
+            const eph_t rtklib_eph = eph_to_rtklib(eph.second, false);
+            if (snapshot_test_elevation(rtklib_eph, true_time, true_ecef.data()) > 10.0 * D2R)
+                {
+                    Snapshot_Measurement measurement;
+                    measurement.system = 'G';
+                    measurement.prn = eph.second.PRN;
+                    measurement.code_phase_s = snapshot_test_code_phase(rtklib_eph, true_time, true_ecef.data());
+                    measurements.push_back(measurement);
+                }
+        }
+    ASSERT_GE(measurements.size(), 6U);
+
+    // a priori some tens of kilometres away, and a coarse time off by seconds
+    const std::array<double, 3> reference_ecef{true_ecef[0] + 12000.0, true_ecef[1] - 9000.0, true_ecef[2] + 5000.0};
+    const gtime_t coarse_time = timeadd(true_time, 1.5);
+
+    const Snapshot_Fix fix = solver.solve(measurements, coarse_time, reference_ecef);
+    ASSERT_TRUE(fix.valid);
+    EXPECT_EQ(fix.satellites, measurements.size());
+    double position_error = 0.0;
+    for (int j = 0; j < 3; j++)
+        {
+            position_error += (fix.ecef[j] - true_ecef[j]) * (fix.ecef[j] - true_ecef[j]);
+        }
+    EXPECT_LT(std::sqrt(position_error), 1.0);
+    EXPECT_NEAR(fix.time_correction_s, -1.5, 1e-3);
+    EXPECT_NEAR(timediff(fix.time, true_time), 0.0, 1e-3);
+    EXPECT_LT(fix.residual_rms_m, 1.0);
+}
+
+
+TEST(SnapshotSolverTest, NeedsFiveSatellitesWithEphemeris)
+{
+    Snapshot_Solver solver;
+    solver.gps_ephemeris_map = snapshot_test_constellation();
+    const std::array<double, 3> reference_ecef{4796983.0, 166452.0, 4187236.0};
+    const gtime_t coarse_time = gpst2time(SNAPSHOT_TEST_WEEK, SNAPSHOT_TEST_TOW);
+
+    std::vector<Snapshot_Measurement> measurements(4);
+    for (uint32_t i = 0; i < 4; i++)
+        {
+            measurements[i].prn = i + 1;
+            measurements[i].code_phase_s = 1e-4 * i;
+        }
+    // a satellite without ephemeris does not count
+    Snapshot_Measurement unknown;
+    unknown.system = 'E';
+    unknown.prn = 7;
+    measurements.push_back(unknown);
+
+    const Snapshot_Fix fix = solver.solve(measurements, coarse_time, reference_ecef);
+    EXPECT_FALSE(fix.valid);
+    EXPECT_EQ(fix.satellites, 4U);
+
+    // nor one whose ephemeris is too old
+    solver.max_ephemeris_age_s = 600.0;
+    measurements.back().system = 'G';
+    EXPECT_EQ(solver.solve(measurements, timeadd(coarse_time, 3600.0), reference_ecef).satellites, 0U);
+}
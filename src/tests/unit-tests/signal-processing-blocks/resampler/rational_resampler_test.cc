@@ -0,0 +1,135 @@
+/*!
+ * \file rational_resampler_test.cc
+ * \brief Checks the pass band, the alias rejection, the group delay and the
+ * streaming of the polyphase rational resampler.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "rational_resampler.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <stdexcept>
+#include <vector>
+
+
+namespace
+{
+// Resamples the whole signal in blocks of the given size, with a zero history
+std::vector<gr_complex> rational_resampler_test_run(Rational_Resampler& resampler, const std::vector<gr_complex>& signal, std::size_t block)
+{
+    const std::size_t history = resampler.taps_per_phase() - 1;
+    std::vector<gr_complex> buffer(history, gr_complex(0.0, 0.0));
+    buffer.insert(buffer.end(), signal.cbegin(), signal.cend());
+    std::vector<gr_complex> out(signal.size() * resampler.interpolation() / resampler.decimation() + 2);
+    std::size_t start = 0;
+    std::size_t n_out = 0;
+    while (start < signal.size())
+        {
+            const std::size_t n_in = std::min(block, signal.size() - start);
+            std::size_t consumed = 0;
+            n_out += resampler.resample(&buffer[start], n_in, &out[n_out], out.size() - n_out, consumed);
+            start += consumed;
+            if (consumed == 0)
+                {
+                    break;
+                }
+        }
+    out.resize(n_out);
+    return out;
+}
+
+
+std::vector<gr_complex> rational_resampler_test_tone(double freq_hz, double fs_hz, std::size_t n)
+{
+    std::vector<gr_complex> tone(n);
+    for (std::size_t k = 0; k < n; k++)
+        {
+            tone[k] = std::polar(1.0F, static_cast<float>(2.0 * 3.1415926535898 * freq_hz * static_cast<double>(k) / fs_hz));
+        }
+    return tone;
+}
+
+
+double rational_resampler_test_power(const std::vector<gr_complex>& signal, std::size_t first)
+{
+    double power = 0.0;
+    for (std::size_t k = first; k < signal.size(); k++)
+        {
+            power += std::norm(signal[k]);
+        }
+    return power / static_cast<double>(signal.size() - first);
+}
+}  // namespace
+
+
+TEST(RationalResamplerTest, ReducedRatio)
+{
+    const Rational_Resampler resampler(26000000, 4000000);
+    EXPECT_EQ(resampler.interpolation(), 2U);
+    EXPECT_EQ(resampler.decimation(), 13U);
+    const Rational_Resampler resampler2(30690000, 10230000);
+    EXPECT_EQ(resampler2.interpolation(), 1U);
+    EXPECT_EQ(resampler2.decimation(), 3U);
+    EXPECT_THROW(Rational_Resampler(0, 4000000), std::invalid_argument);
+    EXPECT_THROW(Rational_Resampler(26000000, 4000000, 1.5), std::invalid_argument);
+}
+
+
+TEST(RationalResamplerTest, PassBandAndAliases)
+{
+    const uint64_t fs_in = 26000000;
+    const uint64_t fs_out = 4000000;
+    Rational_Resampler resampler(fs_in, fs_out);
+    const std::size_t settle = resampler.taps_per_phase();
+
+    // a tone in the pass band keeps its power
+    const std::vector<gr_complex> in_band = rational_resampler_test_run(resampler, rational_resampler_test_tone(1.2e6, fs_in, 26000), 1000);
+    EXPECT_NEAR(rational_resampler_test_power(in_band, settle), 1.0, 0.01);
+
+    // a tone that would alias into the pass band (at 1 MHz) is rejected
+    Rational_Resampler resampler2(fs_in, fs_out);
+    const std::vector<gr_complex> aliased = rational_resampler_test_run(resampler2, rational_resampler_test_tone(5.0e6, fs_in, 26000), 1000);
+    EXPECT_LT(rational_resampler_test_power(aliased, settle), 1e-5);
+}
+
+
+TEST(RationalResamplerTest, ExactLatencyAndStreaming)
+{
+    // 4 MHz to 6 MHz, an impulse at input sample 100 appears at input time 100 + latency
+    const uint64_t fs_in = 4000000;
+    const uint64_t fs_out = 6000000;
+    std::vector<gr_complex> impulse(1000, gr_complex(0.0, 0.0));
+    impulse[100] = gr_complex(1.0, 0.0);
+    Rational_Resampler resampler(fs_in, fs_out);
+    const std::vector<gr_complex> out = rational_resampler_test_run(resampler, impulse, impulse.size());
+    std::size_t peak = 0;
+    for (std::size_t k = 0; k < out.size(); k++)
+        {
+            if (std::abs(out[k]) > std::abs(out[peak]))
+                {
+                    peak = k;
+                }
+        }
+    const double peak_input_time = static_cast<double>(peak) * static_cast<double>(resampler.decimation()) / static_cast<double>(resampler.interpolation());
+    EXPECT_DOUBLE_EQ(peak_input_time, 100.0 + static_cast<double>(resampler.latency_samples()));
+
+    // the same output whatever the size of the input blocks
+    Rational_Resampler resampler2(fs_in, fs_out);
+    const std::vector<gr_complex> out2 = rational_resampler_test_run(resampler2, impulse, 7);
+    ASSERT_EQ(out2.size(), out.size());
+    for (std::size_t k = 0; k < out.size(); k++)
+        {
+            EXPECT_EQ(out2[k], out[k]);
+        }
+}
@@ -0,0 +1,140 @@
+/*!
+ * \file capture_file_source_test.cc
+ * \brief Implements Unit Tests for the capture file writer, reader and source
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "capture_file_source.h"
+#include "gnss_capture_file.h"
+#include <gnuradio/blocks/head.h>
+#include <gnuradio/top_block.h>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef GR_GREATER_38
+#include <gnuradio/blocks/vector_sink.h>
+#else
+#include <gnuradio/blocks/vector_sink_s.h>
+#endif
+
+
+class CaptureFileSourceTest : public ::testing::Test
+{
+protected:
+    CaptureFileSourceTest()
+    {
+        // blocks of 2-bit, 4-bit, 6-bit and 8-bit values, and a last block
+        // of 50 10-bit values
+        for (int i = 0; i < 450; i++)
+            {
+                const int range = 2 << (2 * (i / 100) + 1);
+                samples.push_back(static_cast<int16_t>((i * 7919) % range - range / 2));
+            }
+        Gnss_Capture_Header header;
+        header.item_type = "short";
+        header.item_size = sizeof(int16_t);
+        header.items_per_block = 100;
+        header.sampling_frequency = 1000.0;
+        Gnss_Capture_Writer writer(filename, header);
+        writer.set_time(0, 1000.5);
+        writer.write(samples.data(), 130);
+        writer.write(samples.data() + 130, samples.size() - 130);
+        writer.close();
+        file_bytes = writer.bytes();
+    }
+
+    ~CaptureFileSourceTest() override
+    {
+        std::remove(filename.c_str());
+    }
+
+    std::vector<int16_t> run(bool repeat, uint64_t offset_items, uint64_t max_items)
+    {
+        auto top_block = gr::make_top_block("CaptureFileSourceTest");
+        auto source = make_capture_file_source(filename, repeat, offset_items);
+        auto head = gr::blocks::head::make(sizeof(int16_t), max_items);
+        auto sink = gr::blocks::vector_sink_s::make();
+        top_block->connect(source, 0, head, 0);
+        top_block->connect(head, 0, sink, 0);
+        top_block->run();
+        return sink->data();
+    }
+
+    const std::string filename{"./capture_file_source_test.dat"};
+    std::vector<int16_t> samples;
+    uint64_t file_bytes{0};
+};
+
+
+TEST_F(CaptureFileSourceTest, LosslessPacking)
+{
+    // stored with 2, 4, 8, 8 and 16 bits per value, plus the headers and the index
+    EXPECT_EQ(file_bytes, 128U + 5U * 24U + 25U + 50U + 100U + 100U + 100U + 5U * 24U);
+
+    Gnss_Capture_Reader reader(filename);
+    EXPECT_EQ(reader.header().item_type, "short");
+    EXPECT_EQ(reader.header().items, samples.size());
+    std::vector<int16_t> data(samples.size() + 10);
+    ASSERT_EQ(reader.read(data.data(), data.size()), samples.size());
+    for (size_t i = 0; i < samples.size(); i++)
+        {
+            EXPECT_EQ(data[i], samples[i]);
+        }
+    EXPECT_EQ(reader.read(data.data(), 1), 0U);
+}
+
+
+TEST_F(CaptureFileSourceTest, SeekAndTime)
+{
+    Gnss_Capture_Reader reader(filename);
+    reader.seek(333);
+    int16_t value = 0;
+    ASSERT_EQ(reader.read(&value, 1), 1U);
+    EXPECT_EQ(value, samples[333]);
+    EXPECT_EQ(reader.tell(), 334U);
+    EXPECT_DOUBLE_EQ(reader.time_of(333), 1000.5 + 0.333);
+    EXPECT_DOUBLE_EQ(reader.time_of(449), 1000.5 + 0.449);
+}
+
+
+TEST_F(CaptureFileSourceTest, ReadFromOffset)
+{
+    const std::vector<int16_t> data = run(false, 150, 10000);
+    ASSERT_EQ(data.size(), samples.size() - 150);
+    for (size_t i = 0; i < data.size(); i++)
+        {
+            EXPECT_EQ(data[i], samples[i + 150]);
+        }
+}
+
+
+TEST_F(CaptureFileSourceTest, Repeat)
+{
+    const std::vector<int16_t> data = run(true, 449, 902);
+    ASSERT_EQ(data.size(), 902U);
+    EXPECT_EQ(data[0], samples[449]);
+    for (size_t i = 1; i < data.size(); i++)
+        {
+            EXPECT_EQ(data[i], samples[(i - 1) % samples.size()]);
+        }
+}
+
+
+TEST_F(CaptureFileSourceTest, NotACaptureFile)
+{
+    EXPECT_FALSE(Gnss_Capture_Reader::is_capture_file("./non_existing_file.dat"));
+    EXPECT_THROW(make_capture_file_source("./non_existing_file.dat", false), std::runtime_error);
+}
@@ -0,0 +1,97 @@
+/*!
+ * \file gnss_capture_ring_test.cc
+ * \brief Implements Unit Tests for the event-triggered sample captures
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_capture_file.h"
+#include "gnss_capture_ring.h"
+#include "gnss_capture_trigger.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+
+TEST(GnssCaptureRingTest, WritesTheLastItems)
+{
+    Gnss_Capture_Header header;
+    header.item_type = "short";
+    header.item_size = sizeof(int16_t);
+    header.sampling_frequency = 1000.0;
+    std::vector<int16_t> samples(250);
+    for (size_t i = 0; i < samples.size(); i++)
+        {
+            samples[i] = static_cast<int16_t>(i);
+        }
+
+    std::string filename;
+    {
+        Gnss_Capture_Ring ring("Ring", header, 100, "./gnss_capture_ring_test");
+        EXPECT_FALSE(ring.trigger("telecommand"));  // nothing to write yet
+        for (size_t i = 0; i < samples.size(); i += 30)
+            {
+                ring.push(samples.data() + i, std::min(static_cast<size_t>(30), samples.size() - i));
+            }
+        EXPECT_EQ(ring.items_pushed(), 250U);
+        EXPECT_TRUE(ring.trigger("telecommand"));
+        ring.wait_idle();
+        ASSERT_EQ(ring.captures(), 1U);
+        filename = ring.last_filename();
+    }
+    EXPECT_EQ(filename, "./gnss_capture_ring_test_Ring_1_telecommand.dat");
+
+    // the oldest chunk of the ring (one item here) is left out
+    Gnss_Capture_Reader reader(filename);
+    EXPECT_EQ(reader.header().item_type, "short");
+    std::vector<int16_t> captured(200);
+    captured.resize(reader.read(captured.data(), captured.size()));
+    ASSERT_EQ(captured.size(), 99U);
+    for (size_t i = 0; i < captured.size(); i++)
+        {
+            EXPECT_EQ(captured[i], samples[151 + i]);
+        }
+    EXPECT_FALSE(std::isnan(reader.time_of(0)));
+    EXPECT_NEAR(reader.time_of(98) - reader.time_of(0), 0.098, 1e-6);
+    std::remove(filename.c_str());
+}
+
+
+TEST(GnssCaptureTriggerTest, HoldoffAndReasons)
+{
+    Gnss_Capture_Trigger trigger(std::chrono::seconds(10), "lock_loss, telecommand");
+    std::vector<std::string> targets_reasons;
+    trigger.add_target([&targets_reasons](const std::string& reason) {
+        targets_reasons.push_back(reason);
+        return true;
+    });
+    EXPECT_TRUE(trigger.enabled("lock_loss"));
+    EXPECT_FALSE(trigger.enabled("interference"));
+
+    const auto t0 = std::chrono::steady_clock::now();
+    EXPECT_FALSE(trigger.fire("interference", t0));
+    EXPECT_TRUE(trigger.fire("lock_loss", t0));
+    EXPECT_FALSE(trigger.fire("telecommand", t0 + std::chrono::seconds(5)));
+    EXPECT_TRUE(trigger.fire("telecommand", t0 + std::chrono::seconds(11)));
+    EXPECT_EQ(trigger.captures(), 2U);
+    ASSERT_EQ(targets_reasons.size(), 2U);
+    EXPECT_EQ(targets_reasons[0], "lock_loss");
+    EXPECT_EQ(targets_reasons[1], "telecommand");
+
+    // with no reasons, all of them trigger captures
+    Gnss_Capture_Trigger all(std::chrono::seconds(0), "");
+    EXPECT_TRUE(all.enabled("pvt_jump"));
+}
@@ -0,0 +1,102 @@
+/*!
+ * \file gnss_sdr_ingest_monitor_test.cc
+ * \brief Implements Unit Tests for the monitor of the samples lost by a
+ * signal source
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_ingest_monitor.h"
+#include <gnuradio/blocks/throttle.h>
+#include <gnuradio/gr_complex.h>
+#include <gnuradio/tags.h>
+#include <gnuradio/top_block.h>
+#include <gtest/gtest.h>
+#include <pmt/pmt.h>
+#include <cstdint>
+#include <vector>
+
+#ifdef GR_GREATER_38
+#include <gnuradio/blocks/vector_source.h>
+#else
+#include <gnuradio/blocks/vector_source_c.h>
+#endif
+
+
+gr::tag_t make_rx_time_tag(uint64_t offset, uint64_t full_secs, double frac_secs)
+{
+    gr::tag_t tag;
+    tag.offset = offset;
+    tag.key = pmt::mp("rx_time");
+    tag.value = pmt::make_tuple(pmt::from_uint64(full_secs), pmt::from_double(frac_secs));
+    return tag;
+}
+
+
+TEST(GnssSdrIngestMonitorTest, LostSamplesAndSkew)
+{
+    const double fs = 1e6;
+    const std::vector<gr_complex> samples(10000, gr_complex(1.0, 0.0));
+
+    // 250 samples lost before the sample 5000 of the first RF channel
+    const std::vector<gr::tag_t> tags0{make_rx_time_tag(0, 100, 0.0),
+        make_rx_time_tag(5000, 100, 5250.0 / fs)};
+    // the second RF channel starts 2 us later, without losses
+    const std::vector<gr::tag_t> tags1{make_rx_time_tag(0, 100, 2e-6),
+        make_rx_time_tag(5000, 100, 2e-6 + 5000.0 / fs)};
+
+    auto top_block = gr::make_top_block("ingest_monitor_test");
+    auto source0 = gr::blocks::vector_source_c::make(samples, false, 1, tags0);
+    auto source1 = gr::blocks::vector_source_c::make(samples, false, 1, tags1);
+    auto monitor = gnss_sdr_make_ingest_monitor(sizeof(gr_complex), 2, fs, "SignalSource");
+    top_block->connect(source0, 0, monitor, 0);
+    top_block->connect(source1, 0, monitor, 1);
+    top_block->run();
+
+    EXPECT_EQ(monitor->get_overflows(0), 1U);
+    EXPECT_EQ(monitor->get_lost_samples(0), 250U);
+    EXPECT_EQ(monitor->get_overflows(1), 0U);
+    EXPECT_EQ(monitor->get_lost_samples(1), 0U);
+    // skew of the start times, before and after the lost samples
+    EXPECT_NEAR(monitor->get_max_skew_s(), 250.0 / fs - 2e-6, 1e-9);
+}
+
+
+TEST(GnssSdrIngestMonitorTest, LostSamplesWithoutTimestamps)
+{
+    const double fs = 1e5;
+    const std::vector<gr_complex> samples(20000, gr_complex(1.0, 0.0));
+
+    // a device delivering half of its samples, in 0.4 s
+    auto top_block = gr::make_top_block("ingest_monitor_test");
+    auto source = gr::blocks::vector_source_c::make(samples);
+    auto throttle = gr::blocks::throttle::make(sizeof(gr_complex), fs / 2.0);
+    auto monitor = gnss_sdr_make_ingest_monitor(sizeof(gr_complex), 1, fs, "SignalSource", 0.05);
+    top_block->connect(source, 0, throttle, 0);
+    top_block->connect(throttle, 0, monitor, 0);
+    top_block->run();
+
+    EXPECT_GE(monitor->get_overflows(0), 1U);
+    EXPECT_GT(monitor->get_lost_samples(0), 5000U);
+    EXPECT_LT(monitor->get_lost_samples(0), 20000U);
+
+    // and one delivering all of them
+    auto top_block_2 = gr::make_top_block("ingest_monitor_test");
+    auto source_2 = gr::blocks::vector_source_c::make(samples);
+    auto throttle_2 = gr::blocks::throttle::make(sizeof(gr_complex), fs * 4.0);
+    auto monitor_2 = gnss_sdr_make_ingest_monitor(sizeof(gr_complex), 1, fs, "SignalSource", 0.05);
+    top_block_2->connect(source_2, 0, throttle_2, 0);
+    top_block_2->connect(throttle_2, 0, monitor_2, 0);
+    top_block_2->run();
+
+    EXPECT_EQ(monitor_2->get_overflows(0), 0U);
+    EXPECT_EQ(monitor_2->get_lost_samples(0), 0U);
+}
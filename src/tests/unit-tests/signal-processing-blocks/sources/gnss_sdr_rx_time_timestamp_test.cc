@@ -0,0 +1,89 @@
+/*!
+ * \file gnss_sdr_rx_time_timestamp_test.cc
+ * \brief Tests of the conversion of the rx_time tags into GnssTime time tags
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_rx_time_timestamp.h"
+#include "gnss_time.h"
+#include <boost/any.hpp>
+#include <gnuradio/gr_complex.h>
+#include <gnuradio/tags.h>
+#include <gnuradio/top_block.h>
+#include <gtest/gtest.h>
+#include <pmt/pmt.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#ifdef GR_GREATER_38
+#include <gnuradio/blocks/vector_sink.h>
+#include <gnuradio/blocks/vector_source.h>
+#else
+#include <gnuradio/blocks/vector_sink_c.h>
+#include <gnuradio/blocks/vector_source_c.h>
+#endif
+
+
+TEST(GnssSdrRxTimeTimestampTest, GpsTime)
+{
+    // week 2200, 3600.25 s
+    const GnssTime time = Gnss_Sdr_Rx_Time_Timestamp::gps_time(2200.0 * 604800.0 + 3600.25);
+    EXPECT_EQ(time.week, 2200);
+    EXPECT_EQ(time.tow_ms, 3600250);
+    EXPECT_NEAR(time.tow_ms_fraction, 0.0, 1e-3);
+}
+
+
+TEST(GnssSdrRxTimeTimestampTest, ExtrapolatesTheDeviceTimestamps)
+{
+    const double fs = 1e6;
+    const std::vector<gr_complex> samples(25000, gr_complex(1.0, 0.0));
+
+    // a first timestamp, and a second one after samples lost at 15000
+    std::vector<gr::tag_t> tags(2);
+    tags[0].offset = 0;
+    tags[0].key = pmt::mp("rx_time");
+    tags[0].value = pmt::make_tuple(pmt::from_uint64(1000), pmt::from_double(0.5));
+    tags[1].offset = 15000;
+    tags[1].key = pmt::mp("rx_time");
+    tags[1].value = pmt::make_tuple(pmt::from_uint64(1000), pmt::from_double(0.52));
+
+    auto top_block = gr::make_top_block("rx_time_timestamp_test");
+    auto source = gr::blocks::vector_source_c::make(samples, false, 1, tags);
+    // 18 s of clock offset, and a time tag every 10 ms
+    auto timestamp = gnss_sdr_make_rx_time_timestamp(sizeof(gr_complex), fs, 18.0, 10.0);
+    auto sink = gr::blocks::vector_sink_c::make();
+    top_block->connect(source, 0, timestamp, 0);
+    top_block->connect(timestamp, 0, sink, 0);
+    top_block->run();
+
+    EXPECT_EQ(sink->data(), samples);
+    std::vector<uint64_t> offsets;
+    std::vector<double> tows_ms;
+    for (const auto& tag : sink->tags())
+        {
+            if (pmt::symbol_to_string(tag.key) == "timetag")
+                {
+                    const auto time = boost::any_cast<const std::shared_ptr<GnssTime>>(pmt::any_ref(tag.value));
+                    offsets.push_back(tag.offset);
+                    tows_ms.push_back(static_cast<double>(time->tow_ms) + time->tow_ms_fraction);
+                }
+        }
+    ASSERT_EQ(offsets.size(), 3U);
+    EXPECT_EQ(offsets[0], 0U);
+    EXPECT_EQ(offsets[1], 10000U);
+    EXPECT_EQ(offsets[2], 15000U);
+    EXPECT_NEAR(tows_ms[0], 1018500.0, 1e-3);
+    EXPECT_NEAR(tows_ms[1], 1018510.0, 1e-3);
+    EXPECT_NEAR(tows_ms[2], 1018520.0, 1e-3);
+}
@@ -0,0 +1,110 @@
+/*!
+ * \file mmap_file_source_test.cc
+ * \brief Implements Unit Tests for the memory-mapped file source
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "concurrent_queue.h"
+#include "mmap_file_source.h"
+#include <gnuradio/blocks/head.h>
+#include <gnuradio/top_block.h>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef GR_GREATER_38
+#include <gnuradio/blocks/vector_sink.h>
+#else
+#include <gnuradio/blocks/vector_sink_s.h>
+#endif
+
+
+class MmapFileSourceTest : public ::testing::Test
+{
+protected:
+    MmapFileSourceTest()
+    {
+        // 1001 items and a trailing byte, which is not an item
+        for (int16_t i = 0; i < 1001; i++)
+            {
+                samples.push_back(i);
+            }
+        std::ofstream file(filename, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(samples.data()), samples.size() * sizeof(int16_t));
+        file.put('\0');
+    }
+
+    ~MmapFileSourceTest() override
+    {
+        std::remove(filename.c_str());
+    }
+
+    std::vector<int16_t> run(bool repeat, uint64_t offset_items, uint64_t max_items, uint64_t item_limit = 0)
+    {
+        auto top_block = gr::make_top_block("MmapFileSourceTest");
+        auto source = make_mmap_file_source(sizeof(int16_t), filename, repeat, offset_items);
+        source->set_item_limit(item_limit, &queue);
+        auto head = gr::blocks::head::make(sizeof(int16_t), max_items);
+        auto sink = gr::blocks::vector_sink_s::make();
+        top_block->connect(source, 0, head, 0);
+        top_block->connect(head, 0, sink, 0);
+        top_block->run();
+        return sink->data();
+    }
+
+    const std::string filename{"./mmap_file_source_test.dat"};
+    std::vector<int16_t> samples;
+    Concurrent_Queue<pmt::pmt_t> queue;
+};
+
+
+TEST_F(MmapFileSourceTest, ReadFromOffset)
+{
+    const std::vector<int16_t> data = run(false, 3, 10000);
+    ASSERT_EQ(data.size(), samples.size() - 3);
+    for (size_t i = 0; i < data.size(); i++)
+        {
+            EXPECT_EQ(data[i], samples[i + 3]);
+        }
+}
+
+
+TEST_F(MmapFileSourceTest, Repeat)
+{
+    const std::vector<int16_t> data = run(true, 1000, 2003);
+    ASSERT_EQ(data.size(), 2003U);
+    EXPECT_EQ(data[0], samples[1000]);
+    for (size_t i = 1; i < data.size(); i++)
+        {
+            EXPECT_EQ(data[i], samples[(i - 1) % samples.size()]);
+        }
+}
+
+
+TEST_F(MmapFileSourceTest, ItemLimit)
+{
+    const std::vector<int16_t> data = run(true, 0, 10000, 1500);
+    ASSERT_EQ(data.size(), 1500U);
+    EXPECT_EQ(data[1499], samples[498]);
+    pmt::pmt_t msg;
+    EXPECT_TRUE(queue.timed_wait_and_pop(msg, 100));
+}
+
+
+TEST_F(MmapFileSourceTest, MissingFile)
+{
+    EXPECT_THROW(make_mmap_file_source(sizeof(int16_t), "./non_existing_file.dat", false), std::runtime_error);
+}
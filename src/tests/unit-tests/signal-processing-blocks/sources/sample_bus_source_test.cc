@@ -0,0 +1,189 @@
+/*!
+ * \file sample_bus_source_test.cc
+ * \brief Implements Unit Tests for the shared memory sample bus and its
+ * source
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sample_bus.h"
+#include "sample_bus_source.h"
+#include <gnuradio/top_block.h>
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef GR_GREATER_38
+#include <gnuradio/blocks/vector_sink.h>
+#else
+#include <gnuradio/blocks/vector_sink_s.h>
+#endif
+
+
+namespace
+{
+const std::string SAMPLE_BUS_TEST_NAME("gnss-sdr-sample-bus-test");
+
+std::vector<int16_t> bus_ramp(int16_t first, size_t n)
+{
+    std::vector<int16_t> values(n);
+    for (size_t i = 0; i < n; i++)
+        {
+            values[i] = static_cast<int16_t>(first + i);
+        }
+    return values;
+}
+
+
+std::vector<int16_t> bus_read_all(Gnss_Sample_Bus_Reader& reader, size_t max_items)
+{
+    std::vector<int16_t> output(max_items);
+    size_t n = 0;
+    size_t read = 0;
+    do
+        {
+            read = reader.read(output.data() + n, max_items - n, 50);
+            n += read;
+        }
+    while (read > 0 and n < max_items);
+    output.resize(n);
+    return output;
+}
+}  // namespace
+
+
+TEST(SampleBusTest, ReadersHaveTheirOwnCursor)
+{
+    Gnss_Sample_Bus_Writer writer(SAMPLE_BUS_TEST_NAME, sizeof(int16_t), 1000, false);
+    Gnss_Sample_Bus_Reader early(SAMPLE_BUS_TEST_NAME, sizeof(int16_t), 1000);
+
+    const std::vector<int16_t> first = bus_ramp(0, 300);
+    writer.write(first.data(), first.size(), 5000);
+    Gnss_Sample_Bus_Reader late(SAMPLE_BUS_TEST_NAME, sizeof(int16_t), 1000);
+    EXPECT_EQ(late.first_sample(), 5300U);
+
+    // around the end of the ring
+    const std::vector<int16_t> second = bus_ramp(300, 900);
+    writer.write(second.data(), second.size(), 5300);
+
+    EXPECT_EQ(early.first_sample(), 5000U);
+    EXPECT_EQ(late.next_sample(), 5300U);
+    EXPECT_EQ(bus_read_all(late, 2000), second);
+    EXPECT_EQ(late.lost_samples(), 0U);
+    EXPECT_EQ(late.next_sample(), 6200U);
+
+    // the early reader is 1200 items behind, 200 more than the ring holds
+    const std::vector<int16_t> output = bus_read_all(early, 2000);
+    EXPECT_EQ(early.overruns(), 1U);
+    EXPECT_EQ(early.resyncs(), 0U);
+    ASSERT_EQ(output.size(), 1200U);
+    EXPECT_EQ(early.lost_samples(), 700U);  // it goes on from the middle of the ring
+    for (size_t i = 0; i < 700; i++)
+        {
+            EXPECT_EQ(output[i], 0);
+        }
+    for (size_t i = 700; i < output.size(); i++)
+        {
+            EXPECT_EQ(output[i], static_cast<int16_t>(i));
+        }
+    EXPECT_EQ(early.next_sample(), 6200U);
+
+    EXPECT_FALSE(late.finished());
+    writer.close();
+    EXPECT_TRUE(late.finished());
+}
+
+
+TEST(SampleBusTest, SkipsLongOverruns)
+{
+    Gnss_Sample_Bus_Writer writer(SAMPLE_BUS_TEST_NAME, sizeof(int16_t), 100, false);
+    Gnss_Sample_Bus_Reader reader(SAMPLE_BUS_TEST_NAME, sizeof(int16_t), 10);
+    const std::vector<int16_t> input = bus_ramp(0, 250);
+    writer.write(input.data(), input.size(), 0);
+
+    const std::vector<int16_t> output = bus_read_all(reader, 1000);
+    EXPECT_EQ(reader.resyncs(), 1U);
+    EXPECT_EQ(reader.lost_samples(), 200U);
+    EXPECT_EQ(output, bus_ramp(200, 50));
+    EXPECT_EQ(reader.next_sample(), 250U);
+}
+
+
+TEST(SampleBusTest, RejectsOtherItemSizes)
+{
+    Gnss_Sample_Bus_Writer writer(SAMPLE_BUS_TEST_NAME, sizeof(int16_t), 100, false);
+    EXPECT_THROW(Gnss_Sample_Bus_Reader(SAMPLE_BUS_TEST_NAME, 8, 10), std::runtime_error);
+    EXPECT_THROW(Gnss_Sample_Bus_Reader(SAMPLE_BUS_TEST_NAME + "-missing", sizeof(int16_t), 10), std::runtime_error);
+}
+
+
+TEST(SampleBusTest, ConcurrentReadersSeeTheWholeStream)
+{
+    const size_t total = 200000;
+    Gnss_Sample_Bus_Writer writer(SAMPLE_BUS_TEST_NAME, sizeof(int16_t), total);
+    std::vector<std::vector<int16_t>> outputs(3);
+    std::vector<uint64_t> lost(outputs.size());
+    std::vector<std::thread> readers;
+    for (size_t r = 0; r < outputs.size(); r++)
+        {
+            readers.emplace_back([&, r]() {
+                Gnss_Sample_Bus_Reader reader(SAMPLE_BUS_TEST_NAME, sizeof(int16_t), total);
+                std::vector<int16_t> buffer(777);
+                while (!reader.finished())
+                    {
+                        const size_t n = reader.read(buffer.data(), buffer.size(), 100);
+                        outputs[r].insert(outputs[r].end(), buffer.begin(), buffer.begin() + n);
+                    }
+                lost[r] = reader.lost_samples();
+            });
+        }
+    // the readers attach before the first write
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    const std::vector<int16_t> input = bus_ramp(0, total);
+    for (size_t i = 0; i < total; i += 1000)
+        {
+            writer.write(input.data() + i, 1000, i);
+        }
+    writer.close();
+    for (auto& reader : readers)
+        {
+            reader.join();
+        }
+    for (size_t r = 0; r < outputs.size(); r++)
+        {
+            EXPECT_EQ(lost[r], 0U);
+            EXPECT_EQ(outputs[r], input);
+        }
+}
+
+
+TEST(SampleBusSourceTest, ProducesTheSamplesOfTheBus)
+{
+    auto writer = std::make_shared<Gnss_Sample_Bus_Writer>(SAMPLE_BUS_TEST_NAME, sizeof(int16_t), 4096, false);
+    auto top_block = gr::make_top_block("SampleBusSourceTest");
+    auto source = make_sample_bus_source(sizeof(int16_t), SAMPLE_BUS_TEST_NAME, 1000);
+    auto sink = gr::blocks::vector_sink_s::make();
+    top_block->connect(source, 0, sink, 0);
+    top_block->start();
+
+    const std::vector<int16_t> input = bus_ramp(0, 3000);
+    writer->write(input.data(), input.size(), 0);
+    writer->close();
+    top_block->wait();
+
+    EXPECT_EQ(sink->data(), input);
+    EXPECT_EQ(source->get_lost_samples(), 0U);
+}
@@ -0,0 +1,107 @@
+/*!
+ * \file sample_push_source_test.cc
+ * \brief Implements Unit Tests for the samples pushed by an application
+ * that embeds the receiver
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sample_push_channel.h"
+#include "sample_push_source.h"
+#include <gnuradio/blocks/vector_sink.h>
+#include <gnuradio/top_block.h>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+
+TEST(SamplePushSourceTest, ReadsWholeItemsAcrossTheBuffers)
+{
+    Gnss_Sample_Push_Channel channel(4);
+    std::vector<int16_t> first = {1, 2, 3};  // one item and a half
+    std::vector<int16_t> second = {4, 5, 6, 7, 8};
+    int released = 0;
+    ASSERT_TRUE(channel.push(first.data(), first.size() * sizeof(int16_t), [&released] { released++; }));
+    ASSERT_TRUE(channel.push(second.data(), second.size() * sizeof(int16_t), [&released] { released++; }));
+
+    std::vector<int16_t> out(8);
+    EXPECT_EQ(channel.read(out.data(), 1, 2 * sizeof(int16_t), 0), 1U);
+    EXPECT_EQ(released, 0);
+    EXPECT_EQ(channel.read(out.data() + 2, 10, 2 * sizeof(int16_t), 0), 3U);
+    EXPECT_EQ(released, 2);
+    for (int16_t i = 0; i < 8; i++)
+        {
+            EXPECT_EQ(out[i], i + 1);
+        }
+
+    // nothing left, and the stream is not closed
+    EXPECT_EQ(channel.read(out.data(), 10, 2 * sizeof(int16_t), 10), 0U);
+    EXPECT_FALSE(channel.finished());
+    channel.close();
+    EXPECT_TRUE(channel.finished());
+    EXPECT_FALSE(channel.push(first.data(), first.size() * sizeof(int16_t), [&released] { released++; }));
+    EXPECT_EQ(released, 2);
+    EXPECT_EQ(channel.pushed_bytes(), 8 * sizeof(int16_t));
+}
+
+
+TEST(SamplePushSourceTest, WaitsForTheReader)
+{
+    Gnss_Sample_Push_Channel channel(2);
+    std::vector<int32_t> samples(1000);
+    for (size_t i = 0; i < samples.size(); i++)
+        {
+            samples[i] = static_cast<int32_t>(i);
+        }
+    std::thread producer([&channel, &samples] {
+        for (size_t i = 0; i < samples.size(); i += 100)
+            {
+                channel.push(samples.data() + i, 100 * sizeof(int32_t));
+            }
+        channel.close();
+    });
+
+    std::vector<int32_t> out;
+    std::vector<int32_t> block(64);
+    while (!channel.finished())
+        {
+            const size_t nitems = channel.read(block.data(), block.size(), sizeof(int32_t), 100);
+            out.insert(out.end(), block.begin(), block.begin() + nitems);
+        }
+    producer.join();
+    EXPECT_EQ(out, samples);
+}
+
+
+TEST(SamplePushSourceTest, FeedsTheFlowgraph)
+{
+    auto channel = Gnss_Sample_Push_Channel::get("sample_push_source_test");
+    EXPECT_EQ(Gnss_Sample_Push_Channel::get("sample_push_source_test"), channel);
+
+    auto source = make_sample_push_source(sizeof(int16_t), "sample_push_source_test");
+    auto sink = gr::blocks::vector_sink_s::make();
+    auto top_block = gr::make_top_block("SamplePushSourceTest");
+    top_block->connect(source, 0, sink, 0);
+
+    std::vector<int16_t> samples(5000);
+    for (size_t i = 0; i < samples.size(); i++)
+        {
+            samples[i] = static_cast<int16_t>(i);
+        }
+    bool released = false;
+    ASSERT_TRUE(channel->push(samples.data(), samples.size() * sizeof(int16_t), [&released] { released = true; }));
+    channel->close();
+    top_block->run();  // until the channel is drained
+
+    EXPECT_TRUE(released);
+    EXPECT_EQ(sink->data(), samples);
+}
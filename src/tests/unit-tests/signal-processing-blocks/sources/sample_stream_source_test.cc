@@ -0,0 +1,154 @@
+/*!
+ * \file sample_stream_source_test.cc
+ * \brief Implements Unit Tests for the sample stream sender, receiver and
+ * source
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sample_stream.h"
+#include "sample_stream_source.h"
+#include <gnuradio/blocks/head.h>
+#include <gnuradio/top_block.h>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#ifdef GR_GREATER_38
+#include <gnuradio/blocks/vector_sink.h>
+#else
+#include <gnuradio/blocks/vector_sink_s.h>
+#endif
+
+
+namespace
+{
+constexpr uint16_t SAMPLE_STREAM_TEST_PORT = 47311;
+
+std::vector<int16_t> ramp(int16_t first, size_t n)
+{
+    std::vector<int16_t> values(n);
+    for (size_t i = 0; i < n; i++)
+        {
+            values[i] = static_cast<int16_t>(first + i);
+        }
+    return values;
+}
+
+
+std::vector<int16_t> read_all(Gnss_Sample_Stream_Receiver& receiver, size_t max_items)
+{
+    std::vector<int16_t> output(max_items);
+    size_t n = 0;
+    size_t read = 0;
+    do
+        {
+            read = receiver.read(output.data() + n, max_items - n, 200);
+            n += read;
+        }
+    while (read > 0 and n < max_items);
+    output.resize(n);
+    return output;
+}
+}  // namespace
+
+
+TEST(SampleStreamTest, HeaderRoundTrip)
+{
+    Gnss_Sample_Stream_Header header;
+    header.sequence = 7;
+    header.items = 3;
+    header.first_sample = 0x123456789ULL;
+    header.item_size = 4;
+    std::vector<uint8_t> buffer(Gnss_Sample_Stream_Header::SIZE + 12);
+    header.encode(buffer.data());
+
+    Gnss_Sample_Stream_Header decoded;
+    ASSERT_TRUE(decoded.decode(buffer.data(), buffer.size()));
+    EXPECT_EQ(decoded.sequence, 7U);
+    EXPECT_EQ(decoded.items, 3U);
+    EXPECT_EQ(decoded.first_sample, 0x123456789ULL);
+    EXPECT_EQ(decoded.item_size, 4U);
+
+    // truncated payload, and not a sample stream datagram
+    EXPECT_FALSE(decoded.decode(buffer.data(), buffer.size() - 1));
+    buffer[0] = 0;
+    EXPECT_FALSE(decoded.decode(buffer.data(), buffer.size()));
+}
+
+
+TEST(SampleStreamTest, InvalidAddress)
+{
+    EXPECT_THROW(Gnss_Sample_Stream_Sender("not an address", SAMPLE_STREAM_TEST_PORT, 2), std::runtime_error);
+}
+
+
+TEST(SampleStreamTest, LossesAreFilledWithZeros)
+{
+    Gnss_Sample_Stream_Receiver receiver("127.0.0.1", SAMPLE_STREAM_TEST_PORT, sizeof(int16_t), 1000);
+    Gnss_Sample_Stream_Sender sender("127.0.0.1", SAMPLE_STREAM_TEST_PORT, sizeof(int16_t), 64 * sizeof(int16_t));
+
+    const auto first = ramp(1, 100);
+    const auto second = ramp(301, 100);
+    sender.send(first.data(), first.size(), 1000);
+    sender.send(second.data(), second.size(), 1150);  // 50 samples lost
+    sender.send(first.data(), 20, 1010);              // late
+    EXPECT_EQ(sender.datagrams(), 5U);
+
+    const auto output = read_all(receiver, 1000);
+    ASSERT_EQ(output.size(), 250U);
+    EXPECT_EQ(receiver.first_sample(), 1000U);
+    EXPECT_EQ(receiver.lost_samples(), 50U);
+    EXPECT_EQ(receiver.late_datagrams(), 1U);
+    EXPECT_EQ(receiver.resyncs(), 0U);
+    for (size_t i = 0; i < 100; i++)
+        {
+            EXPECT_EQ(output[i], first[i]);
+            EXPECT_EQ(output[100 + i / 2], 0);
+            EXPECT_EQ(output[150 + i], second[i]);
+        }
+}
+
+
+TEST(SampleStreamTest, LongLossesResync)
+{
+    Gnss_Sample_Stream_Receiver receiver("127.0.0.1", SAMPLE_STREAM_TEST_PORT, sizeof(int16_t), 10);
+    Gnss_Sample_Stream_Sender sender("127.0.0.1", SAMPLE_STREAM_TEST_PORT, sizeof(int16_t));
+
+    const auto samples = ramp(1, 40);
+    sender.send(samples.data(), 20, 0);
+    sender.send(samples.data() + 20, 20, 5000);
+
+    const auto output = read_all(receiver, 1000);
+    EXPECT_EQ(output, samples);
+    EXPECT_EQ(receiver.lost_samples(), 4980U);
+    EXPECT_EQ(receiver.resyncs(), 1U);
+}
+
+
+TEST(SampleStreamTest, SourceBlock)
+{
+    auto source = make_sample_stream_source(sizeof(int16_t), "127.0.0.1", SAMPLE_STREAM_TEST_PORT, 1000);
+    Gnss_Sample_Stream_Sender sender("127.0.0.1", SAMPLE_STREAM_TEST_PORT, sizeof(int16_t));
+    const auto samples = ramp(-500, 1000);
+    sender.send(samples.data(), samples.size(), 0);
+
+    auto top_block = gr::make_top_block("SampleStreamSourceTest");
+    auto head = gr::blocks::head::make(sizeof(int16_t), samples.size());
+    auto sink = gr::blocks::vector_sink_s::make();
+    top_block->connect(source, 0, head, 0);
+    top_block->connect(head, 0, sink, 0);
+    top_block->run();
+
+    EXPECT_EQ(sink->data(), samples);
+    EXPECT_EQ(source->get_lost_samples(), 0U);
+}
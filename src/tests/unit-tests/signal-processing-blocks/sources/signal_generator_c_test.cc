@@ -0,0 +1,126 @@
+/*!
+ * \file signal_generator_c_test.cc
+ * \brief Tests of the signal_generator_c block: the threaded synthesis
+ * against the single-threaded one, and the statistics of the noise
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "signal_generator_c.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+struct Signal_Generator_Test_Satellites
+{
+    std::vector<std::string> signal;
+    std::vector<std::string> system;
+    std::vector<unsigned int> PRN;
+    std::vector<float> CN0_dB;
+    std::vector<float> doppler_Hz;
+    std::vector<unsigned int> delay_chips;
+    std::vector<unsigned int> delay_sec;
+
+    void add(const std::string& sig, const std::string& sys, unsigned int prn, float cn0_db, float doppler, unsigned int delay)
+    {
+        signal.push_back(sig);
+        system.push_back(sys);
+        PRN.push_back(prn);
+        CN0_dB.push_back(cn0_db);
+        doppler_Hz.push_back(doppler);
+        delay_chips.push_back(delay);
+        delay_sec.push_back(0);
+    }
+};
+
+
+std::vector<gr_complex> signal_generator_test_run(const Signal_Generator_Test_Satellites& sats, bool noise_flag,
+    unsigned int fs_in, unsigned int vector_length, unsigned int num_threads, int num_vectors)
+{
+    auto generator = signal_make_generator_c(sats.signal, sats.system, sats.PRN, sats.CN0_dB, sats.doppler_Hz,
+        sats.delay_chips, sats.delay_sec, false, noise_flag, fs_in, vector_length, 1.0, num_threads);
+    std::vector<gr_complex> output(static_cast<size_t>(vector_length) * num_vectors);
+    gr_vector_int ninput_items;
+    gr_vector_const_void_star input_items;
+    for (int n = 0; n < num_vectors; n++)
+        {
+            gr_vector_void_star output_items(1, output.data() + static_cast<size_t>(n) * vector_length);
+            generator->general_work(1, ninput_items, input_items, output_items);
+        }
+    return output;
+}
+}  // namespace
+
+
+TEST(SignalGeneratorCTest, ThreadedSynthesisMatchesSingleThread)
+{
+    Signal_Generator_Test_Satellites sats;
+    sats.add("1B", "E", 11, 45.0, 1500.0, 100);
+    sats.add("1C", "G", 1, 45.0, 1000.0, 200);
+    sats.add("1B", "E", 12, 40.0, -700.0, 0);
+    sats.add("1C", "G", 3, 42.0, -2500.0, 17);
+    sats.add("1C", "G", 7, 47.0, 300.0, 511);
+    const unsigned int fs_in = 4000000;
+    const unsigned int vector_length = fs_in / 1000 * 4 * 25;  // 100 ms, as set by the adapter with Galileo E1
+
+    const std::vector<gr_complex> single = signal_generator_test_run(sats, false, fs_in, vector_length, 1, 3);
+    const std::vector<gr_complex> threaded = signal_generator_test_run(sats, false, fs_in, vector_length, 3, 3);
+    ASSERT_EQ(single.size(), threaded.size());
+    float max_error = 0.0;
+    float max_abs = 0.0;
+    for (size_t i = 0; i < single.size(); i++)
+        {
+            max_error = std::max(max_error, std::abs(single[i] - threaded[i]));
+            max_abs = std::max(max_abs, std::abs(single[i]));
+        }
+    EXPECT_GT(max_abs, 1.0);
+    EXPECT_LT(max_error, 1e-5 * max_abs);
+}
+
+
+TEST(SignalGeneratorCTest, NoiseIsUnitVarianceComplexGaussian)
+{
+    // A signal far below the noise floor
+    Signal_Generator_Test_Satellites sats;
+    sats.add("1C", "G", 1, -100.0, 0.0, 0);
+    const unsigned int fs_in = 4000000;
+    const unsigned int vector_length = fs_in / 1000;
+
+    const std::vector<gr_complex> output = signal_generator_test_run(sats, true, fs_in, vector_length, 1, 50);
+    double mean_i = 0.0;
+    double mean_q = 0.0;
+    double power_i = 0.0;
+    double power_q = 0.0;
+    double cross = 0.0;
+    double fourth_i = 0.0;
+    for (const auto& sample : output)
+        {
+            mean_i += sample.real();
+            mean_q += sample.imag();
+            power_i += sample.real() * sample.real();
+            power_q += sample.imag() * sample.imag();
+            cross += sample.real() * sample.imag();
+            fourth_i += std::pow(sample.real(), 4);
+        }
+    const auto n = static_cast<double>(output.size());
+    EXPECT_NEAR(mean_i / n, 0.0, 0.01);
+    EXPECT_NEAR(mean_q / n, 0.0, 0.01);
+    EXPECT_NEAR(power_i / n, 1.0, 0.01);
+    EXPECT_NEAR(power_q / n, 1.0, 0.01);
+    EXPECT_NEAR(cross / n, 0.0, 0.01);
+    // The kurtosis of a Gaussian is 3
+    EXPECT_NEAR(fourth_i / n, 3.0, 0.1);
+}
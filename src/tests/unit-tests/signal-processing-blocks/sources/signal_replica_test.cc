@@ -0,0 +1,91 @@
+/*!
+ * \file signal_replica_test.cc
+ * \brief Implements Unit Tests for the delayed and frequency shifted replicas
+ * of a signal
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "MATH_CONSTANTS.h"
+#include "signal_replica.h"
+#include <gnuradio/blocks/head.h>
+#include <gnuradio/blocks/vector_source.h>
+#include <gnuradio/top_block.h>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#ifdef GR_GREATER_38
+#include <gnuradio/blocks/vector_sink.h>
+#else
+#include <gnuradio/blocks/vector_sink_c.h>
+#endif
+
+
+namespace
+{
+std::vector<gr_complex> signal_replica_test_run(const std::vector<gr_complex>& input, double fs, double doppler_hz, uint64_t delay_samples)
+{
+    auto top_block = gr::make_top_block("SignalReplicaTest");
+    auto source = gr::blocks::vector_source_c::make(input);
+    auto replica = make_signal_replica(sizeof(gr_complex), fs, doppler_hz, delay_samples);
+    auto head = gr::blocks::head::make(sizeof(gr_complex), input.size());
+    auto sink = gr::blocks::vector_sink_c::make();
+    top_block->connect(source, 0, replica, 0);
+    top_block->connect(replica, 0, head, 0);
+    top_block->connect(head, 0, sink, 0);
+    top_block->run();
+    return sink->data();
+}
+}  // namespace
+
+
+TEST(SignalReplicaTest, DelayedByZeros)
+{
+    std::vector<gr_complex> input(10000);
+    for (size_t i = 0; i < input.size(); i++)
+        {
+            input[i] = gr_complex(static_cast<float>(i + 1), -static_cast<float>(i));
+        }
+    const uint64_t delay = 1234;
+    const std::vector<gr_complex> output = signal_replica_test_run(input, 4e6, 0.0, delay);
+    ASSERT_EQ(output.size(), input.size());
+    for (size_t i = 0; i < output.size(); i++)
+        {
+            EXPECT_EQ(output[i], i < delay ? gr_complex(0.0, 0.0) : input[i - delay]);
+        }
+}
+
+
+TEST(SignalReplicaTest, ShiftedInFrequency)
+{
+    const double fs = 4e6;
+    const double doppler_hz = 1500.0;
+    std::vector<gr_complex> input(100000, gr_complex(1.0, 0.0));
+    const std::vector<gr_complex> output = signal_replica_test_run(input, fs, doppler_hz, 0);
+    ASSERT_EQ(output.size(), input.size());
+    for (size_t i = 0; i < output.size(); i++)
+        {
+            const double phase = TWO_PI * doppler_hz * static_cast<double>(i) / fs;
+            EXPECT_NEAR(std::arg(output[i] * std::conj(gr_complex(std::cos(phase), std::sin(phase)))), 0.0, 2e-3);
+            EXPECT_NEAR(std::abs(output[i]), 1.0, 1e-4);
+        }
+}
+
+
+TEST(SignalReplicaTest, FrequencyShiftNeedsComplexItems)
+{
+    EXPECT_THROW(make_signal_replica(sizeof(int16_t), 4e6, 1500.0, 0), std::invalid_argument);
+    EXPECT_NO_THROW(make_signal_replica(sizeof(int16_t), 4e6, 0.0, 10));
+}
@@ -0,0 +1,112 @@
+/*!
+ * \file tlm_deinterleaver_test.cc
+ * \brief  Tests of the deinterleaver of soft symbols and of the decoder of
+ * the BeiDou DNAV words
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "Galileo_CNAV.h"
+#include "Galileo_E5a.h"
+#include "Galileo_INAV.h"
+#include "beidou_dnav_word_decoder.h"
+#include "tlm_deinterleaver.h"
+#include <gtest/gtest.h>
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+
+TEST(TlmDeinterleaverTest, MatchesTheGalileoDeinterleaving)
+{
+    const std::array<std::array<int32_t, 2>, 3> blocks{{{GALILEO_INAV_INTERLEAVER_ROWS, GALILEO_INAV_INTERLEAVER_COLS},
+        {GALILEO_FNAV_INTERLEAVER_ROWS, GALILEO_FNAV_INTERLEAVER_COLS},
+        {GALILEO_CNAV_INTERLEAVER_ROWS, GALILEO_CNAV_INTERLEAVER_COLS}}};
+    std::mt19937 gen(1);
+    std::normal_distribution<float> dist(0.0, 1.0);
+    for (const auto& block : blocks)
+        {
+            const int32_t rows = block[0];
+            const int32_t cols = block[1];
+            const Tlm_Deinterleaver deinterleaver(rows, cols, true);
+            ASSERT_EQ(deinterleaver.size(), rows * cols);
+            std::vector<float> in(rows * cols);
+            for (auto& symbol : in)
+                {
+                    symbol = dist(gen);
+                }
+            for (const bool inverted : {false, true})
+                {
+                    // as the decoder did it: polarity, deinterleaving and G2 NOT gate
+                    std::vector<float> expected(rows * cols);
+                    for (int32_t r = 0; r < rows; r++)
+                        {
+                            for (int32_t c = 0; c < cols; c++)
+                                {
+                                    expected[c * rows + r] = inverted ? -in[r * cols + c] : in[r * cols + c];
+                                }
+                        }
+                    for (int32_t i = 1; i < rows * cols; i += 2)
+                        {
+                            expected[i] = -expected[i];
+                        }
+                    std::vector<float> out(rows * cols);
+                    deinterleaver.deinterleave(in.data(), out.data(), inverted);
+                    EXPECT_EQ(out, expected);
+                }
+        }
+}
+
+
+TEST(TlmDeinterleaverTest, CorrectsTheBeidouBchErrors)
+{
+    // BCH(15,11,1) is a perfect code: 2048 codewords, and each other word is
+    // at one bit of one of them
+    std::vector<uint32_t> codewords;
+    for (uint32_t word = 0; word < (1U << 15U); word++)
+        {
+            if (beidou_bch15_11_01_correct(word) == word)
+                {
+                    codewords.push_back(word);
+                }
+        }
+    ASSERT_EQ(codewords.size(), 2048U);
+    for (const auto codeword : codewords)
+        {
+            for (uint32_t i = 0; i < 15; i++)
+                {
+                    EXPECT_EQ(beidou_bch15_11_01_correct(codeword ^ (1U << i)), codeword);
+                }
+        }
+
+    // a word of two codewords, with an error in each and the inverted polarity
+    const uint32_t first = codewords[1234];
+    const uint32_t second = codewords[42];
+    std::array<float, 30> symbols{};
+    for (uint32_t c = 0; c < 15; c++)
+        {
+            symbols[2 * c] = ((((first ^ 0x10U) >> c) & 1U) ? -0.5F : 0.5F);
+            symbols[2 * c + 1] = ((((second ^ 0x4000U) >> c) & 1U) ? -0.5F : 0.5F);
+        }
+    std::array<char, 30> bits{};
+    beidou_dnav_decode_word(false, symbols.data(), -1.0F, bits.data());
+    for (uint32_t j = 0; j < 11; j++)
+        {
+            EXPECT_EQ(bits[j], ((first >> j) & 1U) ? '1' : '0');
+            EXPECT_EQ(bits[j + 11], ((second >> j) & 1U) ? '1' : '0');
+        }
+    for (uint32_t j = 0; j < 4; j++)
+        {
+            EXPECT_EQ(bits[j + 22], ((first >> (11 + j)) & 1U) ? '1' : '0');
+            EXPECT_EQ(bits[j + 26], ((second >> (11 + j)) & 1U) ? '1' : '0');
+        }
+}
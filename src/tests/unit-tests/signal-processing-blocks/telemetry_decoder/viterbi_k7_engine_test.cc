@@ -0,0 +1,136 @@
+/*!
+ * \file viterbi_k7_engine_test.cc
+ * \brief  Tests of the Viterbi decoder of the K=7, rate 1/2 convolutional codes
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "viterbi_decoder.h"
+#include "viterbi_k7_engine.h"
+#include <gtest/gtest.h>
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+
+namespace
+{
+const std::array<int32_t, 2> g_encoder{121, 91};  // Galileo, GPS L2C and L5, and SBAS
+
+
+// encodes the bits followed by a zero tail, with the newest bit in the MSB of the polynomials
+std::vector<float> encode(const std::vector<int32_t>& bits, float amplitude)
+{
+    std::vector<float> symbols;
+    int32_t state = 0;
+    std::vector<int32_t> tailed_bits(bits);
+    tailed_bits.insert(tailed_bits.end(), 6, 0);
+    for (const auto bit : tailed_bits)
+        {
+            const int32_t word = (bit << 6) ^ state;
+            for (const auto g : g_encoder)
+                {
+                    int32_t parity = 0;
+                    for (int32_t i = 0; i < 7; i++)
+                        {
+                            parity ^= ((word & g) >> i) & 1;
+                        }
+                    symbols.push_back(parity ? amplitude : -amplitude);
+                }
+            state = word >> 1;
+        }
+    return symbols;
+}
+
+
+std::vector<int32_t> random_bits(uint32_t n, std::mt19937& gen)
+{
+    std::uniform_int_distribution<int32_t> dist(0, 1);
+    std::vector<int32_t> bits(n);
+    for (auto& bit : bits)
+        {
+            bit = dist(gen);
+        }
+    return bits;
+}
+}  // namespace
+
+
+TEST(ViterbiK7EngineTest, SupportedCodes)
+{
+    EXPECT_TRUE(Viterbi_K7_Engine::supports(7, 2, g_encoder.data()));
+    EXPECT_FALSE(Viterbi_K7_Engine::supports(5, 2, g_encoder.data()));
+    EXPECT_FALSE(Viterbi_K7_Engine::supports(7, 3, g_encoder.data()));
+}
+
+
+TEST(ViterbiK7EngineTest, BlockDecoding)
+{
+    std::mt19937 gen(1);
+    std::normal_distribution<float> noise(0.0, 0.6);
+    const int32_t LL = 240;
+    const std::vector<int32_t> bits = random_bits(LL, gen);
+
+    Viterbi_Decoder decoder(7, 2, LL, g_encoder);
+    std::vector<int32_t> decoded(LL);
+    std::vector<float> symbols = encode(bits, 1.0);
+    decoder.decode(decoded, symbols);
+    EXPECT_EQ(decoded, bits);
+
+    for (auto& symbol : symbols)
+        {
+            symbol += noise(gen);
+        }
+    decoder.decode(decoded, symbols);
+    EXPECT_EQ(decoded, bits);
+}
+
+
+TEST(ViterbiK7EngineTest, StreamingDecodingMatchesBlockDecoding)
+{
+    std::mt19937 gen(2);
+    std::normal_distribution<float> noise(0.0, 0.8);
+    const uint32_t nbits = 2000;
+    const uint32_t chunk = 37;
+    const uint32_t traceback_depth = 35;
+    const std::vector<int32_t> bits = random_bits(nbits, gen);
+    std::vector<float> symbols = encode(bits, 1.0);
+    for (auto& symbol : symbols)
+        {
+            symbol += noise(gen);
+        }
+
+    Viterbi_K7_Engine block(g_encoder);
+    std::vector<int32_t> block_bits(nbits);
+    block.update(symbols.data(), nbits + 6);
+    block.traceback(0, 6, nbits, block_bits.data());
+
+    Viterbi_K7_Engine stream(g_encoder);
+    std::vector<int32_t> stream_bits;
+    std::vector<int32_t> decoded(chunk);
+    for (uint32_t n = 0; n + chunk <= nbits; n += chunk)
+        {
+            stream.update(symbols.data() + 2 * n, chunk);
+            if (stream.size() > traceback_depth)
+                {
+                    const uint32_t n_decoded = stream.size() - traceback_depth;
+                    stream.traceback(stream.best_state(), traceback_depth, n_decoded, decoded.data());
+                    stream_bits.insert(stream_bits.end(), decoded.begin(), decoded.begin() + n_decoded);
+                    stream.discard(n_decoded);
+                }
+        }
+    ASSERT_GT(stream_bits.size(), nbits / 2);
+    for (uint32_t i = 0; i < stream_bits.size(); i++)
+        {
+            EXPECT_EQ(stream_bits[i], block_bits[i]) << "at bit " << i;
+        }
+}
@@ -53,3 +53,43 @@ TEST(BayesianEstimationPositivityTest, BayesianPositivityTest)
                 }
         }
 }
+
+
+TEST(BayesianEstimationTest, SequentialSameAsBatch)
+{
+    const int ny = 2;
+    const int n_samples = 1000;
+    std::default_random_engine e1(1);
+    std::normal_distribution<double> normal_dist(0.5, 2.0);
+    arma::mat samples(ny, n_samples);
+    for (auto& sample : samples)
+        {
+            sample = normal_dist(e1);
+        }
+
+    // with kappa = 0, the posteriors are the mean and the scatter matrix of the samples
+    Bayesian_estimator bayes;
+    bayes.init(arma::zeros(ny, 1), 0, 0, arma::eye(ny, ny));
+    arma::vec input(ny);
+    for (int n = 0; n < n_samples; n++)
+        {
+            input = samples.col(n);
+            bayes.update_sequential(input);
+        }
+
+    const arma::vec mean = arma::mean(samples, 1);
+    arma::mat scatter = arma::eye(ny, ny);
+    for (int n = 0; n < n_samples; n++)
+        {
+            scatter += (samples.col(n) - mean) * (samples.col(n) - mean).t();
+        }
+    const arma::mat Psi = scatter / (n_samples - ny - 1);
+    for (int i = 0; i < ny; i++)
+        {
+            EXPECT_NEAR(bayes.get_mu_est()(i), mean(i), 1e-9);
+            for (int j = 0; j < ny; j++)
+                {
+                    EXPECT_NEAR(bayes.get_Psi_est()(i, j), Psi(i, j), 1e-5);
+                }
+        }
+}
@@ -0,0 +1,138 @@
+/*!
+ * \file cpu_multicorrelator_8ic_test.cc
+ * \brief  Tests the integer correlator of 8-bit and 16-bit complex samples against the
+ * single-precision correlator.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "GPS_L1_CA.h"
+#include "cpu_multicorrelator_8ic.h"
+#include "cpu_multicorrelator_real_codes.h"
+#include "gps_sdr_signal_replica.h"
+#include <gnuradio/gr_complex.h>
+#include <gtest/gtest.h>
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>
+#include <cmath>
+#include <complex>
+#include <random>
+
+
+TEST(CpuMulticorrelator8icTest, SameResultsAsRealCodes)
+{
+    const int n_correlator_taps = 3;
+    const int correlation_length = 10000;  // more than one block of the integer NCOs
+    const float code_phase_step_chips = 0.25575;
+    const float rem_code_phase_chips = 0.3;
+    const auto code_length_chips = static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS);
+    volk_gnsssdr::vector<float> pilot_code(code_length_chips);
+    volk_gnsssdr::vector<float> data_code(code_length_chips);
+    gps_l1_ca_code_gen_float(pilot_code, 1, 0);
+    gps_l1_ca_code_gen_float(data_code, 7, 0);
+    volk_gnsssdr::vector<float> local_code_shift_chips{-0.5, 0.0, 0.5};
+
+    const float phase_rate_steps_rad[2] = {0.0, 1e-9};
+    for (float phase_rate_step_rad : phase_rate_steps_rad)
+        {
+            // 2-bit samples of the pilot code with a carrier and noise
+            volk_gnsssdr::vector<lv_8sc_t> in(correlation_length);
+            volk_gnsssdr::vector<gr_complex> in_float(correlation_length);
+            std::default_random_engine e1(1234);
+            std::normal_distribution<float> noise(0.0, 1.0);
+            auto quantize = [](float x) { return static_cast<int8_t>(x < -1.0 ? -3 : (x < 0.0 ? -1 : (x < 1.0 ? 1 : 3))); };
+            for (int n = 0; n < correlation_length; n++)
+                {
+                    const auto chip = static_cast<int>(std::floor(code_phase_step_chips * static_cast<float>(n) - rem_code_phase_chips + static_cast<float>(code_length_chips))) % code_length_chips;
+                    const auto carrier_phase_rad = static_cast<float>(0.4 + 0.05 * n + static_cast<double>(phase_rate_step_rad) * n * n);
+                    const gr_complex sample = 2.0F * pilot_code[chip] * std::exp(gr_complex(0.0, carrier_phase_rad)) + gr_complex(noise(e1), noise(e1));
+                    in[n] = lv_8sc_t(quantize(sample.real()), quantize(sample.imag()));
+                    in_float[n] = gr_complex(in[n].real(), in[n].imag());
+                }
+
+            volk_gnsssdr::vector<gr_complex> outs(n_correlator_taps);
+            volk_gnsssdr::vector<gr_complex> data_out(1);
+            Cpu_Multicorrelator_Real_Codes correlator;
+            correlator.init(correlation_length, n_correlator_taps, 1);
+            correlator.set_high_dynamics_resampler(phase_rate_step_rad != 0.0);
+            correlator.set_local_code_and_taps(code_length_chips, pilot_code.data(), local_code_shift_chips.data());
+            correlator.set_data_local_code_and_taps(code_length_chips, data_code.data(), &local_code_shift_chips[1]);
+            correlator.set_input_output_vectors(outs.data(), in_float.data());
+            correlator.set_data_output_vector(data_out.data());
+            correlator.Carrier_wipeoff_multicorrelator_resampler(0.4, 0.05, phase_rate_step_rad, rem_code_phase_chips, code_phase_step_chips, 0.0, correlation_length);
+
+            volk_gnsssdr::vector<gr_complex> int_outs(n_correlator_taps);
+            volk_gnsssdr::vector<gr_complex> int_data_out(1);
+            Cpu_Multicorrelator_8ic int_correlator;
+            int_correlator.init(correlation_length, n_correlator_taps, 1);
+            int_correlator.set_local_code_and_taps(code_length_chips, pilot_code.data(), local_code_shift_chips.data());
+            int_correlator.set_data_local_code_and_taps(code_length_chips, data_code.data(), &local_code_shift_chips[1]);
+            int_correlator.set_input_output_vectors(int_outs.data(), in.data());
+            int_correlator.set_data_output_vector(int_data_out.data());
+            int_correlator.Carrier_wipeoff_multicorrelator_resampler(0.4, 0.05, phase_rate_step_rad, rem_code_phase_chips, code_phase_step_chips, 0.0, correlation_length);
+
+            // the carrier of the integer NCO has 64 phases
+            const float tolerance = 0.02F * std::abs(outs[1]);
+            // (the high dynamics resampler shifts the first tap to get the others)
+            for (int k = 0; k < (phase_rate_step_rad == 0.0 ? n_correlator_taps : 1); k++)
+                {
+                    EXPECT_NEAR(int_outs[k].real(), outs[k].real(), tolerance);
+                    EXPECT_NEAR(int_outs[k].imag(), outs[k].imag(), tolerance);
+                }
+            EXPECT_NEAR(int_data_out[0].real(), data_out[0].real(), tolerance);
+            EXPECT_NEAR(int_data_out[0].imag(), data_out[0].imag(), tolerance);
+            EXPECT_GT(std::abs(int_outs[1]), 1.5F * std::abs(int_outs[0]));
+
+            correlator.free();
+            int_correlator.free();
+        }
+}
+
+
+TEST(CpuMulticorrelator8icTest, SameResultsWith16BitSamples)
+{
+    const int n_correlator_taps = 3;
+    const int correlation_length = 10000;
+    const float code_phase_step_chips = 0.25575;
+    const float rem_code_phase_chips = 0.3;
+    const auto code_length_chips = static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS);
+    volk_gnsssdr::vector<float> pilot_code(code_length_chips);
+    gps_l1_ca_code_gen_float(pilot_code, 1, 0);
+    volk_gnsssdr::vector<float> local_code_shift_chips{-0.5, 0.0, 0.5};
+
+    // the same 8-bit samples, also stored as 16-bit samples
+    volk_gnsssdr::vector<lv_8sc_t> in(correlation_length);
+    volk_gnsssdr::vector<lv_16sc_t> in_16ic(correlation_length);
+    std::default_random_engine e1(1234);
+    std::uniform_int_distribution<int> sample(-128, 127);
+    for (int n = 0; n < correlation_length; n++)
+        {
+            in[n] = lv_8sc_t(static_cast<int8_t>(sample(e1)), static_cast<int8_t>(sample(e1)));
+            in_16ic[n] = lv_16sc_t(in[n].real(), in[n].imag());
+        }
+
+    volk_gnsssdr::vector<gr_complex> outs(n_correlator_taps);
+    volk_gnsssdr::vector<gr_complex> outs_16ic(n_correlator_taps);
+    Cpu_Multicorrelator_8ic int_correlator;
+    int_correlator.init(correlation_length, n_correlator_taps);
+    int_correlator.set_local_code_and_taps(code_length_chips, pilot_code.data(), local_code_shift_chips.data());
+    int_correlator.set_input_output_vectors(outs.data(), in.data());
+    int_correlator.Carrier_wipeoff_multicorrelator_resampler(0.4, 0.05, 1e-9, rem_code_phase_chips, code_phase_step_chips, 0.0, correlation_length);
+    int_correlator.set_input_output_vectors(outs_16ic.data(), in_16ic.data());
+    int_correlator.Carrier_wipeoff_multicorrelator_resampler(0.4, 0.05, 1e-9, rem_code_phase_chips, code_phase_step_chips, 0.0, correlation_length);
+
+    for (int k = 0; k < n_correlator_taps; k++)
+        {
+            // the 16-bit kernel accumulates in single precision
+            EXPECT_NEAR(outs_16ic[k].real(), outs[k].real(), 1e-3F * std::abs(outs[k]) + 1e-2F);
+            EXPECT_NEAR(outs_16ic[k].imag(), outs[k].imag(), 1e-3F * std::abs(outs[k]) + 1e-2F);
+        }
+    int_correlator.free();
+}
@@ -0,0 +1,165 @@
+/*!
+ * \file cpu_multicorrelator_array_test.cc
+ * \brief  Tests the correlators of the elements of an antenna array against
+ * the single-element correlator, and the beam steered to the satellite.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "GPS_L1_CA.h"
+#include "array_beam_steering.h"
+#include "cpu_multicorrelator_array.h"
+#include "cpu_multicorrelator_real_codes.h"
+#include "gps_sdr_signal_replica.h"
+#include <gnuradio/gr_complex.h>
+#include <gtest/gtest.h>
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>
+#include <cmath>
+#include <complex>
+#include <random>
+#include <vector>
+
+
+TEST(CpuMulticorrelatorArrayTest, SameResultsAsRealCodes)
+{
+    const int n_elements = 4;
+    const int n_correlator_taps = 3;
+    const int correlation_length = 10000;  // more than one block
+    const float code_phase_step_chips = 0.25575;
+    const float rem_code_phase_chips = 0.3;
+    const auto code_length_chips = static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS);
+    volk_gnsssdr::vector<float> pilot_code(code_length_chips);
+    volk_gnsssdr::vector<float> data_code(code_length_chips);
+    gps_l1_ca_code_gen_float(pilot_code, 1, 0);
+    gps_l1_ca_code_gen_float(data_code, 7, 0);
+    volk_gnsssdr::vector<float> local_code_shift_chips{-0.5, 0.0, 0.5};
+
+    // the samples of the elements, interleaved, with a phase and a gain of their own
+    volk_gnsssdr::vector<gr_complex> in(correlation_length * n_elements);
+    std::vector<volk_gnsssdr::vector<gr_complex>> element_in(n_elements, volk_gnsssdr::vector<gr_complex>(correlation_length));
+    std::default_random_engine e1(1234);
+    std::normal_distribution<float> noise(0.0, 1.0);
+    for (int n = 0; n < correlation_length; n++)
+        {
+            const auto chip = static_cast<int>(std::floor(code_phase_step_chips * static_cast<float>(n) - rem_code_phase_chips + static_cast<float>(code_length_chips))) % code_length_chips;
+            const auto carrier_phase_rad = static_cast<float>(0.4 + 0.05 * n);
+            for (int e = 0; e < n_elements; e++)
+                {
+                    const gr_complex sample = (1.0F + 0.2F * static_cast<float>(e)) * pilot_code[chip] * std::exp(gr_complex(0.0, carrier_phase_rad + 0.7F * static_cast<float>(e))) + gr_complex(noise(e1), noise(e1));
+                    in[n * n_elements + e] = sample;
+                    element_in[e][n] = sample;
+                }
+        }
+
+    volk_gnsssdr::vector<gr_complex> array_outs(n_elements * n_correlator_taps);
+    volk_gnsssdr::vector<gr_complex> array_data_outs(n_elements);
+    Cpu_Multicorrelator_Array array_correlator;
+    array_correlator.init(correlation_length, n_correlator_taps, n_elements, 1);
+    array_correlator.set_local_code_and_taps(code_length_chips, pilot_code.data(), local_code_shift_chips.data());
+    array_correlator.set_data_local_code_and_taps(code_length_chips, data_code.data(), &local_code_shift_chips[1]);
+    array_correlator.set_input_output_vectors(array_outs.data(), in.data());
+    array_correlator.set_data_output_vector(array_data_outs.data());
+    array_correlator.Carrier_wipeoff_multicorrelator_resampler(0.4, 0.05, 0.0, rem_code_phase_chips, code_phase_step_chips, 0.0, correlation_length);
+
+    for (int e = 0; e < n_elements; e++)
+        {
+            volk_gnsssdr::vector<gr_complex> outs(n_correlator_taps);
+            volk_gnsssdr::vector<gr_complex> data_out(1);
+            Cpu_Multicorrelator_Real_Codes correlator;
+            correlator.init(correlation_length, n_correlator_taps, 1);
+            correlator.set_high_dynamics_resampler(false);
+            correlator.set_local_code_and_taps(code_length_chips, pilot_code.data(), local_code_shift_chips.data());
+            correlator.set_data_local_code_and_taps(code_length_chips, data_code.data(), &local_code_shift_chips[1]);
+            correlator.set_input_output_vectors(outs.data(), element_in[e].data());
+            correlator.set_data_output_vector(data_out.data());
+            correlator.Carrier_wipeoff_multicorrelator_resampler(0.4, 0.05, 0.0, rem_code_phase_chips, code_phase_step_chips, 0.0, correlation_length);
+
+            const float prompt_magnitude = std::abs(outs[1]);
+            EXPECT_GT(prompt_magnitude, 0.5 * correlation_length);
+            for (int k = 0; k < n_correlator_taps; k++)
+                {
+                    EXPECT_LT(std::abs(array_outs[e * n_correlator_taps + k] - outs[k]), 1e-3 * prompt_magnitude) << "element " << e << ", correlator " << k;
+                }
+            EXPECT_LT(std::abs(array_data_outs[e] - data_out[0]), 1e-3 * prompt_magnitude) << "element " << e;
+        }
+}
+
+
+TEST(ArrayBeamSteeringTest, BroadsideBeforeTheFirstUpdate)
+{
+    const int n_elements = 4;
+    Array_Beam_Steering steering(n_elements, 0.1);
+    std::vector<gr_complex> element_corr{{1.0, 0.0}, {2.0, 0.0}, {3.0, 0.0}, {4.0, 0.0}};
+    gr_complex beam;
+    steering.combine(element_corr.data(), 1, &beam);
+    EXPECT_NEAR(beam.real(), 10.0 / 2.0, 1e-5);
+    EXPECT_NEAR(beam.imag(), 0.0, 1e-5);
+}
+
+
+TEST(ArrayBeamSteeringTest, SteersToTheSatellite)
+{
+    const int n_elements = 4;
+    const int n_correlators = 3;
+    const int prompt_index = 1;
+    Array_Beam_Steering steering(n_elements, 0.1);
+    std::default_random_engine e1(1234);
+    std::normal_distribution<float> noise(0.0, 1.0);
+    std::uniform_real_distribution<float> carrier_phase(0.0, 6.28);
+
+    // the response of the array to the satellite, unknown to the steering
+    std::vector<gr_complex> response(n_elements);
+    for (int e = 0; e < n_elements; e++)
+        {
+            response[e] = std::polar(1.0F, 1.3F * static_cast<float>(e * e));
+        }
+
+    gr_complex beam[n_correlators];
+    std::vector<gr_complex> element_corr(n_elements * n_correlators);
+    for (int epoch = 0; epoch < 200; epoch++)
+        {
+            // prompt correlations of amplitude 10, with a carrier phase that is not locked yet
+            const gr_complex signal = std::polar(10.0F, carrier_phase(e1));
+            for (int e = 0; e < n_elements; e++)
+                {
+                    for (int k = 0; k < n_correlators; k++)
+                        {
+                            element_corr[e * n_correlators + k] = (k == prompt_index ? response[e] * signal : gr_complex(0.0, 0.0)) + gr_complex(noise(e1), noise(e1));
+                        }
+                }
+            steering.combine(element_corr.data(), n_correlators, beam);
+            steering.update(element_corr.data(), n_correlators, prompt_index);
+        }
+
+    // the weights have unit norm, so the noise power of the beam is the one of an element
+    float norm = 0.0;
+    for (const auto& weight : steering.weights())
+        {
+            norm += std::norm(weight);
+        }
+    EXPECT_NEAR(norm, 1.0, 1e-4);
+
+    // coherent combination: the amplitude of the prompt correlation of the
+    // beam is sqrt(n_elements) times the one of an element, with the phase
+    // of the reference element
+    const gr_complex signal = std::polar(10.0F, 0.5F);
+    for (int e = 0; e < n_elements; e++)
+        {
+            element_corr[e * n_correlators + prompt_index] = response[e] * signal;
+        }
+    steering.combine(element_corr.data(), n_correlators, beam);
+    EXPECT_NEAR(std::abs(beam[prompt_index]), 10.0 * std::sqrt(static_cast<float>(n_elements)), 0.2);
+    EXPECT_NEAR(std::arg(beam[prompt_index] * std::conj(response[0] * signal)), 0.0, 0.05);
+
+    // a new satellite starts from the broadside beam
+    steering.reset();
+    EXPECT_NEAR(std::abs(steering.weights()[1] - gr_complex(0.5, 0.0)), 0.0, 1e-6);
+}
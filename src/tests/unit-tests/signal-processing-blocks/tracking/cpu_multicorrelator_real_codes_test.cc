@@ -16,6 +16,7 @@
  */
 
 #include "GPS_L1_CA.h"
+#include "code_replica_cache.h"
 #include "cpu_multicorrelator_real_codes.h"
 #include "gps_sdr_signal_replica.h"
 #include <gflags/gflags.h>
@@ -26,6 +27,7 @@
 #include <complex>
 #include <random>
 #include <thread>
+#include <vector>
 
 
 DEFINE_int32(cpu_multicorrelator_real_codes_iterations_test, 100, "Number of averaged iterations in CPU multicorrelator test timing test");
@@ -252,3 +254,267 @@ TEST(CpuMulticorrelatorRealCodesTest, MeasureExecutionTimeAlloc)
             correlator_pool[n]->free();
         }
 }
+
+
+TEST(CpuMulticorrelatorRealCodesTest, PilotDataCorrelators)
+{
+    const int n_correlator_taps = 3;
+    const int correlation_length = 4000;
+    const float phase_rate_steps_rad[2] = {0.0, 1e-9};
+    volk_gnsssdr::vector<float> pilot_code(static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS));
+    volk_gnsssdr::vector<float> data_code(static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS));
+    gps_l1_ca_code_gen_float(pilot_code, 1, 0);
+    gps_l1_ca_code_gen_float(data_code, 7, 0);
+    volk_gnsssdr::vector<float> local_code_shift_chips{-0.5, 0.0, 0.5};
+    volk_gnsssdr::vector<gr_complex> in(correlation_length);
+    std::default_random_engine e1(1234);
+    std::uniform_real_distribution<float> uniform_dist(-1.0, 1.0);
+    for (auto& sample : in)
+        {
+            sample = gr_complex(uniform_dist(e1), uniform_dist(e1));
+        }
+
+    for (int high_dyn = 0; high_dyn < 2; high_dyn++)
+        {
+            // separate pilot and data correlators
+            volk_gnsssdr::vector<gr_complex> pilot_outs(n_correlator_taps);
+            volk_gnsssdr::vector<gr_complex> data_out(1);
+            Cpu_Multicorrelator_Real_Codes pilot_correlator;
+            Cpu_Multicorrelator_Real_Codes data_correlator;
+            pilot_correlator.init(correlation_length, n_correlator_taps);
+            pilot_correlator.set_high_dynamics_resampler(high_dyn == 1);
+            pilot_correlator.set_local_code_and_taps(static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS), pilot_code.data(), local_code_shift_chips.data());
+            pilot_correlator.set_input_output_vectors(pilot_outs.data(), in.data());
+            data_correlator.init(correlation_length, 1);
+            data_correlator.set_high_dynamics_resampler(high_dyn == 1);
+            data_correlator.set_local_code_and_taps(static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS), data_code.data(), &local_code_shift_chips[1]);
+            data_correlator.set_input_output_vectors(data_out.data(), in.data());
+
+            // pilot and data correlators sharing the carrier wipe-off
+            volk_gnsssdr::vector<gr_complex> fused_pilot_outs(n_correlator_taps);
+            volk_gnsssdr::vector<gr_complex> fused_data_out(1);
+            Cpu_Multicorrelator_Real_Codes fused_correlator;
+            fused_correlator.init(correlation_length, n_correlator_taps, 1);
+            fused_correlator.set_high_dynamics_resampler(high_dyn == 1);
+            fused_correlator.set_local_code_and_taps(static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS), pilot_code.data(), local_code_shift_chips.data());
+            fused_correlator.set_data_local_code_and_taps(static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS), data_code.data(), &local_code_shift_chips[1]);
+            fused_correlator.set_input_output_vectors(fused_pilot_outs.data(), in.data());
+            fused_correlator.set_data_output_vector(fused_data_out.data());
+
+            for (auto* correlator : {&pilot_correlator, &data_correlator, &fused_correlator})
+                {
+                    correlator->Carrier_wipeoff_multicorrelator_resampler(0.4, 0.05, phase_rate_steps_rad[high_dyn], 0.3, 0.25575, 0.0, correlation_length);
+                }
+
+            for (int k = 0; k < n_correlator_taps; k++)
+                {
+                    EXPECT_NEAR(fused_pilot_outs[k].real(), pilot_outs[k].real(), 1e-3);
+                    EXPECT_NEAR(fused_pilot_outs[k].imag(), pilot_outs[k].imag(), 1e-3);
+                }
+            EXPECT_NEAR(fused_data_out[0].real(), data_out[0].real(), 1e-3);
+            EXPECT_NEAR(fused_data_out[0].imag(), data_out[0].imag(), 1e-3);
+
+            pilot_correlator.free();
+            data_correlator.free();
+            fused_correlator.free();
+        }
+}
+
+
+TEST(CpuMulticorrelatorRealCodesTest, CodeReplicaCache)
+{
+    const int n_correlator_taps = 3;
+    const int correlation_length = 4000;
+    const int phases_per_chip = 16;
+    const float code_phase_step_chips = 0.25575;
+    const float rem_code_phase_chips = 0.1;
+    volk_gnsssdr::vector<float> code(static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS));
+    volk_gnsssdr::vector<float> other_code(static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS));
+    gps_l1_ca_code_gen_float(code, 1, 0);
+    gps_l1_ca_code_gen_float(other_code, 7, 0);
+    volk_gnsssdr::vector<float> local_code_shift_chips{-0.5, 0.0, 0.5};
+
+    // the tables are shared by the correlators with the same local code
+    std::shared_ptr<const Code_Replica_Cache> table = Code_Replica_Cache::get(code.data(), static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS), code_phase_step_chips, -2, 2, phases_per_chip, correlation_length);
+    EXPECT_EQ(table, Code_Replica_Cache::get(code.data(), static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS), code_phase_step_chips, -2, 2, phases_per_chip, correlation_length - 1));
+    EXPECT_NE(table, Code_Replica_Cache::get(other_code.data(), static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS), code_phase_step_chips, -2, 2, phases_per_chip, correlation_length));
+    EXPECT_TRUE(table->fits(code_phase_step_chips, 0.0, correlation_length));
+    EXPECT_FALSE(table->fits(code_phase_step_chips, 1e-8, correlation_length));
+    EXPECT_EQ(table->replica(-2.1), nullptr);
+    EXPECT_NE(table->replica(2.0), nullptr);
+
+    // input signal: local code with a carrier
+    volk_gnsssdr::vector<gr_complex> in(correlation_length);
+    for (int n = 0; n < correlation_length; n++)
+        {
+            const int chip = static_cast<int>(std::floor(code_phase_step_chips * static_cast<float>(n) - rem_code_phase_chips + static_cast<float>(GPS_L1_CA_CODE_LENGTH_CHIPS))) % static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS);
+            in[n] = code[chip] * std::exp(gr_complex(0.0, 0.05F * static_cast<float>(n) + 0.4F));
+        }
+
+    const float code_phase_rate_steps_chips[2] = {0.0, 1e-8};
+    for (float code_phase_rate_step_chips : code_phase_rate_steps_chips)
+        {
+            volk_gnsssdr::vector<gr_complex> outs(n_correlator_taps);
+            volk_gnsssdr::vector<gr_complex> cached_outs(n_correlator_taps);
+            Cpu_Multicorrelator_Real_Codes correlator;
+            Cpu_Multicorrelator_Real_Codes cached_correlator;
+            for (auto* c : {&correlator, &cached_correlator})
+                {
+                    c->init(2 * correlation_length, n_correlator_taps);
+                    c->set_local_code_and_taps(static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS), code.data(), local_code_shift_chips.data());
+                }
+            correlator.set_input_output_vectors(outs.data(), in.data());
+            cached_correlator.set_input_output_vectors(cached_outs.data(), in.data());
+            cached_correlator.set_code_replica_cache(phases_per_chip);
+            for (int epoch = 0; epoch < 2; epoch++)
+                {
+                    correlator.Carrier_wipeoff_multicorrelator_resampler(0.4, 0.05, 0.0, rem_code_phase_chips, code_phase_step_chips, code_phase_rate_step_chips, correlation_length);
+                    cached_correlator.Carrier_wipeoff_multicorrelator_resampler(0.4, 0.05, 0.0, rem_code_phase_chips, code_phase_step_chips, code_phase_rate_step_chips, correlation_length);
+                    for (int k = 0; k < n_correlator_taps; k++)
+                        {
+                            if (code_phase_rate_step_chips == 0.0)
+                                {
+                                    // code phase error below 1 / phases_per_chip chips
+                                    EXPECT_NEAR(std::abs(cached_outs[k]), std::abs(outs[k]), static_cast<float>(correlation_length) / static_cast<float>(phases_per_chip));
+                                }
+                            else
+                                {
+                                    // the code phase rate does not fit the table: the local code is resampled
+                                    EXPECT_EQ(cached_outs[k], outs[k]);
+                                }
+                        }
+                }
+            EXPECT_GT(std::abs(cached_outs[1]), 0.9F * static_cast<float>(correlation_length));
+            correlator.free();
+            cached_correlator.free();
+        }
+}
+
+
+TEST(CpuMulticorrelatorRealCodesTest, KernelImplementations)
+{
+    const int n_correlator_taps = 3;
+    const int correlation_length = 4000;
+    volk_gnsssdr::vector<float> code(static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS));
+    gps_l1_ca_code_gen_float(code, 1, 0);
+    volk_gnsssdr::vector<float> local_code_shift_chips{-0.5, 0.0, 0.5};
+
+    // one extra sample, so that the samples from the second one are not aligned
+    volk_gnsssdr::vector<gr_complex> in(correlation_length + 1);
+    std::random_device r;
+    std::default_random_engine e1(r());
+    std::uniform_real_distribution<float> uniform_dist(-1.0, 1.0);
+    for (auto& sample : in)
+        {
+            sample = gr_complex(uniform_dist(e1), uniform_dist(e1));
+        }
+
+    const float phase_rate_steps_rad[2] = {0.0, 1e-9};
+    for (int high_dyn = 0; high_dyn < 2; high_dyn++)
+        {
+            for (int offset = 0; offset < 2; offset++)
+                {
+                    volk_gnsssdr::vector<gr_complex> outs(n_correlator_taps);
+                    volk_gnsssdr::vector<gr_complex> generic_outs(n_correlator_taps);
+                    Cpu_Multicorrelator_Real_Codes correlator;
+                    Cpu_Multicorrelator_Real_Codes generic_correlator;
+                    // an unknown implementation selects the fastest one
+                    correlator.set_kernel_implementations("not_an_implementation", "");
+                    generic_correlator.set_kernel_implementations("generic", "generic");
+                    for (auto* c : {&correlator, &generic_correlator})
+                        {
+                            c->set_high_dynamics_resampler(high_dyn == 1);
+                            c->init(correlation_length, n_correlator_taps);
+                            c->set_local_code_and_taps(static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS), code.data(), local_code_shift_chips.data());
+                        }
+                    correlator.set_input_output_vectors(outs.data(), in.data() + offset);
+                    generic_correlator.set_input_output_vectors(generic_outs.data(), in.data() + offset);
+                    correlator.Carrier_wipeoff_multicorrelator_resampler(0.4, 0.05, phase_rate_steps_rad[high_dyn], 0.3, 0.25575, 0.0, correlation_length);
+                    generic_correlator.Carrier_wipeoff_multicorrelator_resampler(0.4, 0.05, phase_rate_steps_rad[high_dyn], 0.3, 0.25575, 0.0, correlation_length);
+                    for (int k = 0; k < n_correlator_taps; k++)
+                        {
+                            EXPECT_NEAR(outs[k].real(), generic_outs[k].real(), 1e-2);
+                            EXPECT_NEAR(outs[k].imag(), generic_outs[k].imag(), 1e-2);
+                        }
+                    correlator.free();
+                    generic_correlator.free();
+                }
+        }
+}
+
+
+TEST(CpuMulticorrelatorRealCodesTest, SignalQualityMonitoringTaps)
+{
+    const int n_correlator_taps = 3;
+    const int correlation_length = 4000;
+    const float code_phase_step_chips = 0.25575;
+    volk_gnsssdr::vector<float> code(static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS));
+    gps_l1_ca_code_gen_float(code, 1, 0);
+    volk_gnsssdr::vector<float> local_code_shift_chips{-0.5, 0.0, 0.5};
+    const std::vector<int> sqm_shifts_samples{-6, -3, -1, 0, 1, 3, 6};
+    const auto n_sqm = static_cast<int>(sqm_shifts_samples.size());
+    volk_gnsssdr::vector<float> sqm_shifts_chips(n_sqm);
+    for (int k = 0; k < n_sqm; k++)
+        {
+            sqm_shifts_chips[k] = static_cast<float>(sqm_shifts_samples[k]) * code_phase_step_chips;
+        }
+    volk_gnsssdr::vector<gr_complex> in(correlation_length);
+    std::default_random_engine e1(1234);
+    std::uniform_real_distribution<float> uniform_dist(-1.0, 1.0);
+    for (auto& sample : in)
+        {
+            sample = gr_complex(uniform_dist(e1), uniform_dist(e1));
+        }
+
+    const float phase_rate_steps_rad[2] = {0.0, 1e-9};
+    for (int high_dyn = 0; high_dyn < 2; high_dyn++)
+        {
+            volk_gnsssdr::vector<gr_complex> outs(n_correlator_taps);
+            volk_gnsssdr::vector<gr_complex> sqm_outs(n_sqm);
+            Cpu_Multicorrelator_Real_Codes correlator;
+            correlator.set_high_dynamics_resampler(high_dyn == 1);
+            correlator.init(correlation_length, n_correlator_taps);
+            correlator.set_local_code_and_taps(static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS), code.data(), local_code_shift_chips.data());
+            correlator.set_input_output_vectors(outs.data(), in.data());
+            correlator.set_sqm_taps(n_sqm, sqm_shifts_samples.data(), sqm_outs.data());
+
+            // the same taps, each one with its own resampled local code
+            volk_gnsssdr::vector<gr_complex> reference_outs(n_correlator_taps);
+            volk_gnsssdr::vector<gr_complex> reference_sqm_outs(n_sqm);
+            Cpu_Multicorrelator_Real_Codes reference;
+            Cpu_Multicorrelator_Real_Codes reference_sqm;
+            reference.set_high_dynamics_resampler(high_dyn == 1);
+            reference.init(correlation_length, n_correlator_taps);
+            reference.set_local_code_and_taps(static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS), code.data(), local_code_shift_chips.data());
+            reference.set_input_output_vectors(reference_outs.data(), in.data());
+            reference_sqm.set_high_dynamics_resampler(high_dyn == 1);
+            reference_sqm.init(correlation_length, n_sqm);
+            reference_sqm.set_local_code_and_taps(static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS), code.data(), sqm_shifts_chips.data());
+            reference_sqm.set_input_output_vectors(reference_sqm_outs.data(), in.data());
+            for (auto* c : {&reference, &reference_sqm})
+                {
+                    c->Carrier_wipeoff_multicorrelator_resampler(0.4, 0.05, phase_rate_steps_rad[high_dyn], 0.3, code_phase_step_chips, 0.0, correlation_length);
+                }
+
+            // the SQM taps are computed only when requested
+            correlator.Carrier_wipeoff_multicorrelator_resampler(0.4, 0.05, phase_rate_steps_rad[high_dyn], 0.3, code_phase_step_chips, 0.0, correlation_length);
+            EXPECT_FALSE(correlator.take_sqm());
+            correlator.request_sqm();
+            correlator.Carrier_wipeoff_multicorrelator_resampler(0.4, 0.05, phase_rate_steps_rad[high_dyn], 0.3, code_phase_step_chips, 0.0, correlation_length);
+            EXPECT_TRUE(correlator.take_sqm());
+            EXPECT_FALSE(correlator.take_sqm());
+            for (int k = 0; k < n_correlator_taps; k++)
+                {
+                    EXPECT_NEAR(outs[k].real(), reference_outs[k].real(), 1e-3);
+                    EXPECT_NEAR(outs[k].imag(), reference_outs[k].imag(), 1e-3);
+                }
+            for (int k = 0; k < n_sqm; k++)
+                {
+                    EXPECT_NEAR(sqm_outs[k].real(), reference_sqm_outs[k].real(), 1e-2) << "tap " << k;
+                    EXPECT_NEAR(sqm_outs[k].imag(), reference_sqm_outs[k].imag(), 1e-2) << "tap " << k;
+                }
+            correlator.free();
+            reference.free();
+            reference_sqm.free();
+        }
+}
@@ -0,0 +1,103 @@
+/*!
+ * \file cuda_multicorrelator_bank_test.cc
+ * \brief  Tests the correlators of several channels computed by the CUDA
+ * correlator bank against the CPU correlators.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "GPS_L1_CA.h"
+#include "cpu_multicorrelator_real_codes.h"
+#include "cuda_multicorrelator_bank.h"
+#include "gps_sdr_signal_replica.h"
+#include <gnuradio/gr_complex.h>
+#include <gtest/gtest.h>
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <random>
+#include <thread>
+#include <vector>
+
+
+TEST(CudaMulticorrelatorBankTest, SameResultsAsCpuCorrelators)
+{
+    const int n_channels = 4;
+    const int n_correlator_taps = 3;
+    const int correlation_length = 4000;
+    const float code_phase_step_chips = 0.25575;
+    const auto code_length_chips = static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS);
+    volk_gnsssdr::vector<float> local_code_shift_chips{-0.5, 0.0, 0.5};
+
+    std::default_random_engine e1(1234);
+    std::normal_distribution<float> noise(0.0, 1.0);
+    volk_gnsssdr::vector<gr_complex> in(correlation_length);
+    for (auto &sample : in)
+        {
+            sample = gr_complex(noise(e1), noise(e1));
+        }
+
+    std::vector<volk_gnsssdr::vector<float>> codes(n_channels, volk_gnsssdr::vector<float>(code_length_chips));
+    std::vector<volk_gnsssdr::vector<gr_complex>> cpu_outs(n_channels, volk_gnsssdr::vector<gr_complex>(n_correlator_taps));
+    std::vector<volk_gnsssdr::vector<gr_complex>> gpu_outs(n_channels, volk_gnsssdr::vector<gr_complex>(n_correlator_taps));
+    std::array<Cuda_Multicorrelator_Real_Codes, n_channels> gpu_correlators;
+    for (int ch = 0; ch < n_channels; ch++)
+        {
+            // each channel correlates a different PRN, present in the input with a different Doppler
+            gps_l1_ca_code_gen_float(codes[ch], ch + 1, 0);
+            for (int n = 0; n < correlation_length; n++)
+                {
+                    const auto chip = static_cast<int>(std::floor(code_phase_step_chips * static_cast<float>(n))) % code_length_chips;
+                    in[n] += 0.5F * codes[ch][chip] * std::exp(gr_complex(0.0, 0.01F * static_cast<float>((ch + 1) * n)));
+                }
+        }
+    for (int ch = 0; ch < n_channels; ch++)
+        {
+            const float phase_step_rad = 0.01F * static_cast<float>(ch + 1);
+            Cpu_Multicorrelator_Real_Codes cpu_correlator;
+            cpu_correlator.init(correlation_length, n_correlator_taps);
+            cpu_correlator.set_high_dynamics_resampler(false);
+            cpu_correlator.set_local_code_and_taps(code_length_chips, codes[ch].data(), local_code_shift_chips.data());
+            cpu_correlator.set_input_output_vectors(cpu_outs[ch].data(), in.data());
+            cpu_correlator.Carrier_wipeoff_multicorrelator_resampler(0.0, phase_step_rad, 0.0, 0.0, code_phase_step_chips, 0.0, correlation_length);
+            cpu_correlator.free();
+
+            ASSERT_TRUE(gpu_correlators[ch].init(correlation_length, n_correlator_taps, 0, 100000));
+            ASSERT_TRUE(gpu_correlators[ch].set_local_code_and_taps(code_length_chips, codes[ch].data(), local_code_shift_chips.data()));
+            gpu_correlators[ch].set_input_output_vectors(gpu_outs[ch].data(), in.data());
+            gpu_correlators[ch].join_bank();
+        }
+
+    // the correlations of all the channels are computed together
+    std::vector<std::thread> channels;
+    for (int ch = 0; ch < n_channels; ch++)
+        {
+            channels.emplace_back([&, ch] {
+                EXPECT_TRUE(gpu_correlators[ch].Carrier_wipeoff_multicorrelator_resampler(0.0, 0.01F * static_cast<float>(ch + 1), 0.0, 0.0, code_phase_step_chips, 0.0, correlation_length));
+            });
+        }
+    for (auto &channel : channels)
+        {
+            channel.join();
+        }
+
+    for (int ch = 0; ch < n_channels; ch++)
+        {
+            const float tolerance = 1e-3F * std::abs(cpu_outs[ch][1]);
+            for (int k = 0; k < n_correlator_taps; k++)
+                {
+                    EXPECT_NEAR(gpu_outs[ch][k].real(), cpu_outs[ch][k].real(), tolerance);
+                    EXPECT_NEAR(gpu_outs[ch][k].imag(), cpu_outs[ch][k].imag(), tolerance);
+                }
+            gpu_correlators[ch].free();
+        }
+}
@@ -17,7 +17,9 @@
 
 #include "tracking_discriminators.h"
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <cmath>
+#include <complex>
 #include <vector>
 
 double BpskCorrelationFunction(double offset_in_chips)
@@ -172,3 +174,50 @@ TEST(DllNcEMinusLNormalizedTest, CosBoc11)
                 }
         }
 }
+
+
+TEST(SqmMetricsTest, Bpsk)
+{
+    const int n_pairs = 3;
+    const double spacing = 0.1;
+    const gr_complex A = std::polar(2.0F, 0.7F);
+    std::vector<gr_complex> taps(2 * n_pairs + 1);
+    double delta = 0.0;
+    double ratio = 0.0;
+    double asymmetry = 0.0;
+    for (auto err : {0.0, 0.05, -0.1})
+        {
+            for (int k = -n_pairs; k <= n_pairs; k++)
+                {
+                    taps[k + n_pairs] = A * static_cast<float>(BpskCorrelationFunction(err + k * spacing));
+                }
+            sqm_metrics(taps.data(), n_pairs, delta, ratio, asymmetry);
+            const double prompt = BpskCorrelationFunction(err);
+            const double early = BpskCorrelationFunction(err - n_pairs * spacing);
+            const double late = BpskCorrelationFunction(err + n_pairs * spacing);
+            EXPECT_NEAR(delta, (early - late) / prompt, 1e-6) << " err: " << err;
+            EXPECT_NEAR(ratio, (early + late) / (2.0 * prompt), 1e-6) << " err: " << err;
+            if (err == 0.0)
+                {
+                    EXPECT_NEAR(delta, 0.0, 1e-6);
+                    EXPECT_NEAR(ratio, 1.0 - n_pairs * spacing, 1e-6);
+                    EXPECT_NEAR(asymmetry, 0.0, 1e-6);
+                }
+        }
+
+    // a delayed in-phase replica raises the late side of the correlation function
+    for (int k = -n_pairs; k <= n_pairs; k++)
+        {
+            taps[k + n_pairs] = A * static_cast<float>(BpskCorrelationFunction(k * spacing) + 0.5 * BpskCorrelationFunction(k * spacing - 0.2));
+        }
+    sqm_metrics(taps.data(), n_pairs, delta, ratio, asymmetry);
+    EXPECT_LT(delta, 0.0);
+    EXPECT_GT(asymmetry, 0.0);
+
+    // no prompt correlation
+    std::fill(taps.begin(), taps.end(), gr_complex(0.0, 0.0));
+    sqm_metrics(taps.data(), n_pairs, delta, ratio, asymmetry);
+    EXPECT_EQ(delta, 0.0);
+    EXPECT_EQ(ratio, 0.0);
+    EXPECT_EQ(asymmetry, 0.0);
+}
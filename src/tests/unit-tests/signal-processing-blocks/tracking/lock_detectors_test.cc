@@ -0,0 +1,84 @@
+/*!
+ * \file lock_detectors_test.cc
+ * \brief  Tests the batch and incremental lock detectors against the
+ * single-channel ones.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "lock_detectors.h"
+#include <gnuradio/gr_complex.h>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+
+TEST(LockDetectorsTest, BatchSameResultsAsSingleChannel)
+{
+    const int n_channels = 13;
+    const int length = 20;
+    std::default_random_engine e1(1234);
+    std::normal_distribution<float> noise(0.0, 1.0);
+
+    // channel-interleaved prompts, with a different amplitude for each channel
+    std::vector<gr_complex> prompts(n_channels * length);
+    std::vector<std::vector<gr_complex>> channel_prompts(n_channels, std::vector<gr_complex>(length));
+    for (int i = 0; i < length; i++)
+        {
+            for (int ch = 0; ch < n_channels; ch++)
+                {
+                    const auto amplitude = static_cast<float>(ch + 1);
+                    const gr_complex prompt(amplitude + noise(e1), 0.1F * amplitude + noise(e1));
+                    prompts[i * n_channels + ch] = prompt;
+                    channel_prompts[ch][i] = prompt;
+                }
+        }
+
+    std::vector<float> cn0(n_channels);
+    std::vector<float> lock_test(n_channels);
+    cn0_m2m4_estimator_batch(prompts.data(), n_channels, length, 0.001, cn0.data());
+    carrier_lock_detector_batch(prompts.data(), n_channels, length, lock_test.data());
+    for (int ch = 0; ch < n_channels; ch++)
+        {
+            EXPECT_NEAR(cn0[ch], cn0_m2m4_estimator(channel_prompts[ch].data(), length, 0.001), 1e-3);
+            EXPECT_NEAR(lock_test[ch], carrier_lock_detector(channel_prompts[ch].data(), length), 1e-5);
+        }
+}
+
+
+TEST(LockDetectorsTest, IncrementalSameResultsAsWindow)
+{
+    const int length = 20;
+    const int n_prompts = 1000;
+    std::default_random_engine e1(1234);
+    std::normal_distribution<float> noise(0.0, 1.0);
+    std::vector<gr_complex> prompts(n_prompts);
+    for (int i = 0; i < n_prompts; i++)
+        {
+            // the signal power changes along the run
+            const auto amplitude = static_cast<float>(1 + i / 100);
+            prompts[i] = gr_complex(amplitude + noise(e1), noise(e1));
+        }
+
+    Cn0_M2M4_Estimator estimator(length);
+    for (int i = 0; i < n_prompts; i++)
+        {
+            estimator.update(prompts[i]);
+            ASSERT_EQ(estimator.ready(), i >= length - 1);
+            if (estimator.ready())
+                {
+                    EXPECT_NEAR(estimator.cn0(0.001), cn0_m2m4_estimator(&prompts[i - length + 1], length, 0.001), 1e-3);
+                }
+        }
+
+    estimator.reset();
+    EXPECT_FALSE(estimator.ready());
+}
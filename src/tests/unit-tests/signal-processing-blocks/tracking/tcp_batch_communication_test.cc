@@ -0,0 +1,142 @@
+/*!
+ * \file tcp_batch_communication_test.cc
+ * \brief  This file implements unit tests for the pipelined exchange of the
+ * TCP connector tracking channels with an external loop filter
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_shm_ring.h"
+#include "tcp_batch_communication.h"
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+// Replies to each record with the channel as code error and the control
+// identifier as carrier Doppler
+void tcp_batch_test_loop_filter(const std::string& name, const std::atomic<bool>& stop, std::atomic<int>& batches, std::atomic<uint32_t>& max_records)
+{
+    Gnss_Shm_Ring_Writer writer(name + "_commands", SHM_RECORD_TRK_BATCH, sizeof(Tcp_Batch_Header) + TCP_BATCH_MAX_RECORDS * sizeof(Tcp_Batch_Command), 64);
+    std::unique_ptr<Gnss_Shm_Ring_Reader> reader;
+    while (!reader and !stop)
+        {
+            auto candidate = std::make_unique<Gnss_Shm_Ring_Reader>(name + "_correlators", true);
+            if (candidate->is_open())
+                {
+                    reader = std::move(candidate);
+                }
+            std::this_thread::yield();
+        }
+    if (!reader)
+        {
+            return;
+        }
+    std::vector<uint8_t> in(reader->record_size());
+    std::vector<uint8_t> out(sizeof(Tcp_Batch_Header) + TCP_BATCH_MAX_RECORDS * sizeof(Tcp_Batch_Command));
+    while (!stop)
+        {
+            if (!reader->read(in.data()))
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+            Tcp_Batch_Header header{};
+            std::memcpy(&header, in.data(), sizeof(Tcp_Batch_Header));
+            std::memcpy(out.data(), &header, sizeof(Tcp_Batch_Header));
+            for (uint32_t i = 0; i < header.records; i++)
+                {
+                    Tcp_Batch_Correlators record{};
+                    std::memcpy(&record, in.data() + sizeof(Tcp_Batch_Header) + i * sizeof(Tcp_Batch_Correlators), sizeof(Tcp_Batch_Correlators));
+                    Tcp_Batch_Command command{};
+                    command.channel = record.channel;
+                    command.control_id = record.control_id;
+                    command.rx[0] = record.tx[0];
+                    command.rx[1] = static_cast<float>(record.channel);
+                    command.rx[3] = static_cast<float>(record.control_id);
+                    std::memcpy(out.data() + sizeof(Tcp_Batch_Header) + i * sizeof(Tcp_Batch_Command), &command, sizeof(Tcp_Batch_Command));
+                }
+            batches++;
+            max_records = std::max(max_records.load(), header.records);
+            writer.publish(out.data());
+        }
+}
+}  // namespace
+
+
+TEST(TcpBatchCommunicationTest, PipelinedSharedMemory)
+{
+    const std::string name = "gnss-sdr-tcp-batch-test-" + std::to_string(getpid());
+    const int channels = 8;
+    const int periods = 2000;
+    std::atomic<bool> stop{false};
+    std::atomic<int> batches{0};
+    std::atomic<uint32_t> max_records{0};
+    std::thread loop_filter(tcp_batch_test_loop_filter, name, std::cref(stop), std::ref(batches), std::ref(max_records));
+
+    std::vector<int> wrong(channels, 0);
+    std::vector<float> first_doppler(channels, 0.0);
+    {
+        auto com = Tcp_Batch_Communication::get_shared(0, name);
+        ASSERT_TRUE(com->is_connected());
+        EXPECT_EQ(com, Tcp_Batch_Communication::get_shared(0, name));
+        for (int ch = 0; ch < channels; ch++)
+            {
+                com->add_channel(ch, 1);
+            }
+        std::vector<std::thread> tracking;
+        for (int ch = 0; ch < channels; ch++)
+            {
+                tracking.emplace_back([&, ch]() {
+                    Tcp_Packet_Data command;
+                    command.proc_pack_carrier_doppler_hz = -1.0;
+                    for (int k = 1; k <= periods; k++)
+                        {
+                            const float tx[NUM_TX_VARIABLES_GPS_L1_CA] = {static_cast<float>(k), 0, 0, 0, 0, 0, 0, 0, 1};
+                            com->exchange(ch, TCP_BATCH_SIGNAL_GPS_L1_CA, tx, NUM_TX_VARIABLES_GPS_L1_CA, true, &command);
+                            if (k == 1)
+                                {
+                                    // no command is due yet
+                                    first_doppler[ch] = command.proc_pack_carrier_doppler_hz;
+                                }
+                            else if (command.proc_pack_carrier_doppler_hz < static_cast<float>(k - 1) or command.proc_pack_code_error != static_cast<float>(ch))
+                                {
+                                    wrong[ch]++;
+                                }
+                        }
+                });
+            }
+        for (auto& t : tracking)
+            {
+                t.join();
+            }
+    }
+    stop = true;
+    loop_filter.join();
+
+    for (int ch = 0; ch < channels; ch++)
+        {
+            EXPECT_EQ(wrong[ch], 0) << "channel " << ch;
+            EXPECT_FLOAT_EQ(first_doppler[ch], -1.0);
+        }
+    // the records of the channels travel together
+    EXPECT_LT(batches.load(), channels * periods);
+    EXPECT_GT(max_records.load(), 1U);
+}
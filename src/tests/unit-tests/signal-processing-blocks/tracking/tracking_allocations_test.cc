@@ -0,0 +1,252 @@
+/*!
+ * \file tracking_allocations_test.cc
+ * \brief  Checks that the dll_pll_veml_tracking block does not allocate heap
+ * memory once the tracking of a signal has reached its steady state.
+ *
+ * The global operator new is replaced by one that counts the allocations made
+ * by the thread that GNU Radio runs the tracking block in, so this test is
+ * built as its own executable. A synthetic GPS L1 C/A signal is tracked after
+ * start_tracking(), and the allocations are counted while the block produces
+ * its outputs. Memory obtained with volk_gnsssdr_malloc() is not counted, but
+ * it is only requested at initialization.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_synchro.h"
+#include "gps_l1_ca_dll_pll_tracking.h"
+#include "gps_sdr_signal_replica.h"
+#include "in_memory_configuration.h"
+#include <gnuradio/blocks/file_source.h>
+#include <gnuradio/blocks/null_sink.h>
+#include <gnuradio/gr_complex.h>
+#include <gnuradio/top_block.h>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#if defined(__linux__)
+#include <dirent.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+
+namespace
+{
+std::atomic<bool> count_allocations{false};
+std::atomic<uint64_t> n_allocations{0};
+std::atomic<int64_t> counted_thread{0};  // kernel id of the thread whose allocations are counted
+
+#if defined(__linux__)
+int64_t this_thread_id()
+{
+    // cached, so that a counted allocation does not cost a system call
+    static thread_local const int64_t tid = syscall(SYS_gettid);
+    return tid;
+}
+
+
+// GNU Radio names the thread of each block after the block, and the kernel
+// keeps the first 15 characters of the name
+int64_t find_thread(const std::string& block_name)
+{
+    const std::string thread_name = block_name.substr(0, 15);
+    int64_t tid = 0;
+    DIR* tasks = opendir("/proc/self/task");
+    if (tasks == nullptr)
+        {
+            return 0;
+        }
+    struct dirent* entry;
+    while (tid == 0 and (entry = readdir(tasks)) != nullptr)
+        {
+            if (entry->d_name[0] == '.')
+                {
+                    continue;
+                }
+            std::ifstream comm(std::string("/proc/self/task/") + entry->d_name + "/comm");
+            std::string name;
+            std::getline(comm, name);
+            if (name == thread_name)
+                {
+                    tid = std::stoll(entry->d_name);
+                }
+        }
+    closedir(tasks);
+    return tid;
+}
+#endif
+
+
+class Allocation_Counter
+{
+public:
+    explicit Allocation_Counter(int64_t tid)
+    {
+        n_allocations = 0;
+        counted_thread = tid;
+        count_allocations = true;
+    }
+    ~Allocation_Counter() { stop(); }
+    void stop() { count_allocations = false; }
+    uint64_t allocations() const { return n_allocations; }
+};
+}  // namespace
+
+
+void* operator new(std::size_t size)
+{
+#if defined(__linux__)
+    if (count_allocations.load(std::memory_order_relaxed) and this_thread_id() == counted_thread.load(std::memory_order_relaxed))
+        {
+            n_allocations++;
+        }
+#endif
+    void* p = std::malloc(size == 0 ? 1 : size);
+    if (p == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+    return p;
+}
+
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+
+void operator delete(void* p, std::size_t /*size*/) noexcept
+{
+    std::free(p);
+}
+
+
+TEST(TrackingAllocationsTest, NoAllocationsInSteadyState)
+{
+#if !defined(__linux__)
+    std::cout << "The tracking thread can only be identified on Linux. Test skipped.\n";
+#else
+    const int32_t fs_in = 4000000;
+    const int samples_per_code = 4000;
+    const int codes_per_bit = 20;
+    // the outputs start after the bit synchronization, the first ones are
+    // left to the lock detectors and the smoothers to fill their windows
+    const uint64_t warmup_outputs = 500;
+    const uint64_t counted_outputs = 2000;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(20);
+
+    // GPS L1 C/A PRN 1 with no Doppler, its code starting at the first sample
+    // and 57 dB-Hz. The data bits repeat the preamble, which is what the
+    // tracking searches for the bit synchronization.
+    const std::string file_name = "./tmp-trk-allocations.dat";
+    {
+        const std::vector<float> bits{1.0, -1.0, -1.0, -1.0, 1.0, -1.0, 1.0, 1.0, -1.0, -1.0};
+        std::vector<std::complex<float>> code(samples_per_code);
+        gps_l1_ca_code_gen_complex_sampled(code, 1, fs_in, 0);
+        std::default_random_engine e1(1234);
+        std::normal_distribution<float> noise(0.0, 1.0);
+        std::vector<gr_complex> period(samples_per_code);
+        std::ofstream file(file_name, std::ios::binary);
+        for (const auto bit : bits)
+            {
+                for (int c = 0; c < codes_per_bit; c++)
+                    {
+                        for (int n = 0; n < samples_per_code; n++)
+                            {
+                                period[n] = 0.5F * bit * code[n] + gr_complex(noise(e1), noise(e1));
+                            }
+                        file.write(reinterpret_cast<const char*>(period.data()), sizeof(gr_complex) * samples_per_code);
+                    }
+            }
+    }
+
+    auto config = std::make_shared<InMemoryConfiguration>();
+    config->set_property("GNSS-SDR.internal_fs_sps", std::to_string(fs_in));
+    config->set_property("Tracking_1C.implementation", "GPS_L1_CA_DLL_PLL_Tracking");
+    config->set_property("Tracking_1C.item_type", "gr_complex");
+    config->set_property("Tracking_1C.dump", "false");
+    config->set_property("Tracking_1C.pll_bw_hz", "20.0");
+    config->set_property("Tracking_1C.dll_bw_hz", "2.0");
+    config->set_property("Tracking_1C.early_late_space_chips", "0.5");
+    config->set_property("Tracking_1C.pull_in_time_s", "0");
+
+    Gnss_Synchro gnss_synchro{};
+    gnss_synchro.Channel_ID = 0;
+    gnss_synchro.System = 'G';
+    const std::string signal = "1C";
+    signal.copy(gnss_synchro.Signal, 2, 0);
+    gnss_synchro.PRN = 1;
+    gnss_synchro.Acq_delay_samples = 0.0;
+    gnss_synchro.Acq_doppler_hz = 0.0;
+    gnss_synchro.Acq_samplestamp_samples = 0;
+
+    auto top_block = gr::make_top_block("Tracking allocations test");
+    auto tracking = std::make_shared<GpsL1CaDllPllTracking>(config.get(), "Tracking_1C", 1, 1);
+    auto source = gr::blocks::file_source::make(sizeof(gr_complex), file_name.c_str(), true);
+    auto sink = gr::blocks::null_sink::make(sizeof(Gnss_Synchro));
+    tracking->set_channel(gnss_synchro.Channel_ID);
+    tracking->set_gnss_synchro(&gnss_synchro);
+    tracking->connect(top_block);
+    top_block->connect(source, 0, tracking->get_left_block(), 0);
+    top_block->connect(tracking->get_right_block(), 0, sink, 0);
+
+    tracking->start_tracking();
+    top_block->start();
+
+    auto wait_for_outputs = [&](uint64_t outputs) {
+        while (sink->nitems_read(0) < outputs and std::chrono::steady_clock::now() < deadline)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+        return sink->nitems_read(0) >= outputs;
+    };
+
+    const int64_t tracking_thread = find_thread(tracking->get_right_block()->name());
+    const bool warmed_up = wait_for_outputs(warmup_outputs);
+    uint64_t allocations = 0;
+    bool counted = false;
+    if (tracking_thread != 0 and warmed_up)
+        {
+            Allocation_Counter counter(tracking_thread);
+            counted = wait_for_outputs(warmup_outputs + counted_outputs);
+            counter.stop();
+            allocations = counter.allocations();
+        }
+
+    top_block->stop();
+    top_block->wait();
+    tracking->stop_tracking();
+    std::remove(file_name.c_str());
+
+    if (tracking_thread == 0)
+        {
+            std::cout << "The thread of the tracking block was not found. Test skipped.\n";
+            return;
+        }
+    // the outputs stop when the lock is lost
+    ASSERT_TRUE(warmed_up) << "The tracking did not reach the bit synchronization.";
+    ASSERT_TRUE(counted) << "The tracking lost the lock.";
+    EXPECT_EQ(allocations, 0U);
+#endif
+}
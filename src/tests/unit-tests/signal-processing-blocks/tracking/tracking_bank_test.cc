@@ -0,0 +1,130 @@
+/*!
+ * \file tracking_bank_test.cc
+ * \brief  Tests the correlator bank shared by several tracking channels
+ * against the correlators of each channel.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "GPS_L1_CA.h"
+#include "cpu_multicorrelator_real_codes.h"
+#include "gps_sdr_signal_replica.h"
+#include "tracking_bank.h"
+#include <gnuradio/gr_complex.h>
+#include <gtest/gtest.h>
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>
+#include <complex>
+#include <random>
+#include <thread>
+#include <vector>
+
+
+void run_tracking_bank_test(bool high_dyn)
+{
+    const int n_channels = 6;
+    const int n_correlator_taps = 3;
+    const int correlation_length = 4000;
+    const int max_offset = 3000;
+    const auto code_length_chips = static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS);
+
+    volk_gnsssdr::vector<float> ca_code(code_length_chips);
+    gps_l1_ca_code_gen_float(ca_code, 1, 0);
+    volk_gnsssdr::vector<float> local_code_shift_chips{-0.5, 0.0, 0.5};
+
+    std::default_random_engine e1(1234);
+    std::uniform_real_distribution<float> uniform_dist(-1.0, 1.0);
+    volk_gnsssdr::vector<gr_complex> in(correlation_length + max_offset);
+    for (auto &sample : in)
+        {
+            sample = gr_complex(uniform_dist(e1), uniform_dist(e1));
+        }
+
+    std::vector<Cpu_Multicorrelator_Real_Codes> channel_correlators(n_channels);
+    std::vector<Cpu_Multicorrelator_Real_Codes> bank_correlators(n_channels);
+    std::vector<volk_gnsssdr::vector<gr_complex>> channel_outs(n_channels, volk_gnsssdr::vector<gr_complex>(n_correlator_taps));
+    std::vector<volk_gnsssdr::vector<gr_complex>> bank_outs(n_channels, volk_gnsssdr::vector<gr_complex>(n_correlator_taps));
+    std::vector<Tracking_Bank::Correlation> correlations(n_channels);
+
+    for (int n = 0; n < n_channels; n++)
+        {
+            // channels start at different samples of the input, with different Doppler and code phases
+            const gr_complex *sig_in = in.data() + (n * max_offset) / n_channels;
+            correlations[n] = {&bank_correlators[n], sig_in,
+                0.1F * static_cast<float>(n),
+                0.01F + 0.002F * static_cast<float>(n),
+                high_dyn ? 1e-9F : 0.0F,
+                0.3F * static_cast<float>(n),
+                0.25575F,
+                high_dyn ? 1e-10F : 0.0F,
+                correlation_length - 7 * n};
+            for (auto *correlator : {&channel_correlators[n], &bank_correlators[n]})
+                {
+                    correlator->init(correlation_length, n_correlator_taps);
+                    correlator->set_high_dynamics_resampler(high_dyn);
+                    correlator->set_local_code_and_taps(code_length_chips, ca_code.data(), local_code_shift_chips.data());
+                }
+            channel_correlators[n].set_input_output_vectors(channel_outs[n].data(), sig_in);
+            bank_correlators[n].set_input_output_vectors(bank_outs[n].data(), sig_in);
+
+            const Tracking_Bank::Correlation &c = correlations[n];
+            channel_correlators[n].Carrier_wipeoff_multicorrelator_resampler(c.rem_carrier_phase_in_rad,
+                c.phase_step_rad,
+                c.phase_rate_step_rad,
+                c.rem_code_phase_chips,
+                c.code_phase_step_chips,
+                c.code_phase_rate_step_chips,
+                c.signal_length_samples);
+        }
+
+    // all the channels submit their correlations concurrently
+    Tracking_Bank bank(1000000);
+    for (int n = 0; n < n_channels; n++)
+        {
+            bank.join();
+        }
+    std::vector<std::thread> channel_threads;
+    for (int n = 0; n < n_channels; n++)
+        {
+            channel_threads.emplace_back([&bank, &correlations, n]() { bank.correlate(&correlations[n], 1); });
+        }
+    for (auto &t : channel_threads)
+        {
+            t.join();
+        }
+    for (int n = 0; n < n_channels; n++)
+        {
+            bank.leave();
+        }
+
+    for (int n = 0; n < n_channels; n++)
+        {
+            for (int k = 0; k < n_correlator_taps; k++)
+                {
+                    const float tolerance = 1e-3F * std::abs(channel_outs[n][k]) + 1e-2F;
+                    EXPECT_NEAR(bank_outs[n][k].real(), channel_outs[n][k].real(), tolerance) << "channel " << n << ", tap " << k;
+                    EXPECT_NEAR(bank_outs[n][k].imag(), channel_outs[n][k].imag(), tolerance) << "channel " << n << ", tap " << k;
+                }
+            channel_correlators[n].free();
+            bank_correlators[n].free();
+        }
+}
+
+
+TEST(TrackingBankTest, SameResultsAsChannelCorrelators)
+{
+    run_tracking_bank_test(false);
+}
+
+
+TEST(TrackingBankTest, SameResultsAsChannelCorrelatorsHighDynamics)
+{
+    run_tracking_bank_test(true);
+}
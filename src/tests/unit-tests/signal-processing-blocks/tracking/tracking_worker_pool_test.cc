@@ -0,0 +1,85 @@
+/*!
+ * \file tracking_worker_pool_test.cc
+ * \brief  This file implements unit tests for the Tracking_Worker_Pool class
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "tracking_worker_pool.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+TEST(TrackingWorkerPoolTest, BoundsRunningChannels)
+{
+    Tracking_Worker_Pool pool(2);
+    EXPECT_EQ(pool.size(), 2U);
+    std::atomic<int> running{0};
+    std::atomic<int> max_running{0};
+    std::vector<std::thread> channels;
+    for (int i = 0; i < 8; i++)
+        {
+            channels.emplace_back([&]() {
+                for (int n = 0; n < 20; n++)
+                    {
+                        const Tracking_Worker_Pool::Slot slot(&pool);
+                        const int now = ++running;
+                        int max = max_running.load();
+                        while (now > max and !max_running.compare_exchange_weak(max, now))
+                            {
+                            }
+                        std::this_thread::sleep_for(std::chrono::microseconds(200));
+                        running--;
+                    }
+            });
+        }
+    for (auto& channel : channels)
+        {
+            channel.join();
+        }
+    EXPECT_LE(max_running.load(), 2);
+    EXPECT_GE(max_running.load(), 1);
+    EXPECT_EQ(pool.waiting(), 0U);
+    EXPECT_GT(pool.waits(), 0U);
+}
+
+
+TEST(TrackingWorkerPoolTest, SlotsAreHandedOverInOrder)
+{
+    Tracking_Worker_Pool pool(1);
+    std::mutex mtx;
+    std::vector<int> order;
+    pool.acquire();  // the only slot is busy while the channels queue
+    std::vector<std::thread> channels;
+    for (int i = 0; i < 4; i++)
+        {
+            channels.emplace_back([&, i]() {
+                const Tracking_Worker_Pool::Slot slot(&pool);
+                std::lock_guard<std::mutex> lock(mtx);
+                order.push_back(i);
+            });
+            while (pool.waiting() < static_cast<size_t>(i + 1))
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+        }
+    pool.release();
+    for (auto& channel : channels)
+        {
+            channel.join();
+        }
+    EXPECT_EQ(order, std::vector<int>({0, 1, 2, 3}));
+}
+
@@ -18,6 +18,9 @@
 #include "gnss_sdr_make_unique.h"
 #include "reed_solomon.h"
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
 
 
 TEST(ReedSolomonE6BTest, EncodeWithGenMatrix)
@@ -760,3 +763,67 @@ TEST(ReedSolomonE6BTest, DecodeErasure)
     std::vector<uint8_t> decoded(encoded_input.begin(), encoded_input.begin() + 32);
     EXPECT_TRUE(expected_output == decoded);
 }
+
+
+TEST(ReedSolomonE6BTest, DecodeColumns)
+{
+    // HAS message of 53 columns, with the same 200 erasures in all of them
+    // and 11 errors in some of them
+    const int columns = 53;
+    std::mt19937 gen(1);
+    std::uniform_int_distribution<int> dist(0, 255);
+    auto rs = std::make_unique<ReedSolomon>();
+
+    std::vector<std::vector<uint8_t>> info(columns, std::vector<uint8_t>(32));
+    std::vector<std::vector<uint8_t>> matrix(255, std::vector<uint8_t>(columns));
+    std::vector<int> positions(255);
+    for (int i = 0; i < 255; i++)
+        {
+            positions[i] = i;
+        }
+    std::shuffle(positions.begin(), positions.end(), gen);
+    std::vector<int> erasure_positions(positions.begin(), positions.begin() + 200);
+
+    std::vector<std::vector<uint8_t>> received(columns);
+    for (int col = 0; col < columns; col++)
+        {
+            for (auto& symbol : info[col])
+                {
+                    symbol = dist(gen);
+                }
+            received[col] = rs->encode_with_generator_matrix(info[col]);
+            for (auto pos : erasure_positions)
+                {
+                    received[col][pos] = 0;
+                }
+            if (col % 4 == 0)
+                {
+                    for (int i = 200; i < 211; i++)
+                        {
+                            received[col][positions[i]] ^= 0x5A;
+                        }
+                }
+            for (int row = 0; row < 255; row++)
+                {
+                    matrix[row][col] = received[col][row];
+                }
+        }
+
+    int expected_result = 0;
+    for (auto& column : received)
+        {
+            expected_result += rs->decode(column, erasure_positions);
+        }
+    EXPECT_EQ(rs->decode_columns(matrix, erasure_positions), expected_result);
+    for (int col = 0; col < columns; col++)
+        {
+            for (int row = 0; row < 255; row++)
+                {
+                    EXPECT_EQ(matrix[row][col], received[col][row]);
+                }
+            for (int row = 0; row < 32; row++)
+                {
+                    EXPECT_EQ(matrix[row][col], info[col][row]);
+                }
+        }
+}
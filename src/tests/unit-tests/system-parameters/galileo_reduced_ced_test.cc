@@ -0,0 +1,107 @@
+/*!
+ * \file galileo_reduced_ced_test.cc
+ * \brief Tests of the ephemeris computed from a Galileo reduced CED
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "Galileo_INAV.h"
+#include "MATH_CONSTANTS.h"
+#include "galileo_ephemeris.h"
+#include "galileo_reduced_ced.h"
+#include "gnss_nav_data_store.h"
+#include "gnss_receiver_snapshot.h"
+#include "rtklib_conversions.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <string>
+
+
+TEST(GalileoReducedCedTest, ComputesAFlaggedEphemeris)
+{
+    Galileo_Reduced_CED ced{};
+    ced.PRN = 11;
+    ced.TOTRedCED = 2200 * 604800 + 345678;
+    ced.IODnav = 42;
+    ced.DeltaAred = 512.0;
+    ced.exred = 3.0e-4;
+    ced.eyred = -4.0e-4;
+    const Galileo_Ephemeris eph = ced.compute_eph();
+
+    EXPECT_TRUE(eph.flag_reduced_ced);
+    EXPECT_EQ(eph.PRN, 11U);
+    EXPECT_EQ(eph.IOD_nav, 42);
+    EXPECT_EQ(eph.WN, 2200);
+    EXPECT_EQ(eph.tow, 345678);
+    EXPECT_NEAR(eph.sqrtA * eph.sqrtA, 29600000.0 + 512.0, 1e-6);
+    EXPECT_NEAR(eph.ecc, 5.0e-4, 1e-12);
+    EXPECT_NEAR(eph.i_0, 56.0 * GNSS_PI / 180.0, 1e-12);  // radians, as the full ephemeris
+    EXPECT_NEAR(eph.omega, std::atan2(-4.0e-4, 3.0e-4), 1e-12);
+}
+
+
+TEST(GalileoReducedCedTest, DeweightedUntilTheFullEphemeris)
+{
+    Galileo_Reduced_CED ced{};
+    ced.PRN = 3;
+    ced.TOTRedCED = 2200 * 604800 + 1000;
+    const eph_t reduced = eph_to_rtklib(ced.compute_eph());
+    EXPECT_EQ(reduced.sva, CED_URA_INDEX);
+
+    Galileo_Ephemeris full = ced.compute_eph();
+    full.flag_reduced_ced = false;
+    EXPECT_EQ(eph_to_rtklib(full).sva, 0);
+}
+
+
+TEST(GalileoReducedCedTest, FlagSurvivesStoreAndReload)
+{
+    Galileo_Reduced_CED ced{};
+    ced.PRN = 5;
+    ced.TOTRedCED = 2200 * 604800 + 2000;
+    std::map<int32_t, Galileo_Ephemeris> eph_map;
+    eph_map[5] = ced.compute_eph();
+    eph_map[7] = ced.compute_eph();
+    eph_map[7].PRN = 7;
+    eph_map[7].flag_reduced_ced = false;
+
+    // the navigation data files of a warm start
+    for (const bool binary : {true, false})
+        {
+            const std::string filename = binary ? "galileo_reduced_ced_test.bin" : "galileo_reduced_ced_test.xml";
+            ASSERT_TRUE(Gnss_Nav_Data_Store::save_file(filename, "GNSS-SDR_gal_ephemeris_map", eph_map, binary));
+            std::map<int32_t, Galileo_Ephemeris> restored;
+            ASSERT_TRUE(Gnss_Nav_Data_Store::load_file(filename, "GNSS-SDR_gal_ephemeris_map", restored));
+            std::remove(filename.c_str());
+            ASSERT_EQ(restored.size(), 2U);
+            EXPECT_TRUE(restored.at(5).flag_reduced_ced);
+            EXPECT_FALSE(restored.at(7).flag_reduced_ced);
+            // still de-weighted, and still replaced by the full set
+            EXPECT_EQ(eph_to_rtklib(restored.at(5)).sva, CED_URA_INDEX);
+        }
+
+    // the receiver snapshot
+    const std::string filename = "galileo_reduced_ced_test_snapshot.bin";
+    Gnss_Receiver_Snapshot snapshot;
+    for (const auto& eph : eph_map)
+        {
+            snapshot.galileo_ephemeris_map[eph.first] = eph.second;
+        }
+    ASSERT_TRUE(snapshot.save(filename));
+    Gnss_Receiver_Snapshot restored;
+    ASSERT_TRUE(restored.load(filename));
+    std::remove(filename.c_str());
+    ASSERT_EQ(restored.galileo_ephemeris_map.size(), 2U);
+    EXPECT_TRUE(restored.galileo_ephemeris_map.at(5).flag_reduced_ced);
+    EXPECT_FALSE(restored.galileo_ephemeris_map.at(7).flag_reduced_ced);
+}
@@ -0,0 +1,117 @@
+/*!
+ * \file gnss_bit_stream_test.cc
+ * \brief Tests of the bit-packed navigation message stream
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_bit_stream.h"
+#include <boost/crc.hpp>
+#include <gtest/gtest.h>
+#include <bitset>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+std::string random_bit_string(std::size_t n, std::mt19937& gen)
+{
+    std::uniform_int_distribution<int32_t> dist(0, 1);
+    std::string bits;
+    for (std::size_t i = 0; i < n; i++)
+        {
+            bits.push_back(dist(gen) ? '1' : '0');
+        }
+    return bits;
+}
+}  // namespace
+
+
+TEST(GnssBitStreamTest, FieldExtraction)
+{
+    std::mt19937 gen(1);
+    const std::string bits = random_bit_string(234, gen);
+    const Gnss_Bit_Stream<234> stream(bits);
+    ASSERT_EQ(stream.size(), bits.size());
+    EXPECT_EQ(stream.to_string(), bits);
+
+    // reference: fields read from a std::bitset, as the ICD parsers do
+    const std::bitset<234> reference(bits);
+    for (int32_t first = 1; first <= 200; first += 7)
+        {
+            for (int32_t length = 1; length <= 34 && first + length - 1 <= 234; length += 3)
+                {
+                    uint64_t value = 0;
+                    for (int32_t j = 0; j < length; j++)
+                        {
+                            value = (value << 1U) | (reference[234 - first - j] ? 1U : 0U);
+                        }
+                    const Gnss_Bit_Field field(first, length);
+                    EXPECT_EQ(stream.read_unsigned(field), value) << "field (" << first << ", " << length << ")";
+                    EXPECT_EQ(stream.read_bool(field), reference[234 - first]);
+                    int64_t signed_value = static_cast<int64_t>(value);
+                    if (reference[234 - first])
+                        {
+                            signed_value -= (static_cast<int64_t>(1) << length);
+                        }
+                    EXPECT_EQ(stream.read_signed(field), signed_value) << "field (" << first << ", " << length << ")";
+                }
+        }
+}
+
+
+TEST(GnssBitStreamTest, Append)
+{
+    std::mt19937 gen(2);
+    const std::string bits = random_bit_string(234, gen);
+    const Gnss_Bit_Stream<234> stream(bits);
+
+    Gnss_Bit_Stream<128> joined;
+    joined.append(stream, 2, 112);
+    joined.append(stream, 116, 16);
+    EXPECT_EQ(joined.to_string(), bits.substr(2, 112) + bits.substr(116, 16));
+
+    Gnss_Bit_Stream<16> value;
+    value.append(0xA5U, 8);
+    value.append(3U, 2);
+    EXPECT_EQ(value.to_string(), "1010010111");
+    value.clear();
+    EXPECT_EQ(value.size(), 0U);
+}
+
+
+TEST(GnssBitStreamTest, Crc24q)
+{
+    std::mt19937 gen(3);
+    for (int32_t k = 0; k < 100; k++)
+        {
+            const std::string bits = random_bit_string(196, gen);
+            const Gnss_Bit_Stream<196> stream(bits);
+
+            // reference: the bits packed in bytes with leading zero padding
+            std::vector<uint8_t> bytes((bits.size() + 7) / 8, 0);
+            const std::size_t padding = bytes.size() * 8 - bits.size();
+            for (std::size_t i = 0; i < bits.size(); i++)
+                {
+                    if (bits[i] == '1')
+                        {
+                            const std::size_t pos = i + padding;
+                            bytes[pos / 8] |= static_cast<uint8_t>(0x80U >> (pos % 8));
+                        }
+                }
+            boost::crc_optimal<24, 0x1864CFBU, 0x0, 0x0, false, false> crc24q;
+            crc24q.process_bytes(bytes.data(), bytes.size());
+            EXPECT_EQ(stream.crc24q(bits.size()), crc24q.checksum());
+        }
+}
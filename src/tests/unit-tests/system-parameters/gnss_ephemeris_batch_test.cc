@@ -0,0 +1,136 @@
+/*!
+ * \file gnss_ephemeris_batch_test.cc
+ * \brief Implements Unit Tests for the batched evaluation of ephemerides
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "beidou_dnav_ephemeris.h"
+#include "galileo_ephemeris.h"
+#include "gnss_ephemeris_batch.h"
+#include "gps_ephemeris.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+
+namespace
+{
+template <typename T>
+T ephemeris_batch_test_eph(uint32_t prn, double sqrtA, double k)
+{
+    T eph;
+    eph.PRN = prn;
+    eph.sqrtA = sqrtA;
+    eph.M_0 = 0.7 * k - 2.0;
+    eph.delta_n = 4.5e-9;
+    eph.ecc = 0.002 + 0.003 * k;
+    eph.OMEGA_0 = 1.1 * k - 3.0;
+    eph.i_0 = 0.96 + 0.001 * k;
+    eph.omega = 0.5 * k - 1.5;
+    eph.OMEGAdot = -8.1e-9;
+    eph.idot = 1.2e-10;
+    eph.Cuc = 1.1e-6;
+    eph.Cus = 8.2e-6;
+    eph.Crc = 220.0;
+    eph.Crs = 21.0;
+    eph.Cic = -5.6e-8;
+    eph.Cis = 1.3e-7;
+    eph.toe = 345600;
+    eph.toc = 345600;
+    eph.af0 = 1.5e-4 * k;
+    eph.af1 = -3.4e-12;
+    eph.af2 = 0.0;
+    return eph;
+}
+}  // namespace
+
+
+class GnssEphemerisBatchTest : public ::testing::Test
+{
+protected:
+    GnssEphemerisBatchTest()
+    {
+        for (uint32_t prn = 1; prn < 9; prn++)
+            {
+                gps.push_back(ephemeris_batch_test_eph<Gps_Ephemeris>(prn, 5153.6, prn));
+                galileo.push_back(ephemeris_batch_test_eph<Galileo_Ephemeris>(prn, 5440.6, prn + 0.5));
+                beidou.push_back(ephemeris_batch_test_eph<Beidou_Dnav_Ephemeris>(prn, 5282.6, prn + 0.25));
+            }
+        for (const auto& eph : gps)
+            {
+                ephemerides.push_back(&eph);
+            }
+        for (const auto& eph : galileo)
+            {
+                ephemerides.push_back(&eph);
+            }
+        for (const auto& eph : beidou)
+            {
+                ephemerides.push_back(&eph);
+            }
+    }
+
+    std::vector<Gps_Ephemeris> gps;
+    std::vector<Galileo_Ephemeris> galileo;
+    std::vector<Beidou_Dnav_Ephemeris> beidou;
+    std::vector<const Gnss_Ephemeris*> ephemerides;
+};
+
+
+TEST_F(GnssEphemerisBatchTest, SameAsSingleSatellite)
+{
+    Gnss_Ephemeris_Batch batch;
+    EXPECT_TRUE(batch.set_ephemerides(ephemerides));
+    ASSERT_EQ(batch.size(), ephemerides.size());
+    for (const double time : {345600.0, 349200.123, 338400.0, 3600.0})
+        {
+            const auto epoch = batch.compute(time);
+            for (size_t k = 0; k < ephemerides.size(); k++)
+                {
+                    Gnss_Ephemeris eph = *ephemerides[k];
+                    eph.satellitePosition(time);
+                    EXPECT_EQ(batch.prn(k), eph.PRN);
+                    EXPECT_NEAR(epoch->pos_X[k], eph.satpos_X, 1e-6);
+                    EXPECT_NEAR(epoch->pos_Y[k], eph.satpos_Y, 1e-6);
+                    EXPECT_NEAR(epoch->pos_Z[k], eph.satpos_Z, 1e-6);
+                    EXPECT_NEAR(epoch->vel_X[k], eph.satvel_X, 1e-9);
+                    EXPECT_NEAR(epoch->vel_Y[k], eph.satvel_Y, 1e-9);
+                    EXPECT_NEAR(epoch->vel_Z[k], eph.satvel_Z, 1e-9);
+                    EXPECT_NEAR(epoch->clock_s[k], eph.dtr, 1e-15);
+                }
+            const std::vector<double> doppler = batch.predicted_doppler(time, 41.27, 1.98, 50.0, 1.0, -2.0, 0.5, 1);
+            for (size_t k = 0; k < ephemerides.size(); k++)
+                {
+                    EXPECT_NEAR(doppler[k], ephemerides[k]->predicted_doppler(time, 41.27, 1.98, 50.0, 1.0, -2.0, 0.5, 1), 1e-6);
+                }
+        }
+}
+
+
+TEST_F(GnssEphemerisBatchTest, EpochsAreCached)
+{
+    Gnss_Ephemeris_Batch batch(2);
+    batch.set_ephemerides(ephemerides);
+    const auto first = batch.compute(345600.0);
+    EXPECT_EQ(batch.compute(345600.0), first);
+    const auto epochs = batch.compute(std::vector<double>{345601.0, 345600.0});
+    ASSERT_EQ(epochs.size(), 2U);
+    EXPECT_EQ(epochs[1], first);
+
+    // the same ephemerides keep the cache, new ones clear it
+    EXPECT_FALSE(batch.set_ephemerides(ephemerides));
+    EXPECT_EQ(batch.compute(345600.0), first);
+    ephemerides.pop_back();
+    EXPECT_TRUE(batch.set_ephemerides(ephemerides));
+    EXPECT_NE(batch.compute(345600.0), first);
+    EXPECT_EQ(batch.compute(345600.0)->pos_X.size(), ephemerides.size());
+}
@@ -0,0 +1,132 @@
+/*!
+ * \file gnss_nav_data_store_test.cc
+ * \brief Tests of the storage of the navigation data in files
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_nav_data_store.h"
+#include "gps_ephemeris.h"
+#include "gps_utc_model.h"
+#include <boost/archive/binary_oarchive.hpp>
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <string>
+
+
+namespace
+{
+std::map<int, Gps_Ephemeris> nav_data_store_test_map(int n)
+{
+    std::map<int, Gps_Ephemeris> eph_map;
+    for (int prn = 1; prn <= n; prn++)
+        {
+            Gps_Ephemeris eph;
+            eph.PRN = prn;
+            eph.sqrtA = 5153.0 + prn;
+            eph.toe = 345600;
+            eph_map[prn] = eph;
+        }
+    return eph_map;
+}
+}  // namespace
+
+
+TEST(GnssNavDataStoreTest, SaveAndLoad)
+{
+    const std::map<int, Gps_Ephemeris> eph_map = nav_data_store_test_map(4);
+    for (const bool binary : {true, false})
+        {
+            const std::string filename = binary ? "gnss_nav_data_store_test.bin" : "gnss_nav_data_store_test.xml";
+            ASSERT_TRUE(Gnss_Nav_Data_Store::save_file(filename, "GNSS-SDR_ephemeris_map", eph_map, binary));
+            std::ifstream ifs(filename, std::ifstream::binary);
+            EXPECT_EQ(ifs.peek() == 'G', binary);
+            ifs.close();
+
+            std::map<int, Gps_Ephemeris> restored;
+            ASSERT_TRUE(Gnss_Nav_Data_Store::load_file(filename, "GNSS-SDR_ephemeris_map", restored));
+            std::remove(filename.c_str());
+            ASSERT_EQ(restored.size(), 4U);
+            EXPECT_EQ(restored.at(3).PRN, 3U);
+            EXPECT_DOUBLE_EQ(restored.at(3).sqrtA, 5156.0);
+            EXPECT_EQ(restored.at(3).toe, 345600);
+        }
+}
+
+
+TEST(GnssNavDataStoreTest, FormerAndOtherFiles)
+{
+    // a binary archive with its header, as written by the former rinex2assist --binary
+    const std::string filename = "gnss_nav_data_store_test_former.bin";
+    Gps_Utc_Model utc;
+    utc.A0 = 1.5e-9;
+    utc.valid = true;
+    {
+        std::ofstream ofs(filename, std::ofstream::binary | std::ofstream::trunc);
+        boost::archive::binary_oarchive bin(ofs);
+        bin << boost::serialization::make_nvp("GNSS-SDR_utc_model", utc);
+    }
+    Gps_Utc_Model restored;
+    ASSERT_TRUE(Gnss_Nav_Data_Store::load_file(filename, "GNSS-SDR_utc_model", restored));
+    EXPECT_DOUBLE_EQ(restored.A0, 1.5e-9);
+    EXPECT_TRUE(restored.valid);
+
+    // a file of another version is rejected, and the data are left untouched
+    ASSERT_TRUE(Gnss_Nav_Data_Store::save_file(filename, "GNSS-SDR_utc_model", utc, true));
+    {
+        std::fstream fs(filename, std::fstream::binary | std::fstream::in | std::fstream::out);
+        fs.seekp(7);
+        fs.put(99);
+    }
+    restored.A0 = 0.0;
+    EXPECT_FALSE(Gnss_Nav_Data_Store::load_file(filename, "GNSS-SDR_utc_model", restored));
+    EXPECT_DOUBLE_EQ(restored.A0, 0.0);
+
+    // something else
+    {
+        std::ofstream ofs(filename, std::ofstream::binary | std::ofstream::trunc);
+        ofs << "not navigation data";
+    }
+    EXPECT_FALSE(Gnss_Nav_Data_Store::load_file(filename, "GNSS-SDR_utc_model", restored));
+    std::remove(filename.c_str());
+    EXPECT_FALSE(Gnss_Nav_Data_Store::load_file(filename, "GNSS-SDR_utc_model", restored));
+}
+
+
+TEST(GnssNavDataStoreTest, Store)
+{
+    const std::string filename = "gnss_nav_data_store_test_async.bin";
+    {
+        Gnss_Nav_Data_Store store;
+        EXPECT_TRUE(store.binary());
+        for (int n = 1; n <= 20; n++)
+            {
+                store.store(filename, "GNSS-SDR_ephemeris_map", nav_data_store_test_map(n));
+            }
+        store.flush();
+        // each copy is either written or replaced by a newer one
+        EXPECT_EQ(store.written() + store.coalesced(), 20U);
+        EXPECT_EQ(store.failed(), 0U);
+        std::map<int, Gps_Ephemeris> restored;
+        ASSERT_TRUE(Gnss_Nav_Data_Store::load_file(filename, "GNSS-SDR_ephemeris_map", restored));
+        EXPECT_EQ(restored.size(), 20U);
+
+        // written by the destructor
+        store.store(filename, "GNSS-SDR_ephemeris_map", nav_data_store_test_map(2));
+        store.store("/nonexistent/gnss_nav_data_store_test.bin", "GNSS-SDR_ephemeris_map", nav_data_store_test_map(2));
+    }
+    std::map<int, Gps_Ephemeris> restored;
+    ASSERT_TRUE(Gnss_Nav_Data_Store::load_file(filename, "GNSS-SDR_ephemeris_map", restored));
+    EXPECT_EQ(restored.size(), 2U);
+    std::remove(filename.c_str());
+}
@@ -0,0 +1,67 @@
+/*!
+ * \file gnss_receiver_checkpoint_test.cc
+ * \brief Tests of the checkpoint of the processing of a recording
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_receiver_checkpoint.h"
+#include "gnss_receiver_snapshot.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+
+
+TEST(GnssReceiverCheckpointTest, SaveAndLoad)
+{
+    const std::string filename = "gnss_receiver_checkpoint_test.bin";
+    Gnss_Receiver_Checkpoint checkpoint;
+    Gps_Ephemeris gps_eph;
+    gps_eph.PRN = 7;
+    gps_eph.sqrtA = 5153.6;
+    checkpoint.state.gps_ephemeris_map[7] = gps_eph;
+    checkpoint.state.pvt_valid = true;
+    checkpoint.state.latitude_deg = 41.27;
+    Gnss_Channel_Checkpoint channel;
+    channel.System = "GPS";
+    channel.Signal = "1C";
+    channel.PRN = 7;
+    // beyond 32 bits, as in a recording of a few minutes
+    channel.code_epoch_samples = 4000000001234ULL;
+    channel.Carrier_Doppler_hz = -1250.5;
+    channel.CN0_dB_hz = 44.0;
+    checkpoint.channels.push_back(channel);
+    checkpoint.source_filename = "recording.dat";
+    checkpoint.fs = 4000000;
+    checkpoint.sample_stamp = channel.code_epoch_samples;
+
+    ASSERT_TRUE(checkpoint.save(filename));
+    Gnss_Receiver_Checkpoint restored;
+    ASSERT_TRUE(restored.load(filename));
+    EXPECT_EQ(restored.source_filename, "recording.dat");
+    EXPECT_EQ(restored.fs, 4000000);
+    EXPECT_EQ(restored.sample_stamp, 4000000001234ULL);
+    ASSERT_EQ(restored.channels.size(), 1U);
+    EXPECT_EQ(restored.channels[0].Signal, "1C");
+    EXPECT_EQ(restored.channels[0].PRN, 7U);
+    EXPECT_EQ(restored.channels[0].code_epoch_samples, 4000000001234ULL);
+    EXPECT_DOUBLE_EQ(restored.channels[0].Carrier_Doppler_hz, -1250.5);
+    ASSERT_EQ(restored.state.gps_ephemeris_map.size(), 1U);
+    EXPECT_DOUBLE_EQ(restored.state.gps_ephemeris_map.at(7).sqrtA, 5153.6);
+    EXPECT_TRUE(restored.state.pvt_valid);
+
+    // a snapshot is not a checkpoint, and the checkpoint is left untouched
+    ASSERT_TRUE(checkpoint.state.save(filename));
+    EXPECT_FALSE(restored.load(filename));
+    EXPECT_EQ(restored.sample_stamp, 4000000001234ULL);
+    std::remove(filename.c_str());
+    EXPECT_FALSE(restored.load(filename));
+}
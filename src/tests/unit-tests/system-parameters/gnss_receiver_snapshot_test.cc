@@ -0,0 +1,88 @@
+/*!
+ * \file gnss_receiver_snapshot_test.cc
+ * \brief Tests of the snapshot of the receiver state
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_receiver_snapshot.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+
+TEST(GnssReceiverSnapshotTest, SaveAndLoad)
+{
+    const std::string filename = "gnss_receiver_snapshot_test.bin";
+    Gnss_Receiver_Snapshot state;
+    Gps_Ephemeris gps_eph;
+    gps_eph.PRN = 7;
+    gps_eph.sqrtA = 5153.6;
+    gps_eph.toe = 345600;
+    state.gps_ephemeris_map[7] = gps_eph;
+    Galileo_Ephemeris gal_eph;
+    gal_eph.PRN = 11;
+    gal_eph.sqrtA = 5440.6;
+    state.galileo_ephemeris_map[11] = gal_eph;
+    state.galileo_iono.ai0 = 58.25;
+    Gnss_Channel_Snapshot channel;
+    channel.System = "GPS";
+    channel.Signal = "1C";
+    channel.PRN = 7;
+    channel.Carrier_Doppler_hz = -1250.5;
+    channel.CN0_dB_hz = 44.0;
+    state.channels.push_back(channel);
+    state.pvt_valid = true;
+    state.latitude_deg = 41.27;
+    state.longitude_deg = 1.99;
+    state.height_m = 80.0;
+    state.clock_drift_ppm = 0.35;
+    state.time_s = std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+    ASSERT_TRUE(state.save(filename));
+    Gnss_Receiver_Snapshot restored;
+    ASSERT_TRUE(restored.load(filename));
+    std::remove(filename.c_str());
+
+    ASSERT_EQ(restored.gps_ephemeris_map.size(), 1U);
+    EXPECT_EQ(restored.gps_ephemeris_map.at(7).PRN, 7U);
+    EXPECT_DOUBLE_EQ(restored.gps_ephemeris_map.at(7).sqrtA, 5153.6);
+    EXPECT_EQ(restored.gps_ephemeris_map.at(7).toe, 345600);
+    ASSERT_EQ(restored.galileo_ephemeris_map.size(), 1U);
+    EXPECT_DOUBLE_EQ(restored.galileo_ephemeris_map.at(11).sqrtA, 5440.6);
+    EXPECT_DOUBLE_EQ(restored.galileo_iono.ai0, 58.25);
+    ASSERT_EQ(restored.channels.size(), 1U);
+    EXPECT_EQ(restored.channels[0].System, "GPS");
+    EXPECT_EQ(restored.channels[0].Signal, "1C");
+    EXPECT_EQ(restored.channels[0].PRN, 7U);
+    EXPECT_DOUBLE_EQ(restored.channels[0].Carrier_Doppler_hz, -1250.5);
+    EXPECT_TRUE(restored.pvt_valid);
+    EXPECT_DOUBLE_EQ(restored.latitude_deg, 41.27);
+    EXPECT_DOUBLE_EQ(restored.clock_drift_ppm, 0.35);
+    EXPECT_GE(restored.age_s(), 0.0);
+    EXPECT_LT(restored.age_s(), 60.0);
+}
+
+
+TEST(GnssReceiverSnapshotTest, RejectsOtherFiles)
+{
+    const std::string filename = "gnss_receiver_snapshot_test_other.bin";
+    Gnss_Receiver_Snapshot state;
+    EXPECT_FALSE(state.load(filename));  // missing file
+
+    std::ofstream ofs(filename, std::ofstream::binary);
+    ofs << "[GNSS-SDR]\nGNSS-SDR.internal_fs_sps=4000000\n";
+    ofs.close();
+    EXPECT_FALSE(state.load(filename));
+    std::remove(filename.c_str());
+}
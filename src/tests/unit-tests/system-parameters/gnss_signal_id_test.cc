@@ -0,0 +1,53 @@
+/*!
+ * \file gnss_signal_id_test.cc
+ * \brief Tests of the numeric signal identifiers
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_signal_id.h"
+#include "gnss_synchro.h"
+#include <gtest/gtest.h>
+#include <cstring>
+
+
+TEST(GnssSignalIdTest, SignalCodes)
+{
+    EXPECT_EQ(gnss_signal_id('G', "1C"), SIGNAL_GPS_1C);
+    EXPECT_EQ(gnss_signal_id('G', "2S"), SIGNAL_GPS_2S);
+    EXPECT_EQ(gnss_signal_id('G', "L5"), SIGNAL_GPS_L5);
+    EXPECT_EQ(gnss_signal_id('S', "1C"), SIGNAL_SBAS_1C);
+    EXPECT_EQ(gnss_signal_id('E', "1B"), SIGNAL_GAL_1B);
+    EXPECT_EQ(gnss_signal_id('E', "5X"), SIGNAL_GAL_5X);
+    EXPECT_EQ(gnss_signal_id('E', "E6"), SIGNAL_GAL_E6);
+    EXPECT_EQ(gnss_signal_id('E', "7X"), SIGNAL_GAL_7X);
+    EXPECT_EQ(gnss_signal_id('R', "1G"), SIGNAL_GLO_1G);
+    EXPECT_EQ(gnss_signal_id('R', "2G"), SIGNAL_GLO_2G);
+    EXPECT_EQ(gnss_signal_id('C', "B1"), SIGNAL_BDS_B1);
+    EXPECT_EQ(gnss_signal_id('C', "B2"), SIGNAL_BDS_B2);
+    EXPECT_EQ(gnss_signal_id('C', "B3"), SIGNAL_BDS_B3);
+
+    // the code is only valid in its own system
+    EXPECT_EQ(gnss_signal_id('E', "1C"), SIGNAL_UNKNOWN);
+    EXPECT_EQ(gnss_signal_id('G', "1B"), SIGNAL_UNKNOWN);
+    EXPECT_EQ(gnss_signal_id('G', "1"), SIGNAL_UNKNOWN);
+    EXPECT_EQ(gnss_signal_id('\0', "1C"), SIGNAL_UNKNOWN);
+}
+
+
+TEST(GnssSignalIdTest, GnssSynchro)
+{
+    Gnss_Synchro gnss_synchro{};
+    EXPECT_EQ(gnss_signal_id(gnss_synchro), SIGNAL_UNKNOWN);
+    gnss_synchro.System = 'E';
+    std::memcpy(static_cast<void*>(gnss_synchro.Signal), "7X", 3);
+    EXPECT_EQ(gnss_signal_id(gnss_synchro), SIGNAL_GAL_7X);
+}
@@ -0,0 +1,67 @@
+/*!
+ * \file gnss_synchro_test.cc
+ * \brief  This file implements tests for the Gnss_Synchro class
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_synchro.h"
+#include <gtest/gtest.h>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+
+TEST(GnssSynchroTest, TriviallyCopyable)
+{
+    EXPECT_TRUE(std::is_trivially_copyable<Gnss_Synchro>::value);
+    EXPECT_TRUE(std::is_trivially_destructible<Gnss_Synchro>::value);
+    EXPECT_TRUE(std::is_standard_layout<Gnss_Synchro>::value);
+}
+
+
+TEST(GnssSynchroTest, CopyKeepsAllTheFields)
+{
+    Gnss_Synchro synchro;
+    synchro.System = 'E';
+    synchro.Signal[0] = '1';
+    synchro.Signal[1] = 'B';
+    synchro.PRN = 11;
+    synchro.Channel_ID = 3;
+    synchro.Acq_doppler_step = 250;
+    synchro.Acq_samplestamp_samples = 123456789012ULL;
+    synchro.Prompt_I = -1.5;
+    synchro.Tracking_sample_counter = 987654321098ULL;
+    synchro.correlation_length_ms = 4;
+    synchro.TOW_at_current_symbol_ms = 345600000;
+    synchro.interp_TOW_ms = 345600000.25;
+    synchro.Flag_PLL_180_deg_phase_locked = true;
+
+    std::vector<Gnss_Synchro> history(2);
+    history[0] = synchro;
+    std::memcpy(&history[1], &synchro, sizeof(Gnss_Synchro));
+    for (const auto& copy : history)
+        {
+            EXPECT_EQ(copy.System, 'E');
+            EXPECT_EQ(copy.Signal[1], 'B');
+            EXPECT_EQ(copy.PRN, 11U);
+            EXPECT_EQ(copy.Channel_ID, 3);
+            EXPECT_EQ(copy.Acq_doppler_step, 250U);
+            EXPECT_EQ(copy.Acq_samplestamp_samples, 123456789012ULL);
+            EXPECT_EQ(copy.Prompt_I, -1.5);
+            EXPECT_EQ(copy.Tracking_sample_counter, 987654321098ULL);
+            EXPECT_EQ(copy.correlation_length_ms, 4);
+            EXPECT_EQ(copy.TOW_at_current_symbol_ms, 345600000U);
+            EXPECT_EQ(copy.interp_TOW_ms, 345600000.25);
+            EXPECT_TRUE(copy.Flag_PLL_180_deg_phase_locked);
+            EXPECT_FALSE(copy.Flag_valid_word);
+        }
+}
@@ -351,6 +351,32 @@ double FrontEndCal::estimate_doppler_from_eph(unsigned int PRN, double tow, doub
 }
 
 
+double FrontEndCal::estimate_elevation_from_eph(unsigned int PRN, double tow, double lat, double lon, double height) noexcept(false)
+{
+    arma::vec lla = "0.0 0.0 0.0 0.0";
+    lla(0) = lat;
+    lla(1) = lon;
+    lla(2) = height;
+    const arma::vec obs_ecef = lla2ecef(lla);
+
+    std::map<int, Gps_Ephemeris> eph_map;
+    eph_map = global_gps_ephemeris_map.get_map_copy();
+    const auto eph_it = eph_map.find(PRN);
+    if (eph_it == eph_map.end())
+        {
+            throw std::runtime_error("1");
+        }
+    eph_it->second.satellitePosition(tow);
+    arma::vec SV_pos_ecef = "0.0 0.0 0.0 0.0";
+    SV_pos_ecef(0) = eph_it->second.satpos_X;
+    SV_pos_ecef(1) = eph_it->second.satpos_Y;
+    SV_pos_ecef(2) = eph_it->second.satpos_Z;
+    const arma::vec line_of_sight = SV_pos_ecef - obs_ecef;
+    const double sin_elevation = arma::dot(line_of_sight, obs_ecef) / (arma::norm(line_of_sight, 2) * arma::norm(obs_ecef, 2));
+    return std::asin(sin_elevation) * 180.0 / GNSS_PI;
+}
+
+
 void FrontEndCal::GPS_L1_front_end_model_E4000(double f_bb_true_Hz, double f_bb_meas_Hz, double fs_nominal_hz, double *estimated_fs_Hz, double *estimated_f_if_Hz, double *f_osc_err_ppm)
 {
     const double f_osc_n = 28.8e6;
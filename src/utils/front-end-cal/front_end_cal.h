@@ -53,6 +53,14 @@ public:
      */
     double estimate_doppler_from_eph(unsigned int PRN, double tow, double lat, double lon, double height) noexcept(false);
 
+    /*!
+     * \brief This function estimates the elevation [deg] of a GPS satellite over
+     * the geocentric horizon of the receiver, from the same data as
+     * estimate_doppler_from_eph. It throws if there is no ephemeris for the PRN.
+     *
+     */
+    double estimate_elevation_from_eph(unsigned int PRN, double tow, double lat, double lon, double height) noexcept(false);
+
     /*!
      * \brief This function models the Elonics E4000 + RTL2832 front-end
      * Inputs:
@@ -54,6 +54,8 @@
 #include <gnuradio/top_block.h>
 #include <pmt/pmt.h>        // for pmt_t, to_long
 #include <pmt/pmt_sugar.h>  // for mp
+#include <algorithm>  // for max, min
+#include <atomic>
 #include <chrono>
 #include <cmath>  // for round
 #include <cstdint>
@@ -63,6 +65,7 @@
 #include <iostream>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <stdexcept>  // for logic_error
 #include <string>
 #include <thread>
@@ -96,11 +99,6 @@ Concurrent_Map<Gps_Almanac> global_gps_almanac_map;
 Concurrent_Map<Gps_Acq_Assist> global_gps_acq_assist_map;
 Concurrent_Queue<Gps_Acq_Assist> global_gps_acq_assist_queue;
 
-bool stop;
-Concurrent_Queue<int> channel_internal_queue;
-std::vector<Gnss_Synchro> gnss_sync_vector;
-Gnss_Synchro gnss_synchro{};
-
 // ######## GNURADIO BLOCK MESSAGE RECEVER #########
 class FrontEndCal_msg_rx;
 
@@ -118,6 +116,8 @@ private:
 
 public:
     int rx_message{0};
+    Gnss_Synchro* gnss_synchro{nullptr};         // filled by the acquisition block
+    std::vector<Gnss_Synchro> positive_acquisitions;  // since the last clear
 };
 
 
@@ -133,7 +133,10 @@ void FrontEndCal_msg_rx::msg_handler_channel_events(const pmt::pmt_t& msg)
         {
             int64_t message = pmt::to_long(msg);
             rx_message = message;
-            channel_internal_queue.push(rx_message);
+            if (rx_message == 1 and gnss_synchro != nullptr)  // positive acquisition
+                {
+                    positive_acquisitions.push_back(*gnss_synchro);
+                }
         }
     catch (const wht::bad_any_cast& e)
         {
@@ -160,32 +163,6 @@ FrontEndCal_msg_rx::FrontEndCal_msg_rx()
 }
 
 
-void wait_message()
-{
-    while (!stop)
-        {
-            int message;
-            channel_internal_queue.wait_and_pop(message);
-            // std::cout<<"Acq message rx="<<message<< '\n';
-            switch (message)
-                {
-                case 1:  // Positive acq
-                    gnss_sync_vector.push_back(gnss_synchro);
-                    // acquisition->reset();
-                    break;
-                case 2:  // negative acq
-                    // acquisition->reset();
-                    break;
-                case 3:
-                    stop = true;
-                    break;
-                default:
-                    break;
-                }
-        }
-}
-
-
 bool front_end_capture(const std::shared_ptr<ConfigurationInterface>& configuration)
 {
     auto success = false;
@@ -353,66 +330,52 @@ int main(int argc, char** argv)
             std::cout << "Unexpected exception\n";
         }
 
-    // 4. Setup GNU Radio flowgraph (file_source -> Acquisition_10m)
-    gr::top_block_sptr top_block;
-    top_block = gr::make_top_block("Acquisition test");
-
-    // Satellite signal definition
-    gnss_synchro = Gnss_Synchro();
-    gnss_synchro.Channel_ID = 0;
-    gnss_synchro.System = 'G';
-    std::string signal = "1C";
-    signal.copy(gnss_synchro.Signal, 2, 0);
-    gnss_synchro.PRN = 1;
-
+    // 4. Select the satellites to search: with ephemeris assistance, only the ones over the horizon
     int64_t fs_in_ = configuration->property("GNSS-SDR.internal_fs_sps", 2048000);
     configuration->set_property("Acquisition.max_dwells", "10");
 
-    auto acquisition = std::make_shared<GpsL1CaPcpsAcquisitionFineDoppler>(configuration.get(), "Acquisition", 1, 1);
-
-    acquisition->set_channel(1);
-    acquisition->set_gnss_synchro(&gnss_synchro);
-    acquisition->set_threshold(configuration->property("Acquisition.threshold", 2.0));
-    acquisition->set_doppler_max(configuration->property("Acquisition.doppler_max", 10000));
-    acquisition->set_doppler_step(configuration->property("Acquisition.doppler_step", 250));
-
-    gr::block_sptr source;
-    source = gr::blocks::file_source::make(sizeof(gr_complex), "tmp_capture.dat");
-#if GNURADIO_USES_STD_POINTERS
-    std::shared_ptr<FrontEndCal_msg_rx> msg_rx;
-#else
-    boost::shared_ptr<FrontEndCal_msg_rx> msg_rx;
-#endif
-    try
-        {
-            msg_rx = FrontEndCal_msg_rx_make();
-        }
-    catch (const std::exception& e)
-        {
-            std::cout << "Failure connecting the message port system: " << e.what() << '\n';
-            exit(0);
-        }
+    // Get user position from config file (or from SUPL using GSM Cell ID)
+    double lat_deg = configuration->property("GNSS-SDR.init_latitude_deg", 41.0);
+    double lon_deg = configuration->property("GNSS-SDR.init_longitude_deg", 2.0);
+    double altitude_m = configuration->property("GNSS-SDR.init_altitude_m", 100);
 
-    try
+    std::vector<unsigned int> search_prns;
+    const double min_elevation_deg = configuration->property("GNSS-SDR.front_end_cal_min_elevation_deg", -5.0);
+    if (configuration->property("GNSS-SDR.front_end_cal_assisted_search", true) and global_gps_ephemeris_map.size() > 0)
         {
-            acquisition->connect(top_block);
-            top_block->connect(source, 0, acquisition->get_left_block(), 0);
-            top_block->msg_connect(acquisition->get_right_block(), pmt::mp("events"), msg_rx, pmt::mp("events"));
+            const double assistance_TOW = global_gps_ephemeris_map.get_map_copy().begin()->second.tow;
+            for (unsigned int PRN = 1; PRN < 33; PRN++)
+                {
+                    try
+                        {
+                            if (front_end_cal.estimate_elevation_from_eph(PRN, assistance_TOW, lat_deg, lon_deg, altitude_m) >= min_elevation_deg)
+                                {
+                                    search_prns.push_back(PRN);
+                                }
+                        }
+                    catch (const std::exception& ex)
+                        {
+                            // no ephemeris for this PRN
+                        }
+                }
         }
-    catch (const std::exception& e)
+    if (search_prns.empty())
         {
-            std::cout << "Failure connecting the GNU Radio blocks: " << e.what() << '\n';
+            for (unsigned int PRN = 1; PRN < 33; PRN++)
+                {
+                    search_prns.push_back(PRN);
+                }
         }
 
-    // 5. Run the flowgraph
+    // 5. Run the flowgraphs (file_source -> Acquisition), one per thread, each one searching the next PRN not taken yet
     // Get visible GPS satellites (positive acquisitions with Doppler measurements)
     // Compute Doppler estimations
-
-    // todo: Fix the front-end cal to support new channel internal message system (no more external queues)
     std::map<int, double> doppler_measurements_map;
-    std::map<int, double> cn0_measurements_map;
+    std::mutex doppler_measurements_mutex;
+    std::atomic<std::size_t> next_prn{0};
 
-    std::thread ch_thread;
+    unsigned int n_threads = configuration->property("GNSS-SDR.front_end_cal_threads", std::max(std::thread::hardware_concurrency(), 1U));
+    n_threads = std::max(1U, std::min(n_threads, static_cast<unsigned int>(search_prns.size())));
 
     // record startup time
     std::chrono::time_point<std::chrono::system_clock> start;
@@ -420,69 +383,104 @@ int main(int argc, char** argv)
     std::chrono::duration<double> elapsed_seconds{};
     start = std::chrono::system_clock::now();
 
-    bool start_msg = true;
+    std::cout << "Searching for GPS Satellites in L1 band with " << n_threads << " threads...\n";
+    std::cout.flush();
+
+    const auto search_satellites = [&](unsigned int channel) {
+        Gnss_Synchro gnss_synchro{};
+        gnss_synchro.Channel_ID = channel;
+        gnss_synchro.System = 'G';
+        std::string signal = "1C";
+        signal.copy(gnss_synchro.Signal, 2, 0);
+        gnss_synchro.PRN = 1;
+
+        gr::top_block_sptr top_block = gr::make_top_block("Acquisition test");
+        auto acquisition = std::make_shared<GpsL1CaPcpsAcquisitionFineDoppler>(configuration.get(), "Acquisition", 1, 1);
+        acquisition->set_channel(channel);
+        acquisition->set_gnss_synchro(&gnss_synchro);
+        acquisition->set_threshold(configuration->property("Acquisition.threshold", 2.0));
+        acquisition->set_doppler_max(configuration->property("Acquisition.doppler_max", 10000));
+        acquisition->set_doppler_step(configuration->property("Acquisition.doppler_step", 250));
+
+        gr::block_sptr source;
+        source = gr::blocks::file_source::make(sizeof(gr_complex), "tmp_capture.dat");
+#if GNURADIO_USES_STD_POINTERS
+        std::shared_ptr<FrontEndCal_msg_rx> msg_rx;
+#else
+        boost::shared_ptr<FrontEndCal_msg_rx> msg_rx;
+#endif
+        try
+            {
+                msg_rx = FrontEndCal_msg_rx_make();
+                msg_rx->gnss_synchro = &gnss_synchro;
+                acquisition->connect(top_block);
+                top_block->connect(source, 0, acquisition->get_left_block(), 0);
+                top_block->msg_connect(acquisition->get_right_block(), pmt::mp("events"), msg_rx, pmt::mp("events"));
+            }
+        catch (const std::exception& e)
+            {
+                std::cout << "Failure connecting the GNU Radio blocks: " << e.what() << '\n';
+                return;
+            }
+
+        for (std::size_t i = next_prn++; i < search_prns.size(); i = next_prn++)
+            {
+                const unsigned int PRN = search_prns[i];
+                gnss_synchro.PRN = PRN;
+                acquisition->set_gnss_synchro(&gnss_synchro);
+                acquisition->init();
+                acquisition->set_local_code();
+                acquisition->reset();
+                msg_rx->positive_acquisitions.clear();
+                top_block->run();
+                if (!msg_rx->positive_acquisitions.empty())
+                    {
+                        double doppler_measurement_hz = 0;
+                        for (auto& it : msg_rx->positive_acquisitions)
+                            {
+                                doppler_measurement_hz += it.Acq_doppler_hz;
+                            }
+                        doppler_measurement_hz = doppler_measurement_hz / msg_rx->positive_acquisitions.size();
+                        const std::lock_guard<std::mutex> lock(doppler_measurements_mutex);
+                        doppler_measurements_map.insert(std::pair<int, double>(PRN, doppler_measurement_hz));
+                    }
+#if GNURADIO_USES_STD_POINTERS
+                std::dynamic_pointer_cast<gr::blocks::file_source>(source)->seek(0, 0);
+#else
+                boost::dynamic_pointer_cast<gr::blocks::file_source>(source)->seek(0, 0);
+#endif
+            }
+    };
 
-    for (unsigned int PRN = 1; PRN < 33; PRN++)
+    std::vector<std::thread> search_threads;
+    for (unsigned int t = 1; t < n_threads; t++)
         {
-            gnss_synchro.PRN = PRN;
-            acquisition->set_gnss_synchro(&gnss_synchro);
-            acquisition->init();
-            acquisition->set_local_code();
-            acquisition->reset();
-            stop = false;
             try
                 {
-                    ch_thread = std::thread(wait_message);
+                    search_threads.emplace_back(search_satellites, t + 1);
                 }
             catch (const std::exception& e)
                 {
                     LOG(INFO) << "Exception caught (thread resource error)";
                 }
-            top_block->run();
-            if (start_msg == true)
-                {
-                    std::cout << "Searching for GPS Satellites in L1 band...\n";
-                    std::cout << "[";
-                    start_msg = false;
-                }
-            if (!gnss_sync_vector.empty())
+        }
+    search_satellites(1);
+    for (auto& search_thread : search_threads)
+        {
+            search_thread.join();
+        }
+
+    std::cout << "[";
+    for (const auto PRN : search_prns)
+        {
+            if (doppler_measurements_map.count(PRN) != 0)
                 {
                     std::cout << " " << PRN << " ";
-                    double doppler_measurement_hz = 0;
-                    for (auto& it : gnss_sync_vector)
-                        {
-                            doppler_measurement_hz += it.Acq_doppler_hz;
-                        }
-                    doppler_measurement_hz = doppler_measurement_hz / gnss_sync_vector.size();
-                    doppler_measurements_map.insert(std::pair<int, double>(PRN, doppler_measurement_hz));
                 }
             else
                 {
                     std::cout << " . ";
                 }
-            try
-                {
-                    channel_internal_queue.push(3);
-                }
-            catch (const boost::exception& e)
-                {
-                    LOG(INFO) << "Exception caught while pushing to the internal queue.";
-                }
-            try
-                {
-                    ch_thread.join();
-                }
-            catch (const std::exception& e)
-                {
-                    LOG(INFO) << "Exception caught while joining threads.";
-                }
-            gnss_sync_vector.clear();
-#if GNURADIO_USES_STD_POINTERS
-            std::dynamic_pointer_cast<gr::blocks::file_source>(source)->seek(0, 0);
-#else
-            boost::dynamic_pointer_cast<gr::blocks::file_source>(source)->seek(0, 0);
-#endif
-            std::cout.flush();
         }
     std::cout << "]\n";
 
@@ -527,11 +525,6 @@ int main(int argc, char** argv)
             return 0;
         }
 
-    // Get user position from config file (or from SUPL using GSM Cell ID)
-    double lat_deg = configuration->property("GNSS-SDR.init_latitude_deg", 41.0);
-    double lon_deg = configuration->property("GNSS-SDR.init_longitude_deg", 2.0);
-    double altitude_m = configuration->property("GNSS-SDR.init_altitude_m", 100);
-
     std::cout << "Reference location (defined in config file):\n";
 
     std::cout << "Latitude=" << lat_deg << " [º]\n";
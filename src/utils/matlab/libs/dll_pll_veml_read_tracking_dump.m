@@ -49,7 +49,16 @@ if (nargin < 2)
 end
 %loops_counter = fread (f, count, 'uint32',4*12);
 f = fopen (filename, 'rb');
+if (f >= 0)
+    magic = fread (f, 8, 'char=>char')';
+    frewind (f);
+end
 if (f < 0)
+elseif (strcmp(magic, 'GNSSDMPC'))
+    % written with dump_compressed=true
+    fclose (f);
+    v = read_gnss_dump_compressed (filename, count);
+    [v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12, v13, v14, v15, v16, v17, v18, v19, v20, v21, v22] = v{:};
 else
     v1 = fread (f, count, 'float', skip_bytes_each_read - float_size_bytes);
     bytes_shift = bytes_shift + float_size_bytes;
@@ -120,6 +129,8 @@ else
     fseek(f,bytes_shift,'bof'); % move to next unsigned int
     v22 = fread (f, count, 'uint', skip_bytes_each_read - unsigned_int_size_bytes);
     fclose (f);
+end
+if (f >= 0)
 
     GNSS_tracking.VE = v1;
     GNSS_tracking.E = v2;
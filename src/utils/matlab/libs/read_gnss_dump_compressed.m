@@ -0,0 +1,144 @@
+% Usage: read_gnss_dump_compressed (filename, [count])
+%
+% Read a GNSS-SDR dump file written in the compressed format (see
+% gnss_dump_codec.h) into MATLAB, a chunk of records at a time.
+% Returns a cell array with a column of values (as double) per field of
+% the records, in the order of the record layout, and the layout itself.
+
+% -------------------------------------------------------------------------
+%
+% GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+% This file is part of GNSS-SDR.
+%
+% SPDX-FileCopyrightText: 2010-2022 (see AUTHORS file for a list of contributors)
+% SPDX-License-Identifier: GPL-3.0-or-later
+%
+% -------------------------------------------------------------------------
+
+function [fields, layout] = read_gnss_dump_compressed (filename, count)
+
+if (nargin < 2)
+    count = Inf;
+end
+
+fields = {};
+layout = '';
+f = fopen (filename, 'rb');
+if (f < 0)
+    return;
+end
+magic = fread (f, 8, 'char=>char')';
+if (~strcmp(magic, 'GNSSDMPC'))
+    fclose (f);
+    error ('%s is not a compressed dump file', filename);
+end
+layout_size = fread (f, 1, 'uint32');
+layout = fread (f, layout_size, 'char=>char')';
+num_fields = length(layout);
+chunks = cell(0, num_fields);
+records = 0;
+while (records < count)
+    n_records = fread (f, 1, 'uint32');
+    first_record = fread (f, 1, 'uint64'); %#ok<NASGU>
+    payload_size = fread (f, 1, 'uint32');
+    if (isempty(payload_size))
+        break;
+    end
+    payload = fread (f, payload_size, 'uint8=>uint8');
+    if (length(payload) < payload_size)
+        break;  % last chunk of a file still being written
+    end
+    pos = 1;
+    chunk = cell(1, num_fields);
+    for field = 1:num_fields
+        [chunk{field}, pos] = decode_column (payload, pos, n_records, layout(field));
+    end
+    chunks(end + 1, :) = chunk; %#ok<AGROW>
+    records = records + n_records;
+end
+fclose (f);
+
+fields = cell(1, num_fields);
+for field = 1:num_fields
+    fields{field} = vertcat(chunks{:, field});
+    if (length(fields{field}) > count)
+        fields{field} = fields{field}(1:count);
+    end
+end
+end
+
+
+function [values, pos] = decode_column (payload, pos, n_records, type)
+% A column holds the significant byte counts of its codes, two per byte,
+% followed by the low-order bytes of each code
+switch type
+    case {'b', 'B'}
+        size_bytes = 1;
+    case {'h', 'H'}
+        size_bytes = 2;
+    case {'i', 'I', 'f'}
+        size_bytes = 4;
+    otherwise
+        size_bytes = 8;
+end
+packed = payload(pos:pos + ceil(n_records / 2) - 1);
+pos = pos + length(packed);
+counts = double(reshape([bitand(packed, 15)'; bitshift(packed, -4)'], [], 1));
+counts = counts(1:n_records);
+starts = pos + [0; cumsum(counts(1:end - 1))];
+pos = pos + sum(counts);
+codes = zeros(n_records, 1, 'uint64');
+for k = 1:size_bytes
+    sel = counts >= k;
+    codes(sel) = bitor(codes(sel), bitshift(uint64(payload(starts(sel) + k - 1)), 8 * (k - 1)));
+end
+
+if (type == 'f' || type == 'd')
+    % each value was XORed with the previous one
+    words = codes;
+    s = 1;
+    while (s < n_records)
+        words(s + 1:end) = bitxor(words(s + 1:end), words(1:end - s));
+        s = 2 * s;
+    end
+else
+    % zigzag codes of the differences with the previous value
+    if (size_bytes == 8)
+        mask = intmax('uint64');
+    else
+        mask = uint64(2^(8 * size_bytes) - 1);
+    end
+    odd = bitand(codes, uint64(1)) ~= 0;
+    diffs = bitshift(codes, -1);
+    diffs(odd) = bitand(bitxor(diffs(odd), intmax('uint64')), mask);
+    % sums modulo 2^32 of the low and high halves, exact in double
+    lo = cumsum(double(bitand(diffs, uint64(4294967295))));
+    hi = cumsum(double(bitshift(diffs, -32))) + floor(lo / 2^32);
+    words = bitor(bitshift(uint64(mod(hi, 2^32)), 32), uint64(mod(lo, 2^32)));
+    words = bitand(words, mask);
+end
+
+switch type
+    case 'b'
+        values = double(typecast(uint8(words), 'int8'));
+    case 'B'
+        values = double(words);
+    case 'h'
+        values = double(typecast(uint16(words), 'int16'));
+    case 'H'
+        values = double(words);
+    case 'i'
+        values = double(typecast(uint32(words), 'int32'));
+    case 'I'
+        values = double(words);
+    case 'f'
+        values = double(typecast(uint32(words), 'single'));
+    case 'q'
+        values = double(typecast(words, 'int64'));
+    case 'Q'
+        values = double(words);
+    otherwise
+        values = typecast(words, 'double');
+end
+values = values(:);
+end
@@ -13,19 +13,61 @@
  * -----------------------------------------------------------------------------
  */
 
+#include "nav_msg_shm_listener.h"
 #include "nav_msg_udp_listener.h"
 #include <boost/lexical_cast.hpp>
+#include <chrono>
 #include <iostream>
+#include <string>
+#include <thread>
+
+int listen_to_shared_memory(const std::string &shm_name)
+{
+    while (true)
+        {
+            Nav_Msg_Shm_Listener shm_listener(shm_name);
+            if (!shm_listener.is_open())
+                {
+                    std::cerr << shm_listener.error() << '\n';
+                    return 1;
+                }
+            gnss_sdr::navMsg message;
+            while (!shm_listener.writer_closed())
+                {
+                    if (shm_listener.read_nav_message(message))
+                        {
+                            Nav_Msg_Udp_Listener::print_message(message);
+                        }
+                    else
+                        {
+                            // Nothing new, poll again soon
+                            std::this_thread::sleep_for(std::chrono::microseconds(500));
+                        }
+                }
+            // The receiver was restarted, wait for the new shared memory object
+            std::cout << "GNSS-SDR stopped, waiting for it..." << std::endl;
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+            while (!Nav_Msg_Shm_Listener(shm_name).is_open())
+                {
+                    std::this_thread::sleep_for(std::chrono::seconds(1));
+                }
+        }
+}
 
 int main(int argc, char *argv[])
 {
     try
         {
             // Check command line arguments.
+            if (argc == 3 and std::string(argv[1]) == "--shm")
+                {
+                    return listen_to_shared_memory(argv[2]);
+                }
             if (argc != 2)
                 {
                     // Print help.
                     std::cerr << "Usage: nav_msg_listener <port>\n";
+                    std::cerr << "       nav_msg_listener --shm <shared memory name>\n";
                     return 1;
                 }
 
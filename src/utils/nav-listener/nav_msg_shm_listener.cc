@@ -0,0 +1,63 @@
+/*!
+ * \file nav_msg_shm_listener.cc
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "nav_msg_shm_listener.h"
+
+Nav_Msg_Shm_Listener::Nav_Msg_Shm_Listener(const std::string &shm_name)
+    : reader{shm_name}, record{new Nav_Message_Shm_Record()}
+{
+    error_message = reader.error();
+    if (reader.is_open() and (reader.record_type() != SHM_RECORD_NAV_MESSAGE or reader.record_size() != sizeof(Nav_Message_Shm_Record)))
+        {
+            error_message = shm_name + " does not contain navigation messages of this version";
+        }
+}
+
+bool Nav_Msg_Shm_Listener::is_open() const
+{
+    return error_message.empty();
+}
+
+const std::string &Nav_Msg_Shm_Listener::error() const
+{
+    return error_message;
+}
+
+bool Nav_Msg_Shm_Listener::writer_closed() const
+{
+    return reader.writer_closed();
+}
+
+uint64_t Nav_Msg_Shm_Listener::lost() const
+{
+    return reader.lost();
+}
+
+bool Nav_Msg_Shm_Listener::read_nav_message(gnss_sdr::navMsg &message)
+{
+    if (!is_open() or !reader.read(record.get()))
+        {
+            return false;
+        }
+    if (record->nav_message_length > Nav_Message_Shm_Record::MAX_NAV_MESSAGE_LENGTH)
+        {
+            return false;
+        }
+    message.set_system(record->system);
+    message.set_signal(record->signal);
+    message.set_prn(record->prn);
+    message.set_tow_at_current_symbol_ms(record->tow_at_current_symbol_ms);
+    message.set_nav_message(record->nav_message, record->nav_message_length);
+    return true;
+}
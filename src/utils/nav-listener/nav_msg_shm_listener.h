@@ -0,0 +1,44 @@
+/*!
+ * \file nav_msg_shm_listener.h
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_NAV_MSG_SHM_LISTENER_H
+#define GNSS_SDR_NAV_MSG_SHM_LISTENER_H
+
+#include "gnss_shm_ring.h"
+#include "nav_message.pb.h"
+#include "nav_message_shm_record.h"
+#include <memory>
+#include <string>
+
+/*!
+ * \brief Reads the navigation messages published by GNSS-SDR in shared
+ * memory (NavDataMonitor.shm_name), for clients running in the same host.
+ */
+class Nav_Msg_Shm_Listener
+{
+public:
+    explicit Nav_Msg_Shm_Listener(const std::string &shm_name);
+    bool is_open() const;
+    const std::string &error() const;
+    bool writer_closed() const;
+    uint64_t lost() const;
+    bool read_nav_message(gnss_sdr::navMsg &message);
+
+private:
+    Gnss_Shm_Ring_Reader reader;
+    std::unique_ptr<Nav_Message_Shm_Record> record;
+    std::string error_message;
+};
+
+#endif
@@ -46,7 +46,7 @@ bool Nav_Msg_Udp_Listener::receive_and_parse_nav_message(gnss_sdr::navMsg &messa
  * !\brief prints navigation message content
  * \param[in] message nav message to be printed
  */
-void Nav_Msg_Udp_Listener::print_message(gnss_sdr::navMsg &message) const
+void Nav_Msg_Udp_Listener::print_message(gnss_sdr::navMsg &message)
 {
     std::string system = message.system();
     std::string signal = message.signal();
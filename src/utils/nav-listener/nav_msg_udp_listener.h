@@ -23,7 +23,7 @@ class Nav_Msg_Udp_Listener
 {
 public:
     explicit Nav_Msg_Udp_Listener(unsigned short port);
-    void print_message(gnss_sdr::navMsg &message) const;
+    static void print_message(gnss_sdr::navMsg &message);
     bool receive_and_parse_nav_message(gnss_sdr::navMsg &message);
 
 private:
@@ -0,0 +1,314 @@
+#!/usr/bin/env python3
+#
+# GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+# This file is part of GNSS-SDR.
+#
+# Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+# SPDX-License-Identifier: GPL-3.0-or-later
+
+"""Reads the binary dump files of GNSS-SDR into NumPy structured arrays.
+
+The records of each dump are described by a versioned schema of SCHEMAS: the
+name and type of each field, in the order they are written by the block, with
+the characters of the Python struct module (see
+Gnss_Dump_Writer::set_record_layout()). The values are in the byte order of
+the host that wrote the file.
+
+  records = read_dump('tracking_ch_0.dat', 'tracking')
+  records['CN0_SNV_dB_Hz'].mean()
+
+Plain dump files are not read: read_dump() returns a numpy.memmap of the file
+with the dtype of the schema, so the records are paged in by the OS when they
+are used. The compressed files (dump_compressed=true) are decoded, one chunk
+at a time. iter_dump() yields the records in arrays of a bounded size, for
+files larger than the memory, and iter_record_batches() yields them as Arrow
+record batches if pyarrow is installed.
+
+The observables dump multiplexes the channels: its records have a row per
+epoch and a column per channel, and the number of channels has to be given.
+
+usage: gnss_sdr_dump.py --schemas
+       gnss_sdr_dump.py [-c channels] schema filename
+"""
+
+import argparse
+import json
+import os
+import struct
+import sys
+
+import numpy as np
+
+COMPRESSED_MAGIC = b'GNSSDMPC'
+COMPRESSED_CHUNK_HEADER = struct.Struct('=IQI')
+
+NUMPY_TYPES = {'b': 'i1', 'B': 'u1', 'h': 'i2', 'H': 'u2', 'i': 'i4',
+               'I': 'u4', 'q': 'i8', 'Q': 'u8', 'f': 'f4', 'd': 'f8'}
+
+# The version of a schema changes with the fields written by its block
+SCHEMAS = {
+    'tracking': {
+        'version': 1,
+        'writer': 'src/algorithms/tracking/gnuradio_blocks/dll_pll_veml_tracking.cc',
+        'fields': [
+            ('VE', 'f'), ('E', 'f'), ('P', 'f'), ('L', 'f'), ('VL', 'f'),
+            ('prompt_I', 'f'), ('prompt_Q', 'f'),
+            ('PRN_start_sample', 'Q'),
+            ('acc_carrier_phase_rad', 'f'),
+            ('carrier_doppler_hz', 'f'),
+            ('carrier_doppler_rate_hz_s', 'f'),
+            ('code_freq_hz', 'f'),
+            ('code_freq_rate_hz_s', 'f'),
+            ('carr_error', 'f'), ('carr_nco', 'f'),
+            ('code_error', 'f'), ('code_nco', 'f'),
+            ('CN0_SNV_dB_Hz', 'f'),
+            ('carrier_lock_test', 'f'),
+            ('var1', 'f'), ('var2', 'd'),
+            ('PRN', 'I')]},
+    'telemetry': {
+        'version': 1,
+        'writer': 'src/algorithms/telemetry_decoder/gnuradio_blocks/*_telemetry_decoder_gs.cc',
+        'fields': [
+            ('tow_current_symbol_s', 'd'),
+            ('tracking_sample_counter', 'Q'),
+            ('tow_at_preamble_s', 'd'),
+            ('nav_symbol', 'i'),
+            ('PRN', 'i')]},
+    'observables': {
+        'version': 1,
+        'writer': 'src/algorithms/observables/gnuradio_blocks/hybrid_observables_gs.cc',
+        'multiplexed': True,
+        'fields': [
+            ('RX_time', 'd'),
+            ('TOW_at_current_symbol_s', 'd'),
+            ('Carrier_Doppler_hz', 'd'),
+            ('Carrier_phase_cycles', 'd'),
+            ('Pseudorange_m', 'd'),
+            ('PRN', 'd'),
+            ('valid', 'd')]},
+    'pvt': {
+        'version': 1,
+        'writer': 'src/algorithms/PVT/libs/rtklib_solver.cc',
+        'fields': [
+            ('tow_ms', 'I'), ('week', 'I'),
+            ('rx_time', 'd'), ('clock_offset_s', 'd'),
+            ('ecef_x', 'd'), ('ecef_y', 'd'), ('ecef_z', 'd'),
+            ('ecef_vel_x', 'd'), ('ecef_vel_y', 'd'), ('ecef_vel_z', 'd'),
+            ('cov_xx', 'd'), ('cov_yy', 'd'), ('cov_zz', 'd'),
+            ('cov_xy', 'd'), ('cov_yz', 'd'), ('cov_zx', 'd'),
+            ('latitude', 'd'), ('longitude', 'd'), ('height', 'd'),
+            ('valid_sats', 'B'), ('solution_status', 'B'), ('solution_type', 'B'),
+            ('ar_ratio_factor', 'f'), ('ar_ratio_threshold', 'f'),
+            ('gdop', 'd'), ('pdop', 'd'), ('hdop', 'd'), ('vdop', 'd')]},
+}
+
+
+def record_layout(schema):
+    """Layout of the records of schema, as given to set_record_layout()."""
+    return ''.join(field for _, field in SCHEMAS[schema]['fields'])
+
+
+def record_dtype(schema):
+    """Packed dtype of a record of schema (of a channel, for the observables)."""
+    return np.dtype([(name, '=' + NUMPY_TYPES[field]) for name, field in SCHEMAS[schema]['fields']])
+
+
+def is_compressed(filename):
+    with open(filename, 'rb') as f:
+        return f.read(len(COMPRESSED_MAGIC)) == COMPRESSED_MAGIC
+
+
+def _shape(schema, n, channels):
+    if SCHEMAS[schema].get('multiplexed', False):
+        return (n, channels)
+    return (n,)
+
+
+def _read_compressed_header(f, schema, filename):
+    if f.read(len(COMPRESSED_MAGIC)) != COMPRESSED_MAGIC:
+        raise ValueError('{} is not a compressed dump file'.format(filename))
+    (layout_size,) = struct.unpack('=I', f.read(4))
+    layout = f.read(layout_size).decode('ascii')
+    if layout != record_layout(schema):
+        raise ValueError('the records of {} ({}) are not the ones of version {} of the {} schema ({})'.format(
+            filename, layout, SCHEMAS[schema]['version'], schema, record_layout(schema)))
+    return layout
+
+
+def _decode_chunk(payload, n_records, layout, dtype):
+    """Columns of a chunk of a compressed file (see gnss_dump_codec.h)."""
+    columns = []
+    pos = 0
+    for field, name in zip(layout, dtype.names):
+        size = dtype[name].itemsize
+        packed = payload[pos:pos + (n_records + 1) // 2]
+        pos += len(packed)
+        counts = np.empty(2 * len(packed), np.int64)
+        counts[0::2] = packed & 15
+        counts[1::2] = packed >> 4
+        counts = counts[:n_records]
+        starts = pos + np.cumsum(counts) - counts
+        pos += int(counts.sum())
+        if pos > len(payload):
+            raise ValueError('invalid chunk of a compressed dump file')
+        codes = np.zeros(n_records, np.uint64)
+        for k in range(size):
+            sel = counts > k
+            codes[sel] |= payload[starts[sel] + k].astype(np.uint64) << np.uint64(8 * k)
+        if field in 'fd':
+            # each value was XORed with the previous one
+            words = np.bitwise_xor.accumulate(codes)
+        else:
+            # zigzag codes of the differences with the previous value,
+            # summed modulo 2^64 and truncated to the size of the field
+            diffs = (codes >> np.uint64(1)) ^ (np.uint64(0) - (codes & np.uint64(1)))
+            words = np.cumsum(diffs, dtype=np.uint64)
+        columns.append(words.astype('=u{}'.format(size)).view(dtype[name]))
+    if pos != len(payload):
+        raise ValueError('invalid chunk of a compressed dump file')
+    return columns
+
+
+def _iter_compressed_columns(filename, schema):
+    dtype = record_dtype(schema)
+    with open(filename, 'rb') as f:
+        layout = _read_compressed_header(f, schema, filename)
+        while True:
+            header = f.read(COMPRESSED_CHUNK_HEADER.size)
+            if len(header) < COMPRESSED_CHUNK_HEADER.size:
+                return
+            n_records, _, payload_size = COMPRESSED_CHUNK_HEADER.unpack(header)
+            payload = f.read(payload_size)
+            if len(payload) < payload_size:
+                return  # last chunk of a file still being written
+            if n_records > 0:
+                yield _decode_chunk(np.frombuffer(payload, np.uint8), n_records, layout, dtype)
+
+
+def _records(columns, dtype):
+    records = np.empty(len(columns[0]), dtype)
+    for name, column in zip(dtype.names, columns):
+        records[name] = column
+    return records
+
+
+def iter_dump(filename, schema, channels=1, records=65536):
+    """Yields the records of a dump file in arrays of at most the given number
+    of records (of epochs, for the observables). The arrays of plain files are
+    views of a numpy.memmap of the file."""
+    dtype = record_dtype(schema)
+    if not is_compressed(filename):
+        mapped = read_dump(filename, schema, channels)
+        for first in range(0, len(mapped), records):
+            yield mapped[first:first + records]
+        return
+    multiplexed = SCHEMAS[schema].get('multiplexed', False)
+    group = channels if multiplexed else 1
+    pending = np.empty(0, dtype)
+    for columns in _iter_compressed_columns(filename, schema):
+        chunk = _records(columns, dtype)
+        if len(pending) > 0:
+            chunk = np.concatenate((pending, chunk))
+        complete = len(chunk) - len(chunk) % group
+        pending = chunk[complete:]
+        chunk = chunk[:complete].reshape(_shape(schema, complete // group, channels))
+        for first in range(0, len(chunk), records):
+            yield chunk[first:first + records]
+
+
+def read_dump(filename, schema, channels=1):
+    """Records of a dump file, as a structured array with the dtype of schema.
+    A plain file is mapped into memory, not copied (a trailing incomplete
+    record is left out), and a compressed file is decoded."""
+    dtype = record_dtype(schema)
+    if is_compressed(filename):
+        arrays = list(iter_dump(filename, schema, channels))
+        if not arrays:
+            return np.empty(_shape(schema, 0, channels), dtype)
+        return np.concatenate(arrays)
+    group = channels if SCHEMAS[schema].get('multiplexed', False) else 1
+    n = os.path.getsize(filename) // (dtype.itemsize * group)
+    if n == 0:
+        return np.empty(_shape(schema, 0, channels), dtype)
+    return np.memmap(filename, dtype=dtype, mode='r', shape=_shape(schema, n, channels))
+
+
+def _arrow_columns(array):
+    """Contiguous columns of a structured array, named after the fields (and
+    the channels, for the observables)."""
+    names = []
+    columns = []
+    for name in array.dtype.names:
+        if array.ndim == 1:
+            names.append(name)
+            columns.append(np.ascontiguousarray(array[name]))
+        else:
+            for channel in range(array.shape[1]):
+                names.append('{}_ch{}'.format(name, channel))
+                columns.append(np.ascontiguousarray(array[name][:, channel]))
+    return names, columns
+
+
+def iter_record_batches(filename, schema, channels=1, records=65536):
+    """Yields the records of a dump file as pyarrow.RecordBatch. The columns of
+    the compressed files are handed over as they are decoded; those of the
+    plain files are gathered from the interleaved records."""
+    import pyarrow as pa
+    if is_compressed(filename) and not SCHEMAS[schema].get('multiplexed', False):
+        names = record_dtype(schema).names
+        for columns in _iter_compressed_columns(filename, schema):
+            for first in range(0, len(columns[0]), records):
+                yield pa.RecordBatch.from_arrays([pa.array(c[first:first + records]) for c in columns], names=list(names))
+        return
+    for array in iter_dump(filename, schema, channels, records):
+        names, columns = _arrow_columns(array)
+        yield pa.RecordBatch.from_arrays([pa.array(c) for c in columns], names=names)
+
+
+def read_table(filename, schema, channels=1):
+    """Records of a dump file as a pyarrow.Table."""
+    import pyarrow as pa
+    return pa.Table.from_batches(list(iter_record_batches(filename, schema, channels)))
+
+
+def schemas_json():
+    return json.dumps({name: {'version': s['version'],
+                              'writer': s['writer'],
+                              'multiplexed': s.get('multiplexed', False),
+                              'layout': record_layout(name),
+                              'fields': [{'name': n, 'type': t} for n, t in s['fields']]}
+                       for name, s in SCHEMAS.items()}, indent=2)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Prints the number of records and the range of each field of a GNSS-SDR dump file.')
+    parser.add_argument('--schemas', action='store_true', help='print the schemas as JSON and exit')
+    parser.add_argument('-c', '--channels', type=int, default=1, help='channels of the observables dump')
+    parser.add_argument('schema', nargs='?', choices=sorted(SCHEMAS))
+    parser.add_argument('filename', nargs='?')
+    args = parser.parse_args()
+    if args.schemas:
+        print(schemas_json())
+        return 0
+    if args.schema is None or args.filename is None:
+        parser.error('a schema and a dump file are needed')
+
+    n = 0
+    low = {}
+    high = {}
+    for array in iter_dump(args.filename, args.schema, args.channels):
+        n += len(array)
+        for name in array.dtype.names:
+            low[name] = min(low.get(name, array[name].min()), array[name].min())
+            high[name] = max(high.get(name, array[name].max()), array[name].max())
+    print('{}: {} records of the {} schema, version {}{}'.format(
+        args.filename, n, args.schema, SCHEMAS[args.schema]['version'],
+        ' (compressed)' if is_compressed(args.filename) else ''))
+    for name in record_dtype(args.schema).names:
+        if n > 0:
+            print('  {:28} {:>22} {:>22}'.format(name, str(low[name]), str(high[name])))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -53,6 +53,7 @@
 #include <algorithm>
 #include <array>
 #include <fstream>
+#include <future>
 #include <iomanip>
 #include <map>
 #include <set>
@@ -86,9 +87,27 @@ bool file_exist(const char* fileName)
 }
 
 
+// Observation matrices (one row of time, pseudorange, Doppler and carrier phase per epoch) of the rows read,
+// which are released as they are copied
+std::map<int, arma::mat> obs_rows_to_map(std::map<int, std::vector<double>>& obs_rows)
+{
+    std::map<int, arma::mat> obs_map;
+    for (auto& rows : obs_rows)
+        {
+            // the rows are contiguous, so they are the columns of the transpose
+            const arma::mat transposed(rows.second.data(), 4, rows.second.size() / 4);
+            obs_map[rows.first] = transposed.t();
+            std::vector<double>().swap(rows.second);
+        }
+    return obs_map;
+}
+
+
 std::map<int, arma::mat> ReadRinexObs(const std::string& rinex_file, char system, const std::string& signal)
 {
     std::map<int, arma::mat> obs_map;
+    // the rows are appended to vectors, since growing a matrix a row at a time copies it at each epoch
+    std::map<int, std::vector<double>> obs_rows;
     if (not file_exist(rinex_file.c_str()))
         {
             std::cout << "Warning: RINEX Obs file " << rinex_file << " does not exist\n";
@@ -148,73 +167,65 @@ std::map<int, arma::mat> ReadRinexObs(const std::string& rinex_file, char system
 
                             if (pointer != r_base_data.obs.end())
                                 {
-                                    // insert next column
-                                    try
-                                        {
-                                            obs_map.at(prn.id);
-                                        }
-                                    catch (const std::out_of_range& oor)
-                                        {
-                                            obs_map[prn.id] = arma::mat();
-                                        }
-
-                                    arma::mat& obs_mat = obs_map[prn.id];
-                                    obs_mat.insert_rows(obs_mat.n_rows, arma::zeros<arma::mat>(1, 4));
+                                    // insert next row
+                                    std::vector<double>& rows = obs_rows[prn.id];
+                                    rows.resize(rows.size() + 4, 0.0);
+                                    double* obs_row = &rows[rows.size() - 4];
 
                                     if (strcmp("1C\0", signal.c_str()) == 0)
                                         {
-                                            obs_mat.at(obs_mat.n_rows - 1, 0) = sow;
+                                            obs_row[0] = sow;
                                             dataobj = r_base_data.getObs(prn, "C1C", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 1) = dataobj.data;  // C1C P1 (psudorange L1)
+                                            obs_row[1] = dataobj.data;  // C1C P1 (psudorange L1)
                                             dataobj = r_base_data.getObs(prn, "D1C", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 2) = dataobj.data;  // D1C Carrier Doppler
+                                            obs_row[2] = dataobj.data;  // D1C Carrier Doppler
                                             dataobj = r_base_data.getObs(prn, "L1C", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 3) = dataobj.data;  // L1C Carrier Phase
+                                            obs_row[3] = dataobj.data;  // L1C Carrier Phase
                                         }
                                     else if (strcmp("1B\0", signal.c_str()) == 0)
                                         {
-                                            obs_mat.at(obs_mat.n_rows - 1, 0) = sow;
+                                            obs_row[0] = sow;
                                             dataobj = r_base_data.getObs(prn, "C1B", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 1) = dataobj.data;
+                                            obs_row[1] = dataobj.data;
                                             dataobj = r_base_data.getObs(prn, "D1B", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 2) = dataobj.data;
+                                            obs_row[2] = dataobj.data;
                                             dataobj = r_base_data.getObs(prn, "L1B", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 3) = dataobj.data;
+                                            obs_row[3] = dataobj.data;
                                         }
                                     else if (strcmp("2S\0", signal.c_str()) == 0)  // L2M
                                         {
-                                            obs_mat.at(obs_mat.n_rows - 1, 0) = sow;
+                                            obs_row[0] = sow;
                                             dataobj = r_base_data.getObs(prn, "C2S", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 1) = dataobj.data;
+                                            obs_row[1] = dataobj.data;
                                             dataobj = r_base_data.getObs(prn, "D2S", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 2) = dataobj.data;
+                                            obs_row[2] = dataobj.data;
                                             dataobj = r_base_data.getObs(prn, "L2S", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 3) = dataobj.data;
+                                            obs_row[3] = dataobj.data;
                                         }
                                     else if (strcmp("L5\0", signal.c_str()) == 0)
                                         {
-                                            obs_mat.at(obs_mat.n_rows - 1, 0) = sow;
+                                            obs_row[0] = sow;
                                             dataobj = r_base_data.getObs(prn, "C5I", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 1) = dataobj.data;
+                                            obs_row[1] = dataobj.data;
                                             dataobj = r_base_data.getObs(prn, "D5I", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 2) = dataobj.data;
+                                            obs_row[2] = dataobj.data;
                                             dataobj = r_base_data.getObs(prn, "L5I", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 3) = dataobj.data;
+                                            obs_row[3] = dataobj.data;
                                         }
                                     else if (strcmp("5X\0", signal.c_str()) == 0)  // Simulator gives RINEX with E5a+E5b. Doppler and accumulated Carrier phase WILL differ
                                         {
-                                            obs_mat.at(obs_mat.n_rows - 1, 0) = sow;
+                                            obs_row[0] = sow;
                                             dataobj = r_base_data.getObs(prn, "C8I", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 1) = dataobj.data;
+                                            obs_row[1] = dataobj.data;
                                             dataobj = r_base_data.getObs(prn, "D8I", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 2) = dataobj.data;
+                                            obs_row[2] = dataobj.data;
                                             dataobj = r_base_data.getObs(prn, "L8I", r_base_header);
-                                            obs_mat.at(obs_mat.n_rows - 1, 3) = dataobj.data;
+                                            obs_row[3] = dataobj.data;
                                         }
                                     else
                                         {
                                             std::cout << "ReadRinexObs unknown signal requested: " << signal << '\n';
-                                            return obs_map;
+                                            return obs_rows_to_map(obs_rows);
                                         }
                                 }
                         }
@@ -223,19 +234,20 @@ std::map<int, arma::mat> ReadRinexObs(const std::string& rinex_file, char system
     catch (const gpstk::FFStreamError& e)
         {
             std::cout << e;
-            return obs_map;
+            return obs_rows_to_map(obs_rows);
         }
     catch (const gpstk::Exception& e)
         {
             std::cout << e;
-            return obs_map;
+            return obs_rows_to_map(obs_rows);
         }
     catch (const std::exception& e)
         {
             std::cout << "Exception: " << e.what();
             std::cout << "unknown error.  I don't feel so well...\n";
-            return obs_map;
+            return obs_rows_to_map(obs_rows);
         }
+    obs_map = obs_rows_to_map(obs_rows);
     if (obs_map.empty())
         {
             std::cout << "Warning: file "
@@ -1419,10 +1431,10 @@ void RINEX_doublediff_dupli_sat()
 
 void RINEX_doublediff(bool remove_rx_clock_error)
 {
-    // read rinex base observations
-    std::map<int, arma::mat> base_obs = ReadRinexObs(FLAGS_base_rinex_obs, FLAGS_system.c_str()[0], FLAGS_signal);
-    // read rinex receiver-under-test (rover) observations
+    // read rinex base observations, while the receiver-under-test (rover) observations are read
+    std::future<std::map<int, arma::mat>> base_obs_future = std::async(std::launch::async, ReadRinexObs, FLAGS_base_rinex_obs, FLAGS_system.c_str()[0], FLAGS_signal);
     std::map<int, arma::mat> rover_obs = ReadRinexObs(FLAGS_rover_rinex_obs, FLAGS_system.c_str()[0], FLAGS_signal);
+    std::map<int, arma::mat> base_obs = base_obs_future.get();
 
     if (base_obs.empty() or rover_obs.empty())
         {
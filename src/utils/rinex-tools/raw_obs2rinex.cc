@@ -0,0 +1,217 @@
+/*!
+ * \file raw_obs2rinex.cc
+ * \brief Converts the raw observation logs written by the receiver into
+ * RINEX observation and navigation files.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "beidou_dnav_ephemeris.h"
+#include "beidou_dnav_iono.h"
+#include "beidou_dnav_utc_model.h"
+#include "galileo_ephemeris.h"
+#include "galileo_iono.h"
+#include "galileo_utc_model.h"
+#include "glonass_gnav_ephemeris.h"
+#include "glonass_gnav_utc_model.h"
+#include "gps_cnav_ephemeris.h"
+#include "gps_cnav_iono.h"
+#include "gps_cnav_utc_model.h"
+#include "gps_ephemeris.h"
+#include "gps_iono.h"
+#include "gps_utc_model.h"
+#include "raw_obs_log.h"
+#include "rinex_printer.h"
+#include "rtklib_rtkpos.h"
+#include "rtklib_solver.h"
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <string>
+
+#if GFLAGS_OLD_NAMESPACE
+namespace gflags
+{
+using namespace google;
+}
+#endif
+
+DEFINE_string(raw_obs, "", "Raw observation log (.gsob) written by the receiver with PVT.raw_obs_output_enabled=true");
+DEFINE_int32(rinex_version, 0, "RINEX version: 2 or 3 (0: the default of the receiver)");
+DEFINE_string(rinex_output_path, ".", "Folder of the RINEX files");
+DEFINE_string(rinex_name, "-", "Base name of the RINEX files (\"-\": GSDR and the local time)");
+
+
+namespace
+{
+// Stores eph in ephemeris_map, and returns true if it is a new record for
+// the RINEX navigation files, that is, a first one or one with another key
+template <typename T, typename K, typename B>
+bool raw_obs2rinex_update_ephemeris(std::map<int, T>& ephemeris_map, const T& eph, K B::*key)
+{
+    const auto stored = ephemeris_map.find(eph.PRN);
+    const bool new_record = (stored == ephemeris_map.cend() or stored->second.*key != eph.*key);
+    ephemeris_map[eph.PRN] = eph;
+    return new_record;
+}
+
+
+// Updates the navigation data of solver as the PVT block does, and logs the
+// new ephemerides once the headers are written, as the PVT block does
+void raw_obs2rinex_nav_product(const Gnss_Nav_Product& product, uint32_t type_of_rx, Rtklib_Solver& solver, Rinex_Printer& rp)
+{
+    const int rx = static_cast<int>(type_of_rx);
+    switch (product.type())
+        {
+        case NAV_GPS_EPHEMERIS:
+            {
+                const auto eph = product.get<Gps_Ephemeris>();
+                if (raw_obs2rinex_update_ephemeris(solver.gps_ephemeris_map, *eph, &Gps_Ephemeris::toe) and rp.is_rinex_header_written())
+                    {
+                        rp.log_rinex_nav_gps_nav(rx, std::map<int32_t, Gps_Ephemeris>{{eph->PRN, *eph}});
+                    }
+            }
+            break;
+        case NAV_GPS_IONO:
+            solver.gps_iono = *product.get<Gps_Iono>();
+            break;
+        case NAV_GPS_UTC_MODEL:
+            solver.gps_utc_model = *product.get<Gps_Utc_Model>();
+            break;
+        case NAV_GPS_CNAV_EPHEMERIS:
+            {
+                const auto eph = product.get<Gps_CNAV_Ephemeris>();
+                if (raw_obs2rinex_update_ephemeris(solver.gps_cnav_ephemeris_map, *eph, &Gps_CNAV_Ephemeris::toe1) and rp.is_rinex_header_written())
+                    {
+                        rp.log_rinex_nav_gps_cnav(rx, std::map<int32_t, Gps_CNAV_Ephemeris>{{eph->PRN, *eph}});
+                    }
+            }
+            break;
+        case NAV_GPS_CNAV_IONO:
+            solver.gps_cnav_iono = *product.get<Gps_CNAV_Iono>();
+            break;
+        case NAV_GPS_CNAV_UTC_MODEL:
+            solver.gps_cnav_utc_model = *product.get<Gps_CNAV_Utc_Model>();
+            break;
+        case NAV_GALILEO_EPHEMERIS:
+            {
+                const auto eph = product.get<Galileo_Ephemeris>();
+                const auto stored = solver.galileo_ephemeris_map.find(eph->PRN);
+                if (eph->flag_reduced_ced)
+                    {
+                        // used for a first fix only, never written to the RINEX files
+                        if (stored == solver.galileo_ephemeris_map.cend() or stored->second.flag_reduced_ced)
+                            {
+                                solver.galileo_ephemeris_map[eph->PRN] = *eph;
+                            }
+                        break;
+                    }
+                if (raw_obs2rinex_update_ephemeris(solver.galileo_ephemeris_map, *eph, &Galileo_Ephemeris::toe) and rp.is_rinex_header_written())
+                    {
+                        rp.log_rinex_nav_gal_nav(rx, std::map<int32_t, Galileo_Ephemeris>{{eph->PRN, *eph}});
+                    }
+            }
+            break;
+        case NAV_GALILEO_IONO:
+            solver.galileo_iono = *product.get<Galileo_Iono>();
+            break;
+        case NAV_GALILEO_UTC_MODEL:
+            solver.galileo_utc_model = *product.get<Galileo_Utc_Model>();
+            break;
+        case NAV_GLONASS_GNAV_EPHEMERIS:
+            {
+                const auto eph = product.get<Glonass_Gnav_Ephemeris>();
+                if (raw_obs2rinex_update_ephemeris(solver.glonass_gnav_ephemeris_map, *eph, &Glonass_Gnav_Ephemeris::d_t_b) and rp.is_rinex_header_written())
+                    {
+                        rp.log_rinex_nav_glo_gnav(rx, std::map<int32_t, Glonass_Gnav_Ephemeris>{{eph->PRN, *eph}});
+                    }
+            }
+            break;
+        case NAV_GLONASS_GNAV_UTC_MODEL:
+            solver.glonass_gnav_utc_model = *product.get<Glonass_Gnav_Utc_Model>();
+            break;
+        case NAV_BEIDOU_DNAV_EPHEMERIS:
+            {
+                const auto eph = product.get<Beidou_Dnav_Ephemeris>();
+                if (raw_obs2rinex_update_ephemeris(solver.beidou_dnav_ephemeris_map, *eph, &Beidou_Dnav_Ephemeris::toc) and rp.is_rinex_header_written())
+                    {
+                        rp.log_rinex_nav_bds_dnav(rx, std::map<int32_t, Beidou_Dnav_Ephemeris>{{eph->PRN, *eph}});
+                    }
+            }
+            break;
+        case NAV_BEIDOU_DNAV_IONO:
+            solver.beidou_dnav_iono = *product.get<Beidou_Dnav_Iono>();
+            break;
+        case NAV_BEIDOU_DNAV_UTC_MODEL:
+            solver.beidou_dnav_utc_model = *product.get<Beidou_Dnav_Utc_Model>();
+            break;
+        default:
+            break;
+        }
+}
+}  // namespace
+
+
+int main(int argc, char** argv)
+{
+    const std::string intro_help(
+        std::string("\n raw_obs2rinex converts the raw observation log written by GNSS-SDR into RINEX observation\n") +
+        "and navigation files, as the receiver would have written them.\n" +
+        "Usage: raw_obs2rinex --raw_obs=<file.gsob> [--rinex_version=<2|3>] [--rinex_output_path=<folder>] [--rinex_name=<name>]\n" +
+        "Copyright (C) 2010-2022 (see AUTHORS file for a list of contributors)\n" +
+        "This program comes with ABSOLUTELY NO WARRANTY;\n" +
+        "See COPYING file to see a copy of the General Public License\n \n");
+
+    gflags::SetUsageMessage(intro_help);
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+    google::InitGoogleLogging(argv[0]);
+
+    if (FLAGS_raw_obs.empty())
+        {
+            std::cerr << "Usage: raw_obs2rinex --raw_obs=<file.gsob>\n";
+            gflags::ShutDownCommandLineFlags();
+            return 1;
+        }
+
+    // the solver only carries the navigation data for the printer
+    prcopt_t rtklib_configuration_options{};
+    rtklib_configuration_options.mode = PMODE_SINGLE;
+    rtklib_configuration_options.nf = 1;
+    rtk_t rtk{};
+    rtkinit(&rtk, &rtklib_configuration_options);
+    Rtklib_Solver solver(rtk, "raw_obs2rinex", false, false);
+    Rinex_Printer rp(FLAGS_rinex_version, FLAGS_rinex_output_path, FLAGS_rinex_name);
+
+    uint64_t epochs = 0;
+    uint32_t type_of_rx = 0;
+    const bool ok = Raw_Obs_Log::read(
+        FLAGS_raw_obs, type_of_rx,
+        [&](double rx_time, const std::map<int, Gnss_Synchro>& observables) {
+            rp.print_rinex_annotation(&solver, observables, rx_time, static_cast<int>(type_of_rx), true);
+            epochs++;
+        },
+        [&](const Gnss_Nav_Product& product) {
+            raw_obs2rinex_nav_product(product, type_of_rx, solver, rp);
+        });
+    if (!ok)
+        {
+            std::cerr << "Cannot read the raw observation log " << FLAGS_raw_obs << '\n';
+            gflags::ShutDownCommandLineFlags();
+            return 1;
+        }
+    std::cout << epochs << " epochs of " << FLAGS_raw_obs << " converted to RINEX"
+              << (rp.is_rinex_header_written() ? "" : ", but no RINEX file written: no ephemeris logged") << '\n';
+
+    gflags::ShutDownCommandLineFlags();
+    return 0;
+}
@@ -19,10 +19,10 @@
 #include "galileo_ephemeris.h"  // IWYU pragma: keep
 #include "galileo_iono.h"
 #include "galileo_utc_model.h"
+#include "gnss_nav_data_store.h"
 #include "gps_ephemeris.h"
 #include "gps_iono.h"
 #include "gps_utc_model.h"
-#include <boost/archive/xml_oarchive.hpp>
 #include <boost/iostreams/copy.hpp>
 #include <boost/iostreams/filter/gzip.hpp>
 #include <boost/iostreams/filtering_streambuf.hpp>
@@ -33,7 +33,11 @@
 #include <gpstk/Rinex3NavStream.hpp>
 #include <cstddef>  // for size_t
 #include <cstdlib>
+#include <future>
 #include <iostream>
+#include <map>
+#include <string>
+#include <vector>
 
 #if GFLAGS_OLD_NAMESPACE
 namespace gflags
@@ -42,34 +46,30 @@ using namespace google;
 }
 #endif
 
-int main(int argc, char** argv)
+DEFINE_bool(binary, false, "Write versioned binary files (.bin) instead of XML files. They are smaller and read much faster by the receiver, but only on machines with the same endianness and type sizes as this one");
+
+namespace
 {
-    const std::string intro_help(
-        std::string("\n rinex2assist converts navigation RINEX files into XML files for Assisted GNSS\n") +
-        "Copyright (C) 2018 (see AUTHORS file for a list of contributors)\n" +
-        "This program comes with ABSOLUTELY NO WARRANTY;\n" +
-        "See COPYING file to see a copy of the General Public License.\n \n" +
-        "Usage: \n" +
-        "   rinex2assist <RINEX Nav file input>");
+// Navigation data and models of a RINEX navigation file
+struct Rinex_Nav_Contents
+{
+    std::vector<Gps_Ephemeris> gps_ephemeris;
+    std::vector<Galileo_Ephemeris> gal_ephemeris;
+    Gps_Utc_Model gps_utc_model;
+    Gps_Iono gps_iono;
+    Galileo_Utc_Model gal_utc_model;
+    Galileo_Iono gal_iono;
+    bool gps_header{false};  // the models above come from the header
+    bool gal_header{false};
+    std::string error;  // empty if the file was read
+};
 
-    gflags::SetUsageMessage(intro_help);
-    google::SetVersionString("1.0");
-    gflags::ParseCommandLineFlags(&argc, &argv, true);
-
-    if ((argc != 2))
-        {
-            std::cerr << "Usage:\n";
-            std::cerr << "   " << argv[0]
-                      << " <RINEX Nav file input>"
-                      << '\n';
-            gflags::ShutDownCommandLineFlags();
-            return 1;
-        }
-    std::string xml_filename;
 
+// Uncompresses the RINEX file if it is gzipped or compressed, and sets the name of the file to read
+bool uncompress_rinex(const std::string& rinex_filename, std::string& input_filename)
+{
     // Uncompress if RINEX file is gzipped
-    std::string rinex_filename(argv[1]);
-    std::string input_filename = rinex_filename;
+    input_filename = rinex_filename;
     std::size_t found = rinex_filename.find_last_of('.');
     if (found != std::string::npos)
         {
@@ -81,7 +81,7 @@ int main(int argc, char** argv)
                             if (file.fail())
                                 {
                                     std::cerr << "Could not open file " << rinex_filename << '\n';
-                                    return 1;
+                                    return false;
                                 }
                             boost::iostreams::filtering_streambuf<boost::iostreams::input> in;
                             try
@@ -91,7 +91,7 @@ int main(int argc, char** argv)
                             catch (const boost::exception& e)
                                 {
                                     std::cerr << "Could not decompress file " << rinex_filename << '\n';
-                                    return 1;
+                                    return false;
                                 }
                             in.push(file);
                             std::string rinex_filename_unzipped = rinex_filename.substr(0, found);
@@ -99,7 +99,7 @@ int main(int argc, char** argv)
                             if (file.fail())
                                 {
                                     std::cerr << "Could not create file " << rinex_filename_unzipped << '\n';
-                                    return 1;
+                                    return false;
                                 }
                             boost::iostreams::copy(in, output_file);
                             input_filename = rinex_filename_unzipped;
@@ -113,7 +113,7 @@ int main(int argc, char** argv)
                             if (file.fail())
                                 {
                                     std::cerr << "Could not open file" << rinex_filename << '\n';
-                                    return 1;
+                                    return false;
                                 }
                             file.close();
                             std::string uncompress_executable(UNCOMPRESS_EXECUTABLE);
@@ -130,32 +130,28 @@ int main(int argc, char** argv)
                                     if ((s1 != 0) or (s2 != 0) or (s3 != 0))
                                         {
                                             std::cerr << "Failure uncompressing file.\n";
-                                            return 1;
+                                            return false;
                                         }
                                 }
                             else
                                 {
                                     std::cerr << "uncompress program not found.\n";
-                                    return 1;
+                                    return false;
                                 }
                         }
                 }
         }
+    return true;
+}
 
-    std::map<int, Gps_Ephemeris> eph_map;
-    std::map<int, Galileo_Ephemeris> eph_gal_map;
-
-    Gps_Utc_Model gps_utc_model;
-    Gps_Iono gps_iono;
-    Galileo_Utc_Model gal_utc_model;
-    Galileo_Iono gal_iono;
 
-    int i = 0;
-    int j = 0;
+Rinex_Nav_Contents read_rinex_nav(const std::string& filename)
+{
+    Rinex_Nav_Contents contents;
     try
         {
             // Read nav file
-            gpstk::Rinex3NavStream rnffs(input_filename.c_str());  // Open navigation data file
+            gpstk::Rinex3NavStream rnffs(filename.c_str());  // Open navigation data file
             gpstk::Rinex3NavData rne;
             gpstk::Rinex3NavHeader hdr;
 
@@ -165,56 +161,57 @@ int main(int argc, char** argv)
             // Check that it really is a RINEX navigation file
             if (hdr.fileType.substr(0, 1) != "N")
                 {
-                    std::cerr << "This is not a valid RINEX navigation file, or file not found.\n";
-                    std::cerr << "No XML file will be created.\n";
-                    return 1;
+                    contents.error = "This is not a valid RINEX navigation file, or file not found.";
+                    return contents;
                 }
 
             // Collect UTC parameters from RINEX header
             if (hdr.fileSys == "G: (GPS)" || hdr.fileSys == "MIXED")
                 {
-                    gps_utc_model.valid = (hdr.valid > 2147483648) ? true : false;
-                    gps_utc_model.A1 = hdr.mapTimeCorr["GPUT"].A0;
-                    gps_utc_model.A0 = hdr.mapTimeCorr["GPUT"].A1;
-                    gps_utc_model.tot = hdr.mapTimeCorr["GPUT"].refSOW;
-                    gps_utc_model.WN_T = hdr.mapTimeCorr["GPUT"].refWeek;
-                    gps_utc_model.DeltaT_LS = hdr.leapSeconds;
-                    gps_utc_model.WN_LSF = hdr.leapWeek;
-                    gps_utc_model.DN = hdr.leapDay;
-                    gps_utc_model.DeltaT_LSF = hdr.leapDelta;
+                    contents.gps_header = true;
+                    contents.gps_utc_model.valid = (hdr.valid > 2147483648) ? true : false;
+                    contents.gps_utc_model.A1 = hdr.mapTimeCorr["GPUT"].A0;
+                    contents.gps_utc_model.A0 = hdr.mapTimeCorr["GPUT"].A1;
+                    contents.gps_utc_model.tot = hdr.mapTimeCorr["GPUT"].refSOW;
+                    contents.gps_utc_model.WN_T = hdr.mapTimeCorr["GPUT"].refWeek;
+                    contents.gps_utc_model.DeltaT_LS = hdr.leapSeconds;
+                    contents.gps_utc_model.WN_LSF = hdr.leapWeek;
+                    contents.gps_utc_model.DN = hdr.leapDay;
+                    contents.gps_utc_model.DeltaT_LSF = hdr.leapDelta;
 
                     // Collect iono parameters from RINEX header
-                    gps_iono.valid = (hdr.mapIonoCorr["GPSA"].param[0] == 0) ? false : true;
-                    gps_iono.alpha0 = hdr.mapIonoCorr["GPSA"].param[0];
-                    gps_iono.alpha1 = hdr.mapIonoCorr["GPSA"].param[1];
-                    gps_iono.alpha2 = hdr.mapIonoCorr["GPSA"].param[2];
-                    gps_iono.alpha3 = hdr.mapIonoCorr["GPSA"].param[3];
-                    gps_iono.beta0 = hdr.mapIonoCorr["GPSB"].param[0];
-                    gps_iono.beta1 = hdr.mapIonoCorr["GPSB"].param[1];
-                    gps_iono.beta2 = hdr.mapIonoCorr["GPSB"].param[2];
-                    gps_iono.beta3 = hdr.mapIonoCorr["GPSB"].param[3];
+                    contents.gps_iono.valid = (hdr.mapIonoCorr["GPSA"].param[0] == 0) ? false : true;
+                    contents.gps_iono.alpha0 = hdr.mapIonoCorr["GPSA"].param[0];
+                    contents.gps_iono.alpha1 = hdr.mapIonoCorr["GPSA"].param[1];
+                    contents.gps_iono.alpha2 = hdr.mapIonoCorr["GPSA"].param[2];
+                    contents.gps_iono.alpha3 = hdr.mapIonoCorr["GPSA"].param[3];
+                    contents.gps_iono.beta0 = hdr.mapIonoCorr["GPSB"].param[0];
+                    contents.gps_iono.beta1 = hdr.mapIonoCorr["GPSB"].param[1];
+                    contents.gps_iono.beta2 = hdr.mapIonoCorr["GPSB"].param[2];
+                    contents.gps_iono.beta3 = hdr.mapIonoCorr["GPSB"].param[3];
                 }
             if (hdr.fileSys == "E: (GAL)" || hdr.fileSys == "MIXED")
                 {
-                    gal_utc_model.A0 = hdr.mapTimeCorr["GAUT"].A0;
-                    gal_utc_model.A1 = hdr.mapTimeCorr["GAUT"].A1;
-                    gal_utc_model.Delta_tLS = hdr.leapSeconds;
-                    gal_utc_model.tot = hdr.mapTimeCorr["GAUT"].refSOW;
-                    gal_utc_model.WNot = hdr.mapTimeCorr["GAUT"].refWeek;
-                    gal_utc_model.WN_LSF = hdr.leapWeek;
-                    gal_utc_model.DN = hdr.leapDay;
-                    gal_utc_model.Delta_tLSF = hdr.leapDelta;
-                    gal_utc_model.flag_utc_model = (hdr.mapTimeCorr["GAUT"].A0 == 0.0);
-                    gal_iono.ai0 = hdr.mapIonoCorr["GAL"].param[0];
-                    gal_iono.ai1 = hdr.mapIonoCorr["GAL"].param[1];
-                    gal_iono.ai2 = hdr.mapIonoCorr["GAL"].param[2];
-                    gal_iono.Region1_flag = false;
-                    gal_iono.Region2_flag = false;
-                    gal_iono.Region3_flag = false;
-                    gal_iono.Region4_flag = false;
-                    gal_iono.Region5_flag = false;
-                    gal_iono.tow = 0.0;
-                    gal_iono.WN = 0.0;
+                    contents.gal_header = true;
+                    contents.gal_utc_model.A0 = hdr.mapTimeCorr["GAUT"].A0;
+                    contents.gal_utc_model.A1 = hdr.mapTimeCorr["GAUT"].A1;
+                    contents.gal_utc_model.Delta_tLS = hdr.leapSeconds;
+                    contents.gal_utc_model.tot = hdr.mapTimeCorr["GAUT"].refSOW;
+                    contents.gal_utc_model.WNot = hdr.mapTimeCorr["GAUT"].refWeek;
+                    contents.gal_utc_model.WN_LSF = hdr.leapWeek;
+                    contents.gal_utc_model.DN = hdr.leapDay;
+                    contents.gal_utc_model.Delta_tLSF = hdr.leapDelta;
+                    contents.gal_utc_model.flag_utc_model = (hdr.mapTimeCorr["GAUT"].A0 == 0.0);
+                    contents.gal_iono.ai0 = hdr.mapIonoCorr["GAL"].param[0];
+                    contents.gal_iono.ai1 = hdr.mapIonoCorr["GAL"].param[1];
+                    contents.gal_iono.ai2 = hdr.mapIonoCorr["GAL"].param[2];
+                    contents.gal_iono.Region1_flag = false;
+                    contents.gal_iono.Region2_flag = false;
+                    contents.gal_iono.Region3_flag = false;
+                    contents.gal_iono.Region4_flag = false;
+                    contents.gal_iono.Region5_flag = false;
+                    contents.gal_iono.tow = 0.0;
+                    contents.gal_iono.WN = 0.0;
                 }
 
             // Read navigation data
@@ -262,8 +259,7 @@ int main(int argc, char** argv)
                             eph.integrity_status_flag = false;  //
                             eph.alert_flag = false;             //
                             eph.antispoofing_flag = false;      //
-                            eph_map[i] = eph;
-                            i++;
+                            contents.gps_ephemeris.push_back(eph);
                         }
                     if (rne.satSys == "E")
                         {
@@ -291,143 +287,168 @@ int main(int argc, char** argv)
                             eph.af1 = rne.af1;
                             eph.af2 = rne.af2;
                             eph.WN = rne.weeknum;
-                            eph_gal_map[j] = eph;
-                            j++;
+                            contents.gal_ephemeris.push_back(eph);
                         }
                 }
         }
     catch (std::exception& e)
         {
-            std::cerr << "Error reading the RINEX file: " << e.what() << '\n';
-            std::cerr << "No XML file will be created.\n";
-            gflags::ShutDownCommandLineFlags();
-            return 1;
+            contents.error = std::string("Error reading the RINEX file: ") + e.what();
         }
+    return contents;
+}
 
-    if (i == 0 and j == 0)
+
+// Writes an XML file, or a versioned binary one with --binary
+template <typename T>
+bool save_assistance(const std::string& basename, const char* name, const T& object)
+{
+    const std::string filename = basename + (FLAGS_binary ? ".bin" : ".xml");
+    if (!Gnss_Nav_Data_Store::save_file(filename, name, object, FLAGS_binary))
         {
-            std::cerr << "No navigation data found in the RINEX file. No XML file will be created.\n";
+            std::cerr << "Problem creating the file " << filename << '\n';
+            return false;
+        }
+    std::cout << "Generated file: " << filename << '\n';
+    return true;
+}
+}  // namespace
+
+
+int main(int argc, char** argv)
+{
+    const std::string intro_help(
+        std::string("\n rinex2assist converts navigation RINEX files into XML files for Assisted GNSS\n") +
+        "Copyright (C) 2018 (see AUTHORS file for a list of contributors)\n" +
+        "This program comes with ABSOLUTELY NO WARRANTY;\n" +
+        "See COPYING file to see a copy of the General Public License.\n \n" +
+        "Usage: \n" +
+        "   rinex2assist <RINEX Nav file input> [<RINEX Nav file input> ...]");
+
+    gflags::SetUsageMessage(intro_help);
+    google::SetVersionString("1.0");
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+    if ((argc < 2))
+        {
+            std::cerr << "Usage:\n";
+            std::cerr << "   " << argv[0]
+                      << " <RINEX Nav file input> [<RINEX Nav file input> ...]"
+                      << '\n';
             gflags::ShutDownCommandLineFlags();
             return 1;
         }
 
-    // Write XML ephemeris
-    if (i != 0)
+    std::vector<std::string> input_filenames;
+    for (int arg = 1; arg < argc; arg++)
         {
-            std::ofstream ofs;
-            if (xml_filename.empty())
-                {
-                    xml_filename = "gps_ephemeris.xml";
-                }
-            try
+            std::string input_filename;
+            if (!uncompress_rinex(std::string(argv[arg]), input_filename))
                 {
-                    ofs.open(xml_filename.c_str(), std::ofstream::trunc | std::ofstream::out);
-                    boost::archive::xml_oarchive xml(ofs);
-                    xml << boost::serialization::make_nvp("GNSS-SDR_ephemeris_map", eph_map);
-                }
-            catch (std::exception& e)
-                {
-                    std::cerr << "Problem creating the XML file " << xml_filename << ": " << e.what() << '\n';
                     gflags::ShutDownCommandLineFlags();
                     return 1;
                 }
-            std::cout << "Generated file: " << xml_filename << '\n';
+            input_filenames.push_back(input_filename);
         }
-    if (j != 0)
+
+    // The files are parsed in parallel, and their contents merged in the order they were given
+    std::vector<std::future<Rinex_Nav_Contents>> readers;
+    for (const auto& input_filename : input_filenames)
+        {
+            readers.push_back(std::async(std::launch::async, read_rinex_nav, input_filename));
+        }
+
+    std::map<int, Gps_Ephemeris> eph_map;
+    std::map<int, Galileo_Ephemeris> eph_gal_map;
+
+    Gps_Utc_Model gps_utc_model;
+    Gps_Iono gps_iono;
+    Galileo_Utc_Model gal_utc_model;
+    Galileo_Iono gal_iono;
+    bool gps_header = false;
+    bool gal_header = false;
+
+    int i = 0;
+    int j = 0;
+    bool read_error = false;
+    for (std::size_t file = 0; file < readers.size(); file++)
         {
-            std::ofstream ofs2;
-            xml_filename = "gal_ephemeris.xml";
-            try
+            const Rinex_Nav_Contents contents = readers[file].get();
+            if (!contents.error.empty())
                 {
-                    ofs2.open(xml_filename.c_str(), std::ofstream::trunc | std::ofstream::out);
-                    boost::archive::xml_oarchive xml(ofs2);
-                    xml << boost::serialization::make_nvp("GNSS-SDR_gal_ephemeris_map", eph_gal_map);
+                    std::cerr << input_filenames[file] << ": " << contents.error << '\n';
+                    read_error = true;
+                    continue;
                 }
-            catch (std::exception& e)
+            for (const auto& eph : contents.gps_ephemeris)
                 {
-                    std::cerr << "Problem creating the XML file " << xml_filename << ": " << e.what() << '\n';
-                    gflags::ShutDownCommandLineFlags();
-                    return 1;
+                    eph_map[i] = eph;
+                    i++;
                 }
-            std::cout << "Generated file: " << xml_filename << '\n';
-        }
-
-    // Write XML UTC
-    if (gps_utc_model.valid)
-        {
-            std::ofstream ofs3;
-            xml_filename = "gps_utc_model.xml";
-            try
+            for (const auto& eph : contents.gal_ephemeris)
                 {
-                    ofs3.open(xml_filename.c_str(), std::ofstream::trunc | std::ofstream::out);
-                    boost::archive::xml_oarchive xml(ofs3);
-                    xml << boost::serialization::make_nvp("GNSS-SDR_utc_model", gps_utc_model);
+                    eph_gal_map[j] = eph;
+                    j++;
                 }
-            catch (std::exception& e)
+            // the models of the first file that has them
+            if (contents.gps_header and !gps_header)
                 {
-                    std::cerr << "Problem creating the XML file " << xml_filename << ": " << e.what() << '\n';
-                    gflags::ShutDownCommandLineFlags();
-                    return 1;
+                    gps_utc_model = contents.gps_utc_model;
+                    gps_iono = contents.gps_iono;
+                    gps_header = true;
+                }
+            if (contents.gal_header and !gal_header)
+                {
+                    gal_utc_model = contents.gal_utc_model;
+                    gal_iono = contents.gal_iono;
+                    gal_header = true;
                 }
-            std::cout << "Generated file: " << xml_filename << '\n';
+        }
+    if (read_error)
+        {
+            std::cerr << "No XML file will be created.\n";
+            gflags::ShutDownCommandLineFlags();
+            return 1;
+        }
+
+    if (i == 0 and j == 0)
+        {
+            std::cerr << "No navigation data found in the RINEX file. No XML file will be created.\n";
+            gflags::ShutDownCommandLineFlags();
+            return 1;
+        }
+
+    bool saved = true;
+    // Write XML ephemeris
+    if (i != 0)
+        {
+            saved = saved and save_assistance("gps_ephemeris", "GNSS-SDR_ephemeris_map", eph_map);
+        }
+    if (j != 0)
+        {
+            saved = saved and save_assistance("gal_ephemeris", "GNSS-SDR_gal_ephemeris_map", eph_gal_map);
+        }
+
+    // Write XML UTC
+    if (saved and gps_utc_model.valid)
+        {
+            saved = save_assistance("gps_utc_model", "GNSS-SDR_utc_model", gps_utc_model);
         }
 
     // Write XML iono
-    if (gps_iono.valid)
+    if (saved and gps_iono.valid)
         {
-            std::ofstream ofs4;
-            xml_filename = "gps_iono.xml";
-            try
-                {
-                    ofs4.open(xml_filename.c_str(), std::ofstream::trunc | std::ofstream::out);
-                    boost::archive::xml_oarchive xml(ofs4);
-                    xml << boost::serialization::make_nvp("GNSS-SDR_iono_model", gps_iono);
-                }
-            catch (std::exception& e)
-                {
-                    std::cerr << "Problem creating the XML file " << xml_filename << ": " << e.what() << '\n';
-                    gflags::ShutDownCommandLineFlags();
-                    return 1;
-                }
-            std::cout << "Generated file: " << xml_filename << '\n';
+            saved = save_assistance("gps_iono", "GNSS-SDR_iono_model", gps_iono);
         }
 
-    if (gal_utc_model.A0 != 0)
+    if (saved and gal_utc_model.A0 != 0)
         {
-            std::ofstream ofs5;
-            xml_filename = "gal_utc_model.xml";
-            try
-                {
-                    ofs5.open(xml_filename.c_str(), std::ofstream::trunc | std::ofstream::out);
-                    boost::archive::xml_oarchive xml(ofs5);
-                    xml << boost::serialization::make_nvp("GNSS-SDR_gal_utc_model", gal_utc_model);
-                }
-            catch (std::exception& e)
-                {
-                    std::cerr << "Problem creating the XML file " << xml_filename << ": " << e.what() << '\n';
-                    gflags::ShutDownCommandLineFlags();
-                    return 1;
-                }
-            std::cout << "Generated file: " << xml_filename << '\n';
+            saved = save_assistance("gal_utc_model", "GNSS-SDR_gal_utc_model", gal_utc_model);
         }
-    if (gal_iono.ai0 != 0)
+    if (saved and gal_iono.ai0 != 0)
         {
-            std::ofstream ofs7;
-            xml_filename = "gal_iono.xml";
-            try
-                {
-                    ofs7.open(xml_filename.c_str(), std::ofstream::trunc | std::ofstream::out);
-                    boost::archive::xml_oarchive xml(ofs7);
-                    xml << boost::serialization::make_nvp("GNSS-SDR_gal_iono_model", gal_iono);
-                }
-            catch (std::exception& e)
-                {
-                    std::cerr << "Problem creating the XML file " << xml_filename << ": " << e.what() << '\n';
-                    gflags::ShutDownCommandLineFlags();
-                    return 1;
-                }
-            std::cout << "Generated file: " << xml_filename << '\n';
+            saved = save_assistance("gal_iono", "GNSS-SDR_gal_iono_model", gal_iono);
         }
     gflags::ShutDownCommandLineFlags();
-    return 0;
+    return saved ? 0 : 1;
 }
@@ -0,0 +1,121 @@
+#!/usr/bin/env python3
+#
+# GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+# This file is part of GNSS-SDR.
+#
+# Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+# SPDX-License-Identifier: GPL-3.0-or-later
+
+"""Compares benchmark results against a baseline and reports the regressions.
+
+It reads the JSON files written by
+  volk_gnsssdr_profile -b -V 1024,8111,65536 -j volk_gnsssdr.json
+(one time per kernel, implementation and vector length) and by the benchmarks
+of src/tests/benchmarks run with
+  ./benchmark_copy --benchmark_out=benchmark_copy.json --benchmark_out_format=json
+(one time per benchmark and arguments). Each argument can also be a folder,
+and then the files with the same name in both folders are compared.
+
+The script exits with 1 if any result is slower than the baseline by more than
+the threshold, so it can be used to stop a CI job.
+
+usage: gnss-sdr-benchmark-compare.py [-t threshold_percent] baseline current
+"""
+
+import argparse
+import json
+import os
+import statistics
+import sys
+
+
+def read_volk_gnsssdr(data):
+    """Time of a call of each kernel implementation, in ms."""
+    times = {}
+    for test in data['volk_gnsssdr_tests']:
+        iterations = max(test['iter'], 1)
+        for arch, result in test['results'].items():
+            key = '{}/{}/vlen:{}'.format(test['name'], arch, test['vlen'])
+            times[key] = result['time'] / iterations
+    return data.get('machine', ''), times
+
+
+def read_google_benchmark(data):
+    """CPU time of each benchmark, in ns. The median of the repetitions is used."""
+    scale = {'ns': 1.0, 'us': 1e3, 'ms': 1e6, 's': 1e9}
+    runs = {}
+    medians = {}
+    for benchmark in data['benchmarks']:
+        cpu_time = benchmark['cpu_time'] * scale[benchmark.get('time_unit', 'ns')]
+        if benchmark.get('run_type') == 'aggregate':
+            if benchmark.get('aggregate_name') == 'median':
+                medians[benchmark['run_name']] = cpu_time
+        else:
+            runs.setdefault(benchmark.get('run_name', benchmark['name']), []).append(cpu_time)
+    times = {name: statistics.median(values) for name, values in runs.items()}
+    times.update(medians)
+    return data.get('context', {}).get('host_name', ''), times
+
+
+def read_results(filename):
+    with open(filename) as json_file:
+        data = json.load(json_file)
+    if 'volk_gnsssdr_tests' in data:
+        return read_volk_gnsssdr(data)
+    if 'benchmarks' in data:
+        return read_google_benchmark(data)
+    raise ValueError('{}: unknown benchmark format'.format(filename))
+
+
+def compare(baseline_file, current_file, threshold):
+    """Prints the changes beyond the threshold, and returns the number of regressions."""
+    baseline_machine, baseline = read_results(baseline_file)
+    current_machine, current = read_results(current_file)
+    if baseline_machine != current_machine:
+        print('Warning: {} was measured on {} and {} on {}'.format(
+            baseline_file, baseline_machine, current_file, current_machine))
+
+    regressions = 0
+    for key in sorted(set(baseline) & set(current)):
+        if baseline[key] <= 0.0:
+            continue
+        change = 100.0 * (current[key] - baseline[key]) / baseline[key]
+        if change > threshold:
+            print('REGRESSION {:+7.1f}%  {}'.format(change, key))
+            regressions += 1
+        elif change < -threshold:
+            print('improvement {:+6.1f}%  {}'.format(change, key))
+    for key in sorted(set(baseline) - set(current)):
+        print('missing            {}'.format(key))
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('-t', '--threshold', type=float, default=10.0,
+                        help='slowdown, in percent, reported as a regression (default: 10)')
+    parser.add_argument('baseline', help='JSON file or folder with the baseline results')
+    parser.add_argument('current', help='JSON file or folder with the new results')
+    args = parser.parse_args()
+
+    if os.path.isdir(args.baseline):
+        pairs = [(os.path.join(args.baseline, name), os.path.join(args.current, name))
+                 for name in sorted(os.listdir(args.baseline)) if name.endswith('.json')]
+    else:
+        pairs = [(args.baseline, args.current)]
+
+    regressions = 0
+    for baseline_file, current_file in pairs:
+        if not os.path.exists(current_file):
+            print('missing            {}'.format(current_file))
+            continue
+        print('{} vs {}'.format(current_file, baseline_file))
+        regressions += compare(baseline_file, current_file, args.threshold)
+
+    print('{} regressions above {}%'.format(regressions, args.threshold))
+    return 1 if regressions > 0 else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,200 @@
+#!/bin/sh
+# GNSS-SDR shell script that measures the end-to-end throughput of the receiver
+# on recorded signals, for a list of configurations (for instance, L1 only,
+# multi-band and multi-constellation), and writes the results in JSON.
+#
+# usage: ./gnss-sdr-benchmark.sh [-d duration_s] [-r signal_source_role]
+#            [-p sample_period_s] ./gnss-sdr output_dir config_file.conf
+#            [config_file.conf ...]
+#
+#  -d  seconds of signal processed in each run (default: 30). The recording is
+#      repeated if it is shorter
+#  -r  role of the signal source in the config files (default: SignalSource)
+#  -p  period of the samples of the CPU time of the receiver threads
+#      (default: 1)
+#
+# Each config_file must read a file (File_Signal_Source,
+# Replica_File_Signal_Source, ...), which is replayed without throttling. The
+# run of each config_file is written to output_dir/<name of config_file>, and
+# the results of all the runs to output_dir/benchmark.json:
+#  - real_time_factor: signal duration / processing time. Above 1, the run is
+#    faster than real time
+#  - max_channels_real_time: channels of the run times real_time_factor, an
+#    estimate that assumes that the load grows with the number of channels. Use
+#    gnss-sdr-scaling.sh to measure it
+#  - peak_rss_kb: peak resident memory of the receiver
+#  - stages: share of the CPU time of the receiver spent in each thread name.
+#    GNU Radio names the thread of each block after the block, so these are the
+#    processing stages; the numbers that end the names are dropped to add up
+#    the instances of a block. Threads ending less than sample_period_s after
+#    their last sample are counted up to that sample
+#
+# The processing times and the peak memory are measured by GNU time
+# (/usr/bin/time, or the path given in the GNU_TIME environment variable), and
+# the threads are read from /proc, so this script only runs on Linux.
+
+# SPDX-FileCopyrightText: 2022 (see AUTHORS file for a list of contributors)
+# SPDX-License-Identifier: GPL-3.0-or-later
+
+duration=30
+role=SignalSource
+period=1
+
+while getopts "d:r:p:" option
+do
+    case $option in
+        d) duration=$OPTARG ;;
+        r) role=$OPTARG ;;
+        p) period=$OPTARG ;;
+        *) echo "Unknown option"; exit 1 ;;
+    esac
+done
+shift $((OPTIND - 1))
+
+if [ $# -lt 3 ]
+then
+    echo "usage: $0 [-d duration_s] [-r signal_source_role] [-p sample_period_s] ./gnss-sdr output_dir config_file.conf [config_file.conf ...]"
+    exit 1
+fi
+
+gnss_sdr=$1
+output=$2
+shift 2
+
+gnu_time=${GNU_TIME:-/usr/bin/time}
+if [ ! -x "$gnu_time" ]
+then
+    echo "GNU time ($gnu_time, or the path in GNU_TIME) is required"
+    exit 1
+fi
+
+# last value of a property in the configuration file given as $1
+property() {
+    sed -n "s/^[[:space:]]*$2[[:space:]]*=[[:space:]]*\([^;#[:space:]]*\).*/\1/p" "$1" | tail -n 1
+}
+
+mkdir -p "$output" || exit 1
+results="$output/benchmark.json"
+{
+    echo "{"
+    echo "  \"machine\": \"$(uname -m)\","
+    echo "  \"cpus\": $(nproc),"
+    echo "  \"signal_duration_s\": $duration,"
+    echo "  \"runs\": ["
+} > "$results"
+
+separator=""
+for config in "$@"
+do
+    name=$(basename "$config" .conf)
+    dir="$output/$name"
+    mkdir -p "$dir"
+
+    fs=$(property "$config" "$role.sampling_frequency")
+    if [ -z "$fs" ]
+    then
+        echo "$role.sampling_frequency is not set in $config, skipping it"
+        continue
+    fi
+    # the number of samples of interleaved I/Q files counts both components
+    items_per_sample=1
+    case $(property "$config" "$role.item_type") in
+        ishort | ibyte) items_per_sample=2 ;;
+    esac
+    samples=$(awk -v d="$duration" -v fs="$fs" -v m=$items_per_sample 'BEGIN { printf "%.0f", d * fs * m }')
+
+    channels=0
+    for s in 1C 2S L5 1B 5X 7X E6 1G 2G B1 B3
+    do
+        count=$(property "$config" "Channels_$s.count")
+        channels=$((channels + ${count:-0}))
+    done
+
+    # The overrides are appended to a copy of config_file, since the last
+    # value of a property is the one used
+    {
+        cat "$config"
+        echo ""
+        echo "[GNSS-SDR]"
+        echo "$role.samples=$samples"
+        echo "$role.repeat=true"
+        echo "$role.enable_throttle_control=false"
+        echo "PVT.output_path=$dir"
+        echo "PVT.rinex_output_path=$dir"
+    } > "$dir/benchmark.conf"
+
+    echo "Processing $duration s of signal with $config..."
+    : > "$dir/threads.txt"
+    "$gnu_time" -f "%e %U %S %M %x" -o "$dir/time.txt" \
+        "$gnss_sdr" --config_file="$dir/benchmark.conf" > "$dir/gnss-sdr.log" 2>&1 &
+    time_pid=$!
+    # CPU ticks of each thread of the receiver, until it ends
+    while kill -0 $time_pid 2> /dev/null
+    do
+        for pid in $(pgrep -P $time_pid)
+        do
+            for task in /proc/"$pid"/task/*
+            do
+                if [ -r "$task/stat" ]
+                then
+                    comm=$(cat "$task/comm" 2> /dev/null)
+                    # the fields after the name, which may have spaces: utime and stime are the 12th and 13th
+                    ticks=$(sed 's/^.*) //' "$task/stat" 2> /dev/null | awk '{ print $12 + $13 }')
+                    [ -n "$ticks" ] && printf '%s\t%s\t%s\n' "${task##*/}" "$comm" "$ticks" >> "$dir/threads.txt"
+                fi
+            done
+        done
+        sleep "$period"
+    done
+    wait $time_pid
+
+    read -r elapsed user_s system_s peak_rss_kb status < "$dir/time.txt"
+    if [ -z "$status" ]
+    then
+        # GNU time writes a line before the measurements if the command fails
+        read -r elapsed user_s system_s peak_rss_kb status << EOF
+$(tail -n 1 "$dir/time.txt")
+EOF
+    fi
+    real_time_factor=$(awk -v e="$elapsed" -v d="$duration" 'BEGIN { if (e > 0) printf "%.3f", d / e; else print 0 }')
+    max_channels=$(awk -v c=$channels -v r="$real_time_factor" 'BEGIN { printf "%d", c * r }')
+    stages=$(awk -F '\t' '
+        { ticks[$1] = $3; name[$1] = $2 }
+        END {
+            for (tid in ticks) { stage = name[tid]; sub(/[0-9]+$/, "", stage); sum[stage] += ticks[tid]; total += ticks[tid] }
+            first = 1
+            for (stage in sum) {
+                printf "%s\"%s\": %.3f", (first ? "" : ", "), stage, (total > 0 ? sum[stage] / total : 0)
+                first = 0
+            }
+        }' "$dir/threads.txt")
+    {
+        printf "%b" "$separator"
+        echo "    {"
+        echo "      \"config\": \"$name\","
+        echo "      \"exit_status\": ${status:-1},"
+        echo "      \"channels\": $channels,"
+        echo "      \"processing_time_s\": ${elapsed:-0},"
+        echo "      \"user_cpu_s\": ${user_s:-0},"
+        echo "      \"system_cpu_s\": ${system_s:-0},"
+        echo "      \"peak_rss_kb\": ${peak_rss_kb:-0},"
+        echo "      \"real_time_factor\": $real_time_factor,"
+        echo "      \"max_channels_real_time\": $max_channels,"
+        echo "      \"stages\": {$stages}"
+        printf "    }"
+    } >> "$results"
+    separator=",\n"
+    echo "Real-time factor of $name: $real_time_factor (peak RSS $peak_rss_kb kB)"
+    if [ "${status:-1}" -ne 0 ]
+    then
+        echo "GNSS-SDR failed with $config, see $dir/gnss-sdr.log"
+    fi
+done
+
+{
+    echo ""
+    echo "  ]"
+    echo "}"
+} >> "$results"
+echo "Results written to $results"
+exit 0
@@ -0,0 +1,139 @@
+#!/usr/bin/env python3
+#
+# GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+# This file is part of GNSS-SDR.
+#
+# Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+# SPDX-License-Identifier: GPL-3.0-or-later
+
+"""Writes the costs of the target machine used by gnss-sdr --capacity_plan.
+
+It reads the JSON results of the benchmarks of src/tests/benchmarks and of
+volk_gnsssdr_profile, obtained on the target machine with
+  volk_gnsssdr_profile -b -n -j results/volk_gnsssdr.json
+  ./benchmark_acquisition --benchmark_out=results/benchmark_acquisition.json --benchmark_out_format=json
+  ./benchmark_conditioner --benchmark_out=results/benchmark_conditioner.json --benchmark_out_format=json
+  ./benchmark_telemetry_decoder --benchmark_out=results/benchmark_telemetry_decoder.json --benchmark_out_format=json
+and writes the Capacity.* properties of the cost model, in the format of the
+configuration files:
+  gnss-sdr-capacity-calibrate.py results > capacity.conf
+  gnss-sdr --capacity_plan --config_file=my.conf --capacity_calibration=capacity.conf
+
+The costs that are not measured by the given results keep their defaults.
+The median of the results of each benchmark is used.
+
+usage: gnss-sdr-capacity-calibrate.py [-c cpus] results [results ...]
+"""
+
+import argparse
+import json
+import math
+import os
+import statistics
+import sys
+
+# Kernels of the correlators of the tracking, in the puppets of
+# volk_gnsssdr_profile (three correlators)
+VOLK_CORRELATOR_KERNELS = ('volk_gnsssdr_32fc_resamplerxnpuppet_32fc',
+                           'volk_gnsssdr_32fc_x2_rotator_dotprodxnpuppet_32fc')
+VOLK_PUPPET_CORRELATORS = 3
+
+
+def google_benchmark_runs(data):
+    """Runs of each benchmark, without the aggregates of the repetitions."""
+    runs = {}
+    for benchmark in data['benchmarks']:
+        if benchmark.get('run_type') == 'aggregate':
+            continue
+        name = benchmark.get('run_name', benchmark['name'])
+        runs.setdefault(name.split('/')[0], []).append(benchmark)
+    return runs
+
+
+def cpu_ns(benchmark):
+    scale = {'ns': 1.0, 'us': 1e3, 'ms': 1e6, 's': 1e9}
+    return benchmark['cpu_time'] * scale[benchmark.get('time_unit', 'ns')]
+
+
+def per_sample(runs, name, log2=False):
+    """Median time per point of a stage of benchmark_acquisition, in ns."""
+    values = []
+    for benchmark in runs.get(name, []):
+        n = benchmark.get('fft_size', 0)
+        if n > 1 and not benchmark.get('error_occurred', False):
+            values.append(cpu_ns(benchmark) / (n * (math.log2(n) if log2 else 1.0)))
+    return statistics.median(values) if values else None
+
+
+def per_msps(runs, name):
+    """Median time per sample from the MSps counter, in ns."""
+    values = [1e3 / b['MSps'] for b in runs.get(name, []) if b.get('MSps', 0.0) > 0.0]
+    return statistics.median(values) if values else None
+
+
+def read_costs(data, costs):
+    if 'volk_gnsssdr_tests' in data:
+        # the fastest implementation, as chosen by the profile
+        ns = []
+        for kernel in VOLK_CORRELATOR_KERNELS:
+            times = [result['time'] / max(test['iter'], 1) * 1e6 / max(test['vlen'], 1)
+                     for test in data['volk_gnsssdr_tests'] if test['name'] == kernel
+                     for result in test['results'].values()]
+            if times:
+                ns.append(min(times))
+        if len(ns) == len(VOLK_CORRELATOR_KERNELS):
+            costs['correlator_ns_per_sample'] = sum(ns) / VOLK_PUPPET_CORRELATORS
+        return
+    runs = google_benchmark_runs(data)
+    fft = [v for v in (per_sample(runs, 'bm_stage_fft', True), per_sample(runs, 'bm_stage_ifft', True)) if v]
+    if fft:
+        costs['fft_ns_per_point_log2'] = statistics.mean(fft)
+    multiply = [v for v in (per_sample(runs, 'bm_stage_wipeoff'), per_sample(runs, 'bm_stage_multiply')) if v]
+    if multiply:
+        costs['multiply_ns_per_sample'] = statistics.mean(multiply)
+    measured = {
+        'peak_search_ns_per_sample': per_sample(runs, 'bm_stage_peak_search'),
+        'source_ns_per_sample': per_msps(runs, 'bm_unpacker'),
+        'conditioner_ns_per_sample': per_msps(runs, 'bm_fused_signal_conditioner'),
+    }
+    costs.update({key: value for key, value in measured.items() if value})
+    channels = [b['realtime_channels'] for b in runs.get('bm_telemetry_decoder', [])
+                if b.get('realtime_channels', 0.0) > 0.0]
+    if channels:
+        costs['telemetry_cores_per_channel'] = 1.0 / statistics.median(channels)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('-c', '--cpus', type=int, default=0,
+                        help='CPUs of the target machine (default: those of the machine running gnss-sdr)')
+    parser.add_argument('results', nargs='+', help='JSON files or folders with the benchmark results')
+    args = parser.parse_args()
+
+    files = []
+    for path in args.results:
+        if os.path.isdir(path):
+            files += [os.path.join(path, name) for name in sorted(os.listdir(path)) if name.endswith('.json')]
+        else:
+            files.append(path)
+
+    costs = {}
+    for filename in files:
+        with open(filename) as json_file:
+            read_costs(json.load(json_file), costs)
+    if not costs:
+        print('No cost was found in the results', file=sys.stderr)
+        return 1
+
+    print('[GNSS-SDR]')
+    print('; written by gnss-sdr-capacity-calibrate.py from ' + ' '.join(args.results))
+    if args.cpus > 0:
+        print('Capacity.cpus={}'.format(args.cpus))
+    for key in sorted(costs):
+        print('Capacity.{}={:.6g}'.format(key, costs[key]))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
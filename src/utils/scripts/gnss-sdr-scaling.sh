@@ -0,0 +1,173 @@
+#!/bin/sh
+# GNSS-SDR shell script that finds how many RF channels a machine processes in
+# real time, by replaying a recording into an increasing number of virtual RF
+# channels with the Replica_File_Signal_Source, until the processing is slower
+# than the signal.
+#
+# usage: ./gnss-sdr-scaling.sh [-f first] [-m max] [-i increment]
+#            [-d duration_s] [-c channels_per_rf_channel] [-g signal]
+#            [-r signal_source_role] ./gnss-sdr config_file.conf output_dir
+#
+#  -f  first number of RF channels (default: 1)
+#  -m  maximum number of RF channels (default: 16)
+#  -i  increment of the number of RF channels (default: 1)
+#  -d  seconds of signal processed in each run (default: 30). The recording is
+#      repeated if it is shorter
+#  -c  channels of the signal given by -g per RF channel. If 0, the channels of
+#      config_file are spread over the RF channels (default: 0)
+#  -g  signal of the channels added by -c (default: 1C)
+#  -r  role of the signal source in config_file (default: SignalSource)
+#
+# config_file must set the role to Replica_File_Signal_Source, and may set its
+# doppler_step_hz and delay_step_samples. The conditioner of each added RF
+# channel is a copy of SignalConditioner, DataTypeAdapter, InputFilter and
+# Resampler. The run with n RF channels is written to output_dir/rf_n, and a
+# summary of all the runs to output_dir/scaling.txt.
+
+# SPDX-FileCopyrightText: 2022 (see AUTHORS file for a list of contributors)
+# SPDX-License-Identifier: GPL-3.0-or-later
+
+first=1
+max=16
+increment=1
+duration=30
+channels_per_rf=0
+signal=1C
+role=SignalSource
+
+while getopts "f:m:i:d:c:g:r:" option
+do
+    case $option in
+        f) first=$OPTARG ;;
+        m) max=$OPTARG ;;
+        i) increment=$OPTARG ;;
+        d) duration=$OPTARG ;;
+        c) channels_per_rf=$OPTARG ;;
+        g) signal=$OPTARG ;;
+        r) role=$OPTARG ;;
+        *) echo "Unknown option"; exit 1 ;;
+    esac
+done
+shift $((OPTIND - 1))
+
+if [ $# -ne 3 ]
+then
+    echo "usage: $0 [-f first] [-m max] [-i increment] [-d duration_s] [-c channels_per_rf_channel] [-g signal] [-r signal_source_role] ./gnss-sdr config_file.conf output_dir"
+    exit 1
+fi
+
+gnss_sdr=$1
+config=$2
+output=$3
+
+# last value of a property in the configuration file
+property() {
+    sed -n "s/^[[:space:]]*$1[[:space:]]*=[[:space:]]*\([^;#[:space:]]*\).*/\1/p" "$config" | tail -n 1
+}
+
+if [ "$(property "$role.implementation")" != "Replica_File_Signal_Source" ]
+then
+    echo "$role.implementation must be Replica_File_Signal_Source in $config"
+    exit 1
+fi
+fs=$(property "$role.sampling_frequency")
+if [ -z "$fs" ]
+then
+    echo "$role.sampling_frequency is not set in $config"
+    exit 1
+fi
+# the number of samples of interleaved I/Q files counts both components
+items_per_sample=1
+case $(property "$role.item_type") in
+    ishort | ibyte) items_per_sample=2 ;;
+esac
+samples=$(awk -v d="$duration" -v fs="$fs" -v m=$items_per_sample 'BEGIN { printf "%.0f", d * fs * m }')
+
+# channels of config_file, used if -c is 0
+config_channels=0
+for s in 1C 2S L5 1B 5X 7X E6 1G 2G B1 B3
+do
+    count=$(property "Channels_$s.count")
+    config_channels=$((config_channels + ${count:-0}))
+done
+
+mkdir -p "$output" || exit 1
+summary="$output/scaling.txt"
+echo "# RF channels, channels, processing time [s], processing time / signal duration" > "$summary"
+
+last_real_time=0
+n=$first
+while [ "$n" -le "$max" ]
+do
+    dir="$output/rf_$n"
+    mkdir -p "$dir"
+    if [ "$channels_per_rf" -gt 0 ]
+    then
+        channels=$((n * channels_per_rf))
+    else
+        channels=$config_channels
+    fi
+
+    # The overrides are appended to a copy of config_file, since the last
+    # value of a property is the one used
+    {
+        cat "$config"
+        echo ""
+        echo "[GNSS-SDR]"
+        echo "$role.RF_channels=$n"
+        echo "$role.samples=$samples"
+        echo "$role.repeat=true"
+        echo "$role.enable_throttle_control=false"
+        k=1
+        while [ $k -lt "$n" ]
+        do
+            sed -n -e "s/^[[:space:]]*SignalConditioner\./SignalConditioner$k./p" \
+                -e "s/^[[:space:]]*DataTypeAdapter\./DataTypeAdapter$k./p" \
+                -e "s/^[[:space:]]*InputFilter\./InputFilter$k./p" \
+                -e "s/^[[:space:]]*Resampler\./Resampler$k./p" "$config"
+            k=$((k + 1))
+        done
+        if [ "$channels_per_rf" -gt 0 ]
+        then
+            echo "Channels_$signal.count=$channels"
+        fi
+        i=0
+        while [ $i -lt "$channels" ]
+        do
+            if [ "$channels_per_rf" -gt 0 ]
+            then
+                echo "Channel$i.RF_channel_ID=$((i / channels_per_rf))"
+            else
+                echo "Channel$i.RF_channel_ID=$((i % n))"
+            fi
+            i=$((i + 1))
+        done
+        echo "PVT.output_path=$dir"
+        echo "PVT.rinex_output_path=$dir"
+    } > "$dir/scaling.conf"
+
+    echo "Processing $duration s of signal with $n RF channels and $channels channels..."
+    start=$(date +%s)
+    "$gnss_sdr" --config_file="$dir/scaling.conf" > "$dir/gnss-sdr.log" 2>&1
+    status=$?
+    end=$(date +%s)
+    elapsed=$((end - start))
+    ratio=$(awk -v e=$elapsed -v d="$duration" 'BEGIN { printf "%.3f", e / d }')
+    echo "$n, $channels, $elapsed, $ratio" >> "$summary"
+
+    if [ $status -ne 0 ]
+    then
+        echo "GNSS-SDR failed with $n RF channels, see $dir/gnss-sdr.log"
+        break
+    fi
+    if awk -v r="$ratio" 'BEGIN { exit !(r > 1.0) }'
+    then
+        echo "Real time lost with $n RF channels ($elapsed s to process $duration s of signal)"
+        break
+    fi
+    last_real_time=$n
+    n=$((n + increment))
+done
+
+echo "Largest number of RF channels processed in real time: $last_real_time" | tee -a "$summary"
+exit 0
@@ -0,0 +1,175 @@
+#!/bin/sh
+# GNSS-SDR shell script that processes a long recording faster than real time,
+# by splitting it into overlapping time shards processed in parallel, and
+# stitching the RINEX files of the shards back together.
+#
+# usage: ./gnss-sdr-shards.sh [-j jobs] [-l shard_length_s] [-o overlap_s]
+#            [-r signal_source_role] [-p] ./gnss-sdr config_file.conf
+#            recording_duration_s output_dir
+#
+#  -j  number of gnss-sdr instances running at the same time (default: nproc)
+#  -l  length of each shard, in seconds (default: 3600)
+#  -o  seconds processed before each shard, for acquisition, bit
+#      synchronization and the collection of ephemeris (default: 60)
+#  -r  role of the file signal source in config_file (default: SignalSource)
+#  -p  only write the configuration files of the shards, to run them somewhere
+#      else, and stitch their outputs later running this script without -p
+#
+# The shard k is written to output_dir/shard_k, and the stitched RINEX files
+# to output_dir. Only RINEX 3 observation files can be stitched. Navigation
+# files are merged by appending the records of all the shards. All the
+# instances run in the current directory, so dump files should be disabled in
+# config_file.
+
+# SPDX-FileCopyrightText: 2022 (see AUTHORS file for a list of contributors)
+# SPDX-License-Identifier: GPL-3.0-or-later
+
+jobs=$(nproc 2>/dev/null || echo 1)
+length=3600
+overlap=60
+role=SignalSource
+prepare_only=0
+
+while getopts "j:l:o:r:p" option
+do
+    case $option in
+        j) jobs=$OPTARG ;;
+        l) length=$OPTARG ;;
+        o) overlap=$OPTARG ;;
+        r) role=$OPTARG ;;
+        p) prepare_only=1 ;;
+        *) echo "Unknown option"; exit 1 ;;
+    esac
+done
+shift $((OPTIND - 1))
+
+if [ $# -ne 4 ]
+then
+    echo "usage: $0 [-j jobs] [-l shard_length_s] [-o overlap_s] [-r signal_source_role] [-p] ./gnss-sdr config_file.conf recording_duration_s output_dir"
+    exit 1
+fi
+
+gnss_sdr=$1
+config=$2
+duration=$3
+output=$4
+
+# last value of a property in the configuration file
+property() {
+    sed -n "s/^[[:space:]]*$1[[:space:]]*=[[:space:]]*\([^;#[:space:]]*\).*/\1/p" "$config" | tail -n 1
+}
+
+fs=$(property "$role.sampling_frequency")
+if [ -z "$fs" ]
+then
+    echo "$role.sampling_frequency is not set in $config"
+    exit 1
+fi
+# the number of samples of interleaved I/Q files counts both components
+items_per_sample=1
+case $(property "$role.item_type") in
+    ishort | ibyte) items_per_sample=2 ;;
+esac
+
+shards=$(awk -v d="$duration" -v l="$length" 'BEGIN { n = int(d / l); if (n * l < d) n++; print n }')
+mkdir -p "$output" || exit 1
+
+# Configuration of each shard: the overrides are appended to a copy of
+# config_file, since the last value of a property is the one used
+k=0
+while [ $k -lt "$shards" ]
+do
+    dir="$output/shard_$k"
+    mkdir -p "$dir"
+    start=$(awk -v k=$k -v l="$length" -v o="$overlap" 'BEGIN { s = k * l - o; if (s < 0) s = 0; print s }')
+    end=$(awk -v k=$k -v l="$length" -v d="$duration" 'BEGIN { e = (k + 1) * l; if (e > d) e = d; print e }')
+    samples=$(awk -v s="$start" -v e="$end" -v fs="$fs" -v m=$items_per_sample 'BEGIN { printf "%.0f", (e - s) * fs * m }')
+    {
+        cat "$config"
+        echo ""
+        echo "[GNSS-SDR]"
+        echo "$role.seconds_to_skip=$start"
+        echo "$role.samples=$samples"
+        echo "$role.repeat=false"
+        echo "PVT.output_path=$dir"
+        echo "PVT.rinex_output_path=$dir"
+    } > "$dir/shard.conf"
+    k=$((k + 1))
+done
+
+if [ $prepare_only -eq 0 ]
+then
+    k=0
+    running=0
+    while [ $k -lt "$shards" ]
+    do
+        dir="$output/shard_$k"
+        echo "Processing shard $k of $shards..."
+        "$gnss_sdr" --config_file="$dir/shard.conf" > "$dir/gnss-sdr.log" 2>&1 &
+        running=$((running + 1))
+        if [ $running -ge "$jobs" ]
+        then
+            wait
+            running=0
+        fi
+        k=$((k + 1))
+    done
+    wait
+fi
+
+# Stitch the RINEX observation files: the epochs of each shard are appended
+# if they are later than the last epoch already written
+stitched_obs=""
+for file in "$output"/shard_0/*O "$output"/shard_0/*.[0-9][0-9]o
+do
+    [ -f "$file" ] && stitched_obs="$output/$(basename "$file")" && break
+done
+if [ -n "$stitched_obs" ]
+then
+    : > "$stitched_obs"
+    k=0
+    while [ $k -lt "$shards" ]
+    do
+        for file in "$output/shard_$k"/*O "$output/shard_$k"/*.[0-9][0-9]o
+        do
+            [ -f "$file" ] || continue
+            last=$(sed -n 's/^> \(.\{27\}\).*/\1/p' "$stitched_obs" | tail -n 1)
+            awk -v first=$k -v last="$last" '
+                /END OF HEADER/ && !body { body = 1; if (first == 0) print; next }
+                !body { if (first == 0) print; next }
+                /^>/ { keep = substr($0, 3, 27) > last }
+                keep { print }' "$file" >> "$stitched_obs"
+            break
+        done
+        k=$((k + 1))
+    done
+    echo "RINEX observation file written to $stitched_obs"
+fi
+
+# Merge the RINEX navigation files: header of the first shard, and the records
+# of all the shards
+for file in "$output"/shard_0/*[NGLP] "$output"/shard_0/*.[0-9][0-9][nglp]
+do
+    [ -f "$file" ] || continue
+    name=$(basename "$file")
+    suffix=$(printf "%s" "$name" | sed 's/.*\(.\)$/\1/')
+    stitched_nav="$output/$name"
+    : > "$stitched_nav"
+    k=0
+    while [ $k -lt "$shards" ]
+    do
+        for shard_file in "$output/shard_$k"/*"$suffix"
+        do
+            [ -f "$shard_file" ] || continue
+            awk -v first=$k '
+                /END OF HEADER/ && !body { body = 1; if (first == 0) print; next }
+                !body { if (first == 0) print; next }
+                { print }' "$shard_file" >> "$stitched_nav"
+            break
+        done
+        k=$((k + 1))
+    done
+    echo "RINEX navigation file written to $stitched_nav"
+done
+
+exit 0
@@ -0,0 +1,243 @@
+/*!
+ * \file main.cc
+ * \brief Computes the position of a burst of samples a few milliseconds
+ * long (snapshot positioning), with coarse-time navigation.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "GPS_L1_CA.h"
+#include "Galileo_E1.h"
+#include "MATH_CONSTANTS.h"
+#include "acq_snapshot_search.h"
+#include "galileo_e1_signal_replica.h"
+#include "gnss_capture_file.h"
+#include "gnss_replica_cache.h"
+#include "gnss_sdr_flags.h"
+#include "gnss_sdr_supl_client.h"
+#include "gps_sdr_signal_replica.h"
+#include "rtklib_rtkcmn.h"
+#include "snapshot_solver.h"
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <cstring>  // for memcpy
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#if GFLAGS_OLD_NAMESPACE
+namespace gflags
+{
+using namespace google;
+}
+#endif
+
+DEFINE_string(gps_ephemeris_xml, "gps_ephemeris.xml", "GPS L1 C/A ephemeris saved by the receiver or the assistance tools");
+DEFINE_string(gal_ephemeris_xml, "gal_ephemeris.xml", "Galileo ephemeris saved by the receiver or the assistance tools");
+DEFINE_double(ref_lat, 0.0, "A priori latitude [deg], within some tens of kilometres of the receiver");
+DEFINE_double(ref_lon, 0.0, "A priori longitude [deg]");
+DEFINE_double(ref_height, 0.0, "A priori height [m]");
+DEFINE_double(coarse_time, 0.0, "UNIX time of the first sample [s], if the capture file is not timestamped");
+DEFINE_int32(snapshot_ms, 20, "Milliseconds of the capture file used for the fix");
+DEFINE_int32(skip_ms, 0, "Milliseconds skipped at the start of the capture file");
+DEFINE_double(snapshot_threshold, 3.0, "Peak over mean power of the grid that detects a satellite");
+
+
+namespace
+{
+// converts the items of the capture file to complex samples, removing the intermediate frequency
+bool snapshot_read_samples(Gnss_Capture_Reader& reader, uint64_t first_item, size_t nitems, std::vector<gr_complex>& samples)
+{
+    const Gnss_Capture_Header& header = reader.header();
+    std::vector<uint8_t> items(nitems * header.item_size);
+    reader.seek(first_item);
+    nitems = reader.read(items.data(), nitems);
+    samples.resize(nitems);
+    for (size_t i = 0; i < nitems; i++)
+        {
+            const uint8_t* item = items.data() + i * header.item_size;
+            if (header.item_type == "gr_complex")
+                {
+                    memcpy(&samples[i], item, sizeof(gr_complex));
+                }
+            else if (header.item_type == "cshort")
+                {
+                    int16_t iq[2];
+                    memcpy(iq, item, sizeof(iq));
+                    samples[i] = gr_complex(iq[0], iq[1]);
+                }
+            else if (header.item_type == "cbyte")
+                {
+                    const auto* iq = reinterpret_cast<const int8_t*>(item);
+                    samples[i] = gr_complex(iq[0], iq[1]);
+                }
+            else
+                {
+                    std::cerr << "Item type " << header.item_type << " not supported, use gr_complex, cshort or cbyte\n";
+                    return false;
+                }
+        }
+    if (header.intermediate_frequency != 0.0)
+        {
+            const double phase_step = -2.0 * GNSS_PI * header.intermediate_frequency / header.sampling_frequency;
+            for (size_t i = 0; i < nitems; i++)
+                {
+                    const double phase = phase_step * static_cast<double>(first_item + i);
+                    samples[i] *= gr_complex(static_cast<float>(std::cos(phase)), static_cast<float>(std::sin(phase)));
+                }
+        }
+    return true;
+}
+
+
+// searches the satellites with ephemeris of a signal in the burst
+template <typename Ephemeris_Map, typename Code_Gen>
+void snapshot_search(const std::string& signal, char system, const Ephemeris_Map& ephemeris_map, double code_period_s, double fs,
+    const std::vector<gr_complex>& samples, const Code_Gen& code_gen, std::vector<Snapshot_Measurement>& measurements)
+{
+    const double samples_per_code = fs * code_period_s;
+    if (ephemeris_map.empty() or std::fabs(samples_per_code - std::round(samples_per_code)) > 1e-6)
+        {
+            return;
+        }
+    const auto code_length = static_cast<uint32_t>(std::round(samples_per_code));
+    const int32_t doppler_max = (FLAGS_doppler_max > 0 ? FLAGS_doppler_max : 5000);
+    const int32_t doppler_step = (FLAGS_doppler_step > 0 ? FLAGS_doppler_step : static_cast<int32_t>(std::round(250.0 * 1e-3 / code_period_s)));
+    Acq_Snapshot_Search search(signal, static_cast<int64_t>(fs), code_length, doppler_max, doppler_step);
+    for (const auto& eph : ephemeris_map)
+        {
+            const auto prn = static_cast<uint32_t>(eph.first);
+            const auto code = Gnss_Replica_Cache::get().get_complex(signal == "1C" ? "GPS 1C" : "Galileo 1B", prn, fs, "snapshot", code_length,
+                [&code_gen, prn](own::span<std::complex<float>> replica) { code_gen(replica, prn); });
+            search.add_satellite(system, prn, code->data());
+        }
+    for (const auto& result : search.search(samples.data(), samples.size(), static_cast<float>(FLAGS_snapshot_threshold)))
+        {
+            std::cout << system << std::setw(2) << std::setfill('0') << result.prn << std::setfill(' ')
+                      << "  code phase " << std::fixed << std::setprecision(3) << std::setw(8) << result.code_phase_s * 1e6 << " us"
+                      << "  Doppler " << std::setprecision(0) << std::setw(6) << result.doppler_hz << " Hz"
+                      << "  test statistic " << std::setprecision(2) << result.test_statistic
+                      << (result.detected ? "" : "  (not detected)") << '\n';
+            if (result.detected)
+                {
+                    Snapshot_Measurement measurement;
+                    measurement.system = system;
+                    measurement.prn = result.prn;
+                    measurement.code_phase_s = result.code_phase_s;
+                    measurements.push_back(measurement);
+                }
+        }
+}
+}  // namespace
+
+
+int main(int argc, char** argv)
+{
+    const std::string intro_help(
+        std::string("\n Snapshot positioning: computes the position of a GNSS-SDR capture file a few milliseconds long\n") +
+        "from the code phases of its GPS L1 C/A and Galileo E1 satellites, the ephemerides saved by a previous\n" +
+        "run of the receiver (or assistance data), an a priori position and a coarse time.\n" +
+        "Usage: snapshot-fix -s=<capture file> --ref_lat=<deg> --ref_lon=<deg> [--gps_ephemeris_xml=<file>] [--gal_ephemeris_xml=<file>]\n" +
+        "Copyright (C) 2010-2022 (see AUTHORS file for a list of contributors)\n" +
+        "This program comes with ABSOLUTELY NO WARRANTY;\n" +
+        "See COPYING file to see a copy of the General Public License\n \n");
+
+    gflags::SetUsageMessage(intro_help);
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+    google::InitGoogleLogging(argv[0]);
+
+    const std::string capture_file = (FLAGS_s != "-" ? FLAGS_s : FLAGS_signal_source);
+    std::vector<gr_complex> samples;
+    double sampling_frequency = 0.0;
+    double first_sample_time_s = FLAGS_coarse_time;
+    try
+        {
+            Gnss_Capture_Reader reader(capture_file);
+            sampling_frequency = reader.header().sampling_frequency;
+            const auto first_item = static_cast<uint64_t>(std::round(FLAGS_skip_ms * 1e-3 * sampling_frequency));
+            const auto nitems = static_cast<size_t>(std::round(FLAGS_snapshot_ms * 1e-3 * sampling_frequency));
+            if (first_sample_time_s == 0.0)
+                {
+                    first_sample_time_s = reader.time_of(first_item);
+                }
+            if (!snapshot_read_samples(reader, first_item, nitems, samples))
+                {
+                    return 1;
+                }
+        }
+    catch (const std::exception& e)
+        {
+            std::cerr << "Cannot read the capture file " << capture_file << ": " << e.what() << '\n';
+            return 1;
+        }
+    if (std::isnan(first_sample_time_s) or first_sample_time_s == 0.0)
+        {
+            std::cerr << "The capture file is not timestamped, set the time of the first sample with --coarse_time\n";
+            return 1;
+        }
+
+    Snapshot_Solver solver;
+    Gnss_Sdr_Supl_Client assistance;
+    if (assistance.load_ephemeris_xml(FLAGS_gps_ephemeris_xml))
+        {
+            solver.gps_ephemeris_map = assistance.gps_ephemeris_map;
+        }
+    if (assistance.load_gal_ephemeris_xml(FLAGS_gal_ephemeris_xml))
+        {
+            solver.galileo_ephemeris_map = assistance.gal_ephemeris_map;
+        }
+    if (solver.gps_ephemeris_map.empty() and solver.galileo_ephemeris_map.empty())
+        {
+            std::cerr << "No ephemeris found in " << FLAGS_gps_ephemeris_xml << " nor in " << FLAGS_gal_ephemeris_xml << '\n';
+            return 1;
+        }
+
+    std::vector<Snapshot_Measurement> measurements;
+    snapshot_search("1C", 'G', solver.gps_ephemeris_map, GPS_L1_CA_CODE_PERIOD_S, sampling_frequency, samples,
+        [sampling_frequency](own::span<std::complex<float>> replica, uint32_t prn) { gps_l1_ca_code_gen_complex_sampled(replica, prn, static_cast<int32_t>(sampling_frequency), 0); },
+        measurements);
+    snapshot_search("1B", 'E', solver.galileo_ephemeris_map, GALILEO_E1_CODE_PERIOD_S, sampling_frequency, samples,
+        [sampling_frequency](own::span<std::complex<float>> replica, uint32_t prn) { galileo_e1_code_gen_complex_sampled(replica, {'1', 'B', '\0'}, false, prn, static_cast<int32_t>(sampling_frequency), 0, false); },
+        measurements);
+
+    gtime_t coarse_time{};
+    coarse_time.time = static_cast<time_t>(std::floor(first_sample_time_s));
+    coarse_time.sec = first_sample_time_s - std::floor(first_sample_time_s);
+    coarse_time = utc2gpst(coarse_time);
+    std::array<double, 3> reference_lla{FLAGS_ref_lat * D2R, FLAGS_ref_lon * D2R, FLAGS_ref_height};
+    std::array<double, 3> reference_ecef{};
+    pos2ecef(reference_lla.data(), reference_ecef.data());
+
+    const Snapshot_Fix fix = solver.solve(measurements, coarse_time, reference_ecef);
+    if (!fix.valid)
+        {
+            std::cout << "No fix: " << fix.satellites << " satellites with ephemeris detected";
+            if (fix.iterations > 0)
+                {
+                    std::cout << ", residuals of " << std::setprecision(1) << fix.residual_rms_m << " m after " << fix.iterations << " iterations";
+                }
+            std::cout << '\n';
+            return 2;
+        }
+    std::cout << "Fix with " << fix.satellites << " satellites: latitude " << std::setprecision(7) << fix.lla[0] * R2D
+              << " deg, longitude " << fix.lla[1] * R2D << " deg, height " << std::setprecision(1) << fix.lla[2]
+              << " m, time correction " << std::setprecision(3) << fix.time_correction_s
+              << " s, residuals " << std::setprecision(1) << fix.residual_rms_m << " m\n";
+
+    gflags::ShutDownCommandLineFlags();
+    return 0;
+}